@@ -23,19 +23,28 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/StridedArrayView.h>
 
 #include "Magnum/Math/Color.h"
 #include "Magnum/Math/Matrix4.h"
+#include "Magnum/ConvertPixels.h"
+#include "Magnum/FramePacer.h"
 #include "Magnum/Image.h"
+#include "Magnum/ImageOperations.h"
 #include "Magnum/ImageView.h"
 #include "Magnum/PixelFormat.h"
+#include "Magnum/ProfileScope.h"
+#include "Magnum/TaskScheduler.h"
+#include "Magnum/TiledImage.h"
 #ifdef MAGNUM_TARGET_GL
+#include "Magnum/AsyncResourceLoader.h"
 #include "Magnum/ResourceManager.h"
 #include "Magnum/GL/AbstractShaderProgram.h"
 #include "Magnum/GL/Mesh.h"
 #include "Magnum/GL/PixelFormat.h"
 #include "Magnum/GL/Texture.h"
+#include "Magnum/GL/TextureFormat.h"
 #endif
 
 #define DOXYGEN_ELLIPSIS(...) __VA_ARGS__
@@ -63,10 +72,120 @@ class MeshResourceLoader: public AbstractResourceLoader<GL::Mesh> {
     }
 };
 /* [AbstractResourceLoader-implementation] */
+
+Containers::Optional<Image2D> decodeImageFile(ResourceKey);
+
+/* [AsyncResourceLoader-implementation] */
+class TextureResourceLoader:
+    public AsyncResourceLoader<GL::Texture2D, Image2D>
+{
+    // Called on a worker thread, no GL calls allowed here
+    Containers::Optional<Image2D> doDecode(ResourceKey key) override {
+        // Load and decode the file, return an empty optional if not found
+        return decodeImageFile(key);
+    }
+
+    // Called from ResourceManager::update() on the main thread
+    Containers::Pointer<GL::Texture2D> doUpload(ResourceKey,
+        Image2D&& image) override
+    {
+        Containers::Pointer<GL::Texture2D> texture{InPlaceInit};
+        texture->setStorage(1, GL::textureFormat(image.format()), image.size())
+            .setSubImage(0, {}, image);
+        return texture;
+    }
+};
+/* [AsyncResourceLoader-implementation] */
 #endif
 
+namespace MyEngine {
+    struct JobSystem {
+        unsigned workerCount() const;
+        void dispatchAndWait(std::size_t count, void(*job)(void*, std::size_t), void* userData);
+    };
+}
+
+/* [TaskScheduler-custom] */
+class EngineTaskScheduler: public TaskScheduler {
+    public:
+        explicit EngineTaskScheduler(MyEngine::JobSystem& jobs): _jobs(jobs) {}
+
+    private:
+        UnsignedInt doThreadCount() const override {
+            return _jobs.workerCount();
+        }
+
+        void doRun(std::size_t count, void(*task)(void*, std::size_t),
+            void* state) override
+        {
+            _jobs.dispatchAndWait(count, task, state);
+        }
+
+        MyEngine::JobSystem& _jobs;
+};
+
+void setupScheduler(MyEngine::JobSystem& jobs) {
+    static EngineTaskScheduler scheduler{jobs};
+    TaskScheduler::setGlobal(&scheduler);
+}
+/* [TaskScheduler-custom] */
+
 int main() {
 
+{
+bool running{};
+Vector3 position, velocity;
+/* [FramePacer-usage] */
+FramePacer pacer;
+pacer.setTargetFrameRate(120.0f)
+     .start();
+
+while(running) {
+    /* Advance the simulation by a stable delta */
+    position += velocity*pacer.smoothedFrameDuration();
+
+    // Draw, swap buffers ...
+
+    pacer.nextFrame();
+}
+/* [FramePacer-usage] */
+}
+
+{
+struct Cloth {
+    void simulate() {}
+} cloth;
+/* [ProfileScope-usage] */
+{
+    ProfileScope scope{"Cloth simulation"};
+    cloth.simulate();
+}
+/* [ProfileScope-usage] */
+}
+
+{
+struct Physics {
+    static void step(void*) {}
+} physics;
+struct Animator {
+    static void advance(void*) {}
+} animator;
+struct Culling {
+    static void run(void*) {}
+} culling;
+/* [TaskGraph-usage] */
+TaskGraph frame;
+UnsignedInt a = frame.addTask(Animator::advance, &animator);
+UnsignedInt p = frame.addTask(Physics::step, &physics);
+UnsignedInt c = frame.addTask(Culling::run, &culling);
+
+/* Animation and physics run in parallel, culling after both are done */
+frame.addDependency(c, a)
+     .addDependency(c, p);
+frame.run();
+/* [TaskGraph-usage] */
+}
+
 {
 /* [features-using-namespace] */
 using namespace Corrade;
@@ -116,6 +235,47 @@ for(auto row: pixels.slice({48, 48}, {80, 80})) {
 /* [Image-pixels] */
 }
 
+{
+Containers::Array<char> bgrData;
+/* [convertPixels] */
+/* Swizzle BGR data to RGB in-place */
+MutableImageView2D image{PixelFormat::RGB8Unorm, {256, 256}, bgrData};
+convertPixels(image, image, ConvertPixelsFlag::SwapRedBlue);
+
+/* Convert to a linear half-float image with an alpha channel */
+Image2D linear = convertPixels(image, PixelFormat::RGBA16F);
+/* [convertPixels] */
+}
+
+{
+Image2D screenshot{PixelFormat::RGBA8Unorm};
+/* [cropImage] */
+/* A view on a 64x64 tile of the screenshot, no data copied */
+ImageView2D tile = cropImage(screenshot, {{128, 64}, {192, 128}});
+
+/* Tightly packed copy of it */
+Image2D tileCopy = copyImage(tile);
+/* [cropImage] */
+}
+
+{
+ImageView2D strip{PixelFormat::RGB8Unorm, {}};
+Int y{};
+/* [TiledImage2D-usage] */
+/* A 100k x 100k orthophoto in 512x512 tiles, nothing allocated yet */
+TiledImage2D image{PixelFormat::RGB8Unorm, {100000, 100000}, {512, 512}};
+
+/* Stream strips of rows in as they're decoded, allocating only the tiles
+   they touch, and collapse the ones that turned out to be a single color */
+image.setSubImage({0, y}, strip);
+image.compact();
+
+/* Read a small area back for processing */
+Image2D detail = image.subImage({{48000, 52000}, {49024, 53024}});
+/* [TiledImage2D-usage] */
+static_cast<void>(detail);
+}
+
 {
 char data[3];
 /* [ImageView-usage] */
@@ -294,6 +454,23 @@ if(!cube) {
 /* [ResourceManager-use] */
 }
 
+{
+typedef ResourceManager<GL::Texture2D> MyResourceManager;
+Image2D image{PixelFormat::RGBA8Unorm};
+/* [ResourceManager-cache] */
+MyResourceManager manager;
+
+// Keep at most 256 MB of currently unused textures around
+manager.setCacheBudget<GL::Texture2D>(256*1024*1024);
+
+GL::Texture2D texture;
+DOXYGEN_ELLIPSIS()
+std::size_t size = image.data().size();
+manager.set("terrain-17-42", std::move(texture),
+    ResourceDataState::Final, ResourcePolicy::Cached, size);
+/* [ResourceManager-cache] */
+}
+
 {
 ResourceManager<GL::AbstractShaderProgram> manager;
 struct MyShader: GL::AbstractShaderProgram {};
@@ -315,6 +492,27 @@ manager.setLoader<GL::Mesh>(std::move(loader));
 Resource<GL::Mesh> myMesh = manager.get<GL::Mesh>("my-mesh");
 /* [AbstractResourceLoader-use] */
 }
+
+{
+typedef ResourceManager<GL::Texture2D> MyResourceManager;
+bool running{};
+/* [AsyncResourceLoader-use] */
+MyResourceManager manager;
+manager.setLoader<GL::Texture2D>(Containers::pointer<TextureResourceLoader>());
+
+// The texture is in the ResourceState::Loading state until it gets decoded
+// and uploaded in one of the update() calls below
+Resource<GL::Texture2D> texture = manager.get<GL::Texture2D>("diffuse.png");
+
+while(running) {
+    // Draw the frame, skipping or using a fallback for textures that aren't
+    // available yet...
+
+    // Spend at most two milliseconds uploading decoded textures
+    manager.update(std::chrono::milliseconds{2});
+}
+/* [AsyncResourceLoader-use] */
+}
 #endif
 
 }
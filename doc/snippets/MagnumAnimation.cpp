@@ -24,14 +24,20 @@
 */
 
 #include <vector>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Reference.h>
+#include <Corrade/Containers/StridedArrayView.h>
 
 #include "Magnum/Timeline.h"
 #include "Magnum/Math/Bezier.h"
 #include "Magnum/Math/Matrix3.h"
 #include "Magnum/Math/Quaternion.h"
 #include "Magnum/Math/Packing.h"
+#include "Magnum/Animation/Blend.h"
 #include "Magnum/Animation/Easing.h"
+#include "Magnum/Animation/KeyframeLookup.h"
 #include "Magnum/Animation/Player.h"
+#include "Magnum/Animation/Quantization.h"
 
 #define DOXYGEN_ELLIPSIS(...) __VA_ARGS__
 
@@ -55,6 +61,20 @@ static_cast<void>(result1);
 static_cast<void>(result2);
 }
 
+{
+Float frame{};
+/* [interpolateInto] */
+Containers::ArrayView<const Float> keys = DOXYGEN_ELLIPSIS({});
+Containers::StridedArrayView2D<const Vector3> values = DOXYGEN_ELLIPSIS({});
+Containers::Array<Vector3> result{values.size()[1]};
+
+std::size_t hint{};
+Animation::interpolateInto<Float, Vector3, Vector3, Math::lerp>(keys, values,
+    Animation::Extrapolation::Constant, Animation::Extrapolation::Constant,
+    frame, hint, Containers::arrayView(result));
+/* [interpolateInto] */
+}
+
 {
 /* [unpack] */
 UnsignedShort a = DOXYGEN_ELLIPSIS(0), b = DOXYGEN_ELLIPSIS(0);
@@ -81,6 +101,25 @@ Float result2 = lerpPackedBounceIn(a, b, t);
 static_cast<void>(result1);
 static_cast<void>(result2);
 }
+
+{
+/* [packQuaternionSmallestThree] */
+Containers::ArrayView<const Float> keys = DOXYGEN_ELLIPSIS({});
+Containers::ArrayView<const Quaternion> rotations = DOXYGEN_ELLIPSIS({});
+
+/* Pack the rotations to a quarter of the original size */
+Containers::Array<UnsignedInt> packed{NoInit, rotations.size()};
+for(std::size_t i = 0; i != rotations.size(); ++i)
+    packed[i] = Animation::packQuaternionSmallestThree(rotations[i]);
+
+/* Unpack them on the fly during interpolation */
+Animation::TrackView<const Float, const UnsignedInt, Quaternion> track{
+    keys, packed, Animation::unpack<UnsignedInt, Quaternion, Math::slerp,
+        Animation::unpackQuaternionSmallestThree>()};
+Quaternion rotation = track.at(t);
+/* [packQuaternionSmallestThree] */
+static_cast<void>(rotation);
+}
 }
 
 {
@@ -152,6 +191,70 @@ player.add(scaling, objectScaling)
 /* [Player-usage] */
 }
 
+{
+/* [Player-advance-parallel] */
+/* One player for each character */
+Containers::Array<Containers::Reference<Animation::Player<Float>>> players =
+    DOXYGEN_ELLIPSIS({});
+
+Timeline timeline;
+DOXYGEN_ELLIPSIS()
+
+/* Each frame, advance on all available cores and log all players that
+   stopped */
+Animation::Player<Float>::advance(timeline.previousFrameTime(), players, 0,
+    [](Animation::Player<Float>& player, Animation::State, void*) {
+        if(player.state() == Animation::State::Stopped)
+            Debug{} << "Player" << &player << "stopped";
+    });
+/* [Player-advance-parallel] */
+}
+
+{
+/* [Player-addBatch] */
+/* Keyframe times shared by all characters, positions stored as
+   [keyframe][character] */
+Containers::ArrayView<const Float> keys = DOXYGEN_ELLIPSIS({});
+Containers::StridedArrayView2D<const Vector3> positions = DOXYGEN_ELLIPSIS({});
+
+/* One interpolated position for each character */
+Containers::Array<Vector3> characterPositions{positions.size()[1]};
+
+Animation::Player<Float> player;
+player.addBatch<Vector3, Vector3, Math::lerp>(keys, positions,
+    Containers::arrayView(characterPositions));
+/* [Player-addBatch] */
+}
+
+{
+/* [blendInto] */
+/* Rotations of all bones as [keyframe][bone] for a walk and a wave animation,
+   and a mask that has 1.0f for arm bones and 0.0f for the rest */
+Containers::ArrayView<const Float> walkKeys = DOXYGEN_ELLIPSIS({});
+Containers::StridedArrayView2D<const Quaternion> walkRotations = DOXYGEN_ELLIPSIS({});
+Containers::ArrayView<const Float> waveKeys = DOXYGEN_ELLIPSIS({});
+Containers::StridedArrayView2D<const Quaternion> waveRotations = DOXYGEN_ELLIPSIS({});
+Containers::ArrayView<const Float> armMask = DOXYGEN_ELLIPSIS({});
+
+/* Each layer is evaluated directly into its own pose array */
+Containers::Array<Quaternion> pose{walkRotations.size()[1]};
+Containers::Array<Quaternion> wavePose{waveRotations.size()[1]};
+Animation::Player<Float> walk, wave;
+walk.addBatch<Quaternion, Quaternion, Math::slerp>(walkKeys, walkRotations,
+    Containers::arrayView(pose));
+wave.addBatch<Quaternion, Quaternion, Math::slerp>(waveKeys, waveRotations,
+    Containers::arrayView(wavePose));
+
+/* Each frame, advance both and blend the wave over the walk, affecting only
+   the arms */
+Float time = DOXYGEN_ELLIPSIS({}), waveWeight = DOXYGEN_ELLIPSIS({});
+walk.advance(time);
+wave.advance(time);
+Animation::blendInto(Containers::arrayView(wavePose), waveWeight, armMask,
+    Containers::arrayView(pose));
+/* [blendInto] */
+}
+
 {
 const Animation::TrackView<Float, Vector3> translation;
 const Animation::TrackView<Float, Quaternion> rotation;
@@ -306,6 +409,20 @@ Vector2 position = jump.at(2.2f, hint);         // y = 0.775, hint = 2
 static_cast<void>(position);
 }
 
+{
+Animation::TrackView<const Float, const Vector3> cameraPath;
+/* [KeyframeLookup] */
+/* Build the lookup table once */
+Animation::KeyframeLookup<Float> lookup{cameraPath.keys()};
+
+/* Then seek to arbitrary times without having to search from the start */
+Float time = DOXYGEN_ELLIPSIS({});
+std::size_t hint = lookup.hint(time);
+Vector3 position = cameraPath.at(time, hint);
+/* [KeyframeLookup] */
+static_cast<void>(position);
+}
+
 {
 const Animation::Track<Float, Vector2> jump;
 /* [Track-performance-strict] */
@@ -82,4 +82,36 @@ listener.update({group, someOtherGroup});
 /* [Playable-usage] */
 }
 
+{
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+Scene3D scene;
+Audio::Listener3D listener{scene};
+Audio::Buffer footsteps, alarm;
+/* [Playable-voices] */
+/* At most 32 sources are used, no matter how many playables there are */
+Audio::PlayableGroup3D group;
+group.setVoiceCount(32);
+
+Object3D crowd[1000];
+for(Object3D& person: crowd) {
+    person.setParent(&scene);
+    (new Audio::Playable3D{person, &group})
+        ->setBuffer(&footsteps)
+        .setLooping(true)
+        .play();
+}
+
+/* Always audible over the crowd, unless really far away */
+Object3D siren{&scene};
+Audio::Playable3D sirenPlayable{siren, &group};
+sirenPlayable.setBuffer(&alarm)
+    .setPriority(100.0f)
+    .play();
+
+// every frame, assigns the sources to the most audible playables
+listener.update({group});
+/* [Playable-voices] */
+}
+
 }
@@ -23,13 +23,76 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/Utility/Path.h>
+
+#include "Magnum/Audio/AbstractImporter.h"
+#include "Magnum/Audio/Buffer.h"
 #include "Magnum/Audio/Context.h"
 #include "Magnum/Audio/Extensions.h"
+#include "Magnum/Audio/Source.h"
+#include "Magnum/Audio/StreamingSource.h"
 
 using namespace Magnum;
 
 int main() {
 
+{
+PluginManager::Manager<Audio::AbstractImporter> manager;
+Containers::Pointer<Audio::AbstractImporter> importer = manager.loadAndInstantiate("AnyAudioImporter");
+/* [AbstractImporter-dataChunk] */
+Containers::Array<char> chunk{NoInit, 65536};
+while(std::size_t size = importer->dataChunk(chunk)) {
+    // process chunk.prefix(size) ...
+}
+
+/* Rewind back to the beginning */
+importer->seekData(0);
+/* [AbstractImporter-dataChunk] */
+}
+
+{
+PluginManager::Manager<Audio::AbstractImporter> manager;
+/* [AbstractImporter-dataView] */
+Containers::Pointer<Audio::AbstractImporter> importer = manager.loadAndInstantiate("WavAudioImporter");
+
+/* The mapping has to stay alive for as long as the file is opened */
+Containers::Optional<Containers::Array<const char, Utility::Path::MapDeleter>> mapped = Utility::Path::mapRead("sounds.wav");
+if(!mapped || !importer->openMemory(*mapped))
+    Fatal{} << "Can't open sounds.wav";
+
+Audio::Buffer buffer;
+if(Containers::Optional<Containers::ArrayView<const char>> view = importer->dataView())
+    buffer.setData(importer->format(), *view, importer->frequency());
+else
+    buffer.setData(importer->format(), importer->data(), importer->frequency());
+/* [AbstractImporter-dataView] */
+}
+
+{
+PluginManager::Manager<Audio::AbstractImporter> manager;
+bool running{};
+/* [StreamingSource] */
+Containers::Pointer<Audio::AbstractImporter> importer = manager.loadAndInstantiate("AnyAudioImporter");
+if(!importer || !importer->openFile("music.ogg"))
+    Fatal{} << "Can't open music.ogg";
+
+Audio::StreamingSource music{*importer};
+music.setLooping(true)
+     .play();
+music.source().setGain(0.5f);
+
+/* Refill the buffers every frame, or call startUpdateThread() instead */
+while(running) {
+    music.update();
+    // ...
+}
+/* [StreamingSource] */
+}
+
 {
 /* [Context-isExtensionSupported] */
 if(Audio::Context::current().isExtensionSupported<Audio::Extensions::ALC::SOFTX::HRTF>()) {
@@ -23,9 +23,13 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/String.h>
 #include <Corrade/Containers/StringView.h>
+#include <Corrade/PluginManager/Manager.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Format.h>
 
 #include "Magnum/Image.h"
 #include "Magnum/ImageView.h"
@@ -36,15 +40,21 @@
 #include "Magnum/DebugTools/FrameProfiler.h"
 #include "Magnum/DebugTools/ResourceManager.h"
 #include "Magnum/DebugTools/ObjectRenderer.h"
+#include "Magnum/DebugTools/Screenshot.h"
 #include "Magnum/DebugTools/TextureImage.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/DefaultFramebuffer.h"
 #include "Magnum/GL/Framebuffer.h"
 #include "Magnum/GL/CubeMapTexture.h"
 #include "Magnum/GL/Texture.h"
 #include "Magnum/GL/TextureFormat.h"
+#include "Magnum/GL/TimerQueryPool.h"
 #include "Magnum/Math/Range.h"
+#include "Magnum/SceneGraph/Camera.h"
 #include "Magnum/SceneGraph/Drawable.h"
 #include "Magnum/SceneGraph/Object.h"
 #include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/Trade/AbstractImageConverter.h"
 
 #ifndef MAGNUM_TARGET_GLES
 #include "Magnum/GL/SampleQuery.h"
@@ -52,6 +62,13 @@
 #ifndef MAGNUM_TARGET_GLES2
 #include "Magnum/GL/BufferImage.h"
 #endif
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include "Magnum/DebugTools/AsyncReadback.h"
+#include "Magnum/DebugTools/ObjectIdPicker.h"
+#include "Magnum/GL/Buffer.h"
+#endif
+
+#define DOXYGEN_ELLIPSIS(...) __VA_ARGS__
 
 using namespace Magnum;
 using namespace Magnum::Math::Literals;
@@ -108,6 +125,26 @@ new DebugTools::ForceRenderer3D(manager, *object, {0.3f, 1.5f, -0.7f}, force,
 /* [ForceRenderer] */
 }
 
+{
+DebugTools::ResourceManager manager;
+SceneGraph::Camera3D* camera{};
+Containers::ArrayView<SceneGraph::Object<SceneGraph::MatrixTransformation3D>*> objects;
+Containers::ArrayView<Vector3> forces;
+/* [ForceRenderer-batch] */
+DebugTools::ForceRendererBatch3D batch{manager};
+SceneGraph::DrawableGroup3D debugDrawables;
+for(std::size_t i = 0; i != objects.size(); ++i)
+    new DebugTools::ForceRenderer3D{batch, *objects[i], {}, forces[i], "my",
+        &debugDrawables};
+
+DOXYGEN_ELLIPSIS()
+
+// In the draw event, collect the arrows and draw them all in a single call
+camera->draw(debugDrawables);
+batch.draw(*camera);
+/* [ForceRenderer-batch] */
+}
+
 #ifndef MAGNUM_TARGET_GLES
 {
 /* [FrameProfiler-setup-delayed] */
@@ -149,6 +186,24 @@ new DebugTools::ObjectRenderer3D{manager, *object, "my", &debugDrawables};
 /* [ObjectRenderer] */
 }
 
+{
+DebugTools::ResourceManager manager;
+SceneGraph::Camera3D* camera{};
+Containers::ArrayView<SceneGraph::Object<SceneGraph::MatrixTransformation3D>*> objects;
+/* [ObjectRenderer-batch] */
+DebugTools::ObjectRendererBatch3D batch{manager};
+SceneGraph::DrawableGroup3D debugDrawables;
+for(SceneGraph::Object<SceneGraph::MatrixTransformation3D>* object: objects)
+    new DebugTools::ObjectRenderer3D{batch, *object, "my", &debugDrawables};
+
+DOXYGEN_ELLIPSIS()
+
+// In the draw event, collect the transformations and draw all in one call
+camera->draw(debugDrawables);
+batch.draw(*camera);
+/* [ObjectRenderer-batch] */
+}
+
 {
 /* [FrameProfilerGL-usage] */
 DebugTools::FrameProfilerGL _profiler{
@@ -157,6 +212,43 @@ DebugTools::FrameProfilerGL _profiler{
 /* [FrameProfilerGL-usage] */
 }
 
+{
+/* [timerQueryPoolMeasurement] */
+GL::TimerQueryPool pool{3};
+DebugTools::FrameProfiler profiler{{
+    DebugTools::timerQueryPoolMeasurement(pool, "shadows"),
+    DebugTools::timerQueryPoolMeasurement(pool, "lighting")
+}, 50};
+
+// in every frame
+profiler.beginFrame();
+pool.beginFrame();
+// render...
+pool.endFrame();
+profiler.endFrame();
+/* [timerQueryPoolMeasurement] */
+}
+
+{
+/* [memoryUsageMeasurement] */
+/* Create the profiler before any GPU resources so they're all accounted for */
+DebugTools::FrameProfiler profiler{{
+    DebugTools::memoryUsageMeasurement(),
+    DebugTools::memoryUsageMeasurement(GL::MemoryUsageCategory::Texture)
+}, 50};
+/* [memoryUsageMeasurement] */
+}
+
+{
+/* [contextCounterMeasurement] */
+DebugTools::FrameProfiler profiler{{
+    DebugTools::contextCounterMeasurement(GL::ContextCounter::DrawCalls),
+    DebugTools::contextCounterMeasurement(GL::ContextCounter::TextureBindings),
+    DebugTools::contextCounterMeasurement(GL::ContextCounter::BufferUploadSize)
+}, 50};
+/* [contextCounterMeasurement] */
+}
+
 {
 GL::Texture2D texture;
 Range2Di rect;
@@ -197,6 +289,62 @@ GL::BufferImage2D image = DebugTools::textureSubImage(texture,
 /* [textureSubImage-cubemap-rvalue-buffer] */
 }
 #endif
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+{
+PluginManager::Manager<Trade::AbstractImageConverter> manager;
+bool recording{};
+UnsignedInt frame{};
+/* [AsyncScreenshot-usage] */
+DebugTools::AsyncScreenshot screenshot{manager};
+
+// In the draw event, capture every 10th frame while recording
+if(recording && frame % 10 == 0)
+    screenshot.capture(GL::defaultFramebuffer,
+        Utility::format("frame{:.05}.png", frame));
+
+// After swapping buffers
+screenshot.update();
+/* [AsyncScreenshot-usage] */
+}
+#endif
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+{
+GL::Buffer statsBuffer;
+Containers::Array<char> stats;
+/* [AsyncReadback] */
+// After the compute dispatch that fills the buffer, schedule a readback
+DebugTools::AsyncReadback readback = DebugTools::bufferDataAsync(statsBuffer);
+
+DOXYGEN_ELLIPSIS()
+
+// Some frames later, fetch the data only if the GPU is done with the copy
+if(readback.isReady())
+    stats = readback.data();
+/* [AsyncReadback] */
+}
+
+{
+GL::Framebuffer framebuffer{{}};
+Vector2i mousePosition;
+UnsignedInt highlightedId{};
+/* [ObjectIdPicker] */
+DebugTools::ObjectIdPicker picker;
+
+// Every frame, after drawing the scene with object ID output going to the
+// second color attachment
+framebuffer.mapForRead(GL::Framebuffer::ColorAttachment{1});
+picker.pick(framebuffer, mousePosition);
+
+// Use whatever result arrived in the meantime, usually from the previous
+// frame
+if(picker.update())
+    highlightedId = picker.objectId();
+/* [ObjectIdPicker] */
+static_cast<void>(highlightedId);
+}
+#endif
 }
 
 struct Foo: TestSuite::Tester {
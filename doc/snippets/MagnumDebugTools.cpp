@@ -32,11 +32,17 @@
 #include "Magnum/Image.h"
 #include "Magnum/ImageView.h"
 #include "Magnum/PixelFormat.h"
+#include "Magnum/ProfileScope.h"
 #include "Magnum/DebugTools/CompareImage.h"
 #include "Magnum/DebugTools/FrameProfiler.h"
 #include "Magnum/Math/Color.h"
 #include "Magnum/Trade/AbstractImporter.h"
 
+#ifdef MAGNUM_TARGET_VK
+#include "Magnum/Vk/CommandBuffer.h"
+#include "Magnum/Vk/Device.h"
+#endif
+
 using namespace Magnum;
 
 namespace {
@@ -162,4 +168,68 @@ DebugTools::FrameProfiler profiler{{
 /* [FrameProfiler-setup-immediate] */
 }
 
+{
+DebugTools::FrameProfiler profiler;
+/* [FrameProfiler-scopes] */
+profiler.enableScopes();
+
+// in every frame
+profiler.beginFrame();
+{
+    ProfileScope scope{"Physics"};
+    // ...
+}
+{
+    ProfileScope scope{"Rendering"};
+    {
+        ProfileScope shadows{"Shadow maps"};
+        // ...
+    }
+    // ...
+}
+profiler.endFrame();
+profiler.printStatistics(10);
+/* [FrameProfiler-scopes] */
+}
+
+{
+DebugTools::FrameProfiler profiler;
+bool keyPressed{}, saving{};
+/* [FrameProfiler-trace] */
+// on a key press, record the next 300 frames
+if(keyPressed) {
+    profiler.startTrace(300);
+    saving = true;
+}
+
+// in every frame
+profiler.beginFrame();
+// ...
+profiler.endFrame();
+if(saving && !profiler.isTracing()) {
+    profiler.saveTrace("trace.json");
+    saving = false;
+}
+/* [FrameProfiler-trace] */
+}
+
+#ifdef MAGNUM_TARGET_VK
+{
+Vk::Device device{NoCreate};
+Vk::CommandBuffer cmd{NoCreate};
+/* [FrameProfilerVk-usage] */
+DebugTools::FrameProfilerVk profiler{device,
+    DebugTools::FrameProfilerVk::Value::FrameTime|
+    DebugTools::FrameProfilerVk::Value::GpuDuration, 50};
+
+// in every frame
+cmd.begin();
+profiler.beginFrame(cmd);
+// render passes...
+profiler.endFrame(cmd);
+cmd.end();
+// submit the command buffer...
+/* [FrameProfilerVk-usage] */
+}
+#endif
 }
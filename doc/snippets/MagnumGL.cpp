@@ -33,14 +33,19 @@
 #include "Magnum/PixelFormat.h"
 #include "Magnum/GL/AbstractShaderProgram.h"
 #include "Magnum/GL/Buffer.h"
+#include "Magnum/GL/CommandRecorder.h"
 #include "Magnum/GL/Context.h"
 #include "Magnum/GL/CubeMapTexture.h"
 #include "Magnum/GL/DefaultFramebuffer.h"
+#include "Magnum/GL/DrawList.h"
 #include "Magnum/GL/Extensions.h"
 #include "Magnum/GL/Framebuffer.h"
+#include "Magnum/GL/MemoryUsage.h"
 #include "Magnum/GL/Mesh.h"
+#include "Magnum/GL/MeshView.h"
 #include "Magnum/GL/PixelFormat.h"
 #include "Magnum/GL/Renderer.h"
+#include "Magnum/GL/RenderStates.h"
 #include "Magnum/GL/Renderbuffer.h"
 #include "Magnum/GL/RenderbufferFormat.h"
 #include "Magnum/GL/Shader.h"
@@ -65,24 +70,32 @@
 #ifndef MAGNUM_TARGET_WEBGL
 #include "Magnum/GL/DebugOutput.h"
 #include "Magnum/GL/TimeQuery.h"
+#include "Magnum/GL/TimerQueryPool.h"
 #endif
 
 #ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/GL/BufferHeap.h"
 #include "Magnum/GL/BufferImage.h"
 #include "Magnum/GL/PrimitiveQuery.h"
+#include "Magnum/GL/RenderPass.h"
 #include "Magnum/GL/TextureArray.h"
+#include "Magnum/GL/TextureStreamer.h"
 #include "Magnum/GL/TransformFeedback.h"
 #endif
 
 #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
 #include "Magnum/GL/BufferTexture.h"
 #include "Magnum/GL/BufferTextureFormat.h"
+#include "Magnum/GL/ComputePass.h"
 #include "Magnum/GL/CubeMapTextureArray.h"
 #include "Magnum/GL/MultisampleTexture.h"
 #endif
 
 #ifndef MAGNUM_TARGET_GLES
 #include "Magnum/GL/RectangleTexture.h"
+#include "Magnum/GL/SparseTextureResidency.h"
+#include "Magnum/GL/StreamingBuffer.h"
+#include "Magnum/GL/TextureUploader.h"
 #endif
 
 #define DOXYGEN_ELLIPSIS(...) __VA_ARGS__
@@ -90,6 +103,63 @@
 using namespace Magnum;
 using namespace Magnum::Math::Literals;
 
+#ifndef MAGNUM_TARGET_GLES
+namespace Async {
+
+/* [AbstractShaderProgram-async] */
+class MyShader: public GL::AbstractShaderProgram {
+    public:
+        class CompileState;
+
+        static CompileState compile();
+
+        explicit MyShader(CompileState&& state);
+
+    private:
+        explicit MyShader(NoInitT) {}
+
+        Int _transformationMatrixUniform;
+};
+
+class MyShader::CompileState: public MyShader {
+    friend MyShader;
+
+    explicit CompileState(MyShader&& shader, GL::Shader&& vert,
+        GL::Shader&& frag): MyShader{std::move(shader)},
+        _vert{std::move(vert)}, _frag{std::move(frag)} {}
+
+    GL::Shader _vert, _frag;
+};
+
+MyShader::CompileState MyShader::compile() {
+    GL::Shader vert{GL::Version::GL430, GL::Shader::Type::Vertex};
+    GL::Shader frag{GL::Version::GL430, GL::Shader::Type::Fragment};
+    vert.addFile("MyShader.vert");
+    frag.addFile("MyShader.frag");
+    vert.submitCompile();
+    frag.submitCompile();
+
+    MyShader out{NoInit};
+    out.attachShaders({vert, frag});
+    out.submitLink();
+
+    return CompileState{std::move(out), std::move(vert), std::move(frag)};
+}
+
+MyShader::MyShader(CompileState&& state):
+    MyShader{static_cast<MyShader&&>(std::move(state))}
+{
+    CORRADE_INTERNAL_ASSERT_OUTPUT(state._vert.checkCompile() &&
+                                   state._frag.checkCompile());
+    CORRADE_INTERNAL_ASSERT_OUTPUT(checkLink());
+
+    _transformationMatrixUniform = uniformLocation("transformationMatrix");
+}
+/* [AbstractShaderProgram-async] */
+
+}
+#endif
+
 int main() {
 
 #ifndef MAGNUM_TARGET_GLES2
@@ -412,6 +482,26 @@ setTransformFeedbackOutputs({
         "gl_NextBuffer", "velocity"
     }, TransformFeedbackBufferMode::InterleavedAttributes);
 /* [AbstractShaderProgram-xfb-outputs] */
+
+{
+/* [AbstractShaderProgram-binary-cache] */
+/* Once at application startup */
+GL::AbstractShaderProgram::setBinaryCacheDirectory("shader-cache");
+
+/* In the shader constructor */
+GL::Shader vert{GL::Version::GL430, GL::Shader::Type::Vertex};
+GL::Shader frag{GL::Version::GL430, GL::Shader::Type::Fragment};
+vert.addFile("MyShader.vert");
+frag.addFile("MyShader.frag");
+
+if(!loadCachedBinary({vert, frag})) {
+    CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::compile({vert, frag}));
+    attachShaders({vert, frag});
+    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+    saveCachedBinary({vert, frag});
+}
+/* [AbstractShaderProgram-binary-cache] */
+}
 }
 };
 #endif
@@ -481,6 +571,154 @@ buffer.setStorage(data, {});
 }
 #endif
 
+{
+struct: GL::AbstractShaderProgram {} shader;
+GL::Mesh mesh;
+GL::Buffer transformations;
+Containers::ArrayView<const Matrix4> transformationData;
+/* [CommandRecorder-usage] */
+GL::CommandRecorder recorders[2];
+
+/* On each worker thread, recording into its own instance */
+GL::CommandRecorder& recorder = recorders[0];
+recorder
+    .setBufferSubData(transformations, 0, transformationData)
+    .draw(shader, mesh);
+
+/* On the context thread, once all workers are done */
+GL::CommandRecorder::replay({recorders[0], recorders[1]});
+/* [CommandRecorder-usage] */
+}
+
+{
+Shaders::FlatGL3D shader{NoCreate};
+GL::CommandRecorder recorder;
+/* [CommandRecorder-call] */
+Color4 color = DOXYGEN_ELLIPSIS({});
+recorder.call([&shader, color] {
+    shader.setColor(color);
+});
+/* [CommandRecorder-call] */
+}
+
+{
+struct: GL::AbstractShaderProgram {} opaqueShader, transparentShader;
+GL::Mesh mesh;
+GL::MeshView tree{mesh}, rock{mesh}, leaves{mesh};
+GL::Texture2D barkTexture, stoneTexture, leafTexture;
+/* [DrawList-usage] */
+GL::DrawList drawList;
+
+/* Once, for each material */
+UnsignedInt bark = drawList.addBindingSet(0, {&barkTexture});
+UnsignedInt stone = drawList.addBindingSet(0, {&stoneTexture});
+UnsignedInt leaf = drawList.addBindingSet(0, {&leafTexture});
+
+/* Transparent draws go to layer 1, which enables blending */
+drawList.setLayerCallback([](UnsignedInt layer, void*) {
+    GL::Renderer::setFeature(GL::Renderer::Feature::Blending, layer == 1);
+});
+
+/* Each frame, in any order */
+drawList
+    .add(opaqueShader, tree, bark)
+    .add(transparentShader, leaves, leaf, 1)
+    .add(opaqueShader, rock, stone)
+    DOXYGEN_ELLIPSIS();
+drawList.flush();
+/* [DrawList-usage] */
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+{
+struct Vertex {
+    Vector3 position;
+    Vector3 normal;
+};
+Containers::ArrayView<const Vertex> vertexData;
+Containers::ArrayView<const UnsignedShort> indexData;
+/* [BufferHeap-usage] */
+GL::BufferHeap vertices{GL::Buffer::TargetHint::Array, 16*1024*1024};
+GL::BufferHeap indices{GL::Buffer::TargetHint::ElementArray, 4*1024*1024};
+
+/* Allocations aligned to the vertex stride and index type size so the
+   offsets can be expressed in vertices and indices */
+UnsignedInt vertexId = vertices.allocate(vertexData, sizeof(Vertex));
+UnsignedInt indexId = indices.allocate(indexData, sizeof(UnsignedShort));
+
+/* One mesh for each combination of a vertex and an index block */
+GL::Mesh mesh;
+mesh.addVertexBuffer(vertices.blockBuffer(vertices.block(vertexId)), 0,
+        Shaders::PhongGL::Position{},
+        Shaders::PhongGL::Normal{})
+    .setIndexBuffer(indices.blockBuffer(indices.block(indexId)), 0,
+        GL::MeshIndexType::UnsignedShort);
+
+/* The base vertex and index range get updated on compaction */
+GL::MeshView view{mesh};
+view.setCount(indexData.size());
+vertices.attachVertices(vertexId, view, sizeof(Vertex));
+indices.attachIndices(indexId, view);
+
+/* Each frame, move at most 1 MB worth of data */
+vertices.compact(1024*1024);
+indices.compact(1024*1024);
+/* [BufferHeap-usage] */
+}
+#endif
+
+#ifndef MAGNUM_TARGET_GLES
+{
+struct TransformationUniform {
+    Matrix4 transformationMatrix;
+};
+struct: GL::AbstractShaderProgram {} shader;
+GL::Mesh mesh;
+Containers::ArrayView<const Matrix4> transformations;
+/* [StreamingBuffer-usage] */
+/* Space for a few frames worth of uniforms */
+GL::StreamingBuffer uniforms{4*65536,
+    std::size_t(GL::Buffer::uniformOffsetAlignment())};
+
+DOXYGEN_ELLIPSIS()
+
+/* Each frame */
+for(const Matrix4& transformation: transformations) {
+    Containers::ArrayView<char> data = uniforms.allocate(sizeof(TransformationUniform));
+    Containers::arrayCast<TransformationUniform>(data)[0].transformationMatrix = transformation;
+    uniforms.bind(GL::Buffer::Target::Uniform, 0, data);
+    shader.draw(mesh);
+}
+uniforms.fence();
+/* [StreamingBuffer-usage] */
+}
+#endif
+
+#ifndef MAGNUM_TARGET_GLES
+{
+GL::Texture2D texture;
+ImageView2D tile{PixelFormat::RGBA8Unorm, {256, 256}};
+/* [TextureUploader-usage] */
+/* Sixteen slots for 256x256 RGBA tiles */
+GL::TextureUploader uploader{256*256*4, 16};
+
+/* On a worker thread, once the tile is decoded */
+Containers::Optional<UnsignedLong> upload =
+    uploader.stage(texture, 0, {512, 768}, tile);
+if(!upload) {
+    DOXYGEN_ELLIPSIS() /* No free slot, try again later */
+}
+
+/* On the GL thread, each frame */
+uploader.update();
+DOXYGEN_ELLIPSIS()
+if(uploader.isComplete(*upload)) {
+    DOXYGEN_ELLIPSIS() /* The tile can be used for rendering */
+}
+/* [TextureUploader-usage] */
+}
+#endif
+
 {
 GL::Buffer buffer;
 /* [Buffer-setdata-allocate] */
@@ -601,6 +839,35 @@ buffer.setData(data, GL::BufferUsage::StaticDraw);
 }
 #endif
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+{
+GL::AbstractShaderProgram& simulate = *static_cast<GL::AbstractShaderProgram*>(nullptr);
+GL::AbstractShaderProgram& integrate = *static_cast<GL::AbstractShaderProgram*>(nullptr);
+GL::AbstractShaderProgram& shader = *static_cast<GL::AbstractShaderProgram*>(nullptr);
+GL::Mesh mesh;
+UnsignedInt particleCount{};
+/* [ComputePass-usage] */
+GL::Buffer particles, forces;
+
+const Vector3ui workgroupCount =
+    GL::ComputePass::workgroupCount({particleCount, 1, 1}, {64, 1, 1});
+
+GL::ComputePass pass;
+pass.bindStorageBuffer(0, particles, GL::ComputeAccess::Read)
+    .bindStorageBuffer(1, forces, GL::ComputeAccess::Write)
+    .dispatch(simulate, workgroupCount)
+    /* Reads forces written above, a shader storage barrier is issued */
+    .bindStorageBuffer(1, forces, GL::ComputeAccess::Read)
+    .bindStorageBuffer(0, particles, GL::ComputeAccess::ReadWrite)
+    .dispatch(integrate, workgroupCount)
+    /* Particle positions are used as vertex data next */
+    .barrier(particles, GL::Renderer::MemoryBarrier::VertexAttributeArray);
+
+shader.draw(mesh);
+/* [ComputePass-usage] */
+}
+#endif
+
 #ifndef MAGNUM_TARGET_GLES
 {
 /* [Context-supportedVersion] */
@@ -1008,6 +1275,28 @@ GL::Framebuffer::blit(framebuffer, GL::defaultFramebuffer,
 }
 #endif
 
+#ifndef MAGNUM_TARGET_GLES2
+{
+GL::Framebuffer framebuffer{{}};
+/* [RenderPass-usage] */
+/* Color is cleared and kept, depth and stencil are only needed while
+   rendering and never written back to memory */
+GL::RenderPass pass{framebuffer};
+pass.setColorAttachment(0, GL::RenderPassLoad::Clear,
+        GL::RenderPassStore::Store, 0x1f1f1f_rgbf)
+    .setDepthAttachment(GL::RenderPassLoad::Clear,
+        GL::RenderPassStore::DontCare)
+    .setStencilAttachment(GL::RenderPassLoad::Clear,
+        GL::RenderPassStore::DontCare);
+
+/* Every frame */
+pass.begin();
+// draw to the framebuffer ...
+pass.end();
+/* [RenderPass-usage] */
+}
+#endif
+
 #ifndef MAGNUM_TARGET_GLES2
 {
 struct MyShader {
@@ -1039,6 +1328,26 @@ framebuffer.mapForDraw({
 }
 #endif
 
+{
+/* [MemoryUsage-usage] */
+/* Enable as early as possible, objects created before aren't tracked */
+GL::MemoryUsage::setTrackingEnabled(true);
+
+// create buffers, textures, renderbuffers...
+
+Debug{} << "Total:" << GL::MemoryUsage::total() << "bytes, of which"
+    << GL::MemoryUsage::total(GL::MemoryUsageCategory::Texture)
+    << "in" << GL::MemoryUsage::objectCount(GL::MemoryUsageCategory::Texture)
+    << "textures";
+
+/* Ten largest objects */
+Containers::Array<GL::MemoryUsageEntry> entries = GL::MemoryUsage::entries();
+for(std::size_t i = 0; i != Math::min(entries.size(), std::size_t{10}); ++i)
+    Debug{} << entries[i].category << entries[i].id << entries[i].label
+        << entries[i].size;
+/* [MemoryUsage-usage] */
+}
+
 {
 /* [Mesh-vertices] */
 const Vector3 positions[]{
@@ -1349,6 +1658,36 @@ GL::Renderer::setBlendFunction(
 /* [Renderer-setBlendFunction] */
 }
 
+{
+/* [RenderStates-usage] */
+/* Created once, upfront */
+const GL::DepthStencilState opaqueDepth = GL::DepthStencilState{}
+    .setDepthTestEnabled(true);
+const GL::DepthStencilState transparentDepth = GL::DepthStencilState{}
+    .setDepthTestEnabled(true)
+    .setDepthWriteEnabled(false);
+const GL::BlendState opaqueBlend;
+const GL::BlendState transparentBlend = GL::BlendState{}
+    .setEnabled(true)
+    .setFunction(GL::Renderer::BlendFunction::One,
+                 GL::Renderer::BlendFunction::OneMinusSourceAlpha);
+const GL::RasterState raster = GL::RasterState{}
+    .setFaceCullingEnabled(true);
+
+/* Opaque pass */
+GL::Renderer::apply(opaqueDepth);
+GL::Renderer::apply(opaqueBlend);
+GL::Renderer::apply(raster);
+DOXYGEN_ELLIPSIS()
+
+/* Transparent pass, only the depth mask and blending gets changed */
+GL::Renderer::apply(transparentDepth);
+GL::Renderer::apply(transparentBlend);
+GL::Renderer::apply(raster);
+DOXYGEN_ELLIPSIS()
+/* [RenderStates-usage] */
+}
+
 #if !(defined(MAGNUM_TARGET_GLES2) && defined(MAGNUM_TARGET_WEBGL))
 {
 /* [SampleQuery-usage] */
@@ -1401,6 +1740,20 @@ texture.setMagnificationFilter(GL::SamplerFilter::Linear)
     .generateMipmap();
 /* [Texture-usage] */
 }
+
+{
+char data[1]{};
+/* [Texture-setSubImages] */
+/* Mip levels imported from a file, for example */
+ImageView2D level0{PixelFormat::RGBA8Unorm, {512, 512}, DOXYGEN_ELLIPSIS(data)};
+ImageView2D level1{PixelFormat::RGBA8Unorm, {256, 256}, DOXYGEN_ELLIPSIS(data)};
+ImageView2D level2{PixelFormat::RGBA8Unorm, {128, 128}, DOXYGEN_ELLIPSIS(data)};
+
+GL::Texture2D texture;
+texture.setStorage(3, GL::TextureFormat::RGBA8, {512, 512})
+    .setSubImages(0, {level0, level1, level2});
+/* [Texture-setSubImages] */
+}
 #endif
 
 #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
@@ -1413,6 +1766,55 @@ texture.setSwizzle<'b', 'g', 'r', '0'>();
 #endif
 
 #ifndef MAGNUM_TARGET_GLES
+{
+GL::Texture2D texture;
+GL::Buffer materialBuffer;
+/* [Texture-bindless] */
+UnsignedLong handle = texture.handle();
+GL::Texture2D::makeHandleResident(handle);
+
+// Upload the handle to a uniform buffer, where it's accessed as an uvec2
+materialBuffer.setSubData(0, {handle});
+
+// ... draw
+
+GL::Texture2D::makeHandleNonResident(handle);
+/* [Texture-bindless] */
+}
+
+{
+/* [Texture-sparse] */
+Vector2i pageSize = GL::Texture2D::virtualPageSize(GL::TextureFormat::RGBA8);
+
+GL::Texture2D texture;
+texture.setSparse(true)
+    .setStorage(1, GL::TextureFormat::RGBA8, {65536, 65536});
+
+/* Allocate memory for the top left page and upload data to it */
+ImageView2D page = DOXYGEN_ELLIPSIS(ImageView2D{PixelFormat::RGBA8Unorm, pageSize});
+texture.commitPages(0, {{}, pageSize})
+    .setSubImage(0, {}, page);
+/* [Texture-sparse] */
+}
+
+{
+GL::Texture2D texture;
+Vector2i size, pageSize;
+Int levelCount{};
+auto pagesVisibleThisFrame = []() { return Containers::Array<Vector3i>{}; };
+/* [SparseTextureResidency-usage] */
+GL::SparseTextureResidency residency{size, pageSize, levelCount, 8};
+
+/* Each frame, mark pages that were found visible, for example by reading back
+   a feedback framebuffer with page X, Y and mip level in each pixel */
+for(const Vector3i& page: pagesVisibleThisFrame())
+    residency.request(page.z(), page.xy());
+
+/* Commit newly needed pages, uncommit pages unused for more than 8 frames */
+residency.update(texture);
+/* [SparseTextureResidency-usage] */
+}
+
 {
 GL::Texture2D texture;
 /* [Texture-image1] */
@@ -1478,6 +1880,40 @@ GL::CompressedBufferImage2D image = texture.compressedSubImage(0, range, {},
 }
 #endif
 
+#ifndef MAGNUM_TARGET_GLES2
+{
+Vector2 projectedSize;
+struct Assets {
+    GL::Texture2D& texture(UnsignedInt) { return *_texture; }
+    ImageView2D loadLevel(UnsignedInt, Int) {
+        return ImageView2D{PixelFormat::RGBA8Unorm, {}};
+    }
+    GL::Texture2D* _texture;
+};
+/* [TextureStreamer-usage] */
+/* At most 512 MB of texture data */
+GL::TextureStreamer streamer{512*1024*1024};
+
+/* Storage for the full mip chain, only levels 16x16 and smaller uploaded */
+GL::Texture2D texture;
+Assets assets{&texture};
+texture.setStorage(13, GL::TextureFormat::RGBA8, {4096, 4096});
+UnsignedInt id = streamer.add(texture, {4096, 4096}, 13, 32, 5);
+for(Int level = 8; level != 13; ++level)
+    texture.setSubImage(level, {}, assets.loadLevel(id, level));
+
+/* While drawing, request a level based on the on-screen size */
+streamer.request(id, projectedSize);
+
+/* At the end of each frame, upload the levels that are needed */
+streamer.update([](UnsignedInt id, Int level, void* userData) {
+    Assets& assets = *static_cast<Assets*>(userData);
+    assets.texture(id).setSubImage(level, {}, assets.loadLevel(id, level));
+}, &assets);
+/* [TextureStreamer-usage] */
+}
+#endif
+
 #ifndef MAGNUM_TARGET_GLES2
 {
 /* [TextureArray-usage1] */
@@ -1609,4 +2045,25 @@ static_cast<void>(timeElapsed2);
 }
 #endif
 
+{
+/* [TimerQueryPool-usage] */
+GL::TimerQueryPool pool{3};
+
+// in every frame
+pool.beginFrame();
+pool.begin("shadows");
+// render shadow maps...
+pool.end();
+pool.begin("lighting");
+// render the lighting pass...
+pool.end();
+pool.endFrame();
+
+// results of some earlier frame, if they're ready already
+if(pool.hasResults())
+    Debug{} << "Shadows in frame" << pool.resultFrame() << "took"
+        << *pool.duration("shadows")/1.0e6 << "ms";
+/* [TimerQueryPool-usage] */
+}
+
 }
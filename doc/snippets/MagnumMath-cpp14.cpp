@@ -24,6 +24,7 @@
 */
 
 #include "Magnum/Math/BitVector.h"
+#include "Magnum/Math/Matrix4.h"
 #include "Magnum/Magnum.h"
 
 using namespace Magnum;
@@ -48,4 +49,17 @@ Debug{} << BitVector4{0b1010}
         << Math::BitVector<19>{0b00001000, 0b00000011, 0b100};
 /* [BitVector-debug] */
 }
+
+{
+/* [MAGNUM_CONSTEXPR14] */
+/* Calculated at compile time with C++14 and newer */
+constexpr Matrix4 projection = Matrix4::perspectiveProjection(
+    Vector2{16.0f, 9.0f}, 1.0f, 100.0f);
+constexpr Matrix4 transformation =
+    Matrix4::translation({0.0f, 0.0f, -5.0f})*Matrix4::scaling(Vector3{2.0f});
+constexpr Matrix4 transformationProjection = projection*transformation;
+constexpr Matrix4 inverse = transformationProjection.inverted();
+/* [MAGNUM_CONSTEXPR14] */
+static_cast<void>(inverse);
+}
 }
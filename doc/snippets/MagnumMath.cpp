@@ -25,6 +25,9 @@
 
 #include <map>
 #include <set>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/BitArray.h>
+#include <Corrade/Containers/BitArrayView.h>
 
 #include "Magnum/Magnum.h"
 #include "Magnum/Math/Color.h"
@@ -36,10 +39,13 @@
 #include "Magnum/Math/DualQuaternion.h"
 #include "Magnum/Math/Frustum.h"
 #include "Magnum/Math/Half.h"
+#include "Magnum/Math/IntersectionBatch.h"
+#include "Magnum/Math/QuaternionBatch.h"
 #include "Magnum/Math/Range.h"
 #include "Magnum/Math/Algorithms/GramSchmidt.h"
 #include "Magnum/Math/StrictWeakOrdering.h"
 #include "Magnum/Math/Swizzle.h"
+#include "Magnum/Math/Wide.h"
 
 #define DOXYGEN_ELLIPSIS(...) __VA_ARGS__
 
@@ -1029,6 +1035,25 @@ static_cast<void>(sinAngle);
 static_cast<void>(tanAngle);
 }
 
+{
+Vector3 centerData[10];
+Float radiusData[10];
+/* [Intersection-batch-plane-cache] */
+Containers::StridedArrayView1D<const Vector3> centers = DOXYGEN_ELLIPSIS(centerData);
+Containers::StridedArrayView1D<const Float> radii = DOXYGEN_ELLIPSIS(radiusData);
+
+/* Kept across frames, zero-initialized is a valid starting state */
+Containers::Array<UnsignedByte> planeCache{ValueInit, centers.size()};
+Containers::BitArray visible{ValueInit, centers.size()};
+
+/* Every frame */
+Frustum frustum = Frustum::fromMatrix(DOXYGEN_ELLIPSIS(Matrix4{}));
+std::size_t visibleCount = Math::Intersection::sphereFrustumInto(
+    centers, radii, frustum, visible, planeCache);
+/* [Intersection-batch-plane-cache] */
+static_cast<void>(visibleCount);
+}
+
 {
 Rad angle{};
 typedef Float T;
@@ -1040,6 +1065,28 @@ static_cast<void>(sinAngle);
 static_cast<void>(tanAngleSqPlusOne);
 }
 
+{
+Quaternion poseAData[10], poseBData[10];
+Vector3 translationData[10], scalingData[10];
+/* [QuaternionBatch-usage] */
+Containers::StridedArrayView1D<const Quaternion> poseA = DOXYGEN_ELLIPSIS(poseAData);
+Containers::StridedArrayView1D<const Quaternion> poseB = DOXYGEN_ELLIPSIS(poseBData);
+Containers::StridedArrayView1D<const Vector3> translations = DOXYGEN_ELLIPSIS(translationData);
+Containers::StridedArrayView1D<const Vector3> scalings = DOXYGEN_ELLIPSIS(scalingData);
+
+/* Blend two animation poses with the same phase for all joints */
+Float phase = DOXYGEN_ELLIPSIS(0.25f);
+Containers::Array<Quaternion> rotations{NoInit, poseA.size()};
+Math::slerpShortestPathInto(poseA, poseB,
+    Containers::stridedArrayView(&phase, 1).broadcasted<0>(poseA.size()),
+    rotations);
+
+/* Calculate joint matrices */
+Containers::Array<Matrix4> matrices{NoInit, poseA.size()};
+Math::transformationMatrixInto(translations, rotations, scalings, matrices);
+/* [QuaternionBatch-usage] */
+}
+
 {
 /* [Matrix-conversion] */
 Matrix2x2 floatingPoint{Vector2{1.3f, 2.7f}, Vector2{-15.0f, 7.0f}};
@@ -1297,4 +1344,36 @@ Matrix4::scaling(Vector3::xScale(-2.0f));
 /* [Vector3-xScale] */
 }
 
+{
+Vector3 positionData[10];
+Vector3 transformedData[10];
+/* [Wide-usage] */
+Containers::StridedArrayView1D<const Vector3> positions = DOXYGEN_ELLIPSIS(positionData);
+Containers::StridedArrayView1D<Vector3> transformed = DOXYGEN_ELLIPSIS(transformedData);
+Matrix4 transformation = DOXYGEN_ELLIPSIS({});
+
+/* Broadcast the matrix to all four lanes */
+const Math::Matrix4<Math::Wide4f> wideTransformation{transformation};
+
+/* Process four points at a time, the last batch may be smaller */
+for(std::size_t i = 0; i < positions.size(); i += 4) {
+    const std::size_t end = i + 4 < positions.size() ? i + 4 : positions.size();
+    const Math::Vector3<Math::Wide4f> points =
+        Math::loadWide<4>(positions.slice(i, end));
+    Math::storeWide(wideTransformation.transformPoint(points),
+        transformed.slice(i, end));
+}
+/* [Wide-usage] */
+}
+
+{
+Math::Wide4f distance;
+/* [Wide-select] */
+/* Equivalent to distance < 0.0f ? 0.0f : distance for each lane */
+const Math::Wide4f zero{0.0f};
+Math::Wide4f clamped = Math::select(distance < zero, zero, distance);
+/* [Wide-select] */
+static_cast<void>(clamped);
+}
+
 }
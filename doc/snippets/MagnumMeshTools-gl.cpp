@@ -24,10 +24,13 @@
 */
 
 #include <tuple> /* for std::tie() :( */
+#include <Corrade/Containers/Reference.h>
 #include <Corrade/Containers/StridedArrayView.h>
 
+#include "Magnum/GL/AbstractShaderProgram.h"
 #include "Magnum/GL/Buffer.h"
 #include "Magnum/GL/Mesh.h"
+#include "Magnum/GL/MeshView.h"
 #include "Magnum/Math/Vector3.h"
 #include "Magnum/MeshTools/Compile.h"
 #include "Magnum/MeshTools/CompressIndices.h"
@@ -74,6 +77,22 @@ mesh.addVertexBuffer(std::move(vertices),
 /* [compile-external-attributes] */
 }
 
+{
+Trade::MeshData rock{MeshPrimitive::Triangles, 5};
+Trade::MeshData tree{MeshPrimitive::Triangles, 5};
+Trade::MeshData house{MeshPrimitive::Triangles, 5};
+struct: GL::AbstractShaderProgram {} shader;
+/* [compileBatch] */
+GL::Mesh mesh{NoCreate};
+Containers::Array<GL::MeshView> views =
+    MeshTools::compileBatch(mesh, {rock, tree, house});
+
+/* Draw all three with a single multi-draw call */
+Containers::Reference<GL::MeshView> draws[]{views[0], views[1], views[2]};
+shader.draw(draws);
+/* [compileBatch] */
+}
+
 {
 /* [compressIndices] */
 Containers::Array<UnsignedInt> indices;
@@ -0,0 +1,62 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/MeshTools/CompileVk.h"
+#include "Magnum/Trade/MeshData.h"
+#include "Magnum/Vk/CommandBuffer.h"
+#include "Magnum/Vk/Device.h"
+#include "Magnum/Vk/DeviceProperties.h"
+#include "Magnum/Vk/MemoryAllocator.h"
+#include "Magnum/Vk/Mesh.h"
+#include "Magnum/Vk/Queue.h"
+#include "Magnum/Vk/UploadBatcher.h"
+
+#define DOXYGEN_ELLIPSIS(...) __VA_ARGS__
+
+using namespace Magnum;
+
+int main() {
+
+{
+Vk::Device device{NoCreate};
+Vk::Queue queue{NoCreate};
+Vk::CommandBuffer cmd{NoCreate};
+Trade::MeshData meshData{MeshPrimitive::Lines, 5};
+/* [compileVk] */
+Vk::MemoryAllocator allocator{device};
+Vk::UploadBatcher batcher{device, queue,
+    device.properties().pickQueueFamily(Vk::QueueFlag::Graphics), 16*1024*1024};
+
+Vk::Mesh mesh = MeshTools::compileVk(meshData, device, allocator, batcher);
+
+/* Submit the upload and wait until it's done before drawing */
+batcher.wait(batcher.flush());
+
+DOXYGEN_ELLIPSIS()
+cmd.draw(mesh);
+/* [compileVk] */
+}
+
+}
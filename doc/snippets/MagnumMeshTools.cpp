@@ -28,10 +28,14 @@
 
 #include "Magnum/Math/Color.h"
 #include "Magnum/Math/FunctionsBatch.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/MeshTools/BoundingVolume.h"
+#include "Magnum/MeshTools/Bvh.h"
 #include "Magnum/MeshTools/CompressIndices.h"
 #include "Magnum/MeshTools/Concatenate.h"
 #include "Magnum/MeshTools/Duplicate.h"
 #include "Magnum/MeshTools/FlipNormals.h"
+#include "Magnum/MeshTools/GenerateMeshlets.h"
 #include "Magnum/MeshTools/GenerateNormals.h"
 #include "Magnum/MeshTools/Interleave.h"
 #include "Magnum/MeshTools/RemoveDuplicates.h"
@@ -69,6 +73,21 @@ CORRADE_IGNORE_DEPRECATED_POP
 }
 #endif
 
+{
+/* [boundingRangesInto-meshlets] */
+Containers::StridedArrayView1D<const Vector3> positions;
+Containers::Array<MeshTools::Meshlet> meshlets;
+Containers::Array<UnsignedInt> meshletVertices;
+/* … */
+
+Containers::Array<Range3D> bounds{NoInit, meshlets.size()};
+MeshTools::boundingRangesInto(meshletVertices, positions,
+    stridedArrayView(meshlets).slice(&MeshTools::Meshlet::vertexOffset),
+    stridedArrayView(meshlets).slice(&MeshTools::Meshlet::vertexCount),
+    bounds);
+/* [boundingRangesInto-meshlets] */
+}
+
 {
 /* [compressIndices-offset] */
 Containers::ArrayView<const UnsignedInt> indices;
@@ -92,6 +111,22 @@ CORRADE_IGNORE_DEPRECATED_POP
 }
 #endif
 
+{
+/* [Concatenator] */
+Containers::ArrayView<const Trade::MeshData> props;
+UnsignedInt totalIndexCount{}, totalVertexCount{};
+
+/* The first mesh defines the layout of the output */
+MeshTools::Concatenator<> concatenator{props[0]};
+concatenator.reserve(totalIndexCount, totalVertexCount, props.size());
+for(const Trade::MeshData& prop: props)
+    concatenator.append(prop);
+
+Trade::MeshData batch = concatenator.finalize();
+/* [Concatenator] */
+static_cast<void>(batch);
+}
+
 {
 /* [generateFlatNormals] */
 Containers::ArrayView<UnsignedInt> indices;
@@ -105,6 +140,41 @@ Containers::Array<Vector3> normals =
 /* [generateFlatNormals] */
 }
 
+{
+/* [SmoothNormalsGenerator] */
+Containers::ArrayView<const UnsignedInt> indices;
+Containers::ArrayView<const Vector3> positions;
+
+/* Adjacency gets calculated just once */
+MeshTools::SmoothNormalsGenerator generator{indices, UnsignedInt(positions.size())};
+
+/* Then, every time the positions get updated, only the normals are
+   recalculated, reusing the same output memory */
+Containers::Array<Vector3> normals{NoInit, positions.size()};
+generator.generateInto(positions, normals);
+/* [SmoothNormalsGenerator] */
+}
+
+{
+Trade::MeshData mesh{MeshPrimitive::Triangles, 0};
+Vector3 rayOrigin, rayDirection;
+/* [Bvh] */
+/* Built once, afterwards the mesh data don't need to stay in scope */
+MeshTools::Bvh bvh{mesh};
+
+/* Pick the closest triangle under a ray */
+if(Containers::Optional<MeshTools::Bvh::RayHit> hit =
+    bvh.castRay(rayOrigin, rayDirection))
+{
+    Debug{} << "Hit triangle" << hit->triangle << "at distance" << hit->distance;
+}
+
+/* Collect all triangles within a unit distance from the ray origin */
+Containers::Array<UnsignedInt> triangles;
+bvh.querySphere(rayOrigin, 1.0f, triangles);
+/* [Bvh] */
+}
+
 {
 /* [interleave2] */
 Containers::ArrayView<const Vector4> positions;
@@ -24,11 +24,30 @@
 */
 
 #include <thread>
+#include <Corrade/Containers/StringView.h>
 #include <Magnum/Platform/WindowlessEglApplication.h>
 #include <Magnum/Platform/GLContext.h>
 
 using namespace Magnum;
 
+namespace {
+
+void renderThumbnail(Containers::StringView) {}
+
+}
+
+void pool(Containers::ArrayView<const Containers::StringView> files);
+void pool(Containers::ArrayView<const Containers::StringView> files) {
+/* [pool] */
+/* Two contexts on each of the available devices */
+Platform::WindowlessEglContextPool pool{{}, 2, {}};
+
+pool.run(files.size(), [&](std::size_t, std::size_t i) {
+    renderThumbnail(files[i]);
+});
+/* [pool] */
+}
+
 /* [thread] */
 int main() {
     Platform::WindowlessGLContext glContext{{}};
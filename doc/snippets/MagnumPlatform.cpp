@@ -25,6 +25,11 @@
 
 #define DOXYGEN_ELLIPSIS(...) __VA_ARGS__
 
+#include <Magnum/GL/Buffer.h>
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include <Magnum/Platform/GLWorker.h>
+#endif
+
 /* [windowed] */
 #include <Magnum/GL/DefaultFramebuffer.h>
 #include <Magnum/GL/Renderer.h>
@@ -223,3 +228,31 @@ MyApplication::MyApplication(const Arguments& arguments):
 /* [exit-from-constructor] */
 
 }
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+namespace H {
+
+void foo(Platform::Application& app, Containers::ArrayView<const Float> data);
+void foo(Platform::Application& app, Containers::ArrayView<const Float> data) {
+/* [GLWorker] */
+Platform::GLWorker<Platform::Application::SharedGLContext> worker{
+    Platform::Application::SharedGLContext{app}};
+
+GL::Buffer vertices{NoCreate};
+UnsignedLong upload = worker.submit([&vertices, data]() {
+    vertices = GL::Buffer{};
+    vertices.setData(data);
+});
+
+DOXYGEN_ELLIPSIS()
+
+/* Each frame, before drawing */
+worker.update();
+if(worker.isComplete(upload)) {
+    // vertices can be used on the main context now
+}
+/* [GLWorker] */
+}
+
+}
+#endif
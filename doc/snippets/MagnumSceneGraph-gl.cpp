@@ -40,6 +40,7 @@
 #include "Magnum/SceneGraph/Object.h"
 #include "Magnum/SceneGraph/Scene.h"
 #include "Magnum/Shaders/FlatGL.h"
+#include "Magnum/Shaders/InstanceBatcherGL.h"
 #include "Magnum/Shaders/PhongGL.h"
 #include "Magnum/Trade/MeshData.h"
 
@@ -215,6 +216,47 @@ void MyApplication::drawEvent() {
 
 }
 
+namespace C {
+
+struct MyApplication: Platform::Application {
+    explicit MyApplication(const Arguments& arguments);
+
+    void drawEvent() override;
+
+    SceneGraph::Camera3D* _camera;
+    SceneGraph::DrawableGroup3D _drawables;
+    Shaders::InstanceBatcherGL _batcher;
+};
+
+/* [InstanceBatcherGL-scenegraph] */
+class InstancedDrawable: public SceneGraph::Drawable3D {
+    public:
+        explicit InstancedDrawable(Object3D& object, Shaders::InstanceBatcherGL& batcher, Shaders::PhongGL& shader, GL::Mesh& mesh, UnsignedInt material, SceneGraph::DrawableGroup3D& drawables): SceneGraph::Drawable3D{object, &drawables}, _batcher(batcher), _shader(shader), _mesh(mesh), _material{material} {}
+
+    private:
+        void draw(const Matrix4& transformationMatrix, SceneGraph::Camera3D&) override {
+            /* Only records the draw, the actual drawing is done in flush() */
+            _batcher.add(_shader, _mesh, _material, transformationMatrix);
+        }
+
+        Shaders::InstanceBatcherGL& _batcher;
+        Shaders::PhongGL& _shader;
+        GL::Mesh& _mesh;
+        UnsignedInt _material;
+};
+
+// ...
+
+void MyApplication::drawEvent() {
+    _camera->draw(_drawables);
+    _batcher.flush(_camera->projectionMatrix());
+
+    // ...
+}
+/* [InstanceBatcherGL-scenegraph] */
+
+}
+
 int main() {
 /* [Drawable-usage-instance] */
 Scene3D scene;
@@ -35,8 +35,13 @@
 #include "Magnum/SceneGraph/MatrixTransformation3D.h"
 #include "Magnum/SceneGraph/Camera.h"
 #include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/SceneGraph/LevelOfDetail.h"
 #include "Magnum/SceneGraph/Object.h"
+#include "Magnum/SceneGraph/RenderQueue.h"
 #include "Magnum/SceneGraph/Scene.h"
+#include "Magnum/SceneGraph/SpatialBounds.h"
+#include "Magnum/SceneGraph/SpatialIndex.h"
+#include "Magnum/SceneGraph/TransformationCache.h"
 
 #define DOXYGEN_ELLIPSIS(...) __VA_ARGS__
 
@@ -101,6 +106,29 @@ class AnimableObject: public Object3D, public SceneGraph::Animable3D {
 };
 /* [Animable-usage-definition] */
 
+/* [Animable-parallel] */
+class SpinningObject: public Object3D, public SceneGraph::Animable3D {
+    public:
+        SpinningObject(Object3D* parent, SceneGraph::AnimableGroup3D* group): Object3D{parent}, SceneGraph::Animable3D{*this, group} {
+            setThreadSafe(true);
+        }
+
+    private:
+        /* Called on a worker thread, touches only own data */
+        void animationStep(Float time, Float) override {
+            _rotation = Matrix4::rotationY(15.0_degf*time);
+        }
+
+        /* Called on the calling thread afterwards */
+        void animationCommit() override {
+            setTransformation(_rotation);
+        }
+
+        Matrix4 _rotation;
+};
+
+/* [Animable-parallel] */
+
 /* [typedef] */
 typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
 typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
@@ -143,6 +171,31 @@ class CachingObject: public Object3D, SceneGraph::AbstractFeature3D {
 };
 /* [caching] */
 
+/* [RenderQueue-enqueue] */
+class Window: public SceneGraph::Drawable3D {
+    public:
+        explicit Window(Object3D& object, SceneGraph::DrawableGroup3D& group):
+            SceneGraph::Drawable3D{object, &group} {}
+
+    private:
+        /* The frame is opaque, the glass is transparent */
+        void enqueue(SceneGraph::RenderQueue3D& queue, const Matrix4& transformationMatrix) override {
+            queue.add(SceneGraph::RenderQueuePass::Opaque, *this, transformationMatrix, 0, 0);
+            queue.add(SceneGraph::RenderQueuePass::Transparent, *this, transformationMatrix, 0, 1);
+        }
+
+        void drawQueued(const Matrix4& transformationMatrix, SceneGraph::Camera3D& camera, UnsignedInt payload) override {
+            if(payload == 0) {
+                DOXYGEN_ELLIPSIS(static_cast<void>(transformationMatrix); static_cast<void>(camera);) // draw the frame
+            } else {
+                DOXYGEN_ELLIPSIS() // draw the glass
+            }
+        }
+
+        void draw(const Matrix4&, SceneGraph::Camera3D&) override {}
+};
+/* [RenderQueue-enqueue] */
+
 namespace {
 
 /* [transformation] */
@@ -385,4 +438,129 @@ camera.draw(drawableTransformations);
 /* [Drawable-culling] */
 }
 
+{
+Object3D cameraObject;
+SceneGraph::Camera3D camera{cameraObject};
+SceneGraph::DrawableGroup3D drawableGroup;
+SceneGraph::Drawable3D* drawable{};
+/* [Drawable-frustum-culling] */
+/* The mesh fits into a unit sphere around the object origin */
+drawable->setBoundingSphere({}, 1.0f);
+
+DOXYGEN_ELLIPSIS()
+
+/* Drawables that are outside of the view get skipped */
+camera.setFrustumCulling(true);
+camera.draw(drawableGroup);
+/* [Drawable-frustum-culling] */
+}
+
+{
+Scene3D scene;
+Object3D* object{};
+std::size_t objectId{};
+/* [TransformationCache-usage] */
+SceneGraph::TransformationCache<SceneGraph::MatrixTransformation3D> cache{scene};
+
+/* Each frame, mark changed objects as dirty and update */
+object->rotateY(15.0_degf);
+cache.setDirty(objectId)
+     .update();
+
+/* Absolute transformations of all objects, in the same order as objects() */
+for(std::size_t i = 0; i != cache.size(); ++i) {
+    Matrix4 transformation = cache.absoluteTransformations()[i];
+    DOXYGEN_ELLIPSIS(static_cast<void>(transformation);)
+}
+/* [TransformationCache-usage] */
+}
+
+{
+Scene3D scene;
+SceneGraph::Camera3D* camera{};
+/* [SpatialIndex-usage] */
+SceneGraph::SpatialIndex3D index;
+
+/* Objects with a unit cube mesh */
+Object3D* object = new Object3D{&scene};
+new SceneGraph::SpatialBounds3D{*object, Range3D{Vector3{-1.0f}, Vector3{1.0f}}, &index};
+
+DOXYGEN_ELLIPSIS()
+
+/* Objects visible by the camera, the index updates itself implicitly */
+std::vector<std::reference_wrapper<SceneGraph::SpatialBounds3D>> visible =
+    index.queryFrustum(Frustum::fromMatrix(camera->projectionMatrix()*camera->cameraMatrix()));
+/* [SpatialIndex-usage] */
+}
+
+{
+SceneGraph::AnimableGroup3D animables;
+Float time{}, delta{};
+/* [Animable-parallel-step] */
+/* Use all available cores */
+animables.step(time, delta, 0);
+/* [Animable-parallel-step] */
+}
+
+{
+Object3D cameraObject;
+SceneGraph::Camera3D camera{cameraObject};
+SceneGraph::DrawableGroup3D drawables;
+/* [RenderQueue-usage] */
+SceneGraph::RenderQueue3D queue;
+
+/* Each frame, sort the drawables and draw them */
+queue.build(camera, drawables)
+     .draw(camera);
+/* [RenderQueue-usage] */
+}
+
+{
+Scene3D scene;
+/* [LevelOfDetail-usage] */
+SceneGraph::LevelOfDetailGroup3D lods;
+
+/* A building with three levels generated by a mesh simplifier, fitting into
+   a sphere with a radius of 15 units */
+Object3D* building = new Object3D{&scene};
+(new SceneGraph::LevelOfDetail3D{*building, &lods})
+    ->setBoundingSphere(Vector3::yAxis(10.0f), 15.0f)
+     .addLevel(0.25f, 120000)   /* at least a quarter of the viewport height */
+     .addLevel(0.05f, 12000)
+     .addLevel(0.0f, 600);      /* everything smaller */
+/* [LevelOfDetail-usage] */
+}
+
+{
+Object3D cameraObject;
+SceneGraph::Camera3D camera{cameraObject};
+SceneGraph::DrawableGroup3D drawables;
+SceneGraph::LevelOfDetailGroup3D lods;
+/* [LevelOfDetail-draw] */
+class LodDrawable: public SceneGraph::Drawable3D {
+    public:
+        explicit LodDrawable(Object3D& object, SceneGraph::LevelOfDetail3D& lod, SceneGraph::DrawableGroup3D& drawables): SceneGraph::Drawable3D{object, &drawables}, _lod(lod) {}
+
+    private:
+        void draw(const Matrix4& transformationMatrix, SceneGraph::Camera3D& camera) override {
+            /* Too small to be drawn */
+            if(_lod.level() == _lod.levelCount()) return;
+
+            /* Draw a mesh corresponding to _lod.level() */
+            DOXYGEN_ELLIPSIS(static_cast<void>(transformationMatrix); static_cast<void>(camera);)
+        }
+
+        SceneGraph::LevelOfDetail3D& _lod;
+};
+
+DOXYGEN_ELLIPSIS()
+
+/* Each frame, pick the levels for all objects and draw */
+lods.setHysteresis(0.1f)
+    .setTriangleBudget(2000000);
+lods.select(camera);
+camera.draw(drawables);
+/* [LevelOfDetail-draw] */
+}
+
 }
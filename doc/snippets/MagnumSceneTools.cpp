@@ -24,15 +24,27 @@
 */
 
 #include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/BitArray.h>
 #include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Containers/Triple.h>
 
+#include "Magnum/Animation/Player.h"
 #include "Magnum/Math/Matrix3.h"
 #include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Math/Packing.h"
+#include "Magnum/Math/Quaternion.h"
+#include "Magnum/Math/Vector3.h"
 #include "Magnum/MeshTools/Transform.h"
+#include "Magnum/SceneTools/BindAnimation.h"
+#include "Magnum/SceneTools/CompressAnimation.h"
+#include "Magnum/SceneTools/FlatScene.h"
 #include "Magnum/SceneTools/FlattenMeshHierarchy.h"
 #include "Magnum/SceneTools/OrderClusterParents.h"
+#include "Magnum/SceneTools/SceneBuilder.h"
+#include "Magnum/Trade/AnimationData.h"
 #include "Magnum/Trade/SceneData.h"
 #include "Magnum/Trade/MeshData.h"
 
@@ -98,4 +110,92 @@ for(const Containers::Pair<UnsignedInt, Int>& parent:
 }
 /* [orderClusterParents-transformations] */
 }
+
+{
+/* [quantizeRangeInto] */
+Containers::ArrayView<const Vector3> translations = DOXYGEN_ELLIPSIS({});
+
+Containers::Array<Vector3us> quantized{NoInit, translations.size()};
+Range3D range = SceneTools::quantizeRangeInto(translations, quantized);
+
+/* Reconstruct the original value */
+Vector3 translation = Math::lerp(range.min(), range.max(),
+    Math::unpack<Vector3>(quantized[0]));
+/* [quantizeRangeInto] */
+static_cast<void>(translation);
+}
+
+{
+Matrix4 projectionMatrix, cameraMatrix;
+/* [FlatScene3D-usage] */
+Trade::SceneData scene = DOXYGEN_ELLIPSIS(Trade::SceneData{{}, 0, nullptr, {}});
+Containers::Array<Range3D> meshBounds = DOXYGEN_ELLIPSIS({});
+
+SceneTools::FlatScene3D flat{scene};
+Containers::BitArray visible{ValueInit, flat.drawCount()};
+Containers::Array<UnsignedInt> drawList{NoInit, flat.drawCount()};
+
+/* Each frame, animate, update the transformations and cull */
+flat.localTransformations()[0] = DOXYGEN_ELLIPSIS(Matrix4{});
+flat.update()
+    .cull(projectionMatrix*cameraMatrix, meshBounds, visible);
+
+/* Draw the visible meshes, ordered by the mesh ID */
+const std::size_t count = flat.drawListInto(visible, drawList);
+for(UnsignedInt draw: drawList.prefix(count)) {
+    UnsignedInt mesh = flat.drawMeshes()[draw];
+    Int material = flat.drawMaterials()[draw];
+    Matrix4 transformation = flat.absoluteTransformations()[flat.drawObjects()[draw]];
+    DOXYGEN_ELLIPSIS(static_cast<void>(mesh); static_cast<void>(material); static_cast<void>(transformation);)
+}
+/* [FlatScene3D-usage] */
+}
+
+{
+/* [SceneBuilder-usage] */
+Trade::SceneData scene = DOXYGEN_ELLIPSIS(Trade::SceneData{{}, 0, nullptr, {}});
+SceneTools::SceneBuilder builder{scene};
+
+/* Move an object, reparent another and add a new one with a mesh */
+builder.setFieldValue(Trade::SceneField::Translation, 3, Vector3{0.0f, 1.5f, 0.0f});
+builder.setFieldValue(Trade::SceneField::Parent, 7, Int{3});
+UnsignedLong object = builder.addObject();
+builder
+    .setFieldValue(Trade::SceneField::Parent, object, Int{-1})
+    .addFieldValue(Trade::SceneField::Mesh, object, UnsignedInt{2});
+
+/* Remove an object, including all its entries */
+builder.removeObject(5);
+
+/* Create a new immutable scene for an exporter */
+Trade::SceneData edited = builder.toSceneData();
+/* [SceneBuilder-usage] */
+static_cast<void>(edited);
+}
+
+{
+Float time{};
+/* [bindAnimation3D] */
+Trade::SceneData scene = DOXYGEN_ELLIPSIS(Trade::SceneData{{}, 0, nullptr, {}});
+Trade::AnimationData animation = DOXYGEN_ELLIPSIS(Trade::AnimationData{nullptr, nullptr});
+
+/* One TRS entry for each object in the scene */
+Containers::Array<Vector3> translations{ValueInit, std::size_t(scene.mappingBound())};
+Containers::Array<Quaternion> rotations{ValueInit, std::size_t(scene.mappingBound())};
+Containers::Array<Vector3> scalings{DirectInit, std::size_t(scene.mappingBound()), 1.0f};
+
+Animation::Player<Float> player;
+SceneTools::bindAnimation3D(player, animation, translations, rotations, scalings);
+player.play(time);
+
+/* Each frame, advance the animation and combine the TRS entries, for example
+   into SceneTools::FlatScene3D::localTransformations() */
+player.advance(time);
+for(std::size_t i = 0; i != scene.mappingBound(); ++i) {
+    Matrix4 transformation = Matrix4::from(rotations[i].toMatrix(), translations[i])*
+        Matrix4::scaling(scalings[i]);
+    DOXYGEN_ELLIPSIS(static_cast<void>(transformation);)
+}
+/* [bindAnimation3D] */
+}
 }
@@ -35,6 +35,8 @@
 
 #include "Magnum/FileCallback.h"
 #include "Magnum/ShaderTools/AbstractConverter.h"
+#include "Magnum/ShaderTools/CachingConverter.h"
+#include "Magnum/ShaderTools/Spirv.h"
 #include "Magnum/ShaderTools/Stage.h"
 
 #define DOXYGEN_ELLIPSIS(...) __VA_ARGS__
@@ -157,4 +159,55 @@ converter->setInputFileCallback([](const std::string& filename,
 /* [AbstractConverter-setInputFileCallback-template] */
 }
 
+{
+PluginManager::Manager<ShaderTools::AbstractConverter> manager;
+/* [CachingConverter-usage] */
+ShaderTools::CachingConverter converter{
+    manager.loadAndInstantiate("GlslToSpirvShaderConverter"), "shader-cache"};
+converter.setMaxSize(64*1024*1024);
+
+/* Set the state on the wrapper and not on the wrapped converter so it becomes
+   a part of the cache key */
+converter.setDefinitions({
+    {"TEXTURED", ""}
+});
+converter.setOptimizationLevel("1");
+
+/* Compiles the shader on first run, subsequent runs load the cached result as
+   long as neither the file nor anything it includes changes */
+Containers::Optional<Containers::Array<char>> spirv =
+    converter.convertFileToData(ShaderTools::Stage::Fragment, "phong.frag");
+/* [CachingConverter-usage] */
+}
+
+{
+Containers::Pointer<ShaderTools::AbstractConverter> converter;
+Containers::Array<char> vert, frag;
+/* [specializeSpirv] */
+/* Link all stages into a single module, with feature toggles being
+   specialization constants instead of preprocessor defines */
+Containers::Optional<Containers::Array<char>> spirv = converter->linkDataToData({
+    {ShaderTools::Stage::Vertex, vert},
+    {ShaderTools::Stage::Fragment, frag}
+});
+
+/* Bake each used combination of the constants in and strip the dead code.
+   Different combinations can end up producing the same code, deduplicate
+   them to create fewer shader modules and pipelines. */
+Containers::Array<char> variants[4];
+Containers::ArrayView<const void> variantViews[4];
+for(UnsignedInt i = 0; i != 4; ++i) {
+    const Containers::Pair<UnsignedInt, UnsignedInt> specializations[]{
+        {0, i & 1}, /* TEXTURED */
+        {1, i >> 1} /* ALPHA_MASK */
+    };
+    variants[i] = *ShaderTools::specializeSpirv(*spirv, specializations);
+    variantViews[i] = variants[i];
+}
+Containers::Pair<Containers::Array<UnsignedInt>, std::size_t> unique =
+    ShaderTools::deduplicateSpirv(variantViews);
+/* [specializeSpirv] */
+static_cast<void>(unique);
+}
+
 }
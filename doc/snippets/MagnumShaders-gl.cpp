@@ -26,7 +26,10 @@
 #include <numeric>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/ArrayViewStl.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/String.h>
 #include <Corrade/Utility/FormatStl.h>
+#include <Corrade/Utility/Path.h>
 
 #include "Magnum/ImageView.h"
 #include "Magnum/PixelFormat.h"
@@ -38,6 +41,7 @@
 #include "Magnum/GL/MeshView.h"
 #include "Magnum/GL/Shader.h"
 #include "Magnum/GL/Renderbuffer.h"
+#include "Magnum/GL/Renderer.h"
 #include "Magnum/GL/RenderbufferFormat.h"
 #include "Magnum/GL/Texture.h"
 #include "Magnum/GL/TextureFormat.h"
@@ -47,24 +51,44 @@
 #include "Magnum/Math/Matrix4.h"
 #include "Magnum/Math/FunctionsBatch.h"
 #include "Magnum/MeshTools/Duplicate.h"
+#include "Magnum/MeshTools/FullScreenTriangle.h"
 #include "Magnum/Shaders/DistanceFieldVectorGL.h"
 #include "Magnum/Shaders/FlatGL.h"
+#include "Magnum/Shaders/InstanceBatcherGL.h"
 #include "Magnum/Shaders/MeshVisualizerGL.h"
 #include "Magnum/Shaders/PhongGL.h"
+#include "Magnum/Shaders/ShaderVariantCacheGL.h"
 #include "Magnum/Shaders/VectorGL.h"
 #include "Magnum/Shaders/VertexColorGL.h"
 #include "Magnum/Trade/LightData.h"
+#include "Magnum/Trade/PbrMetallicRoughnessMaterialData.h"
 
 #ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/GL/CubeMapTexture.h"
 #include "Magnum/GL/TextureArray.h"
 #include "Magnum/Shaders/DistanceFieldVector.h"
 #include "Magnum/Shaders/Flat.h"
 #include "Magnum/Shaders/Generic.h"
+#include "Magnum/Shaders/InstanceCulling.h"
+#include "Magnum/Shaders/LightCluster.h"
 #include "Magnum/Shaders/MeshVisualizer.h"
+#include "Magnum/Shaders/ParticleSystemGL.h"
+#include "Magnum/Shaders/Pbr.h"
+#include "Magnum/Shaders/PbrGL.h"
 #include "Magnum/Shaders/Phong.h"
+#include "Magnum/Shaders/ShadowCascade.h"
+#include "Magnum/Shaders/TransparencyResolveGL.h"
+#include "Magnum/Shaders/UniformBufferBatcherGL.h"
 #include "Magnum/Shaders/Vector.h"
 #endif
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include "Magnum/Shaders/DepthPyramidGL.h"
+#include "Magnum/Shaders/InstanceCullingGL.h"
+#include "Magnum/Shaders/LightClusterGL.h"
+#include "Magnum/Shaders/MeshVisualizerPrepassGL.h"
+#endif
+
 #define DOXYGEN_ELLIPSIS(...) __VA_ARGS__
 
 using namespace Magnum;
@@ -315,6 +339,22 @@ shader
 }
 #endif
 
+{
+/* [shaders-async] */
+Shaders::FlatGL3D::CompileState flatState =
+    Shaders::FlatGL3D::compile(Shaders::FlatGL3D::Flag::Textured);
+Shaders::PhongGL::CompileState phongState =
+    Shaders::PhongGL::compile(Shaders::PhongGL::Flag::DiffuseTexture, 2);
+
+while(!flatState.isLinkFinished() || !phongState.isLinkFinished()) {
+    // draw a loading screen, process events, ...
+}
+
+Shaders::FlatGL3D flat{std::move(flatState)};
+Shaders::PhongGL phong{std::move(phongState)};
+/* [shaders-async] */
+}
+
 {
 GL::Buffer vertices;
 GL::Mesh mesh;
@@ -540,6 +580,23 @@ mesh.setInstanceCount(Containers::arraySize(instanceData))
 /* [FlatGL-usage-instancing] */
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+{
+GL::Mesh mesh;
+Matrix3 transformationProjectionMatrix;
+/* [FlatGL-usage-skinning] */
+Containers::ArrayView<const Matrix3> jointMatrices = DOXYGEN_ELLIPSIS({});
+
+Shaders::FlatGL2D shader{Shaders::FlatGL2D::Configuration{}
+    .setJointCount(jointMatrices.size(), 4)};
+shader
+    .setJointMatrices(jointMatrices)
+    .setTransformationProjectionMatrix(transformationProjectionMatrix)
+    .draw(mesh);
+/* [FlatGL-usage-skinning] */
+}
+#endif
+
 #ifndef MAGNUM_TARGET_GLES2
 {
 GL::Mesh mesh;
@@ -569,6 +626,91 @@ shader
 }
 #endif
 
+#ifndef MAGNUM_TARGET_GLES
+{
+GL::Mesh mesh;
+GL::Buffer projectionTransformationUniform, textureTransformationUniform,
+    materialUniform, drawUniform;
+/* [FlatGL-bindless] */
+GL::Texture2D wood, marble;
+// ...
+
+/* Handles have to be made resident before any draw that references them */
+UnsignedLong woodHandle = wood.handle();
+UnsignedLong marbleHandle = marble.handle();
+GL::AbstractTexture::makeHandleResident(woodHandle);
+GL::AbstractTexture::makeHandleResident(marbleHandle);
+
+GL::Buffer materialTextureUniform;
+materialTextureUniform.setData({
+    Shaders::FlatMaterialTextureUniform{}
+        .setTextureHandle(woodHandle),
+    Shaders::FlatMaterialTextureUniform{}
+        .setTextureHandle(marbleHandle)
+});
+
+Shaders::FlatGL3D shader{
+    Shaders::FlatGL3D::Flag::MultiDraw|
+    Shaders::FlatGL3D::Flag::Textured|
+    Shaders::FlatGL3D::Flag::BindlessTextures, 2, 16};
+shader
+    .bindTransformationProjectionBuffer(projectionTransformationUniform)
+    .bindMaterialBuffer(materialUniform)
+    .bindMaterialTextureBuffer(materialTextureUniform)
+    .bindDrawBuffer(drawUniform);
+/* [FlatGL-bindless] */
+}
+#endif
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+{
+GL::Buffer projectionTransformationUniform, materialUniform, drawUniform;
+Containers::ArrayView<const Vector3> cubePositions, spherePositions;
+Containers::ArrayView<const UnsignedInt> cubeIndices, sphereIndices;
+/* [FlatGL-vertex-pulling] */
+/* Positions of both meshes in a single buffer, one after another */
+GL::Buffer positions;
+positions.setData({nullptr, (cubePositions.size() + spherePositions.size())*sizeof(Vector3)});
+positions.setSubData(0, cubePositions);
+positions.setSubData(cubePositions.size()*sizeof(Vector3), spherePositions);
+
+/* The vertex offset of each draw */
+GL::Buffer vertexPullingUniform;
+vertexPullingUniform.setData({
+    Shaders::VertexPullingUniform{}
+        .setPositionOffset(0),
+    Shaders::VertexPullingUniform{}
+        .setPositionOffset(cubePositions.size())
+});
+
+/* The mesh has no vertex attributes, just the indices of both meshes */
+GL::Buffer indices;
+indices.setData({nullptr, (cubeIndices.size() + sphereIndices.size())*sizeof(UnsignedInt)});
+indices.setSubData(0, cubeIndices);
+indices.setSubData(cubeIndices.size()*sizeof(UnsignedInt), sphereIndices);
+GL::Mesh mesh;
+mesh.setIndexBuffer(indices, 0, MeshIndexType::UnsignedInt);
+
+GL::MeshView cube{mesh}, sphere{mesh};
+cube.setCount(cubeIndices.size());
+sphere.setCount(sphereIndices.size())
+    .setIndexRange(cubeIndices.size());
+
+Shaders::FlatGL3D shader{Shaders::FlatGL3D::Configuration{}
+    .setFlags(Shaders::FlatGL3D::Flag::MultiDraw|
+              Shaders::FlatGL3D::Flag::VertexPulling)
+    .setDrawCount(2)};
+shader
+    .bindTransformationProjectionBuffer(projectionTransformationUniform)
+    .bindMaterialBuffer(materialUniform)
+    .bindDrawBuffer(drawUniform)
+    .bindVertexPullingBuffer(vertexPullingUniform)
+    .bindPositionStorageBuffer(positions)
+    .draw({cube, sphere});
+/* [FlatGL-vertex-pulling] */
+}
+#endif
+
 {
 struct: GL::AbstractShaderProgram {
 void foo() {
@@ -615,6 +757,298 @@ mesh.setInstanceCount(Containers::arraySize(instanceData))
 /* [PhongGL-usage-instancing] */
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+{
+GL::Mesh mesh;
+Matrix4 transformationMatrix, projectionMatrix;
+/* [PhongGL-usage-skinning] */
+/* Absolute joint transformations multiplied by inverse bind matrices */
+Containers::ArrayView<const Matrix4> jointMatrices = DOXYGEN_ELLIPSIS({});
+
+/* Mesh with two sets of four joint IDs and weights per vertex */
+Shaders::PhongGL shader{Shaders::PhongGL::Configuration{}
+    .setJointCount(jointMatrices.size(), 4, 4)};
+shader
+    .setJointMatrices(jointMatrices)
+    .setTransformationMatrix(transformationMatrix)
+    .setNormalMatrix(transformationMatrix.normalMatrix())
+    .setProjectionMatrix(projectionMatrix)
+    .draw(mesh);
+/* [PhongGL-usage-skinning] */
+}
+#endif
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+{
+GL::Mesh mesh;
+Matrix4 projectionMatrix;
+Vector2i viewportSize;
+Float near{}, far{};
+GL::Buffer projectionUniform, materialUniform, transformationUniform,
+    drawUniform;
+/* [LightClusterGL-usage] */
+/* Light positions are in camera space */
+Containers::Array<Shaders::PhongLightUniform> lights{DOXYGEN_ELLIPSIS(4096)};
+GL::Buffer lightBuffer{GL::Buffer::TargetHint::ShaderStorage, lights};
+
+const Vector3ui clusterCount{16, 9, 24};
+GL::Buffer lightClusterUniform{GL::Buffer::TargetHint::Uniform, {
+    Shaders::LightClusterUniform{}
+        .setInverseProjectionMatrix(projectionMatrix.inverted())
+        .setClusterCount(clusterCount)
+        .setLightCount(lights.size())
+        .setViewportSize(Vector2{viewportSize})
+        .setDepthRange(near, far)
+}};
+
+/* Output buffers with space for all clusters */
+Shaders::LightClusterGL lightCluster{128};
+GL::Buffer clusterLightRanges, clusterLightIndices;
+clusterLightRanges.setData({nullptr,
+    clusterCount.product()*2*sizeof(UnsignedInt)});
+clusterLightIndices.setData({nullptr,
+    clusterCount.product()*lightCluster.maxLightsPerCluster()*sizeof(UnsignedInt)});
+
+/* Assign lights to clusters and wait for the results before drawing */
+lightCluster
+    .bindLightClusterBuffer(lightClusterUniform)
+    .bindLightBuffer(lightBuffer)
+    .bindClusterLightRangeBuffer(clusterLightRanges)
+    .bindClusterLightIndexBuffer(clusterLightIndices)
+    .dispatch(clusterCount);
+GL::Renderer::setMemoryBarrier(GL::Renderer::MemoryBarrier::ShaderStorage);
+
+Shaders::PhongGL shader{Shaders::PhongGL::Flag::LightClusters,
+    UnsignedInt(lights.size())};
+shader
+    .bindLightClusterBuffer(lightClusterUniform)
+    .bindLightBuffer(lightBuffer)
+    .bindClusterLightRangeBuffer(clusterLightRanges)
+    .bindClusterLightIndexBuffer(clusterLightIndices)
+    .bindProjectionBuffer(projectionUniform)
+    .bindMaterialBuffer(materialUniform)
+    .bindTransformationBuffer(transformationUniform)
+    .bindDrawBuffer(drawUniform)
+    .draw(mesh);
+/* [LightClusterGL-usage] */
+}
+#endif
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+{
+GL::Mesh mesh;
+Matrix4 projectionMatrix, cameraMatrix;
+Float meshRadius{};
+/* [InstanceCullingGL-usage] */
+/* Instance transformations, sixteen floats each */
+Containers::Array<Matrix4> instances{DOXYGEN_ELLIPSIS(1000000)};
+GL::Buffer inputInstances{GL::Buffer::TargetHint::ShaderStorage, instances};
+GL::Buffer outputInstances;
+outputInstances.setData({nullptr, instances.size()*sizeof(Matrix4)});
+
+GL::Buffer instanceCullingUniform{GL::Buffer::TargetHint::Uniform, {
+    Shaders::InstanceCullingUniform{}
+        .setFrustum(Frustum::fromMatrix(projectionMatrix*cameraMatrix))
+}};
+GL::Buffer drawUniform{GL::Buffer::TargetHint::ShaderStorage, {
+    Shaders::InstanceCullingDrawUniform{}
+        .setBoundingSphere({}, meshRadius)
+        .setInstanceRange(0, instances.size())
+}};
+
+/* Indexed draw command with the instance count filled by the shader */
+GL::Buffer commands{GL::Buffer::TargetHint::DrawIndirect, {
+    UnsignedInt(mesh.count()), 0u, 0u, 0u, 0u
+}};
+
+Shaders::InstanceCullingGL culling;
+culling
+    .bindInstanceCullingBuffer(instanceCullingUniform)
+    .bindDrawBuffer(drawUniform)
+    .bindInputInstanceBuffer(inputInstances)
+    .bindOutputInstanceBuffer(outputInstances)
+    .bindCommandBuffer(commands)
+    .cull(1, instances.size());
+GL::Renderer::setMemoryBarrier(
+    GL::Renderer::MemoryBarrier::VertexAttributeArray|
+    GL::Renderer::MemoryBarrier::Command);
+
+/* Draw only the visible instances */
+mesh.addVertexBufferInstanced(outputInstances, 1, 0,
+    Shaders::FlatGL3D::TransformationMatrix{});
+Shaders::FlatGL3D shader{Shaders::FlatGL3D::Flag::InstancedTransformation};
+shader
+    .setTransformationProjectionMatrix(projectionMatrix*cameraMatrix)
+    .drawIndirect(mesh, commands);
+/* [InstanceCullingGL-usage] */
+}
+#endif
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+{
+Vector2i size;
+Matrix4 projectionMatrix, cameraMatrix;
+GL::Buffer instanceCullingUniform, drawUniform, inputInstances, outputInstances, commands;
+UnsignedInt drawCount{}, maxInstanceCount{};
+/* [DepthPyramidGL-usage] */
+/* Depth attachment sampled by the pyramid shader */
+GL::Texture2D depth;
+depth.setMinificationFilter(GL::SamplerFilter::Nearest, GL::SamplerMipmap::Base)
+    .setMagnificationFilter(GL::SamplerFilter::Nearest)
+    .setStorage(1, GL::TextureFormat::DepthComponent32F, size);
+GL::Framebuffer framebuffer{{{}, size}};
+framebuffer.attachTexture(GL::Framebuffer::BufferAttachment::Depth, depth, 0);
+
+GL::Texture2D pyramid;
+pyramid.setMinificationFilter(GL::SamplerFilter::Nearest, GL::SamplerMipmap::Nearest)
+    .setMagnificationFilter(GL::SamplerFilter::Nearest)
+    .setWrapping(GL::SamplerWrapping::ClampToEdge)
+    .setStorage(Shaders::DepthPyramidGL::levelCount(size),
+        GL::TextureFormat::R32F, size);
+
+/* The culling uniform needs the projection and pyramid size as well */
+instanceCullingUniform.setData({
+    Shaders::InstanceCullingUniform{}
+        .setFrustum(Frustum::fromMatrix(projectionMatrix*cameraMatrix))
+        .setProjectionMatrix(projectionMatrix*cameraMatrix)
+        .setHierarchicalZSize(Vector2{size})
+});
+
+Shaders::DepthPyramidGL depthPyramid;
+Shaders::InstanceCullingGL culling{
+    Shaders::InstanceCullingGL::Flag::HierarchicalZ};
+
+/* Each frame, cull against the pyramid from the previous frame ... */
+culling
+    .bindInstanceCullingBuffer(instanceCullingUniform)
+    .bindDrawBuffer(drawUniform)
+    .bindInputInstanceBuffer(inputInstances)
+    .bindOutputInstanceBuffer(outputInstances)
+    .bindCommandBuffer(commands)
+    .bindHierarchicalZTexture(pyramid)
+    .cull(drawCount, maxInstanceCount);
+GL::Renderer::setMemoryBarrier(
+    GL::Renderer::MemoryBarrier::VertexAttributeArray|
+    GL::Renderer::MemoryBarrier::Command);
+
+/* ... draw the visible instances into the framebuffer ... */
+DOXYGEN_ELLIPSIS()
+
+/* ... and build the pyramid for the next frame */
+depthPyramid.build(depth, pyramid, size);
+GL::Renderer::setMemoryBarrier(GL::Renderer::MemoryBarrier::TextureFetch);
+/* [DepthPyramidGL-usage] */
+}
+#endif
+
+#ifndef MAGNUM_TARGET_GLES2
+{
+Matrix4 projectionMatrix, cameraMatrix;
+Float timeDelta{};
+/* [ParticleSystemGL-usage] */
+/* A fountain spraying up to a million particles */
+Shaders::ParticleSystemGL particles{1000000};
+particles
+    .setEmitterRadius(0.1f)
+    .setVelocity({0.0f, 8.0f, 0.0f}, 2.0f)
+    .setLifetime(2.0f, 3.0f)
+    .setAcceleration({0.0f, -9.81f, 0.0f})
+    .setDrag(0.1f)
+    .setColor(0x66ccffff_rgbaf, 0x3366ff00_rgbaf)
+    .setSize(0.02f, 0.05f);
+
+/* A billboard quad, for example Primitives::planeSolid() */
+GL::Mesh billboard{DOXYGEN_ELLIPSIS()};
+particles.setupMesh(billboard);
+
+Shaders::FlatGL3D shader{Shaders::FlatGL3D::Configuration{}
+    .setFlags(Shaders::FlatGL3D::Flag::InstancedTransformation|
+              Shaders::FlatGL3D::Flag::VertexColor)};
+
+/* Each frame, emit new particles, update the simulation and draw */
+particles
+    .emit(UnsignedInt(timeDelta*300000.0f))
+    .update(timeDelta, cameraMatrix);
+GL::Renderer::enable(GL::Renderer::Feature::Blending);
+GL::Renderer::setBlendFunction(
+    GL::Renderer::BlendFunction::One,
+    GL::Renderer::BlendFunction::OneMinusSourceAlpha);
+shader.setTransformationProjectionMatrix(projectionMatrix*cameraMatrix);
+particles.draw(shader, billboard);
+/* [ParticleSystemGL-usage] */
+}
+#endif
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+{
+Matrix4 transformationMatrix, projectionMatrix;
+/* [MeshVisualizerPrepassGL-wireframe] */
+/* Tightly packed positions and 32-bit indices of an indexed triangle mesh */
+GL::Buffer positions{GL::Buffer::TargetHint::ShaderStorage};
+GL::Buffer indices{GL::Buffer::TargetHint::ShaderStorage};
+UnsignedInt vertexCount = DOXYGEN_ELLIPSIS(0), indexCount = DOXYGEN_ELLIPSIS(0);
+
+/* Generate the de-indexed positions once */
+GL::Buffer wireframe;
+wireframe.setData({nullptr, indexCount*sizeof(Vector3)});
+Shaders::MeshVisualizerPrepassGL{Shaders::MeshVisualizerPrepassGL::Flag::Wireframe}
+    .bindPositionBuffer(positions)
+    .bindIndexBuffer(indices)
+    .bindWireframeBuffer(wireframe)
+    .generate(vertexCount, indexCount);
+GL::Renderer::setMemoryBarrier(GL::Renderer::MemoryBarrier::VertexAttributeArray);
+
+GL::Mesh mesh;
+mesh.setCount(indexCount)
+    .addVertexBuffer(wireframe, 0, Shaders::MeshVisualizerGL3D::Position{});
+
+Shaders::MeshVisualizerGL3D shader{
+    Shaders::MeshVisualizerGL3D::Flag::Wireframe|
+    Shaders::MeshVisualizerGL3D::Flag::NoGeometryShader};
+shader
+    .setTransformationMatrix(transformationMatrix)
+    .setProjectionMatrix(projectionMatrix)
+    .draw(mesh);
+/* [MeshVisualizerPrepassGL-wireframe] */
+}
+
+{
+GL::Buffer positions, normals, tangents;
+UnsignedInt vertexCount{};
+Matrix4 transformationMatrix, projectionMatrix;
+/* [MeshVisualizerPrepassGL-tbn] */
+Shaders::MeshVisualizerPrepassGL prepass{
+    Shaders::MeshVisualizerPrepassGL::Flag::TangentDirection|
+    Shaders::MeshVisualizerPrepassGL::Flag::BitangentFromTangentDirection|
+    Shaders::MeshVisualizerPrepassGL::Flag::NormalDirection};
+const UnsignedInt lineVertexCount =
+    vertexCount*prepass.lineCountPerVertex()*2;
+
+GL::Buffer lines;
+lines.setData({nullptr, lineVertexCount*(sizeof(Vector3) + sizeof(Color4))});
+prepass
+    .bindPositionBuffer(positions)
+    .bindNormalBuffer(normals)
+    .bindTangentBuffer(tangents)
+    .bindLineBuffer(lines)
+    .setLineLength(0.1f)
+    .generate(vertexCount);
+GL::Renderer::setMemoryBarrier(GL::Renderer::MemoryBarrier::VertexAttributeArray);
+
+GL::Mesh lineMesh{MeshPrimitive::Lines};
+lineMesh.setCount(lineVertexCount)
+    .addVertexBuffer(lines, 0,
+        Shaders::VertexColorGL3D::Position{},
+        Shaders::VertexColorGL3D::Color4{});
+
+Shaders::VertexColorGL3D shader;
+shader
+    .setTransformationProjectionMatrix(projectionMatrix*transformationMatrix)
+    .draw(lineMesh);
+/* [MeshVisualizerPrepassGL-tbn] */
+}
+#endif
+
 {
 GL::Mesh mesh;
 /* [MeshVisualizerGL2D-usage-instancing] */
@@ -958,6 +1392,116 @@ shader.bindTextures(&diffuseAlphaTexture, &diffuseAlphaTexture, nullptr, nullptr
 /* [PhongGL-usage-alpha] */
 }
 
+{
+GL::Mesh mesh;
+Matrix4 transformationMatrix, projectionMatrix;
+/* [PhongGL-depth-prepass] */
+Shaders::PhongGL::Flags flags = DOXYGEN_ELLIPSIS(Shaders::PhongGL::Flag::InstancedTransformation);
+Shaders::PhongGL depthOnly{Shaders::PhongGL::Configuration{}
+    .setFlags(flags|Shaders::PhongGL::Flag::DepthOnly)
+    .setLightCount(3)};
+Shaders::PhongGL shader{Shaders::PhongGL::Configuration{}
+    .setFlags(flags)
+    .setLightCount(3)};
+
+/* Fill the depth buffer, color writes aren't needed */
+GL::Renderer::setColorMask(false, false, false, false);
+depthOnly
+    .setTransformationMatrix(transformationMatrix)
+    .setProjectionMatrix(projectionMatrix)
+    .draw(mesh);
+
+/* Shade only the fragments that ended up visible */
+GL::Renderer::setColorMask(true, true, true, true);
+GL::Renderer::setDepthMask(false);
+GL::Renderer::setDepthFunction(GL::Renderer::DepthFunction::Equal);
+shader
+    .setTransformationMatrix(transformationMatrix)
+    .setProjectionMatrix(projectionMatrix)
+    .setNormalMatrix(transformationMatrix.normalMatrix())
+    DOXYGEN_ELLIPSIS()
+    .draw(mesh);
+GL::Renderer::setDepthMask(true);
+GL::Renderer::setDepthFunction(GL::Renderer::DepthFunction::Less);
+/* [PhongGL-depth-prepass] */
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+{
+GL::Mesh mesh;
+Matrix4 transformationMatrix;
+Vector3 sunDirection;
+Float near{}, far{};
+GL::Buffer projectionUniform, lightUniform, materialUniform,
+    transformationUniform, drawUniform;
+struct {
+    Matrix4 cameraMatrix() const { return {}; }
+    Matrix4 projectionMatrix() const { return {}; }
+} camera;
+/* [PhongGL-shadows] */
+const UnsignedInt cascadeCount = 3;
+GL::Texture2DArray shadowTexture;
+shadowTexture
+    .setMinificationFilter(GL::SamplerFilter::Linear)
+    .setMagnificationFilter(GL::SamplerFilter::Linear)
+    .setWrapping(GL::SamplerWrapping::ClampToEdge)
+    .setCompareMode(GL::SamplerCompareMode::CompareRefToTexture)
+    .setCompareFunction(GL::SamplerCompareFunction::LessOrEqual)
+    .setStorage(1, GL::TextureFormat::DepthComponent32F,
+        {2048, 2048, Int(cascadeCount)});
+
+/* Render the casters into each cascade */
+Shaders::PhongGL depthOnly{Shaders::PhongGL::Configuration{}
+    .setFlags(Shaders::PhongGL::Flag::DepthOnly)};
+const Vector4 splits = Shaders::shadowCascadeSplits(near, far, cascadeCount);
+Shaders::ShadowCascadeUniform shadow;
+shadow
+    .setCascadeSplits(splits)
+    .setCascadeCount(cascadeCount)
+    .setLightIndex(0);
+#ifndef MAGNUM_TARGET_GLES
+GL::Renderer::enable(GL::Renderer::Feature::DepthClamp);
+#endif
+for(UnsignedInt i = 0; i != cascadeCount; ++i) {
+    const Matrix4 cascadeProjection = Shaders::shadowCascadeProjection(
+        camera.cameraMatrix(), camera.projectionMatrix(),
+        i ? splits[i - 1] : near, splits[i], sunDirection);
+    shadow.setCascadeMatrix(i,
+        cascadeProjection*camera.cameraMatrix().inverted());
+
+    GL::Framebuffer framebuffer{{{}, {2048, 2048}}};
+    framebuffer
+        .attachTextureLayer(GL::Framebuffer::BufferAttachment::Depth,
+            shadowTexture, 0, i)
+        .clear(GL::FramebufferClear::Depth)
+        .bind();
+    depthOnly
+        .setProjectionMatrix(cascadeProjection)
+        .setTransformationMatrix(transformationMatrix)
+        .draw(mesh);
+}
+#ifndef MAGNUM_TARGET_GLES
+GL::Renderer::disable(GL::Renderer::Feature::DepthClamp);
+#endif
+
+/* Shade the scene, with the first light being the sun */
+GL::Buffer shadowUniform{GL::Buffer::TargetHint::Uniform, {shadow}};
+Shaders::PhongGL shader{Shaders::PhongGL::Configuration{}
+    .setFlags(Shaders::PhongGL::Flag::ShadowMaps)};
+GL::defaultFramebuffer.bind();
+shader
+    .bindProjectionBuffer(projectionUniform)
+    .bindTransformationBuffer(transformationUniform)
+    .bindDrawBuffer(drawUniform)
+    .bindMaterialBuffer(materialUniform)
+    .bindLightBuffer(lightUniform)
+    .bindShadowBuffer(shadowUniform)
+    .bindShadowTexture(shadowTexture)
+    .draw(mesh);
+/* [PhongGL-shadows] */
+}
+#endif
+
 #ifndef MAGNUM_TARGET_GLES2
 {
 GL::Mesh mesh;
@@ -1115,4 +1659,223 @@ shader
 }
 #endif
 
+{
+GL::Mesh mesh;
+/* [ShaderVariantCacheGL-usage] */
+Shaders::ShaderVariantCacheGL cache;
+
+Shaders::PhongGL& shader = cache.phong(Shaders::PhongGL::Configuration{}
+    .setFlags(Shaders::PhongGL::Flag::DiffuseTexture)
+    .setLightCount(2));
+shader.draw(mesh);
+/* [ShaderVariantCacheGL-usage] */
+}
+
+{
+GL::Mesh treeMesh, rockMesh;
+Matrix4 projectionMatrix;
+Containers::Array<Matrix4> treeTransformations, rockTransformations;
+/* [InstanceBatcherGL-usage] */
+Shaders::PhongGL shader{Shaders::PhongGL::Configuration{}
+    .setFlags(Shaders::PhongGL::Flag::InstancedTransformation)};
+Color3 materialColors[]{0x2f8a3e_rgbf, 0x7a7065_rgbf};
+
+Shaders::InstanceBatcherGL batcher;
+batcher
+    .setupMesh(treeMesh)
+    .setupMesh(rockMesh)
+    .setMaterialCallback([](GL::AbstractShaderProgram& shader, UnsignedInt material, void* userData) {
+        static_cast<Shaders::PhongGL&>(shader).setDiffuseColor(
+            static_cast<const Color3*>(userData)[material]);
+    }, materialColors);
+
+/* Each frame, add all visible objects and draw them all at once */
+for(const Matrix4& transformation: treeTransformations)
+    batcher.add(shader, treeMesh, 0, transformation);
+for(const Matrix4& transformation: rockTransformations)
+    batcher.add(shader, rockMesh, 1, transformation);
+batcher.flush(projectionMatrix);
+/* [InstanceBatcherGL-usage] */
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+{
+struct Object {
+    GL::Mesh* mesh;
+    Matrix4 transformation;
+    UnsignedInt material;
+};
+Containers::Array<Object> objects;
+GL::Buffer projectionUniform, materialUniform, lightUniform;
+/* [UniformBufferBatcherGL-usage] */
+Shaders::PhongGL shader{Shaders::PhongGL::Configuration{}
+    .setFlags(Shaders::PhongGL::Flag::UniformBuffers)
+    .setMaterialCount(8)
+    .setDrawCount(64)};
+shader
+    .bindProjectionBuffer(projectionUniform)
+    .bindMaterialBuffer(materialUniform)
+    .bindLightBuffer(lightUniform);
+
+/* Each frame, add all visible objects and draw them all at once */
+Shaders::UniformBufferBatcherGL batcher;
+for(const Object& object: objects)
+    batcher.add(shader, *object.mesh,
+        Shaders::TransformationUniform3D{}
+            .setTransformationMatrix(object.transformation),
+        Shaders::PhongDrawUniform{}
+            .setNormalMatrix(object.transformation.normalMatrix())
+            .setMaterialId(object.material));
+batcher.flush();
+/* [UniformBufferBatcherGL-usage] */
+}
+#endif
+
+{
+/* [ShaderVariantCacheGL-precompile] */
+Shaders::ShaderVariantCacheGL cache;
+if(Containers::Optional<Containers::String> variants =
+    Utility::Path::readString("shader-variants.txt"))
+{
+    cache.deserialize(*variants);
+    cache.precompile();
+}
+
+DOXYGEN_ELLIPSIS()
+
+Debug{} << cache.statistics();
+std::string variants = cache.serialize();
+Utility::Path::write("shader-variants.txt",
+    Containers::arrayView(variants.data(), variants.size()));
+/* [ShaderVariantCacheGL-precompile] */
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+{
+GL::Renderbuffer depth;
+GL::Texture2D opaque;
+Vector2i size;
+GL::Mesh transparentMesh;
+/* [TransparencyResolveGL-usage] */
+GL::Texture2D accumulation, revealage;
+accumulation.setStorage(1, GL::TextureFormat::RGBA16F, size);
+revealage.setStorage(1, GL::TextureFormat::R8, size);
+
+/* Draw the opaque geometry into the color and depth attachment first */
+GL::Framebuffer framebuffer{{{}, size}};
+framebuffer
+    .attachTexture(GL::Framebuffer::ColorAttachment{0}, opaque, 0)
+    .attachTexture(GL::Framebuffer::ColorAttachment{1}, accumulation, 0)
+    .attachTexture(GL::Framebuffer::ColorAttachment{2}, revealage, 0)
+    .attachRenderbuffer(GL::Framebuffer::BufferAttachment::Depth, depth);
+DOXYGEN_ELLIPSIS()
+
+/* Then accumulate the transparent geometry, testing against the opaque depth
+   but not writing to it */
+framebuffer
+    .mapForDraw({
+        {Shaders::PhongGL::ColorOutput, GL::Framebuffer::ColorAttachment{1}},
+        {Shaders::PhongGL::RevealageOutput, GL::Framebuffer::ColorAttachment{2}}
+    })
+    .clearColor(Shaders::PhongGL::ColorOutput, Color4{0.0f})
+    .clearColor(Shaders::PhongGL::RevealageOutput, Color4{1.0f});
+GL::Renderer::setDepthMask(false);
+GL::Renderer::enable(GL::Renderer::Feature::Blending);
+GL::Renderer::setBlendFunction(Shaders::PhongGL::ColorOutput,
+    GL::Renderer::BlendFunction::One, GL::Renderer::BlendFunction::One);
+GL::Renderer::setBlendFunction(Shaders::PhongGL::RevealageOutput,
+    GL::Renderer::BlendFunction::Zero,
+    GL::Renderer::BlendFunction::OneMinusSourceColor);
+
+Shaders::PhongGL shader{Shaders::PhongGL::Configuration{}
+    .setFlags(Shaders::PhongGL::Flag::OrderIndependentTransparency)};
+shader
+    DOXYGEN_ELLIPSIS()
+    .draw(transparentMesh);
+
+/* Finally composite the result over the opaque geometry */
+framebuffer.mapForDraw({
+    {Shaders::GenericGL3D::ColorOutput, GL::Framebuffer::ColorAttachment{0}}
+});
+GL::Renderer::setBlendFunction(GL::Renderer::BlendFunction::SourceAlpha,
+    GL::Renderer::BlendFunction::OneMinusSourceAlpha);
+GL::Renderer::disable(GL::Renderer::Feature::DepthTest);
+
+GL::Mesh triangle = MeshTools::fullScreenTriangle();
+Shaders::TransparencyResolveGL resolve;
+resolve
+    .bindAccumulationTexture(accumulation)
+    .bindRevealageTexture(revealage)
+    .draw(triangle);
+/* [TransparencyResolveGL-usage] */
+}
+#endif
+
+#ifndef MAGNUM_TARGET_GLES2
+{
+GL::Mesh mesh;
+GL::Buffer projectionUniform, transformationUniform, lightUniform;
+/* [PbrGL-usage] */
+Trade::PbrMetallicRoughnessMaterialData material = DOXYGEN_ELLIPSIS(Trade::PbrMetallicRoughnessMaterialData{{}, {}});
+
+GL::Buffer materialUniform{GL::Buffer::TargetHint::Uniform, {
+    Shaders::PbrMaterialUniform{}
+        .setBaseColor(material.baseColor())
+        .setEmissiveColor(material.emissiveColor())
+        .setMetalness(material.metalness())
+        .setRoughness(material.roughness())
+        .setAlphaMask(material.alphaMask())
+}};
+GL::Buffer drawUniform{GL::Buffer::TargetHint::Uniform, {
+    Shaders::PbrDrawUniform{}
+        .setMaterialId(0)
+}};
+
+Shaders::PbrGL shader{Shaders::PbrGL::Configuration{}
+    .setLightCount(2)};
+shader
+    .bindProjectionBuffer(projectionUniform)
+    .bindTransformationBuffer(transformationUniform)
+    .bindDrawBuffer(drawUniform)
+    .bindMaterialBuffer(materialUniform)
+    .bindLightBuffer(lightUniform)
+    .draw(mesh);
+/* [PbrGL-usage] */
+}
+
+{
+GL::Mesh mesh;
+Matrix4 cameraMatrix;
+GL::Buffer projectionUniform, transformationUniform, drawUniform,
+    materialUniform, lightUniform;
+/* [PbrGL-ibl] */
+/* Generated once, the environment map is a regular HDR cube map */
+GL::CubeMapTexture environment = DOXYGEN_ELLIPSIS(GL::CubeMapTexture{});
+GL::Texture2D brdfLookup = Shaders::pbrBrdfLookupTexture();
+GL::CubeMapTexture prefiltered =
+    Shaders::pbrPrefilteredEnvironmentTexture(environment, 128, 6);
+
+/* Updated every time the camera rotates */
+GL::Buffer imageBasedLightingUniform{GL::Buffer::TargetHint::Uniform, {
+    Shaders::PbrImageBasedLightingUniform{}
+        .setEnvironmentRotation(cameraMatrix.rotation().inverted())
+        .setLevelCount(6)
+}};
+
+Shaders::PbrGL shader{Shaders::PbrGL::Configuration{}
+    .setFlags(Shaders::PbrGL::Flag::ImageBasedLighting)};
+shader
+    .bindBrdfLookupTexture(brdfLookup)
+    .bindEnvironmentTexture(prefiltered)
+    .bindImageBasedLightingBuffer(imageBasedLightingUniform)
+    .bindProjectionBuffer(projectionUniform)
+    .bindTransformationBuffer(transformationUniform)
+    .bindDrawBuffer(drawUniform)
+    .bindMaterialBuffer(materialUniform)
+    .bindLightBuffer(lightUniform)
+    .draw(mesh);
+/* [PbrGL-ibl] */
+}
+#endif
+
 }
@@ -34,9 +34,16 @@
 #include "Magnum/FileCallback.h"
 #include "Magnum/Math/Color.h"
 #include "Magnum/Math/Matrix3.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Shaders/DistanceFieldVectorGL.h"
 #include "Magnum/Shaders/VectorGL.h"
 #include "Magnum/Text/AbstractFont.h"
+#include "Magnum/Text/AbstractFontConverter.h"
 #include "Magnum/Text/DistanceFieldGlyphCache.h"
+#include "Magnum/Text/DynamicGlyphCache.h"
+#include "Magnum/Text/LayoutCache.h"
+#include "Magnum/Text/MultiChannelDistanceFieldGlyphCache.h"
 #include "Magnum/Text/Renderer.h"
 
 using namespace Magnum;
@@ -126,6 +133,29 @@ font->fillGlyphCache(cache, "abcdefghijklmnopqrstuvwxyz"
 /* [DistanceFieldGlyphCache-usage] */
 }
 
+{
+UnsignedInt glyphId{};
+Vector2i glyphSize, glyphOffset;
+Containers::ArrayView<const char> msdfData;
+/* [MultiChannelDistanceFieldGlyphCache-usage] */
+/* Same original and actual size, as the data are generated at the final
+   resolution already, with the same radius as passed to msdfgen */
+Text::MultiChannelDistanceFieldGlyphCache cache{Vector2i{512}, Vector2i{512}, 4};
+
+/* For each glyph, reserve space, insert it and upload its MSDF data */
+Range2Di rectangle = cache.reserve({glyphSize}).front();
+cache.insert(glyphId, glyphOffset, rectangle);
+cache.setDistanceFieldImage(rectangle.min(), ImageView2D{
+    PixelStorage{}.setAlignment(1), PixelFormat::RGB8Unorm,
+    rectangle.size(), msdfData});
+
+/* Render with a shader that takes a median of the three channels */
+Shaders::DistanceFieldVectorGL2D shader{
+    Shaders::DistanceFieldVectorGL2D::Flag::MultiChannel};
+shader.bindVectorTexture(cache.texture());
+/* [MultiChannelDistanceFieldGlyphCache-usage] */
+}
+
 {
 /* [GlyphCache-usage] */
 Containers::Pointer<Text::AbstractFont> font;
@@ -136,6 +166,29 @@ font->fillGlyphCache(cache, "abcdefghijklmnopqrstuvwxyz"
 /* [GlyphCache-usage] */
 }
 
+{
+PluginManager::Manager<Text::AbstractFontConverter> manager;
+Containers::Pointer<Text::AbstractFont> font;
+/* [MagnumFontConverter-glyph-cache] */
+Containers::Pointer<Text::AbstractFontConverter> converter =
+    manager.loadAndInstantiate("MagnumFontConverter");
+
+/* Load a previously saved cache, if there's any */
+Containers::Pointer<Text::AbstractGlyphCache> cache;
+if(Utility::Path::exists("cache.conf"))
+    cache = converter->importGlyphCacheFromFile("cache.conf");
+
+/* Otherwise fill a new one and save it for the next time */
+if(!cache) {
+    cache.reset(new Text::GlyphCache{Vector2i{512}});
+    font->fillGlyphCache(*cache, "abcdefghijklmnopqrstuvwxyz"
+                                 "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+                                 "0123456789?!:;,. ");
+    converter->exportGlyphCacheToFile(*cache, "cache");
+}
+/* [MagnumFontConverter-glyph-cache] */
+}
+
 {
 Matrix3 projectionMatrix;
 /* [Renderer-usage1] */
@@ -180,4 +233,87 @@ shader.setTransformationProjectionMatrix(projectionMatrix)
 /* [Renderer-usage2] */
 }
 
+{
+Containers::Pointer<Text::AbstractFont> font;
+std::string text;
+/* [DynamicGlyphCache-usage] */
+Text::DynamicGlyphCache cache{Vector2i{1024}, Vector2i{1}};
+
+/* Every frame, make sure all glyphs for the text are present before
+   rendering it */
+cache.nextFrame();
+cache.fill(*font, text);
+/* [DynamicGlyphCache-usage] */
+}
+
+{
+Containers::Pointer<Text::AbstractFont> font;
+Text::GlyphCache cache{Vector2i{512}};
+Int fps{};
+/* [LayoutCache-usage] */
+Text::LayoutCache layoutCache;
+
+Text::Renderer2D renderer{*font, cache, 0.15f};
+renderer.setLayoutCache(&layoutCache)
+    .reserve(16, GL::BufferUsage::DynamicDraw, GL::BufferUsage::StaticDraw);
+
+/* Every frame. Only the first occurrence of each value is laid out, after
+   that the vertex data are taken from the cache. */
+renderer.render(std::to_string(fps) + " FPS");
+/* [LayoutCache-usage] */
+}
+
+{
+Containers::Pointer<Text::AbstractFont> font;
+Text::GlyphCache cache{Vector2i{512}};
+Shaders::VectorGL2D shader;
+Matrix3 projectionMatrix;
+Int fps{};
+/* [BatchRenderer-usage] */
+/* Reserve space for all labels in a single buffer */
+Text::BatchRenderer2D renderer{*font, cache, 0.15f};
+renderer.reserve(256, GL::BufferUsage::DynamicDraw, GL::BufferUsage::StaticDraw);
+
+/* Static labels take only as many glyphs as they need, dynamic ones
+   reserve some extra space for future updates */
+renderer.add("Score:", {-0.9f, 0.8f});
+UnsignedInt fpsLabel = renderer.add("FPS: 0", {0.5f, 0.8f}, 16);
+
+/* Change the label text or position occasionally, and upload all changes
+   at once */
+renderer.setText(fpsLabel, "FPS: " + std::to_string(fps));
+renderer.update();
+
+/* Draw all labels in a single draw call */
+shader.setTransformationProjectionMatrix(projectionMatrix)
+    .setColor(0xffffff_rgbf)
+    .bindVectorTexture(cache.texture())
+    .draw(renderer.mesh());
+/* [BatchRenderer-usage] */
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+{
+Containers::Pointer<Text::AbstractFont> font;
+Text::GlyphCache cache{Vector2i{512}};
+Matrix3 projectionMatrix;
+Int fps{};
+/* [InstancedRenderer-usage] */
+/* The shader has to be created with instanced glyphs enabled */
+Shaders::VectorGL2D shader{Shaders::VectorGL2D::Flag::InstancedGlyphs};
+
+Text::InstancedRenderer renderer{*font, cache, 0.15f};
+renderer.reserve(16, GL::BufferUsage::DynamicDraw);
+
+/* Every frame, produces just one instance per glyph */
+renderer.render(std::to_string(fps) + " FPS", 0x2f83cc_rgbf);
+
+shader.setTransformationProjectionMatrix(projectionMatrix)
+    .bindVectorTexture(cache.texture())
+    .bindGlyphRectangleTexture(renderer.glyphRectangleTexture())
+    .draw(renderer.mesh());
+/* [InstancedRenderer-usage] */
+}
+#endif
+
 }
@@ -0,0 +1,143 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/PluginManager/Manager.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/TextureTools/Atlas.h"
+#include "Magnum/TextureTools/CompressBlocks.h"
+#include "Magnum/TextureTools/DistanceFieldCpu.h"
+#include "Magnum/TextureTools/Downsample.h"
+#include "Magnum/Trade/AbstractImageConverter.h"
+
+#ifdef MAGNUM_TARGET_GL
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Texture.h"
+#include "Magnum/GL/TextureFormat.h"
+#endif
+
+#define DOXYGEN_ELLIPSIS(...) __VA_ARGS__
+
+using namespace Magnum;
+
+int main() {
+{
+/* [AtlasPacker-usage] */
+Containers::ArrayView<const Vector2i> sizes = DOXYGEN_ELLIPSIS({});
+Containers::Array<Vector3i> offsets{NoInit, sizes.size()};
+Containers::Array<bool> rotations{NoInit, sizes.size()};
+
+/* Two 1024x1024 layers, allowing the textures to be rotated */
+TextureTools::AtlasPacker packer{{1024, 1024, 2},
+    TextureTools::AtlasPackerFlag::AllowRotation};
+if(!packer.add(sizes, offsets, rotations)) {
+    /* Doesn't fit, use a larger atlas */
+}
+/* [AtlasPacker-usage] */
+}
+
+{
+/* [distanceFieldInto] */
+ImageView2D input = DOXYGEN_ELLIPSIS(ImageView2D{PixelFormat::R8Unorm, {}});
+
+/* A 4x smaller output, with the distance calculated over 16 input pixels */
+Vector2i outputSize = input.size()/4;
+Image2D output{PixelStorage{}.setAlignment(1), PixelFormat::R8Unorm, outputSize,
+    Containers::Array<char>{NoInit, std::size_t(outputSize.product())}};
+TextureTools::distanceFieldInto(input, output, 16);
+/* [distanceFieldInto] */
+}
+
+{
+PluginManager::Manager<Trade::AbstractImageConverter> manager;
+/* [mipmaps] */
+ImageView2D image = DOXYGEN_ELLIPSIS(ImageView2D{PixelFormat::RGBA8Srgb, {}});
+
+Containers::Array<Image2D> levels =
+    TextureTools::mipmaps(image, TextureTools::DownsampleFilter::Kaiser);
+Containers::Array<ImageView2D> views;
+for(const Image2D& level: levels) arrayAppend(views, ImageView2D{level});
+
+Containers::Pointer<Trade::AbstractImageConverter> converter =
+    manager.loadAndInstantiate("KtxImageConverter");
+converter->convertToFile(views, "texture.ktx2");
+/* [mipmaps] */
+}
+
+{
+PluginManager::Manager<Trade::AbstractImageConverter> manager;
+/* [compressBlocks] */
+ImageView2D image = DOXYGEN_ELLIPSIS(ImageView2D{PixelFormat::RGBA8Srgb, {}});
+
+CompressedImage2D compressed = TextureTools::compressBlocks(image,
+    CompressedPixelFormat::Bc7RGBASrgb);
+
+Containers::Pointer<Trade::AbstractImageConverter> converter =
+    manager.loadAndInstantiate("KtxImageConverter");
+converter->convertToFile(compressed, "texture.ktx2");
+/* [compressBlocks] */
+}
+
+{
+/* [compressBlocksInto] */
+ImageView2D image = DOXYGEN_ELLIPSIS(ImageView2D{PixelFormat::RGB8Srgb, {}});
+CompressedPixelFormat format = CompressedPixelFormat::Bc1RGBSrgb;
+
+/* Mapped memory of a GPU staging buffer, for example */
+Containers::ArrayView<char> staging = DOXYGEN_ELLIPSIS({});
+
+Vector2i blockCount = (image.size() + Vector2i{3})/4;
+TextureTools::compressBlocksInto(image, staging.prefix(
+    blockCount.product()*compressedPixelFormatBlockDataSize(format)), format);
+/* [compressBlocksInto] */
+}
+
+#ifdef MAGNUM_TARGET_GL
+{
+/* [compressBlocksFormat] */
+ImageView2D image = DOXYGEN_ELLIPSIS(ImageView2D{PixelFormat::RGBA8Srgb, {}});
+
+Containers::Optional<CompressedPixelFormat> format =
+    TextureTools::compressBlocksFormat(image.format(),
+        TextureTools::compressBlocksTargets(GL::Context::current()));
+
+GL::Texture2D texture;
+if(format) {
+    texture.setCompressedImage(0,
+        TextureTools::compressBlocks(image, *format));
+} else {
+    /* Nothing suitable, upload the image uncompressed */
+    texture.setImage(0, GL::textureFormat(image.format()), image);
+}
+/* [compressBlocksFormat] */
+}
+#endif
+}
@@ -28,6 +28,8 @@
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/StringStl.h> /** @todo remove once file callbacks are <string>-free */
 #include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/Reference.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Path.h>
@@ -47,10 +49,14 @@
 #include "Magnum/Trade/AbstractImporter.h"
 #include "Magnum/Trade/AbstractSceneConverter.h"
 #include "Magnum/Trade/AnimationData.h"
+#include "Magnum/Trade/ChunkedMeshData.h"
+#include "Magnum/Trade/DataArena.h"
 #include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/ImporterCache.h"
 #include "Magnum/Trade/LightData.h"
 #include "Magnum/Trade/MaterialData.h"
 #include "Magnum/Trade/MeshData.h"
+#include "Magnum/Trade/ParallelLoad.h"
 #include "Magnum/Trade/PbrClearCoatMaterialData.h"
 #include "Magnum/Trade/PbrSpecularGlossinessMaterialData.h"
 #include "Magnum/Trade/PbrMetallicRoughnessMaterialData.h"
@@ -361,6 +367,58 @@ for(auto&& row: data.mutablePixels<Color3ub>())
 /* [ImageData-usage-mutable] */
 }
 
+{
+Containers::Pointer<Trade::AbstractImporter> importer;
+UnsignedInt visibleMeshes[1]{};
+/* [ImporterCache] */
+/* Keep at most 256 MB of meshes around */
+Trade::ImporterCache cache{*importer, 256*1024*1024};
+
+/* Each frame fetch only meshes that are visible, the ones not used for a
+   while get evicted once the budget is exceeded */
+for(UnsignedInt id: visibleMeshes) {
+    const Trade::MeshData* mesh = cache.mesh(id);
+    if(!mesh) continue;
+
+    DOXYGEN_ELLIPSIS(static_cast<void>(mesh);)
+}
+/* [ImporterCache] */
+}
+
+{
+Containers::Pointer<Trade::AbstractImporter> importer;
+/* [DataArena] */
+/* 64 MB blocks, the importer will place all mesh and image data there */
+Trade::DataArena arena{64*1024*1024};
+importer->setDataArena(&arena);
+
+{
+    Containers::Optional<Trade::MeshData> mesh = importer->mesh(0);
+    Containers::Optional<Trade::ImageData2D> image = importer->image2D(0);
+    DOXYGEN_ELLIPSIS()
+}
+
+/* All data are destroyed now, recycle the memory for the next level */
+arena.reset();
+/* [DataArena] */
+}
+
+{
+PluginManager::Manager<Trade::AbstractImporter> manager;
+/* [parallelLoadMeshes] */
+Containers::Pointer<Trade::AbstractImporter> importer =
+    manager.loadAndInstantiate("ObjImporter");
+if(!importer || !importer->openFile("scene.obj"))
+    Fatal{} << "Can't open scene.obj with ObjImporter";
+
+/* Load all meshes using all available CPU cores */
+Containers::Array<UnsignedInt> ids{NoInit, importer->meshCount()};
+for(UnsignedInt i = 0; i != ids.size(); ++i) ids[i] = i;
+Containers::Array<Containers::Optional<Trade::MeshData>> meshes =
+    Trade::parallelLoadMeshes(*importer, ids);
+/* [parallelLoadMeshes] */
+}
+
 {
 /* [LightData-populating-range] */
 Trade::LightData data{Trade::LightData::Type::Point,
@@ -501,6 +559,21 @@ color.rgb() = Color3::fromHsv({hsv.hue, hsv.saturation*0.85f, hsv.value});
 /* [MaterialData-usage-mutable] */
 }
 
+{
+Containers::ArrayView<const Containers::Reference<const Trade::MaterialData>> materials;
+/* [materialAttributesInto] */
+Containers::Array<Color4> baseColors{NoInit, materials.size()};
+Containers::Array<UnsignedInt> baseColorTextures{NoInit, materials.size()};
+Trade::materialAttributesInto(materials, 0, {
+    {Trade::MaterialAttribute::BaseColor, 0xffffffff_rgbaf},
+    {Trade::MaterialAttribute::BaseColorTexture, ~UnsignedInt{}}
+}, {
+    Containers::arrayCast<2, char>(stridedArrayView(baseColors)),
+    Containers::arrayCast<2, char>(stridedArrayView(baseColorTextures))
+});
+/* [materialAttributesInto] */
+}
+
 {
 /* [MaterialData-populating] */
 Trade::MaterialData data{Trade::MaterialType::PbrMetallicRoughness, {
@@ -654,6 +727,27 @@ Trade::MeshAttributeData normals{Trade::MeshAttribute::Normal,
 #endif
 
 #ifdef MAGNUM_TARGET_GL
+{
+Containers::Pointer<Trade::AbstractImporter> importer;
+Matrix4 transformation;
+/* [ChunkedMeshData-usage] */
+Containers::Optional<Trade::ChunkedMeshData> chunks =
+    importer->meshChunks(0, 3*1024*1024);
+if(!chunks) Fatal{} << "Can't import the mesh";
+
+Containers::Array<GL::Mesh> meshes{chunks->chunkCount()};
+for(UnsignedInt i = 0; i != chunks->chunkCount(); ++i) {
+    Containers::Optional<Trade::MeshData> chunk = importer->meshChunk(0,
+        chunks->chunkVertexOffset(i), chunks->chunkVertexCount(i));
+    if(!chunk) Fatal{} << "Can't import chunk" << i;
+
+    /* Only the current chunk is resident at a time */
+    meshes[i] = MeshTools::compile(
+        MeshTools::transform3D(*std::move(chunk), transformation));
+}
+/* [ChunkedMeshData-usage] */
+}
+
 {
 /* This snippet is also used by GL::Mesh, bear that in mind when updating */
 /* [MeshData-usage-compile] */
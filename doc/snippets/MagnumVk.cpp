@@ -29,6 +29,7 @@
 #include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/Path.h>
 
+#include "Magnum/ImageView.h"
 #include "Magnum/Magnum.h"
 #include "Magnum/Mesh.h"
 #include "Magnum/PixelFormat.h"
@@ -40,6 +41,7 @@
 #include "Magnum/Vk/CommandBuffer.h"
 #include "Magnum/Vk/CommandPoolCreateInfo.h"
 #include "Magnum/Vk/ComputePipelineCreateInfo.h"
+#include "Magnum/Vk/DescriptorAllocator.h"
 #include "Magnum/Vk/DescriptorPoolCreateInfo.h"
 #include "Magnum/Vk/DescriptorSet.h"
 #include "Magnum/Vk/DescriptorSetLayoutCreateInfo.h"
@@ -50,6 +52,7 @@
 #include "Magnum/Vk/Extensions.h"
 #include "Magnum/Vk/ExtensionProperties.h"
 #include "Magnum/Vk/FenceCreateInfo.h"
+#include "Magnum/Vk/FramePacer.h"
 #include "Magnum/Vk/FramebufferCreateInfo.h"
 #include "Magnum/Vk/InstanceCreateInfo.h"
 #include "Magnum/Vk/Integration.h"
@@ -57,17 +60,26 @@
 #include "Magnum/Vk/ImageViewCreateInfo.h"
 #include "Magnum/Vk/LayerProperties.h"
 #include "Magnum/Vk/MemoryAllocateInfo.h"
+#include "Magnum/Vk/MemoryAllocator.h"
 #include "Magnum/Vk/Mesh.h"
+#include "Magnum/Vk/ParallelCommandRecorder.h"
 #include "Magnum/Vk/Pipeline.h"
+#include "Magnum/Vk/PipelineCacheCreateInfo.h"
 #include "Magnum/Vk/PipelineLayoutCreateInfo.h"
 #include "Magnum/Vk/PixelFormat.h"
+#include "Magnum/Vk/QueryPoolCreateInfo.h"
 #include "Magnum/Vk/Queue.h"
 #include "Magnum/Vk/RasterizationPipelineCreateInfo.h"
 #include "Magnum/Vk/RenderPassCreateInfo.h"
+#include "Magnum/Vk/RenderingInfo.h"
 #include "Magnum/Vk/Result.h"
 #include "Magnum/Vk/SamplerCreateInfo.h"
+#include "Magnum/Vk/SemaphoreCreateInfo.h"
 #include "Magnum/Vk/ShaderCreateInfo.h"
 #include "Magnum/Vk/ShaderSet.h"
+#include "Magnum/Vk/Surface.h"
+#include "Magnum/Vk/SwapchainCreateInfo.h"
+#include "Magnum/Vk/UploadBatcher.h"
 #include "MagnumExternal/Vulkan/flextVkGlobal.h"
 
 /* [wrapping-include-createinfo] */
@@ -242,6 +254,18 @@ buffer.bindMemory(memory, 0);
 /* [Buffer-creation-custom-allocation] */
 }
 
+{
+Vk::Device device{NoCreate};
+/* [Buffer-creation-allocator] */
+Vk::MemoryAllocator allocator{device};
+
+Vk::Buffer buffer{device,
+    Vk::BufferCreateInfo{Vk::BufferUsage::VertexBuffer, 1024*1024},
+    allocator, Vk::MemoryFlag::DeviceLocal
+};
+/* [Buffer-creation-allocator] */
+}
+
 {
 Vk::Device device{NoCreate};
 Vk::CommandBuffer cmd{NoCreate};
@@ -318,6 +342,69 @@ fence.wait();
 /* [CommandBuffer-usage-submit] */
 }
 
+{
+Vk::Device device{NoCreate};
+Vk::CommandPool pool{NoCreate};
+Vk::CommandBuffer cmd{NoCreate};
+/* [CommandBuffer-secondary] */
+Vk::RenderPass renderPass{DOXYGEN_ELLIPSIS(NoCreate)};
+Vk::Framebuffer framebuffer{DOXYGEN_ELLIPSIS(NoCreate)};
+
+Vk::CommandBuffer secondary = pool.allocate(Vk::CommandBufferLevel::Secondary);
+secondary.begin(Vk::CommandBufferBeginInfo{
+    Vk::CommandBufferInheritanceInfo{renderPass, 0, framebuffer}
+});
+DOXYGEN_ELLIPSIS()
+secondary.end();
+
+cmd.begin()
+   .beginRenderPass(Vk::RenderPassBeginInfo{renderPass, framebuffer}DOXYGEN_ELLIPSIS(),
+        Vk::SubpassBeginInfo{Vk::SubpassContents::SecondaryCommandBuffers})
+   .executeCommands({secondary})
+   .endRenderPass()
+   .end();
+/* [CommandBuffer-secondary] */
+}
+
+{
+Vk::CommandBuffer cmd{NoCreate};
+/* [CommandBuffer-draw-indirect] */
+Vk::Mesh mesh{DOXYGEN_ELLIPSIS(Vk::MeshLayout{MeshPrimitive::Triangles})};
+Vk::Buffer commands{DOXYGEN_ELLIPSIS(NoCreate)};
+Vk::Buffer count{DOXYGEN_ELLIPSIS(NoCreate)};
+
+/* Up to 16 draws with VkDrawIndexedIndirectCommand or VkDrawIndirectCommand
+   structures, depending on whether the mesh is indexed */
+cmd.drawIndirect(mesh, commands, 0, 16);
+
+/* Draw count sourced from a buffer, filled for example by a culling compute
+   shader */
+cmd.drawIndirectCount(mesh, commands, 0, count, 0, 16);
+/* [CommandBuffer-draw-indirect] */
+}
+
+{
+Vk::Device device{NoCreate};
+/* [DescriptorAllocator-creation] */
+Vk::DescriptorAllocator allocator{device, Vk::DescriptorPoolCreateInfo{64, {
+    {Vk::DescriptorType::UniformBuffer, 128},
+    {Vk::DescriptorType::CombinedImageSampler, 64}
+}}, 3};
+/* [DescriptorAllocator-creation] */
+
+Vk::FramePacer pacer{device, 3};
+Vk::DescriptorSetLayout layout{NoCreate};
+/* [DescriptorAllocator-usage] */
+/* Once the pacer returns, the GPU is done with sets of this frame index */
+allocator.beginFrame(pacer.beginFrame());
+
+for(DOXYGEN_ELLIPSIS(std::size_t i = 0; i != 0; ++i)) {
+    Vk::DescriptorSet set = allocator.allocate(layout);
+    DOXYGEN_ELLIPSIS(static_cast<void>(set);)
+}
+/* [DescriptorAllocator-usage] */
+}
+
 {
 Vk::Device device{NoCreate};
 /* The include should be a no-op here since it was already included above */
@@ -580,6 +667,115 @@ Vk::Fence fence{device, Vk::FenceCreateInfo{Vk::FenceCreateInfo::Flag::Signaled}
 /* [Fence-creation] */
 }
 
+{
+Vk::Device device{NoCreate};
+Vk::Queue queue{NoCreate};
+/* [FramePacer-usage] */
+Vk::FramePacer pacer{device, 3};
+Vk::CommandBuffer commandBuffers[3]{DOXYGEN_ELLIPSIS(Vk::CommandBuffer{NoCreate}, Vk::CommandBuffer{NoCreate}, Vk::CommandBuffer{NoCreate})};
+
+while(DOXYGEN_ELLIPSIS(false)) {
+    /* Waits only if the GPU is three frames behind */
+    Vk::CommandBuffer& cmd = commandBuffers[pacer.beginFrame()];
+    cmd.begin()
+       DOXYGEN_ELLIPSIS()
+       .end();
+
+    queue.submit({Vk::SubmitInfo{}
+        .setCommandBuffers({cmd})
+        .setSignalSemaphores({pacer.semaphore()}, {pacer.frame()})
+    }, {});
+}
+
+/* Wait for all frames to finish before destroying anything */
+pacer.wait();
+/* [FramePacer-usage] */
+}
+
+{
+Containers::ArrayView<const Containers::StringView> platformExtensions;
+VkSurfaceKHR platformSurface{};
+/* [Surface-creation] */
+/* Required extensions as listed by e.g. app.vkInstanceExtensions() */
+Vk::Instance instance{Vk::InstanceCreateInfo{}
+    .addEnabledExtensions(platformExtensions)
+};
+
+/* Surface created by e.g. app.createVkSurface(instance) */
+Vk::Surface surface = Vk::Surface::wrap(instance, platformSurface,
+    Vk::HandleFlag::DestroyOnDestruction);
+/* [Surface-creation] */
+}
+
+{
+Vk::Instance instance{NoCreate};
+Vk::Surface surface{NoCreate};
+Vk::Device device{NoCreate};
+/* [Swapchain-creation] */
+Vk::DeviceProperties properties = Vk::pickDevice(instance);
+VkSurfaceCapabilitiesKHR capabilities = surface.capabilities(properties);
+
+/* Prefer low-latency modes, fall back to Fifo which is always supported */
+Vk::PresentMode presentMode = surface.pickPresentMode(properties,
+    {Vk::PresentMode::Mailbox, Vk::PresentMode::FifoRelaxed});
+
+Vk::Swapchain swapchain{device, Vk::SwapchainCreateInfo{surface,
+    Vk::PixelFormat::RGBA8Srgb, Vector2i{capabilities.currentExtent},
+    presentMode, capabilities.minImageCount + 1}};
+/* [Swapchain-creation] */
+}
+
+{
+Vk::Device device{NoCreate};
+Vk::Queue queue{NoCreate};
+Vk::Swapchain swapchain{NoCreate};
+Vk::CommandBuffer commandBuffers[3]{DOXYGEN_ELLIPSIS(Vk::CommandBuffer{NoCreate}, Vk::CommandBuffer{NoCreate}, Vk::CommandBuffer{NoCreate})};
+/* [Swapchain-usage] */
+Vk::FramePacer pacer{device, 3};
+
+/* One binary semaphore per frame in flight for acquire, one per swapchain
+   image for present */
+Vk::Semaphore imageAvailable[3]{
+    Vk::Semaphore{device}, Vk::Semaphore{device}, Vk::Semaphore{device}};
+Containers::Array<Vk::Semaphore> renderFinished{DirectInit,
+    swapchain.images().size(), device};
+
+while(DOXYGEN_ELLIPSIS(false)) {
+    const UnsignedInt frameIndex = pacer.beginFrame();
+    Containers::Optional<UnsignedInt> image =
+        swapchain.acquire(imageAvailable[frameIndex]);
+    if(!image) DOXYGEN_ELLIPSIS(continue); /* Recreate the swapchain */
+
+    Vk::CommandBuffer& cmd = commandBuffers[frameIndex];
+    DOXYGEN_ELLIPSIS()
+
+    /* The binary semaphore value is ignored */
+    queue.submit({Vk::SubmitInfo{}
+        .setWaitSemaphores({imageAvailable[frameIndex]},
+            {Vk::PipelineStage::ColorAttachmentOutput})
+        .setCommandBuffers({cmd})
+        .setSignalSemaphores({renderFinished[*image], pacer.semaphore()},
+            {0, pacer.frame()})
+    }, {});
+
+    if(!swapchain.present(queue, *image, renderFinished[*image]))
+        DOXYGEN_ELLIPSIS(continue); /* Recreate the swapchain */
+}
+/* [Swapchain-usage] */
+}
+
+{
+Vk::Swapchain swapchain{NoCreate};
+Vk::FramePacer pacer{NoCreate};
+Vector2i size;
+/* [Swapchain-resize] */
+/* Wait until the GPU is done with all frames in flight */
+pacer.wait();
+if(size.product())
+    swapchain.recreate(size);
+/* [Swapchain-resize] */
+}
+
 {
 Vk::Device device{DOXYGEN_ELLIPSIS(NoCreate)};
 Vector2i size;
@@ -645,6 +841,17 @@ image.bindMemory(memory, 0);
 /* [Image-creation-custom-allocation] */
 }
 
+{
+Vk::Device device{NoCreate};
+/* [Image-creation-allocator] */
+Vk::MemoryAllocator allocator{device};
+
+Vk::Image image{device, Vk::ImageCreateInfo2D{
+    Vk::ImageUsage::Sampled, PixelFormat::RGBA8Srgb, {1024, 1024}, 1
+}, allocator, Vk::MemoryFlag::DeviceLocal};
+/* [Image-creation-allocator] */
+}
+
 {
 Vk::Device device{NoCreate};
 Vk::CommandBuffer cmd{NoCreate};
@@ -905,6 +1112,27 @@ indices.bindMemory(memory, indicesOffset);
 /* [Memory-mapping] */
 }
 
+{
+Vk::Device device{NoCreate};
+/* [MemoryAllocator-usage] */
+/* One allocator per device, 64 MB blocks, allocations of 32 MB and more get a
+   dedicated memory */
+Vk::MemoryAllocator allocator{device};
+
+Vk::Buffer vertices{device, Vk::BufferCreateInfo{
+    Vk::BufferUsage::VertexBuffer|Vk::BufferUsage::TransferDestination, 256*1024
+}, allocator, Vk::MemoryFlag::DeviceLocal};
+Vk::Image texture{device, Vk::ImageCreateInfo2D{
+    Vk::ImageUsage::Sampled|Vk::ImageUsage::TransferDestination,
+    PixelFormat::RGBA8Srgb, {512, 512}, 1
+}, allocator, Vk::MemoryFlag::DeviceLocal};
+
+/* Both are now sub-allocated from the same block */
+Vk::MemoryAllocation& allocation = vertices.allocatedMemory();
+DOXYGEN_ELLIPSIS(static_cast<void>(allocation);)
+/* [MemoryAllocator-usage] */
+}
+
 {
 /* [MeshLayout-usage] */
 constexpr UnsignedInt Binding = 0;
@@ -1091,6 +1319,79 @@ Vk::Pipeline pipeline{device, Vk::ComputePipelineCreateInfo{
 /* [Pipeline-creation-compute] */
 }
 
+{
+Vk::Device device{NoCreate};
+/* [ParallelCommandRecorder-creation] */
+Vk::ParallelCommandRecorder recorder{device, Vk::CommandPoolCreateInfo{
+    device.properties().pickQueueFamily(Vk::QueueFlag::Graphics),
+    Vk::CommandPoolCreateInfo::Flag::Transient
+}};
+/* [ParallelCommandRecorder-creation] */
+}
+
+{
+Vk::ParallelCommandRecorder recorder{NoCreate};
+Vk::CommandBuffer cmd{NoCreate};
+struct Object {
+    void draw(Vk::CommandBuffer&) {}
+};
+/* [ParallelCommandRecorder-recording] */
+Vk::RenderPass renderPass{DOXYGEN_ELLIPSIS(NoCreate)};
+Vk::Framebuffer framebuffer{DOXYGEN_ELLIPSIS(NoCreate)};
+Containers::Array<Object> objects;
+
+/* Each secondary command buffer draws one object */
+Containers::Array<Vk::CommandBuffer> secondary = recorder.recordSecondary(
+    Vk::CommandBufferInheritanceInfo{renderPass, 0, framebuffer},
+    objects.size(),
+    [](Vk::CommandBuffer& cmd, std::size_t i, Containers::Array<Object>& objects) {
+        objects[i].draw(cmd);
+    }, objects);
+
+cmd.begin()
+   .beginRenderPass(Vk::RenderPassBeginInfo{renderPass, framebuffer}DOXYGEN_ELLIPSIS(),
+        Vk::SubpassBeginInfo{Vk::SubpassContents::SecondaryCommandBuffers})
+   .executeCommands(secondary)
+   .endRenderPass()
+   .end();
+/* [ParallelCommandRecorder-recording] */
+}
+
+{
+Vk::Device device{NoCreate};
+/* [PipelineCache-creation] */
+Vk::PipelineCache cache{device};
+
+Vk::Pipeline pipeline{device, Vk::ComputePipelineCreateInfo{DOXYGEN_ELLIPSIS(
+    Vk::ShaderSet{}, VkPipelineLayout{})
+}, cache};
+/* [PipelineCache-creation] */
+}
+
+{
+Vk::Device device{NoCreate};
+/* [PipelineCache-persistence] */
+Vk::PipelineCache cache = Vk::PipelineCache::load(device, "pipeline.cache");
+
+DOXYGEN_ELLIPSIS()
+
+cache.save("pipeline.cache");
+/* [PipelineCache-persistence] */
+}
+
+{
+Vk::Device device{NoCreate};
+Vk::PipelineCache cache{NoCreate};
+Vk::ShaderSet shaderSet;
+VkPipelineLayout pipelineLayout{};
+/* [PipelineCache-batch] */
+Vk::ComputePipelineCreateInfo a{shaderSet, pipelineLayout};
+Vk::ComputePipelineCreateInfo b{DOXYGEN_ELLIPSIS(shaderSet, pipelineLayout)};
+
+Containers::Array<Vk::Pipeline> pipelines = cache.createPipelines({a, b});
+/* [PipelineCache-batch] */
+}
+
 {
 Vk::CommandBuffer cmd{NoCreate};
 /* [Pipeline-usage] */
@@ -1102,6 +1403,27 @@ cmd.bindPipeline(pipeline);
 /* [Pipeline-usage] */
 }
 
+{
+Vk::CommandBuffer cmd{NoCreate};
+Vk::Buffer vertices{NoCreate};
+Vk::Image texture{NoCreate};
+/* [DependencyInfo-usage] */
+/* Vertex data written by a transfer are needed only by vertex input, while a
+   texture written by the same transfer only by the fragment shader. With a
+   single pair of stages, vertex input would have to wait for both. */
+cmd.pipelineBarrier(Vk::DependencyInfo{}
+    .addBufferMemoryBarrier(
+        Vk::PipelineStage::Transfer, Vk::Access::TransferWrite,
+        Vk::PipelineStage::VertexInput, Vk::Access::VertexAttributeRead,
+        vertices)
+    .addImageMemoryBarrier(
+        Vk::PipelineStage::Transfer, Vk::Access::TransferWrite,
+        Vk::PipelineStage::FragmentShader, Vk::Access::ShaderRead,
+        Vk::ImageLayout::TransferDestination, Vk::ImageLayout::ShaderReadOnly,
+        texture));
+/* [DependencyInfo-usage] */
+}
+
 {
 Vk::Device device{NoCreate};
 /* The include should be a no-op here since it was already included above */
@@ -1120,6 +1442,49 @@ Vk::PipelineLayout{device, Vk::PipelineLayoutCreateInfo{
 /* [PipelineLayout-creation] */
 }
 
+{
+Vk::Device device{NoCreate};
+/* The include should be a no-op here since it was already included above */
+/* [QueryPool-creation] */
+#include <Magnum/Vk/QueryPoolCreateInfo.h>
+
+DOXYGEN_ELLIPSIS()
+
+Vk::QueryPool timestamps{device, Vk::QueryPoolCreateInfo{
+    Vk::QueryType::Timestamp, 2}};
+Vk::QueryPool statistics{device, Vk::QueryPoolCreateInfo{
+    Vk::QueryType::PipelineStatistics, 1,
+    Vk::QueryPipelineStatistic::VertexShaderInvocations|
+    Vk::QueryPipelineStatistic::FragmentShaderInvocations}};
+/* [QueryPool-creation] */
+
+Vk::CommandBuffer cmd{NoCreate};
+Vk::Queue queue{NoCreate};
+/* [QueryPool-usage] */
+cmd.begin()
+   .resetQueryPool(timestamps, 0, 2)
+   .resetQueryPool(statistics, 0, 1)
+   .writeTimestamp(Vk::PipelineStage::TopOfPipe, timestamps, 0)
+   .beginQuery(statistics, 0)
+   DOXYGEN_ELLIPSIS()
+   .endQuery(statistics, 0)
+   .writeTimestamp(Vk::PipelineStage::BottomOfPipe, timestamps, 1)
+   .end();
+queue.submit({Vk::SubmitInfo{}.setCommandBuffers({cmd})}).wait();
+
+/* Convert the timestamp difference to nanoseconds */
+UnsignedLong time[2];
+timestamps.results(0, 2, time);
+Double duration = (time[1] - time[0])*device.properties().properties()
+    .properties.limits.timestampPeriod;
+
+/* Statistics are written in the order of their bits */
+UnsignedLong invocations[2];
+statistics.results(0, 1, invocations);
+/* [QueryPool-usage] */
+static_cast<void>(duration);
+}
+
 {
 Vk::Device device{NoCreate};
 /* The include should be a no-op here since it was already included above */
@@ -1182,6 +1547,38 @@ cmd.begin()
 /* [RenderPass-usage-end] */
 }
 
+{
+Vk::Device device{NoCreate};
+Vk::ShaderSet shaderSet{DOXYGEN_ELLIPSIS()};
+Vk::MeshLayout meshLayout{DOXYGEN_ELLIPSIS(MeshPrimitive{})};
+Vk::PipelineLayout pipelineLayout{DOXYGEN_ELLIPSIS(NoCreate)};
+Vk::CommandBuffer cmd{NoCreate};
+/* [RenderingInfo-usage] */
+Vk::ImageView color{DOXYGEN_ELLIPSIS(NoCreate)}, depth{DOXYGEN_ELLIPSIS(NoCreate)};
+
+/* No render pass, only the attachment formats */
+Vk::Pipeline pipeline{device, Vk::RasterizationPipelineCreateInfo{
+        shaderSet, meshLayout, pipelineLayout, {}, 0, 1}
+    .setViewport({{}, {800.0f, 600.0f}})
+    .setRenderingFormats({Vk::PixelFormat::RGBA8Srgb},
+        Vk::PixelFormat::Depth32F)
+};
+
+DOXYGEN_ELLIPSIS()
+
+cmd.beginRendering(Vk::RenderingInfo{{{}, {800, 600}}}
+        .addColorAttachment(color, Vk::ImageLayout::ColorAttachment,
+            Vk::AttachmentLoadOperation::Clear,
+            Vk::AttachmentStoreOperation::Store, 0x1f1f1f_srgbf)
+        .setDepthAttachment(depth, Vk::ImageLayout::DepthStencilAttachment,
+            Vk::AttachmentLoadOperation::Clear,
+            Vk::AttachmentStoreOperation::DontCare))
+   .bindPipeline(pipeline)
+   DOXYGEN_ELLIPSIS()
+   .endRendering();
+/* [RenderingInfo-usage] */
+}
+
 {
 Vk::Device device{NoCreate};
 /* The include should be a no-op here since it was already included above */
@@ -1205,6 +1602,37 @@ Vk::Sampler sampler{device, Vk::SamplerCreateInfo{}
 /* [Sampler-creation-linear] */
 }
 
+{
+Vk::Device device{NoCreate};
+/* The include should be a no-op here since it was already included above */
+/* [Semaphore-creation] */
+#include <Magnum/Vk/SemaphoreCreateInfo.h>
+
+DOXYGEN_ELLIPSIS()
+
+Vk::Semaphore binary{device};
+Vk::Semaphore timeline{device, Vk::SemaphoreCreateInfo{
+    Vk::SemaphoreType::Timeline, 0}};
+/* [Semaphore-creation] */
+
+Vk::Queue queue{NoCreate};
+Vk::CommandBuffer cmd{NoCreate};
+/* [Semaphore-usage] */
+/* Wait for the timeline to reach 1 before the transfer, signal 2 after */
+queue.submit({Vk::SubmitInfo{}
+    .setWaitSemaphores({timeline}, {Vk::PipelineStage::Transfer}, {1})
+    .setCommandBuffers({cmd})
+    .setSignalSemaphores({timeline}, {2})
+}, {});
+
+DOXYGEN_ELLIPSIS()
+
+/* Unblock the submission from the CPU and wait until it's done */
+timeline.signal(1);
+timeline.wait(2);
+/* [Semaphore-usage] */
+}
+
 {
 Vk::Device device{NoCreate};
 /* The include should be a no-op here since it was already included above */
@@ -1254,6 +1682,67 @@ set.addShader(Vk::ShaderStage::Vertex, shader, "vert"_s)
 /* [ShaderSet-usage-ownership-transfer] */
 }
 
+{
+Vk::Instance instance{NoCreate};
+/* [UploadBatcher-creation] */
+Vk::DeviceProperties properties = Vk::pickDevice(instance);
+UnsignedInt transferFamily = properties.pickQueueFamily(Vk::QueueFlag::Transfer);
+
+Vk::Queue transferQueue{NoCreate};
+Vk::Device device{instance, Vk::DeviceCreateInfo{properties}
+    DOXYGEN_ELLIPSIS()
+    .addQueues(transferFamily, {0.0f}, {transferQueue})
+};
+
+/* 16 MB staging ring, at most four batches in flight */
+Vk::UploadBatcher batcher{device, transferQueue, transferFamily,
+    16*1024*1024, 4};
+/* [UploadBatcher-creation] */
+}
+
+{
+Vk::UploadBatcher batcher{NoCreate};
+/* [UploadBatcher-upload] */
+Containers::ArrayView<const char> vertexData = DOXYGEN_ELLIPSIS({});
+Containers::ArrayView<const char> indexData = DOXYGEN_ELLIPSIS({});
+Vk::Buffer vertices{DOXYGEN_ELLIPSIS(NoCreate)};
+Vk::Buffer indices{DOXYGEN_ELLIPSIS(NoCreate)};
+
+batcher
+    .upload(vertexData, vertices)
+    .upload(indexData, indices);
+DOXYGEN_ELLIPSIS()
+
+/* Submit everything recorded so far */
+UnsignedLong batch = batcher.flush();
+
+DOXYGEN_ELLIPSIS()
+
+/* Make sure the data are there before drawing */
+batcher.wait(batch);
+/* [UploadBatcher-upload] */
+}
+
+{
+Vk::UploadBatcher batcher{NoCreate};
+/* [UploadBatcher-image] */
+ImageView2D image{DOXYGEN_ELLIPSIS(PixelFormat::RGBA8Unorm, {})};
+Vk::Image texture{DOXYGEN_ELLIPSIS(NoCreate)};
+
+batcher.commandBuffer()
+    .pipelineBarrier(Vk::PipelineStage::TopOfPipe, Vk::PipelineStage::Transfer, {
+        {Vk::Accesses{}, Vk::Access::TransferWrite,
+         Vk::ImageLayout::Undefined, Vk::ImageLayout::TransferDestination, texture}
+    });
+batcher.upload(image, texture);
+batcher.commandBuffer()
+    .pipelineBarrier(Vk::PipelineStage::Transfer, Vk::PipelineStage::FragmentShader, {
+        {Vk::Access::TransferWrite, Vk::Access::ShaderRead,
+         Vk::ImageLayout::TransferDestination, Vk::ImageLayout::ShaderReadOnly, texture}
+    });
+/* [UploadBatcher-image] */
+}
+
 {
 /* [Integration] */
 VkOffset2D a{64, 32};
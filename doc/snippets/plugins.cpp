@@ -1,3 +1,4 @@
+#include <Corrade/Containers/StringView.h>
 #include <Corrade/PluginManager/Manager.h>
 #include <Corrade/Utility/ConfigurationGroup.h>
 
@@ -64,6 +65,25 @@ importer->openFile("texture.dds");
 /* [anyimporter] */
 }
 
+{
+Containers::StringView filesForThisThread[1];
+auto process = [](Trade::AbstractImporter&) {};
+/* [threads] */
+/* Once at thread startup, with an explicit directory to not probe all
+   search paths */
+PluginManager::Manager<Trade::AbstractImporter> manager{
+    "/opt/my-app/plugins/importers"};
+Containers::Pointer<Trade::AbstractImporter> importer =
+    manager.loadAndInstantiate("AnySceneImporter");
+
+/* Then reuse the same instance for every task handled by the thread */
+for(Containers::StringView file: filesForThisThread) {
+    if(!importer->openFile(file)) continue;
+    process(*importer);
+}
+/* [threads] */
+}
+
 {
 PluginManager::Manager<Trade::AbstractImporter> manager;
 /* [configuration] */
@@ -85,8 +105,10 @@ fontManager.registerExternalManager(importerManager);
 {
 /* [MagnumFontConverter-imageconverter-register] */
 PluginManager::Manager<Trade::AbstractImageConverter> imageConverterManager;
+PluginManager::Manager<Trade::AbstractImporter> importerManager;
 PluginManager::Manager<Text::AbstractFontConverter> fontConverterManager;
 fontConverterManager.registerExternalManager(imageConverterManager);
+fontConverterManager.registerExternalManager(importerManager);
 /* [MagnumFontConverter-imageconverter-register] */
 }
 
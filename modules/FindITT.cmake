@@ -0,0 +1,70 @@
+#.rst:
+# Find ITT
+# --------
+#
+# Finds the Intel Instrumentation and Tracing Technology API library used by
+# VTune and other Intel profilers. This module defines:
+#
+#  ITT_FOUND            - True if the ITT library is found
+#  ITT::ittnotify       - ITT imported target
+#
+# Additionally these variables are defined for internal usage:
+#
+#  ITT_LIBRARY          - ITT library
+#  ITT_INCLUDE_DIR      - Include dir
+#
+# The library is searched for in the ``VTUNE_PROFILER_DIR`` environment
+# variable set by the VTune installation, in addition to the usual paths.
+#
+
+#
+#   This file is part of Magnum.
+#
+#   Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+#               2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+#
+#   Permission is hereby granted, free of charge, to any person obtaining a
+#   copy of this software and associated documentation files (the "Software"),
+#   to deal in the Software without restriction, including without limitation
+#   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+#   and/or sell copies of the Software, and to permit persons to whom the
+#   Software is furnished to do so, subject to the following conditions:
+#
+#   The above copyright notice and this permission notice shall be included
+#   in all copies or substantial portions of the Software.
+#
+#   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+#   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+#   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+#   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+#   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+#   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+#   DEALINGS IN THE SOFTWARE.
+
+find_library(ITT_LIBRARY
+    NAMES ittnotify libittnotify
+    HINTS $ENV{VTUNE_PROFILER_DIR}
+    PATH_SUFFIXES sdk/lib64 sdk/lib32 lib64 lib32)
+
+find_path(ITT_INCLUDE_DIR NAMES ittnotify.h
+    HINTS $ENV{VTUNE_PROFILER_DIR}
+    PATH_SUFFIXES sdk/include include)
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(ITT DEFAULT_MSG
+    ITT_LIBRARY
+    ITT_INCLUDE_DIR)
+
+if(NOT TARGET ITT::ittnotify)
+    add_library(ITT::ittnotify UNKNOWN IMPORTED)
+    set_target_properties(ITT::ittnotify PROPERTIES
+        IMPORTED_LOCATION ${ITT_LIBRARY}
+        INTERFACE_INCLUDE_DIRECTORIES ${ITT_INCLUDE_DIR})
+    # The static library uses dlopen() to load the collector
+    if(CORRADE_TARGET_UNIX)
+        set_property(TARGET ITT::ittnotify APPEND PROPERTY
+            INTERFACE_LINK_LIBRARIES ${CMAKE_DL_LIBS})
+    endif()
+endif()
+
+mark_as_advanced(ITT_LIBRARY ITT_INCLUDE_DIR)
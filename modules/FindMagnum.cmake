@@ -85,8 +85,11 @@
 #  WglContext                   - WGL context
 #  OpenGLTester                 - OpenGLTester class
 #  VulkanTester                 - VulkanTester class
+#  BlockCompressionImageConverter - Block compression image converter plugin
 #  MagnumFont                   - Magnum bitmap font plugin
 #  MagnumFontConverter          - Magnum bitmap font converter plugin
+#  MagnumImporter               - Magnum binary mesh importer plugin
+#  MagnumSceneConverter         - Magnum binary mesh converter plugin
 #  ObjImporter                  - OBJ importer plugin
 #  TgaImageConverter            - TGA image converter plugin
 #  TgaImporter                  - TGA importer plugin
@@ -130,6 +133,11 @@
 #
 #  MAGNUM_BUILD_DEPRECATED      - Defined if compiled with deprecated APIs
 #   included
+#  MAGNUM_BUILD_PROFILING       - Defined if compiled with profiling scopes
+#   in library code
+#  MAGNUM_PROFILING_TRACY       - Defined if the profiling scopes use Tracy
+#  MAGNUM_PROFILING_ITT         - Defined if the profiling scopes use Intel
+#   ITT
 #  MAGNUM_BUILD_STATIC          - Defined if compiled as static libraries
 #  MAGNUM_BUILD_STATIC_UNIQUE_GLOBALS - Defined if static libraries keep the
 #   globals unique even across different shared libraries
@@ -263,6 +271,9 @@ string(REGEX REPLACE ";" "\\\\;" _magnumConfigure "${_magnumConfigure}")
 string(REGEX REPLACE "\n" ";" _magnumConfigure "${_magnumConfigure}")
 set(_magnumFlags
     BUILD_DEPRECATED
+    BUILD_PROFILING
+    PROFILING_TRACY
+    PROFILING_ITT
     BUILD_STATIC
     BUILD_STATIC_UNIQUE_GLOBALS
     TARGET_GL
@@ -345,9 +356,22 @@ if(NOT TARGET Magnum::Magnum)
     set_property(TARGET Magnum::Magnum APPEND PROPERTY INTERFACE_INCLUDE_DIRECTORIES
         ${MAGNUM_INCLUDE_DIR})
 
-    # Dependent libraries
+    # Dependent libraries. The Math::Algorithms reductions use std::thread.
+    set(THREADS_PREFER_PTHREAD_FLAG TRUE)
+    find_package(Threads REQUIRED)
     set_property(TARGET Magnum::Magnum APPEND PROPERTY INTERFACE_LINK_LIBRARIES
-         Corrade::Utility)
+         Corrade::Utility Threads::Threads)
+
+    # Profiler used by the MAGNUM_PROFILE_SCOPE() macros in public headers
+    if(MAGNUM_PROFILING_TRACY)
+        find_package(Tracy CONFIG REQUIRED)
+        set_property(TARGET Magnum::Magnum APPEND PROPERTY
+            INTERFACE_LINK_LIBRARIES Tracy::TracyClient)
+    elseif(MAGNUM_PROFILING_ITT)
+        find_package(ITT REQUIRED)
+        set_property(TARGET Magnum::Magnum APPEND PROPERTY
+            INTERFACE_LINK_LIBRARIES ITT::ittnotify)
+    endif()
 else()
     set(MAGNUM_LIBRARY Magnum::Magnum)
 endif()
@@ -360,7 +384,8 @@ set(_MAGNUM_LIBRARY_COMPONENTS
     WindowlessEglApplication EglContext OpenGLTester)
 set(_MAGNUM_PLUGIN_COMPONENTS
     AnyAudioImporter AnyImageConverter AnyImageImporter AnySceneConverter
-    AnySceneImporter MagnumFont MagnumFontConverter ObjImporter
+    AnySceneImporter BlockCompressionImageConverter MagnumFont MagnumFontConverter MagnumImporter
+    MagnumSceneConverter ObjImporter
     TgaImageConverter TgaImporter WavAudioImporter)
 set(_MAGNUM_EXECUTABLE_COMPONENTS
     imageconverter sceneconverter shaderconverter gl-info al-info)
@@ -419,11 +444,20 @@ if(MAGNUM_TARGET_GL)
     set(_MAGNUM_DebugTools_Shaders_DEPENDENCY_IS_OPTIONAL ON)
     set(_MAGNUM_DebugTools_GL_DEPENDENCY_IS_OPTIONAL ON)
 endif()
+# Vk is used only for FrameProfilerVk, compiled in only if the base library
+# was built with Vulkan interoperability
+if(MAGNUM_TARGET_VK)
+    list(APPEND _MAGNUM_DebugTools_DEPENDENCIES Vk)
+    set(_MAGNUM_DebugTools_Vk_DEPENDENCY_IS_OPTIONAL ON)
+endif()
 
 set(_MAGNUM_MeshTools_DEPENDENCIES Trade)
 if(MAGNUM_TARGET_GL)
     list(APPEND _MAGNUM_MeshTools_DEPENDENCIES GL)
 endif()
+if(MAGNUM_TARGET_VK)
+    list(APPEND _MAGNUM_MeshTools_DEPENDENCIES Vk)
+endif()
 
 set(_MAGNUM_OpenGLTester_DEPENDENCIES GL)
 if(MAGNUM_TARGET_HEADLESS OR CORRADE_TARGET_EMSCRIPTEN OR CORRADE_TARGET_ANDROID)
@@ -499,8 +533,11 @@ set(_MAGNUM_EglContext_DEPENDENCIES GL)
 set(_MAGNUM_GlxContext_DEPENDENCIES GL)
 set(_MAGNUM_WglContext_DEPENDENCIES GL)
 
+set(_MAGNUM_BlockCompressionImageConverter_DEPENDENCIES TextureTools) # and below
 set(_MAGNUM_MagnumFont_DEPENDENCIES Trade TgaImporter GL) # and below
-set(_MAGNUM_MagnumFontConverter_DEPENDENCIES Trade TgaImageConverter) # and below
+set(_MAGNUM_MagnumFontConverter_DEPENDENCIES Trade TgaImageConverter TgaImporter) # and below
+set(_MAGNUM_MagnumImporter_DEPENDENCIES MeshTools) # and below
+set(_MAGNUM_MagnumSceneConverter_DEPENDENCIES MeshTools) # and below
 set(_MAGNUM_ObjImporter_DEPENDENCIES MeshTools) # and below
 foreach(_component ${_MAGNUM_PLUGIN_COMPONENTS})
     if(_component MATCHES ".+AudioImporter")
@@ -920,10 +957,19 @@ foreach(_component ${Magnum_FIND_COMPONENTS})
         elseif(_component STREQUAL TextureTools)
             set(_MAGNUM_${_COMPONENT}_INCLUDE_PATH_NAMES Atlas.h)
 
+            # distanceFieldInto() uses std::thread
+            set(THREADS_PREFER_PTHREAD_FLAG TRUE)
+            find_package(Threads REQUIRED)
+            set_property(TARGET Magnum::${_component} APPEND PROPERTY
+                INTERFACE_LINK_LIBRARIES Threads::Threads)
+
         # Trade library
         elseif(_component STREQUAL Trade)
+            # parallelLoadMeshes() and parallelLoadImages2D() use std::thread
+            set(THREADS_PREFER_PTHREAD_FLAG TRUE)
+            find_package(Threads REQUIRED)
             set_property(TARGET Magnum::${_component} APPEND PROPERTY
-                INTERFACE_LINK_LIBRARIES Corrade::PluginManager)
+                INTERFACE_LINK_LIBRARIES Corrade::PluginManager Threads::Threads)
 
         # Vk library
         elseif(_component STREQUAL Vk)
@@ -936,8 +982,11 @@ foreach(_component ${Magnum_FIND_COMPONENTS})
         # No special setup for AnyImageConverter plugin
         # No special setup for AnyImageImporter plugin
         # No special setup for AnySceneImporter plugin
+        # No special setup for BlockCompressionImageConverter plugin
         # No special setup for MagnumFont plugin
         # No special setup for MagnumFontConverter plugin
+        # No special setup for MagnumImporter plugin
+        # No special setup for MagnumSceneConverter plugin
         # No special setup for ObjImporter plugin
         # No special setup for TgaImageConverter plugin
         # No special setup for TgaImporter plugin
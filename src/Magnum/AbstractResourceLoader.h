@@ -29,6 +29,7 @@
  * @brief Class @ref Magnum::AbstractResourceLoader
  */
 
+#include <chrono>
 #include <string>
 
 #include "Magnum/ResourceManager.h"
@@ -75,6 +76,13 @@ the following code, however, the loader destroys itself (and removes itself
 from the manager) before the manager is destroyed.
 
 @snippet Magnum.cpp AbstractResourceLoader-use
+
+@section AbstractResourceLoader-async Asynchronous loading
+
+For loading on background threads without blocking
+@ref ResourceManager::get(), subclass @ref AsyncResourceLoader instead. It
+decodes the data on a worker thread and finishes the loading in
+@ref ResourceManager::update() called on the main thread.
 */
 template<class T> class AbstractResourceLoader {
     public:
@@ -126,6 +134,22 @@ template<class T> class AbstractResourceLoader {
          */
         void load(ResourceKey key);
 
+        /**
+         * @brief Process loaded resources
+         * @param budget    Time budget. If zero, all resources that are
+         *      ready are processed.
+         * @return Count of processed resources
+         * @m_since_latest
+         *
+         * Called from @ref ResourceManager::update(). Asynchronous loaders
+         * such as @ref AsyncResourceLoader pass the resources that finished
+         * loading in the background to the manager here. The default
+         * implementation does nothing and returns @cpp 0 @ce.
+         */
+        std::size_t update(std::chrono::nanoseconds budget = {}) {
+            return doUpdate(budget);
+        }
+
     protected:
         /**
          * @brief Set loaded resource to resource manager
@@ -143,16 +167,16 @@ template<class T> class AbstractResourceLoader {
          * use the convenience @ref setNotFound() variant.
          * @see @ref loadedCount()
          */
-        void set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy);
+        void set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy, std::size_t size = 0);
 
         /** @overload */
-        void set(ResourceKey key, Containers::Pointer<T> data, ResourceDataState state, ResourcePolicy policy) {
-            return set(key, data.release(), state, policy);
+        void set(ResourceKey key, Containers::Pointer<T> data, ResourceDataState state, ResourcePolicy policy, std::size_t size = 0) {
+            return set(key, data.release(), state, policy, size);
         }
 
         /** @overload */
-        template<class U, class = typename std::enable_if<!std::is_same<typename std::decay<U>::type, std::nullptr_t>::value>::type> void set(ResourceKey key, U&& data, ResourceDataState state, ResourcePolicy policy) {
-            set(key, new typename std::decay<U>::type(std::forward<U>(data)), state, policy);
+        template<class U, class = typename std::enable_if<!std::is_same<typename std::decay<U>::type, std::nullptr_t>::value>::type> void set(ResourceKey key, U&& data, ResourceDataState state, ResourcePolicy policy, std::size_t size = 0) {
+            set(key, new typename std::decay<U>::type(std::forward<U>(data)), state, policy, size);
         }
 
         /**
@@ -206,6 +230,14 @@ template<class T> class AbstractResourceLoader {
          */
         virtual void doLoad(ResourceKey key) = 0;
 
+        /**
+         * @brief Implementation for @ref update()
+         * @m_since_latest
+         *
+         * Default implementation does nothing and returns @cpp 0 @ce.
+         */
+        virtual std::size_t doUpdate(std::chrono::nanoseconds budget);
+
     private:
         #ifndef DOXYGEN_GENERATING_OUTPUT /* https://bugzilla.gnome.org/show_bug.cgi?id=776986 */
         friend Implementation::ResourceManagerData<T>;
@@ -223,6 +255,8 @@ template<class T> AbstractResourceLoader<T>::~AbstractResourceLoader() {
 
 template<class T> std::string AbstractResourceLoader<T>::doName(ResourceKey) const { return {}; }
 
+template<class T> std::size_t AbstractResourceLoader<T>::doUpdate(std::chrono::nanoseconds) { return 0; }
+
 template<class T> void AbstractResourceLoader<T>::load(ResourceKey key) {
     ++_requestedCount;
     /** @todo What policy for loading resources? */
@@ -231,10 +265,10 @@ template<class T> void AbstractResourceLoader<T>::load(ResourceKey key) {
     doLoad(key);
 }
 
-template<class T> void AbstractResourceLoader<T>::set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy) {
+template<class T> void AbstractResourceLoader<T>::set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy, std::size_t size) {
     if(data) ++_loadedCount;
     if(!data && state == ResourceDataState::NotFound) ++_notFoundCount;
-    manager->set(key, data, state, policy);
+    manager->set(key, data, state, policy, size);
 }
 
 }
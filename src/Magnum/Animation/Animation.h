@@ -44,6 +44,7 @@ template<class V> using ResultOf = typename Implementation::ResultTraits<V>::Typ
 enum class Interpolation: UnsignedByte;
 enum class Extrapolation: UnsignedByte;
 
+template<class K> class KeyframeLookup;
 template<class T, class K = T> class Player;
 
 template<class K, class V, class R = ResultOf<V>> class Track;
@@ -0,0 +1,124 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Blend.h"
+
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Math/Quaternion.h"
+
+namespace Magnum { namespace Animation {
+
+namespace {
+
+inline Vector3 blend(const Vector3& a, const Vector3& b, const Float t) {
+    return Math::lerp(a, b, t);
+}
+
+inline Quaternion blend(const Quaternion& a, const Quaternion& b, const Float t) {
+    /* Math::lerpShortestPath() without the normalization assertions, which
+       would be checked for every element otherwise */
+    const Float tb = Math::dot(a, b) < 0.0f ? -t : t;
+    return (a*(1.0f - t) + b*tb).normalized();
+}
+
+inline Vector3 blendAdditive(const Vector3& a, const Vector3& b, const Float t) {
+    return a + b*t;
+}
+
+inline Quaternion blendAdditive(const Quaternion& a, const Quaternion& b, const Float t) {
+    return a*blend(Quaternion{}, b, t);
+}
+
+/* If the mask is empty, the weight is applied uniformly. The branch is
+   outside of the loops to keep them tight. */
+template<class T, T(*f)(const T&, const T&, Float)> void blendIntoImplementation(const Containers::StridedArrayView1D<const T>& pose, const Float weight, const Containers::StridedArrayView1D<const Float>& mask, const Containers::StridedArrayView1D<T>& destination) {
+    if(mask.isEmpty()) for(std::size_t i = 0; i != pose.size(); ++i)
+        destination[i] = f(destination[i], pose[i], weight);
+    else for(std::size_t i = 0; i != pose.size(); ++i)
+        destination[i] = f(destination[i], pose[i], weight*mask[i]);
+}
+
+}
+
+void blendInto(const Containers::StridedArrayView1D<const Vector3>& pose, const Float weight, const Containers::StridedArrayView1D<const Float>& mask, const Containers::StridedArrayView1D<Vector3>& destination) {
+    CORRADE_ASSERT(destination.size() == pose.size(),
+        "Animation::blendInto(): expected destination view with" << pose.size() << "elements but got" << destination.size(), );
+    CORRADE_ASSERT(mask.size() == pose.size(),
+        "Animation::blendInto(): expected mask view with" << pose.size() << "elements but got" << mask.size(), );
+    /* An empty mask is treated as no mask by the implementation, but that
+       only happens if the pose is empty as well so it doesn't matter */
+    blendIntoImplementation<Vector3, blend>(pose, weight, mask, destination);
+}
+
+void blendInto(const Containers::StridedArrayView1D<const Vector3>& pose, const Float weight, const Containers::StridedArrayView1D<Vector3>& destination) {
+    CORRADE_ASSERT(destination.size() == pose.size(),
+        "Animation::blendInto(): expected destination view with" << pose.size() << "elements but got" << destination.size(), );
+    blendIntoImplementation<Vector3, blend>(pose, weight, nullptr, destination);
+}
+
+void blendInto(const Containers::StridedArrayView1D<const Quaternion>& pose, const Float weight, const Containers::StridedArrayView1D<const Float>& mask, const Containers::StridedArrayView1D<Quaternion>& destination) {
+    CORRADE_ASSERT(destination.size() == pose.size(),
+        "Animation::blendInto(): expected destination view with" << pose.size() << "elements but got" << destination.size(), );
+    CORRADE_ASSERT(mask.size() == pose.size(),
+        "Animation::blendInto(): expected mask view with" << pose.size() << "elements but got" << mask.size(), );
+    blendIntoImplementation<Quaternion, blend>(pose, weight, mask, destination);
+}
+
+void blendInto(const Containers::StridedArrayView1D<const Quaternion>& pose, const Float weight, const Containers::StridedArrayView1D<Quaternion>& destination) {
+    CORRADE_ASSERT(destination.size() == pose.size(),
+        "Animation::blendInto(): expected destination view with" << pose.size() << "elements but got" << destination.size(), );
+    blendIntoImplementation<Quaternion, blend>(pose, weight, nullptr, destination);
+}
+
+void blendAdditiveInto(const Containers::StridedArrayView1D<const Vector3>& pose, const Float weight, const Containers::StridedArrayView1D<const Float>& mask, const Containers::StridedArrayView1D<Vector3>& destination) {
+    CORRADE_ASSERT(destination.size() == pose.size(),
+        "Animation::blendAdditiveInto(): expected destination view with" << pose.size() << "elements but got" << destination.size(), );
+    CORRADE_ASSERT(mask.size() == pose.size(),
+        "Animation::blendAdditiveInto(): expected mask view with" << pose.size() << "elements but got" << mask.size(), );
+    blendIntoImplementation<Vector3, blendAdditive>(pose, weight, mask, destination);
+}
+
+void blendAdditiveInto(const Containers::StridedArrayView1D<const Vector3>& pose, const Float weight, const Containers::StridedArrayView1D<Vector3>& destination) {
+    CORRADE_ASSERT(destination.size() == pose.size(),
+        "Animation::blendAdditiveInto(): expected destination view with" << pose.size() << "elements but got" << destination.size(), );
+    blendIntoImplementation<Vector3, blendAdditive>(pose, weight, nullptr, destination);
+}
+
+void blendAdditiveInto(const Containers::StridedArrayView1D<const Quaternion>& pose, const Float weight, const Containers::StridedArrayView1D<const Float>& mask, const Containers::StridedArrayView1D<Quaternion>& destination) {
+    CORRADE_ASSERT(destination.size() == pose.size(),
+        "Animation::blendAdditiveInto(): expected destination view with" << pose.size() << "elements but got" << destination.size(), );
+    CORRADE_ASSERT(mask.size() == pose.size(),
+        "Animation::blendAdditiveInto(): expected mask view with" << pose.size() << "elements but got" << mask.size(), );
+    blendIntoImplementation<Quaternion, blendAdditive>(pose, weight, mask, destination);
+}
+
+void blendAdditiveInto(const Containers::StridedArrayView1D<const Quaternion>& pose, const Float weight, const Containers::StridedArrayView1D<Quaternion>& destination) {
+    CORRADE_ASSERT(destination.size() == pose.size(),
+        "Animation::blendAdditiveInto(): expected destination view with" << pose.size() << "elements but got" << destination.size(), );
+    blendIntoImplementation<Quaternion, blendAdditive>(pose, weight, nullptr, destination);
+}
+
+}}
@@ -0,0 +1,149 @@
+#ifndef Magnum_Animation_Blend_h
+#define Magnum_Animation_Blend_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::Animation::blendInto(), @ref Magnum::Animation::blendAdditiveInto()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum { namespace Animation {
+
+/**
+@brief Blend a pose into another
+@param pose         Pose to blend in
+@param weight       Blend weight
+@param mask         Per-element weight multiplier
+@param destination  Pose to blend into
+@m_since_latest
+
+Meant for layered animation, where each layer is a pose stored as separate
+arrays of translations, rotations and scalings for all bones. Each layer is
+evaluated by a @ref Player with tracks added via @ref Player::addBatch() that
+write directly into the layer arrays, after which the layers are blended
+together in a single tight loop for all bones, without any per-bone callbacks
+or temporaries:
+
+@snippet MagnumAnimation.cpp blendInto
+
+Every value in @p destination is replaced with a @ref Math::lerp() between
+itself and the corresponding value in @p pose, with the interpolation factor
+being @p weight multiplied by the corresponding value in @p mask. A mask value
+of @cpp 0.0f @ce thus leaves the destination value untouched, which can be
+used to apply a layer only to a subset of the skeleton. Expects that
+@p destination and @p mask have the same size as @p pose.
+@see @ref blendAdditiveInto()
+*/
+MAGNUM_EXPORT void blendInto(const Containers::StridedArrayView1D<const Vector3>& pose, Float weight, const Containers::StridedArrayView1D<const Float>& mask, const Containers::StridedArrayView1D<Vector3>& destination);
+
+/**
+@brief Blend a pose into another with a uniform weight
+@m_since_latest
+
+Same as @ref blendInto(const Containers::StridedArrayView1D<const Vector3>&, Float, const Containers::StridedArrayView1D<const Float>&, const Containers::StridedArrayView1D<Vector3>&)
+with all mask values being @cpp 1.0f @ce.
+*/
+MAGNUM_EXPORT void blendInto(const Containers::StridedArrayView1D<const Vector3>& pose, Float weight, const Containers::StridedArrayView1D<Vector3>& destination);
+
+/**
+@brief Blend a rotation pose into another
+@m_since_latest
+
+Like @ref blendInto(const Containers::StridedArrayView1D<const Vector3>&, Float, const Containers::StridedArrayView1D<const Float>&, const Containers::StridedArrayView1D<Vector3>&),
+but the values are blended with a normalized linear interpolation along the
+shortest path, equivalent to @ref Math::lerpShortestPath(const Quaternion<T>&, const Quaternion<T>&, T).
+Compared to @ref Math::slerp() it's significantly cheaper and the difference
+is negligible for the small angles usually involved in pose blending. Expects
+that the quaternions are normalized, but doesn't check that in order to keep
+the loop tight.
+*/
+MAGNUM_EXPORT void blendInto(const Containers::StridedArrayView1D<const Quaternion>& pose, Float weight, const Containers::StridedArrayView1D<const Float>& mask, const Containers::StridedArrayView1D<Quaternion>& destination);
+
+/**
+@brief Blend a rotation pose into another with a uniform weight
+@m_since_latest
+
+Same as @ref blendInto(const Containers::StridedArrayView1D<const Quaternion>&, Float, const Containers::StridedArrayView1D<const Float>&, const Containers::StridedArrayView1D<Quaternion>&)
+with all mask values being @cpp 1.0f @ce.
+*/
+MAGNUM_EXPORT void blendInto(const Containers::StridedArrayView1D<const Quaternion>& pose, Float weight, const Containers::StridedArrayView1D<Quaternion>& destination);
+
+/**
+@brief Additively blend a pose into another
+@param pose         Pose difference to add
+@param weight       Blend weight
+@param mask         Per-element weight multiplier
+@param destination  Pose to blend into
+@m_since_latest
+
+Adds the corresponding value in @p pose, multiplied by @p weight and the
+corresponding value in @p mask, to every value in @p destination. Useful for
+layering for example a breathing or a leaning animation, authored as a
+difference from a reference pose, on top of an arbitrary base pose. Expects
+that @p destination and @p mask have the same size as @p pose.
+@see @ref blendInto()
+*/
+MAGNUM_EXPORT void blendAdditiveInto(const Containers::StridedArrayView1D<const Vector3>& pose, Float weight, const Containers::StridedArrayView1D<const Float>& mask, const Containers::StridedArrayView1D<Vector3>& destination);
+
+/**
+@brief Additively blend a pose into another with a uniform weight
+@m_since_latest
+
+Same as @ref blendAdditiveInto(const Containers::StridedArrayView1D<const Vector3>&, Float, const Containers::StridedArrayView1D<const Float>&, const Containers::StridedArrayView1D<Vector3>&)
+with all mask values being @cpp 1.0f @ce.
+*/
+MAGNUM_EXPORT void blendAdditiveInto(const Containers::StridedArrayView1D<const Vector3>& pose, Float weight, const Containers::StridedArrayView1D<Vector3>& destination);
+
+/**
+@brief Additively blend a rotation pose into another
+@m_since_latest
+
+Like @ref blendAdditiveInto(const Containers::StridedArrayView1D<const Vector3>&, Float, const Containers::StridedArrayView1D<const Float>&, const Containers::StridedArrayView1D<Vector3>&),
+but every value in @p destination is multiplied by the corresponding rotation
+in @p pose, scaled by blending it with an identity rotation. The same
+normalized linear interpolation as in @ref blendInto(const Containers::StridedArrayView1D<const Quaternion>&, Float, const Containers::StridedArrayView1D<const Float>&, const Containers::StridedArrayView1D<Quaternion>&)
+is used for the scaling. Expects that the quaternions are normalized, but
+doesn't check that in order to keep the loop tight.
+*/
+MAGNUM_EXPORT void blendAdditiveInto(const Containers::StridedArrayView1D<const Quaternion>& pose, Float weight, const Containers::StridedArrayView1D<const Float>& mask, const Containers::StridedArrayView1D<Quaternion>& destination);
+
+/**
+@brief Additively blend a rotation pose into another with a uniform weight
+@m_since_latest
+
+Same as @ref blendAdditiveInto(const Containers::StridedArrayView1D<const Quaternion>&, Float, const Containers::StridedArrayView1D<const Float>&, const Containers::StridedArrayView1D<Quaternion>&)
+with all mask values being @cpp 1.0f @ce.
+*/
+MAGNUM_EXPORT void blendAdditiveInto(const Containers::StridedArrayView1D<const Quaternion>& pose, Float weight, const Containers::StridedArrayView1D<Quaternion>& destination);
+
+}}
+
+#endif
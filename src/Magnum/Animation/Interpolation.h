@@ -26,7 +26,7 @@
 */
 
 /** @file
- * @brief Alias @ref Magnum::Animation::ResultOf, enum @ref Magnum::Animation::Interpolation. @ref Magnum::Animation::Extrapolation, function @ref Magnum::Animation::interpolatorFor(), @ref Magnum::Animation::interpolate(), @ref Magnum::Animation::interpolateStrict(), @ref Magnum::Animation::ease(), @ref Magnum::Animation::easeClamped() @ref Magnum::Animation::unpack(), @ref Magnum::Animation::unpackEase(), @ref Magnum::Animation::unpackEaseClamped()
+ * @brief Alias @ref Magnum::Animation::ResultOf, enum @ref Magnum::Animation::Interpolation. @ref Magnum::Animation::Extrapolation, function @ref Magnum::Animation::interpolatorFor(), @ref Magnum::Animation::interpolate(), @ref Magnum::Animation::interpolateStrict(), @ref Magnum::Animation::interpolateInto(), @ref Magnum::Animation::interpolateStrictInto(), @ref Magnum::Animation::ease(), @ref Magnum::Animation::easeClamped() @ref Magnum::Animation::unpack(), @ref Magnum::Animation::unpackEase(), @ref Magnum::Animation::unpackEaseClamped()
  */
 
 #include <Corrade/Containers/StridedArrayView.h>
@@ -223,6 +223,73 @@ Used internally from @ref Track::atStrict() / @ref TrackView::atStrict(), see
 */
 template<class K, class V, class R = ResultOf<V>> R interpolateStrict(const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView1D<const V>& values, R(*interpolator)(const V&, const V&, Float), K frame, std::size_t& hint);
 
+/**
+@brief Interpolate a batch of animation values sharing the same keys
+@tparam K           Key type
+@tparam V           Value type
+@tparam R           Result type
+@param keys         Keys
+@param values       Values. First dimension is keyframes, second tracks.
+@param before       Extrapolation mode before first keyframe
+@param after        Extrapolation mode after last keyframe
+@param interpolator Interpolator function
+@param frame        Frame at which to interpolate
+@param hint         Hint for keyframe search
+@param destination  Where to put the interpolated values
+@m_since_latest
+
+Batch variant of @ref interpolate() for tracks that share the same keyframe
+times, which is the usual case for animations exported from DCC tools. The
+keyframe search and the interpolation factor calculation is done just once,
+after which @p interpolator is called for each track, writing the result to
+the corresponding item of @p destination. Extrapolation, single-keyframe and
+no-keyframe behavior is the same as in @ref interpolate().
+
+Expects that the first dimension of @p values has the same size as @p keys and
+that @p destination has the same size as the second dimension of @p values.
+Contiguous views are processed in a tight loop that the compiler can vectorize
+if @p interpolator gets inlined --- see @ref interpolateInto(const Containers::StridedArrayView1D<const K>&, const Containers::StridedArrayView2D<const V>&, Extrapolation, Extrapolation, K, std::size_t&, const Containers::StridedArrayView1D<R>&)
+for a variant taking the interpolator as a template parameter.
+@see @ref interpolateStrictInto(), @ref Player::addBatch()
+@experimental
+*/
+template<class K, class V, class R = ResultOf<V>> void interpolateInto(const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView2D<const V>& values, Extrapolation before, Extrapolation after, R(*interpolator)(const V&, const V&, Float), K frame, std::size_t& hint, const Containers::StridedArrayView1D<R>& destination);
+
+/**
+@brief Interpolate a batch of animation values sharing the same keys with a compile-time interpolator
+@m_since_latest
+
+Same as @ref interpolateInto(const Containers::StridedArrayView1D<const K>&, const Containers::StridedArrayView2D<const V>&, Extrapolation, Extrapolation, R(*)(const V&, const V&, Float), K, std::size_t&, const Containers::StridedArrayView1D<R>&),
+but with the interpolator known at compile time, allowing the compiler to
+inline it into the per-track loop. Example usage:
+
+@snippet MagnumAnimation.cpp interpolateInto
+@experimental
+*/
+template<class K, class V, class R, R(*interpolator)(const V&, const V&, Float)> void interpolateInto(const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView2D<const V>& values, Extrapolation before, Extrapolation after, K frame, std::size_t& hint, const Containers::StridedArrayView1D<R>& destination);
+
+/**
+@brief Interpolate a batch of animation values sharing the same keys with strict constraints
+@m_since_latest
+
+Batch variant of @ref interpolateStrict(), see
+@ref interpolateInto(const Containers::StridedArrayView1D<const K>&, const Containers::StridedArrayView2D<const V>&, Extrapolation, Extrapolation, R(*)(const V&, const V&, Float), K, std::size_t&, const Containers::StridedArrayView1D<R>&)
+for more information. Expects that there are always at least two keyframes.
+@experimental
+*/
+template<class K, class V, class R = ResultOf<V>> void interpolateStrictInto(const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView2D<const V>& values, R(*interpolator)(const V&, const V&, Float), K frame, std::size_t& hint, const Containers::StridedArrayView1D<R>& destination);
+
+/**
+@brief Interpolate a batch of animation values sharing the same keys with strict constraints and a compile-time interpolator
+@m_since_latest
+
+Same as @ref interpolateStrictInto(const Containers::StridedArrayView1D<const K>&, const Containers::StridedArrayView2D<const V>&, R(*)(const V&, const V&, Float), K, std::size_t&, const Containers::StridedArrayView1D<R>&),
+but with the interpolator known at compile time, allowing the compiler to
+inline it into the per-track loop.
+@experimental
+*/
+template<class K, class V, class R, R(*interpolator)(const V&, const V&, Float)> void interpolateStrictInto(const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView2D<const V>& values, K frame, std::size_t& hint, const Containers::StridedArrayView1D<R>& destination);
+
 /**
 @brief Combine easing function and an interpolator
 
@@ -466,6 +533,123 @@ template<class K, class V, class R> R interpolateStrict(const Containers::Stride
         Math::lerpInverted(Float(keys[hint]), Float(keys[hint + 1]), Float(frame)));
 }
 
+namespace Implementation {
+
+/* Shared by interpolateInto() and interpolateStrictInto(). The functor is a
+   template parameter so the compile-time interpolator variants can get it
+   inlined into the loop. */
+template<class V, class R, class Interpolator> void interpolateTracksInto(const Containers::StridedArrayView2D<const V>& values, const std::size_t first, const std::size_t second, const Float t, const Containers::StridedArrayView1D<R>& destination, Interpolator interpolator) {
+    /* Caching values to avoid inline function calls in debug builds */
+    const std::size_t count = destination.size();
+    const std::ptrdiff_t valueStride = values.stride()[1];
+    const std::ptrdiff_t destinationStride = destination.stride();
+    const char* a = static_cast<const char*>(values.data()) + first*values.stride()[0];
+    const char* b = static_cast<const char*>(values.data()) + second*values.stride()[0];
+    char* out = static_cast<char*>(destination.data());
+
+    /* Contiguous data, a loop that's simple enough for the compiler to
+       vectorize */
+    if(valueStride == sizeof(V) && destinationStride == sizeof(R)) {
+        const V* const aValues = reinterpret_cast<const V*>(a);
+        const V* const bValues = reinterpret_cast<const V*>(b);
+        R* const outValues = reinterpret_cast<R*>(out);
+        for(std::size_t i = 0; i != count; ++i)
+            outValues[i] = interpolator(aValues[i], bValues[i], t);
+
+    /* Generic strided variant */
+    } else for(std::size_t i = 0; i != count; ++i, a += valueStride, b += valueStride, out += destinationStride)
+        *reinterpret_cast<R*>(out) = interpolator(*reinterpret_cast<const V*>(a), *reinterpret_cast<const V*>(b), t);
+}
+
+template<class R> void fillDefaultConstructed(const Containers::StridedArrayView1D<R>& destination) {
+    for(R& i: destination) i = R{};
+}
+
+template<class K, class V, class R, class Interpolator> void interpolateInto(const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView2D<const V>& values, const Extrapolation before, const Extrapolation after, Interpolator interpolator, K frame, std::size_t& hint, const Containers::StridedArrayView1D<R>& destination) {
+    CORRADE_ASSERT(keys.size() == values.size()[0],
+        "Animation::interpolateInto(): expected" << keys.size() << "keyframes but got" << values.size()[0], );
+    CORRADE_ASSERT(destination.size() == values.size()[1],
+        "Animation::interpolateInto(): expected destination size to be" << values.size()[1] << "but got" << destination.size(), );
+
+    /* No data, default-construct everything */
+    if(!keys.size()) return fillDefaultConstructed(destination);
+
+    /* Only one frame, use it verbatim (or default-constructed, if desired) */
+    if(keys.size() == 1) {
+        if((frame < keys[0] && before == Extrapolation::DefaultConstructed) ||
+           (frame > keys[0] && after == Extrapolation::DefaultConstructed))
+            return fillDefaultConstructed(destination);
+
+        return interpolateTracksInto(values, 0, 0, 0.0f, destination, interpolator);
+    }
+
+    /* Rewind from the beginning if hint is too late */
+    if(hint >= keys.size() || frame < keys[hint]) hint = 0;
+
+    /* Go through the keys until we find a pair that is around given time */
+    while(hint + 2 < keys.size() && frame >= keys[hint + 1])
+        ++hint;
+
+    /* Special extrapolation outside of range. Usual extrapolation is handled
+       below. */
+    if(frame < keys[hint]) {
+        if(before == Extrapolation::DefaultConstructed)
+            return fillDefaultConstructed(destination);
+        if(before == Extrapolation::Constant) frame = keys[hint];
+    } else if(frame >= keys[hint + 1]) {
+        if(after == Extrapolation::DefaultConstructed)
+            return fillDefaultConstructed(destination);
+        if(after == Extrapolation::Constant) frame = keys[hint + 1];
+    }
+
+    interpolateTracksInto(values, hint, hint + 1,
+        Math::lerpInverted(Float(keys[hint]), Float(keys[hint + 1]), Float(frame)),
+        destination, interpolator);
+}
+
+template<class K, class V, class R, class Interpolator> void interpolateStrictInto(const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView2D<const V>& values, Interpolator interpolator, const K frame, std::size_t& hint, const Containers::StridedArrayView1D<R>& destination) {
+    CORRADE_ASSERT(keys.size() >= 2, "Animation::interpolateStrictInto(): at least two keyframes required", );
+    CORRADE_ASSERT(keys.size() == values.size()[0],
+        "Animation::interpolateStrictInto(): expected" << keys.size() << "keyframes but got" << values.size()[0], );
+    CORRADE_ASSERT(destination.size() == values.size()[1],
+        "Animation::interpolateStrictInto(): expected destination size to be" << values.size()[1] << "but got" << destination.size(), );
+
+    /* Rewind from the beginning if hint is too late */
+    if(hint >= keys.size() || frame < keys[hint]) hint = 0;
+
+    /* Go through the keys until we find a pair that is around given time */
+    while(hint + 2 < keys.size() && frame >= keys[hint + 1])
+        ++hint;
+
+    interpolateTracksInto(values, hint, hint + 1,
+        Math::lerpInverted(Float(keys[hint]), Float(keys[hint + 1]), Float(frame)),
+        destination, interpolator);
+}
+
+template<class V, class R, R(*interpolator)(const V&, const V&, Float)> struct StaticInterpolator {
+    R operator()(const V& a, const V& b, Float t) const {
+        return interpolator(a, b, t);
+    }
+};
+
+}
+
+template<class K, class V, class R> void interpolateInto(const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView2D<const V>& values, const Extrapolation before, const Extrapolation after, R(*const interpolator)(const V&, const V&, Float), const K frame, std::size_t& hint, const Containers::StridedArrayView1D<R>& destination) {
+    Implementation::interpolateInto(keys, values, before, after, interpolator, frame, hint, destination);
+}
+
+template<class K, class V, class R, R(*interpolator)(const V&, const V&, Float)> void interpolateInto(const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView2D<const V>& values, const Extrapolation before, const Extrapolation after, const K frame, std::size_t& hint, const Containers::StridedArrayView1D<R>& destination) {
+    Implementation::interpolateInto(keys, values, before, after, Implementation::StaticInterpolator<V, R, interpolator>{}, frame, hint, destination);
+}
+
+template<class K, class V, class R> void interpolateStrictInto(const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView2D<const V>& values, R(*const interpolator)(const V&, const V&, Float), const K frame, std::size_t& hint, const Containers::StridedArrayView1D<R>& destination) {
+    Implementation::interpolateStrictInto(keys, values, interpolator, frame, hint, destination);
+}
+
+template<class K, class V, class R, R(*interpolator)(const V&, const V&, Float)> void interpolateStrictInto(const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView2D<const V>& values, const K frame, std::size_t& hint, const Containers::StridedArrayView1D<R>& destination) {
+    Implementation::interpolateStrictInto(keys, values, Implementation::StaticInterpolator<V, R, interpolator>{}, frame, hint, destination);
+}
+
 }}
 
 #endif
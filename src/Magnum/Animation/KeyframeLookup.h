@@ -0,0 +1,143 @@
+#ifndef Magnum_Animation_KeyframeLookup_h
+#define Magnum_Animation_KeyframeLookup_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Animation::KeyframeLookup
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Animation/Animation.h"
+
+namespace Magnum { namespace Animation {
+
+/**
+@brief Keyframe lookup table
+@tparam K   Key type
+@m_since_latest
+
+The keyframe search in @ref TrackView::at(K, std::size_t&) const and
+@ref interpolate() is done in amortized constant time for sequential playback,
+but arbitrary seeks backwards have to search linearly from the beginning of
+the track. For long tracks, such as camera paths scrubbed through in a
+timeline editor, that can get slow.
+
+This class splits the time range of a track into uniformly sized buckets and
+remembers the last keyframe preceding each of them. The @ref hint() function
+then returns, in constant time, a hint that's guaranteed to not be after the
+keyframe matching given frame, so the subsequent search has to go only through
+keyframes in a single bucket:
+
+@snippet MagnumAnimation.cpp KeyframeLookup
+
+The table needs one @relativeref{Magnum,UnsignedInt} per bucket and is built
+in @f$ \mathcal{O}(n + b) @f$ for @f$ n @f$ keyframes and @f$ b @f$ buckets.
+It references neither the keys nor the values, but has to be rebuilt if the
+keys change. The @ref Player can build and use the lookup tables for its
+tracks as well, see @ref Player::buildKeyframeLookup() for more information.
+*/
+template<class K> class KeyframeLookup {
+    public:
+        /**
+         * @brief Default constructor
+         *
+         * Creates an empty lookup table, for which @ref hint() always
+         * returns @cpp 0 @ce.
+         */
+        explicit KeyframeLookup() noexcept: _begin{}, _scale{} {}
+
+        /**
+         * @brief Constructor
+         * @param keys          Track keys
+         * @param bucketCount   Count of buckets
+         *
+         * Expects that @p keys are sorted. If @p keys have less than two
+         * items or @p bucketCount is zero, the table is empty.
+         */
+        explicit KeyframeLookup(const Containers::StridedArrayView1D<const K>& keys, std::size_t bucketCount);
+
+        /**
+         * @brief Construct with one bucket per keyframe
+         *
+         * Equivalent to calling @ref KeyframeLookup(const Containers::StridedArrayView1D<const K>&, std::size_t)
+         * with @p bucketCount set to size of @p keys, which makes the search
+         * go through a single keyframe on average for uniformly distributed
+         * keys.
+         */
+        explicit KeyframeLookup(const Containers::StridedArrayView1D<const K>& keys): KeyframeLookup{keys, keys.size()} {}
+
+        /** @brief Bucket count */
+        std::size_t bucketCount() const { return _buckets.size(); }
+
+        /**
+         * @brief Keyframe search hint for given frame
+         *
+         * Returns index of a keyframe that isn't after the keyframe
+         * matching @p frame, suitable to be passed as the hint to
+         * @ref TrackView::at(K, std::size_t&) const or @ref interpolate().
+         * Frames outside of the track range return hints for the first or
+         * last bucket.
+         */
+        std::size_t hint(K frame) const {
+            if(_buckets.isEmpty()) return 0;
+            return _buckets[bucket(frame)];
+        }
+
+    private:
+        std::size_t bucket(K frame) const {
+            const Float position = (Float(frame) - Float(_begin))*_scale;
+            if(!(position > 0.0f)) return 0;
+            return position >= Float(_buckets.size() - 1) ? _buckets.size() - 1 : std::size_t(position);
+        }
+
+        Containers::Array<UnsignedInt> _buckets;
+        K _begin;
+        Float _scale;
+};
+
+template<class K> KeyframeLookup<K>::KeyframeLookup(const Containers::StridedArrayView1D<const K>& keys, const std::size_t bucketCount): _begin{}, _scale{} {
+    if(keys.size() < 2 || !bucketCount || !(keys.back() > keys.front())) return;
+
+    _buckets = Containers::Array<UnsignedInt>{NoInit, bucketCount};
+    _begin = keys.front();
+    _scale = Float(bucketCount)/(Float(keys.back()) - Float(keys.front()));
+
+    /* The bucket function is monotonic, so a keyframe in an earlier bucket
+       than given frame is guaranteed to not be after it. Each bucket thus
+       stores the last keyframe from the preceding buckets. */
+    std::size_t i = 0;
+    for(std::size_t b = 0; b != bucketCount; ++b) {
+        while(i < keys.size() && bucket(keys[i]) < b) ++i;
+        _buckets[b] = i ? i - 1 : 0;
+    }
+}
+
+}}
+
+#endif
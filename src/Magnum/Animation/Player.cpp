@@ -25,8 +25,20 @@
 
 #include "Player.hpp"
 
+#include "Magnum/Implementation/parallelFor.h"
+
 namespace Magnum { namespace Animation {
 
+namespace Implementation {
+
+void playerParallelFor(const std::size_t count, const UnsignedInt threadCount, void(*const f)(std::size_t, std::size_t, void*), void* const state) {
+    Magnum::Implementation::parallelFor(count, threadCount, [f, state](const std::size_t begin, const std::size_t end) {
+        f(begin, end, state);
+    });
+}
+
+}
+
 Debug& operator<<(Debug& debug, const State value) {
     debug << "Animation::State" << Debug::nospace;
 
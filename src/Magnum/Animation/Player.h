@@ -118,6 +118,22 @@ interpolated value changes, which is useful for triggering other events. See
 @ref addRawCallback() that allows for greater control and further performance
 optimizations. See its documentation for a usage example code snippet.
 
+@subsection Animation-Player-setup-batch Batch evaluation
+
+Tracks imported from common file formats usually share the same keyframe
+times across all animated objects. Adding each of them separately means the
+keyframe search and interpolation factor calculation is repeated for every
+track, which for thousands of tracks dominates the @ref advance() cost. In
+that case you can use @ref addBatch() instead, which takes the values of
+all tracks as a 2D view with keyframes in the first dimension and tracks in
+the second, finds the keyframe just once and then interpolates all values in a
+tight loop, writing them to a destination view:
+
+@snippet MagnumAnimation.cpp Player-addBatch
+
+Poses of multiple animation layers evaluated this way can be then combined
+with @ref blendInto() and @ref blendAdditiveInto().
+
 The animation is implicitly played only once, use @ref setPlayCount() to set a
 number of repeats or make it repeat indefinitely. By default, the
 @ref duration() of an animation is calculated implicitly from all added tracks.
@@ -175,7 +191,9 @@ never from @ref pause(), @ref stop() or any other API.
 For managing global application you can use @ref Timeline, @ref std::chrono
 APIs or any other type that supports basic arithmetic. The time doesn't have to
 be monotonic or have constant speed, but note that non-continuous and backward
-time jumps may have worse performance than going monotonically forward. See
+time jumps may have worse performance than going monotonically forward. For
+scrubbing through long tracks, use @ref buildKeyframeLookup() to make seeks
+done with @ref seekBy() / @ref seekTo() take constant time. See
 @ref Animation-Player-time-type "below" for more information about using
 different time types.
 
@@ -224,6 +242,17 @@ a particular animation:
 
 @snippet MagnumAnimation.cpp Player-higher-order-animated-time
 
+@section Animation-Player-parallel Advancing many players in parallel
+
+When there's many independent players, for example one for each animated
+character, these can be advanced on multiple threads using the static
+@ref advance(T, Containers::ArrayView<const Containers::Reference<Player<T, K>>>, UnsignedInt, void(*)(Player<T, K>&, State, void*), void*)
+overload. Detection of players that ran out or otherwise changed their state
+is deferred to the calling thread, so the reaction to it doesn't need to be
+thread-safe:
+
+@snippet MagnumAnimation.cpp Player-advance-parallel
+
 @section Animation-Player-explicit-specializations Explicit template specializations
 
 The following specializations are explicitly compiled into the @ref Animation
@@ -265,6 +294,41 @@ template<class T, class K
          */
         static void advance(T time, std::initializer_list<Containers::Reference<Player<T, K>>> players);
 
+        /**
+         * @brief Advance multiple players in parallel
+         * @param time          Time to advance the players to
+         * @param players       Players to advance
+         * @param threadCount   Max count of threads to use. If @cpp 0 @ce,
+         *      @ref TaskScheduler::threadCount() of
+         *      @ref TaskScheduler::global() is used.
+         * @param stateChanged  Function to call for each player that changed
+         *      its @ref state() during the advance or @cpp nullptr @ce
+         * @param userData      User data passed to @p stateChanged
+         * @m_since_latest
+         *
+         * Equivalent to calling @ref advance(T) for each item in @p players,
+         * but with the players split among up to @p threadCount threads.
+         * Small player counts are always advanced on the calling thread. If
+         * Corrade isn't built with @ref CORRADE_BUILD_MULTITHREADED or when
+         * targeting @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten", the
+         * @p threadCount parameter is ignored and everything is done on the
+         * calling thread.
+         *
+         * Each player is advanced on exactly one thread, so destinations
+         * written by @ref add(), @ref addWithCallbackOnChange() and
+         * @ref addBatch() are safe as long as they're not shared among
+         * multiple players. Callbacks passed to @ref addWithCallback(),
+         * @ref addWithCallbackOnChange() and @ref addRawCallback() are
+         * however called from the worker threads and thus have to be
+         * thread-safe. The @p stateChanged function, on the other hand, is
+         * called on the calling thread after all players are advanced, with
+         * the player reference and its state before the advance, so it can
+         * safely modify arbitrary state. The same player isn't allowed to be
+         * present in @p players more than once.
+         * @see @ref Animation-Player-parallel
+         */
+        static void advance(T time, Containers::ArrayView<const Containers::Reference<Player<T, K>>> players, UnsignedInt threadCount, void(*stateChanged)(Player<T, K>&, State, void*) = nullptr, void* userData = nullptr);
+
         /** @brief Constructor */
         explicit Player();
 
@@ -347,19 +411,32 @@ template<class T, class K
         /**
          * @brief Whether the player is empty
          *
-         * @see @ref size(), @ref add(), @ref addWithCallback(),
-         *      @ref addWithCallbackOnChange(), @ref addRawCallback()
+         * Returns @cpp true @ce if there are neither any tracks nor any
+         * batches.
+         * @see @ref size(), @ref batchCount(), @ref add(),
+         *      @ref addWithCallback(), @ref addWithCallbackOnChange(),
+         *      @ref addRawCallback(), @ref addBatch()
          */
         bool isEmpty() const;
 
         /**
          * @brief Count of tracks managed by this player
          *
+         * Doesn't include tracks added with @ref addBatch(), see
+         * @ref batchCount() for these.
          * @see @ref isEmpty(), @ref add(), @ref addWithCallback(),
          *      @ref addWithCallbackOnChange(), @ref addRawCallback()
          */
         std::size_t size() const;
 
+        /**
+         * @brief Count of track batches managed by this player
+         * @m_since_latest
+         *
+         * @see @ref isEmpty(), @ref addBatch()
+         */
+        std::size_t batchCount() const;
+
         /**
          * @brief Track at given position
          *
@@ -632,6 +709,62 @@ template<class T, class K
         }
         #endif
 
+        /**
+         * @brief Add a batch of tracks sharing the same keys
+         * @param keys          Keys shared by all tracks in the batch
+         * @param values        Track values. First dimension is keyframes,
+         *      second is tracks.
+         * @param interpolator  Interpolator function
+         * @param destination   Where to put the interpolated values
+         * @param before        Extrapolation mode before first keyframe
+         * @param after         Extrapolation mode after last keyframe
+         * @m_since_latest
+         *
+         * The @p destination is updated with new values after each call to
+         * @ref advance() as long as the animation is playing. Compared to
+         * calling @ref add() for each track separately, the keyframe search
+         * is done only once for the whole batch using
+         * @ref interpolateInto(). Expects that the first dimension of
+         * @p values has the same size as @p keys and that @p destination has
+         * the same size as the second dimension of @p values. The views are
+         * referenced, not copied, so you have to ensure they stay in scope
+         * for the whole lifetime of the player instance.
+         *
+         * Use @ref addBatch(const Containers::StridedArrayView1D<const K>&, const Containers::StridedArrayView2D<const V>&, const Containers::StridedArrayView1D<R>&, Extrapolation, Extrapolation)
+         * to have the interpolator inlined into the per-track loop.
+         * @see @ref Animation-Player-setup-batch
+         */
+        template<class V, class R> Player<T, K>& addBatch(const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView2D<const V>& values, R(*interpolator)(const V&, const V&, Float), const Containers::StridedArrayView1D<R>& destination, Extrapolation before, Extrapolation after);
+
+        /**
+         * @overload
+         * @m_since_latest
+         *
+         * Equivalent to calling @ref addBatch(const Containers::StridedArrayView1D<const K>&, const Containers::StridedArrayView2D<const V>&, R(*)(const V&, const V&, Float), const Containers::StridedArrayView1D<R>&, Extrapolation, Extrapolation)
+         * with both @p before and @p after set to @p extrapolation.
+         */
+        template<class V, class R> Player<T, K>& addBatch(const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView2D<const V>& values, R(*interpolator)(const V&, const V&, Float), const Containers::StridedArrayView1D<R>& destination, Extrapolation extrapolation = Extrapolation::Constant) {
+            return addBatch(keys, values, interpolator, destination, extrapolation, extrapolation);
+        }
+
+        /**
+         * @brief Add a batch of tracks sharing the same keys with a compile-time interpolator
+         * @m_since_latest
+         *
+         * Same as @ref addBatch(const Containers::StridedArrayView1D<const K>&, const Containers::StridedArrayView2D<const V>&, R(*)(const V&, const V&, Float), const Containers::StridedArrayView1D<R>&, Extrapolation, Extrapolation),
+         * but with the interpolator known at compile time, allowing the
+         * compiler to inline and vectorize the per-track loop.
+         */
+        template<class V, class R, R(*interpolator)(const V&, const V&, Float)> Player<T, K>& addBatch(const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView2D<const V>& values, const Containers::StridedArrayView1D<R>& destination, Extrapolation before, Extrapolation after);
+
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        template<class V, class R, R(*interpolator)(const V&, const V&, Float)> Player<T, K>& addBatch(const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView2D<const V>& values, const Containers::StridedArrayView1D<R>& destination, Extrapolation extrapolation = Extrapolation::Constant) {
+            return addBatch<V, R, interpolator>(keys, values, destination, extrapolation, extrapolation);
+        }
+
         /**
          * @brief State
          *
@@ -710,6 +843,7 @@ template<class T, class K
          * @note This function doesn't clamp the seek in any way --- so for
          *      example seeking too far back will make the animation wait for
          *      being played from the beginning in the future.
+         * @see @ref buildKeyframeLookup()
          */
         Player<T, K>& seekBy(T timeDelta);
 
@@ -729,9 +863,27 @@ template<class T, class K
          * @note This function doesn't clamp the seek in any way --- so for
          *      example seeking too far back will make the animation wait for
          *      being played from the beginning in the future.
+         * @see @ref buildKeyframeLookup()
          */
         Player<T, K>& seekTo(T seekTime, T animationTime);
 
+        /**
+         * @brief Build keyframe lookup tables for long tracks
+         * @m_since_latest
+         *
+         * Creates a @ref KeyframeLookup with one bucket per keyframe for
+         * every track and batch added so far that has at least
+         * @p minKeyframeCount keyframes. On the first @ref advance() after
+         * @ref seekBy() or @ref seekTo() the lookup tables are then used to
+         * find the keyframe search hints in constant time, instead of
+         * searching linearly from the beginning of the track. Regular
+         * playback is not affected, as the keyframe search is already done in
+         * amortized constant time there. Tracks and batches added after
+         * calling this function have no lookup tables until this function is
+         * called again.
+         */
+        Player<T, K>& buildKeyframeLookup(std::size_t minKeyframeCount = 64);
+
         /**
          * @brief Stop
          *
@@ -762,7 +914,8 @@ template<class T, class K
          * tracks added with @ref add(), @ref addWithCallback() or
          * @ref addWithCallbackOnChange() in order they were added and updates
          * the destination locations and/or fires the callbacks with
-         * interpolation results.
+         * interpolation results. After that, all batches added with
+         * @ref addBatch() are updated, again in order they were added.
          *
          * If @ref state() is @ref State::Paused or @ref State::Stopped, the
          * function does nothing. If @p time is less than time that was passed
@@ -802,15 +955,19 @@ template<class T, class K
 
     private:
         struct Track;
+        struct Batch;
 
         Player<T, K>& addInternal(const TrackViewStorage<const K>& track, void (*advancer)(const TrackViewStorage<const K>&, K, std::size_t&, void*, void(*)(), void*), void* destination, void(*userCallback)(), void* userCallbackData);
+        Player<T, K>& addBatchInternal(const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView2D<const char>& values, Extrapolation before, Extrapolation after, void(*interpolator)(), void(*advancer)(const Containers::StridedArrayView1D<const K>&, const Containers::StridedArrayView2D<const char>&, Extrapolation, Extrapolation, void(*)(), K, std::size_t&, const Containers::StridedArrayView1D<char>&), const Containers::StridedArrayView1D<char>& destination);
 
         Containers::Optional<std::pair<UnsignedInt, K>> elapsedInternal(T time, T& updatedStartTime, T& updatedPauseTime, State& updatedState) const;
 
         Containers::Array<Track> _tracks;
+        Containers::Array<Batch> _batches;
         Math::Range1D<K> _duration;
         UnsignedInt _playCount{1};
         State _state{State::Stopped};
+        bool _seeked{};
         T _startTime{}, _stopPauseTime{};
         Scaler _scaler;
 };
@@ -871,6 +1028,32 @@ template<class T, class K> template<class V, class R, class Callback> Player<T,
 }
 #endif
 
+template<class T, class K> template<class V, class R> Player<T, K>& Player<T, K>::addBatch(const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView2D<const V>& values, R(*const interpolator)(const V&, const V&, Float), const Containers::StridedArrayView1D<R>& destination, const Extrapolation before, const Extrapolation after) {
+    return addBatchInternal(keys,
+        reinterpret_cast<const Containers::StridedArrayView2D<const char>&>(values),
+        before, after, reinterpret_cast<void(*)()>(interpolator),
+        [](const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView2D<const char>& values, Extrapolation before, Extrapolation after, void(*interpolator)(), K key, std::size_t& hint, const Containers::StridedArrayView1D<char>& destination) {
+            interpolateInto(keys,
+                reinterpret_cast<const Containers::StridedArrayView2D<const V>&>(values),
+                before, after,
+                reinterpret_cast<R(*)(const V&, const V&, Float)>(interpolator),
+                key, hint,
+                reinterpret_cast<const Containers::StridedArrayView1D<R>&>(destination));
+        }, reinterpret_cast<const Containers::StridedArrayView1D<char>&>(destination));
+}
+
+template<class T, class K> template<class V, class R, R(*interpolator)(const V&, const V&, Float)> Player<T, K>& Player<T, K>::addBatch(const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView2D<const V>& values, const Containers::StridedArrayView1D<R>& destination, const Extrapolation before, const Extrapolation after) {
+    return addBatchInternal(keys,
+        reinterpret_cast<const Containers::StridedArrayView2D<const char>&>(values),
+        before, after, nullptr,
+        [](const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView2D<const char>& values, Extrapolation before, Extrapolation after, void(*)(), K key, std::size_t& hint, const Containers::StridedArrayView1D<char>& destination) {
+            interpolateInto<K, V, R, interpolator>(keys,
+                reinterpret_cast<const Containers::StridedArrayView2D<const V>&>(values),
+                before, after, key, hint,
+                reinterpret_cast<const Containers::StridedArrayView1D<R>&>(destination));
+        }, reinterpret_cast<const Containers::StridedArrayView1D<char>&>(destination));
+}
+
 #if defined(CORRADE_TARGET_WINDOWS) && !(defined(CORRADE_TARGET_MINGW) && !defined(CORRADE_TARGET_CLANG))
 extern template class MAGNUM_EXPORT Player<Float, Float>;
 extern template class MAGNUM_EXPORT Player<std::chrono::nanoseconds, Float>;
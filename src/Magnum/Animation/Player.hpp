@@ -35,6 +35,8 @@
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/Reference.h>
 
+#include "Magnum/Animation/KeyframeLookup.h"
+
 namespace Magnum { namespace Animation {
 
 namespace Implementation {
@@ -69,6 +71,20 @@ template<class T, class K> struct Player<T, K>::Track  {
     void(*userCallback)();
     void* userCallbackData;
     std::size_t hint;
+    KeyframeLookup<K> lookup;
+};
+
+template<class T, class K> struct Player<T, K>::Batch  {
+    /*implicit*/ Batch(const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView2D<const char>& values, Extrapolation before, Extrapolation after, void(*interpolator)(), void(*advancer)(const Containers::StridedArrayView1D<const K>&, const Containers::StridedArrayView2D<const char>&, Extrapolation, Extrapolation, void(*)(), K, std::size_t&, const Containers::StridedArrayView1D<char>&), const Containers::StridedArrayView1D<char>& destination, std::size_t hint) noexcept: keys{keys}, values{values}, before{before}, after{after}, interpolator{interpolator}, advancer{advancer}, destination{destination}, hint{hint} {}
+
+    Containers::StridedArrayView1D<const K> keys;
+    Containers::StridedArrayView2D<const char> values;
+    Extrapolation before, after;
+    void(*interpolator)();
+    void(*advancer)(const Containers::StridedArrayView1D<const K>&, const Containers::StridedArrayView2D<const char>&, Extrapolation, Extrapolation, void(*)(), K, std::size_t&, const Containers::StridedArrayView1D<char>&);
+    Containers::StridedArrayView1D<char> destination;
+    std::size_t hint;
+    KeyframeLookup<K> lookup;
 };
 #endif
 
@@ -76,6 +92,43 @@ template<class T, class K> void Player<T, K>::advance(const T time, const std::i
     for(Player<T, K>& p: players) p.advance(time);
 }
 
+namespace Implementation {
+    /* Calls f(begin, end, state) on up to threadCount disjoint parts of
+       [0, count). Implemented in Player.cpp so the threading implementation
+       doesn't need to be included here. */
+    MAGNUM_EXPORT void playerParallelFor(std::size_t count, UnsignedInt threadCount, void(*f)(std::size_t, std::size_t, void*), void* state);
+
+    /* Advancing a player is cheap, so give each thread at least this many to
+       amortize the thread creation */
+    enum: std::size_t { PlayersPerThread = 64 };
+}
+
+template<class T, class K> void Player<T, K>::advance(const T time, const Containers::ArrayView<const Containers::Reference<Player<T, K>>> players, const UnsignedInt threadCount, void(*const stateChanged)(Player<T, K>&, State, void*), void* const userData) {
+    /* Remember the states to fire the callbacks for the changed ones later on
+       the calling thread */
+    Containers::Array<State> states;
+    if(stateChanged) {
+        states = Containers::Array<State>{NoInit, players.size()};
+        for(std::size_t i = 0; i != players.size(); ++i)
+            states[i] = players[i]->_state;
+    }
+
+    struct Data {
+        T time;
+        Containers::ArrayView<const Containers::Reference<Player<T, K>>> players;
+    } data{time, players};
+    Implementation::playerParallelFor((players.size() + Implementation::PlayersPerThread - 1)/Implementation::PlayersPerThread, threadCount, [](const std::size_t begin, const std::size_t end, void* const state) {
+        const Data& d = *static_cast<const Data*>(state);
+        const std::size_t playerEnd = Math::min(end*Implementation::PlayersPerThread, d.players.size());
+        for(std::size_t i = begin*Implementation::PlayersPerThread; i < playerEnd; ++i)
+            d.players[i]->advance(d.time);
+    }, &data);
+
+    if(stateChanged) for(std::size_t i = 0; i != players.size(); ++i)
+        if(players[i]->_state != states[i])
+            stateChanged(players[i], states[i], userData);
+}
+
 template<class T, class K> Player<T, K>::Player(Player<T, K>&&) noexcept = default;
 
 template<class T, class K> Player<T, K>& Player<T, K>::operator=(Player<T, K>&&) noexcept = default;
@@ -87,13 +140,17 @@ template<class T, class K> Player<T, K>::Player(Scaler scaler): _scaler{scaler}
 template<class T, class K> Player<T, K>::~Player() = default;
 
 template<class T, class K> bool Player<T, K>::isEmpty() const {
-    return _tracks.isEmpty();
+    return _tracks.isEmpty() && _batches.isEmpty();
 }
 
 template<class T, class K> std::size_t Player<T, K>::size() const {
     return _tracks.size();
 }
 
+template<class T, class K> std::size_t Player<T, K>::batchCount() const {
+    return _batches.size();
+}
+
 template<class T, class K> const TrackViewStorage<const K>& Player<T, K>::track(std::size_t i) const {
     CORRADE_ASSERT(i < _tracks.size(),
         /* Returning track 0 so we can test this w/ MSVC debug iterators */
@@ -102,7 +159,7 @@ template<class T, class K> const TrackViewStorage<const K>& Player<T, K>::track(
 }
 
 template<class T, class K> Player<T, K>& Player<T, K>::addInternal(const TrackViewStorage<const K>& track, void(*const advancer)(const TrackViewStorage<const K>&, K, std::size_t&, void*, void(*)(), void*), void* const destination, void(*const userCallback)(), void* const userCallbackData) {
-    if(_tracks.isEmpty() && _duration == Math::Range1D<K>{})
+    if(isEmpty() && _duration == Math::Range1D<K>{})
         _duration = track.duration();
     else
         _duration = Math::join(track.duration(), _duration);
@@ -110,6 +167,22 @@ template<class T, class K> Player<T, K>& Player<T, K>::addInternal(const TrackVi
     return *this;
 }
 
+template<class T, class K> Player<T, K>& Player<T, K>::addBatchInternal(const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView2D<const char>& values, const Extrapolation before, const Extrapolation after, void(*const interpolator)(), void(*const advancer)(const Containers::StridedArrayView1D<const K>&, const Containers::StridedArrayView2D<const char>&, Extrapolation, Extrapolation, void(*)(), K, std::size_t&, const Containers::StridedArrayView1D<char>&), const Containers::StridedArrayView1D<char>& destination) {
+    CORRADE_ASSERT(keys.size() == values.size()[0],
+        "Animation::Player::addBatch(): expected" << keys.size() << "keyframes but got" << values.size()[0], *this);
+    CORRADE_ASSERT(destination.size() == values.size()[1],
+        "Animation::Player::addBatch(): expected destination size to be" << values.size()[1] << "but got" << destination.size(), *this);
+
+    /* Same as duration of a TrackView */
+    const Math::Range1D<K> duration = keys.isEmpty() ? Math::Range1D<K>{} : Math::Range1D<K>{keys.front(), keys.back()};
+    if(isEmpty() && _duration == Math::Range1D<K>{})
+        _duration = duration;
+    else
+        _duration = Math::join(duration, _duration);
+    arrayAppend(_batches, InPlaceInit, keys, values, before, after, interpolator, advancer, destination, 0u);
+    return *this;
+}
+
 template<class T, class K> Player<T, K>& Player<T, K>::play(T startTime) {
     /* In case we were paused, move start time backwards by the duration that
        was already played back */
@@ -142,6 +215,10 @@ template<class T, class K> Player<T, K>& Player<T, K>::seekBy(T timeDelta) {
     /* Animation is stopped, nothing to do */
     if(_state == State::Stopped) return *this;
 
+    /* Make the next advance() restore the keyframe hints from the lookup
+       tables, if there are any */
+    _seeked = true;
+
     /* If the animation is paused and parked already, trigger a "park" again in
        order to have the values updated on the next call to advance(). The
        value is simply the new elapsed animation time. */
@@ -161,6 +238,10 @@ template<class T, class K> Player<T, K>& Player<T, K>::seekTo(T seekTime, T anim
     /* Animation is stopped, nothing to do */
     if(_state == State::Stopped) return *this;
 
+    /* Make the next advance() restore the keyframe hints from the lookup
+       tables, if there are any */
+    _seeked = true;
+
     /* If the animation is paused and parked already, trigger a "park" again in
        order to have the values updated on the next call to advance(). The
        value is simply the new elapsed animation time. */
@@ -176,6 +257,16 @@ template<class T, class K> Player<T, K>& Player<T, K>::seekTo(T seekTime, T anim
     return *this;
 }
 
+template<class T, class K> Player<T, K>& Player<T, K>::buildKeyframeLookup(const std::size_t minKeyframeCount) {
+    for(Track& t: _tracks)
+        if(t.track.size() >= minKeyframeCount)
+            t.lookup = KeyframeLookup<K>{t.track.keys()};
+    for(Batch& b: _batches)
+        if(b.keys.size() >= minKeyframeCount)
+            b.lookup = KeyframeLookup<K>{b.keys};
+    return *this;
+}
+
 template<class T, class K> Player<T, K>& Player<T, K>::stop() {
     _state = State::Stopped;
     /* Anything, just not a default-constructed value */
@@ -301,9 +392,24 @@ template<class T, class K> Player<T, K>& Player<T, K>::advance(const T time) {
     Containers::Optional<std::pair<UnsignedInt, K>> elapsed = Implementation::playerElapsed(_duration.size(), _playCount, _scaler, time, _startTime, _stopPauseTime, _state);
     if(!elapsed) return *this;
 
-    /* Advance all tracks. Properly handle durations that don't start at 0. */
+    /* Properly handle durations that don't start at 0 */
+    const K key = _duration.min() + elapsed->second;
+
+    /* After a seek the hints are likely far off, which would mean searching
+       from the beginning. Use the lookup tables instead, if built. */
+    if(_seeked) {
+        for(Track& t: _tracks)
+            if(t.lookup.bucketCount()) t.hint = t.lookup.hint(key);
+        for(Batch& b: _batches)
+            if(b.lookup.bucketCount()) b.hint = b.lookup.hint(key);
+        _seeked = false;
+    }
+
+    /* Advance all tracks and batches */
     for(Track& t: _tracks)
-        t.advancer(t.track, _duration.min() + elapsed->second, t.hint, t.destination, t.userCallback, t.userCallbackData);
+        t.advancer(t.track, key, t.hint, t.destination, t.userCallback, t.userCallbackData);
+    for(Batch& b: _batches)
+        b.advancer(b.keys, b.values, b.before, b.after, b.interpolator, key, b.hint, b.destination);
 
     return *this;
 }
@@ -0,0 +1,116 @@
+#ifndef Magnum_Animation_Quantization_h
+#define Magnum_Animation_Quantization_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::Animation::packQuaternionSmallestThree(), @ref Magnum::Animation::unpackQuaternionSmallestThree()
+ * @m_since_latest
+ */
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Quaternion.h"
+
+namespace Magnum { namespace Animation {
+
+/**
+@brief Pack a quaternion using the smallest-three encoding
+@m_since_latest
+
+Useful for reducing memory use of rotation tracks, which is usually the
+largest part of skeletal animations. Expects that the quaternion is
+normalized. The component with the largest absolute value is omitted, as it
+can be reconstructed from the other three. Its index is stored in the top two
+bits and the remaining three components, which are all in range
+@f$ [-\frac{1}{\sqrt{2}}, \frac{1}{\sqrt{2}}] @f$, are stored in 10 bits each,
+giving a precision of roughly @cpp 0.0014 @ce per component. As @f$ q @f$ and
+@f$ -q @f$ represent the same rotation, the quaternion is negated if the
+largest component is negative, so it can be always reconstructed as positive.
+
+Compared to a full-precision @ref Quaternion this takes a quarter of the
+memory. Use @ref unpackQuaternionSmallestThree() to unpack the value back. The
+function is also usable directly as an unpacker for @ref unpack() to create
+interpolators for packed tracks:
+
+@snippet MagnumAnimation.cpp packQuaternionSmallestThree
+
+@see @ref Math::pack(), @ref SceneTools::packQuaternionSmallestThreeInto()
+*/
+inline UnsignedInt packQuaternionSmallestThree(const Quaternion& value) {
+    const Float components[]{value.vector().x(), value.vector().y(), value.vector().z(), value.scalar()};
+
+    /* Find the largest component */
+    UnsignedInt largest = 0;
+    for(UnsignedInt i = 1; i != 4; ++i)
+        if(Math::abs(components[i]) > Math::abs(components[largest]))
+            largest = i;
+
+    /* Flip the quaternion so the omitted component is positive */
+    const Float sign = components[largest] < 0.0f ? -1.0f : 1.0f;
+
+    /* Map the remaining components from [-1/sqrt(2), 1/sqrt(2)] to
+       [0, 1023] */
+    UnsignedInt out = largest << 30;
+    UnsignedInt shift = 20;
+    for(UnsignedInt i = 0; i != 4; ++i) {
+        if(i == largest) continue;
+        const Float normalized = Math::clamp(sign*components[i]*Constants::sqrt2()*0.5f + 0.5f, 0.0f, 1.0f);
+        out |= UnsignedInt(normalized*1023.0f + 0.5f) << shift;
+        shift -= 10;
+    }
+
+    return out;
+}
+
+/**
+@brief Unpack a quaternion packed using the smallest-three encoding
+@m_since_latest
+
+Inverse to @ref packQuaternionSmallestThree(). The omitted component is
+calculated so the resulting quaternion is normalized. The parameter is taken
+as a @cpp const @ce reference to make the function usable as an unpacker in
+@ref unpack().
+*/
+inline Quaternion unpackQuaternionSmallestThree(const UnsignedInt& value) {
+    const UnsignedInt largest = value >> 30;
+
+    Float components[4];
+    Float lengthSquared = 0.0f;
+    UnsignedInt shift = 20;
+    for(UnsignedInt i = 0; i != 4; ++i) {
+        if(i == largest) continue;
+        const Float component = (Float((value >> shift) & 0x3ff)*(2.0f/1023.0f) - 1.0f)*Constants::sqrtHalf();
+        components[i] = component;
+        lengthSquared += component*component;
+        shift -= 10;
+    }
+
+    components[largest] = std::sqrt(Math::max(1.0f - lengthSquared, 0.0f));
+    return {{components[0], components[1], components[2]}, components[3]};
+}
+
+}}
+
+#endif
@@ -25,6 +25,7 @@
 
 #include <Corrade/TestSuite/Tester.h>
 
+#include "Magnum/Animation/KeyframeLookup.h"
 #include "Magnum/Animation/Player.h"
 
 namespace Magnum { namespace Animation { namespace Test { namespace {
@@ -39,6 +40,8 @@ struct Benchmark: TestSuite::Tester {
     void atEmpty();
     void at();
     void atHint();
+    void atRandomSeek();
+    void atRandomSeekKeyframeLookup();
     void atStrict();
     void atStrictInterleaved();
     void atStrictInterleavedDirectInterpolator();
@@ -50,6 +53,10 @@ struct Benchmark: TestSuite::Tester {
     void playerAdvanceRawCallback();
     void playerAdvanceRawCallbackDirectInterpolator();
 
+    void playerAdvanceManyTracks();
+    void playerAdvanceBatch();
+    void playerAdvanceBatchCompileTimeInterpolator();
+
     Containers::Array<Float> _keys;
     Containers::Array<Int> _values;
     Containers::Array<std::pair<Float, Int>> _interleaved;
@@ -57,10 +64,19 @@ struct Benchmark: TestSuite::Tester {
     Containers::StridedArrayView1D<const Int> _valuesInterleaved;
     TrackView<const Float, const Int> _track;
     TrackView<const Float, const Int> _trackInterleaved;
+    Containers::Array<Float> _batchKeys;
+    Containers::Array<Float> _batchValues;
+    Containers::StridedArrayView2D<const Float> _batchValuesView;
 };
 
 namespace {
-    enum: std::size_t { DataSize = 2000 };
+    enum: std::size_t {
+        DataSize = 2000,
+        /* Similar to a few hundred skinned characters, each having a few
+           dozen joint tracks sharing the same keyframes */
+        BatchKeyCount = 64,
+        BatchTrackCount = 6000
+    };
 }
 
 Benchmark::Benchmark() {
@@ -71,6 +87,8 @@ Benchmark::Benchmark() {
                    &Benchmark::atEmpty,
                    &Benchmark::at,
                    &Benchmark::atHint,
+                   &Benchmark::atRandomSeek,
+                   &Benchmark::atRandomSeekKeyframeLookup,
                    &Benchmark::atStrict,
                    &Benchmark::atStrictInterleaved,
                    &Benchmark::atStrictInterleavedDirectInterpolator,
@@ -80,7 +98,11 @@ Benchmark::Benchmark() {
                    &Benchmark::playerAdvance,
                    &Benchmark::playerAdvanceCallback,
                    &Benchmark::playerAdvanceRawCallback,
-                   &Benchmark::playerAdvanceRawCallbackDirectInterpolator}, 10);
+                   &Benchmark::playerAdvanceRawCallbackDirectInterpolator,
+
+                   &Benchmark::playerAdvanceManyTracks,
+                   &Benchmark::playerAdvanceBatch,
+                   &Benchmark::playerAdvanceBatchCompileTimeInterpolator}, 10);
 
     _keys = Containers::Array<Float>{DataSize};
     _values = Containers::Array<Int>{DirectInit, DataSize, 1};
@@ -94,6 +116,16 @@ Benchmark::Benchmark() {
     _track = TrackView<const Float, const Int>{
         Containers::arrayView(_keys), Containers::arrayView(_values), Math::select};
     _trackInterleaved = {_keysInterleaved, _valuesInterleaved, Math::select};
+
+    /* Values of all tracks at given keyframe are the keyframe index */
+    _batchKeys = Containers::Array<Float>{BatchKeyCount};
+    _batchValues = Containers::Array<Float>{BatchKeyCount*BatchTrackCount};
+    for(std::size_t i = 0; i != BatchKeyCount; ++i) {
+        _batchKeys[i] = Float(i);
+        for(std::size_t j = 0; j != BatchTrackCount; ++j)
+            _batchValues[i*BatchTrackCount + j] = Float(i);
+    }
+    _batchValuesView = Containers::StridedArrayView2D<const Float>{_batchValues, {BatchKeyCount, BatchTrackCount}};
 }
 
 void Benchmark::interpolateEmpty() {
@@ -154,6 +186,31 @@ void Benchmark::atHint() {
     CORRADE_COMPARE(result, 125000);
 }
 
+void Benchmark::atRandomSeek() {
+    Int result{};
+    CORRADE_BENCHMARK(250) {
+        std::size_t hint{};
+        /* Jumping back and forth across the whole track */
+        for(Int i = 0; i != 500; ++i)
+            result += _track.at(Float((i*7919) % 6250), hint);
+    }
+    CORRADE_COMPARE(result, 125000);
+}
+
+void Benchmark::atRandomSeekKeyframeLookup() {
+    const KeyframeLookup<Float> lookup{_track.keys()};
+
+    Int result{};
+    CORRADE_BENCHMARK(250) {
+        for(Int i = 0; i != 500; ++i) {
+            const Float frame = Float((i*7919) % 6250);
+            std::size_t hint = lookup.hint(frame);
+            result += _track.at(frame, hint);
+        }
+    }
+    CORRADE_COMPARE(result, 125000);
+}
+
 void Benchmark::atStrict() {
     Int result{};
     CORRADE_BENCHMARK(250) {
@@ -260,6 +317,46 @@ void Benchmark::playerAdvanceRawCallbackDirectInterpolator() {
     CORRADE_COMPARE(result, 125000);
 }
 
+void Benchmark::playerAdvanceManyTracks() {
+    Containers::Array<Float> result{BatchTrackCount};
+    Player<Float> player;
+    for(std::size_t i = 0; i != BatchTrackCount; ++i)
+        player.add(TrackView<const Float, const Float>{Containers::arrayView(_batchKeys), _batchValuesView.transposed<0, 1>()[i], Math::lerp}, result[i]);
+    player.play({});
+    CORRADE_BENCHMARK(5) {
+        for(Float i = 0.5f; i < Float(BatchKeyCount - 1); i += 1.0f)
+            player.advance(i);
+    }
+    CORRADE_COMPARE(result[0], 62.5f);
+    CORRADE_COMPARE(result[BatchTrackCount - 1], 62.5f);
+}
+
+void Benchmark::playerAdvanceBatch() {
+    Containers::Array<Float> result{BatchTrackCount};
+    Player<Float> player;
+    player.addBatch<Float, Float>(Containers::arrayView(_batchKeys), _batchValuesView, Math::lerp, Containers::arrayView(result))
+        .play({});
+    CORRADE_BENCHMARK(5) {
+        for(Float i = 0.5f; i < Float(BatchKeyCount - 1); i += 1.0f)
+            player.advance(i);
+    }
+    CORRADE_COMPARE(result[0], 62.5f);
+    CORRADE_COMPARE(result[BatchTrackCount - 1], 62.5f);
+}
+
+void Benchmark::playerAdvanceBatchCompileTimeInterpolator() {
+    Containers::Array<Float> result{BatchTrackCount};
+    Player<Float> player;
+    player.addBatch<Float, Float, Math::lerp>(Containers::arrayView(_batchKeys), _batchValuesView, Containers::arrayView(result))
+        .play({});
+    CORRADE_BENCHMARK(5) {
+        for(Float i = 0.5f; i < Float(BatchKeyCount - 1); i += 1.0f)
+            player.advance(i);
+    }
+    CORRADE_COMPARE(result[0], 62.5f);
+    CORRADE_COMPARE(result[BatchTrackCount - 1], 62.5f);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Animation::Test::Benchmark)
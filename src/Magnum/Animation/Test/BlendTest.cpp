@@ -0,0 +1,295 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Animation/Blend.h"
+#include "Magnum/Math/Quaternion.h"
+
+namespace Magnum { namespace Animation { namespace Test { namespace {
+
+struct BlendTest: TestSuite::Tester {
+    explicit BlendTest();
+
+    void vector();
+    void vectorMask();
+    void quaternion();
+    void quaternionShortestPath();
+    void quaternionMask();
+
+    void additiveVector();
+    void additiveVectorMask();
+    void additiveQuaternion();
+    void additiveQuaternionMask();
+
+    void strided();
+
+    void invalidSize();
+};
+
+using namespace Math::Literals;
+
+BlendTest::BlendTest() {
+    addTests({&BlendTest::vector,
+              &BlendTest::vectorMask,
+              &BlendTest::quaternion,
+              &BlendTest::quaternionShortestPath,
+              &BlendTest::quaternionMask,
+
+              &BlendTest::additiveVector,
+              &BlendTest::additiveVectorMask,
+              &BlendTest::additiveQuaternion,
+              &BlendTest::additiveQuaternionMask,
+
+              &BlendTest::strided,
+
+              &BlendTest::invalidSize});
+}
+
+void BlendTest::vector() {
+    const Vector3 pose[]{
+        {2.0f, 4.0f, 6.0f},
+        {-1.0f, 0.0f, 1.0f}
+    };
+    Vector3 destination[]{
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 2.0f, 3.0f}
+    };
+
+    blendInto(pose, 0.25f, destination);
+    CORRADE_COMPARE_AS(Containers::arrayView(destination), Containers::arrayView<Vector3>({
+        {0.5f, 1.0f, 1.5f},
+        {0.5f, 1.5f, 2.5f}
+    }), TestSuite::Compare::Container);
+}
+
+void BlendTest::vectorMask() {
+    const Vector3 pose[]{
+        {2.0f, 4.0f, 6.0f},
+        {-1.0f, 0.0f, 1.0f},
+        {4.0f, 4.0f, 4.0f}
+    };
+    const Float mask[]{1.0f, 0.0f, 0.5f};
+    Vector3 destination[]{
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 2.0f, 3.0f},
+        {0.0f, 0.0f, 0.0f}
+    };
+
+    blendInto(pose, 0.5f, mask, destination);
+    CORRADE_COMPARE_AS(Containers::arrayView(destination), Containers::arrayView<Vector3>({
+        {1.0f, 2.0f, 3.0f},
+        {1.0f, 2.0f, 3.0f}, /* masked out, untouched */
+        {1.0f, 1.0f, 1.0f}
+    }), TestSuite::Compare::Container);
+}
+
+void BlendTest::quaternion() {
+    const Quaternion pose[]{
+        Quaternion::rotation(60.0_degf, Vector3::xAxis()),
+        Quaternion::rotation(-90.0_degf, Vector3::zAxis())
+    };
+    Quaternion destination[]{
+        Quaternion::rotation(20.0_degf, Vector3::xAxis()),
+        Quaternion{}
+    };
+
+    blendInto(pose, 0.5f, destination);
+    CORRADE_COMPARE(destination[0], Quaternion::rotation(40.0_degf, Vector3::xAxis()));
+    CORRADE_COMPARE(destination[1], Quaternion::rotation(-45.0_degf, Vector3::zAxis()));
+
+    /* Full weight replaces the value */
+    blendInto(pose, 1.0f, destination);
+    CORRADE_COMPARE(destination[0], pose[0]);
+    CORRADE_COMPARE(destination[1], pose[1]);
+}
+
+void BlendTest::quaternionShortestPath() {
+    /* -q is the same rotation as q, the blend should take that into account
+       and not go the long way around */
+    const Quaternion pose[]{
+        -Quaternion::rotation(60.0_degf, Vector3::xAxis())
+    };
+    Quaternion destination[]{
+        Quaternion::rotation(20.0_degf, Vector3::xAxis())
+    };
+
+    blendInto(pose, 0.5f, destination);
+    CORRADE_COMPARE(destination[0], Quaternion::rotation(40.0_degf, Vector3::xAxis()));
+}
+
+void BlendTest::quaternionMask() {
+    const Quaternion pose[]{
+        Quaternion::rotation(60.0_degf, Vector3::xAxis()),
+        Quaternion::rotation(60.0_degf, Vector3::xAxis())
+    };
+    const Float mask[]{0.0f, 1.0f};
+    Quaternion destination[]{
+        Quaternion::rotation(20.0_degf, Vector3::yAxis()),
+        Quaternion::rotation(20.0_degf, Vector3::xAxis())
+    };
+
+    blendInto(pose, 0.5f, mask, destination);
+    CORRADE_COMPARE(destination[0], Quaternion::rotation(20.0_degf, Vector3::yAxis()));
+    CORRADE_COMPARE(destination[1], Quaternion::rotation(40.0_degf, Vector3::xAxis()));
+}
+
+void BlendTest::additiveVector() {
+    const Vector3 pose[]{
+        {2.0f, 4.0f, 6.0f},
+        {-1.0f, 0.0f, 1.0f}
+    };
+    Vector3 destination[]{
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 2.0f, 3.0f}
+    };
+
+    blendAdditiveInto(pose, 0.5f, destination);
+    CORRADE_COMPARE_AS(Containers::arrayView(destination), Containers::arrayView<Vector3>({
+        {1.0f, 2.0f, 3.0f},
+        {0.5f, 2.0f, 3.5f}
+    }), TestSuite::Compare::Container);
+}
+
+void BlendTest::additiveVectorMask() {
+    const Vector3 pose[]{
+        {2.0f, 4.0f, 6.0f},
+        {-1.0f, 0.0f, 1.0f}
+    };
+    const Float mask[]{0.0f, 0.5f};
+    Vector3 destination[]{
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 2.0f, 3.0f}
+    };
+
+    blendAdditiveInto(pose, 2.0f, mask, destination);
+    CORRADE_COMPARE_AS(Containers::arrayView(destination), Containers::arrayView<Vector3>({
+        {0.0f, 0.0f, 0.0f},
+        {0.0f, 2.0f, 4.0f}
+    }), TestSuite::Compare::Container);
+}
+
+void BlendTest::additiveQuaternion() {
+    const Quaternion pose[]{
+        Quaternion::rotation(30.0_degf, Vector3::xAxis()),
+        Quaternion::rotation(90.0_degf, Vector3::yAxis())
+    };
+    Quaternion destination[]{
+        Quaternion::rotation(20.0_degf, Vector3::xAxis()),
+        Quaternion::rotation(90.0_degf, Vector3::xAxis())
+    };
+
+    blendAdditiveInto(pose, 1.0f, destination);
+    CORRADE_COMPARE(destination[0], Quaternion::rotation(50.0_degf, Vector3::xAxis()));
+    CORRADE_COMPARE(destination[1],
+        Quaternion::rotation(90.0_degf, Vector3::xAxis())*
+        Quaternion::rotation(90.0_degf, Vector3::yAxis()));
+
+    /* Half the weight is half the angle */
+    blendAdditiveInto(pose, 0.5f, destination);
+    CORRADE_COMPARE(destination[0], Quaternion::rotation(65.0_degf, Vector3::xAxis()));
+}
+
+void BlendTest::additiveQuaternionMask() {
+    const Quaternion pose[]{
+        Quaternion::rotation(30.0_degf, Vector3::xAxis()),
+        Quaternion::rotation(30.0_degf, Vector3::xAxis())
+    };
+    const Float mask[]{1.0f, 0.0f};
+    Quaternion destination[]{
+        Quaternion::rotation(20.0_degf, Vector3::xAxis()),
+        Quaternion::rotation(20.0_degf, Vector3::yAxis())
+    };
+
+    blendAdditiveInto(pose, 1.0f, mask, destination);
+    CORRADE_COMPARE(destination[0], Quaternion::rotation(50.0_degf, Vector3::xAxis()));
+    CORRADE_COMPARE(destination[1], Quaternion::rotation(20.0_degf, Vector3::yAxis()));
+}
+
+void BlendTest::strided() {
+    /* Interleaved pose data, as if coming from a Player writing into a
+       struct per bone */
+    struct Bone {
+        Vector3 translation;
+        Quaternion rotation;
+    };
+    const Bone pose[]{
+        {{2.0f, 4.0f, 6.0f}, Quaternion::rotation(60.0_degf, Vector3::xAxis())},
+        {{-1.0f, 0.0f, 1.0f}, Quaternion::rotation(60.0_degf, Vector3::zAxis())}
+    };
+    Bone destination[]{
+        {{}, {}},
+        {{1.0f, 2.0f, 3.0f}, Quaternion::rotation(20.0_degf, Vector3::zAxis())}
+    };
+
+    Containers::StridedArrayView1D<const Bone> poseView = pose;
+    Containers::StridedArrayView1D<Bone> destinationView = destination;
+    blendInto(poseView.slice(&Bone::translation), 0.5f, destinationView.slice(&Bone::translation));
+    blendInto(poseView.slice(&Bone::rotation), 0.5f, destinationView.slice(&Bone::rotation));
+    CORRADE_COMPARE(destination[0].translation, (Vector3{1.0f, 2.0f, 3.0f}));
+    CORRADE_COMPARE(destination[1].translation, (Vector3{0.0f, 1.0f, 2.0f}));
+    CORRADE_COMPARE(destination[0].rotation, Quaternion::rotation(30.0_degf, Vector3::xAxis()));
+    CORRADE_COMPARE(destination[1].rotation, Quaternion::rotation(40.0_degf, Vector3::zAxis()));
+}
+
+void BlendTest::invalidSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const Vector3 pose[3]{};
+    const Quaternion rotations[3]{};
+    const Float mask[2]{};
+    Vector3 destination[3];
+    Vector3 destinationInvalid[2];
+    Quaternion rotationsDestination[3];
+    Quaternion rotationsDestinationInvalid[4];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    blendInto(pose, 1.0f, destinationInvalid);
+    blendInto(pose, 1.0f, mask, destination);
+    blendInto(rotations, 1.0f, rotationsDestinationInvalid);
+    blendInto(rotations, 1.0f, mask, rotationsDestination);
+    blendAdditiveInto(pose, 1.0f, destinationInvalid);
+    blendAdditiveInto(pose, 1.0f, mask, destination);
+    blendAdditiveInto(rotations, 1.0f, rotationsDestinationInvalid);
+    blendAdditiveInto(rotations, 1.0f, mask, rotationsDestination);
+    CORRADE_COMPARE(out.str(),
+        "Animation::blendInto(): expected destination view with 3 elements but got 2\n"
+        "Animation::blendInto(): expected mask view with 3 elements but got 2\n"
+        "Animation::blendInto(): expected destination view with 3 elements but got 4\n"
+        "Animation::blendInto(): expected mask view with 3 elements but got 2\n"
+        "Animation::blendAdditiveInto(): expected destination view with 3 elements but got 2\n"
+        "Animation::blendAdditiveInto(): expected mask view with 3 elements but got 2\n"
+        "Animation::blendAdditiveInto(): expected destination view with 3 elements but got 4\n"
+        "Animation::blendAdditiveInto(): expected mask view with 3 elements but got 2\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Animation::Test::BlendTest)
@@ -24,6 +24,7 @@
 */
 
 #include <sstream>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/Utility/DebugStl.h>
 
@@ -78,6 +79,16 @@ struct InterpolationTest: TestSuite::Tester {
     void interpolateIntegerKey();
     void interpolateStrictIntegerKey();
 
+    void interpolateInto();
+    void interpolateStrictInto();
+    void interpolateIntoSingleKeyframe();
+    void interpolateIntoNoKeyframe();
+    void interpolateIntoCompileTimeInterpolator();
+    void interpolateIntoStrided();
+
+    void interpolateIntoError();
+    void interpolateStrictIntoError();
+
     void ease();
     void easeClamped();
     void unpack();
@@ -200,7 +211,21 @@ InterpolationTest::InterpolationTest() {
               &InterpolationTest::interpolateStrictError,
 
               &InterpolationTest::interpolateIntegerKey,
-              &InterpolationTest::interpolateStrictIntegerKey,
+              &InterpolationTest::interpolateStrictIntegerKey});
+
+    addInstancedTests({&InterpolationTest::interpolateInto,
+                       &InterpolationTest::interpolateStrictInto},
+                       Containers::arraySize(Data));
+
+    addInstancedTests({&InterpolationTest::interpolateIntoSingleKeyframe},
+                       Containers::arraySize(SingleKeyframeData));
+
+    addTests({&InterpolationTest::interpolateIntoNoKeyframe,
+              &InterpolationTest::interpolateIntoCompileTimeInterpolator,
+              &InterpolationTest::interpolateIntoStrided,
+
+              &InterpolationTest::interpolateIntoError,
+              &InterpolationTest::interpolateStrictIntoError,
 
               &InterpolationTest::ease,
               &InterpolationTest::easeClamped,
@@ -579,6 +604,175 @@ void InterpolationTest::interpolateStrictError() {
         "Animation::interpolateStrict(): keys and values don't have the same size\n");
 }
 
+/* Three tracks sharing the Keys, the first is the same as Values, the second
+   is twice the Values and the third negative Values */
+constexpr Float BatchValues[]{
+    3.0f, 6.0f, -3.0f,
+    1.0f, 2.0f, -1.0f,
+    2.5f, 5.0f, -2.5f,
+    0.5f, 1.0f, -0.5f
+};
+
+void InterpolationTest::interpolateInto() {
+    const auto& data = Data[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Float out[3];
+    std::size_t hint{};
+    Animation::interpolateInto<Float, Float>(Keys,
+        Containers::StridedArrayView2D<const Float>{BatchValues, {4, 3}},
+        data.extrapolationBefore, data.extrapolationAfter,
+        Math::lerp, data.time, hint, Containers::arrayView(out));
+    CORRADE_COMPARE(out[0], data.expectedValue);
+    CORRADE_COMPARE(out[1], data.expectedValue*2.0f);
+    CORRADE_COMPARE(out[2], -data.expectedValue);
+    CORRADE_COMPARE(hint, data.expectedHint);
+}
+
+void InterpolationTest::interpolateStrictInto() {
+    const auto& data = Data[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Float out[3];
+    std::size_t hint{};
+    Animation::interpolateStrictInto<Float, Float>(Keys,
+        Containers::StridedArrayView2D<const Float>{BatchValues, {4, 3}},
+        Math::lerp, data.time, hint, Containers::arrayView(out));
+    CORRADE_COMPARE(out[0], data.expectedValueStrict);
+    CORRADE_COMPARE(out[1], data.expectedValueStrict*2.0f);
+    CORRADE_COMPARE(out[2], -data.expectedValueStrict);
+    CORRADE_COMPARE(hint, data.expectedHint);
+}
+
+void InterpolationTest::interpolateIntoSingleKeyframe() {
+    const auto& data = SingleKeyframeData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Float out[3]{1.0f, 1.0f, 1.0f};
+    std::size_t hint{};
+    Animation::interpolateInto<Float, Float>(
+        Containers::arrayView(Keys).prefix(1),
+        Containers::StridedArrayView2D<const Float>{BatchValues, {4, 3}}.prefix({1, 3}),
+        data.extrapolation, data.extrapolation,
+        Math::lerp, data.time, hint, Containers::arrayView(out));
+    CORRADE_COMPARE(out[0], data.expectedValue);
+    CORRADE_COMPARE(out[1], data.expectedValue*2.0f);
+    CORRADE_COMPARE(out[2], -data.expectedValue);
+    CORRADE_COMPARE(hint, 0);
+}
+
+void InterpolationTest::interpolateIntoNoKeyframe() {
+    Float out[3]{1.0f, 1.0f, 1.0f};
+    std::size_t hint{};
+    Animation::interpolateInto<Float, Float>(nullptr,
+        Containers::StridedArrayView2D<const Float>{BatchValues, {0, 3}},
+        Extrapolation::Extrapolated, Extrapolation::Extrapolated,
+        Math::lerp, 3.5f, hint, Containers::arrayView(out));
+    CORRADE_COMPARE(out[0], 0.0f);
+    CORRADE_COMPARE(out[1], 0.0f);
+    CORRADE_COMPARE(out[2], 0.0f);
+    CORRADE_COMPARE(hint, 0);
+}
+
+void InterpolationTest::interpolateIntoCompileTimeInterpolator() {
+    const Containers::StridedArrayView2D<const Float> values{BatchValues, {4, 3}};
+
+    {
+        Float out[3];
+        std::size_t hint{};
+        Animation::interpolateInto<Float, Float, Float, Math::lerp>(Keys,
+            values, Extrapolation::Extrapolated, Extrapolation::Extrapolated,
+            4.75f, hint, Containers::arrayView(out));
+        CORRADE_COMPARE(out[0], 1.0f);
+        CORRADE_COMPARE(out[1], 2.0f);
+        CORRADE_COMPARE(out[2], -1.0f);
+        CORRADE_COMPARE(hint, 2);
+    } {
+        Float out[3];
+        std::size_t hint{};
+        Animation::interpolateStrictInto<Float, Float, Float, Math::lerp>(Keys,
+            values, 4.75f, hint, Containers::arrayView(out));
+        CORRADE_COMPARE(out[0], 1.0f);
+        CORRADE_COMPARE(out[1], 2.0f);
+        CORRADE_COMPARE(out[2], -1.0f);
+        CORRADE_COMPARE(hint, 2);
+    }
+}
+
+void InterpolationTest::interpolateIntoStrided() {
+    /* Taking every other track and writing to every other item, which
+       should go through the generic strided path */
+    const Containers::StridedArrayView2D<const Float> values = Containers::StridedArrayView2D<const Float>{BatchValues, {4, 3}}.every({1, 2});
+    Float out[4]{7.0f, 7.0f, 7.0f, 7.0f};
+    std::size_t hint{};
+    Animation::interpolateInto<Float, Float>(Keys, values,
+        Extrapolation::Extrapolated, Extrapolation::Extrapolated,
+        Math::lerp, 4.75f, hint, Containers::stridedArrayView(out).every(2));
+    CORRADE_COMPARE(out[0], 1.0f);
+    CORRADE_COMPARE(out[1], 7.0f);
+    CORRADE_COMPARE(out[2], -1.0f);
+    CORRADE_COMPARE(out[3], 7.0f);
+    CORRADE_COMPARE(hint, 2);
+}
+
+void InterpolationTest::interpolateIntoError() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const Containers::StridedArrayView2D<const Float> values{BatchValues, {4, 3}};
+    Float destination[3];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    {
+        std::size_t hint{};
+        Animation::interpolateInto<Float, Float>(
+            Containers::arrayView(Keys).prefix(3), values,
+            Extrapolation::Extrapolated, Extrapolation::Extrapolated,
+            Math::lerp, 0.0f, hint, Containers::arrayView(destination));
+    } {
+        std::size_t hint{};
+        Animation::interpolateInto<Float, Float>(Keys, values,
+            Extrapolation::Extrapolated, Extrapolation::Extrapolated,
+            Math::lerp, 0.0f, hint, Containers::arrayView(destination).prefix(2));
+    }
+
+    CORRADE_COMPARE(out.str(),
+        "Animation::interpolateInto(): expected 3 keyframes but got 4\n"
+        "Animation::interpolateInto(): expected destination size to be 3 but got 2\n");
+}
+
+void InterpolationTest::interpolateStrictIntoError() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const Containers::StridedArrayView2D<const Float> values{BatchValues, {4, 3}};
+    Float destination[3];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    {
+        std::size_t hint{};
+        Animation::interpolateStrictInto<Float, Float>(
+            Containers::arrayView(Keys).prefix(1), values.prefix({1, 3}),
+            Math::lerp, 0.0f, hint, Containers::arrayView(destination));
+    } {
+        std::size_t hint{};
+        Animation::interpolateStrictInto<Float, Float>(
+            Containers::arrayView(Keys).prefix(3), values,
+            Math::lerp, 0.0f, hint, Containers::arrayView(destination));
+    } {
+        std::size_t hint{};
+        Animation::interpolateStrictInto<Float, Float>(Keys, values,
+            Math::lerp, 0.0f, hint, Containers::arrayView(destination).prefix(2));
+    }
+
+    CORRADE_COMPARE(out.str(),
+        "Animation::interpolateStrictInto(): at least two keyframes required\n"
+        "Animation::interpolateStrictInto(): expected 3 keyframes but got 4\n"
+        "Animation::interpolateStrictInto(): expected destination size to be 3 but got 2\n");
+}
+
 void InterpolationTest::ease() {
     auto lerpQuadratic = Animation::ease<Float, Math::lerp, Easing::quadraticIn>();
 
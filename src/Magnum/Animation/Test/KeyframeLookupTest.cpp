@@ -0,0 +1,168 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+
+#include "Magnum/Animation/KeyframeLookup.h"
+#include "Magnum/Animation/Track.h"
+
+namespace Magnum { namespace Animation { namespace Test { namespace {
+
+struct KeyframeLookupTest: TestSuite::Tester {
+    explicit KeyframeLookupTest();
+
+    void constructDefault();
+    void construct();
+    void constructDefaultBucketCount();
+    void constructDegenerate();
+    void constructCopy();
+    void constructMove();
+
+    void hintNotAfterFrame();
+    void trackView();
+};
+
+KeyframeLookupTest::KeyframeLookupTest() {
+    addTests({&KeyframeLookupTest::constructDefault,
+              &KeyframeLookupTest::construct,
+              &KeyframeLookupTest::constructDefaultBucketCount,
+              &KeyframeLookupTest::constructDegenerate,
+              &KeyframeLookupTest::constructCopy,
+              &KeyframeLookupTest::constructMove,
+
+              &KeyframeLookupTest::hintNotAfterFrame,
+              &KeyframeLookupTest::trackView});
+}
+
+void KeyframeLookupTest::constructDefault() {
+    KeyframeLookup<Float> lookup;
+    CORRADE_COMPARE(lookup.bucketCount(), 0);
+    CORRADE_COMPARE(lookup.hint(-10.0f), 0);
+    CORRADE_COMPARE(lookup.hint(10.0f), 0);
+}
+
+void KeyframeLookupTest::construct() {
+    /* One bucket per unit of time */
+    const Float keys[]{0.0f, 1.0f, 2.0f, 5.0f, 5.5f, 10.0f};
+    KeyframeLookup<Float> lookup{keys, 10};
+    CORRADE_COMPARE(lookup.bucketCount(), 10);
+
+    CORRADE_COMPARE(lookup.hint(-1.0f), 0);
+    CORRADE_COMPARE(lookup.hint(0.5f), 0);
+    CORRADE_COMPARE(lookup.hint(1.5f), 0);
+    CORRADE_COMPARE(lookup.hint(2.5f), 1);
+    CORRADE_COMPARE(lookup.hint(4.0f), 2);
+    /* The keyframe at 5.0 is in the same bucket, so it can't be used */
+    CORRADE_COMPARE(lookup.hint(5.25f), 2);
+    CORRADE_COMPARE(lookup.hint(7.0f), 4);
+    CORRADE_COMPARE(lookup.hint(10.0f), 4);
+    CORRADE_COMPARE(lookup.hint(100.0f), 4);
+}
+
+void KeyframeLookupTest::constructDefaultBucketCount() {
+    const Float keys[]{0.0f, 1.0f, 2.0f, 5.0f, 5.5f, 10.0f};
+    KeyframeLookup<Float> lookup{keys};
+    CORRADE_COMPARE(lookup.bucketCount(), 6);
+}
+
+void KeyframeLookupTest::constructDegenerate() {
+    const Float keys[]{3.0f, 3.0f};
+
+    /* All these result in an empty table */
+    CORRADE_COMPARE(KeyframeLookup<Float>(nullptr, 10).bucketCount(), 0);
+    CORRADE_COMPARE(KeyframeLookup<Float>(Containers::arrayView(keys).prefix(1), 10).bucketCount(), 0);
+    CORRADE_COMPARE(KeyframeLookup<Float>(keys, 10).bucketCount(), 0);
+    CORRADE_COMPARE(KeyframeLookup<Float>(keys, 0).bucketCount(), 0);
+}
+
+void KeyframeLookupTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<KeyframeLookup<Float>>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<KeyframeLookup<Float>>{});
+}
+
+void KeyframeLookupTest::constructMove() {
+    const Float keys[]{0.0f, 1.0f, 2.0f, 5.0f, 5.5f, 10.0f};
+    KeyframeLookup<Float> a{keys, 10};
+
+    KeyframeLookup<Float> b{std::move(a)};
+    CORRADE_COMPARE(b.bucketCount(), 10);
+    CORRADE_COMPARE(b.hint(7.0f), 4);
+
+    KeyframeLookup<Float> c;
+    c = std::move(b);
+    CORRADE_COMPARE(c.bucketCount(), 10);
+    CORRADE_COMPARE(c.hint(7.0f), 4);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<KeyframeLookup<Float>>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<KeyframeLookup<Float>>::value);
+}
+
+void KeyframeLookupTest::hintNotAfterFrame() {
+    /* Non-uniformly distributed keys with clusters and gaps */
+    Float keys[500];
+    Float key = -3.0f;
+    for(std::size_t i = 0; i != 500; ++i) {
+        keys[i] = key;
+        key += i % 50 < 45 ? 0.01f : 7.3f;
+    }
+
+    for(std::size_t bucketCount: {1, 7, 500, 2000}) {
+        CORRADE_ITERATION(bucketCount);
+        KeyframeLookup<Float> lookup{keys, bucketCount};
+
+        for(Float frame = -5.0f; frame < keys[499] + 5.0f; frame += 0.137f) {
+            const std::size_t hint = lookup.hint(frame);
+            CORRADE_VERIFY(hint < 500);
+            if(hint) CORRADE_COMPARE_AS(keys[hint], frame,
+                TestSuite::Compare::LessOrEqual);
+        }
+    }
+}
+
+void KeyframeLookupTest::trackView() {
+    Float keys[1000];
+    Float values[1000];
+    for(std::size_t i = 0; i != 1000; ++i) {
+        keys[i] = Float(i)*0.5f;
+        values[i] = Float(i%7);
+    }
+
+    const TrackView<const Float, const Float> track{keys, values, Math::lerp};
+    const KeyframeLookup<Float> lookup{track.keys()};
+
+    /* Jumping back and forth across the track should give the same results
+       as a search from the beginning */
+    for(Int i = 0; i != 200; ++i) {
+        CORRADE_ITERATION(i);
+        const Float frame = Float((i*7919) % 5000)*0.1f;
+        std::size_t hint = lookup.hint(frame);
+        CORRADE_COMPARE(track.at(frame, hint), track.at(frame));
+    }
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Animation::Test::KeyframeLookupTest)
@@ -24,8 +24,10 @@
 */
 
 #include <sstream>
+#include <thread>
 #include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/Reference.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/TestSuite/Compare/Numeric.h>
@@ -62,6 +64,8 @@ struct PlayerTest: TestSuite::Tester {
     void advancePlayCountInfinite();
     void advanceChrono();
     void advanceList();
+    void advanceParallel();
+    void advanceParallelStateChanged();
     void advanceZeroDurationStop();
     void advanceZeroDurationPause();
     void advanceZeroDurationInfinitePlayCount();
@@ -76,6 +80,7 @@ struct PlayerTest: TestSuite::Tester {
     void seekToPlaying();
     void seekToPaused();
     void seekToPausedParked();
+    void seekKeyframeLookup();
 
     void setState();
 
@@ -86,6 +91,10 @@ struct PlayerTest: TestSuite::Tester {
     template<class T> void addWithCallbackOnChange();
     template<class T> void addWithCallbackOnChangeTemplate();
     template<class T> void addRawCallback();
+    void addBatch();
+    void addBatchCompileTimeInterpolator();
+    void addBatchDuration();
+    void addBatchInvalid();
 
     void runFor100YearsFloat();
     void runFor100YearsChrono();
@@ -153,6 +162,8 @@ PlayerTest::PlayerTest() {
               &PlayerTest::advancePlayCountInfinite,
               &PlayerTest::advanceChrono,
               &PlayerTest::advanceList,
+              &PlayerTest::advanceParallel,
+              &PlayerTest::advanceParallelStateChanged,
               &PlayerTest::advanceZeroDurationStop,
               &PlayerTest::advanceZeroDurationPause,
               &PlayerTest::advanceZeroDurationInfinitePlayCount,
@@ -167,6 +178,7 @@ PlayerTest::PlayerTest() {
               &PlayerTest::seekToPlaying,
               &PlayerTest::seekToPaused,
               &PlayerTest::seekToPausedParked,
+              &PlayerTest::seekKeyframeLookup,
 
               &PlayerTest::setState,
 
@@ -181,7 +193,11 @@ PlayerTest::PlayerTest() {
               &PlayerTest::addWithCallbackOnChangeTemplate<Track<Float, Float>>,
               &PlayerTest::addWithCallbackOnChangeTemplate<TrackView<Float, Float>>,
               &PlayerTest::addRawCallback<Track<Float, Float>>,
-              &PlayerTest::addRawCallback<TrackView<Float, Float>>});
+              &PlayerTest::addRawCallback<TrackView<Float, Float>>,
+              &PlayerTest::addBatch,
+              &PlayerTest::addBatchCompileTimeInterpolator,
+              &PlayerTest::addBatchDuration,
+              &PlayerTest::addBatchInvalid});
 
     addInstancedTests({
         &PlayerTest::runFor100YearsFloat,
@@ -199,6 +215,7 @@ void PlayerTest::constructEmpty() {
     CORRADE_COMPARE(player.state(), State::Stopped);
     CORRADE_VERIFY(player.isEmpty());
     CORRADE_COMPARE(player.size(), 0);
+    CORRADE_COMPARE(player.batchCount(), 0);
 }
 
 const Animation::Track<Float, Float> Track{{
@@ -802,6 +819,72 @@ void PlayerTest::advanceList() {
     CORRADE_COMPARE(valueB, 2.75f);
 }
 
+/* Large enough to be split among multiple threads */
+constexpr std::size_t ParallelPlayerCount = 1000;
+
+void PlayerTest::advanceParallel() {
+    for(UnsignedInt threadCount: {1u, 3u, 0u}) {
+        CORRADE_ITERATION(threadCount);
+
+        Containers::Array<Float> values{DirectInit, ParallelPlayerCount, -1.0f};
+        Containers::Array<Player<Float>> players{DirectInit, ParallelPlayerCount};
+        Containers::Array<Containers::Reference<Player<Float>>> references;
+        for(std::size_t i = 0; i != ParallelPlayerCount; ++i) {
+            players[i].add(Track, values[i])
+                .play(i % 2 ? 1.0f : 2.0f);
+            arrayAppend(references, players[i]);
+        }
+
+        /* 1.75 secs in for even players, 2.75 seconds in for odd */
+        Player<Float>::advance(3.75f, references, threadCount);
+        for(std::size_t i = 0; i != ParallelPlayerCount; ++i) {
+            CORRADE_ITERATION(i);
+            CORRADE_COMPARE(players[i].state(), State::Playing);
+            CORRADE_COMPARE(values[i], i % 2 ? 2.75f : 4.0f);
+        }
+    }
+}
+
+void PlayerTest::advanceParallelStateChanged() {
+    Containers::Array<Float> values{DirectInit, ParallelPlayerCount, -1.0f};
+    Containers::Array<Player<Float>> players{DirectInit, ParallelPlayerCount};
+    Containers::Array<Containers::Reference<Player<Float>>> references;
+    for(std::size_t i = 0; i != ParallelPlayerCount; ++i) {
+        players[i].add(Track, values[i])
+            .play(i % 2 ? 10.0f : 0.0f);
+        arrayAppend(references, players[i]);
+    }
+
+    struct Changed {
+        std::thread::id threadId;
+        Containers::Array<std::pair<Player<Float>*, State>> players;
+    } changed;
+    changed.threadId = std::this_thread::get_id();
+
+    /* Even players run out, odd players didn't start yet */
+    Player<Float>::advance(5.5f, references, 0, [](Player<Float>& player, State state, void* userData) {
+        Changed& changed = *static_cast<Changed*>(userData);
+        /* Not recording calls from other threads, which makes the size
+           check below fail */
+        if(std::this_thread::get_id() != changed.threadId) return;
+        arrayAppend(changed.players, InPlaceInit, &player, state);
+    }, &changed);
+
+    CORRADE_COMPARE(changed.players.size(), ParallelPlayerCount/2);
+    for(std::size_t i = 0; i != changed.players.size(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(changed.players[i].first, &players[i*2]);
+        CORRADE_COMPARE(changed.players[i].second, State::Playing);
+        CORRADE_COMPARE(players[i*2].state(), State::Stopped);
+        CORRADE_COMPARE(values[i*2], 2.0f);
+    }
+    for(std::size_t i = 1; i < ParallelPlayerCount; i += 2) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(players[i].state(), State::Playing);
+        CORRADE_COMPARE(values[i], -1.0f);
+    }
+}
+
 void PlayerTest::advanceZeroDurationStop() {
     Float value = -1.0f;
     Player<Float> player;
@@ -1122,6 +1205,55 @@ void PlayerTest::seekToPausedParked() {
     CORRADE_COMPARE(value, -1.0f);
 }
 
+void PlayerTest::seekKeyframeLookup() {
+    /* A long track and a batch of two tracks, with the values being
+       multiples of the key */
+    Float keys[100];
+    Float values[100];
+    Float batchValues[200];
+    for(std::size_t i = 0; i != 100; ++i) {
+        keys[i] = Float(i);
+        values[i] = Float(i)*2.0f;
+        batchValues[i*2 + 0] = Float(i)*3.0f;
+        batchValues[i*2 + 1] = -Float(i);
+    }
+
+    Float value = -1.0f;
+    Float batchDestination[2]{-1.0f, -1.0f};
+    Player<Float> player;
+    player.add(TrackView<const Float, const Float>{keys, values, Math::lerp}, value)
+        .addBatch<Float, Float>(keys,
+            Containers::StridedArrayView2D<const Float>{batchValues, {100, 2}},
+            Math::lerp, Containers::arrayView(batchDestination))
+        .buildKeyframeLookup()
+        .play(0.0f);
+
+    player.advance(90.5f);
+    CORRADE_COMPARE(value, 181.0f);
+    CORRADE_COMPARE(batchDestination[0], 271.5f);
+    CORRADE_COMPARE(batchDestination[1], -90.5f);
+
+    /* Seeking back should give the same values as without the lookup */
+    player.seekTo(90.5f, 10.25f)
+        .advance(90.5f);
+    CORRADE_COMPARE(value, 20.5f);
+    CORRADE_COMPARE(batchDestination[0], 30.75f);
+    CORRADE_COMPARE(batchDestination[1], -10.25f);
+
+    /* Seeking forward as well */
+    player.seekBy(50.0f)
+        .advance(90.5f);
+    CORRADE_COMPARE(value, 120.5f);
+    CORRADE_COMPARE(batchDestination[0], 180.75f);
+    CORRADE_COMPARE(batchDestination[1], -60.25f);
+
+    /* Regular playback continues from there */
+    player.advance(91.5f);
+    CORRADE_COMPARE(value, 122.5f);
+    CORRADE_COMPARE(batchDestination[0], 183.75f);
+    CORRADE_COMPARE(batchDestination[1], -61.25f);
+}
+
 void PlayerTest::setState() {
     Player<Float> player;
     CORRADE_COMPARE(player.state(), State::Stopped);
@@ -1328,6 +1460,112 @@ template<class T> void PlayerTest::addRawCallback() {
         TestSuite::Compare::Container);
 }
 
+/* Same keys as Track, the first track has the same values, the second twice
+   the values */
+constexpr Float BatchKeys[]{1.0f, 2.5f, 3.0f, 4.0f};
+constexpr Float BatchValues[]{
+    1.5f, 3.0f,
+    3.0f, 6.0f,
+    5.0f, 10.0f,
+    2.0f, 4.0f
+};
+
+void PlayerTest::addBatch() {
+    Float values[]{-1.0f, -1.0f};
+    Player<Float> player;
+    player.addBatch<Float, Float>(BatchKeys,
+        Containers::StridedArrayView2D<const Float>{BatchValues, {4, 2}},
+        Math::lerp, Containers::arrayView(values))
+        .play(2.0f);
+
+    CORRADE_VERIFY(!player.isEmpty());
+    CORRADE_COMPARE(player.size(), 0);
+    CORRADE_COMPARE(player.batchCount(), 1);
+    CORRADE_COMPARE(player.duration(), (Range1D{1.0f, 4.0f}));
+    CORRADE_COMPARE(player.state(), State::Playing);
+    CORRADE_COMPARE(values[0], -1.0f);
+    CORRADE_COMPARE(values[1], -1.0f);
+
+    /* 1.75 secs in */
+    player.advance(3.75f);
+    CORRADE_COMPARE(player.state(), State::Playing);
+    CORRADE_COMPARE(values[0], 4.0f);
+    CORRADE_COMPARE(values[1], 8.0f);
+
+    /* When the player gets stopped, the value at the stop time is written */
+    player.advance(5.5f);
+    CORRADE_COMPARE(player.state(), State::Stopped);
+    CORRADE_COMPARE(values[0], 2.0f);
+    CORRADE_COMPARE(values[1], 4.0f);
+}
+
+void PlayerTest::addBatchCompileTimeInterpolator() {
+    Float values[]{-1.0f, -1.0f};
+    Player<Float> player;
+    player.addBatch<Float, Float, Math::lerp>(BatchKeys,
+        Containers::StridedArrayView2D<const Float>{BatchValues, {4, 2}},
+        Containers::arrayView(values))
+        .play(2.0f);
+
+    CORRADE_COMPARE(player.batchCount(), 1);
+    CORRADE_COMPARE(player.duration(), (Range1D{1.0f, 4.0f}));
+
+    /* 1.75 secs in */
+    player.advance(3.75f);
+    CORRADE_COMPARE(values[0], 4.0f);
+    CORRADE_COMPARE(values[1], 8.0f);
+}
+
+void PlayerTest::addBatchDuration() {
+    Animation::Track<Float, Int> track{{
+        {0.5f, 42},
+        {3.0f, 1337},
+        {3.5f, -17}
+    }, Math::select};
+
+    Int value = -1;
+    Float values[]{-1.0f, -1.0f};
+    Player<Float> player;
+    player.addBatch<Float, Float>(BatchKeys,
+        Containers::StridedArrayView2D<const Float>{BatchValues, {4, 2}},
+        Math::lerp, Containers::arrayView(values));
+    CORRADE_COMPARE(player.duration(), (Range1D{1.0f, 4.0f}));
+
+    /* The duration is a union of both tracks and batches */
+    player.add(track, value);
+    CORRADE_COMPARE(player.size(), 1);
+    CORRADE_COMPARE(player.batchCount(), 1);
+    CORRADE_COMPARE(player.duration(), (Range1D{0.5f, 4.0f}));
+
+    /* 2.25 secs in, which is 2.75 in the keyframe time as the duration starts
+       at 0.5 */
+    player.play(0.0f)
+        .advance(2.25f);
+    CORRADE_COMPARE(value, 42);
+    CORRADE_COMPARE(values[0], 4.0f);
+    CORRADE_COMPARE(values[1], 8.0f);
+}
+
+void PlayerTest::addBatchInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Float values[2];
+    Player<Float> player;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    player.addBatch<Float, Float>(Containers::arrayView(BatchKeys).prefix(3),
+        Containers::StridedArrayView2D<const Float>{BatchValues, {4, 2}},
+        Math::lerp, Containers::arrayView(values));
+    player.addBatch<Float, Float>(BatchKeys,
+        Containers::StridedArrayView2D<const Float>{BatchValues, {4, 2}},
+        Math::lerp, Containers::arrayView(values).prefix(1));
+    CORRADE_COMPARE(out.str(),
+        "Animation::Player::addBatch(): expected 3 keyframes but got 4\n"
+        "Animation::Player::addBatch(): expected destination size to be 2 but got 1\n");
+    CORRADE_VERIFY(player.isEmpty());
+}
+
 void PlayerTest::runFor100YearsFloat() {
     auto&& data = RunFor100YearsData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
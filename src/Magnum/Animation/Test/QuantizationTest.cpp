@@ -0,0 +1,129 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+
+#include "Magnum/Animation/Interpolation.h"
+#include "Magnum/Animation/Quantization.h"
+#include "Magnum/Animation/Track.h"
+
+namespace Magnum { namespace Animation { namespace Test { namespace {
+
+struct QuantizationTest: TestSuite::Tester {
+    explicit QuantizationTest();
+
+    void packUnpackQuaternion();
+    void packQuaternionNegativeLargest();
+    void packQuaternionPrecision();
+    void unpackQuaternionTrack();
+};
+
+using namespace Math::Literals;
+
+const struct {
+    const char* name;
+    Quaternion value;
+    UnsignedInt largest;
+} PackUnpackQuaternionData[]{
+    {"identity", Quaternion{}, 3},
+    {"largest X", Quaternion::rotation(150.0_degf, Vector3::xAxis()), 0},
+    {"largest Y", Quaternion::rotation(170.0_degf, Vector3{0.1f, 1.0f, -0.2f}.normalized()), 1},
+    {"largest Z", Quaternion::rotation(160.0_degf, Vector3{0.3f, 0.2f, 1.0f}.normalized()), 2},
+    {"largest W", Quaternion::rotation(35.0_degf, Vector3{1.0f, -1.0f, 0.5f}.normalized()), 3}
+};
+
+QuantizationTest::QuantizationTest() {
+    addInstancedTests({&QuantizationTest::packUnpackQuaternion},
+        Containers::arraySize(PackUnpackQuaternionData));
+
+    addTests({&QuantizationTest::packQuaternionNegativeLargest,
+              &QuantizationTest::packQuaternionPrecision,
+              &QuantizationTest::unpackQuaternionTrack});
+}
+
+Float maxComponentDifference(const Quaternion& a, const Quaternion& b) {
+    return Math::max(Math::abs(a.vector() - b.vector()).max(), Math::abs(a.scalar() - b.scalar()));
+}
+
+void QuantizationTest::packUnpackQuaternion() {
+    auto&& data = PackUnpackQuaternionData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const UnsignedInt packed = packQuaternionSmallestThree(data.value);
+    CORRADE_COMPARE(packed >> 30, data.largest);
+
+    /* The input has the largest component positive, so no sign flip should
+       happen */
+    const Quaternion unpacked = unpackQuaternionSmallestThree(packed);
+    CORRADE_VERIFY(unpacked.isNormalized());
+    CORRADE_COMPARE_AS(maxComponentDifference(unpacked, data.value), 0.002f,
+        TestSuite::Compare::Less);
+}
+
+void QuantizationTest::packQuaternionNegativeLargest() {
+    const Quaternion a = Quaternion::rotation(35.0_degf, Vector3{1.0f, -1.0f, 0.5f}.normalized());
+
+    /* Both q and -q represent the same rotation, so they should pack to the
+       same value and unpack to the one with a positive largest component */
+    CORRADE_COMPARE(packQuaternionSmallestThree(-a), packQuaternionSmallestThree(a));
+    CORRADE_COMPARE_AS(maxComponentDifference(unpackQuaternionSmallestThree(packQuaternionSmallestThree(-a)), a), 0.002f,
+        TestSuite::Compare::Less);
+}
+
+void QuantizationTest::packQuaternionPrecision() {
+    /* Go through a bunch of rotations around various axes and verify the
+       angle error stays small */
+    Float maxAngle = 0.0f;
+    for(Int i = 0; i != 360; ++i) {
+        const Vector3 axis = Vector3{Math::sin(Deg(i*7.0f)), Math::cos(Deg(i*3.0f)), 0.5f}.normalized();
+        const Quaternion a = Quaternion::rotation(Deg(Float(i)), axis);
+        const Quaternion b = unpackQuaternionSmallestThree(packQuaternionSmallestThree(a));
+        maxAngle = Math::max(maxAngle, 2.0f*std::acos(Math::min(Math::abs(Math::dot(a, b)), 1.0f)));
+    }
+
+    CORRADE_COMPARE_AS(maxAngle, Float(Rad(0.5_degf)),
+        TestSuite::Compare::Less);
+}
+
+void QuantizationTest::unpackQuaternionTrack() {
+    const Quaternion a = Quaternion::rotation(15.0_degf, Vector3::yAxis());
+    const Quaternion b = Quaternion::rotation(75.0_degf, Vector3::yAxis());
+
+    const Float keys[]{0.0f, 2.0f};
+    const UnsignedInt values[]{
+        packQuaternionSmallestThree(a),
+        packQuaternionSmallestThree(b)
+    };
+
+    const TrackView<const Float, const UnsignedInt, Quaternion> track{keys, values,
+        unpack<UnsignedInt, Quaternion, Math::slerp, unpackQuaternionSmallestThree>()};
+    CORRADE_COMPARE_AS(maxComponentDifference(track.at(1.0f), Quaternion::rotation(45.0_degf, Vector3::yAxis())), 0.002f,
+        TestSuite::Compare::Less);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Animation::Test::QuantizationTest)
@@ -82,6 +82,11 @@ remember last used keyframe index and pass it in the next iteration as a hint:
 
 @snippet MagnumAnimation.cpp Track-performance-hint
 
+For random access into long tracks, such as when scrubbing through a timeline,
+the hint alone doesn't help as every seek backwards needs to search from the
+beginning again. Use a @ref KeyframeLookup to get a good hint for an arbitrary
+frame in constant time.
+
 @subsection Animation-Track-performance-strict Strict interpolation
 
 While it's possible to have different @ref Extrapolation modes for frames
@@ -0,0 +1,286 @@
+#ifndef Magnum_AsyncResourceLoader_h
+#define Magnum_AsyncResourceLoader_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::AsyncResourceLoader
+ * @m_since_latest
+ */
+
+#include <deque>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pointer.h>
+#if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif
+
+#include "Magnum/AbstractResourceLoader.h"
+
+namespace Magnum {
+
+/**
+@brief Base for asynchronous resource loaders
+@tparam T   Resource type
+@tparam D   Type of decoded data, passed from the worker thread to the main
+    thread
+@m_since_latest
+
+Splits the loading into two parts. Data decoding, such as opening a file and
+importing it, is done in @ref doDecode() on a background worker thread and
+doesn't block @ref ResourceManager::get(). The decoded data are then passed to
+@ref doUpload() on the main thread from @ref ResourceManager::update(), where
+GPU resources can be created. Until then the resource is in the
+@ref ResourceState::Loading state, afterwards it's either
+@ref ResourceState::Final or @ref ResourceState::NotFound, with no need to
+set the state manually.
+
+@snippet Magnum.cpp AsyncResourceLoader-implementation
+
+Call @ref ResourceManager::update() once per frame with a time budget to
+limit how much of the frame is spent creating the resources:
+
+@snippet Magnum.cpp AsyncResourceLoader-use
+
+If Corrade isn't built with @ref CORRADE_BUILD_MULTITHREADED or when
+targeting @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten", no worker threads are
+created and @ref doDecode() is called from @ref ResourceManager::update() as
+well, sharing the same time budget.
+
+@section AsyncResourceLoader-lifetime Worker lifetime
+
+The worker threads are started on the first request and stopped in the
+destructor. Because destructors of subclasses run before the threads are
+stopped, a subclass that accesses its own state in @ref doDecode() should call
+@ref stop() in its destructor. Requests that weren't processed by
+@ref ResourceManager::update() at that point are discarded and the resources
+stay in the @ref ResourceState::Loading state.
+*/
+template<class T, class D> class AsyncResourceLoader: public AbstractResourceLoader<T> {
+    public:
+        /**
+         * @brief Constructor
+         * @param threadCount   Count of worker threads. If @cpp 0 @ce,
+         *      @ref std::thread::hardware_concurrency() is used.
+         */
+        explicit AsyncResourceLoader(UnsignedInt threadCount = 1): _threadCount{threadCount} {
+            #if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+            if(!_threadCount) _threadCount = std::thread::hardware_concurrency();
+            /* hardware_concurrency() can return 0 if it's not known */
+            if(!_threadCount) _threadCount = 1;
+            #else
+            _threadCount = 0;
+            #endif
+        }
+
+        /**
+         * @brief Destructor
+         *
+         * Calls @ref stop().
+         */
+        ~AsyncResourceLoader() { stop(); }
+
+        /**
+         * @brief Count of worker threads
+         *
+         * Always @cpp 0 @ce if Corrade isn't built with
+         * @ref CORRADE_BUILD_MULTITHREADED or when targeting
+         * @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten".
+         */
+        UnsignedInt threadCount() const { return _threadCount; }
+
+        /**
+         * @brief Count of pending resources
+         *
+         * Resources that were requested but not yet passed to the manager
+         * in @ref ResourceManager::update().
+         */
+        std::size_t pendingCount() const { return _pendingCount; }
+
+        /**
+         * @brief Stop the worker threads
+         *
+         * Waits until the worker threads finish the resource they're
+         * currently decoding and joins them. Resources that weren't decoded
+         * yet or weren't passed to the manager are discarded. Subsequent
+         * requests will start the worker threads again.
+         */
+        void stop();
+
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    private:
+    #else
+    protected:
+    #endif
+        /**
+         * @brief Decode resource data
+         *
+         * Called on a worker thread for each requested resource. Should
+         * return an empty @relativeref{Corrade,Containers::Optional} if the
+         * resource wasn't found. Calls to this function can happen from
+         * multiple threads at once if @ref threadCount() is larger than
+         * @cpp 1 @ce and must not access the @ref ResourceManager.
+         */
+        virtual Containers::Optional<D> doDecode(ResourceKey key) = 0;
+
+        /**
+         * @brief Create a resource from decoded data
+         *
+         * Called from @ref ResourceManager::update() on the main thread for
+         * each successfully decoded resource. The returned resource is
+         * passed to the manager with @ref ResourceDataState::Final and
+         * @ref ResourcePolicy::Resident. If @cpp nullptr @ce is returned, the
+         * resource is marked as not found.
+         */
+        virtual Containers::Pointer<T> doUpload(ResourceKey key, D&& data) = 0;
+
+    private:
+        void doLoad(ResourceKey key) override final;
+        std::size_t doUpdate(std::chrono::nanoseconds budget) override final;
+
+        struct Decoded {
+            ResourceKey key;
+            Containers::Optional<D> data;
+        };
+
+        #if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+        void work();
+
+        std::mutex _mutex;
+        std::condition_variable _condition;
+        std::vector<std::thread> _threads;
+        bool _quit{};
+        #endif
+        /* Guarded by the mutex if there are worker threads */
+        std::deque<ResourceKey> _requested;
+        std::deque<Decoded> _decoded;
+
+        UnsignedInt _threadCount;
+        /* Accessed only from the main thread */
+        std::size_t _pendingCount{};
+};
+
+template<class T, class D> void AsyncResourceLoader<T, D>::stop() {
+    #if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _quit = true;
+    }
+    _condition.notify_all();
+    for(std::thread& thread: _threads) thread.join();
+    _threads.clear();
+    _quit = false;
+    #endif
+
+    _requested.clear();
+    _decoded.clear();
+    _pendingCount = 0;
+}
+
+template<class T, class D> void AsyncResourceLoader<T, D>::doLoad(const ResourceKey key) {
+    ++_pendingCount;
+
+    #if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _requested.push_back(key);
+    }
+    _condition.notify_one();
+
+    /* Start the workers lazily, so loaders that never get any request don't
+       have any threads */
+    if(_threads.empty()) for(UnsignedInt i = 0; i != _threadCount; ++i)
+        _threads.emplace_back(&AsyncResourceLoader<T, D>::work, this);
+    #else
+    _requested.push_back(key);
+    #endif
+}
+
+#if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+template<class T, class D> void AsyncResourceLoader<T, D>::work() {
+    std::unique_lock<std::mutex> lock{_mutex};
+    for(;;) {
+        _condition.wait(lock, [this]{ return _quit || !_requested.empty(); });
+        if(_quit) return;
+
+        const ResourceKey key = _requested.front();
+        _requested.pop_front();
+
+        /* Decode without holding the lock so the other workers and the main
+           thread can continue */
+        lock.unlock();
+        Containers::Optional<D> data = doDecode(key);
+        lock.lock();
+
+        _decoded.push_back(Decoded{key, std::move(data)});
+    }
+}
+#endif
+
+template<class T, class D> std::size_t AsyncResourceLoader<T, D>::doUpdate(const std::chrono::nanoseconds budget) {
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    std::size_t count = 0;
+    for(;;) {
+        /* Always process at least one resource, stop once the budget is
+           exhausted */
+        if(count && budget != std::chrono::nanoseconds{} && std::chrono::steady_clock::now() - start >= budget)
+            break;
+
+        Containers::Optional<Decoded> decoded;
+        #if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+        {
+            std::lock_guard<std::mutex> lock{_mutex};
+            if(_decoded.empty()) break;
+            decoded = std::move(_decoded.front());
+            _decoded.pop_front();
+        }
+        #else
+        /* No worker threads, decode on the calling thread */
+        if(_requested.empty()) break;
+        const ResourceKey key = _requested.front();
+        _requested.pop_front();
+        decoded = Decoded{key, doDecode(key)};
+        #endif
+
+        Containers::Pointer<T> resource;
+        if(decoded->data)
+            resource = doUpload(decoded->key, std::move(*decoded->data));
+        if(resource) this->set(decoded->key, std::move(resource));
+        else this->setNotFound(decoded->key);
+
+        --_pendingCount;
+        ++count;
+    }
+
+    return count;
+}
+
+}
+
+#endif
@@ -32,10 +32,14 @@
 #include <Corrade/Containers/String.h>
 #include <Corrade/Containers/StringStl.h> /** @todo remove once AbstractImporter is <string>-free */
 #include <Corrade/PluginManager/Manager.hpp>
+#include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/DebugStl.h> /** @todo remove once AbstractImporter is <string>-free */
 #include <Corrade/Utility/Path.h>
 
+#include "Magnum/Audio/BufferFormat.h"
+#include "Magnum/Math/Functions.h"
+
 #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
 #include "Magnum/Audio/configure.h"
 #endif
@@ -53,7 +57,7 @@ using namespace Containers::Literals;
 Containers::StringView AbstractImporter::pluginInterface() {
     return
 /* [interface] */
-"cz.mosra.magnum.Audio.AbstractImporter/0.1"_s
+"cz.mosra.magnum.Audio.AbstractImporter/0.2"_s
 /* [interface] */
     ;
 }
@@ -100,6 +104,19 @@ void AbstractImporter::doOpenData(Containers::ArrayView<const char>) {
     CORRADE_ASSERT_UNREACHABLE("Audio::AbstractImporter::openData(): feature advertised but not implemented", );
 }
 
+bool AbstractImporter::openMemory(Containers::ArrayView<const void> memory) {
+    CORRADE_ASSERT(features() & ImporterFeature::OpenData,
+        "Audio::AbstractImporter::openMemory(): feature not supported", {});
+
+    close();
+    doOpenMemory(Containers::arrayCast<const char>(memory));
+    return isOpened();
+}
+
+void AbstractImporter::doOpenMemory(const Containers::ArrayView<const char> memory) {
+    doOpenData(memory);
+}
+
 bool AbstractImporter::openFile(const std::string& filename) {
     close();
     doOpenFile(filename);
@@ -124,6 +141,11 @@ void AbstractImporter::close() {
         doClose();
         CORRADE_INTERNAL_ASSERT(!isOpened());
     }
+
+    /* Free the data used by the default dataChunk() implementation */
+    _dataChunkData = nullptr;
+    _dataChunkOffset = 0;
+    _dataChunkDecoded = false;
 }
 
 BufferFormat AbstractImporter::format() const {
@@ -144,6 +166,56 @@ Containers::Array<char> AbstractImporter::data() {
     return out;
 }
 
+Containers::Optional<Containers::ArrayView<const char>> AbstractImporter::dataView() {
+    CORRADE_ASSERT(isOpened(), "Audio::AbstractImporter::dataView(): no file opened", {});
+    return doDataView();
+}
+
+Containers::Optional<Containers::ArrayView<const char>> AbstractImporter::doDataView() {
+    return {};
+}
+
+std::size_t AbstractImporter::dataChunk(const Containers::ArrayView<void> destination) {
+    CORRADE_ASSERT(isOpened(), "Audio::AbstractImporter::dataChunk(): no file opened", {});
+
+    const std::size_t frameSize = bufferFormatSize(doFormat());
+    CORRADE_ASSERT(destination.size() >= frameSize,
+        "Audio::AbstractImporter::dataChunk(): expected at least" << frameSize << "bytes for a sample frame but got" << destination.size(), {});
+
+    /* Pass only whole sample frames to the implementation */
+    const std::size_t size = destination.size()/frameSize*frameSize;
+    const std::size_t out = doDataChunk(Containers::arrayCast<char>(destination).prefix(size));
+    CORRADE_ASSERT(out <= size && out % frameSize == 0,
+        "Audio::AbstractImporter::dataChunk(): implementation returned" << out << "bytes for a destination of" << size << "bytes with" << frameSize << "bytes per sample frame", {});
+    return out;
+}
+
+std::size_t AbstractImporter::doDataChunk(const Containers::ArrayView<char> destination) {
+    /* Decode everything on the first call */
+    if(!_dataChunkDecoded) {
+        _dataChunkData = doData();
+        _dataChunkDecoded = true;
+    }
+
+    /* Copy only whole sample frames in case the data size is not a multiple
+       of the frame size */
+    const std::size_t frameSize = bufferFormatSize(doFormat());
+    const std::size_t available = _dataChunkData.size() - Math::min(_dataChunkOffset, _dataChunkData.size());
+    const std::size_t size = Math::min(destination.size(), available/frameSize*frameSize);
+    Utility::copy(_dataChunkData.sliceSize(_dataChunkOffset, size), destination.prefix(size));
+    _dataChunkOffset += size;
+    return size;
+}
+
+void AbstractImporter::seekData(const std::size_t frame) {
+    CORRADE_ASSERT(isOpened(), "Audio::AbstractImporter::seekData(): no file opened", );
+    doSeekData(frame);
+}
+
+void AbstractImporter::doSeekData(const std::size_t frame) {
+    _dataChunkOffset = frame*bufferFormatSize(doFormat());
+}
+
 Debug& operator<<(Debug& debug, const ImporterFeature value) {
     debug << "Audio::ImporterFeature" << Debug::nospace;
 
@@ -29,6 +29,8 @@
  * @brief Class @ref Magnum::Audio::AbstractImporter, enum @ref Magnum::Audio::ImporterFeature, enum set @ref Magnum::Audio::ImporterFeatures
  */
 
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
 #include <Corrade/PluginManager/AbstractManagingPlugin.h>
 #include <Corrade/Utility/StlForwardString.h>
 
@@ -80,11 +82,47 @@ around in order to have the returned data valid. Moreover, all returned
 deleters --- this is to avoid potential dangling function pointer calls when
 destructing such instances after the plugin module has been unloaded.
 
+@section Audio-AbstractImporter-streaming Streaming
+
+Instead of getting all data at once via @ref data(), which for long music
+tracks may need a lot of memory, the data can be decoded in chunks using
+@ref dataChunk(). Use @ref seekData() to go back to the beginning or to any
+other place in the data. The @ref StreamingSource class provides a high-level
+interface that streams the data through a queue of buffers:
+
+@snippet MagnumAudio.cpp AbstractImporter-dataChunk
+
+Importers that don't implement chunked decoding natively fall back to
+decoding all data via @ref data() on the first call to @ref dataChunk(), so
+the interface is available for all of them, just without the memory savings.
+
+@section Audio-AbstractImporter-zero-copy Zero-copy data access
+
+If the file is opened with @ref openMemory() instead of @ref openData() or
+@ref openFile(), the importer is allowed to reference the passed memory
+directly instead of making a copy of it. If the sample data are stored in the
+file in a way that matches @ref format() --- such as uncompressed PCM in the
+machine endianness --- @ref dataView() then returns a view directly into the
+passed memory, without any copy or decoding. Together with
+@relativeref{Corrade,Utility::Path::mapRead()} this makes it possible to
+access large sound banks with nearly zero load time and memory overhead, as
+only the pages that actually get uploaded to a buffer get read from the disk:
+
+@snippet MagnumAudio.cpp AbstractImporter-dataView
+
+If the importer doesn't support zero-copy access or the data have to be
+converted, @ref dataView() returns @relativeref{Corrade,Containers::NullOpt}
+and you have to use @ref data() or @ref dataChunk() instead.
+
 @section Audio-AbstractImporter-subclassing Subclassing
 
 Plugin implements function @ref doFeatures(), @ref doIsOpened(), one of or both
 @ref doOpenData() and @ref doOpenFile() functions, function @ref doClose() and
 data access functions @ref doFormat(), @ref doFrequency() and @ref doData().
+Optionally, @ref doDataChunk() and @ref doSeekData() can be implemented to
+support chunked decoding without keeping all decoded data in memory, and
+@ref doOpenMemory() together with @ref doDataView() can be implemented to
+support zero-copy access to the sample data.
 
 You don't need to do most of the redundant sanity checks, these things are
 checked by the implementation:
@@ -92,8 +130,8 @@ checked by the implementation:
 -   Functions @ref doOpenData() and @ref doOpenFile() are called after the
     previous file was closed, function @ref doClose() is called only if there
     is any file opened.
--   Function @ref doOpenData() is called only if @ref ImporterFeature::OpenData
-    is supported.
+-   Functions @ref doOpenData() and @ref doOpenMemory() are called only if
+    @ref ImporterFeature::OpenData is supported.
 -   All `do*()` implementations working on opened file are called only if
     there is any file opened.
 
@@ -170,17 +208,33 @@ class MAGNUM_AUDIO_EXPORT AbstractImporter: public PluginManager::AbstractManagi
          * file. Available only if @ref ImporterFeature::OpenData is supported.
          * On failure prints a message to @relativeref{Magnum,Error} and
          * returns @cpp false @ce.
-         * @see @ref features(), @ref openFile()
+         * @see @ref features(), @ref openFile(), @ref openMemory()
          */
         bool openData(Containers::ArrayView<const void> data);
 
+        /**
+         * @brief Open externally owned memory
+         * @m_since_latest
+         *
+         * Like @ref openData(), but the importer is allowed to reference
+         * @p memory directly instead of copying it, so the memory has to stay
+         * in scope and unchanged until the file is closed. Useful together
+         * with @relativeref{Corrade,Utility::Path::mapRead()} and
+         * @ref dataView(), see @ref Audio-AbstractImporter-zero-copy for more
+         * information. Available only if @ref ImporterFeature::OpenData is
+         * supported. On failure prints a message to
+         * @relativeref{Magnum,Error} and returns @cpp false @ce.
+         * @see @ref features()
+         */
+        bool openMemory(Containers::ArrayView<const void> memory);
+
         /**
          * @brief Open file
          *
          * Closes previous file, if it was opened, and tries to open given
          * file. On failure prints a message to @relativeref{Magnum,Error} and
          * returns @cpp false @ce.
-         * @see @ref features(), @ref openData()
+         * @see @ref features(), @ref openData(), @ref openMemory()
          */
         bool openFile(const std::string& filename);
 
@@ -195,9 +249,56 @@ class MAGNUM_AUDIO_EXPORT AbstractImporter: public PluginManager::AbstractManagi
         /** @brief Sample frequency */
         UnsignedInt frequency() const;
 
-        /** @brief Sample data */
+        /**
+         * @brief Sample data
+         *
+         * @see @ref dataView(), @ref dataChunk()
+         */
         Containers::Array<char> data();
 
+        /**
+         * @brief Sample data view
+         * @m_since_latest
+         *
+         * If the importer is able to provide the sample data without
+         * converting them, returns a view on them, otherwise returns
+         * @relativeref{Corrade,Containers::NullOpt}. The view is valid only
+         * until the file is closed. If the file was opened with
+         * @ref openMemory(), the view may point directly into the memory
+         * passed to it. See @ref Audio-AbstractImporter-zero-copy for more
+         * information.
+         * @see @ref data()
+         */
+        Containers::Optional<Containers::ArrayView<const char>> dataView();
+
+        /**
+         * @brief Decode next chunk of sample data
+         * @param destination   Where to put the data
+         * @return Size of the data written to @p destination, in bytes
+         * @m_since_latest
+         *
+         * Decodes as many whole sample frames as fit into @p destination,
+         * continuing where the previous call ended, and returns size of the
+         * data written. Returns @cpp 0 @ce once the end of the data is
+         * reached. Expects that @p destination is large enough for at least
+         * one sample frame, size of which is @ref bufferFormatSize() of
+         * @ref format(). See @ref Audio-AbstractImporter-streaming for more
+         * information.
+         * @see @ref seekData()
+         */
+        std::size_t dataChunk(Containers::ArrayView<void> destination);
+
+        /**
+         * @brief Seek in the sample data
+         * @param frame         Sample frame to seek to
+         * @m_since_latest
+         *
+         * Makes the next @ref dataChunk() call continue from sample frame
+         * @p frame. Seeking past the end makes the next call return
+         * @cpp 0 @ce.
+         */
+        void seekData(std::size_t frame);
+
         /* Since 1.8.17, the original short-hand group closing doesn't work
            anymore. FFS. */
         /**
@@ -214,6 +315,15 @@ class MAGNUM_AUDIO_EXPORT AbstractImporter: public PluginManager::AbstractManagi
         /** @brief Implementation for @ref openData() */
         virtual void doOpenData(Containers::ArrayView<const char> data);
 
+        /**
+         * @brief Implementation for @ref openMemory()
+         * @m_since_latest
+         *
+         * Default implementation calls @ref doOpenData(), which is expected
+         * to not reference the passed data after it returns.
+         */
+        virtual void doOpenMemory(Containers::ArrayView<const char> memory);
+
         /**
          * @brief Implementation for @ref openFile()
          *
@@ -234,6 +344,43 @@ class MAGNUM_AUDIO_EXPORT AbstractImporter: public PluginManager::AbstractManagi
 
         /** @brief Implementation for @ref data() */
         virtual Containers::Array<char> doData() = 0;
+
+        /**
+         * @brief Implementation for @ref dataView()
+         * @m_since_latest
+         *
+         * Default implementation returns
+         * @relativeref{Corrade,Containers::NullOpt}.
+         */
+        virtual Containers::Optional<Containers::ArrayView<const char>> doDataView();
+
+        /**
+         * @brief Implementation for @ref dataChunk()
+         * @m_since_latest
+         *
+         * The @p destination is guaranteed to have a size that's a non-zero
+         * multiple of the sample frame size. The implementation is expected
+         * to return a multiple of the sample frame size as well. Default
+         * implementation calls @ref doData() on the first call and then
+         * copies the data from the result, which is freed on @ref close().
+         */
+        virtual std::size_t doDataChunk(Containers::ArrayView<char> destination);
+
+        /**
+         * @brief Implementation for @ref seekData()
+         * @m_since_latest
+         *
+         * Default implementation adjusts the offset into the data
+         * retrieved by the default @ref doDataChunk() implementation. If you
+         * override @ref doDataChunk(), you have to override this function as
+         * well.
+         */
+        virtual void doSeekData(std::size_t frame);
+
+        /* Used by the default doDataChunk() / doSeekData() implementation */
+        Containers::Array<char> _dataChunkData;
+        std::size_t _dataChunkOffset{};
+        bool _dataChunkDecoded{};
 };
 
 }}
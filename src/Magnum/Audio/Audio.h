@@ -45,6 +45,7 @@ enum class BufferFormat: ALenum;
 class Buffer;
 class Context;
 class Source;
+class StreamingSource;
 /* Renderer used only statically */
 
 template<UnsignedInt> class Playable;
@@ -193,6 +193,16 @@ enum class BufferFormat: ALenum {
     Surround71Channel32 = AL_FORMAT_71CHN32
 };
 
+/**
+@brief Size of a sample frame in given format
+@m_since_latest
+
+Returns size of a single sample for all channels together, in bytes. Useful
+for splitting the data into chunks, for example in
+@ref AbstractImporter::dataChunk().
+*/
+MAGNUM_AUDIO_EXPORT UnsignedInt bufferFormatSize(BufferFormat format);
+
 /** @debugoperatorenum{BufferFormat} */
 MAGNUM_AUDIO_EXPORT Debug& operator<<(Debug& debug, BufferFormat value);
 
@@ -97,6 +97,12 @@ template<UnsignedInt dimensions> void Listener<dimensions>::update(std::initiali
 
     /* Use the more performant way to set multiple objects clean */
     SceneGraph::AbstractObject<dimensions, Float>::setClean(objects);
+
+    /* Assign pooled sources in groups with voice virtualization, now that
+       all positions are up-to-date */
+    const Vector3 listenerPosition = Renderer::listenerPosition();
+    for(PlayableGroup<dimensions>& group: groups)
+        group.updateVoices(listenerPosition);
 }
 
 template<UnsignedInt dimensions> Listener<dimensions>& Listener<dimensions>::setGain(const Float gain) {
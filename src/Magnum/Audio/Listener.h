@@ -117,7 +117,9 @@ template<UnsignedInt dimensions> class Listener: public SceneGraph::AbstractFeat
          * all objects of the @ref Playable "Playables" in the group to reflect
          * transformation changes to spatial audio behavior. Also updates
          * listener-related configuration for @ref Renderer (position,
-         * orientation, gain).
+         * orientation, gain). For groups with voice
+         * virtualization enabled assigns the pooled sources to the most
+         * audible playables, see @ref PlayableGroup::setVoiceCount().
          */
         void update(std::initializer_list<Containers::Reference<PlayableGroup<dimensions>>> groups);
 
@@ -26,6 +26,7 @@
 
 #include "Playable.h"
 
+#include "Magnum/Audio/Buffer.h"
 #include "Magnum/Audio/PlayableGroup.h"
 #include "Magnum/Math/Matrix3.h"
 #include "Magnum/Math/Matrix4.h"
@@ -36,7 +37,81 @@ template<UnsignedInt dimensions> Playable<dimensions>::Playable(SceneGraph::Abst
     SceneGraph::AbstractFeature<dimensions, Float>::setCachedTransformations(SceneGraph::CachedTransformation::Absolute);
 }
 
-template<UnsignedInt dimensions> Playable<dimensions>::~Playable() = default;
+template<UnsignedInt dimensions> Playable<dimensions>::~Playable() {
+    /* The group may have been changed since the voice was assigned, so not
+       using playables() here */
+    if(_voiceGroup) _voiceGroup->releaseVoice(*this);
+}
+
+template<UnsignedInt dimensions> Source& Playable<dimensions>::source() {
+    if(!_source.id()) _source = Source{};
+    return _source;
+}
+
+template<UnsignedInt dimensions> bool Playable<dimensions>::hasVoices() const {
+    return playables() && playables()->voiceCount();
+}
+
+template<UnsignedInt dimensions> Playable<dimensions>& Playable<dimensions>::setBuffer(Buffer* const buffer) {
+    _buffer = buffer;
+    /* Buffers without any data have zero frequency */
+    const Int frequency = buffer ? buffer->frequency() : 0;
+    _duration = frequency ? Float(buffer->sampleCount())/Float(frequency) : 0.0f;
+
+    if(hasVoices()) stop();
+    else source().setBuffer(buffer);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Playable<dimensions>& Playable<dimensions>::setLooping(const bool looping) {
+    _looping = looping;
+
+    if(_voiceGroup) _voiceGroup->_voices[_voice].source.setLooping(looping);
+    else if(!hasVoices()) source().setLooping(looping);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Playable<dimensions>& Playable<dimensions>::setPriority(const Float priority) {
+    _priority = priority;
+    return *this;
+}
+
+template<UnsignedInt dimensions> Playable<dimensions>& Playable<dimensions>::play() {
+    if(!hasVoices()) {
+        source().play();
+        return *this;
+    }
+
+    _playing = true;
+    _startTime = playables()->currentTime();
+
+    /* If there's a source assigned already, restart it, otherwise it gets
+       assigned in the next update */
+    if(_voiceGroup) _voiceGroup->_voices[_voice].source
+        .setOffsetInSeconds(0.0f)
+        .play();
+    return *this;
+}
+
+template<UnsignedInt dimensions> Playable<dimensions>& Playable<dimensions>::stop() {
+    if(!hasVoices()) {
+        source().stop();
+        return *this;
+    }
+
+    _playing = false;
+    if(_voiceGroup) _voiceGroup->releaseVoice(*this);
+    return *this;
+}
+
+template<UnsignedInt dimensions> bool Playable<dimensions>::isPlaying() const {
+    if(hasVoices()) return _playing;
+    return _source.id() && _source.state() == Source::State::Playing;
+}
+
+template<UnsignedInt dimensions> bool Playable<dimensions>::isVirtual() const {
+    return hasVoices() && _playing && !_voiceGroup;
+}
 
 template<UnsignedInt dimensions> Playable<dimensions>& Playable<dimensions>::setGain(const Float gain) {
     _gain = gain;
@@ -49,8 +124,18 @@ template<UnsignedInt dimensions> void Playable<dimensions>::clean(const MatrixTy
     if(playables())
         position = playables()->soundTransformation().transformVector(position);
 
-    _source.setPosition(position);
-    _source.setDirection(Vector3::pad(absoluteTransformationMatrix.rotation()*_direction));
+    const Vector3 direction = Vector3::pad(absoluteTransformationMatrix.rotation()*_direction);
+
+    /* With voice virtualization the source is updated only if it's assigned,
+       in PlayableGroup::updateVoices() */
+    if(hasVoices()) {
+        _position = position;
+        _soundDirection = direction;
+        _dirty = true;
+    } else {
+        source().setPosition(position);
+        source().setDirection(direction);
+    }
 
     /** @todo velocity */
 }
@@ -64,7 +149,9 @@ template<UnsignedInt dimensions> const PlayableGroup<dimensions>* Playable<dimen
 }
 
 template<UnsignedInt dimensions> void Playable<dimensions>::cleanGain() {
-    _source.setGain(playables() ? _gain*playables()->gain() : _gain);
+    const Float gain = playables() ? _gain*playables()->gain() : _gain;
+    if(_voiceGroup) _voiceGroup->_voices[_voice].source.setGain(gain);
+    else if(!hasVoices()) source().setGain(gain);
 }
 
 /* On non-MinGW Windows the instantiations are already marked with extern
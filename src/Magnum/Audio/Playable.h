@@ -70,6 +70,20 @@ you have to use other means to update them:
     @ref Playable gain and updated on every call to @ref setGain() or
     @ref PlayableGroup::setGain().
 
+@section Audio-Playable-voices Voice virtualization
+
+If the playable is in a @ref PlayableGroup with voice virtualization enabled
+using @ref PlayableGroup::setVoiceCount(), its own @ref source() isn't used.
+Instead, set the buffer with @ref setBuffer(), control the playback with
+@ref play() and @ref stop(), and the group assigns one of its pooled sources to
+it when it's among the most audible playables in the group. Otherwise the
+playable is @ref isVirtual() "virtual" --- it doesn't use any OpenAL source,
+only its playback time is tracked so it continues from the right place once it
+gets a source again. Use @ref setPriority() to make some playables more
+important than others:
+
+@snippet MagnumAudio-scenegraph.cpp Playable-voices
+
 @see @ref Playable2D, @ref Playable3D
 */
 template<UnsignedInt dimensions> class Playable: public SceneGraph::AbstractGroupedFeature<dimensions, Playable<dimensions>, Float> {
@@ -101,8 +115,15 @@ template<UnsignedInt dimensions> class Playable: public SceneGraph::AbstractGrou
 
         ~Playable();
 
-        /** @brief Source which is managed by this feature */
-        Source& source() { return _source; }
+        /**
+         * @brief Source which is managed by this feature
+         *
+         * The source is created on first use. If the playable is in a
+         * @ref PlayableGroup with voice virtualization enabled, the source
+         * isn't used for playback, see @ref Audio-Playable-voices for more
+         * information.
+         */
+        Source& source();
 
         /** @brief Gain */
         Float gain() const { return _gain; }
@@ -117,6 +138,112 @@ template<UnsignedInt dimensions> class Playable: public SceneGraph::AbstractGrou
          */
         Playable& setGain(const Float gain);
 
+        /**
+         * @brief Buffer
+         * @m_since_latest
+         *
+         * @see @ref setBuffer()
+         */
+        Buffer* buffer() const { return _buffer; }
+
+        /**
+         * @brief Set buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * The buffer is expected to be already filled with data. If the
+         * playable is in a @ref PlayableGroup with voice virtualization
+         * enabled, stops the playback. Otherwise sets the buffer to
+         * @ref source().
+         * @see @ref Source::setBuffer()
+         */
+        Playable& setBuffer(Buffer* buffer);
+
+        /**
+         * @brief Whether the playback loops
+         * @m_since_latest
+         *
+         * @see @ref setLooping()
+         */
+        bool isLooping() const { return _looping; }
+
+        /**
+         * @brief Set looping
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Default is @cpp false @ce.
+         * @see @ref Source::setLooping()
+         */
+        Playable& setLooping(bool looping);
+
+        /**
+         * @brief Priority
+         * @m_since_latest
+         *
+         * @see @ref setPriority()
+         */
+        Float priority() const { return _priority; }
+
+        /**
+         * @brief Set priority
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Multiplies the audibility used to decide which playables get a
+         * source in a @ref PlayableGroup with voice virtualization enabled,
+         * see @ref PlayableGroup::setVoiceCount() for details. Default is
+         * @cpp 1.0f @ce.
+         */
+        Playable& setPriority(Float priority);
+
+        /**
+         * @brief Play
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * If the playable is in a @ref PlayableGroup with voice virtualization
+         * enabled, (re)starts the playback from the beginning. The playable
+         * gets a source on the next @ref Listener::update() if it's audible
+         * enough. Otherwise calls @ref Source::play() on @ref source().
+         */
+        Playable& play();
+
+        /**
+         * @brief Stop
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * If the playable is in a @ref PlayableGroup with voice virtualization
+         * enabled, stops the playback and releases the source assigned to
+         * it, if any. Otherwise calls @ref Source::stop() on @ref source().
+         */
+        Playable& stop();
+
+        /**
+         * @brief Whether the playable is playing
+         * @m_since_latest
+         *
+         * If the playable is in a @ref PlayableGroup with voice virtualization
+         * enabled, returns @cpp true @ce after @ref play() until
+         * @ref stop() is called or until a non-looping playback reaches the
+         * end, regardless of whether the playable has a source assigned or
+         * is virtual. Otherwise returns whether @ref Source::state() of
+         * @ref source() is @ref Source::State::Playing.
+         */
+        bool isPlaying() const;
+
+        /**
+         * @brief Whether the playable is virtual
+         * @m_since_latest
+         *
+         * Returns @cpp true @ce if the playable is playing in a
+         * @ref PlayableGroup with voice virtualization enabled but has no
+         * source assigned, @cpp false @ce otherwise. The assignment is
+         * updated in @ref Listener::update().
+         */
+        bool isVirtual() const;
+
         /**
          * @brief Group containing this playable
          *
@@ -136,9 +263,28 @@ template<UnsignedInt dimensions> class Playable: public SceneGraph::AbstractGrou
            PlayableGroup::setGain() */
         MAGNUM_AUDIO_LOCAL void cleanGain();
 
+        /* Whether the group has voice virtualization enabled */
+        MAGNUM_AUDIO_LOCAL bool hasVoices() const;
+
         VectorTypeFor<dimensions, Float> _direction;
         Float _gain;
-        Source _source;
+        /* Created on first use, not needed with voice virtualization */
+        Source _source{NoCreate};
+
+        /* Used with voice virtualization. The position and direction are in
+           the sound space, updated in clean() and applied to the assigned
+           source in PlayableGroup::updateVoices(). */
+        Buffer* _buffer{};
+        Float _duration{};
+        Float _priority{1.0f};
+        Double _startTime{};
+        Vector3 _position;
+        Vector3 _soundDirection;
+        PlayableGroup<dimensions>* _voiceGroup{};
+        UnsignedInt _voice{};
+        bool _looping{};
+        bool _playing{};
+        bool _dirty{};
 };
 
 /**
@@ -26,8 +26,13 @@
 
 #include "PlayableGroup.h"
 
+#include <algorithm>
+#include <cmath>
+
+#include "Magnum/Audio/Buffer.h"
 #include "Magnum/Audio/Playable.h"
 #include "Magnum/Audio/Source.h"
+#include "Magnum/Math/Functions.h"
 #include "Magnum/SceneGraph/AbstractObject.h"
 
 namespace Magnum { namespace Audio {
@@ -44,22 +49,58 @@ template<UnsignedInt dimensions> std::vector<std::reference_wrapper<Source>> sou
 
 }
 
-template<UnsignedInt dimensions> PlayableGroup<dimensions>::PlayableGroup(): SceneGraph::FeatureGroup<dimensions, Playable<dimensions>, Float>(), _gain{1.0f} {}
+template<UnsignedInt dimensions> PlayableGroup<dimensions>::PlayableGroup(): SceneGraph::FeatureGroup<dimensions, Playable<dimensions>, Float>(), _gain{1.0f}, _lastUpdate{std::chrono::steady_clock::now()} {}
 
-template<UnsignedInt dimensions> PlayableGroup<dimensions>::~PlayableGroup() = default;
+template<UnsignedInt dimensions> PlayableGroup<dimensions>::~PlayableGroup() {
+    /* Playables that have a voice assigned would otherwise try to release it
+       on destruction */
+    for(Voice& voice: _voices)
+        if(voice.playable) voice.playable->_voiceGroup = nullptr;
+}
 
 template<UnsignedInt dimensions> PlayableGroup<dimensions>& PlayableGroup<dimensions>::play() {
-    Source::play(sources(*this));
+    if(_voices.isEmpty()) {
+        Source::play(sources(*this));
+        return *this;
+    }
+
+    if(_paused) {
+        _lastUpdate = std::chrono::steady_clock::now();
+        _paused = false;
+        for(Voice& voice: _voices)
+            if(voice.playable) voice.source.play();
+    } else for(std::size_t i = 0; i != this->size(); ++i)
+        (*this)[i].play();
+
     return *this;
 }
 
 template<UnsignedInt dimensions> PlayableGroup<dimensions>& PlayableGroup<dimensions>::pause() {
-    Source::pause(sources(*this));
+    if(_voices.isEmpty()) {
+        Source::pause(sources(*this));
+        return *this;
+    }
+
+    if(_paused) return *this;
+
+    _time = currentTime();
+    _paused = true;
+    for(Voice& voice: _voices)
+        if(voice.playable) voice.source.pause();
+
     return *this;
 }
 
 template<UnsignedInt dimensions> PlayableGroup<dimensions>& PlayableGroup<dimensions>::stop() {
-    Source::stop(sources(*this));
+    if(_voices.isEmpty()) {
+        Source::stop(sources(*this));
+        return *this;
+    }
+
+    for(std::size_t i = 0; i != this->size(); ++i)
+        (*this)[i].stop();
+    _paused = false;
+
     return *this;
 }
 
@@ -83,6 +124,117 @@ template<UnsignedInt dimensions> PlayableGroup<dimensions>& PlayableGroup<dimens
     return *this;
 }
 
+template<UnsignedInt dimensions> PlayableGroup<dimensions>& PlayableGroup<dimensions>::setVoiceCount(const UnsignedInt count) {
+    for(Voice& voice: _voices)
+        if(voice.playable) releaseVoice(*voice.playable);
+
+    _voices = Containers::Array<Voice>{ValueInit, count};
+
+    return *this;
+}
+
+template<UnsignedInt dimensions> UnsignedInt PlayableGroup<dimensions>::usedVoiceCount() const {
+    UnsignedInt count = 0;
+    for(const Voice& voice: _voices)
+        if(voice.playable) ++count;
+    return count;
+}
+
+template<UnsignedInt dimensions> Double PlayableGroup<dimensions>::currentTime() const {
+    if(_paused) return _time;
+    return _time + std::chrono::duration<Double>{std::chrono::steady_clock::now() - _lastUpdate}.count();
+}
+
+template<UnsignedInt dimensions> void PlayableGroup<dimensions>::releaseVoice(Playable<dimensions>& playable) {
+    Voice& voice = _voices[playable._voice];
+    voice.source.stop();
+    voice.source.setBuffer(nullptr);
+    voice.playable = nullptr;
+    playable._voiceGroup = nullptr;
+}
+
+template<UnsignedInt dimensions> void PlayableGroup<dimensions>::updateVoices(const Vector3& listenerPosition) {
+    if(_voices.isEmpty()) return;
+
+    /* Advance the playback time */
+    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if(!_paused) _time += std::chrono::duration<Double>{now - _lastUpdate}.count();
+    _lastUpdate = now;
+
+    /* Release voices of playables that were removed from this group */
+    for(Voice& voice: _voices)
+        if(voice.playable && voice.playable->playables() != this)
+            releaseVoice(*voice.playable);
+
+    /* Calculate audibility of all playing playables, stop the ones that
+       reached the end */
+    _candidates.clear();
+    for(std::size_t i = 0; i != this->size(); ++i) {
+        Playable<dimensions>& playable = (*this)[i];
+        if(!playable._playing || !playable._buffer) continue;
+
+        if(!playable._looping && _time - playable._startTime >= playable._duration) {
+            playable._playing = false;
+            if(playable._voiceGroup) releaseVoice(playable);
+            continue;
+        }
+
+        Float audibility = playable._priority*playable._gain/Math::max((playable._position - listenerPosition).length(), 1.0f);
+        /* Bias for playables that already have a voice to avoid switching
+           back and forth between two similarly audible ones */
+        if(playable._voiceGroup) audibility *= 1.25f;
+        _candidates.emplace_back(audibility, i);
+    }
+
+    /* Move the most audible ones to the front, their order doesn't matter */
+    const std::size_t audibleCount = Math::min(_candidates.size(), _voices.size());
+    if(audibleCount < _candidates.size())
+        std::nth_element(_candidates.begin(), _candidates.begin() + audibleCount, _candidates.end(), [](const std::pair<Float, UnsignedInt>& a, const std::pair<Float, UnsignedInt>& b) {
+            return a.first > b.first;
+        });
+
+    /* Release voices of the ones that are not audible enough, first so the
+       voices can be reused */
+    for(std::size_t i = audibleCount; i != _candidates.size(); ++i) {
+        Playable<dimensions>& playable = (*this)[_candidates[i].second];
+        if(playable._voiceGroup) releaseVoice(playable);
+    }
+
+    /* Assign voices to the audible ones that don't have them yet, update
+       sources of the others only if they changed */
+    std::size_t freeVoice = 0;
+    for(std::size_t i = 0; i != audibleCount; ++i) {
+        Playable<dimensions>& playable = (*this)[_candidates[i].second];
+        if(playable._voiceGroup) {
+            if(playable._dirty) _voices[playable._voice].source
+                .setPosition(playable._position)
+                .setDirection(playable._soundDirection);
+            playable._dirty = false;
+            continue;
+        }
+
+        while(_voices[freeVoice].playable) ++freeVoice;
+        Voice& voice = _voices[freeVoice];
+        voice.playable = &playable;
+        playable._voiceGroup = this;
+        playable._voice = freeVoice;
+        playable._dirty = false;
+
+        /* Continue from where the virtual playback is */
+        Float offset = Float(_time - playable._startTime);
+        if(playable._looping && playable._duration > 0.0f)
+            offset = std::fmod(offset, playable._duration);
+        voice.source
+            .setBuffer(playable._buffer)
+            .setLooping(playable._looping)
+            .setPosition(playable._position)
+            .setDirection(playable._soundDirection)
+            .setGain(playable._gain*_gain)
+            .setOffsetInSeconds(offset);
+        if(!_paused) voice.source.play();
+    }
+}
+
 /* On non-MinGW Windows the instantiations are already marked with extern
    template. However Clang-CL doesn't propagate the export from the extern
    template, it seems. */
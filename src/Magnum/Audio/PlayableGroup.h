@@ -30,8 +30,14 @@
  * @brief Class @ref Magnum::Audio::PlayableGroup, typedef @ref Magnum::Audio::PlayableGroup2D, @ref Magnum::Audio::PlayableGroup3D
  */
 
+#include <chrono>
+#include <utility>
+#include <vector>
+#include <Corrade/Containers/Array.h>
+
 #include "Magnum/Magnum.h"
 #include "Magnum/Audio/Audio.h"
+#include "Magnum/Audio/Source.h"
 #include "Magnum/Audio/visibility.h"
 #include "Magnum/Math/Matrix4.h"
 #include "Magnum/SceneGraph/FeatureGroup.h"
@@ -44,6 +50,19 @@ namespace Magnum { namespace Audio {
 Manages a group of @ref Playable instances with an ability to control gain,
 transformation or state for all of them at once. See @ref Playable and
 @ref Listener documentation for more information.
+
+@section Audio-PlayableGroup-voices Voice virtualization
+
+By default each @ref Playable has its own @ref Source, which doesn't scale to
+thousands of sound emitters --- the OpenAL implementation has a limited count
+of sources it can mix and updating all of them every frame has a significant
+cost. With @ref setVoiceCount() the group instead creates a fixed pool of
+sources and in each @ref Listener::update() assigns them to the most audible
+playing playables. The remaining playables are virtual, only their playback
+time is tracked. Sources of playables that keep their assignment are updated
+only if the playable transformation changed. See
+@ref Audio-Playable-voices for details on how to use the playables in that
+case.
 @see @ref PlayableGroup2D, @ref PlayableGroup3D
 */
 template<UnsignedInt dimensions> class PlayableGroup: public SceneGraph::FeatureGroup<dimensions, Playable<dimensions>, Float> {
@@ -56,6 +75,9 @@ template<UnsignedInt dimensions> class PlayableGroup: public SceneGraph::Feature
          * @brief Play all sound sources in this group
          * @return Reference to self (for method chaining)
          *
+         * With voice virtualization enabled, resumes the playback if the
+         * group was paused and calls @ref Playable::play() on all playables
+         * otherwise.
          * @see @ref Source::play()
          */
         PlayableGroup<dimensions>& play();
@@ -64,6 +86,8 @@ template<UnsignedInt dimensions> class PlayableGroup: public SceneGraph::Feature
          * @brief Pause all sound sources in this group
          * @return Reference to self (for method chaining)
          *
+         * With voice virtualization enabled, pauses all pooled sources and
+         * stops the playback time of virtual playables.
          * @see @ref Source::pause()
          */
         PlayableGroup<dimensions>& pause();
@@ -72,6 +96,8 @@ template<UnsignedInt dimensions> class PlayableGroup: public SceneGraph::Feature
          * @brief Stop all sound sources in this group
          * @return Reference to self (for method chaining)
          *
+         * With voice virtualization enabled, calls @ref Playable::stop() on
+         * all playables.
          * @see @ref Source::stop()
          */
         PlayableGroup<dimensions>& stop();
@@ -90,6 +116,45 @@ template<UnsignedInt dimensions> class PlayableGroup: public SceneGraph::Feature
          */
         PlayableGroup<dimensions>& setGain(const Float gain);
 
+        /**
+         * @brief Count of pooled sources
+         * @m_since_latest
+         *
+         * If @cpp 0 @ce, voice virtualization is disabled.
+         * @see @ref setVoiceCount()
+         */
+        UnsignedInt voiceCount() const { return _voices.size(); }
+
+        /**
+         * @brief Enable voice virtualization
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Creates a pool of @p count sources which are assigned to at most
+         * @p count playing playables in @ref Listener::update(). The
+         * playables are picked by their audibility, which is calculated as
+         * @ref Playable::priority() times @ref Playable::gain() divided by
+         * distance to the listener, with distances below @cpp 1.0f @ce
+         * clamped. Playables that already have a source get a small bias to
+         * avoid switching between two similarly audible playables every
+         * frame. Setting @p count to @cpp 0 @ce disables voice virtualization.
+         * Default is @cpp 0 @ce. See @ref Audio-PlayableGroup-voices for
+         * more information.
+         *
+         * Any sources assigned previously are stopped, the playback state of
+         * the playables is kept and the sources get reassigned on the next
+         * @ref Listener::update().
+         */
+        PlayableGroup<dimensions>& setVoiceCount(UnsignedInt count);
+
+        /**
+         * @brief Count of pooled sources currently assigned to a playable
+         * @m_since_latest
+         *
+         * @see @ref voiceCount(), @ref Playable::isVirtual()
+         */
+        UnsignedInt usedVoiceCount() const;
+
         /** @brief Sound transformation */
         const Matrix4& soundTransformation() const { return _soundTransform; }
 
@@ -101,9 +166,30 @@ template<UnsignedInt dimensions> class PlayableGroup: public SceneGraph::Feature
 
     private:
         friend Playable<dimensions>;
+        friend Listener<dimensions>;
+
+        struct Voice {
+            Source source;
+            Playable<dimensions>* playable{};
+        };
+
+        /* Playback time with voice virtualization, doesn't advance when the
+           group is paused */
+        MAGNUM_AUDIO_LOCAL Double currentTime() const;
+        /* Called from Listener::update() after the playables are cleaned */
+        MAGNUM_AUDIO_LOCAL void updateVoices(const Vector3& listenerPosition);
+        MAGNUM_AUDIO_LOCAL void releaseVoice(Playable<dimensions>& playable);
 
         Matrix4 _soundTransform;
         Float _gain;
+
+        Containers::Array<Voice> _voices;
+        /* Audibility and playable index, kept to avoid reallocating on every
+           update */
+        std::vector<std::pair<Float, UnsignedInt>> _candidates;
+        std::chrono::steady_clock::time_point _lastUpdate;
+        Double _time{};
+        bool _paused{};
 };
 
 /**
@@ -37,6 +37,7 @@
 #include <Corrade/Containers/Containers.h>
 
 #include "Magnum/Magnum.h"
+#include "Magnum/Tags.h"
 #include "Magnum/Audio/Audio.h"
 #include "Magnum/Audio/visibility.h"
 #include "Magnum/Math/Vector3.h"
@@ -64,6 +65,15 @@ class MAGNUM_AUDIO_EXPORT Source {
          */
         explicit Source() { alGenSources(1, &_id); }
 
+        /**
+         * @brief Construct without creating the underlying OpenAL object
+         * @m_since_latest
+         *
+         * The constructed instance is equivalent to moved-from state. Move
+         * another object over it to make it useful.
+         */
+        explicit Source(NoCreateT) noexcept: _id{0} {}
+
         /**
          * @brief Destructor
          *
@@ -0,0 +1,292 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "StreamingSource.h"
+
+#include <utility>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Reference.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Audio/AbstractImporter.h"
+#include "Magnum/Audio/Buffer.h"
+#include "Magnum/Audio/BufferFormat.h"
+#include "Magnum/Audio/Source.h"
+
+#if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+namespace Magnum { namespace Audio {
+
+namespace Implementation {
+
+struct StreamingSourceState {
+    explicit StreamingSourceState(AbstractImporter& importer, std::size_t bufferSize, UnsignedInt bufferCount): importer(importer), format{importer.format()}, frequency{importer.frequency()}, data{NoInit, bufferSize}, buffers{ValueInit, bufferCount} {
+        for(Buffer& buffer: buffers)
+            arrayAppend(bufferReferences, buffer);
+    }
+
+    AbstractImporter& importer;
+    BufferFormat format;
+    UnsignedInt frequency;
+    Containers::Array<char> data;
+
+    /* The source has to be destroyed before the buffers queued on it, so it's
+       listed after them */
+    Containers::Array<Buffer> buffers;
+    /* Passed to Source::unqueueBuffers(), which reorders them, so they have
+       to be reset before each call */
+    Containers::Array<Containers::Reference<Buffer>> bufferReferences;
+    Source source;
+    std::size_t queuedCount = 0;
+
+    bool looping = false;
+    bool playing = false;
+    bool paused = false;
+
+    #if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+    /* Mutable so the const getters can lock it as well */
+    mutable std::mutex mutex;
+    std::condition_variable condition;
+    std::thread thread;
+    bool stopThread = false;
+    #endif
+};
+
+}
+
+/* Guards the state against concurrent access from the update thread */
+#if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+#define LOCK_STATE() std::lock_guard<std::mutex> lock{_state->mutex}
+#else
+#define LOCK_STATE() do {} while(false)
+#endif
+
+namespace {
+
+void resetBufferReferences(Implementation::StreamingSourceState& state) {
+    for(std::size_t i = 0; i != state.buffers.size(); ++i)
+        state.bufferReferences[i] = state.buffers[i];
+}
+
+/* Returns the count of bytes put into the buffer, 0 at the end of data */
+std::size_t fillBuffer(Implementation::StreamingSourceState& state, Buffer& buffer) {
+    std::size_t size = state.importer.dataChunk(state.data);
+    if(!size && state.looping) {
+        state.importer.seekData(0);
+        size = state.importer.dataChunk(state.data);
+    }
+
+    if(size) buffer.setData(state.format, state.data.prefix(size), state.frequency);
+    return size;
+}
+
+bool updateStream(Implementation::StreamingSourceState& state) {
+    if(!state.playing) return false;
+    if(state.paused) return true;
+
+    /* Unqueue processed buffers, they get moved to the front of the list */
+    resetBufferReferences(state);
+    const std::size_t processed = state.source.unqueueBuffers(state.bufferReferences);
+    state.queuedCount -= processed;
+
+    /* Refill them and queue them again */
+    std::size_t count = 0;
+    while(count != processed && fillBuffer(state, state.bufferReferences[count]))
+        ++count;
+    if(count) {
+        state.source.queueBuffers(state.bufferReferences.prefix(count));
+        state.queuedCount += count;
+
+        /* If the source ran out of queued buffers before, restart it */
+        if(state.source.state() != Source::State::Playing)
+            state.source.play();
+    }
+
+    /* Nothing queued anymore, everything was played */
+    if(!state.queuedCount) {
+        state.source.stop();
+        state.playing = false;
+    }
+
+    return state.playing;
+}
+
+}
+
+StreamingSource::StreamingSource(AbstractImporter& importer, const std::size_t bufferSize, const UnsignedInt bufferCount) {
+    CORRADE_ASSERT(importer.isOpened(),
+        "Audio::StreamingSource: no file opened", );
+    CORRADE_ASSERT(bufferSize >= bufferFormatSize(importer.format()),
+        "Audio::StreamingSource: expected buffer size to be at least" << bufferFormatSize(importer.format()) << "bytes but got" << bufferSize, );
+    CORRADE_ASSERT(bufferCount,
+        "Audio::StreamingSource: expected a non-zero buffer count", );
+
+    _state.emplace(importer, bufferSize, bufferCount);
+}
+
+StreamingSource::StreamingSource(StreamingSource&&) noexcept = default;
+
+StreamingSource::~StreamingSource() {
+    #if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+    /* Moved-out instances have no state */
+    if(_state) stopUpdateThread();
+    #endif
+}
+
+StreamingSource& StreamingSource::operator=(StreamingSource&& other) noexcept {
+    /* Swapping so the update thread of the original instance, if any, gets
+       stopped by the destructor of the other */
+    using std::swap;
+    swap(_state, other._state);
+    return *this;
+}
+
+Source& StreamingSource::source() { return _state->source; }
+
+AbstractImporter& StreamingSource::importer() { return _state->importer; }
+
+std::size_t StreamingSource::bufferSize() const { return _state->data.size(); }
+
+UnsignedInt StreamingSource::bufferCount() const { return _state->buffers.size(); }
+
+bool StreamingSource::isLooping() const {
+    LOCK_STATE();
+    return _state->looping;
+}
+
+StreamingSource& StreamingSource::setLooping(const bool looping) {
+    LOCK_STATE();
+    _state->looping = looping;
+    return *this;
+}
+
+bool StreamingSource::isPlaying() const {
+    LOCK_STATE();
+    return _state->playing;
+}
+
+StreamingSource& StreamingSource::play() {
+    LOCK_STATE();
+    Implementation::StreamingSourceState& state = *_state;
+
+    if(state.paused) {
+        state.source.play();
+        state.paused = false;
+        return *this;
+    }
+
+    if(state.playing) return *this;
+
+    /* Fill as many buffers as there's data for and queue them */
+    std::size_t count = 0;
+    while(count != state.buffers.size() && fillBuffer(state, state.buffers[count]))
+        ++count;
+    if(!count) return *this;
+
+    resetBufferReferences(state);
+    state.source.queueBuffers(state.bufferReferences.prefix(count));
+    state.queuedCount = count;
+    state.source.play();
+    state.playing = true;
+    return *this;
+}
+
+StreamingSource& StreamingSource::pause() {
+    LOCK_STATE();
+    Implementation::StreamingSourceState& state = *_state;
+
+    if(!state.playing || state.paused) return *this;
+
+    state.source.pause();
+    state.paused = true;
+    return *this;
+}
+
+StreamingSource& StreamingSource::stop() {
+    LOCK_STATE();
+    Implementation::StreamingSourceState& state = *_state;
+
+    /* After stopping, all queued buffers are marked as processed, so all of
+       them get unqueued */
+    state.source.stop();
+    resetBufferReferences(state);
+    state.source.unqueueBuffers(state.bufferReferences);
+    state.queuedCount = 0;
+
+    state.importer.seekData(0);
+    state.playing = false;
+    state.paused = false;
+    return *this;
+}
+
+bool StreamingSource::update() {
+    LOCK_STATE();
+    return updateStream(*_state);
+}
+
+#if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+StreamingSource& StreamingSource::startUpdateThread(const std::chrono::milliseconds interval) {
+    CORRADE_ASSERT(!_state->thread.joinable(),
+        "Audio::StreamingSource::startUpdateThread(): the thread is already running", *this);
+
+    _state->stopThread = false;
+    /* Capturing the state and not this so the instance can be moved while
+       the thread is running */
+    Implementation::StreamingSourceState* const state = _state.get();
+    _state->thread = std::thread{[state, interval] {
+        std::unique_lock<std::mutex> lock{state->mutex};
+        while(!state->stopThread) {
+            updateStream(*state);
+            state->condition.wait_for(lock, interval, [state] {
+                return state->stopThread;
+            });
+        }
+    }};
+    return *this;
+}
+
+StreamingSource& StreamingSource::stopUpdateThread() {
+    if(!_state->thread.joinable()) return *this;
+
+    {
+        std::lock_guard<std::mutex> lock{_state->mutex};
+        _state->stopThread = true;
+    }
+    _state->condition.notify_one();
+    _state->thread.join();
+    return *this;
+}
+
+bool StreamingSource::isUpdateThreadRunning() const {
+    return _state->thread.joinable();
+}
+#endif
+
+}}
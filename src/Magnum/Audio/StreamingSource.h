@@ -0,0 +1,254 @@
+#ifndef Magnum_Audio_StreamingSource_h
+#define Magnum_Audio_StreamingSource_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Audio::StreamingSource
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Audio/Audio.h"
+#include "Magnum/Audio/visibility.h"
+
+#if (defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)) || defined(DOXYGEN_GENERATING_OUTPUT)
+#include <chrono>
+#endif
+
+namespace Magnum { namespace Audio {
+
+namespace Implementation { struct StreamingSourceState; }
+
+/**
+@brief Streaming source
+@m_since_latest
+
+Plays data from an @ref AbstractImporter without uploading all of it to
+OpenAL at once. The data are decoded using @ref AbstractImporter::dataChunk()
+into a fixed ring of @ref Buffer instances that are queued on a @ref Source.
+Calling @ref update() periodically refills buffers that finished playing and
+queues them again, so the memory used is bounded by the buffer size times the
+buffer count regardless of the track length:
+
+@snippet MagnumAudio.cpp StreamingSource
+
+@section Audio-StreamingSource-buffers Buffer size and count
+
+Each buffer should be large enough to cover the time between two
+@ref update() calls, the default of four buffers with 16 kB each is around
+half a second of 16-bit stereo audio at 44.1 kHz. If @ref update() isn't
+called often enough, all queued buffers get played before new ones are
+queued, in which case the playback is resumed on the next @ref update().
+
+@section Audio-StreamingSource-thread Update thread
+
+Instead of calling @ref update() from the main loop, which may stall on frame
+hitches, the updates can be done on a dedicated thread started with
+@ref startUpdateThread(). The @ref play(), @ref pause(), @ref stop(),
+@ref update() and @ref setLooping() functions are synchronized with the
+thread, however the importer and the @ref source() are accessed from it
+without any locking, so the importer shouldn't be used by anything else while
+the thread is running and the source properties should only be changed from a
+single thread. The thread relies on the OpenAL context being current for the
+whole process, which is the default unless the @m_class{m-doc-external}
+[ALC_EXT_thread_local_context](https://openal-soft.org/openal-extensions/EXT_thread_local_context.txt)
+extension is used. The update thread is available only if Corrade is built
+with @ref CORRADE_BUILD_MULTITHREADED and not when targeting
+@ref CORRADE_TARGET_EMSCRIPTEN "Emscripten".
+*/
+class MAGNUM_AUDIO_EXPORT StreamingSource {
+    public:
+        /**
+         * @brief Constructor
+         * @param importer      Importer with an opened file
+         * @param bufferSize    Size of a single buffer in bytes
+         * @param bufferCount   Count of buffers to queue
+         *
+         * Expects that @p importer has a file opened, that @p bufferSize is
+         * large enough for at least one sample frame, size of which is
+         * @ref bufferFormatSize() of @ref AbstractImporter::format(), and
+         * that @p bufferCount is not zero. The importer is expected to stay
+         * in scope for the whole lifetime of the instance.
+         */
+        explicit StreamingSource(AbstractImporter& importer, std::size_t bufferSize = 16384, UnsignedInt bufferCount = 4);
+
+        /** @brief Copying is not allowed */
+        StreamingSource(const StreamingSource&) = delete;
+
+        /** @brief Move constructor */
+        StreamingSource(StreamingSource&&) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Stops the update thread if it's running and deletes the source and
+         * all buffers.
+         */
+        ~StreamingSource();
+
+        /** @brief Copying is not allowed */
+        StreamingSource& operator=(const StreamingSource&) = delete;
+
+        /** @brief Move assignment */
+        StreamingSource& operator=(StreamingSource&&) noexcept;
+
+        /**
+         * @brief Source
+         *
+         * Use to set up position, gain and other properties. Don't queue or
+         * unqueue any buffers or change the playback state on it directly,
+         * use @ref play(), @ref pause() and @ref stop() instead.
+         */
+        Source& source();
+
+        /** @brief Importer */
+        AbstractImporter& importer();
+
+        /** @brief Buffer size in bytes */
+        std::size_t bufferSize() const;
+
+        /** @brief Buffer count */
+        UnsignedInt bufferCount() const;
+
+        /**
+         * @brief Whether the playback loops
+         *
+         * @see @ref setLooping()
+         */
+        bool isLooping() const;
+
+        /**
+         * @brief Set looping
+         * @return Reference to self (for method chaining)
+         *
+         * If enabled, @ref update() seeks to the beginning of the data once
+         * the importer reaches the end, continuing seamlessly. Default is
+         * @cpp false @ce. Unlike @ref Source::setLooping(), which would loop
+         * just the queued buffers, this loops the whole stream.
+         */
+        StreamingSource& setLooping(bool looping);
+
+        /**
+         * @brief Whether the stream is playing
+         *
+         * Returns @cpp true @ce after @ref play() until all data were played
+         * or @ref stop() is called, including the time when the playback is
+         * paused.
+         */
+        bool isPlaying() const;
+
+        /**
+         * @brief Play
+         * @return Reference to self (for method chaining)
+         *
+         * If the playback is paused, resumes it. Otherwise, if not already
+         * playing, fills all buffers with data from the current importer
+         * position, queues them and starts the playback. If there's no data
+         * left, does nothing.
+         */
+        StreamingSource& play();
+
+        /**
+         * @brief Pause
+         * @return Reference to self (for method chaining)
+         *
+         * Use @ref play() to resume the playback.
+         */
+        StreamingSource& pause();
+
+        /**
+         * @brief Stop
+         * @return Reference to self (for method chaining)
+         *
+         * Stops the playback, unqueues all buffers and seeks the importer to
+         * the beginning of the data, so the next @ref play() starts from the
+         * beginning again.
+         */
+        StreamingSource& stop();
+
+        /**
+         * @brief Update the stream
+         * @return Whether the stream is still playing
+         *
+         * Unqueues buffers that finished playing, fills them with new data
+         * and queues them again. If the source ran out of queued buffers
+         * before, restarts the playback. Returns @cpp false @ce once all data
+         * were played, or if the stream isn't playing, equivalently to
+         * @ref isPlaying(). Should be called periodically, see
+         * @ref Audio-StreamingSource-buffers for details. Doesn't need to be
+         * called if the update thread is running.
+         */
+        bool update();
+
+        #if (defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)) || defined(DOXYGEN_GENERATING_OUTPUT)
+        /**
+         * @brief Start the update thread
+         * @param interval      Interval between @ref update() calls
+         * @return Reference to self (for method chaining)
+         *
+         * Calls @ref update() on a dedicated thread every @p interval until
+         * @ref stopUpdateThread() is called or the instance is destroyed.
+         * Expects that the thread isn't already running. See
+         * @ref Audio-StreamingSource-thread for more information.
+         *
+         * @partialsupport Available only if Corrade is built with
+         *      @ref CORRADE_BUILD_MULTITHREADED and not on
+         *      @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten".
+         */
+        StreamingSource& startUpdateThread(std::chrono::milliseconds interval = std::chrono::milliseconds{10});
+
+        /**
+         * @brief Stop the update thread
+         * @return Reference to self (for method chaining)
+         *
+         * Waits until the thread finishes. If the thread isn't running, does
+         * nothing.
+         *
+         * @partialsupport Available only if Corrade is built with
+         *      @ref CORRADE_BUILD_MULTITHREADED and not on
+         *      @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten".
+         */
+        StreamingSource& stopUpdateThread();
+
+        /**
+         * @brief Whether the update thread is running
+         *
+         * @partialsupport Available only if Corrade is built with
+         *      @ref CORRADE_BUILD_MULTITHREADED and not on
+         *      @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten".
+         */
+        bool isUpdateThreadRunning() const;
+        #endif
+
+    private:
+        Containers::Pointer<Implementation::StreamingSourceState> _state;
+};
+
+}}
+
+#endif
@@ -25,6 +25,7 @@
 
 #include <sstream>
 #include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/String.h>
 #include <Corrade/Containers/StringStl.h> /** @todo remove once AbstractImporter is <string>-free */
 #include <Corrade/TestSuite/Tester.h>
@@ -53,6 +54,10 @@ struct AbstractImporterTest: TestSuite::Tester {
     void openDataNotSupported();
     void openDataNotImplemented();
 
+    void openMemory();
+    void openMemoryAsData();
+    void openMemoryNotSupported();
+
     /* file callbacks not supported -- those will be once this gets merged with
        Trade::AbstractImporter */
 
@@ -66,6 +71,19 @@ struct AbstractImporterTest: TestSuite::Tester {
     void dataNoFile();
     void dataCustomDeleter();
 
+    void dataView();
+    void dataViewNotImplemented();
+    void dataViewNoFile();
+
+    void dataChunk();
+    void dataChunkSeek();
+    void dataChunkReopen();
+    void dataChunkImplementation();
+    void dataChunkNoFile();
+    void dataChunkDestinationTooSmall();
+    void dataChunkImplementationInvalidSize();
+    void seekDataNoFile();
+
     void debugFeature();
     void debugFeatures();
 };
@@ -81,6 +99,10 @@ AbstractImporterTest::AbstractImporterTest() {
               &AbstractImporterTest::openDataNotSupported,
               &AbstractImporterTest::openDataNotImplemented,
 
+              &AbstractImporterTest::openMemory,
+              &AbstractImporterTest::openMemoryAsData,
+              &AbstractImporterTest::openMemoryNotSupported,
+
               &AbstractImporterTest::format,
               &AbstractImporterTest::formatNoFile,
 
@@ -91,6 +113,19 @@ AbstractImporterTest::AbstractImporterTest() {
               &AbstractImporterTest::dataNoFile,
               &AbstractImporterTest::dataCustomDeleter,
 
+              &AbstractImporterTest::dataView,
+              &AbstractImporterTest::dataViewNotImplemented,
+              &AbstractImporterTest::dataViewNoFile,
+
+              &AbstractImporterTest::dataChunk,
+              &AbstractImporterTest::dataChunkSeek,
+              &AbstractImporterTest::dataChunkReopen,
+              &AbstractImporterTest::dataChunkImplementation,
+              &AbstractImporterTest::dataChunkNoFile,
+              &AbstractImporterTest::dataChunkDestinationTooSmall,
+              &AbstractImporterTest::dataChunkImplementationInvalidSize,
+              &AbstractImporterTest::seekDataNoFile,
+
               &AbstractImporterTest::debugFeature,
               &AbstractImporterTest::debugFeatures});
 }
@@ -253,6 +288,77 @@ void AbstractImporterTest::openDataNotImplemented() {
     CORRADE_COMPARE(out.str(), "Audio::AbstractImporter::openData(): feature advertised but not implemented\n");
 }
 
+void AbstractImporterTest::openMemory() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::OpenData; }
+        bool doIsOpened() const override { return _opened; }
+        void doClose() override { _opened = false; }
+
+        /* doOpenData() isn't implemented, so if the default doOpenMemory()
+           would get called, it'd assert */
+        void doOpenMemory(Containers::ArrayView<const char> memory) override {
+            _memory = memory;
+            _opened = true;
+        }
+
+        BufferFormat doFormat() const override { return {}; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+
+        bool _opened = false;
+        Containers::ArrayView<const char> _memory;
+    } importer;
+
+    const char a5 = '\xa5';
+    CORRADE_VERIFY(importer.openMemory({&a5, 1}));
+    CORRADE_VERIFY(importer.isOpened());
+    CORRADE_COMPARE(importer._memory.data(), &a5);
+    CORRADE_COMPARE(importer._memory.size(), 1);
+}
+
+void AbstractImporterTest::openMemoryAsData() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::OpenData; }
+        bool doIsOpened() const override { return _opened; }
+        void doClose() override { _opened = false; }
+
+        void doOpenData(Containers::ArrayView<const char> data) override {
+            _opened = (data.size() == 1 && data[0] == '\xa5');
+        }
+
+        BufferFormat doFormat() const override { return {}; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+
+        bool _opened = false;
+    } importer;
+
+    /* doOpenMemory() should call doOpenData() */
+    const char a5 = '\xa5';
+    CORRADE_VERIFY(importer.openMemory({&a5, 1}));
+    CORRADE_VERIFY(importer.isOpened());
+}
+
+void AbstractImporterTest::openMemoryNotSupported() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return false; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return {}; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    CORRADE_VERIFY(!importer.openMemory(nullptr));
+    CORRADE_COMPARE(out.str(), "Audio::AbstractImporter::openMemory(): feature not supported\n");
+}
+
 void AbstractImporterTest::format() {
     struct: AbstractImporter {
         ImporterFeatures doFeatures() const override { return {}; }
@@ -381,6 +487,291 @@ void AbstractImporterTest::dataCustomDeleter() {
     CORRADE_COMPARE(out.str(), "Audio::AbstractImporter::data(): implementation is not allowed to use a custom Array deleter\n");
 }
 
+void AbstractImporterTest::dataView() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return {}; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+        Containers::Optional<Containers::ArrayView<const char>> doDataView() override {
+            return Containers::arrayView(_data);
+        }
+
+        char _data[2]{'H', 'i'};
+    } importer;
+
+    Containers::Optional<Containers::ArrayView<const char>> view = importer.dataView();
+    CORRADE_VERIFY(view);
+    CORRADE_COMPARE(view->data(), importer._data);
+    CORRADE_COMPARE(view->size(), 2);
+}
+
+void AbstractImporterTest::dataViewNotImplemented() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return {}; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+    } importer;
+
+    /* Not an error, the data just can't be accessed without a copy */
+    CORRADE_VERIFY(!importer.dataView());
+}
+
+void AbstractImporterTest::dataViewNoFile() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return false; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return {}; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    importer.dataView();
+    CORRADE_COMPARE(out.str(), "Audio::AbstractImporter::dataView(): no file opened\n");
+}
+
+void AbstractImporterTest::dataChunk() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return BufferFormat::Stereo8; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override {
+            ++decodeCount;
+            /* The last byte is not a whole frame and should be ignored */
+            return Containers::Array<char>{InPlaceInit, {'H', 'e', 'l', 'l', 'o'}};
+        }
+
+        Int decodeCount = 0;
+    } importer;
+
+    /* The destination gets rounded down to whole sample frames */
+    char chunk[3]{};
+    CORRADE_COMPARE(importer.dataChunk(chunk), 2);
+    CORRADE_COMPARE_AS(Containers::arrayView(chunk).prefix(2),
+        Containers::arrayView<char>({'H', 'e'}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(importer.dataChunk(chunk), 2);
+    CORRADE_COMPARE_AS(Containers::arrayView(chunk).prefix(2),
+        Containers::arrayView<char>({'l', 'l'}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(importer.dataChunk(chunk), 0);
+    CORRADE_COMPARE(importer.dataChunk(chunk), 0);
+
+    /* The data should be decoded just once */
+    CORRADE_COMPARE(importer.decodeCount, 1);
+}
+
+void AbstractImporterTest::dataChunkSeek() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return BufferFormat::Stereo8; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override {
+            return Containers::Array<char>{InPlaceInit, {'H', 'e', 'l', 'l', 'o', '!'}};
+        }
+    } importer;
+
+    char chunk[6]{};
+    importer.seekData(2);
+    CORRADE_COMPARE(importer.dataChunk(chunk), 2);
+    CORRADE_COMPARE_AS(Containers::arrayView(chunk).prefix(2),
+        Containers::arrayView<char>({'o', '!'}),
+        TestSuite::Compare::Container);
+
+    importer.seekData(0);
+    CORRADE_COMPARE(importer.dataChunk(chunk), 6);
+    CORRADE_COMPARE_AS(Containers::arrayView(chunk),
+        Containers::arrayView<char>({'H', 'e', 'l', 'l', 'o', '!'}),
+        TestSuite::Compare::Container);
+
+    /* Seeking past the end gives nothing */
+    importer.seekData(4);
+    CORRADE_COMPARE(importer.dataChunk(chunk), 0);
+}
+
+void AbstractImporterTest::dataChunkReopen() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::OpenData; }
+        bool doIsOpened() const override { return _opened; }
+        void doClose() override { _opened = false; }
+        void doOpenData(Containers::ArrayView<const char>) override {
+            _opened = true;
+        }
+
+        BufferFormat doFormat() const override { return BufferFormat::Mono8; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override {
+            return Containers::Array<char>{InPlaceInit, {char('0' + decodeCount++)}};
+        }
+
+        bool _opened = false;
+        Int decodeCount = 0;
+    } importer;
+
+    char chunk[1];
+    CORRADE_VERIFY(importer.openData(chunk));
+    CORRADE_COMPARE(importer.dataChunk(chunk), 1);
+    CORRADE_COMPARE(chunk[0], '0');
+    CORRADE_COMPARE(importer.dataChunk(chunk), 0);
+
+    /* Opening again should discard the previously decoded data and start
+       from the beginning */
+    CORRADE_VERIFY(importer.openData(chunk));
+    CORRADE_COMPARE(importer.dataChunk(chunk), 1);
+    CORRADE_COMPARE(chunk[0], '1');
+}
+
+void AbstractImporterTest::dataChunkImplementation() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return BufferFormat::Mono16; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override {
+            ++decodeCount;
+            return nullptr;
+        }
+        std::size_t doDataChunk(Containers::ArrayView<char> destination) override {
+            destinationSize = destination.size();
+            destination[0] = char(frame);
+            destination[1] = 'x';
+            return 2;
+        }
+        void doSeekData(std::size_t frame) override {
+            this->frame = frame;
+        }
+
+        std::size_t frame = 0;
+        std::size_t destinationSize = 0;
+        Int decodeCount = 0;
+    } importer;
+
+    /* The implementation gets only whole sample frames */
+    char chunk[5]{};
+    importer.seekData(7);
+    CORRADE_COMPARE(importer.dataChunk(chunk), 2);
+    CORRADE_COMPARE(importer.destinationSize, 4);
+    CORRADE_COMPARE(importer.decodeCount, 0);
+    CORRADE_COMPARE(chunk[0], '\x07');
+    CORRADE_COMPARE(chunk[1], 'x');
+}
+
+void AbstractImporterTest::dataChunkNoFile() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return false; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return {}; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    char chunk[4];
+    importer.dataChunk(chunk);
+    CORRADE_COMPARE(out.str(), "Audio::AbstractImporter::dataChunk(): no file opened\n");
+}
+
+void AbstractImporterTest::dataChunkDestinationTooSmall() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return BufferFormat::StereoFloat; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    char chunk[7];
+    importer.dataChunk(chunk);
+    CORRADE_COMPARE(out.str(), "Audio::AbstractImporter::dataChunk(): expected at least 8 bytes for a sample frame but got 7\n");
+}
+
+void AbstractImporterTest::dataChunkImplementationInvalidSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return BufferFormat::Mono16; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+        std::size_t doDataChunk(Containers::ArrayView<char>) override {
+            return size;
+        }
+        void doSeekData(std::size_t) override {}
+
+        std::size_t size;
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    char chunk[5];
+    importer.size = 6;
+    importer.dataChunk(chunk);
+    importer.size = 3;
+    importer.dataChunk(chunk);
+    CORRADE_COMPARE(out.str(),
+        "Audio::AbstractImporter::dataChunk(): implementation returned 6 bytes for a destination of 4 bytes with 2 bytes per sample frame\n"
+        "Audio::AbstractImporter::dataChunk(): implementation returned 3 bytes for a destination of 4 bytes with 2 bytes per sample frame\n");
+}
+
+void AbstractImporterTest::seekDataNoFile() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return false; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return {}; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    importer.seekData(0);
+    CORRADE_COMPARE(out.str(), "Audio::AbstractImporter::seekData(): no file opened\n");
+}
+
 void AbstractImporterTest::debugFeature() {
     std::ostringstream out;
 
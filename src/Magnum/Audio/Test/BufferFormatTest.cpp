@@ -34,11 +34,35 @@ namespace Magnum { namespace Audio { namespace Test { namespace {
 struct BufferFormatTest: TestSuite::Tester {
     explicit BufferFormatTest();
 
+    void size();
+    void sizeInvalid();
+
     void debugFormat();
 };
 
 BufferFormatTest::BufferFormatTest() {
-    addTests({&BufferFormatTest::debugFormat});
+    addTests({&BufferFormatTest::size,
+              &BufferFormatTest::sizeInvalid,
+
+              &BufferFormatTest::debugFormat});
+}
+
+void BufferFormatTest::size() {
+    CORRADE_COMPARE(bufferFormatSize(BufferFormat::Mono8), 1);
+    CORRADE_COMPARE(bufferFormatSize(BufferFormat::StereoMuLaw), 2);
+    CORRADE_COMPARE(bufferFormatSize(BufferFormat::Stereo16), 4);
+    CORRADE_COMPARE(bufferFormatSize(BufferFormat::StereoDouble), 16);
+    CORRADE_COMPARE(bufferFormatSize(BufferFormat::Surround61Channel16), 14);
+    CORRADE_COMPARE(bufferFormatSize(BufferFormat::Surround71Channel32), 32);
+}
+
+void BufferFormatTest::sizeInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    bufferFormatSize(BufferFormat(0xdead));
+    CORRADE_COMPARE(out.str(), "Audio::bufferFormatSize(): invalid format Audio::BufferFormat(0xdead)\n");
 }
 
 void BufferFormatTest::debugFormat() {
@@ -26,7 +26,10 @@
 
 #include <Corrade/TestSuite/Tester.h>
 
+#include "Magnum/Audio/Buffer.h"
+#include "Magnum/Audio/BufferFormat.h"
 #include "Magnum/Audio/Context.h"
+#include "Magnum/Audio/Listener.h"
 #include "Magnum/Audio/Playable.h"
 #include "Magnum/Audio/PlayableGroup.h"
 #include "Magnum/SceneGraph/Scene.h"
@@ -44,7 +47,14 @@ struct PlayableALTest: TestSuite::Tester {
     void feature();
     void group();
 
+    void voices();
+    void voicesPriority();
+    void voicesStop();
+    void voicesRemove();
+    void voicesNoBuffer();
+
     Context _context;
+    Buffer _buffer;
 };
 
 PlayableALTest::PlayableALTest():
@@ -52,7 +62,17 @@ PlayableALTest::PlayableALTest():
     _context{arguments().first, arguments().second}
 {
     addTests({&PlayableALTest::feature,
-              &PlayableALTest::group});
+              &PlayableALTest::group,
+
+              &PlayableALTest::voices,
+              &PlayableALTest::voicesPriority,
+              &PlayableALTest::voicesStop,
+              &PlayableALTest::voicesRemove,
+              &PlayableALTest::voicesNoBuffer});
+
+    /* A second of silence */
+    Short data[22050]{};
+    _buffer.setData(BufferFormat::Mono16, data, 22050);
 }
 
 void PlayableALTest::feature() {
@@ -86,6 +106,170 @@ void PlayableALTest::group() {
     group.stop();
 }
 
+void PlayableALTest::voices() {
+    Scene3D scene;
+    Listener3D listener{scene};
+    PlayableGroup3D group;
+    group.setVoiceCount(2);
+    CORRADE_COMPARE(group.voiceCount(), 2);
+
+    Object3D a{&scene}, b{&scene}, c{&scene};
+    a.translate(Vector3::xAxis(1.0f));
+    b.translate(Vector3::xAxis(5.0f));
+    c.translate(Vector3::xAxis(10.0f));
+    Playable3D playableA{a, &group};
+    Playable3D playableB{b, &group};
+    Playable3D playableC{c, &group};
+    for(Playable3D* playable: {&playableA, &playableB, &playableC})
+        playable->setBuffer(&_buffer)
+            .setLooping(true)
+            .play();
+
+    /* Nothing is assigned until the update */
+    CORRADE_VERIFY(playableA.isPlaying());
+    CORRADE_VERIFY(playableA.isVirtual());
+    CORRADE_COMPARE(group.usedVoiceCount(), 0);
+
+    /* The two nearest get the sources */
+    listener.update({group});
+    CORRADE_COMPARE(group.usedVoiceCount(), 2);
+    CORRADE_VERIFY(!playableA.isVirtual());
+    CORRADE_VERIFY(!playableB.isVirtual());
+    CORRADE_VERIFY(playableC.isVirtual());
+    CORRADE_VERIFY(playableC.isPlaying());
+
+    /* Moving the farthest one closest and the closest one farthest swaps
+       them */
+    a.setTransformation(Matrix4::translation(Vector3::xAxis(20.0f)));
+    c.setTransformation(Matrix4::translation(Vector3::xAxis(0.5f)));
+    listener.update({group});
+    CORRADE_COMPARE(group.usedVoiceCount(), 2);
+    CORRADE_VERIFY(playableA.isVirtual());
+    CORRADE_VERIFY(!playableB.isVirtual());
+    CORRADE_VERIFY(!playableC.isVirtual());
+
+    /* The playables' own sources aren't used at all */
+    CORRADE_COMPARE(playableA.source().state(), Source::State::Initial);
+}
+
+void PlayableALTest::voicesPriority() {
+    Scene3D scene;
+    Listener3D listener{scene};
+    PlayableGroup3D group;
+    group.setVoiceCount(1);
+
+    Object3D a{&scene}, b{&scene};
+    a.translate(Vector3::xAxis(2.0f));
+    b.translate(Vector3::xAxis(10.0f));
+    Playable3D playableA{a, &group};
+    Playable3D playableB{b, &group};
+    playableA.setBuffer(&_buffer)
+        .setLooping(true)
+        .play();
+    playableB.setBuffer(&_buffer)
+        .setLooping(true)
+        .setPriority(100.0f)
+        .play();
+    CORRADE_COMPARE(playableB.priority(), 100.0f);
+
+    /* The far one wins because of the priority */
+    listener.update({group});
+    CORRADE_VERIFY(playableA.isVirtual());
+    CORRADE_VERIFY(!playableB.isVirtual());
+}
+
+void PlayableALTest::voicesStop() {
+    Scene3D scene;
+    Listener3D listener{scene};
+    PlayableGroup3D group;
+    group.setVoiceCount(4);
+
+    Object3D a{&scene};
+    Playable3D playableA{a, &group};
+    playableA.setBuffer(&_buffer)
+        .setLooping(true)
+        .play();
+
+    {
+        Object3D b{&scene};
+        Playable3D playableB{b, &group};
+        playableB.setBuffer(&_buffer)
+            .setLooping(true)
+            .play();
+
+        listener.update({group});
+        CORRADE_COMPARE(group.usedVoiceCount(), 2);
+    }
+
+    /* Destroying a playable releases its source */
+    CORRADE_COMPARE(group.usedVoiceCount(), 1);
+
+    playableA.stop();
+    CORRADE_VERIFY(!playableA.isPlaying());
+    CORRADE_VERIFY(!playableA.isVirtual());
+    CORRADE_COMPARE(group.usedVoiceCount(), 0);
+
+    /* Stopped playables don't get any source */
+    listener.update({group});
+    CORRADE_COMPARE(group.usedVoiceCount(), 0);
+
+    /* Playing the group plays all playables again */
+    group.play();
+    listener.update({group});
+    CORRADE_VERIFY(playableA.isPlaying());
+    CORRADE_COMPARE(group.usedVoiceCount(), 1);
+
+    /* Disabling the virtualization releases all sources */
+    group.setVoiceCount(0);
+    CORRADE_COMPARE(group.usedVoiceCount(), 0);
+}
+
+void PlayableALTest::voicesRemove() {
+    Scene3D scene;
+    Listener3D listener{scene};
+    PlayableGroup3D group, another;
+    group.setVoiceCount(1);
+
+    Object3D a{&scene};
+    Playable3D playableA{a, &group};
+    playableA.setBuffer(&_buffer)
+        .setLooping(true)
+        .play();
+
+    listener.update({group});
+    CORRADE_COMPARE(group.usedVoiceCount(), 1);
+
+    /* Moving the playable elsewhere releases the source on next update */
+    another.add(playableA);
+    listener.update({group});
+    CORRADE_COMPARE(group.usedVoiceCount(), 0);
+}
+
+void PlayableALTest::voicesNoBuffer() {
+    Scene3D scene;
+    Listener3D listener{scene};
+    PlayableGroup3D group;
+    group.setVoiceCount(1);
+
+    Object3D a{&scene};
+    Playable3D playableA{a, &group};
+    playableA.setBuffer(nullptr);
+
+    /* Playables without a buffer don't get any source */
+    playableA.play();
+    listener.update({group});
+    CORRADE_VERIFY(playableA.isPlaying());
+    CORRADE_COMPARE(group.usedVoiceCount(), 0);
+
+    /* The buffer is a second long, so the playback shouldn't have ended
+       yet */
+    playableA.setBuffer(&_buffer)
+        .play();
+    listener.update({group});
+    CORRADE_VERIFY(playableA.isPlaying());
+    CORRADE_COMPARE(group.usedVoiceCount(), 1);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Audio::Test::PlayableALTest)
@@ -0,0 +1,315 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <chrono>
+#include <sstream>
+#include <thread>
+#include <type_traits>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Audio/AbstractImporter.h"
+#include "Magnum/Audio/BufferFormat.h"
+#include "Magnum/Audio/Context.h"
+#include "Magnum/Audio/Source.h"
+#include "Magnum/Audio/StreamingSource.h"
+
+namespace Magnum { namespace Audio { namespace Test { namespace {
+
+struct StreamingSourceALTest: TestSuite::Tester {
+    explicit StreamingSourceALTest();
+
+    void construct();
+    void constructNoFile();
+    void constructInvalidBufferSize();
+    void constructZeroBufferCount();
+    void constructMove();
+
+    void play();
+    void playNoData();
+    void pauseResume();
+    void stop();
+    void update();
+    void updateLooping();
+    void updateThread();
+
+    Context _context;
+};
+
+StreamingSourceALTest::StreamingSourceALTest():
+    TestSuite::Tester{TestSuite::Tester::TesterConfiguration{}.setSkippedArgumentPrefixes({"magnum"})},
+    _context{arguments().first, arguments().second}
+{
+    addTests({&StreamingSourceALTest::construct,
+              &StreamingSourceALTest::constructNoFile,
+              &StreamingSourceALTest::constructInvalidBufferSize,
+              &StreamingSourceALTest::constructZeroBufferCount,
+              &StreamingSourceALTest::constructMove,
+
+              &StreamingSourceALTest::play,
+              &StreamingSourceALTest::playNoData,
+              &StreamingSourceALTest::pauseResume,
+              &StreamingSourceALTest::stop,
+              &StreamingSourceALTest::update,
+              &StreamingSourceALTest::updateLooping,
+              &StreamingSourceALTest::updateThread});
+}
+
+/* Generates 16-bit mono data on the fly, with the position tracked so the
+   tests can verify what was consumed */
+struct Importer: AbstractImporter {
+    explicit Importer(std::size_t frameCount): frameCount{frameCount} {}
+
+    ImporterFeatures doFeatures() const override { return {}; }
+    bool doIsOpened() const override { return true; }
+    void doClose() override {}
+
+    BufferFormat doFormat() const override { return BufferFormat::Mono16; }
+    UnsignedInt doFrequency() const override { return 44100; }
+    Containers::Array<char> doData() override { return nullptr; }
+
+    std::size_t doDataChunk(Containers::ArrayView<char> destination) override {
+        const Containers::ArrayView<Short> samples = Containers::arrayCast<Short>(destination);
+        std::size_t i = 0;
+        for(; i != samples.size() && frame != frameCount; ++i, ++frame)
+            samples[i] = Short(frame % 64*256);
+        if(frame == frameCount) ++endCount;
+        return i*2;
+    }
+
+    void doSeekData(std::size_t frame) override {
+        this->frame = frame;
+        ++seekCount;
+    }
+
+    std::size_t frameCount;
+    std::size_t frame = 0;
+    Int seekCount = 0;
+    Int endCount = 0;
+};
+
+void StreamingSourceALTest::construct() {
+    Importer importer{1000};
+    StreamingSource source{importer, 256, 3};
+    CORRADE_COMPARE(&source.importer(), &importer);
+    CORRADE_COMPARE(source.bufferSize(), 256);
+    CORRADE_COMPARE(source.bufferCount(), 3);
+    CORRADE_VERIFY(!source.isLooping());
+    CORRADE_VERIFY(!source.isPlaying());
+    CORRADE_VERIFY(source.source().id() != 0);
+
+    /* Nothing is decoded until played */
+    CORRADE_COMPARE(importer.frame, 0);
+}
+
+void StreamingSourceALTest::constructNoFile() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return false; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return {}; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    StreamingSource{importer};
+    CORRADE_COMPARE(out.str(), "Audio::StreamingSource: no file opened\n");
+}
+
+void StreamingSourceALTest::constructInvalidBufferSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Importer importer{1000};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    StreamingSource{importer, 1};
+    CORRADE_COMPARE(out.str(), "Audio::StreamingSource: expected buffer size to be at least 2 bytes but got 1\n");
+}
+
+void StreamingSourceALTest::constructZeroBufferCount() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Importer importer{1000};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    StreamingSource{importer, 256, 0};
+    CORRADE_COMPARE(out.str(), "Audio::StreamingSource: expected a non-zero buffer count\n");
+}
+
+void StreamingSourceALTest::constructMove() {
+    Importer importer{1000};
+    StreamingSource a{importer, 256, 3};
+    const ALuint id = a.source().id();
+
+    StreamingSource b{std::move(a)};
+    CORRADE_COMPARE(b.source().id(), id);
+
+    Importer importer2{1000};
+    StreamingSource c{importer2, 128, 2};
+    c = std::move(b);
+    CORRADE_COMPARE(c.source().id(), id);
+    CORRADE_COMPARE(c.bufferSize(), 256);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<StreamingSource>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<StreamingSource>::value);
+}
+
+void StreamingSourceALTest::play() {
+    Importer importer{1000};
+    StreamingSource source{importer, 256, 3};
+    source.play();
+    CORRADE_VERIFY(source.isPlaying());
+    CORRADE_COMPARE(source.source().type(), Source::Type::Streaming);
+
+    /* All three buffers are filled with 128 frames each */
+    CORRADE_COMPARE(importer.frame, 3*128);
+
+    /* Playing again does nothing */
+    source.play();
+    CORRADE_COMPARE(importer.frame, 3*128);
+}
+
+void StreamingSourceALTest::playNoData() {
+    Importer importer{0};
+    StreamingSource source{importer, 256, 3};
+    source.play();
+    CORRADE_VERIFY(!source.isPlaying());
+    CORRADE_VERIFY(!source.update());
+}
+
+void StreamingSourceALTest::pauseResume() {
+    Importer importer{100000};
+    StreamingSource source{importer, 256, 3};
+    source.play();
+
+    source.pause();
+    CORRADE_VERIFY(source.isPlaying());
+    CORRADE_COMPARE(source.source().state(), Source::State::Paused);
+
+    /* Updating while paused doesn't decode anything */
+    CORRADE_VERIFY(source.update());
+    CORRADE_COMPARE(importer.frame, 3*128);
+
+    /* Resuming doesn't decode anything either */
+    source.play();
+    CORRADE_VERIFY(source.isPlaying());
+    CORRADE_COMPARE(source.source().state(), Source::State::Playing);
+    CORRADE_COMPARE(importer.frame, 3*128);
+}
+
+void StreamingSourceALTest::stop() {
+    Importer importer{100000};
+    StreamingSource source{importer, 256, 3};
+    source.play();
+    source.stop();
+    CORRADE_VERIFY(!source.isPlaying());
+    CORRADE_COMPARE(source.source().state(), Source::State::Stopped);
+    CORRADE_COMPARE(importer.seekCount, 1);
+    CORRADE_COMPARE(importer.frame, 0);
+
+    /* Playing again starts from the beginning */
+    source.play();
+    CORRADE_VERIFY(source.isPlaying());
+    CORRADE_COMPARE(importer.frame, 3*128);
+}
+
+void StreamingSourceALTest::update() {
+    /* Around 50 ms of audio */
+    Importer importer{2048};
+    StreamingSource source{importer, 256, 3};
+    source.play();
+
+    /* Update until everything is played, with a generous timeout in case the
+       device plays slower than real time */
+    const auto start = std::chrono::steady_clock::now();
+    while(source.update()) {
+        if(std::chrono::steady_clock::now() - start > std::chrono::seconds{5})
+            CORRADE_FAIL("Timed out waiting for the playback to finish");
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+
+    CORRADE_VERIFY(!source.isPlaying());
+    CORRADE_COMPARE(importer.frame, 2048);
+    CORRADE_COMPARE(importer.seekCount, 0);
+    CORRADE_COMPARE(source.source().state(), Source::State::Stopped);
+}
+
+void StreamingSourceALTest::updateLooping() {
+    Importer importer{256};
+    StreamingSource source{importer, 256, 3};
+    source.setLooping(true);
+    CORRADE_VERIFY(source.isLooping());
+    source.play();
+
+    /* Two buffers exhaust the data, the third is filled after seeking back */
+    CORRADE_COMPARE(importer.seekCount, 1);
+    CORRADE_COMPARE(importer.frame, 128);
+
+    /* Update until the data loop at least once more */
+    const auto start = std::chrono::steady_clock::now();
+    while(importer.seekCount < 2) {
+        if(std::chrono::steady_clock::now() - start > std::chrono::seconds{5})
+            CORRADE_FAIL("Timed out waiting for the playback to loop");
+        CORRADE_VERIFY(source.update());
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+
+    CORRADE_VERIFY(source.isPlaying());
+}
+
+void StreamingSourceALTest::updateThread() {
+    #if !defined(CORRADE_BUILD_MULTITHREADED) || defined(CORRADE_TARGET_EMSCRIPTEN)
+    CORRADE_SKIP("The update thread is not available in this build.");
+    #else
+    Importer importer{2048};
+    StreamingSource source{importer, 256, 3};
+    source.startUpdateThread(std::chrono::milliseconds{1});
+    CORRADE_VERIFY(source.isUpdateThreadRunning());
+    source.play();
+
+    const auto start = std::chrono::steady_clock::now();
+    while(source.isPlaying()) {
+        if(std::chrono::steady_clock::now() - start > std::chrono::seconds{5})
+            CORRADE_FAIL("Timed out waiting for the playback to finish");
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+
+    source.stopUpdateThread();
+    CORRADE_VERIFY(!source.isUpdateThreadRunning());
+    CORRADE_COMPARE(importer.frame, 2048);
+    #endif
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Audio::Test::StreamingSourceALTest)
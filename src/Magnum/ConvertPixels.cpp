@@ -0,0 +1,426 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ConvertPixels.h"
+
+#include <cmath>
+#include <cstring>
+#include <utility>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/EnumSet.hpp>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Implementation/parallelFor.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Packing.h"
+#include "Magnum/Math/PackingBatch.h"
+#include "Magnum/Math/Vector4.h"
+
+#ifdef CORRADE_TARGET_SSE2
+#include <emmintrin.h>
+#elif defined(CORRADE_TARGET_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace Magnum {
+
+namespace {
+
+/* Images with less pixels than this are always converted on the calling
+   thread, the overhead of spawning the threads would be larger than the
+   conversion itself */
+constexpr std::size_t ParallelPixelCount = 256*1024;
+
+/* Channel formats that can be converted through 32-bit floats */
+bool isFloatConvertible(const PixelFormat channelFormat) {
+    switch(channelFormat) {
+        case PixelFormat::R8Unorm:
+        case PixelFormat::R8Snorm:
+        case PixelFormat::R8Srgb:
+        case PixelFormat::R16Unorm:
+        case PixelFormat::R16Snorm:
+        case PixelFormat::R16F:
+        case PixelFormat::R32F:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/* Bit pattern of a one in given channel format, used for the alpha channel
+   if it's not present in the source */
+UnsignedInt channelOne(const PixelFormat channelFormat) {
+    switch(channelFormat) {
+        case PixelFormat::R8Unorm:
+        case PixelFormat::R8Srgb:
+            return 0xff;
+        case PixelFormat::R8Snorm:
+            return 0x7f;
+        case PixelFormat::R16Unorm:
+            return 0xffff;
+        case PixelFormat::R16Snorm:
+            return 0x7fff;
+        case PixelFormat::R16F:
+            return 0x3c00;
+        case PixelFormat::R32F:
+            return 0x3f800000;
+        /* Integer formats */
+        default:
+            return 1;
+    }
+}
+
+/* View on channels of a row of pixels. Pixel views coming from images always
+   have positive strides. */
+template<class T, class U> Containers::StridedArrayView2D<T> channelView(const Containers::StridedArrayView2D<U>& pixels, const UnsignedInt channels) {
+    const std::size_t size = pixels.size()[0] ? (pixels.size()[0] - 1)*std::size_t(pixels.stride()[0]) + pixels.size()[1] : 0;
+    return {{pixels.data(), size}, static_cast<T*>(pixels.data()), {pixels.size()[0], channels}, {pixels.stride()[0], sizeof(T)}};
+}
+
+/* Vectorized kernel for rearranging channels of a contiguous run of 8-bit
+   pixels. Returns the count of pixels it processed, the remainder (or
+   everything, if there's no specialization for given channel counts or
+   platform) is then handled by the scalar loop in shuffleRow(). Each
+   iteration reads a whole batch of pixels before writing it, so it works
+   in-place as well. */
+#ifdef CORRADE_TARGET_SSE2
+std::size_t shuffleKernel(const UnsignedByte* const src, const UnsignedInt srcChannels, UnsignedByte* const dst, const UnsignedInt dstChannels, const bool swapRedBlue, UnsignedByte, const std::size_t count) {
+    /* SSE2 has no byte shuffle instruction, so only the four-channel swap
+       that can be done with shifts and masks on 32-bit lanes is vectorized */
+    if(srcChannels != 4 || dstChannels != 4 || !swapRedBlue) return 0;
+
+    const __m128i greenAlpha = _mm_set1_epi32(Int(0xff00ff00u));
+    const __m128i byte = _mm_set1_epi32(0xff);
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i*4));
+        const __m128i red = _mm_slli_epi32(_mm_and_si128(a, byte), 16);
+        const __m128i blue = _mm_and_si128(_mm_srli_epi32(a, 16), byte);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i*4), _mm_or_si128(_mm_and_si128(a, greenAlpha), _mm_or_si128(red, blue)));
+    }
+    return i;
+}
+#elif defined(CORRADE_TARGET_NEON)
+std::size_t shuffleKernel(const UnsignedByte* const src, const UnsignedInt srcChannels, UnsignedByte* const dst, const UnsignedInt dstChannels, const bool swapRedBlue, const UnsignedByte one, const std::size_t count) {
+    /* The interleaving loads and stores do all the work, the channels are
+       only swapped between registers */
+    std::size_t i = 0;
+    if(srcChannels == 3 && dstChannels == 4) {
+        const uint8x16_t alpha = vdupq_n_u8(one);
+        for(; i + 16 <= count; i += 16) {
+            const uint8x16x3_t a = vld3q_u8(src + i*3);
+            uint8x16x4_t b;
+            b.val[0] = a.val[swapRedBlue ? 2 : 0];
+            b.val[1] = a.val[1];
+            b.val[2] = a.val[swapRedBlue ? 0 : 2];
+            b.val[3] = alpha;
+            vst4q_u8(dst + i*4, b);
+        }
+    } else if(srcChannels == 4 && dstChannels == 3) {
+        for(; i + 16 <= count; i += 16) {
+            const uint8x16x4_t a = vld4q_u8(src + i*4);
+            uint8x16x3_t b;
+            b.val[0] = a.val[swapRedBlue ? 2 : 0];
+            b.val[1] = a.val[1];
+            b.val[2] = a.val[swapRedBlue ? 0 : 2];
+            vst3q_u8(dst + i*3, b);
+        }
+    } else if(srcChannels == 4 && dstChannels == 4 && swapRedBlue) {
+        for(; i + 16 <= count; i += 16) {
+            uint8x16x4_t a = vld4q_u8(src + i*4);
+            std::swap(a.val[0], a.val[2]);
+            vst4q_u8(dst + i*4, a);
+        }
+    } else if(srcChannels == 3 && dstChannels == 3 && swapRedBlue) {
+        for(; i + 16 <= count; i += 16) {
+            uint8x16x3_t a = vld3q_u8(src + i*3);
+            std::swap(a.val[0], a.val[2]);
+            vst3q_u8(dst + i*3, a);
+        }
+    }
+    return i;
+}
+#else
+std::size_t shuffleKernel(const UnsignedByte*, UnsignedInt, UnsignedByte*, UnsignedInt, bool, UnsignedByte, std::size_t) { return 0; }
+#endif
+
+/* Each pixel is read whole before it's written, so this works in-place as
+   well */
+template<class T> void shuffleRowScalar(const char* const src, const std::ptrdiff_t srcStride, const UnsignedInt srcChannels, char* const dst, const std::ptrdiff_t dstStride, const UnsignedInt dstChannels, const bool swapRedBlue, const T one, const std::size_t count) {
+    for(std::size_t i = 0; i != count; ++i) {
+        const T* const srcPixel = reinterpret_cast<const T*>(src + std::ptrdiff_t(i)*srcStride);
+        T* const dstPixel = reinterpret_cast<T*>(dst + std::ptrdiff_t(i)*dstStride);
+        T channels[4]{T{}, T{}, T{}, one};
+        for(UnsignedInt j = 0; j != srcChannels; ++j)
+            channels[j] = srcPixel[j];
+        if(swapRedBlue)
+            std::swap(channels[0], channels[2]);
+        for(UnsignedInt j = 0; j != dstChannels; ++j)
+            dstPixel[j] = channels[j];
+    }
+}
+
+void shuffleRow(const Containers::StridedArrayView2D<const char>& src, const UnsignedInt srcChannels, const Containers::StridedArrayView2D<char>& dst, const UnsignedInt dstChannels, const UnsignedInt channelSize, const UnsignedInt one, const bool swapRedBlue) {
+    const std::size_t count = src.size()[0];
+    const char* const srcData = static_cast<const char*>(src.data());
+    char* const dstData = static_cast<char*>(dst.data());
+    const std::ptrdiff_t srcStride = src.stride()[0];
+    const std::ptrdiff_t dstStride = dst.stride()[0];
+
+    if(channelSize == 1) {
+        std::size_t i = 0;
+        if(srcStride == std::ptrdiff_t(srcChannels) && dstStride == std::ptrdiff_t(dstChannels))
+            i = shuffleKernel(reinterpret_cast<const UnsignedByte*>(srcData), srcChannels, reinterpret_cast<UnsignedByte*>(dstData), dstChannels, swapRedBlue, UnsignedByte(one), count);
+        shuffleRowScalar<UnsignedByte>(srcData + std::ptrdiff_t(i)*srcStride, srcStride, srcChannels, dstData + std::ptrdiff_t(i)*dstStride, dstStride, dstChannels, swapRedBlue, UnsignedByte(one), count - i);
+    } else if(channelSize == 2) {
+        shuffleRowScalar<UnsignedShort>(srcData, srcStride, srcChannels, dstData, dstStride, dstChannels, swapRedBlue, UnsignedShort(one), count);
+    } else {
+        CORRADE_INTERNAL_ASSERT(channelSize == 4);
+        shuffleRowScalar<UnsignedInt>(srcData, srcStride, srcChannels, dstData, dstStride, dstChannels, swapRedBlue, one, count);
+    }
+}
+
+/* Same operations as in Color3::fromSrgb() and Color3::toSrgb() to have
+   bit-exact results */
+inline Float srgbToLinear(const Float value) {
+    constexpr Float a = 0.055f;
+    return value > 0.04045f ? std::pow((value + a)/(1.0f + a), 2.4f) : value/12.92f;
+}
+
+inline Float linearToSrgb(const Float value) {
+    constexpr Float a = 0.055f;
+    return value > 0.0031308f ? (1.0f + a)*std::pow(value, 1.0f/2.4f) - a : value*12.92f;
+}
+
+/* Linear values for all 8-bit sRGB inputs, calculated on first use. There's
+   no 16-bit sRGB format so this covers all sRGB inputs. */
+const Float* srgbToLinearTable() {
+    static const struct Table {
+        Table() {
+            for(UnsignedInt i = 0; i != 256; ++i)
+                data[i] = srgbToLinear(i/255.0f);
+        }
+
+        Float data[256];
+    } table;
+    return table.data;
+}
+
+void unpackRow(const PixelFormat channelFormat, const Containers::StridedArrayView2D<const char>& src, const UnsignedInt channels, const Containers::ArrayView<Vector4> out) {
+    const Containers::StridedArrayView2D<Float> outChannels{out, reinterpret_cast<Float*>(out.data()), {out.size(), channels}, {sizeof(Vector4), sizeof(Float)}};
+
+    switch(channelFormat) {
+        case PixelFormat::R8Unorm:
+            Math::unpackInto(channelView<const UnsignedByte>(src, channels), outChannels);
+            return;
+        case PixelFormat::R8Snorm:
+            Math::unpackInto(channelView<const Byte>(src, channels), outChannels);
+            return;
+        case PixelFormat::R16Unorm:
+            Math::unpackInto(channelView<const UnsignedShort>(src, channels), outChannels);
+            return;
+        case PixelFormat::R16Snorm:
+            Math::unpackInto(channelView<const Short>(src, channels), outChannels);
+            return;
+        case PixelFormat::R16F:
+            Math::unpackHalfInto(channelView<const UnsignedShort>(src, channels), outChannels);
+            return;
+        /* RGB channels go through a lookup table, alpha is linear */
+        case PixelFormat::R8Srgb: {
+            const Float* const table = srgbToLinearTable();
+            const Containers::StridedArrayView2D<const UnsignedByte> in = channelView<const UnsignedByte>(src, channels);
+            for(std::size_t i = 0; i != in.size()[0]; ++i)
+                for(std::size_t j = 0; j != channels; ++j)
+                    outChannels[i][j] = j == 3 ? Math::unpack<Float>(in[i][j]) : table[in[i][j]];
+            return;
+        }
+        case PixelFormat::R32F: {
+            const Containers::StridedArrayView2D<const Float> in = channelView<const Float>(src, channels);
+            for(std::size_t i = 0; i != in.size()[0]; ++i)
+                for(std::size_t j = 0; j != channels; ++j)
+                    outChannels[i][j] = in[i][j];
+            return;
+        }
+        default: CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+    }
+}
+
+/* Clamps the values to the range of given channel format and encodes them to
+   sRGB if needed, so packRow() gets values it can represent */
+void prepareForPacking(const PixelFormat channelFormat, const Containers::ArrayView<Vector4> pixels) {
+    switch(channelFormat) {
+        case PixelFormat::R8Unorm:
+        case PixelFormat::R16Unorm:
+            for(Vector4& pixel: pixels)
+                pixel = Math::clamp(pixel, 0.0f, 1.0f);
+            return;
+        case PixelFormat::R8Snorm:
+        case PixelFormat::R16Snorm:
+            for(Vector4& pixel: pixels)
+                pixel = Math::clamp(pixel, -1.0f, 1.0f);
+            return;
+        /* Alpha stays linear */
+        case PixelFormat::R8Srgb:
+            for(Vector4& pixel: pixels) {
+                pixel = Math::clamp(pixel, 0.0f, 1.0f);
+                for(std::size_t i = 0; i != 3; ++i)
+                    pixel[i] = linearToSrgb(pixel[i]);
+            }
+            return;
+        default: return;
+    }
+}
+
+void packRow(const PixelFormat channelFormat, const Containers::ArrayView<const Vector4> in, const Containers::StridedArrayView2D<char>& dst, const UnsignedInt channels) {
+    const Containers::StridedArrayView2D<const Float> inChannels{in, reinterpret_cast<const Float*>(in.data()), {in.size(), channels}, {sizeof(Vector4), sizeof(Float)}};
+
+    switch(channelFormat) {
+        case PixelFormat::R8Unorm:
+        case PixelFormat::R8Srgb:
+            Math::packInto(inChannels, channelView<UnsignedByte>(dst, channels));
+            return;
+        case PixelFormat::R8Snorm:
+            Math::packInto(inChannels, channelView<Byte>(dst, channels));
+            return;
+        case PixelFormat::R16Unorm:
+            Math::packInto(inChannels, channelView<UnsignedShort>(dst, channels));
+            return;
+        case PixelFormat::R16Snorm:
+            Math::packInto(inChannels, channelView<Short>(dst, channels));
+            return;
+        case PixelFormat::R16F:
+            Math::packHalfInto(inChannels, channelView<UnsignedShort>(dst, channels));
+            return;
+        case PixelFormat::R32F: {
+            const Containers::StridedArrayView2D<Float> out = channelView<Float>(dst, channels);
+            for(std::size_t i = 0; i != out.size()[0]; ++i)
+                for(std::size_t j = 0; j != channels; ++j)
+                    out[i][j] = inChannels[i][j];
+            return;
+        }
+        default: CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+    }
+}
+
+}
+
+void convertPixels(const ImageView2D& src, const MutableImageView2D& dst, const ConvertPixelsFlags flags, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "convertPixels(): expected images of the same size, got" << Debug::packed << src.size() << "and" << Debug::packed << dst.size(), );
+
+    const Containers::StridedArrayView3D<const char> srcPixels = src.pixels();
+    const Containers::StridedArrayView3D<char> dstPixels = dst.pixels();
+    const bool swapRedBlue = !!(flags & ConvertPixelsFlag::SwapRedBlue);
+    const UnsignedInt rowThreadCount = std::size_t(src.size().product()) >= ParallelPixelCount ? threadCount : 1;
+
+    /* Same format, copy the rows as-is. The pixels in a row are always
+       contiguous, memmove() to handle the in-place case. */
+    if(src.format() == dst.format() && src.formatExtra() == dst.formatExtra() && src.pixelSize() == dst.pixelSize() && !swapRedBlue) {
+        const std::size_t rowSize = std::size_t(src.size().x())*src.pixelSize();
+        Implementation::parallelFor(srcPixels.size()[0], rowThreadCount, [&](const std::size_t begin, const std::size_t end) {
+            for(std::size_t i = begin; i != end; ++i)
+                std::memmove(dstPixels[i].data(), srcPixels[i].data(), rowSize);
+        });
+        return;
+    }
+
+    CORRADE_ASSERT(!isPixelFormatImplementationSpecific(src.format()) && !isPixelFormatImplementationSpecific(dst.format()),
+        "convertPixels(): can't convert implementation-specific pixel formats, got" << src.format() << "and" << dst.format(), );
+    CORRADE_ASSERT(!isPixelFormatDepthOrStencil(src.format()) && !isPixelFormatDepthOrStencil(dst.format()),
+        "convertPixels(): can't convert depth/stencil pixel formats, got" << src.format() << "and" << dst.format(), );
+
+    const PixelFormat srcChannelFormat = pixelFormatChannelFormat(src.format());
+    const PixelFormat dstChannelFormat = pixelFormatChannelFormat(dst.format());
+    const UnsignedInt srcChannels = pixelFormatChannelCount(src.format());
+    const UnsignedInt dstChannels = pixelFormatChannelCount(dst.format());
+    CORRADE_ASSERT(!swapRedBlue || srcChannels >= 3,
+        "convertPixels(): can't swap red and blue channels of" << src.format(), );
+
+    /* Same channel type, only rearranging the channels */
+    if(srcChannelFormat == dstChannelFormat) {
+        const UnsignedInt channelSize = pixelFormatSize(srcChannelFormat);
+        const UnsignedInt one = channelOne(srcChannelFormat);
+        Implementation::parallelFor(srcPixels.size()[0], rowThreadCount, [&](const std::size_t begin, const std::size_t end) {
+            for(std::size_t i = begin; i != end; ++i)
+                shuffleRow(srcPixels[i], srcChannels, dstPixels[i], dstChannels, channelSize, one, swapRedBlue);
+        });
+        return;
+    }
+
+    CORRADE_ASSERT(isFloatConvertible(srcChannelFormat) && isFloatConvertible(dstChannelFormat),
+        "convertPixels(): can't convert" << src.format() << "to" << dst.format(), );
+
+    /* Otherwise going through floats. The whole row is unpacked before it's
+       packed again, so this works in-place as well. */
+    Implementation::parallelFor(srcPixels.size()[0], rowThreadCount, [&](const std::size_t begin, const std::size_t end) {
+        Containers::Array<Vector4> row{NoInit, srcPixels.size()[1]};
+        for(std::size_t i = begin; i != end; ++i) {
+            for(Vector4& pixel: row)
+                pixel = {0.0f, 0.0f, 0.0f, 1.0f};
+            unpackRow(srcChannelFormat, srcPixels[i], srcChannels, row);
+            if(swapRedBlue) for(Vector4& pixel: row)
+                std::swap(pixel.x(), pixel.z());
+            prepareForPacking(dstChannelFormat, row);
+            packRow(dstChannelFormat, row, dstPixels[i], dstChannels);
+        }
+    });
+}
+
+Image2D convertPixels(const ImageView2D& src, const PixelFormat format, const ConvertPixelsFlags flags, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(!isPixelFormatImplementationSpecific(format),
+        "convertPixels(): can't allocate an image of an implementation-specific format" << reinterpret_cast<void*>(pixelFormatUnwrap(format)), (Image2D{PixelFormat::RGBA8Unorm}));
+
+    /* Rows aligned to four bytes, matching the default PixelStorage */
+    const std::size_t rowSize = 4*((std::size_t(pixelFormatSize(format))*src.size().x() + 3)/4);
+    Image2D out{format, src.size(), Containers::Array<char>{NoInit, rowSize*src.size().y()}};
+    convertPixels(src, out, flags, threadCount);
+    return out;
+}
+
+Debug& operator<<(Debug& debug, const ConvertPixelsFlag value) {
+    debug << "ConvertPixelsFlag" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(v) case ConvertPixelsFlag::v: return debug << "::" #v;
+        _c(SwapRedBlue)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+Debug& operator<<(Debug& debug, const ConvertPixelsFlags value) {
+    return Containers::enumSetDebugOutput(debug, value, "ConvertPixelsFlags{}", {
+        ConvertPixelsFlag::SwapRedBlue});
+}
+
+}
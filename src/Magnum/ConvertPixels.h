@@ -0,0 +1,137 @@
+#ifndef Magnum_ConvertPixels_h
+#define Magnum_ConvertPixels_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::convertPixels(), enum @ref Magnum::ConvertPixelsFlag, enum set @ref Magnum::ConvertPixelsFlags
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/EnumSet.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum {
+
+/**
+@brief Pixel conversion flag
+@m_since_latest
+
+@see @ref ConvertPixelsFlags, @ref convertPixels()
+*/
+enum class ConvertPixelsFlag: UnsignedByte {
+    /**
+     * Swap the first and third channel of the source, i.e. treat it as being
+     * in a BGR or BGRA order. Expects that the source format has at least
+     * three channels.
+     */
+    SwapRedBlue = 1 << 0
+};
+
+/**
+@brief Pixel conversion flags
+@m_since_latest
+
+@see @ref convertPixels()
+*/
+typedef Containers::EnumSet<ConvertPixelsFlag> ConvertPixelsFlags;
+
+CORRADE_ENUMSET_OPERATORS(ConvertPixelsFlags)
+
+/**
+@debugoperatorenum{ConvertPixelsFlag}
+@m_since_latest
+*/
+MAGNUM_EXPORT Debug& operator<<(Debug& debug, ConvertPixelsFlag value);
+
+/**
+@debugoperatorenum{ConvertPixelsFlags}
+@m_since_latest
+*/
+MAGNUM_EXPORT Debug& operator<<(Debug& debug, ConvertPixelsFlags value);
+
+/**
+@brief Convert pixels between two formats
+@param src          Source image
+@param dst          Destination image
+@param flags        Conversion flags
+@param threadCount  Max count of threads to use. If @cpp 0 @ce,
+    @ref TaskScheduler::threadCount() of @ref TaskScheduler::global() is used.
+@m_since_latest
+
+Expects that both images have the same size. If both have the same format and
+no @p flags are set, the pixels are copied as-is, which works for
+implementation-specific and depth/stencil formats as well. Otherwise the
+conversion is done as follows:
+
+-   If both formats have the same @ref pixelFormatChannelFormat(), only the
+    channels get rearranged --- channels not present in the source are set to
+    zero and alpha to one, channels not present in the destination get
+    dropped. This works for all non-implementation-specific color formats
+    including the integer ones. Conversion between
+    @ref PixelFormat::RGB8Unorm and @ref PixelFormat::RGBA8Unorm (and the
+    sRGB variants) as well as swapping red and blue channels in 8-bit formats
+    is vectorized using SSE2 or NEON if available.
+-   Otherwise, if both formats are normalized, sRGB or floating-point, the
+    pixels are converted through 32-bit floats, using the vectorized
+    @ref Math::unpackInto(), @ref Math::packInto(),
+    @ref Math::unpackHalfInto() and @ref Math::packHalfInto(). sRGB channels
+    are converted to linear RGB and back, alpha is always linear. Values
+    outside of the range of a normalized destination format are clamped.
+-   Conversion between integer and non-integer formats or between integer
+    formats of different channel type isn't supported and asserts.
+
+The source and destination can be views on the same memory if both formats
+have the same pixel size, allowing for example to do an in-place BGR to RGB
+swizzle:
+
+@snippet Magnum.cpp convertPixels
+
+Images with more than about a quarter million pixels are processed on up to
+@p threadCount threads, split by rows. If Corrade isn't built with
+@ref CORRADE_BUILD_MULTITHREADED or when targeting
+@ref CORRADE_TARGET_EMSCRIPTEN "Emscripten", the @p threadCount parameter is
+ignored and everything is done on the calling thread.
+@see @ref isPixelFormatImplementationSpecific(),
+    @ref isPixelFormatDepthOrStencil(), @ref isPixelFormatSrgb()
+*/
+MAGNUM_EXPORT void convertPixels(const ImageView2D& src, const MutableImageView2D& dst, ConvertPixelsFlags flags = {}, UnsignedInt threadCount = 0);
+
+/**
+@brief Convert pixels to a new image
+@m_since_latest
+
+Allocates a new image of @p format with the same size as @p src and default
+@ref PixelStorage and calls
+@ref convertPixels(const ImageView2D&, const MutableImageView2D&, ConvertPixelsFlags, UnsignedInt)
+on it. Expects that @p format is not implementation-specific.
+*/
+MAGNUM_EXPORT Image2D convertPixels(const ImageView2D& src, PixelFormat format, ConvertPixelsFlags flags = {}, UnsignedInt threadCount = 0);
+
+}
+
+#endif
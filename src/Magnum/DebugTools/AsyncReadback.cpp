@@ -0,0 +1,170 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "AsyncReadback.h"
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/DebugTools/BufferData.h"
+#include "Magnum/DebugTools/TextureImage.h"
+#include "Magnum/GL/Buffer.h"
+#include "Magnum/GL/BufferImage.h"
+#include "Magnum/Math/Range.h"
+
+namespace Magnum { namespace DebugTools {
+
+struct AsyncReadback::State {
+    explicit State(GL::Buffer&& buffer, std::size_t size) noexcept: buffer{std::move(buffer)}, fence{glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0)}, size{size} {}
+
+    ~State() {
+        if(fence) glDeleteSync(fence);
+    }
+
+    GL::Buffer buffer;
+    /* Deleted and set to null once signaled */
+    GLsync fence;
+    std::size_t size;
+    bool retrieved{};
+
+    /* Set only for image readbacks */
+    bool isImage{};
+    PixelStorage storage;
+    PixelFormat format{};
+    Vector2i imageSize;
+};
+
+AsyncReadback::AsyncReadback(NoCreateT) noexcept {}
+
+AsyncReadback::AsyncReadback(Containers::Pointer<State>&& state) noexcept: _state{std::move(state)} {}
+
+AsyncReadback::AsyncReadback(GL::BufferImage2D&& image, const PixelFormat format) {
+    const PixelStorage storage = image.storage();
+    const Vector2i size = image.size();
+    const std::size_t dataSize = image.dataSize();
+    _state.emplace(image.release(), dataSize);
+    _state->isImage = true;
+    _state->storage = storage;
+    _state->format = format;
+    _state->imageSize = size;
+}
+
+AsyncReadback::AsyncReadback(AsyncReadback&&) noexcept = default;
+
+AsyncReadback::~AsyncReadback() = default;
+
+AsyncReadback& AsyncReadback::operator=(AsyncReadback&&) noexcept = default;
+
+bool AsyncReadback::isImage() const {
+    return _state && _state->isImage;
+}
+
+std::size_t AsyncReadback::size() const {
+    return _state ? _state->size : 0;
+}
+
+bool AsyncReadback::isReady() {
+    CORRADE_ASSERT(_state,
+        "DebugTools::AsyncReadback::isReady(): the instance is in a moved-from state", {});
+    State& state = *_state;
+    if(!state.fence) return true;
+
+    /* Flush so the fence gets signaled eventually even if the application
+       doesn't submit any more work. GL_WAIT_FAILED would only happen with an
+       invalid sync object or context loss, treating it as signaled to not
+       poll forever. */
+    if(glClientWaitSync(state.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0) == GL_TIMEOUT_EXPIRED)
+        return false;
+
+    glDeleteSync(state.fence);
+    state.fence = {};
+    return true;
+}
+
+AsyncReadback& AsyncReadback::wait() {
+    CORRADE_ASSERT(_state,
+        "DebugTools::AsyncReadback::wait(): the instance is in a moved-from state", *this);
+    State& state = *_state;
+    if(!state.fence) return *this;
+
+    /* Flush on the first wait so the fence isn't waited on forever if it
+       wasn't submitted yet, then wait for a second at a time */
+    GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+    while(glClientWaitSync(state.fence, flags, 1000000000ull) == GL_TIMEOUT_EXPIRED)
+        flags = 0;
+
+    glDeleteSync(state.fence);
+    state.fence = {};
+    return *this;
+}
+
+Containers::Array<char> AsyncReadback::data() {
+    CORRADE_ASSERT(_state,
+        "DebugTools::AsyncReadback::data(): the instance is in a moved-from state", {});
+    CORRADE_ASSERT(!_state->retrieved,
+        "DebugTools::AsyncReadback::data(): the data were already retrieved", {});
+
+    wait();
+    _state->retrieved = true;
+    return bufferSubData(_state->buffer, 0, _state->size);
+}
+
+Image2D AsyncReadback::image() {
+    CORRADE_ASSERT(_state && _state->isImage,
+        "DebugTools::AsyncReadback::image(): not an image readback", (Image2D{PixelFormat{}}));
+    CORRADE_ASSERT(!_state->retrieved,
+        "DebugTools::AsyncReadback::image(): the data were already retrieved", (Image2D{PixelFormat{}}));
+
+    const State& state = *_state;
+    Containers::Array<char> imageData = data();
+    return Image2D{state.storage, state.format, state.imageSize, std::move(imageData)};
+}
+
+AsyncReadback bufferSubDataAsync(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    GL::Buffer staging{GL::Buffer::TargetHint::CopyWrite};
+    staging.setData({nullptr, std::size_t(size)}, GL::BufferUsage::StreamRead);
+    if(size) GL::Buffer::copy(buffer, staging, offset, 0, size);
+
+    return AsyncReadback{Containers::pointer<AsyncReadback::State>(std::move(staging), std::size_t(size))};
+}
+
+AsyncReadback bufferDataAsync(GL::Buffer& buffer) {
+    return bufferSubDataAsync(buffer, 0, buffer.size());
+}
+
+AsyncReadback textureSubImageAsync(GL::Texture2D& texture, const Int level, const Range2Di& range, const PixelFormat format) {
+    GL::BufferImage2D image{format};
+    textureSubImage(texture, level, range, image, GL::BufferUsage::StreamRead);
+    return AsyncReadback{std::move(image), format};
+}
+
+AsyncReadback textureSubImageAsync(GL::CubeMapTexture& texture, const GL::CubeMapCoordinate coordinate, const Int level, const Range2Di& range, const PixelFormat format) {
+    GL::BufferImage2D image{format};
+    textureSubImage(texture, coordinate, level, range, image, GL::BufferUsage::StreamRead);
+    return AsyncReadback{std::move(image), format};
+}
+
+}}
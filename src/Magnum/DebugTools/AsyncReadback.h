@@ -0,0 +1,218 @@
+#ifndef Magnum_DebugTools_AsyncReadback_h
+#define Magnum_DebugTools_AsyncReadback_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#if defined(MAGNUM_TARGET_GL) && !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+/** @file
+ * @brief Class @ref Magnum::DebugTools::AsyncReadback, function @ref Magnum::DebugTools::bufferSubDataAsync(), @ref Magnum::DebugTools::bufferDataAsync(), @ref Magnum::DebugTools::textureSubImageAsync()
+ * @m_since_latest
+ */
+#endif
+
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Tags.h"
+#include "Magnum/DebugTools/visibility.h"
+#include "Magnum/GL/GL.h"
+#include "Magnum/GL/OpenGL.h"
+
+#if defined(MAGNUM_TARGET_GL) && !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+namespace Magnum { namespace DebugTools {
+
+/**
+@brief Asynchronous GPU readback
+@m_since_latest
+
+Returned from @ref bufferSubDataAsync(), @ref bufferDataAsync() and
+@ref textureSubImageAsync(). Unlike @ref bufferSubData() and
+@ref textureSubImage(), which block until the GPU finishes all work that
+affects the data, these only record a copy into a staging buffer followed by a
+fence and return immediately. The data can be then retrieved once
+@ref isReady() returns @cpp true @ce, typically a frame or two later, without
+stalling the pipeline. Useful for getting back GPU-computed results such as
+culling statistics or histograms:
+
+@snippet MagnumDebugTools-gl.cpp AsyncReadback
+
+Calling @ref data() or @ref image() before the readback is ready waits for it
+the same way as @ref wait() does. The instance owns the staging buffer and
+can be kept around for as long as needed, however the retrieval functions can
+be called only once.
+
+@note This class is available only if Magnum is compiled with
+    @ref MAGNUM_TARGET_GL "TARGET_GL" enabled (done by default). See
+    @ref building-features for more information.
+
+@requires_gl31 Extension @gl_extension{ARB,copy_buffer} for buffer readbacks,
+    @gl_extension{ARB,pixel_buffer_object} for texture readbacks and
+    @gl_extension{ARB,sync} for fences
+@requires_gles30 Buffer copies, pixel buffer objects and fences are not
+    available in OpenGL ES 2.0.
+@requires_gles Waiting for a fence on the client side isn't possible in
+    WebGL.
+*/
+class MAGNUM_DEBUGTOOLS_EXPORT AsyncReadback {
+    public:
+        /**
+         * @brief Construct without creating the internal state
+         *
+         * The instance is equivalent to a moved-from state. Useful in cases
+         * where you will overwrite the instance later anyway. Move another
+         * object over it to make it useful.
+         */
+        explicit AsyncReadback(NoCreateT) noexcept;
+
+        /** @brief Copying is not allowed */
+        AsyncReadback(const AsyncReadback&) = delete;
+
+        /** @brief Move constructor */
+        AsyncReadback(AsyncReadback&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Deletes the fence and the staging buffer without waiting for the
+         * readback to finish.
+         */
+        ~AsyncReadback();
+
+        /** @brief Copying is not allowed */
+        AsyncReadback& operator=(const AsyncReadback&) = delete;
+
+        /** @brief Move assignment */
+        AsyncReadback& operator=(AsyncReadback&& other) noexcept;
+
+        /**
+         * @brief Whether the readback is an image
+         *
+         * Returns @cpp true @ce if the readback was created with
+         * @ref textureSubImageAsync(), @cpp false @ce if with
+         * @ref bufferSubDataAsync() or @ref bufferDataAsync() or if the
+         * instance is in a moved-from state.
+         */
+        bool isImage() const;
+
+        /** @brief Size of the read data in bytes */
+        std::size_t size() const;
+
+        /**
+         * @brief Whether the readback is ready
+         *
+         * Polls the fence without waiting, flushing the command queue if the
+         * fence isn't signaled yet so it eventually gets signaled. Once this
+         * function returns @cpp true @ce, it will return @cpp true @ce for
+         * all subsequent calls as well.
+         */
+        bool isReady();
+
+        /**
+         * @brief Wait for the readback to be ready
+         * @return Reference to self (for method chaining)
+         */
+        AsyncReadback& wait();
+
+        /**
+         * @brief Retrieve the data
+         *
+         * Waits for the readback if it isn't ready yet and copies the data
+         * out of the staging buffer. For image readbacks the data include
+         * row padding described by the image @ref PixelStorage. Expects that
+         * the data weren't retrieved already.
+         */
+        Containers::Array<char> data();
+
+        /**
+         * @brief Retrieve the image
+         *
+         * Like @ref data(), but wraps the data in an @ref Image2D with the
+         * pixel format, size and storage the readback was created with.
+         * Expects that @ref isImage() is @cpp true @ce and that the data
+         * weren't retrieved already.
+         */
+        Image2D image();
+
+    private:
+        struct State;
+
+        friend MAGNUM_DEBUGTOOLS_EXPORT AsyncReadback bufferSubDataAsync(GL::Buffer&, GLintptr, GLsizeiptr);
+        friend MAGNUM_DEBUGTOOLS_EXPORT AsyncReadback textureSubImageAsync(GL::Texture2D&, Int, const Range2Di&, PixelFormat);
+        friend MAGNUM_DEBUGTOOLS_EXPORT AsyncReadback textureSubImageAsync(GL::CubeMapTexture&, GL::CubeMapCoordinate, Int, const Range2Di&, PixelFormat);
+
+        MAGNUM_DEBUGTOOLS_LOCAL explicit AsyncReadback(Containers::Pointer<State>&& state) noexcept;
+        MAGNUM_DEBUGTOOLS_LOCAL explicit AsyncReadback(GL::BufferImage2D&& image, PixelFormat format);
+
+        Containers::Pointer<State> _state;
+};
+
+/**
+@brief Asynchronously read buffer subdata
+@m_since_latest
+
+Copies @p size bytes at @p offset from @p buffer into a newly created staging
+buffer using @ref GL::Buffer::copy() and guards the copy with a fence. See
+@ref AsyncReadback for more information.
+@see @ref bufferSubData()
+*/
+MAGNUM_DEBUGTOOLS_EXPORT AsyncReadback bufferSubDataAsync(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+/**
+@brief Asynchronously read buffer data
+@m_since_latest
+
+Equivalent to calling @ref bufferSubDataAsync() with the whole buffer size.
+@see @ref bufferData()
+*/
+MAGNUM_DEBUGTOOLS_EXPORT AsyncReadback bufferDataAsync(GL::Buffer& buffer);
+
+/**
+@brief Asynchronously read range of given texture mip level
+@m_since_latest
+
+Reads the texture into a @ref GL::BufferImage2D using
+@ref textureSubImage(GL::Texture2D&, Int, const Range2Di&, GL::BufferImage2D&, GL::BufferUsage)
+and guards the read with a fence. See @ref AsyncReadback for more
+information. Unlike the synchronous @ref Image2D variant of
+@ref textureSubImage(), the @ref GL::PixelType::Float reinterpretation on
+OpenGL ES isn't done.
+*/
+MAGNUM_DEBUGTOOLS_EXPORT AsyncReadback textureSubImageAsync(GL::Texture2D& texture, Int level, const Range2Di& range, PixelFormat format);
+
+/**
+@brief Asynchronously read range of given cube map texture coordinate mip level
+@m_since_latest
+
+Like @ref textureSubImageAsync(GL::Texture2D&, Int, const Range2Di&, PixelFormat)
+but for a cube map face.
+*/
+MAGNUM_DEBUGTOOLS_EXPORT AsyncReadback textureSubImageAsync(GL::CubeMapTexture& texture, GL::CubeMapCoordinate coordinate, Int level, const Range2Di& range, PixelFormat format);
+
+}}
+#else
+#error this header is available only in the OpenGL build and not on ES2 or WebGL
+#endif
+
+#endif
@@ -43,59 +43,205 @@
 #include "Magnum/Math/Functions.h"
 #include "Magnum/Math/Half.h"
 #include "Magnum/Math/Color.h"
-#include "Magnum/Math/Algorithms/KahanSum.h"
+#include "Magnum/Math/Algorithms/Reduce.h"
 #include "Magnum/Trade/AbstractImageConverter.h"
 #include "Magnum/Trade/AbstractImporter.h"
 #include "Magnum/Trade/ImageData.h"
+#include "Magnum/Implementation/parallelFor.h"
+
+#ifdef CORRADE_TARGET_SSE2
+#include <emmintrin.h>
+#endif
 
 namespace Magnum { namespace DebugTools { namespace Implementation {
 
 namespace {
 
-template<std::size_t size, class T> Float calculateImageDelta(const Containers::StridedArrayView2D<const Math::Vector<size, T>>& actual, const Containers::StridedArrayView2D<const Math::Vector<size, T>>& expected, const Containers::StridedArrayView2D<Float>& output) {
-    CORRADE_INTERNAL_ASSERT(actual.size() == output.size());
-    CORRADE_INTERNAL_ASSERT(output.size() == expected.size());
+/* Rows are processed in batches of at least this many pixels, so small
+   images where the thread startup would cost more than the actual work stay
+   on a single thread */
+constexpr std::size_t MinPixelsPerBatch = 65536;
+
+/* Delta of a single pixel, saved to the output even with NaN and ±Inf. The
+   max is updated with the specials filtered out. */
+template<std::size_t size, class T> inline void pixelDelta(const Math::Vector<size, T>& actual, const Math::Vector<size, T>& expected, Float& output, Float& max) {
+    /* Explicitly convert from T to Float */
+    auto actualPixel = Math::Vector<size, Float>(actual);
+    auto expectedPixel = Math::Vector<size, Float>(expected);
+
+    /* First calculate a classic difference */
+    Math::Vector<size, Float> diff = Math::abs(actualPixel - expectedPixel);
+
+    /* Mark pixels that are NaN in both actual and expected pixels as having
+       no difference */
+    diff = Math::lerp(diff, {}, Math::isNan(actualPixel) & Math::isNan(expectedPixel));
+
+    /* Then also mark pixels that are the same sign of infnity in both actual
+       and expected pixel as having no difference */
+    diff = Math::lerp(diff, {}, Math::isInf(actualPixel) & Math::isInf(expectedPixel) & Math::equal(actualPixel, expectedPixel));
+
+    /* Calculate the difference and save it to the output image even with NaN
+       and ±Inf (as the user should know) */
+    output = diff.sum()/size;
+
+    /* On the other hand, infs and NaNs should not contribute to the max
+       delta -- because all other differences would be zero compared to
+       them */
+    max = Math::max(max, Math::lerp(diff, {}, Math::isNan(diff)|Math::isInf(diff)).sum()/size);
+}
 
-    /* Calculate deltas and maximal value of them */
+template<std::size_t size, class T> Float rowDeltaScalar(const Containers::StridedArrayView1D<const Math::Vector<size, T>>& actual, const Containers::StridedArrayView1D<const Math::Vector<size, T>>& expected, const Containers::StridedArrayView1D<Float>& output, const std::size_t begin) {
     Float max{};
-    for(std::size_t i = 0, iMax = expected.size()[0]; i != iMax; ++i) {
-        Containers::StridedArrayView1D<const Math::Vector<size, T>> actualRow = actual[i];
-        Containers::StridedArrayView1D<const Math::Vector<size, T>> expectedRow = expected[i];
-        Containers::StridedArrayView1D<Float> outputRow = output[i];
-
-        for(std::size_t j = 0, jMax = expectedRow.size(); j != jMax; ++j) {
-            /* Explicitly convert from T to Float */
-            auto actualPixel = Math::Vector<size, Float>(actualRow[j]);
-            auto expectedPixel = Math::Vector<size, Float>(expectedRow[j]);
-
-            /* First calculate a classic difference */
-            Math::Vector<size, Float> diff = Math::abs(actualPixel - expectedPixel);
-
-            /* Mark pixels that are NaN in both actual and expected pixels as
-               having no difference */
-            diff = Math::lerp(diff, {}, Math::isNan(actualPixel) & Math::isNan(expectedPixel));
-
-            /* Then also mark pixels that are the same sign of infnity in both
-               actual and expected pixel as having no difference */
-            diff = Math::lerp(diff, {}, Math::isInf(actualPixel) & Math::isInf(expectedPixel) & Math::equal(actualPixel, expectedPixel));
-
-            /* Calculate the difference and save it to the output image even
-               with NaN and ±Inf (as the user should know) */
-            outputRow[j] = diff.sum()/size;
-
-            /* On the other hand, infs and NaNs should not contribute to the
-               max delta -- because all other differences would be zero
-               compared to them */
-            max = Math::max(max, Math::lerp(diff, {}, Math::isNan(diff)|Math::isInf(diff)).sum()/size);
+    for(std::size_t i = begin, iMax = expected.size(); i != iMax; ++i)
+        pixelDelta(actual[i], expected[i], output[i], max);
+    return max;
+}
+
+template<std::size_t size, class T> Float rowDelta(const Containers::StridedArrayView1D<const Math::Vector<size, T>>& actual, const Containers::StridedArrayView1D<const Math::Vector<size, T>>& expected, const Containers::StridedArrayView1D<Float>& output) {
+    return rowDeltaScalar(actual, expected, output, 0);
+}
+
+#ifdef CORRADE_TARGET_SSE2
+/* The SIMD variants process four pixels at a time, with their channels
+   loaded in a planar layout, i.e. each register containing one channel of
+   all four pixels. That way the channel differences can be summed in the
+   same order as Math::Vector::sum() does, giving bit-exact results with the
+   scalar variant above. */
+inline void loadPlanar(const Math::Vector<4, UnsignedByte>* const data, __m128(&out)[4]) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+    const __m128i mask = _mm_set1_epi32(0xff);
+    out[0] = _mm_cvtepi32_ps(_mm_and_si128(v, mask));
+    out[1] = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(v, 8), mask));
+    out[2] = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(v, 16), mask));
+    out[3] = _mm_cvtepi32_ps(_mm_srli_epi32(v, 24));
+}
+
+/* half_to_float_SSE2() from https://gist.github.com/rygorous/2156668, with
+   the half values in the low 16 bits of each lane. Exact for all finite
+   values, thus matching Math::unpackHalf(), unless denormals are flushed to
+   zero. Inf and NaN don't need to match as pixels containing those go
+   through the scalar path. */
+inline __m128 halfToFloat(const __m128i h) {
+    const __m128i expMantissa = _mm_and_si128(h, _mm_set1_epi32(0x7fff));
+    const __m128i sign = _mm_slli_epi32(_mm_xor_si128(h, expMantissa), 16);
+    const __m128 scaled = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(expMantissa, 13)), _mm_castsi128_ps(_mm_set1_epi32((254 - 15) << 23)));
+    const __m128 infNanExp = _mm_and_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(expMantissa, _mm_set1_epi32(0x7bff))), _mm_castsi128_ps(_mm_set1_epi32(255 << 23)));
+    return _mm_or_ps(scaled, _mm_or_ps(_mm_castsi128_ps(sign), infNanExp));
+}
+
+inline void loadPlanar(const Math::Vector<4, Half>* const data, __m128(&out)[4]) {
+    const __m128 a = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data)));
+    const __m128 b = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data) + 1));
+    /* Each pixel is two 32-bit words, the first containing R and G, the
+       second B and A */
+    const __m128i rg = _mm_castps_si128(_mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+    const __m128i ba = _mm_castps_si128(_mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+    const __m128i mask = _mm_set1_epi32(0xffff);
+    out[0] = halfToFloat(_mm_and_si128(rg, mask));
+    out[1] = halfToFloat(_mm_srli_epi32(rg, 16));
+    out[2] = halfToFloat(_mm_and_si128(ba, mask));
+    out[3] = halfToFloat(_mm_srli_epi32(ba, 16));
+}
+
+inline void loadPlanar(const Math::Vector<1, Float>* const data, __m128(&out)[1]) {
+    out[0] = _mm_loadu_ps(reinterpret_cast<const Float*>(data));
+}
+
+template<std::size_t size, class T> Float rowDeltaSse2(const Containers::StridedArrayView1D<const Math::Vector<size, T>>& actual, const Containers::StridedArrayView1D<const Math::Vector<size, T>>& expected, const Containers::StridedArrayView1D<Float>& output) {
+    if(!actual.isContiguous() || !expected.isContiguous() || !output.isContiguous())
+        return rowDeltaScalar(actual, expected, output, 0);
+
+    /* Caching values to avoid inline function calls in debug builds */
+    const Math::Vector<size, T>* const actualData = static_cast<const Math::Vector<size, T>*>(actual.data());
+    const Math::Vector<size, T>* const expectedData = static_cast<const Math::Vector<size, T>*>(expected.data());
+    Float* const outputData = static_cast<Float*>(output.data());
+    const std::size_t count = expected.size();
+
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    const __m128 inf = _mm_castsi128_ps(_mm_set1_epi32(0x7f800000));
+    __m128 max = _mm_setzero_ps();
+    Float scalarMax{};
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4) {
+        __m128 a[size], e[size], diff[size];
+        loadPlanar(actualData + i, a);
+        loadPlanar(expectedData + i, e);
+
+        /* A NaN or an infinity in any of the inputs results in a NaN or an
+           infinity in the difference, the same for an overflow. These need
+           the special handling done by the scalar variant. */
+        __m128 special = _mm_setzero_ps();
+        for(std::size_t c = 0; c != size; ++c) {
+            diff[c] = _mm_and_ps(_mm_sub_ps(a[c], e[c]), absMask);
+            special = _mm_or_ps(special, _mm_or_ps(_mm_cmpunord_ps(diff[c], diff[c]), _mm_cmpeq_ps(diff[c], inf)));
         }
+        if(_mm_movemask_ps(special)) {
+            for(std::size_t j = i; j != i + 4; ++j)
+                pixelDelta(actualData[j], expectedData[j], outputData[j], scalarMax);
+            continue;
+        }
+
+        __m128 sum = diff[0];
+        for(std::size_t c = 1; c != size; ++c)
+            sum = _mm_add_ps(sum, diff[c]);
+        if(size != 1)
+            sum = _mm_div_ps(sum, _mm_set1_ps(Float(size)));
+        _mm_storeu_ps(outputData + i, sum);
+        max = _mm_max_ps(max, sum);
     }
 
+    /* The max is never NaN, so the order in which it's combined doesn't
+       matter */
+    Float maxs[4];
+    _mm_storeu_ps(maxs, max);
+    for(const Float m: maxs)
+        scalarMax = Math::max(scalarMax, m);
+    return Math::max(scalarMax, rowDeltaScalar(actual, expected, output, i));
+}
+
+Float rowDelta(const Containers::StridedArrayView1D<const Math::Vector<4, UnsignedByte>>& actual, const Containers::StridedArrayView1D<const Math::Vector<4, UnsignedByte>>& expected, const Containers::StridedArrayView1D<Float>& output) {
+    return rowDeltaSse2(actual, expected, output);
+}
+
+Float rowDelta(const Containers::StridedArrayView1D<const Math::Vector<4, Half>>& actual, const Containers::StridedArrayView1D<const Math::Vector<4, Half>>& expected, const Containers::StridedArrayView1D<Float>& output) {
+    return rowDeltaSse2(actual, expected, output);
+}
+
+Float rowDelta(const Containers::StridedArrayView1D<const Math::Vector<1, Float>>& actual, const Containers::StridedArrayView1D<const Math::Vector<1, Float>>& expected, const Containers::StridedArrayView1D<Float>& output) {
+    return rowDeltaSse2(actual, expected, output);
+}
+#endif
+
+template<std::size_t size, class T> Float calculateImageDelta(const Containers::StridedArrayView2D<const Math::Vector<size, T>>& actual, const Containers::StridedArrayView2D<const Math::Vector<size, T>>& expected, const Containers::StridedArrayView2D<Float>& output, const UnsignedInt threadCount) {
+    CORRADE_INTERNAL_ASSERT(actual.size() == output.size());
+    CORRADE_INTERNAL_ASSERT(output.size() == expected.size());
+
+    /* Calculate deltas and maximal value of them for each batch of rows.
+       Each pixel is calculated independently and the max doesn't depend on
+       the order, so the result is the same regardless of the thread
+       count. */
+    const std::size_t rowCount = expected.size()[0];
+    const std::size_t rowsPerBatch = Math::max(MinPixelsPerBatch/Math::max(expected.size()[1], std::size_t{1}), std::size_t{1});
+    const std::size_t batchCount = (rowCount + rowsPerBatch - 1)/rowsPerBatch;
+    Containers::Array<Float> batchMax{ValueInit, batchCount};
+    Magnum::Implementation::parallelFor(batchCount, threadCount, [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t i = begin; i < end; ++i) {
+            Float max{};
+            for(std::size_t row = i*rowsPerBatch, rowEnd = Math::min(row + rowsPerBatch, rowCount); row != rowEnd; ++row)
+                max = Math::max(max, rowDelta(actual[row], expected[row], output[row]));
+            batchMax[i] = max;
+        }
+    });
+
+    Float max{};
+    for(const Float i: batchMax)
+        max = Math::max(max, i);
     return max;
 }
 
 }
 
-std::tuple<Containers::Array<Float>, Float, Float> calculateImageDelta(const PixelFormat actualFormat, const Containers::StridedArrayView3D<const char>& actualPixels, const ImageView2D& expected) {
+std::tuple<Containers::Array<Float>, Float, Float> calculateImageDelta(const PixelFormat actualFormat, const Containers::StridedArrayView3D<const char>& actualPixels, const ImageView2D& expected, const UnsignedInt threadCount) {
     /* Calculate a delta image */
     Containers::Array<Float> deltaData{NoInit,
         std::size_t(expected.size().product())};
@@ -119,14 +265,16 @@ std::tuple<Containers::Array<Float>, Float, Float> calculateImageDelta(const Pix
             case PixelFormat::format:                                       \
                 max = calculateImageDelta<size, T>(                         \
                     Containers::arrayCast<2, const Math::Vector<size, T>>(actualPixels), \
-                    expected.pixels<Math::Vector<size, T>>(), delta);       \
+                    expected.pixels<Math::Vector<size, T>>(), delta,        \
+                    threadCount);                                           \
                 break;
         #define _d(first, second, size, T)                                  \
             case PixelFormat::first:                                        \
             case PixelFormat::second:                                       \
                 max = calculateImageDelta<size, T>(                         \
                     Containers::arrayCast<2, const Math::Vector<size, T>>(actualPixels), \
-                    expected.pixels<Math::Vector<size, T>>(), delta);       \
+                    expected.pixels<Math::Vector<size, T>>(), delta,        \
+                    threadCount);                                           \
                 break;
         #define _e(first, second, third, size, T)                           \
             case PixelFormat::first:                                        \
@@ -134,7 +282,8 @@ std::tuple<Containers::Array<Float>, Float, Float> calculateImageDelta(const Pix
             case PixelFormat::third:                                        \
                 max = calculateImageDelta<size, T>(                         \
                     Containers::arrayCast<2, const Math::Vector<size, T>>(actualPixels), \
-                    expected.pixels<Math::Vector<size, T>>(), delta);       \
+                    expected.pixels<Math::Vector<size, T>>(), delta,        \
+                    threadCount);                                           \
                 break;
         #define _f(first, second, third, fourth, size, T)                   \
             case PixelFormat::first:                                        \
@@ -143,7 +292,8 @@ std::tuple<Containers::Array<Float>, Float, Float> calculateImageDelta(const Pix
             case PixelFormat::fourth:                                       \
                 max = calculateImageDelta<size, T>(                         \
                     Containers::arrayCast<2, const Math::Vector<size, T>>(actualPixels), \
-                    expected.pixels<Math::Vector<size, T>>(), delta);       \
+                    expected.pixels<Math::Vector<size, T>>(), delta,        \
+                    threadCount);                                           \
                 break;
         /* LCOV_EXCL_START */
         _f(R8Unorm, R8Srgb, R8UI, Stencil8UI, 1, UnsignedByte)
@@ -201,7 +351,7 @@ std::tuple<Containers::Array<Float>, Float, Float> calculateImageDelta(const Pix
        *deliberately* leaves specials in. The `max` has them already filtered
        out so if this would filter them out as well, there would be nothing
        left that could cause the comparison to fail. */
-    const Float mean = Math::Algorithms::kahanSum(deltaData.begin(), deltaData.end())/deltaData.size();
+    const Float mean = Math::Algorithms::mean(Containers::arrayView(deltaData), threadCount);
 
     return std::make_tuple(std::move(deltaData), max, mean);
 }
@@ -52,11 +52,17 @@ typedef CORRADE_DEPRECATED("use FrameProfilerGL instead") FrameProfilerGL GLFram
 template<UnsignedInt> class ForceRenderer;
 typedef ForceRenderer<2> ForceRenderer2D;
 typedef ForceRenderer<3> ForceRenderer3D;
+template<UnsignedInt> class ForceRendererBatch;
+typedef ForceRendererBatch<2> ForceRendererBatch2D;
+typedef ForceRendererBatch<3> ForceRendererBatch3D;
 class ForceRendererOptions;
 
 template<UnsignedInt> class ObjectRenderer;
 typedef ObjectRenderer<2> ObjectRenderer2D;
 typedef ObjectRenderer<3> ObjectRenderer3D;
+template<UnsignedInt> class ObjectRendererBatch;
+typedef ObjectRendererBatch<2> ObjectRendererBatch2D;
+typedef ObjectRendererBatch<3> ObjectRendererBatch3D;
 class ObjectRendererOptions;
 
 class ResourceManager;
@@ -25,6 +25,9 @@
 
 #include "ForceRenderer.h"
 
+#include <Corrade/Containers/GrowableArray.h>
+
+#include "Magnum/GL/Buffer.h"
 #include "Magnum/GL/Mesh.h"
 #include "Magnum/DebugTools/ResourceManager.h"
 #include "Magnum/SceneGraph/Camera.h"
@@ -40,6 +43,11 @@ template<UnsignedInt dimensions> ResourceKey shaderKey();
 template<> inline ResourceKey shaderKey<2>() { return ResourceKey("FlatShader2D"); }
 template<> inline ResourceKey shaderKey<3>() { return ResourceKey("FlatShader3D"); }
 
+/* Shared with ObjectRendererBatch */
+template<UnsignedInt dimensions> ResourceKey instancedShaderKey();
+template<> inline ResourceKey instancedShaderKey<2>() { return ResourceKey("FlatShaderInstancedVertexColor2D"); }
+template<> inline ResourceKey instancedShaderKey<3>() { return ResourceKey("FlatShaderInstancedVertexColor3D"); }
+
 constexpr Vector2 positions[]{
     {0.0f,  0.0f},
     {1.0f,  0.0f},
@@ -55,6 +63,66 @@ constexpr UnsignedByte indices[]{
 
 }
 
+template<UnsignedInt dimensions> struct ForceRendererBatch<dimensions>::State {
+    struct Instance {
+        MatrixTypeFor<dimensions, Float> transformationMatrix;
+        Color4 color;
+    };
+
+    explicit State();
+
+    GL::Buffer vertexBuffer{GL::Buffer::TargetHint::Array};
+    GL::Buffer indexBuffer{GL::Buffer::TargetHint::ElementArray};
+    GL::Buffer instanceBuffer{GL::Buffer::TargetHint::Array};
+    GL::Mesh mesh{GL::MeshPrimitive::Lines};
+    Containers::Array<Instance> instances;
+};
+
+template<UnsignedInt dimensions> ForceRendererBatch<dimensions>::State::State() {
+    vertexBuffer.setData(positions, GL::BufferUsage::StaticDraw);
+    indexBuffer.setData(indices, GL::BufferUsage::StaticDraw);
+    mesh.setCount(Containers::arraySize(indices))
+        .addVertexBuffer(vertexBuffer, 0,
+            typename Shaders::FlatGL<dimensions>::Position(Shaders::FlatGL<dimensions>::Position::Components::Two))
+        .addVertexBufferInstanced(instanceBuffer, 1, 0,
+            typename Shaders::FlatGL<dimensions>::TransformationMatrix{},
+            typename Shaders::FlatGL<dimensions>::Color4{})
+        .setIndexBuffer(indexBuffer, 0, GL::MeshIndexType::UnsignedByte, 0, Containers::arraySize(positions));
+}
+
+template<UnsignedInt dimensions> ForceRendererBatch<dimensions>::ForceRendererBatch(ResourceManager& manager): _manager(manager), _state{InPlaceInit} {
+    _shader = manager.get<GL::AbstractShaderProgram, Shaders::FlatGL<dimensions>>(instancedShaderKey<dimensions>());
+    if(!_shader) manager.set<GL::AbstractShaderProgram>(_shader.key(), new Shaders::FlatGL<dimensions>{typename Shaders::FlatGL<dimensions>::Configuration{}
+        .setFlags(Shaders::FlatGL<dimensions>::Flag::VertexColor|
+                  Shaders::FlatGL<dimensions>::Flag::InstancedTransformation)});
+}
+
+/* To avoid deleting pointers to incomplete type on destruction of Resource members */
+template<UnsignedInt dimensions> ForceRendererBatch<dimensions>::~ForceRendererBatch() = default;
+
+template<UnsignedInt dimensions> std::size_t ForceRendererBatch<dimensions>::instanceCount() const {
+    return _state->instances.size();
+}
+
+template<UnsignedInt dimensions> ForceRendererBatch<dimensions>& ForceRendererBatch<dimensions>::add(const MatrixTypeFor<dimensions, Float>& transformationMatrix, const Color4& color) {
+    arrayAppend(_state->instances, typename State::Instance{transformationMatrix, color});
+    return *this;
+}
+
+template<UnsignedInt dimensions> void ForceRendererBatch<dimensions>::draw(SceneGraph::Camera<dimensions, Float>& camera) {
+    if(_state->instances.isEmpty()) return;
+
+    _state->instanceBuffer.setData(_state->instances, GL::BufferUsage::StreamDraw);
+    _state->mesh.setInstanceCount(Int(_state->instances.size()));
+    /* The per-instance color is multiplied with the uniform, which is left
+       at the default white */
+    _shader->setTransformationProjectionMatrix(camera.projectionMatrix())
+        .draw(_state->mesh);
+
+    /* Keeps the capacity for the next frame */
+    arrayResize(_state->instances, 0);
+}
+
 template<UnsignedInt dimensions> ForceRenderer<dimensions>::ForceRenderer(ResourceManager& manager, SceneGraph::AbstractObject<dimensions, Float>& object, const VectorTypeFor<dimensions, Float>& forcePosition, const VectorTypeFor<dimensions, Float>& force, ResourceKey options, SceneGraph::DrawableGroup<dimensions, Float>* drawables): SceneGraph::Drawable<dimensions, Float>(object, drawables), _forcePosition(forcePosition), _force(force), _options(manager.get<ForceRendererOptions>(options)) {
     /* Shader */
     _shader = manager.get<GL::AbstractShaderProgram, Shaders::FlatGL<dimensions>>(shaderKey<dimensions>());
@@ -77,15 +145,24 @@ template<UnsignedInt dimensions> ForceRenderer<dimensions>::ForceRenderer(Resour
     manager.set(_mesh.key(), std::move(mesh), ResourceDataState::Final, ResourcePolicy::Manual);
 }
 
+template<UnsignedInt dimensions> ForceRenderer<dimensions>::ForceRenderer(ForceRendererBatch<dimensions>& batch, SceneGraph::AbstractObject<dimensions, Float>& object, const VectorTypeFor<dimensions, Float>& forcePosition, const VectorTypeFor<dimensions, Float>& force, ResourceKey options, SceneGraph::DrawableGroup<dimensions, Float>* drawables): SceneGraph::Drawable<dimensions, Float>(object, drawables), _forcePosition(forcePosition), _force(force), _options(batch._manager.get<ForceRendererOptions>(options)), _batch{&batch} {}
+
 /* To avoid deleting pointers to incomplete type on destruction of Resource members */
 template<UnsignedInt dimensions> ForceRenderer<dimensions>::~ForceRenderer() = default;
 
 template<UnsignedInt dimensions> void ForceRenderer<dimensions>::draw(const MatrixTypeFor<dimensions, Float>& transformationMatrix, SceneGraph::Camera<dimensions, Float>& camera) {
+    if(_batch) {
+        _batch->add(Implementation::forceRendererTransformation<dimensions>(transformationMatrix.transformPoint(_forcePosition), _force)*MatrixTypeFor<dimensions, Float>::scaling(VectorTypeFor<dimensions, Float>{_options->size()}), _options->color());
+        return;
+    }
+
     _shader->setTransformationProjectionMatrix(camera.projectionMatrix()*Implementation::forceRendererTransformation<dimensions>(transformationMatrix.transformPoint(_forcePosition), _force)*MatrixTypeFor<dimensions, Float>::scaling(VectorTypeFor<dimensions, Float>{_options->size()}))
         .setColor(_options->color())
         .draw(*_mesh);
 }
 
+template class MAGNUM_DEBUGTOOLS_EXPORT ForceRendererBatch<2>;
+template class MAGNUM_DEBUGTOOLS_EXPORT ForceRendererBatch<3>;
 template class MAGNUM_DEBUGTOOLS_EXPORT ForceRenderer<2>;
 template class MAGNUM_DEBUGTOOLS_EXPORT ForceRenderer<3>;
 
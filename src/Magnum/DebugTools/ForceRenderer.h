@@ -27,10 +27,12 @@
 
 #ifdef MAGNUM_TARGET_GL
 /** @file
- * @brief Class @ref Magnum::DebugTools::ForceRenderer, @ref Magnum::DebugTools::ForceRendererOptions, typedef @ref Magnum::DebugTools::ForceRenderer2D, @ref Magnum::DebugTools::ForceRenderer3D
+ * @brief Class @ref Magnum::DebugTools::ForceRenderer, @ref Magnum::DebugTools::ForceRendererBatch, @ref Magnum::DebugTools::ForceRendererOptions, typedef @ref Magnum::DebugTools::ForceRenderer2D, @ref Magnum::DebugTools::ForceRenderer3D, @ref Magnum::DebugTools::ForceRendererBatch2D, @ref Magnum::DebugTools::ForceRendererBatch3D
  */
 #endif
 
+#include <Corrade/Containers/Pointer.h>
+
 #include "Magnum/Resource.h"
 #include "Magnum/DebugTools/DebugTools.h"
 #include "Magnum/DebugTools/visibility.h"
@@ -96,6 +98,103 @@ class ForceRendererOptions {
         Float _size;
 };
 
+/**
+@brief Batch for instanced force rendering
+@m_since_latest
+
+Collects transformations and colors of all @ref ForceRenderer instances
+constructed with it and draws them all with a single instanced draw call in
+@ref draw(). See @ref DebugTools-ForceRenderer-batching for more information.
+
+@note This class is available only if Magnum is compiled with
+    @ref MAGNUM_TARGET_GL "TARGET_GL" and `MAGNUM_WITH_SCENEGRAPH` enabled
+    (done by default). See @ref building-features for more information.
+
+@requires_gl33 Extension @gl_extension{ARB,instanced_arrays}
+@requires_gles30 Extension @gl_extension{ANGLE,instanced_arrays},
+    @gl_extension{EXT,instanced_arrays} or @gl_extension{NV,instanced_arrays}
+    in OpenGL ES 2.0.
+@requires_webgl20 Extension @webgl_extension{ANGLE,instanced_arrays} in WebGL
+    1.0.
+
+@see @ref ForceRendererBatch2D, @ref ForceRendererBatch3D
+*/
+template<UnsignedInt dimensions> class ForceRendererBatch {
+    public:
+        /**
+         * @brief Constructor
+         * @param manager   Resource manager instance
+         *
+         * Creates the instance buffer and a mesh referencing it. The shader
+         * is shared with other batches through @p manager, options of
+         * renderers added to this batch are taken from @p manager as well.
+         */
+        explicit ForceRendererBatch(ResourceManager& manager);
+
+        /** @brief Copying is not allowed */
+        ForceRendererBatch(const ForceRendererBatch<dimensions>&) = delete;
+
+        /**
+         * @brief Moving is not allowed
+         *
+         * Renderers constructed with the batch reference it.
+         */
+        ForceRendererBatch(ForceRendererBatch<dimensions>&&) = delete;
+
+        ~ForceRendererBatch();
+
+        /** @brief Copying is not allowed */
+        ForceRendererBatch<dimensions>& operator=(const ForceRendererBatch<dimensions>&) = delete;
+
+        /** @brief Moving is not allowed */
+        ForceRendererBatch<dimensions>& operator=(ForceRendererBatch<dimensions>&&) = delete;
+
+        /** @brief Count of instances collected since last @ref draw() */
+        std::size_t instanceCount() const;
+
+        /**
+         * @brief Add an instance
+         * @return Reference to self (for method chaining)
+         *
+         * Called from @ref ForceRenderer with a camera-relative
+         * transformation of the arrow that includes its size, but can be used
+         * to add arrows that aren't attached to any object as well.
+         */
+        ForceRendererBatch<dimensions>& add(const MatrixTypeFor<dimensions, Float>& transformationMatrix, const Color4& color);
+
+        /**
+         * @brief Draw all collected instances
+         *
+         * Uploads the transformations and colors collected since the last
+         * call to the instance buffer and draws them with a single call using
+         * projection matrix of @p camera. The collected instances are
+         * cleared afterwards. If there are no instances, the function is a
+         * no-op.
+         */
+        void draw(SceneGraph::Camera<dimensions, Float>& camera);
+
+    private:
+        friend ForceRenderer<dimensions>;
+
+        struct State;
+
+        ResourceManager& _manager;
+        Resource<GL::AbstractShaderProgram, Shaders::FlatGL<dimensions>> _shader;
+        Containers::Pointer<State> _state;
+};
+
+/**
+@brief Two-dimensional force renderer batch
+@m_since_latest
+*/
+typedef ForceRendererBatch<2> ForceRendererBatch2D;
+
+/**
+@brief Three-dimensional force renderer batch
+@m_since_latest
+*/
+typedef ForceRendererBatch<3> ForceRendererBatch3D;
+
 /**
 @brief Force renderer
 
@@ -112,11 +211,22 @@ to it.
 
 @snippet MagnumDebugTools-gl.cpp ForceRenderer
 
+@section DebugTools-ForceRenderer-batching Batched rendering
+
+Similarly to @ref DebugTools-ObjectRenderer-batching "ObjectRenderer", the
+renderers can be constructed with a @ref ForceRendererBatch, in which case
+they only record the arrow transformation and color, and the whole batch is
+drawn with a single instanced draw using @ref ForceRendererBatch::draw() after
+the @ref SceneGraph::Camera::draw() call:
+
+@snippet MagnumDebugTools-gl.cpp ForceRenderer-batch
+
 @note This class is available only if Magnum is compiled with
     @ref MAGNUM_TARGET_GL "TARGET_GL" and `MAGNUM_WITH_SCENEGRAPH` enabled
     (done by default). See @ref building-features for more information.
 
-@see @ref ForceRenderer2D, @ref ForceRenderer3D, @ref ForceRendererOptions
+@see @ref ForceRenderer2D, @ref ForceRenderer3D, @ref ForceRendererOptions,
+    @ref ForceRendererBatch
 */
 template<UnsignedInt dimensions> class ForceRenderer: public SceneGraph::Drawable<dimensions, Float> {
     public:
@@ -139,6 +249,31 @@ template<UnsignedInt dimensions> class ForceRenderer: public SceneGraph::Drawabl
          */
         explicit ForceRenderer(ResourceManager&, SceneGraph::AbstractObject<dimensions, Float>&, const VectorTypeFor<dimensions, Float>&, VectorTypeFor<dimensions, Float>&&, ResourceKey = ResourceKey(), SceneGraph::DrawableGroup<dimensions, Float>* = nullptr) = delete;
 
+        /**
+         * @brief Construct a batched renderer
+         * @param batch         Batch to add the force to
+         * @param object        Object for which to create debug renderer
+         * @param forcePosition Where to render the force, relative to object
+         * @param force         Reference to the force vector
+         * @param options       Options resource key, taken from the resource
+         *      manager the @p batch was constructed with
+         * @param drawables     Drawable group
+         * @m_since_latest
+         *
+         * Instead of drawing, the renderer adds the arrow transformation and
+         * color to @p batch, which is then drawn with
+         * @ref ForceRendererBatch::draw(). The batch is expected to outlive
+         * the renderer. See @ref DebugTools-ForceRenderer-batching for more
+         * information.
+         */
+        explicit ForceRenderer(ForceRendererBatch<dimensions>& batch, SceneGraph::AbstractObject<dimensions, Float>& object, const VectorTypeFor<dimensions, Float>& forcePosition, const VectorTypeFor<dimensions, Float>& force, ResourceKey options = ResourceKey(), SceneGraph::DrawableGroup<dimensions, Float>* drawables = nullptr);
+
+        /**
+         * You have to pass a reference to an external force vector --- the
+         * renderer doesn't store a copy.
+         */
+        explicit ForceRenderer(ForceRendererBatch<dimensions>&, SceneGraph::AbstractObject<dimensions, Float>&, const VectorTypeFor<dimensions, Float>&, VectorTypeFor<dimensions, Float>&&, ResourceKey = ResourceKey(), SceneGraph::DrawableGroup<dimensions, Float>* = nullptr) = delete;
+
         #ifdef MAGNUM_BUILD_DEPRECATED
         /**
          * @brief Constructor
@@ -164,6 +299,7 @@ template<UnsignedInt dimensions> class ForceRenderer: public SceneGraph::Drawabl
         Resource<ForceRendererOptions> _options;
         Resource<GL::AbstractShaderProgram, Shaders::FlatGL<dimensions>> _shader;
         Resource<GL::Mesh> _mesh;
+        ForceRendererBatch<dimensions>* _batch{};
 };
 
 /** @brief Two-dimensional force renderer */
@@ -31,17 +31,31 @@
 #include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/StaticArray.h>
 #include <Corrade/Containers/String.h>
+#include <Corrade/Containers/StringStl.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Format.h>
+#include <Corrade/Utility/FormatStl.h>
+#include <Corrade/Utility/Path.h>
 #include <Corrade/Utility/String.h>
 
+#include "Magnum/ProfileScope.h"
 #include "Magnum/Math/Functions.h"
 #ifdef MAGNUM_TARGET_GL
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/MemoryUsage.h"
 #include "Magnum/GL/TimeQuery.h"
+#include "Magnum/GL/TimerQueryPool.h"
 #ifndef MAGNUM_TARGET_GLES
 #include "Magnum/GL/PipelineStatisticsQuery.h"
 #endif
 #endif
+#ifdef MAGNUM_TARGET_VK
+#include "Magnum/Vk/CommandBuffer.h"
+#include "Magnum/Vk/Device.h"
+#include "Magnum/Vk/DeviceProperties.h"
+#include "Magnum/Vk/Pipeline.h"
+#include "Magnum/Vk/QueryPoolCreateInfo.h"
+#endif
 
 namespace Magnum { namespace DebugTools {
 
@@ -57,6 +71,167 @@ FrameProfiler::Measurement::Measurement(const std::string& name, const Units uni
     _query.delayed = query;
 }
 
+struct FrameProfiler::Trace {
+    struct Measurement {
+        std::string name;
+        Units units;
+    };
+
+    struct Frame {
+        UnsignedLong begin, end;
+    };
+
+    struct Value {
+        UnsignedInt frame, measurement;
+        UnsignedLong value;
+    };
+
+    struct Scope {
+        UnsignedInt name;
+        std::size_t thread;
+        UnsignedLong begin, end;
+    };
+
+    UnsignedInt intern(const std::string& name) {
+        for(UnsignedInt i = 0; i != names.size(); ++i)
+            if(names[i] == name) return i;
+        arrayAppend(names, name);
+        return names.size() - 1;
+    }
+
+    bool active;
+    /* Zero if unlimited */
+    UnsignedInt maxFrameCount;
+    UnsignedLong start, frameBegin;
+    /* Snapshot of measurements at the time the trace was started, so the
+       trace can be exported even after setup() replaced them */
+    Containers::Array<Measurement> measurements;
+    Containers::Array<Frame> frames;
+    Containers::Array<Value> values;
+    /* Scope names, deduplicated so each scope doesn't need to store a copy.
+       Not referencing Scopes::Node as those get discarded in resetScopes(). */
+    Containers::Array<std::string> names;
+    Containers::Array<Scope> scopes;
+};
+
+struct FrameProfiler::Scopes {
+    struct Node {
+        /* A copy, as the nodes are kept for the whole profiler lifetime */
+        std::string name;
+        UnsignedInt parent, depth;
+        /* Index into Trace::names, ~UnsignedInt{} if not used in the current
+           trace yet */
+        UnsignedInt traceName;
+        /* Accumulated for the current frame */
+        UnsignedLong frameDuration;
+        UnsignedLong frameCallCount;
+        /* Moving sums and per-frame history of the above. Nodes added later
+           have zeros for the frames before, which is what the history
+           would contain if they were there from the start. */
+        UnsignedLong movingDurationSum;
+        UnsignedLong movingCallCountSum;
+        Containers::Array<UnsignedLong> durations;
+        Containers::Array<UnsignedLong> callCounts;
+    };
+
+    struct Open {
+        UnsignedInt node;
+        UnsignedLong begin;
+    };
+
+    struct Thread {
+        std::size_t id;
+        Containers::Array<Open> open;
+    };
+
+    UnsignedInt maxFrameCount;
+    /* In order of first appearance, which means a parent is always before
+       its children */
+    Containers::Array<Node> nodes;
+    /* Only threads with scopes open at the time of the last consumption are
+       kept */
+    Containers::Array<Thread> threads;
+    /* Node indices in depth-first order, updated whenever new nodes get
+       added */
+    Containers::Array<UnsignedInt> order;
+    /* Count of scope lines printed by the last printStatistics(), the tree
+       can grow between the calls so it can't be derived from current
+       state */
+    mutable UnsignedInt printedLineCount;
+    /* Non-null if a trace is being captured */
+    Trace* trace;
+
+    static void consume(void* state, std::size_t threadId, const Implementation::ProfileScopeEvent* events, std::size_t count);
+    void updateOrder(UnsignedInt parent);
+};
+
+void FrameProfiler::Scopes::consume(void* const state, const std::size_t threadId, const Implementation::ProfileScopeEvent* const events, const std::size_t count) {
+    Scopes& scopes = *static_cast<Scopes*>(state);
+
+    Thread* thread = nullptr;
+    for(Thread& i: scopes.threads) if(i.id == threadId) {
+        thread = &i;
+        break;
+    }
+    if(!thread) thread = &arrayAppend(scopes.threads, Thread{threadId, {}});
+
+    for(std::size_t i = 0; i != count; ++i) {
+        const Implementation::ProfileScopeEvent& event = events[i];
+
+        /* Scope end. If there's no open scope, its begin was discarded in
+           resetScopes(), ignore it. */
+        if(!event.name) {
+            if(thread->open.empty()) continue;
+
+            const Open& open = thread->open.back();
+            Node& node = scopes.nodes[open.node];
+            node.frameDuration += event.time - open.begin;
+            ++node.frameCallCount;
+
+            /* Scopes that ended before the trace was started are not
+               included in it */
+            if(scopes.trace && event.time >= scopes.trace->start) {
+                if(node.traceName == ~UnsignedInt{})
+                    node.traceName = scopes.trace->intern(node.name);
+                arrayAppend(scopes.trace->scopes, Trace::Scope{node.traceName, threadId, open.begin, event.time});
+            }
+
+            arrayRemoveSuffix(thread->open);
+            continue;
+        }
+
+        /* Scope begin, find a node with the same name under the same parent
+           or add a new one */
+        const UnsignedInt parent = thread->open.empty() ? ~UnsignedInt{} : thread->open.back().node;
+        UnsignedInt node = 0;
+        for(; node != scopes.nodes.size(); ++node)
+            if(scopes.nodes[node].parent == parent && scopes.nodes[node].name == event.name) break;
+        if(node == scopes.nodes.size()) arrayAppend(scopes.nodes, Node{
+            event.name, parent,
+            parent == ~UnsignedInt{} ? 0 : scopes.nodes[parent].depth + 1,
+            ~UnsignedInt{},
+            0, 0, 0, 0,
+            Containers::Array<UnsignedLong>{ValueInit, scopes.maxFrameCount},
+            Containers::Array<UnsignedLong>{ValueInit, scopes.maxFrameCount}});
+
+        arrayAppend(thread->open, Open{node, event.time});
+    }
+}
+
+void FrameProfiler::Scopes::updateOrder(const UnsignedInt parent) {
+    for(UnsignedInt i = 0; i != nodes.size(); ++i) {
+        if(nodes[i].parent != parent) continue;
+        arrayAppend(order, i);
+        updateOrder(i);
+    }
+}
+
+namespace {
+
+void discardScopes(void*, std::size_t, const Implementation::ProfileScopeEvent*, std::size_t) {}
+
+}
+
 FrameProfiler::FrameProfiler() noexcept = default;
 
 FrameProfiler::FrameProfiler(Containers::Array<Measurement>&& measurements, UnsignedInt maxFrameCount) noexcept {
@@ -73,7 +248,9 @@ FrameProfiler::FrameProfiler(FrameProfiler&& other) noexcept:
     _maxFrameCount{other._maxFrameCount},
     _measuredFrameCount{other._measuredFrameCount},
     _measurements{std::move(other._measurements)},
-    _data{std::move(other._data)}
+    _data{std::move(other._data)},
+    _scopes{std::move(other._scopes)},
+    _trace{std::move(other._trace)}
 {
     /* For all state pointers that point to &other patch them to point to this
        instead, to account for 90% of use cases of derived classes */
@@ -91,6 +268,8 @@ FrameProfiler& FrameProfiler::operator=(FrameProfiler&& other) noexcept {
     swap(_measuredFrameCount, other._measuredFrameCount);
     swap(_measurements, other._measurements);
     swap(_data, other._data);
+    swap(_scopes, other._scopes);
+    swap(_trace, other._trace);
 
     /* For all state pointers that point to &other patch them to point to this
        instead, to account for 90% of use cases of derived classes */
@@ -105,9 +284,17 @@ FrameProfiler& FrameProfiler::operator=(FrameProfiler&& other) noexcept {
     return *this;
 }
 
+FrameProfiler::~FrameProfiler() {
+    disableScopes();
+}
+
 void FrameProfiler::setup(Containers::Array<Measurement>&& measurements, const UnsignedInt maxFrameCount) {
     CORRADE_ASSERT(maxFrameCount >= 1, "DebugTools::FrameProfiler::setup(): max frame count can't be zero", );
 
+    /* The trace refers to measurements by their index, so it can't continue
+       with a different set */
+    stopTrace();
+
     _maxFrameCount = maxFrameCount;
     _measurements = std::move(measurements);
     arrayReserve(_data, maxFrameCount*_measurements.size());
@@ -145,12 +332,43 @@ void FrameProfiler::enable() {
         measurement._movingSum = 0;
         measurement._current = 0;
     }
+
+    if(_scopes) resetScopes();
 }
 
 void FrameProfiler::disable() {
     _enabled = false;
 }
 
+void FrameProfiler::enableScopes() {
+    if(!_scopes) {
+        _scopes.emplace();
+        _scopes->printedLineCount = 0;
+        _scopes->trace = isTracing() ? _trace.get() : nullptr;
+        Implementation::profileScopeAcquire();
+    }
+
+    resetScopes();
+}
+
+void FrameProfiler::disableScopes() {
+    if(!_scopes) return;
+
+    Implementation::profileScopeRelease();
+    _scopes = nullptr;
+}
+
+void FrameProfiler::resetScopes() {
+    /* Throw away everything recorded so far. Scopes that are currently open
+       will have their end events ignored as there's nothing to pair them
+       with. */
+    Implementation::profileScopeConsume(discardScopes, nullptr);
+    _scopes->maxFrameCount = _maxFrameCount;
+    _scopes->nodes = {};
+    _scopes->threads = {};
+    _scopes->order = {};
+}
+
 void FrameProfiler::beginFrame() {
     if(!_enabled) return;
 
@@ -159,6 +377,9 @@ void FrameProfiler::beginFrame() {
     _beginFrameCalled = true;
     #endif
 
+    if(isTracing())
+        _trace->frameBegin = Implementation::profileScopeTime();
+
     /* For all measurements call the begin function */
     for(const Measurement& measurement: _measurements) {
         if(!measurement._delay)
@@ -181,6 +402,11 @@ void FrameProfiler::endFrame() {
     _beginFrameCalled = false;
     #endif
 
+    /* Record the frame before querying the measurements so the query
+       overhead isn't included */
+    if(isTracing())
+        arrayAppend(_trace->frames, Trace::Frame{_trace->frameBegin, Implementation::profileScopeTime()});
+
     /* If we don't have all frames yet, enlarge the array */
     if(++_measuredFrameCount <= _maxFrameCount)
         arrayAppend(_data, NoInit, _measurements.size());
@@ -235,8 +461,53 @@ void FrameProfiler::endFrame() {
             const UnsignedLong data = _data[delayedCurrentData(measurementDelay)*_measurements.size() + i];
             CORRADE_INTERNAL_ASSERT(_measurements[i]._movingSum + data >= _measurements[i]._movingSum);
             _measurements[i]._movingSum += data;
+
+            /* The data are for a frame that's (delay - 1) frames before the
+               one just recorded. If the trace was started later, skip them. */
+            if(isTracing() && _trace->frames.size() >= measurementDelay)
+                arrayAppend(_trace->values, Trace::Value{UnsignedInt(_trace->frames.size() - measurementDelay), UnsignedInt(i), data});
         }
     }
+
+    /* Aggregate scopes that ended since the last frame and save the totals
+       into the history, replacing the oldest frame if wrapping around */
+    if(_scopes) {
+        Implementation::profileScopeConsume(Scopes::consume, _scopes.get());
+        if(_scopes->order.size() != _scopes->nodes.size()) {
+            arrayResize(_scopes->order, 0);
+            _scopes->updateOrder(~UnsignedInt{});
+        }
+
+        const UnsignedInt current = (_measuredFrameCount - 1) % _maxFrameCount;
+        for(Scopes::Node& node: _scopes->nodes) {
+            if(_measuredFrameCount > _maxFrameCount) {
+                node.movingDurationSum -= node.durations[current];
+                node.movingCallCountSum -= node.callCounts[current];
+            }
+
+            node.durations[current] = node.frameDuration;
+            node.callCounts[current] = node.frameCallCount;
+            node.movingDurationSum += node.frameDuration;
+            node.movingCallCountSum += node.frameCallCount;
+            node.frameDuration = 0;
+            node.frameCallCount = 0;
+        }
+
+        /* Forget threads that have nothing open, their ID won't be reused
+           and if they record anything new, they get added again */
+        std::size_t out = 0;
+        for(std::size_t i = 0; i != _scopes->threads.size(); ++i) {
+            if(_scopes->threads[i].open.empty()) continue;
+            if(out != i) _scopes->threads[out] = std::move(_scopes->threads[i]);
+            ++out;
+        }
+        arrayRemoveSuffix(_scopes->threads, _scopes->threads.size() - out);
+    }
+
+    /* Stop the trace if it has all frames it wanted. Done only after the
+       scopes are consumed so the last frame has them as well. */
+    if(isTracing() && _trace->maxFrameCount && _trace->frames.size() >= _trace->maxFrameCount)
+        stopTrace();
 }
 
 std::string FrameProfiler::measurementName(const UnsignedInt id) const {
@@ -282,6 +553,180 @@ Double FrameProfiler::measurementMeanInternal(const Measurement& measurement) co
         Math::min(_measuredFrameCount - Math::max(measurement._delay, 1u) + 1, _maxFrameCount);
 }
 
+UnsignedInt FrameProfiler::scopeCount() const {
+    return _scopes ? _scopes->order.size() : 0;
+}
+
+std::string FrameProfiler::scopeName(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < scopeCount(),
+        "DebugTools::FrameProfiler::scopeName(): index" << id << "out of range for" << scopeCount() << "scopes", {});
+    return _scopes->nodes[_scopes->order[id]].name;
+}
+
+UnsignedInt FrameProfiler::scopeDepth(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < scopeCount(),
+        "DebugTools::FrameProfiler::scopeDepth(): index" << id << "out of range for" << scopeCount() << "scopes", {});
+    return _scopes->nodes[_scopes->order[id]].depth;
+}
+
+Double FrameProfiler::scopeDurationMean(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < scopeCount(),
+        "DebugTools::FrameProfiler::scopeDurationMean(): index" << id << "out of range for" << scopeCount() << "scopes", {});
+    /* Nodes are added only in endFrame(), so there's always at least one
+       frame measured */
+    return Double(_scopes->nodes[_scopes->order[id]].movingDurationSum)/
+        Math::min(_measuredFrameCount, _maxFrameCount);
+}
+
+Double FrameProfiler::scopeCallCountMean(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < scopeCount(),
+        "DebugTools::FrameProfiler::scopeCallCountMean(): index" << id << "out of range for" << scopeCount() << "scopes", {});
+    return Double(_scopes->nodes[_scopes->order[id]].movingCallCountSum)/
+        Math::min(_measuredFrameCount, _maxFrameCount);
+}
+
+bool FrameProfiler::isTracing() const {
+    return _trace && _trace->active;
+}
+
+void FrameProfiler::startTrace(const UnsignedInt frameCount) {
+    if(!_trace) _trace.emplace();
+
+    Trace& trace = *_trace;
+    trace.active = true;
+    trace.maxFrameCount = frameCount;
+    trace.start = trace.frameBegin = Implementation::profileScopeTime();
+    trace.measurements = Containers::Array<Trace::Measurement>{_measurements.size()};
+    for(std::size_t i = 0; i != _measurements.size(); ++i)
+        trace.measurements[i] = Trace::Measurement{_measurements[i]._name, _measurements[i]._units};
+    trace.frames = {};
+    trace.values = {};
+    trace.names = {};
+    trace.scopes = {};
+
+    if(_scopes) {
+        _scopes->trace = &trace;
+        for(Scopes::Node& node: _scopes->nodes)
+            node.traceName = ~UnsignedInt{};
+    }
+}
+
+void FrameProfiler::stopTrace() {
+    if(!isTracing()) return;
+
+    _trace->active = false;
+    if(_scopes) _scopes->trace = nullptr;
+}
+
+UnsignedInt FrameProfiler::traceFrameCount() const {
+    return _trace ? _trace->frames.size() : 0;
+}
+
+namespace {
+
+/* Only the quote, backslash and control characters need escaping in JSON */
+void appendJsonString(std::string& out, const std::string& string) {
+    out += '"';
+    for(const char c: string) {
+        if(c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if(UnsignedByte(c) < 0x20)
+            out += Utility::formatString("\\u{:.4x}", UnsignedInt(UnsignedByte(c)));
+        else out += c;
+    }
+    out += '"';
+}
+
+}
+
+std::string FrameProfiler::traceJson() const {
+    std::string out = "{\"traceEvents\":[";
+    if(!_trace) return out + "]}";
+
+    const Trace& trace = *_trace;
+
+    /* Times are relative to the trace start, in microseconds. Scopes that
+       began before the trace start get clamped. */
+    const auto time = [&](const UnsignedLong value) {
+        return Double(Math::max(value, trace.start) - trace.start)/1000.0;
+    };
+
+    /* Track names. Frames are on track 0, each measurement in nanoseconds
+       on a track after, followed by one track for each thread that
+       recorded any scope. */
+    bool first = true;
+    const auto track = [&](const std::size_t id, const std::string& name) {
+        if(!first) out += ',';
+        first = false;
+        out += Utility::formatString("\n{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":{},\"args\":{{\"name\":", id);
+        appendJsonString(out, name);
+        out += "}}";
+    };
+    track(0, "Frames");
+    for(std::size_t i = 0; i != trace.measurements.size(); ++i)
+        if(trace.measurements[i].units == Units::Nanoseconds)
+            track(1 + i, trace.measurements[i].name);
+    const std::size_t threadTrackOffset = 1 + trace.measurements.size();
+    Containers::Array<std::size_t> threads;
+    for(const Trace::Scope& scope: trace.scopes) {
+        bool found = false;
+        for(const std::size_t thread: threads) if(thread == scope.thread) {
+            found = true;
+            break;
+        }
+        if(found) continue;
+        arrayAppend(threads, scope.thread);
+        track(threadTrackOffset + scope.thread, Utility::formatString("Thread {}", scope.thread));
+    }
+
+    /* Frames */
+    for(std::size_t i = 0; i != trace.frames.size(); ++i) {
+        const Trace::Frame& frame = trace.frames[i];
+        out += Utility::formatString(",\n{{\"name\":\"Frame {}\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":{:.3f},\"dur\":{:.3f}}}", i, time(frame.begin), Double(frame.end - frame.begin)/1000.0);
+    }
+
+    /* Measurements, durations as slices starting at the frame begin, the
+       rest as counters */
+    for(const Trace::Value& value: trace.values) {
+        const Trace::Measurement& measurement = trace.measurements[value.measurement];
+        const Double ts = time(trace.frames[value.frame].begin);
+        out += ",\n{\"name\":";
+        appendJsonString(out, measurement.name);
+
+        if(measurement.units == Units::Nanoseconds) {
+            out += Utility::formatString(",\"ph\":\"X\",\"pid\":0,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}", 1 + value.measurement, ts, Double(value.value)/1000.0);
+            continue;
+        }
+
+        Double counter = Double(value.value);
+        if(measurement.units == Units::RatioThousandths ||
+           measurement.units == Units::PercentageThousandths)
+            counter /= 1000.0;
+        out += Utility::formatString(",\"ph\":\"C\",\"pid\":0,\"ts\":{:.3f},\"args\":{{\"value\":{}}}}}", ts, counter);
+    }
+
+    /* Scopes */
+    for(const Trace::Scope& scope: trace.scopes) {
+        out += ",\n{\"name\":";
+        appendJsonString(out, trace.names[scope.name]);
+        out += Utility::formatString(",\"ph\":\"X\",\"pid\":0,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}", threadTrackOffset + scope.thread, time(scope.begin), Double(scope.end - Math::max(scope.begin, trace.start))/1000.0);
+    }
+
+    out += "\n]}";
+    return out;
+}
+
+bool FrameProfiler::saveTrace(const Containers::StringView filename) const {
+    const std::string json = traceJson();
+    if(!Utility::Path::write(filename, Containers::arrayView(json.data(), json.size()))) {
+        Error{} << "DebugTools::FrameProfiler::saveTrace(): cannot write to file" << filename;
+        return false;
+    }
+
+    return true;
+}
+
 Double FrameProfiler::measurementMean(const UnsignedInt id) const {
     CORRADE_ASSERT(id < _measurements.size(),
         "DebugTools::FrameProfiler::measurementMean(): index" << id << "out of range for" << _measurements.size() << "measurements", {});
@@ -382,6 +827,23 @@ void FrameProfiler::printStatisticsInternal(Debug& out) const {
             CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
         }
     }
+
+    if(!_scopes) return;
+
+    out << Debug::newline << " " << Debug::boldColor(Debug::Color::Default)
+        << "Scopes:" << Debug::resetColor;
+
+    /* Indent each level by two more spaces */
+    for(std::size_t i = 0; i != _scopes->order.size(); ++i) {
+        const Scopes::Node& node = _scopes->nodes[_scopes->order[i]];
+        out << Debug::newline << std::string(2*node.depth + 3, ' ')
+            << Debug::boldColor(Debug::Color::Default)
+            << node.name << Debug::nospace << ":" << Debug::resetColor;
+        printTime(out, scopeDurationMean(i));
+        out << "(" << Debug::nospace;
+        printCount(out, scopeCallCountMean(i), 1000.0, "");
+        out << "calls)";
+    }
 }
 
 std::string FrameProfiler::statistics() const {
@@ -404,10 +866,11 @@ void FrameProfiler::printStatistics(Debug& out, const UnsignedInt frequency) con
        overwrite previous output */
     if(out.isTty() && _measuredFrameCount > frequency)
         out << Debug::nospace << "\033[" << Debug::nospace
-            << _measurements.size() + 1 << Debug::nospace << "A\033[J"
+            << _measurements.size() + 1 + (_scopes ? _scopes->printedLineCount : 0) << Debug::nospace << "A\033[J"
             << Debug::nospace;
 
     printStatisticsInternal(out);
+    if(_scopes) _scopes->printedLineCount = _scopes->order.size() + 1;
 
     /* Unconditionally finish with a newline so the TTY scrollback works
        correctly */
@@ -673,6 +1136,360 @@ Debug& operator<<(Debug& debug, const FrameProfilerGL::Values value) {
         #endif
         });
 }
+
+FrameProfiler::Measurement timerQueryPoolMeasurement(GL::TimerQueryPool& pool, const Containers::StringView scope) {
+    /* The durations array is allocated upfront and never reallocated, so
+       it's safe to reference its items directly. Graceful assert in
+       addScope() returns ~0, fall back to an always-zero value. */
+    const UnsignedInt id = pool.addScope(scope);
+    static const UnsignedLong zero = 0;
+    const UnsignedLong* const duration = id < pool.durations().size() ? &pool.durations()[id] : &zero;
+    return FrameProfiler::Measurement{scope, FrameProfiler::Units::Nanoseconds,
+        [](void*) {},
+        [](void* state) {
+            return *static_cast<const UnsignedLong*>(state);
+        }, const_cast<UnsignedLong*>(duration)};
+}
+
+FrameProfiler::Measurement memoryUsageMeasurement() {
+    GL::MemoryUsage::setTrackingEnabled(true);
+    return FrameProfiler::Measurement{"GPU memory", FrameProfiler::Units::Bytes,
+        [](void*) {},
+        [](void*) {
+            return UnsignedLong(GL::MemoryUsage::total());
+        }, nullptr};
+}
+
+FrameProfiler::Measurement memoryUsageMeasurement(const GL::MemoryUsageCategory category) {
+    const char* name = nullptr;
+    switch(category) {
+        case GL::MemoryUsageCategory::Buffer:
+            name = "GPU buffer memory";
+            break;
+        case GL::MemoryUsageCategory::Texture:
+            name = "GPU texture memory";
+            break;
+        case GL::MemoryUsageCategory::Renderbuffer:
+            name = "GPU renderbuffer memory";
+            break;
+    }
+    CORRADE_INTERNAL_ASSERT(name);
+
+    GL::MemoryUsage::setTrackingEnabled(true);
+    /* The category is stashed directly in the state pointer */
+    return FrameProfiler::Measurement{name, FrameProfiler::Units::Bytes,
+        [](void*) {},
+        [](void* state) {
+            return UnsignedLong(GL::MemoryUsage::total(GL::MemoryUsageCategory(reinterpret_cast<std::uintptr_t>(state))));
+        }, reinterpret_cast<void*>(std::uintptr_t(category))};
+}
+
+FrameProfiler::Measurement contextCounterMeasurement(const GL::ContextCounter counter) {
+    const char* name = nullptr;
+    FrameProfiler::Units units = FrameProfiler::Units::Count;
+    switch(counter) {
+        case GL::ContextCounter::DrawCalls:
+            name = "Draw calls";
+            break;
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        case GL::ContextCounter::ComputeDispatches:
+            name = "Compute dispatches";
+            break;
+        #endif
+        case GL::ContextCounter::ShaderProgramSwitches:
+            name = "Shader program switches";
+            break;
+        case GL::ContextCounter::TextureBindings:
+            name = "Texture bindings";
+            break;
+        case GL::ContextCounter::BufferUploads:
+            name = "Buffer uploads";
+            break;
+        case GL::ContextCounter::BufferUploadSize:
+            name = "Buffer upload size";
+            units = FrameProfiler::Units::Bytes;
+            break;
+    }
+    CORRADE_INTERNAL_ASSERT(name);
+
+    /* The counter is stashed directly in the state pointer */
+    return FrameProfiler::Measurement{name, units,
+        [](void*) {
+            GL::Context::current().resetCounters();
+        },
+        [](void* state) {
+            return GL::Context::current().counter(GL::ContextCounter(reinterpret_cast<std::uintptr_t>(state)));
+        }, reinterpret_cast<void*>(std::uintptr_t(counter))};
+}
+#endif
+
+#ifdef MAGNUM_TARGET_VK
+struct FrameProfilerVk::State {
+    explicit State(Vk::Device& device): device{device} {}
+
+    Vk::Device& device;
+    /* Set by beginFrame() / endFrame() for the measurement callbacks */
+    Vk::CommandBuffer* commandBuffer{};
+
+    UnsignedShort cpuDurationIndex = 0xffff,
+        gpuDurationIndex = 0xffff,
+        frameTimeIndex = 0xffff,
+        vertexFetchRatioIndex = 0xffff,
+        primitiveClipRatioIndex = 0xffff;
+    UnsignedLong frameTimeStartFrame[2];
+    UnsignedLong cpuDurationStartFrame;
+
+    enum: UnsignedInt { QueryCount = 3 };
+    Double timestampPeriod;
+    /* Two timestamps for each frame */
+    Vk::QueryPool timestampPool{NoCreate};
+    /* One query for each frame, the statistics are written in the order of
+       their bits */
+    Vk::QueryPool vertexFetchPool{NoCreate};
+    Vk::QueryPool primitiveClipPool{NoCreate};
+};
+
+FrameProfilerVk::FrameProfilerVk(Vk::Device& device): _state{InPlaceInit, device} {}
+
+FrameProfilerVk::FrameProfilerVk(Vk::Device& device, const Values values, const UnsignedInt maxFrameCount): FrameProfilerVk{device}
+{
+    setup(values, maxFrameCount);
+}
+
+FrameProfilerVk::FrameProfilerVk(FrameProfilerVk&&) noexcept = default;
+
+FrameProfilerVk& FrameProfilerVk::operator=(FrameProfilerVk&&) noexcept = default;
+
+FrameProfilerVk::~FrameProfilerVk() = default;
+
+void FrameProfilerVk::setup(const Values values, const UnsignedInt maxFrameCount) {
+    /* Drop pools from a previous setup, they get recreated only if the
+       corresponding value is enabled again */
+    _state->timestampPool = Vk::QueryPool{NoCreate};
+    _state->vertexFetchPool = Vk::QueryPool{NoCreate};
+    _state->primitiveClipPool = Vk::QueryPool{NoCreate};
+    _state->cpuDurationIndex = _state->gpuDurationIndex =
+        _state->frameTimeIndex = _state->vertexFetchRatioIndex =
+            _state->primitiveClipRatioIndex = 0xffff;
+
+    UnsignedShort index = 0;
+    Containers::Array<Measurement> measurements;
+    if(values & Value::FrameTime) {
+        arrayAppend(measurements, InPlaceInit,
+            "Frame time", Units::Nanoseconds, UnsignedInt(Containers::arraySize(_state->frameTimeStartFrame)),
+            [](void* state, UnsignedInt current) {
+                static_cast<State*>(state)->frameTimeStartFrame[current] = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now().time_since_epoch()).count();
+            },
+            [](void*, UnsignedInt) {},
+            [](void* state, UnsignedInt previous, UnsignedInt current) {
+                auto& self = *static_cast<State*>(state);
+                return self.frameTimeStartFrame[current] -
+                    self.frameTimeStartFrame[previous];
+            }, _state.get());
+        _state->frameTimeIndex = index++;
+    }
+    if(values & Value::CpuDuration) {
+        arrayAppend(measurements, InPlaceInit,
+            "CPU duration", Units::Nanoseconds,
+            [](void* state) {
+                static_cast<State*>(state)->cpuDurationStartFrame = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now().time_since_epoch()).count();
+            },
+            [](void* state) {
+                /* libc++ 10 needs an explicit cast to UnsignedLong */
+                return UnsignedLong(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now().time_since_epoch()).count() - static_cast<State*>(state)->cpuDurationStartFrame);
+            }, _state.get());
+        _state->cpuDurationIndex = index++;
+    }
+    if(values & Value::GpuDuration) {
+        _state->timestampPeriod = _state->device.properties().properties().properties.limits.timestampPeriod;
+        _state->timestampPool = Vk::QueryPool{_state->device, Vk::QueryPoolCreateInfo{Vk::QueryType::Timestamp, State::QueryCount*2}};
+        arrayAppend(measurements, InPlaceInit,
+            "GPU duration", Units::Nanoseconds, UnsignedInt(State::QueryCount),
+            [](void* state, UnsignedInt current) {
+                auto& self = *static_cast<State*>(state);
+                CORRADE_INTERNAL_ASSERT(self.commandBuffer);
+                self.commandBuffer->resetQueryPool(self.timestampPool, current*2, 2)
+                    .writeTimestamp(Vk::PipelineStage::TopOfPipe, self.timestampPool, current*2);
+            },
+            [](void* state, UnsignedInt current) {
+                auto& self = *static_cast<State*>(state);
+                CORRADE_INTERNAL_ASSERT(self.commandBuffer);
+                self.commandBuffer->writeTimestamp(Vk::PipelineStage::BottomOfPipe, self.timestampPool, current*2 + 1);
+            },
+            [](void* state, UnsignedInt previous, UnsignedInt) {
+                auto& self = *static_cast<State*>(state);
+                UnsignedLong timestamps[2];
+                self.timestampPool.results(previous*2, 2, timestamps, Vk::QueryResultFlag::Wait);
+                /* Timestamps may wrap around if the queue doesn't have all
+                   64 bits valid, return zero in that case */
+                if(timestamps[1] < timestamps[0]) return UnsignedLong{};
+                return UnsignedLong((timestamps[1] - timestamps[0])*self.timestampPeriod);
+            }, _state.get());
+        _state->gpuDurationIndex = index++;
+    }
+    if(values & Value::VertexFetchRatio) {
+        _state->vertexFetchPool = Vk::QueryPool{_state->device, Vk::QueryPoolCreateInfo{Vk::QueryType::PipelineStatistics, State::QueryCount, Vk::QueryPipelineStatistic::InputAssemblyVertices|Vk::QueryPipelineStatistic::VertexShaderInvocations}};
+        arrayAppend(measurements, InPlaceInit,
+            "Vertex fetch ratio", Units::RatioThousandths,
+            UnsignedInt(State::QueryCount),
+            [](void* state, UnsignedInt current) {
+                auto& self = *static_cast<State*>(state);
+                CORRADE_INTERNAL_ASSERT(self.commandBuffer);
+                self.commandBuffer->resetQueryPool(self.vertexFetchPool, current, 1)
+                    .beginQuery(self.vertexFetchPool, current);
+            },
+            [](void* state, UnsignedInt current) {
+                auto& self = *static_cast<State*>(state);
+                CORRADE_INTERNAL_ASSERT(self.commandBuffer);
+                self.commandBuffer->endQuery(self.vertexFetchPool, current);
+            },
+            [](void* state, UnsignedInt previous, UnsignedInt) {
+                /* Input assembly vertices first, vertex shader invocations
+                   second */
+                UnsignedLong statistics[2];
+                static_cast<State*>(state)->vertexFetchPool.results(previous, 1, statistics, Vk::QueryResultFlag::Wait);
+
+                /* Avoid division by zero if a frame doesn't have any draws */
+                if(!statistics[0]) return UnsignedLong{};
+
+                return statistics[1]*1000/statistics[0];
+            }, _state.get());
+        _state->vertexFetchRatioIndex = index++;
+    }
+    if(values & Value::PrimitiveClipRatio) {
+        _state->primitiveClipPool = Vk::QueryPool{_state->device, Vk::QueryPoolCreateInfo{Vk::QueryType::PipelineStatistics, State::QueryCount, Vk::QueryPipelineStatistic::ClippingInvocations|Vk::QueryPipelineStatistic::ClippingPrimitives}};
+        arrayAppend(measurements, InPlaceInit,
+            "Primitives clipped", Units::PercentageThousandths,
+            UnsignedInt(State::QueryCount),
+            [](void* state, UnsignedInt current) {
+                auto& self = *static_cast<State*>(state);
+                CORRADE_INTERNAL_ASSERT(self.commandBuffer);
+                self.commandBuffer->resetQueryPool(self.primitiveClipPool, current, 1)
+                    .beginQuery(self.primitiveClipPool, current);
+            },
+            [](void* state, UnsignedInt current) {
+                auto& self = *static_cast<State*>(state);
+                CORRADE_INTERNAL_ASSERT(self.commandBuffer);
+                self.commandBuffer->endQuery(self.primitiveClipPool, current);
+            },
+            [](void* state, UnsignedInt previous, UnsignedInt) {
+                /* Clipping input primitives first, output primitives
+                   second */
+                UnsignedLong statistics[2];
+                static_cast<State*>(state)->primitiveClipPool.results(previous, 1, statistics, Vk::QueryResultFlag::Wait);
+
+                /* Avoid division by zero if a frame doesn't have any draws */
+                if(!statistics[0]) return UnsignedLong{};
+
+                /* If we have more output primitives than input, it's because
+                   a triangle got split into multiple. To avoid an underflow,
+                   return zero as well, same as in FrameProfilerGL. */
+                if(statistics[0] < statistics[1]) return UnsignedLong{};
+
+                return 100000 - statistics[1]*100000/statistics[0];
+            }, _state.get());
+        _state->primitiveClipRatioIndex = index++;
+    }
+    setup(std::move(measurements), maxFrameCount);
+}
+
+auto FrameProfilerVk::values() const -> Values {
+    Values values;
+    if(_state->frameTimeIndex != 0xffff) values |= Value::FrameTime;
+    if(_state->cpuDurationIndex != 0xffff) values |= Value::CpuDuration;
+    if(_state->gpuDurationIndex != 0xffff) values |= Value::GpuDuration;
+    if(_state->vertexFetchRatioIndex != 0xffff) values |= Value::VertexFetchRatio;
+    if(_state->primitiveClipRatioIndex != 0xffff) values |= Value::PrimitiveClipRatio;
+    return values;
+}
+
+void FrameProfilerVk::beginFrame(Vk::CommandBuffer& commandBuffer) {
+    _state->commandBuffer = &commandBuffer;
+    FrameProfiler::beginFrame();
+    _state->commandBuffer = nullptr;
+}
+
+void FrameProfilerVk::endFrame(Vk::CommandBuffer& commandBuffer) {
+    _state->commandBuffer = &commandBuffer;
+    FrameProfiler::endFrame();
+    _state->commandBuffer = nullptr;
+}
+
+bool FrameProfilerVk::isMeasurementAvailable(const Value value) const {
+    const UnsignedShort* index = nullptr;
+    switch(value) {
+        case Value::FrameTime: index = &_state->frameTimeIndex; break;
+        case Value::CpuDuration: index = &_state->cpuDurationIndex; break;
+        case Value::GpuDuration: index = &_state->gpuDurationIndex; break;
+        case Value::VertexFetchRatio: index = &_state->vertexFetchRatioIndex; break;
+        case Value::PrimitiveClipRatio: index = &_state->primitiveClipRatioIndex; break;
+    }
+    CORRADE_INTERNAL_ASSERT(index);
+    CORRADE_ASSERT(*index < measurementCount(),
+        "DebugTools::FrameProfilerVk::isMeasurementAvailable():" << value << "not enabled", {});
+    return isMeasurementAvailable(*index);
+}
+
+Double FrameProfilerVk::frameTimeMean() const {
+    CORRADE_ASSERT(_state->frameTimeIndex < measurementCount(),
+        "DebugTools::FrameProfilerVk::frameTimeMean(): not enabled", {});
+    return measurementMean(_state->frameTimeIndex);
+}
+
+Double FrameProfilerVk::cpuDurationMean() const {
+    CORRADE_ASSERT(_state->cpuDurationIndex < measurementCount(),
+        "DebugTools::FrameProfilerVk::cpuDurationMean(): not enabled", {});
+    return measurementMean(_state->cpuDurationIndex);
+}
+
+Double FrameProfilerVk::gpuDurationMean() const {
+    CORRADE_ASSERT(_state->gpuDurationIndex < measurementCount(),
+        "DebugTools::FrameProfilerVk::gpuDurationMean(): not enabled", {});
+    return measurementMean(_state->gpuDurationIndex);
+}
+
+Double FrameProfilerVk::vertexFetchRatioMean() const {
+    CORRADE_ASSERT(_state->vertexFetchRatioIndex < measurementCount(),
+        "DebugTools::FrameProfilerVk::vertexFetchRatioMean(): not enabled", {});
+    return measurementMean(_state->vertexFetchRatioIndex);
+}
+
+Double FrameProfilerVk::primitiveClipRatioMean() const {
+    CORRADE_ASSERT(_state->primitiveClipRatioIndex < measurementCount(),
+        "DebugTools::FrameProfilerVk::primitiveClipRatioMean(): not enabled", {});
+    return measurementMean(_state->primitiveClipRatioIndex);
+}
+
+namespace {
+
+constexpr const char* FrameProfilerVkValueNames[] {
+    "FrameTime",
+    "CpuDuration",
+    "GpuDuration",
+    "VertexFetchRatio",
+    "PrimitiveClipRatio"
+};
+
+}
+
+Debug& operator<<(Debug& debug, const FrameProfilerVk::Value value) {
+    debug << "DebugTools::FrameProfilerVk::Value" << Debug::nospace;
+
+    const UnsignedInt bit = Math::log2(UnsignedShort(value));
+    if(1 << bit == UnsignedShort(value) && bit < Containers::arraySize(FrameProfilerVkValueNames))
+        return debug << "::" << Debug::nospace << FrameProfilerVkValueNames[bit];
+
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedShort(value)) << Debug::nospace << ")";
+}
+
+Debug& operator<<(Debug& debug, const FrameProfilerVk::Values value) {
+    return Containers::enumSetDebugOutput(debug, value, "DebugTools::FrameProfilerVk::Values{}", {
+        FrameProfilerVk::Value::FrameTime,
+        FrameProfilerVk::Value::CpuDuration,
+        FrameProfilerVk::Value::GpuDuration,
+        FrameProfilerVk::Value::VertexFetchRatio,
+        FrameProfilerVk::Value::PrimitiveClipRatio});
+}
 #endif
 
 }}
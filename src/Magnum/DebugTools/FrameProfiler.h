@@ -26,7 +26,7 @@
 */
 
 /** @file
- * @brief Class @ref Magnum::DebugTools::FrameProfiler, @ref Magnum::DebugTools::FrameProfilerGL
+ * @brief Class @ref Magnum::DebugTools::FrameProfiler, @ref Magnum::DebugTools::FrameProfilerGL, function @ref Magnum::DebugTools::timerQueryPoolMeasurement(), @ref Magnum::DebugTools::memoryUsageMeasurement(), @ref Magnum::DebugTools::contextCounterMeasurement()
  * @m_since{2020,06}
  */
 
@@ -37,6 +37,13 @@
 #include "Magnum/Magnum.h"
 #include "Magnum/DebugTools/visibility.h"
 
+#ifdef MAGNUM_TARGET_GL
+#include "Magnum/GL/GL.h"
+#endif
+#ifdef MAGNUM_TARGET_VK
+#include "Magnum/Vk/Vk.h"
+#endif
+
 namespace Magnum { namespace DebugTools {
 
 /**
@@ -119,6 +126,51 @@ parameters passed to each callback:
     If you don't or can't use @cpp this @ce as a state pointer, you need to
     either provide a dedicated move constructor and assignment to do the
     required patching or disable moves altogether to avoid accidents.
+
+@section DebugTools-FrameProfiler-scopes Hierarchical CPU scopes
+
+Besides whole-frame measurements, the profiler can aggregate named nested
+scopes marked with @ref ProfileScope. Call @ref enableScopes() and the
+scopes recorded on any thread are then collected on every @ref endFrame(),
+merged into a tree by their names and nesting and shown in
+@ref statistics() together with the measurements:
+
+@snippet MagnumDebugTools.cpp FrameProfiler-scopes
+
+A scope is accounted to the frame in which it ended. For each scope the
+profiler calculates a moving average of the total duration and of the call
+count per frame, available also through @ref scopeDurationMean() and
+@ref scopeCallCountMean(). Scopes opened in the same parent on different
+threads get merged together, so the total duration can be larger than the
+frame time. If Magnum is built with @ref MAGNUM_BUILD_PROFILING, operations
+such as @ref MeshTools::compile() or @ref Trade::AbstractImporter::mesh()
+show up in the tree as well, unless the scopes are configured to use an
+external profiler instead as described in @ref ProfileScope-library-scopes.
+
+Recorded scopes are consumed from the buffers by the profiler, so only one
+profiler should have scopes enabled at a time.
+
+@section DebugTools-FrameProfiler-trace Trace capture
+
+While the statistics show only moving averages, a trace shows what happened
+in each frame. After calling @ref startTrace(), every frame is recorded
+together with all measurement values and, if scopes are enabled, all
+individual scopes with their begin and end time on each thread. The trace
+can be then exported with @ref saveTrace() or @ref traceJson() in the
+[Chrome trace event format](https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU/preview),
+which can be opened in the [Perfetto UI](https://ui.perfetto.dev/) or in
+@cb{.ini} chrome://tracing @ce.
+
+Measurements in @ref Units::Nanoseconds are shown as slices on a dedicated
+track for each, starting at the begin of the frame they were measured in.
+That's also where results of delayed measurements such as GPU timer queries
+get placed, so they're aligned with the CPU frame that submitted the work.
+Measurements in other units are shown as counters. The trace is unbounded by
+default, passing a frame count to @ref startTrace() makes it stop
+automatically, which is useful for capturing a hitch on a key press in an
+otherwise unprofiled build:
+
+@snippet MagnumDebugTools.cpp FrameProfiler-trace
 */
 class MAGNUM_DEBUGTOOLS_EXPORT FrameProfiler {
     public:
@@ -189,6 +241,8 @@ class MAGNUM_DEBUGTOOLS_EXPORT FrameProfiler {
         /** @brief Move constructor */
         FrameProfiler(FrameProfiler&&) noexcept;
 
+        ~FrameProfiler();
+
         /** @brief Copying is not allowed */
         FrameProfiler& operator=(const FrameProfiler&) = delete;
 
@@ -351,13 +405,157 @@ class MAGNUM_DEBUGTOOLS_EXPORT FrameProfiler {
          */
         Double measurementMean(UnsignedInt id) const;
 
+        /**
+         * @brief Whether scope profiling is enabled
+         * @m_since_latest
+         *
+         * @see @ref enableScopes(), @ref disableScopes()
+         */
+        bool areScopesEnabled() const { return !!_scopes; }
+
+        /**
+         * @brief Enable scope profiling
+         * @m_since_latest
+         *
+         * Starts recording @ref ProfileScope instances on all threads and
+         * aggregating them on every @ref endFrame(). Any scopes recorded
+         * before are discarded. Calling this function on a profiler with
+         * scopes already enabled discards all aggregated scope data, the
+         * same happens when @ref enable() or @ref setup() is called. See
+         * @ref DebugTools-FrameProfiler-scopes for more information.
+         */
+        void enableScopes();
+
+        /**
+         * @brief Disable scope profiling
+         * @m_since_latest
+         *
+         * Stops recording @ref ProfileScope instances and discards all
+         * aggregated scope data. Scope profiling is disabled by default.
+         */
+        void disableScopes();
+
+        /**
+         * @brief Count of aggregated scopes
+         * @m_since_latest
+         *
+         * Count of unique scopes in the tree. The scopes are ordered
+         * depth-first, with children in order they were first encountered.
+         * If scope profiling is disabled, returns @cpp 0 @ce.
+         * @see @ref areScopesEnabled()
+         */
+        UnsignedInt scopeCount() const;
+
+        /**
+         * @brief Scope name
+         * @m_since_latest
+         *
+         * Expects that @p id is less than @ref scopeCount().
+         */
+        std::string scopeName(UnsignedInt id) const;
+
+        /**
+         * @brief Scope depth
+         * @m_since_latest
+         *
+         * Depth of the scope in the tree, top-level scopes have a depth of
+         * @cpp 0 @ce. Expects that @p id is less than @ref scopeCount().
+         */
+        UnsignedInt scopeDepth(UnsignedInt id) const;
+
+        /**
+         * @brief Scope duration mean
+         * @m_since_latest
+         *
+         * Moving average of the total duration of given scope per frame, in
+         * nanoseconds. Frames in which the scope didn't end contribute with
+         * zero. Expects that @p id is less than @ref scopeCount().
+         */
+        Double scopeDurationMean(UnsignedInt id) const;
+
+        /**
+         * @brief Scope call count mean
+         * @m_since_latest
+         *
+         * Moving average of how many times given scope ended per frame.
+         * Expects that @p id is less than @ref scopeCount().
+         */
+        Double scopeCallCountMean(UnsignedInt id) const;
+
+        /**
+         * @brief Whether a trace is being captured
+         * @m_since_latest
+         *
+         * @see @ref startTrace(), @ref stopTrace()
+         */
+        bool isTracing() const;
+
+        /**
+         * @brief Start capturing a trace
+         * @param frameCount    Count of frames after which to stop the
+         *      capture automatically. If @cpp 0 @ce, the capture continues
+         *      until @ref stopTrace() is called.
+         * @m_since_latest
+         *
+         * Discards any previously captured trace. Frames are recorded only
+         * while the profiler is enabled, if scope profiling isn't enabled,
+         * the trace contains only frames and measurement values. Calling
+         * @ref setup() stops the capture. See
+         * @ref DebugTools-FrameProfiler-trace for more information.
+         */
+        void startTrace(UnsignedInt frameCount = 0);
+
+        /**
+         * @brief Stop capturing a trace
+         * @m_since_latest
+         *
+         * The captured trace is kept until the next @ref startTrace() call.
+         * If no trace is being captured, the function is a no-op.
+         */
+        void stopTrace();
+
+        /**
+         * @brief Count of frames in the captured trace
+         * @m_since_latest
+         *
+         * If no trace was captured yet, returns @cpp 0 @ce.
+         */
+        UnsignedInt traceFrameCount() const;
+
+        /**
+         * @brief Captured trace in the Chrome trace event format
+         * @m_since_latest
+         *
+         * Returns a JSON string with an object containing a
+         * @cb{.json} "traceEvents" @ce array. Times are in microseconds
+         * relative to the @ref startTrace() call. If no trace was captured
+         * yet, the array is empty.
+         * @see @ref saveTrace()
+         */
+        std::string traceJson() const;
+
+        /**
+         * @brief Save the captured trace to a file
+         * @m_since_latest
+         *
+         * Saves the output of @ref traceJson() to @p filename. Prints a
+         * message to @relativeref{Magnum,Error} and returns @cpp false @ce if
+         * the file can't be written.
+         */
+        bool saveTrace(Containers::StringView filename) const;
+
         /**
          * @brief Overview of all measurements
          *
          * Returns a formatted string with names, means and units of all
          * measurements in the order they were added. If some measurement data
          * is available yet, prints placeholder values for these; if the
-         * @see @ref isMeasurementAvailable(), @ref isEnabled()
+         *
+         * If scope profiling is enabled, the measurements are followed by
+         * the tree of aggregated scopes with their mean duration and call
+         * count per frame.
+         * @see @ref isMeasurementAvailable(), @ref isEnabled(),
+         *      @ref enableScopes()
          */
         std::string statistics() const;
 
@@ -391,8 +589,12 @@ class MAGNUM_DEBUGTOOLS_EXPORT FrameProfiler {
         }
 
     private:
+        struct Scopes;
+        struct Trace;
+
         UnsignedInt delayedCurrentData(UnsignedInt delay) const;
         Double measurementMeanInternal(const Measurement& measurement) const;
+        void resetScopes();
         void printStatisticsInternal(Debug& out) const;
 
         bool _enabled = true;
@@ -404,6 +606,8 @@ class MAGNUM_DEBUGTOOLS_EXPORT FrameProfiler {
         UnsignedInt _maxFrameCount{1}, _measuredFrameCount{};
         Containers::Array<Measurement> _measurements;
         Containers::Array<UnsignedLong> _data;
+        Containers::Pointer<Scopes> _scopes;
+        Containers::Pointer<Trace> _trace;
 };
 
 /**
@@ -710,6 +914,71 @@ MAGNUM_DEBUGTOOLS_EXPORT Debug& operator<<(Debug& debug, FrameProfilerGL::Value
 */
 MAGNUM_DEBUGTOOLS_EXPORT Debug& operator<<(Debug& debug, FrameProfilerGL::Values value);
 
+/**
+@brief Create a frame profiler measurement for a timer query pool scope
+@param pool     Timer query pool
+@param scope    Scope name
+@m_since_latest
+
+Adds @p scope to @p pool using @ref GL::TimerQueryPool::addScope() if it's
+not there yet and returns an immediate @ref FrameProfiler::Measurement named
+after the scope, measuring @ref FrameProfiler::Units::Nanoseconds. In each
+frame it records the latest duration available in the pool, i.e. the value is
+delayed by the pool latency on top. The measurement references memory owned
+by @p pool, so the pool has to stay alive for as long as the profiler is
+used. Moving the pool is fine.
+
+@snippet MagnumDebugTools-gl.cpp timerQueryPoolMeasurement
+*/
+MAGNUM_DEBUGTOOLS_EXPORT FrameProfiler::Measurement timerQueryPoolMeasurement(GL::TimerQueryPool& pool, Containers::StringView scope);
+
+/**
+@brief Create a frame profiler measurement for total tracked GPU memory usage
+@m_since_latest
+
+Enables @ref GL::MemoryUsage tracking if not already and returns an immediate
+@ref FrameProfiler::Measurement named @cpp "GPU memory" @ce, measuring
+@ref FrameProfiler::Units::Bytes. In each frame it records
+@ref GL::MemoryUsage::total(). As the tracking is enabled only at this point,
+objects created before aren't accounted for --- create the measurement early,
+ideally before any buffers or textures are made.
+
+@snippet MagnumDebugTools-gl.cpp memoryUsageMeasurement
+@see @ref memoryUsageMeasurement(GL::MemoryUsageCategory)
+*/
+MAGNUM_DEBUGTOOLS_EXPORT FrameProfiler::Measurement memoryUsageMeasurement();
+
+/**
+@brief Create a frame profiler measurement for tracked GPU memory usage of given category
+@m_since_latest
+
+Like @ref memoryUsageMeasurement(), but recording just
+@ref GL::MemoryUsage::total(GL::MemoryUsageCategory) for given @p category.
+The measurement is named @cpp "GPU buffer memory" @ce,
+@cpp "GPU texture memory" @ce or @cpp "GPU renderbuffer memory" @ce.
+*/
+MAGNUM_DEBUGTOOLS_EXPORT FrameProfiler::Measurement memoryUsageMeasurement(GL::MemoryUsageCategory category);
+
+/**
+@brief Create a frame profiler measurement for a GL context counter
+@m_since_latest
+
+Returns an immediate @ref FrameProfiler::Measurement that calls
+@ref GL::Context::resetCounters() at the beginning of each frame and records
+@ref GL::Context::counter() for given @p counter at the end of it. The
+measurement is named for example @cpp "Draw calls" @ce or
+@cpp "Texture bindings" @ce and measures
+@ref FrameProfiler::Units::Bytes for
+@ref GL::ContextCounter::BufferUploadSize and
+@ref FrameProfiler::Units::Count for everything else. As all counters are
+reset together, it's possible to have measurements for several counters at
+once, but application code shouldn't rely on the counter values accumulating
+across frames while such measurement is active.
+
+@snippet MagnumDebugTools-gl.cpp contextCounterMeasurement
+*/
+MAGNUM_DEBUGTOOLS_EXPORT FrameProfiler::Measurement contextCounterMeasurement(GL::ContextCounter counter);
+
 #ifdef MAGNUM_BUILD_DEPRECATED
 /** @brief @copybrief FrameProfilerGL
  * @m_deprecated_since_latest Use @ref FrameProfilerGL instead.
@@ -718,6 +987,251 @@ typedef CORRADE_DEPRECATED("use FrameProfilerGL instead") FrameProfilerGL GLFram
 #endif
 #endif
 
+#ifdef MAGNUM_TARGET_VK
+/**
+@brief Vulkan frame profiler
+@m_since_latest
+
+A @ref FrameProfiler with Vulkan-specific measurements. Compared to
+@ref FrameProfilerGL, GPU measurements are recorded into a command buffer, so
+@ref beginFrame() and @ref endFrame() take the @ref Vk::CommandBuffer that
+contains the frame commands. Both have to be called outside of a render pass
+--- @ref beginFrame() right after @ref Vk::CommandBuffer::begin() and
+@ref endFrame() right before @ref Vk::CommandBuffer::end():
+
+@snippet MagnumDebugTools.cpp FrameProfilerVk-usage
+
+The GPU values are retrieved from @ref Vk::QueryPool instances with a delay
+of 3 frames, waiting for the results if they're not available yet. The
+command buffer recorded in a particular frame is thus expected to be
+submitted before results for that frame are queried, which is usually the
+case when at most 3 frames are in flight.
+
+If none of @ref Value::GpuDuration, @ref Value::VertexFetchRatio and
+@ref Value::PrimitiveClipRatio is enabled, no query pools are created and the
+command buffer is unused.
+
+@experimental
+*/
+class MAGNUM_DEBUGTOOLS_EXPORT FrameProfilerVk: public FrameProfiler {
+    public:
+        /**
+         * @brief Measured value
+         *
+         * @see @ref Values, @ref FrameProfilerVk(Vk::Device&, Values, UnsignedInt),
+         *      @ref setup()
+         */
+        enum class Value: UnsignedShort {
+            /**
+             * Measure total frame time (i.e., time between consecutive
+             * @ref beginFrame() calls). Reported in @ref Units::Nanoseconds
+             * with a delay of 2 frames. When converted to seconds, the value
+             * is an inverse of FPS.
+             */
+            FrameTime = 1 << 0,
+
+            /**
+             * Measure CPU frame duration (i.e., CPU time spent between
+             * @ref beginFrame() and @ref endFrame()). Reported in
+             * @ref Units::Nanoseconds with a delay of 1 frame.
+             */
+            CpuDuration = 1 << 1,
+
+            /**
+             * Measure GPU frame duration (i.e., time between a timestamp
+             * written in @ref beginFrame() and @ref endFrame()). Reported in
+             * @ref Units::Nanoseconds with a delay of 3 frames. Uses a
+             * @ref Vk::QueryType::Timestamp query pool and scales the values
+             * by the device timestamp period.
+             */
+            GpuDuration = 1 << 2,
+
+            /**
+             * Ratio of vertex shader invocations to count of vertices
+             * submitted. For a non-indexed draw the ratio will be 1, for
+             * indexed draws ratio is less than 1. The lower the value is, the
+             * better a mesh is optimized for post-transform vertex cache.
+             * Reported in @ref Units::RatioThousandths with a delay of 3
+             * frames.
+             * @requires_vk_feature @ref Vk::DeviceFeature::PipelineStatisticsQuery
+             */
+            VertexFetchRatio = 1 << 3,
+
+            /**
+             * Ratio of primitives discarded by the clipping stage to count of
+             * primitives submitted. The ratio is 0 when all primitives pass
+             * the clipping stage and 1 when all are discarded. Can be used to
+             * measure efficiency of a frustum culling algorithm. Reported in
+             * @ref Units::PercentageThousandths with a delay of 3 frames.
+             * @requires_vk_feature @ref Vk::DeviceFeature::PipelineStatisticsQuery
+             */
+            PrimitiveClipRatio = 1 << 4
+        };
+
+        /**
+         * @brief Measured values
+         *
+         * @see @ref FrameProfilerVk(Vk::Device&, Values, UnsignedInt),
+         *      @ref setup()
+         */
+        typedef Containers::EnumSet<Value> Values;
+
+        /**
+         * @brief Constructor
+         * @param device    Device to create query pools on
+         *
+         * Call @ref setup() to populate the profiler with measurements.
+         */
+        explicit FrameProfilerVk(Vk::Device& device);
+
+        /**
+         * @brief Construct and set up measured values
+         *
+         * Equivalent to calling @ref FrameProfilerVk(Vk::Device&) and
+         * @ref setup() afterwards.
+         */
+        explicit FrameProfilerVk(Vk::Device& device, Values values, UnsignedInt maxFrameCount);
+
+        /** @brief Copying is not allowed */
+        FrameProfilerVk(const FrameProfilerVk&) = delete;
+
+        /** @brief Move constructor */
+        FrameProfilerVk(FrameProfilerVk&&) noexcept;
+
+        /** @brief Copying is not allowed */
+        FrameProfilerVk& operator=(const FrameProfilerVk&) = delete;
+
+        /** @brief Move assignment */
+        FrameProfilerVk& operator=(FrameProfilerVk&&) noexcept;
+
+        ~FrameProfilerVk();
+
+        /**
+         * @brief Setup measured values
+         * @param values        List of measuremed values
+         * @param maxFrameCount Max frame count over which to calculate a
+         *      moving average. Expected to be at least @cpp 1 @ce.
+         *
+         * Calling @ref setup() on an already set up profiler will replace
+         * existing measurements with @p measurements, recreate the query
+         * pools and reset @ref measuredFrameCount() back to @cpp 0 @ce.
+         */
+        void setup(Values values, UnsignedInt maxFrameCount);
+
+        /**
+         * @brief Measured values
+         *
+         * Corresponds to the @p values parameter passed to
+         * @ref FrameProfilerVk(Vk::Device&, Values, UnsignedInt) or
+         * @ref setup().
+         */
+        Values values() const;
+
+        /**
+         * @brief Begin a frame
+         *
+         * Records query pool resets, a timestamp and pipeline statistics
+         * query begins into @p commandBuffer, depending on which values are
+         * enabled, and then delegates to @ref FrameProfiler::beginFrame().
+         * Has to be called outside of a render pass.
+         */
+        void beginFrame(Vk::CommandBuffer& commandBuffer);
+
+        /**
+         * @brief End a frame
+         *
+         * Records a timestamp and pipeline statistics query ends into
+         * @p commandBuffer, depending on which values are enabled, and then
+         * delegates to @ref FrameProfiler::endFrame(). Has to be called
+         * outside of a render pass, with the same command buffer as
+         * @ref beginFrame().
+         */
+        void endFrame(Vk::CommandBuffer& commandBuffer);
+
+        /**
+         * @brief Whether given measurement is available
+         *
+         * Returns @cpp true @ce if enough frames was captured to calculate
+         * given @p value, @cpp false @ce otherwise. Expects that @p value was
+         * enabled.
+         */
+        bool isMeasurementAvailable(Value value) const;
+
+        using FrameProfiler::isMeasurementAvailable;
+
+        /**
+         * @brief Mean frame time in nanoseconds
+         *
+         * Expects that @ref Value::FrameTime was enabled, and that measurement
+         * data is available. See the flag documentation for more information.
+         * @see @ref isMeasurementAvailable(), @ref measurementMean()
+         */
+        Double frameTimeMean() const;
+
+        /**
+         * @brief Mean CPU frame duration in nanoseconds
+         *
+         * Expects that @ref Value::CpuDuration was enabled, and that
+         * measurement data is available. See the flag documentation for more
+         * information.
+         * @see @ref isMeasurementAvailable(), @ref measurementMean()
+         */
+        Double cpuDurationMean() const;
+
+        /**
+         * @brief Mean GPU frame duration in nanoseconds
+         *
+         * Expects that @ref Value::GpuDuration was enabled, and that
+         * measurement data is available. See the flag documentation for more
+         * information.
+         * @see @ref isMeasurementAvailable(), @ref measurementMean()
+         */
+        Double gpuDurationMean() const;
+
+        /**
+         * @brief Mean vertex fetch ratio in thousandths
+         *
+         * Expects that @ref Value::VertexFetchRatio was enabled, and that
+         * measurement data is available. See the flag documentation for more
+         * information.
+         * @see @ref isMeasurementAvailable(), @ref measurementMean()
+         */
+        Double vertexFetchRatioMean() const;
+
+        /**
+         * @brief Mean primitive clip ratio in percentage thousandths
+         *
+         * Expects that @ref Value::PrimitiveClipRatio was enabled, and that
+         * measurement data is available. See the flag documentation for more
+         * information.
+         * @see @ref isMeasurementAvailable(), @ref measurementMean()
+         */
+        Double primitiveClipRatioMean() const;
+
+    private:
+        using FrameProfiler::setup;
+        using FrameProfiler::beginFrame;
+        using FrameProfiler::endFrame;
+
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+CORRADE_ENUMSET_OPERATORS(FrameProfilerVk::Values)
+
+/**
+@debugoperatorclassenum{FrameProfilerVk,FrameProfilerVk::Value}
+@m_since_latest
+*/
+MAGNUM_DEBUGTOOLS_EXPORT Debug& operator<<(Debug& debug, FrameProfilerVk::Value value);
+
+/**
+@debugoperatorclassenum{FrameProfilerVk,FrameProfilerVk::Values}
+@m_since_latest
+*/
+MAGNUM_DEBUGTOOLS_EXPORT Debug& operator<<(Debug& debug, FrameProfilerVk::Values value);
+#endif
+
 }}
 
 namespace Corrade { namespace Utility {
@@ -0,0 +1,180 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ObjectIdPicker.h"
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/DebugTools/BufferData.h"
+#include "Magnum/GL/AbstractFramebuffer.h"
+#include "Magnum/GL/Buffer.h"
+#include "Magnum/GL/BufferImage.h"
+#include "Magnum/GL/OpenGL.h"
+#include "Magnum/GL/PixelFormat.h"
+#include "Magnum/Math/Range.h"
+
+namespace Magnum { namespace DebugTools {
+
+struct ObjectIdPicker::State {
+    struct Slot {
+        GL::Buffer buffer{GL::Buffer::TargetHint::PixelPack};
+        /* Null if the slot isn't pending */
+        GLsync fence{};
+        Vector2i position;
+    };
+
+    explicit State(UnsignedInt maxPendingCount): slots{maxPendingCount} {}
+
+    ~State() {
+        for(Slot& slot: slots)
+            if(slot.fence) glDeleteSync(slot.fence);
+    }
+
+    /* A ring buffer, first is the oldest pending pick */
+    Containers::Array<Slot> slots;
+    UnsignedInt first{};
+    UnsignedInt pendingCount{};
+
+    bool hasResult{};
+    UnsignedInt objectId{};
+    Vector2i position;
+};
+
+ObjectIdPicker::ObjectIdPicker(const UnsignedInt maxPendingCount) {
+    CORRADE_ASSERT(maxPendingCount,
+        "DebugTools::ObjectIdPicker: expected non-zero max pending count", );
+    _state.emplace(maxPendingCount);
+}
+
+ObjectIdPicker::ObjectIdPicker(NoCreateT) noexcept {}
+
+ObjectIdPicker::ObjectIdPicker(ObjectIdPicker&&) noexcept = default;
+
+ObjectIdPicker::~ObjectIdPicker() = default;
+
+ObjectIdPicker& ObjectIdPicker::operator=(ObjectIdPicker&&) noexcept = default;
+
+UnsignedInt ObjectIdPicker::maxPendingCount() const {
+    return _state ? _state->slots.size() : 0;
+}
+
+UnsignedInt ObjectIdPicker::pendingCount() const {
+    return _state ? _state->pendingCount : 0;
+}
+
+bool ObjectIdPicker::pick(GL::AbstractFramebuffer& framebuffer, const Vector2i& position) {
+    CORRADE_ASSERT(_state,
+        "DebugTools::ObjectIdPicker::pick(): the instance is in a moved-from state", {});
+    State& state = *_state;
+    if(state.pendingCount == state.slots.size()) return false;
+
+    /* Lend the buffer to a BufferImage for the read and take it back
+       afterwards, so it's allocated just once */
+    State::Slot& slot = state.slots[(state.first + state.pendingCount) % state.slots.size()];
+    GL::BufferImage2D image{GL::PixelFormat::RedInteger, GL::PixelType::UnsignedInt, {}, std::move(slot.buffer), 0};
+    framebuffer.read(Range2Di::fromSize(position, Vector2i{1}), image, GL::BufferUsage::StreamRead);
+    slot.buffer = image.release();
+    slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot.position = position;
+    ++state.pendingCount;
+    return true;
+}
+
+namespace {
+
+/* GL_WAIT_FAILED would only happen with an invalid sync object or context
+   loss, treating it as signaled to not poll forever */
+bool isSignaled(const GLsync fence, const GLbitfield flags, const GLuint64 timeout) {
+    return glClientWaitSync(fence, flags, timeout) != GL_TIMEOUT_EXPIRED;
+}
+
+}
+
+bool ObjectIdPicker::update() {
+    CORRADE_ASSERT(_state,
+        "DebugTools::ObjectIdPicker::update(): the instance is in a moved-from state", {});
+    State& state = *_state;
+
+    /* The fences get signaled in order, so stop at the first one that isn't.
+       Flush only once so the fence eventually gets signaled even if the
+       application doesn't submit any more work. */
+    State::Slot* latest = nullptr;
+    while(state.pendingCount) {
+        State::Slot& slot = state.slots[state.first];
+        if(!isSignaled(slot.fence, latest ? 0 : GL_SYNC_FLUSH_COMMANDS_BIT, 0))
+            break;
+
+        glDeleteSync(slot.fence);
+        slot.fence = {};
+        latest = &slot;
+        state.first = (state.first + 1) % state.slots.size();
+        --state.pendingCount;
+    }
+
+    if(!latest) return false;
+
+    /* Older finished picks are superseded, read just the latest */
+    const Containers::Array<char> data = bufferSubData(latest->buffer, 0, sizeof(UnsignedInt));
+    state.hasResult = true;
+    state.objectId = *reinterpret_cast<const UnsignedInt*>(data.data());
+    state.position = latest->position;
+    return true;
+}
+
+ObjectIdPicker& ObjectIdPicker::wait() {
+    CORRADE_ASSERT(_state,
+        "DebugTools::ObjectIdPicker::wait(): the instance is in a moved-from state", *this);
+    State& state = *_state;
+    if(!state.pendingCount) return *this;
+
+    /* Wait for the newest pick, which implies all older are done as well.
+       Flush on the first wait so the fence isn't waited on forever if it
+       wasn't submitted yet, then wait for a second at a time. */
+    const GLsync fence = state.slots[(state.first + state.pendingCount - 1) % state.slots.size()].fence;
+    GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+    while(!isSignaled(fence, flags, 1000000000ull))
+        flags = 0;
+
+    update();
+    return *this;
+}
+
+bool ObjectIdPicker::hasResult() const {
+    return _state && _state->hasResult;
+}
+
+UnsignedInt ObjectIdPicker::objectId() const {
+    CORRADE_ASSERT(_state && _state->hasResult,
+        "DebugTools::ObjectIdPicker::objectId(): no result available", {});
+    return _state->objectId;
+}
+
+Vector2i ObjectIdPicker::position() const {
+    CORRADE_ASSERT(_state && _state->hasResult,
+        "DebugTools::ObjectIdPicker::position(): no result available", {});
+    return _state->position;
+}
+
+}}
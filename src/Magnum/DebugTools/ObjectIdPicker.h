@@ -0,0 +1,202 @@
+#ifndef Magnum_DebugTools_ObjectIdPicker_h
+#define Magnum_DebugTools_ObjectIdPicker_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#if defined(MAGNUM_TARGET_GL) && !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+/** @file
+ * @brief Class @ref Magnum::DebugTools::ObjectIdPicker
+ * @m_since_latest
+ */
+#endif
+
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Tags.h"
+#include "Magnum/DebugTools/visibility.h"
+#include "Magnum/GL/GL.h"
+
+#if defined(MAGNUM_TARGET_GL) && !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+namespace Magnum { namespace DebugTools {
+
+/**
+@brief Asynchronous object ID picking
+@m_since_latest
+
+Reads object IDs rendered for example through
+@ref Shaders::PhongGL::ObjectIdOutput or @ref Shaders::FlatGL::ObjectIdOutput
+without stalling the pipeline. Unlike a @ref GL::AbstractFramebuffer::read()
+into an @ref Image2D, which waits until the GPU finishes rendering the frame,
+@ref pick() only records a copy of a single pixel into a pixel buffer followed
+by a fence and returns immediately. The result is then fetched by
+@ref update() once the fence is signaled, typically a frame later, which makes
+it suitable for hover highlighting that picks on every mouse move:
+
+@snippet MagnumDebugTools-gl.cpp ObjectIdPicker
+
+The picker reads from the framebuffer read attachment, so the attachment with
+object IDs has to be mapped for reading with
+@ref GL::Framebuffer::mapForRead() before calling @ref pick(). The attachment
+is expected to be a single-channel 32-bit unsigned integer format such as
+@ref GL::RenderbufferFormat::R32UI. Rendering the IDs only into a small
+region around the cursor using @ref GL::Renderer::Feature::ScissorTest makes
+the picking cheap even with a complex scene.
+
+The pixel buffers are allocated once and reused, there's at most
+@ref maxPendingCount() picks in flight. If the GPU lags behind so much that
+all of them are still pending, further picks are dropped until a slot gets
+free.
+
+@note This class is available only if Magnum is compiled with
+    @ref MAGNUM_TARGET_GL "TARGET_GL" enabled (done by default). See
+    @ref building-features for more information.
+
+@requires_gl30 Extension @gl_extension{EXT,texture_integer} for integer
+    framebuffer attachments
+@requires_gl32 Extension @gl_extension{ARB,sync} for fences
+@requires_gles30 Integer framebuffer attachments, pixel buffer objects and
+    fences are not available in OpenGL ES 2.0.
+@requires_gles Waiting for a fence on the client side isn't possible in
+    WebGL.
+@see @ref AsyncReadback
+*/
+class MAGNUM_DEBUGTOOLS_EXPORT ObjectIdPicker {
+    public:
+        /**
+         * @brief Constructor
+         * @param maxPendingCount   Max count of picks in flight. Expected to
+         *      be non-zero.
+         *
+         * Creates @p maxPendingCount pixel buffers.
+         */
+        explicit ObjectIdPicker(UnsignedInt maxPendingCount = 3);
+
+        /**
+         * @brief Construct without creating the internal state
+         *
+         * The instance is equivalent to a moved-from state. Useful in cases
+         * where you will overwrite the instance later anyway. Move another
+         * object over it to make it useful.
+         */
+        explicit ObjectIdPicker(NoCreateT) noexcept;
+
+        /** @brief Copying is not allowed */
+        ObjectIdPicker(const ObjectIdPicker&) = delete;
+
+        /** @brief Move constructor */
+        ObjectIdPicker(ObjectIdPicker&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Deletes the fences and pixel buffers without waiting for pending
+         * picks to finish.
+         */
+        ~ObjectIdPicker();
+
+        /** @brief Copying is not allowed */
+        ObjectIdPicker& operator=(const ObjectIdPicker&) = delete;
+
+        /** @brief Move assignment */
+        ObjectIdPicker& operator=(ObjectIdPicker&& other) noexcept;
+
+        /** @brief Max count of picks in flight */
+        UnsignedInt maxPendingCount() const;
+
+        /** @brief Count of picks in flight */
+        UnsignedInt pendingCount() const;
+
+        /**
+         * @brief Pick an object ID
+         * @param framebuffer   Framebuffer to read from
+         * @param position      Pixel position, with origin in the bottom
+         *      left corner
+         * @return @cpp false @ce if all pixel buffers are pending and the pick
+         *      was dropped, @cpp true @ce otherwise
+         *
+         * Copies a pixel at @p position from the @p framebuffer read
+         * attachment to a pixel buffer and guards the copy with a fence.
+         * The result can be fetched with @ref update().
+         */
+        bool pick(GL::AbstractFramebuffer& framebuffer, const Vector2i& position);
+
+        /**
+         * @brief Fetch finished picks
+         * @return @cpp true @ce if a new result is available, @cpp false @ce
+         *      otherwise
+         *
+         * Polls fences of the pending picks without waiting, flushing the
+         * command queue so they eventually get signaled even if the
+         * application doesn't submit any more work. If more picks finished
+         * since the last call, only the latest one is read.
+         * @see @ref hasResult(), @ref objectId(), @ref position()
+         */
+        bool update();
+
+        /**
+         * @brief Wait for all pending picks
+         * @return Reference to self (for method chaining)
+         *
+         * Blocks until all pending picks finish and then fetches the latest
+         * one, equivalently to @ref update(). Useful mainly for testing.
+         */
+        ObjectIdPicker& wait();
+
+        /**
+         * @brief Whether there's a pick result
+         *
+         * Returns @cpp true @ce once @ref update() or @ref wait() fetched a
+         * first result.
+         */
+        bool hasResult() const;
+
+        /**
+         * @brief Object ID of the latest finished pick
+         *
+         * Expects that @ref hasResult() is @cpp true @ce.
+         */
+        UnsignedInt objectId() const;
+
+        /**
+         * @brief Position of the latest finished pick
+         *
+         * The position passed to @ref pick() that produced @ref objectId().
+         * Expects that @ref hasResult() is @cpp true @ce.
+         */
+        Vector2i position() const;
+
+    private:
+        struct State;
+
+        Containers::Pointer<State> _state;
+};
+
+}}
+#else
+#error this header is available only in the OpenGL build and not on ES2 or WebGL
+#endif
+
+#endif
@@ -25,11 +25,15 @@
 
 #include "ObjectRenderer.h"
 
+#include <Corrade/Containers/GrowableArray.h>
+
 #include "Magnum/DebugTools/ResourceManager.h"
+#include "Magnum/GL/Buffer.h"
 #include "Magnum/GL/Mesh.h"
 #include "Magnum/MeshTools/Compile.h"
 #include "Magnum/Primitives/Axis.h"
 #include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/Shaders/FlatGL.h"
 #include "Magnum/Shaders/VertexColorGL.h"
 #include "Magnum/Trade/MeshData.h"
 
@@ -41,18 +45,63 @@ template<UnsignedInt> struct Renderer;
 
 template<> struct Renderer<2> {
     static ResourceKey shader() { return {"VertexColorShader2D"}; }
+    static ResourceKey instancedShader() { return {"FlatShaderInstancedVertexColor2D"}; }
     static ResourceKey mesh() { return {"object2d"}; }
     static Trade::MeshData meshData() { return Primitives::axis2D(); }
 };
 
 template<> struct Renderer<3> {
     static ResourceKey shader() { return {"VertexColorShader3D"}; }
+    static ResourceKey instancedShader() { return {"FlatShaderInstancedVertexColor3D"}; }
     static ResourceKey mesh() { return {"object3d"}; }
     static Trade::MeshData meshData() { return Primitives::axis3D(); }
 };
 
 }
 
+template<UnsignedInt dimensions> struct ObjectRendererBatch<dimensions>::State {
+    GL::Buffer buffer{GL::Buffer::TargetHint::Array};
+    /* Compiled separately from the mesh used by non-batched renderers, as
+       the instance buffer is attached to it */
+    GL::Mesh mesh{MeshTools::compile(Renderer<dimensions>::meshData())};
+    Containers::Array<MatrixTypeFor<dimensions, Float>> instances;
+};
+
+template<UnsignedInt dimensions> ObjectRendererBatch<dimensions>::ObjectRendererBatch(ResourceManager& manager): _manager(manager), _state{InPlaceInit} {
+    /* Shader, shared with ForceRendererBatch */
+    _shader = manager.get<GL::AbstractShaderProgram, Shaders::FlatGL<dimensions>>(Renderer<dimensions>::instancedShader());
+    if(!_shader) manager.set<GL::AbstractShaderProgram>(_shader.key(), new Shaders::FlatGL<dimensions>{typename Shaders::FlatGL<dimensions>::Configuration{}
+        .setFlags(Shaders::FlatGL<dimensions>::Flag::VertexColor|
+                  Shaders::FlatGL<dimensions>::Flag::InstancedTransformation)});
+
+    _state->mesh.addVertexBufferInstanced(_state->buffer, 1, 0,
+        typename Shaders::FlatGL<dimensions>::TransformationMatrix{});
+}
+
+/* To avoid deleting pointers to incomplete type on destruction of Resource members */
+template<UnsignedInt dimensions> ObjectRendererBatch<dimensions>::~ObjectRendererBatch() = default;
+
+template<UnsignedInt dimensions> std::size_t ObjectRendererBatch<dimensions>::instanceCount() const {
+    return _state->instances.size();
+}
+
+template<UnsignedInt dimensions> ObjectRendererBatch<dimensions>& ObjectRendererBatch<dimensions>::add(const MatrixTypeFor<dimensions, Float>& transformationMatrix) {
+    arrayAppend(_state->instances, transformationMatrix);
+    return *this;
+}
+
+template<UnsignedInt dimensions> void ObjectRendererBatch<dimensions>::draw(SceneGraph::Camera<dimensions, Float>& camera) {
+    if(_state->instances.isEmpty()) return;
+
+    _state->buffer.setData(_state->instances, GL::BufferUsage::StreamDraw);
+    _state->mesh.setInstanceCount(Int(_state->instances.size()));
+    _shader->setTransformationProjectionMatrix(camera.projectionMatrix())
+        .draw(_state->mesh);
+
+    /* Keeps the capacity for the next frame */
+    arrayResize(_state->instances, 0);
+}
+
 /* Doxygen gets confused when using {} to initialize parent object */
 template<UnsignedInt dimensions> ObjectRenderer<dimensions>::ObjectRenderer(ResourceManager& manager, SceneGraph::AbstractObject<dimensions, Float>& object, ResourceKey options, SceneGraph::DrawableGroup<dimensions, Float>* drawables): SceneGraph::Drawable<dimensions, Float>(object, drawables), _options{manager.get<ObjectRendererOptions>(options)} {
     /* Shader */
@@ -64,14 +113,24 @@ template<UnsignedInt dimensions> ObjectRenderer<dimensions>::ObjectRenderer(Reso
     if(!_mesh) manager.set<GL::Mesh>(_mesh.key(), MeshTools::compile(Renderer<dimensions>::meshData()));
 }
 
+/* Doxygen gets confused when using {} to initialize parent object */
+template<UnsignedInt dimensions> ObjectRenderer<dimensions>::ObjectRenderer(ObjectRendererBatch<dimensions>& batch, SceneGraph::AbstractObject<dimensions, Float>& object, ResourceKey options, SceneGraph::DrawableGroup<dimensions, Float>* drawables): SceneGraph::Drawable<dimensions, Float>(object, drawables), _options{batch._manager.get<ObjectRendererOptions>(options)}, _batch{&batch} {}
+
 /* To avoid deleting pointers to incomplete type on destruction of Resource members */
 template<UnsignedInt dimensions> ObjectRenderer<dimensions>::~ObjectRenderer() = default;
 
 template<UnsignedInt dimensions> void ObjectRenderer<dimensions>::draw(const MatrixTypeFor<dimensions, Float>& transformationMatrix, SceneGraph::Camera<dimensions, Float>& camera) {
+    if(_batch) {
+        _batch->add(transformationMatrix*MatrixTypeFor<dimensions, Float>::scaling(VectorTypeFor<dimensions, Float>{_options->size()}));
+        return;
+    }
+
     _shader->setTransformationProjectionMatrix(camera.projectionMatrix()*transformationMatrix*MatrixTypeFor<dimensions, Float>::scaling(VectorTypeFor<dimensions, Float>{_options->size()}))
         .draw(*_mesh);
 }
 
+template class MAGNUM_DEBUGTOOLS_EXPORT ObjectRendererBatch<2>;
+template class MAGNUM_DEBUGTOOLS_EXPORT ObjectRendererBatch<3>;
 template class MAGNUM_DEBUGTOOLS_EXPORT ObjectRenderer<2>;
 template class MAGNUM_DEBUGTOOLS_EXPORT ObjectRenderer<3>;
 
@@ -27,10 +27,12 @@
 
 #ifdef MAGNUM_TARGET_GL
 /** @file
- * @brief Class @ref Magnum::DebugTools::ObjectRenderer, @ref Magnum::DebugTools::ObjectRendererOptions, typedef @ref Magnum::DebugTools::ObjectRenderer2D, @ref Magnum::DebugTools::ObjectRenderer3D
+ * @brief Class @ref Magnum::DebugTools::ObjectRenderer, @ref Magnum::DebugTools::ObjectRendererBatch, @ref Magnum::DebugTools::ObjectRendererOptions, typedef @ref Magnum::DebugTools::ObjectRenderer2D, @ref Magnum::DebugTools::ObjectRenderer3D, @ref Magnum::DebugTools::ObjectRendererBatch2D, @ref Magnum::DebugTools::ObjectRendererBatch3D
  */
 #endif
 
+#include <Corrade/Containers/Pointer.h>
+
 #include "Magnum/Resource.h"
 #include "Magnum/DebugTools/DebugTools.h"
 #include "Magnum/DebugTools/visibility.h"
@@ -72,6 +74,103 @@ class ObjectRendererOptions {
         Float _size;
 };
 
+/**
+@brief Batch for instanced object rendering
+@m_since_latest
+
+Collects transformations of all @ref ObjectRenderer instances constructed
+with it and draws them all with a single instanced draw call in @ref draw().
+See @ref DebugTools-ObjectRenderer-batching for more information.
+
+@note This class is available only if Magnum is compiled with
+    @ref MAGNUM_TARGET_GL "TARGET_GL" and `MAGNUM_WITH_SCENEGRAPH` enabled
+    (done by default). See @ref building-features for more information.
+
+@requires_gl33 Extension @gl_extension{ARB,instanced_arrays}
+@requires_gles30 Extension @gl_extension{ANGLE,instanced_arrays},
+    @gl_extension{EXT,instanced_arrays} or @gl_extension{NV,instanced_arrays}
+    in OpenGL ES 2.0.
+@requires_webgl20 Extension @webgl_extension{ANGLE,instanced_arrays} in WebGL
+    1.0.
+
+@see @ref ObjectRendererBatch2D, @ref ObjectRendererBatch3D
+*/
+template<UnsignedInt dimensions> class ObjectRendererBatch {
+    public:
+        /**
+         * @brief Constructor
+         * @param manager   Resource manager instance
+         *
+         * Creates the instance buffer and a mesh referencing it. The shader
+         * is shared with other batches through @p manager, options of
+         * renderers added to this batch are taken from @p manager as well.
+         */
+        explicit ObjectRendererBatch(ResourceManager& manager);
+
+        /** @brief Copying is not allowed */
+        ObjectRendererBatch(const ObjectRendererBatch<dimensions>&) = delete;
+
+        /**
+         * @brief Moving is not allowed
+         *
+         * Renderers constructed with the batch reference it.
+         */
+        ObjectRendererBatch(ObjectRendererBatch<dimensions>&&) = delete;
+
+        ~ObjectRendererBatch();
+
+        /** @brief Copying is not allowed */
+        ObjectRendererBatch<dimensions>& operator=(const ObjectRendererBatch<dimensions>&) = delete;
+
+        /** @brief Moving is not allowed */
+        ObjectRendererBatch<dimensions>& operator=(ObjectRendererBatch<dimensions>&&) = delete;
+
+        /** @brief Count of instances collected since last @ref draw() */
+        std::size_t instanceCount() const;
+
+        /**
+         * @brief Add an instance
+         * @return Reference to self (for method chaining)
+         *
+         * Called from @ref ObjectRenderer with a camera-relative
+         * transformation that includes the axis size, but can be used to
+         * add axes that aren't attached to any object as well.
+         */
+        ObjectRendererBatch<dimensions>& add(const MatrixTypeFor<dimensions, Float>& transformationMatrix);
+
+        /**
+         * @brief Draw all collected instances
+         *
+         * Uploads the transformations collected since the last call to the
+         * instance buffer and draws them with a single call using
+         * projection matrix of @p camera. The collected instances are
+         * cleared afterwards. If there are no instances, the function is a
+         * no-op.
+         */
+        void draw(SceneGraph::Camera<dimensions, Float>& camera);
+
+    private:
+        friend ObjectRenderer<dimensions>;
+
+        struct State;
+
+        ResourceManager& _manager;
+        Resource<GL::AbstractShaderProgram, Shaders::FlatGL<dimensions>> _shader;
+        Containers::Pointer<State> _state;
+};
+
+/**
+@brief Two-dimensional object renderer batch
+@m_since_latest
+*/
+typedef ObjectRendererBatch<2> ObjectRendererBatch2D;
+
+/**
+@brief Three-dimensional object renderer batch
+@m_since_latest
+*/
+typedef ObjectRendererBatch<3> ObjectRendererBatch3D;
+
 /**
 @brief Object renderer
 
@@ -84,11 +183,28 @@ Example code:
 
 @snippet MagnumDebugTools-gl.cpp ObjectRenderer
 
+@section DebugTools-ObjectRenderer-batching Batched rendering
+
+By default, each renderer issues its own draw call, which becomes a bottleneck
+when visualizing thousands of objects. If the renderers are constructed with
+an @ref ObjectRendererBatch instead, their @ref SceneGraph::Drawable::draw()
+only records the camera-relative transformation and the whole batch is then
+drawn with a single instanced draw using @ref ObjectRendererBatch::draw()
+after the @ref SceneGraph::Camera::draw() call:
+
+@snippet MagnumDebugTools-gl.cpp ObjectRenderer-batch
+
+The batched renderers use a @ref Shaders::FlatGL with
+@ref Shaders::FlatGL::Flag::VertexColor and
+@relativeref{Shaders::FlatGL,Flag::InstancedTransformation} instead of a
+@ref Shaders::VertexColorGL, which doesn't support instancing.
+
 @note This class is available only if Magnum is compiled with
     @ref MAGNUM_TARGET_GL "TARGET_GL" and `MAGNUM_WITH_SCENEGRAPH` enabled
     (done by default). See @ref building-features for more information.
 
-@see @ref ObjectRenderer2D, @ref ObjectRenderer3D, @ref ObjectRendererOptions
+@see @ref ObjectRenderer2D, @ref ObjectRenderer3D, @ref ObjectRendererOptions,
+    @ref ObjectRendererBatch
 */
 template<UnsignedInt dimensions> class ObjectRenderer: public SceneGraph::Drawable<dimensions, Float> {
     public:
@@ -105,6 +221,23 @@ template<UnsignedInt dimensions> class ObjectRenderer: public SceneGraph::Drawab
          */
         explicit ObjectRenderer(ResourceManager& manager, SceneGraph::AbstractObject<dimensions, Float>& object, ResourceKey options = ResourceKey(), SceneGraph::DrawableGroup<dimensions, Float>* drawables = nullptr);
 
+        /**
+         * @brief Construct a batched renderer
+         * @param batch     Batch to add the object to
+         * @param object    Object for which to create debug renderer
+         * @param options   Options resource key, taken from the resource
+         *      manager the @p batch was constructed with
+         * @param drawables Drawable group
+         * @m_since_latest
+         *
+         * Instead of drawing, the renderer adds the object transformation to
+         * @p batch, which is then drawn with
+         * @ref ObjectRendererBatch::draw(). The batch is expected to outlive
+         * the renderer. See @ref DebugTools-ObjectRenderer-batching for more
+         * information.
+         */
+        explicit ObjectRenderer(ObjectRendererBatch<dimensions>& batch, SceneGraph::AbstractObject<dimensions, Float>& object, ResourceKey options = ResourceKey(), SceneGraph::DrawableGroup<dimensions, Float>* drawables = nullptr);
+
         #ifdef MAGNUM_BUILD_DEPRECATED
         /**
          * @brief Constructor
@@ -123,6 +256,7 @@ template<UnsignedInt dimensions> class ObjectRenderer: public SceneGraph::Drawab
         Resource<ObjectRendererOptions> _options;
         Resource<GL::AbstractShaderProgram, Shaders::VertexColorGL<dimensions>> _shader;
         Resource<GL::Mesh> _mesh;
+        ObjectRendererBatch<dimensions>* _batch{};
 };
 
 /** @brief Two-dimensional object renderer */
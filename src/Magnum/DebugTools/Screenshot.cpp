@@ -37,14 +37,26 @@
 #include "Magnum/GL/PixelFormat.h"
 #include "Magnum/Trade/AbstractImageConverter.h"
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include <mutex>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/Utility/Algorithms.h>
+
+#include "Magnum/GL/Buffer.h"
+#include "Magnum/GL/BufferImage.h"
+
+#ifdef CORRADE_BUILD_MULTITHREADED
+#include <condition_variable>
+#include <thread>
+#endif
+#endif
+
 namespace Magnum { namespace DebugTools {
 
-bool screenshot(GL::AbstractFramebuffer& framebuffer, const std::string& filename) {
-    PluginManager::Manager<Trade::AbstractImageConverter> manager;
-    return screenshot(manager, framebuffer, filename);
-}
+namespace {
 
-bool screenshot(PluginManager::Manager<Trade::AbstractImageConverter>& manager, GL::AbstractFramebuffer& framebuffer, const std::string& filename) {
+Containers::Optional<PixelFormat> genericColorReadFormat(GL::AbstractFramebuffer& framebuffer, const char* const messagePrefix) {
     /* Get the implementation-specific color read format for given framebuffer */
     const GL::PixelFormat format = framebuffer.implementationColorReadFormat();
     const GL::PixelType type = framebuffer.implementationColorReadType();
@@ -60,12 +72,24 @@ bool screenshot(PluginManager::Manager<Trade::AbstractImageConverter>& manager,
         #endif
         return {};
     }(format, type);
-    if(!genericFormat) {
-        Error{} << "DebugTools::screenshot(): can't map (" << Debug::nospace << format << Debug::nospace << "," << type << Debug::nospace << ") to a generic pixel format";
-        return false;
-    }
+    if(!genericFormat)
+        Error{} << messagePrefix << "can't map (" << Debug::nospace << format << Debug::nospace << "," << type << Debug::nospace << ") to a generic pixel format";
+
+    return genericFormat;
+}
 
-    return screenshot(manager, framebuffer, *genericFormat, filename);
+}
+
+bool screenshot(GL::AbstractFramebuffer& framebuffer, const std::string& filename) {
+    PluginManager::Manager<Trade::AbstractImageConverter> manager;
+    return screenshot(manager, framebuffer, filename);
+}
+
+bool screenshot(PluginManager::Manager<Trade::AbstractImageConverter>& manager, GL::AbstractFramebuffer& framebuffer, const std::string& filename) {
+    const Containers::Optional<PixelFormat> format = genericColorReadFormat(framebuffer, "DebugTools::screenshot():");
+    if(!format) return false;
+
+    return screenshot(manager, framebuffer, *format, filename);
 }
 
 bool screenshot(GL::AbstractFramebuffer& framebuffer, const PixelFormat format, const std::string& filename) {
@@ -86,4 +110,266 @@ bool screenshot(PluginManager::Manager<Trade::AbstractImageConverter>& manager,
     return true;
 }
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+namespace {
+
+struct Readback {
+    GL::BufferImage2D image;
+    GLsync fence;
+    PixelFormat format;
+    Containers::String filename;
+    /* Value of State::frame at the time of capture */
+    UnsignedLong frame;
+};
+
+struct Save {
+    Image2D image;
+    Containers::String filename;
+};
+
+bool save(Trade::AbstractImageConverter& converter, const Image2D& image, const Containers::String& filename) {
+    if(!converter.convertToFile(image, filename))
+        return false;
+
+    Debug{} << "DebugTools::AsyncScreenshot: saved a" << image.format() << "image of size" << image.size() << "to" << filename;
+    return true;
+}
+
+}
+
+struct AsyncScreenshot::State {
+    explicit State(PluginManager::Manager<Trade::AbstractImageConverter>& manager, UnsignedInt latency);
+    ~State();
+
+    #ifdef CORRADE_BUILD_MULTITHREADED
+    void work();
+    #endif
+
+    Containers::Pointer<Trade::AbstractImageConverter> converter;
+    UnsignedInt latency;
+
+    /* Accessed only from the GL thread. The readbacks are a FIFO, cleared
+       once there's nothing left in it. Buffers of retired readbacks together
+       with their size are kept for reuse. */
+    Containers::Array<Readback> readbacks;
+    std::size_t readbackBegin{};
+    Containers::Array<std::pair<GL::Buffer, std::size_t>> freeBuffers;
+    UnsignedLong frame{};
+
+    /* Shared with the worker thread */
+    mutable std::mutex mutex;
+    Containers::Array<Save> saves;
+    std::size_t saveBegin{};
+    /* Saves that were queued but not finished yet, including the one
+       currently being worked on */
+    std::size_t savesPending{};
+    UnsignedLong saved{}, failed{};
+    #ifdef CORRADE_BUILD_MULTITHREADED
+    std::condition_variable condition;
+    bool stop{};
+    std::thread thread;
+    #endif
+};
+
+AsyncScreenshot::State::State(PluginManager::Manager<Trade::AbstractImageConverter>& manager, const UnsignedInt latency): converter{manager.loadAndInstantiate("AnyImageConverter")}, latency{latency} {
+    #ifdef CORRADE_BUILD_MULTITHREADED
+    /* There's nothing to do without a converter */
+    if(converter) thread = std::thread{&State::work, this};
+    #endif
+}
+
+AsyncScreenshot::State::~State() {
+    /* Readbacks that weren't retired are discarded. That can happen only if
+       a non-empty instance is move-assigned over, the destructor retires
+       everything. */
+    for(std::size_t i = readbackBegin; i != readbacks.size(); ++i)
+        glDeleteSync(readbacks[i].fence);
+
+    /* The worker saves everything that's queued before exiting */
+    #ifdef CORRADE_BUILD_MULTITHREADED
+    if(thread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            stop = true;
+        }
+        condition.notify_all();
+        thread.join();
+    }
+    #endif
+}
+
+#ifdef CORRADE_BUILD_MULTITHREADED
+void AsyncScreenshot::State::work() {
+    std::unique_lock<std::mutex> lock{mutex};
+    for(;;) {
+        condition.wait(lock, [&]{ return stop || saveBegin != saves.size(); });
+        if(saveBegin == saves.size()) return;
+
+        Save save = std::move(saves[saveBegin]);
+        ++saveBegin;
+        if(saveBegin == saves.size()) {
+            arrayResize(saves, NoInit, 0);
+            saveBegin = 0;
+        }
+
+        /* Save without holding the lock so the GL thread can queue more */
+        lock.unlock();
+        const bool succeeded = DebugTools::save(*converter, save.image, save.filename);
+        lock.lock();
+
+        ++(succeeded ? saved : failed);
+        --savesPending;
+        condition.notify_all();
+    }
+}
+#endif
+
+AsyncScreenshot::AsyncScreenshot(PluginManager::Manager<Trade::AbstractImageConverter>& manager, const UnsignedInt latency) {
+    CORRADE_ASSERT(latency,
+        "DebugTools::AsyncScreenshot: expected non-zero latency", );
+
+    _state.emplace(manager, latency);
+}
+
+AsyncScreenshot::AsyncScreenshot(NoCreateT) noexcept {}
+
+AsyncScreenshot::AsyncScreenshot(AsyncScreenshot&&) noexcept = default;
+
+AsyncScreenshot::~AsyncScreenshot() {
+    if(_state) finish();
+}
+
+AsyncScreenshot& AsyncScreenshot::operator=(AsyncScreenshot&&) noexcept = default;
+
+UnsignedInt AsyncScreenshot::latency() const {
+    return _state ? _state->latency : 0;
+}
+
+bool AsyncScreenshot::capture(GL::AbstractFramebuffer& framebuffer, const Containers::StringView filename) {
+    const Containers::Optional<PixelFormat> format = genericColorReadFormat(framebuffer, "DebugTools::AsyncScreenshot::capture():");
+    if(!format) return false;
+
+    return capture(framebuffer, *format, filename);
+}
+
+bool AsyncScreenshot::capture(GL::AbstractFramebuffer& framebuffer, const PixelFormat format, const Containers::StringView filename) {
+    CORRADE_ASSERT(_state,
+        "DebugTools::AsyncScreenshot::capture(): the instance is in a moved-from state", {});
+    State& state = *_state;
+
+    /* The plugin load failure was already printed in the constructor */
+    if(!state.converter) return false;
+
+    /* Reuse a buffer from a previous readback if there's any. The read
+       reallocates it only if it's too small. */
+    GL::BufferImage2D image{NoCreate};
+    if(!state.freeBuffers.isEmpty()) {
+        std::pair<GL::Buffer, std::size_t>& buffer = state.freeBuffers.back();
+        image = GL::BufferImage2D{format, {}, std::move(buffer.first), buffer.second};
+        arrayRemoveSuffix(state.freeBuffers);
+    } else image = GL::BufferImage2D{format};
+
+    framebuffer.read(framebuffer.viewport(), image, GL::BufferUsage::StreamRead);
+    arrayAppend(state.readbacks, InPlaceInit, std::move(image), glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0), format, Containers::String{filename}, state.frame);
+    return true;
+}
+
+void AsyncScreenshot::retire(const bool wait) {
+    State& state = *_state;
+
+    while(state.readbackBegin != state.readbacks.size()) {
+        Readback& readback = state.readbacks[state.readbackBegin];
+
+        /* Wait if explicitly asked for or if the readback is pending for too
+           long already, flushing on the first wait so the fence isn't waited
+           on forever if it wasn't submitted yet. Otherwise just poll and stop
+           at the first non-signaled fence, as the following ones can't be
+           signaled either. */
+        const bool waitForThis = wait || state.frame - readback.frame >= state.latency;
+        GLbitfield flags = waitForThis ? GL_SYNC_FLUSH_COMMANDS_BIT : 0;
+        GLenum result;
+        for(;;) {
+            result = glClientWaitSync(readback.fence, flags, waitForThis ? 1000000000ull : 0);
+            if(!waitForThis || result != GL_TIMEOUT_EXPIRED) break;
+            flags = 0;
+        }
+        /* GL_WAIT_FAILED would only happen with an invalid sync object or
+           context loss, treating it as signaled to not leak the buffer */
+        if(result == GL_TIMEOUT_EXPIRED) break;
+        glDeleteSync(readback.fence);
+
+        /* Copy the data out so the buffer can be reused right away */
+        const std::size_t dataSize = readback.image.dataSize();
+        Containers::Array<char> data{NoInit, dataSize};
+        GL::Buffer& buffer = readback.image.buffer();
+        Utility::copy(buffer.mapRead(0, dataSize), Containers::arrayView(data));
+        buffer.unmap();
+
+        Save save{Image2D{readback.image.storage(), readback.format, readback.image.size(), std::move(data)}, std::move(readback.filename)};
+        arrayAppend(state.freeBuffers, InPlaceInit, readback.image.release(), dataSize);
+        ++state.readbackBegin;
+
+        #ifdef CORRADE_BUILD_MULTITHREADED
+        {
+            std::lock_guard<std::mutex> lock{state.mutex};
+            arrayAppend(state.saves, std::move(save));
+            ++state.savesPending;
+        }
+        state.condition.notify_all();
+        #else
+        ++(DebugTools::save(*state.converter, save.image, save.filename) ? state.saved : state.failed);
+        #endif
+    }
+
+    /* Everything retired, reset the FIFO to reuse its memory */
+    if(state.readbackBegin == state.readbacks.size()) {
+        arrayResize(state.readbacks, NoInit, 0);
+        state.readbackBegin = 0;
+    }
+}
+
+AsyncScreenshot& AsyncScreenshot::update() {
+    CORRADE_ASSERT(_state,
+        "DebugTools::AsyncScreenshot::update(): the instance is in a moved-from state", *this);
+
+    ++_state->frame;
+    retire(false);
+    return *this;
+}
+
+AsyncScreenshot& AsyncScreenshot::finish() {
+    CORRADE_ASSERT(_state,
+        "DebugTools::AsyncScreenshot::finish(): the instance is in a moved-from state", *this);
+    State& state = *_state;
+
+    retire(true);
+
+    #ifdef CORRADE_BUILD_MULTITHREADED
+    std::unique_lock<std::mutex> lock{state.mutex};
+    state.condition.wait(lock, [&]{ return !state.savesPending; });
+    #else
+    static_cast<void>(state);
+    #endif
+    return *this;
+}
+
+std::size_t AsyncScreenshot::pendingCount() const {
+    if(!_state) return 0;
+    std::lock_guard<std::mutex> lock{_state->mutex};
+    return _state->readbacks.size() - _state->readbackBegin + _state->savesPending;
+}
+
+UnsignedLong AsyncScreenshot::savedCount() const {
+    if(!_state) return 0;
+    std::lock_guard<std::mutex> lock{_state->mutex};
+    return _state->saved;
+}
+
+UnsignedLong AsyncScreenshot::failedCount() const {
+    if(!_state) return 0;
+    std::lock_guard<std::mutex> lock{_state->mutex};
+    return _state->failed;
+}
+#endif
+
 }}
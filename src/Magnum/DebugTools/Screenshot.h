@@ -26,13 +26,15 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::DebugTools::screenshot()
+ * @brief Function @ref Magnum::DebugTools::screenshot(), class @ref Magnum::DebugTools::AsyncScreenshot
  */
 
 #include <string>
+#include <Corrade/Containers/Pointer.h>
 #include <Corrade/PluginManager/PluginManager.h>
 
 #include "Magnum/Magnum.h"
+#include "Magnum/Tags.h"
 #include "Magnum/DebugTools/visibility.h"
 #include "Magnum/GL/GL.h"
 #include "Magnum/Trade/Trade.h"
@@ -100,6 +102,155 @@ doesn't involve costly dynamic library loading and unloading on every call.
 */
 bool MAGNUM_DEBUGTOOLS_EXPORT screenshot(PluginManager::Manager<Trade::AbstractImageConverter>& manager, GL::AbstractFramebuffer& framebuffer, PixelFormat format, const std::string& filename);
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+/**
+@brief Asynchronous screenshot saver
+@m_since_latest
+
+While @ref screenshot() reads the framebuffer directly into client memory,
+stalling the pipeline until all rendering is done, and then saves the image on
+the calling thread, this class reads the framebuffer into a
+@ref GL::BufferImage2D, guards the read with a fence and picks the data up
+a few frames later when the GPU is done with them. The images are then saved
+using the @ref Trade::AnyImageConverter "AnyImageConverter" plugin on a
+background thread. Meant for capturing many frames in a row, such as when
+recording every N-th frame of an animation.
+
+@section DebugTools-AsyncScreenshot-usage Usage
+
+Call @ref capture() at the point where you'd call @ref screenshot(), and
+@ref update() once a frame, usually right after swapping buffers. The update
+retires all readbacks whose fence got signaled. If a readback is pending for
+more than @ref latency() frames, it waits for it instead, so the amount of
+buffer memory in flight stays bounded. The destructor waits for all pending
+captures to be saved, use @ref finish() to wait explicitly:
+
+@snippet MagnumDebugTools-gl.cpp AsyncScreenshot-usage
+
+Pixel buffers are reused across captures, so once the recording reaches a
+steady state no further GPU allocations are done. The saving result is
+reported by a message printed for each file, the same as with
+@ref screenshot(), and in @ref savedCount() and @ref failedCount().
+
+@section DebugTools-AsyncScreenshot-threads Thread safety
+
+All functions are expected to be called from the thread the GL context is
+current in. The plugin manager is accessed from the background thread each
+time a file gets saved, so it's not safe to use it from other threads while
+there are captures pending. If Corrade isn't built with
+@ref CORRADE_BUILD_MULTITHREADED, the images are saved directly in
+@ref update() instead.
+
+@requires_gles30 Pixel buffer objects are not available in OpenGL ES 2.0.
+@requires_gles Buffer mapping is not available in WebGL.
+*/
+class MAGNUM_DEBUGTOOLS_EXPORT AsyncScreenshot {
+    public:
+        /**
+         * @brief Constructor
+         * @param manager   Image converter plugin manager
+         * @param latency   Max count of @ref update() calls for which a
+         *      readback can be pending before it's waited for. Expected
+         *      to be non-zero.
+         *
+         * Instantiates the @ref Trade::AnyImageConverter "AnyImageConverter"
+         * plugin. If that fails, a message is printed and all subsequent
+         * @ref capture() calls fail. The @p manager is expected to stay in
+         * scope for the whole instance lifetime.
+         */
+        explicit AsyncScreenshot(PluginManager::Manager<Trade::AbstractImageConverter>& manager, UnsignedInt latency = 2);
+
+        /**
+         * @brief Construct without creating the internal state
+         *
+         * The instance is equivalent to a moved-from state. Useful in cases
+         * where you will overwrite the instance later anyway. Move another
+         * object over it to make it useful.
+         */
+        explicit AsyncScreenshot(NoCreateT) noexcept;
+
+        /** @brief Copying is not allowed */
+        AsyncScreenshot(const AsyncScreenshot&) = delete;
+
+        /** @brief Move constructor */
+        AsyncScreenshot(AsyncScreenshot&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Calls @ref finish().
+         */
+        ~AsyncScreenshot();
+
+        /** @brief Copying is not allowed */
+        AsyncScreenshot& operator=(const AsyncScreenshot&) = delete;
+
+        /** @brief Move assignment */
+        AsyncScreenshot& operator=(AsyncScreenshot&& other) noexcept;
+
+        /** @brief Latency */
+        UnsignedInt latency() const;
+
+        /**
+         * @brief Capture a framebuffer to a file
+         *
+         * Like @ref screenshot(GL::AbstractFramebuffer&, const std::string&),
+         * queries the framebuffer pixel format and maps it to a generic
+         * @ref Magnum::PixelFormat "PixelFormat". Returns @cpp false @ce if
+         * the format can't be mapped or if the converter plugin failed to
+         * load in the constructor, @cpp true @ce otherwise. Errors during
+         * saving are reported only later by @ref update().
+         */
+        bool capture(GL::AbstractFramebuffer& framebuffer, Containers::StringView filename);
+
+        /**
+         * @brief Capture a framebuffer in requested pixel format to a file
+         *
+         * Similar to @ref capture(GL::AbstractFramebuffer&, Containers::StringView)
+         * but with an explicit pixel format.
+         */
+        bool capture(GL::AbstractFramebuffer& framebuffer, PixelFormat format, Containers::StringView filename);
+
+        /**
+         * @brief Retire finished readbacks
+         * @return Reference to self (for method chaining)
+         *
+         * Expected to be called once a frame. Copies out data of all
+         * readbacks whose fence is signaled or that are pending for
+         * @ref latency() frames already and passes them to the background
+         * thread for saving.
+         */
+        AsyncScreenshot& update();
+
+        /**
+         * @brief Wait for all captures to be saved
+         * @return Reference to self (for method chaining)
+         */
+        AsyncScreenshot& finish();
+
+        /**
+         * @brief Count of captures that weren't saved yet
+         *
+         * Includes both readbacks that weren't retired yet and images
+         * waiting for or being saved on the background thread.
+         */
+        std::size_t pendingCount() const;
+
+        /** @brief Count of successfully saved captures */
+        UnsignedLong savedCount() const;
+
+        /** @brief Count of captures that failed to save */
+        UnsignedLong failedCount() const;
+
+    private:
+        struct State;
+
+        MAGNUM_DEBUGTOOLS_LOCAL void retire(bool wait);
+
+        Containers::Pointer<State> _state;
+};
+#endif
+
 }}
 
 #endif
@@ -0,0 +1,248 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/DebugTools/AsyncReadback.h"
+#include "Magnum/GL/Buffer.h"
+#include "Magnum/GL/CubeMapTexture.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/GL/Texture.h"
+#include "Magnum/GL/TextureFormat.h"
+#include "Magnum/Math/Range.h"
+
+namespace Magnum { namespace DebugTools { namespace Test { namespace {
+
+struct AsyncReadbackGLTest: GL::OpenGLTester {
+    explicit AsyncReadbackGLTest();
+
+    void constructNoCreate();
+    void constructMove();
+
+    void bufferData();
+    void bufferSubData();
+    void bufferSubDataEmpty();
+    void bufferModifiedAfter();
+
+    void textureSubImage2D();
+    void textureSubImageCube();
+
+    void imageNotImage();
+    void dataAlreadyRetrieved();
+};
+
+AsyncReadbackGLTest::AsyncReadbackGLTest() {
+    addTests({&AsyncReadbackGLTest::constructNoCreate,
+              &AsyncReadbackGLTest::constructMove,
+
+              &AsyncReadbackGLTest::bufferData,
+              &AsyncReadbackGLTest::bufferSubData,
+              &AsyncReadbackGLTest::bufferSubDataEmpty,
+              &AsyncReadbackGLTest::bufferModifiedAfter,
+
+              &AsyncReadbackGLTest::textureSubImage2D,
+              &AsyncReadbackGLTest::textureSubImageCube,
+
+              &AsyncReadbackGLTest::imageNotImage,
+              &AsyncReadbackGLTest::dataAlreadyRetrieved});
+}
+
+constexpr Int Data[] = {2, 7, 5, 13, 25};
+
+constexpr UnsignedByte Data2D[] = { 0x00, 0x01, 0x02, 0x03,
+                                    0x04, 0x05, 0x06, 0x07,
+                                    0x08, 0x09, 0x0a, 0x0b,
+                                    0x0c, 0x0d, 0x0e, 0x0f };
+
+void AsyncReadbackGLTest::constructNoCreate() {
+    AsyncReadback readback{NoCreate};
+    CORRADE_VERIFY(!readback.isImage());
+    CORRADE_COMPARE(readback.size(), 0);
+}
+
+void AsyncReadbackGLTest::constructMove() {
+    GL::Buffer buffer;
+    buffer.setData(Data, GL::BufferUsage::StaticDraw);
+
+    AsyncReadback a = bufferDataAsync(buffer);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    AsyncReadback b = std::move(a);
+    CORRADE_COMPARE(b.size(), sizeof(Data));
+
+    AsyncReadback c{NoCreate};
+    c = std::move(b);
+    CORRADE_COMPARE(c.size(), sizeof(Data));
+
+    CORRADE_COMPARE_AS(
+        Containers::arrayCast<Int>(c.data()),
+        Containers::arrayView(Data),
+        TestSuite::Compare::Container);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void AsyncReadbackGLTest::bufferData() {
+    GL::Buffer buffer;
+    buffer.setData(Data, GL::BufferUsage::StaticDraw);
+
+    AsyncReadback readback = bufferDataAsync(buffer);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(!readback.isImage());
+    CORRADE_COMPARE(readback.size(), sizeof(Data));
+
+    /* Once waited for, the readback should stay ready */
+    readback.wait();
+    CORRADE_VERIFY(readback.isReady());
+
+    Containers::Array<char> contents = readback.data();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE_AS(
+        Containers::arrayCast<Int>(contents),
+        Containers::arrayView(Data),
+        TestSuite::Compare::Container);
+}
+
+void AsyncReadbackGLTest::bufferSubData() {
+    GL::Buffer buffer;
+    buffer.setData(Data, GL::BufferUsage::StaticDraw);
+
+    AsyncReadback readback = bufferSubDataAsync(buffer, 4, 12);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(readback.size(), 12);
+
+    /* Not waiting explicitly, data() should do that on its own */
+    Containers::Array<char> contents = readback.data();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE_AS(
+        Containers::arrayCast<Int>(contents),
+        Containers::arrayView(Data).slice(1, 4),
+        TestSuite::Compare::Container);
+}
+
+void AsyncReadbackGLTest::bufferSubDataEmpty() {
+    GL::Buffer buffer;
+    buffer.setData(Data, GL::BufferUsage::StaticDraw);
+
+    AsyncReadback readback = bufferSubDataAsync(buffer, 4, 0);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(readback.size(), 0);
+
+    Containers::Array<char> contents = readback.data();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(contents.isEmpty());
+}
+
+void AsyncReadbackGLTest::bufferModifiedAfter() {
+    GL::Buffer buffer;
+    buffer.setData(Data, GL::BufferUsage::DynamicDraw);
+
+    AsyncReadback readback = bufferDataAsync(buffer);
+
+    /* The copy was issued before the modification, so the readback should
+       see the original contents */
+    constexpr Int Zeros[5]{};
+    buffer.setSubData(0, Zeros);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_COMPARE_AS(
+        Containers::arrayCast<Int>(readback.data()),
+        Containers::arrayView(Data),
+        TestSuite::Compare::Container);
+}
+
+void AsyncReadbackGLTest::textureSubImage2D() {
+    GL::Texture2D texture;
+    texture.setImage(0, GL::TextureFormat::RGBA8, ImageView2D{PixelFormat::RGBA8Unorm, Vector2i{2}, Data2D});
+
+    AsyncReadback readback = textureSubImageAsync(texture, 0, {{}, Vector2i{2}}, PixelFormat::RGBA8Unorm);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(readback.isImage());
+    CORRADE_COMPARE(readback.size(), sizeof(Data2D));
+
+    Image2D image = readback.image();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(image.size(), Vector2i{2});
+    CORRADE_COMPARE(image.format(), PixelFormat::RGBA8Unorm);
+    CORRADE_COMPARE_AS(Containers::arrayCast<UnsignedByte>(image.data()),
+        Containers::arrayView(Data2D), TestSuite::Compare::Container);
+}
+
+void AsyncReadbackGLTest::textureSubImageCube() {
+    GL::CubeMapTexture texture;
+    ImageView2D view{PixelFormat::RGBA8Unorm, Vector2i{2}, Data2D};
+    texture.setImage(GL::CubeMapCoordinate::PositiveX, 0, GL::TextureFormat::RGBA8, view)
+        .setImage(GL::CubeMapCoordinate::NegativeX, 0, GL::TextureFormat::RGBA8, view)
+        .setImage(GL::CubeMapCoordinate::PositiveY, 0, GL::TextureFormat::RGBA8, view)
+        .setImage(GL::CubeMapCoordinate::NegativeY, 0, GL::TextureFormat::RGBA8, view)
+        .setImage(GL::CubeMapCoordinate::PositiveZ, 0, GL::TextureFormat::RGBA8, view)
+        .setImage(GL::CubeMapCoordinate::NegativeZ, 0, GL::TextureFormat::RGBA8, view);
+
+    AsyncReadback readback = textureSubImageAsync(texture, GL::CubeMapCoordinate::PositiveX, 0, {{}, Vector2i{2}}, PixelFormat::RGBA8Unorm);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(readback.isImage());
+
+    Image2D image = readback.image();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(image.size(), Vector2i{2});
+    CORRADE_COMPARE(image.format(), PixelFormat::RGBA8Unorm);
+    CORRADE_COMPARE_AS(Containers::arrayCast<UnsignedByte>(image.data()),
+        Containers::arrayView(Data2D), TestSuite::Compare::Container);
+}
+
+void AsyncReadbackGLTest::imageNotImage() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    GL::Buffer buffer;
+    buffer.setData(Data, GL::BufferUsage::StaticDraw);
+    AsyncReadback readback = bufferDataAsync(buffer);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    readback.image();
+    CORRADE_COMPARE(out.str(), "DebugTools::AsyncReadback::image(): not an image readback\n");
+}
+
+void AsyncReadbackGLTest::dataAlreadyRetrieved() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    GL::Buffer buffer;
+    buffer.setData(Data, GL::BufferUsage::StaticDraw);
+    AsyncReadback readback = bufferDataAsync(buffer);
+    readback.data();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    readback.data();
+    CORRADE_COMPARE(out.str(), "DebugTools::AsyncReadback::data(): the data were already retrieved\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::DebugTools::Test::AsyncReadbackGLTest)
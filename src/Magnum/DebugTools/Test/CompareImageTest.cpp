@@ -33,6 +33,7 @@
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/TestSuite/Compare/File.h>
+#include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/FormatStl.h>
 #include <Corrade/Utility/Path.h>
@@ -62,6 +63,7 @@ struct CompareImageTest: TestSuite::Tester {
     void calculateDeltaStorage();
     void calculateDeltaSpecials();
     void calculateDeltaSpecials3();
+    void calculateDeltaVectorized();
 
     void deltaImage();
     void deltaImageScaling();
@@ -125,6 +127,17 @@ struct CompareImageTest: TestSuite::Tester {
         Containers::Optional<PluginManager::Manager<Trade::AbstractImageConverter>> _converterManager;
 };
 
+const struct {
+    const char* name;
+    PixelFormat format;
+} CalculateDeltaVectorizedData[]{
+    {"RGBA8Unorm", PixelFormat::RGBA8Unorm},
+    {"RGBA16F", PixelFormat::RGBA16F},
+    {"R32F", PixelFormat::R32F},
+    /* Not vectorized, to verify the fallback behaves the same */
+    {"RGB8Unorm", PixelFormat::RGB8Unorm},
+};
+
 CompareImageTest::CompareImageTest() {
     addTests({&CompareImageTest::formatUnknown,
               &CompareImageTest::formatPackedDepthStencil,
@@ -133,9 +146,12 @@ CompareImageTest::CompareImageTest() {
               &CompareImageTest::calculateDelta,
               &CompareImageTest::calculateDeltaStorage,
               &CompareImageTest::calculateDeltaSpecials,
-              &CompareImageTest::calculateDeltaSpecials3,
+              &CompareImageTest::calculateDeltaSpecials3});
 
-              &CompareImageTest::deltaImage,
+    addInstancedTests({&CompareImageTest::calculateDeltaVectorized},
+        Containers::arraySize(CalculateDeltaVectorizedData));
+
+    addTests({&CompareImageTest::deltaImage,
               &CompareImageTest::deltaImageScaling,
               &CompareImageTest::deltaImageColors,
               &CompareImageTest::deltaImageSpecials,
@@ -386,6 +402,58 @@ void CompareImageTest::calculateDeltaSpecials3() {
     CORRADE_COMPARE(mean, -Constants::nan());
 }
 
+void CompareImageTest::calculateDeltaVectorized() {
+    auto&& data = CalculateDeltaVectorizedData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Enough pixels for more than one batch to get multiple threads used,
+       width not divisible by four to have a remainder in every row */
+    const Vector2i size{1027, 67};
+    const std::size_t pixelSize = pixelFormatSize(data.format);
+
+    /* Random bits, which for the floating-point formats give also NaNs,
+       infinities and overflows to test that they get handled */
+    Containers::Array<char> actualData{NoInit, size.product()*pixelSize};
+    Containers::Array<char> expectedData{NoInit, size.product()*pixelSize};
+    UnsignedInt seed = 1;
+    for(std::size_t i = 0; i != actualData.size(); ++i) {
+        seed = seed*1103515245u + 12345u;
+        actualData[i] = char(seed >> 16);
+        /* Make most of the expected bytes the same or just slightly
+           different in order to have also small deltas */
+        expectedData[i] = i % 3 ? actualData[i] : char(actualData[i] + (seed >> 28));
+    }
+    /* RGB8 rows wouldn't be four-byte aligned */
+    const PixelStorage storage = PixelStorage{}.setAlignment(1);
+    const ImageView2D actual{storage, data.format, size, actualData};
+    const ImageView2D expected{storage, data.format, size, expectedData};
+
+    /* Every second pixel of an image twice as wide makes the view strided,
+       which forces the scalar path to be used as a reference */
+    Containers::Array<char> actualStridedData{ValueInit, actualData.size()*2};
+    const Containers::StridedArrayView3D<char> actualStrided = MutableImageView2D{storage, data.format, {size.x()*2, size.y()}, actualStridedData}.pixels().every({1, 2, 1});
+    Utility::copy(actual.pixels(), actualStrided);
+
+    Containers::Array<Float> expectedDelta;
+    Float expectedMax, expectedMean;
+    std::tie(expectedDelta, expectedMax, expectedMean) = Implementation::calculateImageDelta(data.format, actualStrided, expected, 1);
+
+    for(UnsignedInt threadCount: {1u, 4u, 0u}) {
+        CORRADE_ITERATION(threadCount);
+
+        Containers::Array<Float> delta;
+        Float max, mean;
+        std::tie(delta, max, mean) = Implementation::calculateImageDelta(data.format, actual.pixels(), expected, threadCount);
+
+        /* Compare the bits to verify the results are really identical, also
+           for NaNs */
+        CORRADE_COMPARE_AS(Containers::arrayCast<const UnsignedInt>(delta),
+            Containers::arrayCast<const UnsignedInt>(expectedDelta),
+            TestSuite::Compare::Container);
+        CORRADE_COMPARE(max, expectedMax);
+    }
+}
+
 void CompareImageTest::deltaImage() {
     std::ostringstream out;
     Debug d{&out, Debug::Flag::DisableColors};
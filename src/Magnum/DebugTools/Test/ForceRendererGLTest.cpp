@@ -46,9 +46,8 @@
 
 #include "configure.h"
 
-#ifdef CORRADE_TARGET_ANDROID
 #include "Magnum/GL/Context.h"
-#endif
+#include "Magnum/GL/Extensions.h"
 
 namespace Magnum { namespace DebugTools { namespace Test { namespace {
 
@@ -62,9 +61,18 @@ struct ForceRendererGLTest: GL::OpenGLTester {
         PluginManager::Manager<Trade::AbstractImporter> _manager{"nonexistent"};
 };
 
+const struct {
+    const char* name;
+    bool batched;
+} RenderData[]{
+    {"", false},
+    {"batched", true}
+};
+
 ForceRendererGLTest::ForceRendererGLTest() {
-    addTests({&ForceRendererGLTest::render2D,
-              &ForceRendererGLTest::render3D});
+    addInstancedTests({&ForceRendererGLTest::render2D,
+                       &ForceRendererGLTest::render3D},
+        Containers::arraySize(RenderData));
 
     /* Load the plugins directly from the build tree. Otherwise they're either
        static and already loaded or not present in the build tree */
@@ -78,7 +86,29 @@ ForceRendererGLTest::ForceRendererGLTest() {
 
 using namespace Math::Literals;
 
+bool isInstancingSupported() {
+    #ifndef MAGNUM_TARGET_GLES
+    return GL::Context::current().isExtensionSupported<GL::Extensions::ARB::instanced_arrays>();
+    #elif defined(MAGNUM_TARGET_GLES2)
+    #ifndef MAGNUM_TARGET_WEBGL
+    return GL::Context::current().isExtensionSupported<GL::Extensions::ANGLE::instanced_arrays>() ||
+        GL::Context::current().isExtensionSupported<GL::Extensions::EXT::instanced_arrays>() ||
+        GL::Context::current().isExtensionSupported<GL::Extensions::NV::instanced_arrays>();
+    #else
+    return GL::Context::current().isExtensionSupported<GL::Extensions::ANGLE::instanced_arrays>();
+    #endif
+    #else
+    return true;
+    #endif
+}
+
 void ForceRendererGLTest::render2D() {
+    auto&& data = RenderData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if(data.batched && !isInstancingSupported())
+        CORRADE_SKIP("Instanced arrays are not supported.");
+
     SceneGraph::Scene<SceneGraph::MatrixTransformation2D> scene;
 
     SceneGraph::DrawableGroup2D drawables;
@@ -91,7 +121,12 @@ void ForceRendererGLTest::render2D() {
     SceneGraph::Object<SceneGraph::MatrixTransformation2D> object{&scene};
     object.translate({-1.0f, -1.0f});
     Vector2 force{2.0f, 2.0f};
-    ForceRenderer2D renderer{manager, object, {}, force, "my", &drawables};
+    Containers::Optional<ForceRendererBatch2D> batch;
+    Containers::Optional<ForceRenderer2D> renderer;
+    if(data.batched) {
+        batch.emplace(manager);
+        renderer.emplace(*batch, object, Vector2{}, force, "my", &drawables);
+    } else renderer.emplace(manager, object, Vector2{}, force, "my", &drawables);
 
     GL::Renderbuffer color;
     color.setStorage(
@@ -107,6 +142,7 @@ void ForceRendererGLTest::render2D() {
         .bind();
 
     camera.draw(drawables);
+    if(batch) batch->draw(camera);
 
     MAGNUM_VERIFY_NO_GL_ERROR();
 
@@ -131,6 +167,12 @@ void ForceRendererGLTest::render2D() {
 }
 
 void ForceRendererGLTest::render3D() {
+    auto&& data = RenderData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if(data.batched && !isInstancingSupported())
+        CORRADE_SKIP("Instanced arrays are not supported.");
+
     SceneGraph::Scene<SceneGraph::MatrixTransformation3D> scene;
 
     SceneGraph::DrawableGroup3D drawables;
@@ -147,7 +189,12 @@ void ForceRendererGLTest::render3D() {
         .rotateY(-90.0_degf)
         .translate({-0.5f, -1.0f, 1.0f});
     Vector3 force{2.0f, 2.0f, 0.0f};
-    ForceRenderer3D renderer{manager, object, {}, force, "my", &drawables};
+    Containers::Optional<ForceRendererBatch3D> batch;
+    Containers::Optional<ForceRenderer3D> renderer;
+    if(data.batched) {
+        batch.emplace(manager);
+        renderer.emplace(*batch, object, Vector3{}, force, "my", &drawables);
+    } else renderer.emplace(manager, object, Vector3{}, force, "my", &drawables);
 
     GL::Renderbuffer color;
     color.setStorage(
@@ -163,6 +210,7 @@ void ForceRendererGLTest::render3D() {
         .bind();
 
     camera.draw(drawables);
+    if(batch) batch->draw(camera);
 
     MAGNUM_VERIFY_NO_GL_ERROR();
 
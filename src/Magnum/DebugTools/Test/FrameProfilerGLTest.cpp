@@ -34,6 +34,7 @@
 #include "Magnum/GL/OpenGLTester.h"
 #include "Magnum/GL/Renderbuffer.h"
 #include "Magnum/GL/RenderbufferFormat.h"
+#include "Magnum/GL/TimerQueryPool.h"
 #include "Magnum/MeshTools/Compile.h"
 #include "Magnum/Primitives/Cube.h"
 #include "Magnum/Shaders/FlatGL.h"
@@ -54,6 +55,8 @@ struct FrameProfilerGLTest: GL::OpenGLTester {
     void primitiveClipRatioDivisionByZero();
     void primitiveClipRatioNegative();
     #endif
+
+    void timerQueryPool();
 };
 
 using namespace Math::Literals;
@@ -80,6 +83,8 @@ FrameProfilerGLTest::FrameProfilerGLTest() {
               &FrameProfilerGLTest::primitiveClipRatioDivisionByZero,
               &FrameProfilerGLTest::primitiveClipRatioNegative});
     #endif
+
+    addTests({&FrameProfilerGLTest::timerQueryPool});
 }
 
 void FrameProfilerGLTest::test() {
@@ -305,6 +310,68 @@ void FrameProfilerGLTest::primitiveClipRatioNegative() {
 }
 #endif
 
+void FrameProfilerGLTest::timerQueryPool() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::timer_query>())
+        CORRADE_SKIP(GL::Extensions::ARB::timer_query::string() << "is not supported.");
+    #elif defined(MAGNUM_TARGET_WEBGL) && !defined(MAGNUM_TARGET_GLES2)
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::disjoint_timer_query_webgl2>())
+        CORRADE_SKIP(GL::Extensions::EXT::disjoint_timer_query_webgl2::string() << "is not supported.");
+    #else
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::disjoint_timer_query>())
+        CORRADE_SKIP(GL::Extensions::EXT::disjoint_timer_query::string() << "is not supported.");
+    #endif
+
+    /* Bind some FB to avoid errors on contexts w/o default FB */
+    GL::Renderbuffer color;
+    color.setStorage(
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        GL::RenderbufferFormat::RGBA8,
+        #else
+        GL::RenderbufferFormat::RGBA4,
+        #endif
+        Vector2i{32});
+    GL::Framebuffer fb{{{}, Vector2i{32}}};
+    fb.attachRenderbuffer(GL::Framebuffer::ColorAttachment{0}, color)
+      .bind();
+
+    GL::Mesh mesh = MeshTools::compile(Primitives::cubeSolid());
+    Shaders::FlatGL3D shader;
+
+    GL::TimerQueryPool pool{3, 4};
+    FrameProfiler profiler{{
+        timerQueryPoolMeasurement(pool, "draw"),
+        timerQueryPoolMeasurement(pool, "nothing")
+    }, 4};
+    CORRADE_COMPARE(pool.scopeCount(), 2);
+    CORRADE_COMPARE(profiler.measurementCount(), 2);
+    CORRADE_COMPARE(profiler.measurementName(0), "draw");
+    CORRADE_COMPARE(profiler.measurementUnits(0), FrameProfiler::Units::Nanoseconds);
+    CORRADE_COMPARE(profiler.measurementName(1), "nothing");
+
+    /* Render until the profiler has all frames filled with pool results */
+    for(std::size_t i = 0; i != 100 && !(pool.hasResults() && pool.resultFrame() >= 4); ++i) {
+        profiler.beginFrame();
+        pool.beginFrame();
+        pool.begin("draw");
+        shader.draw(mesh);
+        pool.end();
+        pool.endFrame();
+        profiler.endFrame();
+
+        Utility::System::sleep(10);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* The last recorded value is what the pool has */
+    CORRADE_VERIFY(pool.hasResults());
+    CORRADE_COMPARE(profiler.measurementData(0, 3), pool.duration(0));
+    CORRADE_VERIFY(pool.duration(0));
+    /* The scope was never entered */
+    CORRADE_COMPARE(profiler.measurementMean(1), 0.0);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::DebugTools::Test::FrameProfilerGLTest)
@@ -27,12 +27,19 @@
 #include <Corrade/Containers/Pointer.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/TestSuite/Compare/String.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/System.h>
 
+#include "Magnum/ProfileScope.h"
 #include "Magnum/DebugTools/FrameProfiler.h"
 
+#ifdef MAGNUM_TARGET_VK
+#include "Magnum/Vk/CommandBuffer.h"
+#include "Magnum/Vk/Device.h"
+#endif
+
 namespace Magnum { namespace DebugTools { namespace Test { namespace {
 
 struct FrameProfilerTest: TestSuite::Tester {
@@ -61,10 +68,29 @@ struct FrameProfilerTest: TestSuite::Tester {
 
     void statistics();
 
+    void scopes();
+    void scopesEnableDisable();
+    void scopesAcrossFrames();
+    void scopesMove();
+    void scopesOutOfBounds();
+    void scopesStatistics();
+
+    void traceEmpty();
+    void trace();
+    void traceStartedLater();
+    void traceFrameCount();
+    void traceSetup();
+    void traceEscape();
+    void saveTraceFailed();
+
     #ifdef MAGNUM_TARGET_GL
     void gl();
     void glNotEnabled();
     #endif
+    #ifdef MAGNUM_TARGET_VK
+    void vk();
+    void vkNotEnabled();
+    #endif
 
     void debugUnits();
     #ifdef MAGNUM_TARGET_GL
@@ -74,6 +100,10 @@ struct FrameProfilerTest: TestSuite::Tester {
     void configurationGLValue();
     void configurationGLValues();
     #endif
+    #ifdef MAGNUM_TARGET_VK
+    void debugVkValue();
+    void debugVkValues();
+    #endif
 };
 
 struct {
@@ -109,6 +139,20 @@ struct {
 };
 #endif
 
+#ifdef MAGNUM_TARGET_VK
+struct {
+    const char* name;
+    FrameProfilerVk::Values values;
+    UnsignedInt measurementCount;
+    UnsignedInt measurementDelay;
+} VkData[]{
+    {"empty", {}, 0, 1},
+    {"frame time", FrameProfilerVk::Value::FrameTime, 1, 2},
+    {"cpu duration", FrameProfilerVk::Value::CpuDuration, 1, 1},
+    {"frame time + cpu duration", FrameProfilerVk::Value::FrameTime|FrameProfilerVk::Value::CpuDuration, 2, 2}
+};
+#endif
+
 FrameProfilerTest::FrameProfilerTest() {
     addTests({&FrameProfilerTest::defaultConstructed,
               &FrameProfilerTest::noMeasurements});
@@ -133,17 +177,39 @@ FrameProfilerTest::FrameProfilerTest() {
               &FrameProfilerTest::dataNotAvailableYet,
               &FrameProfilerTest::meanNotAvailableYet,
 
-              &FrameProfilerTest::statistics});
+              &FrameProfilerTest::statistics,
+
+              &FrameProfilerTest::scopes,
+              &FrameProfilerTest::scopesEnableDisable,
+              &FrameProfilerTest::scopesAcrossFrames,
+              &FrameProfilerTest::scopesMove,
+              &FrameProfilerTest::scopesOutOfBounds,
+              &FrameProfilerTest::scopesStatistics,
+
+              &FrameProfilerTest::traceEmpty,
+              &FrameProfilerTest::trace,
+              &FrameProfilerTest::traceStartedLater,
+              &FrameProfilerTest::traceFrameCount,
+              &FrameProfilerTest::traceSetup,
+              &FrameProfilerTest::traceEscape,
+              &FrameProfilerTest::saveTraceFailed});
 
     #ifdef MAGNUM_TARGET_GL
     addInstancedTests({&FrameProfilerTest::gl},
         Containers::arraySize(GLData));
     #endif
+    #ifdef MAGNUM_TARGET_VK
+    addInstancedTests({&FrameProfilerTest::vk},
+        Containers::arraySize(VkData));
+    #endif
 
     addTests({
               #ifdef MAGNUM_TARGET_GL
               &FrameProfilerTest::glNotEnabled,
               #endif
+              #ifdef MAGNUM_TARGET_VK
+              &FrameProfilerTest::vkNotEnabled,
+              #endif
 
               &FrameProfilerTest::debugUnits,
               #ifdef MAGNUM_TARGET_GL
@@ -151,7 +217,11 @@ FrameProfilerTest::FrameProfilerTest() {
               &FrameProfilerTest::debugGLValues,
 
               &FrameProfilerTest::configurationGLValue,
-              &FrameProfilerTest::configurationGLValues
+              &FrameProfilerTest::configurationGLValues,
+              #endif
+              #ifdef MAGNUM_TARGET_VK
+              &FrameProfilerTest::debugVkValue,
+              &FrameProfilerTest::debugVkValues,
               #endif
               });
 }
@@ -1092,6 +1162,466 @@ void FrameProfilerTest::statistics() {
         "  CPU usage: -.-- %");
 }
 
+void FrameProfilerTest::scopes() {
+    FrameProfiler profiler{{}, 2};
+    profiler.enableScopes();
+    CORRADE_COMPARE(profiler.scopeCount(), 0);
+
+    profiler.beginFrame();
+    {
+        ProfileScope a{"A"};
+        {
+            ProfileScope b{"B"};
+            Utility::System::sleep(1);
+        } {
+            ProfileScope b{"B"};
+        }
+    } {
+        ProfileScope c{"C"};
+    }
+    profiler.endFrame();
+
+    CORRADE_COMPARE(profiler.scopeCount(), 3);
+    CORRADE_COMPARE(profiler.scopeName(0), "A");
+    CORRADE_COMPARE(profiler.scopeDepth(0), 0);
+    CORRADE_COMPARE(profiler.scopeCallCountMean(0), 1.0);
+    CORRADE_COMPARE(profiler.scopeName(1), "B");
+    CORRADE_COMPARE(profiler.scopeDepth(1), 1);
+    CORRADE_COMPARE(profiler.scopeCallCountMean(1), 2.0);
+    CORRADE_COMPARE(profiler.scopeName(2), "C");
+    CORRADE_COMPARE(profiler.scopeDepth(2), 0);
+    CORRADE_COMPARE(profiler.scopeCallCountMean(2), 1.0);
+
+    /* The slept millisecond is included in both */
+    CORRADE_COMPARE_AS(profiler.scopeDurationMean(1), 1000000.0,
+        TestSuite::Compare::GreaterOrEqual);
+    CORRADE_COMPARE_AS(profiler.scopeDurationMean(0), profiler.scopeDurationMean(1),
+        TestSuite::Compare::GreaterOrEqual);
+
+    /* A new child of A gets ordered before C, a scope with the same name in
+       a different parent is a different node */
+    profiler.beginFrame();
+    {
+        ProfileScope a{"A"};
+        ProfileScope d{"D"};
+        ProfileScope c{"C"};
+    }
+    profiler.endFrame();
+
+    CORRADE_COMPARE(profiler.scopeCount(), 5);
+    CORRADE_COMPARE(profiler.scopeName(0), "A");
+    CORRADE_COMPARE(profiler.scopeCallCountMean(0), 1.0);
+    CORRADE_COMPARE(profiler.scopeName(1), "B");
+    CORRADE_COMPARE(profiler.scopeCallCountMean(1), 1.0);
+    CORRADE_COMPARE(profiler.scopeName(2), "D");
+    CORRADE_COMPARE(profiler.scopeDepth(2), 1);
+    CORRADE_COMPARE(profiler.scopeCallCountMean(2), 0.5);
+    CORRADE_COMPARE(profiler.scopeName(3), "C");
+    CORRADE_COMPARE(profiler.scopeDepth(3), 2);
+    CORRADE_COMPARE(profiler.scopeCallCountMean(3), 0.5);
+    CORRADE_COMPARE(profiler.scopeName(4), "C");
+    CORRADE_COMPARE(profiler.scopeDepth(4), 0);
+    CORRADE_COMPARE(profiler.scopeCallCountMean(4), 0.5);
+
+    /* The first frame falls out of the moving average */
+    profiler.beginFrame();
+    profiler.endFrame();
+
+    CORRADE_COMPARE(profiler.scopeCount(), 5);
+    CORRADE_COMPARE(profiler.scopeCallCountMean(0), 0.5);
+    CORRADE_COMPARE(profiler.scopeCallCountMean(1), 0.0);
+    CORRADE_COMPARE(profiler.scopeDurationMean(1), 0.0);
+    CORRADE_COMPARE(profiler.scopeCallCountMean(2), 0.5);
+    CORRADE_COMPARE(profiler.scopeCallCountMean(3), 0.5);
+    CORRADE_COMPARE(profiler.scopeCallCountMean(4), 0.0);
+}
+
+void FrameProfilerTest::scopesEnableDisable() {
+    FrameProfiler profiler{{}, 5};
+    CORRADE_VERIFY(!profiler.areScopesEnabled());
+
+    /* Not recorded when nothing consumes the scopes */
+    {
+        ProfileScope a{"A"};
+        CORRADE_VERIFY(!a.isRecorded());
+    }
+
+    profiler.enableScopes();
+    CORRADE_VERIFY(profiler.areScopesEnabled());
+
+    profiler.beginFrame();
+    {
+        ProfileScope a{"A"};
+        CORRADE_VERIFY(a.isRecorded());
+    }
+    profiler.endFrame();
+    CORRADE_COMPARE(profiler.scopeCount(), 1);
+
+    /* Enabling the profiler again discards the scope tree as well */
+    profiler.enable();
+    CORRADE_VERIFY(profiler.areScopesEnabled());
+    CORRADE_COMPARE(profiler.scopeCount(), 0);
+
+    /* Scopes recorded before enableScopes() are discarded */
+    {
+        ProfileScope a{"A"};
+    }
+    profiler.enableScopes();
+    profiler.beginFrame();
+    profiler.endFrame();
+    CORRADE_COMPARE(profiler.scopeCount(), 0);
+
+    /* A disabled profiler doesn't consume anything */
+    profiler.disable();
+    {
+        ProfileScope a{"A"};
+    }
+    profiler.beginFrame();
+    profiler.endFrame();
+    CORRADE_COMPARE(profiler.scopeCount(), 0);
+
+    profiler.enable();
+    profiler.disableScopes();
+    CORRADE_VERIFY(!profiler.areScopesEnabled());
+    CORRADE_COMPARE(profiler.scopeCount(), 0);
+    {
+        ProfileScope a{"A"};
+        CORRADE_VERIFY(!a.isRecorded());
+    }
+
+    /* Statistics don't mention scopes if they're not enabled */
+    CORRADE_COMPARE(profiler.statistics(), "Last 0 frames:");
+}
+
+void FrameProfilerTest::scopesAcrossFrames() {
+    FrameProfiler profiler{{}, 5};
+    profiler.enableScopes();
+
+    /* The scope is accounted to the frame it ended in */
+    Containers::Pointer<ProfileScope> a;
+    profiler.beginFrame();
+    a.emplace("A");
+    profiler.endFrame();
+    CORRADE_COMPARE(profiler.scopeCount(), 1);
+    CORRADE_COMPARE(profiler.scopeCallCountMean(0), 0.0);
+
+    profiler.beginFrame();
+    a = nullptr;
+    profiler.endFrame();
+    CORRADE_COMPARE(profiler.scopeCallCountMean(0), 0.5);
+
+    /* A scope open during a reset has its end ignored, while a scope nested
+       in it is treated as top-level */
+    a.emplace("A");
+    profiler.enable();
+    profiler.beginFrame();
+    {
+        ProfileScope b{"B"};
+    }
+    a = nullptr;
+    profiler.endFrame();
+    CORRADE_COMPARE(profiler.scopeCount(), 1);
+    CORRADE_COMPARE(profiler.scopeName(0), "B");
+    CORRADE_COMPARE(profiler.scopeDepth(0), 0);
+    CORRADE_COMPARE(profiler.scopeCallCountMean(0), 1.0);
+}
+
+void FrameProfilerTest::scopesMove() {
+    FrameProfiler a{{}, 5};
+    a.enableScopes();
+
+    FrameProfiler b{std::move(a)};
+    CORRADE_VERIFY(!a.areScopesEnabled());
+    CORRADE_VERIFY(b.areScopesEnabled());
+
+    b.beginFrame();
+    {
+        ProfileScope scope{"A"};
+        CORRADE_VERIFY(scope.isRecorded());
+    }
+    b.endFrame();
+    CORRADE_COMPARE(b.scopeCount(), 1);
+
+    FrameProfiler c;
+    c = std::move(b);
+    CORRADE_VERIFY(!b.areScopesEnabled());
+    CORRADE_VERIFY(c.areScopesEnabled());
+    CORRADE_COMPARE(c.scopeCount(), 1);
+
+    /* After the last profiler with scopes is gone, nothing is recorded */
+    c.disableScopes();
+    {
+        ProfileScope scope{"A"};
+        CORRADE_VERIFY(!scope.isRecorded());
+    }
+}
+
+void FrameProfilerTest::scopesOutOfBounds() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    FrameProfiler profiler{{}, 1};
+    profiler.enableScopes();
+    profiler.beginFrame();
+    {
+        ProfileScope a{"A"};
+    }
+    profiler.endFrame();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    profiler.scopeName(1);
+    profiler.scopeDepth(1);
+    profiler.scopeDurationMean(1);
+    profiler.scopeCallCountMean(1);
+    CORRADE_COMPARE(out.str(),
+        "DebugTools::FrameProfiler::scopeName(): index 1 out of range for 1 scopes\n"
+        "DebugTools::FrameProfiler::scopeDepth(): index 1 out of range for 1 scopes\n"
+        "DebugTools::FrameProfiler::scopeDurationMean(): index 1 out of range for 1 scopes\n"
+        "DebugTools::FrameProfiler::scopeCallCountMean(): index 1 out of range for 1 scopes\n");
+}
+
+void FrameProfilerTest::scopesStatistics() {
+    FrameProfiler profiler{{
+        FrameProfiler::Measurement{"Bloat", FrameProfiler::Units::Bytes,
+            [](void*) {},
+            [](void*) { return UnsignedLong{1024}; }, nullptr}
+    }, 4};
+    profiler.enableScopes();
+    CORRADE_COMPARE(profiler.statistics(),
+        "Last 0 frames:\n"
+        "  Bloat: -.-- B\n"
+        "  Scopes:");
+
+    profiler.beginFrame();
+    {
+        ProfileScope draw{"Draw"};
+        for(std::size_t i = 0; i != 3; ++i) {
+            ProfileScope mesh{"Mesh"};
+        }
+    }
+    profiler.endFrame();
+
+    /* Durations depend on the machine, check just the structure */
+    const std::string statistics = profiler.statistics();
+    CORRADE_COMPARE_AS(statistics,
+        "Last 1 frames:\n"
+        "  Bloat: 1.00 kB\n"
+        "  Scopes:\n"
+        "    Draw: ",
+        TestSuite::Compare::StringHasPrefix);
+    CORRADE_COMPARE_AS(statistics,
+        "s (1.00 calls)\n"
+        "      Mesh: ",
+        TestSuite::Compare::StringContains);
+    CORRADE_COMPARE_AS(statistics,
+        "s (3.00 calls)",
+        TestSuite::Compare::StringHasSuffix);
+}
+
+void FrameProfilerTest::traceEmpty() {
+    FrameProfiler profiler;
+    CORRADE_VERIFY(!profiler.isTracing());
+    CORRADE_COMPARE(profiler.traceFrameCount(), 0);
+    CORRADE_COMPARE(profiler.traceJson(), "{\"traceEvents\":[]}");
+
+    /* Stopping a trace that isn't running is a no-op */
+    profiler.stopTrace();
+    CORRADE_VERIFY(!profiler.isTracing());
+}
+
+/* An immediate duration measurement and a delayed counter */
+Containers::Array<FrameProfiler::Measurement> traceMeasurements() {
+    return Containers::array({
+        FrameProfiler::Measurement{"Duration",
+            FrameProfiler::Units::Nanoseconds,
+            [](void*) {},
+            [](void*) { return UnsignedLong{1500}; }, nullptr},
+        FrameProfiler::Measurement{"Ratio",
+            FrameProfiler::Units::RatioThousandths, 2,
+            [](void*, UnsignedInt) {},
+            [](void*, UnsignedInt) {},
+            [](void*, UnsignedInt, UnsignedInt) { return UnsignedLong{750}; }, nullptr}
+    });
+}
+
+void FrameProfilerTest::trace() {
+    FrameProfiler profiler{traceMeasurements(), 5};
+    profiler.enableScopes();
+
+    profiler.startTrace();
+    CORRADE_VERIFY(profiler.isTracing());
+    CORRADE_COMPARE(profiler.traceFrameCount(), 0);
+
+    for(std::size_t i = 0; i != 3; ++i) {
+        profiler.beginFrame();
+        {
+            ProfileScope a{"A"};
+        }
+        profiler.endFrame();
+    }
+    CORRADE_COMPARE(profiler.traceFrameCount(), 3);
+
+    profiler.stopTrace();
+    CORRADE_VERIFY(!profiler.isTracing());
+
+    /* Frames after the trace is stopped are not recorded, but the trace is
+       kept */
+    profiler.beginFrame();
+    profiler.endFrame();
+    CORRADE_COMPARE(profiler.traceFrameCount(), 3);
+
+    /* Times depend on the machine, check just the parts that don't */
+    const std::string json = profiler.traceJson();
+    CORRADE_COMPARE_AS(json,
+        "{\"traceEvents\":[\n"
+        "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":0,\"args\":{\"name\":\"Frames\"}},\n"
+        "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":1,\"args\":{\"name\":\"Duration\"}},\n"
+        "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":",
+        TestSuite::Compare::StringHasPrefix);
+    CORRADE_COMPARE_AS(json,
+        ",\"args\":{\"name\":\"Thread ",
+        TestSuite::Compare::StringContains);
+    CORRADE_COMPARE_AS(json,
+        "{\"name\":\"Frame 0\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":",
+        TestSuite::Compare::StringContains);
+    CORRADE_COMPARE_AS(json,
+        "{\"name\":\"Frame 2\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":",
+        TestSuite::Compare::StringContains);
+    CORRADE_VERIFY(json.find("\"Frame 3\"") == std::string::npos);
+    CORRADE_COMPARE_AS(json,
+        ",\"dur\":1.500}",
+        TestSuite::Compare::StringContains);
+    CORRADE_COMPARE_AS(json,
+        "{\"name\":\"Ratio\",\"ph\":\"C\",\"pid\":0,\"ts\":",
+        TestSuite::Compare::StringContains);
+    CORRADE_COMPARE_AS(json,
+        ",\"args\":{\"value\":0.75}}",
+        TestSuite::Compare::StringContains);
+    CORRADE_COMPARE_AS(json,
+        "{\"name\":\"A\",\"ph\":\"X\",\"pid\":0,\"tid\":",
+        TestSuite::Compare::StringContains);
+    CORRADE_COMPARE_AS(json,
+        "\n]}",
+        TestSuite::Compare::StringHasSuffix);
+
+    /* Three frames, three durations, three scopes but only two ratios as
+       the third is delayed past the end of the trace */
+    std::size_t slices = 0, counters = 0;
+    for(std::size_t pos = 0; (pos = json.find("\"ph\":\"X\"", pos)) != std::string::npos; ++pos)
+        ++slices;
+    for(std::size_t pos = 0; (pos = json.find("\"ph\":\"C\"", pos)) != std::string::npos; ++pos)
+        ++counters;
+    CORRADE_COMPARE(slices, 9);
+    CORRADE_COMPARE(counters, 2);
+
+    /* Starting again discards the previous trace */
+    profiler.startTrace();
+    CORRADE_COMPARE(profiler.traceFrameCount(), 0);
+    CORRADE_VERIFY(profiler.traceJson().find("\"Frame 0\"") == std::string::npos);
+}
+
+void FrameProfilerTest::traceStartedLater() {
+    FrameProfiler profiler{traceMeasurements(), 5};
+    profiler.enableScopes();
+
+    /* Scope recorded before the trace is started isn't included */
+    profiler.beginFrame();
+    {
+        ProfileScope a{"A"};
+    }
+    profiler.endFrame();
+    {
+        ProfileScope b{"B"};
+    }
+
+    profiler.startTrace();
+    profiler.beginFrame();
+    profiler.endFrame();
+    CORRADE_COMPARE(profiler.traceFrameCount(), 1);
+
+    /* The delayed measurement is for the frame before the trace started, so
+       it's not included */
+    const std::string json = profiler.traceJson();
+    CORRADE_VERIFY(json.find("\"ph\":\"C\"") == std::string::npos);
+    CORRADE_VERIFY(json.find("\"name\":\"B\"") == std::string::npos);
+    CORRADE_COMPARE_AS(json,
+        ",\"dur\":1.500}",
+        TestSuite::Compare::StringContains);
+
+    /* Scopes enabled during the trace get traced as well */
+    profiler.disableScopes();
+    profiler.enableScopes();
+    profiler.beginFrame();
+    {
+        ProfileScope c{"C"};
+    }
+    profiler.endFrame();
+    CORRADE_COMPARE_AS(profiler.traceJson(),
+        "{\"name\":\"C\",\"ph\":\"X\"",
+        TestSuite::Compare::StringContains);
+}
+
+void FrameProfilerTest::traceFrameCount() {
+    FrameProfiler profiler{traceMeasurements(), 5};
+
+    profiler.startTrace(2);
+    for(std::size_t i = 0; i != 5; ++i) {
+        profiler.beginFrame();
+        profiler.endFrame();
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(profiler.isTracing(), i < 1);
+    }
+
+    CORRADE_COMPARE(profiler.traceFrameCount(), 2);
+}
+
+void FrameProfilerTest::traceSetup() {
+    FrameProfiler profiler{traceMeasurements(), 5};
+
+    profiler.startTrace();
+    profiler.beginFrame();
+    profiler.endFrame();
+
+    /* Setting up different measurements stops the trace, but the original
+       measurement names are still used for the export */
+    profiler.setup(Containers::Array<FrameProfiler::Measurement>{}, 5);
+    CORRADE_VERIFY(!profiler.isTracing());
+    CORRADE_COMPARE(profiler.traceFrameCount(), 1);
+    CORRADE_COMPARE_AS(profiler.traceJson(),
+        "{\"name\":\"Duration\",\"ph\":\"X\"",
+        TestSuite::Compare::StringContains);
+}
+
+void FrameProfilerTest::traceEscape() {
+    FrameProfiler profiler{{
+        FrameProfiler::Measurement{"A \"quoted\"\tC:\\path",
+            FrameProfiler::Units::Count,
+            [](void*) {},
+            [](void*) { return UnsignedLong{3}; }, nullptr}
+    }, 5};
+
+    profiler.startTrace();
+    profiler.beginFrame();
+    profiler.endFrame();
+    CORRADE_COMPARE_AS(profiler.traceJson(),
+        "{\"name\":\"A \\\"quoted\\\"\\u0009C:\\\\path\",\"ph\":\"C\"",
+        TestSuite::Compare::StringContains);
+}
+
+void FrameProfilerTest::saveTraceFailed() {
+    FrameProfiler profiler;
+    profiler.startTrace();
+
+    std::ostringstream out;
+    {
+        Error redirectError{&out};
+        CORRADE_VERIFY(!profiler.saveTrace("nonexistent/directory/trace.json"));
+    }
+    CORRADE_COMPARE_AS(out.str(),
+        "DebugTools::FrameProfiler::saveTrace(): cannot write to file nonexistent/directory/trace.json\n",
+        TestSuite::Compare::StringHasSuffix);
+}
+
 #ifdef MAGNUM_TARGET_GL
 void FrameProfilerTest::gl() {
     auto&& data = GLData[testCaseInstanceId()];
@@ -1173,6 +1703,89 @@ void FrameProfilerTest::glNotEnabled() {
 }
 #endif
 
+#ifdef MAGNUM_TARGET_VK
+void FrameProfilerTest::vk() {
+    auto&& data = VkData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* CPU-only measurements don't need a live device or command buffer */
+    Vk::Device device{NoCreate};
+    Vk::CommandBuffer cmd{NoCreate};
+
+    /* Test that we use the right state pointers to survive a move */
+    Containers::Pointer<FrameProfilerVk> profiler_{InPlaceInit, device, data.values, 4u};
+    FrameProfilerVk profiler = std::move(*profiler_);
+    profiler_ = nullptr;
+    CORRADE_COMPARE(profiler.values(), data.values);
+    CORRADE_COMPARE(profiler.maxFrameCount(), 4);
+    CORRADE_COMPARE(profiler.measurementCount(), data.measurementCount);
+
+    /* MSVC 2015 needs the {} */
+    for(auto value: {FrameProfilerVk::Value::CpuDuration,
+                     FrameProfilerVk::Value::FrameTime}) {
+        if(data.values & value)
+            CORRADE_VERIFY(!profiler.isMeasurementAvailable(value));
+    }
+
+    profiler.beginFrame(cmd);
+    Utility::System::sleep(1);
+    profiler.endFrame(cmd);
+
+    profiler.beginFrame(cmd);
+    profiler.endFrame(cmd);
+
+    Utility::System::sleep(10);
+
+    profiler.beginFrame(cmd);
+    Utility::System::sleep(1);
+    profiler.endFrame(cmd);
+
+    profiler.beginFrame(cmd);
+    Utility::System::sleep(1);
+    profiler.endFrame(cmd);
+
+    for(std::size_t i = 0; i != data.measurementCount; ++i)
+        CORRADE_VERIFY(profiler.isMeasurementAvailable(i));
+
+    /* Same bounds as in gl() above */
+    if(data.values & FrameProfilerVk::Value::CpuDuration) {
+        CORRADE_VERIFY(profiler.isMeasurementAvailable(FrameProfilerVk::Value::CpuDuration));
+        CORRADE_COMPARE_AS(profiler.cpuDurationMean(), 0.50*1000*1000,
+            TestSuite::Compare::GreaterOrEqual);
+    }
+    if(data.values & FrameProfilerVk::Value::FrameTime) {
+        CORRADE_VERIFY(profiler.isMeasurementAvailable(FrameProfilerVk::Value::FrameTime));
+        CORRADE_COMPARE_AS(profiler.frameTimeMean(), 3.20*1000*1000,
+            TestSuite::Compare::GreaterOrEqual);
+    }
+
+    /* GPU values need a device, tested in Vk::QueryPoolVkTest */
+}
+
+void FrameProfilerTest::vkNotEnabled() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Vk::Device device{NoCreate};
+    FrameProfilerVk profiler{device, {}, 5};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    profiler.isMeasurementAvailable(FrameProfilerVk::Value::GpuDuration);
+    profiler.frameTimeMean();
+    profiler.cpuDurationMean();
+    profiler.gpuDurationMean();
+    profiler.vertexFetchRatioMean();
+    profiler.primitiveClipRatioMean();
+    CORRADE_COMPARE(out.str(),
+        "DebugTools::FrameProfilerVk::isMeasurementAvailable(): DebugTools::FrameProfilerVk::Value::GpuDuration not enabled\n"
+        "DebugTools::FrameProfilerVk::frameTimeMean(): not enabled\n"
+        "DebugTools::FrameProfilerVk::cpuDurationMean(): not enabled\n"
+        "DebugTools::FrameProfilerVk::gpuDurationMean(): not enabled\n"
+        "DebugTools::FrameProfilerVk::vertexFetchRatioMean(): not enabled\n"
+        "DebugTools::FrameProfilerVk::primitiveClipRatioMean(): not enabled\n");
+}
+#endif
+
 void FrameProfilerTest::debugUnits() {
     std::ostringstream out;
 
@@ -1228,6 +1841,22 @@ void FrameProfilerTest::configurationGLValues() {
 }
 #endif
 
+#ifdef MAGNUM_TARGET_VK
+void FrameProfilerTest::debugVkValue() {
+    std::ostringstream out;
+
+    Debug{&out} << FrameProfilerVk::Value::GpuDuration << FrameProfilerVk::Value(0xfff0);
+    CORRADE_COMPARE(out.str(), "DebugTools::FrameProfilerVk::Value::GpuDuration DebugTools::FrameProfilerVk::Value(0xfff0)\n");
+}
+
+void FrameProfilerTest::debugVkValues() {
+    std::ostringstream out;
+
+    Debug{&out} << (FrameProfilerVk::Value::CpuDuration|FrameProfilerVk::Value::FrameTime) << FrameProfilerVk::Values{};
+    CORRADE_COMPARE(out.str(), "DebugTools::FrameProfilerVk::Value::FrameTime|DebugTools::FrameProfilerVk::Value::CpuDuration DebugTools::FrameProfilerVk::Values{}\n");
+}
+#endif
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::DebugTools::Test::FrameProfilerTest)
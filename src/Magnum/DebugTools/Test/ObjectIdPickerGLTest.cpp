@@ -0,0 +1,228 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+
+#include "Magnum/DebugTools/ObjectIdPicker.h"
+#include "Magnum/GL/Framebuffer.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/GL/Renderbuffer.h"
+#include "Magnum/GL/RenderbufferFormat.h"
+#include "Magnum/GL/Renderer.h"
+#include "Magnum/Math/Range.h"
+
+namespace Magnum { namespace DebugTools { namespace Test { namespace {
+
+struct ObjectIdPickerGLTest: GL::OpenGLTester {
+    explicit ObjectIdPickerGLTest();
+
+    void construct();
+    void constructNoCreate();
+    void constructZeroPendingCount();
+    void constructMove();
+
+    void pick();
+    void pickMultiple();
+    void pickAllPending();
+    void updateNothingPending();
+
+    void noResult();
+};
+
+ObjectIdPickerGLTest::ObjectIdPickerGLTest() {
+    addTests({&ObjectIdPickerGLTest::construct,
+              &ObjectIdPickerGLTest::constructNoCreate,
+              &ObjectIdPickerGLTest::constructZeroPendingCount,
+              &ObjectIdPickerGLTest::constructMove,
+
+              &ObjectIdPickerGLTest::pick,
+              &ObjectIdPickerGLTest::pickMultiple,
+              &ObjectIdPickerGLTest::pickAllPending,
+              &ObjectIdPickerGLTest::updateNothingPending,
+
+              &ObjectIdPickerGLTest::noResult});
+}
+
+/* Left half of the framebuffer has ID 17, right half 42 */
+struct IdFramebuffer {
+    explicit IdFramebuffer() {
+        renderbuffer.setStorage(GL::RenderbufferFormat::R32UI, {8, 8});
+        framebuffer.attachRenderbuffer(GL::Framebuffer::ColorAttachment{0}, renderbuffer)
+            .mapForRead(GL::Framebuffer::ColorAttachment{0});
+
+        GL::Renderer::enable(GL::Renderer::Feature::ScissorTest);
+        GL::Renderer::setScissor({{}, {4, 8}});
+        framebuffer.clearColor(0, Vector4ui{17});
+        GL::Renderer::setScissor({{4, 0}, {8, 8}});
+        framebuffer.clearColor(0, Vector4ui{42});
+        GL::Renderer::disable(GL::Renderer::Feature::ScissorTest);
+    }
+
+    GL::Renderbuffer renderbuffer;
+    GL::Framebuffer framebuffer{{{}, {8, 8}}};
+};
+
+void ObjectIdPickerGLTest::construct() {
+    ObjectIdPicker picker{5};
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(picker.maxPendingCount(), 5);
+    CORRADE_COMPARE(picker.pendingCount(), 0);
+    CORRADE_VERIFY(!picker.hasResult());
+}
+
+void ObjectIdPickerGLTest::constructNoCreate() {
+    ObjectIdPicker picker{NoCreate};
+    CORRADE_COMPARE(picker.maxPendingCount(), 0);
+    CORRADE_COMPARE(picker.pendingCount(), 0);
+    CORRADE_VERIFY(!picker.hasResult());
+}
+
+void ObjectIdPickerGLTest::constructZeroPendingCount() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    ObjectIdPicker{0};
+    CORRADE_COMPARE(out.str(), "DebugTools::ObjectIdPicker: expected non-zero max pending count\n");
+}
+
+void ObjectIdPickerGLTest::constructMove() {
+    IdFramebuffer fb;
+
+    ObjectIdPicker a;
+    CORRADE_VERIFY(a.pick(fb.framebuffer, {6, 2}));
+
+    ObjectIdPicker b = std::move(a);
+    CORRADE_COMPARE(b.maxPendingCount(), 3);
+    CORRADE_COMPARE(b.pendingCount(), 1);
+
+    ObjectIdPicker c{NoCreate};
+    c = std::move(b);
+    CORRADE_COMPARE(c.pendingCount(), 1);
+
+    c.wait();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(c.hasResult());
+    CORRADE_COMPARE(c.objectId(), 42);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<ObjectIdPicker>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<ObjectIdPicker>::value);
+}
+
+void ObjectIdPickerGLTest::pick() {
+    IdFramebuffer fb;
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    ObjectIdPicker picker;
+    CORRADE_VERIFY(picker.pick(fb.framebuffer, {1, 5}));
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(picker.pendingCount(), 1);
+
+    picker.wait();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(picker.pendingCount(), 0);
+    CORRADE_VERIFY(picker.hasResult());
+    CORRADE_COMPARE(picker.objectId(), 17);
+    CORRADE_COMPARE(picker.position(), (Vector2i{1, 5}));
+
+    /* Nothing new after, the result stays */
+    CORRADE_VERIFY(!picker.update());
+    CORRADE_COMPARE(picker.objectId(), 17);
+}
+
+void ObjectIdPickerGLTest::pickMultiple() {
+    IdFramebuffer fb;
+
+    ObjectIdPicker picker;
+    CORRADE_VERIFY(picker.pick(fb.framebuffer, {1, 5}));
+    CORRADE_VERIFY(picker.pick(fb.framebuffer, {7, 0}));
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(picker.pendingCount(), 2);
+
+    /* Only the latest result is kept */
+    picker.wait();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(picker.pendingCount(), 0);
+    CORRADE_COMPARE(picker.objectId(), 42);
+    CORRADE_COMPARE(picker.position(), (Vector2i{7, 0}));
+
+    /* The slots get reused in a round-robin fashion */
+    for(Int i = 0; i != 5; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_VERIFY(picker.pick(fb.framebuffer, {i, 3}));
+        picker.wait();
+        MAGNUM_VERIFY_NO_GL_ERROR();
+        CORRADE_COMPARE(picker.objectId(), i < 4 ? 17 : 42);
+        CORRADE_COMPARE(picker.position(), (Vector2i{i, 3}));
+    }
+}
+
+void ObjectIdPickerGLTest::pickAllPending() {
+    IdFramebuffer fb;
+
+    ObjectIdPicker picker{2};
+    CORRADE_VERIFY(picker.pick(fb.framebuffer, {1, 1}));
+    CORRADE_VERIFY(picker.pick(fb.framebuffer, {2, 2}));
+
+    /* No slot free, the pick gets dropped */
+    CORRADE_VERIFY(!picker.pick(fb.framebuffer, {6, 6}));
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(picker.pendingCount(), 2);
+
+    picker.wait();
+    CORRADE_COMPARE(picker.objectId(), 17);
+    CORRADE_COMPARE(picker.position(), (Vector2i{2, 2}));
+
+    /* After that there's space again */
+    CORRADE_VERIFY(picker.pick(fb.framebuffer, {6, 6}));
+    picker.wait();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(picker.objectId(), 42);
+}
+
+void ObjectIdPickerGLTest::updateNothingPending() {
+    ObjectIdPicker picker;
+    CORRADE_VERIFY(!picker.update());
+    picker.wait();
+    CORRADE_VERIFY(!picker.hasResult());
+}
+
+void ObjectIdPickerGLTest::noResult() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    ObjectIdPicker picker;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    picker.objectId();
+    picker.position();
+    CORRADE_COMPARE(out.str(),
+        "DebugTools::ObjectIdPicker::objectId(): no result available\n"
+        "DebugTools::ObjectIdPicker::position(): no result available\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::DebugTools::Test::ObjectIdPickerGLTest)
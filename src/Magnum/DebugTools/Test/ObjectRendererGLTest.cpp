@@ -46,9 +46,8 @@
 
 #include "configure.h"
 
-#ifdef CORRADE_TARGET_ANDROID
 #include "Magnum/GL/Context.h"
-#endif
+#include "Magnum/GL/Extensions.h"
 
 namespace Magnum { namespace DebugTools { namespace Test { namespace {
 
@@ -62,9 +61,18 @@ struct ObjectRendererGLTest: GL::OpenGLTester {
         PluginManager::Manager<Trade::AbstractImporter> _manager{"nonexistent"};
 };
 
+const struct {
+    const char* name;
+    bool batched;
+} RenderData[]{
+    {"", false},
+    {"batched", true}
+};
+
 ObjectRendererGLTest::ObjectRendererGLTest() {
-    addTests({&ObjectRendererGLTest::render2D,
-              &ObjectRendererGLTest::render3D});
+    addInstancedTests({&ObjectRendererGLTest::render2D,
+                       &ObjectRendererGLTest::render3D},
+        Containers::arraySize(RenderData));
 
     /* Load the plugins directly from the build tree. Otherwise they're either
        static and already loaded or not present in the build tree */
@@ -78,7 +86,29 @@ ObjectRendererGLTest::ObjectRendererGLTest() {
 
 using namespace Math::Literals;
 
+bool isInstancingSupported() {
+    #ifndef MAGNUM_TARGET_GLES
+    return GL::Context::current().isExtensionSupported<GL::Extensions::ARB::instanced_arrays>();
+    #elif defined(MAGNUM_TARGET_GLES2)
+    #ifndef MAGNUM_TARGET_WEBGL
+    return GL::Context::current().isExtensionSupported<GL::Extensions::ANGLE::instanced_arrays>() ||
+        GL::Context::current().isExtensionSupported<GL::Extensions::EXT::instanced_arrays>() ||
+        GL::Context::current().isExtensionSupported<GL::Extensions::NV::instanced_arrays>();
+    #else
+    return GL::Context::current().isExtensionSupported<GL::Extensions::ANGLE::instanced_arrays>();
+    #endif
+    #else
+    return true;
+    #endif
+}
+
 void ObjectRendererGLTest::render2D() {
+    auto&& data = RenderData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if(data.batched && !isInstancingSupported())
+        CORRADE_SKIP("Instanced arrays are not supported.");
+
     SceneGraph::Scene<SceneGraph::MatrixTransformation2D> scene;
 
     SceneGraph::DrawableGroup2D drawables;
@@ -92,7 +122,12 @@ void ObjectRendererGLTest::render2D() {
     object
         .rotate(-17.3_degf)
         .translate({-1.0f, -1.0f});
-    ObjectRenderer2D renderer{manager, object, "my", &drawables};
+    Containers::Optional<ObjectRendererBatch2D> batch;
+    Containers::Optional<ObjectRenderer2D> renderer;
+    if(data.batched) {
+        batch.emplace(manager);
+        renderer.emplace(*batch, object, "my", &drawables);
+    } else renderer.emplace(manager, object, "my", &drawables);
 
     GL::Renderbuffer color;
     color.setStorage(
@@ -108,6 +143,7 @@ void ObjectRendererGLTest::render2D() {
         .bind();
 
     camera.draw(drawables);
+    if(batch) batch->draw(camera);
 
     MAGNUM_VERIFY_NO_GL_ERROR();
 
@@ -123,6 +159,12 @@ void ObjectRendererGLTest::render2D() {
 }
 
 void ObjectRendererGLTest::render3D() {
+    auto&& data = RenderData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if(data.batched && !isInstancingSupported())
+        CORRADE_SKIP("Instanced arrays are not supported.");
+
     SceneGraph::Scene<SceneGraph::MatrixTransformation3D> scene;
 
     SceneGraph::DrawableGroup3D drawables;
@@ -137,7 +179,12 @@ void ObjectRendererGLTest::render3D() {
         .rotateZ(17.3_degf)
         .rotateY(45.0_degf)
         .translate({-1.0f, -1.0f, -1.0f});
-    ObjectRenderer3D renderer{manager, object, "my", &drawables};
+    Containers::Optional<ObjectRendererBatch3D> batch;
+    Containers::Optional<ObjectRenderer3D> renderer;
+    if(data.batched) {
+        batch.emplace(manager);
+        renderer.emplace(*batch, object, "my", &drawables);
+    } else renderer.emplace(manager, object, "my", &drawables);
 
     GL::Renderbuffer color;
     color.setStorage(
@@ -153,6 +200,7 @@ void ObjectRendererGLTest::render3D() {
         .bind();
 
     camera.draw(drawables);
+    if(batch) batch->draw(camera);
 
     MAGNUM_VERIFY_NO_GL_ERROR();
 
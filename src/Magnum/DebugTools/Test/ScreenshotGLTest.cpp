@@ -24,6 +24,7 @@
 */
 
 #include <sstream>
+#include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/ScopeGuard.h>
 #include <Corrade/Containers/String.h>
 #include <Corrade/Containers/StringStl.h> /** @todo remove when screenshot() is <string>-free */
@@ -67,6 +68,13 @@ struct ScreenshotGLTest: GL::OpenGLTester {
     void pluginLoadFailed();
     void saveFailed();
 
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    void async();
+    void asyncUnknownFormat();
+    void asyncPluginLoadFailed();
+    void asyncSaveFailed();
+    #endif
+
     private:
         PluginManager::Manager<Trade::AbstractImageConverter> _converterManager{"nonexistent"};
         PluginManager::Manager<Trade::AbstractImporter> _importerManager{"nonexistent"};
@@ -77,7 +85,15 @@ ScreenshotGLTest::ScreenshotGLTest() {
               &ScreenshotGLTest::r8,
               &ScreenshotGLTest::unknownFormat,
               &ScreenshotGLTest::pluginLoadFailed,
-              &ScreenshotGLTest::saveFailed});
+              &ScreenshotGLTest::saveFailed,
+
+              #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+              &ScreenshotGLTest::async,
+              &ScreenshotGLTest::asyncUnknownFormat,
+              &ScreenshotGLTest::asyncPluginLoadFailed,
+              &ScreenshotGLTest::asyncSaveFailed
+              #endif
+              });
 
     /* Load the plugins directly from the build tree. Otherwise they're either
        static and already loaded or not present in the build tree */
@@ -319,6 +335,159 @@ void ScreenshotGLTest::saveFailed() {
     CORRADE_COMPARE(out.str(), "Trade::AnyImageConverter::convertToFile(): cannot determine the format of image.poo for a 2D image\n");
 }
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+void ScreenshotGLTest::async() {
+    if(!(_converterManager.loadState("AnyImageConverter") & PluginManager::LoadState::Loaded) ||
+       !(_converterManager.loadState("TgaImageConverter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("AnyImageConverter / TgaImageConverter plugins not found.");
+
+    ImageView2D rgba{PixelFormat::RGBA8Unorm, {4, 3}, DataRgba8};
+
+    GL::Texture2D texture;
+    texture.setStorage(1, GL::TextureFormat::RGBA8, {4, 3})
+        .setSubImage(0, {}, rgba);
+    GL::Framebuffer framebuffer{{{}, {4, 3}}};
+    framebuffer.attachTexture(GL::Framebuffer::ColorAttachment{0}, texture, 0);
+
+    CORRADE_COMPARE(framebuffer.checkStatus(GL::FramebufferTarget::Read), GL::Framebuffer::Status::Complete);
+
+    Containers::String files[]{
+        Utility::Path::join(SCREENSHOTTEST_SAVE_DIR, "image-async0.tga"),
+        Utility::Path::join(SCREENSHOTTEST_SAVE_DIR, "image-async1.tga"),
+        Utility::Path::join(SCREENSHOTTEST_SAVE_DIR, "image-async2.tga")
+    };
+    CORRADE_VERIFY(Utility::Path::make(SCREENSHOTTEST_SAVE_DIR));
+    for(const Containers::String& file: files)
+        if(Utility::Path::exists(file))
+            CORRADE_VERIFY(Utility::Path::remove(file));
+
+    {
+        /* The messages get printed from a different thread, so they can't
+           be redirected and verified here */
+        AsyncScreenshot screenshot{_converterManager, 2};
+        CORRADE_COMPARE(screenshot.latency(), 2);
+
+        CORRADE_VERIFY(screenshot.capture(framebuffer, PixelFormat::RGBA8Unorm, files[0]));
+        CORRADE_COMPARE(screenshot.pendingCount(), 1);
+        screenshot.update();
+
+        /* The second capture reuses the buffer from the first if it got
+           retired already, which should make no difference to the output */
+        CORRADE_VERIFY(screenshot.capture(framebuffer, PixelFormat::RGBA8Unorm, files[1]));
+        screenshot.update();
+        screenshot.update();
+
+        /* The first two readbacks are retired by now as the latency was
+           reached, but they may still be waiting to be saved */
+        CORRADE_VERIFY(screenshot.capture(framebuffer, PixelFormat::RGBA8Unorm, files[2]));
+        screenshot.finish();
+        MAGNUM_VERIFY_NO_GL_ERROR();
+        CORRADE_COMPARE(screenshot.pendingCount(), 0);
+        CORRADE_COMPARE(screenshot.savedCount(), 3);
+        CORRADE_COMPARE(screenshot.failedCount(), 0);
+    }
+
+    if(!(_importerManager.loadState("AnyImageImporter") & PluginManager::LoadState::Loaded) ||
+       !(_importerManager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("AnyImageImporter / TgaImporter plugins not found.");
+
+    for(const Containers::String& file: files) {
+        CORRADE_ITERATION(file);
+        CORRADE_COMPARE_WITH(file, rgba, CompareFileToImage{_importerManager});
+    }
+}
+
+void ScreenshotGLTest::asyncUnknownFormat() {
+    if(!(_converterManager.loadState("AnyImageConverter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("AnyImageConverter plugin not found.");
+
+    ImageView2D rgba{GL::PixelFormat::RGB, GL::PixelType::UnsignedShort565, {4, 3}, DataRgba8};
+
+    GL::Texture2D texture;
+    texture.setStorage(1, GL::TextureFormat::RGB565, {4, 3})
+        .setSubImage(0, {}, rgba);
+    GL::Framebuffer framebuffer{{{}, {4, 3}}};
+    framebuffer.attachTexture(GL::Framebuffer::ColorAttachment{0}, texture, 0);
+
+    CORRADE_COMPARE(framebuffer.checkStatus(GL::FramebufferTarget::Read), GL::Framebuffer::Status::Complete);
+
+    if(framebuffer.implementationColorReadFormat() == GL::PixelFormat::RGBA &&
+       framebuffer.implementationColorReadType() == GL::PixelType::UnsignedByte)
+        CORRADE_SKIP("The framebuffer read format is RGBA8, can't test.");
+
+    AsyncScreenshot screenshot{_converterManager};
+
+    std::ostringstream out;
+    bool succeeded;
+    {
+        Error redirectOutput{&out};
+        succeeded = screenshot.capture(framebuffer, Utility::Path::join(SCREENSHOTTEST_SAVE_DIR, "image.tga"));
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(!succeeded);
+    CORRADE_COMPARE(screenshot.pendingCount(), 0);
+    if(framebuffer.implementationColorReadFormat() == GL::PixelFormat::RGBA)
+        CORRADE_COMPARE(out.str(), "DebugTools::AsyncScreenshot::capture(): can't map (GL::PixelFormat::RGBA, GL::PixelType::UnsignedShort565) to a generic pixel format\n");
+    else
+        CORRADE_COMPARE(out.str(), "DebugTools::AsyncScreenshot::capture(): can't map (GL::PixelFormat::RGB, GL::PixelType::UnsignedShort565) to a generic pixel format\n");
+}
+
+void ScreenshotGLTest::asyncPluginLoadFailed() {
+    PluginManager::Manager<Trade::AbstractImageConverter> manager{"nowhere"};
+    if(manager.loadState("AnyImageConverter") != PluginManager::LoadState::NotFound)
+        CORRADE_SKIP("AnyImageConverter plugin found, can't test.");
+
+    GL::Texture2D texture;
+    texture.setStorage(1, GL::TextureFormat::RGBA8, {4, 3});
+    GL::Framebuffer framebuffer{{{}, {4, 3}}};
+    framebuffer.attachTexture(GL::Framebuffer::ColorAttachment{0}, texture, 0);
+
+    std::ostringstream out;
+    Containers::Optional<AsyncScreenshot> screenshot;
+    {
+        Error redirectOutput{&out};
+        screenshot.emplace(manager);
+    }
+    #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+    CORRADE_COMPARE(out.str(), "PluginManager::Manager::load(): plugin AnyImageConverter is not static and was not found in nowhere\n");
+    #else
+    CORRADE_COMPARE(out.str(), "PluginManager::Manager::load(): plugin AnyImageConverter was not found\n");
+    #endif
+
+    /* The capture fails without printing anything else */
+    out.str({});
+    {
+        Error redirectOutput{&out};
+        CORRADE_VERIFY(!screenshot->capture(framebuffer, PixelFormat::RGBA8Unorm, Utility::Path::join(SCREENSHOTTEST_SAVE_DIR, "image.tga")));
+    }
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(out.str(), "");
+    CORRADE_COMPARE(screenshot->pendingCount(), 0);
+}
+
+void ScreenshotGLTest::asyncSaveFailed() {
+    if(!(_converterManager.loadState("AnyImageConverter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("AnyImageConverter plugin not found.");
+
+    GL::Texture2D texture;
+    texture.setStorage(1, GL::TextureFormat::RGBA8, {4, 3});
+    GL::Framebuffer framebuffer{{{}, {4, 3}}};
+    framebuffer.attachTexture(GL::Framebuffer::ColorAttachment{0}, texture, 0);
+
+    /* The error gets printed from a different thread, so it can't be
+       redirected and verified here */
+    AsyncScreenshot screenshot{_converterManager};
+    CORRADE_VERIFY(screenshot.capture(framebuffer, PixelFormat::RGBA8Unorm, "image.poo"));
+    screenshot.finish();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(screenshot.pendingCount(), 0);
+    CORRADE_COMPARE(screenshot.savedCount(), 0);
+    CORRADE_COMPARE(screenshot.failedCount(), 1);
+}
+#endif
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::DebugTools::Test::ScreenshotGLTest)
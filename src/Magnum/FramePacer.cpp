@@ -0,0 +1,238 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FramePacer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/System.h>
+
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum {
+
+using namespace std::chrono;
+
+namespace {
+    /* The smoothed duration is snapped to a multiple of the refresh period if
+       it's closer than this fraction of the period */
+    constexpr Float RefreshSnapTolerance = 0.1f;
+}
+
+FramePacer::FramePacer(const UnsignedInt historySize): _spinDuration{microseconds{2000}}, _history{NoInit, historySize}, _sorted{NoInit, historySize} {
+    CORRADE_ASSERT(historySize, "FramePacer: expected a non-zero history size", );
+}
+
+FramePacer::FramePacer(FramePacer&&) noexcept = default;
+
+FramePacer::~FramePacer() = default;
+
+FramePacer& FramePacer::operator=(FramePacer&&) noexcept = default;
+
+Float FramePacer::targetFrameRate() const {
+    return _targetFrameDuration == nanoseconds{} ? 0.0f :
+        Float(1.0e9/Double(_targetFrameDuration.count()));
+}
+
+FramePacer& FramePacer::setTargetFrameRate(const Float frameRate) {
+    CORRADE_ASSERT(frameRate >= 0.0f,
+        "FramePacer::setTargetFrameRate(): expected a non-negative value, got" << frameRate, *this);
+    _targetFrameDuration = frameRate == 0.0f ? nanoseconds{} :
+        nanoseconds{Long(1.0e9/Double(frameRate))};
+    /* Restart the cadence from the previous frame */
+    _deadline = _previousFrameTime + _targetFrameDuration;
+    return *this;
+}
+
+Float FramePacer::spinDuration() const {
+    return _spinDuration.count()/1.0e9f;
+}
+
+FramePacer& FramePacer::setSpinDuration(const Float seconds) {
+    CORRADE_ASSERT(seconds >= 0.0f,
+        "FramePacer::setSpinDuration(): expected a non-negative value, got" << seconds, *this);
+    _spinDuration = nanoseconds{Long(Double(seconds)*1.0e9)};
+    return *this;
+}
+
+FramePacer& FramePacer::setRefreshRate(const Float refreshRate) {
+    CORRADE_ASSERT(refreshRate >= 0.0f,
+        "FramePacer::setRefreshRate(): expected a non-negative value, got" << refreshRate, *this);
+    _refreshRate = refreshRate;
+    return *this;
+}
+
+FramePacer& FramePacer::setMaxFrameDuration(const Float seconds) {
+    CORRADE_ASSERT(seconds > 0.0f,
+        "FramePacer::setMaxFrameDuration(): expected a positive value, got" << seconds, *this);
+    _maxFrameDuration = seconds;
+    return *this;
+}
+
+FramePacer& FramePacer::start() {
+    return start(steady_clock::now());
+}
+
+FramePacer& FramePacer::start(const steady_clock::time_point time) {
+    _running = true;
+    _startTime = time;
+    _previousFrameTime = time;
+    _deadline = time + _targetFrameDuration;
+    _previousFrameDuration = 0.0f;
+    _historyOffset = 0;
+    _historyCount = 0;
+    return *this;
+}
+
+FramePacer& FramePacer::stop() {
+    _running = false;
+    _startTime = {};
+    _previousFrameTime = {};
+    _deadline = {};
+    _previousFrameDuration = 0.0f;
+    _historyOffset = 0;
+    _historyCount = 0;
+    return *this;
+}
+
+FramePacer& FramePacer::nextFrame() {
+    if(!_running) return *this;
+
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    if(_targetFrameDuration != nanoseconds{}) {
+        /* Sleep for whole milliseconds until the spin duration before the
+           deadline, then busy-wait for the rest */
+        const steady_clock::time_point now = steady_clock::now();
+        if(now + _spinDuration < _deadline) {
+            const milliseconds sleep = duration_cast<milliseconds>(_deadline - _spinDuration - now);
+            if(sleep.count() > 0)
+                Utility::System::sleep(sleep.count());
+        }
+        while(steady_clock::now() < _deadline);
+    }
+    #endif
+
+    const steady_clock::time_point now = steady_clock::now();
+    addFrame(now);
+
+    /* Keep the deadlines on a fixed cadence so a slightly late frame is
+       compensated in the next one, but if we're late by more than a whole
+       frame, start the cadence over instead of trying to catch up */
+    _deadline += _targetFrameDuration;
+    if(_deadline < now) _deadline = now + _targetFrameDuration;
+
+    return *this;
+}
+
+FramePacer& FramePacer::nextFrame(const steady_clock::time_point time) {
+    if(!_running) return *this;
+
+    addFrame(time);
+    _deadline = _previousFrameTime + _targetFrameDuration;
+    return *this;
+}
+
+void FramePacer::addFrame(const steady_clock::time_point time) {
+    const Float duration = time > _previousFrameTime ?
+        duration_cast<nanoseconds>(time - _previousFrameTime).count()/1.0e9f : 0.0f;
+    _previousFrameDuration = duration;
+    _previousFrameTime = std::max(time, _previousFrameTime);
+
+    _history[_historyOffset] = Math::min(duration, _maxFrameDuration);
+    _historyOffset = (_historyOffset + 1) % _history.size();
+    if(_historyCount < _history.size()) ++_historyCount;
+}
+
+Float FramePacer::previousFrameTime() const {
+    return duration_cast<nanoseconds>(_previousFrameTime - _startTime).count()/1.0e9f;
+}
+
+Float FramePacer::smoothedFrameDuration() const {
+    if(!_historyCount)
+        return _targetFrameDuration.count()/1.0e9f;
+
+    const Float mean = frameDurationMean();
+    if(_refreshRate == 0.0f) return mean;
+
+    /* Snap to the nearest multiple of the refresh period if close enough */
+    const Float period = 1.0f/_refreshRate;
+    const Float multiple = Math::max(std::round(mean/period), 1.0f);
+    if(Math::abs(mean - multiple*period) < RefreshSnapTolerance*period)
+        return multiple*period;
+    return mean;
+}
+
+Float FramePacer::predictedNextFrameTime() const {
+    return previousFrameTime() + smoothedFrameDuration();
+}
+
+Float FramePacer::frameDurationMin() const {
+    if(!_historyCount) return 0.0f;
+    return *std::min_element(_history.begin(), _history.begin() + _historyCount);
+}
+
+Float FramePacer::frameDurationMax() const {
+    if(!_historyCount) return 0.0f;
+    return *std::max_element(_history.begin(), _history.begin() + _historyCount);
+}
+
+Float FramePacer::frameDurationMean() const {
+    if(!_historyCount) return 0.0f;
+
+    /* The history is small, so summing it again each time is cheaper than
+       dealing with a drifting running sum */
+    Double sum = 0.0;
+    for(std::size_t i = 0; i != _historyCount; ++i)
+        sum += _history[i];
+    return Float(sum/_historyCount);
+}
+
+Float FramePacer::frameDurationStandardDeviation() const {
+    if(!_historyCount) return 0.0f;
+
+    const Double mean = frameDurationMean();
+    Double sum = 0.0;
+    for(std::size_t i = 0; i != _historyCount; ++i)
+        sum += (_history[i] - mean)*(_history[i] - mean);
+    return Float(std::sqrt(sum/_historyCount));
+}
+
+Float FramePacer::frameDurationPercentile(const Float percentile) const {
+    CORRADE_ASSERT(percentile >= 0.0f && percentile <= 1.0f,
+        "FramePacer::frameDurationPercentile(): expected a value in the [0, 1] range, got" << percentile, {});
+    if(!_historyCount) return 0.0f;
+
+    /* The history isn't ordered by time once it wraps around, but that
+       doesn't matter for the percentile */
+    const Containers::ArrayView<Float> sorted = _sorted.prefix(_historyCount);
+    Utility::copy(_history.prefix(_historyCount), sorted);
+    Float* const nth = sorted.begin() + std::size_t(std::round(percentile*(_historyCount - 1)));
+    std::nth_element(sorted.begin(), nth, sorted.end());
+    return *nth;
+}
+
+}
@@ -0,0 +1,365 @@
+#ifndef Magnum_FramePacer_h
+#define Magnum_FramePacer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::FramePacer
+ * @m_since_latest
+ */
+
+#include <chrono>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum {
+
+/**
+@brief Frame pacer
+@m_since_latest
+
+Compared to @ref Timeline, which only measures duration of the previous frame,
+keeps a rolling history of frame durations, provides a smoothed frame duration
+that's stable enough to be used as a delta for physics and animation, and can
+wait at the end of each frame to hit a target frame rate. All measurements use
+@ref std::chrono::steady_clock, which, unlike
+@ref std::chrono::high_resolution_clock on some platforms, is guaranteed to be
+monotonic.
+
+@section FramePacer-usage Basic usage
+
+Call @ref start() after everything is initialized, and @ref nextFrame() after
+each buffer swap. Use @ref smoothedFrameDuration() instead of
+@ref previousFrameDuration() for advancing the simulation:
+
+@snippet Magnum.cpp FramePacer-usage
+
+@section FramePacer-smoothing Frame duration smoothing
+
+The @ref smoothedFrameDuration() is a mean of the last @ref historySize()
+frame durations, with each duration clamped to @ref maxFrameDuration() first
+so a single long frame such as a shader compilation or a window drag doesn't
+make the next frames jump as well. With VSync enabled, the measured durations
+jitter around a multiple of the display refresh period due to imprecise
+timers, OS scheduling and driver queuing, even though the frames are
+presented exactly at the refresh intervals. If the refresh rate is supplied
+via @ref setRefreshRate(), the smoothed duration is snapped to the nearest
+multiple of the refresh period if it's close enough, eliminating the jitter
+completely.
+
+The rolling distribution of frame durations is available through
+@ref frameDurationMin(), @ref frameDurationMax(), @ref frameDurationMean(),
+@ref frameDurationStandardDeviation() and @ref frameDurationPercentile(),
+useful for example for detecting stutter.
+
+@section FramePacer-pacing Frame rate limiting
+
+If @ref setTargetFrameRate() is set, @ref nextFrame() waits until the target
+frame duration elapses since the previous frame. As sleeping is only precise
+to a millisecond or worse on most systems, the thread sleeps only until
+@ref spinDuration() before the deadline and then busy-waits for the rest. The
+deadlines are kept on a fixed cadence, so a frame that took slightly longer is
+compensated by a shorter wait in the next frame. If a frame is late by more
+than the whole target duration, the cadence is restarted from the current
+time instead of trying to catch up.
+
+On @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten" the framerate is governed by
+the browser and the target frame rate is ignored.
+
+@section FramePacer-present-feedback Present time feedback
+
+If the platform provides actual present times of the frames, for example via
+@m_class{m-doc-external} [VK_GOOGLE_display_timing](https://www.khronos.org/registry/vulkan/specs/1.3-extensions/man/html/VK_GOOGLE_display_timing.html)
+or @m_class{m-doc-external} [GLX_OML_sync_control](https://registry.khronos.org/OpenGL/extensions/OML/GLX_OML_sync_control.txt),
+call @ref nextFrame(std::chrono::steady_clock::time_point) with them instead
+of @ref nextFrame(). The history is then built from the presentation
+intervals instead of CPU-side timestamps, which are a much better predictor of
+when the next frame gets displayed. The display refresh rate for
+@ref setRefreshRate() can be queried from the windowing toolkit, for example
+using @cpp SDL_GetCurrentDisplayMode() @ce or @cpp glfwGetVideoMode() @ce.
+@see @ref DebugTools::FrameProfiler
+*/
+class MAGNUM_EXPORT FramePacer {
+    public:
+        /**
+         * @brief Constructor
+         * @param historySize   Count of frames to calculate the statistics
+         *      from
+         *
+         * Creates a stopped frame pacer with no target frame rate. Expects
+         * that @p historySize is not zero.
+         * @see @ref start()
+         */
+        explicit FramePacer(UnsignedInt historySize = 60);
+
+        /** @brief Copying is not allowed */
+        FramePacer(const FramePacer&) = delete;
+
+        /** @brief Move constructor */
+        FramePacer(FramePacer&&) noexcept;
+
+        ~FramePacer();
+
+        /** @brief Copying is not allowed */
+        FramePacer& operator=(const FramePacer&) = delete;
+
+        /** @brief Move assignment */
+        FramePacer& operator=(FramePacer&&) noexcept;
+
+        /** @brief Count of frames to calculate the statistics from */
+        UnsignedInt historySize() const { return _history.size(); }
+
+        /**
+         * @brief Target frame rate
+         *
+         * If @cpp 0.0f @ce, the frame rate is not limited. Default is
+         * @cpp 0.0f @ce.
+         */
+        Float targetFrameRate() const;
+
+        /**
+         * @brief Set target frame rate
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @p frameRate is not negative. Set to @cpp 0.0f @ce to
+         * not limit the frame rate. See @ref FramePacer-pacing for more
+         * information.
+         */
+        FramePacer& setTargetFrameRate(Float frameRate);
+
+        /**
+         * @brief Spin duration (in seconds)
+         *
+         * Default is @cpp 0.002f @ce.
+         */
+        Float spinDuration() const;
+
+        /**
+         * @brief Set spin duration
+         * @return Reference to self (for method chaining)
+         *
+         * How long before the frame deadline to stop sleeping and start
+         * busy-waiting. Larger values make the pacing more precise but burn
+         * more CPU time. Expects that @p seconds is not negative.
+         */
+        FramePacer& setSpinDuration(Float seconds);
+
+        /**
+         * @brief Display refresh rate
+         *
+         * If @cpp 0.0f @ce, @ref smoothedFrameDuration() isn't snapped to
+         * the refresh period. Default is @cpp 0.0f @ce.
+         */
+        Float refreshRate() const { return _refreshRate; }
+
+        /**
+         * @brief Set display refresh rate
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @p refreshRate is not negative. Set to @cpp 0.0f @ce
+         * to disable snapping. See @ref FramePacer-smoothing for more
+         * information.
+         */
+        FramePacer& setRefreshRate(Float refreshRate);
+
+        /**
+         * @brief Max frame duration (in seconds)
+         *
+         * Default is @cpp 0.25f @ce.
+         */
+        Float maxFrameDuration() const { return _maxFrameDuration; }
+
+        /**
+         * @brief Set max frame duration
+         * @return Reference to self (for method chaining)
+         *
+         * Frame durations are clamped to this value before being added to
+         * the history. Expects that @p seconds is greater than zero.
+         */
+        FramePacer& setMaxFrameDuration(Float seconds);
+
+        /** @brief Whether the frame pacer is running */
+        bool isRunning() const { return _running; }
+
+        /**
+         * @brief Start the frame pacer
+         * @return Reference to self (for method chaining)
+         *
+         * Clears the history and sets the previous frame time and duration
+         * to @cpp 0.0f @ce.
+         * @see @ref stop(), @ref nextFrame()
+         */
+        FramePacer& start();
+
+        /**
+         * @brief Start the frame pacer at given time
+         * @return Reference to self (for method chaining)
+         *
+         * Like @ref start(), but with an explicit start time. Useful
+         * together with @ref nextFrame(std::chrono::steady_clock::time_point).
+         */
+        FramePacer& start(std::chrono::steady_clock::time_point time);
+
+        /**
+         * @brief Stop the frame pacer
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref start()
+         */
+        FramePacer& stop();
+
+        /**
+         * @brief Advance to next frame
+         * @return Reference to self (for method chaining)
+         *
+         * If @ref targetFrameRate() is set, waits until the target frame
+         * duration elapses, then measures duration of the frame and adds it
+         * to the history. Does nothing if the frame pacer is stopped.
+         */
+        FramePacer& nextFrame();
+
+        /**
+         * @brief Advance to next frame with an externally measured time
+         * @return Reference to self (for method chaining)
+         *
+         * Adds duration between @p time and the previous frame time to the
+         * history, without waiting for @ref targetFrameRate(). If @p time is
+         * before the previous frame time, the frame duration is zero. Does
+         * nothing if the frame pacer is stopped. See
+         * @ref FramePacer-present-feedback for more information.
+         */
+        FramePacer& nextFrame(std::chrono::steady_clock::time_point time);
+
+        /**
+         * @brief Time at previous frame (in seconds)
+         *
+         * Time elapsed between @ref start() and the last @ref nextFrame()
+         * call. If the frame pacer is stopped, returns @cpp 0.0f @ce.
+         */
+        Float previousFrameTime() const;
+
+        /**
+         * @brief Duration of previous frame (in seconds)
+         *
+         * Measured duration of the previous frame, including the time spent
+         * waiting for the target frame rate, without any clamping or
+         * smoothing. If the frame pacer is stopped, returns @cpp 0.0f @ce.
+         */
+        Float previousFrameDuration() const { return _previousFrameDuration; }
+
+        /**
+         * @brief Smoothed frame duration (in seconds)
+         *
+         * If no frames were measured yet, returns the target frame duration,
+         * or @cpp 0.0f @ce if @ref targetFrameRate() is not set. See
+         * @ref FramePacer-smoothing for more information.
+         */
+        Float smoothedFrameDuration() const;
+
+        /**
+         * @brief Predicted time of the next frame (in seconds)
+         *
+         * Calculated as @ref previousFrameTime() plus
+         * @ref smoothedFrameDuration(). Can be used for example to
+         * extrapolate positions of moving objects to the time the next frame
+         * gets displayed.
+         */
+        Float predictedNextFrameTime() const;
+
+        /**
+         * @brief Count of frames in the history
+         *
+         * At most @ref historySize().
+         */
+        UnsignedInt frameCount() const { return _historyCount; }
+
+        /**
+         * @brief Minimal frame duration in the history (in seconds)
+         *
+         * If there are no frames in the history, returns @cpp 0.0f @ce.
+         */
+        Float frameDurationMin() const;
+
+        /**
+         * @brief Maximal frame duration in the history (in seconds)
+         *
+         * If there are no frames in the history, returns @cpp 0.0f @ce.
+         */
+        Float frameDurationMax() const;
+
+        /**
+         * @brief Mean frame duration in the history (in seconds)
+         *
+         * Unlike @ref smoothedFrameDuration() not snapped to the refresh
+         * period. If there are no frames in the history, returns
+         * @cpp 0.0f @ce.
+         */
+        Float frameDurationMean() const;
+
+        /**
+         * @brief Frame duration standard deviation in the history (in seconds)
+         *
+         * If there are no frames in the history, returns @cpp 0.0f @ce.
+         */
+        Float frameDurationStandardDeviation() const;
+
+        /**
+         * @brief Frame duration percentile in the history (in seconds)
+         *
+         * Expects that @p percentile is in the @f$ [0, 1] @f$ range, with
+         * @cpp 0.5f @ce being a median and @cpp 1.0f @ce equivalent to
+         * @ref frameDurationMax(). If there are no frames in the history,
+         * returns @cpp 0.0f @ce. Done in an @f$ \mathcal{O}(n) @f$ execution
+         * time with @f$ n @f$ being @ref frameCount(), without any
+         * allocations.
+         */
+        Float frameDurationPercentile(Float percentile) const;
+
+    private:
+        void addFrame(std::chrono::steady_clock::time_point time);
+
+        std::chrono::steady_clock::time_point _startTime;
+        std::chrono::steady_clock::time_point _previousFrameTime;
+        std::chrono::steady_clock::time_point _deadline;
+        std::chrono::nanoseconds _targetFrameDuration{};
+        std::chrono::nanoseconds _spinDuration;
+        Float _refreshRate{};
+        Float _maxFrameDuration{0.25f};
+        Float _previousFrameDuration{};
+
+        /* Ring buffer of clamped frame durations */
+        Containers::Array<Float> _history;
+        /* Scratch space for frameDurationPercentile() */
+        mutable Containers::Array<Float> _sorted;
+        UnsignedInt _historyOffset{}, _historyCount{};
+
+        bool _running{};
+};
+
+}
+
+#endif
@@ -32,7 +32,16 @@
 #endif
 #include <Corrade/Containers/Reference.h>
 #include <Corrade/Utility/DebugStl.h>
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include <cstring>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StringStl.h>
+#include <Corrade/Utility/Path.h>
+#include <Corrade/Utility/Sha1.h>
+#endif
 
+#include "Magnum/ProfileScope.h"
+#include "Magnum/GL/Buffer.h"
 #include "Magnum/GL/Context.h"
 #include "Magnum/GL/Extensions.h"
 #include "Magnum/GL/Mesh.h"
@@ -360,7 +369,9 @@ AbstractShaderProgram& AbstractShaderProgram::draw(Mesh& mesh) {
     /* Nothing to draw, exit without touching any state */
     if(!mesh._count || !mesh._instanceCount) return *this;
 
+    MAGNUM_PROFILE_SCOPE("GL::AbstractShaderProgram::draw()");
     use();
+    ++Context::current().state().mesh.drawCount;
 
     #ifndef MAGNUM_TARGET_GLES2
     mesh.drawInternal(mesh._count, mesh._baseVertex, mesh._instanceCount, mesh._baseInstance, mesh._indexOffset, mesh._indexStart, mesh._indexEnd);
@@ -376,7 +387,9 @@ AbstractShaderProgram& AbstractShaderProgram::draw(MeshView& mesh) {
     /* Nothing to draw, exit without touching any state */
     if(!mesh._count || !mesh._instanceCount) return *this;
 
+    MAGNUM_PROFILE_SCOPE("GL::AbstractShaderProgram::draw()");
     use();
+    ++Context::current().state().mesh.drawCount;
 
     #ifndef MAGNUM_TARGET_GLES2
     mesh._original->drawInternal(mesh._count, mesh._baseVertex, mesh._instanceCount, mesh._baseInstance, mesh._indexOffset, mesh._indexStart, mesh._indexEnd);
@@ -389,7 +402,9 @@ AbstractShaderProgram& AbstractShaderProgram::draw(MeshView& mesh) {
 AbstractShaderProgram& AbstractShaderProgram::draw(Mesh& mesh, const Containers::StridedArrayView1D<const UnsignedInt>& counts, const Containers::StridedArrayView1D<const UnsignedInt>& vertexOffsets, const Containers::StridedArrayView1D<const UnsignedInt>& indexOffsets) {
     if(!counts.size()) return *this;
 
+    MAGNUM_PROFILE_SCOPE("GL::AbstractShaderProgram::draw()");
     use();
+    ++Context::current().state().mesh.drawCount;
 
     mesh.drawInternalStrided(counts, vertexOffsets, indexOffsets);
     return *this;
@@ -399,7 +414,9 @@ AbstractShaderProgram& AbstractShaderProgram::draw(Mesh& mesh, const Containers:
 AbstractShaderProgram& AbstractShaderProgram::draw(Mesh& mesh, const Containers::StridedArrayView1D<const UnsignedInt>& counts, const Containers::StridedArrayView1D<const UnsignedInt>& vertexOffsets, const Containers::StridedArrayView1D<const UnsignedLong>& indexOffsets) {
     if(!counts.size()) return *this;
 
+    MAGNUM_PROFILE_SCOPE("GL::AbstractShaderProgram::draw()");
     use();
+    ++Context::current().state().mesh.drawCount;
 
     mesh.drawInternalStrided(counts, vertexOffsets, indexOffsets);
     return *this;
@@ -415,7 +432,9 @@ AbstractShaderProgram& AbstractShaderProgram::draw(Mesh& mesh, const Containers:
 AbstractShaderProgram& AbstractShaderProgram::draw(Mesh& mesh, const Containers::StridedArrayView1D<const UnsignedInt>& counts, const Containers::StridedArrayView1D<const UnsignedInt>& instanceCounts, const Containers::StridedArrayView1D<const UnsignedInt>& vertexOffsets, const Containers::StridedArrayView1D<const UnsignedInt>& indexOffsets, const Containers::StridedArrayView1D<const UnsignedInt>& instanceOffsets) {
     if(!counts.size()) return *this;
 
+    MAGNUM_PROFILE_SCOPE("GL::AbstractShaderProgram::draw()");
     use();
+    ++Context::current().state().mesh.drawCount;
 
     mesh.drawInternalStrided(counts, instanceCounts, vertexOffsets, indexOffsets, instanceOffsets);
     return *this;
@@ -425,7 +444,9 @@ AbstractShaderProgram& AbstractShaderProgram::draw(Mesh& mesh, const Containers:
 AbstractShaderProgram& AbstractShaderProgram::draw(Mesh& mesh, const Containers::StridedArrayView1D<const UnsignedInt>& counts, const Containers::StridedArrayView1D<const UnsignedInt>& instanceCounts, const Containers::StridedArrayView1D<const UnsignedInt>& vertexOffsets, const Containers::StridedArrayView1D<const UnsignedLong>& indexOffsets, const Containers::StridedArrayView1D<const UnsignedInt>& instanceOffsets) {
     if(!counts.size()) return *this;
 
+    MAGNUM_PROFILE_SCOPE("GL::AbstractShaderProgram::draw()");
     use();
+    ++Context::current().state().mesh.drawCount;
 
     mesh.drawInternalStrided(counts, instanceCounts, vertexOffsets, indexOffsets, instanceOffsets);
     return *this;
@@ -440,7 +461,9 @@ AbstractShaderProgram& AbstractShaderProgram::draw(Mesh& mesh, const Containers:
 AbstractShaderProgram& AbstractShaderProgram::draw(Mesh& mesh, const Containers::StridedArrayView1D<const UnsignedInt>& counts, const Containers::StridedArrayView1D<const UnsignedInt>& instanceCounts, const Containers::StridedArrayView1D<const UnsignedInt>& vertexOffsets, const Containers::StridedArrayView1D<const UnsignedInt>& indexOffsets) {
     if(!counts.size()) return *this;
 
+    MAGNUM_PROFILE_SCOPE("GL::AbstractShaderProgram::draw()");
     use();
+    ++Context::current().state().mesh.drawCount;
 
     mesh.drawInternalStrided(counts, instanceCounts, vertexOffsets, indexOffsets
         #ifndef MAGNUM_TARGET_GLES2
@@ -454,7 +477,9 @@ AbstractShaderProgram& AbstractShaderProgram::draw(Mesh& mesh, const Containers:
 AbstractShaderProgram& AbstractShaderProgram::draw(Mesh& mesh, const Containers::StridedArrayView1D<const UnsignedInt>& counts, const Containers::StridedArrayView1D<const UnsignedInt>& instanceCounts, const Containers::StridedArrayView1D<const UnsignedInt>& vertexOffsets, const Containers::StridedArrayView1D<const UnsignedLong>& indexOffsets) {
     if(!counts.size()) return *this;
 
+    MAGNUM_PROFILE_SCOPE("GL::AbstractShaderProgram::draw()");
     use();
+    ++Context::current().state().mesh.drawCount;
 
     mesh.drawInternalStrided(counts, instanceCounts, vertexOffsets, indexOffsets
         #ifndef MAGNUM_TARGET_GLES2
@@ -473,7 +498,9 @@ AbstractShaderProgram& AbstractShaderProgram::draw(Mesh& mesh, const Containers:
 AbstractShaderProgram& AbstractShaderProgram::draw(Containers::ArrayView<const Containers::Reference<MeshView>> meshes) {
     if(meshes.isEmpty()) return *this;
 
+    MAGNUM_PROFILE_SCOPE("GL::AbstractShaderProgram::draw()");
     use();
+    ++Context::current().state().mesh.drawCount;
 
     #ifndef CORRADE_NO_ASSERT
     const Mesh* original = &*meshes.front()->_original;
@@ -498,7 +525,9 @@ AbstractShaderProgram& AbstractShaderProgram::drawTransformFeedback(Mesh& mesh,
     /* Nothing to draw, exit without touching any state */
     if(!mesh._instanceCount) return *this;
 
+    MAGNUM_PROFILE_SCOPE("GL::AbstractShaderProgram::drawTransformFeedback()");
     use();
+    ++Context::current().state().mesh.drawCount;
     mesh.drawInternal(xfb, stream, mesh._instanceCount);
     return *this;
 }
@@ -507,24 +536,83 @@ AbstractShaderProgram& AbstractShaderProgram::drawTransformFeedback(MeshView& me
     /* If nothing to draw, exit without touching any state */
     if(mesh._instanceCount) return *this;
 
+    MAGNUM_PROFILE_SCOPE("GL::AbstractShaderProgram::drawTransformFeedback()");
     use();
+    ++Context::current().state().mesh.drawCount;
     mesh._original->drawInternal(xfb, stream, mesh._instanceCount);
     return *this;
 }
 #endif
 
 #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+AbstractShaderProgram& AbstractShaderProgram::drawIndirect(Mesh& mesh, Buffer& buffer, const GLintptr offset) {
+    return drawIndirect(mesh, buffer, offset, 1);
+}
+
+AbstractShaderProgram& AbstractShaderProgram::drawIndirect(Mesh& mesh, Buffer& buffer, const GLintptr offset, const UnsignedInt drawCount, const UnsignedInt stride) {
+    CORRADE_ASSERT(!mesh._indexOffset,
+        "GL::AbstractShaderProgram::drawIndirect(): expected a zero index buffer offset but got" << mesh._indexOffset, *this);
+    CORRADE_ASSERT(offset % 4 == 0,
+        "GL::AbstractShaderProgram::drawIndirect(): expected the offset to be a multiple of 4 but got" << offset, *this);
+
+    /* Nothing to draw, exit without touching any state */
+    if(!drawCount) return *this;
+
+    MAGNUM_PROFILE_SCOPE("GL::AbstractShaderProgram::drawIndirect()");
+    use();
+    ++Context::current().state().mesh.drawCount;
+    mesh.drawInternalIndirect(buffer, offset, drawCount, stride);
+    return *this;
+}
+
+#ifndef MAGNUM_TARGET_GLES
+AbstractShaderProgram& AbstractShaderProgram::drawIndirect(Mesh& mesh, Buffer& buffer, const GLintptr offset, Buffer& countBuffer, const GLintptr countOffset, const UnsignedInt maxDrawCount, const UnsignedInt stride) {
+    CORRADE_ASSERT(!mesh._indexOffset,
+        "GL::AbstractShaderProgram::drawIndirect(): expected a zero index buffer offset but got" << mesh._indexOffset, *this);
+    CORRADE_ASSERT(offset % 4 == 0,
+        "GL::AbstractShaderProgram::drawIndirect(): expected the offset to be a multiple of 4 but got" << offset, *this);
+    CORRADE_ASSERT(countOffset % 4 == 0,
+        "GL::AbstractShaderProgram::drawIndirect(): expected the count offset to be a multiple of 4 but got" << countOffset, *this);
+
+    /* Nothing to draw, exit without touching any state */
+    if(!maxDrawCount) return *this;
+
+    MAGNUM_PROFILE_SCOPE("GL::AbstractShaderProgram::drawIndirect()");
+    use();
+    ++Context::current().state().mesh.drawCount;
+    mesh.drawInternalIndirect(buffer, offset, countBuffer, countOffset, maxDrawCount, stride);
+    return *this;
+}
+#endif
+
 AbstractShaderProgram& AbstractShaderProgram::dispatchCompute(const Vector3ui& workgroupCount) {
+    MAGNUM_PROFILE_SCOPE("GL::AbstractShaderProgram::dispatchCompute()");
     use();
+    ++Context::current().state().shaderProgram.dispatchCount;
     glDispatchCompute(workgroupCount.x(), workgroupCount.y(), workgroupCount.z());
     return *this;
 }
+
+AbstractShaderProgram& AbstractShaderProgram::dispatchComputeIndirect(Buffer& buffer, const GLintptr offset) {
+    CORRADE_ASSERT(offset % 4 == 0,
+        "GL::AbstractShaderProgram::dispatchComputeIndirect(): expected the offset to be a multiple of 4 but got" << offset, *this);
+
+    MAGNUM_PROFILE_SCOPE("GL::AbstractShaderProgram::dispatchComputeIndirect()");
+    use();
+    ++Context::current().state().shaderProgram.dispatchCount;
+    buffer.bindInternal(Buffer::TargetHint::DispatchIndirect);
+    glDispatchComputeIndirect(offset);
+    return *this;
+}
 #endif
 
 void AbstractShaderProgram::use(const GLuint id) {
     /* Use only if the program isn't already in use */
-    GLuint& current = Context::current().state().shaderProgram.current;
-    if(current != id) glUseProgram(current = id);
+    Implementation::ShaderProgramState& state = Context::current().state().shaderProgram;
+    if(state.current != id) {
+        glUseProgram(state.current = id);
+        ++state.switchCount;
+    }
 }
 
 void AbstractShaderProgram::use() { use(_id); }
@@ -586,52 +674,203 @@ void AbstractShaderProgram::transformFeedbackVaryingsImplementationDanglingWorka
 bool AbstractShaderProgram::link() { return link({*this}); }
 
 bool AbstractShaderProgram::link(std::initializer_list<Containers::Reference<AbstractShaderProgram>> shaders) {
-    bool allSuccess = true;
+    MAGNUM_PROFILE_SCOPE("GL::AbstractShaderProgram::link()");
 
     /* Invoke (possibly parallel) linking on all shaders */
-    for(AbstractShaderProgram& shader: shaders) glLinkProgram(shader._id);
+    for(AbstractShaderProgram& shader: shaders) shader.submitLink();
 
     /* After linking phase, check status of all shaders */
+    bool allSuccess = true;
     Int i = 1;
     for(AbstractShaderProgram& shader: shaders) {
-        GLint success, logLength;
-        glGetProgramiv(shader._id, GL_LINK_STATUS, &success);
-        glGetProgramiv(shader._id, GL_INFO_LOG_LENGTH, &logLength);
-
-        /* Error or warning message. The string is returned null-terminated,
-           strip the \0 at the end afterwards. */
-        std::string message(logLength, '\n');
-        if(message.size() > 1)
-            glGetProgramInfoLog(shader._id, message.size(), nullptr, &message[0]);
-        message.resize(Math::max(logLength, 1)-1);
-
-        /* Some drivers are chatty and can't keep shut when there's nothing to
-           be said, handle that as well. */
-        Context::current().state().shaderProgram.cleanLogImplementation(message);
-
-        /* Show error log */
-        if(!success) {
-            Error out{Debug::Flag::NoNewlineAtTheEnd};
-            out << "GL::AbstractShaderProgram::link(): linking";
-            if(shaders.size() != 1) out << "of shader" << i;
-            out << "failed with the following message:" << Debug::newline << message;
-
-        /* Or just warnings, if any */
-        } else if(!message.empty()) {
-            Warning out{Debug::Flag::NoNewlineAtTheEnd};
-            out << "GL::AbstractShaderProgram::link(): linking";
-            if(shaders.size() != 1) out << "of shader" << i;
-            out << "succeeded with the following message:" << Debug::newline << message;
-        }
-
         /* Success of all depends on each of them */
-        allSuccess = allSuccess && success;
+        allSuccess = shader.checkLinkInternal(shaders.size() != 1 ? i : 0) && allSuccess;
         ++i;
     }
 
     return allSuccess;
 }
 
+void AbstractShaderProgram::submitLink() {
+    glLinkProgram(_id);
+}
+
+bool AbstractShaderProgram::checkLink() { return checkLinkInternal(0); }
+
+bool AbstractShaderProgram::checkLinkInternal(const Int index) {
+    GLint success, logLength;
+    glGetProgramiv(_id, GL_LINK_STATUS, &success);
+    glGetProgramiv(_id, GL_INFO_LOG_LENGTH, &logLength);
+
+    /* Error or warning message. The string is returned null-terminated,
+       strip the \0 at the end afterwards. */
+    std::string message(logLength, '\n');
+    if(message.size() > 1)
+        glGetProgramInfoLog(_id, message.size(), nullptr, &message[0]);
+    message.resize(Math::max(logLength, 1)-1);
+
+    /* Some drivers are chatty and can't keep shut when there's nothing to
+       be said, handle that as well. */
+    Context::current().state().shaderProgram.cleanLogImplementation(message);
+
+    /* Show error log */
+    if(!success) {
+        Error out{Debug::Flag::NoNewlineAtTheEnd};
+        out << "GL::AbstractShaderProgram::link(): linking";
+        if(index) out << "of shader" << index;
+        out << "failed with the following message:" << Debug::newline << message;
+
+    /* Or just warnings, if any */
+    } else if(!message.empty()) {
+        Warning out{Debug::Flag::NoNewlineAtTheEnd};
+        out << "GL::AbstractShaderProgram::link(): linking";
+        if(index) out << "of shader" << index;
+        out << "succeeded with the following message:" << Debug::newline << message;
+    }
+
+    return success;
+}
+
+bool AbstractShaderProgram::isLinkFinished() {
+    if(!Context::current().isExtensionSupported<Extensions::KHR::parallel_shader_compile>())
+        return true;
+
+    GLint finished;
+    glGetProgramiv(_id, GL_COMPLETION_STATUS_KHR, &finished);
+    return finished == GL_TRUE;
+}
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+Containers::StringView AbstractShaderProgram::binaryCacheDirectory() {
+    return Context::current().state().shaderProgram.binaryCacheDirectory;
+}
+
+void AbstractShaderProgram::setBinaryCacheDirectory(const Containers::StringView directory) {
+    Context::current().state().shaderProgram.binaryCacheDirectory = Containers::String{directory};
+}
+
+namespace {
+
+/* Header of a cache file, followed by the binary data */
+struct BinaryCacheHeader {
+    char magic[4];
+    UnsignedInt format;
+};
+
+constexpr char BinaryCacheMagic[]{'M', 'G', 'P', 'B'};
+
+bool isBinaryCacheSupported(Context& context) {
+    if(context.state().shaderProgram.binaryCacheDirectory.isEmpty())
+        return false;
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!context.isExtensionSupported<Extensions::ARB::get_program_binary>())
+        return false;
+    #endif
+
+    /* Some drivers advertise the extension but support no formats */
+    GLint formatCount;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+    return formatCount > 0;
+}
+
+Containers::String binaryCacheFilename(Context& context, const std::initializer_list<Containers::Reference<const Shader>> shaders) {
+    Utility::Sha1 sha1;
+
+    /* Each string is terminated with a zero byte so different splits of the
+       same concatenated data don't result in the same key */
+    const char zero[1]{};
+    for(const Containers::StringView string: {context.vendorString(), context.rendererString(), context.versionString()})
+        sha1 << Containers::ArrayView<const char>{string.data(), string.size()} << Containers::arrayView(zero);
+    for(const Shader& shader: shaders) {
+        const GLenum type = GLenum(shader.type());
+        sha1 << Containers::arrayCast<const char>(Containers::arrayView(&type, 1));
+        for(const std::string& source: shader.sources())
+            sha1 << Containers::ArrayView<const char>{source.data(), source.size()} << Containers::arrayView(zero);
+    }
+
+    return Utility::Path::join(context.state().shaderProgram.binaryCacheDirectory, sha1.digest().hexString() + ".bin");
+}
+
+}
+
+bool AbstractShaderProgram::loadCachedBinary(const std::initializer_list<Containers::Reference<const Shader>> shaders) {
+    Context& context = Context::current();
+    if(!isBinaryCacheSupported(context)) return false;
+
+    /* From now on, if anything fails, the program gets compiled and the
+       caller is expected to save it afterwards */
+    setRetrievableBinary(true);
+
+    const Containers::String filename = binaryCacheFilename(context, shaders);
+    if(!Utility::Path::exists(filename)) return false;
+
+    const Containers::Optional<Containers::Array<char>> data = Utility::Path::read(filename);
+    if(!data || data->size() < sizeof(BinaryCacheHeader)) return false;
+
+    BinaryCacheHeader header;
+    std::memcpy(&header, data->data(), sizeof(BinaryCacheHeader));
+    if(std::memcmp(header.magic, BinaryCacheMagic, sizeof(BinaryCacheMagic)) != 0)
+        return false;
+
+    /* Check that the format is still supported to avoid a GL error on an
+       unknown enum */
+    {
+        GLint formatCount;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+        Containers::Array<GLint> formats{NoInit, std::size_t(formatCount)};
+        glGetIntegerv(GL_PROGRAM_BINARY_FORMATS, formats);
+        bool found = false;
+        for(const GLint format: formats) if(GLenum(format) == header.format) {
+            found = true;
+            break;
+        }
+        if(!found) return false;
+    }
+
+    glProgramBinary(_id, header.format, data->data() + sizeof(BinaryCacheHeader), data->size() - sizeof(BinaryCacheHeader));
+
+    /* The driver is free to reject the binary for any reason, such as a
+       driver update that didn't change the version string */
+    GLint success;
+    glGetProgramiv(_id, GL_LINK_STATUS, &success);
+    if(!success) {
+        if(context.configurationFlags() & Context::Configuration::Flag::VerboseLog)
+            Debug{} << "GL::AbstractShaderProgram::loadCachedBinary(): cached binary" << filename << "rejected by the driver, recompiling";
+        return false;
+    }
+
+    return true;
+}
+
+bool AbstractShaderProgram::saveCachedBinary(const std::initializer_list<Containers::Reference<const Shader>> shaders) {
+    Context& context = Context::current();
+    if(!isBinaryCacheSupported(context)) return false;
+
+    GLint size;
+    glGetProgramiv(_id, GL_PROGRAM_BINARY_LENGTH, &size);
+    if(!size) return false;
+
+    Containers::Array<char> data{NoInit, sizeof(BinaryCacheHeader) + size};
+    GLenum format;
+    GLsizei written;
+    glGetProgramBinary(_id, size, &written, &format, data + sizeof(BinaryCacheHeader));
+
+    BinaryCacheHeader header;
+    std::memcpy(header.magic, BinaryCacheMagic, sizeof(BinaryCacheMagic));
+    header.format = format;
+    std::memcpy(data, &header, sizeof(BinaryCacheHeader));
+
+    /* Write to a temporary file first and then move it over so concurrently
+       running instances never see a partially written file */
+    const Containers::String filename = binaryCacheFilename(context, shaders);
+    const Containers::String temporary = filename + ".tmp";
+    return Utility::Path::make(context.state().shaderProgram.binaryCacheDirectory) &&
+        Utility::Path::write(temporary, data.prefix(sizeof(BinaryCacheHeader) + written)) &&
+        Utility::Path::move(temporary, filename);
+}
+#endif
+
 void AbstractShaderProgram::cleanLogImplementationNoOp(std::string&) {}
 
 #if defined(CORRADE_TARGET_WINDOWS) && !defined(MAGNUM_TARGET_GLES)
@@ -438,6 +438,53 @@ use DSA functions to avoid unnecessary calls to @fn_gl{UseProgram}. See
 To achieve least state changes, set all uniforms in one run --- method chaining
 comes in handy.
 
+@subsection GL-AbstractShaderProgram-async Asynchronous compilation and linking
+
+The @ref Shader::compile() and @ref link() functions block until the
+operation finishes. If @gl_extension{KHR,parallel_shader_compile} is supported,
+the driver can compile and link in worker threads and the application can
+instead split the work into a submission and a later check of the result. A
+subclass can expose that by providing a static function returning a
+partially constructed instance, which submits the compilation with
+@ref Shader::submitCompile() and linking with @ref submitLink(), and a
+constructor taking the partially constructed instance, which calls
+@ref Shader::checkCompile() and @ref checkLink() and then finishes the
+initialization such as querying uniform locations:
+
+@snippet MagnumGL.cpp AbstractShaderProgram-async
+
+Then, many shaders can be submitted at once and while they're being compiled,
+the application can poll @ref isLinkFinished() and keep rendering a loading
+screen, for example. Without the extension, the submission does all the work
+synchronously and @ref isLinkFinished() always returns @cpp true @ce. All
+builtin @ref Shaders provide such a split, see for example
+@ref Shaders::FlatGL::compile().
+
+@subsection GL-AbstractShaderProgram-binary-cache Program binary cache
+
+On platforms supporting @gl_extension{ARB,get_program_binary} (part of OpenGL
+4.1) or OpenGL ES 3.0, compiled and linked programs can be cached on disk to
+avoid the compilation and linking cost on subsequent runs. The cache is opt-in
+and enabled by setting a directory with @ref setBinaryCacheDirectory(). A
+subclass then creates its @ref Shader instances and adds sources as usual, but
+before compiling them calls @ref loadCachedBinary(). If that succeeds, the
+program is ready to use and the compilation, attachment and linking can be
+skipped. Otherwise the program is compiled and linked as usual and the result
+is saved with @ref saveCachedBinary():
+
+@snippet MagnumGL.cpp AbstractShaderProgram-binary-cache
+
+The cache key is formed from the vendor, renderer and version strings of the
+current context together with types and sources of all shaders, which
+includes all preprocessor defines added with @ref Shader::addSource(). State
+specified before linking, such as attribute locations bound with
+@ref bindAttributeLocation(), is not a part of the key and thus it's expected
+to be fully determined by the shader sources. If the driver rejects the cached
+binary, for example because it got updated without changing its version
+string, @ref loadCachedBinary() returns @cpp false @ce and the program is
+compiled again, overwriting the stale cache entry. The @ref Shaders::FlatGL
+and @ref Shaders::PhongGL shaders make use of the cache.
+
 @see @ref portability-shaders
 
 @todo `GL_NUM_{PROGRAM,SHADER}_BINARY_FORMATS` + `GL_{PROGRAM,SHADER}_BINARY_FORMATS` (vector), (@gl_extension{ARB,ES2_compatibility})
@@ -670,6 +717,39 @@ class MAGNUM_GL_EXPORT AbstractShaderProgram: public AbstractObject {
         static Int maxTexelOffset();
         #endif
 
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        /**
+         * @brief Program binary cache directory
+         * @m_since_latest
+         *
+         * If empty, the program binary cache is disabled. Initially empty.
+         * @see @ref setBinaryCacheDirectory(),
+         *      @ref GL-AbstractShaderProgram-binary-cache
+         * @requires_gl41 Extension @gl_extension{ARB,get_program_binary}
+         * @requires_gles30 Binary program representations are not available
+         *      in OpenGL ES 2.0.
+         * @requires_gles Binary program representations are not supported in
+         *      WebGL.
+         */
+        static Containers::StringView binaryCacheDirectory();
+
+        /**
+         * @brief Set program binary cache directory
+         * @m_since_latest
+         *
+         * The directory is created on first save if it doesn't exist. Set to
+         * an empty string to disable the cache again. The setting is stored
+         * in the state of the current context. See
+         * @ref GL-AbstractShaderProgram-binary-cache for more information.
+         * @requires_gl41 Extension @gl_extension{ARB,get_program_binary}
+         * @requires_gles30 Binary program representations are not available
+         *      in OpenGL ES 2.0.
+         * @requires_gles Binary program representations are not supported in
+         *      WebGL.
+         */
+        static void setBinaryCacheDirectory(Containers::StringView directory);
+        #endif
+
         /**
          * @brief Constructor
          *
@@ -1243,21 +1323,185 @@ class MAGNUM_GL_EXPORT AbstractShaderProgram: public AbstractObject {
         #endif
 
         #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        /**
+         * @brief Draw a mesh with parameters coming from a buffer
+         * @param mesh      Mesh to draw
+         * @param buffer    Buffer containing the draw command
+         * @param offset    Offset of the draw command in @p buffer, in bytes
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @p mesh is compatible with this shader and is fully
+         * set up. Everything set by @ref Mesh::setCount(),
+         * @ref Mesh::setBaseVertex(), @ref Mesh::setInstanceCount() and
+         * @ref Mesh::setBaseInstance() is ignored, the parameters are instead
+         * taken from @p buffer at @p offset, which is expected to contain the
+         * following four 32-bit unsigned integers for a non-indexed mesh:
+         *
+         * @code{.cpp}
+         * struct {
+         *     UnsignedInt count;
+         *     UnsignedInt instanceCount;
+         *     UnsignedInt first;
+         *     UnsignedInt baseInstance;
+         * };
+         * @endcode
+         *
+         * And the following five for an indexed mesh, with @cpp firstIndex @ce
+         * being in units of the index type, counted from the start of the
+         * index buffer. Because of that the index buffer is expected to be
+         * set with a zero offset in @ref Mesh::setIndexBuffer().
+         *
+         * @code{.cpp}
+         * struct {
+         *     UnsignedInt count;
+         *     UnsignedInt instanceCount;
+         *     UnsignedInt firstIndex;
+         *     UnsignedInt baseVertex;
+         *     UnsignedInt baseInstance;
+         * };
+         * @endcode
+         *
+         * The data can be filled on the GPU, for example by a compute shader
+         * culling the draws, without being read back to the CPU. If
+         * @gl_extension{ARB,vertex_array_object} (part of OpenGL 3.0) is
+         * available or on OpenGL ES, the associated vertex array object is
+         * bound instead of setting up the mesh from scratch.
+         * @see @ref drawIndirect(Mesh&, Buffer&, GLintptr, UnsignedInt, UnsignedInt),
+         *      @ref Buffer::TargetHint::DrawIndirect, @fn_gl{UseProgram},
+         *      @fn_gl{BindBuffer} with @def_gl{DRAW_INDIRECT_BUFFER},
+         *      @fn_gl_keyword{DrawArraysIndirect} or
+         *      @fn_gl_keyword{DrawElementsIndirect}
+         * @requires_gl40 Extension @gl_extension{ARB,draw_indirect}
+         * @requires_gles31 Indirect drawing is not available in OpenGL ES
+         *      3.0 and older.
+         * @requires_gles Indirect drawing is not available in WebGL.
+         */
+        AbstractShaderProgram& drawIndirect(Mesh& mesh, Buffer& buffer, GLintptr offset = 0);
+
+        /**
+         * @brief Draw multiple instances of a mesh with parameters coming from a buffer
+         * @param mesh      Mesh to draw
+         * @param buffer    Buffer containing the draw commands
+         * @param offset    Offset of the first draw command in @p buffer, in
+         *      bytes
+         * @param drawCount Count of draw commands
+         * @param stride    Stride between the draw commands. If
+         *      @cpp 0 @ce, the commands are assumed to be tightly packed.
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Executes @p drawCount draw commands in a single call. Layout of the
+         * commands is described in @ref drawIndirect(Mesh&, Buffer&, GLintptr).
+         * If @p drawCount is @cpp 0 @ce, the function does nothing.
+         *
+         * On OpenGL ES, which doesn't have a multi-draw variant of indirect
+         * draws, the functionality is emulated with a sequence of
+         * @fn_gl{DrawArraysIndirect} / @fn_gl{DrawElementsIndirect} calls.
+         * Note that in that case @glsl gl_DrawID @ce isn't available in the
+         * shader.
+         * @see @ref Buffer::TargetHint::DrawIndirect, @fn_gl{UseProgram},
+         *      @fn_gl{BindBuffer} with @def_gl{DRAW_INDIRECT_BUFFER},
+         *      @fn_gl_keyword{MultiDrawArraysIndirect} or
+         *      @fn_gl_keyword{MultiDrawElementsIndirect}
+         * @requires_gl43 Extension @gl_extension{ARB,multi_draw_indirect}
+         * @requires_gles31 Indirect drawing is not available in OpenGL ES
+         *      3.0 and older.
+         * @requires_gles Indirect drawing is not available in WebGL.
+         */
+        AbstractShaderProgram& drawIndirect(Mesh& mesh, Buffer& buffer, GLintptr offset, UnsignedInt drawCount, UnsignedInt stride = 0);
+
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Draw multiple instances of a mesh with parameters and draw count coming from a buffer
+         * @param mesh          Mesh to draw
+         * @param buffer        Buffer containing the draw commands
+         * @param offset        Offset of the first draw command in
+         *      @p buffer, in bytes
+         * @param countBuffer   Buffer containing the draw count
+         * @param countOffset   Offset of the draw count in @p countBuffer, in
+         *      bytes. Expected to be a multiple of four.
+         * @param maxDrawCount  Max count of draw commands to execute
+         * @param stride        Stride between the draw commands. If
+         *      @cpp 0 @ce, the commands are assumed to be tightly packed.
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Compared to @ref drawIndirect(Mesh&, Buffer&, GLintptr, UnsignedInt, UnsignedInt)
+         * the actual draw count is taken from a 32-bit unsigned integer at
+         * @p countOffset in @p countBuffer, clamped to @p maxDrawCount. This
+         * allows a GPU culling pass to decide also the count of draws without
+         * any CPU readback. If @p maxDrawCount is @cpp 0 @ce, the function
+         * does nothing.
+         * @see @ref Buffer::TargetHint::DrawIndirect,
+         *      @ref Buffer::TargetHint::Parameter, @fn_gl{UseProgram},
+         *      @fn_gl{BindBuffer} with @def_gl{DRAW_INDIRECT_BUFFER} and
+         *      @def_gl{PARAMETER_BUFFER},
+         *      @fn_gl_keyword{MultiDrawArraysIndirectCount} or
+         *      @fn_gl_keyword{MultiDrawElementsIndirectCount}
+         * @requires_gl46 OpenGL 4.6 is required, the ARB-suffixed entry
+         *      points of @gl_extension{ARB,indirect_parameters} aren't
+         *      exposed.
+         * @requires_gl Indirect draw count is not available in OpenGL ES or
+         *      WebGL.
+         */
+        AbstractShaderProgram& drawIndirect(Mesh& mesh, Buffer& buffer, GLintptr offset, Buffer& countBuffer, GLintptr countOffset, UnsignedInt maxDrawCount, UnsignedInt stride = 0);
+        #endif
+
         /**
          * @brief Dispatch compute
          * @param workgroupCount    Workgroup count in given dimension
          * @return Reference to self (for method chaining)
          *
          * Valid only on programs with compute shader attached.
-         * @see @fn_gl{DispatchCompute}
+         * @see @ref dispatchComputeIndirect(), @fn_gl{DispatchCompute}
          * @requires_gl43 Extension @gl_extension{ARB,compute_shader}
          * @requires_gles31 Compute shaders are not available in OpenGL ES 3.0
          *      and older.
          * @requires_gles Compute shaders are not available in WebGL.
          */
         AbstractShaderProgram& dispatchCompute(const Vector3ui& workgroupCount);
+
+        /**
+         * @brief Dispatch compute with workgroup count coming from a buffer
+         * @param buffer    Buffer containing the workgroup count
+         * @param offset    Offset of the workgroup count in @p buffer, in
+         *      bytes. Expected to be a multiple of four.
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Valid only on programs with compute shader attached. The @p buffer
+         * is expected to contain three 32-bit unsigned integers with the
+         * workgroup count in each dimension at @p offset, which makes it
+         * possible for a previous compute pass to decide the amount of work
+         * on the GPU.
+         * @see @ref dispatchCompute(), @ref Buffer::TargetHint::DispatchIndirect,
+         *      @fn_gl{BindBuffer} with @def_gl{DISPATCH_INDIRECT_BUFFER},
+         *      @fn_gl_keyword{DispatchComputeIndirect}
+         * @requires_gl43 Extension @gl_extension{ARB,compute_shader}
+         * @requires_gles31 Compute shaders are not available in OpenGL ES 3.0
+         *      and older.
+         * @requires_gles Compute shaders are not available in WebGL.
+         */
+        AbstractShaderProgram& dispatchComputeIndirect(Buffer& buffer, GLintptr offset = 0);
         #endif
 
+        /**
+         * @brief Whether the program linking has finished
+         * @m_since_latest
+         *
+         * Expects that @ref submitLink() was called before. If
+         * @gl_extension{KHR,parallel_shader_compile} is supported, queries
+         * the completion status, making it possible to do other work until
+         * the linking finishes. Otherwise always returns @cpp true @ce, as
+         * the linking is then done synchronously. The result of the linking
+         * then has to be retrieved with @ref checkLink() in any case. See
+         * @ref GL-AbstractShaderProgram-async for more information.
+         * @see @ref Shader::isCompileFinished(), @fn_gl_keyword{GetProgram}
+         *      with @def_gl_extension{COMPLETION_STATUS,KHR,parallel_shader_compile}
+         */
+        bool isLinkFinished();
+
     protected:
         /**
          * @brief Link the shader
@@ -1268,6 +1512,11 @@ class MAGNUM_GL_EXPORT AbstractShaderProgram: public AbstractObject {
          * @ref Shader::compile() before linking. The operation is batched in a
          * way that allows the driver to link multiple shaders simultaneously
          * (i.e. in multiple threads).
+         *
+         * Equivalent to calling @ref submitLink() on all @p shaders and then
+         * @ref checkLink() on all of them. See
+         * @ref GL-AbstractShaderProgram-async for a way to not block on the
+         * linking.
          * @see @fn_gl_keyword{LinkProgram}, @fn_gl_keyword{GetProgram} with
          *      @def_gl{LINK_STATUS} and @def_gl{INFO_LOG_LENGTH},
          *      @fn_gl_keyword{GetProgramInfoLog}
@@ -1289,6 +1538,55 @@ class MAGNUM_GL_EXPORT AbstractShaderProgram: public AbstractObject {
         void setRetrievableBinary(bool enabled) {
             glProgramParameteri(_id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, enabled ? GL_TRUE : GL_FALSE);
         }
+
+        /**
+         * @brief Load program binary from the cache
+         * @param shaders   Shaders the program would be linked from
+         * @m_since_latest
+         *
+         * If a cache directory is set with @ref setBinaryCacheDirectory(),
+         * the driver supports at least one program binary format and the
+         * cache contains a binary matching the current context and sources
+         * of @p shaders, uploads it with @fn_gl_keyword{ProgramBinary} and
+         * returns @cpp true @ce. The program is then linked and @p shaders
+         * don't need to be compiled or attached at all.
+         *
+         * Returns @cpp false @ce if the cache is disabled, the binary isn't
+         * found or the driver rejected it. In that case, if the cache is
+         * enabled, @ref setRetrievableBinary() is called so the program can
+         * be saved with @ref saveCachedBinary() after linking. See
+         * @ref GL-AbstractShaderProgram-binary-cache for more information.
+         * @see @fn_gl{Get} with @def_gl{NUM_PROGRAM_BINARY_FORMATS} and
+         *      @def_gl{PROGRAM_BINARY_FORMATS}, @fn_gl_keyword{GetProgram}
+         *      with @def_gl{LINK_STATUS}
+         * @requires_gl41 Extension @gl_extension{ARB,get_program_binary}
+         * @requires_gles30 Binary program representations are not available
+         *      in OpenGL ES 2.0.
+         * @requires_gles Binary program representations are not supported in
+         *      WebGL.
+         */
+        bool loadCachedBinary(std::initializer_list<Containers::Reference<const Shader>> shaders);
+
+        /**
+         * @brief Save program binary to the cache
+         * @param shaders   Shaders the program was linked from
+         * @m_since_latest
+         *
+         * Expects that the program was successfully linked from @p shaders.
+         * If a cache directory is set with @ref setBinaryCacheDirectory(),
+         * retrieves the binary with @fn_gl_keyword{GetProgramBinary} and
+         * saves it to the cache, returning @cpp true @ce on success. Returns
+         * @cpp false @ce if the cache is disabled, the driver supports no
+         * program binary formats or the file can't be written. See
+         * @ref GL-AbstractShaderProgram-binary-cache for more information.
+         * @see @fn_gl{GetProgram} with @def_gl{PROGRAM_BINARY_LENGTH}
+         * @requires_gl41 Extension @gl_extension{ARB,get_program_binary}
+         * @requires_gles30 Binary program representations are not available
+         *      in OpenGL ES 2.0.
+         * @requires_gles Binary program representations are not supported in
+         *      WebGL.
+         */
+        bool saveCachedBinary(std::initializer_list<Containers::Reference<const Shader>> shaders);
         #endif
 
         #ifndef MAGNUM_TARGET_WEBGL
@@ -1453,6 +1751,33 @@ class MAGNUM_GL_EXPORT AbstractShaderProgram: public AbstractObject {
          */
         bool link();
 
+        /**
+         * @brief Submit the program for linking
+         * @m_since_latest
+         *
+         * Invokes the linking without waiting for it to finish. All attached
+         * shaders are expected to be at least submitted for compilation with
+         * @ref Shader::submitCompile(). Call @ref checkLink() afterwards to
+         * retrieve the result. See @ref GL-AbstractShaderProgram-async for
+         * more information.
+         * @see @ref link(), @fn_gl_keyword{LinkProgram}
+         */
+        void submitLink();
+
+        /**
+         * @brief Check program link status and await completion
+         * @m_since_latest
+         *
+         * Expects that @ref submitLink() was called before. Returns
+         * @cpp false @ce if the linking failed, @cpp true @ce on success.
+         * Linker message (if any) is printed to error output. If the linking
+         * didn't finish yet, the call blocks until it does.
+         * @see @ref isLinkFinished(), @fn_gl_keyword{GetProgram} with
+         *      @def_gl{LINK_STATUS} and @def_gl{INFO_LOG_LENGTH},
+         *      @fn_gl_keyword{GetProgramInfoLog}
+         */
+        bool checkLink();
+
         /**
          * @brief Get uniform location
          * @param name          Uniform name
@@ -1652,6 +1977,7 @@ class MAGNUM_GL_EXPORT AbstractShaderProgram: public AbstractObject {
         #endif
         Int uniformLocationInternal(Containers::ArrayView<const char> name);
         UnsignedInt uniformBlockIndexInternal(Containers::ArrayView<const char> name);
+        bool MAGNUM_GL_LOCAL checkLinkInternal(Int index);
 
         #ifndef MAGNUM_TARGET_GLES2
         void MAGNUM_GL_LOCAL transformFeedbackVaryingsImplementationDefault(Containers::ArrayView<const std::string> outputs, TransformFeedbackBufferMode bufferMode);
@@ -42,6 +42,10 @@
 #ifndef MAGNUM_TARGET_WEBGL
 #include "Magnum/GL/Implementation/DebugState.h"
 #endif
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/GL/Implementation/imageStaging.h"
+#endif
+#include "Magnum/GL/Implementation/MemoryUsageState.h"
 #include "Magnum/GL/Implementation/RendererState.h"
 #include "Magnum/GL/Implementation/State.h"
 #include "Magnum/GL/Implementation/TextureState.h"
@@ -123,6 +127,7 @@ void AbstractTexture::unbind(const Int textureUnit) {
 
     /* Unbind the texture, reset state tracker */
     Context::current().state().texture.unbindImplementation(textureUnit);
+    ++textureState.bindCount;
     /* libstdc++ since GCC 6.3 can't handle just = {} (ambiguous overload of
        operator=) */
     textureState.bindings[textureUnit] = std::pair<GLenum, GLuint>{};
@@ -187,6 +192,7 @@ void AbstractTexture::bindImplementationMulti(const GLint firstTextureUnit, Cont
         if(textureState.bindings[firstTextureUnit + i].second != id) {
             different = true;
             textureState.bindings[firstTextureUnit + i].second = id;
+            ++textureState.bindCount;
         }
     }
 
@@ -248,6 +254,7 @@ AbstractTexture::~AbstractTexture() {
     }
     #endif
 
+    Implementation::memoryUsageRemove(MemoryUsageCategory::Texture, _id);
     glDeleteTextures(1, &_id);
 }
 
@@ -271,6 +278,7 @@ Containers::String AbstractTexture::label() {
 AbstractTexture& AbstractTexture::setLabel(const Containers::StringView label) {
     createIfNotAlready();
     Context::current().state().debug.labelImplementation(GL_TEXTURE, _id, label);
+    Implementation::memoryUsageLabel(MemoryUsageCategory::Texture, _id, label);
     return *this;
 }
 #endif
@@ -331,6 +339,70 @@ void AbstractTexture::bindImageInternal(const Int imageUnit, const Int level, co
 }
 #endif
 
+#ifndef MAGNUM_TARGET_GLES
+void AbstractTexture::makeHandleResident(const UnsignedLong handle) {
+    glMakeTextureHandleResidentARB(handle);
+}
+
+void AbstractTexture::makeHandleNonResident(const UnsignedLong handle) {
+    glMakeTextureHandleNonResidentARB(handle);
+}
+
+bool AbstractTexture::isHandleResident(const UnsignedLong handle) {
+    return glIsTextureHandleResidentARB(handle);
+}
+
+UnsignedLong AbstractTexture::handleInternal() {
+    /* The texture has to exist for the handle query to work, without DSA it
+       needs to be bound at least once */
+    createIfNotAlready();
+    return glGetTextureHandleARB(_id);
+}
+
+Int AbstractTexture::virtualPageSizeCountInternal(const GLenum target, const TextureFormat format) {
+    GLint value;
+    glGetInternalformativ(target, GLenum(format), GL_NUM_VIRTUAL_PAGE_SIZES_ARB, 1, &value);
+    return value;
+}
+
+Vector3i AbstractTexture::virtualPageSizeInternal(const GLenum target, const TextureFormat format, const Int index) {
+    const Int count = virtualPageSizeCountInternal(target, format);
+    CORRADE_ASSERT(index < count,
+        "GL::AbstractTexture::virtualPageSize(): index" << index << "out of range for" << count << "page sizes", {});
+
+    /* The queries return all page sizes at once, so fetch them all and pick
+       the one in question */
+    Containers::Array<GLint> values{NoInit, std::size_t(count)*3};
+    glGetInternalformativ(target, GLenum(format), GL_VIRTUAL_PAGE_SIZE_X_ARB, count, values.data());
+    glGetInternalformativ(target, GLenum(format), GL_VIRTUAL_PAGE_SIZE_Y_ARB, count, values.data() + count);
+    glGetInternalformativ(target, GLenum(format), GL_VIRTUAL_PAGE_SIZE_Z_ARB, count, values.data() + 2*count);
+    return {values[index], values[count + index], values[2*count + index]};
+}
+
+void AbstractTexture::setSparseInternal(const bool sparse, const Int virtualPageSizeIndex) {
+    /* Both have to be set before the storage is allocated */
+    (this->*Context::current().state().texture.parameteriImplementation)(GL_VIRTUAL_PAGE_SIZE_INDEX_ARB, virtualPageSizeIndex);
+    (this->*Context::current().state().texture.parameteriImplementation)(GL_TEXTURE_SPARSE_ARB, sparse);
+}
+
+Int AbstractTexture::sparseLevelCountInternal() {
+    bindInternal();
+    GLint value;
+    glGetTexParameteriv(_target, GL_NUM_SPARSE_LEVELS_ARB, &value);
+    return value;
+}
+
+void AbstractTexture::pageCommitmentInternal(const GLint level, const Range2Di& range, const bool commit) {
+    pageCommitmentInternal(level, Range3Di{{range.min(), 0}, {range.max(), 1}}, commit);
+}
+
+void AbstractTexture::pageCommitmentInternal(const GLint level, const Range3Di& range, const bool commit) {
+    bindInternal();
+    const Vector3i size = range.size();
+    glTexPageCommitmentARB(_target, level, range.min().x(), range.min().y(), range.min().z(), size.x(), size.y(), size.z(), commit);
+}
+#endif
+
 void AbstractTexture::bind(Int textureUnit) {
     Implementation::TextureState& textureState = Context::current().state().texture;
 
@@ -340,6 +412,7 @@ void AbstractTexture::bind(Int textureUnit) {
     /* Update state tracker, bind the texture to the unit */
     textureState.bindings[textureUnit] = {_target, _id};
     (this->*textureState.bindImplementation)(textureUnit);
+    ++textureState.bindCount;
 }
 
 void AbstractTexture::bindImplementationDefault(GLint textureUnit) {
@@ -2108,29 +2181,82 @@ Vector3i AbstractTexture::DataHelper<3>::imageSize(AbstractTexture& texture, con
 }
 #endif
 
+namespace {
+
+/* Size of all levels of a texture storage for memory usage tracking. Layers
+   of array textures are not scaled, cube map textures have six faces. */
+std::size_t textureStorageDataSize(const GLenum target, const GLsizei levels, const TextureFormat internalFormat, const Vector3i& size) {
+    Vector3i scaled{1};
+    std::size_t faces = 1;
+    #ifndef MAGNUM_TARGET_GLES
+    if(target == GL_TEXTURE_1D_ARRAY) scaled.y() = 0;
+    #endif
+    #ifndef MAGNUM_TARGET_GLES2
+    if(target == GL_TEXTURE_2D_ARRAY) scaled.z() = 0;
+    #endif
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if(target ==
+        #ifndef MAGNUM_TARGET_GLES
+        GL_TEXTURE_CUBE_MAP_ARRAY
+        #else
+        GL_TEXTURE_CUBE_MAP_ARRAY_EXT
+        #endif
+    ) scaled.z() = 0;
+    #endif
+    if(target == GL_TEXTURE_CUBE_MAP) faces = 6;
+
+    std::size_t dataSize = 0;
+    for(GLsizei level = 0; level != levels; ++level) {
+        Vector3i levelSize;
+        for(std::size_t i = 0; i != 3; ++i)
+            levelSize[i] = Math::max(scaled[i] ? size[i] >> level : size[i], 1);
+        dataSize += faces*Implementation::textureFormatDataSize(GLenum(internalFormat), levelSize);
+    }
+    return dataSize;
+}
+
+/* Cube map faces specified with setImage() are tracked as separate slices */
+std::size_t textureImageSlice(const GLenum target, const GLint level) {
+    if(target >= GL_TEXTURE_CUBE_MAP_POSITIVE_X && target <= GL_TEXTURE_CUBE_MAP_NEGATIVE_Z)
+        return level*6 + (target - GL_TEXTURE_CUBE_MAP_POSITIVE_X);
+    return level;
+}
+
+}
+
 #ifndef MAGNUM_TARGET_GLES
 void AbstractTexture::DataHelper<1>::setStorage(AbstractTexture& texture, const GLsizei levels, const TextureFormat internalFormat, const Math::Vector< 1, GLsizei >& size) {
     (texture.*Context::current().state().texture.storage1DImplementation)(levels, internalFormat, size);
+    Implementation::memoryUsageSet(MemoryUsageCategory::Texture, texture._id,
+        textureStorageDataSize(texture._target, levels, internalFormat, {size[0], 1, 1}));
 }
 #endif
 
 void AbstractTexture::DataHelper<2>::setStorage(AbstractTexture& texture, const GLsizei levels, const TextureFormat internalFormat, const Vector2i& size) {
     (texture.*Context::current().state().texture.storage2DImplementation)(levels, internalFormat, size);
+    Implementation::memoryUsageSet(MemoryUsageCategory::Texture, texture._id,
+        textureStorageDataSize(texture._target, levels, internalFormat, {size, 1}));
 }
 
 #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
 void AbstractTexture::DataHelper<3>::setStorage(AbstractTexture& texture, const GLsizei levels, const TextureFormat internalFormat, const Vector3i& size) {
     (texture.*Context::current().state().texture.storage3DImplementation)(levels, internalFormat, size);
+    Implementation::memoryUsageSet(MemoryUsageCategory::Texture, texture._id,
+        textureStorageDataSize(texture._target, levels, internalFormat, size));
 }
 #endif
 
 #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
 void AbstractTexture::DataHelper<2>::setStorageMultisample(AbstractTexture& texture, const GLsizei samples, const TextureFormat internalFormat, const Vector2i& size, const GLboolean fixedSampleLocations) {
     (texture.*Context::current().state().texture.storage2DMultisampleImplementation)(samples, internalFormat, size, fixedSampleLocations);
+    Implementation::memoryUsageSet(MemoryUsageCategory::Texture, texture._id,
+        samples*Implementation::textureFormatDataSize(GLenum(internalFormat), {size, 1}));
 }
 
 void AbstractTexture::DataHelper<3>::setStorageMultisample(AbstractTexture& texture, const GLsizei samples, const TextureFormat internalFormat, const Vector3i& size, const GLboolean fixedSampleLocations) {
     (texture.*Context::current().state().texture.storage3DMultisampleImplementation)(samples, internalFormat, size, fixedSampleLocations);
+    Implementation::memoryUsageSet(MemoryUsageCategory::Texture, texture._id,
+        samples*Implementation::textureFormatDataSize(GLenum(internalFormat), size));
 }
 #endif
 
@@ -2140,6 +2266,8 @@ void AbstractTexture::DataHelper<1>::setImage(AbstractTexture& texture, const GL
     Context::current().state().renderer.applyPixelStorageUnpack(image.storage());
     texture.bindInternal();
     glTexImage1D(texture._target, level, GLint(internalFormat), image.size()[0], 0, GLenum(pixelFormat(image.format())), GLenum(pixelType(image.format(), image.formatExtra())), image.data());
+    Implementation::memoryUsageSetSlice(MemoryUsageCategory::Texture, texture._id, level,
+        Implementation::textureFormatDataSize(GLenum(internalFormat), {image.size()[0], 1, 1}));
 }
 
 void AbstractTexture::DataHelper<1>::setCompressedImage(AbstractTexture& texture, const GLint level, const CompressedImageView1D& image) {
@@ -2147,6 +2275,8 @@ void AbstractTexture::DataHelper<1>::setCompressedImage(AbstractTexture& texture
     Context::current().state().renderer.applyPixelStorageUnpack(image.storage());
     texture.bindInternal();
     glCompressedTexImage1D(texture._target, level, GLenum(image.format()), image.size()[0], 0, Magnum::Implementation::occupiedCompressedImageDataSize(image, image.data().size()), image.data());
+    Implementation::memoryUsageSetSlice(MemoryUsageCategory::Texture, texture._id, level,
+        Implementation::textureFormatDataSize(GLenum(image.format()), {image.size()[0], 1, 1}));
 }
 
 void AbstractTexture::DataHelper<1>::setImage(AbstractTexture& texture, const GLint level, const TextureFormat internalFormat, BufferImage1D& image) {
@@ -2154,6 +2284,8 @@ void AbstractTexture::DataHelper<1>::setImage(AbstractTexture& texture, const GL
     Context::current().state().renderer.applyPixelStorageUnpack(image.storage());
     texture.bindInternal();
     glTexImage1D(texture._target, level, GLint(internalFormat), image.size()[0], 0, GLenum(image.format()), GLenum(image.type()), nullptr);
+    Implementation::memoryUsageSetSlice(MemoryUsageCategory::Texture, texture._id, level,
+        Implementation::textureFormatDataSize(GLenum(internalFormat), {image.size()[0], 1, 1}));
 }
 
 void AbstractTexture::DataHelper<1>::setCompressedImage(AbstractTexture& texture, const GLint level, CompressedBufferImage1D& image) {
@@ -2161,6 +2293,8 @@ void AbstractTexture::DataHelper<1>::setCompressedImage(AbstractTexture& texture
     Context::current().state().renderer.applyPixelStorageUnpack(image.storage());
     texture.bindInternal();
     glCompressedTexImage1D(texture._target, level, GLenum(image.format()), image.size()[0], 0, Magnum::Implementation::occupiedCompressedImageDataSize(image, image.dataSize()), nullptr);
+    Implementation::memoryUsageSetSlice(MemoryUsageCategory::Texture, texture._id, level,
+        Implementation::textureFormatDataSize(GLenum(image.format()), {image.size()[0], 1, 1}));
 }
 
 void AbstractTexture::DataHelper<1>::setSubImage(AbstractTexture& texture, const GLint level, const Math::Vector<1, GLint>& offset, const ImageView1D& image) {
@@ -2186,6 +2320,51 @@ void AbstractTexture::DataHelper<1>::setCompressedSubImage(AbstractTexture& text
     Context::current().state().renderer.applyPixelStorageUnpack(image.storage());
     (texture.*Context::current().state().texture.compressedSubImage1DImplementation)(level, offset, image.size(), image.format(), nullptr, Magnum::Implementation::occupiedCompressedImageDataSize(image, image.dataSize()));
 }
+
+void AbstractTexture::DataHelper<1>::setSubImages(AbstractTexture& texture, const GLint firstLevel, const Containers::ArrayView<const ImageView1D> images) {
+    /* Unbinding the pixel unpack buffer and fetching the state just once for
+       all levels. The pixel storage is applied for each, but the state
+       tracker skips it if it's the same as for the previous level. */
+    Buffer::unbindInternal(Buffer::TargetHint::PixelUnpack);
+    Implementation::State& state = Context::current().state();
+    for(std::size_t i = 0; i != images.size(); ++i) {
+        const ImageView1D& image = images[i];
+        state.renderer.applyPixelStorageUnpack(image.storage());
+        (texture.*state.texture.subImage1DImplementation)(GLint(firstLevel + i), {}, image.size(), pixelFormat(image.format()), pixelType(image.format(), image.formatExtra()), image.data());
+    }
+}
+
+void AbstractTexture::DataHelper<1>::setCompressedSubImages(AbstractTexture& texture, const GLint firstLevel, const Containers::ArrayView<const CompressedImageView1D> images) {
+    Buffer::unbindInternal(Buffer::TargetHint::PixelUnpack);
+    Implementation::State& state = Context::current().state();
+    for(std::size_t i = 0; i != images.size(); ++i) {
+        const CompressedImageView1D& image = images[i];
+        state.renderer.applyPixelStorageUnpack(image.storage());
+        (texture.*state.texture.compressedSubImage1DImplementation)(GLint(firstLevel + i), {}, image.size(), compressedPixelFormat(image.format()), image.data(), Magnum::Implementation::occupiedCompressedImageDataSize(image, image.data().size()));
+    }
+}
+
+void AbstractTexture::DataHelper<1>::setSubImages(AbstractTexture& texture, const GLint firstLevel, const Containers::ArrayView<const ImageView1D> images, Buffer& stagingBuffer) {
+    const Containers::Array<std::size_t> offsets = Implementation::stageImageData(stagingBuffer, images);
+    stagingBuffer.bindInternal(Buffer::TargetHint::PixelUnpack);
+    Implementation::State& state = Context::current().state();
+    for(std::size_t i = 0; i != images.size(); ++i) {
+        const ImageView1D& image = images[i];
+        state.renderer.applyPixelStorageUnpack(image.storage());
+        (texture.*state.texture.subImage1DImplementation)(GLint(firstLevel + i), {}, image.size(), pixelFormat(image.format()), pixelType(image.format(), image.formatExtra()), reinterpret_cast<const GLvoid*>(offsets[i]));
+    }
+}
+
+void AbstractTexture::DataHelper<1>::setCompressedSubImages(AbstractTexture& texture, const GLint firstLevel, const Containers::ArrayView<const CompressedImageView1D> images, Buffer& stagingBuffer) {
+    const Containers::Array<std::size_t> offsets = Implementation::stageImageData(stagingBuffer, images);
+    stagingBuffer.bindInternal(Buffer::TargetHint::PixelUnpack);
+    Implementation::State& state = Context::current().state();
+    for(std::size_t i = 0; i != images.size(); ++i) {
+        const CompressedImageView1D& image = images[i];
+        state.renderer.applyPixelStorageUnpack(image.storage());
+        (texture.*state.texture.compressedSubImage1DImplementation)(GLint(firstLevel + i), {}, image.size(), compressedPixelFormat(image.format()), reinterpret_cast<const GLvoid*>(offsets[i]), Magnum::Implementation::occupiedCompressedImageDataSize(image, image.data().size()));
+    }
+}
 #endif
 
 void AbstractTexture::DataHelper<2>::setImage(AbstractTexture& texture, const GLenum target, const GLint level, const TextureFormat internalFormat, const ImageView2D& image) {
@@ -2198,6 +2377,8 @@ void AbstractTexture::DataHelper<2>::setImage(AbstractTexture& texture, const GL
         + Magnum::Implementation::pixelStorageSkipOffset(image)
         #endif
         , image.storage());
+    Implementation::memoryUsageSetSlice(MemoryUsageCategory::Texture, texture._id, textureImageSlice(target, level),
+        Implementation::textureFormatDataSize(GLenum(internalFormat), {image.size(), 1}));
 }
 
 void AbstractTexture::DataHelper<2>::setCompressedImage(AbstractTexture& texture, const GLenum target, const GLint level, const CompressedImageView2D& image) {
@@ -2207,6 +2388,8 @@ void AbstractTexture::DataHelper<2>::setCompressedImage(AbstractTexture& texture
     Context::current().state().renderer.applyPixelStorageUnpack(image.storage());
     texture.bindInternal();
     glCompressedTexImage2D(target, level, GLenum(compressedPixelFormat(image.format())), image.size().x(), image.size().y(), 0, Magnum::Implementation::occupiedCompressedImageDataSize(image, image.data().size()), image.data());
+    Implementation::memoryUsageSetSlice(MemoryUsageCategory::Texture, texture._id, textureImageSlice(target, level),
+        Implementation::textureFormatDataSize(GLenum(compressedPixelFormat(image.format())), {image.size(), 1}));
 }
 
 #ifndef MAGNUM_TARGET_GLES2
@@ -2215,6 +2398,8 @@ void AbstractTexture::DataHelper<2>::setImage(AbstractTexture& texture, const GL
     Context::current().state().renderer.applyPixelStorageUnpack(image.storage());
     texture.bindInternal();
     glTexImage2D(target, level, GLint(internalFormat), image.size().x(), image.size().y(), 0, GLenum(image.format()), GLenum(image.type()), nullptr);
+    Implementation::memoryUsageSetSlice(MemoryUsageCategory::Texture, texture._id, textureImageSlice(target, level),
+        Implementation::textureFormatDataSize(GLenum(internalFormat), {image.size(), 1}));
 }
 
 void AbstractTexture::DataHelper<2>::setCompressedImage(AbstractTexture& texture, const GLenum target, const GLint level, CompressedBufferImage2D& image) {
@@ -2222,6 +2407,8 @@ void AbstractTexture::DataHelper<2>::setCompressedImage(AbstractTexture& texture
     Context::current().state().renderer.applyPixelStorageUnpack(image.storage());
     texture.bindInternal();
     glCompressedTexImage2D(target, level, GLenum(image.format()), image.size().x(), image.size().y(), 0, Magnum::Implementation::occupiedCompressedImageDataSize(image, image.dataSize()), nullptr);
+    Implementation::memoryUsageSetSlice(MemoryUsageCategory::Texture, texture._id, textureImageSlice(target, level),
+        Implementation::textureFormatDataSize(GLenum(image.format()), {image.size(), 1}));
 }
 #endif
 
@@ -2259,6 +2446,61 @@ void AbstractTexture::DataHelper<2>::setCompressedSubImage(AbstractTexture& text
 }
 #endif
 
+void AbstractTexture::DataHelper<2>::setSubImages(AbstractTexture& texture, const GLint firstLevel, const Containers::ArrayView<const ImageView2D> images) {
+    /* Unbinding the pixel unpack buffer and fetching the state just once for
+       all levels. The pixel storage is applied for each, but the state
+       tracker skips it if it's the same as for the previous level. */
+    #ifndef MAGNUM_TARGET_GLES2
+    Buffer::unbindInternal(Buffer::TargetHint::PixelUnpack);
+    #endif
+    Implementation::State& state = Context::current().state();
+    for(std::size_t i = 0; i != images.size(); ++i) {
+        const ImageView2D& image = images[i];
+        state.renderer.applyPixelStorageUnpack(image.storage());
+        (texture.*state.texture.subImage2DImplementation)(GLint(firstLevel + i), {}, image.size(), pixelFormat(image.format()), pixelType(image.format(), image.formatExtra()), image.data()
+            #ifdef MAGNUM_TARGET_GLES2
+            + Magnum::Implementation::pixelStorageSkipOffset(image)
+            #endif
+            , image.storage());
+    }
+}
+
+void AbstractTexture::DataHelper<2>::setCompressedSubImages(AbstractTexture& texture, const GLint firstLevel, const Containers::ArrayView<const CompressedImageView2D> images) {
+    #ifndef MAGNUM_TARGET_GLES2
+    Buffer::unbindInternal(Buffer::TargetHint::PixelUnpack);
+    #endif
+    Implementation::State& state = Context::current().state();
+    for(std::size_t i = 0; i != images.size(); ++i) {
+        const CompressedImageView2D& image = images[i];
+        state.renderer.applyPixelStorageUnpack(image.storage());
+        (texture.*state.texture.compressedSubImage2DImplementation)(GLint(firstLevel + i), {}, image.size(), compressedPixelFormat(image.format()), image.data(), Magnum::Implementation::occupiedCompressedImageDataSize(image, image.data().size()));
+    }
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+void AbstractTexture::DataHelper<2>::setSubImages(AbstractTexture& texture, const GLint firstLevel, const Containers::ArrayView<const ImageView2D> images, Buffer& stagingBuffer) {
+    const Containers::Array<std::size_t> offsets = Implementation::stageImageData(stagingBuffer, images);
+    stagingBuffer.bindInternal(Buffer::TargetHint::PixelUnpack);
+    Implementation::State& state = Context::current().state();
+    for(std::size_t i = 0; i != images.size(); ++i) {
+        const ImageView2D& image = images[i];
+        state.renderer.applyPixelStorageUnpack(image.storage());
+        (texture.*state.texture.subImage2DImplementation)(GLint(firstLevel + i), {}, image.size(), pixelFormat(image.format()), pixelType(image.format(), image.formatExtra()), reinterpret_cast<const GLvoid*>(offsets[i]), image.storage());
+    }
+}
+
+void AbstractTexture::DataHelper<2>::setCompressedSubImages(AbstractTexture& texture, const GLint firstLevel, const Containers::ArrayView<const CompressedImageView2D> images, Buffer& stagingBuffer) {
+    const Containers::Array<std::size_t> offsets = Implementation::stageImageData(stagingBuffer, images);
+    stagingBuffer.bindInternal(Buffer::TargetHint::PixelUnpack);
+    Implementation::State& state = Context::current().state();
+    for(std::size_t i = 0; i != images.size(); ++i) {
+        const CompressedImageView2D& image = images[i];
+        state.renderer.applyPixelStorageUnpack(image.storage());
+        (texture.*state.texture.compressedSubImage2DImplementation)(GLint(firstLevel + i), {}, image.size(), compressedPixelFormat(image.format()), reinterpret_cast<const GLvoid*>(offsets[i]), Magnum::Implementation::occupiedCompressedImageDataSize(image, image.data().size()));
+    }
+}
+#endif
+
 #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
 void AbstractTexture::DataHelper<3>::setImage(AbstractTexture& texture, const GLint level, const TextureFormat internalFormat, const ImageView3D& image) {
     #ifndef MAGNUM_TARGET_GLES2
@@ -2270,6 +2512,8 @@ void AbstractTexture::DataHelper<3>::setImage(AbstractTexture& texture, const GL
         + Magnum::Implementation::pixelStorageSkipOffset(image)
         #endif
         , image.storage());
+    Implementation::memoryUsageSetSlice(MemoryUsageCategory::Texture, texture._id, level,
+        Implementation::textureFormatDataSize(GLenum(internalFormat), image.size()));
 }
 
 void AbstractTexture::DataHelper<3>::setCompressedImage(AbstractTexture& texture, const GLint level, const CompressedImageView3D& image) {
@@ -2283,6 +2527,8 @@ void AbstractTexture::DataHelper<3>::setCompressedImage(AbstractTexture& texture
     #else
     glCompressedTexImage3DOES(texture._target, level, GLenum(compressedPixelFormat(image.format())), image.size().x(), image.size().y(), image.size().z(), 0, Magnum::Implementation::occupiedCompressedImageDataSize(image, image.data().size()), image.data());
     #endif
+    Implementation::memoryUsageSetSlice(MemoryUsageCategory::Texture, texture._id, level,
+        Implementation::textureFormatDataSize(GLenum(compressedPixelFormat(image.format())), image.size()));
 }
 #endif
 
@@ -2292,6 +2538,8 @@ void AbstractTexture::DataHelper<3>::setImage(AbstractTexture& texture, const GL
     Context::current().state().renderer.applyPixelStorageUnpack(image.storage());
     texture.bindInternal();
     glTexImage3D(texture._target, level, GLint(internalFormat), image.size().x(), image.size().y(), image.size().z(), 0, GLenum(image.format()), GLenum(image.type()), nullptr);
+    Implementation::memoryUsageSetSlice(MemoryUsageCategory::Texture, texture._id, level,
+        Implementation::textureFormatDataSize(GLenum(internalFormat), image.size()));
 }
 
 void AbstractTexture::DataHelper<3>::setCompressedImage(AbstractTexture& texture, const GLint level, CompressedBufferImage3D& image) {
@@ -2299,6 +2547,8 @@ void AbstractTexture::DataHelper<3>::setCompressedImage(AbstractTexture& texture
     Context::current().state().renderer.applyPixelStorageUnpack(image.storage());
     texture.bindInternal();
     glCompressedTexImage3D(texture._target, level, GLenum(image.format()), image.size().x(), image.size().y(), image.size().z(), 0, Magnum::Implementation::occupiedCompressedImageDataSize(image, image.dataSize()), nullptr);
+    Implementation::memoryUsageSetSlice(MemoryUsageCategory::Texture, texture._id, level,
+        Implementation::textureFormatDataSize(GLenum(image.format()), image.size()));
 }
 #endif
 
@@ -2322,6 +2572,37 @@ void AbstractTexture::DataHelper<3>::setCompressedSubImage(AbstractTexture& text
     Context::current().state().renderer.applyPixelStorageUnpack(image.storage());
     (texture.*Context::current().state().texture.compressedSubImage3DImplementation)(level, offset, image.size(), compressedPixelFormat(image.format()), image.data(), Magnum::Implementation::occupiedCompressedImageDataSize(image, image.data().size()));
 }
+
+void AbstractTexture::DataHelper<3>::setSubImages(AbstractTexture& texture, const GLint firstLevel, const Containers::ArrayView<const ImageView3D> images) {
+    /* Unbinding the pixel unpack buffer and fetching the state just once for
+       all levels. The pixel storage is applied for each, but the state
+       tracker skips it if it's the same as for the previous level. */
+    #ifndef MAGNUM_TARGET_GLES2
+    Buffer::unbindInternal(Buffer::TargetHint::PixelUnpack);
+    #endif
+    Implementation::State& state = Context::current().state();
+    for(std::size_t i = 0; i != images.size(); ++i) {
+        const ImageView3D& image = images[i];
+        state.renderer.applyPixelStorageUnpack(image.storage());
+        (texture.*state.texture.subImage3DImplementation)(GLint(firstLevel + i), {}, image.size(), pixelFormat(image.format()), pixelType(image.format(), image.formatExtra()), image.data()
+            #ifdef MAGNUM_TARGET_GLES2
+            + Magnum::Implementation::pixelStorageSkipOffset(image)
+            #endif
+            , image.storage());
+    }
+}
+
+void AbstractTexture::DataHelper<3>::setCompressedSubImages(AbstractTexture& texture, const GLint firstLevel, const Containers::ArrayView<const CompressedImageView3D> images) {
+    #ifndef MAGNUM_TARGET_GLES2
+    Buffer::unbindInternal(Buffer::TargetHint::PixelUnpack);
+    #endif
+    Implementation::State& state = Context::current().state();
+    for(std::size_t i = 0; i != images.size(); ++i) {
+        const CompressedImageView3D& image = images[i];
+        state.renderer.applyPixelStorageUnpack(image.storage());
+        (texture.*state.texture.compressedSubImage3DImplementation)(GLint(firstLevel + i), {}, image.size(), compressedPixelFormat(image.format()), image.data(), Magnum::Implementation::occupiedCompressedImageDataSize(image, image.data().size()));
+    }
+}
 #endif
 
 #ifndef MAGNUM_TARGET_GLES2
@@ -2336,6 +2617,28 @@ void AbstractTexture::DataHelper<3>::setCompressedSubImage(AbstractTexture& text
     Context::current().state().renderer.applyPixelStorageUnpack(image.storage());
     (texture.*Context::current().state().texture.compressedSubImage3DImplementation)(level, offset, image.size(), image.format(), nullptr, Magnum::Implementation::occupiedCompressedImageDataSize(image, image.dataSize()));
 }
+
+void AbstractTexture::DataHelper<3>::setSubImages(AbstractTexture& texture, const GLint firstLevel, const Containers::ArrayView<const ImageView3D> images, Buffer& stagingBuffer) {
+    const Containers::Array<std::size_t> offsets = Implementation::stageImageData(stagingBuffer, images);
+    stagingBuffer.bindInternal(Buffer::TargetHint::PixelUnpack);
+    Implementation::State& state = Context::current().state();
+    for(std::size_t i = 0; i != images.size(); ++i) {
+        const ImageView3D& image = images[i];
+        state.renderer.applyPixelStorageUnpack(image.storage());
+        (texture.*state.texture.subImage3DImplementation)(GLint(firstLevel + i), {}, image.size(), pixelFormat(image.format()), pixelType(image.format(), image.formatExtra()), reinterpret_cast<const GLvoid*>(offsets[i]), image.storage());
+    }
+}
+
+void AbstractTexture::DataHelper<3>::setCompressedSubImages(AbstractTexture& texture, const GLint firstLevel, const Containers::ArrayView<const CompressedImageView3D> images, Buffer& stagingBuffer) {
+    const Containers::Array<std::size_t> offsets = Implementation::stageImageData(stagingBuffer, images);
+    stagingBuffer.bindInternal(Buffer::TargetHint::PixelUnpack);
+    Implementation::State& state = Context::current().state();
+    for(std::size_t i = 0; i != images.size(); ++i) {
+        const CompressedImageView3D& image = images[i];
+        state.renderer.applyPixelStorageUnpack(image.storage());
+        (texture.*state.texture.compressedSubImage3DImplementation)(GLint(firstLevel + i), {}, image.size(), compressedPixelFormat(image.format()), reinterpret_cast<const GLvoid*>(offsets[i]), Magnum::Implementation::occupiedCompressedImageDataSize(image, image.data().size()));
+    }
+}
 #endif
 
 #ifndef MAGNUM_TARGET_GLES
@@ -325,6 +325,54 @@ class MAGNUM_GL_EXPORT AbstractTexture: public AbstractObject {
         }
         #endif
 
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Make a bindless texture handle resident
+         * @m_since_latest
+         *
+         * Makes the texture referenced by @p handle accessible to shaders.
+         * The handle is expected to be retrieved with
+         * @ref Texture::handle() "*Texture::handle()". A resident texture can
+         * be sampled from shaders without being bound to any texture unit,
+         * see @ref GL-Texture-bindless for more information. Making a handle
+         * resident that's already resident is an error.
+         * @see @ref makeHandleNonResident(), @ref isHandleResident(),
+         *      @fn_gl_keyword{MakeTextureHandleResidentARB}
+         * @requires_extension Extension @gl_extension{ARB,bindless_texture}
+         * @requires_gl Bindless textures are not available in OpenGL ES and
+         *      WebGL.
+         */
+        static void makeHandleResident(UnsignedLong handle);
+
+        /**
+         * @brief Make a bindless texture handle non-resident
+         * @m_since_latest
+         *
+         * Makes the texture referenced by @p handle no longer accessible to
+         * shaders. The texture has to be made non-resident again before
+         * modifying its storage from the CPU side, making an non-resident
+         * handle non-resident is an error.
+         * @see @ref makeHandleResident(), @ref isHandleResident(),
+         *      @fn_gl_keyword{MakeTextureHandleNonResidentARB}
+         * @requires_extension Extension @gl_extension{ARB,bindless_texture}
+         * @requires_gl Bindless textures are not available in OpenGL ES and
+         *      WebGL.
+         */
+        static void makeHandleNonResident(UnsignedLong handle);
+
+        /**
+         * @brief Whether a bindless texture handle is resident
+         * @m_since_latest
+         *
+         * @see @ref makeHandleResident(), @ref makeHandleNonResident(),
+         *      @fn_gl_keyword{IsTextureHandleResidentARB}
+         * @requires_extension Extension @gl_extension{ARB,bindless_texture}
+         * @requires_gl Bindless textures are not available in OpenGL ES and
+         *      WebGL.
+         */
+        static bool isHandleResident(UnsignedLong handle);
+        #endif
+
         /** @brief Copying is not allowed */
         AbstractTexture(const AbstractTexture&) = delete;
 
@@ -453,6 +501,17 @@ class MAGNUM_GL_EXPORT AbstractTexture: public AbstractObject {
         /* Unlike bind() this also sets the texture binding unit as active */
         void MAGNUM_GL_LOCAL bindInternal();
 
+        #ifndef MAGNUM_TARGET_GLES
+        UnsignedLong handleInternal();
+
+        static Int virtualPageSizeCountInternal(GLenum target, TextureFormat format);
+        static Vector3i virtualPageSizeInternal(GLenum target, TextureFormat format, Int index);
+        void setSparseInternal(bool sparse, Int virtualPageSizeIndex);
+        Int sparseLevelCountInternal();
+        void pageCommitmentInternal(GLint level, const Range2Di& range, bool commit);
+        void pageCommitmentInternal(GLint level, const Range3Di& range, bool commit);
+        #endif
+
         #ifndef MAGNUM_TARGET_GLES2
         void setBaseLevel(Int level);
         #endif
@@ -731,6 +790,11 @@ template<> struct MAGNUM_GL_EXPORT AbstractTexture::DataHelper<1> {
     static void setCompressedSubImage(AbstractTexture& texture, GLint level, const Math::Vector<1, GLint>& offset, const CompressedImageView1D& image);
     static void setCompressedSubImage(AbstractTexture& texture, GLint level, const Math::Vector<1, GLint>& offset, CompressedBufferImage1D& image);
 
+    static void setSubImages(AbstractTexture& texture, GLint firstLevel, Containers::ArrayView<const ImageView1D> images);
+    static void setSubImages(AbstractTexture& texture, GLint firstLevel, Containers::ArrayView<const ImageView1D> images, Buffer& stagingBuffer);
+    static void setCompressedSubImages(AbstractTexture& texture, GLint firstLevel, Containers::ArrayView<const CompressedImageView1D> images);
+    static void setCompressedSubImages(AbstractTexture& texture, GLint firstLevel, Containers::ArrayView<const CompressedImageView1D> images, Buffer& stagingBuffer);
+
     static void invalidateSubImage(AbstractTexture& texture, GLint level, const Math::Vector<1, GLint>& offset, const Math::Vector<1, GLint>& size);
 };
 #endif
@@ -776,6 +840,13 @@ template<> struct MAGNUM_GL_EXPORT AbstractTexture::DataHelper<2> {
     static void setCompressedSubImage(AbstractTexture& texture, GLint level, const Vector2i& offset, CompressedBufferImage2D& image);
     #endif
 
+    static void setSubImages(AbstractTexture& texture, GLint firstLevel, Containers::ArrayView<const ImageView2D> images);
+    static void setCompressedSubImages(AbstractTexture& texture, GLint firstLevel, Containers::ArrayView<const CompressedImageView2D> images);
+    #ifndef MAGNUM_TARGET_GLES2
+    static void setSubImages(AbstractTexture& texture, GLint firstLevel, Containers::ArrayView<const ImageView2D> images, Buffer& stagingBuffer);
+    static void setCompressedSubImages(AbstractTexture& texture, GLint firstLevel, Containers::ArrayView<const CompressedImageView2D> images, Buffer& stagingBuffer);
+    #endif
+
     static void invalidateSubImage(AbstractTexture& texture, GLint level, const Vector2i& offset, const Vector2i& size);
 };
 template<> struct MAGNUM_GL_EXPORT AbstractTexture::DataHelper<3> {
@@ -808,6 +879,13 @@ template<> struct MAGNUM_GL_EXPORT AbstractTexture::DataHelper<3> {
     static void setSubImage(AbstractTexture& texture, GLint level, const Vector3i& offset, BufferImage3D& image);
     static void setCompressedSubImage(AbstractTexture& texture, GLint level, const Vector3i& offset, CompressedBufferImage3D& image);
     #endif
+
+    static void setSubImages(AbstractTexture& texture, GLint firstLevel, Containers::ArrayView<const ImageView3D> images);
+    static void setCompressedSubImages(AbstractTexture& texture, GLint firstLevel, Containers::ArrayView<const CompressedImageView3D> images);
+    #ifndef MAGNUM_TARGET_GLES2
+    static void setSubImages(AbstractTexture& texture, GLint firstLevel, Containers::ArrayView<const ImageView3D> images, Buffer& stagingBuffer);
+    static void setCompressedSubImages(AbstractTexture& texture, GLint firstLevel, Containers::ArrayView<const CompressedImageView3D> images, Buffer& stagingBuffer);
+    #endif
     #endif
 
     static void invalidateSubImage(AbstractTexture& texture, GLint level, const Vector3i& offset, const Vector3i& size);
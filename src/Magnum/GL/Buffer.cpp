@@ -33,6 +33,7 @@
 #endif
 #include <Corrade/Utility/Debug.h>
 
+#include "Magnum/ProfileScope.h"
 #include "Magnum/GL/Context.h"
 #include "Magnum/GL/Extensions.h"
 #include "Magnum/GL/Implementation/State.h"
@@ -40,6 +41,7 @@
 #ifndef MAGNUM_TARGET_WEBGL
 #include "Magnum/GL/Implementation/DebugState.h"
 #endif
+#include "Magnum/GL/Implementation/MemoryUsageState.h"
 #include "Magnum/GL/Implementation/MeshState.h"
 
 #if defined(CORRADE_TARGET_APPLE) && !defined(MAGNUM_TARGET_GLES)
@@ -144,7 +146,7 @@ Int Buffer::maxUniformBindings() {
 }
 
 void Buffer::unbind(const Target target, const UnsignedInt index) {
-    glBindBufferBase(GLenum(target), index, 0);
+    bindIndexedInternal(target, index, 0, 0, -1);
 }
 
 void Buffer::unbind(const Target target, const UnsignedInt firstIndex, const std::size_t count) {
@@ -161,6 +163,34 @@ void Buffer::bind(const Target target, const UnsignedInt firstIndex, std::initia
     Context::current().state().buffer.bindBasesImplementation(target, firstIndex, {buffers.begin(), buffers.size()});
 }
 
+void Buffer::bindIndexedInternal(const Target target, const UnsignedInt index, const GLuint id, const GLintptr offset, const GLsizeiptr size) {
+    Implementation::BufferState& state = Context::current().state().buffer;
+
+    /* Skip the call if the same range is already bound to given uniform
+       binding point */
+    if(target == Target::Uniform && index < Implementation::BufferState::UniformBindingCount) {
+        Implementation::BufferState::IndexedBinding& binding = state.uniformBindings[index];
+        if(binding.id == id && binding.offset == offset && binding.size == size)
+            return;
+        binding = {id, offset, size};
+    }
+
+    if(size == -1) glBindBufferBase(GLenum(target), index, id);
+    else glBindBufferRange(GLenum(target), index, id, offset, size);
+
+    /* Binding to an indexed binding point binds to the generic binding point
+       as well */
+    state.bindings[Implementation::BufferState::indexForTarget(TargetHint(GLenum(target)))] = id;
+}
+
+void Buffer::invalidateIndexedBindingsInternal(const Target target, const UnsignedInt firstIndex, const std::size_t count) {
+    if(target != Target::Uniform) return;
+
+    Implementation::BufferState& state = Context::current().state().buffer;
+    for(std::size_t i = firstIndex; i < firstIndex + count && i < Implementation::BufferState::UniformBindingCount; ++i)
+        state.uniformBindings[i].id = Implementation::State::DisengagedBinding;
+}
+
 void Buffer::copy(Buffer& read, Buffer& write, const GLintptr readOffset, const GLintptr writeOffset, const GLsizeiptr size) {
     Context::current().state().buffer.copyImplementation(read, write, readOffset, writeOffset, size);
 }
@@ -197,7 +227,12 @@ Buffer::~Buffer() {
     /* Remove all current bindings from the state */
     for(std::size_t i = 1; i != Implementation::BufferState::TargetCount; ++i)
         if(bindings[i] == _id) bindings[i] = 0;
+    #ifndef MAGNUM_TARGET_GLES2
+    for(Implementation::BufferState::IndexedBinding& binding: Context::current().state().buffer.uniformBindings)
+        if(binding.id == _id) binding.id = 0;
+    #endif
 
+    Implementation::memoryUsageRemove(MemoryUsageCategory::Buffer, _id);
     glDeleteBuffers(1, &_id);
 }
 
@@ -247,6 +282,7 @@ Buffer& Buffer::setLabel(const Containers::StringView label) {
     #else
     Context::current().state().debug.labelImplementation(GL_BUFFER_KHR, _id, label);
     #endif
+    Implementation::memoryUsageLabel(MemoryUsageCategory::Buffer, _id, label);
     return *this;
 }
 #endif
@@ -299,19 +335,26 @@ auto Buffer::bindSomewhereInternal(const TargetHint hint) -> TargetHint {
 
 #ifndef MAGNUM_TARGET_GLES2
 Buffer& Buffer::bind(const Target target, const UnsignedInt index, const GLintptr offset, const GLsizeiptr size) {
-    glBindBufferRange(GLenum(target), index, _id, offset, size);
+    bindIndexedInternal(target, index, _id, offset, size);
     return *this;
 }
 
 Buffer& Buffer::bind(const Target target, const UnsignedInt index) {
-    glBindBufferBase(GLenum(target), index, _id);
+    bindIndexedInternal(target, index, _id, 0, -1);
     return *this;
 }
 #endif
 
 #ifndef MAGNUM_TARGET_GLES
 Buffer& Buffer::setStorage(const Containers::ArrayView<const void> data, const StorageFlags flags) {
-    (this->*Context::current().state().buffer.storageImplementation)(data, flags);
+    Implementation::BufferState& state = Context::current().state().buffer;
+    (this->*state.storageImplementation)(data, flags);
+    /* Only count actual uploads, not allocations */
+    if(data.data()) {
+        ++state.uploadCount;
+        state.uploadSize += data.size();
+    }
+    Implementation::memoryUsageSet(MemoryUsageCategory::Buffer, _id, data.size());
     return *this;
 }
 
@@ -337,12 +380,24 @@ Containers::Array<char> Buffer::data() {
 #endif
 
 Buffer& Buffer::setData(const Containers::ArrayView<const void> data, const BufferUsage usage) {
-    (this->*Context::current().state().buffer.dataImplementation)(data.size(), data, usage);
+    MAGNUM_PROFILE_SCOPE("GL::Buffer::setData()");
+    Implementation::BufferState& state = Context::current().state().buffer;
+    (this->*state.dataImplementation)(data.size(), data, usage);
+    /* Only count actual uploads, not allocations */
+    if(data.data()) {
+        ++state.uploadCount;
+        state.uploadSize += data.size();
+    }
+    Implementation::memoryUsageSet(MemoryUsageCategory::Buffer, _id, data.size());
     return *this;
 }
 
 Buffer& Buffer::setSubData(const GLintptr offset, const Containers::ArrayView<const void> data) {
-    (this->*Context::current().state().buffer.subDataImplementation)(offset, data.size(), data);
+    MAGNUM_PROFILE_SCOPE("GL::Buffer::setSubData()");
+    Implementation::BufferState& state = Context::current().state().buffer;
+    (this->*state.subDataImplementation)(offset, data.size(), data);
+    ++state.uploadCount;
+    state.uploadSize += data.size();
     return *this;
 }
 
@@ -403,6 +458,7 @@ void Buffer::bindImplementationMulti(const Target target, const GLuint firstInde
     }
 
     glBindBuffersBase(GLenum(target), firstIndex, buffers.size(), ids);
+    invalidateIndexedBindingsInternal(target, firstIndex, buffers.size());
 }
 #endif
 
@@ -435,6 +491,7 @@ void Buffer::bindImplementationMulti(const Target target, const GLuint firstInde
     }
 
     glBindBuffersRange(GLenum(target), firstIndex, buffers.size(), ids, offsetsSizes, offsetsSizes + buffers.size());
+    invalidateIndexedBindingsInternal(target, firstIndex, buffers.size());
 }
 #endif
 
@@ -654,6 +711,9 @@ Debug& operator<<(Debug& debug, const Buffer::TargetHint value) {
         #endif
         #endif
         _c(ElementArray)
+        #ifndef MAGNUM_TARGET_GLES
+        _c(Parameter)
+        #endif
         #ifndef MAGNUM_TARGET_GLES2
         _c(PixelPack)
         _c(PixelUnpack)
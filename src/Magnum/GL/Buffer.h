@@ -192,6 +192,10 @@ memory operations performed by OpenGL on unmapping. Example:
 
 @snippet MagnumGL.cpp Buffer-flush
 
+For data that get updated every frame, the @ref StreamingBuffer class
+provides a persistently mapped ring buffer with the necessary
+synchronization.
+
 @section GL-Buffer-webgl-restrictions WebGL restrictions
 
 Buffers in @ref MAGNUM_TARGET_WEBGL "WebGL" need to be bound only to one unique
@@ -303,6 +307,17 @@ class MAGNUM_GL_EXPORT Buffer: public AbstractObject {
             /** Used for storing vertex indices. */
             ElementArray = GL_ELEMENT_ARRAY_BUFFER,
 
+            #ifndef MAGNUM_TARGET_GLES
+            /**
+             * Used for supplying draw count for indirect drawing.
+             * @m_since_latest
+             * @requires_gl46 Extension @gl_extension{ARB,indirect_parameters}
+             * @requires_gl Indirect draw count is not available in OpenGL
+             *      ES or WebGL.
+             */
+            Parameter = GL_PARAMETER_BUFFER,
+            #endif
+
             #ifndef MAGNUM_TARGET_GLES2
             /**
              * Target for pixel pack operations.
@@ -999,6 +1014,12 @@ class MAGNUM_GL_EXPORT Buffer: public AbstractObject {
          * @p offset parameter must respect alignment, which is 4 bytes for
          * @ref Target::AtomicCounter and implementation-defined for other
          * targets. The buffer must have allocated data store.
+         *
+         * For @ref Target::Uniform, the range bound to the first 24 binding
+         * points is tracked and the call is skipped if the same range of the
+         * same buffer is already bound, which makes it cheap to rebind the
+         * same uniform buffers before every draw. This is especially
+         * important on WebGL, where each GL call is expensive.
          * @note This function is meant to be used only internally from
          *      @ref AbstractShaderProgram subclasses. See its documentation
          *      for more information.
@@ -1016,7 +1037,7 @@ class MAGNUM_GL_EXPORT Buffer: public AbstractObject {
          * @requires_webgl20 No form of indexed buffer binding is available in
          *      WebGL 1.0, see particular @ref Target values for version
          *      requirements.
-         * @todo State tracking for indexed binding
+         * @todo State tracking for indexed binding of other targets
          */
         Buffer& bind(Target target, UnsignedInt index, GLintptr offset, GLsizeiptr size);
 
@@ -1024,7 +1045,10 @@ class MAGNUM_GL_EXPORT Buffer: public AbstractObject {
          * @brief Bind buffer to given binding index
          *
          * The @p index parameter must respect limits for given @p target. The
-         * buffer must have allocated data store.
+         * buffer must have allocated data store. For @ref Target::Uniform the
+         * call is skipped if the buffer is already bound to given binding
+         * point, see @ref bind(Target, UnsignedInt, GLintptr, GLsizeiptr) for
+         * details.
          * @note This function is meant to be used only internally from
          *      @ref AbstractShaderProgram subclasses. See its documentation
          *      for more information.
@@ -1322,6 +1346,9 @@ class MAGNUM_GL_EXPORT Buffer: public AbstractObject {
         TargetHint MAGNUM_GL_LOCAL bindSomewhereInternal(TargetHint hint);
 
         #ifndef MAGNUM_TARGET_GLES2
+        static void MAGNUM_GL_LOCAL bindIndexedInternal(Target target, UnsignedInt index, GLuint id, GLintptr offset, GLsizeiptr size);
+        static void MAGNUM_GL_LOCAL invalidateIndexedBindingsInternal(Target target, UnsignedInt firstIndex, std::size_t count);
+
         static void MAGNUM_GL_LOCAL bindImplementationFallback(Target target, GLuint firstIndex, Containers::ArrayView<Buffer* const> buffers);
         #ifndef MAGNUM_TARGET_GLES
         static void MAGNUM_GL_LOCAL bindImplementationMulti(Target target, GLuint firstIndex, Containers::ArrayView<Buffer* const> buffers);
@@ -0,0 +1,330 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "BufferHeap.h"
+
+#include <algorithm>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/GL/Mesh.h"
+#include "Magnum/GL/MeshView.h"
+#include "Magnum/Math/Functions.h"
+#ifndef MAGNUM_TARGET_GLES
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#endif
+
+namespace Magnum { namespace GL {
+
+struct BufferHeap::Range {
+    std::size_t offset;
+    std::size_t size;
+};
+
+struct BufferHeap::Block {
+    Buffer buffer;
+    /* Unordered, adjacent free ranges are always merged together */
+    Containers::Array<Range> free;
+};
+
+struct BufferHeap::Allocation {
+    std::size_t offset;
+    std::size_t size;
+    std::size_t alignment;
+    UnsignedInt block;
+    /* Null if no view is attached */
+    MeshView* view;
+    /* Vertex stride if the view is attached to vertex data, zero if it's
+       attached to index data */
+    UnsignedInt stride;
+    /* False for freed entries that can be reused */
+    bool used;
+};
+
+namespace {
+
+std::size_t alignUp(const std::size_t offset, const std::size_t alignment) {
+    return (offset + alignment - 1)/alignment*alignment;
+}
+
+}
+
+BufferHeap::BufferHeap(const Buffer::TargetHint targetHint, const std::size_t blockSize): _targetHint{targetHint}, _blockSize{blockSize} {
+    CORRADE_ASSERT(blockSize,
+        "GL::BufferHeap: expected a non-zero block size", );
+}
+
+BufferHeap::BufferHeap(BufferHeap&&) noexcept = default;
+
+BufferHeap::~BufferHeap() = default;
+
+BufferHeap& BufferHeap::operator=(BufferHeap&&) noexcept = default;
+
+UnsignedInt BufferHeap::blockCount() const { return _blocks.size(); }
+
+Buffer& BufferHeap::blockBuffer(const UnsignedInt block) {
+    CORRADE_ASSERT(block < _blocks.size(),
+        "GL::BufferHeap::blockBuffer(): index" << block << "out of range for" << _blocks.size() << "blocks", _blocks[0].buffer);
+    return _blocks[block].buffer;
+}
+
+bool BufferHeap::allocateInBlock(Block& block, const std::size_t size, const std::size_t alignment, std::size_t& offset) {
+    /* Pick the free range that gives the lowest offset, to keep the
+       allocations packed towards the block beginning */
+    std::size_t found = ~std::size_t{};
+    for(std::size_t i = 0; i != block.free.size(); ++i) {
+        const Range& range = block.free[i];
+        const std::size_t aligned = alignUp(range.offset, alignment);
+        if(aligned + size > range.offset + range.size) continue;
+        if(found == ~std::size_t{} || range.offset < block.free[found].offset)
+            found = i;
+    }
+    if(found == ~std::size_t{}) return false;
+
+    /* Split the range into the alignment padding before and the remainder
+       after the allocation, removing the parts that are empty */
+    Range& range = block.free[found];
+    offset = alignUp(range.offset, alignment);
+    const Range before{range.offset, offset - range.offset};
+    const Range after{offset + size, range.offset + range.size - offset - size};
+    if(before.size && after.size) {
+        range = before;
+        arrayAppend(block.free, after);
+    } else if(before.size) {
+        range = before;
+    } else if(after.size) {
+        range = after;
+    } else {
+        range = block.free.back();
+        arrayRemoveSuffix(block.free, 1);
+    }
+
+    return true;
+}
+
+UnsignedInt BufferHeap::allocate(const std::size_t size, const std::size_t alignment) {
+    CORRADE_ASSERT(size && size <= _blockSize,
+        "GL::BufferHeap::allocate(): expected a non-zero size not larger than" << _blockSize << "but got" << size, ~UnsignedInt{});
+    CORRADE_ASSERT(alignment,
+        "GL::BufferHeap::allocate(): expected a non-zero alignment", ~UnsignedInt{});
+
+    /* Find the first block that has enough space */
+    UnsignedInt block = 0;
+    std::size_t offset{};
+    while(block != _blocks.size() && !allocateInBlock(_blocks[block], size, alignment, offset))
+        ++block;
+
+    /* If there's none, create a new one. The allocation is at offset zero,
+       thus always aligned. */
+    if(block == _blocks.size()) {
+        Buffer buffer{_targetHint};
+        #ifndef MAGNUM_TARGET_GLES
+        if(Context::current().isExtensionSupported<Extensions::ARB::buffer_storage>())
+            buffer.setStorage(_blockSize, Buffer::StorageFlag::DynamicStorage);
+        else
+        #endif
+        {
+            buffer.setData({nullptr, _blockSize}, BufferUsage::StaticDraw);
+        }
+
+        Block created{std::move(buffer), {}};
+        if(size != _blockSize)
+            arrayAppend(created.free, Range{size, _blockSize - size});
+        arrayAppend(_blocks, std::move(created));
+        offset = 0;
+    }
+
+    const Allocation allocation{offset, size, alignment, block, nullptr, 0, true};
+
+    /* Reuse a freed entry, if there's any */
+    UnsignedInt id = 0;
+    while(id != _allocations.size() && _allocations[id].used) ++id;
+    if(id == _allocations.size())
+        arrayAppend(_allocations, allocation);
+    else
+        _allocations[id] = allocation;
+    _usedSize += size;
+    ++_allocationCount;
+    return id;
+}
+
+UnsignedInt BufferHeap::allocate(const Containers::ArrayView<const void> data, const std::size_t alignment) {
+    const UnsignedInt id = allocate(data.size(), alignment);
+    #ifdef CORRADE_GRACEFUL_ASSERT
+    if(id == ~UnsignedInt{}) return id;
+    #endif
+    const Allocation& allocation = _allocations[id];
+    _blocks[allocation.block].buffer.setSubData(allocation.offset, data);
+    return id;
+}
+
+void BufferHeap::free(const UnsignedInt id) {
+    CORRADE_ASSERT(id < _allocations.size() && _allocations[id].used,
+        "GL::BufferHeap::free(): invalid ID" << id, );
+
+    Allocation& allocation = _allocations[id];
+    Containers::Array<Range>& ranges = _blocks[allocation.block].free;
+
+    /* Merge with the free ranges directly before and after, if any */
+    const std::size_t end = allocation.offset + allocation.size;
+    std::size_t before = ~std::size_t{}, after = ~std::size_t{};
+    for(std::size_t i = 0; i != ranges.size(); ++i) {
+        if(ranges[i].offset + ranges[i].size == allocation.offset) before = i;
+        else if(ranges[i].offset == end) after = i;
+    }
+    if(before != ~std::size_t{} && after != ~std::size_t{}) {
+        /* Extend the range before and remove the range after by moving the
+           last range over it */
+        ranges[before].size += allocation.size + ranges[after].size;
+        ranges[after] = ranges.back();
+        arrayRemoveSuffix(ranges, 1);
+    } else if(before != ~std::size_t{}) {
+        ranges[before].size += allocation.size;
+    } else if(after != ~std::size_t{}) {
+        ranges[after].offset = allocation.offset;
+        ranges[after].size += allocation.size;
+    } else {
+        arrayAppend(ranges, Range{allocation.offset, allocation.size});
+    }
+
+    _usedSize -= allocation.size;
+    --_allocationCount;
+    allocation.used = false;
+    allocation.view = nullptr;
+}
+
+UnsignedInt BufferHeap::block(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _allocations.size() && _allocations[id].used,
+        "GL::BufferHeap::block(): invalid ID" << id, {});
+    return _allocations[id].block;
+}
+
+GLintptr BufferHeap::offset(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _allocations.size() && _allocations[id].used,
+        "GL::BufferHeap::offset(): invalid ID" << id, {});
+    return GLintptr(_allocations[id].offset);
+}
+
+std::size_t BufferHeap::size(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _allocations.size() && _allocations[id].used,
+        "GL::BufferHeap::size(): invalid ID" << id, {});
+    return _allocations[id].size;
+}
+
+void BufferHeap::updateView(const Allocation& allocation) {
+    if(!allocation.view) return;
+    if(allocation.stride)
+        allocation.view->setBaseVertex(Int(allocation.offset/allocation.stride));
+    else
+        allocation.view->setIndexRange(Int(allocation.offset/allocation.view->mesh().indexTypeSize()));
+}
+
+void BufferHeap::attachVertices(const UnsignedInt id, MeshView& view, const UnsignedInt stride) {
+    CORRADE_ASSERT(id < _allocations.size() && _allocations[id].used,
+        "GL::BufferHeap::attachVertices(): invalid ID" << id, );
+    CORRADE_ASSERT(stride && _allocations[id].alignment % stride == 0,
+        "GL::BufferHeap::attachVertices(): expected allocation alignment to be a multiple of the stride but got" << _allocations[id].alignment << "and" << stride, );
+
+    Allocation& allocation = _allocations[id];
+    allocation.view = &view;
+    allocation.stride = stride;
+    updateView(allocation);
+}
+
+void BufferHeap::attachIndices(const UnsignedInt id, MeshView& view) {
+    CORRADE_ASSERT(id < _allocations.size() && _allocations[id].used,
+        "GL::BufferHeap::attachIndices(): invalid ID" << id, );
+    CORRADE_ASSERT(view.mesh().isIndexed(),
+        "GL::BufferHeap::attachIndices(): the mesh is not indexed", );
+    CORRADE_ASSERT(_allocations[id].alignment % view.mesh().indexTypeSize() == 0,
+        "GL::BufferHeap::attachIndices(): expected allocation alignment to be a multiple of the index type size but got" << _allocations[id].alignment << "and" << view.mesh().indexTypeSize(), );
+
+    Allocation& allocation = _allocations[id];
+    allocation.view = &view;
+    allocation.stride = 0;
+    updateView(allocation);
+}
+
+void BufferHeap::detach(const UnsignedInt id) {
+    CORRADE_ASSERT(id < _allocations.size() && _allocations[id].used,
+        "GL::BufferHeap::detach(): invalid ID" << id, );
+    _allocations[id].view = nullptr;
+}
+
+std::size_t BufferHeap::compact(const std::size_t byteLimit, void(*const relocated)(UnsignedInt, void*), void* const userData) {
+    std::size_t moved = 0;
+    bool limitReached = false;
+    Containers::Array<UnsignedInt> ids;
+    for(UnsignedInt blockId = 0; blockId != _blocks.size(); ++blockId) {
+        Block& block = _blocks[blockId];
+
+        /* Gather allocations in this block, sorted by offset */
+        arrayResize(ids, 0);
+        for(UnsignedInt id = 0; id != _allocations.size(); ++id)
+            if(_allocations[id].used && _allocations[id].block == blockId)
+                arrayAppend(ids, id);
+        std::sort(ids.begin(), ids.end(), [&](const UnsignedInt a, const UnsignedInt b) {
+            return _allocations[a].offset < _allocations[b].offset;
+        });
+
+        /* Move each allocation right after the previous one, and rebuild the
+           free list from the gaps that remain */
+        arrayResize(block.free, 0);
+        std::size_t end = 0;
+        for(const UnsignedInt id: ids) {
+            Allocation& allocation = _allocations[id];
+            const std::size_t offset = alignUp(end, allocation.alignment);
+            if(!limitReached && offset < allocation.offset) {
+                if(moved && moved + allocation.size > byteLimit) {
+                    limitReached = true;
+                } else {
+                    /* Source and destination ranges of a copy can't overlap.
+                       If they would, copy in pieces no larger than the
+                       distance, front to back, each piece overwriting only
+                       data that were copied already. */
+                    const std::size_t step = Math::min(allocation.size, allocation.offset - offset);
+                    for(std::size_t i = 0; i < allocation.size; i += step)
+                        Buffer::copy(block.buffer, block.buffer, allocation.offset + i, offset + i, Math::min(step, allocation.size - i));
+
+                    allocation.offset = offset;
+                    moved += allocation.size;
+                    updateView(allocation);
+                    if(relocated) relocated(id, userData);
+                }
+            }
+
+            if(allocation.offset != end)
+                arrayAppend(block.free, Range{end, allocation.offset - end});
+            end = allocation.offset + allocation.size;
+        }
+        if(end != _blockSize)
+            arrayAppend(block.free, Range{end, _blockSize - end});
+    }
+
+    return moved;
+}
+
+}}
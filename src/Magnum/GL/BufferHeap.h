@@ -0,0 +1,294 @@
+#ifndef Magnum_GL_BufferHeap_h
+#define Magnum_GL_BufferHeap_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MAGNUM_TARGET_GLES2
+/** @file
+ * @brief Class @ref Magnum::GL::BufferHeap
+ * @m_since_latest
+ */
+#endif
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/GL/Buffer.h"
+
+#ifndef MAGNUM_TARGET_GLES2
+namespace Magnum { namespace GL {
+
+/**
+@brief Sub-allocator of vertex and index data in a few large buffers
+@m_since_latest
+
+Hands out ranges of a small set of equally sized @ref Buffer instances, called
+blocks, instead of creating a buffer for each mesh. Meant for streamed meshes
+that get added and removed at runtime, where creating and deleting buffers
+for each of them is expensive and where having the data in a handful of
+buffers allows drawing many of them with a single multi-draw call.
+
+@section GL-BufferHeap-usage Usage
+
+Each @ref allocate() call returns an ID of a range that's placed in the first
+block that has enough free space, creating a new block if none has. The
+@ref block() and @ref offset() of the range are then used to set up a
+@ref MeshView of a @ref Mesh that has the @ref blockBuffer() attached at
+offset zero. The view can be attached to the allocation with
+@ref attachVertices() or @ref attachIndices() to have its base vertex or
+index range set from the offset:
+
+@snippet MagnumGL.cpp BufferHeap-usage
+
+Because vertex and index buffers can't share the same buffer object in WebGL,
+it's recommended to use separate heaps for vertex and index data, each
+created with a corresponding @ref Buffer::TargetHint.
+
+@section GL-BufferHeap-compaction Compaction
+
+Freed ranges are merged with neighboring free space, but with allocations
+of varying sizes coming and going the free space eventually gets fragmented.
+The @ref compact() function moves allocations in each block towards the
+block beginning with @ref Buffer::copy(), updates all attached views and
+optionally calls a function for each moved allocation. The copy is ordered
+with all previously submitted GL commands on the GPU side, so it's safe to
+call it even if the data are still used by draws from the current frame. It
+can be given a limit on the amount of bytes to move, which allows
+spreading the compaction over multiple frames. Allocations never move to a
+different block, so a @ref Mesh set up for a block stays valid.
+
+Blocks are never deleted, even if all their allocations are freed, and are
+reused by subsequent allocations. On desktop GL, if
+@gl_extension{ARB,buffer_storage} is supported, the block storage is
+immutable, allocated using @ref Buffer::setStorage() with
+@ref Buffer::StorageFlag::DynamicStorage, otherwise it's allocated with
+@ref Buffer::setData() with @ref BufferUsage::StaticDraw.
+@requires_gl31 Extension @gl_extension{ARB,copy_buffer}
+@requires_gles30 Buffer copying is not available in OpenGL ES 2.0.
+@requires_webgl20 Buffer copying is not available in WebGL 1.0.
+*/
+class MAGNUM_GL_EXPORT BufferHeap {
+    public:
+        /**
+         * @brief Constructor
+         * @param targetHint    Target hint for all blocks
+         * @param blockSize     Size of a single block in bytes. Expected to be
+         *      non-zero.
+         *
+         * Doesn't create any OpenGL object, blocks are created on-demand in
+         * @ref allocate(). Thus it can be safely used even without any OpenGL
+         * context being active.
+         */
+        explicit BufferHeap(Buffer::TargetHint targetHint, std::size_t blockSize);
+
+        /** @brief Copying is not allowed */
+        BufferHeap(const BufferHeap&) = delete;
+
+        /** @brief Move constructor */
+        BufferHeap(BufferHeap&&) noexcept;
+
+        ~BufferHeap();
+
+        /** @brief Copying is not allowed */
+        BufferHeap& operator=(const BufferHeap&) = delete;
+
+        /** @brief Move assignment */
+        BufferHeap& operator=(BufferHeap&&) noexcept;
+
+        /** @brief Target hint for all blocks */
+        Buffer::TargetHint targetHint() const { return _targetHint; }
+
+        /** @brief Size of a single block in bytes */
+        std::size_t blockSize() const { return _blockSize; }
+
+        /** @brief Count of blocks */
+        UnsignedInt blockCount() const;
+
+        /**
+         * @brief Block buffer
+         *
+         * Expects that @p block is less than @ref blockCount(). The buffer
+         * is owned by the heap, don't change its storage.
+         */
+        Buffer& blockBuffer(UnsignedInt block);
+
+        /** @brief Count of live allocations */
+        std::size_t allocationCount() const { return _allocationCount; }
+
+        /**
+         * @brief Total size of live allocations in bytes
+         *
+         * Doesn't include the padding needed to satisfy alignment of the
+         * allocations.
+         */
+        std::size_t usedSize() const { return _usedSize; }
+
+        /**
+         * @brief Allocate a range
+         * @param size          Size in bytes. Expected to be non-zero and not
+         *      larger than @ref blockSize().
+         * @param alignment     Alignment in bytes. Expected to be non-zero,
+         *      doesn't need to be a power of two.
+         * @return ID of the allocation, used in other functions
+         *
+         * Places the allocation at the lowest offset that fits in the first
+         * block that has enough free space. If there's no such block, a new
+         * one is created. Contents of the range are undefined. IDs of freed
+         * allocations are reused.
+         */
+        UnsignedInt allocate(std::size_t size, std::size_t alignment = 4);
+
+        /**
+         * @brief Allocate a range and fill it with data
+         *
+         * Equivalent to calling @ref allocate(std::size_t, std::size_t) with
+         * size of @p data and then @ref Buffer::setSubData() on the
+         * @ref blockBuffer() at @ref offset().
+         */
+        UnsignedInt allocate(Containers::ArrayView<const void> data, std::size_t alignment = 4);
+
+        /**
+         * @brief Free an allocation
+         *
+         * Detaches a view attached with @ref attachVertices() or
+         * @ref attachIndices(), if any, and merges the range with
+         * neighboring free space. Expects that @p id is a valid allocation
+         * ID. The ID may get reused by a subsequent @ref allocate().
+         */
+        void free(UnsignedInt id);
+
+        /**
+         * @brief Block of an allocation
+         *
+         * Expects that @p id is a valid allocation ID.
+         */
+        UnsignedInt block(UnsignedInt id) const;
+
+        /**
+         * @brief Offset of an allocation in its block
+         *
+         * Changes only in @ref compact(). Expects that @p id is a valid
+         * allocation ID.
+         */
+        GLintptr offset(UnsignedInt id) const;
+
+        /**
+         * @brief Size of an allocation
+         *
+         * Expects that @p id is a valid allocation ID.
+         */
+        std::size_t size(UnsignedInt id) const;
+
+        /**
+         * @brief Attach a view to vertex data
+         * @param id            Allocation ID
+         * @param view          View of a mesh that has the allocation's
+         *      @ref blockBuffer() attached at offset zero
+         * @param stride        Vertex stride in bytes
+         *
+         * Sets @ref MeshView::setBaseVertex() to @ref offset() divided by
+         * @p stride and updates it each time the allocation is moved in
+         * @ref compact(). Replaces a view attached previously. The view is
+         * expected to stay alive and not be moved until the allocation is
+         * freed. Expects that @p id is a valid allocation ID, @p stride is
+         * non-zero and alignment of the allocation is a multiple of it.
+         */
+        void attachVertices(UnsignedInt id, MeshView& view, UnsignedInt stride);
+
+        /**
+         * @brief Attach a view to index data
+         * @param id            Allocation ID
+         * @param view          View of an indexed mesh that has the
+         *      allocation's @ref blockBuffer() attached as an index buffer at
+         *      offset zero
+         *
+         * Calls @ref MeshView::setIndexRange(Int) with @ref offset() divided
+         * by @ref Mesh::indexTypeSize() and updates it each time the
+         * allocation is moved in @ref compact(). Replaces a view attached
+         * previously. The view is expected to stay alive and not be moved
+         * until the allocation is freed. Expects that @p id is a valid
+         * allocation ID and alignment of the allocation is a multiple of the
+         * index type size.
+         */
+        void attachIndices(UnsignedInt id, MeshView& view);
+
+        /**
+         * @brief Detach a view
+         *
+         * Expects that @p id is a valid allocation ID. Does nothing if no
+         * view is attached.
+         */
+        void detach(UnsignedInt id);
+
+        /**
+         * @brief Compact the blocks
+         * @param byteLimit     Maximal amount of bytes to move
+         * @param relocated     Function to call for each moved allocation or
+         *      @cpp nullptr @ce
+         * @param userData      User data passed to @p relocated
+         * @return Amount of moved bytes
+         *
+         * Moves allocations in each block towards the block beginning,
+         * closing gaps between them, as described in
+         * @ref GL-BufferHeap-compaction. Allocations are processed in order
+         * of their offset, first block first, and processing stops before
+         * the first allocation that would exceed @p byteLimit. The first
+         * moved allocation is however always moved, even if it's larger than
+         * the limit, so repeated calls always make progress. The views
+         * attached to moved allocations are updated before @p relocated is
+         * called.
+         * @see @fn_gl2_keyword{CopyNamedBufferSubData,CopyBufferSubData}
+         */
+        std::size_t compact(std::size_t byteLimit, void(*relocated)(UnsignedInt id, void* userData), void* userData);
+
+        /**
+         * @brief Compact the blocks without a relocation callback
+         *
+         * Equivalent to calling @ref compact(std::size_t, void(*)(UnsignedInt, void*), void*)
+         * with @p relocated set to @cpp nullptr @ce.
+         */
+        std::size_t compact(std::size_t byteLimit = ~std::size_t{}) {
+            return compact(byteLimit, nullptr, nullptr);
+        }
+
+    private:
+        struct Range;
+        struct Block;
+        struct Allocation;
+
+        MAGNUM_GL_LOCAL bool allocateInBlock(Block& block, std::size_t size, std::size_t alignment, std::size_t& offset);
+        MAGNUM_GL_LOCAL void updateView(const Allocation& allocation);
+
+        Buffer::TargetHint _targetHint;
+        std::size_t _blockSize, _usedSize{}, _allocationCount{};
+        Containers::Array<Block> _blocks;
+        Containers::Array<Allocation> _allocations;
+};
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 build
+#endif
+
+#endif
@@ -0,0 +1,198 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "CommandRecorder.h"
+
+#include <new>
+#include <Corrade/Containers/GrowableArray.h>
+
+#include "Magnum/GL/AbstractShaderProgram.h"
+#include "Magnum/GL/AbstractTexture.h"
+#include "Magnum/GL/Buffer.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Mesh.h"
+#include "Magnum/GL/MeshView.h"
+
+namespace Magnum { namespace GL {
+
+namespace {
+
+/* Each command is a header followed by a payload. Sizes of both are rounded
+   up to a multiple of the header alignment so the headers and payloads
+   that don't need more than pointer alignment can be used in-place. */
+struct Header {
+    void(*execute)(const char*);
+    std::size_t size;
+};
+
+constexpr std::size_t Alignment = alignof(Header);
+
+constexpr std::size_t paddedSize(const std::size_t size) {
+    return (size + Alignment - 1)/Alignment*Alignment;
+}
+
+struct DrawMesh {
+    AbstractShaderProgram* shader;
+    Mesh* mesh;
+};
+
+struct DrawMeshView {
+    AbstractShaderProgram* shader;
+    MeshView mesh;
+};
+
+struct SetBufferSubData {
+    Buffer* buffer;
+    GLintptr offset;
+    std::size_t size;
+    /* Followed by the data */
+};
+
+struct BindTexture {
+    AbstractTexture* texture;
+    Int textureUnit;
+};
+
+#ifndef MAGNUM_TARGET_GLES2
+struct BindBuffer {
+    Buffer* buffer;
+    GLintptr offset;
+    GLsizeiptr size;
+    Buffer::Target target;
+    UnsignedInt index;
+};
+#endif
+
+static_assert(alignof(DrawMesh) <= Alignment &&
+    alignof(DrawMeshView) <= Alignment &&
+    alignof(SetBufferSubData) <= Alignment &&
+    #ifndef MAGNUM_TARGET_GLES2
+    alignof(BindBuffer) <= Alignment &&
+    #endif
+    alignof(BindTexture) <= Alignment,
+    "command payloads are expected to not need more than pointer alignment");
+
+}
+
+CommandRecorder::CommandRecorder(): _commandCount{} {}
+
+CommandRecorder::CommandRecorder(CommandRecorder&& other) noexcept: _data{std::move(other._data)}, _commandCount{other._commandCount} {
+    other._commandCount = 0;
+}
+
+CommandRecorder::~CommandRecorder() = default;
+
+CommandRecorder& CommandRecorder::operator=(CommandRecorder&& other) noexcept {
+    using std::swap;
+    swap(_data, other._data);
+    swap(_commandCount, other._commandCount);
+    return *this;
+}
+
+char* CommandRecorder::append(const Execute execute, const std::size_t size) {
+    const std::size_t offset = _data.size();
+    arrayAppend(_data, NoInit, sizeof(Header) + paddedSize(size));
+    Header& header = *reinterpret_cast<Header*>(_data + offset);
+    header.execute = execute;
+    header.size = paddedSize(size);
+    ++_commandCount;
+    return _data + offset + sizeof(Header);
+}
+
+CommandRecorder& CommandRecorder::draw(AbstractShaderProgram& shader, Mesh& mesh) {
+    new(append([](const char* data) {
+        const DrawMesh& command = *reinterpret_cast<const DrawMesh*>(data);
+        command.shader->draw(*command.mesh);
+    }, sizeof(DrawMesh))) DrawMesh{&shader, &mesh};
+    return *this;
+}
+
+CommandRecorder& CommandRecorder::draw(AbstractShaderProgram& shader, const MeshView& mesh) {
+    new(append([](const char* data) {
+        /* The view is copied out as draw() needs a mutable reference */
+        const DrawMeshView& command = *reinterpret_cast<const DrawMeshView*>(data);
+        MeshView view = command.mesh;
+        command.shader->draw(view);
+    }, sizeof(DrawMeshView))) DrawMeshView{&shader, mesh};
+    return *this;
+}
+
+CommandRecorder& CommandRecorder::setBufferSubData(Buffer& buffer, const GLintptr offset, const Containers::ArrayView<const void> data) {
+    char* const payload = append([](const char* data) {
+        const SetBufferSubData& command = *reinterpret_cast<const SetBufferSubData*>(data);
+        command.buffer->setSubData(command.offset, Containers::ArrayView<const void>{data + sizeof(SetBufferSubData), command.size});
+    }, sizeof(SetBufferSubData) + data.size());
+    new(payload) SetBufferSubData{&buffer, offset, data.size()};
+    if(data.size()) std::memcpy(payload + sizeof(SetBufferSubData), data.data(), data.size());
+    return *this;
+}
+
+CommandRecorder& CommandRecorder::bindTexture(const Int textureUnit, AbstractTexture& texture) {
+    new(append([](const char* data) {
+        const BindTexture& command = *reinterpret_cast<const BindTexture*>(data);
+        AbstractTexture::bind(command.textureUnit, {command.texture});
+    }, sizeof(BindTexture))) BindTexture{&texture, textureUnit};
+    return *this;
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+CommandRecorder& CommandRecorder::bindBuffer(const Buffer::Target target, const UnsignedInt index, Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    new(append([](const char* data) {
+        const BindBuffer& command = *reinterpret_cast<const BindBuffer*>(data);
+        command.buffer->bind(command.target, command.index, command.offset, command.size);
+    }, sizeof(BindBuffer))) BindBuffer{&buffer, offset, size, target, index};
+    return *this;
+}
+#endif
+
+CommandRecorder& CommandRecorder::replay() {
+    CORRADE_ASSERT(Context::hasCurrent(),
+        "GL::CommandRecorder::replay(): no current GL context", *this);
+
+    for(std::size_t offset = 0; offset != _data.size(); ) {
+        const Header& header = *reinterpret_cast<const Header*>(_data + offset);
+        header.execute(_data + offset + sizeof(Header));
+        offset += sizeof(Header) + header.size;
+    }
+
+    return clear();
+}
+
+void CommandRecorder::replay(const Containers::ArrayView<const Containers::Reference<CommandRecorder>> recorders) {
+    for(CommandRecorder& recorder: recorders) recorder.replay();
+}
+
+void CommandRecorder::replay(const std::initializer_list<Containers::Reference<CommandRecorder>> recorders) {
+    replay(Containers::arrayView(recorders));
+}
+
+CommandRecorder& CommandRecorder::clear() {
+    /* Keeps the capacity, so the next recording doesn't need to allocate */
+    arrayResize(_data, NoInit, 0);
+    _commandCount = 0;
+    return *this;
+}
+
+}}
@@ -0,0 +1,242 @@
+#ifndef Magnum_GL_CommandRecorder_h
+#define Magnum_GL_CommandRecorder_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::GL::CommandRecorder
+ * @m_since_latest
+ */
+
+#include <cstring>
+#include <initializer_list>
+#include <type_traits>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Reference.h>
+
+#include "Magnum/GL/GL.h"
+#include "Magnum/GL/OpenGL.h"
+#include "Magnum/GL/visibility.h"
+
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/GL/Buffer.h"
+#endif
+
+namespace Magnum { namespace GL {
+
+/**
+@brief Deferred command recorder
+@m_since_latest
+
+Records common GL commands into a memory arena without touching the GL
+context, so the recording can happen on any thread. The commands are then
+executed in the order they were recorded with @ref replay() on the thread
+the context is current on.
+
+@section GL-CommandRecorder-usage Usage
+
+Each worker thread records into its own instance, the context thread then
+replays all of them in a fixed order once the workers are done:
+
+@snippet MagnumGL.cpp CommandRecorder-usage
+
+The replay calls the same APIs as the application would do directly, so the
+@ref opengl-state-tracking "state tracker" of the current @ref Context
+applies to the replayed commands as well --- binding a texture that's
+already bound or using a shader that's already in use doesn't result in
+any GL call.
+
+Data passed to @ref setBufferSubData() are copied into the arena. Memory of
+the arena is kept across @ref replay() and @ref clear() calls, so after the
+first few frames the recording doesn't allocate anymore. Uniform values can
+be either set through @ref setBufferSubData() on a uniform buffer or by
+recording a @ref call() to any public shader setter.
+
+@section GL-CommandRecorder-threads Thread safety
+
+A single instance has no internal synchronization, it's expected that only
+one thread records into it at a time and that the recording is finished
+with proper synchronization, such as joining the worker thread, before the
+instance is replayed. The shaders, meshes, textures and buffers are
+referenced, not copied, and have to stay alive until the replay. None of
+them are accessed during the recording, so they can be created and
+modified on the context thread while the workers record.
+*/
+class MAGNUM_GL_EXPORT CommandRecorder {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * Doesn't create any OpenGL object, so it can be safely used even
+         * without any OpenGL context being active.
+         */
+        explicit CommandRecorder();
+
+        /** @brief Copying is not allowed */
+        CommandRecorder(const CommandRecorder&) = delete;
+
+        /** @brief Move constructor */
+        CommandRecorder(CommandRecorder&& other) noexcept;
+
+        ~CommandRecorder();
+
+        /** @brief Copying is not allowed */
+        CommandRecorder& operator=(const CommandRecorder&) = delete;
+
+        /** @brief Move assignment */
+        CommandRecorder& operator=(CommandRecorder&& other) noexcept;
+
+        /** @brief Count of recorded commands */
+        std::size_t commandCount() const { return _commandCount; }
+
+        /** @brief Size of the recorded command data in bytes */
+        std::size_t dataSize() const { return _data.size(); }
+
+        /**
+         * @brief Record a mesh draw
+         * @return Reference to self (for method chaining)
+         *
+         * Replayed as @ref AbstractShaderProgram::draw(Mesh&). The mesh
+         * parameters such as vertex count are taken at the time of the
+         * replay, not recording.
+         */
+        CommandRecorder& draw(AbstractShaderProgram& shader, Mesh& mesh);
+
+        /**
+         * @brief Record a mesh view draw
+         * @return Reference to self (for method chaining)
+         *
+         * Replayed as @ref AbstractShaderProgram::draw(MeshView&). The
+         * @p mesh view is copied, the original mesh is referenced.
+         */
+        CommandRecorder& draw(AbstractShaderProgram& shader, const MeshView& mesh);
+
+        /**
+         * @brief Record a buffer data update
+         * @return Reference to self (for method chaining)
+         *
+         * The @p data are copied. Replayed as
+         * @ref Buffer::setSubData().
+         */
+        CommandRecorder& setBufferSubData(Buffer& buffer, GLintptr offset, Containers::ArrayView<const void> data);
+
+        /**
+         * @brief Record a texture binding
+         * @return Reference to self (for method chaining)
+         *
+         * Replayed as @ref AbstractTexture::bind(Int, std::initializer_list<AbstractTexture*>)
+         * with a single texture.
+         */
+        CommandRecorder& bindTexture(Int textureUnit, AbstractTexture& texture);
+
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Record an indexed buffer range binding
+         * @return Reference to self (for method chaining)
+         *
+         * Replayed as @ref Buffer::bind(Buffer::Target, UnsignedInt, GLintptr, GLsizeiptr).
+         * @requires_gl30 No form of indexed buffer binding is available in
+         *      OpenGL 2.1, see particular @ref Buffer::Target values for
+         *      version/extension requirements.
+         * @requires_gles30 No form of indexed buffer binding is available in
+         *      OpenGL ES 2.0.
+         * @requires_webgl20 No form of indexed buffer binding is available in
+         *      WebGL 1.0.
+         */
+        CommandRecorder& bindBuffer(Buffer::Target target, UnsignedInt index, Buffer& buffer, GLintptr offset, GLsizeiptr size);
+        #endif
+
+        /**
+         * @brief Record a function call
+         * @return Reference to self (for method chaining)
+         *
+         * The @p function is copied into the arena and called during the
+         * replay. It's expected to be trivially copyable, which is the case
+         * for lambdas that capture only references, pointers and values of
+         * trivially copyable types. Useful for example for calling uniform
+         * setters:
+         *
+         * @snippet MagnumGL.cpp CommandRecorder-call
+         */
+        template<class F> CommandRecorder& call(const F& function);
+
+        /**
+         * @brief Replay recorded commands
+         * @return Reference to self (for method chaining)
+         *
+         * Executes all commands in the order they were recorded and then
+         * clears the recorder. Expects that a GL context is current on the
+         * calling thread.
+         * @see @ref clear()
+         */
+        CommandRecorder& replay();
+
+        /**
+         * @brief Replay commands of multiple recorders
+         *
+         * Calls @ref replay() on all @p recorders in order.
+         */
+        static void replay(Containers::ArrayView<const Containers::Reference<CommandRecorder>> recorders);
+
+        /** @overload */
+        static void replay(std::initializer_list<Containers::Reference<CommandRecorder>> recorders);
+
+        /**
+         * @brief Clear recorded commands without executing them
+         * @return Reference to self (for method chaining)
+         *
+         * The arena memory is kept for subsequent recordings.
+         */
+        CommandRecorder& clear();
+
+    private:
+        typedef void(*Execute)(const char*);
+
+        /* Appends a command header and returns a view on the payload of
+           given size, padded to keep the following commands aligned */
+        char* append(Execute execute, std::size_t size);
+
+        Containers::Array<char> _data;
+        std::size_t _commandCount;
+};
+
+template<class F> CommandRecorder& CommandRecorder::call(const F& function) {
+    #ifdef CORRADE_STD_IS_TRIVIALLY_TRAITS_SUPPORTED
+    static_assert(std::is_trivially_copyable<F>::value,
+        "the function is expected to be trivially copyable");
+    #endif
+    /* The arena doesn't guarantee alignment of F, so it's copied back into
+       a properly aligned storage before calling */
+    std::memcpy(append([](const char* data) {
+        typename std::aligned_storage<sizeof(F), alignof(F)>::type storage;
+        std::memcpy(&storage, data, sizeof(F));
+        (*reinterpret_cast<const F*>(&storage))();
+    }, sizeof(F)), &function, sizeof(F));
+    return *this;
+}
+
+}}
+
+#endif
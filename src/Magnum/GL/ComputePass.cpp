@@ -0,0 +1,173 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ComputePass.h"
+
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/GL/AbstractShaderProgram.h"
+#include "Magnum/GL/Buffer.h"
+
+namespace Magnum { namespace GL {
+
+struct ComputePass::Binding {
+    /* Zero if nothing is bound at given index */
+    GLuint id;
+    ComputeAccess access;
+};
+
+struct ComputePass::PendingWrite {
+    GLuint id;
+    /* Barriers not issued since the last write, never empty */
+    Renderer::MemoryBarriers barriers;
+};
+
+Vector3ui ComputePass::workgroupCount(const Vector3ui& itemCount, const Vector3ui& workgroupSize) {
+    CORRADE_ASSERT(workgroupSize.product(),
+        "GL::ComputePass::workgroupCount(): expected a non-zero workgroup size but got" << Debug::packed << workgroupSize, {});
+    return (itemCount + workgroupSize - Vector3ui{1})/workgroupSize;
+}
+
+ComputePass::ComputePass() = default;
+
+ComputePass::ComputePass(ComputePass&&) noexcept = default;
+
+ComputePass::~ComputePass() = default;
+
+ComputePass& ComputePass::operator=(ComputePass&&) noexcept = default;
+
+ComputePass& ComputePass::bindStorageBuffer(const UnsignedInt index, Buffer& buffer, const ComputeAccess access) {
+    buffer.bind(Buffer::Target::ShaderStorage, index);
+
+    if(index >= _bindings.size())
+        arrayResize(_bindings, index + 1);
+    _bindings[index] = {buffer.id(), access};
+    return *this;
+}
+
+ComputePass& ComputePass::bindStorageBuffer(const UnsignedInt index, Buffer& buffer, const GLintptr offset, const GLsizeiptr size, const ComputeAccess access) {
+    #ifndef CORRADE_NO_ASSERT
+    const Int alignment = Buffer::shaderStorageOffsetAlignment();
+    #endif
+    CORRADE_ASSERT(offset % alignment == 0,
+        "GL::ComputePass::bindStorageBuffer(): expected the offset to be a multiple of" << alignment << "but got" << offset, *this);
+
+    buffer.bind(Buffer::Target::ShaderStorage, index, offset, size);
+
+    if(index >= _bindings.size())
+        arrayResize(_bindings, index + 1);
+    _bindings[index] = {buffer.id(), access};
+    return *this;
+}
+
+Renderer::MemoryBarriers ComputePass::pendingBarriers(const GLuint id) const {
+    for(const PendingWrite& pending: _pending)
+        if(pending.id == id) return pending.barriers;
+    return {};
+}
+
+Renderer::MemoryBarriers ComputePass::pendingBarriers(const Buffer& buffer) const {
+    return pendingBarriers(buffer.id());
+}
+
+void ComputePass::issueBarrier(const Renderer::MemoryBarriers barriers) {
+    Renderer::setMemoryBarrier(barriers);
+    ++_barrierCount;
+
+    /* Barriers are global, so the writes of all buffers are now available for
+       given uses. Remove the entries that have nothing left pending. */
+    std::size_t out = 0;
+    for(std::size_t i = 0; i != _pending.size(); ++i) {
+        _pending[i].barriers &= ~barriers;
+        if(_pending[i].barriers) _pending[out++] = _pending[i];
+    }
+    arrayRemoveSuffix(_pending, _pending.size() - out);
+}
+
+void ComputePass::dispatchInternal(AbstractShaderProgram& shader, const Vector3ui* const workgroupCount, Buffer* const indirectBuffer, const GLintptr offset) {
+    /* Gather the barriers needed by this dispatch. Shader storage writes have
+       to be made visible also to subsequent writes, not just reads. */
+    Renderer::MemoryBarriers barriers;
+    for(const Binding& binding: _bindings)
+        if(binding.id && (pendingBarriers(binding.id) & Renderer::MemoryBarrier::ShaderStorage))
+            barriers |= Renderer::MemoryBarrier::ShaderStorage;
+    if(indirectBuffer && (pendingBarriers(indirectBuffer->id()) & Renderer::MemoryBarrier::Command))
+        barriers |= Renderer::MemoryBarrier::Command;
+    if(barriers) issueBarrier(barriers);
+
+    if(indirectBuffer)
+        shader.dispatchComputeIndirect(*indirectBuffer, offset);
+    else
+        shader.dispatchCompute(*workgroupCount);
+
+    /* Everything written by this dispatch now needs all barriers again */
+    for(const Binding& binding: _bindings) {
+        if(!binding.id || !(UnsignedByte(binding.access) & UnsignedByte(ComputeAccess::Write)))
+            continue;
+
+        PendingWrite* found = nullptr;
+        for(PendingWrite& pending: _pending) if(pending.id == binding.id) {
+            found = &pending;
+            break;
+        }
+        if(found) found->barriers = ~Renderer::MemoryBarriers{};
+        else arrayAppend(_pending, InPlaceInit, binding.id, ~Renderer::MemoryBarriers{});
+    }
+}
+
+ComputePass& ComputePass::dispatch(AbstractShaderProgram& shader, const Vector3ui& workgroupCount) {
+    dispatchInternal(shader, &workgroupCount, nullptr, 0);
+    return *this;
+}
+
+ComputePass& ComputePass::dispatchIndirect(AbstractShaderProgram& shader, Buffer& buffer, const GLintptr offset) {
+    dispatchInternal(shader, nullptr, &buffer, offset);
+    return *this;
+}
+
+ComputePass& ComputePass::barrier(Buffer& buffer, const Renderer::MemoryBarriers barriers) {
+    const Renderer::MemoryBarriers needed = pendingBarriers(buffer.id()) & barriers;
+    if(needed) issueBarrier(needed);
+    return *this;
+}
+
+Debug& operator<<(Debug& debug, const ComputeAccess value) {
+    debug << "GL::ComputeAccess" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case ComputeAccess::value: return debug << "::" #value;
+        _c(Read)
+        _c(Write)
+        _c(ReadWrite)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+}}
@@ -0,0 +1,260 @@
+#ifndef Magnum_GL_ComputePass_h
+#define Magnum_GL_ComputePass_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+/** @file
+ * @brief Class @ref Magnum::GL::ComputePass, enum @ref Magnum::GL::ComputeAccess
+ * @m_since_latest
+ */
+#endif
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/GL/Renderer.h"
+#include "Magnum/Math/Vector3.h"
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+namespace Magnum { namespace GL {
+
+/**
+@brief Compute shader access to a storage buffer
+@m_since_latest
+
+@see @ref ComputePass::bindStorageBuffer()
+@requires_gl43 Extension @gl_extension{ARB,shader_storage_buffer_object}
+@requires_gles31 Shader storage is not available in OpenGL ES 3.0 and older.
+@requires_gles Shader storage is not available in WebGL.
+*/
+enum class ComputeAccess: UnsignedByte {
+    /** The buffer is only read by the shader */
+    Read = 1 << 0,
+
+    /** The buffer is only written by the shader */
+    Write = 1 << 1,
+
+    /** The buffer is both read and written by the shader */
+    ReadWrite = Read|Write
+};
+
+/**
+@debugoperatorenum{ComputeAccess}
+@m_since_latest
+*/
+MAGNUM_GL_EXPORT Debug& operator<<(Debug& debug, ComputeAccess value);
+
+/**
+@brief Compute dispatch helper with automatic memory barriers
+@m_since_latest
+
+Shader storage writes done by a compute dispatch aren't guaranteed to be
+visible to subsequent dispatches, draws or buffer reads until a
+@ref Renderer::setMemoryBarrier() with an appropriate bit is issued. This
+class binds storage buffers together with a declared @ref ComputeAccess,
+remembers which buffers were written by which dispatch and inserts a barrier
+only when a written buffer is actually about to be consumed, with only the
+bits needed for given consumer:
+
+@snippet MagnumGL.cpp ComputePass-usage
+
+The barriers are inserted in the following cases:
+
+-   @ref Renderer::MemoryBarrier::ShaderStorage in @ref dispatch() or
+    @ref dispatchIndirect() if any of the bound storage buffers has pending
+    writes from a previous dispatch
+-   @ref Renderer::MemoryBarrier::Command in @ref dispatchIndirect() if the
+    indirect buffer has pending writes from a previous dispatch
+-   Any bits passed to @ref barrier() if the buffer has pending writes that
+    weren't made available for that use yet, for example
+    @ref Renderer::MemoryBarrier::VertexAttributeArray before using the
+    buffer as a vertex buffer, @ref Renderer::MemoryBarrier::Command before
+    using it in @ref AbstractShaderProgram::drawIndirect() or
+    @ref Renderer::MemoryBarrier::BufferUpdate before reading it back with
+    @ref Buffer::data()
+
+As barriers are global, a barrier issued for one buffer makes pending writes
+of all other buffers available for the same kind of use as well, which the
+tracking takes into account. Buffers are identified by their OpenGL ID, so
+the tracking is not affected by moving the @ref Buffer instances around. It
+however doesn't know about writes done outside of the pass, such as by
+shaders dispatched directly through
+@ref AbstractShaderProgram::dispatchCompute() or by image stores.
+
+@section GL-ComputePass-workgroups Workgroup count calculation
+
+Compute shaders have a fixed workgroup size, while the amount of work is
+usually given as a count of items. The @ref workgroupCount() helper
+calculates a count of workgroups that covers all items, the shader is then
+expected to skip invocations outside of the range.
+
+@requires_gl43 Extension @gl_extension{ARB,compute_shader} and
+    @gl_extension{ARB,shader_storage_buffer_object}
+@requires_gles31 Compute shaders are not available in OpenGL ES 3.0 and
+    older.
+@requires_gles Compute shaders are not available in WebGL.
+*/
+class MAGNUM_GL_EXPORT ComputePass {
+    public:
+        /**
+         * @brief Workgroup count covering given item count
+         *
+         * Returns @p itemCount divided by @p workgroupSize in each
+         * dimension, rounded up. Expects that all components of
+         * @p workgroupSize are non-zero.
+         */
+        static Vector3ui workgroupCount(const Vector3ui& itemCount, const Vector3ui& workgroupSize);
+
+        /**
+         * @brief Constructor
+         *
+         * Doesn't touch any OpenGL state, so it can be constructed even
+         * without a context being active.
+         */
+        explicit ComputePass();
+
+        /** @brief Copying is not allowed */
+        ComputePass(const ComputePass&) = delete;
+
+        /** @brief Move constructor */
+        ComputePass(ComputePass&&) noexcept;
+
+        ~ComputePass();
+
+        /** @brief Copying is not allowed */
+        ComputePass& operator=(const ComputePass&) = delete;
+
+        /** @brief Move assignment */
+        ComputePass& operator=(ComputePass&&) noexcept;
+
+        /**
+         * @brief Bind a whole storage buffer
+         * @return Reference to self (for method chaining)
+         *
+         * Binds @p buffer to the @ref Buffer::Target::ShaderStorage binding
+         * at @p index. The @p access is used by the next @ref dispatch() and
+         * @ref dispatchIndirect() calls to decide whether a barrier is needed
+         * and whether the buffer has pending writes afterwards. The binding
+         * stays until another buffer is bound to the same index.
+         * @see @ref Buffer::bind(Target, UnsignedInt)
+         */
+        ComputePass& bindStorageBuffer(UnsignedInt index, Buffer& buffer, ComputeAccess access);
+
+        /**
+         * @brief Bind a storage buffer range
+         * @return Reference to self (for method chaining)
+         *
+         * Like @ref bindStorageBuffer(UnsignedInt, Buffer&, ComputeAccess)
+         * but binds only a range of @p size bytes at @p offset. Expects that
+         * @p offset is a multiple of
+         * @ref Buffer::shaderStorageOffsetAlignment(). Pending writes are
+         * tracked for the whole buffer, not just the range.
+         * @see @ref Buffer::bind(Target, UnsignedInt, GLintptr, GLsizeiptr)
+         */
+        ComputePass& bindStorageBuffer(UnsignedInt index, Buffer& buffer, GLintptr offset, GLsizeiptr size, ComputeAccess access);
+
+        /**
+         * @brief Bind a typed storage buffer range
+         * @return Reference to self (for method chaining)
+         *
+         * Binds @p count items of type @p T starting at item @p first.
+         * Equivalent to calling @ref bindStorageBuffer(UnsignedInt, Buffer&, GLintptr, GLsizeiptr, ComputeAccess)
+         * with @cpp first*sizeof(T) @ce and @cpp count*sizeof(T) @ce.
+         */
+        template<class T> ComputePass& bindStorageBuffer(UnsignedInt index, Buffer& buffer, std::size_t first, std::size_t count, ComputeAccess access) {
+            return bindStorageBuffer(index, buffer, GLintptr(first*sizeof(T)), GLsizeiptr(count*sizeof(T)), access);
+        }
+
+        /**
+         * @brief Dispatch compute
+         * @return Reference to self (for method chaining)
+         *
+         * Issues a @ref Renderer::MemoryBarrier::ShaderStorage barrier if any
+         * of the bound storage buffers has pending writes, then calls
+         * @ref AbstractShaderProgram::dispatchCompute() and marks all bound
+         * buffers with @ref ComputeAccess::Write or
+         * @ref ComputeAccess::ReadWrite as having pending writes.
+         */
+        ComputePass& dispatch(AbstractShaderProgram& shader, const Vector3ui& workgroupCount);
+
+        /**
+         * @brief Dispatch compute with workgroup count coming from a buffer
+         * @return Reference to self (for method chaining)
+         *
+         * Compared to @ref dispatch() additionally issues a
+         * @ref Renderer::MemoryBarrier::Command barrier if @p buffer has
+         * pending writes, such as when the workgroup count was calculated by
+         * a previous dispatch in this pass, and then calls
+         * @ref AbstractShaderProgram::dispatchComputeIndirect().
+         */
+        ComputePass& dispatchIndirect(AbstractShaderProgram& shader, Buffer& buffer, GLintptr offset = 0);
+
+        /**
+         * @brief Make pending writes to a buffer available for given use
+         * @return Reference to self (for method chaining)
+         *
+         * If @p buffer has pending writes from dispatches in this pass that
+         * weren't yet made available for any of @p barriers, issues a
+         * @ref Renderer::setMemoryBarrier() with those. Otherwise does
+         * nothing.
+         */
+        ComputePass& barrier(Buffer& buffer, Renderer::MemoryBarriers barriers);
+
+        /**
+         * @brief Barriers pending for a buffer
+         *
+         * Barrier bits that weren't issued since the last dispatch that wrote
+         * to @p buffer. If the buffer has no pending writes, returns an empty
+         * set.
+         */
+        Renderer::MemoryBarriers pendingBarriers(const Buffer& buffer) const;
+
+        /**
+         * @brief Count of barriers issued by this pass
+         *
+         * Useful for verifying that the declared accesses don't lead to more
+         * barriers than expected.
+         */
+        UnsignedInt barrierCount() const { return _barrierCount; }
+
+    private:
+        struct Binding;
+        struct PendingWrite;
+
+        MAGNUM_GL_LOCAL Renderer::MemoryBarriers pendingBarriers(GLuint id) const;
+        MAGNUM_GL_LOCAL void issueBarrier(Renderer::MemoryBarriers barriers);
+        MAGNUM_GL_LOCAL void dispatchInternal(AbstractShaderProgram& shader, const Vector3ui* workgroupCount, Buffer* indirectBuffer, GLintptr offset);
+
+        Containers::Array<Binding> _bindings;
+        Containers::Array<PendingWrite> _pending;
+        UnsignedInt _barrierCount{};
+};
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 and WebGL build
+#endif
+
+#endif
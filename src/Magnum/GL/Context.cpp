@@ -25,13 +25,15 @@
 
 #include "Context.h"
 
-#include <algorithm> /* std::lower_bound() */
+#include <algorithm> /* std::find() */
 #include <Corrade/Containers/EnumSet.hpp>
 #include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Utility/Arguments.h>
 #include <Corrade/Utility/Debug.h>
 #include <Corrade/Utility/Macros.h> /* CORRADE_THREAD_LOCAL */
+#include <Corrade/Utility/MurmurHash2.h>
 
+#include "Magnum/ProfileScope.h"
 #include "Magnum/GL/AbstractFramebuffer.h"
 #include "Magnum/GL/AbstractShaderProgram.h"
 #include "Magnum/GL/AbstractTexture.h"
@@ -51,6 +53,7 @@
 #include "Magnum/GL/Implementation/ContextState.h"
 #include "Magnum/GL/Implementation/BufferState.h"
 #include "Magnum/GL/Implementation/FramebufferState.h"
+#include "Magnum/GL/Implementation/MemoryUsageState.h"
 #include "Magnum/GL/Implementation/MeshState.h"
 #include "Magnum/GL/Implementation/RendererState.h"
 #include "Magnum/GL/Implementation/ShaderProgramState.h"
@@ -68,8 +71,9 @@ namespace Magnum { namespace GL {
 using namespace Containers::Literals;
 
 /* When adding a new list, Extension::extensions() and Context::Context() needs
-   to be adapted. Binary search is performed on the extensions, thus they have
-   to be sorted alphabetically. */
+   to be adapted. The lists are looked up through a hash table built in
+   extensionHashTable() below, but they're still expected to be sorted
+   alphabetically for easier maintenance and stable output order. */
 namespace {
 
 #ifndef MAGNUM_TARGET_GLES
@@ -571,13 +575,53 @@ struct {
     {Version::None, Containers::arrayView(ExtensionList)}
 };
 
+/* Open-addressing hash table with linear probing, mapping extension strings
+   to entries in KnownExtensionsForVersion, with a null extension denoting an
+   empty bucket. Drivers commonly report several hundred extensions, most of
+   which are unknown to us, and compared to a binary search in each of the
+   per-version lists this needs just a single hash calculation and usually at
+   most one string comparison for each. */
+struct ExtensionHashTableEntry {
+    const Extension* extension;
+    /* Index into KnownExtensionsForVersion */
+    std::size_t version;
+};
+
+enum: std::size_t { ExtensionHashTableSize = 512 };
+static_assert(ExtensionHashTableSize >= 2*Implementation::ExtensionCount && !(ExtensionHashTableSize & (ExtensionHashTableSize - 1)),
+    "extension hash table size expected to be a power of two with a load factor below 0.5");
+
+std::size_t extensionHash(const Containers::StringView string) {
+    return *reinterpret_cast<const std::size_t*>(Utility::MurmurHash2{}(string.data(), string.size()).byteArray());
+}
+
+const ExtensionHashTableEntry* extensionHashTable() {
+    /* The known extensions are the same for all contexts, so the table is
+       built just once on first use and then shared. A function-local static
+       to ensure it's initialized only once without any race conditions among
+       threads. */
+    static const struct Table {
+        Table(): entries{} {
+            for(std::size_t i = 0; i != Containers::arraySize(KnownExtensionsForVersion); ++i) {
+                for(const Extension& extension: KnownExtensionsForVersion[i].extensions) {
+                    std::size_t j = extensionHash(extension.string()) & (ExtensionHashTableSize - 1);
+                    while(entries[j].extension) j = (j + 1) & (ExtensionHashTableSize - 1);
+                    entries[j] = {&extension, i};
+                }
+            }
+        }
+
+        ExtensionHashTableEntry entries[ExtensionHashTableSize];
+    } table;
+    return table.entries;
+}
+
+/* Extensions in KnownExtensionsForVersion lists before `since` are ignored */
 const Extension* findExtension(const Containers::StringView extension, const std::size_t since = 0) {
-    for(std::size_t i = since; i != Containers::arraySize(KnownExtensionsForVersion); ++i) {
-        const auto found = std::lower_bound(KnownExtensionsForVersion[i].extensions.begin(), KnownExtensionsForVersion[i].extensions.end(), extension, [](const Extension& a, const Containers::StringView& b) {
-            return a.string() < b;
-        });
-        if(found != KnownExtensionsForVersion[i].extensions.end() && found->string() == extension)
-            return found;
+    const ExtensionHashTableEntry* const table = extensionHashTable();
+    for(std::size_t i = extensionHash(extension) & (ExtensionHashTableSize - 1); table[i].extension; i = (i + 1) & (ExtensionHashTableSize - 1)) {
+        if(table[i].extension->string() == extension)
+            return table[i].version >= since ? table[i].extension : nullptr;
     }
 
     return {};
@@ -758,6 +802,7 @@ Context::Context(Context&& other) noexcept:
     _supportedExtensions{std::move(other._supportedExtensions)},
     #endif
     _state{other._state},
+    _memoryUsageState{std::move(other._memoryUsageState)},
     _detectedDrivers{std::move(other._detectedDrivers)},
     _driverWorkarounds{std::move(other._driverWorkarounds)},
     _disabledExtensions{std::move(other._disabledExtensions)},
@@ -810,10 +855,15 @@ bool Context::tryCreate(const Configuration& configuration) {
     for(const Extension& extension: configuration.disabledExtensions())
         arrayAppend(_disabledExtensions, extension);
 
+    /* Timestamps for the startup time breakdown printed with verbose log */
+    const UnsignedLong startTime = Magnum::Implementation::profileScopeTime();
+
     /* Load GL function pointers. Pass this instance to it so it can use it for
        potential driver-specific workarounds. */
     if(_functionLoader) _functionLoader(*this);
 
+    const UnsignedLong functionLoaderTime = Magnum::Implementation::profileScopeTime();
+
     /* Initialize to something predictable to avoid crashes on improperly
        created contexts */
     GLint majorVersion = 0, minorVersion = 0;
@@ -956,10 +1006,14 @@ bool Context::tryCreate(const Configuration& configuration) {
     for(const Extension& extension: _disabledExtensions)
         _extensionRequiredVersion[extension.index()] = Version::None;
 
+    const UnsignedLong extensionTime = Magnum::Implementation::profileScopeTime();
+
     /* Setup driver workarounds (increase required version for particular
        extensions), see Implementation/driverWorkarounds.cpp */
     setupDriverWorkarounds();
 
+    const UnsignedLong driverWorkaroundTime = Magnum::Implementation::profileScopeTime();
+
     /* Set this context as current */
     CORRADE_ASSERT(!currentContext, "GL::Context: Another context currently active", false);
     currentContext = this;
@@ -988,6 +1042,8 @@ bool Context::tryCreate(const Configuration& configuration) {
     _stateData = std::move(state.first);
     _state = &state.second;
 
+    const UnsignedLong stateTime = Magnum::Implementation::profileScopeTime();
+
     /* Print a list of used workarounds */
     if(!_driverWorkarounds.isEmpty()) {
         Debug{output} << "Using driver workarounds:";
@@ -1037,6 +1093,19 @@ bool Context::tryCreate(const Configuration& configuration) {
         #endif
     }
 
+    /* Print the startup time breakdown, if requested. The remaining time is
+       spent in querying the default viewport, initializing the renderer
+       state and enabling GPU validation. */
+    if(_configurationFlags & Configuration::Flag::VerboseLog) {
+        const UnsignedLong endTime = Magnum::Implementation::profileScopeTime();
+        Debug{} << "GL::Context: created in" << (endTime - startTime)/1.0e6 << "ms:";
+        Debug{} << "    function loading:" << (functionLoaderTime - startTime)/1.0e6 << "ms";
+        Debug{} << "    version and extension detection:" << (extensionTime - functionLoaderTime)/1.0e6 << "ms";
+        Debug{} << "    driver workarounds:" << (driverWorkaroundTime - extensionTime)/1.0e6 << "ms";
+        Debug{} << "    startup log and state tracker setup:" << (stateTime - driverWorkaroundTime)/1.0e6 << "ms";
+        Debug{} << "    remaining setup:" << (endTime - stateTime)/1.0e6 << "ms";
+    }
+
     /* Everything okay */
     return true;
 }
@@ -1183,6 +1252,8 @@ Version Context::supportedVersion(std::initializer_list<Version> versions) const
 }
 
 void Context::resetState(const States states) {
+    MAGNUM_PROFILE_SCOPE("GL::Context::resetState()");
+
     #ifndef MAGNUM_TARGET_GLES2
     /* Unbind a PBO (if any) to avoid confusing external GL code that is not
        aware of those. Doing this before all buffer state is reset so we can
@@ -1222,7 +1293,8 @@ void Context::resetState(const States states) {
         _state->renderer.packPixelStorage.reset();
     }
 
-    /* Nothing to reset for renderer yet */
+    if(states & State::Renderer)
+        _state->renderer.reset();
 
     if(states & State::Shaders) {
         /* Nothing to reset for shaders */
@@ -1237,6 +1309,36 @@ void Context::resetState(const States states) {
     #endif
 }
 
+UnsignedLong Context::counter(const ContextCounter counter) const {
+    switch(counter) {
+        case ContextCounter::DrawCalls:
+            return _state->mesh.drawCount;
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        case ContextCounter::ComputeDispatches:
+            return _state->shaderProgram.dispatchCount;
+        #endif
+        case ContextCounter::ShaderProgramSwitches:
+            return _state->shaderProgram.switchCount;
+        case ContextCounter::TextureBindings:
+            return _state->texture.bindCount;
+        case ContextCounter::BufferUploads:
+            return _state->buffer.uploadCount;
+        case ContextCounter::BufferUploadSize:
+            return _state->buffer.uploadSize;
+    }
+
+    CORRADE_ASSERT_UNREACHABLE("GL::Context::counter(): invalid counter" << counter, {});
+}
+
+void Context::resetCounters() {
+    _state->mesh.drawCount = 0;
+    _state->shaderProgram.switchCount = 0;
+    _state->shaderProgram.dispatchCount = 0;
+    _state->texture.bindCount = 0;
+    _state->buffer.uploadCount = 0;
+    _state->buffer.uploadSize = 0;
+}
+
 Context::Configuration::Configuration() = default;
 
 Context::Configuration::Configuration(const Configuration& other): _flags{other._flags} {
@@ -1370,6 +1472,27 @@ Debug& operator<<(Debug& debug, const Context::DetectedDrivers value) {
         #endif
     });
 }
+
+Debug& operator<<(Debug& debug, const ContextCounter value) {
+    debug << "GL::ContextCounter" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case ContextCounter::value: return debug << "::" #value;
+        _c(DrawCalls)
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        _c(ComputeDispatches)
+        #endif
+        _c(ShaderProgramSwitches)
+        _c(TextureBindings)
+        _c(BufferUploads)
+        _c(BufferUploadSize)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedInt(value)) << Debug::nospace << ")";
+}
 #endif
 
 }}
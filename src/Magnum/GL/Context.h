@@ -26,7 +26,7 @@
 */
 
 /** @file
- * @brief Class @ref Magnum::GL::Context, @ref Magnum::GL::Extension, macro @ref MAGNUM_ASSERT_GL_VERSION_SUPPORTED(), @ref MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED()
+ * @brief Class @ref Magnum::GL::Context, @ref Magnum::GL::Extension, enum @ref Magnum::GL::ContextCounter, macro @ref MAGNUM_ASSERT_GL_VERSION_SUPPORTED(), @ref MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED()
  */
 
 #include <cstdlib>
@@ -34,6 +34,7 @@
 #include <Corrade/Containers/ArrayTuple.h>
 #include <Corrade/Containers/EnumSet.h>
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pointer.h>
 #include <Corrade/Containers/StaticArray.h>
 
 #include "Magnum/Magnum.h"
@@ -56,6 +57,7 @@ namespace GL {
 
 namespace Implementation {
     struct ContextState;
+    struct MemoryUsageState;
     struct State;
 
     template<class...> class IsExtension;
@@ -80,6 +82,67 @@ namespace Implementation {
     CORRADE_ENUMSET_OPERATORS(ContextConfigurationFlags)
 }
 
+/**
+@brief Context counter
+@m_since_latest
+
+@see @ref Context::counter(), @ref Context::resetCounters()
+*/
+enum class ContextCounter: UnsignedInt {
+    /**
+     * Draw calls submitted through @ref AbstractShaderProgram::draw(),
+     * @ref AbstractShaderProgram::drawTransformFeedback() and
+     * @relativeref{AbstractShaderProgram,drawIndirect()}. A multi-draw
+     * or an indirect draw is counted as a single call. Draws that
+     * are skipped because the mesh has zero vertices or instances
+     * aren't counted.
+     */
+    DrawCalls,
+
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    /**
+     * Compute dispatches submitted through
+     * @ref AbstractShaderProgram::dispatchCompute() and
+     * @relativeref{AbstractShaderProgram,dispatchComputeIndirect()}.
+     * @requires_gl43 Extension @gl_extension{ARB,compute_shader}
+     * @requires_gles31 Compute shaders are not available in OpenGL ES
+     *      3.0 and older.
+     * @requires_gles Compute shaders are not available in WebGL.
+     */
+    ComputeDispatches,
+    #endif
+
+    /**
+     * Shader program switches, i.e. @fn_gl{UseProgram} calls that
+     * weren't filtered out by the state tracker.
+     */
+    ShaderProgramSwitches,
+
+    /**
+     * Texture bindings and unbindings done through
+     * @ref AbstractTexture::bind(), @ref AbstractTexture::unbind() and
+     * the texture-specific @cpp bind() @ce functions that weren't
+     * filtered out by the state tracker. In case of a multi-bind,
+     * each texture unit that changed is counted separately. Bindings
+     * done internally for setting texture parameters or uploading
+     * data aren't counted.
+     */
+    TextureBindings,
+
+    /**
+     * Buffer data uploads done through @ref Buffer::setData(),
+     * @ref Buffer::setSubData() and @ref Buffer::setStorage(). Calls
+     * that only allocate the storage without any data aren't counted.
+     */
+    BufferUploads,
+
+    /**
+     * Total size of buffer data uploads counted in
+     * @ref ContextCounter::BufferUploads, in bytes.
+     */
+    BufferUploadSize
+};
+
 /**
 @brief Run-time information about OpenGL extension
 
@@ -185,7 +248,8 @@ Arguments:
 -   `--magnum-log default|quiet|verbose` --- console logging
     (environment: `MAGNUM_LOG`) (default: `default`). Corresponds to
     @ref Configuration::Flag::QuietLog and
-    @relativeref{Configuration::Flag,VerboseLog}.
+    @relativeref{Configuration::Flag,VerboseLog}. The verbose log
+    additionally contains a breakdown of the time spent in context creation.
 
 Note that all options are prefixed with `--magnum-` to avoid conflicts with
 options passed to the application itself. Options that don't have this prefix
@@ -841,6 +905,29 @@ class MAGNUM_GL_EXPORT Context {
          */
         void resetState(States states = ~States{});
 
+        /**
+         * @brief Counter value
+         * @m_since_latest
+         *
+         * Returns the value accumulated since the context was created or
+         * since the last @ref resetCounters() call. The counters are always
+         * maintained as they're just an integer increment next to state
+         * tracker updates that are done anyway, and are not affected by
+         * @ref resetState(). See also
+         * @ref DebugTools::contextCounterMeasurement() for exposing the
+         * counters in a @ref DebugTools::FrameProfiler.
+         */
+        UnsignedLong counter(ContextCounter counter) const;
+
+        /**
+         * @brief Reset all counters to zero
+         * @m_since_latest
+         *
+         * Meant to be called at the start of each frame to get per-frame
+         * values from @ref counter().
+         */
+        void resetCounters();
+
         /**
          * @brief Detect driver
          *
@@ -856,6 +943,7 @@ class MAGNUM_GL_EXPORT Context {
     #endif
         bool isDriverWorkaroundDisabled(Containers::StringView workaround);
         Implementation::State& state() { return *_state; }
+        Containers::Pointer<Implementation::MemoryUsageState>& memoryUsageState() { return _memoryUsageState; }
 
         /* This function is called from MeshState constructor, which means the
            state() pointer is not ready yet so we have to pass it directly */
@@ -909,6 +997,8 @@ class MAGNUM_GL_EXPORT Context {
 
         Containers::ArrayTuple _stateData;
         Implementation::State* _state;
+        /* Allocated only if GL::MemoryUsage tracking is enabled */
+        Containers::Pointer<Implementation::MemoryUsageState> _memoryUsageState;
 
         Containers::Optional<DetectedDrivers> _detectedDrivers;
 
@@ -941,6 +1031,12 @@ MAGNUM_GL_EXPORT Debug& operator<<(Debug& debug, Context::DetectedDriver value);
 /** @debugoperatorclassenum{Context,Context::DetectedDrivers} */
 MAGNUM_GL_EXPORT Debug& operator<<(Debug& debug, Context::DetectedDrivers value);
 
+/**
+@debugoperatorenum{ContextCounter}
+@m_since_latest
+*/
+MAGNUM_GL_EXPORT Debug& operator<<(Debug& debug, ContextCounter value);
+
 /**
 @brief Configuration
 @m_since_latest
@@ -992,8 +1088,10 @@ class MAGNUM_GL_EXPORT Context::Configuration {
 
             /**
              * Print additional information on startup in addition to the usual
-             * startup log that lists used extensions and workarounds. Has a
-             * precedence over @ref Flag::QuietLog.
+             * startup log that lists used extensions and workarounds,
+             * including a breakdown of the time spent in function loading,
+             * extension detection, driver workaround and state tracker setup.
+             * Has a precedence over @ref Flag::QuietLog.
              *
              * Corresponds to the `--magnum-log verbose`
              * @ref GL-Context-usage-command-line "command-line option".
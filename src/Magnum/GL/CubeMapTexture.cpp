@@ -36,6 +36,9 @@
 #endif
 #include "Magnum/GL/Context.h"
 #include "Magnum/GL/PixelFormat.h"
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/GL/Implementation/imageStaging.h"
+#endif
 #include "Magnum/GL/Implementation/maxTextureSize.h"
 #include "Magnum/GL/Implementation/RendererState.h"
 #include "Magnum/GL/Implementation/State.h"
@@ -548,6 +551,87 @@ CubeMapTexture& CubeMapTexture::setCompressedSubImage(const Int level, const Vec
 }
 #endif
 
+CubeMapTexture& CubeMapTexture::setSubImages(const Int firstLevel, const Containers::ArrayView<const ImageView3D> images) {
+    createIfNotAlready();
+
+    /* Same as in AbstractTexture::DataHelper<2>::setSubImages() */
+    #ifndef MAGNUM_TARGET_GLES2
+    Buffer::unbindInternal(Buffer::TargetHint::PixelUnpack);
+    #endif
+    Implementation::State& state = Context::current().state();
+    for(std::size_t i = 0; i != images.size(); ++i) {
+        const ImageView3D& image = images[i];
+        state.renderer.applyPixelStorageUnpack(image.storage());
+        (this->*state.texture.cubeSubImage3DImplementation)(GLint(firstLevel + i), {}, image.size(), pixelFormat(image.format()), pixelType(image.format(), image.formatExtra()), image.data()
+            #ifdef MAGNUM_TARGET_GLES2
+            + Magnum::Implementation::pixelStorageSkipOffset(image)
+            #endif
+            , image.storage());
+    }
+    return *this;
+}
+
+CubeMapTexture& CubeMapTexture::setSubImages(const Int firstLevel, const std::initializer_list<ImageView3D> images) {
+    return setSubImages(firstLevel, Containers::arrayView(images.begin(), images.size()));
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+CubeMapTexture& CubeMapTexture::setSubImages(const Int firstLevel, const Containers::ArrayView<const ImageView3D> images, Buffer& stagingBuffer) {
+    createIfNotAlready();
+
+    const Containers::Array<std::size_t> offsets = Implementation::stageImageData(stagingBuffer, images);
+    stagingBuffer.bindInternal(Buffer::TargetHint::PixelUnpack);
+    Implementation::State& state = Context::current().state();
+    for(std::size_t i = 0; i != images.size(); ++i) {
+        const ImageView3D& image = images[i];
+        state.renderer.applyPixelStorageUnpack(image.storage());
+        (this->*state.texture.cubeSubImage3DImplementation)(GLint(firstLevel + i), {}, image.size(), pixelFormat(image.format()), pixelType(image.format(), image.formatExtra()), reinterpret_cast<const GLvoid*>(offsets[i]), image.storage());
+    }
+    return *this;
+}
+
+CubeMapTexture& CubeMapTexture::setSubImages(const Int firstLevel, const std::initializer_list<ImageView3D> images, Buffer& stagingBuffer) {
+    return setSubImages(firstLevel, Containers::arrayView(images.begin(), images.size()), stagingBuffer);
+}
+#endif
+
+#ifndef MAGNUM_TARGET_GLES
+CubeMapTexture& CubeMapTexture::setCompressedSubImages(const Int firstLevel, const Containers::ArrayView<const CompressedImageView3D> images) {
+    createIfNotAlready();
+
+    Buffer::unbindInternal(Buffer::TargetHint::PixelUnpack);
+    Implementation::RendererState& state = Context::current().state().renderer;
+    for(std::size_t i = 0; i != images.size(); ++i) {
+        const CompressedImageView3D& image = images[i];
+        state.applyPixelStorageUnpack(image.storage());
+        glCompressedTextureSubImage3D(_id, GLint(firstLevel + i), 0, 0, 0, image.size().x(), image.size().y(), image.size().z(), GLenum(compressedPixelFormat(image.format())), Magnum::Implementation::occupiedCompressedImageDataSize(image, image.data().size()), image.data());
+    }
+    return *this;
+}
+
+CubeMapTexture& CubeMapTexture::setCompressedSubImages(const Int firstLevel, const std::initializer_list<CompressedImageView3D> images) {
+    return setCompressedSubImages(firstLevel, Containers::arrayView(images.begin(), images.size()));
+}
+
+CubeMapTexture& CubeMapTexture::setCompressedSubImages(const Int firstLevel, const Containers::ArrayView<const CompressedImageView3D> images, Buffer& stagingBuffer) {
+    createIfNotAlready();
+
+    const Containers::Array<std::size_t> offsets = Implementation::stageImageData(stagingBuffer, images);
+    stagingBuffer.bindInternal(Buffer::TargetHint::PixelUnpack);
+    Implementation::RendererState& state = Context::current().state().renderer;
+    for(std::size_t i = 0; i != images.size(); ++i) {
+        const CompressedImageView3D& image = images[i];
+        state.applyPixelStorageUnpack(image.storage());
+        glCompressedTextureSubImage3D(_id, GLint(firstLevel + i), 0, 0, 0, image.size().x(), image.size().y(), image.size().z(), GLenum(compressedPixelFormat(image.format())), Magnum::Implementation::occupiedCompressedImageDataSize(image, image.data().size()), reinterpret_cast<const GLvoid*>(offsets[i]));
+    }
+    return *this;
+}
+
+CubeMapTexture& CubeMapTexture::setCompressedSubImages(const Int firstLevel, const std::initializer_list<CompressedImageView3D> images, Buffer& stagingBuffer) {
+    return setCompressedSubImages(firstLevel, Containers::arrayView(images.begin(), images.size()), stagingBuffer);
+}
+#endif
+
 CubeMapTexture& CubeMapTexture::setSubImage(const CubeMapCoordinate coordinate, const Int level, const Vector2i& offset, const ImageView2D& image) {
     #ifndef MAGNUM_TARGET_GLES2
     Buffer::unbindInternal(Buffer::TargetHint::PixelUnpack);
@@ -1169,6 +1169,108 @@ class MAGNUM_GL_EXPORT CubeMapTexture: public AbstractTexture {
         }
         #endif
 
+        /**
+         * @brief Set image subdata of all six faces for consecutive mip levels
+         * @param firstLevel        First mip level
+         * @param images            @ref Image3D, @ref ImageView3D or
+         *      @ref Trade::ImageData3D with all six faces for each level
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Equivalent to calling @ref setSubImage(Int, const Vector3i&, const ImageView3D&)
+         * with a zero offset for each image, the image at index @cpp i @ce
+         * going to mip level @cpp firstLevel + i @ce. See
+         * @ref Texture::setSubImages() for more information.
+         * @requires_gles30 Extension @gl_extension{EXT,unpack_subimage}/
+         *      @gl_extension{NV,pack_subimage} in OpenGL ES 2.0 if
+         *      @ref PixelStorage::rowLength() is set to a non-zero value.
+         * @requires_webgl20 Non-zero @ref PixelStorage::rowLength() is not
+         *      supported in WebGL 1.0.
+         */
+        CubeMapTexture& setSubImages(Int firstLevel, Containers::ArrayView<const ImageView3D> images);
+
+        /** @overload
+         * @m_since_latest
+         */
+        CubeMapTexture& setSubImages(Int firstLevel, std::initializer_list<ImageView3D> images);
+
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Set image subdata of all six faces for consecutive mip levels through a staging buffer
+         * @param firstLevel        First mip level
+         * @param images            @ref Image3D, @ref ImageView3D or
+         *      @ref Trade::ImageData3D with all six faces for each level
+         * @param stagingBuffer     Buffer to stage the image data in
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * See @ref Texture::setSubImages(Int, Containers::ArrayView<const BasicImageView<dimensions>>, Buffer&)
+         * for more information.
+         * @requires_gl30 Extension @gl_extension{ARB,map_buffer_range}
+         * @requires_gles30 Pixel buffer objects are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Pixel buffer objects are not available in WebGL
+         *      1.0.
+         */
+        CubeMapTexture& setSubImages(Int firstLevel, Containers::ArrayView<const ImageView3D> images, Buffer& stagingBuffer);
+
+        /** @overload
+         * @m_since_latest
+         */
+        CubeMapTexture& setSubImages(Int firstLevel, std::initializer_list<ImageView3D> images, Buffer& stagingBuffer);
+        #endif
+
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Set compressed image subdata of all six faces for consecutive mip levels
+         * @param firstLevel        First mip level
+         * @param images            @ref CompressedImage3D,
+         *      @ref CompressedImageView3D or compressed
+         *      @ref Trade::ImageData3D with all six faces for each level
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Compressed equivalent of @ref setSubImages(Int, Containers::ArrayView<const ImageView3D>),
+         * see its documentation for more information.
+         * @requires_gl45 Extension @gl_extension{ARB,direct_state_access}
+         * @requires_gl42 Extension @gl_extension{ARB,compressed_texture_pixel_storage}
+         *      for non-default @ref CompressedPixelStorage
+         * @requires_gl In OpenGL ES and WebGL you need to set image for each
+         *      face separately.
+         */
+        CubeMapTexture& setCompressedSubImages(Int firstLevel, Containers::ArrayView<const CompressedImageView3D> images);
+
+        /** @overload
+         * @m_since_latest
+         */
+        CubeMapTexture& setCompressedSubImages(Int firstLevel, std::initializer_list<CompressedImageView3D> images);
+
+        /**
+         * @brief Set compressed image subdata of all six faces for consecutive mip levels through a staging buffer
+         * @param firstLevel        First mip level
+         * @param images            @ref CompressedImage3D,
+         *      @ref CompressedImageView3D or compressed
+         *      @ref Trade::ImageData3D with all six faces for each level
+         * @param stagingBuffer     Buffer to stage the image data in
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Compressed equivalent of @ref setSubImages(Int, Containers::ArrayView<const ImageView3D>, Buffer&),
+         * see its documentation for more information.
+         * @requires_gl45 Extension @gl_extension{ARB,direct_state_access}
+         * @requires_gl42 Extension @gl_extension{ARB,compressed_texture_pixel_storage}
+         *      for non-default @ref CompressedPixelStorage
+         * @requires_gl In OpenGL ES and WebGL you need to set image for each
+         *      face separately.
+         */
+        CubeMapTexture& setCompressedSubImages(Int firstLevel, Containers::ArrayView<const CompressedImageView3D> images, Buffer& stagingBuffer);
+
+        /** @overload
+         * @m_since_latest
+         */
+        CubeMapTexture& setCompressedSubImages(Int firstLevel, std::initializer_list<CompressedImageView3D> images, Buffer& stagingBuffer);
+        #endif
+
         /**
          * @brief @copybrief Texture::setSubImage()
          * @return Reference to self (for method chaining)
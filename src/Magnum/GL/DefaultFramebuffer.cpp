@@ -93,10 +93,14 @@ DefaultFramebuffer& DefaultFramebuffer::mapForRead(const ReadAttachment attachme
 }
 
 void DefaultFramebuffer::invalidate(std::initializer_list<InvalidationAttachment> attachments) {
+    invalidate(Containers::arrayView(attachments));
+}
+
+void DefaultFramebuffer::invalidate(const Containers::ArrayView<const InvalidationAttachment> attachments) {
     /** @todo C++14: use VLA to avoid heap allocation */
     Containers::Array<GLenum> _attachments(attachments.size());
     for(std::size_t i = 0; i != attachments.size(); ++i)
-        _attachments[i] = GLenum(*(attachments.begin()+i));
+        _attachments[i] = GLenum(attachments[i]);
 
     (this->*Context::current().state().framebuffer.invalidateImplementation)(attachments.size(), _attachments);
 }
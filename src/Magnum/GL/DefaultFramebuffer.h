@@ -444,6 +444,15 @@ class MAGNUM_GL_EXPORT DefaultFramebuffer: public AbstractFramebuffer {
          *      1.0.
          */
         void invalidate(std::initializer_list<InvalidationAttachment> attachments);
+
+        /**
+         * @overload
+         * @m_since_latest
+         *
+         * Useful when the set of attachments to invalidate is known only at
+         * runtime.
+         */
+        void invalidate(Containers::ArrayView<const InvalidationAttachment> attachments);
         #endif
 
         #ifndef MAGNUM_TARGET_GLES2
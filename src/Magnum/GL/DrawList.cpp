@@ -0,0 +1,246 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "DrawList.h"
+
+#include <algorithm>
+#include <Corrade/Containers/GrowableArray.h>
+
+#include "Magnum/GL/AbstractShaderProgram.h"
+#include "Magnum/GL/AbstractTexture.h"
+#include "Magnum/GL/MeshView.h"
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/GL/Buffer.h"
+#endif
+
+namespace Magnum { namespace GL {
+
+namespace {
+
+/* The sort key is layer, shader, mesh and binding set, from the most
+   significant bits. Binding set 0 means no bindings, the registered ones
+   are offset by one. */
+constexpr UnsignedInt LayerBits = 8;
+constexpr UnsignedInt ShaderBits = 16;
+constexpr UnsignedInt MeshBits = 20;
+constexpr UnsignedInt BindingSetBits = 20;
+constexpr UnsignedInt MeshShift = BindingSetBits;
+constexpr UnsignedInt ShaderShift = MeshShift + MeshBits;
+constexpr UnsignedInt LayerShift = ShaderShift + ShaderBits;
+static_assert(LayerShift + LayerBits == 64, "sort key bits don't add up");
+
+}
+
+struct DrawList::Draw {
+    UnsignedLong key;
+    /* Index into _meshViews, which is also the order in which the draws
+       were added */
+    UnsignedInt index;
+};
+
+struct DrawList::BindingSet {
+    Int firstTextureUnit;
+    UnsignedInt textureOffset, textureCount;
+    #ifndef MAGNUM_TARGET_GLES2
+    UnsignedInt firstUniformBinding;
+    UnsignedInt uniformBufferOffset, uniformBufferCount;
+    #endif
+};
+
+DrawList::DrawList(): _layerCallback{}, _layerCallbackUserData{} {}
+
+DrawList::DrawList(DrawList&& other) noexcept: _draws{std::move(other._draws)}, _meshViews{std::move(other._meshViews)}, _shaders{std::move(other._shaders)}, _shaderIds{std::move(other._shaderIds)}, _meshIds{std::move(other._meshIds)}, _bindingSets{std::move(other._bindingSets)}, _textures{std::move(other._textures)},
+    #ifndef MAGNUM_TARGET_GLES2
+    _uniformBuffers{std::move(other._uniformBuffers)},
+    #endif
+    _batch{std::move(other._batch)}, _layerCallback{other._layerCallback}, _layerCallbackUserData{other._layerCallbackUserData} {}
+
+DrawList::~DrawList() = default;
+
+DrawList& DrawList::operator=(DrawList&& other) noexcept {
+    using std::swap;
+    swap(_draws, other._draws);
+    swap(_meshViews, other._meshViews);
+    swap(_shaders, other._shaders);
+    swap(_shaderIds, other._shaderIds);
+    swap(_meshIds, other._meshIds);
+    swap(_bindingSets, other._bindingSets);
+    swap(_textures, other._textures);
+    #ifndef MAGNUM_TARGET_GLES2
+    swap(_uniformBuffers, other._uniformBuffers);
+    #endif
+    swap(_batch, other._batch);
+    swap(_layerCallback, other._layerCallback);
+    swap(_layerCallbackUserData, other._layerCallbackUserData);
+    return *this;
+}
+
+UnsignedInt DrawList::addBindingSet(const Int firstTextureUnit, const Containers::ArrayView<AbstractTexture* const> textures) {
+    #ifndef MAGNUM_TARGET_GLES2
+    return addBindingSet(firstTextureUnit, textures, 0, nullptr);
+    #else
+    CORRADE_ASSERT(_bindingSets.size() < (1u << BindingSetBits) - 1,
+        "GL::DrawList::addBindingSet(): at most" << (1u << BindingSetBits) - 1 << "binding sets can be added", {});
+
+    arrayAppend(_bindingSets, BindingSet{firstTextureUnit, UnsignedInt(_textures.size()), UnsignedInt(textures.size())});
+    arrayAppend(_textures, textures);
+    return _bindingSets.size() - 1;
+    #endif
+}
+
+UnsignedInt DrawList::addBindingSet(const Int firstTextureUnit, const std::initializer_list<AbstractTexture*> textures) {
+    return addBindingSet(firstTextureUnit, Containers::arrayView(textures));
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+UnsignedInt DrawList::addBindingSet(const Int firstTextureUnit, const Containers::ArrayView<AbstractTexture* const> textures, const UnsignedInt firstUniformBinding, const Containers::ArrayView<const Containers::Triple<Buffer*, GLintptr, GLsizeiptr>> uniformBuffers) {
+    CORRADE_ASSERT(_bindingSets.size() < (1u << BindingSetBits) - 1,
+        "GL::DrawList::addBindingSet(): at most" << (1u << BindingSetBits) - 1 << "binding sets can be added", {});
+
+    arrayAppend(_bindingSets, BindingSet{firstTextureUnit, UnsignedInt(_textures.size()), UnsignedInt(textures.size()), firstUniformBinding, UnsignedInt(_uniformBuffers.size()), UnsignedInt(uniformBuffers.size())});
+    arrayAppend(_textures, textures);
+    arrayAppend(_uniformBuffers, uniformBuffers);
+    return _bindingSets.size() - 1;
+}
+
+UnsignedInt DrawList::addBindingSet(const Int firstTextureUnit, const std::initializer_list<AbstractTexture*> textures, const UnsignedInt firstUniformBinding, const std::initializer_list<Containers::Triple<Buffer*, GLintptr, GLsizeiptr>> uniformBuffers) {
+    return addBindingSet(firstTextureUnit, Containers::arrayView(textures), firstUniformBinding, Containers::arrayView(uniformBuffers));
+}
+#endif
+
+DrawList& DrawList::setLayerCallback(const LayerCallback callback, void* const userData) {
+    _layerCallback = callback;
+    _layerCallbackUserData = userData;
+    return *this;
+}
+
+DrawList& DrawList::add(AbstractShaderProgram& shader, const MeshView& mesh, const UnsignedInt bindingSet, const UnsignedInt layer) {
+    CORRADE_ASSERT(bindingSet == ~UnsignedInt{} || bindingSet < _bindingSets.size(),
+        "GL::DrawList::add(): binding set" << bindingSet << "out of range for" << _bindingSets.size() << "binding sets", *this);
+    CORRADE_ASSERT(layer < (1u << LayerBits),
+        "GL::DrawList::add(): expected layer to be less than" << (1u << LayerBits) << "but got" << layer, *this);
+
+    CORRADE_ASSERT(_shaderIds.size() < (1u << ShaderBits) || _shaderIds.count(&shader),
+        "GL::DrawList::add(): at most" << (1u << ShaderBits) << "distinct shaders can be used in a single flush", *this);
+    CORRADE_ASSERT(_meshIds.size() < (1u << MeshBits) || _meshIds.count(&mesh.mesh()),
+        "GL::DrawList::add(): at most" << (1u << MeshBits) << "distinct meshes can be used in a single flush", *this);
+
+    /* Assign a sequential ID to each distinct shader and mesh so they fit
+       into the key */
+    const auto shaderId = _shaderIds.emplace(&shader, UnsignedInt(_shaderIds.size()));
+    if(shaderId.second) arrayAppend(_shaders, &shader);
+    const auto meshId = _meshIds.emplace(&mesh.mesh(), UnsignedInt(_meshIds.size()));
+
+    arrayAppend(_draws, Draw{
+        UnsignedLong(layer) << LayerShift|
+        UnsignedLong(shaderId.first->second) << ShaderShift|
+        UnsignedLong(meshId.first->second) << MeshShift|
+        /* ~UnsignedInt{} overflows to 0 */
+        UnsignedLong(bindingSet + 1),
+        UnsignedInt(_meshViews.size())});
+    arrayAppend(_meshViews, mesh);
+    return *this;
+}
+
+void DrawList::applyBindingSet(const UnsignedInt id) {
+    const BindingSet& set = _bindingSets[id];
+    if(set.textureCount)
+        AbstractTexture::bind(set.firstTextureUnit, _textures.slice(set.textureOffset, set.textureOffset + set.textureCount));
+    #ifndef MAGNUM_TARGET_GLES2
+    for(std::size_t i = 0; i != set.uniformBufferCount; ++i) {
+        const Containers::Triple<Buffer*, GLintptr, GLsizeiptr>& buffer = _uniformBuffers[set.uniformBufferOffset + i];
+        if(buffer.first())
+            buffer.first()->bind(Buffer::Target::Uniform, set.firstUniformBinding + i, buffer.second(), buffer.third());
+        else
+            Buffer::unbind(Buffer::Target::Uniform, set.firstUniformBinding + i);
+    }
+    #endif
+}
+
+std::size_t DrawList::flush() {
+    /* Sorting by the key together with the index keeps the draws with equal
+       state in the order they were added */
+    std::sort(_draws.begin(), _draws.end(), [](const Draw& a, const Draw& b) {
+        return a.key < b.key || (a.key == b.key && a.index < b.index);
+    });
+
+    std::size_t submissionCount = 0;
+    AbstractShaderProgram* batchShader = nullptr;
+    const auto submitBatch = [&]() {
+        if(_batch.isEmpty()) return;
+        batchShader->draw(_batch);
+        arrayResize(_batch, NoInit, 0);
+        ++submissionCount;
+    };
+
+    constexpr UnsignedLong BindingSetMask = (1ull << BindingSetBits) - 1;
+    for(std::size_t i = 0; i != _draws.size(); ++i) {
+        const Draw& draw = _draws[i];
+        const UnsignedLong previousKey = i ? _draws[i - 1].key : 0;
+
+        /* Anything in the key changed, submit what's batched so far */
+        if(!i || draw.key != previousKey) {
+            submitBatch();
+
+            if(_layerCallback && (!i || draw.key >> LayerShift != previousKey >> LayerShift))
+                _layerCallback(draw.key >> LayerShift, _layerCallbackUserData);
+
+            /* Bind only if the set differs from the previous one, a draw
+               without any binding set keeps whatever was bound before */
+            const UnsignedInt bindingSet = draw.key & BindingSetMask;
+            if(bindingSet && (!i || bindingSet != (previousKey & BindingSetMask)))
+                applyBindingSet(bindingSet - 1);
+
+            batchShader = _shaders[(draw.key >> ShaderShift) & ((1u << ShaderBits) - 1)];
+        }
+
+        MeshView& mesh = _meshViews[draw.index];
+
+        /* Instanced draws can't be merged, submit them directly */
+        if(mesh.instanceCount() != 1) {
+            submitBatch();
+            batchShader->draw(mesh);
+            ++submissionCount;
+            continue;
+        }
+
+        arrayAppend(_batch, mesh);
+    }
+
+    submitBatch();
+    clear();
+    return submissionCount;
+}
+
+DrawList& DrawList::clear() {
+    arrayResize(_draws, NoInit, 0);
+    arrayResize(_meshViews, NoInit, 0);
+    arrayResize(_shaders, NoInit, 0);
+    _shaderIds.clear();
+    _meshIds.clear();
+    return *this;
+}
+
+}}
@@ -0,0 +1,248 @@
+#ifndef Magnum_GL_DrawList_h
+#define Magnum_GL_DrawList_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::GL::DrawList
+ * @m_since_latest
+ */
+
+#include <unordered_map>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Reference.h>
+#include <Corrade/Containers/Triple.h>
+
+#include "Magnum/GL/GL.h"
+#include "Magnum/GL/OpenGL.h"
+#include "Magnum/GL/visibility.h"
+
+namespace Magnum { namespace GL {
+
+/**
+@brief Sorted list of draws
+@m_since_latest
+
+Records draws together with the state they need and submits them sorted to
+minimize shader program, mesh and texture switches. Meant for scenes with a
+large amount of draws, where submitting in application order results in a
+lot of redundant state changes.
+
+@section GL-DrawList-usage Usage
+
+Textures and uniform buffer ranges shared by a group of draws, such as a
+material, are registered upfront with @ref addBindingSet(), which returns an
+ID to be passed to @ref add() together with the shader, mesh view and an
+optional layer. The @ref flush() then sorts the recorded draws and submits
+them:
+
+@snippet MagnumGL.cpp DrawList-usage
+
+Draws are sorted by the layer first, then by the shader, then by the mesh
+and then by the binding set. Draws that end up with everything equal keep
+the order in which they were added. The layer is meant for state that has
+to be applied in a fixed order, such as opaque geometry being drawn before
+transparent. The callback set with @ref setLayerCallback() is called each
+time the layer changes during @ref flush(). It can for example change
+@ref Renderer features or blend functions there.
+
+Consecutive non-instanced draws with the same shader, mesh, binding set and
+layer are merged into a single
+@ref AbstractShaderProgram::draw(Containers::ArrayView<const Containers::Reference<MeshView>>)
+call, which on platforms supporting multi-draw results in a single GL
+command. Instanced draws are submitted one by one. Rendering state is only
+changed when it differs from the previous draw, and the GL state tracker
+additionally skips bindings that are already active.
+
+@section GL-DrawList-limits Limitations
+
+The sort key is packed into 64 bits, so at most 256 layers, 65536 distinct
+shaders and 1048576 distinct meshes can be used in a single @ref flush() and
+at most 1048575 binding sets can be registered. Uniform values set directly
+on the shader aren't tracked by the list, per-draw data are expected to be
+supplied through the binding sets or through data indexed in the shader,
+for example by @glsl gl_DrawID @ce.
+
+The shaders, meshes, textures and buffers are referenced, not copied, and
+have to stay alive until the draws using them are flushed. Binding sets
+are kept across @ref flush() calls, so they can be registered once and
+reused for every frame.
+*/
+class MAGNUM_GL_EXPORT DrawList {
+    public:
+        /**
+         * @brief Layer callback
+         *
+         * Called with the layer index and the user data pointer passed to
+         * @ref setLayerCallback().
+         */
+        typedef void(*LayerCallback)(UnsignedInt, void*);
+
+        /**
+         * @brief Constructor
+         *
+         * Doesn't create any OpenGL object, so it can be safely used even
+         * without any OpenGL context being active.
+         */
+        explicit DrawList();
+
+        /** @brief Copying is not allowed */
+        DrawList(const DrawList&) = delete;
+
+        /** @brief Move constructor */
+        DrawList(DrawList&&) noexcept;
+
+        ~DrawList();
+
+        /** @brief Copying is not allowed */
+        DrawList& operator=(const DrawList&) = delete;
+
+        /** @brief Move assignment */
+        DrawList& operator=(DrawList&&) noexcept;
+
+        /** @brief Count of draws recorded since the last @ref flush() */
+        std::size_t drawCount() const { return _draws.size(); }
+
+        /** @brief Count of registered binding sets */
+        UnsignedInt bindingSetCount() const { return _bindingSets.size(); }
+
+        /**
+         * @brief Add a binding set
+         * @param firstTextureUnit  First texture unit
+         * @param textures          Textures to bind to consecutive texture
+         *      units starting at @p firstTextureUnit. If any texture is
+         *      @cpp nullptr @ce, given texture unit is unbound.
+         * @return ID to be passed to @ref add()
+         *
+         * The textures are bound using
+         * @ref AbstractTexture::bind(Int, Containers::ArrayView<AbstractTexture* const>)
+         * when drawing with this binding set. The IDs are allocated
+         * sequentially from @cpp 0 @ce.
+         */
+        UnsignedInt addBindingSet(Int firstTextureUnit, Containers::ArrayView<AbstractTexture* const> textures);
+
+        /** @overload */
+        UnsignedInt addBindingSet(Int firstTextureUnit, std::initializer_list<AbstractTexture*> textures);
+
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Add a binding set with uniform buffer ranges
+         * @param firstTextureUnit      First texture unit
+         * @param textures              Textures to bind to consecutive
+         *      texture units starting at @p firstTextureUnit
+         * @param firstUniformBinding   First uniform buffer binding
+         * @param uniformBuffers        Buffer, offset and size to bind to
+         *      consecutive uniform buffer bindings starting at
+         *      @p firstUniformBinding. If any buffer is @cpp nullptr @ce,
+         *      given binding is unbound.
+         * @return ID to be passed to @ref add()
+         *
+         * In addition to @ref addBindingSet(Int, Containers::ArrayView<AbstractTexture* const>)
+         * binds the uniform buffer ranges using
+         * @ref Buffer::bind(Buffer::Target, UnsignedInt, GLintptr, GLsizeiptr)
+         * with @ref Buffer::Target::Uniform. The offsets are expected to
+         * respect @ref Buffer::uniformOffsetAlignment().
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        UnsignedInt addBindingSet(Int firstTextureUnit, Containers::ArrayView<AbstractTexture* const> textures, UnsignedInt firstUniformBinding, Containers::ArrayView<const Containers::Triple<Buffer*, GLintptr, GLsizeiptr>> uniformBuffers);
+
+        /** @overload */
+        UnsignedInt addBindingSet(Int firstTextureUnit, std::initializer_list<AbstractTexture*> textures, UnsignedInt firstUniformBinding, std::initializer_list<Containers::Triple<Buffer*, GLintptr, GLsizeiptr>> uniformBuffers);
+        #endif
+
+        /**
+         * @brief Set layer callback
+         * @return Reference to self (for method chaining)
+         *
+         * The @p callback is called during @ref flush() before the first
+         * draw of each layer, including layer @cpp 0 @ce. Pass
+         * @cpp nullptr @ce to reset it.
+         */
+        DrawList& setLayerCallback(LayerCallback callback, void* userData = nullptr);
+
+        /**
+         * @brief Add a draw
+         * @param shader        Shader to draw with
+         * @param mesh          Mesh view to draw
+         * @param bindingSet    Binding set ID returned from
+         *      @ref addBindingSet() or @cpp ~UnsignedInt{} @ce if the draw
+         *      doesn't need any bindings
+         * @param layer         Layer, expected to be less than
+         *      @cpp 256 @ce
+         * @return Reference to self (for method chaining)
+         *
+         * The @p mesh view is copied, the mesh it references and the
+         * @p shader are expected to stay alive until the next @ref flush()
+         * or @ref clear().
+         */
+        DrawList& add(AbstractShaderProgram& shader, const MeshView& mesh, UnsignedInt bindingSet = ~UnsignedInt{}, UnsignedInt layer = 0);
+
+        /**
+         * @brief Sort and submit all recorded draws
+         * @return Count of draw submissions
+         *
+         * Sorts the draws as described in the
+         * @ref GL-DrawList-usage "class documentation", submits them and
+         * clears the list. The returned value is the count of
+         * @ref AbstractShaderProgram::draw() calls, i.e. including the
+         * merged ones.
+         */
+        std::size_t flush();
+
+        /**
+         * @brief Clear recorded draws without submitting them
+         * @return Reference to self (for method chaining)
+         *
+         * Registered binding sets are kept.
+         */
+        DrawList& clear();
+
+    private:
+        struct Draw;
+        struct BindingSet;
+
+        MAGNUM_GL_LOCAL void applyBindingSet(UnsignedInt id);
+
+        Containers::Array<Draw> _draws;
+        Containers::Array<MeshView> _meshViews;
+        Containers::Array<AbstractShaderProgram*> _shaders;
+        std::unordered_map<const AbstractShaderProgram*, UnsignedInt> _shaderIds;
+        std::unordered_map<const Mesh*, UnsignedInt> _meshIds;
+        Containers::Array<BindingSet> _bindingSets;
+        Containers::Array<AbstractTexture*> _textures;
+        #ifndef MAGNUM_TARGET_GLES2
+        Containers::Array<Containers::Triple<Buffer*, GLintptr, GLsizeiptr>> _uniformBuffers;
+        #endif
+        Containers::Array<Containers::Reference<MeshView>> _batch;
+        LayerCallback _layerCallback;
+        void* _layerCallbackUserData;
+};
+
+}}
+
+#endif
@@ -215,10 +215,14 @@ Framebuffer& Framebuffer::mapForRead(const ColorAttachment attachment) {
 }
 
 void Framebuffer::invalidate(std::initializer_list<InvalidationAttachment> attachments) {
+    invalidate(Containers::arrayView(attachments));
+}
+
+void Framebuffer::invalidate(const Containers::ArrayView<const InvalidationAttachment> attachments) {
     /** @todo C++14: use VLA to avoid heap allocation */
     Containers::Array<GLenum> _attachments(attachments.size());
     for(std::size_t i = 0; i != attachments.size(); ++i)
-        _attachments[i] = GLenum(*(attachments.begin()+i));
+        _attachments[i] = GLenum(attachments[i]);
 
     (this->*Context::current().state().framebuffer.invalidateImplementation)(attachments.size(), _attachments);
 }
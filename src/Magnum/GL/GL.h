@@ -66,10 +66,13 @@ class AbstractTexture;
 
 template<UnsignedInt, class> class Attribute;
 
+class BlendState;
 enum class BufferUsage: GLenum;
 class Buffer;
 
 #ifndef MAGNUM_TARGET_GLES2
+class BufferHeap;
+
 template<UnsignedInt> class BufferImage;
 typedef BufferImage<1> BufferImage1D;
 typedef BufferImage<2> BufferImage2D;
@@ -86,7 +89,9 @@ class BufferTexture;
 enum class BufferTextureFormat: GLenum;
 #endif
 
+class CommandRecorder;
 class Context;
+enum class ContextCounter: UnsignedInt;
 
 class CubeMapTexture;
 enum class CubeMapCoordinate: GLenum;
@@ -96,7 +101,9 @@ class CubeMapTextureArray;
 
 /* DebugOutput, DebugMessage, DebugGroup used only statically */
 /* DefaultFramebuffer is available only through global instance */
+class DepthStencilState;
 /* DimensionTraits forward declaration is not needed */
+class DrawList;
 
 class Extension;
 class Framebuffer;
@@ -106,6 +113,10 @@ enum class ImageFormat: GLenum;
 enum class ImageAccess: GLenum;
 #endif
 
+class MemoryUsage;
+enum class MemoryUsageCategory: UnsignedByte;
+struct MemoryUsageEntry;
+
 enum class MeshPrimitive: GLenum;
 enum class MeshIndexType: GLenum;
 
@@ -135,6 +146,9 @@ class PrimitiveQuery;
 class SampleQuery;
 #endif
 class TimeQuery;
+class TimerQueryPool;
+
+class RasterState;
 
 #ifndef MAGNUM_TARGET_GLES
 class RectangleTexture;
@@ -143,6 +157,12 @@ class RectangleTexture;
 class Renderbuffer;
 enum class RenderbufferFormat: GLenum;
 
+#ifndef MAGNUM_TARGET_GLES2
+class RenderPass;
+enum class RenderPassLoad: UnsignedByte;
+enum class RenderPassStore: UnsignedByte;
+#endif
+
 enum class SamplerFilter: GLint;
 enum class SamplerMipmap: GLint;
 enum class SamplerWrapping: GLint;
@@ -157,6 +177,11 @@ enum class SamplerDepthStencilMode: GLenum;
 class Sampler;
 class Shader;
 
+#ifndef MAGNUM_TARGET_GLES
+class SparseTextureResidency;
+class StreamingBuffer;
+#endif
+
 template<UnsignedInt> class Texture;
 #ifndef MAGNUM_TARGET_GLES
 typedef Texture<1> Texture1D;
@@ -176,7 +201,12 @@ typedef TextureArray<2> Texture2DArray;
 
 enum class TextureFormat: GLenum;
 
+#ifndef MAGNUM_TARGET_GLES
+class TextureUploader;
+#endif
+
 #ifndef MAGNUM_TARGET_GLES2
+class TextureStreamer;
 class TransformFeedback;
 #endif
 
@@ -52,7 +52,10 @@ const Buffer::TargetHint BufferState::targetForIndex[] = {
     Buffer::TargetHint::DispatchIndirect,
     Buffer::TargetHint::DrawIndirect,
     Buffer::TargetHint::ShaderStorage,
-    Buffer::TargetHint::Texture
+    Buffer::TargetHint::Texture,
+    #ifndef MAGNUM_TARGET_GLES
+    Buffer::TargetHint::Parameter
+    #endif
     #endif
     #endif
 };
@@ -75,6 +78,9 @@ std::size_t BufferState::indexForTarget(Buffer::TargetHint target) {
         case Buffer::TargetHint::ShaderStorage:     return 12;
         case Buffer::TargetHint::Texture:           return 13;
         #endif
+        #ifndef MAGNUM_TARGET_GLES
+        case Buffer::TargetHint::Parameter:         return 14;
+        #endif
         #endif
     }
 
@@ -83,6 +89,7 @@ std::size_t BufferState::indexForTarget(Buffer::TargetHint target) {
 
 BufferState::BufferState(Context& context, Containers::StaticArrayView<Implementation::ExtensionCount, const char*> extensions): bindings()
     #ifndef MAGNUM_TARGET_GLES2
+    , uniformBindings()
     #ifndef MAGNUM_TARGET_GLES
     , minMapAlignment(0)
     #endif
@@ -211,6 +218,9 @@ BufferState::BufferState(Context& context, Containers::StaticArrayView<Implement
 
 void BufferState::reset() {
     for(GLuint& i: bindings) i = State::DisengagedBinding;
+    #ifndef MAGNUM_TARGET_GLES2
+    for(IndexedBinding& i: uniformBindings) i.id = State::DisengagedBinding;
+    #endif
 }
 
 }}}
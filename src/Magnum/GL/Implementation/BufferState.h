@@ -32,7 +32,9 @@ namespace Magnum { namespace GL { namespace Implementation {
 
 struct BufferState {
     enum: std::size_t {
-        #ifndef MAGNUM_TARGET_WEBGL
+        #ifndef MAGNUM_TARGET_GLES
+        TargetCount = 14+1
+        #elif !defined(MAGNUM_TARGET_WEBGL)
         TargetCount = 13+1
         #elif !defined(MAGNUM_TARGET_GLES2) && defined(MAGNUM_TARGET_WEBGL)
         TargetCount = 8+1
@@ -77,6 +79,25 @@ struct BufferState {
     /* Currently bound buffer for all targets */
     GLuint bindings[TargetCount];
 
+    #ifndef MAGNUM_TARGET_GLES2
+    /* Buffers bound to the first few indexed uniform buffer binding points,
+       so shaders rebinding the same range for every draw don't result in
+       redundant glBindBufferRange() calls, which are especially costly on
+       WebGL. Size of -1 means the whole buffer is bound. Binding points
+       above the count are not tracked. 24 is the minimum of
+       GL_MAX_UNIFORM_BUFFER_BINDINGS on ES3 and WebGL 2. */
+    enum: std::size_t { UniformBindingCount = 24 };
+    struct IndexedBinding {
+        GLuint id;
+        GLintptr offset;
+        GLsizeiptr size;
+    } uniformBindings[UniformBindingCount];
+    #endif
+
+    /* Exposed through Context::counter(), reset in Context::resetCounters() */
+    UnsignedLong uploadCount{},
+        uploadSize{};
+
     /* Limits */
     #ifndef MAGNUM_TARGET_GLES2
     GLint
@@ -0,0 +1,70 @@
+#ifndef Magnum_GL_Implementation_MemoryUsageState_h
+#define Magnum_GL_Implementation_MemoryUsageState_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <unordered_map>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/String.h>
+
+#include "Magnum/GL/MemoryUsage.h"
+
+namespace Magnum { namespace GL { namespace Implementation {
+
+/* Allocated by MemoryUsage::setTrackingEnabled() and owned by the Context.
+   Not a part of the State, as that one is required to be trivially
+   destructible on ES. */
+struct MemoryUsageState {
+    struct Object {
+        std::size_t size;
+        /* Sizes of texture levels (times six faces for cube maps) specified
+           with setImage(), empty if the size was specified at once */
+        Containers::Array<std::size_t> slices;
+        Containers::String label;
+    };
+
+    static UnsignedLong key(MemoryUsageCategory category, GLuint id) {
+        return UnsignedLong(category) << 32 | id;
+    }
+
+    std::unordered_map<UnsignedLong, Object> objects;
+    std::size_t totals[3]{};
+    std::size_t counts[3]{};
+};
+
+/* All these are no-ops if the tracking isn't enabled for current context */
+void memoryUsageSet(MemoryUsageCategory category, GLuint id, std::size_t size);
+void memoryUsageSetSlice(MemoryUsageCategory category, GLuint id, std::size_t slice, std::size_t size);
+void memoryUsageLabel(MemoryUsageCategory category, GLuint id, Containers::StringView label);
+void memoryUsageRemove(MemoryUsageCategory category, GLuint id);
+
+/* Defined in PixelFormat.cpp. Data size of an image in given internal
+   format. Formats that don't have a generic equivalent are assumed to be four
+   bytes per pixel. */
+std::size_t textureFormatDataSize(GLenum format, const Vector3i& size);
+
+}}}
+
+#endif
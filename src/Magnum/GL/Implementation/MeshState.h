@@ -103,6 +103,9 @@ struct MeshState {
     #endif
 
     GLuint currentVAO;
+
+    /* Exposed through Context::counter(), reset in Context::resetCounters() */
+    UnsignedLong drawCount{};
     #if !defined(MAGNUM_TARGET_WEBGL) && !defined(MAGNUM_TARGET_GLES2)
     GLint maxVertexAttributeStride{};
     #endif
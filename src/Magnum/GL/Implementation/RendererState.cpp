@@ -195,6 +195,10 @@ RendererState::RendererState(Context& context, ContextState& contextState, Conta
     #endif
 }
 
+void RendererState::reset() {
+    blendEngaged = depthStencilEngaged = rasterEngaged = false;
+}
+
 RendererState::PixelStorage::PixelStorage():
     alignment{4}
     #if !(defined(MAGNUM_TARGET_GLES2) && defined(MAGNUM_TARGET_WEBGL))
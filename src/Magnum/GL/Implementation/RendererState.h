@@ -26,6 +26,7 @@
 */
 
 #include "Magnum/GL/Renderer.h"
+#include "Magnum/GL/RenderStates.h"
 #include "Magnum/Math/Range.h"
 
 namespace Magnum { namespace GL { namespace Implementation {
@@ -35,6 +36,8 @@ struct ContextState;
 struct RendererState {
     explicit RendererState(Context& context, ContextState& contextState, Containers::StaticArrayView<Implementation::ExtensionCount, const char*> extensions);
 
+    void reset();
+
     Range1D(*lineWidthRangeImplementation)();
     void(*clearDepthfImplementation)(GLfloat);
     #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
@@ -97,6 +100,14 @@ struct RendererState {
     GLint maxCullDistances{}, maxCombinedClipAndCullDistances{};
     #endif
 
+    /* State blocks applied last by Renderer::apply(), valid only if the
+       corresponding *Engaged flag is set. Renderer APIs touching the same GL
+       state clear the flag so the next apply() sets the whole block again. */
+    BlendState blend;
+    DepthStencilState depthStencil;
+    RasterState raster;
+    bool blendEngaged{}, depthStencilEngaged{}, rasterEngaged{};
+
     /* Bool parameter is ugly, but this is implementation detail of internal
        API so who cares */
     void applyPixelStorageInternal(const Magnum::PixelStorage& storage, bool unpack);
@@ -25,6 +25,7 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <Corrade/Containers/String.h>
 #include <Corrade/Utility/StlForwardString.h>
 
 #include "Magnum/Magnum.h"
@@ -97,6 +98,15 @@ struct ShaderProgramState {
     /* Currently used program */
     GLuint current;
 
+    /* Exposed through Context::counter(), reset in Context::resetCounters() */
+    UnsignedLong switchCount{},
+        dispatchCount{};
+
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    /* Program binary cache directory, empty if disabled */
+    Containers::String binaryCacheDirectory;
+    #endif
+
     GLint maxVertexAttributes;
     #ifndef MAGNUM_TARGET_GLES2
     #ifndef MAGNUM_TARGET_WEBGL
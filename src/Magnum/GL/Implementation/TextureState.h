@@ -172,6 +172,8 @@ struct TextureState {
     #endif
     GLfloat maxMaxAnisotropy;
     GLint currentTextureUnit;
+    /* Exposed through Context::counter(), reset in Context::resetCounters() */
+    UnsignedLong bindCount{};
     #ifndef MAGNUM_TARGET_GLES2
     GLint maxColorSamples,
         maxDepthSamples,
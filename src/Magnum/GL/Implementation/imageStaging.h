@@ -0,0 +1,72 @@
+#ifndef Magnum_GL_Implementation_imageStaging_h
+#define Magnum_GL_Implementation_imageStaging_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/configure.h"
+
+#ifndef MAGNUM_TARGET_GLES2
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Algorithms.h>
+
+#include "Magnum/GL/Buffer.h"
+
+namespace Magnum { namespace GL { namespace Implementation {
+
+/* Copies data of all images into the buffer, each starting at a four-byte
+   aligned offset, and returns the offsets. The buffer is reallocated, which
+   orphans its previous contents so the driver doesn't need to wait for
+   uploads still sourcing from it, and then mapped just once. Works for both
+   uncompressed and compressed image views. */
+template<class T> Containers::Array<std::size_t> stageImageData(Buffer& buffer, const Containers::ArrayView<const T> images) {
+    Containers::Array<std::size_t> offsets{NoInit, images.size()};
+    std::size_t size = 0;
+    for(std::size_t i = 0; i != images.size(); ++i) {
+        offsets[i] = size;
+        size += (images[i].data().size() + 3)/4*4;
+    }
+
+    buffer.setData({nullptr, size}, BufferUsage::StreamDraw);
+    if(!size) return offsets;
+
+    #ifndef MAGNUM_TARGET_WEBGL
+    const Containers::ArrayView<char> out = buffer.map(0, size, Buffer::MapFlag::Write|Buffer::MapFlag::InvalidateBuffer);
+    CORRADE_INTERNAL_ASSERT(out);
+    for(std::size_t i = 0; i != images.size(); ++i)
+        Utility::copy(images[i].data(), out.slice(offsets[i], offsets[i] + images[i].data().size()));
+    buffer.unmap();
+    #else
+    /* No buffer mapping in WebGL, upload each image separately */
+    for(std::size_t i = 0; i != images.size(); ++i)
+        buffer.setSubData(offsets[i], images[i].data());
+    #endif
+
+    return offsets;
+}
+
+}}}
+#endif
+
+#endif
@@ -0,0 +1,171 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MemoryUsage.h"
+
+#include <algorithm>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Implementation/MemoryUsageState.h"
+
+namespace Magnum { namespace GL {
+
+Debug& operator<<(Debug& debug, const MemoryUsageCategory value) {
+    debug << "GL::MemoryUsageCategory" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case MemoryUsageCategory::value: return debug << "::" #value;
+        _c(Buffer)
+        _c(Texture)
+        _c(Renderbuffer)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+bool MemoryUsage::isTrackingEnabled() {
+    return !!Context::current().memoryUsageState();
+}
+
+void MemoryUsage::setTrackingEnabled(const bool enabled) {
+    Containers::Pointer<Implementation::MemoryUsageState>& state = Context::current().memoryUsageState();
+    if(!enabled) state = nullptr;
+    else if(!state) state.emplace();
+}
+
+std::size_t MemoryUsage::total() {
+    const Implementation::MemoryUsageState* const state = Context::current().memoryUsageState().get();
+    if(!state) return 0;
+
+    std::size_t out = 0;
+    for(const std::size_t total: state->totals) out += total;
+    return out;
+}
+
+std::size_t MemoryUsage::total(const MemoryUsageCategory category) {
+    const Implementation::MemoryUsageState* const state = Context::current().memoryUsageState().get();
+    return state ? state->totals[UnsignedByte(category)] : 0;
+}
+
+std::size_t MemoryUsage::objectCount(const MemoryUsageCategory category) {
+    const Implementation::MemoryUsageState* const state = Context::current().memoryUsageState().get();
+    return state ? state->counts[UnsignedByte(category)] : 0;
+}
+
+Containers::Array<MemoryUsageEntry> MemoryUsage::entries() {
+    const Implementation::MemoryUsageState* const state = Context::current().memoryUsageState().get();
+    if(!state) return {};
+
+    Containers::Array<MemoryUsageEntry> out{state->objects.size()};
+    std::size_t i = 0;
+    for(const auto& object: state->objects) {
+        out[i].category = MemoryUsageCategory(object.first >> 32);
+        out[i].id = GLuint(object.first & 0xffffffffu);
+        out[i].size = object.second.size;
+        out[i].label = object.second.label;
+        ++i;
+    }
+
+    /* Largest first, equal sizes ordered by category and ID so the output
+       doesn't depend on the hash map iteration order */
+    std::sort(out.begin(), out.end(), [](const MemoryUsageEntry& a, const MemoryUsageEntry& b) {
+        if(a.size != b.size) return a.size > b.size;
+        if(a.category != b.category) return a.category < b.category;
+        return a.id < b.id;
+    });
+
+    return out;
+}
+
+namespace Implementation {
+
+namespace {
+
+MemoryUsageState::Object& object(MemoryUsageState& state, const MemoryUsageCategory category, const GLuint id) {
+    const auto inserted = state.objects.emplace(MemoryUsageState::key(category, id), MemoryUsageState::Object{});
+    if(inserted.second) ++state.counts[UnsignedByte(category)];
+    return inserted.first->second;
+}
+
+}
+
+void memoryUsageSet(const MemoryUsageCategory category, const GLuint id, const std::size_t size) {
+    MemoryUsageState* const state = Context::current().memoryUsageState().get();
+    if(!state) return;
+
+    MemoryUsageState::Object& o = object(*state, category, id);
+    state->totals[UnsignedByte(category)] += size - o.size;
+    o.size = size;
+    o.slices = {};
+}
+
+void memoryUsageSetSlice(const MemoryUsageCategory category, const GLuint id, const std::size_t slice, const std::size_t size) {
+    MemoryUsageState* const state = Context::current().memoryUsageState().get();
+    if(!state) return;
+
+    MemoryUsageState::Object& o = object(*state, category, id);
+
+    /* If the size was previously specified at once, discard it */
+    if(o.slices.isEmpty()) {
+        state->totals[UnsignedByte(category)] -= o.size;
+        o.size = 0;
+    }
+
+    if(o.slices.size() <= slice)
+        arrayResize(o.slices, ValueInit, slice + 1);
+
+    state->totals[UnsignedByte(category)] += size - o.slices[slice];
+    o.size += size - o.slices[slice];
+    o.slices[slice] = size;
+}
+
+void memoryUsageLabel(const MemoryUsageCategory category, const GLuint id, const Containers::StringView label) {
+    MemoryUsageState* const state = Context::current().memoryUsageState().get();
+    if(!state) return;
+
+    object(*state, category, id).label = Containers::String{label};
+}
+
+void memoryUsageRemove(const MemoryUsageCategory category, const GLuint id) {
+    MemoryUsageState* const state = Context::current().memoryUsageState().get();
+    if(!state) return;
+
+    const auto found = state->objects.find(MemoryUsageState::key(category, id));
+    if(found == state->objects.end()) return;
+
+    state->totals[UnsignedByte(category)] -= found->second.size;
+    --state->counts[UnsignedByte(category)];
+    state->objects.erase(found);
+}
+
+}
+
+}}
@@ -0,0 +1,184 @@
+#ifndef Magnum_GL_MemoryUsage_h
+#define Magnum_GL_MemoryUsage_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::GL::MemoryUsage, struct @ref Magnum::GL::MemoryUsageEntry, enum @ref Magnum::GL::MemoryUsageCategory
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/String.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/GL/OpenGL.h"
+#include "Magnum/GL/visibility.h"
+
+namespace Magnum { namespace GL {
+
+/**
+@brief GPU memory usage category
+@m_since_latest
+
+@see @ref MemoryUsage::total(MemoryUsageCategory)
+*/
+enum class MemoryUsageCategory: UnsignedByte {
+    /** @ref Buffer data */
+    Buffer,
+
+    /** Texture storage and images of all texture types */
+    Texture,
+
+    /** @ref Renderbuffer storage */
+    Renderbuffer
+};
+
+/**
+@debugoperatorenum{MemoryUsageCategory}
+@m_since_latest
+*/
+MAGNUM_GL_EXPORT Debug& operator<<(Debug& debug, MemoryUsageCategory value);
+
+/**
+@brief GPU memory usage entry
+@m_since_latest
+
+@see @ref MemoryUsage::entries()
+*/
+struct MemoryUsageEntry {
+    /** @brief Object category */
+    MemoryUsageCategory category;
+
+    /** @brief OpenGL object ID */
+    GLuint id;
+
+    /** @brief Size in bytes */
+    std::size_t size;
+
+    /**
+     * @brief Object label
+     *
+     * Label set with @ref Buffer::setLabel(),
+     * @ref AbstractTexture::setLabel() or @ref Renderbuffer::setLabel() while
+     * the tracking was enabled, empty otherwise.
+     */
+    Containers::String label;
+};
+
+/**
+@brief GPU memory usage tracking
+@m_since_latest
+
+OpenGL doesn't provide any portable way to query how much memory is used by
+which object. This class optionally keeps track of data sizes passed to
+@ref Buffer::setData(), @ref Buffer::setStorage(), texture
+@relativeref{Texture,setStorage()}, @relativeref{Texture,setImage()} and
+@relativeref{Texture,setCompressedImage()} and to
+@ref Renderbuffer::setStorage() for the current context, providing totals,
+per-category breakdowns and a list of all objects together with their labels:
+
+@snippet MagnumGL.cpp MemoryUsage-usage
+
+The tracking is disabled by default and has to be enabled with
+@ref setTrackingEnabled(). While disabled, the only overhead is a single
+pointer check in each of the above functions. Only operations done while the
+tracking is enabled are accounted for. The values can be also fed into a
+@ref DebugTools::FrameProfiler using
+@ref DebugTools::memoryUsageMeasurement().
+
+@section GL-MemoryUsage-accuracy Accuracy
+
+The numbers are what the application requested, not what the driver actually
+allocated --- drivers usually add alignment padding, may keep shadow copies
+of the data or lazily allocate just the levels that were written to. Sizes of
+uncompressed texture formats are calculated from an equivalent generic
+@ref Magnum::PixelFormat, compressed formats from the block properties of an
+equivalent @ref Magnum::CompressedPixelFormat. Formats that have no generic
+equivalent, such as @ref TextureFormat::RGB565 or unsized formats on
+OpenGL ES 2.0, are assumed to take four bytes per pixel.
+
+Objects are removed from the accounting when they're destroyed. Objects that
+were wrapped without @ref ObjectFlag::DeleteOnDestruction or released with
+@relativeref{Buffer,release()} are not deleted by Magnum and thus stay
+accounted for, as their memory is still in use.
+*/
+class MAGNUM_GL_EXPORT MemoryUsage {
+    public:
+        /**
+         * @brief Whether the tracking is enabled for current context
+         *
+         * Expects that a @ref Context is current.
+         */
+        static bool isTrackingEnabled();
+
+        /**
+         * @brief Enable or disable the tracking for current context
+         *
+         * Disabling the tracking discards all recorded data. Enabling it
+         * again starts from zero, objects that already have data aren't
+         * accounted for until their data are specified again. Expects that a
+         * @ref Context is current.
+         */
+        static void setTrackingEnabled(bool enabled);
+
+        /**
+         * @brief Total tracked memory usage
+         *
+         * Sum of sizes of all tracked objects, in bytes. If the tracking is
+         * not enabled, returns @cpp 0 @ce.
+         */
+        static std::size_t total();
+
+        /**
+         * @brief Total tracked memory usage in given category
+         *
+         * If the tracking is not enabled, returns @cpp 0 @ce.
+         */
+        static std::size_t total(MemoryUsageCategory category);
+
+        /**
+         * @brief Count of tracked objects in given category
+         *
+         * Includes also objects that have a label but no data yet. If the
+         * tracking is not enabled, returns @cpp 0 @ce.
+         */
+        static std::size_t objectCount(MemoryUsageCategory category);
+
+        /**
+         * @brief All tracked objects
+         *
+         * Sorted by size, largest first. If the tracking is not enabled,
+         * returns an empty array.
+         */
+        static Containers::Array<MemoryUsageEntry> entries();
+
+        /* Static-only class */
+        MemoryUsage() = delete;
+};
+
+}}
+
+#endif
@@ -962,6 +962,70 @@ void Mesh::drawInternal(TransformFeedback& xfb, const UnsignedInt stream, const
 }
 #endif
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+void Mesh::drawInternalIndirect(Buffer& buffer, const GLintptr offset, const UnsignedInt drawCount, const UnsignedInt stride) {
+    const Implementation::MeshState& state = Context::current().state().mesh;
+
+    (this->*state.bindImplementation)();
+    buffer.bindInternal(Buffer::TargetHint::DrawIndirect);
+
+    #ifndef MAGNUM_TARGET_GLES
+    /* Non-indexed mesh */
+    if(!_indexBuffer.id()) {
+        if(drawCount == 1)
+            glDrawArraysIndirect(GLenum(_primitive), reinterpret_cast<GLvoid*>(offset));
+        else
+            glMultiDrawArraysIndirect(GLenum(_primitive), reinterpret_cast<GLvoid*>(offset), drawCount, stride);
+
+    /* Indexed mesh */
+    } else {
+        if(drawCount == 1)
+            glDrawElementsIndirect(GLenum(_primitive), GLenum(_indexType), reinterpret_cast<GLvoid*>(offset));
+        else
+            glMultiDrawElementsIndirect(GLenum(_primitive), GLenum(_indexType), reinterpret_cast<GLvoid*>(offset), drawCount, stride);
+    }
+    #else
+    /* There's no multi-draw indirect in ES 3.1, emulate it with a sequence
+       of single draws. Commands for indexed meshes have one more field. */
+    const GLintptr actualStride = stride ? stride :
+        (_indexBuffer.id() ? 5 : 4)*sizeof(UnsignedInt);
+    for(UnsignedInt i = 0; i != drawCount; ++i) {
+        const GLintptr commandOffset = offset + i*actualStride;
+
+        /* Non-indexed mesh */
+        if(!_indexBuffer.id())
+            glDrawArraysIndirect(GLenum(_primitive), reinterpret_cast<GLvoid*>(commandOffset));
+
+        /* Indexed mesh */
+        else
+            glDrawElementsIndirect(GLenum(_primitive), GLenum(_indexType), reinterpret_cast<GLvoid*>(commandOffset));
+    }
+    #endif
+
+    (this->*state.unbindImplementation)();
+}
+
+#ifndef MAGNUM_TARGET_GLES
+void Mesh::drawInternalIndirect(Buffer& buffer, const GLintptr offset, Buffer& countBuffer, const GLintptr countOffset, const UnsignedInt maxDrawCount, const UnsignedInt stride) {
+    const Implementation::MeshState& state = Context::current().state().mesh;
+
+    (this->*state.bindImplementation)();
+    buffer.bindInternal(Buffer::TargetHint::DrawIndirect);
+    countBuffer.bindInternal(Buffer::TargetHint::Parameter);
+
+    /* Non-indexed mesh */
+    if(!_indexBuffer.id())
+        glMultiDrawArraysIndirectCount(GLenum(_primitive), reinterpret_cast<GLvoid*>(offset), countOffset, maxDrawCount, stride);
+
+    /* Indexed mesh */
+    else
+        glMultiDrawElementsIndirectCount(GLenum(_primitive), GLenum(_indexType), reinterpret_cast<GLvoid*>(offset), countOffset, maxDrawCount, stride);
+
+    (this->*state.unbindImplementation)();
+}
+#endif
+#endif
+
 #ifdef MAGNUM_BUILD_DEPRECATED
 Mesh& Mesh::draw(AbstractShaderProgram& shader) {
     shader.draw(*this);
@@ -1249,6 +1249,13 @@ class MAGNUM_GL_EXPORT Mesh: public AbstractObject {
         MAGNUM_GL_LOCAL void drawInternal(TransformFeedback& xfb, UnsignedInt stream, Int instanceCount);
         #endif
 
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        MAGNUM_GL_LOCAL void drawInternalIndirect(Buffer& buffer, GLintptr offset, UnsignedInt drawCount, UnsignedInt stride);
+        #ifndef MAGNUM_TARGET_GLES
+        MAGNUM_GL_LOCAL void drawInternalIndirect(Buffer& buffer, GLintptr offset, Buffer& countBuffer, GLintptr countOffset, UnsignedInt maxDrawCount, UnsignedInt stride);
+        #endif
+        #endif
+
         void MAGNUM_GL_LOCAL createImplementationDefault(bool);
         void MAGNUM_GL_LOCAL createImplementationVAO(bool createObject);
         #ifndef MAGNUM_TARGET_GLES
@@ -30,7 +30,9 @@
 #include <Corrade/Utility/Debug.h>
 
 #include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Vector3.h"
 #include "Magnum/GL/TextureFormat.h"
+#include "Magnum/GL/Implementation/MemoryUsageState.h"
 
 namespace Magnum { namespace GL {
 
@@ -578,4 +580,30 @@ Debug& operator<<(Debug& debug, const CompressedPixelFormat value) {
 }
 #endif
 
+namespace Implementation {
+
+std::size_t textureFormatDataSize(const GLenum format, const Vector3i& size) {
+    /* Uncompressed formats, find a generic format that maps to it */
+    for(std::size_t i = 0; i != Containers::arraySize(TextureFormatMapping); ++i) {
+        if(GLenum(TextureFormatMapping[i]) == format)
+            return std::size_t(Magnum::pixelFormatSize(Magnum::PixelFormat(i + 1)))*size.product();
+    }
+
+    /* Compressed formats have the same values as the corresponding texture
+       formats, calculate the size from the block properties */
+    for(std::size_t i = 0; i != Containers::arraySize(CompressedFormatMapping); ++i) {
+        if(GLenum(CompressedFormatMapping[i]) == format) {
+            const Magnum::CompressedPixelFormat compressedFormat = Magnum::CompressedPixelFormat(i + 1);
+            const Vector3i blockSize = compressedPixelFormatBlockSize(compressedFormat);
+            const Vector3i blockCount = (size + blockSize - Vector3i{1})/blockSize;
+            return std::size_t(compressedPixelFormatBlockDataSize(compressedFormat))*blockCount.product();
+        }
+    }
+
+    /* No generic equivalent, assume four bytes per pixel */
+    return std::size_t(4)*size.product();
+}
+
+}
+
 }}
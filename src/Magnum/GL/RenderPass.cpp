@@ -0,0 +1,195 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "RenderPass.h"
+
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/GL/DefaultFramebuffer.h"
+#include "Magnum/GL/Framebuffer.h"
+
+namespace Magnum { namespace GL {
+
+struct RenderPass::ColorAttachment {
+    UnsignedInt location;
+    RenderPassLoad load;
+    RenderPassStore store;
+    Color4 clearColor;
+};
+
+RenderPass::RenderPass(Framebuffer& framebuffer): _framebuffer{&framebuffer}, _defaultFramebuffer{} {}
+
+RenderPass::RenderPass(DefaultFramebuffer& framebuffer): _framebuffer{}, _defaultFramebuffer{&framebuffer} {}
+
+RenderPass::RenderPass(RenderPass&&) noexcept = default;
+
+RenderPass::~RenderPass() = default;
+
+RenderPass& RenderPass::operator=(RenderPass&&) noexcept = default;
+
+RenderPass& RenderPass::setColorAttachment(const UnsignedInt location, const RenderPassLoad load, const RenderPassStore store, const Color4& clearColor) {
+    CORRADE_ASSERT(!_active,
+        "GL::RenderPass::setColorAttachment(): the pass is active", *this);
+    CORRADE_ASSERT(_framebuffer || location == 0,
+        "GL::RenderPass::setColorAttachment(): only location 0 is available for the default framebuffer, got" << location, *this);
+
+    for(ColorAttachment& attachment: _colorAttachments) {
+        if(attachment.location != location) continue;
+        attachment = {location, load, store, clearColor};
+        return *this;
+    }
+
+    arrayAppend(_colorAttachments, InPlaceInit, location, load, store, clearColor);
+    return *this;
+}
+
+RenderPass& RenderPass::setDepthAttachment(const RenderPassLoad load, const RenderPassStore store, const Float clearDepth) {
+    CORRADE_ASSERT(!_active,
+        "GL::RenderPass::setDepthAttachment(): the pass is active", *this);
+    _depthLoad = load;
+    _depthStore = store;
+    _clearDepth = clearDepth;
+    return *this;
+}
+
+RenderPass& RenderPass::setStencilAttachment(const RenderPassLoad load, const RenderPassStore store, const Int clearStencil) {
+    CORRADE_ASSERT(!_active,
+        "GL::RenderPass::setStencilAttachment(): the pass is active", *this);
+    _stencilLoad = load;
+    _stencilStore = store;
+    _clearStencil = clearStencil;
+    return *this;
+}
+
+void RenderPass::invalidate(const bool atEnd) {
+    /* Gather everything that should be invalidated. At most one color
+       attachment per location plus depth and stencil. */
+    const auto shouldInvalidate = [atEnd](const RenderPassLoad load, const RenderPassStore store) {
+        return atEnd ? store == RenderPassStore::DontCare :
+                       load == RenderPassLoad::DontCare;
+    };
+
+    if(_framebuffer) {
+        Containers::Array<Framebuffer::InvalidationAttachment> attachments;
+        for(const ColorAttachment& attachment: _colorAttachments)
+            if(shouldInvalidate(attachment.load, attachment.store))
+                arrayAppend(attachments, Framebuffer::InvalidationAttachment{Framebuffer::ColorAttachment{attachment.location}});
+        if(shouldInvalidate(_depthLoad, _depthStore))
+            arrayAppend(attachments, Framebuffer::InvalidationAttachment::Depth);
+        if(shouldInvalidate(_stencilLoad, _stencilStore))
+            arrayAppend(attachments, Framebuffer::InvalidationAttachment::Stencil);
+
+        if(!attachments.isEmpty()) _framebuffer->invalidate(attachments);
+
+    } else {
+        /* There's at most three attachments, no need to allocate */
+        DefaultFramebuffer::InvalidationAttachment attachments[3];
+        std::size_t count = 0;
+        for(const ColorAttachment& attachment: _colorAttachments)
+            if(shouldInvalidate(attachment.load, attachment.store))
+                attachments[count++] = DefaultFramebuffer::InvalidationAttachment::Color;
+        if(shouldInvalidate(_depthLoad, _depthStore))
+            attachments[count++] = DefaultFramebuffer::InvalidationAttachment::Depth;
+        if(shouldInvalidate(_stencilLoad, _stencilStore))
+            attachments[count++] = DefaultFramebuffer::InvalidationAttachment::Stencil;
+
+        if(count) _defaultFramebuffer->invalidate(Containers::arrayView(attachments).prefix(count));
+    }
+}
+
+RenderPass& RenderPass::begin() {
+    CORRADE_ASSERT(!_active,
+        "GL::RenderPass::begin(): the pass is already active", *this);
+
+    if(_framebuffer) _framebuffer->bind();
+    else _defaultFramebuffer->bind();
+
+    /* Invalidate first so the driver knows the contents don't need to be
+       loaded, then clear what should be cleared */
+    invalidate(false);
+
+    for(const ColorAttachment& attachment: _colorAttachments) {
+        if(attachment.load != RenderPassLoad::Clear) continue;
+        if(_framebuffer)
+            _framebuffer->clearColor(attachment.location, attachment.clearColor);
+        else
+            _defaultFramebuffer->clearColor(attachment.clearColor);
+    }
+
+    AbstractFramebuffer& framebuffer = _framebuffer ?
+        static_cast<AbstractFramebuffer&>(*_framebuffer) :
+        static_cast<AbstractFramebuffer&>(*_defaultFramebuffer);
+    if(_depthLoad == RenderPassLoad::Clear && _stencilLoad == RenderPassLoad::Clear)
+        framebuffer.clearDepthStencil(_clearDepth, _clearStencil);
+    else if(_depthLoad == RenderPassLoad::Clear)
+        framebuffer.clearDepth(_clearDepth);
+    else if(_stencilLoad == RenderPassLoad::Clear)
+        framebuffer.clearStencil(_clearStencil);
+
+    _active = true;
+    return *this;
+}
+
+void RenderPass::end() {
+    CORRADE_ASSERT(_active,
+        "GL::RenderPass::end(): the pass isn't active", );
+
+    invalidate(true);
+    _active = false;
+}
+
+Debug& operator<<(Debug& debug, const RenderPassLoad value) {
+    debug << "GL::RenderPassLoad" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case RenderPassLoad::value: return debug << "::" #value;
+        _c(Load)
+        _c(Clear)
+        _c(DontCare)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+Debug& operator<<(Debug& debug, const RenderPassStore value) {
+    debug << "GL::RenderPassStore" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case RenderPassStore::value: return debug << "::" #value;
+        _c(Store)
+        _c(DontCare)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+}}
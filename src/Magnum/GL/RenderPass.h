@@ -0,0 +1,260 @@
+#ifndef Magnum_GL_RenderPass_h
+#define Magnum_GL_RenderPass_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MAGNUM_TARGET_GLES2
+/** @file
+ * @brief Class @ref Magnum::GL::RenderPass, enum @ref Magnum::GL::RenderPassLoad, @ref Magnum::GL::RenderPassStore
+ * @m_since_latest
+ */
+#endif
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/GL/GL.h"
+#include "Magnum/GL/visibility.h"
+#include "Magnum/Math/Color.h"
+
+#ifndef MAGNUM_TARGET_GLES2
+namespace Magnum { namespace GL {
+
+/**
+@brief Render pass attachment load action
+@m_since_latest
+
+What happens with attachment contents at the start of a @ref RenderPass.
+@see @ref RenderPass::setColorAttachment(),
+    @ref RenderPass::setDepthAttachment(),
+    @ref RenderPass::setStencilAttachment()
+*/
+enum class RenderPassLoad: UnsignedByte {
+    /** Previous contents are preserved. This is what happens with
+     * attachments that aren't described in the pass at all. */
+    Load,
+
+    /** The attachment is cleared to a specified value */
+    Clear,
+
+    /**
+     * Previous contents are not needed and are invalidated. On tiled GPUs
+     * this avoids loading them from memory. The contents are undefined, the
+     * pass is expected to overwrite all pixels.
+     */
+    DontCare
+};
+
+/**
+@debugoperatorenum{RenderPassLoad}
+@m_since_latest
+*/
+MAGNUM_GL_EXPORT Debug& operator<<(Debug& debug, RenderPassLoad value);
+
+/**
+@brief Render pass attachment store action
+@m_since_latest
+
+What happens with attachment contents at the end of a @ref RenderPass.
+@see @ref RenderPass::setColorAttachment(),
+    @ref RenderPass::setDepthAttachment(),
+    @ref RenderPass::setStencilAttachment()
+*/
+enum class RenderPassStore: UnsignedByte {
+    /** Contents are preserved. This is what happens with attachments that
+     * aren't described in the pass at all. */
+    Store,
+
+    /**
+     * Contents are not needed after the pass and are invalidated. On tiled
+     * GPUs this avoids writing them back to memory.
+     */
+    DontCare
+};
+
+/**
+@debugoperatorenum{RenderPassStore}
+@m_since_latest
+*/
+MAGNUM_GL_EXPORT Debug& operator<<(Debug& debug, RenderPassStore value);
+
+/**
+@brief Render pass with attachment load and store actions
+@m_since_latest
+
+Tiled GPUs, common on mobile, render into small on-chip tiles and have to load
+the previous framebuffer contents from memory at the start of a pass and write
+them back at the end. Unless told otherwise via @ref Framebuffer::invalidate()
+or a clear, they do that for every attachment, even for depth and stencil
+buffers that are never used after the pass. This class describes what should
+happen with each attachment at the start and the end of a pass and issues the
+clears and invalidations automatically:
+
+@snippet MagnumGL.cpp RenderPass-usage
+
+In @ref begin() the framebuffer is bound for drawing, attachments with
+@ref RenderPassLoad::DontCare are invalidated and attachments with
+@ref RenderPassLoad::Clear are cleared to the value specified for them. In
+@ref end() all attachments with @ref RenderPassStore::DontCare are
+invalidated. Attachments that aren't described are left untouched.
+
+The pass can be begun and ended any number of times, typically once per
+frame. The clears are affected by the current write masks and scissor, same as
+@ref Framebuffer::clearColor() and @ref AbstractFramebuffer::clearDepth()
+"clearDepth()". If invalidation isn't supported by the driver, it's silently
+skipped, which affects only performance, not correctness.
+
+@section GL-RenderPass-color-attachments Color attachment locations
+
+Color attachments are specified using their draw buffer location. For a
+@ref Framebuffer the pass assumes the location @cpp i @ce corresponds to
+@ref Framebuffer::ColorAttachment "Framebuffer::ColorAttachment{i}", which is
+the default mapping unless @ref Framebuffer::mapForDraw() is called with
+something else. For the @ref DefaultFramebuffer only location @cpp 0 @ce is
+accepted.
+
+@requires_gl30 Direct framebuffer clearing is not available in OpenGL 2.1.
+@requires_gles30 Direct framebuffer clearing is not available in OpenGL ES
+    2.0 or WebGL 1.0.
+*/
+class MAGNUM_GL_EXPORT RenderPass {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * The framebuffer is expected to stay alive for the whole lifetime of
+         * the pass. No GL calls are made until @ref begin().
+         */
+        explicit RenderPass(Framebuffer& framebuffer);
+
+        /** @overload */
+        explicit RenderPass(DefaultFramebuffer& framebuffer);
+
+        /** @brief Copying is not allowed */
+        RenderPass(const RenderPass&) = delete;
+
+        /** @brief Move constructor */
+        RenderPass(RenderPass&&) noexcept;
+
+        ~RenderPass();
+
+        /** @brief Copying is not allowed */
+        RenderPass& operator=(const RenderPass&) = delete;
+
+        /** @brief Move assignment */
+        RenderPass& operator=(RenderPass&&) noexcept;
+
+        /**
+         * @brief Describe a color attachment
+         * @param location      Draw buffer location, see
+         *      @ref GL-RenderPass-color-attachments
+         * @param load          Load action
+         * @param store         Store action
+         * @param clearColor    Color to clear with if @p load is
+         *      @ref RenderPassLoad::Clear, ignored otherwise
+         * @return Reference to self (for method chaining)
+         *
+         * Calling this function again for the same location replaces the
+         * previous description. Expects that the pass isn't active.
+         */
+        RenderPass& setColorAttachment(UnsignedInt location, RenderPassLoad load, RenderPassStore store, const Color4& clearColor = {});
+
+        /**
+         * @brief Describe the depth attachment
+         * @param load          Load action
+         * @param store         Store action
+         * @param clearDepth    Depth value to clear with if @p load is
+         *      @ref RenderPassLoad::Clear, ignored otherwise
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that the pass isn't active.
+         */
+        RenderPass& setDepthAttachment(RenderPassLoad load, RenderPassStore store, Float clearDepth = 1.0f);
+
+        /**
+         * @brief Describe the stencil attachment
+         * @param load          Load action
+         * @param store         Store action
+         * @param clearStencil  Stencil value to clear with if @p load is
+         *      @ref RenderPassLoad::Clear, ignored otherwise
+         * @return Reference to self (for method chaining)
+         *
+         * If both depth and stencil are cleared, a single
+         * @ref AbstractFramebuffer::clearDepthStencil() "clearDepthStencil()"
+         * call is made for both. Expects that the pass isn't active.
+         */
+        RenderPass& setStencilAttachment(RenderPassLoad load, RenderPassStore store, Int clearStencil = 0);
+
+        /** @brief Whether the pass is active */
+        bool isActive() const { return _active; }
+
+        /**
+         * @brief Begin the pass
+         * @return Reference to self (for method chaining)
+         *
+         * Binds the framebuffer for drawing, invalidates attachments with
+         * @ref RenderPassLoad::DontCare and clears attachments with
+         * @ref RenderPassLoad::Clear. Expects that the pass isn't already
+         * active.
+         * @see @ref Framebuffer::bind(), @ref Framebuffer::invalidate(),
+         *      @ref Framebuffer::clearColor(),
+         *      @ref AbstractFramebuffer::clearDepth(),
+         *      @ref AbstractFramebuffer::clearStencil(),
+         *      @ref AbstractFramebuffer::clearDepthStencil()
+         */
+        RenderPass& begin();
+
+        /**
+         * @brief End the pass
+         *
+         * Invalidates attachments with @ref RenderPassStore::DontCare.
+         * Expects that the pass is active.
+         * @see @ref Framebuffer::invalidate()
+         */
+        void end();
+
+    private:
+        struct ColorAttachment;
+
+        MAGNUM_GL_LOCAL void invalidate(bool atEnd);
+
+        Framebuffer* _framebuffer;
+        DefaultFramebuffer* _defaultFramebuffer;
+        Containers::Array<ColorAttachment> _colorAttachments;
+        Float _clearDepth{1.0f};
+        Int _clearStencil{};
+        RenderPassLoad _depthLoad{RenderPassLoad::Load},
+            _stencilLoad{RenderPassLoad::Load};
+        RenderPassStore _depthStore{RenderPassStore::Store},
+            _stencilStore{RenderPassStore::Store};
+        bool _active{};
+};
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 build
+#endif
+
+#endif
@@ -0,0 +1,506 @@
+#ifndef Magnum_GL_RenderStates_h
+#define Magnum_GL_RenderStates_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::GL::BlendState, @ref Magnum::GL::DepthStencilState, @ref Magnum::GL::RasterState
+ * @m_since_latest
+ */
+
+#include "Magnum/Math/BitVector.h"
+#include "Magnum/GL/Renderer.h"
+
+namespace Magnum { namespace GL {
+
+/**
+@brief Blend state block
+@m_since_latest
+
+Groups blending enablement, equations, functions and the color write mask so
+they can be applied as a unit with @ref Renderer::apply(const BlendState&).
+Together with @ref DepthStencilState and @ref RasterState it's meant to be
+created once for each render pass and then applied whenever the pass is
+switched to:
+
+@snippet MagnumGL.cpp RenderStates-usage
+
+The defaults match the initial OpenGL state --- blending disabled, additive
+equation, @ref Renderer::BlendFunction::One source and
+@ref Renderer::BlendFunction::Zero destination factors and all color
+channels writable. Per-draw-buffer blending isn't part of the block, use
+@ref Renderer::enable(Renderer::Feature, UnsignedInt) and related APIs for
+that.
+*/
+class BlendState {
+    public:
+        /** @brief Constructor */
+        constexpr /*implicit*/ BlendState() noexcept: _equationRgb{Renderer::BlendEquation::Add}, _equationAlpha{Renderer::BlendEquation::Add}, _sourceRgb{Renderer::BlendFunction::One}, _destinationRgb{Renderer::BlendFunction::Zero}, _sourceAlpha{Renderer::BlendFunction::One}, _destinationAlpha{Renderer::BlendFunction::Zero}, _colorMask{0xf}, _enabled{false} {}
+
+        /**
+         * @brief Whether blending is enabled
+         *
+         * @see @ref Renderer::Feature::Blending
+         */
+        constexpr bool isEnabled() const { return _enabled; }
+
+        /**
+         * @brief Enable or disable blending
+         * @return Reference to self (for method chaining)
+         *
+         * Default is @cpp false @ce.
+         * @see @ref Renderer::Feature::Blending
+         */
+        BlendState& setEnabled(bool enabled) {
+            _enabled = enabled;
+            return *this;
+        }
+
+        /** @brief RGB blend equation */
+        constexpr Renderer::BlendEquation equationRgb() const { return _equationRgb; }
+
+        /** @brief Alpha blend equation */
+        constexpr Renderer::BlendEquation equationAlpha() const { return _equationAlpha; }
+
+        /**
+         * @brief Set blend equation
+         * @return Reference to self (for method chaining)
+         *
+         * Sets the same equation for both RGB and alpha. Default is
+         * @ref Renderer::BlendEquation::Add.
+         * @see @ref Renderer::setBlendEquation(Renderer::BlendEquation)
+         */
+        BlendState& setEquation(Renderer::BlendEquation equation) {
+            _equationRgb = _equationAlpha = equation;
+            return *this;
+        }
+
+        /**
+         * @brief Set separate blend equation
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::setBlendEquation(Renderer::BlendEquation, Renderer::BlendEquation)
+         */
+        BlendState& setEquation(Renderer::BlendEquation rgb, Renderer::BlendEquation alpha) {
+            _equationRgb = rgb;
+            _equationAlpha = alpha;
+            return *this;
+        }
+
+        /** @brief RGB source blend function */
+        constexpr Renderer::BlendFunction sourceRgb() const { return _sourceRgb; }
+
+        /** @brief RGB destination blend function */
+        constexpr Renderer::BlendFunction destinationRgb() const { return _destinationRgb; }
+
+        /** @brief Alpha source blend function */
+        constexpr Renderer::BlendFunction sourceAlpha() const { return _sourceAlpha; }
+
+        /** @brief Alpha destination blend function */
+        constexpr Renderer::BlendFunction destinationAlpha() const { return _destinationAlpha; }
+
+        /**
+         * @brief Set blend function
+         * @return Reference to self (for method chaining)
+         *
+         * Sets the same function for both RGB and alpha. Default is
+         * @ref Renderer::BlendFunction::One for source and
+         * @ref Renderer::BlendFunction::Zero for destination.
+         * @see @ref Renderer::setBlendFunction(Renderer::BlendFunction, Renderer::BlendFunction)
+         */
+        BlendState& setFunction(Renderer::BlendFunction source, Renderer::BlendFunction destination) {
+            _sourceRgb = _sourceAlpha = source;
+            _destinationRgb = _destinationAlpha = destination;
+            return *this;
+        }
+
+        /**
+         * @brief Set separate blend function
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::setBlendFunction(Renderer::BlendFunction, Renderer::BlendFunction, Renderer::BlendFunction, Renderer::BlendFunction)
+         */
+        BlendState& setFunction(Renderer::BlendFunction sourceRgb, Renderer::BlendFunction destinationRgb, Renderer::BlendFunction sourceAlpha, Renderer::BlendFunction destinationAlpha) {
+            _sourceRgb = sourceRgb;
+            _destinationRgb = destinationRgb;
+            _sourceAlpha = sourceAlpha;
+            _destinationAlpha = destinationAlpha;
+            return *this;
+        }
+
+        /**
+         * @brief Color write mask
+         *
+         * Bits correspond to the red, green, blue and alpha channel.
+         */
+        constexpr BitVector4 colorMask() const { return BitVector4{_colorMask}; }
+
+        /**
+         * @brief Set color write mask
+         * @return Reference to self (for method chaining)
+         *
+         * Default is all channels writable.
+         * @see @ref Renderer::setColorMask(GLboolean, GLboolean, GLboolean, GLboolean)
+         */
+        BlendState& setColorMask(bool allowRed, bool allowGreen, bool allowBlue, bool allowAlpha) {
+            _colorMask = (allowRed ? 1 : 0)|(allowGreen ? 2 : 0)|(allowBlue ? 4 : 0)|(allowAlpha ? 8 : 0);
+            return *this;
+        }
+
+    private:
+        Renderer::BlendEquation _equationRgb, _equationAlpha;
+        Renderer::BlendFunction _sourceRgb, _destinationRgb, _sourceAlpha, _destinationAlpha;
+        UnsignedByte _colorMask;
+        bool _enabled;
+};
+
+/**
+@brief Depth and stencil state block
+@m_since_latest
+
+Groups depth test enablement, depth function and depth write mask together
+with stencil test enablement, stencil function, operations and write mask so
+they can be applied as a unit with
+@ref Renderer::apply(const DepthStencilState&). See @ref BlendState for an
+usage example.
+
+The defaults match the initial OpenGL state --- depth and stencil test
+disabled, @ref Renderer::DepthFunction::Less, depth writes enabled,
+@ref Renderer::StencilFunction::Always with a zero reference value,
+@ref Renderer::StencilOperation::Keep for all operations and all bits
+allowed in both the stencil function and write mask. The stencil settings
+apply to both front- and back-facing polygons, use
+@ref Renderer::setStencilFunction(Renderer::PolygonFacing, Renderer::StencilFunction, Int, UnsignedInt)
+and related APIs for two-sided stencil.
+*/
+class DepthStencilState {
+    public:
+        /** @brief Constructor */
+        constexpr /*implicit*/ DepthStencilState() noexcept: _depthFunction{Renderer::DepthFunction::Less}, _stencilFunction{Renderer::StencilFunction::Always}, _stencilFail{Renderer::StencilOperation::Keep}, _depthFail{Renderer::StencilOperation::Keep}, _depthPass{Renderer::StencilOperation::Keep}, _stencilReferenceValue{0}, _stencilFunctionMask{~UnsignedInt{}}, _stencilWriteMask{~UnsignedInt{}}, _depthTestEnabled{false}, _depthWriteEnabled{true}, _stencilTestEnabled{false} {}
+
+        /**
+         * @brief Whether depth test is enabled
+         *
+         * @see @ref Renderer::Feature::DepthTest
+         */
+        constexpr bool isDepthTestEnabled() const { return _depthTestEnabled; }
+
+        /**
+         * @brief Enable or disable depth test
+         * @return Reference to self (for method chaining)
+         *
+         * Default is @cpp false @ce.
+         * @see @ref Renderer::Feature::DepthTest
+         */
+        DepthStencilState& setDepthTestEnabled(bool enabled) {
+            _depthTestEnabled = enabled;
+            return *this;
+        }
+
+        /** @brief Depth function */
+        constexpr Renderer::DepthFunction depthFunction() const { return _depthFunction; }
+
+        /**
+         * @brief Set depth function
+         * @return Reference to self (for method chaining)
+         *
+         * Default is @ref Renderer::DepthFunction::Less.
+         * @see @ref Renderer::setDepthFunction()
+         */
+        DepthStencilState& setDepthFunction(Renderer::DepthFunction function) {
+            _depthFunction = function;
+            return *this;
+        }
+
+        /** @brief Whether depth writes are enabled */
+        constexpr bool isDepthWriteEnabled() const { return _depthWriteEnabled; }
+
+        /**
+         * @brief Enable or disable depth writes
+         * @return Reference to self (for method chaining)
+         *
+         * Default is @cpp true @ce.
+         * @see @ref Renderer::setDepthMask()
+         */
+        DepthStencilState& setDepthWriteEnabled(bool enabled) {
+            _depthWriteEnabled = enabled;
+            return *this;
+        }
+
+        /**
+         * @brief Whether stencil test is enabled
+         *
+         * @see @ref Renderer::Feature::StencilTest
+         */
+        constexpr bool isStencilTestEnabled() const { return _stencilTestEnabled; }
+
+        /**
+         * @brief Enable or disable stencil test
+         * @return Reference to self (for method chaining)
+         *
+         * Default is @cpp false @ce.
+         * @see @ref Renderer::Feature::StencilTest
+         */
+        DepthStencilState& setStencilTestEnabled(bool enabled) {
+            _stencilTestEnabled = enabled;
+            return *this;
+        }
+
+        /** @brief Stencil function */
+        constexpr Renderer::StencilFunction stencilFunction() const { return _stencilFunction; }
+
+        /** @brief Stencil reference value */
+        constexpr Int stencilReferenceValue() const { return _stencilReferenceValue; }
+
+        /** @brief Stencil function mask */
+        constexpr UnsignedInt stencilFunctionMask() const { return _stencilFunctionMask; }
+
+        /**
+         * @brief Set stencil function
+         * @return Reference to self (for method chaining)
+         *
+         * Default is @ref Renderer::StencilFunction::Always, @cpp 0 @ce
+         * reference value and all bits set in the mask.
+         * @see @ref Renderer::setStencilFunction(Renderer::StencilFunction, Int, UnsignedInt)
+         */
+        DepthStencilState& setStencilFunction(Renderer::StencilFunction function, Int referenceValue, UnsignedInt mask) {
+            _stencilFunction = function;
+            _stencilReferenceValue = referenceValue;
+            _stencilFunctionMask = mask;
+            return *this;
+        }
+
+        /** @brief Action when stencil test fails */
+        constexpr Renderer::StencilOperation stencilFailOperation() const { return _stencilFail; }
+
+        /** @brief Action when stencil test passes, but depth test fails */
+        constexpr Renderer::StencilOperation depthFailOperation() const { return _depthFail; }
+
+        /** @brief Action when both stencil and depth test pass */
+        constexpr Renderer::StencilOperation depthPassOperation() const { return _depthPass; }
+
+        /**
+         * @brief Set stencil operation
+         * @return Reference to self (for method chaining)
+         *
+         * Default is @ref Renderer::StencilOperation::Keep for all three.
+         * @see @ref Renderer::setStencilOperation(Renderer::StencilOperation, Renderer::StencilOperation, Renderer::StencilOperation)
+         */
+        DepthStencilState& setStencilOperation(Renderer::StencilOperation stencilFail, Renderer::StencilOperation depthFail, Renderer::StencilOperation depthPass) {
+            _stencilFail = stencilFail;
+            _depthFail = depthFail;
+            _depthPass = depthPass;
+            return *this;
+        }
+
+        /** @brief Stencil write mask */
+        constexpr UnsignedInt stencilWriteMask() const { return _stencilWriteMask; }
+
+        /**
+         * @brief Set stencil write mask
+         * @return Reference to self (for method chaining)
+         *
+         * Default is all bits set.
+         * @see @ref Renderer::setStencilMask(UnsignedInt)
+         */
+        DepthStencilState& setStencilWriteMask(UnsignedInt allowBits) {
+            _stencilWriteMask = allowBits;
+            return *this;
+        }
+
+    private:
+        Renderer::DepthFunction _depthFunction;
+        Renderer::StencilFunction _stencilFunction;
+        Renderer::StencilOperation _stencilFail, _depthFail, _depthPass;
+        Int _stencilReferenceValue;
+        UnsignedInt _stencilFunctionMask, _stencilWriteMask;
+        bool _depthTestEnabled, _depthWriteEnabled, _stencilTestEnabled;
+};
+
+/**
+@brief Rasterization state block
+@m_since_latest
+
+Groups face culling, front face winding, polygon offset, scissor test and
+polygon mode so they can be applied as a unit with
+@ref Renderer::apply(const RasterState&). See @ref BlendState for an usage
+example.
+
+The defaults match the initial OpenGL state --- face culling disabled,
+culling of @ref Renderer::PolygonFacing::Back faces,
+@ref Renderer::FrontFace::CounterClockWise, polygon offset fill disabled with
+a zero factor and units, scissor test disabled and
+@ref Renderer::PolygonMode::Fill. The scissor rectangle itself isn't part
+of the block as it usually changes with the viewport, use
+@ref Renderer::setScissor() for it.
+*/
+class RasterState {
+    public:
+        /** @brief Constructor */
+        constexpr /*implicit*/ RasterState() noexcept: _faceCullingMode{Renderer::PolygonFacing::Back}, _frontFace{Renderer::FrontFace::CounterClockWise},
+            #ifndef MAGNUM_TARGET_WEBGL
+            _polygonMode{Renderer::PolygonMode::Fill},
+            #endif
+            _polygonOffsetFactor{}, _polygonOffsetUnits{}, _faceCullingEnabled{false}, _polygonOffsetFillEnabled{false}, _scissorTestEnabled{false} {}
+
+        /**
+         * @brief Whether face culling is enabled
+         *
+         * @see @ref Renderer::Feature::FaceCulling
+         */
+        constexpr bool isFaceCullingEnabled() const { return _faceCullingEnabled; }
+
+        /**
+         * @brief Enable or disable face culling
+         * @return Reference to self (for method chaining)
+         *
+         * Default is @cpp false @ce.
+         * @see @ref Renderer::Feature::FaceCulling
+         */
+        RasterState& setFaceCullingEnabled(bool enabled) {
+            _faceCullingEnabled = enabled;
+            return *this;
+        }
+
+        /** @brief Face culling mode */
+        constexpr Renderer::PolygonFacing faceCullingMode() const { return _faceCullingMode; }
+
+        /**
+         * @brief Set face culling mode
+         * @return Reference to self (for method chaining)
+         *
+         * Default is @ref Renderer::PolygonFacing::Back.
+         * @see @ref Renderer::setFaceCullingMode()
+         */
+        RasterState& setFaceCullingMode(Renderer::PolygonFacing mode) {
+            _faceCullingMode = mode;
+            return *this;
+        }
+
+        /** @brief Front face winding */
+        constexpr Renderer::FrontFace frontFace() const { return _frontFace; }
+
+        /**
+         * @brief Set front face winding
+         * @return Reference to self (for method chaining)
+         *
+         * Default is @ref Renderer::FrontFace::CounterClockWise.
+         * @see @ref Renderer::setFrontFace()
+         */
+        RasterState& setFrontFace(Renderer::FrontFace mode) {
+            _frontFace = mode;
+            return *this;
+        }
+
+        #ifndef MAGNUM_TARGET_WEBGL
+        /** @brief Polygon mode */
+        constexpr Renderer::PolygonMode polygonMode() const { return _polygonMode; }
+
+        /**
+         * @brief Set polygon mode
+         * @return Reference to self (for method chaining)
+         *
+         * Default is @ref Renderer::PolygonMode::Fill.
+         * @see @ref Renderer::setPolygonMode()
+         * @requires_es_extension Extension @gl_extension{NV,polygon_mode}.
+         *      Otherwise behaves always like @ref Renderer::PolygonMode::Fill.
+         * @requires_gles Polygon mode is not available in WebGL.
+         */
+        RasterState& setPolygonMode(Renderer::PolygonMode mode) {
+            _polygonMode = mode;
+            return *this;
+        }
+        #endif
+
+        /**
+         * @brief Whether polygon offset fill is enabled
+         *
+         * @see @ref Renderer::Feature::PolygonOffsetFill
+         */
+        constexpr bool isPolygonOffsetFillEnabled() const { return _polygonOffsetFillEnabled; }
+
+        /**
+         * @brief Enable or disable polygon offset fill
+         * @return Reference to self (for method chaining)
+         *
+         * Default is @cpp false @ce.
+         * @see @ref Renderer::Feature::PolygonOffsetFill
+         */
+        RasterState& setPolygonOffsetFillEnabled(bool enabled) {
+            _polygonOffsetFillEnabled = enabled;
+            return *this;
+        }
+
+        /** @brief Polygon offset factor */
+        constexpr Float polygonOffsetFactor() const { return _polygonOffsetFactor; }
+
+        /** @brief Polygon offset units */
+        constexpr Float polygonOffsetUnits() const { return _polygonOffsetUnits; }
+
+        /**
+         * @brief Set polygon offset
+         * @return Reference to self (for method chaining)
+         *
+         * Default is @cpp 0.0f @ce for both.
+         * @see @ref Renderer::setPolygonOffset()
+         */
+        RasterState& setPolygonOffset(Float factor, Float units) {
+            _polygonOffsetFactor = factor;
+            _polygonOffsetUnits = units;
+            return *this;
+        }
+
+        /**
+         * @brief Whether scissor test is enabled
+         *
+         * @see @ref Renderer::Feature::ScissorTest
+         */
+        constexpr bool isScissorTestEnabled() const { return _scissorTestEnabled; }
+
+        /**
+         * @brief Enable or disable scissor test
+         * @return Reference to self (for method chaining)
+         *
+         * Default is @cpp false @ce.
+         * @see @ref Renderer::Feature::ScissorTest
+         */
+        RasterState& setScissorTestEnabled(bool enabled) {
+            _scissorTestEnabled = enabled;
+            return *this;
+        }
+
+    private:
+        Renderer::PolygonFacing _faceCullingMode;
+        Renderer::FrontFace _frontFace;
+        #ifndef MAGNUM_TARGET_WEBGL
+        Renderer::PolygonMode _polygonMode;
+        #endif
+        Float _polygonOffsetFactor, _polygonOffsetUnits;
+        bool _faceCullingEnabled, _polygonOffsetFillEnabled, _scissorTestEnabled;
+};
+
+}}
+
+#endif
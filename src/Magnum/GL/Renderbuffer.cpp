@@ -29,6 +29,8 @@
 #include <Corrade/Containers/String.h>
 #endif
 
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector3.h"
 #include "Magnum/GL/Context.h"
 #include "Magnum/GL/Extensions.h"
 
@@ -36,6 +38,7 @@
 #include "Magnum/GL/Implementation/DebugState.h"
 #endif
 #include "Magnum/GL/Implementation/FramebufferState.h"
+#include "Magnum/GL/Implementation/MemoryUsageState.h"
 #include "Magnum/GL/Implementation/State.h"
 
 namespace Magnum { namespace GL {
@@ -95,6 +98,7 @@ Renderbuffer::~Renderbuffer() {
     GLuint& binding = Context::current().state().framebuffer.renderbufferBinding;
     if(binding == _id) binding = 0;
 
+    Implementation::memoryUsageRemove(MemoryUsageCategory::Renderbuffer, _id);
     glDeleteRenderbuffers(1, &_id);
 }
 
@@ -118,17 +122,22 @@ Containers::String Renderbuffer::label() {
 Renderbuffer& Renderbuffer::setLabel(const Containers::StringView label) {
     createIfNotAlready();
     Context::current().state().debug.labelImplementation(GL_RENDERBUFFER, _id, label);
+    Implementation::memoryUsageLabel(MemoryUsageCategory::Renderbuffer, _id, label);
     return *this;
 }
 #endif
 
 void Renderbuffer::setStorage(const RenderbufferFormat internalFormat, const Vector2i& size) {
     (this->*Context::current().state().framebuffer.renderbufferStorageImplementation)(internalFormat, size);
+    Implementation::memoryUsageSet(MemoryUsageCategory::Renderbuffer, _id,
+        Implementation::textureFormatDataSize(GLenum(internalFormat), {size, 1}));
 }
 
 #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
 void Renderbuffer::setStorageMultisample(const Int samples, const RenderbufferFormat internalFormat, const Vector2i& size) {
     (this->*Context::current().state().framebuffer.renderbufferStorageMultisampleImplementation)(samples, internalFormat, size);
+    Implementation::memoryUsageSet(MemoryUsageCategory::Renderbuffer, _id,
+        Math::max(samples, 1)*Implementation::textureFormatDataSize(GLenum(internalFormat), {size, 1}));
 }
 #endif
 
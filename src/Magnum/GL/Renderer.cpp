@@ -27,6 +27,7 @@
 
 #include "Magnum/GL/Context.h"
 #include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/RenderStates.h"
 #include "Magnum/Math/Color.h"
 #include "Magnum/Math/Range.h"
 
@@ -60,11 +61,38 @@ Range1D Renderer::lineWidthRangeImplementationMesaForwardCompatible() {
 }
 #endif
 
+namespace {
+
+/* Makes the next Renderer::apply() set the whole state block containing given
+   feature again. Features that aren't a part of any block don't need to touch
+   the state tracker at all. */
+void disengageStateBlock(const Renderer::Feature feature) {
+    switch(feature) {
+        case Renderer::Feature::Blending:
+            Context::current().state().renderer.blendEngaged = false;
+            return;
+        case Renderer::Feature::DepthTest:
+        case Renderer::Feature::StencilTest:
+            Context::current().state().renderer.depthStencilEngaged = false;
+            return;
+        case Renderer::Feature::FaceCulling:
+        case Renderer::Feature::PolygonOffsetFill:
+        case Renderer::Feature::ScissorTest:
+            Context::current().state().renderer.rasterEngaged = false;
+            return;
+        default: return;
+    }
+}
+
+}
+
 void Renderer::enable(const Feature feature) {
+    disengageStateBlock(feature);
     glEnable(GLenum(feature));
 }
 
 void Renderer::disable(const Feature feature) {
+    disengageStateBlock(feature);
     glDisable(GLenum(feature));
 }
 
@@ -74,10 +102,12 @@ void Renderer::setFeature(const Feature feature, const bool enabled) {
 
 #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
 void Renderer::enable(const Feature feature, const UnsignedInt drawBuffer) {
+    disengageStateBlock(feature);
     Context::current().state().renderer.enableiImplementation(GLenum(feature), drawBuffer);
 }
 
 void Renderer::disable(const Feature feature, const UnsignedInt drawBuffer) {
+    disengageStateBlock(feature);
     Context::current().state().renderer.disableiImplementation(GLenum(feature), drawBuffer);
 }
 
@@ -109,10 +139,12 @@ void Renderer::setClearStencil(const Int stencil) {
 }
 
 void Renderer::setFrontFace(const FrontFace mode) {
+    Context::current().state().renderer.rasterEngaged = false;
     glFrontFace(GLenum(mode));
 }
 
 void Renderer::setFaceCullingMode(const PolygonFacing mode) {
+    Context::current().state().renderer.rasterEngaged = false;
     glCullFace(GLenum(mode));
 }
 
@@ -124,6 +156,7 @@ void Renderer::setProvokingVertex(const ProvokingVertex mode) {
 
 #ifndef MAGNUM_TARGET_WEBGL
 void Renderer::setPolygonMode(const PolygonMode mode) {
+    Context::current().state().renderer.rasterEngaged = false;
     #ifndef MAGNUM_TARGET_GLES
     glPolygonMode
     #else
@@ -134,6 +167,7 @@ void Renderer::setPolygonMode(const PolygonMode mode) {
 #endif
 
 void Renderer::setPolygonOffset(const Float factor, const Float units) {
+    Context::current().state().renderer.rasterEngaged = false;
     glPolygonOffset(factor, units);
 }
 
@@ -283,81 +317,185 @@ void Renderer::setScissor(const Range2Di& rectangle) {
 }
 
 void Renderer::setStencilFunction(const PolygonFacing facing, const StencilFunction function, const Int referenceValue, const UnsignedInt mask) {
+    Context::current().state().renderer.depthStencilEngaged = false;
     glStencilFuncSeparate(GLenum(facing), GLenum(function), referenceValue, mask);
 }
 
 void Renderer::setStencilFunction(const StencilFunction function, const Int referenceValue, const UnsignedInt mask) {
+    Context::current().state().renderer.depthStencilEngaged = false;
     glStencilFunc(GLenum(function), referenceValue, mask);
 }
 
 void Renderer::setStencilOperation(const PolygonFacing facing, const StencilOperation stencilFail, const StencilOperation depthFail, const StencilOperation depthPass) {
+    Context::current().state().renderer.depthStencilEngaged = false;
     glStencilOpSeparate(GLenum(facing), GLenum(stencilFail), GLenum(depthFail), GLenum(depthPass));
 }
 
 void Renderer::setStencilOperation(const StencilOperation stencilFail, const StencilOperation depthFail, const StencilOperation depthPass) {
+    Context::current().state().renderer.depthStencilEngaged = false;
     glStencilOp(GLenum(stencilFail), GLenum(depthFail), GLenum(depthPass));
 }
 
 void Renderer::setDepthFunction(const DepthFunction function) {
+    Context::current().state().renderer.depthStencilEngaged = false;
     glDepthFunc(GLenum(function));
 }
 
 void Renderer::setColorMask(const GLboolean allowRed, const GLboolean allowGreen, const GLboolean allowBlue, const GLboolean allowAlpha) {
+    Context::current().state().renderer.blendEngaged = false;
     glColorMask(allowRed, allowGreen, allowBlue, allowAlpha);
 }
 
 #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
 void Renderer::setColorMask(const UnsignedInt drawBuffer, const GLboolean allowRed, const GLboolean allowGreen, const GLboolean allowBlue, const GLboolean allowAlpha) {
+    Context::current().state().renderer.blendEngaged = false;
     Context::current().state().renderer.colorMaskiImplementation(drawBuffer, allowRed, allowGreen, allowBlue, allowAlpha);
 }
 #endif
 
 void Renderer::setDepthMask(const GLboolean allow) {
+    Context::current().state().renderer.depthStencilEngaged = false;
     glDepthMask(allow);
 }
 
 void Renderer::setStencilMask(const PolygonFacing facing, const UnsignedInt allowBits) {
+    Context::current().state().renderer.depthStencilEngaged = false;
     glStencilMaskSeparate(GLenum(facing), allowBits);
 }
 
 void Renderer::setStencilMask(const UnsignedInt allowBits) {
+    Context::current().state().renderer.depthStencilEngaged = false;
     glStencilMask(allowBits);
 }
 
 void Renderer::setBlendEquation(const BlendEquation equation) {
+    Context::current().state().renderer.blendEngaged = false;
     glBlendEquation(GLenum(equation));
 }
 
 void Renderer::setBlendEquation(const BlendEquation rgb, const BlendEquation alpha) {
+    Context::current().state().renderer.blendEngaged = false;
     glBlendEquationSeparate(GLenum(rgb), GLenum(alpha));
 }
 
 void Renderer::setBlendFunction(const BlendFunction source, const BlendFunction destination) {
+    Context::current().state().renderer.blendEngaged = false;
     glBlendFunc(GLenum(source), GLenum(destination));
 }
 
 void Renderer::setBlendFunction(const BlendFunction sourceRgb, const BlendFunction destinationRgb, const BlendFunction sourceAlpha, const BlendFunction destinationAlpha) {
+    Context::current().state().renderer.blendEngaged = false;
     glBlendFuncSeparate(GLenum(sourceRgb), GLenum(destinationRgb), GLenum(sourceAlpha), GLenum(destinationAlpha));
 }
 
 #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
 void Renderer::setBlendEquation(const UnsignedInt drawBuffer, const BlendEquation equation) {
+    Context::current().state().renderer.blendEngaged = false;
     Context::current().state().renderer.blendEquationiImplementation(drawBuffer, GLenum(equation));
 }
 
 void Renderer::setBlendEquation(const UnsignedInt drawBuffer, const BlendEquation rgb, const BlendEquation alpha) {
+    Context::current().state().renderer.blendEngaged = false;
     Context::current().state().renderer.blendEquationSeparateiImplementation(drawBuffer, GLenum(rgb), GLenum(alpha));
 }
 
 void Renderer::setBlendFunction(const UnsignedInt drawBuffer, const BlendFunction source, const BlendFunction destination) {
+    Context::current().state().renderer.blendEngaged = false;
     Context::current().state().renderer.blendFunciImplementation(drawBuffer, GLenum(source), GLenum(destination));
 }
 
 void Renderer::setBlendFunction(const UnsignedInt drawBuffer, const BlendFunction sourceRgb, const BlendFunction destinationRgb, const BlendFunction sourceAlpha, const BlendFunction destinationAlpha) {
+    Context::current().state().renderer.blendEngaged = false;
     Context::current().state().renderer.blendFuncSeparateiImplementation(drawBuffer, GLenum(sourceRgb), GLenum(destinationRgb), GLenum(sourceAlpha), GLenum(destinationAlpha));
 }
 #endif
 
+void Renderer::apply(const BlendState& blend) {
+    Implementation::RendererState& state = Context::current().state().renderer;
+    const BlendState& current = state.blend;
+    const bool engaged = state.blendEngaged;
+
+    if(!engaged || current.isEnabled() != blend.isEnabled())
+        blend.isEnabled() ? glEnable(GLenum(Feature::Blending)) : glDisable(GLenum(Feature::Blending));
+    if(!engaged || current.equationRgb() != blend.equationRgb() || current.equationAlpha() != blend.equationAlpha())
+        glBlendEquationSeparate(GLenum(blend.equationRgb()), GLenum(blend.equationAlpha()));
+    if(!engaged || current.sourceRgb() != blend.sourceRgb() || current.destinationRgb() != blend.destinationRgb() || current.sourceAlpha() != blend.sourceAlpha() || current.destinationAlpha() != blend.destinationAlpha())
+        glBlendFuncSeparate(GLenum(blend.sourceRgb()), GLenum(blend.destinationRgb()), GLenum(blend.sourceAlpha()), GLenum(blend.destinationAlpha()));
+    if(!engaged || current.colorMask() != blend.colorMask()) {
+        const BitVector4 mask = blend.colorMask();
+        glColorMask(mask[0], mask[1], mask[2], mask[3]);
+    }
+
+    state.blend = blend;
+    state.blendEngaged = true;
+}
+
+void Renderer::apply(const DepthStencilState& depthStencil) {
+    Implementation::RendererState& state = Context::current().state().renderer;
+    const DepthStencilState& current = state.depthStencil;
+    const bool engaged = state.depthStencilEngaged;
+
+    if(!engaged || current.isDepthTestEnabled() != depthStencil.isDepthTestEnabled())
+        depthStencil.isDepthTestEnabled() ? glEnable(GLenum(Feature::DepthTest)) : glDisable(GLenum(Feature::DepthTest));
+    if(!engaged || current.depthFunction() != depthStencil.depthFunction())
+        glDepthFunc(GLenum(depthStencil.depthFunction()));
+    if(!engaged || current.isDepthWriteEnabled() != depthStencil.isDepthWriteEnabled())
+        glDepthMask(depthStencil.isDepthWriteEnabled());
+
+    if(!engaged || current.isStencilTestEnabled() != depthStencil.isStencilTestEnabled())
+        depthStencil.isStencilTestEnabled() ? glEnable(GLenum(Feature::StencilTest)) : glDisable(GLenum(Feature::StencilTest));
+    if(!engaged || current.stencilFunction() != depthStencil.stencilFunction() || current.stencilReferenceValue() != depthStencil.stencilReferenceValue() || current.stencilFunctionMask() != depthStencil.stencilFunctionMask())
+        glStencilFunc(GLenum(depthStencil.stencilFunction()), depthStencil.stencilReferenceValue(), depthStencil.stencilFunctionMask());
+    if(!engaged || current.stencilFailOperation() != depthStencil.stencilFailOperation() || current.depthFailOperation() != depthStencil.depthFailOperation() || current.depthPassOperation() != depthStencil.depthPassOperation())
+        glStencilOp(GLenum(depthStencil.stencilFailOperation()), GLenum(depthStencil.depthFailOperation()), GLenum(depthStencil.depthPassOperation()));
+    if(!engaged || current.stencilWriteMask() != depthStencil.stencilWriteMask())
+        glStencilMask(depthStencil.stencilWriteMask());
+
+    state.depthStencil = depthStencil;
+    state.depthStencilEngaged = true;
+}
+
+void Renderer::apply(const RasterState& raster) {
+    Implementation::RendererState& state = Context::current().state().renderer;
+    const RasterState& current = state.raster;
+    const bool engaged = state.rasterEngaged;
+
+    if(!engaged || current.isFaceCullingEnabled() != raster.isFaceCullingEnabled())
+        raster.isFaceCullingEnabled() ? glEnable(GLenum(Feature::FaceCulling)) : glDisable(GLenum(Feature::FaceCulling));
+    if(!engaged || current.faceCullingMode() != raster.faceCullingMode())
+        glCullFace(GLenum(raster.faceCullingMode()));
+    if(!engaged || current.frontFace() != raster.frontFace())
+        glFrontFace(GLenum(raster.frontFace()));
+
+    #ifndef MAGNUM_TARGET_WEBGL
+    if((!engaged || current.polygonMode() != raster.polygonMode())
+        #ifdef MAGNUM_TARGET_GLES
+        /* Without the extension the function pointer is null and polygon
+           mode is always Fill, as documented */
+        && Context::current().isExtensionSupported<Extensions::NV::polygon_mode>()
+        #endif
+    ) {
+        #ifndef MAGNUM_TARGET_GLES
+        glPolygonMode
+        #else
+        glPolygonModeNV
+        #endif
+            (GL_FRONT_AND_BACK, GLenum(raster.polygonMode()));
+    }
+    #endif
+
+    if(!engaged || current.isPolygonOffsetFillEnabled() != raster.isPolygonOffsetFillEnabled())
+        raster.isPolygonOffsetFillEnabled() ? glEnable(GLenum(Feature::PolygonOffsetFill)) : glDisable(GLenum(Feature::PolygonOffsetFill));
+    if(!engaged || current.polygonOffsetFactor() != raster.polygonOffsetFactor() || current.polygonOffsetUnits() != raster.polygonOffsetUnits())
+        glPolygonOffset(raster.polygonOffsetFactor(), raster.polygonOffsetUnits());
+
+    if(!engaged || current.isScissorTestEnabled() != raster.isScissorTestEnabled())
+        raster.isScissorTestEnabled() ? glEnable(GLenum(Feature::ScissorTest)) : glDisable(GLenum(Feature::ScissorTest));
+
+    state.raster = raster;
+    state.rasterEngaged = true;
+}
+
 void Renderer::setBlendColor(const Color4& color) {
     glBlendColor(color.r(), color.g(), color.b(), color.a());
 }
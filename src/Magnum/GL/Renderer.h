@@ -639,6 +639,71 @@ class MAGNUM_GL_EXPORT Renderer {
          * @}
          */
 
+        /** @{ @name State blocks */
+
+        /**
+         * @brief Apply a blend state block
+         * @m_since_latest
+         *
+         * Compares @p state against the block applied last time and issues
+         * GL calls only for the values that differ. Calling
+         * @ref enable() / @ref disable() with @ref Feature::Blending,
+         * @ref setBlendEquation(), @ref setBlendFunction() or
+         * @ref setColorMask() in between makes the next call set all values
+         * of the block again. The tracked state is also reset by
+         * @ref Context::resetState() with @ref Context::State::Renderer.
+         * @see @ref BlendState, @fn_gl_keyword{Enable} / @fn_gl_keyword{Disable}
+         *      with @def_gl{BLEND}, @fn_gl_keyword{BlendEquationSeparate},
+         *      @fn_gl_keyword{BlendFuncSeparate}, @fn_gl_keyword{ColorMask}
+         */
+        static void apply(const BlendState& state);
+
+        /**
+         * @brief Apply a depth and stencil state block
+         * @m_since_latest
+         *
+         * Compares @p state against the block applied last time and issues
+         * GL calls only for the values that differ. Calling
+         * @ref enable() / @ref disable() with @ref Feature::DepthTest or
+         * @ref Feature::StencilTest, @ref setDepthFunction(),
+         * @ref setDepthMask(), @ref setStencilFunction(),
+         * @ref setStencilOperation() or @ref setStencilMask() in between makes
+         * the next call set all values of the block again. The tracked state
+         * is also reset by @ref Context::resetState() with
+         * @ref Context::State::Renderer.
+         * @see @ref DepthStencilState, @fn_gl_keyword{Enable} /
+         *      @fn_gl_keyword{Disable} with @def_gl{DEPTH_TEST} and
+         *      @def_gl{STENCIL_TEST}, @fn_gl_keyword{DepthFunc},
+         *      @fn_gl_keyword{DepthMask}, @fn_gl_keyword{StencilFunc},
+         *      @fn_gl_keyword{StencilOp}, @fn_gl_keyword{StencilMask}
+         */
+        static void apply(const DepthStencilState& state);
+
+        /**
+         * @brief Apply a rasterization state block
+         * @m_since_latest
+         *
+         * Compares @p state against the block applied last time and issues
+         * GL calls only for the values that differ. Calling
+         * @ref enable() / @ref disable() with @ref Feature::FaceCulling,
+         * @ref Feature::PolygonOffsetFill or @ref Feature::ScissorTest,
+         * @ref setFaceCullingMode(), @ref setFrontFace(),
+         * @ref setPolygonOffset() or @ref setPolygonMode() in between makes
+         * the next call set all values of the block again. The tracked state
+         * is also reset by @ref Context::resetState() with
+         * @ref Context::State::Renderer.
+         * @see @ref RasterState, @fn_gl_keyword{Enable} /
+         *      @fn_gl_keyword{Disable} with @def_gl{CULL_FACE},
+         *      @def_gl{POLYGON_OFFSET_FILL} and @def_gl{SCISSOR_TEST},
+         *      @fn_gl_keyword{CullFace}, @fn_gl_keyword{FrontFace},
+         *      @fn_gl_keyword{PolygonOffset}, @fn_gl_keyword{PolygonMode}
+         */
+        static void apply(const RasterState& state);
+
+        /**
+         * @}
+         */
+
         /** @{ @name Clearing values */
 
         /**
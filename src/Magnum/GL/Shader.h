@@ -67,6 +67,21 @@ Source number `0` is a @glsl #version @ce directive added in the constructor
 (unless @ref Version::None is specified). which means the first added source
 has a number `1`.
 
+@section GL-Shader-async Asynchronous compilation
+
+The @ref compile() functions block until the compilation is done. With
+@gl_extension{KHR,parallel_shader_compile} the driver can compile in worker
+threads, and the wait can be avoided by splitting the operation into
+@ref submitCompile(), which just invokes the compilation, and
+@ref checkCompile(), which retrieves the result. In between,
+@ref isCompileFinished() can be polled to find out whether the result is
+available already or whether there's time to do other work. Together with
+@ref AbstractShaderProgram::submitLink() and related APIs this allows
+compiling a large set of shaders while the application keeps rendering ---
+see @ref GL-AbstractShaderProgram-async for more information. If the
+extension isn't supported, the compilation happens synchronously and
+@ref isCompileFinished() always returns @cpp true @ce.
+
 @section GL-Shader-performance-optimizations Performance optimizations
 
 Shader limits and implementation-defined values (such as @ref maxUniformComponents())
@@ -515,12 +530,34 @@ class MAGNUM_GL_EXPORT Shader: public AbstractObject {
          * are printed to error output. The operation is batched in a way that
          * allows the driver to perform multiple compilations simultaneously
          * (i.e. in multiple threads).
+         *
+         * Equivalent to calling @ref submitCompile() on all @p shaders and
+         * then @ref checkCompile() on all of them. See
+         * @ref GL-Shader-async for a way to not block on the compilation.
          * @see @fn_gl_keyword{ShaderSource}, @fn_gl_keyword{CompileShader},
          *      @fn_gl_keyword{GetShader} with @def_gl{COMPILE_STATUS} and
          *      @def_gl{INFO_LOG_LENGTH}, @fn_gl_keyword{GetShaderInfoLog}
          */
         static bool compile(std::initializer_list<Containers::Reference<Shader>> shaders);
 
+        #ifndef MAGNUM_TARGET_WEBGL
+        /**
+         * @brief Set max count of shader compiler threads
+         * @m_since_latest
+         *
+         * Affects shaders and programs submitted for compilation and linking
+         * afterwards. A value of @cpp 0 @ce disables asynchronous compilation
+         * and the value of @cpp 0xffffffffu @ce lets the implementation
+         * choose an appropriate count, which is the default. If
+         * @gl_extension{KHR,parallel_shader_compile} is not supported, the
+         * function does nothing.
+         * @see @ref GL-Shader-async, @fn_gl_extension_keyword{MaxShaderCompilerThreads,KHR,parallel_shader_compile}
+         * @requires_gles Setting the thread count is not available in WebGL,
+         *      the implementation always decides on its own.
+         */
+        static void setMaxCompilerThreads(UnsignedInt count);
+        #endif
+
         /**
          * @brief Constructor
          * @param version   Target version
@@ -643,7 +680,52 @@ class MAGNUM_GL_EXPORT Shader: public AbstractObject {
          */
         bool compile();
 
+        /**
+         * @brief Submit the shader for compilation
+         * @m_since_latest
+         *
+         * Uploads the sources and invokes the compilation without waiting
+         * for it to finish. Expects that at least one file was added. Call
+         * @ref checkCompile() afterwards to retrieve the result. See
+         * @ref GL-Shader-async for more information.
+         * @see @ref compile(), @fn_gl_keyword{ShaderSource},
+         *      @fn_gl_keyword{CompileShader}
+         */
+        void submitCompile();
+
+        /**
+         * @brief Check shader compilation status and await completion
+         * @m_since_latest
+         *
+         * Expects that @ref submitCompile() was called before. Returns
+         * @cpp false @ce if the compilation failed, @cpp true @ce on success.
+         * Compiler messages (if any) are printed to error output. If the
+         * compilation didn't finish yet, the call blocks until it does.
+         * @see @ref isCompileFinished(), @fn_gl_keyword{GetShader} with
+         *      @def_gl{COMPILE_STATUS} and @def_gl{INFO_LOG_LENGTH},
+         *      @fn_gl_keyword{GetShaderInfoLog}
+         */
+        bool checkCompile();
+
+        /**
+         * @brief Whether the shader compilation has finished
+         * @m_since_latest
+         *
+         * Expects that @ref submitCompile() was called before. If
+         * @gl_extension{KHR,parallel_shader_compile} is supported, queries
+         * the completion status, making it possible to do other work until
+         * the compilation finishes. Otherwise always returns @cpp true @ce,
+         * as the compilation is then done synchronously. The result of the
+         * compilation then has to be retrieved with @ref checkCompile() in
+         * any case.
+         * @see @ref GL-Shader-async, @fn_gl_keyword{GetShader} with
+         *      @def_gl_extension{COMPLETION_STATUS,KHR,parallel_shader_compile}
+         */
+        bool isCompileFinished();
+
     private:
+        bool MAGNUM_GL_LOCAL checkCompileInternal(Int index);
+
         void MAGNUM_GL_LOCAL addSourceImplementationDefault(std::string source);
         #if defined(CORRADE_TARGET_EMSCRIPTEN) && defined(__EMSCRIPTEN_PTHREADS__)
         void MAGNUM_GL_LOCAL addSourceImplementationEmscriptenPthread(std::string source);
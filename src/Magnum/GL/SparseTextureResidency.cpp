@@ -0,0 +1,164 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "SparseTextureResidency.h"
+
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/GL/Texture.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Range.h"
+
+namespace Magnum { namespace GL {
+
+namespace {
+
+Vector2i levelSize(const Vector2i& size, const Int level) {
+    return Math::max(size >> level, Vector2i{1});
+}
+
+Vector2i levelPageCount(const Vector2i& size, const Vector2i& pageSize, const Int level) {
+    return (levelSize(size, level) + pageSize - Vector2i{1})/pageSize;
+}
+
+}
+
+SparseTextureResidency::SparseTextureResidency(const Vector2i& size, const Vector2i& pageSize, const Int levelCount, const UnsignedInt evictionDelay): _size{size}, _pageSize{pageSize}, _levelCount{levelCount}, _evictionDelay{evictionDelay}, _frame{1}, _residentPageCount{} {
+    CORRADE_ASSERT(size.product(),
+        "GL::SparseTextureResidency: expected non-zero size but got" << Debug::packed << size, );
+    CORRADE_ASSERT(pageSize.product(),
+        "GL::SparseTextureResidency: expected non-zero page size but got" << Debug::packed << pageSize, );
+    CORRADE_ASSERT(levelCount,
+        "GL::SparseTextureResidency: expected non-zero level count", );
+
+    _levelOffsets = Containers::Array<std::size_t>{NoInit, std::size_t(levelCount) + 1};
+    _levelOffsets[0] = 0;
+    for(Int i = 0; i != levelCount; ++i)
+        _levelOffsets[i + 1] = _levelOffsets[i] + levelPageCount(size, pageSize, i).product();
+
+    _lastRequested = Containers::Array<UnsignedInt>{ValueInit, _levelOffsets.back()};
+    _resident = Containers::Array<bool>{ValueInit, _levelOffsets.back()};
+}
+
+SparseTextureResidency::SparseTextureResidency(SparseTextureResidency&&) noexcept = default;
+
+SparseTextureResidency::~SparseTextureResidency() = default;
+
+SparseTextureResidency& SparseTextureResidency::operator=(SparseTextureResidency&&) noexcept = default;
+
+Vector2i SparseTextureResidency::pageCount(const Int level) const {
+    CORRADE_ASSERT(level < _levelCount,
+        "GL::SparseTextureResidency::pageCount(): level" << level << "out of range for" << _levelCount << "levels", {});
+    return levelPageCount(_size, _pageSize, level);
+}
+
+std::size_t SparseTextureResidency::pageIndex(const Int level, const Vector2i& page) const {
+    return _levelOffsets[level] + page.y()*levelPageCount(_size, _pageSize, level).x() + page.x();
+}
+
+bool SparseTextureResidency::isResident(const Int level, const Vector2i& page) const {
+    CORRADE_ASSERT(level < _levelCount,
+        "GL::SparseTextureResidency::isResident(): level" << level << "out of range for" << _levelCount << "levels", {});
+    CORRADE_ASSERT((page < levelPageCount(_size, _pageSize, level)).all(),
+        "GL::SparseTextureResidency::isResident(): page" << Debug::packed << page << "out of range for" << Debug::packed << levelPageCount(_size, _pageSize, level) << "pages in level" << level, {});
+    return _resident[pageIndex(level, page)];
+}
+
+bool SparseTextureResidency::isRequested(const Int level, const Vector2i& page) const {
+    CORRADE_ASSERT(level < _levelCount,
+        "GL::SparseTextureResidency::isRequested(): level" << level << "out of range for" << _levelCount << "levels", {});
+    CORRADE_ASSERT((page < levelPageCount(_size, _pageSize, level)).all(),
+        "GL::SparseTextureResidency::isRequested(): page" << Debug::packed << page << "out of range for" << Debug::packed << levelPageCount(_size, _pageSize, level) << "pages in level" << level, {});
+    return _lastRequested[pageIndex(level, page)] == _frame;
+}
+
+void SparseTextureResidency::request(const Int level, const Vector2i& page) {
+    CORRADE_ASSERT(level < _levelCount,
+        "GL::SparseTextureResidency::request(): level" << level << "out of range for" << _levelCount << "levels", );
+    CORRADE_ASSERT((page < levelPageCount(_size, _pageSize, level)).all(),
+        "GL::SparseTextureResidency::request(): page" << Debug::packed << page << "out of range for" << Debug::packed << levelPageCount(_size, _pageSize, level) << "pages in level" << level, );
+    _lastRequested[pageIndex(level, page)] = _frame;
+}
+
+void SparseTextureResidency::request(const Int level, const Range2Di& range) {
+    CORRADE_ASSERT(level < _levelCount,
+        "GL::SparseTextureResidency::request(): level" << level << "out of range for" << _levelCount << "levels", );
+
+    /* Round the max up to whole pages and clamp to the level. Division of
+       negative values rounds towards zero, but those get clamped away
+       anyway. */
+    const Vector2i pageCount = levelPageCount(_size, _pageSize, level);
+    const Vector2i min = Math::clamp(range.min()/_pageSize, Vector2i{0}, pageCount);
+    const Vector2i max = Math::clamp((range.max() + _pageSize - Vector2i{1})/_pageSize, Vector2i{0}, pageCount);
+
+    for(Int y = min.y(); y < max.y(); ++y)
+        for(Int x = min.x(); x < max.x(); ++x)
+            _lastRequested[pageIndex(level, {x, y})] = _frame;
+}
+
+std::size_t SparseTextureResidency::update(void(*const callback)(Int, const Range2Di&, bool, void*), void* const userData) {
+    std::size_t changed = 0;
+    for(Int level = 0; level != _levelCount; ++level) {
+        const Vector2i size = levelSize(_size, level);
+        const Vector2i pageCount = levelPageCount(_size, _pageSize, level);
+        for(Int y = 0; y != pageCount.y(); ++y) for(Int x = 0; x != pageCount.x(); ++x) {
+            const std::size_t i = pageIndex(level, {x, y});
+
+            /* Commit pages requested in this frame that aren't resident
+               yet, uncommit resident pages that weren't requested for long
+               enough. The frame counter starts at one so _frame minus the
+               delay never wraps around for pages that were requested at
+               least once. */
+            bool commit;
+            if(_lastRequested[i] == _frame) {
+                if(_resident[i]) continue;
+                commit = true;
+            } else {
+                if(!_resident[i] || _frame - _lastRequested[i] <= _evictionDelay) continue;
+                commit = false;
+            }
+
+            const Vector2i min = Vector2i{x, y}*_pageSize;
+            callback(level, {min, Math::min(min + _pageSize, size)}, commit, userData);
+            _resident[i] = commit;
+            if(commit) ++_residentPageCount;
+            else --_residentPageCount;
+            ++changed;
+        }
+    }
+
+    ++_frame;
+    return changed;
+}
+
+std::size_t SparseTextureResidency::update(Texture2D& texture) {
+    return update([](const Int level, const Range2Di& range, const bool commit, void* const userData) {
+        Texture2D& texture = *static_cast<Texture2D*>(userData);
+        if(commit) texture.commitPages(level, range);
+        else texture.uncommitPages(level, range);
+    }, &texture);
+}
+
+}}
@@ -0,0 +1,207 @@
+#ifndef Magnum_GL_SparseTextureResidency_h
+#define Magnum_GL_SparseTextureResidency_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MAGNUM_TARGET_GLES
+/** @file
+ * @brief Class @ref Magnum::GL::SparseTextureResidency
+ * @m_since_latest
+ */
+#endif
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/GL/GL.h"
+#include "Magnum/GL/visibility.h"
+#include "Magnum/Math/Vector2.h"
+
+#ifndef MAGNUM_TARGET_GLES
+namespace Magnum { namespace GL {
+
+/**
+@brief Page residency tracker for sparse textures
+@m_since_latest
+
+Keeps track of which pages of a @ref Texture2D made sparse with
+@ref Texture::setSparse() are committed and which are actually needed. Each
+frame, the pages needed for rendering are marked with @ref request() --- for
+example based on a feedback pass that renders page coordinates of visible
+texels into a small framebuffer --- and @ref update() then commits the newly
+requested pages and uncommits pages that weren't requested for more than
+@ref evictionDelay() updates:
+
+@snippet MagnumGL.cpp SparseTextureResidency-usage
+
+The class only does the bookkeeping, uploading data to newly committed pages
+is up to the application. Apart from @ref update(Texture2D&), which calls
+@ref Texture::commitPages() and @ref Texture::uncommitPages(), there's also an
+@ref update(void(*)(Int, const Range2Di&, bool, void*), void*) overload
+that reports the changes through a callback, which can be used to upload the
+page data right after committing it or to drive a different texture type such
+as a @ref Texture2DArray layer.
+
+Mip levels are tracked separately, pages at the right and bottom edge of a
+level that's not a multiple of the page size are smaller, the ranges passed to
+the texture are clamped to the level size. Only levels up to
+@ref Texture::sparseLevelCount() should be tracked, the remaining levels form
+a mip tail that's committed together with the last sparse level.
+@requires_extension Extension @gl_extension{ARB,sparse_texture}
+@requires_gl Sparse textures are not available in OpenGL ES and WebGL.
+*/
+class MAGNUM_GL_EXPORT SparseTextureResidency {
+    public:
+        /**
+         * @brief Constructor
+         * @param size          Texture size in pixels. Expected to be
+         *      non-zero.
+         * @param pageSize      Page size in pixels, usually
+         *      @ref Texture::virtualPageSize(). Expected to be non-zero.
+         * @param levelCount    Count of tracked mip levels. Expected to be
+         *      non-zero.
+         * @param evictionDelay How many @ref update() calls a page stays
+         *      committed after it was last requested
+         *
+         * All pages are initially treated as not committed.
+         */
+        explicit SparseTextureResidency(const Vector2i& size, const Vector2i& pageSize, Int levelCount, UnsignedInt evictionDelay = 0);
+
+        /** @brief Copying is not allowed */
+        SparseTextureResidency(const SparseTextureResidency&) = delete;
+
+        /** @brief Move constructor */
+        SparseTextureResidency(SparseTextureResidency&&) noexcept;
+
+        ~SparseTextureResidency();
+
+        /** @brief Copying is not allowed */
+        SparseTextureResidency& operator=(const SparseTextureResidency&) = delete;
+
+        /** @brief Move assignment */
+        SparseTextureResidency& operator=(SparseTextureResidency&&) noexcept;
+
+        /** @brief Texture size */
+        Vector2i size() const { return _size; }
+
+        /** @brief Page size */
+        Vector2i pageSize() const { return _pageSize; }
+
+        /** @brief Count of tracked mip levels */
+        Int levelCount() const { return _levelCount; }
+
+        /** @brief Eviction delay */
+        UnsignedInt evictionDelay() const { return _evictionDelay; }
+
+        /**
+         * @brief Count of pages in given mip level
+         *
+         * Expects that @p level is less than @ref levelCount().
+         */
+        Vector2i pageCount(Int level) const;
+
+        /** @brief Count of committed pages in all levels */
+        std::size_t residentPageCount() const { return _residentPageCount; }
+
+        /**
+         * @brief Whether given page is committed
+         *
+         * Expects that @p level is less than @ref levelCount() and @p page
+         * is less than @ref pageCount() for given level.
+         */
+        bool isResident(Int level, const Vector2i& page) const;
+
+        /**
+         * @brief Whether given page was requested since the last update
+         *
+         * Expects that @p level is less than @ref levelCount() and @p page
+         * is less than @ref pageCount() for given level.
+         */
+        bool isRequested(Int level, const Vector2i& page) const;
+
+        /**
+         * @brief Request a page
+         *
+         * Marks the page as needed in the current frame. Expects that
+         * @p level is less than @ref levelCount() and @p page is less than
+         * @ref pageCount() for given level.
+         */
+        void request(Int level, const Vector2i& page);
+
+        /**
+         * @brief Request all pages covering a pixel range
+         *
+         * Marks all pages overlapping @p range in given level as needed in
+         * the current frame. Parts of the range outside of the level are
+         * ignored. Expects that @p level is less than @ref levelCount().
+         */
+        void request(Int level, const Range2Di& range);
+
+        /**
+         * @brief Update page residency
+         * @param callback      Function to call for each changed page
+         * @param userData      User data passed to @p callback
+         * @return Count of pages that were committed or uncommitted
+         *
+         * Calls @p callback with @cpp commit @ce set to @cpp true @ce for
+         * all requested pages that aren't committed yet and with
+         * @cpp false @ce for all committed pages that weren't requested in
+         * this and the last @ref evictionDelay() updates. The range is in
+         * pixels of given level, clamped to its size. Then starts a new
+         * frame, resetting the requests.
+         */
+        std::size_t update(void(*callback)(Int level, const Range2Di& range, bool commit, void* userData), void* userData);
+
+        /**
+         * @brief Update page residency of a texture
+         * @return Count of pages that were committed or uncommitted
+         *
+         * Calls @ref Texture::commitPages() and
+         * @ref Texture::uncommitPages() on @p texture for the changed pages.
+         * See @ref update(void(*)(Int, const Range2Di&, bool, void*), void*)
+         * for more information.
+         */
+        std::size_t update(Texture2D& texture);
+
+    private:
+        std::size_t pageIndex(Int level, const Vector2i& page) const;
+
+        Vector2i _size, _pageSize;
+        Int _levelCount;
+        UnsignedInt _evictionDelay;
+        /* Frame numbers start from 1, 0 means the page was never requested */
+        UnsignedInt _frame;
+        std::size_t _residentPageCount;
+        /* Offset of each level in the page arrays, the last item is the
+           total page count */
+        Containers::Array<std::size_t> _levelOffsets;
+        Containers::Array<UnsignedInt> _lastRequested;
+        Containers::Array<bool> _resident;
+};
+
+}}
+#else
+#error this header is not available in OpenGL ES build
+#endif
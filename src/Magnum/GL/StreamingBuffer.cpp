@@ -0,0 +1,150 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "StreamingBuffer.h"
+
+#include <utility>
+#include <Corrade/Utility/Assert.h>
+
+namespace Magnum { namespace GL {
+
+namespace {
+    /* If more fences than this are pending, fence() waits for the oldest */
+    constexpr std::size_t MaxFenceCount = 16;
+}
+
+struct StreamingBuffer::Fence {
+    GLsync sync;
+    /* Value of _head at the time the fence was inserted */
+    UnsignedLong end;
+};
+
+StreamingBuffer::StreamingBuffer(const std::size_t size, const std::size_t alignment): _buffer{Buffer::TargetHint::Uniform}, _data{}, _size{size}, _alignment{alignment}, _head{}, _retired{}, _fences{ValueInit, MaxFenceCount}, _fenceBegin{}, _fenceCount{} {
+    CORRADE_ASSERT(alignment,
+        "GL::StreamingBuffer: expected a non-zero alignment", );
+    CORRADE_ASSERT(size && size % alignment == 0,
+        "GL::StreamingBuffer: expected a non-zero size that's a multiple of" << alignment << "but got" << size, );
+
+    _buffer.setStorage(size, Buffer::StorageFlag::MapWrite|Buffer::StorageFlag::MapPersistent|Buffer::StorageFlag::MapCoherent);
+    _data = _buffer.map(0, size, Buffer::MapFlag::Write|Buffer::MapFlag::Persistent|Buffer::MapFlag::Coherent).data();
+}
+
+StreamingBuffer::StreamingBuffer(NoCreateT) noexcept: _buffer{NoCreate}, _data{}, _size{}, _alignment{1}, _head{}, _retired{}, _fenceBegin{}, _fenceCount{} {}
+
+StreamingBuffer::StreamingBuffer(StreamingBuffer&& other) noexcept: _buffer{std::move(other._buffer)}, _data{other._data}, _size{other._size}, _alignment{other._alignment}, _head{other._head}, _retired{other._retired}, _fences{std::move(other._fences)}, _fenceBegin{other._fenceBegin}, _fenceCount{other._fenceCount} {
+    other._data = nullptr;
+    other._size = 0;
+    other._fenceCount = 0;
+}
+
+StreamingBuffer::~StreamingBuffer() {
+    for(std::size_t i = 0; i != _fenceCount; ++i)
+        glDeleteSync(_fences[(_fenceBegin + i) % _fences.size()].sync);
+}
+
+StreamingBuffer& StreamingBuffer::operator=(StreamingBuffer&& other) noexcept {
+    using std::swap;
+    swap(_buffer, other._buffer);
+    swap(_data, other._data);
+    swap(_size, other._size);
+    swap(_alignment, other._alignment);
+    swap(_head, other._head);
+    swap(_retired, other._retired);
+    swap(_fences, other._fences);
+    swap(_fenceBegin, other._fenceBegin);
+    swap(_fenceCount, other._fenceCount);
+    return *this;
+}
+
+void StreamingBuffer::waitForOldestFence() {
+    Fence& fence = _fences[_fenceBegin];
+
+    /* Flush on the first wait so the fence isn't waited on forever if it
+       wasn't submitted yet, then wait for a second at a time */
+    GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+    for(;;) {
+        const GLenum result = glClientWaitSync(fence.sync, flags, 1000000000ull);
+        if(result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED)
+            break;
+        /* Would only happen with an invalid sync object or context loss,
+           retrying in that case doesn't make sense */
+        if(result == GL_WAIT_FAILED)
+            break;
+        flags = 0;
+    }
+
+    glDeleteSync(fence.sync);
+    _retired = fence.end;
+    _fenceBegin = (_fenceBegin + 1) % _fences.size();
+    --_fenceCount;
+}
+
+Containers::ArrayView<char> StreamingBuffer::allocate(const std::size_t size) {
+    CORRADE_ASSERT(size <= _size,
+        "GL::StreamingBuffer::allocate(): can't allocate" << size << "bytes in a buffer of" << _size << "bytes", {});
+
+    /* Align the start and move to the next round if it wouldn't fit before
+       the end. As the size is a multiple of the alignment, the next round
+       start is aligned as well. */
+    UnsignedLong start = (_head + _alignment - 1)/_alignment*_alignment;
+    if(start % _size + size > _size)
+        start = (start/_size + 1)*_size;
+    const UnsignedLong end = start + size;
+
+    /* Wait until the GPU doesn't use anything in the range anymore */
+    while(end - _retired > _size) {
+        CORRADE_ASSERT(_fenceCount,
+            "GL::StreamingBuffer::allocate(): can't allocate" << size << "bytes, only" << (_size - (_head - _retired)) << "bytes left until the next fence()", {});
+        waitForOldestFence();
+    }
+
+    _head = end;
+    return {_data + start % _size, size};
+}
+
+GLintptr StreamingBuffer::offset(const Containers::ArrayView<const char> allocation) const {
+    CORRADE_ASSERT(allocation.data() >= _data && allocation.data() + allocation.size() <= _data + _size,
+        "GL::StreamingBuffer::offset(): allocation not from this buffer", {});
+    return allocation.data() - _data;
+}
+
+StreamingBuffer& StreamingBuffer::bind(const Buffer::Target target, const UnsignedInt index, const Containers::ArrayView<const char> allocation) {
+    _buffer.bind(target, index, offset(allocation), allocation.size());
+    return *this;
+}
+
+StreamingBuffer& StreamingBuffer::fence() {
+    /* Nothing new allocated since the last fence, nothing to do */
+    if(_head == (_fenceCount ? _fences[(_fenceBegin + _fenceCount - 1) % _fences.size()].end : _retired))
+        return *this;
+
+    if(_fenceCount == _fences.size()) waitForOldestFence();
+
+    _fences[(_fenceBegin + _fenceCount) % _fences.size()] = Fence{glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0), _head};
+    ++_fenceCount;
+    return *this;
+}
+
+}}
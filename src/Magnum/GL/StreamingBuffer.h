@@ -0,0 +1,202 @@
+#ifndef Magnum_GL_StreamingBuffer_h
+#define Magnum_GL_StreamingBuffer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MAGNUM_TARGET_GLES
+/** @file
+ * @brief Class @ref Magnum::GL::StreamingBuffer
+ * @m_since_latest
+ */
+#endif
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/GL/Buffer.h"
+
+#ifndef MAGNUM_TARGET_GLES
+namespace Magnum { namespace GL {
+
+/**
+@brief Persistently mapped ring buffer for streaming data
+@m_since_latest
+
+Wraps an immutable @ref Buffer that is persistently mapped for writing and
+hands out sub-allocations from it in a ring fashion. It's meant for data that
+change every frame, such as per-draw uniforms or dynamic vertex data, and
+replaces @ref Buffer::setSubData() calls. Those can cause the driver to stall
+if the GPU is still using the previous contents of the buffer.
+
+@section GL-StreamingBuffer-usage Usage
+
+Create the buffer with a size large enough for a few frames worth of data
+and with an alignment satisfying the intended use, for example
+@ref Buffer::uniformOffsetAlignment() for uniform buffers. Then each
+@ref allocate() call returns a view that can be written to directly and that
+can be bound with @ref bind() or used with any API taking the @ref buffer()
+together with @ref offset(). When the GPU commands using the data are
+submitted, call @ref fence():
+
+@snippet MagnumGL.cpp StreamingBuffer-usage
+
+The allocations are placed one after another and wrap around to the
+beginning once the end of the buffer is reached. Before a range still used
+by the GPU is handed out again, the allocation waits on the fence inserted
+after its use. With the buffer large enough to cover the frames in flight
+the wait is thus usually a no-op. As the mapping is coherent, there's no need
+to flush the written ranges.
+
+At most 16 fences can be pending at a time. If @ref fence() is called when
+all of them are in use, it waits for the oldest one to be signaled first.
+Calling @ref fence() with nothing allocated since the previous call does
+nothing.
+@requires_gl44 Extension @gl_extension{ARB,buffer_storage}
+@requires_gl Buffer storage is not available in OpenGL ES and WebGL.
+*/
+class MAGNUM_GL_EXPORT StreamingBuffer {
+    public:
+        /**
+         * @brief Constructor
+         * @param size          Buffer size in bytes
+         * @param alignment     Alignment of all allocations in bytes.
+         *      Expected to be non-zero and @p size is expected to be a
+         *      multiple of it.
+         *
+         * Creates a buffer with @ref Buffer::StorageFlag::MapWrite,
+         * @relativeref{Buffer::StorageFlag,MapPersistent} and
+         * @relativeref{Buffer::StorageFlag,MapCoherent} and maps it whole.
+         * @see @ref Buffer::setStorage(), @ref Buffer::map(),
+         *      @fn_gl_keyword{FenceSync}
+         */
+        explicit StreamingBuffer(std::size_t size, std::size_t alignment = 1);
+
+        /**
+         * @brief Construct without creating the underlying OpenGL object
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         *
+         * This function can be safely used for constructing (and later
+         * destructing) objects even without any OpenGL context being active.
+         * However note that this is a low-level and a potentially dangerous
+         * API, see the documentation of @ref NoCreate for alternatives.
+         */
+        explicit StreamingBuffer(NoCreateT) noexcept;
+
+        /** @brief Copying is not allowed */
+        StreamingBuffer(const StreamingBuffer&) = delete;
+
+        /** @brief Move constructor */
+        StreamingBuffer(StreamingBuffer&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Deletes all pending fences together with the buffer. Doesn't wait
+         * for the fences.
+         * @see @fn_gl_keyword{DeleteSync}
+         */
+        ~StreamingBuffer();
+
+        /** @brief Copying is not allowed */
+        StreamingBuffer& operator=(const StreamingBuffer&) = delete;
+
+        /** @brief Move assignment */
+        StreamingBuffer& operator=(StreamingBuffer&& other) noexcept;
+
+        /** @brief Underlying buffer */
+        Buffer& buffer() { return _buffer; }
+
+        /** @brief Buffer size in bytes */
+        std::size_t size() const { return _size; }
+
+        /** @brief Alignment of all allocations in bytes */
+        std::size_t alignment() const { return _alignment; }
+
+        /**
+         * @brief Allocate a range of the buffer
+         * @param size      Allocation size in bytes. Expected to not be
+         *      larger than @ref size().
+         *
+         * Returns a view into the mapped memory, aligned to @ref alignment().
+         * If the range is still used by the GPU, waits for the corresponding
+         * fence to be signaled first. Expects that the allocation fits into
+         * the buffer together with everything allocated since the last
+         * @ref fence() call, as such data can't be waited on.
+         * @see @ref offset(), @fn_gl_keyword{ClientWaitSync}
+         */
+        Containers::ArrayView<char> allocate(std::size_t size);
+
+        /**
+         * @brief Offset of an allocation in the buffer
+         *
+         * Expects that @p allocation is a view returned from
+         * @ref allocate().
+         */
+        GLintptr offset(Containers::ArrayView<const char> allocation) const;
+
+        /**
+         * @brief Bind an allocation to given binding index
+         * @return Reference to self (for method chaining)
+         *
+         * Equivalent to calling @ref Buffer::bind(Buffer::Target, UnsignedInt, GLintptr, GLsizeiptr)
+         * on @ref buffer() with @ref offset() and size of @p allocation.
+         */
+        StreamingBuffer& bind(Buffer::Target target, UnsignedInt index, Containers::ArrayView<const char> allocation);
+
+        /**
+         * @brief Insert a fence
+         * @return Reference to self (for method chaining)
+         *
+         * Marks everything allocated so far as used by GPU commands
+         * submitted until now. Call after submitting the commands that use
+         * the allocated data, usually once per frame.
+         * @see @fn_gl_keyword{FenceSync}
+         */
+        StreamingBuffer& fence();
+
+    private:
+        struct Fence;
+
+        MAGNUM_GL_LOCAL void waitForOldestFence();
+
+        Buffer _buffer;
+        char* _data;
+        std::size_t _size, _alignment;
+        /* Monotonically increasing positions, wrapping around the buffer
+           size. Everything before _retired isn't used by the GPU anymore. */
+        UnsignedLong _head, _retired;
+        /* Fixed-size ring of pending fences */
+        Containers::Array<Fence> _fences;
+        std::size_t _fenceBegin, _fenceCount;
+};
+
+}}
+#else
+#error this header is not available in OpenGL ES build
+#endif
+
+#endif
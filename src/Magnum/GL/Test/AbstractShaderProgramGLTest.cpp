@@ -29,10 +29,16 @@
 #include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Resource.h>
+#include <Corrade/Utility/System.h>
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Utility/Path.h>
+#endif
 
 #include "Magnum/Image.h"
 #include "Magnum/ImageView.h"
 #include "Magnum/GL/AbstractShaderProgram.h"
+#include "Magnum/GL/Buffer.h"
 #include "Magnum/GL/Context.h"
 #include "Magnum/GL/Extensions.h"
 #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
@@ -51,6 +57,8 @@
 #include <Corrade/Containers/String.h>
 #endif
 
+#include "configure.h"
+
 namespace Magnum { namespace GL { namespace Test { namespace {
 
 struct AbstractShaderProgramGLTest: OpenGLTester {
@@ -64,6 +72,7 @@ struct AbstractShaderProgramGLTest: OpenGLTester {
     #endif
 
     void create();
+    void createAsync();
     void createMultipleOutputs();
     #ifndef MAGNUM_TARGET_GLES
     void createMultipleOutputsIndexed();
@@ -71,6 +80,9 @@ struct AbstractShaderProgramGLTest: OpenGLTester {
 
     void linkFailure();
     void uniformNotFound();
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    void binaryCache();
+    #endif
 
     void uniform();
     void uniformVector();
@@ -94,6 +106,16 @@ struct AbstractShaderProgramGLTest: OpenGLTester {
     #endif
 };
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+const struct {
+    const char* name;
+    bool indirect;
+} ComputeData[]{
+    {"", false},
+    {"indirect", true}
+};
+#endif
+
 AbstractShaderProgramGLTest::AbstractShaderProgramGLTest() {
     addTests({&AbstractShaderProgramGLTest::construct,
               &AbstractShaderProgramGLTest::constructMove,
@@ -103,6 +125,7 @@ AbstractShaderProgramGLTest::AbstractShaderProgramGLTest() {
               #endif
 
               &AbstractShaderProgramGLTest::create,
+              &AbstractShaderProgramGLTest::createAsync,
               &AbstractShaderProgramGLTest::createMultipleOutputs,
               #ifndef MAGNUM_TARGET_GLES
               &AbstractShaderProgramGLTest::createMultipleOutputsIndexed,
@@ -110,6 +133,9 @@ AbstractShaderProgramGLTest::AbstractShaderProgramGLTest() {
 
               &AbstractShaderProgramGLTest::linkFailure,
               &AbstractShaderProgramGLTest::uniformNotFound,
+              #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+              &AbstractShaderProgramGLTest::binaryCache,
+              #endif
 
               &AbstractShaderProgramGLTest::uniform,
               &AbstractShaderProgramGLTest::uniformVector,
@@ -126,12 +152,13 @@ AbstractShaderProgramGLTest::AbstractShaderProgramGLTest() {
               &AbstractShaderProgramGLTest::createUniformBlocks,
               &AbstractShaderProgramGLTest::uniformBlockIndexNotFound,
               &AbstractShaderProgramGLTest::uniformBlock,
-
-              #ifndef MAGNUM_TARGET_WEBGL
-              &AbstractShaderProgramGLTest::compute
-              #endif
               #endif
               });
+
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    addInstancedTests({&AbstractShaderProgramGLTest::compute},
+        Containers::arraySize(ComputeData));
+    #endif
 }
 
 using namespace Containers::Literals;
@@ -205,10 +232,16 @@ struct MyPublicShader: AbstractShaderProgram {
     using AbstractShaderProgram::bindFragmentDataLocation;
     #endif
     using AbstractShaderProgram::link;
+    using AbstractShaderProgram::submitLink;
+    using AbstractShaderProgram::checkLink;
     using AbstractShaderProgram::uniformLocation;
     #ifndef MAGNUM_TARGET_GLES2
     using AbstractShaderProgram::uniformBlockIndex;
     #endif
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    using AbstractShaderProgram::loadCachedBinary;
+    using AbstractShaderProgram::saveCachedBinary;
+    #endif
 };
 
 void AbstractShaderProgramGLTest::create() {
@@ -276,6 +309,60 @@ void AbstractShaderProgramGLTest::create() {
     CORRADE_VERIFY(additionsUniform >= 0);
 }
 
+void AbstractShaderProgramGLTest::createAsync() {
+    Utility::Resource rs("AbstractShaderProgramGLTest");
+
+    Shader vert(
+        #ifndef MAGNUM_TARGET_GLES
+        #ifndef CORRADE_TARGET_APPLE
+        Version::GL210
+        #else
+        Version::GL310
+        #endif
+        #else
+        Version::GLES200
+        #endif
+        , Shader::Type::Vertex);
+    vert.addSource(rs.getString("MyShader.vert"));
+    vert.submitCompile();
+
+    Shader frag(
+        #ifndef MAGNUM_TARGET_GLES
+        #ifndef CORRADE_TARGET_APPLE
+        Version::GL210
+        #else
+        Version::GL310
+        #endif
+        #else
+        Version::GLES200
+        #endif
+        , Shader::Type::Fragment);
+    frag.addSource(rs.getString("MyShader.frag"));
+    frag.submitCompile();
+
+    MyPublicShader program;
+    program.attachShaders({vert, frag});
+    program.bindAttributeLocation(0, "position");
+    program.submitLink();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Without the extension it's always finished immediately */
+    if(!Context::current().isExtensionSupported<Extensions::KHR::parallel_shader_compile>())
+        CORRADE_VERIFY(program.isLinkFinished());
+    else while(!program.isLinkFinished())
+        Utility::System::sleep(10);
+
+    CORRADE_VERIFY(vert.checkCompile());
+    CORRADE_VERIFY(frag.checkCompile());
+    CORRADE_VERIFY(program.checkLink());
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    const Int matrixUniform = program.uniformLocation("matrix");
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(matrixUniform >= 0);
+}
+
 void AbstractShaderProgramGLTest::createMultipleOutputs() {
     #ifndef MAGNUM_TARGET_GLES
     if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::gpu_shader4>())
@@ -460,6 +547,140 @@ void AbstractShaderProgramGLTest::uniformNotFound() {
         "GL::AbstractShaderProgram: location of uniform 'another' cannot be retrieved\n");
 }
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+void AbstractShaderProgramGLTest::binaryCache() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::ARB::get_program_binary>())
+        CORRADE_SKIP(Extensions::ARB::get_program_binary::string() << "is not supported.");
+    #endif
+
+    GLint formatCount;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+    if(!formatCount)
+        CORRADE_SKIP("The driver supports no program binary formats.");
+
+    /* Start with an empty cache so leftovers from previous runs don't affect
+       the test */
+    const Containers::String directory = Utility::Path::join(ABSTRACTSHADERPROGRAMGLTEST_SAVE_DIR, "binary-cache");
+    if(Utility::Path::exists(directory)) {
+        Containers::Optional<Containers::Array<Containers::String>> files = Utility::Path::list(directory, Utility::Path::ListFlag::SkipDirectories);
+        CORRADE_VERIFY(files);
+        for(const Containers::String& file: *files)
+            CORRADE_VERIFY(Utility::Path::remove(Utility::Path::join(directory, file)));
+    }
+
+    CORRADE_COMPARE(AbstractShaderProgram::binaryCacheDirectory(), "");
+    AbstractShaderProgram::setBinaryCacheDirectory(directory);
+    CORRADE_COMPARE(AbstractShaderProgram::binaryCacheDirectory(), directory);
+
+    Shader vert(
+        #ifndef MAGNUM_TARGET_GLES
+        #ifndef CORRADE_TARGET_APPLE
+        Version::GL210
+        #else
+        Version::GL310
+        #endif
+        #else
+        Version::GLES200
+        #endif
+        , Shader::Type::Vertex);
+    Shader frag(
+        #ifndef MAGNUM_TARGET_GLES
+        #ifndef CORRADE_TARGET_APPLE
+        Version::GL210
+        #else
+        Version::GL310
+        #endif
+        #else
+        Version::GLES200
+        #endif
+        , Shader::Type::Fragment);
+    vert.addSource("void main() { gl_Position = vec4(0.0); }");
+    frag.addSource(
+        #if !defined(CORRADE_TARGET_APPLE) || defined(MAGNUM_TARGET_GLES)
+        "void main() { gl_FragColor = vec4(1.0); }"
+        #else
+        "out vec4 color;\n"
+        "void main() { color = vec4(1.0); }"
+        #endif
+        );
+
+    /* Not cached yet, gets compiled, linked and saved */
+    {
+        MyPublicShader program;
+        CORRADE_VERIFY(!program.loadCachedBinary({vert, frag}));
+        MAGNUM_VERIFY_NO_GL_ERROR();
+
+        CORRADE_VERIFY(Shader::compile({vert, frag}));
+        program.attachShaders({vert, frag});
+        CORRADE_VERIFY(program.link());
+        CORRADE_VERIFY(program.saveCachedBinary({vert, frag}));
+        MAGNUM_VERIFY_NO_GL_ERROR();
+    }
+
+    /* Now it gets loaded without compiling or linking anything */
+    {
+        MyPublicShader program;
+        CORRADE_VERIFY(program.loadCachedBinary({vert, frag}));
+        MAGNUM_VERIFY_NO_GL_ERROR();
+
+        GLint success;
+        glGetProgramiv(program.id(), GL_LINK_STATUS, &success);
+        CORRADE_VERIFY(success);
+    }
+
+    /* Different sources are a different cache entry */
+    {
+        Shader anotherFrag(
+            #ifndef MAGNUM_TARGET_GLES
+            #ifndef CORRADE_TARGET_APPLE
+            Version::GL210
+            #else
+            Version::GL310
+            #endif
+            #else
+            Version::GLES200
+            #endif
+            , Shader::Type::Fragment);
+        anotherFrag.addSource(
+            #if !defined(CORRADE_TARGET_APPLE) || defined(MAGNUM_TARGET_GLES)
+            "void main() { gl_FragColor = vec4(0.5); }"
+            #else
+            "out vec4 color;\n"
+            "void main() { color = vec4(0.5); }"
+            #endif
+            );
+
+        MyPublicShader program;
+        CORRADE_VERIFY(!program.loadCachedBinary({vert, anotherFrag}));
+        MAGNUM_VERIFY_NO_GL_ERROR();
+    }
+
+    /* A corrupted file is rejected, falling back to compilation */
+    {
+        Containers::Optional<Containers::Array<Containers::String>> files = Utility::Path::list(directory, Utility::Path::ListFlag::SkipDirectories);
+        CORRADE_VERIFY(files);
+        CORRADE_COMPARE(files->size(), 1);
+        const char garbage[]{"MGPB\x00\x00\x00\x00garbage"};
+        CORRADE_VERIFY(Utility::Path::write(Utility::Path::join(directory, (*files)[0]), Containers::arrayView(garbage)));
+
+        MyPublicShader program;
+        CORRADE_VERIFY(!program.loadCachedBinary({vert, frag}));
+        MAGNUM_VERIFY_NO_GL_ERROR();
+    }
+
+    /* Disabling the cache makes it not load anything */
+    AbstractShaderProgram::setBinaryCacheDirectory({});
+    CORRADE_COMPARE(AbstractShaderProgram::binaryCacheDirectory(), "");
+    {
+        MyPublicShader program;
+        CORRADE_VERIFY(!program.loadCachedBinary({vert, frag}));
+        CORRADE_VERIFY(!program.saveCachedBinary({vert, frag}));
+        MAGNUM_VERIFY_NO_GL_ERROR();
+    }
+}
+#endif
+
 struct MyShader: AbstractShaderProgram {
     explicit MyShader();
 
@@ -815,6 +1036,9 @@ void AbstractShaderProgramGLTest::uniformBlock() {
 
 #ifndef MAGNUM_TARGET_WEBGL
 void AbstractShaderProgramGLTest::compute() {
+    auto&& data = ComputeData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
     #ifndef MAGNUM_TARGET_GLES
     if(!Context::current().isExtensionSupported<Extensions::ARB::compute_shader>())
         CORRADE_SKIP(Extensions::ARB::compute_shader::string() << "is not supported.");
@@ -875,18 +1099,23 @@ void AbstractShaderProgramGLTest::compute() {
 
     MAGNUM_VERIFY_NO_GL_ERROR();
 
-    shader.setImages(in, out)
-        .dispatchCompute({1, 1, 1});
+    shader.setImages(in, out);
+    if(data.indirect) {
+        /* Put the workgroup count at an offset to verify it's used */
+        const UnsignedInt workgroupCount[]{0xffffffffu, 1, 1, 1};
+        Buffer buffer{Buffer::TargetHint::DispatchIndirect, workgroupCount};
+        shader.dispatchComputeIndirect(buffer, 4);
+    } else shader.dispatchCompute({1, 1, 1});
 
     MAGNUM_VERIFY_NO_GL_ERROR();
 
     /** @todo Test on ES */
     #ifndef MAGNUM_TARGET_GLES
-    const auto data = out.image(0, {PixelFormat::RGBAInteger, PixelType::UnsignedByte}).release();
+    const auto image = out.image(0, {PixelFormat::RGBAInteger, PixelType::UnsignedByte}).release();
 
     MAGNUM_VERIFY_NO_GL_ERROR();
 
-    CORRADE_COMPARE_AS(Containers::arrayCast<const Color4ub>(data),
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Color4ub>(image),
         Containers::arrayView(outData),
         TestSuite::Compare::Container);
     #endif
@@ -55,6 +55,7 @@ struct BufferGLTest: OpenGLTester {
     #ifndef MAGNUM_TARGET_GLES2
     void bindBase();
     void bindRange();
+    void bindRangeStateTracking();
     #endif
 
     #ifndef MAGNUM_TARGET_GLES
@@ -87,6 +88,7 @@ BufferGLTest::BufferGLTest() {
               #ifndef MAGNUM_TARGET_GLES2
               &BufferGLTest::bindBase,
               &BufferGLTest::bindRange,
+              &BufferGLTest::bindRangeStateTracking,
               #endif
 
               #ifndef MAGNUM_TARGET_GLES
@@ -261,6 +263,67 @@ void BufferGLTest::bindRange() {
 
     MAGNUM_VERIFY_NO_GL_ERROR();
 }
+
+void BufferGLTest::bindRangeStateTracking() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(Extensions::ARB::uniform_buffer_object::string() << "is not supported.");
+    #endif
+
+    Buffer buffer;
+    buffer.setData({nullptr, 1024}, BufferUsage::StaticDraw)
+         .bind(Buffer::Target::Uniform, 3, 256, 64);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    GLint id, offset;
+    glGetIntegeri_v(GL_UNIFORM_BUFFER_BINDING, 3, &id);
+    glGetIntegeri_v(GL_UNIFORM_BUFFER_START, 3, &offset);
+    CORRADE_COMPARE(GLuint(id), buffer.id());
+    CORRADE_COMPARE(offset, 256);
+
+    /* Unbinding behind the tracker's back and binding the same range again
+       is a no-op, as the tracker thinks it's still bound */
+    glBindBufferBase(GL_UNIFORM_BUFFER, 3, 0);
+    buffer.bind(Buffer::Target::Uniform, 3, 256, 64);
+    glGetIntegeri_v(GL_UNIFORM_BUFFER_BINDING, 3, &id);
+    CORRADE_COMPARE(id, 0);
+
+    /* A different range is bound */
+    buffer.bind(Buffer::Target::Uniform, 3, 512, 64);
+    glGetIntegeri_v(GL_UNIFORM_BUFFER_BINDING, 3, &id);
+    glGetIntegeri_v(GL_UNIFORM_BUFFER_START, 3, &offset);
+    CORRADE_COMPARE(GLuint(id), buffer.id());
+    CORRADE_COMPARE(offset, 512);
+
+    /* After resetting the state the same range gets bound again */
+    glBindBufferBase(GL_UNIFORM_BUFFER, 3, 0);
+    Context::current().resetState(Context::State::Buffers);
+    buffer.bind(Buffer::Target::Uniform, 3, 512, 64);
+    glGetIntegeri_v(GL_UNIFORM_BUFFER_BINDING, 3, &id);
+    CORRADE_COMPARE(GLuint(id), buffer.id());
+
+    /* Unbinding through the API is tracked as well */
+    Buffer::unbind(Buffer::Target::Uniform, 3);
+    buffer.bind(Buffer::Target::Uniform, 3, 512, 64);
+    glGetIntegeri_v(GL_UNIFORM_BUFFER_BINDING, 3, &id);
+    CORRADE_COMPARE(GLuint(id), buffer.id());
+
+    /* Deleting a buffer removes it from the tracked bindings, so a new
+       buffer that possibly gets the same ID is bound again */
+    {
+        Buffer another;
+        another.setData({nullptr, 1024}, BufferUsage::StaticDraw)
+            .bind(Buffer::Target::Uniform, 4, 0, 64);
+    }
+    Buffer another;
+    another.setData({nullptr, 1024}, BufferUsage::StaticDraw)
+        .bind(Buffer::Target::Uniform, 4, 0, 64);
+    glGetIntegeri_v(GL_UNIFORM_BUFFER_BINDING, 4, &id);
+    CORRADE_COMPARE(GLuint(id), another.id());
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
 #endif
 
 #ifndef MAGNUM_TARGET_GLES
@@ -0,0 +1,420 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/GL/Buffer.h"
+#include "Magnum/GL/BufferHeap.h"
+#include "Magnum/GL/Mesh.h"
+#include "Magnum/GL/MeshView.h"
+#include "Magnum/GL/OpenGLTester.h"
+
+namespace Magnum { namespace GL { namespace Test { namespace {
+
+struct BufferHeapGLTest: OpenGLTester {
+    explicit BufferHeapGLTest();
+
+    void allocate();
+    void allocateAligned();
+    void allocateData();
+    void allocateNewBlock();
+    void blockBufferOutOfRange();
+
+    void free();
+    void freeMerge();
+
+    void attachVertices();
+    void attachIndices();
+    void attachInvalid();
+
+    void compact();
+    void compactOverlapping();
+    void compactByteLimit();
+};
+
+BufferHeapGLTest::BufferHeapGLTest() {
+    addTests({&BufferHeapGLTest::allocate,
+              &BufferHeapGLTest::allocateAligned,
+              &BufferHeapGLTest::allocateData,
+              &BufferHeapGLTest::allocateNewBlock,
+              &BufferHeapGLTest::blockBufferOutOfRange,
+
+              &BufferHeapGLTest::free,
+              &BufferHeapGLTest::freeMerge,
+
+              &BufferHeapGLTest::attachVertices,
+              &BufferHeapGLTest::attachIndices,
+              &BufferHeapGLTest::attachInvalid,
+
+              &BufferHeapGLTest::compact,
+              &BufferHeapGLTest::compactOverlapping,
+              &BufferHeapGLTest::compactByteLimit});
+}
+
+#ifndef MAGNUM_TARGET_GLES
+Containers::Array<char> blockData(BufferHeap& heap, UnsignedInt id) {
+    return heap.blockBuffer(heap.block(id)).subData(heap.offset(id), heap.size(id));
+}
+#endif
+
+void BufferHeapGLTest::allocate() {
+    BufferHeap heap{Buffer::TargetHint::Array, 256};
+
+    CORRADE_COMPARE(heap.allocate(12), 0);
+    CORRADE_COMPARE(heap.allocate(20), 1);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(heap.blockCount(), 1);
+    CORRADE_VERIFY(heap.blockBuffer(0).id());
+    CORRADE_COMPARE(heap.blockBuffer(0).size(), 256);
+    CORRADE_COMPARE(heap.allocationCount(), 2);
+    CORRADE_COMPARE(heap.usedSize(), 32);
+    CORRADE_COMPARE(heap.block(0), 0);
+    CORRADE_COMPARE(heap.offset(0), 0);
+    CORRADE_COMPARE(heap.size(0), 12);
+    CORRADE_COMPARE(heap.block(1), 0);
+    CORRADE_COMPARE(heap.offset(1), 12);
+    CORRADE_COMPARE(heap.size(1), 20);
+}
+
+void BufferHeapGLTest::allocateAligned() {
+    BufferHeap heap{Buffer::TargetHint::Array, 256};
+
+    CORRADE_COMPARE(heap.offset(heap.allocate(5, 1)), 0);
+    /* The alignment doesn't need to be a power of two, useful for vertex
+       strides */
+    CORRADE_COMPARE(heap.offset(heap.allocate(24, 12)), 12);
+    /* The padding before the previous allocation is used for a smaller
+       one */
+    CORRADE_COMPARE(heap.offset(heap.allocate(4, 4)), 8);
+    CORRADE_COMPARE(heap.offset(heap.allocate(1, 1)), 5);
+    CORRADE_COMPARE(heap.usedSize(), 34);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void BufferHeapGLTest::allocateData() {
+    BufferHeap heap{Buffer::TargetHint::Array, 256};
+
+    const char a[]{'a', 'b', 'c'};
+    const char b[]{'d', 'e', 'f', 'g', 'h'};
+    CORRADE_COMPARE(heap.allocate(a), 0);
+    CORRADE_COMPARE(heap.allocate(b), 1);
+    CORRADE_COMPARE(heap.offset(0), 0);
+    CORRADE_COMPARE(heap.offset(1), 4);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /** @todo How to verify the contents on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_COMPARE_AS(blockData(heap, 0),
+        Containers::arrayView(a),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(blockData(heap, 1),
+        Containers::arrayView(b),
+        TestSuite::Compare::Container);
+    #endif
+}
+
+void BufferHeapGLTest::allocateNewBlock() {
+    BufferHeap heap{Buffer::TargetHint::Array, 64};
+
+    CORRADE_COMPARE(heap.allocate(48), 0);
+    /* Doesn't fit into the first block anymore */
+    CORRADE_COMPARE(heap.allocate(32), 1);
+    /* Fits into the remaining space of the first block */
+    CORRADE_COMPARE(heap.allocate(16), 2);
+    /* A whole block */
+    CORRADE_COMPARE(heap.allocate(64), 3);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(heap.blockCount(), 3);
+    CORRADE_COMPARE(heap.block(0), 0);
+    CORRADE_COMPARE(heap.block(1), 1);
+    CORRADE_COMPARE(heap.offset(1), 0);
+    CORRADE_COMPARE(heap.block(2), 0);
+    CORRADE_COMPARE(heap.offset(2), 48);
+    CORRADE_COMPARE(heap.block(3), 2);
+    CORRADE_COMPARE(heap.offset(3), 0);
+    CORRADE_VERIFY(heap.blockBuffer(0).id() != heap.blockBuffer(1).id());
+}
+
+void BufferHeapGLTest::blockBufferOutOfRange() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    BufferHeap heap{Buffer::TargetHint::Array, 64};
+    heap.allocate(16);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    heap.blockBuffer(1);
+    CORRADE_COMPARE(out.str(),
+        "GL::BufferHeap::blockBuffer(): index 1 out of range for 1 blocks\n");
+}
+
+void BufferHeapGLTest::free() {
+    BufferHeap heap{Buffer::TargetHint::Array, 64};
+
+    CORRADE_COMPARE(heap.allocate(16), 0);
+    CORRADE_COMPARE(heap.allocate(16), 1);
+    CORRADE_COMPARE(heap.allocate(16), 2);
+
+    heap.free(1);
+    CORRADE_COMPARE(heap.allocationCount(), 2);
+    CORRADE_COMPARE(heap.usedSize(), 32);
+
+    /* Both the ID and the range get reused */
+    CORRADE_COMPARE(heap.allocate(8), 1);
+    CORRADE_COMPARE(heap.offset(1), 16);
+    CORRADE_COMPARE(heap.allocate(8), 3);
+    CORRADE_COMPARE(heap.offset(3), 24);
+    CORRADE_COMPARE(heap.allocationCount(), 4);
+    CORRADE_COMPARE(heap.usedSize(), 48);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void BufferHeapGLTest::freeMerge() {
+    BufferHeap heap{Buffer::TargetHint::Array, 64};
+
+    for(UnsignedInt i = 0; i != 4; ++i)
+        CORRADE_COMPARE(heap.allocate(16), i);
+
+    /* Freeing the middle two merges them with each other, freeing the last
+       one merges all three together */
+    heap.free(1);
+    heap.free(2);
+    heap.free(3);
+    CORRADE_COMPARE(heap.usedSize(), 16);
+
+    /* So the rest of the block can be allocated at once */
+    CORRADE_COMPARE(heap.offset(heap.allocate(48)), 16);
+    CORRADE_COMPARE(heap.blockCount(), 1);
+
+    /* Freeing in reverse merges the other way */
+    heap.free(0);
+    heap.free(1);
+    CORRADE_COMPARE(heap.usedSize(), 0);
+    CORRADE_COMPARE(heap.offset(heap.allocate(64)), 0);
+    CORRADE_COMPARE(heap.blockCount(), 1);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void BufferHeapGLTest::attachVertices() {
+    BufferHeap heap{Buffer::TargetHint::Array, 256};
+    Mesh mesh;
+    MeshView view{mesh};
+
+    heap.allocate(12);
+    const UnsignedInt id = heap.allocate(36, 12);
+    heap.attachVertices(id, view, 12);
+    CORRADE_COMPARE(view.baseVertex(), 1);
+
+    /* A detached view isn't updated anymore */
+    heap.detach(id);
+    heap.free(0);
+    heap.compact();
+    CORRADE_COMPARE(heap.offset(id), 0);
+    CORRADE_COMPARE(view.baseVertex(), 1);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void BufferHeapGLTest::attachIndices() {
+    BufferHeap heap{Buffer::TargetHint::ElementArray, 256};
+    heap.allocate(6);
+    const UnsignedInt id = heap.allocate(12, 2);
+
+    Mesh mesh;
+    mesh.setIndexBuffer(heap.blockBuffer(0), 0, MeshIndexType::UnsignedShort);
+    MeshView view{mesh};
+    view.setCount(6);
+
+    /* The index offset isn't exposed on the view, this only verifies it
+       doesn't assert */
+    heap.attachIndices(id, view);
+    heap.free(0);
+    CORRADE_COMPARE(heap.compact(), 12);
+    CORRADE_COMPARE(heap.offset(id), 0);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void BufferHeapGLTest::attachInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    BufferHeap heap{Buffer::TargetHint::ElementArray, 256};
+    const UnsignedInt id = heap.allocate(24, 4);
+
+    Mesh mesh;
+    MeshView view{mesh};
+    Mesh indexed;
+    indexed.setIndexBuffer(heap.blockBuffer(0), 0, MeshIndexType::UnsignedInt);
+    MeshView indexedView{indexed};
+    const UnsignedInt shortAligned = heap.allocate(24, 2);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    heap.attachVertices(id + 5, view, 12);
+    heap.attachVertices(id, view, 0);
+    heap.attachVertices(id, view, 12);
+    heap.attachIndices(id + 5, indexedView);
+    heap.attachIndices(id, view);
+    heap.attachIndices(shortAligned, indexedView);
+    CORRADE_COMPARE(out.str(),
+        "GL::BufferHeap::attachVertices(): invalid ID 5\n"
+        "GL::BufferHeap::attachVertices(): expected allocation alignment to be a multiple of the stride but got 4 and 0\n"
+        "GL::BufferHeap::attachVertices(): expected allocation alignment to be a multiple of the stride but got 4 and 12\n"
+        "GL::BufferHeap::attachIndices(): invalid ID 5\n"
+        "GL::BufferHeap::attachIndices(): the mesh is not indexed\n"
+        "GL::BufferHeap::attachIndices(): expected allocation alignment to be a multiple of the index type size but got 2 and 4\n");
+}
+
+void relocated(UnsignedInt id, void* userData) {
+    arrayAppend(*static_cast<Containers::Array<UnsignedInt>*>(userData), id);
+}
+
+void BufferHeapGLTest::compact() {
+    BufferHeap heap{Buffer::TargetHint::Array, 32};
+
+    char data[8];
+    for(std::size_t i = 0; i != 8; ++i) data[i] = char(i);
+
+    /* Fill two blocks, then free a few allocations in both */
+    Containers::Array<UnsignedInt> ids;
+    for(std::size_t i = 0; i != 8; ++i)
+        arrayAppend(ids, heap.allocate(Containers::arrayView(data).prefix(i + 1), 8));
+    CORRADE_COMPARE(heap.blockCount(), 2);
+    heap.free(ids[0]);
+    heap.free(ids[2]);
+    heap.free(ids[5]);
+
+    Mesh mesh;
+    MeshView view{mesh};
+    heap.attachVertices(ids[3], view, 4);
+    CORRADE_COMPARE(view.baseVertex(), 6);
+
+    Containers::Array<UnsignedInt> moved;
+    CORRADE_COMPARE(heap.compact(~std::size_t{}, relocated, &moved), 2 + 4 + 7 + 8);
+    CORRADE_COMPARE_AS(moved, Containers::arrayView<UnsignedInt>({
+        ids[1], ids[3], ids[6], ids[7]
+    }), TestSuite::Compare::Container);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Allocations stay in their blocks */
+    CORRADE_COMPARE(heap.block(ids[1]), 0);
+    CORRADE_COMPARE(heap.offset(ids[1]), 0);
+    CORRADE_COMPARE(heap.block(ids[3]), 0);
+    CORRADE_COMPARE(heap.offset(ids[3]), 8);
+    CORRADE_COMPARE(heap.block(ids[4]), 1);
+    CORRADE_COMPARE(heap.offset(ids[4]), 0);
+    CORRADE_COMPARE(heap.block(ids[6]), 1);
+    CORRADE_COMPARE(heap.offset(ids[6]), 8);
+    CORRADE_COMPARE(heap.block(ids[7]), 1);
+    CORRADE_COMPARE(heap.offset(ids[7]), 16);
+    CORRADE_COMPARE(view.baseVertex(), 2);
+
+    /* Compacting again doesn't move anything */
+    arrayResize(moved, 0);
+    CORRADE_COMPARE(heap.compact(~std::size_t{}, relocated, &moved), 0);
+    CORRADE_VERIFY(moved.isEmpty());
+
+    /* The free space is merged after the compaction */
+    const UnsignedInt merged = heap.allocate(20);
+    CORRADE_COMPARE(heap.block(merged), 0);
+    CORRADE_COMPARE(heap.offset(merged), 12);
+    CORRADE_COMPARE(heap.blockCount(), 2);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /** @todo How to verify the contents on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    for(std::size_t i: {1, 3, 4, 6, 7}) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE_AS(blockData(heap, ids[i]),
+            Containers::arrayView(data).prefix(i + 1),
+            TestSuite::Compare::Container);
+    }
+    #endif
+}
+
+void BufferHeapGLTest::compactOverlapping() {
+    BufferHeap heap{Buffer::TargetHint::Array, 64};
+
+    char data[40];
+    for(std::size_t i = 0; i != 40; ++i) data[i] = char(i);
+
+    /* The allocation moves by less than its size, so it has to be copied in
+       pieces */
+    const UnsignedInt a = heap.allocate(12);
+    const UnsignedInt b = heap.allocate(data);
+    heap.free(a);
+    CORRADE_COMPARE(heap.compact(), 40);
+    CORRADE_COMPARE(heap.offset(b), 0);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /** @todo How to verify the contents on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_COMPARE_AS(blockData(heap, b),
+        Containers::arrayView(data),
+        TestSuite::Compare::Container);
+    #endif
+}
+
+void BufferHeapGLTest::compactByteLimit() {
+    BufferHeap heap{Buffer::TargetHint::Array, 64};
+
+    const UnsignedInt a = heap.allocate(8);
+    const UnsignedInt b = heap.allocate(16);
+    const UnsignedInt c = heap.allocate(8);
+    const UnsignedInt d = heap.allocate(4);
+    heap.free(a);
+
+    /* The first allocation is moved even though it's over the limit */
+    CORRADE_COMPARE(heap.compact(10), 16);
+    CORRADE_COMPARE(heap.offset(b), 0);
+    CORRADE_COMPARE(heap.offset(c), 24);
+    CORRADE_COMPARE(heap.offset(d), 32);
+
+    /* The limit is large enough for one more but not for both */
+    CORRADE_COMPARE(heap.compact(10), 8);
+    CORRADE_COMPARE(heap.offset(c), 16);
+    CORRADE_COMPARE(heap.offset(d), 32);
+
+    /* The gap left by the limit can be allocated from */
+    CORRADE_COMPARE(heap.offset(heap.allocate(8)), 24);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::GL::Test::BufferHeapGLTest)
@@ -0,0 +1,135 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/GL/BufferHeap.h"
+
+namespace Magnum { namespace GL { namespace Test { namespace {
+
+struct BufferHeapTest: TestSuite::Tester {
+    explicit BufferHeapTest();
+
+    void construct();
+    void constructInvalid();
+    void constructCopy();
+    void constructMove();
+
+    void allocateInvalid();
+    void invalidId();
+};
+
+BufferHeapTest::BufferHeapTest() {
+    addTests({&BufferHeapTest::construct,
+              &BufferHeapTest::constructInvalid,
+              &BufferHeapTest::constructCopy,
+              &BufferHeapTest::constructMove,
+
+              &BufferHeapTest::allocateInvalid,
+              &BufferHeapTest::invalidId});
+}
+
+void BufferHeapTest::construct() {
+    /* No GL objects are created until the first allocation */
+    BufferHeap heap{Buffer::TargetHint::ElementArray, 65536};
+    CORRADE_COMPARE(heap.targetHint(), Buffer::TargetHint::ElementArray);
+    CORRADE_COMPARE(heap.blockSize(), 65536);
+    CORRADE_COMPARE(heap.blockCount(), 0);
+    CORRADE_COMPARE(heap.allocationCount(), 0);
+    CORRADE_COMPARE(heap.usedSize(), 0);
+}
+
+void BufferHeapTest::constructInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    BufferHeap{Buffer::TargetHint::Array, 0};
+    CORRADE_COMPARE(out.str(),
+        "GL::BufferHeap: expected a non-zero block size\n");
+}
+
+void BufferHeapTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<BufferHeap>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<BufferHeap>{});
+}
+
+void BufferHeapTest::constructMove() {
+    BufferHeap a{Buffer::TargetHint::ElementArray, 65536};
+
+    BufferHeap b = std::move(a);
+    CORRADE_COMPARE(b.targetHint(), Buffer::TargetHint::ElementArray);
+    CORRADE_COMPARE(b.blockSize(), 65536);
+
+    BufferHeap c{Buffer::TargetHint::Array, 1024};
+    c = std::move(b);
+    CORRADE_COMPARE(c.targetHint(), Buffer::TargetHint::ElementArray);
+    CORRADE_COMPARE(c.blockSize(), 65536);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<BufferHeap>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<BufferHeap>::value);
+}
+
+void BufferHeapTest::allocateInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    BufferHeap heap{Buffer::TargetHint::Array, 1024};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    heap.allocate(0);
+    heap.allocate(1025);
+    heap.allocate(16, 0);
+    CORRADE_COMPARE(out.str(),
+        "GL::BufferHeap::allocate(): expected a non-zero size not larger than 1024 but got 0\n"
+        "GL::BufferHeap::allocate(): expected a non-zero size not larger than 1024 but got 1025\n"
+        "GL::BufferHeap::allocate(): expected a non-zero alignment\n");
+}
+
+void BufferHeapTest::invalidId() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    BufferHeap heap{Buffer::TargetHint::Array, 1024};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    heap.free(0);
+    heap.block(1);
+    heap.offset(2);
+    heap.size(3);
+    heap.detach(4);
+    CORRADE_COMPARE(out.str(),
+        "GL::BufferHeap::free(): invalid ID 0\n"
+        "GL::BufferHeap::block(): invalid ID 1\n"
+        "GL::BufferHeap::offset(): invalid ID 2\n"
+        "GL::BufferHeap::size(): invalid ID 3\n"
+        "GL::BufferHeap::detach(): invalid ID 4\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::GL::Test::BufferHeapTest)
@@ -0,0 +1,185 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/GL/AbstractShaderProgram.h"
+#include "Magnum/GL/Buffer.h"
+#include "Magnum/GL/CommandRecorder.h"
+#include "Magnum/GL/Mesh.h"
+#include "Magnum/GL/MeshView.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/GL/Shader.h"
+#include "Magnum/GL/Texture.h"
+#include "Magnum/GL/Version.h"
+
+namespace Magnum { namespace GL { namespace Test { namespace {
+
+struct CommandRecorderGLTest: OpenGLTester {
+    explicit CommandRecorderGLTest();
+
+    void replay();
+    void replayOrder();
+    void replayMultiple();
+    void setBufferSubData();
+};
+
+CommandRecorderGLTest::CommandRecorderGLTest() {
+    addTests({&CommandRecorderGLTest::replay,
+              &CommandRecorderGLTest::replayOrder,
+              &CommandRecorderGLTest::replayMultiple,
+              &CommandRecorderGLTest::setBufferSubData});
+}
+
+struct PointShader: AbstractShaderProgram {
+    explicit PointShader();
+};
+
+PointShader::PointShader() {
+    #ifndef MAGNUM_TARGET_GLES
+    Shader vert(
+        #ifndef CORRADE_TARGET_APPLE
+        Version::GL210
+        #else
+        Version::GL310
+        #endif
+        , Shader::Type::Vertex);
+    Shader frag(
+        #ifndef CORRADE_TARGET_APPLE
+        Version::GL210
+        #else
+        Version::GL310
+        #endif
+        , Shader::Type::Fragment);
+    #elif defined(MAGNUM_TARGET_GLES2)
+    Shader vert(Version::GLES200, Shader::Type::Vertex);
+    Shader frag(Version::GLES200, Shader::Type::Fragment);
+    #else
+    Shader vert(Version::GLES300, Shader::Type::Vertex);
+    Shader frag(Version::GLES300, Shader::Type::Fragment);
+    #endif
+
+    vert.addSource(
+        "void main() {\n"
+        "    gl_PointSize = 1.0;\n"
+        "    gl_Position = vec4(0.0, 0.0, 0.0, 1.0);\n"
+        "}\n");
+    frag.addSource(
+        "#if (defined(GL_ES) && __VERSION__ >= 300) || (!defined(GL_ES) && __VERSION__ >= 130)\n"
+        "out lowp vec4 result;\n"
+        "#define gl_FragColor result\n"
+        "#endif\n"
+        "void main() { gl_FragColor = vec4(1.0); }\n");
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(vert.compile() && frag.compile());
+
+    attachShaders({vert, frag});
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+}
+
+void CommandRecorderGLTest::replay() {
+    PointShader shader;
+    Mesh mesh{MeshPrimitive::Points};
+    mesh.setCount(4);
+    MeshView view{mesh};
+    view.setCount(2);
+    Texture2D texture;
+
+    CommandRecorder recorder;
+    recorder.bindTexture(0, texture)
+        .draw(shader, mesh)
+        .draw(shader, view);
+    CORRADE_COMPARE(recorder.commandCount(), 3);
+
+    recorder.replay();
+    CORRADE_COMPARE(recorder.commandCount(), 0);
+    CORRADE_COMPARE(recorder.dataSize(), 0);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void CommandRecorderGLTest::replayOrder() {
+    Containers::Array<Int> called;
+
+    CommandRecorder recorder;
+    for(Int i = 0; i != 50; ++i) recorder.call([&called, i] {
+        arrayAppend(called, i*10);
+    });
+
+    recorder.replay();
+    CORRADE_COMPARE(called.size(), 50);
+    for(Int i = 0; i != 50; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(called[i], i*10);
+    }
+}
+
+void CommandRecorderGLTest::replayMultiple() {
+    Containers::Array<Int> called;
+
+    CommandRecorder a, b;
+    b.call([&called] { arrayAppend(called, 3); });
+    a.call([&called] { arrayAppend(called, 1); })
+     .call([&called] { arrayAppend(called, 2); });
+    b.call([&called] { arrayAppend(called, 4); });
+
+    /* Replayed in the order of the recorders, not of the recording */
+    CommandRecorder::replay({a, b});
+    CORRADE_COMPARE_AS(called, Containers::arrayView<Int>({
+        1, 2, 3, 4
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(a.commandCount(), 0);
+    CORRADE_COMPARE(b.commandCount(), 0);
+}
+
+void CommandRecorderGLTest::setBufferSubData() {
+    Buffer buffer;
+    buffer.setData({nullptr, 16});
+
+    /* The data are copied, so the original can go out of scope */
+    CommandRecorder recorder;
+    {
+        const Int data[]{3, 7, -15, 27};
+        recorder.setBufferSubData(buffer, 0, Containers::arrayView(data).prefix(2))
+            .setBufferSubData(buffer, 8, Containers::arrayView(data).exceptPrefix(2));
+    }
+
+    recorder.replay();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /** @todo How to verify the contents in ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_COMPARE_AS(Containers::arrayCast<Int>(buffer.data()),
+        Containers::arrayView<Int>({3, 7, -15, 27}),
+        TestSuite::Compare::Container);
+    #endif
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::GL::Test::CommandRecorderGLTest)
@@ -0,0 +1,166 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Reference.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/GL/AbstractShaderProgram.h"
+#include "Magnum/GL/Buffer.h"
+#include "Magnum/GL/CommandRecorder.h"
+#include "Magnum/GL/Mesh.h"
+#include "Magnum/GL/MeshView.h"
+#include "Magnum/GL/Texture.h"
+
+namespace Magnum { namespace GL { namespace Test { namespace {
+
+struct CommandRecorderTest: TestSuite::Tester {
+    explicit CommandRecorderTest();
+
+    void construct();
+    void constructCopy();
+    void constructMove();
+
+    void record();
+    void clear();
+    void replayNoContext();
+};
+
+CommandRecorderTest::CommandRecorderTest() {
+    addTests({&CommandRecorderTest::construct,
+              &CommandRecorderTest::constructCopy,
+              &CommandRecorderTest::constructMove,
+
+              &CommandRecorderTest::record,
+              &CommandRecorderTest::clear,
+              &CommandRecorderTest::replayNoContext});
+}
+
+struct DummyShader: AbstractShaderProgram {
+    explicit DummyShader(): AbstractShaderProgram{NoCreate} {}
+};
+
+void CommandRecorderTest::construct() {
+    CommandRecorder recorder;
+    CORRADE_COMPARE(recorder.commandCount(), 0);
+    CORRADE_COMPARE(recorder.dataSize(), 0);
+}
+
+void CommandRecorderTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<CommandRecorder>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<CommandRecorder>{});
+}
+
+void CommandRecorderTest::constructMove() {
+    DummyShader shader;
+    Mesh mesh{NoCreate};
+
+    CommandRecorder a;
+    a.draw(shader, mesh)
+     .draw(shader, mesh);
+    const std::size_t dataSize = a.dataSize();
+
+    CommandRecorder b{std::move(a)};
+    CORRADE_COMPARE(a.commandCount(), 0);
+    CORRADE_COMPARE(a.dataSize(), 0);
+    CORRADE_COMPARE(b.commandCount(), 2);
+    CORRADE_COMPARE(b.dataSize(), dataSize);
+
+    CommandRecorder c;
+    c.draw(shader, mesh);
+    c = std::move(b);
+    CORRADE_COMPARE(c.commandCount(), 2);
+    CORRADE_COMPARE(c.dataSize(), dataSize);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<CommandRecorder>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<CommandRecorder>::value);
+}
+
+void CommandRecorderTest::record() {
+    DummyShader shader;
+    Mesh mesh{NoCreate};
+    MeshView view{mesh};
+    Buffer buffer{NoCreate};
+    Texture2D texture{NoCreate};
+
+    /* None of these touch the GL context, so they work without one */
+    CommandRecorder recorder;
+    recorder.draw(shader, mesh);
+    CORRADE_COMPARE(recorder.commandCount(), 1);
+    const std::size_t drawSize = recorder.dataSize();
+    CORRADE_VERIFY(drawSize);
+
+    const char data[]{'a', 'b', 'c', 'd', 'e'};
+    recorder.draw(shader, view)
+        .setBufferSubData(buffer, 16, data)
+        .bindTexture(3, texture)
+        #ifndef MAGNUM_TARGET_GLES2
+        .bindBuffer(Buffer::Target::Uniform, 1, buffer, 0, 64)
+        #endif
+        .call([]{});
+    CORRADE_COMPARE(recorder.commandCount(),
+        #ifndef MAGNUM_TARGET_GLES2
+        6
+        #else
+        5
+        #endif
+    );
+    /* The buffer data get copied and padded */
+    CORRADE_VERIFY(recorder.dataSize() >= drawSize*4 + sizeof(data));
+    CORRADE_COMPARE(recorder.dataSize() % sizeof(void*), 0);
+}
+
+void CommandRecorderTest::clear() {
+    DummyShader shader;
+    Mesh mesh{NoCreate};
+
+    CommandRecorder recorder;
+    recorder.draw(shader, mesh)
+        .draw(shader, mesh);
+    CORRADE_COMPARE(recorder.commandCount(), 2);
+
+    recorder.clear();
+    CORRADE_COMPARE(recorder.commandCount(), 0);
+    CORRADE_COMPARE(recorder.dataSize(), 0);
+}
+
+void CommandRecorderTest::replayNoContext() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    CommandRecorder recorder;
+    recorder.call([]{});
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    recorder.replay();
+    /* The commands are kept */
+    CORRADE_COMPARE(recorder.commandCount(), 1);
+    CORRADE_COMPARE(out.str(), "GL::CommandRecorder::replay(): no current GL context\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::GL::Test::CommandRecorderTest)
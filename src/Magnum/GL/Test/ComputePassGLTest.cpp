@@ -0,0 +1,193 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/StringStl.h> /** @todo remove when Shader is <string>-free */
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/GL/AbstractShaderProgram.h"
+#include "Magnum/GL/Buffer.h"
+#include "Magnum/GL/ComputePass.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/GL/Shader.h"
+#include "Magnum/Math/Vector3.h"
+
+namespace Magnum { namespace GL { namespace Test { namespace {
+
+struct ComputePassGLTest: OpenGLTester {
+    explicit ComputePassGLTest();
+
+    void dispatch();
+    void dispatchIndirect();
+};
+
+ComputePassGLTest::ComputePassGLTest() {
+    addTests({&ComputePassGLTest::dispatch,
+              &ComputePassGLTest::dispatchIndirect});
+}
+
+/* Doubles each value of the input and writes it to the output. With the
+   same buffer bound to both it's an in-place operation. */
+struct DoubleShader: AbstractShaderProgram {
+    explicit DoubleShader() {
+        Shader compute{
+            #ifndef MAGNUM_TARGET_GLES
+            Version::GL430,
+            #else
+            Version::GLES310,
+            #endif
+            Shader::Type::Compute};
+        compute.addSource(
+            "layout(local_size_x = 4) in;\n"
+            "layout(std430, binding = 0) readonly buffer Input {\n"
+            "    uint inputData[];\n"
+            "};\n"
+            "layout(std430, binding = 1) writeonly buffer Output {\n"
+            "    uint outputData[];\n"
+            "};\n"
+            "void main() {\n"
+            "    uint i = gl_GlobalInvocationID.x;\n"
+            "    outputData[i] = inputData[i]*2u;\n"
+            "}\n");
+        CORRADE_INTERNAL_ASSERT_OUTPUT(compute.compile());
+
+        attachShader(compute);
+        CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+    }
+};
+
+bool computeSupported() {
+    #ifndef MAGNUM_TARGET_GLES
+    return Context::current().isExtensionSupported<Extensions::ARB::compute_shader>() &&
+        Context::current().isExtensionSupported<Extensions::ARB::shader_storage_buffer_object>();
+    #else
+    return Context::current().isVersionSupported(Version::GLES310);
+    #endif
+}
+
+void ComputePassGLTest::dispatch() {
+    if(!computeSupported())
+        CORRADE_SKIP("Compute shaders or shader storage buffers are not supported.");
+
+    DoubleShader shader;
+
+    const UnsignedInt data[]{1, 2, 3, 4, 5, 6, 7, 8};
+    Buffer a{data};
+    Buffer b;
+    b.setData({nullptr, sizeof(data)});
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    ComputePass pass;
+    pass.bindStorageBuffer(0, a, ComputeAccess::Read)
+        .bindStorageBuffer(1, b, ComputeAccess::Write)
+        .dispatch(shader, ComputePass::workgroupCount({8, 1, 1}, {4, 1, 1}));
+    CORRADE_COMPARE(pass.barrierCount(), 0);
+    CORRADE_VERIFY(!pass.pendingBarriers(a));
+    CORRADE_VERIFY(pass.pendingBarriers(b) >= Renderer::MemoryBarrier::ShaderStorage);
+
+    /* Reading the output in the next dispatch needs a barrier */
+    pass.bindStorageBuffer(0, b, ComputeAccess::Read)
+        .bindStorageBuffer(1, a, ComputeAccess::Write)
+        .dispatch(shader, {2, 1, 1});
+    CORRADE_COMPARE(pass.barrierCount(), 1);
+    CORRADE_VERIFY(pass.pendingBarriers(a) >= Renderer::MemoryBarrier::ShaderStorage);
+    /* The barrier was issued for shader storage only, the rest is still
+       pending for b */
+    CORRADE_VERIFY(!(pass.pendingBarriers(b) & Renderer::MemoryBarrier::ShaderStorage));
+    CORRADE_VERIFY(pass.pendingBarriers(b) >= Renderer::MemoryBarrier::BufferUpdate);
+
+    /* Reading back needs another barrier, but only once */
+    pass.barrier(a, Renderer::MemoryBarrier::BufferUpdate);
+    CORRADE_COMPARE(pass.barrierCount(), 2);
+    pass.barrier(a, Renderer::MemoryBarrier::BufferUpdate);
+    CORRADE_COMPARE(pass.barrierCount(), 2);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /** @todo Test on ES */
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_COMPARE_AS(Containers::arrayCast<UnsignedInt>(a.data()),
+        Containers::arrayView<UnsignedInt>({4, 8, 12, 16, 20, 24, 28, 32}),
+        TestSuite::Compare::Container);
+    #endif
+}
+
+void ComputePassGLTest::dispatchIndirect() {
+    if(!computeSupported())
+        CORRADE_SKIP("Compute shaders or shader storage buffers are not supported.");
+
+    DoubleShader shader;
+
+    const UnsignedInt data[]{1, 2, 3, 4, 5, 6, 7, 8};
+    Buffer a{data};
+    /* Put the workgroup count at an offset to verify it's used */
+    const UnsignedInt workgroupCount[]{0xffffffffu, 2, 1, 1};
+    Buffer indirect{Buffer::TargetHint::DispatchIndirect, workgroupCount};
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* The indirect buffer isn't written by the pass so no barrier is
+       needed for it */
+    ComputePass pass;
+    pass.bindStorageBuffer(0, a, ComputeAccess::Read)
+        .bindStorageBuffer(1, a, ComputeAccess::Write)
+        .dispatchIndirect(shader, indirect, 4);
+    CORRADE_COMPARE(pass.barrierCount(), 0);
+    CORRADE_VERIFY(!pass.pendingBarriers(indirect));
+
+    /* Writing the dispatch parameters in a pass and then using them needs a
+       command barrier in addition to the storage one. The input is all
+       zeros, so the dispatch below is empty and doesn't touch the data. */
+    const UnsignedInt zeros[4]{};
+    Buffer zero{zeros};
+    pass.bindStorageBuffer(0, zero, ComputeAccess::Read)
+        .bindStorageBuffer(1, indirect, ComputeAccess::Write)
+        .dispatch(shader, {1, 1, 1});
+    CORRADE_COMPARE(pass.barrierCount(), 0);
+
+    /* Both the storage and the command barrier are issued at once */
+    pass.bindStorageBuffer(0, a, ComputeAccess::Read)
+        .bindStorageBuffer(1, a, ComputeAccess::Write)
+        .dispatchIndirect(shader, indirect, 0);
+    CORRADE_COMPARE(pass.barrierCount(), 1);
+    CORRADE_VERIFY(!(pass.pendingBarriers(indirect) & Renderer::MemoryBarrier::Command));
+
+    pass.barrier(a, Renderer::MemoryBarrier::BufferUpdate);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /** @todo Test on ES */
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_COMPARE_AS(Containers::arrayCast<UnsignedInt>(a.data()),
+        Containers::arrayView<UnsignedInt>({2, 4, 6, 8, 10, 12, 14, 16}),
+        TestSuite::Compare::Container);
+    #endif
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::GL::Test::ComputePassGLTest)
@@ -0,0 +1,93 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/GL/ComputePass.h"
+#include "Magnum/Math/Vector3.h"
+
+namespace Magnum { namespace GL { namespace Test { namespace {
+
+struct ComputePassTest: TestSuite::Tester {
+    explicit ComputePassTest();
+
+    void workgroupCount();
+    void workgroupCountZeroSize();
+
+    void constructCopy();
+    void constructMove();
+
+    void debugAccess();
+};
+
+ComputePassTest::ComputePassTest() {
+    addTests({&ComputePassTest::workgroupCount,
+              &ComputePassTest::workgroupCountZeroSize,
+
+              &ComputePassTest::constructCopy,
+              &ComputePassTest::constructMove,
+
+              &ComputePassTest::debugAccess});
+}
+
+void ComputePassTest::workgroupCount() {
+    /* Exact multiple */
+    CORRADE_COMPARE(ComputePass::workgroupCount({256, 64, 1}, {64, 16, 1}), (Vector3ui{4, 4, 1}));
+    /* Rounded up */
+    CORRADE_COMPARE(ComputePass::workgroupCount({257, 1, 3}, {64, 16, 2}), (Vector3ui{5, 1, 2}));
+    /* Zero items result in zero workgroups */
+    CORRADE_COMPARE(ComputePass::workgroupCount({0, 0, 0}, {64, 1, 1}), (Vector3ui{0, 0, 0}));
+}
+
+void ComputePassTest::workgroupCountZeroSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    ComputePass::workgroupCount({256, 1, 1}, {64, 0, 1});
+    CORRADE_COMPARE(out.str(), "GL::ComputePass::workgroupCount(): expected a non-zero workgroup size but got {64, 0, 1}\n");
+}
+
+void ComputePassTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<ComputePass>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<ComputePass>{});
+}
+
+void ComputePassTest::constructMove() {
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<ComputePass>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<ComputePass>::value);
+}
+
+void ComputePassTest::debugAccess() {
+    std::ostringstream out;
+    Debug{&out} << ComputeAccess::ReadWrite << ComputeAccess(0xde);
+    CORRADE_COMPARE(out.str(), "GL::ComputeAccess::ReadWrite GL::ComputeAccess(0xde)\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::GL::Test::ComputePassTest)
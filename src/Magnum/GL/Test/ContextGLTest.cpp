@@ -30,9 +30,11 @@
 #include <Corrade/Containers/StringView.h>
 #include <Corrade/TestSuite/Compare/Numeric.h>
 
+#include "Magnum/GL/Buffer.h"
 #include "Magnum/GL/Context.h"
 #include "Magnum/GL/Extensions.h"
 #include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/GL/Texture.h"
 #include "Magnum/Platform/GLContext.h"
 
 #ifndef CORRADE_TARGET_EMSCRIPTEN
@@ -63,6 +65,10 @@ struct ContextGLTest: OpenGLTester {
     void supportedVersion();
     void isExtensionSupported();
     void isExtensionDisabled();
+
+    void countersBuffer();
+    void countersTexture();
+    void resetCounters();
 };
 
 using namespace Containers::Literals;
@@ -87,6 +93,15 @@ struct {
     {"quiet on command line", {}, {}, {}, {}, {},
         Containers::array({"", "--magnum-log", "quiet"}),
         {}, "Renderer: "},
+    {"no startup time breakdown by default", {}, {}, {}, {}, {}, {},
+        {}, "GL::Context: created in "},
+    {"verbose startup time breakdown", {}, {},
+        Context::Configuration::Flag::VerboseLog,
+        {}, {}, {},
+        "GL::Context: created in ", {}},
+    {"verbose startup time breakdown on command line", {}, {}, {}, {}, {},
+        Containers::array({"", "--magnum-log", "verbose"}),
+        "    version and extension detection: ", {}},
     {"quiet and verbose", {}, {},
         Context::Configuration::Flag::QuietLog|Context::Configuration::Flag::VerboseLog,
         {}, {}, {},
@@ -203,7 +218,11 @@ ContextGLTest::ContextGLTest() {
         #endif
         &ContextGLTest::supportedVersion,
         &ContextGLTest::isExtensionSupported,
-        &ContextGLTest::isExtensionDisabled});
+        &ContextGLTest::isExtensionDisabled,
+
+        &ContextGLTest::countersBuffer,
+        &ContextGLTest::countersTexture,
+        &ContextGLTest::resetCounters});
 }
 
 void ContextGLTest::stringFlags() {
@@ -517,6 +536,67 @@ void ContextGLTest::isExtensionDisabled() {
     #endif
 }
 
+void ContextGLTest::countersBuffer() {
+    Context& context = Context::current();
+    context.resetCounters();
+
+    const char data[32]{};
+    Buffer buffer;
+    buffer.setData(data);
+    buffer.setSubData(8, Containers::arrayView(data).prefix(16));
+    /* An allocation without any data isn't counted */
+    buffer.setData({nullptr, 64});
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(context.counter(ContextCounter::BufferUploads), 2);
+    CORRADE_COMPARE(context.counter(ContextCounter::BufferUploadSize), 48);
+}
+
+void ContextGLTest::countersTexture() {
+    Context& context = Context::current();
+    /* Ensure nothing is bound from previous tests so the first bind isn't
+       filtered out */
+    context.resetState(Context::State::Textures);
+    context.resetCounters();
+
+    Texture2D a, b;
+    a.bind(0);
+    /* Redundant bind, filtered out by the state tracker */
+    a.bind(0);
+    b.bind(1);
+    Texture2D::unbind(1);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(context.counter(ContextCounter::TextureBindings), 3);
+
+    /* Only the units that actually change are counted in a multi-bind */
+    AbstractTexture::bind(0, {&a, &b});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(context.counter(ContextCounter::TextureBindings), 4);
+}
+
+void ContextGLTest::resetCounters() {
+    Context& context = Context::current();
+
+    const char data[4]{};
+    Buffer buffer;
+    buffer.setData(data);
+    CORRADE_COMPARE_AS(context.counter(ContextCounter::BufferUploads), UnsignedLong{},
+        TestSuite::Compare::Greater);
+
+    context.resetCounters();
+    CORRADE_COMPARE(context.counter(ContextCounter::DrawCalls), 0);
+    CORRADE_COMPARE(context.counter(ContextCounter::ShaderProgramSwitches), 0);
+    CORRADE_COMPARE(context.counter(ContextCounter::TextureBindings), 0);
+    CORRADE_COMPARE(context.counter(ContextCounter::BufferUploads), 0);
+    CORRADE_COMPARE(context.counter(ContextCounter::BufferUploadSize), 0);
+
+    /* Resetting the state tracker doesn't affect the counters */
+    buffer.setData(data);
+    context.resetState();
+    CORRADE_COMPARE(context.counter(ContextCounter::BufferUploads), 1);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::GL::Test::ContextGLTest)
@@ -64,6 +64,8 @@ struct ContextTest: TestSuite::Tester {
     void debugDetectedDriverPacked();
     void debugDetectedDrivers();
     void debugDetectedDriversPacked();
+
+    void debugContextCounter();
 };
 
 ContextTest::ContextTest() {
@@ -89,7 +91,9 @@ ContextTest::ContextTest() {
               &ContextTest::debugDetectedDriver,
               &ContextTest::debugDetectedDriverPacked,
               &ContextTest::debugDetectedDrivers,
-              &ContextTest::debugDetectedDriversPacked});
+              &ContextTest::debugDetectedDriversPacked,
+
+              &ContextTest::debugContextCounter});
 }
 
 void ContextTest::isExtension() {
@@ -539,6 +543,12 @@ void ContextTest::debugDetectedDriversPacked() {
     #endif
 }
 
+void ContextTest::debugContextCounter() {
+    std::ostringstream out;
+    Debug{&out} << ContextCounter::TextureBindings << ContextCounter(0xdead);
+    CORRADE_COMPARE(out.str(), "GL::ContextCounter::TextureBindings GL::ContextCounter(0xdead)\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::GL::Test::ContextTest)
@@ -145,6 +145,10 @@ struct CubeMapTextureGLTest: OpenGLTester {
     void image3DQueryViewNullptr();
     void image3DQueryViewBadSize();
     #endif
+    void subImages3D();
+    #ifndef MAGNUM_TARGET_GLES2
+    void subImages3DStaging();
+    #endif
 
     #ifndef MAGNUM_TARGET_GLES
     void compressedImage3D();
@@ -381,6 +385,12 @@ CubeMapTextureGLTest::CubeMapTextureGLTest() {
               &CubeMapTextureGLTest::image3DQueryViewBadSize});
     #endif
 
+    addTests({&CubeMapTextureGLTest::subImages3D,
+              #ifndef MAGNUM_TARGET_GLES2
+              &CubeMapTextureGLTest::subImages3DStaging,
+              #endif
+              });
+
     addInstancedTests({
         &CubeMapTextureGLTest::subImage,
         #ifndef MAGNUM_TARGET_GLES2
@@ -1842,6 +1852,82 @@ void CubeMapTextureGLTest::image3DBuffer() {
 }
 #endif
 
+/* Each face of the first level is one row, each face of the second level is
+   four values */
+constexpr UnsignedByte SubImagesDataLevel0[2*2*6*4]{
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f,
+    0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f,
+    0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0x3e, 0x3f,
+    0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4a, 0x4b, 0x4c, 0x4d, 0x4e, 0x4f,
+    0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x5b, 0x5c, 0x5d, 0x5e, 0x5f
+};
+constexpr UnsignedByte SubImagesDataLevel1[1*1*6*4]{
+    0x60, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6a, 0x6b,
+    0x6c, 0x6d, 0x6e, 0x6f, 0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77
+};
+
+void CubeMapTextureGLTest::subImages3D() {
+    #if !(defined(MAGNUM_TARGET_GLES2) && defined(MAGNUM_TARGET_WEBGL))
+    constexpr TextureFormat format = TextureFormat::RGBA8;
+    #else
+    constexpr TextureFormat format = TextureFormat::RGBA;
+    #endif
+
+    CubeMapTexture texture;
+    texture.setStorage(2, format, Vector2i{2})
+        .setSubImages(0, {
+            ImageView3D{PixelFormat::RGBA, PixelType::UnsignedByte, {2, 2, 6}, SubImagesDataLevel0},
+            ImageView3D{PixelFormat::RGBA, PixelType::UnsignedByte, {1, 1, 6}, SubImagesDataLevel1}
+        });
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    #ifndef MAGNUM_TARGET_GLES
+    Image3D image0 = texture.image(0, {PixelFormat::RGBA, PixelType::UnsignedByte});
+    Image3D image1 = texture.image(1, {PixelFormat::RGBA, PixelType::UnsignedByte});
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_COMPARE(image0.size(), (Vector3i{2, 2, 6}));
+    CORRADE_COMPARE_AS(Containers::arrayCast<UnsignedByte>(image0.data()),
+        Containers::arrayView(SubImagesDataLevel0),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(image1.size(), (Vector3i{1, 1, 6}));
+    CORRADE_COMPARE_AS(Containers::arrayCast<UnsignedByte>(image1.data()),
+        Containers::arrayView(SubImagesDataLevel1),
+        TestSuite::Compare::Container);
+    #endif
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+void CubeMapTextureGLTest::subImages3DStaging() {
+    CubeMapTexture texture;
+    Buffer stagingBuffer;
+    texture.setStorage(2, TextureFormat::RGBA8, Vector2i{2})
+        .setSubImages(0, {
+            ImageView3D{PixelFormat::RGBA, PixelType::UnsignedByte, {2, 2, 6}, SubImagesDataLevel0},
+            ImageView3D{PixelFormat::RGBA, PixelType::UnsignedByte, {1, 1, 6}, SubImagesDataLevel1}
+        }, stagingBuffer);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    #ifndef MAGNUM_TARGET_GLES
+    Image3D image0 = texture.image(0, {PixelFormat::RGBA, PixelType::UnsignedByte});
+    Image3D image1 = texture.image(1, {PixelFormat::RGBA, PixelType::UnsignedByte});
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_COMPARE_AS(Containers::arrayCast<UnsignedByte>(image0.data()),
+        Containers::arrayView(SubImagesDataLevel0),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayCast<UnsignedByte>(image1.data()),
+        Containers::arrayView(SubImagesDataLevel1),
+        TestSuite::Compare::Container);
+    #endif
+}
+#endif
+
 #ifndef MAGNUM_TARGET_GLES
 void CubeMapTextureGLTest::image3DQueryView() {
     setTestCaseDescription(FullPixelStorageData[testCaseInstanceId()].name);
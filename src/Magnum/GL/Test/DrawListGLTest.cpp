@@ -0,0 +1,259 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/GL/AbstractShaderProgram.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/DrawList.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/Mesh.h"
+#include "Magnum/GL/MeshView.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/GL/Shader.h"
+#include "Magnum/GL/Texture.h"
+#include "Magnum/GL/TextureFormat.h"
+#include "Magnum/GL/Version.h"
+
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/GL/Buffer.h"
+#endif
+
+namespace Magnum { namespace GL { namespace Test { namespace {
+
+struct DrawListGLTest: OpenGLTester {
+    explicit DrawListGLTest();
+
+    void flush();
+    void flushInstanced();
+    void flushLayerCallback();
+    void flushBindingSets();
+};
+
+DrawListGLTest::DrawListGLTest() {
+    addTests({&DrawListGLTest::flush,
+              &DrawListGLTest::flushInstanced,
+              &DrawListGLTest::flushLayerCallback,
+              &DrawListGLTest::flushBindingSets});
+}
+
+struct PointShader: AbstractShaderProgram {
+    explicit PointShader();
+};
+
+PointShader::PointShader() {
+    #ifndef MAGNUM_TARGET_GLES
+    Shader vert(
+        #ifndef CORRADE_TARGET_APPLE
+        Version::GL210
+        #else
+        Version::GL310
+        #endif
+        , Shader::Type::Vertex);
+    Shader frag(
+        #ifndef CORRADE_TARGET_APPLE
+        Version::GL210
+        #else
+        Version::GL310
+        #endif
+        , Shader::Type::Fragment);
+    #elif defined(MAGNUM_TARGET_GLES2)
+    Shader vert(Version::GLES200, Shader::Type::Vertex);
+    Shader frag(Version::GLES200, Shader::Type::Fragment);
+    #else
+    Shader vert(Version::GLES300, Shader::Type::Vertex);
+    Shader frag(Version::GLES300, Shader::Type::Fragment);
+    #endif
+
+    vert.addSource(
+        "void main() {\n"
+        "    gl_PointSize = 1.0;\n"
+        "    gl_Position = vec4(0.0, 0.0, 0.0, 1.0);\n"
+        "}\n");
+    frag.addSource(
+        "#if (defined(GL_ES) && __VERSION__ >= 300) || (!defined(GL_ES) && __VERSION__ >= 130)\n"
+        "out lowp vec4 result;\n"
+        "#define gl_FragColor result\n"
+        "#endif\n"
+        "void main() { gl_FragColor = vec4(1.0); }\n");
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(vert.compile() && frag.compile());
+
+    attachShaders({vert, frag});
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+}
+
+void DrawListGLTest::flush() {
+    PointShader shader1, shader2;
+    Mesh mesh1{MeshPrimitive::Points}, mesh2{MeshPrimitive::Points};
+    mesh1.setCount(4);
+    mesh2.setCount(4);
+
+    MeshView view1a{mesh1}, view1b{mesh1}, view2{mesh2};
+    view1a.setCount(2);
+    view1b.setCount(2)
+        .setBaseVertex(2);
+    view2.setCount(4);
+
+    DrawList list;
+    list.add(shader1, view1a)
+        .add(shader2, view2)
+        .add(shader1, view2)
+        .add(shader2, view1a)
+        .add(shader1, view1b);
+    CORRADE_COMPARE(list.drawCount(), 5);
+
+    /* Sorted, the two views of the first mesh with the first shader get
+       merged, everything else is separate */
+    CORRADE_COMPARE(list.flush(), 4);
+    CORRADE_COMPARE(list.drawCount(), 0);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Flushing again does nothing */
+    CORRADE_COMPARE(list.flush(), 0);
+}
+
+void DrawListGLTest::flushInstanced() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::ARB::draw_instanced>())
+        CORRADE_SKIP(Extensions::ARB::draw_instanced::string() << "is not supported.");
+    #elif defined(MAGNUM_TARGET_GLES2)
+    if(!Context::current().isExtensionSupported<Extensions::ANGLE::instanced_arrays>() &&
+       !Context::current().isExtensionSupported<Extensions::EXT::instanced_arrays>() &&
+       !Context::current().isExtensionSupported<Extensions::EXT::draw_instanced>() &&
+       !Context::current().isExtensionSupported<Extensions::NV::instanced_arrays>() &&
+       !Context::current().isExtensionSupported<Extensions::NV::draw_instanced>())
+        CORRADE_SKIP("Required extension is not available.");
+    #endif
+
+    PointShader shader;
+    Mesh mesh{MeshPrimitive::Points};
+    mesh.setCount(4);
+
+    MeshView view{mesh}, instanced{mesh};
+    view.setCount(4);
+    instanced.setCount(4)
+        .setInstanceCount(3);
+
+    DrawList list;
+    list.add(shader, view)
+        .add(shader, instanced)
+        .add(shader, view);
+
+    /* The instanced draw is submitted separately and splits the batch */
+    CORRADE_COMPARE(list.flush(), 3);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void DrawListGLTest::flushLayerCallback() {
+    PointShader shader;
+    Mesh mesh{MeshPrimitive::Points};
+    mesh.setCount(4);
+    MeshView view{mesh};
+    view.setCount(4);
+
+    Containers::Array<UnsignedInt> layers;
+
+    DrawList list;
+    list.setLayerCallback([](UnsignedInt layer, void* userData) {
+        arrayAppend(*static_cast<Containers::Array<UnsignedInt>*>(userData), layer);
+    }, &layers);
+    list.add(shader, view, ~UnsignedInt{}, 7)
+        .add(shader, view, ~UnsignedInt{}, 3)
+        .add(shader, view)
+        .add(shader, view, ~UnsignedInt{}, 7);
+
+    /* Each layer is a separate submission and the callback is called before
+       each, including the implicit layer 0 */
+    CORRADE_COMPARE(list.flush(), 3);
+    CORRADE_COMPARE_AS(layers, Containers::arrayView<UnsignedInt>({
+        0, 3, 7
+    }), TestSuite::Compare::Container);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void DrawListGLTest::flushBindingSets() {
+    PointShader shader;
+    Mesh mesh{MeshPrimitive::Points};
+    mesh.setCount(4);
+    MeshView view{mesh};
+    view.setCount(4);
+
+    Texture2D a, b;
+    a.setImage(0, TextureFormat::RGBA, ImageView2D{PixelFormat::RGBA8Unorm, {4, 4}});
+    b.setImage(0, TextureFormat::RGBA, ImageView2D{PixelFormat::RGBA8Unorm, {4, 4}});
+
+    DrawList list;
+    const UnsignedInt setA = list.addBindingSet(0, {&a});
+    const UnsignedInt setB = list.addBindingSet(0, {&b, &a});
+    #ifndef MAGNUM_TARGET_GLES2
+    Buffer uniforms;
+    uniforms.setData({nullptr, 256});
+    const UnsignedInt setC = list.addBindingSet(0, {&b}, 0, {{&uniforms, 0, 256}, {nullptr, 0, 0}});
+    #endif
+    CORRADE_COMPARE(list.bindingSetCount(),
+        #ifndef MAGNUM_TARGET_GLES2
+        3
+        #else
+        2
+        #endif
+    );
+
+    list.add(shader, view, setB)
+        .add(shader, view, setA)
+        #ifndef MAGNUM_TARGET_GLES2
+        .add(shader, view, setC)
+        #endif
+        .add(shader, view)
+        .add(shader, view, setA);
+
+    /* Draws with different binding sets can't be merged */
+    CORRADE_COMPARE(list.flush(),
+        #ifndef MAGNUM_TARGET_GLES2
+        4
+        #else
+        3
+        #endif
+    );
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* The binding sets are kept after a flush */
+    list.add(shader, view, setA);
+    CORRADE_COMPARE(list.flush(), 1);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::GL::Test::DrawListGLTest)
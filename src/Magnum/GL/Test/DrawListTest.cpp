@@ -0,0 +1,200 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/GL/AbstractShaderProgram.h"
+#include "Magnum/GL/DrawList.h"
+#include "Magnum/GL/Mesh.h"
+#include "Magnum/GL/MeshView.h"
+#include "Magnum/GL/Texture.h"
+
+namespace Magnum { namespace GL { namespace Test { namespace {
+
+struct DrawListTest: TestSuite::Tester {
+    explicit DrawListTest();
+
+    void construct();
+    void constructCopy();
+    void constructMove();
+
+    void addBindingSet();
+    void add();
+    void addInvalidBindingSet();
+    void addInvalidLayer();
+
+    void flushEmpty();
+    void clear();
+};
+
+DrawListTest::DrawListTest() {
+    addTests({&DrawListTest::construct,
+              &DrawListTest::constructCopy,
+              &DrawListTest::constructMove,
+
+              &DrawListTest::addBindingSet,
+              &DrawListTest::add,
+              &DrawListTest::addInvalidBindingSet,
+              &DrawListTest::addInvalidLayer,
+
+              &DrawListTest::flushEmpty,
+              &DrawListTest::clear});
+}
+
+struct DummyShader: AbstractShaderProgram {
+    explicit DummyShader(): AbstractShaderProgram{NoCreate} {}
+};
+
+void DrawListTest::construct() {
+    DrawList list;
+    CORRADE_COMPARE(list.drawCount(), 0);
+    CORRADE_COMPARE(list.bindingSetCount(), 0);
+}
+
+void DrawListTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<DrawList>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<DrawList>{});
+}
+
+void DrawListTest::constructMove() {
+    DummyShader shader;
+    Mesh mesh{NoCreate};
+    MeshView view{mesh};
+
+    DrawList a;
+    a.addBindingSet(0, {nullptr});
+    a.add(shader, view)
+     .add(shader, view);
+
+    DrawList b{std::move(a)};
+    CORRADE_COMPARE(b.drawCount(), 2);
+    CORRADE_COMPARE(b.bindingSetCount(), 1);
+
+    DrawList c;
+    c.add(shader, view);
+    c = std::move(b);
+    CORRADE_COMPARE(c.drawCount(), 2);
+    CORRADE_COMPARE(c.bindingSetCount(), 1);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<DrawList>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<DrawList>::value);
+}
+
+void DrawListTest::addBindingSet() {
+    Texture2D a{NoCreate}, b{NoCreate};
+
+    DrawList list;
+    CORRADE_COMPARE(list.addBindingSet(0, {&a, &b}), 0);
+    CORRADE_COMPARE(list.addBindingSet(3, {}), 1);
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_COMPARE(list.addBindingSet(1, {&b}, 2, {{nullptr, 0, 0}}), 2);
+    CORRADE_COMPARE(list.bindingSetCount(), 3);
+    #else
+    CORRADE_COMPARE(list.bindingSetCount(), 2);
+    #endif
+}
+
+void DrawListTest::add() {
+    DummyShader shader1, shader2;
+    Mesh mesh1{NoCreate}, mesh2{NoCreate};
+    MeshView view1{mesh1}, view2{mesh2};
+
+    DrawList list;
+    UnsignedInt set = list.addBindingSet(0, {nullptr});
+    list.add(shader1, view1)
+        .add(shader2, view1, set)
+        .add(shader1, view2, ~UnsignedInt{}, 255);
+    CORRADE_COMPARE(list.drawCount(), 3);
+}
+
+void DrawListTest::addInvalidBindingSet() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    DummyShader shader;
+    Mesh mesh{NoCreate};
+    MeshView view{mesh};
+
+    DrawList list;
+    list.addBindingSet(0, {nullptr});
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    list.add(shader, view, 1);
+    CORRADE_COMPARE(list.drawCount(), 0);
+    CORRADE_COMPARE(out.str(), "GL::DrawList::add(): binding set 1 out of range for 1 binding sets\n");
+}
+
+void DrawListTest::addInvalidLayer() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    DummyShader shader;
+    Mesh mesh{NoCreate};
+    MeshView view{mesh};
+
+    DrawList list;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    list.add(shader, view, ~UnsignedInt{}, 256);
+    CORRADE_COMPARE(list.drawCount(), 0);
+    CORRADE_COMPARE(out.str(), "GL::DrawList::add(): expected layer to be less than 256 but got 256\n");
+}
+
+void DrawListTest::flushEmpty() {
+    Int called = 0;
+
+    DrawList list;
+    list.setLayerCallback([](UnsignedInt, void* userData) {
+        ++*static_cast<Int*>(userData);
+    }, &called);
+
+    /* Nothing to submit, doesn't touch any GL state and so works even without
+       a GL context. The callback isn't called either. */
+    CORRADE_COMPARE(list.flush(), 0);
+    CORRADE_COMPARE(called, 0);
+}
+
+void DrawListTest::clear() {
+    DummyShader shader;
+    Mesh mesh{NoCreate};
+    MeshView view{mesh};
+
+    DrawList list;
+    list.addBindingSet(0, {nullptr});
+    list.add(shader, view)
+        .add(shader, view, 0);
+    CORRADE_COMPARE(list.drawCount(), 2);
+
+    list.clear();
+    CORRADE_COMPARE(list.drawCount(), 0);
+    /* Binding sets are kept */
+    CORRADE_COMPARE(list.bindingSetCount(), 1);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::GL::Test::DrawListTest)
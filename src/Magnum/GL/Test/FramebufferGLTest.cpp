@@ -1408,6 +1408,15 @@ void FramebufferGLTest::invalidate() {
 
     MAGNUM_VERIFY_NO_GL_ERROR();
 
+    /* Runtime-sized list */
+    const Framebuffer::InvalidationAttachment attachments[]{
+        Framebuffer::ColorAttachment(0),
+        Framebuffer::InvalidationAttachment::Stencil
+    };
+    framebuffer.invalidate(attachments);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
     #ifndef MAGNUM_TARGET_GLES2
     /* Invalidating combined bits should work as well even if there's just stencil alone */
     framebuffer.invalidate({Framebuffer::InvalidationAttachment::DepthStencil});
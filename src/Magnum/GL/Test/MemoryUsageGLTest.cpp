@@ -0,0 +1,251 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/Containers/StringView.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/GL/Buffer.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/MemoryUsage.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/GL/Renderbuffer.h"
+#include "Magnum/GL/RenderbufferFormat.h"
+#include "Magnum/GL/Texture.h"
+#include "Magnum/GL/TextureFormat.h"
+
+namespace Magnum { namespace GL { namespace Test { namespace {
+
+struct MemoryUsageGLTest: OpenGLTester {
+    explicit MemoryUsageGLTest();
+
+    void teardown();
+
+    void disabled();
+    void buffer();
+    void textureStorage();
+    void textureImage();
+    void renderbuffer();
+    void entries();
+    void disableDiscards();
+};
+
+using namespace Containers::Literals;
+
+MemoryUsageGLTest::MemoryUsageGLTest() {
+    addTests({&MemoryUsageGLTest::disabled,
+              &MemoryUsageGLTest::buffer,
+              &MemoryUsageGLTest::textureStorage,
+              &MemoryUsageGLTest::textureImage,
+              &MemoryUsageGLTest::renderbuffer,
+              &MemoryUsageGLTest::entries,
+              &MemoryUsageGLTest::disableDiscards},
+        nullptr,
+        &MemoryUsageGLTest::teardown);
+}
+
+void MemoryUsageGLTest::teardown() {
+    MemoryUsage::setTrackingEnabled(false);
+}
+
+void MemoryUsageGLTest::disabled() {
+    CORRADE_VERIFY(!MemoryUsage::isTrackingEnabled());
+
+    Buffer buffer;
+    const char data[16]{};
+    buffer.setData(data);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(MemoryUsage::total(), 0);
+    CORRADE_COMPARE(MemoryUsage::objectCount(MemoryUsageCategory::Buffer), 0);
+    CORRADE_VERIFY(MemoryUsage::entries().isEmpty());
+}
+
+void MemoryUsageGLTest::buffer() {
+    MemoryUsage::setTrackingEnabled(true);
+    CORRADE_VERIFY(MemoryUsage::isTrackingEnabled());
+
+    {
+        Buffer buffer;
+        const char data[32]{};
+        buffer.setData(Containers::arrayView(data).prefix(16));
+
+        MAGNUM_VERIFY_NO_GL_ERROR();
+        CORRADE_COMPARE(MemoryUsage::total(), 16);
+        CORRADE_COMPARE(MemoryUsage::total(MemoryUsageCategory::Buffer), 16);
+        CORRADE_COMPARE(MemoryUsage::objectCount(MemoryUsageCategory::Buffer), 1);
+
+        /* Setting the data again replaces the previous size */
+        buffer.setData(data);
+
+        MAGNUM_VERIFY_NO_GL_ERROR();
+        CORRADE_COMPARE(MemoryUsage::total(MemoryUsageCategory::Buffer), 32);
+        CORRADE_COMPARE(MemoryUsage::objectCount(MemoryUsageCategory::Buffer), 1);
+    }
+
+    /* Destruction removes the buffer */
+    CORRADE_COMPARE(MemoryUsage::total(), 0);
+    CORRADE_COMPARE(MemoryUsage::objectCount(MemoryUsageCategory::Buffer), 0);
+}
+
+void MemoryUsageGLTest::textureStorage() {
+    MemoryUsage::setTrackingEnabled(true);
+
+    {
+        Texture2D texture;
+        texture.setStorage(3,
+            #ifndef MAGNUM_TARGET_GLES2
+            TextureFormat::RGBA8,
+            #else
+            TextureFormat::RGBA,
+            #endif
+            {4, 4});
+
+        MAGNUM_VERIFY_NO_GL_ERROR();
+        /* 4x4, 2x2 and 1x1 levels, four bytes each */
+        CORRADE_COMPARE(MemoryUsage::total(MemoryUsageCategory::Texture), 84);
+        CORRADE_COMPARE(MemoryUsage::objectCount(MemoryUsageCategory::Texture), 1);
+    }
+
+    CORRADE_COMPARE(MemoryUsage::total(MemoryUsageCategory::Texture), 0);
+    CORRADE_COMPARE(MemoryUsage::objectCount(MemoryUsageCategory::Texture), 0);
+}
+
+void MemoryUsageGLTest::textureImage() {
+    MemoryUsage::setTrackingEnabled(true);
+
+    Texture2D texture;
+    texture.setImage(0,
+        #ifndef MAGNUM_TARGET_GLES2
+        TextureFormat::RGBA8,
+        #else
+        TextureFormat::RGBA,
+        #endif
+        ImageView2D{PixelFormat::RGBA8Unorm, {4, 4}});
+    texture.setImage(1,
+        #ifndef MAGNUM_TARGET_GLES2
+        TextureFormat::RGBA8,
+        #else
+        TextureFormat::RGBA,
+        #endif
+        ImageView2D{PixelFormat::RGBA8Unorm, {2, 2}});
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(MemoryUsage::total(MemoryUsageCategory::Texture), 64 + 16);
+
+    /* Respecifying a level replaces just its size */
+    texture.setImage(0,
+        #ifndef MAGNUM_TARGET_GLES2
+        TextureFormat::RGBA8,
+        #else
+        TextureFormat::RGBA,
+        #endif
+        ImageView2D{PixelFormat::RGBA8Unorm, {2, 2}});
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(MemoryUsage::total(MemoryUsageCategory::Texture), 16 + 16);
+    CORRADE_COMPARE(MemoryUsage::objectCount(MemoryUsageCategory::Texture), 1);
+}
+
+void MemoryUsageGLTest::renderbuffer() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::ARB::framebuffer_object>())
+        CORRADE_SKIP(Extensions::ARB::framebuffer_object::string() << "is not supported.");
+    #endif
+
+    MemoryUsage::setTrackingEnabled(true);
+
+    {
+        Renderbuffer renderbuffer;
+        renderbuffer.setStorage(
+            #ifndef MAGNUM_TARGET_GLES2
+            RenderbufferFormat::RGBA8,
+            #else
+            RenderbufferFormat::RGBA4,
+            #endif
+            {4, 4});
+
+        MAGNUM_VERIFY_NO_GL_ERROR();
+        /* RGBA4 has no generic equivalent and falls back to four bytes per
+           pixel as well */
+        CORRADE_COMPARE(MemoryUsage::total(MemoryUsageCategory::Renderbuffer), 64);
+        CORRADE_COMPARE(MemoryUsage::objectCount(MemoryUsageCategory::Renderbuffer), 1);
+    }
+
+    CORRADE_COMPARE(MemoryUsage::total(MemoryUsageCategory::Renderbuffer), 0);
+}
+
+void MemoryUsageGLTest::entries() {
+    MemoryUsage::setTrackingEnabled(true);
+
+    const char data[32]{};
+    Buffer small;
+    small.setData(Containers::arrayView(data).prefix(8));
+    Buffer large;
+    large.setData(data);
+    #ifndef MAGNUM_TARGET_WEBGL
+    /* The label gets recorded even if KHR_debug isn't supported */
+    large.setLabel("vertices"_s);
+    #endif
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(MemoryUsage::total(), 40);
+
+    Containers::Array<MemoryUsageEntry> entries = MemoryUsage::entries();
+    CORRADE_COMPARE(entries.size(), 2);
+    CORRADE_COMPARE(entries[0].category, MemoryUsageCategory::Buffer);
+    CORRADE_COMPARE(entries[0].id, large.id());
+    CORRADE_COMPARE(entries[0].size, 32);
+    #ifndef MAGNUM_TARGET_WEBGL
+    CORRADE_COMPARE(entries[0].label, "vertices");
+    #endif
+    CORRADE_COMPARE(entries[1].category, MemoryUsageCategory::Buffer);
+    CORRADE_COMPARE(entries[1].id, small.id());
+    CORRADE_COMPARE(entries[1].size, 8);
+    CORRADE_COMPARE(entries[1].label, "");
+}
+
+void MemoryUsageGLTest::disableDiscards() {
+    MemoryUsage::setTrackingEnabled(true);
+
+    Buffer buffer;
+    const char data[16]{};
+    buffer.setData(data);
+    CORRADE_COMPARE(MemoryUsage::total(), 16);
+
+    /* Disabling discards everything, re-enabling starts from scratch */
+    MemoryUsage::setTrackingEnabled(false);
+    CORRADE_COMPARE(MemoryUsage::total(), 0);
+    MemoryUsage::setTrackingEnabled(true);
+    CORRADE_COMPARE(MemoryUsage::total(), 0);
+    CORRADE_VERIFY(MemoryUsage::entries().isEmpty());
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::GL::Test::MemoryUsageGLTest)
@@ -225,6 +225,15 @@ struct MeshGLTest: OpenGLTester {
     void multiDrawInstancedBaseInstanceNoExtensionAvailable();
     #endif
     #endif
+
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    void drawIndirect();
+    void drawIndirectIndexed();
+    #ifndef MAGNUM_TARGET_GLES
+    void drawIndirectCount();
+    #endif
+    void drawIndirectIndexBufferOffset();
+    #endif
 };
 
 const struct {
@@ -741,6 +750,20 @@ MeshGLTest::MeshGLTest() {
     });
     #endif
 
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    addInstancedTests({&MeshGLTest::drawIndirect,
+                       #ifndef MAGNUM_TARGET_GLES
+                       &MeshGLTest::drawIndirectCount
+                       #endif
+                       },
+        Containers::arraySize(MultiDrawData));
+
+    addInstancedTests({&MeshGLTest::drawIndirectIndexed},
+        Containers::arraySize(MultiDrawIndexedData));
+
+    addTests({&MeshGLTest::drawIndirectIndexBufferOffset});
+    #endif
+
     /* Reset clear color to something trivial first */
     Renderer::setClearColor(0x000000_rgbf);
 }
@@ -5225,6 +5248,212 @@ void MeshGLTest::multiDrawInstancedBaseInstanceNoExtensionAvailable() {
 #endif
 #endif
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+void MeshGLTest::drawIndirect() {
+    auto&& data = MultiDrawData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::ARB::multi_draw_indirect>())
+        CORRADE_SKIP(Extensions::ARB::multi_draw_indirect::string() << "is not supported.");
+    #else
+    if(!Context::current().isVersionSupported(Version::GLES310))
+        CORRADE_SKIP("OpenGL ES 3.1 is not supported.");
+    #endif
+
+    if(data.vertexId && !GL::Context::current().isExtensionSupported<GL::Extensions::MAGNUM::shader_vertex_id>())
+        CORRADE_SKIP("gl_VertexID not supported");
+
+    if(data.drawId) {
+        #ifndef MAGNUM_TARGET_GLES
+        if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::shader_draw_parameters>())
+            CORRADE_SKIP(GL::Extensions::ARB::shader_draw_parameters::string() << "is not supported.");
+        #else
+        CORRADE_SKIP("Multi-draw indirect is emulated on ES, gl_DrawID is not available.");
+        #endif
+    }
+
+    const struct {
+        Vector2 position;
+        Vector4 value;
+    } vertexData[] {
+        {}, /* initial offset */
+        {{-1.0f/3.0f, -1.0f/3.0f}, data.values[0]},
+        {{ 1.0f/3.0f, -1.0f/3.0f}, data.values[1]},
+        {{-1.0f/3.0f,  1.0f/3.0f}, data.values[2]},
+        {{ 1.0f/3.0f,  1.0f/3.0f}, data.values[3]},
+    };
+
+    Mesh mesh{MeshPrimitive::Points};
+    mesh.addVertexBuffer(Buffer{vertexData}, sizeof(vertexData[0]), MultiDrawShader::Position{}, MultiDrawShader::Value{});
+
+    /* Commands interleaved with some extra data and placed at an offset to
+       verify both the stride and the offset is correctly used */
+    struct Command {
+        UnsignedInt count;
+        UnsignedInt instanceCount;
+        UnsignedInt first;
+        UnsignedInt baseInstance;
+        UnsignedInt padding;
+    } commands[] {
+        {},
+        {data.counts[0], 1, data.vertexOffsets[0], 0, 0xdeadbeefu},
+        {data.counts[1], 1, data.vertexOffsets[1], 0, 0xdeadbeefu},
+        {data.counts[2], 1, data.vertexOffsets[2], 0, 0xdeadbeefu},
+        {data.counts[3], 1, data.vertexOffsets[3], 0, 0xdeadbeefu},
+    };
+    Buffer buffer{Buffer::TargetHint::DrawIndirect, commands};
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    MultiDrawChecker checker;
+    MultiDrawShader{data.vertexId, data.drawId}.drawIndirect(mesh, buffer, sizeof(Command), 4, sizeof(Command));
+    Vector4 value = checker.get();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE_WITH(value, data.expected,
+        TestSuite::Compare::around(Vector4{1.0f/255.0f}));
+}
+
+void MeshGLTest::drawIndirectIndexed() {
+    auto&& data = MultiDrawIndexedData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::ARB::multi_draw_indirect>())
+        CORRADE_SKIP(Extensions::ARB::multi_draw_indirect::string() << "is not supported.");
+    #else
+    if(!Context::current().isVersionSupported(Version::GLES310))
+        CORRADE_SKIP("OpenGL ES 3.1 is not supported.");
+    #endif
+
+    if(data.vertexId && !GL::Context::current().isExtensionSupported<GL::Extensions::MAGNUM::shader_vertex_id>())
+        CORRADE_SKIP("gl_VertexID not supported");
+
+    const struct {
+        Vector2 position;
+        Vector4 value;
+    } vertexData[] {
+        {}, /* initial offset */
+        {{-1.0f/3.0f, -1.0f/3.0f}, data.values[0]},
+        {{ 1.0f/3.0f, -1.0f/3.0f}, data.values[1]},
+        {{-1.0f/3.0f,  1.0f/3.0f}, data.values[2]},
+        {{ 1.0f/3.0f,  1.0f/3.0f}, data.values[3]},
+    };
+
+    Mesh mesh{MeshPrimitive::Points};
+    mesh.addVertexBuffer(Buffer{vertexData}, sizeof(vertexData[0]), MultiDrawShader::Position{}, MultiDrawShader::Value{})
+        .setIndexBuffer(Buffer{Buffer::TargetHint::ElementArray, data.indices}, 0, MeshIndexType::UnsignedInt);
+
+    /* Tightly packed, the first index is in indices, not bytes */
+    struct Command {
+        UnsignedInt count;
+        UnsignedInt instanceCount;
+        UnsignedInt firstIndex;
+        UnsignedInt baseVertex;
+        UnsignedInt baseInstance;
+    } commands[] {
+        {data.counts[0], 1, data.indexOffsetsInBytes[0]/4, data.vertexOffsets[0], 0},
+        {data.counts[1], 1, data.indexOffsetsInBytes[1]/4, data.vertexOffsets[1], 0},
+        {data.counts[2], 1, data.indexOffsetsInBytes[2]/4, data.vertexOffsets[2], 0},
+        {data.counts[3], 1, data.indexOffsetsInBytes[3]/4, data.vertexOffsets[3], 0}
+    };
+    Buffer buffer{Buffer::TargetHint::DrawIndirect, commands};
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    MultiDrawChecker checker;
+    MultiDrawShader{data.vertexId, false}.drawIndirect(mesh, buffer, 0, 4);
+    Vector4 value = checker.get();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE_WITH(value, data.expected,
+        TestSuite::Compare::around(Vector4{1.0f/255.0f}));
+}
+
+#ifndef MAGNUM_TARGET_GLES
+void MeshGLTest::drawIndirectCount() {
+    auto&& data = MultiDrawData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if(!Context::current().isVersionSupported(Version::GL460))
+        CORRADE_SKIP("OpenGL 4.6 is not supported.");
+
+    if(data.vertexId && !GL::Context::current().isExtensionSupported<GL::Extensions::MAGNUM::shader_vertex_id>())
+        CORRADE_SKIP("gl_VertexID not supported");
+
+    if(data.drawId && !GL::Context::current().isExtensionSupported<GL::Extensions::ARB::shader_draw_parameters>())
+        CORRADE_SKIP(GL::Extensions::ARB::shader_draw_parameters::string() << "is not supported.");
+
+    const struct {
+        Vector2 position;
+        Vector4 value;
+    } vertexData[] {
+        {}, /* initial offset */
+        {{-1.0f/3.0f, -1.0f/3.0f}, data.values[0]},
+        {{ 1.0f/3.0f, -1.0f/3.0f}, data.values[1]},
+        {{-1.0f/3.0f,  1.0f/3.0f}, data.values[2]},
+        {{ 1.0f/3.0f,  1.0f/3.0f}, data.values[3]},
+    };
+
+    Mesh mesh{MeshPrimitive::Points};
+    mesh.addVertexBuffer(Buffer{vertexData}, sizeof(vertexData[0]), MultiDrawShader::Position{}, MultiDrawShader::Value{});
+
+    /* The last command would draw all points, it should be excluded by the
+       draw count */
+    const struct Command {
+        UnsignedInt count;
+        UnsignedInt instanceCount;
+        UnsignedInt first;
+        UnsignedInt baseInstance;
+    } commands[] {
+        {data.counts[0], 1, data.vertexOffsets[0], 0},
+        {data.counts[1], 1, data.vertexOffsets[1], 0},
+        {data.counts[2], 1, data.vertexOffsets[2], 0},
+        {data.counts[3], 1, data.vertexOffsets[3], 0},
+        {4, 1, 1, 0}
+    };
+    Buffer buffer{Buffer::TargetHint::DrawIndirect, commands};
+
+    /* Count at an offset to verify it's used */
+    const UnsignedInt count[]{5, 4};
+    Buffer countBuffer{Buffer::TargetHint::Parameter, count};
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    MultiDrawChecker checker;
+    MultiDrawShader{data.vertexId, data.drawId}.drawIndirect(mesh, buffer, 0, countBuffer, 4, 5);
+    Vector4 value = checker.get();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE_WITH(value, data.expected,
+        TestSuite::Compare::around(Vector4{1.0f/255.0f}));
+}
+#endif
+
+void MeshGLTest::drawIndirectIndexBufferOffset() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Mesh mesh;
+    mesh.setIndexBuffer(Buffer{Buffer::TargetHint::ElementArray, {0, 2, 1, 0}}, 4, MeshIndexType::UnsignedInt);
+    Buffer buffer{Buffer::TargetHint::DrawIndirect};
+    MultiDrawShader shader;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    shader.drawIndirect(mesh, buffer, 0, 3);
+    #ifndef MAGNUM_TARGET_GLES
+    shader.drawIndirect(mesh, buffer, 0, buffer, 0, 3);
+    #endif
+    CORRADE_COMPARE(out.str(),
+        "GL::AbstractShaderProgram::drawIndirect(): expected a zero index buffer offset but got 4\n"
+        #ifndef MAGNUM_TARGET_GLES
+        "GL::AbstractShaderProgram::drawIndirect(): expected a zero index buffer offset but got 4\n"
+        #endif
+        );
+}
+#endif
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::GL::Test::MeshGLTest)
@@ -0,0 +1,162 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Image.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/Framebuffer.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/GL/PixelFormat.h"
+#include "Magnum/GL/Renderbuffer.h"
+#include "Magnum/GL/RenderbufferFormat.h"
+#include "Magnum/GL/RenderPass.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Range.h"
+
+namespace Magnum { namespace GL { namespace Test { namespace {
+
+struct RenderPassGLTest: OpenGLTester {
+    explicit RenderPassGLTest();
+
+    void clear();
+    void dontCare();
+    void load();
+};
+
+RenderPassGLTest::RenderPassGLTest() {
+    addTests({&RenderPassGLTest::clear,
+              &RenderPassGLTest::dontCare,
+              &RenderPassGLTest::load});
+}
+
+void RenderPassGLTest::clear() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isVersionSupported(Version::GL300))
+        CORRADE_SKIP("GL 3.0 is not supported.");
+    #endif
+
+    Renderbuffer color;
+    color.setStorage(RenderbufferFormat::RGBA8, Vector2i{16});
+    Renderbuffer depthStencil;
+    depthStencil.setStorage(RenderbufferFormat::Depth24Stencil8, Vector2i{16});
+
+    Framebuffer framebuffer({{}, Vector2i{16}});
+    framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment{0}, color)
+               .attachRenderbuffer(Framebuffer::BufferAttachment::DepthStencil, depthStencil);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(framebuffer.checkStatus(FramebufferTarget::Draw), Framebuffer::Status::Complete);
+
+    RenderPass pass{framebuffer};
+    pass.setColorAttachment(0, RenderPassLoad::Clear, RenderPassStore::Store, Math::unpack<Color4>(Color4ub{128, 64, 32, 17}))
+        .setDepthAttachment(RenderPassLoad::Clear, RenderPassStore::DontCare)
+        .setStencilAttachment(RenderPassLoad::Clear, RenderPassStore::DontCare);
+
+    pass.begin();
+    CORRADE_VERIFY(pass.isActive());
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    pass.end();
+    CORRADE_VERIFY(!pass.isActive());
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* The color is stored */
+    Image2D image = framebuffer.read({{}, Vector2i{1}},
+        {PixelFormat::RGBA, PixelType::UnsignedByte});
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(Containers::arrayCast<Color4ub>(image.data())[0], (Color4ub{128, 64, 32, 17}));
+
+    /* The pass can be repeated */
+    pass.begin().end();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void RenderPassGLTest::dontCare() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isVersionSupported(Version::GL300))
+        CORRADE_SKIP("GL 3.0 is not supported.");
+    #endif
+
+    Renderbuffer color;
+    color.setStorage(RenderbufferFormat::RGBA8, Vector2i{16});
+    Renderbuffer depthStencil;
+    depthStencil.setStorage(RenderbufferFormat::Depth24Stencil8, Vector2i{16});
+
+    Framebuffer framebuffer({{}, Vector2i{16}});
+    framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment{0}, color)
+               .attachRenderbuffer(Framebuffer::BufferAttachment::DepthStencil, depthStencil);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Everything is invalidated, both at the start and at the end. The
+       invalidation is a hint, so verify just that it doesn't cause errors. */
+    RenderPass pass{framebuffer};
+    pass.setColorAttachment(0, RenderPassLoad::DontCare, RenderPassStore::DontCare)
+        .setDepthAttachment(RenderPassLoad::DontCare, RenderPassStore::DontCare)
+        .setStencilAttachment(RenderPassLoad::DontCare, RenderPassStore::DontCare)
+        .begin()
+        .end();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void RenderPassGLTest::load() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isVersionSupported(Version::GL300))
+        CORRADE_SKIP("GL 3.0 is not supported.");
+    #endif
+
+    Renderbuffer color;
+    color.setStorage(RenderbufferFormat::RGBA8, Vector2i{16});
+
+    Framebuffer framebuffer({{}, Vector2i{16}});
+    framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment{0}, color)
+        .clearColor(0, Math::unpack<Color4>(Color4ub{128, 64, 32, 17}));
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Attachments that aren't described are loaded and stored, so the
+       contents stay */
+    RenderPass pass{framebuffer};
+    pass.setDepthAttachment(RenderPassLoad::DontCare, RenderPassStore::DontCare)
+        .begin()
+        .end();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Image2D image = framebuffer.read({{}, Vector2i{1}},
+        {PixelFormat::RGBA, PixelType::UnsignedByte});
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(Containers::arrayCast<Color4ub>(image.data())[0], (Color4ub{128, 64, 32, 17}));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::GL::Test::RenderPassGLTest)
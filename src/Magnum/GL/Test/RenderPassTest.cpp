@@ -0,0 +1,116 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/GL/DefaultFramebuffer.h"
+#include "Magnum/GL/RenderPass.h"
+
+namespace Magnum { namespace GL { namespace Test { namespace {
+
+struct RenderPassTest: TestSuite::Tester {
+    explicit RenderPassTest();
+
+    void construct();
+    void constructCopy();
+    void constructMove();
+
+    void colorAttachmentDefaultFramebufferInvalidLocation();
+    void endNotActive();
+
+    void debugLoad();
+    void debugStore();
+};
+
+RenderPassTest::RenderPassTest() {
+    addTests({&RenderPassTest::construct,
+              &RenderPassTest::constructCopy,
+              &RenderPassTest::constructMove,
+
+              &RenderPassTest::colorAttachmentDefaultFramebufferInvalidLocation,
+              &RenderPassTest::endNotActive,
+
+              &RenderPassTest::debugLoad,
+              &RenderPassTest::debugStore});
+}
+
+void RenderPassTest::construct() {
+    /* No GL calls are made on construction or when describing attachments */
+    RenderPass pass{defaultFramebuffer};
+    pass.setColorAttachment(0, RenderPassLoad::Clear, RenderPassStore::Store)
+        .setDepthAttachment(RenderPassLoad::DontCare, RenderPassStore::DontCare)
+        .setStencilAttachment(RenderPassLoad::Clear, RenderPassStore::DontCare, 1);
+    CORRADE_VERIFY(!pass.isActive());
+}
+
+void RenderPassTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<RenderPass>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<RenderPass>{});
+}
+
+void RenderPassTest::constructMove() {
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<RenderPass>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<RenderPass>::value);
+}
+
+void RenderPassTest::colorAttachmentDefaultFramebufferInvalidLocation() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    RenderPass pass{defaultFramebuffer};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    pass.setColorAttachment(1, RenderPassLoad::Clear, RenderPassStore::Store);
+    CORRADE_COMPARE(out.str(), "GL::RenderPass::setColorAttachment(): only location 0 is available for the default framebuffer, got 1\n");
+}
+
+void RenderPassTest::endNotActive() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    RenderPass pass{defaultFramebuffer};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    pass.end();
+    CORRADE_COMPARE(out.str(), "GL::RenderPass::end(): the pass isn't active\n");
+}
+
+void RenderPassTest::debugLoad() {
+    std::ostringstream out;
+    Debug{&out} << RenderPassLoad::DontCare << RenderPassLoad(0xde);
+    CORRADE_COMPARE(out.str(), "GL::RenderPassLoad::DontCare GL::RenderPassLoad(0xde)\n");
+}
+
+void RenderPassTest::debugStore() {
+    std::ostringstream out;
+    Debug{&out} << RenderPassStore::Store << RenderPassStore(0xde);
+    CORRADE_COMPARE(out.str(), "GL::RenderPassStore::Store GL::RenderPassStore(0xde)\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::GL::Test::RenderPassTest)
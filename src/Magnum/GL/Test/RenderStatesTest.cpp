@@ -0,0 +1,180 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <type_traits>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/GL/RenderStates.h"
+
+namespace Magnum { namespace GL { namespace Test { namespace {
+
+struct RenderStatesTest: TestSuite::Tester {
+    explicit RenderStatesTest();
+
+    void blendConstructDefault();
+    void blendSetters();
+    void depthStencilConstructDefault();
+    void depthStencilSetters();
+    void rasterConstructDefault();
+    void rasterSetters();
+};
+
+RenderStatesTest::RenderStatesTest() {
+    addTests({&RenderStatesTest::blendConstructDefault,
+              &RenderStatesTest::blendSetters,
+              &RenderStatesTest::depthStencilConstructDefault,
+              &RenderStatesTest::depthStencilSetters,
+              &RenderStatesTest::rasterConstructDefault,
+              &RenderStatesTest::rasterSetters});
+}
+
+void RenderStatesTest::blendConstructDefault() {
+    constexpr BlendState a;
+    constexpr bool enabled = a.isEnabled();
+    constexpr Renderer::BlendEquation equationRgb = a.equationRgb();
+    constexpr Renderer::BlendFunction destinationAlpha = a.destinationAlpha();
+    constexpr BitVector4 colorMask = a.colorMask();
+    CORRADE_VERIFY(!enabled);
+    CORRADE_VERIFY(equationRgb == Renderer::BlendEquation::Add);
+    CORRADE_VERIFY(a.equationAlpha() == Renderer::BlendEquation::Add);
+    CORRADE_VERIFY(a.sourceRgb() == Renderer::BlendFunction::One);
+    CORRADE_VERIFY(a.destinationRgb() == Renderer::BlendFunction::Zero);
+    CORRADE_VERIFY(a.sourceAlpha() == Renderer::BlendFunction::One);
+    CORRADE_VERIFY(destinationAlpha == Renderer::BlendFunction::Zero);
+    CORRADE_COMPARE(colorMask, BitVector4{0xf});
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<BlendState>::value);
+}
+
+void RenderStatesTest::blendSetters() {
+    BlendState a;
+    a.setEnabled(true)
+     .setEquation(Renderer::BlendEquation::Subtract)
+     .setFunction(Renderer::BlendFunction::SourceAlpha, Renderer::BlendFunction::OneMinusSourceAlpha)
+     .setColorMask(true, false, true, false);
+    CORRADE_VERIFY(a.isEnabled());
+    CORRADE_VERIFY(a.equationRgb() == Renderer::BlendEquation::Subtract);
+    CORRADE_VERIFY(a.equationAlpha() == Renderer::BlendEquation::Subtract);
+    CORRADE_VERIFY(a.sourceRgb() == Renderer::BlendFunction::SourceAlpha);
+    CORRADE_VERIFY(a.destinationRgb() == Renderer::BlendFunction::OneMinusSourceAlpha);
+    CORRADE_VERIFY(a.sourceAlpha() == Renderer::BlendFunction::SourceAlpha);
+    CORRADE_VERIFY(a.destinationAlpha() == Renderer::BlendFunction::OneMinusSourceAlpha);
+    CORRADE_COMPARE(a.colorMask(), BitVector4{0x5});
+
+    a.setEquation(Renderer::BlendEquation::Add, Renderer::BlendEquation::ReverseSubtract)
+     .setFunction(Renderer::BlendFunction::One, Renderer::BlendFunction::Zero, Renderer::BlendFunction::DestinationAlpha, Renderer::BlendFunction::SourceColor);
+    CORRADE_VERIFY(a.equationRgb() == Renderer::BlendEquation::Add);
+    CORRADE_VERIFY(a.equationAlpha() == Renderer::BlendEquation::ReverseSubtract);
+    CORRADE_VERIFY(a.sourceRgb() == Renderer::BlendFunction::One);
+    CORRADE_VERIFY(a.destinationRgb() == Renderer::BlendFunction::Zero);
+    CORRADE_VERIFY(a.sourceAlpha() == Renderer::BlendFunction::DestinationAlpha);
+    CORRADE_VERIFY(a.destinationAlpha() == Renderer::BlendFunction::SourceColor);
+}
+
+void RenderStatesTest::depthStencilConstructDefault() {
+    constexpr DepthStencilState a;
+    constexpr bool depthTestEnabled = a.isDepthTestEnabled();
+    constexpr UnsignedInt stencilWriteMask = a.stencilWriteMask();
+    CORRADE_VERIFY(!depthTestEnabled);
+    CORRADE_VERIFY(a.depthFunction() == Renderer::DepthFunction::Less);
+    CORRADE_VERIFY(a.isDepthWriteEnabled());
+    CORRADE_VERIFY(!a.isStencilTestEnabled());
+    CORRADE_VERIFY(a.stencilFunction() == Renderer::StencilFunction::Always);
+    CORRADE_COMPARE(a.stencilReferenceValue(), 0);
+    CORRADE_COMPARE(a.stencilFunctionMask(), 0xffffffffu);
+    CORRADE_VERIFY(a.stencilFailOperation() == Renderer::StencilOperation::Keep);
+    CORRADE_VERIFY(a.depthFailOperation() == Renderer::StencilOperation::Keep);
+    CORRADE_VERIFY(a.depthPassOperation() == Renderer::StencilOperation::Keep);
+    CORRADE_COMPARE(stencilWriteMask, 0xffffffffu);
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<DepthStencilState>::value);
+}
+
+void RenderStatesTest::depthStencilSetters() {
+    DepthStencilState a;
+    a.setDepthTestEnabled(true)
+     .setDepthFunction(Renderer::DepthFunction::GreaterOrEqual)
+     .setDepthWriteEnabled(false)
+     .setStencilTestEnabled(true)
+     .setStencilFunction(Renderer::StencilFunction::NotEqual, 3, 0x0f)
+     .setStencilOperation(Renderer::StencilOperation::Zero, Renderer::StencilOperation::Invert, Renderer::StencilOperation::Replace)
+     .setStencilWriteMask(0xf0u);
+    CORRADE_VERIFY(a.isDepthTestEnabled());
+    CORRADE_VERIFY(a.depthFunction() == Renderer::DepthFunction::GreaterOrEqual);
+    CORRADE_VERIFY(!a.isDepthWriteEnabled());
+    CORRADE_VERIFY(a.isStencilTestEnabled());
+    CORRADE_VERIFY(a.stencilFunction() == Renderer::StencilFunction::NotEqual);
+    CORRADE_COMPARE(a.stencilReferenceValue(), 3);
+    CORRADE_COMPARE(a.stencilFunctionMask(), 0x0fu);
+    CORRADE_VERIFY(a.stencilFailOperation() == Renderer::StencilOperation::Zero);
+    CORRADE_VERIFY(a.depthFailOperation() == Renderer::StencilOperation::Invert);
+    CORRADE_VERIFY(a.depthPassOperation() == Renderer::StencilOperation::Replace);
+    CORRADE_COMPARE(a.stencilWriteMask(), 0xf0u);
+}
+
+void RenderStatesTest::rasterConstructDefault() {
+    constexpr RasterState a;
+    constexpr bool faceCullingEnabled = a.isFaceCullingEnabled();
+    constexpr Renderer::FrontFace frontFace = a.frontFace();
+    CORRADE_VERIFY(!faceCullingEnabled);
+    CORRADE_VERIFY(a.faceCullingMode() == Renderer::PolygonFacing::Back);
+    CORRADE_VERIFY(frontFace == Renderer::FrontFace::CounterClockWise);
+    #ifndef MAGNUM_TARGET_WEBGL
+    CORRADE_VERIFY(a.polygonMode() == Renderer::PolygonMode::Fill);
+    #endif
+    CORRADE_VERIFY(!a.isPolygonOffsetFillEnabled());
+    CORRADE_COMPARE(a.polygonOffsetFactor(), 0.0f);
+    CORRADE_COMPARE(a.polygonOffsetUnits(), 0.0f);
+    CORRADE_VERIFY(!a.isScissorTestEnabled());
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<RasterState>::value);
+}
+
+void RenderStatesTest::rasterSetters() {
+    RasterState a;
+    a.setFaceCullingEnabled(true)
+     .setFaceCullingMode(Renderer::PolygonFacing::FrontAndBack)
+     .setFrontFace(Renderer::FrontFace::ClockWise)
+     #ifndef MAGNUM_TARGET_WEBGL
+     .setPolygonMode(Renderer::PolygonMode::Line)
+     #endif
+     .setPolygonOffsetFillEnabled(true)
+     .setPolygonOffset(1.5f, -2.0f)
+     .setScissorTestEnabled(true);
+    CORRADE_VERIFY(a.isFaceCullingEnabled());
+    CORRADE_VERIFY(a.faceCullingMode() == Renderer::PolygonFacing::FrontAndBack);
+    CORRADE_VERIFY(a.frontFace() == Renderer::FrontFace::ClockWise);
+    #ifndef MAGNUM_TARGET_WEBGL
+    CORRADE_VERIFY(a.polygonMode() == Renderer::PolygonMode::Line);
+    #endif
+    CORRADE_VERIFY(a.isPolygonOffsetFillEnabled());
+    CORRADE_COMPARE(a.polygonOffsetFactor(), 1.5f);
+    CORRADE_COMPARE(a.polygonOffsetUnits(), -2.0f);
+    CORRADE_VERIFY(a.isScissorTestEnabled());
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::GL::Test::RenderStatesTest)
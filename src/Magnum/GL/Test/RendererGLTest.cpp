@@ -44,6 +44,7 @@
 #include "Magnum/GL/OpenGLTester.h"
 #include "Magnum/GL/PixelFormat.h"
 #include "Magnum/GL/Renderer.h"
+#include "Magnum/GL/RenderStates.h"
 #include "Magnum/GL/Renderbuffer.h"
 #include "Magnum/GL/RenderbufferFormat.h"
 #include "Magnum/GL/Shader.h"
@@ -69,6 +70,10 @@ struct RendererGLTest: OpenGLTester {
     void drawBuffersBlend();
     #endif
 
+    void applyStateBlocks();
+    void applyStateBlocksDisengaged();
+    void applyStateBlocksResetState();
+
     private:
         PluginManager::Manager<Trade::AbstractImporter> _manager{"nonexistent"};
         Containers::String _testDir;
@@ -87,9 +92,11 @@ RendererGLTest::RendererGLTest() {
               #endif
               #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
               &RendererGLTest::drawBuffersIndexed,
-              &RendererGLTest::drawBuffersBlend
+              &RendererGLTest::drawBuffersBlend,
               #endif
-              });
+              &RendererGLTest::applyStateBlocks,
+              &RendererGLTest::applyStateBlocksDisengaged,
+              &RendererGLTest::applyStateBlocksResetState});
 
     /* Load the plugins directly from the build tree. Otherwise they're either
        static and already loaded or not present in the build tree */
@@ -299,6 +306,160 @@ void RendererGLTest::drawBuffersBlend() {
 }
 #endif
 
+void RendererGLTest::applyStateBlocks() {
+    Renderer::apply(BlendState{}
+        .setEnabled(true)
+        .setEquation(Renderer::BlendEquation::Add, Renderer::BlendEquation::Subtract)
+        .setFunction(Renderer::BlendFunction::One, Renderer::BlendFunction::OneMinusSourceAlpha, Renderer::BlendFunction::SourceAlpha, Renderer::BlendFunction::Zero)
+        .setColorMask(true, false, true, false));
+    Renderer::apply(DepthStencilState{}
+        .setDepthTestEnabled(true)
+        .setDepthFunction(Renderer::DepthFunction::LessOrEqual)
+        .setDepthWriteEnabled(false)
+        .setStencilTestEnabled(true)
+        .setStencilFunction(Renderer::StencilFunction::Equal, 1, 0xff)
+        .setStencilOperation(Renderer::StencilOperation::Keep, Renderer::StencilOperation::Keep, Renderer::StencilOperation::Replace)
+        .setStencilWriteMask(0x0f));
+    Renderer::apply(RasterState{}
+        .setFaceCullingEnabled(true)
+        .setFaceCullingMode(Renderer::PolygonFacing::Front)
+        .setFrontFace(Renderer::FrontFace::ClockWise)
+        .setPolygonOffsetFillEnabled(true)
+        .setPolygonOffset(1.0f, 2.0f)
+        .setScissorTestEnabled(true));
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    GLint value;
+    GLboolean colorMask[4];
+    Float polygonOffset;
+    CORRADE_VERIFY(glIsEnabled(GL_BLEND));
+    glGetIntegerv(GL_BLEND_EQUATION_ALPHA, &value);
+    CORRADE_COMPARE(value, GL_FUNC_SUBTRACT);
+    glGetIntegerv(GL_BLEND_DST_RGB, &value);
+    CORRADE_COMPARE(value, GL_ONE_MINUS_SRC_ALPHA);
+    glGetIntegerv(GL_BLEND_SRC_ALPHA, &value);
+    CORRADE_COMPARE(value, GL_SRC_ALPHA);
+    glGetBooleanv(GL_COLOR_WRITEMASK, colorMask);
+    CORRADE_VERIFY(colorMask[0]);
+    CORRADE_VERIFY(!colorMask[1]);
+    CORRADE_VERIFY(colorMask[2]);
+    CORRADE_VERIFY(!colorMask[3]);
+
+    CORRADE_VERIFY(glIsEnabled(GL_DEPTH_TEST));
+    glGetIntegerv(GL_DEPTH_FUNC, &value);
+    CORRADE_COMPARE(value, GL_LEQUAL);
+    CORRADE_VERIFY(glIsEnabled(GL_STENCIL_TEST));
+    glGetIntegerv(GL_STENCIL_FUNC, &value);
+    CORRADE_COMPARE(value, GL_EQUAL);
+    glGetIntegerv(GL_STENCIL_PASS_DEPTH_PASS, &value);
+    CORRADE_COMPARE(value, GL_REPLACE);
+    glGetIntegerv(GL_STENCIL_WRITEMASK, &value);
+    CORRADE_COMPARE(value, 0x0f);
+
+    CORRADE_VERIFY(glIsEnabled(GL_CULL_FACE));
+    glGetIntegerv(GL_CULL_FACE_MODE, &value);
+    CORRADE_COMPARE(value, GL_FRONT);
+    glGetIntegerv(GL_FRONT_FACE, &value);
+    CORRADE_COMPARE(value, GL_CW);
+    CORRADE_VERIFY(glIsEnabled(GL_POLYGON_OFFSET_FILL));
+    glGetFloatv(GL_POLYGON_OFFSET_UNITS, &polygonOffset);
+    CORRADE_COMPARE(polygonOffset, 2.0f);
+    CORRADE_VERIFY(glIsEnabled(GL_SCISSOR_TEST));
+
+    /* Applying the defaults should get back to the initial GL state */
+    Renderer::apply(BlendState{});
+    Renderer::apply(DepthStencilState{});
+    Renderer::apply(RasterState{});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_VERIFY(!glIsEnabled(GL_BLEND));
+    glGetBooleanv(GL_COLOR_WRITEMASK, colorMask);
+    CORRADE_VERIFY(colorMask[1]);
+    CORRADE_VERIFY(colorMask[3]);
+    CORRADE_VERIFY(!glIsEnabled(GL_DEPTH_TEST));
+    glGetIntegerv(GL_DEPTH_WRITEMASK, &value);
+    CORRADE_VERIFY(value);
+    CORRADE_VERIFY(!glIsEnabled(GL_STENCIL_TEST));
+    glGetIntegerv(GL_STENCIL_WRITEMASK, &value);
+    CORRADE_COMPARE(UnsignedInt(value) & 0xff, 0xff);
+    CORRADE_VERIFY(!glIsEnabled(GL_CULL_FACE));
+    glGetIntegerv(GL_FRONT_FACE, &value);
+    CORRADE_COMPARE(value, GL_CCW);
+    CORRADE_VERIFY(!glIsEnabled(GL_POLYGON_OFFSET_FILL));
+    CORRADE_VERIFY(!glIsEnabled(GL_SCISSOR_TEST));
+}
+
+void RendererGLTest::applyStateBlocksDisengaged() {
+    const DepthStencilState depth = DepthStencilState{}
+        .setDepthTestEnabled(true);
+    const BlendState blend = BlendState{}
+        .setEnabled(true);
+    const RasterState raster = RasterState{}
+        .setFaceCullingEnabled(true);
+    Renderer::apply(depth);
+    Renderer::apply(blend);
+    Renderer::apply(raster);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(glIsEnabled(GL_DEPTH_TEST));
+    CORRADE_VERIFY(glIsEnabled(GL_BLEND));
+    CORRADE_VERIFY(glIsEnabled(GL_CULL_FACE));
+
+    /* Changing the state through the regular APIs makes the next apply() set
+       the whole block again, even though it's the same as the last one */
+    Renderer::disable(Renderer::Feature::DepthTest);
+    Renderer::disable(Renderer::Feature::Blending);
+    Renderer::disable(Renderer::Feature::FaceCulling);
+    Renderer::apply(depth);
+    Renderer::apply(blend);
+    Renderer::apply(raster);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(glIsEnabled(GL_DEPTH_TEST));
+    CORRADE_VERIFY(glIsEnabled(GL_BLEND));
+    CORRADE_VERIFY(glIsEnabled(GL_CULL_FACE));
+
+    /* Setters other than enable() / disable() do the same */
+    Renderer::setDepthFunction(Renderer::DepthFunction::Greater);
+    Renderer::setColorMask(false, false, false, false);
+    Renderer::setFrontFace(Renderer::FrontFace::ClockWise);
+    Renderer::apply(depth);
+    Renderer::apply(blend);
+    Renderer::apply(raster);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    GLint value;
+    GLboolean colorMask[4];
+    glGetIntegerv(GL_DEPTH_FUNC, &value);
+    CORRADE_COMPARE(value, GL_LESS);
+    glGetBooleanv(GL_COLOR_WRITEMASK, colorMask);
+    CORRADE_VERIFY(colorMask[0]);
+    glGetIntegerv(GL_FRONT_FACE, &value);
+    CORRADE_COMPARE(value, GL_CCW);
+
+    Renderer::apply(DepthStencilState{});
+    Renderer::apply(BlendState{});
+    Renderer::apply(RasterState{});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void RendererGLTest::applyStateBlocksResetState() {
+    const DepthStencilState depth = DepthStencilState{}
+        .setDepthTestEnabled(true);
+    Renderer::apply(depth);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(glIsEnabled(GL_DEPTH_TEST));
+
+    /* External code changes the state behind our back. After resetting the
+       tracker, apply() sets the whole block again. */
+    glDisable(GL_DEPTH_TEST);
+    Context::current().resetState(Context::State::Renderer);
+    Renderer::apply(depth);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(glIsEnabled(GL_DEPTH_TEST));
+
+    Renderer::apply(DepthStencilState{});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::GL::Test::RendererGLTest)
@@ -23,9 +23,11 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <sstream>
 #include <Corrade/Containers/StringStl.h> /** @todo remove once Shader is <string>-free */
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Path.h>
+#include <Corrade/Utility/System.h>
 
 #include "Magnum/GL/Context.h"
 #include "Magnum/GL/Extensions.h"
@@ -57,6 +59,8 @@ struct ShaderGLTest: OpenGLTester {
     void compile();
     void compileUtf8();
     void compileNoVersion();
+    void compileAsync();
+    void compileAsyncFailure();
 };
 
 ShaderGLTest::ShaderGLTest() {
@@ -73,7 +77,9 @@ ShaderGLTest::ShaderGLTest() {
               &ShaderGLTest::addFile,
               &ShaderGLTest::compile,
               &ShaderGLTest::compileUtf8,
-              &ShaderGLTest::compileNoVersion});
+              &ShaderGLTest::compileNoVersion,
+              &ShaderGLTest::compileAsync,
+              &ShaderGLTest::compileAsyncFailure});
 }
 
 #ifndef MAGNUM_TARGET_WEBGL
@@ -315,6 +321,65 @@ void ShaderGLTest::compileNoVersion() {
     CORRADE_VERIFY(shader.compile());
 }
 
+void ShaderGLTest::compileAsync() {
+    #ifndef MAGNUM_TARGET_GLES
+    constexpr Version v =
+        #ifndef CORRADE_TARGET_APPLE
+        Version::GL210
+        #else
+        Version::GL310
+        #endif
+        ;
+    #else
+    constexpr Version v = Version::GLES200;
+    #endif
+
+    #ifndef MAGNUM_TARGET_WEBGL
+    /* A no-op if the extension isn't supported */
+    Shader::setMaxCompilerThreads(2);
+    #endif
+
+    Shader shader(v, Shader::Type::Fragment);
+    shader.addSource("void main() {}\n");
+    shader.submitCompile();
+
+    /* Without the extension it's always finished immediately */
+    if(!Context::current().isExtensionSupported<Extensions::KHR::parallel_shader_compile>())
+        CORRADE_VERIFY(shader.isCompileFinished());
+    else while(!shader.isCompileFinished())
+        Utility::System::sleep(10);
+
+    CORRADE_VERIFY(shader.checkCompile());
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void ShaderGLTest::compileAsyncFailure() {
+    #ifndef MAGNUM_TARGET_GLES
+    constexpr Version v =
+        #ifndef CORRADE_TARGET_APPLE
+        Version::GL210
+        #else
+        Version::GL310
+        #endif
+        ;
+    #else
+    constexpr Version v = Version::GLES200;
+    #endif
+
+    Shader shader(v, Shader::Type::Fragment);
+    shader.addSource("[fu] bleh error #:! stuff\n");
+    shader.submitCompile();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* The submission itself doesn't print anything, only the check does */
+    std::ostringstream out;
+    {
+        Error redirectError{&out};
+        CORRADE_VERIFY(!shader.checkCompile());
+    }
+    CORRADE_VERIFY(out.str().find("GL::Shader::compile(): compilation of fragment shader failed with the following message:") == 0);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::GL::Test::ShaderGLTest)
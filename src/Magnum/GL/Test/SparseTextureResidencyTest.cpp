@@ -0,0 +1,260 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/GL/SparseTextureResidency.h"
+#include "Magnum/Math/Range.h"
+
+namespace Magnum { namespace GL { namespace Test { namespace {
+
+struct SparseTextureResidencyTest: TestSuite::Tester {
+    explicit SparseTextureResidencyTest();
+
+    void construct();
+    void constructInvalid();
+    void constructCopy();
+    void constructMove();
+
+    void request();
+    void requestRange();
+    void requestInvalid();
+
+    void update();
+    void updateEvictionDelay();
+};
+
+SparseTextureResidencyTest::SparseTextureResidencyTest() {
+    addTests({&SparseTextureResidencyTest::construct,
+              &SparseTextureResidencyTest::constructInvalid,
+              &SparseTextureResidencyTest::constructCopy,
+              &SparseTextureResidencyTest::constructMove,
+
+              &SparseTextureResidencyTest::request,
+              &SparseTextureResidencyTest::requestRange,
+              &SparseTextureResidencyTest::requestInvalid,
+
+              &SparseTextureResidencyTest::update,
+              &SparseTextureResidencyTest::updateEvictionDelay});
+}
+
+struct Change {
+    Int level;
+    Range2Di range;
+    bool commit;
+};
+
+void recordChange(Int level, const Range2Di& range, bool commit, void* userData) {
+    arrayAppend(*static_cast<Containers::Array<Change>*>(userData), Change{level, range, commit});
+}
+
+void SparseTextureResidencyTest::construct() {
+    SparseTextureResidency residency{{1000, 300}, {256, 128}, 3, 2};
+    CORRADE_COMPARE(residency.size(), (Vector2i{1000, 300}));
+    CORRADE_COMPARE(residency.pageSize(), (Vector2i{256, 128}));
+    CORRADE_COMPARE(residency.levelCount(), 3);
+    CORRADE_COMPARE(residency.evictionDelay(), 2);
+    CORRADE_COMPARE(residency.residentPageCount(), 0);
+
+    /* Partial pages at the edges are counted as well */
+    CORRADE_COMPARE(residency.pageCount(0), (Vector2i{4, 3}));
+    CORRADE_COMPARE(residency.pageCount(1), (Vector2i{2, 2}));
+    CORRADE_COMPARE(residency.pageCount(2), (Vector2i{1, 1}));
+
+    CORRADE_VERIFY(!residency.isResident(0, {3, 2}));
+    CORRADE_VERIFY(!residency.isRequested(0, {3, 2}));
+}
+
+void SparseTextureResidencyTest::constructInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    SparseTextureResidency{{0, 300}, {256, 128}, 1};
+    SparseTextureResidency{{1000, 300}, {256, 0}, 1};
+    SparseTextureResidency{{1000, 300}, {256, 128}, 0};
+    CORRADE_COMPARE(out.str(),
+        "GL::SparseTextureResidency: expected non-zero size but got {0, 300}\n"
+        "GL::SparseTextureResidency: expected non-zero page size but got {256, 0}\n"
+        "GL::SparseTextureResidency: expected non-zero level count\n");
+}
+
+void SparseTextureResidencyTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<SparseTextureResidency>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<SparseTextureResidency>{});
+}
+
+void SparseTextureResidencyTest::constructMove() {
+    SparseTextureResidency a{{512, 512}, {128, 128}, 1};
+    a.request(0, {1, 2});
+
+    SparseTextureResidency b = std::move(a);
+    CORRADE_COMPARE(b.size(), (Vector2i{512, 512}));
+    CORRADE_VERIFY(b.isRequested(0, {1, 2}));
+
+    SparseTextureResidency c{{32, 32}, {16, 16}, 1};
+    c = std::move(b);
+    CORRADE_COMPARE(c.size(), (Vector2i{512, 512}));
+    CORRADE_VERIFY(c.isRequested(0, {1, 2}));
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<SparseTextureResidency>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<SparseTextureResidency>::value);
+}
+
+void SparseTextureResidencyTest::request() {
+    SparseTextureResidency residency{{512, 512}, {128, 128}, 2};
+    residency.request(0, {1, 2});
+    residency.request(1, {0, 1});
+    CORRADE_VERIFY(residency.isRequested(0, {1, 2}));
+    CORRADE_VERIFY(!residency.isRequested(0, {2, 1}));
+    CORRADE_VERIFY(residency.isRequested(1, {0, 1}));
+    CORRADE_VERIFY(!residency.isRequested(1, {1, 0}));
+
+    /* Requests aren't commits */
+    CORRADE_VERIFY(!residency.isResident(0, {1, 2}));
+    CORRADE_COMPARE(residency.residentPageCount(), 0);
+}
+
+void SparseTextureResidencyTest::requestRange() {
+    SparseTextureResidency residency{{512, 512}, {128, 128}, 1};
+
+    /* Overlaps pages 0 to 2 in X and 1 to 2 in Y, the negative part is
+       ignored */
+    residency.request(0, Range2Di{{-20, 130}, {257, 300}});
+    for(Int y = 0; y != 4; ++y) for(Int x = 0; x != 4; ++x) {
+        CORRADE_ITERATION(x, y);
+        CORRADE_COMPARE(residency.isRequested(0, {x, y}), x <= 2 && y >= 1 && y <= 2);
+    }
+
+    /* Completely outside does nothing */
+    residency.request(0, Range2Di{{600, 600}, {700, 700}});
+    CORRADE_VERIFY(!residency.isRequested(0, {3, 3}));
+}
+
+void SparseTextureResidencyTest::requestInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    SparseTextureResidency residency{{512, 256}, {128, 128}, 2};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    residency.pageCount(2);
+    residency.isResident(2, {});
+    residency.isResident(0, {4, 0});
+    residency.isRequested(2, {});
+    residency.isRequested(1, {0, 1});
+    residency.request(2, Vector2i{});
+    residency.request(0, Vector2i{0, 2});
+    residency.request(2, Range2Di{});
+    CORRADE_COMPARE(out.str(),
+        "GL::SparseTextureResidency::pageCount(): level 2 out of range for 2 levels\n"
+        "GL::SparseTextureResidency::isResident(): level 2 out of range for 2 levels\n"
+        "GL::SparseTextureResidency::isResident(): page {4, 0} out of range for {4, 2} pages in level 0\n"
+        "GL::SparseTextureResidency::isRequested(): level 2 out of range for 2 levels\n"
+        "GL::SparseTextureResidency::isRequested(): page {0, 1} out of range for {2, 1} pages in level 1\n"
+        "GL::SparseTextureResidency::request(): level 2 out of range for 2 levels\n"
+        "GL::SparseTextureResidency::request(): page {0, 2} out of range for {4, 2} pages in level 0\n"
+        "GL::SparseTextureResidency::request(): level 2 out of range for 2 levels\n");
+}
+
+void SparseTextureResidencyTest::update() {
+    SparseTextureResidency residency{{300, 256}, {128, 128}, 2};
+
+    /* Committing, the edge page gets clamped to the level size */
+    residency.request(0, {2, 1});
+    residency.request(1, {0, 0});
+    {
+        Containers::Array<Change> changes;
+        CORRADE_COMPARE(residency.update(recordChange, &changes), 2);
+        CORRADE_COMPARE(changes.size(), 2);
+        CORRADE_COMPARE(changes[0].level, 0);
+        CORRADE_COMPARE(changes[0].range, (Range2Di{{256, 128}, {300, 256}}));
+        CORRADE_VERIFY(changes[0].commit);
+        CORRADE_COMPARE(changes[1].level, 1);
+        CORRADE_COMPARE(changes[1].range, (Range2Di{{0, 0}, {128, 128}}));
+        CORRADE_VERIFY(changes[1].commit);
+    }
+    CORRADE_VERIFY(residency.isResident(0, {2, 1}));
+    CORRADE_VERIFY(residency.isResident(1, {0, 0}));
+    CORRADE_VERIFY(!residency.isRequested(0, {2, 1}));
+    CORRADE_COMPARE(residency.residentPageCount(), 2);
+
+    /* Requesting an already resident page does nothing, the other one gets
+       evicted as it wasn't requested */
+    residency.request(0, {2, 1});
+    {
+        Containers::Array<Change> changes;
+        CORRADE_COMPARE(residency.update(recordChange, &changes), 1);
+        CORRADE_COMPARE(changes.size(), 1);
+        CORRADE_COMPARE(changes[0].level, 1);
+        CORRADE_COMPARE(changes[0].range, (Range2Di{{0, 0}, {128, 128}}));
+        CORRADE_VERIFY(!changes[0].commit);
+    }
+    CORRADE_VERIFY(residency.isResident(0, {2, 1}));
+    CORRADE_VERIFY(!residency.isResident(1, {0, 0}));
+    CORRADE_COMPARE(residency.residentPageCount(), 1);
+
+    /* Nothing requested, everything gets evicted, subsequent update does
+       nothing */
+    {
+        Containers::Array<Change> changes;
+        CORRADE_COMPARE(residency.update(recordChange, &changes), 1);
+        CORRADE_COMPARE(residency.update(recordChange, &changes), 0);
+    }
+    CORRADE_COMPARE(residency.residentPageCount(), 0);
+}
+
+void SparseTextureResidencyTest::updateEvictionDelay() {
+    SparseTextureResidency residency{{256, 256}, {128, 128}, 1, 2};
+
+    residency.request(0, {1, 1});
+    Containers::Array<Change> changes;
+    CORRADE_COMPARE(residency.update(recordChange, &changes), 1);
+
+    /* The page stays resident for two more updates */
+    CORRADE_COMPARE(residency.update(recordChange, &changes), 0);
+    CORRADE_COMPARE(residency.update(recordChange, &changes), 0);
+    CORRADE_VERIFY(residency.isResident(0, {1, 1}));
+
+    /* Requesting it again restarts the delay */
+    residency.request(0, {1, 1});
+    CORRADE_COMPARE(residency.update(recordChange, &changes), 0);
+    CORRADE_COMPARE(residency.update(recordChange, &changes), 0);
+    CORRADE_COMPARE(residency.update(recordChange, &changes), 0);
+    CORRADE_VERIFY(residency.isResident(0, {1, 1}));
+
+    CORRADE_COMPARE(residency.update(recordChange, &changes), 1);
+    CORRADE_VERIFY(!residency.isResident(0, {1, 1}));
+    CORRADE_COMPARE(changes.size(), 2);
+    CORRADE_VERIFY(changes[0].commit);
+    CORRADE_VERIFY(!changes[1].commit);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::GL::Test::SparseTextureResidencyTest)
@@ -0,0 +1,315 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/GL/Buffer.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/GL/StreamingBuffer.h"
+
+namespace Magnum { namespace GL { namespace Test { namespace {
+
+struct StreamingBufferGLTest: OpenGLTester {
+    explicit StreamingBufferGLTest();
+
+    void construct();
+    void constructInvalid();
+    void constructMove();
+
+    void allocate();
+    void allocateAligned();
+    void allocateWrapAround();
+    void allocateTooLarge();
+    void allocateNotFenced();
+    void offsetNotFromBuffer();
+
+    void fence();
+    void fenceNothingAllocated();
+    void fenceTooMany();
+
+    void bind();
+};
+
+StreamingBufferGLTest::StreamingBufferGLTest() {
+    addTests({&StreamingBufferGLTest::construct,
+              &StreamingBufferGLTest::constructInvalid,
+              &StreamingBufferGLTest::constructMove,
+
+              &StreamingBufferGLTest::allocate,
+              &StreamingBufferGLTest::allocateAligned,
+              &StreamingBufferGLTest::allocateWrapAround,
+              &StreamingBufferGLTest::allocateTooLarge,
+              &StreamingBufferGLTest::allocateNotFenced,
+              &StreamingBufferGLTest::offsetNotFromBuffer,
+
+              &StreamingBufferGLTest::fence,
+              &StreamingBufferGLTest::fenceNothingAllocated,
+              &StreamingBufferGLTest::fenceTooMany,
+
+              &StreamingBufferGLTest::bind});
+}
+
+#define SKIP_IF_NO_BUFFER_STORAGE()                                         \
+    if(!Context::current().isExtensionSupported<Extensions::ARB::buffer_storage>()) \
+        CORRADE_SKIP(Extensions::ARB::buffer_storage::string() << "is not supported.")
+
+void StreamingBufferGLTest::construct() {
+    SKIP_IF_NO_BUFFER_STORAGE();
+
+    {
+        StreamingBuffer buffer{1024, 16};
+
+        MAGNUM_VERIFY_NO_GL_ERROR();
+        CORRADE_VERIFY(buffer.buffer().id() > 0);
+        CORRADE_COMPARE(buffer.buffer().size(), 1024);
+        CORRADE_COMPARE(buffer.size(), 1024);
+        CORRADE_COMPARE(buffer.alignment(), 16);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void StreamingBufferGLTest::constructInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    StreamingBuffer{1024, 0};
+    StreamingBuffer{0, 16};
+    StreamingBuffer{1000, 16};
+    CORRADE_COMPARE(out.str(),
+        "GL::StreamingBuffer: expected a non-zero alignment\n"
+        "GL::StreamingBuffer: expected a non-zero size that's a multiple of 16 but got 0\n"
+        "GL::StreamingBuffer: expected a non-zero size that's a multiple of 16 but got 1000\n");
+}
+
+void StreamingBufferGLTest::constructMove() {
+    SKIP_IF_NO_BUFFER_STORAGE();
+
+    StreamingBuffer a{1024, 16};
+    const UnsignedInt id = a.buffer().id();
+    a.allocate(32);
+    a.fence();
+
+    StreamingBuffer b{std::move(a)};
+    CORRADE_COMPARE(a.buffer().id(), 0);
+    CORRADE_COMPARE(a.size(), 0);
+    CORRADE_COMPARE(b.buffer().id(), id);
+    CORRADE_COMPARE(b.size(), 1024);
+    CORRADE_COMPARE(b.alignment(), 16);
+
+    StreamingBuffer c{256, 4};
+    const UnsignedInt cId = c.buffer().id();
+    c = std::move(b);
+    CORRADE_COMPARE(b.buffer().id(), cId);
+    CORRADE_COMPARE(b.size(), 256);
+    CORRADE_COMPARE(c.buffer().id(), id);
+    CORRADE_COMPARE(c.size(), 1024);
+
+    /* The allocation continues where it left off */
+    CORRADE_COMPARE(c.offset(c.allocate(16)), 32);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<StreamingBuffer>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<StreamingBuffer>::value);
+}
+
+void StreamingBufferGLTest::allocate() {
+    SKIP_IF_NO_BUFFER_STORAGE();
+
+    StreamingBuffer buffer{64};
+
+    Containers::ArrayView<char> a = buffer.allocate(12);
+    Containers::ArrayView<char> b = buffer.allocate(20);
+    CORRADE_COMPARE(a.size(), 12);
+    CORRADE_COMPARE(b.size(), 20);
+    CORRADE_COMPARE(buffer.offset(a), 0);
+    CORRADE_COMPARE(buffer.offset(b), 12);
+
+    for(std::size_t i = 0; i != a.size(); ++i) a[i] = char(i);
+    for(std::size_t i = 0; i != b.size(); ++i) b[i] = char(100 + i);
+    buffer.fence();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Copy the data elsewhere to verify they made it to the GPU */
+    Buffer copy;
+    copy.setData({nullptr, 32}, BufferUsage::StaticRead);
+    Buffer::copy(buffer.buffer(), copy, 0, 0, 32);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    char expected[32];
+    for(std::size_t i = 0; i != 12; ++i) expected[i] = char(i);
+    for(std::size_t i = 0; i != 20; ++i) expected[12 + i] = char(100 + i);
+    CORRADE_COMPARE_AS(copy.data(),
+        Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void StreamingBufferGLTest::allocateAligned() {
+    SKIP_IF_NO_BUFFER_STORAGE();
+
+    StreamingBuffer buffer{256, 16};
+    CORRADE_COMPARE(buffer.offset(buffer.allocate(4)), 0);
+    CORRADE_COMPARE(buffer.offset(buffer.allocate(17)), 16);
+    CORRADE_COMPARE(buffer.offset(buffer.allocate(16)), 48);
+    CORRADE_COMPARE(buffer.offset(buffer.allocate(1)), 64);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void StreamingBufferGLTest::allocateWrapAround() {
+    SKIP_IF_NO_BUFFER_STORAGE();
+
+    StreamingBuffer buffer{64, 4};
+
+    CORRADE_COMPARE(buffer.offset(buffer.allocate(40)), 0);
+    buffer.fence();
+
+    /* Doesn't fit before the end, goes to the beginning. That range is
+       still guarded by the fence, so it gets waited on. */
+    CORRADE_COMPARE(buffer.offset(buffer.allocate(32)), 0);
+    buffer.fence();
+    CORRADE_COMPARE(buffer.offset(buffer.allocate(32)), 32);
+    buffer.fence();
+
+    /* Exactly at the end, wraps to the beginning again */
+    CORRADE_COMPARE(buffer.offset(buffer.allocate(64)), 0);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void StreamingBufferGLTest::allocateTooLarge() {
+    SKIP_IF_NO_BUFFER_STORAGE();
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    StreamingBuffer buffer{64, 4};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    buffer.allocate(65);
+    CORRADE_COMPARE(out.str(),
+        "GL::StreamingBuffer::allocate(): can't allocate 65 bytes in a buffer of 64 bytes\n");
+}
+
+void StreamingBufferGLTest::allocateNotFenced() {
+    SKIP_IF_NO_BUFFER_STORAGE();
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    StreamingBuffer buffer{64, 4};
+    buffer.allocate(40);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    buffer.allocate(32);
+    CORRADE_COMPARE(out.str(),
+        "GL::StreamingBuffer::allocate(): can't allocate 32 bytes, only 24 bytes left until the next fence()\n");
+}
+
+void StreamingBufferGLTest::offsetNotFromBuffer() {
+    SKIP_IF_NO_BUFFER_STORAGE();
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    StreamingBuffer buffer{64, 4};
+    char data[4];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    buffer.offset(data);
+    CORRADE_COMPARE(out.str(),
+        "GL::StreamingBuffer::offset(): allocation not from this buffer\n");
+}
+
+void StreamingBufferGLTest::fence() {
+    SKIP_IF_NO_BUFFER_STORAGE();
+
+    StreamingBuffer buffer{64, 4};
+
+    /* Simulate a few frames each using half of the buffer */
+    for(std::size_t i = 0; i != 8; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(buffer.offset(buffer.allocate(32)), i % 2 ? 32 : 0);
+        buffer.fence();
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void StreamingBufferGLTest::fenceNothingAllocated() {
+    SKIP_IF_NO_BUFFER_STORAGE();
+
+    StreamingBuffer buffer{64, 4};
+
+    /* Neither of these should do anything, nor fail */
+    buffer.fence();
+    buffer.allocate(16);
+    buffer.fence()
+        .fence()
+        .fence();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void StreamingBufferGLTest::fenceTooMany() {
+    SKIP_IF_NO_BUFFER_STORAGE();
+
+    StreamingBuffer buffer{1024, 4};
+
+    /* More fences than the internal limit, the oldest should be waited on
+       and everything should still work */
+    for(std::size_t i = 0; i != 40; ++i) {
+        CORRADE_ITERATION(i);
+        buffer.allocate(4);
+        buffer.fence();
+    }
+
+    CORRADE_COMPARE(buffer.offset(buffer.allocate(4)), 160);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void StreamingBufferGLTest::bind() {
+    SKIP_IF_NO_BUFFER_STORAGE();
+
+    StreamingBuffer buffer{4096, std::size_t(Buffer::uniformOffsetAlignment())};
+    buffer.allocate(4);
+    Containers::ArrayView<char> allocation = buffer.allocate(64);
+    CORRADE_COMPARE(buffer.offset(allocation), Buffer::uniformOffsetAlignment());
+
+    buffer.bind(Buffer::Target::Uniform, 0, allocation);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::GL::Test::StreamingBufferGLTest)
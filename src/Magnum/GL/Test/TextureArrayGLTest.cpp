@@ -81,6 +81,10 @@ struct TextureArrayGLTest: OpenGLTester {
     void bindImage2D();
     #endif
 
+    #ifndef MAGNUM_TARGET_GLES
+    void bindlessHandle2D();
+    #endif
+
     #ifndef MAGNUM_TARGET_GLES
     template<class T> void sampling1D();
     #endif
@@ -312,6 +316,10 @@ TextureArrayGLTest::TextureArrayGLTest() {
         &TextureArrayGLTest::bindImage2D,
         #endif
 
+        #ifndef MAGNUM_TARGET_GLES
+        &TextureArrayGLTest::bindlessHandle2D,
+        #endif
+
         #ifndef MAGNUM_TARGET_GLES
         &TextureArrayGLTest::sampling1D<GenericSampler>,
         &TextureArrayGLTest::sampling1D<GLSampler>,
@@ -659,6 +667,33 @@ void TextureArrayGLTest::bindImage2D() {
 }
 #endif
 
+#ifndef MAGNUM_TARGET_GLES
+void TextureArrayGLTest::bindlessHandle2D() {
+    if(!Context::current().isExtensionSupported<Extensions::ARB::bindless_texture>())
+        CORRADE_SKIP(Extensions::ARB::bindless_texture::string() << "is not supported.");
+
+    Texture2DArray texture;
+    texture.setMinificationFilter(SamplerFilter::Linear)
+        .setMagnificationFilter(SamplerFilter::Linear)
+        .setStorage(1, TextureFormat::RGBA8, (Vector3i{32, 32, 4}));
+
+    const UnsignedLong handle = texture.handle();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(handle);
+    /* Repeated queries return the same handle */
+    CORRADE_COMPARE(texture.handle(), handle);
+    CORRADE_VERIFY(!AbstractTexture::isHandleResident(handle));
+
+    AbstractTexture::makeHandleResident(handle);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(AbstractTexture::isHandleResident(handle));
+
+    AbstractTexture::makeHandleNonResident(handle);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(!AbstractTexture::isHandleResident(handle));
+}
+#endif
+
 #ifndef MAGNUM_TARGET_GLES
 template<class T> void TextureArrayGLTest::sampling1D() {
     setTestCaseTemplateName(std::is_same<T, GenericSampler>::value ?
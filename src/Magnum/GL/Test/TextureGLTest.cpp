@@ -24,6 +24,7 @@
 */
 
 #include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
 
 #include "Magnum/Image.h"
 #include "Magnum/ImageView.h"
@@ -37,6 +38,9 @@
 #endif
 #include "Magnum/GL/OpenGLTester.h"
 #include "Magnum/GL/PixelFormat.h"
+#ifndef MAGNUM_TARGET_GLES
+#include "Magnum/GL/SparseTextureResidency.h"
+#endif
 #include "Magnum/GL/Texture.h"
 #include "Magnum/GL/TextureFormat.h"
 #include "Magnum/Math/Color.h"
@@ -93,6 +97,12 @@ struct TextureGLTest: OpenGLTester {
     void bindImage3D();
     #endif
 
+    #ifndef MAGNUM_TARGET_GLES
+    void bindlessHandle2D();
+    void sparse2D();
+    void sparseResidency2D();
+    #endif
+
     #ifndef MAGNUM_TARGET_GLES
     template<class T> void sampling1D();
     #endif
@@ -184,6 +194,10 @@ struct TextureGLTest: OpenGLTester {
     #ifndef MAGNUM_TARGET_GLES2
     void subImage2DBuffer();
     #endif
+    void subImages2D();
+    #ifndef MAGNUM_TARGET_GLES2
+    void subImages2DStaging();
+    #endif
     #ifndef MAGNUM_TARGET_GLES
     void subImage2DQuery();
     void subImage2DQueryView();
@@ -481,6 +495,12 @@ TextureGLTest::TextureGLTest() {
         &TextureGLTest::bindImage3D,
         #endif
 
+        #ifndef MAGNUM_TARGET_GLES
+        &TextureGLTest::bindlessHandle2D,
+        &TextureGLTest::sparse2D,
+        &TextureGLTest::sparseResidency2D,
+        #endif
+
         #ifndef MAGNUM_TARGET_GLES
         &TextureGLTest::sampling1D<GenericSampler>,
         &TextureGLTest::sampling1D<GLSampler>,
@@ -584,6 +604,12 @@ TextureGLTest::TextureGLTest() {
         #endif
         }, Containers::arraySize(PixelStorage2DData));
 
+    addTests({&TextureGLTest::subImages2D,
+              #ifndef MAGNUM_TARGET_GLES2
+              &TextureGLTest::subImages2DStaging,
+              #endif
+              });
+
     addInstancedTests({
         &TextureGLTest::compressedImage2D,
         #ifndef MAGNUM_TARGET_GLES2
@@ -998,6 +1024,93 @@ void TextureGLTest::bindImage3D() {
 }
 #endif
 
+#ifndef MAGNUM_TARGET_GLES
+void TextureGLTest::bindlessHandle2D() {
+    if(!Context::current().isExtensionSupported<Extensions::ARB::bindless_texture>())
+        CORRADE_SKIP(Extensions::ARB::bindless_texture::string() << "is not supported.");
+
+    Texture2D texture;
+    texture.setMinificationFilter(SamplerFilter::Linear)
+        .setMagnificationFilter(SamplerFilter::Linear)
+        .setStorage(1, TextureFormat::RGBA8, Vector2i{32});
+
+    const UnsignedLong handle = texture.handle();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(handle);
+    /* Repeated queries return the same handle */
+    CORRADE_COMPARE(texture.handle(), handle);
+    CORRADE_VERIFY(!AbstractTexture::isHandleResident(handle));
+
+    AbstractTexture::makeHandleResident(handle);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(AbstractTexture::isHandleResident(handle));
+
+    AbstractTexture::makeHandleNonResident(handle);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(!AbstractTexture::isHandleResident(handle));
+}
+
+void TextureGLTest::sparse2D() {
+    if(!Context::current().isExtensionSupported<Extensions::ARB::sparse_texture>())
+        CORRADE_SKIP(Extensions::ARB::sparse_texture::string() << "is not supported.");
+
+    const Int pageSizeCount = Texture2D::virtualPageSizeCount(TextureFormat::RGBA8);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    if(!pageSizeCount)
+        CORRADE_SKIP("Sparse RGBA8 textures are not supported.");
+
+    const Vector2i pageSize = Texture2D::virtualPageSize(TextureFormat::RGBA8);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_INFO("Page size:" << Debug::packed << pageSize);
+    CORRADE_VERIFY((pageSize > Vector2i{}).all());
+
+    Texture2D texture;
+    texture.setSparse(true)
+        .setStorage(1, TextureFormat::RGBA8, pageSize*4);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE_AS(texture.sparseLevelCount(), 1,
+        TestSuite::Compare::GreaterOrEqual);
+
+    /* Commit a page, upload data to it and uncommit it again */
+    texture.commitPages(0, {pageSize, pageSize*2});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Containers::Array<Color4ub> data{ValueInit, std::size_t(pageSize.product())};
+    texture.setSubImage(0, pageSize, ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, pageSize, data});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    texture.uncommitPages(0, {pageSize, pageSize*2});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void TextureGLTest::sparseResidency2D() {
+    if(!Context::current().isExtensionSupported<Extensions::ARB::sparse_texture>())
+        CORRADE_SKIP(Extensions::ARB::sparse_texture::string() << "is not supported.");
+    if(!Texture2D::virtualPageSizeCount(TextureFormat::RGBA8))
+        CORRADE_SKIP("Sparse RGBA8 textures are not supported.");
+
+    const Vector2i pageSize = Texture2D::virtualPageSize(TextureFormat::RGBA8);
+
+    /* Not a multiple of the page size to verify the edge pages are clamped
+       correctly */
+    Texture2D texture;
+    texture.setSparse(true)
+        .setStorage(1, TextureFormat::RGBA8, pageSize*2 + Vector2i{3});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    SparseTextureResidency residency{pageSize*2 + Vector2i{3}, pageSize, 1};
+    residency.request(0, {2, 2});
+    residency.request(0, {0, 1});
+    CORRADE_COMPARE(residency.update(texture), 2);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(residency.residentPageCount(), 2);
+
+    CORRADE_COMPARE(residency.update(texture), 2);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(residency.residentPageCount(), 0);
+}
+#endif
+
 #ifndef MAGNUM_TARGET_GLES
 template<class T> void TextureGLTest::sampling1D() {
     setTestCaseTemplateName(std::is_same<T, GenericSampler>::value ?
@@ -1827,6 +1940,113 @@ void TextureGLTest::subImage2DBuffer() {
 }
 #endif
 
+constexpr UnsignedByte SubImagesData2DLevel0[4*4*4]{
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f,
+    0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f,
+    0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0x3e, 0x3f
+};
+
+/* With three extra bytes at the end, so the staging buffer has to realign
+   the offset of the image that follows */
+constexpr UnsignedByte SubImagesData2DLevel1[]{
+    0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47,
+    0x48, 0x49, 0x4a, 0x4b, 0x4c, 0x4d, 0x4e, 0x4f, 0, 0, 0
+};
+
+#ifndef MAGNUM_TARGET_GLES
+constexpr UnsignedByte SubImagesData2DLevel1Complete[]{
+    0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47,
+    0x48, 0x49, 0x4a, 0x4b, 0x4c, 0x4d, 0x4e, 0x4f
+};
+#endif
+
+void TextureGLTest::subImages2D() {
+    Texture2D texture;
+    texture.setImage(0,
+        #if !(defined(MAGNUM_TARGET_GLES2) && defined(MAGNUM_TARGET_WEBGL))
+        TextureFormat::RGBA8,
+        #else
+        TextureFormat::RGBA,
+        #endif
+        ImageView2D(PixelFormat::RGBA, PixelType::UnsignedByte, Vector2i(4), Zero2D));
+    texture.setImage(1,
+        #if !(defined(MAGNUM_TARGET_GLES2) && defined(MAGNUM_TARGET_WEBGL))
+        TextureFormat::RGBA8,
+        #else
+        TextureFormat::RGBA,
+        #endif
+        ImageView2D(PixelFormat::RGBA, PixelType::UnsignedByte, Vector2i(2), Zero2D));
+    texture.setSubImages(0, {
+        ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, Vector2i(4), SubImagesData2DLevel0},
+        ImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::RGBA, PixelType::UnsignedByte, Vector2i(2), SubImagesData2DLevel1}
+    });
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /** @todo How to test this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    Image2D image0 = texture.image(0, {PixelFormat::RGBA, PixelType::UnsignedByte});
+    Image2D image1 = texture.image(1, {PixelFormat::RGBA, PixelType::UnsignedByte});
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_COMPARE(image0.size(), Vector2i(4));
+    CORRADE_COMPARE_AS(Containers::arrayCast<UnsignedByte>(image0.data()),
+        Containers::arrayView(SubImagesData2DLevel0),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(image1.size(), Vector2i(2));
+    CORRADE_COMPARE_AS(Containers::arrayCast<UnsignedByte>(image1.data()),
+        Containers::arrayView(SubImagesData2DLevel1Complete),
+        TestSuite::Compare::Container);
+    #endif
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+void TextureGLTest::subImages2DStaging() {
+    Texture2D texture;
+    texture.setStorage(3, TextureFormat::RGBA8, Vector2i(4));
+
+    /* Upload the first and second level through the staging buffer. Level 1
+       goes first in the buffer, with the following level at an offset that
+       needs to be realigned, and a different pixel storage for each. */
+    Buffer stagingBuffer;
+    texture.setSubImages(1, {
+        ImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::RGBA, PixelType::UnsignedByte, Vector2i(2), SubImagesData2DLevel1},
+        ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, Vector2i(1), SubImagesData2DLevel0}
+    }, stagingBuffer);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Upload level 0 through the same buffer again, which should orphan the
+       previous contents */
+    texture.setSubImages(0, {
+        ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, Vector2i(4), SubImagesData2DLevel0}
+    }, stagingBuffer);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /** @todo How to test this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    Image2D image0 = texture.image(0, {PixelFormat::RGBA, PixelType::UnsignedByte});
+    Image2D image1 = texture.image(1, {PixelFormat::RGBA, PixelType::UnsignedByte});
+    Image2D image2 = texture.image(2, {PixelFormat::RGBA, PixelType::UnsignedByte});
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_COMPARE_AS(Containers::arrayCast<UnsignedByte>(image0.data()),
+        Containers::arrayView(SubImagesData2DLevel0),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayCast<UnsignedByte>(image1.data()),
+        Containers::arrayView(SubImagesData2DLevel1Complete),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayCast<UnsignedByte>(image2.data()),
+        Containers::arrayView(SubImagesData2DLevel0).prefix(4),
+        TestSuite::Compare::Container);
+    #endif
+}
+#endif
+
 #ifndef MAGNUM_TARGET_GLES
 void TextureGLTest::subImage2DQuery() {
     setTestCaseDescription(PixelStorage2DData[testCaseInstanceId()].name);
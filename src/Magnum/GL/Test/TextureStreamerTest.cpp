@@ -0,0 +1,432 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/GL/TextureStreamer.h"
+
+namespace Magnum { namespace GL { namespace Test { namespace {
+
+struct TextureStreamerTest: TestSuite::Tester {
+    explicit TextureStreamerTest();
+
+    void levelForScreenSize();
+
+    void construct();
+    void constructCopy();
+    void constructMove();
+
+    void add();
+    void addInvalid();
+    void remove();
+    void invalidId();
+
+    void request();
+    void requestScreenSize();
+    void requestInvalid();
+
+    void update();
+    void updatePriority();
+    void updateUploadLimit();
+    void updateBudget();
+    void updateBudgetLowered();
+    void updateEvictionDelay();
+};
+
+TextureStreamerTest::TextureStreamerTest() {
+    addTests({&TextureStreamerTest::levelForScreenSize,
+
+              &TextureStreamerTest::construct,
+              &TextureStreamerTest::constructCopy,
+              &TextureStreamerTest::constructMove,
+
+              &TextureStreamerTest::add,
+              &TextureStreamerTest::addInvalid,
+              &TextureStreamerTest::remove,
+              &TextureStreamerTest::invalidId,
+
+              &TextureStreamerTest::request,
+              &TextureStreamerTest::requestScreenSize,
+              &TextureStreamerTest::requestInvalid,
+
+              &TextureStreamerTest::update,
+              &TextureStreamerTest::updatePriority,
+              &TextureStreamerTest::updateUploadLimit,
+              &TextureStreamerTest::updateBudget,
+              &TextureStreamerTest::updateBudgetLowered,
+              &TextureStreamerTest::updateEvictionDelay});
+}
+
+struct Upload {
+    UnsignedInt id;
+    Int level;
+};
+
+void recordUpload(UnsignedInt id, Int level, void* userData) {
+    arrayAppend(*static_cast<Containers::Array<Upload>*>(userData), Upload{id, level});
+}
+
+/* Size of the three coarsest levels of a 256x256 RGBA8 texture, 4x4 + 2x2 +
+   1x1 pixels, four bytes each */
+constexpr std::size_t ResidentSize = 84;
+/* Size of level 5 and 4 of a 256x256 RGBA8 texture */
+constexpr std::size_t Level5Size = 8*8*4;
+constexpr std::size_t Level4Size = 16*16*4;
+
+void TextureStreamerTest::levelForScreenSize() {
+    /* 128x128 is the coarsest level still larger than 100x100 */
+    CORRADE_COMPARE(TextureStreamer::levelForScreenSize({1024, 1024}, {100.0f, 100.0f}), 3);
+    /* The smaller ratio is used so both dimensions are large enough */
+    CORRADE_COMPARE(TextureStreamer::levelForScreenSize({1024, 512}, {100.0f, 100.0f}), 2);
+    /* Exact size */
+    CORRADE_COMPARE(TextureStreamer::levelForScreenSize({1024, 1024}, {256.0f, 256.0f}), 2);
+    /* Magnified */
+    CORRADE_COMPARE(TextureStreamer::levelForScreenSize({256, 256}, {1000.0f, 1000.0f}), 0);
+    /* Not visible at all */
+    CORRADE_COMPARE(TextureStreamer::levelForScreenSize({256, 256}, {0.0f, 0.0f}), 30);
+}
+
+void TextureStreamerTest::construct() {
+    TextureStreamer streamer{1024*1024, 3};
+    CORRADE_COMPARE(streamer.memoryBudget(), 1024*1024);
+    CORRADE_COMPARE(streamer.evictionDelay(), 3);
+    CORRADE_COMPARE(streamer.uploadLimit(), ~UnsignedInt{});
+    CORRADE_COMPARE(streamer.residentMemory(), 0);
+    CORRADE_COMPARE(streamer.textureCount(), 0);
+
+    streamer.setMemoryBudget(4096)
+        .setUploadLimit(2);
+    CORRADE_COMPARE(streamer.memoryBudget(), 4096);
+    CORRADE_COMPARE(streamer.uploadLimit(), 2);
+}
+
+void TextureStreamerTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<TextureStreamer>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<TextureStreamer>{});
+}
+
+void TextureStreamerTest::constructMove() {
+    TextureStreamer a{4096};
+    UnsignedInt id = a.add({256, 256}, 9, 32, 3);
+
+    TextureStreamer b = std::move(a);
+    CORRADE_COMPARE(b.textureCount(), 1);
+    CORRADE_COMPARE(b.baseLevel(id), 6);
+
+    TextureStreamer c{1024};
+    c = std::move(b);
+    CORRADE_COMPARE(c.memoryBudget(), 4096);
+    CORRADE_COMPARE(c.baseLevel(id), 6);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<TextureStreamer>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<TextureStreamer>::value);
+}
+
+void TextureStreamerTest::add() {
+    TextureStreamer streamer{1024*1024};
+    CORRADE_COMPARE(streamer.add({256, 256}, 9, 32, 3), 0);
+    CORRADE_COMPARE(streamer.textureCount(), 1);
+    CORRADE_COMPARE(streamer.levelCount(0), 9);
+    CORRADE_COMPARE(streamer.baseLevel(0), 6);
+    CORRADE_COMPARE(streamer.requestedLevel(0), 9);
+    CORRADE_COMPARE(streamer.residentMemory(), ResidentSize);
+
+    /* Block-compressed, non-square. The 1x1 level is rounded up to a whole
+       byte. */
+    CORRADE_COMPARE(streamer.add({4, 2}, 3, 4, 3), 1);
+    CORRADE_COMPARE(streamer.textureCount(), 2);
+    CORRADE_COMPARE(streamer.baseLevel(1), 0);
+    CORRADE_COMPARE(streamer.residentMemory(), ResidentSize + 4 + 1 + 1);
+}
+
+void TextureStreamerTest::addInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    TextureStreamer streamer{1024};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    streamer.add({0, 256}, 9, 32, 3);
+    streamer.add({256, 256}, 0, 32, 1);
+    streamer.add({256, 256}, 9, 0, 3);
+    streamer.add({256, 256}, 9, 32, 0);
+    streamer.add({256, 256}, 9, 32, 10);
+    CORRADE_COMPARE(out.str(),
+        "GL::TextureStreamer::add(): expected non-zero size but got {0, 256}\n"
+        "GL::TextureStreamer::add(): expected non-zero level count\n"
+        "GL::TextureStreamer::add(): expected non-zero pixel size\n"
+        "GL::TextureStreamer::add(): expected resident level count to be non-zero and not larger than 9 but got 0\n"
+        "GL::TextureStreamer::add(): expected resident level count to be non-zero and not larger than 9 but got 10\n");
+}
+
+void TextureStreamerTest::remove() {
+    TextureStreamer streamer{1024*1024};
+    CORRADE_COMPARE(streamer.add({256, 256}, 9, 32, 3), 0);
+    CORRADE_COMPARE(streamer.add({256, 256}, 9, 32, 4), 1);
+    CORRADE_COMPARE(streamer.residentMemory(), 2*ResidentSize + Level5Size);
+
+    streamer.remove(0);
+    CORRADE_COMPARE(streamer.textureCount(), 1);
+    CORRADE_COMPARE(streamer.residentMemory(), ResidentSize + Level5Size);
+
+    /* The ID gets reused */
+    CORRADE_COMPARE(streamer.add({256, 256}, 9, 32, 3), 0);
+    CORRADE_COMPARE(streamer.textureCount(), 2);
+    CORRADE_COMPARE(streamer.residentMemory(), 2*ResidentSize + Level5Size);
+}
+
+void TextureStreamerTest::invalidId() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    TextureStreamer streamer{1024};
+    streamer.add({256, 256}, 9, 32, 3);
+    streamer.add({256, 256}, 9, 32, 3);
+    streamer.remove(1);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    streamer.remove(1);
+    streamer.levelCount(2);
+    streamer.baseLevel(2);
+    streamer.requestedLevel(1);
+    CORRADE_COMPARE(out.str(),
+        "GL::TextureStreamer::remove(): invalid ID 1\n"
+        "GL::TextureStreamer::levelCount(): invalid ID 2\n"
+        "GL::TextureStreamer::baseLevel(): invalid ID 2\n"
+        "GL::TextureStreamer::requestedLevel(): invalid ID 1\n");
+}
+
+void TextureStreamerTest::request() {
+    TextureStreamer streamer{1024*1024};
+    UnsignedInt id = streamer.add({256, 256}, 9, 32, 3);
+
+    /* The finest request wins */
+    streamer.request(id, 4);
+    streamer.request(id, 2);
+    streamer.request(id, 5);
+    CORRADE_COMPARE(streamer.requestedLevel(id), 2);
+
+    /* Levels past the end are clamped */
+    UnsignedInt another = streamer.add({256, 256}, 9, 32, 3);
+    streamer.request(another, 15);
+    CORRADE_COMPARE(streamer.requestedLevel(another), 8);
+}
+
+void TextureStreamerTest::requestScreenSize() {
+    TextureStreamer streamer{1024*1024};
+    UnsignedInt id = streamer.add({256, 256}, 9, 32, 3);
+
+    /* 64x64 is the coarsest level larger than 30x40 */
+    streamer.request(id, Vector2{30.0f, 40.0f});
+    CORRADE_COMPARE(streamer.requestedLevel(id), 2);
+}
+
+void TextureStreamerTest::requestInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    TextureStreamer streamer{1024};
+    streamer.add({256, 256}, 9, 32, 3);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    streamer.request(1, 3);
+    streamer.request(1, Vector2{30.0f, 40.0f});
+    streamer.request(0, -1);
+    CORRADE_COMPARE(out.str(),
+        "GL::TextureStreamer::request(): invalid ID 1\n"
+        "GL::TextureStreamer::request(): invalid ID 1\n"
+        "GL::TextureStreamer::request(): expected a non-negative level but got -1\n");
+}
+
+void TextureStreamerTest::update() {
+    TextureStreamer streamer{1024*1024};
+    UnsignedInt id = streamer.add({256, 256}, 9, 32, 3);
+
+    /* Levels are uploaded from the coarsest */
+    streamer.request(id, 4);
+    {
+        Containers::Array<Upload> uploads;
+        CORRADE_COMPARE(streamer.update(recordUpload, &uploads), 2);
+        CORRADE_COMPARE(uploads.size(), 2);
+        CORRADE_COMPARE(uploads[0].id, id);
+        CORRADE_COMPARE(uploads[0].level, 5);
+        CORRADE_COMPARE(uploads[1].id, id);
+        CORRADE_COMPARE(uploads[1].level, 4);
+    }
+    CORRADE_COMPARE(streamer.baseLevel(id), 4);
+    CORRADE_COMPARE(streamer.requestedLevel(id), 9);
+    CORRADE_COMPARE(streamer.residentMemory(), ResidentSize + Level5Size + Level4Size);
+
+    /* Requesting a coarser level than what's resident does nothing */
+    streamer.request(id, 5);
+    {
+        Containers::Array<Upload> uploads;
+        CORRADE_COMPARE(streamer.update(recordUpload, &uploads), 0);
+        CORRADE_COMPARE(uploads.size(), 0);
+    }
+    CORRADE_COMPARE(streamer.baseLevel(id), 4);
+}
+
+void TextureStreamerTest::updatePriority() {
+    TextureStreamer streamer{1024*1024};
+    UnsignedInt a = streamer.add({256, 256}, 9, 32, 3);
+    UnsignedInt b = streamer.add({256, 256}, 9, 32, 3);
+
+    /* The texture with the larger difference goes first, one level at a
+       time */
+    streamer.request(b, 5);
+    streamer.request(a, 3);
+    Containers::Array<Upload> uploads;
+    CORRADE_COMPARE(streamer.update(recordUpload, &uploads), 4);
+    CORRADE_COMPARE(uploads.size(), 4);
+    CORRADE_COMPARE(uploads[0].id, a);
+    CORRADE_COMPARE(uploads[0].level, 5);
+    CORRADE_COMPARE(uploads[1].id, b);
+    CORRADE_COMPARE(uploads[1].level, 5);
+    CORRADE_COMPARE(uploads[2].id, a);
+    CORRADE_COMPARE(uploads[2].level, 4);
+    CORRADE_COMPARE(uploads[3].id, a);
+    CORRADE_COMPARE(uploads[3].level, 3);
+}
+
+void TextureStreamerTest::updateUploadLimit() {
+    TextureStreamer streamer{1024*1024};
+    streamer.setUploadLimit(2);
+    UnsignedInt a = streamer.add({256, 256}, 9, 32, 3);
+    UnsignedInt b = streamer.add({256, 256}, 9, 32, 3);
+
+    streamer.request(a, 3);
+    streamer.request(b, 5);
+    {
+        Containers::Array<Upload> uploads;
+        CORRADE_COMPARE(streamer.update(recordUpload, &uploads), 2);
+        CORRADE_COMPARE(uploads.size(), 2);
+        CORRADE_COMPARE(uploads[0].id, a);
+        CORRADE_COMPARE(uploads[0].level, 5);
+        CORRADE_COMPARE(uploads[1].id, b);
+        CORRADE_COMPARE(uploads[1].level, 5);
+    }
+
+    /* The rest continues in the next update */
+    streamer.request(a, 3);
+    streamer.request(b, 5);
+    {
+        Containers::Array<Upload> uploads;
+        CORRADE_COMPARE(streamer.update(recordUpload, &uploads), 2);
+        CORRADE_COMPARE(uploads.size(), 2);
+        CORRADE_COMPARE(uploads[0].id, a);
+        CORRADE_COMPARE(uploads[0].level, 4);
+        CORRADE_COMPARE(uploads[1].id, a);
+        CORRADE_COMPARE(uploads[1].level, 3);
+    }
+}
+
+void TextureStreamerTest::updateBudget() {
+    /* Enough for the resident levels of both and level 5 of one */
+    TextureStreamer streamer{2*ResidentSize + Level5Size, 10};
+    UnsignedInt a = streamer.add({256, 256}, 9, 32, 3);
+    UnsignedInt b = streamer.add({256, 256}, 9, 32, 3);
+
+    /* Uploading level 4 doesn't fit */
+    streamer.request(a, 4);
+    {
+        Containers::Array<Upload> uploads;
+        CORRADE_COMPARE(streamer.update(recordUpload, &uploads), 1);
+        CORRADE_COMPARE(uploads.size(), 1);
+        CORRADE_COMPARE(uploads[0].id, a);
+        CORRADE_COMPARE(uploads[0].level, 5);
+    }
+    CORRADE_COMPARE(streamer.baseLevel(a), 5);
+    CORRADE_COMPARE(streamer.residentMemory(), 2*ResidentSize + Level5Size);
+
+    /* Level 5 of the texture that's not requested anymore is evicted to make
+       room, even though the eviction delay isn't over yet */
+    streamer.request(b, 5);
+    {
+        Containers::Array<Upload> uploads;
+        CORRADE_COMPARE(streamer.update(recordUpload, &uploads), 1);
+        CORRADE_COMPARE(uploads.size(), 1);
+        CORRADE_COMPARE(uploads[0].id, b);
+        CORRADE_COMPARE(uploads[0].level, 5);
+    }
+    CORRADE_COMPARE(streamer.baseLevel(a), 6);
+    CORRADE_COMPARE(streamer.baseLevel(b), 5);
+    CORRADE_COMPARE(streamer.residentMemory(), 2*ResidentSize + Level5Size);
+
+    /* If both are needed, the level that's already uploaded stays and the
+       other upload is postponed */
+    streamer.request(a, 5);
+    streamer.request(b, 5);
+    {
+        Containers::Array<Upload> uploads;
+        CORRADE_COMPARE(streamer.update(recordUpload, &uploads), 0);
+        CORRADE_COMPARE(uploads.size(), 0);
+    }
+    CORRADE_COMPARE(streamer.baseLevel(a), 6);
+    CORRADE_COMPARE(streamer.baseLevel(b), 5);
+}
+
+void TextureStreamerTest::updateBudgetLowered() {
+    TextureStreamer streamer{1024*1024, 10};
+    UnsignedInt id = streamer.add({256, 256}, 9, 32, 3);
+    Containers::Array<Upload> uploads;
+
+    streamer.request(id, 4);
+    CORRADE_COMPARE(streamer.update(recordUpload, &uploads), 2);
+    CORRADE_COMPARE(streamer.baseLevel(id), 4);
+
+    /* Streamed levels that aren't needed are evicted, the always resident
+       levels stay even if they don't fit */
+    streamer.setMemoryBudget(0);
+    CORRADE_COMPARE(streamer.update(recordUpload, &uploads), 0);
+    CORRADE_COMPARE(streamer.baseLevel(id), 6);
+    CORRADE_COMPARE(streamer.residentMemory(), ResidentSize);
+}
+
+void TextureStreamerTest::updateEvictionDelay() {
+    TextureStreamer streamer{1024*1024, 1};
+    UnsignedInt id = streamer.add({256, 256}, 9, 32, 3);
+    Containers::Array<Upload> uploads;
+
+    streamer.request(id, 5);
+    CORRADE_COMPARE(streamer.update(recordUpload, &uploads), 1);
+    CORRADE_COMPARE(streamer.baseLevel(id), 5);
+
+    /* Not requested in one update, stays */
+    CORRADE_COMPARE(streamer.update(recordUpload, &uploads), 0);
+    CORRADE_COMPARE(streamer.baseLevel(id), 5);
+
+    /* Not requested in two updates, evicted */
+    CORRADE_COMPARE(streamer.update(recordUpload, &uploads), 0);
+    CORRADE_COMPARE(streamer.baseLevel(id), 6);
+    CORRADE_COMPARE(streamer.residentMemory(), ResidentSize);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::GL::Test::TextureStreamerTest)
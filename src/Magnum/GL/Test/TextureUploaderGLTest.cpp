@@ -0,0 +1,291 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <thread>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/GL/Buffer.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/GL/PixelFormat.h"
+#include "Magnum/GL/Texture.h"
+#include "Magnum/GL/TextureFormat.h"
+#include "Magnum/GL/TextureUploader.h"
+#include "Magnum/Math/Color.h"
+
+namespace Magnum { namespace GL { namespace Test { namespace {
+
+struct TextureUploaderGLTest: OpenGLTester {
+    explicit TextureUploaderGLTest();
+
+    void construct();
+    void constructInvalid();
+    void constructMove();
+
+    void upload();
+    void uploadPixelStorage();
+    void uploadFromThread();
+    void stageNoFreeSlot();
+    void stageTooLarge();
+    void slotReuse();
+};
+
+TextureUploaderGLTest::TextureUploaderGLTest() {
+    addTests({&TextureUploaderGLTest::construct,
+              &TextureUploaderGLTest::constructInvalid,
+              &TextureUploaderGLTest::constructMove,
+
+              &TextureUploaderGLTest::upload,
+              &TextureUploaderGLTest::uploadPixelStorage,
+              &TextureUploaderGLTest::uploadFromThread,
+              &TextureUploaderGLTest::stageNoFreeSlot,
+              &TextureUploaderGLTest::stageTooLarge,
+              &TextureUploaderGLTest::slotReuse});
+}
+
+#define SKIP_IF_NO_BUFFER_STORAGE()                                         \
+    if(!Context::current().isExtensionSupported<Extensions::ARB::buffer_storage>()) \
+        CORRADE_SKIP(Extensions::ARB::buffer_storage::string() << "is not supported.")
+
+constexpr UnsignedByte Data[]{
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f
+};
+
+void TextureUploaderGLTest::construct() {
+    SKIP_IF_NO_BUFFER_STORAGE();
+
+    {
+        /* The slot size gets rounded up to a multiple of four */
+        TextureUploader uploader{1022, 3};
+
+        MAGNUM_VERIFY_NO_GL_ERROR();
+        CORRADE_VERIFY(uploader.buffer().id() > 0);
+        CORRADE_COMPARE(uploader.buffer().size(), 3*1024);
+        CORRADE_COMPARE(uploader.slotSize(), 1024);
+        CORRADE_COMPARE(uploader.slotCount(), 3);
+        CORRADE_COMPARE(uploader.pendingCount(), 0);
+        CORRADE_COMPARE(uploader.completedCount(), 0);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void TextureUploaderGLTest::constructInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    TextureUploader{0, 3};
+    TextureUploader{1024, 0};
+    CORRADE_COMPARE(out.str(),
+        "GL::TextureUploader: expected non-zero slot size and count but got 0 and 3\n"
+        "GL::TextureUploader: expected non-zero slot size and count but got 1024 and 0\n");
+}
+
+void TextureUploaderGLTest::constructMove() {
+    SKIP_IF_NO_BUFFER_STORAGE();
+
+    TextureUploader a{1024, 4};
+    const UnsignedInt id = a.buffer().id();
+
+    TextureUploader b{std::move(a)};
+    CORRADE_COMPARE(a.slotCount(), 0);
+    CORRADE_COMPARE(b.buffer().id(), id);
+    CORRADE_COMPARE(b.slotCount(), 4);
+
+    TextureUploader c{256, 2};
+    const UnsignedInt cId = c.buffer().id();
+    c = std::move(b);
+    CORRADE_COMPARE(b.buffer().id(), cId);
+    CORRADE_COMPARE(b.slotCount(), 2);
+    CORRADE_COMPARE(c.buffer().id(), id);
+    CORRADE_COMPARE(c.slotCount(), 4);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<TextureUploader>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<TextureUploader>::value);
+}
+
+void TextureUploaderGLTest::upload() {
+    SKIP_IF_NO_BUFFER_STORAGE();
+
+    Texture2D texture;
+    texture.setStorage(1, TextureFormat::RGBA8, {4, 4});
+
+    TextureUploader uploader{64, 4};
+    Containers::Optional<UnsignedLong> a = uploader.stage(texture, 0, {0, 0}, ImageView2D{Magnum::PixelFormat::RGBA8Unorm, {2, 2}, Data});
+    Containers::Optional<UnsignedLong> b = uploader.stage(texture, 0, {2, 2}, ImageView2D{Magnum::PixelFormat::RGBA8Unorm, {2, 2}, Data});
+    CORRADE_VERIFY(a);
+    CORRADE_VERIFY(b);
+    CORRADE_COMPARE(*a, 0);
+    CORRADE_COMPARE(*b, 1);
+    CORRADE_COMPARE(uploader.pendingCount(), 2);
+    CORRADE_VERIFY(!uploader.isComplete(*a));
+
+    uploader.finish();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(uploader.pendingCount(), 0);
+    CORRADE_COMPARE(uploader.completedCount(), 2);
+    CORRADE_VERIFY(uploader.isComplete(*a));
+    CORRADE_VERIFY(uploader.isComplete(*b));
+
+    Image2D image = texture.image(0, {Magnum::PixelFormat::RGBA8Unorm});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    const Containers::StridedArrayView2D<const Color4ub> pixels = image.pixels<Color4ub>();
+    CORRADE_COMPARE(pixels[0][0], (Color4ub{0x00, 0x01, 0x02, 0x03}));
+    CORRADE_COMPARE(pixels[0][1], (Color4ub{0x04, 0x05, 0x06, 0x07}));
+    CORRADE_COMPARE(pixels[1][0], (Color4ub{0x08, 0x09, 0x0a, 0x0b}));
+    CORRADE_COMPARE(pixels[1][1], (Color4ub{0x0c, 0x0d, 0x0e, 0x0f}));
+    CORRADE_COMPARE(pixels[2][2], (Color4ub{0x00, 0x01, 0x02, 0x03}));
+    CORRADE_COMPARE(pixels[3][3], (Color4ub{0x0c, 0x0d, 0x0e, 0x0f}));
+}
+
+void TextureUploaderGLTest::uploadPixelStorage() {
+    SKIP_IF_NO_BUFFER_STORAGE();
+
+    Texture2D texture;
+    texture.setStorage(1, TextureFormat::R8, {2, 2});
+
+    /* Two rows of two bytes, each row padded to four bytes and the first
+       row skipped */
+    const UnsignedByte data[]{
+        0xff, 0xff, 0xff, 0xff,
+        0x10, 0x20, 0xff, 0xff,
+        0x30, 0x40, 0xff, 0xff
+    };
+
+    TextureUploader uploader{16, 1};
+    CORRADE_VERIFY(uploader.stage(texture, 0, {}, ImageView2D{
+        PixelStorage{}.setAlignment(4).setSkip({0, 1, 0}),
+        Magnum::PixelFormat::R8Unorm, {2, 2}, data}));
+    uploader.finish();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Image2D image = texture.image(0, {PixelStorage{}.setAlignment(1), Magnum::PixelFormat::R8Unorm});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE_AS(Containers::arrayCast<const UnsignedByte>(image.data()),
+        Containers::arrayView<UnsignedByte>({0x10, 0x20, 0x30, 0x40}),
+        TestSuite::Compare::Container);
+}
+
+void TextureUploaderGLTest::uploadFromThread() {
+    SKIP_IF_NO_BUFFER_STORAGE();
+
+    Texture2D texture;
+    texture.setStorage(1, TextureFormat::RGBA8, {8, 8});
+
+    TextureUploader uploader{16, 16};
+
+    /* Stage sixteen 2x2 tiles from a worker thread, retrying if no slot is
+       free */
+    std::thread worker{[&uploader, &texture] {
+        for(Int i = 0; i != 16; ++i)
+            while(!uploader.stage(texture, 0, {i%4*2, i/4*2}, ImageView2D{Magnum::PixelFormat::RGBA8Unorm, {2, 2}, Data}))
+                std::this_thread::yield();
+    }};
+    worker.join();
+
+    CORRADE_COMPARE(uploader.pendingCount(), 16);
+    uploader.finish();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(uploader.completedCount(), 16);
+
+    Image2D image = texture.image(0, {Magnum::PixelFormat::RGBA8Unorm});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    const Containers::StridedArrayView2D<const Color4ub> pixels = image.pixels<Color4ub>();
+    for(std::size_t i = 0; i != 64; ++i) {
+        CORRADE_ITERATION(i);
+        const std::size_t x = i%8, y = i/8;
+        const std::size_t data = (y%2*2 + x%2)*4;
+        CORRADE_COMPARE(pixels[y][x], (Color4ub{Data[data], Data[data + 1], Data[data + 2], Data[data + 3]}));
+    }
+}
+
+void TextureUploaderGLTest::stageNoFreeSlot() {
+    SKIP_IF_NO_BUFFER_STORAGE();
+
+    Texture2D texture;
+    texture.setStorage(1, TextureFormat::RGBA8, {4, 4});
+
+    TextureUploader uploader{16, 2};
+    CORRADE_VERIFY(uploader.stage(texture, 0, {}, ImageView2D{Magnum::PixelFormat::RGBA8Unorm, {2, 2}, Data}));
+    CORRADE_VERIFY(uploader.stage(texture, 0, {}, ImageView2D{Magnum::PixelFormat::RGBA8Unorm, {2, 2}, Data}));
+    CORRADE_VERIFY(!uploader.stage(texture, 0, {}, ImageView2D{Magnum::PixelFormat::RGBA8Unorm, {2, 2}, Data}));
+    CORRADE_COMPARE(uploader.pendingCount(), 2);
+
+    /* After the uploads are done, slots are free again */
+    uploader.finish();
+    CORRADE_VERIFY(uploader.stage(texture, 0, {}, ImageView2D{Magnum::PixelFormat::RGBA8Unorm, {2, 2}, Data}));
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void TextureUploaderGLTest::stageTooLarge() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+    SKIP_IF_NO_BUFFER_STORAGE();
+
+    Texture2D texture;
+    TextureUploader uploader{12, 2};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    uploader.stage(texture, 0, {}, ImageView2D{Magnum::PixelFormat::RGBA8Unorm, {2, 2}, Data});
+    CORRADE_COMPARE(out.str(),
+        "GL::TextureUploader::stage(): image of 16 bytes doesn't fit into a slot of 12 bytes\n");
+}
+
+void TextureUploaderGLTest::slotReuse() {
+    SKIP_IF_NO_BUFFER_STORAGE();
+
+    Texture2D texture;
+    texture.setStorage(1, TextureFormat::RGBA8, {4, 4});
+
+    /* Cycle through a single slot several times, each time with an update()
+       in between, IDs continue to increase */
+    TextureUploader uploader{16, 1};
+    for(UnsignedLong i = 0; i != 5; ++i) {
+        CORRADE_ITERATION(i);
+        Containers::Optional<UnsignedLong> id = uploader.stage(texture, 0, {}, ImageView2D{Magnum::PixelFormat::RGBA8Unorm, {2, 2}, Data});
+        CORRADE_VERIFY(id);
+        CORRADE_COMPARE(*id, i);
+        uploader.finish();
+        CORRADE_VERIFY(uploader.isComplete(*id));
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::GL::Test::TextureUploaderGLTest)
@@ -0,0 +1,376 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/System.h>
+
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/Framebuffer.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/GL/Renderbuffer.h"
+#include "Magnum/GL/RenderbufferFormat.h"
+#include "Magnum/GL/TimerQueryPool.h"
+
+namespace Magnum { namespace GL { namespace Test { namespace {
+
+struct TimerQueryPoolGLTest: OpenGLTester {
+    explicit TimerQueryPoolGLTest();
+
+    void construct();
+    void constructMove();
+
+    void addScope();
+    void addScopeTooMany();
+
+    void query();
+    void queryScopeNested();
+    void queryScopeTooMany();
+    void queryFrameAlreadyBegun();
+    void queryScopeNotEnded();
+};
+
+TimerQueryPoolGLTest::TimerQueryPoolGLTest() {
+    addTests({&TimerQueryPoolGLTest::construct,
+              &TimerQueryPoolGLTest::constructMove,
+
+              &TimerQueryPoolGLTest::addScope,
+              &TimerQueryPoolGLTest::addScopeTooMany,
+
+              &TimerQueryPoolGLTest::query,
+              &TimerQueryPoolGLTest::queryScopeNested,
+              &TimerQueryPoolGLTest::queryScopeTooMany,
+              &TimerQueryPoolGLTest::queryFrameAlreadyBegun,
+              &TimerQueryPoolGLTest::queryScopeNotEnded});
+}
+
+void TimerQueryPoolGLTest::construct() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::ARB::timer_query>())
+        CORRADE_SKIP(Extensions::ARB::timer_query::string() << "is not supported.");
+    #elif defined(MAGNUM_TARGET_WEBGL) && !defined(MAGNUM_TARGET_GLES2)
+    if(!Context::current().isExtensionSupported<Extensions::EXT::disjoint_timer_query_webgl2>())
+        CORRADE_SKIP(Extensions::EXT::disjoint_timer_query_webgl2::string() << "is not supported.");
+    #else
+    if(!Context::current().isExtensionSupported<Extensions::EXT::disjoint_timer_query>())
+        CORRADE_SKIP(Extensions::EXT::disjoint_timer_query::string() << "is not supported.");
+    #endif
+
+    {
+        TimerQueryPool pool{2, 5};
+        MAGNUM_VERIFY_NO_GL_ERROR();
+
+        CORRADE_COMPARE(pool.frameCount(), 2);
+        CORRADE_COMPARE(pool.maxScopeCount(), 5);
+        CORRADE_COMPARE(pool.scopeCount(), 0);
+        CORRADE_COMPARE(pool.measuredFrameCount(), 0);
+        CORRADE_COMPARE(pool.droppedFrameCount(), 0);
+        CORRADE_VERIFY(!pool.hasResults());
+        CORRADE_COMPARE(pool.durations().size(), 5);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void TimerQueryPoolGLTest::constructMove() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::ARB::timer_query>())
+        CORRADE_SKIP(Extensions::ARB::timer_query::string() << "is not supported.");
+    #elif defined(MAGNUM_TARGET_WEBGL) && !defined(MAGNUM_TARGET_GLES2)
+    if(!Context::current().isExtensionSupported<Extensions::EXT::disjoint_timer_query_webgl2>())
+        CORRADE_SKIP(Extensions::EXT::disjoint_timer_query_webgl2::string() << "is not supported.");
+    #else
+    if(!Context::current().isExtensionSupported<Extensions::EXT::disjoint_timer_query>())
+        CORRADE_SKIP(Extensions::EXT::disjoint_timer_query::string() << "is not supported.");
+    #endif
+
+    TimerQueryPool a{2, 5};
+    a.addScope("shadows");
+    const UnsignedLong* durations = a.durations().data();
+
+    TimerQueryPool b{std::move(a)};
+    CORRADE_COMPARE(b.frameCount(), 2);
+    CORRADE_COMPARE(b.maxScopeCount(), 5);
+    CORRADE_COMPARE(b.scopeCount(), 1);
+    CORRADE_COMPARE(b.scopeName(0), "shadows");
+    /* The durations memory doesn't move */
+    CORRADE_COMPARE(b.durations().data(), durations);
+
+    TimerQueryPool c{NoCreate};
+    c = std::move(b);
+    CORRADE_COMPARE(c.frameCount(), 2);
+    CORRADE_COMPARE(c.scopeCount(), 1);
+    CORRADE_COMPARE(c.durations().data(), durations);
+}
+
+void TimerQueryPoolGLTest::addScope() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::ARB::timer_query>())
+        CORRADE_SKIP(Extensions::ARB::timer_query::string() << "is not supported.");
+    #elif defined(MAGNUM_TARGET_WEBGL) && !defined(MAGNUM_TARGET_GLES2)
+    if(!Context::current().isExtensionSupported<Extensions::EXT::disjoint_timer_query_webgl2>())
+        CORRADE_SKIP(Extensions::EXT::disjoint_timer_query_webgl2::string() << "is not supported.");
+    #else
+    if(!Context::current().isExtensionSupported<Extensions::EXT::disjoint_timer_query>())
+        CORRADE_SKIP(Extensions::EXT::disjoint_timer_query::string() << "is not supported.");
+    #endif
+
+    TimerQueryPool pool{2, 5};
+    CORRADE_COMPARE(pool.addScope("shadows"), 0);
+    CORRADE_COMPARE(pool.addScope("lights"), 1);
+    /* Adding an existing scope returns the same ID */
+    CORRADE_COMPARE(pool.addScope("shadows"), 0);
+    CORRADE_COMPARE(pool.scopeCount(), 2);
+    CORRADE_COMPARE(pool.scopeName(0), "shadows");
+    CORRADE_COMPARE(pool.scopeName(1), "lights");
+    CORRADE_COMPARE(pool.findScope("lights"), Containers::optional(1u));
+    CORRADE_VERIFY(!pool.findScope("post"));
+
+    /* No results yet, so the durations are all zero */
+    CORRADE_COMPARE(pool.duration(1), 0);
+    CORRADE_COMPARE(pool.duration("shadows"), Containers::optional(UnsignedLong{}));
+    CORRADE_VERIFY(!pool.duration("post"));
+}
+
+void TimerQueryPoolGLTest::addScopeTooMany() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::ARB::timer_query>())
+        CORRADE_SKIP(Extensions::ARB::timer_query::string() << "is not supported.");
+    #elif defined(MAGNUM_TARGET_WEBGL) && !defined(MAGNUM_TARGET_GLES2)
+    if(!Context::current().isExtensionSupported<Extensions::EXT::disjoint_timer_query_webgl2>())
+        CORRADE_SKIP(Extensions::EXT::disjoint_timer_query_webgl2::string() << "is not supported.");
+    #else
+    if(!Context::current().isExtensionSupported<Extensions::EXT::disjoint_timer_query>())
+        CORRADE_SKIP(Extensions::EXT::disjoint_timer_query::string() << "is not supported.");
+    #endif
+
+    TimerQueryPool pool{2, 2};
+    pool.addScope("shadows");
+    pool.addScope("lights");
+    /* Existing scopes are fine */
+    pool.addScope("shadows");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    pool.addScope("post");
+    CORRADE_COMPARE(out.str(), "GL::TimerQueryPool::addScope(): can't add post, only 2 scopes allowed\n");
+}
+
+void TimerQueryPoolGLTest::query() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::ARB::timer_query>())
+        CORRADE_SKIP(Extensions::ARB::timer_query::string() << "is not supported.");
+    #elif defined(MAGNUM_TARGET_WEBGL) && !defined(MAGNUM_TARGET_GLES2)
+    if(!Context::current().isExtensionSupported<Extensions::EXT::disjoint_timer_query_webgl2>())
+        CORRADE_SKIP(Extensions::EXT::disjoint_timer_query_webgl2::string() << "is not supported.");
+    #else
+    if(!Context::current().isExtensionSupported<Extensions::EXT::disjoint_timer_query>())
+        CORRADE_SKIP(Extensions::EXT::disjoint_timer_query::string() << "is not supported.");
+    #endif
+
+    Renderbuffer renderbuffer;
+    renderbuffer.setStorage(
+        #ifndef MAGNUM_TARGET_GLES2
+        RenderbufferFormat::RGBA8,
+        #else
+        RenderbufferFormat::RGBA4,
+        #endif
+        Vector2i(32));
+
+    Framebuffer framebuffer({{}, Vector2i{32}});
+    framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment(0), renderbuffer);
+
+    TimerQueryPool pool{3, 4};
+
+    /* Render frames until results of the first one are available. The same
+       scope is entered twice a frame, "nothing" is not entered at all in
+       frames after the first. */
+    for(std::size_t i = 0; i != 100 && !pool.hasResults(); ++i) {
+        pool.beginFrame();
+
+        if(i == 0) {
+            pool.begin("nothing");
+            pool.end();
+        }
+
+        pool.begin("clear");
+        framebuffer.clear(FramebufferClear::Color);
+        pool.end();
+
+        pool.begin("clear");
+        framebuffer.clear(FramebufferClear::Color);
+        pool.end();
+
+        pool.endFrame();
+        MAGNUM_VERIFY_NO_GL_ERROR();
+
+        /* Give the GPU some time */
+        Utility::System::sleep(10);
+    }
+
+    CORRADE_VERIFY(pool.hasResults());
+    CORRADE_COMPARE(pool.scopeCount(), 2);
+    CORRADE_COMPARE_AS(pool.resultFrame(), pool.measuredFrameCount(),
+        TestSuite::Compare::Less);
+    Debug{} << "Clearing twice in frame" << pool.resultFrame() << "took" << pool.duration(1)/1.0e6f << "ms, results delayed by" << pool.measuredFrameCount() - pool.resultFrame() << "frames," << pool.droppedFrameCount() << "frames dropped";
+    CORRADE_VERIFY(pool.duration(1));
+    CORRADE_COMPARE(pool.duration(1), pool.durations()[1]);
+
+    /* Render more frames to get results without the "nothing" scope */
+    const UnsignedLong resultFrame = pool.resultFrame();
+    for(std::size_t i = 0; i != 100 && pool.resultFrame() == resultFrame; ++i) {
+        pool.beginFrame();
+        pool.begin("clear");
+        framebuffer.clear(FramebufferClear::Color);
+        pool.end();
+        pool.endFrame();
+        MAGNUM_VERIFY_NO_GL_ERROR();
+
+        Utility::System::sleep(10);
+    }
+
+    CORRADE_COMPARE_AS(pool.resultFrame(), resultFrame,
+        TestSuite::Compare::Greater);
+    CORRADE_COMPARE(pool.duration("nothing"), Containers::optional(UnsignedLong{}));
+    CORRADE_VERIFY(pool.duration(1));
+}
+
+void TimerQueryPoolGLTest::queryScopeNested() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::ARB::timer_query>())
+        CORRADE_SKIP(Extensions::ARB::timer_query::string() << "is not supported.");
+    #elif defined(MAGNUM_TARGET_WEBGL) && !defined(MAGNUM_TARGET_GLES2)
+    if(!Context::current().isExtensionSupported<Extensions::EXT::disjoint_timer_query_webgl2>())
+        CORRADE_SKIP(Extensions::EXT::disjoint_timer_query_webgl2::string() << "is not supported.");
+    #else
+    if(!Context::current().isExtensionSupported<Extensions::EXT::disjoint_timer_query>())
+        CORRADE_SKIP(Extensions::EXT::disjoint_timer_query::string() << "is not supported.");
+    #endif
+
+    TimerQueryPool pool{2, 4};
+    pool.beginFrame();
+    pool.begin("shadows");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    pool.begin("lights");
+    CORRADE_COMPARE(out.str(), "GL::TimerQueryPool::begin(): scope shadows is already active, time elapsed queries can't be nested\n");
+
+    pool.end();
+    pool.endFrame();
+}
+
+void TimerQueryPoolGLTest::queryScopeTooMany() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::ARB::timer_query>())
+        CORRADE_SKIP(Extensions::ARB::timer_query::string() << "is not supported.");
+    #elif defined(MAGNUM_TARGET_WEBGL) && !defined(MAGNUM_TARGET_GLES2)
+    if(!Context::current().isExtensionSupported<Extensions::EXT::disjoint_timer_query_webgl2>())
+        CORRADE_SKIP(Extensions::EXT::disjoint_timer_query_webgl2::string() << "is not supported.");
+    #else
+    if(!Context::current().isExtensionSupported<Extensions::EXT::disjoint_timer_query>())
+        CORRADE_SKIP(Extensions::EXT::disjoint_timer_query::string() << "is not supported.");
+    #endif
+
+    TimerQueryPool pool{2, 2};
+    pool.beginFrame();
+    pool.begin("shadows");
+    pool.end();
+    pool.begin("shadows");
+    pool.end();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    pool.begin("shadows");
+    CORRADE_COMPARE(out.str(), "GL::TimerQueryPool::begin(): only 2 scopes allowed in a frame\n");
+
+    pool.endFrame();
+}
+
+void TimerQueryPoolGLTest::queryFrameAlreadyBegun() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::ARB::timer_query>())
+        CORRADE_SKIP(Extensions::ARB::timer_query::string() << "is not supported.");
+    #elif defined(MAGNUM_TARGET_WEBGL) && !defined(MAGNUM_TARGET_GLES2)
+    if(!Context::current().isExtensionSupported<Extensions::EXT::disjoint_timer_query_webgl2>())
+        CORRADE_SKIP(Extensions::EXT::disjoint_timer_query_webgl2::string() << "is not supported.");
+    #else
+    if(!Context::current().isExtensionSupported<Extensions::EXT::disjoint_timer_query>())
+        CORRADE_SKIP(Extensions::EXT::disjoint_timer_query::string() << "is not supported.");
+    #endif
+
+    TimerQueryPool pool{2, 2};
+    pool.beginFrame();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    pool.beginFrame();
+    CORRADE_COMPARE(out.str(), "GL::TimerQueryPool::beginFrame(): frame already begun\n");
+
+    pool.endFrame();
+}
+
+void TimerQueryPoolGLTest::queryScopeNotEnded() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::ARB::timer_query>())
+        CORRADE_SKIP(Extensions::ARB::timer_query::string() << "is not supported.");
+    #elif defined(MAGNUM_TARGET_WEBGL) && !defined(MAGNUM_TARGET_GLES2)
+    if(!Context::current().isExtensionSupported<Extensions::EXT::disjoint_timer_query_webgl2>())
+        CORRADE_SKIP(Extensions::EXT::disjoint_timer_query_webgl2::string() << "is not supported.");
+    #else
+    if(!Context::current().isExtensionSupported<Extensions::EXT::disjoint_timer_query>())
+        CORRADE_SKIP(Extensions::EXT::disjoint_timer_query::string() << "is not supported.");
+    #endif
+
+    TimerQueryPool pool{2, 2};
+    pool.beginFrame();
+    pool.begin("shadows");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    pool.endFrame();
+    CORRADE_COMPARE(out.str(), "GL::TimerQueryPool::endFrame(): scope shadows not ended\n");
+
+    pool.end();
+    pool.endFrame();
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::GL::Test::TimerQueryPoolGLTest)
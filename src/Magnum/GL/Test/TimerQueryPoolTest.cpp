@@ -0,0 +1,127 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/GL/TimerQueryPool.h"
+
+namespace Magnum { namespace GL { namespace Test { namespace {
+
+struct TimerQueryPoolTest: TestSuite::Tester {
+    explicit TimerQueryPoolTest();
+
+    void constructNoCreate();
+    void constructZeroCount();
+    void constructCopy();
+
+    void frameNotBegun();
+    void resultsNotAvailable();
+};
+
+TimerQueryPoolTest::TimerQueryPoolTest() {
+    addTests({&TimerQueryPoolTest::constructNoCreate,
+              &TimerQueryPoolTest::constructZeroCount,
+              &TimerQueryPoolTest::constructCopy,
+
+              &TimerQueryPoolTest::frameNotBegun,
+              &TimerQueryPoolTest::resultsNotAvailable});
+}
+
+void TimerQueryPoolTest::constructNoCreate() {
+    {
+        TimerQueryPool pool{NoCreate};
+        CORRADE_COMPARE(pool.frameCount(), 0);
+        CORRADE_COMPARE(pool.maxScopeCount(), 0);
+        CORRADE_COMPARE(pool.scopeCount(), 0);
+        CORRADE_COMPARE(pool.measuredFrameCount(), 0);
+        CORRADE_COMPARE(pool.droppedFrameCount(), 0);
+        CORRADE_VERIFY(!pool.hasResults());
+        CORRADE_VERIFY(!pool.findScope("shadows"));
+        CORRADE_VERIFY(!pool.duration("shadows"));
+        CORRADE_VERIFY(pool.durations().isEmpty());
+    }
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoCreateT, TimerQueryPool>::value);
+}
+
+void TimerQueryPoolTest::constructZeroCount() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    TimerQueryPool{0, 16};
+    TimerQueryPool{3, 0};
+    CORRADE_COMPARE(out.str(),
+        "GL::TimerQueryPool: expected non-zero frame and scope count but got 0 and 16\n"
+        "GL::TimerQueryPool: expected non-zero frame and scope count but got 3 and 0\n");
+}
+
+void TimerQueryPoolTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<TimerQueryPool>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<TimerQueryPool>{});
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<TimerQueryPool>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<TimerQueryPool>::value);
+}
+
+void TimerQueryPoolTest::frameNotBegun() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    TimerQueryPool pool{NoCreate};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    pool.begin("shadows");
+    pool.end();
+    pool.endFrame();
+    CORRADE_COMPARE(out.str(),
+        "GL::TimerQueryPool::begin(): no frame begun\n"
+        "GL::TimerQueryPool::end(): no scope begun\n"
+        "GL::TimerQueryPool::endFrame(): no frame begun\n");
+}
+
+void TimerQueryPoolTest::resultsNotAvailable() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    TimerQueryPool pool{NoCreate};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    pool.resultFrame();
+    pool.duration(0);
+    pool.scopeName(0);
+    CORRADE_COMPARE(out.str(),
+        "GL::TimerQueryPool::resultFrame(): no results available yet\n"
+        "GL::TimerQueryPool::duration(): index 0 out of range for 0 scopes\n"
+        "GL::TimerQueryPool::scopeName(): index 0 out of range for 0 scopes\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::GL::Test::TimerQueryPoolTest)
@@ -89,6 +89,34 @@ In a shader, the texture is used via @glsl sampler1D @ce / @glsl sampler2D @ce
 @ref AbstractShaderProgram documentation for more information about usage in
 shaders.
 
+@section GL-Texture-bindless Bindless textures
+
+On desktop GL with @gl_extension{ARB,bindless_texture}, a 64-bit texture
+handle can be retrieved with @ref handle() and made resident with
+@ref makeHandleResident(). The handle can be then passed to the shader for
+example through a uniform buffer and used directly, without binding the
+texture to any texture unit:
+
+@snippet MagnumGL.cpp Texture-bindless
+
+Once a handle is retrieved, the texture state --- including its filtering and
+wrapping parameters --- is frozen and can't be modified anymore, the texture
+data can be modified only while the handle is not resident.
+
+@section GL-Texture-sparse Sparse textures
+
+On desktop GL with @gl_extension{ARB,sparse_texture}, a 2D texture can be made
+sparse with @ref setSparse() before its storage is allocated. Only the address
+space is reserved then and physical memory is allocated per-page with
+@ref commitPages() and released again with @ref uncommitPages(), allowing
+textures considerably larger than available video memory. Page size depends on
+the format and can be queried with @ref virtualPageSize():
+
+@snippet MagnumGL.cpp Texture-sparse
+
+The @ref SparseTextureResidency class can be used to keep track of which pages
+are actually needed and commit or uncommit them accordingly.
+
 @see @ref Texture1D, @ref Texture2D, @ref Texture3D, @ref TextureArray,
     @ref CubeMapTexture, @ref CubeMapTextureArray, @ref RectangleTexture,
     @ref BufferTexture, @ref MultisampleTexture
@@ -290,6 +318,166 @@ template<UnsignedInt dimensions> class Texture: public AbstractTexture {
         }
         #endif
 
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Bindless texture handle
+         * @m_since_latest
+         *
+         * Returns a 64-bit handle that can be used to access the texture in
+         * shaders without binding it to a texture unit, after making it
+         * resident using @ref makeHandleResident(). The handle is unique for
+         * the texture and stays the same in repeated calls. After calling
+         * this function the texture parameters and storage are immutable,
+         * see @ref GL-Texture-bindless for more information.
+         * @see @fn_gl_keyword{GetTextureHandleARB}
+         * @requires_extension Extension @gl_extension{ARB,bindless_texture}
+         * @requires_gl Bindless textures are not available in OpenGL ES and
+         *      WebGL.
+         */
+        UnsignedLong handle() { return handleInternal(); }
+        #endif
+
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Count of available virtual page sizes
+         * @m_since_latest
+         *
+         * Available only on 2D textures. Returns @cpp 0 @ce if sparse
+         * textures of given @p format are not supported.
+         * @see @ref virtualPageSize(), @ref setSparse(),
+         *      @fn_gl_keyword{GetInternalformat} with
+         *      @def_gl_extension{NUM_VIRTUAL_PAGE_SIZES,ARB,sparse_texture}
+         * @requires_extension Extension @gl_extension{ARB,sparse_texture}
+         * @requires_gl Sparse textures are not available in OpenGL ES and
+         *      WebGL.
+         */
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        template<UnsignedInt d = dimensions, class = typename std::enable_if<d == 2>::type>
+        #endif
+        static Int virtualPageSizeCount(TextureFormat format) {
+            return virtualPageSizeCountInternal(Implementation::textureTarget<dimensions>(), format);
+        }
+
+        /**
+         * @brief Virtual page size
+         * @m_since_latest
+         *
+         * Available only on 2D textures. Expects that @p index is less than
+         * @ref virtualPageSizeCount(). Offsets and sizes passed to
+         * @ref commitPages() and @ref uncommitPages() have to be multiples of
+         * the page size selected with @ref setSparse().
+         * @see @fn_gl_keyword{GetInternalformat} with
+         *      @def_gl_extension{VIRTUAL_PAGE_SIZE_X,ARB,sparse_texture},
+         *      @def_gl_extension{VIRTUAL_PAGE_SIZE_Y,ARB,sparse_texture}
+         * @requires_extension Extension @gl_extension{ARB,sparse_texture}
+         * @requires_gl Sparse textures are not available in OpenGL ES and
+         *      WebGL.
+         */
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        template<UnsignedInt d = dimensions, class = typename std::enable_if<d == 2>::type>
+        #endif
+        static Vector2i virtualPageSize(TextureFormat format, Int index = 0) {
+            return virtualPageSizeInternal(Implementation::textureTarget<dimensions>(), format, index).xy();
+        }
+
+        /**
+         * @brief Make the texture sparse
+         * @param sparse                Whether the texture is sparse
+         * @param virtualPageSizeIndex  Index of the virtual page size to use
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Available only on 2D textures. Has to be called before
+         * @ref setStorage(). Storage of a sparse texture only reserves the
+         * virtual address space, the physical memory is then allocated and
+         * released with @ref commitPages() and @ref uncommitPages(). See
+         * also @ref SparseTextureResidency for a helper that tracks page
+         * residency based on what's requested each frame.
+         * @see @ref virtualPageSize(), @ref sparseLevelCount(),
+         *      @fn_gl_keyword{TexParameter} with
+         *      @def_gl_extension{TEXTURE_SPARSE,ARB,sparse_texture} and
+         *      @def_gl_extension{VIRTUAL_PAGE_SIZE_INDEX,ARB,sparse_texture}
+         * @requires_extension Extension @gl_extension{ARB,sparse_texture}
+         * @requires_gl Sparse textures are not available in OpenGL ES and
+         *      WebGL.
+         */
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        template<UnsignedInt d = dimensions, class = typename std::enable_if<d == 2>::type>
+        #endif
+        Texture<dimensions>& setSparse(bool sparse, Int virtualPageSizeIndex = 0) {
+            setSparseInternal(sparse, virtualPageSizeIndex);
+            return *this;
+        }
+
+        /**
+         * @brief Count of sparse mip levels
+         * @m_since_latest
+         *
+         * Available only on 2D textures. Mip levels starting from this
+         * index are smaller than a single page and are committed and
+         * uncommitted together as a *mip tail* with any page of the last
+         * sparse level.
+         * @see @ref setSparse(), @fn_gl_keyword{GetTexParameter} with
+         *      @def_gl_extension{NUM_SPARSE_LEVELS,ARB,sparse_texture}
+         * @requires_extension Extension @gl_extension{ARB,sparse_texture}
+         * @requires_gl Sparse textures are not available in OpenGL ES and
+         *      WebGL.
+         */
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        template<UnsignedInt d = dimensions, class = typename std::enable_if<d == 2>::type>
+        #endif
+        Int sparseLevelCount() { return sparseLevelCountInternal(); }
+
+        /**
+         * @brief Commit pages of a sparse texture
+         * @param level             Mip level
+         * @param range             Range to commit, in pixels
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Available only on 2D textures. Allocates physical memory for all
+         * pages in @p range, which has to be aligned to
+         * @ref virtualPageSize() or extend to the edge of the level. Contents
+         * of newly committed pages are undefined.
+         * @see @ref uncommitPages(), @ref setSparse(),
+         *      @fn_gl_keyword{TexPageCommitmentARB}
+         * @requires_extension Extension @gl_extension{ARB,sparse_texture}
+         * @requires_gl Sparse textures are not available in OpenGL ES and
+         *      WebGL.
+         */
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        template<UnsignedInt d = dimensions, class = typename std::enable_if<d == 2>::type>
+        #endif
+        Texture<dimensions>& commitPages(Int level, const Range2Di& range) {
+            pageCommitmentInternal(level, range, true);
+            return *this;
+        }
+
+        /**
+         * @brief Uncommit pages of a sparse texture
+         * @param level             Mip level
+         * @param range             Range to uncommit, in pixels
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Available only on 2D textures. Releases physical memory of all
+         * pages in @p range, with the same alignment requirements as
+         * @ref commitPages(). Sampling uncommitted pages returns undefined
+         * values.
+         * @see @fn_gl_keyword{TexPageCommitmentARB}
+         * @requires_extension Extension @gl_extension{ARB,sparse_texture}
+         * @requires_gl Sparse textures are not available in OpenGL ES and
+         *      WebGL.
+         */
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        template<UnsignedInt d = dimensions, class = typename std::enable_if<d == 2>::type>
+        #endif
+        Texture<dimensions>& uncommitPages(Int level, const Range2Di& range) {
+            pageCommitmentInternal(level, range, false);
+            return *this;
+        }
+        #endif
+
         #ifndef MAGNUM_TARGET_GLES2
         /**
          * @brief Set base mip level
@@ -1353,6 +1541,147 @@ template<UnsignedInt dimensions> class Texture: public AbstractTexture {
         }
         #endif
 
+        /**
+         * @brief Set image subdata of consecutive mip levels
+         * @param firstLevel        First mip level
+         * @param images            @ref Image, @ref ImageView or
+         *      @ref Trade::ImageData of the same dimension count for each
+         *      level
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Equivalent to calling @ref setSubImage(Int, const VectorTypeFor<dimensions, Int>&, const BasicImageView<dimensions>&)
+         * with a zero offset for each image, the image at index @cpp i @ce
+         * going to mip level @cpp firstLevel + i @ce. The pixel unpack
+         * buffer is unbound and the texture bound just once for all levels
+         * and pixel storage parameters are set only if they differ from the
+         * previous level. Useful for uploading a whole mip chain at once:
+         *
+         * @snippet MagnumGL.cpp Texture-setSubImages
+         *
+         * See @ref setSubImages(Int, Containers::ArrayView<const BasicImageView<dimensions>>, Buffer&)
+         * for a variant that goes through a staging pixel buffer.
+         * @see @ref setStorage()
+         */
+        Texture<dimensions>& setSubImages(Int firstLevel, Containers::ArrayView<const BasicImageView<dimensions>> images) {
+            DataHelper<Dimensions>::setSubImages(*this, firstLevel, images);
+            return *this;
+        }
+
+        /** @overload
+         * @m_since_latest
+         */
+        Texture<dimensions>& setSubImages(Int firstLevel, std::initializer_list<BasicImageView<dimensions>> images) {
+            return setSubImages(firstLevel, Containers::arrayView(images.begin(), images.size()));
+        }
+
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Set image subdata of consecutive mip levels through a staging buffer
+         * @param firstLevel        First mip level
+         * @param images            @ref Image, @ref ImageView or
+         *      @ref Trade::ImageData of the same dimension count for each
+         *      level
+         * @param stagingBuffer     Buffer to stage the image data in
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Compared to @ref setSubImages(Int, Containers::ArrayView<const BasicImageView<dimensions>>),
+         * data of all images are first copied into @p stagingBuffer with a
+         * single reallocation and a single buffer mapping, each level
+         * starting at a four-byte-aligned offset, and then all levels are
+         * uploaded from it as a pixel unpack buffer. The reallocation
+         * orphans previous contents of the buffer, so it can be reused for
+         * subsequent uploads without waiting for the previous ones to
+         * finish. In WebGL, where buffer mapping isn't available, the data
+         * are copied with a @ref Buffer::setSubData() call for each level
+         * instead.
+         * @see @ref Buffer::setData(), @ref Buffer::map()
+         * @requires_gl30 Extension @gl_extension{ARB,map_buffer_range}
+         * @requires_gles30 Pixel buffer objects are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Pixel buffer objects are not available in WebGL
+         *      1.0.
+         */
+        Texture<dimensions>& setSubImages(Int firstLevel, Containers::ArrayView<const BasicImageView<dimensions>> images, Buffer& stagingBuffer) {
+            DataHelper<Dimensions>::setSubImages(*this, firstLevel, images, stagingBuffer);
+            return *this;
+        }
+
+        /** @overload
+         * @m_since_latest
+         */
+        Texture<dimensions>& setSubImages(Int firstLevel, std::initializer_list<BasicImageView<dimensions>> images, Buffer& stagingBuffer) {
+            return setSubImages(firstLevel, Containers::arrayView(images.begin(), images.size()), stagingBuffer);
+        }
+        #endif
+
+        /**
+         * @brief Set compressed image subdata of consecutive mip levels
+         * @param firstLevel        First mip level
+         * @param images            @ref CompressedImage,
+         *      @ref CompressedImageView or compressed @ref Trade::ImageData
+         *      of the same dimension count for each level
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Compressed equivalent of
+         * @ref setSubImages(Int, Containers::ArrayView<const BasicImageView<dimensions>>),
+         * see its documentation for more information.
+         * @requires_gl42 Extension @gl_extension{ARB,compressed_texture_pixel_storage}
+         *      for non-default @ref CompressedPixelStorage
+         * @requires_gl Non-default @ref CompressedPixelStorage is not
+         *      available in OpenGL ES and WebGL.
+         */
+        Texture<dimensions>& setCompressedSubImages(Int firstLevel, Containers::ArrayView<const BasicCompressedImageView<dimensions>> images) {
+            DataHelper<Dimensions>::setCompressedSubImages(*this, firstLevel, images);
+            return *this;
+        }
+
+        /** @overload
+         * @m_since_latest
+         */
+        Texture<dimensions>& setCompressedSubImages(Int firstLevel, std::initializer_list<BasicCompressedImageView<dimensions>> images) {
+            return setCompressedSubImages(firstLevel, Containers::arrayView(images.begin(), images.size()));
+        }
+
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Set compressed image subdata of consecutive mip levels through a staging buffer
+         * @param firstLevel        First mip level
+         * @param images            @ref CompressedImage,
+         *      @ref CompressedImageView or compressed @ref Trade::ImageData
+         *      of the same dimension count for each level
+         * @param stagingBuffer     Buffer to stage the image data in
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Compressed equivalent of
+         * @ref setSubImages(Int, Containers::ArrayView<const BasicImageView<dimensions>>, Buffer&),
+         * see its documentation for more information.
+         * @requires_gl30 Extension @gl_extension{ARB,map_buffer_range}
+         * @requires_gl42 Extension @gl_extension{ARB,compressed_texture_pixel_storage}
+         *      for non-default @ref CompressedPixelStorage
+         * @requires_gl Non-default @ref CompressedPixelStorage is not
+         *      available in OpenGL ES and WebGL.
+         * @requires_gles30 Pixel buffer objects are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Pixel buffer objects are not available in WebGL
+         *      1.0.
+         */
+        Texture<dimensions>& setCompressedSubImages(Int firstLevel, Containers::ArrayView<const BasicCompressedImageView<dimensions>> images, Buffer& stagingBuffer) {
+            DataHelper<Dimensions>::setCompressedSubImages(*this, firstLevel, images, stagingBuffer);
+            return *this;
+        }
+
+        /** @overload
+         * @m_since_latest
+         */
+        Texture<dimensions>& setCompressedSubImages(Int firstLevel, std::initializer_list<BasicCompressedImageView<dimensions>> images, Buffer& stagingBuffer) {
+            return setCompressedSubImages(firstLevel, Containers::arrayView(images.begin(), images.size()), stagingBuffer);
+        }
+        #endif
+
         /**
          * @brief Generate mipmap
          * @return Reference to self (for method chaining)
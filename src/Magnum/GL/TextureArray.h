@@ -80,6 +80,10 @@ In shader, the texture is used via @glsl sampler1DArray @ce / @glsl sampler2DArr
 See @ref AbstractShaderProgram documentation for more information about usage
 in shaders.
 
+Bindless handles and sparse storage are supported on 2D texture arrays as
+well, see @ref GL-Texture-bindless and @ref GL-Texture-sparse for more
+information.
+
 @see @ref Texture1DArray, @ref Texture2DArray, @ref Texture,
     @ref CubeMapTexture, @ref CubeMapTextureArray, @ref RectangleTexture,
     @ref BufferTexture, @ref MultisampleTexture
@@ -240,6 +244,140 @@ template<UnsignedInt dimensions> class TextureArray: public AbstractTexture {
         }
         #endif
 
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Bindless texture handle
+         * @m_since_latest
+         *
+         * Returns a 64-bit handle that can be used to access the texture in
+         * shaders without binding it to a texture unit, after making it
+         * resident using @ref makeHandleResident(). The handle is unique for
+         * the texture and stays the same in repeated calls. After calling
+         * this function the texture parameters and storage are immutable,
+         * see @ref GL-Texture-bindless for more information.
+         * @see @fn_gl_keyword{GetTextureHandleARB}
+         * @requires_extension Extension @gl_extension{ARB,bindless_texture}
+         * @requires_gl Bindless textures are not available in OpenGL ES and
+         *      WebGL.
+         */
+        UnsignedLong handle() { return handleInternal(); }
+        #endif
+
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief @copybrief Texture::virtualPageSizeCount()
+         * @m_since_latest
+         *
+         * Available only on 2D texture arrays. See
+         * @ref Texture::virtualPageSizeCount() for more information.
+         * @requires_extension Extension @gl_extension{ARB,sparse_texture}
+         * @requires_gl Sparse textures are not available in OpenGL ES and
+         *      WebGL.
+         */
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        template<UnsignedInt d = dimensions, class = typename std::enable_if<d == 2>::type>
+        #endif
+        static Int virtualPageSizeCount(TextureFormat format) {
+            return virtualPageSizeCountInternal(Implementation::textureArrayTarget<dimensions>(), format);
+        }
+
+        /**
+         * @brief @copybrief Texture::virtualPageSize()
+         * @m_since_latest
+         *
+         * Available only on 2D texture arrays. The Z component is the page
+         * depth in layers. See @ref Texture::virtualPageSize() for more
+         * information.
+         * @requires_extension Extension @gl_extension{ARB,sparse_texture}
+         * @requires_gl Sparse textures are not available in OpenGL ES and
+         *      WebGL.
+         */
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        template<UnsignedInt d = dimensions, class = typename std::enable_if<d == 2>::type>
+        #endif
+        static Vector3i virtualPageSize(TextureFormat format, Int index = 0) {
+            return virtualPageSizeInternal(Implementation::textureArrayTarget<dimensions>(), format, index);
+        }
+
+        /**
+         * @brief @copybrief Texture::setSparse()
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Available only on 2D texture arrays. See
+         * @ref Texture::setSparse() for more information.
+         * @requires_extension Extension @gl_extension{ARB,sparse_texture}
+         * @requires_gl Sparse textures are not available in OpenGL ES and
+         *      WebGL.
+         */
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        template<UnsignedInt d = dimensions, class = typename std::enable_if<d == 2>::type>
+        #endif
+        TextureArray<dimensions>& setSparse(bool sparse, Int virtualPageSizeIndex = 0) {
+            setSparseInternal(sparse, virtualPageSizeIndex);
+            return *this;
+        }
+
+        /**
+         * @brief @copybrief Texture::sparseLevelCount()
+         * @m_since_latest
+         *
+         * Available only on 2D texture arrays. See
+         * @ref Texture::sparseLevelCount() for more information.
+         * @requires_extension Extension @gl_extension{ARB,sparse_texture}
+         * @requires_gl Sparse textures are not available in OpenGL ES and
+         *      WebGL.
+         */
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        template<UnsignedInt d = dimensions, class = typename std::enable_if<d == 2>::type>
+        #endif
+        Int sparseLevelCount() { return sparseLevelCountInternal(); }
+
+        /**
+         * @brief @copybrief Texture::commitPages()
+         * @param level             Mip level
+         * @param range             Range to commit, in pixels and layers
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Available only on 2D texture arrays. The Z coordinate of @p range
+         * specifies layers. See @ref Texture::commitPages() for more
+         * information.
+         * @requires_extension Extension @gl_extension{ARB,sparse_texture}
+         * @requires_gl Sparse textures are not available in OpenGL ES and
+         *      WebGL.
+         */
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        template<UnsignedInt d = dimensions, class = typename std::enable_if<d == 2>::type>
+        #endif
+        TextureArray<dimensions>& commitPages(Int level, const Range3Di& range) {
+            pageCommitmentInternal(level, range, true);
+            return *this;
+        }
+
+        /**
+         * @brief @copybrief Texture::uncommitPages()
+         * @param level             Mip level
+         * @param range             Range to uncommit, in pixels and layers
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Available only on 2D texture arrays. The Z coordinate of @p range
+         * specifies layers. See @ref Texture::uncommitPages() for more
+         * information.
+         * @requires_extension Extension @gl_extension{ARB,sparse_texture}
+         * @requires_gl Sparse textures are not available in OpenGL ES and
+         *      WebGL.
+         */
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        template<UnsignedInt d = dimensions, class = typename std::enable_if<d == 2>::type>
+        #endif
+        TextureArray<dimensions>& uncommitPages(Int level, const Range3Di& range) {
+            pageCommitmentInternal(level, range, false);
+            return *this;
+        }
+        #endif
+
         /**
          * @brief @copybrief Texture::setBaseLevel()
          * @return Reference to self (for method chaining)
@@ -940,6 +1078,86 @@ template<UnsignedInt dimensions> class TextureArray: public AbstractTexture {
             return setCompressedSubImage(level, offset, image);
         }
 
+        /**
+         * @brief @copybrief Texture::setSubImages(Int, Containers::ArrayView<const BasicImageView<dimensions>>)
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * See @ref Texture::setSubImages(Int, Containers::ArrayView<const BasicImageView<dimensions>>)
+         * for more information.
+         */
+        TextureArray<dimensions>& setSubImages(Int firstLevel, Containers::ArrayView<const BasicImageView<dimensions+1>> images) {
+            DataHelper<dimensions+1>::setSubImages(*this, firstLevel, images);
+            return *this;
+        }
+
+        /** @overload
+         * @m_since_latest
+         */
+        TextureArray<dimensions>& setSubImages(Int firstLevel, std::initializer_list<BasicImageView<dimensions+1>> images) {
+            return setSubImages(firstLevel, Containers::arrayView(images.begin(), images.size()));
+        }
+
+        /**
+         * @brief @copybrief Texture::setSubImages(Int, Containers::ArrayView<const BasicImageView<dimensions>>, Buffer&)
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * See @ref Texture::setSubImages(Int, Containers::ArrayView<const BasicImageView<dimensions>>, Buffer&)
+         * for more information.
+         */
+        TextureArray<dimensions>& setSubImages(Int firstLevel, Containers::ArrayView<const BasicImageView<dimensions+1>> images, Buffer& stagingBuffer) {
+            DataHelper<dimensions+1>::setSubImages(*this, firstLevel, images, stagingBuffer);
+            return *this;
+        }
+
+        /** @overload
+         * @m_since_latest
+         */
+        TextureArray<dimensions>& setSubImages(Int firstLevel, std::initializer_list<BasicImageView<dimensions+1>> images, Buffer& stagingBuffer) {
+            return setSubImages(firstLevel, Containers::arrayView(images.begin(), images.size()), stagingBuffer);
+        }
+
+        /**
+         * @brief @copybrief Texture::setCompressedSubImages(Int, Containers::ArrayView<const BasicCompressedImageView<dimensions>>)
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * See @ref Texture::setCompressedSubImages(Int, Containers::ArrayView<const BasicCompressedImageView<dimensions>>)
+         * for more information.
+         */
+        TextureArray<dimensions>& setCompressedSubImages(Int firstLevel, Containers::ArrayView<const BasicCompressedImageView<dimensions+1>> images) {
+            DataHelper<dimensions+1>::setCompressedSubImages(*this, firstLevel, images);
+            return *this;
+        }
+
+        /** @overload
+         * @m_since_latest
+         */
+        TextureArray<dimensions>& setCompressedSubImages(Int firstLevel, std::initializer_list<BasicCompressedImageView<dimensions+1>> images) {
+            return setCompressedSubImages(firstLevel, Containers::arrayView(images.begin(), images.size()));
+        }
+
+        /**
+         * @brief @copybrief Texture::setCompressedSubImages(Int, Containers::ArrayView<const BasicCompressedImageView<dimensions>>, Buffer&)
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * See @ref Texture::setCompressedSubImages(Int, Containers::ArrayView<const BasicCompressedImageView<dimensions>>, Buffer&)
+         * for more information.
+         */
+        TextureArray<dimensions>& setCompressedSubImages(Int firstLevel, Containers::ArrayView<const BasicCompressedImageView<dimensions+1>> images, Buffer& stagingBuffer) {
+            DataHelper<dimensions+1>::setCompressedSubImages(*this, firstLevel, images, stagingBuffer);
+            return *this;
+        }
+
+        /** @overload
+         * @m_since_latest
+         */
+        TextureArray<dimensions>& setCompressedSubImages(Int firstLevel, std::initializer_list<BasicCompressedImageView<dimensions+1>> images, Buffer& stagingBuffer) {
+            return setCompressedSubImages(firstLevel, Containers::arrayView(images.begin(), images.size()), stagingBuffer);
+        }
+
         /**
          * @brief @copybrief Texture::generateMipmap()
          * @return Reference to self (for method chaining)
@@ -0,0 +1,264 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "TextureStreamer.h"
+
+#include <cmath>
+#include <algorithm>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/GL/Texture.h"
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum { namespace GL {
+
+struct TextureStreamer::Entry {
+    /* Null if added without a texture */
+    Texture2D* texture;
+    Vector2i size;
+    Int levelCount;
+    UnsignedInt bitsPerPixel;
+    /* Levels from this one up are never evicted */
+    Int residentBaseLevel;
+    Int baseLevel;
+    /* Base level last applied to the texture */
+    Int appliedBaseLevel;
+    /* levelCount if not requested in this frame */
+    Int requestedLevel;
+    UnsignedInt lastRequested;
+    /* False for removed entries that can be reused */
+    bool used;
+};
+
+namespace {
+
+std::size_t levelDataSize(const Vector2i& size, const UnsignedInt bitsPerPixel, const Int level) {
+    return (std::size_t(Math::max(size >> level, Vector2i{1}).product())*bitsPerPixel + 7)/8;
+}
+
+}
+
+Int TextureStreamer::levelForScreenSize(const Vector2i& textureSize, const Vector2& screenSize) {
+    const Float ratio = (Vector2{textureSize}/screenSize).min();
+    /* Also catches NaNs from zero sizes */
+    if(!(ratio > 1.0f)) return 0;
+    /* Infinity if the screen size is zero, catch it to not convert it to an
+       integer */
+    if(ratio >= Float(1 << 30)) return 30;
+    return Int(std::log2(ratio));
+}
+
+TextureStreamer::TextureStreamer(const std::size_t memoryBudget, const UnsignedInt evictionDelay): _memoryBudget{memoryBudget}, _evictionDelay{evictionDelay} {}
+
+TextureStreamer::TextureStreamer(TextureStreamer&&) noexcept = default;
+
+TextureStreamer::~TextureStreamer() = default;
+
+TextureStreamer& TextureStreamer::operator=(TextureStreamer&&) noexcept = default;
+
+UnsignedInt TextureStreamer::add(Texture2D& texture, const Vector2i& size, const Int levelCount, const UnsignedInt bitsPerPixel, const Int residentLevelCount) {
+    const UnsignedInt id = addInternal(&texture, size, levelCount, bitsPerPixel, residentLevelCount);
+    #ifdef CORRADE_GRACEFUL_ASSERT
+    if(id == ~UnsignedInt{}) return id;
+    #endif
+    texture.setBaseLevel(_entries[id].baseLevel);
+    return id;
+}
+
+UnsignedInt TextureStreamer::add(const Vector2i& size, const Int levelCount, const UnsignedInt bitsPerPixel, const Int residentLevelCount) {
+    return addInternal(nullptr, size, levelCount, bitsPerPixel, residentLevelCount);
+}
+
+UnsignedInt TextureStreamer::addInternal(Texture2D* const texture, const Vector2i& size, const Int levelCount, const UnsignedInt bitsPerPixel, const Int residentLevelCount) {
+    CORRADE_ASSERT(size.product(),
+        "GL::TextureStreamer::add(): expected non-zero size but got" << Debug::packed << size, ~UnsignedInt{});
+    CORRADE_ASSERT(levelCount > 0,
+        "GL::TextureStreamer::add(): expected non-zero level count", ~UnsignedInt{});
+    CORRADE_ASSERT(bitsPerPixel,
+        "GL::TextureStreamer::add(): expected non-zero pixel size", ~UnsignedInt{});
+    CORRADE_ASSERT(residentLevelCount > 0 && residentLevelCount <= levelCount,
+        "GL::TextureStreamer::add(): expected resident level count to be non-zero and not larger than" << levelCount << "but got" << residentLevelCount, ~UnsignedInt{});
+
+    const Int residentBaseLevel = levelCount - residentLevelCount;
+    const Entry entry{texture, size, levelCount, bitsPerPixel, residentBaseLevel, residentBaseLevel, residentBaseLevel, levelCount, 0, true};
+
+    /* Reuse a removed entry, if there's any */
+    UnsignedInt id = 0;
+    while(id != _entries.size() && _entries[id].used) ++id;
+    if(id == _entries.size())
+        arrayAppend(_entries, entry);
+    else
+        _entries[id] = entry;
+    for(Int level = residentBaseLevel; level != levelCount; ++level)
+        _residentMemory += levelDataSize(size, bitsPerPixel, level);
+    ++_textureCount;
+    return id;
+}
+
+void TextureStreamer::remove(const UnsignedInt id) {
+    CORRADE_ASSERT(id < _entries.size() && _entries[id].used,
+        "GL::TextureStreamer::remove(): invalid ID" << id, );
+
+    Entry& entry = _entries[id];
+    for(Int level = entry.baseLevel; level != entry.levelCount; ++level)
+        _residentMemory -= levelDataSize(entry.size, entry.bitsPerPixel, level);
+    entry.used = false;
+    entry.texture = nullptr;
+    --_textureCount;
+}
+
+Int TextureStreamer::levelCount(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _entries.size() && _entries[id].used,
+        "GL::TextureStreamer::levelCount(): invalid ID" << id, {});
+    return _entries[id].levelCount;
+}
+
+Int TextureStreamer::baseLevel(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _entries.size() && _entries[id].used,
+        "GL::TextureStreamer::baseLevel(): invalid ID" << id, {});
+    return _entries[id].baseLevel;
+}
+
+Int TextureStreamer::requestedLevel(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _entries.size() && _entries[id].used,
+        "GL::TextureStreamer::requestedLevel(): invalid ID" << id, {});
+    return _entries[id].requestedLevel;
+}
+
+void TextureStreamer::request(const UnsignedInt id, const Int level) {
+    CORRADE_ASSERT(id < _entries.size() && _entries[id].used,
+        "GL::TextureStreamer::request(): invalid ID" << id, );
+    CORRADE_ASSERT(level >= 0,
+        "GL::TextureStreamer::request(): expected a non-negative level but got" << level, );
+
+    Entry& entry = _entries[id];
+    entry.requestedLevel = Math::min(entry.requestedLevel, Math::min(level, entry.levelCount - 1));
+    entry.lastRequested = _frame;
+}
+
+void TextureStreamer::request(const UnsignedInt id, const Vector2& screenSize) {
+    CORRADE_ASSERT(id < _entries.size() && _entries[id].used,
+        "GL::TextureStreamer::request(): invalid ID" << id, );
+    request(id, levelForScreenSize(_entries[id].size, screenSize));
+}
+
+bool TextureStreamer::evictFor(const std::size_t size, const UnsignedInt exceptId) {
+    while(_residentMemory + size > _memoryBudget) {
+        /* Find the texture with the most levels that are uploaded but not
+           needed in this frame. For textures that weren't requested the
+           requested level is the level count, so all streamed levels are
+           excess. */
+        Entry* victim = nullptr;
+        Int victimExcess = 0;
+        for(std::size_t i = 0; i != _entries.size(); ++i) {
+            Entry& entry = _entries[i];
+            if(!entry.used || i == exceptId) continue;
+            const Int excess = Math::min(entry.requestedLevel, entry.residentBaseLevel) - entry.baseLevel;
+            if(excess > victimExcess) {
+                victim = &entry;
+                victimExcess = excess;
+            }
+        }
+
+        /* Everything that's uploaded is needed, can't make room */
+        if(!victim) return false;
+
+        _residentMemory -= levelDataSize(victim->size, victim->bitsPerPixel, victim->baseLevel);
+        ++victim->baseLevel;
+    }
+
+    return true;
+}
+
+std::size_t TextureStreamer::update(void(*const upload)(UnsignedInt, Int, void*), void* const userData) {
+    /* Evict streamed levels of textures that weren't requested for too
+       long */
+    for(Entry& entry: _entries) {
+        if(!entry.used || entry.baseLevel == entry.residentBaseLevel) continue;
+        if(entry.lastRequested && _frame - entry.lastRequested <= _evictionDelay) continue;
+
+        for(Int level = entry.baseLevel; level != entry.residentBaseLevel; ++level)
+            _residentMemory -= levelDataSize(entry.size, entry.bitsPerPixel, level);
+        entry.baseLevel = entry.residentBaseLevel;
+    }
+
+    /* Gather textures that need finer levels, the ones with the largest
+       difference between the requested and the uploaded level first */
+    Containers::Array<UnsignedInt> candidates;
+    for(std::size_t i = 0; i != _entries.size(); ++i) {
+        const Entry& entry = _entries[i];
+        if(entry.used && entry.requestedLevel < entry.baseLevel)
+            arrayAppend(candidates, UnsignedInt(i));
+    }
+    std::stable_sort(candidates.begin(), candidates.end(), [this](UnsignedInt a, UnsignedInt b) {
+        return _entries[a].baseLevel - _entries[a].requestedLevel >
+               _entries[b].baseLevel - _entries[b].requestedLevel;
+    });
+
+    /* Upload one level of each candidate at a time, so a single texture
+       needing many levels doesn't starve the others */
+    std::size_t uploadCount = 0;
+    for(bool progress = true; progress && uploadCount < _uploadLimit; ) {
+        progress = false;
+        for(const UnsignedInt id: candidates) {
+            if(uploadCount == _uploadLimit) break;
+
+            Entry& entry = _entries[id];
+            if(entry.requestedLevel >= entry.baseLevel) continue;
+
+            const Int level = entry.baseLevel - 1;
+            const std::size_t size = levelDataSize(entry.size, entry.bitsPerPixel, level);
+            if(!evictFor(size, id)) continue;
+
+            upload(id, level, userData);
+            entry.baseLevel = level;
+            _residentMemory += size;
+            ++uploadCount;
+            progress = true;
+        }
+    }
+
+    /* Shrink to the budget if it was lowered or if there were no uploads
+       that would trigger the eviction */
+    evictFor(0, ~UnsignedInt{});
+
+    /* Apply the base levels and start a new frame */
+    for(Entry& entry: _entries) {
+        if(!entry.used) continue;
+
+        if(entry.baseLevel != entry.appliedBaseLevel) {
+            if(entry.texture) entry.texture->setBaseLevel(entry.baseLevel);
+            entry.appliedBaseLevel = entry.baseLevel;
+        }
+
+        entry.requestedLevel = entry.levelCount;
+    }
+    ++_frame;
+
+    return uploadCount;
+}
+
+}}
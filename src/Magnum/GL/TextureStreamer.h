@@ -0,0 +1,297 @@
+#ifndef Magnum_GL_TextureStreamer_h
+#define Magnum_GL_TextureStreamer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MAGNUM_TARGET_GLES2
+/** @file
+ * @brief Class @ref Magnum::GL::TextureStreamer
+ * @m_since_latest
+ */
+#endif
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/GL/GL.h"
+#include "Magnum/GL/visibility.h"
+#include "Magnum/Math/Vector2.h"
+
+#ifndef MAGNUM_TARGET_GLES2
+namespace Magnum { namespace GL {
+
+/**
+@brief Mip level streaming manager for 2D textures
+@m_since_latest
+
+Manages which mip levels of a set of @ref Texture2D instances are uploaded,
+based on how large the textures appear on screen and on a global memory
+budget. The textures are expected to be created with storage for the full mip
+chain using @ref Texture::setStorage(), with only a few coarsest levels
+uploaded initially. The streamer then clamps @ref Texture::setBaseLevel() to
+the uploaded levels, so sampling never reads undefined data, and requests
+uploads of finer levels as they're needed:
+
+@snippet MagnumGL.cpp TextureStreamer-usage
+
+@section GL-TextureStreamer-demand Screen-space demand
+
+Each frame, the finest level needed by each drawn texture is marked with
+@ref request(). The level can be calculated from the projected on-screen size
+of the textured object with @ref levelForScreenSize(), a texture that covers
+100x100 pixels doesn't need more than the 128x128 level for example. Multiple
+requests for the same texture in one frame result in the finest of the
+requested levels being used.
+
+@section GL-TextureStreamer-update Updating residency
+
+@ref update() then goes through the textures that need finer levels than
+what's currently uploaded, the ones with the largest difference between the
+requested and the uploaded level first, and calls the supplied upload
+callback one level at a time, finest levels last. If uploading a level would
+exceed @ref memoryBudget(), levels that are uploaded but not needed anymore
+are evicted first --- levels finer than what was requested in this frame, or
+all streamed levels of textures that weren't requested at all. Levels that
+are still needed by other textures are never evicted to make room, in that
+case the upload is postponed. Textures that weren't requested for more than
+@ref evictionDelay() updates have their streamed levels evicted
+unconditionally. The count of uploads per update can be additionally limited
+with @ref setUploadLimit() to spread the upload cost over multiple frames.
+
+Evicting a level only raises the base level of the texture, the data are
+left in place and the level is uploaded again when needed. Note that storage
+allocated with @ref Texture::setStorage() is usually committed by the driver
+for the full mip chain right away, the budget thus limits the amount of
+uploaded data and texture memory bandwidth rather than actual memory
+allocation. Combine with @ref SparseTextureResidency to avoid committing
+memory for levels that aren't resident on platforms that support sparse
+textures.
+
+@requires_gl30 Texture base level is always @cpp 0 @ce in OpenGL 2.1.
+@requires_gles30 Texture base level is always @cpp 0 @ce in OpenGL ES 2.0
+    and WebGL 1.0.
+*/
+class MAGNUM_GL_EXPORT TextureStreamer {
+    public:
+        /**
+         * @brief Level needed for given on-screen size
+         * @param textureSize   Texture size in pixels
+         * @param screenSize    Projected size of the texture on screen in
+         *      pixels
+         *
+         * Returns the coarsest level that's still at least as large as
+         * @p screenSize in both dimensions, i.e. a base-2 logarithm of the
+         * minimal ratio between @p textureSize and @p screenSize, rounded
+         * down and clamped to @cpp 0 @ce. The result isn't clamped to the
+         * level count, @ref request() does that.
+         */
+        static Int levelForScreenSize(const Vector2i& textureSize, const Vector2& screenSize);
+
+        /**
+         * @brief Constructor
+         * @param memoryBudget  Memory budget in bytes
+         * @param evictionDelay How many @ref update() calls a texture keeps
+         *      its streamed levels after it was last requested
+         */
+        explicit TextureStreamer(std::size_t memoryBudget, UnsignedInt evictionDelay = 0);
+
+        /** @brief Copying is not allowed */
+        TextureStreamer(const TextureStreamer&) = delete;
+
+        /** @brief Move constructor */
+        TextureStreamer(TextureStreamer&&) noexcept;
+
+        ~TextureStreamer();
+
+        /** @brief Copying is not allowed */
+        TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+        /** @brief Move assignment */
+        TextureStreamer& operator=(TextureStreamer&&) noexcept;
+
+        /** @brief Memory budget in bytes */
+        std::size_t memoryBudget() const { return _memoryBudget; }
+
+        /**
+         * @brief Set memory budget
+         * @return Reference to self (for method chaining)
+         *
+         * If the resident memory is over the new budget, levels that aren't
+         * needed are evicted in the next @ref update().
+         */
+        TextureStreamer& setMemoryBudget(std::size_t bytes) {
+            _memoryBudget = bytes;
+            return *this;
+        }
+
+        /** @brief Eviction delay */
+        UnsignedInt evictionDelay() const { return _evictionDelay; }
+
+        /** @brief Max count of level uploads in one @ref update() */
+        UnsignedInt uploadLimit() const { return _uploadLimit; }
+
+        /**
+         * @brief Limit count of level uploads in one @ref update()
+         * @return Reference to self (for method chaining)
+         *
+         * Default is unlimited.
+         */
+        TextureStreamer& setUploadLimit(UnsignedInt count) {
+            _uploadLimit = count;
+            return *this;
+        }
+
+        /**
+         * @brief Resident memory in bytes
+         *
+         * Total size of all uploaded levels of all textures, including the
+         * always resident coarsest levels. Can be larger than
+         * @ref memoryBudget() if the always resident levels alone don't fit
+         * into it.
+         */
+        std::size_t residentMemory() const { return _residentMemory; }
+
+        /** @brief Count of managed textures */
+        std::size_t textureCount() const { return _textureCount; }
+
+        /**
+         * @brief Add a texture
+         * @param texture       Texture with storage for @p levelCount
+         *      levels
+         * @param size          Size of the texture level @cpp 0 @ce
+         * @param levelCount    Mip level count. Expected to be non-zero.
+         * @param bitsPerPixel  Pixel size in bits, used for calculating
+         *      memory usage. For block-compressed formats it's the block size
+         *      divided by the count of pixels in a block, for example
+         *      @cpp 4 @ce for BC1. Expected to be non-zero.
+         * @param residentLevelCount Count of coarsest levels that are
+         *      already uploaded and are never evicted. Expected to be
+         *      non-zero and not larger than @p levelCount.
+         * @return ID of the texture, used in other functions
+         *
+         * Calls @ref Texture::setBaseLevel() with the first resident level.
+         * The texture is expected to stay alive until it's removed using
+         * @ref remove(). IDs of removed textures are reused.
+         */
+        UnsignedInt add(Texture2D& texture, const Vector2i& size, Int levelCount, UnsignedInt bitsPerPixel, Int residentLevelCount);
+
+        /**
+         * @brief Add a texture without a GL object
+         *
+         * Like @ref add(Texture2D&, const Vector2i&, Int, UnsignedInt, Int),
+         * but the base level is only tracked and available through
+         * @ref baseLevel(), without calling any GL APIs. Useful when the
+         * application wants to apply the base level itself.
+         */
+        UnsignedInt add(const Vector2i& size, Int levelCount, UnsignedInt bitsPerPixel, Int residentLevelCount);
+
+        /**
+         * @brief Remove a texture
+         *
+         * Expects that @p id is a valid texture ID. The ID may get reused by
+         * a subsequent @ref add().
+         */
+        void remove(UnsignedInt id);
+
+        /**
+         * @brief Mip level count of a texture
+         *
+         * Expects that @p id is a valid texture ID.
+         */
+        Int levelCount(UnsignedInt id) const;
+
+        /**
+         * @brief Base level of a texture
+         *
+         * The finest uploaded level. Expects that @p id is a valid texture
+         * ID.
+         */
+        Int baseLevel(UnsignedInt id) const;
+
+        /**
+         * @brief Level requested in this frame
+         *
+         * Returns @ref levelCount(UnsignedInt) const if the texture wasn't
+         * requested since the last @ref update(). Expects that @p id is a
+         * valid texture ID.
+         */
+        Int requestedLevel(UnsignedInt id) const;
+
+        /**
+         * @brief Request a level
+         *
+         * Marks @p level and all coarser levels as needed in the current
+         * frame. Levels past the last level are clamped to it. Expects that
+         * @p id is a valid texture ID and @p level is not negative.
+         */
+        void request(UnsignedInt id, Int level);
+
+        /**
+         * @brief Request a level for given on-screen size
+         *
+         * Equivalent to calling @ref request(UnsignedInt, Int) with the
+         * result of @ref levelForScreenSize().
+         */
+        void request(UnsignedInt id, const Vector2& screenSize);
+
+        /**
+         * @brief Update level residency
+         * @param upload        Function to call for each level that should
+         *      be uploaded
+         * @param userData      User data passed to @p upload
+         * @return Count of uploaded levels
+         *
+         * Calls @p upload for levels that should be uploaded and evicts
+         * levels that aren't needed as described in
+         * @ref GL-TextureStreamer-update, calls
+         * @ref Texture::setBaseLevel() on textures with a changed base
+         * level and starts a new frame, resetting the requests. The callback
+         * is expected to upload the whole level with
+         * @ref Texture::setSubImage() or
+         * @ref Texture::setCompressedSubImage(), the base level is adjusted
+         * after it returns.
+         */
+        std::size_t update(void(*upload)(UnsignedInt id, Int level, void* userData), void* userData);
+
+    private:
+        struct Entry;
+
+        MAGNUM_GL_LOCAL UnsignedInt addInternal(Texture2D* texture, const Vector2i& size, Int levelCount, UnsignedInt bitsPerPixel, Int residentLevelCount);
+        MAGNUM_GL_LOCAL bool evictFor(std::size_t size, UnsignedInt exceptId);
+
+        std::size_t _memoryBudget, _residentMemory{}, _textureCount{};
+        UnsignedInt _evictionDelay,
+            _uploadLimit{~UnsignedInt{}},
+            /* Frame numbers start from 1, 0 means never requested */
+            _frame{1};
+        Containers::Array<Entry> _entries;
+};
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 build
+#endif
+
+#endif
@@ -0,0 +1,251 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "TextureUploader.h"
+
+#include <mutex>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/GL/Buffer.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/PixelFormat.h"
+#include "Magnum/GL/Texture.h"
+#include "Magnum/GL/Implementation/RendererState.h"
+#include "Magnum/GL/Implementation/State.h"
+#include "Magnum/GL/Implementation/TextureState.h"
+
+namespace Magnum { namespace GL {
+
+namespace {
+
+struct Upload {
+    Texture2D* texture;
+    Int level;
+    Vector2i offset;
+    Vector2i size;
+    PixelStorage storage;
+    PixelFormat format;
+    PixelType type;
+    UnsignedInt slot;
+};
+
+struct Batch {
+    GLsync fence;
+    /* Slots of the uploads issued together with this fence */
+    std::size_t slotBegin, slotEnd;
+    /* Value of completed once the fence is signaled */
+    UnsignedLong end;
+};
+
+}
+
+struct TextureUploader::State {
+    explicit State(std::size_t slotSize, std::size_t slotCount);
+
+    Buffer buffer;
+    char* data;
+    std::size_t slotSize, slotCount;
+
+    /* Shared with the worker threads */
+    mutable std::mutex mutex;
+    Containers::Array<UnsignedInt> freeSlots;
+    Containers::Array<Upload> pending;
+    UnsignedLong staged{}, completed{};
+
+    /* Accessed only from the GL thread. The in-flight slots are a FIFO
+       referenced by the batches, cleared once there's no batch left. */
+    Containers::Array<Upload> submitting;
+    Containers::Array<UnsignedInt> inFlightSlots;
+    Containers::Array<Batch> batches;
+    std::size_t batchBegin{};
+    UnsignedLong submitted{};
+};
+
+TextureUploader::State::State(const std::size_t slotSize, const std::size_t slotCount): buffer{Buffer::TargetHint::PixelUnpack}, slotSize{slotSize}, slotCount{slotCount} {
+    buffer.setStorage(slotSize*slotCount, Buffer::StorageFlag::MapWrite|Buffer::StorageFlag::MapPersistent|Buffer::StorageFlag::MapCoherent);
+    data = buffer.map(0, slotSize*slotCount, Buffer::MapFlag::Write|Buffer::MapFlag::Persistent|Buffer::MapFlag::Coherent).data();
+
+    /* Popped from the back, so the first staged upload gets the first
+       slot */
+    arrayReserve(freeSlots, slotCount);
+    for(std::size_t i = 0; i != slotCount; ++i)
+        arrayAppend(freeSlots, UnsignedInt(slotCount - i - 1));
+}
+
+TextureUploader::TextureUploader(const std::size_t slotSize, const std::size_t slotCount) {
+    CORRADE_ASSERT(slotSize && slotCount,
+        "GL::TextureUploader: expected non-zero slot size and count but got" << slotSize << "and" << slotCount, );
+
+    _state.emplace((slotSize + 3)/4*4, slotCount);
+}
+
+TextureUploader::TextureUploader(NoCreateT) noexcept {}
+
+TextureUploader::TextureUploader(TextureUploader&&) noexcept = default;
+
+TextureUploader::~TextureUploader() {
+    if(!_state) return;
+    for(std::size_t i = _state->batchBegin; i != _state->batches.size(); ++i)
+        glDeleteSync(_state->batches[i].fence);
+}
+
+TextureUploader& TextureUploader::operator=(TextureUploader&&) noexcept = default;
+
+Buffer& TextureUploader::buffer() {
+    return _state->buffer;
+}
+
+std::size_t TextureUploader::slotSize() const {
+    return _state ? _state->slotSize : 0;
+}
+
+std::size_t TextureUploader::slotCount() const {
+    return _state ? _state->slotCount : 0;
+}
+
+Containers::Optional<UnsignedLong> TextureUploader::stage(Texture2D& texture, const Int level, const Vector2i& offset, const ImageView2D& image) {
+    CORRADE_ASSERT(_state,
+        "GL::TextureUploader::stage(): the instance is in a moved-from state", {});
+    State& state = *_state;
+    CORRADE_ASSERT(image.data().size() <= state.slotSize,
+        "GL::TextureUploader::stage(): image of" << image.data().size() << "bytes doesn't fit into a slot of" << state.slotSize << "bytes", {});
+
+    /* Format conversion is just a table lookup, so it can be done here
+       instead of on the GL thread */
+    Upload upload{&texture, level, offset, image.size(), image.storage(),
+        pixelFormat(image.format()),
+        pixelType(image.format(), image.formatExtra()), 0};
+
+    {
+        std::lock_guard<std::mutex> lock{state.mutex};
+        if(state.freeSlots.isEmpty()) return {};
+        upload.slot = state.freeSlots.back();
+        arrayRemoveSuffix(state.freeSlots);
+    }
+
+    /* Copy without holding the lock, the slot is owned by this thread until
+       it's queued */
+    Utility::copy(image.data(), Containers::ArrayView<char>{state.data + upload.slot*state.slotSize, image.data().size()});
+
+    /* Upload IDs get assigned in the order the uploads get queued so they
+       can be compared against the count of completed uploads */
+    std::lock_guard<std::mutex> lock{state.mutex};
+    arrayAppend(state.pending, upload);
+    return state.staged++;
+}
+
+void TextureUploader::retire(const bool wait) {
+    State& state = *_state;
+
+    while(state.batchBegin != state.batches.size()) {
+        const Batch& batch = state.batches[state.batchBegin];
+
+        /* When waiting, flush on the first wait so the fence isn't waited
+           on forever if it wasn't submitted yet, then wait for a second at
+           a time. Otherwise just poll and stop at the first non-signaled
+           fence, as the following ones can't be signaled either. */
+        GLbitfield flags = wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0;
+        GLenum result;
+        for(;;) {
+            result = glClientWaitSync(batch.fence, flags, wait ? 1000000000ull : 0);
+            if(!wait || result != GL_TIMEOUT_EXPIRED) break;
+            flags = 0;
+        }
+        /* GL_WAIT_FAILED would only happen with an invalid sync object or
+           context loss, treating it as signaled to not leak slots */
+        if(result == GL_TIMEOUT_EXPIRED) break;
+
+        glDeleteSync(batch.fence);
+        {
+            std::lock_guard<std::mutex> lock{state.mutex};
+            arrayAppend(state.freeSlots, state.inFlightSlots.slice(batch.slotBegin, batch.slotEnd));
+            state.completed = batch.end;
+        }
+        ++state.batchBegin;
+    }
+
+    /* Everything retired, reset the FIFOs to reuse their memory */
+    if(state.batchBegin == state.batches.size()) {
+        arrayResize(state.batches, NoInit, 0);
+        arrayResize(state.inFlightSlots, NoInit, 0);
+        state.batchBegin = 0;
+    }
+}
+
+TextureUploader& TextureUploader::update() {
+    CORRADE_ASSERT(_state,
+        "GL::TextureUploader::update(): the instance is in a moved-from state", *this);
+    State& state = *_state;
+
+    retire(false);
+
+    /* Take the pending uploads, swapping with the (empty) array from the
+       previous call to reuse its memory */
+    {
+        std::lock_guard<std::mutex> lock{state.mutex};
+        std::swap(state.pending, state.submitting);
+    }
+    if(state.submitting.isEmpty()) return *this;
+
+    Implementation::State& glState = Context::current().state();
+    const std::size_t slotBegin = state.inFlightSlots.size();
+    state.buffer.bindInternal(Buffer::TargetHint::PixelUnpack);
+    for(const Upload& upload: state.submitting) {
+        glState.renderer.applyPixelStorageUnpack(upload.storage);
+        (static_cast<AbstractTexture&>(*upload.texture).*glState.texture.subImage2DImplementation)(upload.level, upload.offset, upload.size, upload.format, upload.type, reinterpret_cast<const GLvoid*>(upload.slot*state.slotSize), upload.storage);
+        arrayAppend(state.inFlightSlots, upload.slot);
+    }
+
+    state.submitted += state.submitting.size();
+    arrayAppend(state.batches, Batch{glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0), slotBegin, state.inFlightSlots.size(), state.submitted});
+    arrayResize(state.submitting, NoInit, 0);
+    return *this;
+}
+
+TextureUploader& TextureUploader::finish() {
+    CORRADE_ASSERT(_state,
+        "GL::TextureUploader::finish(): the instance is in a moved-from state", *this);
+
+    update();
+    retire(true);
+    return *this;
+}
+
+std::size_t TextureUploader::pendingCount() const {
+    if(!_state) return 0;
+    std::lock_guard<std::mutex> lock{_state->mutex};
+    return _state->pending.size();
+}
+
+UnsignedLong TextureUploader::completedCount() const {
+    if(!_state) return 0;
+    std::lock_guard<std::mutex> lock{_state->mutex};
+    return _state->completed;
+}
+
+}}
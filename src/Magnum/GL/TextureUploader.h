@@ -0,0 +1,235 @@
+#ifndef Magnum_GL_TextureUploader_h
+#define Magnum_GL_TextureUploader_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MAGNUM_TARGET_GLES
+/** @file
+ * @brief Class @ref Magnum::GL::TextureUploader
+ * @m_since_latest
+ */
+#endif
+
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/GL/GL.h"
+#include "Magnum/GL/OpenGL.h"
+#include "Magnum/GL/visibility.h"
+
+#ifndef MAGNUM_TARGET_GLES
+namespace Magnum { namespace GL {
+
+/**
+@brief Asynchronous texture uploader
+@m_since_latest
+
+Stages image data into a pool of fixed-size slots in a persistently mapped
+pixel buffer and uploads them to textures from there, so the CPU-side copy
+can happen on worker threads and the GL thread only issues the
+buffer-to-texture copies. Meant for streaming large amounts of texture data,
+such as tiles of a virtual texture, without stalling the frame.
+
+@section GL-TextureUploader-usage Usage
+
+Worker threads call @ref stage() with the target texture, its mip level and
+offset and the image to upload. It copies the data into a free slot and
+returns an upload ID, or @relativeref{Corrade,Containers::NullOpt} if all
+slots are currently in use, in which case it's up to the worker to retry
+later. The GL thread periodically calls @ref update(), usually once a frame,
+which issues the copies staged so far and guards them with a fence:
+
+@snippet MagnumGL.cpp TextureUploader-usage
+
+The upload IDs are assigned in order the @ref stage() calls finish and the
+uploads are issued and completed in the same order. Checking for completion
+is thus a matter of comparing the ID with @ref completedCount(), which is
+done by @ref isComplete(). A slot is reused only after the fence guarding
+its upload is signaled, which is checked by @ref update() without waiting.
+Use @ref finish() to wait for all uploads to complete.
+
+The image data are copied including any padding described by its
+@ref PixelStorage and are then uploaded with the same pixel storage
+parameters. The image is thus expected to have no more than
+@ref slotSize() bytes of data.
+
+@section GL-TextureUploader-threads Thread safety
+
+The @ref stage(), @ref completedCount() and @ref isComplete() functions
+can be called from any thread, concurrently with each other and with
+functions called on the GL thread. Everything else, including construction
+and destruction, is expected to happen on the thread the GL context is
+current on. The target textures are only accessed during @ref update() and
+have to stay alive until the upload is issued.
+@requires_gl44 Extension @gl_extension{ARB,buffer_storage}
+@requires_gl Buffer storage is not available in OpenGL ES and WebGL.
+*/
+class MAGNUM_GL_EXPORT TextureUploader {
+    public:
+        /**
+         * @brief Constructor
+         * @param slotSize      Size of a single staging slot in bytes.
+         *      Expected to be non-zero.
+         * @param slotCount     Count of staging slots. Expected to be
+         *      non-zero.
+         *
+         * Creates a pixel unpack buffer of @cpp slotSize*slotCount @ce
+         * bytes with @ref Buffer::StorageFlag::MapWrite,
+         * @relativeref{Buffer::StorageFlag,MapPersistent} and
+         * @relativeref{Buffer::StorageFlag,MapCoherent} and maps it whole.
+         * The slot size gets rounded up to a multiple of @cpp 4 @ce bytes
+         * to keep the default pixel row alignment satisfied.
+         * @see @ref Buffer::setStorage(), @ref Buffer::map()
+         */
+        explicit TextureUploader(std::size_t slotSize, std::size_t slotCount);
+
+        /**
+         * @brief Construct without creating the underlying OpenGL object
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         *
+         * This function can be safely used for constructing (and later
+         * destructing) objects even without any OpenGL context being active.
+         * However note that this is a low-level and a potentially dangerous
+         * API, see the documentation of @ref NoCreate for alternatives.
+         */
+        explicit TextureUploader(NoCreateT) noexcept;
+
+        /** @brief Copying is not allowed */
+        TextureUploader(const TextureUploader&) = delete;
+
+        /** @brief Move constructor */
+        TextureUploader(TextureUploader&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Deletes all pending fences together with the buffer. Doesn't wait
+         * for the fences, uploads that are staged but not issued yet are
+         * discarded.
+         * @see @fn_gl_keyword{DeleteSync}
+         */
+        ~TextureUploader();
+
+        /** @brief Copying is not allowed */
+        TextureUploader& operator=(const TextureUploader&) = delete;
+
+        /** @brief Move assignment */
+        TextureUploader& operator=(TextureUploader&& other) noexcept;
+
+        /**
+         * @brief Underlying buffer
+         *
+         * Expects that the instance isn't in a moved-from state.
+         */
+        Buffer& buffer();
+
+        /** @brief Size of a single staging slot in bytes */
+        std::size_t slotSize() const;
+
+        /** @brief Count of staging slots */
+        std::size_t slotCount() const;
+
+        /**
+         * @brief Stage an image for upload
+         * @param texture   Target texture
+         * @param level     Mip level
+         * @param offset    Offset in the target texture
+         * @param image     Image to upload. Expected to have at most
+         *      @ref slotSize() bytes of data.
+         * @return Upload ID or @relativeref{Corrade,Containers::NullOpt} if
+         *      there's no free slot
+         *
+         * Copies the image data into a free slot and queues the upload to
+         * be issued on the next @ref update(). Can be called from any
+         * thread, the copy itself is done without holding any lock. The
+         * @p image is converted to a GL pixel format using
+         * @ref pixelFormat() and @ref pixelType() without touching the GL
+         * context.
+         * @see @ref isComplete()
+         */
+        Containers::Optional<UnsignedLong> stage(Texture2D& texture, Int level, const Vector2i& offset, const ImageView2D& image);
+
+        /**
+         * @brief Issue staged uploads and retire completed ones
+         * @return Reference to self (for method chaining)
+         *
+         * Frees slots of all uploads whose fence is already signaled,
+         * without waiting, then issues copies of all uploads staged since
+         * the last call and inserts a fence after them.
+         * @see @ref Texture::setSubImage(), @fn_gl_keyword{ClientWaitSync},
+         *      @fn_gl_keyword{FenceSync}
+         */
+        TextureUploader& update();
+
+        /**
+         * @brief Wait for all uploads to complete
+         * @return Reference to self (for method chaining)
+         *
+         * Calls @ref update() and then waits for all fences to be
+         * signaled. Uploads staged by other threads while this function
+         * runs are not waited for.
+         */
+        TextureUploader& finish();
+
+        /**
+         * @brief Count of uploads staged but not issued yet
+         *
+         * Can be called from any thread.
+         */
+        std::size_t pendingCount() const;
+
+        /**
+         * @brief Count of completed uploads
+         *
+         * All uploads with an ID less than this value are complete. Can be
+         * called from any thread.
+         */
+        UnsignedLong completedCount() const;
+
+        /**
+         * @brief Whether given upload is complete
+         *
+         * Equivalent to comparing @p upload with @ref completedCount(). Can
+         * be called from any thread.
+         */
+        bool isComplete(UnsignedLong upload) const {
+            return upload < completedCount();
+        }
+
+    private:
+        struct State;
+
+        MAGNUM_GL_LOCAL void retire(bool wait);
+
+        Containers::Pointer<State> _state;
+};
+
+}}
+#else
+#error this header is not available in OpenGL ES build
+#endif
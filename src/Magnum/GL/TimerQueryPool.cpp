@@ -0,0 +1,172 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "TimerQueryPool.h"
+
+#include <Corrade/Containers/StringView.h>
+
+namespace Magnum { namespace GL {
+
+TimerQueryPool::TimerQueryPool(const UnsignedInt frameCount, const UnsignedInt maxScopeCount): _frameCount{frameCount}, _maxScopeCount{maxScopeCount} {
+    CORRADE_ASSERT(frameCount && maxScopeCount,
+        "GL::TimerQueryPool: expected non-zero frame and scope count but got" << frameCount << "and" << maxScopeCount, );
+
+    _queries = Containers::Array<TimeQuery>{DirectInit, std::size_t{frameCount}*maxScopeCount, TimeQuery::Target::TimeElapsed};
+    _queryScopes = Containers::Array<UnsignedInt>{NoInit, std::size_t{frameCount}*maxScopeCount};
+    _queryCounts = Containers::Array<UnsignedInt>{ValueInit, frameCount};
+    _scopeNames = Containers::Array<Containers::String>{ValueInit, maxScopeCount};
+    _durations = Containers::Array<UnsignedLong>{ValueInit, maxScopeCount};
+}
+
+TimerQueryPool::TimerQueryPool(NoCreateT) noexcept {}
+
+Containers::StringView TimerQueryPool::scopeName(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _scopeCount,
+        "GL::TimerQueryPool::scopeName(): index" << id << "out of range for" << _scopeCount << "scopes", {});
+    return _scopeNames[id];
+}
+
+Containers::Optional<UnsignedInt> TimerQueryPool::findScope(const Containers::StringView name) const {
+    for(UnsignedInt i = 0; i != _scopeCount; ++i)
+        if(_scopeNames[i] == name) return i;
+    return {};
+}
+
+UnsignedInt TimerQueryPool::addScope(const Containers::StringView name) {
+    if(const Containers::Optional<UnsignedInt> found = findScope(name))
+        return *found;
+
+    CORRADE_ASSERT(_scopeCount < _maxScopeCount,
+        "GL::TimerQueryPool::addScope(): can't add" << name << Debug::nospace << ", only" << _maxScopeCount << "scopes allowed", ~UnsignedInt{});
+    _scopeNames[_scopeCount] = Containers::String{name};
+    return _scopeCount++;
+}
+
+void TimerQueryPool::beginFrame() {
+    CORRADE_ASSERT(!_inFrame,
+        "GL::TimerQueryPool::beginFrame(): frame already begun", );
+
+    retrieve();
+
+    /* The GPU is lagging too much and all slots are still in flight. Drop the
+       oldest frame instead of waiting for it. */
+    if(_frame - _pendingFrame == _frameCount) {
+        ++_pendingFrame;
+        ++_droppedFrameCount;
+    }
+
+    _queryCounts[_frame % _frameCount] = 0;
+    _inFrame = true;
+}
+
+void TimerQueryPool::begin(const Containers::StringView name) {
+    CORRADE_ASSERT(_inFrame,
+        "GL::TimerQueryPool::begin(): no frame begun", );
+    CORRADE_ASSERT(!_inScope,
+        "GL::TimerQueryPool::begin(): scope" << _scopeNames[_queryScopes[(_frame % _frameCount)*_maxScopeCount + _queryCounts[_frame % _frameCount]]] << "is already active, time elapsed queries can't be nested", );
+
+    const std::size_t frame = _frame % _frameCount;
+    CORRADE_ASSERT(_queryCounts[frame] < _maxScopeCount,
+        "GL::TimerQueryPool::begin(): only" << _maxScopeCount << "scopes allowed in a frame", );
+
+    const UnsignedInt id = addScope(name);
+    #ifdef CORRADE_GRACEFUL_ASSERT
+    if(id == ~UnsignedInt{}) return;
+    #endif
+
+    const std::size_t query = frame*_maxScopeCount + _queryCounts[frame];
+    _queryScopes[query] = id;
+    _queries[query].begin();
+    _inScope = true;
+}
+
+void TimerQueryPool::end() {
+    CORRADE_ASSERT(_inScope,
+        "GL::TimerQueryPool::end(): no scope begun", );
+
+    const std::size_t frame = _frame % _frameCount;
+    _queries[frame*_maxScopeCount + _queryCounts[frame]++].end();
+    _inScope = false;
+}
+
+void TimerQueryPool::endFrame() {
+    CORRADE_ASSERT(_inFrame,
+        "GL::TimerQueryPool::endFrame(): no frame begun", );
+    CORRADE_ASSERT(!_inScope,
+        "GL::TimerQueryPool::endFrame(): scope" << _scopeNames[_queryScopes[(_frame % _frameCount)*_maxScopeCount + _queryCounts[_frame % _frameCount]]] << "not ended", );
+
+    ++_frame;
+    _inFrame = false;
+
+    retrieve();
+}
+
+void TimerQueryPool::retrieve() {
+    /* Go from the oldest frame and stop at the first one that isn't finished
+       yet, as the results are always expected to arrive in order */
+    for(; _pendingFrame != _frame; ++_pendingFrame) {
+        const std::size_t frame = _pendingFrame % _frameCount;
+        const Containers::ArrayView<TimeQuery> queries = _queries.slice(frame*_maxScopeCount, frame*_maxScopeCount + _queryCounts[frame]);
+
+        /* Checking availability doesn't wait for the GPU. Go from the last
+           query, which is most likely to be not done yet. */
+        bool available = true;
+        for(std::size_t i = queries.size(); i != 0; --i) {
+            if(!queries[i - 1].resultAvailable()) {
+                available = false;
+                break;
+            }
+        }
+        if(!available) break;
+
+        /* Scopes that weren't entered in this frame have zero duration */
+        for(UnsignedLong& duration: _durations) duration = 0;
+        for(std::size_t i = 0; i != queries.size(); ++i)
+            _durations[_queryScopes[frame*_maxScopeCount + i]] += queries[i].result<UnsignedLong>();
+
+        _resultFrame = _pendingFrame;
+        _hasResults = true;
+    }
+}
+
+UnsignedLong TimerQueryPool::resultFrame() const {
+    CORRADE_ASSERT(_hasResults,
+        "GL::TimerQueryPool::resultFrame(): no results available yet", {});
+    return _resultFrame;
+}
+
+UnsignedLong TimerQueryPool::duration(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _scopeCount,
+        "GL::TimerQueryPool::duration(): index" << id << "out of range for" << _scopeCount << "scopes", {});
+    return _durations[id];
+}
+
+Containers::Optional<UnsignedLong> TimerQueryPool::duration(const Containers::StringView name) const {
+    if(const Containers::Optional<UnsignedInt> found = findScope(name))
+        return _durations[*found];
+    return {};
+}
+
+}}
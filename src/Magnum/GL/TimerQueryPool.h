@@ -0,0 +1,287 @@
+#ifndef Magnum_GL_TimerQueryPool_h
+#define Magnum_GL_TimerQueryPool_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::GL::TimerQueryPool
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/String.h>
+
+#include "Magnum/Tags.h"
+#include "Magnum/GL/TimeQuery.h"
+
+namespace Magnum { namespace GL {
+
+/**
+@brief Pool of timer queries for named per-frame scopes
+@m_since_latest
+
+Measures GPU duration of named scopes in a frame using
+@ref TimeQuery::Target::TimeElapsed queries. Queries of up to @ref frameCount()
+frames are kept in flight and results of a frame are retrieved only after
+@ref TimeQuery::resultAvailable() reports all of them as available, so
+reading the results never stalls the pipeline. The scopes are delimited with
+@ref begin() and @ref end() calls between @ref beginFrame() and
+@ref endFrame():
+
+@snippet MagnumGL.cpp TimerQueryPool-usage
+
+Each distinct scope name gets an ID on first use, or explicitly via
+@ref addScope(). The @ref duration() then returns the GPU time spent in a
+scope in the most recent frame that has results available, with
+@ref resultFrame() telling which frame that was. A scope that's entered
+multiple times in a single frame has the durations summed, a scope that wasn't
+entered at all in given frame has a zero duration. All times are reported in
+nanoseconds.
+
+If the GPU lags more than @ref frameCount() frames behind, queries of the
+oldest frame are reused without waiting for their results, which is counted in
+@ref droppedFrameCount(). Increase the frame count if this happens regularly.
+
+@section GL-TimerQueryPool-profiler Usage with the frame profiler
+
+The durations can be fed into a @ref DebugTools::FrameProfiler using
+@ref DebugTools::timerQueryPoolMeasurement(). As the results are already
+delayed by the pool itself, the measurement is an immediate one, taking the
+latest available value in each frame.
+
+@section GL-TimerQueryPool-limitations Limitations
+
+As time elapsed queries can't be nested, there can be at most one scope active
+at a time. Because of the same reason, the pool can't be combined with
+@ref DebugTools::FrameProfilerGL::Value::GpuDuration, which measures the
+whole frame with a single query.
+
+@requires_gl33 Extension @gl_extension{ARB,timer_query}
+@requires_es_extension Extension @gl_extension{EXT,disjoint_timer_query}
+@requires_webgl_extension Extension @webgl_extension{EXT,disjoint_timer_query}
+    on WebGL 1, @gl_extension{EXT,disjoint_timer_query_webgl2} on WebGL 2
+@see @ref DebugTools::FrameProfilerGL
+*/
+class MAGNUM_GL_EXPORT TimerQueryPool {
+    public:
+        /**
+         * @brief Constructor
+         * @param frameCount    Count of frames in flight
+         * @param maxScopeCount Max count of distinct scopes and also max
+         *      count of @ref begin() / @ref end() pairs in a single frame
+         *
+         * Creates @p frameCount times @p maxScopeCount query objects.
+         * Expects that both @p frameCount and @p maxScopeCount are non-zero.
+         * A frame count of @cpp 3 @ce is usually enough to not have to wait
+         * for any results.
+         */
+        explicit TimerQueryPool(UnsignedInt frameCount = 3, UnsignedInt maxScopeCount = 16);
+
+        /**
+         * @brief Construct without creating the underlying OpenGL objects
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         *
+         * This function can be safely used for constructing (and later
+         * destructing) objects even without any OpenGL context being active.
+         * However note that this is a low-level and a potentially dangerous
+         * API, see the documentation of @ref NoCreate for alternatives.
+         */
+        explicit TimerQueryPool(NoCreateT) noexcept;
+
+        /** @brief Copying is not allowed */
+        TimerQueryPool(const TimerQueryPool&) = delete;
+
+        /** @brief Move constructor */
+        TimerQueryPool(TimerQueryPool&&) noexcept = default;
+
+        /** @brief Copying is not allowed */
+        TimerQueryPool& operator=(const TimerQueryPool&) = delete;
+
+        /** @brief Move assignment */
+        TimerQueryPool& operator=(TimerQueryPool&&) noexcept = default;
+
+        /** @brief Count of frames in flight */
+        UnsignedInt frameCount() const { return _frameCount; }
+
+        /** @brief Max count of scopes */
+        UnsignedInt maxScopeCount() const { return _maxScopeCount; }
+
+        /**
+         * @brief Count of scopes
+         *
+         * Count of distinct scope names passed to @ref begin() or
+         * @ref addScope() so far.
+         */
+        UnsignedInt scopeCount() const { return _scopeCount; }
+
+        /**
+         * @brief Scope name
+         *
+         * Expects that @p id is less than @ref scopeCount().
+         */
+        Containers::StringView scopeName(UnsignedInt id) const;
+
+        /**
+         * @brief Find a scope ID
+         *
+         * Returns @ref Containers::NullOpt if no scope of given name was
+         * added yet.
+         * @see @ref addScope()
+         */
+        Containers::Optional<UnsignedInt> findScope(Containers::StringView name) const;
+
+        /**
+         * @brief Add a scope
+         *
+         * If a scope of given name already exists, returns its ID, otherwise
+         * adds a new one. Expects that @ref scopeCount() is less than
+         * @ref maxScopeCount() when adding a new scope. Useful for setting up
+         * the scopes upfront, for example for
+         * @ref DebugTools::timerQueryPoolMeasurement().
+         * @see @ref findScope()
+         */
+        UnsignedInt addScope(Containers::StringView name);
+
+        /**
+         * @brief Begin a frame
+         *
+         * Retrieves results of all finished frames. If all @ref frameCount()
+         * frames are still in flight, the oldest one is dropped and its
+         * queries are reused. Expects that a frame isn't already begun.
+         * @see @ref droppedFrameCount()
+         */
+        void beginFrame();
+
+        /**
+         * @brief Begin a scope
+         *
+         * Adds the scope using @ref addScope() if it doesn't exist yet and
+         * begins a time elapsed query. Expects that it's called between
+         * @ref beginFrame() and @ref endFrame(), that no other scope is
+         * active and that there was less than @ref maxScopeCount() scopes
+         * begun in this frame.
+         */
+        void begin(Containers::StringView name);
+
+        /**
+         * @brief End a scope
+         *
+         * Expects that a scope was begun with @ref begin().
+         */
+        void end();
+
+        /**
+         * @brief End a frame
+         *
+         * Retrieves results of all finished frames, including the current one
+         * if it's done already. Expects that @ref beginFrame() was called
+         * before and there's no scope active.
+         */
+        void endFrame();
+
+        /**
+         * @brief Count of frames ended with @ref endFrame() so far
+         */
+        UnsignedLong measuredFrameCount() const { return _frame; }
+
+        /**
+         * @brief Whether any results are available
+         *
+         * Returns @cpp false @ce until results of at least one frame are
+         * retrieved.
+         * @see @ref resultFrame()
+         */
+        bool hasResults() const { return _hasResults; }
+
+        /**
+         * @brief Frame the results are from
+         *
+         * Zero-based index of the frame, i.e. @ref measuredFrameCount()
+         * minus this value is the actual latency of the results. Expects that
+         * @ref hasResults() is @cpp true @ce.
+         */
+        UnsignedLong resultFrame() const;
+
+        /**
+         * @brief Count of frames dropped without retrieving their results
+         *
+         * @see @ref beginFrame()
+         */
+        UnsignedLong droppedFrameCount() const { return _droppedFrameCount; }
+
+        /**
+         * @brief Scope duration
+         *
+         * Time spent in given scope in frame @ref resultFrame(), in
+         * nanoseconds. Returns @cpp 0 @ce if @ref hasResults() is
+         * @cpp false @ce. Expects that @p id is less than
+         * @ref scopeCount().
+         * @see @ref durations()
+         */
+        UnsignedLong duration(UnsignedInt id) const;
+
+        /**
+         * @brief Scope duration for a scope name
+         *
+         * Returns @ref Containers::NullOpt if there's no scope of given name,
+         * otherwise behaves the same as @ref duration(UnsignedInt) const.
+         */
+        Containers::Optional<UnsignedLong> duration(Containers::StringView name) const;
+
+        /**
+         * @brief Durations of all scopes
+         *
+         * Indexed by scope ID, size is @ref maxScopeCount(). The memory is
+         * allocated upfront and doesn't change location during the lifetime
+         * of the pool, including moves, so it's possible to keep a pointer
+         * to a particular value.
+         */
+        Containers::ArrayView<const UnsignedLong> durations() const { return _durations; }
+
+    private:
+        void retrieve();
+
+        UnsignedInt _frameCount{}, _maxScopeCount{}, _scopeCount{};
+        /* Frame-major, _maxScopeCount queries for each of _frameCount frames.
+           _queryScopes contain a scope ID for each used query, _queryCounts
+           how many queries are used in each frame. */
+        Containers::Array<TimeQuery> _queries;
+        Containers::Array<UnsignedInt> _queryScopes;
+        Containers::Array<UnsignedInt> _queryCounts;
+        Containers::Array<Containers::String> _scopeNames;
+        Containers::Array<UnsignedLong> _durations;
+        /* Index of the current frame and the oldest frame for which results
+           weren't retrieved yet */
+        UnsignedLong _frame{}, _pendingFrame{}, _resultFrame{}, _droppedFrameCount{};
+        bool _inFrame{}, _inScope{}, _hasResults{};
+};
+
+}}
+
+#endif
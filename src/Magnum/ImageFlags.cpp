@@ -55,6 +55,7 @@ Debug& operator<<(Debug& debug, const ImageFlag2D value) {
         /* LCOV_EXCL_START */
         #define _c(value) case ImageFlag2D::value: return debug << (packed ? "" : "::") << Debug::nospace << #value;
         _c(Array)
+        _c(YDown)
         #undef _c
         /* LCOV_EXCL_STOP */
     }
@@ -73,6 +74,7 @@ Debug& operator<<(Debug& debug, const ImageFlag3D value) {
         #define _c(value) case ImageFlag3D::value: return debug << (packed ? "" : "::") << Debug::nospace << #value;
         _c(Array)
         _c(CubeMap)
+        _c(YDown)
         #undef _c
         /* LCOV_EXCL_STOP */
     }
@@ -87,14 +89,16 @@ Debug& operator<<(Debug& debug, const ImageFlags1D value) {
 
 Debug& operator<<(Debug& debug, const ImageFlags2D value) {
     return Containers::enumSetDebugOutput(debug, value, debug.immediateFlags() >= Debug::Flag::Packed ? "{}" : "ImageFlags2D{}", {
-        ImageFlag2D::Array
+        ImageFlag2D::Array,
+        ImageFlag2D::YDown
     });
 }
 
 Debug& operator<<(Debug& debug, const ImageFlags3D value) {
     return Containers::enumSetDebugOutput(debug, value, debug.immediateFlags() >= Debug::Flag::Packed ? "{}" : "ImageFlags3D{}", {
         ImageFlag3D::Array,
-        ImageFlag3D::CubeMap
+        ImageFlag3D::CubeMap,
+        ImageFlag3D::YDown
     });
 }
 
@@ -62,6 +62,19 @@ enum class ImageFlag2D: UnsignedShort {
      * Guaranteed to have the same value as @ref ImageFlag3D::Array.
      */
     Array = 1 << 0,
+
+    /**
+     * The image rows are stored top-down instead of the bottom-up order
+     * Magnum and OpenGL use, i.e. the first row in memory is the top row of
+     * the image. Used for example by importers that reference file data
+     * directly without flipping them, see @ref Trade::TgaImporter for an
+     * example. The data can be flipped with @ref flipImageY(), the flag is
+     * then expected to be removed.
+     *
+     * Guaranteed to have the same value as @ref ImageFlag3D::YDown.
+     * @m_since_latest
+     */
+    YDown = 1 << 2
 };
 
 /**
@@ -88,7 +101,17 @@ enum class ImageFlag3D: UnsignedShort {
      * exact multiple of six square 2D faces, with each six layers being one
      * cube map.
      */
-    CubeMap = 1 << 1
+    CubeMap = 1 << 1,
+
+    /**
+     * The image rows in each slice are stored top-down instead of the
+     * bottom-up order Magnum and OpenGL use. See @ref ImageFlag2D::YDown for
+     * more information.
+     *
+     * Guaranteed to have the same value as @ref ImageFlag2D::YDown.
+     * @m_since_latest
+     */
+    YDown = 1 << 2
 };
 
 /** @debugoperatorenum{ImageFlag1D} */
@@ -0,0 +1,213 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ImageOperations.h"
+
+#include <cstring>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Implementation/parallelFor.h"
+#include "Magnum/Math/Range.h"
+
+#ifdef CORRADE_TARGET_SSE2
+#include <emmintrin.h>
+#elif defined(CORRADE_TARGET_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace Magnum {
+
+namespace {
+
+/* Images with less data than this are always processed on the calling
+   thread. The operations are mostly memory-bound so the threshold is rather
+   high. */
+constexpr std::size_t ParallelByteCount = 4*1024*1024;
+
+inline UnsignedInt threadCountFor(const std::size_t byteCount, const UnsignedInt threadCount) {
+    return byteCount >= ParallelByteCount ? threadCount : 1;
+}
+
+template<class T> ImageView<2, T> cropImageImplementation(const ImageView<2, T>& image, const Range2Di& range) {
+    CORRADE_ASSERT(Range2Di{{}, image.size()}.contains(range),
+        "cropImage(): range" << Debug::packed << range.min() << "to" << Debug::packed << range.max() << "out of bounds for an image of size" << Debug::packed << image.size(),
+        (ImageView<2, T>{image.storage(), image.format(), image.formatExtra(), image.pixelSize(), {}, image.data(), image.flags()}));
+
+    /* The row length has to be set explicitly, otherwise it'd be implicitly
+       taken from the new size */
+    PixelStorage storage = image.storage();
+    if(!storage.rowLength()) storage.setRowLength(image.size().x());
+    storage.setSkip(storage.skip() + Vector3i{range.min(), 0});
+    return ImageView<2, T>{storage, image.format(), image.formatExtra(), image.pixelSize(), range.size(), image.data(), image.flags()};
+}
+
+/* Vectorized kernel for extracting a channel out of a contiguous run of 8-bit
+   pixels. Returns the count of pixels it processed, the remainder (or
+   everything, if there's no specialization for given channel count or
+   platform) is then handled by the scalar loop in extractChannelRow(). */
+#ifdef CORRADE_TARGET_SSE2
+std::size_t extractChannelKernel(const UnsignedByte* const src, const UnsignedInt channelCount, const UnsignedInt channel, UnsignedByte* const dst, const std::size_t count) {
+    /* Only four-channel pixels map to 32-bit lanes, the channel is shifted to
+       the lowest byte of each and then the lanes get packed together */
+    if(channelCount != 4) return 0;
+
+    const __m128i byte = _mm_set1_epi32(0xff);
+    const __m128i shift = _mm_cvtsi32_si128(Int(channel*8));
+    std::size_t i = 0;
+    for(; i + 16 <= count; i += 16) {
+        const __m128i a = _mm_and_si128(_mm_srl_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i*4)), shift), byte);
+        const __m128i b = _mm_and_si128(_mm_srl_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i*4 + 16)), shift), byte);
+        const __m128i c = _mm_and_si128(_mm_srl_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i*4 + 32)), shift), byte);
+        const __m128i d = _mm_and_si128(_mm_srl_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i*4 + 48)), shift), byte);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d)));
+    }
+    return i;
+}
+#elif defined(CORRADE_TARGET_NEON)
+std::size_t extractChannelKernel(const UnsignedByte* const src, const UnsignedInt channelCount, const UnsignedInt channel, UnsignedByte* const dst, const std::size_t count) {
+    std::size_t i = 0;
+    if(channelCount == 4) {
+        for(; i + 16 <= count; i += 16)
+            vst1q_u8(dst + i, vld4q_u8(src + i*4).val[channel]);
+    } else if(channelCount == 3) {
+        for(; i + 16 <= count; i += 16)
+            vst1q_u8(dst + i, vld3q_u8(src + i*3).val[channel]);
+    }
+    return i;
+}
+#else
+std::size_t extractChannelKernel(const UnsignedByte*, UnsignedInt, UnsignedInt, UnsignedByte*, std::size_t) { return 0; }
+#endif
+
+template<class T> void extractChannelRowScalar(const char* const src, const std::ptrdiff_t srcStride, char* const dst, const std::ptrdiff_t dstStride, const std::size_t count) {
+    for(std::size_t i = 0; i != count; ++i)
+        *reinterpret_cast<T*>(dst + std::ptrdiff_t(i)*dstStride) = *reinterpret_cast<const T*>(src + std::ptrdiff_t(i)*srcStride);
+}
+
+void extractChannelRow(const Containers::StridedArrayView2D<const char>& src, const UnsignedInt channelCount, const UnsignedInt channel, const UnsignedInt channelSize, const Containers::StridedArrayView2D<char>& dst) {
+    const std::size_t count = src.size()[0];
+    const char* const srcData = static_cast<const char*>(src.data());
+    char* const dstData = static_cast<char*>(dst.data());
+    const std::ptrdiff_t srcStride = src.stride()[0];
+    const std::ptrdiff_t dstStride = dst.stride()[0];
+
+    if(channelSize == 1) {
+        std::size_t i = 0;
+        if(srcStride == std::ptrdiff_t(channelCount) && dstStride == 1)
+            i = extractChannelKernel(reinterpret_cast<const UnsignedByte*>(srcData), channelCount, channel, reinterpret_cast<UnsignedByte*>(dstData), count);
+        extractChannelRowScalar<UnsignedByte>(srcData + std::ptrdiff_t(i)*srcStride + channel, srcStride, dstData + std::ptrdiff_t(i)*dstStride, dstStride, count - i);
+    } else if(channelSize == 2) {
+        extractChannelRowScalar<UnsignedShort>(srcData + channel*2, srcStride, dstData, dstStride, count);
+    } else {
+        CORRADE_INTERNAL_ASSERT(channelSize == 4);
+        extractChannelRowScalar<UnsignedInt>(srcData + channel*4, srcStride, dstData, dstStride, count);
+    }
+}
+
+}
+
+void copyImage(const ImageView2D& src, const MutableImageView2D& dst, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "copyImage(): expected images of the same size, got" << Debug::packed << src.size() << "and" << Debug::packed << dst.size(), );
+    CORRADE_ASSERT(src.format() == dst.format() && src.formatExtra() == dst.formatExtra() && src.pixelSize() == dst.pixelSize(),
+        "copyImage(): expected images of the same format, got" << src.format() << "and" << dst.format(), );
+
+    const Containers::StridedArrayView3D<const char> srcPixels = src.pixels();
+    const Containers::StridedArrayView3D<char> dstPixels = dst.pixels();
+    const std::size_t rowSize = std::size_t(src.size().x())*src.pixelSize();
+    /* If rows in both images are tightly packed, whole ranges of rows can be
+       copied at once */
+    const bool contiguous = srcPixels.isContiguous() && dstPixels.isContiguous();
+    Implementation::parallelFor(srcPixels.size()[0], threadCountFor(rowSize*srcPixels.size()[0], threadCount), [&](const std::size_t begin, const std::size_t end) {
+        if(begin == end) return;
+
+        if(contiguous)
+            std::memcpy(dstPixels[begin].data(), srcPixels[begin].data(), (end - begin)*rowSize);
+        else for(std::size_t i = begin; i != end; ++i)
+            std::memcpy(dstPixels[i].data(), srcPixels[i].data(), rowSize);
+    });
+}
+
+Image2D copyImage(const ImageView2D& src, const PixelStorage& storage, const UnsignedInt threadCount) {
+    /* Temporary image without data to calculate the data size */
+    const std::size_t dataSize = Implementation::imageDataSizeFor(Image2D{storage, src.format(), src.formatExtra(), src.pixelSize()}, src.size());
+    Image2D out{storage, src.format(), src.formatExtra(), src.pixelSize(), src.size(), Containers::Array<char>{NoInit, dataSize}, src.flags()};
+    copyImage(src, out, threadCount);
+    return out;
+}
+
+ImageView2D cropImage(const ImageView2D& image, const Range2Di& range) {
+    return cropImageImplementation(image, range);
+}
+
+MutableImageView2D cropImage(const MutableImageView2D& image, const Range2Di& range) {
+    return cropImageImplementation(image, range);
+}
+
+void flipImageY(const MutableImageView2D& image, const UnsignedInt threadCount) {
+    const Containers::StridedArrayView3D<char> pixels = image.pixels();
+    const std::size_t height = pixels.size()[0];
+    const std::size_t rowSize = std::size_t(image.size().x())*image.pixelSize();
+    Implementation::parallelFor(height/2, threadCountFor(rowSize*height, threadCount), [&](const std::size_t begin, const std::size_t end) {
+        if(begin == end) return;
+
+        Containers::Array<char> row{NoInit, rowSize};
+        for(std::size_t i = begin; i != end; ++i) {
+            char* const a = static_cast<char*>(pixels[i].data());
+            char* const b = static_cast<char*>(pixels[height - i - 1].data());
+            std::memcpy(row, a, rowSize);
+            std::memcpy(a, b, rowSize);
+            std::memcpy(b, row, rowSize);
+        }
+    });
+}
+
+void extractImageChannel(const ImageView2D& src, const UnsignedInt channel, const MutableImageView2D& dst, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "extractImageChannel(): expected images of the same size, got" << Debug::packed << src.size() << "and" << Debug::packed << dst.size(), );
+    CORRADE_ASSERT(!isPixelFormatImplementationSpecific(src.format()) && !isPixelFormatDepthOrStencil(src.format()),
+        "extractImageChannel(): can't extract a channel from" << src.format(), );
+    const UnsignedInt channelCount = pixelFormatChannelCount(src.format());
+    CORRADE_ASSERT(channel < channelCount,
+        "extractImageChannel(): index" << channel << "out of range for" << channelCount << "channels in" << src.format(), );
+    const UnsignedInt channelSize = pixelFormatSize(pixelFormatChannelFormat(src.format()));
+    CORRADE_ASSERT(dst.pixelSize() == channelSize,
+        "extractImageChannel(): expected destination pixel size to be" << channelSize << "but got" << dst.pixelSize(), );
+
+    const Containers::StridedArrayView3D<const char> srcPixels = src.pixels();
+    const Containers::StridedArrayView3D<char> dstPixels = dst.pixels();
+    Implementation::parallelFor(srcPixels.size()[0], threadCountFor(std::size_t(src.size().product())*src.pixelSize(), threadCount), [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t i = begin; i != end; ++i)
+            extractChannelRow(srcPixels[i], channelCount, channel, channelSize, dstPixels[i]);
+    });
+}
+
+}
@@ -0,0 +1,130 @@
+#ifndef Magnum_ImageOperations_h
+#define Magnum_ImageOperations_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::copyImage(), @ref Magnum::cropImage(), @ref Magnum::flipImageY(), @ref Magnum::extractImageChannel()
+ * @m_since_latest
+ */
+
+#include "Magnum/Magnum.h"
+#include "Magnum/PixelStorage.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum {
+
+/**
+@brief Copy image pixels
+@param src          Source image
+@param dst          Destination image
+@param threadCount  Max count of threads to use. If @cpp 0 @ce,
+    @ref TaskScheduler::threadCount() of @ref TaskScheduler::global() is used.
+@m_since_latest
+
+Expects that both images have the same size, format and pixel size, but they
+can differ in @ref PixelStorage, allowing for example to change row alignment
+or to copy a subrange of a larger image made with @ref cropImage(). If rows in
+both images are tightly packed, the whole range is copied at once, otherwise
+row by row. The views are expected to not overlap. Use @ref convertPixels() to
+copy between different pixel formats.
+
+Images with more than a few megabytes of data are copied on up to
+@p threadCount threads, split by rows. If Corrade isn't built with
+@ref CORRADE_BUILD_MULTITHREADED or when targeting
+@ref CORRADE_TARGET_EMSCRIPTEN "Emscripten", the @p threadCount parameter is
+ignored and everything is done on the calling thread.
+*/
+MAGNUM_EXPORT void copyImage(const ImageView2D& src, const MutableImageView2D& dst, UnsignedInt threadCount = 0);
+
+/**
+@brief Copy image pixels to a new image
+@m_since_latest
+
+Allocates a new image with the same format and size as @p src and given
+@p storage and calls
+@ref copyImage(const ImageView2D&, const MutableImageView2D&, UnsignedInt) on
+it. Useful for example to get a tightly packed copy of a cropped image:
+
+@snippet Magnum.cpp cropImage
+*/
+MAGNUM_EXPORT Image2D copyImage(const ImageView2D& src, const PixelStorage& storage = {}, UnsignedInt threadCount = 0);
+
+/**
+@brief Crop an image
+@m_since_latest
+
+Returns a view on @p range of @p image, with @ref PixelStorage::skip() and
+@ref PixelStorage::rowLength() adjusted to reference the original data. No
+data are copied, use @ref copyImage() to make a copy of the cropped view.
+Expects that @p range is contained in the image.
+*/
+MAGNUM_EXPORT ImageView2D cropImage(const ImageView2D& image, const Range2Di& range);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_EXPORT MutableImageView2D cropImage(const MutableImageView2D& image, const Range2Di& range);
+
+/**
+@brief Flip an image upside down in-place
+@param image        Image to flip
+@param threadCount  Max count of threads to use. If @cpp 0 @ce,
+    @ref TaskScheduler::threadCount() of @ref TaskScheduler::global() is used.
+@m_since_latest
+
+Swaps the rows, which is useful for example for converting between
+top-down image data and the bottom-up convention used by Magnum and OpenGL.
+Multithreading behaves the same as in
+@ref copyImage(const ImageView2D&, const MutableImageView2D&, UnsignedInt).
+*/
+MAGNUM_EXPORT void flipImageY(const MutableImageView2D& image, UnsignedInt threadCount = 0);
+
+/**
+@brief Extract a single channel of an image
+@param src          Source image
+@param channel      Channel index
+@param dst          Destination image
+@param threadCount  Max count of threads to use. If @cpp 0 @ce,
+    @ref TaskScheduler::threadCount() of @ref TaskScheduler::global() is used.
+@m_since_latest
+
+Expects that both images have the same size, the source format is not
+implementation-specific or depth/stencil, @p channel is less than its
+@ref pixelFormatChannelCount() and the destination pixel size matches the
+size of a single channel. The destination format itself isn't checked, so
+it's possible to for example extract linear alpha out of a
+@ref PixelFormat::RGBA8Srgb image into a @ref PixelFormat::R8Unorm image.
+Extracting a channel out of three- and four-channel 8-bit images is
+vectorized using SSE2 or NEON if available. Multithreading behaves the same
+as in
+@ref copyImage(const ImageView2D&, const MutableImageView2D&, UnsignedInt).
+*/
+MAGNUM_EXPORT void extractImageChannel(const ImageView2D& src, UnsignedInt channel, const MutableImageView2D& dst, UnsignedInt threadCount = 0);
+
+}
+
+#endif
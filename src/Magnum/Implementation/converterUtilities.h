@@ -25,11 +25,16 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/StaticArray.h>
 #include <Corrade/PluginManager/AbstractPlugin.h>
 #include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/String.h>
+#if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+#include <atomic>
+#include <thread>
+#endif
 
 #include "Magnum/Magnum.h"
 
@@ -79,6 +84,48 @@ void setOptions(PluginManager::AbstractPlugin& plugin, const std::string& anyPlu
     }
 }
 
+/* Worker count for a --batch conversion, 0 means all available cores. Never
+   more than there are entries. */
+std::size_t batchWorkerCount(UnsignedInt jobs, const std::size_t entryCount) {
+    #if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+    if(!jobs) jobs = std::thread::hardware_concurrency();
+    #else
+    jobs = 1;
+    #endif
+    if(jobs > entryCount) jobs = UnsignedInt(entryCount);
+    return jobs ? jobs : 1;
+}
+
+/* Calls convert(worker, entry) for every entry on workerCount threads. Each
+   worker has its own plugin instances, indexed by the first argument. Files
+   can take vastly different time to convert, so instead of splitting the
+   entries into fixed chunks each worker picks the next unprocessed one. */
+template<class F> void runBatch(const std::size_t workerCount, const std::size_t entryCount, F convert) {
+    #if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+    if(workerCount > 1) {
+        std::atomic<std::size_t> next{0};
+        const auto worker = [&](const std::size_t workerId) {
+            for(std::size_t i; (i = next++) < entryCount; )
+                convert(workerId, i);
+        };
+
+        /* The calling thread does its share of the work as well */
+        Containers::Array<std::thread> threads{workerCount - 1};
+        for(std::size_t i = 0; i != threads.size(); ++i)
+            threads[i] = std::thread{worker, i + 1};
+        worker(0);
+        for(std::thread& thread: threads)
+            thread.join();
+        return;
+    }
+    #else
+    static_cast<void>(workerCount);
+    #endif
+
+    for(std::size_t i = 0; i != entryCount; ++i)
+        convert(0, i);
+}
+
 }
 
 }}
@@ -116,6 +116,42 @@ Enabled by default in a static build.
 #define MAGNUM_BUILD_STATIC_UNIQUE_GLOBALS
 #undef MAGNUM_BUILD_STATIC_UNIQUE_GLOBALS
 
+/**
+@brief Build with profiling scopes
+@m_since_latest
+
+Defined if potentially expensive operations in library code are marked with
+@ref MAGNUM_PROFILE_SCOPE(). Disabled by default.
+@see @ref ProfileScope, @ref building, @ref cmake
+*/
+#define MAGNUM_BUILD_PROFILING
+#undef MAGNUM_BUILD_PROFILING
+
+/**
+@brief Profiling scopes use Tracy
+@m_since_latest
+
+Defined if @ref MAGNUM_BUILD_PROFILING is enabled and the
+@ref MAGNUM_PROFILE_SCOPE() macros create [Tracy](https://github.com/wolfpld/tracy)
+zones instead of @ref ProfileScope instances.
+@see @ref MAGNUM_PROFILING_ITT, @ref building, @ref cmake
+*/
+#define MAGNUM_PROFILING_TRACY
+#undef MAGNUM_PROFILING_TRACY
+
+/**
+@brief Profiling scopes use Intel ITT
+@m_since_latest
+
+Defined if @ref MAGNUM_BUILD_PROFILING is enabled and the
+@ref MAGNUM_PROFILE_SCOPE() macros create [Intel ITT](https://github.com/intel/ittapi)
+tasks instead of @ref ProfileScope instances, which can be then viewed in
+VTune.
+@see @ref MAGNUM_PROFILING_TRACY, @ref building, @ref cmake
+*/
+#define MAGNUM_PROFILING_ITT
+#undef MAGNUM_PROFILING_ITT
+
 #ifdef MAGNUM_BUILD_DEPRECATED
 /** @brief Multi-threaded build
  * @m_deprecated_since{2019,10} Use @ref CORRADE_BUILD_MULTITHREADED instead.
@@ -1246,6 +1282,9 @@ template<class T> class CORRADE_DEPRECATED("use Math::Vector3 or Containers::Arr
 
 enum class InputFileCallbackPolicy: UnsignedByte;
 
+class FramePacer;
+class ProfileScope;
+
 enum class ImageFlag1D: UnsignedShort;
 enum class ImageFlag2D: UnsignedShort;
 enum class ImageFlag3D: UnsignedShort;
@@ -1283,6 +1322,9 @@ typedef BasicMutableCompressedImageView<1> MutableCompressedImageView1D;
 typedef BasicMutableCompressedImageView<2> MutableCompressedImageView2D;
 typedef BasicMutableCompressedImageView<3> MutableCompressedImageView3D;
 
+enum class TiledImageTileState: UnsignedByte;
+class TiledImage2D;
+
 enum class MeshPrimitive: UnsignedInt;
 enum class MeshIndexType: UnsignedInt;
 enum class VertexFormat: UnsignedInt;
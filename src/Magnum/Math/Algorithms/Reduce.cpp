@@ -0,0 +1,337 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Reduce.h"
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Implementation/parallelFor.h"
+
+#ifdef CORRADE_TARGET_SSE2
+#include <emmintrin.h>
+#elif defined(CORRADE_TARGET_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace Magnum { namespace Math { namespace Algorithms {
+
+namespace {
+
+/* The values are reduced in blocks of a fixed size and the per-block results
+   are then combined in order. As the block boundaries don't depend on the
+   thread count, neither does the result. */
+constexpr std::size_t BlockSize = 65536;
+
+/* Each thread gets at least this many blocks, so inputs where the thread
+   startup would cost more than the actual work stay on a single thread */
+constexpr std::size_t MinBlocksPerThread = 4;
+
+/* Below this size the pairwise summation accumulates directly */
+constexpr std::size_t PairwiseBaseSize = 128;
+
+/* Lane abstractions the kernels below are templated on. The SIMD variants
+   ignore the stride and are used only for contiguous views, ScalarLanes is
+   used for strided views and on platforms without SIMD, SingleLane for
+   remainders and for combining the lanes together. */
+template<class T> struct SingleLane {
+    enum: std::size_t { Size = 1 };
+    typedef T Type;
+
+    static Type zero() { return T(0); }
+    static Type splat(const T a) { return a; }
+    static Type load(const char* const data, std::ptrdiff_t) { return *reinterpret_cast<const T*>(data); }
+    static Type add(const Type a, const Type b) { return a + b; }
+    static Type sub(const Type a, const Type b) { return a - b; }
+    static Type mul(const Type a, const Type b) { return a*b; }
+    static void store(T* const out, const Type a) { *out = a; }
+};
+
+template<class T> struct ScalarLanes {
+    enum: std::size_t { Size = 4 };
+    struct Type { T v[Size]; };
+
+    static Type zero() { return Type{}; }
+    static Type splat(const T a) { return {{a, a, a, a}}; }
+    static Type load(const char* const data, const std::ptrdiff_t stride) {
+        return {{*reinterpret_cast<const T*>(data),
+                 *reinterpret_cast<const T*>(data + stride),
+                 *reinterpret_cast<const T*>(data + 2*stride),
+                 *reinterpret_cast<const T*>(data + 3*stride)}};
+    }
+    static Type add(const Type& a, const Type& b) {
+        return {{a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3]}};
+    }
+    static Type sub(const Type& a, const Type& b) {
+        return {{a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3]}};
+    }
+    static Type mul(const Type& a, const Type& b) {
+        return {{a.v[0]*b.v[0], a.v[1]*b.v[1], a.v[2]*b.v[2], a.v[3]*b.v[3]}};
+    }
+    static void store(T* const out, const Type& a) {
+        for(std::size_t i = 0; i != Size; ++i) out[i] = a.v[i];
+    }
+};
+
+template<class T> struct SimdLanes { typedef ScalarLanes<T> Type; };
+
+#ifdef CORRADE_TARGET_SSE2
+struct SseFloatLanes {
+    enum: std::size_t { Size = 4 };
+    typedef __m128 Type;
+
+    static Type zero() { return _mm_setzero_ps(); }
+    static Type splat(const Float a) { return _mm_set1_ps(a); }
+    static Type load(const char* const data, std::ptrdiff_t) { return _mm_loadu_ps(reinterpret_cast<const Float*>(data)); }
+    static Type add(const Type a, const Type b) { return _mm_add_ps(a, b); }
+    static Type sub(const Type a, const Type b) { return _mm_sub_ps(a, b); }
+    static Type mul(const Type a, const Type b) { return _mm_mul_ps(a, b); }
+    static void store(Float* const out, const Type a) { _mm_storeu_ps(out, a); }
+};
+
+struct SseDoubleLanes {
+    enum: std::size_t { Size = 2 };
+    typedef __m128d Type;
+
+    static Type zero() { return _mm_setzero_pd(); }
+    static Type splat(const Double a) { return _mm_set1_pd(a); }
+    static Type load(const char* const data, std::ptrdiff_t) { return _mm_loadu_pd(reinterpret_cast<const Double*>(data)); }
+    static Type add(const Type a, const Type b) { return _mm_add_pd(a, b); }
+    static Type sub(const Type a, const Type b) { return _mm_sub_pd(a, b); }
+    static Type mul(const Type a, const Type b) { return _mm_mul_pd(a, b); }
+    static void store(Double* const out, const Type a) { _mm_storeu_pd(out, a); }
+};
+
+template<> struct SimdLanes<Float> { typedef SseFloatLanes Type; };
+template<> struct SimdLanes<Double> { typedef SseDoubleLanes Type; };
+#elif defined(CORRADE_TARGET_NEON)
+struct NeonFloatLanes {
+    enum: std::size_t { Size = 4 };
+    typedef float32x4_t Type;
+
+    static Type zero() { return vdupq_n_f32(0.0f); }
+    static Type splat(const Float a) { return vdupq_n_f32(a); }
+    static Type load(const char* const data, std::ptrdiff_t) { return vld1q_f32(reinterpret_cast<const Float*>(data)); }
+    static Type add(const Type a, const Type b) { return vaddq_f32(a, b); }
+    static Type sub(const Type a, const Type b) { return vsubq_f32(a, b); }
+    static Type mul(const Type a, const Type b) { return vmulq_f32(a, b); }
+    static void store(Float* const out, const Type a) { vst1q_f32(out, a); }
+};
+
+template<> struct SimdLanes<Float> { typedef NeonFloatLanes Type; };
+
+/* Double-precision NEON is only on AArch64, 32-bit ARM uses ScalarLanes */
+#ifndef CORRADE_TARGET_32BIT
+struct NeonDoubleLanes {
+    enum: std::size_t { Size = 2 };
+    typedef float64x2_t Type;
+
+    static Type zero() { return vdupq_n_f64(0.0); }
+    static Type splat(const Double a) { return vdupq_n_f64(a); }
+    static Type load(const char* const data, std::ptrdiff_t) { return vld1q_f64(reinterpret_cast<const Double*>(data)); }
+    static Type add(const Type a, const Type b) { return vaddq_f64(a, b); }
+    static Type sub(const Type a, const Type b) { return vsubq_f64(a, b); }
+    static Type mul(const Type a, const Type b) { return vmulq_f64(a, b); }
+    static void store(Double* const out, const Type a) { vst1q_f64(out, a); }
+};
+
+template<> struct SimdLanes<Double> { typedef NeonDoubleLanes Type; };
+#endif
+#endif
+
+/* What gets accumulated for each item. The second view and the parameter are
+   used only by some of them. */
+struct Values {
+    template<class L, class T> static typename L::Type load(const char* const a, const std::ptrdiff_t aStride, const char*, std::ptrdiff_t, T) {
+        return L::load(a, aStride);
+    }
+};
+
+struct Products {
+    template<class L, class T> static typename L::Type load(const char* const a, const std::ptrdiff_t aStride, const char* const b, const std::ptrdiff_t bStride, T) {
+        return L::mul(L::load(a, aStride), L::load(b, bStride));
+    }
+};
+
+struct SquaredDeviations {
+    template<class L, class T> static typename L::Type load(const char* const a, const std::ptrdiff_t aStride, const char*, std::ptrdiff_t, const T mean) {
+        const typename L::Type d = L::sub(L::load(a, aStride), L::splat(mean));
+        return L::mul(d, d);
+    }
+};
+
+template<class L> inline void kahanAdd(typename L::Type& sum, typename L::Type& c, const typename L::Type value) {
+    const typename L::Type y = L::sub(value, c);
+    const typename L::Type t = L::add(sum, y);
+    c = L::sub(L::sub(t, sum), y);
+    sum = t;
+}
+
+template<class L, class Op, class T> T kahanBlock(const char* const a, const std::ptrdiff_t aStride, const char* const b, const std::ptrdiff_t bStride, const std::size_t count, const T param) {
+    /* Two independent accumulators to hide the latency of the dependency
+       chain in the compensation */
+    typename L::Type sum0 = L::zero(), c0 = L::zero(), sum1 = L::zero(), c1 = L::zero();
+    std::size_t i = 0;
+    for(; i + 2*L::Size <= count; i += 2*L::Size) {
+        const std::ptrdiff_t j = std::ptrdiff_t(i + L::Size);
+        kahanAdd<L>(sum0, c0, Op::template load<L>(a + std::ptrdiff_t(i)*aStride, aStride, b + std::ptrdiff_t(i)*bStride, bStride, param));
+        kahanAdd<L>(sum1, c1, Op::template load<L>(a + j*aStride, aStride, b + j*bStride, bStride, param));
+    }
+
+    /* Combine the lanes together with their compensations and then continue
+       with the remainder */
+    T sums[2*L::Size];
+    T cs[2*L::Size];
+    L::store(sums, sum0);
+    L::store(sums + L::Size, sum1);
+    L::store(cs, c0);
+    L::store(cs + L::Size, c1);
+    T sum = T(0), c = T(0);
+    for(std::size_t j = 0; j != 2*L::Size; ++j) {
+        kahanAdd<SingleLane<T>>(sum, c, sums[j]);
+        kahanAdd<SingleLane<T>>(sum, c, -cs[j]);
+    }
+    for(; i != count; ++i)
+        kahanAdd<SingleLane<T>>(sum, c, Op::template load<SingleLane<T>>(a + std::ptrdiff_t(i)*aStride, aStride, b + std::ptrdiff_t(i)*bStride, bStride, param));
+
+    return sum - c;
+}
+
+template<class L, class Op, class T> T pairwiseBlock(const char* const a, const std::ptrdiff_t aStride, const char* const b, const std::ptrdiff_t bStride, const std::size_t count, const T param) {
+    if(count > PairwiseBaseSize) {
+        const std::ptrdiff_t half = count/2;
+        return pairwiseBlock<L, Op, T>(a, aStride, b, bStride, half, param) +
+               pairwiseBlock<L, Op, T>(a + half*aStride, aStride, b + half*bStride, bStride, count - half, param);
+    }
+
+    typename L::Type lanes = L::zero();
+    std::size_t i = 0;
+    for(; i + L::Size <= count; i += L::Size)
+        lanes = L::add(lanes, Op::template load<L>(a + std::ptrdiff_t(i)*aStride, aStride, b + std::ptrdiff_t(i)*bStride, bStride, param));
+
+    T sums[L::Size];
+    L::store(sums, lanes);
+    T sum = T(0);
+    for(std::size_t j = 0; j != L::Size; ++j)
+        sum += sums[j];
+    for(; i != count; ++i)
+        sum += Op::template load<SingleLane<T>>(a + std::ptrdiff_t(i)*aStride, aStride, b + std::ptrdiff_t(i)*bStride, bStride, param);
+
+    return sum;
+}
+
+/* Ops that don't need the second view get the first one passed again */
+template<class Op, class T> T reduce(const Containers::StridedArrayView1D<const T>& a, const Containers::StridedArrayView1D<const T>& b, const T param, const bool kahan, const UnsignedInt threadCount) {
+    T(*block)(const char*, std::ptrdiff_t, const char*, std::ptrdiff_t, std::size_t, T);
+    if(a.isContiguous() && b.isContiguous()) {
+        if(kahan) block = kahanBlock<typename SimdLanes<T>::Type, Op, T>;
+        else block = pairwiseBlock<typename SimdLanes<T>::Type, Op, T>;
+    } else {
+        if(kahan) block = kahanBlock<ScalarLanes<T>, Op, T>;
+        else block = pairwiseBlock<ScalarLanes<T>, Op, T>;
+    }
+
+    const std::size_t count = a.size();
+    const std::size_t blockCount = (count + BlockSize - 1)/BlockSize;
+    Containers::Array<T> blockSums{NoInit, blockCount};
+
+    /* Caching values to avoid inline function calls in debug builds */
+    const char* const aData = static_cast<const char*>(a.data());
+    const char* const bData = static_cast<const char*>(b.data());
+    const std::ptrdiff_t aStride = a.stride();
+    const std::ptrdiff_t bStride = b.stride();
+    T* const blockSumsData = blockSums.data();
+    Magnum::Implementation::parallelFor((blockCount + MinBlocksPerThread - 1)/MinBlocksPerThread, threadCount, [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t i = begin*MinBlocksPerThread, iMax = Math::min(end*MinBlocksPerThread, blockCount); i < iMax; ++i) {
+            const std::ptrdiff_t offset = i*BlockSize;
+            blockSumsData[i] = block(aData + offset*aStride, aStride, bData + offset*bStride, bStride, Math::min(BlockSize, count - offset), param);
+        }
+    });
+
+    if(kahan) {
+        T sum = T(0), c = T(0);
+        for(const T blockSum: blockSums)
+            kahanAdd<SingleLane<T>>(sum, c, blockSum);
+        return sum - c;
+    }
+
+    const char* const blockSumsBytes = reinterpret_cast<const char*>(blockSumsData);
+    return pairwiseBlock<SingleLane<T>, Values, T>(blockSumsBytes, sizeof(T), blockSumsBytes, sizeof(T), blockCount, T(0));
+}
+
+template<class T> T dotImplementation(const Containers::StridedArrayView1D<const T>& a, const Containers::StridedArrayView1D<const T>& b, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(a.size() == b.size(),
+        "Math::Algorithms::dot(): expected views of the same size, got" << a.size() << "and" << b.size(), {});
+    return reduce<Products>(a, b, T(0), true, threadCount);
+}
+
+template<class T> T varianceImplementation(const Containers::StridedArrayView1D<const T>& values, const UnsignedInt threadCount) {
+    return reduce<SquaredDeviations>(values, values, mean(values, threadCount), true, threadCount)/T(values.size());
+}
+
+}
+
+Float kahanSum(const Containers::StridedArrayView1D<const Float>& values, const UnsignedInt threadCount) {
+    return reduce<Values>(values, values, 0.0f, true, threadCount);
+}
+
+Double kahanSum(const Containers::StridedArrayView1D<const Double>& values, const UnsignedInt threadCount) {
+    return reduce<Values>(values, values, 0.0, true, threadCount);
+}
+
+Float pairwiseSum(const Containers::StridedArrayView1D<const Float>& values, const UnsignedInt threadCount) {
+    return reduce<Values>(values, values, 0.0f, false, threadCount);
+}
+
+Double pairwiseSum(const Containers::StridedArrayView1D<const Double>& values, const UnsignedInt threadCount) {
+    return reduce<Values>(values, values, 0.0, false, threadCount);
+}
+
+Float dot(const Containers::StridedArrayView1D<const Float>& a, const Containers::StridedArrayView1D<const Float>& b, const UnsignedInt threadCount) {
+    return dotImplementation(a, b, threadCount);
+}
+
+Double dot(const Containers::StridedArrayView1D<const Double>& a, const Containers::StridedArrayView1D<const Double>& b, const UnsignedInt threadCount) {
+    return dotImplementation(a, b, threadCount);
+}
+
+Float mean(const Containers::StridedArrayView1D<const Float>& values, const UnsignedInt threadCount) {
+    return kahanSum(values, threadCount)/Float(values.size());
+}
+
+Double mean(const Containers::StridedArrayView1D<const Double>& values, const UnsignedInt threadCount) {
+    return kahanSum(values, threadCount)/Double(values.size());
+}
+
+Float variance(const Containers::StridedArrayView1D<const Float>& values, const UnsignedInt threadCount) {
+    return varianceImplementation(values, threadCount);
+}
+
+Double variance(const Containers::StridedArrayView1D<const Double>& values, const UnsignedInt threadCount) {
+    return varianceImplementation(values, threadCount);
+}
+
+}}}
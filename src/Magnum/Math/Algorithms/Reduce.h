@@ -0,0 +1,159 @@
+#ifndef Magnum_Math_Algorithms_Reduce_h
+#define Magnum_Math_Algorithms_Reduce_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::Math::Algorithms::kahanSum(const Corrade::Containers::StridedArrayView1D<const Float>&, UnsignedInt), @ref Magnum::Math::Algorithms::pairwiseSum(), @ref Magnum::Math::Algorithms::dot(), @ref Magnum::Math::Algorithms::mean(), @ref Magnum::Math::Algorithms::variance()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Types.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum { namespace Math { namespace Algorithms {
+
+/**
+@brief Vectorized Kahan sum of a large list of values
+@param values       Values to sum
+@param threadCount  Max count of threads to use. If @cpp 0 @ce,
+    @ref TaskScheduler::threadCount() of @ref TaskScheduler::global() is used.
+@m_since_latest
+
+Batch counterpart to @ref kahanSum(Iterator, Iterator, T, T*) with the same
+roundoff error compensation. The values are split into fixed-size blocks, each
+block is summed with the compensation done separately for each SIMD lane and
+the per-block results are then combined, again with compensation. Contiguous
+views use SSE2 or NEON if available, strided views are processed with a scalar
+fallback.
+
+Inputs with more than a few hundred thousand values are processed on up to
+@p threadCount threads, smaller inputs are always processed on the calling
+thread. The block boundaries don't depend on the thread count, so the result
+is the same regardless of how many threads were used. If Corrade isn't built
+with @ref CORRADE_BUILD_MULTITHREADED or when targeting
+@ref CORRADE_TARGET_EMSCRIPTEN "Emscripten", the @p threadCount parameter is
+ignored and everything is done on the calling thread.
+@see @ref pairwiseSum(), @ref mean()
+*/
+MAGNUM_EXPORT Float kahanSum(const Corrade::Containers::StridedArrayView1D<const Float>& values, UnsignedInt threadCount = 0);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_EXPORT Double kahanSum(const Corrade::Containers::StridedArrayView1D<const Double>& values, UnsignedInt threadCount = 0);
+
+/**
+@brief Vectorized pairwise sum of a large list of values
+@param values       Values to sum
+@param threadCount  Max count of threads to use. If @cpp 0 @ce,
+    @ref TaskScheduler::threadCount() of @ref TaskScheduler::global() is used.
+@m_since_latest
+
+Recursively splits the values into halves and adds the partial sums together,
+which makes the roundoff error grow only logarithmically with the value count.
+Compared to @ref kahanSum(const Corrade::Containers::StridedArrayView1D<const Float>&, UnsignedInt)
+it's a bit less precise but needs only one addition per value, so it's
+preferable when the data are already in cache and the summation isn't limited
+by memory bandwidth. Vectorization and multithreading behave the same as in
+@ref kahanSum(const Corrade::Containers::StridedArrayView1D<const Float>&, UnsignedInt).
+*/
+MAGNUM_EXPORT Float pairwiseSum(const Corrade::Containers::StridedArrayView1D<const Float>& values, UnsignedInt threadCount = 0);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_EXPORT Double pairwiseSum(const Corrade::Containers::StridedArrayView1D<const Double>& values, UnsignedInt threadCount = 0);
+
+/**
+@brief Vectorized dot product of two large lists of values
+@param a            First list of values
+@param b            Second list of values
+@param threadCount  Max count of threads to use. If @cpp 0 @ce,
+    @ref TaskScheduler::threadCount() of @ref TaskScheduler::global() is used.
+@m_since_latest
+
+Sum of @f$ a_i b_i @f$ calculated with Kahan summation. Expects that both
+views have the same size. The SIMD path is used only if both views are
+contiguous. Vectorization and multithreading behave the same as in
+@ref kahanSum(const Corrade::Containers::StridedArrayView1D<const Float>&, UnsignedInt).
+*/
+MAGNUM_EXPORT Float dot(const Corrade::Containers::StridedArrayView1D<const Float>& a, const Corrade::Containers::StridedArrayView1D<const Float>& b, UnsignedInt threadCount = 0);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_EXPORT Double dot(const Corrade::Containers::StridedArrayView1D<const Double>& a, const Corrade::Containers::StridedArrayView1D<const Double>& b, UnsignedInt threadCount = 0);
+
+/**
+@brief Arithmetic mean of a large list of values
+@param values       Values to calculate the mean of
+@param threadCount  Max count of threads to use. If @cpp 0 @ce,
+    @ref TaskScheduler::threadCount() of @ref TaskScheduler::global() is used.
+@m_since_latest
+
+Calculated as
+@ref kahanSum(const Corrade::Containers::StridedArrayView1D<const Float>&, UnsignedInt)
+divided by the value count. For an empty view the result is NaN.
+@see @ref variance()
+*/
+MAGNUM_EXPORT Float mean(const Corrade::Containers::StridedArrayView1D<const Float>& values, UnsignedInt threadCount = 0);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_EXPORT Double mean(const Corrade::Containers::StridedArrayView1D<const Double>& values, UnsignedInt threadCount = 0);
+
+/**
+@brief Population variance of a large list of values
+@param values       Values to calculate the variance of
+@param threadCount  Max count of threads to use. If @cpp 0 @ce,
+    @ref TaskScheduler::threadCount() of @ref TaskScheduler::global() is used.
+@m_since_latest
+
+Calculated in two passes, first calculating the @ref mean() @f$ \mu @f$ and
+then a Kahan sum of @f$ (x_i - \mu)^2 @f$ divided by the value count @f$ n @f$.
+Compared to a single-pass calculation from a sum of squares this doesn't suffer
+from catastrophic cancellation when the variance is small relative to the
+mean. Multiply the result by @f$ \frac{n}{n - 1} @f$ to get a sample variance.
+For an empty view the result is NaN.
+*/
+MAGNUM_EXPORT Float variance(const Corrade::Containers::StridedArrayView1D<const Float>& values, UnsignedInt threadCount = 0);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_EXPORT Double variance(const Corrade::Containers::StridedArrayView1D<const Double>& values, UnsignedInt threadCount = 0);
+
+}}}
+
+#endif
@@ -0,0 +1,231 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <numeric>
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Algorithms/Reduce.h"
+
+namespace Magnum { namespace Math { namespace Algorithms { namespace Test { namespace {
+
+struct ReduceTest: TestSuite::Tester {
+    explicit ReduceTest();
+
+    template<class T> void kahanSum();
+    template<class T> void pairwiseSum();
+    void strided();
+    template<class T> void dot();
+    template<class T> void meanVariance();
+    void threadCountIndependent();
+    void empty();
+
+    void dotSizeMismatch();
+
+    void accumulate1MFloats();
+    void kahan1MFloats();
+    void pairwise1MFloats();
+};
+
+/* More than enough values to get several blocks per thread */
+constexpr std::size_t Count = 2000000;
+
+const struct {
+    const char* name;
+    UnsignedInt threadCount;
+} ThreadData[]{
+    {"single thread", 1},
+    {"four threads", 4},
+    {"hardware concurrency", 0},
+};
+
+ReduceTest::ReduceTest() {
+    addInstancedTests<ReduceTest>({
+        &ReduceTest::kahanSum<Float>,
+        &ReduceTest::kahanSum<Double>,
+        &ReduceTest::pairwiseSum<Float>,
+        &ReduceTest::pairwiseSum<Double>,
+        &ReduceTest::strided,
+        &ReduceTest::dot<Float>,
+        &ReduceTest::dot<Double>,
+        &ReduceTest::meanVariance<Float>,
+        &ReduceTest::meanVariance<Double>},
+        Containers::arraySize(ThreadData));
+
+    addTests({&ReduceTest::threadCountIndependent,
+              &ReduceTest::empty,
+
+              &ReduceTest::dotSizeMismatch});
+
+    addBenchmarks({&ReduceTest::accumulate1MFloats,
+                   &ReduceTest::kahan1MFloats,
+                   &ReduceTest::pairwise1MFloats}, 50);
+}
+
+template<class> struct TypeName;
+template<> struct TypeName<Float> { static const char* name() { return "Float"; } };
+template<> struct TypeName<Double> { static const char* name() { return "Double"; } };
+
+template<class T> void ReduceTest::kahanSum() {
+    auto&& data = ThreadData[testCaseInstanceId()];
+    setTestCaseTemplateName(TypeName<T>::name());
+    setTestCaseDescription(data.name);
+
+    /* Neither 0.1f nor 0.1 is exactly representable, so a naive sum
+       accumulates a significant error */
+    Containers::Array<T> values{DirectInit, Count, T(0.1)};
+    CORRADE_COMPARE(Algorithms::kahanSum(Containers::arrayView(values), data.threadCount), T(Count)*T(0.1));
+}
+
+template<class T> void ReduceTest::pairwiseSum() {
+    auto&& data = ThreadData[testCaseInstanceId()];
+    setTestCaseTemplateName(TypeName<T>::name());
+    setTestCaseDescription(data.name);
+
+    Containers::Array<T> values{DirectInit, Count, T(0.1)};
+    CORRADE_COMPARE(Algorithms::pairwiseSum(Containers::arrayView(values), data.threadCount), T(Count)*T(0.1));
+}
+
+void ReduceTest::strided() {
+    auto&& data = ThreadData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Every second value is skipped, so if the SIMD path would be used it'd
+       pick up the 1000s as well */
+    Containers::Array<Float> values{NoInit, Count};
+    for(std::size_t i = 0; i != values.size(); ++i)
+        values[i] = i % 2 ? 1000.0f : 0.1f;
+    Containers::StridedArrayView1D<const Float> view = Containers::stridedArrayView(values).every(2);
+
+    CORRADE_COMPARE(Algorithms::kahanSum(view, data.threadCount), Float(Count/2)*0.1f);
+    CORRADE_COMPARE(Algorithms::pairwiseSum(view, data.threadCount), Float(Count/2)*0.1f);
+    CORRADE_COMPARE(Algorithms::dot(view, view, data.threadCount), Float(Count/2)*0.01f);
+    CORRADE_COMPARE(Algorithms::mean(view, data.threadCount), 0.1f);
+}
+
+template<class T> void ReduceTest::dot() {
+    auto&& data = ThreadData[testCaseInstanceId()];
+    setTestCaseTemplateName(TypeName<T>::name());
+    setTestCaseDescription(data.name);
+
+    Containers::Array<T> a{DirectInit, Count, T(0.1)};
+    Containers::Array<T> b{DirectInit, Count, T(3.0)};
+    CORRADE_COMPARE(Algorithms::dot(Containers::arrayView(a), Containers::arrayView(b), data.threadCount), T(Count)*T(0.3));
+}
+
+template<class T> void ReduceTest::meanVariance() {
+    auto&& data = ThreadData[testCaseInstanceId()];
+    setTestCaseTemplateName(TypeName<T>::name());
+    setTestCaseDescription(data.name);
+
+    /* A small variance relative to the mean, calculating it from a sum of
+       squares would lose all precision */
+    Containers::Array<T> values{NoInit, Count};
+    for(std::size_t i = 0; i != values.size(); ++i)
+        values[i] = i % 2 ? T(1000.5) : T(999.5);
+
+    CORRADE_COMPARE(Algorithms::mean(Containers::arrayView(values), data.threadCount), T(1000.0));
+    CORRADE_COMPARE(Algorithms::variance(Containers::arrayView(values), data.threadCount), T(0.25));
+}
+
+void ReduceTest::threadCountIndependent() {
+    Containers::Array<Float> values{NoInit, Count};
+    for(std::size_t i = 0; i != values.size(); ++i)
+        values[i] = 1.0f/Float(i + 1);
+
+    /* The block boundaries are fixed, so the results should be bit-exact
+       regardless of the thread count */
+    const Float kahan = Algorithms::kahanSum(Containers::arrayView(values), 1);
+    const Float pairwise = Algorithms::pairwiseSum(Containers::arrayView(values), 1);
+    const Float dot = Algorithms::dot(Containers::arrayView(values), Containers::arrayView(values), 1);
+    for(UnsignedInt threadCount: {2u, 3u, 7u}) {
+        CORRADE_ITERATION(threadCount);
+        CORRADE_VERIFY(Algorithms::kahanSum(Containers::arrayView(values), threadCount) == kahan);
+        CORRADE_VERIFY(Algorithms::pairwiseSum(Containers::arrayView(values), threadCount) == pairwise);
+        CORRADE_VERIFY(Algorithms::dot(Containers::arrayView(values), Containers::arrayView(values), threadCount) == dot);
+    }
+}
+
+void ReduceTest::empty() {
+    CORRADE_COMPARE(Algorithms::kahanSum(Containers::StridedArrayView1D<const Float>{}), 0.0f);
+    CORRADE_COMPARE(Algorithms::pairwiseSum(Containers::StridedArrayView1D<const Double>{}), 0.0);
+    CORRADE_COMPARE(Algorithms::dot(Containers::StridedArrayView1D<const Float>{}, Containers::StridedArrayView1D<const Float>{}), 0.0f);
+    CORRADE_VERIFY(Math::isNan(Algorithms::mean(Containers::StridedArrayView1D<const Float>{})));
+    CORRADE_VERIFY(Math::isNan(Algorithms::variance(Containers::StridedArrayView1D<const Double>{})));
+}
+
+void ReduceTest::dotSizeMismatch() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const Float a[3]{};
+    const Float b[2]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Algorithms::dot(a, b);
+    CORRADE_COMPARE(out.str(), "Math::Algorithms::dot(): expected views of the same size, got 3 and 2\n");
+}
+
+void ReduceTest::accumulate1MFloats() {
+    Containers::Array<Float> data{DirectInit, 1000000, 1.0f};
+
+    volatile Float a; /* to avoid optimizing the loop out */
+    CORRADE_BENCHMARK(10) {
+        a = std::accumulate(data.begin(), data.end(), 0.0f);
+    }
+
+    CORRADE_COMPARE(Float(a), 1000000.0f);
+}
+
+void ReduceTest::kahan1MFloats() {
+    Containers::Array<Float> data{DirectInit, 1000000, 1.0f};
+
+    volatile Float a; /* to avoid optimizing the loop out */
+    CORRADE_BENCHMARK(10) {
+        a = Algorithms::kahanSum(Containers::arrayView(data));
+    }
+
+    CORRADE_COMPARE(Float(a), 1000000.0f);
+}
+
+void ReduceTest::pairwise1MFloats() {
+    Containers::Array<Float> data{DirectInit, 1000000, 1.0f};
+
+    volatile Float a; /* to avoid optimizing the loop out */
+    CORRADE_BENCHMARK(10) {
+        a = Algorithms::pairwiseSum(Containers::arrayView(data));
+    }
+
+    CORRADE_COMPARE(Float(a), 1000000.0f);
+}
+
+}}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Algorithms::Test::ReduceTest)
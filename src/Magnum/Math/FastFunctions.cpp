@@ -0,0 +1,300 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FastFunctions.h"
+
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+#ifdef CORRADE_TARGET_SSE2
+#include <emmintrin.h>
+#elif defined(CORRADE_TARGET_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace Magnum { namespace Math { namespace Fast {
+
+namespace {
+
+/* Vectorized kernels for a contiguous run of values. Each returns the count
+   of values it processed, the remainder (or everything, if there's no SIMD
+   support on given platform) is then handled by the scalar loops below. The
+   kernels do the same operations in the same order as the scalar functions
+   in FastFunctions.h, so they have the same error bounds, the only
+   difference may be in the compiler fusing multiplications and additions in
+   the scalar code. */
+#if defined(CORRADE_TARGET_SSE2) || defined(CORRADE_TARGET_NEON)
+#ifdef CORRADE_TARGET_SSE2
+typedef __m128 Floats;
+typedef __m128i Ints;
+
+inline Floats load(const Float* const data) { return _mm_loadu_ps(data); }
+inline void store(Float* const data, const Floats a) { _mm_storeu_ps(data, a); }
+inline Floats splat(const Float a) { return _mm_set1_ps(a); }
+inline Ints splat(const UnsignedInt a) { return _mm_set1_epi32(Int(a)); }
+inline Floats add(const Floats a, const Floats b) { return _mm_add_ps(a, b); }
+inline Floats sub(const Floats a, const Floats b) { return _mm_sub_ps(a, b); }
+inline Floats mul(const Floats a, const Floats b) { return _mm_mul_ps(a, b); }
+inline Floats min(const Floats a, const Floats b) { return _mm_min_ps(a, b); }
+inline Floats max(const Floats a, const Floats b) { return _mm_max_ps(a, b); }
+/* All bits set in lanes where a < b */
+inline Floats lessMask(const Floats a, const Floats b) { return _mm_cmplt_ps(a, b); }
+inline Floats andBits(const Floats a, const Floats b) { return _mm_and_ps(a, b); }
+inline Ints bits(const Floats a) { return _mm_castps_si128(a); }
+inline Floats fromBits(const Ints a) { return _mm_castsi128_ps(a); }
+inline Ints addInts(const Ints a, const Ints b) { return _mm_add_epi32(a, b); }
+inline Ints subInts(const Ints a, const Ints b) { return _mm_sub_epi32(a, b); }
+inline Ints andInts(const Ints a, const Ints b) { return _mm_and_si128(a, b); }
+inline Ints orInts(const Ints a, const Ints b) { return _mm_or_si128(a, b); }
+inline Ints xorInts(const Ints a, const Ints b) { return _mm_xor_si128(a, b); }
+template<int shift> inline Ints shiftLeft(const Ints a) { return _mm_slli_epi32(a, shift); }
+template<int shift> inline Ints shiftRight(const Ints a) { return _mm_srli_epi32(a, shift); }
+inline Floats toFloats(const Ints a) { return _mm_cvtepi32_ps(a); }
+/* Used only on values that are already integral, so the rounding mode
+   doesn't matter */
+inline Ints toInts(const Floats a) { return _mm_cvtps_epi32(a); }
+#else
+typedef float32x4_t Floats;
+typedef uint32x4_t Ints;
+
+inline Floats load(const Float* const data) { return vld1q_f32(data); }
+inline void store(Float* const data, const Floats a) { vst1q_f32(data, a); }
+inline Floats splat(const Float a) { return vdupq_n_f32(a); }
+inline Ints splat(const UnsignedInt a) { return vdupq_n_u32(a); }
+inline Floats add(const Floats a, const Floats b) { return vaddq_f32(a, b); }
+inline Floats sub(const Floats a, const Floats b) { return vsubq_f32(a, b); }
+inline Floats mul(const Floats a, const Floats b) { return vmulq_f32(a, b); }
+inline Floats min(const Floats a, const Floats b) { return vminq_f32(a, b); }
+inline Floats max(const Floats a, const Floats b) { return vmaxq_f32(a, b); }
+/* All bits set in lanes where a < b */
+inline Floats lessMask(const Floats a, const Floats b) { return vreinterpretq_f32_u32(vcltq_f32(a, b)); }
+inline Floats andBits(const Floats a, const Floats b) { return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b))); }
+inline Ints bits(const Floats a) { return vreinterpretq_u32_f32(a); }
+inline Floats fromBits(const Ints a) { return vreinterpretq_f32_u32(a); }
+inline Ints addInts(const Ints a, const Ints b) { return vaddq_u32(a, b); }
+inline Ints subInts(const Ints a, const Ints b) { return vsubq_u32(a, b); }
+inline Ints andInts(const Ints a, const Ints b) { return vandq_u32(a, b); }
+inline Ints orInts(const Ints a, const Ints b) { return vorrq_u32(a, b); }
+inline Ints xorInts(const Ints a, const Ints b) { return veorq_u32(a, b); }
+template<int shift> inline Ints shiftLeft(const Ints a) { return vshlq_n_u32(a, shift); }
+template<int shift> inline Ints shiftRight(const Ints a) { return vshrq_n_u32(a, shift); }
+inline Floats toFloats(const Ints a) { return vcvtq_f32_s32(vreinterpretq_s32_u32(a)); }
+/* Used only on values that are already integral, so the rounding mode
+   doesn't matter */
+inline Ints toInts(const Floats a) { return vreinterpretq_u32_s32(vcvtq_s32_f32(a)); }
+#endif
+
+/* Equivalents of the helpers in Implementation in FastFunctions.h */
+inline Floats reduceToPi(const Floats x, Ints& n) {
+    const Floats magic = splat(Implementation::FastRoundMagic);
+    const Floats nBits = add(mul(x, splat(0.318309886f)), magic);
+    const Floats nf = sub(nBits, magic);
+    n = bits(nBits);
+    return sub(sub(sub(x, mul(nf, splat(3.140625f))), mul(nf, splat(9.67502593994140625e-4f))), mul(nf, splat(1.509957990978376432e-7f)));
+}
+
+inline Floats sinPolynomial(const Floats r, const Floats r2) {
+    return add(r, mul(mul(r, r2), add(splat(-0.166666571f), mul(r2, add(splat(0.00833301729f), mul(r2, add(splat(-0.000198066152f), mul(r2, splat(2.60005477e-06f)))))))));
+}
+
+inline Floats cosPolynomial(const Floats r2) {
+    return add(splat(1.0f), mul(r2, add(splat(-0.499999323f), mul(r2, add(splat(0.0416639895f), mul(r2, add(splat(-0.00138559272f), mul(r2, splat(2.31943865e-05f)))))))));
+}
+
+inline Floats flipSignIfOdd(const Floats value, const Ints n) {
+    return fromBits(xorInts(bits(value), shiftLeft<31>(n)));
+}
+
+std::size_t sinKernel(const Float* const src, Float* const dst, const std::size_t count) {
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4) {
+        Ints n;
+        const Floats r = reduceToPi(load(src + i), n);
+        store(dst + i, flipSignIfOdd(sinPolynomial(r, mul(r, r)), n));
+    }
+    return i;
+}
+
+std::size_t cosKernel(const Float* const src, Float* const dst, const std::size_t count) {
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4) {
+        Ints n;
+        const Floats r = reduceToPi(load(src + i), n);
+        store(dst + i, flipSignIfOdd(cosPolynomial(mul(r, r)), n));
+    }
+    return i;
+}
+
+std::size_t sincosKernel(const Float* const src, Float* const sinDst, Float* const cosDst, const std::size_t count) {
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4) {
+        Ints n;
+        const Floats r = reduceToPi(load(src + i), n);
+        const Floats r2 = mul(r, r);
+        /* Both calculated before storing in case one of the outputs is
+           in-place */
+        const Floats sinValues = flipSignIfOdd(sinPolynomial(r, r2), n);
+        const Floats cosValues = flipSignIfOdd(cosPolynomial(r2), n);
+        store(sinDst + i, sinValues);
+        store(cosDst + i, cosValues);
+    }
+    return i;
+}
+
+std::size_t expKernel(const Float* const src, Float* const dst, const std::size_t count) {
+    const Floats magic = splat(Implementation::FastRoundMagic);
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4) {
+        const Floats x = min(max(load(src + i), splat(-87.3365479f)), splat(88.3762589f));
+        const Floats nf = sub(add(mul(x, splat(1.44269504f)), magic), magic);
+        const Floats r = sub(sub(x, mul(nf, splat(0.693359375f))), mul(nf, splat(-2.12194440e-4f)));
+        Floats p = add(mul(splat(1.9875691500e-4f), r), splat(1.3981999507e-3f));
+        p = add(mul(p, r), splat(8.3334519073e-3f));
+        p = add(mul(p, r), splat(4.1665795894e-2f));
+        p = add(mul(p, r), splat(1.6666665459e-1f));
+        p = add(mul(p, r), splat(5.0000001201e-1f));
+        p = add(add(mul(mul(p, r), r), r), splat(1.0f));
+        const Floats scale = fromBits(shiftLeft<23>(addInts(toInts(nf), splat(127u))));
+        store(dst + i, mul(p, scale));
+    }
+    return i;
+}
+
+std::size_t logKernel(const Float* const src, Float* const dst, const std::size_t count) {
+    const Floats one = splat(1.0f);
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4) {
+        const Ints x = bits(load(src + i));
+        Floats e = toFloats(subInts(shiftRight<23>(x), splat(126u)));
+        const Floats m = fromBits(orInts(andInts(x, splat(0x807fffffu)), splat(0x3f000000u)));
+
+        const Floats small = lessMask(m, splat(0.707106781f));
+        const Floats f = add(sub(m, one), andBits(small, m));
+        e = sub(e, andBits(small, one));
+
+        const Floats z = mul(f, f);
+        Floats y = sub(mul(splat(7.0376836292e-2f), f), splat(1.1514610310e-1f));
+        y = add(mul(y, f), splat(1.1676998740e-1f));
+        y = sub(mul(y, f), splat(1.2420140846e-1f));
+        y = add(mul(y, f), splat(1.4249322787e-1f));
+        y = sub(mul(y, f), splat(1.6668057665e-1f));
+        y = add(mul(y, f), splat(2.0000714765e-1f));
+        y = sub(mul(y, f), splat(2.4999993993e-1f));
+        y = add(mul(y, f), splat(3.3333331174e-1f));
+        y = mul(mul(y, f), z);
+
+        store(dst + i, add(add(f, sub(add(y, mul(e, splat(-2.12194440e-4f))), mul(splat(0.5f), z))), mul(e, splat(0.693359375f))));
+    }
+    return i;
+}
+#else
+std::size_t sinKernel(const Float*, Float*, std::size_t) { return 0; }
+std::size_t cosKernel(const Float*, Float*, std::size_t) { return 0; }
+std::size_t sincosKernel(const Float*, Float*, Float*, std::size_t) { return 0; }
+std::size_t expKernel(const Float*, Float*, std::size_t) { return 0; }
+std::size_t logKernel(const Float*, Float*, std::size_t) { return 0; }
+#endif
+
+/* Common code for the single-output functions. The vectorized kernel is used
+   only if both views are contiguous, everything else goes through the scalar
+   function. */
+template<class T, std::size_t(*kernel)(const Float*, Float*, std::size_t), Float(*function)(T)> void intoImplementation(const Corrade::Containers::StridedArrayView1D<const T>& src, const Corrade::Containers::StridedArrayView1D<Float>& dst) {
+    std::size_t i = 0;
+    if(src.isContiguous() && dst.isContiguous())
+        i = kernel(reinterpret_cast<const Float*>(src.data()), reinterpret_cast<Float*>(dst.data()), src.size());
+
+    /* Caching values to avoid inline function calls in debug builds */
+    const std::ptrdiff_t srcStride = src.stride();
+    const std::ptrdiff_t dstStride = dst.stride();
+    const char* srcPtr = reinterpret_cast<const char*>(src.data()) + std::ptrdiff_t(i)*srcStride;
+    char* dstPtr = reinterpret_cast<char*>(dst.data()) + std::ptrdiff_t(i)*dstStride;
+    for(std::size_t max = src.size(); i != max; ++i) {
+        *reinterpret_cast<Float*>(dstPtr) = function(*reinterpret_cast<const T*>(srcPtr));
+
+        srcPtr += srcStride;
+        dstPtr += dstStride;
+    }
+}
+
+/* Overloads can't be passed as template arguments directly, so wrapping
+   them */
+Float sinRad(const Rad<Float> angle) { return sin(angle); }
+Float cosRad(const Rad<Float> angle) { return cos(angle); }
+Float expFloat(const Float value) { return exp(value); }
+Float logFloat(const Float value) { return log(value); }
+
+}
+
+void sinInto(const Corrade::Containers::StridedArrayView1D<const Rad<Float>>& src, const Corrade::Containers::StridedArrayView1D<Float>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::Fast::sinInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+    intoImplementation<Rad<Float>, sinKernel, sinRad>(src, dst);
+}
+
+void cosInto(const Corrade::Containers::StridedArrayView1D<const Rad<Float>>& src, const Corrade::Containers::StridedArrayView1D<Float>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::Fast::cosInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+    intoImplementation<Rad<Float>, cosKernel, cosRad>(src, dst);
+}
+
+void sincosInto(const Corrade::Containers::StridedArrayView1D<const Rad<Float>>& src, const Corrade::Containers::StridedArrayView1D<Float>& sinDst, const Corrade::Containers::StridedArrayView1D<Float>& cosDst) {
+    CORRADE_ASSERT(src.size() == sinDst.size() && src.size() == cosDst.size(),
+        "Math::Fast::sincosInto(): wrong destination sizes, got" << sinDst.size() << "and" << cosDst.size() << "but expected" << src.size(), );
+
+    std::size_t i = 0;
+    if(src.isContiguous() && sinDst.isContiguous() && cosDst.isContiguous())
+        i = sincosKernel(reinterpret_cast<const Float*>(src.data()), reinterpret_cast<Float*>(sinDst.data()), reinterpret_cast<Float*>(cosDst.data()), src.size());
+
+    /* Caching values to avoid inline function calls in debug builds */
+    const std::ptrdiff_t srcStride = src.stride();
+    const std::ptrdiff_t sinDstStride = sinDst.stride();
+    const std::ptrdiff_t cosDstStride = cosDst.stride();
+    const char* srcPtr = reinterpret_cast<const char*>(src.data()) + std::ptrdiff_t(i)*srcStride;
+    char* sinDstPtr = reinterpret_cast<char*>(sinDst.data()) + std::ptrdiff_t(i)*sinDstStride;
+    char* cosDstPtr = reinterpret_cast<char*>(cosDst.data()) + std::ptrdiff_t(i)*cosDstStride;
+    for(std::size_t max = src.size(); i != max; ++i) {
+        const std::pair<Float, Float> out = sincos(*reinterpret_cast<const Rad<Float>*>(srcPtr));
+        *reinterpret_cast<Float*>(sinDstPtr) = out.first;
+        *reinterpret_cast<Float*>(cosDstPtr) = out.second;
+
+        srcPtr += srcStride;
+        sinDstPtr += sinDstStride;
+        cosDstPtr += cosDstStride;
+    }
+}
+
+void expInto(const Corrade::Containers::StridedArrayView1D<const Float>& src, const Corrade::Containers::StridedArrayView1D<Float>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::Fast::expInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+    intoImplementation<Float, expKernel, expFloat>(src, dst);
+}
+
+void logInto(const Corrade::Containers::StridedArrayView1D<const Float>& src, const Corrade::Containers::StridedArrayView1D<Float>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::Fast::logInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+    intoImplementation<Float, logKernel, logFloat>(src, dst);
+}
+
+}}}
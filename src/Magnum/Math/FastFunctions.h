@@ -0,0 +1,304 @@
+#ifndef Magnum_Math_FastFunctions_h
+#define Magnum_Math_FastFunctions_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Namespace @ref Magnum::Math::Fast
+ * @m_since_latest
+ */
+
+#include <utility>
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Types.h"
+#include "Magnum/visibility.h"
+#include "Magnum/Math/Angle.h"
+
+namespace Magnum { namespace Math {
+
+namespace Implementation {
+    union FastFloatBits {
+        Float f;
+        UnsignedInt u;
+        Int i;
+    };
+
+    /* Adding 1.5*2^23 to a float with absolute value less than 2^22 rounds
+       it to the nearest integer, which then ends up in the low mantissa bits.
+       Subtracting it again gives back the rounded value as a float. */
+    constexpr Float FastRoundMagic = 12582912.0f;
+
+    /* Reduces x to r = x - n*π in [-π/2, π/2] and returns r together with
+       n. π is split into three parts so the first two products are exact for
+       reasonably large n. */
+    inline Float fastReduceToPi(const Float x, FastFloatBits& n) {
+        n.f = x*0.318309886f + FastRoundMagic;
+        const Float nf = n.f - FastRoundMagic;
+        return ((x - nf*3.140625f) - nf*9.67502593994140625e-4f) - nf*1.509957990978376432e-7f;
+    }
+
+    /* Minimax polynomials for sine and cosine on [-π/2, π/2] */
+    inline Float fastSinPolynomial(const Float r, const Float r2) {
+        return r + r*r2*(-0.166666571f + r2*(0.00833301729f + r2*(-0.000198066152f + r2*2.60005477e-06f)));
+    }
+    inline Float fastCosPolynomial(const Float r2) {
+        return 1.0f + r2*(-0.499999323f + r2*(0.0416639895f + r2*(-0.00138559272f + r2*2.31943865e-05f)));
+    }
+
+    /* Flips the sign of the value if n is odd */
+    inline Float fastFlipSignIfOdd(const Float value, const FastFloatBits& n) {
+        FastFloatBits out;
+        out.f = value;
+        out.u ^= n.u << 31;
+        return out.f;
+    }
+}
+
+namespace Fast {
+
+/**
+@{ @name Fast approximate transcendental functions
+
+Polynomial approximations of the functions from @ref Magnum/Math/Functions.h,
+trading precision and handling of special values for speed. Unlike the
+standard library functions, the implementations are branch-free, which makes
+them inlineable in hot loops and allows the compiler to vectorize them. The
+maximum errors listed for each function are measured against a
+double-precision reference, the batch variants additionally process
+contiguous ranges using SSE2 or NEON instructions if @ref CORRADE_TARGET_SSE2
+or @ref CORRADE_TARGET_NEON is defined.
+
+Use these only where a bounded error is acceptable, such as for particle
+systems, noise or easing. Everywhere else the regular @ref Math::sin(),
+@ref Math::exp() etc. should be preferred.
+*/
+
+/**
+@brief Fast sine
+@m_since_latest
+
+Range-reduced to @f$ [-\frac{\pi}{2}, \frac{\pi}{2}] @f$ and evaluated using a
+minimax polynomial of degree 9. The maximum absolute error is
+@f$ 1.5 \cdot 10^{-7} @f$ for @p angle in @f$ [-10^4, 10^4] @f$, the error
+grows with the magnitude of the angle and the result is undefined for
+@f$ |angle| \ge 2^{22} \pi @f$.
+@see @ref Math::sin(), @ref sinInto()
+*/
+#ifdef DOXYGEN_GENERATING_OUTPUT
+inline Float sin(Rad<Float> angle);
+#else
+inline Float sin(Unit<Rad, Float> angle) {
+    Implementation::FastFloatBits n;
+    const Float r = Implementation::fastReduceToPi(Float(angle), n);
+    return Implementation::fastFlipSignIfOdd(Implementation::fastSinPolynomial(r, r*r), n);
+}
+inline Float sin(Unit<Deg, Float> angle) { return sin(Rad<Float>(angle)); }
+#endif
+
+/**
+@brief Fast cosine
+@m_since_latest
+
+Range-reduced to @f$ [-\frac{\pi}{2}, \frac{\pi}{2}] @f$ and evaluated using a
+minimax polynomial of degree 8. The maximum absolute error is
+@f$ 2.5 \cdot 10^{-7} @f$ for @p angle in @f$ [-10^4, 10^4] @f$, the error
+grows with the magnitude of the angle and the result is undefined for
+@f$ |angle| \ge 2^{22} \pi @f$.
+@see @ref Math::cos(), @ref cosInto()
+*/
+#ifdef DOXYGEN_GENERATING_OUTPUT
+inline Float cos(Rad<Float> angle);
+#else
+inline Float cos(Unit<Rad, Float> angle) {
+    Implementation::FastFloatBits n;
+    const Float r = Implementation::fastReduceToPi(Float(angle), n);
+    return Implementation::fastFlipSignIfOdd(Implementation::fastCosPolynomial(r*r), n);
+}
+inline Float cos(Unit<Deg, Float> angle) { return cos(Rad<Float>(angle)); }
+#endif
+
+/**
+@brief Fast sine and cosine
+@m_since_latest
+
+Shares the range reduction between the two, otherwise equivalent to calling
+@ref sin() and @ref cos(), including the error bounds.
+@see @ref Math::sincos(), @ref sincosInto()
+*/
+#ifdef DOXYGEN_GENERATING_OUTPUT
+inline std::pair<Float, Float> sincos(Rad<Float> angle);
+#else
+inline std::pair<Float, Float> sincos(Unit<Rad, Float> angle) {
+    Implementation::FastFloatBits n;
+    const Float r = Implementation::fastReduceToPi(Float(angle), n);
+    const Float r2 = r*r;
+    return {Implementation::fastFlipSignIfOdd(Implementation::fastSinPolynomial(r, r2), n),
+            Implementation::fastFlipSignIfOdd(Implementation::fastCosPolynomial(r2), n)};
+}
+inline std::pair<Float, Float> sincos(Unit<Deg, Float> angle) { return sincos(Rad<Float>(angle)); }
+#endif
+
+/**
+@brief Fast natural exponential
+@m_since_latest
+
+Range-reduced to @f$ [-\frac{\ln 2}{2}, \frac{\ln 2}{2}] @f$ and evaluated
+using a polynomial of degree 7, with coefficients taken from the
+[Cephes](https://www.netlib.org/cephes/) library. The maximum relative error
+is @f$ 1.0 \cdot 10^{-7} @f$. The input is clamped to
+@f$ [-87.33, 88.37] @f$, which means the result never overflows to infinity
+and results close to the denormal range have a lower precision.
+@see @ref Math::exp(), @ref expInto()
+*/
+inline Float exp(Float value) {
+    /* Clamped so the 2^n scale is always a normal float */
+    const Float x = value < -87.3365479f ? -87.3365479f : value > 88.3762589f ? 88.3762589f : value;
+
+    /* x = n*ln(2) + r, with ln(2) split into two parts so n*ln(2) is exact */
+    Implementation::FastFloatBits n;
+    n.f = x*1.44269504f + Implementation::FastRoundMagic;
+    const Float nf = n.f - Implementation::FastRoundMagic;
+    const Float r = (x - nf*0.693359375f) - nf*-2.12194440e-4f;
+
+    const Float p = ((((((1.9875691500e-4f*r + 1.3981999507e-3f)*r + 8.3334519073e-3f)*r + 4.1665795894e-2f)*r + 1.6666665459e-1f)*r + 5.0000001201e-1f)*r*r + r) + 1.0f;
+
+    /* e^x = 2^n*e^r */
+    Implementation::FastFloatBits scale;
+    scale.i = (Int(nf) + 127) << 23;
+    return p*scale.f;
+}
+
+/**
+@brief Fast natural logarithm
+@m_since_latest
+
+Decomposed to an exponent and a mantissa in
+@f$ [\frac{\sqrt{2}}{2}, \sqrt{2}) @f$, which is evaluated using a polynomial
+of degree 10, with coefficients taken from the
+[Cephes](https://www.netlib.org/cephes/) library. The maximum relative error
+is @f$ 1.0 \cdot 10^{-7} @f$. The result is undefined for zero, negative,
+denormal, infinite and NaN inputs.
+@see @ref Math::log(), @ref logInto()
+*/
+inline Float log(Float value) {
+    /* Mantissa in [0.5, 1) and the corresponding exponent */
+    Implementation::FastFloatBits bits;
+    bits.f = value;
+    Float e = Float(Int(bits.u >> 23) - 126);
+    bits.u = (bits.u & 0x807fffffu) | 0x3f000000u;
+    const Float m = bits.f;
+
+    /* Shift the mantissa to [√2/2, √2) to have the polynomial argument
+       centered around zero */
+    const bool small = m < 0.707106781f;
+    const Float f = (m - 1.0f) + (small ? m : 0.0f);
+    e -= small ? 1.0f : 0.0f;
+
+    const Float z = f*f;
+    const Float y = ((((((((7.0376836292e-2f*f - 1.1514610310e-1f)*f + 1.1676998740e-1f)*f - 1.2420140846e-1f)*f + 1.4249322787e-1f)*f - 1.6668057665e-1f)*f + 2.0000714765e-1f)*f - 2.4999993993e-1f)*f + 3.3333331174e-1f)*f*z;
+
+    /* ln(x) = e*ln(2) + ln(m), again with ln(2) split into two parts */
+    return (f + (y + e*-2.12194440e-4f - 0.5f*z)) + e*0.693359375f;
+}
+
+/**
+@brief Fast sine of a range of values
+@param[in]  src     Source angles
+@param[out] dst     Destination values
+@m_since_latest
+
+Equivalent to calling @ref sin() on each item, with the same error bounds.
+Expects that @p src and @p dst have the same size. The views can be
+arbitrarily strided and @p dst can point to the same memory as @p src for an
+in-place operation, but otherwise the views shouldn't overlap.
+*/
+MAGNUM_EXPORT void sinInto(const Corrade::Containers::StridedArrayView1D<const Rad<Float>>& src, const Corrade::Containers::StridedArrayView1D<Float>& dst);
+
+/**
+@brief Fast cosine of a range of values
+@param[in]  src     Source angles
+@param[out] dst     Destination values
+@m_since_latest
+
+Equivalent to calling @ref cos() on each item, with the same error bounds.
+Expects that @p src and @p dst have the same size. The views can be
+arbitrarily strided and @p dst can point to the same memory as @p src for an
+in-place operation, but otherwise the views shouldn't overlap.
+*/
+MAGNUM_EXPORT void cosInto(const Corrade::Containers::StridedArrayView1D<const Rad<Float>>& src, const Corrade::Containers::StridedArrayView1D<Float>& dst);
+
+/**
+@brief Fast sine and cosine of a range of values
+@param[in]  src     Source angles
+@param[out] sinDst  Destination sine values
+@param[out] cosDst  Destination cosine values
+@m_since_latest
+
+Equivalent to calling @ref sincos() on each item, with the same error bounds.
+Expects that @p src, @p sinDst and @p cosDst have the same size. The views
+can be arbitrarily strided and one of the destinations can point to the same
+memory as @p src for an in-place operation, but otherwise the views shouldn't
+overlap.
+*/
+MAGNUM_EXPORT void sincosInto(const Corrade::Containers::StridedArrayView1D<const Rad<Float>>& src, const Corrade::Containers::StridedArrayView1D<Float>& sinDst, const Corrade::Containers::StridedArrayView1D<Float>& cosDst);
+
+/**
+@brief Fast natural exponential of a range of values
+@param[in]  src     Source values
+@param[out] dst     Destination values
+@m_since_latest
+
+Equivalent to calling @ref exp() on each item, with the same error bounds.
+Expects that @p src and @p dst have the same size. The views can be
+arbitrarily strided and @p dst can be the same view as @p src for an in-place
+operation, but otherwise the views shouldn't overlap.
+*/
+MAGNUM_EXPORT void expInto(const Corrade::Containers::StridedArrayView1D<const Float>& src, const Corrade::Containers::StridedArrayView1D<Float>& dst);
+
+/**
+@brief Fast natural logarithm of a range of values
+@param[in]  src     Source values
+@param[out] dst     Destination values
+@m_since_latest
+
+Equivalent to calling @ref log() on each item, with the same error bounds.
+Expects that @p src and @p dst have the same size. The views can be
+arbitrarily strided and @p dst can be the same view as @p src for an in-place
+operation, but otherwise the views shouldn't overlap.
+*/
+MAGNUM_EXPORT void logInto(const Corrade::Containers::StridedArrayView1D<const Float>& src, const Corrade::Containers::StridedArrayView1D<Float>& dst);
+
+/* Since 1.8.17, the original short-hand group closing doesn't work anymore.
+   FFS. */
+/**
+ * @}
+ */
+
+}
+
+}}
+
+#endif
@@ -0,0 +1,179 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FunctionsBatch.h"
+
+#include "Magnum/Math/Implementation/lanes.h"
+
+namespace Magnum { namespace Math { namespace Implementation {
+
+/* The kernels process the data in chunks of twelve floats, which is a
+   multiple of every supported component count. Lane i of each chunk thus
+   always corresponds to component i % components and the per-lane results
+   can be folded into per-component results at the end. */
+enum: std::size_t { ChunkSize = 12 };
+
+namespace {
+
+/* Folds a mask of ChunkSize lanes into a mask of components */
+UnsignedInt componentMask(UnsignedInt laneMask, const UnsignedInt components) {
+    UnsignedInt out = 0;
+    for(UnsignedInt i = 0; laneMask; ++i, laneMask >>= 1)
+        if(laneMask & 1) out |= 1 << (i % components);
+    return out;
+}
+
+struct IsInf {
+    UnsignedInt operator()(const Lanes& a) const { return lanesInfMask(a); }
+    bool operator()(const Float a) const { return Math::isInf(a); }
+};
+
+struct IsNan {
+    UnsignedInt operator()(const Lanes& a) const { return lanesNanMask(a); }
+    bool operator()(const Float a) const { return Math::isNan(a); }
+};
+
+template<class Op> UnsignedInt maskContiguous(const Float* const data, const std::size_t count, const UnsignedInt components) {
+    const std::size_t size = count*components;
+    const UnsignedInt all = (1 << components) - 1;
+    UnsignedInt out = 0;
+
+    std::size_t i = 0;
+    for(; i + ChunkSize <= size; i += ChunkSize) {
+        const UnsignedInt mask =
+            Op{}(lanesLoad4(data + i))|
+            Op{}(lanesLoad4(data + i + 4)) << 4|
+            Op{}(lanesLoad4(data + i + 8)) << 8;
+        /* Exit as soon as all components are known to have a match */
+        if(mask && (out |= componentMask(mask, components)) == all)
+            return out;
+    }
+
+    for(; i != size; ++i)
+        if(Op{}(data[i])) out |= 1 << (i % components);
+
+    return out;
+}
+
+struct Min {
+    Lanes operator()(const Lanes& a, const Lanes& b) const { return lanesMin(a, b); }
+    Float operator()(const Float a, const Float b) const { return Math::min(a, b); }
+};
+
+struct Max {
+    Lanes operator()(const Lanes& a, const Lanes& b) const { return lanesMax(a, b); }
+    Float operator()(const Float a, const Float b) const { return Math::max(a, b); }
+};
+
+/* Three accumulators, each covering a third of a chunk */
+struct Accumulator {
+    Lanes a, b, c;
+};
+
+/* Starts each lane with the initial value of its component. As the initial
+   values are non-NaN unless a component is all NaNs, the NaN skipping
+   behavior is the same as with the scalar loop. */
+Accumulator accumulatorLoad(const Float* const out, const UnsignedInt components) {
+    Float lanes[ChunkSize];
+    for(std::size_t j = 0; j != ChunkSize; ++j)
+        lanes[j] = out[j % components];
+    return {lanesLoad4(lanes), lanesLoad4(lanes + 4), lanesLoad4(lanes + 8)};
+}
+
+template<class Op> inline void accumulatorApply(Accumulator& accumulator, const Float* const data) {
+    accumulator.a = Op{}(accumulator.a, lanesLoad4(data));
+    accumulator.b = Op{}(accumulator.b, lanesLoad4(data + 4));
+    accumulator.c = Op{}(accumulator.c, lanesLoad4(data + 8));
+}
+
+/* The lanes are folded in order, so for values comparing equal (such as
+   negative and positive zero) the result may differ from the scalar loop
+   in which one of them is picked */
+template<class Op> void accumulatorStore(const Accumulator& accumulator, Float* const out, const UnsignedInt components) {
+    Float lanes[ChunkSize];
+    lanesStore4(lanes, accumulator.a);
+    lanesStore4(lanes + 4, accumulator.b);
+    lanesStore4(lanes + 8, accumulator.c);
+    for(std::size_t j = 0; j != ChunkSize; ++j)
+        out[j % components] = Op{}(out[j % components], lanes[j]);
+}
+
+template<class Op> void reduceContiguous(const Float* const data, const std::size_t count, const UnsignedInt components, Float* const out) {
+    const std::size_t size = count*components;
+
+    std::size_t i = 0;
+    if(size >= ChunkSize) {
+        Accumulator accumulator = accumulatorLoad(out, components);
+        for(; i + ChunkSize <= size; i += ChunkSize)
+            accumulatorApply<Op>(accumulator, data + i);
+        accumulatorStore<Op>(accumulator, out, components);
+    }
+
+    for(; i != size; ++i)
+        out[i % components] = Op{}(out[i % components], data[i]);
+}
+
+}
+
+UnsignedInt isInfContiguous(const Float* const data, const std::size_t count, const UnsignedInt components) {
+    return maskContiguous<IsInf>(data, count, components);
+}
+
+UnsignedInt isNanContiguous(const Float* const data, const std::size_t count, const UnsignedInt components) {
+    return maskContiguous<IsNan>(data, count, components);
+}
+
+void minContiguous(const Float* const data, const std::size_t count, const UnsignedInt components, Float* const out) {
+    reduceContiguous<Min>(data, count, components, out);
+}
+
+void maxContiguous(const Float* const data, const std::size_t count, const UnsignedInt components, Float* const out) {
+    reduceContiguous<Max>(data, count, components, out);
+}
+
+void minmaxContiguous(const Float* const data, const std::size_t count, const UnsignedInt components, Float* const outMin, Float* const outMax) {
+    const std::size_t size = count*components;
+
+    /* Same as reduceContiguous(), just with both operations in a single pass
+       over the data */
+    std::size_t i = 0;
+    if(size >= ChunkSize) {
+        Accumulator min = accumulatorLoad(outMin, components);
+        Accumulator max = accumulatorLoad(outMax, components);
+        for(; i + ChunkSize <= size; i += ChunkSize) {
+            accumulatorApply<Min>(min, data + i);
+            accumulatorApply<Max>(max, data + i);
+        }
+        accumulatorStore<Min>(min, outMin, components);
+        accumulatorStore<Max>(max, outMax, components);
+    }
+
+    for(; i != size; ++i) {
+        outMin[i % components] = Math::min(outMin[i % components], data[i]);
+        outMax[i % components] = Math::max(outMax[i % components], data[i]);
+    }
+}
+
+}}}
@@ -44,13 +44,40 @@ template<class T, class View = decltype(Corrade::Containers::Implementation::Era
 template<class T> static T stridedArrayViewTypeFor(const Corrade::Containers::ArrayView<T>&);
 template<class T> static T stridedArrayViewTypeFor(const Corrade::Containers::StridedArrayView1D<T>&);
 
+/* Float component count of scalar and vector types that can go through the
+   SSE2 / NEON implementations in FunctionsBatch.cpp if the range is
+   contiguous, 0 for everything else */
+template<class T, bool = IsScalar<T>::value || IsVector<T>::value> struct BatchFloatComponents: std::integral_constant<UnsignedInt, 0> {};
+template<class T> struct BatchFloatComponents<T, true>: std::integral_constant<UnsignedInt, std::is_same<UnderlyingTypeOf<T>, Float>::value && sizeof(T) <= 4*sizeof(Float) ? UnsignedInt(sizeof(T)/sizeof(Float)) : 0> {};
+
+/* The data is count items of components floats each. The isNan() / isInf()
+   variants return a mask of components that have any NaN / infinity, the
+   others update the values in out, which are expected to be initialized to
+   the first non-NaN value for each component. */
+MAGNUM_EXPORT UnsignedInt isInfContiguous(const Float* data, std::size_t count, UnsignedInt components);
+MAGNUM_EXPORT UnsignedInt isNanContiguous(const Float* data, std::size_t count, UnsignedInt components);
+MAGNUM_EXPORT void minContiguous(const Float* data, std::size_t count, UnsignedInt components, Float* out);
+MAGNUM_EXPORT void maxContiguous(const Float* data, std::size_t count, UnsignedInt components, Float* out);
+MAGNUM_EXPORT void minmaxContiguous(const Float* data, std::size_t count, UnsignedInt components, Float* outMin, Float* outMax);
+
+inline void fromComponentMask(const UnsignedInt mask, bool& out) {
+    out = mask;
+}
+template<std::size_t size> inline void fromComponentMask(const UnsignedInt mask, BitVector<size>& out) {
+    for(std::size_t i = 0; i != size; ++i)
+        out.set(i, mask & (1 << i));
+}
+
 }
 
 /**
 @{ @name Batch functions
 
 These functions process an ubounded range of values, as opposed to single
-vectors or scalars.
+vectors or scalars. Contiguous ranges of @ref Float scalars and vectors of up
+to four components are processed using SSE2 or NEON instructions if
+@ref CORRADE_TARGET_SSE2 or @ref CORRADE_TARGET_NEON is defined, contiguous
+integer ranges are processed with a loop that the compiler can vectorize.
 */
 
 /**
@@ -65,6 +92,14 @@ empty, returns @cpp false @ce or a @ref BitVector with no bits set.
 template<class T> auto isInf(const Corrade::Containers::StridedArrayView1D<const T>& range) -> decltype(isInf(std::declval<T>())) {
     if(range.isEmpty()) return {};
 
+    /* Contiguous Float scalars and vectors have a vectorized implementation */
+    constexpr UnsignedInt components = Implementation::BatchFloatComponents<T>::value;
+    if(components && range.isContiguous()) {
+        decltype(isInf(std::declval<T>())) out{};
+        Implementation::fromComponentMask(Implementation::isInfContiguous(static_cast<const Float*>(range.data()), range.size(), components), out);
+        return out;
+    }
+
     /* For scalars, this loop exits once any value is infinity. For vectors
        the loop accumulates the bits and exits as soon as all bits are set
        or the input is exhausted */
@@ -117,6 +152,14 @@ returns @cpp false @ce or a @ref BitVector with no bits set.
 template<class T> inline auto isNan(const Corrade::Containers::StridedArrayView1D<const T>& range) -> decltype(isNan(std::declval<T>())) {
     if(range.isEmpty()) return {};
 
+    /* Contiguous Float scalars and vectors have a vectorized implementation */
+    constexpr UnsignedInt components = Implementation::BatchFloatComponents<T>::value;
+    if(components && range.isContiguous()) {
+        decltype(isNan(std::declval<T>())) out{};
+        Implementation::fromComponentMask(Implementation::isNanContiguous(static_cast<const Float*>(range.data()), range.size(), components), out);
+        return out;
+    }
+
     /* For scalars, this loop exits once any value is infinity. For vectors
        the loop accumulates the bits and exits as soon as all bits are set
        or the input is exhausted */
@@ -203,7 +246,19 @@ template<class T> inline T min(const Corrade::Containers::StridedArrayView1D<con
     if(range.isEmpty()) return {};
 
     std::pair<std::size_t, T> iOut = Implementation::firstNonNan(range, IsFloatingPoint<T>{}, IsVector<T>{});
-    for(++iOut.first; iOut.first != range.size(); ++iOut.first)
+    ++iOut.first;
+
+    /* Contiguous Float scalars and vectors have a vectorized implementation,
+       contiguous integer ranges go through a plain pointer so the compiler
+       can vectorize the loop */
+    constexpr UnsignedInt components = Implementation::BatchFloatComponents<T>::value;
+    if(components && range.isContiguous()) {
+        Implementation::minContiguous(static_cast<const Float*>(range.data()) + iOut.first*components, range.size() - iOut.first, components, reinterpret_cast<Float*>(&iOut.second));
+    } else if(IsIntegral<T>::value && range.isContiguous()) {
+        const T* const data = static_cast<const T*>(range.data());
+        for(; iOut.first != range.size(); ++iOut.first)
+            iOut.second = Math::min(iOut.second, data[iOut.first]);
+    } else for(; iOut.first != range.size(); ++iOut.first)
         iOut.second = Math::min(iOut.second, range[iOut.first]);
 
     return iOut.second;
@@ -248,7 +303,19 @@ template<class T> inline T max(const Corrade::Containers::StridedArrayView1D<con
     if(range.isEmpty()) return {};
 
     std::pair<std::size_t, T> iOut = Implementation::firstNonNan(range, IsFloatingPoint<T>{}, IsVector<T>{});
-    for(++iOut.first; iOut.first != range.size(); ++iOut.first)
+    ++iOut.first;
+
+    /* Contiguous Float scalars and vectors have a vectorized implementation,
+       contiguous integer ranges go through a plain pointer so the compiler
+       can vectorize the loop */
+    constexpr UnsignedInt components = Implementation::BatchFloatComponents<T>::value;
+    if(components && range.isContiguous()) {
+        Implementation::maxContiguous(static_cast<const Float*>(range.data()) + iOut.first*components, range.size() - iOut.first, components, reinterpret_cast<Float*>(&iOut.second));
+    } else if(IsIntegral<T>::value && range.isContiguous()) {
+        const T* const data = static_cast<const T*>(range.data());
+        for(; iOut.first != range.size(); ++iOut.first)
+            iOut.second = Math::max(iOut.second, data[iOut.first]);
+    } else for(; iOut.first != range.size(); ++iOut.first)
         iOut.second = Math::max(iOut.second, range[iOut.first]);
 
     return iOut.second;
@@ -283,11 +350,12 @@ template<class T, std::size_t size> inline T max(const T(&array)[size]) {
 }
 
 namespace Implementation {
+    /* Branchless so the loop in minmax() can get vectorized by the compiler.
+       Math::min() / Math::max() pick the first argument if the second is NaN,
+       so NaNs are skipped the same way as with the original comparisons. */
     template<class T> inline typename std::enable_if<IsScalar<T>::value, void>::type minmax(T& min, T& max, T value) {
-        if(value < min)
-            min = value;
-        else if(value > max)
-            max = value;
+        min = Math::min(min, value);
+        max = Math::max(max, value);
     }
     template<std::size_t size, class T> inline void minmax(Vector<size, T>& min, Vector<size, T>& max, const Vector<size, T>& value) {
         for(std::size_t i = 0; i != size; ++i)
@@ -309,7 +377,17 @@ template<class T> inline std::pair<T, T> minmax(const Corrade::Containers::Strid
 
     std::pair<std::size_t, T> iOut = Implementation::firstNonNan(range, IsFloatingPoint<T>{}, IsVector<T>{});
     T min{iOut.second}, max{iOut.second};
-    for(++iOut.first; iOut.first != range.size(); ++iOut.first)
+    ++iOut.first;
+
+    /* Same dispatch as in min() / max() */
+    constexpr UnsignedInt components = Implementation::BatchFloatComponents<T>::value;
+    if(components && range.isContiguous()) {
+        Implementation::minmaxContiguous(static_cast<const Float*>(range.data()) + iOut.first*components, range.size() - iOut.first, components, reinterpret_cast<Float*>(&min), reinterpret_cast<Float*>(&max));
+    } else if(IsIntegral<T>::value && range.isContiguous()) {
+        const T* const data = static_cast<const T*>(range.data());
+        for(; iOut.first != range.size(); ++iOut.first)
+            Implementation::minmax(min, max, data[iOut.first]);
+    } else for(; iOut.first != range.size(); ++iOut.first)
         Implementation::minmax(min, max, range[iOut.first]);
 
     return {min, max};
@@ -0,0 +1,279 @@
+#ifndef Magnum_Math_Implementation_lanes_h
+#define Magnum_Math_Implementation_lanes_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Types.h"
+
+#ifdef CORRADE_TARGET_SSE2
+#include <emmintrin.h>
+#elif defined(CORRADE_TARGET_NEON)
+#include <arm_neon.h>
+#else
+#include <Corrade/Utility/StlMath.h>
+#endif
+
+namespace Magnum { namespace Math { namespace Implementation {
+
+/* A minimal abstraction over a four-component float register so the batch
+   kernels are written just once. On x86 it's SSE2, on ARM NEON and a plain
+   struct elsewhere. Multiplications and additions are always kept separate,
+   so the kernels can reproduce the operation order of the per-element APIs
+   exactly. */
+#ifdef CORRADE_TARGET_SSE2
+typedef __m128 Lanes;
+
+inline Lanes lanesLoad4(const Float* data) {
+    return _mm_loadu_ps(data);
+}
+
+inline Lanes lanesLoad3(const Float* data) {
+    return _mm_setr_ps(data[0], data[1], data[2], 0.0f);
+}
+
+inline Lanes lanesBroadcast(const Float a) {
+    return _mm_set1_ps(a);
+}
+
+inline Lanes lanesMultiply(const Lanes a, const Float b) {
+    return _mm_mul_ps(a, _mm_set1_ps(b));
+}
+
+inline Lanes lanesAdd(const Lanes a, const Lanes b) {
+    return _mm_add_ps(a, b);
+}
+
+inline Lanes lanesDivideByW(const Lanes a) {
+    return _mm_div_ps(a, _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 3, 3)));
+}
+
+/* Same as Math::min(a[i], b[i]) and Math::max(a[i], b[i]), i.e. picking
+   a[i] if b[i] is NaN. The SSE instructions return the second operand if any
+   of them is NaN, thus the swapped order. */
+inline Lanes lanesMin(const Lanes a, const Lanes b) {
+    return _mm_min_ps(b, a);
+}
+
+inline Lanes lanesMax(const Lanes a, const Lanes b) {
+    return _mm_max_ps(b, a);
+}
+
+/* Bit i is set if a[i] < b[i] */
+inline UnsignedInt lanesLessMask(const Lanes a, const Lanes b) {
+    return _mm_movemask_ps(_mm_cmplt_ps(a, b));
+}
+
+/* Bit i is set if a[i] is NaN */
+inline UnsignedInt lanesNanMask(const Lanes a) {
+    return _mm_movemask_ps(_mm_cmpunord_ps(a, a));
+}
+
+/* Bit i is set if a[i] is a positive or negative infinity */
+inline UnsignedInt lanesInfMask(const Lanes a) {
+    const __m128 abs = _mm_and_ps(a, _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff)));
+    return _mm_movemask_ps(_mm_cmpeq_ps(abs, _mm_castsi128_ps(_mm_set1_epi32(0x7f800000))));
+}
+
+inline void lanesStore4(Float* const out, const Lanes a) {
+    _mm_storeu_ps(out, a);
+}
+
+inline void lanesStore3(Float* const out, const Lanes a) {
+    /* Not storing all four components as that would write past the end of
+       the last item */
+    _mm_storel_pi(reinterpret_cast<__m64*>(out), a);
+    _mm_store_ss(out + 2, _mm_movehl_ps(a, a));
+}
+#elif defined(CORRADE_TARGET_NEON)
+typedef float32x4_t Lanes;
+
+inline Lanes lanesLoad4(const Float* data) {
+    return vld1q_f32(data);
+}
+
+inline Lanes lanesLoad3(const Float* data) {
+    const Float padded[4]{data[0], data[1], data[2], 0.0f};
+    return vld1q_f32(padded);
+}
+
+inline Lanes lanesBroadcast(const Float a) {
+    return vdupq_n_f32(a);
+}
+
+inline Lanes lanesMultiply(const Lanes a, const Float b) {
+    /* Not using vmlaq_n_f32() for the whole multiply-add as it's not
+       guaranteed to round the same way as a separate multiply and add */
+    return vmulq_n_f32(a, b);
+}
+
+inline Lanes lanesAdd(const Lanes a, const Lanes b) {
+    return vaddq_f32(a, b);
+}
+
+inline Lanes lanesDivideByW(const Lanes a) {
+    #ifdef __aarch64__
+    return vdivq_f32(a, vdupq_n_f32(vgetq_lane_f32(a, 3)));
+    #else
+    /* ARMv7 NEON has only a reciprocal estimate, which isn't precise enough */
+    Float data[4];
+    vst1q_f32(data, a);
+    const Float w = data[3];
+    for(Float& i: data) i /= w;
+    return vld1q_f32(data);
+    #endif
+}
+
+/* Same as Math::min(a[i], b[i]) and Math::max(a[i], b[i]), i.e. picking
+   a[i] if b[i] is NaN. Not using vminq_f32() / vmaxq_f32() as those
+   propagate NaNs from both operands. */
+inline Lanes lanesMin(const Lanes a, const Lanes b) {
+    return vbslq_f32(vcltq_f32(b, a), b, a);
+}
+
+inline Lanes lanesMax(const Lanes a, const Lanes b) {
+    return vbslq_f32(vcltq_f32(a, b), b, a);
+}
+
+/* There's no movemask instruction on NEON, so the all-ones / all-zeros lanes
+   are masked with their bit values and summed together. Pairwise adds are
+   used instead of vaddvq_u32() as that one is only on AArch64. */
+inline UnsignedInt lanesMask(const uint32x4_t mask) {
+    const UnsignedInt bitValues[4]{1, 2, 4, 8};
+    const uint32x4_t bits = vandq_u32(mask, vld1q_u32(bitValues));
+    uint32x2_t sum = vadd_u32(vget_low_u32(bits), vget_high_u32(bits));
+    sum = vpadd_u32(sum, sum);
+    return vget_lane_u32(sum, 0);
+}
+
+/* Bit i is set if a[i] < b[i] */
+inline UnsignedInt lanesLessMask(const Lanes a, const Lanes b) {
+    return lanesMask(vcltq_f32(a, b));
+}
+
+/* Bit i is set if a[i] is NaN */
+inline UnsignedInt lanesNanMask(const Lanes a) {
+    return lanesMask(vmvnq_u32(vceqq_f32(a, a)));
+}
+
+/* Bit i is set if a[i] is a positive or negative infinity */
+inline UnsignedInt lanesInfMask(const Lanes a) {
+    return lanesMask(vceqq_f32(vabsq_f32(a), vreinterpretq_f32_u32(vdupq_n_u32(0x7f800000))));
+}
+
+inline void lanesStore4(Float* const out, const Lanes a) {
+    vst1q_f32(out, a);
+}
+
+inline void lanesStore3(Float* const out, const Lanes a) {
+    vst1_f32(out, vget_low_f32(a));
+    vst1q_lane_f32(out + 2, a, 2);
+}
+#else
+struct Lanes {
+    Float data[4];
+};
+
+inline Lanes lanesLoad4(const Float* data) {
+    return {{data[0], data[1], data[2], data[3]}};
+}
+
+inline Lanes lanesLoad3(const Float* data) {
+    return {{data[0], data[1], data[2], 0.0f}};
+}
+
+inline Lanes lanesBroadcast(const Float a) {
+    return {{a, a, a, a}};
+}
+
+inline Lanes lanesMultiply(const Lanes& a, const Float b) {
+    return {{a.data[0]*b, a.data[1]*b, a.data[2]*b, a.data[3]*b}};
+}
+
+inline Lanes lanesAdd(const Lanes& a, const Lanes& b) {
+    return {{a.data[0] + b.data[0], a.data[1] + b.data[1], a.data[2] + b.data[2], a.data[3] + b.data[3]}};
+}
+
+inline Lanes lanesDivideByW(const Lanes& a) {
+    const Float w = a.data[3];
+    return {{a.data[0]/w, a.data[1]/w, a.data[2]/w, a.data[3]/w}};
+}
+
+/* Same as Math::min(a[i], b[i]) and Math::max(a[i], b[i]), i.e. picking
+   a[i] if b[i] is NaN */
+inline Lanes lanesMin(const Lanes& a, const Lanes& b) {
+    Lanes out;
+    for(std::size_t i = 0; i != 4; ++i)
+        out.data[i] = b.data[i] < a.data[i] ? b.data[i] : a.data[i];
+    return out;
+}
+
+inline Lanes lanesMax(const Lanes& a, const Lanes& b) {
+    Lanes out;
+    for(std::size_t i = 0; i != 4; ++i)
+        out.data[i] = a.data[i] < b.data[i] ? b.data[i] : a.data[i];
+    return out;
+}
+
+/* Bit i is set if a[i] < b[i] */
+inline UnsignedInt lanesLessMask(const Lanes& a, const Lanes& b) {
+    return (a.data[0] < b.data[0] ? 1 : 0)|
+           (a.data[1] < b.data[1] ? 2 : 0)|
+           (a.data[2] < b.data[2] ? 4 : 0)|
+           (a.data[3] < b.data[3] ? 8 : 0);
+}
+
+/* Bit i is set if a[i] is NaN */
+inline UnsignedInt lanesNanMask(const Lanes& a) {
+    return (std::isnan(a.data[0]) ? 1 : 0)|
+           (std::isnan(a.data[1]) ? 2 : 0)|
+           (std::isnan(a.data[2]) ? 4 : 0)|
+           (std::isnan(a.data[3]) ? 8 : 0);
+}
+
+/* Bit i is set if a[i] is a positive or negative infinity */
+inline UnsignedInt lanesInfMask(const Lanes& a) {
+    return (std::isinf(a.data[0]) ? 1 : 0)|
+           (std::isinf(a.data[1]) ? 2 : 0)|
+           (std::isinf(a.data[2]) ? 4 : 0)|
+           (std::isinf(a.data[3]) ? 8 : 0);
+}
+
+inline void lanesStore4(Float* const out, const Lanes& a) {
+    out[0] = a.data[0];
+    out[1] = a.data[1];
+    out[2] = a.data[2];
+    out[3] = a.data[3];
+}
+
+inline void lanesStore3(Float* const out, const Lanes& a) {
+    out[0] = a.data[0];
+    out[1] = a.data[1];
+    out[2] = a.data[2];
+}
+#endif
+
+}}}
+
+#endif
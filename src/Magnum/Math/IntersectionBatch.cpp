@@ -0,0 +1,277 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "IntersectionBatch.h"
+
+#include <Corrade/Containers/BitArrayView.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Intersection.h"
+#include "Magnum/Math/Implementation/lanes.h"
+
+namespace Magnum { namespace Math { namespace Intersection {
+
+using namespace Math::Implementation;
+
+namespace {
+
+/* Frustum planes in a structure-of-arrays layout, with the six planes padded
+   to two groups of four. The padding planes are all zeros, which makes them
+   never reject anything with the comparisons used below. The W component is
+   multiplied by a factor that differs for each primitive type, in order to
+   match the per-element APIs. */
+struct FrustumLanes {
+    explicit FrustumLanes(const Frustum<Float>& frustum, const Float wScale) {
+        Float data[7][8]{};
+        for(std::size_t i = 0; i != 6; ++i) {
+            const Vector4<Float>& plane = frustum[i];
+            data[0][i] = plane.x();
+            data[1][i] = plane.y();
+            data[2][i] = plane.z();
+            data[3][i] = wScale*plane.w();
+            data[4][i] = Math::abs(plane.x());
+            data[5][i] = Math::abs(plane.y());
+            data[6][i] = Math::abs(plane.z());
+        }
+
+        for(std::size_t i = 0; i != 2; ++i) {
+            x[i] = lanesLoad4(data[0] + i*4);
+            y[i] = lanesLoad4(data[1] + i*4);
+            z[i] = lanesLoad4(data[2] + i*4);
+            w[i] = lanesLoad4(data[3] + i*4);
+            absX[i] = lanesLoad4(data[4] + i*4);
+            absY[i] = lanesLoad4(data[5] + i*4);
+            absZ[i] = lanesLoad4(data[6] + i*4);
+        }
+    }
+
+    Lanes x[2], y[2], z[2], w[2], absX[2], absY[2], absZ[2];
+};
+
+/* Same as sphereFrustum(), with W in the lanes being just the plane W. Bit i
+   of the result is set if plane i rejects the sphere. */
+UnsignedInt sphereRejectingPlanes(const FrustumLanes& planes, const Vector3<Float>& center, const Float radius) {
+    const Lanes negativeRadiusSq = lanesBroadcast(-(radius*radius));
+
+    UnsignedInt out = 0;
+    for(std::size_t i = 0; i != 2; ++i) {
+        const Lanes distance = lanesAdd(lanesAdd(lanesAdd(
+            lanesMultiply(planes.x[i], center.x()),
+            lanesMultiply(planes.y[i], center.y())),
+            lanesMultiply(planes.z[i], center.z())),
+            planes.w[i]);
+        out |= lanesLessMask(distance, negativeRadiusSq) << i*4;
+    }
+
+    return out;
+}
+
+bool sphereRejectedBy(const Vector4<Float>& plane, const Vector3<Float>& center, const Float radius) {
+    return Distance::pointPlaneScaled(center, plane) < -(radius*radius);
+}
+
+/* Same as aabbFrustum() and rangeFrustum(), with W in the lanes being the
+   plane W multiplied by -1 or -2, respectively */
+UnsignedInt boxRejectingPlanes(const FrustumLanes& planes, const Vector3<Float>& center, const Vector3<Float>& extent) {
+    UnsignedInt out = 0;
+    for(std::size_t i = 0; i != 2; ++i) {
+        const Lanes d = lanesAdd(lanesAdd(
+            lanesMultiply(planes.x[i], center.x()),
+            lanesMultiply(planes.y[i], center.y())),
+            lanesMultiply(planes.z[i], center.z()));
+        const Lanes r = lanesAdd(lanesAdd(
+            lanesMultiply(planes.absX[i], extent.x()),
+            lanesMultiply(planes.absY[i], extent.y())),
+            lanesMultiply(planes.absZ[i], extent.z()));
+        out |= lanesLessMask(lanesAdd(d, r), planes.w[i]) << i*4;
+    }
+
+    return out;
+}
+
+bool boxRejectedBy(const Vector4<Float>& plane, const Float wScale, const Vector3<Float>& center, const Vector3<Float>& extent) {
+    const Float d = Math::dot(center, plane.xyz());
+    const Float r = Math::dot(extent, Math::abs(plane.xyz()));
+    return d + r < wScale*plane.w();
+}
+
+/* Common loop for all frustum variants. If a plane cache is supplied, the
+   plane that rejected the item last time is tested first, and if it rejects
+   it again, the remaining planes don't need to be tested at all. */
+template<class RejectingPlanes, class RejectedBy> std::size_t frustumInto(const std::size_t count, const Frustum<Float>& frustum, const Corrade::Containers::MutableBitArrayView intersects, const Corrade::Containers::StridedArrayView1D<UnsignedByte>* const planeCache, const RejectingPlanes rejectingPlanes, const RejectedBy rejectedBy) {
+    std::size_t intersectionCount = 0;
+    for(std::size_t i = 0; i != count; ++i) {
+        if(planeCache) {
+            const UnsignedByte plane = (*planeCache)[i];
+            if(plane < 6 && rejectedBy(frustum[plane], i)) {
+                intersects.reset(i);
+                continue;
+            }
+        }
+
+        const UnsignedInt planes = rejectingPlanes(i);
+        if(!planes) {
+            intersects.set(i);
+            ++intersectionCount;
+            continue;
+        }
+
+        intersects.reset(i);
+        if(planeCache) {
+            UnsignedByte plane = 0;
+            while(!(planes & (1 << plane))) ++plane;
+            (*planeCache)[i] = plane;
+        }
+    }
+
+    return intersectionCount;
+}
+
+std::size_t sphereFrustumIntoImplementation(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& sphereCenters, const Corrade::Containers::StridedArrayView1D<const Float>& sphereRadii, const Frustum<Float>& frustum, const Corrade::Containers::MutableBitArrayView intersects, const Corrade::Containers::StridedArrayView1D<UnsignedByte>* const planeCache) {
+    CORRADE_ASSERT(sphereRadii.size() == sphereCenters.size() && intersects.size() == sphereCenters.size(),
+        "Math::Intersection::sphereFrustumInto(): expected" << sphereCenters.size() << "sphere radii and output bits but got" << sphereRadii.size() << "and" << intersects.size(), {});
+
+    const FrustumLanes planes{frustum, 1.0f};
+    return frustumInto(sphereCenters.size(), frustum, intersects, planeCache,
+        [&](const std::size_t i) {
+            return sphereRejectingPlanes(planes, sphereCenters[i], sphereRadii[i]);
+        },
+        [&](const Vector4<Float>& plane, const std::size_t i) {
+            return sphereRejectedBy(plane, sphereCenters[i], sphereRadii[i]);
+        });
+}
+
+std::size_t rangeFrustumIntoImplementation(const Corrade::Containers::StridedArrayView1D<const Range3D<Float>>& ranges, const Frustum<Float>& frustum, const Corrade::Containers::MutableBitArrayView intersects, const Corrade::Containers::StridedArrayView1D<UnsignedByte>* const planeCache) {
+    CORRADE_ASSERT(intersects.size() == ranges.size(),
+        "Math::Intersection::rangeFrustumInto(): expected" << ranges.size() << "output bits but got" << intersects.size(), {});
+
+    /* Like in rangeFrustum(), converting to center/extent without the
+       division by 2 and comparing to -2*plane.w() instead */
+    const FrustumLanes planes{frustum, -2.0f};
+    return frustumInto(ranges.size(), frustum, intersects, planeCache,
+        [&](const std::size_t i) {
+            const Range3D<Float>& range = ranges[i];
+            return boxRejectingPlanes(planes, range.min() + range.max(), range.max() - range.min());
+        },
+        [&](const Vector4<Float>& plane, const std::size_t i) {
+            const Range3D<Float>& range = ranges[i];
+            return boxRejectedBy(plane, -2.0f, range.min() + range.max(), range.max() - range.min());
+        });
+}
+
+std::size_t aabbFrustumIntoImplementation(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& aabbCenters, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& aabbExtents, const Frustum<Float>& frustum, const Corrade::Containers::MutableBitArrayView intersects, const Corrade::Containers::StridedArrayView1D<UnsignedByte>* const planeCache) {
+    CORRADE_ASSERT(aabbExtents.size() == aabbCenters.size() && intersects.size() == aabbCenters.size(),
+        "Math::Intersection::aabbFrustumInto(): expected" << aabbCenters.size() << "AABB extents and output bits but got" << aabbExtents.size() << "and" << intersects.size(), {});
+
+    const FrustumLanes planes{frustum, -1.0f};
+    return frustumInto(aabbCenters.size(), frustum, intersects, planeCache,
+        [&](const std::size_t i) {
+            return boxRejectingPlanes(planes, aabbCenters[i], aabbExtents[i]);
+        },
+        [&](const Vector4<Float>& plane, const std::size_t i) {
+            return boxRejectedBy(plane, -1.0f, aabbCenters[i], aabbExtents[i]);
+        });
+}
+
+}
+
+std::size_t sphereFrustumInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& sphereCenters, const Corrade::Containers::StridedArrayView1D<const Float>& sphereRadii, const Frustum<Float>& frustum, const Corrade::Containers::MutableBitArrayView intersects) {
+    return sphereFrustumIntoImplementation(sphereCenters, sphereRadii, frustum, intersects, nullptr);
+}
+
+std::size_t sphereFrustumInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& sphereCenters, const Corrade::Containers::StridedArrayView1D<const Float>& sphereRadii, const Frustum<Float>& frustum, const Corrade::Containers::MutableBitArrayView intersects, const Corrade::Containers::StridedArrayView1D<UnsignedByte>& planeCache) {
+    CORRADE_ASSERT(planeCache.size() == sphereCenters.size(),
+        "Math::Intersection::sphereFrustumInto(): expected" << sphereCenters.size() << "plane cache items but got" << planeCache.size(), {});
+    return sphereFrustumIntoImplementation(sphereCenters, sphereRadii, frustum, intersects, &planeCache);
+}
+
+std::size_t rangeFrustumInto(const Corrade::Containers::StridedArrayView1D<const Range3D<Float>>& ranges, const Frustum<Float>& frustum, const Corrade::Containers::MutableBitArrayView intersects) {
+    return rangeFrustumIntoImplementation(ranges, frustum, intersects, nullptr);
+}
+
+std::size_t rangeFrustumInto(const Corrade::Containers::StridedArrayView1D<const Range3D<Float>>& ranges, const Frustum<Float>& frustum, const Corrade::Containers::MutableBitArrayView intersects, const Corrade::Containers::StridedArrayView1D<UnsignedByte>& planeCache) {
+    CORRADE_ASSERT(planeCache.size() == ranges.size(),
+        "Math::Intersection::rangeFrustumInto(): expected" << ranges.size() << "plane cache items but got" << planeCache.size(), {});
+    return rangeFrustumIntoImplementation(ranges, frustum, intersects, &planeCache);
+}
+
+std::size_t aabbFrustumInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& aabbCenters, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& aabbExtents, const Frustum<Float>& frustum, const Corrade::Containers::MutableBitArrayView intersects) {
+    return aabbFrustumIntoImplementation(aabbCenters, aabbExtents, frustum, intersects, nullptr);
+}
+
+std::size_t aabbFrustumInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& aabbCenters, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& aabbExtents, const Frustum<Float>& frustum, const Corrade::Containers::MutableBitArrayView intersects, const Corrade::Containers::StridedArrayView1D<UnsignedByte>& planeCache) {
+    CORRADE_ASSERT(planeCache.size() == aabbCenters.size(),
+        "Math::Intersection::aabbFrustumInto(): expected" << aabbCenters.size() << "plane cache items but got" << planeCache.size(), {});
+    return aabbFrustumIntoImplementation(aabbCenters, aabbExtents, frustum, intersects, &planeCache);
+}
+
+std::size_t sphereConeViewInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& sphereCenters, const Corrade::Containers::StridedArrayView1D<const Float>& sphereRadii, const Matrix4<Float>& coneView, const Rad<Float> coneAngle, const Corrade::Containers::MutableBitArrayView intersects) {
+    const Rad<Float> halfAngle = coneAngle*0.5f;
+    return sphereConeViewInto(sphereCenters, sphereRadii, coneView, Math::sin(halfAngle), Math::tan(halfAngle), intersects);
+}
+
+std::size_t sphereConeViewInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& sphereCenters, const Corrade::Containers::StridedArrayView1D<const Float>& sphereRadii, const Matrix4<Float>& coneView, const Float sinAngle, const Float tanAngle, const Corrade::Containers::MutableBitArrayView intersects) {
+    CORRADE_ASSERT(sphereRadii.size() == sphereCenters.size() && intersects.size() == sphereCenters.size(),
+        "Math::Intersection::sphereConeViewInto(): expected" << sphereCenters.size() << "sphere radii and output bits but got" << sphereRadii.size() << "and" << intersects.size(), {});
+    CORRADE_ASSERT(coneView.isRigidTransformation(),
+        "Math::Intersection::sphereConeViewInto(): coneView does not represent a rigid transformation:" << Corrade::Utility::Debug::newline << coneView, {});
+
+    /* Transforming the centers the same way as transformPointsInto(), the
+       rest is the same as in sphereConeView() */
+    const Lanes c0 = lanesLoad4(coneView[0].data());
+    const Lanes c1 = lanesLoad4(coneView[1].data());
+    const Lanes c2 = lanesLoad4(coneView[2].data());
+    const Lanes c3 = lanesLoad4(coneView[3].data());
+    std::size_t intersectionCount = 0;
+    for(std::size_t i = 0, max = sphereCenters.size(); i != max; ++i) {
+        const Vector3<Float>& sphereCenter = sphereCenters[i];
+        const Float sphereRadius = sphereRadii[i];
+
+        Vector3<Float> center{NoInit};
+        lanesStore3(center.data(), lanesDivideByW(lanesAdd(lanesAdd(lanesAdd(
+            lanesMultiply(c0, sphereCenter.x()),
+            lanesMultiply(c1, sphereCenter.y())),
+            lanesMultiply(c2, sphereCenter.z())),
+            c3)));
+
+        bool intersection;
+        if(-center.z() > -sphereRadius*sinAngle) {
+            const Float coneRadius = tanAngle*(center.z() - sphereRadius/sinAngle);
+            intersection = center.xy().dot() <= coneRadius*coneRadius;
+        } else {
+            intersection = center.dot() <= sphereRadius*sphereRadius;
+        }
+
+        if(intersection) {
+            intersects.set(i);
+            ++intersectionCount;
+        } else intersects.reset(i);
+    }
+
+    return intersectionCount;
+}
+
+}}}
@@ -0,0 +1,215 @@
+#ifndef Magnum_Math_IntersectionBatch_h
+#define Magnum_Math_IntersectionBatch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::Math::Intersection::sphereFrustumInto(), @ref Magnum::Math::Intersection::rangeFrustumInto(), @ref Magnum::Math::Intersection::aabbFrustumInto(), @ref Magnum::Math::Intersection::sphereConeViewInto()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Types.h"
+#include "Magnum/visibility.h"
+#include "Magnum/Math/Math.h"
+
+namespace Magnum { namespace Math { namespace Intersection {
+
+/**
+@{ @name Batch intersection functions
+
+These functions test an unbounded range of primitives against a single frustum
+or cone and write the result into a bit array, as opposed to the per-element
+@ref sphereFrustum() and friends. On x86 the frustum tests use SSE2 to test
+all six planes at once, on ARM NEON, with a scalar fallback everywhere else.
+The result is the same as when calling the per-element functions in a loop, up
+to differences caused by the compiler fusing multiplications and additions in
+the scalar code.
+
+The frustum variants optionally take a *plane cache*, which implements the
+plane-coherency optimization --- for every item it remembers the plane that
+rejected it the last time and tests against that plane first on the next call.
+Objects that stay outside of the frustum over consecutive frames are then
+rejected with just a single plane test:
+
+@snippet MagnumMath.cpp Intersection-batch-plane-cache
+*/
+
+/**
+@brief Intersection of spheres and a frustum
+@param[in]  sphereCenters   Sphere centers
+@param[in]  sphereRadii     Sphere radii
+@param[in]  frustum         Frustum planes with normals pointing outwards
+@param[out] intersects      Where to put the results
+@return Count of spheres intersecting the frustum
+@m_since_latest
+
+Bit @cpp i @ce of @p intersects is set if
+@ref sphereFrustum(const Vector3<T>&, T, const Frustum<T>&) returns
+@cpp true @ce for @cpp sphereCenters[i] @ce and @cpp sphereRadii[i] @ce and
+cleared otherwise. Expects that @p sphereRadii and @p intersects have the same
+size as @p sphereCenters.
+*/
+MAGNUM_EXPORT std::size_t sphereFrustumInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& sphereCenters, const Corrade::Containers::StridedArrayView1D<const Float>& sphereRadii, const Frustum<Float>& frustum, Corrade::Containers::MutableBitArrayView intersects);
+
+/**
+@brief Intersection of spheres and a frustum using a plane cache
+@param[in]      sphereCenters   Sphere centers
+@param[in]      sphereRadii     Sphere radii
+@param[in]      frustum         Frustum planes with normals pointing outwards
+@param[out]     intersects      Where to put the results
+@param[in,out]  planeCache      Index of the plane that rejected each sphere
+    the last time
+@return Count of spheres intersecting the frustum
+@m_since_latest
+
+Like @ref sphereFrustumInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>&, const Corrade::Containers::StridedArrayView1D<const Float>&, const Frustum<Float>&, Corrade::Containers::MutableBitArrayView),
+but for each item first tests the plane stored in @p planeCache. If it doesn't
+reject the sphere, all planes are tested and if any of them rejects the
+sphere, its index is stored in @p planeCache. Values outside of the
+@cpp [0, 5] @ce range are ignored, so a zero-initialized cache is a valid
+starting point. Expects that @p planeCache has the same size as
+@p sphereCenters.
+*/
+MAGNUM_EXPORT std::size_t sphereFrustumInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& sphereCenters, const Corrade::Containers::StridedArrayView1D<const Float>& sphereRadii, const Frustum<Float>& frustum, Corrade::Containers::MutableBitArrayView intersects, const Corrade::Containers::StridedArrayView1D<UnsignedByte>& planeCache);
+
+/**
+@brief Intersection of ranges and a frustum
+@param[in]  ranges      Ranges
+@param[in]  frustum     Frustum planes with normals pointing outwards
+@param[out] intersects  Where to put the results
+@return Count of ranges intersecting the frustum
+@m_since_latest
+
+Bit @cpp i @ce of @p intersects is set if
+@ref rangeFrustum(const Range3D<T>&, const Frustum<T>&) returns @cpp true @ce
+for @cpp ranges[i] @ce and cleared otherwise. Expects that @p intersects has
+the same size as @p ranges.
+@see @ref aabbFrustumInto()
+*/
+MAGNUM_EXPORT std::size_t rangeFrustumInto(const Corrade::Containers::StridedArrayView1D<const Range3D<Float>>& ranges, const Frustum<Float>& frustum, Corrade::Containers::MutableBitArrayView intersects);
+
+/**
+@brief Intersection of ranges and a frustum using a plane cache
+@param[in]      ranges      Ranges
+@param[in]      frustum     Frustum planes with normals pointing outwards
+@param[out]     intersects  Where to put the results
+@param[in,out]  planeCache  Index of the plane that rejected each range the
+    last time
+@return Count of ranges intersecting the frustum
+@m_since_latest
+
+Like @ref rangeFrustumInto(const Corrade::Containers::StridedArrayView1D<const Range3D<Float>>&, const Frustum<Float>&, Corrade::Containers::MutableBitArrayView),
+but with the plane cache used the same way as in
+@ref sphereFrustumInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>&, const Corrade::Containers::StridedArrayView1D<const Float>&, const Frustum<Float>&, Corrade::Containers::MutableBitArrayView, const Corrade::Containers::StridedArrayView1D<UnsignedByte>&).
+Expects that @p planeCache has the same size as @p ranges.
+*/
+MAGNUM_EXPORT std::size_t rangeFrustumInto(const Corrade::Containers::StridedArrayView1D<const Range3D<Float>>& ranges, const Frustum<Float>& frustum, Corrade::Containers::MutableBitArrayView intersects, const Corrade::Containers::StridedArrayView1D<UnsignedByte>& planeCache);
+
+/**
+@brief Intersection of axis-aligned boxes and a frustum
+@param[in]  aabbCenters Centers of the AABBs
+@param[in]  aabbExtents (Half-)extents of the AABBs
+@param[in]  frustum     Frustum planes with normals pointing outwards
+@param[out] intersects  Where to put the results
+@return Count of boxes intersecting the frustum
+@m_since_latest
+
+Bit @cpp i @ce of @p intersects is set if
+@ref aabbFrustum(const Vector3<T>&, const Vector3<T>&, const Frustum<T>&)
+returns @cpp true @ce for @cpp aabbCenters[i] @ce and @cpp aabbExtents[i] @ce
+and cleared otherwise. Expects that @p aabbExtents and @p intersects have the
+same size as @p aabbCenters.
+@see @ref rangeFrustumInto()
+*/
+MAGNUM_EXPORT std::size_t aabbFrustumInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& aabbCenters, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& aabbExtents, const Frustum<Float>& frustum, Corrade::Containers::MutableBitArrayView intersects);
+
+/**
+@brief Intersection of axis-aligned boxes and a frustum using a plane cache
+@param[in]      aabbCenters Centers of the AABBs
+@param[in]      aabbExtents (Half-)extents of the AABBs
+@param[in]      frustum     Frustum planes with normals pointing outwards
+@param[out]     intersects  Where to put the results
+@param[in,out]  planeCache  Index of the plane that rejected each box the
+    last time
+@return Count of boxes intersecting the frustum
+@m_since_latest
+
+Like @ref aabbFrustumInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>&, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>&, const Frustum<Float>&, Corrade::Containers::MutableBitArrayView),
+but with the plane cache used the same way as in
+@ref sphereFrustumInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>&, const Corrade::Containers::StridedArrayView1D<const Float>&, const Frustum<Float>&, Corrade::Containers::MutableBitArrayView, const Corrade::Containers::StridedArrayView1D<UnsignedByte>&).
+Expects that @p planeCache has the same size as @p aabbCenters.
+*/
+MAGNUM_EXPORT std::size_t aabbFrustumInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& aabbCenters, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& aabbExtents, const Frustum<Float>& frustum, Corrade::Containers::MutableBitArrayView intersects, const Corrade::Containers::StridedArrayView1D<UnsignedByte>& planeCache);
+
+/**
+@brief Intersection of spheres and a cone view
+@param[in]  sphereCenters   Sphere centers
+@param[in]  sphereRadii     Sphere radii
+@param[in]  coneView        View matrix with translation and rotation of the
+    cone
+@param[in]  coneAngle       Apex angle of the cone
+    (@f$ 0 < \Theta < \pi @f$)
+@param[out] intersects      Where to put the results
+@return Count of spheres intersecting the cone
+@m_since_latest
+
+Precomputes a portion of the intersection equation from @p coneAngle and calls
+@ref sphereConeViewInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>&, const Corrade::Containers::StridedArrayView1D<const Float>&, const Matrix4<Float>&, Float, Float, Corrade::Containers::MutableBitArrayView).
+*/
+MAGNUM_EXPORT std::size_t sphereConeViewInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& sphereCenters, const Corrade::Containers::StridedArrayView1D<const Float>& sphereRadii, const Matrix4<Float>& coneView, Rad<Float> coneAngle, Corrade::Containers::MutableBitArrayView intersects);
+
+/**
+@brief Intersection of spheres and a cone view using precomputed values
+@param[in]  sphereCenters   Sphere centers
+@param[in]  sphereRadii     Sphere radii
+@param[in]  coneView        View matrix with translation and rotation of the
+    cone
+@param[in]  sinAngle        Precomputed sine of half the cone's opening angle
+@param[in]  tanAngle        Precomputed tangent of half the cone's opening
+    angle
+@param[out] intersects      Where to put the results
+@return Count of spheres intersecting the cone
+@m_since_latest
+
+Bit @cpp i @ce of @p intersects is set if
+@ref sphereConeView(const Vector3<T>&, T, const Matrix4<T>&, T, T) returns
+@cpp true @ce for @cpp sphereCenters[i] @ce and @cpp sphereRadii[i] @ce and
+cleared otherwise. The rigid transformation check on @p coneView is done just
+once for the whole batch. Expects that @p sphereRadii and @p intersects have
+the same size as @p sphereCenters.
+*/
+MAGNUM_EXPORT std::size_t sphereConeViewInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& sphereCenters, const Corrade::Containers::StridedArrayView1D<const Float>& sphereRadii, const Matrix4<Float>& coneView, Float sinAngle, Float tanAngle, Corrade::Containers::MutableBitArrayView intersects);
+
+/* Since 1.8.17, the original short-hand group closing doesn't work anymore.
+   FFS. */
+/**
+ * @}
+ */
+
+}}}
+
+#endif
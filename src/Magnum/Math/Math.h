@@ -26,10 +26,11 @@
 */
 
 /** @file
- * @brief Forward declarations for the @ref Magnum::Math namespace
+ * @brief Forward declarations for the @ref Magnum::Math namespace, macro @ref MAGNUM_CONSTEXPR14
  */
 
 #include <cstddef>
+#include <Corrade/Corrade.h>
 
 #include "Magnum/Types.h"
 
@@ -37,6 +38,29 @@
 #include <Corrade/Utility/Macros.h>
 #endif
 
+/**
+@brief C++14 constexpr
+@m_since_latest
+
+Expands to @cpp constexpr @ce if compiling as C++14 or newer, empty otherwise.
+Used on math functions that need loops, local variables or in-place
+modification and thus can't be @cpp constexpr @ce under the C++11 rules. With
+C++14 and newer, constant vectors, matrices and quaternions calculated with
+such functions can then be evaluated at compile time. MSVC 2015 is excluded as
+it doesn't implement the relaxed rules.
+
+@snippet MagnumMath-cpp14.cpp MAGNUM_CONSTEXPR14
+
+Functions that need @ref std::sqrt() or trigonometry, such as
+@ref Matrix4::lookAt() or @ref Matrix4::perspectiveProjection(Rad<T>, T, T, T),
+are not @cpp constexpr @ce even in C++14.
+*/
+#if CORRADE_CXX_STANDARD >= 201402 && !defined(CORRADE_MSVC2015_COMPATIBILITY)
+#define MAGNUM_CONSTEXPR14 constexpr
+#else
+#define MAGNUM_CONSTEXPR14
+#endif
+
 namespace Magnum { namespace Math {
 
 /** @todo Denormals to zero */
@@ -85,6 +109,8 @@ template<class> class Vector2;
 template<class> class Vector3;
 template<class> class Vector4;
 
+template<class, std::size_t> class Wide;
+
 template<class> struct ColorHsv;
 template<class> class Color3;
 template<class> class Color4;
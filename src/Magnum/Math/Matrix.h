@@ -140,7 +140,7 @@ template<std::size_t size, class T> class Matrix: public RectangularMatrix<size,
          * tr(A) = \sum_{i=1}^n a_{i,i}
          * @f]
          */
-        T trace() const { return RectangularMatrix<size, size, T>::diagonal().sum(); }
+        MAGNUM_CONSTEXPR14 T trace() const { return RectangularMatrix<size, size, T>::diagonal().sum(); }
 
         /**
          * @brief Matrix without given column and row
@@ -166,7 +166,7 @@ template<std::size_t size, class T> class Matrix: public RectangularMatrix<size,
          *
          * @see @ref cofactor(), @ref adjugate(), @ref determinant()
          */
-        Matrix<size-1, T> ij(std::size_t skipCol, std::size_t skipRow) const;
+        MAGNUM_CONSTEXPR14 Matrix<size-1, T> ij(std::size_t skipCol, std::size_t skipRow) const;
 
         /**
          * @brief Cofactor
@@ -199,7 +199,7 @@ template<std::size_t size, class T> class Matrix: public RectangularMatrix<size,
          *
          * @see @ref ij(), @ref comatrix(), @ref adjugate()
          */
-        T cofactor(std::size_t col, std::size_t row) const;
+        MAGNUM_CONSTEXPR14 T cofactor(std::size_t col, std::size_t row) const;
 
         /**
          * @brief Matrix of cofactors
@@ -218,7 +218,7 @@ template<std::size_t size, class T> class Matrix: public RectangularMatrix<size,
          *
          * @see @ref Matrix4::normalMatrix(), @ref ij(), @ref adjugate()
          */
-        Matrix<size, T> comatrix() const;
+        MAGNUM_CONSTEXPR14 Matrix<size, T> comatrix() const;
 
         /**
          * @brief Adjugate matrix
@@ -227,7 +227,7 @@ template<std::size_t size, class T> class Matrix: public RectangularMatrix<size,
          * @f$ adj(A) @f$. Transpose of a @ref comatrix(), used for example to
          * calculate an @ref inverted() matrix.
          */
-        Matrix<size, T> adjugate() const;
+        MAGNUM_CONSTEXPR14 Matrix<size, T> adjugate() const;
 
         /**
          * @brief Determinant
@@ -245,7 +245,7 @@ template<std::size_t size, class T> class Matrix: public RectangularMatrix<size,
          *
          * @see @ref ij()
          */
-        T determinant() const { return Implementation::MatrixDeterminant<size, T>()(*this); }
+        MAGNUM_CONSTEXPR14 T determinant() const { return Implementation::MatrixDeterminant<size, T>()(*this); }
 
         /**
          * @brief Inverted matrix
@@ -261,7 +261,7 @@ template<std::size_t size, class T> class Matrix: public RectangularMatrix<size,
          *      @ref Matrix4::normalMatrix()
          * @m_keyword{inverse(),GLSL inverse(),}
          */
-        Matrix<size, T> inverted() const;
+        MAGNUM_CONSTEXPR14 Matrix<size, T> inverted() const;
 
         /**
          * @brief Inverted orthogonal matrix
@@ -282,16 +282,16 @@ template<std::size_t size, class T> class Matrix: public RectangularMatrix<size,
 
         #ifndef DOXYGEN_GENERATING_OUTPUT
         /* Reimplementation of functions to return correct type */
-        Matrix<size, T> operator*(const Matrix<size, T>& other) const {
+        MAGNUM_CONSTEXPR14 Matrix<size, T> operator*(const Matrix<size, T>& other) const {
             return RectangularMatrix<size, size, T>::operator*(other);
         }
-        template<std::size_t otherCols> RectangularMatrix<otherCols, size, T> operator*(const RectangularMatrix<otherCols, size, T>& other) const {
+        template<std::size_t otherCols> MAGNUM_CONSTEXPR14 RectangularMatrix<otherCols, size, T> operator*(const RectangularMatrix<otherCols, size, T>& other) const {
             return RectangularMatrix<size, size, T>::operator*(other);
         }
-        Vector<size, T> operator*(const Vector<size, T>& other) const {
+        MAGNUM_CONSTEXPR14 Vector<size, T> operator*(const Vector<size, T>& other) const {
             return RectangularMatrix<size, size, T>::operator*(other);
         }
-        Matrix<size, T> transposed() const {
+        MAGNUM_CONSTEXPR14 Matrix<size, T> transposed() const {
             return RectangularMatrix<size, size, T>::transposed();
         }
         MAGNUM_RECTANGULARMATRIX_SUBCLASS_IMPLEMENTATION(size, size, Matrix<size, T>)
@@ -349,23 +349,23 @@ MAGNUM_MATRIX_OPERATOR_IMPLEMENTATION(Matrix<size, T>)
     constexpr const VectorType<T> operator[](std::size_t col) const {       \
         return VectorType<T>(Matrix<size, T>::operator[](col));             \
     }                                                                       \
-    VectorType<T> row(std::size_t row) const {                              \
+    MAGNUM_CONSTEXPR14 VectorType<T> row(std::size_t row) const {           \
         return VectorType<T>(Matrix<size, T>::row(row));                    \
     }                                                                       \
                                                                             \
-    Type<T> operator*(const Matrix<size, T>& other) const {                 \
+    MAGNUM_CONSTEXPR14 Type<T> operator*(const Matrix<size, T>& other) const { \
         return Matrix<size, T>::operator*(other);                           \
     }                                                                       \
-    template<std::size_t otherCols> RectangularMatrix<otherCols, size, T> operator*(const RectangularMatrix<otherCols, size, T>& other) const { \
+    template<std::size_t otherCols> MAGNUM_CONSTEXPR14 RectangularMatrix<otherCols, size, T> operator*(const RectangularMatrix<otherCols, size, T>& other) const { \
         return Matrix<size, T>::operator*(other);                           \
     }                                                                       \
-    VectorType<T> operator*(const Vector<size, T>& other) const {           \
+    MAGNUM_CONSTEXPR14 VectorType<T> operator*(const Vector<size, T>& other) const { \
         return Matrix<size, T>::operator*(other);                           \
     }                                                                       \
                                                                             \
-    Type<T> transposed() const { return Matrix<size, T>::transposed(); }    \
+    MAGNUM_CONSTEXPR14 Type<T> transposed() const { return Matrix<size, T>::transposed(); } \
     constexpr VectorType<T> diagonal() const { return Matrix<size, T>::diagonal(); } \
-    Type<T> inverted() const { return Matrix<size, T>::inverted(); }        \
+    MAGNUM_CONSTEXPR14 Type<T> inverted() const { return Matrix<size, T>::inverted(); } \
     Type<T> invertedOrthogonal() const {                                    \
         return Matrix<size, T>::invertedOrthogonal();                       \
     }
@@ -373,7 +373,7 @@ MAGNUM_MATRIX_OPERATOR_IMPLEMENTATION(Matrix<size, T>)
 namespace Implementation {
 
 template<std::size_t size, class T> struct MatrixDeterminant {
-    T operator()(const Matrix<size, T>& m) {
+    MAGNUM_CONSTEXPR14 T operator()(const Matrix<size, T>& m) const {
         T out(0);
 
         /* Using ._data[] instead of [] to avoid function call indirection on
@@ -384,7 +384,7 @@ template<std::size_t size, class T> struct MatrixDeterminant {
         return out;
     }
 
-    T operator()(const Matrix<size + 1, T>& m, const std::size_t skipCol, const std::size_t skipRow) {
+    MAGNUM_CONSTEXPR14 T operator()(const Matrix<size + 1, T>& m, const std::size_t skipCol, const std::size_t skipRow) const {
         return m.ij(skipCol, skipRow).determinant();
     }
 };
@@ -470,8 +470,9 @@ template<std::size_t size, class T> bool Matrix<size, T>::isOrthogonal() const {
     return true;
 }
 
-template<std::size_t size, class T> Matrix<size-1, T> Matrix<size, T>::ij(const std::size_t skipCol, const std::size_t skipRow) const {
-    Matrix<size-1, T> out{Magnum::NoInit};
+template<std::size_t size, class T> MAGNUM_CONSTEXPR14 Matrix<size-1, T> Matrix<size, T>::ij(const std::size_t skipCol, const std::size_t skipRow) const {
+    /* Not NoInit in order to be usable in a C++14 constexpr context */
+    Matrix<size-1, T> out{ZeroInit};
 
     /* Using ._data[] instead of [] to avoid function call indirection on debug
        builds (saves a lot, yet doesn't obfuscate too much) */
@@ -484,12 +485,12 @@ template<std::size_t size, class T> Matrix<size-1, T> Matrix<size, T>::ij(const
     return out;
 }
 
-template<std::size_t size, class T> T Matrix<size, T>::cofactor(std::size_t col, std::size_t row) const {
+template<std::size_t size, class T> MAGNUM_CONSTEXPR14 T Matrix<size, T>::cofactor(std::size_t col, std::size_t row) const {
     return (((row+col) & 1) ? -1 : 1)*Implementation::MatrixDeterminant<size - 1, T>()(*this, col, row);
 }
 
-template<std::size_t size, class T> Matrix<size, T> Matrix<size, T>::comatrix() const {
-    Matrix<size, T> out{Magnum::NoInit};
+template<std::size_t size, class T> MAGNUM_CONSTEXPR14 Matrix<size, T> Matrix<size, T>::comatrix() const {
+    Matrix<size, T> out{ZeroInit};
 
     /* Using ._data[] instead of [] to avoid function call indirection on debug
        builds (saves a lot, yet doesn't obfuscate too much) */
@@ -500,8 +501,8 @@ template<std::size_t size, class T> Matrix<size, T> Matrix<size, T>::comatrix()
     return out;
 }
 
-template<std::size_t size, class T> Matrix<size, T> Matrix<size, T>::adjugate() const {
-    Matrix<size, T> out{Magnum::NoInit};
+template<std::size_t size, class T> MAGNUM_CONSTEXPR14 Matrix<size, T> Matrix<size, T>::adjugate() const {
+    Matrix<size, T> out{ZeroInit};
 
     /* Same as comatrix(), except using cofactor(row, col) instead of
        cofactor(col, row). Could also be just comatrix().transpose() but since
@@ -513,7 +514,7 @@ template<std::size_t size, class T> Matrix<size, T> Matrix<size, T>::adjugate()
     return out;
 }
 
-template<std::size_t size, class T> Matrix<size, T> Matrix<size, T>::inverted() const {
+template<std::size_t size, class T> MAGNUM_CONSTEXPR14 Matrix<size, T> Matrix<size, T>::inverted() const {
     return adjugate()/determinant();
 }
 
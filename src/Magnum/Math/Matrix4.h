@@ -338,7 +338,7 @@ template<class T> class Matrix4: public Matrix4x4<T> {
          * function), use @ref orthographicProjection(const Vector2<T>&, const Vector2<T>&, T, T).
          * @see @ref perspectiveProjection(), @ref Matrix3::projection()
          */
-        static Matrix4<T> orthographicProjection(const Vector2<T>& size, T near, T far);
+        MAGNUM_CONSTEXPR14 static Matrix4<T> orthographicProjection(const Vector2<T>& size, T near, T far);
 
         /**
          * @brief 3D off-center orthographic projection matrix
@@ -368,7 +368,7 @@ template<class T> class Matrix4: public Matrix4x4<T> {
          *      @ref Matrix3::projection(const Vector2<T>&, const Vector2<T>&)
          * @m_keywords{glOrtho()}
          */
-        static Matrix4<T> orthographicProjection(const Vector2<T>& bottomLeft, const Vector2<T>& topRight, T near, T far);
+        MAGNUM_CONSTEXPR14 static Matrix4<T> orthographicProjection(const Vector2<T>& bottomLeft, const Vector2<T>& topRight, T near, T far);
 
         /**
          * @brief 3D perspective projection matrix
@@ -401,7 +401,7 @@ template<class T> class Matrix4: public Matrix4x4<T> {
          *      @ref orthographicProjection(), @ref Matrix3::projection(),
          *      @ref Constants::inf()
          */
-        static Matrix4<T> perspectiveProjection(const Vector2<T>& size, T near, T far);
+        MAGNUM_CONSTEXPR14 static Matrix4<T> perspectiveProjection(const Vector2<T>& size, T near, T far);
 
         /**
          * @brief 3D perspective projection matrix
@@ -489,7 +489,7 @@ template<class T> class Matrix4: public Matrix4x4<T> {
          *      @ref Matrix3::projection(), @ref Constants::inf()
          * @m_keywords{glFrustum()}
          */
-        static Matrix4<T> perspectiveProjection(const Vector2<T>& bottomLeft, const Vector2<T>& topRight, T near, T far);
+        MAGNUM_CONSTEXPR14 static Matrix4<T> perspectiveProjection(const Vector2<T>& bottomLeft, const Vector2<T>& topRight, T near, T far);
 
         /**
          * @brief Matrix oriented towards a specific point
@@ -1045,8 +1045,11 @@ template<class T> class Matrix4: public Matrix4x4<T> {
          *      @ref Matrix3::transformVector()
          * @todo extract 3x3 matrix and multiply directly? (benchmark that)
          */
-        Vector3<T> transformVector(const Vector3<T>& vector) const {
-            return ((*this)*Vector4<T>(vector, T(0))).xyz();
+        MAGNUM_CONSTEXPR14 Vector3<T> transformVector(const Vector3<T>& vector) const {
+            /* Not calling xyz() directly on the temporary as it'd pick the
+               non-constexpr reference-returning overload */
+            const Vector4<T> transformed{(*this)*Vector4<T>(vector, T(0))};
+            return transformed.xyz();
         }
 
         /**
@@ -1059,7 +1062,7 @@ template<class T> class Matrix4: public Matrix4x4<T> {
          * @see @ref DualQuaternion::transformPoint(),
          *      @ref Matrix3::transformPoint()
          */
-        Vector3<T> transformPoint(const Vector3<T>& vector) const {
+        MAGNUM_CONSTEXPR14 Vector3<T> transformPoint(const Vector3<T>& vector) const {
             const Vector4<T> transformed{(*this)*Vector4<T>(vector, T(1))};
             return transformed.xyz()/transformed.w();
         }
@@ -1140,7 +1143,7 @@ template<class T> Matrix4<T> Matrix4<T>::reflection(const Vector3<T>& normal) {
     return from(Matrix3x3<T>() - T(2)*normal*RectangularMatrix<1, 3, T>(normal).transposed(), {});
 }
 
-template<class T> Matrix4<T> Matrix4<T>::orthographicProjection(const Vector2<T>& size, const T near, const T far) {
+template<class T> MAGNUM_CONSTEXPR14 Matrix4<T> Matrix4<T>::orthographicProjection(const Vector2<T>& size, const T near, const T far) {
     const Vector2<T> xyScale = T(2.0)/size;
     const T zScale = T(2.0)/(near-far);
 
@@ -1150,7 +1153,7 @@ template<class T> Matrix4<T> Matrix4<T>::orthographicProjection(const Vector2<T>
             {       T(0),        T(0), near*zScale-T(1), T(1)}};
 }
 
-template<class T> Matrix4<T> Matrix4<T>::orthographicProjection(const Vector2<T>& bottomLeft, const Vector2<T>& topRight, const T near, const T far) {
+template<class T> MAGNUM_CONSTEXPR14 Matrix4<T> Matrix4<T>::orthographicProjection(const Vector2<T>& bottomLeft, const Vector2<T>& topRight, const T near, const T far) {
     const Vector3<T> difference{topRight - bottomLeft, near - far};
     const Vector3<T> scale = T(2.0)/difference;
     const Vector3<T> offset = Vector3<T>{topRight + bottomLeft, near + far}/difference;
@@ -1161,14 +1164,13 @@ template<class T> Matrix4<T> Matrix4<T>::orthographicProjection(const Vector2<T>
             {-offset.x(), -offset.y(), offset.z(), T(1)}};
 }
 
-template<class T> Matrix4<T> Matrix4<T>::perspectiveProjection(const Vector2<T>& size, const T near, const T far) {
+template<class T> MAGNUM_CONSTEXPR14 Matrix4<T> Matrix4<T>::perspectiveProjection(const Vector2<T>& size, const T near, const T far) {
     const Vector2<T> xyScale = 2*near/size;
 
-    T m22, m32;
-    if(far == Constants<T>::inf()) {
-        m22 = T(-1);
-        m32 = T(-2)*near;
-    } else {
+    /* Variables have to be initialized in a C++14 constexpr context */
+    T m22 = T(-1);
+    T m32 = T(-2)*near;
+    if(far != Constants<T>::inf()) {
         const T zScale = T(1.0)/(near-far);
         m22 = (far+near)*zScale;
         m32 = T(2)*far*near*zScale;
@@ -1180,16 +1182,15 @@ template<class T> Matrix4<T> Matrix4<T>::perspectiveProjection(const Vector2<T>&
             {       T(0),        T(0), m32,  T(0)}};
 }
 
-template<class T> Matrix4<T> Matrix4<T>::perspectiveProjection(const Vector2<T>& bottomLeft, const Vector2<T>& topRight, const T near, const T far) {
+template<class T> MAGNUM_CONSTEXPR14 Matrix4<T> Matrix4<T>::perspectiveProjection(const Vector2<T>& bottomLeft, const Vector2<T>& topRight, const T near, const T far) {
     const Vector2<T> xyDifference = topRight - bottomLeft;
     const Vector2<T> xyScale = 2*near/xyDifference;
     const Vector2<T> xyOffset = (topRight + bottomLeft)/xyDifference;
 
-    T m22, m32;
-    if(far == Constants<T>::inf()) {
-        m22 = T(-1);
-        m32 = T(-2)*near;
-    } else {
+    /* Variables have to be initialized in a C++14 constexpr context */
+    T m22 = T(-1);
+    T m32 = T(-2)*near;
+    if(far != Constants<T>::inf()) {
         const T zScale = T(1.0)/(near-far);
         m22 = (far+near)*zScale;
         m32 = T(2)*far*near*zScale;
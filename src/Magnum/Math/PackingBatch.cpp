@@ -25,41 +25,395 @@
 
 #include "PackingBatch.h"
 
+#include <cstring>
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Utility/Assert.h>
 
 #include "Magnum/Math/Packing.h"
 #include "Magnum/Math/Implementation/halfTables.hpp"
 
+#ifdef CORRADE_TARGET_SSE2
+#include <emmintrin.h>
+#if defined(__F16C__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#elif defined(CORRADE_TARGET_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace Magnum { namespace Math {
 
 namespace {
 
-template<class T> inline void unpackUnsignedIntoImplementation(const Corrade::Containers::StridedArrayView2D<const T>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
-    CORRADE_ASSERT(src.size() == dst.size(),
-        "Math::unpackInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
-    CORRADE_ASSERT(src.template isContiguous<1>() && dst.isContiguous<1>(),
-        "Math::unpackInto(): second view dimension is not contiguous", );
+/* Vectorized kernels for a contiguous run of values. Each returns the count
+   of values it processed, the remainder (or everything, if there's no
+   specialization for given type or platform) is then handled by the scalar
+   loops below. The kernels produce the same results as the scalar code for
+   all inputs that are in range for given type. Out-of-range inputs are
+   saturated in the pack kernels, whereas the scalar code has undefined
+   behavior for those. */
+template<class T> std::size_t unpackKernel(const T*, Float*, std::size_t) { return 0; }
+template<class T> std::size_t packKernel(const Float*, T*, std::size_t) { return 0; }
+
+#ifdef CORRADE_TARGET_SSE2
+/* Converts four 32-bit integers to floats and divides them by the bit max,
+   i.e. the same operation order as in the scalar code */
+inline __m128 unpackLanes(const __m128i a, const Float bitMax) {
+    return _mm_div_ps(_mm_cvtepi32_ps(a), _mm_set1_ps(bitMax));
+}
+
+template<> std::size_t unpackKernel(const UnsignedByte* const src, Float* const dst, const std::size_t count) {
+    const __m128i zero = _mm_setzero_si128();
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8) {
+        const __m128i a = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i)), zero);
+        _mm_storeu_ps(dst + i, unpackLanes(_mm_unpacklo_epi16(a, zero), 255.0f));
+        _mm_storeu_ps(dst + i + 4, unpackLanes(_mm_unpackhi_epi16(a, zero), 255.0f));
+    }
+    return i;
+}
+
+template<> std::size_t unpackKernel(const UnsignedShort* const src, Float* const dst, const std::size_t count) {
+    const __m128i zero = _mm_setzero_si128();
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_ps(dst + i, unpackLanes(_mm_unpacklo_epi16(a, zero), 65535.0f));
+        _mm_storeu_ps(dst + i + 4, unpackLanes(_mm_unpackhi_epi16(a, zero), 65535.0f));
+    }
+    return i;
+}
+
+/* The signed variants sign-extend by unpacking each value with itself and
+   shifting right. The max() with -1 is the same as the clamp in the scalar
+   code. */
+template<> std::size_t unpackKernel(const Byte* const src, Float* const dst, const std::size_t count) {
+    const __m128 minusOne = _mm_set1_ps(-1.0f);
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8) {
+        const __m128i a = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i));
+        const __m128i a16 = _mm_srai_epi16(_mm_unpacklo_epi8(a, a), 8);
+        _mm_storeu_ps(dst + i, _mm_max_ps(unpackLanes(_mm_srai_epi32(_mm_unpacklo_epi16(a16, a16), 16), 127.0f), minusOne));
+        _mm_storeu_ps(dst + i + 4, _mm_max_ps(unpackLanes(_mm_srai_epi32(_mm_unpackhi_epi16(a16, a16), 16), 127.0f), minusOne));
+    }
+    return i;
+}
 
-    /** @todo SSE/NEON implementations exploiting second dimension size/stride,
-        contiguity etc */
+template<> std::size_t unpackKernel(const Short* const src, Float* const dst, const std::size_t count) {
+    const __m128 minusOne = _mm_set1_ps(-1.0f);
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_ps(dst + i, _mm_max_ps(unpackLanes(_mm_srai_epi32(_mm_unpacklo_epi16(a, a), 16), 32767.0f), minusOne));
+        _mm_storeu_ps(dst + i + 4, _mm_max_ps(unpackLanes(_mm_srai_epi32(_mm_unpackhi_epi16(a, a), 16), 32767.0f), minusOne));
+    }
+    return i;
+}
+
+/* Multiplies four floats by the bit max and rounds them with the same
+   semantics as std::round(), i.e. halfway cases away from zero. SSE2 has only
+   round-to-nearest-even and truncation, so it truncates and then adjusts the
+   result based on the fractional part, which is calculated exactly. */
+inline __m128i packLanes(const Float* const src, const Float bitMax) {
+    const __m128 a = _mm_mul_ps(_mm_loadu_ps(src), _mm_set1_ps(bitMax));
+    const __m128i truncated = _mm_cvttps_epi32(a);
+    const __m128 fraction = _mm_sub_ps(a, _mm_cvtepi32_ps(truncated));
+    /* The masks are all ones, i.e. -1, where the condition is true */
+    const __m128i up = _mm_castps_si128(_mm_cmpge_ps(fraction, _mm_set1_ps(0.5f)));
+    const __m128i down = _mm_castps_si128(_mm_cmple_ps(fraction, _mm_set1_ps(-0.5f)));
+    return _mm_add_epi32(_mm_sub_epi32(truncated, up), down);
+}
+
+template<> std::size_t packKernel(const Float* const src, UnsignedByte* const dst, const std::size_t count) {
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8) {
+        const __m128i a = _mm_packs_epi32(packLanes(src + i, 255.0f), packLanes(src + i + 4, 255.0f));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(a, a));
+    }
+    return i;
+}
 
-    /* Caching values to avoid inline function calls in ebug builds */
+template<> std::size_t packKernel(const Float* const src, Byte* const dst, const std::size_t count) {
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8) {
+        const __m128i a = _mm_packs_epi32(packLanes(src + i, 127.0f), packLanes(src + i + 4, 127.0f));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i), _mm_packs_epi16(a, a));
+    }
+    return i;
+}
+
+/* SSE2 has only a signed 32-to-16-bit saturating pack, so the values are
+   shifted to the signed range first and then back */
+template<> std::size_t packKernel(const Float* const src, UnsignedShort* const dst, const std::size_t count) {
+    const __m128i bias32 = _mm_set1_epi32(32768);
+    const __m128i bias16 = _mm_set1_epi16(-32768);
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8) {
+        const __m128i a = _mm_packs_epi32(
+            _mm_sub_epi32(packLanes(src + i, 65535.0f), bias32),
+            _mm_sub_epi32(packLanes(src + i + 4, 65535.0f), bias32));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_xor_si128(a, bias16));
+    }
+    return i;
+}
+
+template<> std::size_t packKernel(const Float* const src, Short* const dst, const std::size_t count) {
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packs_epi32(packLanes(src + i, 32767.0f), packLanes(src + i + 4, 32767.0f)));
+    return i;
+}
+#elif defined(CORRADE_TARGET_NEON)
+#ifdef __aarch64__
+/* Converts four 32-bit integers to floats and divides them by the bit max,
+   i.e. the same operation order as in the scalar code. ARMv7 NEON has no
+   division, only a reciprocal estimate, so it's AArch64-only. */
+inline float32x4_t unpackLanes(const int32x4_t a, const Float bitMax) {
+    return vdivq_f32(vcvtq_f32_s32(a), vdupq_n_f32(bitMax));
+}
+
+template<> std::size_t unpackKernel(const UnsignedByte* const src, Float* const dst, const std::size_t count) {
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8) {
+        const uint16x8_t a = vmovl_u8(vld1_u8(src + i));
+        vst1q_f32(dst + i, unpackLanes(vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(a))), 255.0f));
+        vst1q_f32(dst + i + 4, unpackLanes(vreinterpretq_s32_u32(vmovl_u16(vget_high_u16(a))), 255.0f));
+    }
+    return i;
+}
+
+template<> std::size_t unpackKernel(const UnsignedShort* const src, Float* const dst, const std::size_t count) {
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8) {
+        const uint16x8_t a = vld1q_u16(src + i);
+        vst1q_f32(dst + i, unpackLanes(vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(a))), 65535.0f));
+        vst1q_f32(dst + i + 4, unpackLanes(vreinterpretq_s32_u32(vmovl_u16(vget_high_u16(a))), 65535.0f));
+    }
+    return i;
+}
+
+/* The max() with -1 is the same as the clamp in the scalar code */
+template<> std::size_t unpackKernel(const Byte* const src, Float* const dst, const std::size_t count) {
+    const float32x4_t minusOne = vdupq_n_f32(-1.0f);
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8) {
+        const int16x8_t a = vmovl_s8(vld1_s8(src + i));
+        vst1q_f32(dst + i, vmaxq_f32(unpackLanes(vmovl_s16(vget_low_s16(a)), 127.0f), minusOne));
+        vst1q_f32(dst + i + 4, vmaxq_f32(unpackLanes(vmovl_s16(vget_high_s16(a)), 127.0f), minusOne));
+    }
+    return i;
+}
+
+template<> std::size_t unpackKernel(const Short* const src, Float* const dst, const std::size_t count) {
+    const float32x4_t minusOne = vdupq_n_f32(-1.0f);
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8) {
+        const int16x8_t a = vld1q_s16(src + i);
+        vst1q_f32(dst + i, vmaxq_f32(unpackLanes(vmovl_s16(vget_low_s16(a)), 32767.0f), minusOne));
+        vst1q_f32(dst + i + 4, vmaxq_f32(unpackLanes(vmovl_s16(vget_high_s16(a)), 32767.0f), minusOne));
+    }
+    return i;
+}
+
+#endif
+
+/* Multiplies four floats by the bit max and rounds them with the same
+   semantics as std::round(), i.e. halfway cases away from zero. Not using
+   vcvtaq_s32_f32(), which does exactly that, to keep the code the same as
+   for SSE2. */
+inline int32x4_t packLanes(const Float* const src, const Float bitMax) {
+    const float32x4_t a = vmulq_n_f32(vld1q_f32(src), bitMax);
+    const int32x4_t truncated = vcvtq_s32_f32(a);
+    const float32x4_t fraction = vsubq_f32(a, vcvtq_f32_s32(truncated));
+    /* The masks are all ones, i.e. -1, where the condition is true */
+    const int32x4_t up = vreinterpretq_s32_u32(vcgeq_f32(fraction, vdupq_n_f32(0.5f)));
+    const int32x4_t down = vreinterpretq_s32_u32(vcleq_f32(fraction, vdupq_n_f32(-0.5f)));
+    return vaddq_s32(vsubq_s32(truncated, up), down);
+}
+
+template<> std::size_t packKernel(const Float* const src, UnsignedByte* const dst, const std::size_t count) {
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8)
+        vst1_u8(dst + i, vqmovun_s16(vcombine_s16(vqmovn_s32(packLanes(src + i, 255.0f)), vqmovn_s32(packLanes(src + i + 4, 255.0f)))));
+    return i;
+}
+
+template<> std::size_t packKernel(const Float* const src, Byte* const dst, const std::size_t count) {
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8)
+        vst1_s8(dst + i, vqmovn_s16(vcombine_s16(vqmovn_s32(packLanes(src + i, 127.0f)), vqmovn_s32(packLanes(src + i + 4, 127.0f)))));
+    return i;
+}
+
+template<> std::size_t packKernel(const Float* const src, UnsignedShort* const dst, const std::size_t count) {
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8)
+        vst1q_u16(dst + i, vcombine_u16(vqmovun_s32(packLanes(src + i, 65535.0f)), vqmovun_s32(packLanes(src + i + 4, 65535.0f))));
+    return i;
+}
+
+template<> std::size_t packKernel(const Float* const src, Short* const dst, const std::size_t count) {
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8)
+        vst1q_s16(dst + i, vcombine_s16(vqmovn_s32(packLanes(src + i, 32767.0f)), vqmovn_s32(packLanes(src + i + 4, 32767.0f))));
+    return i;
+}
+#endif
+
+/* Hardware half-float conversion. Unlike the table-based fallback, it rounds
+   to nearest even when packing, and both directions convert signaling NaNs
+   to quiet NaNs. Otherwise the results are the same. */
+#if defined(CORRADE_TARGET_SSE2) && (defined(__F16C__) || defined(__AVX2__))
+std::size_t unpackHalfKernel(const UnsignedShort* const src, Float* const dst, const std::size_t count) {
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4)
+        _mm_storeu_ps(dst + i, _mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i))));
+    return i;
+}
+
+std::size_t packHalfKernel(const Float* const src, UnsignedShort* const dst, const std::size_t count) {
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4)
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i), _mm_cvtps_ph(_mm_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT));
+    return i;
+}
+#elif defined(CORRADE_TARGET_NEON) && (defined(__aarch64__) || (defined(__ARM_FP) && (__ARM_FP & 2)))
+std::size_t unpackHalfKernel(const UnsignedShort* const src, Float* const dst, const std::size_t count) {
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4)
+        vst1q_f32(dst + i, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(src + i))));
+    return i;
+}
+
+std::size_t packHalfKernel(const Float* const src, UnsignedShort* const dst, const std::size_t count) {
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4)
+        vst1_u16(dst + i, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(src + i))));
+    return i;
+}
+#else
+std::size_t unpackHalfKernel(const UnsignedShort*, Float*, std::size_t) { return 0; }
+std::size_t packHalfKernel(const Float*, UnsignedShort*, std::size_t) { return 0; }
+#endif
+
+}
+
+namespace {
+
+/* Conversion of a contiguous run of values, first with the vectorized kernel
+   and then the remainder with scalar code */
+template<class T> void unpackUnsignedRun(const T* const src, Float* const dst, const std::size_t count) {
+    /* Caching values to avoid inline function calls in debug builds */
     constexpr Float bitMax = Implementation::bitMax<T>();
+    for(std::size_t i = unpackKernel(src, dst, count); i != count; ++i)
+        dst[i] = src[i]/bitMax;
+}
+
+template<class T> void unpackSignedRun(const T* const src, Float* const dst, const std::size_t count) {
+    /* Caching values to avoid inline function calls in debug builds */
+    constexpr Float bitMax = Implementation::bitMax<T>();
+    for(std::size_t i = unpackKernel(src, dst, count); i != count; ++i) {
+        const Float value = src[i]/bitMax;
+        /* Avoiding a max() call in Debug */
+        dst[i] = value < -1.0f ? -1.0f : value;
+    }
+}
+
+template<class T> void packRun(const Float* const src, T* const dst, const std::size_t count) {
+    /* Caching values to avoid inline function calls in debug builds */
+    constexpr Float bitMax = Implementation::bitMax<T>();
+    for(std::size_t i = packKernel(src, dst, count); i != count; ++i)
+        /** @todo provide a version that doesn't do rounding */
+        dst[i] = std::round(src[i]*bitMax);
+}
+
+void unpackHalfRun(const UnsignedShort* const src, Float* const dst, const std::size_t count) {
+    UnsignedInt* const dstBits = reinterpret_cast<UnsignedInt*>(dst);
+    for(std::size_t i = unpackHalfKernel(src, dst, count); i != count; ++i) {
+        const UnsignedShort h = src[i];
+        dstBits[i] = HalfMantissaTable[HalfOffsetTable[h >> 10] + (h & 0x3ff)] + HalfExponentTable[h >> 10];
+    }
+}
+
+void packHalfRun(const Float* const src, UnsignedShort* const dst, const std::size_t count) {
+    const UnsignedInt* const srcBits = reinterpret_cast<const UnsignedInt*>(src);
+    for(std::size_t i = packHalfKernel(src, dst, count); i != count; ++i) {
+        const UnsignedInt f = srcBits[i];
+        dst[i] = HalfBaseTable[(f >> 23) & 0x1ff] + ((f & 0x007fffff) >> HalfShiftTable[(f >> 23) & 0x1ff]);
+    }
+}
+
+/* Rows shorter than this are too short for the vectorized kernels to kick
+   in, and are thus gathered into a tile first */
+constexpr std::size_t MinKernelRowSize = 8;
+/* Count of values in a tile, sized to comfortably fit on the stack and in L1
+   cache for both the source and destination type */
+constexpr std::size_t TileSize = 512;
+
+template<class T, class U, void(*run)(const T*, U*, std::size_t)> void convertRows(const Corrade::Containers::StridedArrayView2D<const T>& src, const Corrade::Containers::StridedArrayView2D<U>& dst) {
     const char* srcPtr = reinterpret_cast<const char*>(src.data());
     char* dstPtr = reinterpret_cast<char*>(dst.data());
     const std::ptrdiff_t srcStride = src.stride()[0];
     const std::ptrdiff_t dstStride = dst.stride()[0];
-    const std::size_t maxJ = src.size()[1];
-    for(std::size_t i = 0, maxI = src.size()[0]; i != maxI; ++i) {
-        const T* srcPtrI = reinterpret_cast<const T*>(srcPtr);
-        Float* dstPtrI = reinterpret_cast<Float*>(dstPtr);
-        for(std::size_t j = 0; j != maxJ; ++j)
-            *dstPtrI++ = *srcPtrI++/bitMax;
+    const std::size_t rowCount = src.size()[0];
+    const std::size_t rowSize = src.size()[1];
+    const bool srcContiguous = src.isContiguous();
+    const bool dstContiguous = dst.isContiguous();
+
+    /* If both views are contiguous, process them as a single run so the
+       vectorized kernels get a long enough run of data even if the second
+       dimension has just a few components */
+    if(srcContiguous && dstContiguous) {
+        run(reinterpret_cast<const T*>(srcPtr), reinterpret_cast<U*>(dstPtr), rowCount*rowSize);
+        return;
+    }
 
-        srcPtr += srcStride;
-        dstPtr += dstStride;
+    /* Long enough rows, such as pixels of an image row, are processed one by
+       one */
+    if(!rowSize || rowSize >= MinKernelRowSize || rowCount == 1) {
+        for(std::size_t i = 0; i != rowCount; ++i) {
+            run(reinterpret_cast<const T*>(srcPtr), reinterpret_cast<U*>(dstPtr), rowSize);
+            srcPtr += srcStride;
+            dstPtr += dstStride;
+        }
+        return;
     }
+
+    /* Otherwise, which is the case of interleaved vertex data, gather the
+       rows into a contiguous tile, convert it in one go and scatter the
+       result back. If either side is contiguous, it's used directly instead
+       of the tile. */
+    T srcTile[TileSize];
+    U dstTile[TileSize];
+    const std::size_t rowsPerTile = TileSize/rowSize;
+    for(std::size_t i = 0; i < rowCount; i += rowsPerTile) {
+        const std::size_t tileRowCount = Math::min(rowsPerTile, rowCount - i);
+        const std::size_t tileValueCount = tileRowCount*rowSize;
+
+        const T* tileSrc;
+        if(srcContiguous)
+            tileSrc = reinterpret_cast<const T*>(srcPtr + i*srcStride);
+        else {
+            for(std::size_t r = 0; r != tileRowCount; ++r)
+                std::memcpy(srcTile + r*rowSize, srcPtr + (i + r)*srcStride, rowSize*sizeof(T));
+            tileSrc = srcTile;
+        }
+
+        U* const tileDst = dstContiguous ? reinterpret_cast<U*>(dstPtr + i*dstStride) : dstTile;
+        run(tileSrc, tileDst, tileValueCount);
+
+        if(!dstContiguous) for(std::size_t r = 0; r != tileRowCount; ++r)
+            std::memcpy(dstPtr + (i + r)*dstStride, dstTile + r*rowSize, rowSize*sizeof(U));
+    }
+}
+
+template<class T> inline void unpackUnsignedIntoImplementation(const Corrade::Containers::StridedArrayView2D<const T>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::unpackInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+    CORRADE_ASSERT(src.template isContiguous<1>() && dst.isContiguous<1>(),
+        "Math::unpackInto(): second view dimension is not contiguous", );
+
+    convertRows<T, Float, unpackUnsignedRun<T>>(src, dst);
 }
 
 }
@@ -80,28 +434,7 @@ template<class T> inline void unpackSignedIntoImplementation(const Corrade::Cont
     CORRADE_ASSERT(src.template isContiguous<1>() && dst.isContiguous<1>(),
         "Math::unpackInto(): second view dimension is not contiguous", );
 
-    /** @todo SSE/NEON implementations exploiting second dimension size/stride,
-        contiguity etc */
-
-    /* Caching values to avoid inline function calls in debug builds */
-    constexpr Float bitMax = Implementation::bitMax<T>();
-    const char* srcPtr = reinterpret_cast<const char*>(src.data());
-    char* dstPtr = reinterpret_cast<char*>(dst.data());
-    const std::ptrdiff_t srcStride = src.stride()[0];
-    const std::ptrdiff_t dstStride = dst.stride()[0];
-    const std::size_t maxJ = src.size()[1];
-    for(std::size_t i = 0, maxI = src.size()[0]; i != maxI; ++i) {
-        const T* srcPtrI = reinterpret_cast<const T*>(srcPtr);
-        Float* dstPtrI = reinterpret_cast<Float*>(dstPtr);
-        for(std::size_t j = 0; j != maxJ; ++j) {
-            const Float value = *srcPtrI++/bitMax;
-            /* Avoiding a max() call in Debug */
-            *dstPtrI++ = value < -1.0f ? -1.0f : value;
-        }
-
-        srcPtr += srcStride;
-        dstPtr += dstStride;
-    }
+    convertRows<T, Float, unpackSignedRun<T>>(src, dst);
 }
 
 }
@@ -122,26 +455,7 @@ template<class T> inline void packIntoImplementation(const Corrade::Containers::
     CORRADE_ASSERT(src.isContiguous<1>() && dst.template isContiguous<1>(),
         "Math::packInto(): second view dimension is not contiguous", );
 
-    /** @todo SSE/NEON implementations exploiting second dimension size/stride,
-        contiguity etc */
-
-    /* Caching values to avoid inline function calls in debug builds */
-    constexpr Float bitMax = Implementation::bitMax<T>();
-    const char* srcPtr = reinterpret_cast<const char*>(src.data());
-    char* dstPtr = reinterpret_cast<char*>(dst.data());
-    const std::ptrdiff_t srcStride = src.stride()[0];
-    const std::ptrdiff_t dstStride = dst.stride()[0];
-    const std::size_t maxJ = src.size()[1];
-    for(std::size_t i = 0, maxI = src.size()[0]; i != maxI; ++i) {
-        const Float* srcPtrI = reinterpret_cast<const Float*>(srcPtr);
-        T* dstPtrI = reinterpret_cast<T*>(dstPtr);
-        for(std::size_t j = 0; j != maxJ; ++j)
-            /** @todo provide a version that doesn't do rounding */
-            *dstPtrI++ = std::round(*srcPtrI++*bitMax);
-
-        srcPtr += srcStride;
-        dstPtr += dstStride;
-    }
+    convertRows<Float, T, packRun<T>>(src, dst);
 }
 
 }
@@ -170,16 +484,21 @@ template<class T, class U> inline void castIntoImplementation(const Corrade::Con
     CORRADE_ASSERT(src.template isContiguous<1>() && dst.template isContiguous<1>(),
         "Math::castInto(): second view dimension is not contiguous", );
 
-    /** @todo SSE/NEON implementations exploiting second dimension size/stride,
-        contiguity etc */
-
-    /* Caching values to avoid inline function calls in debug buílds */
+    /* Caching values to avoid inline function calls in debug builds */
     const char* srcPtr = reinterpret_cast<const char*>(src.data());
     char* dstPtr = reinterpret_cast<char*>(dst.data());
     const std::ptrdiff_t srcStride = src.stride()[0];
     const std::ptrdiff_t dstStride = dst.stride()[0];
-    const std::size_t maxJ = src.size()[1];
-    for(std::size_t i = 0, maxI = src.size()[0]; i != maxI; ++i) {
+    /* If both views are contiguous, process them as a single row so the
+       compiler-vectorized loop gets a long enough run of data even if the
+       second dimension has just a few components */
+    std::size_t maxI = src.size()[0];
+    std::size_t maxJ = src.size()[1];
+    if(src.isContiguous() && dst.isContiguous()) {
+        maxJ *= maxI;
+        maxI = 1;
+    }
+    for(std::size_t i = 0; i != maxI; ++i) {
         const T* srcPtrI = reinterpret_cast<const T*>(srcPtr);
         U* dstPtrI = reinterpret_cast<U*>(dstPtr);
         for(std::size_t j = 0; j != maxJ; ++j)
@@ -404,23 +723,7 @@ void unpackHalfInto(const Corrade::Containers::StridedArrayView2D<const Unsigned
     CORRADE_ASSERT(src.isContiguous<1>() && dst.isContiguous<1>(),
         "Math::unpackHalfInto(): second view dimension is not contiguous", );
 
-    /* Caching values to avoid inline function calls in debug builds */
-    const char* srcPtr = reinterpret_cast<const char*>(src.data());
-    char* dstPtr = reinterpret_cast<char*>(dst.data());
-    const std::ptrdiff_t srcStride = src.stride()[0];
-    const std::ptrdiff_t dstStride = dst.stride()[0];
-    const std::size_t maxJ = src.size()[1];
-    for(std::size_t i = 0, maxI = src.size()[0]; i != maxI; ++i) {
-        const UnsignedShort* srcPtrI = reinterpret_cast<const UnsignedShort*>(srcPtr);
-        UnsignedInt* dstPtrI = reinterpret_cast<UnsignedInt*>(dstPtr);
-        for(std::size_t j = 0; j != maxJ; ++j) {
-            const UnsignedShort h = *srcPtrI++;
-            *dstPtrI++ = HalfMantissaTable[HalfOffsetTable[h >> 10] + (h & 0x3ff)] + HalfExponentTable[h >> 10];
-        }
-
-        srcPtr += srcStride;
-        dstPtr += dstStride;
-    }
+    convertRows<UnsignedShort, Float, unpackHalfRun>(src, dst);
 }
 
 void packHalfInto(const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<UnsignedShort>& dst) {
@@ -429,23 +732,7 @@ void packHalfInto(const Corrade::Containers::StridedArrayView2D<const Float>& sr
     CORRADE_ASSERT(src.isContiguous<1>() && dst.isContiguous<1>(),
         "Math::packHalfInto(): second view dimension is not contiguous", );
 
-    /* Caching values to avoid inline function calls in debug builds */
-    const char* srcPtr = reinterpret_cast<const char*>(src.data());
-    char* dstPtr = reinterpret_cast<char*>(dst.data());
-    const std::ptrdiff_t srcStride = src.stride()[0];
-    const std::ptrdiff_t dstStride = dst.stride()[0];
-    const std::size_t maxJ = src.size()[1];
-    for(std::size_t i = 0, maxI = src.size()[0]; i != maxI; ++i) {
-        const UnsignedInt* srcPtrI = reinterpret_cast<const UnsignedInt*>(srcPtr);
-        UnsignedShort* dstPtrI = reinterpret_cast<UnsignedShort*>(dstPtr);
-        for(std::size_t j = 0; j != maxJ; ++j) {
-            const UnsignedInt f = *srcPtrI++;
-            *dstPtrI++ = HalfBaseTable[(f >> 23) & 0x1ff] + ((f & 0x007fffff) >> HalfShiftTable[(f >> 23) & 0x1ff]);
-        }
-
-        srcPtr += srcStride;
-        dstPtr += dstStride;
-    }
+    convertRows<Float, UnsignedShort, packHalfRun>(src, dst);
 }
 
 }}
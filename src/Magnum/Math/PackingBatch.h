@@ -41,7 +41,11 @@ namespace Magnum { namespace Math {
 @{ @name Batch packing functions
 
 These functions process an ubounded range of values, as opposed to single
-vectors or scalars.
+vectors or scalars. If both the source and destination views are contiguous,
+@ref packInto(), @ref unpackInto(), @ref packHalfInto() and
+@ref unpackHalfInto() process the data using SSE2 or NEON instructions if
+@ref CORRADE_TARGET_SSE2 or @ref CORRADE_TARGET_NEON is defined. The remaining
+values, as well as non-contiguous views, are processed with a scalar loop.
 */
 
 /**
@@ -142,6 +146,12 @@ contiguous.
 
 Algorithm used: *Jeroen van der Zijp -- Fast Half Float Conversions, 2008,
 ftp://ftp.fox-toolkit.org/pub/fasthalffloatconversion.pdf*
+
+If both views are contiguous and the library is compiled with F16C support on
+x86 (for example with `-mf16c` or `-mavx2`) or with half-float support on ARM,
+the hardware conversion instructions are used instead. Unlike the table-based
+implementation, which truncates, these round to nearest even and convert
+signaling NaNs to quiet NaNs.
 @see @ref Half
 */
 MAGNUM_EXPORT void packHalfInto(const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<UnsignedShort>& dst);
@@ -161,6 +171,11 @@ contiguous.
 
 Algorithm used: *Jeroen van der Zijp -- Fast Half Float Conversions, 2008,
 ftp://ftp.fox-toolkit.org/pub/fasthalffloatconversion.pdf*
+
+If both views are contiguous and the library is compiled with F16C support on
+x86 (for example with `-mf16c` or `-mavx2`) or with half-float support on ARM,
+the hardware conversion instructions are used instead. The result is the same
+except for signaling NaNs, which are converted to quiet NaNs.
 @see @ref Half
 */
 MAGNUM_EXPORT void unpackHalfInto(const Corrade::Containers::StridedArrayView2D<const UnsignedShort>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst);
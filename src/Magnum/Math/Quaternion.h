@@ -54,7 +54,7 @@ namespace Implementation {
 @f]
 @see @ref Quaternion::dot() const
 */
-template<class T> inline T dot(const Quaternion<T>& a, const Quaternion<T>& b) {
+template<class T> MAGNUM_CONSTEXPR14 inline T dot(const Quaternion<T>& a, const Quaternion<T>& b) {
     return dot(a.vector(), b.vector()) + a.scalar()*b.scalar();
 }
 
@@ -450,7 +450,7 @@ template<class T> class Quaternion {
          * @see @ref fromMatrix(), @ref DualQuaternion::toMatrix(),
          *      @ref Matrix4::from(const Matrix3x3<T>&, const Vector3<T>&)
          */
-        Matrix3x3<T> toMatrix() const;
+        constexpr Matrix3x3<T> toMatrix() const;
 
         /**
          * @brief Convert to an euler vector
@@ -472,7 +472,7 @@ template<class T> class Quaternion {
          *      -q = [-\boldsymbol q_V, -q_S]
          * @f]
          */
-        Quaternion<T> operator-() const { return {-_vector, -_scalar}; }
+        MAGNUM_CONSTEXPR14 Quaternion<T> operator-() const { return {-_vector, -_scalar}; }
 
         /**
          * @brief Add and assign a quaternion
@@ -481,7 +481,7 @@ template<class T> class Quaternion {
          *      p + q = [\boldsymbol p_V + \boldsymbol q_V, p_S + q_S]
          * @f]
          */
-        Quaternion<T>& operator+=(const Quaternion<T>& other) {
+        MAGNUM_CONSTEXPR14 Quaternion<T>& operator+=(const Quaternion<T>& other) {
             _vector += other._vector;
             _scalar += other._scalar;
             return *this;
@@ -492,7 +492,7 @@ template<class T> class Quaternion {
          *
          * @see @ref operator+=()
          */
-        Quaternion<T> operator+(const Quaternion<T>& other) const {
+        MAGNUM_CONSTEXPR14 Quaternion<T> operator+(const Quaternion<T>& other) const {
             return Quaternion<T>(*this) += other;
         }
 
@@ -503,7 +503,7 @@ template<class T> class Quaternion {
          *      p - q = [\boldsymbol p_V - \boldsymbol q_V, p_S - q_S]
          * @f]
          */
-        Quaternion<T>& operator-=(const Quaternion<T>& other) {
+        MAGNUM_CONSTEXPR14 Quaternion<T>& operator-=(const Quaternion<T>& other) {
             _vector -= other._vector;
             _scalar -= other._scalar;
             return *this;
@@ -514,7 +514,7 @@ template<class T> class Quaternion {
          *
          * @see @ref operator-=()
          */
-        Quaternion<T> operator-(const Quaternion<T>& other) const {
+        MAGNUM_CONSTEXPR14 Quaternion<T> operator-(const Quaternion<T>& other) const {
             return Quaternion<T>(*this) -= other;
         }
 
@@ -525,7 +525,7 @@ template<class T> class Quaternion {
          *      q \cdot a = [\boldsymbol q_V \cdot a, q_S \cdot a]
          * @f]
          */
-        Quaternion<T>& operator*=(T scalar) {
+        MAGNUM_CONSTEXPR14 Quaternion<T>& operator*=(T scalar) {
             _vector *= scalar;
             _scalar *= scalar;
             return *this;
@@ -536,7 +536,7 @@ template<class T> class Quaternion {
          *
          * @see @ref operator*=(T)
          */
-        Quaternion<T> operator*(T scalar) const {
+        MAGNUM_CONSTEXPR14 Quaternion<T> operator*(T scalar) const {
             return Quaternion<T>(*this) *= scalar;
         }
 
@@ -547,7 +547,7 @@ template<class T> class Quaternion {
          *      \frac q a = [\frac {\boldsymbol q_V} a, \frac {q_S} a]
          * @f]
          */
-        Quaternion<T>& operator/=(T scalar) {
+        MAGNUM_CONSTEXPR14 Quaternion<T>& operator/=(T scalar) {
             _vector /= scalar;
             _scalar /= scalar;
             return *this;
@@ -558,7 +558,7 @@ template<class T> class Quaternion {
          *
          * @see @ref operator/=(T)
          */
-        Quaternion<T> operator/(T scalar) const {
+        MAGNUM_CONSTEXPR14 Quaternion<T> operator/(T scalar) const {
             return Quaternion<T>(*this) /= scalar;
         }
 
@@ -573,7 +573,7 @@ template<class T> class Quaternion {
          * @see @ref cross(const Vector3<T>&, const Vector3<T>&),
          *      @ref Vector::dot() const
          */
-        Quaternion<T> operator*(const Quaternion<T>& other) const;
+        MAGNUM_CONSTEXPR14 Quaternion<T> operator*(const Quaternion<T>& other) const;
 
         /**
          * @brief Dot product of the quaternion
@@ -586,7 +586,7 @@ template<class T> class Quaternion {
          * @see @ref isNormalized(),
          *      @ref dot(const Quaternion<T>&, const Quaternion<T>&)
          */
-        T dot() const { return Math::dot(*this, *this); }
+        MAGNUM_CONSTEXPR14 T dot() const { return Math::dot(*this, *this); }
 
         /**
          * @brief Quaternion length
@@ -613,7 +613,7 @@ template<class T> class Quaternion {
          *      q^* = [-\boldsymbol q_V, q_S]
          * @f]
          */
-        Quaternion<T> conjugated() const { return {-_vector, _scalar}; }
+        MAGNUM_CONSTEXPR14 Quaternion<T> conjugated() const { return {-_vector, _scalar}; }
 
         /**
          * @brief Inverted quaternion
@@ -623,7 +623,7 @@ template<class T> class Quaternion {
          *      q^{-1} = \frac{q^*}{|q|^2} = \frac{q^*}{q \cdot q}
          * @f]
          */
-        Quaternion<T> inverted() const { return conjugated()/dot(); }
+        MAGNUM_CONSTEXPR14 Quaternion<T> inverted() const { return conjugated()/dot(); }
 
         /**
          * @brief Inverted normalized quaternion
@@ -648,8 +648,11 @@ template<class T> class Quaternion {
          *      @ref DualQuaternion::transformPoint(),
          *      @ref Complex::transformVector()
          */
-        Vector3<T> transformVector(const Vector3<T>& vector) const {
-            return ((*this)*Quaternion<T>(vector)*inverted()).vector();
+        MAGNUM_CONSTEXPR14 Vector3<T> transformVector(const Vector3<T>& vector) const {
+            /* Not calling vector() directly on the temporary as it'd pick the
+               non-constexpr reference-returning overload */
+            const Quaternion<T> transformed = (*this)*Quaternion<T>(vector)*inverted();
+            return transformed.vector();
         }
 
         /**
@@ -693,7 +696,7 @@ template<class T> class Quaternion {
 
 Same as @ref Quaternion::operator*(T) const.
 */
-template<class T> inline Quaternion<T> operator*(T scalar, const Quaternion<T>& quaternion) {
+template<class T> MAGNUM_CONSTEXPR14 inline Quaternion<T> operator*(T scalar, const Quaternion<T>& quaternion) {
     return quaternion*scalar;
 }
 
@@ -705,7 +708,7 @@ template<class T> inline Quaternion<T> operator*(T scalar, const Quaternion<T>&
 @f]
 @see @ref Quaternion::operator/()
 */
-template<class T> inline Quaternion<T> operator/(T scalar, const Quaternion<T>& quaternion) {
+template<class T> MAGNUM_CONSTEXPR14 inline Quaternion<T> operator/(T scalar, const Quaternion<T>& quaternion) {
     return {scalar/quaternion.vector(), scalar/quaternion.scalar()};
 }
 
@@ -797,7 +800,7 @@ template<class T> inline Vector3<T> Quaternion<T>::axis() const {
     return _vector/std::sqrt(1-pow2(_scalar));
 }
 
-template<class T> Matrix3x3<T> Quaternion<T>::toMatrix() const {
+template<class T> constexpr Matrix3x3<T> Quaternion<T>::toMatrix() const {
     return {
         Vector<3, T>(T(1) - 2*pow2(_vector.y()) - 2*pow2(_vector.z()),
             2*_vector.x()*_vector.y() + 2*_vector.z()*_scalar,
@@ -842,7 +845,7 @@ template<class T> Vector3<Rad<T>> Quaternion<T>::toEuler() const {
     return euler;
 }
 
-template<class T> inline Quaternion<T> Quaternion<T>::operator*(const Quaternion<T>& other) const {
+template<class T> MAGNUM_CONSTEXPR14 inline Quaternion<T> Quaternion<T>::operator*(const Quaternion<T>& other) const {
     return {_scalar*other._vector + other._scalar*_vector + Math::cross(_vector, other._vector),
             _scalar*other._scalar - Math::dot(_vector, other._vector)};
 }
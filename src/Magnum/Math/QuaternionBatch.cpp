@@ -0,0 +1,222 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "QuaternionBatch.h"
+
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/DualQuaternion.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Wide.h"
+
+namespace Magnum { namespace Math {
+
+/* All functions process four items at a time in a structure-of-arrays layout.
+   The operations are done in the same order as in the per-element APIs, so
+   the results match those up to differences caused by the compiler fusing
+   multiplications and additions. Branches are emulated with select(),
+   evaluating both sides. For the last, partial, chunk the unused lanes are
+   zero-filled by loadWide(), which may produce NaNs in those, but these are
+   not written back by storeWide(). */
+
+namespace {
+
+typedef Quaternion<Wide4f> WideQuaternion;
+
+WideQuaternion select(const BitVector<4>& mask, const WideQuaternion& a, const WideQuaternion& b) {
+    return {{Math::select(mask, a.vector().x(), b.vector().x()),
+             Math::select(mask, a.vector().y(), b.vector().y()),
+             Math::select(mask, a.vector().z(), b.vector().z())},
+             Math::select(mask, a.scalar(), b.scalar())};
+}
+
+/* Same as Quaternion::toMatrix(), which can't be used with Wide4f directly
+   because of integer literals in the calculation */
+Matrix3x3<Wide4f> rotationMatrix(const WideQuaternion& quaternion) {
+    const Wide4f x = quaternion.vector().x();
+    const Wide4f y = quaternion.vector().y();
+    const Wide4f z = quaternion.vector().z();
+    const Wide4f w = quaternion.scalar();
+    const Wide4f one{1.0f};
+    return {
+        Vector3<Wide4f>{one - 2.0f*(y*y) - 2.0f*(z*z),
+            2.0f*x*y + 2.0f*z*w,
+                2.0f*x*z - 2.0f*y*w},
+        Vector3<Wide4f>{2.0f*x*y - 2.0f*z*w,
+            one - 2.0f*(x*x) - 2.0f*(z*z),
+                2.0f*y*z + 2.0f*x*w},
+        Vector3<Wide4f>{2.0f*x*z + 2.0f*y*w,
+            2.0f*y*z - 2.0f*x*w,
+                one - 2.0f*(x*x) - 2.0f*(y*y)}
+    };
+}
+
+WideQuaternion lerpImplementation(const WideQuaternion& a, const WideQuaternion& b, const Wide4f& t) {
+    const WideQuaternion out = (Wide4f{1.0f} - t)*a + t*b;
+    return out/Math::sqrt(dot(out, out));
+}
+
+WideQuaternion lerpShortestPathImplementation(const WideQuaternion& a, const WideQuaternion& b, const Wide4f& t) {
+    return lerpImplementation(select(dot(a, b) < Wide4f{0.0f}, -a, a), b, t);
+}
+
+/* Shared implementation of slerp() and slerpShortestPath(), the two differ
+   only in the threshold for the linear fallback and in which quaternion is
+   used for the spherical interpolation */
+template<bool shortestPath> WideQuaternion slerpImplementation(const WideQuaternion& a, const WideQuaternion& b, const Wide4f& t) {
+    const Wide4f cosHalfAngle = dot(a, b);
+    const Wide4f absCosHalfAngle = Math::abs(cosHalfAngle);
+    const WideQuaternion shortestA = select(cosHalfAngle < Wide4f{0.0f}, -a, a);
+    const BitVector<4> linear = shortestPath ?
+        absCosHalfAngle >= Wide4f{1.0f - TypeTraits<Float>::epsilon()} :
+        absCosHalfAngle > Wide4f{1.0f - 0.5f*TypeTraits<Float>::epsilon()};
+
+    /* There's no vectorized variant of the trigonometric functions, so these
+       are done for each lane separately */
+    Wide4f sinA{Magnum::NoInit};
+    Wide4f sinB{Magnum::NoInit};
+    Wide4f sinAngle{Magnum::NoInit};
+    for(std::size_t i = 0; i != 4; ++i) {
+        const Float angle = std::acos(shortestPath ? absCosHalfAngle[i] : cosHalfAngle[i]);
+        sinA[i] = std::sin((1.0f - t[i])*angle);
+        sinB[i] = std::sin(t[i]*angle);
+        sinAngle[i] = std::sin(angle);
+    }
+
+    return select(linear,
+        (Wide4f{1.0f} - t)*shortestA + t*b,
+        (sinA*(shortestPath ? shortestA : a) + sinB*b)/sinAngle);
+}
+
+template<WideQuaternion(*interpolator)(const WideQuaternion&, const WideQuaternion&, const Wide4f&)> void interpolateInto(const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& a, const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& b, const Corrade::Containers::StridedArrayView1D<const Float>& t, const Corrade::Containers::StridedArrayView1D<Quaternion<Float>>& out) {
+    for(std::size_t i = 0; i < a.size(); i += 4) {
+        const std::size_t end = Math::min(i + 4, a.size());
+        storeWide(interpolator(
+            loadWide<4>(a.slice(i, end)),
+            loadWide<4>(b.slice(i, end)),
+            loadWide<4>(t.slice(i, end))), out.slice(i, end));
+    }
+}
+
+}
+
+void lerpInto(const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& a, const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& b, const Corrade::Containers::StridedArrayView1D<const Float>& t, const Corrade::Containers::StridedArrayView1D<Quaternion<Float>>& out) {
+    CORRADE_ASSERT(b.size() == a.size() && t.size() == a.size() && out.size() == a.size(),
+        "Math::lerpInto(): expected" << a.size() << "second quaternions, interpolation phases and output items but got" << b.size() << Corrade::Utility::Debug::nospace << "," << t.size() << "and" << out.size(), );
+    interpolateInto<lerpImplementation>(a, b, t, out);
+}
+
+void lerpShortestPathInto(const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& a, const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& b, const Corrade::Containers::StridedArrayView1D<const Float>& t, const Corrade::Containers::StridedArrayView1D<Quaternion<Float>>& out) {
+    CORRADE_ASSERT(b.size() == a.size() && t.size() == a.size() && out.size() == a.size(),
+        "Math::lerpShortestPathInto(): expected" << a.size() << "second quaternions, interpolation phases and output items but got" << b.size() << Corrade::Utility::Debug::nospace << "," << t.size() << "and" << out.size(), );
+    interpolateInto<lerpShortestPathImplementation>(a, b, t, out);
+}
+
+void slerpInto(const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& a, const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& b, const Corrade::Containers::StridedArrayView1D<const Float>& t, const Corrade::Containers::StridedArrayView1D<Quaternion<Float>>& out) {
+    CORRADE_ASSERT(b.size() == a.size() && t.size() == a.size() && out.size() == a.size(),
+        "Math::slerpInto(): expected" << a.size() << "second quaternions, interpolation phases and output items but got" << b.size() << Corrade::Utility::Debug::nospace << "," << t.size() << "and" << out.size(), );
+    interpolateInto<slerpImplementation<false>>(a, b, t, out);
+}
+
+void slerpShortestPathInto(const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& a, const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& b, const Corrade::Containers::StridedArrayView1D<const Float>& t, const Corrade::Containers::StridedArrayView1D<Quaternion<Float>>& out) {
+    CORRADE_ASSERT(b.size() == a.size() && t.size() == a.size() && out.size() == a.size(),
+        "Math::slerpShortestPathInto(): expected" << a.size() << "second quaternions, interpolation phases and output items but got" << b.size() << Corrade::Utility::Debug::nospace << "," << t.size() << "and" << out.size(), );
+    interpolateInto<slerpImplementation<true>>(a, b, t, out);
+}
+
+void blendInto(const Corrade::Containers::StridedArrayView1D<const DualQuaternion<Float>>& transformations, const Corrade::Containers::StridedArrayView2D<const UnsignedInt>& ids, const Corrade::Containers::StridedArrayView2D<const Float>& weights, const Corrade::Containers::StridedArrayView1D<DualQuaternion<Float>>& out) {
+    CORRADE_ASSERT(weights.size() == ids.size(),
+        "Math::blendInto(): expected joint ID and weight views to have the same size but got" << ids.size() << "and" << weights.size(), );
+    CORRADE_ASSERT(out.size() == ids.size()[0],
+        "Math::blendInto(): expected" << ids.size()[0] << "output items but got" << out.size(), );
+
+    for(std::size_t i = 0; i < out.size(); i += 4) {
+        const std::size_t end = Math::min(i + 4, out.size());
+
+        WideQuaternion real{ZeroInit};
+        WideQuaternion dual{ZeroInit};
+        WideQuaternion firstReal{Magnum::NoInit};
+        for(std::size_t j = 0; j != ids.size()[1]; ++j) {
+            /* Gather the referenced transformations. The unused lanes stay
+               as identity with a zero weight. */
+            DualQuaternion<Float> items[4];
+            Wide4f weight;
+            for(std::size_t k = i; k != end; ++k) {
+                const UnsignedInt id = ids[k][j];
+                CORRADE_ASSERT(id < transformations.size(),
+                    "Math::blendInto(): joint ID" << id << "out of range for" << transformations.size() << "transformations", );
+                items[k - i] = transformations[id];
+                weight[k - i] = weights[k][j];
+            }
+            const DualQuaternion<Wide4f> item = loadWide<4>(Corrade::Containers::stridedArrayView(items));
+
+            /* Blend on the shortest path relative to the first joint */
+            if(j == 0) firstReal = item.real();
+            weight = Math::select(dot(item.real(), firstReal) < Wide4f{0.0f}, -weight, weight);
+            real += item.real()*weight;
+            dual += item.dual()*weight;
+        }
+
+        /* Same as DualQuaternion::normalized(), i.e. a division by the dual
+           length */
+        const Wide4f length = Math::sqrt(dot(real, real));
+        const Wide4f dualLength = dot(real, dual)/length;
+        storeWide(DualQuaternion<Wide4f>{
+            real/length,
+            (dual*length - real*dualLength)/(length*length)
+        }, out.slice(i, end));
+    }
+}
+
+void transformationMatrixInto(const Corrade::Containers::StridedArrayView1D<const DualQuaternion<Float>>& src, const Corrade::Containers::StridedArrayView1D<Matrix4<Float>>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::transformationMatrixInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    for(std::size_t i = 0; i < src.size(); i += 4) {
+        const std::size_t end = Math::min(i + 4, src.size());
+        const DualQuaternion<Wide4f> transformation = loadWide<4>(src.slice(i, end));
+        const Vector3<Wide4f> translation = (transformation.dual()*transformation.real().conjugated()).vector()*Wide4f{2.0f};
+        storeWide(Matrix4<Wide4f>::from(rotationMatrix(transformation.real()), translation), dst.slice(i, end));
+    }
+}
+
+void transformationMatrixInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& translations, const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& rotations, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& scalings, const Corrade::Containers::StridedArrayView1D<Matrix4<Float>>& dst) {
+    CORRADE_ASSERT(rotations.size() == translations.size() && scalings.size() == translations.size() && dst.size() == translations.size(),
+        "Math::transformationMatrixInto(): expected" << translations.size() << "rotations, scalings and output items but got" << rotations.size() << Corrade::Utility::Debug::nospace << "," << scalings.size() << "and" << dst.size(), );
+
+    for(std::size_t i = 0; i < translations.size(); i += 4) {
+        const std::size_t end = Math::min(i + 4, translations.size());
+        const Vector3<Wide4f> scaling = loadWide<4>(scalings.slice(i, end));
+        const Matrix3x3<Wide4f> rotationScaling = rotationMatrix(loadWide<4>(rotations.slice(i, end)));
+        storeWide(Matrix4<Wide4f>::from(Matrix3x3<Wide4f>{
+            rotationScaling[0]*scaling.x(),
+            rotationScaling[1]*scaling.y(),
+            rotationScaling[2]*scaling.z()
+        }, loadWide<4>(translations.slice(i, end))), dst.slice(i, end));
+    }
+}
+
+}}
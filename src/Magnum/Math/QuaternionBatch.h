@@ -0,0 +1,200 @@
+#ifndef Magnum_Math_QuaternionBatch_h
+#define Magnum_Math_QuaternionBatch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Functions @ref Magnum::Math::lerpInto(), @ref Magnum::Math::lerpShortestPathInto(), @ref Magnum::Math::slerpInto(), @ref Magnum::Math::slerpShortestPathInto(), @ref Magnum::Math::blendInto(), @ref Magnum::Math::transformationMatrixInto()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Types.h"
+#include "Magnum/visibility.h"
+#include "Magnum/Math/Math.h"
+
+namespace Magnum { namespace Math {
+
+/**
+@{ @name Batch quaternion functions
+
+These functions operate on an unbounded range of quaternions or dual
+quaternions, as opposed to the per-element @ref slerp(),
+@ref DualQuaternion::toMatrix() and friends. Meant mainly for animation
+blending and skinning, where the same operation is done on thousands of joints
+each frame. Internally the items are processed four at a time in a
+structure-of-arrays layout using @ref Wide4f, which allows the compiler to
+vectorize the arithmetic. The views can be arbitrarily strided. To use the same
+interpolation phase for all items, pass a view with a zero stride, for example
+using @ref Corrade::Containers::StridedArrayView::broadcasted().
+
+@snippet MagnumMath.cpp QuaternionBatch-usage
+
+Unlike the per-element functions, these don't check that the input quaternions
+are normalized.
+*/
+
+/**
+@brief Linear interpolation of quaternions
+@param[in]  a       First quaternions
+@param[in]  b       Second quaternions
+@param[in]  t       Interpolation phases
+@param[out] out     Where to put the interpolated quaternions
+@m_since_latest
+
+Equivalent to calling @ref lerp(const Quaternion<T>&, const Quaternion<T>&, T)
+on each item. Expects that all views have the same size and that the
+quaternions are normalized.
+@see @ref lerpShortestPathInto(), @ref slerpInto()
+*/
+MAGNUM_EXPORT void lerpInto(const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& a, const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& b, const Corrade::Containers::StridedArrayView1D<const Float>& t, const Corrade::Containers::StridedArrayView1D<Quaternion<Float>>& out);
+
+/**
+@brief Linear shortest-path interpolation of quaternions
+@param[in]  a       First quaternions
+@param[in]  b       Second quaternions
+@param[in]  t       Interpolation phases
+@param[out] out     Where to put the interpolated quaternions
+@m_since_latest
+
+Equivalent to calling @ref lerpShortestPath(const Quaternion<T>&, const Quaternion<T>&, T)
+on each item. Expects that all views have the same size and that the
+quaternions are normalized.
+@see @ref lerpInto(), @ref slerpShortestPathInto()
+*/
+MAGNUM_EXPORT void lerpShortestPathInto(const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& a, const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& b, const Corrade::Containers::StridedArrayView1D<const Float>& t, const Corrade::Containers::StridedArrayView1D<Quaternion<Float>>& out);
+
+/**
+@brief Spherical linear interpolation of quaternions
+@param[in]  a       First quaternions
+@param[in]  b       Second quaternions
+@param[in]  t       Interpolation phases
+@param[out] out     Where to put the interpolated quaternions
+@m_since_latest
+
+Equivalent to calling @ref slerp(const Quaternion<T>&, const Quaternion<T>&, T)
+on each item. Expects that all views have the same size and that the
+quaternions are normalized. The trigonometric functions are evaluated for
+each item separately, consider using @ref lerpShortestPathInto() if the
+accuracy of a linear interpolation is sufficient.
+@see @ref slerpShortestPathInto(), @ref lerpInto()
+*/
+MAGNUM_EXPORT void slerpInto(const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& a, const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& b, const Corrade::Containers::StridedArrayView1D<const Float>& t, const Corrade::Containers::StridedArrayView1D<Quaternion<Float>>& out);
+
+/**
+@brief Spherical linear shortest-path interpolation of quaternions
+@param[in]  a       First quaternions
+@param[in]  b       Second quaternions
+@param[in]  t       Interpolation phases
+@param[out] out     Where to put the interpolated quaternions
+@m_since_latest
+
+Equivalent to calling @ref slerpShortestPath(const Quaternion<T>&, const Quaternion<T>&, T)
+on each item. Expects that all views have the same size and that the
+quaternions are normalized. The trigonometric functions are evaluated for
+each item separately, consider using @ref lerpShortestPathInto() if the
+accuracy of a linear interpolation is sufficient.
+@see @ref slerpInto(), @ref lerpShortestPathInto()
+*/
+MAGNUM_EXPORT void slerpShortestPathInto(const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& a, const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& b, const Corrade::Containers::StridedArrayView1D<const Float>& t, const Corrade::Containers::StridedArrayView1D<Quaternion<Float>>& out);
+
+/**
+@brief Dual quaternion linear blending
+@param[in]  transformations Joint transformations
+@param[in]  ids             Joint IDs
+@param[in]  weights         Joint weights
+@param[out] out             Where to put the blended transformations
+@m_since_latest
+
+For each item @f$ i @f$ calculates a weighted sum of dual quaternions
+@f$ \hat q_{\mathrm{id}_{ij}} @f$ referenced by the second dimension of
+@p ids and @p weights, negating weights of dual quaternions whose real part
+lies in the opposite hemisphere than the real part of the first one, and
+normalizes the result: @f[
+    \begin{array}{rcl}
+        s_{ij} & = & \begin{cases}
+                \phantom{-}1, & q_{0\mathrm{id}_{i0}} \cdot q_{0\mathrm{id}_{ij}} \ge 0 \\
+                -1, & q_{0\mathrm{id}_{i0}} \cdot q_{0\mathrm{id}_{ij}} < 0
+            \end{cases} \\[15pt]
+        \hat b_i & = & \sum_j s_{ij} w_{ij} \hat q_{\mathrm{id}_{ij}} \\[5pt]
+        \hat q_i & = & \cfrac{\hat b_i}{|\hat b_i|}
+    \end{array}
+@f]
+
+The normalization is the same as in @ref DualQuaternion::normalized(). This is
+the *Dual Quaternion Linear Blending* from *Ladislav Kavan et al -- Skinning
+with Dual Quaternions, 2007*, usable both for CPU skinning and for calculating
+per-vertex or per-instance transformations for GPU skinning.
+
+Expects that @p ids and @p weights have the same size, that their first
+dimension has the same size as @p out and that all IDs are in bounds for
+@p transformations. Weights for each item are expected to be non-negative and
+not all zero.
+@see @ref transformationMatrixInto(const Corrade::Containers::StridedArrayView1D<const DualQuaternion<Float>>&, const Corrade::Containers::StridedArrayView1D<Matrix4<Float>>&)
+*/
+MAGNUM_EXPORT void blendInto(const Corrade::Containers::StridedArrayView1D<const DualQuaternion<Float>>& transformations, const Corrade::Containers::StridedArrayView2D<const UnsignedInt>& ids, const Corrade::Containers::StridedArrayView2D<const Float>& weights, const Corrade::Containers::StridedArrayView1D<DualQuaternion<Float>>& out);
+
+/**
+@brief Convert dual quaternions to transformation matrices
+@param[in]  src     Source dual quaternions
+@param[out] dst     Destination matrices
+@m_since_latest
+
+Equivalent to calling @ref DualQuaternion::toMatrix() on each item. Expects
+that @p src and @p dst have the same size and that the dual quaternions are
+normalized.
+*/
+MAGNUM_EXPORT void transformationMatrixInto(const Corrade::Containers::StridedArrayView1D<const DualQuaternion<Float>>& src, const Corrade::Containers::StridedArrayView1D<Matrix4<Float>>& dst);
+
+/**
+@brief Combine translations, rotations and scalings into transformation matrices
+@param[in]  translations    Translations
+@param[in]  rotations       Rotations
+@param[in]  scalings        Scalings
+@param[out] dst             Destination matrices
+@m_since_latest
+
+Equivalent to the following for each item, i.e. first scaling, then rotating
+and then translating: @f[
+    \boldsymbol{M}_i = \boldsymbol{T}_i \boldsymbol{R}_i \boldsymbol{S}_i
+@f]
+
+Or, in code, @cpp Matrix4::from(rotations[i].toMatrix(), translations[i])*Matrix4::scaling(scalings[i]) @ce.
+Useful for calculating joint matrices from decomposed animated
+transformations. Expects that all views have the same size and that the
+rotation quaternions are normalized.
+*/
+MAGNUM_EXPORT void transformationMatrixInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& translations, const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& rotations, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& scalings, const Corrade::Containers::StridedArrayView1D<Matrix4<Float>>& dst);
+
+/* Since 1.8.17, the original short-hand group closing doesn't work anymore.
+   FFS. */
+/**
+ * @}
+ */
+
+}}
+
+#endif
@@ -256,7 +256,7 @@ template<std::size_t cols, std::size_t rows, class T> class RectangularMatrix {
          *
          * @see @ref row(), @ref data()
          */
-        Vector<rows, T>& operator[](std::size_t col) { return _data[col]; }
+        MAGNUM_CONSTEXPR14 Vector<rows, T>& operator[](std::size_t col) { return _data[col]; }
         /* returns const& so [][] operations are also constexpr */
         constexpr const Vector<rows, T>& operator[](std::size_t col) const { return _data[col]; } /**< @overload */
 
@@ -268,7 +268,7 @@ template<std::size_t cols, std::size_t rows, class T> class RectangularMatrix {
          * stored.
          * @see @ref setRow(), @ref operator[]()
          */
-        Vector<cols, T> row(std::size_t row) const;
+        MAGNUM_CONSTEXPR14 Vector<cols, T> row(std::size_t row) const;
 
         /**
          * @brief Set matrix row
@@ -341,7 +341,7 @@ template<std::size_t cols, std::size_t rows, class T> class RectangularMatrix {
          *      \boldsymbol B_j = -\boldsymbol A_j
          * @f]
          */
-        RectangularMatrix<cols, rows, T> operator-() const;
+        MAGNUM_CONSTEXPR14 RectangularMatrix<cols, rows, T> operator-() const;
 
         /**
          * @brief Add and assign a matrix
@@ -350,7 +350,7 @@ template<std::size_t cols, std::size_t rows, class T> class RectangularMatrix {
          *      \boldsymbol A_j = \boldsymbol A_j + \boldsymbol B_j
          * @f]
          */
-        RectangularMatrix<cols, rows, T>& operator+=(const RectangularMatrix<cols, rows, T>& other) {
+        MAGNUM_CONSTEXPR14 RectangularMatrix<cols, rows, T>& operator+=(const RectangularMatrix<cols, rows, T>& other) {
             for(std::size_t i = 0; i != cols; ++i)
                 _data[i] += other._data[i];
 
@@ -362,7 +362,7 @@ template<std::size_t cols, std::size_t rows, class T> class RectangularMatrix {
          *
          * @see @ref operator+=()
          */
-        RectangularMatrix<cols, rows, T> operator+(const RectangularMatrix<cols, rows, T>& other) const {
+        MAGNUM_CONSTEXPR14 RectangularMatrix<cols, rows, T> operator+(const RectangularMatrix<cols, rows, T>& other) const {
             return RectangularMatrix<cols, rows, T>(*this)+=other;
         }
 
@@ -373,7 +373,7 @@ template<std::size_t cols, std::size_t rows, class T> class RectangularMatrix {
          *      \boldsymbol A_j = \boldsymbol A_j - \boldsymbol B_j
          * @f]
          */
-        RectangularMatrix<cols, rows, T>& operator-=(const RectangularMatrix<cols, rows, T>& other) {
+        MAGNUM_CONSTEXPR14 RectangularMatrix<cols, rows, T>& operator-=(const RectangularMatrix<cols, rows, T>& other) {
             for(std::size_t i = 0; i != cols; ++i)
                 _data[i] -= other._data[i];
 
@@ -385,7 +385,7 @@ template<std::size_t cols, std::size_t rows, class T> class RectangularMatrix {
          *
          * @see @ref operator-=()
          */
-        RectangularMatrix<cols, rows, T> operator-(const RectangularMatrix<cols, rows, T>& other) const {
+        MAGNUM_CONSTEXPR14 RectangularMatrix<cols, rows, T> operator-(const RectangularMatrix<cols, rows, T>& other) const {
             return RectangularMatrix<cols, rows, T>(*this)-=other;
         }
 
@@ -396,7 +396,7 @@ template<std::size_t cols, std::size_t rows, class T> class RectangularMatrix {
          *      \boldsymbol A_j = a \boldsymbol A_j
          * @f]
          */
-        RectangularMatrix<cols, rows, T>& operator*=(T scalar) {
+        MAGNUM_CONSTEXPR14 RectangularMatrix<cols, rows, T>& operator*=(T scalar) {
             for(std::size_t i = 0; i != cols; ++i)
                 _data[i] *= scalar;
 
@@ -408,7 +408,7 @@ template<std::size_t cols, std::size_t rows, class T> class RectangularMatrix {
          *
          * @see @ref operator*=(T), @ref operator*(T, const RectangularMatrix<cols, rows, T>&)
          */
-        RectangularMatrix<cols, rows, T> operator*(T scalar) const {
+        MAGNUM_CONSTEXPR14 RectangularMatrix<cols, rows, T> operator*(T scalar) const {
             return RectangularMatrix<cols, rows, T>(*this) *= scalar;
         }
 
@@ -419,7 +419,7 @@ template<std::size_t cols, std::size_t rows, class T> class RectangularMatrix {
          *      \boldsymbol A_j = \frac{\boldsymbol A_j} a
          * @f]
          */
-        RectangularMatrix<cols, rows, T>& operator/=(T scalar) {
+        MAGNUM_CONSTEXPR14 RectangularMatrix<cols, rows, T>& operator/=(T scalar) {
             for(std::size_t i = 0; i != cols; ++i)
                 _data[i] /= scalar;
 
@@ -432,7 +432,7 @@ template<std::size_t cols, std::size_t rows, class T> class RectangularMatrix {
          * @see @ref operator/=(T),
          *      @ref operator/(T, const RectangularMatrix<cols, rows, T>&)
          */
-        RectangularMatrix<cols, rows, T> operator/(T scalar) const {
+        MAGNUM_CONSTEXPR14 RectangularMatrix<cols, rows, T> operator/(T scalar) const {
             return RectangularMatrix<cols, rows, T>(*this) /= scalar;
         }
 
@@ -444,7 +444,7 @@ template<std::size_t cols, std::size_t rows, class T> class RectangularMatrix {
          * @f]
          * @m_keyword{outerProduct(),GLSL outerProduct(),}
          */
-        template<std::size_t size> RectangularMatrix<size, rows, T> operator*(const RectangularMatrix<size, cols, T>& other) const;
+        template<std::size_t size> MAGNUM_CONSTEXPR14 RectangularMatrix<size, rows, T> operator*(const RectangularMatrix<size, cols, T>& other) const;
 
         /**
          * @brief Multiply a vector
@@ -454,7 +454,7 @@ template<std::size_t cols, std::size_t rows, class T> class RectangularMatrix {
          *      (\boldsymbol {Aa})_i = \sum_{k=0}^{m-1} \boldsymbol A_{ki} \boldsymbol a_k
          * @f]
          */
-        Vector<rows, T> operator*(const Vector<cols, T>& other) const {
+        MAGNUM_CONSTEXPR14 Vector<rows, T> operator*(const Vector<cols, T>& other) const {
             return operator*(RectangularMatrix<1, cols, T>(other))[0];
         }
 
@@ -467,7 +467,7 @@ template<std::size_t cols, std::size_t rows, class T> class RectangularMatrix {
          * @see @ref row(), @ref flippedCols(), @ref flippedRows()
          * @m_keyword{transpose(),GLSL transpose(),}
          */
-        RectangularMatrix<rows, cols, T> transposed() const;
+        MAGNUM_CONSTEXPR14 RectangularMatrix<rows, cols, T> transposed() const;
 
         /**
          * @brief Matrix with flipped cols
@@ -630,7 +630,7 @@ template<class T> using Matrix4x3 = RectangularMatrix<4, 3, T>;
 
 Same as @ref RectangularMatrix::operator*(T) const.
 */
-template<std::size_t cols, std::size_t rows, class T> inline RectangularMatrix<cols, rows, T> operator*(
+template<std::size_t cols, std::size_t rows, class T> MAGNUM_CONSTEXPR14 inline RectangularMatrix<cols, rows, T> operator*(
     #ifdef DOXYGEN_GENERATING_OUTPUT
     T
     #else
@@ -649,7 +649,7 @@ The computation is done column-wise. @f[
 @f]
 @see @ref RectangularMatrix::operator/(T) const
 */
-template<std::size_t cols, std::size_t rows, class T> inline RectangularMatrix<cols, rows, T> operator/(
+template<std::size_t cols, std::size_t rows, class T> MAGNUM_CONSTEXPR14 inline RectangularMatrix<cols, rows, T> operator/(
     #ifdef DOXYGEN_GENERATING_OUTPUT
     T
     #else
@@ -657,7 +657,8 @@ template<std::size_t cols, std::size_t rows, class T> inline RectangularMatrix<c
     #endif
     scalar, const RectangularMatrix<cols, rows, T>& matrix)
 {
-    RectangularMatrix<cols, rows, T> out{Magnum::NoInit};
+    /* Not NoInit in order to be usable in a C++14 constexpr context */
+    RectangularMatrix<cols, rows, T> out{ZeroInit};
 
     for(std::size_t i = 0; i != cols; ++i)
         out[i] = scalar/matrix[i];
@@ -673,7 +674,7 @@ Internally the same as multiplying one-column matrix with one-row matrix. @f[
 @f]
 @see @ref RectangularMatrix::operator*(const RectangularMatrix<size, cols, T>&) const
 */
-template<std::size_t size, std::size_t cols, class T> inline RectangularMatrix<cols, size, T> operator*(const Vector<size, T>& vector, const RectangularMatrix<cols, 1, T>& matrix) {
+template<std::size_t size, std::size_t cols, class T> MAGNUM_CONSTEXPR14 inline RectangularMatrix<cols, size, T> operator*(const Vector<size, T>& vector, const RectangularMatrix<cols, 1, T>& matrix) {
     return RectangularMatrix<1, size, T>(vector)*matrix;
 }
 
@@ -732,35 +733,35 @@ extern template MAGNUM_EXPORT Corrade::Utility::Debug& operator<<(Corrade::Utili
         return Math::RectangularMatrix<cols, rows, T>::fromDiagonal(diagonal); \
     }                                                                       \
                                                                             \
-    __VA_ARGS__ operator-() const {                                         \
+    MAGNUM_CONSTEXPR14 __VA_ARGS__ operator-() const {                      \
         return Math::RectangularMatrix<cols, rows, T>::operator-();         \
     }                                                                       \
-    __VA_ARGS__& operator+=(const Math::RectangularMatrix<cols, rows, T>& other) { \
+    MAGNUM_CONSTEXPR14 __VA_ARGS__& operator+=(const Math::RectangularMatrix<cols, rows, T>& other) { \
         Math::RectangularMatrix<cols, rows, T>::operator+=(other);          \
         return *this;                                                       \
     }                                                                       \
-    __VA_ARGS__ operator+(const Math::RectangularMatrix<cols, rows, T>& other) const { \
+    MAGNUM_CONSTEXPR14 __VA_ARGS__ operator+(const Math::RectangularMatrix<cols, rows, T>& other) const { \
         return Math::RectangularMatrix<cols, rows, T>::operator+(other);    \
     }                                                                       \
-    __VA_ARGS__& operator-=(const Math::RectangularMatrix<cols, rows, T>& other) { \
+    MAGNUM_CONSTEXPR14 __VA_ARGS__& operator-=(const Math::RectangularMatrix<cols, rows, T>& other) { \
         Math::RectangularMatrix<cols, rows, T>::operator-=(other);          \
         return *this;                                                       \
     }                                                                       \
-    __VA_ARGS__ operator-(const Math::RectangularMatrix<cols, rows, T>& other) const { \
+    MAGNUM_CONSTEXPR14 __VA_ARGS__ operator-(const Math::RectangularMatrix<cols, rows, T>& other) const { \
         return Math::RectangularMatrix<cols, rows, T>::operator-(other);    \
     }                                                                       \
-    __VA_ARGS__& operator*=(T number) {                                     \
+    MAGNUM_CONSTEXPR14 __VA_ARGS__& operator*=(T number) {                  \
         Math::RectangularMatrix<cols, rows, T>::operator*=(number);         \
         return *this;                                                       \
     }                                                                       \
-    __VA_ARGS__ operator*(T number) const {                                 \
+    MAGNUM_CONSTEXPR14 __VA_ARGS__ operator*(T number) const {              \
         return Math::RectangularMatrix<cols, rows, T>::operator*(number);   \
     }                                                                       \
-    __VA_ARGS__& operator/=(T number) {                                     \
+    MAGNUM_CONSTEXPR14 __VA_ARGS__& operator/=(T number) {                  \
         Math::RectangularMatrix<cols, rows, T>::operator/=(number);         \
         return *this;                                                       \
     }                                                                       \
-    __VA_ARGS__ operator/(T number) const {                                 \
+    MAGNUM_CONSTEXPR14 __VA_ARGS__ operator/(T number) const {              \
         return Math::RectangularMatrix<cols, rows, T>::operator/(number);   \
     }                                                                       \
     constexpr __VA_ARGS__ flippedCols() const {                             \
@@ -771,24 +772,24 @@ extern template MAGNUM_EXPORT Corrade::Utility::Debug& operator<<(Corrade::Utili
     }                                                                       \
 
 #define MAGNUM_MATRIX_OPERATOR_IMPLEMENTATION(...)                          \
-    template<std::size_t size, class T> inline __VA_ARGS__ operator*(typename std::common_type<T>::type number, const __VA_ARGS__& matrix) { \
+    template<std::size_t size, class T> MAGNUM_CONSTEXPR14 inline __VA_ARGS__ operator*(typename std::common_type<T>::type number, const __VA_ARGS__& matrix) { \
         return number*static_cast<const Math::RectangularMatrix<size, size, T>&>(matrix); \
     }                                                                       \
-    template<std::size_t size, class T> inline __VA_ARGS__ operator/(typename std::common_type<T>::type number, const __VA_ARGS__& matrix) { \
+    template<std::size_t size, class T> MAGNUM_CONSTEXPR14 inline __VA_ARGS__ operator/(typename std::common_type<T>::type number, const __VA_ARGS__& matrix) { \
         return number/static_cast<const Math::RectangularMatrix<size, size, T>&>(matrix); \
     }                                                                       \
-    template<std::size_t size, class T> inline __VA_ARGS__ operator*(const Vector<size, T>& vector, const RectangularMatrix<size, 1, T>& matrix) { \
+    template<std::size_t size, class T> MAGNUM_CONSTEXPR14 inline __VA_ARGS__ operator*(const Vector<size, T>& vector, const RectangularMatrix<size, 1, T>& matrix) { \
         return Math::RectangularMatrix<1, size, T>(vector)*matrix;          \
     }
 
 #define MAGNUM_MATRIXn_OPERATOR_IMPLEMENTATION(size, Type)                  \
-    template<class T> inline Type<T> operator*(typename std::common_type<T>::type number, const Type<T>& matrix) { \
+    template<class T> MAGNUM_CONSTEXPR14 inline Type<T> operator*(typename std::common_type<T>::type number, const Type<T>& matrix) { \
         return number*static_cast<const Math::RectangularMatrix<size, size, T>&>(matrix); \
     }                                                                       \
-    template<class T> inline Type<T> operator/(typename std::common_type<T>::type number, const Type<T>& matrix) { \
+    template<class T> MAGNUM_CONSTEXPR14 inline Type<T> operator/(typename std::common_type<T>::type number, const Type<T>& matrix) { \
         return number/static_cast<const Math::RectangularMatrix<size, size, T>&>(matrix); \
     }                                                                       \
-    template<class T> inline Type<T> operator*(const Vector<size, T>& vector, const RectangularMatrix<size, 1, T>& matrix) { \
+    template<class T> MAGNUM_CONSTEXPR14 inline Type<T> operator*(const Vector<size, T>& vector, const RectangularMatrix<size, 1, T>& matrix) { \
         return Math::RectangularMatrix<1, size, T>(vector)*matrix;          \
     }
 #endif
@@ -804,7 +805,7 @@ namespace Implementation {
 
 template<std::size_t cols, std::size_t rows, class T> template<std::size_t ...sequence> constexpr RectangularMatrix<cols, rows, T>::RectangularMatrix(Corrade::Containers::Implementation::Sequence<sequence...>, const Vector<DiagonalSize, T>& diagonal): _data{Implementation::diagonalMatrixColumn<rows, sequence>(sequence < DiagonalSize ? diagonal[sequence] : T{})...} {}
 
-template<std::size_t cols, std::size_t rows, class T> inline Vector<cols, T> RectangularMatrix<cols, rows, T>::row(std::size_t row) const {
+template<std::size_t cols, std::size_t rows, class T> MAGNUM_CONSTEXPR14 inline Vector<cols, T> RectangularMatrix<cols, rows, T>::row(std::size_t row) const {
     Vector<cols, T> out;
 
     /* Using ._data[] instead of [] to avoid function call indirection
@@ -822,7 +823,7 @@ template<std::size_t cols, std::size_t rows, class T> inline void RectangularMat
         _data[i]._data[row] = data._data[i];
 }
 
-template<std::size_t cols, std::size_t rows, class T> inline RectangularMatrix<cols, rows, T> RectangularMatrix<cols, rows, T>::operator-() const {
+template<std::size_t cols, std::size_t rows, class T> MAGNUM_CONSTEXPR14 inline RectangularMatrix<cols, rows, T> RectangularMatrix<cols, rows, T>::operator-() const {
     RectangularMatrix<cols, rows, T> out;
 
     for(std::size_t i = 0; i != cols; ++i)
@@ -831,7 +832,7 @@ template<std::size_t cols, std::size_t rows, class T> inline RectangularMatrix<c
     return out;
 }
 
-template<std::size_t cols, std::size_t rows, class T> template<std::size_t size> inline RectangularMatrix<size, rows, T> RectangularMatrix<cols, rows, T>::operator*(const RectangularMatrix<size, cols, T>& other) const {
+template<std::size_t cols, std::size_t rows, class T> template<std::size_t size> MAGNUM_CONSTEXPR14 inline RectangularMatrix<size, rows, T> RectangularMatrix<cols, rows, T>::operator*(const RectangularMatrix<size, cols, T>& other) const {
     RectangularMatrix<size, rows, T> out{ZeroInit};
 
     /* Using ._data[] instead of [] to avoid function call indirection
@@ -844,8 +845,9 @@ template<std::size_t cols, std::size_t rows, class T> template<std::size_t size>
     return out;
 }
 
-template<std::size_t cols, std::size_t rows, class T> inline RectangularMatrix<rows, cols, T> RectangularMatrix<cols, rows, T>::transposed() const {
-    RectangularMatrix<rows, cols, T> out{Magnum::NoInit};
+template<std::size_t cols, std::size_t rows, class T> MAGNUM_CONSTEXPR14 inline RectangularMatrix<rows, cols, T> RectangularMatrix<cols, rows, T>::transposed() const {
+    /* Not NoInit in order to be usable in a C++14 constexpr context */
+    RectangularMatrix<rows, cols, T> out{ZeroInit};
 
     /* Using ._data[] instead of [] to avoid function call indirection
        on debug builds (saves a lot, yet doesn't obfuscate too much) */
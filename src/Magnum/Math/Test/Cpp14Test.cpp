@@ -0,0 +1,143 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Quaternion.h"
+
+namespace Magnum { namespace Math { namespace Test { namespace {
+
+/* Tests functions that are constexpr only with the relaxed C++14 rules, i.e.
+   the ones marked with MAGNUM_CONSTEXPR14. The values are calculated at
+   compile time and then compared to the same operation done at runtime. */
+
+struct Cpp14Test: Corrade::TestSuite::Tester {
+    explicit Cpp14Test();
+
+    void vector();
+    void matrix();
+    void matrix4();
+    void quaternion();
+};
+
+typedef Math::Vector2<Float> Vector2;
+typedef Math::Vector3<Float> Vector3;
+typedef Math::Matrix3x3<Float> Matrix3x3;
+typedef Math::Matrix4<Float> Matrix4;
+typedef Math::Quaternion<Float> Quaternion;
+
+Cpp14Test::Cpp14Test() {
+    addTests({&Cpp14Test::vector,
+              &Cpp14Test::matrix,
+              &Cpp14Test::matrix4,
+              &Cpp14Test::quaternion});
+}
+
+void Cpp14Test::vector() {
+    constexpr Vector3 a = Vector3{1.0f, 2.0f, 3.0f}*2.0f - Vector3{0.5f, 1.0f, -1.0f};
+    constexpr Vector3 negated = -a;
+    constexpr Vector3 inverted = 1.0f/Vector3{2.0f, 4.0f, 0.5f};
+    constexpr Float dot = Math::dot(a, Vector3{2.0f, 1.0f, 0.0f});
+    constexpr Float sum = a.sum();
+    constexpr Vector3 cross = Math::cross(Vector3::xAxis(), Vector3::yAxis());
+    CORRADE_COMPARE(a, (Vector3{1.5f, 3.0f, 7.0f}));
+    CORRADE_COMPARE(negated, (Vector3{-1.5f, -3.0f, -7.0f}));
+    CORRADE_COMPARE(inverted, (Vector3{0.5f, 0.25f, 2.0f}));
+    CORRADE_COMPARE(dot, 6.0f);
+    CORRADE_COMPARE(sum, 11.5f);
+    CORRADE_COMPARE(cross, Vector3::zAxis());
+}
+
+void Cpp14Test::matrix() {
+    constexpr Matrix3x3 a{Vector3{2.0f, 0.0f, 0.0f},
+                          Vector3{0.0f, 4.0f, 0.0f},
+                          Vector3{1.0f, 0.0f, 1.0f}};
+    constexpr Float determinant = a.determinant();
+    constexpr Float trace = a.trace();
+    constexpr Matrix3x3 transposed = a.transposed();
+    constexpr Matrix3x3 inverted = a.inverted();
+    constexpr Matrix3x3 identity = a*inverted;
+    constexpr Vector3 transformed = a*Vector3{1.0f, 1.0f, 1.0f};
+    CORRADE_COMPARE(determinant, 8.0f);
+    CORRADE_COMPARE(trace, 7.0f);
+    CORRADE_COMPARE(transposed, (Matrix3x3{Vector3{2.0f, 0.0f, 1.0f},
+                                           Vector3{0.0f, 4.0f, 0.0f},
+                                           Vector3{0.0f, 0.0f, 1.0f}}));
+    CORRADE_COMPARE(inverted, (Matrix3x3{Vector3{0.5f, 0.0f, 0.0f},
+                                         Vector3{0.0f, 0.25f, 0.0f},
+                                         Vector3{-0.5f, 0.0f, 1.0f}}));
+    CORRADE_COMPARE(identity, Matrix3x3{});
+    CORRADE_COMPARE(transformed, (Vector3{3.0f, 4.0f, 1.0f}));
+}
+
+void Cpp14Test::matrix4() {
+    constexpr Matrix4 perspective = Matrix4::perspectiveProjection(Vector2{16.0f, 9.0f}, 32.0f, 100.0f);
+    constexpr Matrix4 perspectiveInfinite = Matrix4::perspectiveProjection(Vector2{-16.0f, -9.0f}, Vector2{16.0f, 9.0f}, 32.0f, Constants<Float>::inf());
+    constexpr Matrix4 orthographic = Matrix4::orthographicProjection(Vector2{5.0f, 4.0f}, 1.0f, 9.0f);
+    constexpr Matrix4 transformation = Matrix4::translation({1.0f, 2.0f, 3.0f})*Matrix4::scaling(Vector3{2.0f});
+    constexpr Matrix4 inverted = transformation.inverted();
+    constexpr Vector3 point = transformation.transformPoint({1.0f, 1.0f, 1.0f});
+    constexpr Vector3 vector = transformation.transformVector({1.0f, 1.0f, 1.0f});
+
+    /* Variables to force runtime evaluation */
+    Vector2 size{16.0f, 9.0f};
+    Float infinity = Constants<Float>::inf();
+    CORRADE_COMPARE(perspective, Matrix4::perspectiveProjection(size, 32.0f, 100.0f));
+    CORRADE_COMPARE(perspectiveInfinite, Matrix4::perspectiveProjection(-size, size, 32.0f, infinity));
+    CORRADE_COMPARE(orthographic, Matrix4::orthographicProjection(Vector2{5.0f, 4.0f}, 1.0f, 9.0f));
+    CORRADE_COMPARE(inverted, Matrix4::scaling(Vector3{0.5f})*Matrix4::translation({-1.0f, -2.0f, -3.0f}));
+    CORRADE_COMPARE(point, (Vector3{3.0f, 4.0f, 5.0f}));
+    CORRADE_COMPARE(vector, (Vector3{2.0f, 2.0f, 2.0f}));
+}
+
+void Cpp14Test::quaternion() {
+    constexpr Quaternion a{{1.0f, 2.0f, 3.0f}, 4.0f};
+    constexpr Quaternion b{{-1.0f, 0.5f, 2.0f}, 1.0f};
+    /* Normalized, rotation around X */
+    constexpr Quaternion rotation{{0.6f, 0.0f, 0.0f}, 0.8f};
+    constexpr Quaternion multiplied = a*b;
+    constexpr Quaternion added = a + b*2.0f;
+    constexpr Float dot = Math::dot(a, b);
+    constexpr Quaternion conjugated = a.conjugated();
+    constexpr Matrix3x3 matrix = rotation.toMatrix();
+    constexpr Vector3 transformed = rotation.transformVector({0.0f, 1.0f, 0.0f});
+
+    /* Variables to force runtime evaluation */
+    Quaternion ra = a;
+    Quaternion rb = b;
+    Quaternion rrotation = rotation;
+    CORRADE_COMPARE(multiplied, ra*rb);
+    CORRADE_COMPARE(added, (Quaternion{{-1.0f, 3.0f, 7.0f}, 6.0f}));
+    CORRADE_COMPARE(dot, 10.0f);
+    CORRADE_COMPARE(conjugated, (Quaternion{{-1.0f, -2.0f, -3.0f}, 4.0f}));
+    CORRADE_COMPARE(matrix, rrotation.toMatrix());
+    CORRADE_COMPARE(transformed, rrotation.transformVectorNormalized({0.0f, 1.0f, 0.0f}));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::Cpp14Test)
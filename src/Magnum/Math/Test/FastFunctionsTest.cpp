@@ -0,0 +1,333 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <limits>
+#include <sstream>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/FastFunctions.h"
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum { namespace Math { namespace Test { namespace {
+
+struct FastFunctionsTest: Corrade::TestSuite::Tester {
+    explicit FastFunctionsTest();
+
+    void sinCos();
+    void sinCosSpecial();
+    void sincos();
+    void exp();
+    void expSpecial();
+    void log();
+    void logSpecial();
+
+    void sinCosInto();
+    void sinCosIntoStrided();
+    void sinCosIntoInPlace();
+    void sincosInto();
+    void expLogInto();
+    void empty();
+
+    void assertions();
+};
+
+typedef Math::Deg<Float> Deg;
+typedef Math::Rad<Float> Rad;
+
+using namespace Literals;
+
+FastFunctionsTest::FastFunctionsTest() {
+    addTests({&FastFunctionsTest::sinCos,
+              &FastFunctionsTest::sinCosSpecial,
+              &FastFunctionsTest::sincos,
+              &FastFunctionsTest::exp,
+              &FastFunctionsTest::expSpecial,
+              &FastFunctionsTest::log,
+              &FastFunctionsTest::logSpecial,
+
+              &FastFunctionsTest::sinCosInto,
+              &FastFunctionsTest::sinCosIntoStrided,
+              &FastFunctionsTest::sinCosIntoInPlace,
+              &FastFunctionsTest::sincosInto,
+              &FastFunctionsTest::expLogInto,
+              &FastFunctionsTest::empty,
+
+              &FastFunctionsTest::assertions});
+}
+
+void FastFunctionsTest::sinCos() {
+    /* Verify the documented error bounds against a double-precision
+       reference over the whole documented range */
+    Double maxSinError = 0.0, maxCosError = 0.0;
+    for(Int i = -1000000; i <= 1000000; i += 3) {
+        const Float angle = Float(i)*0.01f;
+        maxSinError = Math::max(maxSinError, Math::abs(Double(Fast::sin(Rad(angle))) - std::sin(Double(angle))));
+        maxCosError = Math::max(maxCosError, Math::abs(Double(Fast::cos(Rad(angle))) - std::cos(Double(angle))));
+    }
+    CORRADE_COMPARE_AS(maxSinError, 1.5e-7,
+        Corrade::TestSuite::Compare::LessOrEqual);
+    CORRADE_COMPARE_AS(maxCosError, 2.5e-7,
+        Corrade::TestSuite::Compare::LessOrEqual);
+
+    /* Degree overloads */
+    CORRADE_COMPARE(Fast::sin(30.0_degf), 0.5f);
+    CORRADE_COMPARE(Fast::cos(60.0_degf), 0.5f);
+    CORRADE_COMPARE(Fast::sin(2*15.0_degf), 0.5f);
+}
+
+void FastFunctionsTest::sinCosSpecial() {
+    CORRADE_COMPARE(Fast::sin(0.0_radf), 0.0f);
+    CORRADE_COMPARE(Fast::cos(0.0_radf), 1.0f);
+    CORRADE_COMPARE(Fast::sin(90.0_degf), 1.0f);
+    CORRADE_COMPARE(Fast::cos(180.0_degf), -1.0f);
+    CORRADE_COMPARE(Fast::sin(-90.0_degf), -1.0f);
+
+    /* The sign is preserved for negative angles */
+    CORRADE_COMPARE(Fast::sin(-30.0_degf), -0.5f);
+    CORRADE_COMPARE(Fast::cos(-60.0_degf), 0.5f);
+}
+
+void FastFunctionsTest::sincos() {
+    for(Int i = -1000; i <= 1000; ++i) {
+        const Rad angle{Float(i)*0.037f};
+        CORRADE_ITERATION(angle);
+        const std::pair<Float, Float> out = Fast::sincos(angle);
+        /* Should be bit-exact with the separate variants */
+        CORRADE_VERIFY(out.first == Fast::sin(angle));
+        CORRADE_VERIFY(out.second == Fast::cos(angle));
+    }
+
+    const std::pair<Float, Float> out = Fast::sincos(30.0_degf);
+    CORRADE_COMPARE(out.first, 0.5f);
+    CORRADE_COMPARE(out.second, 0.866025f);
+}
+
+void FastFunctionsTest::exp() {
+    Double maxError = 0.0;
+    for(Int i = -8733000; i <= 8837000; i += 7) {
+        const Float value = Float(i)*0.00001f;
+        const Double expected = std::exp(Double(value));
+        /* Values that would end up denormal have a lower precision */
+        if(expected < Double(std::numeric_limits<Float>::min())) continue;
+        maxError = Math::max(maxError, Math::abs(Double(Fast::exp(value)) - expected)/expected);
+    }
+    CORRADE_COMPARE_AS(maxError, 1.0e-7,
+        Corrade::TestSuite::Compare::LessOrEqual);
+}
+
+void FastFunctionsTest::expSpecial() {
+    CORRADE_COMPARE(Fast::exp(0.0f), 1.0f);
+    CORRADE_COMPARE(Fast::exp(1.0f), Constants<Float>::e());
+    CORRADE_COMPARE(Fast::exp(-1.0f), 1.0f/Constants<Float>::e());
+
+    /* Out-of-range inputs are clamped instead of going to infinity */
+    CORRADE_VERIFY(!Math::isInf(Fast::exp(1000.0f)));
+    CORRADE_COMPARE_AS(Fast::exp(1000.0f), 1.0e38f,
+        Corrade::TestSuite::Compare::Greater);
+    CORRADE_COMPARE_AS(Fast::exp(-1000.0f), 1.2e-38f,
+        Corrade::TestSuite::Compare::Less);
+    CORRADE_COMPARE_AS(Fast::exp(-1000.0f), 0.0f,
+        Corrade::TestSuite::Compare::GreaterOrEqual);
+}
+
+void FastFunctionsTest::log() {
+    /* Going through all exponents of normal floats and a few mantissas for
+       each */
+    Double maxError = 0.0;
+    for(Int exponent = -126; exponent <= 127; ++exponent) {
+        for(Int i = 0; i != 4096; ++i) {
+            const Float value = std::ldexp(1.0f + Float(i)/4096.0f, exponent);
+            const Double expected = std::log(Double(value));
+            /* The relative error doesn't make sense around zero */
+            if(Math::abs(expected) < 1.0e-30) continue;
+            maxError = Math::max(maxError, Math::abs((Double(Fast::log(value)) - expected)/expected));
+        }
+    }
+    CORRADE_COMPARE_AS(maxError, 1.0e-7,
+        Corrade::TestSuite::Compare::LessOrEqual);
+}
+
+void FastFunctionsTest::logSpecial() {
+    CORRADE_COMPARE(Fast::log(1.0f), 0.0f);
+    CORRADE_COMPARE(Fast::log(Constants<Float>::e()), 1.0f);
+    CORRADE_COMPARE(Fast::log(2.0f), 0.693147f);
+    CORRADE_COMPARE(Fast::log(0.5f), -0.693147f);
+}
+
+void FastFunctionsTest::sinCosInto() {
+    /* Eleven items so both the SIMD implementation and the remainder is
+       tested */
+    const Rad src[]{
+        0.0_radf, 0.5_radf, -1.2_radf, 3.5_radf, 100.0_radf, -250.0_radf,
+        7.7_radf, 0.001_radf, -0.001_radf, 1570.7963_radf, -42.0_radf
+    };
+    Float sinOut[Corrade::Containers::arraySize(src)];
+    Float cosOut[Corrade::Containers::arraySize(src)];
+    Fast::sinInto(src, sinOut);
+    Fast::cosInto(src, cosOut);
+
+    /* Ensure the results are consistent with non-batch APIs */
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(src); ++i) {
+        CORRADE_ITERATION(src[i]);
+        CORRADE_COMPARE(sinOut[i], Fast::sin(src[i]));
+        CORRADE_COMPARE(cosOut[i], Fast::cos(src[i]));
+    }
+}
+
+void FastFunctionsTest::sinCosIntoStrided() {
+    /* Interleaved with other data to test non-trivial strides, which makes
+       the functions go through the scalar code */
+    struct Data {
+        Rad src;
+        Float dst;
+        Float padding;
+    } data[]{
+        {0.0_radf, 0.0f, 1.0f},
+        {0.5_radf, 0.0f, 1.0f},
+        {-1.2_radf, 0.0f, 1.0f},
+        {3.5_radf, 0.0f, 1.0f},
+        {100.0_radf, 0.0f, 1.0f},
+    };
+
+    Corrade::Containers::StridedArrayView1D<const Rad> src{data, &data[0].src, Corrade::Containers::arraySize(data), sizeof(Data)};
+    Corrade::Containers::StridedArrayView1D<Float> dst{data, &data[0].dst, Corrade::Containers::arraySize(data), sizeof(Data)};
+    Fast::sinInto(src, dst);
+    for(const Data& i: data) {
+        CORRADE_ITERATION(i.src);
+        CORRADE_COMPARE(i.dst, Fast::sin(i.src));
+        /* The padding shouldn't get overwritten */
+        CORRADE_COMPARE(i.padding, 1.0f);
+    }
+
+    Fast::cosInto(src, dst);
+    for(const Data& i: data) {
+        CORRADE_ITERATION(i.src);
+        CORRADE_COMPARE(i.dst, Fast::cos(i.src));
+    }
+}
+
+void FastFunctionsTest::sinCosIntoInPlace() {
+    const Rad src[]{
+        0.0_radf, 0.5_radf, -1.2_radf, 3.5_radf, 100.0_radf, -250.0_radf
+    };
+    Rad data[]{
+        0.0_radf, 0.5_radf, -1.2_radf, 3.5_radf, 100.0_radf, -250.0_radf
+    };
+    Fast::sinInto(data, Corrade::Containers::arrayCast<Float>(Corrade::Containers::stridedArrayView(data)));
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(src); ++i) {
+        CORRADE_ITERATION(src[i]);
+        CORRADE_COMPARE(Float(data[i]), Fast::sin(src[i]));
+    }
+}
+
+void FastFunctionsTest::sincosInto() {
+    const Rad src[]{
+        0.0_radf, 0.5_radf, -1.2_radf, 3.5_radf, 100.0_radf, -250.0_radf,
+        7.7_radf, 0.001_radf, -0.001_radf, 1570.7963_radf, -42.0_radf
+    };
+    Float sinOut[Corrade::Containers::arraySize(src)];
+    Float cosOut[Corrade::Containers::arraySize(src)];
+    Fast::sincosInto(src, sinOut, cosOut);
+
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(src); ++i) {
+        CORRADE_ITERATION(src[i]);
+        CORRADE_COMPARE(sinOut[i], Fast::sin(src[i]));
+        CORRADE_COMPARE(cosOut[i], Fast::cos(src[i]));
+    }
+}
+
+void FastFunctionsTest::expLogInto() {
+    const Float src[]{
+        0.5f, 1.0f, 2.5f, 0.001f, 17.0f, 80.0f, 1.0e-20f, 3.3f, 12345.0f,
+        0.75f, 1.0e20f
+    };
+    Float expOut[Corrade::Containers::arraySize(src)];
+    Float logOut[Corrade::Containers::arraySize(src)];
+    Fast::expInto(src, expOut);
+    Fast::logInto(src, logOut);
+
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(src); ++i) {
+        CORRADE_ITERATION(src[i]);
+        CORRADE_COMPARE(expOut[i], Fast::exp(src[i]));
+        CORRADE_COMPARE(logOut[i], Fast::log(src[i]));
+    }
+
+    /* In-place */
+    Float data[Corrade::Containers::arraySize(src)];
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(src); ++i)
+        data[i] = src[i];
+    Fast::logInto(data, data);
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(src); ++i) {
+        CORRADE_ITERATION(src[i]);
+        CORRADE_COMPARE(data[i], logOut[i]);
+    }
+}
+
+void FastFunctionsTest::empty() {
+    /* Shouldn't crash or do anything */
+    Fast::sinInto(
+        Corrade::Containers::StridedArrayView1D<const Rad>{},
+        Corrade::Containers::StridedArrayView1D<Float>{});
+    Fast::sincosInto(
+        Corrade::Containers::StridedArrayView1D<const Rad>{},
+        Corrade::Containers::StridedArrayView1D<Float>{},
+        Corrade::Containers::StridedArrayView1D<Float>{});
+    Fast::expInto(
+        Corrade::Containers::StridedArrayView1D<const Float>{},
+        Corrade::Containers::StridedArrayView1D<Float>{});
+    CORRADE_VERIFY(true);
+}
+
+void FastFunctionsTest::assertions() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const Rad angles[2]{};
+    const Float values[2]{};
+    Float result2[2];
+    Float result3[3];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Fast::sinInto(angles, result3);
+    Fast::cosInto(angles, result3);
+    Fast::sincosInto(angles, result2, result3);
+    Fast::sincosInto(angles, result3, result2);
+    Fast::expInto(values, result3);
+    Fast::logInto(values, result3);
+    CORRADE_COMPARE(out.str(),
+        "Math::Fast::sinInto(): wrong destination size, got 3 but expected 2\n"
+        "Math::Fast::cosInto(): wrong destination size, got 3 but expected 2\n"
+        "Math::Fast::sincosInto(): wrong destination sizes, got 2 and 3 but expected 2\n"
+        "Math::Fast::sincosInto(): wrong destination sizes, got 3 and 2 but expected 2\n"
+        "Math::Fast::expInto(): wrong destination size, got 3 but expected 2\n"
+        "Math::Fast::logInto(): wrong destination size, got 3 but expected 2\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::FastFunctionsTest)
@@ -44,6 +44,10 @@ struct FunctionsBatchTest: Corrade::TestSuite::Tester {
 
     void nanIgnoring();
     void nanIgnoringVector();
+
+    void largeContiguous();
+    void largeContiguousVector();
+    void largeContiguousIntegral();
 };
 
 using namespace Literals;
@@ -62,7 +66,11 @@ FunctionsBatchTest::FunctionsBatchTest() {
               &FunctionsBatchTest::minmax,
 
               &FunctionsBatchTest::nanIgnoring,
-              &FunctionsBatchTest::nanIgnoringVector});
+              &FunctionsBatchTest::nanIgnoringVector,
+
+              &FunctionsBatchTest::largeContiguous,
+              &FunctionsBatchTest::largeContiguousVector,
+              &FunctionsBatchTest::largeContiguousIntegral});
 }
 
 void FunctionsBatchTest::isInf() {
@@ -284,6 +292,87 @@ void FunctionsBatchTest::nanIgnoringVector() {
     CORRADE_COMPARE(Math::minmax(allNan).second[1], Constants::nan());
 }
 
+void FunctionsBatchTest::largeContiguous() {
+    /* Contiguous Float ranges are processed with SIMD instructions in chunks,
+       make sure the results are the same as with a strided view, which goes
+       through the scalar loop. 50 values, so there's a remainder. */
+    Float data[50];
+    Float strided[100]{};
+    for(std::size_t i = 0; i != 50; ++i)
+        data[i] = Float((i*37 + 1)%50) - 20.0f;
+    /* NaNs at the start and in the middle of a chunk should be ignored */
+    data[0] = Constants::nan();
+    data[17] = Constants::nan();
+    for(std::size_t i = 0; i != 50; ++i)
+        strided[i*2] = data[i];
+    Corrade::Containers::StridedArrayView1D<const Float> stridedView{strided, strided, 50, 2*sizeof(Float)};
+
+    CORRADE_VERIFY(Math::isNan(data));
+    CORRADE_VERIFY(Math::isNan(stridedView));
+    CORRADE_VERIFY(!Math::isInf(data));
+    CORRADE_VERIFY(!Math::isInf(stridedView));
+    CORRADE_COMPARE(Math::min(data), -20.0f);
+    CORRADE_COMPARE(Math::min(stridedView), -20.0f);
+    CORRADE_COMPARE(Math::max(data), 29.0f);
+    CORRADE_COMPARE(Math::max(stridedView), 29.0f);
+    CORRADE_COMPARE(Math::minmax(data), std::make_pair(-20.0f, 29.0f));
+    CORRADE_COMPARE(Math::minmax(stridedView), std::make_pair(-20.0f, 29.0f));
+
+    /* Infinity in the remainder */
+    data[49] = -Constants::inf();
+    strided[98] = -Constants::inf();
+    CORRADE_VERIFY(Math::isInf(data));
+    CORRADE_VERIFY(Math::isInf(stridedView));
+    CORRADE_COMPARE(Math::min(data), -Constants::inf());
+    CORRADE_COMPARE(Math::min(stridedView), -Constants::inf());
+}
+
+void FunctionsBatchTest::largeContiguousVector() {
+    /* Three-component vectors don't fit evenly into four-component SIMD
+       registers, verify the per-component results are still correct */
+    Vector3 data[21];
+    for(std::size_t i = 0; i != 21; ++i)
+        data[i] = {Float(i), -Float(i), Float((i*5)%21)};
+    /* NaN only in the Y component, infinity only in the Z component */
+    data[0].y() = Constants::nan();
+    data[11].y() = Constants::nan();
+    data[13].z() = Constants::inf();
+
+    CORRADE_COMPARE(Math::isNan(data), BitVector<3>{2});
+    CORRADE_COMPARE(Math::isInf(data), BitVector<3>{4});
+    CORRADE_COMPARE(Math::min(data), (Vector3{0.0f, -20.0f, 0.0f}));
+    CORRADE_COMPARE(Math::max(data), (Vector3{20.0f, -1.0f, Constants::inf()}));
+    CORRADE_COMPARE(Math::minmax(data), std::make_pair(
+        Vector3{0.0f, -20.0f, 0.0f},
+        Vector3{20.0f, -1.0f, Constants::inf()}));
+
+    /* A component that's all NaNs stays NaN */
+    for(Vector3& i: data) i.x() = Constants::nan();
+    CORRADE_COMPARE(Math::isNan(data), BitVector<3>{3});
+    /* Need to compare this way because of NaNs */
+    CORRADE_COMPARE(Math::min(data)[0], Constants::nan());
+    CORRADE_COMPARE(Math::min(data)[1], -20.0f);
+    CORRADE_COMPARE(Math::max(data)[0], Constants::nan());
+    CORRADE_COMPARE(Math::max(data)[2], Constants::inf());
+}
+
+void FunctionsBatchTest::largeContiguousIntegral() {
+    /* Contiguous integer ranges go through a loop the compiler can
+       vectorize */
+    Int data[50];
+    Vector3i vectors[50];
+    for(std::size_t i = 0; i != 50; ++i) {
+        data[i] = Int((i*37)%50) - 20;
+        vectors[i] = {data[i], -data[i], Int(i)};
+    }
+
+    CORRADE_COMPARE(Math::min(data), -20);
+    CORRADE_COMPARE(Math::max(data), 29);
+    CORRADE_COMPARE(Math::minmax(data), std::make_pair(-20, 29));
+    CORRADE_COMPARE(Math::minmax(vectors), std::make_pair(
+        Vector3i{-20, -29, 0}, Vector3i{29, 20, 49}));
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Math::Test::FunctionsBatchTest)
@@ -23,10 +23,13 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <Corrade/Containers/Array.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Numeric.h>
 
-#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/FastFunctions.h"
+#include "Magnum/Math/FunctionsBatch.h"
+#include "Magnum/Math/Vector3.h"
 
 #ifdef CORRADE_TARGET_SSE2
 #include <xmmintrin.h>
@@ -48,6 +51,21 @@ struct FunctionsBenchmark: Corrade::TestSuite::Tester {
 
     void sinCosSeparate();
     void sinCosCombined();
+    void sinCosCombinedFast();
+
+    void minmaxBatchStrided();
+    void minmaxBatchContiguous();
+    void minmaxBatchVector3Strided();
+    void minmaxBatchVector3Contiguous();
+    void isNanBatchStrided();
+    void isNanBatchContiguous();
+
+    void sinBatch();
+    void sinBatchFast();
+    void expBatch();
+    void expBatchFast();
+    void logBatch();
+    void logBatchFast();
 };
 
 FunctionsBenchmark::FunctionsBenchmark() {
@@ -65,12 +83,28 @@ FunctionsBenchmark::FunctionsBenchmark() {
     }, 500);
 
     addBenchmarks({&FunctionsBenchmark::sinCosSeparate,
-                   &FunctionsBenchmark::sinCosCombined}, 100);
+                   &FunctionsBenchmark::sinCosCombined,
+                   &FunctionsBenchmark::sinCosCombinedFast}, 100);
+
+    addBenchmarks({&FunctionsBenchmark::minmaxBatchStrided,
+                   &FunctionsBenchmark::minmaxBatchContiguous,
+                   &FunctionsBenchmark::minmaxBatchVector3Strided,
+                   &FunctionsBenchmark::minmaxBatchVector3Contiguous,
+                   &FunctionsBenchmark::isNanBatchStrided,
+                   &FunctionsBenchmark::isNanBatchContiguous}, 100);
+
+    addBenchmarks({&FunctionsBenchmark::sinBatch,
+                   &FunctionsBenchmark::sinBatchFast,
+                   &FunctionsBenchmark::expBatch,
+                   &FunctionsBenchmark::expBatchFast,
+                   &FunctionsBenchmark::logBatch,
+                   &FunctionsBenchmark::logBatchFast}, 100);
 }
 
 typedef Math::Constants<Float> Constants;
 typedef Math::Deg<Float> Deg;
 typedef Math::Rad<Float> Rad;
+typedef Math::Vector3<Float> Vector3;
 
 enum: std::size_t { Repeats = 100000 };
 
@@ -223,6 +257,166 @@ void FunctionsBenchmark::sinCosCombined() {
     CORRADE_VERIFY(cos == cos);
 }
 
+void FunctionsBenchmark::sinCosCombinedFast() {
+    Float sin{}, cos{}, a{};
+    CORRADE_BENCHMARK(1000) {
+        auto sincos = Math::Fast::sincos(Rad(a));
+        sin += sincos.first;
+        cos += sincos.second;
+        a += 0.1f;
+    }
+
+    CORRADE_COMPARE_AS(a, 10.0f, Corrade::TestSuite::Compare::Greater);
+
+    /* To avoid the whole loop being optimized away */
+    CORRADE_VERIFY(sin == sin);
+    CORRADE_VERIFY(cos == cos);
+}
+
+/* The strided variants have every other item unused, which makes the batch
+   functions go through the scalar loop instead of the SIMD implementation */
+enum: std::size_t { BatchSize = 16384 };
+
+template<class T> Corrade::Containers::Array<T> batchData(const std::size_t stride) {
+    Corrade::Containers::Array<T> out{ValueInit, BatchSize*stride};
+    for(std::size_t i = 0; i != BatchSize; ++i)
+        out[i*stride] = T(Float(i%1000)*0.5f - 100.0f);
+    return out;
+}
+
+void FunctionsBenchmark::minmaxBatchStrided() {
+    Corrade::Containers::Array<Float> data = batchData<Float>(2);
+    Corrade::Containers::StridedArrayView1D<const Float> view{data, data.data(), BatchSize, 2*sizeof(Float)};
+
+    std::pair<Float, Float> out;
+    CORRADE_BENCHMARK(10)
+        out = Math::minmax(view);
+
+    CORRADE_COMPARE(out, std::make_pair(-100.0f, 399.5f));
+}
+
+void FunctionsBenchmark::minmaxBatchContiguous() {
+    Corrade::Containers::Array<Float> data = batchData<Float>(1);
+
+    std::pair<Float, Float> out;
+    CORRADE_BENCHMARK(10)
+        out = Math::minmax(data);
+
+    CORRADE_COMPARE(out, std::make_pair(-100.0f, 399.5f));
+}
+
+void FunctionsBenchmark::minmaxBatchVector3Strided() {
+    Corrade::Containers::Array<Vector3> data = batchData<Vector3>(2);
+    Corrade::Containers::StridedArrayView1D<const Vector3> view{data, data.data(), BatchSize, 2*sizeof(Vector3)};
+
+    std::pair<Vector3, Vector3> out;
+    CORRADE_BENCHMARK(10)
+        out = Math::minmax(view);
+
+    CORRADE_COMPARE(out, std::make_pair(Vector3{-100.0f}, Vector3{399.5f}));
+}
+
+void FunctionsBenchmark::minmaxBatchVector3Contiguous() {
+    Corrade::Containers::Array<Vector3> data = batchData<Vector3>(1);
+
+    std::pair<Vector3, Vector3> out;
+    CORRADE_BENCHMARK(10)
+        out = Math::minmax(data);
+
+    CORRADE_COMPARE(out, std::make_pair(Vector3{-100.0f}, Vector3{399.5f}));
+}
+
+void FunctionsBenchmark::isNanBatchStrided() {
+    Corrade::Containers::Array<Float> data = batchData<Float>(2);
+    Corrade::Containers::StridedArrayView1D<const Float> view{data, data.data(), BatchSize, 2*sizeof(Float)};
+
+    /* No NaNs, so the whole range is always checked */
+    bool out = true;
+    CORRADE_BENCHMARK(10)
+        out = Math::isNan(view);
+
+    CORRADE_VERIFY(!out);
+}
+
+void FunctionsBenchmark::isNanBatchContiguous() {
+    Corrade::Containers::Array<Float> data = batchData<Float>(1);
+
+    /* No NaNs, so the whole range is always checked */
+    bool out = true;
+    CORRADE_BENCHMARK(10)
+        out = Math::isNan(data);
+
+    CORRADE_VERIFY(!out);
+}
+
+/* The naive variants call the libm functions in a loop, the fast variants
+   go through the batch APIs, which use SSE2 or NEON for contiguous data */
+void FunctionsBenchmark::sinBatch() {
+    Corrade::Containers::Array<Float> data = batchData<Float>(1);
+    Corrade::Containers::Array<Float> out{NoInit, BatchSize};
+
+    CORRADE_BENCHMARK(10)
+        for(std::size_t i = 0; i != BatchSize; ++i)
+            out[i] = Math::sin(Rad(data[i]));
+
+    CORRADE_COMPARE(out[200], Math::sin(Rad(0.0f)));
+}
+
+void FunctionsBenchmark::sinBatchFast() {
+    Corrade::Containers::Array<Float> data = batchData<Float>(1);
+    Corrade::Containers::Array<Float> out{NoInit, BatchSize};
+
+    CORRADE_BENCHMARK(10)
+        Math::Fast::sinInto(Corrade::Containers::arrayCast<const Rad>(Corrade::Containers::arrayView(data)), Corrade::Containers::arrayView(out));
+
+    CORRADE_COMPARE(out[200], Math::sin(Rad(0.0f)));
+}
+
+void FunctionsBenchmark::expBatch() {
+    Corrade::Containers::Array<Float> data = batchData<Float>(1);
+    for(Float& i: data) i *= 0.1f;
+    Corrade::Containers::Array<Float> out{NoInit, BatchSize};
+
+    CORRADE_BENCHMARK(10)
+        for(std::size_t i = 0; i != BatchSize; ++i)
+            out[i] = Math::exp(data[i]);
+
+    CORRADE_COMPARE(out[200], 1.0f);
+}
+
+void FunctionsBenchmark::expBatchFast() {
+    Corrade::Containers::Array<Float> data = batchData<Float>(1);
+    for(Float& i: data) i *= 0.1f;
+    Corrade::Containers::Array<Float> out{NoInit, BatchSize};
+
+    CORRADE_BENCHMARK(10)
+        Math::Fast::expInto(Corrade::Containers::arrayView(data), Corrade::Containers::arrayView(out));
+
+    CORRADE_COMPARE(out[200], 1.0f);
+}
+
+void FunctionsBenchmark::logBatch() {
+    Corrade::Containers::Array<Float> data = batchData<Float>(1);
+    for(Float& i: data) i = Math::abs(i) + 1.0f;
+    Corrade::Containers::Array<Float> out{NoInit, BatchSize};
+
+    CORRADE_BENCHMARK(10)
+        for(std::size_t i = 0; i != BatchSize; ++i)
+            out[i] = Math::log(data[i]);
+
+    CORRADE_COMPARE(out[200], 0.0f);
+}
+
+void FunctionsBenchmark::logBatchFast() {
+    Corrade::Containers::Array<Float> data = batchData<Float>(1);
+    for(Float& i: data) i = Math::abs(i) + 1.0f;
+    Corrade::Containers::Array<Float> out{NoInit, BatchSize};
+
+    CORRADE_BENCHMARK(10)
+        Math::Fast::logInto(Corrade::Containers::arrayView(data), Corrade::Containers::arrayView(out));
+
+    CORRADE_COMPARE(out[200], 0.0f);
+}
 
 }}}}
 
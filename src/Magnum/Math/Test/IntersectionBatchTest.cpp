@@ -0,0 +1,368 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/BitArray.h>
+#include <Corrade/Containers/BitArrayView.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Intersection.h"
+#include "Magnum/Math/IntersectionBatch.h"
+
+namespace Magnum { namespace Math { namespace Test { namespace {
+
+struct IntersectionBatchTest: Corrade::TestSuite::Tester {
+    explicit IntersectionBatchTest();
+
+    void sphereFrustum();
+    void sphereFrustumPlaneCache();
+    void rangeFrustum();
+    void rangeFrustumPlaneCache();
+    void aabbFrustum();
+    void aabbFrustumPlaneCache();
+    void sphereConeView();
+    void empty();
+
+    void invalidSize();
+    void sphereConeViewNotRigid();
+};
+
+typedef Math::Vector3<Float> Vector3;
+typedef Math::Matrix4<Float> Matrix4;
+typedef Math::Frustum<Float> Frustum;
+typedef Math::Range3D<Float> Range3D;
+typedef Math::Rad<Float> Rad;
+typedef Math::Deg<Float> Deg;
+
+/* Same as in IntersectionTest::sphereFrustum() */
+const Frustum SphereFrustum{
+    {1.0f, 0.0f, 0.0f, 0.0f},
+    {-1.0f, 0.0f, 0.0f, 10.0f},
+    {0.0f, 1.0f, 0.0f, 0.0f},
+    {0.0f, -1.0f, 0.0f, 10.0f},
+    {0.0f, 0.0f, 1.0f, 0.0f},
+    {0.0f, 0.0f, -1.0f, 10.0f}};
+
+/* Same as in IntersectionTest::rangeFrustum() */
+const Frustum RangeFrustum{
+    {1.0f, 0.0f, 0.0f, 0.0f},
+    {-1.0f, 0.0f, 0.0f, 5.0f},
+    {0.0f, 1.0f, 0.0f, 0.0f},
+    {0.0f, -1.0f, 0.0f, 1.0f},
+    {0.0f, 0.0f, 1.0f, 0.0f},
+    {0.0f, 0.0f, -1.0f, 10.0f}};
+
+/* Interleaved with other data to test non-trivial strides. The first plane
+   rejecting given item, if any, is in the comment. */
+const struct Sphere {
+    Vector3 center;
+    Int padding;
+    Float radius;
+} Spheres[]{
+    /* On edge */
+    {{0.0f, 0.0f, -1.0f}, 0, 1.5f},
+    /* Inside */
+    {{5.5f, 5.5f, 5.5f}, 0, 1.5f},
+    /* Outside, in front of the far plane */
+    {{0.0f, 0.0f, 100.0f}, 0, 0.5f},
+    /* Outside, left of the left plane */
+    {{-5.0f, 5.0f, 5.0f}, 0, 1.0f},
+    /* Outside, above the top plane */
+    {{5.0f, 20.0f, 5.0f}, 0, 1.0f},
+    /* Outside of the left and bottom plane, the left is reported */
+    {{-5.0f, -5.0f, 5.0f}, 0, 1.0f},
+};
+
+const struct Range {
+    Range3D range;
+    Int padding;
+} Ranges[]{
+    /* Fully inside */
+    {{Vector3{1.0f}, Vector3{2.0f}}, 0},
+    /* Intersects with exactly one plane each */
+    {Range3D::fromSize({2.4f, -0.1f, 4.9f}, Vector3{0.2f}), 0},
+    {Range3D::fromSize({2.4f, 0.9f, 4.9f}, Vector3{0.2f}), 0},
+    {Range3D::fromSize({-0.1f, 0.4f, 4.9f}, Vector3{0.2f}), 0},
+    {Range3D::fromSize({4.9f, 0.4f, 4.9f}, Vector3{0.2f}), 0},
+    {Range3D::fromSize({2.4f, 0.4f, -0.1f}, Vector3{0.2f}), 0},
+    {Range3D::fromSize({2.4f, 0.4f, 9.9f}, Vector3{0.2f}), 0},
+    /* Bigger than frustum, but still intersects */
+    {{Vector3{-100.0f}, Vector3{100.0f}}, 0},
+    /* Outside of frustum, behind the first, third and fifth plane */
+    {{Vector3{-10.0f}, Vector3{-5.0f}}, 0},
+    /* Outside of frustum, in front of the fourth plane */
+    {{{1.0f, 3.0f, 1.0f}, {2.0f, 4.0f, 2.0f}}, 0},
+};
+
+IntersectionBatchTest::IntersectionBatchTest() {
+    addTests({&IntersectionBatchTest::sphereFrustum,
+              &IntersectionBatchTest::sphereFrustumPlaneCache,
+              &IntersectionBatchTest::rangeFrustum,
+              &IntersectionBatchTest::rangeFrustumPlaneCache,
+              &IntersectionBatchTest::aabbFrustum,
+              &IntersectionBatchTest::aabbFrustumPlaneCache,
+              &IntersectionBatchTest::sphereConeView,
+              &IntersectionBatchTest::empty,
+
+              &IntersectionBatchTest::invalidSize,
+              &IntersectionBatchTest::sphereConeViewNotRigid});
+}
+
+void IntersectionBatchTest::sphereFrustum() {
+    const Corrade::Containers::StridedArrayView1D<const Sphere> spheres = Spheres;
+
+    /* Fill with garbage to verify that all bits get overwritten */
+    Corrade::Containers::BitArray intersects{DirectInit, spheres.size(), true};
+    CORRADE_COMPARE(Intersection::sphereFrustumInto(spheres.slice(&Sphere::center), spheres.slice(&Sphere::radius), SphereFrustum, intersects), 2);
+
+    /* Ensure the results are consistent with non-batch APIs */
+    for(std::size_t i = 0; i != spheres.size(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(intersects[i], Intersection::sphereFrustum(spheres[i].center, spheres[i].radius, SphereFrustum));
+    }
+    CORRADE_VERIFY(intersects[0]);
+    CORRADE_VERIFY(intersects[1]);
+    CORRADE_VERIFY(!intersects[2]);
+}
+
+void IntersectionBatchTest::sphereFrustumPlaneCache() {
+    const Corrade::Containers::StridedArrayView1D<const Sphere> spheres = Spheres;
+
+    Corrade::Containers::BitArray intersects{ValueInit, spheres.size()};
+    UnsignedByte planeCache[6]{};
+    CORRADE_COMPARE(Intersection::sphereFrustumInto(spheres.slice(&Sphere::center), spheres.slice(&Sphere::radius), SphereFrustum, intersects, planeCache), 2);
+
+    /* The first rejecting plane is remembered for items outside, the others
+       are left untouched */
+    CORRADE_COMPARE(planeCache[0], 0);
+    CORRADE_COMPARE(planeCache[1], 0);
+    CORRADE_COMPARE(planeCache[2], 5);
+    CORRADE_COMPARE(planeCache[3], 0);
+    CORRADE_COMPARE(planeCache[4], 3);
+    CORRADE_COMPARE(planeCache[5], 0);
+
+    /* Stale or out-of-range values in the cache shouldn't affect the
+       result */
+    planeCache[0] = 4;
+    planeCache[1] = 0xff;
+    planeCache[2] = 1;
+    planeCache[5] = 6;
+    intersects = Corrade::Containers::BitArray{ValueInit, intersects.size()};
+    CORRADE_COMPARE(Intersection::sphereFrustumInto(spheres.slice(&Sphere::center), spheres.slice(&Sphere::radius), SphereFrustum, intersects, planeCache), 2);
+    for(std::size_t i = 0; i != spheres.size(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(intersects[i], Intersection::sphereFrustum(spheres[i].center, spheres[i].radius, SphereFrustum));
+    }
+
+    /* The stale value got updated, the out-of-range value for an item outside
+       as well */
+    CORRADE_COMPARE(planeCache[0], 4);
+    CORRADE_COMPARE(planeCache[1], 0xff);
+    CORRADE_COMPARE(planeCache[2], 5);
+    CORRADE_COMPARE(planeCache[5], 0);
+}
+
+void IntersectionBatchTest::rangeFrustum() {
+    const Corrade::Containers::StridedArrayView1D<const Range> ranges = Ranges;
+
+    Corrade::Containers::BitArray intersects{DirectInit, ranges.size(), true};
+    CORRADE_COMPARE(Intersection::rangeFrustumInto(ranges.slice(&Range::range), RangeFrustum, intersects), 8);
+
+    for(std::size_t i = 0; i != ranges.size(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(intersects[i], Intersection::rangeFrustum(ranges[i].range, RangeFrustum));
+    }
+    CORRADE_VERIFY(!intersects[8]);
+    CORRADE_VERIFY(!intersects[9]);
+}
+
+void IntersectionBatchTest::rangeFrustumPlaneCache() {
+    const Corrade::Containers::StridedArrayView1D<const Range> ranges = Ranges;
+
+    Corrade::Containers::BitArray intersects{ValueInit, ranges.size()};
+    UnsignedByte planeCache[10]{};
+    /* A stale value for the last range */
+    planeCache[9] = 1;
+    CORRADE_COMPARE(Intersection::rangeFrustumInto(ranges.slice(&Range::range), RangeFrustum, intersects, planeCache), 8);
+    for(std::size_t i = 0; i != ranges.size(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(intersects[i], Intersection::rangeFrustum(ranges[i].range, RangeFrustum));
+    }
+
+    CORRADE_COMPARE(planeCache[8], 0);
+    CORRADE_COMPARE(planeCache[9], 3);
+
+    /* Second run with the cache filled gives the same result */
+    intersects = Corrade::Containers::BitArray{ValueInit, intersects.size()};
+    CORRADE_COMPARE(Intersection::rangeFrustumInto(ranges.slice(&Range::range), RangeFrustum, intersects, planeCache), 8);
+    for(std::size_t i = 0; i != ranges.size(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(intersects[i], Intersection::rangeFrustum(ranges[i].range, RangeFrustum));
+    }
+}
+
+void IntersectionBatchTest::aabbFrustum() {
+    Vector3 centers[Corrade::Containers::arraySize(Ranges)];
+    Vector3 extents[Corrade::Containers::arraySize(Ranges)];
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(Ranges); ++i) {
+        centers[i] = Ranges[i].range.center();
+        extents[i] = Ranges[i].range.size()*0.5f;
+    }
+
+    Corrade::Containers::BitArray intersects{DirectInit, Corrade::Containers::arraySize(Ranges), true};
+    CORRADE_COMPARE(Intersection::aabbFrustumInto(centers, extents, RangeFrustum, intersects), 8);
+
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(Ranges); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(intersects[i], Intersection::aabbFrustum(centers[i], extents[i], RangeFrustum));
+    }
+    CORRADE_VERIFY(!intersects[8]);
+    CORRADE_VERIFY(!intersects[9]);
+}
+
+void IntersectionBatchTest::aabbFrustumPlaneCache() {
+    Vector3 centers[Corrade::Containers::arraySize(Ranges)];
+    Vector3 extents[Corrade::Containers::arraySize(Ranges)];
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(Ranges); ++i) {
+        centers[i] = Ranges[i].range.center();
+        extents[i] = Ranges[i].range.size()*0.5f;
+    }
+
+    Corrade::Containers::BitArray intersects{ValueInit, Corrade::Containers::arraySize(Ranges)};
+    UnsignedByte planeCache[10]{};
+    CORRADE_COMPARE(Intersection::aabbFrustumInto(centers, extents, RangeFrustum, intersects, planeCache), 8);
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(Ranges); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(intersects[i], Intersection::aabbFrustum(centers[i], extents[i], RangeFrustum));
+    }
+
+    CORRADE_COMPARE(planeCache[8], 0);
+    CORRADE_COMPARE(planeCache[9], 3);
+}
+
+void IntersectionBatchTest::sphereConeView() {
+    /* Same setup as in IntersectionTest::sphereConeView() */
+    const Vector3 center{1.0f, -2.0f, 1.3f};
+    const Vector3 normal{Vector3{0.5f, 1.0f, 2.0f}.normalized()};
+    const Matrix4 coneView = Matrix4::lookAt(center, center + normal, Vector3::yAxis()).invertedRigid();
+    const Rad angle{Deg{72.0f}};
+
+    const Vector3 axis = Math::cross(Vector3::yAxis(), normal).normalized();
+    const Vector3 surface = Matrix4::rotation(0.5f*angle, axis).transformVector(normal);
+    const Vector3 surfaceNormal = Matrix4::rotation(Rad{Deg{90.0f}}, axis).transformVector(surface);
+
+    const Sphere spheres[]{
+        /* Fully contained in the cone */
+        {center + normal*5.0f, 0, 0.8f},
+        /* Fully contained in the double side of the cone */
+        {center + normal*-5.0f, 0, 0.75f},
+        /* Fully outside of the cone */
+        {center + surface + surfaceNormal*5.0f, 0, 0.75f},
+        /* Intersecting the apex, with the center behind the cone plane */
+        {center - normal*0.1f, 0, 0.55f},
+        /* Intersecting the apex, with the center in front of the cone plane */
+        {center + normal*0.1f, 0, 0.55f},
+    };
+    const Corrade::Containers::StridedArrayView1D<const Sphere> view = spheres;
+
+    Corrade::Containers::BitArray intersects{DirectInit, view.size(), false};
+    CORRADE_COMPARE(Intersection::sphereConeViewInto(view.slice(&Sphere::center), view.slice(&Sphere::radius), coneView, angle, intersects), 3);
+    for(std::size_t i = 0; i != view.size(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(intersects[i], Intersection::sphereConeView(spheres[i].center, spheres[i].radius, coneView, angle));
+    }
+    CORRADE_VERIFY(intersects[0]);
+    CORRADE_VERIFY(!intersects[1]);
+    CORRADE_VERIFY(!intersects[2]);
+}
+
+void IntersectionBatchTest::empty() {
+    /* Shouldn't crash or do anything */
+    CORRADE_COMPARE(Intersection::sphereFrustumInto(nullptr, nullptr, SphereFrustum, nullptr), 0);
+    CORRADE_COMPARE(Intersection::sphereFrustumInto(nullptr, nullptr, SphereFrustum, nullptr, nullptr), 0);
+    CORRADE_COMPARE(Intersection::rangeFrustumInto(nullptr, RangeFrustum, nullptr), 0);
+    CORRADE_COMPARE(Intersection::aabbFrustumInto(nullptr, nullptr, RangeFrustum, nullptr), 0);
+    CORRADE_COMPARE(Intersection::sphereConeViewInto(nullptr, nullptr, Matrix4{}, Rad{Deg{72.0f}}, nullptr), 0);
+}
+
+void IntersectionBatchTest::invalidSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Vector3 centers[3]{};
+    Float radii[3]{};
+    Float radiiInvalid[2]{};
+    Range3D ranges[3]{};
+    UnsignedByte planeCache[2]{};
+    Corrade::Containers::BitArray intersects{ValueInit, 3};
+    Corrade::Containers::BitArray intersectsInvalid{ValueInit, 4};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Intersection::sphereFrustumInto(centers, radiiInvalid, SphereFrustum, intersects);
+    Intersection::sphereFrustumInto(centers, radii, SphereFrustum, intersectsInvalid);
+    Intersection::sphereFrustumInto(centers, radii, SphereFrustum, intersects, planeCache);
+    Intersection::rangeFrustumInto(ranges, RangeFrustum, intersectsInvalid);
+    Intersection::rangeFrustumInto(ranges, RangeFrustum, intersects, planeCache);
+    Intersection::aabbFrustumInto(centers, Corrade::Containers::arrayView(centers).prefix(2), RangeFrustum, intersects);
+    Intersection::aabbFrustumInto(centers, centers, RangeFrustum, intersectsInvalid);
+    Intersection::aabbFrustumInto(centers, centers, RangeFrustum, intersects, planeCache);
+    Intersection::sphereConeViewInto(centers, radiiInvalid, Matrix4{}, 0.5f, 0.5f, intersects);
+    Intersection::sphereConeViewInto(centers, radii, Matrix4{}, 0.5f, 0.5f, intersectsInvalid);
+    CORRADE_COMPARE(out.str(),
+        "Math::Intersection::sphereFrustumInto(): expected 3 sphere radii and output bits but got 2 and 3\n"
+        "Math::Intersection::sphereFrustumInto(): expected 3 sphere radii and output bits but got 3 and 4\n"
+        "Math::Intersection::sphereFrustumInto(): expected 3 plane cache items but got 2\n"
+        "Math::Intersection::rangeFrustumInto(): expected 3 output bits but got 4\n"
+        "Math::Intersection::rangeFrustumInto(): expected 3 plane cache items but got 2\n"
+        "Math::Intersection::aabbFrustumInto(): expected 3 AABB extents and output bits but got 2 and 3\n"
+        "Math::Intersection::aabbFrustumInto(): expected 3 AABB extents and output bits but got 3 and 4\n"
+        "Math::Intersection::aabbFrustumInto(): expected 3 plane cache items but got 2\n"
+        "Math::Intersection::sphereConeViewInto(): expected 3 sphere radii and output bits but got 2 and 3\n"
+        "Math::Intersection::sphereConeViewInto(): expected 3 sphere radii and output bits but got 3 and 4\n");
+}
+
+void IntersectionBatchTest::sphereConeViewNotRigid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Vector3 centers[1]{};
+    Float radii[1]{};
+    Corrade::Containers::BitArray intersects{ValueInit, 1};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Intersection::sphereConeViewInto(centers, radii, Matrix4{ZeroInit}, Rad{}, intersects);
+    CORRADE_COMPARE(out.str(),
+        "Math::Intersection::sphereConeViewInto(): coneView does not represent a rigid transformation:\n"
+        "Matrix(0, 0, 0, 0,\n"
+        "       0, 0, 0, 0,\n"
+        "       0, 0, 0, 0,\n"
+        "       0, 0, 0, 0)\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::IntersectionBatchTest)
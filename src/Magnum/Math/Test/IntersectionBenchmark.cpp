@@ -26,10 +26,16 @@
 
 #include <random>
 #include <utility>
+#include <vector>
+#include <Corrade/Containers/ArrayViewStl.h>
+#include <Corrade/Containers/BitArray.h>
+#include <Corrade/Containers/BitArrayView.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
 
 #include "Magnum/Math/Angle.h"
 #include "Magnum/Math/Intersection.h"
+#include "Magnum/Math/IntersectionBatch.h"
 
 namespace Magnum { namespace Math { namespace Test { namespace {
 
@@ -102,14 +108,19 @@ struct IntersectionBenchmark: Corrade::TestSuite::Tester {
 
     void rangeFrustumNaive();
     void rangeFrustum();
+    void rangeFrustumBatch();
+    void rangeFrustumBatchPlaneCache();
 
     void rangeCone();
 
     void sphereFrustum();
+    void sphereFrustumBatch();
+    void sphereFrustumBatchPlaneCache();
 
     void sphereConeNaive();
     void sphereCone();
     void sphereConeView();
+    void sphereConeViewBatch();
 
     Frustum _frustum;
     struct {
@@ -126,14 +137,19 @@ struct IntersectionBenchmark: Corrade::TestSuite::Tester {
 IntersectionBenchmark::IntersectionBenchmark() {
     addBenchmarks({&IntersectionBenchmark::rangeFrustumNaive,
                    &IntersectionBenchmark::rangeFrustum,
+                   &IntersectionBenchmark::rangeFrustumBatch,
+                   &IntersectionBenchmark::rangeFrustumBatchPlaneCache,
 
                    &IntersectionBenchmark::rangeCone,
 
                    &IntersectionBenchmark::sphereFrustum,
+                   &IntersectionBenchmark::sphereFrustumBatch,
+                   &IntersectionBenchmark::sphereFrustumBatchPlaneCache,
 
                    &IntersectionBenchmark::sphereConeNaive,
                    &IntersectionBenchmark::sphereCone,
-                   &IntersectionBenchmark::sphereConeView}, 10);
+                   &IntersectionBenchmark::sphereConeView,
+                   &IntersectionBenchmark::sphereConeViewBatch}, 10);
 
     /* Generate random data for the benchmarks */
     std::random_device rnd;
@@ -173,6 +189,31 @@ void IntersectionBenchmark::rangeFrustum() {
     }
 }
 
+void IntersectionBenchmark::rangeFrustumBatch() {
+    Corrade::Containers::BitArray intersects{ValueInit, _boxes.size()};
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(50) {
+        count += Intersection::rangeFrustumInto(Corrade::Containers::arrayView(_boxes), _frustum, intersects);
+    }
+
+    CORRADE_VERIFY(count <= 50*_boxes.size());
+}
+
+void IntersectionBenchmark::rangeFrustumBatchPlaneCache() {
+    /* Filling the cache outside of the benchmark loop to simulate a
+       steady state with objects not moving between frames */
+    Corrade::Containers::BitArray intersects{ValueInit, _boxes.size()};
+    std::vector<UnsignedByte> planeCache(_boxes.size());
+    Intersection::rangeFrustumInto(Corrade::Containers::arrayView(_boxes), _frustum, intersects, Corrade::Containers::arrayView(planeCache));
+
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(50) {
+        count += Intersection::rangeFrustumInto(Corrade::Containers::arrayView(_boxes), _frustum, intersects, Corrade::Containers::arrayView(planeCache));
+    }
+
+    CORRADE_VERIFY(count <= 50*_boxes.size());
+}
+
 void IntersectionBenchmark::rangeCone() {
     volatile bool b = false;
     CORRADE_BENCHMARK(50) {
@@ -191,6 +232,33 @@ void IntersectionBenchmark::sphereFrustum() {
     }
 }
 
+void IntersectionBenchmark::sphereFrustumBatch() {
+    const Corrade::Containers::StridedArrayView1D<Vector4> spheres = Corrade::Containers::arrayView(_spheres);
+    Corrade::Containers::BitArray intersects{ValueInit, _spheres.size()};
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(50) {
+        count += Intersection::sphereFrustumInto(spheres.slice(&Vector4::xyz), spheres.slice(&Vector4::w), _frustum, intersects);
+    }
+
+    CORRADE_VERIFY(count <= 50*_spheres.size());
+}
+
+void IntersectionBenchmark::sphereFrustumBatchPlaneCache() {
+    /* Filling the cache outside of the benchmark loop to simulate a
+       steady state with objects not moving between frames */
+    const Corrade::Containers::StridedArrayView1D<Vector4> spheres = Corrade::Containers::arrayView(_spheres);
+    Corrade::Containers::BitArray intersects{ValueInit, _spheres.size()};
+    std::vector<UnsignedByte> planeCache(_spheres.size());
+    Intersection::sphereFrustumInto(spheres.slice(&Vector4::xyz), spheres.slice(&Vector4::w), _frustum, intersects, Corrade::Containers::arrayView(planeCache));
+
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(50) {
+        count += Intersection::sphereFrustumInto(spheres.slice(&Vector4::xyz), spheres.slice(&Vector4::w), _frustum, intersects, Corrade::Containers::arrayView(planeCache));
+    }
+
+    CORRADE_VERIFY(count <= 50*_spheres.size());
+}
+
 void IntersectionBenchmark::sphereConeNaive() {
     volatile bool b = false;
     CORRADE_BENCHMARK(50) for(auto& sphere: _spheres) {
@@ -221,6 +289,19 @@ void IntersectionBenchmark::sphereConeView() {
     }
 }
 
+void IntersectionBenchmark::sphereConeViewBatch() {
+    const Corrade::Containers::StridedArrayView1D<Vector4> spheres = Corrade::Containers::arrayView(_spheres);
+    Corrade::Containers::BitArray intersects{ValueInit, _spheres.size()};
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(50) {
+        const Float sinAngle = Math::sin(_cone.angle);
+        const Float tanAngle = Math::tan(_cone.angle);
+        count += Intersection::sphereConeViewInto(spheres.slice(&Vector4::xyz), spheres.slice(&Vector4::w), _coneView, sinAngle, tanAngle, intersects);
+    }
+
+    CORRADE_VERIFY(count <= 50*_spheres.size());
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Math::Test::IntersectionBenchmark)
@@ -23,10 +23,13 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
 
 #include "Magnum/Math/Matrix3.h"
 #include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/TransformBatch.h"
 #include "Magnum/Math/Algorithms/GaussJordan.h"
 
 namespace Magnum { namespace Math { namespace Test { namespace {
@@ -48,6 +51,11 @@ struct MatrixBenchmark: Corrade::TestSuite::Tester {
     void invert4Rigid();
     void invert4Orthogonal();
 
+    void normalMatrix4();
+    void normalMatrix4Batch();
+    void invert4Batch();
+    void invert4RigidBatch();
+
     void transformVector3();
     void transformPoint3();
     void transformVector4();
@@ -69,6 +77,11 @@ MatrixBenchmark::MatrixBenchmark() {
                    &MatrixBenchmark::invert4Rigid,
                    &MatrixBenchmark::invert4Orthogonal}, 50);
 
+    addBenchmarks({&MatrixBenchmark::normalMatrix4,
+                   &MatrixBenchmark::normalMatrix4Batch,
+                   &MatrixBenchmark::invert4Batch,
+                   &MatrixBenchmark::invert4RigidBatch}, 50);
+
     addBenchmarks({&MatrixBenchmark::transformVector3,
                    &MatrixBenchmark::transformPoint3,
                    &MatrixBenchmark::transformVector4,
@@ -80,6 +93,7 @@ typedef Math::Vector3<Float> Vector3;
 typedef Math::Vector4<Float> Vector4;
 typedef Math::Matrix4<Float> Matrix4;
 typedef Math::Matrix3<Float> Matrix3;
+typedef Math::Matrix3x3<Float> Matrix3x3;
 
 enum: std::size_t { Repeats = 10000 };
 
@@ -201,6 +215,49 @@ void MatrixBenchmark::invert4Orthogonal() {
     CORRADE_VERIFY(a.toVector().sum() != 0);
 }
 
+void MatrixBenchmark::normalMatrix4() {
+    Matrix4 a = Data4;
+    CORRADE_BENCHMARK(Repeats) {
+        a = Matrix4::from(a.normalMatrix(), a.translation());
+    }
+
+    CORRADE_VERIFY(a.toVector().sum() != 0);
+}
+
+/* The batch variants process Repeats different matrices in a single call
+   instead of feeding the output back to the input, so the timings are
+   directly comparable to the per-element variants above */
+
+void MatrixBenchmark::normalMatrix4Batch() {
+    Corrade::Containers::Array<Matrix4> a{Corrade::DirectInit, Repeats, Data4};
+    Corrade::Containers::Array<Matrix3x3> out{Corrade::NoInit, Repeats};
+    CORRADE_BENCHMARK(1) {
+        normalMatricesInto(Corrade::Containers::arrayView(a), Corrade::Containers::arrayView(out));
+    }
+
+    CORRADE_VERIFY(out[0].toVector().sum() != 0);
+}
+
+void MatrixBenchmark::invert4Batch() {
+    Corrade::Containers::Array<Matrix4> a{Corrade::DirectInit, Repeats, Data4};
+    const Corrade::Containers::StridedArrayView1D<Matrix4> view = Corrade::Containers::arrayView(a);
+    CORRADE_BENCHMARK(1) {
+        invertedInto(view, view);
+    }
+
+    CORRADE_VERIFY(a[0].toVector().sum() != 0);
+}
+
+void MatrixBenchmark::invert4RigidBatch() {
+    Corrade::Containers::Array<Matrix4> a{Corrade::DirectInit, Repeats, Data4Rigid};
+    const Corrade::Containers::StridedArrayView1D<Matrix4> view = Corrade::Containers::arrayView(a);
+    CORRADE_BENCHMARK(1) {
+        invertedRigidInto(view, view);
+    }
+
+    CORRADE_VERIFY(a[0].toVector().sum() != 0);
+}
+
 void MatrixBenchmark::transformVector3() {
     Vector2 a{3.0f, -2.2f};
     CORRADE_BENCHMARK(Repeats) {
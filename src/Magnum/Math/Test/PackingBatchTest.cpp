@@ -48,8 +48,13 @@ struct PackingBatchTest: Corrade::TestSuite::Tester {
     void packSignedByte();
     void packSignedShort();
 
+    template<class T> void packUnpackContiguous();
+    template<class T> void packUnpackInterleaved();
+
     void unpackHalf();
     void packHalf();
+    void packUnpackHalfContiguous();
+    void packUnpackHalfInterleaved();
 
     template<class FloatingPoint, class Integral> void castUnsignedFloatingPoint();
     template<class FloatingPoint, class Integral> void castSignedFloatingPoint();
@@ -73,9 +78,19 @@ PackingBatchTest::PackingBatchTest() {
               &PackingBatchTest::packUnsignedShort,
               &PackingBatchTest::packSignedByte,
               &PackingBatchTest::packSignedShort,
+              &PackingBatchTest::packUnpackContiguous<UnsignedByte>,
+              &PackingBatchTest::packUnpackContiguous<Byte>,
+              &PackingBatchTest::packUnpackContiguous<UnsignedShort>,
+              &PackingBatchTest::packUnpackContiguous<Short>,
+              &PackingBatchTest::packUnpackInterleaved<UnsignedByte>,
+              &PackingBatchTest::packUnpackInterleaved<Byte>,
+              &PackingBatchTest::packUnpackInterleaved<UnsignedShort>,
+              &PackingBatchTest::packUnpackInterleaved<Short>,
 
               &PackingBatchTest::unpackHalf,
               &PackingBatchTest::packHalf,
+              &PackingBatchTest::packUnpackHalfContiguous,
+              &PackingBatchTest::packUnpackHalfInterleaved,
 
               &PackingBatchTest::castUnsignedFloatingPoint<Float, UnsignedByte>,
               &PackingBatchTest::castUnsignedFloatingPoint<Float, UnsignedShort>,
@@ -379,6 +394,75 @@ void PackingBatchTest::packSignedShort() {
         CORRADE_COMPARE(Math::pack<Vector2s>(data[i].src), data[i].dst);
 }
 
+template<class T> void PackingBatchTest::packUnpackContiguous() {
+    setTestCaseTemplateName(TypeTraits<T>::name());
+
+    /* 13 three-component items, i.e. 39 values in total, so most of the data
+       goes through the vectorized code paths and the rest through the scalar
+       loop */
+    constexpr Float bitMax = Implementation::bitMax<T>();
+    const Float min = std::is_signed<T>::value ? -1.0f : 0.0f;
+    Float src[39];
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(src); ++i) {
+        src[i] = min + (1.0f - min)*Float(i)/38.0f;
+        /* Some values exactly in the middle between two integers, to test
+           the rounding */
+        if(i % 5 == 0) src[i] = (Math::floor(src[i]*bitMax) + 0.5f)/bitMax;
+    }
+
+    T packed[39];
+    Float unpacked[39];
+    packInto(Corrade::Containers::StridedArrayView2D<const Float>{src, {13, 3}},
+             Corrade::Containers::StridedArrayView2D<T>{packed, {13, 3}});
+    unpackInto(Corrade::Containers::StridedArrayView2D<const T>{packed, {13, 3}},
+               Corrade::Containers::StridedArrayView2D<Float>{unpacked, {13, 3}});
+
+    /* Ensure the results are consistent with non-batch APIs */
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(src); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(packed[i], Math::pack<T>(src[i]));
+        CORRADE_COMPARE(unpacked[i], Math::unpack<Float>(packed[i]));
+    }
+}
+
+template<class T> void PackingBatchTest::packUnpackInterleaved() {
+    setTestCaseTemplateName(TypeTraits<T>::name());
+
+    /* Three components out of four, like a vertex attribute interleaved with
+       others. Has enough rows to span several gathered tiles and the
+       vectorized kernels, and a count that's not a multiple of the tile
+       size so the last tile is partial. */
+    constexpr Float bitMax = Implementation::bitMax<T>();
+    const Float min = std::is_signed<T>::value ? -1.0f : 0.0f;
+    Float src[1001*4]{};
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(src); ++i) {
+        src[i] = min + (1.0f - min)*Float(i % 97)/96.0f;
+        /* Some values exactly in the middle between two integers, to test
+           the rounding */
+        if(i % 5 == 0) src[i] = (Math::floor(src[i]*bitMax) + 0.5f)/bitMax;
+    }
+
+    T packed[1001*4]{};
+    Float unpacked[1001*4]{};
+    packInto(Corrade::Containers::StridedArrayView2D<const Float>{src, {1001, 3}, {4*sizeof(Float), sizeof(Float)}},
+             Corrade::Containers::StridedArrayView2D<T>{packed, {1001, 3}, {4*sizeof(T), sizeof(T)}});
+    unpackInto(Corrade::Containers::StridedArrayView2D<const T>{packed, {1001, 3}, {4*sizeof(T), sizeof(T)}},
+               Corrade::Containers::StridedArrayView2D<Float>{unpacked, {1001, 3}, {4*sizeof(Float), sizeof(Float)}});
+
+    /* Ensure the results are consistent with non-batch APIs and that the
+       fourth component wasn't touched */
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(src); ++i) {
+        CORRADE_ITERATION(i);
+        if(i % 4 == 3) {
+            CORRADE_COMPARE(packed[i], T{});
+            CORRADE_COMPARE(unpacked[i], 0.0f);
+        } else {
+            CORRADE_COMPARE(packed[i], Math::pack<T>(src[i]));
+            CORRADE_COMPARE(unpacked[i], Math::unpack<Float>(packed[i]));
+        }
+    }
+}
+
 void PackingBatchTest::unpackHalf() {
     /* Test data adapted from HalfTest */
     struct Data {
@@ -445,6 +529,67 @@ void PackingBatchTest::packHalf() {
         CORRADE_COMPARE(Math::packHalf(data[i].src), data[i].dst);
 }
 
+void PackingBatchTest::packUnpackHalfContiguous() {
+    /* Values exactly representable as halves, so the result is the same
+       independently of whether a hardware conversion with rounding or the
+       table-based fallback with truncation is used. 13 three-component items,
+       i.e. 39 values in total, so most of the data goes through the
+       vectorized code paths and the rest through the scalar loop. */
+    Float src[39];
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(src); ++i)
+        src[i] = Float(i)*0.75f - 12.0f;
+    /* Smallest normal and denormal value, infinities */
+    src[3] = 6.103515625e-05f;
+    src[4] = 5.9604644775390625e-08f;
+    src[5] = Constants::inf();
+    src[6] = -Constants::inf();
+
+    UnsignedShort packed[39];
+    Float unpacked[39];
+    packHalfInto(Corrade::Containers::StridedArrayView2D<const Float>{src, {13, 3}},
+                 Corrade::Containers::StridedArrayView2D<UnsignedShort>{packed, {13, 3}});
+    unpackHalfInto(Corrade::Containers::StridedArrayView2D<const UnsignedShort>{packed, {13, 3}},
+                   Corrade::Containers::StridedArrayView2D<Float>{unpacked, {13, 3}});
+
+    /* Ensure the results are consistent with non-batch APIs, and that the
+       round trip is lossless */
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(src); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(packed[i], Math::packHalf(src[i]));
+        CORRADE_COMPARE(unpacked[i], src[i]);
+    }
+}
+
+void PackingBatchTest::packUnpackHalfInterleaved() {
+    /* Three components out of four, like a vertex attribute interleaved with
+       others. Has enough rows to span several gathered tiles and the
+       vectorized kernels. Values exactly representable as halves to make
+       the round trip lossless. */
+    Float src[1001*4]{};
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(src); ++i)
+        src[i] = Float(Int(i % 257) - 128)*0.25f;
+
+    UnsignedShort packed[1001*4]{};
+    Float unpacked[1001*4]{};
+    packHalfInto(Corrade::Containers::StridedArrayView2D<const Float>{src, {1001, 3}, {4*sizeof(Float), sizeof(Float)}},
+                 Corrade::Containers::StridedArrayView2D<UnsignedShort>{packed, {1001, 3}, {4*sizeof(UnsignedShort), sizeof(UnsignedShort)}});
+    unpackHalfInto(Corrade::Containers::StridedArrayView2D<const UnsignedShort>{packed, {1001, 3}, {4*sizeof(UnsignedShort), sizeof(UnsignedShort)}},
+                   Corrade::Containers::StridedArrayView2D<Float>{unpacked, {1001, 3}, {4*sizeof(Float), sizeof(Float)}});
+
+    /* Ensure the results are consistent with non-batch APIs and that the
+       fourth component wasn't touched */
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(src); ++i) {
+        CORRADE_ITERATION(i);
+        if(i % 4 == 3) {
+            CORRADE_COMPARE(packed[i], 0);
+            CORRADE_COMPARE(unpacked[i], 0.0f);
+        } else {
+            CORRADE_COMPARE(packed[i], Math::packHalf(src[i]));
+            CORRADE_COMPARE(unpacked[i], src[i]);
+        }
+    }
+}
+
 template<class FloatingPoint, class Integral> void PackingBatchTest::castUnsignedFloatingPoint() {
     setTestCaseTemplateName({TypeTraits<FloatingPoint>::name(), TypeTraits<Integral>::name()});
 
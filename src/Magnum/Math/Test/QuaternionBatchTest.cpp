@@ -0,0 +1,418 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/DualQuaternion.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/QuaternionBatch.h"
+
+namespace Magnum { namespace Math { namespace Test { namespace {
+
+struct QuaternionBatchTest: Corrade::TestSuite::Tester {
+    explicit QuaternionBatchTest();
+
+    void interpolate();
+    void interpolateBroadcastedPhase();
+    void blend();
+    void transformationMatrixDualQuaternion();
+    void transformationMatrixTranslationRotationScaling();
+    void empty();
+
+    void assertions();
+
+    void benchmarkSlerpShortestPathNaive();
+    void benchmarkSlerpShortestPath();
+    void benchmarkTransformationMatrixNaive();
+    void benchmarkTransformationMatrix();
+};
+
+typedef Math::Deg<Float> Deg;
+typedef Math::Vector3<Float> Vector3;
+typedef Math::Matrix4<Float> Matrix4;
+typedef Math::Quaternion<Float> Quaternion;
+typedef Math::DualQuaternion<Float> DualQuaternion;
+
+const struct {
+    const char* name;
+    void(*batch)(const Corrade::Containers::StridedArrayView1D<const Quaternion>&, const Corrade::Containers::StridedArrayView1D<const Quaternion>&, const Corrade::Containers::StridedArrayView1D<const Float>&, const Corrade::Containers::StridedArrayView1D<Quaternion>&);
+    Quaternion(*scalar)(const Quaternion&, const Quaternion&, Float);
+} InterpolateData[]{
+    {"lerp", lerpInto, Math::lerp<Float>},
+    {"lerp shortest path", lerpShortestPathInto, Math::lerpShortestPath<Float>},
+    {"slerp", slerpInto, Math::slerp<Float>},
+    {"slerp shortest path", slerpShortestPathInto, Math::slerpShortestPath<Float>},
+};
+
+constexpr std::size_t BenchmarkSize = 10000;
+
+QuaternionBatchTest::QuaternionBatchTest() {
+    addInstancedTests({&QuaternionBatchTest::interpolate,
+                       &QuaternionBatchTest::interpolateBroadcastedPhase},
+        Corrade::Containers::arraySize(InterpolateData));
+
+    addTests({&QuaternionBatchTest::blend,
+              &QuaternionBatchTest::transformationMatrixDualQuaternion,
+              &QuaternionBatchTest::transformationMatrixTranslationRotationScaling,
+              &QuaternionBatchTest::empty,
+
+              &QuaternionBatchTest::assertions});
+
+    addBenchmarks({&QuaternionBatchTest::benchmarkSlerpShortestPathNaive,
+                   &QuaternionBatchTest::benchmarkSlerpShortestPath,
+                   &QuaternionBatchTest::benchmarkTransformationMatrixNaive,
+                   &QuaternionBatchTest::benchmarkTransformationMatrix}, 10);
+}
+
+void QuaternionBatchTest::interpolate() {
+    auto&& data = InterpolateData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Interleaved with other data to test non-trivial strides. Six items, so
+       there's one full chunk and one partial. */
+    struct Item {
+        Quaternion a;
+        Float t;
+        Quaternion b;
+        Quaternion out;
+    } items[]{
+        {Quaternion::rotation(Deg(35.0f), Vector3::xAxis()), 0.25f,
+         Quaternion::rotation(Deg(-120.0f), Vector3::yAxis()), {}},
+        /* Opposite hemispheres */
+        {Quaternion::rotation(Deg(90.0f), Vector3{1.0f, 1.0f, 0.0f}.normalized()), 0.5f,
+         -Quaternion::rotation(Deg(15.0f), Vector3::zAxis()), {}},
+        /* Same quaternions, going through the linear fallback in slerp */
+        {Quaternion{}, 0.75f, Quaternion{}, {}},
+        /* Quaternions that are negations of each other, also going through
+           the linear fallback. Not using t = 0.5 as the non-shortest-path
+           lerp would result in a zero quaternion. */
+        {Quaternion{}, 0.0f, -Quaternion{}, {}},
+        {Quaternion::rotation(Deg(170.0f), Vector3::zAxis()), 1.0f,
+         Quaternion::rotation(Deg(-170.0f), Vector3::zAxis()), {}},
+        {Quaternion::rotation(Deg(45.0f), Vector3{1.0f, -2.0f, 0.5f}.normalized()), 0.35f,
+         Quaternion::rotation(Deg(-30.0f), Vector3{0.0f, 1.0f, 1.0f}.normalized()), {}},
+    };
+
+    Corrade::Containers::StridedArrayView1D<Item> view = items;
+    data.batch(
+        view.slice(&Item::a),
+        view.slice(&Item::b),
+        view.slice(&Item::t),
+        view.slice(&Item::out));
+
+    /* Ensure the results are consistent with non-batch APIs */
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(items); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(items[i].out, data.scalar(items[i].a, items[i].b, items[i].t));
+    }
+}
+
+void QuaternionBatchTest::interpolateBroadcastedPhase() {
+    auto&& data = InterpolateData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const Quaternion a[]{
+        Quaternion::rotation(Deg(35.0f), Vector3::xAxis()),
+        Quaternion::rotation(Deg(90.0f), Vector3{1.0f, 1.0f, 0.0f}.normalized()),
+        Quaternion{},
+        Quaternion::rotation(Deg(170.0f), Vector3::zAxis()),
+        Quaternion::rotation(Deg(45.0f), Vector3{1.0f, -2.0f, 0.5f}.normalized())
+    };
+    const Quaternion b[]{
+        Quaternion::rotation(Deg(-120.0f), Vector3::yAxis()),
+        -Quaternion::rotation(Deg(15.0f), Vector3::zAxis()),
+        Quaternion::rotation(Deg(5.0f), Vector3::yAxis()),
+        Quaternion::rotation(Deg(-170.0f), Vector3::zAxis()),
+        Quaternion::rotation(Deg(-30.0f), Vector3{0.0f, 1.0f, 1.0f}.normalized())
+    };
+    const Float t = 0.35f;
+
+    Quaternion out[5];
+    data.batch(a, b,
+        Corrade::Containers::stridedArrayView(&t, 1).broadcasted<0>(5),
+        out);
+
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(out); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(out[i], data.scalar(a[i], b[i], t));
+    }
+}
+
+void QuaternionBatchTest::blend() {
+    const DualQuaternion joints[]{
+        DualQuaternion::translation({1.0f, 2.0f, 3.0f})*
+            DualQuaternion::rotation(Deg(35.0f), Vector3::xAxis()),
+        DualQuaternion::rotation(Deg(-90.0f), Vector3::yAxis()),
+        /* In the opposite hemisphere than the first joint */
+        -(DualQuaternion::translation({-1.0f, 0.0f, 0.5f})*
+          DualQuaternion::rotation(Deg(60.0f), Vector3::zAxis()))
+    };
+
+    /* Five items, so there's one full chunk and one partial */
+    const UnsignedInt ids[]{
+        0, 1,
+        1, 2,
+        2, 0,
+        0, 2,
+        1, 1
+    };
+    const Float weights[]{
+        0.5f, 0.5f,
+        0.25f, 0.75f,
+        1.0f, 0.0f,
+        0.5f, 0.5f,
+        0.3f, 0.7f
+    };
+
+    DualQuaternion out[5];
+    blendInto(joints,
+        Corrade::Containers::StridedArrayView2D<const UnsignedInt>{ids, {5, 2}},
+        Corrade::Containers::StridedArrayView2D<const Float>{weights, {5, 2}},
+        out);
+
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(out); ++i) {
+        CORRADE_ITERATION(i);
+
+        /* Calculate the expected value from the documented formula */
+        const Quaternion& first = joints[ids[i*2]].real();
+        Quaternion real{ZeroInit}, dual{ZeroInit};
+        for(std::size_t j = 0; j != 2; ++j) {
+            const DualQuaternion& joint = joints[ids[i*2 + j]];
+            const Float weight = dot(first, joint.real()) < 0.0f ? -weights[i*2 + j] : weights[i*2 + j];
+            real += joint.real()*weight;
+            dual += joint.dual()*weight;
+        }
+
+        CORRADE_COMPARE(out[i], (DualQuaternion{real, dual}.normalized()));
+        CORRADE_VERIFY(out[i].isNormalized());
+    }
+
+    /* A joint with a full weight is passed through, including the sign */
+    CORRADE_COMPARE(out[2], joints[2]);
+}
+
+void QuaternionBatchTest::transformationMatrixDualQuaternion() {
+    /* Interleaved with other data to test non-trivial strides */
+    struct Item {
+        DualQuaternion src;
+        Float padding;
+        Matrix4 dst;
+    } items[]{
+        {DualQuaternion{}, 1.0f, {}},
+        {DualQuaternion::translation({1.0f, 2.0f, 3.0f})*
+         DualQuaternion::rotation(Deg(35.0f), Vector3::xAxis()), 1.0f, {}},
+        {DualQuaternion::rotation(Deg(-90.0f), Vector3::yAxis()), 1.0f, {}},
+        {DualQuaternion::translation({-1.0f, 0.0f, 0.5f}), 1.0f, {}},
+        {DualQuaternion::rotation(Deg(60.0f), Vector3{1.0f, -2.0f, 0.5f}.normalized())*
+         DualQuaternion::translation({0.0f, 3.0f, -7.5f}), 1.0f, {}}
+    };
+
+    Corrade::Containers::StridedArrayView1D<Item> view = items;
+    transformationMatrixInto(view.slice(&Item::src), view.slice(&Item::dst));
+
+    for(const Item& i: items) {
+        CORRADE_ITERATION(i.src);
+        CORRADE_COMPARE(i.dst, i.src.toMatrix());
+        /* The padding shouldn't get overwritten */
+        CORRADE_COMPARE(i.padding, 1.0f);
+    }
+}
+
+void QuaternionBatchTest::transformationMatrixTranslationRotationScaling() {
+    const Vector3 translations[]{
+        {},
+        {1.0f, 2.0f, 3.0f},
+        {-1.0f, 0.0f, 0.5f},
+        {0.0f, 3.0f, -7.5f},
+        {100.0f, -35.0f, 12.5f}
+    };
+    const Quaternion rotations[]{
+        {},
+        Quaternion::rotation(Deg(35.0f), Vector3::xAxis()),
+        Quaternion::rotation(Deg(-90.0f), Vector3::yAxis()),
+        Quaternion::rotation(Deg(60.0f), Vector3{1.0f, -2.0f, 0.5f}.normalized()),
+        {}
+    };
+    const Vector3 scalings[]{
+        Vector3{1.0f},
+        {2.0f, 0.5f, -1.5f},
+        Vector3{1.0f},
+        {0.25f, 4.0f, 1.0f},
+        {-1.0f, 1.0f, 3.0f}
+    };
+
+    Matrix4 out[5];
+    transformationMatrixInto(translations, rotations, scalings, out);
+
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(out); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(out[i],
+            Matrix4::from(rotations[i].toMatrix(), translations[i])*
+            Matrix4::scaling(scalings[i]));
+    }
+}
+
+void QuaternionBatchTest::empty() {
+    /* Shouldn't crash or do anything */
+    slerpInto(
+        Corrade::Containers::StridedArrayView1D<const Quaternion>{},
+        Corrade::Containers::StridedArrayView1D<const Quaternion>{},
+        Corrade::Containers::StridedArrayView1D<const Float>{},
+        Corrade::Containers::StridedArrayView1D<Quaternion>{});
+    blendInto(
+        Corrade::Containers::StridedArrayView1D<const DualQuaternion>{},
+        Corrade::Containers::StridedArrayView2D<const UnsignedInt>{},
+        Corrade::Containers::StridedArrayView2D<const Float>{},
+        Corrade::Containers::StridedArrayView1D<DualQuaternion>{});
+    transformationMatrixInto(
+        Corrade::Containers::StridedArrayView1D<const DualQuaternion>{},
+        Corrade::Containers::StridedArrayView1D<Matrix4>{});
+    CORRADE_VERIFY(true);
+}
+
+void QuaternionBatchTest::assertions() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const Quaternion quaternions2[2];
+    const Quaternion quaternions3[3];
+    const Float t2[2]{};
+    Quaternion out2[2];
+    const DualQuaternion joints[3];
+    const UnsignedInt ids[]{0, 1, 5};
+    const Float weights[3]{};
+    DualQuaternion blended2[2];
+    DualQuaternion blended3[3];
+    const Vector3 vectors2[2];
+    Matrix4 matrices2[2];
+    Matrix4 matrices3[3];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    lerpInto(quaternions2, quaternions3, t2, out2);
+    lerpShortestPathInto(quaternions2, quaternions3, t2, out2);
+    slerpInto(quaternions2, quaternions3, t2, out2);
+    slerpShortestPathInto(quaternions2, quaternions3, t2, out2);
+    blendInto(joints,
+        Corrade::Containers::StridedArrayView2D<const UnsignedInt>{ids, {3, 1}},
+        Corrade::Containers::StridedArrayView2D<const Float>{weights, {1, 3}},
+        blended3);
+    blendInto(joints,
+        Corrade::Containers::StridedArrayView2D<const UnsignedInt>{ids, {3, 1}},
+        Corrade::Containers::StridedArrayView2D<const Float>{weights, {3, 1}},
+        blended2);
+    blendInto(joints,
+        Corrade::Containers::StridedArrayView2D<const UnsignedInt>{ids, {3, 1}},
+        Corrade::Containers::StridedArrayView2D<const Float>{weights, {3, 1}},
+        blended3);
+    transformationMatrixInto(joints, matrices2);
+    transformationMatrixInto(vectors2, quaternions3, vectors2, matrices2);
+    transformationMatrixInto(vectors2, quaternions2, vectors2, matrices3);
+    CORRADE_COMPARE(out.str(),
+        "Math::lerpInto(): expected 2 second quaternions, interpolation phases and output items but got 3, 2 and 2\n"
+        "Math::lerpShortestPathInto(): expected 2 second quaternions, interpolation phases and output items but got 3, 2 and 2\n"
+        "Math::slerpInto(): expected 2 second quaternions, interpolation phases and output items but got 3, 2 and 2\n"
+        "Math::slerpShortestPathInto(): expected 2 second quaternions, interpolation phases and output items but got 3, 2 and 2\n"
+        "Math::blendInto(): expected joint ID and weight views to have the same size but got {3, 1} and {1, 3}\n"
+        "Math::blendInto(): expected 3 output items but got 2\n"
+        "Math::blendInto(): joint ID 5 out of range for 3 transformations\n"
+        "Math::transformationMatrixInto(): wrong destination size, got 2 but expected 3\n"
+        "Math::transformationMatrixInto(): expected 2 rotations, scalings and output items but got 3, 2 and 2\n"
+        "Math::transformationMatrixInto(): expected 2 rotations, scalings and output items but got 2, 2 and 3\n");
+}
+
+void QuaternionBatchTest::benchmarkSlerpShortestPathNaive() {
+    Corrade::Containers::Array<Quaternion> a{Corrade::NoInit, BenchmarkSize};
+    Corrade::Containers::Array<Quaternion> b{Corrade::NoInit, BenchmarkSize};
+    Corrade::Containers::Array<Quaternion> out{Corrade::NoInit, BenchmarkSize};
+    for(std::size_t i = 0; i != BenchmarkSize; ++i) {
+        a[i] = Quaternion::rotation(Deg(Float(i%360)), Vector3::xAxis());
+        b[i] = Quaternion::rotation(Deg(Float(i%180)), Vector3::yAxis());
+    }
+
+    CORRADE_BENCHMARK(10)
+        for(std::size_t i = 0; i != BenchmarkSize; ++i)
+            out[i] = Math::slerpShortestPath(a[i], b[i], 0.35f);
+
+    CORRADE_VERIFY(out[1].isNormalized());
+}
+
+void QuaternionBatchTest::benchmarkSlerpShortestPath() {
+    Corrade::Containers::Array<Quaternion> a{Corrade::NoInit, BenchmarkSize};
+    Corrade::Containers::Array<Quaternion> b{Corrade::NoInit, BenchmarkSize};
+    Corrade::Containers::Array<Quaternion> out{Corrade::NoInit, BenchmarkSize};
+    for(std::size_t i = 0; i != BenchmarkSize; ++i) {
+        a[i] = Quaternion::rotation(Deg(Float(i%360)), Vector3::xAxis());
+        b[i] = Quaternion::rotation(Deg(Float(i%180)), Vector3::yAxis());
+    }
+
+    const Float t = 0.35f;
+    CORRADE_BENCHMARK(10)
+        slerpShortestPathInto(a, b, Corrade::Containers::stridedArrayView(&t, 1).broadcasted<0>(BenchmarkSize), out);
+
+    CORRADE_VERIFY(out[1].isNormalized());
+}
+
+void QuaternionBatchTest::benchmarkTransformationMatrixNaive() {
+    Corrade::Containers::Array<Vector3> translations{Corrade::NoInit, BenchmarkSize};
+    Corrade::Containers::Array<Quaternion> rotations{Corrade::NoInit, BenchmarkSize};
+    Corrade::Containers::Array<Vector3> scalings{Corrade::NoInit, BenchmarkSize};
+    Corrade::Containers::Array<Matrix4> out{Corrade::NoInit, BenchmarkSize};
+    for(std::size_t i = 0; i != BenchmarkSize; ++i) {
+        translations[i] = Vector3{Float(i), Float(i%7), -Float(i%13)};
+        rotations[i] = Quaternion::rotation(Deg(Float(i%360)), Vector3::xAxis());
+        scalings[i] = Vector3{1.0f + Float(i%3)};
+    }
+
+    CORRADE_BENCHMARK(10)
+        for(std::size_t i = 0; i != BenchmarkSize; ++i)
+            out[i] = Matrix4::from(rotations[i].toMatrix(), translations[i])*Matrix4::scaling(scalings[i]);
+
+    CORRADE_COMPARE(out[1].translation(), (Vector3{1.0f, 1.0f, -1.0f}));
+}
+
+void QuaternionBatchTest::benchmarkTransformationMatrix() {
+    Corrade::Containers::Array<Vector3> translations{Corrade::NoInit, BenchmarkSize};
+    Corrade::Containers::Array<Quaternion> rotations{Corrade::NoInit, BenchmarkSize};
+    Corrade::Containers::Array<Vector3> scalings{Corrade::NoInit, BenchmarkSize};
+    Corrade::Containers::Array<Matrix4> out{Corrade::NoInit, BenchmarkSize};
+    for(std::size_t i = 0; i != BenchmarkSize; ++i) {
+        translations[i] = Vector3{Float(i), Float(i%7), -Float(i%13)};
+        rotations[i] = Quaternion::rotation(Deg(Float(i%360)), Vector3::xAxis());
+        scalings[i] = Vector3{1.0f + Float(i%3)};
+    }
+
+    CORRADE_BENCHMARK(10)
+        transformationMatrixInto(translations, rotations, scalings, out);
+
+    CORRADE_COMPARE(out[1].translation(), (Vector3{1.0f, 1.0f, -1.0f}));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::QuaternionBatchTest)
@@ -0,0 +1,442 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/TransformBatch.h"
+
+namespace Magnum { namespace Math { namespace Test { namespace {
+
+struct TransformBatchTest: Corrade::TestSuite::Tester {
+    explicit TransformBatchTest();
+
+    void points3D();
+    void points3DProjective();
+    void points3DInPlace();
+    void pointsHomogeneous();
+    void points2D();
+    void vectors3D();
+    void vectors3DMatrix3x3();
+    void vectors2D();
+    void normalMatrices();
+    void invertedRigid();
+    void invertedRigidInPlace();
+    void inverted();
+    void invertedInPlace();
+    void empty();
+
+    void assertions();
+
+    void benchmarkPoints3DNaive();
+    void benchmarkPoints3D();
+};
+
+typedef Math::Deg<Float> Deg;
+typedef Math::Vector2<Float> Vector2;
+typedef Math::Vector3<Float> Vector3;
+typedef Math::Vector4<Float> Vector4;
+typedef Math::Matrix3<Float> Matrix3;
+typedef Math::Matrix3x3<Float> Matrix3x3;
+typedef Math::Matrix4<Float> Matrix4;
+
+const Matrix4 Transformation3D =
+    Matrix4::translation({1.0f, -2.0f, 3.5f})*
+    Matrix4::rotation(Deg(35.0f), Vector3{1.0f, 2.0f, -0.5f}.normalized())*
+    Matrix4::scaling({2.0f, 0.5f, -1.5f});
+
+const Matrix3 Transformation2D =
+    Matrix3::translation({1.0f, -2.0f})*
+    Matrix3::rotation(Deg(35.0f))*
+    Matrix3::scaling({2.0f, -1.5f});
+
+constexpr std::size_t BenchmarkSize = 100000;
+
+TransformBatchTest::TransformBatchTest() {
+    addTests({&TransformBatchTest::points3D,
+              &TransformBatchTest::points3DProjective,
+              &TransformBatchTest::points3DInPlace,
+              &TransformBatchTest::pointsHomogeneous,
+              &TransformBatchTest::points2D,
+              &TransformBatchTest::vectors3D,
+              &TransformBatchTest::vectors3DMatrix3x3,
+              &TransformBatchTest::vectors2D,
+              &TransformBatchTest::normalMatrices,
+              &TransformBatchTest::invertedRigid,
+              &TransformBatchTest::invertedRigidInPlace,
+              &TransformBatchTest::inverted,
+              &TransformBatchTest::invertedInPlace,
+              &TransformBatchTest::empty,
+
+              &TransformBatchTest::assertions});
+
+    addBenchmarks({&TransformBatchTest::benchmarkPoints3DNaive,
+                   &TransformBatchTest::benchmarkPoints3D}, 10);
+}
+
+void TransformBatchTest::points3D() {
+    /* Interleaved with other data to test non-trivial strides */
+    struct Data {
+        Vector3 src;
+        Float padding;
+        Vector3 dst;
+    } data[]{
+        {{0.0f, 0.0f, 0.0f}, 1.0f, {}},
+        {{1.0f, 2.0f, 3.0f}, 1.0f, {}},
+        {{-0.5f, 7.0f, 0.25f}, 1.0f, {}},
+        {{100.0f, -35.0f, 12.5f}, 1.0f, {}},
+        {{0.0f, 0.0f, -1.0f}, 1.0f, {}}
+    };
+
+    Corrade::Containers::StridedArrayView1D<const Vector3> src{data, &data[0].src, Corrade::Containers::arraySize(data), sizeof(Data)};
+    Corrade::Containers::StridedArrayView1D<Vector3> dst{data, &data[0].dst, Corrade::Containers::arraySize(data), sizeof(Data)};
+    transformPointsInto(Transformation3D, src, dst);
+
+    /* Ensure the results are consistent with non-batch APIs */
+    for(const Data& i: data) {
+        CORRADE_ITERATION(i.src);
+        CORRADE_COMPARE(i.dst, Transformation3D.transformPoint(i.src));
+        /* The padding shouldn't get overwritten */
+        CORRADE_COMPARE(i.padding, 1.0f);
+    }
+}
+
+void TransformBatchTest::points3DProjective() {
+    /* The result should be divided by W like in Matrix4::transformPoint() */
+    const Matrix4 projection = Matrix4::perspectiveProjection(Deg(60.0f), 4.0f/3.0f, 0.1f, 100.0f)*Transformation3D;
+
+    const Vector3 src[]{
+        {1.0f, 2.0f, -3.0f},
+        {-0.5f, 7.0f, -25.0f},
+        {0.0f, 0.0f, -1.0f}
+    };
+    Vector3 dst[3];
+    transformPointsInto(projection, src, dst);
+
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(src); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(dst[i], projection.transformPoint(src[i]));
+    }
+}
+
+void TransformBatchTest::points3DInPlace() {
+    Vector3 data[]{
+        {1.0f, 2.0f, 3.0f},
+        {-0.5f, 7.0f, 0.25f},
+        {100.0f, -35.0f, 12.5f}
+    };
+    const Vector3 expected[]{
+        Transformation3D.transformPoint(data[0]),
+        Transformation3D.transformPoint(data[1]),
+        Transformation3D.transformPoint(data[2])
+    };
+
+    transformPointsInto(Transformation3D, data, data);
+    CORRADE_COMPARE_AS(Corrade::Containers::arrayView(data),
+        Corrade::Containers::arrayView(expected),
+        Corrade::TestSuite::Compare::Container);
+}
+
+void TransformBatchTest::pointsHomogeneous() {
+    const Vector4 src[]{
+        {1.0f, 2.0f, 3.0f, 1.0f},
+        {-0.5f, 7.0f, 0.25f, 0.0f},
+        {100.0f, -35.0f, 12.5f, -2.5f}
+    };
+    Vector4 dst[3];
+    transformPointsInto(Transformation3D, src, dst);
+
+    /* W isn't assumed to be 1 and there's no division */
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(src); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(dst[i], Transformation3D*src[i]);
+    }
+}
+
+void TransformBatchTest::points2D() {
+    struct Data {
+        Vector2 src;
+        Vector2 dst;
+        Float padding;
+    } data[]{
+        {{0.0f, 0.0f}, {}, 1.0f},
+        {{1.0f, 2.0f}, {}, 1.0f},
+        {{-0.5f, 7.0f}, {}, 1.0f},
+        {{100.0f, -35.0f}, {}, 1.0f}
+    };
+
+    Corrade::Containers::StridedArrayView1D<const Vector2> src{data, &data[0].src, Corrade::Containers::arraySize(data), sizeof(Data)};
+    Corrade::Containers::StridedArrayView1D<Vector2> dst{data, &data[0].dst, Corrade::Containers::arraySize(data), sizeof(Data)};
+    transformPointsInto(Transformation2D, src, dst);
+
+    for(const Data& i: data) {
+        CORRADE_ITERATION(i.src);
+        CORRADE_COMPARE(i.dst, Transformation2D.transformPoint(i.src));
+        CORRADE_COMPARE(i.padding, 1.0f);
+    }
+}
+
+void TransformBatchTest::vectors3D() {
+    struct Data {
+        Vector3 src;
+        Float padding;
+        Vector3 dst;
+    } data[]{
+        {{0.0f, 0.0f, 0.0f}, 1.0f, {}},
+        {{1.0f, 2.0f, 3.0f}, 1.0f, {}},
+        {{-0.5f, 7.0f, 0.25f}, 1.0f, {}},
+        {{100.0f, -35.0f, 12.5f}, 1.0f, {}}
+    };
+
+    Corrade::Containers::StridedArrayView1D<const Vector3> src{data, &data[0].src, Corrade::Containers::arraySize(data), sizeof(Data)};
+    Corrade::Containers::StridedArrayView1D<Vector3> dst{data, &data[0].dst, Corrade::Containers::arraySize(data), sizeof(Data)};
+    transformVectorsInto(Transformation3D, src, dst);
+
+    /* The translation shouldn't be applied */
+    for(const Data& i: data) {
+        CORRADE_ITERATION(i.src);
+        CORRADE_COMPARE(i.dst, Transformation3D.transformVector(i.src));
+        CORRADE_COMPARE(i.padding, 1.0f);
+    }
+}
+
+void TransformBatchTest::vectors3DMatrix3x3() {
+    const Matrix3x3 normalMatrix = Transformation3D.normalMatrix();
+
+    Vector3 data[]{
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 0.6f, 0.8f},
+        {-0.5f, 7.0f, 0.25f}
+    };
+    const Vector3 expected[]{
+        normalMatrix*data[0],
+        normalMatrix*data[1],
+        normalMatrix*data[2]
+    };
+
+    /* Testing in-place here */
+    transformVectorsInto(normalMatrix, data, data);
+    CORRADE_COMPARE_AS(Corrade::Containers::arrayView(data),
+        Corrade::Containers::arrayView(expected),
+        Corrade::TestSuite::Compare::Container);
+}
+
+void TransformBatchTest::vectors2D() {
+    const Vector2 src[]{
+        {0.0f, 0.0f},
+        {1.0f, 2.0f},
+        {-0.5f, 7.0f},
+        {100.0f, -35.0f}
+    };
+    Vector2 dst[4];
+    transformVectorsInto(Transformation2D, src, dst);
+
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(src); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(dst[i], Transformation2D.transformVector(src[i]));
+    }
+}
+
+void TransformBatchTest::normalMatrices() {
+    /* Interleaved with other data to test non-trivial strides */
+    struct Data {
+        Matrix4 src;
+        Matrix3x3 dst;
+        Float padding;
+    } data[]{
+        {Transformation3D, {}, 1.0f},
+        {Matrix4{}, {}, 1.0f},
+        {Matrix4::rotationX(Deg(-75.0f))*Matrix4::scaling({1.0f, 3.0f, 0.25f}), {}, 1.0f},
+        {Matrix4::perspectiveProjection(Deg(60.0f), 4.0f/3.0f, 0.1f, 100.0f), {}, 1.0f}
+    };
+
+    Corrade::Containers::StridedArrayView1D<const Matrix4> src{data, &data[0].src, Corrade::Containers::arraySize(data), sizeof(Data)};
+    Corrade::Containers::StridedArrayView1D<Matrix3x3> dst{data, &data[0].dst, Corrade::Containers::arraySize(data), sizeof(Data)};
+    normalMatricesInto(src, dst);
+
+    /* Ensure the results are consistent with non-batch APIs */
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(data); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(data[i].dst, data[i].src.normalMatrix());
+        /* The padding shouldn't get overwritten */
+        CORRADE_COMPARE(data[i].padding, 1.0f);
+    }
+}
+
+void TransformBatchTest::invertedRigid() {
+    /* Interleaved with other data to test non-trivial strides */
+    struct Data {
+        Matrix4 src;
+        Float padding;
+        Matrix4 dst;
+    } data[]{
+        {Matrix4::translation({1.0f, -2.0f, 3.5f})*Matrix4::rotation(Deg(35.0f), Vector3{1.0f, 2.0f, -0.5f}.normalized()), 1.0f, {}},
+        {Matrix4{}, 1.0f, {}},
+        {Matrix4::rotationZ(Deg(120.0f))*Matrix4::translation({-7.0f, 0.5f, 0.0f}), 1.0f, {}}
+    };
+
+    Corrade::Containers::StridedArrayView1D<const Matrix4> src{data, &data[0].src, Corrade::Containers::arraySize(data), sizeof(Data)};
+    Corrade::Containers::StridedArrayView1D<Matrix4> dst{data, &data[0].dst, Corrade::Containers::arraySize(data), sizeof(Data)};
+    invertedRigidInto(src, dst);
+
+    /* Ensure the results are consistent with non-batch APIs */
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(data); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(data[i].dst, data[i].src.invertedRigid());
+        /* The padding shouldn't get overwritten */
+        CORRADE_COMPARE(data[i].padding, 1.0f);
+    }
+}
+
+void TransformBatchTest::invertedRigidInPlace() {
+    const Matrix4 a = Matrix4::translation({1.0f, -2.0f, 3.5f})*Matrix4::rotation(Deg(35.0f), Vector3{1.0f, 2.0f, -0.5f}.normalized());
+    const Matrix4 b = Matrix4::rotationZ(Deg(120.0f))*Matrix4::translation({-7.0f, 0.5f, 0.0f});
+
+    Matrix4 data[]{a, b};
+    invertedRigidInto(data, data);
+    CORRADE_COMPARE(data[0], a.invertedRigid());
+    CORRADE_COMPARE(data[1], b.invertedRigid());
+}
+
+void TransformBatchTest::inverted() {
+    /* Interleaved with other data to test non-trivial strides */
+    struct Data {
+        Matrix4 src;
+        Float padding;
+        Matrix4 dst;
+    } data[]{
+        {Transformation3D, 1.0f, {}},
+        {Matrix4{}, 1.0f, {}},
+        {Matrix4::perspectiveProjection(Deg(60.0f), 4.0f/3.0f, 0.1f, 100.0f), 1.0f, {}},
+        {Matrix4{Vector4{3.0f, 1.0f, 4.0f, 1.0f},
+                 Vector4{5.0f, 9.0f, 2.0f, 6.0f},
+                 Vector4{5.0f, 3.0f, 5.0f, 8.0f},
+                 Vector4{9.0f, 7.0f, 9.0f, 3.0f}}, 1.0f, {}}
+    };
+
+    Corrade::Containers::StridedArrayView1D<const Matrix4> src{data, &data[0].src, Corrade::Containers::arraySize(data), sizeof(Data)};
+    Corrade::Containers::StridedArrayView1D<Matrix4> dst{data, &data[0].dst, Corrade::Containers::arraySize(data), sizeof(Data)};
+    invertedInto(src, dst);
+
+    /* Ensure the results are consistent with non-batch APIs */
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(data); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(data[i].dst, data[i].src.inverted());
+        /* The padding shouldn't get overwritten */
+        CORRADE_COMPARE(data[i].padding, 1.0f);
+    }
+}
+
+void TransformBatchTest::invertedInPlace() {
+    const Matrix4 projection = Matrix4::perspectiveProjection(Deg(60.0f), 4.0f/3.0f, 0.1f, 100.0f);
+
+    Matrix4 data[]{Transformation3D, projection};
+    invertedInto(data, data);
+    CORRADE_COMPARE(data[0], Transformation3D.inverted());
+    CORRADE_COMPARE(data[1], projection.inverted());
+}
+
+void TransformBatchTest::empty() {
+    /* Shouldn't crash or do anything */
+    transformPointsInto(Transformation3D,
+        Corrade::Containers::StridedArrayView1D<const Vector3>{},
+        Corrade::Containers::StridedArrayView1D<Vector3>{});
+    transformVectorsInto(Transformation2D,
+        Corrade::Containers::StridedArrayView1D<const Vector2>{},
+        Corrade::Containers::StridedArrayView1D<Vector2>{});
+    invertedInto(
+        Corrade::Containers::StridedArrayView1D<const Matrix4>{},
+        Corrade::Containers::StridedArrayView1D<Matrix4>{});
+    CORRADE_VERIFY(true);
+}
+
+void TransformBatchTest::assertions() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Vector2 data2[2]{};
+    Vector2 result2[3]{};
+    Vector3 data3[2]{};
+    Vector3 result3[3]{};
+    Vector4 data4[2]{};
+    Vector4 result4[3]{};
+    Matrix4 matrices4[2]{};
+    Matrix4 resultMatrices4[3]{};
+    Matrix3x3 resultMatrices3x3[3]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    transformPointsInto(Transformation3D, data3, result3);
+    transformPointsInto(Transformation3D, data4, result4);
+    transformPointsInto(Transformation2D, data2, result2);
+    transformVectorsInto(Transformation3D, data3, result3);
+    transformVectorsInto(Transformation3D.normalMatrix(), data3, result3);
+    transformVectorsInto(Transformation2D, data2, result2);
+    normalMatricesInto(matrices4, resultMatrices3x3);
+    invertedRigidInto(matrices4, resultMatrices4);
+    invertedInto(matrices4, resultMatrices4);
+    CORRADE_COMPARE(out.str(),
+        "Math::transformPointsInto(): wrong destination size, got 3 but expected 2\n"
+        "Math::transformPointsInto(): wrong destination size, got 3 but expected 2\n"
+        "Math::transformPointsInto(): wrong destination size, got 3 but expected 2\n"
+        "Math::transformVectorsInto(): wrong destination size, got 3 but expected 2\n"
+        "Math::transformVectorsInto(): wrong destination size, got 3 but expected 2\n"
+        "Math::transformVectorsInto(): wrong destination size, got 3 but expected 2\n"
+        "Math::normalMatricesInto(): wrong destination size, got 3 but expected 2\n"
+        "Math::invertedRigidInto(): wrong destination size, got 3 but expected 2\n"
+        "Math::invertedInto(): wrong destination size, got 3 but expected 2\n");
+}
+
+void TransformBatchTest::benchmarkPoints3DNaive() {
+    Corrade::Containers::Array<Vector3> data{Corrade::NoInit, BenchmarkSize};
+    for(std::size_t i = 0; i != data.size(); ++i)
+        data[i] = Vector3{Float(i), Float(i%7), -Float(i%13)};
+
+    CORRADE_BENCHMARK(10)
+        for(Vector3& i: data) i = Transformation3D.transformPoint(i);
+
+    CORRADE_VERIFY(data[0] != Vector3{});
+}
+
+void TransformBatchTest::benchmarkPoints3D() {
+    Corrade::Containers::Array<Vector3> data{Corrade::NoInit, BenchmarkSize};
+    for(std::size_t i = 0; i != data.size(); ++i)
+        data[i] = Vector3{Float(i), Float(i%7), -Float(i%13)};
+
+    const Corrade::Containers::StridedArrayView1D<Vector3> view = Corrade::Containers::arrayView(data);
+    CORRADE_BENCHMARK(10)
+        transformPointsInto(Transformation3D, view, view);
+
+    CORRADE_VERIFY(data[0] != Vector3{});
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::TransformBatchTest)
@@ -0,0 +1,438 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Quaternion.h"
+#include "Magnum/Math/Wide.h"
+
+namespace Magnum { namespace Math { namespace Test { namespace {
+
+struct WideTest: Corrade::TestSuite::Tester {
+    explicit WideTest();
+
+    void construct();
+    void constructDefault();
+    void constructNoInit();
+    void constructOneValue();
+    void constructCopy();
+    void access();
+
+    void compare();
+    void compareLanes();
+    void negative();
+    void addSubtract();
+    void multiplyDivide();
+    void multiplyDivideScalar();
+    void minMaxAbsSqrt();
+    void select();
+    void sum();
+
+    void vector();
+    void matrix();
+    void quaternion();
+
+    void load();
+    void loadPartial();
+    void loadScalar();
+    void store();
+    void storePartial();
+    void storeScalar();
+    void loadStoreInvalid();
+
+    void debug();
+};
+
+typedef Math::Deg<Float> Deg;
+typedef Math::Vector3<Float> Vector3;
+typedef Math::Vector4<Float> Vector4;
+typedef Math::Matrix4<Float> Matrix4;
+typedef Math::Quaternion<Float> Quaternion;
+typedef Math::Vector3<Wide4f> WideVector3;
+typedef Math::Matrix4<Wide4f> WideMatrix4;
+
+WideTest::WideTest() {
+    addTests({&WideTest::construct,
+              &WideTest::constructDefault,
+              &WideTest::constructNoInit,
+              &WideTest::constructOneValue,
+              &WideTest::constructCopy,
+              &WideTest::access,
+
+              &WideTest::compare,
+              &WideTest::compareLanes,
+              &WideTest::negative,
+              &WideTest::addSubtract,
+              &WideTest::multiplyDivide,
+              &WideTest::multiplyDivideScalar,
+              &WideTest::minMaxAbsSqrt,
+              &WideTest::select,
+              &WideTest::sum,
+
+              &WideTest::vector,
+              &WideTest::matrix,
+              &WideTest::quaternion,
+
+              &WideTest::load,
+              &WideTest::loadPartial,
+              &WideTest::loadScalar,
+              &WideTest::store,
+              &WideTest::storePartial,
+              &WideTest::storeScalar,
+              &WideTest::loadStoreInvalid,
+
+              &WideTest::debug});
+}
+
+void WideTest::construct() {
+    constexpr Wide4f a{1.0f, -2.0f, 3.5f, 4.0f};
+    CORRADE_COMPARE(a[0], 1.0f);
+    CORRADE_COMPARE(a[1], -2.0f);
+    CORRADE_COMPARE(a[2], 3.5f);
+    CORRADE_COMPARE(a[3], 4.0f);
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<Wide4f, Float, Float, Float, Float>::value);
+}
+
+void WideTest::constructDefault() {
+    constexpr Wide4f a;
+    constexpr Wide4f b{ZeroInit};
+    CORRADE_COMPARE(a, (Wide4f{0.0f, 0.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(b, (Wide4f{0.0f, 0.0f, 0.0f, 0.0f}));
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<Wide4f>::value);
+    CORRADE_VERIFY(std::is_nothrow_constructible<Wide4f, ZeroInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<ZeroInitT, Wide4f>::value);
+}
+
+void WideTest::constructNoInit() {
+    Wide4f a{1.0f, -2.0f, 3.5f, 4.0f};
+    new(&a) Wide4f{Magnum::NoInit};
+    {
+        #if defined(__GNUC__) && __GNUC__*100 + __GNUC_MINOR__ >= 601 && __OPTIMIZE__
+        CORRADE_EXPECT_FAIL("GCC 6.1+ misoptimizes and overwrites the value.");
+        #endif
+        CORRADE_COMPARE(a, (Wide4f{1.0f, -2.0f, 3.5f, 4.0f}));
+    }
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<Wide4f, Magnum::NoInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<Magnum::NoInitT, Wide4f>::value);
+}
+
+void WideTest::constructOneValue() {
+    Wide8f a{2.5f};
+    for(std::size_t i = 0; i != 8; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(a[i], 2.5f);
+    }
+
+    /* Implicit conversion is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<Float, Wide8f>::value);
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<Wide8f, Float>::value);
+}
+
+void WideTest::constructCopy() {
+    constexpr Wide4f a{1.0f, -2.0f, 3.5f, 4.0f};
+    constexpr Wide4f b(a);
+    CORRADE_COMPARE(b, (Wide4f{1.0f, -2.0f, 3.5f, 4.0f}));
+
+    CORRADE_VERIFY(std::is_nothrow_copy_constructible<Wide4f>::value);
+    CORRADE_VERIFY(std::is_nothrow_copy_assignable<Wide4f>::value);
+}
+
+void WideTest::access() {
+    Wide4f a{1.0f, -2.0f, 3.5f, 4.0f};
+    a[2] = 7.0f;
+    CORRADE_COMPARE(a[2], 7.0f);
+    CORRADE_COMPARE(a.data()[3], 4.0f);
+
+    const Wide4f ca = a;
+    CORRADE_COMPARE(ca.data()[2], 7.0f);
+    CORRADE_COMPARE(ca[0], 1.0f);
+
+    CORRADE_COMPARE(std::size_t(Wide4f::Width), 4);
+    CORRADE_COMPARE(std::size_t(Wide8f::Width), 8);
+}
+
+void WideTest::compare() {
+    /* Fuzzy compare, all lanes have to match */
+    CORRADE_VERIFY((Wide4f{1.0f, 2.0f, 3.0f, 4.0f} == Wide4f{1.0f, 2.0f, 3.0f, 4.0f + TypeTraits<Float>::epsilon()/2}));
+    CORRADE_VERIFY((Wide4f{1.0f, 2.0f, 3.0f, 4.0f} != Wide4f{1.0f, 2.0f, 3.0f, 4.0f + TypeTraits<Float>::epsilon()*8}));
+    CORRADE_VERIFY(!(Wide4f{1.0f, 2.0f, 3.0f, 4.0f} != Wide4f{1.0f, 2.0f, 3.0f, 4.0f}));
+}
+
+void WideTest::compareLanes() {
+    Wide4f a{1.0f, 2.0f, 3.0f, 4.0f};
+    Wide4f b{4.0f, 2.0f, 2.0f, 5.0f};
+    CORRADE_COMPARE(a < b, BitVector<4>{0x9});
+    CORRADE_COMPARE(a <= b, BitVector<4>{0xb});
+    CORRADE_COMPARE(a >= b, BitVector<4>{0x6});
+    CORRADE_COMPARE(a > b, BitVector<4>{0x4});
+    CORRADE_COMPARE(Math::equal(a, b), BitVector<4>{0x2});
+    CORRADE_COMPARE(Math::notEqual(a, b), BitVector<4>{0xd});
+}
+
+void WideTest::negative() {
+    CORRADE_COMPARE(-Wide4f(1.0f, -2.0f, 3.5f, 0.0f), (Wide4f{-1.0f, 2.0f, -3.5f, 0.0f}));
+    CORRADE_COMPARE(+Wide4f(1.0f, -2.0f, 3.5f, 0.0f), (Wide4f{1.0f, -2.0f, 3.5f, 0.0f}));
+}
+
+void WideTest::addSubtract() {
+    Wide4f a{1.0f, -2.0f, 3.5f, 0.0f};
+    Wide4f b{0.5f, 3.0f, -1.5f, 2.0f};
+    Wide4f c{1.5f, 1.0f, 2.0f, 2.0f};
+    CORRADE_COMPARE(a + b, c);
+    CORRADE_COMPARE(c - b, a);
+}
+
+void WideTest::multiplyDivide() {
+    Wide4f a{1.0f, -2.0f, 3.5f, 0.0f};
+    Wide4f b{0.5f, 3.0f, -2.0f, 2.0f};
+    Wide4f c{0.5f, -6.0f, -7.0f, 0.0f};
+    CORRADE_COMPARE(a*b, c);
+    CORRADE_COMPARE(c/b, a);
+}
+
+void WideTest::multiplyDivideScalar() {
+    Wide4f a{1.0f, -2.0f, 3.5f, 0.0f};
+    Wide4f b{2.0f, -4.0f, 7.0f, 0.0f};
+    CORRADE_COMPARE(a*2.0f, b);
+    CORRADE_COMPARE(2.0f*a, b);
+    CORRADE_COMPARE(b/2.0f, a);
+    CORRADE_COMPARE(1.0f/Wide4f(2.0f, -4.0f, 0.5f, 1.0f), (Wide4f{0.5f, -0.25f, 2.0f, 1.0f}));
+}
+
+void WideTest::minMaxAbsSqrt() {
+    Wide4f a{1.0f, -2.0f, 3.5f, 0.0f};
+    Wide4f b{0.5f, 3.0f, -2.0f, 2.0f};
+    CORRADE_COMPARE(Math::min(a, b), (Wide4f{0.5f, -2.0f, -2.0f, 0.0f}));
+    CORRADE_COMPARE(Math::max(a, b), (Wide4f{1.0f, 3.0f, 3.5f, 2.0f}));
+    CORRADE_COMPARE(Math::abs(a), (Wide4f{1.0f, 2.0f, 3.5f, 0.0f}));
+    CORRADE_COMPARE(Math::sqrt(Wide4f{4.0f, 0.25f, 16.0f, 0.0f}), (Wide4f{2.0f, 0.5f, 4.0f, 0.0f}));
+}
+
+void WideTest::select() {
+    Wide4f a{1.0f, -2.0f, 3.5f, 0.0f};
+    Wide4f b{0.5f, 3.0f, -2.0f, 2.0f};
+    CORRADE_COMPARE(Math::select(BitVector<4>{0x5}, a, b), (Wide4f{1.0f, 3.0f, 3.5f, 2.0f}));
+    CORRADE_COMPARE(Math::select(a < Wide4f{0.0f}, Wide4f{0.0f}, a), (Wide4f{1.0f, 0.0f, 3.5f, 0.0f}));
+}
+
+void WideTest::sum() {
+    CORRADE_COMPARE((Wide4f{1.0f, -2.0f, 3.5f, 0.5f}.sum()), 3.0f);
+}
+
+void WideTest::vector() {
+    const Vector3 a[]{
+        {1.0f, 2.0f, 3.0f},
+        {-0.5f, 7.0f, 0.25f},
+        {0.0f, 1.0f, 0.0f},
+        {3.0f, -4.0f, 2.0f}
+    };
+    const Vector3 b[]{
+        {0.0f, 0.0f, 1.0f},
+        {2.0f, -1.0f, 0.5f},
+        {1.0f, 0.0f, 0.0f},
+        {3.0f, 4.0f, -2.0f}
+    };
+
+    WideVector3 wa = loadWide<4>(Corrade::Containers::stridedArrayView(a));
+    WideVector3 wb = loadWide<4>(Corrade::Containers::stridedArrayView(b));
+
+    /* Everything should match the scalar results in each lane */
+    WideVector3 crossed = Math::cross(wa, wb);
+    Wide4f dotted = Math::dot(wa, wb);
+    WideVector3 combined = wa*Wide4f{2.0f} - wb + wa*wb;
+    for(std::size_t i = 0; i != 4; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE((Vector3{crossed.x()[i], crossed.y()[i], crossed.z()[i]}), Math::cross(a[i], b[i]));
+        CORRADE_COMPARE(dotted[i], Math::dot(a[i], b[i]));
+        CORRADE_COMPARE((Vector3{combined.x()[i], combined.y()[i], combined.z()[i]}), a[i]*2.0f - b[i] + a[i]*b[i]);
+    }
+
+    /* Vector comparison works through Wide::operator==() */
+    CORRADE_COMPARE(wa, wa);
+    CORRADE_VERIFY(wa != wb);
+}
+
+void WideTest::matrix() {
+    const Matrix4 transformation =
+        Matrix4::translation({1.0f, -2.0f, 3.5f})*
+        Matrix4::rotation(Deg(35.0f), Vector3{1.0f, 2.0f, -0.5f}.normalized())*
+        Matrix4::scaling({2.0f, 0.5f, -1.5f});
+    const Vector3 points[]{
+        {1.0f, 2.0f, 3.0f},
+        {-0.5f, 7.0f, 0.25f},
+        {0.0f, 1.0f, 0.0f},
+        {3.0f, -4.0f, 2.0f}
+    };
+
+    /* Broadcast */
+    const WideMatrix4 wideTransformation{transformation};
+    CORRADE_COMPARE(wideTransformation[3][1], Wide4f{-2.0f});
+
+    Vector3 transformed[4];
+    storeWide(wideTransformation.transformPoint(loadWide<4>(Corrade::Containers::stridedArrayView(points))), Corrade::Containers::stridedArrayView(transformed));
+    for(std::size_t i = 0; i != 4; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(transformed[i], transformation.transformPoint(points[i]));
+    }
+}
+
+void WideTest::quaternion() {
+    const Quaternion a[]{
+        Quaternion::rotation(Deg(35.0f), Vector3::xAxis()),
+        Quaternion::rotation(Deg(-120.0f), Vector3::yAxis()),
+        Quaternion{},
+        Quaternion::rotation(Deg(90.0f), Vector3{1.0f, 1.0f, 0.0f}.normalized())
+    };
+    const Quaternion b = Quaternion::rotation(Deg(15.0f), Vector3::zAxis());
+
+    Quaternion multiplied[4];
+    storeWide(loadWide<4>(Corrade::Containers::stridedArrayView(a))*Math::Quaternion<Wide4f>{b}, Corrade::Containers::stridedArrayView(multiplied));
+    for(std::size_t i = 0; i != 4; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(multiplied[i], a[i]*b);
+    }
+}
+
+void WideTest::load() {
+    struct Data {
+        Vector3 position;
+        Float padding;
+    } data[]{
+        {{1.0f, 2.0f, 3.0f}, 0.0f},
+        {{4.0f, 5.0f, 6.0f}, 0.0f},
+        {{7.0f, 8.0f, 9.0f}, 0.0f},
+        {{10.0f, 11.0f, 12.0f}, 0.0f}
+    };
+
+    /* Mutable view, strided */
+    Corrade::Containers::StridedArrayView1D<Vector3> positions{data, &data[0].position, 4, sizeof(Data)};
+    WideVector3 a = loadWide<4>(positions);
+    CORRADE_COMPARE(a.x(), (Wide4f{1.0f, 4.0f, 7.0f, 10.0f}));
+    CORRADE_COMPARE(a.y(), (Wide4f{2.0f, 5.0f, 8.0f, 11.0f}));
+    CORRADE_COMPARE(a.z(), (Wide4f{3.0f, 6.0f, 9.0f, 12.0f}));
+}
+
+void WideTest::loadPartial() {
+    const Vector3 data[]{
+        {1.0f, 2.0f, 3.0f},
+        {4.0f, 5.0f, 6.0f}
+    };
+
+    /* The remaining lanes are zero */
+    WideVector3 a = loadWide<4>(Corrade::Containers::stridedArrayView(data));
+    CORRADE_COMPARE(a.x(), (Wide4f{1.0f, 4.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(a.y(), (Wide4f{2.0f, 5.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(a.z(), (Wide4f{3.0f, 6.0f, 0.0f, 0.0f}));
+}
+
+void WideTest::loadScalar() {
+    const Float data[]{1.0f, 2.0f, 3.0f};
+    CORRADE_COMPARE(loadWide<4>(Corrade::Containers::stridedArrayView(data)), (Wide4f{1.0f, 2.0f, 3.0f, 0.0f}));
+}
+
+void WideTest::store() {
+    struct Data {
+        Vector4 value;
+        Float padding;
+    } data[4]{};
+
+    Math::Vector4<Wide4f> a{
+        Wide4f{1.0f, 5.0f, 9.0f, 13.0f},
+        Wide4f{2.0f, 6.0f, 10.0f, 14.0f},
+        Wide4f{3.0f, 7.0f, 11.0f, 15.0f},
+        Wide4f{4.0f, 8.0f, 12.0f, 16.0f}};
+    storeWide(a, Corrade::Containers::StridedArrayView1D<Vector4>{data, &data[0].value, 4, sizeof(Data)});
+    CORRADE_COMPARE(data[0].value, (Vector4{1.0f, 2.0f, 3.0f, 4.0f}));
+    CORRADE_COMPARE(data[1].value, (Vector4{5.0f, 6.0f, 7.0f, 8.0f}));
+    CORRADE_COMPARE(data[2].value, (Vector4{9.0f, 10.0f, 11.0f, 12.0f}));
+    CORRADE_COMPARE(data[3].value, (Vector4{13.0f, 14.0f, 15.0f, 16.0f}));
+
+    /* Padding shouldn't be touched */
+    for(const Data& i: data) CORRADE_COMPARE(i.padding, 0.0f);
+}
+
+void WideTest::storePartial() {
+    Vector3 data[]{
+        {-1.0f, -1.0f, -1.0f},
+        {-1.0f, -1.0f, -1.0f}
+    };
+
+    WideVector3 a{
+        Wide4f{1.0f, 4.0f, 7.0f, 10.0f},
+        Wide4f{2.0f, 5.0f, 8.0f, 11.0f},
+        Wide4f{3.0f, 6.0f, 9.0f, 12.0f}};
+    storeWide(a, Corrade::Containers::stridedArrayView(data).prefix(1));
+    CORRADE_COMPARE(data[0], (Vector3{1.0f, 2.0f, 3.0f}));
+    CORRADE_COMPARE(data[1], (Vector3{-1.0f, -1.0f, -1.0f}));
+}
+
+void WideTest::storeScalar() {
+    Float data[3]{};
+    storeWide(Wide4f{1.0f, 2.0f, 3.0f, 4.0f}, Corrade::Containers::stridedArrayView(data));
+    CORRADE_COMPARE(data[0], 1.0f);
+    CORRADE_COMPARE(data[1], 2.0f);
+    CORRADE_COMPARE(data[2], 3.0f);
+}
+
+void WideTest::loadStoreInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Vector3 data[5];
+    Float scalarData[5];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    loadWide<4>(Corrade::Containers::stridedArrayView(data));
+    loadWide<4>(Corrade::Containers::stridedArrayView(scalarData));
+    storeWide(WideVector3{}, Corrade::Containers::stridedArrayView(data));
+    storeWide(Wide4f{}, Corrade::Containers::stridedArrayView(scalarData));
+    CORRADE_COMPARE(out.str(),
+        "Math::loadWide(): expected at most 4 items but got 5\n"
+        "Math::loadWide(): expected at most 4 items but got 5\n"
+        "Math::storeWide(): expected at most 4 items but got 5\n"
+        "Math::storeWide(): expected at most 4 items but got 5\n");
+}
+
+void WideTest::debug() {
+    std::ostringstream o;
+    Debug(&o) << Wide4f{0.5f, 15.0f, 1.0f, -2.0f};
+    CORRADE_COMPARE(o.str(), "Wide(0.5, 15, 1, -2)\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::WideTest)
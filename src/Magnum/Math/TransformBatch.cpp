@@ -0,0 +1,331 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "TransformBatch.h"
+
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Implementation/lanes.h"
+
+namespace Magnum { namespace Math {
+
+/* The kernels below do the operations in the same order as in
+   RectangularMatrix::operator*() -- multiply each column with a component and
+   accumulate from the first to the last -- so the results match the
+   per-element APIs. */
+using namespace Implementation;
+
+void transformPointsInto(const Matrix4<Float>& matrix, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector3<Float>>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::transformPointsInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    /* Caching values to avoid inline function calls in debug builds */
+    const Lanes c0 = lanesLoad4(matrix[0].data());
+    const Lanes c1 = lanesLoad4(matrix[1].data());
+    const Lanes c2 = lanesLoad4(matrix[2].data());
+    const Lanes c3 = lanesLoad4(matrix[3].data());
+    const char* srcPtr = reinterpret_cast<const char*>(src.data());
+    char* dstPtr = reinterpret_cast<char*>(dst.data());
+    const std::ptrdiff_t srcStride = src.stride();
+    const std::ptrdiff_t dstStride = dst.stride();
+    for(std::size_t i = 0, max = src.size(); i != max; ++i) {
+        const Float* const in = reinterpret_cast<const Float*>(srcPtr);
+        const Lanes out = lanesAdd(lanesAdd(lanesAdd(
+            lanesMultiply(c0, in[0]),
+            lanesMultiply(c1, in[1])),
+            lanesMultiply(c2, in[2])),
+            c3);
+        lanesStore3(reinterpret_cast<Float*>(dstPtr), lanesDivideByW(out));
+
+        srcPtr += srcStride;
+        dstPtr += dstStride;
+    }
+}
+
+void transformPointsInto(const Matrix4<Float>& matrix, const Corrade::Containers::StridedArrayView1D<const Vector4<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector4<Float>>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::transformPointsInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    /* Caching values to avoid inline function calls in debug builds */
+    const Lanes c0 = lanesLoad4(matrix[0].data());
+    const Lanes c1 = lanesLoad4(matrix[1].data());
+    const Lanes c2 = lanesLoad4(matrix[2].data());
+    const Lanes c3 = lanesLoad4(matrix[3].data());
+    const char* srcPtr = reinterpret_cast<const char*>(src.data());
+    char* dstPtr = reinterpret_cast<char*>(dst.data());
+    const std::ptrdiff_t srcStride = src.stride();
+    const std::ptrdiff_t dstStride = dst.stride();
+    for(std::size_t i = 0, max = src.size(); i != max; ++i) {
+        const Float* const in = reinterpret_cast<const Float*>(srcPtr);
+        lanesStore4(reinterpret_cast<Float*>(dstPtr), lanesAdd(lanesAdd(lanesAdd(
+            lanesMultiply(c0, in[0]),
+            lanesMultiply(c1, in[1])),
+            lanesMultiply(c2, in[2])),
+            lanesMultiply(c3, in[3])));
+
+        srcPtr += srcStride;
+        dstPtr += dstStride;
+    }
+}
+
+void transformPointsInto(const Matrix3<Float>& matrix, const Corrade::Containers::StridedArrayView1D<const Vector2<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector2<Float>>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::transformPointsInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    /** @todo SIMD implementation processing two items at a time, with just
+        two components per item it's not worth it to do one at a time */
+
+    /* Caching values to avoid inline function calls in debug builds */
+    const Float m00 = matrix[0][0], m01 = matrix[0][1];
+    const Float m10 = matrix[1][0], m11 = matrix[1][1];
+    const Float m20 = matrix[2][0], m21 = matrix[2][1];
+    const char* srcPtr = reinterpret_cast<const char*>(src.data());
+    char* dstPtr = reinterpret_cast<char*>(dst.data());
+    const std::ptrdiff_t srcStride = src.stride();
+    const std::ptrdiff_t dstStride = dst.stride();
+    for(std::size_t i = 0, max = src.size(); i != max; ++i) {
+        const Float* const in = reinterpret_cast<const Float*>(srcPtr);
+        Float* const out = reinterpret_cast<Float*>(dstPtr);
+        const Float x = in[0], y = in[1];
+        out[0] = m00*x + m10*y + m20;
+        out[1] = m01*x + m11*y + m21;
+
+        srcPtr += srcStride;
+        dstPtr += dstStride;
+    }
+}
+
+void transformVectorsInto(const Matrix4<Float>& matrix, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector3<Float>>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::transformVectorsInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    /* Caching values to avoid inline function calls in debug builds */
+    const Lanes c0 = lanesLoad4(matrix[0].data());
+    const Lanes c1 = lanesLoad4(matrix[1].data());
+    const Lanes c2 = lanesLoad4(matrix[2].data());
+    const char* srcPtr = reinterpret_cast<const char*>(src.data());
+    char* dstPtr = reinterpret_cast<char*>(dst.data());
+    const std::ptrdiff_t srcStride = src.stride();
+    const std::ptrdiff_t dstStride = dst.stride();
+    for(std::size_t i = 0, max = src.size(); i != max; ++i) {
+        const Float* const in = reinterpret_cast<const Float*>(srcPtr);
+        lanesStore3(reinterpret_cast<Float*>(dstPtr), lanesAdd(lanesAdd(
+            lanesMultiply(c0, in[0]),
+            lanesMultiply(c1, in[1])),
+            lanesMultiply(c2, in[2])));
+
+        srcPtr += srcStride;
+        dstPtr += dstStride;
+    }
+}
+
+void transformVectorsInto(const Matrix3x3<Float>& matrix, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector3<Float>>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::transformVectorsInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    /* Caching values to avoid inline function calls in debug builds. The
+       columns have just three components, so they can't be loaded directly
+       as the last one would read past the end. */
+    const Lanes c0 = lanesLoad3(matrix[0].data());
+    const Lanes c1 = lanesLoad3(matrix[1].data());
+    const Lanes c2 = lanesLoad3(matrix[2].data());
+    const char* srcPtr = reinterpret_cast<const char*>(src.data());
+    char* dstPtr = reinterpret_cast<char*>(dst.data());
+    const std::ptrdiff_t srcStride = src.stride();
+    const std::ptrdiff_t dstStride = dst.stride();
+    for(std::size_t i = 0, max = src.size(); i != max; ++i) {
+        const Float* const in = reinterpret_cast<const Float*>(srcPtr);
+        lanesStore3(reinterpret_cast<Float*>(dstPtr), lanesAdd(lanesAdd(
+            lanesMultiply(c0, in[0]),
+            lanesMultiply(c1, in[1])),
+            lanesMultiply(c2, in[2])));
+
+        srcPtr += srcStride;
+        dstPtr += dstStride;
+    }
+}
+
+void transformVectorsInto(const Matrix3<Float>& matrix, const Corrade::Containers::StridedArrayView1D<const Vector2<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector2<Float>>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::transformVectorsInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    /** @todo SIMD implementation processing two items at a time, with just
+        two components per item it's not worth it to do one at a time */
+
+    /* Caching values to avoid inline function calls in debug builds */
+    const Float m00 = matrix[0][0], m01 = matrix[0][1];
+    const Float m10 = matrix[1][0], m11 = matrix[1][1];
+    const char* srcPtr = reinterpret_cast<const char*>(src.data());
+    char* dstPtr = reinterpret_cast<char*>(dst.data());
+    const std::ptrdiff_t srcStride = src.stride();
+    const std::ptrdiff_t dstStride = dst.stride();
+    for(std::size_t i = 0, max = src.size(); i != max; ++i) {
+        const Float* const in = reinterpret_cast<const Float*>(srcPtr);
+        Float* const out = reinterpret_cast<Float*>(dstPtr);
+        const Float x = in[0], y = in[1];
+        out[0] = m00*x + m10*y;
+        out[1] = m01*x + m11*y;
+
+        srcPtr += srcStride;
+        dstPtr += dstStride;
+    }
+}
+
+
+void normalMatricesInto(const Corrade::Containers::StridedArrayView1D<const Matrix4<Float>>& src, const Corrade::Containers::StridedArrayView1D<Matrix3x3<Float>>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::normalMatricesInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    const char* srcPtr = reinterpret_cast<const char*>(src.data());
+    char* dstPtr = reinterpret_cast<char*>(dst.data());
+    const std::ptrdiff_t srcStride = src.stride();
+    const std::ptrdiff_t dstStride = dst.stride();
+    for(std::size_t i = 0, max = src.size(); i != max; ++i) {
+        const Float* const in = reinterpret_cast<const Float*>(srcPtr);
+        Float* const out = reinterpret_cast<Float*>(dstPtr);
+
+        /* Comatrix of the upper left 3x3 part. With the columns being a, b
+           and c, its columns are b×c, c×a and a×b. */
+        const Float ax = in[0], ay = in[1], az = in[2];
+        const Float bx = in[4], by = in[5], bz = in[6];
+        const Float cx = in[8], cy = in[9], cz = in[10];
+        out[0] = by*cz - bz*cy;
+        out[1] = bz*cx - bx*cz;
+        out[2] = bx*cy - by*cx;
+        out[3] = cy*az - cz*ay;
+        out[4] = cz*ax - cx*az;
+        out[5] = cx*ay - cy*ax;
+        out[6] = ay*bz - az*by;
+        out[7] = az*bx - ax*bz;
+        out[8] = ax*by - ay*bx;
+
+        srcPtr += srcStride;
+        dstPtr += dstStride;
+    }
+}
+
+void invertedRigidInto(const Corrade::Containers::StridedArrayView1D<const Matrix4<Float>>& src, const Corrade::Containers::StridedArrayView1D<Matrix4<Float>>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::invertedRigidInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    const char* srcPtr = reinterpret_cast<const char*>(src.data());
+    char* dstPtr = reinterpret_cast<char*>(dst.data());
+    const std::ptrdiff_t srcStride = src.stride();
+    const std::ptrdiff_t dstStride = dst.stride();
+    for(std::size_t i = 0, max = src.size(); i != max; ++i) {
+        const Float* const in = reinterpret_cast<const Float*>(srcPtr);
+        Float* const out = reinterpret_cast<Float*>(dstPtr);
+
+        /* Everything is read upfront so the operation can be done in-place.
+           The inverse is a transposed rotation part and a translation rotated
+           by it in the opposite direction. */
+        const Float ax = in[0], ay = in[1], az = in[2];
+        const Float bx = in[4], by = in[5], bz = in[6];
+        const Float cx = in[8], cy = in[9], cz = in[10];
+        const Float tx = in[12], ty = in[13], tz = in[14];
+        out[0] = ax;
+        out[1] = bx;
+        out[2] = cx;
+        out[3] = 0.0f;
+        out[4] = ay;
+        out[5] = by;
+        out[6] = cy;
+        out[7] = 0.0f;
+        out[8] = az;
+        out[9] = bz;
+        out[10] = cz;
+        out[11] = 0.0f;
+        out[12] = -(ax*tx + ay*ty + az*tz);
+        out[13] = -(bx*tx + by*ty + bz*tz);
+        out[14] = -(cx*tx + cy*ty + cz*tz);
+        out[15] = 1.0f;
+
+        srcPtr += srcStride;
+        dstPtr += dstStride;
+    }
+}
+
+void invertedInto(const Corrade::Containers::StridedArrayView1D<const Matrix4<Float>>& src, const Corrade::Containers::StridedArrayView1D<Matrix4<Float>>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::invertedInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    const char* srcPtr = reinterpret_cast<const char*>(src.data());
+    char* dstPtr = reinterpret_cast<char*>(dst.data());
+    const std::ptrdiff_t srcStride = src.stride();
+    const std::ptrdiff_t dstStride = dst.stride();
+    for(std::size_t i = 0, max = src.size(); i != max; ++i) {
+        const Float* const in = reinterpret_cast<const Float*>(srcPtr);
+        Float* const out = reinterpret_cast<Float*>(dstPtr);
+
+        /* Everything is read upfront so the operation can be done in-place.
+           Since (A^T)^-1 = (A^-1)^T, the columns can be treated as rows here
+           without having to transpose anything. */
+        const Float a00 = in[ 0], a01 = in[ 1], a02 = in[ 2], a03 = in[ 3];
+        const Float a10 = in[ 4], a11 = in[ 5], a12 = in[ 6], a13 = in[ 7];
+        const Float a20 = in[ 8], a21 = in[ 9], a22 = in[10], a23 = in[11];
+        const Float a30 = in[12], a31 = in[13], a32 = in[14], a33 = in[15];
+
+        /* 2x2 subdeterminants of the first two and the last two rows, which
+           are then shared by all cofactors */
+        const Float s0 = a00*a11 - a10*a01;
+        const Float s1 = a00*a12 - a10*a02;
+        const Float s2 = a00*a13 - a10*a03;
+        const Float s3 = a01*a12 - a11*a02;
+        const Float s4 = a01*a13 - a11*a03;
+        const Float s5 = a02*a13 - a12*a03;
+        const Float c0 = a20*a31 - a30*a21;
+        const Float c1 = a20*a32 - a30*a22;
+        const Float c2 = a20*a33 - a30*a23;
+        const Float c3 = a21*a32 - a31*a22;
+        const Float c4 = a21*a33 - a31*a23;
+        const Float c5 = a22*a33 - a32*a23;
+
+        const Float invDeterminant = 1.0f/(s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0);
+        out[ 0] = ( a11*c5 - a12*c4 + a13*c3)*invDeterminant;
+        out[ 1] = (-a01*c5 + a02*c4 - a03*c3)*invDeterminant;
+        out[ 2] = ( a31*s5 - a32*s4 + a33*s3)*invDeterminant;
+        out[ 3] = (-a21*s5 + a22*s4 - a23*s3)*invDeterminant;
+        out[ 4] = (-a10*c5 + a12*c2 - a13*c1)*invDeterminant;
+        out[ 5] = ( a00*c5 - a02*c2 + a03*c1)*invDeterminant;
+        out[ 6] = (-a30*s5 + a32*s2 - a33*s1)*invDeterminant;
+        out[ 7] = ( a20*s5 - a22*s2 + a23*s1)*invDeterminant;
+        out[ 8] = ( a10*c4 - a11*c2 + a13*c0)*invDeterminant;
+        out[ 9] = (-a00*c4 + a01*c2 - a03*c0)*invDeterminant;
+        out[10] = ( a30*s4 - a31*s2 + a33*s0)*invDeterminant;
+        out[11] = (-a20*s4 + a21*s2 - a23*s0)*invDeterminant;
+        out[12] = (-a10*c3 + a11*c1 - a12*c0)*invDeterminant;
+        out[13] = ( a00*c3 - a01*c1 + a02*c0)*invDeterminant;
+        out[14] = (-a30*s3 + a31*s1 - a32*s0)*invDeterminant;
+        out[15] = ( a20*s3 - a21*s1 + a22*s0)*invDeterminant;
+
+        srcPtr += srcStride;
+        dstPtr += dstStride;
+    }
+}
+
+}}
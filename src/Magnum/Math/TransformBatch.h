@@ -0,0 +1,216 @@
+#ifndef Magnum_Math_TransformBatch_h
+#define Magnum_Math_TransformBatch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Functions @ref Magnum::Math::transformPointsInto(), @ref Magnum::Math::transformVectorsInto(), @ref Magnum::Math::normalMatricesInto(), @ref Magnum::Math::invertedRigidInto(), @ref Magnum::Math::invertedInto()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Types.h"
+#include "Magnum/visibility.h"
+#include "Magnum/Math/Math.h"
+
+namespace Magnum { namespace Math {
+
+/**
+@{ @name Batch transformation functions
+
+These functions transform an unbounded range of points or vectors with a single
+matrix, as opposed to the per-element @ref Matrix4::transformPoint() and
+friends. On x86 the 3D and homogeneous variants use SSE2, on ARM NEON, with a
+scalar fallback everywhere else. The result is the same as when calling the
+per-element functions in a loop, up to differences caused by the compiler
+fusing multiplications and additions in the scalar code.
+*/
+
+/**
+@brief Transform 3D points with a 4x4 matrix
+@param[in]  matrix  Transformation matrix
+@param[in]  src     Source points
+@param[out] dst     Destination points
+@m_since_latest
+
+Equivalent to calling @ref Matrix4::transformPoint() on each item, including
+the division by the resulting W component. Expects that @p src and @p dst have
+the same size. The views can be arbitrarily strided and @p dst can be the same
+view as @p src for an in-place operation, but otherwise the views shouldn't
+overlap.
+@see @ref transformVectorsInto(const Matrix4<Float>&, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>&, const Corrade::Containers::StridedArrayView1D<Vector3<Float>>&)
+*/
+MAGNUM_EXPORT void transformPointsInto(const Matrix4<Float>& matrix, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector3<Float>>& dst);
+
+/**
+@brief Transform homogeneous 3D points with a 4x4 matrix
+@param[in]  matrix  Transformation matrix
+@param[in]  src     Source points
+@param[out] dst     Destination points
+@m_since_latest
+
+Equivalent to @cpp matrix*src[i] @ce for each item, i.e. the W component
+is taken from the input and no division is done. Expects that @p src and
+@p dst have the same size. The views can be arbitrarily strided and @p dst can
+be the same view as @p src for an in-place operation, but otherwise the views
+shouldn't overlap.
+*/
+MAGNUM_EXPORT void transformPointsInto(const Matrix4<Float>& matrix, const Corrade::Containers::StridedArrayView1D<const Vector4<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector4<Float>>& dst);
+
+/**
+@brief Transform 2D points with a 3x3 matrix
+@param[in]  matrix  Transformation matrix
+@param[in]  src     Source points
+@param[out] dst     Destination points
+@m_since_latest
+
+Equivalent to calling @ref Matrix3::transformPoint() on each item. Expects
+that @p src and @p dst have the same size. The views can be arbitrarily
+strided and @p dst can be the same view as @p src for an in-place operation,
+but otherwise the views shouldn't overlap.
+@see @ref transformVectorsInto(const Matrix3<Float>&, const Corrade::Containers::StridedArrayView1D<const Vector2<Float>>&, const Corrade::Containers::StridedArrayView1D<Vector2<Float>>&)
+*/
+MAGNUM_EXPORT void transformPointsInto(const Matrix3<Float>& matrix, const Corrade::Containers::StridedArrayView1D<const Vector2<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector2<Float>>& dst);
+
+/**
+@brief Transform 3D vectors with a 4x4 matrix
+@param[in]  matrix  Transformation matrix
+@param[in]  src     Source vectors
+@param[out] dst     Destination vectors
+@m_since_latest
+
+Equivalent to calling @ref Matrix4::transformVector() on each item, i.e.
+ignoring the translation part. Expects that @p src and @p dst have the same
+size. The views can be arbitrarily strided and @p dst can be the same view as
+@p src for an in-place operation, but otherwise the views shouldn't overlap.
+@see @ref transformPointsInto(const Matrix4<Float>&, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>&, const Corrade::Containers::StridedArrayView1D<Vector3<Float>>&)
+*/
+MAGNUM_EXPORT void transformVectorsInto(const Matrix4<Float>& matrix, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector3<Float>>& dst);
+
+/**
+@brief Transform 3D vectors with a 3x3 matrix
+@param[in]  matrix  Transformation matrix
+@param[in]  src     Source vectors
+@param[out] dst     Destination vectors
+@m_since_latest
+
+Equivalent to @cpp matrix*src[i] @ce for each item. Useful for example for
+transforming normals with @ref Matrix4::normalMatrix(). Expects that @p src
+and @p dst have the same size. The views can be arbitrarily strided and @p dst
+can be the same view as @p src for an in-place operation, but otherwise the
+views shouldn't overlap.
+*/
+MAGNUM_EXPORT void transformVectorsInto(const Matrix3x3<Float>& matrix, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector3<Float>>& dst);
+
+/**
+@brief Transform 2D vectors with a 3x3 matrix
+@param[in]  matrix  Transformation matrix
+@param[in]  src     Source vectors
+@param[out] dst     Destination vectors
+@m_since_latest
+
+Equivalent to calling @ref Matrix3::transformVector() on each item, i.e.
+ignoring the translation part. Expects that @p src and @p dst have the same
+size. The views can be arbitrarily strided and @p dst can be the same view as
+@p src for an in-place operation, but otherwise the views shouldn't overlap.
+@see @ref transformPointsInto(const Matrix3<Float>&, const Corrade::Containers::StridedArrayView1D<const Vector2<Float>>&, const Corrade::Containers::StridedArrayView1D<Vector2<Float>>&)
+*/
+MAGNUM_EXPORT void transformVectorsInto(const Matrix3<Float>& matrix, const Corrade::Containers::StridedArrayView1D<const Vector2<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector2<Float>>& dst);
+
+/* Since 1.8.17, the original short-hand group closing doesn't work anymore.
+   FFS. */
+/**
+ * @}
+ */
+
+/**
+@{ @name Batch matrix functions
+
+These functions calculate derived matrices for an unbounded range of
+transformation matrices, such as when preparing per-drawable uniforms every
+frame, as opposed to the per-element @ref Matrix4::normalMatrix(),
+@ref Matrix4::invertedRigid() and @ref Matrix4::inverted(). The kernels are
+branch-free and read each matrix just once, which allows the compiler to
+schedule and vectorize the arithmetic well. The results are the same as when
+calling the per-element functions in a loop, up to floating-point rounding
+differences caused by a different order of operations.
+*/
+
+/**
+@brief Calculate normal matrices for a list of 4x4 transformation matrices
+@param[in]  src     Source transformation matrices
+@param[out] dst     Destination normal matrices
+@m_since_latest
+
+Equivalent to calling @ref Matrix4::normalMatrix() on each item. Expects that
+@p src and @p dst have the same size. The views can be arbitrarily strided.
+@see @ref transformVectorsInto(const Matrix3x3<Float>&, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>&, const Corrade::Containers::StridedArrayView1D<Vector3<Float>>&)
+*/
+MAGNUM_EXPORT void normalMatricesInto(const Corrade::Containers::StridedArrayView1D<const Matrix4<Float>>& src, const Corrade::Containers::StridedArrayView1D<Matrix3x3<Float>>& dst);
+
+/**
+@brief Invert a list of rigid 4x4 transformation matrices
+@param[in]  src     Source rigid transformation matrices
+@param[out] dst     Destination inverted matrices
+@m_since_latest
+
+Equivalent to calling @ref Matrix4::invertedRigid() on each item. Unlike the
+per-element variant, the matrices are *not* checked to be rigid
+transformations --- if they contain scaling, shear or projection, the output
+is undefined. Expects that @p src and @p dst have the same size. The views can
+be arbitrarily strided and @p dst can be the same view as @p src for an
+in-place operation, but otherwise the views shouldn't overlap.
+@see @ref invertedInto()
+*/
+MAGNUM_EXPORT void invertedRigidInto(const Corrade::Containers::StridedArrayView1D<const Matrix4<Float>>& src, const Corrade::Containers::StridedArrayView1D<Matrix4<Float>>& dst);
+
+/**
+@brief Invert a list of 4x4 matrices
+@param[in]  src     Source matrices
+@param[out] dst     Destination inverted matrices
+@m_since_latest
+
+Equivalent to calling @ref Matrix4::inverted() on each item, calculated using
+a Laplace expansion via 2x2 subdeterminants. Same as with the per-element
+variant, the matrices are expected to be invertible, singular matrices result
+in non-finite values. If the matrices are known to be rigid transformations,
+@ref invertedRigidInto() is significantly faster. Expects that @p src and
+@p dst have the same size. The views can be arbitrarily strided and @p dst can
+be the same view as @p src for an in-place operation, but otherwise the views
+shouldn't overlap.
+@see @ref Algorithms::gaussJordanInverted()
+*/
+MAGNUM_EXPORT void invertedInto(const Corrade::Containers::StridedArrayView1D<const Matrix4<Float>>& src, const Corrade::Containers::StridedArrayView1D<Matrix4<Float>>& dst);
+
+/* Since 1.8.17, the original short-hand group closing doesn't work anymore.
+   FFS. */
+/**
+ * @}
+ */
+
+}}
+
+#endif
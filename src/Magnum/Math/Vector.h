@@ -101,7 +101,7 @@ the same general direction, `1` when two *normalized* vectors are parallel,
 @f]
 @see @ref Vector::dot() const, @ref Vector::operator-(), @ref Vector2::perpendicular()
 */
-template<std::size_t size, class T> inline T dot(const Vector<size, T>& a, const Vector<size, T>& b) {
+template<std::size_t size, class T> MAGNUM_CONSTEXPR14 inline T dot(const Vector<size, T>& a, const Vector<size, T>& b) {
     T out{};
     for(std::size_t i = 0; i != size; ++i)
         out += a._data[i]*b._data[i];
@@ -254,7 +254,7 @@ template<std::size_t size, class T> class Vector {
          *
          * @see @ref data()
          */
-        T& operator[](std::size_t pos) { return _data[pos]; }
+        MAGNUM_CONSTEXPR14 T& operator[](std::size_t pos) { return _data[pos]; }
         constexpr T operator[](std::size_t pos) const { return _data[pos]; } /**< @overload */
 
         /**
@@ -339,9 +339,9 @@ template<std::size_t size, class T> class Vector {
          * @see @ref Vector2::perpendicular()
          */
         #ifdef DOXYGEN_GENERATING_OUTPUT
-        Vector<size, T>
+        MAGNUM_CONSTEXPR14 Vector<size, T>
         #else
-        template<class U = T> typename std::enable_if<std::is_signed<U>::value, Vector<size, T>>::type
+        template<class U = T> MAGNUM_CONSTEXPR14 typename std::enable_if<std::is_signed<U>::value, Vector<size, T>>::type
         #endif
         operator-() const;
 
@@ -352,7 +352,7 @@ template<std::size_t size, class T> class Vector {
          *      \boldsymbol a_i = \boldsymbol a_i + \boldsymbol b_i
          * @f]
          */
-        Vector<size, T>& operator+=(const Vector<size, T>& other) {
+        MAGNUM_CONSTEXPR14 Vector<size, T>& operator+=(const Vector<size, T>& other) {
             for(std::size_t i = 0; i != size; ++i)
                 _data[i] += other._data[i];
 
@@ -364,7 +364,7 @@ template<std::size_t size, class T> class Vector {
          *
          * @see @ref operator+=(), @ref sum()
          */
-        Vector<size, T> operator+(const Vector<size, T>& other) const {
+        MAGNUM_CONSTEXPR14 Vector<size, T> operator+(const Vector<size, T>& other) const {
             return Vector<size, T>(*this) += other;
         }
 
@@ -375,7 +375,7 @@ template<std::size_t size, class T> class Vector {
          *      \boldsymbol a_i = \boldsymbol a_i - \boldsymbol b_i
          * @f]
          */
-        Vector<size, T>& operator-=(const Vector<size, T>& other) {
+        MAGNUM_CONSTEXPR14 Vector<size, T>& operator-=(const Vector<size, T>& other) {
             for(std::size_t i = 0; i != size; ++i)
                 _data[i] -= other._data[i];
 
@@ -387,7 +387,7 @@ template<std::size_t size, class T> class Vector {
          *
          * @see @ref operator-=()
          */
-        Vector<size, T> operator-(const Vector<size, T>& other) const {
+        MAGNUM_CONSTEXPR14 Vector<size, T> operator-(const Vector<size, T>& other) const {
             return Vector<size, T>(*this) -= other;
         }
 
@@ -400,7 +400,7 @@ template<std::size_t size, class T> class Vector {
          * @see @ref operator*=(const Vector<size, T>&),
          *      @ref operator*=(Vector<size, Integral>&, FloatingPoint)
          */
-        Vector<size, T>& operator*=(T scalar) {
+        MAGNUM_CONSTEXPR14 Vector<size, T>& operator*=(T scalar) {
             for(std::size_t i = 0; i != size; ++i)
                 _data[i] *= scalar;
 
@@ -414,7 +414,7 @@ template<std::size_t size, class T> class Vector {
          *      @ref operator*=(T), @ref operator*(T, const Vector<size, T>&),
          *      @ref operator*(const Vector<size, Integral>&, FloatingPoint)
          */
-        Vector<size, T> operator*(T scalar) const {
+        MAGNUM_CONSTEXPR14 Vector<size, T> operator*(T scalar) const {
             return Vector<size, T>(*this) *= scalar;
         }
 
@@ -427,7 +427,7 @@ template<std::size_t size, class T> class Vector {
          * @see @ref operator/=(const Vector<size, T>&),
          *      @ref operator/=(Vector<size, Integral>&, FloatingPoint)
          */
-        Vector<size, T>& operator/=(T scalar) {
+        MAGNUM_CONSTEXPR14 Vector<size, T>& operator/=(T scalar) {
             for(std::size_t i = 0; i != size; ++i)
                 _data[i] /= scalar;
 
@@ -441,7 +441,7 @@ template<std::size_t size, class T> class Vector {
          *      @ref operator/=(T), @ref operator/(T, const Vector<size, T>&),
          *      @ref operator/(const Vector<size, Integral>&, FloatingPoint)
          */
-        Vector<size, T> operator/(T scalar) const {
+        MAGNUM_CONSTEXPR14 Vector<size, T> operator/(T scalar) const {
             return Vector<size, T>(*this) /= scalar;
         }
 
@@ -454,7 +454,7 @@ template<std::size_t size, class T> class Vector {
          * @see @ref operator*=(T),
          *      @ref operator*=(Vector<size, Integral>&, const Vector<size, FloatingPoint>&)
          */
-        Vector<size, T>& operator*=(const Vector<size, T>& other) {
+        MAGNUM_CONSTEXPR14 Vector<size, T>& operator*=(const Vector<size, T>& other) {
             for(std::size_t i = 0; i != size; ++i)
                 _data[i] *= other._data[i];
 
@@ -468,7 +468,7 @@ template<std::size_t size, class T> class Vector {
          *      @ref operator*(const Vector<size, Integral>&, const Vector<size, FloatingPoint>&),
          *      @ref product()
          */
-        Vector<size, T> operator*(const Vector<size, T>& other) const {
+        MAGNUM_CONSTEXPR14 Vector<size, T> operator*(const Vector<size, T>& other) const {
             return Vector<size, T>(*this) *= other;
         }
 
@@ -481,7 +481,7 @@ template<std::size_t size, class T> class Vector {
          * @see @ref operator/=(T),
          *      @ref operator/=(Vector<size, Integral>&, const Vector<size, FloatingPoint>&)
          */
-        Vector<size, T>& operator/=(const Vector<size, T>& other) {
+        MAGNUM_CONSTEXPR14 Vector<size, T>& operator/=(const Vector<size, T>& other) {
             for(std::size_t i = 0; i != size; ++i)
                 _data[i] /= other._data[i];
 
@@ -494,7 +494,7 @@ template<std::size_t size, class T> class Vector {
          * @see @ref operator/(T) const, @ref operator/=(const Vector<size, T>&),
          *      @ref operator/(const Vector<size, Integral>&, const Vector<size, FloatingPoint>&)
          */
-        Vector<size, T> operator/(const Vector<size, T>& other) const {
+        MAGNUM_CONSTEXPR14 Vector<size, T> operator/(const Vector<size, T>& other) const {
             return Vector<size, T>(*this) /= other;
         }
 
@@ -509,7 +509,7 @@ template<std::size_t size, class T> class Vector {
          *      @ref isNormalized(), @ref Distance::pointPointSquared(),
          *      @ref Intersection::pointSphere()
          */
-        T dot() const { return Math::dot(*this, *this); }
+        MAGNUM_CONSTEXPR14 T dot() const { return Math::dot(*this, *this); }
 
         /**
          * @brief Vector length
@@ -639,14 +639,14 @@ template<std::size_t size, class T> class Vector {
          *
          * @see @ref operator+(), @ref length()
          */
-        T sum() const;
+        MAGNUM_CONSTEXPR14 T sum() const;
 
         /**
          * @brief Product of values in the vector
          *
          * @see @ref operator*(const Vector<size, T>&) const
          */
-        T product() const;
+        MAGNUM_CONSTEXPR14 T product() const;
 
         /**
          * @brief Minimal value in the vector
@@ -702,7 +702,7 @@ template<std::size_t size, class T> class Vector {
         template<std::size_t size_, class T_> friend BitVector<size_> equal(const Vector<size_, T_>&, const Vector<size_, T_>&);
         template<std::size_t size_, class T_> friend BitVector<size_> notEqual(const Vector<size_, T_>&, const Vector<size_, T_>&);
 
-        template<std::size_t size_, class U> friend U dot(const Vector<size_, U>&, const Vector<size_, U>&);
+        template<std::size_t size_, class U> friend MAGNUM_CONSTEXPR14 U dot(const Vector<size_, U>&, const Vector<size_, U>&);
 
         /* Implementation for Vector<size, T>::Vector(const Vector<size, U>&) */
         template<class U, std::size_t ...sequence> constexpr explicit Vector(Corrade::Containers::Implementation::Sequence<sequence...>, const Vector<size, U>& vector) noexcept: _data{T(vector._data[sequence])...} {}
@@ -756,7 +756,7 @@ template<std::size_t size, class T> inline BitVector<size> notEqual(const Vector
 
 Same as @ref Vector::operator*(T) const.
 */
-template<std::size_t size, class T> inline Vector<size, T> operator*(
+template<std::size_t size, class T> MAGNUM_CONSTEXPR14 inline Vector<size, T> operator*(
     #ifdef DOXYGEN_GENERATING_OUTPUT
     T
     #else
@@ -775,7 +775,7 @@ template<std::size_t size, class T> inline Vector<size, T> operator*(
 @f]
 @see @ref Vector::operator/(T) const
 */
-template<std::size_t size, class T> inline Vector<size, T> operator/(
+template<std::size_t size, class T> MAGNUM_CONSTEXPR14 inline Vector<size, T> operator/(
     #ifdef DOXYGEN_GENERATING_OUTPUT
     T
     #else
@@ -1280,50 +1280,50 @@ extern template MAGNUM_EXPORT Corrade::Utility::Debug& operator<<(Corrade::Utili
         return Math::Vector<size, T>::pad(a, value);                        \
     }                                                                       \
                                                                             \
-    template<class U = T> typename std::enable_if<std::is_signed<U>::value, Type<T>>::type \
+    template<class U = T> MAGNUM_CONSTEXPR14 typename std::enable_if<std::is_signed<U>::value, Type<T>>::type \
     operator-() const {                                                     \
         return Math::Vector<size, T>::operator-();                          \
     }                                                                       \
-    Type<T>& operator+=(const Math::Vector<size, T>& other) {               \
+    MAGNUM_CONSTEXPR14 Type<T>& operator+=(const Math::Vector<size, T>& other) { \
         Math::Vector<size, T>::operator+=(other);                           \
         return *this;                                                       \
     }                                                                       \
-    Type<T> operator+(const Math::Vector<size, T>& other) const {           \
+    MAGNUM_CONSTEXPR14 Type<T> operator+(const Math::Vector<size, T>& other) const { \
         return Math::Vector<size, T>::operator+(other);                     \
     }                                                                       \
-    Type<T>& operator-=(const Math::Vector<size, T>& other) {               \
+    MAGNUM_CONSTEXPR14 Type<T>& operator-=(const Math::Vector<size, T>& other) { \
         Math::Vector<size, T>::operator-=(other);                           \
         return *this;                                                       \
     }                                                                       \
-    Type<T> operator-(const Math::Vector<size, T>& other) const {           \
+    MAGNUM_CONSTEXPR14 Type<T> operator-(const Math::Vector<size, T>& other) const { \
         return Math::Vector<size, T>::operator-(other);                     \
     }                                                                       \
-    Type<T>& operator*=(T number) {                                         \
+    MAGNUM_CONSTEXPR14 Type<T>& operator*=(T number) {                      \
         Math::Vector<size, T>::operator*=(number);                          \
         return *this;                                                       \
     }                                                                       \
-    Type<T> operator*(T number) const {                                     \
+    MAGNUM_CONSTEXPR14 Type<T> operator*(T number) const {                  \
         return Math::Vector<size, T>::operator*(number);                    \
     }                                                                       \
-    Type<T>& operator/=(T number) {                                         \
+    MAGNUM_CONSTEXPR14 Type<T>& operator/=(T number) {                      \
         Math::Vector<size, T>::operator/=(number);                          \
         return *this;                                                       \
     }                                                                       \
-    Type<T> operator/(T number) const {                                     \
+    MAGNUM_CONSTEXPR14 Type<T> operator/(T number) const {                  \
         return Math::Vector<size, T>::operator/(number);                    \
     }                                                                       \
-    Type<T>& operator*=(const Math::Vector<size, T>& other) {               \
+    MAGNUM_CONSTEXPR14 Type<T>& operator*=(const Math::Vector<size, T>& other) { \
         Math::Vector<size, T>::operator*=(other);                           \
         return *this;                                                       \
     }                                                                       \
-    Type<T> operator*(const Math::Vector<size, T>& other) const {           \
+    MAGNUM_CONSTEXPR14 Type<T> operator*(const Math::Vector<size, T>& other) const { \
         return Math::Vector<size, T>::operator*(other);                     \
     }                                                                       \
-    Type<T>& operator/=(const Math::Vector<size, T>& other) {               \
+    MAGNUM_CONSTEXPR14 Type<T>& operator/=(const Math::Vector<size, T>& other) { \
         Math::Vector<size, T>::operator/=(other);                           \
         return *this;                                                       \
     }                                                                       \
-    Type<T> operator/(const Math::Vector<size, T>& other) const {           \
+    MAGNUM_CONSTEXPR14 Type<T> operator/(const Math::Vector<size, T>& other) const { \
         return Math::Vector<size, T>::operator/(other);                     \
     }                                                                       \
                                                                             \
@@ -1344,10 +1344,10 @@ extern template MAGNUM_EXPORT Corrade::Utility::Debug& operator<<(Corrade::Utili
     }
 
 #define MAGNUM_VECTORn_OPERATOR_IMPLEMENTATION(size, Type)                  \
-    template<class T> inline Type<T> operator*(typename std::common_type<T>::type number, const Type<T>& vector) { \
+    template<class T> MAGNUM_CONSTEXPR14 inline Type<T> operator*(typename std::common_type<T>::type number, const Type<T>& vector) { \
         return number*static_cast<const Math::Vector<size, T>&>(vector);    \
     }                                                                       \
-    template<class T> inline Type<T> operator/(typename std::common_type<T>::type number, const Type<T>& vector) { \
+    template<class T> MAGNUM_CONSTEXPR14 inline Type<T> operator/(typename std::common_type<T>::type number, const Type<T>& vector) { \
         return number/static_cast<const Math::Vector<size, T>&>(vector);    \
     }                                                                       \
                                                                             \
@@ -1479,9 +1479,9 @@ template<std::size_t size, class T> inline BitVector<size> Vector<size, T>::oper
 
 template<std::size_t size, class T>
 #ifdef DOXYGEN_GENERATING_OUTPUT
-inline Vector<size, T>
+MAGNUM_CONSTEXPR14 inline Vector<size, T>
 #else
-template<class U> inline typename std::enable_if<std::is_signed<U>::value, Vector<size, T>>::type
+template<class U> MAGNUM_CONSTEXPR14 inline typename std::enable_if<std::is_signed<U>::value, Vector<size, T>>::type
 #endif
 Vector<size, T>::operator-() const {
     Vector<size, T> out;
@@ -1504,7 +1504,7 @@ Vector<size, T>::projectedOntoNormalized(const Vector<size, T>& line) const {
     return line*Math::dot(*this, line);
 }
 
-template<std::size_t size, class T> inline T Vector<size, T>::sum() const {
+template<std::size_t size, class T> MAGNUM_CONSTEXPR14 inline T Vector<size, T>::sum() const {
     T out(_data[0]);
 
     for(std::size_t i = 1; i != size; ++i)
@@ -1513,7 +1513,7 @@ template<std::size_t size, class T> inline T Vector<size, T>::sum() const {
     return out;
 }
 
-template<std::size_t size, class T> inline T Vector<size, T>::product() const {
+template<std::size_t size, class T> MAGNUM_CONSTEXPR14 inline T Vector<size, T>::product() const {
     T out(_data[0]);
 
     for(std::size_t i = 1; i != size; ++i)
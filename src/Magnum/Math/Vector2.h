@@ -47,7 +47,7 @@ perpendicular. @f[
 @see @ref Vector2::perpendicular(),
     @ref dot(const Vector<size, T>&, const Vector<size, T>&)
  */
-template<class T> inline T cross(const Vector2<T>& a, const Vector2<T>& b) {
+template<class T> constexpr T cross(const Vector2<T>& a, const Vector2<T>& b) {
     return a._data[0]*b._data[1] - a._data[1]*b._data[0];
 }
 
@@ -184,7 +184,7 @@ template<class T> class Vector2: public Vector<2, T> {
         MAGNUM_VECTOR_SUBCLASS_IMPLEMENTATION(2, Vector2)
 
     private:
-        template<class U> friend U cross(const Vector2<U>&, const Vector2<U>&);
+        template<class U> friend constexpr U cross(const Vector2<U>&, const Vector2<U>&);
 };
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
@@ -48,7 +48,7 @@ are corners of a triangle in a counterclockwise order,
 gives the direction of its normal.
 @see @ref cross(const Vector2<T>&, const Vector2<T>&), @ref planeEquation()
 */
-template<class T> inline Vector3<T> cross(const Vector3<T>& a, const Vector3<T>& b) {
+template<class T> constexpr Vector3<T> cross(const Vector3<T>& a, const Vector3<T>& b) {
     return {
         a._data[1]*b._data[2] - b._data[1]*a._data[2],
         a._data[2]*b._data[0] - b._data[2]*a._data[0],
@@ -235,7 +235,7 @@ template<class T> class Vector3: public Vector<3, T> {
         MAGNUM_VECTOR_SUBCLASS_IMPLEMENTATION(3, Vector3)
 
     private:
-        template<class U> friend Vector3<U> cross(const Vector3<U>&, const Vector3<U>&);
+        template<class U> friend constexpr Vector3<U> cross(const Vector3<U>&, const Vector3<U>&);
 };
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
@@ -0,0 +1,525 @@
+#ifndef Magnum_Math_Wide_h
+#define Magnum_Math_Wide_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Math::Wide, function @ref Magnum::Math::loadWide(), @ref Magnum::Math::storeWide(), alias @ref Magnum::Math::Wide4f, @ref Magnum::Math::Wide8f, @ref Magnum::Math::Wide4d
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+#include <Corrade/Utility/StlMath.h>
+
+#include "Magnum/Math/BitVector.h"
+#include "Magnum/Math/Tags.h"
+#include "Magnum/Math/TypeTraits.h"
+
+namespace Magnum { namespace Math {
+
+/**
+@brief Wide scalar
+@tparam T       Underlying scalar type
+@tparam width   Count of lanes
+@m_since_latest
+
+A fixed-size pack of @p width scalars on which all operations are done
+lane-wise. Meant to be used as an underlying type of the other math classes in
+order to get structure-of-arrays companions with the same API --- for example,
+a @cpp Vector3<Wide4f> @ce represents four 3D vectors, with all X components
+in one @ref Wide4f, all Y components in another etc. Operations such as
+@ref cross(), @ref dot(), vector addition or matrix multiplication then
+process all four vectors at once, with the per-lane loops being trivially
+vectorizable by the compiler.
+
+@section Math-Wide-usage Usage
+
+Use @ref loadWide() to fill a wide type from a strided view of the usual
+array-of-structures types and @ref storeWide() to scatter the result back:
+
+@snippet MagnumMath.cpp Wide-usage
+
+@section Math-Wide-limitations Limitations
+
+Operations that branch on a value, such as @ref Vector::length(),
+@ref Vector::normalized() or the lexicographic comparisons, aren't available
+for wide types, as a branch would need to be taken differently for each lane.
+Use @ref sqrt(const Wide<T, width>&) together with @ref dot() instead, and the
+lane-wise comparison operators on @ref Wide itself together with
+@ref select() to emulate branches.
+
+Unlike the scalar equality comparison, @ref operator==() on a @ref Wide is
+@cpp true @ce only if all lanes compare equal, which is what makes
+@ref Vector::operator==() and similar work for wide types.
+*/
+template<class T, std::size_t width> class Wide {
+    static_assert(width != 0, "Wide cannot have zero lanes");
+
+    public:
+        typedef T Type;             /**< @brief Underlying scalar type */
+
+        enum: std::size_t {
+            Width = width           /**< Count of lanes */
+        };
+
+        /**
+         * @brief Default constructor
+         *
+         * Equivalent to @ref Wide(ZeroInitT).
+         */
+        constexpr /*implicit*/ Wide() noexcept: _data{} {}
+
+        /** @brief Construct a zero-filled value */
+        constexpr explicit Wide(ZeroInitT) noexcept: _data{} {}
+
+        /** @brief Construct without initializing the contents */
+        explicit Wide(Magnum::NoInitT) noexcept {}
+
+        /**
+         * @brief Construct from per-lane values
+         * @param first     Value for the first lane
+         * @param next      Values for the next lanes
+         */
+        template<class ...U, class V = typename std::enable_if<sizeof...(U)+1 == width, T>::type> constexpr /*implicit*/ Wide(T first, U... next) noexcept: _data{first, next...} {}
+
+        /** @brief Construct with all lanes set to given value */
+        explicit Wide(T value) noexcept {
+            for(std::size_t i = 0; i != width; ++i)
+                _data[i] = value;
+        }
+
+        /**
+         * @brief Raw data
+         *
+         * Contiguous array of all lanes.
+         */
+        T* data() { return _data; }
+        const T* data() const { return _data; } /**< @overload */
+
+        /** @brief Value at given lane */
+        T& operator[](std::size_t lane) { return _data[lane]; }
+        /** @overload */
+        T operator[](std::size_t lane) const { return _data[lane]; }
+
+        /**
+         * @brief Equality comparison
+         *
+         * Returns @cpp true @ce if all lanes are equal, using a fuzzy compare
+         * for floating-point types. Use @ref equal() for a lane-wise
+         * comparison.
+         * @see @ref TypeTraits::equals()
+         */
+        bool operator==(const Wide<T, width>& other) const {
+            for(std::size_t i = 0; i != width; ++i)
+                if(!TypeTraits<T>::equals(_data[i], other._data[i])) return false;
+            return true;
+        }
+
+        /**
+         * @brief Non-equality comparison
+         *
+         * Returns @cpp true @ce if any lane is different. Use
+         * @ref notEqual() for a lane-wise comparison.
+         */
+        bool operator!=(const Wide<T, width>& other) const {
+            return !operator==(other);
+        }
+
+        /** @brief Lane-wise less-than comparison */
+        BitVector<width> operator<(const Wide<T, width>& other) const {
+            BitVector<width> out;
+            for(std::size_t i = 0; i != width; ++i)
+                out.set(i, _data[i] < other._data[i]);
+            return out;
+        }
+
+        /** @brief Lane-wise less-than or equal comparison */
+        BitVector<width> operator<=(const Wide<T, width>& other) const {
+            BitVector<width> out;
+            for(std::size_t i = 0; i != width; ++i)
+                out.set(i, _data[i] <= other._data[i]);
+            return out;
+        }
+
+        /** @brief Lane-wise greater-than or equal comparison */
+        BitVector<width> operator>=(const Wide<T, width>& other) const {
+            BitVector<width> out;
+            for(std::size_t i = 0; i != width; ++i)
+                out.set(i, _data[i] >= other._data[i]);
+            return out;
+        }
+
+        /** @brief Lane-wise greater-than comparison */
+        BitVector<width> operator>(const Wide<T, width>& other) const {
+            BitVector<width> out;
+            for(std::size_t i = 0; i != width; ++i)
+                out.set(i, _data[i] > other._data[i]);
+            return out;
+        }
+
+        /** @brief Promotion */
+        Wide<T, width> operator+() const { return *this; }
+
+        /** @brief Negated value */
+        Wide<T, width> operator-() const {
+            Wide<T, width> out{Magnum::NoInit};
+            for(std::size_t i = 0; i != width; ++i)
+                out._data[i] = -_data[i];
+            return out;
+        }
+
+        /** @brief Add and assign a value lane-wise */
+        Wide<T, width>& operator+=(const Wide<T, width>& other) {
+            for(std::size_t i = 0; i != width; ++i)
+                _data[i] += other._data[i];
+            return *this;
+        }
+
+        /** @brief Add a value lane-wise */
+        Wide<T, width> operator+(const Wide<T, width>& other) const {
+            return Wide<T, width>{*this} += other;
+        }
+
+        /** @brief Subtract and assign a value lane-wise */
+        Wide<T, width>& operator-=(const Wide<T, width>& other) {
+            for(std::size_t i = 0; i != width; ++i)
+                _data[i] -= other._data[i];
+            return *this;
+        }
+
+        /** @brief Subtract a value lane-wise */
+        Wide<T, width> operator-(const Wide<T, width>& other) const {
+            return Wide<T, width>{*this} -= other;
+        }
+
+        /** @brief Multiply and assign a value lane-wise */
+        Wide<T, width>& operator*=(const Wide<T, width>& other) {
+            for(std::size_t i = 0; i != width; ++i)
+                _data[i] *= other._data[i];
+            return *this;
+        }
+
+        /** @brief Multiply with a value lane-wise */
+        Wide<T, width> operator*(const Wide<T, width>& other) const {
+            return Wide<T, width>{*this} *= other;
+        }
+
+        /** @brief Multiply all lanes with a scalar and assign */
+        Wide<T, width>& operator*=(T scalar) {
+            for(std::size_t i = 0; i != width; ++i)
+                _data[i] *= scalar;
+            return *this;
+        }
+
+        /** @brief Multiply all lanes with a scalar */
+        Wide<T, width> operator*(T scalar) const {
+            return Wide<T, width>{*this} *= scalar;
+        }
+
+        /** @brief Divide and assign a value lane-wise */
+        Wide<T, width>& operator/=(const Wide<T, width>& other) {
+            for(std::size_t i = 0; i != width; ++i)
+                _data[i] /= other._data[i];
+            return *this;
+        }
+
+        /** @brief Divide with a value lane-wise */
+        Wide<T, width> operator/(const Wide<T, width>& other) const {
+            return Wide<T, width>{*this} /= other;
+        }
+
+        /** @brief Divide all lanes with a scalar and assign */
+        Wide<T, width>& operator/=(T scalar) {
+            for(std::size_t i = 0; i != width; ++i)
+                _data[i] /= scalar;
+            return *this;
+        }
+
+        /** @brief Divide all lanes with a scalar */
+        Wide<T, width> operator/(T scalar) const {
+            return Wide<T, width>{*this} /= scalar;
+        }
+
+        /** @brief Sum of all lanes */
+        T sum() const {
+            T out(_data[0]);
+            for(std::size_t i = 1; i != width; ++i)
+                out += _data[i];
+            return out;
+        }
+
+    private:
+        T _data[width];
+};
+
+/**
+@brief Four-lane float wide scalar
+@m_since_latest
+
+Matches the width of SSE and NEON registers.
+*/
+typedef Wide<Float, 4> Wide4f;
+
+/**
+@brief Eight-lane float wide scalar
+@m_since_latest
+
+Matches the width of AVX registers.
+*/
+typedef Wide<Float, 8> Wide8f;
+
+/**
+@brief Four-lane double wide scalar
+@m_since_latest
+
+Matches the width of AVX registers.
+*/
+typedef Wide<Double, 4> Wide4d;
+
+/** @relates Wide
+@brief Multiply a scalar with all lanes
+@m_since_latest
+*/
+template<class T, std::size_t width> inline Wide<T, width> operator*(T scalar, const Wide<T, width>& value) {
+    return value*scalar;
+}
+
+/** @relates Wide
+@brief Divide a scalar with all lanes
+@m_since_latest
+*/
+template<class T, std::size_t width> inline Wide<T, width> operator/(T scalar, const Wide<T, width>& value) {
+    Wide<T, width> out{Magnum::NoInit};
+    for(std::size_t i = 0; i != width; ++i)
+        out[i] = scalar/value[i];
+    return out;
+}
+
+/** @relatesalso Wide
+@brief Lane-wise equality comparison
+@m_since_latest
+
+Uses a fuzzy compare for floating-point types.
+*/
+template<class T, std::size_t width> inline BitVector<width> equal(const Wide<T, width>& a, const Wide<T, width>& b) {
+    BitVector<width> out;
+    for(std::size_t i = 0; i != width; ++i)
+        out.set(i, TypeTraits<T>::equals(a[i], b[i]));
+    return out;
+}
+
+/** @relatesalso Wide
+@brief Lane-wise non-equality comparison
+@m_since_latest
+
+Uses a fuzzy compare for floating-point types.
+*/
+template<class T, std::size_t width> inline BitVector<width> notEqual(const Wide<T, width>& a, const Wide<T, width>& b) {
+    BitVector<width> out;
+    for(std::size_t i = 0; i != width; ++i)
+        out.set(i, !TypeTraits<T>::equals(a[i], b[i]));
+    return out;
+}
+
+/** @relatesalso Wide
+@brief Lane-wise minimum
+@m_since_latest
+*/
+template<class T, std::size_t width> inline Wide<T, width> min(const Wide<T, width>& value, const Wide<T, width>& min) {
+    Wide<T, width> out{Magnum::NoInit};
+    for(std::size_t i = 0; i != width; ++i)
+        out[i] = min[i] < value[i] ? min[i] : value[i];
+    return out;
+}
+
+/** @relatesalso Wide
+@brief Lane-wise maximum
+@m_since_latest
+*/
+template<class T, std::size_t width> inline Wide<T, width> max(const Wide<T, width>& value, const Wide<T, width>& max) {
+    Wide<T, width> out{Magnum::NoInit};
+    for(std::size_t i = 0; i != width; ++i)
+        out[i] = value[i] < max[i] ? max[i] : value[i];
+    return out;
+}
+
+/** @relatesalso Wide
+@brief Lane-wise absolute value
+@m_since_latest
+*/
+template<class T, std::size_t width> inline Wide<T, width> abs(const Wide<T, width>& value) {
+    Wide<T, width> out{Magnum::NoInit};
+    for(std::size_t i = 0; i != width; ++i)
+        out[i] = std::abs(value[i]);
+    return out;
+}
+
+/** @relatesalso Wide
+@brief Lane-wise square root
+@m_since_latest
+*/
+template<class T, std::size_t width> inline Wide<T, width> sqrt(const Wide<T, width>& value) {
+    Wide<T, width> out{Magnum::NoInit};
+    for(std::size_t i = 0; i != width; ++i)
+        out[i] = std::sqrt(value[i]);
+    return out;
+}
+
+/** @relatesalso Wide
+@brief Lane-wise selection
+@m_since_latest
+
+Picks a lane from @p a if the corresponding bit in @p mask is set and from
+@p b otherwise. Useful together with the lane-wise comparison operators to
+emulate branches:
+
+@snippet MagnumMath.cpp Wide-select
+*/
+template<class T, std::size_t width> inline Wide<T, width> select(const BitVector<width>& mask, const Wide<T, width>& a, const Wide<T, width>& b) {
+    Wide<T, width> out{Magnum::NoInit};
+    for(std::size_t i = 0; i != width; ++i)
+        out[i] = mask[i] ? a[i] : b[i];
+    return out;
+}
+
+/**
+@brief Load a wide type from a strided view
+@tparam width   Count of lanes
+@m_since_latest
+
+Converts up to @p width items of given type into a structure-of-arrays
+representation with @ref Wide as the underlying type, lane @cpp i @ce
+containing the @cpp i @ce-th item. Lanes past the end of @p src are
+zero-initialized. Expects that @p src has at most @p width items. Works with
+all single-parameter math types such as @ref Vector3, @ref Matrix4 or
+@ref Quaternion, the view can be arbitrarily strided.
+@see @ref storeWide()
+*/
+template<std::size_t width, template<class> class Type, class T> Type<Wide<T, width>> loadWide(const Corrade::Containers::StridedArrayView1D<const Type<T>>& src) {
+    static_assert(sizeof(Type<Wide<T, width>>) == sizeof(Type<T>)*width,
+        "unexpected layout of the wide type");
+    CORRADE_ASSERT(src.size() <= width,
+        "Math::loadWide(): expected at most" << width << "items but got" << src.size(), {});
+
+    Type<Wide<T, width>> out{ZeroInit};
+    Wide<T, width>* const outData = reinterpret_cast<Wide<T, width>*>(&out);
+    for(std::size_t i = 0; i != src.size(); ++i) {
+        const T* const in = reinterpret_cast<const T*>(&src[i]);
+        for(std::size_t j = 0; j != sizeof(Type<T>)/sizeof(T); ++j)
+            outData[j][i] = in[j];
+    }
+
+    return out;
+}
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+template<std::size_t width, template<class> class Type, class T> Type<Wide<T, width>> loadWide(const Corrade::Containers::StridedArrayView1D<Type<T>>& src) {
+    return loadWide<width, Type, T>(Corrade::Containers::StridedArrayView1D<const Type<T>>{src});
+}
+
+/**
+@brief Load a wide scalar from a strided view
+@tparam width   Count of lanes
+@m_since_latest
+
+Scalar counterpart to the above, lane @cpp i @ce containing the
+@cpp i @ce-th item. Lanes past the end of @p src are zero-initialized. Expects
+that @p src has at most @p width items.
+*/
+template<std::size_t width, class T> typename std::enable_if<IsScalar<T>::value, Wide<T, width>>::type loadWide(const Corrade::Containers::StridedArrayView1D<const T>& src) {
+    CORRADE_ASSERT(src.size() <= width,
+        "Math::loadWide(): expected at most" << width << "items but got" << src.size(), {});
+
+    Wide<T, width> out;
+    for(std::size_t i = 0; i != src.size(); ++i)
+        out[i] = src[i];
+    return out;
+}
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+template<std::size_t width, class T> typename std::enable_if<IsScalar<T>::value, Wide<T, width>>::type loadWide(const Corrade::Containers::StridedArrayView1D<T>& src) {
+    return loadWide<width, T>(Corrade::Containers::StridedArrayView1D<const T>{src});
+}
+
+/**
+@brief Store a wide type to a strided view
+@m_since_latest
+
+Inverse to @ref loadWide(), writes the first @cpp dst.size() @ce lanes of
+@p src to @p dst. Expects that @p dst has at most @p width items.
+*/
+template<template<class> class Type, class T, std::size_t width> void storeWide(const Type<Wide<T, width>>& src, const Corrade::Containers::StridedArrayView1D<Type<T>>& dst) {
+    static_assert(sizeof(Type<Wide<T, width>>) == sizeof(Type<T>)*width,
+        "unexpected layout of the wide type");
+    CORRADE_ASSERT(dst.size() <= width,
+        "Math::storeWide(): expected at most" << width << "items but got" << dst.size(), );
+
+    const Wide<T, width>* const srcData = reinterpret_cast<const Wide<T, width>*>(&src);
+    for(std::size_t i = 0; i != dst.size(); ++i) {
+        T* const out = reinterpret_cast<T*>(&dst[i]);
+        for(std::size_t j = 0; j != sizeof(Type<T>)/sizeof(T); ++j)
+            out[j] = srcData[j][i];
+    }
+}
+
+/**
+@brief Store a wide scalar to a strided view
+@m_since_latest
+
+Scalar counterpart to the above, writes the first @cpp dst.size() @ce lanes of
+@p src to @p dst. Expects that @p dst has at most @p width items.
+*/
+template<class T, std::size_t width> void storeWide(const Wide<T, width>& src, const Corrade::Containers::StridedArrayView1D<T>& dst) {
+    CORRADE_ASSERT(dst.size() <= width,
+        "Math::storeWide(): expected at most" << width << "items but got" << dst.size(), );
+
+    for(std::size_t i = 0; i != dst.size(); ++i)
+        dst[i] = src[i];
+}
+
+#ifndef CORRADE_NO_DEBUG
+/** @debugoperator{Wide} */
+template<class T, std::size_t width> Corrade::Utility::Debug& operator<<(Corrade::Utility::Debug& debug, const Wide<T, width>& value) {
+    const bool packed = debug.immediateFlags() >= Corrade::Utility::Debug::Flag::Packed;
+    debug << (packed ? "{" : "Wide(") << Corrade::Utility::Debug::nospace;
+    for(std::size_t i = 0; i != width; ++i) {
+        if(i != 0) debug << Corrade::Utility::Debug::nospace << ",";
+        debug << value[i];
+    }
+    return debug << Corrade::Utility::Debug::nospace << (packed ? "}" : ")");
+}
+#endif
+
+}}
+
+#endif
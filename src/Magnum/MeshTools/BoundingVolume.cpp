@@ -26,12 +26,16 @@
 
 #include "BoundingVolume.h"
 
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/Pair.h>
 #include <Corrade/Containers/StridedArrayView.h>
 
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Matrix4.h"
 #include "Magnum/Math/Range.h"
 #include "Magnum/Math/Vector3.h"
 #include "Magnum/Math/FunctionsBatch.h"
+#include "Magnum/Trade/ChunkedMeshData.h"
 
 namespace Magnum { namespace MeshTools {
 
@@ -39,6 +43,119 @@ Range3D boundingRange(const Containers::StridedArrayView1D<const Vector3>& point
     return Math::minmax(points);
 }
 
+Range3D boundingRange(const Trade::ChunkedMeshData& mesh, const Matrix4& transformation) {
+    const Containers::ArrayView<const Range3D> chunkBounds = mesh.chunkBounds();
+    if(chunkBounds.isEmpty()) return {};
+
+    Vector3 min{Constants::inf()}, max{-Constants::inf()};
+    for(const Range3D& bounds: chunkBounds) {
+        for(UnsignedInt corner = 0; corner != 8; ++corner) {
+            const Vector3 point = transformation.transformPoint({
+                (corner & 1 ? bounds.max() : bounds.min()).x(),
+                (corner & 2 ? bounds.max() : bounds.min()).y(),
+                (corner & 4 ? bounds.max() : bounds.min()).z()});
+            min = Math::min(min, point);
+            max = Math::max(max, point);
+        }
+    }
+
+    return {min, max};
+}
+
+void boundingRangesInto(const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const UnsignedInt>& offsets, const Containers::StridedArrayView1D<const UnsignedInt>& counts, const Containers::StridedArrayView1D<Range3D>& ranges) {
+    CORRADE_ASSERT(offsets.size() == counts.size() && offsets.size() == ranges.size(),
+        "MeshTools::boundingRangesInto(): expected offset, count and output views to have the same size but got" << offsets.size() << Debug::nospace << "," << counts.size() << "and" << ranges.size(), );
+
+    for(std::size_t i = 0; i != offsets.size(); ++i) {
+        CORRADE_ASSERT(std::size_t{offsets[i]} + counts[i] <= positions.size(),
+            "MeshTools::boundingRangesInto(): sub-range" << i << "of" << counts[i] << "items at offset" << offsets[i] << "out of bounds for" << positions.size() << "elements", );
+        ranges[i] = Math::minmax(positions.slice(offsets[i], offsets[i] + counts[i]));
+    }
+}
+
+namespace {
+
+template<class T> void boundingRangesIntoImplementation(const Containers::StridedArrayView1D<const T>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const UnsignedInt>& offsets, const Containers::StridedArrayView1D<const UnsignedInt>& counts, const Containers::StridedArrayView1D<Range3D>& ranges) {
+    CORRADE_ASSERT(offsets.size() == counts.size() && offsets.size() == ranges.size(),
+        "MeshTools::boundingRangesInto(): expected offset, count and output views to have the same size but got" << offsets.size() << Debug::nospace << "," << counts.size() << "and" << ranges.size(), );
+
+    for(std::size_t i = 0; i != offsets.size(); ++i) {
+        CORRADE_ASSERT(std::size_t{offsets[i]} + counts[i] <= indices.size(),
+            "MeshTools::boundingRangesInto(): sub-range" << i << "of" << counts[i] << "items at offset" << offsets[i] << "out of bounds for" << indices.size() << "indices", );
+
+        if(!counts[i]) {
+            ranges[i] = {};
+            continue;
+        }
+
+        /* Compared to minmax() the positions aren't contiguous so it's not
+           possible to cheaply look up the first non-NaN value upfront.
+           Instead start with an inverted range, which makes the loop
+           branchless as Math::min() and Math::max() skip NaNs in the second
+           argument, and fix up components that didn't get any non-NaN value
+           afterwards. */
+        Vector3 min{Constants::inf()};
+        Vector3 max{-Constants::inf()};
+        for(const T index: indices.slice(offsets[i], offsets[i] + counts[i])) {
+            CORRADE_ASSERT(index < positions.size(),
+                "MeshTools::boundingRangesInto(): index" << index << "out of bounds for" << positions.size() << "elements", );
+            min = Math::min(min, positions[index]);
+            max = Math::max(max, positions[index]);
+        }
+
+        /* Components that were all NaNs, propagate the NaN to match
+           minmax() */
+        for(std::size_t j = 0; j != 3; ++j) if(min[j] > max[j])
+            min[j] = max[j] = Constants::nan();
+
+        ranges[i] = {min, max};
+    }
+}
+
+template<class T> Containers::Array<Range3D> boundingRangesImplementation(const Containers::StridedArrayView1D<const T>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const UnsignedInt>& offsets, const Containers::StridedArrayView1D<const UnsignedInt>& counts) {
+    CORRADE_ASSERT(offsets.size() == counts.size(),
+        "MeshTools::boundingRanges(): expected offset and count views to have the same size but got" << offsets.size() << "and" << counts.size(), {});
+
+    Containers::Array<Range3D> out{NoInit, offsets.size()};
+    boundingRangesIntoImplementation(indices, positions, offsets, counts, out);
+    return out;
+}
+
+}
+
+void boundingRangesInto(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const UnsignedInt>& offsets, const Containers::StridedArrayView1D<const UnsignedInt>& counts, const Containers::StridedArrayView1D<Range3D>& ranges) {
+    boundingRangesIntoImplementation(indices, positions, offsets, counts, ranges);
+}
+
+void boundingRangesInto(const Containers::StridedArrayView1D<const UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const UnsignedInt>& offsets, const Containers::StridedArrayView1D<const UnsignedInt>& counts, const Containers::StridedArrayView1D<Range3D>& ranges) {
+    boundingRangesIntoImplementation(indices, positions, offsets, counts, ranges);
+}
+
+void boundingRangesInto(const Containers::StridedArrayView1D<const UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const UnsignedInt>& offsets, const Containers::StridedArrayView1D<const UnsignedInt>& counts, const Containers::StridedArrayView1D<Range3D>& ranges) {
+    boundingRangesIntoImplementation(indices, positions, offsets, counts, ranges);
+}
+
+Containers::Array<Range3D> boundingRanges(const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const UnsignedInt>& offsets, const Containers::StridedArrayView1D<const UnsignedInt>& counts) {
+    CORRADE_ASSERT(offsets.size() == counts.size(),
+        "MeshTools::boundingRanges(): expected offset and count views to have the same size but got" << offsets.size() << "and" << counts.size(), {});
+
+    Containers::Array<Range3D> out{NoInit, offsets.size()};
+    boundingRangesInto(positions, offsets, counts, out);
+    return out;
+}
+
+Containers::Array<Range3D> boundingRanges(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const UnsignedInt>& offsets, const Containers::StridedArrayView1D<const UnsignedInt>& counts) {
+    return boundingRangesImplementation(indices, positions, offsets, counts);
+}
+
+Containers::Array<Range3D> boundingRanges(const Containers::StridedArrayView1D<const UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const UnsignedInt>& offsets, const Containers::StridedArrayView1D<const UnsignedInt>& counts) {
+    return boundingRangesImplementation(indices, positions, offsets, counts);
+}
+
+Containers::Array<Range3D> boundingRanges(const Containers::StridedArrayView1D<const UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const UnsignedInt>& offsets, const Containers::StridedArrayView1D<const UnsignedInt>& counts) {
+    return boundingRangesImplementation(indices, positions, offsets, counts);
+}
+
 Containers::Pair<Vector3, Float> boundingSphereBouncingBubble(const Containers::StridedArrayView1D<const Vector3>& points) {
     /* See comment about radius below, this is done for consistency */
     if(points.isEmpty()) return {{}, Math::TypeTraits<Float>::epsilon()};
@@ -27,12 +27,15 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::boundingRange(), @ref Magnum::MeshTools::boundingSphereBouncingBubble()
+ * @brief Function @ref Magnum::MeshTools::boundingRange(), @ref Magnum::MeshTools::boundingRangesInto(), @ref Magnum::MeshTools::boundingRanges(), @ref Magnum::MeshTools::boundingSphereBouncingBubble()
  * @m_since_latest
  */
 
+#include <Corrade/Containers/Containers.h>
+
 #include "Magnum/Magnum.h"
 #include "Magnum/MeshTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
 
 namespace Magnum { namespace MeshTools {
 
@@ -49,6 +52,115 @@ Same as @ref Math::minmax(const Corrade::Containers::StridedArrayView1D<const T>
 */
 MAGNUM_MESHTOOLS_EXPORT Range3D boundingRange(const Containers::StridedArrayView1D<const Vector3>& positions);
 
+/**
+@brief Calculate a bounding range of a chunked mesh
+@param mesh             Chunked mesh
+@param transformation   Transformation to apply to the chunk bounds
+@return Bounding range
+@m_since_latest
+
+Calculated from @ref Trade::ChunkedMeshData::chunkBounds() alone, without
+accessing any vertex data. All eight corners of each chunk bound are
+transformed with @p transformation and the result is a union of their bounds,
+which means that for a transformation involving rotation the result is
+conservative, i.e. it contains the actual transformed vertices but may not be
+tight. With an identity transformation it's equal to
+@ref Trade::ChunkedMeshData::bounds(). If there are no chunks, returns a
+default-constructed range.
+@see @ref boundingRange(const Containers::StridedArrayView1D<const Vector3>&),
+    @ref Trade::AbstractImporter::meshChunks()
+*/
+MAGNUM_MESHTOOLS_EXPORT Range3D boundingRange(const Trade::ChunkedMeshData& mesh, const Matrix4& transformation);
+
+/**
+@brief Calculate bounding ranges of multiple sub-ranges into an existing array
+@param[in] positions    Vertex positions
+@param[in] offsets      Offsets of the sub-ranges in @p positions
+@param[in] counts       Sizes of the sub-ranges
+@param[out] ranges      Where to put the calculated bounding ranges
+@m_since_latest
+
+Calculates a bounding range of each @p positions sub-range described by
+corresponding @p offsets and @p counts items, such as a list of submeshes
+sharing a single vertex buffer, in a single call. Each is calculated the same
+way as with @ref boundingRange(), i.e. <em>NaN</em>s are ignored, unless the
+whole sub-range is <em>NaN</em>s, and an empty sub-range results in a
+default-constructed @ref Range3D. The @p offsets, @p counts and @p ranges are
+expected to have the same size and all sub-ranges are expected to be in bounds
+of @p positions.
+@see @ref boundingRanges(), @ref Containers::StridedArrayView::slice(U T::*) const
+*/
+MAGNUM_MESHTOOLS_EXPORT void boundingRangesInto(const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const UnsignedInt>& offsets, const Containers::StridedArrayView1D<const UnsignedInt>& counts, const Containers::StridedArrayView1D<Range3D>& ranges);
+
+/**
+@brief Calculate bounding ranges of multiple indexed sub-ranges into an existing array
+@param[in] indices      Vertex indices
+@param[in] positions    Vertex positions
+@param[in] offsets      Offsets of the sub-ranges in @p indices
+@param[in] counts       Sizes of the sub-ranges
+@param[out] ranges      Where to put the calculated bounding ranges
+@m_since_latest
+
+Like @ref boundingRangesInto(const Containers::StridedArrayView1D<const Vector3>&, const Containers::StridedArrayView1D<const UnsignedInt>&, const Containers::StridedArrayView1D<const UnsignedInt>&, const Containers::StridedArrayView1D<Range3D>&),
+but the sub-ranges describe ranges of @p indices, which then reference
+@p positions. Useful for example for calculating bounds of submeshes sharing a
+single index buffer or of meshlets produced by @ref generateMeshlets(), where
+@p indices is the meshlet vertex array and @p offsets and @p counts are
+@ref Meshlet::vertexOffset and @ref Meshlet::vertexCount:
+
+@snippet MagnumMeshTools.cpp boundingRangesInto-meshlets
+
+Vertices referenced multiple times don't affect the result. The @p offsets,
+@p counts and @p ranges are expected to have the same size, all sub-ranges are
+expected to be in bounds of @p indices and all referenced indices are
+expected to be in bounds of @p positions.
+*/
+MAGNUM_MESHTOOLS_EXPORT void boundingRangesInto(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const UnsignedInt>& offsets, const Containers::StridedArrayView1D<const UnsignedInt>& counts, const Containers::StridedArrayView1D<Range3D>& ranges);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT void boundingRangesInto(const Containers::StridedArrayView1D<const UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const UnsignedInt>& offsets, const Containers::StridedArrayView1D<const UnsignedInt>& counts, const Containers::StridedArrayView1D<Range3D>& ranges);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT void boundingRangesInto(const Containers::StridedArrayView1D<const UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const UnsignedInt>& offsets, const Containers::StridedArrayView1D<const UnsignedInt>& counts, const Containers::StridedArrayView1D<Range3D>& ranges);
+
+/**
+@brief Calculate bounding ranges of multiple sub-ranges
+@m_since_latest
+
+Allocates an array of the same size as @p offsets and calls
+@ref boundingRangesInto(const Containers::StridedArrayView1D<const Vector3>&, const Containers::StridedArrayView1D<const UnsignedInt>&, const Containers::StridedArrayView1D<const UnsignedInt>&, const Containers::StridedArrayView1D<Range3D>&)
+on it. The @p offsets and @p counts are expected to have the same size.
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<Range3D> boundingRanges(const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const UnsignedInt>& offsets, const Containers::StridedArrayView1D<const UnsignedInt>& counts);
+
+/**
+@brief Calculate bounding ranges of multiple indexed sub-ranges
+@m_since_latest
+
+Allocates an array of the same size as @p offsets and calls
+@ref boundingRangesInto(const Containers::StridedArrayView1D<const UnsignedInt>&, const Containers::StridedArrayView1D<const Vector3>&, const Containers::StridedArrayView1D<const UnsignedInt>&, const Containers::StridedArrayView1D<const UnsignedInt>&, const Containers::StridedArrayView1D<Range3D>&)
+on it. The @p offsets and @p counts are expected to have the same size.
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<Range3D> boundingRanges(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const UnsignedInt>& offsets, const Containers::StridedArrayView1D<const UnsignedInt>& counts);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<Range3D> boundingRanges(const Containers::StridedArrayView1D<const UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const UnsignedInt>& offsets, const Containers::StridedArrayView1D<const UnsignedInt>& counts);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<Range3D> boundingRanges(const Containers::StridedArrayView1D<const UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const UnsignedInt>& offsets, const Containers::StridedArrayView1D<const UnsignedInt>& counts);
+
 /**
 @brief Calculate an approximate bounding sphere using the Bouncing Bubble
     algorithm
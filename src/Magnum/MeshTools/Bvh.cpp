@@ -0,0 +1,655 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Bvh.h"
+
+#include <algorithm>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/ProfileScope.h"
+#include "Magnum/Implementation/parallelFor.h"
+#include "Magnum/Math/Frustum.h"
+#include "Magnum/Math/FunctionsBatch.h"
+#include "Magnum/Math/Intersection.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Bins of the surface area heuristic, per axis */
+constexpr UnsignedInt BinCount = 16;
+
+/* Nodes with at most this many triangles become leaves if the heuristic
+   doesn't find a cheaper split */
+constexpr std::size_t MaxLeafSize = 8;
+
+/* Below this depth the nodes are split in the middle instead of with the
+   heuristic. Each such split halves the triangle count, so the depth never
+   exceeds SahMaxDepth + 32 and the traversal can use a fixed-size stack. */
+constexpr UnsignedInt SahMaxDepth = 32;
+constexpr UnsignedInt MaxDepth = 64;
+
+/* Top levels of the tree are split on a single thread until the nodes are
+   smaller than this or there's enough of them to keep all threads busy. The
+   limits don't depend on the thread count in order to make the resulting tree
+   always the same. */
+constexpr std::size_t MinTrianglesPerTask = 16384;
+constexpr std::size_t MaxTaskCount = 64;
+
+/* Per-triangle and per-node work is done in blocks of this size so small
+   meshes stay on a single thread */
+constexpr std::size_t BlockSize = 16384;
+
+inline Range3D emptyRange() {
+    return {Vector3{Constants::inf()}, Vector3{-Constants::inf()}};
+}
+
+inline void extend(Range3D& range, const Range3D& other) {
+    range.min() = Math::min(range.min(), other.min());
+    range.max() = Math::max(range.max(), other.max());
+}
+
+inline void extend(Range3D& range, const Vector3& point) {
+    range.min() = Math::min(range.min(), point);
+    range.max() = Math::max(range.max(), point);
+}
+
+inline Float halfArea(const Range3D& range) {
+    const Vector3 size = range.size();
+    return size.x()*size.y() + size.y()*size.z() + size.z()*size.x();
+}
+
+template<class F> void parallelForBlocks(const std::size_t count, const UnsignedInt threadCount, const F& f) {
+    const std::size_t blockCount = (count + BlockSize - 1)/BlockSize;
+    Magnum::Implementation::parallelFor(blockCount, threadCount, [&](const std::size_t begin, const std::size_t end) {
+        f(begin*BlockSize, Math::min(end*BlockSize, count));
+    });
+}
+
+struct BuildState {
+    Containers::ArrayView<const Range3D> triangleBounds;
+    Containers::ArrayView<const Vector3> centroids;
+    Containers::ArrayView<UnsignedInt> ids;
+};
+
+/* A range of BuildState::ids to be turned into a subtree rooted at node */
+struct Task {
+    UnsignedInt node;
+    UnsignedInt depth;
+    std::size_t begin;
+    std::size_t end;
+};
+
+Range3D rangeBounds(const BuildState& state, const std::size_t begin, const std::size_t end) {
+    Range3D out = emptyRange();
+    for(std::size_t i = begin; i != end; ++i)
+        extend(out, state.triangleBounds[state.ids[i]]);
+    return out;
+}
+
+inline UnsignedInt binIndex(const Float centroid, const Float min, const Float scale) {
+    return Math::min(UnsignedInt((centroid - min)*scale), BinCount - 1);
+}
+
+std::size_t splitMiddle(const BuildState& state, const std::size_t begin, const std::size_t end, const UnsignedInt axis) {
+    const std::size_t middle = begin + (end - begin)/2;
+    std::nth_element(state.ids.data() + begin, state.ids.data() + middle, state.ids.data() + end, [&](const UnsignedInt a, const UnsignedInt b) {
+        return state.centroids[a][axis] < state.centroids[b][axis];
+    });
+    return middle;
+}
+
+/* Reorders the ids in given range and returns the split position, or begin if
+   the range should become a leaf */
+std::size_t split(const BuildState& state, const std::size_t begin, const std::size_t end, const Range3D& bounds, const UnsignedInt depth) {
+    const std::size_t count = end - begin;
+    if(count == 1) return begin;
+
+    Range3D centroidBounds = emptyRange();
+    for(std::size_t i = begin; i != end; ++i)
+        extend(centroidBounds, state.centroids[state.ids[i]]);
+    const Vector3 centroidSize = centroidBounds.size();
+    const UnsignedInt longestAxis =
+        centroidSize.x() >= centroidSize.y() && centroidSize.x() >= centroidSize.z() ? 0 :
+        centroidSize.y() >= centroidSize.z() ? 1 : 2;
+
+    /* All centroids at the same position, the triangles can be only split
+       arbitrarily */
+    if(!(centroidSize[longestAxis] > 0.0f)) {
+        if(count <= MaxLeafSize) return begin;
+        return begin + count/2;
+    }
+
+    if(depth >= SahMaxDepth) {
+        if(count <= MaxLeafSize) return begin;
+        return splitMiddle(state, begin, end, longestAxis);
+    }
+
+    /* Flat bounds would make all costs infinite, in which case just the
+       triangle counts decide */
+    const Float parentArea = halfArea(bounds);
+    const Float inverseParentArea = parentArea > 0.0f ? 1.0f/parentArea : 0.0f;
+
+    /* The cost of a leaf is its triangle count, the cost of a split one
+       traversal step plus triangle counts weighted by the probability of
+       hitting each child */
+    Float bestCost = Float(count);
+    UnsignedInt bestAxis = ~UnsignedInt{};
+    UnsignedInt bestBin{};
+    for(UnsignedInt axis = 0; axis != 3; ++axis) {
+        if(!(centroidSize[axis] > 0.0f)) continue;
+
+        const Float min = centroidBounds.min()[axis];
+        const Float scale = BinCount/centroidSize[axis];
+        Range3D binBounds[BinCount];
+        std::size_t binCounts[BinCount]{};
+        for(Range3D& i: binBounds) i = emptyRange();
+        for(std::size_t i = begin; i != end; ++i) {
+            const UnsignedInt id = state.ids[i];
+            const UnsignedInt bin = binIndex(state.centroids[id][axis], min, scale);
+            ++binCounts[bin];
+            extend(binBounds[bin], state.triangleBounds[id]);
+        }
+
+        /* Cost of everything right of a split before given bin */
+        Float rightCosts[BinCount];
+        Range3D right = emptyRange();
+        std::size_t rightCount = 0;
+        for(UnsignedInt bin = BinCount - 1; bin != 0; --bin) {
+            if(binCounts[bin]) {
+                extend(right, binBounds[bin]);
+                rightCount += binCounts[bin];
+            }
+            rightCosts[bin] = rightCount ? halfArea(right)*rightCount : 0.0f;
+        }
+
+        Range3D left = emptyRange();
+        std::size_t leftCount = 0;
+        for(UnsignedInt bin = 1; bin != BinCount; ++bin) {
+            if(binCounts[bin - 1]) {
+                extend(left, binBounds[bin - 1]);
+                leftCount += binCounts[bin - 1];
+            }
+            if(!leftCount || leftCount == count) continue;
+
+            const Float cost = 1.0f + (halfArea(left)*leftCount + rightCosts[bin])*inverseParentArea;
+            if(cost < bestCost) {
+                bestCost = cost;
+                bestAxis = axis;
+                bestBin = bin;
+            }
+        }
+    }
+
+    if(bestAxis == ~UnsignedInt{}) {
+        if(count <= MaxLeafSize) return begin;
+        return splitMiddle(state, begin, end, longestAxis);
+    }
+
+    /* The bin assignment is the same as above, so both sides are guaranteed
+       to be non-empty */
+    const Float min = centroidBounds.min()[bestAxis];
+    const Float scale = BinCount/centroidSize[bestAxis];
+    return std::partition(state.ids.data() + begin, state.ids.data() + end, [&](const UnsignedInt id) {
+        return binIndex(state.centroids[id][bestAxis], min, scale) < bestBin;
+    }) - state.ids.data();
+}
+
+/* Builds a subtree into a standalone node array with the root at index 0 and
+   children at indices relative to it */
+void buildSubtree(const BuildState& state, const Task& root, const Range3D& bounds, Containers::Array<Bvh::Node>& nodes) {
+    arrayAppend(nodes, Bvh::Node{bounds, 0, 0});
+    Containers::Array<Task> stack;
+    arrayAppend(stack, Task{0, root.depth, root.begin, root.end});
+    while(!stack.isEmpty()) {
+        const Task task = stack.back();
+        arrayRemoveSuffix(stack, 1);
+
+        const std::size_t middle = split(state, task.begin, task.end, nodes[task.node].bounds, task.depth);
+        if(middle == task.begin) {
+            nodes[task.node].offset = task.begin;
+            nodes[task.node].count = task.end - task.begin;
+            continue;
+        }
+
+        const UnsignedInt child = nodes.size();
+        nodes[task.node].offset = child;
+        arrayAppend(nodes, Bvh::Node{rangeBounds(state, task.begin, middle), 0, 0});
+        arrayAppend(nodes, Bvh::Node{rangeBounds(state, middle, task.end), 0, 0});
+        arrayAppend(stack, Task{child, task.depth + 1, task.begin, middle});
+        arrayAppend(stack, Task{child + 1, task.depth + 1, middle, task.end});
+    }
+}
+
+/* Two-sided Möller–Trumbore */
+inline bool rayTriangle(const Vector3& origin, const Vector3& direction, const Vector3& a, const Vector3& b, const Vector3& c, Float& distance, Vector2& barycentric) {
+    const Vector3 ab = b - a;
+    const Vector3 ac = c - a;
+    const Vector3 p = Math::cross(direction, ac);
+    const Float determinant = Math::dot(ab, p);
+    if(determinant == 0.0f) return false;
+
+    const Float inverseDeterminant = 1.0f/determinant;
+    const Vector3 t = origin - a;
+    const Float u = Math::dot(t, p)*inverseDeterminant;
+    if(u < 0.0f || u > 1.0f) return false;
+
+    const Vector3 q = Math::cross(t, ab);
+    const Float v = Math::dot(direction, q)*inverseDeterminant;
+    if(v < 0.0f || u + v > 1.0f) return false;
+
+    distance = Math::dot(ac, q)*inverseDeterminant;
+    barycentric = {u, v};
+    return true;
+}
+
+/* Slab test, returns the entry distance clamped to zero */
+inline bool rayRange(const Vector3& origin, const Vector3& inverseDirection, const Range3D& range, const Float maxDistance, Float& distance) {
+    const Vector3 t0 = (range.min() - origin)*inverseDirection;
+    const Vector3 t1 = (range.max() - origin)*inverseDirection;
+    const Float tNear = Math::max(Math::min(t0, t1).max(), 0.0f);
+    const Float tFar = Math::min(Math::max(t0, t1).min(), maxDistance);
+    distance = tNear;
+    return tNear <= tFar;
+}
+
+inline Float rangePointDistanceSquared(const Range3D& range, const Vector3& point) {
+    return (Math::max(range.min() - point, Vector3{0.0f}) +
+            Math::max(point - range.max(), Vector3{0.0f})).dot();
+}
+
+/* From Real-Time Collision Detection by Christer Ericson, section 5.1.5 */
+Vector3 closestPointOnTriangle(const Vector3& p, const Vector3& a, const Vector3& b, const Vector3& c) {
+    const Vector3 ab = b - a;
+    const Vector3 ac = c - a;
+    const Vector3 ap = p - a;
+    const Float d1 = Math::dot(ab, ap);
+    const Float d2 = Math::dot(ac, ap);
+    if(d1 <= 0.0f && d2 <= 0.0f) return a;
+
+    const Vector3 bp = p - b;
+    const Float d3 = Math::dot(ab, bp);
+    const Float d4 = Math::dot(ac, bp);
+    if(d3 >= 0.0f && d4 <= d3) return b;
+
+    const Float vc = d1*d4 - d3*d2;
+    if(vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+        return a + ab*(d1/(d1 - d3));
+
+    const Vector3 cp = p - c;
+    const Float d5 = Math::dot(ab, cp);
+    const Float d6 = Math::dot(ac, cp);
+    if(d6 >= 0.0f && d5 <= d6) return c;
+
+    const Float vb = d5*d2 - d1*d6;
+    if(vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+        return a + ac*(d2/(d2 - d6));
+
+    const Float va = d3*d6 - d5*d4;
+    if(va <= 0.0f && d4 - d3 >= 0.0f && d5 - d6 >= 0.0f)
+        return b + (c - b)*((d4 - d3)/((d4 - d3) + (d5 - d6)));
+
+    const Float inverseDenominator = 1.0f/(va + vb + vc);
+    return a + ab*(vb*inverseDenominator) + ac*(vc*inverseDenominator);
+}
+
+template<class T> Containers::Array<UnsignedInt> indicesToUnsignedInt(const Containers::StridedArrayView1D<const T>& indices) {
+    Containers::Array<UnsignedInt> out{NoInit, indices.size()};
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        out[i] = indices[i];
+    return out;
+}
+
+Containers::Array<Vector3> copyPositions(const Containers::StridedArrayView1D<const Vector3>& positions) {
+    Containers::Array<Vector3> out{NoInit, positions.size()};
+    Utility::copy(positions, out);
+    return out;
+}
+
+}
+
+Bvh::Bvh(const Trade::MeshData& mesh, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(mesh.primitive() == MeshPrimitive::Triangles,
+        "MeshTools::Bvh: expected a" << MeshPrimitive::Triangles << "mesh but got" << mesh.primitive(), );
+    CORRADE_ASSERT(mesh.hasAttribute(Trade::MeshAttribute::Position),
+        "MeshTools::Bvh: the mesh has no positions", );
+
+    _positions = mesh.positions3DAsArray();
+
+    Containers::Array<UnsignedInt> indices;
+    if(mesh.isIndexed()) indices = mesh.indicesAsArray();
+    else {
+        indices = Containers::Array<UnsignedInt>{NoInit, mesh.vertexCount()};
+        for(std::size_t i = 0; i != indices.size(); ++i)
+            indices[i] = i;
+    }
+
+    build(std::move(indices), threadCount);
+}
+
+Bvh::Bvh(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt threadCount): _positions{copyPositions(positions)} {
+    build(indicesToUnsignedInt(indices), threadCount);
+}
+
+Bvh::Bvh(const Containers::StridedArrayView1D<const UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt threadCount): _positions{copyPositions(positions)} {
+    build(indicesToUnsignedInt(indices), threadCount);
+}
+
+Bvh::Bvh(const Containers::StridedArrayView1D<const UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt threadCount): _positions{copyPositions(positions)} {
+    build(indicesToUnsignedInt(indices), threadCount);
+}
+
+Bvh::Bvh(const Containers::StridedArrayView2D<const char>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(indices.isContiguous<1>(),
+        "MeshTools::Bvh: second index view dimension is not contiguous", );
+    _positions = copyPositions(positions);
+    if(indices.size()[1] == 4)
+        build(indicesToUnsignedInt(Containers::arrayCast<1, const UnsignedInt>(indices)), threadCount);
+    else if(indices.size()[1] == 2)
+        build(indicesToUnsignedInt(Containers::arrayCast<1, const UnsignedShort>(indices)), threadCount);
+    else {
+        CORRADE_ASSERT(indices.size()[1] == 1,
+            "MeshTools::Bvh: expected index type size 1, 2 or 4 but got" << indices.size()[1], );
+        build(indicesToUnsignedInt(Containers::arrayCast<1, const UnsignedByte>(indices)), threadCount);
+    }
+}
+
+Bvh::Bvh(Bvh&&) noexcept = default;
+
+Bvh::~Bvh() = default;
+
+Bvh& Bvh::operator=(Bvh&&) noexcept = default;
+
+void Bvh::build(Containers::Array<UnsignedInt>&& indices, const UnsignedInt threadCount) {
+    MAGNUM_PROFILE_SCOPE("MeshTools::Bvh");
+
+    CORRADE_ASSERT(indices.size() % 3 == 0,
+        "MeshTools::Bvh: expected index count divisible by 3, got" << indices.size(), );
+    #ifndef CORRADE_NO_ASSERT
+    for(const UnsignedInt index: indices)
+        CORRADE_ASSERT(index < _positions.size(),
+            "MeshTools::Bvh: index" << index << "out of bounds for" << _positions.size() << "vertices", );
+    #endif
+
+    const std::size_t triangleCount = indices.size()/3;
+    if(!triangleCount) return;
+
+    /* Per-triangle bounds and centroids */
+    Containers::Array<Range3D> triangleBounds{NoInit, triangleCount};
+    Containers::Array<Vector3> centroids{NoInit, triangleCount};
+    parallelForBlocks(triangleCount, threadCount, [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t i = begin; i != end; ++i) {
+            const Vector3& a = _positions[indices[i*3 + 0]];
+            const Vector3& b = _positions[indices[i*3 + 1]];
+            const Vector3& c = _positions[indices[i*3 + 2]];
+            triangleBounds[i] = {Math::min(Math::min(a, b), c),
+                                 Math::max(Math::max(a, b), c)};
+            centroids[i] = triangleBounds[i].center();
+        }
+    });
+
+    _triangleIds = Containers::Array<UnsignedInt>{NoInit, triangleCount};
+    for(std::size_t i = 0; i != triangleCount; ++i)
+        _triangleIds[i] = i;
+
+    const BuildState state{triangleBounds, centroids, _triangleIds};
+
+    /* Split the top levels breadth-first on a single thread, collecting
+       the nodes that are small enough to become standalone tasks */
+    arrayAppend(_nodes, Node{rangeBounds(state, 0, triangleCount), 0, 0});
+    Containers::Array<Task> queue;
+    arrayAppend(queue, Task{0, 0, 0, triangleCount});
+    Containers::Array<Task> tasks;
+    for(std::size_t i = 0; i != queue.size(); ++i) {
+        const Task task = queue[i];
+        if(task.end - task.begin < MinTrianglesPerTask ||
+           tasks.size() + queue.size() - i >= MaxTaskCount)
+        {
+            arrayAppend(tasks, task);
+            continue;
+        }
+
+        const std::size_t middle = split(state, task.begin, task.end, _nodes[task.node].bounds, task.depth);
+        if(middle == task.begin) {
+            _nodes[task.node].offset = task.begin;
+            _nodes[task.node].count = task.end - task.begin;
+            continue;
+        }
+
+        const UnsignedInt child = _nodes.size();
+        _nodes[task.node].offset = child;
+        arrayAppend(_nodes, Node{rangeBounds(state, task.begin, middle), 0, 0});
+        arrayAppend(_nodes, Node{rangeBounds(state, middle, task.end), 0, 0});
+        arrayAppend(queue, Task{child, task.depth + 1, task.begin, middle});
+        arrayAppend(queue, Task{child + 1, task.depth + 1, middle, task.end});
+    }
+
+    /* Build the subtrees in parallel. Each works on a disjoint range of the
+       triangle IDs. */
+    Containers::Array<Containers::Array<Node>> subtrees{tasks.size()};
+    Magnum::Implementation::parallelFor(tasks.size(), threadCount, [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t i = begin; i != end; ++i)
+            buildSubtree(state, tasks[i], _nodes[tasks[i].node].bounds, subtrees[i]);
+    });
+
+    /* Stitch the subtrees together in task order. The subtree root replaces
+       the placeholder node, the rest gets appended. */
+    for(std::size_t i = 0; i != tasks.size(); ++i) {
+        const UnsignedInt base = _nodes.size() - 1;
+        for(std::size_t j = 0; j != subtrees[i].size(); ++j) {
+            Node node = subtrees[i][j];
+            if(!node.count) node.offset += base;
+            if(j == 0) _nodes[tasks[i].node] = node;
+            else arrayAppend(_nodes, node);
+        }
+    }
+    arrayShrink(_nodes, DefaultInit);
+
+    /* Put the triangle indices in the leaf order for better locality during
+       traversal */
+    _indices = Containers::Array<UnsignedInt>{NoInit, indices.size()};
+    parallelForBlocks(triangleCount, threadCount, [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t i = begin; i != end; ++i) {
+            const UnsignedInt id = _triangleIds[i];
+            _indices[i*3 + 0] = indices[id*3 + 0];
+            _indices[i*3 + 1] = indices[id*3 + 1];
+            _indices[i*3 + 2] = indices[id*3 + 2];
+        }
+    });
+}
+
+Range3D Bvh::bounds() const {
+    return _nodes.isEmpty() ? Range3D{} : _nodes[0].bounds;
+}
+
+Containers::Optional<Bvh::RayHit> Bvh::castRay(const Vector3& origin, const Vector3& direction, const Float maxDistance) const {
+    if(_nodes.isEmpty()) return {};
+
+    const Vector3 inverseDirection = 1.0f/direction;
+    Float nearest = maxDistance;
+    Containers::Optional<RayHit> hit;
+
+    /* The depth is limited during the build, and as only one of the children
+       gets processed right away, the stack never has more than one entry per
+       level */
+    struct Entry {
+        UnsignedInt node;
+        Float distance;
+    } stack[MaxDepth + 1];
+    std::size_t stackSize = 0;
+
+    Float distance;
+    if(rayRange(origin, inverseDirection, _nodes[0].bounds, nearest, distance))
+        stack[stackSize++] = {0, distance};
+
+    while(stackSize) {
+        const Entry entry = stack[--stackSize];
+        /* A closer hit was found since this node got pushed */
+        if(entry.distance > nearest) continue;
+
+        const Node& node = _nodes[entry.node];
+        if(node.count) {
+            for(std::size_t i = node.offset, end = node.offset + node.count; i != end; ++i) {
+                Float triangleDistance;
+                Vector2 barycentric;
+                if(rayTriangle(origin, direction,
+                    _positions[_indices[i*3 + 0]],
+                    _positions[_indices[i*3 + 1]],
+                    _positions[_indices[i*3 + 2]],
+                    triangleDistance, barycentric) &&
+                   triangleDistance >= 0.0f && triangleDistance < nearest)
+                {
+                    nearest = triangleDistance;
+                    hit = RayHit{_triangleIds[i], triangleDistance, barycentric};
+                }
+            }
+            continue;
+        }
+
+        /* Push the farther child first so the nearer one gets processed
+           first */
+        Float distanceA, distanceB;
+        const bool hitA = rayRange(origin, inverseDirection, _nodes[node.offset].bounds, nearest, distanceA);
+        const bool hitB = rayRange(origin, inverseDirection, _nodes[node.offset + 1].bounds, nearest, distanceB);
+        if(hitA && hitB) {
+            if(distanceA <= distanceB) {
+                stack[stackSize++] = {node.offset + 1, distanceB};
+                stack[stackSize++] = {node.offset, distanceA};
+            } else {
+                stack[stackSize++] = {node.offset, distanceA};
+                stack[stackSize++] = {node.offset + 1, distanceB};
+            }
+        } else if(hitA) stack[stackSize++] = {node.offset, distanceA};
+        else if(hitB) stack[stackSize++] = {node.offset + 1, distanceB};
+    }
+
+    return hit;
+}
+
+std::size_t Bvh::querySphere(const Vector3& center, const Float radius, Containers::Array<UnsignedInt>& out) const {
+    if(_nodes.isEmpty()) return 0;
+
+    const std::size_t outSize = out.size();
+    const Float radiusSquared = radius*radius;
+    UnsignedInt stack[MaxDepth + 1];
+    std::size_t stackSize = 0;
+    stack[stackSize++] = 0;
+    while(stackSize) {
+        const Node& node = _nodes[stack[--stackSize]];
+        if(rangePointDistanceSquared(node.bounds, center) > radiusSquared)
+            continue;
+
+        if(!node.count) {
+            stack[stackSize++] = node.offset + 1;
+            stack[stackSize++] = node.offset;
+            continue;
+        }
+
+        for(std::size_t i = node.offset, end = node.offset + node.count; i != end; ++i) {
+            const Vector3 closest = closestPointOnTriangle(center,
+                _positions[_indices[i*3 + 0]],
+                _positions[_indices[i*3 + 1]],
+                _positions[_indices[i*3 + 2]]);
+            if((closest - center).dot() <= radiusSquared)
+                arrayAppend(out, _triangleIds[i]);
+        }
+    }
+
+    return out.size() - outSize;
+}
+
+std::size_t Bvh::queryFrustum(const Frustum& frustum, Containers::Array<UnsignedInt>& out) const {
+    if(_nodes.isEmpty()) return 0;
+
+    const std::size_t outSize = out.size();
+    UnsignedInt stack[MaxDepth + 1];
+    std::size_t stackSize = 0;
+    stack[stackSize++] = 0;
+    while(stackSize) {
+        const Node& node = _nodes[stack[--stackSize]];
+        if(!Math::Intersection::rangeFrustum(node.bounds, frustum))
+            continue;
+
+        if(!node.count) {
+            stack[stackSize++] = node.offset + 1;
+            stack[stackSize++] = node.offset;
+            continue;
+        }
+
+        for(std::size_t i = node.offset, end = node.offset + node.count; i != end; ++i) {
+            const Vector3& a = _positions[_indices[i*3 + 0]];
+            const Vector3& b = _positions[_indices[i*3 + 1]];
+            const Vector3& c = _positions[_indices[i*3 + 2]];
+            bool outside = false;
+            for(const Vector4& plane: frustum) {
+                if(Math::dot(plane.xyz(), a) + plane.w() < 0.0f &&
+                   Math::dot(plane.xyz(), b) + plane.w() < 0.0f &&
+                   Math::dot(plane.xyz(), c) + plane.w() < 0.0f)
+                {
+                    outside = true;
+                    break;
+                }
+            }
+            if(!outside) arrayAppend(out, _triangleIds[i]);
+        }
+    }
+
+    return out.size() - outSize;
+}
+
+void Bvh::refit(const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(positions.size() == _positions.size(),
+        "MeshTools::Bvh::refit(): expected" << _positions.size() << "positions but got" << positions.size(), );
+    Utility::copy(positions, _positions);
+
+    /* Leaves first, they're independent of each other */
+    parallelForBlocks(_nodes.size(), threadCount, [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t i = begin; i != end; ++i) {
+            Node& node = _nodes[i];
+            if(!node.count) continue;
+
+            Range3D bounds = emptyRange();
+            for(std::size_t j = node.offset*3, jEnd = (node.offset + node.count)*3; j != jEnd; ++j)
+                extend(bounds, _positions[_indices[j]]);
+            node.bounds = bounds;
+        }
+    });
+
+    /* Then the inner nodes bottom-up. Children always have a larger index
+       than their parent, so a reverse pass sees them updated already. */
+    for(std::size_t i = _nodes.size(); i != 0; --i) {
+        Node& node = _nodes[i - 1];
+        if(node.count) continue;
+
+        node.bounds = _nodes[node.offset].bounds;
+        extend(node.bounds, _nodes[node.offset + 1].bounds);
+    }
+}
+
+}}
@@ -0,0 +1,267 @@
+#ifndef Magnum_MeshTools_Bvh_h
+#define Magnum_MeshTools_Bvh_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::MeshTools::Bvh
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/MeshTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Bounding volume hierarchy of a triangle mesh
+@m_since_latest
+
+Accelerates ray, sphere and frustum queries on large triangle meshes, such as
+picking a triangle under the cursor. The hierarchy is a binary tree of
+axis-aligned bounding boxes built with a binned surface area heuristic. Its
+top levels are split on a single thread, and the subtrees below them are then
+built in parallel. The resulting tree doesn't depend on the thread count.
+
+@snippet MagnumMeshTools.cpp Bvh
+
+The class keeps its own copy of the index and position data, reordered so
+that triangles of each leaf are next to each other in memory, which means the
+original data don't need to stay in scope. The nodes are 32 bytes each, with
+both children of an inner node next to each other. For deforming meshes that
+keep their topology, @ref refit() recalculates the node bounds for new
+positions without rebuilding the tree, at the cost of the tree getting less
+efficient the more the mesh deforms.
+*/
+class MAGNUM_MESHTOOLS_EXPORT Bvh {
+    public:
+        /**
+         * @brief Tree node
+         *
+         * A leaf if @ref count is non-zero, an inner node otherwise.
+         */
+        struct Node {
+            /** @brief Bounds of all triangles in the subtree */
+            Range3D bounds;
+
+            /**
+             * @brief Offset
+             *
+             * For a leaf it's the offset of its first triangle in
+             * @ref triangleIds(), for an inner node index of its first child
+             * in @ref nodes(), with the second child right after.
+             */
+            UnsignedInt offset;
+
+            /** @brief Triangle count in a leaf or @cpp 0 @ce for inner nodes */
+            UnsignedInt count;
+        };
+
+        /**
+         * @brief Ray hit
+         *
+         * @see @ref castRay()
+         */
+        struct RayHit {
+            /** @brief ID of the hit triangle in the original mesh */
+            UnsignedInt triangle;
+
+            /**
+             * @brief Hit distance
+             *
+             * In multiples of the ray direction length.
+             */
+            Float distance;
+
+            /**
+             * @brief Barycentric coordinates of the hit
+             *
+             * Weights of the second and third triangle vertex, the first
+             * vertex weight is @cpp 1.0f - barycentric.sum() @ce.
+             */
+            Vector2 barycentric;
+        };
+
+        /**
+         * @brief Construct from a mesh
+         * @param mesh          Mesh to build the hierarchy for
+         * @param threadCount   Max count of threads to use. If @cpp 0 @ce,
+         *      @ref TaskScheduler::threadCount() of
+         *      @ref TaskScheduler::global() is used.
+         *
+         * Expects that the mesh is a @ref MeshPrimitive::Triangles and has a
+         * @ref Trade::MeshAttribute::Position. Non-indexed meshes are
+         * treated as having a trivial index buffer.
+         */
+        explicit Bvh(const Trade::MeshData& mesh, UnsignedInt threadCount = 0);
+
+        /**
+         * @brief Construct from an index and position array
+         * @param indices       Triangle indices
+         * @param positions     Vertex positions
+         * @param threadCount   Max count of threads to use. If @cpp 0 @ce,
+         *      @ref TaskScheduler::threadCount() of
+         *      @ref TaskScheduler::global() is used.
+         *
+         * Expects that the @p indices have a size divisible by @cpp 3 @ce and
+         * all are in bounds of @p positions.
+         */
+        explicit Bvh(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt threadCount = 0);
+
+        /** @overload */
+        explicit Bvh(const Containers::StridedArrayView1D<const UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt threadCount = 0);
+
+        /** @overload */
+        explicit Bvh(const Containers::StridedArrayView1D<const UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt threadCount = 0);
+
+        /**
+         * @brief Construct from a type-erased index array
+         *
+         * Expects that the second dimension of @p indices is contiguous and
+         * represents the actual 1/2/4-byte index type. Based on its size then
+         * calls one of the
+         * @ref Bvh(const Containers::StridedArrayView1D<const UnsignedInt>&, const Containers::StridedArrayView1D<const Vector3>&, UnsignedInt)
+         * etc. overloads.
+         */
+        explicit Bvh(const Containers::StridedArrayView2D<const char>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt threadCount = 0);
+
+        /** @brief Copying is not allowed */
+        Bvh(const Bvh&) = delete;
+
+        /** @brief Move constructor */
+        Bvh(Bvh&&) noexcept;
+
+        ~Bvh();
+
+        /** @brief Copying is not allowed */
+        Bvh& operator=(const Bvh&) = delete;
+
+        /** @brief Move assignment */
+        Bvh& operator=(Bvh&&) noexcept;
+
+        /** @brief Triangle count */
+        std::size_t triangleCount() const { return _triangleIds.size(); }
+
+        /** @brief Vertex count */
+        std::size_t vertexCount() const { return _positions.size(); }
+
+        /**
+         * @brief Bounds of the whole mesh
+         *
+         * Default-constructed @ref Range3D if the mesh has no triangles.
+         */
+        Range3D bounds() const;
+
+        /**
+         * @brief Tree nodes
+         *
+         * The first node is the root. Children always have a larger index
+         * than their parent. Empty if the mesh has no triangles.
+         */
+        Containers::ArrayView<const Node> nodes() const { return _nodes; }
+
+        /**
+         * @brief Triangle IDs in the order they're referenced by leaves
+         *
+         * Size is @ref triangleCount().
+         */
+        Containers::ArrayView<const UnsignedInt> triangleIds() const { return _triangleIds; }
+
+        /**
+         * @brief Cast a ray
+         * @param origin        Ray origin
+         * @param direction     Ray direction, doesn't need to be normalized
+         * @param maxDistance   Max hit distance in multiples of @p direction
+         *      length
+         * @return Closest hit or @ref Containers::NullOpt if the ray doesn't
+         *      hit anything within @p maxDistance
+         *
+         * Both front and back faces are hit, degenerate triangles are never
+         * hit.
+         */
+        Containers::Optional<RayHit> castRay(const Vector3& origin, const Vector3& direction, Float maxDistance = Constants::inf()) const;
+
+        /**
+         * @brief Query triangles intersecting a sphere
+         * @param[in] center    Sphere center
+         * @param[in] radius    Sphere radius
+         * @param[out] out      Where to append IDs of triangles in the
+         *      original mesh
+         * @return Count of appended triangle IDs
+         *
+         * Tests the exact distance of each triangle to @p center. The IDs are
+         * appended to @p out in no particular order.
+         */
+        std::size_t querySphere(const Vector3& center, Float radius, Containers::Array<UnsignedInt>& out) const;
+
+        /**
+         * @brief Query triangles intersecting a frustum
+         * @param[in] frustum   Frustum
+         * @param[out] out      Where to append IDs of triangles in the
+         *      original mesh
+         * @return Count of appended triangle IDs
+         *
+         * The test is conservative --- a triangle is rejected only if all its
+         * vertices are outside of the same frustum plane, which means large
+         * triangles near frustum corners may get reported even if they're
+         * outside. The IDs are appended to @p out in no particular order.
+         * @see @ref Math::Intersection::rangeFrustum()
+         */
+        std::size_t queryFrustum(const Frustum& frustum, Containers::Array<UnsignedInt>& out) const;
+
+        /**
+         * @brief Refit the hierarchy to new positions
+         * @param positions     New vertex positions
+         * @param threadCount   Max count of threads to use. If @cpp 0 @ce,
+         *      @ref TaskScheduler::threadCount() of
+         *      @ref TaskScheduler::global() is used.
+         *
+         * Updates the internal position copy and recalculates bounds of all
+         * nodes while keeping the tree structure. Expects that @p positions
+         * have the same size as @ref vertexCount(). The tree structure
+         * gets neither reallocated nor reordered.
+         */
+        void refit(const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt threadCount = 0);
+
+    private:
+        void build(Containers::Array<UnsignedInt>&& indices, UnsignedInt threadCount);
+
+        Containers::Array<Vector3> _positions;
+        /* Triangle vertex indices in the leaf order */
+        Containers::Array<UnsignedInt> _indices;
+        Containers::Array<UnsignedInt> _triangleIds;
+        Containers::Array<Node> _nodes;
+};
+
+}}
+
+#endif
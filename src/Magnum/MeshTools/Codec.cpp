@@ -0,0 +1,335 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Codec.h"
+
+#include <cstring>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* The stream starts with a marker byte, the upper nibble identifies the
+   stream kind and the lower is the index type size for indices and a format
+   version for vertices. It's followed by blocks of up to BlockSize elements,
+   each consisting of one encoded byte plane for each byte of an element. A
+   plane is a header with 2 bits for each group of GroupSize bytes, followed
+   by group payloads with a size given by GroupPayloadSize. */
+constexpr UnsignedByte IndexMarker = 0xe0;
+constexpr UnsignedByte VertexMarker = 0xa1;
+constexpr std::size_t BlockSize = 256;
+constexpr std::size_t GroupSize = 16;
+constexpr std::size_t GroupPayloadSize[]{0, 4, 8, 16};
+
+/* Worst-case size of an encoded plane with all groups stored raw */
+constexpr std::size_t planeBound(const std::size_t size) {
+    return ((size + GroupSize - 1)/GroupSize + 3)/4 + (size + GroupSize - 1)/GroupSize*GroupSize;
+}
+
+std::size_t streamBound(const std::size_t count, const std::size_t planeCount) {
+    return 1 + planeCount*(count/BlockSize*planeBound(BlockSize) + planeBound(count % BlockSize));
+}
+
+inline UnsignedByte zigzag(const UnsignedByte value) {
+    return UnsignedByte(value << 1)^UnsignedByte(0 - (value >> 7));
+}
+
+inline UnsignedByte unzigzag(const UnsignedByte value) {
+    return UnsignedByte(value >> 1)^UnsignedByte(0 - (value & 1));
+}
+
+/* The input has `size` bytes padded with zeros to a multiple of GroupSize,
+   returns a pointer past the written data */
+char* encodePlane(const UnsignedByte* const in, const std::size_t size, char* const out) {
+    const std::size_t groupCount = (size + GroupSize - 1)/GroupSize;
+    const std::size_t headerSize = (groupCount + 3)/4;
+    UnsignedByte* const header = reinterpret_cast<UnsignedByte*>(out);
+    std::memset(header, 0, headerSize);
+
+    UnsignedByte* payload = header + headerSize;
+    for(std::size_t g = 0; g != groupCount; ++g) {
+        const UnsignedByte* const group = in + g*GroupSize;
+
+        /* An OR of all values has the same highest bit as their maximum */
+        UnsignedByte bits = 0;
+        for(std::size_t i = 0; i != GroupSize; ++i) bits |= group[i];
+
+        UnsignedByte mode;
+        if(!bits) {
+            mode = 0;
+        } else if(bits < 4) {
+            mode = 1;
+            for(std::size_t i = 0; i != 4; ++i)
+                payload[i] = UnsignedByte(group[4*i]|group[4*i + 1] << 2|group[4*i + 2] << 4|group[4*i + 3] << 6);
+        } else if(bits < 16) {
+            mode = 2;
+            for(std::size_t i = 0; i != 8; ++i)
+                payload[i] = UnsignedByte(group[2*i]|group[2*i + 1] << 4);
+        } else {
+            mode = 3;
+            std::memcpy(payload, group, GroupSize);
+        }
+
+        header[g/4] |= mode << 2*(g % 4);
+        payload += GroupPayloadSize[mode];
+    }
+
+    return reinterpret_cast<char*>(payload);
+}
+
+/* Decodes `size` bytes into `out`, which has to have space for `size`
+   rounded up to a multiple of GroupSize. Returns nullptr if the data are too
+   short, otherwise a pointer past the consumed data. */
+const char* decodePlane(const char* const in, const char* const end, const std::size_t size, UnsignedByte* const out) {
+    const std::size_t groupCount = (size + GroupSize - 1)/GroupSize;
+    const std::size_t headerSize = (groupCount + 3)/4;
+    if(std::size_t(end - in) < headerSize) return nullptr;
+
+    /* Check bounds for the whole plane upfront so the loop below doesn't need
+       to */
+    const UnsignedByte* const header = reinterpret_cast<const UnsignedByte*>(in);
+    std::size_t payloadSize = 0;
+    for(std::size_t g = 0; g != groupCount; ++g)
+        payloadSize += GroupPayloadSize[(header[g/4] >> 2*(g % 4)) & 3];
+    if(std::size_t(end - in) - headerSize < payloadSize) return nullptr;
+
+    const UnsignedByte* payload = header + headerSize;
+    for(std::size_t g = 0; g != groupCount; ++g) {
+        UnsignedByte* const group = out + g*GroupSize;
+        switch((header[g/4] >> 2*(g % 4)) & 3) {
+            case 0:
+                std::memset(group, 0, GroupSize);
+                break;
+            case 1:
+                for(std::size_t i = 0; i != 4; ++i) {
+                    const UnsignedByte packed = payload[i];
+                    group[4*i] = packed & 0x03;
+                    group[4*i + 1] = (packed >> 2) & 0x03;
+                    group[4*i + 2] = (packed >> 4) & 0x03;
+                    group[4*i + 3] = packed >> 6;
+                }
+                payload += 4;
+                break;
+            case 2:
+                for(std::size_t i = 0; i != 8; ++i) {
+                    const UnsignedByte packed = payload[i];
+                    group[2*i] = packed & 0x0f;
+                    group[2*i + 1] = packed >> 4;
+                }
+                payload += 8;
+                break;
+            case 3:
+                std::memcpy(group, payload, GroupSize);
+                payload += GroupSize;
+                break;
+        }
+    }
+
+    return reinterpret_cast<const char*>(payload);
+}
+
+/* Shrinks the output to the actually written size and turns it into an
+   array with a default deleter */
+Containers::Array<char> finalize(Containers::Array<char>& out, const char* const end) {
+    arrayResize(out, end - out.data());
+    arrayShrink(out, DefaultInit);
+    return std::move(out);
+}
+
+template<class T> Containers::Array<char> encodeIndicesImplementation(const Containers::StridedArrayView1D<const T>& indices) {
+    Containers::Array<char> out;
+    arrayResize(out, NoInit, streamBound(indices.size(), sizeof(T)));
+    out[0] = char(IndexMarker|sizeof(T));
+    char* o = out.data() + 1;
+
+    UnsignedByte planes[sizeof(T)][BlockSize];
+    T previous = 0;
+    for(std::size_t begin = 0; begin < indices.size(); begin += BlockSize) {
+        const std::size_t size = Math::min(BlockSize, indices.size() - begin);
+        for(std::size_t i = 0; i != size; ++i) {
+            const T index = indices[begin + i];
+            const T delta = T(index - previous);
+            const T zigzagged = T(T(delta << 1)^T(0 - (delta >> (sizeof(T)*8 - 1))));
+            for(std::size_t p = 0; p != sizeof(T); ++p)
+                planes[p][i] = UnsignedByte(zigzagged >> 8*p);
+            previous = index;
+        }
+
+        const std::size_t paddedSize = (size + GroupSize - 1)/GroupSize*GroupSize;
+        for(std::size_t p = 0; p != sizeof(T); ++p) {
+            std::memset(planes[p] + size, 0, paddedSize - size);
+            o = encodePlane(planes[p], size, o);
+        }
+    }
+
+    return finalize(out, o);
+}
+
+template<class T> bool decodeIndicesImplementation(const Containers::ArrayView<const char> data, const Containers::StridedArrayView1D<T>& indices) {
+    if(data.isEmpty() || UnsignedByte(data[0]) != (IndexMarker|sizeof(T))) {
+        Error{} << "MeshTools::decodeIndicesInto(): invalid header for" << sizeof(T)*8 << Debug::nospace << "-bit indices";
+        return false;
+    }
+
+    const char* in = data.data() + 1;
+    const char* const end = data.end();
+    UnsignedByte planes[sizeof(T)][BlockSize];
+    T previous = 0;
+    for(std::size_t begin = 0; begin < indices.size(); begin += BlockSize) {
+        const std::size_t size = Math::min(BlockSize, indices.size() - begin);
+        for(std::size_t p = 0; p != sizeof(T); ++p) {
+            if(!(in = decodePlane(in, end, size, planes[p]))) {
+                Error{} << "MeshTools::decodeIndicesInto(): data too short for" << indices.size() << "indices";
+                return false;
+            }
+        }
+
+        for(std::size_t i = 0; i != size; ++i) {
+            T zigzagged = 0;
+            for(std::size_t p = 0; p != sizeof(T); ++p)
+                zigzagged |= T(T(planes[p][i]) << 8*p);
+            previous = T(previous + T(T(zigzagged >> 1)^T(0 - (zigzagged & 1))));
+            indices[begin + i] = previous;
+        }
+    }
+
+    if(in != end) {
+        Error{} << "MeshTools::decodeIndicesInto(): expected" << in - data.data() << "bytes for" << indices.size() << "indices but got" << data.size();
+        return false;
+    }
+
+    return true;
+}
+
+}
+
+Containers::Array<char> encodeIndices(const Containers::StridedArrayView1D<const UnsignedInt>& indices) {
+    return encodeIndicesImplementation(indices);
+}
+
+Containers::Array<char> encodeIndices(const Containers::StridedArrayView1D<const UnsignedShort>& indices) {
+    return encodeIndicesImplementation(indices);
+}
+
+Containers::Array<char> encodeIndices(const Containers::StridedArrayView1D<const UnsignedByte>& indices) {
+    return encodeIndicesImplementation(indices);
+}
+
+bool decodeIndicesInto(const Containers::ArrayView<const char> data, const Containers::StridedArrayView1D<UnsignedInt>& indices) {
+    return decodeIndicesImplementation(data, indices);
+}
+
+bool decodeIndicesInto(const Containers::ArrayView<const char> data, const Containers::StridedArrayView1D<UnsignedShort>& indices) {
+    return decodeIndicesImplementation(data, indices);
+}
+
+bool decodeIndicesInto(const Containers::ArrayView<const char> data, const Containers::StridedArrayView1D<UnsignedByte>& indices) {
+    return decodeIndicesImplementation(data, indices);
+}
+
+Containers::Array<char> encodeVertices(const Containers::StridedArrayView2D<const char>& vertices) {
+    const std::size_t count = vertices.size()[0];
+    const std::size_t vertexSize = vertices.size()[1];
+
+    Containers::Array<char> out;
+    arrayResize(out, NoInit, streamBound(count, vertexSize));
+    out[0] = char(VertexMarker);
+    char* o = out.data() + 1;
+
+    /* Each byte column is a separate plane, delta-encoded against the same
+       byte of the previous vertex, continuing across blocks */
+    Containers::Array<UnsignedByte> previous{ValueInit, vertexSize};
+    UnsignedByte plane[BlockSize];
+    const Containers::StridedArrayView2D<const UnsignedByte> bytes = Containers::arrayCast<const UnsignedByte>(vertices).transposed<0, 1>();
+    for(std::size_t begin = 0; begin < count; begin += BlockSize) {
+        const std::size_t size = Math::min(BlockSize, count - begin);
+        const std::size_t paddedSize = (size + GroupSize - 1)/GroupSize*GroupSize;
+        for(std::size_t k = 0; k != vertexSize; ++k) {
+            const Containers::StridedArrayView1D<const UnsignedByte> column = bytes[k].slice(begin, begin + size);
+            UnsignedByte last = previous[k];
+            for(std::size_t i = 0; i != size; ++i) {
+                plane[i] = zigzag(UnsignedByte(column[i] - last));
+                last = column[i];
+            }
+            previous[k] = last;
+
+            std::memset(plane + size, 0, paddedSize - size);
+            o = encodePlane(plane, size, o);
+        }
+    }
+
+    return finalize(out, o);
+}
+
+bool decodeVerticesInto(const Containers::ArrayView<const char> data, const Containers::StridedArrayView2D<char>& vertices) {
+    if(data.isEmpty() || UnsignedByte(data[0]) != VertexMarker) {
+        Error{} << "MeshTools::decodeVerticesInto(): invalid header";
+        return false;
+    }
+
+    const std::size_t count = vertices.size()[0];
+    const std::size_t vertexSize = vertices.size()[1];
+    const std::ptrdiff_t vertexStride = vertices.stride()[0];
+    const std::ptrdiff_t byteStride = vertices.stride()[1];
+
+    const char* in = data.data() + 1;
+    const char* const end = data.end();
+    Containers::Array<UnsignedByte> previous{ValueInit, vertexSize};
+    UnsignedByte plane[BlockSize];
+    for(std::size_t begin = 0; begin < count; begin += BlockSize) {
+        const std::size_t size = Math::min(BlockSize, count - begin);
+        char* const blockBegin = static_cast<char*>(vertices.data()) + std::ptrdiff_t(begin)*vertexStride;
+        for(std::size_t k = 0; k != vertexSize; ++k) {
+            if(!(in = decodePlane(in, end, size, plane))) {
+                Error{} << "MeshTools::decodeVerticesInto(): data too short for" << count << "vertices of" << vertexSize << "bytes";
+                return false;
+            }
+
+            /* Raw pointer arithmetic instead of a strided view for the
+               innermost loop */
+            char* out = blockBegin + std::ptrdiff_t(k)*byteStride;
+            UnsignedByte last = previous[k];
+            for(std::size_t i = 0; i != size; ++i, out += vertexStride) {
+                last += unzigzag(plane[i]);
+                *out = char(last);
+            }
+            previous[k] = last;
+        }
+    }
+
+    if(in != end) {
+        Error{} << "MeshTools::decodeVerticesInto(): expected" << in - data.data() << "bytes for" << count << "vertices of" << vertexSize << "bytes but got" << data.size();
+        return false;
+    }
+
+    return true;
+}
+
+}}
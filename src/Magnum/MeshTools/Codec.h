@@ -0,0 +1,150 @@
+#ifndef Magnum_MeshTools_Codec_h
+#define Magnum_MeshTools_Codec_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::encodeIndices(), @ref Magnum::MeshTools::decodeIndicesInto(), @ref Magnum::MeshTools::encodeVertices(), @ref Magnum::MeshTools::decodeVerticesInto()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Encode an index buffer
+@m_since_latest
+
+Produces a compact byte stream meant for storage or network delivery, which
+can be decoded back with @ref decodeIndicesInto(). The encoding is lossless
+and consists of the following steps:
+
+1.  Each index is replaced with a difference from the previous index, wrapping
+    around in the index type, which turns indices of a mesh with a good vertex
+    locality, such as after @ref optimizeVertexCacheInPlace(), into small
+    numbers.
+2.  The difference is zigzag-encoded, mapping small negative and positive
+    values to small unsigned values.
+3.  Bytes of the result are split into separate byte planes, processed in
+    blocks of 256 indices. Each plane is then stored in groups of 16 bytes,
+    each group using either 0, 2, 4 or 8 bits per byte based on the largest
+    value in it, with a 2-bit group header. Higher byte planes of small
+    differences thus take just the header.
+
+An optimized triangle mesh with 32-bit indices typically encodes to around
+one byte per index. The output size is however bounded, in the worst case it
+makes the data about 1.6% larger than the input. Pass the output of
+@ref compressIndices() to avoid wasting space on the higher byte planes
+altogether.
+@see @ref encodeVertices()
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<char> encodeIndices(const Containers::StridedArrayView1D<const UnsignedInt>& indices);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<char> encodeIndices(const Containers::StridedArrayView1D<const UnsignedShort>& indices);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<char> encodeIndices(const Containers::StridedArrayView1D<const UnsignedByte>& indices);
+
+/**
+@brief Decode an index buffer
+@m_since_latest
+
+Decodes @p data produced by @ref encodeIndices() into @p indices. The
+@p indices view is expected to have the same size and type as the input that
+was encoded. As the data are commonly coming from an untrusted source, the
+function doesn't assert on invalid input but instead prints a message to
+@relativeref{Magnum,Error} and returns @cpp false @ce if @p data were produced
+from a different index type, are truncated or have trailing bytes. Contents of
+@p indices are unspecified in that case.
+
+The decoding consists of just table-driven unpacking of bit groups and a
+prefix sum, with all bounds checked upfront for each block.
+@see @ref decodeVerticesInto()
+*/
+MAGNUM_MESHTOOLS_EXPORT bool decodeIndicesInto(Containers::ArrayView<const char> data, const Containers::StridedArrayView1D<UnsignedInt>& indices);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT bool decodeIndicesInto(Containers::ArrayView<const char> data, const Containers::StridedArrayView1D<UnsignedShort>& indices);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT bool decodeIndicesInto(Containers::ArrayView<const char> data, const Containers::StridedArrayView1D<UnsignedByte>& indices);
+
+/**
+@brief Encode a vertex buffer
+@m_since_latest
+
+Takes a 2D view where the first dimension is vertices and the second is bytes
+of each vertex, such as the view returned by @ref interleavedData(), and
+produces a compact byte stream that can be decoded back with
+@ref decodeVerticesInto(). The encoding is lossless and works on each byte
+of the vertex separately, in blocks of 256 vertices:
+
+1.  Each byte is replaced with a difference from the same byte of the
+    previous vertex, wrapping around.
+2.  The difference is zigzag-encoded.
+3.  Each byte column of the block forms a byte plane, which is stored in
+    groups of 16 bytes the same way as in @ref encodeIndices().
+
+Since the differences are calculated on bytes and not whole values, the
+encoding works best for quantized attributes, such as the output of
+@ref quantize(), where neighboring vertices often differ only in the lowest
+bits, and on meshes with a good vertex locality, such as after
+@ref optimizeVertexFetchInPlace(). Floating-point attributes compress considerably worse. In
+the worst case the output is about 1.6% larger than the input.
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<char> encodeVertices(const Containers::StridedArrayView2D<const char>& vertices);
+
+/**
+@brief Decode a vertex buffer
+@m_since_latest
+
+Decodes @p data produced by @ref encodeVertices() into @p vertices. The
+@p vertices view is expected to have the same size as the input that was
+encoded. Same as with @ref decodeIndicesInto(), the function prints a message
+to @relativeref{Magnum,Error} and returns @cpp false @ce if @p data are
+invalid, contents of @p vertices are unspecified in that case.
+*/
+MAGNUM_MESHTOOLS_EXPORT bool decodeVerticesInto(Containers::ArrayView<const char> data, const Containers::StridedArrayView2D<char>& vertices);
+
+}}
+
+#endif
@@ -61,10 +61,12 @@ Trade::MeshData combineIndexedImplementation(
         }
     }
 
-    /* Make the combined index array unique */
+    /* Make the combined index array unique. The index tuples are narrow and
+       there's usually a lot of them, for which sorting is faster than
+       hashing. */
     Containers::Array<char> indexData{indexCount*sizeof(UnsignedInt)};
     const auto indexDataI = Containers::arrayCast<UnsignedInt>(indexData);
-    const UnsignedInt vertexCount = removeDuplicatesInPlaceInto(
+    const UnsignedInt vertexCount = removeDuplicatesRadixInPlaceInto(
         Containers::StridedArrayView2D<char>{combinedIndices, {indexCount, indexStride}},
         indexDataI);
 
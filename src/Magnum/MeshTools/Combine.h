@@ -74,7 +74,10 @@ between attributes manually. Similarly, for simplicity the resulting mesh has
 always @ref MeshIndexType::UnsignedInt --- use @ref compressIndices(const Trade::MeshData&, MeshIndexType)
 if you want to have it compressed to a smaller type.
 
-Vertex data unreferenced by the index buffers are discarded. This means the
+The combined index tuples are made unique using
+@ref removeDuplicatesRadixInPlaceInto(), which keeps the unique vertices in
+the order of their first occurrence. Vertex data unreferenced by the index
+buffers are discarded. This means the
 function can be also called with just a single argument to compact a mesh with
 a sparse index buffer.
 
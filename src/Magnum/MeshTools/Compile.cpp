@@ -27,13 +27,20 @@
 
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
 
+#include "Magnum/ProfileScope.h"
 #include "Magnum/GL/Buffer.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
 #include "Magnum/GL/Mesh.h"
+#include "Magnum/GL/MeshView.h"
 #include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/Concatenate.h"
 #include "Magnum/MeshTools/GenerateNormals.h"
 #include "Magnum/MeshTools/Duplicate.h"
 #include "Magnum/MeshTools/Interleave.h"
+#include "Magnum/MeshTools/Reference.h"
 #include "Magnum/Trade/MeshData.h"
 
 #ifdef MAGNUM_BUILD_DEPRECATED
@@ -55,6 +62,8 @@ namespace Magnum { namespace MeshTools {
 namespace {
 
 GL::Mesh compileInternal(const Trade::MeshData& meshData, GL::Buffer&& indices, GL::Buffer&& vertices, const CompileFlags flags) {
+    MAGNUM_PROFILE_SCOPE("MeshTools::compile()");
+
     /* Only this one flag is allowed at this point */
     CORRADE_INTERNAL_ASSERT(!(flags & ~CompileFlag::NoWarnOnCustomAttributes));
     CORRADE_ASSERT((!meshData.isIndexed() || indices.id()) && vertices.id(),
@@ -173,16 +182,150 @@ GL::Mesh compileInternal(const Trade::MeshData& meshData, GL::Buffer&& indices,
 
 GL::Mesh compileInternal(const Trade::MeshData& meshData, const CompileFlags flags) {
     GL::Buffer indices{NoCreate};
-    if(meshData.isIndexed()) {
-        indices = GL::Buffer{GL::Buffer::TargetHint::ElementArray};
-        indices.setData(meshData.indexData());
+    GL::Buffer vertices{NoCreate};
+    {
+        MAGNUM_PROFILE_SCOPE("MeshTools::compile(): buffer upload");
+
+        if(meshData.isIndexed()) {
+            indices = GL::Buffer{GL::Buffer::TargetHint::ElementArray};
+            indices.setData(meshData.indexData());
+        }
+
+        vertices = GL::Buffer{GL::Buffer::TargetHint::Array};
+        vertices.setData(meshData.vertexData());
+    }
+
+    return compileInternal(meshData, std::move(indices), std::move(vertices), flags);
+}
+
+#ifndef MAGNUM_TARGET_WEBGL
+/* Compared to generateFlatNormalsInto() goes through an index buffer instead
+   of requiring the positions to be deindexed first. Each normal is written
+   only once and never read back, as the output is a write-only mapping. */
+template<class T> void generateFlatNormalsIndexedInto(const Containers::StridedArrayView1D<const T>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals) {
+    for(std::size_t i = 0; i + 2 < indices.size(); i += 3) {
+        const Vector3 normal = Math::cross(
+            positions[indices[i + 2]] - positions[indices[i + 1]],
+            positions[indices[i]] - positions[indices[i + 1]]).normalized();
+        normals[i] = normal;
+        normals[i + 1] = normal;
+        normals[i + 2] = normal;
     }
+}
 
+/* Does the same as the allocating path in compile(const Trade::MeshData&,
+   CompileFlags) but writes the interleaved, possibly deindexed vertex data
+   together with the generated normals directly into a mapped buffer. Returns
+   an empty optional if mapping isn't possible, in which case the caller
+   falls back to the allocating path. */
+Containers::Optional<GL::Mesh> compileMapped(const Trade::MeshData& meshData, const Containers::ArrayView<const Trade::MeshAttributeData> extra, const CompileFlags flags) {
+    #ifdef MAGNUM_TARGET_GLES2
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::map_buffer_range>())
+        return {};
+    #endif
+
+    /* Implementation-specific formats are handled (and reported) by the
+       allocating path */
+    if(meshData.isIndexed() && isMeshIndexTypeImplementationSpecific(meshData.indexType()))
+        return {};
+    for(UnsignedInt i = 0; i != meshData.attributeCount(); ++i)
+        if(isVertexFormatImplementationSpecific(meshData.attributeFormat(i)))
+            return {};
+
+    MAGNUM_PROFILE_SCOPE("MeshTools::compile(): mapped buffer upload");
+
+    /* If we want flat normals, the vertices get deindexed, otherwise they're
+       just interleaved together with the normals */
+    const bool deindex = flags & CompileFlag::GenerateFlatNormals && meshData.isIndexed();
+    const UnsignedInt vertexCount = deindex ? meshData.indexCount() : meshData.vertexCount();
+    Containers::Array<Trade::MeshAttributeData> attributeData = Implementation::interleavedLayout(reference(meshData), extra, InterleaveFlag::PreserveInterleavedAttributes);
+    if(!attributeData) return {};
+    const std::size_t size = attributeData[0].stride()*vertexCount;
+    if(!size) return {};
+
+    /* Allocate immutable storage if possible, otherwise just an uninitialized
+       buffer, and map it */
     GL::Buffer vertices{GL::Buffer::TargetHint::Array};
-    vertices.setData(meshData.vertexData());
+    #ifndef MAGNUM_TARGET_GLES
+    if(GL::Context::current().isExtensionSupported<GL::Extensions::ARB::buffer_storage>())
+        vertices.setStorage(size, GL::Buffer::StorageFlag::MapWrite);
+    else
+    #endif
+    {
+        vertices.setData({nullptr, size}, GL::BufferUsage::StaticDraw);
+    }
+    const Containers::ArrayView<char> vertexData = vertices.map(0, size, GL::Buffer::MapFlag::Write|GL::Buffer::MapFlag::InvalidateBuffer);
+    if(!vertexData) return {};
+
+    /* Copy the attributes over. When deindexing, go through the index buffer
+       the same way as duplicate() does. */
+    Containers::Optional<Trade::MeshData> generated;
+    if(deindex) {
+        for(Trade::MeshAttributeData& attribute: attributeData) {
+            attribute = Trade::MeshAttributeData{
+                attribute.name(), attribute.format(),
+                Containers::StridedArrayView1D<void>{vertexData,
+                    vertexData + attribute.offset(vertexData),
+                    vertexCount, attribute.stride()},
+                attribute.arraySize()};
+        }
+        generated.emplace(meshData.primitive(), Trade::DataFlag::Mutable, vertexData, std::move(attributeData));
+        for(UnsignedInt i = 0; i != meshData.attributeCount(); ++i)
+            duplicateInto(meshData.indices(), meshData.attribute(i), generated->mutableAttribute(i));
+    } else {
+        attributeData = interleaveInto(meshData, vertexData, extra);
+        if(!attributeData) return {};
+        const Trade::MeshIndexData indices = meshData.isIndexed() ?
+            Trade::MeshIndexData{meshData.indexType(),
+                Containers::StridedArrayView1D<const void>{
+                    meshData.indexData(),
+                    meshData.indexData().data() + meshData.indexOffset(),
+                    meshData.indexCount(),
+                    meshData.indexStride()}} :
+            Trade::MeshIndexData{};
+        generated.emplace(meshData.primitive(),
+            Trade::DataFlags{}, meshData.indexData(), indices,
+            Trade::DataFlag::Mutable, vertexData, std::move(attributeData),
+            vertexCount);
+    }
 
-    return compileInternal(meshData, std::move(indices), std::move(vertices), flags);
+    /* Generate the normals, reading positions from the original data and not
+       from the mapped memory. If we don't have the index buffer, we can only
+       generate flat ones. */
+    const Containers::StridedArrayView1D<const Vector3> positions = meshData.attribute<Vector3>(Trade::MeshAttribute::Position);
+    const Containers::StridedArrayView1D<Vector3> normals = generated->mutableAttribute<Vector3>(Trade::MeshAttribute::Normal);
+    if(deindex) {
+        const MeshIndexType indexType = meshData.indexType();
+        if(indexType == MeshIndexType::UnsignedInt)
+            generateFlatNormalsIndexedInto(meshData.indices<UnsignedInt>(), positions, normals);
+        else if(indexType == MeshIndexType::UnsignedShort)
+            generateFlatNormalsIndexedInto(meshData.indices<UnsignedShort>(), positions, normals);
+        else if(indexType == MeshIndexType::UnsignedByte)
+            generateFlatNormalsIndexedInto(meshData.indices<UnsignedByte>(), positions, normals);
+        else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+    } else if(flags & CompileFlag::GenerateFlatNormals || !meshData.isIndexed()) {
+        generateFlatNormalsInto(positions, normals);
+    } else {
+        /* Smooth normals need to be accumulated, which can't be done in a
+           write-only mapping, so they're calculated into a temporary and
+           copied over */
+        const Containers::Array<Vector3> smoothNormals = generateSmoothNormals(meshData.indices(), positions);
+        Utility::copy(Containers::stridedArrayView(smoothNormals), normals);
+    }
+
+    /* If the data got corrupted during unmapping, let the caller go through
+       the allocating path instead */
+    if(!vertices.unmap()) return {};
+
+    GL::Buffer indexBuffer{NoCreate};
+    if(generated->isIndexed()) {
+        indexBuffer = GL::Buffer{GL::Buffer::TargetHint::ElementArray};
+        indexBuffer.setData(meshData.indexData());
+    }
+
+    return compileInternal(*generated, std::move(indexBuffer), std::move(vertices), flags & CompileFlag::NoWarnOnCustomAttributes);
 }
+#endif
 
 }
 
@@ -229,6 +372,14 @@ GL::Mesh compile(const Trade::MeshData& meshData, CompileFlags flags) {
         } else CORRADE_ASSERT(meshData.attributeFormat(Trade::MeshAttribute::Normal) == VertexFormat::Vector3,
             "MeshTools::compile(): can't generate normals into" << meshData.attributeFormat(Trade::MeshAttribute::Normal), GL::Mesh{});
 
+        #ifndef MAGNUM_TARGET_WEBGL
+        /* Generate straight into a mapped buffer if requested and possible */
+        if(flags & CompileFlag::MappedBuffers) {
+            if(Containers::Optional<GL::Mesh> mesh = compileMapped(meshData, extra, flags))
+                return std::move(*mesh);
+        }
+        #endif
+
         /* If we want flat normals, we need to first duplicate everything using
            the index buffer. Otherwise just interleave the potential extra
            normal attribute in. */
@@ -249,14 +400,65 @@ GL::Mesh compile(const Trade::MeshData& meshData, CompileFlags flags) {
                 generated.attribute<Vector3>(Trade::MeshAttribute::Position),
                 generated.mutableAttribute<Vector3>(Trade::MeshAttribute::Normal));
 
-        return compile(generated, flags & ~(CompileFlag::GenerateFlatNormals|CompileFlag::GenerateSmoothNormals));
+        return compile(generated, flags & ~(CompileFlag::GenerateFlatNormals|CompileFlag::GenerateSmoothNormals|CompileFlag::MappedBuffers));
     }
 
-    flags &= ~(CompileFlag::GenerateFlatNormals|CompileFlag::GenerateSmoothNormals);
+    flags &= ~(CompileFlag::GenerateFlatNormals|CompileFlag::GenerateSmoothNormals|CompileFlag::MappedBuffers);
     CORRADE_INTERNAL_ASSERT(!(flags & ~CompileFlag::NoWarnOnCustomAttributes));
     return compileInternal(meshData, flags);
 }
 
+Containers::Array<GL::MeshView> compileBatch(GL::Mesh& mesh, const Containers::ArrayView<const Containers::Reference<const Trade::MeshData>> meshes, const CompileFlags flags) {
+    CORRADE_ASSERT(!meshes.isEmpty(),
+        "MeshTools::compileBatch(): no meshes passed", {});
+    CORRADE_ASSERT(!(flags & (CompileFlag::GenerateFlatNormals|CompileFlag::GenerateSmoothNormals)),
+        "MeshTools::compileBatch(): normal generation is not supported", {});
+
+    /* Reserve the output upfront. If any mesh is indexed, non-indexed meshes
+       get a trivial index buffer generated. */
+    bool indexed = false;
+    UnsignedInt indexCount = 0;
+    UnsignedInt vertexCount = 0;
+    for(const Trade::MeshData& meshData: meshes) {
+        indexed = indexed || meshData.isIndexed();
+        indexCount += meshData.isIndexed() ? meshData.indexCount() : meshData.vertexCount();
+        vertexCount += meshData.vertexCount();
+    }
+
+    Concatenator<> concatenator{meshes[0]};
+    concatenator.reserve(indexed ? indexCount : 0, vertexCount, meshes.size());
+    for(const Trade::MeshData& meshData: meshes)
+        concatenator.append(meshData);
+    const Trade::MeshData concatenated = concatenator.finalize();
+
+    mesh = compile(concatenated, flags);
+
+    /* Indices are already adjusted for the vertex offsets, so indexed views
+       only need the index offset. For non-indexed the base vertex is the
+       first vertex to draw. */
+    Containers::Array<GL::MeshView> views{DirectInit, meshes.size(), mesh};
+    for(std::size_t i = 0; i != meshes.size(); ++i) {
+        const Trade::MeshData& meshData = meshes[i];
+        const UnsignedInt vertexOffset = concatenator.vertexOffsets()[i];
+        if(concatenated.isIndexed()) {
+            views[i].setCount(meshData.isIndexed() ? meshData.indexCount() : meshData.vertexCount());
+            if(meshData.vertexCount())
+                views[i].setIndexRange(Int(concatenator.indexOffsets()[i]), vertexOffset, vertexOffset + meshData.vertexCount() - 1);
+            else
+                views[i].setIndexRange(Int(concatenator.indexOffsets()[i]));
+        } else {
+            views[i].setCount(meshData.vertexCount())
+                .setBaseVertex(Int(vertexOffset));
+        }
+    }
+
+    return views;
+}
+
+Containers::Array<GL::MeshView> compileBatch(GL::Mesh& mesh, const std::initializer_list<Containers::Reference<const Trade::MeshData>> meshes, const CompileFlags flags) {
+    return compileBatch(mesh, Containers::arrayView(meshes), flags);
+}
+
 #ifdef MAGNUM_BUILD_DEPRECATED
 CORRADE_IGNORE_DEPRECATED_PUSH
 GL::Mesh compile(const Trade::MeshData2D& meshData) {
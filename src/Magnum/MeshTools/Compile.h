@@ -26,13 +26,16 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::compile()
+ * @brief Function @ref Magnum::MeshTools::compile(), @ref Magnum::MeshTools::compileBatch()
  */
 
 #include "Magnum/configure.h"
 
 #ifdef MAGNUM_TARGET_GL
+#include <initializer_list>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/EnumSet.h>
+#include <Corrade/Containers/Reference.h>
 
 #include "Magnum/Magnum.h"
 #include "Magnum/GL/GL.h"
@@ -81,7 +84,28 @@ enum class CompileFlag: UnsignedByte {
      * this flag to suppress the warning messages.
      * @m_since{2020,06}
      */
-    NoWarnOnCustomAttributes = 1 << 2
+    NoWarnOnCustomAttributes = 1 << 2,
+
+    /**
+     * If @ref CompileFlag::GenerateFlatNormals or
+     * @ref CompileFlag::GenerateSmoothNormals is set and normals are
+     * generated, allocates the vertex buffer first and writes the
+     * interleaved, possibly deindexed vertex data together with the
+     * generated normals directly into its mapped memory, instead of
+     * creating a new @ref Trade::MeshData and then uploading it. This avoids
+     * a temporary copy of the whole vertex data. Smooth normals are still
+     * calculated into a temporary array first, as they need to be
+     * accumulated and the mapped memory is write-only.
+     *
+     * On desktop GL with @gl_extension{ARB,buffer_storage} the buffer is
+     * allocated as immutable with @ref GL::Buffer::setStorage(). The flag
+     * has no effect if normals aren't generated, if mapping isn't possible
+     * (on WebGL or on OpenGL ES 2.0 without @gl_extension{EXT,map_buffer_range})
+     * or if the mapping fails, in which case the data are prepared on the
+     * CPU and uploaded as usual.
+     * @m_since_latest
+     */
+    MappedBuffers = 1 << 3
 };
 
 /**
@@ -136,7 +160,8 @@ modifications, keeping the original layout and vertex formats. If
 interleaved together with the generated normals; if
 @ref CompileFlag::GenerateFlatNormals is requested, the mesh is first
 deindexed and then the vertex data is interleaved together with the generated
-normals.
+normals. With @ref CompileFlag::MappedBuffers, this is done directly in mapped
+GPU memory instead of a temporary CPU-side copy.
 
 The generated mesh owns the index and vertex buffers and there's no possibility
 to access them afterwards. For alternative solutions see the
@@ -206,6 +231,51 @@ MAGNUM_MESHTOOLS_EXPORT GL::Mesh compile(const Trade::MeshData& meshData, GL::Bu
  */
 MAGNUM_MESHTOOLS_EXPORT GL::Mesh compile(const Trade::MeshData& meshData, GL::Buffer&& indices, GL::Buffer&& vertices);
 
+/**
+@brief Compile many meshes into shared buffers
+@param[out] mesh    Mesh to compile into
+@param[in] meshes   Meshes to compile
+@param[in] flags    Compilation flags
+@return Views on @p mesh, one for each mesh in @p meshes
+@m_since_latest
+
+Concatenates @p meshes using a @ref Concatenator, compiles the result into
+@p mesh with a single vertex buffer and at most one index buffer using
+@ref compile(const Trade::MeshData&, CompileFlags), replacing its previous
+contents, and returns a @ref GL::MeshView for each input mesh. Compared to
+compiling each mesh separately, this results in just one vertex array object
+and two buffers instead of one for every mesh, and the returned views can be
+passed directly to
+@ref GL::AbstractShaderProgram::draw(Containers::ArrayView<const Containers::Reference<MeshView>>)
+to draw them all with a single multi-draw call:
+
+@snippet MagnumMeshTools-gl.cpp compileBatch
+
+The attribute layout and primitive is taken from the first mesh, with the same
+rules as in @ref concatenate() --- superfluous attributes of other meshes are
+ignored and missing attributes zeroed out. If any mesh is indexed, the output
+is indexed as well, with a trivial index buffer generated for the non-indexed
+meshes and indices adjusted for vertex offsets of particular meshes, so the
+views don't need a base vertex. The views then have their index range set to
+vertices of given mesh. If no mesh is indexed, the views have their base
+vertex set to the first vertex of given mesh instead.
+
+The returned views reference @p mesh, so it's expected to not be moved or
+destroyed while they're in use. Expects that @p meshes contains at least one
+item. Normal generation isn't supported, so @p flags are expected to not
+contain @ref CompileFlag::GenerateFlatNormals or
+@ref CompileFlag::GenerateSmoothNormals --- deindexing for flat normals would
+make the views not match the original meshes anymore.
+@see @ref Concatenator::indexOffsets(), @ref Concatenator::vertexOffsets()
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<GL::MeshView> compileBatch(GL::Mesh& mesh, Containers::ArrayView<const Containers::Reference<const Trade::MeshData>> meshes, CompileFlags flags = {});
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<GL::MeshView> compileBatch(GL::Mesh& mesh, std::initializer_list<Containers::Reference<const Trade::MeshData>> meshes, CompileFlags flags = {});
+
 #ifdef MAGNUM_BUILD_DEPRECATED
 /**
 @brief Compile 2D mesh data
@@ -0,0 +1,192 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "CompileVk.h"
+
+#include <algorithm>
+#include <Corrade/Containers/GrowableArray.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/VertexFormat.h"
+#include "Magnum/Math/BitVector.h"
+#include "Magnum/Trade/MeshData.h"
+#include "Magnum/Vk/BufferCreateInfo.h"
+#include "Magnum/Vk/Mesh.h"
+#include "Magnum/Vk/MeshLayout.h"
+#include "Magnum/Vk/UploadBatcher.h"
+#include "Magnum/Vk/VertexFormat.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Kept consistent with Shaders/generic.glsl */
+enum: UnsignedInt {
+    PositionLocation = 0,
+    TextureCoordinatesLocation = 1,
+    ColorLocation = 2,
+    TangentLocation = 3,
+    BitangentLocation = 4,
+    ObjectIdLocation = 4,
+    NormalLocation = 5
+};
+
+struct Binding {
+    UnsignedLong offset;
+    UnsignedInt stride;
+};
+
+Vk::Mesh compileVkInternal(const Trade::MeshData& meshData, Vk::Device& device, Vk::MemoryAllocator* const allocator, Vk::UploadBatcher& batcher) {
+    /* If the type is implementation-specific, we have no way to know if it's
+       strided, so just assume it is */
+    CORRADE_ASSERT(!meshData.isIndexed() || isMeshIndexTypeImplementationSpecific(meshData.indexType()) || Short(meshIndexTypeSize(meshData.indexType())) == meshData.indexStride(),
+        "MeshTools::compileVk():" << meshData.indexType() << "with stride of" << meshData.indexStride() << "bytes isn't supported by Vulkan", Vk::Mesh{Vk::MeshLayout{Vk::MeshPrimitive::Points}});
+
+    Vk::MeshLayout layout{meshData.primitive()};
+
+    /* Go through the attributes in order of their offsets, so each binding
+       starts at the lowest offset of the attributes it contains and the
+       relative attribute offsets are never negative */
+    Containers::Array<UnsignedInt> order{NoInit, meshData.attributeCount()};
+    for(UnsignedInt i = 0; i != order.size(); ++i) order[i] = i;
+    std::sort(order.begin(), order.end(), [&meshData](UnsignedInt a, UnsignedInt b) {
+        return meshData.attributeOffset(a) < meshData.attributeOffset(b);
+    });
+
+    /* Ensure each known attribute gets bound only once */
+    Math::BitVector<8> boundAttributes;
+    Containers::Array<Binding> bindings;
+    for(const UnsignedInt i: order) {
+        const Trade::MeshAttribute name = meshData.attributeName(i);
+        UnsignedInt location = ~UnsignedInt{};
+        switch(name) {
+            case Trade::MeshAttribute::Position:
+                location = PositionLocation;
+                break;
+            case Trade::MeshAttribute::TextureCoordinates:
+                location = TextureCoordinatesLocation;
+                break;
+            case Trade::MeshAttribute::Color:
+                location = ColorLocation;
+                break;
+            case Trade::MeshAttribute::Tangent:
+                location = TangentLocation;
+                break;
+            case Trade::MeshAttribute::Bitangent:
+                location = BitangentLocation;
+                break;
+            case Trade::MeshAttribute::Normal:
+                location = NormalLocation;
+                break;
+            case Trade::MeshAttribute::ObjectId:
+                location = ObjectIdLocation;
+                break;
+        }
+
+        if(location == ~UnsignedInt{}) {
+            Warning{} << "MeshTools::compileVk(): ignoring unknown/unsupported attribute" << name;
+            continue;
+        }
+
+        /* Vulkan has no concept of array attributes */
+        if(meshData.attributeArraySize(i)) {
+            Warning{} << "MeshTools::compileVk(): ignoring array attribute" << name;
+            continue;
+        }
+
+        /* Implementation-specific formats are passed through as-is */
+        const VertexFormat format = meshData.attributeFormat(i);
+        if(!Vk::hasVertexFormat(format)) {
+            Warning{} << "MeshTools::compileVk(): ignoring attribute" << name << "with" << format << "that has no Vulkan equivalent";
+            continue;
+        }
+
+        if(boundAttributes[location]) continue;
+        boundAttributes.set(location, true);
+
+        const Int stride = meshData.attributeStride(i);
+        CORRADE_ASSERT(stride > 0,
+            "MeshTools::compileVk():" << name << "stride of" << stride << "bytes isn't supported by Vulkan", Vk::Mesh{Vk::MeshLayout{Vk::MeshPrimitive::Points}});
+
+        /* Put the attribute into an existing binding if it has the same
+           stride and falls into its stride-sized window, otherwise create a
+           new one */
+        const UnsignedLong offset = meshData.attributeOffset(i);
+        UnsignedInt binding = 0;
+        for(; binding != bindings.size(); ++binding)
+            if(bindings[binding].stride == UnsignedInt(stride) && offset - bindings[binding].offset < UnsignedInt(stride))
+                break;
+        if(binding == bindings.size()) {
+            arrayAppend(bindings, Binding{offset, UnsignedInt(stride)});
+            layout.addBinding(binding, stride);
+        }
+
+        layout.addAttribute(location, binding, format, offset - bindings[binding].offset);
+    }
+
+    Vk::Mesh mesh{std::move(layout)};
+    mesh.setCount(meshData.isIndexed() ? meshData.indexCount() : meshData.vertexCount());
+
+    /* Index data go right after vertex data, aligned to four bytes. If there
+       are no indices and no bound attributes, there's nothing to upload. */
+    const UnsignedLong indexOffset = (meshData.vertexData().size() + 3) & ~UnsignedLong{3};
+    const UnsignedLong size = meshData.isIndexed() ?
+        indexOffset + meshData.indexData().size() :
+        (bindings.isEmpty() ? 0 : meshData.vertexData().size());
+    if(!size) return mesh;
+
+    const Vk::BufferCreateInfo info{Vk::BufferUsage::VertexBuffer|Vk::BufferUsage::IndexBuffer|Vk::BufferUsage::TransferDestination, size};
+    Vk::Buffer buffer = allocator ?
+        Vk::Buffer{device, info, *allocator, Vk::MemoryFlag::DeviceLocal} :
+        Vk::Buffer{device, info, Vk::MemoryFlag::DeviceLocal};
+
+    batcher.upload(meshData.vertexData(), buffer);
+    if(meshData.isIndexed())
+        batcher.upload(meshData.indexData(), buffer, indexOffset);
+
+    /* All bindings reference the same buffer, the ownership is transferred
+       either to the index buffer or to the first vertex binding */
+    const VkBuffer handle = buffer;
+    for(UnsignedInt i = meshData.isIndexed() ? 0 : 1; i < bindings.size(); ++i)
+        mesh.addVertexBuffer(i, handle, bindings[i].offset);
+    if(meshData.isIndexed())
+        mesh.setIndexBuffer(std::move(buffer), indexOffset + meshData.indexOffset(), meshData.indexType());
+    else
+        mesh.addVertexBuffer(0, std::move(buffer), bindings[0].offset);
+
+    return mesh;
+}
+
+}
+
+Vk::Mesh compileVk(const Trade::MeshData& meshData, Vk::Device& device, Vk::MemoryAllocator& allocator, Vk::UploadBatcher& batcher) {
+    return compileVkInternal(meshData, device, &allocator, batcher);
+}
+
+Vk::Mesh compileVk(const Trade::MeshData& meshData, Vk::Device& device, Vk::UploadBatcher& batcher) {
+    return compileVkInternal(meshData, device, nullptr, batcher);
+}
+
+}}
@@ -0,0 +1,110 @@
+#ifndef Magnum_MeshTools_CompileVk_h
+#define Magnum_MeshTools_CompileVk_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::compileVk()
+ * @m_since_latest
+ */
+
+#include "Magnum/configure.h"
+
+#ifdef MAGNUM_TARGET_VK
+#include "Magnum/Magnum.h"
+#include "Magnum/Trade/Trade.h"
+#include "Magnum/MeshTools/visibility.h"
+#include "Magnum/Vk/Vk.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Compile Vulkan mesh data
+@param meshData     Mesh data
+@param device       Vulkan device
+@param allocator    Memory allocator to sub-allocate the buffer memory from
+@param batcher      Upload batcher to copy the data through
+@m_since_latest
+
+Creates a single @ref Vk::Buffer with @ref Vk::BufferUsage::VertexBuffer,
+@relativeref{Vk::BufferUsage,IndexBuffer} and
+@relativeref{Vk::BufferUsage,TransferDestination}, backed by
+@ref Vk::MemoryFlag::DeviceLocal memory from @p allocator, and records
+uploads of @ref Trade::MeshData::vertexData() and, if the mesh is indexed,
+@ref Trade::MeshData::indexData() into it through @p batcher. The data are
+copied as-is without any further modifications, keeping the original layout
+and vertex formats, with the index data placed right after the vertex data,
+aligned to four bytes. The returned @ref Vk::Mesh owns the buffer and has a
+@ref Vk::MeshLayout derived from the mesh attributes:
+
+-   Attributes sharing the same stride and falling into the same stride-sized
+    window of the vertex data share a single binding, so a fully interleaved
+    mesh has just one binding, while each attribute of a non-interleaved mesh
+    gets its own binding. All bindings reference the same buffer at different
+    offsets.
+-   Attribute locations match the generic shader attribute definitions used
+    by @ref MeshTools::compile() for OpenGL --- @ref Trade::MeshAttribute::Position
+    is at location @cpp 0 @ce, @ref Trade::MeshAttribute::TextureCoordinates
+    at @cpp 1 @ce, @ref Trade::MeshAttribute::Color at @cpp 2 @ce,
+    @ref Trade::MeshAttribute::Tangent at @cpp 3 @ce,
+    @ref Trade::MeshAttribute::Bitangent and
+    @ref Trade::MeshAttribute::ObjectId at @cpp 4 @ce and
+    @ref Trade::MeshAttribute::Normal at @cpp 5 @ce. If the same location is
+    used by more than one attribute, only the first one is bound.
+-   Vertex formats are mapped using @ref Vk::vertexFormat(), formats that
+    don't have a Vulkan equivalent, array attributes and custom attributes are
+    ignored with a warning. Implementation-specific vertex formats and
+    @ref Magnum::MeshIndexType values are passed as-is.
+-   The index buffer is expected to be contiguous and stride of all
+    attributes is expected to be positive.
+
+The uploads are recorded into the current batch of @p batcher but not
+submitted --- call @ref Vk::UploadBatcher::flush() and wait for the batch to
+finish before the mesh is drawn. Both the vertex and the index data are
+expected to fit into @ref Vk::UploadBatcher::stagingSize().
+
+@snippet MagnumMeshTools-vk.cpp compileVk
+
+@note This function is available only if Magnum is compiled with
+    @ref MAGNUM_TARGET_VK enabled (done by default if the Vk library is
+    built). See @ref building-features for more information.
+*/
+MAGNUM_MESHTOOLS_EXPORT Vk::Mesh compileVk(const Trade::MeshData& meshData, Vk::Device& device, Vk::MemoryAllocator& allocator, Vk::UploadBatcher& batcher);
+
+/**
+@brief Compile Vulkan mesh data with dedicated buffer memory
+@m_since_latest
+
+Compared to @ref compileVk(const Trade::MeshData&, Vk::Device&, Vk::MemoryAllocator&, Vk::UploadBatcher&)
+allocates dedicated @ref Vk::MemoryFlag::DeviceLocal memory for the buffer
+instead of sub-allocating it.
+*/
+MAGNUM_MESHTOOLS_EXPORT Vk::Mesh compileVk(const Trade::MeshData& meshData, Vk::Device& device, Vk::UploadBatcher& batcher);
+
+}}
+#else
+#error this header is available only in the Vulkan build
+#endif
+
+#endif
@@ -30,58 +30,367 @@
 #include <Corrade/Containers/ArrayViewStl.h>
 #include <Corrade/Utility/Algorithms.h>
 
+#include "Magnum/ProfileScope.h"
+#include "Magnum/Implementation/parallelFor.h"
 #include "Magnum/Math/FunctionsBatch.h"
 #include "Magnum/MeshTools/Reference.h"
 #include "Magnum/Trade/MeshData.h"
 
+#ifdef CORRADE_TARGET_SSE2
+#include <emmintrin.h>
+#elif defined(CORRADE_TARGET_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace Magnum { namespace MeshTools {
 
 namespace {
 
-template<class T, class U> inline Containers::Array<char> compress(const Containers::StridedArrayView1D<const U>& indices, Long offset) {
-    /* Can't use Utility::copy() here because we're copying from a larger type
-       to a smaller one (and subtracting an offset in addition) */
-    Containers::Array<char> buffer(indices.size()*sizeof(T));
-    for(std::size_t i = 0; i != indices.size(); ++i) {
-        T index = static_cast<T>(indices[i] - offset);
-        std::memcpy(buffer.begin()+i*sizeof(T), &index, sizeof(T));
+/* Indices are processed in blocks of a fixed size, each thread gets at least
+   MinBlocksPerThread of them so small meshes stay on a single thread */
+constexpr std::size_t BlockSize = 65536;
+constexpr std::size_t MinBlocksPerThread = 4;
+
+template<class T> void minmaxStrided(const char* const data, const std::ptrdiff_t stride, const std::size_t count, T& min, T& max) {
+    for(std::size_t i = 0; i != count; ++i) {
+        const T value = *reinterpret_cast<const T*>(data + i*stride);
+        if(value < min) min = value;
+        if(value > max) max = value;
     }
+}
 
-    return buffer;
+template<class T, std::size_t size> void minmaxLanes(const T(&mins)[size], const T(&maxs)[size], T& min, T& max) {
+    for(std::size_t i = 0; i != size; ++i) {
+        if(mins[i] < min) min = mins[i];
+        if(maxs[i] > max) max = maxs[i];
+    }
 }
 
-template<class T> std::pair<Containers::Array<char>, MeshIndexType> compressIndicesImplementation(const Containers::StridedArrayView1D<const T>& indices, const MeshIndexType atLeast, const Long offset) {
-    CORRADE_ASSERT(!isMeshIndexTypeImplementationSpecific(atLeast),
-        "MeshTools::compressIndices(): can't compress to an implementation-specific index type" << reinterpret_cast<void*>(meshIndexTypeUnwrap(atLeast)),
-        (std::pair<Containers::Array<char>, MeshIndexType>{nullptr, MeshIndexType::UnsignedInt}));
+/* Generic variant for contiguous data, overloaded with SIMD variants for
+   concrete types below */
+template<class T> void minmaxContiguous(const T* const data, const std::size_t count, T& min, T& max) {
+    minmaxStrided(reinterpret_cast<const char*>(data), sizeof(T), count, min, max);
+}
+
+#ifdef CORRADE_TARGET_SSE2
+void minmaxContiguous(const UnsignedByte* const data, const std::size_t count, UnsignedByte& min, UnsignedByte& max) {
+    __m128i vmin = _mm_set1_epi8(char(min));
+    __m128i vmax = _mm_set1_epi8(char(max));
+    std::size_t i = 0;
+    for(; i + 16 <= count; i += 16) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        vmin = _mm_min_epu8(vmin, a);
+        vmax = _mm_max_epu8(vmax, a);
+    }
+
+    UnsignedByte mins[16], maxs[16];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(mins), vmin);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(maxs), vmax);
+    minmaxLanes(mins, maxs, min, max);
+    minmaxStrided(reinterpret_cast<const char*>(data + i), sizeof(UnsignedByte), count - i, min, max);
+}
+
+/* SSE2 has only signed 16-bit min/max, so the values are flipped to the
+   signed range and back */
+void minmaxContiguous(const UnsignedShort* const data, const std::size_t count, UnsignedShort& min, UnsignedShort& max) {
+    const __m128i sign = _mm_set1_epi16(Short(0x8000));
+    __m128i vmin = _mm_xor_si128(_mm_set1_epi16(Short(min)), sign);
+    __m128i vmax = _mm_xor_si128(_mm_set1_epi16(Short(max)), sign);
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8) {
+        const __m128i a = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), sign);
+        vmin = _mm_min_epi16(vmin, a);
+        vmax = _mm_max_epi16(vmax, a);
+    }
+
+    UnsignedShort mins[8], maxs[8];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(mins), _mm_xor_si128(vmin, sign));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(maxs), _mm_xor_si128(vmax, sign));
+    minmaxLanes(mins, maxs, min, max);
+    minmaxStrided(reinterpret_cast<const char*>(data + i), sizeof(UnsignedShort), count - i, min, max);
+}
+
+/* No 32-bit min/max in SSE2 at all, emulated with a signed comparison and
+   a blend */
+void minmaxContiguous(const UnsignedInt* const data, const std::size_t count, UnsignedInt& min, UnsignedInt& max) {
+    const __m128i sign = _mm_set1_epi32(Int(0x80000000u));
+    __m128i vmin = _mm_xor_si128(_mm_set1_epi32(Int(min)), sign);
+    __m128i vmax = _mm_xor_si128(_mm_set1_epi32(Int(max)), sign);
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4) {
+        const __m128i a = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), sign);
+        const __m128i less = _mm_cmplt_epi32(a, vmin);
+        vmin = _mm_or_si128(_mm_and_si128(less, a), _mm_andnot_si128(less, vmin));
+        const __m128i greater = _mm_cmpgt_epi32(a, vmax);
+        vmax = _mm_or_si128(_mm_and_si128(greater, a), _mm_andnot_si128(greater, vmax));
+    }
+
+    UnsignedInt mins[4], maxs[4];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(mins), _mm_xor_si128(vmin, sign));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(maxs), _mm_xor_si128(vmax, sign));
+    minmaxLanes(mins, maxs, min, max);
+    minmaxStrided(reinterpret_cast<const char*>(data + i), sizeof(UnsignedInt), count - i, min, max);
+}
+#elif defined(CORRADE_TARGET_NEON)
+void minmaxContiguous(const UnsignedByte* const data, const std::size_t count, UnsignedByte& min, UnsignedByte& max) {
+    uint8x16_t vmin = vdupq_n_u8(min);
+    uint8x16_t vmax = vdupq_n_u8(max);
+    std::size_t i = 0;
+    for(; i + 16 <= count; i += 16) {
+        const uint8x16_t a = vld1q_u8(data + i);
+        vmin = vminq_u8(vmin, a);
+        vmax = vmaxq_u8(vmax, a);
+    }
+
+    UnsignedByte mins[16], maxs[16];
+    vst1q_u8(mins, vmin);
+    vst1q_u8(maxs, vmax);
+    minmaxLanes(mins, maxs, min, max);
+    minmaxStrided(reinterpret_cast<const char*>(data + i), sizeof(UnsignedByte), count - i, min, max);
+}
+
+void minmaxContiguous(const UnsignedShort* const data, const std::size_t count, UnsignedShort& min, UnsignedShort& max) {
+    uint16x8_t vmin = vdupq_n_u16(min);
+    uint16x8_t vmax = vdupq_n_u16(max);
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8) {
+        const uint16x8_t a = vld1q_u16(data + i);
+        vmin = vminq_u16(vmin, a);
+        vmax = vmaxq_u16(vmax, a);
+    }
+
+    UnsignedShort mins[8], maxs[8];
+    vst1q_u16(mins, vmin);
+    vst1q_u16(maxs, vmax);
+    minmaxLanes(mins, maxs, min, max);
+    minmaxStrided(reinterpret_cast<const char*>(data + i), sizeof(UnsignedShort), count - i, min, max);
+}
+
+void minmaxContiguous(const UnsignedInt* const data, const std::size_t count, UnsignedInt& min, UnsignedInt& max) {
+    uint32x4_t vmin = vdupq_n_u32(min);
+    uint32x4_t vmax = vdupq_n_u32(max);
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4) {
+        const uint32x4_t a = vld1q_u32(data + i);
+        vmin = vminq_u32(vmin, a);
+        vmax = vmaxq_u32(vmax, a);
+    }
+
+    UnsignedInt mins[4], maxs[4];
+    vst1q_u32(mins, vmin);
+    vst1q_u32(maxs, vmax);
+    minmaxLanes(mins, maxs, min, max);
+    minmaxStrided(reinterpret_cast<const char*>(data + i), sizeof(UnsignedInt), count - i, min, max);
+}
+#endif
+
+/* Single pass over the indices calculating both the min and the max. Empty
+   input results in both being zero. */
+template<class T> std::pair<T, T> minmaxImplementation(const Containers::StridedArrayView1D<const T>& indices) {
+    const std::size_t count = indices.size();
+    if(!count) return {};
+
+    const std::size_t blockCount = (count + BlockSize - 1)/BlockSize;
+    Containers::Array<T> blockMins{NoInit, blockCount};
+    Containers::Array<T> blockMaxs{NoInit, blockCount};
+
+    /* Caching values to avoid inline function calls in debug builds */
+    const char* const data = static_cast<const char*>(indices.data());
+    const std::ptrdiff_t stride = indices.stride();
+    const bool contiguous = stride == std::ptrdiff_t(sizeof(T));
+    T* const blockMinsData = blockMins.data();
+    T* const blockMaxsData = blockMaxs.data();
+    Magnum::Implementation::parallelFor((blockCount + MinBlocksPerThread - 1)/MinBlocksPerThread, 0, [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t i = begin*MinBlocksPerThread, iMax = Math::min(end*MinBlocksPerThread, blockCount); i < iMax; ++i) {
+            const std::size_t first = i*BlockSize;
+            const std::size_t size = Math::min(BlockSize, count - first);
+            const char* const blockData = data + std::ptrdiff_t(first)*stride;
+            T min = *reinterpret_cast<const T*>(blockData);
+            T max = min;
+            if(contiguous)
+                minmaxContiguous(reinterpret_cast<const T*>(blockData), size, min, max);
+            else
+                minmaxStrided(blockData, stride, size, min, max);
+            blockMinsData[i] = min;
+            blockMaxsData[i] = max;
+        }
+    });
+
+    /* The maxima are never smaller than the minima from the same block, so
+       running both passes on both arrays gives the right result */
+    std::pair<T, T> out{blockMins[0], blockMaxs[0]};
+    minmaxStrided(reinterpret_cast<const char*>(blockMinsData), sizeof(T), blockCount, out.first, out.second);
+    minmaxStrided(reinterpret_cast<const char*>(blockMaxsData), sizeof(T), blockCount, out.first, out.second);
+    return out;
+}
+
+template<class T, class U> void compressStrided(const char* const data, const std::ptrdiff_t stride, const std::size_t count, T* const out, const Long offset) {
+    for(std::size_t i = 0; i != count; ++i)
+        out[i] = static_cast<T>(*reinterpret_cast<const U*>(data + i*stride) - offset);
+}
+
+/* Generic variant for contiguous data. Compilers vectorize this well enough
+   for conversions to the same or a larger type, narrowing conversions have
+   explicit SIMD variants below. Those saturate instead of wrapping around, so
+   they're used only if all resulting values are known to fit into the
+   output type. */
+template<class T, class U> void compressContiguous(const U* const data, T* const out, const std::size_t count, const Long offset) {
+    for(std::size_t i = 0; i != count; ++i)
+        out[i] = static_cast<T>(data[i] - offset);
+}
+
+#ifdef CORRADE_TARGET_SSE2
+/* SSE2 has only a signed 32-to-16-bit saturating pack, so the values are
+   shifted to the signed range before and back after */
+void compressContiguous(const UnsignedInt* const data, UnsignedShort* const out, const std::size_t count, const Long offset) {
+    const __m128i bias = _mm_set1_epi32(Int(UnsignedInt(offset) + 0x8000u));
+    const __m128i sign = _mm_set1_epi16(Short(0x8000));
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8) {
+        const __m128i a = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), bias);
+        const __m128i b = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 4)), bias);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_xor_si128(_mm_packs_epi32(a, b), sign));
+    }
+
+    compressStrided<UnsignedShort, UnsignedInt>(reinterpret_cast<const char*>(data + i), sizeof(UnsignedInt), count - i, out + i, offset);
+}
+
+void compressContiguous(const UnsignedInt* const data, UnsignedByte* const out, const std::size_t count, const Long offset) {
+    const __m128i vOffset = _mm_set1_epi32(Int(UnsignedInt(offset)));
+    std::size_t i = 0;
+    for(; i + 16 <= count; i += 16) {
+        const __m128i a = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), vOffset);
+        const __m128i b = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 4)), vOffset);
+        const __m128i c = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 8)), vOffset);
+        const __m128i d = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 12)), vOffset);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d)));
+    }
 
-    const UnsignedInt max = Math::max(indices) - offset;
+    compressStrided<UnsignedByte, UnsignedInt>(reinterpret_cast<const char*>(data + i), sizeof(UnsignedInt), count - i, out + i, offset);
+}
+
+void compressContiguous(const UnsignedShort* const data, UnsignedByte* const out, const std::size_t count, const Long offset) {
+    const __m128i vOffset = _mm_set1_epi16(Short(UnsignedShort(offset)));
+    std::size_t i = 0;
+    for(; i + 16 <= count; i += 16) {
+        const __m128i a = _mm_sub_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), vOffset);
+        const __m128i b = _mm_sub_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 8)), vOffset);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(a, b));
+    }
+
+    compressStrided<UnsignedByte, UnsignedShort>(reinterpret_cast<const char*>(data + i), sizeof(UnsignedShort), count - i, out + i, offset);
+}
+#elif defined(CORRADE_TARGET_NEON)
+void compressContiguous(const UnsignedInt* const data, UnsignedShort* const out, const std::size_t count, const Long offset) {
+    const uint32x4_t vOffset = vdupq_n_u32(UnsignedInt(offset));
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8) {
+        const uint16x4_t a = vmovn_u32(vsubq_u32(vld1q_u32(data + i), vOffset));
+        const uint16x4_t b = vmovn_u32(vsubq_u32(vld1q_u32(data + i + 4), vOffset));
+        vst1q_u16(out + i, vcombine_u16(a, b));
+    }
+
+    compressStrided<UnsignedShort, UnsignedInt>(reinterpret_cast<const char*>(data + i), sizeof(UnsignedInt), count - i, out + i, offset);
+}
+
+void compressContiguous(const UnsignedInt* const data, UnsignedByte* const out, const std::size_t count, const Long offset) {
+    const uint32x4_t vOffset = vdupq_n_u32(UnsignedInt(offset));
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8) {
+        const uint16x4_t a = vmovn_u32(vsubq_u32(vld1q_u32(data + i), vOffset));
+        const uint16x4_t b = vmovn_u32(vsubq_u32(vld1q_u32(data + i + 4), vOffset));
+        vst1_u8(out + i, vmovn_u16(vcombine_u16(a, b)));
+    }
+
+    compressStrided<UnsignedByte, UnsignedInt>(reinterpret_cast<const char*>(data + i), sizeof(UnsignedInt), count - i, out + i, offset);
+}
+
+void compressContiguous(const UnsignedShort* const data, UnsignedByte* const out, const std::size_t count, const Long offset) {
+    const uint16x8_t vOffset = vdupq_n_u16(UnsignedShort(offset));
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8)
+        vst1_u8(out + i, vmovn_u16(vsubq_u16(vld1q_u16(data + i), vOffset)));
+
+    compressStrided<UnsignedByte, UnsignedShort>(reinterpret_cast<const char*>(data + i), sizeof(UnsignedShort), count - i, out + i, offset);
+}
+#endif
+
+template<class T, class U> Containers::Array<char> compress(const Containers::StridedArrayView1D<const U>& indices, const Long offset, const U min, const U max) {
+    const std::size_t count = indices.size();
+    Containers::Array<char> buffer{NoInit, count*sizeof(T)};
+
+    /* The SIMD variants saturate instead of wrapping around, use them only
+       if everything fits into the output type. That's always the case except
+       for when the offset is larger than the smallest index. */
+    const bool simd = indices.stride() == std::ptrdiff_t(sizeof(U)) &&
+        Long(min) >= offset && Long(max) - offset <= Long(T(~T{}));
+
+    /* Caching values to avoid inline function calls in debug builds */
+    const char* const data = static_cast<const char*>(indices.data());
+    const std::ptrdiff_t stride = indices.stride();
+    T* const out = reinterpret_cast<T*>(buffer.data());
+    const std::size_t blockCount = (count + BlockSize - 1)/BlockSize;
+    Magnum::Implementation::parallelFor((blockCount + MinBlocksPerThread - 1)/MinBlocksPerThread, 0, [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t i = begin*MinBlocksPerThread, iMax = Math::min(end*MinBlocksPerThread, blockCount); i < iMax; ++i) {
+            const std::size_t first = i*BlockSize;
+            const std::size_t size = Math::min(BlockSize, count - first);
+            const char* const blockData = data + std::ptrdiff_t(first)*stride;
+            if(simd)
+                compressContiguous(reinterpret_cast<const U*>(blockData), out + first, size, offset);
+            else
+                compressStrided<T, U>(blockData, stride, size, out + first, offset);
+        }
+    });
+
+    return buffer;
+}
+
+template<class T> std::pair<Containers::Array<char>, MeshIndexType> compressIndicesImplementation(const Containers::StridedArrayView1D<const T>& indices, const MeshIndexType atLeast, const Long offset, const T min, const T max) {
+    const UnsignedInt maxOffset = max - offset;
     Containers::Array<char> out;
     MeshIndexType type;
-    const UnsignedInt log = Math::log(256, max);
+    const UnsignedInt log = Math::log(256, maxOffset);
 
     /* If it fits into 8 bytes and 8 bytes are allowed, pack into 8 */
     if(log == 0 && atLeast == MeshIndexType::UnsignedByte) {
-        out = compress<UnsignedByte>(indices, offset);
+        out = compress<UnsignedByte>(indices, offset, min, max);
         type = MeshIndexType::UnsignedByte;
 
     /* Otherwise, if it fits into either 8 or 16 bytes and we allow either 8 or
        16, pack into 16 */
     } else if(log <= 1 && atLeast != MeshIndexType::UnsignedInt) {
-        out = compress<UnsignedShort>(indices, offset);
+        out = compress<UnsignedShort>(indices, offset, min, max);
         type = MeshIndexType::UnsignedShort;
 
     /* Otherwise pack into 32 */
     } else {
-        out = compress<UnsignedInt>(indices, offset);
+        out = compress<UnsignedInt>(indices, offset, min, max);
         type = MeshIndexType::UnsignedInt;
     }
 
     return {std::move(out), type};
 }
 
+template<class T> std::pair<Containers::Array<char>, MeshIndexType> compressIndicesImplementation(const Containers::StridedArrayView1D<const T>& indices, const MeshIndexType atLeast, const Long offset) {
+    CORRADE_ASSERT(!isMeshIndexTypeImplementationSpecific(atLeast),
+        "MeshTools::compressIndices(): can't compress to an implementation-specific index type" << reinterpret_cast<void*>(meshIndexTypeUnwrap(atLeast)),
+        (std::pair<Containers::Array<char>, MeshIndexType>{nullptr, MeshIndexType::UnsignedInt}));
+
+    const std::pair<T, T> minmax = minmaxImplementation(indices);
+    return compressIndicesImplementation(indices, atLeast, offset, minmax.first, minmax.second);
+}
+
+template<class T> Containers::Triple<Containers::Array<char>, MeshIndexType, UnsignedInt> compressIndicesRebasedImplementation(const Containers::StridedArrayView1D<const T>& indices, const MeshIndexType atLeast) {
+    CORRADE_ASSERT(!isMeshIndexTypeImplementationSpecific(atLeast),
+        "MeshTools::compressIndicesRebased(): can't compress to an implementation-specific index type" << reinterpret_cast<void*>(meshIndexTypeUnwrap(atLeast)),
+        (Containers::Triple<Containers::Array<char>, MeshIndexType, UnsignedInt>{nullptr, MeshIndexType::UnsignedInt, 0}));
+
+    const std::pair<T, T> minmax = minmaxImplementation(indices);
+    std::pair<Containers::Array<char>, MeshIndexType> out = compressIndicesImplementation(indices, atLeast, minmax.first, minmax.first, minmax.second);
+    return {std::move(out.first), out.second, minmax.first};
 }
 
+}
 std::pair<Containers::Array<char>, MeshIndexType> compressIndices(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const MeshIndexType atLeast, const Long offset) {
     return compressIndicesImplementation(indices, atLeast, offset);
 }
@@ -122,8 +431,37 @@ std::pair<Containers::Array<char>, MeshIndexType> compressIndices(const Containe
     return compressIndices(indices, MeshIndexType::UnsignedShort, offset);
 }
 
+Containers::Triple<Containers::Array<char>, MeshIndexType, UnsignedInt> compressIndicesRebased(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const MeshIndexType atLeast) {
+    return compressIndicesRebasedImplementation(indices, atLeast);
+}
+
+Containers::Triple<Containers::Array<char>, MeshIndexType, UnsignedInt> compressIndicesRebased(const Containers::StridedArrayView1D<const UnsignedShort>& indices, const MeshIndexType atLeast) {
+    return compressIndicesRebasedImplementation(indices, atLeast);
+}
+
+Containers::Triple<Containers::Array<char>, MeshIndexType, UnsignedInt> compressIndicesRebased(const Containers::StridedArrayView1D<const UnsignedByte>& indices, const MeshIndexType atLeast) {
+    return compressIndicesRebasedImplementation(indices, atLeast);
+}
+
+Containers::Triple<Containers::Array<char>, MeshIndexType, UnsignedInt> compressIndicesRebased(const Containers::StridedArrayView2D<const char>& indices, const MeshIndexType atLeast) {
+    CORRADE_ASSERT(indices.isContiguous<1>(), "MeshTools::compressIndicesRebased(): second view dimension is not contiguous", {});
+    if(indices.size()[1] == 4)
+        return compressIndicesRebasedImplementation(Containers::arrayCast<1, const UnsignedInt>(indices), atLeast);
+    else if(indices.size()[1] == 2)
+        return compressIndicesRebasedImplementation(Containers::arrayCast<1, const UnsignedShort>(indices), atLeast);
+    else {
+        CORRADE_ASSERT(indices.size()[1] == 1, "MeshTools::compressIndicesRebased(): expected index type size 1, 2 or 4 but got" << indices.size()[1], {});
+        return compressIndicesRebasedImplementation(Containers::arrayCast<1, const UnsignedByte>(indices), atLeast);
+    }
+}
+
 Trade::MeshData compressIndices(Trade::MeshData&& data, MeshIndexType atLeast) {
+    MAGNUM_PROFILE_SCOPE("MeshTools::compressIndices()");
+
     CORRADE_ASSERT(data.isIndexed(), "MeshTools::compressIndices(): mesh data not indexed", (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+    CORRADE_ASSERT(!isMeshIndexTypeImplementationSpecific(atLeast),
+        "MeshTools::compressIndices(): can't compress to an implementation-specific index type" << reinterpret_cast<void*>(meshIndexTypeUnwrap(atLeast)),
+        (Trade::MeshData{MeshPrimitive{}, 0}));
 
     /* Transfer vertex data as-is, as those don't need any changes. Release if
        possible. */
@@ -136,26 +474,20 @@ Trade::MeshData compressIndices(Trade::MeshData&& data, MeshIndexType atLeast) {
         Utility::copy(data.vertexData(), vertexData);
     }
 
-    /* Compress the indices */
-    UnsignedInt offset;
-    std::pair<Containers::Array<char>, MeshIndexType> result;
+    /* Compress the indices, rebasing them to the smallest index */
+    Containers::Triple<Containers::Array<char>, MeshIndexType, UnsignedInt> result;
     if(data.indexType() == MeshIndexType::UnsignedInt) {
-        auto indices = data.indices<UnsignedInt>();
-        offset = Math::min(indices);
-        result = compressIndicesImplementation<UnsignedInt>(indices, atLeast, offset);
+        result = compressIndicesRebasedImplementation<UnsignedInt>(data.indices<UnsignedInt>(), atLeast);
     } else if(data.indexType() == MeshIndexType::UnsignedShort) {
-        auto indices = data.indices<UnsignedShort>();
-        offset = Math::min(indices);
-        result = compressIndicesImplementation<UnsignedShort>(indices, atLeast, offset);
+        result = compressIndicesRebasedImplementation<UnsignedShort>(data.indices<UnsignedShort>(), atLeast);
     } else {
         CORRADE_ASSERT(!isMeshIndexTypeImplementationSpecific(data.indexType()),
             "MeshTools::compressIndices(): mesh has an implementation-specific index type" << reinterpret_cast<void*>(meshIndexTypeUnwrap(data.indexType())),
             (Trade::MeshData{MeshPrimitive{}, 0}));
         CORRADE_INTERNAL_ASSERT(data.indexType() == MeshIndexType::UnsignedByte);
-        auto indices = data.indices<UnsignedByte>();
-        offset = Math::min(indices);
-        result = compressIndicesImplementation<UnsignedByte>(indices, atLeast, offset);
+        result = compressIndicesRebasedImplementation<UnsignedByte>(data.indices<UnsignedByte>(), atLeast);
     }
+    const UnsignedInt offset = result.third();
 
     /* Recreate the attribute array */
     const UnsignedInt newVertexCount = vertexCount - offset;
@@ -168,8 +500,8 @@ Trade::MeshData compressIndices(Trade::MeshData&& data, MeshIndexType atLeast) {
             data.attributeArraySize(i)};
     }
 
-    Trade::MeshIndexData indices{result.second, result.first};
-    return Trade::MeshData{data.primitive(), std::move(result.first), indices,
+    Trade::MeshIndexData indices{result.second(), result.first()};
+    return Trade::MeshData{data.primitive(), std::move(result.first()), indices,
         std::move(vertexData), std::move(attributeData), newVertexCount};
 }
 
@@ -26,11 +26,11 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::compressIndices()
+ * @brief Function @ref Magnum::MeshTools::compressIndices(), @ref Magnum::MeshTools::compressIndicesRebased()
  */
 
 #include <utility>
-#include <Corrade/Containers/Containers.h>
+#include <Corrade/Containers/Triple.h>
 
 #include "Magnum/Mesh.h"
 #include "Magnum/MeshTools/visibility.h"
@@ -72,9 +72,15 @@ offsets accordingly. Example:
 
 @snippet MagnumMeshTools.cpp compressIndices-offset
 
-A negative @p offset value will do an operation inverse to the above. See also
-@ref compressIndices(const Trade::MeshData&, MeshIndexType) that can do this
-operation directly on a @ref Trade::MeshData instance.
+A negative @p offset value will do an operation inverse to the above. Use
+@ref compressIndicesRebased() to subtract the smallest index without having to
+calculate it first, see also @ref compressIndices(const Trade::MeshData&, MeshIndexType)
+that can do this operation directly on a @ref Trade::MeshData instance.
+
+The index range is found in a single pass over the input. For contiguous
+views, both the range detection and conversion to a smaller type are
+vectorized on SSE2 and NEON, and large inputs are processed on multiple
+threads if @ref CORRADE_BUILD_MULTITHREADED is enabled.
 
 The @p atLeast parameter is expected to not be an implementation-specific type.
 @see @ref isMeshIndexTypeImplementationSpecific()
@@ -143,6 +149,48 @@ with @p atLeast set to @ref MeshIndexType::UnsignedShort.
 */
 MAGNUM_MESHTOOLS_EXPORT std::pair<Containers::Array<char>, MeshIndexType> compressIndices(const Containers::StridedArrayView2D<const char>& indices, Long offset);
 
+/**
+@brief Compress an index array, rebasing it to the smallest index
+@param indices  Index array
+@param atLeast  Smallest allowed type
+@return Compressed index array, corresponding type and the smallest index that
+    got subtracted from all indices
+@m_since_latest
+
+Like @ref compressIndices(const Containers::StridedArrayView1D<const UnsignedInt>&, MeshIndexType, Long),
+but with the @p offset being the smallest index in @p indices, detected in the
+same pass as the largest index. The returned offset should be used to adjust
+vertex attribute offsets accordingly. If @p indices are empty, the returned
+offset is @cpp 0 @ce.
+
+The @p atLeast parameter is expected to not be an implementation-specific type.
+@see @ref isMeshIndexTypeImplementationSpecific()
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Triple<Containers::Array<char>, MeshIndexType, UnsignedInt> compressIndicesRebased(const Containers::StridedArrayView1D<const UnsignedInt>& indices, MeshIndexType atLeast = MeshIndexType::UnsignedShort);
+
+/**
+@overload
+@m_since_latest
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Triple<Containers::Array<char>, MeshIndexType, UnsignedInt> compressIndicesRebased(const Containers::StridedArrayView1D<const UnsignedShort>& indices, MeshIndexType atLeast = MeshIndexType::UnsignedShort);
+
+/**
+@overload
+@m_since_latest
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Triple<Containers::Array<char>, MeshIndexType, UnsignedInt> compressIndicesRebased(const Containers::StridedArrayView1D<const UnsignedByte>& indices, MeshIndexType atLeast = MeshIndexType::UnsignedShort);
+
+/**
+@brief Compress a type-erased index array, rebasing it to the smallest index
+@m_since_latest
+
+Expects that the second dimension of @p indices is contiguous and represents
+the actual 1/2/4-byte index type. Based on its size then calls one of the
+@ref compressIndicesRebased(const Containers::StridedArrayView1D<const UnsignedInt>&, MeshIndexType)
+etc. overloads.
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Triple<Containers::Array<char>, MeshIndexType, UnsignedInt> compressIndicesRebased(const Containers::StridedArrayView2D<const char>& indices, MeshIndexType atLeast = MeshIndexType::UnsignedShort);
+
 /**
 @brief Compress mesh data indices
 @m_since{2020,06}
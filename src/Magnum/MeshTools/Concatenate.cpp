@@ -26,9 +26,11 @@
 #include "Concatenate.h"
 
 #include <numeric>
-#include <unordered_map>
 #include <Corrade/Utility/Algorithms.h>
 
+#include "Magnum/ProfileScope.h"
+#include "Magnum/Math/Functions.h"
+
 namespace Magnum { namespace MeshTools {
 
 namespace Implementation {
@@ -54,19 +56,82 @@ std::pair<UnsignedInt, UnsignedInt> concatenateIndexVertexCount(Containers::Arra
     return {indexCount, vertexCount};
 }
 
-/* std::hash for enumeration types is only since C++14, so we need to make our
-   own. It's amazing how extremely verbose this can get, ugh. */
-struct MeshAttributeHash: std::hash<typename std::underlying_type<Trade::MeshAttribute>::type> {
-    std::size_t operator()(Trade::MeshAttribute value) const {
-        return std::hash<typename std::underlying_type<Trade::MeshAttribute>::type>::operator()(static_cast<typename std::underlying_type<Trade::MeshAttribute>::type>(value));
-    }
-};
+Containers::Array<Trade::MeshAttributeData> concatenateLayout(const Trade::MeshData& mesh, const InterleaveFlags flags) {
+    /* Make a non-owning copy of the attribute data to avoid
+       interleavedLayout() stealing the original (we still need it to be able
+       to reference the original data). If there's no attributes in the
+       original array, pass just vertex count --- otherwise MeshData will
+       assert on that to avoid it getting lost. */
+    if(mesh.attributeCount())
+        return Implementation::interleavedLayout(Trade::MeshData{mesh.primitive(),
+            {}, mesh.vertexData(),
+            Trade::meshAttributeDataNonOwningArray(mesh.attributeData())}, {}, flags);
+    return Implementation::interleavedLayout(Trade::MeshData{mesh.primitive(),
+        mesh.vertexCount()}, {}, flags);
+}
 
-Trade::MeshData concatenate(Containers::Array<char>&& indexData, const UnsignedInt vertexCount, Containers::Array<char>&& vertexData, Containers::Array<Trade::MeshAttributeData>&& attributeData, const Containers::ArrayView<const Containers::Reference<const Trade::MeshData>> meshes, const char* const assertPrefix) {
+bool concatenateMeshInto(const Containers::ArrayView<UnsignedInt> indices, const Containers::ArrayView<char> vertexData, const Containers::ArrayView<const Trade::MeshAttributeData> attributeData, const Containers::ArrayView<bool> copied, const MeshPrimitive primitive, const Trade::MeshData& mesh, const std::size_t id, const UnsignedInt vertexOffset, const char* const assertPrefix) {
     #ifdef CORRADE_NO_ASSERT
+    static_cast<void>(id);
     static_cast<void>(assertPrefix);
     #endif
 
+    CORRADE_ASSERT(mesh.primitive() == primitive,
+        assertPrefix << "expected" << primitive << "but got" << mesh.primitive() << "in mesh" << id, false);
+
+    /* If the mesh is indexed, copy the indices over, expanded to 32bit */
+    if(mesh.isIndexed()) {
+        CORRADE_ASSERT(!isMeshIndexTypeImplementationSpecific(mesh.indexType()),
+            assertPrefix << "mesh" << id << "has an implementation-specific index type" << reinterpret_cast<void*>(meshIndexTypeUnwrap(mesh.indexType())), false);
+
+        mesh.indicesInto(indices);
+
+        /* Adjust indices for current vertex offset */
+        for(UnsignedInt& index: indices) index += vertexOffset;
+
+    /* Otherwise, if we need an index buffer (meaning at least one of the
+       meshes is indexed), generate a trivial index buffer */
+    } else if(!indices.isEmpty())
+        std::iota(indices.begin(), indices.end(), vertexOffset);
+
+    /* Reset markers saying which attribute has already been copied */
+    for(bool& i: copied) i = false;
+
+    /* Copy attributes to their destination, skipping ones that don't have
+       any equivalent in the destination mesh */
+    for(UnsignedInt src = 0; src != mesh.attributeCount(); ++src) {
+        /* Find the earliest destination attribute of the same name that
+           hasn't been copied yet. There's usually just a handful of
+           attributes so a linear search is faster than any map. */
+        const Trade::MeshAttribute name = mesh.attributeName(src);
+        UnsignedInt dst = 0;
+        for(; dst != attributeData.size(); ++dst)
+            if(!copied[dst] && attributeData[dst].name() == name) break;
+
+        /* No corresponding attribute found, continue */
+        if(dst == attributeData.size()) continue;
+
+        /* Check format compatibility */
+        const Trade::MeshAttributeData& attribute = attributeData[dst];
+        CORRADE_ASSERT(attribute.format() == mesh.attributeFormat(src),
+            assertPrefix << "expected" << attribute.format() << "for attribute" << dst << "(" << Debug::nospace << name << Debug::nospace << ") but got" << mesh.attributeFormat(src) << "in mesh" << id << "attribute" << src, false);
+        CORRADE_ASSERT(attribute.arraySize() == mesh.attributeArraySize(src),
+            assertPrefix << "expected array size" << attribute.arraySize() << "for attribute" << dst << "(" << Debug::nospace << name << Debug::nospace << ") but got" << mesh.attributeArraySize(src) << "in mesh" << id << "attribute" << src, false);
+
+        /* Copy the data to a slice of the output, mark the attribute as
+           copied */
+        const std::size_t stride = attribute.stride();
+        Utility::copy(mesh.attribute(src), Containers::StridedArrayView2D<char>{vertexData,
+            vertexData + attribute.offset(vertexData) + vertexOffset*stride,
+            {mesh.vertexCount(), vertexFormatSize(attribute.format())*Math::max(attribute.arraySize(), UnsignedShort{1})},
+            {std::ptrdiff_t(stride), 1}});
+        copied[dst] = true;
+    }
+
+    return true;
+}
+
+Trade::MeshData concatenateFinalize(const MeshPrimitive primitive, Containers::Array<char>&& indexData, const UnsignedInt vertexCount, Containers::Array<char>&& vertexData, Containers::Array<Trade::MeshAttributeData>&& attributeData) {
     /* Convert the attributes from offset-only and zero vertex count to
        absolute, referencing the vertex data array */
     for(Trade::MeshAttributeData& attribute: attributeData) {
@@ -78,118 +143,60 @@ Trade::MeshData concatenate(Containers::Array<char>&& indexData, const UnsignedI
             attribute.arraySize()};
     }
 
+    const Containers::ArrayView<UnsignedInt> indices = Containers::arrayCast<UnsignedInt>(indexData);
+    return Trade::MeshData{primitive,
+        /* If the index array is empty, we're creating a non-indexed mesh (not
+           an indexed mesh with zero indices) */
+        std::move(indexData), indices.isEmpty() ?
+            Trade::MeshIndexData{} : Trade::MeshIndexData{indices},
+        std::move(vertexData), std::move(attributeData), vertexCount};
+}
+
+Trade::MeshData concatenate(Containers::Array<char>&& indexData, const UnsignedInt vertexCount, Containers::Array<char>&& vertexData, Containers::Array<Trade::MeshAttributeData>&& attributeData, const Containers::ArrayView<const Containers::Reference<const Trade::MeshData>> meshes, const char* const assertPrefix) {
+    #ifdef CORRADE_NO_ASSERT
+    static_cast<void>(assertPrefix);
+    #endif
+
     /* Only list primitives are supported currently */
     /** @todo delegate to `indexTriangleStrip()` (`duplicate*()`?) etc when
         those are done */
+    const MeshPrimitive primitive = meshes.front()->primitive();
     CORRADE_ASSERT(
-        meshes.front()->primitive() != MeshPrimitive::LineStrip &&
-        meshes.front()->primitive() != MeshPrimitive::LineLoop &&
-        meshes.front()->primitive() != MeshPrimitive::TriangleStrip &&
-        meshes.front()->primitive() != MeshPrimitive::TriangleFan,
-        assertPrefix << meshes.front()->primitive() << "is not supported, turn it into a plain indexed mesh first",
+        primitive != MeshPrimitive::LineStrip &&
+        primitive != MeshPrimitive::LineLoop &&
+        primitive != MeshPrimitive::TriangleStrip &&
+        primitive != MeshPrimitive::TriangleFan,
+        assertPrefix << primitive << "is not supported, turn it into a plain indexed mesh first",
         (Trade::MeshData{MeshPrimitive{}, 0}));
 
-    /* Populate the resulting instance with what we have. It'll be used below
-       for convenient access to vertex / index data */
-    auto indices = Containers::arrayCast<UnsignedInt>(indexData);
-    Trade::MeshData out{meshes.front()->primitive(),
-        /* If the index array is empty, we're creating a non-indexed mesh (not
-           an indexed mesh with zero indices) */
-        std::move(indexData), indices.isEmpty() ?
-            Trade::MeshIndexData{} : Trade::MeshIndexData{indices},
-        std::move(vertexData), std::move(attributeData), vertexCount};
-    /* Create an attribute map. Yes, this is an inevitable fugly thing that
-       allocates like mad, while everything else is zero-alloc.
-       Containers::HashMap can't be here soon enough. */
-    std::unordered_multimap<Trade::MeshAttribute, std::pair<UnsignedInt, bool>, MeshAttributeHash> attributeMap;
-    attributeMap.reserve(out.attributeCount());
-    for(UnsignedInt i = 0; i != out.attributeCount(); ++i)
-        attributeMap.emplace(out.attributeName(i), std::make_pair(i, false));
-
-    /* Go through all meshes and put all attributes and index arrays together. */
+    /* Go through all meshes and put all attributes and index arrays
+       together. The copied markers are allocated just once for all. */
+    const Containers::ArrayView<UnsignedInt> indices = Containers::arrayCast<UnsignedInt>(indexData);
+    Containers::Array<bool> copied{NoInit, attributeData.size()};
     std::size_t indexOffset = 0;
-    std::size_t vertexOffset = 0;
+    UnsignedInt vertexOffset = 0;
     for(std::size_t i = 0; i != meshes.size(); ++i) {
         const Trade::MeshData& mesh = meshes[i];
 
-        /* This won't fire for i == ~std::size_t{}, as that's where
-           out.primitive() comes from */
-        CORRADE_ASSERT(mesh.primitive() == out.primitive(),
-            assertPrefix << "expected" << out.primitive() << "but got" << mesh.primitive() << "in mesh" << i,
-            (Trade::MeshData{MeshPrimitive{}, 0}));
+        /* If we need an index buffer, the mesh either uses its own indices or
+           gets a trivial index buffer generated for all its vertices */
+        const std::size_t meshIndexCount = indices.isEmpty() ? 0 :
+            mesh.isIndexed() ? mesh.indexCount() : mesh.vertexCount();
+        if(!concatenateMeshInto(indices.slice(indexOffset, indexOffset + meshIndexCount), vertexData, attributeData, copied, primitive, mesh, i, vertexOffset, assertPrefix))
+            return Trade::MeshData{MeshPrimitive{}, 0};
 
-        /* If the mesh is indexed, copy the indices over, expanded to 32bit */
-        if(mesh.isIndexed()) {
-            CORRADE_ASSERT(!isMeshIndexTypeImplementationSpecific(mesh.indexType()),
-                assertPrefix << "mesh" << i << "has an implementation-specific index type" << reinterpret_cast<void*>(meshIndexTypeUnwrap(mesh.indexType())),
-                (Trade::MeshData{MeshPrimitive{}, 0}));
-
-            Containers::ArrayView<UnsignedInt> dst = indices.slice(indexOffset, indexOffset + mesh.indexCount());
-            mesh.indicesInto(dst);
-            indexOffset += mesh.indexCount();
-
-            /* Adjust indices for current vertex offset */
-            for(UnsignedInt& index: dst) index += vertexOffset;
-
-        /* Otherwise, if we need an index buffer (meaning at least one of the
-           meshes is indexed), generate a trivial index buffer */
-        } else if(!indices.isEmpty()) {
-            std::iota(indices + indexOffset, indices + indexOffset + mesh.vertexCount(), UnsignedInt(vertexOffset));
-            indexOffset += mesh.vertexCount();
-        }
-
-        /* Reset markers saying which attribute has already been copied */
-        for(auto it = attributeMap.begin(); it != attributeMap.end(); ++it)
-            it->second.second = false;
-
-        /* Copy attributes to their destination, skipping ones that don't have
-           any equivalent in the destination mesh */
-        for(UnsignedInt src = 0; src != mesh.attributeCount(); ++src) {
-            /* Go through destination attributes of the same name and find the
-               earliest one that hasn't been copied yet */
-            auto range = attributeMap.equal_range(mesh.attributeName(src));
-            UnsignedInt dst = ~UnsignedInt{};
-            auto found = attributeMap.end();
-            for(auto it = range.first; it != range.second; ++it) {
-                if(it->second.second) continue;
-
-                /* The range is unordered so we need to go through everything
-                   and pick one with smallest ID */
-                if(it->second.first < dst) {
-                    dst = it->second.first;
-                    found = it;
-                }
-            }
-
-            /* No corresponding attribute found, continue */
-            if(dst == ~UnsignedInt{}) continue;
-
-            /* Check format compatibility. This won't fire for i ==
-               ~std::size_t{}, as that's where out.primitive() comes from */
-            CORRADE_ASSERT(out.attributeFormat(dst) == mesh.attributeFormat(src),
-                assertPrefix << "expected" << out.attributeFormat(dst) << "for attribute" << dst << "(" << Debug::nospace << out.attributeName(dst) << Debug::nospace << ") but got" << mesh.attributeFormat(src) << "in mesh" << i << "attribute" << src,
-                (Trade::MeshData{MeshPrimitive{}, 0}));
-            CORRADE_ASSERT(out.attributeArraySize(dst) == mesh.attributeArraySize(src),
-                assertPrefix << "expected array size" << out.attributeArraySize(dst) << "for attribute" << dst << "(" << Debug::nospace << out.attributeName(dst) << Debug::nospace << ") but got" << mesh.attributeArraySize(src) << "in mesh" << i << "attribute" << src,
-                (Trade::MeshData{MeshPrimitive{}, 0}));
-
-            /* Copy the data to a slice of the output, mark the attribute as
-               copied */
-            Utility::copy(mesh.attribute(src), out.mutableAttribute(dst)
-                .slice(vertexOffset, vertexOffset + mesh.vertexCount()));
-            found->second.second = true;
-        }
-
-        /* Update vertex offset for the next mesh */
+        indexOffset += meshIndexCount;
         vertexOffset += mesh.vertexCount();
     }
 
-    return out;
+    return concatenateFinalize(primitive, std::move(indexData), vertexCount, std::move(vertexData), std::move(attributeData));
 }
 
 }
 
 Trade::MeshData concatenate(const Containers::ArrayView<const Containers::Reference<const Trade::MeshData>> meshes, const InterleaveFlags flags) {
+    MAGNUM_PROFILE_SCOPE("MeshTools::concatenate()");
+
     CORRADE_ASSERT(!meshes.isEmpty(),
         "MeshTools::concatenate(): expected at least one mesh",
         (Trade::MeshData{MeshPrimitive::Points, 0}));
@@ -202,19 +209,8 @@ Trade::MeshData concatenate(const Containers::ArrayView<const Containers::Refere
     }
     #endif
 
-    /* Calculate final attribute stride and offsets. Make a non-owning copy of
-       the attribute data to avoid interleavedLayout() stealing the original
-       (we still need it to be able to reference the original data). If there's
-       no attributes in the original array, pass just vertex count ---
-       otherwise MeshData will assert on that to avoid it getting lost. */
-    Containers::Array<Trade::MeshAttributeData> attributeData;
-    if(meshes.front()->attributeCount())
-        attributeData = Implementation::interleavedLayout(Trade::MeshData{meshes.front()->primitive(),
-            {}, meshes.front()->vertexData(),
-            Trade::meshAttributeDataNonOwningArray(meshes.front()->attributeData())}, {}, flags);
-    else attributeData =
-        Implementation::interleavedLayout(Trade::MeshData{meshes.front()->primitive(),
-            meshes.front()->vertexCount()}, {}, flags);
+    /* Calculate final attribute stride and offsets */
+    Containers::Array<Trade::MeshAttributeData> attributeData = Implementation::concatenateLayout(meshes.front(), flags);
 
     /* Calculate total index/vertex count and allocate the target memory.
        Index data are allocated with NoInit as the whole array will be written,
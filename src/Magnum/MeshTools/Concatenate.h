@@ -26,7 +26,7 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::concatenate(), @ref Magnum::MeshTools::concatenateInto()
+ * @brief Function @ref Magnum::MeshTools::concatenate(), @ref Magnum::MeshTools::concatenateInto(), class @ref Magnum::MeshTools::Concatenator
  * @m_since{2020,06}
  */
 
@@ -41,6 +41,9 @@ namespace Magnum { namespace MeshTools {
 namespace Implementation {
     MAGNUM_MESHTOOLS_EXPORT std::pair<UnsignedInt, UnsignedInt> concatenateIndexVertexCount(Containers::ArrayView<const Containers::Reference<const Trade::MeshData>> meshes);
     MAGNUM_MESHTOOLS_EXPORT Trade::MeshData concatenate(Containers::Array<char>&& indexData, UnsignedInt vertexCount, Containers::Array<char>&& vertexData, Containers::Array<Trade::MeshAttributeData>&& attributeData, Containers::ArrayView<const Containers::Reference<const Trade::MeshData>> meshes, const char* assertPrefix);
+    MAGNUM_MESHTOOLS_EXPORT Containers::Array<Trade::MeshAttributeData> concatenateLayout(const Trade::MeshData& mesh, InterleaveFlags flags);
+    MAGNUM_MESHTOOLS_EXPORT bool concatenateMeshInto(Containers::ArrayView<UnsignedInt> indices, Containers::ArrayView<char> vertexData, Containers::ArrayView<const Trade::MeshAttributeData> attributeData, Containers::ArrayView<bool> copied, MeshPrimitive primitive, const Trade::MeshData& mesh, std::size_t id, UnsignedInt vertexOffset, const char* assertPrefix);
+    MAGNUM_MESHTOOLS_EXPORT Trade::MeshData concatenateFinalize(MeshPrimitive primitive, Containers::Array<char>&& indexData, UnsignedInt vertexCount, Containers::Array<char>&& vertexData, Containers::Array<Trade::MeshAttributeData>&& attributeData);
 }
 
 /**
@@ -150,6 +153,213 @@ template<template<class> class Allocator = Containers::ArrayAllocator> void conc
     concatenateInto<Allocator>(destination, Containers::arrayView(meshes), flags);
 }
 
+/**
+@brief Incremental mesh concatenator
+@tparam Allocator   Allocator to use for the index and vertex data
+@m_since_latest
+
+Produces the same output as @ref concatenate(Containers::ArrayView<const Containers::Reference<const Trade::MeshData>>, InterleaveFlags),
+but the meshes are added one by one with @ref append() instead of having to be
+all available at once. Together with @ref reserve() this makes it possible to
+batch a large amount of small meshes into a single one without keeping all of
+them in memory and without any reallocation, for example when they're
+produced one after another by an importer:
+
+@snippet MagnumMeshTools.cpp Concatenator
+
+The output index and vertex data are grown with
+@ref Containers::arrayResize() using given @p Allocator. The attribute layout
+is taken from the mesh passed to the constructor, with the same rules as in
+@ref concatenate(). Offsets of particular meshes in the output are available
+through @ref indexOffsets() and @ref vertexOffsets(), for example to draw them
+separately or to build per-mesh material tables.
+*/
+template<template<class> class Allocator = Containers::ArrayAllocator> class Concatenator {
+    public:
+        /**
+         * @brief Constructor
+         * @param layout    Mesh from which the primitive and the attribute
+         *      layout is taken
+         * @param flags     Flags to pass to @ref interleavedLayout()
+         *
+         * The @p layout mesh isn't added to the output, pass it to
+         * @ref append() if it should be. Attributes of @p layout are
+         * expected to not have an implementation-specific format, the
+         * primitive is expected to not be @ref MeshPrimitive::LineStrip,
+         * @ref MeshPrimitive::LineLoop, @ref MeshPrimitive::TriangleStrip or
+         * @ref MeshPrimitive::TriangleFan.
+         */
+        explicit Concatenator(const Trade::MeshData& layout, InterleaveFlags flags = InterleaveFlag::PreserveInterleavedAttributes);
+
+        /** @brief Primitive of the output */
+        MeshPrimitive primitive() const { return _primitive; }
+
+        /** @brief Count of meshes appended so far */
+        std::size_t meshCount() const { return _vertexOffsets.size(); }
+
+        /**
+         * @brief Count of indices appended so far
+         *
+         * If no indexed mesh was appended so far, returns @cpp 0 @ce.
+         */
+        UnsignedInt indexCount() const {
+            return _indexData.size()/sizeof(UnsignedInt);
+        }
+
+        /** @brief Count of vertices appended so far */
+        UnsignedInt vertexCount() const { return _vertexCount; }
+
+        /**
+         * @brief Index offsets of appended meshes
+         *
+         * Contains one item for each mesh passed to @ref append(), being the
+         * offset of its first index in the output index buffer. If the
+         * output isn't indexed, the values are equal to @ref vertexOffsets().
+         */
+        Containers::ArrayView<const UnsignedInt> indexOffsets() const {
+            return _indexOffsets;
+        }
+
+        /**
+         * @brief Vertex offsets of appended meshes
+         *
+         * Contains one item for each mesh passed to @ref append(), being the
+         * offset of its first vertex in the output vertex data.
+         */
+        Containers::ArrayView<const UnsignedInt> vertexOffsets() const {
+            return _vertexOffsets;
+        }
+
+        /**
+         * @brief Reserve memory for the output
+         * @param indexCount    Total count of indices. Pass @cpp 0 @ce if no
+         *      indexed meshes are expected.
+         * @param vertexCount   Total count of vertices
+         * @param meshCount     Total count of meshes
+         * @return Reference to self (for method chaining)
+         *
+         * Calls @ref Containers::arrayReserve() on the output index and vertex
+         * data and the offset arrays, making subsequent @ref append() calls
+         * not reallocate until the counts are exceeded. Note that if an
+         * indexed mesh is appended after non-indexed ones, a trivial index
+         * buffer is generated for them, which needs to be accounted for in
+         * @p indexCount.
+         */
+        Concatenator<Allocator>& reserve(UnsignedInt indexCount, UnsignedInt vertexCount, std::size_t meshCount = 0);
+
+        /**
+         * @brief Append a mesh
+         * @return Reference to self (for method chaining)
+         *
+         * Attributes present in the layout are copied from @p mesh,
+         * superfluous attributes are ignored and missing attributes zeroed
+         * out. If the mesh is indexed (expected to not have an
+         * implementation-specific index type), the output is made indexed as
+         * well, with a trivial index buffer generated for all previous
+         * non-indexed meshes. Expects that the mesh has the same
+         * @ref primitive() and matching attributes have the same format and
+         * array size. Can't be called after @ref finalize().
+         */
+        Concatenator<Allocator>& append(const Trade::MeshData& mesh);
+
+        /**
+         * @brief Finalize the output
+         *
+         * Returns the concatenated mesh, with index type always being
+         * @ref MeshIndexType::UnsignedInt if any of the appended meshes was
+         * indexed. The @ref indexOffsets() and @ref vertexOffsets() stay
+         * available, but @ref append() and @ref finalize() can't be called
+         * anymore.
+         */
+        Trade::MeshData finalize();
+
+    private:
+        MeshPrimitive _primitive;
+        bool _indexed{}, _finalized{};
+        UnsignedInt _vertexCount{};
+        Containers::Array<Trade::MeshAttributeData> _attributeData;
+        Containers::Array<bool> _copied;
+        Containers::Array<char> _indexData, _vertexData;
+        Containers::Array<UnsignedInt> _indexOffsets, _vertexOffsets;
+};
+
+template<template<class> class Allocator> Concatenator<Allocator>::Concatenator(const Trade::MeshData& layout, const InterleaveFlags flags): _primitive{layout.primitive()} {
+    #ifndef CORRADE_NO_ASSERT
+    for(std::size_t i = 0; i != layout.attributeCount(); ++i) {
+        const VertexFormat format = layout.attributeFormat(i);
+        CORRADE_ASSERT(!isVertexFormatImplementationSpecific(format),
+            "MeshTools::Concatenator: attribute" << i << "of the layout mesh has an implementation-specific format" << reinterpret_cast<void*>(vertexFormatUnwrap(format)), );
+    }
+    #endif
+    CORRADE_ASSERT(
+        _primitive != MeshPrimitive::LineStrip &&
+        _primitive != MeshPrimitive::LineLoop &&
+        _primitive != MeshPrimitive::TriangleStrip &&
+        _primitive != MeshPrimitive::TriangleFan,
+        "MeshTools::Concatenator:" << _primitive << "is not supported, turn it into a plain indexed mesh first", );
+
+    _attributeData = Implementation::concatenateLayout(layout, flags);
+    _copied = Containers::Array<bool>{NoInit, _attributeData.size()};
+}
+
+template<template<class> class Allocator> Concatenator<Allocator>& Concatenator<Allocator>::reserve(const UnsignedInt indexCount, const UnsignedInt vertexCount, const std::size_t meshCount) {
+    Containers::arrayReserve<Allocator>(_indexData, std::size_t{indexCount}*sizeof(UnsignedInt));
+    if(!_attributeData.isEmpty())
+        Containers::arrayReserve<Allocator>(_vertexData, std::size_t{vertexCount}*_attributeData[0].stride());
+    Containers::arrayReserve(_indexOffsets, meshCount);
+    Containers::arrayReserve(_vertexOffsets, meshCount);
+    return *this;
+}
+
+template<template<class> class Allocator> Concatenator<Allocator>& Concatenator<Allocator>::append(const Trade::MeshData& mesh) {
+    CORRADE_ASSERT(!_finalized,
+        "MeshTools::Concatenator::append(): the output was already finalized", *this);
+
+    /* If this is the first indexed mesh, all previous meshes get a trivial
+       index buffer generated for all their vertices */
+    if(mesh.isIndexed() && !_indexed) {
+        Containers::arrayResize<Allocator>(_indexData, NoInit, std::size_t{_vertexCount}*sizeof(UnsignedInt));
+        const Containers::ArrayView<UnsignedInt> indices = Containers::arrayCast<UnsignedInt>(_indexData);
+        for(UnsignedInt i = 0; i != _vertexCount; ++i) indices[i] = i;
+        _indexed = true;
+    }
+
+    /* If the output is indexed, the mesh either uses its own indices or gets
+       a trivial index buffer generated for all its vertices. Everything is
+       overwritten so the index memory doesn't need to be initialized, vertex
+       data are zero-initialized as attributes missing in the mesh are left
+       untouched. */
+    const std::size_t indexOffset = _indexed ? indexCount() : _vertexCount;
+    const std::size_t meshIndexCount = !_indexed ? 0 :
+        mesh.isIndexed() ? mesh.indexCount() : mesh.vertexCount();
+    if(meshIndexCount)
+        Containers::arrayResize<Allocator>(_indexData, NoInit, _indexData.size() + meshIndexCount*sizeof(UnsignedInt));
+    if(!_attributeData.isEmpty())
+        Containers::arrayResize<Allocator>(_vertexData, ValueInit, _vertexData.size() + std::size_t{mesh.vertexCount()}*_attributeData[0].stride());
+
+    const std::size_t id = _vertexOffsets.size();
+    Containers::arrayAppend(_indexOffsets, UnsignedInt(indexOffset));
+    Containers::arrayAppend(_vertexOffsets, _vertexCount);
+
+    Implementation::concatenateMeshInto(
+        meshIndexCount ?
+            Containers::arrayCast<UnsignedInt>(_indexData).exceptPrefix(indexOffset) :
+            Containers::ArrayView<UnsignedInt>{},
+        _vertexData, _attributeData, _copied, _primitive, mesh, id,
+        _vertexCount, "MeshTools::Concatenator::append():");
+
+    _vertexCount += mesh.vertexCount();
+    return *this;
+}
+
+template<template<class> class Allocator> Trade::MeshData Concatenator<Allocator>::finalize() {
+    CORRADE_ASSERT(!_finalized,
+        "MeshTools::Concatenator::finalize(): the output was already finalized",
+        (Trade::MeshData{MeshPrimitive{}, 0}));
+    _finalized = true;
+    return Implementation::concatenateFinalize(_primitive, std::move(_indexData), _vertexCount, std::move(_vertexData), std::move(_attributeData));
+}
+
 }}
 
 #endif
@@ -26,8 +26,11 @@
 #include "Duplicate.h"
 
 #include <cstring>
+#include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Utility/Algorithms.h>
 
+#include "Magnum/ProfileScope.h"
+#include "Magnum/Implementation/parallelFor.h"
 #include "Magnum/Math/Functions.h"
 #include "Magnum/MeshTools/Interleave.h"
 #include "Magnum/Trade/MeshData.h"
@@ -36,6 +39,93 @@ namespace Magnum { namespace MeshTools {
 
 namespace {
 
+/* Indices are processed in blocks of this size, with all attributes gathered
+   for one block before continuing to the next, so the indices stay in cache.
+   Each thread gets at least MinBlocksPerThread blocks so small meshes stay on
+   a single thread. */
+constexpr std::size_t BlockSize = 4096;
+constexpr std::size_t MinBlocksPerThread = 16;
+
+/* How many items ahead the source data get prefetched */
+constexpr std::size_t PrefetchDistance = 16;
+
+/* A single attribute to gather, with the second dimension contiguous */
+struct Gather {
+    const char* data;
+    std::ptrdiff_t dataStride;
+    char* out;
+    std::ptrdiff_t outStride;
+    std::size_t size;
+};
+
+/* Gathers items [begin, end) of all attributes. Returns position of the first
+   out-of-bounds index or end if all indices are in bounds, in which case
+   nothing from the offending block is written. */
+template<class T> std::size_t gatherRange(const char* const indices, const std::ptrdiff_t indexStride, const std::size_t begin, const std::size_t end, const Containers::ArrayView<const Gather> gathers, const std::size_t dataCount) {
+    const auto index = [&](std::size_t i) -> std::size_t {
+        return *reinterpret_cast<const T*>(indices + std::ptrdiff_t(i)*indexStride);
+    };
+
+    for(std::size_t block = begin; block < end; block += BlockSize) {
+        const std::size_t blockEnd = Math::min(block + BlockSize, end);
+
+        #ifndef CORRADE_NO_ASSERT
+        for(std::size_t i = block; i != blockEnd; ++i)
+            if(index(i) >= dataCount) return i;
+        #else
+        static_cast<void>(dataCount);
+        #endif
+
+        for(const Gather& gather: gathers) {
+            for(std::size_t i = block; i != blockEnd; ++i) {
+                #ifdef CORRADE_TARGET_GCC
+                if(i + PrefetchDistance < blockEnd)
+                    __builtin_prefetch(gather.data + std::ptrdiff_t(index(i + PrefetchDistance))*gather.dataStride);
+                #endif
+                std::memcpy(gather.out + std::ptrdiff_t(i)*gather.outStride,
+                    gather.data + std::ptrdiff_t(index(i))*gather.dataStride,
+                    gather.size);
+            }
+        }
+    }
+
+    return end;
+}
+
+template<class T> void gatherImplementation(const Containers::StridedArrayView1D<const T>& indices, const Containers::ArrayView<const Gather> gathers, const std::size_t dataCount) {
+    const std::size_t count = indices.size();
+    const std::size_t chunkSize = BlockSize*MinBlocksPerThread;
+    const std::size_t chunkCount = (count + chunkSize - 1)/chunkSize;
+
+    /* Caching values to avoid inline function calls in debug builds */
+    const char* const indexData = static_cast<const char*>(indices.data());
+    const std::ptrdiff_t indexStride = indices.stride();
+
+    #ifndef CORRADE_NO_ASSERT
+    /* The bounds are checked on the worker threads but the assertion is
+       fired only here, as the output redirection is thread-local */
+    Containers::Array<std::size_t> outOfBounds{NoInit, chunkCount};
+    #endif
+    Magnum::Implementation::parallelFor(chunkCount, 0, [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t i = begin; i != end; ++i) {
+            const std::size_t position = gatherRange<T>(indexData, indexStride, i*chunkSize, Math::min((i + 1)*chunkSize, count), gathers, dataCount);
+            #ifndef CORRADE_NO_ASSERT
+            outOfBounds[i] = position;
+            #else
+            static_cast<void>(position);
+            #endif
+        }
+    });
+
+    #ifndef CORRADE_NO_ASSERT
+    for(std::size_t i = 0; i != chunkCount; ++i) {
+        const std::size_t position = outOfBounds[i];
+        CORRADE_ASSERT(position == Math::min((i + 1)*chunkSize, count),
+            "MeshTools::duplicateInto(): index" << std::size_t(indices[position]) << "out of bounds for" << dataCount << "elements", );
+    }
+    #endif
+}
+
 template<class T> inline void duplicateIntoImplementation(const Containers::StridedArrayView1D<const T>& indices, const Containers::StridedArrayView2D<const char>& data, const Containers::StridedArrayView2D<char>& out) {
     CORRADE_ASSERT(out.size()[0] == indices.size(),
         "MeshTools::duplicateInto(): index array and output size don't match, expected" << indices.size() << "but got" << out.size()[0], );
@@ -43,11 +133,19 @@ template<class T> inline void duplicateIntoImplementation(const Containers::Stri
         "MeshTools::duplicateInto(): second view dimension is not contiguous", );
     CORRADE_ASSERT(data.size()[1] == out.size()[1],
         "MeshTools::duplicateInto(): input and output type size doesn't match, expected" << data.size()[1] << "but got" << out.size()[1], );
-    const std::size_t size = data.size()[1];
-    for(std::size_t i = 0; i != indices.size(); ++i) {
-        const std::size_t index = indices[i];
-        CORRADE_ASSERT(index < data.size()[0], "MeshTools::duplicateInto(): index" << index << "out of bounds for" << data.size()[0] << "elements", );
-        std::memcpy(out[i].data(), data[index].data(), size);
+    const Gather gather{static_cast<const char*>(data.data()), data.stride()[0],
+        static_cast<char*>(out.data()), out.stride()[0], data.size()[1]};
+    gatherImplementation(indices, {&gather, 1}, data.size()[0]);
+}
+
+void gatherErased(const Containers::StridedArrayView2D<const char>& indices, const Containers::ArrayView<const Gather> gathers, const std::size_t dataCount) {
+    if(indices.size()[1] == 4)
+        gatherImplementation(Containers::arrayCast<1, const UnsignedInt>(indices), gathers, dataCount);
+    else if(indices.size()[1] == 2)
+        gatherImplementation(Containers::arrayCast<1, const UnsignedShort>(indices), gathers, dataCount);
+    else {
+        CORRADE_INTERNAL_ASSERT(indices.size()[1] == 1);
+        gatherImplementation(Containers::arrayCast<1, const UnsignedByte>(indices), gathers, dataCount);
     }
 }
 
@@ -79,6 +177,8 @@ void duplicateInto(const Containers::StridedArrayView2D<const char>& indices, co
 }
 
 Trade::MeshData duplicate(const Trade::MeshData& data, const Containers::ArrayView<const Trade::MeshAttributeData> extra) {
+    MAGNUM_PROFILE_SCOPE("MeshTools::duplicate()");
+
     CORRADE_ASSERT(data.isIndexed(), "MeshTools::duplicate(): mesh data not indexed", (Trade::MeshData{MeshPrimitive::Triangles, 0}));
     CORRADE_ASSERT(!isMeshIndexTypeImplementationSpecific(data.indexType()),
         "MeshTools::duplicate(): mesh has an implementation-specific index type" << reinterpret_cast<void*>(meshIndexTypeUnwrap(data.indexType())),
@@ -101,9 +201,17 @@ Trade::MeshData duplicate(const Trade::MeshData& data, const Containers::ArrayVi
     /* Calculate the layout */
     Trade::MeshData layout = interleavedLayout(data, data.indexCount(), extra);
 
-    /* Copy existing attributes to new locations */
+    /* Collect existing attributes and their new locations. All attributes
+       are then gathered in a single pass over the index buffer. */
+    Containers::Array<Gather> gathers;
+    arrayReserve(gathers, data.attributeCount() + extra.size());
+    const auto addGather = [&](const Containers::StridedArrayView2D<const char>& src, const Containers::StridedArrayView2D<char>& dst) {
+        CORRADE_INTERNAL_ASSERT(src.size()[1] == dst.size()[1] && src.isContiguous<1>() && dst.isContiguous<1>());
+        arrayAppend(gathers, Gather{static_cast<const char*>(src.data()), src.stride()[0],
+            static_cast<char*>(dst.data()), dst.stride()[0], src.size()[1]});
+    };
     for(UnsignedInt i = 0; i != data.attributeCount(); ++i)
-        duplicateInto(data.indices(), data.attribute(i), layout.mutableAttribute(i));
+        addGather(data.attribute(i), layout.mutableAttribute(i));
 
     /* Mix in the extra attributes */
     UnsignedInt attributeIndex = data.attributeCount();
@@ -126,12 +234,14 @@ Trade::MeshData duplicate(const Trade::MeshData& data, const Containers::ArrayVi
             const Containers::StridedArrayView2D<const char> attributeData =
                 Containers::arrayCast<2, const char>(extra[i].data(),
                 vertexFormatSize(extra[i].format())*Math::max(extra[i].arraySize(), UnsignedShort{1}));
-            duplicateInto(data.indices(), attributeData, layout.mutableAttribute(attributeIndex));
+            addGather(attributeData, layout.mutableAttribute(attributeIndex));
         }
 
         ++attributeIndex;
     }
 
+    gatherErased(data.indices(), gathers, data.vertexCount());
+
     return layout;
 }
 
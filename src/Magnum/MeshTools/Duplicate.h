@@ -105,6 +105,10 @@ accepts a 2D view, where the second dimension spans the actual type. Expects
 that @p out has the same size as @p indices and all indices are in range for
 the @p data array, and that the second dimension of both @p data and @p out
 is contiguous and has the same size.
+
+The indices are processed in blocks, with source data prefetched ahead of the
+copy where the compiler supports it. Large index arrays are split across
+multiple threads if @ref CORRADE_BUILD_MULTITHREADED is enabled.
 */
 MAGNUM_MESHTOOLS_EXPORT void duplicateInto(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView2D<const char>& data, const Containers::StridedArrayView2D<char>& out);
 
@@ -144,6 +148,10 @@ is done by @ref interleavedLayout(), see its documentation for detailed
 behavior description. Note that offset-only @ref Trade::MeshAttributeData
 instances are not supported in the @p extra array.
 
+All attributes are gathered together in a single pass over the index buffer,
+one block of indices at a time, and large meshes are split across multiple
+threads in the same way as in @ref duplicateInto(const Containers::StridedArrayView1D<const UnsignedInt>&, const Containers::StridedArrayView2D<const char>&, const Containers::StridedArrayView2D<char>&).
+
 Expects that @p data is indexed with a non-implementation-specific index type
 and each attribute in @p extra has either the same amount of elements as
 @p data vertex count (*not* index count) or has none. All attributes are
@@ -29,6 +29,7 @@
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Utility/Algorithms.h>
 
+#include "Magnum/ProfileScope.h"
 #include "Magnum/Math/Vector3.h"
 #include "Magnum/MeshTools/Reference.h"
 #include "Magnum/Trade/MeshData.h"
@@ -271,6 +272,8 @@ void generateQuadIndicesInto(const Containers::StridedArrayView1D<const Vector3>
 }
 
 Trade::MeshData generateIndices(Trade::MeshData&& data) {
+    MAGNUM_PROFILE_SCOPE("MeshTools::generateIndices()");
+
     CORRADE_ASSERT(!data.isIndexed(),
         "MeshTools::generateIndices(): mesh data already indexed",
         (Trade::MeshData{MeshPrimitive::Triangles, 0}));
@@ -0,0 +1,202 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "GenerateMeshlets.h"
+
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/MeshTools/BoundingVolume.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+void finalizeMeshlet(Meshlet& meshlet, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::ArrayView<const UnsignedInt> vertices, const Containers::ArrayView<const UnsignedByte> triangles, const Containers::ArrayView<Vector3> scratch) {
+    /* Gather the positions so the bounding sphere can be calculated with the
+       existing algorithm */
+    for(std::size_t i = 0; i != vertices.size(); ++i)
+        scratch[i] = positions[vertices[i]];
+    const Containers::Pair<Vector3, Float> sphere = boundingSphereBouncingBubble(scratch.prefix(vertices.size()));
+    meshlet.center = sphere.first();
+    meshlet.radius = sphere.second();
+
+    /* Average of all normals is the cone axis. Degenerate triangles have no
+       defined normal, skip them. */
+    Vector3 axis;
+    for(std::size_t i = 0; i != triangles.size(); i += 3) {
+        const Vector3 a = scratch[triangles[i + 0]];
+        const Vector3 normal = Math::cross(scratch[triangles[i + 1]] - a, scratch[triangles[i + 2]] - a);
+        const Float length = normal.length();
+        if(length > 0.0f) axis += normal/length;
+    }
+
+    /* Only degenerate triangles or the normals cancel each other out, there's
+       no usable cone */
+    const Float axisLength = axis.length();
+    if(axisLength == 0.0f) {
+        meshlet.coneAxis = {};
+        meshlet.coneCutoff = 1.0f;
+        return;
+    }
+    axis /= axisLength;
+
+    /* The widest angle between the axis and any of the normals is the cone
+       opening */
+    Float minDot = 1.0f;
+    for(std::size_t i = 0; i != triangles.size(); i += 3) {
+        const Vector3 a = scratch[triangles[i + 0]];
+        const Vector3 normal = Math::cross(scratch[triangles[i + 1]] - a, scratch[triangles[i + 2]] - a);
+        const Float length = normal.length();
+        if(length > 0.0f) minDot = Math::min(minDot, Math::dot(axis, normal/length));
+    }
+
+    meshlet.coneAxis = axis;
+    /* Wider than a hemisphere, the meshlet can never be backface-culled. The
+       cutoff is a sine of the cone half-angle, i.e. cosine of the angle
+       between the view vector and the axis at which the cone becomes entirely
+       backfacing. */
+    meshlet.coneCutoff = minDot <= 0.0f ? 1.0f : Math::sqrt(1.0f - minDot*minDot);
+}
+
+template<class T> Containers::Triple<Containers::Array<Meshlet>, Containers::Array<UnsignedInt>, Containers::Array<UnsignedByte>> generateMeshletsImplementation(const Containers::StridedArrayView1D<const T>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt maxVertexCount, const UnsignedInt maxTriangleCount) {
+    CORRADE_ASSERT(indices.size() % 3 == 0,
+        "MeshTools::generateMeshlets(): index count" << indices.size() << "not divisible by 3", {});
+    CORRADE_ASSERT(maxVertexCount >= 3 && maxVertexCount <= 256,
+        "MeshTools::generateMeshlets(): expected max vertex count to be in range [3, 256] but got" << maxVertexCount, {});
+    CORRADE_ASSERT(maxTriangleCount,
+        "MeshTools::generateMeshlets(): expected non-zero max triangle count", {});
+
+    /* Meshlet-local index of each vertex or ~0 if the vertex isn't in the
+       current meshlet. Reset for vertices of each finished meshlet, so the
+       whole operation stays linear. */
+    Containers::Array<UnsignedInt> localIndex{DirectInit, positions.size(), ~UnsignedInt{}};
+    Containers::Array<Vector3> scratch{NoInit, maxVertexCount};
+
+    Containers::Array<Meshlet> meshlets;
+    Containers::Array<UnsignedInt> meshletVertices;
+    /* Each input triangle results in exactly three meshlet-local indices */
+    Containers::Array<UnsignedByte> meshletTriangles{NoInit, indices.size()};
+
+    Meshlet meshlet{0, 0, 0, 0, {}, 0.0f, {}, 0.0f};
+    for(std::size_t i = 0; i != indices.size(); i += 3) {
+        const UnsignedInt a = indices[i + 0];
+        const UnsignedInt b = indices[i + 1];
+        const UnsignedInt c = indices[i + 2];
+        #ifndef CORRADE_NO_ASSERT
+        for(const UnsignedInt vertex: {a, b, c})
+            CORRADE_ASSERT(vertex < positions.size(),
+                "MeshTools::generateMeshlets(): index" << vertex << "out of bounds for" << positions.size() << "elements", {});
+        #endif
+
+        /* Count how many new vertices the triangle would add, taking care of
+           degenerate triangles referencing the same vertex more than once */
+        const UnsignedInt newVertexCount =
+            (localIndex[a] == ~UnsignedInt{}) +
+            (localIndex[b] == ~UnsignedInt{} && b != a) +
+            (localIndex[c] == ~UnsignedInt{} && c != a && c != b);
+        if(meshlet.vertexCount + newVertexCount > maxVertexCount || meshlet.triangleCount == maxTriangleCount) {
+            finalizeMeshlet(meshlet, positions,
+                meshletVertices.exceptPrefix(meshlet.vertexOffset),
+                meshletTriangles.slice(meshlet.triangleOffset*3, i),
+                scratch);
+            arrayAppend(meshlets, meshlet);
+
+            for(const UnsignedInt vertex: meshletVertices.exceptPrefix(meshlet.vertexOffset))
+                localIndex[vertex] = ~UnsignedInt{};
+
+            meshlet = Meshlet{UnsignedInt(meshletVertices.size()), 0, UnsignedInt(i/3), 0, {}, 0.0f, {}, 0.0f};
+        }
+
+        for(std::size_t j = 0; j != 3; ++j) {
+            const UnsignedInt vertex = indices[i + j];
+            if(localIndex[vertex] == ~UnsignedInt{}) {
+                localIndex[vertex] = meshlet.vertexCount++;
+                arrayAppend(meshletVertices, vertex);
+            }
+            meshletTriangles[i + j] = UnsignedByte(localIndex[vertex]);
+        }
+
+        ++meshlet.triangleCount;
+    }
+
+    /* Add the last meshlet, if not empty */
+    if(meshlet.triangleCount) {
+        finalizeMeshlet(meshlet, positions,
+            meshletVertices.exceptPrefix(meshlet.vertexOffset),
+            meshletTriangles.exceptPrefix(meshlet.triangleOffset*3),
+            scratch);
+        arrayAppend(meshlets, meshlet);
+    }
+
+    /* Convert the growable arrays back to default deleters so the users don't
+       need to care */
+    arrayShrink(meshlets, DefaultInit);
+    arrayShrink(meshletVertices, DefaultInit);
+
+    return {std::move(meshlets), std::move(meshletVertices), std::move(meshletTriangles)};
+}
+
+}
+
+Containers::Triple<Containers::Array<Meshlet>, Containers::Array<UnsignedInt>, Containers::Array<UnsignedByte>> generateMeshlets(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt maxVertexCount, const UnsignedInt maxTriangleCount) {
+    return generateMeshletsImplementation(indices, positions, maxVertexCount, maxTriangleCount);
+}
+
+Containers::Triple<Containers::Array<Meshlet>, Containers::Array<UnsignedInt>, Containers::Array<UnsignedByte>> generateMeshlets(const Containers::StridedArrayView1D<const UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt maxVertexCount, const UnsignedInt maxTriangleCount) {
+    return generateMeshletsImplementation(indices, positions, maxVertexCount, maxTriangleCount);
+}
+
+Containers::Triple<Containers::Array<Meshlet>, Containers::Array<UnsignedInt>, Containers::Array<UnsignedByte>> generateMeshlets(const Containers::StridedArrayView1D<const UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt maxVertexCount, const UnsignedInt maxTriangleCount) {
+    return generateMeshletsImplementation(indices, positions, maxVertexCount, maxTriangleCount);
+}
+
+Containers::Triple<Containers::Array<Meshlet>, Containers::Array<UnsignedInt>, Containers::Array<UnsignedByte>> generateMeshlets(const Trade::MeshData& mesh, const UnsignedInt maxVertexCount, const UnsignedInt maxTriangleCount) {
+    CORRADE_ASSERT(mesh.primitive() == MeshPrimitive::Triangles,
+        "MeshTools::generateMeshlets(): expected a" << MeshPrimitive::Triangles << "mesh, got" << mesh.primitive(), {});
+    CORRADE_ASSERT(mesh.hasAttribute(Trade::MeshAttribute::Position),
+        "MeshTools::generateMeshlets(): the mesh has no positions", {});
+    CORRADE_ASSERT(!mesh.isIndexed() || !isMeshIndexTypeImplementationSpecific(mesh.indexType()),
+        "MeshTools::generateMeshlets(): mesh has an implementation-specific index type" << reinterpret_cast<void*>(meshIndexTypeUnwrap(mesh.indexType())), {});
+
+    const Containers::Array<Vector3> positions = mesh.positions3DAsArray();
+
+    /* For a non-indexed mesh generate a trivial index buffer */
+    Containers::Array<UnsignedInt> indices;
+    if(mesh.isIndexed())
+        indices = mesh.indicesAsArray();
+    else {
+        indices = Containers::Array<UnsignedInt>{NoInit, mesh.vertexCount()};
+        for(UnsignedInt i = 0; i != indices.size(); ++i)
+            indices[i] = i;
+    }
+
+    return generateMeshletsImplementation(Containers::StridedArrayView1D<const UnsignedInt>{indices}, positions, maxVertexCount, maxTriangleCount);
+}
+
+}}
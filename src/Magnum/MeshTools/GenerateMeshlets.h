@@ -0,0 +1,160 @@
+#ifndef Magnum_MeshTools_GenerateMeshlets_h
+#define Magnum_MeshTools_GenerateMeshlets_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Struct @ref Magnum::MeshTools::Meshlet, function @ref Magnum::MeshTools::generateMeshlets()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Triple.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Meshlet
+@m_since_latest
+
+A bounded cluster of triangles produced by @ref generateMeshlets(). The
+@ref vertexOffset and @ref vertexCount describe a range in the meshlet vertex
+array, which contains indices into the original vertex data. The
+@ref triangleOffset and @ref triangleCount describe a range of triangles in
+the meshlet triangle array, where each triangle is three meshlet-local vertex
+indices, i.e. indices into the @ref vertexOffset range.
+
+The @ref center and @ref radius describe a bounding sphere of the cluster,
+@ref coneAxis and @ref coneCutoff a cone enclosing normals of all triangles
+in the cluster. The whole meshlet can be discarded as backfacing if the
+following holds for a camera at @f$ \boldsymbol{c} @f$, with
+@f$ \boldsymbol{p} @f$ being the @ref center, @f$ r @f$ the @ref radius,
+@f$ \boldsymbol{a} @f$ the @ref coneAxis and @f$ t @f$ the @ref coneCutoff:
+@f[
+    (\boldsymbol{p} - \boldsymbol{c}) \cdot \boldsymbol{a} \ge
+    t |\boldsymbol{p} - \boldsymbol{c}| + r
+@f]
+
+If the normals don't fit into a cone narrower than a hemisphere or the cluster
+consists of degenerate triangles only, @ref coneCutoff is @cpp 1.0f @ce,
+making the above test always fail.
+@see @ref Math::Intersection::sphereFrustum()
+*/
+struct Meshlet {
+    /** @brief Offset into the meshlet vertex array */
+    UnsignedInt vertexOffset;
+
+    /** @brief Count of vertices in the meshlet vertex array */
+    UnsignedInt vertexCount;
+
+    /**
+     * @brief Offset into the meshlet triangle array
+     *
+     * In triangles, i.e. the actual offset in the meshlet triangle index
+     * array is three times this value.
+     */
+    UnsignedInt triangleOffset;
+
+    /** @brief Count of triangles in the meshlet triangle array */
+    UnsignedInt triangleCount;
+
+    /** @brief Bounding sphere center */
+    Vector3 center;
+
+    /** @brief Bounding sphere radius */
+    Float radius;
+
+    /** @brief Normal cone axis */
+    Vector3 coneAxis;
+
+    /** @brief Normal cone cutoff */
+    Float coneCutoff;
+};
+
+/**
+@brief Split a triangle mesh into meshlets
+@param indices          Triangle indices
+@param positions        Vertex positions
+@param maxVertexCount   Max count of unique vertices in a meshlet
+@param maxTriangleCount Max count of triangles in a meshlet
+@return Meshlets, meshlet vertex indices and meshlet-local triangle indices
+@m_since_latest
+
+Greedily walks the triangles in the order they are in @p indices and puts them
+into a meshlet until either @p maxVertexCount or @p maxTriangleCount would be
+exceeded, at which point a new meshlet is started. Because of that the
+clusters are as local as the input index order is, it's thus recommended to
+optimize the index buffer for vertex locality with @ref tipsifyInPlace()
+first. Bounding sphere of each meshlet is calculated using
+@ref boundingSphereBouncingBubble(), see the @ref Meshlet documentation for
+details about the normal cone.
+
+The first returned array contains the meshlets, the second vertex indices for
+each meshlet, pointing into @p positions, and the third meshlet-local triangle
+indices, three for each triangle. Meshlet-local indices are stored in bytes,
+so @p maxVertexCount is expected to be in range @cpp [3, 256] @ce,
+@p maxTriangleCount is expected to be non-zero. The @p indices are expected to
+have a size divisible by @cpp 3 @ce and all be in bounds of @p positions.
+Common values are @cpp 64 @ce vertices and @cpp 124 @ce triangles for NVidia
+mesh shaders.
+@see @ref generateMeshlets(const Trade::MeshData&, UnsignedInt, UnsignedInt)
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Triple<Containers::Array<Meshlet>, Containers::Array<UnsignedInt>, Containers::Array<UnsignedByte>> generateMeshlets(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt maxVertexCount, UnsignedInt maxTriangleCount);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT Containers::Triple<Containers::Array<Meshlet>, Containers::Array<UnsignedInt>, Containers::Array<UnsignedByte>> generateMeshlets(const Containers::StridedArrayView1D<const UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt maxVertexCount, UnsignedInt maxTriangleCount);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT Containers::Triple<Containers::Array<Meshlet>, Containers::Array<UnsignedInt>, Containers::Array<UnsignedByte>> generateMeshlets(const Containers::StridedArrayView1D<const UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt maxVertexCount, UnsignedInt maxTriangleCount);
+
+/**
+@brief Split a triangle mesh into meshlets
+@m_since_latest
+
+Expects that the mesh is a @ref MeshPrimitive::Triangles and has a
+@ref Trade::MeshAttribute::Position attribute, which then gets converted to
+@ref VertexFormat::Vector3 using @ref Trade::MeshData::positions3DAsArray().
+If the mesh is not indexed, it's treated as if each triangle had its own
+unique vertices. The index type, if present, is expected to not be
+implementation-specific. See
+@ref generateMeshlets(const Containers::StridedArrayView1D<const UnsignedInt>&, const Containers::StridedArrayView1D<const Vector3>&, UnsignedInt, UnsignedInt)
+for more information.
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Triple<Containers::Array<Meshlet>, Containers::Array<UnsignedInt>, Containers::Array<UnsignedByte>> generateMeshlets(const Trade::MeshData& mesh, UnsignedInt maxVertexCount, UnsignedInt maxTriangleCount);
+
+}}
+
+#endif
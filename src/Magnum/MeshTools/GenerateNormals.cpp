@@ -28,8 +28,11 @@
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/StridedArrayView.h>
 
+#include "Magnum/ProfileScope.h"
+#include "Magnum/Implementation/parallelFor.h"
 #include "Magnum/Math/Functions.h"
 #include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/Implementation/Tipsify.h"
 
 #ifdef MAGNUM_BUILD_DEPRECATED
 #include <vector>
@@ -46,10 +49,16 @@ void generateFlatNormalsInto(const Containers::StridedArrayView1D<const Vector3>
     CORRADE_ASSERT(normals.size() == positions.size(),
         "MeshTools::generateFlatNormalsInto(): bad output size, expected" << positions.size() << "but got" << normals.size(), );
 
-    for(std::size_t i = 0; i != positions.size(); i += 3)
-        normals[i] = normals[i + 1] = normals[i + 2] = Math::cross(
+    /* Not chaining the assignments to avoid reading the output back, which
+       may be a write-only mapped GPU buffer */
+    for(std::size_t i = 0; i != positions.size(); i += 3) {
+        const Vector3 normal = Math::cross(
             positions[i + 2] - positions[i + 1],
             positions[i] - positions[i+1]).normalized();
+        normals[i] = normal;
+        normals[i + 1] = normal;
+        normals[i + 2] = normal;
+    }
 }
 
 Containers::Array<Vector3> generateFlatNormals(const Containers::StridedArrayView1D<const Vector3>& positions) {
@@ -98,7 +107,97 @@ namespace {
 using namespace Math::Literals;
 #endif
 
+/* Calculates normals from a vertex-triangle adjacency, used by both
+   generateSmoothNormalsInto() and SmoothNormalsGenerator. The crossAngles
+   array is a scratch memory with one item for each triangle. Both passes
+   write only to items they own, so they're split across threads without any
+   synchronization, and each vertex accumulates its triangles in the same
+   order independently of the thread count. */
+template<class T, class U> void smoothNormalsFromAdjacencyInto(const Containers::StridedArrayView1D<const T>& indices, const Containers::ArrayView<const UnsignedInt> triangleOffset, const Containers::ArrayView<const U> triangleIds, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::ArrayView<std::pair<Vector3, Math::Vector3<Rad>>> crossAngles, const Containers::StridedArrayView1D<Vector3>& normals, const UnsignedInt threadCount) {
+    /* Precalculate cross product and interior angles of each face --- the loop
+       below would otherwise calculate it for every vertex, which is at least
+       3x as much work */
+    Magnum::Implementation::parallelFor(crossAngles.size(), threadCount, [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t i = begin; i != end; ++i) {
+            const Vector3 v0 = positions[indices[i*3 + 0]];
+            const Vector3 v1 = positions[indices[i*3 + 1]];
+            const Vector3 v2 = positions[indices[i*3 + 2]];
+
+            /* Cross product */
+            crossAngles[i].first = Math::cross(v2 - v1, v0 - v1);
+
+            /* If any of the vectors is zero, the normalization would result in
+               a NaN and the angle calculation will assert. This happens also
+               when any of the original positions is NaN. If that's the case,
+               skip the rest. Given triangle will then contribute with a zero
+               total angle, effectively getting ignored for normal
+               calculation. */
+            const Vector3 v10n = (v1 - v0).normalized();
+            const Vector3 v20n = (v2 - v0).normalized();
+            const Vector3 v21n = (v2 - v1).normalized();
+            if(Math::isNan(v10n) || Math::isNan(v20n) || Math::isNan(v21n)) {
+                crossAngles[i].second = Math::Vector3<Rad>{Math::ZeroInit};
+                continue;
+            }
+
+            /* Inner angle at each vertex of the triangle. The last one can be
+               calculated as a remainder to 180°. */
+            /* This using namespace doesn't work with MSVC2019 with /permissive-
+               (it gets lost when instantiating?!), so it's duplicated above */
+            using namespace Math::Literals;
+            crossAngles[i].second[0] = Math::angle(v10n, v20n);
+            crossAngles[i].second[1] = Math::angle(-v10n, v21n);
+            crossAngles[i].second[2] = Rad(180.0_degf)
+                - crossAngles[i].second[0] - crossAngles[i].second[1];
+        }
+    });
+
+    /* For every vertex v, calculate normals from all faces it belongs to and
+       average them */
+    Magnum::Implementation::parallelFor(positions.size(), threadCount, [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t v = begin; v != end; ++v) {
+            /* normals are an external memory, ensure we accumulate from zero */
+            normals[v] = Vector3{Math::ZeroInit};
+
+            /* Go through all triangles sharing this vertex */
+            for(std::size_t t = triangleOffset[v]; t != triangleOffset[v + 1]; ++t) {
+                const std::size_t baseIndex = std::size_t(triangleIds[t])*3;
+                const T v0i = indices[baseIndex + 0];
+                const T v1i = indices[baseIndex + 1];
+                const T v2i = indices[baseIndex + 2];
+
+                /* Cross product is a vector in direction of the normal with
+                   length equal to size of the parallelogram */
+                const std::pair<Vector3, Math::Vector3<Rad>>& crossAngle = crossAngles[triangleIds[t]];
+
+                /* Angle between two sides of the triangle that share vertex
+                   `v`. The shared vertex can be one of the three. */
+                Rad angle;
+                if(v == v0i) angle = crossAngle.second[0];
+                else if(v == v1i) angle = crossAngle.second[1];
+                else if(v == v2i) angle = crossAngle.second[2];
+                else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+
+                /* The normal is cross.normalized(), we need to multiply it it
+                   by surface area which is cross.length()/2. Since
+                   normalization is division by length, multiplying it by length
+                   again will be a no-op. Then, since all normals are divided by
+                   2, it doesn't change their ratio for the final normalization
+                   so we can omit that as well. Finally we need to weight by the
+                   angle, and in that case only the ratio is important as well,
+                   so it doesn't matter if degrees or radians. */
+                normals[v] += crossAngle.first*Float(angle);
+            }
+
+            /* Normalize the accumulated direction */
+            normals[v] = normals[v].normalized();
+        }
+    });
+}
+
 template<class T> inline void generateSmoothNormalsIntoImplementation(const Containers::StridedArrayView1D<const T>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals) {
+    MAGNUM_PROFILE_SCOPE("MeshTools::generateSmoothNormals()");
+
     CORRADE_ASSERT(indices.size() % 3 == 0,
         "MeshTools::generateSmoothNormalsInto(): index count not divisible by 3", );
     CORRADE_ASSERT(normals.size() == positions.size(),
@@ -144,81 +243,8 @@ template<class T> inline void generateSmoothNormalsIntoImplementation(const Cont
     /* Now, triangleCount should be all zeros, we don't need it anymore and the
        underlying `normals` array is ready to get filled with real output. */
 
-    /* Precalculate cross product and interior angles of each face --- the loop
-       below would otherwise calculate it for every vertex, which is at least
-       3x as much work */
     Containers::Array<std::pair<Vector3, Math::Vector3<Rad>>> crossAngles{NoInit, indices.size()/3};
-    for(std::size_t i = 0; i != crossAngles.size(); ++i) {
-        const Vector3 v0 = positions[indices[i*3 + 0]];
-        const Vector3 v1 = positions[indices[i*3 + 1]];
-        const Vector3 v2 = positions[indices[i*3 + 2]];
-
-        /* Cross product */
-        crossAngles[i].first = Math::cross(v2 - v1, v0 - v1);
-
-        /* If any of the vectors is zero, the normalization would result in a
-           NaN and the angle calculation will assert. This happens also when
-           any of the original positions is NaN. If that's the case, skip the
-           rest. Given triangle will then contribute with a zero total angle,
-           effectively getting ignored for normal calculation. */
-        const Vector3 v10n = (v1 - v0).normalized();
-        const Vector3 v20n = (v2 - v0).normalized();
-        const Vector3 v21n = (v2 - v1).normalized();
-        if(Math::isNan(v10n) || Math::isNan(v20n) || Math::isNan(v21n)) {
-            crossAngles[i].second = Math::Vector3<Rad>{Math::ZeroInit};
-            continue;
-        }
-
-        /* Inner angle at each vertex of the triangle. The last one can be
-           calculated as a remainder to 180°. */
-        /* This using namespace doesn't work with MSVC2019 with /permissive-
-           (it gets lost when instantiating?!), so it's duplicated above */
-        using namespace Math::Literals;
-        crossAngles[i].second[0] = Math::angle(v10n, v20n);
-        crossAngles[i].second[1] = Math::angle(-v10n, v21n);
-        crossAngles[i].second[2] = Rad(180.0_degf)
-            - crossAngles[i].second[0] - crossAngles[i].second[1];
-    }
-
-    /* For every vertex v, calculate normals from all faces it belongs to and
-       average them */
-    for(std::size_t v = 0; v != positions.size(); ++v) {
-        /* normals are an external memory, ensure we accumulate from zero */
-        normals[v] = Vector3{Math::ZeroInit};
-
-        /* Go through all triangles sharing this vertex */
-        for(std::size_t t = triangleOffset[v]; t != triangleOffset[v + 1]; ++t) {
-            const std::size_t baseIndex = triangleIds[t]*3;
-            const T v0i = indices[baseIndex + 0];
-            const T v1i = indices[baseIndex + 1];
-            const T v2i = indices[baseIndex + 2];
-
-            /* Cross product is a vector in direction of the normal with length
-               equal to size of the parallelogram */
-            const std::pair<Vector3, Math::Vector3<Rad>>& crossAngle = crossAngles[triangleIds[t]];
-
-            /* Angle between two sides of the triangle that share vertex `v`.
-               The shared vertex can be one of the three. */
-            Rad angle;
-            if(v == v0i) angle = crossAngle.second[0];
-            else if(v == v1i) angle = crossAngle.second[1];
-            else if(v == v2i) angle = crossAngle.second[2];
-            else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
-
-            /* The normal is cross.normalized(), we need to multiply it it by
-               surface area which is cross.length()/2. Since normalization is
-               division by length, multiplying it by length again will be a
-               no-op. Then, since all normals are divided by 2, it doesn't
-               change their ratio for the final normalization so we can omit
-               that as well. Finally we need to weight by the angle, and in
-               that case only the ratio is important as well, so it doesn't
-               matter if degrees or radians. */
-            normals[v] += crossAngle.first*Float(angle);
-        }
-
-        /* Normalize the accumulated direction */
-        normals[v] = normals[v].normalized();
-    }
+    smoothNormalsFromAdjacencyInto<T, T>(indices, triangleOffset, triangleIds, positions, crossAngles, normals, 1);
 }
 
 }
@@ -277,4 +303,85 @@ Containers::Array<Vector3> generateSmoothNormals(const Containers::StridedArrayV
     return out;
 }
 
+namespace {
+
+template<class T> Containers::Array<UnsignedInt> smoothNormalsGeneratorIndices(const Containers::StridedArrayView1D<const T>& indices, const UnsignedInt vertexCount) {
+    CORRADE_ASSERT(indices.size() % 3 == 0,
+        "MeshTools::SmoothNormalsGenerator: index count not divisible by 3", {});
+
+    Containers::Array<UnsignedInt> out{NoInit, indices.size()};
+    for(std::size_t i = 0; i != indices.size(); ++i) {
+        CORRADE_ASSERT(indices[i] < vertexCount,
+            "MeshTools::SmoothNormalsGenerator: index" << indices[i] << "out of bounds for" << vertexCount << "elements", {});
+        out[i] = indices[i];
+    }
+    #ifdef CORRADE_NO_ASSERT
+    static_cast<void>(vertexCount);
+    #endif
+    return out;
+}
+
+}
+
+SmoothNormalsGenerator::SmoothNormalsGenerator(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const UnsignedInt vertexCount): _vertexCount{vertexCount}, _indices{smoothNormalsGeneratorIndices(indices, vertexCount)} {
+    build();
+}
+
+SmoothNormalsGenerator::SmoothNormalsGenerator(const Containers::StridedArrayView1D<const UnsignedShort>& indices, const UnsignedInt vertexCount): _vertexCount{vertexCount}, _indices{smoothNormalsGeneratorIndices(indices, vertexCount)} {
+    build();
+}
+
+SmoothNormalsGenerator::SmoothNormalsGenerator(const Containers::StridedArrayView1D<const UnsignedByte>& indices, const UnsignedInt vertexCount): _vertexCount{vertexCount}, _indices{smoothNormalsGeneratorIndices(indices, vertexCount)} {
+    build();
+}
+
+SmoothNormalsGenerator::SmoothNormalsGenerator(const Containers::StridedArrayView2D<const char>& indices, const UnsignedInt vertexCount): _vertexCount{vertexCount} {
+    CORRADE_ASSERT(indices.isContiguous<1>(), "MeshTools::SmoothNormalsGenerator: second index view dimension is not contiguous", );
+    if(indices.size()[1] == 4)
+        _indices = smoothNormalsGeneratorIndices(Containers::arrayCast<1, const UnsignedInt>(indices), vertexCount);
+    else if(indices.size()[1] == 2)
+        _indices = smoothNormalsGeneratorIndices(Containers::arrayCast<1, const UnsignedShort>(indices), vertexCount);
+    else {
+        CORRADE_ASSERT(indices.size()[1] == 1, "MeshTools::SmoothNormalsGenerator: expected index type size 1, 2 or 4 but got" << indices.size()[1], );
+        _indices = smoothNormalsGeneratorIndices(Containers::arrayCast<1, const UnsignedByte>(indices), vertexCount);
+    }
+
+    build();
+}
+
+SmoothNormalsGenerator::SmoothNormalsGenerator(SmoothNormalsGenerator&&) noexcept = default;
+
+SmoothNormalsGenerator::~SmoothNormalsGenerator() = default;
+
+SmoothNormalsGenerator& SmoothNormalsGenerator::operator=(SmoothNormalsGenerator&&) noexcept = default;
+
+void SmoothNormalsGenerator::build() {
+    /* The per-vertex triangle count is not needed for anything here, it's
+       just an implementation detail of the adjacency building */
+    Containers::Array<UnsignedInt> triangleCount;
+    Implementation::buildAdjacency(Containers::StridedArrayView1D<const UnsignedInt>{_indices}, _vertexCount, triangleCount, _triangleOffset, _triangleIds);
+
+    /* Scratch memory reused by all generateInto() calls */
+    _crossAngles = Containers::Array<std::pair<Vector3, Math::Vector3<Rad>>>{NoInit, _indices.size()/3};
+}
+
+void SmoothNormalsGenerator::generateInto(const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(positions.size() == _vertexCount,
+        "MeshTools::SmoothNormalsGenerator::generateInto(): expected" << _vertexCount << "positions but got" << positions.size(), );
+    CORRADE_ASSERT(normals.size() == _vertexCount,
+        "MeshTools::SmoothNormalsGenerator::generateInto(): bad output size, expected" << _vertexCount << "but got" << normals.size(), );
+
+    /* Consistently with generateSmoothNormalsInto(), nothing to do for an
+       empty index buffer */
+    if(_indices.isEmpty()) return;
+
+    smoothNormalsFromAdjacencyInto<UnsignedInt, UnsignedInt>(_indices, _triangleOffset, _triangleIds, positions, _crossAngles, normals, threadCount);
+}
+
+Containers::Array<Vector3> SmoothNormalsGenerator::generate(const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt threadCount) {
+    Containers::Array<Vector3> out{NoInit, positions.size()};
+    generateInto(positions, out, threadCount);
+    return out;
+}
+
 }}
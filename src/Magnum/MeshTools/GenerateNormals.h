@@ -26,9 +26,12 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::generateFlatNormals(), @ref Magnum::MeshTools::generateFlatNormalsInto(), @ref Magnum::MeshTools::generateSmoothNormals(), @ref Magnum::MeshTools::generateSmoothNormalsInto()
+ * @brief Function @ref Magnum::MeshTools::generateFlatNormals(), @ref Magnum::MeshTools::generateFlatNormalsInto(), @ref Magnum::MeshTools::generateSmoothNormals(), @ref Magnum::MeshTools::generateSmoothNormalsInto(), class @ref Magnum::MeshTools::SmoothNormalsGenerator
  */
 
+#include <utility>
+#include <Corrade/Containers/Array.h>
+
 #include "Magnum/Magnum.h"
 #include "Magnum/MeshTools/visibility.h"
 
@@ -191,6 +194,108 @@ etc. overloads.
 */
 MAGNUM_MESHTOOLS_EXPORT void generateSmoothNormalsInto(const Containers::StridedArrayView2D<const char>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals);
 
+/**
+@brief Smooth normal generator with a reusable adjacency
+@m_since_latest
+
+Calculates the same output as @ref generateSmoothNormalsInto(), but the
+vertex-triangle adjacency is built just once in the constructor and then
+reused for any number of @ref generateInto() calls with different positions.
+Useful for meshes that deform every frame while keeping their topology, such
+as skinned or morphed meshes, as the steady state doesn't do any allocation:
+
+@snippet MagnumMeshTools.cpp SmoothNormalsGenerator
+
+The class keeps its own copy of the index buffer, so the original doesn't
+need to stay in scope.
+*/
+class MAGNUM_MESHTOOLS_EXPORT SmoothNormalsGenerator {
+    public:
+        /**
+         * @brief Constructor
+         * @param indices       Triangle face indices
+         * @param vertexCount   Vertex count
+         *
+         * Expects that the @p indices have a size divisible by @cpp 3 @ce and
+         * all are less than @p vertexCount.
+         */
+        explicit SmoothNormalsGenerator(const Containers::StridedArrayView1D<const UnsignedInt>& indices, UnsignedInt vertexCount);
+
+        /** @overload */
+        explicit SmoothNormalsGenerator(const Containers::StridedArrayView1D<const UnsignedShort>& indices, UnsignedInt vertexCount);
+
+        /** @overload */
+        explicit SmoothNormalsGenerator(const Containers::StridedArrayView1D<const UnsignedByte>& indices, UnsignedInt vertexCount);
+
+        /**
+         * @brief Construct with a type-erased index array
+         *
+         * Expects that the second dimension of @p indices is contiguous and
+         * represents the actual 1/2/4-byte index type. Based on its size then
+         * calls one of the
+         * @ref SmoothNormalsGenerator(const Containers::StridedArrayView1D<const UnsignedInt>&, UnsignedInt)
+         * etc. overloads.
+         */
+        explicit SmoothNormalsGenerator(const Containers::StridedArrayView2D<const char>& indices, UnsignedInt vertexCount);
+
+        /** @brief Copying is not allowed */
+        SmoothNormalsGenerator(const SmoothNormalsGenerator&) = delete;
+
+        /** @brief Move constructor */
+        SmoothNormalsGenerator(SmoothNormalsGenerator&&) noexcept;
+
+        ~SmoothNormalsGenerator();
+
+        /** @brief Copying is not allowed */
+        SmoothNormalsGenerator& operator=(const SmoothNormalsGenerator&) = delete;
+
+        /** @brief Move assignment */
+        SmoothNormalsGenerator& operator=(SmoothNormalsGenerator&&) noexcept;
+
+        /** @brief Vertex count */
+        UnsignedInt vertexCount() const { return _vertexCount; }
+
+        /** @brief Index count */
+        std::size_t indexCount() const { return _indices.size(); }
+
+        /**
+         * @brief Generate smooth normals into an existing array
+         * @param positions     Vertex positions
+         * @param normals       Where to put the generated normals
+         * @param threadCount   Max count of threads to use. If @cpp 0 @ce,
+         *      @ref TaskScheduler::threadCount() of
+         *      @ref TaskScheduler::global() is used.
+         *
+         * Expects that both @p positions and @p normals have a size equal to
+         * @ref vertexCount(). Doesn't allocate any memory on its own. The
+         * per-face cross products and angles and then the per-vertex
+         * accumulation over the cached adjacency are each split into up to
+         * @p threadCount ranges submitted to @ref TaskScheduler::global().
+         * Every vertex gathers the contributions of its faces in the same
+         * order on any thread, so the output is the same independently of
+         * @p threadCount.
+         * @see @ref generate()
+         */
+        void generateInto(const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals, UnsignedInt threadCount = 0);
+
+        /**
+         * @brief Generate smooth normals
+         *
+         * Allocates the output array and delegates to @ref generateInto().
+         */
+        Containers::Array<Vector3> generate(const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt threadCount = 0);
+
+    private:
+        void build();
+
+        UnsignedInt _vertexCount;
+        Containers::Array<UnsignedInt> _indices;
+        Containers::Array<UnsignedInt> _triangleOffset;
+        Containers::Array<UnsignedInt> _triangleIds;
+        /* Scratch memory for the calculation */
+        Containers::Array<std::pair<Vector3, Math::Vector3<Rad>>> _crossAngles;
+};
+
 }}
 
 #endif
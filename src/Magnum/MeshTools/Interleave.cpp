@@ -26,8 +26,10 @@
 #include "Interleave.h"
 
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pair.h>
 #include <Corrade/Utility/Algorithms.h>
 
+#include "Magnum/ProfileScope.h"
 #include "Magnum/Math/Functions.h"
 #include "Magnum/MeshTools/Reference.h"
 #include "Magnum/Trade/MeshData.h"
@@ -43,6 +45,89 @@ inline std::size_t attributeSize(const Trade::MeshData& data, UnsignedInt i) {
 inline std::size_t attributeSize(const Trade::MeshAttributeData& data) {
     return vertexFormatSize(data.format())*Math::max(data.arraySize(), UnsignedShort{1});
 }
+
+/* How many bytes of the destination to fill with all attributes before moving
+   to the next block. Small enough to stay in L1 cache on common hardware. */
+constexpr std::size_t InterleaveBlockSize = 16384;
+
+/* Converts offset-only attributes in the layout created by
+   Implementation::interleavedLayout() to absolute ones referencing
+   vertexData, and copies the original and extra attributes there. Instead of
+   going through the whole destination once for each attribute, the copy is
+   done in blocks of vertices so each destination block stays in cache until
+   all attributes are written into it. Returns false if an assertion
+   fails. */
+bool interleaveIntoLayout(const char* const messagePrefix, const Trade::MeshData& data, const Containers::ArrayView<const Trade::MeshAttributeData> extra, const Containers::ArrayView<char> vertexData, const Containers::ArrayView<Trade::MeshAttributeData> attributeData) {
+    const UnsignedInt vertexCount = data.vertexCount();
+    const std::size_t stride = attributeData[0].stride();
+
+    /* Gather source and destination views of all attributes that need
+       copying. The destination views are created with an unbounded size to
+       sidestep range assertions in case of implementation-specific formats
+       that conservatively occupy the whole stride, same as
+       Trade::MeshData::mutableAttribute() does. */
+    Containers::Array<Containers::Pair<Containers::StridedArrayView2D<const char>, Containers::StridedArrayView2D<char>>> copies{ValueInit, attributeData.size()};
+    std::size_t copyCount = 0;
+    const auto destination = [&](const UnsignedInt i, const std::size_t size) {
+        return Containers::StridedArrayView2D<char>{
+            {vertexData.data(), ~std::size_t{}},
+            vertexData.data() + attributeData[i].offset(vertexData),
+            {vertexCount, size},
+            {std::ptrdiff_t(stride), 1}};
+    };
+    for(UnsignedInt i = 0; i != data.attributeCount(); ++i) {
+        const Containers::StridedArrayView2D<const char> source = data.attribute(i);
+        copies[copyCount++] = {source, destination(i, source.size()[1])};
+    }
+
+    UnsignedInt attributeIndex = data.attributeCount();
+    for(UnsignedInt i = 0; i != extra.size(); ++i) {
+        /* Padding, ignore */
+        if(extra[i].format() == VertexFormat{}) continue;
+
+        /* Asserting here even though data() has another assert since that
+           one would be too confusing in this context */
+        CORRADE_ASSERT(!extra[i].isOffsetOnly(),
+            messagePrefix << "extra attribute" << i << "is offset-only, which is not supported", false);
+
+        /* Copy the attribute in, if it is non-empty, otherwise keep the
+           memory uninitialized */
+        if(extra[i].data()) {
+            CORRADE_ASSERT(extra[i].data().size() == vertexCount,
+                messagePrefix << "extra attribute" << i << "expected to have" << vertexCount << "items but got" << extra[i].data().size(), false);
+            copies[copyCount++] = {
+                Containers::arrayCast<2, const char>(extra[i].data(), attributeSize(extra[i])),
+                destination(attributeIndex, attributeSize(extra[i]))};
+        }
+
+        ++attributeIndex;
+    }
+
+    /* Convert the attributes from offset-only and zero vertex count to
+       absolute, referencing the destination */
+    for(Trade::MeshAttributeData& attribute: attributeData) {
+        attribute = Trade::MeshAttributeData{
+            attribute.name(), attribute.format(),
+            Containers::StridedArrayView1D<void>{vertexData,
+                vertexData + attribute.offset(vertexData),
+                vertexCount, attribute.stride()},
+            attribute.arraySize()};
+    }
+
+    #ifdef CORRADE_NO_ASSERT
+    static_cast<void>(messagePrefix);
+    #endif
+
+    const std::size_t verticesPerBlock = Math::max(std::size_t{1}, InterleaveBlockSize/Math::max(stride, std::size_t{1}));
+    for(std::size_t begin = 0; begin < vertexCount; begin += verticesPerBlock) {
+        const std::size_t end = Math::min(begin + verticesPerBlock, std::size_t(vertexCount));
+        for(std::size_t i = 0; i != copyCount; ++i)
+            Utility::copy(copies[i].first().slice(begin, end), copies[i].second().slice(begin, end));
+    }
+
+    return true;
+}
+
 Containers::Optional<Containers::StridedArrayView2D<const char>> interleavedDataInternal(const Trade::MeshData& data) {
     /* There is no attributes, return a zero-sized view to indicate a success */
     if(!data.attributeCount())
@@ -260,6 +345,8 @@ Trade::MeshData interleavedLayout(const Trade::MeshData& data, const UnsignedInt
 }
 
 Trade::MeshData interleave(Trade::MeshData&& data, const Containers::ArrayView<const Trade::MeshAttributeData> extra, const InterleaveFlags flags) {
+    MAGNUM_PROFILE_SCOPE("MeshTools::interleave()");
+
     /* Transfer the indices unchanged, in case the mesh is indexed */
     Containers::Array<char> indexData;
     Trade::MeshIndexData indices;
@@ -325,48 +412,20 @@ Trade::MeshData interleave(Trade::MeshData&& data, const Containers::ArrayView<c
     } else {
         /* Calculate the layout. Can't std::move() the data in to avoid copying
            the attribute array as we need the original attributes below. */
-        Trade::MeshData layout = interleavedLayout(data, vertexCount, extra, flags);
+        attributeData = Implementation::interleavedLayout(reference(data), extra, flags);
         #ifdef CORRADE_GRACEFUL_ASSERT
         /* If interleavedLayout() gracefully asserted and returned no
            attributes (but the original had some), exit right away to not blow
            up on something else later. Sorry, yes, this is shitty. */
-        if(!layout.attributeCount() && (data.attributeCount() || extra.size()))
+        if(!attributeData && (data.attributeCount() || extra.size()))
             return Trade::MeshData{MeshPrimitive::Points, 0};
         #endif
 
-        /* Copy existing attributes to new locations */
-        for(UnsignedInt i = 0; i != data.attributeCount(); ++i)
-            Utility::copy(data.attribute(i), layout.mutableAttribute(i));
-
-        /* Mix in the extra attributes */
-        UnsignedInt attributeIndex = data.attributeCount();
-        for(UnsignedInt i = 0; i != extra.size(); ++i) {
-            /* Padding, ignore */
-            if(extra[i].format() == VertexFormat{}) continue;
-
-            /* Asserting here even though data() has another assert since that
-               one would be too confusing in this context */
-            CORRADE_ASSERT(!extra[i].isOffsetOnly(),
-                "MeshTools::interleave(): extra attribute" << i << "is offset-only, which is not supported",
-                (Trade::MeshData{MeshPrimitive::Triangles, 0}));
-
-            /* Copy the attribute in, if it is non-empty, otherwise keep the
-               memory uninitialized */
-            if(extra[i].data()) {
-                CORRADE_ASSERT(extra[i].data().size() == vertexCount,
-                    "MeshTools::interleave(): extra attribute" << i << "expected to have" << vertexCount << "items but got" << extra[i].data().size(),
-                    (Trade::MeshData{MeshPrimitive::Triangles, 0}));
-                const Containers::StridedArrayView2D<const char> attribute =
-                    Containers::arrayCast<2, const char>(extra[i].data(), vertexFormatSize(extra[i].format()));
-                Utility::copy(attribute, layout.mutableAttribute(attributeIndex));
-            }
-
-            ++attributeIndex;
+        if(attributeData) {
+            vertexData = Containers::Array<char>{NoInit, attributeData[0].stride()*vertexCount};
+            if(!interleaveIntoLayout("MeshTools::interleave():", data, extra, vertexData, attributeData))
+                return Trade::MeshData{MeshPrimitive::Triangles, 0};
         }
-
-        /* Release the data from the layout to pack them into the output */
-        vertexData = layout.releaseVertexData();
-        attributeData = layout.releaseAttributeData();
     }
 
     return Trade::MeshData{data.primitive(), std::move(indexData), indices,
@@ -387,4 +446,30 @@ Trade::MeshData interleave(const Trade::MeshData& data, const std::initializer_l
     return interleave(std::move(data), Containers::arrayView(extra), flags);
 }
 
+std::size_t interleavedVertexDataSize(const Trade::MeshData& data, const Containers::ArrayView<const Trade::MeshAttributeData> extra, const InterleaveFlags flags) {
+    const Containers::Array<Trade::MeshAttributeData> attributeData = Implementation::interleavedLayout(reference(data), extra, flags);
+    return attributeData ? attributeData[0].stride()*data.vertexCount() : 0;
+}
+
+std::size_t interleavedVertexDataSize(const Trade::MeshData& data, const std::initializer_list<Trade::MeshAttributeData> extra, const InterleaveFlags flags) {
+    return interleavedVertexDataSize(data, Containers::arrayView(extra), flags);
+}
+
+Containers::Array<Trade::MeshAttributeData> interleaveInto(const Trade::MeshData& data, const Containers::ArrayView<char> vertexData, const Containers::ArrayView<const Trade::MeshAttributeData> extra, const InterleaveFlags flags) {
+    Containers::Array<Trade::MeshAttributeData> attributeData = Implementation::interleavedLayout(reference(data), extra, flags);
+    if(!attributeData) return {};
+
+    CORRADE_ASSERT(vertexData.size() == attributeData[0].stride()*data.vertexCount(),
+        "MeshTools::interleaveInto(): expected a buffer of" << attributeData[0].stride()*data.vertexCount() << "bytes but got" << vertexData.size(), {});
+
+    if(!interleaveIntoLayout("MeshTools::interleaveInto():", data, extra, vertexData, attributeData))
+        return {};
+
+    return attributeData;
+}
+
+Containers::Array<Trade::MeshAttributeData> interleaveInto(const Trade::MeshData& data, const Containers::ArrayView<char> vertexData, const std::initializer_list<Trade::MeshAttributeData> extra, const InterleaveFlags flags) {
+    return interleaveInto(data, vertexData, Containers::arrayView(extra), flags);
+}
+
 }}
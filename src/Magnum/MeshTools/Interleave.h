@@ -26,7 +26,7 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::interleave(), @ref Magnum::MeshTools::interleaveInto(), @ref Magnum::MeshTools::isInterleaved(), @ref Magnum::MeshTools::interleavedLayout()
+ * @brief Function @ref Magnum::MeshTools::interleave(), @ref Magnum::MeshTools::interleaveInto(), @ref Magnum::MeshTools::isInterleaved(), @ref Magnum::MeshTools::interleavedLayout(), @ref Magnum::MeshTools::interleavedVertexDataSize()
  */
 
 #include <cstring>
@@ -355,6 +355,54 @@ MAGNUM_MESHTOOLS_EXPORT Trade::MeshData interleave(Trade::MeshData&& data, Conta
  */
 MAGNUM_MESHTOOLS_EXPORT Trade::MeshData interleave(Trade::MeshData&& data, std::initializer_list<Trade::MeshAttributeData> extra, InterleaveFlags flags = InterleaveFlag::PreserveInterleavedAttributes);
 
+/**
+@brief Size of interleaved mesh vertex data
+@m_since_latest
+
+Returns size of the vertex data that @ref interleave(const Trade::MeshData&, Containers::ArrayView<const Trade::MeshAttributeData>, InterleaveFlags)
+would allocate for given @p data, @p extra and @p flags. Meant to be used for
+allocating a destination for
+@ref interleaveInto(const Trade::MeshData&, Containers::ArrayView<char>, Containers::ArrayView<const Trade::MeshAttributeData>, InterleaveFlags).
+Returns @cpp 0 @ce if the mesh has no attributes and there's no @p extra
+attributes.
+*/
+MAGNUM_MESHTOOLS_EXPORT std::size_t interleavedVertexDataSize(const Trade::MeshData& data, Containers::ArrayView<const Trade::MeshAttributeData> extra = {}, InterleaveFlags flags = InterleaveFlag::PreserveInterleavedAttributes);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT std::size_t interleavedVertexDataSize(const Trade::MeshData& data, std::initializer_list<Trade::MeshAttributeData> extra, InterleaveFlags flags = InterleaveFlag::PreserveInterleavedAttributes);
+
+/**
+@brief Interleave mesh vertex data into an existing buffer
+@return Attribute data referencing @p vertexData
+@m_since_latest
+
+Produces the same vertex data layout as @ref interleave(const Trade::MeshData&, Containers::ArrayView<const Trade::MeshAttributeData>, InterleaveFlags),
+but writes it to a caller-provided @p vertexData instead of allocating a new
+array, which can be for example a memory-mapped GPU buffer. Expects that the
+size of @p vertexData is exactly @ref interleavedVertexDataSize() for given
+@p data, @p extra and @p flags. Index data, if any, are not touched in any
+way. Gaps and padding in the destination are left untouched.
+
+The returned attributes can be used to create a non-owning
+@ref Trade::MeshData instance referencing @p vertexData. Returns an empty
+array if the mesh has no attributes and there's no @p extra attributes.
+
+The data are copied in blocks of vertices, with all attributes written to one
+block before moving to the next, so the destination block is still in cache
+for all attributes. The same is done by @ref interleave() internally. Same
+restrictions for @p extra and attribute formats as in @ref interleave() apply.
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<Trade::MeshAttributeData> interleaveInto(const Trade::MeshData& data, Containers::ArrayView<char> vertexData, Containers::ArrayView<const Trade::MeshAttributeData> extra = {}, InterleaveFlags flags = InterleaveFlag::PreserveInterleavedAttributes);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<Trade::MeshAttributeData> interleaveInto(const Trade::MeshData& data, Containers::ArrayView<char> vertexData, std::initializer_list<Trade::MeshAttributeData> extra, InterleaveFlags flags = InterleaveFlag::PreserveInterleavedAttributes);
+
 namespace Implementation {
 
 /* Used internally by interleavedLayout() and concatenate() */
@@ -0,0 +1,499 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Optimize.h"
+
+#include <algorithm>
+#include <numeric>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+
+#include "Magnum/ProfileScope.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/Interleave.h"
+#include "Magnum/MeshTools/Reference.h"
+#include "Magnum/MeshTools/Implementation/Tipsify.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Parameters from the paper */
+constexpr UnsignedInt ForsythCacheSize = 32;
+constexpr Float ForsythCacheDecayPower = 1.5f;
+constexpr Float ForsythLastTriangleScore = 0.75f;
+constexpr Float ForsythValenceBoostScale = 2.0f;
+constexpr Float ForsythValenceBoostPower = 0.5f;
+
+Float forsythVertexScore(const Int cachePosition, const UnsignedInt liveTriangleCount) {
+    /* No triangles left that would use this vertex */
+    if(!liveTriangleCount) return -1.0f;
+
+    Float score = 0.0f;
+    if(cachePosition >= 0) {
+        /* Vertices of the last triangle get a fixed score, to avoid using
+           them right again, which is wasteful for strip-like access */
+        if(cachePosition < 3) score = ForsythLastTriangleScore;
+        else score = Math::pow(1.0f - Float(cachePosition - 3)/Float(ForsythCacheSize - 3), ForsythCacheDecayPower);
+    }
+
+    /* Boost vertices with only a few triangles left so they get finished
+       sooner and don't leave lone triangles behind */
+    return score + ForsythValenceBoostScale*Math::pow(Float(liveTriangleCount), -ForsythValenceBoostPower);
+}
+
+template<class T> void optimizeVertexCacheInPlaceImplementation(const Containers::StridedArrayView1D<T>& indices, const UnsignedInt vertexCount) {
+    CORRADE_ASSERT(indices.size() % 3 == 0,
+        "MeshTools::optimizeVertexCacheInPlace(): index count" << indices.size() << "not divisible by 3", );
+    #ifndef CORRADE_NO_ASSERT
+    for(const T index: indices)
+        CORRADE_ASSERT(index < vertexCount,
+            "MeshTools::optimizeVertexCacheInPlace(): index" << index << "out of bounds for" << vertexCount << "elements", );
+    #endif
+
+    const std::size_t triangleCount = indices.size()/3;
+    if(!triangleCount) return;
+
+    /* Neighboring triangles for each vertex, per-vertex live triangle count */
+    Containers::Array<UnsignedInt> liveTriangleCount, neighborOffset, neighbors;
+    Implementation::buildAdjacency<T>(indices, vertexCount, liveTriangleCount, neighborOffset, neighbors);
+
+    /* Per-vertex position in the simulated LRU cache and score */
+    Containers::Array<Int> cachePosition{DirectInit, vertexCount, -1};
+    Containers::Array<Float> vertexScore{NoInit, vertexCount};
+    for(UnsignedInt i = 0; i != vertexCount; ++i)
+        vertexScore[i] = forsythVertexScore(-1, liveTriangleCount[i]);
+
+    /** @todo Have some bitset/staticbitset class for this */
+    Containers::Array<bool> emitted{triangleCount};
+
+    /* Output index buffer */
+    Containers::Array<T> outputIndices{NoInit, indices.size()};
+
+    /* Cache contents. The extra three slots are for vertices that get evicted
+       by the newly added triangle, whose scores need to be updated as well. */
+    UnsignedInt cache[ForsythCacheSize + 3];
+    UnsignedInt newCache[ForsythCacheSize + 3];
+    std::size_t cacheSize = 0;
+
+    /* Initially pick the triangle with the best score */
+    std::size_t bestTriangle = 0;
+    {
+        Float bestScore = -Constants::inf();
+        for(std::size_t i = 0; i != triangleCount; ++i) {
+            const Float score = vertexScore[indices[i*3 + 0]] + vertexScore[indices[i*3 + 1]] + vertexScore[indices[i*3 + 2]];
+            if(score > bestScore) {
+                bestScore = score;
+                bestTriangle = i;
+            }
+        }
+    }
+
+    /* Cursor for picking the next triangle if there's nothing left in the
+       cache neighborhood. Goes only forward, so the whole operation stays
+       linear. */
+    std::size_t nextTriangle = 0;
+    for(std::size_t i = 0; i != triangleCount; ++i) {
+        if(bestTriangle == ~std::size_t{}) {
+            while(emitted[nextTriangle]) ++nextTriangle;
+            bestTriangle = nextTriangle;
+        }
+
+        const std::size_t t = bestTriangle;
+        emitted[t] = true;
+
+        /* Vertices of the emitted triangle go to the front of the cache, the
+           previous contents after. Degenerate triangles reference some
+           vertices more than once, add them just once. */
+        std::size_t newCacheSize = 0;
+        for(std::size_t j = 0; j != 3; ++j) {
+            const UnsignedInt v = indices[t*3 + j];
+            outputIndices[i*3 + j] = v;
+            --liveTriangleCount[v];
+
+            if(std::find(newCache, newCache + newCacheSize, v) == newCache + newCacheSize)
+                newCache[newCacheSize++] = v;
+        }
+        const std::size_t triangleVertexCount = newCacheSize;
+        for(std::size_t j = 0; j != cacheSize; ++j) {
+            const UnsignedInt v = cache[j];
+            if(std::find(newCache, newCache + triangleVertexCount, v) == newCache + triangleVertexCount)
+                newCache[newCacheSize++] = v;
+        }
+
+        /* Update cache positions and scores of all vertices in the cache,
+           including the ones that fell out of it */
+        for(std::size_t j = 0; j != newCacheSize; ++j) {
+            const UnsignedInt v = newCache[j];
+            cachePosition[v] = j < ForsythCacheSize ? Int(j) : -1;
+            vertexScore[v] = forsythVertexScore(cachePosition[v], liveTriangleCount[v]);
+        }
+
+        /* Pick the best triangle among the ones that are neighbors of
+           vertices with updated scores */
+        bestTriangle = ~std::size_t{};
+        Float bestScore = -Constants::inf();
+        for(std::size_t j = 0; j != newCacheSize; ++j) {
+            const UnsignedInt v = newCache[j];
+            for(UnsignedInt ti = neighborOffset[v]; ti != neighborOffset[v + 1]; ++ti) {
+                const UnsignedInt neighbor = neighbors[ti];
+                if(emitted[neighbor]) continue;
+
+                const Float score = vertexScore[indices[neighbor*3 + 0]] + vertexScore[indices[neighbor*3 + 1]] + vertexScore[indices[neighbor*3 + 2]];
+                if(score > bestScore) {
+                    bestScore = score;
+                    bestTriangle = neighbor;
+                }
+            }
+        }
+
+        /* Keep only what fits into the cache */
+        cacheSize = Math::min(newCacheSize, std::size_t(ForsythCacheSize));
+        for(std::size_t j = 0; j != cacheSize; ++j)
+            cache[j] = newCache[j];
+    }
+
+    /* Swap original index buffer with optimized */
+    Utility::copy(outputIndices, indices);
+}
+
+template<class T> void optimizeOverdrawInPlaceImplementation(const Containers::StridedArrayView1D<T>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt cacheSize) {
+    CORRADE_ASSERT(indices.size() % 3 == 0,
+        "MeshTools::optimizeOverdrawInPlace(): index count" << indices.size() << "not divisible by 3", );
+    CORRADE_ASSERT(cacheSize,
+        "MeshTools::optimizeOverdrawInPlace(): expected non-zero cache size", );
+    #ifndef CORRADE_NO_ASSERT
+    for(const T index: indices)
+        CORRADE_ASSERT(index < positions.size(),
+            "MeshTools::optimizeOverdrawInPlace(): index" << index << "out of bounds for" << positions.size() << "elements", );
+    #endif
+
+    const std::size_t triangleCount = indices.size()/3;
+    if(!triangleCount) return;
+
+    /* Split the triangles into clusters at hard boundaries, i.e. triangles
+       where all three vertices are a cache miss. Reordering there doesn't
+       affect the vertex cache efficiency. Caching timestamps work the same as
+       in tipsify(). */
+    Containers::Array<UnsignedInt> clusterOffsets;
+    {
+        UnsignedInt time = cacheSize + 1;
+        Containers::Array<UnsignedInt> timestamp{positions.size()};
+        for(std::size_t i = 0; i != triangleCount; ++i) {
+            UnsignedInt misses = 0;
+            for(std::size_t j = 0; j != 3; ++j) {
+                const UnsignedInt v = indices[i*3 + j];
+                if(time - timestamp[v] > cacheSize) {
+                    timestamp[v] = time++;
+                    ++misses;
+                }
+            }
+
+            if(!i || misses == 3) arrayAppend(clusterOffsets, UnsignedInt(i));
+        }
+        arrayAppend(clusterOffsets, UnsignedInt(triangleCount));
+    }
+    const std::size_t clusterCount = clusterOffsets.size() - 1;
+
+    /* Area-weighted centroids and normals of each cluster, and of the whole
+       mesh. Using twice the area since the factor doesn't matter. */
+    Vector3 meshCentroid;
+    Float meshArea = 0.0f;
+    Containers::Array<Vector3> clusterCentroid{ValueInit, clusterCount};
+    Containers::Array<Vector3> clusterNormal{ValueInit, clusterCount};
+    for(std::size_t cluster = 0; cluster != clusterCount; ++cluster) {
+        Float clusterArea = 0.0f;
+        for(std::size_t i = clusterOffsets[cluster]; i != clusterOffsets[cluster + 1]; ++i) {
+            const Vector3& a = positions[indices[i*3 + 0]];
+            const Vector3& b = positions[indices[i*3 + 1]];
+            const Vector3& c = positions[indices[i*3 + 2]];
+            const Vector3 normal = Math::cross(b - a, c - a);
+            const Float area = normal.length();
+            const Vector3 centroid = (a + b + c)/3.0f;
+
+            clusterCentroid[cluster] += centroid*area;
+            clusterNormal[cluster] += normal;
+            clusterArea += area;
+        }
+
+        meshCentroid += clusterCentroid[cluster];
+        meshArea += clusterArea;
+        if(clusterArea > 0.0f) clusterCentroid[cluster] /= clusterArea;
+    }
+    if(meshArea > 0.0f) meshCentroid /= meshArea;
+
+    /* Clusters facing outwards of the mesh center are drawn first. Clusters
+       of only degenerate triangles are put at the end as they're invisible
+       anyway. */
+    Containers::Array<Float> sortKey{NoInit, clusterCount};
+    for(std::size_t cluster = 0; cluster != clusterCount; ++cluster) {
+        const Float normalLength = clusterNormal[cluster].length();
+        sortKey[cluster] = normalLength > 0.0f ?
+            Math::dot(clusterCentroid[cluster] - meshCentroid, clusterNormal[cluster]/normalLength) :
+            -Constants::inf();
+    }
+
+    /* Stable sort to have the output deterministic */
+    Containers::Array<UnsignedInt> clusterOrder{NoInit, clusterCount};
+    std::iota(clusterOrder.begin(), clusterOrder.end(), 0);
+    std::stable_sort(clusterOrder.begin(), clusterOrder.end(), [&sortKey](UnsignedInt a, UnsignedInt b) {
+        return sortKey[a] > sortKey[b];
+    });
+
+    /* Output index buffer */
+    Containers::Array<T> outputIndices{NoInit, indices.size()};
+    std::size_t outputIndex = 0;
+    for(const UnsignedInt c: clusterOrder)
+        for(std::size_t i = clusterOffsets[c]*3; i != clusterOffsets[c + 1]*3; ++i)
+            outputIndices[outputIndex++] = indices[i];
+    CORRADE_INTERNAL_ASSERT(outputIndex == indices.size());
+
+    /* Swap original index buffer with optimized */
+    Utility::copy(outputIndices, indices);
+}
+
+template<class T> std::size_t optimizeVertexFetchInPlaceImplementation(const Containers::StridedArrayView1D<T>& indices, const Containers::StridedArrayView2D<char>& data) {
+    const std::size_t vertexCount = data.size()[0];
+
+    /* New index of each vertex, in order of first reference */
+    Containers::Array<UnsignedInt> remap{DirectInit, vertexCount, ~UnsignedInt{}};
+    std::size_t referencedCount = 0;
+    for(std::size_t i = 0; i != indices.size(); ++i) {
+        const T index = indices[i];
+        CORRADE_ASSERT(index < vertexCount,
+            "MeshTools::optimizeVertexFetchInPlace(): index" << index << "out of bounds for" << vertexCount << "elements", {});
+        if(remap[index] == ~UnsignedInt{})
+            remap[index] = referencedCount++;
+        indices[i] = T(remap[index]);
+    }
+
+    /* Unreferenced vertices go after, in their original order */
+    std::size_t nextIndex = referencedCount;
+    for(std::size_t i = 0; i != vertexCount; ++i)
+        if(remap[i] == ~UnsignedInt{}) remap[i] = nextIndex++;
+    CORRADE_INTERNAL_ASSERT(nextIndex == vertexCount);
+
+    /* Make a copy of the data and scatter it back in the new order */
+    Containers::Array<char> dataCopy{NoInit, data.size()[0]*data.size()[1]};
+    const Containers::StridedArrayView2D<char> dataCopyView{dataCopy, data.size()};
+    Utility::copy(data, dataCopyView);
+    for(std::size_t i = 0; i != vertexCount; ++i)
+        Utility::copy(dataCopyView[i], data[remap[i]]);
+
+    return referencedCount;
+}
+
+}
+
+void optimizeVertexCacheInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const UnsignedInt vertexCount) {
+    optimizeVertexCacheInPlaceImplementation(indices, vertexCount);
+}
+
+void optimizeVertexCacheInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const UnsignedInt vertexCount) {
+    optimizeVertexCacheInPlaceImplementation(indices, vertexCount);
+}
+
+void optimizeVertexCacheInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const UnsignedInt vertexCount) {
+    optimizeVertexCacheInPlaceImplementation(indices, vertexCount);
+}
+
+void optimizeVertexCacheInPlace(const Containers::StridedArrayView2D<char>& indices, const UnsignedInt vertexCount) {
+    CORRADE_ASSERT(indices.isContiguous<1>(), "MeshTools::optimizeVertexCacheInPlace(): second index view dimension is not contiguous", );
+    if(indices.size()[1] == 4)
+        return optimizeVertexCacheInPlaceImplementation(Containers::arrayCast<1, UnsignedInt>(indices), vertexCount);
+    else if(indices.size()[1] == 2)
+        return optimizeVertexCacheInPlaceImplementation(Containers::arrayCast<1, UnsignedShort>(indices), vertexCount);
+    else {
+        CORRADE_ASSERT(indices.size()[1] == 1, "MeshTools::optimizeVertexCacheInPlace(): expected index type size 1, 2 or 4 but got" << indices.size()[1], );
+        return optimizeVertexCacheInPlaceImplementation(Containers::arrayCast<1, UnsignedByte>(indices), vertexCount);
+    }
+}
+
+void optimizeOverdrawInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt cacheSize) {
+    optimizeOverdrawInPlaceImplementation(indices, positions, cacheSize);
+}
+
+void optimizeOverdrawInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt cacheSize) {
+    optimizeOverdrawInPlaceImplementation(indices, positions, cacheSize);
+}
+
+void optimizeOverdrawInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt cacheSize) {
+    optimizeOverdrawInPlaceImplementation(indices, positions, cacheSize);
+}
+
+void optimizeOverdrawInPlace(const Containers::StridedArrayView2D<char>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt cacheSize) {
+    CORRADE_ASSERT(indices.isContiguous<1>(), "MeshTools::optimizeOverdrawInPlace(): second index view dimension is not contiguous", );
+    if(indices.size()[1] == 4)
+        return optimizeOverdrawInPlaceImplementation(Containers::arrayCast<1, UnsignedInt>(indices), positions, cacheSize);
+    else if(indices.size()[1] == 2)
+        return optimizeOverdrawInPlaceImplementation(Containers::arrayCast<1, UnsignedShort>(indices), positions, cacheSize);
+    else {
+        CORRADE_ASSERT(indices.size()[1] == 1, "MeshTools::optimizeOverdrawInPlace(): expected index type size 1, 2 or 4 but got" << indices.size()[1], );
+        return optimizeOverdrawInPlaceImplementation(Containers::arrayCast<1, UnsignedByte>(indices), positions, cacheSize);
+    }
+}
+
+std::size_t optimizeVertexFetchInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView2D<char>& data) {
+    return optimizeVertexFetchInPlaceImplementation(indices, data);
+}
+
+std::size_t optimizeVertexFetchInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView2D<char>& data) {
+    return optimizeVertexFetchInPlaceImplementation(indices, data);
+}
+
+std::size_t optimizeVertexFetchInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView2D<char>& data) {
+    return optimizeVertexFetchInPlaceImplementation(indices, data);
+}
+
+std::size_t optimizeVertexFetchInPlace(const Containers::StridedArrayView2D<char>& indices, const Containers::StridedArrayView2D<char>& data) {
+    CORRADE_ASSERT(indices.isContiguous<1>(), "MeshTools::optimizeVertexFetchInPlace(): second index view dimension is not contiguous", {});
+    if(indices.size()[1] == 4)
+        return optimizeVertexFetchInPlaceImplementation(Containers::arrayCast<1, UnsignedInt>(indices), data);
+    else if(indices.size()[1] == 2)
+        return optimizeVertexFetchInPlaceImplementation(Containers::arrayCast<1, UnsignedShort>(indices), data);
+    else {
+        CORRADE_ASSERT(indices.size()[1] == 1, "MeshTools::optimizeVertexFetchInPlace(): expected index type size 1, 2 or 4 but got" << indices.size()[1], {});
+        return optimizeVertexFetchInPlaceImplementation(Containers::arrayCast<1, UnsignedByte>(indices), data);
+    }
+}
+
+Trade::MeshData optimizeVertexCache(Trade::MeshData&& data) {
+    MAGNUM_PROFILE_SCOPE("MeshTools::optimizeVertexCache()");
+
+    CORRADE_ASSERT(data.isIndexed(),
+        "MeshTools::optimizeVertexCache(): mesh data not indexed",
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+    CORRADE_ASSERT(data.primitive() == MeshPrimitive::Triangles,
+        "MeshTools::optimizeVertexCache(): expected a" << MeshPrimitive::Triangles << "mesh, got" << data.primitive(),
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+    CORRADE_ASSERT(!isMeshIndexTypeImplementationSpecific(data.indexType()),
+        "MeshTools::optimizeVertexCache(): mesh has an implementation-specific index type" << reinterpret_cast<void*>(meshIndexTypeUnwrap(data.indexType())),
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+
+    /* Make the data owned if not already, the vertex data are then passed
+       through unchanged */
+    Trade::MeshData out = owned(std::move(data));
+    optimizeVertexCacheInPlace(out.mutableIndices(), out.vertexCount());
+    return out;
+}
+
+Trade::MeshData optimizeVertexCache(const Trade::MeshData& data) {
+    /* Pass through to the && overload, which then decides whether to reuse
+       anything based on the DataFlags */
+    return optimizeVertexCache(reference(data));
+}
+
+Trade::MeshData optimizeOverdraw(Trade::MeshData&& data, const UnsignedInt cacheSize) {
+    MAGNUM_PROFILE_SCOPE("MeshTools::optimizeOverdraw()");
+
+    CORRADE_ASSERT(data.isIndexed(),
+        "MeshTools::optimizeOverdraw(): mesh data not indexed",
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+    CORRADE_ASSERT(data.primitive() == MeshPrimitive::Triangles,
+        "MeshTools::optimizeOverdraw(): expected a" << MeshPrimitive::Triangles << "mesh, got" << data.primitive(),
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+    CORRADE_ASSERT(!isMeshIndexTypeImplementationSpecific(data.indexType()),
+        "MeshTools::optimizeOverdraw(): mesh has an implementation-specific index type" << reinterpret_cast<void*>(meshIndexTypeUnwrap(data.indexType())),
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+    CORRADE_ASSERT(data.hasAttribute(Trade::MeshAttribute::Position),
+        "MeshTools::optimizeOverdraw(): the mesh has no positions",
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+
+    /* Make the data owned if not already, the vertex data are then passed
+       through unchanged */
+    Trade::MeshData out = owned(std::move(data));
+    optimizeOverdrawInPlace(out.mutableIndices(), out.positions3DAsArray(), cacheSize);
+    return out;
+}
+
+Trade::MeshData optimizeOverdraw(const Trade::MeshData& data, const UnsignedInt cacheSize) {
+    /* Pass through to the && overload, which then decides whether to reuse
+       anything based on the DataFlags */
+    return optimizeOverdraw(reference(data), cacheSize);
+}
+
+Trade::MeshData optimizeVertexFetch(const Trade::MeshData& data) {
+    MAGNUM_PROFILE_SCOPE("MeshTools::optimizeVertexFetch()");
+
+    CORRADE_ASSERT(data.isIndexed(),
+        "MeshTools::optimizeVertexFetch(): mesh data not indexed",
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+    CORRADE_ASSERT(data.attributeCount(),
+        "MeshTools::optimizeVertexFetch(): can't optimize vertex fetch of an attributeless mesh",
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+    CORRADE_ASSERT(!isMeshIndexTypeImplementationSpecific(data.indexType()),
+        "MeshTools::optimizeVertexFetch(): mesh has an implementation-specific index type" << reinterpret_cast<void*>(meshIndexTypeUnwrap(data.indexType())),
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+    #ifndef CORRADE_NO_ASSERT
+    for(std::size_t i = 0; i != data.attributeCount(); ++i) {
+        const VertexFormat format = data.attributeFormat(i);
+        CORRADE_ASSERT(!isVertexFormatImplementationSpecific(format),
+            "MeshTools::optimizeVertexFetch(): attribute" << i << "has an implementation-specific format" << reinterpret_cast<void*>(vertexFormatUnwrap(format)),
+            (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+    }
+    #endif
+
+    /* Turn the passed data into an interleaved owned mutable instance we can
+       operate on */
+    Trade::MeshData ownedInterleaved = owned(interleave(data, {}, InterleaveFlags{}));
+
+    /* Because the interleaved mesh was forced to be repacked, the vertex data
+       should span the whole stride -- this is relied on in the attribute
+       rerouting loop below */
+    const Containers::StridedArrayView2D<char> vertexData = MeshTools::interleavedMutableData(ownedInterleaved);
+    CORRADE_INTERNAL_ASSERT(vertexData.size()[1] == std::size_t(ownedInterleaved.attributeStride(0)));
+
+    const UnsignedInt referencedVertexCount = optimizeVertexFetchInPlace(ownedInterleaved.mutableIndices(), vertexData);
+
+    const MeshIndexType indexType = ownedInterleaved.indexType();
+    Containers::Array<char> indexData = ownedInterleaved.releaseIndexData();
+
+    /* Allocate a new, shorter vertex data and copy the referenced prefix */
+    Containers::Array<char> referencedVertexData{NoInit, referencedVertexCount*vertexData.size()[1]};
+    Utility::copy(vertexData.prefix(referencedVertexCount),
+        Containers::StridedArrayView2D<char>{referencedVertexData, {referencedVertexCount, vertexData.size()[1]}});
+
+    /* Route all attributes to the new vertex data */
+    Containers::Array<Trade::MeshAttributeData> attributeData{ownedInterleaved.attributeCount()};
+    for(UnsignedInt i = 0; i != ownedInterleaved.attributeCount(); ++i)
+        attributeData[i] = Trade::MeshAttributeData{ownedInterleaved.attributeName(i),
+            ownedInterleaved.attributeFormat(i),
+            Containers::StridedArrayView1D<void>{referencedVertexData,
+                referencedVertexData.data() + ownedInterleaved.attributeOffset(i),
+                referencedVertexCount,
+                ownedInterleaved.attributeStride(i)},
+            ownedInterleaved.attributeArraySize(i)};
+
+    Trade::MeshIndexData indices{indexType, indexData};
+    return Trade::MeshData{ownedInterleaved.primitive(),
+        std::move(indexData), indices,
+        std::move(referencedVertexData), std::move(attributeData),
+        referencedVertexCount};
+}
+
+}}
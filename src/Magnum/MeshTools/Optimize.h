@@ -0,0 +1,232 @@
+#ifndef Magnum_MeshTools_Optimize_h
+#define Magnum_MeshTools_Optimize_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::optimizeVertexCacheInPlace(), @ref Magnum::MeshTools::optimizeOverdrawInPlace(), @ref Magnum::MeshTools::optimizeVertexFetchInPlace(), @ref Magnum::MeshTools::optimizeVertexCache(), @ref Magnum::MeshTools::optimizeOverdraw(), @ref Magnum::MeshTools::optimizeVertexFetch()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Optimize a triangle index buffer for post-transform vertex cache in-place
+@param[in,out] indices  Index array to operate on
+@param[in] vertexCount  Vertex count
+@m_since_latest
+
+Compared to @ref tipsifyInPlace() the algorithm doesn't need to know the
+actual post-transform vertex cache size, as it assumes a LRU cache with
+scores decaying with position, which generalizes well across FIFO cache
+implementations of various sizes as well. The @p indices are expected to have
+a size divisible by @cpp 3 @ce and all be less than @p vertexCount. Algorithm
+used: *Tom Forsyth --- Linear-Speed Vertex Cache Optimisation, 2006,
+https://tomforsyth1000.github.io/papers/fast_vert_cache_opt.html*.
+@see @ref optimizeOverdrawInPlace(), @ref optimizeVertexFetchInPlace(),
+    @ref optimizeVertexCache(const Trade::MeshData&)
+*/
+MAGNUM_MESHTOOLS_EXPORT void optimizeVertexCacheInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, UnsignedInt vertexCount);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT void optimizeVertexCacheInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, UnsignedInt vertexCount);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT void optimizeVertexCacheInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, UnsignedInt vertexCount);
+
+/**
+@brief Optimize a type-erased triangle index buffer for post-transform vertex cache in-place
+@m_since_latest
+
+Expects that the second dimension of @p indices is contiguous and represents
+the actual 1/2/4-byte index type. Based on its size then calls one of the
+@ref optimizeVertexCacheInPlace(const Containers::StridedArrayView1D<UnsignedInt>&, UnsignedInt)
+etc. overloads.
+*/
+MAGNUM_MESHTOOLS_EXPORT void optimizeVertexCacheInPlace(const Containers::StridedArrayView2D<char>& indices, UnsignedInt vertexCount);
+
+/**
+@brief Optimize a triangle index buffer for reduced overdraw in-place
+@param[in,out] indices  Index array to operate on
+@param[in] positions    Vertex positions
+@param[in] cacheSize    Post-transform vertex cache size
+@m_since_latest
+
+Splits the triangle list into clusters at points where the triangle order
+causes a full cache miss with a FIFO cache of @p cacheSize, and then sorts the
+clusters so ones facing outwards of the mesh are drawn first, which makes
+them more likely to occlude the remaining ones. Triangle order inside the
+clusters is preserved, so it's meant to be used after
+@ref optimizeVertexCacheInPlace() or @ref tipsifyInPlace() without
+significantly affecting their result. The @p indices are expected to have a
+size divisible by @cpp 3 @ce and all be in bounds of @p positions. Algorithm
+used: *Pedro V. Sander, Diego Nehab, and Joshua Barczak --- Fast Triangle
+Reordering for Vertex Locality and Reduced Overdraw, SIGGRAPH 2007,
+https://gfx.cs.princeton.edu/pubs/Sander_2007_%3eTR/tipsy.pdf*.
+@see @ref optimizeOverdraw(const Trade::MeshData&, UnsignedInt)
+*/
+MAGNUM_MESHTOOLS_EXPORT void optimizeOverdrawInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt cacheSize = 16);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT void optimizeOverdrawInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt cacheSize = 16);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT void optimizeOverdrawInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt cacheSize = 16);
+
+/**
+@brief Optimize a type-erased triangle index buffer for reduced overdraw in-place
+@m_since_latest
+
+Expects that the second dimension of @p indices is contiguous and represents
+the actual 1/2/4-byte index type. Based on its size then calls one of the
+@ref optimizeOverdrawInPlace(const Containers::StridedArrayView1D<UnsignedInt>&, const Containers::StridedArrayView1D<const Vector3>&, UnsignedInt)
+etc. overloads.
+*/
+MAGNUM_MESHTOOLS_EXPORT void optimizeOverdrawInPlace(const Containers::StridedArrayView2D<char>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt cacheSize = 16);
+
+/**
+@brief Optimize vertex data for pre-transform vertex fetch in-place
+@param[in,out] indices  Index array to operate on
+@param[in,out] data     Vertex data to operate on
+@return Count of vertices referenced by @p indices
+@m_since_latest
+
+Renumbers the vertices in the order in which they're first referenced by
+@p indices and reorders @p data correspondingly, making the vertex fetch
+access memory as linearly as possible. Vertices not referenced by @p indices
+are moved to the end in their original order, the returned value is the count
+of vertices that are referenced, i.e. the prefix of @p data that's actually
+used. All @p indices are expected to be in bounds of @p data. Should be
+performed as the last step after @ref optimizeVertexCacheInPlace() and
+@ref optimizeOverdrawInPlace(), as those change the order in which vertices
+are referenced.
+@see @ref optimizeVertexFetch(const Trade::MeshData&)
+*/
+MAGNUM_MESHTOOLS_EXPORT std::size_t optimizeVertexFetchInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView2D<char>& data);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT std::size_t optimizeVertexFetchInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView2D<char>& data);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT std::size_t optimizeVertexFetchInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView2D<char>& data);
+
+/**
+@brief Optimize type-erased vertex data for pre-transform vertex fetch in-place
+@m_since_latest
+
+Expects that the second dimension of @p indices is contiguous and represents
+the actual 1/2/4-byte index type. Based on its size then calls one of the
+@ref optimizeVertexFetchInPlace(const Containers::StridedArrayView1D<UnsignedInt>&, const Containers::StridedArrayView2D<char>&)
+etc. overloads.
+*/
+MAGNUM_MESHTOOLS_EXPORT std::size_t optimizeVertexFetchInPlace(const Containers::StridedArrayView2D<char>& indices, const Containers::StridedArrayView2D<char>& data);
+
+/**
+@brief Optimize a mesh for post-transform vertex cache
+@m_since_latest
+
+Expects that the mesh is an indexed @ref MeshPrimitive::Triangles with a
+non-implementation-specific index type. Vertex data are passed through
+unchanged, the index buffer is reordered with
+@ref optimizeVertexCacheInPlace(). Data that are already owned and mutable
+are moved to the output, otherwise they get copied.
+@see @ref optimizeVertexCache(Trade::MeshData&&)
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData optimizeVertexCache(const Trade::MeshData& data);
+
+/**
+@brief Optimize a mesh for post-transform vertex cache
+@m_since_latest
+
+Compared to @ref optimizeVertexCache(const Trade::MeshData&) this function can
+transfer ownership of @p data index and vertex buffers (in case they are
+owned) to the returned instance instead of making copies of them.
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData optimizeVertexCache(Trade::MeshData&& data);
+
+/**
+@brief Optimize a mesh for reduced overdraw
+@m_since_latest
+
+Expects that the mesh is an indexed @ref MeshPrimitive::Triangles with a
+non-implementation-specific index type and has a
+@ref Trade::MeshAttribute::Position attribute, which then gets converted to
+@ref VertexFormat::Vector3 using @ref Trade::MeshData::positions3DAsArray().
+Vertex data are passed through unchanged, the index buffer is reordered with
+@ref optimizeOverdrawInPlace(). Data that are already owned and mutable are
+moved to the output, otherwise they get copied.
+@see @ref optimizeOverdraw(Trade::MeshData&&, UnsignedInt)
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData optimizeOverdraw(const Trade::MeshData& data, UnsignedInt cacheSize = 16);
+
+/**
+@brief Optimize a mesh for reduced overdraw
+@m_since_latest
+
+Compared to @ref optimizeOverdraw(const Trade::MeshData&, UnsignedInt) this
+function can transfer ownership of @p data index and vertex buffers (in case
+they are owned) to the returned instance instead of making copies of them.
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData optimizeOverdraw(Trade::MeshData&& data, UnsignedInt cacheSize = 16);
+
+/**
+@brief Optimize a mesh for pre-transform vertex fetch
+@m_since_latest
+
+Expects that the mesh is indexed with a non-implementation-specific index type
+and no attribute has an implementation-specific format. The vertex data are
+interleaved, reordered with @ref optimizeVertexFetchInPlace() and vertices not
+referenced by the index buffer are removed. The resulting mesh is always
+owned, attribute order and formats are preserved.
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData optimizeVertexFetch(const Trade::MeshData& data);
+
+}}
+
+#endif
@@ -0,0 +1,140 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Quantize.h"
+
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Math/FunctionsBatch.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/PackingBatch.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/MeshTools/FilterAttributes.h"
+#include "Magnum/MeshTools/Interleave.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools {
+
+Containers::Pair<Trade::MeshData, Matrix4> quantize(const Trade::MeshData& data) {
+    /* Copy original attributes to a mutable array so we can update the
+       formats. Not using Utility::copy() here as the view returned by
+       attributeData() might have offset-only attributes which interleave()
+       doesn't want. */
+    Containers::Array<Trade::MeshAttributeData> attributes{data.attributeCount()};
+    Range3D positionRange;
+    bool hasPositions = false;
+    for(UnsignedInt i = 0; i != data.attributeCount(); ++i) {
+        attributes[i] = data.attributeData(i);
+
+        /* Array attributes can be only custom, which we don't touch */
+        if(data.attributeArraySize(i)) continue;
+
+        const Trade::MeshAttribute name = data.attributeName(i);
+        const VertexFormat format = data.attributeFormat(i);
+        VertexFormat quantizedFormat{};
+        if(name == Trade::MeshAttribute::Position) {
+            Range3D range;
+            if(format == VertexFormat::Vector2) {
+                const std::pair<Vector2, Vector2> minmax = Math::minmax(data.attribute<Vector2>(i));
+                range = {Vector3{minmax.first, 0.0f}, Vector3{minmax.second, 0.0f}};
+                quantizedFormat = VertexFormat::Vector2usNormalized;
+            } else if(format == VertexFormat::Vector3) {
+                const std::pair<Vector3, Vector3> minmax = Math::minmax(data.attribute<Vector3>(i));
+                range = {minmax.first, minmax.second};
+                quantizedFormat = VertexFormat::Vector3usNormalized;
+            } else continue;
+
+            positionRange = hasPositions ? Math::join(positionRange, range) : range;
+            hasPositions = true;
+
+        } else if(name == Trade::MeshAttribute::Normal ||
+                  name == Trade::MeshAttribute::Tangent ||
+                  name == Trade::MeshAttribute::Bitangent) {
+            if(format == VertexFormat::Vector3)
+                quantizedFormat = VertexFormat::Vector3sNormalized;
+            else if(name == Trade::MeshAttribute::Tangent && format == VertexFormat::Vector4)
+                quantizedFormat = VertexFormat::Vector4sNormalized;
+            else continue;
+
+        } else if(name == Trade::MeshAttribute::TextureCoordinates) {
+            if(format != VertexFormat::Vector2) continue;
+
+            /* Pick the format based on the range. Coordinates outside of
+               [-1, 1] would need a transformation as well, keep those
+               unchanged. */
+            const std::pair<Vector2, Vector2> minmax = Math::minmax(data.attribute<Vector2>(i));
+            if((minmax.first >= Vector2{0.0f}).all() && (minmax.second <= Vector2{1.0f}).all())
+                quantizedFormat = VertexFormat::Vector2usNormalized;
+            else if((minmax.first >= Vector2{-1.0f}).all() && (minmax.second <= Vector2{1.0f}).all())
+                quantizedFormat = VertexFormat::Vector2sNormalized;
+            else continue;
+
+        } else continue;
+
+        /* Replace the attribute with an empty placeholder that we'll pack the
+           data into */
+        attributes[i] = Trade::MeshAttributeData{name, quantizedFormat, nullptr};
+    }
+
+    /* Uniform scale so normals aren't affected by the dequantization. If the
+       mesh is just a single point, scale by 1 to keep the matrix
+       invertible. */
+    Float scale = positionRange.size().max();
+    if(scale == 0.0f) scale = 1.0f;
+    const Matrix4 transformation = hasPositions ?
+        Matrix4::translation(positionRange.min())*Matrix4::scaling(Vector3{scale}) : Matrix4{};
+
+    /* Create the output mesh, tightly packed */
+    Trade::MeshData out = interleave(filterOnlyAttributes(data, Containers::ArrayView<const UnsignedInt>{}), attributes, InterleaveFlags{});
+
+    for(UnsignedInt i = 0; i != data.attributeCount(); ++i) {
+        const VertexFormat format = out.attributeFormat(i);
+        if(format == data.attributeFormat(i)) continue;
+
+        const Containers::StridedArrayView2D<const Float> src = Containers::arrayCast<2, const Float>(data.attribute(i));
+        if(format == VertexFormat::Vector2usNormalized || format == VertexFormat::Vector3usNormalized) {
+            /* Positions get mapped to the unit cube first, texture
+               coordinates are in the [0, 1] range already */
+            if(out.attributeName(i) == Trade::MeshAttribute::Position) {
+                Containers::Array<Float> normalized{NoInit, src.size()[0]*src.size()[1]};
+                const Containers::StridedArrayView2D<Float> normalized2D{normalized, src.size()};
+                for(std::size_t j = 0; j != src.size()[0]; ++j)
+                    for(std::size_t k = 0; k != src.size()[1]; ++k)
+                        normalized2D[j][k] = (src[j][k] - positionRange.min()[k])/scale;
+                Math::packInto(normalized2D, Containers::arrayCast<2, UnsignedShort>(out.mutableAttribute(i)));
+            } else Math::packInto(src, Containers::arrayCast<2, UnsignedShort>(out.mutableAttribute(i)));
+        } else {
+            CORRADE_INTERNAL_ASSERT(format == VertexFormat::Vector2sNormalized ||
+                                    format == VertexFormat::Vector3sNormalized ||
+                                    format == VertexFormat::Vector4sNormalized);
+            Math::packInto(src, Containers::arrayCast<2, Short>(out.mutableAttribute(i)));
+        }
+    }
+
+    return {std::move(out), transformation};
+}
+
+}}
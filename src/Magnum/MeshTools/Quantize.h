@@ -0,0 +1,79 @@
+#ifndef Magnum_MeshTools_Quantize_h
+#define Magnum_MeshTools_Quantize_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::quantize()
+ * @m_since_latest
+ */
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Quantize mesh vertex attributes
+@return Mesh with quantized attributes and a dequantization transformation
+@m_since_latest
+
+Packs floating-point attributes into smaller normalized integer formats:
+
+-   @ref VertexFormat::Vector3 @ref Trade::MeshAttribute::Position is turned
+    into @ref VertexFormat::Vector3usNormalized and
+    @ref VertexFormat::Vector2 into @ref VertexFormat::Vector2usNormalized.
+    The positions are mapped to a unit cube and the returned transformation
+    maps them back to the original range, so it's meant to be multiplied with
+    the object transformation when drawing the mesh. To not distort
+    normals, the scale is the same for all three axes. If there are multiple
+    position attributes, such as for morph targets, all share the same range
+    and transformation.
+-   @ref VertexFormat::Vector3 @ref Trade::MeshAttribute::Normal,
+    @ref Trade::MeshAttribute::Tangent and
+    @ref Trade::MeshAttribute::Bitangent is turned into
+    @ref VertexFormat::Vector3sNormalized, @ref VertexFormat::Vector4
+    @ref Trade::MeshAttribute::Tangent into
+    @ref VertexFormat::Vector4sNormalized.
+-   @ref VertexFormat::Vector2 @ref Trade::MeshAttribute::TextureCoordinates
+    are turned into @ref VertexFormat::Vector2usNormalized if all of them are
+    in the @f$ [0, 1] @f$ range and into @ref VertexFormat::Vector2sNormalized
+    if they're in the @f$ [-1, 1] @f$ range. Texture coordinates outside of
+    these ranges, for example with repeated textures, are kept as-is.
+
+The packing is done using @ref Math::packInto(). All other attributes,
+including attributes that are already in a packed format, are passed through
+unchanged. The index buffer is copied as well and the output vertex data are
+tightly interleaved, which for a typical mesh with positions, normals and
+texture coordinates results in 16 bytes per vertex instead of 32. If the mesh
+has no positions, the returned transformation is an identity.
+@see @ref interleave(), @ref Trade::MeshData::positions3DAsArray()
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Pair<Trade::MeshData, Matrix4> quantize(const Trade::MeshData& data);
+
+}}
+
+#endif
@@ -27,10 +27,34 @@
 
 #include <Corrade/Utility/Algorithms.h>
 
+#include "Magnum/Trade/DataArena.h"
 #include "Magnum/Trade/MeshData.h"
 
 namespace Magnum { namespace MeshTools {
 
+namespace {
+
+/* Creates a copy of the attribute array with attributes pointing to
+   vertexData instead of originalVertexData */
+Containers::Array<Trade::MeshAttributeData> rerouteAttributes(const Containers::ArrayView<const Trade::MeshAttributeData> originalAttributeData, const Containers::ArrayView<const char> originalVertexData, const Containers::ArrayView<const char> vertexData, const UnsignedInt vertexCount) {
+    Containers::Array<Trade::MeshAttributeData> attributeData{originalAttributeData.size()};
+    for(std::size_t i = 0; i != originalAttributeData.size(); ++i) {
+        attributeData[i] = Trade::MeshAttributeData{
+            originalAttributeData[i].name(),
+            originalAttributeData[i].format(),
+            Containers::StridedArrayView1D<const void>{
+                vertexData,
+                vertexData.data() + originalAttributeData[i].offset(originalVertexData),
+                vertexCount,
+                originalAttributeData[i].stride()},
+            originalAttributeData[i].arraySize()};
+    }
+
+    return attributeData;
+}
+
+}
+
 Trade::MeshData reference(const Trade::MeshData& data) {
     /* Can't do just Trade::MeshIndexData{data.indices()} as that would discard
        implementation-specific types. And can't do
@@ -132,20 +156,7 @@ Trade::MeshData owned(Trade::MeshData&& data) {
 
     /* Otherwise we have to allocate a new one and re-route the attributes to
        a potentially different vertex array */
-    } else {
-        attributeData = Containers::Array<Trade::MeshAttributeData>{originalAttributeData.size()};
-        for(std::size_t i = 0; i != originalAttributeData.size(); ++i) {
-            attributeData[i] = Trade::MeshAttributeData{
-                originalAttributeData[i].name(),
-                originalAttributeData[i].format(),
-                Containers::StridedArrayView1D<const void>{
-                    vertexData,
-                    vertexData.data() + originalAttributeData[i].offset(originalVertexData),
-                    vertexCount,
-                    originalAttributeData[i].stride()},
-                originalAttributeData[i].arraySize()};
-        }
-    }
+    } else attributeData = rerouteAttributes(originalAttributeData, originalVertexData, vertexData, vertexCount);
 
     return Trade::MeshData{data.primitive(),
         std::move(indexData), indices,
@@ -153,4 +164,34 @@ Trade::MeshData owned(Trade::MeshData&& data) {
         vertexCount};
 }
 
+Trade::MeshData owned(const Trade::MeshData& data, Trade::DataArena& arena) {
+    /** @todo copy only the actually used range instead of the whole thing? */
+
+    /* Copy the index data, if the mesh is indexed. If not, the
+       default-constructed instances are fine. */
+    Containers::Array<char> indexData;
+    Trade::MeshIndexData indices;
+    if(data.isIndexed()) {
+        indexData = arena.allocate(data.indexData().size());
+        indices = Trade::MeshIndexData{
+            data.indexType(),
+            Containers::StridedArrayView1D<const void>{
+                indexData,
+                indexData.data() + data.indexOffset(),
+                data.indexCount(),
+                data.indexStride()}};
+        Utility::copy(data.indexData(), indexData);
+    }
+
+    Containers::Array<char> vertexData = arena.allocate(data.vertexData().size());
+    Utility::copy(data.vertexData(), vertexData);
+
+    Containers::Array<Trade::MeshAttributeData> attributeData = rerouteAttributes(data.attributeData(), data.vertexData(), vertexData, data.vertexCount());
+
+    return Trade::MeshData{data.primitive(),
+        std::move(indexData), indices,
+        std::move(vertexData), std::move(attributeData),
+        data.vertexCount()};
+}
+
 }}
@@ -26,7 +26,7 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::reference(), @ref Magnum::MeshTools::owned()
+ * @brief Function @ref Magnum::MeshTools::reference(), @ref Magnum::MeshTools::mutableReference(), @ref Magnum::MeshTools::owned()
  * @m_since{2020,06}
  */
 
@@ -88,6 +88,18 @@ into newly allocated arrays.
 */
 MAGNUM_MESHTOOLS_EXPORT Trade::MeshData owned(Trade::MeshData&& data);
 
+/**
+@brief Create a @ref Trade::MeshData owned by a data arena
+@m_since_latest
+
+Like @ref owned(const Trade::MeshData&), but the index and vertex data are
+allocated from @p arena. The attribute data are allocated separately as they
+don't usually take a significant amount of memory. Useful for gathering
+meshes produced by different importers and tools into a single arena that's
+then freed at once, see @ref Trade::DataArena for more information.
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData owned(const Trade::MeshData& data, Trade::DataArena& arena);
+
 }}
 
 #endif
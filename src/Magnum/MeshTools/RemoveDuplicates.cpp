@@ -34,6 +34,9 @@
 #include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/MurmurHash2.h>
 
+#include "Magnum/ProfileScope.h"
+#include "Magnum/TaskScheduler.h"
+#include "Magnum/Implementation/parallelFor.h"
 #include "Magnum/Math/FunctionsBatch.h"
 #include "Magnum/Math/Range.h"
 #include "Magnum/MeshTools/Reference.h"
@@ -63,7 +66,122 @@ struct ArrayHash {
     private: std::size_t _size;
 };
 
-std::size_t removeDuplicatesInto(const Containers::StridedArrayView2D<const char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices) {
+namespace {
+
+/* Open-addressing hash table with linear probing, storing just indices of
+   the keys, with the key data themselves living outside of the table.
+   Compared to an std::unordered_map it does only a single allocation instead
+   of one for every unique entry and the probing is much more cache-friendly,
+   while giving the exact same results. */
+class EntryTable {
+    public:
+        explicit EntryTable(std::size_t maxEntryCount, std::size_t entrySize): _hash{entrySize}, _equal{entrySize}, _slots{DirectInit, slotCount(maxEntryCount), ~UnsignedInt{}}, _mask{_slots.size() - 1} {}
+
+        /* If an entry equal to `entry` is already in the table, returns index
+           of its key, otherwise inserts `index` and returns it. The `key`
+           functor returns a pointer to key data at given index. */
+        template<class KeyFunctor> UnsignedInt findOrInsert(const void* entry, const UnsignedInt index, const KeyFunctor& key) {
+            return findOrInsert(entry, _hash(entry), index, key);
+        }
+
+        /* Same as above, but with the hash of `entry` calculated already */
+        template<class KeyFunctor> UnsignedInt findOrInsert(const void* entry, const std::size_t hash, const UnsignedInt index, const KeyFunctor& key) {
+            for(std::size_t slot = hash & _mask; ; slot = (slot + 1) & _mask) {
+                UnsignedInt& existing = _slots[slot];
+                if(existing == ~UnsignedInt{}) return existing = index;
+                if(_equal(key(existing), entry)) return existing;
+            }
+        }
+
+    private:
+        /* Reserving at least twice as many slots as there can be entries to
+           have the load factor always at most 0.5. Power of two so the
+           modulo is just a mask. */
+        static std::size_t slotCount(const std::size_t maxEntryCount) {
+            std::size_t count = 2;
+            while(count < maxEntryCount*2) count <<= 1;
+            return count;
+        }
+
+        ArrayHash _hash;
+        ArrayEqual _equal;
+        Containers::Array<UnsignedInt> _slots;
+        std::size_t _mask;
+};
+
+/* Partitions smaller than this aren't worth the extra passes over the data */
+constexpr std::size_t MinPartitionSize = 4096;
+
+/* Returns count of partitions to split `dataSize` items into, 1 means the
+   serial path should be taken */
+std::size_t removeDuplicatesPartitionCount(const std::size_t dataSize, const UnsignedInt threadCount) {
+    const std::size_t count = threadCount ? threadCount : TaskScheduler::global().threadCount();
+    return Math::max(Math::min(count, dataSize/MinPartitionSize), std::size_t{1});
+}
+
+/* Writes the index of the first occurrence of each item to `indices`, with
+   the items partitioned by their hash so each partition can be processed by
+   a different thread. Equal items always land in the same partition and each
+   partition goes through its items in the original order, so the output is
+   exactly the same as with the serial loop in removeDuplicatesInto(). Returns
+   count of unique items. */
+std::size_t firstOccurrencesPartitioned(const Containers::StridedArrayView2D<const char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices, const std::size_t partitionCount) {
+    const std::size_t dataSize = data.size()[0];
+    const ArrayHash hash{data.size()[1]};
+
+    /* Hash everything upfront, in parallel. The hashes are used both for
+       picking a partition and for the table lookup. */
+    Containers::Array<std::size_t> hashes{NoInit, dataSize};
+    Magnum::Implementation::parallelFor(dataSize, UnsignedInt(partitionCount), [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t i = begin; i != end; ++i)
+            hashes[i] = hash(data[i].data());
+    });
+
+    /* The partition is picked from the top 16 bits of the hash, which don't
+       affect the slot the item ends up in the partition table, as that uses
+       the low bits */
+    constexpr std::size_t PartitionShift = sizeof(std::size_t)*8 - 16;
+    const auto partition = [&](const std::size_t i) {
+        return ((hashes[i] >> PartitionShift)*partitionCount) >> 16;
+    };
+
+    /* Stable counting sort of item indices by their partition */
+    Containers::Array<std::size_t> partitionOffsets{ValueInit, partitionCount + 1};
+    for(std::size_t i = 0; i != dataSize; ++i)
+        ++partitionOffsets[partition(i) + 1];
+    for(std::size_t i = 0; i != partitionCount; ++i)
+        partitionOffsets[i + 1] += partitionOffsets[i];
+    Containers::Array<UnsignedInt> partitionItems{NoInit, dataSize};
+    {
+        Containers::Array<std::size_t> position{NoInit, partitionCount};
+        Utility::copy(partitionOffsets.prefix(partitionCount), position);
+        for(std::size_t i = 0; i != dataSize; ++i)
+            partitionItems[position[partition(i)]++] = i;
+    }
+
+    /* Deduplicate each partition with its own table. Each task writes only
+       to the indices of items in its own partition. */
+    const auto key = [&data](UnsignedInt index) -> const void* {
+        return data[index].data();
+    };
+    Magnum::Implementation::parallelFor(partitionCount, UnsignedInt(partitionCount), [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t p = begin; p != end; ++p) {
+            const Containers::ArrayView<const UnsignedInt> items = partitionItems.slice(partitionOffsets[p], partitionOffsets[p + 1]);
+            EntryTable table{items.size(), data.size()[1]};
+            for(const UnsignedInt i: items)
+                indices[i] = table.findOrInsert(data[i].data(), hashes[i], i, key);
+        }
+    });
+
+    std::size_t uniqueCount = 0;
+    for(std::size_t i = 0; i != dataSize; ++i)
+        if(indices[i] == i) ++uniqueCount;
+    return uniqueCount;
+}
+
+}
+
+std::size_t removeDuplicatesInto(const Containers::StridedArrayView2D<const char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices, const UnsignedInt threadCount) {
     /* Assuming the second dimension is contiguous so we can calculate the
        hashes easily */
     CORRADE_ASSERT(data.isEmpty()[0] || data.isContiguous<1>(),
@@ -73,37 +191,41 @@ std::size_t removeDuplicatesInto(const Containers::StridedArrayView2D<const char
     CORRADE_ASSERT(indices.size() == dataSize,
         "MeshTools::removeDuplicatesInto(): output index array has" << indices.size() << "elements but expected" << dataSize, {});
 
-    /* Table containing index of first occurrence for each unique entry.
-       Reserving more buckets than necessary (i.e. as if each entry was
-       unique). */
-    std::unordered_map<const void*, UnsignedInt, ArrayHash, ArrayEqual> table{
-        dataSize,
-        ArrayHash{data.size()[1]},
-        ArrayEqual{data.size()[1]}};
+    const std::size_t partitions = removeDuplicatesPartitionCount(dataSize, threadCount);
+    if(partitions > 1)
+        return firstOccurrencesPartitioned(data, indices, partitions);
+
+    /* Table containing index of first occurrence for each unique entry. The
+       keys are the original unchanged data. */
+    EntryTable table{dataSize, data.size()[1]};
+    const auto key = [&data](UnsignedInt index) -> const void* {
+        return data[index].data();
+    };
 
     /* Go through all entries */
+    std::size_t uniqueCount = 0;
     for(std::size_t i = 0; i != dataSize; ++i) {
         /* Try to insert new entry into the table. The inserted index points
            into the original unchanged data array. */
-        const Containers::ArrayView<const char> entry = data[i].asContiguous();
-        const auto result = table.emplace(entry, i);
+        const UnsignedInt found = table.findOrInsert(data[i].data(), i, key);
+        if(found == i) ++uniqueCount;
 
         /* Put the (either new or already existing) index into the output
            index array */
-        indices[i] = result.first->second;
+        indices[i] = found;
     }
 
-    CORRADE_INTERNAL_ASSERT(dataSize >= table.size());
-    return table.size();
+    CORRADE_INTERNAL_ASSERT(dataSize >= uniqueCount);
+    return uniqueCount;
 }
 
-std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicates(const Containers::StridedArrayView2D<const char>& data) {
+std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicates(const Containers::StridedArrayView2D<const char>& data, const UnsignedInt threadCount) {
     Containers::Array<UnsignedInt> indices{NoInit, data.size()[0]};
-    const std::size_t size = removeDuplicatesInto(data, indices);
+    const std::size_t size = removeDuplicatesInto(data, indices, threadCount);
     return {std::move(indices), size};
 }
 
-std::size_t removeDuplicatesInPlaceInto(const Containers::StridedArrayView2D<char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices) {
+std::size_t removeDuplicatesInPlaceInto(const Containers::StridedArrayView2D<char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices, const UnsignedInt threadCount) {
     /* Assuming the second dimension is contiguous so we can calculate the
        hashes easily */
     CORRADE_ASSERT(data.isEmpty()[0] || data.isContiguous<1>(),
@@ -113,57 +235,172 @@ std::size_t removeDuplicatesInPlaceInto(const Containers::StridedArrayView2D<cha
     CORRADE_ASSERT(indices.size() == dataSize,
         "MeshTools::removeDuplicatesInPlaceInto(): output index array has" << indices.size() << "elements but expected" << dataSize, {});
 
-    /* Table containing index of first occurrence for each unique entry.
-       Reserving more buckets than necessary (i.e. as if each entry was
-       unique). */
-    std::unordered_map<const void*, UnsignedInt, ArrayHash, ArrayEqual> table{
-        dataSize,
-        ArrayHash{data.size()[1]},
-        ArrayEqual{data.size()[1]}};
+    /* For the parallel path, find the first occurrences without modifying
+       the data first and then compact the unique items to the prefix and
+       turn the first occurrence indices into indices into the prefix. As the
+       first occurrence of an item is always before it, its index is already
+       remapped by the time it's needed. */
+    const std::size_t partitions = removeDuplicatesPartitionCount(dataSize, threadCount);
+    if(partitions > 1) {
+        firstOccurrencesPartitioned(data, indices, partitions);
+        std::size_t uniqueCount = 0;
+        for(std::size_t i = 0; i != dataSize; ++i) {
+            const UnsignedInt first = indices[i];
+            if(first == i) {
+                if(i != uniqueCount)
+                    Utility::copy(data[i].asContiguous(), data[uniqueCount].asContiguous());
+                indices[i] = uniqueCount++;
+            } else indices[i] = indices[first];
+        }
+
+        return uniqueCount;
+    }
+
+    /* Table containing index of first occurrence for each unique entry. The
+       keys are the unique prefix of the data array. */
+    EntryTable table{dataSize, data.size()[1]};
+    const auto key = [&data](UnsignedInt index) -> const void* {
+        return data[index].data();
+    };
 
     /* Go through all entries and insert them into the table. Because the keys
-       have runtime size, the table doesn't store a copy of the keys, only a
-       reference. The reference is to the original data that we mutate
+       have runtime size, the table doesn't store a copy of the keys, only an
+       index to them. The index is to the original data that we mutate
        in-place, so extra care needs to be taken to prevent already-inserted
        keys from getting modified. */
+    std::size_t uniqueCount = 0;
     for(std::size_t i = 0; i != dataSize; ++i) {
         /* First copy the key data to a potentially final no-longer-mutable
            place (except if the source and target location is the same). Data
-           in [table.size()-1, i) is already present in the [0, table.size()-1)
+           in [uniqueCount, i) is already present in the [0, uniqueCount)
            range from previous iterations so we aren't overwriting anything. If
            insertion succeeds, this location will not be touched ever again; if
            it fails the location isn't used as a key anywhere and so it can be
            reused next time for a different key.
 
-           Alternatively we could first call find() and only then conditionally
-           do a copy() and emplace(), but that means the hash & search would be
+           Alternatively we could first do a lookup and only then conditionally
+           do a copy() and insertion, but that means the hash & search would be
            performed twice, which is never faster than a plain memory copy. */
-        const Containers::ArrayView<char> dst = data[table.size()].asContiguous();
-        if(i != table.size())
+        const Containers::ArrayView<char> dst = data[uniqueCount].asContiguous();
+        if(i != uniqueCount)
             Utility::copy(data[i].asContiguous(), dst);
 
         /* Insert the new entry into the table. If it succeeds, dst is
            guaranteed to not change anymore. */
-        const auto result = table.emplace(dst, table.size());
+        const UnsignedInt found = table.findOrInsert(dst.data(), uniqueCount, key);
+        if(found == uniqueCount) ++uniqueCount;
 
         /* Put the (either new or already existing) index into the output index
            array */
-        indices[i] = result.first->second;
+        indices[i] = found;
+    }
+
+    CORRADE_INTERNAL_ASSERT(dataSize >= uniqueCount);
+    return uniqueCount;
+}
+
+std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicatesInPlace(const Containers::StridedArrayView2D<char>& data, const UnsignedInt threadCount) {
+    Containers::Array<UnsignedInt> indices{NoInit, data.size()[0]};
+    const std::size_t size = removeDuplicatesInPlaceInto(data, indices, threadCount);
+    return {std::move(indices), size};
+}
+
+std::size_t removeDuplicatesRadixInPlaceInto(const Containers::StridedArrayView2D<char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices) {
+    /* Assuming the second dimension is contiguous so we can compare the items
+       with a memcmp() */
+    CORRADE_ASSERT(data.isEmpty()[0] || data.isContiguous<1>(),
+        "MeshTools::removeDuplicatesRadixInPlaceInto(): second data view dimension is not contiguous", {});
+
+    const std::size_t dataSize = data.size()[0];
+    CORRADE_ASSERT(indices.size() == dataSize,
+        "MeshTools::removeDuplicatesRadixInPlaceInto(): output index array has" << indices.size() << "elements but expected" << dataSize, {});
+
+    if(!dataSize) return 0;
+
+    /* Caching values to avoid inline function calls in debug builds */
+    const std::size_t itemSize = data.size()[1];
+    const char* const bytes = static_cast<const char*>(data.data());
+    const std::ptrdiff_t stride = data.stride()[0];
+    const auto item = [&](UnsignedInt i) {
+        return reinterpret_cast<const UnsignedByte*>(bytes + std::ptrdiff_t(i)*stride);
+    };
+
+    /* Histograms for all bytes, calculated in a single pass */
+    Containers::Array<UnsignedInt> histograms{ValueInit, itemSize*256};
+    for(std::size_t i = 0; i != dataSize; ++i) {
+        const UnsignedByte* const key = item(i);
+        for(std::size_t j = 0; j != itemSize; ++j)
+            ++histograms[j*256 + key[j]];
     }
 
-    CORRADE_INTERNAL_ASSERT(dataSize >= table.size());
-    return table.size();
+    /* Stable LSD radix sort of a permutation, going from the last byte to the
+       first. The resulting order is lexicographic in the bytes, which is
+       enough for grouping equal items together, and equal items stay in the
+       order of their occurrence. Bytes that are the same in all items don't
+       affect the order and are skipped. */
+    Containers::Array<UnsignedInt> permutation{NoInit, dataSize};
+    Containers::Array<UnsignedInt> scratch{NoInit, dataSize};
+    for(std::size_t i = 0; i != dataSize; ++i)
+        permutation[i] = i;
+    for(std::size_t j = itemSize; j != 0; --j) {
+        UnsignedInt* const histogram = histograms.data() + (j - 1)*256;
+        if(histogram[item(0)[j - 1]] == dataSize) continue;
+
+        /* Turn the histogram into output offsets for each bucket */
+        UnsignedInt offset = 0;
+        for(std::size_t k = 0; k != 256; ++k) {
+            const UnsignedInt count = histogram[k];
+            histogram[k] = offset;
+            offset += count;
+        }
+
+        for(std::size_t i = 0; i != dataSize; ++i) {
+            const UnsignedInt index = permutation[i];
+            scratch[histogram[item(index)[j - 1]]++] = index;
+        }
+
+        std::swap(permutation, scratch);
+    }
+
+    /* For each item, save the position of the first occurrence of the same
+       item into the output. Because the sort is stable, it's the first item
+       of each run. */
+    {
+        UnsignedInt first = permutation[0];
+        for(std::size_t i = 0; i != dataSize; ++i) {
+            const UnsignedInt index = permutation[i];
+            if(std::memcmp(item(index), item(first), itemSize) != 0)
+                first = index;
+            indices[index] = first;
+        }
+    }
+
+    /* Go through the items in their original order, assigning new indices
+       to first occurrences and moving them to the unique prefix. Other
+       items reference a first occurrence that was already processed before,
+       so its new index is already in the output. */
+    std::size_t uniqueCount = 0;
+    for(std::size_t i = 0; i != dataSize; ++i) {
+        const UnsignedInt first = indices[i];
+        if(first == i) {
+            if(i != uniqueCount)
+                Utility::copy(data[i].asContiguous(), data[uniqueCount].asContiguous());
+            indices[i] = uniqueCount++;
+        } else indices[i] = indices[first];
+    }
+
+    return uniqueCount;
 }
 
-std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicatesInPlace(const Containers::StridedArrayView2D<char>& data) {
+std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicatesRadixInPlace(const Containers::StridedArrayView2D<char>& data) {
     Containers::Array<UnsignedInt> indices{NoInit, data.size()[0]};
-    const std::size_t size = removeDuplicatesInPlaceInto(data, indices);
+    const std::size_t size = removeDuplicatesRadixInPlaceInto(data, indices);
     return {std::move(indices), size};
 }
 
 namespace {
 
-template<class IndexType> std::size_t removeDuplicatesIndexedInPlaceImplementation(const Containers::StridedArrayView1D<IndexType>& indices, const Containers::StridedArrayView2D<char>& data) {
+template<class IndexType> std::size_t removeDuplicatesIndexedInPlaceImplementation(const Containers::StridedArrayView1D<IndexType>& indices, const Containers::StridedArrayView2D<char>& data, const UnsignedInt threadCount) {
     /* Somehow ~IndexType{} doesn't work for < 4byte types, as the result is
        int(-1) instead of the type I want */
     CORRADE_ASSERT(data.size()[0] <= IndexType(-1),
@@ -174,34 +411,34 @@ template<class IndexType> std::size_t removeDuplicatesIndexedInPlaceImplementati
        original order, which is an useful property. The float version has this
        inverted (having the *Indexed() variant as the main implementation)
        because the remapping there has to be done once for every dimension. */
-    std::pair<Containers::Array<UnsignedInt>, std::size_t> result = removeDuplicatesInPlace(data);
+    std::pair<Containers::Array<UnsignedInt>, std::size_t> result = removeDuplicatesInPlace(data, threadCount);
     for(auto& i: indices) i = result.first[i];
     return result.second;
 }
 
 }
 
-std::size_t removeDuplicatesIndexedInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView2D<char>& data) {
-    return removeDuplicatesIndexedInPlaceImplementation(indices, data);
+std::size_t removeDuplicatesIndexedInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView2D<char>& data, const UnsignedInt threadCount) {
+    return removeDuplicatesIndexedInPlaceImplementation(indices, data, threadCount);
 }
 
-std::size_t removeDuplicatesIndexedInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView2D<char>& data) {
-    return removeDuplicatesIndexedInPlaceImplementation(indices, data);
+std::size_t removeDuplicatesIndexedInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView2D<char>& data, const UnsignedInt threadCount) {
+    return removeDuplicatesIndexedInPlaceImplementation(indices, data, threadCount);
 }
 
-std::size_t removeDuplicatesIndexedInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView2D<char>& data) {
-    return removeDuplicatesIndexedInPlaceImplementation(indices, data);
+std::size_t removeDuplicatesIndexedInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView2D<char>& data, const UnsignedInt threadCount) {
+    return removeDuplicatesIndexedInPlaceImplementation(indices, data, threadCount);
 }
 
-std::size_t removeDuplicatesIndexedInPlace(const Containers::StridedArrayView2D<char>& indices, const Containers::StridedArrayView2D<char>& data) {
+std::size_t removeDuplicatesIndexedInPlace(const Containers::StridedArrayView2D<char>& indices, const Containers::StridedArrayView2D<char>& data, const UnsignedInt threadCount) {
     CORRADE_ASSERT(indices.isContiguous<1>(), "MeshTools::removeDuplicatesIndexedInPlace(): second index view dimension is not contiguous", {});
     if(indices.size()[1] == 4)
-        return removeDuplicatesIndexedInPlace(Containers::arrayCast<1, UnsignedInt>(indices), data);
+        return removeDuplicatesIndexedInPlace(Containers::arrayCast<1, UnsignedInt>(indices), data, threadCount);
     else if(indices.size()[1] == 2)
-        return removeDuplicatesIndexedInPlace(Containers::arrayCast<1, UnsignedShort>(indices), data);
+        return removeDuplicatesIndexedInPlace(Containers::arrayCast<1, UnsignedShort>(indices), data, threadCount);
     else {
         CORRADE_ASSERT(indices.size()[1] == 1, "MeshTools::removeDuplicatesIndexedInPlace(): expected index type size 1, 2 or 4 but got" << indices.size()[1], {});
-        return removeDuplicatesIndexedInPlace(Containers::arrayCast<1, UnsignedByte>(indices), data);
+        return removeDuplicatesIndexedInPlace(Containers::arrayCast<1, UnsignedByte>(indices), data, threadCount);
     }
 }
 
@@ -396,7 +633,125 @@ std::size_t removeDuplicatesFuzzyIndexedInPlace(const Containers::StridedArrayVi
     return removeDuplicatesFuzzyIndexedInPlaceImplementation(indices, data, epsilon);
 }
 
-Trade::MeshData removeDuplicates(const Trade::MeshData& data) {
+namespace {
+
+/* Hashing from Teschner et al.: Optimized Spatial Hashing for Collision
+   Detection of Deformable Objects */
+template<std::size_t dimensions> std::size_t cellHash(const Math::Vector<dimensions, Long>& cell) {
+    constexpr UnsignedLong Primes[]{73856093ull, 19349663ull, 83492791ull};
+    UnsignedLong hash = 0;
+    for(std::size_t i = 0; i != dimensions; ++i)
+        hash ^= UnsignedLong(cell[i])*Primes[i];
+    return std::size_t(hash);
+}
+
+template<class VectorType> std::size_t removeDuplicatesSpatialInPlaceIntoImplementation(const Containers::StridedArrayView1D<VectorType>& positions, const Containers::StridedArrayView1D<UnsignedInt>& indices, const Float epsilon, const std::size_t scratchMemoryBudget) {
+    constexpr std::size_t dimensions = VectorType::Size;
+    typedef Math::Vector<dimensions, Long> CellType;
+
+    CORRADE_ASSERT(indices.size() == positions.size(),
+        "MeshTools::removeDuplicatesSpatialInPlaceInto(): output index array has" << indices.size() << "elements but expected" << positions.size(), {});
+    CORRADE_ASSERT(epsilon > 0.0f,
+        "MeshTools::removeDuplicatesSpatialInPlaceInto(): expected a positive epsilon but got" << epsilon, {});
+
+    const std::size_t dataSize = positions.size();
+    if(!dataSize) return 0;
+
+    /* Cells are relative to the data minimum to avoid overflows. Make the
+       cell at least so large that the coordinates fit into a 64-bit integer.
+       It can be larger than epsilon, but not smaller, otherwise looking into
+       just the immediate neighbor cells wouldn't be enough. */
+    const std::pair<VectorType, VectorType> minmax = Math::minmax(positions);
+    const Float cellSize = Math::max(epsilon, (minmax.second - minmax.first).max()/Float(1ull << 62));
+    const auto cellFor = [&minmax, cellSize](const VectorType& position) {
+        return CellType{Math::floor((position - minmax.first)/cellSize)};
+    };
+
+    /* Bucket count is a power of two, twice the vertex count at most, or less
+       if the scratch memory budget says so. Fewer buckets mean more cells
+       share the same bucket, making the lookup slower but not less
+       correct. */
+    std::size_t bucketCount = 1;
+    while(bucketCount < dataSize*2 && (!scratchMemoryBudget || bucketCount*2*sizeof(UnsignedInt) <= scratchMemoryBudget))
+        bucketCount <<= 1;
+    const std::size_t bucketMask = bucketCount - 1;
+
+    /* First unique vertex in each bucket and the next unique vertex in the
+       same bucket for each unique vertex */
+    Containers::Array<UnsignedInt> buckets{DirectInit, bucketCount, ~UnsignedInt{}};
+    Containers::Array<UnsignedInt> next{NoInit, dataSize};
+
+    /* 3^dimensions neighbor cells, including the center cell */
+    constexpr UnsignedInt NeighborCount = dimensions == 2 ? 9 : 27;
+
+    const Float epsilonSquared = epsilon*epsilon;
+    std::size_t uniqueCount = 0;
+    for(std::size_t i = 0; i != dataSize; ++i) {
+        const VectorType position = positions[i];
+        const CellType cell = cellFor(position);
+
+        /* Find the earliest unique vertex within epsilon in this and all
+           neighbor cells. The unique vertices are only ever in the
+           [0, uniqueCount) prefix which doesn't get modified anymore. Picking
+           the earliest one makes the output independent of the bucket
+           layout. */
+        UnsignedInt found = ~UnsignedInt{};
+        for(UnsignedInt n = 0; n != NeighborCount; ++n) {
+            CellType neighbor = cell;
+            for(UnsignedInt d = 0, divisor = 1; d != dimensions; ++d, divisor *= 3)
+                neighbor[d] += Long((n/divisor) % 3) - 1;
+
+            for(UnsignedInt u = buckets[cellHash(neighbor) & bucketMask]; u != ~UnsignedInt{}; u = next[u])
+                if(u < found && (positions[u] - position).dot() <= epsilonSquared)
+                    found = u;
+        }
+
+        /* Not found, put the vertex to the end of the unique prefix. Data in
+           [uniqueCount, i) is already present in the [0, uniqueCount) range
+           from previous iterations so we aren't overwriting anything. */
+        if(found == ~UnsignedInt{}) {
+            found = uniqueCount++;
+            positions[found] = position;
+
+            const std::size_t bucket = cellHash(cell) & bucketMask;
+            next[found] = buckets[bucket];
+            buckets[bucket] = found;
+        }
+
+        indices[i] = found;
+    }
+
+    CORRADE_INTERNAL_ASSERT(dataSize >= uniqueCount);
+    return uniqueCount;
+}
+
+template<class VectorType> std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicatesSpatialInPlaceImplementation(const Containers::StridedArrayView1D<VectorType>& positions, const Float epsilon, const std::size_t scratchMemoryBudget) {
+    Containers::Array<UnsignedInt> indices{NoInit, positions.size()};
+    const std::size_t size = removeDuplicatesSpatialInPlaceIntoImplementation(positions, indices, epsilon, scratchMemoryBudget);
+    return {std::move(indices), size};
+}
+
+}
+
+std::size_t removeDuplicatesSpatialInPlaceInto(const Containers::StridedArrayView1D<Vector2>& positions, const Containers::StridedArrayView1D<UnsignedInt>& indices, const Float epsilon, const std::size_t scratchMemoryBudget) {
+    return removeDuplicatesSpatialInPlaceIntoImplementation(positions, indices, epsilon, scratchMemoryBudget);
+}
+
+std::size_t removeDuplicatesSpatialInPlaceInto(const Containers::StridedArrayView1D<Vector3>& positions, const Containers::StridedArrayView1D<UnsignedInt>& indices, const Float epsilon, const std::size_t scratchMemoryBudget) {
+    return removeDuplicatesSpatialInPlaceIntoImplementation(positions, indices, epsilon, scratchMemoryBudget);
+}
+
+std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicatesSpatialInPlace(const Containers::StridedArrayView1D<Vector2>& positions, const Float epsilon, const std::size_t scratchMemoryBudget) {
+    return removeDuplicatesSpatialInPlaceImplementation(positions, epsilon, scratchMemoryBudget);
+}
+
+std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicatesSpatialInPlace(const Containers::StridedArrayView1D<Vector3>& positions, const Float epsilon, const std::size_t scratchMemoryBudget) {
+    return removeDuplicatesSpatialInPlaceImplementation(positions, epsilon, scratchMemoryBudget);
+}
+
+Trade::MeshData removeDuplicates(const Trade::MeshData& data, const UnsignedInt threadCount) {
+    MAGNUM_PROFILE_SCOPE("MeshTools::removeDuplicates()");
+
     CORRADE_ASSERT(data.attributeCount(),
         "MeshTools::removeDuplicates(): can't remove duplicates in an attributeless mesh",
         (Trade::MeshData{MeshPrimitive::Points, 0}));
@@ -435,12 +790,12 @@ Trade::MeshData removeDuplicates(const Trade::MeshData& data) {
     Containers::Array<char> indexData;
     MeshIndexType indexType;
     if(ownedInterleaved.isIndexed()) {
-        uniqueVertexCount = removeDuplicatesIndexedInPlace(ownedInterleaved.mutableIndices(), vertexData);
+        uniqueVertexCount = removeDuplicatesIndexedInPlace(ownedInterleaved.mutableIndices(), vertexData, threadCount);
         indexData = ownedInterleaved.releaseIndexData();
         indexType = ownedInterleaved.indexType();
     } else {
         indexData = Containers::Array<char>{NoInit, ownedInterleaved.vertexCount()*sizeof(UnsignedInt)};
-        uniqueVertexCount = removeDuplicatesInPlaceInto(vertexData, Containers::arrayCast<UnsignedInt>(indexData));
+        uniqueVertexCount = removeDuplicatesInPlaceInto(vertexData, Containers::arrayCast<UnsignedInt>(indexData), threadCount);
         indexType = MeshIndexType::UnsignedInt;
     }
 
@@ -471,7 +826,9 @@ Trade::MeshData removeDuplicates(const Trade::MeshData& data) {
         uniqueVertexCount};
 }
 
-Trade::MeshData removeDuplicatesFuzzy(const Trade::MeshData& data, const Float floatEpsilon, const Double doubleEpsilon) {
+Trade::MeshData removeDuplicatesFuzzy(const Trade::MeshData& data, const RemoveDuplicatesFuzzyFlags flags, const Float floatEpsilon, const Double doubleEpsilon) {
+    MAGNUM_PROFILE_SCOPE("MeshTools::removeDuplicatesFuzzy()");
+
     CORRADE_ASSERT(data.attributeCount(),
         "MeshTools::removeDuplicatesFuzzy(): can't remove duplicates in an attributeless mesh",
         (Trade::MeshData{MeshPrimitive::Points, 0}));
@@ -551,7 +908,19 @@ Trade::MeshData removeDuplicatesFuzzy(const Trade::MeshData& data, const Float f
                 attributeEpsilon = floatEpsilon*range;
             }
 
-            removeDuplicatesFuzzyInPlaceIntoImplementation(attribute, outputIndices, attributeEpsilon);
+            /* Positions can optionally go through the spatial hash if they
+               are 2D or 3D */
+            if((flags & RemoveDuplicatesFuzzyFlag::SpatialPositions) &&
+               owned.attributeName(i) == Trade::MeshAttribute::Position &&
+               !owned.attributeArraySize(i) &&
+               attributeEpsilon > 0.0f &&
+               (format == VertexFormat::Vector2 || format == VertexFormat::Vector3))
+            {
+                if(format == VertexFormat::Vector2)
+                    removeDuplicatesSpatialInPlaceInto(owned.mutableAttribute<Vector2>(i), outputIndices, attributeEpsilon);
+                else
+                    removeDuplicatesSpatialInPlaceInto(owned.mutableAttribute<Vector3>(i), outputIndices, attributeEpsilon);
+            } else removeDuplicatesFuzzyInPlaceIntoImplementation(attribute, outputIndices, attributeEpsilon);
 
         /* Doubles. No builtin attributes support those at the moment, so
            there's just the epsilon scaling based on attribute value range */
@@ -611,4 +980,8 @@ Trade::MeshData removeDuplicatesFuzzy(const Trade::MeshData& data, const Float f
     return out;
 }
 
+Trade::MeshData removeDuplicatesFuzzy(const Trade::MeshData& data, const Float floatEpsilon, const Double doubleEpsilon) {
+    return removeDuplicatesFuzzy(data, {}, floatEpsilon, doubleEpsilon);
+}
+
 }}
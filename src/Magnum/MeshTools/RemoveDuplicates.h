@@ -26,10 +26,11 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::removeDuplicatesInPlace(), @ref Magnum::MeshTools::removeDuplicatesIndexedInPlace()
+ * @brief Function @ref Magnum::MeshTools::removeDuplicatesInPlace(), @ref Magnum::MeshTools::removeDuplicatesRadixInPlace(), @ref Magnum::MeshTools::removeDuplicatesIndexedInPlace(), @ref Magnum::MeshTools::removeDuplicatesSpatialInPlace(), enum @ref Magnum::MeshTools::RemoveDuplicatesFuzzyFlag, enum set @ref Magnum::MeshTools::RemoveDuplicatesFuzzyFlags
  */
 
 #include <utility>
+#include <Corrade/Containers/EnumSet.h>
 
 #include "Magnum/Magnum.h"
 #include "Magnum/Math/TypeTraits.h"
@@ -48,6 +49,9 @@ namespace Magnum { namespace MeshTools {
 @brief Remove duplicate data from given array in-place
 @param[in,out] data Data array, duplicate items will be cut away with order
     preserved
+@param[in]     threadCount Max count of threads to use. If @cpp 0 @ce,
+    @ref TaskScheduler::threadCount() of @ref TaskScheduler::global() is
+    used.
 @return The resulting index array and size of unique prefix in the cleaned up
     @p data array
 @m_since{2020,06}
@@ -57,24 +61,41 @@ each item, the second dimension is expected to be contiguous. A plain bit-exact
 matching is used, if you need fuzzy comparison for floating-point data, use
 @ref removeDuplicatesFuzzyInPlace() instead. If you want to remove duplicate
 data from an already indexed array, use
-@ref removeDuplicatesIndexedInPlace(const Containers::StridedArrayView1D<UnsignedInt>&, const Containers::StridedArrayView2D<char>&)
+@ref removeDuplicatesIndexedInPlace(const Containers::StridedArrayView1D<UnsignedInt>&, const Containers::StridedArrayView2D<char>&, UnsignedInt)
 instead. Usage example:
 
 @snippet MagnumMeshTools.cpp removeDuplicates
 
-See @ref removeDuplicates(const Containers::StridedArrayView2D<const char>&)
+The operation is done in a single pass with an open-addressing hash table that
+allocates just one index per input item, making it linear in the item count.
+The output is deterministic --- the unique items always keep the order of
+their first occurrence.
+
+If more than one thread is used, the items are hashed in parallel and
+partitioned by their hash into up to @p threadCount parts, each having at
+least a few thousand items. Each part is then deduplicated with its own hash
+table in a separate task submitted to @ref TaskScheduler::global(). Equal
+items always end up in the same part and each part is processed in the
+original order, so the output is the same as with a single thread. The unique items are
+then compacted to the prefix in a serial pass. Compared to the single-threaded
+variant this allocates an additional hash and index for each item.
+
+See @ref removeDuplicates(const Containers::StridedArrayView2D<const char>&, UnsignedInt)
 for a variant that doesn't modify the input data in any way but instead returns
 an index array pointing to original data locations.
 @see @ref Corrade::Containers::StridedArrayView::isContiguous(),
     @ref removeDuplicatesInPlaceInto()
 */
-MAGNUM_MESHTOOLS_EXPORT std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicatesInPlace(const Containers::StridedArrayView2D<char>& data);
+MAGNUM_MESHTOOLS_EXPORT std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicatesInPlace(const Containers::StridedArrayView2D<char>& data, UnsignedInt threadCount = 0);
 
 /**
 @brief Remove duplicate data from given array in-place into given output index array
 @param[in,out] data     Data array, duplicate items will be cut away with order
     preserved
 @param[out]    indices  Where to put the resulting index array
+@param[in]     threadCount Max count of threads to use. If @cpp 0 @ce,
+    @ref TaskScheduler::threadCount() of @ref TaskScheduler::global() is
+    used.
 @return Size of unique prefix in the cleaned up @p data array
 @m_since{2020,06}
 
@@ -82,33 +103,81 @@ Same as above, except that the index array is not allocated but put into
 @p indices instead. Expects that @p indices has the same size as @p data.
 @see @ref removeDuplicatesInto()
 */
-MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesInPlaceInto(const Containers::StridedArrayView2D<char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices);
+MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesInPlaceInto(const Containers::StridedArrayView2D<char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices, UnsignedInt threadCount = 0);
+
+/**
+@brief Remove duplicate data from given array in-place using a radix sort
+@param[in,out] data Data array, duplicate items will be cut away with order
+    preserved
+@return The resulting index array and size of unique prefix in the cleaned up
+    @p data array
+@m_since_latest
+
+Produces the same output as @ref removeDuplicatesInPlace(), but instead of
+hashing the items it sorts a permutation of them with a stable LSD radix sort
+over all bytes in the second dimension and then compacts runs of equal items.
+Bytes that are the same in all items are skipped, so for example index tuples
+with small values take only a few passes. Apart from the output, the function
+allocates two indices per input item and a 256-entry histogram for each byte,
+independently of how many duplicates there are.
+
+Meant mainly for combining many narrow fixed-size items such as index tuples
+of large OBJ-like meshes, where a hash table gets slow due to random memory
+access. For wide items the number of passes grows linearly with the item size
+and @ref removeDuplicatesInPlace() is likely the better choice. The second
+dimension of @p data is expected to be contiguous.
+@see @ref combineIndexedAttributes(),
+    @ref Corrade::Containers::StridedArrayView::isContiguous(),
+    @ref removeDuplicatesRadixInPlaceInto()
+*/
+MAGNUM_MESHTOOLS_EXPORT std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicatesRadixInPlace(const Containers::StridedArrayView2D<char>& data);
+
+/**
+@brief Remove duplicate data from given array in-place into given output index array using a radix sort
+@param[in,out] data     Data array, duplicate items will be cut away with order
+    preserved
+@param[out]    indices  Where to put the resulting index array
+@return Size of unique prefix in the cleaned up @p data array
+@m_since_latest
+
+Same as above, except that the index array is not allocated but put into
+@p indices instead. Expects that @p indices has the same size as @p data.
+*/
+MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesRadixInPlaceInto(const Containers::StridedArrayView2D<char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices);
 
 /**
 @brief Remove duplicate data from given array
 @param[in] data     Data array
+@param[in] threadCount Max count of threads to use. If @cpp 0 @ce,
+    @ref TaskScheduler::threadCount() of @ref TaskScheduler::global() is
+    used.
 @return The resulting index array and count of unique items in the original
     @p data array
 @m_since{2020,06}
 
-Compared to @ref removeDuplicatesInPlace(const Containers::StridedArrayView2D<char>&)
+Compared to @ref removeDuplicatesInPlace(const Containers::StridedArrayView2D<char>&, UnsignedInt)
 this function doesn't modify the input data array in any way but instead
-returns an index array pointing to original data locations.
+returns an index array pointing to original data locations. The work is
+distributed across threads the same way, with the final compaction pass
+skipped.
 */
-MAGNUM_MESHTOOLS_EXPORT std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicates(const Containers::StridedArrayView2D<const char>& data);
+MAGNUM_MESHTOOLS_EXPORT std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicates(const Containers::StridedArrayView2D<const char>& data, UnsignedInt threadCount = 0);
 
 /**
 @brief Remove duplicate data from given array into given output index array
 @param[in]  data    Data array
 @param[out] indices Where to put the resulting index array
+@param[in]  threadCount Max count of threads to use. If @cpp 0 @ce,
+    @ref TaskScheduler::threadCount() of @ref TaskScheduler::global() is
+    used.
 @return Count of unique items in the original @p data array
 @m_since{2020,06}
 
-Compared to @ref removeDuplicatesInPlaceInto(const Containers::StridedArrayView2D<char>&, const Containers::StridedArrayView1D<UnsignedInt>&)
+Compared to @ref removeDuplicatesInPlaceInto(const Containers::StridedArrayView2D<char>&, const Containers::StridedArrayView1D<UnsignedInt>&, UnsignedInt)
 this function doesn't modify the input data array in any way but instead
 makes an index array pointing to original data locations.
 */
-MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesInto(const Containers::StridedArrayView2D<const char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices);
+MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesInto(const Containers::StridedArrayView2D<const char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices, UnsignedInt threadCount = 0);
 
 /**
 @brief Remove duplicates from indexed data in-place
@@ -116,26 +185,29 @@ MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesInto(const Containers::Strid
     unique data
 @param[in,out] data     Data array, duplicate items will be cut away with order
     preserved
+@param[in]     threadCount Max count of threads to use. If @cpp 0 @ce,
+    @ref TaskScheduler::threadCount() of @ref TaskScheduler::global() is
+    used.
 @return Size of unique prefix in the cleaned up @p data array
 @m_since{2020,06}
 
-Compared to @ref removeDuplicatesInPlace(const Containers::StridedArrayView2D<char>&)
+Compared to @ref removeDuplicatesInPlace(const Containers::StridedArrayView2D<char>&, UnsignedInt)
 this variant is more suited for data that is already indexed as it works on
 the existing index array instead of allocating a new one.
 */
-MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesIndexedInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView2D<char>& data);
+MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesIndexedInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView2D<char>& data, UnsignedInt threadCount = 0);
 
 /**
  * @overload
  * @m_since{2020,06}
  */
-MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesIndexedInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView2D<char>& data);
+MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesIndexedInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView2D<char>& data, UnsignedInt threadCount = 0);
 
 /**
  * @overload
  * @m_since{2020,06}
  */
-MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesIndexedInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView2D<char>& data);
+MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesIndexedInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView2D<char>& data, UnsignedInt threadCount = 0);
 
 /**
 @brief Remove duplicates from indexed data in-place on a type-erased index array
@@ -143,10 +215,10 @@ MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesIndexedInPlace(const Contain
 
 Expects that the second dimension of @p indices is contiguous and represents
 the actual 1/2/4-byte index type. Based on its size then calls one of the
-@ref removeDuplicatesIndexedInPlace(const Containers::StridedArrayView1D<UnsignedInt>&, const Containers::StridedArrayView2D<char>&)
+@ref removeDuplicatesIndexedInPlace(const Containers::StridedArrayView1D<UnsignedInt>&, const Containers::StridedArrayView2D<char>&, UnsignedInt)
 etc. overloads.
 */
-MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesIndexedInPlace(const Containers::StridedArrayView2D<char>& indices, const Containers::StridedArrayView2D<char>& data);
+MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesIndexedInPlace(const Containers::StridedArrayView2D<char>& indices, const Containers::StridedArrayView2D<char>& data, UnsignedInt threadCount = 0);
 
 /**
 @brief Remove duplicate data from given array using fuzzy comparison in-place
@@ -162,7 +234,7 @@ Removes duplicate data from the array by collapsing them into buckets of size
 @p epsilon. First vector in given bucket is used, other ones are thrown away,
 no interpolation is done. Note that this function is meant to be used for
 floating-point data (or generally with non-zero @p epsilon), for data where
-bit-exact matching is sufficient use @ref removeDuplicatesInPlace(const Containers::StridedArrayView2D<char>&)
+bit-exact matching is sufficient use @ref removeDuplicatesInPlace(const Containers::StridedArrayView2D<char>&, UnsignedInt)
 instead.
 
 If you want to remove duplicate data from an already indexed array, use
@@ -288,6 +360,70 @@ MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesFuzzyIndexedInPlace(const Co
  */
 MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesFuzzyIndexedInPlace(const Containers::StridedArrayView2D<char>& indices, const Containers::StridedArrayView2D<Double>& data, Double epsilon = Math::TypeTraits<Double>::epsilon());
 
+/**
+@brief Remove duplicate positions using a spatial hash in-place
+@param[in,out] positions    Position array, duplicate items will be cut away
+    with order preserved
+@param[in] epsilon          Epsilon value, positions closer than this
+    distance will be melt together. Expected to be positive.
+@param[in] scratchMemoryBudget Max amount of memory in bytes for the spatial
+    hash bucket table. If @cpp 0 @ce, the table has twice as many buckets as
+    there are positions.
+@return The resulting index array and size of unique prefix in the cleaned up
+    @p positions array
+@m_since_latest
+
+Compared to @ref removeDuplicatesFuzzyInPlace(), which discretizes the data
+and repeats the operation once for each dimension, this puts the positions
+into a grid of cells of @p epsilon size and looks for a match only in the
+immediately neighboring cells. Positions right at a cell boundary thus still
+get correctly merged and the operation is done in a single pass with expected
+linear complexity. A position gets merged with the earliest unique position
+that's within @p epsilon Euclidean distance, which makes the output
+deterministic and not dependent on @p scratchMemoryBudget. Note that the
+comparison isn't transitive --- a chain of positions each closer than
+@p epsilon to its neighbor isn't merged together if its ends are further
+apart.
+
+Apart from the bucket table, the operation allocates a single
+@relativeref{Magnum,UnsignedInt} per position. Limiting @p scratchMemoryBudget
+makes more cells share the same bucket, which makes the operation slower but
+doesn't affect the result.
+@see @ref removeDuplicatesFuzzy(const Trade::MeshData&, RemoveDuplicatesFuzzyFlags, Float, Double)
+*/
+MAGNUM_MESHTOOLS_EXPORT std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicatesSpatialInPlace(const Containers::StridedArrayView1D<Vector3>& positions, Float epsilon, std::size_t scratchMemoryBudget = 0);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicatesSpatialInPlace(const Containers::StridedArrayView1D<Vector2>& positions, Float epsilon, std::size_t scratchMemoryBudget = 0);
+
+/**
+@brief Remove duplicate positions using a spatial hash in-place into given output index array
+@param[in,out] positions    Position array, duplicate items will be cut away
+    with order preserved
+@param[out] indices         Where to put the resulting index array
+@param[in] epsilon          Epsilon value, positions closer than this
+    distance will be melt together. Expected to be positive.
+@param[in] scratchMemoryBudget Max amount of memory in bytes for the spatial
+    hash bucket table. If @cpp 0 @ce, the table has twice as many buckets as
+    there are positions.
+@return Size of unique prefix in the cleaned up @p positions array
+@m_since_latest
+
+Same as above, except that the index array is not allocated but put into
+@p indices instead. Expects that @p indices has the same size as
+@p positions.
+*/
+MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesSpatialInPlaceInto(const Containers::StridedArrayView1D<Vector3>& positions, const Containers::StridedArrayView1D<UnsignedInt>& indices, Float epsilon, std::size_t scratchMemoryBudget = 0);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesSpatialInPlaceInto(const Containers::StridedArrayView1D<Vector2>& positions, const Containers::StridedArrayView1D<UnsignedInt>& indices, Float epsilon, std::size_t scratchMemoryBudget = 0);
+
 /**
 @brief Remove mesh data duplicates
 @m_since{2020,06}
@@ -305,25 +441,67 @@ have an implementation-specific format.
 
 In order to remove random padding values from the input and make the vertices
 suitable for fast in-place duplicate removal, this function unconditionally
-copies and interleaves the input vertex and index data.
+copies and interleaves the input vertex and index data. The @p threadCount is
+passed through to the above functions.
 @see @ref isMeshIndexTypeImplementationSpecific(),
     @ref isVertexFormatImplementationSpecific()
 */
-MAGNUM_MESHTOOLS_EXPORT Trade::MeshData removeDuplicates(const Trade::MeshData& data);
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData removeDuplicates(const Trade::MeshData& data, UnsignedInt threadCount = 0);
 
 /**
 @brief Remove mesh data duplicates with fuzzy comparison for floating-point attributes
 @m_since{2020,06}
 
-Compared to @ref removeDuplicates(const Trade::MeshData&), calls
+Compared to @ref removeDuplicates(const Trade::MeshData&, UnsignedInt), calls
 @ref removeDuplicatesFuzzyInPlace() or @ref removeDuplicatesFuzzyIndexedInPlace()
 on floating-point attributes. For attributes with a known range (such as
 @ref Trade::MeshAttribute::Normal being always @f$ [-1, 1] @f$ in each
 direction) the @p floatEpsilon / @p doubleEpsilon is scaled appropriately,
 otherwise it's scaled to calculated value range.
+@see @ref removeDuplicatesFuzzy(const Trade::MeshData&, RemoveDuplicatesFuzzyFlags, Float, Double)
 */
 MAGNUM_MESHTOOLS_EXPORT Trade::MeshData removeDuplicatesFuzzy(const Trade::MeshData& data, Float floatEpsilon = Math::TypeTraits<Float>::epsilon(), Double doubleEpsilon = Math::TypeTraits<Double>::epsilon());
 
+/**
+@brief Fuzzy duplicate removal behavior flag
+@m_since_latest
+
+@see @ref RemoveDuplicatesFuzzyFlags,
+    @ref removeDuplicatesFuzzy(const Trade::MeshData&, RemoveDuplicatesFuzzyFlags, Float, Double)
+*/
+enum class RemoveDuplicatesFuzzyFlag: UnsignedInt {
+    /**
+     * Use @ref removeDuplicatesSpatialInPlaceInto() for
+     * @ref Trade::MeshAttribute::Position attributes that are
+     * @ref VertexFormat::Vector2 or @ref VertexFormat::Vector3 instead of
+     * the discretization-based @ref removeDuplicatesFuzzyInPlaceInto().
+     * Significantly faster and using less memory on large meshes, and
+     * merging positions based on their Euclidean distance instead of
+     * per-component comparison.
+     */
+    SpatialPositions = 1 << 0
+};
+
+/**
+@brief Fuzzy duplicate removal behavior flags
+@m_since_latest
+
+@see @ref removeDuplicatesFuzzy(const Trade::MeshData&, RemoveDuplicatesFuzzyFlags, Float, Double)
+*/
+typedef Containers::EnumSet<RemoveDuplicatesFuzzyFlag> RemoveDuplicatesFuzzyFlags;
+
+CORRADE_ENUMSET_OPERATORS(RemoveDuplicatesFuzzyFlags)
+
+/**
+@brief Remove mesh data duplicates with fuzzy comparison for floating-point attributes and given flags
+@m_since_latest
+
+Same as @ref removeDuplicatesFuzzy(const Trade::MeshData&, Float, Double), but
+with behavior controlled by @p flags. The epsilon for positions is scaled to
+the calculated value range in both cases.
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData removeDuplicatesFuzzy(const Trade::MeshData& data, RemoveDuplicatesFuzzyFlags flags, Float floatEpsilon = Math::TypeTraits<Float>::epsilon(), Double doubleEpsilon = Math::TypeTraits<Double>::epsilon());
+
 #ifdef MAGNUM_BUILD_DEPRECATED
 template<class Vector> std::vector<UnsignedInt> removeDuplicates(std::vector<Vector>& data, typename Vector::Type epsilon) {
     /* A trivial index array that'll be remapped and returned after */
@@ -0,0 +1,416 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Simplify.h"
+
+#include <algorithm>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+
+#include "Magnum/ProfileScope.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/FunctionsBatch.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/Implementation/Tipsify.h"
+#include "Magnum/MeshTools/Reference.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Symmetric 4x4 matrix of the plane equation products, only the upper
+   triangle is stored. Doubles because the values get accumulated over many
+   collapses. */
+struct Quadric {
+    Double a2, ab, ac, ad, b2, bc, bd, c2, cd, d2;
+    Double weight;
+};
+
+Quadric& operator+=(Quadric& a, const Quadric& b) {
+    a.a2 += b.a2; a.ab += b.ab; a.ac += b.ac; a.ad += b.ad;
+    a.b2 += b.b2; a.bc += b.bc; a.bd += b.bd;
+    a.c2 += b.c2; a.cd += b.cd;
+    a.d2 += b.d2;
+    a.weight += b.weight;
+    return a;
+}
+
+/* Area-weighted quadric of a triangle plane */
+Quadric planeQuadric(const Vector3& a, const Vector3& b, const Vector3& c) {
+    const Vector3d normal = Math::cross(Vector3d{b - a}, Vector3d{c - a});
+    const Double length = normal.length();
+    if(length == 0.0) return Quadric{};
+    const Vector3d n = normal/length;
+    const Double d = -Math::dot(n, Vector3d{a});
+    const Double w = length*0.5;
+    return Quadric{
+        w*n.x()*n.x(), w*n.x()*n.y(), w*n.x()*n.z(), w*n.x()*d,
+        w*n.y()*n.y(), w*n.y()*n.z(), w*n.y()*d,
+        w*n.z()*n.z(), w*n.z()*d,
+        w*d*d,
+        w};
+}
+
+/* Average squared distance of the point to all planes in the quadric */
+Double quadricError(const Quadric& q, const Vector3& point) {
+    if(q.weight == 0.0) return 0.0;
+    const Double x = point.x(), y = point.y(), z = point.z();
+    const Double error =
+        q.a2*x*x + 2.0*q.ab*x*y + 2.0*q.ac*x*z + 2.0*q.ad*x +
+        q.b2*y*y + 2.0*q.bc*y*z + 2.0*q.bd*y +
+        q.c2*z*z + 2.0*q.cd*z +
+        q.d2;
+    /* Can get slightly negative due to precision */
+    return Math::max(error, 0.0)/q.weight;
+}
+
+struct Collapse {
+    UnsignedInt from, to;
+    Double error;
+};
+
+/* Drops triangles that reference the same vertex more than once, returns
+   the new index count */
+std::size_t removeDegenerateTriangles(const Containers::ArrayView<UnsignedInt> indices) {
+    std::size_t out = 0;
+    for(std::size_t i = 0; i != indices.size(); i += 3) {
+        const UnsignedInt a = indices[i + 0];
+        const UnsignedInt b = indices[i + 1];
+        const UnsignedInt c = indices[i + 2];
+        if(a == b || b == c || c == a) continue;
+        indices[out++] = a;
+        indices[out++] = b;
+        indices[out++] = c;
+    }
+    return out;
+}
+
+template<class T> std::size_t simplifyInPlaceImplementation(const Containers::StridedArrayView1D<T>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const std::size_t targetIndexCount, const Float targetError) {
+    CORRADE_ASSERT(indices.size() % 3 == 0,
+        "MeshTools::simplifyInPlace(): index count" << indices.size() << "not divisible by 3", {});
+    #ifndef CORRADE_NO_ASSERT
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        CORRADE_ASSERT(indices[i] < positions.size(),
+            "MeshTools::simplifyInPlace(): index" << indices[i] << "out of bounds for" << positions.size() << "elements", {});
+    #endif
+
+    /* Nothing to do */
+    if(indices.size() <= targetIndexCount) return indices.size();
+
+    const UnsignedInt vertexCount = positions.size();
+
+    /* Operate on a 32-bit copy so the adjacency can be reused for all index
+       types. Degenerate triangles have no contribution to the surface, get
+       rid of them upfront. */
+    Containers::Array<UnsignedInt> work{NoInit, indices.size()};
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        work[i] = indices[i];
+    std::size_t indexCount = removeDegenerateTriangles(work);
+
+    /* The error is relative to the mesh size. A mesh where all positions are
+       the same is taken as a unit one. */
+    const std::pair<Vector3, Vector3> minmax = Math::minmax(positions);
+    Float extent = (minmax.second - minmax.first).max();
+    if(extent == 0.0f) extent = 1.0f;
+    const Double maxErrorSquared = Math::pow<2>(Double(targetError)*extent);
+
+    /* Initial vertex quadrics */
+    Containers::Array<Quadric> quadrics{ValueInit, vertexCount};
+    for(std::size_t i = 0; i != indexCount; i += 3) {
+        const Quadric q = planeQuadric(positions[work[i + 0]], positions[work[i + 1]], positions[work[i + 2]]);
+        for(std::size_t j = 0; j != 3; ++j)
+            quadrics[work[i + j]] += q;
+    }
+
+    /* Lock vertices on edges that aren't shared by exactly two triangles.
+       That's mesh borders, which includes attribute seams where vertices are
+       duplicated, and non-manifold edges. */
+    Containers::Array<bool> locked{ValueInit, vertexCount};
+    {
+        Containers::Array<UnsignedLong> edges{NoInit, indexCount};
+        for(std::size_t i = 0; i != indexCount; ++i) {
+            const UnsignedInt a = work[i];
+            const UnsignedInt b = work[i - i%3 + (i + 1)%3];
+            edges[i] = UnsignedLong(Math::min(a, b)) << 32 | Math::max(a, b);
+        }
+        std::sort(edges.begin(), edges.end());
+        for(std::size_t i = 0; i != edges.size(); ) {
+            std::size_t j = i + 1;
+            while(j != edges.size() && edges[j] == edges[i]) ++j;
+            if(j - i != 2) {
+                locked[edges[i] >> 32] = true;
+                locked[edges[i] & 0xffffffffu] = true;
+            }
+            i = j;
+        }
+    }
+
+    Containers::Array<UnsignedInt> remap{NoInit, vertexCount};
+    for(UnsignedInt i = 0; i != vertexCount; ++i)
+        remap[i] = i;
+    Containers::Array<bool> touched{NoInit, vertexCount};
+    /* Stamps for the link condition check, to avoid clearing the arrays for
+       each candidate */
+    Containers::Array<UnsignedInt> neighborStamp{ValueInit, vertexCount};
+    Containers::Array<UnsignedInt> commonStamp{ValueInit, vertexCount};
+    UnsignedInt stamp = 0;
+    Containers::Array<Collapse> candidates{NoInit, indexCount};
+    Containers::Array<UnsignedInt> liveTriangleCount, neighborOffset, neighbors;
+
+    /* Each pass collapses a set of independent edges, i.e. ones where no
+       two collapses share a triangle, and then rebuilds the adjacency */
+    while(indexCount > targetIndexCount) {
+        Implementation::buildAdjacency(Containers::StridedArrayView1D<const UnsignedInt>{work.prefix(indexCount)}, vertexCount, liveTriangleCount, neighborOffset, neighbors);
+
+        /* Each triangle edge in one direction, the other gets added by the
+           neighbor triangle. Locked vertices can be collapsed onto, but not
+           away. */
+        std::size_t candidateCount = 0;
+        for(std::size_t i = 0; i != indexCount; ++i) {
+            const UnsignedInt from = work[i];
+            const UnsignedInt to = work[i - i%3 + (i + 1)%3];
+            if(locked[from]) continue;
+
+            Quadric q = quadrics[from];
+            q += quadrics[to];
+            const Double error = quadricError(q, positions[to]);
+            if(error > maxErrorSquared) continue;
+
+            candidates[candidateCount++] = Collapse{from, to, error};
+        }
+
+        /* Sort with a full ordering so the result doesn't depend on the
+           sort implementation */
+        std::sort(candidates.begin(), candidates.begin() + candidateCount, [](const Collapse& a, const Collapse& b) {
+            if(a.error != b.error) return a.error < b.error;
+            if(a.from != b.from) return a.from < b.from;
+            return a.to < b.to;
+        });
+
+        for(bool& i: touched) i = false;
+        std::size_t removedIndexCount = 0;
+        for(std::size_t i = 0; i != candidateCount && indexCount - removedIndexCount > targetIndexCount; ++i) {
+            const UnsignedInt from = candidates[i].from;
+            const UnsignedInt to = candidates[i].to;
+
+            /* Neighborhood of either vertex was changed by a collapse in this
+               pass already */
+            if(touched[from] || touched[to]) continue;
+
+            const Containers::ArrayView<const UnsignedInt> fromTriangles = neighbors.slice(neighborOffset[from], neighborOffset[from + 1]);
+            const Containers::ArrayView<const UnsignedInt> toTriangles = neighbors.slice(neighborOffset[to], neighborOffset[to + 1]);
+
+            /* Mark all vertices neighboring the target vertex */
+            ++stamp;
+            for(const UnsignedInt triangle: toTriangles)
+                for(std::size_t j = 0; j != 3; ++j)
+                    neighborStamp[work[triangle*3 + j]] = stamp;
+
+            /* Triangles containing both vertices get removed by the collapse,
+               the rest shouldn't flip. Count vertices neighboring both,
+               which for the collapse to keep the topology should be exactly
+               the vertices opposite to the removed edge. */
+            std::size_t removedTriangleCount = 0;
+            std::size_t commonNeighborCount = 0;
+            bool valid = true;
+            for(const UnsignedInt triangle: fromTriangles) {
+                const UnsignedInt* const t = work + triangle*3;
+                bool containsTo = false;
+                for(std::size_t j = 0; j != 3; ++j) {
+                    const UnsignedInt vertex = t[j];
+                    if(vertex == to) containsTo = true;
+                    else if(vertex != from && neighborStamp[vertex] == stamp && commonStamp[vertex] != stamp) {
+                        commonStamp[vertex] = stamp;
+                        ++commonNeighborCount;
+                    }
+                }
+
+                if(containsTo) {
+                    ++removedTriangleCount;
+                    continue;
+                }
+
+                const Vector3 a = positions[t[0]];
+                const Vector3 b = positions[t[1]];
+                const Vector3 c = positions[t[2]];
+                const Vector3 na = t[0] == from ? positions[to] : a;
+                const Vector3 nb = t[1] == from ? positions[to] : b;
+                const Vector3 nc = t[2] == from ? positions[to] : c;
+                if(Math::dot(Math::cross(b - a, c - a), Math::cross(nb - na, nc - na)) <= 0.0f) {
+                    valid = false;
+                    break;
+                }
+            }
+
+            if(!valid || !removedTriangleCount || commonNeighborCount != removedTriangleCount)
+                continue;
+
+            remap[from] = to;
+            quadrics[to] += quadrics[from];
+            removedIndexCount += removedTriangleCount*3;
+            for(const UnsignedInt triangle: fromTriangles)
+                for(std::size_t j = 0; j != 3; ++j)
+                    touched[work[triangle*3 + j]] = true;
+        }
+
+        /* No collapse possible without exceeding the error */
+        if(!removedIndexCount) break;
+
+        for(std::size_t i = 0; i != indexCount; ++i)
+            work[i] = remap[work[i]];
+        indexCount = removeDegenerateTriangles(work.prefix(indexCount));
+    }
+
+    for(std::size_t i = 0; i != indexCount; ++i)
+        indices[i] = T(work[i]);
+    return indexCount;
+}
+
+}
+
+std::size_t simplifyInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const std::size_t targetIndexCount, const Float targetError) {
+    return simplifyInPlaceImplementation(indices, positions, targetIndexCount, targetError);
+}
+
+std::size_t simplifyInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const std::size_t targetIndexCount, const Float targetError) {
+    return simplifyInPlaceImplementation(indices, positions, targetIndexCount, targetError);
+}
+
+std::size_t simplifyInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const std::size_t targetIndexCount, const Float targetError) {
+    return simplifyInPlaceImplementation(indices, positions, targetIndexCount, targetError);
+}
+
+namespace {
+
+Containers::Array<UnsignedInt> indicesOrTrivial(const Trade::MeshData& mesh) {
+    if(mesh.isIndexed()) return mesh.indicesAsArray();
+
+    Containers::Array<UnsignedInt> indices{NoInit, mesh.vertexCount()};
+    for(UnsignedInt i = 0; i != indices.size(); ++i)
+        indices[i] = i;
+    return indices;
+}
+
+/* Index buffer for a mesh referencing (original) vertex data */
+Containers::Array<char> indexData(const Containers::ArrayView<const UnsignedInt> indices) {
+    Containers::Array<char> out{NoInit, indices.size()*sizeof(UnsignedInt)};
+    Utility::copy(Containers::arrayCast<const char>(indices), out);
+    return out;
+}
+
+}
+
+Trade::MeshData simplify(const Trade::MeshData& mesh, const UnsignedInt targetIndexCount, const Float targetError) {
+    MAGNUM_PROFILE_SCOPE("MeshTools::simplify()");
+
+    CORRADE_ASSERT(mesh.primitive() == MeshPrimitive::Triangles,
+        "MeshTools::simplify(): expected a" << MeshPrimitive::Triangles << "mesh, got" << mesh.primitive(),
+        (Trade::MeshData{MeshPrimitive{}, 0}));
+    CORRADE_ASSERT(mesh.hasAttribute(Trade::MeshAttribute::Position),
+        "MeshTools::simplify(): the mesh has no positions",
+        (Trade::MeshData{MeshPrimitive{}, 0}));
+    CORRADE_ASSERT(!mesh.isIndexed() || !isMeshIndexTypeImplementationSpecific(mesh.indexType()),
+        "MeshTools::simplify(): mesh has an implementation-specific index type" << reinterpret_cast<void*>(meshIndexTypeUnwrap(mesh.indexType())),
+        (Trade::MeshData{MeshPrimitive{}, 0}));
+
+    const Containers::Array<Vector3> positions = mesh.positions3DAsArray();
+    Containers::Array<UnsignedInt> indices = indicesOrTrivial(mesh);
+    const std::size_t indexCount = simplifyInPlaceImplementation(Containers::StridedArrayView1D<UnsignedInt>{indices}, positions, targetIndexCount, targetError);
+
+    Containers::Array<char> data = indexData(indices.prefix(indexCount));
+    const Trade::MeshIndexData indexDataDescription{MeshIndexType::UnsignedInt, data};
+    /* Make a copy of the vertex data, keeping the attribute layout */
+    return owned(Trade::MeshData{MeshPrimitive::Triangles,
+        std::move(data), indexDataDescription,
+        {}, mesh.vertexData(),
+        Trade::meshAttributeDataNonOwningArray(mesh.attributeData()),
+        mesh.vertexCount()});
+}
+
+Containers::Array<Containers::Array<UnsignedInt>> generateLods(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt lodCount, const Float reductionFactor, const Float targetError) {
+    CORRADE_ASSERT(lodCount,
+        "MeshTools::generateLods(): expected at least one level", {});
+    CORRADE_ASSERT(reductionFactor > 0.0f && reductionFactor < 1.0f,
+        "MeshTools::generateLods(): expected reduction factor to be in range (0, 1) but got" << reductionFactor, {});
+
+    Containers::Array<Containers::Array<UnsignedInt>> lods;
+    arrayReserve(lods, lodCount);
+
+    Containers::Array<UnsignedInt> lod{NoInit, indices.size()};
+    Utility::copy(indices, lod);
+    arrayAppend(lods, std::move(lod));
+
+    /* Each level is made from the previous one */
+    for(UnsignedInt i = 1; i != lodCount; ++i) {
+        const Containers::ArrayView<const UnsignedInt> previous = lods[i - 1];
+        Containers::Array<UnsignedInt> next{NoInit, previous.size()};
+        Utility::copy(previous, next);
+        const std::size_t indexCount = simplifyInPlaceImplementation(Containers::StridedArrayView1D<UnsignedInt>{next}, positions, std::size_t(previous.size()*reductionFactor), targetError);
+
+        /* Can't reduce any further, stop */
+        if(indexCount == previous.size()) break;
+
+        Containers::Array<UnsignedInt> shrunk{NoInit, indexCount};
+        Utility::copy(next.prefix(indexCount), shrunk);
+        arrayAppend(lods, std::move(shrunk));
+    }
+
+    /* Convert the growable array back to a default deleter so the users
+       don't need to care */
+    arrayShrink(lods, DefaultInit);
+
+    return lods;
+}
+
+Containers::Array<Trade::MeshData> generateLods(const Trade::MeshData& mesh, const UnsignedInt lodCount, const Float reductionFactor, const Float targetError) {
+    CORRADE_ASSERT(mesh.primitive() == MeshPrimitive::Triangles,
+        "MeshTools::generateLods(): expected a" << MeshPrimitive::Triangles << "mesh, got" << mesh.primitive(), {});
+    CORRADE_ASSERT(mesh.hasAttribute(Trade::MeshAttribute::Position),
+        "MeshTools::generateLods(): the mesh has no positions", {});
+    CORRADE_ASSERT(!mesh.isIndexed() || !isMeshIndexTypeImplementationSpecific(mesh.indexType()),
+        "MeshTools::generateLods(): mesh has an implementation-specific index type" << reinterpret_cast<void*>(meshIndexTypeUnwrap(mesh.indexType())), {});
+
+    const Containers::Array<Vector3> positions = mesh.positions3DAsArray();
+    const Containers::Array<UnsignedInt> indices = indicesOrTrivial(mesh);
+    const Containers::Array<Containers::Array<UnsignedInt>> lods = generateLods(Containers::StridedArrayView1D<const UnsignedInt>{indices}, positions, lodCount, reductionFactor, targetError);
+
+    /* All levels reference the original vertex data */
+    Containers::Array<Trade::MeshData> out{NoInit, lods.size()};
+    for(std::size_t i = 0; i != lods.size(); ++i) {
+        Containers::Array<char> data = indexData(lods[i]);
+        const Trade::MeshIndexData indexDataDescription{MeshIndexType::UnsignedInt, data};
+        new(&out[i]) Trade::MeshData{MeshPrimitive::Triangles,
+            std::move(data), indexDataDescription,
+            {}, mesh.vertexData(),
+            Trade::meshAttributeDataNonOwningArray(mesh.attributeData()),
+            mesh.vertexCount()};
+    }
+
+    return out;
+}
+
+}}
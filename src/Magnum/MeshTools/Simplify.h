@@ -0,0 +1,154 @@
+#ifndef Magnum_MeshTools_Simplify_h
+#define Magnum_MeshTools_Simplify_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::simplifyInPlace(), @ref Magnum::MeshTools::simplify(), @ref Magnum::MeshTools::generateLods()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Simplify a triangle mesh in-place
+@param[in,out] indices  Triangle indices. The simplified triangles are put
+    into a prefix of the array.
+@param[in] positions    Vertex positions
+@param[in] targetIndexCount Target index count
+@param[in] targetError  Max allowed error, relative to the mesh size
+@return Index count of the simplified mesh
+@m_since_latest
+
+Performs iterative edge collapses ordered by a quadric error metric, as
+described in *Michael Garland, Paul S. Heckbert: Surface Simplification Using
+Quadric Error Metrics, SIGGRAPH 1997*, until the index count is at most
+@p targetIndexCount or no further collapse is possible without exceeding
+@p targetError. The error is a square root of the average squared distance of
+a vertex to the planes of the triangles it replaced, divided by the largest
+dimension of the mesh bounding box --- i.e., @cpp 0.01f @ce allows the
+surface to deviate by roughly one percent of the mesh size.
+
+Edges are always collapsed onto one of their existing vertices and the
+vertices themselves are never moved or created, which means the simplified
+mesh can use the original vertex data unchanged and only the index buffer
+differs. Vertices that are on a mesh border --- i.e., an edge that's used by
+just a single triangle --- are never collapsed. Meshes with per-vertex
+attribute discontinuities such as texture coordinate seams have the vertices
+duplicated along the seam, which in terms of indices looks like a border, so
+the seams are preserved as well. Collapses that would flip the orientation of
+any neighboring triangle are rejected.
+
+The @p indices are expected to have a size divisible by @cpp 3 @ce and all
+be in bounds of @p positions. Vertices that are no longer referenced are kept
+in @p positions, use @ref optimizeVertexFetchInPlace() to remove them
+afterwards if needed.
+@see @ref simplify(), @ref generateLods()
+*/
+MAGNUM_MESHTOOLS_EXPORT std::size_t simplifyInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, std::size_t targetIndexCount, Float targetError);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT std::size_t simplifyInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, std::size_t targetIndexCount, Float targetError);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT std::size_t simplifyInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, std::size_t targetIndexCount, Float targetError);
+
+/**
+@brief Simplify a triangle mesh
+@m_since_latest
+
+Expects that the mesh is a @ref MeshPrimitive::Triangles and has a
+@ref Trade::MeshAttribute::Position attribute, which then gets converted to
+@ref VertexFormat::Vector3 using @ref Trade::MeshData::positions3DAsArray().
+If the mesh is not indexed, it's treated as if each triangle had its own
+unique vertices, in which case nothing can be simplified, so it's recommended
+to call @ref removeDuplicates(const Trade::MeshData&, UnsignedInt) first. The
+index type, if present, is expected to not be implementation-specific. The
+output has @ref MeshIndexType::UnsignedInt indices and a copy of the original
+vertex data. See @ref simplifyInPlace() for more information about the
+algorithm.
+@see @ref generateLods(const Trade::MeshData&, UnsignedInt, Float, Float)
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData simplify(const Trade::MeshData& mesh, UnsignedInt targetIndexCount, Float targetError);
+
+/**
+@brief Generate a chain of level-of-detail index buffers
+@param indices          Triangle indices of the full-detail mesh
+@param positions        Vertex positions
+@param lodCount         Max count of levels to generate, including the full
+    detail one
+@param reductionFactor  Target index count of each level relative to the
+    previous one
+@param targetError      Max allowed error of each level relative to the
+    previous one, see @ref simplifyInPlace() for details
+@return Index buffers for each level, first being a copy of @p indices
+@m_since_latest
+
+Each level is produced by calling @ref simplifyInPlace() on the previous
+level, with the target index count being @p reductionFactor times the
+previous level index count. All levels index the same original vertex data,
+so at runtime it's enough to have a single vertex buffer and one index buffer
+for each level, for example by uploading all index buffers to a single
+@ref GL::Buffer and then creating a mesh for each via
+@ref compile(const Trade::MeshData&, GL::Buffer&, GL::Buffer&). If a level
+can't be reduced any further without exceeding @p targetError, generation
+stops and fewer than @p lodCount levels are returned.
+
+Expects that @p lodCount is at least @cpp 1 @ce and @p reductionFactor is in
+range @f$ (0, 1) @f$.
+@see @ref generateLods(const Trade::MeshData&, UnsignedInt, Float, Float)
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<Containers::Array<UnsignedInt>> generateLods(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt lodCount, Float reductionFactor = 0.5f, Float targetError = 0.01f);
+
+/**
+@brief Generate a chain of level-of-detail meshes
+@m_since_latest
+
+Expects that the mesh is a @ref MeshPrimitive::Triangles and has a
+@ref Trade::MeshAttribute::Position attribute, the index type, if present, is
+expected to not be implementation-specific. The returned meshes each have
+their own @ref MeshIndexType::UnsignedInt index buffer but all of them
+reference the vertex data of @p mesh, similarly to @ref reference(), so
+@p mesh has to stay in scope for as long as the returned meshes are used.
+See @ref generateLods(const Containers::StridedArrayView1D<const UnsignedInt>&, const Containers::StridedArrayView1D<const Vector3>&, UnsignedInt, Float, Float)
+for more information.
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<Trade::MeshData> generateLods(const Trade::MeshData& mesh, UnsignedInt lodCount, Float reductionFactor = 0.5f, Float targetError = 0.01f);
+
+}}
+
+#endif
@@ -0,0 +1,132 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Subdivide.h"
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Implementation/parallelFor.h"
+
+namespace Magnum { namespace MeshTools { namespace Implementation {
+
+namespace {
+
+/* Count of edges or faces processed by a single thread at least, to not spawn
+   threads for tiny meshes */
+constexpr std::size_t BlockSize = 4096;
+
+}
+
+std::size_t subdivideSharedInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const std::size_t vertexCount, const std::size_t vertexCapacity, void(*const interpolate)(void*, Containers::ArrayView<const UnsignedInt>, std::size_t, std::size_t), void* const state, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(!(indices.size()%12), "MeshTools::subdivideSharedInPlace(): can't divide" << indices.size() << "indices to four parts with each having triangle faces", {});
+
+    const std::size_t faceCount = indices.size()/12;
+
+    /* Assign a new vertex to each unique edge, in order the edges are first
+       referenced by the faces. That's the same order as removing duplicates
+       from the output of subdivideInPlace() would produce. It's done serially
+       so the output doesn't depend on the thread count. The edge lookup is an
+       open-addressing table with linear probing that's at most half full,
+       which needs just two allocations compared to an
+       std::unordered_map. */
+    std::size_t tableSize = 1;
+    while(tableSize < faceCount*3*2) tableSize <<= 1;
+    constexpr UnsignedLong EmptyKey = ~UnsignedLong{};
+    Containers::Array<UnsignedLong> tableKeys{DirectInit, tableSize, EmptyKey};
+    Containers::Array<UnsignedInt> tableValues{NoInit, tableSize};
+    Containers::Array<UnsignedInt> edges{NoInit, faceCount*3*2};
+    Containers::Array<UnsignedInt> faceEdgeVertices{NoInit, faceCount*3};
+    std::size_t edgeCount = 0;
+    for(std::size_t i = 0; i != faceCount*3; ++i) {
+        const UnsignedInt a = indices[i];
+        const UnsignedInt b = indices[i - i%3 + (i%3 + 1)%3];
+        const UnsignedLong key = a < b ?
+            UnsignedLong(a) << 32 | b : UnsignedLong(b) << 32 | a;
+
+        /* Fibonacci hashing, taking the upper bits which are mixed the most */
+        std::size_t slot = std::size_t((key*0x9e3779b97f4a7c15ull) >> 32) & (tableSize - 1);
+        while(tableKeys[slot] != key && tableKeys[slot] != EmptyKey)
+            slot = (slot + 1) & (tableSize - 1);
+        if(tableKeys[slot] == EmptyKey) {
+            tableKeys[slot] = key;
+            tableValues[slot] = UnsignedInt(edgeCount);
+            /* Remember the edge in the orientation of the first face that
+               references it, again to match subdivideInPlace() */
+            edges[edgeCount*2 + 0] = a;
+            edges[edgeCount*2 + 1] = b;
+            ++edgeCount;
+        }
+        faceEdgeVertices[i] = vertexCount + tableValues[slot];
+    }
+
+    CORRADE_ASSERT(UnsignedLong(vertexCount) + edgeCount <= 0xffffffffull,
+        "MeshTools::subdivideSharedInPlace(): a 4-byte index type is too small for" << vertexCount + edgeCount << "vertices", {});
+    CORRADE_ASSERT(vertexCount + edgeCount <= vertexCapacity,
+        "MeshTools::subdivideSharedInPlace(): expected at least" << vertexCount + edgeCount << "vertices but got" << vertexCapacity, {});
+    #ifdef CORRADE_NO_ASSERT
+    static_cast<void>(vertexCapacity);
+    #endif
+
+    /* Interpolate the new vertices. Those only read the original vertices,
+       so the edges can be processed in any order. */
+    const Containers::ArrayView<const UnsignedInt> edgesView = edges.prefix(edgeCount*2);
+    Magnum::Implementation::parallelFor((edgeCount + BlockSize - 1)/BlockSize, threadCount, [&](const std::size_t begin, const std::size_t end) {
+        interpolate(state, edgesView, begin*BlockSize, Math::min(end*BlockSize, edgeCount));
+    });
+
+    /* Subdivide each face to four new, with the same layout as
+       subdivideInPlace(). Each face writes only into its own slot and its
+       own three new slots at the end, so the faces can be processed in any
+       order as well. */
+    Magnum::Implementation::parallelFor((faceCount + BlockSize - 1)/BlockSize, threadCount, [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t i = begin*BlockSize, iMax = Math::min(end*BlockSize, faceCount); i < iMax; ++i) {
+            const UnsignedInt original[]{
+                indices[i*3 + 0],
+                indices[i*3 + 1],
+                indices[i*3 + 2]
+            };
+            const UnsignedInt* const newVertices = faceEdgeVertices + i*3;
+
+            const std::size_t indexOffset = faceCount*3 + i*9;
+            indices[indexOffset + 0] = original[0];
+            indices[indexOffset + 1] = newVertices[0];
+            indices[indexOffset + 2] = newVertices[2];
+
+            indices[indexOffset + 3] = newVertices[0];
+            indices[indexOffset + 4] = original[1];
+            indices[indexOffset + 5] = newVertices[1];
+
+            indices[indexOffset + 6] = newVertices[2];
+            indices[indexOffset + 7] = newVertices[1];
+            indices[indexOffset + 8] = original[2];
+            for(std::size_t j = 0; j != 3; ++j)
+                indices[i*3 + j] = newVertices[j];
+        }
+    });
+
+    return vertexCount + edgeCount;
+}
+
+}}}
@@ -26,7 +26,7 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::subdivide(), @ref Magnum::MeshTools::subdivideInPlace()
+ * @brief Function @ref Magnum::MeshTools::subdivide(), @ref Magnum::MeshTools::subdivideInPlace(), @ref Magnum::MeshTools::subdivideShared(), @ref Magnum::MeshTools::subdivideSharedInPlace()
  */
 
 #include <Corrade/Containers/GrowableArray.h>
@@ -35,6 +35,7 @@
 #include <Corrade/Utility/Assert.h>
 
 #include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
 
 #ifdef MAGNUM_BUILD_DEPRECATED
 #include <vector>
@@ -44,6 +45,11 @@ namespace Magnum { namespace MeshTools {
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
 template<class IndexType, class Vertex, class Interpolator> void subdivideInPlace(const Containers::StridedArrayView1D<IndexType>& indices, const Containers::StridedArrayView1D<Vertex>& vertices, Interpolator interpolator);
+template<class Vertex, class Interpolator> std::size_t subdivideSharedInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView1D<Vertex>& vertices, std::size_t vertexCount, Interpolator interpolator, UnsignedInt threadCount = 0);
+
+namespace Implementation {
+    MAGNUM_MESHTOOLS_EXPORT std::size_t subdivideSharedInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, std::size_t vertexCount, std::size_t vertexCapacity, void(*interpolate)(void*, Containers::ArrayView<const UnsignedInt>, std::size_t, std::size_t), void* state, UnsignedInt threadCount);
+}
 #endif
 
 /**
@@ -59,7 +65,8 @@ template<class IndexType, class Vertex, class Interpolator> void subdivideInPlac
 Goes through all triangle faces and subdivides them into four new, enlarging
 the @p indices and @p vertices arrays as appropriate. Removing duplicate
 vertices in the mesh is up to the user.
-@see @ref subdivideInPlace(), @ref removeDuplicatesInPlace()
+@see @ref subdivideInPlace(), @ref subdivideShared(),
+    @ref removeDuplicatesInPlace()
 */
 template<class IndexType, class Vertex, class Interpolator> void subdivide(Containers::Array<IndexType>& indices, Containers::Array<Vertex>& vertices, Interpolator interpolator) {
     CORRADE_ASSERT(!(indices.size()%3), "MeshTools::subdivide(): index count is not divisible by 3", );
@@ -111,7 +118,8 @@ each step. @f[
     \end{array}
 @f]
 
-@see @ref subdivide(), @ref removeDuplicatesInPlace()
+@see @ref subdivide(), @ref subdivideSharedInPlace(),
+    @ref removeDuplicatesInPlace()
 */
 template<class IndexType, class Vertex, class Interpolator> void subdivideInPlace(const Containers::StridedArrayView1D<IndexType>& indices, const Containers::StridedArrayView1D<Vertex>& vertices, Interpolator interpolator) {
     CORRADE_ASSERT(!(indices.size()%12), "MeshTools::subdivideInPlace(): can't divide" << indices.size() << "indices to four parts with each having triangle faces", );
@@ -168,6 +176,93 @@ template<class IndexType, class Vertex, class Interpolator> void subdivideInPlac
     subdivideInPlace(Containers::stridedArrayView(indices), vertices, interpolator);
 }
 
+/**
+@brief Subdivide a mesh with vertices shared across edges
+@tparam Vertex          Vertex data type
+@tparam Interpolator    See the @p interpolator function parameter
+@param[in,out] indices  Index array to operate on
+@param[in,out] vertices Vertex array to operate on
+@param interpolator     Functor or function pointer which interpolates
+    two adjacent vertices: @cpp Vertex interpolator(Vertex a, Vertex b) @ce
+@param threadCount      Max count of threads to use. If @cpp 0 @ce,
+    @ref TaskScheduler::threadCount() of @ref TaskScheduler::global() is used.
+@m_since_latest
+
+Like @ref subdivide(), but faces sharing an edge share also the vertex
+created on that edge, so there's no need to remove duplicates afterwards. The
+@p vertices array is enlarged only by the count of unique edges. See
+@ref subdivideSharedInPlace() for more information.
+*/
+template<class Vertex, class Interpolator> void subdivideShared(Containers::Array<UnsignedInt>& indices, Containers::Array<Vertex>& vertices, Interpolator interpolator, UnsignedInt threadCount = 0) {
+    CORRADE_ASSERT(!(indices.size()%3), "MeshTools::subdivideShared(): index count is not divisible by 3", );
+
+    const std::size_t vertexCount = vertices.size();
+    arrayResize(vertices, NoInit, vertexCount + indices.size());
+    arrayResize(indices, NoInit, indices.size()*4);
+    arrayResize(vertices, subdivideSharedInPlace(Containers::stridedArrayView(indices), Containers::stridedArrayView(vertices), vertexCount, interpolator, threadCount));
+}
+
+/**
+@brief Subdivide a mesh with vertices shared across edges in-place
+@tparam Vertex          Vertex data type
+@tparam Interpolator    See the @p interpolator function parameter
+@param[in,out] indices  Index array to operate on
+@param[in,out] vertices Vertex array to operate on
+@param vertexCount      Count of vertices in @p vertices that are used by
+    the original mesh
+@param interpolator     Functor or function pointer which interpolates
+    two adjacent vertices: @cpp Vertex interpolator(Vertex a, Vertex b) @ce
+@param threadCount      Max count of threads to use. If @cpp 0 @ce,
+    @ref TaskScheduler::threadCount() of @ref TaskScheduler::global() is used.
+@return New vertex count
+@m_since_latest
+
+Like @ref subdivideInPlace(), but instead of creating three new vertices for
+every face, a single vertex is created for every unique edge and shared by all
+faces adjacent to it. The output is thus the same as from
+@ref subdivideInPlace() followed by @ref removeDuplicatesIndexedInPlace(),
+including the vertex order, but without the duplicate vertices ever being
+created and without hashing the vertex data.
+
+Assuming the original mesh has @f$ i @f$ indices, @f$ v @f$ vertices and
+@f$ e @f$ unique edges, expects the @p indices array to have a size of
+@f$ 4i @f$ with the original indices being in the first quarter, and the
+@p vertices array to have a size of at least @f$ v + e @f$, with the original
+vertices being in the first @p vertexCount items. For a closed mesh,
+@f$ e = \frac{1}{2} i @f$, in general @f$ e \le i @f$. The function returns
+@f$ v + e @f$, which can be passed as @p vertexCount to a subsequent
+subdivision step.
+
+The unique edges are found serially, as their order defines order of the
+output vertices. Calculating the new vertices and writing the new faces is
+then distributed over up to @p threadCount threads, which means the
+@p interpolator has to be safe to call from multiple threads at once. If
+Corrade isn't built with @ref CORRADE_BUILD_MULTITHREADED or on
+@ref CORRADE_TARGET_EMSCRIPTEN "Emscripten", everything is done on the
+calling thread.
+@see @ref subdivideShared()
+*/
+template<class Vertex, class Interpolator> std::size_t subdivideSharedInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView1D<Vertex>& vertices, const std::size_t vertexCount, Interpolator interpolator, const UnsignedInt threadCount) {
+    struct State {
+        const Containers::StridedArrayView1D<Vertex>& vertices;
+        const std::size_t vertexCount;
+        Interpolator& interpolator;
+    } state{vertices, vertexCount, interpolator};
+    return Implementation::subdivideSharedInPlace(indices, vertexCount, vertices.size(), [](void* statePointer, const Containers::ArrayView<const UnsignedInt> edges, const std::size_t begin, const std::size_t end) {
+        State& state = *static_cast<State*>(statePointer);
+        for(std::size_t i = begin; i != end; ++i)
+            state.vertices[state.vertexCount + i] = state.interpolator(state.vertices[edges[2*i]], state.vertices[edges[2*i + 1]]);
+    }, &state, threadCount);
+}
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+template<class Vertex, class Interpolator> std::size_t subdivideSharedInPlace(const Containers::ArrayView<UnsignedInt>& indices, const Containers::StridedArrayView1D<Vertex>& vertices, std::size_t vertexCount, Interpolator interpolator, UnsignedInt threadCount = 0) {
+    return subdivideSharedInPlace(Containers::stridedArrayView(indices), vertices, vertexCount, interpolator, threadCount);
+}
+
 }}
 
 #endif
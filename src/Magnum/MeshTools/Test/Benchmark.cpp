@@ -0,0 +1,228 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Reference.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/Algorithms.h>
+
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/Codec.h"
+#include "Magnum/MeshTools/Combine.h"
+#include "Magnum/MeshTools/CompressIndices.h"
+#include "Magnum/MeshTools/Concatenate.h"
+#include "Magnum/MeshTools/Duplicate.h"
+#include "Magnum/MeshTools/FilterAttributes.h"
+#include "Magnum/MeshTools/GenerateNormals.h"
+#include "Magnum/MeshTools/Interleave.h"
+#include "Magnum/MeshTools/Quantize.h"
+#include "Magnum/MeshTools/RemoveDuplicates.h"
+#include "Magnum/MeshTools/Tipsify.h"
+#include "Magnum/Primitives/Grid.h"
+#include "Magnum/Primitives/Icosphere.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct Benchmark: TestSuite::Tester {
+    explicit Benchmark();
+
+    void removeDuplicates();
+    void removeDuplicatesFuzzy();
+    void generateSmoothNormals();
+    void interleave();
+    void compressIndices();
+    void tipsify();
+    void concatenate();
+    void duplicate();
+    void combineIndexedAttributes();
+    void decodeIndices();
+    void decodeVertices();
+
+    Trade::MeshData _grid{MeshPrimitive::Triangles, 0};
+    Trade::MeshData _gridDuplicated{MeshPrimitive::Triangles, 0};
+    Trade::MeshData _icosphere{MeshPrimitive::Triangles, 0};
+};
+
+/* A 1000x1000 vertex grid has a million vertices and two million triangles,
+   the duplicated variant has six million vertices. An icosphere with 8
+   subdivisions has about 650k vertices but a much less regular connectivity
+   than the grid. Each benchmark is run just once per repeat, as a single
+   iteration already takes tens to hundreds of milliseconds. */
+constexpr Vector2i GridSubdivisions{998, 998};
+constexpr UnsignedInt GridVertexCount = 1000*1000;
+constexpr UnsignedInt IcosphereSubdivisions = 8;
+constexpr std::size_t Repeats = 5;
+
+Benchmark::Benchmark() {
+    addBenchmarks({&Benchmark::removeDuplicates,
+                   &Benchmark::removeDuplicatesFuzzy,
+                   &Benchmark::generateSmoothNormals,
+                   &Benchmark::interleave,
+                   &Benchmark::compressIndices,
+                   &Benchmark::tipsify,
+                   &Benchmark::concatenate,
+                   &Benchmark::duplicate,
+                   &Benchmark::combineIndexedAttributes,
+                   &Benchmark::decodeIndices,
+                   &Benchmark::decodeVertices}, Repeats);
+
+    _grid = Primitives::grid3DSolid(GridSubdivisions);
+    _gridDuplicated = MeshTools::duplicate(_grid);
+    _icosphere = Primitives::icosphereSolid(IcosphereSubdivisions);
+}
+
+void Benchmark::removeDuplicates() {
+    Trade::MeshData out{MeshPrimitive::Triangles, 0};
+    CORRADE_BENCHMARK(1) {
+        out = MeshTools::removeDuplicates(_gridDuplicated);
+    }
+
+    CORRADE_COMPARE(out.vertexCount(), GridVertexCount);
+}
+
+void Benchmark::removeDuplicatesFuzzy() {
+    Trade::MeshData out{MeshPrimitive::Triangles, 0};
+    CORRADE_BENCHMARK(1) {
+        out = MeshTools::removeDuplicatesFuzzy(_gridDuplicated);
+    }
+
+    CORRADE_COMPARE(out.vertexCount(), GridVertexCount);
+}
+
+void Benchmark::generateSmoothNormals() {
+    Containers::Array<Vector3> out;
+    CORRADE_BENCHMARK(1) {
+        out = MeshTools::generateSmoothNormals(
+            _icosphere.indices<UnsignedInt>(),
+            _icosphere.attribute<Vector3>(Trade::MeshAttribute::Position));
+    }
+
+    CORRADE_COMPARE(out.size(), _icosphere.vertexCount());
+}
+
+void Benchmark::interleave() {
+    Trade::MeshData out{MeshPrimitive::Triangles, 0};
+    CORRADE_BENCHMARK(1) {
+        /* Without PreserveInterleavedAttributes the already-interleaved
+           layout is thrown away and everything gets repacked */
+        out = MeshTools::interleave(_grid, {}, InterleaveFlags{});
+    }
+
+    CORRADE_COMPARE(out.vertexCount(), GridVertexCount);
+}
+
+void Benchmark::compressIndices() {
+    Trade::MeshData out{MeshPrimitive::Triangles, 0};
+    CORRADE_BENCHMARK(1) {
+        out = MeshTools::compressIndices(_grid);
+    }
+
+    /* Too many vertices to fit into 16 bits, so it's just the range
+       calculation and a copy */
+    CORRADE_COMPARE(out.indexType(), MeshIndexType::UnsignedInt);
+    CORRADE_COMPARE(out.indexCount(), _grid.indexCount());
+}
+
+void Benchmark::tipsify() {
+    Containers::Array<UnsignedInt> indices{NoInit, _icosphere.indexCount()};
+    CORRADE_BENCHMARK(1) {
+        /* The copy is negligible compared to the actual operation */
+        Utility::copy(_icosphere.indices<UnsignedInt>(), indices);
+        MeshTools::tipsifyInPlace(indices, _icosphere.vertexCount(), 24);
+    }
+
+    CORRADE_COMPARE(indices.size(), _icosphere.indexCount());
+}
+
+void Benchmark::concatenate() {
+    Trade::MeshData out{MeshPrimitive::Triangles, 0};
+    CORRADE_BENCHMARK(1) {
+        out = MeshTools::concatenate({_grid, _icosphere, _grid});
+    }
+
+    CORRADE_COMPARE(out.vertexCount(), 2*GridVertexCount + _icosphere.vertexCount());
+}
+
+void Benchmark::duplicate() {
+    Trade::MeshData out{MeshPrimitive::Triangles, 0};
+    CORRADE_BENCHMARK(1) {
+        out = MeshTools::duplicate(_grid);
+    }
+
+    CORRADE_COMPARE(out.vertexCount(), _grid.indexCount());
+}
+
+void Benchmark::combineIndexedAttributes() {
+    /* Two meshes sharing the same index buffer, so the combined mesh ends up
+       with the same vertex count as the original */
+    const Trade::MeshData positions = filterOnlyAttributes(_grid, {Trade::MeshAttribute::Position});
+    const Trade::MeshData normals = filterOnlyAttributes(_grid, {Trade::MeshAttribute::Normal});
+
+    Trade::MeshData out{MeshPrimitive::Triangles, 0};
+    CORRADE_BENCHMARK(1) {
+        out = MeshTools::combineIndexedAttributes({positions, normals});
+    }
+
+    CORRADE_COMPARE(out.vertexCount(), GridVertexCount);
+}
+
+void Benchmark::decodeIndices() {
+    const Containers::Array<char> encoded = MeshTools::encodeIndices(_grid.indices<UnsignedInt>());
+
+    Containers::Array<UnsignedInt> out{NoInit, _grid.indexCount()};
+    CORRADE_BENCHMARK(1) {
+        MeshTools::decodeIndicesInto(encoded, out);
+    }
+
+    CORRADE_COMPARE_AS(out, _grid.indices<UnsignedInt>(),
+        TestSuite::Compare::Container);
+}
+
+void Benchmark::decodeVertices() {
+    /* Quantized positions and normals, 12 bytes per vertex, which is what
+       the codec is designed for */
+    const Trade::MeshData quantized = MeshTools::quantize(_grid).first();
+    const Containers::StridedArrayView2D<const char> vertices = interleavedData(quantized);
+    const Containers::Array<char> encoded = MeshTools::encodeVertices(vertices);
+
+    Containers::Array<char> expected{NoInit, vertices.size()[0]*vertices.size()[1]};
+    Utility::copy(vertices, Containers::StridedArrayView2D<char>{expected, vertices.size()});
+
+    Containers::Array<char> out{NoInit, expected.size()};
+    CORRADE_BENCHMARK(1) {
+        MeshTools::decodeVerticesInto(encoded, Containers::StridedArrayView2D<char>{out, vertices.size()});
+    }
+
+    CORRADE_COMPARE_AS(out, expected,
+        TestSuite::Compare::Container);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::Benchmark)
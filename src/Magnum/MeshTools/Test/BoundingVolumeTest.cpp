@@ -24,23 +24,29 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <sstream>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/Pair.h>
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
 
 #include "Magnum/Math/FunctionsBatch.h"
 #include "Magnum/Math/TypeTraits.h"
 #include "Magnum/Math/Angle.h"
 #include "Magnum/Math/Range.h"
 #include "Magnum/Math/Vector3.h"
+#include "Magnum/Math/BitVector.h"
+#include "Magnum/Math/Matrix4.h"
 #include "Magnum/MeshTools/BoundingVolume.h"
 #include "Magnum/MeshTools/Reference.h"
 #include "Magnum/MeshTools/Transform.h"
 #include "Magnum/Primitives/Capsule.h"
 #include "Magnum/Primitives/Cube.h"
 #include "Magnum/Primitives/Icosphere.h"
+#include "Magnum/Trade/ChunkedMeshData.h"
 #include "Magnum/Trade/MeshData.h"
 
 namespace Magnum { namespace MeshTools { namespace Test { namespace {
@@ -50,21 +56,39 @@ struct BoundingVolumeTest: TestSuite::Tester {
 
     void range();
     void rangeNaN();
+    void rangeChunked();
+    void rangeChunkedEmpty();
+    void ranges();
+    template<class T> void rangesIndexed();
+    void rangesIndexedNaN();
+    void rangesInvalidSize();
+    void rangesOutOfBounds();
 
     void sphereBouncingBubble();
     void sphereBouncingBubbleNaN();
 
     void benchmarkRange();
+    void benchmarkRanges();
     void benchmarkSphereBouncingBubble();
 };
 
 BoundingVolumeTest::BoundingVolumeTest() {
     addTests({&BoundingVolumeTest::range,
               &BoundingVolumeTest::rangeNaN,
+              &BoundingVolumeTest::rangeChunked,
+              &BoundingVolumeTest::rangeChunkedEmpty,
+              &BoundingVolumeTest::ranges,
+              &BoundingVolumeTest::rangesIndexed<UnsignedInt>,
+              &BoundingVolumeTest::rangesIndexed<UnsignedShort>,
+              &BoundingVolumeTest::rangesIndexed<UnsignedByte>,
+              &BoundingVolumeTest::rangesIndexedNaN,
+              &BoundingVolumeTest::rangesInvalidSize,
+              &BoundingVolumeTest::rangesOutOfBounds,
               &BoundingVolumeTest::sphereBouncingBubble,
               &BoundingVolumeTest::sphereBouncingBubbleNaN});
 
     addBenchmarks({&BoundingVolumeTest::benchmarkRange,
+                   &BoundingVolumeTest::benchmarkRanges,
                    &BoundingVolumeTest::benchmarkSphereBouncingBubble}, 150);
 }
 
@@ -102,6 +126,166 @@ void BoundingVolumeTest::rangeNaN() {
     }
 }
 
+void BoundingVolumeTest::rangeChunked() {
+    using namespace Math::Literals;
+
+    Trade::ChunkedMeshData mesh{MeshPrimitive::Points, 5, 3, Containers::array<Range3D>({
+        {{0.0f, 0.0f, 0.0f}, {1.0f, 2.0f, 3.0f}},
+        {{-1.0f, 1.0f, 0.5f}, {0.0f, 1.5f, 1.0f}}
+    })};
+
+    /* With an identity it's just a union */
+    CORRADE_COMPARE(MeshTools::boundingRange(mesh, Matrix4{}),
+        (Range3D{{-1.0f, 0.0f, 0.0f}, {1.0f, 2.0f, 3.0f}}));
+
+    /* Translation and scaling map corners to corners */
+    CORRADE_COMPARE(MeshTools::boundingRange(mesh,
+        Matrix4::translation({1.0f, 0.0f, -1.0f})*
+        Matrix4::scaling({2.0f, -1.0f, 1.0f})),
+        (Range3D{{-1.0f, -2.0f, -1.0f}, {3.0f, 0.0f, 2.0f}}));
+
+    /* Rotation by 90° around Z swaps X and Y, with Y flipped */
+    const Range3D rotated = MeshTools::boundingRange(mesh,
+        Matrix4::rotationZ(90.0_degf));
+    CORRADE_COMPARE(rotated.min(), (Vector3{-2.0f, -1.0f, 0.0f}));
+    CORRADE_COMPARE(rotated.max(), (Vector3{0.0f, 1.0f, 3.0f}));
+}
+
+void BoundingVolumeTest::rangeChunkedEmpty() {
+    Trade::ChunkedMeshData mesh{MeshPrimitive::Points, 0, 3, nullptr};
+    CORRADE_COMPARE(MeshTools::boundingRange(mesh, Matrix4::scaling(Vector3{2.0f})), Range3D{});
+}
+
+const Vector3 RangesPositions[]{
+    {1.0f, 2.0f, 3.0f},
+    {-1.0f, 0.5f, 7.0f},
+    {0.0f, 5.0f, -2.0f},
+    {3.0f, -4.0f, 0.0f},
+    {2.0f, 1.0f, 1.0f}
+};
+
+struct Subrange {
+    UnsignedInt offset;
+    UnsignedInt count;
+};
+
+void BoundingVolumeTest::ranges() {
+    /* Interleaved offsets and counts, similarly to what's in a Meshlet */
+    const Subrange subranges[]{
+        {0, 3},
+        {3, 2},
+        {1, 0}, /* Empty */
+        {4, 1}
+    };
+    const Containers::StridedArrayView1D<const UnsignedInt> offsets = Containers::stridedArrayView(subranges).slice(&Subrange::offset);
+    const Containers::StridedArrayView1D<const UnsignedInt> counts = Containers::stridedArrayView(subranges).slice(&Subrange::count);
+
+    Range3D out[4];
+    MeshTools::boundingRangesInto(RangesPositions, offsets, counts, out);
+    CORRADE_COMPARE(out[0], (Range3D{{-1.0f, 0.5f, -2.0f}, {1.0f, 5.0f, 7.0f}}));
+    CORRADE_COMPARE(out[1], (Range3D{{2.0f, -4.0f, 0.0f}, {3.0f, 1.0f, 1.0f}}));
+    CORRADE_COMPARE(out[2], Range3D{});
+    CORRADE_COMPARE(out[3], (Range3D{{2.0f, 1.0f, 1.0f}, {2.0f, 1.0f, 1.0f}}));
+
+    /* The allocating variant should give back the same */
+    Containers::Array<Range3D> allocated = MeshTools::boundingRanges(RangesPositions, offsets, counts);
+    CORRADE_COMPARE_AS(allocated, Containers::arrayView(out),
+        TestSuite::Compare::Container);
+}
+
+template<class T> void BoundingVolumeTest::rangesIndexed() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    const T indices[]{
+        4, 0, 4, 2, /* Vertex referenced twice */
+        3, 1
+    };
+    const UnsignedInt offsets[]{0, 4, 2};
+    const UnsignedInt counts[]{4, 2, 0};
+
+    Range3D out[3];
+    MeshTools::boundingRangesInto(Containers::stridedArrayView(indices), RangesPositions, offsets, counts, out);
+    CORRADE_COMPARE(out[0], (Range3D{{0.0f, 1.0f, -2.0f}, {2.0f, 5.0f, 3.0f}}));
+    CORRADE_COMPARE(out[1], (Range3D{{-1.0f, -4.0f, 0.0f}, {3.0f, 0.5f, 7.0f}}));
+    CORRADE_COMPARE(out[2], Range3D{});
+
+    /* The allocating variant should give back the same */
+    Containers::Array<Range3D> allocated = MeshTools::boundingRanges(Containers::stridedArrayView(indices), RangesPositions, offsets, counts);
+    CORRADE_COMPARE_AS(allocated, Containers::arrayView(out),
+        TestSuite::Compare::Container);
+}
+
+void BoundingVolumeTest::rangesIndexedNaN() {
+    /* Same behavior as with rangeNaN(), but here the code path is different
+       so it needs to be tested separately */
+    const Vector3 positions[]{
+        Vector3{Constants::nan()},
+        {1.0f, Constants::nan(), 1.0f},
+        Vector3{Constants::nan()},
+        {2.0f, Constants::nan(), 2.0f}
+    };
+    const UnsignedInt indices[]{0, 1, 2, 3, 0, 2};
+    const UnsignedInt offsets[]{0, 4};
+    const UnsignedInt counts[]{4, 2};
+
+    Containers::Array<Range3D> out = MeshTools::boundingRanges(Containers::stridedArrayView(indices), positions, offsets, counts);
+    CORRADE_COMPARE(out.size(), 2);
+
+    /* Y is all NaNs in the first sub-range, the rest is skipped */
+    CORRADE_COMPARE(out[0].min().xz(), (Vector2{1.0f, 1.0f}));
+    CORRADE_COMPARE(out[0].max().xz(), (Vector2{2.0f, 2.0f}));
+    CORRADE_VERIFY(Math::isNan(out[0].min().y()));
+    CORRADE_VERIFY(Math::isNan(out[0].max().y()));
+
+    /* Second sub-range is all NaNs */
+    CORRADE_VERIFY(Math::isNan(out[1].min()).all());
+    CORRADE_VERIFY(Math::isNan(out[1].max()).all());
+}
+
+void BoundingVolumeTest::rangesInvalidSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const UnsignedInt indices[3]{};
+    const UnsignedInt offsets[3]{};
+    const UnsignedInt counts[3]{};
+    Range3D ranges[3];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::boundingRangesInto(RangesPositions, Containers::arrayView(offsets).prefix(2), counts, ranges);
+    MeshTools::boundingRangesInto(RangesPositions, offsets, counts, Containers::arrayView(ranges).prefix(2));
+    MeshTools::boundingRangesInto(Containers::stridedArrayView(indices), RangesPositions, offsets, Containers::arrayView(counts).prefix(1), ranges);
+    MeshTools::boundingRanges(RangesPositions, offsets, Containers::arrayView(counts).prefix(2));
+    MeshTools::boundingRanges(Containers::stridedArrayView(indices), RangesPositions, Containers::arrayView(offsets).prefix(1), counts);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::boundingRangesInto(): expected offset, count and output views to have the same size but got 2, 3 and 3\n"
+        "MeshTools::boundingRangesInto(): expected offset, count and output views to have the same size but got 3, 3 and 2\n"
+        "MeshTools::boundingRangesInto(): expected offset, count and output views to have the same size but got 3, 1 and 3\n"
+        "MeshTools::boundingRanges(): expected offset and count views to have the same size but got 3 and 2\n"
+        "MeshTools::boundingRanges(): expected offset and count views to have the same size but got 1 and 3\n");
+}
+
+void BoundingVolumeTest::rangesOutOfBounds() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const UnsignedInt indices[]{0, 4, 5};
+    const UnsignedInt offsets[]{0, 3};
+    const UnsignedInt countsPositions[]{2, 3};
+    const UnsignedInt countsIndices[]{2, 2};
+    const UnsignedInt countsIndex[]{3, 0};
+    Range3D ranges[2];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::boundingRangesInto(RangesPositions, offsets, countsPositions, ranges);
+    MeshTools::boundingRangesInto(Containers::stridedArrayView(indices), RangesPositions, offsets, countsIndices, ranges);
+    MeshTools::boundingRangesInto(Containers::stridedArrayView(indices), RangesPositions, offsets, countsIndex, ranges);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::boundingRangesInto(): sub-range 1 of 3 items at offset 3 out of bounds for 5 elements\n"
+        "MeshTools::boundingRangesInto(): sub-range 1 of 2 items at offset 3 out of bounds for 3 indices\n"
+        "MeshTools::boundingRangesInto(): index 5 out of bounds for 5 elements\n");
+}
+
 void BoundingVolumeTest::sphereBouncingBubble() {
     /* Empty positions -- produces radius epsilon for consistency with all
        all identical positions */
@@ -245,6 +429,30 @@ void BoundingVolumeTest::benchmarkRange() {
     CORRADE_COMPARE_AS(r, 1.0f, TestSuite::Compare::Greater);
 }
 
+void BoundingVolumeTest::benchmarkRanges() {
+    Containers::Array<Vector3> points{NoInit, 500};
+    for(size_t i = 0; i < points.size(); ++i) {
+        points[i] = Vector3{Float(i)*0.01f};
+    }
+
+    /* 10 sub-ranges of 50 points each */
+    UnsignedInt offsets[10];
+    UnsignedInt counts[10];
+    for(UnsignedInt i = 0; i != 10; ++i) {
+        offsets[i] = i*50;
+        counts[i] = 50;
+    }
+
+    Range3D ranges[10];
+    Float r = 0.0f;
+    CORRADE_BENCHMARK(50) {
+        MeshTools::boundingRangesInto(points, offsets, counts, ranges);
+        r += ranges[9].size().x();
+    }
+
+    CORRADE_COMPARE_AS(r, 1.0f, TestSuite::Compare::Greater);
+}
+
 void BoundingVolumeTest::benchmarkSphereBouncingBubble() {
     Containers::Array<Vector3> points{NoInit, 500};
     for(size_t i = 0; i < points.size(); ++i) {
@@ -0,0 +1,594 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <sstream>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Frustum.h"
+#include "Magnum/Math/FunctionsBatch.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Math/Vector4.h"
+#include "Magnum/MeshTools/Bvh.h"
+#include "Magnum/Primitives/Grid.h"
+#include "Magnum/Primitives/Icosphere.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct BvhTest: TestSuite::Tester {
+    explicit BvhTest();
+
+    template<class T> void construct();
+    void constructMeshData();
+    void constructMeshDataNotIndexed();
+    template<class T> void constructErased();
+    void constructEmpty();
+    void constructLarge();
+    void constructThreadCountIndependent();
+    void constructMove();
+
+    void constructNotTriangles();
+    void constructNoPositions();
+    void constructWrongIndexCount();
+    void constructIndexOutOfBounds();
+    void constructErasedNonContiguous();
+    void constructErasedWrongIndexSize();
+
+    void castRay();
+    void castRayMiss();
+    void castRayMaxDistance();
+    void castRayEmpty();
+    void castRayBruteForce();
+
+    void querySphere();
+    void querySphereEmpty();
+
+    void queryFrustum();
+    void queryFrustumBruteForce();
+
+    void refit();
+    void refitWrongSize();
+
+    void benchmarkBuild();
+    void benchmarkCastRay();
+};
+
+BvhTest::BvhTest() {
+    addTests({&BvhTest::construct<UnsignedByte>,
+              &BvhTest::construct<UnsignedShort>,
+              &BvhTest::construct<UnsignedInt>,
+              &BvhTest::constructMeshData,
+              &BvhTest::constructMeshDataNotIndexed,
+              &BvhTest::constructErased<UnsignedByte>,
+              &BvhTest::constructErased<UnsignedShort>,
+              &BvhTest::constructErased<UnsignedInt>,
+              &BvhTest::constructEmpty,
+              &BvhTest::constructLarge,
+              &BvhTest::constructThreadCountIndependent,
+              &BvhTest::constructMove,
+
+              &BvhTest::constructNotTriangles,
+              &BvhTest::constructNoPositions,
+              &BvhTest::constructWrongIndexCount,
+              &BvhTest::constructIndexOutOfBounds,
+              &BvhTest::constructErasedNonContiguous,
+              &BvhTest::constructErasedWrongIndexSize,
+
+              &BvhTest::castRay,
+              &BvhTest::castRayMiss,
+              &BvhTest::castRayMaxDistance,
+              &BvhTest::castRayEmpty,
+              &BvhTest::castRayBruteForce,
+
+              &BvhTest::querySphere,
+              &BvhTest::querySphereEmpty,
+
+              &BvhTest::queryFrustum,
+              &BvhTest::queryFrustumBruteForce,
+
+              &BvhTest::refit,
+              &BvhTest::refitWrongSize});
+
+    addBenchmarks({&BvhTest::benchmarkBuild,
+                   &BvhTest::benchmarkCastRay}, 10);
+}
+
+/* Two triangles next to each other in the XY plane, and a third one further
+   along Z */
+constexpr Vector3 Positions[]{
+    {0.0f, 0.0f, 0.0f},
+    {1.0f, 0.0f, 0.0f},
+    {0.0f, 1.0f, 0.0f},
+    {1.0f, 1.0f, 0.0f},
+    {0.0f, 0.0f, -5.0f},
+    {1.0f, 0.0f, -5.0f},
+    {0.0f, 1.0f, -5.0f}
+};
+
+/* Verifies that each triangle is referenced by exactly one leaf and that all
+   nodes are contained in their parents */
+void verifyTree(const Bvh& bvh) {
+    Containers::Array<UnsignedInt> referenced{ValueInit, bvh.triangleCount()};
+    for(std::size_t i = 0; i != bvh.nodes().size(); ++i) {
+        const Bvh::Node& node = bvh.nodes()[i];
+        if(node.count) {
+            for(std::size_t j = node.offset; j != node.offset + node.count; ++j)
+                ++referenced[bvh.triangleIds()[j]];
+            continue;
+        }
+
+        CORRADE_VERIFY(node.offset > i);
+        CORRADE_VERIFY(node.offset + 1 < bvh.nodes().size());
+        for(const Bvh::Node& child: {bvh.nodes()[node.offset], bvh.nodes()[node.offset + 1]}) {
+            CORRADE_VERIFY(Math::min(child.bounds.min(), node.bounds.min()) == node.bounds.min());
+            CORRADE_VERIFY(Math::max(child.bounds.max(), node.bounds.max()) == node.bounds.max());
+        }
+    }
+    for(const UnsignedInt i: referenced) CORRADE_COMPARE(i, 1);
+}
+
+/* Plain Möller–Trumbore to compare against */
+Containers::Optional<Float> castRayBruteForce(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Vector3& origin, const Vector3& direction) {
+    Containers::Optional<Float> nearest;
+    for(std::size_t i = 0; i != indices.size()/3; ++i) {
+        const Vector3 a = positions[indices[i*3 + 0]];
+        const Vector3 ab = positions[indices[i*3 + 1]] - a;
+        const Vector3 ac = positions[indices[i*3 + 2]] - a;
+        const Vector3 p = Math::cross(direction, ac);
+        const Float determinant = Math::dot(ab, p);
+        if(determinant == 0.0f) continue;
+        const Vector3 t = origin - a;
+        const Float u = Math::dot(t, p)/determinant;
+        const Vector3 q = Math::cross(t, ab);
+        const Float v = Math::dot(direction, q)/determinant;
+        const Float distance = Math::dot(ac, q)/determinant;
+        if(u < 0.0f || v < 0.0f || u + v > 1.0f || distance < 0.0f) continue;
+        if(!nearest || distance < *nearest) nearest = distance;
+    }
+    return nearest;
+}
+
+template<class T> void BvhTest::construct() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    const T indices[]{0, 1, 2, 2, 1, 3, 4, 5, 6};
+    Bvh bvh{Containers::stridedArrayView(indices), Positions};
+    CORRADE_COMPARE(bvh.triangleCount(), 3);
+    CORRADE_COMPARE(bvh.vertexCount(), 7);
+    CORRADE_COMPARE(bvh.bounds(), (Range3D{{0.0f, 0.0f, -5.0f}, {1.0f, 1.0f, 0.0f}}));
+    CORRADE_VERIFY(!bvh.nodes().isEmpty());
+    CORRADE_COMPARE(bvh.nodes()[0].bounds, bvh.bounds());
+    CORRADE_COMPARE(bvh.triangleIds().size(), 3);
+    verifyTree(bvh);
+}
+
+void BvhTest::constructMeshData() {
+    Trade::MeshData mesh = Primitives::icosphereSolid(2);
+
+    Bvh bvh{mesh};
+    CORRADE_COMPARE(bvh.triangleCount(), mesh.indexCount()/3);
+    CORRADE_COMPARE(bvh.vertexCount(), mesh.vertexCount());
+    CORRADE_COMPARE(bvh.bounds(), Range3D{Math::minmax(mesh.positions3DAsArray())});
+    /* The mesh is large enough to not fit into a single leaf */
+    CORRADE_VERIFY(bvh.nodes().size() > 1);
+    verifyTree(bvh);
+}
+
+void BvhTest::constructMeshDataNotIndexed() {
+    Trade::MeshData mesh{MeshPrimitive::Triangles, {}, Positions, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::stridedArrayView(Positions).prefix(6)}
+    }};
+
+    Bvh bvh{mesh};
+    CORRADE_COMPARE(bvh.triangleCount(), 2);
+    CORRADE_COMPARE(bvh.vertexCount(), 6);
+    CORRADE_COMPARE(bvh.bounds(), (Range3D{{0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 0.0f}}));
+    verifyTree(bvh);
+}
+
+template<class T> void BvhTest::constructErased() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    const T indices[]{0, 1, 2, 2, 1, 3, 4, 5, 6};
+    Bvh bvh{Containers::arrayCast<2, const char>(Containers::stridedArrayView(indices)), Positions};
+    CORRADE_COMPARE(bvh.triangleCount(), 3);
+    CORRADE_COMPARE(bvh.bounds(), (Range3D{{0.0f, 0.0f, -5.0f}, {1.0f, 1.0f, 0.0f}}));
+    verifyTree(bvh);
+}
+
+void BvhTest::constructEmpty() {
+    Bvh bvh{Containers::StridedArrayView1D<const UnsignedInt>{}, Positions};
+    CORRADE_COMPARE(bvh.triangleCount(), 0);
+    CORRADE_COMPARE(bvh.vertexCount(), 7);
+    CORRADE_COMPARE(bvh.bounds(), Range3D{});
+    CORRADE_VERIFY(bvh.nodes().isEmpty());
+    CORRADE_VERIFY(bvh.triangleIds().isEmpty());
+}
+
+void BvhTest::constructLarge() {
+    /* Large enough to go through the parallel subtree build */
+    Trade::MeshData mesh = Primitives::grid3DSolid({200, 200}, {});
+
+    Bvh bvh{mesh};
+    CORRADE_COMPARE(bvh.triangleCount(), 200*200*2);
+    CORRADE_COMPARE(bvh.bounds(), (Range3D{{-1.0f, -1.0f, 0.0f}, {1.0f, 1.0f, 0.0f}}));
+    verifyTree(bvh);
+}
+
+void BvhTest::constructThreadCountIndependent() {
+    Trade::MeshData mesh = Primitives::icosphereSolid(6);
+
+    Bvh a{mesh, 1};
+    Bvh b{mesh, 4};
+    CORRADE_COMPARE(a.nodes().size(), b.nodes().size());
+    for(std::size_t i = 0; i != a.nodes().size(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(a.nodes()[i].bounds, b.nodes()[i].bounds);
+        CORRADE_COMPARE(a.nodes()[i].offset, b.nodes()[i].offset);
+        CORRADE_COMPARE(a.nodes()[i].count, b.nodes()[i].count);
+    }
+    CORRADE_COMPARE_AS(a.triangleIds(), b.triangleIds(),
+        TestSuite::Compare::Container);
+}
+
+void BvhTest::constructMove() {
+    const UnsignedInt indices[]{0, 1, 2, 2, 1, 3, 4, 5, 6};
+    Bvh a{indices, Positions};
+    const Bvh::Node* nodes = a.nodes().data();
+
+    Bvh b{std::move(a)};
+    CORRADE_COMPARE(b.nodes().data(), nodes);
+    CORRADE_COMPARE(b.triangleCount(), 3);
+
+    const UnsignedInt indices2[]{0, 1, 2};
+    Bvh c{indices2, Positions};
+    c = std::move(b);
+    CORRADE_COMPARE(c.nodes().data(), nodes);
+    CORRADE_COMPARE(c.triangleCount(), 3);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<Bvh>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<Bvh>::value);
+    CORRADE_VERIFY(!std::is_copy_constructible<Bvh>::value);
+    CORRADE_VERIFY(!std::is_copy_assignable<Bvh>::value);
+}
+
+void BvhTest::constructNotTriangles() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Trade::MeshData mesh{MeshPrimitive::TriangleStrip, {}, Positions, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::stridedArrayView(Positions)}
+    }};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Bvh{mesh};
+    CORRADE_COMPARE(out.str(), "MeshTools::Bvh: expected a MeshPrimitive::Triangles mesh but got MeshPrimitive::TriangleStrip\n");
+}
+
+void BvhTest::constructNoPositions() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Trade::MeshData mesh{MeshPrimitive::Triangles, 3};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Bvh{mesh};
+    CORRADE_COMPARE(out.str(), "MeshTools::Bvh: the mesh has no positions\n");
+}
+
+void BvhTest::constructWrongIndexCount() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const UnsignedInt indices[]{0, 1, 2, 3};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Bvh{indices, Positions};
+    CORRADE_COMPARE(out.str(), "MeshTools::Bvh: expected index count divisible by 3, got 4\n");
+}
+
+void BvhTest::constructIndexOutOfBounds() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const UnsignedInt indices[]{0, 1, 2, 3, 7, 4};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Bvh{indices, Positions};
+    CORRADE_COMPARE(out.str(), "MeshTools::Bvh: index 7 out of bounds for 7 vertices\n");
+}
+
+void BvhTest::constructErasedNonContiguous() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const char indices[6*4]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Bvh{Containers::StridedArrayView2D<const char>{indices, {6, 2}, {4, 2}}, Positions};
+    CORRADE_COMPARE(out.str(), "MeshTools::Bvh: second index view dimension is not contiguous\n");
+}
+
+void BvhTest::constructErasedWrongIndexSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const char indices[6*3]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Bvh{Containers::StridedArrayView2D<const char>{indices, {6, 3}}.every(2), Positions};
+    CORRADE_COMPARE(out.str(), "MeshTools::Bvh: expected index type size 1, 2 or 4 but got 3\n");
+}
+
+void BvhTest::castRay() {
+    const UnsignedInt indices[]{0, 1, 2, 2, 1, 3, 4, 5, 6};
+    Bvh bvh{indices, Positions};
+
+    /* Hits the second triangle first, the third is behind it */
+    Containers::Optional<Bvh::RayHit> hit = bvh.castRay({0.75f, 0.75f, 2.0f}, {0.0f, 0.0f, -0.5f});
+    CORRADE_VERIFY(hit);
+    CORRADE_COMPARE(hit->triangle, 1);
+    CORRADE_COMPARE(hit->distance, 4.0f);
+    /* The second triangle is {0, 1}, {1, 0}, {1, 1} */
+    CORRADE_COMPARE(hit->barycentric, (Vector2{0.25f, 0.5f}));
+
+    /* Hits the third triangle as the first two are outside of the ray */
+    hit = bvh.castRay({0.25f, 0.25f, -10.0f}, {0.0f, 0.0f, 1.0f});
+    CORRADE_VERIFY(hit);
+    CORRADE_COMPARE(hit->triangle, 2);
+    CORRADE_COMPARE(hit->distance, 5.0f);
+    CORRADE_COMPARE(hit->barycentric, (Vector2{0.25f, 0.25f}));
+}
+
+void BvhTest::castRayMiss() {
+    const UnsignedInt indices[]{0, 1, 2, 2, 1, 3, 4, 5, 6};
+    Bvh bvh{indices, Positions};
+
+    /* Next to the mesh */
+    CORRADE_VERIFY(!bvh.castRay({2.0f, 0.5f, 2.0f}, {0.0f, 0.0f, -1.0f}));
+    /* Pointing away from the mesh */
+    CORRADE_VERIFY(!bvh.castRay({0.25f, 0.25f, 2.0f}, {0.0f, 0.0f, 1.0f}));
+    /* Parallel to the triangles */
+    CORRADE_VERIFY(!bvh.castRay({-1.0f, 0.25f, 0.0f}, {1.0f, 0.0f, 0.0f}));
+}
+
+void BvhTest::castRayMaxDistance() {
+    const UnsignedInt indices[]{0, 1, 2, 2, 1, 3, 4, 5, 6};
+    Bvh bvh{indices, Positions};
+
+    /* The first triangle is too far away */
+    CORRADE_VERIFY(!bvh.castRay({0.25f, 0.25f, 2.0f}, {0.0f, 0.0f, -1.0f}, 1.5f));
+
+    /* The first triangle is in range, the third not */
+    Containers::Optional<Bvh::RayHit> hit = bvh.castRay({0.25f, 0.25f, 2.0f}, {0.0f, 0.0f, -1.0f}, 2.5f);
+    CORRADE_VERIFY(hit);
+    CORRADE_COMPARE(hit->triangle, 0);
+    CORRADE_COMPARE(hit->distance, 2.0f);
+}
+
+void BvhTest::castRayEmpty() {
+    Bvh bvh{Containers::StridedArrayView1D<const UnsignedInt>{}, Positions};
+    CORRADE_VERIFY(!bvh.castRay({0.25f, 0.25f, 2.0f}, {0.0f, 0.0f, -1.0f}));
+}
+
+void BvhTest::castRayBruteForce() {
+    Trade::MeshData mesh = Primitives::icosphereSolid(3);
+    const Containers::Array<UnsignedInt> indices = mesh.indicesAsArray();
+    const Containers::Array<Vector3> positions = mesh.positions3DAsArray();
+
+    Bvh bvh{mesh};
+    std::size_t hitCount = 0;
+    for(Int i = 0; i != 16; ++i) for(Int j = 0; j != 16; ++j) {
+        CORRADE_ITERATION(Vector2i{i, j});
+        /* Rays from a plane in front of the sphere, pointing in various
+           directions, some missing it */
+        const Vector3 origin{i*0.1f - 0.75f, j*0.1f - 0.75f, 3.0f};
+        const Vector3 direction{j*0.05f - 0.4f, i*0.05f - 0.4f, -1.0f};
+        const Containers::Optional<Float> expected = castRayBruteForce(indices, positions, origin, direction);
+        const Containers::Optional<Bvh::RayHit> hit = bvh.castRay(origin, direction);
+        CORRADE_COMPARE(!!hit, !!expected);
+        if(!hit) continue;
+
+        ++hitCount;
+        CORRADE_COMPARE(hit->distance, *expected);
+        /* The hit point is on the reported triangle */
+        const Vector3 a = positions[indices[hit->triangle*3 + 0]];
+        const Vector3 b = positions[indices[hit->triangle*3 + 1]];
+        const Vector3 c = positions[indices[hit->triangle*3 + 2]];
+        CORRADE_COMPARE(a + (b - a)*hit->barycentric.x() + (c - a)*hit->barycentric.y(), origin + direction*hit->distance);
+    }
+
+    /* Make sure the test isn't accidentally testing just misses */
+    CORRADE_COMPARE_AS(hitCount, 64, TestSuite::Compare::Greater);
+}
+
+void BvhTest::querySphere() {
+    const UnsignedInt indices[]{0, 1, 2, 2, 1, 3, 4, 5, 6};
+    Bvh bvh{indices, Positions};
+
+    /* Close to the middle of the edge shared by the first two triangles */
+    Containers::Array<UnsignedInt> out;
+    arrayAppend(out, 1337u);
+    CORRADE_COMPARE(bvh.querySphere({0.5f, 0.5f, 0.5f}, 0.6f, out), 2);
+    std::sort(out.begin() + 1, out.end());
+    CORRADE_COMPARE_AS(out, Containers::arrayView<UnsignedInt>({
+        1337, 0, 1
+    }), TestSuite::Compare::Container);
+
+    /* Near the corner of the second triangle, outside of the first one even
+       though it's inside its bounds */
+    arrayResize(out, 0);
+    CORRADE_COMPARE(bvh.querySphere({1.0f, 1.0f, 0.2f}, 0.3f, out), 1);
+    CORRADE_COMPARE_AS(out, Containers::arrayView<UnsignedInt>({
+        1
+    }), TestSuite::Compare::Container);
+
+    /* Inside the third triangle bounds but too far from its face */
+    arrayResize(out, 0);
+    CORRADE_COMPARE(bvh.querySphere({0.9f, 0.9f, -5.0f}, 0.3f, out), 0);
+
+    /* Everything */
+    CORRADE_COMPARE(bvh.querySphere({0.5f, 0.5f, -2.5f}, 5.0f, out), 3);
+}
+
+void BvhTest::querySphereEmpty() {
+    Bvh bvh{Containers::StridedArrayView1D<const UnsignedInt>{}, Positions};
+
+    Containers::Array<UnsignedInt> out;
+    CORRADE_COMPARE(bvh.querySphere({}, 100.0f, out), 0);
+    CORRADE_VERIFY(out.isEmpty());
+}
+
+void BvhTest::queryFrustum() {
+    const UnsignedInt indices[]{0, 1, 2, 2, 1, 3, 4, 5, 6};
+    Bvh bvh{indices, Positions};
+
+    /* A box around the first two triangles, with the third one behind the
+       far plane */
+    const Frustum frustum{
+        { 1.0f,  0.0f,  0.0f, 1.0f},
+        {-1.0f,  0.0f,  0.0f, 2.0f},
+        { 0.0f,  1.0f,  0.0f, 1.0f},
+        { 0.0f, -1.0f,  0.0f, 2.0f},
+        { 0.0f,  0.0f, -1.0f, 1.0f},
+        { 0.0f,  0.0f,  1.0f, 1.0f}};
+
+    Containers::Array<UnsignedInt> out;
+    CORRADE_COMPARE(bvh.queryFrustum(frustum, out), 2);
+    std::sort(out.begin(), out.end());
+    CORRADE_COMPARE_AS(out, Containers::arrayView<UnsignedInt>({
+        0, 1
+    }), TestSuite::Compare::Container);
+}
+
+void BvhTest::queryFrustumBruteForce() {
+    Trade::MeshData mesh = Primitives::icosphereSolid(4);
+    const Containers::Array<UnsignedInt> indices = mesh.indicesAsArray();
+    const Containers::Array<Vector3> positions = mesh.positions3DAsArray();
+
+    /* A box cutting a corner off the sphere */
+    const Frustum frustum{
+        { 1.0f,  0.0f,  0.0f, -0.3f},
+        {-1.0f,  0.0f,  0.0f,  2.0f},
+        { 0.0f,  1.0f,  0.0f, -0.2f},
+        { 0.0f, -1.0f,  0.0f,  2.0f},
+        { 0.0f,  0.0f,  1.0f,  0.1f},
+        { 0.0f,  0.0f, -1.0f,  2.0f}};
+
+    Containers::Array<UnsignedInt> expected;
+    for(UnsignedInt i = 0; i != indices.size()/3; ++i) {
+        bool outside = false;
+        for(const Vector4& plane: frustum) {
+            Int outsideCount = 0;
+            for(UnsignedInt j = 0; j != 3; ++j)
+                if(Math::dot(plane.xyz(), positions[indices[i*3 + j]]) + plane.w() < 0.0f) ++outsideCount;
+            if(outsideCount == 3) outside = true;
+        }
+        if(!outside) arrayAppend(expected, i);
+    }
+
+    Bvh bvh{mesh};
+    Containers::Array<UnsignedInt> out;
+    CORRADE_COMPARE(bvh.queryFrustum(frustum, out), expected.size());
+    std::sort(out.begin(), out.end());
+    CORRADE_COMPARE_AS(out, expected, TestSuite::Compare::Container);
+
+    /* Make sure the test isn't accidentally testing all or nothing */
+    CORRADE_COMPARE_AS(expected.size(), 0, TestSuite::Compare::Greater);
+    CORRADE_COMPARE_AS(expected.size(), indices.size()/6, TestSuite::Compare::Less);
+}
+
+void BvhTest::refit() {
+    Trade::MeshData mesh = Primitives::icosphereSolid(3);
+    Containers::Array<Vector3> positions = mesh.positions3DAsArray();
+
+    Bvh bvh{mesh};
+    const std::size_t nodeCount = bvh.nodes().size();
+    const Containers::Optional<Bvh::RayHit> hit = bvh.castRay({0.1f, 0.2f, 3.0f}, {0.0f, 0.0f, -1.0f});
+    CORRADE_VERIFY(hit);
+
+    /* Scale the sphere twice along Z and move it to the side */
+    for(Vector3& i: positions) i = i*Vector3{1.0f, 1.0f, 2.0f} + Vector3{5.0f, 0.0f, 0.0f};
+    bvh.refit(positions);
+    CORRADE_COMPARE(bvh.nodes().size(), nodeCount);
+    CORRADE_COMPARE(bvh.bounds(), Range3D{Math::minmax(positions)});
+    verifyTree(bvh);
+
+    /* The original location is empty now */
+    CORRADE_VERIFY(!bvh.castRay({0.1f, 0.2f, 3.0f}, {0.0f, 0.0f, -1.0f}));
+
+    /* The same triangle gets hit at the new location, the distance being
+       affected by the scale */
+    const Containers::Optional<Bvh::RayHit> refitHit = bvh.castRay({5.1f, 0.2f, 3.0f}, {0.0f, 0.0f, -1.0f});
+    CORRADE_VERIFY(refitHit);
+    CORRADE_COMPARE(refitHit->triangle, hit->triangle);
+    CORRADE_COMPARE(refitHit->barycentric, hit->barycentric);
+    CORRADE_COMPARE(3.0f - refitHit->distance, 2.0f*(3.0f - hit->distance));
+}
+
+void BvhTest::refitWrongSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const UnsignedInt indices[]{0, 1, 2};
+    Bvh bvh{indices, Positions};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    bvh.refit(Containers::arrayView(Positions).prefix(6));
+    CORRADE_COMPARE(out.str(), "MeshTools::Bvh::refit(): expected 7 positions but got 6\n");
+}
+
+void BvhTest::benchmarkBuild() {
+    Trade::MeshData mesh = Primitives::icosphereSolid(6);
+
+    std::size_t nodeCount = 0;
+    CORRADE_BENCHMARK(1)
+        nodeCount += Bvh{mesh}.nodes().size();
+
+    CORRADE_VERIFY(nodeCount);
+}
+
+void BvhTest::benchmarkCastRay() {
+    Bvh bvh{Primitives::icosphereSolid(6)};
+
+    UnsignedInt hitCount = 0;
+    CORRADE_BENCHMARK(10) for(Int i = 0; i != 100; ++i) {
+        if(bvh.castRay({i*0.01f - 0.5f, 0.3f, 3.0f}, {0.0f, 0.0f, -1.0f}))
+            ++hitCount;
+    }
+
+    CORRADE_COMPARE(hitCount, 10*100);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::BvhTest)
@@ -0,0 +1,247 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/TypeTraits.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/Codec.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct CodecTest: TestSuite::Tester {
+    explicit CodecTest();
+
+    void encodeIndices();
+    template<class T> void indicesRoundtrip();
+    void indicesEmpty();
+    void decodeIndicesInvalid();
+
+    void encodeVertices();
+    void verticesRoundtrip();
+    void verticesEmpty();
+    void decodeVerticesInvalid();
+};
+
+CodecTest::CodecTest() {
+    addTests({&CodecTest::encodeIndices,
+              &CodecTest::indicesRoundtrip<UnsignedByte>,
+              &CodecTest::indicesRoundtrip<UnsignedShort>,
+              &CodecTest::indicesRoundtrip<UnsignedInt>,
+              &CodecTest::indicesEmpty,
+              &CodecTest::decodeIndicesInvalid,
+
+              &CodecTest::encodeVertices,
+              &CodecTest::verticesRoundtrip,
+              &CodecTest::verticesEmpty,
+              &CodecTest::decodeVerticesInvalid});
+}
+
+/* Differences 0, 1, 1, 0, -1, 2, zigzagged to 0, 2, 2, 0, 1, 4 */
+const UnsignedShort Indices[]{0, 1, 2, 2, 1, 3};
+
+const char IndicesEncoded[]{
+    '\xe2',
+    /* Lower byte plane, one group with 4 bits per value */
+    '\x02', '\x20', '\x02', '\x41', '\x00', '\x00', '\x00', '\x00', '\x00',
+    /* Upper byte plane, all zeros */
+    '\x00'
+};
+
+/* Differences for the first byte 0x10, 1, -2, zigzagged to 0x20, 2, 3; for
+   the second byte 0, -1, 2, zigzagged to 0, 1, 4 */
+const UnsignedByte Vertices[][2]{
+    {0x10, 0x00},
+    {0x11, 0xff},
+    {0x0f, 0x01}
+};
+
+const char VerticesEncoded[]{
+    '\xa1',
+    /* First byte, stored raw */
+    '\x03', '\x20', '\x02', '\x03', '\x00', '\x00', '\x00', '\x00', '\x00',
+            '\x00', '\x00', '\x00', '\x00', '\x00', '\x00', '\x00', '\x00',
+    /* Second byte, 4 bits per value */
+    '\x02', '\x10', '\x04', '\x00', '\x00', '\x00', '\x00', '\x00', '\x00'
+};
+
+void CodecTest::encodeIndices() {
+    Containers::Array<char> out = MeshTools::encodeIndices(Indices);
+    CORRADE_COMPARE_AS(out,
+        Containers::arrayView(IndicesEncoded),
+        TestSuite::Compare::Container);
+
+    UnsignedShort decoded[6];
+    CORRADE_VERIFY(MeshTools::decodeIndicesInto(out, decoded));
+    CORRADE_COMPARE_AS(Containers::arrayView(decoded),
+        Containers::arrayView(Indices),
+        TestSuite::Compare::Container);
+}
+
+template<class T> void CodecTest::indicesRoundtrip() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    /* Multiple blocks with the last one being incomplete. Mostly small
+       differences with a large jump every now and then, which makes the
+       higher byte planes contain nonzero groups as well and the differences
+       wrap around. */
+    Containers::Array<T> indices{NoInit, 1000};
+    UnsignedInt seed = 1;
+    for(std::size_t i = 0; i != indices.size(); ++i) {
+        seed = seed*1103515245u + 12345u;
+        indices[i] = i % 97 == 0 ? T(seed >> 8) : T(i/3 + (seed >> 16) % 5);
+    }
+
+    Containers::Array<char> encoded = MeshTools::encodeIndices(indices);
+    /* The mostly small differences should make it at least a quarter smaller
+       even for 8-bit indices */
+    CORRADE_COMPARE_AS(encoded.size(), indices.size()*sizeof(T)*3/4,
+        TestSuite::Compare::Less);
+
+    /* Decode into a strided view to verify it's handled correctly */
+    Containers::Array<T> decoded{ValueInit, 2*indices.size()};
+    Containers::StridedArrayView1D<T> decodedView = Containers::stridedArrayView(decoded).every(2);
+    CORRADE_VERIFY(MeshTools::decodeIndicesInto(encoded, decodedView));
+    CORRADE_COMPARE_AS(decodedView,
+        Containers::stridedArrayView(indices),
+        TestSuite::Compare::Container);
+}
+
+void CodecTest::indicesEmpty() {
+    Containers::Array<char> out = MeshTools::encodeIndices(Containers::StridedArrayView1D<const UnsignedInt>{});
+    CORRADE_COMPARE_AS(out,
+        Containers::arrayView({'\xe4'}),
+        TestSuite::Compare::Container);
+
+    CORRADE_VERIFY(MeshTools::decodeIndicesInto(out, Containers::StridedArrayView1D<UnsignedInt>{}));
+}
+
+void CodecTest::decodeIndicesInvalid() {
+    UnsignedShort decodedShort[6];
+    UnsignedInt decodedInt[6];
+    char trailing[sizeof(IndicesEncoded) + 1]{};
+    Utility::copy(IndicesEncoded, Containers::arrayView(trailing).prefix(sizeof(IndicesEncoded)));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!MeshTools::decodeIndicesInto({}, decodedShort));
+    CORRADE_VERIFY(!MeshTools::decodeIndicesInto(IndicesEncoded, decodedInt));
+    CORRADE_VERIFY(!MeshTools::decodeIndicesInto(Containers::arrayView(IndicesEncoded).exceptSuffix(1), decodedShort));
+    CORRADE_VERIFY(!MeshTools::decodeIndicesInto(trailing, decodedShort));
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::decodeIndicesInto(): invalid header for 16-bit indices\n"
+        "MeshTools::decodeIndicesInto(): invalid header for 32-bit indices\n"
+        "MeshTools::decodeIndicesInto(): data too short for 6 indices\n"
+        "MeshTools::decodeIndicesInto(): expected 11 bytes for 6 indices but got 12\n");
+}
+
+void CodecTest::encodeVertices() {
+    Containers::Array<char> out = MeshTools::encodeVertices(Containers::arrayCast<2, const char>(Containers::arrayView(Vertices)));
+    CORRADE_COMPARE_AS(out,
+        Containers::arrayView(VerticesEncoded),
+        TestSuite::Compare::Container);
+
+    UnsignedByte decoded[3][2];
+    CORRADE_VERIFY(MeshTools::decodeVerticesInto(out, Containers::arrayCast<2, char>(Containers::arrayView(decoded))));
+    for(std::size_t i = 0; i != 3; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(decoded[i][0], Vertices[i][0]);
+        CORRADE_COMPARE(decoded[i][1], Vertices[i][1]);
+    }
+}
+
+void CodecTest::verticesRoundtrip() {
+    /* Quantized positions of a smooth surface and a constant normal,
+       spanning multiple blocks with the last one being incomplete */
+    struct Vertex {
+        Vector3s position;
+        Short padding;
+        Vector3s normal;
+    };
+    Containers::Array<Vertex> vertices{NoInit, 700};
+    for(std::size_t i = 0; i != vertices.size(); ++i) {
+        const Short x = Short(i % 32*512), y = Short(i/32*256);
+        vertices[i].position = {x, y, Short((x + y)/4)};
+        vertices[i].padding = 0;
+        vertices[i].normal = {0, 0, 32767};
+    }
+
+    /* Mostly small differences in the lower bytes, the upper bytes and the
+       normals are nearly constant */
+    const Containers::StridedArrayView2D<const char> bytes = Containers::arrayCast<2, const char>(Containers::stridedArrayView(vertices));
+    Containers::Array<char> encoded = MeshTools::encodeVertices(bytes);
+    CORRADE_COMPARE_AS(encoded.size(), bytes.size()[0]*bytes.size()[1]/3,
+        TestSuite::Compare::Less);
+
+    /* Decode into a view with a different stride */
+    Containers::Array<char> decoded{ValueInit, vertices.size()*32};
+    const Containers::StridedArrayView2D<char> decodedView{decoded, {vertices.size(), sizeof(Vertex)}, {32, 1}};
+    CORRADE_VERIFY(MeshTools::decodeVerticesInto(encoded, decodedView));
+    for(std::size_t i = 0; i != vertices.size(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE_AS(decodedView[i],
+            bytes[i],
+            TestSuite::Compare::Container);
+    }
+}
+
+void CodecTest::verticesEmpty() {
+    Containers::Array<char> out = MeshTools::encodeVertices(Containers::StridedArrayView2D<const char>{});
+    CORRADE_COMPARE_AS(out,
+        Containers::arrayView({'\xa1'}),
+        TestSuite::Compare::Container);
+
+    CORRADE_VERIFY(MeshTools::decodeVerticesInto(out, Containers::StridedArrayView2D<char>{}));
+}
+
+void CodecTest::decodeVerticesInvalid() {
+    char decoded[3*2];
+    const Containers::StridedArrayView2D<char> decodedView{decoded, {3, 2}};
+    char trailing[sizeof(VerticesEncoded) + 1]{};
+    Utility::copy(VerticesEncoded, Containers::arrayView(trailing).prefix(sizeof(VerticesEncoded)));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!MeshTools::decodeVerticesInto({}, decodedView));
+    CORRADE_VERIFY(!MeshTools::decodeVerticesInto(IndicesEncoded, decodedView));
+    CORRADE_VERIFY(!MeshTools::decodeVerticesInto(Containers::arrayView(VerticesEncoded).exceptSuffix(1), decodedView));
+    CORRADE_VERIFY(!MeshTools::decodeVerticesInto(trailing, decodedView));
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::decodeVerticesInto(): invalid header\n"
+        "MeshTools::decodeVerticesInto(): invalid header\n"
+        "MeshTools::decodeVerticesInto(): data too short for 3 vertices of 2 bytes\n"
+        "MeshTools::decodeVerticesInto(): expected 27 bytes for 3 vertices of 2 bytes but got 28\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::CodecTest)
@@ -39,6 +39,7 @@
 #include "Magnum/GL/Context.h"
 #include "Magnum/GL/Extensions.h"
 #include "Magnum/GL/Mesh.h"
+#include "Magnum/GL/MeshView.h"
 #include "Magnum/GL/OpenGLTester.h"
 #include "Magnum/GL/Framebuffer.h"
 #include "Magnum/GL/Renderbuffer.h"
@@ -77,7 +78,8 @@ enum class Flag {
     GeneratedSmoothNormals = 1 << 6,
     TextureCoordinates2D = 1 << 7,
     Colors = 1 << 8,
-    ObjectId = 1 << 9
+    ObjectId = 1 << 9,
+    MappedBuffers = 1 << 10
 };
 
 typedef Containers::EnumSet<Flag> Flags;
@@ -119,6 +121,10 @@ struct CompileGLTest: GL::OpenGLTester {
         void externalBuffers();
         void externalBuffersInvalid();
 
+        void batch();
+        void batchNonIndexed();
+        void batchInvalid();
+
     private:
         PluginManager::Manager<Trade::AbstractImporter> _manager{"nonexistent"};
 
@@ -194,6 +200,11 @@ const struct {
     {"positions, gen smooth normals + texcoords", Flag::GeneratedSmoothNormals|Flag::TextureCoordinates2D, {}},
     {"positions, gen smooth normals + texcoords + colors", Flag::GeneratedSmoothNormals|Flag::TextureCoordinates2D|Flag::Colors, {}},
     {"positions, nonindexed + gen smooth normals", Flag::NonIndexed|Flag::GeneratedSmoothNormals, {}},
+    {"positions + gen flat normals + texcoords + colors, mapped buffers", Flag::GeneratedFlatNormals|Flag::TextureCoordinates2D|Flag::Colors|Flag::MappedBuffers, {}},
+    {"positions + normals, gen flat normals, mapped buffers", Flag::Normals|Flag::GeneratedFlatNormals|Flag::MappedBuffers, {}},
+    {"positions, nonindexed + gen flat normals + colors, mapped buffers", Flag::NonIndexed|Flag::GeneratedFlatNormals|Flag::Colors|Flag::MappedBuffers, {}},
+    {"positions, gen smooth normals + texcoords + colors, mapped buffers", Flag::GeneratedSmoothNormals|Flag::TextureCoordinates2D|Flag::Colors|Flag::MappedBuffers, {}},
+    {"positions, nonindexed + gen smooth normals, mapped buffers", Flag::NonIndexed|Flag::GeneratedSmoothNormals|Flag::MappedBuffers, {}},
     {"positions, tangents, bitangents, normals", Flag::Tangents|Flag::Bitangents|Flag::Normals, {}},
     {"positions, tangents, bitangents from tangents, normals", Flag::Tangents|Flag::BitangentsFromTangents|Flag::Normals, {}},
     {"positions, object id, nonindexed", Flag::ObjectId|Flag::NonIndexed, {}}
@@ -285,7 +296,11 @@ CompileGLTest::CompileGLTest() {
         &CompileGLTest::renderSetup,
         &CompileGLTest::renderTeardown);
 
-    addTests({&CompileGLTest::externalBuffersInvalid});
+    addTests({&CompileGLTest::externalBuffersInvalid,
+
+              &CompileGLTest::batch,
+              &CompileGLTest::batchNonIndexed,
+              &CompileGLTest::batchInvalid});
 
     /* Load the plugins directly from the build tree. Otherwise they're either
        static and already loaded or not present in the build tree */
@@ -731,6 +746,8 @@ template<class T> void CompileGLTest::threeDimensions() {
         flags |= CompileFlag::GenerateFlatNormals;
     if(data.flags & Flag::GeneratedSmoothNormals)
         flags |= CompileFlag::GenerateSmoothNormals;
+    if(data.flags & Flag::MappedBuffers)
+        flags |= CompileFlag::MappedBuffers;
     #ifdef MAGNUM_BUILD_DEPRECATED
     CORRADE_IGNORE_DEPRECATED_PUSH /** @todo remove once MeshDataXD is gone */
     #endif
@@ -1413,6 +1430,89 @@ void CompileGLTest::externalBuffersInvalid() {
         "MeshTools::compile(): invalid external buffer(s)\n");
 }
 
+void CompileGLTest::batch() {
+    const Vector3 positions[13]{};
+    const UnsignedShort indices[]{0, 1, 2, 2, 1, 3};
+
+    /* Non-indexed mesh first to verify it gets a trivial index buffer */
+    Trade::MeshData a{MeshPrimitive::Triangles, {}, positions, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+            Containers::arrayView(positions).prefix(3)}
+    }};
+    Trade::MeshData b{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices},
+        {}, positions, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                Containers::arrayView(positions).prefix(4)}
+    }};
+    Trade::MeshData c{MeshPrimitive::Triangles, {}, positions, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+            Containers::arrayView(positions).prefix(6)}
+    }};
+
+    GL::Mesh mesh{NoCreate};
+    Containers::Array<GL::MeshView> views = compileBatch(mesh, {a, b, c});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_VERIFY(mesh.id());
+    CORRADE_VERIFY(mesh.isIndexed());
+    CORRADE_COMPARE(mesh.indexType(), MeshIndexType::UnsignedInt);
+    CORRADE_COMPARE(mesh.count(), 3 + 6 + 6);
+
+    CORRADE_COMPARE(views.size(), 3);
+    CORRADE_COMPARE(&views[0].mesh(), &mesh);
+    CORRADE_COMPARE(&views[2].mesh(), &mesh);
+    CORRADE_COMPARE(views[0].count(), 3);
+    CORRADE_COMPARE(views[1].count(), 6);
+    CORRADE_COMPARE(views[2].count(), 6);
+    /* Indices are absolute, no base vertex needed */
+    CORRADE_COMPARE(views[0].baseVertex(), 0);
+    CORRADE_COMPARE(views[1].baseVertex(), 0);
+    CORRADE_COMPARE(views[2].baseVertex(), 0);
+}
+
+void CompileGLTest::batchNonIndexed() {
+    const Vector3 positions[9]{};
+
+    Trade::MeshData a{MeshPrimitive::Lines, {}, positions, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+            Containers::arrayView(positions).prefix(4)}
+    }};
+    Trade::MeshData b{MeshPrimitive::Lines, {}, positions, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+            Containers::arrayView(positions).prefix(2)}
+    }};
+
+    GL::Mesh mesh{NoCreate};
+    Containers::Array<GL::MeshView> views = compileBatch(mesh, {a, b});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_VERIFY(!mesh.isIndexed());
+    CORRADE_COMPARE(mesh.primitive(), GL::MeshPrimitive::Lines);
+    CORRADE_COMPARE(mesh.count(), 6);
+
+    CORRADE_COMPARE(views.size(), 2);
+    CORRADE_COMPARE(views[0].count(), 4);
+    CORRADE_COMPARE(views[0].baseVertex(), 0);
+    CORRADE_COMPARE(views[1].count(), 2);
+    CORRADE_COMPARE(views[1].baseVertex(), 4);
+}
+
+void CompileGLTest::batchInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Trade::MeshData data{MeshPrimitive::Triangles, 3};
+    GL::Mesh mesh{NoCreate};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    compileBatch(mesh, Containers::ArrayView<const Containers::Reference<const Trade::MeshData>>{});
+    compileBatch(mesh, {data}, CompileFlag::GenerateSmoothNormals);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::compileBatch(): no meshes passed\n"
+        "MeshTools::compileBatch(): normal generation is not supported\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::CompileGLTest)
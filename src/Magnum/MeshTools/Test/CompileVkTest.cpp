@@ -0,0 +1,233 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <sstream>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/CompileVk.h"
+#include "Magnum/Trade/MeshData.h"
+#include "Magnum/Vk/DeviceProperties.h"
+#include "Magnum/Vk/MemoryAllocator.h"
+#include "Magnum/Vk/Mesh.h"
+#include "Magnum/Vk/MeshLayout.h"
+#include "Magnum/Vk/UploadBatcher.h"
+#include "Magnum/Vk/VertexFormat.h"
+#include "Magnum/Vk/VulkanTester.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct CompileVkTest: Vk::VulkanTester {
+    explicit CompileVkTest();
+
+    void interleaved();
+    void nonInterleaved();
+    void indexed();
+    void dedicatedMemory();
+
+    void unknownAttribute();
+    void empty();
+};
+
+CompileVkTest::CompileVkTest() {
+    addTests({&CompileVkTest::interleaved,
+              &CompileVkTest::nonInterleaved,
+              &CompileVkTest::indexed,
+              &CompileVkTest::dedicatedMemory,
+
+              &CompileVkTest::unknownAttribute,
+              &CompileVkTest::empty});
+}
+
+struct Vertex {
+    Vector3 position;
+    Vector2 textureCoordinates;
+    Vector3 normal;
+};
+
+const Vertex Vertices[]{
+    {{-1.0f, -1.0f, 0.0f}, {0.0f, 0.0f}, {0.0f, 0.0f, 1.0f}},
+    {{ 1.0f, -1.0f, 0.0f}, {1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}},
+    {{ 0.0f,  1.0f, 0.0f}, {0.5f, 1.0f}, {0.0f, 0.0f, 1.0f}}
+};
+
+void CompileVkTest::interleaved() {
+    Containers::StridedArrayView1D<const Vertex> vertices = Vertices;
+    Trade::MeshData data{MeshPrimitive::Triangles, {}, Vertices, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+            vertices.slice(&Vertex::position)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::TextureCoordinates,
+            vertices.slice(&Vertex::textureCoordinates)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Normal,
+            vertices.slice(&Vertex::normal)}
+    }};
+
+    Vk::MemoryAllocator allocator{device()};
+    Vk::UploadBatcher batcher{device(), queue(), device().properties().pickQueueFamily(Vk::QueueFlag::Graphics), 1024};
+    Vk::Mesh mesh = compileVk(data, device(), allocator, batcher);
+    batcher.finish();
+
+    CORRADE_COMPARE(mesh.count(), 3);
+    CORRADE_VERIFY(!mesh.isIndexed());
+    CORRADE_COMPARE(mesh.layout(), Vk::MeshLayout{MeshPrimitive::Triangles}
+        .addBinding(0, sizeof(Vertex))
+        .addAttribute(0, 0, VertexFormat::Vector3, 0)
+        .addAttribute(1, 0, VertexFormat::Vector2, 12)
+        .addAttribute(5, 0, VertexFormat::Vector3, 20));
+
+    /* A single binding referencing the start of the buffer */
+    CORRADE_COMPARE(mesh.vertexBuffers().size(), 1);
+    CORRADE_VERIFY(mesh.vertexBuffers()[0]);
+    CORRADE_COMPARE(mesh.vertexBufferOffsets()[0], 0);
+    CORRADE_COMPARE(mesh.vertexBufferStrides()[0], sizeof(Vertex));
+}
+
+void CompileVkTest::nonInterleaved() {
+    const Vector3 positions[]{
+        {-1.0f, -1.0f, 0.0f},
+        { 1.0f, -1.0f, 0.0f},
+        { 0.0f,  1.0f, 0.0f},
+        { 0.0f,  0.0f, 0.0f}
+    };
+    const Vector2 textureCoordinates[]{
+        {0.0f, 0.0f},
+        {1.0f, 0.0f},
+        {0.5f, 1.0f},
+        {0.5f, 0.5f}
+    };
+    char vertexData[sizeof(positions) + sizeof(textureCoordinates)];
+    std::memcpy(vertexData, positions, sizeof(positions));
+    std::memcpy(vertexData + sizeof(positions), textureCoordinates, sizeof(textureCoordinates));
+
+    Trade::MeshData data{MeshPrimitive::Triangles, {}, vertexData, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+            VertexFormat::Vector3, 0, 4, sizeof(Vector3)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::TextureCoordinates,
+            VertexFormat::Vector2, sizeof(positions), 4, sizeof(Vector2)}
+    }, 4};
+
+    Vk::MemoryAllocator allocator{device()};
+    Vk::UploadBatcher batcher{device(), queue(), device().properties().pickQueueFamily(Vk::QueueFlag::Graphics), 1024};
+    Vk::Mesh mesh = compileVk(data, device(), allocator, batcher);
+    batcher.finish();
+
+    CORRADE_COMPARE(mesh.count(), 4);
+    CORRADE_COMPARE(mesh.layout(), Vk::MeshLayout{MeshPrimitive::Triangles}
+        .addBinding(0, sizeof(Vector3))
+        .addBinding(1, sizeof(Vector2))
+        .addAttribute(0, 0, VertexFormat::Vector3, 0)
+        .addAttribute(1, 1, VertexFormat::Vector2, 0));
+
+    /* Two bindings, both in the same buffer */
+    CORRADE_COMPARE(mesh.vertexBuffers().size(), 2);
+    CORRADE_COMPARE(mesh.vertexBuffers()[0], mesh.vertexBuffers()[1]);
+    CORRADE_COMPARE(mesh.vertexBufferOffsets()[0], 0);
+    CORRADE_COMPARE(mesh.vertexBufferOffsets()[1], sizeof(positions));
+}
+
+void CompileVkTest::indexed() {
+    const UnsignedShort indices[]{0, 1, 2, 2, 1, 0};
+    Containers::StridedArrayView1D<const Vertex> vertices = Vertices;
+    Trade::MeshData data{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices},
+        {}, Vertices, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                vertices.slice(&Vertex::position)}
+        }};
+
+    Vk::MemoryAllocator allocator{device()};
+    Vk::UploadBatcher batcher{device(), queue(), device().properties().pickQueueFamily(Vk::QueueFlag::Graphics), 1024};
+    Vk::Mesh mesh = compileVk(data, device(), allocator, batcher);
+    batcher.finish();
+
+    CORRADE_COMPARE(mesh.count(), 6);
+    CORRADE_VERIFY(mesh.isIndexed());
+    CORRADE_COMPARE(mesh.indexType(), MeshIndexType::UnsignedShort);
+
+    /* Index data are placed after the vertex data in the same buffer,
+       aligned to four bytes */
+    CORRADE_COMPARE(mesh.vertexBuffers().size(), 1);
+    CORRADE_COMPARE(mesh.indexBuffer(), mesh.vertexBuffers()[0]);
+    CORRADE_COMPARE(mesh.indexBufferOffset(), sizeof(Vertices));
+}
+
+void CompileVkTest::dedicatedMemory() {
+    Containers::StridedArrayView1D<const Vertex> vertices = Vertices;
+    Trade::MeshData data{MeshPrimitive::Triangles, {}, Vertices, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+            vertices.slice(&Vertex::position)}
+    }};
+
+    Vk::UploadBatcher batcher{device(), queue(), device().properties().pickQueueFamily(Vk::QueueFlag::Graphics), 1024};
+    Vk::Mesh mesh = compileVk(data, device(), batcher);
+    batcher.finish();
+
+    CORRADE_COMPARE(mesh.count(), 3);
+    CORRADE_COMPARE(mesh.vertexBuffers().size(), 1);
+    CORRADE_VERIFY(mesh.vertexBuffers()[0]);
+}
+
+void CompileVkTest::unknownAttribute() {
+    Containers::StridedArrayView1D<const Vertex> vertices = Vertices;
+    Trade::MeshData data{MeshPrimitive::Triangles, {}, Vertices, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+            vertices.slice(&Vertex::position)},
+        Trade::MeshAttributeData{Trade::meshAttributeCustom(115),
+            vertices.slice(&Vertex::normal)}
+    }};
+
+    Vk::UploadBatcher batcher{device(), queue(), device().properties().pickQueueFamily(Vk::QueueFlag::Graphics), 1024};
+
+    std::ostringstream out;
+    Warning redirectWarning{&out};
+    Vk::Mesh mesh = compileVk(data, device(), batcher);
+    batcher.finish();
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::compileVk(): ignoring unknown/unsupported attribute Trade::MeshAttribute::Custom(115)\n");
+
+    CORRADE_COMPARE(mesh.layout(), Vk::MeshLayout{MeshPrimitive::Triangles}
+        .addBinding(0, sizeof(Vertex))
+        .addAttribute(0, 0, VertexFormat::Vector3, 0));
+}
+
+void CompileVkTest::empty() {
+    Trade::MeshData data{MeshPrimitive::Points, 0};
+
+    Vk::UploadBatcher batcher{device(), queue(), device().properties().pickQueueFamily(Vk::QueueFlag::Graphics), 1024};
+    Vk::Mesh mesh = compileVk(data, device(), batcher);
+
+    /* Nothing got uploaded */
+    CORRADE_COMPARE(batcher.flush(), 0);
+    CORRADE_COMPARE(mesh.count(), 0);
+    CORRADE_COMPARE(mesh.vertexBuffers().size(), 0);
+    CORRADE_VERIFY(!mesh.isIndexed());
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::CompileVkTest)
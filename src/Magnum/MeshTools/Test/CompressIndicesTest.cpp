@@ -26,6 +26,7 @@
 #include <sstream>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/Triple.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/Utility/DebugStl.h>
@@ -53,6 +54,15 @@ struct CompressIndicesTest: TestSuite::Tester {
     /* No compressErased(), as that's tested in the templates above */
     void compressErasedNonContiguous();
     void compressErasedWrongIndexSize();
+    template<class T> void compressLarge();
+    void compressLargeOffsetAboveMin();
+
+    template<class T> void compressRebased();
+    void compressRebasedEmpty();
+    void compressRebasedErasedNonContiguous();
+    void compressRebasedErasedWrongIndexSize();
+    void compressRebasedImplementationSpecificAtLeastIndexType();
+
     #ifdef MAGNUM_BUILD_DEPRECATED
     void compressDeprecated();
     #endif
@@ -68,6 +78,19 @@ struct CompressIndicesTest: TestSuite::Tester {
     #endif
 };
 
+const struct {
+    const char* name;
+    std::size_t count;
+    bool strided;
+} LargeData[]{
+    /* Smaller than a single SIMD register */
+    {"few", 7, false},
+    {"one block with a remainder", 65536 + 13, false},
+    /* More than the minimal block count for going multithreaded */
+    {"many blocks", 6*65536 + 5, false},
+    {"many blocks, strided", 6*65536 + 5, true},
+};
+
 CompressIndicesTest::CompressIndicesTest() {
     addTests({&CompressIndicesTest::compressUnsignedByte<UnsignedByte>,
               &CompressIndicesTest::compressUnsignedByte<UnsignedShort>,
@@ -81,7 +104,24 @@ CompressIndicesTest::CompressIndicesTest() {
               &CompressIndicesTest::compressOffsetNegative<UnsignedShort>,
               &CompressIndicesTest::compressOffsetNegative<UnsignedInt>,
               &CompressIndicesTest::compressErasedNonContiguous,
-              &CompressIndicesTest::compressErasedWrongIndexSize,
+              &CompressIndicesTest::compressErasedWrongIndexSize});
+
+    addInstancedTests<CompressIndicesTest>({
+        &CompressIndicesTest::compressLarge<UnsignedByte>,
+        &CompressIndicesTest::compressLarge<UnsignedShort>,
+        &CompressIndicesTest::compressLarge<UnsignedInt>},
+        Containers::arraySize(LargeData));
+
+    addTests({&CompressIndicesTest::compressLargeOffsetAboveMin,
+
+              &CompressIndicesTest::compressRebased<UnsignedByte>,
+              &CompressIndicesTest::compressRebased<UnsignedShort>,
+              &CompressIndicesTest::compressRebased<UnsignedInt>,
+              &CompressIndicesTest::compressRebasedEmpty,
+              &CompressIndicesTest::compressRebasedErasedNonContiguous,
+              &CompressIndicesTest::compressRebasedErasedWrongIndexSize,
+              &CompressIndicesTest::compressRebasedImplementationSpecificAtLeastIndexType,
+
               #ifdef MAGNUM_BUILD_DEPRECATED
               &CompressIndicesTest::compressDeprecated,
               #endif
@@ -235,6 +275,126 @@ void CompressIndicesTest::compressErasedWrongIndexSize() {
         "MeshTools::compressIndices(): expected index type size 1, 2 or 4 but got 3\n");
 }
 
+template<class T> void CompressIndicesTest::compressLarge() {
+    auto&& data = LargeData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    /* Indices in range [base - 1, base + 250] with the extremes at places
+       that aren't handled by the SIMD loops for small sizes */
+    const T base = sizeof(T) == 1 ? 3 : 1000;
+    Containers::Array<T> indexData{data.count*(data.strided ? 2 : 1)};
+    Containers::StridedArrayView1D<T> indices = Containers::stridedArrayView(indexData).every(data.strided ? 2 : 1);
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        indices[i] = T(base + (i*7919) % 200);
+    indices[indices.size() - 1] = base - 1;
+    indices[indices.size()/2] = base + 250;
+
+    /* Rebasing makes it fit into 8 bits */
+    Containers::Triple<Containers::Array<char>, MeshIndexType, UnsignedInt> rebased = compressIndicesRebased(Containers::StridedArrayView1D<const T>{indices}, MeshIndexType::UnsignedByte);
+    CORRADE_COMPARE(rebased.second(), MeshIndexType::UnsignedByte);
+    CORRADE_COMPARE(rebased.third(), UnsignedInt(base - 1));
+    Containers::Array<UnsignedByte> expectedRebased{indices.size()};
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        expectedRebased[i] = UnsignedByte(indices[i] - base + 1);
+    CORRADE_COMPARE_AS(Containers::arrayCast<UnsignedByte>(rebased.first()),
+        expectedRebased,
+        TestSuite::Compare::Container);
+
+    /* Without an offset it's converted to a 16-bit type */
+    std::pair<Containers::Array<char>, MeshIndexType> out = compressIndices(Containers::StridedArrayView1D<const T>{indices});
+    CORRADE_COMPARE(out.second, MeshIndexType::UnsignedShort);
+    Containers::Array<UnsignedShort> expected{indices.size()};
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        expected[i] = indices[i];
+    CORRADE_COMPARE_AS(Containers::arrayCast<UnsignedShort>(out.first),
+        expected,
+        TestSuite::Compare::Container);
+}
+
+void CompressIndicesTest::compressLargeOffsetAboveMin() {
+    /* The offset is larger than the smallest index, which means the values
+       wrap around. The SIMD variants saturate instead, so they shouldn't get
+       used in this case. */
+    Containers::Array<UnsignedInt> indices{6*65536 + 5};
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        indices[i] = 100 + (i*7919) % 200;
+
+    std::pair<Containers::Array<char>, MeshIndexType> out = compressIndices(Containers::stridedArrayView(indices), MeshIndexType::UnsignedByte, 200);
+    CORRADE_COMPARE(out.second, MeshIndexType::UnsignedByte);
+    Containers::Array<UnsignedByte> expected{indices.size()};
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        expected[i] = UnsignedByte(indices[i] - 200);
+    CORRADE_COMPARE_AS(Containers::arrayCast<UnsignedByte>(out.first),
+        expected,
+        TestSuite::Compare::Container);
+}
+
+template<class T> void CompressIndicesTest::compressRebased() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    const T indices[]{100 + 1, 100 + 100, 100 + 0, 100 + 5};
+    Containers::Triple<Containers::Array<char>, MeshIndexType, UnsignedInt> out = compressIndicesRebased(indices, MeshIndexType::UnsignedByte);
+
+    CORRADE_COMPARE(out.second(), MeshIndexType::UnsignedByte);
+    CORRADE_COMPARE(out.third(), 100);
+    CORRADE_COMPARE_AS(Containers::arrayCast<UnsignedByte>(out.first()),
+        Containers::arrayView<UnsignedByte>({1, 100, 0, 5}),
+        TestSuite::Compare::Container);
+
+    /* Test the type-erased variant as well, with the default atLeast */
+    out = compressIndicesRebased(Containers::arrayCast<2, const char>(Containers::stridedArrayView(indices)));
+
+    CORRADE_COMPARE(out.second(), MeshIndexType::UnsignedShort);
+    CORRADE_COMPARE(out.third(), 100);
+    CORRADE_COMPARE_AS(Containers::arrayCast<UnsignedShort>(out.first()),
+        Containers::arrayView<UnsignedShort>({1, 100, 0, 5}),
+        TestSuite::Compare::Container);
+}
+
+void CompressIndicesTest::compressRebasedEmpty() {
+    Containers::Triple<Containers::Array<char>, MeshIndexType, UnsignedInt> out = compressIndicesRebased(Containers::StridedArrayView1D<const UnsignedInt>{});
+    CORRADE_COMPARE(out.first().size(), 0);
+    CORRADE_COMPARE(out.second(), MeshIndexType::UnsignedShort);
+    CORRADE_COMPARE(out.third(), 0);
+}
+
+void CompressIndicesTest::compressRebasedErasedNonContiguous() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const char indices[6*4]{};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    compressIndicesRebased(Containers::StridedArrayView2D<const char>{indices, {6, 2}, {4, 2}});
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::compressIndicesRebased(): second view dimension is not contiguous\n");
+}
+
+void CompressIndicesTest::compressRebasedErasedWrongIndexSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const char indices[6*3]{};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    compressIndicesRebased(Containers::StridedArrayView2D<const char>{indices, {6, 3}});
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::compressIndicesRebased(): expected index type size 1, 2 or 4 but got 3\n");
+}
+
+void CompressIndicesTest::compressRebasedImplementationSpecificAtLeastIndexType() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const UnsignedInt indices[]{1, 2, 3};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    compressIndicesRebased(indices, meshIndexTypeWrap(0xcaca));
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::compressIndicesRebased(): can't compress to an implementation-specific index type 0xcaca\n");
+}
+
 #ifdef MAGNUM_BUILD_DEPRECATED
 void CompressIndicesTest::compressDeprecated() {
     Containers::Array<char> data;
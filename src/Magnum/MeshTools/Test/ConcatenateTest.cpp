@@ -54,6 +54,15 @@ struct ConcatenateTest: TestSuite::Tester {
     void concatenateImplementationSpecificIndexType();
     void concatenateImplementationSpecificVertexFormat();
     void concatenateIntoNoMeshes();
+
+    void concatenator();
+    void concatenatorNotIndexed();
+    void concatenatorNoAttributes();
+    void concatenatorReserve();
+    void concatenatorUnsupportedPrimitive();
+    void concatenatorImplementationSpecificVertexFormat();
+    void concatenatorInconsistentPrimitive();
+    void concatenatorAlreadyFinalized();
 };
 
 const struct {
@@ -84,7 +93,16 @@ ConcatenateTest::ConcatenateTest() {
               &ConcatenateTest::concatenateInconsistentAttributeArraySize,
               &ConcatenateTest::concatenateImplementationSpecificIndexType,
               &ConcatenateTest::concatenateImplementationSpecificVertexFormat,
-              &ConcatenateTest::concatenateIntoNoMeshes});
+              &ConcatenateTest::concatenateIntoNoMeshes,
+
+              &ConcatenateTest::concatenator,
+              &ConcatenateTest::concatenatorNotIndexed,
+              &ConcatenateTest::concatenatorNoAttributes,
+              &ConcatenateTest::concatenatorReserve,
+              &ConcatenateTest::concatenatorUnsupportedPrimitive,
+              &ConcatenateTest::concatenatorImplementationSpecificVertexFormat,
+              &ConcatenateTest::concatenatorInconsistentPrimitive,
+              &ConcatenateTest::concatenatorAlreadyFinalized});
 }
 
 /* MSVC 2015 doesn't like unnamed bitfields in local structs, so this has to
@@ -733,6 +751,249 @@ void ConcatenateTest::concatenateIntoNoMeshes() {
     CORRADE_COMPARE(out.str(), "MeshTools::concatenateInto(): no meshes passed\n");
 }
 
+void ConcatenateTest::concatenator() {
+    /* First is non-indexed with a position and a texture coordinate */
+    const struct VertexDataA {
+        Vector3 position;
+        Vector2 textureCoordinates;
+    } vertexDataA[]{
+        {{1.0f, 2.0f, 3.0f}, {0.1f, 0.2f}},
+        {{4.0f, 5.0f, 6.0f}, {0.3f, 0.4f}}
+    };
+    Trade::MeshData a{MeshPrimitive::Lines, {}, vertexDataA, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+            Containers::stridedArrayView(vertexDataA,
+                &vertexDataA[0].position, 2, sizeof(VertexDataA))},
+        Trade::MeshAttributeData{Trade::MeshAttribute::TextureCoordinates,
+            Containers::stridedArrayView(vertexDataA,
+                &vertexDataA[0].textureCoordinates, 2, sizeof(VertexDataA))}
+    }};
+
+    /* Second is indexed, with just a position. The texture coordinates will
+       be zero-filled and a trivial index buffer generated for the first. */
+    const Vector3 positionsB[]{
+        {1.5f, 2.5f, 3.5f},
+        {4.5f, 5.5f, 6.5f},
+        {7.5f, 8.5f, 9.5f}
+    };
+    const UnsignedByte indicesB[]{2, 0, 1, 2};
+    Trade::MeshData b{MeshPrimitive::Lines,
+        {}, indicesB, Trade::MeshIndexData{indicesB}, {}, positionsB, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                Containers::arrayView(positionsB)}
+        }};
+
+    MeshTools::Concatenator<> concatenator{a};
+    CORRADE_COMPARE(concatenator.primitive(), MeshPrimitive::Lines);
+    CORRADE_COMPARE(concatenator.meshCount(), 0);
+    concatenator
+        .append(a)
+        .append(b)
+        .append(a);
+    CORRADE_COMPARE(concatenator.meshCount(), 3);
+    CORRADE_COMPARE(concatenator.indexCount(), 8);
+    CORRADE_COMPARE(concatenator.vertexCount(), 7);
+    CORRADE_COMPARE_AS(concatenator.indexOffsets(),
+        Containers::arrayView<UnsignedInt>({0, 2, 6}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(concatenator.vertexOffsets(),
+        Containers::arrayView<UnsignedInt>({0, 2, 5}),
+        TestSuite::Compare::Container);
+
+    Trade::MeshData dst = concatenator.finalize();
+    CORRADE_COMPARE(dst.primitive(), MeshPrimitive::Lines);
+    CORRADE_COMPARE(dst.attributeCount(), 2);
+    CORRADE_COMPARE_AS(dst.attribute<Vector3>(Trade::MeshAttribute::Position),
+        Containers::arrayView<Vector3>({
+            {1.0f, 2.0f, 3.0f},
+            {4.0f, 5.0f, 6.0f},
+            {1.5f, 2.5f, 3.5f},
+            {4.5f, 5.5f, 6.5f},
+            {7.5f, 8.5f, 9.5f},
+            {1.0f, 2.0f, 3.0f},
+            {4.0f, 5.0f, 6.0f}
+        }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(dst.attribute<Vector2>(Trade::MeshAttribute::TextureCoordinates),
+        Containers::arrayView<Vector2>({
+            {0.1f, 0.2f},
+            {0.3f, 0.4f},
+            {}, {}, {}, /* Missing in the second mesh */
+            {0.1f, 0.2f},
+            {0.3f, 0.4f}
+        }), TestSuite::Compare::Container);
+    CORRADE_VERIFY(dst.isIndexed());
+    CORRADE_COMPARE(dst.indexType(), MeshIndexType::UnsignedInt);
+    CORRADE_COMPARE_AS(dst.indices<UnsignedInt>(),
+        Containers::arrayView<UnsignedInt>({
+            0, 1,       /* generated for the first non-indexed mesh */
+            4, 2, 3, 4, /* offset for the second indexed mesh */
+            5, 6        /* implicit + offset for the third mesh */
+        }), TestSuite::Compare::Container);
+
+    /* The layout from the first mesh is preserved */
+    CORRADE_VERIFY(isInterleaved(dst));
+    CORRADE_COMPARE(dst.attributeStride(0), sizeof(VertexDataA));
+    CORRADE_COMPARE(dst.indexDataFlags(), Trade::DataFlag::Owned|Trade::DataFlag::Mutable);
+    CORRADE_COMPARE(dst.vertexDataFlags(), Trade::DataFlag::Owned|Trade::DataFlag::Mutable);
+
+    /* The output should be the same as with concatenate() */
+    Trade::MeshData expected = MeshTools::concatenate({a, b, a});
+    CORRADE_COMPARE_AS(dst.indices<UnsignedInt>(),
+        expected.indices<UnsignedInt>(),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(dst.vertexData(),
+        expected.vertexData(),
+        TestSuite::Compare::Container);
+
+    /* Offsets are still available after finalizing */
+    CORRADE_COMPARE(concatenator.vertexOffsets().size(), 3);
+}
+
+void ConcatenateTest::concatenatorNotIndexed() {
+    const Vector3 positions[]{
+        {1.0f, 2.0f, 3.0f},
+        {4.0f, 5.0f, 6.0f}
+    };
+    Trade::MeshData a{MeshPrimitive::Points, {}, positions, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+            Containers::arrayView(positions)}
+    }};
+
+    MeshTools::Concatenator<> concatenator{a};
+    concatenator
+        .append(a)
+        .append(a);
+    CORRADE_COMPARE(concatenator.indexCount(), 0);
+    CORRADE_COMPARE_AS(concatenator.indexOffsets(),
+        Containers::arrayView<UnsignedInt>({0, 2}),
+        TestSuite::Compare::Container);
+
+    Trade::MeshData dst = concatenator.finalize();
+    CORRADE_VERIFY(!dst.isIndexed());
+    CORRADE_COMPARE_AS(dst.attribute<Vector3>(Trade::MeshAttribute::Position),
+        Containers::arrayView<Vector3>({
+            {1.0f, 2.0f, 3.0f},
+            {4.0f, 5.0f, 6.0f},
+            {1.0f, 2.0f, 3.0f},
+            {4.0f, 5.0f, 6.0f}
+        }), TestSuite::Compare::Container);
+}
+
+void ConcatenateTest::concatenatorNoAttributes() {
+    Trade::MeshData a{MeshPrimitive::Points, 3};
+    const UnsignedShort indices[]{1, 0};
+    Trade::MeshData b{MeshPrimitive::Points, {}, indices, Trade::MeshIndexData{indices}, 2};
+
+    MeshTools::Concatenator<> concatenator{a};
+    Trade::MeshData dst = concatenator
+        .append(a)
+        .append(b)
+        .finalize();
+    CORRADE_COMPARE(dst.attributeCount(), 0);
+    CORRADE_COMPARE(dst.vertexCount(), 5);
+    CORRADE_VERIFY(!dst.vertexData());
+    CORRADE_VERIFY(dst.isIndexed());
+    CORRADE_COMPARE_AS(dst.indices<UnsignedInt>(),
+        Containers::arrayView<UnsignedInt>({
+            0, 1, 2,
+            4, 3
+        }), TestSuite::Compare::Container);
+}
+
+void ConcatenateTest::concatenatorReserve() {
+    const Vector3 positions[]{
+        {1.0f, 2.0f, 3.0f},
+        {4.0f, 5.0f, 6.0f},
+        {7.0f, 8.0f, 9.0f}
+    };
+    const UnsignedInt indices[]{0, 1, 2, 2, 1, 0};
+    Trade::MeshData a{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices}, {}, positions, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                Containers::arrayView(positions)}
+        }};
+
+    MeshTools::Concatenator<> concatenator{a};
+    concatenator.reserve(100*6, 100*3, 100);
+    for(std::size_t i = 0; i != 100; ++i) concatenator.append(a);
+    CORRADE_COMPARE(concatenator.indexCount(), 600);
+    CORRADE_COMPARE(concatenator.vertexCount(), 300);
+    CORRADE_COMPARE(concatenator.vertexOffsets()[99], 297);
+
+    Trade::MeshData dst = concatenator.finalize();
+    CORRADE_COMPARE(dst.indices<UnsignedInt>()[599], 297);
+    CORRADE_COMPARE(dst.attribute<Vector3>(Trade::MeshAttribute::Position)[298], (Vector3{4.0f, 5.0f, 6.0f}));
+
+    /* Appending within the reserved capacity shouldn't reallocate, so the
+       capacity should stay at what was reserved */
+    Containers::Array<char> indexData = dst.releaseIndexData();
+    Containers::Array<char> vertexData = dst.releaseVertexData();
+    CORRADE_COMPARE(Containers::arrayCapacity(indexData), 100*6*sizeof(UnsignedInt));
+    CORRADE_COMPARE(Containers::arrayCapacity(vertexData), 100*3*sizeof(Vector3));
+}
+
+void ConcatenateTest::concatenatorUnsupportedPrimitive() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Trade::MeshData a{MeshPrimitive::TriangleFan, 0};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::Concatenator<>{a};
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::Concatenator: MeshPrimitive::TriangleFan is not supported, turn it into a plain indexed mesh first\n");
+}
+
+void ConcatenateTest::concatenatorImplementationSpecificVertexFormat() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Trade::MeshData a{MeshPrimitive::Lines, nullptr, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+            VertexFormat::Vector3, nullptr},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Color,
+            vertexFormatWrap(0xcaca), nullptr}
+    }};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::Concatenator<>{a};
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::Concatenator: attribute 1 of the layout mesh has an implementation-specific format 0xcaca\n");
+}
+
+void ConcatenateTest::concatenatorInconsistentPrimitive() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Trade::MeshData a{MeshPrimitive::Triangles, 0};
+    Trade::MeshData b{MeshPrimitive::Lines, 0};
+
+    MeshTools::Concatenator<> concatenator{a};
+    concatenator.append(a);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    concatenator.append(b);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::Concatenator::append(): expected MeshPrimitive::Triangles but got MeshPrimitive::Lines in mesh 1\n");
+}
+
+void ConcatenateTest::concatenatorAlreadyFinalized() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Trade::MeshData a{MeshPrimitive::Triangles, 0};
+
+    MeshTools::Concatenator<> concatenator{a};
+    concatenator.finalize();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    concatenator.append(a);
+    concatenator.finalize();
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::Concatenator::append(): the output was already finalized\n"
+        "MeshTools::Concatenator::finalize(): the output was already finalized\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::ConcatenateTest)
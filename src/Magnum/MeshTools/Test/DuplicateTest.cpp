@@ -42,6 +42,8 @@ struct DuplicateTest: TestSuite::Tester {
 
     void duplicate();
     void duplicateOutOfBounds();
+    void duplicateLarge();
+    void duplicateLargeOutOfBounds();
     #ifdef MAGNUM_BUILD_DEPRECATED
     void duplicateStl();
     #endif
@@ -67,11 +69,14 @@ struct DuplicateTest: TestSuite::Tester {
     void duplicateMeshDataExtraOffsetOnly();
     void duplicateMeshDataExtraImplementationSpecificVertexFormat();
     void duplicateMeshDataNoAttributes();
+    void duplicateMeshDataLarge();
 };
 
 DuplicateTest::DuplicateTest() {
     addTests({&DuplicateTest::duplicate,
               &DuplicateTest::duplicateOutOfBounds,
+              &DuplicateTest::duplicateLarge,
+              &DuplicateTest::duplicateLargeOutOfBounds,
               #ifdef MAGNUM_BUILD_DEPRECATED
               &DuplicateTest::duplicateStl,
               #endif
@@ -102,7 +107,8 @@ DuplicateTest::DuplicateTest() {
               &DuplicateTest::duplicateMeshDataExtraWrongCount,
               &DuplicateTest::duplicateMeshDataExtraOffsetOnly,
               &DuplicateTest::duplicateMeshDataExtraImplementationSpecificVertexFormat,
-              &DuplicateTest::duplicateMeshDataNoAttributes});
+              &DuplicateTest::duplicateMeshDataNoAttributes,
+              &DuplicateTest::duplicateMeshDataLarge});
 }
 
 void DuplicateTest::duplicate() {
@@ -128,6 +134,41 @@ void DuplicateTest::duplicateOutOfBounds() {
         "MeshTools::duplicateInto(): index 4 out of bounds for 4 elements\n");
 }
 
+void DuplicateTest::duplicateLarge() {
+    /* Enough indices to be split into multiple blocks and threads, with the
+       last block not complete */
+    Containers::Array<UnsignedInt> indices{NoInit, 5*65536 + 3};
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        indices[i] = (i*7919) % 1000;
+    Containers::Array<Int> data{NoInit, 1000};
+    for(std::size_t i = 0; i != data.size(); ++i)
+        data[i] = Int(i)*3 - 1500;
+
+    Containers::Array<Int> expected{NoInit, indices.size()};
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        expected[i] = data[indices[i]];
+
+    CORRADE_COMPARE_AS((MeshTools::duplicate<UnsignedInt, Int>(indices, data)),
+        expected,
+        TestSuite::Compare::Container);
+}
+
+void DuplicateTest::duplicateLargeOutOfBounds() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    /* The bounds are checked on a worker thread, the assertion should be
+       still printed on the main one */
+    Containers::Array<UnsignedInt> indices{ValueInit, 5*65536 + 3};
+    indices[4*65536 + 5] = 1337;
+    constexpr Int data[]{-7, 35, 12, -18};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::duplicate<UnsignedInt, Int>(indices, data);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::duplicateInto(): index 1337 out of bounds for 4 elements\n");
+}
+
 #ifdef MAGNUM_BUILD_DEPRECATED
 void DuplicateTest::duplicateStl() {
     CORRADE_IGNORE_DEPRECATED_PUSH
@@ -489,6 +530,45 @@ void DuplicateTest::duplicateMeshDataNoAttributes() {
     CORRADE_VERIFY(!duplicated.vertexData());
 }
 
+void DuplicateTest::duplicateMeshDataLarge() {
+    /* All attributes are gathered in a single pass over the indices, verify
+       that each lands in the right place even with multiple threads */
+    Containers::Array<UnsignedInt> indices{NoInit, 3*65536 + 7};
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        indices[i] = (i*7919) % 100;
+    Containers::Array<Vector3> positions{NoInit, 100};
+    Containers::Array<UnsignedShort> ids{NoInit, 100};
+    for(std::size_t i = 0; i != positions.size(); ++i) {
+        positions[i] = {Float(i), Float(i)*0.5f, -Float(i)};
+        ids[i] = UnsignedShort(1000 + i);
+    }
+    Trade::MeshData data{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices},
+        {}, positions, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                Containers::arrayView(positions)}
+        }};
+
+    Trade::MeshData duplicated = MeshTools::duplicate(data, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::ObjectId,
+            Containers::arrayView(ids)}
+    });
+    CORRADE_COMPARE(duplicated.vertexCount(), indices.size());
+
+    Containers::Array<Vector3> expectedPositions{NoInit, indices.size()};
+    Containers::Array<UnsignedShort> expectedIds{NoInit, indices.size()};
+    for(std::size_t i = 0; i != indices.size(); ++i) {
+        expectedPositions[i] = positions[indices[i]];
+        expectedIds[i] = ids[indices[i]];
+    }
+    CORRADE_COMPARE_AS(duplicated.attribute<Vector3>(Trade::MeshAttribute::Position),
+        expectedPositions,
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(duplicated.attribute<UnsignedShort>(Trade::MeshAttribute::ObjectId),
+        expectedIds,
+        TestSuite::Compare::Container);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::DuplicateTest)
@@ -0,0 +1,412 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/StringStl.h> /** @todo remove once Debug is stream-free */
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/TypeTraits.h"
+#include "Magnum/MeshTools/BoundingVolume.h"
+#include "Magnum/MeshTools/GenerateMeshlets.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct GenerateMeshletsTest: TestSuite::Tester {
+    explicit GenerateMeshletsTest();
+
+    template<class T> void vertexLimit();
+    void triangleLimit();
+    void empty();
+    void bounds();
+    void cone();
+    void coneWiderThanHemisphere();
+    void coneDegenerate();
+    void degenerateTriangle();
+
+    void wrongIndexCount();
+    void wrongLimits();
+    void indexOutOfBounds();
+
+    void meshData();
+    void meshDataNotIndexed();
+    void meshDataNotTriangles();
+    void meshDataNoPositions();
+    void meshDataImplementationSpecificIndexType();
+};
+
+GenerateMeshletsTest::GenerateMeshletsTest() {
+    addTests({&GenerateMeshletsTest::vertexLimit<UnsignedInt>,
+              &GenerateMeshletsTest::vertexLimit<UnsignedShort>,
+              &GenerateMeshletsTest::vertexLimit<UnsignedByte>,
+              &GenerateMeshletsTest::triangleLimit,
+              &GenerateMeshletsTest::empty,
+              &GenerateMeshletsTest::bounds,
+              &GenerateMeshletsTest::cone,
+              &GenerateMeshletsTest::coneWiderThanHemisphere,
+              &GenerateMeshletsTest::coneDegenerate,
+              &GenerateMeshletsTest::degenerateTriangle,
+
+              &GenerateMeshletsTest::wrongIndexCount,
+              &GenerateMeshletsTest::wrongLimits,
+              &GenerateMeshletsTest::indexOutOfBounds,
+
+              &GenerateMeshletsTest::meshData,
+              &GenerateMeshletsTest::meshDataNotIndexed,
+              &GenerateMeshletsTest::meshDataNotTriangles,
+              &GenerateMeshletsTest::meshDataNoPositions,
+              &GenerateMeshletsTest::meshDataImplementationSpecificIndexType});
+}
+
+/*
+    3---4---5
+    | \ | \ |
+    0---1---2
+*/
+const Vector3 GridPositions[]{
+    {0.0f, 0.0f, 0.0f},
+    {1.0f, 0.0f, 0.0f},
+    {2.0f, 0.0f, 0.0f},
+    {0.0f, 1.0f, 0.0f},
+    {1.0f, 1.0f, 0.0f},
+    {2.0f, 1.0f, 0.0f}
+};
+
+const UnsignedInt GridIndices[]{
+    0, 1, 4,
+    0, 4, 3,
+    1, 2, 5,
+    1, 5, 4
+};
+
+template<class T> void GenerateMeshletsTest::vertexLimit() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    T indices[Containers::arraySize(GridIndices)];
+    for(std::size_t i = 0; i != Containers::arraySize(GridIndices); ++i)
+        indices[i] = GridIndices[i];
+
+    /* The third triangle would add two new vertices, which is over the
+       limit */
+    Containers::Triple<Containers::Array<Meshlet>, Containers::Array<UnsignedInt>, Containers::Array<UnsignedByte>> out = MeshTools::generateMeshlets(Containers::stridedArrayView(indices), GridPositions, 4, 256);
+    CORRADE_COMPARE(out.first().size(), 2);
+    CORRADE_COMPARE(out.first()[0].vertexOffset, 0);
+    CORRADE_COMPARE(out.first()[0].vertexCount, 4);
+    CORRADE_COMPARE(out.first()[0].triangleOffset, 0);
+    CORRADE_COMPARE(out.first()[0].triangleCount, 2);
+    CORRADE_COMPARE(out.first()[1].vertexOffset, 4);
+    CORRADE_COMPARE(out.first()[1].vertexCount, 4);
+    CORRADE_COMPARE(out.first()[1].triangleOffset, 2);
+    CORRADE_COMPARE(out.first()[1].triangleCount, 2);
+    CORRADE_COMPARE_AS(out.second(), Containers::arrayView<UnsignedInt>({
+        0, 1, 4, 3,
+        1, 2, 5, 4
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.third(), Containers::arrayView<UnsignedByte>({
+        0, 1, 2, 0, 2, 3,
+        0, 1, 2, 0, 2, 3
+    }), TestSuite::Compare::Container);
+}
+
+void GenerateMeshletsTest::triangleLimit() {
+    Containers::Triple<Containers::Array<Meshlet>, Containers::Array<UnsignedInt>, Containers::Array<UnsignedByte>> out = MeshTools::generateMeshlets(Containers::stridedArrayView(GridIndices), GridPositions, 256, 1);
+    CORRADE_COMPARE(out.first().size(), 4);
+    for(std::size_t i = 0; i != out.first().size(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(out.first()[i].vertexOffset, i*3);
+        CORRADE_COMPARE(out.first()[i].vertexCount, 3);
+        CORRADE_COMPARE(out.first()[i].triangleOffset, i);
+        CORRADE_COMPARE(out.first()[i].triangleCount, 1);
+    }
+    CORRADE_COMPARE_AS(out.second(),
+        Containers::arrayView(GridIndices),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.third(), Containers::arrayView<UnsignedByte>({
+        0, 1, 2,
+        0, 1, 2,
+        0, 1, 2,
+        0, 1, 2
+    }), TestSuite::Compare::Container);
+}
+
+void GenerateMeshletsTest::empty() {
+    Containers::Triple<Containers::Array<Meshlet>, Containers::Array<UnsignedInt>, Containers::Array<UnsignedByte>> out = MeshTools::generateMeshlets(Containers::StridedArrayView1D<const UnsignedInt>{}, GridPositions, 64, 124);
+    CORRADE_COMPARE(out.first().size(), 0);
+    CORRADE_COMPARE(out.second().size(), 0);
+    CORRADE_COMPARE(out.third().size(), 0);
+}
+
+void GenerateMeshletsTest::bounds() {
+    Containers::Triple<Containers::Array<Meshlet>, Containers::Array<UnsignedInt>, Containers::Array<UnsignedByte>> out = MeshTools::generateMeshlets(Containers::stridedArrayView(GridIndices), GridPositions, 4, 256);
+    CORRADE_COMPARE(out.first().size(), 2);
+
+    /* The bounding sphere should be the same as calculated from just the
+       meshlet vertices */
+    const Containers::Pair<Vector3, Float> first = MeshTools::boundingSphereBouncingBubble(Containers::arrayView({
+        GridPositions[0], GridPositions[1], GridPositions[4], GridPositions[3]
+    }));
+    CORRADE_COMPARE(out.first()[0].center, first.first());
+    CORRADE_COMPARE(out.first()[0].radius, first.second());
+
+    const Containers::Pair<Vector3, Float> second = MeshTools::boundingSphereBouncingBubble(Containers::arrayView({
+        GridPositions[1], GridPositions[2], GridPositions[5], GridPositions[4]
+    }));
+    CORRADE_COMPARE(out.first()[1].center, second.first());
+    CORRADE_COMPARE(out.first()[1].radius, second.second());
+}
+
+void GenerateMeshletsTest::cone() {
+    /* A flat grid has all normals pointing in +Z, the cone is thus of a zero
+       angle */
+    {
+        Containers::Triple<Containers::Array<Meshlet>, Containers::Array<UnsignedInt>, Containers::Array<UnsignedByte>> out = MeshTools::generateMeshlets(Containers::stridedArrayView(GridIndices), GridPositions, 256, 256);
+        CORRADE_COMPARE(out.first().size(), 1);
+        CORRADE_COMPARE(out.first()[0].coneAxis, Vector3::zAxis());
+        CORRADE_COMPARE(out.first()[0].coneCutoff, 0.0f);
+
+    /* Two triangles facing +Z and +X, the axis is between them, with a 45°
+       opening */
+    } {
+        const Vector3 positions[]{
+            {0.0f, 0.0f,  0.0f},
+            {1.0f, 0.0f,  0.0f},
+            {1.0f, 1.0f,  0.0f},
+            {0.0f, 0.0f, -1.0f},
+            {0.0f, 1.0f,  0.0f}
+        };
+        const UnsignedInt indices[]{
+            0, 1, 2,
+            0, 3, 4
+        };
+        Containers::Triple<Containers::Array<Meshlet>, Containers::Array<UnsignedInt>, Containers::Array<UnsignedByte>> out = MeshTools::generateMeshlets(Containers::stridedArrayView(indices), positions, 256, 256);
+        CORRADE_COMPARE(out.first().size(), 1);
+        CORRADE_COMPARE(out.first()[0].coneAxis, (Vector3{1.0f, 0.0f, 1.0f}).normalized());
+        CORRADE_COMPARE(out.first()[0].coneCutoff, Constants::sqrtHalf());
+    }
+}
+
+void GenerateMeshletsTest::coneWiderThanHemisphere() {
+    /* Triangles facing +Z, +X and -Z, the cone is a hemisphere around +X */
+    const Vector3 positions[]{
+        {0.0f, 0.0f,  0.0f},
+        {1.0f, 0.0f,  0.0f},
+        {1.0f, 1.0f,  0.0f},
+        {0.0f, 0.0f, -1.0f},
+        {0.0f, 1.0f,  0.0f}
+    };
+    const UnsignedInt indices[]{
+        0, 1, 2,
+        0, 3, 4,
+        0, 2, 1
+    };
+    Containers::Triple<Containers::Array<Meshlet>, Containers::Array<UnsignedInt>, Containers::Array<UnsignedByte>> out = MeshTools::generateMeshlets(Containers::stridedArrayView(indices), positions, 256, 256);
+    CORRADE_COMPARE(out.first().size(), 1);
+    CORRADE_COMPARE(out.first()[0].coneAxis, Vector3::xAxis());
+    CORRADE_COMPARE(out.first()[0].coneCutoff, 1.0f);
+}
+
+void GenerateMeshletsTest::coneDegenerate() {
+    /* Two opposite triangles, the normals cancel out */
+    const Vector3 positions[]{
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {1.0f, 1.0f, 0.0f}
+    };
+    const UnsignedInt indices[]{
+        0, 1, 2,
+        0, 2, 1
+    };
+    Containers::Triple<Containers::Array<Meshlet>, Containers::Array<UnsignedInt>, Containers::Array<UnsignedByte>> out = MeshTools::generateMeshlets(Containers::stridedArrayView(indices), positions, 256, 256);
+    CORRADE_COMPARE(out.first().size(), 1);
+    CORRADE_COMPARE(out.first()[0].coneAxis, Vector3{});
+    CORRADE_COMPARE(out.first()[0].coneCutoff, 1.0f);
+}
+
+void GenerateMeshletsTest::degenerateTriangle() {
+    /* A triangle referencing the same vertex twice counts it just once, and
+       isn't taken into account for the cone */
+    const UnsignedInt indices[]{
+        0, 1, 4,
+        1, 1, 4,
+        0, 4, 3
+    };
+    Containers::Triple<Containers::Array<Meshlet>, Containers::Array<UnsignedInt>, Containers::Array<UnsignedByte>> out = MeshTools::generateMeshlets(Containers::stridedArrayView(indices), GridPositions, 4, 256);
+    CORRADE_COMPARE(out.first().size(), 1);
+    CORRADE_COMPARE(out.first()[0].vertexCount, 4);
+    CORRADE_COMPARE(out.first()[0].triangleCount, 3);
+    CORRADE_COMPARE(out.first()[0].coneAxis, Vector3::zAxis());
+    CORRADE_COMPARE(out.first()[0].coneCutoff, 0.0f);
+    CORRADE_COMPARE_AS(out.second(), Containers::arrayView<UnsignedInt>({
+        0, 1, 4, 3
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.third(), Containers::arrayView<UnsignedByte>({
+        0, 1, 2,
+        1, 1, 2,
+        0, 2, 3
+    }), TestSuite::Compare::Container);
+}
+
+void GenerateMeshletsTest::wrongIndexCount() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const UnsignedInt indices[4]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::generateMeshlets(Containers::stridedArrayView(indices), GridPositions, 64, 124);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::generateMeshlets(): index count 4 not divisible by 3\n");
+}
+
+void GenerateMeshletsTest::wrongLimits() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::generateMeshlets(Containers::stridedArrayView(GridIndices), GridPositions, 2, 124);
+    MeshTools::generateMeshlets(Containers::stridedArrayView(GridIndices), GridPositions, 257, 124);
+    MeshTools::generateMeshlets(Containers::stridedArrayView(GridIndices), GridPositions, 64, 0);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::generateMeshlets(): expected max vertex count to be in range [3, 256] but got 2\n"
+        "MeshTools::generateMeshlets(): expected max vertex count to be in range [3, 256] but got 257\n"
+        "MeshTools::generateMeshlets(): expected non-zero max triangle count\n");
+}
+
+void GenerateMeshletsTest::indexOutOfBounds() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const UnsignedInt indices[]{
+        0, 1, 2,
+        3, 6, 5
+    };
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::generateMeshlets(Containers::stridedArrayView(indices), GridPositions, 64, 124);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::generateMeshlets(): index 6 out of bounds for 6 elements\n");
+}
+
+void GenerateMeshletsTest::meshData() {
+    const UnsignedShort indices[]{
+        0, 1, 4,
+        0, 4, 3,
+        1, 2, 5,
+        1, 5, 4
+    };
+    /* Positions are expected to be converted to 3D */
+    const Vector2 positions[]{
+        {0.0f, 0.0f},
+        {1.0f, 0.0f},
+        {2.0f, 0.0f},
+        {0.0f, 1.0f},
+        {1.0f, 1.0f},
+        {2.0f, 1.0f}
+    };
+    Trade::MeshData mesh{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices},
+        {}, positions, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(positions)}
+        }};
+
+    Containers::Triple<Containers::Array<Meshlet>, Containers::Array<UnsignedInt>, Containers::Array<UnsignedByte>> out = MeshTools::generateMeshlets(mesh, 4, 256);
+    CORRADE_COMPARE(out.first().size(), 2);
+    CORRADE_COMPARE(out.first()[1].vertexOffset, 4);
+    CORRADE_COMPARE(out.first()[1].triangleOffset, 2);
+    CORRADE_COMPARE(out.first()[1].coneAxis, Vector3::zAxis());
+    CORRADE_COMPARE_AS(out.second(), Containers::arrayView<UnsignedInt>({
+        0, 1, 4, 3,
+        1, 2, 5, 4
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.third(), Containers::arrayView<UnsignedByte>({
+        0, 1, 2, 0, 2, 3,
+        0, 1, 2, 0, 2, 3
+    }), TestSuite::Compare::Container);
+}
+
+void GenerateMeshletsTest::meshDataNotIndexed() {
+    const Vector3 positions[]{
+        GridPositions[0], GridPositions[1], GridPositions[4],
+        GridPositions[0], GridPositions[4], GridPositions[3],
+    };
+    Trade::MeshData mesh{MeshPrimitive::Triangles, {}, positions, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(positions)}
+    }};
+
+    /* Each triangle has its own vertices, so with a limit of four the mesh
+       gets split in two */
+    Containers::Triple<Containers::Array<Meshlet>, Containers::Array<UnsignedInt>, Containers::Array<UnsignedByte>> out = MeshTools::generateMeshlets(mesh, 4, 256);
+    CORRADE_COMPARE(out.first().size(), 2);
+    CORRADE_COMPARE_AS(out.second(), Containers::arrayView<UnsignedInt>({
+        0, 1, 2,
+        3, 4, 5
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.third(), Containers::arrayView<UnsignedByte>({
+        0, 1, 2,
+        0, 1, 2
+    }), TestSuite::Compare::Container);
+}
+
+void GenerateMeshletsTest::meshDataNotTriangles() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::generateMeshlets(Trade::MeshData{MeshPrimitive::Lines, 6}, 64, 124);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::generateMeshlets(): expected a MeshPrimitive::Triangles mesh, got MeshPrimitive::Lines\n");
+}
+
+void GenerateMeshletsTest::meshDataNoPositions() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::generateMeshlets(Trade::MeshData{MeshPrimitive::Triangles, 6}, 64, 124);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::generateMeshlets(): the mesh has no positions\n");
+}
+
+void GenerateMeshletsTest::meshDataImplementationSpecificIndexType() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::generateMeshlets(Trade::MeshData{MeshPrimitive::Triangles,
+        nullptr, Trade::MeshIndexData{meshIndexTypeWrap(0xcaca), Containers::StridedArrayView1D<const void>{}},
+        nullptr, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position, VertexFormat::Vector3, nullptr}
+        }}, 64, 124);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::generateMeshlets(): mesh has an implementation-specific index type 0xcaca\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::GenerateMeshletsTest)
@@ -68,8 +68,28 @@ struct GenerateNormalsTest: TestSuite::Tester {
     void smoothErasedNonContiguous();
     void smoothErasedWrongIndexSize();
 
+    template<class T> void smoothGenerator();
+    void smoothGeneratorBeveledCube();
+    void smoothGeneratorCylinderDeformed();
+    void smoothGeneratorMultithreaded();
+    void smoothGeneratorErased();
+    void smoothGeneratorWrongCount();
+    void smoothGeneratorOutOfBounds();
+    void smoothGeneratorIntoWrongSize();
+    void smoothGeneratorErasedWrongIndexSize();
+
     void benchmarkFlat();
     void benchmarkSmooth();
+    void benchmarkSmoothGenerator();
+};
+
+const struct {
+    const char* name;
+    UnsignedInt threadCount;
+} SmoothGeneratorMultithreadedData[] {
+    {"all threads", 0},
+    {"two threads", 2},
+    {"five threads", 5}
 };
 
 GenerateNormalsTest::GenerateNormalsTest() {
@@ -96,10 +116,26 @@ GenerateNormalsTest::GenerateNormalsTest() {
               &GenerateNormalsTest::smoothErased<UnsignedShort>,
               &GenerateNormalsTest::smoothErased<UnsignedInt>,
               &GenerateNormalsTest::smoothErasedNonContiguous,
-              &GenerateNormalsTest::smoothErasedWrongIndexSize});
+              &GenerateNormalsTest::smoothErasedWrongIndexSize,
+
+              &GenerateNormalsTest::smoothGenerator<UnsignedByte>,
+              &GenerateNormalsTest::smoothGenerator<UnsignedShort>,
+              &GenerateNormalsTest::smoothGenerator<UnsignedInt>,
+              &GenerateNormalsTest::smoothGeneratorBeveledCube,
+              &GenerateNormalsTest::smoothGeneratorCylinderDeformed});
+
+    addInstancedTests({&GenerateNormalsTest::smoothGeneratorMultithreaded},
+        Containers::arraySize(SmoothGeneratorMultithreadedData));
+
+    addTests({&GenerateNormalsTest::smoothGeneratorErased,
+              &GenerateNormalsTest::smoothGeneratorWrongCount,
+              &GenerateNormalsTest::smoothGeneratorOutOfBounds,
+              &GenerateNormalsTest::smoothGeneratorIntoWrongSize,
+              &GenerateNormalsTest::smoothGeneratorErasedWrongIndexSize});
 
     addBenchmarks({&GenerateNormalsTest::benchmarkFlat,
-                   &GenerateNormalsTest::benchmarkSmooth}, 150);
+                   &GenerateNormalsTest::benchmarkSmooth,
+                   &GenerateNormalsTest::benchmarkSmoothGenerator}, 150);
 }
 
 /* Two vertices connected by one edge, each wound in another direction */
@@ -449,6 +485,17 @@ void GenerateNormalsTest::benchmarkSmooth() {
     CORRADE_COMPARE(Math::min(normals), (Vector3{-0.996072f, -0.997808f, -0.996072f}));
 }
 
+void GenerateNormalsTest::benchmarkSmoothGenerator() {
+    SmoothNormalsGenerator generator{BeveledCubeIndices, Containers::arraySize(BeveledCubePositions)};
+
+    Containers::Array<Vector3> normals{NoInit, Containers::arraySize(BeveledCubePositions)};
+    CORRADE_BENCHMARK(10) {
+        generator.generateInto(BeveledCubePositions, normals);
+    }
+
+    CORRADE_COMPARE(Math::min(normals), (Vector3{-0.996072f, -0.997808f, -0.996072f}));
+}
+
 template<class T> void GenerateNormalsTest::smoothErased() {
     setTestCaseTemplateName(Math::TypeTraits<T>::name());
 
@@ -492,6 +539,163 @@ void GenerateNormalsTest::smoothErasedWrongIndexSize() {
         "MeshTools::generateSmoothNormalsInto(): expected index type size 1, 2 or 4 but got 3\n");
 }
 
+template<class T> void GenerateNormalsTest::smoothGenerator() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    /* Two triangles sharing an edge, similar to smoothTwoTriangles() */
+    const T indices[]{0, 1, 2, 3, 1, 2};
+    Vector3 positions[]{
+        {-1.0f, 0.0f, 0.0f},
+        {0.0f, -1.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f}
+    };
+
+    SmoothNormalsGenerator generator{indices, 4};
+    CORRADE_COMPARE(generator.vertexCount(), 4);
+    CORRADE_COMPARE(generator.indexCount(), 6);
+    CORRADE_COMPARE_AS(generator.generate(positions),
+        generateSmoothNormals(indices, positions),
+        TestSuite::Compare::Container);
+
+    /* Move the last vertex out of the plane, the generator should pick up
+       the updated positions without being recreated */
+    positions[3].z() = 1.0f;
+    Vector3 normals[4];
+    generator.generateInto(positions, normals);
+    CORRADE_COMPARE_AS(Containers::arrayView(normals),
+        generateSmoothNormals(indices, positions),
+        TestSuite::Compare::Container);
+}
+
+void GenerateNormalsTest::smoothGeneratorBeveledCube() {
+    SmoothNormalsGenerator generator{BeveledCubeIndices, Containers::arraySize(BeveledCubePositions)};
+
+    /* Calling it repeatedly should give the same result every time */
+    for(std::size_t i = 0; i != 3; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE_AS(generator.generate(BeveledCubePositions),
+            generateSmoothNormals(BeveledCubeIndices, BeveledCubePositions),
+            TestSuite::Compare::Container);
+    }
+}
+
+void GenerateNormalsTest::smoothGeneratorCylinderDeformed() {
+    const Trade::MeshData data = Primitives::cylinderSolid(1, 5, 1.0f);
+    Containers::Array<Vector3> positions = data.positions3DAsArray();
+
+    SmoothNormalsGenerator generator{data.indices(), data.vertexCount()};
+    CORRADE_COMPARE_AS(generator.generate(positions),
+        data.attribute<Vector3>(Trade::MeshAttribute::Normal),
+        TestSuite::Compare::Container);
+
+    /* Squash the cylinder, normals should change the same way as if they'd
+       be generated from scratch */
+    for(Vector3& i: positions) i *= Vector3{2.0f, 0.5f, 1.0f};
+    Containers::Array<Vector3> normals{NoInit, positions.size()};
+    generator.generateInto(positions, normals);
+    CORRADE_COMPARE_AS(normals,
+        generateSmoothNormals(data.indices(), positions),
+        TestSuite::Compare::Container);
+}
+
+void GenerateNormalsTest::smoothGeneratorMultithreaded() {
+    auto&& data = SmoothGeneratorMultithreadedData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* A mesh large enough for each thread to get a range of both faces and
+       vertices, deformed so the normals aren't trivial */
+    const Trade::MeshData mesh = Primitives::cylinderSolid(50, 100, 1.0f);
+    Containers::Array<Vector3> positions = mesh.positions3DAsArray();
+    for(Vector3& i: positions) i *= Vector3{2.0f, 0.5f, 1.0f + i.y()*i.y()};
+
+    SmoothNormalsGenerator generator{mesh.indices(), mesh.vertexCount()};
+    Containers::Array<Vector3> expected = generator.generate(positions, 1);
+
+    /* Calling it repeatedly should give the same result every time, with the
+       output memory reused */
+    Containers::Array<Vector3> normals{NoInit, positions.size()};
+    for(std::size_t i = 0; i != 3; ++i) {
+        CORRADE_ITERATION(i);
+        generator.generateInto(positions, normals, data.threadCount);
+        CORRADE_COMPARE_AS(normals,
+            expected,
+            TestSuite::Compare::Container);
+    }
+}
+
+void GenerateNormalsTest::smoothGeneratorErased() {
+    const UnsignedShort indices[]{0, 1, 2, 3, 4, 5};
+
+    SmoothNormalsGenerator generator{Containers::arrayCast<2, const char>(Containers::stridedArrayView(indices)), 6};
+    CORRADE_COMPARE(generator.indexCount(), 6);
+    CORRADE_COMPARE_AS(generator.generate(TwoTriangles),
+        Containers::arrayView<Vector3>({
+            Vector3::zAxis(),
+            Vector3::zAxis(),
+            Vector3::zAxis(),
+            -Vector3::zAxis(),
+            -Vector3::zAxis(),
+            -Vector3::zAxis()
+        }), TestSuite::Compare::Container);
+}
+
+void GenerateNormalsTest::smoothGeneratorWrongCount() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::stringstream out;
+    Error redirectError{&out};
+
+    const UnsignedByte indices[7]{};
+    SmoothNormalsGenerator{indices, 1};
+    CORRADE_COMPARE(out.str(), "MeshTools::SmoothNormalsGenerator: index count not divisible by 3\n");
+}
+
+void GenerateNormalsTest::smoothGeneratorOutOfBounds() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::stringstream out;
+    Error redirectError{&out};
+
+    const UnsignedInt indices[] { 0, 1, 2 };
+    SmoothNormalsGenerator{indices, 2};
+    CORRADE_COMPARE(out.str(), "MeshTools::SmoothNormalsGenerator: index 2 out of bounds for 2 elements\n");
+}
+
+void GenerateNormalsTest::smoothGeneratorIntoWrongSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const UnsignedByte indices[6]{};
+    SmoothNormalsGenerator generator{indices, 3};
+
+    const Vector3 positions[3];
+    const Vector3 positionsWrong[4];
+    Vector3 normals[3];
+    Vector3 normalsWrong[4];
+
+    std::stringstream out;
+    Error redirectError{&out};
+    generator.generateInto(positionsWrong, normals);
+    generator.generateInto(positions, normalsWrong);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::SmoothNormalsGenerator::generateInto(): expected 3 positions but got 4\n"
+        "MeshTools::SmoothNormalsGenerator::generateInto(): bad output size, expected 3 but got 4\n");
+}
+
+void GenerateNormalsTest::smoothGeneratorErasedWrongIndexSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const char indices[6*4]{};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    SmoothNormalsGenerator{Containers::StridedArrayView2D<const char>{indices, {6, 2}, {4, 2}}, 3};
+    SmoothNormalsGenerator{Containers::StridedArrayView2D<const char>{indices, {6, 3}, {4, 1}}, 3};
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::SmoothNormalsGenerator: second index view dimension is not contiguous\n"
+        "MeshTools::SmoothNormalsGenerator: expected index type size 1, 2 or 4 but got 3\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::GenerateNormalsTest)
@@ -98,6 +98,12 @@ struct InterleaveTest: Corrade::TestSuite::Tester {
     void interleaveMeshDataAlreadyInterleavedMoveIndices();
     void interleaveMeshDataAlreadyInterleavedMoveNonOwned();
     void interleaveMeshDataNothing();
+    void interleaveMeshDataMultipleBlocks();
+
+    void interleaveMeshDataInto();
+    void interleaveMeshDataIntoWrongSize();
+    void interleaveMeshDataIntoExtraWrongCount();
+    void interleaveMeshDataIntoNothing();
 };
 
 const struct {
@@ -190,7 +196,13 @@ InterleaveTest::InterleaveTest() {
         Containers::arraySize(StridedIndicesData));
 
     addTests({&InterleaveTest::interleaveMeshDataAlreadyInterleavedMoveNonOwned,
-              &InterleaveTest::interleaveMeshDataNothing});
+              &InterleaveTest::interleaveMeshDataNothing,
+              &InterleaveTest::interleaveMeshDataMultipleBlocks,
+
+              &InterleaveTest::interleaveMeshDataInto,
+              &InterleaveTest::interleaveMeshDataIntoWrongSize,
+              &InterleaveTest::interleaveMeshDataIntoExtraWrongCount,
+              &InterleaveTest::interleaveMeshDataIntoNothing});
 }
 
 void InterleaveTest::attributeCount() {
@@ -1515,6 +1527,120 @@ void InterleaveTest::interleaveMeshDataNothing() {
     CORRADE_COMPARE(interleaved.vertexData().size(), 0);
 }
 
+void InterleaveTest::interleaveMeshDataMultipleBlocks() {
+    /* Enough vertices for the data to get copied in more than one block */
+    Containers::Array<Vector3> positions{NoInit, 5000};
+    Containers::Array<Vector2> textureCoordinates{NoInit, 5000};
+    for(std::size_t i = 0; i != positions.size(); ++i) {
+        positions[i] = Vector3{Float(i), Float(i*2), Float(i*3)};
+        textureCoordinates[i] = Vector2{Float(i), -Float(i)};
+    }
+
+    Containers::Array<char> vertexData{NoInit, positions.size()*sizeof(Vector3) + textureCoordinates.size()*sizeof(Vector2)};
+    Containers::ArrayView<Vector3> originalPositions = Containers::arrayCast<Vector3>(vertexData.prefix(positions.size()*sizeof(Vector3)));
+    Containers::ArrayView<Vector2> originalTextureCoordinates = Containers::arrayCast<Vector2>(vertexData.exceptPrefix(positions.size()*sizeof(Vector3)));
+    Utility::copy(positions, originalPositions);
+    Utility::copy(textureCoordinates, originalTextureCoordinates);
+
+    Trade::MeshData data{MeshPrimitive::Points, {}, vertexData, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position, originalPositions},
+        Trade::MeshAttributeData{Trade::MeshAttribute::TextureCoordinates, originalTextureCoordinates}
+    }};
+    CORRADE_VERIFY(!MeshTools::isInterleaved(data));
+
+    Trade::MeshData interleaved = MeshTools::interleave(data);
+    CORRADE_VERIFY(MeshTools::isInterleaved(interleaved));
+    CORRADE_COMPARE(interleaved.attributeStride(0), 20);
+    CORRADE_COMPARE_AS(interleaved.attribute<Vector3>(Trade::MeshAttribute::Position),
+        Containers::stridedArrayView(positions),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(interleaved.attribute<Vector2>(Trade::MeshAttribute::TextureCoordinates),
+        Containers::stridedArrayView(textureCoordinates),
+        TestSuite::Compare::Container);
+}
+
+void InterleaveTest::interleaveMeshDataInto() {
+    Vector2 positions[]{{1.3f, 0.3f}, {0.87f, 1.1f}, {1.0f, -0.5f}};
+    Trade::MeshData data{MeshPrimitive::TriangleFan,
+        {}, Containers::arrayView(positions), {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(positions)}
+        }};
+
+    const Vector3 normals[]{Vector3::xAxis(), Vector3::yAxis(), Vector3::zAxis()};
+    const Trade::MeshAttributeData extra[]{
+        Trade::MeshAttributeData{4},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Normal, Containers::arrayView(normals)}
+    };
+    CORRADE_COMPARE(MeshTools::interleavedVertexDataSize(data, extra), 3*24);
+
+    /* Fill the destination with a pattern to verify the padding is left
+       untouched */
+    char vertexData[3*24];
+    for(char& i: vertexData) i = '\xcd';
+    Containers::Array<Trade::MeshAttributeData> attributes = MeshTools::interleaveInto(data, vertexData, extra);
+    CORRADE_COMPARE(attributes.size(), 2);
+
+    Trade::MeshData interleaved{MeshPrimitive::TriangleFan, {}, vertexData, std::move(attributes)};
+    CORRADE_VERIFY(MeshTools::isInterleaved(interleaved));
+    CORRADE_COMPARE(interleaved.vertexCount(), 3);
+    CORRADE_COMPARE(interleaved.attributeStride(Trade::MeshAttribute::Normal), 24);
+    CORRADE_COMPARE(interleaved.attributeOffset(Trade::MeshAttribute::Normal), 12);
+    CORRADE_COMPARE_AS(interleaved.attribute<Vector2>(Trade::MeshAttribute::Position),
+        Containers::stridedArrayView(positions),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(interleaved.attribute<Vector3>(Trade::MeshAttribute::Normal),
+        Containers::stridedArrayView(normals),
+        TestSuite::Compare::Container);
+    for(std::size_t i = 0; i != 3; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(vertexData[i*24 + 8], '\xcd');
+        CORRADE_COMPARE(vertexData[i*24 + 11], '\xcd');
+    }
+}
+
+void InterleaveTest::interleaveMeshDataIntoWrongSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Vector2 positions[]{{1.3f, 0.3f}, {0.87f, 1.1f}, {1.0f, -0.5f}};
+    Trade::MeshData data{MeshPrimitive::TriangleFan,
+        {}, Containers::arrayView(positions), {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(positions)}
+        }};
+
+    char vertexData[25];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::interleaveInto(data, vertexData);
+    CORRADE_COMPARE(out.str(), "MeshTools::interleaveInto(): expected a buffer of 24 bytes but got 25\n");
+}
+
+void InterleaveTest::interleaveMeshDataIntoExtraWrongCount() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Vector2 positions[]{{1.3f, 0.3f}, {0.87f, 1.1f}, {1.0f, -0.5f}};
+    Trade::MeshData data{MeshPrimitive::TriangleFan,
+        {}, Containers::arrayView(positions), {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(positions)}
+        }};
+    const Vector3 normals[]{Vector3::xAxis(), Vector3::yAxis()};
+
+    char vertexData[3*20];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::interleaveInto(data, vertexData, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Normal, VertexFormat::Vector3, Containers::arrayView(normals)}
+    });
+    CORRADE_COMPARE(out.str(), "MeshTools::interleaveInto(): extra attribute 0 expected to have 3 items but got 2\n");
+}
+
+void InterleaveTest::interleaveMeshDataIntoNothing() {
+    Trade::MeshData data{MeshPrimitive::Points, 2};
+    CORRADE_COMPARE(MeshTools::interleavedVertexDataSize(data), 0);
+    CORRADE_VERIFY(!MeshTools::interleaveInto(data, nullptr));
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::InterleaveTest)
@@ -0,0 +1,635 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/StringStl.h> /** @todo remove once Debug is stream-free */
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/TypeTraits.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/Optimize.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct OptimizeTest: TestSuite::Tester {
+    explicit OptimizeTest();
+
+    template<class T> void vertexCache();
+    void vertexCacheErased();
+    void vertexCacheAcmr();
+    void vertexCacheEmpty();
+    void vertexCacheDegenerateTriangle();
+    void vertexCacheWrongIndexCount();
+    void vertexCacheIndexOutOfBounds();
+    void vertexCacheErasedWrongIndexSize();
+
+    template<class T> void overdraw();
+    void overdrawFlat();
+    void overdrawWrongIndexCount();
+    void overdrawZeroCacheSize();
+    void overdrawIndexOutOfBounds();
+
+    template<class T> void vertexFetch();
+    void vertexFetchErased();
+    void vertexFetchIndexOutOfBounds();
+
+    void meshDataVertexCache();
+    void meshDataVertexCacheRvalue();
+    void meshDataOverdraw();
+    void meshDataVertexFetch();
+    void meshDataNotIndexed();
+    void meshDataNotTriangles();
+    void meshDataNoPositions();
+    void meshDataNoAttributes();
+    void meshDataImplementationSpecificIndexType();
+};
+
+/* Same mesh as in TipsifyTest
+
+ 0 ----- 1 ----- 2 ----- 3
+  \ 0  /  \ 7  /  \ 2  /  \
+   \  / 11 \  / 13 \  / 12 \
+    4 ----- 5 ----- 6 ----- 7
+   /  \ 3  /  \ 8  /  \ 5  /
+  / 14 \  / 9  \  / 15 \  /
+ 8 ----- 9 ---- 10 ---- 11          18 ---- 17
+  \ 4  /  \ 1  /  \ 17 /  \           \ 18  /
+   \  / 16 \  / 10 \  / 6  \           \  /
+    12 ---- 13 ---- 14 ---- 15          16
+
+*/
+
+constexpr UnsignedInt Indices[]{
+    4, 1, 0,
+    10, 9, 13,
+    6, 3, 2,
+    9, 5, 4,
+    12, 9, 8,
+    11, 7, 6,
+
+    14, 15, 11,
+    2, 1, 5,
+    10, 6, 5,
+    10, 5, 9,
+    13, 14, 10,
+    1, 4, 5,
+
+    7, 3, 6,
+    6, 2, 5,
+    9, 4, 8,
+    6, 10, 11,
+    13, 9, 12,
+    14, 11, 10,
+
+    16, 17, 18
+};
+
+constexpr std::size_t VertexCount = 19;
+
+constexpr UnsignedInt OptimizedIndices[]{
+    16, 17, 18, /* all vertices have just one triangle, chosen first */
+    4, 1, 0,
+    1, 4, 5,
+    2, 1, 5,
+    9, 5, 4,
+    9, 4, 8,
+    12, 9, 8,
+    13, 9, 12,
+    10, 9, 13,
+    10, 5, 9,
+    13, 14, 10,
+    6, 2, 5,
+    10, 6, 5,
+    6, 3, 2,
+    7, 3, 6,
+    11, 7, 6,
+    6, 10, 11,
+    14, 11, 10,
+    14, 15, 11
+};
+
+/* Average count of vertex transformations per triangle, simulating a FIFO
+   cache of given size */
+Float acmr(const Containers::ArrayView<const UnsignedInt> indices, const std::size_t vertexCount, const UnsignedInt cacheSize) {
+    Containers::Array<UnsignedInt> timestamp{vertexCount};
+    UnsignedInt time = cacheSize + 1;
+    UnsignedInt misses = 0;
+    for(const UnsignedInt index: indices) {
+        if(time - timestamp[index] > cacheSize) {
+            timestamp[index] = time++;
+            ++misses;
+        }
+    }
+    return Float(misses)/Float(indices.size()/3);
+}
+
+/* Triangles rotated so the smallest index is first, packed into a single
+   integer and sorted. Comparing the output of this verifies that the set of
+   triangles stays the same, including their winding. */
+Containers::Array<UnsignedInt> sortedTriangles(const Containers::ArrayView<const UnsignedInt> indices) {
+    Containers::Array<UnsignedInt> out{NoInit, indices.size()/3};
+    for(std::size_t i = 0; i != out.size(); ++i) {
+        UnsignedInt a = indices[i*3 + 0];
+        UnsignedInt b = indices[i*3 + 1];
+        UnsignedInt c = indices[i*3 + 2];
+        while(a > b || a > c) {
+            const UnsignedInt t = a;
+            a = b;
+            b = c;
+            c = t;
+        }
+        out[i] = a << 20 | b << 10 | c;
+    }
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+/* A grid of 31x31 quads, with triangles shuffled to destroy any locality */
+Containers::Array<UnsignedInt> shuffledGrid() {
+    constexpr UnsignedInt Size = 31;
+    constexpr UnsignedInt TriangleCount = Size*Size*2;
+    Containers::Array<UnsignedInt> grid{NoInit, TriangleCount*3};
+    for(UnsignedInt y = 0; y != Size; ++y) for(UnsignedInt x = 0; x != Size; ++x) {
+        const UnsignedInt a = y*(Size + 1) + x;
+        const UnsignedInt b = a + 1;
+        const UnsignedInt c = a + Size + 1;
+        const UnsignedInt d = c + 1;
+        const UnsignedInt t = (y*Size + x)*2;
+        grid[t*3 + 0] = a;
+        grid[t*3 + 1] = b;
+        grid[t*3 + 2] = d;
+        grid[t*3 + 3] = a;
+        grid[t*3 + 4] = d;
+        grid[t*3 + 5] = c;
+    }
+
+    /* 7919 is a prime, so this is a permutation */
+    Containers::Array<UnsignedInt> shuffled{NoInit, grid.size()};
+    for(UnsignedInt t = 0; t != TriangleCount; ++t) {
+        const UnsignedInt source = (t*7919) % TriangleCount;
+        for(std::size_t i = 0; i != 3; ++i)
+            shuffled[t*3 + i] = grid[source*3 + i];
+    }
+    return shuffled;
+}
+
+OptimizeTest::OptimizeTest() {
+    addTests({&OptimizeTest::vertexCache<UnsignedByte>,
+              &OptimizeTest::vertexCache<UnsignedShort>,
+              &OptimizeTest::vertexCache<UnsignedInt>,
+              &OptimizeTest::vertexCacheErased,
+              &OptimizeTest::vertexCacheAcmr,
+              &OptimizeTest::vertexCacheEmpty,
+              &OptimizeTest::vertexCacheDegenerateTriangle,
+              &OptimizeTest::vertexCacheWrongIndexCount,
+              &OptimizeTest::vertexCacheIndexOutOfBounds,
+              &OptimizeTest::vertexCacheErasedWrongIndexSize,
+
+              &OptimizeTest::overdraw<UnsignedByte>,
+              &OptimizeTest::overdraw<UnsignedShort>,
+              &OptimizeTest::overdraw<UnsignedInt>,
+              &OptimizeTest::overdrawFlat,
+              &OptimizeTest::overdrawWrongIndexCount,
+              &OptimizeTest::overdrawZeroCacheSize,
+              &OptimizeTest::overdrawIndexOutOfBounds,
+
+              &OptimizeTest::vertexFetch<UnsignedByte>,
+              &OptimizeTest::vertexFetch<UnsignedShort>,
+              &OptimizeTest::vertexFetch<UnsignedInt>,
+              &OptimizeTest::vertexFetchErased,
+              &OptimizeTest::vertexFetchIndexOutOfBounds,
+
+              &OptimizeTest::meshDataVertexCache,
+              &OptimizeTest::meshDataVertexCacheRvalue,
+              &OptimizeTest::meshDataOverdraw,
+              &OptimizeTest::meshDataVertexFetch,
+              &OptimizeTest::meshDataNotIndexed,
+              &OptimizeTest::meshDataNotTriangles,
+              &OptimizeTest::meshDataNoPositions,
+              &OptimizeTest::meshDataNoAttributes,
+              &OptimizeTest::meshDataImplementationSpecificIndexType});
+}
+
+template<class T> void OptimizeTest::vertexCache() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    T indices[Containers::arraySize(Indices)];
+    for(std::size_t i = 0; i != Containers::arraySize(Indices); ++i)
+        indices[i] = Indices[i];
+    MeshTools::optimizeVertexCacheInPlace(Containers::stridedArrayView(indices), VertexCount);
+
+    T expected[Containers::arraySize(OptimizedIndices)];
+    for(std::size_t i = 0; i != Containers::arraySize(OptimizedIndices); ++i)
+        expected[i] = OptimizedIndices[i];
+    CORRADE_COMPARE_AS(Containers::arrayView(indices),
+        Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void OptimizeTest::vertexCacheErased() {
+    UnsignedShort indices[Containers::arraySize(Indices)];
+    for(std::size_t i = 0; i != Containers::arraySize(Indices); ++i)
+        indices[i] = Indices[i];
+    MeshTools::optimizeVertexCacheInPlace(Containers::arrayCast<2, char>(Containers::stridedArrayView(indices)), VertexCount);
+
+    UnsignedShort expected[Containers::arraySize(OptimizedIndices)];
+    for(std::size_t i = 0; i != Containers::arraySize(OptimizedIndices); ++i)
+        expected[i] = OptimizedIndices[i];
+    CORRADE_COMPARE_AS(Containers::arrayView(indices),
+        Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void OptimizeTest::vertexCacheAcmr() {
+    Containers::Array<UnsignedInt> indices = shuffledGrid();
+    const std::size_t vertexCount = 32*32;
+    CORRADE_COMPARE(acmr(indices, vertexCount, 16), 3.0f);
+
+    MeshTools::optimizeVertexCacheInPlace(Containers::stridedArrayView(indices), vertexCount);
+
+    /* The ideal for a regular grid is 0.5, the unshuffled row-by-row order
+       is slightly over 1 */
+    CORRADE_COMPARE_AS(acmr(indices, vertexCount, 16), 0.75f,
+        TestSuite::Compare::Less);
+    CORRADE_COMPARE_AS(acmr(indices, vertexCount, 32), 0.75f,
+        TestSuite::Compare::Less);
+
+    /* All triangles should be still there, in the original winding */
+    CORRADE_COMPARE_AS(sortedTriangles(indices),
+        sortedTriangles(shuffledGrid()),
+        TestSuite::Compare::Container);
+}
+
+void OptimizeTest::vertexCacheEmpty() {
+    /* Shouldn't crash or try to access anything */
+    MeshTools::optimizeVertexCacheInPlace(Containers::StridedArrayView1D<UnsignedInt>{}, 0);
+    CORRADE_VERIFY(true);
+}
+
+void OptimizeTest::vertexCacheDegenerateTriangle() {
+    UnsignedInt indices[]{0, 0, 0, 1, 2, 2};
+    MeshTools::optimizeVertexCacheInPlace(Containers::stridedArrayView(indices), 3);
+
+    /* The vertices of the second triangle have higher valence score, so it's
+       picked first */
+    CORRADE_COMPARE_AS(Containers::arrayView(indices),
+        Containers::arrayView<UnsignedInt>({1, 2, 2, 0, 0, 0}),
+        TestSuite::Compare::Container);
+}
+
+void OptimizeTest::vertexCacheWrongIndexCount() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    UnsignedInt indices[7]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::optimizeVertexCacheInPlace(Containers::stridedArrayView(indices), 1);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::optimizeVertexCacheInPlace(): index count 7 not divisible by 3\n");
+}
+
+void OptimizeTest::vertexCacheIndexOutOfBounds() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    UnsignedInt indices[]{0, 1, 2, 3, 4, 5};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::optimizeVertexCacheInPlace(Containers::stridedArrayView(indices), 5);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::optimizeVertexCacheInPlace(): index 5 out of bounds for 5 elements\n");
+}
+
+void OptimizeTest::vertexCacheErasedWrongIndexSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    char indices[3*3]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::optimizeVertexCacheInPlace(Containers::StridedArrayView2D<char>{indices, {3, 3}}.every({1, 2}), 1);
+    MeshTools::optimizeVertexCacheInPlace(Containers::StridedArrayView2D<char>{indices, {3, 3}}, 1);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::optimizeVertexCacheInPlace(): second index view dimension is not contiguous\n"
+        "MeshTools::optimizeVertexCacheInPlace(): expected index type size 1, 2 or 4 but got 3\n");
+}
+
+/* Two disconnected triangles facing +Z, one in front of the other */
+constexpr Vector3 OverdrawPositions[]{
+    {-1.0f, -1.0f, -1.0f},
+    { 1.0f, -1.0f, -1.0f},
+    { 0.0f,  1.0f, -1.0f},
+    {-1.0f, -1.0f,  1.0f},
+    { 1.0f, -1.0f,  1.0f},
+    { 0.0f,  1.0f,  1.0f},
+};
+
+template<class T> void OptimizeTest::overdraw() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    /* The back triangle is first, the front one should get drawn first to
+       occlude it. Since all vertices of the second triangle are a cache miss,
+       it's considered a separate cluster. */
+    T indices[]{0, 1, 2, 3, 4, 5};
+    MeshTools::optimizeOverdrawInPlace(Containers::stridedArrayView(indices), OverdrawPositions);
+    CORRADE_COMPARE_AS(Containers::arrayView(indices),
+        Containers::arrayView<T>({3, 4, 5, 0, 1, 2}),
+        TestSuite::Compare::Container);
+
+    /* Already in the right order, nothing changes */
+    MeshTools::optimizeOverdrawInPlace(Containers::stridedArrayView(indices), OverdrawPositions);
+    CORRADE_COMPARE_AS(Containers::arrayView(indices),
+        Containers::arrayView<T>({3, 4, 5, 0, 1, 2}),
+        TestSuite::Compare::Container);
+}
+
+void OptimizeTest::overdrawFlat() {
+    Containers::Array<UnsignedInt> indices = shuffledGrid();
+    const std::size_t vertexCount = 32*32;
+    MeshTools::optimizeVertexCacheInPlace(Containers::stridedArrayView(indices), vertexCount);
+    Containers::Array<UnsignedInt> expected{NoInit, indices.size()};
+    Utility::copy(indices, expected);
+
+    Containers::Array<Vector3> positions{NoInit, vertexCount};
+    for(std::size_t i = 0; i != vertexCount; ++i)
+        positions[i] = {Float(i % 32), Float(i/32), 0.0f};
+    MeshTools::optimizeOverdrawInPlace(Containers::stridedArrayView(indices), positions);
+
+    /* All clusters are coplanar, so none of them occludes any other and the
+       order is kept, preserving the vertex cache optimization */
+    CORRADE_COMPARE_AS(indices, expected,
+        TestSuite::Compare::Container);
+}
+
+void OptimizeTest::overdrawWrongIndexCount() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    UnsignedInt indices[7]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::optimizeOverdrawInPlace(Containers::stridedArrayView(indices), OverdrawPositions);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::optimizeOverdrawInPlace(): index count 7 not divisible by 3\n");
+}
+
+void OptimizeTest::overdrawZeroCacheSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    UnsignedInt indices[3]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::optimizeOverdrawInPlace(Containers::stridedArrayView(indices), OverdrawPositions, 0);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::optimizeOverdrawInPlace(): expected non-zero cache size\n");
+}
+
+void OptimizeTest::overdrawIndexOutOfBounds() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    UnsignedInt indices[]{0, 1, 6};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::optimizeOverdrawInPlace(Containers::stridedArrayView(indices), OverdrawPositions);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::optimizeOverdrawInPlace(): index 6 out of bounds for 6 elements\n");
+}
+
+template<class T> void OptimizeTest::vertexFetch() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    T indices[]{3, 1, 3, 4, 1, 1};
+    Int data[]{10, 11, 12, 13, 14};
+    CORRADE_COMPARE(MeshTools::optimizeVertexFetchInPlace(Containers::stridedArrayView(indices), Containers::arrayCast<2, char>(Containers::stridedArrayView(data))), 3);
+
+    /* Vertices in order of first use, unreferenced ones at the end */
+    CORRADE_COMPARE_AS(Containers::arrayView(indices),
+        Containers::arrayView<T>({0, 1, 0, 2, 1, 1}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(data),
+        Containers::arrayView<Int>({13, 11, 14, 10, 12}),
+        TestSuite::Compare::Container);
+}
+
+void OptimizeTest::vertexFetchErased() {
+    UnsignedShort indices[]{3, 1, 3, 4, 1, 1};
+    Int data[]{10, 11, 12, 13, 14};
+    CORRADE_COMPARE(MeshTools::optimizeVertexFetchInPlace(Containers::arrayCast<2, char>(Containers::stridedArrayView(indices)), Containers::arrayCast<2, char>(Containers::stridedArrayView(data))), 3);
+
+    CORRADE_COMPARE_AS(Containers::arrayView(indices),
+        Containers::arrayView<UnsignedShort>({0, 1, 0, 2, 1, 1}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(data),
+        Containers::arrayView<Int>({13, 11, 14, 10, 12}),
+        TestSuite::Compare::Container);
+}
+
+void OptimizeTest::vertexFetchIndexOutOfBounds() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    UnsignedInt indices[]{0, 1, 5};
+    Int data[5]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::optimizeVertexFetchInPlace(Containers::stridedArrayView(indices), Containers::arrayCast<2, char>(Containers::stridedArrayView(data)));
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::optimizeVertexFetchInPlace(): index 5 out of bounds for 5 elements\n");
+}
+
+void OptimizeTest::meshDataVertexCache() {
+    const UnsignedInt ids[VertexCount]{};
+    const Trade::MeshData mesh{MeshPrimitive::Triangles,
+        {}, Indices, Trade::MeshIndexData{Indices},
+        {}, ids, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::ObjectId, Containers::arrayView(ids)}
+        }};
+
+    /* The input is not owned, so a copy is made */
+    Trade::MeshData out = MeshTools::optimizeVertexCache(mesh);
+    CORRADE_COMPARE(out.indexType(), MeshIndexType::UnsignedInt);
+    CORRADE_COMPARE(out.vertexCount(), 19);
+    CORRADE_VERIFY(out.vertexData().data() != static_cast<const void*>(ids));
+    CORRADE_COMPARE_AS(out.indices<UnsignedInt>(),
+        Containers::arrayView(OptimizedIndices),
+        TestSuite::Compare::Container);
+}
+
+void OptimizeTest::meshDataVertexCacheRvalue() {
+    Containers::Array<char> indexData{sizeof(Indices)};
+    Utility::copy(Containers::arrayCast<const char>(Containers::arrayView(Indices)), indexData);
+    Trade::MeshIndexData indices{Containers::arrayCast<UnsignedInt>(indexData)};
+    const void* indexPointer = indexData.data();
+
+    Trade::MeshData out = MeshTools::optimizeVertexCache(Trade::MeshData{MeshPrimitive::Triangles, std::move(indexData), indices, VertexCount});
+
+    /* The data are owned, so the optimization is done in-place */
+    CORRADE_COMPARE(static_cast<const void*>(out.indexData().data()), indexPointer);
+    CORRADE_COMPARE_AS(out.indices<UnsignedInt>(),
+        Containers::arrayView(OptimizedIndices),
+        TestSuite::Compare::Container);
+}
+
+void OptimizeTest::meshDataOverdraw() {
+    const UnsignedByte indices[]{0, 1, 2, 3, 4, 5};
+    const Trade::MeshData mesh{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices},
+        {}, OverdrawPositions, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(OverdrawPositions)}
+        }};
+
+    Trade::MeshData out = MeshTools::optimizeOverdraw(mesh);
+    CORRADE_COMPARE(out.indexType(), MeshIndexType::UnsignedByte);
+    CORRADE_COMPARE_AS(out.indices<UnsignedByte>(),
+        Containers::arrayView<UnsignedByte>({3, 4, 5, 0, 1, 2}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.attribute<Vector3>(Trade::MeshAttribute::Position),
+        Containers::arrayView(OverdrawPositions),
+        TestSuite::Compare::Container);
+}
+
+void OptimizeTest::meshDataVertexFetch() {
+    const UnsignedShort indices[]{3, 1, 0, 0, 1, 3};
+    const struct Vertex {
+        Vector2 position;
+        UnsignedInt id;
+    } vertices[]{
+        {{1.0f, 2.0f}, 0},
+        {{3.0f, 4.0f}, 1},
+        {{5.0f, 6.0f}, 2},
+        {{7.0f, 8.0f}, 3}
+    };
+    const Trade::MeshData mesh{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices},
+        {}, vertices, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::stridedArrayView(vertices).slice(&Vertex::position)},
+            Trade::MeshAttributeData{Trade::MeshAttribute::ObjectId, Containers::stridedArrayView(vertices).slice(&Vertex::id)}
+        }};
+
+    /* Vertex 2 is unreferenced and gets removed */
+    Trade::MeshData out = MeshTools::optimizeVertexFetch(mesh);
+    CORRADE_COMPARE(out.primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(out.indexType(), MeshIndexType::UnsignedShort);
+    CORRADE_COMPARE(out.vertexCount(), 3);
+    CORRADE_COMPARE_AS(out.indices<UnsignedShort>(),
+        Containers::arrayView<UnsignedShort>({0, 1, 2, 2, 1, 0}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.attribute<Vector2>(Trade::MeshAttribute::Position),
+        Containers::arrayView<Vector2>({{7.0f, 8.0f}, {3.0f, 4.0f}, {1.0f, 2.0f}}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.attribute<UnsignedInt>(Trade::MeshAttribute::ObjectId),
+        Containers::arrayView<UnsignedInt>({3, 1, 0}),
+        TestSuite::Compare::Container);
+}
+
+void OptimizeTest::meshDataNotIndexed() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::optimizeVertexCache(Trade::MeshData{MeshPrimitive::Triangles, 6});
+    MeshTools::optimizeOverdraw(Trade::MeshData{MeshPrimitive::Triangles, 6});
+    MeshTools::optimizeVertexFetch(Trade::MeshData{MeshPrimitive::Triangles, 6});
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::optimizeVertexCache(): mesh data not indexed\n"
+        "MeshTools::optimizeOverdraw(): mesh data not indexed\n"
+        "MeshTools::optimizeVertexFetch(): mesh data not indexed\n");
+}
+
+void OptimizeTest::meshDataNotTriangles() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const UnsignedByte indices[]{0, 1};
+    Trade::MeshData mesh{MeshPrimitive::Lines, {}, indices, Trade::MeshIndexData{indices}, 2};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::optimizeVertexCache(mesh);
+    MeshTools::optimizeOverdraw(mesh);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::optimizeVertexCache(): expected a MeshPrimitive::Triangles mesh, got MeshPrimitive::Lines\n"
+        "MeshTools::optimizeOverdraw(): expected a MeshPrimitive::Triangles mesh, got MeshPrimitive::Lines\n");
+}
+
+void OptimizeTest::meshDataNoPositions() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const UnsignedByte indices[]{0, 1, 2};
+    Trade::MeshData mesh{MeshPrimitive::Triangles, {}, indices, Trade::MeshIndexData{indices}, 3};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::optimizeOverdraw(mesh);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::optimizeOverdraw(): the mesh has no positions\n");
+}
+
+void OptimizeTest::meshDataNoAttributes() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const UnsignedByte indices[]{0, 1, 2};
+    Trade::MeshData mesh{MeshPrimitive::Triangles, {}, indices, Trade::MeshIndexData{indices}, 3};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::optimizeVertexFetch(mesh);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::optimizeVertexFetch(): can't optimize vertex fetch of an attributeless mesh\n");
+}
+
+void OptimizeTest::meshDataImplementationSpecificIndexType() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Trade::MeshData mesh{MeshPrimitive::Triangles,
+        nullptr, Trade::MeshIndexData{meshIndexTypeWrap(0xcaca), Containers::StridedArrayView1D<const void>{}},
+        nullptr, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position, VertexFormat::Vector3, nullptr}
+        }};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::optimizeVertexCache(mesh);
+    MeshTools::optimizeOverdraw(mesh);
+    MeshTools::optimizeVertexFetch(mesh);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::optimizeVertexCache(): mesh has an implementation-specific index type 0xcaca\n"
+        "MeshTools::optimizeOverdraw(): mesh has an implementation-specific index type 0xcaca\n"
+        "MeshTools::optimizeVertexFetch(): mesh has an implementation-specific index type 0xcaca\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::OptimizeTest)
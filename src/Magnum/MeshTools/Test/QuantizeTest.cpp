@@ -0,0 +1,315 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/MeshTools/Quantize.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+using namespace Math::Literals;
+
+struct QuantizeTest: TestSuite::Tester {
+    explicit QuantizeTest();
+
+    void positions3D();
+    void positions2D();
+    void positionsSinglePoint();
+    void positionsMultiple();
+    void normalsTangentsBitangents();
+    void textureCoordinates();
+    void passthrough();
+    void noPositions();
+    void vertexSize();
+};
+
+QuantizeTest::QuantizeTest() {
+    addTests({&QuantizeTest::positions3D,
+              &QuantizeTest::positions2D,
+              &QuantizeTest::positionsSinglePoint,
+              &QuantizeTest::positionsMultiple,
+              &QuantizeTest::normalsTangentsBitangents,
+              &QuantizeTest::textureCoordinates,
+              &QuantizeTest::passthrough,
+              &QuantizeTest::noPositions,
+              &QuantizeTest::vertexSize});
+}
+
+void QuantizeTest::positions3D() {
+    /* The X axis has the largest extent, which gets used for all axes */
+    const Vector3 positions[]{
+        {-1.0f, 0.0f, 2.0f},
+        { 3.0f, 1.0f, 2.5f},
+        { 1.0f, 2.0f, 2.0f},
+    };
+    Trade::MeshData mesh{MeshPrimitive::Triangles, {}, positions, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(positions)}
+    }};
+
+    Containers::Pair<Trade::MeshData, Matrix4> out = MeshTools::quantize(mesh);
+    CORRADE_COMPARE(out.second(), Matrix4::translation({-1.0f, 0.0f, 2.0f})*Matrix4::scaling(Vector3{4.0f}));
+    CORRADE_COMPARE(out.first().attributeCount(), 1);
+    CORRADE_COMPARE(out.first().attributeFormat(0), VertexFormat::Vector3usNormalized);
+    CORRADE_COMPARE_AS(out.first().attribute<Vector3us>(0), Containers::arrayView<Vector3us>({
+        {0, 0, 0},
+        {65535, 16384, 8192},
+        {32768, 32768, 0}
+    }), TestSuite::Compare::Container);
+
+    /* Dequantizing gives back the original values */
+    const Containers::Array<Vector3> dequantized = out.first().positions3DAsArray();
+    for(std::size_t i = 0; i != Containers::arraySize(positions); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE_AS((out.second().transformPoint(dequantized[i]) - positions[i]).length(), 4.0f/65535.0f,
+            TestSuite::Compare::LessOrEqual);
+    }
+}
+
+void QuantizeTest::positions2D() {
+    const Vector2 positions[]{
+        {1.0f, 1.0f},
+        {1.5f, 3.0f},
+    };
+    Trade::MeshData mesh{MeshPrimitive::Lines, {}, positions, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(positions)}
+    }};
+
+    Containers::Pair<Trade::MeshData, Matrix4> out = MeshTools::quantize(mesh);
+    CORRADE_COMPARE(out.first().primitive(), MeshPrimitive::Lines);
+    CORRADE_COMPARE(out.second(), Matrix4::translation({1.0f, 1.0f, 0.0f})*Matrix4::scaling(Vector3{2.0f}));
+    CORRADE_COMPARE(out.first().attributeFormat(0), VertexFormat::Vector2usNormalized);
+    CORRADE_COMPARE_AS(out.first().attribute<Vector2us>(0), Containers::arrayView<Vector2us>({
+        {0, 0},
+        {16384, 65535}
+    }), TestSuite::Compare::Container);
+}
+
+void QuantizeTest::positionsSinglePoint() {
+    const Vector3 positions[]{
+        {1.0f, 2.0f, 3.0f},
+        {1.0f, 2.0f, 3.0f},
+    };
+    Trade::MeshData mesh{MeshPrimitive::Points, {}, positions, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(positions)}
+    }};
+
+    /* The scale is 1 instead of 0 to keep the matrix invertible */
+    Containers::Pair<Trade::MeshData, Matrix4> out = MeshTools::quantize(mesh);
+    CORRADE_COMPARE(out.second(), Matrix4::translation({1.0f, 2.0f, 3.0f}));
+    CORRADE_COMPARE_AS(out.first().attribute<Vector3us>(0), Containers::arrayView<Vector3us>({
+        {0, 0, 0},
+        {0, 0, 0}
+    }), TestSuite::Compare::Container);
+}
+
+void QuantizeTest::positionsMultiple() {
+    const struct Vertex {
+        Vector3 position;
+        Vector3 morphedPosition;
+    } vertices[]{
+        {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}},
+        {{1.0f, 1.0f, 1.0f}, {2.0f, 1.0f, 1.0f}}
+    };
+    const Containers::StridedArrayView1D<const Vertex> view = vertices;
+    Trade::MeshData mesh{MeshPrimitive::Points, {}, vertices, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position, view.slice(&Vertex::position)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position, view.slice(&Vertex::morphedPosition)}
+    }};
+
+    /* Both share the same range */
+    Containers::Pair<Trade::MeshData, Matrix4> out = MeshTools::quantize(mesh);
+    CORRADE_COMPARE(out.second(), Matrix4::scaling(Vector3{2.0f}));
+    CORRADE_COMPARE_AS(out.first().attribute<Vector3us>(0), Containers::arrayView<Vector3us>({
+        {0, 0, 0},
+        {32768, 32768, 32768}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.first().attribute<Vector3us>(1), Containers::arrayView<Vector3us>({
+        {0, 0, 0},
+        {65535, 32768, 32768}
+    }), TestSuite::Compare::Container);
+}
+
+void QuantizeTest::normalsTangentsBitangents() {
+    const struct Vertex {
+        Vector3 normal;
+        Vector4 tangent;
+        Vector3 tangent3;
+        Vector3 bitangent;
+    } vertices[]{
+        {{0.0f, 0.0f, 1.0f}, {1.0f, 0.0f, 0.0f, -1.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}},
+        {{0.0f, -1.0f, 0.0f}, {0.0f, 0.0f, 1.0f, 1.0f}, {0.0f, 0.0f, -1.0f}, {-1.0f, 0.0f, 0.0f}}
+    };
+    const Containers::StridedArrayView1D<const Vertex> view = vertices;
+    Trade::MeshData mesh{MeshPrimitive::Points, {}, vertices, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Normal, view.slice(&Vertex::normal)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Tangent, view.slice(&Vertex::tangent)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Tangent, view.slice(&Vertex::tangent3)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Bitangent, view.slice(&Vertex::bitangent)}
+    }};
+
+    Containers::Pair<Trade::MeshData, Matrix4> out = MeshTools::quantize(mesh);
+    CORRADE_COMPARE(out.second(), Matrix4{});
+    CORRADE_COMPARE(out.first().attributeFormat(0), VertexFormat::Vector3sNormalized);
+    CORRADE_COMPARE(out.first().attributeFormat(1), VertexFormat::Vector4sNormalized);
+    CORRADE_COMPARE(out.first().attributeFormat(2), VertexFormat::Vector3sNormalized);
+    CORRADE_COMPARE(out.first().attributeFormat(3), VertexFormat::Vector3sNormalized);
+    CORRADE_COMPARE_AS(out.first().attribute<Vector3s>(0), Containers::arrayView<Vector3s>({
+        {0, 0, 32767},
+        {0, -32767, 0}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.first().attribute<Vector4s>(1), Containers::arrayView<Vector4s>({
+        {32767, 0, 0, -32767},
+        {0, 0, 32767, 32767}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.first().attribute<Vector3s>(2), Containers::arrayView<Vector3s>({
+        {32767, 0, 0},
+        {0, 0, -32767}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.first().attribute<Vector3s>(3), Containers::arrayView<Vector3s>({
+        {0, 32767, 0},
+        {-32767, 0, 0}
+    }), TestSuite::Compare::Container);
+
+    /* The convenience accessors unpack them back */
+    CORRADE_COMPARE_AS(out.first().bitangentSignsAsArray(), Containers::arrayView({
+        -1.0f, 1.0f
+    }), TestSuite::Compare::Container);
+}
+
+void QuantizeTest::textureCoordinates() {
+    const struct Vertex {
+        Vector2 unsignedCoordinates;
+        Vector2 signedCoordinates;
+        Vector2 repeatedCoordinates;
+    } vertices[]{
+        {{0.0f, 0.5f}, {-1.0f, 0.5f}, {0.0f, 0.0f}},
+        {{1.0f, 0.25f}, {0.0f, 1.0f}, {2.0f, -1.0f}}
+    };
+    const Containers::StridedArrayView1D<const Vertex> view = vertices;
+    Trade::MeshData mesh{MeshPrimitive::Points, {}, vertices, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::TextureCoordinates, view.slice(&Vertex::unsignedCoordinates)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::TextureCoordinates, view.slice(&Vertex::signedCoordinates)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::TextureCoordinates, view.slice(&Vertex::repeatedCoordinates)}
+    }};
+
+    Containers::Pair<Trade::MeshData, Matrix4> out = MeshTools::quantize(mesh);
+    CORRADE_COMPARE(out.first().attributeFormat(0), VertexFormat::Vector2usNormalized);
+    CORRADE_COMPARE(out.first().attributeFormat(1), VertexFormat::Vector2sNormalized);
+    /* Can't be represented without a transformation, kept as-is */
+    CORRADE_COMPARE(out.first().attributeFormat(2), VertexFormat::Vector2);
+    CORRADE_COMPARE_AS(out.first().attribute<Vector2us>(0), Containers::arrayView<Vector2us>({
+        {0, 32768},
+        {65535, 16384}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.first().attribute<Vector2s>(1), Containers::arrayView<Vector2s>({
+        {-32767, 16384},
+        {0, 32767}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.first().attribute<Vector2>(2), view.slice(&Vertex::repeatedCoordinates),
+        TestSuite::Compare::Container);
+}
+
+void QuantizeTest::passthrough() {
+    const struct Vertex {
+        Vector3s normal;
+        Color4ub color;
+        Vector3d custom;
+    } vertices[]{
+        {{0, 0, 32767}, 0xff3366cc_rgba, {1.0, 2.0, 3.0}},
+        {{32767, 0, 0}, 0x336699ff_rgba, {4.0, 5.0, 6.0}}
+    };
+    const Containers::StridedArrayView1D<const Vertex> view = vertices;
+    const UnsignedShort indices[]{1, 0, 1};
+    Trade::MeshData mesh{MeshPrimitive::Points,
+        {}, indices, Trade::MeshIndexData{indices},
+        {}, vertices, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Normal, VertexFormat::Vector3sNormalized, view.slice(&Vertex::normal)},
+            Trade::MeshAttributeData{Trade::MeshAttribute::Color, view.slice(&Vertex::color)},
+            Trade::MeshAttributeData{Trade::meshAttributeCustom(3), view.slice(&Vertex::custom)}
+        }};
+
+    /* Already packed or unknown attributes are kept as-is, index buffer is
+       copied */
+    Containers::Pair<Trade::MeshData, Matrix4> out = MeshTools::quantize(mesh);
+    CORRADE_VERIFY(out.first().isIndexed());
+    CORRADE_COMPARE(out.first().indexType(), MeshIndexType::UnsignedShort);
+    CORRADE_COMPARE_AS(out.first().indices<UnsignedShort>(), Containers::arrayView(indices),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(out.first().attributeFormat(0), VertexFormat::Vector3sNormalized);
+    CORRADE_COMPARE(out.first().attributeFormat(1), VertexFormat::Vector4ubNormalized);
+    CORRADE_COMPARE(out.first().attributeFormat(2), VertexFormat::Vector3d);
+    CORRADE_COMPARE_AS(out.first().attribute<Vector3s>(0), view.slice(&Vertex::normal),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.first().attribute<Color4ub>(1), view.slice(&Vertex::color),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.first().attribute<Vector3d>(2), view.slice(&Vertex::custom),
+        TestSuite::Compare::Container);
+}
+
+void QuantizeTest::noPositions() {
+    Trade::MeshData mesh{MeshPrimitive::Triangles, 3};
+
+    Containers::Pair<Trade::MeshData, Matrix4> out = MeshTools::quantize(mesh);
+    CORRADE_COMPARE(out.first().vertexCount(), 3);
+    CORRADE_COMPARE(out.first().attributeCount(), 0);
+    CORRADE_COMPARE(out.second(), Matrix4{});
+}
+
+void QuantizeTest::vertexSize() {
+    const struct Vertex {
+        Vector3 position;
+        Vector3 normal;
+        Vector2 textureCoordinates;
+    } vertices[]{
+        {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f}},
+        {{1.0f, 1.0f, 1.0f}, {0.0f, 1.0f, 0.0f}, {1.0f, 1.0f}}
+    };
+    const Containers::StridedArrayView1D<const Vertex> view = vertices;
+    Trade::MeshData mesh{MeshPrimitive::Points, {}, vertices, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position, view.slice(&Vertex::position)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Normal, view.slice(&Vertex::normal)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::TextureCoordinates, view.slice(&Vertex::textureCoordinates)}
+    }};
+    CORRADE_COMPARE(mesh.attributeStride(0), 32);
+
+    /* Half the size, tightly packed */
+    Containers::Pair<Trade::MeshData, Matrix4> out = MeshTools::quantize(mesh);
+    CORRADE_COMPARE(out.first().attributeStride(0), 16);
+    CORRADE_COMPARE(out.first().attributeOffset(0), 0);
+    CORRADE_COMPARE(out.first().attributeOffset(1), 6);
+    CORRADE_COMPARE(out.first().attributeOffset(2), 12);
+    CORRADE_COMPARE(out.first().vertexData().size(), 32);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::QuantizeTest)
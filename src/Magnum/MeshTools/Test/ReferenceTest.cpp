@@ -33,6 +33,7 @@
 #include "Magnum/Primitives/Cube.h"
 #include "Magnum/Primitives/Gradient.h"
 #include "Magnum/Primitives/Grid.h"
+#include "Magnum/Trade/DataArena.h"
 #include "Magnum/Trade/MeshData.h"
 #include <Magnum/Primitives/Circle.h>
 
@@ -60,6 +61,7 @@ struct ReferenceTest: TestSuite::Tester {
     void ownedImplementationSpecificVertexFormat();
     void ownedRvaluePassthrough();
     void ownedRvaluePartialPassthrough();
+    void ownedArena();
 };
 
 struct {
@@ -92,7 +94,8 @@ ReferenceTest::ReferenceTest() {
     addTests({&ReferenceTest::ownedArrayAttribute,
               &ReferenceTest::ownedImplementationSpecificVertexFormat,
               &ReferenceTest::ownedRvaluePassthrough,
-              &ReferenceTest::ownedRvaluePartialPassthrough});
+              &ReferenceTest::ownedRvaluePartialPassthrough,
+              &ReferenceTest::ownedArena});
 }
 
 void ReferenceTest::reference() {
@@ -397,6 +400,42 @@ void ReferenceTest::ownedRvaluePartialPassthrough() {
     CORRADE_VERIFY(owned.attributeData() != attributeData);
 }
 
+void ReferenceTest::ownedArena() {
+    Trade::MeshData cube = Primitives::cubeSolid();
+    Trade::DataArena arena;
+
+    {
+        Trade::MeshData owned = MeshTools::owned(cube, arena);
+        CORRADE_VERIFY(owned.isIndexed());
+        CORRADE_COMPARE(owned.primitive(), cube.primitive());
+        CORRADE_COMPARE(owned.indexDataFlags(), Trade::DataFlag::Mutable|Trade::DataFlag::Owned);
+        CORRADE_COMPARE(owned.vertexDataFlags(), Trade::DataFlag::Mutable|Trade::DataFlag::Owned);
+        CORRADE_COMPARE(owned.indexCount(), cube.indexCount());
+        CORRADE_COMPARE(owned.indexType(), cube.indexType());
+        CORRADE_COMPARE(owned.vertexCount(), cube.vertexCount());
+        CORRADE_COMPARE(owned.attributeCount(), cube.attributeCount());
+        for(std::size_t i = 0; i != cube.attributeCount(); ++i) {
+            CORRADE_ITERATION(i);
+            CORRADE_COMPARE(owned.attributeName(i), cube.attributeName(i));
+            CORRADE_COMPARE(owned.attributeFormat(i), cube.attributeFormat(i));
+            CORRADE_COMPARE(owned.attributeOffset(i), cube.attributeOffset(i));
+            CORRADE_COMPARE(owned.attributeStride(i), cube.attributeStride(i));
+        }
+
+        CORRADE_COMPARE_AS(owned.indexData(), cube.indexData(), TestSuite::Compare::Container);
+        CORRADE_COMPARE_AS(owned.vertexData(), cube.vertexData(), TestSuite::Compare::Container);
+
+        /* Both index and vertex data come from the arena */
+        CORRADE_COMPARE(arena.allocationCount(), 2);
+        Containers::Array<char> indexData = owned.releaseIndexData();
+        Containers::Array<char> vertexData = owned.releaseVertexData();
+        CORRADE_VERIFY(indexData.deleter() == Trade::DataArena::deleter);
+        CORRADE_VERIFY(vertexData.deleter() == Trade::DataArena::deleter);
+    }
+
+    CORRADE_COMPARE(arena.allocationCount(), 0);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::ReferenceTest)
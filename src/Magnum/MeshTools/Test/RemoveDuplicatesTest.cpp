@@ -29,6 +29,7 @@
 #include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/DebugStl.h>
 
 #include "Magnum/Math/Vector3.h"
@@ -44,6 +45,15 @@ struct RemoveDuplicatesTest: TestSuite::Tester {
     void removeDuplicates();
     void removeDuplicatesNonContiguous();
     void removeDuplicatesIntoWrongOutputSize();
+    void removeDuplicatesManyUnique();
+    void removeDuplicatesMultithreaded();
+
+    void removeDuplicatesRadix();
+    void removeDuplicatesRadixEmpty();
+    void removeDuplicatesRadixNonContiguous();
+    void removeDuplicatesRadixIntoWrongOutputSize();
+    void removeDuplicatesRadixManyUnique();
+    void removeDuplicatesRadixIndexTuples();
 
     template<class T> void removeDuplicatesIndexedInPlace();
     void removeDuplicatesIndexedInPlaceSmallType();
@@ -68,6 +78,13 @@ struct RemoveDuplicatesTest: TestSuite::Tester {
     void removeDuplicatesFuzzyIndexedInPlaceErasedNonContiguous();
     void removeDuplicatesFuzzyIndexedInPlaceErasedWrongIndexSize();
 
+    void removeDuplicatesSpatialInPlace();
+    void removeDuplicatesSpatialInPlace2D();
+    void removeDuplicatesSpatialInPlaceScratchMemoryBudget();
+    void removeDuplicatesSpatialInPlaceEmpty();
+    void removeDuplicatesSpatialInPlaceIntoWrongOutputSize();
+    void removeDuplicatesSpatialInPlaceInvalidEpsilon();
+
     /* this is additionally regression-tested in PrimitivesIcosphereTest */
 
     void removeDuplicatesMeshData();
@@ -81,14 +98,26 @@ struct RemoveDuplicatesTest: TestSuite::Tester {
     void removeDuplicatesMeshDataFuzzyAttributeless();
     void removeDuplicatesMeshDataFuzzyImplementationSpecificIndexType();
     void removeDuplicatesMeshDataFuzzyImplementationSpecificVertexFormat();
+    void removeDuplicatesMeshDataFuzzySpatialPositions();
 
     void soakTest();
+    void soakTestRadix();
     void soakTestFuzzy();
 
     void benchmark();
+    void benchmarkRadix();
     void benchmarkFuzzy();
 };
 
+const struct {
+    const char* name;
+    UnsignedInt threadCount;
+} MultithreadedData[] {
+    {"all threads", 0},
+    {"two threads", 2},
+    {"five threads", 5}
+};
+
 const struct {
     const char* name;
     bool indexed;
@@ -169,6 +198,18 @@ RemoveDuplicatesTest::RemoveDuplicatesTest() {
     addTests({&RemoveDuplicatesTest::removeDuplicates,
               &RemoveDuplicatesTest::removeDuplicatesNonContiguous,
               &RemoveDuplicatesTest::removeDuplicatesIntoWrongOutputSize,
+              &RemoveDuplicatesTest::removeDuplicatesManyUnique});
+
+    addInstancedTests({&RemoveDuplicatesTest::removeDuplicatesMultithreaded},
+        Containers::arraySize(MultithreadedData));
+
+    addTests({&RemoveDuplicatesTest::removeDuplicatesRadix,
+              &RemoveDuplicatesTest::removeDuplicatesRadixEmpty,
+              &RemoveDuplicatesTest::removeDuplicatesRadixNonContiguous,
+              &RemoveDuplicatesTest::removeDuplicatesRadixIntoWrongOutputSize,
+              &RemoveDuplicatesTest::removeDuplicatesRadixManyUnique,
+              &RemoveDuplicatesTest::removeDuplicatesRadixIndexTuples,
+
               &RemoveDuplicatesTest::removeDuplicatesIndexedInPlace<UnsignedByte>,
               &RemoveDuplicatesTest::removeDuplicatesIndexedInPlace<UnsignedShort>,
               &RemoveDuplicatesTest::removeDuplicatesIndexedInPlace<UnsignedInt>,
@@ -207,7 +248,14 @@ RemoveDuplicatesTest::RemoveDuplicatesTest() {
               &RemoveDuplicatesTest::removeDuplicatesFuzzyIndexedInPlaceErased<UnsignedInt, Float>,
               &RemoveDuplicatesTest::removeDuplicatesFuzzyIndexedInPlaceErased<UnsignedInt, Double>,
               &RemoveDuplicatesTest::removeDuplicatesFuzzyIndexedInPlaceErasedNonContiguous,
-              &RemoveDuplicatesTest::removeDuplicatesFuzzyIndexedInPlaceErasedWrongIndexSize});
+              &RemoveDuplicatesTest::removeDuplicatesFuzzyIndexedInPlaceErasedWrongIndexSize,
+
+              &RemoveDuplicatesTest::removeDuplicatesSpatialInPlace,
+              &RemoveDuplicatesTest::removeDuplicatesSpatialInPlace2D,
+              &RemoveDuplicatesTest::removeDuplicatesSpatialInPlaceScratchMemoryBudget,
+              &RemoveDuplicatesTest::removeDuplicatesSpatialInPlaceEmpty,
+              &RemoveDuplicatesTest::removeDuplicatesSpatialInPlaceIntoWrongOutputSize,
+              &RemoveDuplicatesTest::removeDuplicatesSpatialInPlaceInvalidEpsilon});
 
     addInstancedTests({&RemoveDuplicatesTest::removeDuplicatesMeshData},
         Containers::arraySize(RemoveDuplicatesMeshDataData));
@@ -225,12 +273,15 @@ RemoveDuplicatesTest::RemoveDuplicatesTest() {
 
               &RemoveDuplicatesTest::removeDuplicatesMeshDataFuzzyAttributeless,
               &RemoveDuplicatesTest::removeDuplicatesMeshDataFuzzyImplementationSpecificIndexType,
-              &RemoveDuplicatesTest::removeDuplicatesMeshDataFuzzyImplementationSpecificVertexFormat});
+              &RemoveDuplicatesTest::removeDuplicatesMeshDataFuzzyImplementationSpecificVertexFormat,
+              &RemoveDuplicatesTest::removeDuplicatesMeshDataFuzzySpatialPositions});
 
     addRepeatedTests({&RemoveDuplicatesTest::soakTest,
+                      &RemoveDuplicatesTest::soakTestRadix,
                       &RemoveDuplicatesTest::soakTestFuzzy}, 10);
 
     addBenchmarks({&RemoveDuplicatesTest::benchmark,
+                   &RemoveDuplicatesTest::benchmarkRadix,
                    &RemoveDuplicatesTest::benchmarkFuzzy}, 10);
 }
 
@@ -286,6 +337,164 @@ void RemoveDuplicatesTest::removeDuplicatesIntoWrongOutputSize() {
         "MeshTools::removeDuplicatesInPlaceInto(): output index array has 7 elements but expected 8\n");
 }
 
+void RemoveDuplicatesTest::removeDuplicatesManyUnique() {
+    /* Enough unique items to have the hash table probing go over many
+       collisions. The output should point to first occurrences in both
+       variants. */
+    UnsignedInt data[10000];
+    for(std::size_t i = 0; i != Containers::arraySize(data); ++i)
+        data[i] = i % 3001;
+
+    UnsignedInt expected[Containers::arraySize(data)];
+    for(std::size_t i = 0; i != Containers::arraySize(data); ++i)
+        expected[i] = i % 3001;
+
+    std::pair<Containers::Array<UnsignedInt>, std::size_t> result = MeshTools::removeDuplicates(Containers::arrayCast<2, const char>(Containers::arrayView(data)));
+    CORRADE_COMPARE(result.second, 3001);
+    CORRADE_COMPARE_AS(result.first,
+        Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+
+    result = MeshTools::removeDuplicatesInPlace(Containers::arrayCast<2, char>(Containers::arrayView(data)));
+    CORRADE_COMPARE(result.second, 3001);
+    CORRADE_COMPARE_AS(result.first,
+        Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(data).prefix(3001),
+        Containers::arrayView(expected).prefix(3001),
+        TestSuite::Compare::Container);
+}
+
+void RemoveDuplicatesTest::removeDuplicatesMultithreaded() {
+    auto&& data = MultithreadedData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Enough items for the data to be partitioned even with five threads,
+       with duplicates scattered all over. The output should be exactly the
+       same as with a single thread. */
+    Containers::Array<UnsignedInt> input{NoInit, 100000};
+    for(std::size_t i = 0; i != input.size(); ++i)
+        input[i] = (i*7919) % 30011;
+
+    std::pair<Containers::Array<UnsignedInt>, std::size_t> expected = MeshTools::removeDuplicates(Containers::arrayCast<2, const char>(Containers::arrayView(input)), 1);
+    CORRADE_COMPARE(expected.second, 30011);
+
+    std::pair<Containers::Array<UnsignedInt>, std::size_t> result = MeshTools::removeDuplicates(Containers::arrayCast<2, const char>(Containers::arrayView(input)), data.threadCount);
+    CORRADE_COMPARE(result.second, expected.second);
+    CORRADE_COMPARE_AS(result.first,
+        expected.first,
+        TestSuite::Compare::Container);
+
+    Containers::Array<UnsignedInt> expectedInPlaceData{NoInit, input.size()};
+    Utility::copy(input, expectedInPlaceData);
+    std::pair<Containers::Array<UnsignedInt>, std::size_t> expectedInPlace = MeshTools::removeDuplicatesInPlace(Containers::arrayCast<2, char>(Containers::arrayView(expectedInPlaceData)), 1);
+    CORRADE_COMPARE(expectedInPlace.second, 30011);
+
+    Containers::Array<UnsignedInt> inPlaceData{NoInit, input.size()};
+    Utility::copy(input, inPlaceData);
+    std::pair<Containers::Array<UnsignedInt>, std::size_t> inPlace = MeshTools::removeDuplicatesInPlace(Containers::arrayCast<2, char>(Containers::arrayView(inPlaceData)), data.threadCount);
+    CORRADE_COMPARE(inPlace.second, expectedInPlace.second);
+    CORRADE_COMPARE_AS(inPlace.first,
+        expectedInPlace.first,
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(inPlaceData.prefix(inPlace.second),
+        expectedInPlaceData.prefix(expectedInPlace.second),
+        TestSuite::Compare::Container);
+}
+
+void RemoveDuplicatesTest::removeDuplicatesRadix() {
+    Int data[]{-15, 32, 24, -15, 15, 7541, 24, 32};
+
+    /* Same output as removeDuplicatesInPlace() */
+    std::pair<Containers::Array<UnsignedInt>, std::size_t> result =
+        MeshTools::removeDuplicatesRadixInPlace(Containers::arrayCast<2, char>(Containers::arrayView(data)));
+    CORRADE_COMPARE(result.second, 5);
+    CORRADE_COMPARE_AS(Containers::arrayView(result.first),
+        Containers::arrayView<UnsignedInt>({0, 1, 2, 0, 3, 4, 2, 1}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(data).prefix(result.second),
+        Containers::arrayView<Int>({-15, 32, 24, 15, 7541}),
+        TestSuite::Compare::Container);
+}
+
+void RemoveDuplicatesTest::removeDuplicatesRadixEmpty() {
+    std::pair<Containers::Array<UnsignedInt>, std::size_t> result =
+        MeshTools::removeDuplicatesRadixInPlace(Containers::StridedArrayView2D<char>{});
+    CORRADE_COMPARE(result.second, 0);
+    CORRADE_COMPARE(result.first.size(), 0);
+}
+
+void RemoveDuplicatesTest::removeDuplicatesRadixNonContiguous() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Int data[8]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::removeDuplicatesRadixInPlace(Containers::arrayCast<2, char>(Containers::arrayView(data)).every({1, 2}));
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::removeDuplicatesRadixInPlaceInto(): second data view dimension is not contiguous\n");
+}
+
+void RemoveDuplicatesTest::removeDuplicatesRadixIntoWrongOutputSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Int data[8]{};
+    UnsignedInt output[7];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::removeDuplicatesRadixInPlaceInto(
+        Containers::arrayCast<2, char>(Containers::arrayView(data)),
+        output);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::removeDuplicatesRadixInPlaceInto(): output index array has 7 elements but expected 8\n");
+}
+
+void RemoveDuplicatesTest::removeDuplicatesRadixManyUnique() {
+    /* Values spanning more than one byte so more than one sort pass is
+       done. The output should point to first occurrences. */
+    UnsignedInt data[10000];
+    for(std::size_t i = 0; i != Containers::arraySize(data); ++i)
+        data[i] = i % 3001;
+
+    UnsignedInt expected[Containers::arraySize(data)];
+    for(std::size_t i = 0; i != Containers::arraySize(data); ++i)
+        expected[i] = i % 3001;
+
+    std::pair<Containers::Array<UnsignedInt>, std::size_t> result = MeshTools::removeDuplicatesRadixInPlace(Containers::arrayCast<2, char>(Containers::arrayView(data)));
+    CORRADE_COMPARE(result.second, 3001);
+    CORRADE_COMPARE_AS(result.first,
+        Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(data).prefix(3001),
+        Containers::arrayView(expected).prefix(3001),
+        TestSuite::Compare::Container);
+}
+
+void RemoveDuplicatesTest::removeDuplicatesRadixIndexTuples() {
+    /* Shuffled position / normal / texture coordinate index triplets like
+       in an OBJ file. The result should be exactly the same as with the
+       hash-based variant. */
+    Vector3ui data[3000];
+    for(std::size_t i = 0; i != Containers::arraySize(data); ++i)
+        data[i] = {UnsignedInt(i % 701), UnsignedInt(i % 13)*1000, UnsignedInt(i % 7)};
+    std::shuffle(std::begin(data), std::end(data), std::minstd_rand{});
+
+    Vector3ui dataRadix[Containers::arraySize(data)];
+    Utility::copy(data, dataRadix);
+
+    std::pair<Containers::Array<UnsignedInt>, std::size_t> expected = MeshTools::removeDuplicatesInPlace(Containers::arrayCast<2, char>(Containers::arrayView(data)));
+    std::pair<Containers::Array<UnsignedInt>, std::size_t> result = MeshTools::removeDuplicatesRadixInPlace(Containers::arrayCast<2, char>(Containers::arrayView(dataRadix)));
+    CORRADE_COMPARE(result.second, expected.second);
+    CORRADE_COMPARE_AS(result.first,
+        expected.first,
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(dataRadix).prefix(result.second),
+        Containers::arrayView(data).prefix(expected.second),
+        TestSuite::Compare::Container);
+}
+
 template<class T> void RemoveDuplicatesTest::removeDuplicatesIndexedInPlace() {
     setTestCaseTemplateName(Math::TypeTraits<T>::name());
 
@@ -601,6 +810,97 @@ void RemoveDuplicatesTest::removeDuplicatesFuzzyIndexedInPlaceErasedWrongIndexSi
         "MeshTools::removeDuplicatesFuzzyIndexedInPlace(): expected index type size 1, 2 or 4 but got 3\n");
 }
 
+/* The second and third position are in neighboring cells with the 0.1
+   epsilon, but should still get merged together. The second is however too
+   far from the first. */
+const Vector3 SpatialPositions[]{
+    {0.0f, 0.0f, 0.0f},
+    {0.1999f, 0.0f, 0.0f},
+    {0.2001f, 0.0f, 0.0f},
+    {1.0f, 1.0f, 1.0f},
+    {0.05f, 0.0f, 0.0f},
+    {1.05f, 1.0f, 1.0f},
+    {3.0f, 3.0f, 3.0f}
+};
+
+void RemoveDuplicatesTest::removeDuplicatesSpatialInPlace() {
+    Vector3 positions[Containers::arraySize(SpatialPositions)];
+    Utility::copy(SpatialPositions, positions);
+
+    std::pair<Containers::Array<UnsignedInt>, std::size_t> result = MeshTools::removeDuplicatesSpatialInPlace(Containers::stridedArrayView(positions), 0.1f);
+    CORRADE_COMPARE_AS(result.first, Containers::arrayView<UnsignedInt>({
+        0, 1, 1, 2, 0, 2, 3
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(positions).prefix(result.second),
+        Containers::arrayView<Vector3>({
+            {0.0f, 0.0f, 0.0f},
+            {0.1999f, 0.0f, 0.0f},
+            {1.0f, 1.0f, 1.0f},
+            {3.0f, 3.0f, 3.0f}
+        }), TestSuite::Compare::Container);
+}
+
+void RemoveDuplicatesTest::removeDuplicatesSpatialInPlace2D() {
+    Vector2 positions[Containers::arraySize(SpatialPositions)];
+    for(std::size_t i = 0; i != Containers::arraySize(SpatialPositions); ++i)
+        positions[i] = SpatialPositions[i].xy();
+
+    UnsignedInt indices[Containers::arraySize(SpatialPositions)];
+    CORRADE_COMPARE(MeshTools::removeDuplicatesSpatialInPlaceInto(Containers::stridedArrayView(positions), indices, 0.1f), 4);
+    CORRADE_COMPARE_AS(Containers::arrayView(indices), Containers::arrayView<UnsignedInt>({
+        0, 1, 1, 2, 0, 2, 3
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(positions).prefix(4),
+        Containers::arrayView<Vector2>({
+            {0.0f, 0.0f},
+            {0.1999f, 0.0f},
+            {1.0f, 1.0f},
+            {3.0f, 3.0f}
+        }), TestSuite::Compare::Container);
+}
+
+void RemoveDuplicatesTest::removeDuplicatesSpatialInPlaceScratchMemoryBudget() {
+    Vector3 positions[Containers::arraySize(SpatialPositions)];
+    Utility::copy(SpatialPositions, positions);
+
+    /* With a budget this small there's just a single bucket, the output
+       should be still the same */
+    UnsignedInt indices[Containers::arraySize(SpatialPositions)];
+    CORRADE_COMPARE(MeshTools::removeDuplicatesSpatialInPlaceInto(Containers::stridedArrayView(positions), indices, 0.1f, 4), 4);
+    CORRADE_COMPARE_AS(Containers::arrayView(indices), Containers::arrayView<UnsignedInt>({
+        0, 1, 1, 2, 0, 2, 3
+    }), TestSuite::Compare::Container);
+}
+
+void RemoveDuplicatesTest::removeDuplicatesSpatialInPlaceEmpty() {
+    CORRADE_COMPARE(MeshTools::removeDuplicatesSpatialInPlace(Containers::StridedArrayView1D<Vector3>{}, 0.1f).second, 0);
+}
+
+void RemoveDuplicatesTest::removeDuplicatesSpatialInPlaceIntoWrongOutputSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Vector3 positions[3];
+    UnsignedInt indices[2];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::removeDuplicatesSpatialInPlaceInto(Containers::stridedArrayView(positions), indices, 0.1f);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::removeDuplicatesSpatialInPlaceInto(): output index array has 2 elements but expected 3\n");
+}
+
+void RemoveDuplicatesTest::removeDuplicatesSpatialInPlaceInvalidEpsilon() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Vector3 positions[3];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::removeDuplicatesSpatialInPlace(Containers::stridedArrayView(positions), 0.0f);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::removeDuplicatesSpatialInPlaceInto(): expected a positive epsilon but got 0\n");
+}
+
 void RemoveDuplicatesTest::removeDuplicatesMeshData() {
     auto&& data = RemoveDuplicatesMeshDataData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
@@ -1176,6 +1476,28 @@ void RemoveDuplicatesTest::removeDuplicatesMeshDataFuzzyImplementationSpecificVe
         "MeshTools::removeDuplicatesFuzzy(): attribute 1 has an implementation-specific format 0xcaca\n");
 }
 
+void RemoveDuplicatesTest::removeDuplicatesMeshDataFuzzySpatialPositions() {
+    const Trade::MeshData mesh{MeshPrimitive::Points, {}, SpatialPositions, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(SpatialPositions)}
+    }};
+
+    /* The range is 3, so this makes the epsilon 0.1 */
+    Trade::MeshData unique = MeshTools::removeDuplicatesFuzzy(mesh, RemoveDuplicatesFuzzyFlag::SpatialPositions, 0.1f/3.0f);
+    CORRADE_COMPARE(unique.primitive(), MeshPrimitive::Points);
+    CORRADE_VERIFY(unique.isIndexed());
+    CORRADE_COMPARE(unique.indexType(), MeshIndexType::UnsignedInt);
+    CORRADE_COMPARE_AS(unique.indices<UnsignedInt>(), Containers::arrayView<UnsignedInt>({
+        0, 1, 1, 2, 0, 2, 3
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(unique.attribute<Vector3>(Trade::MeshAttribute::Position),
+        Containers::arrayView<Vector3>({
+            {0.0f, 0.0f, 0.0f},
+            {0.1999f, 0.0f, 0.0f},
+            {1.0f, 1.0f, 1.0f},
+            {3.0f, 3.0f, 3.0f}
+        }), TestSuite::Compare::Container);
+}
+
 void RemoveDuplicatesTest::soakTest() {
     /* Array of 100 unique items with 10 duplicates each, randomly shuffled */
     UnsignedInt data[1000];
@@ -1189,6 +1511,19 @@ void RemoveDuplicatesTest::soakTest() {
         ).second, 100);
 }
 
+void RemoveDuplicatesTest::soakTestRadix() {
+    /* Array of 100 unique items with 10 duplicates each, randomly shuffled */
+    UnsignedInt data[1000];
+    for(std::size_t i = 0; i != Containers::arraySize(data); ++i)
+        data[i] = i / 10 + testCaseRepeatId()*909091;
+    std::shuffle(std::begin(data), std::end(data), std::minstd_rand{std::random_device{}()});
+
+    CORRADE_COMPARE(MeshTools::removeDuplicatesRadixInPlace(
+        Containers::StridedArrayView2D<char>{
+            Containers::arrayCast<char>(Containers::arrayView(data)), {1000, 4}}
+        ).second, 100);
+}
+
 void RemoveDuplicatesTest::soakTestFuzzy() {
     /* Array of 100 unique items with 10 duplicates each, randomly shuffled */
     Float data[1000];
@@ -1218,6 +1553,23 @@ void RemoveDuplicatesTest::benchmark() {
     CORRADE_COMPARE(count, 100);
 }
 
+void RemoveDuplicatesTest::benchmarkRadix() {
+    /* Array of 100 unique items with 100 duplicates each, shuffled */
+    Vector3i data[10000];
+    for(std::size_t i = 0; i != Containers::arraySize(data); ++i)
+        data[i].x() = i/100;
+    std::shuffle(std::begin(data), std::end(data), std::minstd_rand{std::random_device{}()});
+
+    std::size_t count;
+    UnsignedInt indices[10000];
+    CORRADE_BENCHMARK(1)
+        count = MeshTools::removeDuplicatesRadixInPlaceInto(
+            Containers::arrayCast<2, char>(Containers::arrayView(data)),
+            indices);
+
+    CORRADE_COMPARE(count, 100);
+}
+
 void RemoveDuplicatesTest::benchmarkFuzzy() {
     /* Array of 100 unique items with 100 duplicates each, shuffled */
     Vector3 data[10000];
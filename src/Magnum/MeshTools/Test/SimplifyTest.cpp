@@ -0,0 +1,405 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/StringStl.h> /** @todo remove once Debug is stream-free */
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/TypeTraits.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/Simplify.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct SimplifyTest: TestSuite::Tester {
+    explicit SimplifyTest();
+
+    template<class T> void flat();
+    void targetIndexCount();
+    void targetIndexCountNotReached();
+    void ridge();
+    void seam();
+    void empty();
+
+    void wrongIndexCount();
+    void indexOutOfBounds();
+
+    void meshData();
+    void meshDataNotIndexed();
+    void meshDataInvalid();
+
+    void lods();
+    void lodsSingle();
+    void lodsInvalid();
+    void lodsMeshData();
+    void lodsMeshDataInvalid();
+};
+
+SimplifyTest::SimplifyTest() {
+    addTests({&SimplifyTest::flat<UnsignedInt>,
+              &SimplifyTest::flat<UnsignedShort>,
+              &SimplifyTest::flat<UnsignedByte>,
+              &SimplifyTest::targetIndexCount,
+              &SimplifyTest::targetIndexCountNotReached,
+              &SimplifyTest::ridge,
+              &SimplifyTest::seam,
+              &SimplifyTest::empty,
+
+              &SimplifyTest::wrongIndexCount,
+              &SimplifyTest::indexOutOfBounds,
+
+              &SimplifyTest::meshData,
+              &SimplifyTest::meshDataNotIndexed,
+              &SimplifyTest::meshDataInvalid,
+
+              &SimplifyTest::lods,
+              &SimplifyTest::lodsSingle,
+              &SimplifyTest::lodsInvalid,
+              &SimplifyTest::lodsMeshData,
+              &SimplifyTest::lodsMeshDataInvalid});
+}
+
+/* A 8x8 grid of quads in the XY plane, 81 vertices and 128 triangles. If
+   seam is set, vertices in the middle column are duplicated for the right
+   half of the grid, which makes them look like a border. */
+Containers::Array<Vector3> gridPositions(bool seam = false) {
+    Containers::Array<Vector3> positions;
+    for(Int y = 0; y != 9; ++y)
+        for(Int x = 0; x != 9; ++x)
+            arrayAppend(positions, Vector3{Float(x), Float(y), 0.0f});
+    if(seam) for(Int y = 0; y != 9; ++y)
+        arrayAppend(positions, Vector3{4.0f, Float(y), 0.0f});
+    return positions;
+}
+
+Containers::Array<UnsignedInt> gridIndices(bool seam = false) {
+    const auto vertex = [seam](UnsignedInt x, UnsignedInt y, UnsignedInt quadX) {
+        if(seam && x == 4 && quadX >= 4) return 81 + y;
+        return y*9 + x;
+    };
+
+    Containers::Array<UnsignedInt> indices;
+    for(UnsignedInt y = 0; y != 8; ++y) {
+        for(UnsignedInt x = 0; x != 8; ++x) {
+            const UnsignedInt a = vertex(x, y, x);
+            const UnsignedInt b = vertex(x + 1, y, x);
+            const UnsignedInt c = vertex(x, y + 1, x);
+            const UnsignedInt d = vertex(x + 1, y + 1, x);
+            arrayAppend(indices, {a, b, d, a, d, c});
+        }
+    }
+    return indices;
+}
+
+template<class T> Float area(const Containers::StridedArrayView1D<T>& indices, const Containers::StridedArrayView1D<const Vector3>& positions) {
+    Float area = 0.0f;
+    for(std::size_t i = 0; i != indices.size(); i += 3) {
+        const Vector3 a = positions[indices[i]];
+        area += Math::cross(positions[indices[i + 1]] - a, positions[indices[i + 2]] - a).length()*0.5f;
+    }
+    return area;
+}
+
+template<class T> void SimplifyTest::flat() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    const Containers::Array<Vector3> positions = gridPositions();
+    const Containers::Array<UnsignedInt> gridIndices_ = gridIndices();
+    Containers::Array<T> indices{NoInit, gridIndices_.size()};
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        indices[i] = gridIndices_[i];
+
+    /* All inner vertices are collapsed away, only the 32 border vertices
+       stay, which is 30 triangles */
+    const std::size_t count = MeshTools::simplifyInPlace(Containers::stridedArrayView(indices), positions, 0, 0.01f);
+    CORRADE_COMPARE(count, 90);
+
+    const Containers::StridedArrayView1D<const T> simplified = Containers::stridedArrayView(indices).prefix(count);
+    CORRADE_COMPARE(area(simplified, positions), 64.0f);
+
+    /* No triangle got flipped */
+    for(std::size_t i = 0; i != count; i += 3) {
+        CORRADE_ITERATION(i);
+        const Vector3 a = positions[simplified[i]];
+        CORRADE_COMPARE_AS(Math::cross(positions[simplified[i + 1]] - a, positions[simplified[i + 2]] - a).z(), 0.0f,
+            TestSuite::Compare::Greater);
+    }
+
+    /* All border vertices are still there */
+    bool referenced[81]{};
+    for(const T i: simplified) referenced[i] = true;
+    for(UnsignedInt y = 0; y != 9; ++y) {
+        for(UnsignedInt x = 0; x != 9; ++x) {
+            CORRADE_ITERATION(y*9 + x);
+            CORRADE_COMPARE(referenced[y*9 + x], x == 0 || x == 8 || y == 0 || y == 8);
+        }
+    }
+}
+
+void SimplifyTest::targetIndexCount() {
+    const Containers::Array<Vector3> positions = gridPositions();
+    Containers::Array<UnsignedInt> indices = gridIndices();
+
+    const std::size_t count = MeshTools::simplifyInPlace(Containers::stridedArrayView(indices), positions, 300, 0.01f);
+    CORRADE_COMPARE(count, 300);
+    CORRADE_COMPARE(area(Containers::stridedArrayView(indices).prefix(count), positions), 64.0f);
+}
+
+void SimplifyTest::targetIndexCountNotReached() {
+    const Containers::Array<Vector3> positions = gridPositions();
+    Containers::Array<UnsignedInt> indices = gridIndices();
+    const Containers::Array<UnsignedInt> expected = gridIndices();
+
+    /* The index count is already below the target, nothing changes */
+    const std::size_t count = MeshTools::simplifyInPlace(Containers::stridedArrayView(indices), positions, 1000, 0.01f);
+    CORRADE_COMPARE(count, 384);
+    CORRADE_COMPARE_AS(indices, expected, TestSuite::Compare::Container);
+}
+
+void SimplifyTest::ridge() {
+    /* Fold the grid along the middle column, the surface area should stay
+       the same as the collapses can't move the crease */
+    Containers::Array<Vector3> positions = gridPositions();
+    for(Vector3& i: positions)
+        i.z() = Math::abs(i.x() - 4.0f)*0.5f;
+    Containers::Array<UnsignedInt> indices = gridIndices();
+    const Float originalArea = area(Containers::stridedArrayView(indices), positions);
+
+    const std::size_t count = MeshTools::simplifyInPlace(Containers::stridedArrayView(indices), positions, 0, 0.01f);
+    CORRADE_COMPARE_AS(count, 384, TestSuite::Compare::Less);
+    /* Removing just the flat parts would result in 90 indices */
+    CORRADE_COMPARE_AS(count, 90, TestSuite::Compare::Greater);
+    CORRADE_COMPARE(area(Containers::stridedArrayView(indices).prefix(count), positions), originalArea);
+}
+
+void SimplifyTest::seam() {
+    const Containers::Array<Vector3> positions = gridPositions(true);
+    Containers::Array<UnsignedInt> indices = gridIndices(true);
+
+    const std::size_t count = MeshTools::simplifyInPlace(Containers::stridedArrayView(indices), positions, 0, 0.01f);
+    CORRADE_COMPARE_AS(count, 384, TestSuite::Compare::Less);
+    CORRADE_COMPARE(area(Containers::stridedArrayView(indices).prefix(count), positions), 64.0f);
+
+    /* Both copies of the seam vertices are still referenced */
+    bool referenced[90]{};
+    for(const UnsignedInt i: indices.prefix(count)) referenced[i] = true;
+    for(UnsignedInt y = 0; y != 9; ++y) {
+        CORRADE_ITERATION(y);
+        CORRADE_VERIFY(referenced[y*9 + 4]);
+        CORRADE_VERIFY(referenced[81 + y]);
+    }
+}
+
+void SimplifyTest::empty() {
+    CORRADE_COMPARE(MeshTools::simplifyInPlace(Containers::StridedArrayView1D<UnsignedInt>{}, nullptr, 0, 0.01f), 0);
+}
+
+void SimplifyTest::wrongIndexCount() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    UnsignedInt indices[4]{};
+    const Vector3 positions[1];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::simplifyInPlace(Containers::stridedArrayView(indices), positions, 0, 0.01f);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::simplifyInPlace(): index count 4 not divisible by 3\n");
+}
+
+void SimplifyTest::indexOutOfBounds() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    UnsignedInt indices[]{0, 1, 2, 1, 3, 2};
+    const Vector3 positions[3];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::simplifyInPlace(Containers::stridedArrayView(indices), positions, 0, 0.01f);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::simplifyInPlace(): index 3 out of bounds for 3 elements\n");
+}
+
+void SimplifyTest::meshData() {
+    const Containers::Array<Vector3> positions = gridPositions();
+    const Containers::Array<UnsignedInt> gridIndices_ = gridIndices();
+    /* Index type is expected to be converted to 32-bit */
+    Containers::Array<UnsignedShort> indices{NoInit, gridIndices_.size()};
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        indices[i] = gridIndices_[i];
+
+    Trade::MeshData mesh{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{Containers::stridedArrayView(indices)},
+        {}, positions, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(positions)}
+        }};
+
+    Trade::MeshData out = MeshTools::simplify(mesh, 0, 0.01f);
+    CORRADE_COMPARE(out.primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(out.indexType(), MeshIndexType::UnsignedInt);
+    CORRADE_COMPARE(out.indexCount(), 90);
+    /* The vertex data are copied */
+    CORRADE_COMPARE(out.vertexCount(), 81);
+    CORRADE_VERIFY(out.vertexData().data() != mesh.vertexData().data());
+    CORRADE_COMPARE(out.vertexDataFlags(), Trade::DataFlag::Owned|Trade::DataFlag::Mutable);
+    CORRADE_COMPARE(out.attribute<Vector3>(Trade::MeshAttribute::Position)[80], (Vector3{8.0f, 8.0f, 0.0f}));
+    CORRADE_COMPARE(area(out.indices<UnsignedInt>(), positions), 64.0f);
+}
+
+void SimplifyTest::meshDataNotIndexed() {
+    const Vector3 positions[]{
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {1.0f, 1.0f, 0.0f},
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 1.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f}
+    };
+    Trade::MeshData mesh{MeshPrimitive::Triangles, {}, positions, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(positions)}
+    }};
+
+    /* Each triangle has its own vertices, which means everything is a
+       border and nothing can be collapsed */
+    Trade::MeshData out = MeshTools::simplify(mesh, 0, 0.01f);
+    CORRADE_VERIFY(out.isIndexed());
+    CORRADE_COMPARE_AS(out.indices<UnsignedInt>(), Containers::arrayView<UnsignedInt>({
+        0, 1, 2, 3, 4, 5
+    }), TestSuite::Compare::Container);
+}
+
+void SimplifyTest::meshDataInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::simplify(Trade::MeshData{MeshPrimitive::Lines, 6}, 0, 0.01f);
+    MeshTools::simplify(Trade::MeshData{MeshPrimitive::Triangles, 6}, 0, 0.01f);
+    MeshTools::simplify(Trade::MeshData{MeshPrimitive::Triangles,
+        nullptr, Trade::MeshIndexData{meshIndexTypeWrap(0xcaca), Containers::StridedArrayView1D<const void>{}},
+        nullptr, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position, VertexFormat::Vector3, nullptr}
+        }}, 0, 0.01f);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::simplify(): expected a MeshPrimitive::Triangles mesh, got MeshPrimitive::Lines\n"
+        "MeshTools::simplify(): the mesh has no positions\n"
+        "MeshTools::simplify(): mesh has an implementation-specific index type 0xcaca\n");
+}
+
+void SimplifyTest::lods() {
+    const Containers::Array<Vector3> positions = gridPositions();
+    const Containers::Array<UnsignedInt> indices = gridIndices();
+
+    /* The last level can't go below 90 indices so the generation stops
+       before reaching the requested count */
+    const Containers::Array<Containers::Array<UnsignedInt>> lods = MeshTools::generateLods(Containers::stridedArrayView(indices), positions, 6, 0.5f, 0.01f);
+    CORRADE_COMPARE(lods.size(), 4);
+    CORRADE_COMPARE_AS(lods[0], indices, TestSuite::Compare::Container);
+    CORRADE_COMPARE(lods[1].size(), 192);
+    CORRADE_COMPARE(lods[2].size(), 96);
+    CORRADE_COMPARE(lods[3].size(), 90);
+    for(std::size_t i = 0; i != lods.size(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(area(Containers::stridedArrayView(lods[i]), positions), 64.0f);
+    }
+}
+
+void SimplifyTest::lodsSingle() {
+    const Containers::Array<Vector3> positions = gridPositions();
+    const Containers::Array<UnsignedInt> indices = gridIndices();
+
+    const Containers::Array<Containers::Array<UnsignedInt>> lods = MeshTools::generateLods(Containers::stridedArrayView(indices), positions, 1);
+    CORRADE_COMPARE(lods.size(), 1);
+    CORRADE_COMPARE_AS(lods[0], indices, TestSuite::Compare::Container);
+}
+
+void SimplifyTest::lodsInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::generateLods(Containers::StridedArrayView1D<const UnsignedInt>{}, nullptr, 0);
+    MeshTools::generateLods(Containers::StridedArrayView1D<const UnsignedInt>{}, nullptr, 3, 0.0f);
+    MeshTools::generateLods(Containers::StridedArrayView1D<const UnsignedInt>{}, nullptr, 3, 1.0f);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::generateLods(): expected at least one level\n"
+        "MeshTools::generateLods(): expected reduction factor to be in range (0, 1) but got 0\n"
+        "MeshTools::generateLods(): expected reduction factor to be in range (0, 1) but got 1\n");
+}
+
+void SimplifyTest::lodsMeshData() {
+    const Containers::Array<Vector3> positions = gridPositions();
+    const Containers::Array<UnsignedInt> indices = gridIndices();
+
+    Trade::MeshData mesh{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{Containers::stridedArrayView(indices)},
+        {}, positions, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(positions)}
+        }};
+
+    const Containers::Array<Trade::MeshData> lods = MeshTools::generateLods(mesh, 3);
+    CORRADE_COMPARE(lods.size(), 3);
+    CORRADE_COMPARE(lods[0].indexCount(), 384);
+    CORRADE_COMPARE(lods[1].indexCount(), 192);
+    CORRADE_COMPARE(lods[2].indexCount(), 96);
+    for(std::size_t i = 0; i != lods.size(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(lods[i].primitive(), MeshPrimitive::Triangles);
+        CORRADE_COMPARE(lods[i].indexType(), MeshIndexType::UnsignedInt);
+        /* All levels reference the original vertex data */
+        CORRADE_COMPARE(lods[i].vertexDataFlags(), Trade::DataFlags{});
+        CORRADE_COMPARE(lods[i].vertexData().data(), mesh.vertexData().data());
+        CORRADE_COMPARE(lods[i].vertexCount(), 81);
+        CORRADE_COMPARE(lods[i].attributeCount(), 1);
+    }
+}
+
+void SimplifyTest::lodsMeshDataInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::generateLods(Trade::MeshData{MeshPrimitive::Lines, 6}, 3);
+    MeshTools::generateLods(Trade::MeshData{MeshPrimitive::Triangles, 6}, 3);
+    MeshTools::generateLods(Trade::MeshData{MeshPrimitive::Triangles,
+        nullptr, Trade::MeshIndexData{meshIndexTypeWrap(0xcaca), Containers::StridedArrayView1D<const void>{}},
+        nullptr, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position, VertexFormat::Vector3, nullptr}
+        }}, 3);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::generateLods(): expected a MeshPrimitive::Triangles mesh, got MeshPrimitive::Lines\n"
+        "MeshTools::generateLods(): the mesh has no positions\n"
+        "MeshTools::generateLods(): mesh has an implementation-specific index type 0xcaca\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::SimplifyTest)
@@ -50,9 +50,26 @@ struct SubdivideTest: TestSuite::Tester {
     void subdivideInPlaceWrongIndexCount();
     void subdivideInPlaceSmallIndexType();
 
+    void subdivideShared();
+    void subdivideSharedWrongIndexCount();
+    void subdivideSharedInPlace();
+    void subdivideSharedInPlaceMatchesRemoveDuplicates();
+    void subdivideSharedInPlaceWrongIndexCount();
+    void subdivideSharedInPlaceTooSmallVertexArray();
+
     /* this is additionally regression-tested in PrimitivesIcosphereTest */
 
     void benchmark();
+    void benchmarkShared();
+};
+
+const struct {
+    const char* name;
+    UnsignedInt threadCount;
+} SharedMatchesRemoveDuplicatesData[]{
+    {"", 1},
+    {"all threads", 0},
+    {"three threads", 3}
 };
 
 typedef Math::Vector<1, Int> Vector1;
@@ -73,9 +90,20 @@ SubdivideTest::SubdivideTest() {
               &SubdivideTest::subdivideInPlace<UnsignedShort>,
               &SubdivideTest::subdivideInPlace<UnsignedInt>,
               &SubdivideTest::subdivideInPlaceWrongIndexCount,
-              &SubdivideTest::subdivideInPlaceSmallIndexType});
+              &SubdivideTest::subdivideInPlaceSmallIndexType,
+
+              &SubdivideTest::subdivideShared,
+              &SubdivideTest::subdivideSharedWrongIndexCount,
+              &SubdivideTest::subdivideSharedInPlace});
+
+    addInstancedTests({&SubdivideTest::subdivideSharedInPlaceMatchesRemoveDuplicates},
+        Containers::arraySize(SharedMatchesRemoveDuplicatesData));
 
-    addBenchmarks({&SubdivideTest::benchmark}, 4);
+    addTests({&SubdivideTest::subdivideSharedInPlaceWrongIndexCount,
+              &SubdivideTest::subdivideSharedInPlaceTooSmallVertexArray});
+
+    addBenchmarks({&SubdivideTest::benchmark,
+                   &SubdivideTest::benchmarkShared}, 4);
 }
 
 void SubdivideTest::subdivide() {
@@ -162,6 +190,118 @@ void SubdivideTest::subdivideInPlaceSmallIndexType() {
     CORRADE_COMPARE(out.str(), "MeshTools::subdivideInPlace(): a 1-byte index type is too small for 256 vertices\n");
 }
 
+void SubdivideTest::subdivideShared() {
+    auto positions = Containers::array<Vector1>({0, 2, 6, 8});
+    auto indices = Containers::array<UnsignedInt>({0, 1, 2, 1, 2, 3});
+    MeshTools::subdivideShared(indices, positions, interpolator1);
+
+    /* Compared to subdivide(), the 1-2 edge is shared and thus there's one
+       vertex less */
+    CORRADE_COMPARE_AS(indices, Containers::arrayView<UnsignedInt>({
+        4, 5, 6, 5, 7, 8, 0, 4, 6, 4, 1, 5, 6, 5, 2, 1, 5, 8, 5, 2, 7, 8, 7, 3
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(positions, Containers::arrayView<Vector1>({
+        0, 2, 6, 8, 1, 4, 3, 7, 5
+    }), TestSuite::Compare::Container);
+}
+
+void SubdivideTest::subdivideSharedWrongIndexCount() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::stringstream out;
+    Error redirectError{&out};
+
+    Containers::Array<Vector1> positions;
+    Containers::Array<UnsignedInt> indices{2};
+    MeshTools::subdivideShared(indices, positions, interpolator1);
+    CORRADE_COMPARE(out.str(), "MeshTools::subdivideShared(): index count is not divisible by 3\n");
+}
+
+void SubdivideTest::subdivideSharedInPlace() {
+    UnsignedInt indices[6*4]{0, 1, 2, 1, 2, 3, /* and 18 more */};
+    /* There's 5 unique edges, so 5 new vertices. The extra one at the end
+       isn't touched. */
+    Vector1 positions[4 + 5 + 1]{0, 2, 6, 8, 0, 0, 0, 0, 0, 42};
+    CORRADE_COMPARE(MeshTools::subdivideSharedInPlace(
+        Containers::stridedArrayView(indices),
+        Containers::stridedArrayView(positions), 4, interpolator1), 9);
+
+    CORRADE_COMPARE_AS(Containers::arrayView(indices),
+        Containers::arrayView<UnsignedInt>({4, 5, 6, 5, 7, 8, 0, 4, 6, 4, 1, 5, 6, 5, 2, 1, 5, 8, 5, 2, 7, 8, 7, 3}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(positions),
+        Containers::arrayView<Vector1>({0, 2, 6, 8, 1, 4, 3, 7, 5, 42}),
+        TestSuite::Compare::Container);
+}
+
+void SubdivideTest::subdivideSharedInPlaceMatchesRemoveDuplicates() {
+    auto&& data = SharedMatchesRemoveDuplicatesData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Trade::MeshData icosphere = Primitives::icosphereSolid(0);
+
+    /* Subdivide 5 times, which is enough to have more than one block of
+       edges and faces to distribute in the last iteration */
+    const std::size_t indexCount = icosphere.indexCount()*4*4*4*4*4;
+    const std::size_t vertexCount = icosphere.vertexCount() + (indexCount - icosphere.indexCount())/3;
+
+    Containers::Array<UnsignedInt> expectedIndices{NoInit, indexCount};
+    Containers::Array<Vector3> expectedPositions{NoInit, vertexCount};
+    Utility::copy(icosphere.indices<UnsignedInt>(), expectedIndices.prefix(icosphere.indexCount()));
+    Utility::copy(icosphere.attribute<Vector3>(Trade::MeshAttribute::Position), expectedPositions.prefix(icosphere.vertexCount()));
+    for(std::size_t i = 0; i != 5; ++i) {
+        const std::size_t iterationIndexCount = icosphere.indexCount()*(1 << (i + 1)*2);
+        const std::size_t iterationVertexCount = icosphere.vertexCount() + (iterationIndexCount - icosphere.indexCount())/3;
+        MeshTools::subdivideInPlace(expectedIndices.prefix(iterationIndexCount), Containers::stridedArrayView(expectedPositions).prefix(iterationVertexCount), interpolator3);
+    }
+    const std::size_t expectedVertexCount = MeshTools::removeDuplicatesIndexedInPlace(
+        Containers::stridedArrayView(expectedIndices),
+        Containers::arrayCast<2, char>(Containers::stridedArrayView(expectedPositions)));
+
+    Containers::Array<UnsignedInt> indices{NoInit, indexCount};
+    Containers::Array<Vector3> positions{NoInit, vertexCount};
+    Utility::copy(icosphere.indices<UnsignedInt>(), indices.prefix(icosphere.indexCount()));
+    Utility::copy(icosphere.attribute<Vector3>(Trade::MeshAttribute::Position), positions.prefix(icosphere.vertexCount()));
+    std::size_t actualVertexCount = icosphere.vertexCount();
+    for(std::size_t i = 0; i != 5; ++i) {
+        const std::size_t iterationIndexCount = icosphere.indexCount()*(1 << (i + 1)*2);
+        actualVertexCount = MeshTools::subdivideSharedInPlace(indices.prefix(iterationIndexCount), Containers::stridedArrayView(positions), actualVertexCount, interpolator3, data.threadCount);
+    }
+
+    CORRADE_COMPARE(actualVertexCount, expectedVertexCount);
+    CORRADE_COMPARE_AS(indices, expectedIndices,
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(positions.prefix(actualVertexCount),
+        expectedPositions.prefix(expectedVertexCount),
+        TestSuite::Compare::Container);
+}
+
+void SubdivideTest::subdivideSharedInPlaceWrongIndexCount() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::stringstream out;
+    Error redirectError{&out};
+
+    UnsignedInt indices[6*4 + 1]{0, 1, 2, 1, 2, 3, /* and 18+1 more */};
+    Vector1 positions[]{0};
+    MeshTools::subdivideSharedInPlace(Containers::stridedArrayView(indices),
+        Containers::stridedArrayView(positions), 1, interpolator1);
+    CORRADE_COMPARE(out.str(), "MeshTools::subdivideSharedInPlace(): can't divide 25 indices to four parts with each having triangle faces\n");
+}
+
+void SubdivideTest::subdivideSharedInPlaceTooSmallVertexArray() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::stringstream out;
+    Error redirectError{&out};
+
+    UnsignedInt indices[6*4]{0, 1, 2, 1, 2, 3, /* and 18 more */};
+    Vector1 positions[4 + 4]{0, 2, 6, 8};
+    MeshTools::subdivideSharedInPlace(Containers::stridedArrayView(indices),
+        Containers::stridedArrayView(positions), 4, interpolator1);
+    CORRADE_COMPARE(out.str(), "MeshTools::subdivideSharedInPlace(): expected at least 9 vertices but got 8\n");
+}
+
 void SubdivideTest::benchmark() {
     Trade::MeshData icosphere = Primitives::icosphereSolid(0);
 
@@ -180,6 +320,24 @@ void SubdivideTest::benchmark() {
     }
 }
 
+void SubdivideTest::benchmarkShared() {
+    Trade::MeshData icosphere = Primitives::icosphereSolid(0);
+
+    CORRADE_BENCHMARK(3) {
+        Containers::Array<UnsignedInt> indices;
+        arrayResize(indices, NoInit, icosphere.indexCount());
+        Utility::copy(icosphere.indices<UnsignedInt>(), indices);
+
+        Containers::Array<Vector3> positions;
+        arrayResize(positions, NoInit, icosphere.vertexCount());
+        Utility::copy(icosphere.attribute<Vector3>(Trade::MeshAttribute::Position), positions);
+
+        /* Subdivide 5 times */
+        for(std::size_t i = 0; i != 5; ++i)
+            MeshTools::subdivideShared(indices, positions, interpolator3);
+    }
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::SubdivideTest)
@@ -29,14 +29,55 @@
  * @brief Function @ref Magnum::MeshTools::transformVectorsInPlace(), @ref Magnum::MeshTools::transformVectors(), @ref Magnum::MeshTools::transformPointsInPlace(), @ref Magnum::MeshTools::transformPoints(), @ref Magnum::MeshTools::transform2D(), @ref Magnum::MeshTools::transform2DInPlace(), @ref Magnum::MeshTools::transform3D(), @ref Magnum::MeshTools::transform3DInPlace(), @ref Magnum::MeshTools::transformTextureCoordinates2D(), @ref Magnum::MeshTools::transformTextureCoordinates2DInPlace()
  */
 
+#include <Corrade/Containers/StridedArrayView.h>
+
 #include "Magnum/Math/DualQuaternion.h"
 #include "Magnum/Math/DualComplex.h"
+#include "Magnum/Math/TransformBatch.h"
 #include "Magnum/MeshTools/InterleaveFlags.h"
 #include "Magnum/MeshTools/visibility.h"
 #include "Magnum/Trade/Trade.h"
 
 namespace Magnum { namespace MeshTools {
 
+#ifndef DOXYGEN_GENERATING_OUTPUT
+namespace Implementation {
+    /* Whether a container can be passed to the batch APIs in
+       Math/TransformBatch.h -- i.e., it's a view or a container of Float
+       vectors convertible to a strided view */
+    template<class T, class U, class Vector> using IsTransformBatchable = std::integral_constant<bool, std::is_same<T, Float>::value && std::is_convertible<U, Containers::StridedArrayView1D<Vector>>::value>;
+
+    template<class T, class U> void transformVectorsInPlace(const Math::Matrix4<T>& matrix, U&& vectors, std::false_type) {
+        for(auto& vector: vectors) vector = matrix.transformVector(vector);
+    }
+    template<class U> void transformVectorsInPlace(const Matrix4& matrix, U&& vectors, std::true_type) {
+        const Containers::StridedArrayView1D<Vector3> view = vectors;
+        Math::transformVectorsInto(matrix, view, view);
+    }
+    template<class T, class U> void transformVectorsInPlace(const Math::Matrix3<T>& matrix, U&& vectors, std::false_type) {
+        for(auto& vector: vectors) vector = matrix.transformVector(vector);
+    }
+    template<class U> void transformVectorsInPlace(const Matrix3& matrix, U&& vectors, std::true_type) {
+        const Containers::StridedArrayView1D<Vector2> view = vectors;
+        Math::transformVectorsInto(matrix, view, view);
+    }
+    template<class T, class U> void transformPointsInPlace(const Math::Matrix4<T>& matrix, U&& points, std::false_type) {
+        for(auto& point: points) point = matrix.transformPoint(point);
+    }
+    template<class U> void transformPointsInPlace(const Matrix4& matrix, U&& points, std::true_type) {
+        const Containers::StridedArrayView1D<Vector3> view = points;
+        Math::transformPointsInto(matrix, view, view);
+    }
+    template<class T, class U> void transformPointsInPlace(const Math::Matrix3<T>& matrix, U&& points, std::false_type) {
+        for(auto& point: points) point = matrix.transformPoint(point);
+    }
+    template<class U> void transformPointsInPlace(const Matrix3& matrix, U&& points, std::true_type) {
+        const Containers::StridedArrayView1D<Vector2> view = points;
+        Math::transformPointsInto(matrix, view, view);
+    }
+}
+#endif
+
 /**
 @brief Transform vectors in-place using given transformation
 
@@ -49,6 +90,13 @@ representations.
 Unlike in @ref transformPointsInPlace(), the transformation does not involve
 translation.
 
+If @p vectors is convertible to a
+@ref Corrade::Containers::StridedArrayView "Containers::StridedArrayView1D" of
+@ref Magnum::Vector3 "Vector3" or @ref Magnum::Vector2 "Vector2" and the
+transformation is a @ref Magnum::Matrix4 "Matrix4" or
+@ref Magnum::Matrix3 "Matrix3", the operation is delegated to the SIMD-enabled
+@ref Math::transformVectorsInto() batch API.
+
 Example usage:
 
 @snippet MagnumMeshTools.cpp transformVectors
@@ -60,12 +108,12 @@ Example usage:
 @todo GPU transform feedback implementation (otherwise this is only bad joke)
 */
 template<class T, class U> void transformVectorsInPlace(const Math::Matrix4<T>& matrix, U&& vectors) {
-    for(auto& vector: vectors) vector = matrix.transformVector(vector);
+    Implementation::transformVectorsInPlace(matrix, std::forward<U>(vectors), Implementation::IsTransformBatchable<T, U&&, Vector3>{});
 }
 
 /** @overload */
 template<class T, class U> void transformVectorsInPlace(const Math::Matrix3<T>& matrix, U&& vectors) {
-    for(auto& vector: vectors) vector = matrix.transformVector(vector);
+    Implementation::transformVectorsInPlace(matrix, std::forward<U>(vectors), Implementation::IsTransformBatchable<T, U&&, Vector2>{});
 }
 
 /** @overload */
@@ -103,6 +151,13 @@ requirements are for other transformation representations.
 Unlike in @ref transformVectorsInPlace(), the transformation also involves
 translation.
 
+If @p points is convertible to a
+@ref Corrade::Containers::StridedArrayView "Containers::StridedArrayView1D" of
+@ref Magnum::Vector3 "Vector3" or @ref Magnum::Vector2 "Vector2" and the
+transformation is a @ref Magnum::Matrix4 "Matrix4" or
+@ref Magnum::Matrix3 "Matrix3", the operation is delegated to the SIMD-enabled
+@ref Math::transformPointsInto() batch API.
+
 Example usage:
 
 @snippet MagnumMeshTools.cpp transformPoints
@@ -113,12 +168,12 @@ Example usage:
     @ref DualQuaternion::transformPointNormalized()
 */
 template<class T, class U> void transformPointsInPlace(const Math::Matrix4<T>& matrix, U&& points) {
-    for(auto& point: points) point = matrix.transformPoint(point);
+    Implementation::transformPointsInPlace(matrix, std::forward<U>(points), Implementation::IsTransformBatchable<T, U&&, Vector3>{});
 }
 
 /** @overload */
 template<class T, class U> void transformPointsInPlace(const Math::Matrix3<T>& matrix, U&& points) {
-    for(auto& point: points) point = matrix.transformPoint(point);
+    Implementation::transformPointsInPlace(matrix, std::forward<U>(points), Implementation::IsTransformBatchable<T, U&&, Vector2>{});
 }
 
 /** @overload */
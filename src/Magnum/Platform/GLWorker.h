@@ -0,0 +1,309 @@
+#ifndef Magnum_Platform_GLWorker_h
+#define Magnum_Platform_GLWorker_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/configure.h"
+
+#if defined(MAGNUM_TARGET_GL) && !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+/** @file
+ * @brief Class @ref Magnum::Platform::GLWorker
+ * @m_since_latest
+ */
+#endif
+
+#if defined(MAGNUM_TARGET_GL) && !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include <deque>
+#include <functional>
+#if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+#include "Magnum/Magnum.h"
+#include "Magnum/GL/OpenGL.h"
+#include "Magnum/Platform/GLContext.h"
+
+namespace Magnum { namespace Platform {
+
+/**
+@brief Worker thread with a shared OpenGL context
+@tparam Context     Context type
+@m_since_latest
+
+Runs jobs such as @ref GL::Buffer or @ref GL::Texture uploads or shader
+compilation on a background thread with an OpenGL context that shares objects
+with the main one, so asset streaming can use the driver's parallelism without
+blocking the main context. The @p Context type is expected to have
+@cpp makeCurrent() @ce and @cpp release() @ce functions, such as
+@ref Sdl2Application::SharedGLContext, @ref GlfwApplication::SharedGLContext,
+@ref WindowlessEglContext or @ref WindowlessGlxContext, created as shared with
+the main context:
+
+@snippet MagnumPlatform.cpp GLWorker
+
+@section Platform-GLWorker-synchronization Synchronization
+
+Each job gets an ID, assigned in order of the @ref submit() calls. The jobs
+are executed in the same order and each is followed by a fence. Call
+@ref update() on the main thread, usually once a frame, to make the main
+context wait on fences of all jobs finished so far. The wait happens on the
+GPU, the main thread is not blocked. GL commands issued after
+@ref update() are thus guaranteed to see results of all jobs with ID less than
+@ref completedCount(), which is what @ref isComplete() checks.
+
+Only objects that are shared between contexts can be created by the jobs ---
+buffers, textures, renderbuffers, shaders and shader programs. Container
+objects such as meshes (vertex array objects), framebuffers or transform
+feedback objects are not shared and have to be created on the main context.
+
+@section Platform-GLWorker-threads Thread safety
+
+The @ref submit(), @ref submittedCount(), @ref completedCount() and
+@ref isComplete() functions can be called from any thread. Everything else,
+including construction and destruction, is expected to happen on the thread
+the main context is current on.
+
+If Corrade isn't built with @ref CORRADE_BUILD_MULTITHREADED or when targeting
+@ref CORRADE_TARGET_EMSCRIPTEN "Emscripten", no thread is created and the jobs
+are executed directly on the main context in @ref update().
+@requires_gl32 Extension @gl_extension{ARB,sync}
+@requires_gles30 Not defined in OpenGL ES 2.0.
+@requires_gles Not available in WebGL, which doesn't support shared contexts.
+*/
+template<class Context> class GLWorker {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * Takes over the @p context, makes it current on a newly created
+         * thread and creates a @ref GLContext there. The context is expected
+         * to be not current on any thread.
+         */
+        explicit GLWorker(Context&& context);
+
+        /** @brief Copying is not allowed */
+        GLWorker(const GLWorker<Context>&) = delete;
+
+        /** @brief Moving is not allowed */
+        GLWorker(GLWorker<Context>&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Waits for the currently executed job to finish and stops the
+         * thread. Jobs that weren't started yet are discarded. Fences of jobs
+         * that finished but weren't waited on in @ref update() are deleted.
+         */
+        ~GLWorker();
+
+        /** @brief Copying is not allowed */
+        GLWorker<Context>& operator=(const GLWorker<Context>&) = delete;
+
+        /** @brief Moving is not allowed */
+        GLWorker<Context>& operator=(GLWorker<Context>&&) = delete;
+
+        /** @brief Context */
+        Context& context() { return _context; }
+
+        /**
+         * @brief Submit a job
+         * @return Job ID
+         *
+         * The @p job is called on the worker thread with the shared context
+         * current. Can be called from any thread.
+         * @see @ref isComplete()
+         */
+        template<class F> UnsignedLong submit(F&& job);
+
+        /**
+         * @brief Wait for finished jobs
+         * @return Reference to self (for method chaining)
+         *
+         * Makes the main context wait on fences of all jobs finished since
+         * the last call and increases @ref completedCount() by their count.
+         * Doesn't block the calling thread.
+         * @see @fn_gl_keyword{WaitSync}, @fn_gl_keyword{DeleteSync}
+         */
+        GLWorker<Context>& update();
+
+        /** @brief Count of submitted jobs */
+        UnsignedLong submittedCount() const;
+
+        /**
+         * @brief Count of completed jobs
+         *
+         * Jobs with an ID less than this value are completed and their
+         * results are visible to the main context.
+         */
+        UnsignedLong completedCount() const;
+
+        /**
+         * @brief Whether given job is complete
+         *
+         * Equivalent to @cpp id < completedCount() @ce.
+         */
+        bool isComplete(UnsignedLong id) const { return id < completedCount(); }
+
+    private:
+        #if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+        void run();
+        #endif
+
+        Context _context;
+        std::deque<std::function<void()>> _jobs;
+        UnsignedLong _submitted{}, _completed{};
+        #if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+        mutable std::mutex _mutex;
+        std::condition_variable _condition;
+        /* Fences of jobs that finished on the worker, in order */
+        std::deque<GLsync> _fences;
+        bool _stop{};
+        /* Declared last so it's started after everything else is
+           initialized */
+        std::thread _thread;
+        #endif
+};
+
+template<class Context> GLWorker<Context>::GLWorker(Context&& context): _context{std::move(context)} {
+    #if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+    _thread = std::thread{&GLWorker<Context>::run, this};
+    #endif
+}
+
+template<class Context> GLWorker<Context>::~GLWorker() {
+    #if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _stop = true;
+    }
+    _condition.notify_one();
+    _thread.join();
+
+    for(GLsync fence: _fences) glDeleteSync(fence);
+    #endif
+}
+
+template<class Context> template<class F> UnsignedLong GLWorker<Context>::submit(F&& job) {
+    UnsignedLong id;
+    {
+        #if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+        std::lock_guard<std::mutex> lock{_mutex};
+        #endif
+        _jobs.emplace_back(std::forward<F>(job));
+        id = _submitted++;
+    }
+    #if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+    _condition.notify_one();
+    #endif
+    return id;
+}
+
+template<class Context> GLWorker<Context>& GLWorker<Context>::update() {
+    #if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+    std::deque<GLsync> fences;
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        std::swap(fences, _fences);
+    }
+
+    for(GLsync fence: fences) {
+        glWaitSync(fence, 0, GL_TIMEOUT_IGNORED);
+        glDeleteSync(fence);
+    }
+
+    std::lock_guard<std::mutex> lock{_mutex};
+    _completed += fences.size();
+    #else
+    /* No threads, execute everything on the main context */
+    while(!_jobs.empty()) {
+        _jobs.front()();
+        _jobs.pop_front();
+        ++_completed;
+    }
+    #endif
+    return *this;
+}
+
+template<class Context> UnsignedLong GLWorker<Context>::submittedCount() const {
+    #if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+    std::lock_guard<std::mutex> lock{_mutex};
+    #endif
+    return _submitted;
+}
+
+template<class Context> UnsignedLong GLWorker<Context>::completedCount() const {
+    #if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+    std::lock_guard<std::mutex> lock{_mutex};
+    #endif
+    return _completed;
+}
+
+#if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+template<class Context> void GLWorker<Context>::run() {
+    if(!_context.makeCurrent()) return;
+
+    {
+        GLContext glContext{NoCreate};
+        if(!glContext.tryCreate(GLContext::Configuration{}.addFlags(GLContext::Configuration::Flag::QuietLog))) {
+            _context.release();
+            return;
+        }
+
+        for(;;) {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lock{_mutex};
+                _condition.wait(lock, [this]() {
+                    return _stop || !_jobs.empty();
+                });
+                if(_stop) break;
+                job = std::move(_jobs.front());
+                _jobs.pop_front();
+            }
+
+            job();
+
+            /* The flush is needed for the fence to become visible to other
+               contexts */
+            GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            glFlush();
+
+            std::lock_guard<std::mutex> lock{_mutex};
+            _fences.push_back(fence);
+        }
+    }
+
+    _context.release();
+}
+#endif
+
+}}
+#else
+#error this header is available only in the OpenGL build, not on OpenGL ES 2.0 or WebGL
+#endif
+
+#endif
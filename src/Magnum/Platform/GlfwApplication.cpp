@@ -31,12 +31,14 @@
 #include <tuple>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/StringView.h>
 #include <Corrade/Utility/Arguments.h>
 #include <Corrade/Utility/Unicode.h>
 
 #include "Magnum/ImageView.h"
 #include "Magnum/PixelFormat.h"
 #include "Magnum/Math/ConfigurationValue.h"
+#include "Magnum/Math/Functions.h"
 #include "Magnum/Platform/ScreenedApplication.hpp"
 #include "Magnum/Platform/Implementation/DpiScaling.h"
 
@@ -718,6 +720,53 @@ Vector2i GlfwApplication::framebufferSize() const {
 }
 #endif
 
+#if defined(MAGNUM_TARGET_VK) && GLFW_VERSION_MAJOR*100 + GLFW_VERSION_MINOR >= 302
+/* glfw3.h declares glfwCreateWindowSurface() only if vulkan.h is included
+   before it, which is not the case with the flextVk headers */
+extern "C" VkResult glfwCreateWindowSurface(VkInstance, GLFWwindow*, const VkAllocationCallbacks*, VkSurfaceKHR*);
+
+Containers::Array<Containers::StringView> GlfwApplication::vkInstanceExtensions() {
+    UnsignedInt count = 0;
+    const char** const names = glfwGetRequiredInstanceExtensions(&count);
+    Containers::Array<Containers::StringView> out{count};
+    for(std::size_t i = 0; i != count; ++i)
+        out[i] = Containers::StringView{names[i], Containers::StringViewFlag::Global};
+    return out;
+}
+
+VkSurfaceKHR GlfwApplication::createVkSurface(const VkInstance instance) {
+    CORRADE_ASSERT(_window, "Platform::GlfwApplication::createVkSurface(): no window opened", {});
+
+    VkSurfaceKHR surface{};
+    if(const VkResult result = glfwCreateWindowSurface(instance, _window, nullptr, &surface)) {
+        Error{} << "Platform::GlfwApplication::createVkSurface(): cannot create a surface, error" << Int(result);
+        return {};
+    }
+    return surface;
+}
+#endif
+
+void GlfwApplication::swapBuffers() {
+    #if GLFW_VERSION_MAJOR*100 + GLFW_VERSION_MINOR >= 302
+    /* Measure how long the frame took for LoopFlag::FrameStartDelay. Spikes
+       are taken immediately while drops decay slowly, to not miss a refresh
+       right after a spike. */
+    if(_loopFlags & LoopFlag::FrameStartDelay) {
+        if(_drawEventStart) {
+            const Double duration = glfwGetTime() - _drawEventStart;
+            _drawDuration = Math::max(duration, 0.95*_drawDuration + 0.05*duration);
+            _drawEventStart = 0.0;
+        }
+
+        glfwSwapBuffers(_window);
+        _swapEnd = glfwGetTime();
+    } else
+    #endif
+    {
+        glfwSwapBuffers(_window);
+    }
+}
+
 void GlfwApplication::setSwapInterval(const Int interval) {
     glfwSwapInterval(interval);
 }
@@ -764,6 +813,33 @@ bool GlfwApplication::mainLoopIteration() {
        avoid spinning the CPU by waiting for the next input event. */
     if(_flags & Flag::Redraw) {
         _flags &= ~Flag::Redraw;
+
+        #if GLFW_VERSION_MAJOR*100 + GLFW_VERSION_MINOR >= 302
+        /* Delay the frame start so it ends a safety margin before the next
+           refresh, based on how long the previous frames took. Events
+           arriving in the meantime get processed. */
+        if(_loopFlags & LoopFlag::FrameStartDelay) {
+            if(_swapEnd) {
+                GLFWmonitor* monitor = glfwGetWindowMonitor(_window);
+                if(!monitor) monitor = glfwGetPrimaryMonitor();
+                const GLFWvidmode* const mode = monitor ? glfwGetVideoMode(monitor) : nullptr;
+                const Double period = 1.0/(mode && mode->refreshRate ? mode->refreshRate : 60);
+                const Double deadline = _swapEnd + 0.75*period - _drawDuration;
+                for(Double now = glfwGetTime(); now < deadline && !glfwWindowShouldClose(_window); now = glfwGetTime())
+                    glfwWaitEventsTimeout(deadline - now);
+            }
+
+            _drawEventStart = glfwGetTime();
+        }
+        #endif
+
+        /* Process also events that arrived since the end of the previous
+           frame */
+        if(_loopFlags & LoopFlag::LateInputSampling) {
+            glfwPollEvents();
+            if(glfwWindowShouldClose(_window)) return false;
+        }
+
         drawEvent();
         glfwPollEvents();
     } else glfwWaitEvents();
@@ -901,6 +977,42 @@ GlfwApplication::GLConfiguration::GLConfiguration():
 }
 
 GlfwApplication::GLConfiguration::~GLConfiguration() = default;
+
+GlfwApplication::SharedGLContext::SharedGLContext(GlfwApplication& application) {
+    CORRADE_ASSERT(application._window && application._context->version() != GL::Version::None,
+        "Platform::GlfwApplication::SharedGLContext: the application has no GL context", );
+
+    /* All other hints stay the same as for the application context. This
+       doesn't change the current context. */
+    glfwWindowHint(GLFW_VISIBLE, false);
+    _window = glfwCreateWindow(1, 1, "", nullptr, application._window);
+    if(!_window)
+        Error{} << "Platform::GlfwApplication::SharedGLContext: cannot create context";
+}
+
+GlfwApplication::SharedGLContext::SharedGLContext(SharedGLContext&& other) noexcept: _window{other._window} {
+    other._window = nullptr;
+}
+
+GlfwApplication::SharedGLContext::~SharedGLContext() {
+    if(_window) glfwDestroyWindow(_window);
+}
+
+GlfwApplication::SharedGLContext& GlfwApplication::SharedGLContext::operator=(SharedGLContext&& other) noexcept {
+    using std::swap;
+    swap(other._window, _window);
+    return *this;
+}
+
+bool GlfwApplication::SharedGLContext::makeCurrent() {
+    glfwMakeContextCurrent(_window);
+    return true;
+}
+
+bool GlfwApplication::SharedGLContext::release() {
+    glfwMakeContextCurrent(nullptr);
+    return true;
+}
 #endif
 
 GlfwApplication::Configuration::Configuration():
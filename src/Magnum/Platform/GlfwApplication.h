@@ -44,6 +44,10 @@
 #include "Magnum/Platform/GLContext.h"
 #endif
 
+#ifdef MAGNUM_TARGET_VK
+#include "MagnumExternal/Vulkan/flextVk.h"
+#endif
+
 #ifndef DOXYGEN_GENERATING_OUTPUT
 #define GLFW_INCLUDE_NONE
 #endif
@@ -173,6 +177,7 @@ class GlfwApplication {
         class Configuration;
         #ifdef MAGNUM_TARGET_GL
         class GLConfiguration;
+        class SharedGLContext;
         #endif
         class ExitEvent;
         class ViewportEvent;
@@ -302,6 +307,42 @@ class GlfwApplication {
          */
         GLFWwindow* window() { return _window; }
 
+        #if defined(MAGNUM_TARGET_VK) && (GLFW_VERSION_MAJOR*100 + GLFW_VERSION_MINOR >= 302 || defined(DOXYGEN_GENERATING_OUTPUT))
+        /**
+         * @brief Vulkan instance extensions needed for presenting to the window
+         * @m_since_latest
+         *
+         * Returns @vk_extension{KHR,surface} together with the
+         * platform-specific surface extension, to be passed to
+         * @ref Vk::InstanceCreateInfo::addEnabledExtensions(). The views
+         * point to global memory owned by GLFW. Returns an empty array if
+         * Vulkan isn't available on the system.
+         * @note This function is available only if Magnum is compiled with
+         *      @ref MAGNUM_TARGET_VK enabled and with GLFW 3.2+.
+         * @see @ref Vk-Surface-creation
+         */
+        Containers::Array<Containers::StringView> vkInstanceExtensions();
+
+        /**
+         * @brief Create a Vulkan surface for the window
+         * @m_since_latest
+         *
+         * Expects that the window was created without an OpenGL context,
+         * i.e. with @ref Configuration::WindowFlag::Contextless if Magnum
+         * is built with @ref MAGNUM_TARGET_GL, and that @p instance was
+         * created with extensions listed in @ref vkInstanceExtensions().
+         * Prints a message to @relativeref{Magnum,Error} and returns
+         * @cpp nullptr @ce if the surface can't be created. The returned
+         * surface is owned by the caller, wrap it in a @ref Vk::Surface with
+         * @ref Vk::HandleFlag::DestroyOnDestruction to have it destroyed
+         * automatically.
+         * @note This function is available only if Magnum is compiled with
+         *      @ref MAGNUM_TARGET_VK enabled and with GLFW 3.2+.
+         * @see @ref Vk-Surface-creation
+         */
+        VkSurfaceKHR createVkSurface(VkInstance instance);
+        #endif
+
     protected:
         /* Nobody will need to have (and delete) GlfwApplication*, thus this is
            faster than public pure virtual destructor */
@@ -517,7 +558,7 @@ class GlfwApplication {
          *
          * Paints currently rendered framebuffer on screen.
          */
-        void swapBuffers() { glfwSwapBuffers(_window); }
+        void swapBuffers();
 
         /**
          * @brief Set swap interval
@@ -535,6 +576,67 @@ class GlfwApplication {
         /** @copydoc Sdl2Application::redraw() */
         void redraw();
 
+        /**
+         * @brief Main loop flag
+         * @m_since_latest
+         *
+         * @see @ref LoopFlags, @ref setLoopFlags()
+         */
+        enum class LoopFlag: UnsignedByte {
+            /**
+             * Process input events once more right before @ref drawEvent(),
+             * so the frame reflects the most recent input. By default events
+             * are processed only right after @ref drawEvent(), which means
+             * any input arriving while waiting for VSync is delayed by a
+             * frame.
+             */
+            LateInputSampling = 1 << 0,
+
+            #if GLFW_VERSION_MAJOR*100 + GLFW_VERSION_MINOR >= 302 || defined(DOXYGEN_GENERATING_OUTPUT)
+            /**
+             * Delay the start of @ref drawEvent() so the frame finishes
+             * shortly before the next display refresh instead of right after
+             * the previous one, processing input events that arrive in the
+             * meantime. The delay is based on measured time between the start
+             * of @ref drawEvent() and the @ref swapBuffers() call, with a
+             * quarter of the frame period left as a safety margin. The frame
+             * period is taken from the refresh rate of the monitor the window
+             * is on, assuming VSync is enabled. If the frame time fluctuates a
+             * lot, this may result in missed display refreshes.
+             * @note Available since GLFW 3.2.
+             */
+            FrameStartDelay = 1 << 1
+            #endif
+        };
+
+        /**
+         * @brief Main loop flags
+         * @m_since_latest
+         *
+         * @see @ref setLoopFlags()
+         */
+        typedef Containers::EnumSet<LoopFlag> LoopFlags;
+
+        /**
+         * @brief Main loop flags
+         * @m_since_latest
+         */
+        LoopFlags loopFlags() const { return _loopFlags; }
+
+        /**
+         * @brief Set main loop flags
+         * @m_since_latest
+         *
+         * By default no flags are set, meaning @ref drawEvent() is called
+         * right at the start of a main loop iteration if a redraw is
+         * requested, input events are processed right after and if no redraw
+         * is requested, the application blocks until the next input event.
+         * Unlike @ref Sdl2Application, there's no tick event and thus the
+         * application always blocks when not redrawing, so there's no
+         * equivalent to @ref Sdl2Application::LoopFlag::WaitForEvents.
+         */
+        void setLoopFlags(LoopFlags flags) { _loopFlags = flags; }
+
     private:
         /**
          * @brief Viewport event
@@ -768,6 +870,9 @@ class GlfwApplication {
         Vector2 _dpiScaling;
         GLFWwindow* _window{nullptr};
         Flags _flags;
+        LoopFlags _loopFlags;
+        /* For LoopFlag::FrameStartDelay, in seconds */
+        Double _drawEventStart{}, _swapEnd{}, _drawDuration{};
         #ifdef MAGNUM_TARGET_GL
         /* Has to be in an Optional because we delay-create it in a constructor
            with populated Arguments and it gets explicitly destroyed before the
@@ -1020,6 +1125,84 @@ class GlfwApplication::GLConfiguration: public GL::Context::Configuration {
 };
 
 CORRADE_ENUMSET_OPERATORS(GlfwApplication::GLConfiguration::Flags)
+
+/**
+@brief Shared OpenGL context
+@m_since_latest
+
+OpenGL context sharing objects with the context of a @ref GlfwApplication,
+meant to be made current on a different thread, for example through
+@ref GLWorker. As GLFW ties contexts to windows, it's created together with a
+hidden window, using the same hints as the application context.
+@note This class is available only if Magnum is compiled with
+    @ref MAGNUM_TARGET_GL enabled (done by default). See @ref building-features
+    for more information.
+*/
+class GlfwApplication::SharedGLContext {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * Expects that the application has a GL context created. As with
+         * all GLFW window operations, has to be called on the main thread.
+         * Prints a message to @relativeref{Magnum,Error} if the context can't
+         * be created, use @ref isCreated() to check.
+         */
+        explicit SharedGLContext(GlfwApplication& application);
+
+        /**
+         * @brief Construct without creating the context
+         *
+         * Move an instance with created context over to make it usable.
+         */
+        explicit SharedGLContext(NoCreateT) {}
+
+        /** @brief Copying is not allowed */
+        SharedGLContext(const SharedGLContext&) = delete;
+
+        /** @brief Move constructor */
+        SharedGLContext(SharedGLContext&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Destroys the context and its hidden window, if any. Has to be
+         * called on the main thread and the context is expected to not be
+         * current on any thread.
+         */
+        ~SharedGLContext();
+
+        /** @brief Copying is not allowed */
+        SharedGLContext& operator=(const SharedGLContext&) = delete;
+
+        /** @brief Move assignment */
+        SharedGLContext& operator=(SharedGLContext&& other) noexcept;
+
+        /** @brief Whether the context is created */
+        bool isCreated() const { return _window; }
+
+        /**
+         * @brief Make the context current
+         *
+         * Always returns @cpp true @ce, failures are reported through the
+         * GLFW error callback.
+         */
+        bool makeCurrent();
+
+        /**
+         * @brief Release the context
+         *
+         * Always returns @cpp true @ce, failures are reported through the
+         * GLFW error callback.
+         */
+        bool release();
+
+        /** @brief Underlying hidden window owning the context */
+        GLFWwindow* window() { return _window; }
+
+    private:
+        GLFWwindow* _window{};
+};
 #endif
 
 namespace Implementation {
@@ -1390,6 +1573,7 @@ class GlfwApplication::Configuration {
         #endif
 };
 
+CORRADE_ENUMSET_OPERATORS(GlfwApplication::LoopFlags)
 CORRADE_ENUMSET_OPERATORS(GlfwApplication::Configuration::WindowFlags)
 
 /**
@@ -35,11 +35,19 @@
 #pragma clang diagnostic ignored "-Wpragma-pack"
 #endif
 #include <SDL.h>
+#if defined(MAGNUM_TARGET_VK) && !defined(CORRADE_TARGET_EMSCRIPTEN) && SDL_MAJOR_VERSION*1000 + SDL_MINOR_VERSION*100 + SDL_PATCHLEVEL >= 2006
+#include <SDL_vulkan.h>
+#endif
 #ifdef CORRADE_TARGET_CLANG_CL
 #pragma clang diagnostic pop
 #endif
 #ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 #include <tuple>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/StringView.h>
 #else
 #include <emscripten/emscripten.h>
 #include <emscripten/html5.h>
@@ -762,9 +770,51 @@ void Sdl2Application::setContainerCssClass(const Containers::StringView cssClass
 }
 #endif
 
+#if defined(MAGNUM_TARGET_VK) && !defined(CORRADE_TARGET_EMSCRIPTEN) && SDL_MAJOR_VERSION*1000 + SDL_MINOR_VERSION*100 + SDL_PATCHLEVEL >= 2006
+Containers::Array<Containers::StringView> Sdl2Application::vkInstanceExtensions() {
+    CORRADE_ASSERT(_window, "Platform::Sdl2Application::vkInstanceExtensions(): no window opened", {});
+
+    unsigned int count;
+    if(!SDL_Vulkan_GetInstanceExtensions(_window, &count, nullptr)) {
+        Error{} << "Platform::Sdl2Application::vkInstanceExtensions(): cannot query the extensions:" << SDL_GetError();
+        return {};
+    }
+    Containers::Array<const char*> names{count};
+    CORRADE_INTERNAL_ASSERT_OUTPUT(SDL_Vulkan_GetInstanceExtensions(_window, &count, names));
+
+    Containers::Array<Containers::StringView> out{count};
+    for(std::size_t i = 0; i != count; ++i)
+        out[i] = Containers::StringView{names[i], Containers::StringViewFlag::Global};
+    return out;
+}
+
+VkSurfaceKHR Sdl2Application::createVkSurface(const VkInstance instance) {
+    CORRADE_ASSERT(_window, "Platform::Sdl2Application::createVkSurface(): no window opened", {});
+
+    VkSurfaceKHR surface{};
+    if(!SDL_Vulkan_CreateSurface(_window, instance, &surface)) {
+        Error{} << "Platform::Sdl2Application::createVkSurface(): cannot create a surface:" << SDL_GetError();
+        return {};
+    }
+    return surface;
+}
+#endif
+
 void Sdl2Application::swapBuffers() {
     #ifndef CORRADE_TARGET_EMSCRIPTEN
-    SDL_GL_SwapWindow(_window);
+    /* Measure how long the frame took for LoopFlag::FrameStartDelay. Spikes
+       are taken immediately while drops decay slowly, to not miss a refresh
+       right after a spike. */
+    if(_loopFlags & LoopFlag::FrameStartDelay) {
+        if(_drawEventStart) {
+            const Double duration = Double(SDL_GetPerformanceCounter() - _drawEventStart)/Double(SDL_GetPerformanceFrequency());
+            _drawDuration = Math::max(duration, 0.95*_drawDuration + 0.05*duration);
+            _drawEventStart = 0;
+        }
+
+        SDL_GL_SwapWindow(_window);
+        _swapEnd = SDL_GetPerformanceCounter();
+    } else SDL_GL_SwapWindow(_window);
     #else
     SDL_Flip(_surface);
     #endif
@@ -826,8 +876,95 @@ Sdl2Application::~Sdl2Application() {
     SDL_Quit();
 }
 
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+struct Sdl2Application::RenderThread {
+    std::mutex mutex;
+    std::condition_variable condition;
+    /* The main thread appends to the back packet, the render thread swaps it
+       with the front one at the start of each iteration and processes it
+       without holding the lock */
+    Containers::Array<SDL_Event> front, back;
+    Uint32 wakeUpEvent;
+    bool exit = false;
+};
+#endif
+
 int Sdl2Application::exec() {
     #ifndef CORRADE_TARGET_EMSCRIPTEN
+    #ifndef CORRADE_TARGET_APPLE
+    if(_loopFlags & LoopFlag::RenderThread) {
+        RenderThread state;
+        state.wakeUpEvent = SDL_RegisterEvents(1);
+
+        /* Collect events through a watch instead of in the loop below, as on
+           Windows it gets called also from within the modal loop during
+           window resize or drag, while SDL_WaitEvent() is blocked */
+        const SDL_EventFilter watch = [](void* userData, SDL_Event* event) -> int {
+            auto& state = *static_cast<RenderThread*>(userData);
+            if(event->type == state.wakeUpEvent) return 0;
+            {
+                std::lock_guard<std::mutex> lock{state.mutex};
+                arrayAppend(state.back, *event);
+            }
+            state.condition.notify_one();
+            return 0;
+        };
+        SDL_AddEventWatch(watch, &state);
+
+        /* Release the GL context on the main thread so the render thread can
+           make it current */
+        #ifdef MAGNUM_TARGET_GL
+        if(_glContext) SDL_GL_MakeCurrent(_window, nullptr);
+        GL::Context::makeCurrent(nullptr);
+        #endif
+
+        _renderThread = &state;
+        std::thread thread{[this, &state]() {
+            #ifdef MAGNUM_TARGET_GL
+            if(_glContext) SDL_GL_MakeCurrent(_window, _glContext);
+            if(_context) GL::Context::makeCurrent(&*_context);
+            #endif
+
+            while(mainLoopIteration()) {}
+
+            #ifdef MAGNUM_TARGET_GL
+            GL::Context::makeCurrent(nullptr);
+            if(_glContext) SDL_GL_MakeCurrent(_window, nullptr);
+            #endif
+
+            /* Wake up the main thread, which is waiting for an event */
+            {
+                std::lock_guard<std::mutex> lock{state.mutex};
+                state.exit = true;
+            }
+            SDL_Event event{};
+            event.type = state.wakeUpEvent;
+            SDL_PushEvent(&event);
+        }};
+
+        /* The events are already collected by the watch above, here they're
+           only pumped and removed from the queue */
+        SDL_Event event;
+        while(SDL_WaitEvent(&event)) {
+            std::lock_guard<std::mutex> lock{state.mutex};
+            if(state.exit) break;
+        }
+
+        thread.join();
+        _renderThread = nullptr;
+        SDL_DelEventWatch(watch, &state);
+
+        /* Make the GL context current on the main thread again so it can be
+           destroyed */
+        #ifdef MAGNUM_TARGET_GL
+        if(_glContext) SDL_GL_MakeCurrent(_window, _glContext);
+        if(_context) GL::Context::makeCurrent(&*_context);
+        #endif
+
+        return _exitCode;
+    }
+    #endif
+
     while(mainLoopIteration()) {}
     #else
     emscripten_set_main_loop_arg([](void* arg) {
@@ -847,6 +984,139 @@ void Sdl2Application::exit(const int exitCode) {
     _exitCode = exitCode;
 }
 
+bool Sdl2Application::processEvents() {
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    /* With LoopFlag::RenderThread the events can't be polled from here as
+       SDL_PollEvent() pumps them, which has to be done on the main thread.
+       Take the packet collected by the main thread instead. */
+    if(_renderThread) {
+        {
+            std::lock_guard<std::mutex> lock{_renderThread->mutex};
+            std::swap(_renderThread->front, _renderThread->back);
+        }
+        bool running = true;
+        for(SDL_Event& event: _renderThread->front)
+            if(!processEvent(event)) {
+                running = false;
+                break;
+            }
+        /* Keep the capacity for the next time the packets are swapped */
+        arrayRemoveSuffix(_renderThread->front, _renderThread->front.size());
+        return running;
+    }
+    #endif
+
+    SDL_Event event;
+    while(SDL_PollEvent(&event))
+        if(!processEvent(event)) return false;
+
+    return true;
+}
+
+bool Sdl2Application::processEvent(SDL_Event& event) {
+    switch(event.type) {
+        case SDL_WINDOWEVENT:
+            switch(event.window.event) {
+                /* Not using SDL_WINDOWEVENT_RESIZED, because that doesn't
+                   get fired when the window is resized programmatically
+                   (such as through setMaxWindowSize()) */
+                case SDL_WINDOWEVENT_SIZE_CHANGED: {
+                    #ifdef CORRADE_TARGET_EMSCRIPTEN
+                    /* If anybody sees this assert, then emscripten finally
+                       implemented resize events. Praise them for that.
+                       https://github.com/kripken/emscripten/issues/1731 */
+                    CORRADE_INTERNAL_ASSERT_UNREACHABLE();
+                    #else
+                    /* {event.window.data1, event.window.data2} seems to be
+                       framebuffer size and not window size on macOS, which
+                       is weird. Query the values directly instead to be
+                       really sure. */
+                    ViewportEvent e{event, windowSize(),
+                        #ifdef MAGNUM_TARGET_GL
+                        framebufferSize(),
+                        #endif
+                        _dpiScaling};
+                    /** @todo handle also WM_DPICHANGED events when a window is moved between displays with different DPI */
+                    viewportEvent(e);
+                    _flags |= Flag::Redraw;
+                    #endif
+                } break;
+                /* Direct everything that wasn't exposed via a callback to
+                   anyEvent(), so users can implement event handling for
+                   things not present in the Application APIs */
+                case SDL_WINDOWEVENT_EXPOSED:
+                    _flags |= Flag::Redraw;
+                    if(!(_flags & Flag::NoAnyEvent)) anyEvent(event);
+                    break;
+                default:
+                    if(!(_flags & Flag::NoAnyEvent)) anyEvent(event);
+            } break;
+
+        case SDL_KEYDOWN:
+        case SDL_KEYUP: {
+            KeyEvent e{event, static_cast<KeyEvent::Key>(event.key.keysym.sym), fixedModifiers(event.key.keysym.mod), event.key.repeat != 0};
+            event.type == SDL_KEYDOWN ? keyPressEvent(e) : keyReleaseEvent(e);
+        } break;
+
+        case SDL_MOUSEBUTTONDOWN:
+        case SDL_MOUSEBUTTONUP: {
+            MouseEvent e{event, static_cast<MouseEvent::Button>(event.button.button), {event.button.x, event.button.y}
+                #ifndef CORRADE_TARGET_EMSCRIPTEN
+                , event.button.clicks
+                #endif
+                };
+            event.type == SDL_MOUSEBUTTONDOWN ? mousePressEvent(e) : mouseReleaseEvent(e);
+        } break;
+
+        case SDL_MOUSEWHEEL: {
+            MouseScrollEvent e{event, {Float(event.wheel.x), Float(event.wheel.y)}};
+            mouseScrollEvent(e);
+        } break;
+
+        case SDL_MOUSEMOTION: {
+            MouseMoveEvent e{event, {event.motion.x, event.motion.y}, {event.motion.xrel, event.motion.yrel}, static_cast<MouseMoveEvent::Button>(event.motion.state)};
+            mouseMoveEvent(e);
+            break;
+        }
+
+        case SDL_MULTIGESTURE: {
+            MultiGestureEvent e{event, {event.mgesture.x, event.mgesture.y}, event.mgesture.dTheta, event.mgesture.dDist, event.mgesture.numFingers};
+            multiGestureEvent(e);
+            break;
+        }
+
+        case SDL_TEXTINPUT: {
+            TextInputEvent e{event, event.text.text};
+            textInputEvent(e);
+        } break;
+
+        case SDL_TEXTEDITING: {
+            TextEditingEvent e{event, event.edit.text, event.edit.start, event.edit.length};
+            textEditingEvent(e);
+        } break;
+
+        case SDL_QUIT: {
+            ExitEvent e{event};
+            exitEvent(e);
+            if(e.isAccepted()) {
+                /* On Emscripten this flag is used only to indicate a
+                   desire to exit from mainLoopIteration() */
+                _flags |= Flag::Exit;
+                #ifdef CORRADE_TARGET_EMSCRIPTEN
+                emscripten_cancel_main_loop();
+                #endif
+                return false;
+            }
+        } break;
+
+        /* Direct everything else to anyEvent(), so users can implement
+           event handling for things not present in the Application APIs */
+        default: if(!(_flags & Flag::NoAnyEvent)) anyEvent(event);
+    }
+
+    return true;
+}
+
 bool Sdl2Application::mainLoopIteration() {
     /* If exit was requested directly in the constructor, exit immediately
        without calling anything else */
@@ -891,108 +1161,7 @@ bool Sdl2Application::mainLoopIteration() {
     }
     #endif
 
-    SDL_Event event;
-    while(SDL_PollEvent(&event)) {
-        switch(event.type) {
-            case SDL_WINDOWEVENT:
-                switch(event.window.event) {
-                    /* Not using SDL_WINDOWEVENT_RESIZED, because that doesn't
-                       get fired when the window is resized programmatically
-                       (such as through setMaxWindowSize()) */
-                    case SDL_WINDOWEVENT_SIZE_CHANGED: {
-                        #ifdef CORRADE_TARGET_EMSCRIPTEN
-                        /* If anybody sees this assert, then emscripten finally
-                           implemented resize events. Praise them for that.
-                           https://github.com/kripken/emscripten/issues/1731 */
-                        CORRADE_INTERNAL_ASSERT_UNREACHABLE();
-                        #else
-                        /* {event.window.data1, event.window.data2} seems to be
-                           framebuffer size and not window size on macOS, which
-                           is weird. Query the values directly instead to be
-                           really sure. */
-                        ViewportEvent e{event, windowSize(),
-                            #ifdef MAGNUM_TARGET_GL
-                            framebufferSize(),
-                            #endif
-                            _dpiScaling};
-                        /** @todo handle also WM_DPICHANGED events when a window is moved between displays with different DPI */
-                        viewportEvent(e);
-                        _flags |= Flag::Redraw;
-                        #endif
-                    } break;
-                    /* Direct everything that wasn't exposed via a callback to
-                       anyEvent(), so users can implement event handling for
-                       things not present in the Application APIs */
-                    case SDL_WINDOWEVENT_EXPOSED:
-                        _flags |= Flag::Redraw;
-                        if(!(_flags & Flag::NoAnyEvent)) anyEvent(event);
-                        break;
-                    default:
-                        if(!(_flags & Flag::NoAnyEvent)) anyEvent(event);
-                } break;
-
-            case SDL_KEYDOWN:
-            case SDL_KEYUP: {
-                KeyEvent e{event, static_cast<KeyEvent::Key>(event.key.keysym.sym), fixedModifiers(event.key.keysym.mod), event.key.repeat != 0};
-                event.type == SDL_KEYDOWN ? keyPressEvent(e) : keyReleaseEvent(e);
-            } break;
-
-            case SDL_MOUSEBUTTONDOWN:
-            case SDL_MOUSEBUTTONUP: {
-                MouseEvent e{event, static_cast<MouseEvent::Button>(event.button.button), {event.button.x, event.button.y}
-                    #ifndef CORRADE_TARGET_EMSCRIPTEN
-                    , event.button.clicks
-                    #endif
-                    };
-                event.type == SDL_MOUSEBUTTONDOWN ? mousePressEvent(e) : mouseReleaseEvent(e);
-            } break;
-
-            case SDL_MOUSEWHEEL: {
-                MouseScrollEvent e{event, {Float(event.wheel.x), Float(event.wheel.y)}};
-                mouseScrollEvent(e);
-            } break;
-
-            case SDL_MOUSEMOTION: {
-                MouseMoveEvent e{event, {event.motion.x, event.motion.y}, {event.motion.xrel, event.motion.yrel}, static_cast<MouseMoveEvent::Button>(event.motion.state)};
-                mouseMoveEvent(e);
-                break;
-            }
-
-            case SDL_MULTIGESTURE: {
-                MultiGestureEvent e{event, {event.mgesture.x, event.mgesture.y}, event.mgesture.dTheta, event.mgesture.dDist, event.mgesture.numFingers};
-                multiGestureEvent(e);
-                break;
-            }
-
-            case SDL_TEXTINPUT: {
-                TextInputEvent e{event, event.text.text};
-                textInputEvent(e);
-            } break;
-
-            case SDL_TEXTEDITING: {
-                TextEditingEvent e{event, event.edit.text, event.edit.start, event.edit.length};
-                textEditingEvent(e);
-            } break;
-
-            case SDL_QUIT: {
-                ExitEvent e{event};
-                exitEvent(e);
-                if(e.isAccepted()) {
-                    /* On Emscripten this flag is used only to indicate a
-                       desire to exit from mainLoopIteration() */
-                    _flags |= Flag::Exit;
-                    #ifdef CORRADE_TARGET_EMSCRIPTEN
-                    emscripten_cancel_main_loop();
-                    #endif
-                    return !(_flags & Flag::Exit);
-                }
-            } break;
-
-            /* Direct everything else to anyEvent(), so users can implement
-               event handling for things not present in the Application APIs */
-            default: if(!(_flags & Flag::NoAnyEvent)) anyEvent(event);
-        }
-    }
+    if(!processEvents()) return false;
 
     /* Tick event */
     if(!(_flags & Flag::NoTickEvent)) tickEvent();
@@ -1000,6 +1169,34 @@ bool Sdl2Application::mainLoopIteration() {
     /* Draw event */
     if(_flags & Flag::Redraw) {
         _flags &= ~Flag::Redraw;
+
+        #ifndef CORRADE_TARGET_EMSCRIPTEN
+        /* Delay the frame start so it ends a safety margin before the next
+           refresh, based on how long the previous frames took */
+        if(_loopFlags & LoopFlag::FrameStartDelay) {
+            Double period = 0.0;
+            if(_flags & Flag::VSyncEnabled) {
+                SDL_DisplayMode mode;
+                period = 1.0/(SDL_GetWindowDisplayMode(_window, &mode) == 0 && mode.refresh_rate ? mode.refresh_rate : 60);
+            } else if(_minimalLoopPeriod)
+                period = _minimalLoopPeriod/1000.0;
+
+            if(period && _swapEnd) {
+                const Double sinceSwap = Double(SDL_GetPerformanceCounter() - _swapEnd)/Double(SDL_GetPerformanceFrequency());
+                const Double delay = 0.75*period - _drawDuration - sinceSwap;
+                if(delay > 0.0) SDL_Delay(UnsignedInt(delay*1000.0));
+            }
+        }
+
+        /* Process also events that arrived during tickEvent() and the delay
+           above */
+        if((_loopFlags & LoopFlag::LateInputSampling) && !processEvents())
+            return false;
+
+        if(_loopFlags & LoopFlag::FrameStartDelay)
+            _drawEventStart = SDL_GetPerformanceCounter();
+        #endif
+
         drawEvent();
 
         #ifndef CORRADE_TARGET_EMSCRIPTEN
@@ -1022,9 +1219,19 @@ bool Sdl2Application::mainLoopIteration() {
             SDL_Delay(_minimalLoopPeriod - loopTime);
     }
 
-    /* Then, if the tick event doesn't need to be called periodically, wait
-       indefinitely for next input event */
-    if(_flags & Flag::NoTickEvent) SDL_WaitEvent(nullptr);
+    /* Then, if the tick event doesn't need to be called periodically or the
+       application asked for it, wait indefinitely for next input event */
+    if((_flags & Flag::NoTickEvent) || (_loopFlags & LoopFlag::WaitForEvents)) {
+        /* SDL_WaitEvent() pumps the events, which can't be done outside of
+           the main thread, so wait for the main thread to hand over a
+           packet instead */
+        if(_renderThread) {
+            std::unique_lock<std::mutex> lock{_renderThread->mutex};
+            _renderThread->condition.wait(lock, [this]() {
+                return !_renderThread->back.isEmpty();
+            });
+        } else SDL_WaitEvent(nullptr);
+    }
     #endif
     return !(_flags & Flag::Exit);
 }
@@ -1205,6 +1412,57 @@ Sdl2Application::GLConfiguration::GLConfiguration():
 }
 
 Sdl2Application::GLConfiguration::~GLConfiguration() = default;
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+Sdl2Application::SharedGLContext::SharedGLContext(Sdl2Application& application): _window{application._window} {
+    CORRADE_ASSERT(application._glContext,
+        "Platform::Sdl2Application::SharedGLContext: the application has no GL context", );
+
+    /* SDL shares the new context with the one current on this thread and
+       makes the new one current, so make sure the application context is
+       current both before and after */
+    SDL_GL_MakeCurrent(_window, application._glContext);
+    int previousShare;
+    SDL_GL_GetAttribute(SDL_GL_SHARE_WITH_CURRENT_CONTEXT, &previousShare);
+    SDL_GL_SetAttribute(SDL_GL_SHARE_WITH_CURRENT_CONTEXT, 1);
+    _context = SDL_GL_CreateContext(_window);
+    SDL_GL_SetAttribute(SDL_GL_SHARE_WITH_CURRENT_CONTEXT, previousShare);
+    SDL_GL_MakeCurrent(_window, application._glContext);
+
+    if(!_context)
+        Error{} << "Platform::Sdl2Application::SharedGLContext: cannot create context:" << SDL_GetError();
+}
+
+Sdl2Application::SharedGLContext::SharedGLContext(SharedGLContext&& other) noexcept: _window{other._window}, _context{other._context} {
+    other._window = nullptr;
+    other._context = nullptr;
+}
+
+Sdl2Application::SharedGLContext::~SharedGLContext() {
+    if(_context) SDL_GL_DeleteContext(_context);
+}
+
+Sdl2Application::SharedGLContext& Sdl2Application::SharedGLContext::operator=(SharedGLContext&& other) noexcept {
+    using std::swap;
+    swap(other._window, _window);
+    swap(other._context, _context);
+    return *this;
+}
+
+bool Sdl2Application::SharedGLContext::makeCurrent() {
+    if(SDL_GL_MakeCurrent(_window, _context) == 0) return true;
+
+    Error{} << "Platform::Sdl2Application::SharedGLContext::makeCurrent(): cannot make context current:" << SDL_GetError();
+    return false;
+}
+
+bool Sdl2Application::SharedGLContext::release() {
+    if(SDL_GL_MakeCurrent(_window, nullptr) == 0) return true;
+
+    Error{} << "Platform::Sdl2Application::SharedGLContext::release(): cannot release context:" << SDL_GetError();
+    return false;
+}
+#endif
 #endif
 
 Sdl2Application::Configuration::Configuration():
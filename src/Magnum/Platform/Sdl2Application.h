@@ -44,6 +44,10 @@
 #include "Magnum/Platform/GLContext.h"
 #endif
 
+#ifdef MAGNUM_TARGET_VK
+#include "MagnumExternal/Vulkan/flextVk.h"
+#endif
+
 #ifdef CORRADE_TARGET_WINDOWS /* Windows version of SDL2 redefines main(), we don't want that */
 #define SDL_MAIN_HANDLED
 #endif
@@ -480,6 +484,9 @@ class Sdl2Application {
         class Configuration;
         #ifdef MAGNUM_TARGET_GL
         class GLConfiguration;
+        #ifndef CORRADE_TARGET_EMSCRIPTEN
+        class SharedGLContext;
+        #endif
         #endif
         class ExitEvent;
         class ViewportEvent;
@@ -629,6 +636,43 @@ class Sdl2Application {
         SDL_GLContext glContext() { return _glContext; }
         #endif
 
+        #if defined(MAGNUM_TARGET_VK) && !defined(CORRADE_TARGET_EMSCRIPTEN) && (SDL_MAJOR_VERSION*1000 + SDL_MINOR_VERSION*100 + SDL_PATCHLEVEL >= 2006 || defined(DOXYGEN_GENERATING_OUTPUT))
+        /**
+         * @brief Vulkan instance extensions needed for presenting to the window
+         * @m_since_latest
+         *
+         * Returns @vk_extension{KHR,surface} together with the
+         * platform-specific surface extension, to be passed to
+         * @ref Vk::InstanceCreateInfo::addEnabledExtensions(). The views
+         * point to global memory owned by SDL. Expects that the window was
+         * created with @ref Configuration::WindowFlag::Vulkan.
+         * @note This function is available only if Magnum is compiled with
+         *      @ref MAGNUM_TARGET_VK enabled and with SDL 2.0.6+. Not
+         *      available in @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten".
+         * @see @ref Vk-Surface-creation
+         */
+        Containers::Array<Containers::StringView> vkInstanceExtensions();
+
+        /**
+         * @brief Create a Vulkan surface for the window
+         * @m_since_latest
+         *
+         * Expects that the window was created with
+         * @ref Configuration::WindowFlag::Vulkan and that @p instance was
+         * created with extensions listed in @ref vkInstanceExtensions().
+         * Prints a message to @relativeref{Magnum,Error} and returns
+         * @cpp nullptr @ce if the surface can't be created. The returned
+         * surface is owned by the caller, wrap it in a @ref Vk::Surface with
+         * @ref Vk::HandleFlag::DestroyOnDestruction to have it destroyed
+         * automatically.
+         * @note This function is available only if Magnum is compiled with
+         *      @ref MAGNUM_TARGET_VK enabled and with SDL 2.0.6+. Not
+         *      available in @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten".
+         * @see @ref Vk-Surface-creation
+         */
+        VkSurfaceKHR createVkSurface(VkInstance instance);
+        #endif
+
     protected:
         /* Nobody will need to have (and delete) Sdl2Application*, thus this is
            faster than public pure virtual destructor */
@@ -898,6 +942,100 @@ class Sdl2Application {
         void setMinimalLoopPeriod(UnsignedInt milliseconds) {
             _minimalLoopPeriod = milliseconds;
         }
+
+        /**
+         * @brief Main loop flag
+         * @m_since_latest
+         *
+         * @see @ref LoopFlags, @ref setLoopFlags()
+         * @note Not available in @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten",
+         *      the browser is managing the main loop instead.
+         */
+        enum class LoopFlag: UnsignedByte {
+            /**
+             * Process input events once more right before @ref drawEvent(),
+             * after @ref tickEvent() and the @ref LoopFlag::FrameStartDelay,
+             * so the frame reflects the most recent input.
+             */
+            LateInputSampling = 1 << 0,
+
+            /**
+             * Delay the start of @ref drawEvent() so the frame finishes
+             * shortly before the next display refresh instead of right after
+             * the previous one. The delay is based on measured time between
+             * the start of @ref drawEvent() and the @ref swapBuffers() call,
+             * with a quarter of the frame period left as a safety margin. The
+             * frame period is taken from the display refresh rate if VSync is
+             * enabled and from @ref setMinimalLoopPeriod() otherwise; if
+             * neither is set, no delay is done. Combine with
+             * @ref LoopFlag::LateInputSampling to reduce latency between
+             * input and its appearance on the screen. If the frame time
+             * fluctuates a lot, this may result in missed display refreshes.
+             */
+            FrameStartDelay = 1 << 1,
+
+            /**
+             * If @ref redraw() isn't requested, block until the next input
+             * event even if @ref tickEvent() is implemented. By default the
+             * application blocks only if @ref tickEvent() isn't implemented.
+             * Useful for tools that redraw only in response to input, to
+             * avoid draining the battery.
+             */
+            WaitForEvents = 1 << 2,
+
+            /**
+             * Run the main loop on a dedicated render thread. The GL context
+             * is made current on the render thread and all event handlers,
+             * @ref tickEvent() and @ref drawEvent() are called from there as
+             * well, so application code doesn't need any synchronization.
+             * The main thread only pumps window system events and hands them
+             * over to the render thread in double-buffered per-frame packets,
+             * which means operating system stalls such as a modal loop
+             * during window resize or drag don't block rendering. Has to be
+             * set before @ref exec() is called, changing it afterwards has no
+             * effect.
+             *
+             * As the event handlers are no longer called on the main thread,
+             * functionality that SDL restricts to the main thread, such as
+             * @ref setWindowTitle(), @ref setCursor() or
+             * @ref startTextInput(), may not work on all platforms. In
+             * particular, Apple platforms require all window operations to be
+             * done on the main thread, so the flag is ignored there.
+             */
+            RenderThread = 1 << 3
+        };
+
+        /**
+         * @brief Main loop flags
+         * @m_since_latest
+         *
+         * @see @ref setLoopFlags()
+         * @note Not available in @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten",
+         *      the browser is managing the main loop instead.
+         */
+        typedef Containers::EnumSet<LoopFlag> LoopFlags;
+
+        /**
+         * @brief Main loop flags
+         * @m_since_latest
+         *
+         * @note Not available in @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten",
+         *      the browser is managing the main loop instead.
+         */
+        LoopFlags loopFlags() const { return _loopFlags; }
+
+        /**
+         * @brief Set main loop flags
+         * @m_since_latest
+         *
+         * By default no flags are set, meaning input events are processed
+         * once at the start of each main loop iteration, @ref drawEvent() is
+         * called right after and the pacing is controlled only by
+         * @ref setSwapInterval() and @ref setMinimalLoopPeriod().
+         * @note Not available in @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten",
+         *      the browser is managing the main loop instead.
+         */
+        void setLoopFlags(LoopFlags flags) { _loopFlags = flags; }
         #endif
 
         /**
@@ -1226,6 +1364,10 @@ class Sdl2Application {
         typedef Containers::EnumSet<Flag> Flags;
         CORRADE_ENUMSET_FRIEND_OPERATORS(Flags)
 
+        /* Returns false if the application should exit */
+        bool processEvents();
+        bool processEvent(SDL_Event& event);
+
         #ifndef CORRADE_TARGET_EMSCRIPTEN
         SDL_Cursor* _cursors[12]{};
         #else
@@ -1242,6 +1384,14 @@ class Sdl2Application {
         #ifndef CORRADE_TARGET_EMSCRIPTEN
         SDL_Window* _window{};
         UnsignedInt _minimalLoopPeriod;
+        LoopFlags _loopFlags;
+        /* For LoopFlag::FrameStartDelay, in SDL_GetPerformanceCounter() units
+           except for the duration, which is in seconds */
+        Uint64 _drawEventStart{}, _swapEnd{};
+        Double _drawDuration{};
+        /* Non-null only while exec() runs with LoopFlag::RenderThread */
+        struct RenderThread;
+        RenderThread* _renderThread{};
         #else
         SDL_Surface* _surface{};
         Vector2i _lastKnownCanvasSize;
@@ -1541,6 +1691,85 @@ class Sdl2Application::GLConfiguration: public GL::Context::Configuration {
 
 #ifndef CORRADE_TARGET_EMSCRIPTEN
 CORRADE_ENUMSET_OPERATORS(Sdl2Application::GLConfiguration::Flags)
+
+/**
+@brief Shared OpenGL context
+@m_since_latest
+
+OpenGL context sharing objects with the context of a @ref Sdl2Application,
+meant to be made current on a different thread, for example through
+@ref GLWorker. It's created for the application window, using the same
+attributes as the application context.
+@note This class is available only if Magnum is compiled with
+    @ref MAGNUM_TARGET_GL enabled (done by default). See @ref building-features
+    for more information. Not available in
+    @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten".
+*/
+class Sdl2Application::SharedGLContext {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * Expects that the application has a GL context created. The
+         * application context is current on the calling thread after this
+         * function returns. Prints a message to @relativeref{Magnum,Error} if
+         * the context can't be created, use @ref isCreated() to check.
+         */
+        explicit SharedGLContext(Sdl2Application& application);
+
+        /**
+         * @brief Construct without creating the context
+         *
+         * Move an instance with created context over to make it usable.
+         */
+        explicit SharedGLContext(NoCreateT) {}
+
+        /** @brief Copying is not allowed */
+        SharedGLContext(const SharedGLContext&) = delete;
+
+        /** @brief Move constructor */
+        SharedGLContext(SharedGLContext&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Destroys the context, if any. The context is expected to not be
+         * current on any thread.
+         */
+        ~SharedGLContext();
+
+        /** @brief Copying is not allowed */
+        SharedGLContext& operator=(const SharedGLContext&) = delete;
+
+        /** @brief Move assignment */
+        SharedGLContext& operator=(SharedGLContext&& other) noexcept;
+
+        /** @brief Whether the context is created */
+        bool isCreated() const { return _context; }
+
+        /**
+         * @brief Make the context current
+         *
+         * Prints a message to @relativeref{Magnum,Error} and returns
+         * @cpp false @ce on failure, otherwise returns @cpp true @ce.
+         */
+        bool makeCurrent();
+
+        /**
+         * @brief Release the context
+         *
+         * Prints a message to @relativeref{Magnum,Error} and returns
+         * @cpp false @ce on failure, otherwise returns @cpp true @ce.
+         */
+        bool release();
+
+        /** @brief Underlying OpenGL context */
+        SDL_GLContext glContext() { return _context; }
+
+    private:
+        SDL_Window* _window{};
+        SDL_GLContext _context{};
+};
 #endif
 #endif
 
@@ -2944,6 +3173,9 @@ typedef BasicScreenedApplication<Sdl2Application> ScreenedApplication;
 #endif
 #endif
 
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+CORRADE_ENUMSET_OPERATORS(Sdl2Application::LoopFlags)
+#endif
 CORRADE_ENUMSET_OPERATORS(Sdl2Application::Configuration::WindowFlags)
 CORRADE_ENUMSET_OPERATORS(Sdl2Application::InputEvent::Modifiers)
 CORRADE_ENUMSET_OPERATORS(Sdl2Application::MouseMoveEvent::Buttons)
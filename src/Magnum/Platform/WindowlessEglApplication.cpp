@@ -29,6 +29,10 @@
 
 #include <cstring> /** @todo used by extensionSupported(), cleann up */
 #include <string>
+#ifdef CORRADE_BUILD_MULTITHREADED
+#include <atomic>
+#include <thread>
+#endif
 #include <Corrade/Utility/Arguments.h>
 #include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/Debug.h>
@@ -89,6 +93,35 @@ bool extensionSupported(const char* const extensions, Containers::ArrayView<cons
     return pos && (pos[extension.size() - 1] == ' ' || pos[extension.size() - 1] == '\0');
 }
 
+bool deviceEnumerationSupported(const char* const extensions) {
+    return extensions &&
+        /* eglQueryDevicesEXT(). NVidia exposes only EGL_EXT_device_base,
+           which is an older version of EGL_EXT_device_enumeration before it
+           got split to that and EGL_EXT_device_query, so test for both. */
+        (extensionSupported(extensions, "EGL_EXT_device_enumeration") || extensionSupported(extensions, "EGL_EXT_device_base")) &&
+
+        /* eglGetPlatformDisplayEXT() */
+        extensionSupported(extensions, "EGL_EXT_platform_base") &&
+
+        /* EGL_PLATFORM_DEVICE_EXT (FFS, why it has to be scattered over a
+           thousand extensions?!). This is supported only since Mesa 19.2. */
+        extensionSupported(extensions, "EGL_EXT_platform_device");
+}
+
+}
+
+UnsignedInt WindowlessEglContext::deviceCount() {
+    if(!deviceEnumerationSupported(eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS)))
+        return 1;
+
+    EGLint count;
+    auto eglQueryDevices = reinterpret_cast<EGLBoolean(*)(EGLint, EGLDeviceEXT*, EGLint*)>(eglGetProcAddress("eglQueryDevicesEXT"));
+    if(!eglQueryDevices(0, nullptr, &count)) {
+        Error{} << "Platform::WindowlessEglContext::deviceCount(): cannot query EGL devices:" << Implementation::eglErrorString(eglGetError());
+        return 0;
+    }
+
+    return count;
 }
 #endif
 
@@ -117,19 +150,7 @@ WindowlessEglContext::WindowlessEglContext(const Configuration& configuration, G
            version parsing from a string. Not feeling like doing that today,
            no. */
         const char* const extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
-        if(extensions &&
-            /* eglQueryDevicesEXT(). NVidia exposes only EGL_EXT_device_base,
-               which is an older version of EGL_EXT_device_enumeration before
-               it got split to that and EGL_EXT_device_query, so test for both. */
-            (extensionSupported(extensions, "EGL_EXT_device_enumeration") || extensionSupported(extensions, "EGL_EXT_device_base")) &&
-
-            /* eglGetPlatformDisplayEXT() */
-            extensionSupported(extensions, "EGL_EXT_platform_base") &&
-
-            /* EGL_PLATFORM_DEVICE_EXT (FFS, why it has to be scattered over a
-               thousand extensions?!). This is supported only since Mesa 19.2. */
-            extensionSupported(extensions, "EGL_EXT_platform_device")
-        ) {
+        if(deviceEnumerationSupported(extensions)) {
             /* When libEGL_nvidia.so is present on a system w/o a NV GPU,
                eglQueryDevicesEXT() fails there with EGL_BAD_ALLOC, but that is
                never propagated to the glvnd wrapper. Enable debug output if
@@ -607,6 +628,136 @@ WindowlessEglContext::Configuration::Configuration()
     #endif
 }
 
+#ifndef MAGNUM_TARGET_WEBGL
+WindowlessEglContextPool::WindowlessEglContextPool(const std::initializer_list<UnsignedInt> devices, const UnsignedInt contextsPerDevice, const WindowlessEglContext::Configuration& configuration): WindowlessEglContextPool{Containers::arrayView(devices), contextsPerDevice, configuration} {}
+
+WindowlessEglContextPool::WindowlessEglContextPool(const Containers::ArrayView<const UnsignedInt> devices, const UnsignedInt contextsPerDevice, const WindowlessEglContext::Configuration& configuration) {
+    /* If no devices are specified, use all */
+    Containers::Array<UnsignedInt> allDevices;
+    Containers::ArrayView<const UnsignedInt> usedDevices = devices;
+    if(devices.isEmpty()) {
+        allDevices = Containers::Array<UnsignedInt>{NoInit, WindowlessEglContext::deviceCount()};
+        for(std::size_t i = 0; i != allDevices.size(); ++i)
+            allDevices[i] = UnsignedInt(i);
+        usedDevices = allDevices;
+    }
+
+    const std::size_t count = usedDevices.size()*contextsPerDevice;
+    if(!count) {
+        Error{} << "Platform::WindowlessEglContextPool: no contexts to create";
+        return;
+    }
+
+    Containers::Array<WindowlessEglContext> eglContexts{DirectInit, count, NoCreate};
+    Containers::Array<GLContext> glContexts{DirectInit, count, NoCreate};
+    Containers::Array<UnsignedInt> contextDevices{NoInit, count};
+    for(std::size_t i = 0; i != usedDevices.size(); ++i) {
+        for(std::size_t j = 0; j != contextsPerDevice; ++j) {
+            const std::size_t id = i*contextsPerDevice + j;
+            contextDevices[id] = usedDevices[i];
+
+            /* The first context on given device initializes the display, the
+               others are shared with it */
+            WindowlessEglContext::Configuration contextConfiguration{configuration};
+            contextConfiguration
+                .setDevice(usedDevices[i])
+                .setSharedContext(EGL_NO_DISPLAY, EGL_NO_CONTEXT);
+            if(j) {
+                WindowlessEglContext& first = eglContexts[i*contextsPerDevice];
+                contextConfiguration.setSharedContext(first.display(), first.glContext());
+            }
+
+            eglContexts[id] = WindowlessEglContext{contextConfiguration, &glContexts[id]};
+            if(!eglContexts[id].isCreated() || !eglContexts[id].makeCurrent() || !glContexts[id].tryCreate(contextConfiguration)) {
+                Error{} << "Platform::WindowlessEglContextPool: cannot create context" << j << "on device" << usedDevices[i];
+
+                /* Destroy the already created ones in reverse order, see the
+                   destructor for details */
+                GL::Context::makeCurrent(nullptr);
+                glContexts = nullptr;
+                for(std::size_t k = id + 1; k; --k) {
+                    WindowlessEglContext destroyed{NoCreate};
+                    destroyed = std::move(eglContexts[k - 1]);
+                }
+                return;
+            }
+
+            eglContexts[id].release();
+        }
+    }
+
+    GL::Context::makeCurrent(nullptr);
+    _eglContexts = std::move(eglContexts);
+    _glContexts = std::move(glContexts);
+    _devices = std::move(contextDevices);
+}
+
+WindowlessEglContextPool::~WindowlessEglContextPool() {
+    /* The first context on each device owns the display and calls
+       eglTerminate() on destruction, so it has to be destroyed only after
+       all contexts shared with it */
+    _glContexts = nullptr;
+    for(std::size_t i = _eglContexts.size(); i; --i) {
+        WindowlessEglContext destroyed{NoCreate};
+        destroyed = std::move(_eglContexts[i - 1]);
+    }
+}
+
+UnsignedInt WindowlessEglContextPool::device(const std::size_t id) const {
+    CORRADE_ASSERT(id < _devices.size(),
+        "Platform::WindowlessEglContextPool::device(): index" << id << "out of range for" << _devices.size() << "contexts", {});
+    return _devices[id];
+}
+
+WindowlessEglContext& WindowlessEglContextPool::context(const std::size_t id) {
+    CORRADE_ASSERT(id < _eglContexts.size(),
+        "Platform::WindowlessEglContextPool::context(): index" << id << "out of range for" << _eglContexts.size() << "contexts", _eglContexts[0]);
+    return _eglContexts[id];
+}
+
+GLContext& WindowlessEglContextPool::glContext(const std::size_t id) {
+    CORRADE_ASSERT(id < _glContexts.size(),
+        "Platform::WindowlessEglContextPool::glContext(): index" << id << "out of range for" << _glContexts.size() << "contexts", _glContexts[0]);
+    return _glContexts[id];
+}
+
+void WindowlessEglContextPool::run(const std::size_t jobCount, void(*const job)(void*, std::size_t, std::size_t), void* const state) {
+    CORRADE_ASSERT(isCreated(),
+        "Platform::WindowlessEglContextPool::run(): no contexts created", );
+
+    #ifdef CORRADE_BUILD_MULTITHREADED
+    /* Jobs can take vastly different time, so instead of splitting them into
+       fixed chunks each context picks the next unprocessed one */
+    std::atomic<std::size_t> next{0};
+    const auto worker = [&](const std::size_t context) {
+        if(!_eglContexts[context].makeCurrent()) return;
+        GL::Context::makeCurrent(&_glContexts[context]);
+        for(std::size_t i; (i = next++) < jobCount; )
+            job(state, context, i);
+        GL::Context::makeCurrent(nullptr);
+        _eglContexts[context].release();
+    };
+
+    Containers::Array<std::thread> threads{_eglContexts.size()};
+    for(std::size_t i = 0; i != threads.size(); ++i)
+        threads[i] = std::thread{worker, i};
+    for(std::thread& thread: threads)
+        thread.join();
+    #else
+    /* The current GL::Context is a global, so the contexts can't be used from
+       multiple threads at once. Alternate between them at least. */
+    for(std::size_t i = 0; i != jobCount; ++i) {
+        const std::size_t context = i % _eglContexts.size();
+        if(!_eglContexts[context].makeCurrent()) continue;
+        GL::Context::makeCurrent(&_glContexts[context]);
+        job(state, context, i);
+    }
+    GL::Context::makeCurrent(nullptr);
+    _eglContexts[0].release();
+    #endif
+}
+#endif
+
 #ifndef DOXYGEN_GENERATING_OUTPUT
 WindowlessEglApplication::WindowlessEglApplication(const Arguments& arguments): WindowlessEglApplication{arguments, Configuration{}} {}
 #endif
@@ -28,7 +28,7 @@
 */
 
 /** @file
- * @brief Class @ref Magnum::Platform::WindowlessEglApplication, @ref Magnum::Platform::WindowlessEglContext, macro @ref MAGNUM_WINDOWLESSEGLAPPLICATION_MAIN()
+ * @brief Class @ref Magnum::Platform::WindowlessEglApplication, @ref Magnum::Platform::WindowlessEglContext, @ref Magnum::Platform::WindowlessEglContextPool, macro @ref MAGNUM_WINDOWLESSEGLAPPLICATION_MAIN()
  */
 
 #include "Magnum/configure.h"
@@ -49,6 +49,7 @@
 #undef Button3
 #undef Button4
 #undef Button5
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/EnumSet.h>
 #include <Corrade/Containers/Optional.h>
 
@@ -84,6 +85,24 @@ class WindowlessEglContext {
     public:
         class Configuration;
 
+        #ifndef MAGNUM_TARGET_WEBGL
+        /**
+         * @brief Count of available EGL devices
+         * @m_since_latest
+         *
+         * If
+         * [EGL_EXT_device_enumeration](https://www.khronos.org/registry/EGL/extensions/EXT/EGL_EXT_device_enumeration.txt)
+         * together with
+         * [EGL_EXT_platform_device](https://www.khronos.org/registry/EGL/extensions/EXT/EGL_EXT_platform_device.txt)
+         * isn't supported, returns @cpp 1 @ce for the default display. If
+         * the device query fails, prints a message to @relativeref{Magnum,Error}
+         * and returns @cpp 0 @ce.
+         * @see @ref Configuration::setDevice(), @ref WindowlessEglContextPool
+         * @note Not available on @ref MAGNUM_TARGET_WEBGL "WebGL".
+         */
+        static UnsignedInt deviceCount();
+        #endif
+
         /**
          * @brief Constructor
          * @param configuration Context configuration
@@ -158,6 +177,16 @@ class WindowlessEglContext {
          */
         EGLContext glContext() { return _context; }
 
+        /**
+         * @brief Display the context is created on
+         * @m_since_latest
+         *
+         * Together with @ref glContext() meant to be passed to
+         * @ref Configuration::setSharedContext(). Returns @cpp nullptr @ce in
+         * case the context was not created yet.
+         */
+        EGLDisplay display() { return _display; }
+
     private:
         #ifndef MAGNUM_TARGET_WEBGL
         bool _sharedContext = false;
@@ -416,6 +445,137 @@ class WindowlessEglContext::Configuration: public GL::Context::Configuration {
 
 #ifndef MAGNUM_TARGET_WEBGL
 CORRADE_ENUMSET_OPERATORS(WindowlessEglContext::Configuration::Flags)
+
+/**
+@brief Pool of windowless EGL contexts
+@m_since_latest
+
+Creates multiple @ref WindowlessEglContext instances, possibly spread over
+multiple EGL devices, together with a @ref GLContext for each, and distributes
+jobs across them. Meant for headless rendering servers where a single context
+per process leaves most of the GPUs idle:
+
+@snippet MagnumPlatform-windowless-thread.cpp pool
+
+Contexts on the same device share a single `EGLDisplay` and are created as
+shared with the first one on given device, so GL objects such as shaders or
+textures created in one of them are usable in all others on the same device.
+Contexts on different devices don't share anything.
+
+Each call to @ref run() makes every context current on its own thread and
+the threads then pick jobs one by one until all are processed, so jobs of
+varying complexity are balanced across the contexts. The calling thread only
+waits for the jobs to finish. Since the @ref GL::Context::current() instance
+is thread-local only if Corrade is built with
+@ref CORRADE_BUILD_MULTITHREADED, the jobs are executed sequentially on the
+calling thread otherwise, alternating between the contexts.
+
+Both the construction and @ref run() change the EGL and @ref GL::Context
+current on the calling thread, and no context is current after they return.
+@note Not available on @ref MAGNUM_TARGET_WEBGL "WebGL".
+*/
+class WindowlessEglContextPool {
+    public:
+        /**
+         * @brief Constructor
+         * @param devices           EGL device IDs to create the contexts
+         *      on. If empty, all devices reported by
+         *      @ref WindowlessEglContext::deviceCount() are used.
+         * @param contextsPerDevice Count of contexts to create on each device
+         * @param configuration     Context configuration. The
+         *      @ref WindowlessEglContext::Configuration::setDevice() "device"
+         *      and @ref WindowlessEglContext::Configuration::setSharedContext() "shared context"
+         *      properties are overwritten.
+         *
+         * If creation of any context fails, all already created contexts are
+         * destroyed and @ref isCreated() returns @cpp false @ce.
+         */
+        explicit WindowlessEglContextPool(Containers::ArrayView<const UnsignedInt> devices, UnsignedInt contextsPerDevice, const WindowlessEglContext::Configuration& configuration);
+
+        /** @overload */
+        explicit WindowlessEglContextPool(std::initializer_list<UnsignedInt> devices, UnsignedInt contextsPerDevice, const WindowlessEglContext::Configuration& configuration);
+
+        /** @brief Copying is not allowed */
+        WindowlessEglContextPool(const WindowlessEglContextPool&) = delete;
+
+        /** @brief Moving is not allowed */
+        WindowlessEglContextPool(WindowlessEglContextPool&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Destroys the contexts in reverse order of their creation, so the
+         * first context on each device, which owns the `EGLDisplay`, is
+         * destroyed last.
+         */
+        ~WindowlessEglContextPool();
+
+        /** @brief Copying is not allowed */
+        WindowlessEglContextPool& operator=(const WindowlessEglContextPool&) = delete;
+
+        /** @brief Moving is not allowed */
+        WindowlessEglContextPool& operator=(WindowlessEglContextPool&&) = delete;
+
+        /** @brief Whether the contexts are created */
+        bool isCreated() const { return !_eglContexts.isEmpty(); }
+
+        /** @brief Context count */
+        std::size_t size() const { return _eglContexts.size(); }
+
+        /**
+         * @brief EGL device ID of given context
+         *
+         * Expects that @p id is less than @ref size().
+         */
+        UnsignedInt device(std::size_t id) const;
+
+        /**
+         * @brief Context
+         *
+         * Expects that @p id is less than @ref size(). Use for example to
+         * create a shared context on the same device, or to access the
+         * context from outside of @ref run().
+         */
+        WindowlessEglContext& context(std::size_t id);
+
+        /**
+         * @brief Magnum context
+         *
+         * Expects that @p id is less than @ref size().
+         */
+        GLContext& glContext(std::size_t id);
+
+        /**
+         * @brief Run jobs
+         * @param jobCount  Job count
+         * @param job       Job function. Called with @p state, ID of the
+         *      context that's current and ID of the job.
+         * @param state     State passed to @p job
+         *
+         * Blocks until all jobs are done. Expects that the contexts are
+         * created. A job is executed with both the EGL context and its
+         * @ref GLContext current, and the functions may be called from
+         * multiple threads at the same time, each with a different context.
+         */
+        void run(std::size_t jobCount, void(*job)(void*, std::size_t, std::size_t), void* state);
+
+        /**
+         * @brief Run jobs
+         *
+         * Convenience overload taking a functor that's called with ID of the
+         * context that's current and ID of the job.
+         */
+        template<class F> void run(std::size_t jobCount, F job) {
+            run(jobCount, [](void* state, std::size_t context, std::size_t id) {
+                (*static_cast<F*>(state))(context, id);
+            }, &job);
+        }
+
+    private:
+        Containers::Array<WindowlessEglContext> _eglContexts;
+        Containers::Array<GLContext> _glContexts;
+        Containers::Array<UnsignedInt> _devices;
+};
 #endif
 
 /**
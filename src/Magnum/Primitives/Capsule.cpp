@@ -111,7 +111,10 @@ Trade::MeshData capsule3DSolid(const UnsignedInt hemisphereRings, const Unsigned
         "Primitives::capsule3DSolid(): at least one hemisphere ring, one cylinder ring and three segments expected",
         (Trade::MeshData{MeshPrimitive::Triangles, 0}));
 
-    Implementation::Spheroid capsule{segments, Implementation::Spheroid::Flag(UnsignedByte(flags))};
+    const Implementation::Spheroid::Flags spheroidFlags = Implementation::Spheroid::Flag(UnsignedByte(flags));
+    Implementation::Spheroid capsule{segments, spheroidFlags,
+        Implementation::Spheroid::vertexCount(segments, spheroidFlags, 2*(hemisphereRings - 1) + cylinderRings + 1, 2),
+        Implementation::Spheroid::indexCount(segments, hemisphereRings*2 - 2 + cylinderRings, 2)};
 
     Float height = 2.0f+2.0f*halfLength;
     Float hemisphereTextureCoordsVIncrement = 1.0f/(hemisphereRings*height);
@@ -38,7 +38,10 @@ Trade::MeshData coneSolid(const UnsignedInt rings, const UnsignedInt segments, c
         "Primitives::coneSolid(): at least one ring and three segments expected",
         (Trade::MeshData{MeshPrimitive::Triangles, 0}));
 
-    Implementation::Spheroid cone{segments, Implementation::Spheroid::Flag(UnsignedByte(flags))};
+    const Implementation::Spheroid::Flags spheroidFlags = Implementation::Spheroid::Flag(UnsignedByte(flags));
+    Implementation::Spheroid cone{segments, spheroidFlags,
+        Implementation::Spheroid::vertexCount(segments, spheroidFlags, rings + 1 + (flags & ConeFlag::CapEnd ? 1 : 0), flags & ConeFlag::CapEnd ? 1 : 0),
+        Implementation::Spheroid::indexCount(segments, rings, flags & ConeFlag::CapEnd ? 1 : 0)};
 
     const Float length = 2.0f*halfLength;
     const Float textureCoordsV = flags & ConeFlag::CapEnd ? 1.0f/(length + 1.0f) : 0.0f;
@@ -25,6 +25,8 @@
 
 #include "Cylinder.h"
 
+#include <Corrade/Containers/StridedArrayView.h>
+
 #include "Magnum/Mesh.h"
 #include "Magnum/Math/Color.h"
 #include "Magnum/Primitives/Implementation/Spheroid.h"
@@ -33,13 +35,9 @@
 
 namespace Magnum { namespace Primitives {
 
-Trade::MeshData cylinderSolid(const UnsignedInt rings, const UnsignedInt segments, const Float halfLength, const CylinderFlags flags) {
-    CORRADE_ASSERT(rings >= 1 && segments >= 3,
-        "Primitives::cylinderSolid(): at least one ring and three segments expected",
-        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
-
-    Implementation::Spheroid cylinder{segments, Implementation::Spheroid::Flag(UnsignedByte(flags))};
+namespace {
 
+void cylinderSolidGenerate(Implementation::Spheroid& cylinder, const UnsignedInt rings, const UnsignedInt segments, const Float halfLength, const CylinderFlags flags) {
     const Float length = 2.0f*halfLength;
     const Float textureCoordsV = flags & CylinderFlag::CapEnds ? 1.0f/(length+2.0f) : 0.0f;
 
@@ -67,10 +65,51 @@ Trade::MeshData cylinderSolid(const UnsignedInt rings, const UnsignedInt segment
     else
         cylinder.faceRings(rings, 0);
     if(flags & CylinderFlag::CapEnds) cylinder.topFaceRing();
+}
+
+}
+
+UnsignedInt cylinderSolidVertexCount(const UnsignedInt rings, const UnsignedInt segments, const CylinderFlags flags) {
+    CORRADE_ASSERT(rings >= 1 && segments >= 3,
+        "Primitives::cylinderSolidVertexCount(): at least one ring and three segments expected", {});
+    const UnsignedInt caps = flags & CylinderFlag::CapEnds ? 2 : 0;
+    return Implementation::Spheroid::vertexCount(segments, Implementation::Spheroid::Flag(UnsignedByte(flags)), rings + 1 + caps, caps);
+}
 
+UnsignedInt cylinderSolidIndexCount(const UnsignedInt rings, const UnsignedInt segments, const CylinderFlags flags) {
+    CORRADE_ASSERT(rings >= 1 && segments >= 3,
+        "Primitives::cylinderSolidIndexCount(): at least one ring and three segments expected", {});
+    return Implementation::Spheroid::indexCount(segments, rings, flags & CylinderFlag::CapEnds ? 2 : 0);
+}
+
+Trade::MeshData cylinderSolid(const UnsignedInt rings, const UnsignedInt segments, const Float halfLength, const CylinderFlags flags) {
+    CORRADE_ASSERT(rings >= 1 && segments >= 3,
+        "Primitives::cylinderSolid(): at least one ring and three segments expected",
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+
+    Implementation::Spheroid cylinder{segments, Implementation::Spheroid::Flag(UnsignedByte(flags)),
+        cylinderSolidVertexCount(rings, segments, flags),
+        cylinderSolidIndexCount(rings, segments, flags)};
+    cylinderSolidGenerate(cylinder, rings, segments, halfLength, flags);
     return cylinder.finalize();
 }
 
+void cylinderSolidInto(const UnsignedInt rings, const UnsignedInt segments, const Float halfLength, const CylinderFlags flags, const Containers::StridedArrayView1D<Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals, const Containers::StridedArrayView1D<Vector4>& tangents, const Containers::StridedArrayView1D<Vector2>& textureCoordinates, const Containers::StridedArrayView1D<UnsignedInt>& indices) {
+    CORRADE_ASSERT(rings >= 1 && segments >= 3,
+        "Primitives::cylinderSolidInto(): at least one ring and three segments expected", );
+
+    const Implementation::Spheroid::Flags spheroidFlags = Implementation::Spheroid::Flag(UnsignedByte(flags));
+    if(!Implementation::Spheroid::checkSizes("cylinderSolidInto", spheroidFlags,
+        cylinderSolidVertexCount(rings, segments, flags),
+        cylinderSolidIndexCount(rings, segments, flags),
+        positions, normals, tangents, textureCoordinates, indices))
+        return;
+
+    Implementation::Spheroid cylinder{segments, spheroidFlags, positions, normals, tangents, textureCoordinates, indices};
+    cylinderSolidGenerate(cylinder, rings, segments, halfLength, flags);
+    cylinder.finish();
+}
+
 Trade::MeshData cylinderWireframe(const UnsignedInt rings, const UnsignedInt segments, const Float halfLength) {
     CORRADE_ASSERT(rings >= 1 && segments >= 4 && segments%4 == 0,
         "Primitives::cylinderWireframe(): at least one ring and multiples of 4 segments expected",
@@ -26,7 +26,7 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::Primitives::cylinderSolid(), @ref Magnum::Primitives::cylinderWireframe()
+ * @brief Function @ref Magnum::Primitives::cylinderSolid(), @ref Magnum::Primitives::cylinderSolidVertexCount(), @ref Magnum::Primitives::cylinderSolidIndexCount(), @ref Magnum::Primitives::cylinderSolidInto(), @ref Magnum::Primitives::cylinderWireframe()
  */
 
 #include <Corrade/Containers/EnumSet.h>
@@ -101,10 +101,45 @@ The cylinder is by default created with radius set to @f$ 1.0 @f$. In order to
 get radius @f$ r @f$, length @f$ l @f$ and preserve correct normals, set
 @p halfLength to @f$ 0.5 \frac{l}{r} @f$ and then scale all positions by
 @f$ r @f$, for example using @ref MeshTools::transform3D().
-@see @ref cylinderWireframe(), @ref coneSolid()
+@see @ref cylinderWireframe(), @ref coneSolid(), @ref cylinderSolidInto()
 */
 MAGNUM_PRIMITIVES_EXPORT Trade::MeshData cylinderSolid(UnsignedInt rings, UnsignedInt segments, Float halfLength, CylinderFlags flags = {});
 
+/**
+@brief Vertex count of a solid 3D cylinder
+@m_since_latest
+
+Count of vertices generated by @ref cylinderSolid() and expected by
+@ref cylinderSolidInto(). Expects the same @p rings and @p segments
+constraints as @ref cylinderSolid().
+*/
+MAGNUM_PRIMITIVES_EXPORT UnsignedInt cylinderSolidVertexCount(UnsignedInt rings, UnsignedInt segments, CylinderFlags flags = {});
+
+/**
+@brief Index count of a solid 3D cylinder
+@m_since_latest
+
+Count of indices generated by @ref cylinderSolid() and expected by
+@ref cylinderSolidInto(). Expects the same @p rings and @p segments
+constraints as @ref cylinderSolid().
+*/
+MAGNUM_PRIMITIVES_EXPORT UnsignedInt cylinderSolidIndexCount(UnsignedInt rings, UnsignedInt segments, CylinderFlags flags = {});
+
+/**
+@brief Solid 3D cylinder into existing views
+@m_since_latest
+
+A variant of @ref cylinderSolid() that fills existing memory instead of
+allocating a new @ref Trade::MeshData. The @p positions and @p normals are
+expected to have @ref cylinderSolidVertexCount() items. The @p tangents and
+@p textureCoordinates are expected to have the same size if
+@ref CylinderFlag::Tangents or @relativeref{CylinderFlag,TextureCoordinates}
+is set and to be empty otherwise. The @p indices are expected to have
+@ref cylinderSolidIndexCount() items. The generated data are the same as with
+@ref cylinderSolid().
+*/
+MAGNUM_PRIMITIVES_EXPORT void cylinderSolidInto(UnsignedInt rings, UnsignedInt segments, Float halfLength, CylinderFlags flags, const Containers::StridedArrayView1D<Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals, const Containers::StridedArrayView1D<Vector4>& tangents, const Containers::StridedArrayView1D<Vector2>& textureCoordinates, const Containers::StridedArrayView1D<UnsignedInt>& indices);
+
 /**
 @brief Wireframe 3D cylinder
 @param rings        Number of (line) rings. Must be larger or equal to
@@ -31,13 +31,13 @@
 
 namespace Magnum { namespace Primitives {
 
-Trade::MeshData grid3DSolid(const Vector2i& subdivisions, const GridFlags flags) {
+namespace {
+
+void grid3DSolidGenerate(const Vector2i& subdivisions, const Containers::StridedArrayView1D<Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals, const Containers::StridedArrayView1D<Vector4>& tangents, const Containers::StridedArrayView1D<Vector2>& textureCoordinates, const Containers::StridedArrayView1D<UnsignedInt>& indices) {
     const Vector2i vertexCount = subdivisions + Vector2i{2};
     const Vector2i faceCount = subdivisions + Vector2i{1};
 
     /* Indices */
-    Containers::Array<char> indexData{std::size_t(faceCount.product()*6)*sizeof(UnsignedInt)};
-    auto indices = Containers::arrayCast<UnsignedInt>(indexData);
     {
         std::size_t i = 0;
         for(Int y = 0; y != faceCount.y(); ++y) {
@@ -56,6 +56,41 @@ Trade::MeshData grid3DSolid(const Vector2i& subdivisions, const GridFlags flags)
         }
     }
 
+    /* Positions */
+    {
+        std::size_t i = 0;
+        for(Int y = 0; y != vertexCount.y(); ++y)
+            for(Int x = 0; x != vertexCount.x(); ++x)
+                positions[i++] = {(Vector2(x, y)/Vector2(faceCount))*2.0f - Vector2{1.0f}, 0.0f};
+    }
+
+    /* Normals and tangents, if any. Those are the same for all. The views
+       are empty if the attribute isn't requested. */
+    for(Vector3& i: normals) i = Vector3::zAxis(1.0f);
+    for(Vector4& i: tangents) i = {1.0f, 0.0f, 0.0f, 1.0f};
+
+    /* Texture coordinates, if any */
+    for(std::size_t i = 0; i != textureCoordinates.size(); ++i)
+        textureCoordinates[i] = positions[i].xy()*0.5f + Vector2{0.5f};
+}
+
+}
+
+UnsignedInt grid3DSolidVertexCount(const Vector2i& subdivisions) {
+    return (subdivisions + Vector2i{2}).product();
+}
+
+UnsignedInt grid3DSolidIndexCount(const Vector2i& subdivisions) {
+    return (subdivisions + Vector2i{1}).product()*6;
+}
+
+Trade::MeshData grid3DSolid(const Vector2i& subdivisions, const GridFlags flags) {
+    const UnsignedInt vertexCount = grid3DSolidVertexCount(subdivisions);
+
+    /* Indices */
+    Containers::Array<char> indexData{Containers::NoInit, grid3DSolidIndexCount(subdivisions)*sizeof(UnsignedInt)};
+    auto indices = Containers::arrayCast<UnsignedInt>(indexData);
+
     /* Calculate attribute count and vertex size */
     std::size_t stride = sizeof(Vector3);
     std::size_t attributeCount = 1;
@@ -71,64 +106,85 @@ Trade::MeshData grid3DSolid(const Vector2i& subdivisions, const GridFlags flags)
         stride += sizeof(Vector2);
         ++attributeCount;
     }
-    Containers::Array<char> vertexData{stride*vertexCount.product()};
+    Containers::Array<char> vertexData{stride*vertexCount};
     Containers::Array<Trade::MeshAttributeData> attributes{attributeCount};
     std::size_t attributeIndex = 0;
     std::size_t attributeOffset = 0;
 
-    /* Fill positions */
     Containers::StridedArrayView1D<Vector3> positions{vertexData,
         reinterpret_cast<Vector3*>(vertexData.begin()),
-        std::size_t(vertexCount.product()), std::ptrdiff_t(stride)};
+        vertexCount, std::ptrdiff_t(stride)};
     attributes[attributeIndex++] =
         Trade::MeshAttributeData{Trade::MeshAttribute::Position, positions};
     attributeOffset += sizeof(Vector3);
-    {
-        std::size_t i = 0;
-        for(Int y = 0; y != vertexCount.y(); ++y)
-            for(Int x = 0; x != vertexCount.x(); ++x)
-                positions[i++] = {(Vector2(x, y)/Vector2(faceCount))*2.0f - Vector2{1.0f}, 0.0f};
-    }
 
-    /* Fill normals and tangents, if any. Those are the same for all. */
+    Containers::StridedArrayView1D<Vector3> normals;
     if(flags & GridFlag::Normals) {
-        Containers::StridedArrayView1D<Vector3> normals{vertexData,
+        normals = Containers::StridedArrayView1D<Vector3>{vertexData,
             reinterpret_cast<Vector3*>(vertexData.begin() + attributeOffset),
-            std::size_t(vertexCount.product()), std::ptrdiff_t(stride)};
+            vertexCount, std::ptrdiff_t(stride)};
         attributes[attributeIndex++] =
             Trade::MeshAttributeData{Trade::MeshAttribute::Normal, normals};
         attributeOffset += sizeof(Vector3);
-        for(auto&& i: normals) i = Vector3::zAxis(1.0f);
     }
+
+    Containers::StridedArrayView1D<Vector4> tangents;
     if(flags & GridFlag::Tangents) {
-        Containers::StridedArrayView1D<Vector4> tangents{vertexData,
+        tangents = Containers::StridedArrayView1D<Vector4>{vertexData,
             reinterpret_cast<Vector4*>(vertexData.begin() + attributeOffset),
-            std::size_t(vertexCount.product()), std::ptrdiff_t(stride)};
+            vertexCount, std::ptrdiff_t(stride)};
         attributes[attributeIndex++] =
             Trade::MeshAttributeData{Trade::MeshAttribute::Tangent, tangents};
         attributeOffset += sizeof(Vector4);
-        for(auto&& i: tangents) i = {1.0f, 0.0f, 0.0f, 1.0f};
     }
 
+    Containers::StridedArrayView1D<Vector2> textureCoords;
     if(flags & GridFlag::TextureCoordinates) {
-        Containers::StridedArrayView1D<Vector2> textureCoords{vertexData,
+        textureCoords = Containers::StridedArrayView1D<Vector2>{vertexData,
             reinterpret_cast<Vector2*>(vertexData.begin() + attributeOffset),
-            std::size_t(vertexCount.product()), std::ptrdiff_t(stride)};
+            vertexCount, std::ptrdiff_t(stride)};
         attributes[attributeIndex++] =
             Trade::MeshAttributeData{Trade::MeshAttribute::TextureCoordinates, textureCoords};
         attributeOffset += sizeof(Vector2);
-        for(std::size_t i = 0; i != positions.size(); ++i)
-            textureCoords[i] = positions[i].xy()*0.5f + Vector2{0.5f};
     }
 
     CORRADE_INTERNAL_ASSERT(attributeIndex == attributeCount);
     CORRADE_INTERNAL_ASSERT(attributeOffset == stride);
 
+    grid3DSolidGenerate(subdivisions, positions, normals, tangents, textureCoords, indices);
+
     return Trade::MeshData{MeshPrimitive::Triangles,
         std::move(indexData), Trade::MeshIndexData{indices},
         std::move(vertexData), std::move(attributes)};
 }
 
+void grid3DSolidInto(const Vector2i& subdivisions, const GridFlags flags, const Containers::StridedArrayView1D<Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals, const Containers::StridedArrayView1D<Vector4>& tangents, const Containers::StridedArrayView1D<Vector2>& textureCoordinates, const Containers::StridedArrayView1D<UnsignedInt>& indices) {
+    #ifndef CORRADE_NO_ASSERT
+    const UnsignedInt vertexCount = grid3DSolidVertexCount(subdivisions);
+    const UnsignedInt indexCount = grid3DSolidIndexCount(subdivisions);
+    #endif
+    CORRADE_ASSERT(positions.size() == vertexCount,
+        "Primitives::grid3DSolidInto(): expected" << vertexCount << "positions but got" << positions.size(), );
+    #ifndef CORRADE_NO_ASSERT
+    const UnsignedInt expectedNormalCount = flags & GridFlag::Normals ? vertexCount : 0;
+    const UnsignedInt expectedTangentCount = flags & GridFlag::Tangents ? vertexCount : 0;
+    const UnsignedInt expectedTextureCoordinateCount = flags & GridFlag::TextureCoordinates ? vertexCount : 0;
+    #endif
+    CORRADE_ASSERT(normals.size() == expectedNormalCount,
+        "Primitives::grid3DSolidInto(): expected" << expectedNormalCount << "normals but got" << normals.size(), );
+    CORRADE_ASSERT(tangents.size() == expectedTangentCount,
+        "Primitives::grid3DSolidInto(): expected" << expectedTangentCount << "tangents but got" << tangents.size(), );
+    CORRADE_ASSERT(textureCoordinates.size() == expectedTextureCoordinateCount,
+        "Primitives::grid3DSolidInto(): expected" << expectedTextureCoordinateCount << "texture coordinates but got" << textureCoordinates.size(), );
+    CORRADE_ASSERT(indices.size() == indexCount,
+        "Primitives::grid3DSolidInto(): expected" << indexCount << "indices but got" << indices.size(), );
+    #ifdef CORRADE_NO_ASSERT
+    static_cast<void>(flags);
+    #endif
+
+    grid3DSolidGenerate(subdivisions, positions, normals, tangents, textureCoordinates, indices);
+}
+
 namespace {
 
 constexpr Trade::MeshAttributeData AttributeData3DWireframe[]{
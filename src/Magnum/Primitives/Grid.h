@@ -26,7 +26,7 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::Primitives::grid3DSolid(), @ref Magnum::Primitives::grid3DWireframe()
+ * @brief Function @ref Magnum::Primitives::grid3DSolid(), @ref Magnum::Primitives::grid3DSolidVertexCount(), @ref Magnum::Primitives::grid3DSolidIndexCount(), @ref Magnum::Primitives::grid3DSolidInto(), @ref Magnum::Primitives::grid3DWireframe()
  */
 
 #include <Corrade/Containers/EnumSet.h>
@@ -107,10 +107,43 @@ each direction. Specifying @cpp {0, 0} @ce will make the result an (indexed)
 equivalent to @ref planeSolid(); @cpp {5, 3} @ce will make the grid have 6
 cells horizontally and 4 vertically. In particular, this is different from the
 `subdivisions` parameter in @ref icosphereSolid().
-@see @ref grid3DWireframe()
+@see @ref grid3DWireframe(), @ref grid3DSolidInto()
 */
 MAGNUM_PRIMITIVES_EXPORT Trade::MeshData grid3DSolid(const Vector2i& subdivisions, GridFlags flags = GridFlag::Normals);
 
+/**
+@brief Vertex count of a solid 3D grid
+@m_since_latest
+
+Count of vertices generated by @ref grid3DSolid() and expected by
+@ref grid3DSolidInto().
+*/
+MAGNUM_PRIMITIVES_EXPORT UnsignedInt grid3DSolidVertexCount(const Vector2i& subdivisions);
+
+/**
+@brief Index count of a solid 3D grid
+@m_since_latest
+
+Count of indices generated by @ref grid3DSolid() and expected by
+@ref grid3DSolidInto().
+*/
+MAGNUM_PRIMITIVES_EXPORT UnsignedInt grid3DSolidIndexCount(const Vector2i& subdivisions);
+
+/**
+@brief Solid 3D grid into existing views
+@m_since_latest
+
+A variant of @ref grid3DSolid() that fills existing memory instead of
+allocating a new @ref Trade::MeshData. The @p positions are expected to have
+@ref grid3DSolidVertexCount() items, the @p normals, @p tangents and
+@p textureCoordinates are expected to have the same size if
+@ref GridFlag::Normals, @relativeref{GridFlag,Tangents} or
+@relativeref{GridFlag,TextureCoordinates} is set and to be empty otherwise.
+The @p indices are expected to have @ref grid3DSolidIndexCount() items. The
+generated data are the same as with @ref grid3DSolid().
+*/
+MAGNUM_PRIMITIVES_EXPORT void grid3DSolidInto(const Vector2i& subdivisions, GridFlags flags, const Containers::StridedArrayView1D<Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals, const Containers::StridedArrayView1D<Vector4>& tangents, const Containers::StridedArrayView1D<Vector2>& textureCoordinates, const Containers::StridedArrayView1D<UnsignedInt>& indices);
+
 /**
 @brief Wireframe 3D grid
 
@@ -27,9 +27,7 @@
 
 #include "Magnum/Mesh.h"
 #include "Magnum/Math/Vector3.h"
-#include "Magnum/MeshTools/RemoveDuplicates.h"
 #include "Magnum/MeshTools/Subdivide.h"
-#include "Magnum/Trade/ArrayAllocator.h"
 #include "Magnum/Trade/MeshData.h"
 
 namespace Magnum { namespace Primitives {
@@ -83,50 +81,28 @@ constexpr struct VertexSolidStrip {
 
 }
 
-Trade::MeshData icosphereSolid(const UnsignedInt subdivisions) {
-    const std::size_t indexCount = Containers::arraySize(Indices)*(1 << subdivisions*2);
-    const std::size_t vertexCount = Containers::arraySize(Vertices) + ((indexCount - Containers::arraySize(Indices))/3);
+UnsignedInt icosphereSolidVertexCount(const UnsignedInt subdivisions) {
+    return 10*(1 << subdivisions*2) + 2;
+}
+
+UnsignedInt icosphereSolidIndexCount(const UnsignedInt subdivisions) {
+    return Containers::arraySize(Indices)*(1 << subdivisions*2);
+}
 
-    Containers::Array<char> indexData{indexCount*sizeof(UnsignedInt)};
+Trade::MeshData icosphereSolid(const UnsignedInt subdivisions) {
+    Containers::Array<char> indexData{NoInit, icosphereSolidIndexCount(subdivisions)*sizeof(UnsignedInt)};
     auto indices = Containers::arrayCast<UnsignedInt>(indexData);
-    std::memcpy(indices.begin(), Indices, sizeof(Indices));
 
     struct Vertex {
         Vector3 position;
         Vector3 normal;
     };
-    Containers::Array<char> vertexData;
-    Containers::arrayResize<Trade::ArrayAllocator>(vertexData, NoInit,
-        sizeof(Vertex)*vertexCount);
-
-    /* Build up the subdivided positions */
-    {
-        auto vertices = Containers::arrayCast<Vertex>(vertexData);
-        Containers::StridedArrayView1D<Vector3> positions{vertices, &vertices[0].position, vertices.size(), sizeof(Vertex)};
-        for(std::size_t i = 0; i != Containers::arraySize(Vertices); ++i)
-            positions[i] = Vertices[i].position;
-
-        for(std::size_t i = 0; i != subdivisions; ++i) {
-            const std::size_t iterationIndexCount = Containers::arraySize(Indices)*(1 << (i + 1)*2);
-            const std::size_t iterationVertexCount = Containers::arraySize(Vertices) + ((iterationIndexCount - Containers::arraySize(Indices))/3);
-            MeshTools::subdivideInPlace(indices.prefix(iterationIndexCount), positions.prefix(iterationVertexCount), [](const Vector3& a, const Vector3& b) {
-                return (a+b).normalized();
-            });
-        }
-
-        /** @todo i need arrayShrinkAndGiveUpMemoryIfItDoesntCauseRealloc() */
-        Containers::arrayResize<Trade::ArrayAllocator>(vertexData,
-            MeshTools::removeDuplicatesIndexedInPlace(
-                Containers::stridedArrayView(indices),
-                Containers::arrayCast<2, char>(positions))*sizeof(Vertex));
-    }
-
-    /* Build up the views again with correct size, fill the normals */
+    Containers::Array<char> vertexData{NoInit, icosphereSolidVertexCount(subdivisions)*sizeof(Vertex)};
     auto vertices = Containers::arrayCast<Vertex>(vertexData);
     Containers::StridedArrayView1D<Vector3> positions{vertices, &vertices[0].position, vertices.size(), sizeof(Vertex)};
     Containers::StridedArrayView1D<Vector3> normals{vertices, &vertices[0].normal, vertices.size(), sizeof(Vertex)};
-    for(std::size_t i = 0; i != positions.size(); ++i)
-        normals[i] = positions[i];
+
+    icosphereSolidInto(subdivisions, positions, normals, indices);
 
     return Trade::MeshData{MeshPrimitive::Triangles, std::move(indexData),
         Trade::MeshIndexData{indices}, std::move(vertexData),
@@ -134,6 +110,38 @@ Trade::MeshData icosphereSolid(const UnsignedInt subdivisions) {
          Trade::MeshAttributeData{Trade::MeshAttribute::Normal, normals}}};
 }
 
+void icosphereSolidInto(const UnsignedInt subdivisions, const Containers::StridedArrayView1D<Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals, const Containers::StridedArrayView1D<UnsignedInt>& indices) {
+    #ifndef CORRADE_NO_ASSERT
+    const std::size_t expectedVertexCount = icosphereSolidVertexCount(subdivisions);
+    const std::size_t expectedIndexCount = icosphereSolidIndexCount(subdivisions);
+    #endif
+    CORRADE_ASSERT(positions.size() == expectedVertexCount && normals.size() == expectedVertexCount,
+        "Primitives::icosphereSolidInto(): expected" << expectedVertexCount << "positions and normals but got" << positions.size() << "and" << normals.size(), );
+    CORRADE_ASSERT(indices.size() == expectedIndexCount,
+        "Primitives::icosphereSolidInto(): expected" << expectedIndexCount << "indices but got" << indices.size(), );
+
+    for(std::size_t i = 0; i != Containers::arraySize(Indices); ++i)
+        indices[i] = Indices[i];
+    for(std::size_t i = 0; i != Containers::arraySize(Vertices); ++i)
+        positions[i] = Vertices[i].position;
+
+    /* The icosphere is closed, so each subdivision adds exactly half as many
+       new vertices as there was indices, with no duplicates. Thus it can be
+       subdivided directly in the output. */
+    std::size_t vertexCount = Containers::arraySize(Vertices);
+    for(std::size_t i = 0; i != subdivisions; ++i) {
+        const std::size_t iterationIndexCount = Containers::arraySize(Indices)*(1 << (i + 1)*2);
+        vertexCount = MeshTools::subdivideSharedInPlace(indices.prefix(iterationIndexCount), positions, vertexCount, [](const Vector3& a, const Vector3& b) {
+            return (a+b).normalized();
+        });
+    }
+    CORRADE_INTERNAL_ASSERT(vertexCount == positions.size());
+
+    /* Positions on an unit sphere are equal to normals */
+    for(std::size_t i = 0; i != vertexCount; ++i)
+        normals[i] = positions[i];
+}
+
 namespace {
 
 /* Taking the above, converting each triangle to three lines and leaving out
@@ -26,7 +26,7 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::Primitives::icosphereSolid()
+ * @brief Function @ref Magnum::Primitives::icosphereSolid(), @ref Magnum::Primitives::icosphereSolidVertexCount(), @ref Magnum::Primitives::icosphereSolidIndexCount(), @ref Magnum::Primitives::icosphereSolidInto()
  */
 
 #include "Magnum/Primitives/visibility.h"
@@ -51,10 +51,45 @@ icosphere with 12 vertices and 20 faces, saying @cpp 1 @ce will result in an
 icosphere with 80 faces (each triangle subdivided into four smaller), saying
 @cpp 2 @ce will result in 320 faces and so on. In particular, this is different
 from the `subdivisions` parameter in @ref grid3DSolid() or @ref grid3DWireframe().
-@see @ref uvSphereSolid(), @ref uvSphereWireframe()
+@see @ref uvSphereSolid(), @ref uvSphereWireframe(), @ref icosphereSolidInto()
 */
 MAGNUM_PRIMITIVES_EXPORT Trade::MeshData icosphereSolid(UnsignedInt subdivisions);
 
+/**
+@brief Vertex count of a solid 3D icosphere
+@m_since_latest
+
+Count of vertices generated by @ref icosphereSolid() and expected by
+@ref icosphereSolidInto(), equal to @f$ 10 \cdot 4^n + 2 @f$.
+*/
+MAGNUM_PRIMITIVES_EXPORT UnsignedInt icosphereSolidVertexCount(UnsignedInt subdivisions);
+
+/**
+@brief Index count of a solid 3D icosphere
+@m_since_latest
+
+Count of indices generated by @ref icosphereSolid() and expected by
+@ref icosphereSolidInto(), equal to @f$ 60 \cdot 4^n @f$.
+*/
+MAGNUM_PRIMITIVES_EXPORT UnsignedInt icosphereSolidIndexCount(UnsignedInt subdivisions);
+
+/**
+@brief Solid 3D icosphere into existing views
+@m_since_latest
+
+A variant of @ref icosphereSolid() that fills existing memory instead of
+allocating a new @ref Trade::MeshData. The @p positions and @p normals are
+expected to have @ref icosphereSolidVertexCount() items, the @p indices
+@ref icosphereSolidIndexCount() items. The generated data are the same as with
+@ref icosphereSolid().
+
+The subdivision is done directly in the output views using
+@ref MeshTools::subdivideSharedInPlace(), which means the
+@p positions and @p indices are also used as the working memory and
+the only temporary allocations are for the edge lookup.
+*/
+MAGNUM_PRIMITIVES_EXPORT void icosphereSolidInto(UnsignedInt subdivisions, const Containers::StridedArrayView1D<Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals, const Containers::StridedArrayView1D<UnsignedInt>& indices);
+
 /**
 @brief Wireframe 3D icosphere
 @m_since{2020,06}
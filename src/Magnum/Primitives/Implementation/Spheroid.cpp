@@ -25,63 +25,105 @@
 
 #include "Spheroid.h"
 
-#include <Corrade/Containers/GrowableArray.h>
-
 #include "Magnum/Math/Functions.h"
 #include "Magnum/Math/Color.h"
 #include "Magnum/Mesh.h"
 #include "Magnum/Trade/MeshData.h"
-#include "Magnum/Trade/ArrayAllocator.h"
 
 namespace Magnum { namespace Primitives { namespace Implementation {
 
-Spheroid::Spheroid(UnsignedInt segments, Flags flags): _segments(segments), _flags{flags}, _stride{sizeof(Vector3) + sizeof(Vector3)}, _attributeCount{2} {
-    if(_flags & Flag::Tangents) {
-        _tangentOffset = _stride;
-        _stride += sizeof(Vector4);
-        ++_attributeCount;
-    } else _tangentOffset = ~std::size_t{};
+UnsignedInt Spheroid::vertexCount(const UnsignedInt segments, const Flags flags, const UnsignedInt rings, const UnsignedInt capVertices) {
+    /* Rings have the first vertex duplicated for texture coordinates and
+       tangents */
+    return (segments + (flags & (Flag::TextureCoordinates|Flag::Tangents) ? 1 : 0))*rings + capVertices;
+}
 
-    if(_flags & Flag::TextureCoordinates) {
-        _textureCoordinateOffset = _stride;
-        _stride += sizeof(Vector2);
-        ++_attributeCount;
-    } else _textureCoordinateOffset = ~std::size_t{};
+UnsignedInt Spheroid::indexCount(const UnsignedInt segments, const UnsignedInt faceRings, const UnsignedInt capFaceRings) {
+    return segments*(6*faceRings + 3*capFaceRings);
 }
 
-void Spheroid::append(const Vector3& position, const Vector3& normal) {
-    Containers::arrayAppend<Trade::ArrayAllocator>(_vertexData,
-        Containers::arrayCast<const char>(Containers::arrayView(&position, 1)));
-    Containers::arrayAppend<Trade::ArrayAllocator>(_vertexData,
-        Containers::arrayCast<const char>(Containers::arrayView(&normal, 1)));
+bool Spheroid::checkSizes(const char* const function, const Flags flags, const UnsignedInt vertexCount, const UnsignedInt indexCount, const Containers::StridedArrayView1D<Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals, const Containers::StridedArrayView1D<Vector4>& tangents, const Containers::StridedArrayView1D<Vector2>& textureCoordinates, const Containers::StridedArrayView1D<UnsignedInt>& indices) {
+    #ifdef CORRADE_NO_ASSERT
+    static_cast<void>(function);
+    #endif
+    CORRADE_ASSERT(positions.size() == vertexCount && normals.size() == vertexCount,
+        "Primitives::" << Debug::nospace << function << Debug::nospace << "(): expected" << vertexCount << "positions and normals but got" << positions.size() << "and" << normals.size(), false);
+    const UnsignedInt expectedTangentCount = flags & Flag::Tangents ? vertexCount : 0;
+    CORRADE_ASSERT(tangents.size() == expectedTangentCount,
+        "Primitives::" << Debug::nospace << function << Debug::nospace << "(): expected" << expectedTangentCount << "tangents but got" << tangents.size(), false);
+    const UnsignedInt expectedTextureCoordinateCount = flags & Flag::TextureCoordinates ? vertexCount : 0;
+    CORRADE_ASSERT(textureCoordinates.size() == expectedTextureCoordinateCount,
+        "Primitives::" << Debug::nospace << function << Debug::nospace << "(): expected" << expectedTextureCoordinateCount << "texture coordinates but got" << textureCoordinates.size(), false);
+    CORRADE_ASSERT(indices.size() == indexCount,
+        "Primitives::" << Debug::nospace << function << Debug::nospace << "(): expected" << indexCount << "indices but got" << indices.size(), false);
+    #ifdef CORRADE_NO_ASSERT
+    static_cast<void>(flags);
+    static_cast<void>(vertexCount);
+    static_cast<void>(indexCount);
+    static_cast<void>(positions);
+    static_cast<void>(normals);
+    static_cast<void>(tangents);
+    static_cast<void>(textureCoordinates);
+    static_cast<void>(indices);
+    #endif
+    return true;
+}
+
+Spheroid::Spheroid(const UnsignedInt segments, const Flags flags, const UnsignedInt vertexCount, const UnsignedInt indexCount): _segments{segments}, _flags{flags} {
+    std::size_t stride = sizeof(Vector3) + sizeof(Vector3);
+    std::size_t tangentOffset{}, textureCoordinateOffset{};
     if(_flags & Flag::Tangents) {
-        /** @todo make arrayGrow() a public API instead of this */
-        constexpr const char empty[sizeof(Vector4)]{};
-        Containers::arrayAppend<Trade::ArrayAllocator>(_vertexData,
-            Containers::arrayView(empty));
+        tangentOffset = stride;
+        stride += sizeof(Vector4);
     }
     if(_flags & Flag::TextureCoordinates) {
-        /** @todo make arrayGrow() a public API instead */
-        constexpr const char empty[sizeof(Vector2)]{};
-        Containers::arrayAppend<Trade::ArrayAllocator>(_vertexData,
-            Containers::arrayView(empty));
+        textureCoordinateOffset = stride;
+        stride += sizeof(Vector2);
     }
+
+    _vertexData = Containers::Array<char>{ValueInit, stride*vertexCount};
+    _indexData = Containers::Array<char>{NoInit, sizeof(UnsignedInt)*indexCount};
+
+    /* GCC 4.8 can't handle the stridedArrayView() convenience thing */
+    _positions = Containers::StridedArrayView1D<Vector3>{_vertexData,
+        reinterpret_cast<Vector3*>(_vertexData.data()),
+        vertexCount, std::ptrdiff_t(stride)};
+    _normals = Containers::StridedArrayView1D<Vector3>{_vertexData,
+        reinterpret_cast<Vector3*>(_vertexData.data() + sizeof(Vector3)),
+        vertexCount, std::ptrdiff_t(stride)};
+    if(_flags & Flag::Tangents)
+        _tangents = Containers::StridedArrayView1D<Vector4>{_vertexData,
+            reinterpret_cast<Vector4*>(_vertexData.data() + tangentOffset),
+            vertexCount, std::ptrdiff_t(stride)};
+    if(_flags & Flag::TextureCoordinates)
+        _textureCoordinates = Containers::StridedArrayView1D<Vector2>{_vertexData,
+            reinterpret_cast<Vector2*>(_vertexData.data() + textureCoordinateOffset),
+            vertexCount, std::ptrdiff_t(stride)};
+    _indices = Containers::arrayCast<UnsignedInt>(_indexData);
+}
+
+Spheroid::Spheroid(const UnsignedInt segments, const Flags flags, const Containers::StridedArrayView1D<Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals, const Containers::StridedArrayView1D<Vector4>& tangents, const Containers::StridedArrayView1D<Vector2>& textureCoordinates, const Containers::StridedArrayView1D<UnsignedInt>& indices): _segments{segments}, _flags{flags}, _positions{positions}, _normals{normals}, _tangents{tangents}, _textureCoordinates{textureCoordinates}, _indices{indices} {}
+
+void Spheroid::append(const Vector3& position, const Vector3& normal) {
+    _positions[_vertexCount] = position;
+    _normals[_vertexCount] = normal;
+    ++_vertexCount;
 }
 
 Vector3 Spheroid::lastVertexPosition(const std::size_t offsetFromEnd) {
-    return Containers::arrayCast<Vector3>(_vertexData.slice<sizeof(Vector3)>(_vertexData.size() - _stride*offsetFromEnd))[0];
+    return _positions[_vertexCount - offsetFromEnd];
 }
 
 Vector3 Spheroid::lastVertexNormal(const std::size_t offsetFromEnd) {
-    return Containers::arrayCast<Vector3>(_vertexData.slice<sizeof(Vector3)>(_vertexData.size() - _stride*offsetFromEnd + sizeof(Vector3)))[0];
+    return _normals[_vertexCount - offsetFromEnd];
 }
 
 Vector4& Spheroid::lastVertexTangent(const std::size_t offsetFromEnd) {
-    return Containers::arrayCast<Vector4>(_vertexData.slice<sizeof(Vector4)>(_vertexData.size() - _stride*offsetFromEnd + _tangentOffset))[0];
+    return _tangents[_vertexCount - offsetFromEnd];
 }
 
 Vector2& Spheroid::lastVertexTextureCoords(const std::size_t offsetFromEnd) {
-    return Containers::arrayCast<Vector2>(_vertexData.slice<sizeof(Vector2)>(_vertexData.size() - _stride*offsetFromEnd + _textureCoordinateOffset))[0];
+    return _textureCoordinates[_vertexCount - offsetFromEnd];
 }
 
 void Spheroid::capVertex(Float y, Float normalY, Float textureCoordsV) {
@@ -158,17 +200,15 @@ void Spheroid::cylinderVertexRings(const UnsignedInt count, const Float startY,
 
 void Spheroid::bottomFaceRing() {
     for(UnsignedInt j = 0; j != _segments; ++j) {
-        Containers::arrayAppend<Trade::ArrayAllocator>(_indexData, {
-            /* Bottom vertex */
-            0u,
+        /* Bottom vertex */
+        appendIndex(0u);
 
-            /* Top right vertex */
-            (j != _segments-1 || _flags & (Flag::TextureCoordinates|Flag::Tangents)) ?
-            j+2 : 1,
+        /* Top right vertex */
+        appendIndex((j != _segments-1 || _flags & (Flag::TextureCoordinates|Flag::Tangents)) ?
+            j+2 : 1);
 
-            /* Top left vertex */
-            j+1
-        });
+        /* Top left vertex */
+        appendIndex(j+1);
     }
 }
 
@@ -183,14 +223,12 @@ void Spheroid::faceRings(UnsignedInt count, UnsignedInt offset) {
             const UnsignedInt topLeft = bottomLeft+vertexSegments;
             const UnsignedInt topRight = bottomRight+vertexSegments;
 
-            Containers::arrayAppend<Trade::ArrayAllocator>(_indexData, {
-                bottomLeft,
-                bottomRight,
-                topRight,
-                bottomLeft,
-                topRight,
-                topLeft
-            });
+            appendIndex(bottomLeft);
+            appendIndex(bottomRight);
+            appendIndex(topRight);
+            appendIndex(bottomLeft);
+            appendIndex(topRight);
+            appendIndex(topLeft);
         }
     }
 }
@@ -198,20 +236,18 @@ void Spheroid::faceRings(UnsignedInt count, UnsignedInt offset) {
 void Spheroid::topFaceRing() {
     const UnsignedInt vertexSegments = _segments + (_flags & (Flag::TextureCoordinates|Flag::Tangents) ? 1 : 0);
 
-    const UnsignedInt vertexCount = _vertexData.size()/_stride;
+    const UnsignedInt vertexCount = _vertexCount;
 
     for(UnsignedInt j = 0; j != _segments; ++j) {
-        Containers::arrayAppend<Trade::ArrayAllocator>(_indexData, {
-            /* Bottom left vertex */
-            vertexCount - vertexSegments + j - 1,
+        /* Bottom left vertex */
+        appendIndex(vertexCount - vertexSegments + j - 1);
 
-            /* Bottom right vertex */
-            (j != _segments-1 || _flags & (Flag::TextureCoordinates|Flag::Tangents)) ?
-            vertexCount - vertexSegments + j : vertexCount - _segments - 1,
+        /* Bottom right vertex */
+        appendIndex((j != _segments-1 || _flags & (Flag::TextureCoordinates|Flag::Tangents)) ?
+            vertexCount - vertexSegments + j : vertexCount - _segments - 1);
 
-            /* Top vertex */
-            vertexCount - 1
-        });
+        /* Top vertex */
+        appendIndex(vertexCount - 1);
     }
 }
 
@@ -240,44 +276,35 @@ void Spheroid::capVertexRing(Float y, Float textureCoordsV, const Vector3& norma
     }
 }
 
+void Spheroid::finish() {
+    CORRADE_INTERNAL_ASSERT(_vertexCount == _positions.size() && _indexCount == _indices.size());
+}
+
 Trade::MeshData Spheroid::finalize() {
-    Trade::MeshIndexData indices{_indexData};
+    finish();
+
+    const Trade::MeshIndexData indices{_indices};
 
     std::size_t attributeOffset = 0;
-    Containers::Array<Trade::MeshAttributeData> attributes{_attributeCount};
+    Containers::Array<Trade::MeshAttributeData> attributes{2 +
+        (_flags & Flag::Tangents ? 1 : 0) +
+        (_flags & Flag::TextureCoordinates ? 1 : 0)};
     attributes[attributeOffset++] = Trade::MeshAttributeData{
-        Trade::MeshAttribute::Position, VertexFormat::Vector3,
-        /* GCC 4.8 can't handle the stridedArrayView() convenience thing */
-        Containers::StridedArrayView1D<const char>{_vertexData,
-            _vertexData.data(),
-            _vertexData.size()/_stride, std::ptrdiff_t(_stride)}};
+        Trade::MeshAttribute::Position, _positions};
     attributes[attributeOffset++] = Trade::MeshAttributeData{
-        Trade::MeshAttribute::Normal, VertexFormat::Vector3,
-        /* GCC 4.8 can't handle the stridedArrayView() convenience thing */
-        Containers::StridedArrayView1D<const char>{_vertexData,
-            _vertexData.data() + sizeof(Vector3),
-            _vertexData.size()/_stride, std::ptrdiff_t(_stride)}};
-
+        Trade::MeshAttribute::Normal, _normals};
     if(_flags & Flag::Tangents)
         attributes[attributeOffset++] = Trade::MeshAttributeData{
-            Trade::MeshAttribute::Tangent, VertexFormat::Vector4,
-            /* GCC 4.8 can't handle the stridedArrayView() convenience thing */
-            Containers::StridedArrayView1D<const char>{_vertexData,
-                _vertexData.data() + _tangentOffset,
-                _vertexData.size()/_stride, std::ptrdiff_t(_stride)}};
+            Trade::MeshAttribute::Tangent, _tangents};
     if(_flags & Flag::TextureCoordinates)
         attributes[attributeOffset++] = Trade::MeshAttributeData{
-            Trade::MeshAttribute::TextureCoordinates, VertexFormat::Vector2,
-            /* GCC 4.8 can't handle the stridedArrayView() convenience thing */
-            Containers::StridedArrayView1D<const char>{_vertexData,
-                _vertexData.data() + _textureCoordinateOffset,
-                _vertexData.size()/_stride, std::ptrdiff_t(_stride)}};
+            Trade::MeshAttribute::TextureCoordinates, _textureCoordinates};
 
-    CORRADE_INTERNAL_ASSERT(attributeOffset == _attributeCount);
+    CORRADE_INTERNAL_ASSERT(attributeOffset == attributes.size());
 
     return Trade::MeshData{MeshPrimitive::Triangles,
-        Containers::arrayAllocatorCast<char, Trade::ArrayAllocator>(std::move(_indexData)),
-        indices, std::move(_vertexData), std::move(attributes)};
+        std::move(_indexData), indices,
+        std::move(_vertexData), std::move(attributes)};
 }
 
 }}}
@@ -43,7 +43,25 @@ class Spheroid {
 
         typedef Containers::EnumSet<Flag> Flags;
 
-        explicit Spheroid(UnsignedInt segments, Flags flags);
+        /* Vertex count for given count of rings (including the cap rings)
+           and additional single cap vertices, index count for given count of
+           face rings (including the bottom and top face rings) */
+        static UnsignedInt vertexCount(UnsignedInt segments, Flags flags, UnsignedInt rings, UnsignedInt capVertices);
+        static UnsignedInt indexCount(UnsignedInt segments, UnsignedInt faceRings, UnsignedInt capFaceRings);
+
+        /* Allocates interleaved vertex data and index data of given size,
+           finalize() then turns them into a MeshData */
+        explicit Spheroid(UnsignedInt segments, Flags flags, UnsignedInt vertexCount, UnsignedInt indexCount);
+
+        /* Checks sizes of the views passed to the second constructor, prints
+           an assertion message prefixed with given function name and returns
+           false if they don't match */
+        static bool checkSizes(const char* function, Flags flags, UnsignedInt vertexCount, UnsignedInt indexCount, const Containers::StridedArrayView1D<Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals, const Containers::StridedArrayView1D<Vector4>& tangents, const Containers::StridedArrayView1D<Vector2>& textureCoordinates, const Containers::StridedArrayView1D<UnsignedInt>& indices);
+
+        /* Writes into existing views. The tangent and texture coordinate
+           views are expected to be empty if the corresponding flag isn't
+           set, sizes are checked by the callers. */
+        explicit Spheroid(UnsignedInt segments, Flags flags, const Containers::StridedArrayView1D<Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals, const Containers::StridedArrayView1D<Vector4>& tangents, const Containers::StridedArrayView1D<Vector2>& textureCoordinates, const Containers::StridedArrayView1D<UnsignedInt>& indices);
 
         void capVertex(Float y, Float normalY, Float textureCoordsV);
         void hemisphereVertexRings(UnsignedInt count, Float centerY, Rad startRingAngle, Rad ringAngleIncrement, Float startTextureCoordsV, Float textureCoordsVIncrement);
@@ -53,20 +71,29 @@ class Spheroid {
         void topFaceRing();
         void capVertexRing(Float y, Float textureCoordsV, const Vector3& normal);
 
+        /* Checks that all vertices and indices were written */
+        void finish();
+
+        /* Calls finish() and returns the allocated data. Can be called only
+           on an instance created with the allocating constructor. */
         Trade::MeshData finalize();
 
     private:
         UnsignedInt _segments;
         Flags _flags;
-        std::size_t _stride;
-        std::size_t _textureCoordinateOffset,
-            _tangentOffset;
-        std::size_t _attributeCount;
 
-        Containers::Array<UnsignedInt> _indexData;
+        Containers::Array<char> _indexData;
         Containers::Array<char> _vertexData;
+        Containers::StridedArrayView1D<Vector3> _positions, _normals;
+        Containers::StridedArrayView1D<Vector4> _tangents;
+        Containers::StridedArrayView1D<Vector2> _textureCoordinates;
+        Containers::StridedArrayView1D<UnsignedInt> _indices;
+        UnsignedInt _vertexCount{}, _indexCount{};
 
         void append(const Vector3& position, const Vector3& normal);
+        void appendIndex(UnsignedInt index) {
+            _indices[_indexCount++] = index;
+        }
         Vector3 lastVertexPosition(std::size_t offsetFromEnd);
         Vector3 lastVertexNormal(std::size_t offsetFromEnd);
         Vector4& lastVertexTangent(std::size_t offsetFromEnd);
@@ -23,8 +23,11 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <sstream>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
 
 #include "Magnum/Math/Vector4.h"
 #include "Magnum/Primitives/Cylinder.h"
@@ -39,6 +42,8 @@ struct CylinderTest: TestSuite::Tester {
     void solidWithCaps();
     void solidWithTextureCoordinatesOrTangents();
     void solidWithTextureCoordinatesOrTangentsAndCaps();
+    void solidInto();
+    void solidIntoInvalidSize();
     void wireframe();
 };
 
@@ -51,6 +56,16 @@ constexpr struct {
     {"both", CylinderFlag::TextureCoordinates|CylinderFlag::Tangents}
 };
 
+constexpr struct {
+    const char* name;
+    CylinderFlags flags;
+} SolidIntoData[] {
+    {"", {}},
+    {"caps", CylinderFlag::CapEnds},
+    {"texture coordinates + tangents", CylinderFlag::TextureCoordinates|CylinderFlag::Tangents},
+    {"all", CylinderFlag::TextureCoordinates|CylinderFlag::Tangents|CylinderFlag::CapEnds}
+};
+
 CylinderTest::CylinderTest() {
     addTests({&CylinderTest::solidWithoutAnything,
               &CylinderTest::solidWithCaps});
@@ -60,7 +75,12 @@ CylinderTest::CylinderTest() {
         &CylinderTest::solidWithTextureCoordinatesOrTangentsAndCaps},
         Containers::arraySize(TextureCoordinatesOrTangentsData));
 
-    addTests({&CylinderTest::wireframe});
+    addInstancedTests({&CylinderTest::solidInto},
+        Containers::arraySize(SolidIntoData));
+
+    addTests({&CylinderTest::solidIntoInvalidSize,
+
+              &CylinderTest::wireframe});
 }
 
 void CylinderTest::solidWithoutAnything() {
@@ -440,6 +460,59 @@ void CylinderTest::solidWithTextureCoordinatesOrTangentsAndCaps() {
     }), TestSuite::Compare::Container);
 }
 
+void CylinderTest::solidInto() {
+    auto&& data = SolidIntoData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Trade::MeshData cylinder = cylinderSolid(3, 5, 1.5f, data.flags);
+
+    const UnsignedInt vertexCount = cylinderSolidVertexCount(3, 5, data.flags);
+    const UnsignedInt indexCount = cylinderSolidIndexCount(3, 5, data.flags);
+    CORRADE_COMPARE(vertexCount, cylinder.vertexCount());
+    CORRADE_COMPARE(indexCount, cylinder.indexCount());
+
+    Containers::Array<Vector3> positions{vertexCount};
+    Containers::Array<Vector3> normals{vertexCount};
+    Containers::Array<Vector4> tangents{data.flags & CylinderFlag::Tangents ? vertexCount : 0};
+    Containers::Array<Vector2> textureCoordinates{data.flags & CylinderFlag::TextureCoordinates ? vertexCount : 0};
+    Containers::Array<UnsignedInt> indices{indexCount};
+    cylinderSolidInto(3, 5, 1.5f, data.flags, positions, normals, tangents, textureCoordinates, indices);
+
+    CORRADE_COMPARE_AS(positions, cylinder.attribute<Vector3>(Trade::MeshAttribute::Position),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(normals, cylinder.attribute<Vector3>(Trade::MeshAttribute::Normal),
+        TestSuite::Compare::Container);
+    if(data.flags & CylinderFlag::Tangents)
+        CORRADE_COMPARE_AS(tangents, cylinder.attribute<Vector4>(Trade::MeshAttribute::Tangent),
+            TestSuite::Compare::Container);
+    if(data.flags & CylinderFlag::TextureCoordinates)
+        CORRADE_COMPARE_AS(textureCoordinates, cylinder.attribute<Vector2>(Trade::MeshAttribute::TextureCoordinates),
+            TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(indices, cylinder.indices<UnsignedInt>(),
+        TestSuite::Compare::Container);
+}
+
+void CylinderTest::solidIntoInvalidSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    /* 2*3 vertices, 3*6 indices */
+    Vector3 positions[6];
+    Vector3 normals[6];
+    Vector3 normalsInvalid[7];
+    UnsignedInt indices[18];
+    UnsignedInt indicesInvalid[17];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    cylinderSolidInto(0, 3, 1.0f, {}, positions, normals, nullptr, nullptr, indices);
+    cylinderSolidInto(1, 3, 1.0f, {}, positions, normalsInvalid, nullptr, nullptr, indices);
+    cylinderSolidInto(1, 3, 1.0f, {}, positions, normals, nullptr, nullptr, indicesInvalid);
+    CORRADE_COMPARE(out.str(),
+        "Primitives::cylinderSolidInto(): at least one ring and three segments expected\n"
+        "Primitives::cylinderSolidInto(): expected 6 positions and normals but got 6 and 7\n"
+        "Primitives::cylinderSolidInto(): expected 18 indices but got 17\n");
+}
+
 void CylinderTest::wireframe() {
     Trade::MeshData cylinder = cylinderWireframe(2, 8, 0.5f);
 
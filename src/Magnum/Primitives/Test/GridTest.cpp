@@ -23,8 +23,11 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <sstream>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
 
 #include "Magnum/Math/Vector4.h"
 #include "Magnum/Primitives/Grid.h"
@@ -36,6 +39,8 @@ struct GridTest: TestSuite::Tester {
     explicit GridTest();
 
     void solid3D();
+    void solid3DInto();
+    void solid3DIntoInvalidSize();
     void wireframe3D();
 };
 
@@ -52,10 +57,13 @@ constexpr struct {
 };
 
 GridTest::GridTest() {
-    addInstancedTests({&GridTest::solid3D},
+    addInstancedTests({&GridTest::solid3D,
+                       &GridTest::solid3DInto},
         Containers::arraySize(Solid3DData));
 
-    addTests({&GridTest::wireframe3D});
+    addTests({&GridTest::solid3DIntoInvalidSize,
+
+              &GridTest::wireframe3D});
 }
 
 void GridTest::solid3D() {
@@ -285,6 +293,66 @@ void GridTest::solid3D() {
     }), TestSuite::Compare::Container);
 }
 
+void GridTest::solid3DInto() {
+    auto&& data = Solid3DData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Trade::MeshData grid = grid3DSolid({5, 3}, data.flags);
+
+    const UnsignedInt vertexCount = grid3DSolidVertexCount({5, 3});
+    const UnsignedInt indexCount = grid3DSolidIndexCount({5, 3});
+    CORRADE_COMPARE(vertexCount, grid.vertexCount());
+    CORRADE_COMPARE(indexCount, grid.indexCount());
+
+    Containers::Array<Vector3> positions{vertexCount};
+    Containers::Array<Vector3> normals{data.flags & GridFlag::Normals ? vertexCount : 0};
+    Containers::Array<Vector4> tangents{data.flags & GridFlag::Tangents ? vertexCount : 0};
+    Containers::Array<Vector2> textureCoordinates{data.flags & GridFlag::TextureCoordinates ? vertexCount : 0};
+    Containers::Array<UnsignedInt> indices{indexCount};
+    grid3DSolidInto({5, 3}, data.flags, positions, normals, tangents, textureCoordinates, indices);
+
+    CORRADE_COMPARE_AS(positions, grid.attribute<Vector3>(Trade::MeshAttribute::Position),
+        TestSuite::Compare::Container);
+    if(data.flags & GridFlag::Normals)
+        CORRADE_COMPARE_AS(normals, grid.attribute<Vector3>(Trade::MeshAttribute::Normal),
+            TestSuite::Compare::Container);
+    if(data.flags & GridFlag::Tangents)
+        CORRADE_COMPARE_AS(tangents, grid.attribute<Vector4>(Trade::MeshAttribute::Tangent),
+            TestSuite::Compare::Container);
+    if(data.flags & GridFlag::TextureCoordinates)
+        CORRADE_COMPARE_AS(textureCoordinates, grid.attribute<Vector2>(Trade::MeshAttribute::TextureCoordinates),
+            TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(indices, grid.indices<UnsignedInt>(),
+        TestSuite::Compare::Container);
+}
+
+void GridTest::solid3DIntoInvalidSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    /* 3*2 vertices, 2*1*6 indices */
+    Vector3 positions[6];
+    Vector3 positionsInvalid[5];
+    Vector3 normals[6];
+    Vector4 tangents[6];
+    Vector2 textureCoordinates[6];
+    UnsignedInt indices[12];
+    UnsignedInt indicesInvalid[13];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    grid3DSolidInto({1, 0}, {}, positionsInvalid, nullptr, nullptr, nullptr, indices);
+    grid3DSolidInto({1, 0}, {}, positions, normals, nullptr, nullptr, indices);
+    grid3DSolidInto({1, 0}, GridFlag::Tangents, positions, nullptr, nullptr, nullptr, indices);
+    grid3DSolidInto({1, 0}, {}, positions, nullptr, nullptr, textureCoordinates, indices);
+    grid3DSolidInto({1, 0}, GridFlag::Tangents, positions, nullptr, tangents, nullptr, indicesInvalid);
+    CORRADE_COMPARE(out.str(),
+        "Primitives::grid3DSolidInto(): expected 6 positions but got 5\n"
+        "Primitives::grid3DSolidInto(): expected 0 normals but got 6\n"
+        "Primitives::grid3DSolidInto(): expected 6 tangents but got 0\n"
+        "Primitives::grid3DSolidInto(): expected 0 texture coordinates but got 6\n"
+        "Primitives::grid3DSolidInto(): expected 12 indices but got 13\n");
+}
+
 void GridTest::wireframe3D() {
     Trade::MeshData grid = grid3DWireframe({5, 3});
 
@@ -23,8 +23,11 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <sstream>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
 
 #include "Magnum/Math/Vector3.h"
 #include "Magnum/Primitives/Icosphere.h"
@@ -38,6 +41,8 @@ struct IcosphereTest: TestSuite::Tester {
     void count0();
     void data1();
     void count2();
+    void into();
+    void intoInvalidSize();
 
     void wireframe();
 };
@@ -46,6 +51,8 @@ IcosphereTest::IcosphereTest() {
     addTests({&IcosphereTest::count0,
               &IcosphereTest::data1,
               &IcosphereTest::count2,
+              &IcosphereTest::into,
+              &IcosphereTest::intoInvalidSize,
 
               &IcosphereTest::wireframe});
 }
@@ -150,6 +157,45 @@ void IcosphereTest::count2() {
     CORRADE_COMPARE(icosphere.attributeCount(), 2);
 }
 
+void IcosphereTest::into() {
+    Trade::MeshData icosphere = Primitives::icosphereSolid(2);
+
+    const UnsignedInt vertexCount = Primitives::icosphereSolidVertexCount(2);
+    const UnsignedInt indexCount = Primitives::icosphereSolidIndexCount(2);
+    CORRADE_COMPARE(vertexCount, 162);
+    CORRADE_COMPARE(indexCount, 960);
+
+    Containers::Array<Vector3> positions{vertexCount};
+    Containers::Array<Vector3> normals{vertexCount};
+    Containers::Array<UnsignedInt> indices{indexCount};
+    Primitives::icosphereSolidInto(2, positions, normals, indices);
+
+    CORRADE_COMPARE_AS(positions, icosphere.attribute<Vector3>(Trade::MeshAttribute::Position),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(normals, icosphere.attribute<Vector3>(Trade::MeshAttribute::Normal),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(indices, icosphere.indices<UnsignedInt>(),
+        TestSuite::Compare::Container);
+}
+
+void IcosphereTest::intoInvalidSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Vector3 positions[12];
+    Vector3 positionsInvalid[13];
+    Vector3 normals[12];
+    UnsignedInt indices[60];
+    UnsignedInt indicesInvalid[59];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Primitives::icosphereSolidInto(0, positionsInvalid, normals, indices);
+    Primitives::icosphereSolidInto(0, positions, normals, indicesInvalid);
+    CORRADE_COMPARE(out.str(),
+        "Primitives::icosphereSolidInto(): expected 12 positions and normals but got 13 and 12\n"
+        "Primitives::icosphereSolidInto(): expected 60 indices but got 59\n");
+}
+
 void IcosphereTest::wireframe() {
     Trade::MeshData icosphere = Primitives::icosphereWireframe();
 
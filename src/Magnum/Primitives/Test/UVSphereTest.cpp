@@ -23,8 +23,11 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <sstream>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
 
 #include "Magnum/Math/Vector4.h"
 #include "Magnum/Primitives/UVSphere.h"
@@ -37,6 +40,8 @@ struct UVSphereTest: TestSuite::Tester {
 
     void solidWithoutTextureCoordinates();
     void solidWithTextureCoordinatesOrTangents();
+    void solidInto();
+    void solidIntoInvalidSize();
     void wireframe();
 };
 
@@ -49,13 +54,28 @@ constexpr struct {
     {"both", UVSphereFlag::TextureCoordinates|UVSphereFlag::Tangents}
 };
 
+constexpr struct {
+    const char* name;
+    UVSphereFlags flags;
+} SolidIntoData[] {
+    {"", {}},
+    {"texture coordinates", UVSphereFlag::TextureCoordinates},
+    {"tangents", UVSphereFlag::Tangents},
+    {"both", UVSphereFlag::TextureCoordinates|UVSphereFlag::Tangents}
+};
+
 UVSphereTest::UVSphereTest() {
     addTests({&UVSphereTest::solidWithoutTextureCoordinates});
 
     addInstancedTests({&UVSphereTest::solidWithTextureCoordinatesOrTangents},
         Containers::arraySize(TextureCoordinatesOrTangentsData));
 
-    addTests({&UVSphereTest::wireframe});
+    addInstancedTests({&UVSphereTest::solidInto},
+        Containers::arraySize(SolidIntoData));
+
+    addTests({&UVSphereTest::solidIntoInvalidSize,
+
+              &UVSphereTest::wireframe});
 }
 
 void UVSphereTest::solidWithoutTextureCoordinates() {
@@ -181,6 +201,67 @@ void UVSphereTest::solidWithTextureCoordinatesOrTangents() {
     }), TestSuite::Compare::Container);
 }
 
+void UVSphereTest::solidInto() {
+    auto&& data = SolidIntoData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Trade::MeshData sphere = uvSphereSolid(5, 7, data.flags);
+
+    const UnsignedInt vertexCount = uvSphereSolidVertexCount(5, 7, data.flags);
+    const UnsignedInt indexCount = uvSphereSolidIndexCount(5, 7);
+    CORRADE_COMPARE(vertexCount, sphere.vertexCount());
+    CORRADE_COMPARE(indexCount, sphere.indexCount());
+
+    Containers::Array<Vector3> positions{vertexCount};
+    Containers::Array<Vector3> normals{vertexCount};
+    Containers::Array<Vector4> tangents{data.flags & UVSphereFlag::Tangents ? vertexCount : 0};
+    Containers::Array<Vector2> textureCoordinates{data.flags & UVSphereFlag::TextureCoordinates ? vertexCount : 0};
+    Containers::Array<UnsignedInt> indices{indexCount};
+    uvSphereSolidInto(5, 7, data.flags, positions, normals, tangents, textureCoordinates, indices);
+
+    CORRADE_COMPARE_AS(positions, sphere.attribute<Vector3>(Trade::MeshAttribute::Position),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(normals, sphere.attribute<Vector3>(Trade::MeshAttribute::Normal),
+        TestSuite::Compare::Container);
+    if(data.flags & UVSphereFlag::Tangents)
+        CORRADE_COMPARE_AS(tangents, sphere.attribute<Vector4>(Trade::MeshAttribute::Tangent),
+            TestSuite::Compare::Container);
+    if(data.flags & UVSphereFlag::TextureCoordinates)
+        CORRADE_COMPARE_AS(textureCoordinates, sphere.attribute<Vector2>(Trade::MeshAttribute::TextureCoordinates),
+            TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(indices, sphere.indices<UnsignedInt>(),
+        TestSuite::Compare::Container);
+}
+
+void UVSphereTest::solidIntoInvalidSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    /* 3*3 + 2 vertices, 3*(2*6 + 2*3) indices */
+    Vector3 positions[11];
+    Vector3 positionsInvalid[10];
+    Vector3 normals[11];
+    Vector4 tangents[11];
+    Vector2 textureCoordinates[11];
+    UnsignedInt indices[54];
+    UnsignedInt indicesInvalid[55];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    uvSphereSolidInto(1, 3, {}, positions, normals, nullptr, nullptr, indices);
+    uvSphereSolidInto(4, 3, {}, positionsInvalid, normals, nullptr, nullptr, indices);
+    uvSphereSolidInto(4, 3, {}, positions, normals, tangents, nullptr, indices);
+    uvSphereSolidInto(4, 3, UVSphereFlag::Tangents, positions, normals, nullptr, textureCoordinates, indices);
+    uvSphereSolidInto(4, 3, UVSphereFlag::TextureCoordinates, positions, normals, nullptr, nullptr, indices);
+    uvSphereSolidInto(4, 3, {}, positions, normals, nullptr, nullptr, indicesInvalid);
+    CORRADE_COMPARE(out.str(),
+        "Primitives::uvSphereSolidInto(): at least two rings and three segments expected\n"
+        "Primitives::uvSphereSolidInto(): expected 11 positions and normals but got 10 and 11\n"
+        "Primitives::uvSphereSolidInto(): expected 0 tangents but got 11\n"
+        "Primitives::uvSphereSolidInto(): expected 11 tangents but got 0\n"
+        "Primitives::uvSphereSolidInto(): expected 11 texture coordinates but got 0\n"
+        "Primitives::uvSphereSolidInto(): expected 54 indices but got 55\n");
+}
+
 void UVSphereTest::wireframe() {
     Trade::MeshData sphere = uvSphereWireframe(6, 8);
 
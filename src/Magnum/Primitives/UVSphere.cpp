@@ -25,6 +25,8 @@
 
 #include "UVSphere.h"
 
+#include <Corrade/Containers/StridedArrayView.h>
+
 #include "Magnum/Mesh.h"
 #include "Magnum/Math/Color.h"
 #include "Magnum/Primitives/Implementation/Spheroid.h"
@@ -33,13 +35,9 @@
 
 namespace Magnum { namespace Primitives {
 
-Trade::MeshData uvSphereSolid(const UnsignedInt rings, const UnsignedInt segments, const UVSphereFlags flags) {
-    CORRADE_ASSERT(rings >= 2 && segments >= 3,
-        "Primitives::uvSphereSolid(): at least two rings and three segments expected",
-        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
-
-    Implementation::Spheroid sphere(segments, Implementation::Spheroid::Flag(UnsignedByte(flags)));
+namespace {
 
+void uvSphereSolidGenerate(Implementation::Spheroid& sphere, const UnsignedInt rings) {
     Float textureCoordsVIncrement = 1.0f/rings;
     Rad ringAngleIncrement(Constants::pi()/rings);
 
@@ -56,10 +54,50 @@ Trade::MeshData uvSphereSolid(const UnsignedInt rings, const UnsignedInt segment
     sphere.bottomFaceRing();
     sphere.faceRings(rings-2);
     sphere.topFaceRing();
+}
+
+}
+
+UnsignedInt uvSphereSolidVertexCount(const UnsignedInt rings, const UnsignedInt segments, const UVSphereFlags flags) {
+    CORRADE_ASSERT(rings >= 2 && segments >= 3,
+        "Primitives::uvSphereSolidVertexCount(): at least two rings and three segments expected", {});
+    return Implementation::Spheroid::vertexCount(segments, Implementation::Spheroid::Flag(UnsignedByte(flags)), rings - 1, 2);
+}
 
+UnsignedInt uvSphereSolidIndexCount(const UnsignedInt rings, const UnsignedInt segments) {
+    CORRADE_ASSERT(rings >= 2 && segments >= 3,
+        "Primitives::uvSphereSolidIndexCount(): at least two rings and three segments expected", {});
+    return Implementation::Spheroid::indexCount(segments, rings - 2, 2);
+}
+
+Trade::MeshData uvSphereSolid(const UnsignedInt rings, const UnsignedInt segments, const UVSphereFlags flags) {
+    CORRADE_ASSERT(rings >= 2 && segments >= 3,
+        "Primitives::uvSphereSolid(): at least two rings and three segments expected",
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+
+    Implementation::Spheroid sphere{segments, Implementation::Spheroid::Flag(UnsignedByte(flags)),
+        uvSphereSolidVertexCount(rings, segments, flags),
+        uvSphereSolidIndexCount(rings, segments)};
+    uvSphereSolidGenerate(sphere, rings);
     return sphere.finalize();
 }
 
+void uvSphereSolidInto(const UnsignedInt rings, const UnsignedInt segments, const UVSphereFlags flags, const Containers::StridedArrayView1D<Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals, const Containers::StridedArrayView1D<Vector4>& tangents, const Containers::StridedArrayView1D<Vector2>& textureCoordinates, const Containers::StridedArrayView1D<UnsignedInt>& indices) {
+    CORRADE_ASSERT(rings >= 2 && segments >= 3,
+        "Primitives::uvSphereSolidInto(): at least two rings and three segments expected", );
+
+    const Implementation::Spheroid::Flags spheroidFlags = Implementation::Spheroid::Flag(UnsignedByte(flags));
+    if(!Implementation::Spheroid::checkSizes("uvSphereSolidInto", spheroidFlags,
+        uvSphereSolidVertexCount(rings, segments, flags),
+        uvSphereSolidIndexCount(rings, segments),
+        positions, normals, tangents, textureCoordinates, indices))
+        return;
+
+    Implementation::Spheroid sphere{segments, spheroidFlags, positions, normals, tangents, textureCoordinates, indices};
+    uvSphereSolidGenerate(sphere, rings);
+    sphere.finish();
+}
+
 #ifdef MAGNUM_BUILD_DEPRECATED
 CORRADE_IGNORE_DEPRECATED_PUSH
 Trade::MeshData uvSphereSolid(const UnsignedInt rings, const UnsignedInt segments, const UVSphereTextureCoords textureCoords) {
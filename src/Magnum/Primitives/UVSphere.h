@@ -26,7 +26,7 @@
 */
 
 /** @file
- * @brief Class @ref Magnum::Primitives::uvSphereSolid(), @ref Magnum::Primitives::uvSphereWireframe()
+ * @brief Class @ref Magnum::Primitives::uvSphereSolid(), @ref Magnum::Primitives::uvSphereSolidVertexCount(), @ref Magnum::Primitives::uvSphereSolidIndexCount(), @ref Magnum::Primitives::uvSphereSolidInto(), @ref Magnum::Primitives::uvSphereWireframe()
  */
 
 #include <Corrade/Containers/EnumSet.h>
@@ -83,10 +83,47 @@ generated, vertices of one segment are duplicated for texture wrapping.
 
 @image html primitives-uvspheresolid.png width=256px
 
-@see @ref icosphereSolid()
+@see @ref icosphereSolid(), @ref uvSphereSolidInto()
 */
 MAGNUM_PRIMITIVES_EXPORT Trade::MeshData uvSphereSolid(UnsignedInt rings, UnsignedInt segments, UVSphereFlags flags = {});
 
+/**
+@brief Vertex count of a solid 3D UV sphere
+@m_since_latest
+
+Count of vertices generated by @ref uvSphereSolid() and expected by
+@ref uvSphereSolidInto(). Expects the same @p rings and @p segments
+constraints as @ref uvSphereSolid().
+*/
+MAGNUM_PRIMITIVES_EXPORT UnsignedInt uvSphereSolidVertexCount(UnsignedInt rings, UnsignedInt segments, UVSphereFlags flags = {});
+
+/**
+@brief Index count of a solid 3D UV sphere
+@m_since_latest
+
+Count of indices generated by @ref uvSphereSolid() and expected by
+@ref uvSphereSolidInto(). Expects the same @p rings and @p segments
+constraints as @ref uvSphereSolid().
+*/
+MAGNUM_PRIMITIVES_EXPORT UnsignedInt uvSphereSolidIndexCount(UnsignedInt rings, UnsignedInt segments);
+
+/**
+@brief Solid 3D UV sphere into existing views
+@m_since_latest
+
+A variant of @ref uvSphereSolid() that fills existing memory instead of
+allocating a new @ref Trade::MeshData, useful for example to write directly
+into a mapped GPU buffer or to reuse memory for repeatedly generated meshes.
+The @p positions and @p normals are expected to have
+@ref uvSphereSolidVertexCount() items. The @p tangents and
+@p textureCoordinates are expected to have the same size if
+@ref UVSphereFlag::Tangents or @relativeref{UVSphereFlag,TextureCoordinates}
+is set and to be empty otherwise. The @p indices are expected to have
+@ref uvSphereSolidIndexCount() items. The generated data are the same as with
+@ref uvSphereSolid().
+*/
+MAGNUM_PRIMITIVES_EXPORT void uvSphereSolidInto(UnsignedInt rings, UnsignedInt segments, UVSphereFlags flags, const Containers::StridedArrayView1D<Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals, const Containers::StridedArrayView1D<Vector4>& tangents, const Containers::StridedArrayView1D<Vector2>& textureCoordinates, const Containers::StridedArrayView1D<UnsignedInt>& indices);
+
 #ifdef MAGNUM_BUILD_DEPRECATED
 /**
 @brief Whether to generate UV sphere texture coordinates
@@ -0,0 +1,212 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ProfileScope.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum {
+
+namespace {
+
+/* Has to be a power of two so the indices can keep growing and wrap around
+   consistently when they overflow. 4096 events with 16 bytes each is 64 kB
+   per thread. */
+constexpr std::size_t BufferSize = 4096;
+static_assert(!(BufferSize & (BufferSize - 1)), "buffer size not a power of two");
+
+/* A single-producer single-consumer ring buffer. The producer is the thread
+   that owns it, the consumer is whoever calls profileScopeConsume(). Both
+   indices are only ever incremented, their difference is the count of
+   events not yet consumed. */
+struct Buffer {
+    Implementation::ProfileScopeEvent events[BufferSize];
+    std::atomic<std::size_t> write{0}, read{0};
+    /* Set by the producer on thread exit, after which it doesn't touch the
+       buffer anymore and the consumer is responsible for freeing it */
+    std::atomic<bool> finished{false};
+    /* Accessed only by the producer. Count of recorded scopes that are still
+       open, for each a slot has to be reserved for its end event. */
+    std::size_t depth{};
+    /* Guarded by Registry::mutex */
+    std::size_t id;
+    Buffer* next;
+};
+
+struct Registry {
+    ~Registry() {
+        for(Buffer* buffer = first; buffer; ) {
+            Buffer* const next = buffer->next;
+            delete buffer;
+            buffer = next;
+        }
+    }
+
+    std::mutex mutex;
+    Buffer* first{};
+    std::size_t nextId{};
+};
+
+Registry& registry() {
+    static Registry registry;
+    return registry;
+}
+
+/* Constant-initialized, so it's safe to check even during static
+   initialization */
+std::atomic<UnsignedInt> consumerCount{0};
+
+struct ThreadBuffer {
+    ~ThreadBuffer() {
+        if(buffer) buffer->finished.store(true, std::memory_order_release);
+    }
+
+    Buffer* buffer{};
+};
+
+#ifdef CORRADE_BUILD_MULTITHREADED
+thread_local
+#endif
+ThreadBuffer threadBuffer;
+
+Buffer& currentBuffer() {
+    if(!threadBuffer.buffer) {
+        Registry& r = registry();
+        Buffer* const buffer = new Buffer;
+        std::lock_guard<std::mutex> lock{r.mutex};
+        buffer->id = r.nextId++;
+        buffer->next = r.first;
+        r.first = buffer;
+        threadBuffer.buffer = buffer;
+    }
+
+    return *threadBuffer.buffer;
+}
+
+}
+
+ProfileScope::ProfileScope(const char* const name) noexcept: _recorded{false} {
+    CORRADE_ASSERT(name,
+        "ProfileScope: name can't be null", );
+
+    if(!consumerCount.load(std::memory_order_relaxed)) return;
+
+    Buffer& buffer = currentBuffer();
+    const std::size_t write = buffer.write.load(std::memory_order_relaxed);
+    const std::size_t read = buffer.read.load(std::memory_order_acquire);
+
+    /* Besides the begin event, there has to be space for the end events of
+       this and all currently open scopes, otherwise they'd have nowhere to
+       go */
+    if(write - read + buffer.depth + 2 > BufferSize) return;
+
+    buffer.events[write & (BufferSize - 1)] = {name, Implementation::profileScopeTime()};
+    buffer.write.store(write + 1, std::memory_order_release);
+    ++buffer.depth;
+    _recorded = true;
+}
+
+ProfileScope::~ProfileScope() {
+    if(!_recorded) return;
+
+    /* Space for this event is guaranteed by the check in the constructor */
+    Buffer& buffer = *threadBuffer.buffer;
+    const std::size_t write = buffer.write.load(std::memory_order_relaxed);
+    buffer.events[write & (BufferSize - 1)] = {nullptr, Implementation::profileScopeTime()};
+    buffer.write.store(write + 1, std::memory_order_release);
+    --buffer.depth;
+}
+
+namespace Implementation {
+
+void profileScopeAcquire() {
+    consumerCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+void profileScopeRelease() {
+    CORRADE_INTERNAL_ASSERT(consumerCount.load(std::memory_order_relaxed));
+    consumerCount.fetch_sub(1, std::memory_order_relaxed);
+}
+
+UnsignedLong profileScopeTime() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void profileScopeConsume(void(*const callback)(void*, std::size_t, const ProfileScopeEvent*, std::size_t), void* const state) {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock{r.mutex};
+
+    for(Buffer** next = &r.first; *next; ) {
+        Buffer& buffer = **next;
+
+        /* Query the finished flag first so if it's set, all events the
+           thread recorded are visible in the write index loaded below */
+        const bool finished = buffer.finished.load(std::memory_order_acquire);
+        const std::size_t write = buffer.write.load(std::memory_order_acquire);
+        std::size_t read = buffer.read.load(std::memory_order_relaxed);
+
+        /* If the range wraps around, pass it to the callback in two parts */
+        while(read != write) {
+            const std::size_t offset = read & (BufferSize - 1);
+            const std::size_t count = Math::min(write - read, BufferSize - offset);
+            callback(state, buffer.id, buffer.events + offset, count);
+            read += count;
+        }
+        buffer.read.store(read, std::memory_order_release);
+
+        if(finished) {
+            *next = buffer.next;
+            delete &buffer;
+        } else next = &buffer.next;
+    }
+}
+
+#ifdef MAGNUM_PROFILING_ITT
+__itt_domain* profileScopeIttDomain() {
+    #ifdef CORRADE_TARGET_WINDOWS
+    static __itt_domain* const domain = __itt_domain_createA("Magnum");
+    #else
+    static __itt_domain* const domain = __itt_domain_create("Magnum");
+    #endif
+    return domain;
+}
+
+__itt_string_handle* profileScopeIttName(const char* const name) {
+    #ifdef CORRADE_TARGET_WINDOWS
+    return __itt_string_handle_createA(name);
+    #else
+    return __itt_string_handle_create(name);
+    #endif
+}
+#endif
+
+}
+
+}
@@ -0,0 +1,211 @@
+#ifndef Magnum_ProfileScope_h
+#define Magnum_ProfileScope_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::ProfileScope, macro @ref MAGNUM_PROFILE_SCOPE()
+ * @m_since_latest
+ */
+
+#include <Corrade/Utility/Macros.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/visibility.h"
+
+#ifdef MAGNUM_PROFILING_TRACY
+#include <tracy/Tracy.hpp>
+#elif defined(MAGNUM_PROFILING_ITT)
+#include <ittnotify.h>
+#endif
+
+namespace Magnum {
+
+/**
+@brief Named CPU profiling scope
+@m_since_latest
+
+RAII marker recording a steady clock timestamp on construction and on
+destruction. Scopes can be arbitrarily nested and can be used from any thread.
+The events are recorded into a fixed-size lock-free ring buffer that's
+allocated for each thread on first use, so recording a scope doesn't involve
+any allocation or synchronization with other threads. The buffers are
+consumed by @ref DebugTools::FrameProfiler if
+@ref DebugTools::FrameProfiler::enableScopes() is called, which then
+aggregates the scopes into a tree and shows it in its statistics output.
+
+@snippet Magnum.cpp ProfileScope-usage
+
+If there's no consumer, recording is disabled and the scope cost is a single
+relaxed atomic load. If the consumer doesn't keep up and the buffer for given
+thread is full, newly opened scopes on that thread are not recorded. Scopes
+that are already recorded are always closed properly.
+
+The @p name is not copied, only the pointer is stored, so it's expected to be
+a string literal or otherwise live at least until the consumer processes the
+recorded data. Scopes are matched by the string contents, not the pointer.
+
+@section ProfileScope-library-scopes Scopes in Magnum libraries
+
+When Magnum is built with @ref MAGNUM_BUILD_PROFILING enabled, selected
+potentially expensive operations are marked with the
+@ref MAGNUM_PROFILE_SCOPE() macro. Without the option the macro expands to
+nothing and the library code has no overhead. The marked operations are:
+
+-   shader compilation and linking, draws, compute dispatches, buffer data
+    uploads and @ref GL::Context::resetState() in the @ref GL library
+-   opening files and loading meshes, scenes, animations, materials and
+    images in @ref Trade::AbstractImporter
+-   @ref MeshTools::compile() and the @ref Trade::MeshData-based
+    @ref MeshTools algorithms
+-   @ref SceneGraph::Camera::draw()
+
+By default the macro creates a @ref ProfileScope, so the library scopes show
+up in @ref DebugTools::FrameProfiler together with scopes in application
+code. The `MAGNUM_PROFILING_BACKEND` CMake option can be set to `Tracy` or
+`Itt` to map the macro to a [Tracy](https://github.com/wolfpld/tracy) zone or
+an [Intel ITT](https://github.com/intel/ittapi) task instead, for use with
+Tracy or VTune without patching the library. In that case the scopes aren't
+recorded into the @ref ProfileScope buffers and
+@ref MAGNUM_PROFILING_TRACY or @ref MAGNUM_PROFILING_ITT is defined. Memory
+allocation tracking in Tracy is done by replacing the global allocation
+functions in the application and isn't affected by this option. See
+@ref building-features for more information.
+*/
+class MAGNUM_EXPORT ProfileScope {
+    public:
+        /**
+         * @brief Begin a scope
+         * @param name      Scope name. Expected to be non-null and have
+         *      at least the lifetime of the recorded data, see above.
+         */
+        explicit ProfileScope(const char* name) noexcept;
+
+        /** @brief Copying is not allowed */
+        ProfileScope(const ProfileScope&) = delete;
+
+        /** @brief Moving is not allowed */
+        ProfileScope(ProfileScope&&) = delete;
+
+        /** @brief End the scope */
+        ~ProfileScope();
+
+        /** @brief Copying is not allowed */
+        ProfileScope& operator=(const ProfileScope&) = delete;
+
+        /** @brief Moving is not allowed */
+        ProfileScope& operator=(ProfileScope&&) = delete;
+
+        /**
+         * @brief Whether the scope is recorded
+         *
+         * Returns @cpp false @ce if there was no consumer at the time the
+         * scope was opened or if the buffer for this thread was full.
+         */
+        bool isRecorded() const { return _recorded; }
+
+    private:
+        bool _recorded;
+};
+
+namespace Implementation {
+
+/* Consumer interface used by DebugTools::FrameProfiler. Not a public API. */
+
+struct ProfileScopeEvent {
+    /* nullptr for the end of a scope */
+    const char* name;
+    /* Nanoseconds of std::chrono::steady_clock */
+    UnsignedLong time;
+};
+
+/* Enables or disables recording, reference-counted. While disabled, the
+   scopes are not recorded. */
+MAGNUM_EXPORT void profileScopeAcquire();
+MAGNUM_EXPORT void profileScopeRelease();
+
+/* Current time in the same units as ProfileScopeEvent::time */
+MAGNUM_EXPORT UnsignedLong profileScopeTime();
+
+/* Calls the callback for all events recorded since the last call, in order
+   for each thread. The `thread` is an unique ID of the thread the events come
+   from, events of one thread may be split into more than one call. Buffers of
+   threads that exited are freed once their events are consumed. Only one
+   consumer is meant to call this at a time, otherwise each gets just a part
+   of the events. */
+MAGNUM_EXPORT void profileScopeConsume(void(*callback)(void* state, std::size_t thread, const ProfileScopeEvent* events, std::size_t count), void* state);
+
+#ifdef MAGNUM_PROFILING_ITT
+/* Domain all library scopes are recorded in */
+MAGNUM_EXPORT __itt_domain* profileScopeIttDomain();
+
+/* Creates a task name handle. Hides the difference between narrow and wide
+   string variants on Windows. */
+MAGNUM_EXPORT __itt_string_handle* profileScopeIttName(const char* name);
+
+struct IttProfileScope {
+    explicit IttProfileScope(__itt_string_handle* name) noexcept: domain{profileScopeIttDomain()} {
+        __itt_task_begin(domain, __itt_null, __itt_null, name);
+    }
+
+    ~IttProfileScope() {
+        __itt_task_end(domain);
+    }
+
+    __itt_domain* domain;
+};
+#endif
+
+}
+
+}
+
+/** @hideinitializer
+@brief Mark a profiling scope in Magnum libraries
+@m_since_latest
+
+If Magnum is built with @ref MAGNUM_BUILD_PROFILING, creates a
+@ref Magnum::ProfileScope with given name that's alive until the end of the
+current scope. If @ref MAGNUM_PROFILING_TRACY or @ref MAGNUM_PROFILING_ITT is
+defined, creates a Tracy zone or an ITT task instead. Otherwise expands to
+nothing. The @p name is expected to be a string literal.
+@see @ref ProfileScope-library-scopes
+*/
+#if defined(MAGNUM_BUILD_PROFILING) || defined(DOXYGEN_GENERATING_OUTPUT)
+#ifdef MAGNUM_PROFILING_TRACY
+#define MAGNUM_PROFILE_SCOPE(name) ZoneScopedN(name)
+#elif defined(MAGNUM_PROFILING_ITT)
+#define MAGNUM_PROFILE_SCOPE(name)                                          \
+    static __itt_string_handle* const _CORRADE_HELPER_PASTE(magnumProfileScopeName, __LINE__) = Magnum::Implementation::profileScopeIttName(name); \
+    const Magnum::Implementation::IttProfileScope _CORRADE_HELPER_PASTE(magnumProfileScope, __LINE__){_CORRADE_HELPER_PASTE(magnumProfileScopeName, __LINE__)}
+#else
+#define MAGNUM_PROFILE_SCOPE(name)                                          \
+    const Magnum::ProfileScope _CORRADE_HELPER_PASTE(magnumProfileScope, __LINE__){name}
+#endif
+#else
+#define MAGNUM_PROFILE_SCOPE(name) do {} while(false)
+#endif
+
+#endif
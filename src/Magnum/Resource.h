@@ -132,11 +132,11 @@ class Resource {
          * Creates empty resource. Resources are acquired from the manager by
          * calling @ref ResourceManager::get().
          */
-        explicit Resource(): _manager{nullptr}, _lastCheck{0}, _state{ResourceState::Final}, _data{nullptr} {}
+        explicit Resource(): _manager{nullptr}, _handle{}, _lastCheck{0}, _state{ResourceState::Final}, _data{nullptr} {}
 
         /** @brief Copy constructor */
-        Resource(const Resource<T, U>& other): _manager{other._manager}, _key{other._key}, _lastCheck{other._lastCheck}, _state{other._state}, _data{other._data} {
-            if(_manager) _manager->incrementReferenceCount(_key);
+        Resource(const Resource<T, U>& other): _manager{other._manager}, _key{other._key}, _handle{other._handle}, _lastCheck{other._lastCheck}, _state{other._state}, _data{other._data} {
+            if(_manager) _manager->incrementReferenceCount(_handle);
         }
 
         /** @brief Move constructor */
@@ -144,7 +144,7 @@ class Resource {
 
         /** @brief Destructor */
         ~Resource() {
-            if(_manager) _manager->decrementReferenceCount(_key);
+            if(_manager) _manager->decrementReferenceCount(_handle);
         }
 
         /** @brief Copy assignment */
@@ -236,35 +236,40 @@ class Resource {
         friend Implementation::ResourceManagerData<T>;
         #endif
 
-        Resource(Implementation::ResourceManagerData<T>* manager, ResourceKey key): _manager{manager}, _key{key}, _lastCheck{0}, _state{ResourceState::NotLoaded}, _data{nullptr} {
-            manager->incrementReferenceCount(key);
+        Resource(Implementation::ResourceManagerData<T>* manager, ResourceKey key, UnsignedInt handle): _manager{manager}, _key{key}, _handle{handle}, _lastCheck{0}, _state{ResourceState::NotLoaded}, _data{nullptr} {
+            manager->incrementReferenceCount(handle);
         }
 
         void acquire();
 
         Implementation::ResourceManagerData<T>* _manager;
         ResourceKey _key;
+        /* Index of the resource slot in the manager, stays the same for as
+           long as the resource is referenced */
+        UnsignedInt _handle;
         std::size_t _lastCheck;
         ResourceState _state;
         T* _data;
 };
 
 template<class T, class U> Resource<T, U>& Resource<T, U>::operator=(const Resource<T, U>& other) {
-    if(_manager) _manager->decrementReferenceCount(_key);
+    if(_manager) _manager->decrementReferenceCount(_handle);
 
     _manager = other._manager;
     _key = other._key;
+    _handle = other._handle;
     _lastCheck = other._lastCheck;
     _state = other._state;
     _data = other._data;
 
-    if(_manager) _manager->incrementReferenceCount(_key);
+    if(_manager) _manager->incrementReferenceCount(_handle);
     return *this;
 }
 
-template<class T, class U> Resource<T, U>::Resource(Resource<T, U>&& other) noexcept: _manager(other._manager), _key(other._key), _lastCheck(other._lastCheck), _state(other._state), _data(other._data) {
+template<class T, class U> Resource<T, U>::Resource(Resource<T, U>&& other) noexcept: _manager(other._manager), _key(other._key), _handle(other._handle), _lastCheck(other._lastCheck), _state(other._state), _data(other._data) {
     other._manager = nullptr;
     other._key = {};
+    other._handle = 0;
     other._lastCheck = 0;
     other._state = ResourceState::Final;
     other._data = nullptr;
@@ -274,6 +279,7 @@ template<class T, class U> Resource<T, U>& Resource<T, U>::operator=(Resource<T,
     using std::swap;
     swap(_manager, other._manager);
     swap(_key, other._key);
+    swap(_handle, other._handle);
     swap(_lastCheck, other._lastCheck);
     swap(_state, other._state);
     swap(_data, other._data);
@@ -288,7 +294,7 @@ template<class T, class U> void Resource<T, U>::acquire() {
     if(_manager->lastChange() <= _lastCheck) return;
 
     /* Acquire new data and save last check time */
-    const typename Implementation::ResourceManagerData<T>::Data& d = _manager->data(_key);
+    const typename Implementation::ResourceManagerData<T>::Data& d = _manager->data(_handle);
     _lastCheck = _manager->lastChange();
 
     /* Try to get the data */
@@ -29,7 +29,9 @@
  * @brief Class @ref Magnum::ResourceManager, @ref Magnum::ResourceDataState, @ref Magnum::ResourcePolicy
  */
 
-#include <unordered_map>
+#include <chrono>
+#include <list>
+#include <vector>
 #include <Corrade/Containers/Pointer.h>
 
 #include "Magnum/Resource.h"
@@ -86,7 +88,18 @@ enum class ResourcePolicy: UnsignedByte {
     Manual,
 
     /** The resource will be unloaded when last reference to it is gone. */
-    ReferenceCounted
+    ReferenceCounted,
+
+    /**
+     * The resource will stay cached when the last reference to it is gone
+     * and will be unloaded only once the total size of unreferenced cached
+     * resources of given type exceeds @ref ResourceManager::cacheBudget(),
+     * least recently used first, or when calling
+     * @ref ResourceManager::free(). See
+     * @ref ResourceManager-cache for more information.
+     * @m_since_latest
+     */
+    Cached
 };
 
 template<class> class AbstractResourceLoader;
@@ -110,7 +123,7 @@ template<class T> class ResourceManagerData {
 
         std::size_t lastChange() const { return _lastChange; }
 
-        std::size_t count() const { return _data.size(); }
+        std::size_t count() const { return _count; }
 
         std::size_t referenceCount(ResourceKey key) const;
 
@@ -118,7 +131,7 @@ template<class T> class ResourceManagerData {
 
         template<class U> Resource<T, U> get(ResourceKey key);
 
-        void set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy);
+        void set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy, std::size_t size = 0);
 
         T* fallback() { return _fallback; }
         const T* fallback() const { return _fallback; }
@@ -127,7 +140,23 @@ template<class T> class ResourceManagerData {
 
         void free();
 
-        void clear() { _data.clear(); }
+        void clear() {
+            _slots.clear();
+            _freeSlots.clear();
+            _index.clear();
+            _count = 0;
+            _cache.clear();
+            _cachedSize = 0;
+        }
+
+        std::size_t cacheBudget() const { return _cacheBudget; }
+
+        std::size_t cachedSize() const { return _cachedSize; }
+
+        void setCacheBudget(std::size_t size) {
+            _cacheBudget = size;
+            cacheEvict(NoHandle);
+        }
 
         AbstractResourceLoader<T>* loader() { return _loader; }
         const AbstractResourceLoader<T>* loader() const { return _loader; }
@@ -136,24 +165,49 @@ template<class T> class ResourceManagerData {
 
         void setLoader(AbstractResourceLoader<T>* loader);
 
+        std::size_t update(std::chrono::nanoseconds budget);
+
     protected:
         ResourceManagerData(): _fallback(nullptr), _loader(nullptr), _lastChange(0) {}
 
     private:
         struct Data;
 
-        const Data& data(ResourceKey key) { return _data[key]; }
+        enum: UnsignedInt { NoHandle = ~UnsignedInt{} };
 
-        void incrementReferenceCount(ResourceKey key) {
-            ++_data[key].referenceCount;
-        }
+        /* Resources are stored in _slots, indices of unused slots are in
+           _freeSlots. A slot index doesn't change for the whole lifetime of
+           a resource, so it's used as a handle by Resource to access the data
+           without a lookup. The _index is an open-addressing hash table with
+           linear probing mapping keys to slot indices plus one, with zero
+           denoting an empty bucket. */
+        UnsignedInt find(ResourceKey key) const;
+        UnsignedInt insert(ResourceKey key);
+        void erase(UnsignedInt handle);
+        void insertIntoIndex(UnsignedInt handle);
 
-        void decrementReferenceCount(ResourceKey key);
+        const Data& data(UnsignedInt handle) const { return _slots[handle]; }
 
-        std::unordered_map<ResourceKey, Data> _data;
+        void incrementReferenceCount(UnsignedInt handle);
+
+        void decrementReferenceCount(UnsignedInt handle);
+
+        /* Unreferenced resources with ResourcePolicy::Cached are in _cache,
+           least recently used first */
+        void cacheAdd(UnsignedInt handle);
+        void cacheRemove(UnsignedInt handle);
+        void cacheEvict(UnsignedInt keep);
+
+        std::vector<Data> _slots;
+        std::vector<UnsignedInt> _freeSlots;
+        std::vector<UnsignedInt> _index;
+        std::size_t _count{};
+        std::list<UnsignedInt> _cache;
         T* _fallback;
         AbstractResourceLoader<T>* _loader;
         std::size_t _lastChange;
+        std::size_t _cacheBudget{~std::size_t{}};
+        std::size_t _cachedSize{};
 };
 
 /* Helper class for defining which real types are in the type pack */
@@ -185,7 +239,8 @@ The resources can be managed in three ways - resident resources, which stay in
 memory for whole lifetime of the manager, manually managed resources, which
 can be deleted by calling @ref free() if nothing references them anymore, and
 reference counted resources, which are deleted as soon as the last reference
-to them is removed.
+to them is removed. See also @ref ResourceManager-cache below for a fourth way
+that's in between the last two.
 
 Resource state and policy is configured when setting the resource data in
 @ref set() and can be changed each time the data are updated, although already
@@ -218,6 +273,27 @@ Basic usage is:
 </li>
 </ul>
 
+@section ResourceManager-cache Caching unreferenced resources
+
+With @ref ResourcePolicy::ReferenceCounted, a resource that's repeatedly
+acquired and released is repeatedly loaded and unloaded as well --- for
+example when the camera moves back and forth across a boundary of a streamed
+chunk of the world. Resources set with @ref ResourcePolicy::Cached stay in the
+manager after the last reference is gone and are unloaded only once the total
+size of such unreferenced resources exceeds a per-type budget set via
+@ref setCacheBudget(), least recently released first. If the resource is
+acquired again before that happens, it's reused without going through the
+loader.
+
+The size is passed as the last parameter of @ref set() and is in arbitrary
+units, usually bytes of CPU or GPU memory the resource occupies. The budget is
+unlimited by default, making the policy behave like
+@ref ResourcePolicy::Manual until a budget is set. The budget is checked each
+time a resource gets released or set, with the exception that a resource that
+was just set isn't evicted before it's acquired for the first time.
+
+@snippet Magnum.cpp ResourceManager-cache
+
 @see @ref AbstractResourceLoader
 */
 /* Due to too much work involved with explicit template instantiation (all
@@ -282,12 +358,15 @@ template<class... Types> class ResourceManager: private Implementation::Resource
          * zero reference count. It means that all reference counted resources
          * which were only loaded but not used will stay loaded and you need to
          * explicitly call @ref free() to delete them.
+         *
+         * The @p size is used only by @ref ResourcePolicy::Cached, see
+         * @ref ResourceManager-cache for more information.
          * @attention Subsequent updates are not possible if resource state is
          *      already @ref ResourceState::Final.
          * @see @ref referenceCount(), @ref state()
          */
-        template<class T> ResourceManager<Types...>& set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy) {
-            this->Implementation::ResourceManagerData<T>::set(key, data, state, policy);
+        template<class T> ResourceManager<Types...>& set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy, std::size_t size = 0) {
+            this->Implementation::ResourceManagerData<T>::set(key, data, state, policy, size);
             return *this;
         }
 
@@ -295,14 +374,14 @@ template<class... Types> class ResourceManager: private Implementation::Resource
          * @overload
          * @m_since{2019,10}
          */
-        template<class T> ResourceManager<Types...>& set(ResourceKey key, Containers::Pointer<T>&& data, ResourceDataState state, ResourcePolicy policy) {
-            set(key, data.release(), state, policy);
+        template<class T> ResourceManager<Types...>& set(ResourceKey key, Containers::Pointer<T>&& data, ResourceDataState state, ResourcePolicy policy, std::size_t size = 0) {
+            set(key, data.release(), state, policy, size);
             return *this;
         }
 
         /** @overload */
-        template<class U> ResourceManager<Types...>& set(ResourceKey key, U&& data, ResourceDataState state, ResourcePolicy policy) {
-            return set(key, new typename std::decay<U>::type(std::forward<U>(data)), state, policy);
+        template<class U> ResourceManager<Types...>& set(ResourceKey key, U&& data, ResourceDataState state, ResourcePolicy policy, std::size_t size = 0) {
+            return set(key, new typename std::decay<U>::type(std::forward<U>(data)), state, policy, size);
         }
 
         /**
@@ -359,6 +438,45 @@ template<class... Types> class ResourceManager: private Implementation::Resource
             return setFallback(new typename std::decay<U>::type(std::forward<U>(data)));
         }
 
+        /**
+         * @brief Cache budget for given type of resources
+         * @m_since_latest
+         *
+         * Max total size of unreferenced resources with
+         * @ref ResourcePolicy::Cached. Unlimited by default.
+         * @see @ref cachedSize(), @ref ResourceManager-cache
+         */
+        template<class T> std::size_t cacheBudget() const {
+            return this->Implementation::ResourceManagerData<T>::cacheBudget();
+        }
+
+        /**
+         * @brief Set cache budget for given type of resources
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * If the total size of currently cached resources exceeds @p size,
+         * least recently used resources are unloaded until it fits.
+         * @see @ref ResourceManager-cache
+         */
+        template<class T> ResourceManager<Types...>& setCacheBudget(std::size_t size) {
+            this->Implementation::ResourceManagerData<T>::setCacheBudget(size);
+            return *this;
+        }
+
+        /**
+         * @brief Total size of cached resources of given type
+         * @m_since_latest
+         *
+         * Sum of sizes of resources with @ref ResourcePolicy::Cached that
+         * aren't referenced by anything, as passed to @ref set(). Never larger
+         * than @ref cacheBudget(), except for resources that were set but not
+         * acquired yet.
+         */
+        template<class T> std::size_t cachedSize() const {
+            return this->Implementation::ResourceManagerData<T>::cachedSize();
+        }
+
         /**
          * @brief Free all resources of given type which are not referenced
          * @return Reference to self (for method chaining)
@@ -431,6 +549,25 @@ template<class... Types> class ResourceManager: private Implementation::Resource
             return setLoader(loader.release());
         }
 
+        /**
+         * @brief Process asynchronously loaded resources
+         * @param budget    Time budget. If zero, all resources that are
+         *      ready are processed.
+         * @return Count of processed resources
+         * @m_since_latest
+         *
+         * Calls @ref AbstractResourceLoader::update() on loaders of all
+         * types, passing each the remaining part of @p budget. Meant to be
+         * called once per frame on the thread that owns the manager, such as
+         * after swapping buffers. Each loader processes at least one ready
+         * resource even if the budget was already exhausted, so the loading
+         * always makes progress. See @ref AsyncResourceLoader for more
+         * information.
+         */
+        std::size_t update(std::chrono::nanoseconds budget = {}) {
+            return updateInternal(budget, std::chrono::steady_clock::now(), Implementation::ResourceTypePack<Types...>{});
+        }
+
     private:
         template<class FirstType, class ...NextTypes> void freeInternal(Implementation::ResourceTypePack<FirstType, NextTypes...>) {
             free<FirstType>();
@@ -444,6 +581,19 @@ template<class... Types> class ResourceManager: private Implementation::Resource
         }
         void clearInternal(Implementation::ResourceTypePack<>) const {}
 
+        template<class FirstType, class ...NextTypes> std::size_t updateInternal(const std::chrono::nanoseconds budget, const std::chrono::steady_clock::time_point start, Implementation::ResourceTypePack<FirstType, NextTypes...>) {
+            /* A zero budget means unlimited, so if the budget is exhausted
+               pass the smallest non-zero value instead */
+            std::chrono::nanoseconds remaining = budget;
+            if(budget != std::chrono::nanoseconds{}) {
+                const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+                remaining = elapsed < budget ? budget - elapsed : std::chrono::nanoseconds{1};
+            }
+            const std::size_t count = Implementation::ResourceManagerData<FirstType>::update(remaining);
+            return count + updateInternal(budget, start, Implementation::ResourceTypePack<NextTypes...>{});
+        }
+        std::size_t updateInternal(std::chrono::nanoseconds, std::chrono::steady_clock::time_point, Implementation::ResourceTypePack<>) const { return 0; }
+
         template<class FirstType, class ...NextTypes> void freeLoaders(Implementation::ResourceTypePack<FirstType, NextTypes...>) {
             Implementation::ResourceManagerData<FirstType>::freeLoader();
             freeLoaders(Implementation::ResourceTypePack<NextTypes...>{});
@@ -464,63 +614,87 @@ template<class T> ResourceManagerData<T>::~ResourceManagerData() {
 }
 
 template<class T> std::size_t ResourceManagerData<T>::referenceCount(const ResourceKey key) const {
-    auto it = _data.find(key);
-    if(it == _data.end()) return 0;
-    return it->second.referenceCount;
+    const UnsignedInt handle = find(key);
+    if(handle == NoHandle) return 0;
+    return _slots[handle].referenceCount;
 }
 
 template<class T> ResourceState ResourceManagerData<T>::state(const ResourceKey key) const {
-    const auto it = _data.find(key);
+    const UnsignedInt handle = find(key);
+    const Data* const d = handle == NoHandle ? nullptr : &_slots[handle];
 
     /* Resource not loaded */
-    if(it == _data.end() || !it->second.data) {
+    if(!d || !d->data) {
         /* Fallback found, add *Fallback to state */
         if(_fallback) {
-            if(it != _data.end() && it->second.state == ResourceDataState::Loading)
+            if(d && d->state == ResourceDataState::Loading)
                 return ResourceState::LoadingFallback;
-            else if(it != _data.end() && it->second.state == ResourceDataState::NotFound)
+            else if(d && d->state == ResourceDataState::NotFound)
                 return ResourceState::NotFoundFallback;
             else return ResourceState::NotLoadedFallback;
         }
 
         /* Fallback not found, loading didn't start yet */
-        if(it == _data.end() || (it->second.state != ResourceDataState::Loading && it->second.state != ResourceDataState::NotFound))
+        if(!d || (d->state != ResourceDataState::Loading && d->state != ResourceDataState::NotFound))
             return ResourceState::NotLoaded;
     }
 
     /* Loading / NotFound without fallback, Mutable / Final */
-    return static_cast<ResourceState>(it->second.state);
+    return static_cast<ResourceState>(d->state);
 }
 
 template<class T> template<class U> Resource<T, U> ResourceManagerData<T>::get(ResourceKey key) {
-    /* Ask loader for the data, if they aren't there yet */
-    if(_loader && _data.find(key) == _data.end())
-        _loader->load(key);
+    UnsignedInt handle = find(key);
+    if(handle == NoHandle) {
+        /* Ask loader for the data, if they aren't there yet. It may or may
+           not add the resource. */
+        if(_loader) {
+            _loader->load(key);
+            handle = find(key);
+        }
+
+        if(handle == NoHandle) handle = insert(key);
+    }
 
-    return Resource<T, U>(this, key);
+    return Resource<T, U>(this, key, handle);
 }
 
-template<class T> void ResourceManagerData<T>::set(const ResourceKey key, T* const data, const ResourceDataState state, const ResourcePolicy policy) {
-    auto it = _data.find(key);
+template<class T> void ResourceManagerData<T>::set(const ResourceKey key, T* const data, const ResourceDataState state, const ResourcePolicy policy, const std::size_t size) {
+    UnsignedInt handle = find(key);
 
     /* NotFound / Loading state shouldn't have any data */
     CORRADE_ASSERT((data == nullptr) == (state == ResourceDataState::NotFound || state == ResourceDataState::Loading),
         "ResourceManager::set(): data should be null if and only if state is NotFound or Loading", );
 
     /* Cannot change resource with already final state */
-    CORRADE_ASSERT(it == _data.end() || it->second.state != ResourceDataState::Final,
+    CORRADE_ASSERT(handle == NoHandle || _slots[handle].state != ResourceDataState::Final,
         "ResourceManager::set(): cannot change already final resource" << key, );
 
     /* Insert the resource, if not already there */
-    if(it == _data.end())
-        it = _data.emplace(key, Data()).first;
+    if(handle == NoHandle)
+        handle = insert(key);
+
+    /* Otherwise delete previous data and remove it from the cache, it gets
+       added back below if it's still cached */
+    else {
+        safeDelete(_slots[handle].data);
+        if(_slots[handle].policy == ResourcePolicy::Cached && !_slots[handle].referenceCount)
+            cacheRemove(handle);
+    }
 
-    /* Otherwise delete previous data */
-    else safeDelete(it->second.data);
+    Data& d = _slots[handle];
+    d.data = data;
+    d.state = state;
+    d.policy = policy;
+    d.size = size;
+
+    /* Cache the resource if it's not referenced yet, but don't evict it
+       before anybody had a chance to acquire it */
+    if(policy == ResourcePolicy::Cached && !d.referenceCount) {
+        cacheAdd(handle);
+        cacheEvict(handle);
+    }
 
-    it->second.data = data;
-    it->second.state = state;
-    it->second.policy = policy;
     ++_lastChange;
 }
 
@@ -534,10 +708,13 @@ template<class T> void ResourceManagerData<T>::setFallback(T* const data) {
 
 template<class T> void ResourceManagerData<T>::free() {
     /* Delete all non-referenced non-resident resources */
-    for(auto it = _data.begin(); it != _data.end(); ) {
-        if(it->second.policy != ResourcePolicy::Resident && !it->second.referenceCount)
-            it = _data.erase(it);
-        else ++it;
+    for(UnsignedInt i = 0; i != _slots.size(); ++i) {
+        const Data& d = _slots[i];
+        if(d.used && d.policy != ResourcePolicy::Resident && !d.referenceCount) {
+            if(d.policy == ResourcePolicy::Cached)
+                cacheRemove(i);
+            erase(i);
+        }
     }
 }
 
@@ -549,6 +726,10 @@ template<class T> void ResourceManagerData<T>::setLoader(AbstractResourceLoader<
     if((_loader = loader)) _loader->manager = this;
 }
 
+template<class T> std::size_t ResourceManagerData<T>::update(const std::chrono::nanoseconds budget) {
+    return _loader ? _loader->update(budget) : 0;
+}
+
 template<class T> void ResourceManagerData<T>::freeLoader() {
     if(!_loader) return;
 
@@ -556,21 +737,134 @@ template<class T> void ResourceManagerData<T>::freeLoader() {
     delete _loader;
 }
 
-template<class T> void ResourceManagerData<T>::decrementReferenceCount(ResourceKey key) {
-    auto it = _data.find(key);
-    CORRADE_INTERNAL_ASSERT(it != _data.end());
+template<class T> UnsignedInt ResourceManagerData<T>::find(const ResourceKey key) const {
+    if(_index.empty()) return NoHandle;
+
+    const std::size_t mask = _index.size() - 1;
+    for(std::size_t i = std::hash<ResourceKey>{}(key) & mask; _index[i]; i = (i + 1) & mask)
+        if(_slots[_index[i] - 1].key == key) return _index[i] - 1;
+
+    return NoHandle;
+}
+
+template<class T> UnsignedInt ResourceManagerData<T>::insert(const ResourceKey key) {
+    /* Reuse a free slot, if there's any */
+    UnsignedInt handle;
+    if(!_freeSlots.empty()) {
+        handle = _freeSlots.back();
+        _freeSlots.pop_back();
+    } else {
+        handle = UnsignedInt(_slots.size());
+        _slots.emplace_back();
+    }
+
+    _slots[handle].key = key;
+    _slots[handle].used = true;
+    ++_count;
+
+    /* Keep the load factor at most 3/4, otherwise add to the existing
+       index */
+    if(_count*4 > _index.size()*3) {
+        _index.assign(_index.empty() ? 16 : _index.size()*2, 0);
+        for(UnsignedInt i = 0; i != _slots.size(); ++i)
+            if(_slots[i].used) insertIntoIndex(i);
+    } else insertIntoIndex(handle);
+
+    return handle;
+}
+
+template<class T> void ResourceManagerData<T>::insertIntoIndex(const UnsignedInt handle) {
+    const std::size_t mask = _index.size() - 1;
+    std::size_t i = std::hash<ResourceKey>{}(_slots[handle].key) & mask;
+    while(_index[i]) i = (i + 1) & mask;
+    _index[i] = handle + 1;
+}
+
+template<class T> void ResourceManagerData<T>::erase(const UnsignedInt handle) {
+    Data& d = _slots[handle];
+
+    /* Find the bucket with the handle */
+    const std::size_t mask = _index.size() - 1;
+    std::size_t i = std::hash<ResourceKey>{}(d.key) & mask;
+    while(_index[i] != handle + 1) i = (i + 1) & mask;
+
+    /* Instead of leaving a tombstone, shift back all following entries in
+       the probe sequence that would become unreachable */
+    for(std::size_t j = (i + 1) & mask; _index[j]; j = (j + 1) & mask) {
+        const std::size_t home = std::hash<ResourceKey>{}(_slots[_index[j] - 1].key) & mask;
+        if((j > i && (home <= i || home > j)) ||
+           (j < i && (home <= i && home > j))) {
+            _index[i] = _index[j];
+            i = j;
+        }
+    }
+    _index[i] = 0;
+
+    /* Clear the slot and put it to the free list */
+    safeDelete(d.data);
+    d.key = {};
+    d.data = nullptr;
+    d.state = ResourceDataState::Mutable;
+    d.policy = ResourcePolicy::Manual;
+    d.size = 0;
+    d.used = false;
+    _freeSlots.push_back(handle);
+    --_count;
+}
+
+template<class T> void ResourceManagerData<T>::incrementReferenceCount(const UnsignedInt handle) {
+    Data& d = _slots[handle];
+
+    /* The resource is used again, remove it from the cache */
+    if(!d.referenceCount++ && d.policy == ResourcePolicy::Cached)
+        cacheRemove(handle);
+}
+
+template<class T> void ResourceManagerData<T>::decrementReferenceCount(const UnsignedInt handle) {
+    Data& d = _slots[handle];
+    CORRADE_INTERNAL_ASSERT(d.used);
+    if(--d.referenceCount) return;
 
     /* Free the resource if it is reference counted */
-    if(--it->second.referenceCount == 0 && it->second.policy == ResourcePolicy::ReferenceCounted)
-        _data.erase(it);
+    if(d.policy == ResourcePolicy::ReferenceCounted)
+        erase(handle);
+
+    /* Or put it to the cache, possibly evicting older resources */
+    else if(d.policy == ResourcePolicy::Cached) {
+        cacheAdd(handle);
+        cacheEvict(NoHandle);
+    }
+}
+
+template<class T> void ResourceManagerData<T>::cacheAdd(const UnsignedInt handle) {
+    _slots[handle].cacheIterator = _cache.insert(_cache.end(), handle);
+    _cachedSize += _slots[handle].size;
+}
+
+template<class T> void ResourceManagerData<T>::cacheRemove(const UnsignedInt handle) {
+    _cache.erase(_slots[handle].cacheIterator);
+    _cachedSize -= _slots[handle].size;
+}
+
+template<class T> void ResourceManagerData<T>::cacheEvict(const UnsignedInt keep) {
+    while(_cachedSize > _cacheBudget && !_cache.empty()) {
+        const UnsignedInt handle = _cache.front();
+
+        /* The kept resource is always the most recent one, so if we got to
+           it, there's nothing else left to evict */
+        if(handle == keep) break;
+
+        cacheRemove(handle);
+        erase(handle);
+    }
 }
 
 template<class T> struct ResourceManagerData<T>::Data {
-    Data(): data(nullptr), state(ResourceDataState::Mutable), policy(ResourcePolicy::Manual), referenceCount(0) {}
+    Data(): data(nullptr), state(ResourceDataState::Mutable), policy(ResourcePolicy::Manual), referenceCount(0), size(0), used(false) {}
 
     Data(const Data&) = delete;
 
-    Data(Data&& other) noexcept: data{other.data}, state{other.state}, policy{other.policy}, referenceCount{other.referenceCount} {
+    Data(Data&& other) noexcept: key{other.key}, data{other.data}, state{other.state}, policy{other.policy}, referenceCount{other.referenceCount}, size{other.size}, cacheIterator{other.cacheIterator}, used{other.used} {
         other.data = nullptr;
         other.referenceCount = 0;
     }
@@ -580,10 +874,16 @@ template<class T> struct ResourceManagerData<T>::Data {
     Data& operator=(const Data&) = delete;
     Data& operator=(Data&&) = delete;
 
+    ResourceKey key;
     T* data;
     ResourceDataState state;
     ResourcePolicy policy;
     std::size_t referenceCount;
+    std::size_t size;
+    /* Valid only if policy is Cached and referenceCount is zero */
+    std::list<UnsignedInt>::iterator cacheIterator;
+    /* False if the slot is in the free list */
+    bool used;
 };
 
 template<class T> inline ResourceManagerData<T>::Data::~Data() {
@@ -106,6 +106,28 @@ just puts itself to rest and waits until some animation changes its state to
 permanently running into separate group, they will not be traversed every time
 the @ref AnimableGroup::step() gets called, saving precious frame time.
 
+@section SceneGraph-Animable-parallel Parallel animation steps
+
+With a large count of animables, @ref AnimableGroup::step() can spread the
+@ref animationStep() calls over multiple threads. Only animables marked with
+@ref setThreadSafe() are stepped in parallel, others are stepped serially on
+the calling thread. As the scene graph itself isn't thread-safe, a
+thread-safe @ref animationStep() is expected to only calculate the new
+animation state without touching the object or anything else shared,
+including calling @ref setState(), and apply the result in
+@ref animationCommit(), which is then called serially on the calling thread
+for all thread-safe animables in the order they are in the group:
+
+@snippet MagnumSceneGraph.cpp Animable-parallel
+
+The thread count is then passed to @ref AnimableGroup::step():
+
+@snippet MagnumSceneGraph.cpp Animable-parallel-step
+
+The thread-safe animables are stepped after all other animables regardless
+of the thread count passed to @ref AnimableGroup::step(), so the result is
+deterministic.
+
 @section SceneGraph-Animable-explicit-specializations Explicit template specializations
 
 The following specializations are explicitly compiled into @ref SceneGraph
@@ -201,6 +223,30 @@ template<UnsignedInt dimensions, class T> class Animable: public AbstractGrouped
             return *this;
         }
 
+        /**
+         * @brief Whether the animation step is thread-safe
+         * @m_since_latest
+         *
+         * @see @ref setThreadSafe()
+         */
+        bool isThreadSafe() const { return _threadSafe; }
+
+        /**
+         * @brief Mark the animation step as thread-safe
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * If enabled, @ref animationStep() can be called from a worker thread
+         * concurrently with other thread-safe animables and
+         * @ref animationCommit() gets called on the calling thread afterwards.
+         * Default is @cpp false @ce. See @ref SceneGraph-Animable-parallel
+         * for more information.
+         */
+        Animable<dimensions, T>& setThreadSafe(bool threadSafe) {
+            _threadSafe = threadSafe;
+            return *this;
+        }
+
         /**
          * @brief Group containing this animable
          *
@@ -243,6 +289,21 @@ template<UnsignedInt dimensions, class T> class Animable: public AbstractGrouped
          */
         virtual void animationStep(Float time, Float delta) = 0;
 
+        /**
+         * @brief Commit the animation step
+         * @m_since_latest
+         *
+         * Called from @ref AnimableGroup::step() on the calling thread after
+         * @ref animationStep() if the animable is marked with
+         * @ref setThreadSafe(), in the order the animables are in the group.
+         * Use it to apply the results calculated in @ref animationStep() to
+         * the object. Not called for animables that aren't thread-safe.
+         *
+         * Default implementation does nothing.
+         * @see @ref SceneGraph-Animable-parallel
+         */
+        virtual void animationCommit() {}
+
         /**
          * @brief Action on animation start
          *
@@ -298,7 +359,7 @@ template<UnsignedInt dimensions, class T> class Animable: public AbstractGrouped
         Float _duration;
         Float _startTime, _pauseTime;
         AnimationState _previousState, _currentState;
-        bool _repeated;
+        bool _repeated, _threadSafe;
         UnsignedShort _repeatCount;
         UnsignedShort _repeats;
 };
@@ -29,6 +29,7 @@
  * @brief @ref compilation-speedup-hpp "Template implementation" for @ref Animable.h and @ref AnimableGroup.h
  */
 
+#include "Magnum/TaskScheduler.h"
 #include "Magnum/Timeline.h"
 #include "Magnum/Math/Constants.h"
 #include "Magnum/SceneGraph/AnimableGroup.h"
@@ -36,7 +37,13 @@
 
 namespace Magnum { namespace SceneGraph {
 
-template<UnsignedInt dimensions, class T> Animable<dimensions, T>::Animable(AbstractObject<dimensions, T>& object, AnimableGroup<dimensions, T>* group): AbstractGroupedFeature<dimensions, Animable<dimensions, T>, T>{object, group}, _duration{0.0f}, _startTime{Constants::inf()}, _pauseTime{-Constants::inf()}, _previousState{AnimationState::Stopped}, _currentState{AnimationState::Stopped}, _repeated{false}, _repeatCount{0}, _repeats{0} {}
+namespace Implementation {
+    /* Count of thread-safe animables below which they're always stepped
+       on the calling thread */
+    enum: std::size_t { AnimableGroupParallelThreshold = 1024 };
+}
+
+template<UnsignedInt dimensions, class T> Animable<dimensions, T>::Animable(AbstractObject<dimensions, T>& object, AnimableGroup<dimensions, T>* group): AbstractGroupedFeature<dimensions, Animable<dimensions, T>, T>{object, group}, _duration{0.0f}, _startTime{Constants::inf()}, _pauseTime{-Constants::inf()}, _previousState{AnimationState::Stopped}, _currentState{AnimationState::Stopped}, _repeated{false}, _threadSafe{false}, _repeatCount{0}, _repeats{0} {}
 
 template<UnsignedInt dimensions, class T> Animable<dimensions, T>::~Animable() {
     /* Update count of running animations when deleting an animable that's
@@ -66,7 +73,7 @@ template<UnsignedInt dimensions, class T> const AnimableGroup<dimensions, T>* An
     return static_cast<const AnimableGroup<dimensions, T>*>(AbstractGroupedFeature<dimensions, Animable<dimensions, T>, T>::group());
 }
 
-template<UnsignedInt dimensions, class T> void AnimableGroup<dimensions, T>::step(const Float time, const Float delta) {
+template<UnsignedInt dimensions, class T> void AnimableGroup<dimensions, T>::step(const Float time, const Float delta, UnsignedInt threadCount) {
     if(!_runningCount && !wakeUp) return;
     wakeUp = false;
 
@@ -135,10 +142,34 @@ template<UnsignedInt dimensions, class T> void AnimableGroup<dimensions, T>::ste
             "SceneGraph::AnimableGroup::step(): animation was started in future - probably wrong time passed", );
         CORRADE_ASSERT(delta >= 0.0f,
             "SceneGraph::AnimableGroup::step(): negative delta passed", );
-        animable.animationStep(time - animable._startTime, delta);
+        if(animable._threadSafe)
+            _deferred.emplace_back(&animable, time - animable._startTime);
+        else
+            animable.animationStep(time - animable._startTime, delta);
     }
 
     CORRADE_INTERNAL_ASSERT((_runningCount <= AnimableGroup<dimensions, T>::size()));
+
+    if(_deferred.empty()) return;
+
+    /* Step the thread-safe animables on the global task scheduler if there's
+       enough of them, so no threads get created for each step */
+    if(threadCount != 1 && _deferred.size() >= Implementation::AnimableGroupParallelThreshold) {
+        TaskScheduler::global().parallelFor(_deferred.size(), threadCount, [this, delta](const std::size_t begin, const std::size_t end) {
+            stepDeferred(begin, end, delta);
+        });
+    } else stepDeferred(0, _deferred.size(), delta);
+
+    /* Commit the results serially in the group order, so the outcome doesn't
+       depend on the thread count */
+    for(const std::pair<Animable<dimensions, T>*, Float>& i: _deferred)
+        i.first->animationCommit();
+    _deferred.clear();
+}
+
+template<UnsignedInt dimensions, class T> void AnimableGroup<dimensions, T>::stepDeferred(const std::size_t begin, const std::size_t end, const Float delta) {
+    for(std::size_t i = begin; i != end; ++i)
+        _deferred[i].first->animationStep(_deferred[i].second, delta);
 }
 
 }}
@@ -60,17 +60,31 @@ template<UnsignedInt dimensions, class T> class AnimableGroup: public FeatureGro
 
         /**
          * @brief Perform animation step
-         * @param time      Absolute time (e.g. @ref Timeline::previousFrameTime())
-         * @param delta     Time delta for current frame (e.g. @ref Timeline::previousFrameDuration())
+         * @param time          Absolute time (e.g. @ref Timeline::previousFrameTime())
+         * @param delta         Time delta for current frame (e.g. @ref Timeline::previousFrameDuration())
+         * @param threadCount   Max count of threads to use for stepping
+         *      animables marked with @ref Animable::setThreadSafe(). If
+         *      @cpp 0 @ce, @ref TaskScheduler::threadCount() of
+         *      @ref TaskScheduler::global() is used.
          *
          * If there are no running animations the function does nothing.
+         * Thread-safe animables are stepped in parallel only if there's
+         * enough of them to outweigh the task submission overhead. The work is
+         * submitted to @ref TaskScheduler::global(), so no threads are
+         * created or joined in each step. See
+         * @ref SceneGraph-Animable-parallel for more information.
          * @see @ref runningCount()
          */
-        void step(Float time, Float delta);
+        void step(Float time, Float delta, UnsignedInt threadCount = 1);
 
     private:
+        void MAGNUM_SCENEGRAPH_LOCAL stepDeferred(std::size_t begin, std::size_t end, Float delta);
+
         std::size_t _runningCount;
         bool wakeUp;
+        /* Thread-safe animables and their animation time, stepped after all
+           others */
+        std::vector<std::pair<Animable<dimensions, T>*, Float>> _deferred;
 };
 
 /**
@@ -71,6 +71,25 @@ Common setup example for 3D scenes:
 
 @snippet MagnumSceneGraph.cpp Camera-3D
 
+@section SceneGraph-Camera-frustum-culling Frustum culling
+
+By default, @ref draw() calls @ref Drawable::draw() on every drawable in the
+group. If @ref setFrustumCulling() is enabled, drawables that have a bounding
+volume set via @ref Drawable::setBoundingSphere() or
+@ref Drawable::setBoundingBox() and which lie completely outside of the view
+are skipped. See @ref SceneGraph-Drawable-frustum-culling for an example.
+
+The clip planes are extracted from @ref projectionMatrix() in the camera
+space, which in 3D gives the same planes as @ref Math::Frustum::fromMatrix().
+The bounding volumes are transformed by the camera-relative transformations
+that are calculated for the drawing anyway, and tested against all planes in
+a batched branchless loop. The per-plane test is equivalent to
+@ref Math::Intersection::sphereFrustum() and
+@ref Math::Intersection::aabbFrustum() with the transformed box conservatively
+enlarged to stay axis-aligned. The test is conservative --- a drawable may
+get drawn even though it's not visible, but a visible drawable is never
+culled.
+
 @section SceneGraph-Camera-explicit-specializations Explicit template specializations
 
 The following specializations are explicitly compiled into @ref SceneGraph
@@ -186,6 +205,27 @@ template<UnsignedInt dimensions, class T> class Camera: public AbstractFeature<d
          */
         void setViewport(const Vector2i& size);
 
+        /**
+         * @brief Whether frustum culling is enabled
+         *
+         * @see @ref setFrustumCulling()
+         */
+        bool frustumCulling() const { return _frustumCulling; }
+
+        /**
+         * @brief Enable or disable frustum culling
+         * @return Reference to self (for method chaining)
+         *
+         * If enabled, both @ref draw() overloads skip drawables that have a
+         * bounding volume and are completely outside of the view. Disabled
+         * by default. See @ref SceneGraph-Camera-frustum-culling for more
+         * information.
+         */
+        Camera<dimensions, T>& setFrustumCulling(bool enabled) {
+            _frustumCulling = enabled;
+            return *this;
+        }
+
         /**
          * @brief Drawable transformations
          *
@@ -199,7 +239,8 @@ template<UnsignedInt dimensions, class T> class Camera: public AbstractFeature<d
         /**
          * @brief Draw
          *
-         * Draws given group of drawables.
+         * Draws given group of drawables. If @ref frustumCulling() is
+         * enabled, drawables outside of the view are skipped.
          * @see @ref draw(const std::vector<std::pair<std::reference_wrapper<Drawable<dimensions, T>>, MatrixTypeFor<dimensions, T>>>&)
          */
         void draw(DrawableGroup<dimensions, T>& group);
@@ -209,7 +250,9 @@ template<UnsignedInt dimensions, class T> class Camera: public AbstractFeature<d
          *
          * Useful in combination with @ref drawableTransformations() for
          * implementing custom draw order or object culling. See
-         * @ref SceneGraph-Drawable-draw-order for more information.
+         * @ref SceneGraph-Drawable-draw-order for more information. If
+         * @ref frustumCulling() is enabled, drawables outside of the view are
+         * skipped.
          */
         void draw(const std::vector<std::pair<std::reference_wrapper<Drawable<dimensions, T>>, MatrixTypeFor<dimensions, T>>>& drawableTransformations);
 
@@ -221,6 +264,11 @@ template<UnsignedInt dimensions, class T> class Camera: public AbstractFeature<d
 
         void fixAspectRatio();
 
+        /* Draws `count` drawables, `drawableTransformation(i)` returns a
+           pair of i-th drawable and its camera-relative transformation.
+           Performs frustum culling if enabled. */
+        template<class F> void drawInternal(std::size_t count, const F& drawableTransformation);
+
         MatrixTypeFor<dimensions, T> _rawProjectionMatrix;
         AspectRatioPolicy _aspectRatioPolicy;
 
@@ -228,6 +276,7 @@ template<UnsignedInt dimensions, class T> class Camera: public AbstractFeature<d
         MatrixTypeFor<dimensions, T> _cameraMatrix;
 
         Vector2i _viewport;
+        bool _frustumCulling;
 };
 
 /**
@@ -29,6 +29,7 @@
  * @brief @ref compilation-speedup-hpp "Template implementation" for @ref Camera.h
  */
 
+#include "Magnum/ProfileScope.h"
 #include "Magnum/Math/Functions.h"
 #include "Magnum/SceneGraph/Camera.h"
 #include "Magnum/SceneGraph/Drawable.h"
@@ -55,7 +56,7 @@ template<UnsignedInt dimensions, class T> MatrixTypeFor<dimensions, T> aspectRat
 
 }
 
-template<UnsignedInt dimensions, class T> Camera<dimensions, T>::Camera(AbstractObject<dimensions, T>& object): AbstractFeature<dimensions, T>(object), _aspectRatioPolicy(AspectRatioPolicy::NotPreserved) {
+template<UnsignedInt dimensions, class T> Camera<dimensions, T>::Camera(AbstractObject<dimensions, T>& object): AbstractFeature<dimensions, T>(object), _aspectRatioPolicy(AspectRatioPolicy::NotPreserved), _frustumCulling{false} {
     AbstractFeature<dimensions, T>::setCachedTransformations(CachedTransformation::InvertedAbsolute);
 }
 
@@ -109,6 +110,7 @@ template<UnsignedInt dimensions, class T> std::vector<std::pair<std::reference_w
 template<UnsignedInt dimensions, class T> void Camera<dimensions, T>::draw(DrawableGroup<dimensions, T>& group) {
     AbstractObject<dimensions, T>* scene = AbstractFeature<dimensions, T>::object().scene();
     CORRADE_ASSERT(scene, "SceneGraph::Camera::draw(): cannot draw when camera is not part of any scene", );
+    MAGNUM_PROFILE_SCOPE("SceneGraph::Camera::draw()");
 
     /* Compute camera matrix */
     AbstractFeature<dimensions, T>::object().setClean();
@@ -122,13 +124,78 @@ template<UnsignedInt dimensions, class T> void Camera<dimensions, T>::draw(Drawa
         scene->transformationMatrices(objects, _cameraMatrix);
 
     /* Perform the drawing */
-    for(std::size_t i = 0; i != transformations.size(); ++i)
-        group[i].draw(transformations[i], *this);
+    drawInternal(transformations.size(), [&](std::size_t i) {
+        return std::pair<Drawable<dimensions, T>&, const MatrixTypeFor<dimensions, T>&>{group[i], transformations[i]};
+    });
 }
 
 template<UnsignedInt dimensions, class T> void Camera<dimensions, T>::draw(const std::vector<std::pair<std::reference_wrapper<Drawable<dimensions, T>>, MatrixTypeFor<dimensions, T>>>& drawableTransformations) {
-    for(auto&& drawableTransformation: drawableTransformations)
-        drawableTransformation.first.get().draw(drawableTransformation.second, *this);
+    MAGNUM_PROFILE_SCOPE("SceneGraph::Camera::draw()");
+    drawInternal(drawableTransformations.size(), [&](std::size_t i) {
+        return std::pair<Drawable<dimensions, T>&, const MatrixTypeFor<dimensions, T>&>{drawableTransformations[i].first.get(), drawableTransformations[i].second};
+    });
+}
+
+template<UnsignedInt dimensions, class T> template<class F> void Camera<dimensions, T>::drawInternal(const std::size_t count, const F& drawableTransformation) {
+    if(!_frustumCulling) {
+        for(std::size_t i = 0; i != count; ++i) {
+            const std::pair<Drawable<dimensions, T>&, const MatrixTypeFor<dimensions, T>&> current = drawableTransformation(i);
+            current.first.draw(current.second, *this);
+        }
+        return;
+    }
+
+    /* Transform the bounding volumes to camera space. A sphere radius gets
+       scaled by the largest axis scale, box half-size is enlarged so the box
+       stays axis-aligned after rotation. Drawables without bounds are left
+       at zero and get drawn unconditionally below. */
+    std::vector<Math::Vector<dimensions, T>> centers(count);
+    std::vector<Math::Vector<dimensions, T>> halfSizes(count);
+    std::vector<T> radii(count);
+    for(std::size_t i = 0; i != count; ++i) {
+        const std::pair<Drawable<dimensions, T>&, const MatrixTypeFor<dimensions, T>&> current = drawableTransformation(i);
+        const Drawable<dimensions, T>& drawable = current.first;
+        if(drawable._bounds == DrawableBounds::None) continue;
+
+        const Math::Matrix<dimensions, T> rotationScaling = current.second.rotationScaling();
+        T maxScaleSquared{};
+        for(std::size_t j = 0; j != dimensions; ++j) {
+            halfSizes[i] += Math::abs(rotationScaling[j])*drawable._boundsHalfSize[j];
+            maxScaleSquared = Math::max(maxScaleSquared, rotationScaling[j].dot());
+        }
+        centers[i] = current.second.transformPoint(drawable._boundsCenter);
+        radii[i] = drawable._boundsRadius*Math::sqrt(maxScaleSquared);
+    }
+
+    /* Extract the clip planes from the projection matrix rows, with normals
+       pointing inside. In 3D this is the same as Math::Frustum::fromMatrix(),
+       the same construction works for the 2D projection as well. Then test
+       all drawables against one plane at a time in a branchless loop. */
+    const Math::Vector<dimensions + 1, T> w = _projectionMatrix.row(dimensions);
+    std::vector<UnsignedByte> outside(count);
+    for(std::size_t p = 0; p != 2*dimensions; ++p) {
+        const Math::Vector<dimensions + 1, T> row = _projectionMatrix.row(p/2);
+        const Math::Vector<dimensions + 1, T> plane = p % 2 ? w - row : w + row;
+        Math::Vector<dimensions, T> normal = Math::Vector<dimensions, T>::pad(plane);
+        T distance = plane[dimensions];
+        const T length = normal.length();
+        if(length != T(0)) {
+            normal /= length;
+            distance /= length;
+        }
+        const Math::Vector<dimensions, T> absNormal = Math::abs(normal);
+
+        for(std::size_t i = 0; i != count; ++i)
+            outside[i] |= UnsignedByte(Math::dot(normal, centers[i]) + distance < -(radii[i] + Math::dot(absNormal, halfSizes[i])));
+    }
+
+    /* Perform the drawing */
+    for(std::size_t i = 0; i != count; ++i) {
+        const std::pair<Drawable<dimensions, T>&, const MatrixTypeFor<dimensions, T>&> current = drawableTransformation(i);
+        if(outside[i] && current.first._bounds != DrawableBounds::None)
+            continue;
+        current.first.draw(current.second, *this);
+    }
 }
 
 }}
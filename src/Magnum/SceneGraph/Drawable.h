@@ -26,13 +26,37 @@
 */
 
 /** @file
- * @brief Class @ref Magnum::SceneGraph::Drawable, @ref Magnum::SceneGraph::DrawableGroup, alias @ref Magnum::SceneGraph::BasicDrawable2D, @ref Magnum::SceneGraph::BasicDrawable3D, @ref Magnum::SceneGraph::BasicDrawableGroup2D, @ref Magnum::SceneGraph::BasicDrawableGroup3D, typedef @ref Magnum::SceneGraph::Drawable2D, @ref Magnum::SceneGraph::Drawable3D, @ref Magnum::SceneGraph::DrawableGroup2D, @ref Magnum::SceneGraph::DrawableGroup3D
+ * @brief Class @ref Magnum::SceneGraph::Drawable, @ref Magnum::SceneGraph::DrawableGroup, enum @ref Magnum::SceneGraph::DrawableBounds, alias @ref Magnum::SceneGraph::BasicDrawable2D, @ref Magnum::SceneGraph::BasicDrawable3D, @ref Magnum::SceneGraph::BasicDrawableGroup2D, @ref Magnum::SceneGraph::BasicDrawableGroup3D, typedef @ref Magnum::SceneGraph::Drawable2D, @ref Magnum::SceneGraph::Drawable3D, @ref Magnum::SceneGraph::DrawableGroup2D, @ref Magnum::SceneGraph::DrawableGroup3D
  */
 
+#include "Magnum/Math/Range.h"
 #include "Magnum/SceneGraph/AbstractGroupedFeature.h"
 
 namespace Magnum { namespace SceneGraph {
 
+/**
+@brief Drawable bounding volume type
+
+@see @ref Drawable::bounds(), @ref Camera::setFrustumCulling()
+*/
+enum class DrawableBounds: UnsignedByte {
+    /**
+     * No bounding volume. The drawable is never culled. Default.
+     */
+    None,
+
+    /**
+     * Bounding sphere (or a circle in 2D), set with
+     * @ref Drawable::setBoundingSphere()
+     */
+    Sphere,
+
+    /**
+     * Axis-aligned bounding box, set with @ref Drawable::setBoundingBox()
+     */
+    Box
+};
+
 /**
 @brief Drawable
 
@@ -114,9 +138,11 @@ parameters once for whole group instead of setting them again in each
 @section SceneGraph-Drawable-draw-order Custom draw order and object culling
 
 By default all contents of a drawable group are drawn, in the order they were
-added. In some cases you may want to draw them in a different order (for
-example to have correctly sorted transparent objects) or draw just a subset
-(for example to cull invisible objects away). That can be achieved using
+added. Note that @ref DrawableGroup::remove() moves the last drawable to the
+place of the removed one, so the order changes after a removal. In some cases
+you may want to draw them in a different order (for example to have correctly
+sorted transparent objects) or draw just a subset (for example to cull
+invisible objects away). That can be achieved using
 @ref Camera::drawableTransformations() in combination with
 @ref Camera::draw(const std::vector<std::pair<std::reference_wrapper<Drawable<dimensions, T>>, MatrixTypeFor<dimensions, T>>>&).
 For example, to have the objects sorted back-to-front, apply @ref std::sort()
@@ -133,6 +159,26 @@ get used in any way except being passed to the draw function:
 
 @snippet MagnumSceneGraph.cpp Drawable-culling
 
+@section SceneGraph-Drawable-frustum-culling Builtin frustum culling
+
+For the common case of skipping drawables outside of the view, each drawable
+can be given a bounding volume relative to its object using either
+@ref setBoundingSphere() or @ref setBoundingBox(). When
+@ref Camera::setFrustumCulling() is enabled, @ref Camera::draw() transforms
+the volumes together with the objects and calls @ref draw() only on those
+that intersect the camera frustum. Drawables without a bounding volume are
+always drawn.
+
+@snippet MagnumSceneGraph.cpp Drawable-frustum-culling
+
+@section SceneGraph-Drawable-render-queue Sorting with a render queue
+
+Instead of sorting the drawable transformation list by hand, the drawables
+can be put into a @ref RenderQueue, which sorts opaque drawables
+front-to-back and transparent drawables back-to-front and draws them in two
+passes. Each drawable decides which entries it adds to the queue in
+@ref enqueue(). See the @ref RenderQueue documentation for more information.
+
 @section SceneGraph-Drawable-explicit-specializations Explicit template specializations
 
 The following specializations are explicitly compiled into @ref SceneGraph
@@ -187,6 +233,110 @@ template<UnsignedInt dimensions, class T> class Drawable: public AbstractGrouped
          * @ref SceneGraph::Camera::projectionMatrix() "Camera::projectionMatrix()".
          */
         virtual void draw(const MatrixTypeFor<dimensions, T>& transformationMatrix, Camera<dimensions, T>& camera) = 0;
+
+        /**
+         * @brief Add the drawable to a render queue
+         * @param queue                 Render queue
+         * @param transformationMatrix  Object transformation relative to
+         *      camera
+         * @m_since_latest
+         *
+         * Called from @ref RenderQueue::build(). Default implementation adds
+         * a single @ref RenderQueuePass::Opaque entry with order and payload
+         * set to @cpp 0 @ce, override to add a different or more entries.
+         * See @ref SceneGraph-RenderQueue-entries for more information.
+         */
+        virtual void enqueue(RenderQueue<dimensions, T>& queue, const MatrixTypeFor<dimensions, T>& transformationMatrix);
+
+        /**
+         * @brief Draw a render queue entry
+         * @param transformationMatrix  Entry transformation relative to
+         *      camera
+         * @param camera                Camera
+         * @param payload               Entry payload
+         * @m_since_latest
+         *
+         * Called from @ref RenderQueue::draw() for each entry added in
+         * @ref enqueue(). Default implementation calls
+         * @ref draw(const MatrixTypeFor<dimensions, T>&, Camera<dimensions, T>&) "draw()",
+         * ignoring the payload.
+         */
+        virtual void drawQueued(const MatrixTypeFor<dimensions, T>& transformationMatrix, Camera<dimensions, T>& camera, UnsignedInt payload);
+
+        /**
+         * @brief Bounding volume type
+         *
+         * Default is @ref DrawableBounds::None.
+         * @see @ref setBoundingSphere(), @ref setBoundingBox(),
+         *      @ref resetBounds()
+         */
+        DrawableBounds bounds() const { return _bounds; }
+
+        /**
+         * @brief Bounding sphere center
+         *
+         * Relative to the object this drawable belongs to. Expects that
+         * @ref bounds() is @ref DrawableBounds::Sphere.
+         */
+        VectorTypeFor<dimensions, T> boundingSphereCenter() const;
+
+        /**
+         * @brief Bounding sphere radius
+         *
+         * Expects that @ref bounds() is @ref DrawableBounds::Sphere.
+         */
+        T boundingSphereRadius() const;
+
+        /**
+         * @brief Set bounding sphere
+         * @return Reference to self (for method chaining)
+         *
+         * The @p center is relative to the object this drawable belongs to,
+         * the sphere gets transformed together with the object. Sets
+         * @ref bounds() to @ref DrawableBounds::Sphere. Expects that
+         * @p radius is not negative.
+         * @see @ref Camera::setFrustumCulling()
+         */
+        Drawable<dimensions, T>& setBoundingSphere(const VectorTypeFor<dimensions, T>& center, T radius);
+
+        /**
+         * @brief Bounding box
+         *
+         * Relative to the object this drawable belongs to. Expects that
+         * @ref bounds() is @ref DrawableBounds::Box.
+         */
+        RangeTypeFor<dimensions, T> boundingBox() const;
+
+        /**
+         * @brief Set bounding box
+         * @return Reference to self (for method chaining)
+         *
+         * The @p box is relative to the object this drawable belongs to and
+         * gets transformed together with the object. Sets @ref bounds() to
+         * @ref DrawableBounds::Box.
+         * @see @ref Camera::setFrustumCulling()
+         */
+        Drawable<dimensions, T>& setBoundingBox(const RangeTypeFor<dimensions, T>& box);
+
+        /**
+         * @brief Reset the bounding volume
+         * @return Reference to self (for method chaining)
+         *
+         * Sets @ref bounds() to @ref DrawableBounds::None, the drawable is
+         * then never culled.
+         */
+        Drawable<dimensions, T>& resetBounds();
+
+    private:
+        template<UnsignedInt, class> friend class Camera;
+
+        /* Center of the sphere or the box, half-size of the box (zero for a
+           sphere) and radius of the sphere (zero for a box), so the culling
+           loop can treat both uniformly */
+        VectorTypeFor<dimensions, T> _boundsCenter;
+        VectorTypeFor<dimensions, T> _boundsHalfSize;
+        T _boundsRadius;
+        DrawableBounds _bounds;
 };
 
 /**
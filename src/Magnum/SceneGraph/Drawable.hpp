@@ -30,10 +30,60 @@
  */
 
 #include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/SceneGraph/RenderQueue.h"
 
 namespace Magnum { namespace SceneGraph {
 
-template<UnsignedInt dimensions, class T> Drawable<dimensions, T>::Drawable(AbstractObject<dimensions, T>& object, DrawableGroup<dimensions, T>* drawables): AbstractGroupedFeature<dimensions, Drawable<dimensions, T>, T>(object, drawables) {}
+template<UnsignedInt dimensions, class T> Drawable<dimensions, T>::Drawable(AbstractObject<dimensions, T>& object, DrawableGroup<dimensions, T>* drawables): AbstractGroupedFeature<dimensions, Drawable<dimensions, T>, T>(object, drawables), _boundsRadius{}, _bounds{DrawableBounds::None} {}
+
+template<UnsignedInt dimensions, class T> void Drawable<dimensions, T>::enqueue(RenderQueue<dimensions, T>& queue, const MatrixTypeFor<dimensions, T>& transformationMatrix) {
+    queue.add(RenderQueuePass::Opaque, *this, transformationMatrix);
+}
+
+template<UnsignedInt dimensions, class T> void Drawable<dimensions, T>::drawQueued(const MatrixTypeFor<dimensions, T>& transformationMatrix, Camera<dimensions, T>& camera, UnsignedInt) {
+    draw(transformationMatrix, camera);
+}
+
+template<UnsignedInt dimensions, class T> VectorTypeFor<dimensions, T> Drawable<dimensions, T>::boundingSphereCenter() const {
+    CORRADE_ASSERT(_bounds == DrawableBounds::Sphere,
+        "SceneGraph::Drawable::boundingSphereCenter(): the drawable has no bounding sphere", {});
+    return _boundsCenter;
+}
+
+template<UnsignedInt dimensions, class T> T Drawable<dimensions, T>::boundingSphereRadius() const {
+    CORRADE_ASSERT(_bounds == DrawableBounds::Sphere,
+        "SceneGraph::Drawable::boundingSphereRadius(): the drawable has no bounding sphere", {});
+    return _boundsRadius;
+}
+
+template<UnsignedInt dimensions, class T> Drawable<dimensions, T>& Drawable<dimensions, T>::setBoundingSphere(const VectorTypeFor<dimensions, T>& center, const T radius) {
+    CORRADE_ASSERT(radius >= T(0),
+        "SceneGraph::Drawable::setBoundingSphere(): expected a non-negative radius but got" << radius, *this);
+    _boundsCenter = center;
+    _boundsHalfSize = {};
+    _boundsRadius = radius;
+    _bounds = DrawableBounds::Sphere;
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> RangeTypeFor<dimensions, T> Drawable<dimensions, T>::boundingBox() const {
+    CORRADE_ASSERT(_bounds == DrawableBounds::Box,
+        "SceneGraph::Drawable::boundingBox(): the drawable has no bounding box", {});
+    return RangeTypeFor<dimensions, T>::fromCenter(_boundsCenter, _boundsHalfSize);
+}
+
+template<UnsignedInt dimensions, class T> Drawable<dimensions, T>& Drawable<dimensions, T>::setBoundingBox(const RangeTypeFor<dimensions, T>& box) {
+    _boundsCenter = box.center();
+    _boundsHalfSize = box.size()/T(2);
+    _boundsRadius = T(0);
+    _bounds = DrawableBounds::Box;
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> Drawable<dimensions, T>& Drawable<dimensions, T>::resetBounds() {
+    _bounds = DrawableBounds::None;
+    return *this;
+}
 
 }}
 
@@ -65,7 +65,7 @@ template<UnsignedInt dimensions, class T> class AbstractFeatureGroup {
         virtual ~AbstractFeatureGroup();
 
         void add(AbstractFeature<dimensions, T>& feature);
-        void remove(AbstractFeature<dimensions, T>& feature);
+        void remove(std::size_t index);
 
         std::vector<std::reference_wrapper<AbstractFeature<dimensions, T>>> _features;
 };
@@ -115,18 +115,43 @@ template<UnsignedInt dimensions, class Feature, class T> class FeatureGroup: pub
          * @return Reference to self (for method chaining)
          *
          * If the features is part of another group, it is removed from it.
+         * The feature is added to the end of the group.
          * @see @ref remove(), @ref AbstractGroupedFeature::AbstractGroupedFeature()
          */
         FeatureGroup<dimensions, Feature, T>& add(Feature& feature);
 
+        /**
+         * @brief Add a list of features to the group
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Equivalent to calling @ref add(Feature&) for each item, but
+         * allocates the storage just once.
+         */
+        FeatureGroup<dimensions, Feature, T>& add(const std::vector<std::reference_wrapper<Feature>>& features);
+
         /**
          * @brief Remove a feature from the group
          * @return Reference to self (for method chaining)
          *
-         * The feature must be part of the group.
+         * The feature must be part of the group. The removal is done in
+         * constant time by moving the last feature in the group to the place
+         * of the removed one, which means the order of remaining features
+         * isn't preserved.
          * @see @ref add()
          */
         FeatureGroup<dimensions, Feature, T>& remove(Feature& feature);
+
+        /**
+         * @brief Remove a list of features from the group
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Equivalent to calling @ref remove(Feature&) for each item, thus
+         * the time complexity is linear in the count of removed features,
+         * independent of the group size.
+         */
+        FeatureGroup<dimensions, Feature, T>& remove(const std::vector<std::reference_wrapper<Feature>>& features);
 };
 
 /**
@@ -185,6 +210,13 @@ template<UnsignedInt dimensions, class Feature, class T> FeatureGroup<dimensions
     /* Crossreference the feature and group together */
     AbstractFeatureGroup<dimensions, T>::add(feature);
     feature._group = this;
+    feature._groupIndex = AbstractFeatureGroup<dimensions, T>::_features.size() - 1;
+    return *this;
+}
+
+template<UnsignedInt dimensions, class Feature, class T> FeatureGroup<dimensions, Feature, T>& FeatureGroup<dimensions, Feature, T>::add(const std::vector<std::reference_wrapper<Feature>>& features) {
+    AbstractFeatureGroup<dimensions, T>::_features.reserve(AbstractFeatureGroup<dimensions, T>::_features.size() + features.size());
+    for(Feature& feature: features) add(feature);
     return *this;
 }
 
@@ -192,11 +224,21 @@ template<UnsignedInt dimensions, class Feature, class T> FeatureGroup<dimensions
     CORRADE_ASSERT(feature._group == this,
         "SceneGraph::AbstractFeatureGroup::remove(): feature is not part of this group", *this);
 
-    AbstractFeatureGroup<dimensions, T>::remove(feature);
+    /* Move the last feature to the place of the removed one, if it's not
+       the last already */
+    const std::size_t index = feature._groupIndex;
+    if(index + 1 != AbstractFeatureGroup<dimensions, T>::_features.size())
+        (*this)[AbstractFeatureGroup<dimensions, T>::_features.size() - 1]._groupIndex = index;
+    AbstractFeatureGroup<dimensions, T>::remove(index);
     feature._group = nullptr;
     return *this;
 }
 
+template<UnsignedInt dimensions, class Feature, class T> FeatureGroup<dimensions, Feature, T>& FeatureGroup<dimensions, Feature, T>::remove(const std::vector<std::reference_wrapper<Feature>>& features) {
+    for(Feature& feature: features) remove(feature);
+    return *this;
+}
+
 #if defined(CORRADE_TARGET_WINDOWS) && !(defined(CORRADE_TARGET_MINGW) && !defined(CORRADE_TARGET_CLANG))
 extern template class MAGNUM_SCENEGRAPH_EXPORT AbstractFeatureGroup<2, Float>;
 extern template class MAGNUM_SCENEGRAPH_EXPORT AbstractFeatureGroup<3, Float>;
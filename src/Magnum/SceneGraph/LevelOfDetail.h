@@ -0,0 +1,343 @@
+#ifndef Magnum_SceneGraph_LevelOfDetail_h
+#define Magnum_SceneGraph_LevelOfDetail_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::LevelOfDetail, @ref Magnum::SceneGraph::LevelOfDetailGroup, alias @ref Magnum::SceneGraph::BasicLevelOfDetail2D, @ref Magnum::SceneGraph::BasicLevelOfDetail3D, @ref Magnum::SceneGraph::BasicLevelOfDetailGroup2D, @ref Magnum::SceneGraph::BasicLevelOfDetailGroup3D, typedef @ref Magnum::SceneGraph::LevelOfDetail2D, @ref Magnum::SceneGraph::LevelOfDetail3D, @ref Magnum::SceneGraph::LevelOfDetailGroup2D, @ref Magnum::SceneGraph::LevelOfDetailGroup3D
+ * @m_since_latest
+ */
+
+#include <vector>
+
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/SceneGraph/AbstractGroupedFeature.h"
+#include "Magnum/SceneGraph/FeatureGroup.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Level of detail selection
+@m_since_latest
+
+Picks one of several detail levels of an object based on how large it
+appears on the screen. The feature itself doesn't reference any meshes, it
+only describes the levels and their triangle counts --- a @ref Drawable
+attached to the same object then draws the mesh corresponding to the
+currently selected @ref level(). The levels can come for example from
+@ref MeshTools::generateLods().
+
+@section SceneGraph-LevelOfDetail-usage Usage
+
+The feature is attached to an object together with a @ref LevelOfDetailGroup,
+gets a bounding sphere that encloses the object's mesh and a list of levels,
+ordered from the most detailed to the least detailed. Each level has a minimal
+screen size at which it's used and a triangle count:
+
+@snippet MagnumSceneGraph.cpp LevelOfDetail-usage
+
+The screen size is the fraction of the viewport height covered by the
+projected bounding sphere diameter, so a value of @cpp 0.5f @ce means the
+object covers roughly half of the viewport height. The selection is done for
+all features in the group at once in @ref LevelOfDetailGroup::select(), which
+calculates transformations of all objects relative to the camera in a single
+batch, same as @ref Camera::draw() does. The first level with minimal screen
+size not larger than the current screen size is picked. If the object is
+smaller than the minimal screen size of the last level, the
+@ref level() is equal to @ref levelCount() and the object is expected to not
+be drawn at all. Set the minimal screen size of the last level to
+@cpp 0.0f @ce to always draw it.
+
+@snippet MagnumSceneGraph.cpp LevelOfDetail-draw
+
+@section SceneGraph-LevelOfDetail-hysteresis Hysteresis and triangle budget
+
+To avoid objects rapidly switching between two levels when their screen size
+is close to a threshold, use @ref LevelOfDetailGroup::setHysteresis(). The
+screen size then has to get past the threshold by given fraction in order
+for the level to change.
+
+With @ref LevelOfDetailGroup::setTriangleBudget(), the selection additionally
+ensures that the total triangle count of all selected levels doesn't exceed
+given value, if possible. If it does, objects with the smallest screen size
+are switched to coarser levels first, one level at a time, until the total
+fits into the budget or all objects are at their least detailed level.
+Objects that are too small to be drawn at all are never made visible by the
+budget and objects are never hidden because of it.
+
+@see @ref LevelOfDetail2D, @ref LevelOfDetail3D, @ref BasicLevelOfDetail2D,
+    @ref BasicLevelOfDetail3D
+*/
+template<UnsignedInt dimensions, class T> class LevelOfDetail: public AbstractGroupedFeature<dimensions, LevelOfDetail<dimensions, T>, T> {
+    friend LevelOfDetailGroup<dimensions, T>;
+
+    public:
+        /**
+         * @brief Constructor
+         * @param object    Object this level of detail selection belongs to
+         * @param group     Group this level of detail selection belongs to
+         *
+         * Adds the feature to the object and also to the group, if
+         * specified. The bounding sphere is initially a unit sphere around
+         * the object origin and there are no levels.
+         */
+        explicit LevelOfDetail(AbstractObject<dimensions, T>& object, LevelOfDetailGroup<dimensions, T>* group = nullptr);
+
+        /**
+         * @brief Group containing this level of detail selection
+         *
+         * If the feature doesn't belong to any group, returns
+         * @cpp nullptr @ce.
+         */
+        LevelOfDetailGroup<dimensions, T>* levelOfDetailGroup() {
+            return static_cast<LevelOfDetailGroup<dimensions, T>*>(AbstractGroupedFeature<dimensions, LevelOfDetail<dimensions, T>, T>::group());
+        }
+
+        /** @overload */
+        const LevelOfDetailGroup<dimensions, T>* levelOfDetailGroup() const {
+            return static_cast<const LevelOfDetailGroup<dimensions, T>*>(AbstractGroupedFeature<dimensions, LevelOfDetail<dimensions, T>, T>::group());
+        }
+
+        /** @brief Bounding sphere center in object-local coordinates */
+        VectorTypeFor<dimensions, T> boundingSphereCenter() const { return _center; }
+
+        /** @brief Bounding sphere radius in object-local coordinates */
+        T boundingSphereRadius() const { return _radius; }
+
+        /**
+         * @brief Set bounding sphere
+         * @return Reference to self (for method chaining)
+         *
+         * The sphere is in object-local coordinates and is expected to
+         * enclose the most detailed level. Default is a sphere with a radius
+         * of @cpp 1.0 @ce at the object origin.
+         */
+        LevelOfDetail<dimensions, T>& setBoundingSphere(const VectorTypeFor<dimensions, T>& center, T radius);
+
+        /** @brief Level count */
+        std::size_t levelCount() const { return _levels.size(); }
+
+        /**
+         * @brief Add a level
+         * @param minScreenSize     Minimal screen size at which the level is
+         *      used
+         * @param triangleCount     Triangle count of the level
+         * @return Reference to self (for method chaining)
+         *
+         * The levels are expected to be added from the most detailed to the
+         * least detailed, i.e. with @p minScreenSize not larger than for the
+         * previous level. See @ref SceneGraph-LevelOfDetail-usage for more
+         * information.
+         */
+        LevelOfDetail<dimensions, T>& addLevel(T minScreenSize, UnsignedInt triangleCount);
+
+        /**
+         * @brief Minimal screen size of given level
+         *
+         * Expects that @p id is less than @ref levelCount().
+         */
+        T levelMinScreenSize(UnsignedInt id) const;
+
+        /**
+         * @brief Triangle count of given level
+         *
+         * Expects that @p id is less than @ref levelCount().
+         */
+        UnsignedInt levelTriangleCount(UnsignedInt id) const;
+
+        /**
+         * @brief Selected level
+         *
+         * Updated by @ref LevelOfDetailGroup::select(). If equal to
+         * @ref levelCount(), the object is too small to be drawn. Initially
+         * @cpp 0 @ce.
+         */
+        UnsignedInt level() const { return _level; }
+
+        /**
+         * @brief Screen size from the last selection
+         *
+         * Fraction of the viewport height covered by the projected bounding
+         * sphere diameter, calculated by @ref LevelOfDetailGroup::select().
+         * If the bounding sphere center is at or behind the camera plane, the
+         * screen size is infinity. Initially @cpp 0.0 @ce.
+         */
+        T screenSize() const { return _screenSize; }
+
+    private:
+        /* Level picked for given screen size without any hysteresis */
+        UnsignedInt MAGNUM_SCENEGRAPH_LOCAL levelForScreenSize(T screenSize) const;
+
+        VectorTypeFor<dimensions, T> _center;
+        T _radius;
+        T _screenSize;
+        UnsignedInt _level;
+        std::vector<std::pair<T, UnsignedInt>> _levels;
+};
+
+/**
+@brief Group of level of detail selections
+@m_since_latest
+
+See @ref LevelOfDetail for more information.
+@see @ref LevelOfDetailGroup2D, @ref LevelOfDetailGroup3D,
+    @ref BasicLevelOfDetailGroup2D, @ref BasicLevelOfDetailGroup3D
+*/
+template<UnsignedInt dimensions, class T> class LevelOfDetailGroup: public FeatureGroup<dimensions, LevelOfDetail<dimensions, T>, T> {
+    public:
+        /** @brief Constructor */
+        explicit LevelOfDetailGroup();
+
+        /** @brief Hysteresis */
+        T hysteresis() const { return _hysteresis; }
+
+        /**
+         * @brief Set hysteresis
+         * @return Reference to self (for method chaining)
+         *
+         * Fraction by which the screen size has to get past a level
+         * threshold in order for the level to change. Expected to be in the
+         * @f$ [0, 1) @f$ range. Default is @cpp 0.0 @ce, i.e. no hysteresis.
+         * See @ref SceneGraph-LevelOfDetail-hysteresis for more information.
+         */
+        LevelOfDetailGroup<dimensions, T>& setHysteresis(T hysteresis);
+
+        /** @brief Triangle budget */
+        UnsignedLong triangleBudget() const { return _triangleBudget; }
+
+        /**
+         * @brief Set triangle budget
+         * @return Reference to self (for method chaining)
+         *
+         * Max total triangle count of all selected levels. Default is
+         * @cpp 0 @ce, i.e. unlimited. See
+         * @ref SceneGraph-LevelOfDetail-hysteresis for more information.
+         */
+        LevelOfDetailGroup<dimensions, T>& setTriangleBudget(UnsignedLong budget);
+
+        /**
+         * @brief Select levels for all features in the group
+         * @return Total triangle count of all selected levels
+         *
+         * Calculates transformations of all objects relative to @p camera,
+         * projects their bounding spheres using
+         * @ref Camera::projectionMatrix() and updates
+         * @ref LevelOfDetail::screenSize() and @ref LevelOfDetail::level() of
+         * all features in the group. Expects that the camera is a part of a
+         * scene.
+         */
+        UnsignedLong select(Camera<dimensions, T>& camera);
+
+    private:
+        T _hysteresis;
+        UnsignedLong _triangleBudget;
+        /* Scratch memory for the triangle budget, kept to avoid
+           reallocations */
+        std::vector<UnsignedInt> _order;
+};
+
+/**
+@brief Level of detail selection for two-dimensional scenes
+@m_since_latest
+
+Convenience alternative to @cpp LevelOfDetail<2, T> @ce. See
+@ref LevelOfDetail for more information.
+@see @ref LevelOfDetail2D, @ref BasicLevelOfDetail3D
+*/
+template<class T> using BasicLevelOfDetail2D = LevelOfDetail<2, T>;
+
+/**
+@brief Level of detail selection for two-dimensional float scenes
+@m_since_latest
+
+@see @ref LevelOfDetail3D
+*/
+typedef BasicLevelOfDetail2D<Float> LevelOfDetail2D;
+
+/**
+@brief Level of detail selection for three-dimensional scenes
+@m_since_latest
+
+Convenience alternative to @cpp LevelOfDetail<3, T> @ce. See
+@ref LevelOfDetail for more information.
+@see @ref LevelOfDetail3D, @ref BasicLevelOfDetail2D
+*/
+template<class T> using BasicLevelOfDetail3D = LevelOfDetail<3, T>;
+
+/**
+@brief Level of detail selection for three-dimensional float scenes
+@m_since_latest
+
+@see @ref LevelOfDetail2D
+*/
+typedef BasicLevelOfDetail3D<Float> LevelOfDetail3D;
+
+/**
+@brief Group of level of detail selections for two-dimensional scenes
+@m_since_latest
+
+Convenience alternative to @cpp LevelOfDetailGroup<2, T> @ce. See
+@ref LevelOfDetail for more information.
+@see @ref LevelOfDetailGroup2D, @ref BasicLevelOfDetailGroup3D
+*/
+template<class T> using BasicLevelOfDetailGroup2D = LevelOfDetailGroup<2, T>;
+
+/**
+@brief Group of level of detail selections for two-dimensional float scenes
+@m_since_latest
+
+@see @ref LevelOfDetailGroup3D
+*/
+typedef BasicLevelOfDetailGroup2D<Float> LevelOfDetailGroup2D;
+
+/**
+@brief Group of level of detail selections for three-dimensional scenes
+@m_since_latest
+
+Convenience alternative to @cpp LevelOfDetailGroup<3, T> @ce. See
+@ref LevelOfDetail for more information.
+@see @ref LevelOfDetailGroup3D, @ref BasicLevelOfDetailGroup2D
+*/
+template<class T> using BasicLevelOfDetailGroup3D = LevelOfDetailGroup<3, T>;
+
+/**
+@brief Group of level of detail selections for three-dimensional float scenes
+@m_since_latest
+
+@see @ref LevelOfDetailGroup2D
+*/
+typedef BasicLevelOfDetailGroup3D<Float> LevelOfDetailGroup3D;
+
+#if defined(CORRADE_TARGET_WINDOWS) && !(defined(CORRADE_TARGET_MINGW) && !defined(CORRADE_TARGET_CLANG))
+extern template class MAGNUM_SCENEGRAPH_EXPORT LevelOfDetail<2, Float>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT LevelOfDetail<3, Float>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT LevelOfDetailGroup<2, Float>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT LevelOfDetailGroup<3, Float>;
+#endif
+
+}}
+
+#endif
@@ -0,0 +1,166 @@
+#ifndef Magnum_SceneGraph_LevelOfDetail_hpp
+#define Magnum_SceneGraph_LevelOfDetail_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref LevelOfDetail.h
+ * @m_since_latest
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/SceneGraph/AbstractObject.h"
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/LevelOfDetail.h"
+
+namespace Magnum { namespace SceneGraph {
+
+template<UnsignedInt dimensions, class T> LevelOfDetail<dimensions, T>::LevelOfDetail(AbstractObject<dimensions, T>& object, LevelOfDetailGroup<dimensions, T>* group): AbstractGroupedFeature<dimensions, LevelOfDetail<dimensions, T>, T>{object, group}, _radius{T(1)}, _screenSize{}, _level{} {}
+
+template<UnsignedInt dimensions, class T> LevelOfDetail<dimensions, T>& LevelOfDetail<dimensions, T>::setBoundingSphere(const VectorTypeFor<dimensions, T>& center, const T radius) {
+    _center = center;
+    _radius = radius;
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> LevelOfDetail<dimensions, T>& LevelOfDetail<dimensions, T>::addLevel(const T minScreenSize, const UnsignedInt triangleCount) {
+    CORRADE_ASSERT(_levels.empty() || minScreenSize <= _levels.back().first,
+        "SceneGraph::LevelOfDetail::addLevel(): expected minimal screen size not larger than" << _levels.back().first << "but got" << minScreenSize, *this);
+    _levels.emplace_back(minScreenSize, triangleCount);
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> T LevelOfDetail<dimensions, T>::levelMinScreenSize(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _levels.size(),
+        "SceneGraph::LevelOfDetail::levelMinScreenSize(): index" << id << "out of range for" << _levels.size() << "levels", {});
+    return _levels[id].first;
+}
+
+template<UnsignedInt dimensions, class T> UnsignedInt LevelOfDetail<dimensions, T>::levelTriangleCount(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _levels.size(),
+        "SceneGraph::LevelOfDetail::levelTriangleCount(): index" << id << "out of range for" << _levels.size() << "levels", {});
+    return _levels[id].second;
+}
+
+template<UnsignedInt dimensions, class T> UnsignedInt LevelOfDetail<dimensions, T>::levelForScreenSize(const T screenSize) const {
+    UnsignedInt level = 0;
+    while(level != _levels.size() && screenSize < _levels[level].first)
+        ++level;
+    return level;
+}
+
+template<UnsignedInt dimensions, class T> LevelOfDetailGroup<dimensions, T>::LevelOfDetailGroup(): _hysteresis{}, _triangleBudget{} {}
+
+template<UnsignedInt dimensions, class T> LevelOfDetailGroup<dimensions, T>& LevelOfDetailGroup<dimensions, T>::setHysteresis(const T hysteresis) {
+    CORRADE_ASSERT(hysteresis >= T(0) && hysteresis < T(1),
+        "SceneGraph::LevelOfDetailGroup::setHysteresis(): expected a value in range [0, 1) but got" << hysteresis, *this);
+    _hysteresis = hysteresis;
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> LevelOfDetailGroup<dimensions, T>& LevelOfDetailGroup<dimensions, T>::setTriangleBudget(const UnsignedLong budget) {
+    _triangleBudget = budget;
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> UnsignedLong LevelOfDetailGroup<dimensions, T>::select(Camera<dimensions, T>& camera) {
+    AbstractObject<dimensions, T>* scene = camera.object().scene();
+    CORRADE_ASSERT(scene, "SceneGraph::LevelOfDetailGroup::select(): camera is not part of any scene", {});
+
+    /* Compute camera matrix */
+    camera.object().setClean();
+
+    /* Compute transformations of all objects in the group relative to the
+       camera in a single batch */
+    const std::size_t count = this->size();
+    std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>> objects;
+    objects.reserve(count);
+    for(std::size_t i = 0; i != count; ++i)
+        objects.push_back((*this)[i].object());
+    const std::vector<MatrixTypeFor<dimensions, T>> transformations =
+        scene->transformationMatrices(objects, camera.cameraMatrix());
+
+    /* Projected diameter in NDC is 2*radius*P[1][1]/w, and as NDC is two
+       units high, the fraction of viewport height is radius*P[1][1]/w */
+    const MatrixTypeFor<dimensions, T>& projectionMatrix = camera.projectionMatrix();
+    UnsignedLong triangleCount = 0;
+    for(std::size_t i = 0; i != count; ++i) {
+        LevelOfDetail<dimensions, T>& lod = (*this)[i];
+        const MatrixTypeFor<dimensions, T>& transformation = transformations[i];
+
+        const VectorTypeFor<dimensions, T> center = transformation.transformPoint(lod._center);
+        const T radius = lod._radius*std::sqrt(transformation.scalingSquared().max());
+        const T w = (projectionMatrix*Math::Vector<dimensions + 1, T>::pad(center, T(1)))[dimensions];
+        lod._screenSize = w > T(0) ? radius*projectionMatrix[1][1]/w : Math::Constants<T>::inf();
+
+        /* Switch to a coarser level only if the screen size is below the
+           threshold even when enlarged by the hysteresis, and to a finer
+           level only if it's above even when shrunk by it */
+        const UnsignedInt coarser = lod.levelForScreenSize(lod._screenSize*(T(1) + _hysteresis));
+        const UnsignedInt finer = lod.levelForScreenSize(lod._screenSize*(T(1) - _hysteresis));
+        if(coarser > lod._level) lod._level = coarser;
+        else if(finer < lod._level) lod._level = finer;
+        /* The level count could have changed since the last selection */
+        else if(lod._level > lod._levels.size()) lod._level = lod._levels.size();
+
+        if(lod._level < lod._levels.size())
+            triangleCount += lod._levels[lod._level].second;
+    }
+
+    /* If over the budget, coarsen the smallest objects first, one level at a
+       time */
+    if(!_triangleBudget || triangleCount <= _triangleBudget)
+        return triangleCount;
+
+    _order.resize(count);
+    for(std::size_t i = 0; i != count; ++i) _order[i] = i;
+    std::stable_sort(_order.begin(), _order.end(), [this](UnsignedInt a, UnsignedInt b) {
+        return (*this)[a]._screenSize < (*this)[b]._screenSize;
+    });
+
+    for(bool changed = true; changed && triangleCount > _triangleBudget; ) {
+        changed = false;
+        for(const UnsignedInt i: _order) {
+            LevelOfDetail<dimensions, T>& lod = (*this)[i];
+            if(lod._level + 1 >= lod._levels.size()) continue;
+
+            triangleCount -= lod._levels[lod._level].second;
+            ++lod._level;
+            triangleCount += lod._levels[lod._level].second;
+            changed = true;
+            if(triangleCount <= _triangleBudget) break;
+        }
+    }
+
+    return triangleCount;
+}
+
+}}
+
+#endif
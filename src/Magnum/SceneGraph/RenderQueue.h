@@ -0,0 +1,251 @@
+#ifndef Magnum_SceneGraph_RenderQueue_h
+#define Magnum_SceneGraph_RenderQueue_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::RenderQueue, enum @ref Magnum::SceneGraph::RenderQueuePass, alias @ref Magnum::SceneGraph::BasicRenderQueue2D, @ref Magnum::SceneGraph::BasicRenderQueue3D, typedef @ref Magnum::SceneGraph::RenderQueue2D, @ref Magnum::SceneGraph::RenderQueue3D
+ * @m_since_latest
+ */
+
+#include <vector>
+
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/SceneGraph/SceneGraph.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Render queue pass
+@m_since_latest
+
+@see @ref RenderQueue::add()
+*/
+enum class RenderQueuePass: UnsignedByte {
+    /** Opaque pass, sorted front-to-back and drawn first */
+    Opaque,
+
+    /** Transparent pass, sorted back-to-front and drawn after the opaque pass */
+    Transparent
+};
+
+/**
+@brief Render queue
+@m_since_latest
+
+Alternative to @ref Camera::draw() that draws the contents of a
+@ref DrawableGroup sorted by a key instead of in the order the drawables were
+added to the group. Opaque drawables are drawn front-to-back to make the most
+of early depth test, transparent drawables are drawn afterwards back-to-front
+for correct blending.
+
+@snippet MagnumSceneGraph.cpp RenderQueue-usage
+
+@section SceneGraph-RenderQueue-entries Queue entries
+
+The queue is filled by @ref build(), which calculates camera-relative
+transformations of all drawables in the group and calls
+@ref Drawable::enqueue() on each. By default it adds a single
+@ref RenderQueuePass::Opaque entry with order @cpp 0 @ce and payload
+@cpp 0 @ce, a drawable can however override it to add any number of entries
+to either pass. When the queue is drawn, @ref Drawable::drawQueued() gets
+called with the entry transformation and payload, which by default delegates
+to @ref Drawable::draw(). The payload can be used for example to distinguish
+between an opaque and a transparent part of a single drawable:
+
+@snippet MagnumSceneGraph.cpp RenderQueue-enqueue
+
+@section SceneGraph-RenderQueue-sorting Sort order
+
+Each entry has a 64-bit sort key, with the upper 32 bits being the @p order
+passed to @ref add() and the lower 32 bits derived from the camera-space
+depth of the entry, which is the distance along the negative Z axis for 3D
+and always zero for 2D. The order has a priority over the depth, so it can be
+used for example for layering or for grouping entries with the same shader
+or material together. The entries are sorted with a stable radix sort in
+@ref sort(), which is called implicitly from @ref build(), so entries with
+equal keys are drawn in the order they were added.
+
+Unlike @ref Camera::draw(), the queue doesn't perform any frustum culling.
+
+@section SceneGraph-RenderQueue-explicit-specializations Explicit template specializations
+
+The following specializations are explicitly compiled into @ref SceneGraph
+library. For other specializations (e.g. using @ref Magnum::Double "Double"
+type) you have to use @ref RenderQueue.hpp implementation file to avoid
+linker errors. See also @ref compilation-speedup-hpp for more information.
+
+-   @ref RenderQueue2D
+-   @ref RenderQueue3D
+
+@see @ref scenegraph, @ref BasicRenderQueue2D, @ref BasicRenderQueue3D,
+    @ref RenderQueue2D, @ref RenderQueue3D
+*/
+template<UnsignedInt dimensions, class T> class RenderQueue {
+    public:
+        /**
+         * @brief Queue entry
+         *
+         * @see @ref opaque(), @ref transparent()
+         */
+        struct Entry {
+            /** @brief Drawable */
+            Drawable<dimensions, T>* drawable;
+
+            /** @brief Transformation relative to camera */
+            MatrixTypeFor<dimensions, T> transformationMatrix;
+
+            /** @brief Sort key */
+            UnsignedLong key;
+
+            /** @brief Payload passed to @ref Drawable::drawQueued() */
+            UnsignedInt payload;
+        };
+
+        /** @brief Constructor */
+        explicit RenderQueue();
+
+        /**
+         * @brief Opaque entries
+         *
+         * In the order they will be drawn if @ref sort() was called after
+         * the last @ref add().
+         */
+        const std::vector<Entry>& opaque() const { return _opaque; }
+
+        /**
+         * @brief Transparent entries
+         *
+         * In the order they will be drawn if @ref sort() was called after
+         * the last @ref add().
+         */
+        const std::vector<Entry>& transparent() const { return _transparent; }
+
+        /**
+         * @brief Clear the queue
+         * @return Reference to self (for method chaining)
+         *
+         * Memory allocated by the queue is kept for reuse.
+         */
+        RenderQueue<dimensions, T>& clear();
+
+        /**
+         * @brief Add an entry to the queue
+         * @param pass                  Pass to add the entry to
+         * @param drawable              Drawable
+         * @param transformationMatrix  Transformation relative to camera
+         * @param order                 Order, has a priority over depth
+         * @param payload               Payload passed to
+         *      @ref Drawable::drawQueued()
+         * @return Reference to self (for method chaining)
+         *
+         * Expected to be called from @ref Drawable::enqueue(). See
+         * @ref SceneGraph-RenderQueue-sorting for more information.
+         */
+        RenderQueue<dimensions, T>& add(RenderQueuePass pass, Drawable<dimensions, T>& drawable, const MatrixTypeFor<dimensions, T>& transformationMatrix, UnsignedInt order = 0, UnsignedInt payload = 0);
+
+        /**
+         * @brief Build the queue from a drawable group
+         * @return Reference to self (for method chaining)
+         *
+         * Clears the queue, calls @ref Drawable::enqueue() for all drawables
+         * in @p group with their transformations calculated using
+         * @ref Camera::drawableTransformations() and then calls @ref sort().
+         */
+        RenderQueue<dimensions, T>& build(Camera<dimensions, T>& camera, DrawableGroup<dimensions, T>& group);
+
+        /**
+         * @brief Sort the queue
+         * @return Reference to self (for method chaining)
+         *
+         * Sorts both passes by the entry key. Called implicitly from
+         * @ref build(), you need to call it only after adding entries
+         * directly through @ref add().
+         */
+        RenderQueue<dimensions, T>& sort();
+
+        /**
+         * @brief Draw the queue
+         *
+         * Calls @ref Drawable::drawQueued() for all opaque entries and then
+         * for all transparent entries, in the order they are in the queue.
+         */
+        void draw(Camera<dimensions, T>& camera);
+
+    private:
+        void MAGNUM_SCENEGRAPH_LOCAL sort(std::vector<Entry>& entries);
+
+        std::vector<Entry> _opaque, _transparent;
+        /* Scratch memory for sorting, kept to avoid reallocations */
+        std::vector<Entry> _sorted;
+        std::vector<UnsignedLong> _keys;
+        std::vector<UnsignedInt> _indices;
+};
+
+/**
+@brief Render queue for two-dimensional scenes
+@m_since_latest
+
+Convenience alternative to @cpp RenderQueue<2, T> @ce. See @ref RenderQueue
+for more information.
+@see @ref RenderQueue2D, @ref BasicRenderQueue3D
+*/
+template<class T> using BasicRenderQueue2D = RenderQueue<2, T>;
+
+/**
+@brief Render queue for two-dimensional float scenes
+@m_since_latest
+
+@see @ref RenderQueue3D
+*/
+typedef BasicRenderQueue2D<Float> RenderQueue2D;
+
+/**
+@brief Render queue for three-dimensional scenes
+@m_since_latest
+
+Convenience alternative to @cpp RenderQueue<3, T> @ce. See @ref RenderQueue
+for more information.
+@see @ref RenderQueue3D, @ref BasicRenderQueue2D
+*/
+template<class T> using BasicRenderQueue3D = RenderQueue<3, T>;
+
+/**
+@brief Render queue for three-dimensional float scenes
+@m_since_latest
+
+@see @ref RenderQueue2D
+*/
+typedef BasicRenderQueue3D<Float> RenderQueue3D;
+
+#if defined(CORRADE_TARGET_WINDOWS) && !(defined(CORRADE_TARGET_MINGW) && !defined(CORRADE_TARGET_CLANG))
+extern template class MAGNUM_SCENEGRAPH_EXPORT RenderQueue<2, Float>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT RenderQueue<3, Float>;
+#endif
+
+}}
+
+#endif
@@ -0,0 +1,150 @@
+#ifndef Magnum_SceneGraph_RenderQueue_hpp
+#define Magnum_SceneGraph_RenderQueue_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref RenderQueue.h
+ * @m_since_latest
+ */
+
+#include <cstring>
+
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/SceneGraph/RenderQueue.h"
+
+namespace Magnum { namespace SceneGraph {
+
+namespace Implementation {
+
+/* Maps a float to an unsigned integer with the same ordering -- positive
+   values get the sign bit set, negative values get all bits flipped */
+inline UnsignedInt renderQueueDepthKey(const Float depth) {
+    UnsignedInt bits;
+    std::memcpy(&bits, &depth, sizeof(Float));
+    return bits & 0x80000000u ? ~bits : bits|0x80000000u;
+}
+
+}
+
+template<UnsignedInt dimensions, class T> RenderQueue<dimensions, T>::RenderQueue() = default;
+
+template<UnsignedInt dimensions, class T> RenderQueue<dimensions, T>& RenderQueue<dimensions, T>::clear() {
+    _opaque.clear();
+    _transparent.clear();
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> RenderQueue<dimensions, T>& RenderQueue<dimensions, T>::add(const RenderQueuePass pass, Drawable<dimensions, T>& drawable, const MatrixTypeFor<dimensions, T>& transformationMatrix, const UnsignedInt order, const UnsignedInt payload) {
+    /* Camera looks along the negative Z axis in 3D, there's no depth in 2D */
+    const Float depth = dimensions == 3 ? Float(-transformationMatrix.translation()[dimensions - 1]) : 0.0f;
+
+    /* Opaque entries are sorted front-to-back, transparent back-to-front */
+    UnsignedInt depthKey = Implementation::renderQueueDepthKey(depth);
+    if(pass == RenderQueuePass::Transparent) depthKey = ~depthKey;
+
+    (pass == RenderQueuePass::Opaque ? _opaque : _transparent).push_back(Entry{&drawable, transformationMatrix, UnsignedLong(order) << 32 | depthKey, payload});
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> RenderQueue<dimensions, T>& RenderQueue<dimensions, T>::build(Camera<dimensions, T>& camera, DrawableGroup<dimensions, T>& group) {
+    clear();
+    for(const std::pair<std::reference_wrapper<Drawable<dimensions, T>>, MatrixTypeFor<dimensions, T>>& drawableTransformation: camera.drawableTransformations(group))
+        drawableTransformation.first.get().enqueue(*this, drawableTransformation.second);
+    return sort();
+}
+
+template<UnsignedInt dimensions, class T> RenderQueue<dimensions, T>& RenderQueue<dimensions, T>::sort() {
+    sort(_opaque);
+    sort(_transparent);
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> void RenderQueue<dimensions, T>::sort(std::vector<Entry>& entries) {
+    const std::size_t count = entries.size();
+    if(count < 2) return;
+
+    /* Two halves of the scratch memory are ping-ponged between the passes */
+    _keys.resize(2*count);
+    _indices.resize(2*count);
+    UnsignedLong* keys = _keys.data();
+    UnsignedLong* keysOut = keys + count;
+    UnsignedInt* indices = _indices.data();
+    UnsignedInt* indicesOut = indices + count;
+
+    /* Calculate histograms of all eight key bytes in a single pass */
+    std::size_t histograms[8][256]{};
+    for(std::size_t i = 0; i != count; ++i) {
+        keys[i] = entries[i].key;
+        indices[i] = i;
+        for(std::size_t byte = 0; byte != 8; ++byte)
+            ++histograms[byte][(keys[i] >> 8*byte) & 0xff];
+    }
+
+    /* Stable LSD radix sort, one byte at a time */
+    for(std::size_t byte = 0; byte != 8; ++byte) {
+        std::size_t* histogram = histograms[byte];
+
+        /* If all keys have the same value of this byte, the pass wouldn't
+           change anything. That's often the case for the upper bytes. */
+        if(histogram[(keys[0] >> 8*byte) & 0xff] == count) continue;
+
+        /* Turn the histogram into output offsets */
+        std::size_t offset = 0;
+        for(std::size_t i = 0; i != 256; ++i) {
+            const std::size_t size = histogram[i];
+            histogram[i] = offset;
+            offset += size;
+        }
+
+        for(std::size_t i = 0; i != count; ++i) {
+            const std::size_t out = histogram[(keys[i] >> 8*byte) & 0xff]++;
+            keysOut[out] = keys[i];
+            indicesOut[out] = indices[i];
+        }
+
+        std::swap(keys, keysOut);
+        std::swap(indices, indicesOut);
+    }
+
+    /* Reorder the entries */
+    _sorted.clear();
+    _sorted.reserve(count);
+    for(std::size_t i = 0; i != count; ++i)
+        _sorted.push_back(entries[indices[i]]);
+    std::swap(entries, _sorted);
+}
+
+template<UnsignedInt dimensions, class T> void RenderQueue<dimensions, T>::draw(Camera<dimensions, T>& camera) {
+    for(const Entry& entry: _opaque)
+        entry.drawable->drawQueued(entry.transformationMatrix, camera, entry.payload);
+    for(const Entry& entry: _transparent)
+        entry.drawable->drawQueued(entry.transformationMatrix, camera, entry.payload);
+}
+
+}}
+
+#endif
@@ -35,6 +35,7 @@ namespace Magnum { namespace SceneGraph {
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
 enum class AspectRatioPolicy: UnsignedByte;
+enum class DrawableBounds: UnsignedByte;
 
 /* Enum CachedTransformation and CachedTransformations used only directly */
 
@@ -123,6 +124,18 @@ template<class T> using BasicDrawableGroup3D = DrawableGroup<3, T>;
 typedef BasicDrawableGroup2D<Float> DrawableGroup2D;
 typedef BasicDrawableGroup3D<Float> DrawableGroup3D;
 
+template<UnsignedInt, class> class LevelOfDetail;
+template<class T> using BasicLevelOfDetail2D = LevelOfDetail<2, T>;
+template<class T> using BasicLevelOfDetail3D = LevelOfDetail<3, T>;
+typedef BasicLevelOfDetail2D<Float> LevelOfDetail2D;
+typedef BasicLevelOfDetail3D<Float> LevelOfDetail3D;
+
+template<UnsignedInt, class> class LevelOfDetailGroup;
+template<class T> using BasicLevelOfDetailGroup2D = LevelOfDetailGroup<2, T>;
+template<class T> using BasicLevelOfDetailGroup3D = LevelOfDetailGroup<3, T>;
+typedef BasicLevelOfDetailGroup2D<Float> LevelOfDetailGroup2D;
+typedef BasicLevelOfDetailGroup3D<Float> LevelOfDetailGroup3D;
+
 template<class> class BasicMatrixTransformation2D;
 template<class> class BasicMatrixTransformation3D;
 typedef BasicMatrixTransformation2D<Float> MatrixTransformation2D;
@@ -130,6 +143,14 @@ typedef BasicMatrixTransformation3D<Float> MatrixTransformation3D;
 
 template<class Transformation> class Object;
 
+enum class RenderQueuePass: UnsignedByte;
+
+template<UnsignedInt, class> class RenderQueue;
+template<class T> using BasicRenderQueue2D = RenderQueue<2, T>;
+template<class T> using BasicRenderQueue3D = RenderQueue<3, T>;
+typedef BasicRenderQueue2D<Float> RenderQueue2D;
+typedef BasicRenderQueue3D<Float> RenderQueue3D;
+
 template<class> class BasicRigidMatrixTransformation2D;
 template<class> class BasicRigidMatrixTransformation3D;
 typedef BasicRigidMatrixTransformation2D<Float> RigidMatrixTransformation2D;
@@ -137,6 +158,13 @@ typedef BasicRigidMatrixTransformation3D<Float> RigidMatrixTransformation3D;
 
 template<class Transformation> class Scene;
 
+template<class> class BasicSpatialBounds3D;
+typedef BasicSpatialBounds3D<Float> SpatialBounds3D;
+template<class> class BasicSpatialIndex3D;
+typedef BasicSpatialIndex3D<Float> SpatialIndex3D;
+
+template<class Transformation> class TransformationCache;
+
 template<UnsignedInt, class T, class = T> class TranslationTransformation;
 template<class T, class TranslationType = T> using BasicTranslationTransformation2D = TranslationTransformation<2, T, TranslationType>;
 template<class T, class TranslationType = T> using BasicTranslationTransformation3D = TranslationTransformation<3, T, TranslationType>;
@@ -0,0 +1,132 @@
+#ifndef Magnum_SceneGraph_SpatialBounds_h
+#define Magnum_SceneGraph_SpatialBounds_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::BasicSpatialBounds3D, typedef @ref Magnum::SceneGraph::SpatialBounds3D
+ * @m_since_latest
+ */
+
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/SceneGraph/AbstractGroupedFeature.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Bounds of an object in a spatial index
+@m_since_latest
+
+Attaches an axis-aligned bounding box to an object and makes it part of a
+@ref BasicSpatialIndex3D "SpatialIndex3D". The box is specified relative to
+the object and the feature keeps its absolute transformation cached, so
+the index gets refitted only for objects whose transformation changed. See
+@ref BasicSpatialIndex3D "SpatialIndex3D" for more information.
+
+@section SceneGraph-SpatialBounds3D-explicit-specializations Explicit template specializations
+
+The following specialization is explicitly compiled into @ref SceneGraph
+library. For other specializations (e.g. using @ref Magnum::Double "Double"
+type) you have to use @ref SpatialIndex.hpp implementation file to avoid
+linker errors. See also @ref compilation-speedup-hpp for more information.
+
+-   @ref SpatialBounds3D
+
+@see @ref scenegraph, @ref SpatialBounds3D
+*/
+template<class T> class BasicSpatialBounds3D: public AbstractGroupedFeature<3, BasicSpatialBounds3D<T>, T> {
+    public:
+        /**
+         * @brief Constructor
+         * @param object    Object this feature belongs to
+         * @param bounds    Bounding box relative to the object
+         * @param index     Spatial index this feature belongs to
+         *
+         * Adds the feature to the object and also to the index, if
+         * specified. Otherwise you can use
+         * @ref BasicSpatialIndex3D::add() "SpatialIndex3D::add()".
+         */
+        explicit BasicSpatialBounds3D(AbstractObject<3, T>& object, const Math::Range3D<T>& bounds, BasicSpatialIndex3D<T>* index = nullptr);
+
+        /**
+         * @brief Destructor
+         *
+         * Removes the feature from the object and from the index, if it
+         * belongs to any.
+         */
+        ~BasicSpatialBounds3D();
+
+        /**
+         * @brief Spatial index containing this feature
+         *
+         * If the feature doesn't belong to any index, returns
+         * @cpp nullptr @ce.
+         */
+        BasicSpatialIndex3D<T>* index();
+        const BasicSpatialIndex3D<T>* index() const; /**< @overload */
+
+        /** @brief Bounding box relative to the object */
+        Math::Range3D<T> bounds() const { return _bounds; }
+
+        /**
+         * @brief Set bounding box relative to the object
+         * @return Reference to self (for method chaining)
+         */
+        BasicSpatialBounds3D<T>& setBounds(const Math::Range3D<T>& bounds);
+
+        /**
+         * @brief Absolute bounding box
+         *
+         * Bounding box transformed with the absolute object transformation
+         * and enlarged to stay axis-aligned. Up-to-date after
+         * @ref BasicSpatialIndex3D::update() "SpatialIndex3D::update()".
+         */
+        Math::Range3D<T> absoluteBounds() const { return _absoluteBounds; }
+
+    private:
+        template<class> friend class BasicSpatialIndex3D;
+
+        void MAGNUM_SCENEGRAPH_LOCAL clean(const Math::Matrix4<T>& absoluteTransformationMatrix) override;
+        void MAGNUM_SCENEGRAPH_LOCAL updateAbsoluteBounds();
+
+        Math::Range3D<T> _bounds, _absoluteBounds;
+        Math::Matrix4<T> _absoluteTransformationMatrix;
+};
+
+/**
+@brief Bounds of an object in a three-dimensional float spatial index
+@m_since_latest
+*/
+typedef BasicSpatialBounds3D<Float> SpatialBounds3D;
+
+#if defined(CORRADE_TARGET_WINDOWS) && !(defined(CORRADE_TARGET_MINGW) && !defined(CORRADE_TARGET_CLANG))
+extern template class MAGNUM_SCENEGRAPH_EXPORT BasicSpatialBounds3D<Float>;
+#endif
+
+}}
+
+#endif
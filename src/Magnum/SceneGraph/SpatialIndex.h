@@ -0,0 +1,199 @@
+#ifndef Magnum_SceneGraph_SpatialIndex_h
+#define Magnum_SceneGraph_SpatialIndex_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::BasicSpatialIndex3D, typedef @ref Magnum::SceneGraph::SpatialIndex3D
+ * @m_since_latest
+ */
+
+#include "Magnum/Math/Frustum.h"
+#include "Magnum/SceneGraph/FeatureGroup.h"
+#include "Magnum/SceneGraph/SpatialBounds.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Spatial index
+@m_since_latest
+
+A group of @ref BasicSpatialBounds3D "SpatialBounds3D" features organized in
+a bounding volume hierarchy, allowing frustum, ray, sphere and box queries in
+a logarithmic instead of linear time.
+
+@snippet MagnumSceneGraph.cpp SpatialIndex-usage
+
+@section SceneGraph-SpatialIndex3D-updates Updating the index
+
+The absolute bounds of each object are cached in the feature, which gets
+notified by the scene graph when the object transformation changes. On
+@ref update(), which is also called implicitly by all queries, the dirty
+objects are cleaned, the absolute bounds of them recalculated and the
+hierarchy refitted bottom-up without changing its topology. When features
+are added or removed, the hierarchy is rebuilt from scratch. As refitting
+may degrade the hierarchy quality after large movements, you can call
+@ref rebuild() explicitly as well.
+
+Note that the index is notified about added and removed features only
+through the @ref BasicSpatialBounds3D "SpatialBounds3D" constructor and
+destructor and through @ref add() and @ref remove() of this class, not when
+calling them through the @ref FeatureGroup base.
+
+@section SceneGraph-SpatialIndex3D-explicit-specializations Explicit template specializations
+
+The following specialization is explicitly compiled into @ref SceneGraph
+library. For other specializations (e.g. using @ref Magnum::Double "Double"
+type) you have to use @ref SpatialIndex.hpp implementation file to avoid
+linker errors. See also @ref compilation-speedup-hpp for more information.
+
+-   @ref SpatialIndex3D
+
+@see @ref scenegraph, @ref SpatialIndex3D, @ref Camera::setFrustumCulling()
+*/
+template<class T> class BasicSpatialIndex3D: public FeatureGroup<3, BasicSpatialBounds3D<T>, T> {
+    public:
+        /** @brief Constructor */
+        explicit BasicSpatialIndex3D();
+
+        ~BasicSpatialIndex3D();
+
+        /**
+         * @brief Add a feature to the index
+         * @return Reference to self (for method chaining)
+         *
+         * If the feature is a part of another group, it's removed from it.
+         * The hierarchy gets rebuilt on next @ref update().
+         */
+        BasicSpatialIndex3D<T>& add(BasicSpatialBounds3D<T>& feature);
+
+        /**
+         * @brief Remove a feature from the index
+         * @return Reference to self (for method chaining)
+         *
+         * The feature is expected to be a part of the index. The hierarchy
+         * gets rebuilt on next @ref update().
+         */
+        BasicSpatialIndex3D<T>& remove(BasicSpatialBounds3D<T>& feature);
+
+        /**
+         * @brief Count of nodes in the hierarchy
+         *
+         * Up-to-date after @ref update().
+         */
+        std::size_t nodeCount() const { return _nodes.size(); }
+
+        /**
+         * @brief Update the index
+         *
+         * Cleans all dirty objects, recalculates their absolute bounds and
+         * refits the hierarchy. If features were added or removed since the
+         * last update, rebuilds the hierarchy from scratch instead.
+         */
+        void update();
+
+        /**
+         * @brief Rebuild the hierarchy
+         *
+         * Like @ref update(), but always rebuilds the hierarchy from scratch.
+         */
+        void rebuild();
+
+        /**
+         * @brief Features intersecting a frustum
+         *
+         * Calls @ref update() and returns features whose absolute bounds
+         * intersect @p frustum, tested with
+         * @ref Math::Intersection::rangeFrustum(). The frustum is expected to
+         * be in the same coordinate system as the scene, for example
+         * @cpp Frustum::fromMatrix(camera.projectionMatrix()*camera.cameraMatrix()) @ce.
+         */
+        std::vector<std::reference_wrapper<BasicSpatialBounds3D<T>>> queryFrustum(const Math::Frustum<T>& frustum);
+
+        /**
+         * @brief Features intersecting a ray
+         *
+         * Calls @ref update() and returns features whose absolute bounds
+         * intersect a line going through @p origin in @p direction, tested
+         * with @ref Math::Intersection::rayRange(). Note that the test is done
+         * in both directions from the origin, the caller is expected to
+         * filter out results behind the origin if needed.
+         */
+        std::vector<std::reference_wrapper<BasicSpatialBounds3D<T>>> queryRay(const Math::Vector3<T>& origin, const Math::Vector3<T>& direction);
+
+        /**
+         * @brief Features intersecting a sphere
+         *
+         * Calls @ref update() and returns features whose absolute bounds
+         * intersect a sphere with given @p center and @p radius.
+         */
+        std::vector<std::reference_wrapper<BasicSpatialBounds3D<T>>> querySphere(const Math::Vector3<T>& center, T radius);
+
+        /**
+         * @brief Features intersecting a box
+         *
+         * Calls @ref update() and returns features whose absolute bounds
+         * intersect @p box, tested with @ref Math::intersects().
+         */
+        std::vector<std::reference_wrapper<BasicSpatialBounds3D<T>>> queryBox(const Math::Range3D<T>& box);
+
+    private:
+        friend BasicSpatialBounds3D<T>;
+
+        /* Leaf nodes have count non-zero and first pointing to _items,
+           inner nodes have count zero and first pointing to the left child,
+           which is directly followed by the right child. Children are
+           always after their parent. */
+        struct Node {
+            Math::Range3D<T> bounds;
+            UnsignedInt first;
+            UnsignedInt count;
+        };
+
+        void MAGNUM_SCENEGRAPH_LOCAL cleanObjects();
+        void MAGNUM_SCENEGRAPH_LOCAL buildNode(std::size_t node, UnsignedInt begin, UnsignedInt end);
+        void MAGNUM_SCENEGRAPH_LOCAL refit();
+        template<class F> std::vector<std::reference_wrapper<BasicSpatialBounds3D<T>>> MAGNUM_SCENEGRAPH_LOCAL query(const F& test);
+
+        std::vector<Node> _nodes;
+        /* Indices into the group */
+        std::vector<UnsignedInt> _items;
+        bool _structureDirty, _boundsDirty;
+};
+
+/**
+@brief Three-dimensional float spatial index
+@m_since_latest
+*/
+typedef BasicSpatialIndex3D<Float> SpatialIndex3D;
+
+#if defined(CORRADE_TARGET_WINDOWS) && !(defined(CORRADE_TARGET_MINGW) && !defined(CORRADE_TARGET_CLANG))
+extern template class MAGNUM_SCENEGRAPH_EXPORT BasicSpatialIndex3D<Float>;
+#endif
+
+}}
+
+#endif
@@ -0,0 +1,254 @@
+#ifndef Magnum_SceneGraph_SpatialIndex_hpp
+#define Magnum_SceneGraph_SpatialIndex_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref SpatialBounds.h and @ref SpatialIndex.h
+ * @m_since_latest
+ */
+
+#include <algorithm> /* std::nth_element() */
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Intersection.h"
+#include "Magnum/SceneGraph/AbstractObject.h"
+#include "Magnum/SceneGraph/SpatialBounds.h"
+#include "Magnum/SceneGraph/SpatialIndex.h"
+
+namespace Magnum { namespace SceneGraph {
+
+namespace Implementation {
+    /* Max count of features in a single leaf node */
+    enum: UnsignedInt { SpatialIndexLeafSize = 4 };
+}
+
+template<class T> BasicSpatialBounds3D<T>::BasicSpatialBounds3D(AbstractObject<3, T>& object, const Math::Range3D<T>& bounds, BasicSpatialIndex3D<T>* index): AbstractGroupedFeature<3, BasicSpatialBounds3D<T>, T>{object, index}, _bounds{bounds} {
+    AbstractFeature<3, T>::setCachedTransformations(CachedTransformation::Absolute);
+
+    /* If the object is already clean, clean() won't get called until it
+       gets dirty again, so fetch the transformation directly */
+    _absoluteTransformationMatrix = object.absoluteTransformationMatrix();
+    updateAbsoluteBounds();
+
+    if(index) index->_structureDirty = true;
+}
+
+template<class T> BasicSpatialBounds3D<T>::~BasicSpatialBounds3D() {
+    /* The base destructor removes the feature from the group */
+    if(BasicSpatialIndex3D<T>* i = index()) i->_structureDirty = true;
+}
+
+template<class T> BasicSpatialIndex3D<T>* BasicSpatialBounds3D<T>::index() {
+    return static_cast<BasicSpatialIndex3D<T>*>(AbstractGroupedFeature<3, BasicSpatialBounds3D<T>, T>::group());
+}
+
+template<class T> const BasicSpatialIndex3D<T>* BasicSpatialBounds3D<T>::index() const {
+    return static_cast<const BasicSpatialIndex3D<T>*>(AbstractGroupedFeature<3, BasicSpatialBounds3D<T>, T>::group());
+}
+
+template<class T> BasicSpatialBounds3D<T>& BasicSpatialBounds3D<T>::setBounds(const Math::Range3D<T>& bounds) {
+    _bounds = bounds;
+    updateAbsoluteBounds();
+    return *this;
+}
+
+template<class T> void BasicSpatialBounds3D<T>::clean(const Math::Matrix4<T>& absoluteTransformationMatrix) {
+    _absoluteTransformationMatrix = absoluteTransformationMatrix;
+    updateAbsoluteBounds();
+}
+
+template<class T> void BasicSpatialBounds3D<T>::updateAbsoluteBounds() {
+    /* Transform the center and enlarge the half-size so the box stays
+       axis-aligned after rotation */
+    const Math::Matrix3<T> rotationScaling = _absoluteTransformationMatrix.rotationScaling();
+    const Math::Vector3<T> center = _absoluteTransformationMatrix.transformPoint(_bounds.center());
+    const Math::Vector3<T> halfSize = _bounds.size()/T(2);
+    Math::Vector3<T> absoluteHalfSize;
+    for(std::size_t i = 0; i != 3; ++i)
+        absoluteHalfSize += Math::abs(rotationScaling[i])*halfSize[i];
+    _absoluteBounds = Math::Range3D<T>::fromCenter(center, absoluteHalfSize);
+
+    if(BasicSpatialIndex3D<T>* i = index()) i->_boundsDirty = true;
+}
+
+template<class T> BasicSpatialIndex3D<T>::BasicSpatialIndex3D(): _structureDirty{false}, _boundsDirty{false} {}
+
+template<class T> BasicSpatialIndex3D<T>::~BasicSpatialIndex3D() = default;
+
+template<class T> BasicSpatialIndex3D<T>& BasicSpatialIndex3D<T>::add(BasicSpatialBounds3D<T>& feature) {
+    FeatureGroup<3, BasicSpatialBounds3D<T>, T>::add(feature);
+    _structureDirty = true;
+    return *this;
+}
+
+template<class T> BasicSpatialIndex3D<T>& BasicSpatialIndex3D<T>::remove(BasicSpatialBounds3D<T>& feature) {
+    FeatureGroup<3, BasicSpatialBounds3D<T>, T>::remove(feature);
+    _structureDirty = true;
+    return *this;
+}
+
+template<class T> void BasicSpatialIndex3D<T>::cleanObjects() {
+    /* Clean all dirty objects in a single batch, which calls clean() on the
+       features and updates their absolute bounds */
+    std::vector<std::reference_wrapper<AbstractObject<3, T>>> objects;
+    for(std::size_t i = 0; i != this->size(); ++i) {
+        AbstractObject<3, T>& object = (*this)[i].object();
+        if(object.isDirty()) objects.push_back(object);
+    }
+    if(!objects.empty()) AbstractObject<3, T>::setClean(objects);
+}
+
+template<class T> void BasicSpatialIndex3D<T>::update() {
+    cleanObjects();
+
+    if(_structureDirty) rebuild();
+    else if(_boundsDirty) refit();
+}
+
+template<class T> void BasicSpatialIndex3D<T>::rebuild() {
+    cleanObjects();
+
+    _items.resize(this->size());
+    for(std::size_t i = 0; i != _items.size(); ++i)
+        _items[i] = UnsignedInt(i);
+
+    _nodes.clear();
+    if(!_items.empty()) {
+        _nodes.emplace_back();
+        buildNode(0, 0, UnsignedInt(_items.size()));
+    }
+
+    _structureDirty = false;
+    _boundsDirty = false;
+}
+
+template<class T> void BasicSpatialIndex3D<T>::buildNode(const std::size_t node, const UnsignedInt begin, const UnsignedInt end) {
+    /* Bounds of the node and of the feature centers, which decide the
+       split axis */
+    Math::Range3D<T> bounds = (*this)[_items[begin]]._absoluteBounds;
+    Math::Range3D<T> centerBounds{bounds.center(), bounds.center()};
+    for(UnsignedInt i = begin + 1; i != end; ++i) {
+        const Math::Range3D<T>& itemBounds = (*this)[_items[i]]._absoluteBounds;
+        bounds = Math::join(bounds, itemBounds);
+        centerBounds = Math::join(centerBounds, Math::Range3D<T>{itemBounds.center(), itemBounds.center()});
+    }
+    _nodes[node].bounds = bounds;
+
+    if(end - begin <= Implementation::SpatialIndexLeafSize) {
+        _nodes[node].first = begin;
+        _nodes[node].count = end - begin;
+        return;
+    }
+
+    /* Median split along the longest axis of the centers */
+    const Math::Vector3<T> size = centerBounds.size();
+    const std::size_t axis = size.x() >= size.y() && size.x() >= size.z() ? 0 :
+        size.y() >= size.z() ? 1 : 2;
+    const UnsignedInt middle = begin + (end - begin)/2;
+    std::nth_element(_items.begin() + begin, _items.begin() + middle, _items.begin() + end, [this, axis](UnsignedInt a, UnsignedInt b) {
+        return (*this)[a]._absoluteBounds.center()[axis] < (*this)[b]._absoluteBounds.center()[axis];
+    });
+
+    const std::size_t left = _nodes.size();
+    _nodes[node].first = UnsignedInt(left);
+    _nodes[node].count = 0;
+    _nodes.emplace_back();
+    _nodes.emplace_back();
+    buildNode(left, begin, middle);
+    buildNode(left + 1, middle, end);
+}
+
+template<class T> void BasicSpatialIndex3D<T>::refit() {
+    /* Children are always after their parent, so going backwards updates
+       them before the parent */
+    for(std::size_t i = _nodes.size(); i != 0; --i) {
+        Node& node = _nodes[i - 1];
+        if(node.count) {
+            Math::Range3D<T> bounds = (*this)[_items[node.first]]._absoluteBounds;
+            for(UnsignedInt j = 1; j != node.count; ++j)
+                bounds = Math::join(bounds, (*this)[_items[node.first + j]]._absoluteBounds);
+            node.bounds = bounds;
+        } else node.bounds = Math::join(_nodes[node.first].bounds, _nodes[node.first + 1].bounds);
+    }
+
+    _boundsDirty = false;
+}
+
+template<class T> template<class F> std::vector<std::reference_wrapper<BasicSpatialBounds3D<T>>> BasicSpatialIndex3D<T>::query(const F& test) {
+    update();
+
+    std::vector<std::reference_wrapper<BasicSpatialBounds3D<T>>> out;
+    if(_nodes.empty()) return out;
+
+    std::vector<UnsignedInt> stack{0};
+    while(!stack.empty()) {
+        const Node& node = _nodes[stack.back()];
+        stack.pop_back();
+        if(!test(node.bounds)) continue;
+
+        if(node.count) {
+            for(UnsignedInt i = 0; i != node.count; ++i) {
+                BasicSpatialBounds3D<T>& feature = (*this)[_items[node.first + i]];
+                if(test(feature._absoluteBounds)) out.push_back(feature);
+            }
+        } else {
+            stack.push_back(node.first + 1);
+            stack.push_back(node.first);
+        }
+    }
+
+    return out;
+}
+
+template<class T> std::vector<std::reference_wrapper<BasicSpatialBounds3D<T>>> BasicSpatialIndex3D<T>::queryFrustum(const Math::Frustum<T>& frustum) {
+    return query([&frustum](const Math::Range3D<T>& bounds) {
+        return Math::Intersection::rangeFrustum(bounds, frustum);
+    });
+}
+
+template<class T> std::vector<std::reference_wrapper<BasicSpatialBounds3D<T>>> BasicSpatialIndex3D<T>::queryRay(const Math::Vector3<T>& origin, const Math::Vector3<T>& direction) {
+    const Math::Vector3<T> inverseDirection = T(1)/direction;
+    return query([&origin, &inverseDirection](const Math::Range3D<T>& bounds) {
+        return Math::Intersection::rayRange(origin, inverseDirection, bounds);
+    });
+}
+
+template<class T> std::vector<std::reference_wrapper<BasicSpatialBounds3D<T>>> BasicSpatialIndex3D<T>::querySphere(const Math::Vector3<T>& center, const T radius) {
+    const T radiusSquared = radius*radius;
+    return query([&center, radiusSquared](const Math::Range3D<T>& bounds) {
+        return (Math::clamp(center, bounds.min(), bounds.max()) - center).dot() <= radiusSquared;
+    });
+}
+
+template<class T> std::vector<std::reference_wrapper<BasicSpatialBounds3D<T>>> BasicSpatialIndex3D<T>::queryBox(const Math::Range3D<T>& box) {
+    return query([&box](const Math::Range3D<T>& bounds) {
+        return Math::intersects(bounds, box);
+    });
+}
+
+}}
+
+#endif
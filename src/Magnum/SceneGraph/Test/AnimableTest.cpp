@@ -25,6 +25,7 @@
 
 #include <sstream>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/Utility/DebugStl.h>
 
 #include "Magnum/SceneGraph/AbstractFeature.hpp"
@@ -36,6 +37,18 @@
 
 namespace Magnum { namespace SceneGraph { namespace Test { namespace {
 
+const struct {
+    const char* name;
+    std::size_t count;
+    UnsignedInt threadCount;
+} StepThreadSafeData[]{
+    {"single thread", 16, 1},
+    {"four threads, below threshold", 16, 4},
+    {"single thread, above threshold", 3000, 1},
+    {"four threads", 3000, 4},
+    {"hardware concurrency", 3000, 0},
+};
+
 struct AnimableTest: TestSuite::Tester {
     explicit AnimableTest();
 
@@ -46,6 +59,8 @@ struct AnimableTest: TestSuite::Tester {
     template<class T> void stop();
     template<class T> void pause();
 
+    void stepThreadSafe();
+
     void deleteWhileRunning();
 
     void debug();
@@ -63,9 +78,12 @@ AnimableTest::AnimableTest() {
               &AnimableTest::stop<Float>,
               &AnimableTest::stop<Double>,
               &AnimableTest::pause<Float>,
-              &AnimableTest::pause<Double>,
+              &AnimableTest::pause<Double>});
 
-              &AnimableTest::deleteWhileRunning,
+    addInstancedTests({&AnimableTest::stepThreadSafe},
+        Containers::arraySize(StepThreadSafeData));
+
+    addTests({&AnimableTest::deleteWhileRunning,
 
               &AnimableTest::debug});
 }
@@ -377,6 +395,69 @@ template<class T> void AnimableTest::pause() {
     CORRADE_COMPARE(animable.time, 2.0f);
 }
 
+void AnimableTest::stepThreadSafe() {
+    auto&& data = StepThreadSafeData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Every third animable is not thread-safe, those are stepped directly.
+       The thread-safe ones record the time in animationStep() and publish
+       it in animationCommit(). */
+    class LoggingAnimable: public SceneGraph::Animable3D {
+        public:
+            explicit LoggingAnimable(AbstractObject3D& object, AnimableGroup3D& group, Int id, std::vector<Int>& log, std::vector<Float>& times): SceneGraph::Animable3D{object, &group}, _id{id}, _log(log), _times(times), _time{-1.0f} {}
+
+        protected:
+            void animationStep(Float time, Float) override {
+                if(isThreadSafe()) {
+                    _time = time;
+                } else {
+                    _log.push_back(_id);
+                    _times[_id] = time;
+                }
+            }
+
+            void animationCommit() override {
+                _log.push_back(_id);
+                _times[_id] = _time;
+            }
+
+        private:
+            Int _id;
+            std::vector<Int>& _log;
+            std::vector<Float>& _times;
+            Float _time;
+    };
+
+    Object3D<Float> object;
+    AnimableGroup3D group;
+    std::vector<Int> log;
+    std::vector<Float> times(data.count, -1.0f);
+    for(std::size_t i = 0; i != data.count; ++i) {
+        (new LoggingAnimable{object, group, Int(i), log, times})
+            ->setThreadSafe(i % 3 != 0)
+            .setState(AnimationState::Running);
+    }
+    CORRADE_VERIFY(!group[0].isThreadSafe());
+    CORRADE_VERIFY(group[1].isThreadSafe());
+
+    group.step(1.0f, 0.5f, data.threadCount);
+    group.step(3.5f, 0.5f, data.threadCount);
+    CORRADE_COMPARE(group.runningCount(), data.count);
+
+    /* The non-thread-safe animables are stepped first, then the thread-safe
+       ones are committed, both in the group order */
+    std::vector<Int> expected;
+    for(Int step = 0; step != 2; ++step) {
+        for(std::size_t i = 0; i < data.count; i += 3)
+            expected.push_back(i);
+        for(std::size_t i = 0; i != data.count; ++i)
+            if(i % 3) expected.push_back(i);
+    }
+    CORRADE_COMPARE_AS(log, expected, TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(times, std::vector<Float>(data.count, 2.5f),
+        TestSuite::Compare::Container);
+}
+
 void AnimableTest::deleteWhileRunning() {
     Object3D<Float> object;
     AnimableGroup3D group;
@@ -23,7 +23,7 @@
     DEALINGS IN THE SOFTWARE.
 */
 
-#include <algorithm> /* std::sort() */
+#include <algorithm> /* std::sort(), std::reverse() */
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
 
@@ -53,6 +53,13 @@ struct CameraTest: TestSuite::Tester {
 
     template<class T> void draw();
     template<class T> void drawOrdered();
+
+    template<class T> void drawableBounds();
+    template<class T> void drawCulledSphere();
+    template<class T> void drawCulledBox();
+    template<class T> void drawCulled2D();
+    template<class T> void drawCulledDisabled();
+    template<class T> void drawCulledTransformations();
 };
 
 CameraTest::CameraTest() {
@@ -77,13 +84,40 @@ CameraTest::CameraTest() {
         &CameraTest::draw<Float>,
         &CameraTest::draw<Double>,
         &CameraTest::drawOrdered<Float>,
-        &CameraTest::drawOrdered<Double>});
+        &CameraTest::drawOrdered<Double>,
+
+        &CameraTest::drawableBounds<Float>,
+        &CameraTest::drawableBounds<Double>,
+        &CameraTest::drawCulledSphere<Float>,
+        &CameraTest::drawCulledSphere<Double>,
+        &CameraTest::drawCulledBox<Float>,
+        &CameraTest::drawCulledBox<Double>,
+        &CameraTest::drawCulled2D<Float>,
+        &CameraTest::drawCulled2D<Double>,
+        &CameraTest::drawCulledDisabled<Float>,
+        &CameraTest::drawCulledDisabled<Double>,
+        &CameraTest::drawCulledTransformations<Float>,
+        &CameraTest::drawCulledTransformations<Double>});
 }
 
 template<class T> using Object2D = SceneGraph::Object<SceneGraph::BasicMatrixTransformation2D<T>>;
 template<class T> using Object3D = SceneGraph::Object<SceneGraph::BasicMatrixTransformation3D<T>>;
+template<class T> using Scene2D = SceneGraph::Scene<SceneGraph::BasicMatrixTransformation2D<T>>;
 template<class T> using Scene3D = SceneGraph::Scene<SceneGraph::BasicMatrixTransformation3D<T>>;
 
+template<UnsignedInt dimensions, class T> class IdDrawable: public SceneGraph::Drawable<dimensions, T> {
+    public:
+        explicit IdDrawable(AbstractObject<dimensions, T>& object, DrawableGroup<dimensions, T>* group, Int id, std::vector<Int>& drawn): SceneGraph::Drawable<dimensions, T>{object, group}, _id{id}, _drawn(drawn) {}
+
+    private:
+        void draw(const MatrixTypeFor<dimensions, T>&, Camera<dimensions, T>&) override {
+            _drawn.push_back(_id);
+        }
+
+        Int _id;
+        std::vector<Int>& _drawn;
+};
+
 template<class T> void CameraTest::fixAspectRatio() {
     setTestCaseTemplateName(Math::TypeTraits<T>::name());
 
@@ -302,6 +336,211 @@ template<class T> void CameraTest::drawOrdered() {
     }), TestSuite::Compare::Container);
 }
 
+template<class T> void CameraTest::drawableBounds() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    Scene3D<T> scene;
+    Object3D<T> object{&scene};
+    std::vector<Int> drawn;
+    IdDrawable<3, T> drawable{object, nullptr, 0, drawn};
+    CORRADE_COMPARE(drawable.bounds(), DrawableBounds::None);
+
+    drawable.setBoundingSphere({T(1.0), T(2.0), T(3.0)}, T(0.5));
+    CORRADE_COMPARE(drawable.bounds(), DrawableBounds::Sphere);
+    CORRADE_COMPARE(drawable.boundingSphereCenter(), (Math::Vector3<T>{T(1.0), T(2.0), T(3.0)}));
+    CORRADE_COMPARE(drawable.boundingSphereRadius(), T(0.5));
+
+    drawable.setBoundingBox({{T(-1.0), T(0.0), T(1.0)}, {T(3.0), T(2.0), T(2.0)}});
+    CORRADE_COMPARE(drawable.bounds(), DrawableBounds::Box);
+    CORRADE_COMPARE(drawable.boundingBox(), (Math::Range3D<T>{{T(-1.0), T(0.0), T(1.0)}, {T(3.0), T(2.0), T(2.0)}}));
+
+    drawable.resetBounds();
+    CORRADE_COMPARE(drawable.bounds(), DrawableBounds::None);
+}
+
+template<class T> void CameraTest::drawCulledSphere() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    BasicDrawableGroup3D<T> group;
+    Scene3D<T> scene;
+    std::vector<Int> drawn;
+
+    /* In front of the camera */
+    Object3D<T> a{&scene};
+    a.translate(Math::Vector3<T>::zAxis(T(-5.0)));
+    (new IdDrawable<3, T>{a, &group, 0, drawn})->setBoundingSphere({}, T(1.0));
+
+    /* Behind the camera */
+    Object3D<T> b{&scene};
+    b.translate(Math::Vector3<T>::zAxis(T(5.0)));
+    (new IdDrawable<3, T>{b, &group, 1, drawn})->setBoundingSphere({}, T(1.0));
+
+    /* Far to the right */
+    Object3D<T> c{&scene};
+    c.translate({T(100.0), T(0.0), T(-5.0)});
+    (new IdDrawable<3, T>{c, &group, 2, drawn})->setBoundingSphere({}, T(1.0));
+
+    /* Behind the camera but without bounds, so always drawn */
+    Object3D<T> d{&scene};
+    d.translate(Math::Vector3<T>::zAxis(T(5.0)));
+    new IdDrawable<3, T>{d, &group, 3, drawn};
+
+    /* Center behind the camera, but the object scale makes the sphere large
+       enough to reach into the view */
+    Object3D<T> e{&scene};
+    e.scale(Math::Vector3<T>{T(10.0)})
+     .translate(Math::Vector3<T>::zAxis(T(0.5)));
+    (new IdDrawable<3, T>{e, &group, 4, drawn})->setBoundingSphere({}, T(1.0));
+
+    /* Object behind the camera, but the sphere center offset moves it in
+       front */
+    Object3D<T> f{&scene};
+    f.translate(Math::Vector3<T>::zAxis(T(5.0)));
+    (new IdDrawable<3, T>{f, &group, 5, drawn})->setBoundingSphere(Math::Vector3<T>::zAxis(T(-10.0)), T(1.0));
+
+    Object3D<T> cameraObject{&scene};
+    BasicCamera3D<T> camera{cameraObject};
+    camera.setProjectionMatrix(Math::Matrix4<T>::perspectiveProjection(Math::Deg<T>(T(90.0)), T(1.0), T(0.1), T(100.0)))
+        .setFrustumCulling(true);
+    CORRADE_VERIFY(camera.frustumCulling());
+
+    camera.draw(group);
+    CORRADE_COMPARE_AS(drawn, (std::vector<Int>{0, 3, 4, 5}),
+        TestSuite::Compare::Container);
+}
+
+template<class T> void CameraTest::drawCulledBox() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    BasicDrawableGroup3D<T> group;
+    Scene3D<T> scene;
+    std::vector<Int> drawn;
+    const Math::Range3D<T> box{Math::Vector3<T>{T(-1.0)}, Math::Vector3<T>{T(1.0)}};
+
+    /* In front of the camera */
+    Object3D<T> a{&scene};
+    a.translate(Math::Vector3<T>::zAxis(T(-2.0)));
+    (new IdDrawable<3, T>{a, &group, 0, drawn})->setBoundingBox(box);
+
+    /* Behind the camera */
+    Object3D<T> b{&scene};
+    b.translate(Math::Vector3<T>::zAxis(T(3.0)));
+    (new IdDrawable<3, T>{b, &group, 1, drawn})->setBoundingBox(box);
+
+    /* Outside of the right frustum plane */
+    Object3D<T> c{&scene};
+    c.translate({T(5.0), T(0.0), T(-2.0)});
+    (new IdDrawable<3, T>{c, &group, 2, drawn})->setBoundingBox(box);
+
+    /* The same position, but rotated and scaled so the box reaches into the
+       view */
+    Object3D<T> d{&scene};
+    d.scale(Math::Vector3<T>{T(2.0)})
+     .rotateY(Math::Deg<T>(T(45.0)))
+     .translate({T(5.0), T(0.0), T(-2.0)});
+    (new IdDrawable<3, T>{d, &group, 3, drawn})->setBoundingBox(box);
+
+    Object3D<T> cameraObject{&scene};
+    BasicCamera3D<T> camera{cameraObject};
+    camera.setProjectionMatrix(Math::Matrix4<T>::perspectiveProjection(Math::Deg<T>(T(90.0)), T(1.0), T(0.1), T(100.0)))
+        .setFrustumCulling(true);
+
+    camera.draw(group);
+    CORRADE_COMPARE_AS(drawn, (std::vector<Int>{0, 3}),
+        TestSuite::Compare::Container);
+}
+
+template<class T> void CameraTest::drawCulled2D() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    BasicDrawableGroup2D<T> group;
+    Scene2D<T> scene;
+    std::vector<Int> drawn;
+
+    Object2D<T> a{&scene};
+    a.translate(Math::Vector2<T>::xAxis(T(0.5)));
+    (new IdDrawable<2, T>{a, &group, 0, drawn})->setBoundingSphere({}, T(0.1));
+
+    Object2D<T> b{&scene};
+    b.translate(Math::Vector2<T>::xAxis(T(3.0)));
+    (new IdDrawable<2, T>{b, &group, 1, drawn})->setBoundingSphere({}, T(1.0));
+
+    Object2D<T> c{&scene};
+    c.translate(Math::Vector2<T>::xAxis(T(1.5)));
+    (new IdDrawable<2, T>{c, &group, 2, drawn})->setBoundingSphere({}, T(1.0));
+
+    Object2D<T> d{&scene};
+    d.translate(Math::Vector2<T>::yAxis(T(-2.0)));
+    (new IdDrawable<2, T>{d, &group, 3, drawn})->setBoundingBox({Math::Vector2<T>{T(-0.1)}, Math::Vector2<T>{T(0.1)}});
+
+    /* Default projection shows the [-1, 1] square */
+    Object2D<T> cameraObject{&scene};
+    BasicCamera2D<T> camera{cameraObject};
+    camera.setFrustumCulling(true);
+
+    camera.draw(group);
+    CORRADE_COMPARE_AS(drawn, (std::vector<Int>{0, 2}),
+        TestSuite::Compare::Container);
+}
+
+template<class T> void CameraTest::drawCulledDisabled() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    BasicDrawableGroup3D<T> group;
+    Scene3D<T> scene;
+    std::vector<Int> drawn;
+
+    Object3D<T> a{&scene};
+    a.translate(Math::Vector3<T>::zAxis(T(-5.0)));
+    (new IdDrawable<3, T>{a, &group, 0, drawn})->setBoundingSphere({}, T(1.0));
+
+    Object3D<T> b{&scene};
+    b.translate(Math::Vector3<T>::zAxis(T(5.0)));
+    (new IdDrawable<3, T>{b, &group, 1, drawn})->setBoundingSphere({}, T(1.0));
+
+    Object3D<T> cameraObject{&scene};
+    BasicCamera3D<T> camera{cameraObject};
+    camera.setProjectionMatrix(Math::Matrix4<T>::perspectiveProjection(Math::Deg<T>(T(90.0)), T(1.0), T(0.1), T(100.0)));
+
+    /* Culling is disabled by default, everything gets drawn */
+    CORRADE_VERIFY(!camera.frustumCulling());
+    camera.draw(group);
+    CORRADE_COMPARE_AS(drawn, (std::vector<Int>{0, 1}),
+        TestSuite::Compare::Container);
+}
+
+template<class T> void CameraTest::drawCulledTransformations() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    BasicDrawableGroup3D<T> group;
+    Scene3D<T> scene;
+    std::vector<Int> drawn;
+
+    Object3D<T> a{&scene};
+    a.translate(Math::Vector3<T>::zAxis(T(-5.0)));
+    (new IdDrawable<3, T>{a, &group, 0, drawn})->setBoundingSphere({}, T(1.0));
+
+    Object3D<T> b{&scene};
+    b.translate(Math::Vector3<T>::zAxis(T(5.0)));
+    (new IdDrawable<3, T>{b, &group, 1, drawn})->setBoundingSphere({}, T(1.0));
+
+    Object3D<T> c{&scene};
+    c.translate(Math::Vector3<T>::zAxis(T(-10.0)));
+    (new IdDrawable<3, T>{c, &group, 2, drawn})->setBoundingSphere({}, T(1.0));
+
+    Object3D<T> cameraObject{&scene};
+    BasicCamera3D<T> camera{cameraObject};
+    camera.setProjectionMatrix(Math::Matrix4<T>::perspectiveProjection(Math::Deg<T>(T(90.0)), T(1.0), T(0.1), T(100.0)))
+        .setFrustumCulling(true);
+
+    /* Culling is applied also to a custom list, preserving its order */
+    std::vector<std::pair<std::reference_wrapper<SceneGraph::BasicDrawable3D<T>>, Math::Matrix4<T>>> drawableTransformations = camera.drawableTransformations(group);
+    std::reverse(drawableTransformations.begin(), drawableTransformations.end());
+    camera.draw(drawableTransformations);
+    CORRADE_COMPARE_AS(drawn, (std::vector<Int>{2, 0}),
+        TestSuite::Compare::Container);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::CameraTest)
@@ -0,0 +1,200 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/SceneGraph/AbstractGroupedFeature.h"
+#include "Magnum/SceneGraph/FeatureGroup.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Object.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test { namespace {
+
+struct FeatureGroupTest: TestSuite::Tester {
+    explicit FeatureGroupTest();
+
+    void add();
+    void addFromOtherGroup();
+    void remove();
+    void removeLast();
+    void addMultiple();
+    void removeMultiple();
+    void destructFeature();
+};
+
+typedef Object<MatrixTransformation3D> Object3D;
+typedef Scene<MatrixTransformation3D> Scene3D;
+
+struct Feature: AbstractGroupedFeature3D<Feature> {
+    explicit Feature(AbstractObject3D& object, FeatureGroup3D<Feature>* group = nullptr): AbstractGroupedFeature3D<Feature>{object, group} {}
+};
+
+FeatureGroupTest::FeatureGroupTest() {
+    addTests({&FeatureGroupTest::add,
+              &FeatureGroupTest::addFromOtherGroup,
+              &FeatureGroupTest::remove,
+              &FeatureGroupTest::removeLast,
+              &FeatureGroupTest::addMultiple,
+              &FeatureGroupTest::removeMultiple,
+              &FeatureGroupTest::destructFeature});
+}
+
+void FeatureGroupTest::add() {
+    Scene3D scene;
+    Object3D object{&scene};
+    FeatureGroup3D<Feature> group;
+    CORRADE_VERIFY(group.isEmpty());
+
+    Feature a{object, &group};
+    Feature b{object};
+    group.add(b);
+    CORRADE_COMPARE(group.size(), 2);
+    CORRADE_COMPARE(&group[0], &a);
+    CORRADE_COMPARE(&group[1], &b);
+    CORRADE_COMPARE(b.group(), &group);
+}
+
+void FeatureGroupTest::addFromOtherGroup() {
+    Scene3D scene;
+    Object3D object{&scene};
+    FeatureGroup3D<Feature> group1;
+    FeatureGroup3D<Feature> group2;
+
+    Feature a{object, &group1};
+    Feature b{object, &group1};
+    group2.add(a);
+    CORRADE_COMPARE(group1.size(), 1);
+    CORRADE_COMPARE(&group1[0], &b);
+    CORRADE_COMPARE(group2.size(), 1);
+    CORRADE_COMPARE(&group2[0], &a);
+    CORRADE_COMPARE(a.group(), &group2);
+}
+
+void FeatureGroupTest::remove() {
+    Scene3D scene;
+    Object3D object{&scene};
+    FeatureGroup3D<Feature> group;
+
+    Feature a{object, &group};
+    Feature b{object, &group};
+    Feature c{object, &group};
+    Feature d{object, &group};
+
+    /* The last feature gets moved into the place of the removed one */
+    group.remove(b);
+    CORRADE_VERIFY(!b.group());
+    CORRADE_COMPARE(group.size(), 3);
+    CORRADE_COMPARE(&group[0], &a);
+    CORRADE_COMPARE(&group[1], &d);
+    CORRADE_COMPARE(&group[2], &c);
+
+    /* The moved feature has its index updated, so removing it works */
+    group.remove(d);
+    CORRADE_COMPARE(group.size(), 2);
+    CORRADE_COMPARE(&group[0], &a);
+    CORRADE_COMPARE(&group[1], &c);
+
+    group.remove(a);
+    CORRADE_COMPARE(group.size(), 1);
+    CORRADE_COMPARE(&group[0], &c);
+}
+
+void FeatureGroupTest::removeLast() {
+    Scene3D scene;
+    Object3D object{&scene};
+    FeatureGroup3D<Feature> group;
+
+    Feature a{object, &group};
+    Feature b{object, &group};
+
+    group.remove(b);
+    CORRADE_COMPARE(group.size(), 1);
+    CORRADE_COMPARE(&group[0], &a);
+
+    group.remove(a);
+    CORRADE_VERIFY(group.isEmpty());
+}
+
+void FeatureGroupTest::addMultiple() {
+    Scene3D scene;
+    Object3D object{&scene};
+    FeatureGroup3D<Feature> group;
+    FeatureGroup3D<Feature> otherGroup;
+
+    Feature a{object, &group};
+    Feature b{object};
+    Feature c{object, &otherGroup};
+    group.add({b, c});
+    CORRADE_COMPARE(group.size(), 3);
+    CORRADE_COMPARE(&group[0], &a);
+    CORRADE_COMPARE(&group[1], &b);
+    CORRADE_COMPARE(&group[2], &c);
+    CORRADE_VERIFY(otherGroup.isEmpty());
+
+    /* Indices are correct so removal works */
+    group.remove(b);
+    CORRADE_COMPARE(group.size(), 2);
+    CORRADE_COMPARE(&group[1], &c);
+}
+
+void FeatureGroupTest::removeMultiple() {
+    Scene3D scene;
+    Object3D object{&scene};
+    FeatureGroup3D<Feature> group;
+
+    Feature a{object, &group};
+    Feature b{object, &group};
+    Feature c{object, &group};
+    Feature d{object, &group};
+    Feature e{object, &group};
+
+    group.remove({a, e, c});
+    CORRADE_COMPARE(group.size(), 2);
+    CORRADE_VERIFY(!a.group());
+    CORRADE_VERIFY(!c.group());
+    CORRADE_VERIFY(!e.group());
+    CORRADE_COMPARE(&group[0], &d);
+    CORRADE_COMPARE(&group[1], &b);
+}
+
+void FeatureGroupTest::destructFeature() {
+    Scene3D scene;
+    Object3D object{&scene};
+    FeatureGroup3D<Feature> group;
+
+    Feature a{object, &group};
+    Feature* b = new Feature{object, &group};
+    Feature c{object, &group};
+
+    delete b;
+    CORRADE_COMPARE(group.size(), 2);
+    CORRADE_COMPARE(&group[0], &a);
+    CORRADE_COMPARE(&group[1], &c);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::FeatureGroupTest)
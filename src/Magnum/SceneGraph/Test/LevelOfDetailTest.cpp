@@ -0,0 +1,431 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Constants.h"
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/LevelOfDetail.h"
+#include "Magnum/SceneGraph/MatrixTransformation2D.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test { namespace {
+
+struct LevelOfDetailTest: TestSuite::Tester {
+    explicit LevelOfDetailTest();
+
+    void construct();
+    void addLevel();
+    void addLevelInvalidOrder();
+    void levelOutOfRange();
+
+    void select();
+    void selectScaled();
+    void select2D();
+    void selectBehindCamera();
+    void selectTooSmall();
+    void selectNoLevels();
+    void selectHysteresis();
+    void selectHysteresisInvalid();
+    void selectTriangleBudget();
+    void selectTriangleBudgetUnreachable();
+    void selectNoScene();
+};
+
+typedef Object<MatrixTransformation2D> Object2D;
+typedef Scene<MatrixTransformation2D> Scene2D;
+typedef Object<MatrixTransformation3D> Object3D;
+typedef Scene<MatrixTransformation3D> Scene3D;
+
+using namespace Math::Literals;
+
+LevelOfDetailTest::LevelOfDetailTest() {
+    addTests({&LevelOfDetailTest::construct,
+              &LevelOfDetailTest::addLevel,
+              &LevelOfDetailTest::addLevelInvalidOrder,
+              &LevelOfDetailTest::levelOutOfRange,
+
+              &LevelOfDetailTest::select,
+              &LevelOfDetailTest::selectScaled,
+              &LevelOfDetailTest::select2D,
+              &LevelOfDetailTest::selectBehindCamera,
+              &LevelOfDetailTest::selectTooSmall,
+              &LevelOfDetailTest::selectNoLevels,
+              &LevelOfDetailTest::selectHysteresis,
+              &LevelOfDetailTest::selectHysteresisInvalid,
+              &LevelOfDetailTest::selectTriangleBudget,
+              &LevelOfDetailTest::selectTriangleBudgetUnreachable,
+              &LevelOfDetailTest::selectNoScene});
+}
+
+void LevelOfDetailTest::construct() {
+    Object3D object;
+    LevelOfDetailGroup3D group;
+    LevelOfDetail3D lod{object, &group};
+    CORRADE_COMPARE(&lod.object(), &object);
+    CORRADE_COMPARE(lod.levelOfDetailGroup(), &group);
+    CORRADE_COMPARE(group.size(), 1);
+    CORRADE_COMPARE(lod.boundingSphereCenter(), Vector3{});
+    CORRADE_COMPARE(lod.boundingSphereRadius(), 1.0f);
+    CORRADE_COMPARE(lod.levelCount(), 0);
+    CORRADE_COMPARE(lod.level(), 0);
+    CORRADE_COMPARE(lod.screenSize(), 0.0f);
+
+    CORRADE_COMPARE(group.hysteresis(), 0.0f);
+    CORRADE_COMPARE(group.triangleBudget(), 0);
+}
+
+void LevelOfDetailTest::addLevel() {
+    Object3D object;
+    LevelOfDetail3D lod{object};
+    lod.setBoundingSphere({1.0f, 2.0f, 3.0f}, 4.5f)
+       .addLevel(0.5f, 1000)
+       .addLevel(0.5f, 500)
+       .addLevel(0.0f, 10);
+    CORRADE_COMPARE(lod.boundingSphereCenter(), (Vector3{1.0f, 2.0f, 3.0f}));
+    CORRADE_COMPARE(lod.boundingSphereRadius(), 4.5f);
+    CORRADE_COMPARE(lod.levelCount(), 3);
+    CORRADE_COMPARE(lod.levelMinScreenSize(0), 0.5f);
+    CORRADE_COMPARE(lod.levelMinScreenSize(2), 0.0f);
+    CORRADE_COMPARE(lod.levelTriangleCount(1), 500);
+    CORRADE_COMPARE(lod.levelTriangleCount(2), 10);
+}
+
+void LevelOfDetailTest::addLevelInvalidOrder() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Object3D object;
+    LevelOfDetail3D lod{object};
+    lod.addLevel(0.25f, 100);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    lod.addLevel(0.5f, 10);
+    CORRADE_COMPARE(lod.levelCount(), 1);
+    CORRADE_COMPARE(out.str(), "SceneGraph::LevelOfDetail::addLevel(): expected minimal screen size not larger than 0.25 but got 0.5\n");
+}
+
+void LevelOfDetailTest::levelOutOfRange() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Object3D object;
+    LevelOfDetail3D lod{object};
+    lod.addLevel(0.25f, 100)
+       .addLevel(0.0f, 10);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    lod.levelMinScreenSize(2);
+    lod.levelTriangleCount(2);
+    CORRADE_COMPARE(out.str(),
+        "SceneGraph::LevelOfDetail::levelMinScreenSize(): index 2 out of range for 2 levels\n"
+        "SceneGraph::LevelOfDetail::levelTriangleCount(): index 2 out of range for 2 levels\n");
+}
+
+void LevelOfDetailTest::select() {
+    Scene3D scene;
+    LevelOfDetailGroup3D group;
+
+    /* With a 90° field of view and a square aspect ratio, the screen size is
+       radius divided by distance */
+    Object3D cameraObject{&scene};
+    cameraObject.translate(Vector3::zAxis(2.0f));
+    Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(Matrix4::perspectiveProjection(90.0_degf, 1.0f, 0.1f, 100.0f));
+
+    Object3D close{&scene}, middle{&scene}, distant{&scene};
+    close.translate(Vector3::zAxis(1.0f));
+    middle.translate(Vector3::zAxis(-3.0f));
+    distant.translate(Vector3::zAxis(-18.0f));
+
+    LevelOfDetail3D closeLod{close, &group};
+    LevelOfDetail3D middleLod{middle, &group};
+    LevelOfDetail3D distantLod{distant, &group};
+    for(LevelOfDetail3D* lod: {&closeLod, &middleLod, &distantLod})
+        lod->addLevel(0.5f, 1000)
+            .addLevel(0.15f, 100)
+            .addLevel(0.0f, 10);
+
+    CORRADE_COMPARE(group.select(camera), 1000 + 100 + 10);
+    CORRADE_COMPARE(closeLod.screenSize(), 1.0f);
+    CORRADE_COMPARE(middleLod.screenSize(), 0.2f);
+    CORRADE_COMPARE(distantLod.screenSize(), 0.05f);
+    CORRADE_COMPARE(closeLod.level(), 0);
+    CORRADE_COMPARE(middleLod.level(), 1);
+    CORRADE_COMPARE(distantLod.level(), 2);
+
+    /* Moving the camera further away makes everything coarser */
+    cameraObject.translate(Vector3::zAxis(2.0f));
+    CORRADE_COMPARE(group.select(camera), 100 + 10 + 10);
+    CORRADE_COMPARE(closeLod.screenSize(), 1.0f/3.0f);
+    CORRADE_COMPARE(closeLod.level(), 1);
+    CORRADE_COMPARE(middleLod.level(), 2);
+    CORRADE_COMPARE(distantLod.level(), 2);
+}
+
+void LevelOfDetailTest::selectScaled() {
+    Scene3D scene;
+    LevelOfDetailGroup3D group;
+
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(Matrix4::perspectiveProjection(90.0_degf, 1.0f, 0.1f, 100.0f));
+
+    /* The sphere center is transformed with the object and the radius is
+       scaled by the largest axis scale */
+    Object3D object{&scene};
+    object.scale({1.0f, 3.0f, 0.5f})
+          .translate(Vector3::zAxis(-4.0f));
+    LevelOfDetail3D lod{object, &group};
+    lod.setBoundingSphere(Vector3::zAxis(-4.0f), 0.5f)
+       .addLevel(0.0f, 10);
+
+    /* Center at Z = -4 - 4*0.5 = -6, radius 0.5*3 */
+    group.select(camera);
+    CORRADE_COMPARE(lod.screenSize(), 0.25f);
+}
+
+void LevelOfDetailTest::select2D() {
+    Scene2D scene;
+    LevelOfDetailGroup2D group;
+
+    Object2D cameraObject{&scene};
+    Camera2D camera{cameraObject};
+    camera.setProjectionMatrix(Matrix3::projection({8.0f, 4.0f}));
+
+    /* Projection has no perspective, so the screen size is just the radius
+       relative to half of the projection height */
+    Object2D object{&scene};
+    object.translate({100.0f, 0.0f});
+    LevelOfDetail2D lod{object, &group};
+    lod.setBoundingSphere({}, 0.5f)
+       .addLevel(0.5f, 20)
+       .addLevel(0.0f, 2);
+
+    CORRADE_COMPARE(group.select(camera), 2);
+    CORRADE_COMPARE(lod.screenSize(), 0.25f);
+    CORRADE_COMPARE(lod.level(), 1);
+
+    object.scale(Vector2{3.0f});
+    CORRADE_COMPARE(group.select(camera), 20);
+    CORRADE_COMPARE(lod.screenSize(), 0.75f);
+    CORRADE_COMPARE(lod.level(), 0);
+}
+
+void LevelOfDetailTest::selectBehindCamera() {
+    Scene3D scene;
+    LevelOfDetailGroup3D group;
+
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(Matrix4::perspectiveProjection(90.0_degf, 1.0f, 0.1f, 100.0f));
+
+    Object3D object{&scene};
+    object.translate(Vector3::zAxis(5.0f));
+    LevelOfDetail3D lod{object, &group};
+    lod.addLevel(0.5f, 1000)
+       .addLevel(0.0f, 10);
+
+    /* Picks the finest level */
+    CORRADE_COMPARE(group.select(camera), 1000);
+    CORRADE_COMPARE(lod.screenSize(), Constants::inf());
+    CORRADE_COMPARE(lod.level(), 0);
+}
+
+void LevelOfDetailTest::selectTooSmall() {
+    Scene3D scene;
+    LevelOfDetailGroup3D group;
+
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(Matrix4::perspectiveProjection(90.0_degf, 1.0f, 0.1f, 100.0f));
+
+    Object3D object{&scene};
+    object.translate(Vector3::zAxis(-50.0f));
+    LevelOfDetail3D lod{object, &group};
+    lod.addLevel(0.5f, 1000)
+       .addLevel(0.1f, 10);
+
+    CORRADE_COMPARE(group.select(camera), 0);
+    CORRADE_COMPARE(lod.level(), 2);
+    CORRADE_COMPARE(lod.level(), lod.levelCount());
+}
+
+void LevelOfDetailTest::selectNoLevels() {
+    Scene3D scene;
+    LevelOfDetailGroup3D group;
+
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+
+    Object3D object{&scene};
+    LevelOfDetail3D lod{object, &group};
+
+    /* Shouldn't crash or do anything strange */
+    CORRADE_COMPARE(group.select(camera), 0);
+    CORRADE_COMPARE(lod.level(), 0);
+    CORRADE_COMPARE(lod.level(), lod.levelCount());
+}
+
+void LevelOfDetailTest::selectHysteresis() {
+    Scene3D scene;
+    LevelOfDetailGroup3D group;
+    group.setHysteresis(0.2f);
+    CORRADE_COMPARE(group.hysteresis(), 0.2f);
+
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(Matrix4::perspectiveProjection(90.0_degf, 1.0f, 0.1f, 100.0f));
+
+    Object3D object{&scene};
+    object.translate(Vector3::zAxis(-1.0f));
+    LevelOfDetail3D lod{object, &group};
+    lod.addLevel(0.5f, 1000)
+       .addLevel(0.0f, 10);
+
+    /* Screen size 1.0, finest level */
+    group.select(camera);
+    CORRADE_COMPARE(lod.level(), 0);
+
+    /* Screen size 0.45 is below the threshold, but not enough to switch */
+    object.setTransformation(Matrix4::translation(Vector3::zAxis(-1.0f/0.45f)));
+    group.select(camera);
+    CORRADE_COMPARE(lod.screenSize(), 0.45f);
+    CORRADE_COMPARE(lod.level(), 0);
+
+    /* Screen size 0.4 is enough */
+    object.setTransformation(Matrix4::translation(Vector3::zAxis(-2.5f)));
+    group.select(camera);
+    CORRADE_COMPARE(lod.screenSize(), 0.4f);
+    CORRADE_COMPARE(lod.level(), 1);
+
+    /* Going back up, 0.55 isn't enough to switch back */
+    object.setTransformation(Matrix4::translation(Vector3::zAxis(-1.0f/0.55f)));
+    group.select(camera);
+    CORRADE_COMPARE(lod.level(), 1);
+
+    /* But 0.65 is */
+    object.setTransformation(Matrix4::translation(Vector3::zAxis(-1.0f/0.65f)));
+    group.select(camera);
+    CORRADE_COMPARE(lod.level(), 0);
+}
+
+void LevelOfDetailTest::selectHysteresisInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    LevelOfDetailGroup3D group;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    group.setHysteresis(-0.1f);
+    group.setHysteresis(1.0f);
+    CORRADE_COMPARE(group.hysteresis(), 0.0f);
+    CORRADE_COMPARE(out.str(),
+        "SceneGraph::LevelOfDetailGroup::setHysteresis(): expected a value in range [0, 1) but got -0.1\n"
+        "SceneGraph::LevelOfDetailGroup::setHysteresis(): expected a value in range [0, 1) but got 1\n");
+}
+
+void LevelOfDetailTest::selectTriangleBudget() {
+    Scene3D scene;
+    LevelOfDetailGroup3D group;
+    group.setTriangleBudget(1200);
+    CORRADE_COMPARE(group.triangleBudget(), 1200);
+
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(Matrix4::perspectiveProjection(90.0_degf, 1.0f, 0.1f, 100.0f));
+
+    /* Screen sizes 1.0, 0.5 and 0.25, all at the finest level without a
+       budget */
+    Object3D a{&scene}, b{&scene}, c{&scene};
+    a.translate(Vector3::zAxis(-1.0f));
+    b.translate(Vector3::zAxis(-2.0f));
+    c.translate(Vector3::zAxis(-4.0f));
+    LevelOfDetail3D aLod{a, &group};
+    LevelOfDetail3D bLod{b, &group};
+    LevelOfDetail3D cLod{c, &group};
+    for(LevelOfDetail3D* lod: {&aLod, &bLod, &cLod})
+        lod->addLevel(0.1f, 1000)
+            .addLevel(0.0f, 100);
+
+    /* The smallest object gets coarsened first, then the middle one, which
+       is enough */
+    CORRADE_COMPARE(group.select(camera), 1000 + 100 + 100);
+    CORRADE_COMPARE(aLod.level(), 0);
+    CORRADE_COMPARE(bLod.level(), 1);
+    CORRADE_COMPARE(cLod.level(), 1);
+
+    /* Without the budget everything goes back to the finest level */
+    group.setTriangleBudget(0);
+    CORRADE_COMPARE(group.select(camera), 3000);
+    CORRADE_COMPARE(aLod.level(), 0);
+    CORRADE_COMPARE(bLod.level(), 0);
+    CORRADE_COMPARE(cLod.level(), 0);
+}
+
+void LevelOfDetailTest::selectTriangleBudgetUnreachable() {
+    Scene3D scene;
+    LevelOfDetailGroup3D group;
+    group.setTriangleBudget(10);
+
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(Matrix4::perspectiveProjection(90.0_degf, 1.0f, 0.1f, 100.0f));
+
+    Object3D a{&scene}, b{&scene};
+    a.translate(Vector3::zAxis(-1.0f));
+    b.translate(Vector3::zAxis(-2.0f));
+    LevelOfDetail3D aLod{a, &group};
+    LevelOfDetail3D bLod{b, &group};
+    for(LevelOfDetail3D* lod: {&aLod, &bLod})
+        lod->addLevel(0.1f, 1000)
+            .addLevel(0.05f, 100)
+            .addLevel(0.0f, 20);
+
+    /* Everything ends up at the coarsest level, but nothing gets hidden */
+    CORRADE_COMPARE(group.select(camera), 40);
+    CORRADE_COMPARE(aLod.level(), 2);
+    CORRADE_COMPARE(bLod.level(), 2);
+}
+
+void LevelOfDetailTest::selectNoScene() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Object3D cameraObject;
+    Camera3D camera{cameraObject};
+    LevelOfDetailGroup3D group;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    group.select(camera);
+    CORRADE_COMPARE(out.str(), "SceneGraph::LevelOfDetailGroup::select(): camera is not part of any scene\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::LevelOfDetailTest)
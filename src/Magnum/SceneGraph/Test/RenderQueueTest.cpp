@@ -0,0 +1,379 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/SceneGraph/MatrixTransformation2D.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/RenderQueue.hpp"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test { namespace {
+
+struct RenderQueueTest: TestSuite::Tester {
+    explicit RenderQueueTest();
+
+    void depthKey();
+
+    void build();
+    void buildTransparent();
+    void buildOrder();
+    void buildStable();
+    void build2D();
+    void payload();
+    void clear();
+    void sortMany();
+};
+
+typedef Object<MatrixTransformation2D> Object2D;
+typedef Scene<MatrixTransformation2D> Scene2D;
+typedef Object<MatrixTransformation3D> Object3D;
+typedef Scene<MatrixTransformation3D> Scene3D;
+
+RenderQueueTest::RenderQueueTest() {
+    addTests({&RenderQueueTest::depthKey,
+
+              &RenderQueueTest::build,
+              &RenderQueueTest::buildTransparent,
+              &RenderQueueTest::buildOrder,
+              &RenderQueueTest::buildStable,
+              &RenderQueueTest::build2D,
+              &RenderQueueTest::payload,
+              &RenderQueueTest::clear,
+              &RenderQueueTest::sortMany});
+}
+
+/* Records the ID and payload of each drawn entry. Adds itself to the given
+   pass with given order. */
+template<UnsignedInt dimensions> struct IdDrawable: Drawable<dimensions, Float> {
+    explicit IdDrawable(AbstractObject<dimensions, Float>& object, DrawableGroup<dimensions, Float>& group, Int id, std::vector<Int>& drawn, RenderQueuePass pass = RenderQueuePass::Opaque, UnsignedInt order = 0): Drawable<dimensions, Float>{object, &group}, id{id}, drawn(drawn), pass{pass}, order{order} {}
+
+    void enqueue(RenderQueue<dimensions, Float>& queue, const MatrixTypeFor<dimensions, Float>& transformationMatrix) override {
+        queue.add(pass, *this, transformationMatrix, order, 0);
+    }
+
+    void draw(const MatrixTypeFor<dimensions, Float>&, Camera<dimensions, Float>&) override {
+        drawn.push_back(id);
+    }
+
+    Int id;
+    std::vector<Int>& drawn;
+    RenderQueuePass pass;
+    UnsignedInt order;
+};
+
+void RenderQueueTest::depthKey() {
+    CORRADE_COMPARE_AS(Implementation::renderQueueDepthKey(-100.0f),
+        Implementation::renderQueueDepthKey(-0.5f),
+        TestSuite::Compare::Less);
+    CORRADE_COMPARE_AS(Implementation::renderQueueDepthKey(-0.5f),
+        Implementation::renderQueueDepthKey(0.0f),
+        TestSuite::Compare::Less);
+    CORRADE_COMPARE_AS(Implementation::renderQueueDepthKey(-0.0f),
+        Implementation::renderQueueDepthKey(0.0f),
+        TestSuite::Compare::LessOrEqual);
+    CORRADE_COMPARE_AS(Implementation::renderQueueDepthKey(0.0f),
+        Implementation::renderQueueDepthKey(0.5f),
+        TestSuite::Compare::Less);
+    CORRADE_COMPARE_AS(Implementation::renderQueueDepthKey(0.5f),
+        Implementation::renderQueueDepthKey(100.0f),
+        TestSuite::Compare::Less);
+}
+
+void RenderQueueTest::build() {
+    Scene3D scene;
+    DrawableGroup3D group;
+    std::vector<Int> drawn;
+
+    Object3D a{&scene};
+    a.translate(Vector3::zAxis(-10.0f));
+    new IdDrawable<3>{a, group, 0, drawn};
+
+    Object3D b{&scene};
+    b.translate(Vector3::zAxis(-1.0f));
+    new IdDrawable<3>{b, group, 1, drawn};
+
+    Object3D c{&scene};
+    c.translate(Vector3::zAxis(-5.0f));
+    new IdDrawable<3>{c, group, 2, drawn};
+
+    /* Camera is moved back, so the drawables are at depth 12, 3 and 7 */
+    Object3D cameraObject{&scene};
+    cameraObject.translate(Vector3::zAxis(2.0f));
+    Camera3D camera{cameraObject};
+
+    RenderQueue3D queue;
+    queue.build(camera, group);
+    CORRADE_COMPARE(queue.opaque().size(), 3);
+    CORRADE_COMPARE(queue.transparent().size(), 0);
+    CORRADE_COMPARE(queue.opaque()[0].transformationMatrix, Matrix4::translation(Vector3::zAxis(-3.0f)));
+    CORRADE_COMPARE(queue.opaque()[1].transformationMatrix, Matrix4::translation(Vector3::zAxis(-7.0f)));
+    CORRADE_COMPARE(queue.opaque()[2].transformationMatrix, Matrix4::translation(Vector3::zAxis(-12.0f)));
+
+    /* Front-to-back */
+    queue.draw(camera);
+    CORRADE_COMPARE_AS(drawn, (std::vector<Int>{1, 2, 0}),
+        TestSuite::Compare::Container);
+}
+
+void RenderQueueTest::buildTransparent() {
+    Scene3D scene;
+    DrawableGroup3D group;
+    std::vector<Int> drawn;
+
+    Object3D a{&scene};
+    a.translate(Vector3::zAxis(-10.0f));
+    new IdDrawable<3>{a, group, 0, drawn, RenderQueuePass::Transparent};
+
+    Object3D b{&scene};
+    b.translate(Vector3::zAxis(-1.0f));
+    new IdDrawable<3>{b, group, 1, drawn, RenderQueuePass::Transparent};
+
+    Object3D c{&scene};
+    c.translate(Vector3::zAxis(-5.0f));
+    new IdDrawable<3>{c, group, 2, drawn};
+
+    Object3D d{&scene};
+    d.translate(Vector3::zAxis(-3.0f));
+    new IdDrawable<3>{d, group, 3, drawn, RenderQueuePass::Transparent};
+
+    Object3D e{&scene};
+    e.translate(Vector3::zAxis(-20.0f));
+    new IdDrawable<3>{e, group, 4, drawn};
+
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+
+    RenderQueue3D queue;
+    queue.build(camera, group);
+    CORRADE_COMPARE(queue.opaque().size(), 2);
+    CORRADE_COMPARE(queue.transparent().size(), 3);
+
+    /* Opaque front-to-back first, then transparent back-to-front */
+    queue.draw(camera);
+    CORRADE_COMPARE_AS(drawn, (std::vector<Int>{2, 4, 0, 3, 1}),
+        TestSuite::Compare::Container);
+}
+
+void RenderQueueTest::buildOrder() {
+    Scene3D scene;
+    DrawableGroup3D group;
+    std::vector<Int> drawn;
+
+    /* The order has a priority over depth */
+    Object3D a{&scene};
+    a.translate(Vector3::zAxis(-10.0f));
+    new IdDrawable<3>{a, group, 0, drawn, RenderQueuePass::Opaque, 1};
+
+    Object3D b{&scene};
+    b.translate(Vector3::zAxis(-1.0f));
+    new IdDrawable<3>{b, group, 1, drawn, RenderQueuePass::Opaque, 2};
+
+    Object3D c{&scene};
+    c.translate(Vector3::zAxis(-5.0f));
+    new IdDrawable<3>{c, group, 2, drawn, RenderQueuePass::Opaque, 1};
+
+    Object3D d{&scene};
+    d.translate(Vector3::zAxis(-3.0f));
+    new IdDrawable<3>{d, group, 3, drawn, RenderQueuePass::Transparent, 1};
+
+    Object3D e{&scene};
+    e.translate(Vector3::zAxis(-20.0f));
+    new IdDrawable<3>{e, group, 4, drawn, RenderQueuePass::Transparent, 0};
+
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+
+    RenderQueue3D queue;
+    queue.build(camera, group)
+         .draw(camera);
+    CORRADE_COMPARE_AS(drawn, (std::vector<Int>{2, 0, 1, 4, 3}),
+        TestSuite::Compare::Container);
+}
+
+void RenderQueueTest::buildStable() {
+    Scene3D scene;
+    DrawableGroup3D group;
+    std::vector<Int> drawn;
+
+    /* All at the same depth, should be drawn in the group order */
+    Object3D a{&scene};
+    a.translate(Vector3::zAxis(-5.0f));
+    for(Int i = 0; i != 4; ++i)
+        new IdDrawable<3>{a, group, i, drawn};
+    new IdDrawable<3>{a, group, 4, drawn, RenderQueuePass::Transparent};
+    new IdDrawable<3>{a, group, 5, drawn, RenderQueuePass::Transparent};
+
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+
+    RenderQueue3D queue;
+    queue.build(camera, group)
+         .draw(camera);
+    CORRADE_COMPARE_AS(drawn, (std::vector<Int>{0, 1, 2, 3, 4, 5}),
+        TestSuite::Compare::Container);
+}
+
+void RenderQueueTest::build2D() {
+    Scene2D scene;
+    DrawableGroup2D group;
+    std::vector<Int> drawn;
+
+    /* There's no depth in 2D, so only the order and the group order matter */
+    Object2D a{&scene};
+    a.translate(Vector2::yAxis(-10.0f));
+    new IdDrawable<2>{a, group, 0, drawn, RenderQueuePass::Opaque, 1};
+
+    Object2D b{&scene};
+    b.translate(Vector2::yAxis(5.0f));
+    new IdDrawable<2>{b, group, 1, drawn, RenderQueuePass::Opaque, 0};
+
+    Object2D c{&scene};
+    c.translate(Vector2::xAxis(3.0f));
+    new IdDrawable<2>{c, group, 2, drawn, RenderQueuePass::Opaque, 1};
+
+    Object2D d{&scene};
+    new IdDrawable<2>{d, group, 3, drawn, RenderQueuePass::Opaque, 0};
+
+    Object2D cameraObject{&scene};
+    Camera2D camera{cameraObject};
+
+    RenderQueue2D queue;
+    queue.build(camera, group)
+         .draw(camera);
+    CORRADE_COMPARE_AS(drawn, (std::vector<Int>{1, 3, 0, 2}),
+        TestSuite::Compare::Container);
+}
+
+void RenderQueueTest::payload() {
+    struct MultiDrawable: Drawable3D {
+        explicit MultiDrawable(Object3D& object, DrawableGroup3D& group, std::vector<Int>& drawn): Drawable3D{object, &group}, drawn(drawn) {}
+
+        void enqueue(RenderQueue3D& queue, const Matrix4& transformationMatrix) override {
+            queue.add(RenderQueuePass::Transparent, *this, transformationMatrix, 0, 3);
+            queue.add(RenderQueuePass::Opaque, *this, transformationMatrix, 0, 7);
+            queue.add(RenderQueuePass::Opaque, *this, Matrix4::translation(Vector3::zAxis(-1.0f)), 0, 5);
+        }
+
+        void drawQueued(const Matrix4&, Camera3D&, UnsignedInt payload) override {
+            drawn.push_back(Int(payload));
+        }
+
+        /* Not called as drawQueued() is overridden */
+        void draw(const Matrix4&, Camera3D&) override {
+            drawn.push_back(-1);
+        }
+
+        std::vector<Int>& drawn;
+    };
+
+    Scene3D scene;
+    DrawableGroup3D group;
+    std::vector<Int> drawn;
+
+    Object3D a{&scene};
+    a.translate(Vector3::zAxis(-5.0f));
+    new MultiDrawable{a, group, drawn};
+
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+
+    RenderQueue3D queue;
+    queue.build(camera, group);
+    CORRADE_COMPARE(queue.opaque().size(), 2);
+    CORRADE_COMPARE(queue.opaque()[0].payload, 5);
+    CORRADE_COMPARE(queue.opaque()[1].payload, 7);
+    CORRADE_COMPARE(queue.transparent().size(), 1);
+    CORRADE_COMPARE(queue.transparent()[0].payload, 3);
+
+    queue.draw(camera);
+    CORRADE_COMPARE_AS(drawn, (std::vector<Int>{5, 7, 3}),
+        TestSuite::Compare::Container);
+}
+
+void RenderQueueTest::clear() {
+    Scene3D scene;
+    DrawableGroup3D group;
+    std::vector<Int> drawn;
+
+    Object3D a{&scene};
+    IdDrawable<3>* drawable = new IdDrawable<3>{a, group, 0, drawn};
+
+    RenderQueue3D queue;
+    queue.add(RenderQueuePass::Opaque, *drawable, {})
+         .add(RenderQueuePass::Transparent, *drawable, {});
+    CORRADE_COMPARE(queue.opaque().size(), 1);
+    CORRADE_COMPARE(queue.transparent().size(), 1);
+
+    queue.clear();
+    CORRADE_COMPARE(queue.opaque().size(), 0);
+    CORRADE_COMPARE(queue.transparent().size(), 0);
+
+    /* Building clears the previous contents as well */
+    queue.add(RenderQueuePass::Opaque, *drawable, {});
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    queue.build(camera, group);
+    CORRADE_COMPARE(queue.opaque().size(), 1);
+}
+
+void RenderQueueTest::sortMany() {
+    Scene3D scene;
+    DrawableGroup3D group;
+    std::vector<Int> drawn;
+
+    Object3D a{&scene};
+    IdDrawable<3>* drawable = new IdDrawable<3>{a, group, 0, drawn};
+
+    /* Depths and orders spread over all key bytes, both positive and
+       negative */
+    RenderQueue3D queue;
+    UnsignedInt state = 1;
+    for(std::size_t i = 0; i != 1000; ++i) {
+        state = state*1664525u + 1013904223u;
+        const Float depth = Float(Int(state >> 8) - (1 << 23))/256.0f;
+        queue.add(RenderQueuePass::Opaque, *drawable, Matrix4::translation(Vector3::zAxis(-depth)), state % 7)
+             .add(RenderQueuePass::Transparent, *drawable, Matrix4::translation(Vector3::zAxis(-depth)), state % 7);
+    }
+
+    queue.sort();
+    CORRADE_COMPARE(queue.opaque().size(), 1000);
+    CORRADE_COMPARE(queue.transparent().size(), 1000);
+    for(std::size_t i = 1; i != 1000; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE_AS(queue.opaque()[i - 1].key, queue.opaque()[i].key,
+            TestSuite::Compare::LessOrEqual);
+        CORRADE_COMPARE_AS(queue.transparent()[i - 1].key, queue.transparent()[i].key,
+            TestSuite::Compare::LessOrEqual);
+    }
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::RenderQueueTest)
@@ -0,0 +1,257 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm> /* std::sort() */
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Frustum.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Object.h"
+#include "Magnum/SceneGraph/Scene.h"
+#include "Magnum/SceneGraph/SpatialBounds.h"
+#include "Magnum/SceneGraph/SpatialIndex.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test { namespace {
+
+struct SpatialIndexTest: TestSuite::Tester {
+    explicit SpatialIndexTest();
+
+    void bounds();
+    void boundsTransformed();
+    void boundsSetBounds();
+
+    void empty();
+    void queryBox();
+    void querySphere();
+    void queryRay();
+    void queryFrustum();
+
+    void refit();
+    void addRemove();
+    void destroyFeature();
+};
+
+typedef Object<MatrixTransformation3D> Object3D;
+typedef Scene<MatrixTransformation3D> Scene3D;
+
+using namespace Math::Literals;
+
+SpatialIndexTest::SpatialIndexTest() {
+    addTests({&SpatialIndexTest::bounds,
+              &SpatialIndexTest::boundsTransformed,
+              &SpatialIndexTest::boundsSetBounds,
+
+              &SpatialIndexTest::empty,
+              &SpatialIndexTest::queryBox,
+              &SpatialIndexTest::querySphere,
+              &SpatialIndexTest::queryRay,
+              &SpatialIndexTest::queryFrustum,
+
+              &SpatialIndexTest::refit,
+              &SpatialIndexTest::addRemove,
+              &SpatialIndexTest::destroyFeature});
+}
+
+/* A row of 100 unit boxes along X, at X = 0, 10, 20, ... */
+struct Row {
+    explicit Row() {
+        for(std::size_t i = 0; i != Containers::arraySize(objects); ++i) {
+            objects[i] = new Object3D{&scene};
+            objects[i]->translate(Vector3::xAxis(Float(i)*10.0f));
+            features[i] = new SpatialBounds3D{*objects[i], Range3D::fromCenter({}, Vector3{0.5f}), &index};
+        }
+    }
+
+    std::vector<Int> ids(const std::vector<std::reference_wrapper<SpatialBounds3D>>& features) const {
+        std::vector<Int> out;
+        for(SpatialBounds3D& feature: features)
+            out.push_back(std::find(this->features, this->features + Containers::arraySize(this->features), &feature) - this->features);
+        std::sort(out.begin(), out.end());
+        return out;
+    }
+
+    /* Destructed in reverse order, so the index is gone before the scene
+       deletes the objects and the features */
+    Scene3D scene;
+    SpatialIndex3D index;
+    Object3D* objects[100];
+    SpatialBounds3D* features[100];
+};
+
+void SpatialIndexTest::bounds() {
+    Scene3D scene;
+    Object3D object{&scene};
+    object.translate({1.0f, 2.0f, 3.0f});
+
+    SpatialBounds3D feature{object, {{-1.0f, 0.0f, 0.5f}, {1.0f, 1.0f, 1.0f}}};
+    CORRADE_VERIFY(!feature.index());
+    CORRADE_COMPARE(feature.bounds(), (Range3D{{-1.0f, 0.0f, 0.5f}, {1.0f, 1.0f, 1.0f}}));
+    CORRADE_COMPARE(feature.absoluteBounds(), (Range3D{{0.0f, 2.0f, 3.5f}, {2.0f, 3.0f, 4.0f}}));
+}
+
+void SpatialIndexTest::boundsTransformed() {
+    Scene3D scene;
+    Object3D parent{&scene};
+    parent.scale(Vector3{2.0f});
+    Object3D object{&parent};
+    SpatialIndex3D index;
+    SpatialBounds3D feature{object, Range3D::fromCenter({}, {1.0f, 0.5f, 0.5f}), &index};
+    CORRADE_COMPARE(feature.index(), &index);
+
+    /* Rotated 90 degrees around Z with 2x scaling from the parent, extents
+       swap on X and Y */
+    object.rotateZ(90.0_degf)
+          .translate(Vector3::xAxis(3.0f));
+    index.update();
+    CORRADE_COMPARE(feature.absoluteBounds(), Range3D::fromCenter({6.0f, 0.0f, 0.0f}, {1.0f, 2.0f, 1.0f}));
+    CORRADE_VERIFY(!object.isDirty());
+}
+
+void SpatialIndexTest::boundsSetBounds() {
+    Scene3D scene;
+    Object3D object{&scene};
+    object.translate(Vector3::xAxis(5.0f));
+    SpatialIndex3D index;
+    SpatialBounds3D feature{object, Range3D::fromCenter({}, Vector3{1.0f}), &index};
+
+    feature.setBounds(Range3D::fromCenter({}, Vector3{2.0f}));
+    CORRADE_COMPARE(feature.bounds(), Range3D::fromCenter({}, Vector3{2.0f}));
+    CORRADE_COMPARE(feature.absoluteBounds(), Range3D::fromCenter({5.0f, 0.0f, 0.0f}, Vector3{2.0f}));
+}
+
+void SpatialIndexTest::empty() {
+    SpatialIndex3D index;
+    index.update();
+    CORRADE_COMPARE(index.nodeCount(), 0);
+    CORRADE_VERIFY(index.queryBox({Vector3{-100.0f}, Vector3{100.0f}}).empty());
+    CORRADE_VERIFY(index.querySphere({}, 100.0f).empty());
+    CORRADE_VERIFY(index.queryRay({}, Vector3::xAxis()).empty());
+    CORRADE_VERIFY(index.queryFrustum(Frustum{}).empty());
+}
+
+void SpatialIndexTest::queryBox() {
+    Row row;
+    CORRADE_COMPARE_AS(row.ids(row.index.queryBox({{9.0f, -1.0f, -1.0f}, {31.0f, 1.0f, 1.0f}})),
+        (std::vector<Int>{1, 2, 3}),
+        TestSuite::Compare::Container);
+
+    /* 100 items with 4 per leaf need at least 25 leaves */
+    CORRADE_COMPARE_AS(row.index.nodeCount(), 2*25 - 1,
+        TestSuite::Compare::GreaterOrEqual);
+
+    CORRADE_VERIFY(row.index.queryBox({{1.0f, -1.0f, -1.0f}, {9.0f, 1.0f, 1.0f}}).empty());
+}
+
+void SpatialIndexTest::querySphere() {
+    Row row;
+    CORRADE_COMPARE_AS(row.ids(row.index.querySphere({500.0f, 0.0f, 0.0f}, 10.0f)),
+        (std::vector<Int>{49, 50, 51}),
+        TestSuite::Compare::Container);
+
+    /* Closest box corners are at a distance of sqrt(3*4.5^2), so slightly
+       more than the radius */
+    CORRADE_VERIFY(row.index.querySphere({5.0f, 5.0f, 5.0f}, 7.7f).empty());
+}
+
+void SpatialIndexTest::queryRay() {
+    Row row;
+
+    /* Along the row hits everything */
+    CORRADE_COMPARE(row.index.queryRay({-10.0f, 0.0f, 0.0f}, Vector3::xAxis()).size(), 100);
+
+    /* Perpendicular to the row hits just one */
+    CORRADE_COMPARE_AS(row.ids(row.index.queryRay({700.2f, 10.0f, 0.0f}, -Vector3::yAxis())),
+        (std::vector<Int>{70}),
+        TestSuite::Compare::Container);
+
+    CORRADE_VERIFY(row.index.queryRay({705.0f, 10.0f, 0.0f}, -Vector3::yAxis()).empty());
+}
+
+void SpatialIndexTest::queryFrustum() {
+    Row row;
+
+    /* Orthographic box around X = 195 to 305 */
+    const Matrix4 projection = Matrix4::orthographicProjection({110.0f, 10.0f}, -10.0f, 10.0f);
+    const Matrix4 camera = Matrix4::translation(Vector3::xAxis(250.0f)).inverted();
+    CORRADE_COMPARE_AS(row.ids(row.index.queryFrustum(Frustum::fromMatrix(projection*camera))),
+        (std::vector<Int>{20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30}),
+        TestSuite::Compare::Container);
+}
+
+void SpatialIndexTest::refit() {
+    Row row;
+    row.index.update();
+    const std::size_t nodeCount = row.index.nodeCount();
+    CORRADE_VERIFY(row.index.queryBox(Range3D::fromCenter({0.0f, 100.0f, 0.0f}, Vector3{1.0f})).empty());
+
+    /* Moving an object refits the hierarchy, keeping its topology */
+    row.objects[42]->translate(Vector3::yAxis(100.0f));
+    CORRADE_COMPARE_AS(row.ids(row.index.queryBox(Range3D::fromCenter({420.0f, 100.0f, 0.0f}, Vector3{1.0f}))),
+        (std::vector<Int>{42}),
+        TestSuite::Compare::Container);
+    CORRADE_VERIFY(row.index.queryBox(Range3D::fromCenter({420.0f, 0.0f, 0.0f}, Vector3{1.0f})).empty());
+    CORRADE_COMPARE(row.index.nodeCount(), nodeCount);
+
+    /* Moving a parent moves children as well */
+    Object3D* child = new Object3D{row.objects[0]};
+    child->translate(Vector3::zAxis(3.0f));
+    SpatialBounds3D childFeature{*child, Range3D::fromCenter({}, Vector3{0.5f}), &row.index};
+    row.objects[0]->translate(Vector3::yAxis(-50.0f));
+    CORRADE_COMPARE(row.index.queryBox(Range3D::fromCenter({0.0f, -50.0f, 3.0f}, Vector3{1.0f})).size(), 1);
+}
+
+void SpatialIndexTest::addRemove() {
+    Row row;
+    CORRADE_COMPARE(row.index.queryBox(Range3D::fromCenter({100.0f, 0.0f, 0.0f}, Vector3{1.0f})).size(), 1);
+
+    row.index.remove(*row.features[10]);
+    CORRADE_VERIFY(!row.features[10]->index());
+    CORRADE_VERIFY(row.index.queryBox(Range3D::fromCenter({100.0f, 0.0f, 0.0f}, Vector3{1.0f})).empty());
+
+    row.index.add(*row.features[10]);
+    CORRADE_COMPARE(row.features[10]->index(), &row.index);
+    CORRADE_COMPARE_AS(row.ids(row.index.queryBox(Range3D::fromCenter({100.0f, 0.0f, 0.0f}, Vector3{1.0f}))),
+        (std::vector<Int>{10}),
+        TestSuite::Compare::Container);
+}
+
+void SpatialIndexTest::destroyFeature() {
+    Row row;
+    CORRADE_COMPARE(row.index.queryBox(Range3D::fromCenter({100.0f, 0.0f, 0.0f}, Vector3{1.0f})).size(), 1);
+
+    delete row.objects[10];
+    row.objects[10] = nullptr;
+    row.features[10] = nullptr;
+    CORRADE_COMPARE(row.index.size(), 99);
+    CORRADE_VERIFY(row.index.queryBox(Range3D::fromCenter({100.0f, 0.0f, 0.0f}, Vector3{1.0f})).empty());
+    CORRADE_COMPARE(row.index.queryBox({{-1.0f, -1.0f, -1.0f}, {1000.0f, 1.0f, 1.0f}}).size(), 99);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::SpatialIndexTest)
@@ -0,0 +1,315 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Object.h"
+#include "Magnum/SceneGraph/Scene.h"
+#include "Magnum/SceneGraph/TransformationCache.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test { namespace {
+
+struct TransformationCacheTest: TestSuite::Tester {
+    explicit TransformationCacheTest();
+
+    void construct();
+    void constructEmpty();
+    void constructMove();
+
+    void update();
+    void updateNotDirty();
+    void updateParentDirty();
+    void rebuild();
+    void subtree();
+    void updateThreaded();
+
+    void invalidIndex();
+};
+
+typedef Object<MatrixTransformation3D> Object3D;
+typedef Scene<MatrixTransformation3D> Scene3D;
+
+using namespace Math::Literals;
+
+const struct {
+    const char* name;
+    UnsignedInt threadCount;
+} ThreadData[]{
+    {"single thread", 1},
+    {"four threads", 4},
+    {"all threads", 0},
+};
+
+TransformationCacheTest::TransformationCacheTest() {
+    addTests({&TransformationCacheTest::construct,
+              &TransformationCacheTest::constructEmpty,
+              &TransformationCacheTest::constructMove,
+
+              &TransformationCacheTest::update,
+              &TransformationCacheTest::updateNotDirty,
+              &TransformationCacheTest::updateParentDirty,
+              &TransformationCacheTest::rebuild,
+              &TransformationCacheTest::subtree,
+
+              &TransformationCacheTest::invalidIndex});
+
+    addInstancedTests({&TransformationCacheTest::updateThreaded},
+        Containers::arraySize(ThreadData));
+}
+
+void TransformationCacheTest::construct() {
+    Scene3D scene;
+    Object3D a{&scene};
+    a.translate(Vector3::xAxis(1.0f));
+    Object3D b{&scene};
+    b.translate(Vector3::yAxis(2.0f));
+    Object3D c{&a};
+    c.scale(Vector3{3.0f});
+    Object3D d{&c};
+    d.translate(Vector3::zAxis(4.0f));
+    Object3D e{&b};
+    e.rotateX(90.0_degf);
+
+    TransformationCache<MatrixTransformation3D> cache{scene};
+    CORRADE_COMPARE(&cache.root(), &scene);
+    CORRADE_COMPARE(cache.size(), 5);
+
+    /* Breadth-first, parents always before children */
+    CORRADE_COMPARE_AS(cache.objects(), Containers::arrayView<Object3D*>({
+        &a, &b, &c, &e, &d
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(cache.parents(), Containers::arrayView<Int>({
+        -1, -1, 0, 1, 2
+    }), TestSuite::Compare::Container);
+
+    for(std::size_t i = 0; i != cache.size(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_VERIFY(!cache.isDirty(i));
+        CORRADE_COMPARE(cache.transformations()[i], cache.objects()[i]->transformationMatrix());
+        CORRADE_COMPARE(cache.absoluteTransformations()[i], cache.objects()[i]->absoluteTransformationMatrix());
+    }
+}
+
+void TransformationCacheTest::constructEmpty() {
+    Scene3D scene;
+
+    TransformationCache<MatrixTransformation3D> cache{scene};
+    CORRADE_COMPARE(cache.size(), 0);
+    CORRADE_VERIFY(cache.objects().isEmpty());
+    CORRADE_VERIFY(cache.parents().isEmpty());
+    CORRADE_VERIFY(cache.transformations().isEmpty());
+    CORRADE_VERIFY(cache.absoluteTransformations().isEmpty());
+
+    /* Shouldn't crash or anything */
+    cache.update();
+    CORRADE_COMPARE(cache.size(), 0);
+}
+
+void TransformationCacheTest::constructMove() {
+    Scene3D scene;
+    Object3D a{&scene};
+    a.translate(Vector3::xAxis(1.0f));
+
+    TransformationCache<MatrixTransformation3D> cache{scene};
+    TransformationCache<MatrixTransformation3D> b{std::move(cache)};
+    CORRADE_COMPARE(&b.root(), &scene);
+    CORRADE_COMPARE(b.size(), 1);
+    CORRADE_COMPARE(b.absoluteTransformations()[0], Matrix4::translation(Vector3::xAxis(1.0f)));
+
+    Scene3D anotherScene;
+    TransformationCache<MatrixTransformation3D> c{anotherScene};
+    c = std::move(b);
+    CORRADE_COMPARE(&c.root(), &scene);
+    CORRADE_COMPARE(c.size(), 1);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<TransformationCache<MatrixTransformation3D>>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<TransformationCache<MatrixTransformation3D>>::value);
+}
+
+void TransformationCacheTest::update() {
+    Scene3D scene;
+    Object3D a{&scene};
+    a.translate(Vector3::xAxis(1.0f));
+    Object3D b{&a};
+    b.translate(Vector3::yAxis(2.0f));
+
+    TransformationCache<MatrixTransformation3D> cache{scene};
+    CORRADE_COMPARE(cache.absoluteTransformations()[1], Matrix4::translation({1.0f, 2.0f, 0.0f}));
+
+    b.translate(Vector3::zAxis(3.0f));
+    cache.setDirty(1);
+    CORRADE_VERIFY(!cache.isDirty(0));
+    CORRADE_VERIFY(cache.isDirty(1));
+
+    cache.update();
+    CORRADE_VERIFY(!cache.isDirty(1));
+    CORRADE_COMPARE(cache.transformations()[1], Matrix4::translation({0.0f, 2.0f, 3.0f}));
+    CORRADE_COMPARE(cache.absoluteTransformations()[0], Matrix4::translation({1.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(cache.absoluteTransformations()[1], Matrix4::translation({1.0f, 2.0f, 3.0f}));
+}
+
+void TransformationCacheTest::updateNotDirty() {
+    Scene3D scene;
+    Object3D a{&scene};
+    a.translate(Vector3::xAxis(1.0f));
+
+    TransformationCache<MatrixTransformation3D> cache{scene};
+
+    /* The change isn't picked up without marking the object dirty */
+    a.translate(Vector3::xAxis(1.0f));
+    cache.update();
+    CORRADE_COMPARE(cache.absoluteTransformations()[0], Matrix4::translation(Vector3::xAxis(1.0f)));
+
+    cache.setDirty()
+         .update();
+    CORRADE_COMPARE(cache.absoluteTransformations()[0], Matrix4::translation(Vector3::xAxis(2.0f)));
+}
+
+void TransformationCacheTest::updateParentDirty() {
+    Scene3D scene;
+    Object3D a{&scene};
+    a.translate(Vector3::xAxis(1.0f));
+    Object3D b{&a};
+    b.translate(Vector3::yAxis(2.0f));
+    Object3D c{&b};
+    c.scale(Vector3{2.0f});
+    Object3D d{&scene};
+    d.translate(Vector3::zAxis(5.0f));
+
+    TransformationCache<MatrixTransformation3D> cache{scene};
+
+    /* Changing the topmost parent updates all its children but not the
+       unrelated object */
+    a.translate(Vector3::xAxis(1.0f));
+    d.translate(Vector3::zAxis(5.0f));
+    cache.setDirty(0)
+         .update();
+    CORRADE_COMPARE_AS(cache.objects(), Containers::arrayView<Object3D*>({
+        &a, &d, &b, &c
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(cache.absoluteTransformations()[0], a.absoluteTransformationMatrix());
+    CORRADE_COMPARE(cache.absoluteTransformations()[1], Matrix4::translation(Vector3::zAxis(5.0f)));
+    CORRADE_COMPARE(cache.absoluteTransformations()[2], b.absoluteTransformationMatrix());
+    CORRADE_COMPARE(cache.absoluteTransformations()[3], c.absoluteTransformationMatrix());
+}
+
+void TransformationCacheTest::rebuild() {
+    Scene3D scene;
+    Object3D a{&scene};
+    a.translate(Vector3::xAxis(1.0f));
+    Object3D b{&scene};
+    b.translate(Vector3::yAxis(2.0f));
+
+    TransformationCache<MatrixTransformation3D> cache{scene};
+    CORRADE_COMPARE(cache.size(), 2);
+
+    b.setParent(&a);
+    Object3D c{&b};
+    cache.rebuild();
+    CORRADE_COMPARE_AS(cache.objects(), Containers::arrayView<Object3D*>({
+        &a, &b, &c
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(cache.parents(), Containers::arrayView<Int>({
+        -1, 0, 1
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(cache.absoluteTransformations()[2], Matrix4::translation({1.0f, 2.0f, 0.0f}));
+}
+
+void TransformationCacheTest::subtree() {
+    Scene3D scene;
+    Object3D a{&scene};
+    a.translate(Vector3::xAxis(1.0f));
+    Object3D b{&a};
+    b.translate(Vector3::yAxis(2.0f));
+
+    /* Absolute transformations are relative to the root, which itself isn't
+       included */
+    TransformationCache<MatrixTransformation3D> cache{a};
+    CORRADE_COMPARE(cache.size(), 1);
+    CORRADE_COMPARE(cache.objects()[0], &b);
+    CORRADE_COMPARE(cache.parents()[0], -1);
+    CORRADE_COMPARE(cache.absoluteTransformations()[0], Matrix4::translation(Vector3::yAxis(2.0f)));
+}
+
+void TransformationCacheTest::updateThreaded() {
+    auto&& data = ThreadData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Wide enough levels to be split among the threads, with the first
+       level being a single object so the rest depends on it */
+    Scene3D scene;
+    Object3D root{&scene};
+    root.translate(Vector3::xAxis(1.0f));
+    for(std::size_t i = 0; i != 5003; ++i) {
+        Object3D* child = new Object3D{&root};
+        child->translate(Vector3::yAxis(Float(i)));
+        (new Object3D{child})->rotateZ(90.0_degf);
+    }
+
+    TransformationCache<MatrixTransformation3D> cache{scene};
+    CORRADE_COMPARE(cache.size(), 1 + 5003*2);
+
+    /* Mark a few objects dirty in each level, both the root and some
+       individual leaves */
+    root.translate(Vector3::zAxis(2.0f));
+    cache.setDirty(0);
+    cache.objects()[5004 + 17]->scale(Vector3{3.0f});
+    cache.setDirty(5004 + 17);
+    cache.objects()[10006]->scale(Vector3{2.0f});
+    cache.setDirty(10006);
+
+    cache.update(data.threadCount);
+    for(std::size_t i = 0; i != cache.size(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_VERIFY(!cache.isDirty(i));
+        CORRADE_COMPARE(cache.absoluteTransformations()[i], cache.objects()[i]->absoluteTransformationMatrix());
+    }
+}
+
+void TransformationCacheTest::invalidIndex() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Scene3D scene;
+    Object3D a{&scene};
+    Object3D b{&scene};
+
+    TransformationCache<MatrixTransformation3D> cache{scene};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    cache.isDirty(2);
+    cache.setDirty(2);
+    CORRADE_COMPARE(out.str(),
+        "SceneGraph::TransformationCache::isDirty(): index 2 out of range for 2 objects\n"
+        "SceneGraph::TransformationCache::setDirty(): index 2 out of range for 2 objects\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::TransformationCacheTest)
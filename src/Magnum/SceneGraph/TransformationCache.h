@@ -0,0 +1,230 @@
+#ifndef Magnum_SceneGraph_TransformationCache_h
+#define Magnum_SceneGraph_TransformationCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::TransformationCache
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/BitArray.h>
+
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/SceneGraph/SceneGraph.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Flat transformation cache
+@m_since_latest
+
+Stores an object hierarchy in a data-oriented layout --- an array of objects
+in a breadth-first order, where each parent is before all its children, an
+array of parent indices, contiguous arrays of local and absolute
+transformation matrices and a dirty bitset. Compared to
+@ref Object::absoluteTransformationMatrix() or
+@ref Object::transformationMatrices(), which walk the linked object tree and
+allocate on every call, @ref update() recalculates absolute transformations
+of all dirty objects in a single linear pass without any allocations.
+
+@snippet MagnumSceneGraph.cpp TransformationCache-usage
+
+The cache doesn't get notified about changes in the hierarchy. After an
+object transformation is changed, mark the object with @ref setDirty(), which
+causes its local transformation to be fetched again and the absolute
+transformation of the object and all its children to be recalculated in the
+next @ref update(). Objects are identified by their position in
+@ref objects(). When objects are added, removed or reparented, call
+@ref rebuild().
+
+@section SceneGraph-TransformationCache-explicit-specializations Explicit template specializations
+
+The following specializations are explicitly compiled into @ref SceneGraph
+library. For other specializations (e.g. using @ref Magnum::Double "Double"
+type) you have to use @ref TransformationCache.hpp implementation file to
+avoid linker errors. See also @ref compilation-speedup-hpp for more
+information.
+
+-   @ref TransformationCache "TransformationCache<T>" for all
+    transformations listed in @ref SceneGraph-Object-explicit-specializations "Object"
+
+@see @ref scenegraph, @ref SceneTools::flattenTransformationHierarchy3D()
+*/
+template<class Transformation> class TransformationCache {
+    public:
+        /** @brief Transformation matrix type */
+        typedef MatrixTypeFor<Transformation::Dimensions, typename Transformation::Type> MatrixType;
+
+        /**
+         * @brief Constructor
+         * @param root      Root of the hierarchy, usually a @ref Scene
+         *
+         * Calls @ref rebuild(). The @p root is expected to stay alive for the
+         * whole cache lifetime.
+         */
+        explicit TransformationCache(Object<Transformation>& root);
+
+        /** @brief Copying is not allowed */
+        TransformationCache(const TransformationCache<Transformation>&) = delete;
+
+        /** @brief Move constructor */
+        TransformationCache(TransformationCache<Transformation>&&) noexcept;
+
+        ~TransformationCache();
+
+        /** @brief Copying is not allowed */
+        TransformationCache<Transformation>& operator=(const TransformationCache<Transformation>&) = delete;
+
+        /** @brief Move assignment */
+        TransformationCache<Transformation>& operator=(TransformationCache<Transformation>&&) noexcept;
+
+        /** @brief Root of the hierarchy */
+        Object<Transformation>& root() { return *_root; }
+        const Object<Transformation>& root() const { return *_root; } /**< @overload */
+
+        /**
+         * @brief Object count
+         *
+         * Count of all descendants of @ref root(), the root itself is not
+         * included.
+         */
+        std::size_t size() const { return _objects.size(); }
+
+        /**
+         * @brief Objects
+         *
+         * In a breadth-first order, so each parent is before all its
+         * children and objects of the same depth are next to each other.
+         * Size of the view is @ref size().
+         */
+        Containers::ArrayView<Object<Transformation>* const> objects() const { return _objects; }
+
+        /**
+         * @brief Parent indices
+         *
+         * Index of the parent in @ref objects() for each object, @cpp -1 @ce
+         * for direct children of @ref root(). Size of the view is
+         * @ref size().
+         */
+        Containers::ArrayView<const Int> parents() const { return _parents; }
+
+        /**
+         * @brief Local transformations
+         *
+         * Transformation of each object relative to its parent, as fetched
+         * in the last @ref update(). Size of the view is @ref size().
+         */
+        Containers::ArrayView<const MatrixType> transformations() const { return _transformations; }
+
+        /**
+         * @brief Absolute transformations
+         *
+         * Transformation of each object relative to @ref root(), as
+         * calculated in the last @ref update(). Size of the view is
+         * @ref size().
+         */
+        Containers::ArrayView<const MatrixType> absoluteTransformations() const { return _absoluteTransformations; }
+
+        /**
+         * @brief Whether an object is dirty
+         *
+         * Expects that @p id is less than @ref size().
+         * @see @ref setDirty()
+         */
+        bool isDirty(std::size_t id) const;
+
+        /**
+         * @brief Mark an object as dirty
+         * @return Reference to self (for method chaining)
+         *
+         * Local transformation of the object gets fetched again in the next
+         * @ref update() and the absolute transformation of the object and all
+         * its children recalculated. Expects that @p id is less than
+         * @ref size().
+         */
+        TransformationCache<Transformation>& setDirty(std::size_t id);
+
+        /**
+         * @brief Mark all objects as dirty
+         * @return Reference to self (for method chaining)
+         */
+        TransformationCache<Transformation>& setDirty();
+
+        /**
+         * @brief Update absolute transformations
+         * @param threadCount   Max count of threads to use. If @cpp 0 @ce,
+         *      @ref TaskScheduler::threadCount() of
+         *      @ref TaskScheduler::global() is used.
+         *
+         * Fetches local transformations of all objects marked with
+         * @ref setDirty() and recalculates absolute transformations of them
+         * and all their children in a single linear pass. Clears the dirty
+         * bits afterwards. Doesn't allocate.
+         *
+         * The objects are grouped by their depth in the hierarchy and objects
+         * of the same depth don't depend on each other. If @p threadCount is
+         * larger than @cpp 1 @ce, each depth level that's large enough is
+         * split among tasks submitted to @ref TaskScheduler::global(), with
+         * the levels processed one after another. Narrow and deep hierarchies
+         * thus don't benefit from multiple threads. The
+         * @ref Object::transformationMatrix() is called from the worker
+         * threads, which is safe as long as the hierarchy isn't modified
+         * during the update.
+         */
+        void update(UnsignedInt threadCount = 1);
+
+        /**
+         * @brief Rebuild the hierarchy
+         *
+         * Walks the hierarchy under @ref root() again to pick up added,
+         * removed or reparented objects, fetches all local transformations
+         * and recalculates all absolute transformations. Called implicitly
+         * from the constructor.
+         */
+        void rebuild();
+
+    private:
+        void MAGNUM_SCENEGRAPH_LOCAL updateRange(std::size_t begin, std::size_t end);
+
+        Object<Transformation>* _root;
+        Containers::Array<Object<Transformation>*> _objects;
+        Containers::Array<Int> _parents;
+        /* Offsets of each depth level in _objects, with the last item being
+           the object count */
+        Containers::Array<UnsignedInt> _levelOffsets;
+        Containers::Array<MatrixType> _transformations;
+        Containers::Array<MatrixType> _absoluteTransformations;
+        Containers::BitArray _dirty;
+        /* Dirty state propagated from parents during update(), a byte per
+           object so it can be written from multiple threads */
+        Containers::Array<bool> _propagatedDirty;
+};
+
+}}
+
+#endif
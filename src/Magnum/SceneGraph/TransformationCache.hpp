@@ -0,0 +1,152 @@
+#ifndef Magnum_SceneGraph_TransformationCache_hpp
+#define Magnum_SceneGraph_TransformationCache_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref TransformationCache.h
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/GrowableArray.h>
+
+#include "Magnum/TaskScheduler.h"
+#include "Magnum/SceneGraph/Object.h"
+#include "Magnum/SceneGraph/TransformationCache.h"
+
+namespace Magnum { namespace SceneGraph {
+
+template<class Transformation> TransformationCache<Transformation>::TransformationCache(Object<Transformation>& root): _root{&root} {
+    rebuild();
+}
+
+template<class Transformation> TransformationCache<Transformation>::TransformationCache(TransformationCache<Transformation>&&) noexcept = default;
+
+template<class Transformation> TransformationCache<Transformation>::~TransformationCache() = default;
+
+template<class Transformation> TransformationCache<Transformation>& TransformationCache<Transformation>::operator=(TransformationCache<Transformation>&&) noexcept = default;
+
+template<class Transformation> bool TransformationCache<Transformation>::isDirty(const std::size_t id) const {
+    CORRADE_ASSERT(id < _objects.size(),
+        "SceneGraph::TransformationCache::isDirty(): index" << id << "out of range for" << _objects.size() << "objects", {});
+    return _dirty[id];
+}
+
+template<class Transformation> TransformationCache<Transformation>& TransformationCache<Transformation>::setDirty(const std::size_t id) {
+    CORRADE_ASSERT(id < _objects.size(),
+        "SceneGraph::TransformationCache::setDirty(): index" << id << "out of range for" << _objects.size() << "objects", *this);
+    _dirty.set(id);
+    return *this;
+}
+
+template<class Transformation> TransformationCache<Transformation>& TransformationCache<Transformation>::setDirty() {
+    _dirty.setAll();
+    return *this;
+}
+
+namespace Implementation {
+    /* Depth levels smaller than this are processed on the calling thread
+       only, as the cost of submitting the tasks would outweigh the gains */
+    enum: std::size_t { TransformationCacheParallelLevelThreshold = 4096 };
+}
+
+template<class Transformation> void TransformationCache<Transformation>::updateRange(const std::size_t begin, const std::size_t end) {
+    /* The objects are in a topological order so a parent is always updated
+       before its children. A dirty parent makes all its children dirty as
+       well, but their local transformations stay the same. The dirty bits
+       are only read here and the propagated state is written to a byte per
+       object, as neighboring bits could be modified by another thread. */
+    for(std::size_t i = begin; i != end; ++i) {
+        const bool dirty = _dirty[i];
+        if(dirty)
+            _transformations[i] = _objects[i]->transformationMatrix();
+
+        const Int parent = _parents[i];
+        if(parent == -1) {
+            _propagatedDirty[i] = dirty;
+            if(dirty)
+                _absoluteTransformations[i] = _transformations[i];
+        } else if(dirty || _propagatedDirty[parent]) {
+            _propagatedDirty[i] = true;
+            _absoluteTransformations[i] = _absoluteTransformations[parent]*_transformations[i];
+        } else _propagatedDirty[i] = false;
+    }
+}
+
+template<class Transformation> void TransformationCache<Transformation>::update(const UnsignedInt threadCount) {
+    if(threadCount != 1 && _objects.size() >= Implementation::TransformationCacheParallelLevelThreshold) {
+        /* Objects in a single level don't depend on each other, so each
+           large enough level is split among tasks on the global scheduler */
+        for(std::size_t level = 0; level + 1 < _levelOffsets.size(); ++level) {
+            const std::size_t begin = _levelOffsets[level];
+            const std::size_t end = _levelOffsets[level + 1];
+            if(end - begin < Implementation::TransformationCacheParallelLevelThreshold) {
+                updateRange(begin, end);
+                continue;
+            }
+
+            TaskScheduler::global().parallelFor(end - begin, threadCount, [this, begin](const std::size_t chunkBegin, const std::size_t chunkEnd) {
+                updateRange(begin + chunkBegin, begin + chunkEnd);
+            });
+        }
+    } else updateRange(0, _objects.size());
+
+    _dirty.resetAll();
+}
+
+template<class Transformation> void TransformationCache<Transformation>::rebuild() {
+    /* Breadth-first traversal, with the object array itself used as the
+       queue. The resulting order is topological, with objects of the same
+       depth being next to each other. */
+    arrayResize(_objects, NoInit, 0);
+    arrayResize(_parents, NoInit, 0);
+    arrayResize(_levelOffsets, NoInit, 0);
+    arrayAppend(_levelOffsets, 0u);
+    for(Object<Transformation>* child = _root->children().first(); child; child = child->nextSibling()) {
+        arrayAppend(_objects, child);
+        arrayAppend(_parents, -1);
+    }
+    for(std::size_t levelBegin = 0; levelBegin != _objects.size(); ) {
+        const std::size_t levelEnd = _objects.size();
+        arrayAppend(_levelOffsets, UnsignedInt(levelEnd));
+        for(std::size_t i = levelBegin; i != levelEnd; ++i) {
+            for(Object<Transformation>* child = _objects[i]->children().first(); child; child = child->nextSibling()) {
+                arrayAppend(_objects, child);
+                arrayAppend(_parents, Int(i));
+            }
+        }
+        levelBegin = levelEnd;
+    }
+
+    _transformations = Containers::Array<MatrixType>{NoInit, _objects.size()};
+    _absoluteTransformations = Containers::Array<MatrixType>{NoInit, _objects.size()};
+    _dirty = Containers::BitArray{DirectInit, _objects.size(), true};
+    _propagatedDirty = Containers::Array<bool>{NoInit, _objects.size()};
+    update();
+}
+
+}}
+
+#endif
@@ -30,11 +30,15 @@
 #include "Magnum/SceneGraph/DualComplexTransformation.h"
 #include "Magnum/SceneGraph/DualQuaternionTransformation.h"
 #include "Magnum/SceneGraph/FeatureGroup.hpp"
+#include "Magnum/SceneGraph/LevelOfDetail.hpp"
 #include "Magnum/SceneGraph/MatrixTransformation2D.hpp"
 #include "Magnum/SceneGraph/MatrixTransformation3D.hpp"
 #include "Magnum/SceneGraph/Object.hpp"
+#include "Magnum/SceneGraph/RenderQueue.hpp"
 #include "Magnum/SceneGraph/RigidMatrixTransformation2D.hpp"
 #include "Magnum/SceneGraph/RigidMatrixTransformation3D.hpp"
+#include "Magnum/SceneGraph/SpatialIndex.hpp"
+#include "Magnum/SceneGraph/TransformationCache.hpp"
 #include "Magnum/SceneGraph/TranslationTransformation.h"
 #include "Magnum/SceneGraph/TranslationRotationScalingTransformation2D.h"
 #include "Magnum/SceneGraph/TranslationRotationScalingTransformation3D.h"
@@ -72,6 +76,17 @@ template class MAGNUM_SCENEGRAPH_EXPORT_HPP Camera<3, Float>;
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP Drawable<2, Float>;
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP Drawable<3, Float>;
 
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP LevelOfDetail<2, Float>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP LevelOfDetail<3, Float>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP LevelOfDetailGroup<2, Float>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP LevelOfDetailGroup<3, Float>;
+
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP RenderQueue<2, Float>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP RenderQueue<3, Float>;
+
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP BasicSpatialBounds3D<Float>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP BasicSpatialIndex3D<Float>;
+
 /* These have rotation(const Complex&) and rotation(const Quaternion&) defined
    in a hpp to avoid dragging in Complex / Quaternion for every user */
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP BasicMatrixTransformation2D<Float>;
@@ -89,6 +104,17 @@ template class MAGNUM_SCENEGRAPH_EXPORT_HPP Object<BasicTranslationRotationScali
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP Object<BasicTranslationRotationScalingTransformation3D<Float>>;
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP Object<TranslationTransformation<2, Float>>;
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP Object<TranslationTransformation<3, Float>>;
+
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP TransformationCache<BasicDualComplexTransformation<Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP TransformationCache<BasicDualQuaternionTransformation<Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP TransformationCache<BasicMatrixTransformation2D<Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP TransformationCache<BasicMatrixTransformation3D<Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP TransformationCache<BasicRigidMatrixTransformation2D<Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP TransformationCache<BasicRigidMatrixTransformation3D<Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP TransformationCache<BasicTranslationRotationScalingTransformation2D<Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP TransformationCache<BasicTranslationRotationScalingTransformation3D<Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP TransformationCache<TranslationTransformation<2, Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP TransformationCache<TranslationTransformation<3, Float>>;
 #endif
 
 }}
@@ -0,0 +1,98 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "BindAnimation.h"
+
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Animation/Player.h"
+#include "Magnum/Math/Complex.h"
+#include "Magnum/Math/CubicHermite.h"
+#include "Magnum/Math/Quaternion.h"
+#include "Magnum/Trade/AnimationData.h"
+
+namespace Magnum { namespace SceneTools {
+
+namespace {
+
+/* Adds the track to the player if it's of type V or CubicV with a result type
+   R, returns false otherwise */
+template<class T, class V, class CubicV, class R> bool bindTrack(const char* const function, const char* const name, Animation::Player<T, Float>& player, const Trade::AnimationData& animation, const UnsignedInt id, const Containers::StridedArrayView1D<R>& destination) {
+    if(destination.isEmpty() || animation.trackResultType(id) != Trade::Implementation::animationTypeFor<R>())
+        return false;
+
+    const Trade::AnimationTrackType type = animation.trackType(id);
+    if(type != Trade::Implementation::animationTypeFor<V>() &&
+       type != Trade::Implementation::animationTypeFor<CubicV>())
+        return false;
+
+    const UnsignedLong target = animation.trackTarget(id);
+    CORRADE_ASSERT(target < destination.size(),
+        "SceneTools::" << Debug::nospace << function << Debug::nospace << "(): track" << id << "targets object" << target << "but only" << destination.size() << name << "were passed", {});
+
+    if(type == Trade::Implementation::animationTypeFor<V>())
+        player.add(animation.track<V, R>(id), destination[target]);
+    else
+        player.add(animation.track<CubicV, R>(id), destination[target]);
+    return true;
+}
+
+template<class T, class VectorType, class RotationType, class CubicVectorType, class CubicRotationType> std::size_t bindAnimation(const char* const function, const Trade::AnimationTrackTargetType translationTarget, const Trade::AnimationTrackTargetType rotationTarget, const Trade::AnimationTrackTargetType scalingTarget, Animation::Player<T, Float>& player, const Trade::AnimationData& animation, const Containers::StridedArrayView1D<VectorType>& translations, const Containers::StridedArrayView1D<RotationType>& rotations, const Containers::StridedArrayView1D<VectorType>& scalings) {
+    std::size_t count = 0;
+    for(UnsignedInt i = 0, max = animation.trackCount(); i != max; ++i) {
+        const Trade::AnimationTrackTargetType targetType = animation.trackTargetType(i);
+        bool bound = false;
+        if(targetType == translationTarget)
+            bound = bindTrack<T, VectorType, CubicVectorType>(function, "translations", player, animation, i, translations);
+        else if(targetType == rotationTarget)
+            bound = bindTrack<T, RotationType, CubicRotationType>(function, "rotations", player, animation, i, rotations);
+        else if(targetType == scalingTarget)
+            bound = bindTrack<T, VectorType, CubicVectorType>(function, "scalings", player, animation, i, scalings);
+        if(bound) ++count;
+    }
+
+    return count;
+}
+
+}
+
+std::size_t bindAnimation3D(Animation::Player<Float, Float>& player, const Trade::AnimationData& animation, const Containers::StridedArrayView1D<Vector3>& translations, const Containers::StridedArrayView1D<Quaternion>& rotations, const Containers::StridedArrayView1D<Vector3>& scalings) {
+    return bindAnimation<Float, Vector3, Quaternion, CubicHermite3D, CubicHermiteQuaternion>("bindAnimation3D", Trade::AnimationTrackTargetType::Translation3D, Trade::AnimationTrackTargetType::Rotation3D, Trade::AnimationTrackTargetType::Scaling3D, player, animation, translations, rotations, scalings);
+}
+
+std::size_t bindAnimation3D(Animation::Player<std::chrono::nanoseconds, Float>& player, const Trade::AnimationData& animation, const Containers::StridedArrayView1D<Vector3>& translations, const Containers::StridedArrayView1D<Quaternion>& rotations, const Containers::StridedArrayView1D<Vector3>& scalings) {
+    return bindAnimation<std::chrono::nanoseconds, Vector3, Quaternion, CubicHermite3D, CubicHermiteQuaternion>("bindAnimation3D", Trade::AnimationTrackTargetType::Translation3D, Trade::AnimationTrackTargetType::Rotation3D, Trade::AnimationTrackTargetType::Scaling3D, player, animation, translations, rotations, scalings);
+}
+
+std::size_t bindAnimation2D(Animation::Player<Float, Float>& player, const Trade::AnimationData& animation, const Containers::StridedArrayView1D<Vector2>& translations, const Containers::StridedArrayView1D<Complex>& rotations, const Containers::StridedArrayView1D<Vector2>& scalings) {
+    return bindAnimation<Float, Vector2, Complex, CubicHermite2D, CubicHermiteComplex>("bindAnimation2D", Trade::AnimationTrackTargetType::Translation2D, Trade::AnimationTrackTargetType::Rotation2D, Trade::AnimationTrackTargetType::Scaling2D, player, animation, translations, rotations, scalings);
+}
+
+std::size_t bindAnimation2D(Animation::Player<std::chrono::nanoseconds, Float>& player, const Trade::AnimationData& animation, const Containers::StridedArrayView1D<Vector2>& translations, const Containers::StridedArrayView1D<Complex>& rotations, const Containers::StridedArrayView1D<Vector2>& scalings) {
+    return bindAnimation<std::chrono::nanoseconds, Vector2, Complex, CubicHermite2D, CubicHermiteComplex>("bindAnimation2D", Trade::AnimationTrackTargetType::Translation2D, Trade::AnimationTrackTargetType::Rotation2D, Trade::AnimationTrackTargetType::Scaling2D, player, animation, translations, rotations, scalings);
+}
+
+}}
@@ -0,0 +1,127 @@
+#ifndef Magnum_SceneTools_BindAnimation_h
+#define Magnum_SceneTools_BindAnimation_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::SceneTools::bindAnimation2D(), @ref Magnum::SceneTools::bindAnimation3D()
+ * @m_since_latest
+ */
+
+#include <chrono>
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Animation/Animation.h"
+#include "Magnum/SceneTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace SceneTools {
+
+/**
+@brief Bind 3D animation tracks to per-object transformation arrays
+@param player           Player to add the tracks to
+@param animation        Animation to bind
+@param translations     Translation for each object
+@param rotations        Rotation for each object
+@param scalings         Scaling for each object
+@return Count of tracks added to @p player
+@m_since_latest
+
+Goes through all tracks in @p animation and adds each
+@ref Trade::AnimationTrackTargetType::Translation3D,
+@relativeref{Trade::AnimationTrackTargetType,Rotation3D} and
+@relativeref{Trade::AnimationTrackTargetType,Scaling3D} track to @p player
+with the destination being the item of @p translations, @p rotations or
+@p scalings at index given by @ref Trade::AnimationData::trackTarget(). The
+views are thus usually sized to @ref Trade::SceneData::mappingBound() of the
+scene the animation belongs to:
+
+@snippet MagnumSceneTools.cpp bindAnimation3D
+
+Translation and scaling tracks are expected to be either
+@ref Trade::AnimationTrackType::Vector3 or
+@relativeref{Trade::AnimationTrackType,CubicHermite3D} with a
+@relativeref{Trade::AnimationTrackType,Vector3} result, rotation tracks either
+@relativeref{Trade::AnimationTrackType,Quaternion} or
+@relativeref{Trade::AnimationTrackType,CubicHermiteQuaternion} with a
+@relativeref{Trade::AnimationTrackType,Quaternion} result. Tracks of other
+types or targets, as well as tracks of a kind for which an empty view was
+passed, are skipped. For the remaining tracks the
+@ref Trade::AnimationData::trackTarget() is expected to be less than size of
+the corresponding view.
+
+The interpolator is taken from each track and no callbacks are involved, so
+the only allocation is the amortized growth of the track list inside
+@p player. The track data are referenced, not copied, so @p animation is
+expected to stay in scope for as long as @p player is used.
+
+@experimental
+
+@see @ref bindAnimation2D(), @ref Animation::Player::add()
+*/
+MAGNUM_SCENETOOLS_EXPORT std::size_t bindAnimation3D(Animation::Player<Float, Float>& player, const Trade::AnimationData& animation, const Containers::StridedArrayView1D<Vector3>& translations, const Containers::StridedArrayView1D<Quaternion>& rotations, const Containers::StridedArrayView1D<Vector3>& scalings);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_SCENETOOLS_EXPORT std::size_t bindAnimation3D(Animation::Player<std::chrono::nanoseconds, Float>& player, const Trade::AnimationData& animation, const Containers::StridedArrayView1D<Vector3>& translations, const Containers::StridedArrayView1D<Quaternion>& rotations, const Containers::StridedArrayView1D<Vector3>& scalings);
+
+/**
+@brief Bind 2D animation tracks to per-object transformation arrays
+@param player           Player to add the tracks to
+@param animation        Animation to bind
+@param translations     Translation for each object
+@param rotations        Rotation for each object
+@param scalings         Scaling for each object
+@return Count of tracks added to @p player
+@m_since_latest
+
+Like @ref bindAnimation3D(), but binds
+@ref Trade::AnimationTrackTargetType::Translation2D,
+@relativeref{Trade::AnimationTrackTargetType,Rotation2D} and
+@relativeref{Trade::AnimationTrackTargetType,Scaling2D} tracks instead.
+Translation and scaling tracks are expected to be either
+@ref Trade::AnimationTrackType::Vector2 or
+@relativeref{Trade::AnimationTrackType,CubicHermite2D} with a
+@relativeref{Trade::AnimationTrackType,Vector2} result, rotation tracks either
+@relativeref{Trade::AnimationTrackType,Complex} or
+@relativeref{Trade::AnimationTrackType,CubicHermiteComplex} with a
+@relativeref{Trade::AnimationTrackType,Complex} result.
+
+@experimental
+*/
+MAGNUM_SCENETOOLS_EXPORT std::size_t bindAnimation2D(Animation::Player<Float, Float>& player, const Trade::AnimationData& animation, const Containers::StridedArrayView1D<Vector2>& translations, const Containers::StridedArrayView1D<Complex>& rotations, const Containers::StridedArrayView1D<Vector2>& scalings);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_SCENETOOLS_EXPORT std::size_t bindAnimation2D(Animation::Player<std::chrono::nanoseconds, Float>& player, const Trade::AnimationData& animation, const Containers::StridedArrayView1D<Vector2>& translations, const Containers::StridedArrayView1D<Complex>& rotations, const Containers::StridedArrayView1D<Vector2>& scalings);
+
+}}
+
+#endif
@@ -0,0 +1,135 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "CompressAnimation.h"
+
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Math/Packing.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Animation/Quantization.h"
+
+namespace Magnum { namespace SceneTools {
+
+namespace {
+
+Float error(const Vector3& a, const Vector3& b) {
+    return (a - b).length();
+}
+
+Float error(const Quaternion& a, const Quaternion& b) {
+    /* Angle of the rotation between the two, q and -q being the same */
+    return 2.0f*std::acos(Math::min(Math::abs(Math::dot(a, b)), 1.0f));
+}
+
+Vector3 interpolate(const Vector3& a, const Vector3& b, Float t) {
+    return Math::lerp(a, b, t);
+}
+
+Quaternion interpolate(const Quaternion& a, const Quaternion& b, Float t) {
+    return Math::slerp(a, b, t);
+}
+
+template<class T> Containers::Array<UnsignedInt> reduceKeyframesImplementation(const Containers::StridedArrayView1D<const Float>& keys, const Containers::StridedArrayView1D<const T>& values, const Float maxError) {
+    CORRADE_ASSERT(keys.size() == values.size(),
+        "SceneTools::reduceKeyframes(): expected" << keys.size() << "values but got" << values.size(), {});
+    CORRADE_ASSERT(maxError >= 0.0f,
+        "SceneTools::reduceKeyframes(): expected a non-negative error but got" << maxError, {});
+
+    Containers::Array<UnsignedInt> out;
+    if(keys.isEmpty()) return out;
+
+    /* First keyframe is always kept */
+    arrayAppend(out, 0u);
+
+    /* Returns true if all keyframes between a and b can be reconstructed by
+       interpolating a and b */
+    auto fits = [&](const std::size_t a, const std::size_t b) {
+        for(std::size_t i = a + 1; i < b; ++i) {
+            const Float t = Math::lerpInverted(keys[a], keys[b], keys[i]);
+            if(error(interpolate(values[a], values[b], t), values[i]) > maxError)
+                return false;
+        }
+        return true;
+    };
+
+    /* Extend each segment as far as possible and then start a new one from
+       its end */
+    std::size_t a = 0;
+    while(a + 1 < keys.size()) {
+        std::size_t b = a + 1;
+        while(b + 1 < keys.size() && fits(a, b + 1))
+            ++b;
+        arrayAppend(out, UnsignedInt(b));
+        a = b;
+    }
+
+    /* Convert back to a default deleter to make the array usable in plugins */
+    arrayShrink(out, DefaultInit);
+    return out;
+}
+
+}
+
+Containers::Array<UnsignedInt> reduceKeyframes(const Containers::StridedArrayView1D<const Float>& keys, const Containers::StridedArrayView1D<const Vector3>& values, const Float maxError) {
+    return reduceKeyframesImplementation(keys, values, maxError);
+}
+
+Containers::Array<UnsignedInt> reduceKeyframes(const Containers::StridedArrayView1D<const Float>& keys, const Containers::StridedArrayView1D<const Quaternion>& values, const Rad maxError) {
+    return reduceKeyframesImplementation(keys, values, Float(maxError));
+}
+
+Range3D quantizeRangeInto(const Containers::StridedArrayView1D<const Vector3>& values, const Containers::StridedArrayView1D<Vector3us>& destination) {
+    CORRADE_ASSERT(destination.size() == values.size(),
+        "SceneTools::quantizeRangeInto(): expected destination view with" << values.size() << "elements but got" << destination.size(), {});
+
+    if(values.isEmpty()) return {};
+
+    Range3D range{values[0], values[0]};
+    for(const Vector3& value: values)
+        range = Math::join(range, Range3D{value, value});
+
+    /* Avoid a division by zero for dimensions where all values are the
+       same. These get quantized to zero. */
+    const Vector3 size = range.size();
+    const Vector3 scale{size.x() ? 1.0f/size.x() : 0.0f,
+                        size.y() ? 1.0f/size.y() : 0.0f,
+                        size.z() ? 1.0f/size.z() : 0.0f};
+    for(std::size_t i = 0; i != values.size(); ++i)
+        destination[i] = Math::pack<Vector3us>((values[i] - range.min())*scale);
+
+    return range;
+}
+
+void packQuaternionSmallestThreeInto(const Containers::StridedArrayView1D<const Quaternion>& values, const Containers::StridedArrayView1D<UnsignedInt>& destination) {
+    CORRADE_ASSERT(destination.size() == values.size(),
+        "SceneTools::packQuaternionSmallestThreeInto(): expected destination view with" << values.size() << "elements but got" << destination.size(), );
+
+    for(std::size_t i = 0; i != values.size(); ++i)
+        destination[i] = Animation::packQuaternionSmallestThree(values[i]);
+}
+
+}}
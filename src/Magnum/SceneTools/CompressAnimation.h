@@ -0,0 +1,115 @@
+#ifndef Magnum_SceneTools_CompressAnimation_h
+#define Magnum_SceneTools_CompressAnimation_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::SceneTools::reduceKeyframes(), @ref Magnum::SceneTools::quantizeRangeInto(), @ref Magnum::SceneTools::packQuaternionSmallestThreeInto()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/SceneTools/visibility.h"
+
+namespace Magnum { namespace SceneTools {
+
+/**
+@brief Reduce keyframes of a linearly interpolated 3D vector track
+@param keys         Track keys
+@param values       Track values
+@param maxError     Max allowed distance between the original and
+    reconstructed value
+@m_since_latest
+
+Returns indices of keyframes that need to be kept in order for a
+@ref Math::lerp() interpolation of the reduced track to differ from
+@p values by at most @p maxError at all original keyframes. The first and last
+keyframe is always kept. The keyframes are processed greedily, extending
+each linear segment as far as the error allows, which is
+@f$ \mathcal{O}(n m^2) @f$ with @f$ m @f$ being the longest removed keyframe
+span. Meant to be used offline, for example when preparing a mocap library
+for use in an application. Use the returned indices to copy the kept
+keys and values to a new track. Expects that @p keys and @p values have the
+same size and @p maxError is not negative.
+
+Suitable for translation and scaling tracks. Together with
+@ref quantizeRangeInto() and
+@ref Animation::packQuaternionSmallestThree() the memory use of a typical
+skeletal animation can be reduced by an order of magnitude.
+@see @ref reduceKeyframes(const Containers::StridedArrayView1D<const Float>&, const Containers::StridedArrayView1D<const Quaternion>&, Rad)
+*/
+MAGNUM_SCENETOOLS_EXPORT Containers::Array<UnsignedInt> reduceKeyframes(const Containers::StridedArrayView1D<const Float>& keys, const Containers::StridedArrayView1D<const Vector3>& values, Float maxError);
+
+/**
+@brief Reduce keyframes of a spherically interpolated rotation track
+@param keys         Track keys
+@param values       Track values
+@param maxError     Max allowed angle between the original and
+    reconstructed rotation
+@m_since_latest
+
+Like @ref reduceKeyframes(const Containers::StridedArrayView1D<const Float>&, const Containers::StridedArrayView1D<const Vector3>&, Float),
+but the values are reconstructed with @ref Math::slerp() and the error is the
+angle of the rotation between the original and reconstructed value. Expects
+that the quaternions are normalized.
+*/
+MAGNUM_SCENETOOLS_EXPORT Containers::Array<UnsignedInt> reduceKeyframes(const Containers::StridedArrayView1D<const Float>& keys, const Containers::StridedArrayView1D<const Quaternion>& values, Rad maxError);
+
+/**
+@brief Quantize 3D vectors to a range
+@param values       Values to quantize
+@param destination  Where to put the quantized values
+@return Range of the original values
+@m_since_latest
+
+Calculates the range of @p values and stores each value relative to it as a
+normalized 16-bit integer, which for translation tracks gives a much better
+precision than a @ref Half "half-float" at the same size. Expects that
+@p destination has the same size as @p values. The original values can be
+reconstructed by unpacking the result and interpolating between the range
+bounds:
+
+@snippet MagnumSceneTools.cpp quantizeRangeInto
+
+The quantized values can be used directly in an @ref Animation::TrackView
+with an interpolator created using @ref Animation::unpack(), with the range
+applied to the interpolated result afterwards.
+*/
+MAGNUM_SCENETOOLS_EXPORT Range3D quantizeRangeInto(const Containers::StridedArrayView1D<const Vector3>& values, const Containers::StridedArrayView1D<Vector3us>& destination);
+
+/**
+@brief Pack quaternions using the smallest-three encoding
+@m_since_latest
+
+Calls @ref Animation::packQuaternionSmallestThree() on all @p values, putting
+the result into @p destination. Expects that both views have the same size.
+*/
+MAGNUM_SCENETOOLS_EXPORT void packQuaternionSmallestThreeInto(const Containers::StridedArrayView1D<const Quaternion>& values, const Containers::StridedArrayView1D<UnsignedInt>& destination);
+
+}}
+
+#endif
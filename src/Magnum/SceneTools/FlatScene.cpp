@@ -0,0 +1,208 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FlatScene.h"
+
+#include <Corrade/Containers/BitArrayView.h>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+
+#include "Magnum/Math/Frustum.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Intersection.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/SceneTools/OrderClusterParents.h"
+#include "Magnum/Trade/SceneData.h"
+
+namespace Magnum { namespace SceneTools {
+
+FlatScene3D::FlatScene3D(const Trade::SceneData& scene) {
+    CORRADE_ASSERT(scene.is3D(),
+        "SceneTools::FlatScene3D: the scene is not 3D", );
+    CORRADE_ASSERT(scene.hasField(Trade::SceneField::Parent),
+        "SceneTools::FlatScene3D: the scene has no hierarchy", );
+
+    const std::size_t objectCount = scene.mappingBound();
+
+    /* Hierarchy, ordered for update() and indexed by object ID for
+       parents() */
+    _orderedParents = orderClusterParents(scene);
+    _parents = Containers::Array<Int>{DirectInit, objectCount, -2};
+    for(const Containers::Pair<UnsignedInt, Int>& parent: _orderedParents) {
+        CORRADE_INTERNAL_ASSERT(parent.first() < objectCount);
+        _parents[parent.first()] = parent.second();
+    }
+
+    /* Local transformations indexed by object ID, identity for objects that
+       have none */
+    _localTransformations = Containers::Array<Matrix4>{ValueInit, objectCount};
+    {
+        Containers::Array<Containers::Pair<UnsignedInt, Matrix4>> transformations{NoInit, scene.transformationFieldSize()};
+        scene.transformations3DInto(
+            stridedArrayView(transformations).slice(&decltype(transformations)::Type::first),
+            stridedArrayView(transformations).slice(&decltype(transformations)::Type::second));
+        for(const Containers::Pair<UnsignedInt, Matrix4>& transformation: transformations) {
+            CORRADE_INTERNAL_ASSERT(transformation.first() < objectCount);
+            _localTransformations[transformation.first()] = transformation.second();
+        }
+    }
+
+    _absoluteTransformations = Containers::Array<Matrix4>{NoInit, objectCount};
+    update();
+
+    /* Draws, if there are any */
+    if(!scene.hasField(Trade::SceneField::Mesh)) return;
+    const std::size_t drawCount = scene.fieldSize(Trade::SceneField::Mesh);
+    _drawObjects = Containers::Array<UnsignedInt>{NoInit, drawCount};
+    _drawMeshes = Containers::Array<UnsignedInt>{NoInit, drawCount};
+    _drawMaterials = Containers::Array<Int>{NoInit, drawCount};
+    scene.meshesMaterialsInto(_drawObjects, _drawMeshes, _drawMaterials);
+
+    /* Order the draws by mesh ID with a counting sort, which keeps the
+       original order for draws of the same mesh */
+    UnsignedInt meshBound = 0;
+    for(const UnsignedInt mesh: _drawMeshes)
+        meshBound = Math::max(meshBound, mesh + 1);
+    Containers::Array<UnsignedInt> meshOffsets{ValueInit, std::size_t(meshBound) + 1};
+    for(const UnsignedInt mesh: _drawMeshes)
+        ++meshOffsets[mesh + 1];
+    for(std::size_t i = 1; i < meshOffsets.size(); ++i)
+        meshOffsets[i] += meshOffsets[i - 1];
+    _meshOrderedDraws = Containers::Array<UnsignedInt>{NoInit, drawCount};
+    for(std::size_t i = 0; i != drawCount; ++i)
+        _meshOrderedDraws[meshOffsets[_drawMeshes[i]]++] = i;
+}
+
+FlatScene3D::FlatScene3D(FlatScene3D&&) noexcept = default;
+
+FlatScene3D::~FlatScene3D() = default;
+
+FlatScene3D& FlatScene3D::operator=(FlatScene3D&&) noexcept = default;
+
+std::size_t FlatScene3D::objectCount() const {
+    return _parents.size();
+}
+
+Containers::ArrayView<const Int> FlatScene3D::parents() const {
+    return _parents;
+}
+
+Containers::ArrayView<Matrix4> FlatScene3D::localTransformations() {
+    return _localTransformations;
+}
+
+Containers::ArrayView<const Matrix4> FlatScene3D::localTransformations() const {
+    return _localTransformations;
+}
+
+Containers::ArrayView<const Matrix4> FlatScene3D::absoluteTransformations() const {
+    return _absoluteTransformations;
+}
+
+FlatScene3D& FlatScene3D::update(const Matrix4& globalTransformation) {
+    /* Objects that aren't a part of the hierarchy get their local
+       transformation, the rest gets overwritten below */
+    Utility::copy(_localTransformations, _absoluteTransformations);
+
+    /* The parents are ordered so a parent always gets its absolute
+       transformation before its children */
+    for(const Containers::Pair<UnsignedInt, Int>& parent: _orderedParents) {
+        _absoluteTransformations[parent.first()] =
+            (parent.second() == -1 ? globalTransformation : _absoluteTransformations[parent.second()])*
+            _localTransformations[parent.first()];
+    }
+
+    return *this;
+}
+
+FlatScene3D& FlatScene3D::update() {
+    return update(Matrix4{});
+}
+
+std::size_t FlatScene3D::drawCount() const {
+    return _drawObjects.size();
+}
+
+Containers::ArrayView<const UnsignedInt> FlatScene3D::drawObjects() const {
+    return _drawObjects;
+}
+
+Containers::ArrayView<const UnsignedInt> FlatScene3D::drawMeshes() const {
+    return _drawMeshes;
+}
+
+Containers::ArrayView<const Int> FlatScene3D::drawMaterials() const {
+    return _drawMaterials;
+}
+
+std::size_t FlatScene3D::cull(const Matrix4& projectionMatrix, const Containers::StridedArrayView1D<const Range3D>& meshBounds, const Containers::MutableBitArrayView visible) const {
+    CORRADE_ASSERT(visible.size() == _drawObjects.size(),
+        "SceneTools::FlatScene3D::cull(): expected" << _drawObjects.size() << "visibility bits but got" << visible.size(), {});
+
+    const Frustum frustum = Frustum::fromMatrix(projectionMatrix);
+    std::size_t count = 0;
+    for(std::size_t i = 0; i != _drawObjects.size(); ++i) {
+        const UnsignedInt mesh = _drawMeshes[i];
+        CORRADE_ASSERT(mesh < meshBounds.size(),
+            "SceneTools::FlatScene3D::cull(): mesh" << mesh << "out of bounds for" << meshBounds.size() << "mesh bounds", {});
+
+        /* Transform the box center and enlarge the half-size so the box
+           stays axis-aligned after rotation */
+        const Matrix4& transformation = _absoluteTransformations[_drawObjects[i]];
+        const Range3D& bounds = meshBounds[mesh];
+        const Vector3 halfSize = bounds.size()*0.5f;
+        const Matrix3x3 rotationScaling = transformation.rotationScaling();
+        const Vector3 extents =
+            Math::abs(rotationScaling[0])*halfSize.x() +
+            Math::abs(rotationScaling[1])*halfSize.y() +
+            Math::abs(rotationScaling[2])*halfSize.z();
+        const bool inside = Math::Intersection::aabbFrustum(transformation.transformPoint(bounds.center()), extents, frustum);
+        if(inside) {
+            visible.set(i);
+            ++count;
+        } else visible.reset(i);
+    }
+
+    return count;
+}
+
+std::size_t FlatScene3D::drawListInto(const Containers::BitArrayView visible, const Containers::ArrayView<UnsignedInt>& drawList) const {
+    CORRADE_ASSERT(visible.size() == _drawObjects.size(),
+        "SceneTools::FlatScene3D::drawListInto(): expected" << _drawObjects.size() << "visibility bits but got" << visible.size(), {});
+
+    std::size_t count = 0;
+    for(const UnsignedInt draw: _meshOrderedDraws) {
+        if(!visible[draw]) continue;
+        CORRADE_ASSERT(count < drawList.size(),
+            "SceneTools::FlatScene3D::drawListInto(): draw list with" << drawList.size() << "items too small for all visible draws", {});
+        drawList[count++] = draw;
+    }
+
+    return count;
+}
+
+}}
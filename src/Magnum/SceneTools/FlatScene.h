@@ -0,0 +1,242 @@
+#ifndef Magnum_SceneTools_FlatScene_h
+#define Magnum_SceneTools_FlatScene_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneTools::FlatScene3D
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/SceneTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace SceneTools {
+
+/**
+@brief Flat runtime 3D scene
+@m_since_latest
+
+A compact runtime representation of a @ref Trade::SceneData hierarchy with
+meshes attached, as an alternative to instantiating a
+@ref SceneGraph::Object for each node. All data are stored in flat arrays
+indexed by object ID or by draw ID, without any per-object allocations or
+virtual calls:
+
+-   @ref parents(), @ref localTransformations() and
+    @ref absoluteTransformations() have @ref objectCount() items, which is
+    equal to @ref Trade::SceneData::mappingBound()
+-   @ref drawObjects(), @ref drawMeshes() and @ref drawMaterials() have
+    @ref drawCount() items, one for each @ref Trade::SceneField::Mesh entry
+
+@snippet MagnumSceneTools.cpp FlatScene3D-usage
+
+@section SceneTools-FlatScene3D-update Updating transformations
+
+The local transformations can be modified directly through the mutable
+@ref localTransformations() view, after which @ref update() recalculates all
+absolute transformations in a single linear pass over the hierarchy, which is
+ordered so a parent is always processed before its children. Objects that
+aren't a part of the hierarchy get their local transformation, consistently
+with @ref flattenTransformationHierarchy3DInto().
+
+@section SceneTools-FlatScene3D-culling Culling and drawing
+
+Given a bounding box for each mesh, @ref cull() marks draws that are at least
+partially inside a frustum. The visibility can be then passed to
+@ref drawListInto(), which produces a list of visible draws ordered by the
+mesh ID, so consecutive draws of the same mesh can be batched together.
+
+@experimental
+*/
+class MAGNUM_SCENETOOLS_EXPORT FlatScene3D {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * The @ref Trade::SceneField::Parent field is expected to be
+         * contained in the scene, having no cycles or duplicates, and the
+         * scene is expected to be 3D. If @ref Trade::SceneField::Mesh is not
+         * present, the scene has no draws. The absolute transformations are
+         * calculated with an identity global transformation.
+         *
+         * The operation is done in an @f$ \mathcal{O}(m + n) @f$ execution
+         * time and memory complexity, with @f$ m @f$ being size of the
+         * @ref Trade::SceneField::Mesh field and @f$ n @f$ being
+         * @ref Trade::SceneData::mappingBound(). The @p scene isn't
+         * referenced after the constructor exits.
+         */
+        explicit FlatScene3D(const Trade::SceneData& scene);
+
+        /** @brief Copying is not allowed */
+        FlatScene3D(const FlatScene3D&) = delete;
+
+        /** @brief Move constructor */
+        FlatScene3D(FlatScene3D&&) noexcept;
+
+        ~FlatScene3D();
+
+        /** @brief Copying is not allowed */
+        FlatScene3D& operator=(const FlatScene3D&) = delete;
+
+        /** @brief Move assignment */
+        FlatScene3D& operator=(FlatScene3D&&) noexcept;
+
+        /**
+         * @brief Object count
+         *
+         * Equal to @ref Trade::SceneData::mappingBound() of the original
+         * scene.
+         */
+        std::size_t objectCount() const;
+
+        /**
+         * @brief Object parents
+         *
+         * Indexed by object ID. Top-level objects have @cpp -1 @ce, objects
+         * that aren't a part of the hierarchy @cpp -2 @ce.
+         */
+        Containers::ArrayView<const Int> parents() const;
+
+        /**
+         * @brief Local object transformations
+         *
+         * Indexed by object ID. Objects without a transformation in the
+         * original scene have an identity. After modifying the
+         * transformations, call @ref update() to recalculate
+         * @ref absoluteTransformations().
+         */
+        Containers::ArrayView<Matrix4> localTransformations();
+        Containers::ArrayView<const Matrix4> localTransformations() const; /**< @overload */
+
+        /**
+         * @brief Absolute object transformations
+         *
+         * Indexed by object ID. Up-to-date after @ref update().
+         */
+        Containers::ArrayView<const Matrix4> absoluteTransformations() const;
+
+        /**
+         * @brief Update absolute transformations
+         * @return Reference to self (for method chaining)
+         *
+         * Recalculates @ref absoluteTransformations() from
+         * @ref localTransformations() with @p globalTransformation prepended
+         * to all top-level objects. Done in an @f$ \mathcal{O}(n) @f$
+         * execution time, with @f$ n @f$ being @ref objectCount(), without
+         * any allocations.
+         */
+        FlatScene3D& update(const Matrix4& globalTransformation);
+
+        /**
+         * @brief Update absolute transformations
+         * @return Reference to self (for method chaining)
+         *
+         * Same as above with the global transformation set to an identity
+         * matrix.
+         */
+        FlatScene3D& update();
+
+        /**
+         * @brief Draw count
+         *
+         * Equal to size of the @ref Trade::SceneField::Mesh field in the
+         * original scene.
+         */
+        std::size_t drawCount() const;
+
+        /** @brief Object ID for each draw */
+        Containers::ArrayView<const UnsignedInt> drawObjects() const;
+
+        /** @brief Mesh ID for each draw */
+        Containers::ArrayView<const UnsignedInt> drawMeshes() const;
+
+        /**
+         * @brief Material ID for each draw
+         *
+         * If the original scene has no @ref Trade::SceneField::MeshMaterial
+         * field or the draw has no material assigned, the value is
+         * @cpp -1 @ce.
+         */
+        Containers::ArrayView<const Int> drawMaterials() const;
+
+        /**
+         * @brief Cull draws against a frustum
+         * @param[in]  projectionMatrix  Projection matrix, including the
+         *      camera transformation
+         * @param[in]  meshBounds        Bounding box of each mesh, indexed
+         *      by mesh ID
+         * @param[out] visible           Where to put visibility of each draw
+         * @return Count of visible draws
+         *
+         * Transforms the bounding box of the mesh referenced by each draw
+         * with @ref absoluteTransformations() of the draw object and checks
+         * it against the frustum extracted from @p projectionMatrix with
+         * @ref Math::Frustum::fromMatrix(). The test is conservative --- a
+         * draw may be marked as visible even though it's not, but a visible
+         * draw is never marked as invisible. Expects that @p meshBounds
+         * contains all meshes referenced by @ref drawMeshes() and that
+         * @p visible has a size of @ref drawCount().
+         */
+        std::size_t cull(const Matrix4& projectionMatrix, const Containers::StridedArrayView1D<const Range3D>& meshBounds, Containers::MutableBitArrayView visible) const;
+
+        /**
+         * @brief Create a list of visible draws
+         * @param[in]  visible   Visibility of each draw, usually an output
+         *      of @ref cull()
+         * @param[out] drawList  Where to put IDs of the visible draws
+         * @return Count of visible draws written to the @p drawList prefix
+         *
+         * The draw IDs are ordered by their mesh ID, keeping the original
+         * order for draws of the same mesh, so consecutive draws of the same
+         * mesh can be batched together. Expects that @p visible has a size of
+         * @ref drawCount() and @p drawList is large enough to contain all
+         * visible draws. The order is calculated upfront in the constructor,
+         * so this is done in an @f$ \mathcal{O}(n) @f$ execution time, with
+         * @f$ n @f$ being @ref drawCount(), without any allocations.
+         */
+        std::size_t drawListInto(Containers::BitArrayView visible, const Containers::ArrayView<UnsignedInt>& drawList) const;
+
+    private:
+        /* Object ID and its parent, ordered so a parent is always before its
+           children */
+        Containers::Array<Containers::Pair<UnsignedInt, Int>> _orderedParents;
+        Containers::Array<Int> _parents;
+        Containers::Array<Matrix4> _localTransformations;
+        Containers::Array<Matrix4> _absoluteTransformations;
+        Containers::Array<UnsignedInt> _drawObjects;
+        Containers::Array<UnsignedInt> _drawMeshes;
+        Containers::Array<Int> _drawMaterials;
+        /* Draw IDs ordered by mesh ID, calculated in the constructor so
+           drawListInto() only needs to filter it */
+        Containers::Array<UnsignedInt> _meshOrderedDraws;
+};
+
+}}
+
+#endif
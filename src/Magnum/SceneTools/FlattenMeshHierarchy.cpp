@@ -30,9 +30,13 @@
 #include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Containers/Triple.h>
+#include <Corrade/Utility/Algorithms.h>
 
 #include "Magnum/DimensionTraits.h"
+#include "Magnum/TaskScheduler.h"
+#include "Magnum/Implementation/parallelFor.h"
 #include "Magnum/Math/Matrix3.h"
 #include "Magnum/Math/Matrix4.h"
 #include "Magnum/Trade/SceneData.h"
@@ -50,6 +54,9 @@ template<> struct SceneDataDimensionTraits<2> {
     static void transformationsInto(const Trade::SceneData& scene, const Containers::StridedArrayView1D<UnsignedInt>& mappingDestination, const Containers::StridedArrayView1D<Matrix3>& transformationDestination) {
         return scene.transformations2DInto(mappingDestination, transformationDestination);
     }
+    static void transformationsInto(const Trade::SceneData& scene, const std::size_t offset, const Containers::StridedArrayView1D<Matrix3>& transformationDestination) {
+        scene.transformations2DInto(offset, nullptr, transformationDestination);
+    }
 };
 template<> struct SceneDataDimensionTraits<3> {
     static bool isDimensions(const Trade::SceneData& scene) {
@@ -58,56 +65,237 @@ template<> struct SceneDataDimensionTraits<3> {
     static void transformationsInto(const Trade::SceneData& scene, const Containers::StridedArrayView1D<UnsignedInt>& mappingDestination, const Containers::StridedArrayView1D<Matrix4>& transformationDestination) {
         return scene.transformations3DInto(mappingDestination, transformationDestination);
     }
+    static void transformationsInto(const Trade::SceneData& scene, const std::size_t offset, const Containers::StridedArrayView1D<Matrix4>& transformationDestination) {
+        scene.transformations3DInto(offset, nullptr, transformationDestination);
+    }
 };
 
-template<UnsignedInt dimensions>
-Containers::Array<Containers::Triple<UnsignedInt, Int, MatrixTypeFor<dimensions, Float>>> flattenMeshHierarchyImplementation(const Trade::SceneData& scene, const MatrixTypeFor<dimensions, Float>& globalTransformation) {
-    CORRADE_ASSERT(SceneDataDimensionTraits<dimensions>::isDimensions(scene),
-        "SceneTools::flattenMeshHierarchy(): the scene is not" << dimensions << Debug::nospace << "D", {});
-    const Containers::Optional<UnsignedInt> parentFieldId = scene.findFieldId(Trade::SceneField::Parent);
-    CORRADE_ASSERT(parentFieldId,
-        "SceneTools::flattenMeshHierarchy(): the scene has no hierarchy", {});
-
-    /* If there's no mesh field in the file, nothing to do. Another case is
-       that there is a mesh field but it's empty, then for simplicity we still
-       go through everything. */
-    if(!scene.hasField(Trade::SceneField::Mesh)) return {};
+/* Depth levels smaller than this are processed on the calling thread only,
+   as the cost of submitting the tasks would outweigh the gains */
+constexpr std::size_t ParallelLevelThreshold = 4096;
 
+/* The scene is assumed to have the right dimension count and a parent field,
+   the destination is assumed to have the right size, checked by the
+   callers */
+template<UnsignedInt dimensions> void flattenTransformationHierarchyIntoImplementation(const Trade::SceneData& scene, const UnsignedInt parentFieldId, const Containers::StridedArrayView1D<MatrixTypeFor<dimensions, Float>>& transformations, const MatrixTypeFor<dimensions, Float>& globalTransformation, UnsignedInt threadCount) {
     /* Allocate a single storage for all temporary data */
     Containers::ArrayView<Containers::Pair<UnsignedInt, Int>> orderedClusteredParents;
-    Containers::ArrayView<Containers::Pair<UnsignedInt, MatrixTypeFor<dimensions, Float>>> transformations;
-    Containers::ArrayView<MatrixTypeFor<dimensions, Float>> absoluteTransformations;
+    Containers::ArrayView<Containers::Pair<UnsignedInt, MatrixTypeFor<dimensions, Float>>> localTransformations;
     Containers::ArrayTuple storage{
         /* Output of orderClusterParentsInto() */
-        {NoInit, scene.fieldSize(*parentFieldId), orderedClusteredParents},
+        {NoInit, scene.fieldSize(parentFieldId), orderedClusteredParents},
         /* Output of scene.transformationsXDInto() */
-        {NoInit, scene.transformationFieldSize(), transformations},
-        /* Above transformations but indexed by object ID */
-        {ValueInit, std::size_t(scene.mappingBound() + 1), absoluteTransformations}
+        {NoInit, scene.transformationFieldSize(), localTransformations}
     };
     orderClusterParentsInto(scene,
         stridedArrayView(orderedClusteredParents).slice(&decltype(orderedClusteredParents)::Type::first),
         stridedArrayView(orderedClusteredParents).slice(&decltype(orderedClusteredParents)::Type::second));
     SceneDataDimensionTraits<dimensions>::transformationsInto(scene,
-        stridedArrayView(transformations).slice(&decltype(transformations)::Type::first),
-        stridedArrayView(transformations).slice(&decltype(transformations)::Type::second));
+        stridedArrayView(localTransformations).slice(&decltype(localTransformations)::Type::first),
+        stridedArrayView(localTransformations).slice(&decltype(localTransformations)::Type::second));
 
     /* Retrieve transformations of all objects, indexed by object ID. Since not
        all nodes in the hierarchy may have a transformation assigned, the whole
-       array got initialized to identity first. */
+       array gets initialized to identity first. */
     /** @todo switch to a hashmap eventually? */
-    absoluteTransformations[0] = globalTransformation;
-    for(const Containers::Pair<UnsignedInt, MatrixTypeFor<dimensions, Float>>& transformation: transformations) {
+    const MatrixTypeFor<dimensions, Float> identity[1]{};
+    Utility::copy(Containers::stridedArrayView(identity).broadcasted<0>(transformations.size()), transformations);
+    for(const Containers::Pair<UnsignedInt, MatrixTypeFor<dimensions, Float>>& transformation: localTransformations) {
         CORRADE_INTERNAL_ASSERT(transformation.first() < scene.mappingBound());
-        absoluteTransformations[transformation.first() + 1] = transformation.second();
+        transformations[transformation.first()] = transformation.second();
+    }
+
+    /* Turn the transformations into absolute. The parents are ordered so a
+       parent always gets its absolute transformation before its children. */
+    const auto process = [&transformations, &globalTransformation](const Containers::ArrayView<const Containers::Pair<UnsignedInt, Int>> parents) {
+        for(const Containers::Pair<UnsignedInt, Int>& parentOffset: parents) {
+            transformations[parentOffset.first()] =
+                (parentOffset.second() == -1 ? globalTransformation : transformations[parentOffset.second()])*
+                transformations[parentOffset.first()];
+        }
+    };
+
+    if(!threadCount) threadCount = TaskScheduler::global().threadCount();
+    if(threadCount > 1 && orderedClusteredParents.size() >= ParallelLevelThreshold) {
+        /* Nodes on the same depth level don't depend on each other, so each
+           level can be processed in parallel once all levels above are done.
+           Calculate the depth of each node and sort the parent list by depth
+           using a counting sort, which preserves the relative order inside
+           each level. */
+        Containers::Array<UnsignedInt> depths{NoInit, std::size_t(scene.mappingBound())};
+        Containers::Array<std::size_t> levelOffsets;
+        for(const Containers::Pair<UnsignedInt, Int>& parentOffset: orderedClusteredParents) {
+            const UnsignedInt depth = parentOffset.second() == -1 ? 0 : depths[parentOffset.second()] + 1;
+            depths[parentOffset.first()] = depth;
+            if(levelOffsets.size() < depth + 2)
+                arrayResize(levelOffsets, ValueInit, depth + 2);
+            ++levelOffsets[depth + 1];
+        }
+        for(std::size_t i = 1; i < levelOffsets.size(); ++i)
+            levelOffsets[i] += levelOffsets[i - 1];
+
+        Containers::Array<std::size_t> levelCursors{NoInit, levelOffsets.size()};
+        Utility::copy(levelOffsets, levelCursors);
+        Containers::Array<Containers::Pair<UnsignedInt, Int>> levels{NoInit, orderedClusteredParents.size()};
+        for(const Containers::Pair<UnsignedInt, Int>& parentOffset: orderedClusteredParents)
+            levels[levelCursors[depths[parentOffset.first()]]++] = parentOffset;
+
+        for(std::size_t level = 0; level + 1 < levelOffsets.size(); ++level) {
+            const Containers::ArrayView<const Containers::Pair<UnsignedInt, Int>> levelParents = levels.slice(levelOffsets[level], levelOffsets[level + 1]);
+            if(levelParents.size() < ParallelLevelThreshold) {
+                process(levelParents);
+                continue;
+            }
+
+            Magnum::Implementation::parallelFor(levelParents.size(), threadCount, [&process, &levelParents](const std::size_t begin, const std::size_t end) {
+                process(levelParents.slice(begin, end));
+            });
+        }
+
+        return;
     }
 
-    /* Turn the transformations into absolute */
-    for(const Containers::Pair<UnsignedInt, Int>& parentOffset: orderedClusteredParents) {
-        absoluteTransformations[parentOffset.first() + 1] =
-            absoluteTransformations[parentOffset.second() + 1]*
-            absoluteTransformations[parentOffset.first() + 1];
+    process(orderedClusteredParents);
+}
+
+template<UnsignedInt dimensions> void flattenTransformationHierarchyIntoImplementation(const Trade::SceneData& scene, const Containers::ArrayView<const UnsignedInt> dirtyObjects, const Containers::StridedArrayView1D<MatrixTypeFor<dimensions, Float>>& transformations, const MatrixTypeFor<dimensions, Float>& globalTransformation) {
+    CORRADE_ASSERT(SceneDataDimensionTraits<dimensions>::isDimensions(scene),
+        "SceneTools::flattenTransformationHierarchyInto(): the scene is not" << dimensions << Debug::nospace << "D", );
+    const Containers::Optional<UnsignedInt> parentFieldId = scene.findFieldId(Trade::SceneField::Parent);
+    CORRADE_ASSERT(parentFieldId,
+        "SceneTools::flattenTransformationHierarchyInto(): the scene has no hierarchy", );
+    const std::size_t objectCount = scene.mappingBound();
+    CORRADE_ASSERT(transformations.size() == objectCount,
+        "SceneTools::flattenTransformationHierarchyInto(): bad output size, expected" << objectCount << "but got" << transformations.size(), );
+    #ifndef CORRADE_NO_ASSERT
+    for(const UnsignedInt object: dirtyObjects)
+        CORRADE_ASSERT(object < objectCount,
+            "SceneTools::flattenTransformationHierarchyInto(): object" << object << "out of bounds for" << objectCount << "objects", );
+    #endif
+
+    /* Allocate a single storage for all temporary data */
+    const std::size_t parentCount = scene.fieldSize(*parentFieldId);
+    Containers::ArrayView<UnsignedInt> parentMapping;
+    Containers::ArrayView<Int> parents;
+    Containers::ArrayView<UnsignedInt> transformationMapping;
+    Containers::ArrayView<Int> objectParents;
+    Containers::ArrayView<UnsignedInt> objectTransformations;
+    Containers::ArrayView<UnsignedInt> childOffsets;
+    Containers::ArrayView<UnsignedInt> children;
+    Containers::ArrayView<UnsignedByte> states;
+    Containers::ArrayTuple storage{
+        /* Output of scene.parentsInto() */
+        {NoInit, parentCount, parentMapping},
+        {NoInit, parentCount, parents},
+        /* Object mapping of scene.transformationsXDInto() */
+        {NoInit, scene.transformationFieldSize(), transformationMapping},
+        /* Parent of each object, -2 if it's not a part of the hierarchy */
+        {NoInit, objectCount, objectParents},
+        /* Offset of each object into the transformation field, ~0 if it has
+           no transformation */
+        {NoInit, objectCount, objectTransformations},
+        /* Children of each object, see below for why it's two items more */
+        {ValueInit, objectCount + 2, childOffsets},
+        {NoInit, parentCount, children},
+        /* Whether given object is dirty and if it was already processed */
+        {ValueInit, objectCount, states}
+    };
+    scene.parentsInto(parentMapping, parents);
+    SceneDataDimensionTraits<dimensions>::transformationsInto(scene, transformationMapping, nullptr);
+
+    for(Int& parent: objectParents) parent = -2;
+    for(UnsignedInt& offset: objectTransformations) offset = ~UnsignedInt{};
+    for(std::size_t i = 0; i != transformationMapping.size(); ++i)
+        objectTransformations[transformationMapping[i]] = i;
+
+    /* Build a list of children for each object. The counts are put two items
+       further, then turned into offsets and incremented again while placing
+       the children, at which point children of an object `i` are in range
+       [childOffsets[i], childOffsets[i + 1]). */
+    for(std::size_t i = 0; i != parentCount; ++i) {
+        CORRADE_INTERNAL_ASSERT(parentMapping[i] < objectCount);
+        objectParents[parentMapping[i]] = parents[i];
+        if(parents[i] != -1) ++childOffsets[parents[i] + 2];
     }
+    for(std::size_t i = 1; i != childOffsets.size(); ++i)
+        childOffsets[i] += childOffsets[i - 1];
+    for(std::size_t i = 0; i != parentCount; ++i)
+        if(parents[i] != -1) children[childOffsets[parents[i] + 1]++] = parentMapping[i];
+
+    enum: UnsignedByte { Dirty = 1, Processed = 2 };
+    for(const UnsignedInt object: dirtyObjects)
+        states[object] = Dirty;
+
+    Containers::Array<UnsignedInt> stack;
+    for(const UnsignedInt object: dirtyObjects) {
+        /* Skip duplicates and objects that have a dirty ancestor, those get
+           updated as part of the ancestor subtree */
+        if(states[object] == Processed) continue;
+        bool hasDirtyAncestor = false;
+        for(Int parent = objectParents[object]; parent >= 0; parent = objectParents[parent]) {
+            if(states[parent]) {
+                hasDirtyAncestor = true;
+                break;
+            }
+        }
+        if(hasDirtyAncestor) continue;
+        states[object] = Processed;
+
+        /* Update the whole subtree depth-first, going always from the parent
+           to the children so the parent transformation is up-to-date. The
+           parent of the subtree root isn't dirty, so its transformation from
+           the previous run can be used. */
+        arrayAppend(stack, object);
+        while(!stack.isEmpty()) {
+            const UnsignedInt current = stack[stack.size() - 1];
+            arrayRemoveSuffix(stack);
+
+            MatrixTypeFor<dimensions, Float> local;
+            if(objectTransformations[current] != ~UnsignedInt{})
+                SceneDataDimensionTraits<dimensions>::transformationsInto(scene, objectTransformations[current], Containers::arrayView(&local, 1));
+
+            /* Consistently with the full variant, objects that aren't a part
+               of the hierarchy get their local transformation */
+            const Int parent = objectParents[current];
+            if(parent == -2)
+                transformations[current] = local;
+            else transformations[current] =
+                (parent == -1 ? globalTransformation : transformations[parent])*local;
+
+            for(std::size_t i = childOffsets[current]; i != childOffsets[current + 1]; ++i)
+                arrayAppend(stack, children[i]);
+        }
+    }
+}
+
+template<UnsignedInt dimensions> void flattenTransformationHierarchyIntoImplementation(const Trade::SceneData& scene, const Containers::StridedArrayView1D<MatrixTypeFor<dimensions, Float>>& transformations, const MatrixTypeFor<dimensions, Float>& globalTransformation, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(SceneDataDimensionTraits<dimensions>::isDimensions(scene),
+        "SceneTools::flattenTransformationHierarchyInto(): the scene is not" << dimensions << Debug::nospace << "D", );
+    const Containers::Optional<UnsignedInt> parentFieldId = scene.findFieldId(Trade::SceneField::Parent);
+    CORRADE_ASSERT(parentFieldId,
+        "SceneTools::flattenTransformationHierarchyInto(): the scene has no hierarchy", );
+    CORRADE_ASSERT(transformations.size() == scene.mappingBound(),
+        "SceneTools::flattenTransformationHierarchyInto(): bad output size, expected" << scene.mappingBound() << "but got" << transformations.size(), );
+
+    flattenTransformationHierarchyIntoImplementation<dimensions>(scene, *parentFieldId, transformations, globalTransformation, threadCount);
+}
+
+template<UnsignedInt dimensions>
+Containers::Array<Containers::Triple<UnsignedInt, Int, MatrixTypeFor<dimensions, Float>>> flattenMeshHierarchyImplementation(const Trade::SceneData& scene, const MatrixTypeFor<dimensions, Float>& globalTransformation, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(SceneDataDimensionTraits<dimensions>::isDimensions(scene),
+        "SceneTools::flattenMeshHierarchy(): the scene is not" << dimensions << Debug::nospace << "D", {});
+    const Containers::Optional<UnsignedInt> parentFieldId = scene.findFieldId(Trade::SceneField::Parent);
+    CORRADE_ASSERT(parentFieldId,
+        "SceneTools::flattenMeshHierarchy(): the scene has no hierarchy", {});
+
+    /* If there's no mesh field in the file, nothing to do. Another case is
+       that there is a mesh field but it's empty, then for simplicity we still
+       go through everything. */
+    if(!scene.hasField(Trade::SceneField::Mesh)) return {};
+
+    /* Absolute transformations of all objects, indexed by object ID */
+    Containers::Array<MatrixTypeFor<dimensions, Float>> absoluteTransformations{NoInit, std::size_t(scene.mappingBound())};
+    flattenTransformationHierarchyIntoImplementation<dimensions>(scene, *parentFieldId, stridedArrayView(absoluteTransformations), globalTransformation, threadCount);
 
     /* Allocate the output array, retrieve mesh & material IDs and assign
        absolute transformations to each. The matrix location is abused for
@@ -123,7 +311,7 @@ Containers::Array<Containers::Triple<UnsignedInt, Int, MatrixTypeFor<dimensions,
         stridedArrayView(out).slice(&decltype(out)::Type::second));
     for(std::size_t i = 0; i != out.size(); ++i) {
         CORRADE_INTERNAL_ASSERT(mapping[i] < scene.mappingBound());
-        matrices[i] = absoluteTransformations[mapping[i] + 1];
+        matrices[i] = absoluteTransformations[mapping[i]];
     }
 
     return out;
@@ -131,20 +319,44 @@ Containers::Array<Containers::Triple<UnsignedInt, Int, MatrixTypeFor<dimensions,
 
 }
 
+Containers::Array<Containers::Triple<UnsignedInt, Int, Matrix3>> flattenMeshHierarchy2D(const Trade::SceneData& scene, const Matrix3& globalTransformation, const UnsignedInt threadCount) {
+    return flattenMeshHierarchyImplementation<2>(scene, globalTransformation, threadCount);
+}
+
 Containers::Array<Containers::Triple<UnsignedInt, Int, Matrix3>> flattenMeshHierarchy2D(const Trade::SceneData& scene, const Matrix3& globalTransformation) {
-    return flattenMeshHierarchyImplementation<2>(scene, globalTransformation);
+    return flattenMeshHierarchyImplementation<2>(scene, globalTransformation, 1);
 }
 
 Containers::Array<Containers::Triple<UnsignedInt, Int, Matrix3>> flattenMeshHierarchy2D(const Trade::SceneData& scene) {
-    return flattenMeshHierarchyImplementation<2>(scene, {});
+    return flattenMeshHierarchyImplementation<2>(scene, {}, 1);
+}
+
+Containers::Array<Containers::Triple<UnsignedInt, Int, Matrix4>> flattenMeshHierarchy3D(const Trade::SceneData& scene, const Matrix4& globalTransformation, const UnsignedInt threadCount) {
+    return flattenMeshHierarchyImplementation<3>(scene, globalTransformation, threadCount);
 }
 
 Containers::Array<Containers::Triple<UnsignedInt, Int, Matrix4>> flattenMeshHierarchy3D(const Trade::SceneData& scene, const Matrix4& globalTransformation) {
-    return flattenMeshHierarchyImplementation<3>(scene, globalTransformation);
+    return flattenMeshHierarchyImplementation<3>(scene, globalTransformation, 1);
 }
 
 Containers::Array<Containers::Triple<UnsignedInt, Int, Matrix4>> flattenMeshHierarchy3D(const Trade::SceneData& scene) {
-    return flattenMeshHierarchyImplementation<3>(scene, {});
+    return flattenMeshHierarchyImplementation<3>(scene, {}, 1);
+}
+
+void flattenTransformationHierarchy2DInto(const Trade::SceneData& scene, const Containers::StridedArrayView1D<Matrix3>& transformations, const Matrix3& globalTransformation, const UnsignedInt threadCount) {
+    flattenTransformationHierarchyIntoImplementation<2>(scene, transformations, globalTransformation, threadCount);
+}
+
+void flattenTransformationHierarchy2DInto(const Trade::SceneData& scene, const Containers::ArrayView<const UnsignedInt> dirtyObjects, const Containers::StridedArrayView1D<Matrix3>& transformations, const Matrix3& globalTransformation) {
+    flattenTransformationHierarchyIntoImplementation<2>(scene, dirtyObjects, transformations, globalTransformation);
+}
+
+void flattenTransformationHierarchy3DInto(const Trade::SceneData& scene, const Containers::StridedArrayView1D<Matrix4>& transformations, const Matrix4& globalTransformation, const UnsignedInt threadCount) {
+    flattenTransformationHierarchyIntoImplementation<3>(scene, transformations, globalTransformation, threadCount);
+}
+
+void flattenTransformationHierarchy3DInto(const Trade::SceneData& scene, const Containers::ArrayView<const UnsignedInt> dirtyObjects, const Containers::StridedArrayView1D<Matrix4>& transformations, const Matrix4& globalTransformation) {
+    flattenTransformationHierarchyIntoImplementation<3>(scene, dirtyObjects, transformations, globalTransformation);
 }
 
 }}
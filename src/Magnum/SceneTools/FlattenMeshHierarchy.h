@@ -26,10 +26,12 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::SceneTools::flattenMeshHierarchy2D(), @ref Magnum::SceneTools::flattenMeshHierarchy3D()
+ * @brief Function @ref Magnum::SceneTools::flattenMeshHierarchy2D(), @ref Magnum::SceneTools::flattenMeshHierarchy3D(), @ref Magnum::SceneTools::flattenTransformationHierarchy2DInto(), @ref Magnum::SceneTools::flattenTransformationHierarchy3DInto()
  * @m_since_latest
  */
 
+#include <Corrade/Containers/Containers.h>
+
 #include "Magnum/Magnum.h"
 #include "Magnum/SceneTools/visibility.h"
 #include "Magnum/Trade/Trade.h"
@@ -72,6 +74,81 @@ Same as above with @p globalTransformation set to an identity matrix.
 */
 MAGNUM_SCENETOOLS_EXPORT Containers::Array<Containers::Triple<UnsignedInt, Int, Matrix3>> flattenMeshHierarchy2D(const Trade::SceneData& scene);
 
+/**
+@brief Flatten a 2D mesh hierarchy using multiple threads
+@m_since_latest
+
+Same as @ref flattenMeshHierarchy2D(const Trade::SceneData&, const Matrix3&),
+but calculates the absolute transformations using
+@ref flattenTransformationHierarchy2DInto(const Trade::SceneData&, const Containers::StridedArrayView1D<Matrix3>&, const Matrix3&, UnsignedInt)
+with given @p threadCount. See its documentation for more information.
+
+@experimental
+*/
+MAGNUM_SCENETOOLS_EXPORT Containers::Array<Containers::Triple<UnsignedInt, Int, Matrix3>> flattenMeshHierarchy2D(const Trade::SceneData& scene, const Matrix3& globalTransformation, UnsignedInt threadCount);
+
+/**
+@brief Flatten a 2D transformation hierarchy into a pre-allocated view
+@param[in]  scene           Input scene
+@param[out] transformations Where to put absolute transformations of all
+    objects
+@param[in]  globalTransformation Global transformation to prepend
+@param[in]  threadCount     Max count of threads to use. If @cpp 0 @ce,
+    @ref TaskScheduler::threadCount() of @ref TaskScheduler::global() is
+    used.
+@m_since_latest
+
+Calculates absolute transformations of all objects in the scene, indexed by
+object ID, with @p globalTransformation prepended. The
+@ref Trade::SceneField::Parent field is expected to be contained in the
+scene, having no cycles or duplicates, and the scene is expected to be 2D.
+The @p transformations view is expected to have a size of
+@ref Trade::SceneData::mappingBound(). Objects that aren't a part of the
+hierarchy get their local transformation, for which the
+@p globalTransformation isn't applied, or an identity if they have no
+transformation either.
+
+The operation is done in an @f$ \mathcal{O}(n) @f$ execution time and
+memory complexity, with @f$ n @f$ being @ref Trade::SceneData::mappingBound().
+If more than one thread is used and the hierarchy is large enough, the nodes
+are additionally sorted by their depth, and each depth level that's large
+enough is split among tasks submitted to @ref TaskScheduler::global(), as the
+nodes inside a single level don't depend on each other. Narrow hierarchies
+thus don't benefit from multiple threads.
+@see @ref flattenMeshHierarchy2D(const Trade::SceneData&, const Matrix3&, UnsignedInt)
+
+@experimental
+*/
+MAGNUM_SCENETOOLS_EXPORT void flattenTransformationHierarchy2DInto(const Trade::SceneData& scene, const Containers::StridedArrayView1D<Matrix3>& transformations, const Matrix3& globalTransformation, UnsignedInt threadCount = 1);
+
+/**
+@brief Update a 2D transformation hierarchy in a pre-allocated view
+@param[in]  scene           Input scene
+@param[in]  dirtyObjects    Objects with changed local transformation
+@param[in,out] transformations Absolute transformations of all objects
+@param[in]  globalTransformation Global transformation to prepend
+@m_since_latest
+
+Expects that @p transformations contain the output of
+@ref flattenTransformationHierarchy2DInto(const Trade::SceneData&, const Containers::StridedArrayView1D<Matrix3>&, const Matrix3&, UnsignedInt)
+for given scene, and the only thing that changed since is the local
+transformation of the @p dirtyObjects. Recalculates absolute transformations
+of the @p dirtyObjects and all their descendants, leaving the rest untouched.
+The @p globalTransformation is expected to be the same as in the original
+call. The scene is expected to satisfy the same constraints as in the
+original call and all @p dirtyObjects are expected to be less than
+@ref Trade::SceneData::mappingBound(). Duplicates and objects that are a
+descendant of another dirty object are allowed and processed only once.
+
+Calculating a list of children for each object is still done in an
+@f$ \mathcal{O}(n) @f$ execution time and memory complexity, with
+@f$ n @f$ being @ref Trade::SceneData::mappingBound(), but the matrix
+multiplications are done only for the affected subtrees.
+
+@experimental
+*/
+MAGNUM_SCENETOOLS_EXPORT void flattenTransformationHierarchy2DInto(const Trade::SceneData& scene, Containers::ArrayView<const UnsignedInt> dirtyObjects, const Containers::StridedArrayView1D<Matrix3>& transformations, const Matrix3& globalTransformation);
+
 /**
 @brief Flatten a 3D mesh hierarchy
 @m_since_latest
@@ -108,6 +185,81 @@ Same as above with @p globalTransformation set to an identity matrix.
 */
 MAGNUM_SCENETOOLS_EXPORT Containers::Array<Containers::Triple<UnsignedInt, Int, Matrix4>> flattenMeshHierarchy3D(const Trade::SceneData& scene);
 
+/**
+@brief Flatten a 3D mesh hierarchy using multiple threads
+@m_since_latest
+
+Same as @ref flattenMeshHierarchy3D(const Trade::SceneData&, const Matrix4&),
+but calculates the absolute transformations using
+@ref flattenTransformationHierarchy3DInto(const Trade::SceneData&, const Containers::StridedArrayView1D<Matrix4>&, const Matrix4&, UnsignedInt)
+with given @p threadCount. See its documentation for more information.
+
+@experimental
+*/
+MAGNUM_SCENETOOLS_EXPORT Containers::Array<Containers::Triple<UnsignedInt, Int, Matrix4>> flattenMeshHierarchy3D(const Trade::SceneData& scene, const Matrix4& globalTransformation, UnsignedInt threadCount);
+
+/**
+@brief Flatten a 3D transformation hierarchy into a pre-allocated view
+@param[in]  scene           Input scene
+@param[out] transformations Where to put absolute transformations of all
+    objects
+@param[in]  globalTransformation Global transformation to prepend
+@param[in]  threadCount     Max count of threads to use. If @cpp 0 @ce,
+    @ref TaskScheduler::threadCount() of @ref TaskScheduler::global() is
+    used.
+@m_since_latest
+
+Calculates absolute transformations of all objects in the scene, indexed by
+object ID, with @p globalTransformation prepended. The
+@ref Trade::SceneField::Parent field is expected to be contained in the
+scene, having no cycles or duplicates, and the scene is expected to be 3D.
+The @p transformations view is expected to have a size of
+@ref Trade::SceneData::mappingBound(). Objects that aren't a part of the
+hierarchy get their local transformation, for which the
+@p globalTransformation isn't applied, or an identity if they have no
+transformation either.
+
+The operation is done in an @f$ \mathcal{O}(n) @f$ execution time and
+memory complexity, with @f$ n @f$ being @ref Trade::SceneData::mappingBound().
+If more than one thread is used and the hierarchy is large enough, the nodes
+are additionally sorted by their depth, and each depth level that's large
+enough is split among tasks submitted to @ref TaskScheduler::global(), as the
+nodes inside a single level don't depend on each other. Narrow hierarchies
+thus don't benefit from multiple threads.
+@see @ref flattenMeshHierarchy3D(const Trade::SceneData&, const Matrix4&, UnsignedInt)
+
+@experimental
+*/
+MAGNUM_SCENETOOLS_EXPORT void flattenTransformationHierarchy3DInto(const Trade::SceneData& scene, const Containers::StridedArrayView1D<Matrix4>& transformations, const Matrix4& globalTransformation, UnsignedInt threadCount = 1);
+
+/**
+@brief Update a 3D transformation hierarchy in a pre-allocated view
+@param[in]  scene           Input scene
+@param[in]  dirtyObjects    Objects with changed local transformation
+@param[in,out] transformations Absolute transformations of all objects
+@param[in]  globalTransformation Global transformation to prepend
+@m_since_latest
+
+Expects that @p transformations contain the output of
+@ref flattenTransformationHierarchy3DInto(const Trade::SceneData&, const Containers::StridedArrayView1D<Matrix4>&, const Matrix4&, UnsignedInt)
+for given scene, and the only thing that changed since is the local
+transformation of the @p dirtyObjects. Recalculates absolute transformations
+of the @p dirtyObjects and all their descendants, leaving the rest untouched.
+The @p globalTransformation is expected to be the same as in the original
+call. The scene is expected to satisfy the same constraints as in the
+original call and all @p dirtyObjects are expected to be less than
+@ref Trade::SceneData::mappingBound(). Duplicates and objects that are a
+descendant of another dirty object are allowed and processed only once.
+
+Calculating a list of children for each object is still done in an
+@f$ \mathcal{O}(n) @f$ execution time and memory complexity, with
+@f$ n @f$ being @ref Trade::SceneData::mappingBound(), but the matrix
+multiplications are done only for the affected subtrees.
+
+@experimental
+*/
+MAGNUM_SCENETOOLS_EXPORT void flattenTransformationHierarchy3DInto(const Trade::SceneData& scene, Containers::ArrayView<const UnsignedInt> dirtyObjects, const Containers::StridedArrayView1D<Matrix4>& transformations, const Matrix4& globalTransformation);
+
 }}
 
 #endif
@@ -0,0 +1,415 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "SceneBuilder.h"
+
+#include <cstring>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+
+#include "Magnum/Math/Complex.h"
+#include "Magnum/Math/Quaternion.h"
+#include "Magnum/SceneTools/Implementation/combine.h"
+
+namespace Magnum { namespace SceneTools {
+
+namespace {
+
+/* Entries of fields that share the object mapping */
+struct Group {
+    /* Object ID for each entry */
+    Containers::Array<UnsignedInt> mapping;
+    /* Next older and next newer entry of the same object for each entry, ~0
+       if there's none */
+    Containers::Array<UnsignedInt> older;
+    Containers::Array<UnsignedInt> newer;
+    /* Most recently added entry for each object, ~0 if the object has no
+       entries. Enlarged to the mapping bound on demand, so objects that never
+       get an entry in this group don't need to be stored. */
+    Containers::Array<UnsignedInt> latest;
+};
+
+struct Field {
+    Trade::SceneField name;
+    Trade::SceneFieldType type;
+    UnsignedShort arraySize;
+    UnsignedInt group;
+    std::size_t valueSize;
+    Containers::Array<char> data;
+    /* Value an entry gets if it's added through another field in the same
+       group */
+    Containers::Array<char> defaultValue;
+};
+
+/* Fields that are required to share the object mapping by SceneData */
+bool isSharedMapping(const Trade::SceneField a, const Trade::SceneField b) {
+    const auto isTrs = [](const Trade::SceneField name) {
+        return name == Trade::SceneField::Translation ||
+               name == Trade::SceneField::Rotation ||
+               name == Trade::SceneField::Scaling;
+    };
+    const auto isMesh = [](const Trade::SceneField name) {
+        return name == Trade::SceneField::Mesh ||
+               name == Trade::SceneField::MeshMaterial;
+    };
+    return (isTrs(a) && isTrs(b)) || (isMesh(a) && isMesh(b));
+}
+
+template<class T> void setDefaultValue(Containers::Array<char>& out, const T& value) {
+    CORRADE_INTERNAL_ASSERT(out.size() == sizeof(T));
+    std::memcpy(out.data(), &value, sizeof(T));
+}
+
+Containers::Array<char> defaultValueFor(const Trade::SceneField name, const Trade::SceneFieldType type, const std::size_t size) {
+    Containers::Array<char> out{ValueInit, size};
+
+    /* All bits set is -1 for all signed types */
+    if(name == Trade::SceneField::MeshMaterial) {
+        for(char& i: out) i = '\xff';
+    } else if(name == Trade::SceneField::Rotation) {
+        if(type == Trade::SceneFieldType::Complex)
+            setDefaultValue(out, Complex{});
+        else if(type == Trade::SceneFieldType::Complexd)
+            setDefaultValue(out, Complexd{});
+        else if(type == Trade::SceneFieldType::Quaternion)
+            setDefaultValue(out, Quaternion{});
+        else if(type == Trade::SceneFieldType::Quaterniond)
+            setDefaultValue(out, Quaterniond{});
+    } else if(name == Trade::SceneField::Scaling) {
+        if(type == Trade::SceneFieldType::Vector2)
+            setDefaultValue(out, Vector2{1.0f});
+        else if(type == Trade::SceneFieldType::Vector2d)
+            setDefaultValue(out, Vector2d{1.0});
+        else if(type == Trade::SceneFieldType::Vector3)
+            setDefaultValue(out, Vector3{1.0f});
+        else if(type == Trade::SceneFieldType::Vector3d)
+            setDefaultValue(out, Vector3d{1.0});
+    }
+
+    /* Everything else is zero */
+    return out;
+}
+
+UnsignedInt findField(const Containers::ArrayView<const Field> fields, const Trade::SceneField name) {
+    for(std::size_t i = 0; i != fields.size(); ++i)
+        if(fields[i].name == name) return i;
+    return ~UnsignedInt{};
+}
+
+/* Adds an entry for given object to the group and links it to the other
+   entries of the same object. Values of the fields are not touched. */
+UnsignedInt appendEntry(Group& group, const UnsignedInt object, const UnsignedLong mappingBound) {
+    if(group.latest.size() <= object)
+        arrayResize(group.latest, DirectInit, mappingBound, ~UnsignedInt{});
+
+    const UnsignedInt entry = group.mapping.size();
+    arrayAppend(group.mapping, object);
+    arrayAppend(group.older, group.latest[object]);
+    arrayAppend(group.newer, ~UnsignedInt{});
+    if(group.latest[object] != ~UnsignedInt{})
+        group.newer[group.latest[object]] = entry;
+    group.latest[object] = entry;
+    return entry;
+}
+
+/* Unlinks the entry and replaces it with the last entry of the group */
+void removeEntry(Group& group, const Containers::ArrayView<Field> fields, const UnsignedInt groupId, const UnsignedInt entry) {
+    const UnsignedInt object = group.mapping[entry];
+    if(group.newer[entry] != ~UnsignedInt{})
+        group.older[group.newer[entry]] = group.older[entry];
+    else
+        group.latest[object] = group.older[entry];
+    if(group.older[entry] != ~UnsignedInt{})
+        group.newer[group.older[entry]] = group.newer[entry];
+
+    const UnsignedInt last = group.mapping.size() - 1;
+    if(entry != last) {
+        const UnsignedInt lastObject = group.mapping[last];
+        group.mapping[entry] = lastObject;
+        group.older[entry] = group.older[last];
+        group.newer[entry] = group.newer[last];
+        if(group.newer[entry] != ~UnsignedInt{})
+            group.older[group.newer[entry]] = entry;
+        else
+            group.latest[lastObject] = entry;
+        if(group.older[entry] != ~UnsignedInt{})
+            group.newer[group.older[entry]] = entry;
+
+        for(Field& field: fields) if(field.group == groupId)
+            std::memcpy(field.data.data() + entry*field.valueSize, field.data.data() + last*field.valueSize, field.valueSize);
+    }
+
+    arrayRemoveSuffix(group.mapping);
+    arrayRemoveSuffix(group.older);
+    arrayRemoveSuffix(group.newer);
+    for(Field& field: fields) if(field.group == groupId)
+        arrayRemoveSuffix(field.data, field.valueSize);
+}
+
+void removeEntriesFor(Group& group, const Containers::ArrayView<Field> fields, const UnsignedInt groupId, const UnsignedInt object) {
+    if(group.latest.size() <= object) return;
+    while(group.latest[object] != ~UnsignedInt{})
+        removeEntry(group, fields, groupId, group.latest[object]);
+}
+
+}
+
+struct SceneBuilder::State {
+    UnsignedLong mappingBound;
+    Containers::Array<Group> groups;
+    Containers::Array<Field> fields;
+};
+
+SceneBuilder::SceneBuilder(const UnsignedLong mappingBound): _state{InPlaceInit} {
+    CORRADE_ASSERT(mappingBound <= 0xffffffffull,
+        "SceneTools::SceneBuilder: expected the mapping bound to fit into 32 bits but got" << mappingBound, );
+    _state->mappingBound = mappingBound;
+}
+
+SceneBuilder::SceneBuilder(const Trade::SceneData& scene): SceneBuilder{scene.mappingBound()} {
+    #ifdef CORRADE_GRACEFUL_ASSERT
+    /* If the delegated constructor assertion fired, exit */
+    if(_state->mappingBound != scene.mappingBound()) return;
+    #endif
+
+    /* Add all fields first so the default values are filled for fields that
+       share the mapping. The field IDs are then the same as in the scene. */
+    for(UnsignedInt i = 0; i != scene.fieldCount(); ++i)
+        addField(scene.fieldName(i), scene.fieldType(i), scene.fieldArraySize(i));
+
+    State& state = *_state;
+    for(UnsignedInt i = 0; i != scene.fieldCount(); ++i) {
+        Field& field = state.fields[i];
+        Group& group = state.groups[field.group];
+
+        /* If the group has no entries yet, add them from this field mapping
+           together with default values for all fields in the group. If it
+           has, they were added from a field sharing the mapping with this
+           one earlier, so only the values get overwritten below. */
+        const std::size_t size = scene.fieldSize(i);
+        if(group.mapping.isEmpty()) {
+            for(const UnsignedInt object: scene.mappingAsArray(i))
+                appendEntry(group, object, state.mappingBound);
+            for(Field& other: state.fields) if(other.group == field.group) {
+                for(std::size_t j = 0; j != size; ++j)
+                    arrayAppend(other.data, other.defaultValue);
+            }
+        } else CORRADE_INTERNAL_ASSERT(group.mapping.size() == size);
+
+        Utility::copy(scene.field(i), Containers::StridedArrayView2D<char>{field.data, {size, field.valueSize}});
+    }
+}
+
+SceneBuilder::SceneBuilder(SceneBuilder&&) noexcept = default;
+
+SceneBuilder::~SceneBuilder() = default;
+
+SceneBuilder& SceneBuilder::operator=(SceneBuilder&&) noexcept = default;
+
+UnsignedLong SceneBuilder::mappingBound() const {
+    return _state->mappingBound;
+}
+
+UnsignedLong SceneBuilder::addObject() {
+    CORRADE_ASSERT(_state->mappingBound < 0xffffffffull,
+        "SceneTools::SceneBuilder::addObject(): the mapping bound would no longer fit into 32 bits", {});
+    return _state->mappingBound++;
+}
+
+SceneBuilder& SceneBuilder::removeObject(const UnsignedLong object) {
+    State& state = *_state;
+    CORRADE_ASSERT(object < state.mappingBound,
+        "SceneTools::SceneBuilder::removeObject(): index" << object << "out of range for" << state.mappingBound << "objects", *this);
+
+    for(std::size_t i = 0; i != state.groups.size(); ++i)
+        removeEntriesFor(state.groups[i], state.fields, i, object);
+
+    return *this;
+}
+
+UnsignedInt SceneBuilder::fieldCount() const {
+    return _state->fields.size();
+}
+
+bool SceneBuilder::hasField(const Trade::SceneField name) const {
+    return findField(_state->fields, name) != ~UnsignedInt{};
+}
+
+Trade::SceneFieldType SceneBuilder::fieldType(const Trade::SceneField name) const {
+    const UnsignedInt id = findField(_state->fields, name);
+    CORRADE_ASSERT(id != ~UnsignedInt{},
+        "SceneTools::SceneBuilder::fieldType(): field" << name << "not found", {});
+    return _state->fields[id].type;
+}
+
+UnsignedShort SceneBuilder::fieldArraySize(const Trade::SceneField name) const {
+    const UnsignedInt id = findField(_state->fields, name);
+    CORRADE_ASSERT(id != ~UnsignedInt{},
+        "SceneTools::SceneBuilder::fieldArraySize(): field" << name << "not found", {});
+    return _state->fields[id].arraySize;
+}
+
+std::size_t SceneBuilder::fieldSize(const Trade::SceneField name) const {
+    const UnsignedInt id = findField(_state->fields, name);
+    CORRADE_ASSERT(id != ~UnsignedInt{},
+        "SceneTools::SceneBuilder::fieldSize(): field" << name << "not found", {});
+    return _state->groups[_state->fields[id].group].mapping.size();
+}
+
+SceneBuilder& SceneBuilder::addField(const Trade::SceneField name, const Trade::SceneFieldType type, const UnsignedShort arraySize) {
+    State& state = *_state;
+    CORRADE_ASSERT(findField(state.fields, name) == ~UnsignedInt{},
+        "SceneTools::SceneBuilder::addField(): field" << name << "already exists", *this);
+
+    /* Share the group with an existing field, if required, otherwise create a
+       new one */
+    UnsignedInt group = ~UnsignedInt{};
+    for(const Field& field: state.fields) if(isSharedMapping(field.name, name)) {
+        group = field.group;
+        break;
+    }
+    if(group == ~UnsignedInt{}) {
+        group = state.groups.size();
+        arrayAppend(state.groups, InPlaceInit);
+    }
+
+    const std::size_t valueSize = sceneFieldTypeSize(type)*(arraySize ? arraySize : 1);
+    Field& field = arrayAppend(state.fields, Field{name, type, arraySize, group, valueSize, {}, defaultValueFor(name, type, valueSize)});
+
+    /* If the group already has entries, fill them with the default value */
+    for(std::size_t i = 0, size = state.groups[group].mapping.size(); i != size; ++i)
+        arrayAppend(field.data, field.defaultValue);
+
+    return *this;
+}
+
+std::size_t SceneBuilder::fieldSizeFor(const Trade::SceneField name, const UnsignedLong object) const {
+    const State& state = *_state;
+    const UnsignedInt id = findField(state.fields, name);
+    CORRADE_ASSERT(id != ~UnsignedInt{},
+        "SceneTools::SceneBuilder::fieldSizeFor(): field" << name << "not found", {});
+    CORRADE_ASSERT(object < state.mappingBound,
+        "SceneTools::SceneBuilder::fieldSizeFor(): index" << object << "out of range for" << state.mappingBound << "objects", {});
+
+    const Group& group = state.groups[state.fields[id].group];
+    if(group.latest.size() <= object) return 0;
+    std::size_t count = 0;
+    for(UnsignedInt entry = group.latest[object]; entry != ~UnsignedInt{}; entry = group.older[entry])
+        ++count;
+    return count;
+}
+
+const void* SceneBuilder::fieldValueForInternal(const Trade::SceneField name, const Trade::SceneFieldType type, const UnsignedLong object) const {
+    const State& state = *_state;
+    const UnsignedInt id = findField(state.fields, name);
+    CORRADE_ASSERT(id != ~UnsignedInt{},
+        "SceneTools::SceneBuilder::fieldValueFor(): field" << name << "not found", {});
+    const Field& field = state.fields[id];
+    CORRADE_ASSERT(field.type == type,
+        "SceneTools::SceneBuilder::fieldValueFor():" << name << "is" << field.type << "but requested a type equivalent to" << type, {});
+    CORRADE_ASSERT(!field.arraySize,
+        "SceneTools::SceneBuilder::fieldValueFor():" << name << "is an array field, can't access values directly", {});
+    CORRADE_ASSERT(object < state.mappingBound,
+        "SceneTools::SceneBuilder::fieldValueFor(): index" << object << "out of range for" << state.mappingBound << "objects", {});
+
+    const Group& group = state.groups[field.group];
+    if(group.latest.size() <= object || group.latest[object] == ~UnsignedInt{})
+        return nullptr;
+    return field.data.data() + group.latest[object]*field.valueSize;
+}
+
+void SceneBuilder::setFieldValueInternal(const Trade::SceneField name, const Trade::SceneFieldType type, const UnsignedLong object, const void* const value, const bool add) {
+    State& state = *_state;
+    #ifndef CORRADE_NO_ASSERT
+    const char* const messagePrefix = add ?
+        "SceneTools::SceneBuilder::addFieldValue():" :
+        "SceneTools::SceneBuilder::setFieldValue():";
+    #endif
+    CORRADE_ASSERT(object < state.mappingBound,
+        messagePrefix << "index" << object << "out of range for" << state.mappingBound << "objects", );
+
+    UnsignedInt id = findField(state.fields, name);
+    if(id == ~UnsignedInt{}) {
+        id = state.fields.size();
+        addField(name, type);
+    }
+
+    Field& field = state.fields[id];
+    CORRADE_ASSERT(field.type == type,
+        messagePrefix << name << "is" << field.type << "but got a type equivalent to" << type, );
+    CORRADE_ASSERT(!field.arraySize,
+        messagePrefix << name << "is an array field, can't set values directly", );
+
+    /* Add a new entry if requested or if there's none for the object yet,
+       with default values for all fields in the group */
+    Group& group = state.groups[field.group];
+    UnsignedInt entry = group.latest.size() > object ? group.latest[object] : ~UnsignedInt{};
+    if(add || entry == ~UnsignedInt{}) {
+        entry = appendEntry(group, object, state.mappingBound);
+        for(Field& other: state.fields) if(other.group == field.group)
+            arrayAppend(other.data, other.defaultValue);
+    }
+
+    std::memcpy(field.data.data() + entry*field.valueSize, value, field.valueSize);
+}
+
+SceneBuilder& SceneBuilder::removeFieldValues(const Trade::SceneField name, const UnsignedLong object) {
+    State& state = *_state;
+    const UnsignedInt id = findField(state.fields, name);
+    CORRADE_ASSERT(id != ~UnsignedInt{},
+        "SceneTools::SceneBuilder::removeFieldValues(): field" << name << "not found", *this);
+    CORRADE_ASSERT(object < state.mappingBound,
+        "SceneTools::SceneBuilder::removeFieldValues(): index" << object << "out of range for" << state.mappingBound << "objects", *this);
+
+    const UnsignedInt group = state.fields[id].group;
+    removeEntriesFor(state.groups[group], state.fields, group, object);
+    return *this;
+}
+
+Trade::SceneData SceneBuilder::toSceneData() const {
+    const State& state = *_state;
+
+    /* Fields in the same group reference the same mapping view, which
+       combine() preserves */
+    Containers::Array<Trade::SceneFieldData> fields;
+    arrayReserve(fields, state.fields.size());
+    for(const Field& field: state.fields) {
+        const Group& group = state.groups[field.group];
+        if(group.mapping.isEmpty()) continue;
+
+        arrayAppend(fields, InPlaceInit,
+            field.name,
+            Trade::SceneMappingType::UnsignedInt,
+            Containers::stridedArrayView(group.mapping),
+            field.type,
+            Containers::StridedArrayView1D<const void>{Containers::arrayView(field.data), field.data.data(), group.mapping.size(), std::ptrdiff_t(field.valueSize)},
+            field.arraySize);
+    }
+
+    return Implementation::combine(Trade::SceneMappingType::UnsignedInt, state.mappingBound, fields);
+}
+
+}}
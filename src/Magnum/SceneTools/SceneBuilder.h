@@ -0,0 +1,290 @@
+#ifndef Magnum_SceneTools_SceneBuilder_h
+#define Magnum_SceneTools_SceneBuilder_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneTools::SceneBuilder
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/SceneTools/visibility.h"
+#include "Magnum/Trade/SceneData.h"
+
+namespace Magnum { namespace SceneTools {
+
+/**
+@brief Mutable scene builder
+@m_since_latest
+
+A @ref Trade::SceneData is immutable once constructed, so applying a small
+edit such as moving or reparenting an object would mean rebuilding all its
+fields. This class keeps each field in separately growable storage instead,
+allowing objects and field entries to be added, modified and removed in a time
+proportional to the size of the change, and turned back into a
+@ref Trade::SceneData with @ref toSceneData() when needed, for example by an
+exporter:
+
+@snippet MagnumSceneTools.cpp SceneBuilder-usage
+
+@section SceneTools-SceneBuilder-storage Field storage
+
+Each field is stored as a growable array of values of given
+@ref Trade::SceneFieldType and array size, together with a growable array of
+object IDs the values are mapped to. @ref Trade::SceneField::Translation,
+@relativeref{Trade::SceneField,Rotation} and
+@relativeref{Trade::SceneField,Scaling}, and
+@ref Trade::SceneField::Mesh and @relativeref{Trade::SceneField,MeshMaterial}
+share the object mapping, as required by @ref Trade::SceneData. If an entry is
+added to just one of the shared fields, the other fields get a default value,
+which is a zero translation, an identity rotation, an unit scaling, a zero
+mesh and a @cpp -1 @ce mesh material.
+
+Entries of the same object in each field are additionally linked together,
+which makes it possible to find and remove them in a time proportional to
+their count. Removed entries are replaced with the last entry in the field, so
+the order of entries isn't preserved, and the resulting
+@ref Trade::SceneData thus has no @ref Trade::SceneFieldFlag::OrderedMapping
+or @relativeref{Trade::SceneFieldFlag,ImplicitMapping} flags.
+
+@section SceneTools-SceneBuilder-snapshot Snapshotting
+
+The @ref toSceneData() function copies all non-empty fields into a single
+allocation, with the object mapping shared among fields as described above,
+and with @ref Trade::SceneMappingType::UnsignedInt. As the fields are already
+stored contiguously, it's a plain copy of each field, without any per-object
+work.
+
+@experimental
+*/
+class MAGNUM_SCENETOOLS_EXPORT SceneBuilder {
+    public:
+        /**
+         * @brief Constructor
+         * @param mappingBound  Initial mapping bound
+         *
+         * Creates a builder with no fields and @p mappingBound objects.
+         * Expects that @p mappingBound fits into 32 bits.
+         */
+        explicit SceneBuilder(UnsignedLong mappingBound = 0);
+
+        /**
+         * @brief Construct from an existing scene
+         *
+         * Copies all fields including their types and array sizes, field
+         * flags are not preserved. Expects that
+         * @ref Trade::SceneData::mappingBound() of @p scene fits into 32
+         * bits. The operation is done in an @f$ \mathcal{O}(n) @f$
+         * execution time, with @f$ n @f$ being the total count of entries in
+         * all fields, and the @p scene isn't referenced after the
+         * constructor exits.
+         */
+        explicit SceneBuilder(const Trade::SceneData& scene);
+
+        /** @brief Copying is not allowed */
+        SceneBuilder(const SceneBuilder&) = delete;
+
+        /** @brief Move constructor */
+        SceneBuilder(SceneBuilder&&) noexcept;
+
+        ~SceneBuilder();
+
+        /** @brief Copying is not allowed */
+        SceneBuilder& operator=(const SceneBuilder&) = delete;
+
+        /** @brief Move assignment */
+        SceneBuilder& operator=(SceneBuilder&&) noexcept;
+
+        /**
+         * @brief Mapping bound
+         *
+         * Upper bound on object IDs. IDs of removed objects are not reused,
+         * so the bound never decreases.
+         */
+        UnsignedLong mappingBound() const;
+
+        /**
+         * @brief Add an object
+         * @return ID of the new object
+         *
+         * Returns @ref mappingBound() and increments it. The object has no
+         * field entries.
+         */
+        UnsignedLong addObject();
+
+        /**
+         * @brief Remove an object
+         * @return Reference to self (for method chaining)
+         *
+         * Removes all entries of @p object in all fields. The ID isn't
+         * reused by subsequent @ref addObject() calls. Entries of other
+         * objects referencing @p object, such as
+         * @ref Trade::SceneField::Parent of its children, are not updated,
+         * the children are expected to be reparented or removed as well.
+         * Expects that @p object is less than @ref mappingBound().
+         */
+        SceneBuilder& removeObject(UnsignedLong object);
+
+        /** @brief Field count */
+        UnsignedInt fieldCount() const;
+
+        /**
+         * @brief Whether the builder has given field
+         *
+         * @see @ref addField(), @ref fieldSize()
+         */
+        bool hasField(Trade::SceneField name) const;
+
+        /**
+         * @brief Field type
+         *
+         * Expects that @p name is present.
+         */
+        Trade::SceneFieldType fieldType(Trade::SceneField name) const;
+
+        /**
+         * @brief Field array size
+         *
+         * Expects that @p name is present.
+         */
+        UnsignedShort fieldArraySize(Trade::SceneField name) const;
+
+        /**
+         * @brief Count of entries in given field
+         *
+         * Expects that @p name is present.
+         */
+        std::size_t fieldSize(Trade::SceneField name) const;
+
+        /**
+         * @brief Add a field
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @p name isn't present yet. If @p name shares the
+         * object mapping with fields that already have entries, the entries
+         * get a default value for @p name, as described in
+         * @ref SceneTools-SceneBuilder-storage. Fields don't need to be
+         * added explicitly, @ref setFieldValue() and @ref addFieldValue()
+         * add them with a type matching the value on first use.
+         */
+        SceneBuilder& addField(Trade::SceneField name, Trade::SceneFieldType type, UnsignedShort arraySize = 0);
+
+        /**
+         * @brief Count of entries for given object in given field
+         *
+         * Expects that @p name is present and @p object is less than
+         * @ref mappingBound(). Returns @cpp 0 @ce if the object has no
+         * entries in the field.
+         */
+        std::size_t fieldSizeFor(Trade::SceneField name, UnsignedLong object) const;
+
+        /**
+         * @brief Field value for given object
+         *
+         * Expects that @p name is present, is not an array field, @p T
+         * corresponds to its type and @p object is less than
+         * @ref mappingBound(). If the object has more than one entry in the
+         * field, returns the most recently added one, if it has none, returns
+         * @relativeref{Corrade,Containers::NullOpt}.
+         */
+        template<class T> Containers::Optional<T> fieldValueFor(Trade::SceneField name, UnsignedLong object) const;
+
+        /**
+         * @brief Set a field value for given object
+         * @return Reference to self (for method chaining)
+         *
+         * If the object has no entry in @p name yet, adds one, if it has more
+         * than one, modifies the most recently added one. If @p name isn't
+         * present, it's added with a type corresponding to @p T first.
+         * Expects that @p name is not an array field, @p T corresponds to its
+         * type and @p object is less than @ref mappingBound().
+         * @see @ref addFieldValue()
+         */
+        template<class T> SceneBuilder& setFieldValue(Trade::SceneField name, UnsignedLong object, const T& value);
+
+        /**
+         * @brief Add a field value for given object
+         * @return Reference to self (for method chaining)
+         *
+         * Unlike @ref setFieldValue(), always adds a new entry, useful for
+         * example for objects having multiple meshes assigned. If @p name
+         * isn't present, it's added with a type corresponding to @p T first.
+         * Expects that @p name is not an array field, @p T corresponds to its
+         * type and @p object is less than @ref mappingBound().
+         */
+        template<class T> SceneBuilder& addFieldValue(Trade::SceneField name, UnsignedLong object, const T& value);
+
+        /**
+         * @brief Remove field values for given object
+         * @return Reference to self (for method chaining)
+         *
+         * Removes all entries of @p object in @p name. As the entries are
+         * shared among fields that share the object mapping, removing for
+         * example a @ref Trade::SceneField::Rotation of an object removes its
+         * @relativeref{Trade::SceneField,Translation} and
+         * @relativeref{Trade::SceneField,Scaling} as well. Expects that
+         * @p name is present and @p object is less than @ref mappingBound().
+         */
+        SceneBuilder& removeFieldValues(Trade::SceneField name, UnsignedLong object);
+
+        /**
+         * @brief Create a scene out of the builder contents
+         *
+         * Fields with no entries are not included. See
+         * @ref SceneTools-SceneBuilder-snapshot for more information.
+         */
+        Trade::SceneData toSceneData() const;
+
+    private:
+        struct State;
+
+        const void* fieldValueForInternal(Trade::SceneField name, Trade::SceneFieldType type, UnsignedLong object) const;
+        void setFieldValueInternal(Trade::SceneField name, Trade::SceneFieldType type, UnsignedLong object, const void* value, bool add);
+
+        Containers::Pointer<State> _state;
+};
+
+template<class T> Containers::Optional<T> SceneBuilder::fieldValueFor(const Trade::SceneField name, const UnsignedLong object) const {
+    if(const void* const value = fieldValueForInternal(name, Trade::Implementation::SceneFieldTypeFor<T>::type(), object))
+        return *static_cast<const T*>(value);
+    return {};
+}
+
+template<class T> SceneBuilder& SceneBuilder::setFieldValue(const Trade::SceneField name, const UnsignedLong object, const T& value) {
+    setFieldValueInternal(name, Trade::Implementation::SceneFieldTypeFor<T>::type(), object, &value, false);
+    return *this;
+}
+
+template<class T> SceneBuilder& SceneBuilder::addFieldValue(const Trade::SceneField name, const UnsignedLong object, const T& value) {
+    setFieldValueInternal(name, Trade::Implementation::SceneFieldTypeFor<T>::type(), object, &value, true);
+    return *this;
+}
+
+}}
+
+#endif
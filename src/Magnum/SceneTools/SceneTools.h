@@ -35,6 +35,8 @@
 namespace Magnum { namespace SceneTools {
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
+class FlatScene3D;
+class SceneBuilder;
 #endif
 
 }}
@@ -0,0 +1,246 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Animation/Player.h"
+#include "Magnum/Math/Complex.h"
+#include "Magnum/Math/CubicHermite.h"
+#include "Magnum/Math/Quaternion.h"
+#include "Magnum/SceneTools/BindAnimation.h"
+#include "Magnum/Trade/AnimationData.h"
+
+namespace Magnum { namespace SceneTools { namespace Test { namespace {
+
+struct BindAnimationTest: TestSuite::Tester {
+    explicit BindAnimationTest();
+
+    void bind3D();
+    void bind3DNanoseconds();
+    void bind2D();
+    void bindEmptyView();
+    void bindTargetOutOfRange();
+};
+
+using namespace Math::Literals;
+
+BindAnimationTest::BindAnimationTest() {
+    addTests({&BindAnimationTest::bind3D,
+              &BindAnimationTest::bind3DNanoseconds,
+              &BindAnimationTest::bind2D,
+              &BindAnimationTest::bindEmptyView,
+              &BindAnimationTest::bindTargetOutOfRange});
+}
+
+const struct Keyframe3D {
+    Float time;
+    Vector3 translation;
+    Quaternion rotation;
+    CubicHermite3D scaling;
+    Vector2 translation2D;
+} Keyframes3D[]{
+    {0.0f, {1.0f, 2.0f, 3.0f}, {},
+        {{}, Vector3{1.0f}, {}}, {}},
+    {1.0f, {4.0f, 5.0f, 6.0f}, Quaternion::rotation(90.0_degf, Vector3::yAxis()),
+        {{}, Vector3{2.0f}, {}}, {7.0f, 8.0f}},
+    {2.0f, {7.0f, 8.0f, 9.0f}, Quaternion::rotation(180.0_degf, Vector3::yAxis()),
+        {{}, Vector3{3.0f}, {}}, {9.0f, 10.0f}},
+};
+
+Trade::AnimationData animation3D() {
+    const Containers::StridedArrayView1D<const Keyframe3D> keyframes = Keyframes3D;
+    return Trade::AnimationData{{}, Keyframes3D, {
+        /* A translation of object 1 */
+        Trade::AnimationTrackData{Trade::AnimationTrackTargetType::Translation3D, 1,
+            Animation::TrackView<const Float, const Vector3>{
+                keyframes.slice(&Keyframe3D::time),
+                keyframes.slice(&Keyframe3D::translation),
+                Animation::Interpolation::Linear,
+                Trade::animationInterpolatorFor<Vector3>(Animation::Interpolation::Linear)}},
+        /* A 2D track, should be skipped */
+        Trade::AnimationTrackData{Trade::AnimationTrackTargetType::Translation2D, 0,
+            Animation::TrackView<const Float, const Vector2>{
+                keyframes.slice(&Keyframe3D::time),
+                keyframes.slice(&Keyframe3D::translation2D),
+                Animation::Interpolation::Linear,
+                Trade::animationInterpolatorFor<Vector2>(Animation::Interpolation::Linear)}},
+        /* A rotation of object 0 */
+        Trade::AnimationTrackData{Trade::AnimationTrackTargetType::Rotation3D, 0,
+            Animation::TrackView<const Float, const Quaternion>{
+                keyframes.slice(&Keyframe3D::time),
+                keyframes.slice(&Keyframe3D::rotation),
+                Animation::Interpolation::Linear,
+                Trade::animationInterpolatorFor<Quaternion>(Animation::Interpolation::Linear)}},
+        /* A custom track, should be skipped */
+        Trade::AnimationTrackData{Trade::AnimationTrackTargetType::Custom, 2,
+            Animation::TrackView<const Float, const Vector3>{
+                keyframes.slice(&Keyframe3D::time),
+                keyframes.slice(&Keyframe3D::translation),
+                Animation::Interpolation::Linear,
+                Trade::animationInterpolatorFor<Vector3>(Animation::Interpolation::Linear)}},
+        /* A spline scaling of object 2 */
+        Trade::AnimationTrackData{Trade::AnimationTrackTargetType::Scaling3D, 2,
+            Animation::TrackView<const Float, const CubicHermite3D>{
+                keyframes.slice(&Keyframe3D::time),
+                keyframes.slice(&Keyframe3D::scaling),
+                Animation::Interpolation::Spline,
+                Trade::animationInterpolatorFor<CubicHermite3D>(Animation::Interpolation::Spline)}},
+    }};
+}
+
+void BindAnimationTest::bind3D() {
+    Trade::AnimationData animation = animation3D();
+
+    Vector3 translations[3];
+    Quaternion rotations[3];
+    Vector3 scalings[3]{Vector3{1.0f}, Vector3{1.0f}, Vector3{1.0f}};
+
+    Animation::Player<Float> player;
+    CORRADE_COMPARE(bindAnimation3D(player, animation, translations, rotations, scalings), 3);
+    CORRADE_COMPARE(player.size(), 3);
+    CORRADE_COMPARE(player.duration(), (Range1D{0.0f, 2.0f}));
+
+    player.play(0.0f);
+    player.advance(1.0f);
+    CORRADE_COMPARE_AS(Containers::arrayView(translations), Containers::arrayView<Vector3>({
+        {}, {4.0f, 5.0f, 6.0f}, {}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(rotations), Containers::arrayView<Quaternion>({
+        Quaternion::rotation(90.0_degf, Vector3::yAxis()), {}, {}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(scalings), Containers::arrayView<Vector3>({
+        Vector3{1.0f}, Vector3{1.0f}, Vector3{2.0f}
+    }), TestSuite::Compare::Container);
+}
+
+void BindAnimationTest::bind3DNanoseconds() {
+    Trade::AnimationData animation = animation3D();
+
+    Vector3 translations[3];
+    Quaternion rotations[3];
+    Vector3 scalings[3];
+
+    Animation::Player<std::chrono::nanoseconds, Float> player;
+    CORRADE_COMPARE(bindAnimation3D(player, animation, translations, rotations, scalings), 3);
+
+    player.play(std::chrono::nanoseconds{});
+    player.advance(std::chrono::seconds{1});
+    CORRADE_COMPARE(translations[1], (Vector3{4.0f, 5.0f, 6.0f}));
+    CORRADE_COMPARE(rotations[0], Quaternion::rotation(90.0_degf, Vector3::yAxis()));
+    CORRADE_COMPARE(scalings[2], Vector3{2.0f});
+}
+
+void BindAnimationTest::bind2D() {
+    const struct Keyframe {
+        Float time;
+        Vector2 translation;
+        Complex rotation;
+        Vector2 scaling;
+    } keyframeData[]{
+        {0.0f, {1.0f, 2.0f}, {}, Vector2{1.0f}},
+        {1.0f, {3.0f, 4.0f}, Complex::rotation(90.0_degf), Vector2{2.0f}}
+    };
+    const Containers::StridedArrayView1D<const Keyframe> keyframes = keyframeData;
+
+    Trade::AnimationData animation{{}, keyframeData, {
+        Trade::AnimationTrackData{Trade::AnimationTrackTargetType::Scaling2D, 0,
+            Animation::TrackView<const Float, const Vector2>{
+                keyframes.slice(&Keyframe::time),
+                keyframes.slice(&Keyframe::scaling),
+                Animation::Interpolation::Linear,
+                Trade::animationInterpolatorFor<Vector2>(Animation::Interpolation::Linear)}},
+        Trade::AnimationTrackData{Trade::AnimationTrackTargetType::Rotation2D, 1,
+            Animation::TrackView<const Float, const Complex>{
+                keyframes.slice(&Keyframe::time),
+                keyframes.slice(&Keyframe::rotation),
+                Animation::Interpolation::Constant,
+                Trade::animationInterpolatorFor<Complex>(Animation::Interpolation::Constant)}},
+        /* A 3D track, should be skipped */
+        Trade::AnimationTrackData{Trade::AnimationTrackTargetType::Translation3D, 0,
+            Animation::TrackView<const Float, const Vector2>{
+                keyframes.slice(&Keyframe::time),
+                keyframes.slice(&Keyframe::translation),
+                Animation::Interpolation::Linear,
+                Trade::animationInterpolatorFor<Vector2>(Animation::Interpolation::Linear)}},
+        Trade::AnimationTrackData{Trade::AnimationTrackTargetType::Translation2D, 1,
+            Animation::TrackView<const Float, const Vector2>{
+                keyframes.slice(&Keyframe::time),
+                keyframes.slice(&Keyframe::translation),
+                Animation::Interpolation::Linear,
+                Trade::animationInterpolatorFor<Vector2>(Animation::Interpolation::Linear)}},
+    }};
+
+    Vector2 translations[2];
+    Complex rotations[2];
+    Vector2 scalings[2];
+
+    Animation::Player<Float> player;
+    CORRADE_COMPARE(bindAnimation2D(player, animation, translations, rotations, scalings), 3);
+
+    player.play(0.0f);
+    player.advance(0.5f);
+    CORRADE_COMPARE(translations[0], Vector2{});
+    CORRADE_COMPARE(translations[1], (Vector2{2.0f, 3.0f}));
+    CORRADE_COMPARE(rotations[1], Complex{});
+    CORRADE_COMPARE(scalings[0], Vector2{1.5f});
+}
+
+void BindAnimationTest::bindEmptyView() {
+    Trade::AnimationData animation = animation3D();
+
+    Vector3 translations[3];
+    Vector3 scalings[3];
+
+    /* Rotations are not wanted, so the track is skipped */
+    Animation::Player<Float> player;
+    CORRADE_COMPARE(bindAnimation3D(player, animation, translations, nullptr, scalings), 2);
+    CORRADE_COMPARE(player.size(), 2);
+}
+
+void BindAnimationTest::bindTargetOutOfRange() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Trade::AnimationData animation = animation3D();
+
+    Vector3 translations[3];
+    Quaternion rotations[3];
+    Vector3 scalings[2];
+
+    Animation::Player<Float> player;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    bindAnimation3D(player, animation, translations, rotations, scalings);
+    CORRADE_COMPARE(out.str(),
+        "SceneTools::bindAnimation3D(): track 4 targets object 2 but only 2 scalings were passed\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneTools::Test::BindAnimationTest)
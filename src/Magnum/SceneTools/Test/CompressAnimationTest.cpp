@@ -0,0 +1,266 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Packing.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Animation/Quantization.h"
+#include "Magnum/SceneTools/CompressAnimation.h"
+
+namespace Magnum { namespace SceneTools { namespace Test { namespace {
+
+struct CompressAnimationTest: TestSuite::Tester {
+    explicit CompressAnimationTest();
+
+    void reduceKeyframesLinear();
+    void reduceKeyframesNonLinear();
+    void reduceKeyframesZeroError();
+    void reduceKeyframesQuaternion();
+    void reduceKeyframesEmpty();
+    void reduceKeyframesSingle();
+    void reduceKeyframesInvalid();
+
+    void quantizeRange();
+    void quantizeRangeConstantDimension();
+    void quantizeRangeEmpty();
+    void quantizeRangeInvalidSize();
+
+    void packQuaternionSmallestThree();
+    void packQuaternionSmallestThreeInvalidSize();
+};
+
+using namespace Math::Literals;
+
+CompressAnimationTest::CompressAnimationTest() {
+    addTests({&CompressAnimationTest::reduceKeyframesLinear,
+              &CompressAnimationTest::reduceKeyframesNonLinear,
+              &CompressAnimationTest::reduceKeyframesZeroError,
+              &CompressAnimationTest::reduceKeyframesQuaternion,
+              &CompressAnimationTest::reduceKeyframesEmpty,
+              &CompressAnimationTest::reduceKeyframesSingle,
+              &CompressAnimationTest::reduceKeyframesInvalid,
+
+              &CompressAnimationTest::quantizeRange,
+              &CompressAnimationTest::quantizeRangeConstantDimension,
+              &CompressAnimationTest::quantizeRangeEmpty,
+              &CompressAnimationTest::quantizeRangeInvalidSize,
+
+              &CompressAnimationTest::packQuaternionSmallestThree,
+              &CompressAnimationTest::packQuaternionSmallestThreeInvalidSize});
+}
+
+void CompressAnimationTest::reduceKeyframesLinear() {
+    /* Non-uniformly spaced keys but the motion is linear, so only the first
+       and last keyframe should be kept */
+    const Float keys[]{0.0f, 0.5f, 1.5f, 2.0f, 4.0f};
+    Vector3 values[5];
+    for(std::size_t i = 0; i != 5; ++i)
+        values[i] = Vector3{1.0f, -2.0f, 0.5f}*keys[i] + Vector3{3.0f};
+
+    CORRADE_COMPARE_AS(reduceKeyframes(keys, values, 0.001f),
+        Containers::arrayView<UnsignedInt>({0, 4}),
+        TestSuite::Compare::Container);
+}
+
+void CompressAnimationTest::reduceKeyframesNonLinear() {
+    /* Two linear segments with a sharp turn in the middle, the turn has to be
+       kept. The small jitter in the second segment is below the threshold. */
+    const Float keys[]{0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f};
+    const Vector3 values[]{
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {2.0f, 0.0f, 0.0f},
+        {2.0f, 1.0f, 0.0f},
+        {2.0f, 2.005f, 0.0f},
+        {2.0f, 3.0f, 0.0f},
+    };
+
+    CORRADE_COMPARE_AS(reduceKeyframes(keys, values, 0.01f),
+        Containers::arrayView<UnsignedInt>({0, 2, 5}),
+        TestSuite::Compare::Container);
+
+    /* With a smaller threshold the jitter is preserved */
+    CORRADE_COMPARE_AS(reduceKeyframes(keys, values, 0.001f),
+        Containers::arrayView<UnsignedInt>({0, 2, 3, 4, 5}),
+        TestSuite::Compare::Container);
+}
+
+void CompressAnimationTest::reduceKeyframesZeroError() {
+    /* Exactly linear values are removed even with zero error */
+    const Float keys[]{0.0f, 1.0f, 2.0f, 3.0f};
+    const Vector3 values[]{
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 2.0f, 4.0f},
+        {2.0f, 4.0f, 8.0f},
+        {2.0f, 4.0f, 9.0f},
+    };
+
+    CORRADE_COMPARE_AS(reduceKeyframes(keys, values, 0.0f),
+        Containers::arrayView<UnsignedInt>({0, 2, 3}),
+        TestSuite::Compare::Container);
+}
+
+void CompressAnimationTest::reduceKeyframesQuaternion() {
+    /* Constant angular velocity around one axis, then a change of the axis */
+    const Float keys[]{0.0f, 1.0f, 2.0f, 3.0f, 4.0f};
+    const Quaternion values[]{
+        Quaternion::rotation(0.0_degf, Vector3::yAxis()),
+        Quaternion::rotation(20.0_degf, Vector3::yAxis()),
+        Quaternion::rotation(40.0_degf, Vector3::yAxis()),
+        Quaternion::rotation(60.0_degf, Vector3::yAxis()),
+        Quaternion::rotation(30.0_degf, Vector3::xAxis())*
+            Quaternion::rotation(60.0_degf, Vector3::yAxis()),
+    };
+
+    CORRADE_COMPARE_AS(reduceKeyframes(keys, values, Rad(0.5_degf)),
+        Containers::arrayView<UnsignedInt>({0, 3, 4}),
+        TestSuite::Compare::Container);
+}
+
+void CompressAnimationTest::reduceKeyframesEmpty() {
+    CORRADE_COMPARE_AS(reduceKeyframes(Containers::StridedArrayView1D<const Float>{}, Containers::StridedArrayView1D<const Vector3>{}, 0.1f),
+        Containers::arrayView<UnsignedInt>({}),
+        TestSuite::Compare::Container);
+}
+
+void CompressAnimationTest::reduceKeyframesSingle() {
+    const Float keys[]{1.0f};
+    const Quaternion values[]{Quaternion::rotation(35.0_degf, Vector3::zAxis())};
+
+    CORRADE_COMPARE_AS(reduceKeyframes(keys, values, Rad(1.0_degf)),
+        Containers::arrayView<UnsignedInt>({0}),
+        TestSuite::Compare::Container);
+}
+
+void CompressAnimationTest::reduceKeyframesInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const Float keys[3]{};
+    const Vector3 values[2]{};
+    const Vector3 values3[3]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    reduceKeyframes(keys, values, 0.1f);
+    reduceKeyframes(keys, values3, -0.1f);
+    CORRADE_COMPARE(out.str(),
+        "SceneTools::reduceKeyframes(): expected 3 values but got 2\n"
+        "SceneTools::reduceKeyframes(): expected a non-negative error but got -0.1\n");
+}
+
+void CompressAnimationTest::quantizeRange() {
+    const Vector3 values[]{
+        {-10.0f, 5.0f, 100.0f},
+        {30.0f, 7.5f, 100.25f},
+        {10.0f, 10.0f, 100.5f},
+    };
+
+    Vector3us quantized[3];
+    const Range3D range = quantizeRangeInto(values, quantized);
+    CORRADE_COMPARE(range, (Range3D{{-10.0f, 5.0f, 100.0f}, {30.0f, 10.0f, 100.5f}}));
+
+    /* Range bounds are stored exactly */
+    CORRADE_COMPARE(quantized[0], (Vector3us{0, 0, 0}));
+    CORRADE_COMPARE(quantized[1], (Vector3us{65535, 32768, 32768}));
+    CORRADE_COMPARE(quantized[2], (Vector3us{32768, 65535, 65535}));
+
+    /* Reconstruction is precise to a fraction of the range size */
+    for(std::size_t i = 0; i != 3; ++i) {
+        CORRADE_ITERATION(i);
+        const Vector3 reconstructed = Math::lerp(range.min(), range.max(), Math::unpack<Vector3>(quantized[i]));
+        CORRADE_COMPARE_AS(Math::abs(reconstructed - values[i]).max(), 0.001f,
+            TestSuite::Compare::Less);
+    }
+}
+
+void CompressAnimationTest::quantizeRangeConstantDimension() {
+    /* If all values are the same in some dimension, it shouldn't produce a
+       NaN */
+    const Vector3 values[]{
+        {1.0f, 5.0f, 3.0f},
+        {2.0f, 5.0f, 3.0f},
+    };
+
+    Vector3us quantized[2];
+    const Range3D range = quantizeRangeInto(values, quantized);
+    CORRADE_COMPARE(range, (Range3D{{1.0f, 5.0f, 3.0f}, {2.0f, 5.0f, 3.0f}}));
+    CORRADE_COMPARE(quantized[0], (Vector3us{0, 0, 0}));
+    CORRADE_COMPARE(quantized[1], (Vector3us{65535, 0, 0}));
+    CORRADE_COMPARE(Math::lerp(range.min(), range.max(), Math::unpack<Vector3>(quantized[1])), values[1]);
+}
+
+void CompressAnimationTest::quantizeRangeEmpty() {
+    CORRADE_COMPARE(quantizeRangeInto(Containers::StridedArrayView1D<const Vector3>{}, Containers::StridedArrayView1D<Vector3us>{}), Range3D{});
+}
+
+void CompressAnimationTest::quantizeRangeInvalidSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const Vector3 values[3]{};
+    Vector3us quantized[2];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    quantizeRangeInto(values, quantized);
+    CORRADE_COMPARE(out.str(), "SceneTools::quantizeRangeInto(): expected destination view with 3 elements but got 2\n");
+}
+
+void CompressAnimationTest::packQuaternionSmallestThree() {
+    const Quaternion values[]{
+        Quaternion::rotation(35.0_degf, Vector3::zAxis()),
+        Quaternion::rotation(150.0_degf, Vector3::xAxis()),
+        -Quaternion::rotation(75.0_degf, Vector3{1.0f, 1.0f, 0.0f}.normalized()),
+    };
+
+    UnsignedInt packed[3];
+    packQuaternionSmallestThreeInto(values, packed);
+    for(std::size_t i = 0; i != 3; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(packed[i], Animation::packQuaternionSmallestThree(values[i]));
+    }
+}
+
+void CompressAnimationTest::packQuaternionSmallestThreeInvalidSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const Quaternion values[3]{};
+    UnsignedInt packed[4];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    packQuaternionSmallestThreeInto(values, packed);
+    CORRADE_COMPARE(out.str(), "SceneTools::packQuaternionSmallestThreeInto(): expected destination view with 3 elements but got 4\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneTools::Test::CompressAnimationTest)
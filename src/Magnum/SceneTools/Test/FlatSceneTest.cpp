@@ -0,0 +1,323 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/BitArray.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/SceneTools/FlatScene.h"
+#include "Magnum/Trade/SceneData.h"
+
+namespace Magnum { namespace SceneTools { namespace Test { namespace {
+
+struct FlatSceneTest: TestSuite::Tester {
+    explicit FlatSceneTest();
+
+    void construct();
+    void constructNoMeshField();
+    void constructInvalid();
+    void constructMove();
+
+    void update();
+    void cull();
+    void cullInvalid();
+    void drawList();
+    void drawListInvalid();
+};
+
+using namespace Math::Literals;
+
+FlatSceneTest::FlatSceneTest() {
+    addTests({&FlatSceneTest::construct,
+              &FlatSceneTest::constructNoMeshField,
+              &FlatSceneTest::constructInvalid,
+              &FlatSceneTest::constructMove,
+
+              &FlatSceneTest::update,
+              &FlatSceneTest::cull,
+              &FlatSceneTest::cullInvalid,
+              &FlatSceneTest::drawList,
+              &FlatSceneTest::drawListInvalid});
+}
+
+/*
+      0T      3M
+     / \
+    1TM 2MM         4T (not in the hierarchy)
+*/
+const struct Data {
+    struct Parent {
+        UnsignedInt object;
+        Int parent;
+    } parents[4];
+    struct Transformation {
+        UnsignedInt object;
+        Matrix4 transformation;
+    } transforms[3];
+    struct Mesh {
+        UnsignedInt object;
+        UnsignedInt mesh;
+        Int meshMaterial;
+    } meshes[4];
+} SceneDataStorage[]{{
+    {{2, 0},
+     {0, -1},
+     {3, -1},
+     {1, 0}},
+    {{1, Matrix4::scaling({2.0f, 2.0f, 2.0f})},
+     {0, Matrix4::translation({0.0f, 0.0f, -10.0f})},
+     {4, Matrix4::translation({5.0f, 0.0f, 0.0f})}},
+    {{2, 3, 7},
+     {1, 0, -1},
+     {3, 1, 2},
+     {2, 0, 5}}
+}};
+
+Trade::SceneData sceneData(bool meshes = true) {
+    const Data& data = SceneDataStorage[0];
+    Trade::SceneFieldData parents{Trade::SceneField::Parent,
+        Containers::stridedArrayView(data.parents).slice(&Data::Parent::object),
+        Containers::stridedArrayView(data.parents).slice(&Data::Parent::parent)};
+    Trade::SceneFieldData transformations{Trade::SceneField::Transformation,
+        Containers::stridedArrayView(data.transforms).slice(&Data::Transformation::object),
+        Containers::stridedArrayView(data.transforms).slice(&Data::Transformation::transformation)};
+    if(!meshes) return Trade::SceneData{Trade::SceneMappingType::UnsignedInt, 5, {}, SceneDataStorage, {
+        parents, transformations
+    }};
+
+    return Trade::SceneData{Trade::SceneMappingType::UnsignedInt, 5, {}, SceneDataStorage, {
+        parents, transformations,
+        Trade::SceneFieldData{Trade::SceneField::Mesh,
+            Containers::stridedArrayView(data.meshes).slice(&Data::Mesh::object),
+            Containers::stridedArrayView(data.meshes).slice(&Data::Mesh::mesh)},
+        Trade::SceneFieldData{Trade::SceneField::MeshMaterial,
+            Containers::stridedArrayView(data.meshes).slice(&Data::Mesh::object),
+            Containers::stridedArrayView(data.meshes).slice(&Data::Mesh::meshMaterial)}
+    }};
+}
+
+void FlatSceneTest::construct() {
+    FlatScene3D flat{sceneData()};
+    CORRADE_COMPARE(flat.objectCount(), 5);
+    CORRADE_COMPARE_AS(flat.parents(), Containers::arrayView<Int>({
+        -1, 0, 0, -1, -2
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(flat.localTransformations(), Containers::arrayView<Matrix4>({
+        Matrix4::translation({0.0f, 0.0f, -10.0f}),
+        Matrix4::scaling({2.0f, 2.0f, 2.0f}),
+        Matrix4{},
+        Matrix4{},
+        Matrix4::translation({5.0f, 0.0f, 0.0f})
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(flat.absoluteTransformations(), Containers::arrayView<Matrix4>({
+        Matrix4::translation({0.0f, 0.0f, -10.0f}),
+        Matrix4::translation({0.0f, 0.0f, -10.0f})*Matrix4::scaling({2.0f, 2.0f, 2.0f}),
+        Matrix4::translation({0.0f, 0.0f, -10.0f}),
+        Matrix4{},
+        /* Not a part of the hierarchy, gets the local transformation */
+        Matrix4::translation({5.0f, 0.0f, 0.0f})
+    }), TestSuite::Compare::Container);
+
+    CORRADE_COMPARE(flat.drawCount(), 4);
+    CORRADE_COMPARE_AS(flat.drawObjects(), Containers::arrayView<UnsignedInt>({
+        2, 1, 3, 2
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(flat.drawMeshes(), Containers::arrayView<UnsignedInt>({
+        3, 0, 1, 0
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(flat.drawMaterials(), Containers::arrayView<Int>({
+        7, -1, 2, 5
+    }), TestSuite::Compare::Container);
+}
+
+void FlatSceneTest::constructNoMeshField() {
+    FlatScene3D flat{sceneData(false)};
+    CORRADE_COMPARE(flat.objectCount(), 5);
+    CORRADE_COMPARE(flat.drawCount(), 0);
+    CORRADE_VERIFY(flat.drawObjects().isEmpty());
+    CORRADE_VERIFY(flat.drawMeshes().isEmpty());
+    CORRADE_VERIFY(flat.drawMaterials().isEmpty());
+
+    /* Culling and draw list should work with no draws as well */
+    CORRADE_COMPARE(flat.cull(Matrix4{}, nullptr, nullptr), 0);
+    CORRADE_COMPARE(flat.drawListInto(nullptr, nullptr), 0);
+}
+
+void FlatSceneTest::constructInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Trade::SceneData notDimensions{Trade::SceneMappingType::UnsignedInt, 0, nullptr, {}};
+    Trade::SceneData noHierarchy{Trade::SceneMappingType::UnsignedInt, 0, nullptr, {
+        Trade::SceneFieldData{Trade::SceneField::Transformation, Trade::SceneMappingType::UnsignedInt, nullptr, Trade::SceneFieldType::Matrix4x4, nullptr}
+    }};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    FlatScene3D{notDimensions};
+    FlatScene3D{noHierarchy};
+    CORRADE_COMPARE(out.str(),
+        "SceneTools::FlatScene3D: the scene is not 3D\n"
+        "SceneTools::FlatScene3D: the scene has no hierarchy\n");
+}
+
+void FlatSceneTest::constructMove() {
+    FlatScene3D a{sceneData()};
+
+    FlatScene3D b{std::move(a)};
+    CORRADE_COMPARE(b.objectCount(), 5);
+    CORRADE_COMPARE(b.drawCount(), 4);
+
+    FlatScene3D c{sceneData(false)};
+    c = std::move(b);
+    CORRADE_COMPARE(c.objectCount(), 5);
+    CORRADE_COMPARE(c.drawCount(), 4);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<FlatScene3D>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<FlatScene3D>::value);
+}
+
+void FlatSceneTest::update() {
+    FlatScene3D flat{sceneData()};
+
+    flat.localTransformations()[0] = Matrix4::translation({1.0f, 0.0f, 0.0f});
+    flat.localTransformations()[4] = Matrix4::rotationX(90.0_degf);
+
+    /* Absolute transformations don't change until update() is called */
+    CORRADE_COMPARE(flat.absoluteTransformations()[2], Matrix4::translation({0.0f, 0.0f, -10.0f}));
+
+    flat.update(Matrix4::scaling({3.0f, 3.0f, 3.0f}));
+    CORRADE_COMPARE_AS(flat.absoluteTransformations(), Containers::arrayView<Matrix4>({
+        Matrix4::scaling({3.0f, 3.0f, 3.0f})*Matrix4::translation({1.0f, 0.0f, 0.0f}),
+        Matrix4::scaling({3.0f, 3.0f, 3.0f})*Matrix4::translation({1.0f, 0.0f, 0.0f})*Matrix4::scaling({2.0f, 2.0f, 2.0f}),
+        Matrix4::scaling({3.0f, 3.0f, 3.0f})*Matrix4::translation({1.0f, 0.0f, 0.0f}),
+        Matrix4::scaling({3.0f, 3.0f, 3.0f}),
+        /* Global transformation not applied to objects outside of the
+           hierarchy */
+        Matrix4::rotationX(90.0_degf)
+    }), TestSuite::Compare::Container);
+}
+
+void FlatSceneTest::cull() {
+    FlatScene3D flat{sceneData()};
+
+    /* Objects 1 and 2 are at Z = -10, object 3 at the origin. Mesh 0 and 3
+       are unit cubes around the origin, mesh 1 is far to the side, mesh 2
+       isn't referenced at all. */
+    const Range3D meshBounds[]{
+        {Vector3{-1.0f}, Vector3{1.0f}},
+        {{100.0f, -1.0f, -1.0f}, {102.0f, 1.0f, 1.0f}},
+        {},
+        {Vector3{-1.0f}, Vector3{1.0f}},
+    };
+
+    Containers::BitArray visible{DirectInit, 4, false};
+    const Matrix4 projection = Matrix4::perspectiveProjection(60.0_degf, 1.0f, 0.1f, 100.0f);
+    CORRADE_COMPARE(flat.cull(projection, meshBounds, visible), 3);
+    CORRADE_VERIFY(visible[0]);
+    CORRADE_VERIFY(visible[1]);
+    /* Off to the side and behind the near plane */
+    CORRADE_VERIFY(!visible[2]);
+    CORRADE_VERIFY(visible[3]);
+
+    /* Moving the object 0 behind the camera moves its children as well, the
+       previously set bits get reset */
+    flat.localTransformations()[0] = Matrix4::translation({0.0f, 0.0f, 10.0f});
+    flat.update();
+    CORRADE_COMPARE(flat.cull(projection, meshBounds, visible), 0);
+    CORRADE_VERIFY(!visible[0]);
+    CORRADE_VERIFY(!visible[1]);
+    CORRADE_VERIFY(!visible[2]);
+    CORRADE_VERIFY(!visible[3]);
+
+    /* Scaling the object 1 makes its mesh large enough to reach into the
+       view again */
+    flat.localTransformations()[1] = Matrix4::scaling(Vector3{20.0f});
+    flat.update();
+    CORRADE_COMPARE(flat.cull(projection, meshBounds, visible), 1);
+    CORRADE_VERIFY(visible[1]);
+}
+
+void FlatSceneTest::cullInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    FlatScene3D flat{sceneData()};
+    const Range3D meshBounds[4]{};
+    Containers::BitArray visible{ValueInit, 4};
+    Containers::BitArray visibleTooSmall{ValueInit, 3};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    flat.cull({}, meshBounds, visibleTooSmall);
+    flat.cull({}, Containers::arrayView(meshBounds).exceptSuffix(1), visible);
+    CORRADE_COMPARE(out.str(),
+        "SceneTools::FlatScene3D::cull(): expected 4 visibility bits but got 3\n"
+        "SceneTools::FlatScene3D::cull(): mesh 3 out of bounds for 3 mesh bounds\n");
+}
+
+void FlatSceneTest::drawList() {
+    FlatScene3D flat{sceneData()};
+
+    /* Meshes of the draws are 3, 0, 1, 0 */
+    Containers::BitArray visible{DirectInit, 4, true};
+    UnsignedInt drawList[4];
+    CORRADE_COMPARE(flat.drawListInto(visible, drawList), 4);
+    CORRADE_COMPARE_AS(Containers::arrayView(drawList), Containers::arrayView<UnsignedInt>({
+        1, 3, 2, 0
+    }), TestSuite::Compare::Container);
+
+    /* Invisible draws are skipped, the output can be larger than needed */
+    visible.reset(1);
+    visible.reset(2);
+    CORRADE_COMPARE(flat.drawListInto(visible, drawList), 2);
+    CORRADE_COMPARE_AS(Containers::arrayView(drawList).prefix(2), Containers::arrayView<UnsignedInt>({
+        3, 0
+    }), TestSuite::Compare::Container);
+}
+
+void FlatSceneTest::drawListInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    FlatScene3D flat{sceneData()};
+    Containers::BitArray visible{DirectInit, 4, true};
+    Containers::BitArray visibleTooSmall{DirectInit, 3, true};
+    UnsignedInt drawList[4];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    flat.drawListInto(visibleTooSmall, drawList);
+    flat.drawListInto(visible, Containers::arrayView(drawList).exceptSuffix(1));
+    CORRADE_COMPARE(out.str(),
+        "SceneTools::FlatScene3D::drawListInto(): expected 4 visibility bits but got 3\n"
+        "SceneTools::FlatScene3D::drawListInto(): draw list with 3 items too small for all visible draws\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneTools::Test::FlatSceneTest)
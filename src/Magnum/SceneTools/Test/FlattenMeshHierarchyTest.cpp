@@ -24,6 +24,7 @@
 */
 
 #include <sstream>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Containers/Triple.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
@@ -44,6 +45,12 @@ struct FlattenMeshHierarchyTest: TestSuite::Tester {
     void not2DNot3D();
     void noParentField();
     void noMeshField();
+
+    void transformationHierarchy3D();
+    void transformationHierarchy3DParallel();
+    void transformationHierarchy3DIncremental();
+    void transformationHierarchy2DIncremental();
+    void transformationHierarchyInvalid();
 };
 
 using namespace Math::Literals;
@@ -86,7 +93,13 @@ FlattenMeshHierarchyTest::FlattenMeshHierarchyTest() {
 
     addTests({&FlattenMeshHierarchyTest::not2DNot3D,
               &FlattenMeshHierarchyTest::noParentField,
-              &FlattenMeshHierarchyTest::noMeshField});
+              &FlattenMeshHierarchyTest::noMeshField,
+
+              &FlattenMeshHierarchyTest::transformationHierarchy3D,
+              &FlattenMeshHierarchyTest::transformationHierarchy3DParallel,
+              &FlattenMeshHierarchyTest::transformationHierarchy3DIncremental,
+              &FlattenMeshHierarchyTest::transformationHierarchy2DIncremental,
+              &FlattenMeshHierarchyTest::transformationHierarchyInvalid});
 }
 
 void FlattenMeshHierarchyTest::test2D() {
@@ -406,6 +419,231 @@ void FlattenMeshHierarchyTest::noMeshField() {
         TestSuite::Compare::Container);
 }
 
+void FlattenMeshHierarchyTest::transformationHierarchy3D() {
+    /*
+            1T      6       7T
+           / \
+          5T  2
+          |
+          3T
+    */
+    struct Data {
+        struct Parent {
+            UnsignedInt object;
+            Int parent;
+        } parents[4];
+
+        struct Transformation {
+            UnsignedInt object;
+            Matrix4 transformation;
+        } transforms[4];
+    } data[]{{
+        {{3, 5},
+         {5, 1},
+         {1, -1},
+         {2, 1}},
+        {{1, Matrix4::translation({1.0f, -1.5f, 0.5f})},
+         {5, Matrix4::rotationZ(35.0_degf)},
+         {3, Matrix4::scaling({3.0f, 5.0f, 2.0f})},
+         /* Not part of the hierarchy */
+         {7, Matrix4::translation({2.0f, 1.0f, 4.0f})}}
+    }};
+
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedInt, 8, {}, data, {
+        Trade::SceneFieldData{Trade::SceneField::Parent,
+            Containers::stridedArrayView(data->parents).slice(&Data::Parent::object),
+            Containers::stridedArrayView(data->parents).slice(&Data::Parent::parent)},
+        Trade::SceneFieldData{Trade::SceneField::Transformation,
+            Containers::stridedArrayView(data->transforms).slice(&Data::Transformation::object),
+            Containers::stridedArrayView(data->transforms).slice(&Data::Transformation::transformation)}
+    }};
+
+    const Matrix4 global = Matrix4::scaling(Vector3{0.5f});
+    Matrix4 out[8];
+    flattenTransformationHierarchy3DInto(scene, out, global);
+    CORRADE_COMPARE_AS(Containers::arrayView(out), Containers::arrayView<Matrix4>({
+        {},
+        global*Matrix4::translation({1.0f, -1.5f, 0.5f}),
+        global*Matrix4::translation({1.0f, -1.5f, 0.5f}),
+        global*Matrix4::translation({1.0f, -1.5f, 0.5f})*
+               Matrix4::rotationZ(35.0_degf)*
+               Matrix4::scaling({3.0f, 5.0f, 2.0f}),
+        {},
+        global*Matrix4::translation({1.0f, -1.5f, 0.5f})*
+               Matrix4::rotationZ(35.0_degf),
+        {},
+        /* Not part of the hierarchy, so global transformation not applied */
+        Matrix4::translation({2.0f, 1.0f, 4.0f})
+    }), TestSuite::Compare::Container);
+}
+
+struct Node {
+    UnsignedInt object;
+    Int parent;
+    Matrix4 transformation;
+};
+
+/* A root with 64 children, each having 128 children, making the last level
+   large enough to be processed in parallel */
+Containers::Array<Node> wideHierarchy() {
+    Containers::Array<Node> nodes{NoInit, 1 + 64 + 64*128};
+    nodes[0] = {0, -1, Matrix4::rotationX(15.0_degf)};
+    for(UnsignedInt i = 0; i != 64; ++i)
+        nodes[1 + i] = {1 + i, 0, Matrix4::translation({Float(i), 0.0f, 1.0f})*Matrix4::rotationY(Deg(i))};
+    for(UnsignedInt i = 0; i != 64*128; ++i)
+        nodes[65 + i] = {65 + i, Int(1 + i/128), Matrix4::scaling(Vector3{1.0f + i%7})*Matrix4::translation({0.0f, Float(i%128), 0.0f})};
+    return nodes;
+}
+
+Trade::SceneData wideHierarchyScene(const Containers::ArrayView<Node> nodes) {
+    return Trade::SceneData{Trade::SceneMappingType::UnsignedInt, nodes.size(), {}, nodes, {
+        Trade::SceneFieldData{Trade::SceneField::Parent,
+            Containers::stridedArrayView(nodes).slice(&Node::object),
+            Containers::stridedArrayView(nodes).slice(&Node::parent)},
+        Trade::SceneFieldData{Trade::SceneField::Transformation,
+            Containers::stridedArrayView(nodes).slice(&Node::object),
+            Containers::stridedArrayView(nodes).slice(&Node::transformation)},
+        Trade::SceneFieldData{Trade::SceneField::Mesh,
+            Containers::stridedArrayView(nodes).slice(&Node::object),
+            Containers::stridedArrayView(nodes).slice(&Node::object)}
+    }};
+}
+
+void FlattenMeshHierarchyTest::transformationHierarchy3DParallel() {
+    Containers::Array<Node> nodes = wideHierarchy();
+    Trade::SceneData scene = wideHierarchyScene(nodes);
+
+    const Matrix4 global = Matrix4::translation({0.0f, 0.0f, -5.0f});
+    Containers::Array<Matrix4> expected{NoInit, nodes.size()};
+    flattenTransformationHierarchy3DInto(scene, stridedArrayView(expected), global);
+    /* Verify that the sequential variant actually calculated something */
+    CORRADE_COMPARE(expected[65 + 200], global*nodes[0].transformation*nodes[2].transformation*nodes[65 + 200].transformation);
+
+    Containers::Array<Matrix4> out{NoInit, nodes.size()};
+    flattenTransformationHierarchy3DInto(scene, stridedArrayView(out), global, 4);
+    CORRADE_COMPARE_AS(out, expected, TestSuite::Compare::Container);
+
+    /* The mesh variant should give back the same */
+    Containers::Array<Containers::Triple<UnsignedInt, Int, Matrix4>> meshes = flattenMeshHierarchy3D(scene, global, 4);
+    CORRADE_COMPARE_AS(stridedArrayView(meshes).slice(&Containers::Triple<UnsignedInt, Int, Matrix4>::third),
+        Containers::stridedArrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void FlattenMeshHierarchyTest::transformationHierarchy3DIncremental() {
+    Containers::Array<Node> nodes = wideHierarchy();
+    Trade::SceneData scene = wideHierarchyScene(nodes);
+
+    const Matrix4 global = Matrix4::translation({0.0f, 0.0f, -5.0f});
+    Containers::Array<Matrix4> out{NoInit, nodes.size()};
+    flattenTransformationHierarchy3DInto(scene, stridedArrayView(out), global);
+
+    /* Modify a subtree root, a node inside that subtree and a leaf elsewhere.
+       The scene references the data directly, so the change is visible. */
+    nodes[3].transformation = Matrix4::rotationZ(-45.0_degf);
+    nodes[65 + 2*128 + 5].transformation = Matrix4::scaling(Vector3{0.25f});
+    nodes[65 + 30*128 + 7].transformation = Matrix4::translation(Vector3{7.0f});
+    /* Poison a transformation outside of the modified subtrees to verify
+       it's not recalculated */
+    out[65 + 10*128] = Matrix4{Math::ZeroInit};
+    const UnsignedInt dirty[]{
+        65 + 2*128 + 5, 3, 65 + 30*128 + 7, 3
+    };
+    flattenTransformationHierarchy3DInto(scene, dirty, stridedArrayView(out), global);
+
+    Containers::Array<Matrix4> expected{NoInit, nodes.size()};
+    flattenTransformationHierarchy3DInto(scene, stridedArrayView(expected), global);
+    CORRADE_COMPARE(out[65 + 10*128], Matrix4{Math::ZeroInit});
+    expected[65 + 10*128] = Matrix4{Math::ZeroInit};
+    CORRADE_COMPARE_AS(out, expected, TestSuite::Compare::Container);
+}
+
+void FlattenMeshHierarchyTest::transformationHierarchy2DIncremental() {
+    /*
+            1T      3T
+           / \
+          2T  0T
+    */
+    struct Data {
+        struct Parent {
+            UnsignedShort object;
+            Byte parent;
+        } parents[3];
+
+        struct Transformation {
+            UnsignedShort object;
+            Matrix3 transformation;
+        } transforms[4];
+    } data[]{{
+        {{2, 1},
+         {0, 1},
+         {1, -1}},
+        {{1, Matrix3::translation({1.0f, -1.5f})},
+         {2, Matrix3::rotation(35.0_degf)},
+         {0, Matrix3::scaling({3.0f, 5.0f})},
+         /* Not part of the hierarchy */
+         {3, Matrix3::translation({2.0f, 1.0f})}}
+    }};
+
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedShort, 4, {}, data, {
+        Trade::SceneFieldData{Trade::SceneField::Parent,
+            Containers::stridedArrayView(data->parents).slice(&Data::Parent::object),
+            Containers::stridedArrayView(data->parents).slice(&Data::Parent::parent)},
+        Trade::SceneFieldData{Trade::SceneField::Transformation,
+            Containers::stridedArrayView(data->transforms).slice(&Data::Transformation::object),
+            Containers::stridedArrayView(data->transforms).slice(&Data::Transformation::transformation)}
+    }};
+
+    Matrix3 out[4];
+    flattenTransformationHierarchy2DInto(scene, out, {});
+
+    data->transforms[0].transformation = Matrix3::translation({-1.0f, 0.5f});
+    data->transforms[3].transformation = Matrix3::translation({4.0f, 3.0f});
+    const UnsignedInt dirty[]{1, 3};
+    flattenTransformationHierarchy2DInto(scene, dirty, out, {});
+    CORRADE_COMPARE_AS(Containers::arrayView(out), Containers::arrayView<Matrix3>({
+        Matrix3::translation({-1.0f, 0.5f})*Matrix3::scaling({3.0f, 5.0f}),
+        Matrix3::translation({-1.0f, 0.5f}),
+        Matrix3::translation({-1.0f, 0.5f})*Matrix3::rotation(35.0_degf),
+        Matrix3::translation({4.0f, 3.0f})
+    }), TestSuite::Compare::Container);
+}
+
+void FlattenMeshHierarchyTest::transformationHierarchyInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Trade::SceneData notDimensions{Trade::SceneMappingType::UnsignedInt, 0, nullptr, {}};
+    Trade::SceneData noHierarchy{Trade::SceneMappingType::UnsignedInt, 0, nullptr, {
+        Trade::SceneFieldData{Trade::SceneField::Transformation, Trade::SceneMappingType::UnsignedInt, nullptr, Trade::SceneFieldType::Matrix4x4, nullptr}
+    }};
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedInt, 3, nullptr, {
+        Trade::SceneFieldData{Trade::SceneField::Parent, Trade::SceneMappingType::UnsignedInt, nullptr, Trade::SceneFieldType::Int, nullptr},
+        Trade::SceneFieldData{Trade::SceneField::Transformation, Trade::SceneMappingType::UnsignedInt, nullptr, Trade::SceneFieldType::Matrix4x4, nullptr}
+    }};
+
+    const UnsignedInt dirty[]{0, 3};
+    Matrix3 transformations2D[3];
+    Matrix4 transformations3D[3];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    flattenTransformationHierarchy2DInto(notDimensions, transformations2D, {});
+    flattenTransformationHierarchy3DInto(notDimensions, {}, transformations3D, {});
+    flattenTransformationHierarchy3DInto(noHierarchy, transformations3D, {});
+    flattenTransformationHierarchy3DInto(noHierarchy, {}, transformations3D, {});
+    flattenTransformationHierarchy3DInto(scene, Containers::arrayView(transformations3D).exceptSuffix(1), {});
+    flattenTransformationHierarchy3DInto(scene, {}, Containers::arrayView(transformations3D).exceptSuffix(1), {});
+    flattenTransformationHierarchy3DInto(scene, dirty, transformations3D, {});
+    CORRADE_COMPARE(out.str(),
+        "SceneTools::flattenTransformationHierarchyInto(): the scene is not 2D\n"
+        "SceneTools::flattenTransformationHierarchyInto(): the scene is not 3D\n"
+        "SceneTools::flattenTransformationHierarchyInto(): the scene has no hierarchy\n"
+        "SceneTools::flattenTransformationHierarchyInto(): the scene has no hierarchy\n"
+        "SceneTools::flattenTransformationHierarchyInto(): bad output size, expected 3 but got 2\n"
+        "SceneTools::flattenTransformationHierarchyInto(): bad output size, expected 3 but got 2\n"
+        "SceneTools::flattenTransformationHierarchyInto(): object 3 out of bounds for 3 objects\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::SceneTools::Test::FlattenMeshHierarchyTest)
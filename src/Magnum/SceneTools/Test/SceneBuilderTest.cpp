@@ -0,0 +1,526 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Quaternion.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/SceneTools/SceneBuilder.h"
+#include "Magnum/Trade/SceneData.h"
+
+namespace Magnum { namespace SceneTools { namespace Test { namespace {
+
+struct SceneBuilderTest: TestSuite::Tester {
+    explicit SceneBuilderTest();
+
+    void construct();
+    void constructScene();
+    void constructMappingBoundTooLarge();
+    void constructCopy();
+    void constructMove();
+
+    void addObject();
+    void addField();
+    void addFieldInvalid();
+    void setFieldValue();
+    void addFieldValue();
+    void fieldValueInvalid();
+    void sharedMappingDefaults();
+
+    void removeFieldValues();
+    void removeObject();
+    void removeInvalid();
+
+    void toSceneData();
+};
+
+using namespace Math::Literals;
+
+SceneBuilderTest::SceneBuilderTest() {
+    addTests({&SceneBuilderTest::construct,
+              &SceneBuilderTest::constructScene,
+              &SceneBuilderTest::constructMappingBoundTooLarge,
+              &SceneBuilderTest::constructCopy,
+              &SceneBuilderTest::constructMove,
+
+              &SceneBuilderTest::addObject,
+              &SceneBuilderTest::addField,
+              &SceneBuilderTest::addFieldInvalid,
+              &SceneBuilderTest::setFieldValue,
+              &SceneBuilderTest::addFieldValue,
+              &SceneBuilderTest::fieldValueInvalid,
+              &SceneBuilderTest::sharedMappingDefaults,
+
+              &SceneBuilderTest::removeFieldValues,
+              &SceneBuilderTest::removeObject,
+              &SceneBuilderTest::removeInvalid,
+
+              &SceneBuilderTest::toSceneData});
+}
+
+constexpr Trade::SceneField CustomField = Trade::sceneFieldCustom(7);
+
+/*
+        0
+       /
+      1TRM
+     / \
+    3TR 2MM
+*/
+const struct Data {
+    struct Parent {
+        UnsignedInt object;
+        Int parent;
+    } parents[4];
+    struct Trs {
+        UnsignedInt object;
+        Vector3 translation;
+        Quaternion rotation;
+    } trs[2];
+    struct Mesh {
+        UnsignedInt object;
+        UnsignedInt mesh;
+        Int meshMaterial;
+    } meshes[3];
+    struct Custom {
+        UnsignedInt object;
+        UnsignedByte values[2];
+    } custom[1];
+} SceneDataStorage[]{{
+    {{0, -1},
+     {1, 0},
+     {2, 1},
+     {3, 1}},
+    {{1, {1.0f, 2.0f, 3.0f}, Quaternion::rotation(90.0_degf, Vector3::xAxis())},
+     {3, {4.0f, 5.0f, 6.0f}, Quaternion::rotation(90.0_degf, Vector3::yAxis())}},
+    {{2, 5, -1},
+     {1, 6, 3},
+     {2, 7, 4}},
+    {{3, {0x11, 0x22}}}
+}};
+
+Trade::SceneData sceneData() {
+    const Data& data = SceneDataStorage[0];
+    return Trade::SceneData{Trade::SceneMappingType::UnsignedInt, 5, {}, SceneDataStorage, {
+        Trade::SceneFieldData{Trade::SceneField::Parent,
+            Containers::stridedArrayView(data.parents).slice(&Data::Parent::object),
+            Containers::stridedArrayView(data.parents).slice(&Data::Parent::parent)},
+        Trade::SceneFieldData{Trade::SceneField::Translation,
+            Containers::stridedArrayView(data.trs).slice(&Data::Trs::object),
+            Containers::stridedArrayView(data.trs).slice(&Data::Trs::translation)},
+        Trade::SceneFieldData{Trade::SceneField::Rotation,
+            Containers::stridedArrayView(data.trs).slice(&Data::Trs::object),
+            Containers::stridedArrayView(data.trs).slice(&Data::Trs::rotation)},
+        Trade::SceneFieldData{Trade::SceneField::Mesh,
+            Containers::stridedArrayView(data.meshes).slice(&Data::Mesh::object),
+            Containers::stridedArrayView(data.meshes).slice(&Data::Mesh::mesh)},
+        Trade::SceneFieldData{Trade::SceneField::MeshMaterial,
+            Containers::stridedArrayView(data.meshes).slice(&Data::Mesh::object),
+            Containers::stridedArrayView(data.meshes).slice(&Data::Mesh::meshMaterial)},
+        Trade::SceneFieldData{CustomField,
+            Trade::SceneMappingType::UnsignedInt,
+            Containers::stridedArrayView(data.custom).slice(&Data::Custom::object),
+            Trade::SceneFieldType::UnsignedByte,
+            Containers::stridedArrayView(data.custom).slice(&Data::Custom::values),
+            2}
+    }};
+}
+
+void SceneBuilderTest::construct() {
+    SceneBuilder builder{5};
+    CORRADE_COMPARE(builder.mappingBound(), 5);
+    CORRADE_COMPARE(builder.fieldCount(), 0);
+    CORRADE_VERIFY(!builder.hasField(Trade::SceneField::Parent));
+
+    /* An empty builder makes an empty scene */
+    Trade::SceneData scene = builder.toSceneData();
+    CORRADE_COMPARE(scene.mappingBound(), 5);
+    CORRADE_COMPARE(scene.fieldCount(), 0);
+}
+
+void SceneBuilderTest::constructScene() {
+    SceneBuilder builder{sceneData()};
+    CORRADE_COMPARE(builder.mappingBound(), 5);
+    CORRADE_COMPARE(builder.fieldCount(), 6);
+
+    CORRADE_VERIFY(builder.hasField(Trade::SceneField::Parent));
+    CORRADE_VERIFY(builder.hasField(Trade::SceneField::Rotation));
+    CORRADE_VERIFY(builder.hasField(CustomField));
+    CORRADE_VERIFY(!builder.hasField(Trade::SceneField::Scaling));
+
+    CORRADE_COMPARE(builder.fieldType(Trade::SceneField::Parent), Trade::SceneFieldType::Int);
+    CORRADE_COMPARE(builder.fieldType(Trade::SceneField::Rotation), Trade::SceneFieldType::Quaternion);
+    CORRADE_COMPARE(builder.fieldType(CustomField), Trade::SceneFieldType::UnsignedByte);
+    CORRADE_COMPARE(builder.fieldArraySize(Trade::SceneField::Parent), 0);
+    CORRADE_COMPARE(builder.fieldArraySize(CustomField), 2);
+
+    CORRADE_COMPARE(builder.fieldSize(Trade::SceneField::Parent), 4);
+    CORRADE_COMPARE(builder.fieldSize(Trade::SceneField::Translation), 2);
+    CORRADE_COMPARE(builder.fieldSize(Trade::SceneField::MeshMaterial), 3);
+    CORRADE_COMPARE(builder.fieldSize(CustomField), 1);
+
+    CORRADE_COMPARE(builder.fieldValueFor<Int>(Trade::SceneField::Parent, 3), 1);
+    CORRADE_COMPARE(builder.fieldValueFor<Vector3>(Trade::SceneField::Translation, 3), (Vector3{4.0f, 5.0f, 6.0f}));
+    CORRADE_COMPARE(builder.fieldValueFor<Quaternion>(Trade::SceneField::Rotation, 1), Quaternion::rotation(90.0_degf, Vector3::xAxis()));
+    CORRADE_COMPARE(builder.fieldValueFor<Vector3>(Trade::SceneField::Translation, 0), Containers::NullOpt);
+
+    /* Object 2 has two meshes, the most recently added one is returned */
+    CORRADE_COMPARE(builder.fieldSizeFor(Trade::SceneField::Mesh, 2), 2);
+    CORRADE_COMPARE(builder.fieldSizeFor(Trade::SceneField::Mesh, 1), 1);
+    CORRADE_COMPARE(builder.fieldSizeFor(Trade::SceneField::Mesh, 4), 0);
+    CORRADE_COMPARE(builder.fieldValueFor<UnsignedInt>(Trade::SceneField::Mesh, 2), 7);
+    CORRADE_COMPARE(builder.fieldValueFor<Int>(Trade::SceneField::MeshMaterial, 2), 4);
+}
+
+void SceneBuilderTest::constructMappingBoundTooLarge() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    SceneBuilder{0x100000000ull};
+    CORRADE_COMPARE(out.str(), "SceneTools::SceneBuilder: expected the mapping bound to fit into 32 bits but got 4294967296\n");
+}
+
+void SceneBuilderTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<SceneBuilder>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<SceneBuilder>{});
+}
+
+void SceneBuilderTest::constructMove() {
+    SceneBuilder a{sceneData()};
+
+    SceneBuilder b{std::move(a)};
+    CORRADE_COMPARE(b.mappingBound(), 5);
+    CORRADE_COMPARE(b.fieldSize(Trade::SceneField::Parent), 4);
+
+    SceneBuilder c{3};
+    c = std::move(b);
+    CORRADE_COMPARE(c.mappingBound(), 5);
+    CORRADE_COMPARE(c.fieldSize(Trade::SceneField::Parent), 4);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<SceneBuilder>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<SceneBuilder>::value);
+}
+
+void SceneBuilderTest::addObject() {
+    SceneBuilder builder{sceneData()};
+    CORRADE_COMPARE(builder.addObject(), 5);
+    CORRADE_COMPARE(builder.addObject(), 6);
+    CORRADE_COMPARE(builder.mappingBound(), 7);
+
+    /* New objects have no entries */
+    CORRADE_COMPARE(builder.fieldSizeFor(Trade::SceneField::Parent, 6), 0);
+    CORRADE_COMPARE(builder.fieldSize(Trade::SceneField::Parent), 4);
+
+    /* Removed IDs aren't reused */
+    builder.removeObject(6);
+    CORRADE_COMPARE(builder.addObject(), 7);
+}
+
+void SceneBuilderTest::addField() {
+    SceneBuilder builder{3};
+    builder
+        .addField(Trade::SceneField::Parent, Trade::SceneFieldType::Short)
+        .addField(CustomField, Trade::SceneFieldType::Float, 3);
+    CORRADE_COMPARE(builder.fieldCount(), 2);
+    CORRADE_COMPARE(builder.fieldType(Trade::SceneField::Parent), Trade::SceneFieldType::Short);
+    CORRADE_COMPARE(builder.fieldArraySize(Trade::SceneField::Parent), 0);
+    CORRADE_COMPARE(builder.fieldSize(Trade::SceneField::Parent), 0);
+    CORRADE_COMPARE(builder.fieldType(CustomField), Trade::SceneFieldType::Float);
+    CORRADE_COMPARE(builder.fieldArraySize(CustomField), 3);
+}
+
+void SceneBuilderTest::addFieldInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    SceneBuilder builder{sceneData()};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    builder.addField(Trade::SceneField::Parent, Trade::SceneFieldType::Long);
+    builder.fieldType(Trade::SceneField::Light);
+    builder.fieldArraySize(Trade::SceneField::Light);
+    builder.fieldSize(Trade::SceneField::Light);
+    CORRADE_COMPARE(out.str(),
+        "SceneTools::SceneBuilder::addField(): field Trade::SceneField::Parent already exists\n"
+        "SceneTools::SceneBuilder::fieldType(): field Trade::SceneField::Light not found\n"
+        "SceneTools::SceneBuilder::fieldArraySize(): field Trade::SceneField::Light not found\n"
+        "SceneTools::SceneBuilder::fieldSize(): field Trade::SceneField::Light not found\n");
+}
+
+void SceneBuilderTest::setFieldValue() {
+    SceneBuilder builder{sceneData()};
+
+    /* Overwriting an existing entry */
+    builder.setFieldValue(Trade::SceneField::Parent, 3, Int{0});
+    CORRADE_COMPARE(builder.fieldSize(Trade::SceneField::Parent), 4);
+    CORRADE_COMPARE(builder.fieldValueFor<Int>(Trade::SceneField::Parent, 3), 0);
+
+    /* Adding a new one */
+    builder.setFieldValue(Trade::SceneField::Parent, 4, Int{2});
+    CORRADE_COMPARE(builder.fieldSize(Trade::SceneField::Parent), 5);
+    CORRADE_COMPARE(builder.fieldValueFor<Int>(Trade::SceneField::Parent, 4), 2);
+
+    /* With multiple entries the most recent one gets modified */
+    builder.setFieldValue(Trade::SceneField::Mesh, 2, 9u);
+    CORRADE_COMPARE(builder.fieldSize(Trade::SceneField::Mesh), 3);
+    CORRADE_COMPARE(builder.fieldValueFor<UnsignedInt>(Trade::SceneField::Mesh, 2), 9);
+
+    /* Setting a value of a field that isn't present adds it */
+    builder.setFieldValue(Trade::SceneField::Light, 0, 3u);
+    CORRADE_VERIFY(builder.hasField(Trade::SceneField::Light));
+    CORRADE_COMPARE(builder.fieldType(Trade::SceneField::Light), Trade::SceneFieldType::UnsignedInt);
+    CORRADE_COMPARE(builder.fieldSize(Trade::SceneField::Light), 1);
+    CORRADE_COMPARE(builder.fieldValueFor<UnsignedInt>(Trade::SceneField::Light, 0), 3);
+}
+
+void SceneBuilderTest::addFieldValue() {
+    SceneBuilder builder{sceneData()};
+
+    builder
+        .addFieldValue(Trade::SceneField::Mesh, 1, 10u)
+        .addFieldValue(Trade::SceneField::Mesh, 1, 11u)
+        .addFieldValue(Trade::SceneField::Mesh, 4, 12u);
+    CORRADE_COMPARE(builder.fieldSize(Trade::SceneField::Mesh), 6);
+    CORRADE_COMPARE(builder.fieldSize(Trade::SceneField::MeshMaterial), 6);
+    CORRADE_COMPARE(builder.fieldSizeFor(Trade::SceneField::Mesh, 1), 3);
+    CORRADE_COMPARE(builder.fieldSizeFor(Trade::SceneField::Mesh, 4), 1);
+    CORRADE_COMPARE(builder.fieldValueFor<UnsignedInt>(Trade::SceneField::Mesh, 1), 11);
+    /* The material gets a default */
+    CORRADE_COMPARE(builder.fieldValueFor<Int>(Trade::SceneField::MeshMaterial, 1), -1);
+
+    /* Adding to a field that isn't present adds it */
+    builder.addFieldValue(Trade::SceneField::Camera, 3, 0u);
+    CORRADE_COMPARE(builder.fieldType(Trade::SceneField::Camera), Trade::SceneFieldType::UnsignedInt);
+    CORRADE_COMPARE(builder.fieldSize(Trade::SceneField::Camera), 1);
+}
+
+void SceneBuilderTest::fieldValueInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    SceneBuilder builder{sceneData()};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    builder.fieldSizeFor(Trade::SceneField::Light, 0);
+    builder.fieldSizeFor(Trade::SceneField::Parent, 5);
+    builder.fieldValueFor<UnsignedInt>(Trade::SceneField::Light, 0);
+    builder.fieldValueFor<Long>(Trade::SceneField::Parent, 0);
+    builder.fieldValueFor<UnsignedByte>(CustomField, 0);
+    builder.fieldValueFor<Int>(Trade::SceneField::Parent, 5);
+    builder.setFieldValue(Trade::SceneField::Parent, 5, Int{});
+    builder.setFieldValue(Trade::SceneField::Parent, 0, Long{});
+    builder.setFieldValue(CustomField, 0, UnsignedByte{});
+    builder.addFieldValue(Trade::SceneField::Parent, 5, Int{});
+    CORRADE_COMPARE(out.str(),
+        "SceneTools::SceneBuilder::fieldSizeFor(): field Trade::SceneField::Light not found\n"
+        "SceneTools::SceneBuilder::fieldSizeFor(): index 5 out of range for 5 objects\n"
+        "SceneTools::SceneBuilder::fieldValueFor(): field Trade::SceneField::Light not found\n"
+        "SceneTools::SceneBuilder::fieldValueFor(): Trade::SceneField::Parent is Trade::SceneFieldType::Int but requested a type equivalent to Trade::SceneFieldType::Long\n"
+        "SceneTools::SceneBuilder::fieldValueFor(): Trade::SceneField::Custom(7) is an array field, can't access values directly\n"
+        "SceneTools::SceneBuilder::fieldValueFor(): index 5 out of range for 5 objects\n"
+        "SceneTools::SceneBuilder::setFieldValue(): index 5 out of range for 5 objects\n"
+        "SceneTools::SceneBuilder::setFieldValue(): Trade::SceneField::Parent is Trade::SceneFieldType::Int but got a type equivalent to Trade::SceneFieldType::Long\n"
+        "SceneTools::SceneBuilder::setFieldValue(): Trade::SceneField::Custom(7) is an array field, can't set values directly\n"
+        "SceneTools::SceneBuilder::addFieldValue(): index 5 out of range for 5 objects\n");
+}
+
+void SceneBuilderTest::sharedMappingDefaults() {
+    SceneBuilder builder{5};
+
+    /* Rotation alone */
+    builder.setFieldValue(Trade::SceneField::Rotation, 2, Quaternion::rotation(90.0_degf, Vector3::zAxis()));
+    CORRADE_VERIFY(!builder.hasField(Trade::SceneField::Translation));
+
+    /* Adding a translation fills a default for the existing rotation entry,
+       and a default rotation for the new entry */
+    builder.setFieldValue(Trade::SceneField::Translation, 4, Vector3{1.0f, 2.0f, 3.0f});
+    CORRADE_COMPARE(builder.fieldSize(Trade::SceneField::Translation), 2);
+    CORRADE_COMPARE(builder.fieldSize(Trade::SceneField::Rotation), 2);
+    CORRADE_COMPARE(builder.fieldValueFor<Vector3>(Trade::SceneField::Translation, 2), Vector3{});
+    CORRADE_COMPARE(builder.fieldValueFor<Quaternion>(Trade::SceneField::Rotation, 4), Quaternion{});
+
+    /* Setting a value of an object that already has an entry in the group
+       doesn't add a new one */
+    builder.setFieldValue(Trade::SceneField::Translation, 2, Vector3{4.0f, 5.0f, 6.0f});
+    CORRADE_COMPARE(builder.fieldSize(Trade::SceneField::Translation), 2);
+    CORRADE_COMPARE(builder.fieldValueFor<Quaternion>(Trade::SceneField::Rotation, 2), Quaternion::rotation(90.0_degf, Vector3::zAxis()));
+
+    /* Explicitly added scaling gets filled with an unit scale */
+    builder.addField(Trade::SceneField::Scaling, Trade::SceneFieldType::Vector3);
+    CORRADE_COMPARE(builder.fieldSize(Trade::SceneField::Scaling), 2);
+    CORRADE_COMPARE(builder.fieldValueFor<Vector3>(Trade::SceneField::Scaling, 2), Vector3{1.0f});
+    CORRADE_COMPARE(builder.fieldValueFor<Vector3>(Trade::SceneField::Scaling, 4), Vector3{1.0f});
+
+    /* Mesh material is -1 by default */
+    builder.addFieldValue(Trade::SceneField::Mesh, 1, 3u);
+    builder.setFieldValue(Trade::SceneField::MeshMaterial, 0, Int{7});
+    CORRADE_COMPARE(builder.fieldValueFor<Int>(Trade::SceneField::MeshMaterial, 1), -1);
+    CORRADE_COMPARE(builder.fieldValueFor<UnsignedInt>(Trade::SceneField::Mesh, 0), 0);
+    CORRADE_COMPARE(builder.fieldValueFor<Int>(Trade::SceneField::MeshMaterial, 0), 7);
+
+    /* The fields share the mapping, otherwise the SceneData constructor would
+       assert */
+    Trade::SceneData scene = builder.toSceneData();
+    CORRADE_COMPARE(scene.fieldCount(), 5);
+    CORRADE_COMPARE(scene.mapping(Trade::SceneField::Translation).data(), scene.mapping(Trade::SceneField::Scaling).data());
+    CORRADE_COMPARE(scene.mapping(Trade::SceneField::Mesh).data(), scene.mapping(Trade::SceneField::MeshMaterial).data());
+}
+
+void SceneBuilderTest::removeFieldValues() {
+    SceneBuilder builder{sceneData()};
+
+    /* Removes both meshes of object 2 and their materials */
+    builder.removeFieldValues(Trade::SceneField::Mesh, 2);
+    CORRADE_COMPARE(builder.fieldSize(Trade::SceneField::Mesh), 1);
+    CORRADE_COMPARE(builder.fieldSize(Trade::SceneField::MeshMaterial), 1);
+    CORRADE_COMPARE(builder.fieldSizeFor(Trade::SceneField::Mesh, 2), 0);
+    CORRADE_COMPARE(builder.fieldValueFor<UnsignedInt>(Trade::SceneField::Mesh, 1), 6);
+    CORRADE_COMPARE(builder.fieldValueFor<Int>(Trade::SceneField::MeshMaterial, 1), 3);
+
+    /* Removing rotation removes translation as well */
+    builder.removeFieldValues(Trade::SceneField::Rotation, 1);
+    CORRADE_COMPARE(builder.fieldSize(Trade::SceneField::Translation), 1);
+    CORRADE_COMPARE(builder.fieldValueFor<Vector3>(Trade::SceneField::Translation, 1), Containers::NullOpt);
+    CORRADE_COMPARE(builder.fieldValueFor<Vector3>(Trade::SceneField::Translation, 3), (Vector3{4.0f, 5.0f, 6.0f}));
+
+    /* Removing values of an object that has none is a no-op */
+    builder.removeFieldValues(Trade::SceneField::Translation, 4);
+    CORRADE_COMPARE(builder.fieldSize(Trade::SceneField::Translation), 1);
+}
+
+void SceneBuilderTest::removeObject() {
+    SceneBuilder builder{sceneData()};
+
+    builder.removeObject(1);
+    CORRADE_COMPARE(builder.mappingBound(), 5);
+    CORRADE_COMPARE(builder.fieldSize(Trade::SceneField::Parent), 3);
+    CORRADE_COMPARE(builder.fieldSize(Trade::SceneField::Translation), 1);
+    CORRADE_COMPARE(builder.fieldSize(Trade::SceneField::Mesh), 2);
+    CORRADE_COMPARE(builder.fieldSize(CustomField), 1);
+
+    /* The remaining entries are still correctly linked after the last entry
+       got moved in place of the removed one */
+    CORRADE_COMPARE(builder.fieldSizeFor(Trade::SceneField::Mesh, 2), 2);
+    CORRADE_COMPARE(builder.fieldValueFor<UnsignedInt>(Trade::SceneField::Mesh, 2), 7);
+    CORRADE_COMPARE(builder.fieldValueFor<Int>(Trade::SceneField::Parent, 3), 1);
+
+    /* The last entry is moved in place of the removed one */
+    Trade::SceneData scene = builder.toSceneData();
+    CORRADE_COMPARE_AS(scene.mapping<UnsignedInt>(Trade::SceneField::Parent),
+        Containers::arrayView<UnsignedInt>({0, 3, 2}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(scene.field<Int>(Trade::SceneField::Parent),
+        Containers::arrayView<Int>({-1, 1, 1}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(scene.mapping<UnsignedInt>(Trade::SceneField::Mesh),
+        Containers::arrayView<UnsignedInt>({2, 2}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(scene.field<UnsignedInt>(Trade::SceneField::Mesh),
+        Containers::arrayView<UnsignedInt>({5, 7}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(scene.field<Int>(Trade::SceneField::MeshMaterial),
+        Containers::arrayView<Int>({-1, 4}),
+        TestSuite::Compare::Container);
+
+    /* Removing the remaining mesh object leaves the mesh fields empty, which
+       are then not included in the scene */
+    builder.removeObject(2);
+    CORRADE_COMPARE(builder.fieldSize(Trade::SceneField::Mesh), 0);
+    CORRADE_VERIFY(builder.hasField(Trade::SceneField::Mesh));
+    Trade::SceneData sceneNoMeshes = builder.toSceneData();
+    CORRADE_VERIFY(!sceneNoMeshes.hasField(Trade::SceneField::Mesh));
+    CORRADE_VERIFY(!sceneNoMeshes.hasField(Trade::SceneField::MeshMaterial));
+    CORRADE_VERIFY(sceneNoMeshes.hasField(Trade::SceneField::Parent));
+}
+
+void SceneBuilderTest::removeInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    SceneBuilder builder{sceneData()};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    builder.removeObject(5);
+    builder.removeFieldValues(Trade::SceneField::Light, 0);
+    builder.removeFieldValues(Trade::SceneField::Parent, 5);
+    CORRADE_COMPARE(out.str(),
+        "SceneTools::SceneBuilder::removeObject(): index 5 out of range for 5 objects\n"
+        "SceneTools::SceneBuilder::removeFieldValues(): field Trade::SceneField::Light not found\n"
+        "SceneTools::SceneBuilder::removeFieldValues(): index 5 out of range for 5 objects\n");
+}
+
+void SceneBuilderTest::toSceneData() {
+    SceneBuilder builder{sceneData()};
+    builder.setFieldValue(Trade::SceneField::Translation, 1, Vector3{7.0f, 8.0f, 9.0f});
+
+    Trade::SceneData scene = builder.toSceneData();
+    CORRADE_COMPARE(scene.mappingType(), Trade::SceneMappingType::UnsignedInt);
+    CORRADE_COMPARE(scene.mappingBound(), 5);
+    CORRADE_COMPARE(scene.fieldCount(), 6);
+    CORRADE_VERIFY(scene.is3D());
+
+    CORRADE_COMPARE_AS(scene.mapping<UnsignedInt>(Trade::SceneField::Parent),
+        Containers::arrayView<UnsignedInt>({0, 1, 2, 3}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(scene.field<Int>(Trade::SceneField::Parent),
+        Containers::arrayView<Int>({-1, 0, 1, 1}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(scene.mapping<UnsignedInt>(Trade::SceneField::Rotation),
+        Containers::arrayView<UnsignedInt>({1, 3}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(scene.field<Vector3>(Trade::SceneField::Translation),
+        Containers::arrayView<Vector3>({{7.0f, 8.0f, 9.0f}, {4.0f, 5.0f, 6.0f}}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(scene.field<Quaternion>(Trade::SceneField::Rotation),
+        Containers::arrayView<Quaternion>({
+            Quaternion::rotation(90.0_degf, Vector3::xAxis()),
+            Quaternion::rotation(90.0_degf, Vector3::yAxis())
+        }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(scene.field<UnsignedInt>(Trade::SceneField::Mesh),
+        Containers::arrayView<UnsignedInt>({5, 6, 7}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(scene.field<Int>(Trade::SceneField::MeshMaterial),
+        Containers::arrayView<Int>({-1, 3, 4}),
+        TestSuite::Compare::Container);
+
+    /* Shared mappings are preserved */
+    CORRADE_COMPARE(scene.mapping(Trade::SceneField::Translation).data(), scene.mapping(Trade::SceneField::Rotation).data());
+    CORRADE_COMPARE(scene.mapping(Trade::SceneField::Mesh).data(), scene.mapping(Trade::SceneField::MeshMaterial).data());
+
+    /* Array fields as well */
+    CORRADE_COMPARE(scene.fieldArraySize(CustomField), 2);
+    CORRADE_COMPARE_AS(scene.field<UnsignedByte[]>(CustomField)[0],
+        Containers::arrayView<UnsignedByte>({0x11, 0x22}),
+        TestSuite::Compare::Container);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneTools::Test::SceneBuilderTest)
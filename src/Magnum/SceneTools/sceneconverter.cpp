@@ -28,6 +28,7 @@
 #include <unordered_map> /* sceneFieldNames */
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/Pointer.h>
 #include <Corrade/Containers/Reference.h>
 #include <Corrade/Containers/Triple.h>
 #include <Corrade/Utility/Arguments.h>
@@ -41,6 +42,7 @@
 #include "Magnum/Math/Matrix4.h"
 #include "Magnum/Math/FunctionsBatch.h"
 #include "Magnum/MeshTools/Concatenate.h"
+#include "Magnum/MeshTools/Reference.h"
 #include "Magnum/MeshTools/RemoveDuplicates.h"
 #include "Magnum/MeshTools/Transform.h"
 #include "Magnum/SceneTools/FlattenMeshHierarchy.h"
@@ -135,8 +137,8 @@ magnum-sceneconverter [-h|--help] [-I|--importer PLUGIN]
     [--level LEVEL] [--concatenate-meshes] [--info-animations] [--info-images]
     [--info-lights] [--info-materials] [--info-meshes] [--info-objects]
     [--info-scenes] [--info-skins] [--info-textures] [--info]
-    [--color on|4bit|off|auto] [--bounds] [-v|--verbose] [--profile] [--] input
-    output
+    [--color on|4bit|off|auto] [--bounds] [-v|--verbose] [--profile]
+    [--batch FILE] [-j|--jobs N] [--] input output
 @endcode
 
 Arguments:
@@ -154,7 +156,7 @@ Arguments:
     the output. See @ref Utility::String::parseNumberSequence() for syntax
     description.
 -   `--remove-duplicates` --- remove duplicate vertices using
-    @ref MeshTools::removeDuplicates(const Trade::MeshData&) after import
+    @ref MeshTools::removeDuplicates(const Trade::MeshData&, UnsignedInt) after import
 -   `--remove-duplicates-fuzzy EPSILON` --- remove duplicate vertices using
     @ref MeshTools::removeDuplicatesFuzzy(const Trade::MeshData&, Float, Double)
     after import
@@ -185,13 +187,19 @@ Arguments:
 -   `--bounds` --- show bounds of known attributes in `--info` output
 -   `-v`, `--verbose` --- verbose output from importer and converter plugins
 -   `--profile` --- measure import and conversion time
+-   `--batch FILE` --- convert all input / output pairs listed in a file
+-   `-j`, `--jobs N` --- worker count for `--batch` and for mesh processing
+    in `--info` (default: `0`, which means all available cores)
 
 If any of the `--info-*` options are given, the utility will print information
 about given data present in the file. In this case no conversion is done and
 output file doesn't need to be specified. In case one data references another
 and both `--info-*` options are specified, the output will also list reference
 count (for example, `--info-scenes` together with `--info-meshes` will print
-how many objects reference given mesh).
+how many objects reference given mesh). Mesh properties and `--bounds` are
+calculated on `--jobs` workers, meshes are imported in parallel as well if the
+importer advertises @ref Trade::ImporterFeature::ThreadSafeImport. The output
+order is the same regardless of the worker count.
 
 The `-i` / `--importer-options` and `-c` / `--converter-options` arguments
 accept a comma-separated list of key/value pairs to set in the importer /
@@ -216,6 +224,27 @@ scene hierarchy transformation baked in using
 @ref SceneTools::flattenMeshHierarchy3D(). Only attributes that are present in
 the first mesh are taken, if `--only-attributes` is specified as well, the IDs
 reference attributes of the first mesh.
+
+@subsection magnum-sceneconverter-usage-batch Batch conversion
+
+If `--batch` is given, `input` and `output` are not specified and the pairs
+are read from given file instead, one whitespace-separated pair per line.
+Empty lines and lines starting with `#` are skipped. Filenames containing
+spaces are not supported.
+
+@code{.sh}
+magnum-sceneconverter --batch meshes.txt -j 8 --profile --remove-duplicates
+@endcode
+
+All plugins are loaded and configured just once for each of the `-j` /
+`--jobs` workers and then reused for all files, which avoids the plugin
+loading and startup overhead of invoking the utility for each file
+separately. Files are distributed to the workers dynamically as they finish
+previous conversions. With `--profile`, import and conversion time is printed
+for each file together with the total time. A failure to convert any file is
+reported but doesn't stop conversion of the remaining ones, the utility then
+exits with a non-zero code. This mode can't be combined with `--info-*` or
+`--concatenate-meshes`.
 */
 
 }
@@ -242,6 +271,55 @@ UnsignedInt namedAttributeId(const Trade::MeshData& mesh, UnsignedInt id) {
     CORRADE_INTERNAL_ASSERT_UNREACHABLE();
 }
 
+/* Filters attributes and removes duplicates, if requested. Shared between
+   the single-file and the --batch conversion. */
+bool processMesh(const Utility::Arguments& args, Containers::Optional<Trade::MeshData>& mesh, std::chrono::high_resolution_clock::duration& conversionTime) {
+    /* Filter attributes, if requested */
+    if(!args.value("only-attributes").empty()) {
+        const Containers::Optional<Containers::Array<UnsignedInt>> only = Utility::String::parseNumberSequence(args.value<Containers::StringView>("only-attributes"), 0, mesh->attributeCount());
+        if(!only) return false;
+
+        /** @todo use MeshTools::filterOnlyAttributes() once it has a rvalue
+            overload that transfers ownership */
+        Containers::Array<Trade::MeshAttributeData> attributes;
+        arrayReserve(attributes, only->size());
+        for(UnsignedInt i: *only)
+            arrayAppend(attributes, mesh->attributeData(i));
+
+        const Trade::MeshIndexData indices{mesh->indices()};
+        const UnsignedInt vertexCount = mesh->vertexCount();
+        mesh = Trade::MeshData{mesh->primitive(),
+            mesh->releaseIndexData(), indices,
+            mesh->releaseVertexData(), std::move(attributes),
+            vertexCount};
+    }
+
+    /* Remove duplicates, if requested */
+    if(args.isSet("remove-duplicates")) {
+        const UnsignedInt beforeVertexCount = mesh->vertexCount();
+        {
+            Trade::Implementation::Duration d{conversionTime};
+            mesh = MeshTools::removeDuplicates(*std::move(mesh));
+        }
+        if(args.isSet("verbose"))
+            Debug{} << "Duplicate removal:" << beforeVertexCount << "->" << mesh->vertexCount() << "vertices";
+    }
+
+    /* Remove duplicates with fuzzy comparison, if requested */
+    /** @todo accept two values for float and double fuzzy comparison */
+    if(!args.value("remove-duplicates-fuzzy").empty()) {
+        const UnsignedInt beforeVertexCount = mesh->vertexCount();
+        {
+            Trade::Implementation::Duration d{conversionTime};
+            mesh = MeshTools::removeDuplicatesFuzzy(*std::move(mesh), args.value<Float>("remove-duplicates-fuzzy"));
+        }
+        if(args.isSet("verbose"))
+            Debug{} << "Fuzzy duplicate removal:" << beforeVertexCount << "->" << mesh->vertexCount() << "vertices";
+    }
+
+    return true;
+}
+
 bool isInfoRequested(const Utility::Arguments& args) {
     return args.isSet("info-animations") ||
            args.isSet("info-images") ||
@@ -255,6 +333,132 @@ bool isInfoRequested(const Utility::Arguments& args) {
            args.isSet("info");
 }
 
+/* Everything a --batch worker needs. The plugin managers are not shared
+   between workers, as the Any* plugins load their delegates through them. The
+   instances are declared after the managers so they get destroyed first. */
+struct BatchWorker {
+    Containers::Pointer<PluginManager::Manager<Trade::AbstractImporter>> importerManager;
+    Containers::Pointer<PluginManager::Manager<Trade::AbstractSceneConverter>> converterManager;
+    Containers::Pointer<Trade::AbstractImporter> importer;
+    /* The last one is the one saving to a file */
+    Containers::Array<Containers::Pointer<Trade::AbstractSceneConverter>> converters;
+};
+
+int convertBatch(const Utility::Arguments& args) {
+    if(!args.value("input").empty() || !args.value("output").empty()) {
+        Error{} << "Input and output files shouldn't be set for --batch";
+        return 1;
+    }
+    if(isInfoRequested(args) || args.isSet("concatenate-meshes")) {
+        Error{} << "The --batch option can't be combined with --info or --concatenate-meshes";
+        return 1;
+    }
+
+    Containers::Optional<Containers::Array<Trade::Implementation::BatchEntry>> entries = Trade::Implementation::parseBatchManifest(args.value("batch"));
+    if(!entries) return 3;
+
+    /* Load all plugins upfront on the main thread, so the workers only do the
+       actual conversion */
+    Containers::Array<BatchWorker> workers{Implementation::batchWorkerCount(args.value<UnsignedInt>("jobs"), entries->size())};
+    for(BatchWorker& worker: workers) {
+        worker.importerManager.emplace(
+            args.value("plugin-dir").empty() ? Containers::String{} :
+            Utility::Path::join(args.value("plugin-dir"), Trade::AbstractImporter::pluginSearchPaths().back()));
+        worker.converterManager.emplace(
+            args.value("plugin-dir").empty() ? Containers::String{} :
+            Utility::Path::join(args.value("plugin-dir"), Trade::AbstractSceneConverter::pluginSearchPaths().back()));
+
+        if(!(worker.importer = worker.importerManager->loadAndInstantiate(args.value("importer")))) {
+            Debug{} << "Available importer plugins:" << ", "_s.join(worker.importerManager->aliasList());
+            return 1;
+        }
+        if(args.isSet("verbose")) worker.importer->addFlags(Trade::ImporterFlag::Verbose);
+        Implementation::setOptions(*worker.importer, "AnySceneImporter", args.value("importer-options"));
+
+        /* Same logic as in the non-batch case -- the last passed converter is
+           used for saving if it's capable of that, otherwise the implicit
+           AnySceneConverter is appended */
+        for(std::size_t i = 0, converterCount = args.arrayValueCount("converter"); i <= converterCount; ++i) {
+            const Containers::StringView converterName = i == converterCount ?
+                "AnySceneConverter"_s : args.arrayValue<Containers::StringView>("converter", i);
+            Containers::Pointer<Trade::AbstractSceneConverter> converter = worker.converterManager->loadAndInstantiate(converterName);
+            if(!converter) {
+                Debug{} << "Available converter plugins:" << ", "_s.join(worker.converterManager->aliasList());
+                return 2;
+            }
+
+            if(args.isSet("verbose")) converter->addFlags(Trade::SceneConverterFlag::Verbose);
+            if(i < args.arrayValueCount("converter-options"))
+                Implementation::setOptions(*converter, "AnySceneConverter", args.arrayValue("converter-options", i));
+
+            const bool last = i + 1 >= converterCount && (converter->features() & Trade::SceneConverterFeature::ConvertMeshToFile);
+            if(!last && !(converter->features() & Trade::SceneConverterFeature::ConvertMesh)) {
+                Error{} << converterName << "doesn't support mesh conversion, only" << converter->features();
+                return 6;
+            }
+
+            arrayAppend(worker.converters, std::move(converter));
+            if(last) break;
+        }
+    }
+
+    /* Wow, C++, you suck. This implicitly initializes to random shit?! */
+    std::chrono::high_resolution_clock::duration totalTime{};
+    {
+        Trade::Implementation::Duration totalDuration{totalTime};
+        Implementation::runBatch(workers.size(), entries->size(), [&](const std::size_t workerId, const std::size_t i) {
+            BatchWorker& worker = workers[workerId];
+            Trade::Implementation::BatchEntry& entry = (*entries)[i];
+
+            Containers::Optional<Trade::MeshData> mesh;
+            {
+                Trade::Implementation::Duration d{entry.importTime};
+                #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+                Containers::Optional<Containers::Array<const char, Utility::Path::MapDeleter>> mapped;
+                if(args.isSet("map")) {
+                    if(!(mapped = Utility::Path::mapRead(entry.input)) || !worker.importer->openMemory(*mapped)) {
+                        Error{} << "Cannot memory-map file" << entry.input;
+                        return;
+                    }
+                } else
+                #endif
+                if(!worker.importer->openFile(entry.input)) {
+                    Error{} << "Cannot open file" << entry.input;
+                    return;
+                }
+
+                /* The memory-mapped file may get unmapped at the end of this
+                   scope, so make the mesh owned before closing the importer */
+                mesh = worker.importer->mesh(args.value<UnsignedInt>("mesh"), args.value<UnsignedInt>("level"));
+                if(mesh) mesh = MeshTools::owned(*std::move(mesh));
+                worker.importer->close();
+                if(!mesh) {
+                    Error{} << "Cannot import the mesh from" << entry.input;
+                    return;
+                }
+            }
+
+            if(!processMesh(args, mesh, entry.conversionTime)) return;
+
+            Trade::Implementation::Duration d{entry.conversionTime};
+            for(std::size_t j = 0; j + 1 < worker.converters.size(); ++j) {
+                if(!(mesh = worker.converters[j]->convert(*mesh))) {
+                    Error{} << args.arrayValue("converter", j) << "cannot convert the mesh from" << entry.input;
+                    return;
+                }
+            }
+            if(!worker.converters.back()->convertToFile(*mesh, entry.output)) {
+                Error{} << "Cannot save file" << entry.output;
+                return;
+            }
+
+            entry.succeeded = true;
+        });
+    }
+
+    return Trade::Implementation::printBatchProfile(*entries, workers.size(), totalTime, args.isSet("profile")) ? 1 : 0;
+}
+
 }
 
 int main(int argc, char** argv) {
@@ -289,11 +493,17 @@ int main(int argc, char** argv) {
         .addBooleanOption("bounds").setHelp("bounds", "show bounds of known attributes in --info output")
         .addBooleanOption('v', "verbose").setHelp("verbose", "verbose output from importer and converter plugins")
         .addBooleanOption("profile").setHelp("profile", "measure import and conversion time")
+        .addOption("batch").setHelp("batch", "convert all input / output pairs listed in a file", "FILE")
+        .addOption('j', "jobs", "0").setHelp("jobs", "worker count for --batch and --info, 0 means all available cores", "N")
         .setParseErrorCallback([](const Utility::Arguments& args, Utility::Arguments::ParseError error, const std::string& key) {
             /* If --info is passed, we don't need the output argument */
             if(error == Utility::Arguments::ParseError::MissingArgument &&
                 key == "output" && isInfoRequested(args)) return true;
 
+            /* With --batch the files are taken from the manifest */
+            if(error == Utility::Arguments::ParseError::MissingArgument &&
+                (key == "input" || key == "output") && !args.value("batch").empty()) return true;
+
             /* Handle all other errors as usual */
             return false;
         })
@@ -304,7 +514,9 @@ about given data present in the file. In this case no conversion is done and
 output file doesn't need to be specified. In case one data references another
 and both --info-* options are specified, the output will also list reference
 count (for example, --info-scenes together with --info-meshes will print how
-many objects reference given mesh).
+many objects reference given mesh). Mesh properties and --bounds are
+calculated on -j / --jobs workers, the output order is the same regardless of
+the worker count.
 
 The -i / --importer-options and -c / --converter-options arguments accept a
 comma-separated list of key/value pairs to set in the importer / converter
@@ -322,9 +534,18 @@ used.
 If --concatenate-meshes is given, all meshes of the input file are concatenated
 into a single mesh, with the scene hierarchy transformation baked in. Only
 attributes that are present in the first mesh are taken, if --only-attributes
-is specified as well, the IDs reference attributes of the first mesh.)")
+is specified as well, the IDs reference attributes of the first mesh.
+
+If --batch is given, the input and output arguments are not specified and the
+input / output pairs are read from given file instead, one whitespace-separated
+pair per line, skipping empty lines and lines starting with #. Plugins are
+loaded just once and all files are converted on -j / --jobs workers, with
+--profile printing timing for each file. This mode can't be combined with
+--info-* or --concatenate-meshes.)")
         .parse(argc, argv);
 
+    if(!args.value("batch").empty()) return convertBatch(args);
+
     /* Generic checks */
     if(!args.value<Containers::StringView>("output").isEmpty()) {
         /* Not an error in this case, it should be possible to just append
@@ -661,82 +882,111 @@ is specified as well, the IDs reference attributes of the first mesh.)")
             }
         }
 
-        /* Mesh properties */
+        /* Mesh properties. With --bounds in particular this is the most
+           expensive part, so the meshes are processed in batches on --jobs
+           workers, keeping just one batch in memory at a time. The importer
+           is called from multiple threads only if it's thread-safe, names are
+           queried afterwards on the main thread. Results are stored at fixed
+           indices so the output order doesn't depend on the worker count. */
         Containers::Array<MeshInfo> meshInfos;
-        if(args.isSet("info") || args.isSet("info-meshes")) for(UnsignedInt i = 0; i != importer->meshCount(); ++i) {
-            for(UnsignedInt j = 0; j != importer->meshLevelCount(i); ++j) {
-                Containers::Optional<Trade::MeshData> mesh;
+        if(args.isSet("info") || args.isSet("info-meshes")) {
+            Containers::Array<Containers::Pair<UnsignedInt, UnsignedInt>> meshLevels;
+            for(UnsignedInt i = 0; i != importer->meshCount(); ++i)
+                for(UnsignedInt j = 0; j != importer->meshLevelCount(i); ++j)
+                    arrayAppend(meshLevels, InPlaceInit, i, j);
+
+            const std::size_t workerCount = Implementation::batchWorkerCount(args.value<UnsignedInt>("jobs"), meshLevels.size());
+            const std::size_t importWorkerCount = importer->features() & Trade::ImporterFeature::ThreadSafeImport ? workerCount : 1;
+            const std::size_t batchSize = workerCount*16;
+            const bool bounds = args.isSet("bounds");
+
+            for(std::size_t batchBegin = 0; batchBegin < meshLevels.size(); batchBegin += batchSize) {
+                const Containers::ArrayView<const Containers::Pair<UnsignedInt, UnsignedInt>> batch = meshLevels.slice(batchBegin, Math::min(batchBegin + batchSize, meshLevels.size()));
+
+                Containers::Array<Containers::Optional<Trade::MeshData>> meshes{batch.size()};
                 {
                     Trade::Implementation::Duration d{importTime};
-                    if(!(mesh = importer->mesh(i, j))) {
+                    Implementation::runBatch(importWorkerCount, batch.size(), [&](std::size_t, const std::size_t k) {
+                        meshes[k] = importer->mesh(batch[k].first(), batch[k].second());
+                    });
+                }
+
+                Containers::Array<MeshInfo> infos{batch.size()};
+                Implementation::runBatch(workerCount, batch.size(), [&](std::size_t, const std::size_t k) {
+                    if(!meshes[k]) return;
+                    const Trade::MeshData& mesh = *meshes[k];
+
+                    MeshInfo& info = infos[k];
+                    info.mesh = batch[k].first();
+                    info.level = batch[k].second();
+                    info.primitive = mesh.primitive();
+                    info.vertexCount = mesh.vertexCount();
+                    info.vertexDataSize = mesh.vertexData().size();
+                    info.vertexDataFlags = mesh.vertexDataFlags();
+                    if(mesh.isIndexed()) {
+                        info.indexCount = mesh.indexCount();
+                        info.indexType = mesh.indexType();
+                        info.indexOffset = mesh.indexOffset();
+                        info.indexStride = mesh.indexStride();
+                        info.indexDataSize = mesh.indexData().size();
+                        info.indexDataFlags = mesh.indexDataFlags();
+                        if(bounds)
+                            info.indexBounds = calculateBounds(mesh.indicesAsArray());
+                    }
+                    info.attributes = Containers::Array<MeshAttributeInfo>{mesh.attributeCount()};
+                    for(UnsignedInt l = 0; l != mesh.attributeCount(); ++l) {
+                        const Trade::MeshAttribute name = mesh.attributeName(l);
+                        MeshAttributeInfo& attribute = info.attributes[l];
+                        attribute.offset = mesh.attributeOffset(l);
+                        attribute.stride = mesh.attributeStride(l);
+                        attribute.arraySize = mesh.attributeArraySize(l);
+                        attribute.name = name;
+                        attribute.format = mesh.attributeFormat(l);
+
+                        /* Calculate bounds, if requested, if this is not an
+                           implementation-specific format and if it's not a
+                           custom attribute */
+                        if(bounds && !isVertexFormatImplementationSpecific(mesh.attributeFormat(l))) switch(name) {
+                            case Trade::MeshAttribute::Position:
+                                attribute.bounds = calculateBounds(mesh.positions3DAsArray(namedAttributeId(mesh, l)));
+                                break;
+                            case Trade::MeshAttribute::Tangent:
+                                attribute.bounds = calculateBounds(mesh.tangentsAsArray(namedAttributeId(mesh, l)));
+                                break;
+                            case Trade::MeshAttribute::Bitangent:
+                                attribute.bounds = calculateBounds(mesh.bitangentsAsArray(namedAttributeId(mesh, l)));
+                                break;
+                            case Trade::MeshAttribute::Normal:
+                                attribute.bounds = calculateBounds(mesh.normalsAsArray(namedAttributeId(mesh, l)));
+                                break;
+                            case Trade::MeshAttribute::TextureCoordinates:
+                                attribute.bounds = calculateBounds(mesh.textureCoordinates2DAsArray(namedAttributeId(mesh, l)));
+                                break;
+                            case Trade::MeshAttribute::Color:
+                                attribute.bounds = calculateBounds(mesh.colorsAsArray(namedAttributeId(mesh, l)));
+                                break;
+                            case Trade::MeshAttribute::ObjectId:
+                                attribute.bounds = calculateBounds(mesh.objectIdsAsArray(namedAttributeId(mesh, l)));
+                                break;
+                        }
+                    }
+                });
+
+                for(std::size_t k = 0; k != batch.size(); ++k) {
+                    if(!meshes[k]) {
                         error = true;
                         continue;
                     }
-                }
 
-                MeshInfo info{};
-                info.mesh = i;
-                info.level = j;
-                info.primitive = mesh->primitive();
-                info.vertexCount = mesh->vertexCount();
-                info.vertexDataSize = mesh->vertexData().size();
-                info.vertexDataFlags = mesh->vertexDataFlags();
-                if(!j) {
-                    info.name = importer->meshName(i);
-                }
-                if(mesh->isIndexed()) {
-                    info.indexCount = mesh->indexCount();
-                    info.indexType = mesh->indexType();
-                    info.indexOffset = mesh->indexOffset();
-                    info.indexStride = mesh->indexStride();
-                    info.indexDataSize = mesh->indexData().size();
-                    info.indexDataFlags = mesh->indexDataFlags();
-                    if(args.isSet("bounds"))
-                        info.indexBounds = calculateBounds(mesh->indicesAsArray());
-                }
-                for(UnsignedInt k = 0; k != mesh->attributeCount(); ++k) {
-                    const Trade::MeshAttribute name = mesh->attributeName(k);
-
-                    /* Calculate bounds, if requested, if this is not an
-                       implementation-specific format and if it's not a custom
-                       attribute */
-                    Containers::String bounds;
-                    if(args.isSet("bounds") && !isVertexFormatImplementationSpecific(mesh->attributeFormat(k))) switch(name) {
-                        case Trade::MeshAttribute::Position:
-                            bounds = calculateBounds(mesh->positions3DAsArray(namedAttributeId(*mesh, k)));
-                            break;
-                        case Trade::MeshAttribute::Tangent:
-                            bounds = calculateBounds(mesh->tangentsAsArray(namedAttributeId(*mesh, k)));
-                            break;
-                        case Trade::MeshAttribute::Bitangent:
-                            bounds = calculateBounds(mesh->bitangentsAsArray(namedAttributeId(*mesh, k)));
-                            break;
-                        case Trade::MeshAttribute::Normal:
-                            bounds = calculateBounds(mesh->normalsAsArray(namedAttributeId(*mesh, k)));
-                            break;
-                        case Trade::MeshAttribute::TextureCoordinates:
-                            bounds = calculateBounds(mesh->textureCoordinates2DAsArray(namedAttributeId(*mesh, k)));
-                            break;
-                        case Trade::MeshAttribute::Color:
-                            bounds = calculateBounds(mesh->colorsAsArray(namedAttributeId(*mesh, k)));
-                            break;
-                        case Trade::MeshAttribute::ObjectId:
-                            Debug{} << mesh->objectIdsAsArray(namedAttributeId(*mesh, k));
-                            bounds = calculateBounds(mesh->objectIdsAsArray(namedAttributeId(*mesh, k)));
-                            break;
-                    }
+                    MeshInfo& info = infos[k];
+                    if(!info.level)
+                        info.name = importer->meshName(info.mesh);
+                    for(MeshAttributeInfo& attribute: info.attributes)
+                        if(Trade::isMeshAttributeCustom(attribute.name))
+                            attribute.customName = importer->meshAttributeName(attribute.name);
 
-                    arrayAppend(info.attributes, InPlaceInit,
-                        mesh->attributeOffset(k),
-                        mesh->attributeStride(k),
-                        mesh->attributeArraySize(k),
-                        name, Trade::isMeshAttributeCustom(name) ?
-                            importer->meshAttributeName(name) : "",
-                        mesh->attributeFormat(k),
-                        bounds);
+                    arrayAppend(meshInfos, std::move(info));
                 }
-
-                arrayAppend(meshInfos, std::move(info));
             }
         }
 
@@ -1366,48 +1616,7 @@ is specified as well, the IDs reference attributes of the first mesh.)")
     /* Wow, C++, you suck. This implicitly initializes to random shit?! */
     std::chrono::high_resolution_clock::duration conversionTime{};
 
-    /* Filter attributes, if requested */
-    if(!args.value("only-attributes").empty()) {
-        const Containers::Optional<Containers::Array<UnsignedInt>> only = Utility::String::parseNumberSequence(args.value<Containers::StringView>("only-attributes"), 0, mesh->attributeCount());
-        if(!only) return 2;
-
-        /** @todo use MeshTools::filterOnlyAttributes() once it has a rvalue
-            overload that transfers ownership */
-        Containers::Array<Trade::MeshAttributeData> attributes;
-        arrayReserve(attributes, only->size());
-        for(UnsignedInt i: *only)
-            arrayAppend(attributes, mesh->attributeData(i));
-
-        const Trade::MeshIndexData indices{mesh->indices()};
-        const UnsignedInt vertexCount = mesh->vertexCount();
-        mesh = Trade::MeshData{mesh->primitive(),
-            mesh->releaseIndexData(), indices,
-            mesh->releaseVertexData(), std::move(attributes),
-            vertexCount};
-    }
-
-    /* Remove duplicates, if requested */
-    if(args.isSet("remove-duplicates")) {
-        const UnsignedInt beforeVertexCount = mesh->vertexCount();
-        {
-            Trade::Implementation::Duration d{conversionTime};
-            mesh = MeshTools::removeDuplicates(*std::move(mesh));
-        }
-        if(args.isSet("verbose"))
-            Debug{} << "Duplicate removal:" << beforeVertexCount << "->" << mesh->vertexCount() << "vertices";
-    }
-
-    /* Remove duplicates with fuzzy comparison, if requested */
-    /** @todo accept two values for float and double fuzzy comparison */
-    if(!args.value("remove-duplicates-fuzzy").empty()) {
-        const UnsignedInt beforeVertexCount = mesh->vertexCount();
-        {
-            Trade::Implementation::Duration d{conversionTime};
-            mesh = MeshTools::removeDuplicatesFuzzy(*std::move(mesh), args.value<Float>("remove-duplicates-fuzzy"));
-        }
-        if(args.isSet("verbose"))
-            Debug{} << "Fuzzy duplicate removal:" << beforeVertexCount << "->" << mesh->vertexCount() << "vertices";
-    }
+    if(!processMesh(args, mesh, conversionTime)) return 2;
 
     PluginManager::Manager<Trade::AbstractSceneConverter> converterManager{
         args.value("plugin-dir").empty() ? Containers::String{} :
@@ -0,0 +1,539 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "CachingConverter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <string> /** @todo remove once file callbacks are <string>-free */
+#include <utility>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/Containers/StringStl.h> /** @todo remove once file callbacks are <string>-free */
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/Path.h>
+#include <Corrade/Utility/Sha1.h>
+
+#include "Magnum/FileCallback.h"
+
+namespace Magnum { namespace ShaderTools {
+
+using namespace Containers::Literals;
+
+namespace {
+
+/* Header of a cache entry file. Followed by dependencyCount dependency
+   records, each being an UnsignedInt filename size, the filename and a SHA-1
+   digest of the file contents, and then by the converted data. */
+struct CacheEntryHeader {
+    char magic[4];
+    UnsignedInt dependencyCount;
+    /* Milliseconds since the epoch */
+    UnsignedLong lastUse;
+};
+
+constexpr char CacheEntryMagic[]{'M', 'G', 'S', 'C'};
+
+UnsignedLong currentTime() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+Utility::Sha1::Digest hash(const Containers::ArrayView<const char> data) {
+    Utility::Sha1 sha1;
+    sha1 << data;
+    return sha1.digest();
+}
+
+}
+
+struct CachingConverter::State {
+    explicit State(Containers::Pointer<AbstractConverter>&& converter, const Containers::StringView directory): converter{std::move(converter)}, directory{directory} {}
+
+    /* Whether results of the wrapped converter are fully determined by what
+       the wrapper can see. If the converter can preprocess but doesn't load
+       the includes through the callback, they'd be invisible to us. */
+    bool isCacheable() const {
+        const ConverterFeatures features = converter->features();
+        return (features & ConverterFeature::InputFileCallback) || !(features & ConverterFeature::Preprocess);
+    }
+
+    Utility::Sha1::Digest key(ConverterFlags flags, Stage stage, const Utility::Sha1::Digest& source, Containers::StringView from, Containers::StringView to) const;
+    Containers::String filename(const Utility::Sha1::Digest& key) const {
+        return Utility::Path::join(directory, key.hexString() + ".bin");
+    }
+
+    /* Loads a file the same way the wrapped converter would and hashes it */
+    static Containers::Optional<Utility::Sha1::Digest> hashFile(const CachingConverter& self, Containers::StringView filename);
+
+    /* Input file callback set on the wrapped converter, forwarding to the
+       user callback or to the filesystem and recording all loaded files */
+    static Containers::Optional<Containers::ArrayView<const char>> fileCallback(const std::string& filename, InputFileCallbackPolicy policy, void* userData);
+
+    Containers::Optional<Containers::Array<char>> load(const CachingConverter& self, const Utility::Sha1::Digest& key);
+    void beginRecording();
+    void save(CachingConverter& self, const Utility::Sha1::Digest& key, Containers::ArrayView<const char> data);
+
+    Containers::Pointer<AbstractConverter> converter;
+    Containers::String directory;
+    std::size_t maxSize{};
+    Containers::String version;
+    std::size_t hitCount{}, missCount{};
+
+    /* Converter state that's a part of the cache key. Definitions are
+       serialized to a string right away to not have to distinguish null and
+       empty views later. */
+    Format inputFormat{}, outputFormat{};
+    Containers::String inputFormatVersion, outputFormatVersion;
+    Containers::String definitions;
+    Containers::String optimizationLevel, debugInfoLevel;
+
+    /* Files loaded by the wrapped converter during the current conversion */
+    bool recording{};
+    Containers::Array<Containers::Pair<Containers::String, Utility::Sha1::Digest>> dependencies;
+
+    /* Files loaded from the filesystem if no user callback is set, kept
+       until the converter closes them */
+    Containers::Array<Containers::Pair<Containers::String, Containers::Array<char>>> openedFiles;
+};
+
+Utility::Sha1::Digest CachingConverter::State::key(const ConverterFlags flags, const Stage stage, const Utility::Sha1::Digest& source, const Containers::StringView from, const Containers::StringView to) const {
+    Utility::Sha1 sha1;
+
+    /* Each string is terminated with a zero byte so different splits of the
+       same concatenated data don't result in the same key */
+    const char zero[1]{};
+    for(const Containers::StringView string: {pluginInterface(), Containers::StringView{converter->plugin()}, Containers::StringView{version}, Containers::StringView{inputFormatVersion}, Containers::StringView{outputFormatVersion}, Containers::StringView{definitions}, Containers::StringView{optimizationLevel}, Containers::StringView{debugInfoLevel}, from, to})
+        sha1 << Containers::ArrayView<const char>{string.data(), string.size()} << Containers::arrayView(zero);
+
+    /* Quiet and Verbose affect only the diagnostic output */
+    const UnsignedInt values[]{
+        UnsignedInt(stage),
+        UnsignedInt(flags & ~(ConverterFlag::Quiet|ConverterFlag::Verbose)),
+        UnsignedInt(inputFormat),
+        UnsignedInt(outputFormat)
+    };
+    sha1 << Containers::arrayCast<const char>(Containers::arrayView(values))
+         << Containers::ArrayView<const char>{source.byteArray(), Utility::Sha1::DigestSize};
+
+    return sha1.digest();
+}
+
+Containers::Optional<Utility::Sha1::Digest> CachingConverter::State::hashFile(const CachingConverter& self, const Containers::StringView filename) {
+    if(const auto callback = self.inputFileCallback()) {
+        const Containers::Optional<Containers::ArrayView<const char>> data = callback(filename, InputFileCallbackPolicy::LoadTemporary, self.inputFileCallbackUserData());
+        if(!data) return {};
+        const Utility::Sha1::Digest digest = hash(*data);
+        callback(filename, InputFileCallbackPolicy::Close, self.inputFileCallbackUserData());
+        return digest;
+    }
+
+    /* Checking for existence first to avoid Path::read() printing an error
+       for files that were removed since */
+    if(!Utility::Path::exists(filename)) return {};
+    const Containers::Optional<Containers::Array<char>> data = Utility::Path::read(filename);
+    if(!data) return {};
+    return hash(*data);
+}
+
+Containers::Optional<Containers::ArrayView<const char>> CachingConverter::State::fileCallback(const std::string& filename, const InputFileCallbackPolicy policy, void* const userData) {
+    const CachingConverter& self = *static_cast<const CachingConverter*>(userData);
+    State& state = *self._state;
+
+    Containers::Optional<Containers::ArrayView<const char>> data;
+    if(const auto callback = self.inputFileCallback()) {
+        data = callback(filename, policy, self.inputFileCallbackUserData());
+    } else if(policy == InputFileCallbackPolicy::Close) {
+        for(Containers::Pair<Containers::String, Containers::Array<char>>& file: state.openedFiles) {
+            if(file.first() != Containers::StringView{filename}) continue;
+            if(&file != &state.openedFiles.back())
+                std::swap(file, state.openedFiles.back());
+            arrayRemoveSuffix(state.openedFiles);
+            break;
+        }
+    } else {
+        Containers::Optional<Containers::Array<char>> file = Utility::Path::read(filename);
+        if(!file) return {};
+        data = Containers::ArrayView<const char>{arrayAppend(state.openedFiles, InPlaceInit, Containers::String{filename}, *std::move(file)).second()};
+    }
+
+    if(data && policy != InputFileCallbackPolicy::Close && state.recording)
+        arrayAppend(state.dependencies, InPlaceInit, Containers::String{filename}, hash(*data));
+
+    return data;
+}
+
+Containers::Optional<Containers::Array<char>> CachingConverter::State::load(const CachingConverter& self, const Utility::Sha1::Digest& key) {
+    const Containers::String filename = this->filename(key);
+    if(!Utility::Path::exists(filename)) return {};
+
+    Containers::Optional<Containers::Array<char>> entry = Utility::Path::read(filename);
+    if(!entry || entry->size() < sizeof(CacheEntryHeader)) return {};
+
+    CacheEntryHeader header;
+    std::memcpy(&header, entry->data(), sizeof(CacheEntryHeader));
+    if(std::memcmp(header.magic, CacheEntryMagic, sizeof(CacheEntryMagic)) != 0)
+        return {};
+
+    /* Check that all dependencies are still the same */
+    std::size_t offset = sizeof(CacheEntryHeader);
+    for(UnsignedInt i = 0; i != header.dependencyCount; ++i) {
+        UnsignedInt filenameSize;
+        if(entry->size() < offset + sizeof(UnsignedInt)) return {};
+        std::memcpy(&filenameSize, entry->data() + offset, sizeof(UnsignedInt));
+        offset += sizeof(UnsignedInt);
+        if(entry->size() < offset + filenameSize + Utility::Sha1::DigestSize)
+            return {};
+
+        const Containers::StringView dependency{entry->data() + offset, filenameSize};
+        offset += filenameSize;
+        const Utility::Sha1::Digest digest = Utility::Sha1::Digest::fromByteArray(entry->data() + offset);
+        offset += Utility::Sha1::DigestSize;
+
+        const Containers::Optional<Utility::Sha1::Digest> current = hashFile(self, dependency);
+        if(!current || *current != digest) return {};
+    }
+
+    Containers::Array<char> out{NoInit, entry->size() - offset};
+    Utility::copy(entry->exceptPrefix(offset), out);
+
+    /* Update the last use time for LRU eviction. Written to a temporary file
+       first and then moved over so concurrently running instances never see
+       a partially written file. Failure isn't fatal, the entry just might get
+       evicted sooner. */
+    header.lastUse = currentTime();
+    std::memcpy(entry->data(), &header, sizeof(CacheEntryHeader));
+    const Containers::String temporary = filename + ".tmp";
+    if(Utility::Path::write(temporary, *entry))
+        Utility::Path::move(temporary, filename);
+
+    return out;
+}
+
+void CachingConverter::State::beginRecording() {
+    recording = true;
+    dependencies = {};
+}
+
+void CachingConverter::State::save(CachingConverter& self, const Utility::Sha1::Digest& key, const Containers::ArrayView<const char> data) {
+    recording = false;
+
+    std::size_t size = sizeof(CacheEntryHeader) + data.size();
+    for(const Containers::Pair<Containers::String, Utility::Sha1::Digest>& dependency: dependencies)
+        size += sizeof(UnsignedInt) + dependency.first().size() + Utility::Sha1::DigestSize;
+
+    Containers::Array<char> entry{NoInit, size};
+    CacheEntryHeader header;
+    std::memcpy(header.magic, CacheEntryMagic, sizeof(CacheEntryMagic));
+    header.dependencyCount = dependencies.size();
+    header.lastUse = currentTime();
+    std::memcpy(entry.data(), &header, sizeof(CacheEntryHeader));
+
+    std::size_t offset = sizeof(CacheEntryHeader);
+    for(const Containers::Pair<Containers::String, Utility::Sha1::Digest>& dependency: dependencies) {
+        const UnsignedInt filenameSize = dependency.first().size();
+        std::memcpy(entry.data() + offset, &filenameSize, sizeof(UnsignedInt));
+        offset += sizeof(UnsignedInt);
+        std::memcpy(entry.data() + offset, dependency.first().data(), filenameSize);
+        offset += filenameSize;
+        std::memcpy(entry.data() + offset, dependency.second().byteArray(), Utility::Sha1::DigestSize);
+        offset += Utility::Sha1::DigestSize;
+    }
+    Utility::copy(data, entry.exceptPrefix(offset));
+
+    const Containers::String filename = this->filename(key);
+    const Containers::String temporary = filename + ".tmp";
+    if(!Utility::Path::make(directory) ||
+       !Utility::Path::write(temporary, entry) ||
+       !Utility::Path::move(temporary, filename)) {
+        Warning{} << "ShaderTools::CachingConverter: cannot save a cache entry to" << filename;
+        return;
+    }
+
+    self.trim();
+}
+
+CachingConverter::CachingConverter(Containers::Pointer<AbstractConverter>&& converter, const Containers::StringView directory): _state{InPlaceInit, std::move(converter), directory} {
+    CORRADE_ASSERT(_state->converter,
+        "ShaderTools::CachingConverter: converter is null", );
+
+    /* Route all file loading done by the wrapped converter through us to be
+       able to record the dependencies */
+    if(doFeatures() & ConverterFeature::InputFileCallback)
+        _state->converter->setInputFileCallback(State::fileCallback, this);
+}
+
+CachingConverter::~CachingConverter() = default;
+
+AbstractConverter& CachingConverter::converter() {
+    return *_state->converter;
+}
+
+const AbstractConverter& CachingConverter::converter() const {
+    return *_state->converter;
+}
+
+Containers::StringView CachingConverter::directory() const {
+    return _state->directory;
+}
+
+std::size_t CachingConverter::maxSize() const {
+    return _state->maxSize;
+}
+
+CachingConverter& CachingConverter::setMaxSize(const std::size_t size) {
+    _state->maxSize = size;
+    return *this;
+}
+
+Containers::StringView CachingConverter::version() const {
+    return _state->version;
+}
+
+CachingConverter& CachingConverter::setVersion(const Containers::StringView version) {
+    _state->version = Containers::String{version};
+    return *this;
+}
+
+std::size_t CachingConverter::hitCount() const {
+    return _state->hitCount;
+}
+
+std::size_t CachingConverter::missCount() const {
+    return _state->missCount;
+}
+
+std::size_t CachingConverter::trim() {
+    const State& state = *_state;
+    if(!state.maxSize) return 0;
+
+    const Containers::Optional<Containers::Array<Containers::String>> files = Utility::Path::list(state.directory, Utility::Path::ListFlag::SkipDirectories|Utility::Path::ListFlag::SkipDotAndDotDot);
+    if(!files) return 0;
+
+    struct Entry {
+        Containers::String filename;
+        std::size_t size;
+        UnsignedLong lastUse;
+    };
+    Containers::Array<Entry> entries;
+    std::size_t totalSize = 0;
+    for(const Containers::String& file: *files) {
+        /* Temporary files have a different suffix and are thus skipped */
+        if(!file.hasSuffix(".bin"_s)) continue;
+
+        Containers::String filename = Utility::Path::join(state.directory, file);
+        const Containers::Optional<std::size_t> size = Utility::Path::size(filename);
+        if(!size) continue;
+
+        arrayAppend(entries, InPlaceInit, std::move(filename), *size, UnsignedLong{});
+        totalSize += *size;
+    }
+
+    /* Read the last use times only if there's something to evict. Entries
+       that can't be read or are invalid are treated as the oldest. */
+    if(totalSize <= state.maxSize) return 0;
+    for(Entry& entry: entries) {
+        const Containers::Optional<Containers::Array<char>> data = Utility::Path::read(entry.filename);
+        if(!data || data->size() < sizeof(CacheEntryHeader)) continue;
+
+        CacheEntryHeader header;
+        std::memcpy(&header, data->data(), sizeof(CacheEntryHeader));
+        if(std::memcmp(header.magic, CacheEntryMagic, sizeof(CacheEntryMagic)) == 0)
+            entry.lastUse = header.lastUse;
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return a.lastUse < b.lastUse;
+    });
+
+    std::size_t removed = 0;
+    for(const Entry& entry: entries) {
+        if(totalSize <= state.maxSize) break;
+        if(!Utility::Path::remove(entry.filename)) continue;
+        totalSize -= entry.size;
+        ++removed;
+    }
+
+    return removed;
+}
+
+ConverterFeatures CachingConverter::doFeatures() const {
+    /* File callbacks get handled by us and forwarded to the wrapped converter
+       if it supports them at least through its base implementation */
+    ConverterFeatures features = _state->converter->features();
+    if(features & (ConverterFeature::InputFileCallback|ConverterFeature::ValidateData|ConverterFeature::ConvertData|ConverterFeature::LinkData))
+        features |= ConverterFeature::InputFileCallback;
+    return features;
+}
+
+void CachingConverter::doSetFlags(const ConverterFlags flags) {
+    _state->converter->setFlags(flags);
+}
+
+void CachingConverter::doSetInputFormat(const Format format, const Containers::StringView version) {
+    _state->inputFormat = format;
+    _state->inputFormatVersion = Containers::String{version};
+    _state->converter->setInputFormat(format, version);
+}
+
+void CachingConverter::doSetOutputFormat(const Format format, const Containers::StringView version) {
+    _state->outputFormat = format;
+    _state->outputFormatVersion = Containers::String{version};
+    _state->converter->setOutputFormat(format, version);
+}
+
+void CachingConverter::doSetDefinitions(const Containers::ArrayView<const Containers::Pair<Containers::StringView, Containers::StringView>> definitions) {
+    /* A null value means the macro gets undefined, which has to result in a
+       different key than an empty value */
+    Containers::Array<char> serialized;
+    for(const Containers::Pair<Containers::StringView, Containers::StringView>& definition: definitions) {
+        arrayAppend(serialized, Containers::ArrayView<const char>{definition.first().data(), definition.first().size()});
+        arrayAppend(serialized, definition.second().data() ? '=' : '\0');
+        arrayAppend(serialized, Containers::ArrayView<const char>{definition.second().data(), definition.second().size()});
+        arrayAppend(serialized, '\n');
+    }
+    _state->definitions = Containers::String{serialized.data(), serialized.size()};
+    _state->converter->setDefinitions(definitions);
+}
+
+void CachingConverter::doSetOptimizationLevel(const Containers::StringView level) {
+    _state->optimizationLevel = Containers::String{level};
+    _state->converter->setOptimizationLevel(level);
+}
+
+void CachingConverter::doSetDebugInfoLevel(const Containers::StringView level) {
+    _state->debugInfoLevel = Containers::String{level};
+    _state->converter->setDebugInfoLevel(level);
+}
+
+Containers::Pair<bool, Containers::String> CachingConverter::doValidateData(const Stage stage, const Containers::ArrayView<const char> data) {
+    return _state->converter->validateData(stage, data);
+}
+
+Containers::Pair<bool, Containers::String> CachingConverter::doValidateFile(const Stage stage, const Containers::StringView filename) {
+    return _state->converter->validateFile(stage, filename);
+}
+
+Containers::Optional<Containers::Array<char>> CachingConverter::doConvertDataToData(const Stage stage, const Containers::ArrayView<const char> data) {
+    State& state = *_state;
+    if(!state.isCacheable()) {
+        ++state.missCount;
+        return state.converter->convertDataToData(stage, data);
+    }
+
+    const Utility::Sha1::Digest key = state.key(flags(), stage, hash(data), {}, {});
+    if(Containers::Optional<Containers::Array<char>> out = state.load(*this, key)) {
+        if(flags() & ConverterFlag::Verbose)
+            Debug{} << "ShaderTools::CachingConverter::convertDataToData(): using a cached result";
+        ++state.hitCount;
+        return out;
+    }
+
+    ++state.missCount;
+    state.beginRecording();
+    Containers::Optional<Containers::Array<char>> out = state.converter->convertDataToData(stage, data);
+    state.recording = false;
+    if(out) state.save(*this, key, *out);
+    return out;
+}
+
+Containers::Optional<Containers::Array<char>> CachingConverter::doConvertFileToData(const Stage stage, const Containers::StringView filename) {
+    State& state = *_state;
+    /* If the file can't be loaded, let the wrapped converter fail on it with
+       its own message */
+    const Containers::Optional<Utility::Sha1::Digest> source = state.isCacheable() ? State::hashFile(*this, filename) : Containers::NullOpt;
+    if(!source) {
+        ++state.missCount;
+        return state.converter->convertFileToData(stage, filename);
+    }
+
+    const Utility::Sha1::Digest key = state.key(flags(), stage, *source, filename, {});
+    if(Containers::Optional<Containers::Array<char>> out = state.load(*this, key)) {
+        if(flags() & ConverterFlag::Verbose)
+            Debug{} << "ShaderTools::CachingConverter::convertFileToData(): using a cached result for" << filename;
+        ++state.hitCount;
+        return out;
+    }
+
+    ++state.missCount;
+    state.beginRecording();
+    Containers::Optional<Containers::Array<char>> out = state.converter->convertFileToData(stage, filename);
+    state.recording = false;
+    if(out) state.save(*this, key, *out);
+    return out;
+}
+
+bool CachingConverter::doConvertFileToFile(const Stage stage, const Containers::StringView from, const Containers::StringView to) {
+    State& state = *_state;
+    const Containers::Optional<Utility::Sha1::Digest> source = state.isCacheable() ? State::hashFile(*this, from) : Containers::NullOpt;
+    if(!source) {
+        ++state.missCount;
+        return state.converter->convertFileToFile(stage, from, to);
+    }
+
+    const Utility::Sha1::Digest key = state.key(flags(), stage, *source, from, to);
+    if(const Containers::Optional<Containers::Array<char>> out = state.load(*this, key)) {
+        if(flags() & ConverterFlag::Verbose)
+            Debug{} << "ShaderTools::CachingConverter::convertFileToFile(): using a cached result for" << from;
+        ++state.hitCount;
+
+        if(!Utility::Path::write(to, *out)) {
+            Error{} << "ShaderTools::CachingConverter::convertFileToFile(): cannot write to file" << to;
+            return false;
+        }
+
+        return true;
+    }
+
+    /* Going through the file-to-file conversion of the wrapped converter and
+       reading the output back instead of converting to data, as the wrapped
+       converter may need the output filename to detect the target format */
+    ++state.missCount;
+    state.beginRecording();
+    const bool success = state.converter->convertFileToFile(stage, from, to);
+    state.recording = false;
+    if(!success) return false;
+
+    if(const Containers::Optional<Containers::Array<char>> out = Utility::Path::read(to))
+        state.save(*this, key, *out);
+    return true;
+}
+
+Containers::Optional<Containers::Array<char>> CachingConverter::doLinkDataToData(const Containers::ArrayView<const Containers::Pair<Stage, Containers::ArrayView<const char>>> data) {
+    return _state->converter->linkDataToData(Containers::arrayCast<const Containers::Pair<Stage, Containers::ArrayView<const void>>>(data));
+}
+
+Containers::Optional<Containers::Array<char>> CachingConverter::doLinkFilesToData(const Containers::ArrayView<const Containers::Pair<Stage, Containers::StringView>> filenames) {
+    return _state->converter->linkFilesToData(filenames);
+}
+
+bool CachingConverter::doLinkFilesToFile(const Containers::ArrayView<const Containers::Pair<Stage, Containers::StringView>> from, const Containers::StringView to) {
+    return _state->converter->linkFilesToFile(from, to);
+}
+
+}}
@@ -0,0 +1,208 @@
+#ifndef Magnum_ShaderTools_CachingConverter_h
+#define Magnum_ShaderTools_CachingConverter_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::ShaderTools::CachingConverter
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/ShaderTools/AbstractConverter.h"
+
+namespace Magnum { namespace ShaderTools {
+
+/**
+@brief Caching shader converter wrapper
+@m_since_latest
+
+Wraps another @ref AbstractConverter instance and stores results of
+@ref convertDataToData(), @ref convertDataToFile(), @ref convertFileToData()
+and @ref convertFileToFile() in an on-disk cache, returning them on subsequent
+calls with the same input without invoking the wrapped converter at all. The
+wrapper is itself an @ref AbstractConverter, so it can be used in place of the
+original instance anywhere, for example when setting up pipelines for the
+@ref Vk library or in the @ref magnum-shaderconverter "magnum-shaderconverter"
+utility with the `--cache-dir` option:
+
+@snippet MagnumShaderTools.cpp CachingConverter-usage
+
+@section ShaderTools-CachingConverter-key Cache key
+
+A cache entry is identified by a SHA-1 hash of:
+
+-   the shader source, and for file conversion also the input and output
+    filenames, as file format detection and @cpp #include @ce resolution
+    depend on them
+-   the @ref Stage passed to the conversion function
+-   @ref flags() except for @ref ConverterFlag::Quiet and
+    @ref ConverterFlag::Verbose, which only affect diagnostic output
+-   input and output format and version set via @ref setInputFormat() and
+    @ref setOutputFormat()
+-   definitions set via @ref setDefinitions(), optimization level set via
+    @ref setOptimizationLevel() and debug info level set via
+    @ref setDebugInfoLevel()
+-   name of the wrapped plugin, the @ref pluginInterface() string and a
+    user-supplied version string set via @ref setVersion()
+
+In addition, each entry records names and content hashes of all files the
+wrapped converter loaded during the conversion, which includes all
+@cpp #include @ce dependencies. A cached entry is used only if all of them
+still have the same contents. The files are loaded through the callback set
+with @ref setInputFileCallback(), or directly from the filesystem if no
+callback is set.
+
+Neither the plugin binary nor its @relativeref{Corrade,PluginManager::AbstractPlugin::configuration()}
+is tracked, use @ref setVersion() to supply a string that changes whenever the
+plugin gets updated or its configuration changes.
+
+@section ShaderTools-CachingConverter-limitations Behavior and limitations
+
+File dependencies can be tracked only if the wrapped converter loads them
+through the input file callback, i.e. if it advertises
+@ref ConverterFeature::InputFileCallback. Converters that support
+@ref ConverterFeature::Preprocess but not
+@ref ConverterFeature::InputFileCallback could silently read included files
+from the filesystem and thus aren't cached at all, every operation is passed
+through to them. Validation and linking are always passed through as well.
+
+As the wrapped converter isn't invoked on a cache hit, no warnings it printed
+during the original conversion are repeated. Failed conversions aren't cached.
+
+Entries are written to a temporary file first and then moved over, so
+multiple processes can share the same cache directory. Each entry stores the
+time it was last used and if the total size of all entries exceeds
+@ref maxSize(), least recently used entries are removed after a new entry is
+saved.
+*/
+class MAGNUM_SHADERTOOLS_EXPORT CachingConverter: public AbstractConverter {
+    public:
+        /**
+         * @brief Constructor
+         * @param converter     Converter to wrap
+         * @param directory     Cache directory
+         *
+         * Expects that @p converter is not @cpp nullptr @ce. The directory
+         * is created on first save if it doesn't exist. State set on
+         * @p converter before wrapping it isn't included in the
+         * @ref ShaderTools-CachingConverter-key "cache key", set it through
+         * the wrapper instead.
+         */
+        explicit CachingConverter(Containers::Pointer<AbstractConverter>&& converter, Containers::StringView directory);
+
+        ~CachingConverter();
+
+        /** @brief Wrapped converter */
+        AbstractConverter& converter();
+        const AbstractConverter& converter() const; /**< @overload */
+
+        /** @brief Cache directory */
+        Containers::StringView directory() const;
+
+        /**
+         * @brief Max cache size in bytes
+         *
+         * If @cpp 0 @ce, the cache size is unlimited. Default is
+         * @cpp 0 @ce.
+         */
+        std::size_t maxSize() const;
+
+        /**
+         * @brief Set max cache size in bytes
+         * @return Reference to self (for method chaining)
+         *
+         * The limit is enforced after saving a new entry by removing least
+         * recently used entries until the total size fits. Use @ref trim()
+         * to enforce it explicitly.
+         */
+        CachingConverter& setMaxSize(std::size_t size);
+
+        /** @brief Wrapped converter version */
+        Containers::StringView version() const;
+
+        /**
+         * @brief Set wrapped converter version
+         * @return Reference to self (for method chaining)
+         *
+         * Arbitrary string that's included in the
+         * @ref ShaderTools-CachingConverter-key "cache key", meant to change
+         * whenever the wrapped plugin gets updated or its configuration
+         * changes. Empty by default.
+         */
+        CachingConverter& setVersion(Containers::StringView version);
+
+        /**
+         * @brief Count of cache hits
+         *
+         * Conversions that were satisfied from the cache since construction.
+         */
+        std::size_t hitCount() const;
+
+        /**
+         * @brief Count of cache misses
+         *
+         * Conversions that were passed to the wrapped converter since
+         * construction, including ones that failed or that couldn't be
+         * cached.
+         */
+        std::size_t missCount() const;
+
+        /**
+         * @brief Remove least recently used entries over the size limit
+         *
+         * If @ref maxSize() is non-zero, removes least recently used entries
+         * from @ref directory() until their total size is not larger than
+         * @ref maxSize(). Returns the count of removed entries.
+         */
+        std::size_t trim();
+
+    private:
+        struct State;
+
+        MAGNUM_SHADERTOOLS_LOCAL ConverterFeatures doFeatures() const override;
+        MAGNUM_SHADERTOOLS_LOCAL void doSetFlags(ConverterFlags flags) override;
+        MAGNUM_SHADERTOOLS_LOCAL void doSetInputFormat(Format format, Containers::StringView version) override;
+        MAGNUM_SHADERTOOLS_LOCAL void doSetOutputFormat(Format format, Containers::StringView version) override;
+        MAGNUM_SHADERTOOLS_LOCAL void doSetDefinitions(Containers::ArrayView<const Containers::Pair<Containers::StringView, Containers::StringView>> definitions) override;
+        MAGNUM_SHADERTOOLS_LOCAL void doSetOptimizationLevel(Containers::StringView level) override;
+        MAGNUM_SHADERTOOLS_LOCAL void doSetDebugInfoLevel(Containers::StringView level) override;
+
+        MAGNUM_SHADERTOOLS_LOCAL Containers::Pair<bool, Containers::String> doValidateData(Stage stage, Containers::ArrayView<const char> data) override;
+        MAGNUM_SHADERTOOLS_LOCAL Containers::Pair<bool, Containers::String> doValidateFile(Stage stage, Containers::StringView filename) override;
+        MAGNUM_SHADERTOOLS_LOCAL Containers::Optional<Containers::Array<char>> doConvertDataToData(Stage stage, Containers::ArrayView<const char> data) override;
+        MAGNUM_SHADERTOOLS_LOCAL Containers::Optional<Containers::Array<char>> doConvertFileToData(Stage stage, Containers::StringView filename) override;
+        MAGNUM_SHADERTOOLS_LOCAL bool doConvertFileToFile(Stage stage, Containers::StringView from, Containers::StringView to) override;
+        MAGNUM_SHADERTOOLS_LOCAL Containers::Optional<Containers::Array<char>> doLinkDataToData(Containers::ArrayView<const Containers::Pair<Stage, Containers::ArrayView<const char>>> data) override;
+        MAGNUM_SHADERTOOLS_LOCAL Containers::Optional<Containers::Array<char>> doLinkFilesToData(Containers::ArrayView<const Containers::Pair<Stage, Containers::StringView>> filenames) override;
+        MAGNUM_SHADERTOOLS_LOCAL bool doLinkFilesToFile(Containers::ArrayView<const Containers::Pair<Stage, Containers::StringView>> from, Containers::StringView to) override;
+
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
@@ -0,0 +1,499 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Spirv.h"
+
+#include <cstring>
+#include <unordered_map>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/MurmurHash2.h>
+
+/* For SpvHasResultAndType() */
+#define SPV_ENABLE_UTILITY_CODE
+#include "Magnum/ShaderTools/Implementation/spirv.h"
+
+namespace Magnum { namespace ShaderTools {
+
+using namespace Containers::Literals;
+
+namespace {
+
+constexpr UnsignedInt instructionWord(const SpvOp op, const UnsignedInt size) {
+    return size << 16 | op;
+}
+
+SpvOp instructionOp(const Containers::ArrayView<const UnsignedInt> instruction) {
+    return SpvOp(instruction[0] & 0xffff);
+}
+
+/* Splits the module after the header into a list of instructions. Prints a
+   message and returns false if the data is not a SPIR-V or if any instruction
+   is malformed. */
+bool parseInstructions(const char* const prefix, const Containers::ArrayView<const void> data, Containers::Array<Containers::ArrayView<const UnsignedInt>>& out) {
+    const Containers::ArrayView<const UnsignedInt> spirv = Implementation::spirvData(data.data(), data.size());
+    if(!spirv) {
+        Error{} << prefix << "the data isn't a SPIR-V binary";
+        return false;
+    }
+
+    for(std::size_t offset = 0; offset < spirv.size(); ) {
+        const UnsignedInt size = spirv[offset] >> 16;
+        if(!size || offset + size > spirv.size()) {
+            /* Offset including the header */
+            Error{} << prefix << "invalid instruction at word" << offset + 5;
+            return false;
+        }
+
+        arrayAppend(out, spirv.slice(offset, offset + size));
+        offset += size;
+    }
+
+    return true;
+}
+
+/* Result ID of an instruction or 0 if it has none */
+UnsignedInt resultId(const Containers::ArrayView<const UnsignedInt> instruction) {
+    bool hasResult, hasResultType;
+    SpvHasResultAndType(instructionOp(instruction), &hasResult, &hasResultType);
+    const std::size_t i = hasResultType ? 2 : 1;
+    return hasResult && instruction.size() > i ? instruction[i] : 0;
+}
+
+/* The header is kept as-is, which means the ID bound stays valid even though
+   some IDs may no longer be used */
+Containers::Array<char> finalize(const Containers::ArrayView<const void> data, const Containers::ArrayView<const UnsignedInt> instructions, const UnsignedInt bound) {
+    Containers::Array<char> out{NoInit, 5*4 + instructions.size()*4};
+    std::memcpy(out.data(), data.data(), 5*4);
+    reinterpret_cast<UnsignedInt*>(out.data())[3] = bound;
+    Utility::copy(Containers::arrayCast<const char>(instructions), out.exceptPrefix(5*4));
+    return out;
+}
+
+/* Evaluates a boolean-returning OpSpecConstantOp on known operands */
+Containers::Optional<bool> foldBooleanOperation(const SpvOp op, const Containers::ArrayView<const UnsignedInt> operands) {
+    if(op == SpvOpLogicalNot && operands.size() == 1)
+        return !operands[0];
+    if(operands.size() != 2)
+        return {};
+
+    const UnsignedInt a = operands[0], b = operands[1];
+    const Int sa = Int(a), sb = Int(b);
+    switch(op) {
+        case SpvOpLogicalAnd: return a && b;
+        case SpvOpLogicalOr: return a || b;
+        case SpvOpLogicalEqual: return !a == !b;
+        case SpvOpLogicalNotEqual: return !a != !b;
+        case SpvOpIEqual: return a == b;
+        case SpvOpINotEqual: return a != b;
+        case SpvOpULessThan: return a < b;
+        case SpvOpULessThanEqual: return a <= b;
+        case SpvOpUGreaterThan: return a > b;
+        case SpvOpUGreaterThanEqual: return a >= b;
+        case SpvOpSLessThan: return sa < sb;
+        case SpvOpSLessThanEqual: return sa <= sb;
+        case SpvOpSGreaterThan: return sa > sb;
+        case SpvOpSGreaterThanEqual: return sa >= sb;
+        default: return {};
+    }
+}
+
+struct Block {
+    /* Instruction range, the first is OpLabel */
+    std::size_t begin, end;
+    UnsignedInt label;
+    /* Range in the successor array */
+    std::size_t successorBegin, successorEnd;
+    bool reachable;
+    /* If the block is unreachable but needed as a merge or continue target,
+       it's reduced to a label and OpUnreachable, or to a label and a branch
+       back to the loop header, respectively */
+    SpvOp stub;
+    UnsignedInt stubTarget;
+};
+
+}
+
+Containers::Optional<Containers::Array<char>> specializeSpirv(const Containers::ArrayView<const void> data, const Containers::ArrayView<const Containers::Pair<UnsignedInt, UnsignedInt>> specializations) {
+    Containers::Array<Containers::ArrayView<const UnsignedInt>> instructions;
+    if(!parseInstructions("ShaderTools::specializeSpirv():", data, instructions))
+        return {};
+
+    UnsignedInt bound = static_cast<const UnsignedInt*>(data.data())[3];
+
+    /* Per-ID state. Constant values are 32-bit integers or booleans as 0 and
+       1, specialized is set for spec constants that got turned into regular
+       ones, and removed for IDs defined in removed blocks. */
+    Containers::Array<UnsignedInt> specIds{DirectInit, bound, ~UnsignedInt{}};
+    Containers::Array<UnsignedInt> constantValues{ValueInit, bound};
+    Containers::Array<bool> constantKnown{ValueInit, bound};
+    Containers::Array<bool> specialized{ValueInit, bound};
+    Containers::Array<bool> removed{ValueInit, bound};
+    Containers::Array<UnsignedInt> labelBlocks{DirectInit, bound, ~UnsignedInt{}};
+
+    /* Per-instruction state. A non-empty replacement is written instead of
+       the original instruction. */
+    Containers::Array<bool> dropped{ValueInit, instructions.size()};
+    Containers::Array<Containers::Array<UnsignedInt>> replacements{ValueInit, instructions.size()};
+    Containers::Array<UnsignedInt> instructionBlocks{DirectInit, instructions.size(), ~UnsignedInt{}};
+
+    const auto findSpecialization = [&](const UnsignedInt id) -> const Containers::Pair<UnsignedInt, UnsignedInt>* {
+        if(id >= bound || specIds[id] == ~UnsignedInt{}) return nullptr;
+        for(const Containers::Pair<UnsignedInt, UnsignedInt>& specialization: specializations)
+            if(specialization.first() == specIds[id]) return &specialization;
+        return nullptr;
+    };
+
+    /* Gather specialization IDs, replace the specialized constants and fold
+       operations on them. Decorations are all before constants and constants
+       before their uses, so a single pass is enough. Meanwhile split the
+       function bodies into blocks. */
+    Containers::Array<Block> blocks;
+    Containers::Array<Containers::Pair<std::size_t, std::size_t>> functions;
+    std::size_t firstFunction = instructions.size();
+    for(std::size_t i = 0; i != instructions.size(); ++i) {
+        const Containers::ArrayView<const UnsignedInt> instruction = instructions[i];
+        const SpvOp op = instructionOp(instruction);
+
+        if(op == SpvOpDecorate && instruction.size() >= 4 && instruction[2] == SpvDecorationSpecId) {
+            if(instruction[1] < bound) specIds[instruction[1]] = instruction[3];
+
+        } else if((op == SpvOpConstantTrue || op == SpvOpConstantFalse) && instruction.size() == 3) {
+            if(instruction[2] < bound) {
+                constantKnown[instruction[2]] = true;
+                constantValues[instruction[2]] = op == SpvOpConstantTrue;
+            }
+
+        /* 64-bit constants are five words, those aren't tracked */
+        } else if(op == SpvOpConstant && instruction.size() == 4) {
+            if(instruction[2] < bound) {
+                constantKnown[instruction[2]] = true;
+                constantValues[instruction[2]] = instruction[3];
+            }
+
+        } else if((op == SpvOpSpecConstantTrue || op == SpvOpSpecConstantFalse) && instruction.size() == 3) {
+            if(const Containers::Pair<UnsignedInt, UnsignedInt>* const specialization = findSpecialization(instruction[2])) {
+                const bool value = specialization->second();
+                replacements[i] = Containers::array({instructionWord(value ? SpvOpConstantTrue : SpvOpConstantFalse, 3), instruction[1], instruction[2]});
+                constantKnown[instruction[2]] = true;
+                constantValues[instruction[2]] = value;
+                specialized[instruction[2]] = true;
+            }
+
+        } else if(op == SpvOpSpecConstant && instruction.size() == 4) {
+            if(const Containers::Pair<UnsignedInt, UnsignedInt>* const specialization = findSpecialization(instruction[2])) {
+                replacements[i] = Containers::array({instructionWord(SpvOpConstant, 4), instruction[1], instruction[2], specialization->second()});
+                constantKnown[instruction[2]] = true;
+                constantValues[instruction[2]] = specialization->second();
+                specialized[instruction[2]] = true;
+            }
+
+        } else if(op == SpvOpSpecConstantOp && instruction.size() >= 5 && instruction.size() <= 6 && instruction[2] < bound) {
+            UnsignedInt operands[2];
+            bool known = true;
+            for(std::size_t j = 4; j != instruction.size(); ++j) {
+                if(instruction[j] >= bound || !constantKnown[instruction[j]]) {
+                    known = false;
+                    break;
+                }
+                operands[j - 4] = constantValues[instruction[j]];
+            }
+            if(!known) continue;
+
+            if(const Containers::Optional<bool> value = foldBooleanOperation(SpvOp(instruction[3]), Containers::arrayView(operands).prefix(instruction.size() - 4))) {
+                replacements[i] = Containers::array({instructionWord(*value ? SpvOpConstantTrue : SpvOpConstantFalse, 3), instruction[1], instruction[2]});
+                constantKnown[instruction[2]] = true;
+                constantValues[instruction[2]] = *value;
+            }
+
+        } else if(op == SpvOpFunction) {
+            if(firstFunction == instructions.size()) firstFunction = i;
+            arrayAppend(functions, InPlaceInit, blocks.size(), blocks.size());
+
+        } else if(op == SpvOpLabel && instruction.size() == 2 && instruction[1] < bound && !functions.isEmpty()) {
+            /* The previous block ends here */
+            if(functions.back().second() != functions.back().first())
+                blocks.back().end = i;
+            labelBlocks[instruction[1]] = UnsignedInt(blocks.size());
+            arrayAppend(blocks, InPlaceInit, i, i, instruction[1], 0, 0, false, SpvOpNop, 0);
+            ++functions.back().second();
+
+        } else if(op == SpvOpFunctionEnd && !functions.isEmpty()) {
+            if(functions.back().second() != functions.back().first())
+                blocks.back().end = i;
+        }
+    }
+
+    for(std::size_t i = 0; i != blocks.size(); ++i)
+        for(std::size_t j = blocks[i].begin; j != blocks[i].end; ++j)
+            instructionBlocks[j] = i;
+
+    /* Fold conditional branches on known constants and gather the resulting
+       successors of each block */
+    Containers::Array<UnsignedInt> successors;
+    for(const Containers::Pair<std::size_t, std::size_t>& function: functions) {
+        for(std::size_t i = function.first(); i != function.second(); ++i) {
+            Block& block = blocks[i];
+            block.successorBegin = successors.size();
+            const auto addSuccessor = [&](const UnsignedInt label) {
+                if(label < bound && labelBlocks[label] >= function.first() && labelBlocks[label] < function.second())
+                    arrayAppend(successors, labelBlocks[label]);
+            };
+
+            /* A block without a terminator is invalid, leave it alone */
+            if(block.end - block.begin < 2) {
+                block.successorEnd = successors.size();
+                continue;
+            }
+
+            const Containers::ArrayView<const UnsignedInt> terminator = instructions[block.end - 1];
+            const SpvOp op = instructionOp(terminator);
+            if(op == SpvOpBranch && terminator.size() == 2) {
+                addSuccessor(terminator[1]);
+            } else if(op == SpvOpBranchConditional && terminator.size() >= 4) {
+                if(terminator[1] < bound && constantKnown[terminator[1]]) {
+                    const UnsignedInt target = constantValues[terminator[1]] ? terminator[2] : terminator[3];
+                    replacements[block.end - 1] = Containers::array({instructionWord(SpvOpBranch, 2), target});
+                    addSuccessor(target);
+
+                    /* A selection merge can't precede an unconditional
+                       branch. A loop merge can, so that one stays. */
+                    if(block.end - block.begin > 2 && instructionOp(instructions[block.end - 2]) == SpvOpSelectionMerge)
+                        dropped[block.end - 2] = true;
+                } else {
+                    addSuccessor(terminator[2]);
+                    addSuccessor(terminator[3]);
+                }
+            } else if(op == SpvOpSwitch) {
+                /* Literal width depends on the selector type, which isn't
+                   tracked. Treat everything that looks like a label of this
+                   function as a target, which at worst keeps a dead block
+                   alive. */
+                for(std::size_t j = 2; j < terminator.size(); ++j)
+                    addSuccessor(terminator[j]);
+            }
+
+            block.successorEnd = successors.size();
+        }
+
+        /* Mark blocks reachable from the entry block */
+        if(function.first() == function.second()) continue;
+        Containers::Array<UnsignedInt> stack;
+        arrayAppend(stack, UnsignedInt(function.first()));
+        blocks[function.first()].reachable = true;
+        while(!stack.isEmpty()) {
+            const Block& block = blocks[stack.back()];
+            arrayRemoveSuffix(stack);
+            for(std::size_t j = block.successorBegin; j != block.successorEnd; ++j) {
+                if(blocks[successors[j]].reachable) continue;
+                blocks[successors[j]].reachable = true;
+                arrayAppend(stack, successors[j]);
+            }
+        }
+
+        /* Unreachable blocks that are merge or continue targets of a
+           reachable construct have to stay, as a stub */
+        for(std::size_t i = function.first(); i != function.second(); ++i) {
+            const Block& block = blocks[i];
+            if(!block.reachable || block.end - block.begin < 3 || dropped[block.end - 2])
+                continue;
+
+            const Containers::ArrayView<const UnsignedInt> merge = instructions[block.end - 2];
+            const SpvOp op = instructionOp(merge);
+            if((op == SpvOpSelectionMerge || op == SpvOpLoopMerge) && merge.size() >= 2 && merge[1] < bound && labelBlocks[merge[1]] != ~UnsignedInt{}) {
+                Block& mergeBlock = blocks[labelBlocks[merge[1]]];
+                if(!mergeBlock.reachable && mergeBlock.stub == SpvOpNop)
+                    mergeBlock.stub = SpvOpUnreachable;
+            }
+            if(op == SpvOpLoopMerge && merge.size() >= 3 && merge[2] < bound && labelBlocks[merge[2]] != ~UnsignedInt{}) {
+                Block& continueBlock = blocks[labelBlocks[merge[2]]];
+                if(!continueBlock.reachable) {
+                    continueBlock.stub = SpvOpBranch;
+                    continueBlock.stubTarget = block.label;
+                }
+            }
+        }
+    }
+
+    /* IDs defined in removed blocks. Labels of stubbed blocks stay. */
+    for(const Block& block: blocks) {
+        if(block.reachable) continue;
+        for(std::size_t i = block.stub == SpvOpNop ? block.begin : block.begin + 1; i != block.end; ++i) {
+            const UnsignedInt id = resultId(instructions[i]);
+            if(id && id < bound) removed[id] = true;
+        }
+    }
+
+    /* A stubbed continue block branches back to the loop header, so OpPhi
+       instructions in the header need an operand for it. The original value
+       may be defined in a removed block, use an OpUndef instead. Those are
+       allowed among global declarations, so they're put right before the
+       first function. */
+    const auto isPredecessor = [&](const UnsignedInt parent, const std::size_t blockId) -> bool {
+        if(parent >= bound || labelBlocks[parent] == ~UnsignedInt{}) return false;
+        const Block& parentBlock = blocks[labelBlocks[parent]];
+        if(parentBlock.stub == SpvOpBranch)
+            return parentBlock.stubTarget == blocks[blockId].label;
+        if(!parentBlock.reachable) return false;
+        for(std::size_t j = parentBlock.successorBegin; j != parentBlock.successorEnd; ++j)
+            if(successors[j] == blockId) return true;
+        return false;
+    };
+    Containers::Array<Containers::Pair<UnsignedInt, UnsignedInt>> undefs;
+    const auto undefFor = [&](const UnsignedInt type) -> UnsignedInt {
+        for(const Containers::Pair<UnsignedInt, UnsignedInt>& undef: undefs)
+            if(undef.first() == type) return undef.second();
+        arrayAppend(undefs, InPlaceInit, type, bound);
+        return bound++;
+    };
+
+    /* Assemble the output. Functions go to a separate array so the OpUndefs
+       can be put in between once they're all known. */
+    Containers::Array<UnsignedInt> out, functionOut;
+    Containers::Array<UnsignedInt>* target = &out;
+    for(std::size_t i = 0; i != instructions.size(); ++i) {
+        const Containers::ArrayView<const UnsignedInt> instruction = instructions[i];
+        const SpvOp op = instructionOp(instruction);
+
+        /* Names and decorations of IDs that are gone, and specialization IDs
+           of constants that are no longer specializable */
+        if(dropped[i] || (instruction.size() >= 2 && (op == SpvOpName || op == SpvOpDecorate || op == SpvOpDecorateId || op == SpvOpDecorateString) && instruction[1] < bound && (removed[instruction[1]] || (op == SpvOpDecorate && instruction.size() >= 3 && instruction[2] == SpvDecorationSpecId && specialized[instruction[1]]))))
+            continue;
+
+        if(i == firstFunction) target = &functionOut;
+
+        const UnsignedInt blockId = instructionBlocks[i];
+        if(blockId != ~UnsignedInt{}) {
+            const Block& block = blocks[blockId];
+            if(!block.reachable) {
+                if(block.stub == SpvOpUnreachable && i == block.begin)
+                    arrayAppend(*target, Containers::arrayView({instruction[0], instruction[1], instructionWord(SpvOpUnreachable, 1)}));
+                else if(block.stub == SpvOpBranch && i == block.begin)
+                    arrayAppend(*target, Containers::arrayView({instruction[0], instruction[1], instructionWord(SpvOpBranch, 2), block.stubTarget}));
+                continue;
+            }
+
+            /* Keep only OpPhi operands coming from actual predecessors */
+            if(op == SpvOpPhi && instruction.size() >= 3) {
+                const std::size_t begin = target->size();
+                arrayAppend(*target, instruction.prefix(3));
+                for(std::size_t j = 3; j + 1 < instruction.size(); j += 2) {
+                    if(!isPredecessor(instruction[j + 1], blockId)) continue;
+                    const UnsignedInt parent = instruction[j + 1];
+                    const bool fromStub = blocks[labelBlocks[parent]].stub == SpvOpBranch;
+                    arrayAppend(*target, Containers::arrayView({fromStub ? undefFor(instruction[1]) : instruction[j], parent}));
+                }
+                (*target)[begin] = instructionWord(SpvOpPhi, target->size() - begin);
+                continue;
+            }
+        }
+
+        if(!replacements[i].isEmpty())
+            arrayAppend(*target, replacements[i]);
+        else
+            arrayAppend(*target, instruction);
+    }
+
+    for(const Containers::Pair<UnsignedInt, UnsignedInt>& undef: undefs)
+        arrayAppend(out, Containers::arrayView({instructionWord(SpvOpUndef, 3), undef.first(), undef.second()}));
+    arrayAppend(out, functionOut);
+
+    return finalize(data, out, bound);
+}
+
+Containers::Optional<Containers::Array<char>> stripSpirvDebugInfo(const Containers::ArrayView<const void> data) {
+    Containers::Array<Containers::ArrayView<const UnsignedInt>> instructions;
+    if(!parseInstructions("ShaderTools::stripSpirvDebugInfo():", data, instructions))
+        return {};
+
+    /* Non-semantic instructions may reference OpString, keep them if there's
+       any such import */
+    bool keepStrings = false;
+    for(const Containers::ArrayView<const UnsignedInt> instruction: instructions) {
+        if(instructionOp(instruction) == SpvOpExtInstImport && instruction.size() >= 3 && Containers::StringView{reinterpret_cast<const char*>(instruction + 2), (instruction.size() - 2)*4}.hasPrefix("NonSemantic."_s)) {
+            keepStrings = true;
+            break;
+        }
+    }
+
+    Containers::Array<UnsignedInt> out;
+    for(const Containers::ArrayView<const UnsignedInt> instruction: instructions) {
+        switch(instructionOp(instruction)) {
+            case SpvOpString:
+                if(keepStrings) break;
+                continue;
+            case SpvOpSource:
+            case SpvOpSourceContinued:
+            case SpvOpSourceExtension:
+            case SpvOpName:
+            case SpvOpMemberName:
+            case SpvOpLine:
+            case SpvOpNoLine:
+            case SpvOpModuleProcessed:
+                continue;
+            default: break;
+        }
+
+        arrayAppend(out, instruction);
+    }
+
+    return finalize(data, out, static_cast<const UnsignedInt*>(data.data())[3]);
+}
+
+Containers::Pair<Containers::Array<UnsignedInt>, std::size_t> deduplicateSpirv(const Containers::ArrayView<const Containers::ArrayView<const void>> variants) {
+    Containers::Array<UnsignedInt> indices{NoInit, variants.size()};
+    std::size_t count = 0;
+
+    /* Hash of the data to the index of the first variant with it. Collisions
+       are resolved by comparing the actual data. */
+    std::unordered_multimap<std::size_t, UnsignedInt> table;
+    table.reserve(variants.size());
+    for(std::size_t i = 0; i != variants.size(); ++i) {
+        const Containers::ArrayView<const char> data = Containers::arrayCast<const char>(variants[i]);
+        const std::size_t hash = *reinterpret_cast<const std::size_t*>(Utility::MurmurHash2{}(data.data(), data.size()).byteArray());
+
+        indices[i] = i;
+        const auto range = table.equal_range(hash);
+        for(auto it = range.first; it != range.second; ++it) {
+            const Containers::ArrayView<const void> other = variants[it->second];
+            if(other.size() == data.size() && std::memcmp(other.data(), data.data(), data.size()) == 0) {
+                indices[i] = it->second;
+                break;
+            }
+        }
+
+        if(indices[i] == i) {
+            table.emplace(hash, i);
+            ++count;
+        }
+    }
+
+    return Containers::pair(std::move(indices), count);
+}
+
+}}
@@ -0,0 +1,117 @@
+#ifndef Magnum_ShaderTools_Spirv_h
+#define Magnum_ShaderTools_Spirv_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::ShaderTools::specializeSpirv(), @ref Magnum::ShaderTools::stripSpirvDebugInfo(), @ref Magnum::ShaderTools::deduplicateSpirv()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/ShaderTools/visibility.h"
+
+namespace Magnum { namespace ShaderTools {
+
+/**
+@brief Specialize a SPIR-V module and strip code paths that became dead
+@param data             SPIR-V binary
+@param specializations  Pairs of specialization constant IDs and their 32-bit
+    values. Booleans are @cpp false @ce for zero and @cpp true @ce otherwise.
+@m_since_latest
+
+Meant as a post-pass for output of @ref AbstractConverter::convertDataToData()
+or @ref AbstractConverter::linkDataToData() when a single shader source is
+compiled once with feature toggles expressed as specialization constants,
+instead of a preprocessor-defined variant for each combination. For every
+`SpecId` decoration present in @p specializations the function:
+
+-   Turns the corresponding `OpSpecConstantTrue`, `OpSpecConstantFalse` or
+    32-bit `OpSpecConstant` into a regular constant and removes its
+    specialization ID decoration
+-   Folds `OpSpecConstantOp` instructions that depend only on known 32-bit
+    integer or boolean constants and produce a boolean, such as the result of
+    @glsl COUNT > 0 @ce or @glsl !FEATURE @ce
+-   Replaces `OpBranchConditional` on a known condition with an unconditional
+    branch, removing the now-unneeded selection merge instruction
+-   Removes blocks that are no longer reachable, together with names and
+    decorations of IDs defined in them, and updates `OpPhi` instructions that
+    referenced them. Blocks that are still needed as merge or continue targets
+    of a reachable construct are reduced to a stub.
+
+Specialization constants not listed in @p specializations, 64-bit constants
+and switches on known values are left untouched. If no specialization matches,
+the output is identical to the input. The result is a smaller module with
+fewer branches, which makes driver-side shader module creation and pipeline
+compilation faster and, combined with @ref deduplicateSpirv(), helps to reduce
+the number of distinct pipelines. The output is meant to be passed through a
+validator such as the one in @ref AbstractConverter::validateData() in case
+the input was not produced by a trusted compiler.
+
+If @p data isn't a SPIR-V binary or contains a malformed instruction, prints a
+message to @relativeref{Magnum,Error} and returns
+@relativeref{Corrade,Containers::NullOpt}.
+
+@snippet MagnumShaderTools.cpp specializeSpirv
+*/
+MAGNUM_SHADERTOOLS_EXPORT Containers::Optional<Containers::Array<char>> specializeSpirv(Containers::ArrayView<const void> data, Containers::ArrayView<const Containers::Pair<UnsignedInt, UnsignedInt>> specializations);
+
+/**
+@brief Strip debug info from a SPIR-V module
+@m_since_latest
+
+Removes `OpSource`, `OpSourceContinued`, `OpSourceExtension`, `OpName`,
+`OpMemberName`, `OpLine`, `OpNoLine` and `OpModuleProcessed` instructions.
+`OpString` is removed as well unless the module imports a
+`NonSemantic.*` extended instruction set that may reference it. Useful to
+canonicalize modules before passing them to @ref deduplicateSpirv(), as
+otherwise variants differing only in the source text or names don't compare
+equal.
+
+If @p data isn't a SPIR-V binary or contains a malformed instruction, prints a
+message to @relativeref{Magnum,Error} and returns
+@relativeref{Corrade,Containers::NullOpt}.
+*/
+MAGNUM_SHADERTOOLS_EXPORT Containers::Optional<Containers::Array<char>> stripSpirvDebugInfo(Containers::ArrayView<const void> data);
+
+/**
+@brief Find identical SPIR-V modules
+@param variants     Module data
+@return Index array mapping each variant to the first identical one and count
+    of unique variants
+@m_since_latest
+
+Modules are compared bit-exactly, so it's recommended to pass them through
+@ref specializeSpirv() and @ref stripSpirvDebugInfo() first. A variant that
+has no identical predecessor maps to itself. The caller can then create a
+single shader module for all variants that map to the same index.
+*/
+MAGNUM_SHADERTOOLS_EXPORT Containers::Pair<Containers::Array<UnsignedInt>, std::size_t> deduplicateSpirv(Containers::ArrayView<const Containers::ArrayView<const void>> variants);
+
+}}
+
+#endif
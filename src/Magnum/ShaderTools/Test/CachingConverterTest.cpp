@@ -0,0 +1,486 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <string> /** @todo remove once file callbacks are <string>-free */
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/Containers/StringStl.h> /** @todo remove once file callbacks are <string>-free */
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/FileToString.h>
+#include <Corrade/TestSuite/Compare/String.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Path.h>
+#include <Corrade/Utility/System.h>
+
+#include "Magnum/FileCallback.h"
+#include "Magnum/ShaderTools/CachingConverter.h"
+#include "Magnum/ShaderTools/Stage.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace ShaderTools { namespace Test { namespace {
+
+struct CachingConverterTest: TestSuite::Tester {
+    explicit CachingConverterTest();
+
+    void construct();
+    void constructNull();
+
+    void convertDataToData();
+    void convertDataToDataFailed();
+    void convertFileToData();
+    void convertFileToFile();
+    void keyState();
+    void keyFlags();
+    void includeCallback();
+    void includeFilesystem();
+    void notCacheable();
+    void trim();
+
+    void setup();
+
+    Containers::String _directory;
+};
+
+using namespace Containers::Literals;
+
+/* Converter that replaces the first line in the form of `#include <file>`
+   with contents of given file, loaded through the input file callback. If
+   the source is `fail`, the conversion fails. */
+struct IncludingConverter: AbstractConverter {
+    explicit IncludingConverter(ConverterFeatures features = ConverterFeature::ConvertData|ConverterFeature::InputFileCallback|ConverterFeature::Preprocess|ConverterFeature::Optimize): features{features} {}
+
+    ConverterFeatures doFeatures() const override { return features; }
+    void doSetInputFormat(Format, Containers::StringView) override {}
+    void doSetOutputFormat(Format, Containers::StringView) override {}
+    void doSetDefinitions(Containers::ArrayView<const Containers::Pair<Containers::StringView, Containers::StringView>>) override {}
+    void doSetOptimizationLevel(Containers::StringView) override {}
+
+    Containers::Optional<Containers::Array<char>> doConvertDataToData(Stage, const Containers::ArrayView<const char> data) override {
+        ++conversionCount;
+
+        const Containers::StringView source{data.data(), data.size()};
+        if(source == "fail"_s) {
+            Error{} << "IncludingConverter: failed";
+            return {};
+        }
+
+        Containers::String out = source;
+        if(source.hasPrefix("#include "_s)) {
+            const Containers::StringView filename = source.exceptPrefix("#include "_s.size()).partition('\n')[0];
+            const Containers::Optional<Containers::ArrayView<const char>> included = inputFileCallback()(filename, InputFileCallbackPolicy::LoadTemporary, inputFileCallbackUserData());
+            if(!included) {
+                Error{} << "IncludingConverter: cannot include" << filename;
+                return {};
+            }
+            out = Containers::StringView{*included} + source.partition('\n')[2];
+            inputFileCallback()(filename, InputFileCallbackPolicy::Close, inputFileCallbackUserData());
+        }
+
+        Containers::Array<char> array{NoInit, out.size()};
+        Utility::copy(out, array);
+        return Containers::optional(std::move(array));
+    }
+
+    ConverterFeatures features;
+    Int conversionCount = 0;
+};
+
+const struct {
+    const char* name;
+    bool callback;
+} IncludeFilesystemData[]{
+    {"", false},
+    {"file callback", true}
+};
+
+CachingConverterTest::CachingConverterTest() {
+    addTests({&CachingConverterTest::construct,
+              &CachingConverterTest::constructNull});
+
+    addTests({&CachingConverterTest::convertDataToData,
+              &CachingConverterTest::convertDataToDataFailed,
+              &CachingConverterTest::convertFileToData,
+              &CachingConverterTest::convertFileToFile,
+              &CachingConverterTest::keyState,
+              &CachingConverterTest::keyFlags,
+              &CachingConverterTest::includeCallback},
+        &CachingConverterTest::setup,
+        &CachingConverterTest::setup);
+
+    addInstancedTests({&CachingConverterTest::includeFilesystem},
+        Containers::arraySize(IncludeFilesystemData),
+        &CachingConverterTest::setup,
+        &CachingConverterTest::setup);
+
+    addTests({&CachingConverterTest::notCacheable,
+              &CachingConverterTest::trim},
+        &CachingConverterTest::setup,
+        &CachingConverterTest::setup);
+
+    _directory = Utility::Path::join(SHADERTOOLS_TEST_OUTPUT_DIR, "CachingConverterTest");
+}
+
+void CachingConverterTest::setup() {
+    /* Start each test with an empty cache */
+    if(!Utility::Path::exists(_directory)) return;
+    Containers::Optional<Containers::Array<Containers::String>> files = Utility::Path::list(_directory, Utility::Path::ListFlag::SkipDirectories|Utility::Path::ListFlag::SkipDotAndDotDot);
+    CORRADE_INTERNAL_ASSERT(files);
+    for(const Containers::String& file: *files)
+        CORRADE_INTERNAL_ASSERT_OUTPUT(Utility::Path::remove(Utility::Path::join(_directory, file)));
+}
+
+void CachingConverterTest::construct() {
+    CachingConverter converter{Containers::pointer<IncludingConverter>(ConverterFeature::ConvertFile|ConverterFeature::ConvertData|ConverterFeature::LinkFile), _directory};
+    CORRADE_COMPARE(converter.directory(), _directory);
+    CORRADE_COMPARE(converter.maxSize(), 0);
+    CORRADE_COMPARE(converter.version(), "");
+    CORRADE_COMPARE(converter.hitCount(), 0);
+    CORRADE_COMPARE(converter.missCount(), 0);
+
+    /* File callbacks are handled by the wrapper itself */
+    CORRADE_COMPARE(converter.features(), ConverterFeature::ConvertFile|ConverterFeature::ConvertData|ConverterFeature::LinkFile|ConverterFeature::InputFileCallback);
+    CORRADE_VERIFY(converter.converter().inputFileCallback());
+
+    converter.setMaxSize(1024)
+        .setVersion("v2");
+    CORRADE_COMPARE(converter.maxSize(), 1024);
+    CORRADE_COMPARE(converter.version(), "v2");
+}
+
+void CachingConverterTest::constructNull() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CachingConverter{nullptr, _directory};
+    CORRADE_COMPARE(out.str(), "ShaderTools::CachingConverter: converter is null\n");
+}
+
+void CachingConverterTest::convertDataToData() {
+    CachingConverter converter{Containers::pointer<IncludingConverter>(), _directory};
+    auto& wrapped = static_cast<IncludingConverter&>(converter.converter());
+
+    Containers::Optional<Containers::Array<char>> out = converter.convertDataToData({}, "hello"_s);
+    CORRADE_VERIFY(out);
+    CORRADE_COMPARE(Containers::StringView{*out}, "hello");
+    CORRADE_COMPARE(wrapped.conversionCount, 1);
+    CORRADE_COMPARE(converter.hitCount(), 0);
+    CORRADE_COMPARE(converter.missCount(), 1);
+
+    /* Second time it's taken from the cache */
+    std::ostringstream verbose;
+    converter.setFlags(ConverterFlag::Verbose);
+    {
+        Debug redirectOutput{&verbose};
+        out = converter.convertDataToData({}, "hello"_s);
+    }
+    CORRADE_VERIFY(out);
+    CORRADE_COMPARE(Containers::StringView{*out}, "hello");
+    CORRADE_VERIFY(!out->deleter());
+    CORRADE_COMPARE(wrapped.conversionCount, 1);
+    CORRADE_COMPARE(converter.hitCount(), 1);
+    CORRADE_COMPARE(converter.missCount(), 1);
+    CORRADE_COMPARE(verbose.str(), "ShaderTools::CachingConverter::convertDataToData(): using a cached result\n");
+
+    /* A different source is a miss */
+    out = converter.convertDataToData({}, "hello!"_s);
+    CORRADE_VERIFY(out);
+    CORRADE_COMPARE(Containers::StringView{*out}, "hello!");
+    CORRADE_COMPARE(wrapped.conversionCount, 2);
+
+    /* A different instance sees the cache as well */
+    CachingConverter another{Containers::pointer<IncludingConverter>(), _directory};
+    out = another.convertDataToData({}, "hello"_s);
+    CORRADE_VERIFY(out);
+    CORRADE_COMPARE(Containers::StringView{*out}, "hello");
+    CORRADE_COMPARE(static_cast<IncludingConverter&>(another.converter()).conversionCount, 0);
+    CORRADE_COMPARE(another.hitCount(), 1);
+}
+
+void CachingConverterTest::convertDataToDataFailed() {
+    CachingConverter converter{Containers::pointer<IncludingConverter>(), _directory};
+    auto& wrapped = static_cast<IncludingConverter&>(converter.converter());
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!converter.convertDataToData({}, "fail"_s));
+    CORRADE_VERIFY(!converter.convertDataToData({}, "fail"_s));
+
+    /* Failures aren't cached */
+    CORRADE_COMPARE(wrapped.conversionCount, 2);
+    CORRADE_COMPARE(converter.missCount(), 2);
+    CORRADE_COMPARE(out.str(),
+        "IncludingConverter: failed\n"
+        "IncludingConverter: failed\n");
+}
+
+void CachingConverterTest::convertFileToData() {
+    CachingConverter converter{Containers::pointer<IncludingConverter>(), _directory};
+    auto& wrapped = static_cast<IncludingConverter&>(converter.converter());
+
+    const Containers::String input = Utility::Path::join(SHADERTOOLS_TEST_OUTPUT_DIR, "CachingConverterTest.in");
+    CORRADE_VERIFY(Utility::Path::write(input, "source"_s));
+
+    Containers::Optional<Containers::Array<char>> out = converter.convertFileToData({}, input);
+    CORRADE_VERIFY(out);
+    CORRADE_COMPARE(Containers::StringView{*out}, "source");
+
+    out = converter.convertFileToData({}, input);
+    CORRADE_VERIFY(out);
+    CORRADE_COMPARE(Containers::StringView{*out}, "source");
+    CORRADE_COMPARE(wrapped.conversionCount, 1);
+    CORRADE_COMPARE(converter.hitCount(), 1);
+
+    /* Changing the file invalidates the entry */
+    CORRADE_VERIFY(Utility::Path::write(input, "modified"_s));
+    out = converter.convertFileToData({}, input);
+    CORRADE_VERIFY(out);
+    CORRADE_COMPARE(Containers::StringView{*out}, "modified");
+    CORRADE_COMPARE(wrapped.conversionCount, 2);
+}
+
+void CachingConverterTest::convertFileToFile() {
+    CachingConverter converter{Containers::pointer<IncludingConverter>(), _directory};
+    auto& wrapped = static_cast<IncludingConverter&>(converter.converter());
+
+    const Containers::String input = Utility::Path::join(SHADERTOOLS_TEST_OUTPUT_DIR, "CachingConverterTest.in");
+    const Containers::String output = Utility::Path::join(SHADERTOOLS_TEST_OUTPUT_DIR, "CachingConverterTest.out");
+    CORRADE_VERIFY(Utility::Path::write(input, "source"_s));
+    if(Utility::Path::exists(output))
+        CORRADE_VERIFY(Utility::Path::remove(output));
+
+    CORRADE_VERIFY(converter.convertFileToFile({}, input, output));
+    CORRADE_COMPARE_AS(output, "source", TestSuite::Compare::FileToString);
+
+    /* The output gets written even on a cache hit */
+    CORRADE_VERIFY(Utility::Path::remove(output));
+    CORRADE_VERIFY(converter.convertFileToFile({}, input, output));
+    CORRADE_COMPARE_AS(output, "source", TestSuite::Compare::FileToString);
+    CORRADE_COMPARE(wrapped.conversionCount, 1);
+    CORRADE_COMPARE(converter.hitCount(), 1);
+
+    /* A different output filename is a different key, as the output format
+       may be detected from it */
+    CORRADE_VERIFY(converter.convertFileToFile({}, input, output + ".2"));
+    CORRADE_COMPARE(wrapped.conversionCount, 2);
+}
+
+void CachingConverterTest::keyState() {
+    CachingConverter converter{Containers::pointer<IncludingConverter>(), _directory};
+    auto& wrapped = static_cast<IncludingConverter&>(converter.converter());
+
+    CORRADE_VERIFY(converter.convertDataToData({}, "hello"_s));
+    CORRADE_COMPARE(wrapped.conversionCount, 1);
+
+    /* Each of these is a miss the first time and a hit the second time */
+    for(auto&& change: std::initializer_list<void(*)(CachingConverter&)>{
+        [](CachingConverter& c) { c.setDefinitions({{"FOO", ""}}); },
+        /* An undefine is different from an empty definition */
+        [](CachingConverter& c) { c.setDefinitions({{"FOO", nullptr}}); },
+        [](CachingConverter& c) { c.setOptimizationLevel("2"); },
+        [](CachingConverter& c) { c.setOutputFormat(Format::Spirv, "vulkan1.1"); },
+        [](CachingConverter& c) { c.setInputFormat(Format::Glsl, "450"); },
+        [](CachingConverter& c) { c.setVersion("v2"); },
+    }) {
+        const Int count = wrapped.conversionCount;
+        change(converter);
+        CORRADE_VERIFY(converter.convertDataToData({}, "hello"_s));
+        CORRADE_COMPARE(wrapped.conversionCount, count + 1);
+        CORRADE_VERIFY(converter.convertDataToData({}, "hello"_s));
+        CORRADE_COMPARE(wrapped.conversionCount, count + 1);
+    }
+
+    /* The stage is a part of the key as well */
+    CORRADE_VERIFY(converter.convertDataToData(Stage::Fragment, "hello"_s));
+    CORRADE_COMPARE(wrapped.conversionCount, 8);
+}
+
+void CachingConverterTest::keyFlags() {
+    CachingConverter converter{Containers::pointer<IncludingConverter>(), _directory};
+    auto& wrapped = static_cast<IncludingConverter&>(converter.converter());
+
+    CORRADE_VERIFY(converter.convertDataToData({}, "hello"_s));
+    CORRADE_COMPARE(wrapped.conversionCount, 1);
+    CORRADE_COMPARE(wrapped.flags(), ConverterFlags{});
+
+    /* Flags get propagated, Quiet doesn't affect the key */
+    converter.setFlags(ConverterFlag::Quiet);
+    CORRADE_COMPARE(wrapped.flags(), ConverterFlag::Quiet);
+    CORRADE_VERIFY(converter.convertDataToData({}, "hello"_s));
+    CORRADE_COMPARE(wrapped.conversionCount, 1);
+
+    /* But WarningAsError does */
+    converter.setFlags(ConverterFlag::WarningAsError);
+    CORRADE_VERIFY(converter.convertDataToData({}, "hello"_s));
+    CORRADE_COMPARE(wrapped.conversionCount, 2);
+}
+
+void CachingConverterTest::includeCallback() {
+    CachingConverter converter{Containers::pointer<IncludingConverter>(), _directory};
+    auto& wrapped = static_cast<IncludingConverter&>(converter.converter());
+
+    Containers::String included = "A"_s;
+    converter.setInputFileCallback([](const std::string& filename, InputFileCallbackPolicy policy, Containers::String& included) -> Containers::Optional<Containers::ArrayView<const char>> {
+        if(policy == InputFileCallbackPolicy::Close) return {};
+        if(filename != "included.glsl") return {};
+        return Containers::ArrayView<const char>{included.data(), included.size()};
+    }, included);
+
+    Containers::Optional<Containers::Array<char>> out = converter.convertDataToData({}, "#include included.glsl\n;"_s);
+    CORRADE_VERIFY(out);
+    CORRADE_COMPARE(Containers::StringView{*out}, "A;");
+
+    out = converter.convertDataToData({}, "#include included.glsl\n;"_s);
+    CORRADE_VERIFY(out);
+    CORRADE_COMPARE(Containers::StringView{*out}, "A;");
+    CORRADE_COMPARE(wrapped.conversionCount, 1);
+
+    /* Changing the included file invalidates the entry */
+    included = "B"_s;
+    out = converter.convertDataToData({}, "#include included.glsl\n;"_s);
+    CORRADE_VERIFY(out);
+    CORRADE_COMPARE(Containers::StringView{*out}, "B;");
+    CORRADE_COMPARE(wrapped.conversionCount, 2);
+
+    /* The entry got replaced with the new dependency state, so the original
+       state isn't a hit anymore */
+    included = "A"_s;
+    out = converter.convertDataToData({}, "#include included.glsl\n;"_s);
+    CORRADE_VERIFY(out);
+    CORRADE_COMPARE(Containers::StringView{*out}, "A;");
+    CORRADE_COMPARE(wrapped.conversionCount, 3);
+    CORRADE_COMPARE(converter.hitCount(), 1);
+}
+
+void CachingConverterTest::includeFilesystem() {
+    auto&& data = IncludeFilesystemData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    CachingConverter converter{Containers::pointer<IncludingConverter>(), _directory};
+    auto& wrapped = static_cast<IncludingConverter&>(converter.converter());
+
+    Containers::Optional<Containers::Array<char>> storage;
+    if(data.callback) converter.setInputFileCallback([](const std::string& filename, InputFileCallbackPolicy policy, Containers::Optional<Containers::Array<char>>& storage) -> Containers::Optional<Containers::ArrayView<const char>> {
+        if(policy == InputFileCallbackPolicy::Close) {
+            storage = Containers::NullOpt;
+            return {};
+        }
+        storage = Utility::Path::read(filename);
+        if(!storage) return {};
+        return Containers::ArrayView<const char>{*storage};
+    }, storage);
+
+    const Containers::String included = Utility::Path::join(SHADERTOOLS_TEST_OUTPUT_DIR, "CachingConverterTest.glsl");
+    const Containers::String source = "#include " + included + "\n;";
+    CORRADE_VERIFY(Utility::Path::write(included, "A"_s));
+
+    Containers::Optional<Containers::Array<char>> out = converter.convertDataToData({}, source);
+    CORRADE_VERIFY(out);
+    CORRADE_COMPARE(Containers::StringView{*out}, "A;");
+
+    out = converter.convertDataToData({}, source);
+    CORRADE_VERIFY(out);
+    CORRADE_COMPARE(wrapped.conversionCount, 1);
+
+    CORRADE_VERIFY(Utility::Path::write(included, "B"_s));
+    out = converter.convertDataToData({}, source);
+    CORRADE_VERIFY(out);
+    CORRADE_COMPARE(Containers::StringView{*out}, "B;");
+    CORRADE_COMPARE(wrapped.conversionCount, 2);
+
+    /* A removed dependency is a miss as well, and the conversion then fails
+       on its own */
+    CORRADE_VERIFY(Utility::Path::remove(included));
+    {
+        std::ostringstream out;
+        Error redirectError{&out};
+        CORRADE_VERIFY(!converter.convertDataToData({}, source));
+    }
+    CORRADE_COMPARE(wrapped.conversionCount, 3);
+}
+
+void CachingConverterTest::notCacheable() {
+    /* Can preprocess but doesn't route the includes through a callback, so
+       the wrapper can't know what it includes */
+    CachingConverter converter{Containers::pointer<IncludingConverter>(ConverterFeature::ConvertData|ConverterFeature::Preprocess), _directory};
+    auto& wrapped = static_cast<IncludingConverter&>(converter.converter());
+
+    CORRADE_VERIFY(converter.convertDataToData({}, "hello"_s));
+    CORRADE_VERIFY(converter.convertDataToData({}, "hello"_s));
+    CORRADE_COMPARE(wrapped.conversionCount, 2);
+    CORRADE_COMPARE(converter.hitCount(), 0);
+    CORRADE_COMPARE(converter.missCount(), 2);
+    CORRADE_VERIFY(!Utility::Path::exists(_directory) || Utility::Path::list(_directory, Utility::Path::ListFlag::SkipDirectories|Utility::Path::ListFlag::SkipDotAndDotDot)->isEmpty());
+}
+
+void CachingConverterTest::trim() {
+    CachingConverter converter{Containers::pointer<IncludingConverter>(), _directory};
+    auto& wrapped = static_cast<IncludingConverter&>(converter.converter());
+
+    /* Entries for all three sources have the same size, the limit fits two */
+    CORRADE_VERIFY(converter.convertDataToData({}, "aaaa"_s));
+    CORRADE_VERIFY(converter.convertDataToData({}, "bbbb"_s));
+    Containers::Optional<Containers::Array<Containers::String>> files = Utility::Path::list(_directory, Utility::Path::ListFlag::SkipDirectories|Utility::Path::ListFlag::SkipDotAndDotDot);
+    CORRADE_VERIFY(files);
+    CORRADE_COMPARE(files->size(), 2);
+    const Containers::Optional<std::size_t> entrySize = Utility::Path::size(Utility::Path::join(_directory, files->front()));
+    CORRADE_VERIFY(entrySize);
+
+    /* Nothing to trim if unlimited or within the limit */
+    CORRADE_COMPARE(converter.trim(), 0);
+    converter.setMaxSize(2**entrySize);
+    CORRADE_COMPARE(converter.trim(), 0);
+
+    /* Use the first one again so the second becomes least recently used.
+       The timestamps have a millisecond granularity, so wait a bit to make
+       the order deterministic. */
+    Utility::System::sleep(5);
+    CORRADE_VERIFY(converter.convertDataToData({}, "aaaa"_s));
+    CORRADE_COMPARE(converter.hitCount(), 1);
+
+    /* Adding a third entry evicts the least recently used one */
+    Utility::System::sleep(5);
+    CORRADE_VERIFY(converter.convertDataToData({}, "cccc"_s));
+    files = Utility::Path::list(_directory, Utility::Path::ListFlag::SkipDirectories|Utility::Path::ListFlag::SkipDotAndDotDot);
+    CORRADE_VERIFY(files);
+    CORRADE_COMPARE(files->size(), 2);
+
+    CORRADE_COMPARE(wrapped.conversionCount, 3);
+    CORRADE_VERIFY(converter.convertDataToData({}, "aaaa"_s));
+    CORRADE_VERIFY(converter.convertDataToData({}, "cccc"_s));
+    CORRADE_COMPARE(wrapped.conversionCount, 3);
+    CORRADE_VERIFY(converter.convertDataToData({}, "bbbb"_s));
+    CORRADE_COMPARE(wrapped.conversionCount, 4);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::ShaderTools::Test::CachingConverterTest)
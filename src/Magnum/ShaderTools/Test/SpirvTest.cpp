@@ -23,11 +23,17 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <sstream>
 #include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pair.h>
 #include <Corrade/Containers/String.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Path.h>
 
+#include "Magnum/ShaderTools/Spirv.h"
 #include "Magnum/ShaderTools/Implementation/spirv.h"
 #include "MagnumExternal/Vulkan/spirv.h"
 
@@ -49,6 +55,18 @@ struct SpirvTest: TestSuite::Tester {
 
     void entrypointInterface();
     void entrypointInterfaceNothing();
+
+    void specialize();
+    void specializeNoMatch();
+    void specializeSpecConstantOp();
+    void specializeLoopContinue();
+    void specializeInvalid();
+
+    void stripDebugInfo();
+    void stripDebugInfoNonSemantic();
+    void stripDebugInfoInvalid();
+
+    void deduplicate();
 };
 
 const UnsignedInt Data[] {
@@ -65,6 +83,14 @@ const UnsignedInt InvalidMagic[]{
     0 /* first instruction */
 };
 
+const struct {
+    const char* name;
+    bool value;
+} SpecializeData[] {
+    {"false", false},
+    {"true", true}
+};
+
 const struct {
     const char* name;
     Containers::ArrayView<const void> data;
@@ -90,6 +116,20 @@ SpirvTest::SpirvTest() {
 
               &SpirvTest::entrypointInterface,
               &SpirvTest::entrypointInterfaceNothing});
+
+    addInstancedTests({&SpirvTest::specialize},
+        Containers::arraySize(SpecializeData));
+
+    addTests({&SpirvTest::specializeNoMatch,
+              &SpirvTest::specializeSpecConstantOp,
+              &SpirvTest::specializeLoopContinue,
+              &SpirvTest::specializeInvalid,
+
+              &SpirvTest::stripDebugInfo,
+              &SpirvTest::stripDebugInfoNonSemantic,
+              &SpirvTest::stripDebugInfoInvalid,
+
+              &SpirvTest::deduplicate});
 }
 
 void SpirvTest::data() {
@@ -262,6 +302,315 @@ void SpirvTest::entrypointInterfaceNothing() {
     CORRADE_VERIFY(true);
 }
 
+/* "main" and "foo" as null-terminated SPIR-V string literals */
+constexpr UnsignedInt Main[]{0x6e69616d, 0};
+constexpr UnsignedInt Foo = 0x006f6f66;
+
+/* A fragment shader doing
+
+    int a = FEATURE ? 1 + 2 : 1;
+
+   where FEATURE is a boolean specialization constant with ID 3. */
+Containers::Array<UnsignedInt> specializeInput() {
+    return Containers::array<UnsignedInt>({
+        SpvMagicNumber, SpvVersion, 0, 20, 0,
+        op(2, SpvOpCapability), SpvCapabilityShader,
+        op(3, SpvOpMemoryModel), SpvAddressingModelLogical, SpvMemoryModelGLSL450,
+        op(5, SpvOpEntryPoint), SpvExecutionModelFragment, 4, Main[0], Main[1],
+        op(3, SpvOpExecutionMode), 4, SpvExecutionModeOriginUpperLeft,
+        op(4, SpvOpName), 4, Main[0], Main[1],
+        op(3, SpvOpName), 5, Foo,
+        op(4, SpvOpDecorate), 7, SpvDecorationSpecId, 3,
+        op(3, SpvOpDecorate), 5, SpvDecorationRelaxedPrecision,
+        op(2, SpvOpTypeVoid), 2,
+        op(3, SpvOpTypeFunction), 3, 2,
+        op(2, SpvOpTypeBool), 6,
+        op(4, SpvOpTypeInt), 8, 32, 1,
+        op(3, SpvOpSpecConstantTrue), 6, 7,
+        op(4, SpvOpConstant), 8, 9, 1,
+        op(4, SpvOpConstant), 8, 10, 2,
+        op(5, SpvOpFunction), 2, 4, SpvFunctionControlMaskNone, 3,
+        op(2, SpvOpLabel), 11,
+        op(3, SpvOpSelectionMerge), 13, SpvSelectionControlMaskNone,
+        op(4, SpvOpBranchConditional), 7, 12, 14,
+        op(2, SpvOpLabel), 12,
+        op(5, SpvOpIAdd), 8, 5, 9, 10,
+        op(2, SpvOpBranch), 13,
+        op(2, SpvOpLabel), 14,
+        op(2, SpvOpBranch), 13,
+        op(2, SpvOpLabel), 13,
+        op(7, SpvOpPhi), 8, 15, 5, 12, 9, 14,
+        op(1, SpvOpReturn),
+        op(1, SpvOpFunctionEnd)
+    });
+}
+
+void SpirvTest::specialize() {
+    auto&& data = SpecializeData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const Containers::Array<UnsignedInt> input = specializeInput();
+    const Containers::Pair<UnsignedInt, UnsignedInt> specializations[]{
+        {3, data.value}
+    };
+    Containers::Optional<Containers::Array<char>> out = specializeSpirv(input, specializations);
+    CORRADE_VERIFY(out);
+
+    /* The selection merge is gone together with the block that's not taken,
+       the OpPhi has just one parent left. The specialization ID decoration is
+       removed and for the false case also the name and decoration of the ID
+       defined in the removed block. */
+    if(data.value) CORRADE_COMPARE_AS(Containers::arrayCast<const UnsignedInt>(*out), Containers::arrayView<UnsignedInt>({
+        SpvMagicNumber, SpvVersion, 0, 20, 0,
+        op(2, SpvOpCapability), SpvCapabilityShader,
+        op(3, SpvOpMemoryModel), SpvAddressingModelLogical, SpvMemoryModelGLSL450,
+        op(5, SpvOpEntryPoint), SpvExecutionModelFragment, 4, Main[0], Main[1],
+        op(3, SpvOpExecutionMode), 4, SpvExecutionModeOriginUpperLeft,
+        op(4, SpvOpName), 4, Main[0], Main[1],
+        op(3, SpvOpName), 5, Foo,
+        op(3, SpvOpDecorate), 5, SpvDecorationRelaxedPrecision,
+        op(2, SpvOpTypeVoid), 2,
+        op(3, SpvOpTypeFunction), 3, 2,
+        op(2, SpvOpTypeBool), 6,
+        op(4, SpvOpTypeInt), 8, 32, 1,
+        op(3, SpvOpConstantTrue), 6, 7,
+        op(4, SpvOpConstant), 8, 9, 1,
+        op(4, SpvOpConstant), 8, 10, 2,
+        op(5, SpvOpFunction), 2, 4, SpvFunctionControlMaskNone, 3,
+        op(2, SpvOpLabel), 11,
+        op(2, SpvOpBranch), 12,
+        op(2, SpvOpLabel), 12,
+        op(5, SpvOpIAdd), 8, 5, 9, 10,
+        op(2, SpvOpBranch), 13,
+        op(2, SpvOpLabel), 13,
+        op(5, SpvOpPhi), 8, 15, 5, 12,
+        op(1, SpvOpReturn),
+        op(1, SpvOpFunctionEnd)
+    }), TestSuite::Compare::Container);
+    else CORRADE_COMPARE_AS(Containers::arrayCast<const UnsignedInt>(*out), Containers::arrayView<UnsignedInt>({
+        SpvMagicNumber, SpvVersion, 0, 20, 0,
+        op(2, SpvOpCapability), SpvCapabilityShader,
+        op(3, SpvOpMemoryModel), SpvAddressingModelLogical, SpvMemoryModelGLSL450,
+        op(5, SpvOpEntryPoint), SpvExecutionModelFragment, 4, Main[0], Main[1],
+        op(3, SpvOpExecutionMode), 4, SpvExecutionModeOriginUpperLeft,
+        op(4, SpvOpName), 4, Main[0], Main[1],
+        op(2, SpvOpTypeVoid), 2,
+        op(3, SpvOpTypeFunction), 3, 2,
+        op(2, SpvOpTypeBool), 6,
+        op(4, SpvOpTypeInt), 8, 32, 1,
+        op(3, SpvOpConstantFalse), 6, 7,
+        op(4, SpvOpConstant), 8, 9, 1,
+        op(4, SpvOpConstant), 8, 10, 2,
+        op(5, SpvOpFunction), 2, 4, SpvFunctionControlMaskNone, 3,
+        op(2, SpvOpLabel), 11,
+        op(2, SpvOpBranch), 14,
+        op(2, SpvOpLabel), 14,
+        op(2, SpvOpBranch), 13,
+        op(2, SpvOpLabel), 13,
+        op(5, SpvOpPhi), 8, 15, 9, 14,
+        op(1, SpvOpReturn),
+        op(1, SpvOpFunctionEnd)
+    }), TestSuite::Compare::Container);
+}
+
+void SpirvTest::specializeNoMatch() {
+    const Containers::Array<UnsignedInt> input = specializeInput();
+    const Containers::Pair<UnsignedInt, UnsignedInt> specializations[]{
+        {4, 0}
+    };
+    Containers::Optional<Containers::Array<char>> out = specializeSpirv(input, specializations);
+    CORRADE_VERIFY(out);
+    CORRADE_COMPARE_AS(Containers::arrayCast<const UnsignedInt>(*out),
+        Containers::arrayView(input),
+        TestSuite::Compare::Container);
+}
+
+void SpirvTest::specializeSpecConstantOp() {
+    const UnsignedInt input[]{
+        SpvMagicNumber, SpvVersion, 0, 20, 0,
+        op(2, SpvOpCapability), SpvCapabilityShader,
+        op(4, SpvOpDecorate), 16, SpvDecorationSpecId, 1,
+        op(2, SpvOpTypeBool), 6,
+        op(4, SpvOpTypeInt), 8, 32, 1,
+        op(4, SpvOpConstant), 8, 9, 1,
+        op(4, SpvOpSpecConstant), 8, 16, 3,
+        op(6, SpvOpSpecConstantOp), 6, 17, SpvOpSGreaterThan, 16, 9,
+        op(5, SpvOpSpecConstantOp), 6, 18, SpvOpLogicalNot, 17,
+        /* Not a boolean operation, stays */
+        op(6, SpvOpSpecConstantOp), 8, 19, SpvOpIAdd, 16, 9
+    };
+    const Containers::Pair<UnsignedInt, UnsignedInt> specializations[]{
+        {1, 0}
+    };
+    Containers::Optional<Containers::Array<char>> out = specializeSpirv(input, specializations);
+    CORRADE_VERIFY(out);
+    CORRADE_COMPARE_AS(Containers::arrayCast<const UnsignedInt>(*out), Containers::arrayView<UnsignedInt>({
+        SpvMagicNumber, SpvVersion, 0, 20, 0,
+        op(2, SpvOpCapability), SpvCapabilityShader,
+        op(2, SpvOpTypeBool), 6,
+        op(4, SpvOpTypeInt), 8, 32, 1,
+        op(4, SpvOpConstant), 8, 9, 1,
+        op(4, SpvOpConstant), 8, 16, 0,
+        op(3, SpvOpConstantFalse), 6, 17,
+        op(3, SpvOpConstantTrue), 6, 18,
+        op(6, SpvOpSpecConstantOp), 8, 19, SpvOpIAdd, 16, 9
+    }), TestSuite::Compare::Container);
+}
+
+void SpirvTest::specializeLoopContinue() {
+    /* A loop that's always exited from the body, so the continue block
+       becomes unreachable. It has to stay as a stub branching back to the
+       header and the header OpPhi gets an OpUndef for it. */
+    const UnsignedInt input[]{
+        SpvMagicNumber, SpvVersion, 0, 30, 0,
+        op(2, SpvOpCapability), SpvCapabilityShader,
+        op(3, SpvOpMemoryModel), SpvAddressingModelLogical, SpvMemoryModelGLSL450,
+        op(4, SpvOpDecorate), 7, SpvDecorationSpecId, 0,
+        op(2, SpvOpTypeVoid), 2,
+        op(3, SpvOpTypeFunction), 3, 2,
+        op(2, SpvOpTypeBool), 6,
+        op(4, SpvOpTypeInt), 8, 32, 1,
+        op(3, SpvOpSpecConstantFalse), 6, 7,
+        op(4, SpvOpConstant), 8, 9, 1,
+        op(5, SpvOpFunction), 2, 4, SpvFunctionControlMaskNone, 3,
+        op(2, SpvOpLabel), 11,
+        op(2, SpvOpBranch), 12,
+        op(2, SpvOpLabel), 12,
+        op(7, SpvOpPhi), 8, 20, 9, 11, 21, 14,
+        op(4, SpvOpLoopMerge), 13, 14, SpvLoopControlMaskNone,
+        op(2, SpvOpBranch), 15,
+        op(2, SpvOpLabel), 15,
+        op(4, SpvOpBranchConditional), 7, 13, 14,
+        op(2, SpvOpLabel), 14,
+        op(5, SpvOpIAdd), 8, 21, 20, 9,
+        op(2, SpvOpBranch), 12,
+        op(2, SpvOpLabel), 13,
+        op(1, SpvOpReturn),
+        op(1, SpvOpFunctionEnd)
+    };
+    const Containers::Pair<UnsignedInt, UnsignedInt> specializations[]{
+        {0, 1}
+    };
+    Containers::Optional<Containers::Array<char>> out = specializeSpirv(input, specializations);
+    CORRADE_VERIFY(out);
+    CORRADE_COMPARE_AS(Containers::arrayCast<const UnsignedInt>(*out), Containers::arrayView<UnsignedInt>({
+        /* The ID bound is increased for the OpUndef */
+        SpvMagicNumber, SpvVersion, 0, 31, 0,
+        op(2, SpvOpCapability), SpvCapabilityShader,
+        op(3, SpvOpMemoryModel), SpvAddressingModelLogical, SpvMemoryModelGLSL450,
+        op(2, SpvOpTypeVoid), 2,
+        op(3, SpvOpTypeFunction), 3, 2,
+        op(2, SpvOpTypeBool), 6,
+        op(4, SpvOpTypeInt), 8, 32, 1,
+        op(3, SpvOpConstantTrue), 6, 7,
+        op(4, SpvOpConstant), 8, 9, 1,
+        op(3, SpvOpUndef), 8, 30,
+        op(5, SpvOpFunction), 2, 4, SpvFunctionControlMaskNone, 3,
+        op(2, SpvOpLabel), 11,
+        op(2, SpvOpBranch), 12,
+        op(2, SpvOpLabel), 12,
+        op(7, SpvOpPhi), 8, 20, 9, 11, 30, 14,
+        op(4, SpvOpLoopMerge), 13, 14, SpvLoopControlMaskNone,
+        op(2, SpvOpBranch), 15,
+        op(2, SpvOpLabel), 15,
+        op(2, SpvOpBranch), 13,
+        op(2, SpvOpLabel), 14,
+        op(2, SpvOpBranch), 12,
+        op(2, SpvOpLabel), 13,
+        op(1, SpvOpReturn),
+        op(1, SpvOpFunctionEnd)
+    }), TestSuite::Compare::Container);
+}
+
+void SpirvTest::specializeInvalid() {
+    const UnsignedInt invalidInstruction[]{
+        SpvMagicNumber, SpvVersion, 0, 20, 0,
+        op(2, SpvOpCapability), SpvCapabilityShader,
+        /* Should be 2 */
+        op(3, SpvOpCapability), SpvCapabilityShader
+    };
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!specializeSpirv(Containers::arrayView(JustHeader), {}));
+    CORRADE_VERIFY(!specializeSpirv(invalidInstruction, {}));
+    CORRADE_COMPARE(out.str(),
+        "ShaderTools::specializeSpirv(): the data isn't a SPIR-V binary\n"
+        "ShaderTools::specializeSpirv(): invalid instruction at word 7\n");
+}
+
+void SpirvTest::stripDebugInfo() {
+    const UnsignedInt input[]{
+        SpvMagicNumber, SpvVersion, 0, 10, 0,
+        op(2, SpvOpCapability), SpvCapabilityShader,
+        op(3, SpvOpString), 5, Foo,
+        op(3, SpvOpSource), SpvSourceLanguageGLSL, 450,
+        op(3, SpvOpName), 2, Foo,
+        op(2, SpvOpTypeVoid), 2,
+        op(4, SpvOpLine), 5, 1, 1,
+        op(1, SpvOpNoLine)
+    };
+    Containers::Optional<Containers::Array<char>> out = stripSpirvDebugInfo(input);
+    CORRADE_VERIFY(out);
+    CORRADE_COMPARE_AS(Containers::arrayCast<const UnsignedInt>(*out), Containers::arrayView<UnsignedInt>({
+        SpvMagicNumber, SpvVersion, 0, 10, 0,
+        op(2, SpvOpCapability), SpvCapabilityShader,
+        op(2, SpvOpTypeVoid), 2
+    }), TestSuite::Compare::Container);
+}
+
+void SpirvTest::stripDebugInfoNonSemantic() {
+    const UnsignedInt input[]{
+        SpvMagicNumber, SpvVersion, 0, 10, 0,
+        op(2, SpvOpCapability), SpvCapabilityShader,
+        /* "NonSemantic.Foo" */
+        op(6, SpvOpExtInstImport), 1, 0x536e6f4e, 0x6e616d65, 0x2e636974, 0x006f6f46,
+        op(3, SpvOpString), 5, Foo,
+        op(3, SpvOpName), 2, Foo,
+        op(2, SpvOpTypeVoid), 2
+    };
+    Containers::Optional<Containers::Array<char>> out = stripSpirvDebugInfo(input);
+    CORRADE_VERIFY(out);
+    CORRADE_COMPARE_AS(Containers::arrayCast<const UnsignedInt>(*out), Containers::arrayView<UnsignedInt>({
+        SpvMagicNumber, SpvVersion, 0, 10, 0,
+        op(2, SpvOpCapability), SpvCapabilityShader,
+        op(6, SpvOpExtInstImport), 1, 0x536e6f4e, 0x6e616d65, 0x2e636974, 0x006f6f46,
+        op(3, SpvOpString), 5, Foo,
+        op(2, SpvOpTypeVoid), 2
+    }), TestSuite::Compare::Container);
+}
+
+void SpirvTest::stripDebugInfoInvalid() {
+    const UnsignedInt invalidInstruction[]{
+        SpvMagicNumber, SpvVersion, 0, 20, 0,
+        /* Zero size */
+        op(0, SpvOpCapability), SpvCapabilityShader
+    };
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!stripSpirvDebugInfo(Containers::arrayView(InvalidMagic)));
+    CORRADE_VERIFY(!stripSpirvDebugInfo(invalidInstruction));
+    CORRADE_COMPARE(out.str(),
+        "ShaderTools::stripSpirvDebugInfo(): the data isn't a SPIR-V binary\n"
+        "ShaderTools::stripSpirvDebugInfo(): invalid instruction at word 5\n");
+}
+
+void SpirvTest::deduplicate() {
+    const UnsignedInt a[]{SpvMagicNumber, SpvVersion, 0, 10, 0, op(2, SpvOpCapability), SpvCapabilityShader};
+    const UnsignedInt b[]{SpvMagicNumber, SpvVersion, 0, 10, 0, op(2, SpvOpCapability), SpvCapabilityShader};
+    const UnsignedInt c[]{SpvMagicNumber, SpvVersion, 0, 10, 0, op(2, SpvOpCapability), SpvCapabilityKernel};
+    /* Same prefix as a, but longer */
+    const UnsignedInt d[]{SpvMagicNumber, SpvVersion, 0, 10, 0, op(2, SpvOpCapability), SpvCapabilityShader, op(1, SpvOpNop)};
+
+    const Containers::ArrayView<const void> variants[]{a, c, b, d, a, c};
+    Containers::Pair<Containers::Array<UnsignedInt>, std::size_t> out = deduplicateSpirv(variants);
+    CORRADE_COMPARE(out.second(), 3);
+    CORRADE_COMPARE_AS(out.first(), Containers::arrayView<UnsignedInt>({
+        0, 1, 0, 3, 0, 1
+    }), TestSuite::Compare::Container);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::ShaderTools::Test::SpirvTest)
@@ -23,9 +23,11 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <chrono>
 #include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/String.h>
 #include <Corrade/Utility/Arguments.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Path.h>
@@ -33,6 +35,7 @@
 #include "Magnum/Implementation/converterUtilities.h"
 #include "Magnum/Math/Functions.h"
 #include "Magnum/ShaderTools/AbstractConverter.h"
+#include "Magnum/ShaderTools/CachingConverter.h"
 #include "Magnum/ShaderTools/Stage.h"
 #include "Magnum/ShaderTools/Implementation/spirv.h"
 
@@ -89,12 +92,14 @@ magnum-shaderconverter phong.frag phong.frag.spv \
 @code{.sh}
 magnum-shaderconverter [-h|--help] [--validate] [--link]
     [-C|--converter NAME]... [--plugin-dir DIR]
-    [-c|--converter-options key=val,key2=val2,…]... [--info] [-q|--quiet]
+    [-c|--converter-options key=val,key2=val2,…]... [--cache-dir DIR]
+    [--info] [-q|--quiet]
     [-v|--verbose] [--warning-as-error] [-E|--preprocess-only]
     [-D|--define name=value]... [-U|--undefine name]... [-O|--optimize LEVEL]
     [-g|--debug-info LEVEL] [--input-format glsl|spv|spvasm|hlsl|metal]...
     [--output-format glsl|spv|spvasm|hlsl|metal]...
     [--input-version VERSION]... [--output-version VERSION]...
+    [--batch FILE] [-j|--jobs N] [--profile]
     [--] input... output
 @endcode
 
@@ -114,6 +119,8 @@ Arguments:
 -   `--plugin-dir DIR` --- override base plugin dir
 -   `-c`, `--converter-options key=val,key2=val2,…` --- configuration options
     to pass to the converter(s)
+-   `--cache-dir DIR` --- cache conversion results in given directory. Wraps
+    the converter(s) in a @ref ShaderTools::CachingConverter.
 -   `--info` --- print SPIR-V module info and exit
 -   `-q`, `--quiet` --- quiet output from converter plugin(s). Corresponds to
     the @ref ShaderTools::ConverterFlag::Quiet flag.
@@ -137,6 +144,13 @@ Arguments:
     converter
 -   `--input-version VERSION` --- input format version for each converter
 -   `--output-version VERSION` --- output format version for each converter
+-   `--batch FILE` --- convert all permutations listed in given manifest file
+    instead of a single `input` and `output`. See
+    @ref magnum-shaderconverter-usage-batch below.
+-   `-j`, `--jobs N` --- number of parallel conversion jobs for `--batch`
+    (default: @cpp 0 @ce, which is all available cores)
+-   `--profile` --- print per-permutation conversion time and output size for
+    `--batch`
 
 If `--validate` is given, the utility will validate the `input` file using
 passed `--converter` (or @ref ShaderTools::AnyConverter "AnyShaderConverter" if
@@ -166,11 +180,53 @@ The `-D` / `--define`, `-U` / `--undefine`, `-O` / `--optimize`, `-g` /
 converter. Split the conversion to multiple passes if you need to pass those to
 converters later in the chain.
 
+If `--cache-dir` is given, results of each conversion step are cached in given
+directory, keyed by the input contents, contents of all files it includes and
+all options affecting the output, including the `-c` / `--converter-options`.
+A conversion step that matches a cache entry is skipped, making incremental
+shader builds significantly faster. Validation and linking are not cached. See
+@ref ShaderTools::CachingConverter for more information.
+
 Values accepted by `-O` / `--optimize`, `-g` / `--debug-info`, `--input-format`,
 `--output-format`, `--input-version` and `--output-version` are
 converter-specific, see documentation of a particular converter for more
 information.
 
+@subsection magnum-shaderconverter-usage-batch Batch conversion
+
+With `--batch`, the `input` and `output` arguments are omitted and the utility
+instead converts all permutations listed in given manifest file, spreading the
+work across `-j` / `--jobs` threads. Each non-empty line that doesn't start
+with `#` contains a whitespace-separated input and output file, optionally
+followed by a `--stage=NAME` option and any number of `-DNAME`,
+`-DNAME=VALUE` and `-UNAME` options that get added to the global `-D` /
+`--define` and `-U` / `--undefine` for given permutation. Accepted stage names
+are `vertex`, `fragment`, `geometry`, `tessellation-control`,
+`tessellation-evaluation`, `compute`, `ray-generation`, `ray-any-hit`,
+`ray-closest-hit`, `ray-miss`, `ray-intersection`, `ray-callable`,
+`mesh-task`, `mesh` and `kernel`. For example:
+
+@code{.sh}
+# Input file      Output file             Stage and definitions
+phong.glsl        phong.vert.spv          --stage=vertex
+phong.glsl        phong.frag.spv          --stage=fragment
+phong.glsl        phong-textured.frag.spv --stage=fragment -DDIFFUSE_TEXTURE
+phong.glsl        phong-lights4.frag.spv  --stage=fragment -DLIGHT_COUNT=4
+@endcode
+
+@code{.sh}
+magnum-shaderconverter --batch permutations.txt -j 8 --profile \
+    --output-version opengl4.5 --cache-dir .shadercache
+@endcode
+
+Every thread gets its own converter instance, with all remaining options
+applied the same way as in the single-file case. Only a single `-C` /
+`--converter` is allowed, and `--validate`, `--link` and `--info` can't be
+used together with `--batch`. If `--profile` is passed, the conversion time
+and output size of each permutation is printed in the manifest order,
+followed by the total time. The utility exits with a non-zero code if any of
+the permutations failed to convert.
+
 */
 
 }
@@ -231,6 +287,270 @@ void printSpirvInfo(Containers::ArrayView<const UnsignedInt> data) {
     }
 }
 
+Containers::Optional<ShaderTools::Format> parseFormat(const Containers::StringView format) {
+    if(format == ""_s) return ShaderTools::Format::Unspecified;
+    if(format == "glsl"_s) return ShaderTools::Format::Glsl;
+    if(format == "spv"_s) return ShaderTools::Format::Spirv;
+    if(format == "spvasm"_s) return ShaderTools::Format::SpirvAssembly;
+    if(format == "hlsl"_s) return ShaderTools::Format::Hlsl;
+    if(format == "metal"_s) return ShaderTools::Format::Msl;
+    /** @todo wgsl and dxil once i figure out the extensions */
+
+    Error{} << "Unrecognized format" << format << Debug::nospace << ", expected glsl, spv, spvasm, hlsl or metal";
+    return {};
+}
+
+Containers::Optional<ShaderTools::Stage> parseStage(const Containers::StringView stage) {
+    if(stage == "vertex"_s) return ShaderTools::Stage::Vertex;
+    if(stage == "fragment"_s) return ShaderTools::Stage::Fragment;
+    if(stage == "geometry"_s) return ShaderTools::Stage::Geometry;
+    if(stage == "tessellation-control"_s) return ShaderTools::Stage::TessellationControl;
+    if(stage == "tessellation-evaluation"_s) return ShaderTools::Stage::TessellationEvaluation;
+    if(stage == "compute"_s) return ShaderTools::Stage::Compute;
+    if(stage == "ray-generation"_s) return ShaderTools::Stage::RayGeneration;
+    if(stage == "ray-any-hit"_s) return ShaderTools::Stage::RayAnyHit;
+    if(stage == "ray-closest-hit"_s) return ShaderTools::Stage::RayClosestHit;
+    if(stage == "ray-miss"_s) return ShaderTools::Stage::RayMiss;
+    if(stage == "ray-intersection"_s) return ShaderTools::Stage::RayIntersection;
+    if(stage == "ray-callable"_s) return ShaderTools::Stage::RayCallable;
+    if(stage == "mesh-task"_s) return ShaderTools::Stage::MeshTask;
+    if(stage == "mesh"_s) return ShaderTools::Stage::Mesh;
+    if(stage == "kernel"_s) return ShaderTools::Stage::Kernel;
+
+    Error{} << "Unrecognized stage" << stage;
+    return {};
+}
+
+/* Wraps the converter in a cache if --cache-dir is set. Done before setting
+   any formats, flags or definitions so they become a part of the cache key.
+   Plugin configuration isn't tracked by the cache, so the options get passed
+   as the version string. */
+void cacheConverter(Containers::Pointer<ShaderTools::AbstractConverter>& converter, const Utility::Arguments& args, const std::size_t i) {
+    if(args.value<Containers::StringView>("cache-dir").isEmpty()) return;
+
+    Containers::Pointer<ShaderTools::CachingConverter> cachingConverter{InPlaceInit, std::move(converter), args.value<Containers::StringView>("cache-dir")};
+    if(i < args.arrayValueCount("converter-options"))
+        cachingConverter->setVersion(args.arrayValue<Containers::StringView>("converter-options", i));
+    converter = std::move(cachingConverter);
+}
+
+struct BatchEntry {
+    Containers::StringView input, output;
+    ShaderTools::Stage stage;
+    /* Definitions specific to this permutation, views into the manifest */
+    Containers::Array<Containers::Pair<Containers::StringView, Containers::StringView>> definitions;
+    std::chrono::high_resolution_clock::duration time;
+    std::size_t size;
+    bool succeeded;
+};
+
+/* Parses a --batch manifest. Each non-empty line that doesn't start with #
+   contains a whitespace-separated input and output filename, optionally
+   followed by --stage=NAME, -DNAME[=VALUE] and -UNAME. The entries reference
+   the manifest contents, which thus have to stay in scope. */
+Containers::Optional<Containers::Array<BatchEntry>> parseBatchManifest(const Containers::StringView filename, const Containers::StringView manifest) {
+    Containers::Array<BatchEntry> entries;
+    const Containers::Array<Containers::StringView> lines = manifest.split('\n');
+    for(std::size_t i = 0; i != lines.size(); ++i) {
+        const Containers::StringView line = lines[i].trimmed();
+        if(line.isEmpty() || line.hasPrefix('#')) continue;
+
+        const Containers::Array<Containers::StringView> tokens = line.splitOnWhitespaceWithoutEmpty();
+        if(tokens.size() < 2) {
+            Error{} << "Invalid batch manifest line" << i + 1 << "in" << filename << Debug::nospace << ", expected an input and an output file but got" << line;
+            return {};
+        }
+
+        BatchEntry entry{tokens[0], tokens[1], ShaderTools::Stage::Unspecified, {}, {}, 0, false};
+        for(const Containers::StringView token: tokens.exceptPrefix(2)) {
+            if(token.hasPrefix("--stage="_s)) {
+                const Containers::Optional<ShaderTools::Stage> stage = parseStage(token.exceptPrefix("--stage="_s));
+                if(!stage) {
+                    Error{} << "Invalid batch manifest line" << i + 1 << "in" << filename;
+                    return {};
+                }
+                entry.stage = *stage;
+            } else if(token.hasPrefix("-D"_s) && token.size() > 2) {
+                const Containers::Array3<Containers::StringView> define = token.exceptPrefix(2).partition('=');
+                arrayAppend(entry.definitions, InPlaceInit, define[0], define[2]);
+            } else if(token.hasPrefix("-U"_s) && token.size() > 2) {
+                arrayAppend(entry.definitions, InPlaceInit, token.exceptPrefix(2), nullptr);
+            } else {
+                Error{} << "Invalid batch manifest line" << i + 1 << "in" << filename << Debug::nospace << ", expected --stage=NAME, -DNAME[=VALUE] or -UNAME but got" << token;
+                return {};
+            }
+        }
+
+        arrayAppend(entries, std::move(entry));
+    }
+
+    return Containers::optional(std::move(entries));
+}
+
+/* Every worker has its own manager, as the Any* plugins load their delegates
+   through it, which isn't safe to do from multiple threads */
+struct BatchWorker {
+    Containers::Pointer<PluginManager::Manager<ShaderTools::AbstractConverter>> manager;
+    Containers::Pointer<ShaderTools::AbstractConverter> converter;
+};
+
+int convertBatch(const Utility::Arguments& args) {
+    if(args.arrayValueCount("input") || !args.value("output").empty()) {
+        Error{} << "Input and output files shouldn't be set for --batch";
+        return 1;
+    }
+    if(args.isSet("validate") || args.isSet("link") || args.isSet("info")) {
+        Error{} << "The --batch option can't be combined with --validate, --link or --info";
+        return 1;
+    }
+    if(args.arrayValueCount("converter") > 1) {
+        Error{} << "Cannot use multiple converters with --batch";
+        return 5;
+    }
+    if(args.isSet("quiet") && args.isSet("verbose")) {
+        Error{} << "Can't set both --quiet and --verbose";
+        return 6;
+    }
+    if(args.isSet("quiet") && args.isSet("warning-as-error")) {
+        Error{} << "Can't set both --quiet and --warning-as-error";
+        return 6;
+    }
+
+    const Containers::Optional<Containers::String> manifest = Utility::Path::readString(args.value("batch"));
+    if(!manifest) {
+        Error{} << "Cannot read the batch manifest" << args.value("batch");
+        return 3;
+    }
+    Containers::Optional<Containers::Array<BatchEntry>> entries = parseBatchManifest(args.value("batch"), *manifest);
+    if(!entries) return 3;
+
+    /* Formats and global definitions are the same for all permutations */
+    ShaderTools::Format inputFormat{}, outputFormat{};
+    if(args.arrayValueCount("input-format")) {
+        if(const Containers::Optional<ShaderTools::Format> format = parseFormat(args.arrayValue<Containers::StringView>("input-format", 0)))
+            inputFormat = *format;
+        else return 8;
+    }
+    if(args.arrayValueCount("output-format")) {
+        if(const Containers::Optional<ShaderTools::Format> format = parseFormat(args.arrayValue<Containers::StringView>("output-format", 0)))
+            outputFormat = *format;
+        else return 9;
+    }
+    Containers::Array<Containers::Pair<Containers::StringView, Containers::StringView>> globalDefinitions;
+    for(std::size_t j = 0; j != args.arrayValueCount("define"); ++j) {
+        const Containers::Array3<Containers::StringView> define =
+        args.arrayValue<Containers::StringView>("define", j).partition('=');
+        arrayAppend(globalDefinitions, InPlaceInit, define[0], define[2]);
+    }
+    for(std::size_t j = 0; j != args.arrayValueCount("undefine"); ++j)
+        arrayAppend(globalDefinitions, InPlaceInit,
+            args.arrayValue<Containers::StringView>("undefine", j), nullptr);
+    bool hasDefinitions = !globalDefinitions.isEmpty();
+    for(const BatchEntry& entry: *entries)
+        if(!entry.definitions.isEmpty()) hasDefinitions = true;
+
+    ShaderTools::ConverterFlags flags;
+    if(args.isSet("quiet")) flags |= ShaderTools::ConverterFlag::Quiet;
+    if(args.isSet("verbose")) flags |= ShaderTools::ConverterFlag::Verbose;
+    if(args.isSet("warning-as-error")) flags |= ShaderTools::ConverterFlag::WarningAsError;
+    if(args.isSet("preprocess-only")) flags |= ShaderTools::ConverterFlag::PreprocessOnly;
+
+    /* Load all plugins upfront on the main thread, so the workers only do the
+       actual conversion */
+    const std::string converterName = args.arrayValueCount("converter") ?
+        args.arrayValue("converter", 0) : "AnyShaderConverter";
+    Containers::Array<BatchWorker> workers{Implementation::batchWorkerCount(args.value<UnsignedInt>("jobs"), entries->size())};
+    for(BatchWorker& worker: workers) {
+        worker.manager.emplace(
+            args.value("plugin-dir").empty() ? Containers::String{} :
+            Utility::Path::join(args.value("plugin-dir"), ShaderTools::AbstractConverter::pluginSearchPaths().back()));
+        if(!(worker.converter = worker.manager->loadAndInstantiate(converterName))) {
+            Debug{} << "Available converter plugins:" << ", "_s.join(worker.manager->aliasList());
+            return 7;
+        }
+
+        if(args.arrayValueCount("converter-options"))
+            Implementation::setOptions(*worker.converter, "AnyShaderConverter", args.arrayValue("converter-options", 0));
+        cacheConverter(worker.converter, args, 0);
+
+        if(!(worker.converter->features() >= ShaderTools::ConverterFeature::ConvertFile)) {
+            Error{} << converterName << "doesn't support file conversion";
+            return 15;
+        }
+        if((args.isSet("preprocess-only") || hasDefinitions) && !(worker.converter->features() >= ShaderTools::ConverterFeature::Preprocess)) {
+            Error{} << "The -E / -D / -U options are set, but" << converterName << "doesn't support preprocessing";
+            return 10;
+        }
+
+        worker.converter->setInputFormat(inputFormat, args.arrayValueCount("input-version") ? args.arrayValue<Containers::StringView>("input-version", 0) : Containers::StringView{});
+        worker.converter->setOutputFormat(outputFormat, args.arrayValueCount("output-version") ? args.arrayValue<Containers::StringView>("output-version", 0) : Containers::StringView{});
+        worker.converter->addFlags(flags);
+
+        if(!args.value<Containers::StringView>("optimize").isEmpty()) {
+            if(!(worker.converter->features() >= ShaderTools::ConverterFeature::Optimize)) {
+                Error{} << "The -O option is set, but" << converterName << "doesn't support optimization";
+                return 11;
+            }
+
+            worker.converter->setOptimizationLevel(args.value<Containers::StringView>("optimize"));
+        }
+
+        if(!args.value<Containers::StringView>("debug-info").isEmpty()) {
+            if(!(worker.converter->features() >= ShaderTools::ConverterFeature::DebugInfo)) {
+                Error{} << "The -g option is set, but" << converterName << "doesn't support debug info";
+                return 12;
+            }
+
+            worker.converter->setDebugInfoLevel(args.value<Containers::StringView>("debug-info"));
+        }
+    }
+
+    const std::chrono::high_resolution_clock::time_point totalStart = std::chrono::high_resolution_clock::now();
+    Implementation::runBatch(workers.size(), entries->size(), [&](const std::size_t workerId, const std::size_t i) {
+        ShaderTools::AbstractConverter& converter = *workers[workerId].converter;
+        BatchEntry& entry = (*entries)[i];
+        const std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+        /* Definitions are set for every permutation to reset whatever was set
+           for the previous one */
+        if(hasDefinitions) {
+            Containers::Array<Containers::Pair<Containers::StringView, Containers::StringView>> definitions;
+            arrayReserve(definitions, globalDefinitions.size() + entry.definitions.size());
+            arrayAppend(definitions, globalDefinitions);
+            arrayAppend(definitions, entry.definitions);
+            converter.setDefinitions(definitions);
+        }
+
+        if(!converter.convertFileToFile(entry.stage, entry.input, entry.output))
+            Error{} << "Cannot convert" << entry.input << "to" << entry.output;
+        else {
+            entry.succeeded = true;
+            if(const Containers::Optional<std::size_t> size = Utility::Path::size(entry.output))
+                entry.size = *size;
+        }
+
+        entry.time = std::chrono::high_resolution_clock::now() - start;
+    });
+    const std::chrono::high_resolution_clock::duration totalTime = std::chrono::high_resolution_clock::now() - totalStart;
+
+    /* Print per-permutation stats in the manifest order. The input is usually
+       shared among many permutations, so the output is what identifies them. */
+    std::size_t failed = 0;
+    for(const BatchEntry& entry: *entries) {
+        if(!entry.succeeded) ++failed;
+        if(!args.isSet("profile")) continue;
+
+        Debug d;
+        d << entry.output << Debug::nospace << ": conversion took" << UnsignedInt(std::chrono::duration_cast<std::chrono::milliseconds>(entry.time).count())/1.0e3f << "seconds";
+        if(entry.succeeded) d << Debug::nospace << "," << entry.size << "bytes";
+        else d << "(failed)";
+    }
+    if(args.isSet("profile"))
+        Debug{} << "Converted" << entries->size() - failed << "out of" << entries->size() << "permutations with" << workers.size() << "workers in" << UnsignedInt(std::chrono::duration_cast<std::chrono::milliseconds>(totalTime).count())/1.0e3f << "seconds";
+
+    return failed ? 1 : 0;
+}
+
 }
 
 int main(int argc, char** argv) {
@@ -242,6 +562,7 @@ int main(int argc, char** argv) {
         .addArrayOption('C', "converter").setHelp("converter", "shader converter plugin(s)")
         .addOption("plugin-dir").setHelp("plugin-dir", "override base plugin dir", "DIR")
         .addArrayOption('c', "converter-options").setHelp("converter-options", "configuration options to pass to the converter(s)", "key=val,key2=val2,…")
+        .addOption("cache-dir").setHelp("cache-dir", "cache conversion results in given directory", "DIR")
         .addBooleanOption("info").setHelp("info", "print SPIR-V module info and exit")
         .addBooleanOption('q', "quiet").setHelp("quiet", "quiet output from converter plugin(s)")
         .addBooleanOption('v', "verbose").setHelp("verbose", "verbose output from converter plugin(s)")
@@ -256,7 +577,16 @@ int main(int argc, char** argv) {
         .addArrayOption("output-format").setHelp("output-format", "output format for each converter", "glsl|spv|spvasm|hlsl|metal")
         .addArrayOption("input-version").setHelp("input-version", "input format version for each converter", "VERSION")
         .addArrayOption("output-version").setHelp("output-version", "output format version for each converter", "VERSION")
+        .addOption("batch").setHelp("batch", "convert all permutations listed in given manifest file", "FILE")
+        .addOption('j', "jobs", "0").setHelp("jobs", "number of parallel conversion jobs for --batch, 0 means all available cores", "N")
+        .addBooleanOption("profile").setHelp("profile", "print per-permutation conversion time and output size for --batch")
         .setParseErrorCallback([](const Utility::Arguments& args, Utility::Arguments::ParseError error, const std::string& key) {
+            /* If --batch is passed, we don't need the input and output
+               arguments */
+            if(error == Utility::Arguments::ParseError::MissingArgument &&
+               (key == "input" || key == "output") && !args.value("batch").empty())
+                return true;
+
             /* If --info / --validate is passed, we don't need the output
                argument */
             if(error == Utility::Arguments::ParseError::MissingArgument &&
@@ -296,11 +626,27 @@ The -D / --define, -U / --undefine, -O / --optimize, -g / --debug-info, -E /
 conversion to multiple passes if you need to pass those to converters later in
 the chain.
 
+If --cache-dir is given, results of each conversion step are cached in given
+directory, keyed by the input contents, contents of all files it includes and
+all options affecting the output. Validation and linking are not cached.
+
 Values accepted by -O / --optimize, -g / --debug-info, --input-format,
 --output-format, --input-version and --output-version are converter-specific,
-see documentation of a particular converter for more information.)")
+see documentation of a particular converter for more information.
+
+If --batch is given, the input and output arguments are omitted and all
+permutations listed in given manifest file are converted in parallel using -j /
+--jobs threads. Each non-empty line that doesn't start with # contains an input
+and output file, optionally followed by --stage=NAME, -DNAME[=VALUE] and
+-UNAME options that get added to the global -D / -U for given permutation.
+Stage names are lowercase and hyphenated, such as vertex, fragment,
+tessellation-control or ray-any-hit. Only a single --converter is allowed and
+--validate, --link and --info can't be combined with --batch. With --profile,
+conversion time and output size of each permutation is printed.)")
         .parse(argc, argv);
 
+    if(!args.value("batch").empty()) return convertBatch(args);
+
     /* Generic checks */
     if(!args.value<Containers::StringView>("output").isEmpty()) {
         if(args.isSet("validate")) {
@@ -378,23 +724,14 @@ see documentation of a particular converter for more information.)")
         if(i < args.arrayValueCount("converter-options"))
             Implementation::setOptions(*converter, "AnyShaderConverter", args.arrayValue("converter-options", i));
 
+        /* Wrap the converter in a cache, if desired */
+        cacheConverter(converter, args, i);
+
         /* Parse format, if passed. If --info is desired, implicitly set the
            output format to SPIR-V */
         ShaderTools::Format inputFormat{}, outputFormat{};
         if(args.isSet("info"))
             outputFormat = ShaderTools::Format::Spirv;
-        auto parseFormat = [](Containers::StringView format) -> Containers::Optional<ShaderTools::Format> {
-            if(format == ""_s) return ShaderTools::Format::Unspecified;
-            if(format == "glsl"_s) return ShaderTools::Format::Glsl;
-            if(format == "spv"_s) return ShaderTools::Format::Spirv;
-            if(format == "spvasm"_s) return ShaderTools::Format::SpirvAssembly;
-            if(format == "hlsl"_s) return ShaderTools::Format::Hlsl;
-            if(format == "metal"_s) return ShaderTools::Format::Msl;
-            /** @todo wgsl and dxil once i figure out the extensions */
-
-            Error{} << "Unrecognized format" << format << Debug::nospace << ", expected glsl, spv, spvasm, hlsl or metal";
-            return {};
-        };
         if(i < args.arrayValueCount("input-format")) {
             if(const Containers::Optional<ShaderTools::Format> format = parseFormat(args.arrayValue<Containers::StringView>("input-format", i)))
                 inputFormat = *format;
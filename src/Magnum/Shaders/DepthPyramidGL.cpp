@@ -0,0 +1,150 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "DepthPyramidGL.h"
+
+#include <Corrade/Containers/Reference.h>
+#include <Corrade/Utility/Resource.h>
+
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/ImageFormat.h"
+#include "Magnum/GL/Renderer.h"
+#include "Magnum/GL/Texture.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector3.h"
+
+#include "Magnum/Shaders/Implementation/CreateCompatibilityShader.h"
+
+namespace Magnum { namespace Shaders {
+
+namespace {
+    enum: Int {
+        DepthTextureUnit = 0
+    };
+
+    enum: Int {
+        DestinationImageUnit = 0,
+        SourceImageUnit = 1
+    };
+
+    enum: Int {
+        FirstLevelUniform = 0
+    };
+
+    /* Keep in sync with GROUP_SIZE in DepthPyramid.comp */
+    constexpr Int GroupSize = 8;
+}
+
+Int DepthPyramidGL::levelCount(const Vector2i& size) {
+    CORRADE_ASSERT(size.product(),
+        "Shaders::DepthPyramidGL::levelCount(): expected a non-zero size but got" << Debug::packed << size, {});
+    return Math::log2(UnsignedInt(size.max())) + 1;
+}
+
+DepthPyramidGL::CompileState DepthPyramidGL::compile() {
+    #ifndef MAGNUM_TARGET_GLES
+    MAGNUM_ASSERT_GL_VERSION_SUPPORTED(GL::Version::GL430);
+    #else
+    MAGNUM_ASSERT_GL_VERSION_SUPPORTED(GL::Version::GLES310);
+    #endif
+
+    #ifdef MAGNUM_BUILD_STATIC
+    /* Import resources on static build, if not already */
+    if(!Utility::Resource::hasGroup("MagnumShadersGL"))
+        importShaderResources();
+    #endif
+    Utility::Resource rs("MagnumShadersGL");
+
+    #ifndef MAGNUM_TARGET_GLES
+    const GL::Version version = GL::Version::GL430;
+    #else
+    const GL::Version version = GL::Version::GLES310;
+    #endif
+
+    GL::Shader comp = Implementation::createCompatibilityShader(rs, version, GL::Shader::Type::Compute);
+    comp.addSource(rs.getString("DepthPyramid.comp"));
+
+    DepthPyramidGL out{NoInit};
+
+    /* If a matching program binary is cached, there's nothing to compile
+       or link */
+    const bool cached = out.loadCachedBinary({comp});
+    if(!cached) {
+        comp.submitCompile();
+        out.attachShader(comp);
+        out.submitLink();
+    }
+
+    return CompileState{std::move(out), std::move(comp), cached};
+}
+
+DepthPyramidGL::DepthPyramidGL(CompileState&& state): DepthPyramidGL{static_cast<DepthPyramidGL&&>(std::move(state))} {
+    #ifdef CORRADE_GRACEFUL_ASSERT
+    /* When graceful assertions fire from within compile(), we get a
+       NoCreate'd CompileState. Exiting makes it possible to test the
+       assert. */
+    if(!id()) return;
+    #endif
+
+    /* If the program was loaded from the binary cache, there's nothing to
+       check */
+    if(!state._cached) {
+        CORRADE_INTERNAL_ASSERT_OUTPUT(state._comp.checkCompile());
+        CORRADE_INTERNAL_ASSERT_OUTPUT(checkLink());
+        saveCachedBinary({state._comp});
+    }
+
+    /* All bindings and uniform locations are specified in the shader code
+       directly */
+}
+
+DepthPyramidGL::DepthPyramidGL(): DepthPyramidGL{compile()} {}
+
+DepthPyramidGL& DepthPyramidGL::build(GL::Texture2D& depth, GL::Texture2D& pyramid, const Vector2i& size) {
+    CORRADE_ASSERT(size.product(),
+        "Shaders::DepthPyramidGL::build(): expected a non-zero size but got" << Debug::packed << size, *this);
+
+    /* First level is a copy of the depth texture */
+    depth.bind(DepthTextureUnit);
+    pyramid.bindImage(DestinationImageUnit, 0, GL::ImageAccess::WriteOnly, GL::ImageFormat::R32F);
+    setUniform(FirstLevelUniform, 1);
+    dispatchCompute({Vector2ui{(size + Vector2i{GroupSize - 1})/GroupSize}, 1});
+
+    /* Each next level reduces the previous one until it's a single texel */
+    setUniform(FirstLevelUniform, 0);
+    Vector2i levelSize = size;
+    for(Int level = 1; levelSize != Vector2i{1}; ++level) {
+        levelSize = Math::max(levelSize/2, Vector2i{1});
+        GL::Renderer::setMemoryBarrier(GL::Renderer::MemoryBarrier::ShaderImageAccess);
+        pyramid.bindImage(SourceImageUnit, level - 1, GL::ImageAccess::ReadOnly, GL::ImageFormat::R32F);
+        pyramid.bindImage(DestinationImageUnit, level, GL::ImageAccess::WriteOnly, GL::ImageFormat::R32F);
+        dispatchCompute({Vector2ui{(levelSize + Vector2i{GroupSize - 1})/GroupSize}, 1});
+    }
+
+    return *this;
+}
+
+}}
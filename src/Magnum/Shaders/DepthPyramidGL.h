@@ -0,0 +1,205 @@
+#ifndef Magnum_Shaders_DepthPyramidGL_h
+#define Magnum_Shaders_DepthPyramidGL_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+/** @file
+ * @brief Class @ref Magnum::Shaders::DepthPyramidGL
+ * @m_since_latest
+ */
+#endif
+
+#include "Magnum/GL/AbstractShaderProgram.h"
+#include "Magnum/GL/Shader.h"
+#include "Magnum/Shaders/visibility.h"
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+namespace Magnum { namespace Shaders {
+
+/**
+@brief Hierarchical Z pyramid OpenGL compute shader
+@m_since_latest
+
+Builds a depth pyramid from a depth buffer for
+@ref InstanceCullingGL::Flag::HierarchicalZ. The first level of the pyramid is
+a copy of the depth buffer, each next level then contains the farthest depth
+of the corresponding two by two texels in the level above. Levels with an odd
+size include the extra row or column in their last texel, so the pyramid stays
+conservative for sizes that aren't a power of two.
+
+@section Shaders-DepthPyramidGL-usage Usage
+
+The pyramid is a @ref GL::TextureFormat::R32F texture of the same size as the
+depth buffer and with a full mip chain, whose size can be queried with
+@ref levelCount(). The depth buffer is expected to be a texture with a depth
+format attached to the framebuffer the scene is rendered to. At the end of
+each frame, or after a depth prepass, build the pyramid with @ref build() and
+use it to cull instances in the next frame:
+
+@snippet MagnumShaders-gl.cpp DepthPyramidGL-usage
+
+Since the pyramid is built from the previous frame, instances that just got
+disoccluded by camera movement are drawn one frame late. If that's a problem,
+the instances culled in the first pass can be tested again against a pyramid
+built from the current frame and drawn in a second pass.
+
+@section Shaders-DepthPyramidGL-fallback Fallback without compute shaders
+
+On platforms without compute shaders, occlusion of individual objects can be
+tested with a @ref GL::SampleQuery by drawing their bounding boxes with color
+and depth writes disabled. On desktop GL the draw of the actual object can be
+then wrapped in @ref GL::SampleQuery::beginConditionalRender() with
+@ref GL::SampleQuery::ConditionalRenderMode::NoWait, which avoids the
+round trip to the CPU. On OpenGL ES 3.0 and WebGL 2, which don't have
+conditional rendering, the boolean
+@ref GL::SampleQuery::Target::AnySamplesPassedConservative result can be
+checked in the next frame once @ref GL::AbstractQuery::resultAvailable() is
+@cpp true @ce. Compared to the pyramid this scales only to a few hundreds of
+objects, as each query is a separate draw.
+
+@requires_gl43 Extensions @gl_extension{ARB,compute_shader} and
+    @gl_extension{ARB,shader_image_load_store}
+@requires_gles31 Compute shaders and image load/store are not available in
+    OpenGL ES 3.0 and older.
+@requires_gles Compute shaders are not available in WebGL.
+*/
+class MAGNUM_SHADERS_EXPORT DepthPyramidGL: public GL::AbstractShaderProgram {
+    public:
+        class CompileState;
+
+        /**
+         * @brief Level count of a pyramid for given depth buffer size
+         *
+         * Returns count of levels needed to go from @p size down to a single
+         * texel, i.e. @cpp Math::log2(size.max()) + 1 @ce. Expects that the
+         * size is non-zero.
+         */
+        static Int levelCount(const Vector2i& size);
+
+        /**
+         * @brief Compile asynchronously
+         *
+         * Compared to @ref DepthPyramidGL() can perform an asynchronous
+         * compilation and linking. See @ref shaders-async for more
+         * information.
+         * @see @ref DepthPyramidGL(CompileState&&)
+         */
+        static CompileState compile();
+
+        /** @brief Constructor */
+        explicit DepthPyramidGL();
+
+        /**
+         * @brief Finalize an asynchronous compilation
+         *
+         * Takes an asynchronous compilation state returned by @ref compile()
+         * and forms a ready-to-use shader object. See @ref shaders-async for
+         * more information.
+         */
+        explicit DepthPyramidGL(CompileState&& state);
+
+        /**
+         * @brief Construct without creating the underlying OpenGL object
+         *
+         * The constructed instance is equivalent to a moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         *
+         * This function can be safely used for constructing (and later
+         * destructing) objects even without any OpenGL context being active.
+         * However note that this is a low-level and a potentially dangerous
+         * API, see the documentation of @ref NoCreate for alternatives.
+         */
+        explicit DepthPyramidGL(NoCreateT) noexcept: AbstractShaderProgram{NoCreate} {}
+
+        /** @brief Copying is not allowed */
+        DepthPyramidGL(const DepthPyramidGL&) = delete;
+
+        /** @brief Move constructor */
+        DepthPyramidGL(DepthPyramidGL&&) noexcept = default;
+
+        /** @brief Copying is not allowed */
+        DepthPyramidGL& operator=(const DepthPyramidGL&) = delete;
+
+        /** @brief Move assignment */
+        DepthPyramidGL& operator=(DepthPyramidGL&&) noexcept = default;
+
+        /**
+         * @brief Build the pyramid
+         * @param depth     Depth texture
+         * @param pyramid   Pyramid texture
+         * @param size      Size of the depth texture and the first pyramid
+         *      level
+         * @return Reference to self (for method chaining)
+         *
+         * The @p depth texture is expected to have a single level and a
+         * minification filter without mipmaps, as otherwise it's not
+         * complete and reads as zero. The @p pyramid is expected to have a
+         * @ref GL::TextureFormat::R32F format and at least @ref levelCount()
+         * levels, @p size is expected to be non-zero. Dispatches one pass for each level, with a
+         * @ref GL::Renderer::MemoryBarrier::ShaderImageAccess barrier in
+         * between. Issue a @ref GL::Renderer::MemoryBarrier::TextureFetch
+         * barrier before passing the pyramid to
+         * @ref InstanceCullingGL::bindHierarchicalZTexture().
+         */
+        DepthPyramidGL& build(GL::Texture2D& depth, GL::Texture2D& pyramid, const Vector2i& size);
+
+    private:
+        /* Creates the GL shader program object but does nothing else.
+           Internal, used by compile(). */
+        explicit DepthPyramidGL(NoInitT) {}
+
+        /* Prevent accidentally calling irrelevant functions */
+        using GL::AbstractShaderProgram::draw;
+        #ifndef MAGNUM_TARGET_GLES
+        using GL::AbstractShaderProgram::drawTransformFeedback;
+        #endif
+};
+
+/**
+@brief Asynchronous compilation state
+@m_since_latest
+
+Returned by @ref compile(). See @ref shaders-async for more information.
+*/
+class DepthPyramidGL::CompileState: public DepthPyramidGL {
+    /* Everything deliberately private except for the inheritance */
+    friend class DepthPyramidGL;
+
+    explicit CompileState(NoCreateT): DepthPyramidGL{NoCreate}, _comp{NoCreate} {}
+
+    explicit CompileState(DepthPyramidGL&& shader, GL::Shader&& comp, bool cached): DepthPyramidGL{std::move(shader)}, _comp{std::move(comp)}, _cached{cached} {}
+
+    GL::Shader _comp;
+    bool _cached;
+};
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 and WebGL build
+#endif
+
+#endif
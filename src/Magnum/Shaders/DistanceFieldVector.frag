@@ -129,6 +129,10 @@ uniform lowp sampler2D vectorTexture;
 
 in mediump vec2 interpolatedTextureCoordinates;
 
+#ifdef INSTANCED_GLYPHS
+in lowp vec4 interpolatedColor;
+#endif
+
 #ifdef MULTI_DRAW
 flat in highp uint drawId;
 #endif
@@ -155,10 +159,21 @@ void main() {
     lowp const vec2 outlineRange = materials[materialId].material_outlineRange;
     #endif
 
+    #ifndef MULTI_CHANNEL
     lowp float intensity = texture(vectorTexture, interpolatedTextureCoordinates).r;
+    #else
+    /* Median of the three channels, which reconstructs sharp corners that
+       a single channel would round off */
+    lowp const vec3 channels = texture(vectorTexture, interpolatedTextureCoordinates).rgb;
+    lowp float intensity = max(min(channels.r, channels.g), min(max(channels.r, channels.g), channels.b));
+    #endif
 
     /* Fill color */
-    fragmentColor = smoothstep(outlineRange.x-smoothness, outlineRange.x+smoothness, intensity)*color;
+    fragmentColor = smoothstep(outlineRange.x-smoothness, outlineRange.x+smoothness, intensity)*color
+        #ifdef INSTANCED_GLYPHS
+        *interpolatedColor
+        #endif
+        ;
 
     /* Outline */
     if(outlineRange.x > outlineRange.y) {
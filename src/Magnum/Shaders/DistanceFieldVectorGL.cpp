@@ -48,7 +48,12 @@
 namespace Magnum { namespace Shaders {
 
 namespace {
-    enum: Int { TextureUnit = 6 };
+    enum: Int {
+        TextureUnit = 6,
+        #ifndef MAGNUM_TARGET_GLES2
+        GlyphRectangleTextureUnit = 7
+        #endif
+    };
 
     #ifndef MAGNUM_TARGET_GLES2
     enum: Int {
@@ -63,22 +68,16 @@ namespace {
     #endif
 }
 
-template<UnsignedInt dimensions> DistanceFieldVectorGL<dimensions>::DistanceFieldVectorGL(const Flags flags
+template<UnsignedInt dimensions> typename DistanceFieldVectorGL<dimensions>::CompileState DistanceFieldVectorGL<dimensions>::compile(const Flags flags
     #ifndef MAGNUM_TARGET_GLES2
     , const UnsignedInt materialCount, const UnsignedInt drawCount
     #endif
-):
-    _flags{flags}
-    #ifndef MAGNUM_TARGET_GLES2
-    , _materialCount{materialCount},
-    _drawCount{drawCount}
-    #endif
-{
+) {
     #ifndef MAGNUM_TARGET_GLES2
     CORRADE_ASSERT(!(flags >= Flag::UniformBuffers) || materialCount,
-        "Shaders::DistanceFieldVectorGL: material count can't be zero", );
+        "Shaders::DistanceFieldVectorGL: material count can't be zero", CompileState{NoCreate});
     CORRADE_ASSERT(!(flags >= Flag::UniformBuffers) || drawCount,
-        "Shaders::DistanceFieldVectorGL: draw count can't be zero", );
+        "Shaders::DistanceFieldVectorGL: draw count can't be zero", CompileState{NoCreate});
     #endif
 
     #ifndef MAGNUM_TARGET_GLES
@@ -95,6 +94,12 @@ template<UnsignedInt dimensions> DistanceFieldVectorGL<dimensions>::DistanceFiel
         MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::WEBGL::multi_draw);
         #endif
     }
+    #ifndef MAGNUM_TARGET_GLES
+    if(flags & Flag::InstancedGlyphs) {
+        MAGNUM_ASSERT_GL_VERSION_SUPPORTED(GL::Version::GL300);
+        MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::ARB::instanced_arrays);
+    }
+    #endif
     #endif
 
     #ifdef MAGNUM_BUILD_STATIC
@@ -118,6 +123,7 @@ template<UnsignedInt dimensions> DistanceFieldVectorGL<dimensions>::DistanceFiel
     vert.addSource(flags & Flag::TextureTransformation ? "#define TEXTURE_TRANSFORMATION\n" : "")
         .addSource(dimensions == 2 ? "#define TWO_DIMENSIONS\n" : "#define THREE_DIMENSIONS\n");
     #ifndef MAGNUM_TARGET_GLES2
+    vert.addSource(flags & Flag::InstancedGlyphs ? "#define INSTANCED_GLYPHS\n" : "");
     if(flags >= Flag::UniformBuffers) {
         vert.addSource(Utility::formatString(
             "#define UNIFORM_BUFFERS\n"
@@ -138,26 +144,81 @@ template<UnsignedInt dimensions> DistanceFieldVectorGL<dimensions>::DistanceFiel
             drawCount));
         frag.addSource(flags >= Flag::MultiDraw ? "#define MULTI_DRAW\n" : "");
     }
+    frag.addSource(flags & Flag::InstancedGlyphs ? "#define INSTANCED_GLYPHS\n" : "");
     #endif
-    frag.addSource(rs.getString("generic.glsl"))
+    frag.addSource(flags & Flag::MultiChannel ? "#define MULTI_CHANNEL\n" : "")
+        .addSource(rs.getString("generic.glsl"))
         .addSource(rs.getString("DistanceFieldVector.frag"));
 
-    CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::compile({vert, frag}));
-
-    attachShaders({vert, frag});
+    DistanceFieldVectorGL<dimensions> out{NoInit};
+    out._flags = flags;
+    #ifndef MAGNUM_TARGET_GLES2
+    out._materialCount = materialCount;
+    out._drawCount = drawCount;
+    #endif
 
-    /* ES3 has this done in the shader directly */
-    #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
-    #ifndef MAGNUM_TARGET_GLES
-    if(!context.isExtensionSupported<GL::Extensions::ARB::explicit_attrib_location>(version))
+    /* If a matching program binary is cached, there's nothing to compile
+       or link */
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    const bool cached = out.loadCachedBinary({vert, frag});
+    #else
+    const bool cached = false;
     #endif
-    {
-        bindAttributeLocation(Position::Location, "position");
-        bindAttributeLocation(TextureCoordinates::Location, "textureCoordinates");
+    if(!cached) {
+        vert.submitCompile();
+        frag.submitCompile();
+
+        out.attachShaders({vert, frag});
+
+        /* ES3 has this done in the shader directly */
+        #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
+        #ifndef MAGNUM_TARGET_GLES
+        if(!context.isExtensionSupported<GL::Extensions::ARB::explicit_attrib_location>(version))
+        #endif
+        {
+            #ifndef MAGNUM_TARGET_GLES2
+            if(flags & Flag::InstancedGlyphs) {
+                out.bindAttributeLocation(GlyphOffsetScale::Location, "glyphOffsetScale");
+                out.bindAttributeLocation(GlyphId::Location, "glyphId");
+                out.bindAttributeLocation(GlyphColor::Location, "glyphColor");
+            } else
+            #endif
+            {
+                out.bindAttributeLocation(Position::Location, "position");
+                out.bindAttributeLocation(TextureCoordinates::Location, "textureCoordinates");
+            }
+        }
+        #endif
+
+        out.submitLink();
     }
+
+    return CompileState{std::move(out), std::move(vert), std::move(frag), version, cached};
+}
+
+template<UnsignedInt dimensions> DistanceFieldVectorGL<dimensions>::DistanceFieldVectorGL(CompileState&& state): DistanceFieldVectorGL{static_cast<DistanceFieldVectorGL&&>(std::move(state))} {
+    #ifdef CORRADE_GRACEFUL_ASSERT
+    /* When graceful assertions fire from within compile(), we get a
+       NoCreate'd CompileState. Exiting makes it possible to test the
+       assert. */
+    if(!id()) return;
     #endif
 
-    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+    /* If the program was loaded from the binary cache, there's nothing to
+       check */
+    if(!state._cached) {
+        CORRADE_INTERNAL_ASSERT_OUTPUT(state._vert.checkCompile() && state._frag.checkCompile());
+        CORRADE_INTERNAL_ASSERT_OUTPUT(checkLink());
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        saveCachedBinary({state._vert, state._frag});
+        #endif
+    }
+
+    #ifndef MAGNUM_TARGET_GLES
+    const GL::Context& context = GL::Context::current();
+    const GL::Version version = state._version;
+    #endif
+    const Flags flags = _flags;
 
     #ifndef MAGNUM_TARGET_GLES
     if(!context.isExtensionSupported<GL::Extensions::ARB::explicit_uniform_location>(version))
@@ -185,6 +246,8 @@ template<UnsignedInt dimensions> DistanceFieldVectorGL<dimensions>::DistanceFiel
     {
         setUniform(uniformLocation("vectorTexture"), TextureUnit);
         #ifndef MAGNUM_TARGET_GLES2
+        if(flags & Flag::InstancedGlyphs)
+            setUniform(uniformLocation("glyphRectangleTexture"), GlyphRectangleTextureUnit);
         if(flags >= Flag::UniformBuffers) {
             setUniformBlockBinding(uniformBlockIndex("TransformationProjection"), TransformationProjectionBufferBinding);
             setUniformBlockBinding(uniformBlockIndex("Draw"), DrawBufferBinding);
@@ -215,7 +278,15 @@ template<UnsignedInt dimensions> DistanceFieldVectorGL<dimensions>::DistanceFiel
 }
 
 #ifndef MAGNUM_TARGET_GLES2
-template<UnsignedInt dimensions> DistanceFieldVectorGL<dimensions>::DistanceFieldVectorGL(const Flags flags): DistanceFieldVectorGL{flags, 1, 1} {}
+template<UnsignedInt dimensions> typename DistanceFieldVectorGL<dimensions>::CompileState DistanceFieldVectorGL<dimensions>::compile(const Flags flags) {
+    return compile(flags, 1, 1);
+}
+#endif
+
+template<UnsignedInt dimensions> DistanceFieldVectorGL<dimensions>::DistanceFieldVectorGL(const Flags flags): DistanceFieldVectorGL{compile(flags)} {}
+
+#ifndef MAGNUM_TARGET_GLES2
+template<UnsignedInt dimensions> DistanceFieldVectorGL<dimensions>::DistanceFieldVectorGL(const Flags flags, const UnsignedInt materialCount, const UnsignedInt drawCount): DistanceFieldVectorGL{compile(flags, materialCount, drawCount)} {}
 #endif
 
 template<UnsignedInt dimensions> DistanceFieldVectorGL<dimensions>& DistanceFieldVectorGL<dimensions>::setTransformationProjectionMatrix(const MatrixTypeFor<dimensions, Float>& matrix) {
@@ -350,6 +421,15 @@ template<UnsignedInt dimensions> DistanceFieldVectorGL<dimensions>& DistanceFiel
     return *this;
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+template<UnsignedInt dimensions> DistanceFieldVectorGL<dimensions>& DistanceFieldVectorGL<dimensions>::bindGlyphRectangleTexture(GL::Texture2D& texture) {
+    CORRADE_ASSERT(_flags & Flag::InstancedGlyphs,
+        "Shaders::DistanceFieldVectorGL::bindGlyphRectangleTexture(): the shader was not created with instanced glyphs enabled", *this);
+    texture.bind(GlyphRectangleTextureUnit);
+    return *this;
+}
+#endif
+
 template class MAGNUM_SHADERS_EXPORT DistanceFieldVectorGL<2>;
 template class MAGNUM_SHADERS_EXPORT DistanceFieldVectorGL<3>;
 
@@ -366,6 +446,10 @@ Debug& operator<<(Debug& debug, const DistanceFieldVectorGLFlag value) {
         _c(UniformBuffers)
         _c(MultiDraw)
         #endif
+        _c(MultiChannel)
+        #ifndef MAGNUM_TARGET_GLES2
+        _c(InstancedGlyphs)
+        #endif
         #undef _c
         /* LCOV_EXCL_STOP */
     }
@@ -378,7 +462,11 @@ Debug& operator<<(Debug& debug, const DistanceFieldVectorGLFlags value) {
         DistanceFieldVectorGLFlag::TextureTransformation,
         #ifndef MAGNUM_TARGET_GLES2
         DistanceFieldVectorGLFlag::MultiDraw, /* Superset of UniformBuffers */
-        DistanceFieldVectorGLFlag::UniformBuffers
+        DistanceFieldVectorGLFlag::UniformBuffers,
+        #endif
+        DistanceFieldVectorGLFlag::MultiChannel,
+        #ifndef MAGNUM_TARGET_GLES2
+        DistanceFieldVectorGLFlag::InstancedGlyphs
         #endif
     });
 }
@@ -32,6 +32,7 @@
 
 #include "Magnum/DimensionTraits.h"
 #include "Magnum/GL/AbstractShaderProgram.h"
+#include "Magnum/GL/Shader.h"
 #include "Magnum/Shaders/GenericGL.h"
 #include "Magnum/Shaders/visibility.h"
 
@@ -42,7 +43,11 @@ namespace Implementation {
         TextureTransformation = 1 << 0,
         #ifndef MAGNUM_TARGET_GLES2
         UniformBuffers = 1 << 1,
-        MultiDraw = UniformBuffers|(1 << 2)
+        MultiDraw = UniformBuffers|(1 << 2),
+        #endif
+        MultiChannel = 1 << 3,
+        #ifndef MAGNUM_TARGET_GLES2
+        InstancedGlyphs = 1 << 4
         #endif
     };
     typedef Containers::EnumSet<DistanceFieldVectorGLFlag> DistanceFieldVectorGLFlags;
@@ -113,6 +118,22 @@ example.
 @requires_webgl_extension Extension @webgl_extension{ANGLE,multi_draw} for
     multidraw.
 
+@section Shaders-DistanceFieldVectorGL-instanced-glyphs Instanced glyph rendering
+
+Similarly to @ref Shaders-VectorGL-instanced-glyphs "VectorGL", with
+@ref Flag::InstancedGlyphs enabled the shader expands each instance described
+by @ref GlyphOffsetScale, @ref GlyphId and @ref GlyphColor to a glyph quad,
+taking the glyph rectangles from a texture bound with
+@ref bindGlyphRectangleTexture(). The glyph color is multiplied with
+@ref setColor(), the outline color is left unchanged.
+
+@requires_gl30 Extension @gl_extension{EXT,gpu_shader4} for instanced
+    glyphs.
+@requires_gl33 Extension @gl_extension{ARB,instanced_arrays} for instanced
+    glyphs.
+@requires_gles30 Instanced glyphs are not available in OpenGL ES 2.0.
+@requires_webgl20 Instanced glyphs are not available in WebGL 1.0.
+
 @see @ref shaders, @ref DistanceFieldVectorGL2D, @ref DistanceFieldVectorGL3D
 @todo Use fragment shader derivations to have proper smoothness in perspective/
     large zoom levels, make it optional as it might have negative performance
@@ -137,6 +158,49 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT DistanceFieldVector
          */
         typedef typename GenericGL<dimensions>::TextureCoordinates TextureCoordinates;
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Glyph offset and scale
+         * @m_since_latest
+         *
+         * @ref Magnum::Vector3 "Vector3", see @ref VectorGL::GlyphOffsetScale
+         * for more information. Per-instance, used only if
+         * @ref Flag::InstancedGlyphs is set.
+         * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+         * @requires_gles30 Instanced glyphs are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Instanced glyphs are not available in WebGL 1.0.
+         */
+        typedef GL::Attribute<GenericGL<dimensions>::TextureOffsetLayer::Location, Vector3> GlyphOffsetScale;
+
+        /**
+         * @brief Glyph ID
+         * @m_since_latest
+         *
+         * @ref Magnum::UnsignedInt "UnsignedInt", see
+         * @ref VectorGL::GlyphId for more information. Per-instance, used
+         * only if @ref Flag::InstancedGlyphs is set.
+         * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+         * @requires_gles30 Instanced glyphs are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Instanced glyphs are not available in WebGL 1.0.
+         */
+        typedef GL::Attribute<GenericGL<dimensions>::ObjectId::Location, UnsignedInt> GlyphId;
+
+        /**
+         * @brief Glyph color
+         * @m_since_latest
+         *
+         * @ref Magnum::Color4 "Color4", multiplied with @ref setColor().
+         * Per-instance, used only if @ref Flag::InstancedGlyphs is set.
+         * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+         * @requires_gles30 Instanced glyphs are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Instanced glyphs are not available in WebGL 1.0.
+         */
+        typedef typename GenericGL<dimensions>::Color4 GlyphColor;
+        #endif
+
         enum: UnsignedInt {
             /**
              * Color shader output. @ref shaders-generic "Generic output",
@@ -199,7 +263,38 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT DistanceFieldVector
              *      relies on uniform buffers, which require WebGL 2.0.
              * @m_since_latest
              */
-            MultiDraw = UniformBuffers|(1 << 2)
+            MultiDraw = UniformBuffers|(1 << 2),
+            #endif
+
+            /**
+             * Interpret the texture as a multi-channel signed distance field,
+             * taking a median of the red, green and blue channel instead of
+             * just the red channel. Such texture preserves sharp corners
+             * even at much lower resolutions and radii than a single-channel
+             * distance field. See @ref Text::MultiChannelDistanceFieldGlyphCache
+             * for more information.
+             * @m_since_latest
+             */
+            MultiChannel = 1 << 3,
+
+            #ifndef MAGNUM_TARGET_GLES2
+            /**
+             * Render instanced glyphs. Instead of @ref Position and
+             * @ref TextureCoordinates, expects a per-instance
+             * @ref GlyphOffsetScale, @ref GlyphId and @ref GlyphColor and
+             * glyph rectangles supplied via
+             * @ref bindGlyphRectangleTexture(). See
+             * @ref Shaders-DistanceFieldVectorGL-instanced-glyphs for more
+             * information.
+             * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+             * @requires_gl33 Extension @gl_extension{ARB,instanced_arrays}
+             * @requires_gles30 Instanced glyphs are not available in OpenGL
+             *      ES 2.0.
+             * @requires_webgl20 Instanced glyphs are not available in WebGL
+             *      1.0.
+             * @m_since_latest
+             */
+            InstancedGlyphs = 1 << 4
             #endif
         };
 
@@ -217,6 +312,36 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT DistanceFieldVector
         typedef Implementation::DistanceFieldVectorGLFlags Flags;
         #endif
 
+        class CompileState;
+
+        /**
+         * @brief Compile asynchronously
+         * @m_since_latest
+         *
+         * Compared to @ref DistanceFieldVectorGL(Flags) can perform an asynchronous
+         * compilation and linking. See @ref shaders-async for more
+         * information.
+         * @see @ref DistanceFieldVectorGL(CompileState&&),
+         *      @ref compile(Flags, UnsignedInt, UnsignedInt)
+         */
+        static CompileState compile(Flags flags = {});
+
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Compile for a multi-draw scenario asynchronously
+         * @m_since_latest
+         *
+         * Compared to @ref DistanceFieldVectorGL(Flags, UnsignedInt, UnsignedInt) can perform an
+         * asynchronous compilation and linking. See @ref shaders-async for
+         * more information.
+         * @see @ref DistanceFieldVectorGL(CompileState&&), @ref compile(Flags)
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        static CompileState compile(Flags flags, UnsignedInt materialCount, UnsignedInt drawCount);
+        #endif
+
         /**
          * @brief Constructor
          * @param flags     Flags
@@ -266,6 +391,16 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT DistanceFieldVector
         explicit DistanceFieldVectorGL(Flags flags, UnsignedInt materialCount, UnsignedInt drawCount);
         #endif
 
+        /**
+         * @brief Finalize an asynchronous compilation
+         * @m_since_latest
+         *
+         * Takes an asynchronous compilation state returned by @ref compile()
+         * and forms a ready-to-use shader object. See @ref shaders-async for
+         * more information.
+         */
+        explicit DistanceFieldVectorGL(CompileState&& state);
+
         /**
          * @brief Construct without creating the underlying OpenGL object
          *
@@ -564,6 +699,24 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT DistanceFieldVector
          */
         DistanceFieldVectorGL<dimensions>& bindVectorTexture(GL::Texture2D& texture);
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Bind a glyph rectangle texture
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that the shader was created with
+         * @ref Flag::InstancedGlyphs enabled. See
+         * @ref Shaders-VectorGL-instanced-glyphs for the expected layout.
+         * @see @ref Text::InstancedRenderer::glyphRectangleTexture()
+         * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+         * @requires_gles30 Instanced glyphs are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Instanced glyphs are not available in WebGL 1.0.
+         */
+        DistanceFieldVectorGL<dimensions>& bindGlyphRectangleTexture(GL::Texture2D& texture);
+        #endif
+
         /**
          * @}
          */
@@ -602,6 +755,10 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT DistanceFieldVector
         #endif
 
     private:
+        /* Creates the GL shader program object but does nothing else.
+           Internal, used by compile(). */
+        explicit DistanceFieldVectorGL(NoInitT) {}
+
         /* Prevent accidentally calling irrelevant functions */
         #ifndef MAGNUM_TARGET_GLES
         using GL::AbstractShaderProgram::drawTransformFeedback;
@@ -627,6 +784,25 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT DistanceFieldVector
         #endif
 };
 
+/**
+@brief Asynchronous compilation state
+@m_since_latest
+
+Returned by @ref compile(). See @ref shaders-async for more information.
+*/
+template<UnsignedInt dimensions> class DistanceFieldVectorGL<dimensions>::CompileState: public DistanceFieldVectorGL<dimensions> {
+    /* Everything deliberately private except for the inheritance */
+    friend class DistanceFieldVectorGL;
+
+    explicit CompileState(NoCreateT): DistanceFieldVectorGL<dimensions>{NoCreate}, _vert{NoCreate}, _frag{NoCreate} {}
+
+    explicit CompileState(DistanceFieldVectorGL<dimensions>&& shader, GL::Shader&& vert, GL::Shader&& frag, GL::Version version, bool cached): DistanceFieldVectorGL<dimensions>{std::move(shader)}, _vert{std::move(vert)}, _frag{std::move(frag)}, _version{version}, _cached{cached} {}
+
+    GL::Shader _vert, _frag;
+    GL::Version _version;
+    bool _cached;
+};
+
 /**
 @brief Two-dimensional distance field vector OpenGL shader
 @m_since_latest
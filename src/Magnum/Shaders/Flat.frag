@@ -27,6 +27,10 @@
 #extension GL_EXT_gpu_shader4: require
 #endif
 
+#ifdef BINDLESS_TEXTURES
+#extension GL_ARB_bindless_texture: require
+#endif
+
 #ifndef NEW_GLSL
 #define fragmentColor gl_FragColor
 #define texture texture2D
@@ -88,9 +92,9 @@ uniform highp uint drawOffset
 #endif
 
 struct DrawUniform {
-    highp uvec4 materialIdReservedObjectIdReservedReserved;
-    #define draw_materialIdReserved materialIdReservedObjectIdReservedReserved.x
-    #define draw_objectId materialIdReservedObjectIdReservedReserved.y
+    highp uvec4 materialIdJointOffsetObjectIdReservedReserved;
+    #define draw_materialIdJointOffset materialIdJointOffsetObjectIdReservedReserved.x
+    #define draw_objectId materialIdJointOffsetObjectIdReservedReserved.y
 };
 
 layout(std140
@@ -114,10 +118,39 @@ layout(std140
 ) uniform Material {
     MaterialUniform materials[MATERIAL_COUNT];
 };
+
+#ifdef BINDLESS_TEXTURES
+/* Indexed with the same material ID as the Material block above, the handles
+   are 64-bit, stored as low and high 32-bit halves */
+struct MaterialTextureUniform {
+    highp uvec4 textureObjectIdTextureHandles;
+    #define materialTexture_textureHandle textureObjectIdTextureHandles.xy
+    #define materialTexture_objectIdTextureHandle textureObjectIdTextureHandles.zw
+};
+
+layout(std140
+    #ifdef EXPLICIT_BINDING
+    , binding = 6
+    #endif
+) uniform MaterialTexture {
+    MaterialTextureUniform materialTextures[MATERIAL_COUNT];
+};
+#endif
 #endif
 
 /* Textures */
 
+#ifdef BINDLESS_TEXTURES
+/* Samplers get constructed from the handles in the MaterialTexture block, the
+   materialId is defined at the start of main() */
+#ifndef TEXTURE_ARRAYS
+#define textureData sampler2D(materialTextures[materialId].materialTexture_textureHandle)
+#define objectIdTextureData usampler2D(materialTextures[materialId].materialTexture_objectIdTextureHandle)
+#else
+#define textureData sampler2DArray(materialTextures[materialId].materialTexture_textureHandle)
+#define objectIdTextureData usampler2DArray(materialTextures[materialId].materialTexture_objectIdTextureHandle)
+#endif
+#else
 #ifdef TEXTURED
 #ifdef EXPLICIT_BINDING
 layout(binding = 0)
@@ -143,6 +176,7 @@ uniform lowp
     #endif
     objectIdTextureData;
 #endif
+#endif
 
 /* Inputs */
 
@@ -170,7 +204,21 @@ flat in highp uint interpolatedInstanceObjectId;
 #ifdef EXPLICIT_ATTRIB_LOCATION
 layout(location = COLOR_OUTPUT_ATTRIBUTE_LOCATION)
 #endif
-out lowp vec4 fragmentColor;
+/* The weighted color for order-independent transparency goes way over the
+   lowp range */
+out
+    #ifndef ORDER_INDEPENDENT_TRANSPARENCY
+    lowp
+    #else
+    highp
+    #endif
+    vec4 fragmentColor;
+#endif
+#ifdef ORDER_INDEPENDENT_TRANSPARENCY
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = REVEALAGE_OUTPUT_ATTRIBUTE_LOCATION)
+#endif
+out lowp float fragmentRevealage;
 #endif
 #ifdef OBJECT_ID
 #ifdef EXPLICIT_ATTRIB_LOCATION
@@ -190,7 +238,7 @@ void main() {
     highp const uint objectId = draws[drawId].draw_objectId;
     #endif
     #if MATERIAL_COUNT > 1
-    mediump const uint materialId = draws[drawId].draw_materialIdReserved & 0xffffu;
+    mediump const uint materialId = draws[drawId].draw_materialIdJointOffset & 0xffffu;
     #else
     #define materialId 0u
     #endif
@@ -226,4 +274,13 @@ void main() {
         #endif
         objectId;
     #endif
+
+    #ifdef ORDER_INDEPENDENT_TRANSPARENCY
+    /* Weighted blended order-independent transparency, weight function from
+       equation (10) in http://jcgt.org/published/0002/02/09/ */
+    lowp const float alpha = fragmentColor.a;
+    highp const float weight = clamp(pow(min(1.0, alpha*10.0) + 0.01, 3.0)*1.0e8*pow(1.0 - gl_FragCoord.z*0.9, 3.0), 1.0e-2, 3.0e3);
+    fragmentColor = vec4(fragmentColor.rgb*alpha, alpha)*weight;
+    fragmentRevealage = alpha;
+    #endif
 }
@@ -26,7 +26,7 @@
 */
 
 /** @file
- * @brief Struct @ref Magnum::Shaders::FlatDrawUniform, @ref Magnum::Shaders::FlatMaterialUniform
+ * @brief Struct @ref Magnum::Shaders::FlatDrawUniform, @ref Magnum::Shaders::FlatMaterialUniform, @ref Magnum::Shaders::FlatMaterialTextureUniform
  */
 
 #include "Magnum/Magnum.h"
@@ -55,12 +55,12 @@ be shared among multiple draw calls and thus are provided in a separate
 struct FlatDrawUniform {
     /** @brief Construct with default parameters */
     constexpr explicit FlatDrawUniform(DefaultInitT = DefaultInit) noexcept:
-        #if ((defined(CORRADE_TARGET_CLANG) && __clang_major__ < 4) || (defined(CORRADE_TARGET_APPLE_CLANG) && __clang_major__ < 8)) && defined(CORRADE_TARGET_BIG_ENDIAN)
-        _pad0{}, /* Otherwise it refuses to constexpr, on 3.8 at least */
+        #ifdef CORRADE_TARGET_BIG_ENDIAN
+        jointOffset{0},
         #endif
         materialId{0},
-        #if (defined(CORRADE_TARGET_CLANG) && __clang_major__ < 4) || (defined(CORRADE_TARGET_APPLE_CLANG) && __clang_major__ < 8) && !defined(CORRADE_TARGET_BIG_ENDIAN)
-        _pad0{},
+        #ifndef CORRADE_TARGET_BIG_ENDIAN
+        jointOffset{0},
         #endif
         objectId{0}
         #if (defined(CORRADE_TARGET_CLANG) && __clang_major__ < 4) || (defined(CORRADE_TARGET_APPLE_CLANG) && __clang_major__ < 8)
@@ -98,6 +98,16 @@ struct FlatDrawUniform {
         return *this;
     }
 
+    /**
+     * @brief Set the @ref jointOffset field
+     * @return Reference to self (for method chaining)
+     * @m_since_latest
+     */
+    FlatDrawUniform& setJointOffset(UnsignedInt offset) {
+        jointOffset = offset;
+        return *this;
+    }
+
     /**
      * @}
      */
@@ -114,25 +124,29 @@ struct FlatDrawUniform {
      * first material gets used.
      */
 
+    /** @var jointOffset
+     * @brief Joint offset
+     * @m_since_latest
+     *
+     * Offset added to joint IDs in the @ref FlatGL::JointIds and
+     * @ref FlatGL::SecondaryJointIds attributes. Useful when a UBO with joint
+     * matrices for more than one skin is supplied or in a multi-draw
+     * scenario. Should be less than the joint count passed to
+     * @ref FlatGL::Configuration::setJointCount(). Default value is
+     * @cpp 0 @ce, meaning no offset is added to joint IDs.
+     *
+     * Used only if the shader was created with a non-zero joint count,
+     * ignored otherwise.
+     */
+
     /* This field is an UnsignedInt in the shader and materialId is extracted
-       as (value & 0xffff), so the order has to be different on BE */
+       as (value & 0xffff) and jointOffset as (value >> 16), so the order has
+       to be different on BE */
     #ifndef CORRADE_TARGET_BIG_ENDIAN
     UnsignedShort materialId;
-    /* warning: Member __pad0__ is not documented. FFS DOXYGEN WHY DO YOU THINK
-       I MADE THOSE UNNAMED, YOU DUMB FOOL */
-    #ifndef DOXYGEN_GENERATING_OUTPUT
-    UnsignedShort
-        #if (defined(CORRADE_TARGET_CLANG) && __clang_major__ < 4) || (defined(CORRADE_TARGET_APPLE_CLANG) && __clang_major__ < 8)
-        _pad0 /* Otherwise it refuses to constexpr, on 3.8 at least */
-        #endif
-        :16; /* reserved for skinOffset */
-    #endif
+    UnsignedShort jointOffset;
     #else
-    UnsignedShort
-        #if (defined(CORRADE_TARGET_CLANG) && __clang_major__ < 4) || (defined(CORRADE_TARGET_APPLE_CLANG) && __clang_major__ < 8)
-        _pad0 /* Otherwise it refuses to constexpr, on 3.8 at least */
-        #endif
-        :16; /* reserved for skinOffset */
+    UnsignedShort jointOffset;
     UnsignedShort materialId;
     #endif
 
@@ -261,6 +275,77 @@ struct FlatMaterialUniform {
     #endif
 };
 
+/**
+@brief Material texture uniform for flat shaders
+@m_since_latest
+
+Bindless texture handles of a material referenced from
+@ref FlatDrawUniform::materialId, used if
+@ref FlatGL::Flag::BindlessTextures is enabled. The handles are stored as two
+32-bit halves to keep the structure compatible with the std140 layout of an
+@glsl uvec2 @ce, use the setters to fill them from a 64-bit value.
+@see @ref FlatGL::bindMaterialTextureBuffer(),
+    @ref GL::Texture::handle() "GL::Texture*::handle()"
+*/
+struct FlatMaterialTextureUniform {
+    /** @brief Construct with default parameters */
+    constexpr explicit FlatMaterialTextureUniform(DefaultInitT = DefaultInit) noexcept: textureHandle{}, objectIdTextureHandle{} {}
+
+    /** @brief Construct without initializing the contents */
+    explicit FlatMaterialTextureUniform(NoInitT) noexcept: textureHandle{NoInit}, objectIdTextureHandle{NoInit} {}
+
+    /** @{
+     * @name Convenience setters
+     *
+     * Provided to allow the use of method chaining for populating a structure
+     * in a single expression, otherwise equivalent to accessing the fields
+     * directly. Also guaranteed to provide backwards compatibility when
+     * packing of the actual fields changes.
+     */
+
+    /**
+     * @brief Set the @ref textureHandle field
+     * @return Reference to self (for method chaining)
+     */
+    FlatMaterialTextureUniform& setTextureHandle(UnsignedLong handle) {
+        textureHandle = {UnsignedInt(handle), UnsignedInt(handle >> 32)};
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref objectIdTextureHandle field
+     * @return Reference to self (for method chaining)
+     */
+    FlatMaterialTextureUniform& setObjectIdTextureHandle(UnsignedLong handle) {
+        objectIdTextureHandle = {UnsignedInt(handle), UnsignedInt(handle >> 32)};
+        return *this;
+    }
+
+    /**
+     * @}
+     */
+
+    /**
+     * @brief Color texture handle
+     *
+     * Low and high 32 bits of a resident texture handle. Default value is
+     * @cpp {0, 0} @ce. Used only if @ref FlatGL::Flag::Textured is enabled,
+     * ignored otherwise. If @ref FlatGL::Flag::TextureArrays is enabled, the
+     * handle is expected to be of a @ref GL::Texture2DArray, otherwise of a
+     * @ref GL::Texture2D.
+     */
+    Vector2ui textureHandle;
+
+    /**
+     * @brief Object ID texture handle
+     *
+     * Low and high 32 bits of a resident texture handle. Default value is
+     * @cpp {0, 0} @ce. Used only if @ref FlatGL::Flag::ObjectIdTexture is
+     * enabled, ignored otherwise.
+     */
+    Vector2ui objectIdTextureHandle;
+};
+
 #ifdef MAGNUM_BUILD_DEPRECATED
 /** @brief @copybrief FlatGL
  * @m_deprecated_since_latest Use @ref FlatGL instead.
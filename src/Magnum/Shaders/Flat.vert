@@ -23,7 +23,7 @@
     DEALINGS IN THE SOFTWARE.
 */
 
-#if defined(INSTANCED_OBJECT_ID) && !defined(GL_ES) && !defined(NEW_GLSL)
+#if (defined(INSTANCED_OBJECT_ID) || defined(JOINT_COUNT)) && !defined(GL_ES) && !defined(NEW_GLSL)
 #extension GL_EXT_gpu_shader4: require
 #endif
 
@@ -89,6 +89,21 @@ layout(location = 2)
 uniform highp uint textureLayer; /* defaults to zero */
 #endif
 
+#ifdef JOINT_COUNT
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = JOINT_MATRICES_LOCATION)
+#endif
+/* Defaults set from the constructor, a mat3[] / mat4[] initializer for an
+   arbitrary count would be needlessly long */
+#ifdef TWO_DIMENSIONS
+uniform highp mat3 jointMatrices[JOINT_COUNT];
+#elif defined(THREE_DIMENSIONS)
+uniform highp mat4 jointMatrices[JOINT_COUNT];
+#else
+#error
+#endif
+#endif
+
 /* Uniform buffers */
 
 #else
@@ -139,10 +154,95 @@ layout(std140
     TextureTransformationUniform textureTransformations[DRAW_COUNT];
 };
 #endif
+
+#ifdef JOINT_COUNT
+/* Keep in sync with Flat.frag. Needed here only for the joint offset. */
+struct DrawUniform {
+    highp uvec4 materialIdJointOffsetObjectIdReservedReserved;
+    #define draw_materialIdJointOffset materialIdJointOffsetObjectIdReservedReserved.x
+};
+
+layout(std140
+    #ifdef EXPLICIT_BINDING
+    , binding = 2
+    #endif
+) uniform Draw {
+    DrawUniform draws[DRAW_COUNT];
+};
+
+layout(std140
+    #ifdef EXPLICIT_BINDING
+    , binding = 8
+    #endif
+) uniform Joint {
+    highp
+        #ifdef TWO_DIMENSIONS
+        /* Can't be a mat3 because of ANGLE, see DrawUniform in Phong.vert for
+           details */
+        mat3x4
+        #elif defined(THREE_DIMENSIONS)
+        mat4
+        #else
+        #error
+        #endif
+    jointMatrices[JOINT_COUNT];
+};
+#endif
+
+#ifdef VERTEX_PULLING
+/* Keep in sync with Phong.vert. Offsets are in vertices, not bytes. */
+struct VertexPullingUniform {
+    highp uvec4 positionNormalTextureCoordinatesColorOffset;
+    #define vertexPulling_positionOffset positionNormalTextureCoordinatesColorOffset.x
+    #define vertexPulling_textureCoordinatesOffset positionNormalTextureCoordinatesColorOffset.z
+    #define vertexPulling_colorOffset positionNormalTextureCoordinatesColorOffset.w
+};
+
+layout(std140
+    #ifdef EXPLICIT_BINDING
+    , binding = 10
+    #endif
+) uniform VertexPulling {
+    VertexPullingUniform vertexPullings[DRAW_COUNT];
+};
+
+/* Tightly packed floats, as a vec3 / vec2 array would be padded to sixteen
+   bytes even with std430. Storage buffers need GL 4.3 / ES 3.1 so explicit
+   bindings are always available. */
+layout(std430, binding = 0) readonly buffer PositionStorage {
+    highp float positionStorage[];
+};
+
+#ifdef TEXTURED
+layout(std430, binding = 1) readonly buffer TextureCoordinatesStorage {
+    mediump float textureCoordinatesStorage[];
+};
+#endif
+
+#ifdef VERTEX_COLOR
+layout(std430, binding = 2) readonly buffer ColorStorage {
+    lowp float colorStorage[];
+};
+#endif
+#endif
+#endif
+
+#ifdef DYNAMIC_PER_VERTEX_JOINT_COUNT
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = PER_VERTEX_JOINT_COUNT_LOCATION)
+#endif
+uniform mediump uvec2 perVertexJointCount
+    #ifndef GL_ES
+    = uvec2(PER_VERTEX_JOINT_COUNT, SECONDARY_PER_VERTEX_JOINT_COUNT)
+    #endif
+    ;
 #endif
 
 /* Inputs */
 
+/* With vertex pulling, position, texture coordinates and vertex color are
+   fetched from storage buffers at the beginning of main() instead */
+#ifndef VERTEX_PULLING
 #ifdef EXPLICIT_ATTRIB_LOCATION
 layout(location = POSITION_ATTRIBUTE_LOCATION)
 #endif
@@ -160,8 +260,35 @@ layout(location = TEXTURECOORDINATES_ATTRIBUTE_LOCATION)
 #endif
 in mediump vec2 textureCoordinates;
 #endif
+#endif
+
+#ifdef JOINT_COUNT
+#if PER_VERTEX_JOINT_COUNT
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = WEIGHTS_ATTRIBUTE_LOCATION)
+#endif
+in mediump vec4 weights;
+
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = JOINTIDS_ATTRIBUTE_LOCATION)
+#endif
+in mediump uvec4 jointIds;
+#endif
+
+#if SECONDARY_PER_VERTEX_JOINT_COUNT
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = SECONDARY_WEIGHTS_ATTRIBUTE_LOCATION)
+#endif
+in mediump vec4 secondaryWeights;
 
-#ifdef VERTEX_COLOR
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = SECONDARY_JOINTIDS_ATTRIBUTE_LOCATION)
+#endif
+in mediump uvec4 secondaryJointIds;
+#endif
+#endif
+
+#if defined(VERTEX_COLOR) && !defined(VERTEX_PULLING)
 #ifdef EXPLICIT_ATTRIB_LOCATION
 layout(location = COLOR_ATTRIBUTE_LOCATION)
 #endif
@@ -252,6 +379,82 @@ void main() {
     highp const uint textureLayer = floatBitsToUint(textureTransformations[drawId].textureTransformation_layer);
     #endif
     #endif
+
+    #ifdef VERTEX_PULLING
+    /* gl_VertexID already includes the base vertex for indexed draws, the
+       per-draw offsets allow multiple meshes to share the same buffers */
+    highp const uint positionIndex = vertexPullings[drawId].vertexPulling_positionOffset + uint(gl_VertexID);
+    #ifdef TWO_DIMENSIONS
+    highp const vec2 position = vec2(
+        positionStorage[positionIndex*2u],
+        positionStorage[positionIndex*2u + 1u]);
+    #elif defined(THREE_DIMENSIONS)
+    highp const vec4 position = vec4(
+        positionStorage[positionIndex*3u],
+        positionStorage[positionIndex*3u + 1u],
+        positionStorage[positionIndex*3u + 2u], 1.0);
+    #else
+    #error
+    #endif
+    #ifdef TEXTURED
+    highp const uint textureCoordinatesIndex = vertexPullings[drawId].vertexPulling_textureCoordinatesOffset + uint(gl_VertexID);
+    mediump const vec2 textureCoordinates = vec2(
+        textureCoordinatesStorage[textureCoordinatesIndex*2u],
+        textureCoordinatesStorage[textureCoordinatesIndex*2u + 1u]);
+    #endif
+    #ifdef VERTEX_COLOR
+    highp const uint colorIndex = vertexPullings[drawId].vertexPulling_colorOffset + uint(gl_VertexID);
+    lowp const vec4 vertexColor = vec4(
+        colorStorage[colorIndex*4u],
+        colorStorage[colorIndex*4u + 1u],
+        colorStorage[colorIndex*4u + 2u],
+        colorStorage[colorIndex*4u + 3u]);
+    #endif
+    #endif
+    #endif
+
+    #ifdef JOINT_COUNT
+    /* Skin matrix, a weighted sum of joint matrices affecting the vertex */
+    #ifdef UNIFORM_BUFFERS
+    highp const uint jointOffset = draws[drawId].draw_materialIdJointOffset >> 16u;
+    #else
+    #define jointOffset 0u
+    #endif
+    #ifdef TWO_DIMENSIONS
+    highp mat3 skinMatrix = mat3(0.0);
+    #elif defined(THREE_DIMENSIONS)
+    highp mat4 skinMatrix = mat4(0.0);
+    #else
+    #error
+    #endif
+    #if PER_VERTEX_JOINT_COUNT
+    for(int i = 0; i != PER_VERTEX_JOINT_COUNT; ++i) {
+        #ifdef DYNAMIC_PER_VERTEX_JOINT_COUNT
+        if(uint(i) >= perVertexJointCount.x) break;
+        #endif
+        skinMatrix += weights[i]*
+            #if defined(TWO_DIMENSIONS) && defined(UNIFORM_BUFFERS)
+            mat3(jointMatrices[jointOffset + jointIds[i]])
+            #else
+            jointMatrices[jointOffset + jointIds[i]]
+            #endif
+            ;
+    }
+    #endif
+    #if SECONDARY_PER_VERTEX_JOINT_COUNT
+    for(int i = 0; i != SECONDARY_PER_VERTEX_JOINT_COUNT; ++i) {
+        #ifdef DYNAMIC_PER_VERTEX_JOINT_COUNT
+        if(uint(i) >= perVertexJointCount.y) break;
+        #endif
+        skinMatrix += secondaryWeights[i]*
+            #if defined(TWO_DIMENSIONS) && defined(UNIFORM_BUFFERS)
+            mat3(jointMatrices[jointOffset + secondaryJointIds[i]])
+            #else
+            jointMatrices[jointOffset + secondaryJointIds[i]]
+            #endif
+            ;
+    }
+    #endif
     #endif
 
     #ifdef TWO_DIMENSIONS
@@ -259,12 +462,18 @@ void main() {
         #ifdef INSTANCED_TRANSFORMATION
         instancedTransformationMatrix*
         #endif
+        #ifdef JOINT_COUNT
+        skinMatrix*
+        #endif
         vec3(position, 1.0), 0.0);
     #elif defined(THREE_DIMENSIONS)
     gl_Position = transformationProjectionMatrix*
         #ifdef INSTANCED_TRANSFORMATION
         instancedTransformationMatrix*
         #endif
+        #ifdef JOINT_COUNT
+        skinMatrix*
+        #endif
         position;
     #else
     #error
@@ -25,6 +25,9 @@
 
 #include "FlatGL.h"
 
+#ifndef MAGNUM_TARGET_GLES2
+#include <Corrade/Containers/Array.h>
+#endif
 #include <Corrade/Containers/EnumSet.hpp>
 #include <Corrade/Containers/Reference.h>
 #include <Corrade/Utility/Resource.h>
@@ -63,21 +66,38 @@ namespace {
         TransformationProjectionBufferBinding = 1,
         DrawBufferBinding = 2,
         TextureTransformationBufferBinding = 3,
-        MaterialBufferBinding = 4
+        MaterialBufferBinding = 4,
+        #ifndef MAGNUM_TARGET_GLES
+        MaterialTextureBufferBinding = 6, /* shared with Phong */
+        #endif
+        JointBufferBinding = 8, /* shared with Phong */
+        #ifndef MAGNUM_TARGET_WEBGL
+        VertexPullingBufferBinding = 10 /* shared with Phong */
+        #endif
     };
     #endif
-}
 
-template<UnsignedInt dimensions> FlatGL<dimensions>::FlatGL(const Flags flags
-    #ifndef MAGNUM_TARGET_GLES2
-    , const UnsignedInt materialCount, const UnsignedInt drawCount
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    /* Shader storage buffer bindings used with Flag::VertexPulling, shared
+       with Phong */
+    enum: Int {
+        PositionStorageBufferBinding = 0,
+        TextureCoordinatesStorageBufferBinding = 1,
+        ColorStorageBufferBinding = 2
+    };
     #endif
-):
-    _flags{flags}
+}
+
+template<UnsignedInt dimensions> typename FlatGL<dimensions>::CompileState FlatGL<dimensions>::compile(const Configuration& configuration) {
+    const Flags flags = configuration.flags();
     #ifndef MAGNUM_TARGET_GLES2
-    , _materialCount{materialCount}, _drawCount{drawCount}
+    const UnsignedInt materialCount = configuration.materialCount();
+    const UnsignedInt drawCount = configuration.drawCount();
+    const UnsignedInt jointCount = configuration.jointCount();
+    const UnsignedInt perVertexJointCount = configuration.perVertexJointCount();
+    const UnsignedInt secondaryPerVertexJointCount = configuration.secondaryPerVertexJointCount();
     #endif
-{
+
     #ifndef CORRADE_NO_ASSERT
     {
         const bool textureTransformationNotEnabledOrTextured = !(flags & Flag::TextureTransformation) || flags & Flag::Textured
@@ -86,22 +106,34 @@ template<UnsignedInt dimensions> FlatGL<dimensions>::FlatGL(const Flags flags
             #endif
             ;
         CORRADE_ASSERT(textureTransformationNotEnabledOrTextured,
-            "Shaders::FlatGL: texture transformation enabled but the shader is not textured", );
+            "Shaders::FlatGL: texture transformation enabled but the shader is not textured", CompileState{NoCreate});
     }
     #endif
 
     #ifndef MAGNUM_TARGET_GLES2
     CORRADE_ASSERT(!(flags >= Flag::UniformBuffers) || materialCount,
-        "Shaders::FlatGL: material count can't be zero", );
+        "Shaders::FlatGL: material count can't be zero", CompileState{NoCreate});
     CORRADE_ASSERT(!(flags >= Flag::UniformBuffers) || drawCount,
-        "Shaders::FlatGL: draw count can't be zero", );
+        "Shaders::FlatGL: draw count can't be zero", CompileState{NoCreate});
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(flags & Flag::DynamicPerVertexJointCount) || jointCount,
+        "Shaders::FlatGL: dynamic per-vertex joint count enabled for zero joints", CompileState{NoCreate});
+    CORRADE_ASSERT(!secondaryPerVertexJointCount || !(flags & Flag::InstancedTransformation),
+        "Shaders::FlatGL: secondary per-vertex joint attributes conflict with the instanced TransformationMatrix attribute", CompileState{NoCreate});
     #endif
 
     #ifndef MAGNUM_TARGET_GLES2
     CORRADE_ASSERT(!(flags & Flag::TextureArrays) || flags & Flag::Textured || flags >= Flag::ObjectIdTexture,
-        "Shaders::FlatGL: texture arrays enabled but the shader is not textured", );
+        "Shaders::FlatGL: texture arrays enabled but the shader is not textured", CompileState{NoCreate});
     CORRADE_ASSERT(!(flags & Flag::UniformBuffers) || !(flags & Flag::TextureArrays) || flags >= (Flag::TextureArrays|Flag::TextureTransformation),
-        "Shaders::FlatGL: texture arrays require texture transformation enabled as well if uniform buffers are used", );
+        "Shaders::FlatGL: texture arrays require texture transformation enabled as well if uniform buffers are used", CompileState{NoCreate});
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_ASSERT(!(flags & Flag::BindlessTextures) || flags >= Flag::UniformBuffers,
+        "Shaders::FlatGL: bindless textures require uniform buffers to be enabled", CompileState{NoCreate});
     #endif
 
     #ifndef MAGNUM_TARGET_GLES
@@ -122,6 +154,17 @@ template<UnsignedInt dimensions> FlatGL<dimensions>::FlatGL(const Flags flags
     #ifndef MAGNUM_TARGET_GLES
     if(flags >= Flag::TextureArrays)
         MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::EXT::texture_array);
+    if(flags >= Flag::BindlessTextures)
+        MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::ARB::bindless_texture);
+    #endif
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if(flags >= Flag::VertexPulling) {
+        #ifndef MAGNUM_TARGET_GLES
+        MAGNUM_ASSERT_GL_VERSION_SUPPORTED(GL::Version::GL430);
+        #else
+        MAGNUM_ASSERT_GL_VERSION_SUPPORTED(GL::Version::GLES310);
+        #endif
+    }
     #endif
 
     #ifdef MAGNUM_BUILD_STATIC
@@ -133,12 +176,33 @@ template<UnsignedInt dimensions> FlatGL<dimensions>::FlatGL(const Flags flags
 
     const GL::Context& context = GL::Context::current();
 
+    /* Shader storage buffers used by vertex pulling need GLSL 4.30 / ES 3.10 */
     #ifndef MAGNUM_TARGET_GLES
-    const GL::Version version = context.supportedVersion({GL::Version::GL320, GL::Version::GL310, GL::Version::GL300, GL::Version::GL210});
+    const GL::Version version = flags >= Flag::VertexPulling ? GL::Version::GL430 :
+        context.supportedVersion({GL::Version::GL320, GL::Version::GL310, GL::Version::GL300, GL::Version::GL210});
+    #elif !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    const GL::Version version = flags >= Flag::VertexPulling ? GL::Version::GLES310 :
+        context.supportedVersion({GL::Version::GLES300, GL::Version::GLES200});
     #else
     const GL::Version version = context.supportedVersion({GL::Version::GLES300, GL::Version::GLES200});
     #endif
 
+    FlatGL<dimensions> out{NoInit};
+    out._flags = flags;
+    #ifndef MAGNUM_TARGET_GLES2
+    out._materialCount = materialCount;
+    out._drawCount = drawCount;
+    out._jointCount = jointCount;
+    out._perVertexJointCount = perVertexJointCount;
+    out._secondaryPerVertexJointCount = secondaryPerVertexJointCount;
+    /* With uniform buffers all other uniforms are aliased, so the per-vertex
+       joint count is put right after the draw offset */
+    if(flags >= Flag::UniformBuffers) {
+        out._jointMatricesUniform = -1;
+        out._perVertexJointCountUniform = 1;
+    } else out._perVertexJointCountUniform = out._jointMatricesUniform + Int(jointCount);
+    #endif
+
     GL::Shader vert = Implementation::createCompatibilityShader(rs, version, GL::Shader::Type::Vertex);
     GL::Shader frag = Implementation::createCompatibilityShader(rs, version, GL::Shader::Type::Fragment);
 
@@ -159,12 +223,32 @@ template<UnsignedInt dimensions> FlatGL<dimensions>::FlatGL(const Flags flags
         .addSource(flags & Flag::InstancedTransformation ? "#define INSTANCED_TRANSFORMATION\n" : "")
         .addSource(flags >= Flag::InstancedTextureOffset ? "#define INSTANCED_TEXTURE_OFFSET\n" : "");
     #ifndef MAGNUM_TARGET_GLES2
+    if(jointCount) {
+        vert.addSource(Utility::formatString(
+            "#define JOINT_COUNT {}\n"
+            "#define PER_VERTEX_JOINT_COUNT {}\n"
+            "#define SECONDARY_PER_VERTEX_JOINT_COUNT {}\n"
+            "#define JOINT_MATRICES_LOCATION {}\n",
+            jointCount,
+            perVertexJointCount,
+            secondaryPerVertexJointCount,
+            out._jointMatricesUniform));
+    }
+    if(flags >= Flag::DynamicPerVertexJointCount) {
+        vert.addSource(Utility::formatString(
+            "#define DYNAMIC_PER_VERTEX_JOINT_COUNT\n"
+            "#define PER_VERTEX_JOINT_COUNT_LOCATION {}\n",
+            out._perVertexJointCountUniform));
+    }
     if(flags >= Flag::UniformBuffers) {
         vert.addSource(Utility::formatString(
             "#define UNIFORM_BUFFERS\n"
             "#define DRAW_COUNT {}\n",
             drawCount));
         vert.addSource(flags >= Flag::MultiDraw ? "#define MULTI_DRAW\n" : "");
+        #ifndef MAGNUM_TARGET_WEBGL
+        vert.addSource(flags >= Flag::VertexPulling ? "#define VERTEX_PULLING\n" : "");
+        #endif
     }
     #endif
     vert.addSource(rs.getString("generic.glsl"))
@@ -179,6 +263,7 @@ template<UnsignedInt dimensions> FlatGL<dimensions>::FlatGL(const Flags flags
         .addSource(flags & Flag::ObjectId ? "#define OBJECT_ID\n" : "")
         .addSource(flags >= Flag::InstancedObjectId ? "#define INSTANCED_OBJECT_ID\n" : "")
         .addSource(flags >= Flag::ObjectIdTexture ? "#define OBJECT_ID_TEXTURE\n" : "")
+        .addSource(flags & Flag::OrderIndependentTransparency ? "#define ORDER_INDEPENDENT_TRANSPARENCY\n" : "")
         #endif
         ;
     #ifndef MAGNUM_TARGET_GLES2
@@ -190,53 +275,109 @@ template<UnsignedInt dimensions> FlatGL<dimensions>::FlatGL(const Flags flags
             drawCount,
             materialCount));
         frag.addSource(flags >= Flag::MultiDraw ? "#define MULTI_DRAW\n" : "");
+        #ifndef MAGNUM_TARGET_GLES
+        frag.addSource(flags >= Flag::BindlessTextures ? "#define BINDLESS_TEXTURES\n" : "");
+        #endif
     }
     #endif
     frag.addSource(rs.getString("generic.glsl"))
         .addSource(rs.getString("Flat.frag"));
 
-    CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::compile({vert, frag}));
+    /* If a matching program binary is cached, there's nothing to compile
+       or link */
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    const bool cached = out.loadCachedBinary({vert, frag});
+    #else
+    const bool cached = false;
+    #endif
+    if(!cached) {
+        vert.submitCompile();
+        frag.submitCompile();
 
-    attachShaders({vert, frag});
+        out.attachShaders({vert, frag});
 
-    /* ES3 has this done in the shader directly and doesn't even provide
-       bindFragmentDataLocation() */
-    #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
-    #ifndef MAGNUM_TARGET_GLES
-    if(!context.isExtensionSupported<GL::Extensions::ARB::explicit_attrib_location>(version))
-    #endif
-    {
-        bindAttributeLocation(Position::Location, "position");
-        if(flags & Flag::Textured
+        /* ES3 has this done in the shader directly and doesn't even provide
+           bindFragmentDataLocation() */
+        #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
+        #ifndef MAGNUM_TARGET_GLES
+        if(!context.isExtensionSupported<GL::Extensions::ARB::explicit_attrib_location>(version))
+        #endif
+        {
+            out.bindAttributeLocation(Position::Location, "position");
+            if(flags & Flag::Textured
+                #ifndef MAGNUM_TARGET_GLES2
+                || flags >= Flag::ObjectIdTexture
+                #endif
+            )
+                out.bindAttributeLocation(TextureCoordinates::Location, "textureCoordinates");
+            if(flags & Flag::VertexColor)
+                out.bindAttributeLocation(Color3::Location, "vertexColor"); /* Color4 is the same */
             #ifndef MAGNUM_TARGET_GLES2
-            || flags >= Flag::ObjectIdTexture
+            if(flags & Flag::ObjectId) {
+                out.bindFragmentDataLocation(ColorOutput, "color");
+                out.bindFragmentDataLocation(ObjectIdOutput, "objectId");
+            }
+            if(flags & Flag::OrderIndependentTransparency) {
+                out.bindFragmentDataLocation(ColorOutput, "fragmentColor");
+                out.bindFragmentDataLocation(RevealageOutput, "fragmentRevealage");
+            }
+            if(flags >= Flag::InstancedObjectId)
+                out.bindAttributeLocation(ObjectId::Location, "instanceObjectId");
+            #endif
+            if(flags & Flag::InstancedTransformation)
+                out.bindAttributeLocation(TransformationMatrix::Location, "instancedTransformationMatrix");
+            if(flags >= Flag::InstancedTextureOffset)
+                out.bindAttributeLocation(TextureOffset::Location, "instancedTextureOffset");
+            #ifndef MAGNUM_TARGET_GLES2
+            if(perVertexJointCount) {
+                out.bindAttributeLocation(Weights::Location, "weights");
+                out.bindAttributeLocation(JointIds::Location, "jointIds");
+            }
+            if(secondaryPerVertexJointCount) {
+                out.bindAttributeLocation(SecondaryWeights::Location, "secondaryWeights");
+                out.bindAttributeLocation(SecondaryJointIds::Location, "secondaryJointIds");
+            }
             #endif
-        )
-            bindAttributeLocation(TextureCoordinates::Location, "textureCoordinates");
-        if(flags & Flag::VertexColor)
-            bindAttributeLocation(Color3::Location, "vertexColor"); /* Color4 is the same */
-        #ifndef MAGNUM_TARGET_GLES2
-        if(flags & Flag::ObjectId) {
-            bindFragmentDataLocation(ColorOutput, "color");
-            bindFragmentDataLocation(ObjectIdOutput, "objectId");
         }
-        if(flags >= Flag::InstancedObjectId)
-            bindAttributeLocation(ObjectId::Location, "instanceObjectId");
         #endif
-        if(flags & Flag::InstancedTransformation)
-            bindAttributeLocation(TransformationMatrix::Location, "instancedTransformationMatrix");
-        if(flags >= Flag::InstancedTextureOffset)
-            bindAttributeLocation(TextureOffset::Location, "instancedTextureOffset");
+
+        out.submitLink();
     }
+
+    return CompileState{std::move(out), std::move(vert), std::move(frag), version, cached};
+}
+
+template<UnsignedInt dimensions> FlatGL<dimensions>::FlatGL(CompileState&& state): FlatGL{static_cast<FlatGL&&>(std::move(state))} {
+    #ifdef CORRADE_GRACEFUL_ASSERT
+    /* When graceful assertions fire from within compile(), we get a
+       NoCreate'd CompileState. Exiting makes it possible to test the
+       assert. */
+    if(!id()) return;
     #endif
 
-    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+    /* If the program was loaded from the binary cache, there's nothing to
+       check */
+    if(!state._cached) {
+        CORRADE_INTERNAL_ASSERT_OUTPUT(state._vert.checkCompile() && state._frag.checkCompile());
+        CORRADE_INTERNAL_ASSERT_OUTPUT(checkLink());
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        saveCachedBinary({state._vert, state._frag});
+        #endif
+    }
+
+    #ifndef MAGNUM_TARGET_GLES
+    const GL::Context& context = GL::Context::current();
+    const GL::Version version = state._version;
+    #endif
+    const Flags flags = _flags;
 
     #ifndef MAGNUM_TARGET_GLES
     if(!context.isExtensionSupported<GL::Extensions::ARB::explicit_uniform_location>(version))
     #endif
     {
         #ifndef MAGNUM_TARGET_GLES2
+        if(flags >= Flag::DynamicPerVertexJointCount)
+            _perVertexJointCountUniform = uniformLocation("perVertexJointCount");
         if(flags >= Flag::UniformBuffers) {
             if(_drawCount > 1) _drawOffsetUniform = uniformLocation("drawOffset");
         } else
@@ -253,6 +394,7 @@ template<UnsignedInt dimensions> FlatGL<dimensions>::FlatGL(const Flags flags
             if(flags & Flag::AlphaMask) _alphaMaskUniform = uniformLocation("alphaMask");
             #ifndef MAGNUM_TARGET_GLES2
             if(flags & Flag::ObjectId) _objectIdUniform = uniformLocation("objectId");
+            if(_jointCount) _jointMatricesUniform = uniformLocation("jointMatrices");
             #endif
         }
     }
@@ -261,22 +403,50 @@ template<UnsignedInt dimensions> FlatGL<dimensions>::FlatGL(const Flags flags
     if(!context.isExtensionSupported<GL::Extensions::ARB::shading_language_420pack>(version))
     #endif
     {
-        if(flags & Flag::Textured) setUniform(uniformLocation("textureData"), TextureUnit);
+        /* With bindless textures the samplers come from a uniform buffer and
+           there are no sampler uniforms to set */
+        #ifndef MAGNUM_TARGET_GLES
+        if(!(flags >= Flag::BindlessTextures))
+        #endif
+        {
+            if(flags & Flag::Textured) setUniform(uniformLocation("textureData"), TextureUnit);
+            #ifndef MAGNUM_TARGET_GLES2
+            if(flags >= Flag::ObjectIdTexture) setUniform(uniformLocation("objectIdTextureData"), ObjectIdTextureUnit);
+            #endif
+        }
         #ifndef MAGNUM_TARGET_GLES2
-        if(flags >= Flag::ObjectIdTexture) setUniform(uniformLocation("objectIdTextureData"), ObjectIdTextureUnit);
         if(flags >= Flag::UniformBuffers) {
             setUniformBlockBinding(uniformBlockIndex("TransformationProjection"), TransformationProjectionBufferBinding);
             setUniformBlockBinding(uniformBlockIndex("Draw"), DrawBufferBinding);
             if(flags & Flag::TextureTransformation)
                 setUniformBlockBinding(uniformBlockIndex("TextureTransformation"), TextureTransformationBufferBinding);
             setUniformBlockBinding(uniformBlockIndex("Material"), MaterialBufferBinding);
+            #ifndef MAGNUM_TARGET_GLES
+            if(flags >= Flag::BindlessTextures)
+                setUniformBlockBinding(uniformBlockIndex("MaterialTexture"), MaterialTextureBufferBinding);
+            #endif
+            if(_jointCount)
+                setUniformBlockBinding(uniformBlockIndex("Joint"), JointBufferBinding);
+            #ifndef MAGNUM_TARGET_WEBGL
+            if(flags >= Flag::VertexPulling)
+                setUniformBlockBinding(uniformBlockIndex("VertexPulling"), VertexPullingBufferBinding);
+            #endif
         }
         #endif
     }
 
+    /* Joint matrices don't have a shader-side initializer on any platform,
+       as it'd be needlessly long for large joint counts */
+    #ifndef MAGNUM_TARGET_GLES2
+    if(_jointCount && !(flags >= Flag::UniformBuffers))
+        setJointMatrices(Containers::Array<MatrixTypeFor<dimensions, Float>>{DirectInit, _jointCount, Math::IdentityInit});
+    #endif
+
     /* Set defaults in OpenGL ES (for desktop they are set in shader code itself) */
     #ifdef MAGNUM_TARGET_GLES
     #ifndef MAGNUM_TARGET_GLES2
+    if(flags >= Flag::DynamicPerVertexJointCount)
+        setPerVertexJointCount(_perVertexJointCount, _secondaryPerVertexJointCount);
     if(flags >= Flag::UniformBuffers) {
         /* Draw offset is zero by default */
     } else
@@ -293,8 +463,39 @@ template<UnsignedInt dimensions> FlatGL<dimensions>::FlatGL(const Flags flags
     #endif
 }
 
+template<UnsignedInt dimensions> typename FlatGL<dimensions>::CompileState FlatGL<dimensions>::compile(const Flags flags) {
+    return compile(Configuration{}
+        .setFlags(flags));
+}
+
 #ifndef MAGNUM_TARGET_GLES2
-template<UnsignedInt dimensions> FlatGL<dimensions>::FlatGL(const Flags flags): FlatGL{flags, 1, 1} {}
+template<UnsignedInt dimensions> typename FlatGL<dimensions>::CompileState FlatGL<dimensions>::compile(const Flags flags, const UnsignedInt materialCount, const UnsignedInt drawCount) {
+    return compile(Configuration{}
+        .setFlags(flags)
+        .setMaterialCount(materialCount)
+        .setDrawCount(drawCount));
+}
+#endif
+
+template<UnsignedInt dimensions> FlatGL<dimensions>::FlatGL(const Flags flags): FlatGL{compile(flags)} {}
+
+#ifndef MAGNUM_TARGET_GLES2
+template<UnsignedInt dimensions> FlatGL<dimensions>::FlatGL(const Flags flags, const UnsignedInt materialCount, const UnsignedInt drawCount): FlatGL{compile(flags, materialCount, drawCount)} {}
+#endif
+
+template<UnsignedInt dimensions> FlatGL<dimensions>::FlatGL(const Configuration& configuration): FlatGL{compile(configuration)} {}
+
+#ifndef MAGNUM_TARGET_GLES2
+template<UnsignedInt dimensions> FlatGL<dimensions>& FlatGL<dimensions>::setPerVertexJointCount(const UnsignedInt count, const UnsignedInt secondaryCount) {
+    CORRADE_ASSERT(_flags >= Flag::DynamicPerVertexJointCount,
+        "Shaders::FlatGL::setPerVertexJointCount(): the shader was not created with dynamic per-vertex joint count enabled", *this);
+    CORRADE_ASSERT(count <= _perVertexJointCount,
+        "Shaders::FlatGL::setPerVertexJointCount(): expected at most" << _perVertexJointCount << "per-vertex joints, got" << count, *this);
+    CORRADE_ASSERT(secondaryCount <= _secondaryPerVertexJointCount,
+        "Shaders::FlatGL::setPerVertexJointCount(): expected at most" << _secondaryPerVertexJointCount << "secondary per-vertex joints, got" << secondaryCount, *this);
+    setUniform(_perVertexJointCountUniform, Vector2ui{count, secondaryCount});
+    return *this;
+}
 #endif
 
 template<UnsignedInt dimensions> FlatGL<dimensions>& FlatGL<dimensions>::setTransformationProjectionMatrix(const MatrixTypeFor<dimensions, Float>& matrix) {
@@ -357,6 +558,28 @@ template<UnsignedInt dimensions> FlatGL<dimensions>& FlatGL<dimensions>::setObje
     setUniform(_objectIdUniform, id);
     return *this;
 }
+
+template<UnsignedInt dimensions> FlatGL<dimensions>& FlatGL<dimensions>::setJointMatrices(const Containers::ArrayView<const MatrixTypeFor<dimensions, Float>> matrices) {
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::FlatGL::setJointMatrices(): the shader was created with uniform buffers enabled", *this);
+    CORRADE_ASSERT(matrices.size() <= _jointCount,
+        "Shaders::FlatGL::setJointMatrices(): expected at most" << _jointCount << "items but got" << matrices.size(), *this);
+    if(matrices.size()) setUniform(_jointMatricesUniform, matrices);
+    return *this;
+}
+
+template<UnsignedInt dimensions> FlatGL<dimensions>& FlatGL<dimensions>::setJointMatrices(const std::initializer_list<MatrixTypeFor<dimensions, Float>> matrices) {
+    return setJointMatrices(Containers::arrayView(matrices));
+}
+
+template<UnsignedInt dimensions> FlatGL<dimensions>& FlatGL<dimensions>::setJointMatrix(const UnsignedInt id, const MatrixTypeFor<dimensions, Float>& matrix) {
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::FlatGL::setJointMatrix(): the shader was created with uniform buffers enabled", *this);
+    CORRADE_ASSERT(id < _jointCount,
+        "Shaders::FlatGL::setJointMatrix(): joint ID" << id << "is out of bounds for" << _jointCount << "joints", *this);
+    setUniform(_jointMatricesUniform + id, matrix);
+    return *this;
+}
 #endif
 
 #ifndef MAGNUM_TARGET_GLES2
@@ -428,6 +651,102 @@ template<UnsignedInt dimensions> FlatGL<dimensions>& FlatGL<dimensions>::bindMat
     buffer.bind(GL::Buffer::Target::Uniform, MaterialBufferBinding, offset, size);
     return *this;
 }
+
+template<UnsignedInt dimensions> FlatGL<dimensions>& FlatGL<dimensions>::bindJointBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::FlatGL::bindJointBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, JointBufferBinding);
+    return *this;
+}
+
+template<UnsignedInt dimensions> FlatGL<dimensions>& FlatGL<dimensions>::bindJointBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::FlatGL::bindJointBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, JointBufferBinding, offset, size);
+    return *this;
+}
+
+#ifndef MAGNUM_TARGET_GLES
+template<UnsignedInt dimensions> FlatGL<dimensions>& FlatGL<dimensions>::bindMaterialTextureBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags >= Flag::BindlessTextures,
+        "Shaders::FlatGL::bindMaterialTextureBuffer(): the shader was not created with bindless textures enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, MaterialTextureBufferBinding);
+    return *this;
+}
+
+template<UnsignedInt dimensions> FlatGL<dimensions>& FlatGL<dimensions>::bindMaterialTextureBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags >= Flag::BindlessTextures,
+        "Shaders::FlatGL::bindMaterialTextureBuffer(): the shader was not created with bindless textures enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, MaterialTextureBufferBinding, offset, size);
+    return *this;
+}
+#endif
+
+#ifndef MAGNUM_TARGET_WEBGL
+template<UnsignedInt dimensions> FlatGL<dimensions>& FlatGL<dimensions>::bindVertexPullingBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags >= Flag::VertexPulling,
+        "Shaders::FlatGL::bindVertexPullingBuffer(): the shader was not created with vertex pulling enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, VertexPullingBufferBinding);
+    return *this;
+}
+
+template<UnsignedInt dimensions> FlatGL<dimensions>& FlatGL<dimensions>::bindVertexPullingBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags >= Flag::VertexPulling,
+        "Shaders::FlatGL::bindVertexPullingBuffer(): the shader was not created with vertex pulling enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, VertexPullingBufferBinding, offset, size);
+    return *this;
+}
+
+template<UnsignedInt dimensions> FlatGL<dimensions>& FlatGL<dimensions>::bindPositionStorageBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags >= Flag::VertexPulling,
+        "Shaders::FlatGL::bindPositionStorageBuffer(): the shader was not created with vertex pulling enabled", *this);
+    buffer.bind(GL::Buffer::Target::ShaderStorage, PositionStorageBufferBinding);
+    return *this;
+}
+
+template<UnsignedInt dimensions> FlatGL<dimensions>& FlatGL<dimensions>::bindPositionStorageBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags >= Flag::VertexPulling,
+        "Shaders::FlatGL::bindPositionStorageBuffer(): the shader was not created with vertex pulling enabled", *this);
+    buffer.bind(GL::Buffer::Target::ShaderStorage, PositionStorageBufferBinding, offset, size);
+    return *this;
+}
+
+template<UnsignedInt dimensions> FlatGL<dimensions>& FlatGL<dimensions>::bindTextureCoordinatesStorageBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags >= Flag::VertexPulling,
+        "Shaders::FlatGL::bindTextureCoordinatesStorageBuffer(): the shader was not created with vertex pulling enabled", *this);
+    CORRADE_ASSERT(_flags & Flag::Textured || _flags >= Flag::ObjectIdTexture,
+        "Shaders::FlatGL::bindTextureCoordinatesStorageBuffer(): the shader was not created with texturing enabled", *this);
+    buffer.bind(GL::Buffer::Target::ShaderStorage, TextureCoordinatesStorageBufferBinding);
+    return *this;
+}
+
+template<UnsignedInt dimensions> FlatGL<dimensions>& FlatGL<dimensions>::bindTextureCoordinatesStorageBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags >= Flag::VertexPulling,
+        "Shaders::FlatGL::bindTextureCoordinatesStorageBuffer(): the shader was not created with vertex pulling enabled", *this);
+    CORRADE_ASSERT(_flags & Flag::Textured || _flags >= Flag::ObjectIdTexture,
+        "Shaders::FlatGL::bindTextureCoordinatesStorageBuffer(): the shader was not created with texturing enabled", *this);
+    buffer.bind(GL::Buffer::Target::ShaderStorage, TextureCoordinatesStorageBufferBinding, offset, size);
+    return *this;
+}
+
+template<UnsignedInt dimensions> FlatGL<dimensions>& FlatGL<dimensions>::bindColorStorageBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags >= Flag::VertexPulling,
+        "Shaders::FlatGL::bindColorStorageBuffer(): the shader was not created with vertex pulling enabled", *this);
+    CORRADE_ASSERT(_flags & Flag::VertexColor,
+        "Shaders::FlatGL::bindColorStorageBuffer(): the shader was not created with vertex colors enabled", *this);
+    buffer.bind(GL::Buffer::Target::ShaderStorage, ColorStorageBufferBinding);
+    return *this;
+}
+
+template<UnsignedInt dimensions> FlatGL<dimensions>& FlatGL<dimensions>::bindColorStorageBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags >= Flag::VertexPulling,
+        "Shaders::FlatGL::bindColorStorageBuffer(): the shader was not created with vertex pulling enabled", *this);
+    CORRADE_ASSERT(_flags & Flag::VertexColor,
+        "Shaders::FlatGL::bindColorStorageBuffer(): the shader was not created with vertex colors enabled", *this);
+    buffer.bind(GL::Buffer::Target::ShaderStorage, ColorStorageBufferBinding, offset, size);
+    return *this;
+}
+#endif
 #endif
 
 template<UnsignedInt dimensions> FlatGL<dimensions>& FlatGL<dimensions>::bindTexture(GL::Texture2D& texture) {
@@ -474,6 +793,23 @@ template<UnsignedInt dimensions> FlatGL<dimensions>& FlatGL<dimensions>::bindObj
 }
 #endif
 
+#ifndef MAGNUM_TARGET_GLES2
+template<UnsignedInt dimensions> typename FlatGL<dimensions>::Configuration& FlatGL<dimensions>::Configuration::setJointCount(const UnsignedInt count, const UnsignedInt perVertexCount, const UnsignedInt secondaryPerVertexCount) {
+    CORRADE_ASSERT(perVertexCount <= 4,
+        "Shaders::FlatGL::Configuration::setJointCount(): expected at most 4 per-vertex joints, got" << perVertexCount, *this);
+    CORRADE_ASSERT(secondaryPerVertexCount <= 4,
+        "Shaders::FlatGL::Configuration::setJointCount(): expected at most 4 secondary per-vertex joints, got" << secondaryPerVertexCount, *this);
+    CORRADE_ASSERT(count || !(perVertexCount || secondaryPerVertexCount),
+        "Shaders::FlatGL::Configuration::setJointCount(): count can't be zero if per-vertex joint count is non-zero", *this);
+    CORRADE_ASSERT(!count || perVertexCount || secondaryPerVertexCount,
+        "Shaders::FlatGL::Configuration::setJointCount(): per-vertex joint count can't be zero if count is non-zero", *this);
+    _jointCount = count;
+    _perVertexJointCount = perVertexCount;
+    _secondaryPerVertexJointCount = secondaryPerVertexCount;
+    return *this;
+}
+#endif
+
 template class MAGNUM_SHADERS_EXPORT FlatGL<2>;
 template class MAGNUM_SHADERS_EXPORT FlatGL<3>;
 
@@ -508,6 +844,14 @@ Debug& operator<<(Debug& debug, const FlatGLFlag value) {
         _c(UniformBuffers)
         _c(MultiDraw)
         _c(TextureArrays)
+        #ifndef MAGNUM_TARGET_GLES
+        _c(BindlessTextures)
+        #endif
+        _c(DynamicPerVertexJointCount)
+        _c(OrderIndependentTransparency)
+        #ifndef MAGNUM_TARGET_WEBGL
+        _c(VertexPulling)
+        #endif
         #endif
         #undef _c
         /* LCOV_EXCL_STOP */
@@ -535,8 +879,16 @@ Debug& operator<<(Debug& debug, const FlatGLFlags value) {
         FlatGLFlag::InstancedTransformation,
         #ifndef MAGNUM_TARGET_GLES2
         FlatGLFlag::MultiDraw, /* Superset of UniformBuffers */
+        #ifndef MAGNUM_TARGET_WEBGL
+        FlatGLFlag::VertexPulling, /* Superset of UniformBuffers */
+        #endif
         FlatGLFlag::UniformBuffers,
-        FlatGLFlag::TextureArrays
+        FlatGLFlag::TextureArrays,
+        #ifndef MAGNUM_TARGET_GLES
+        FlatGLFlag::BindlessTextures,
+        #endif
+        FlatGLFlag::DynamicPerVertexJointCount,
+        FlatGLFlag::OrderIndependentTransparency
         #endif
     });
 }
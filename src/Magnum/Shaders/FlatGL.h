@@ -32,6 +32,7 @@
 
 #include "Magnum/DimensionTraits.h"
 #include "Magnum/GL/AbstractShaderProgram.h"
+#include "Magnum/GL/Shader.h"
 #include "Magnum/Shaders/GenericGL.h"
 #include "Magnum/Shaders/visibility.h"
 
@@ -53,7 +54,15 @@ namespace Implementation {
         #ifndef MAGNUM_TARGET_GLES2
         UniformBuffers = 1 << 8,
         MultiDraw = UniformBuffers|(1 << 9),
-        TextureArrays = 1 << 10
+        TextureArrays = 1 << 10,
+        #ifndef MAGNUM_TARGET_GLES
+        BindlessTextures = 1 << 12,
+        #endif
+        DynamicPerVertexJointCount = 1 << 13,
+        OrderIndependentTransparency = 1 << 14,
+        #ifndef MAGNUM_TARGET_WEBGL
+        VertexPulling = UniformBuffers|(1 << 15)
+        #endif
         #endif
     };
     typedef Containers::EnumSet<FlatGLFlag> FlatGLFlags;
@@ -116,6 +125,24 @@ blending enabled. Note that this feature is implemented using the GLSL
 impact on some platforms. With proper depth sorting and blending you'll usually
 get much better performance and output quality.
 
+@section Shaders-FlatGL-oit Order-independent transparency
+
+Blending transparent objects as described above requires them to be sorted
+back to front, which gets expensive with many objects and isn't possible to
+do correctly for intersecting geometry. Enabling
+@ref Flag::OrderIndependentTransparency makes the shader output values for
+weighted blended order-independent transparency instead, which can be drawn in
+any order. The @ref ColorOutput is meant to be accumulated in a floating-point
+attachment and the @ref RevealageOutput in a single-component attachment,
+which are then composited over the opaque geometry with
+@ref TransparencyResolveGL. See its documentation for a complete example.
+
+The result is an approximation that weights the overlapping surfaces based on
+their depth and opacity, so it's best suited for many layers of similarly
+transparent surfaces such as particles or x-ray views. Opaque surfaces drawn
+this way get blended with whatever else is at the same pixel, draw them
+regularly before the transparent ones.
+
 @section Shaders-FlatGL-object-id Object ID output
 
 The shader supports writing object ID to the framebuffer for object picking or
@@ -162,6 +189,34 @@ color to a mesh:
 @requires_webgl20 Extension @webgl_extension{ANGLE,instanced_arrays} in WebGL
     1.0.
 
+@section Shaders-FlatGL-skinning Skinning
+
+To render skinned meshes, set the count of joint matrices and the count of
+joints affecting each vertex with @ref Configuration::setJointCount() and pass
+the configuration to @ref FlatGL(const Configuration&). The mesh is then
+expected to contain the @ref JointIds and @ref Weights attributes, with up to
+four more joints per vertex supplied in the @ref SecondaryJointIds and
+@ref SecondaryWeights attributes. Joint matrices are supplied with
+@ref setJointMatrices() and are applied before the instanced and the
+per-draw transformation:
+
+@snippet MagnumShaders-gl.cpp FlatGL-usage-skinning
+
+With @ref Flag::UniformBuffers, joint matrices are supplied in a
+@ref TransformationUniform2D / @ref TransformationUniform3D buffer bound with
+@ref bindJointBuffer() instead, each draw picking its range via
+@ref FlatDrawUniform::jointOffset. Similarly to @ref PhongGL,
+@ref Flag::DynamicPerVertexJointCount allows using a single shader for meshes
+with different count of per-vertex joints. Secondary per-vertex joints can't
+be used together with @ref Flag::InstancedTransformation, as the attributes
+share locations.
+
+@requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+@requires_gles30 Skinning requires integer support in shaders, which is not
+    available in OpenGL ES 2.0.
+@requires_webgl20 Skinning requires integer support in shaders, which is not
+    available in WebGL 1.0.
+
 @section Shaders-FlatGL-ubo Uniform buffers
 
 See @ref shaders-usage-ubo for a high-level overview that applies to all
@@ -197,6 +252,46 @@ all shaders, see @ref shaders-usage-multidraw for an example.
 @requires_webgl_extension Extension @webgl_extension{ANGLE,multi_draw} for
     multidraw.
 
+@section Shaders-FlatGL-bindless Bindless textures
+
+With @ref Flag::BindlessTextures, the shader doesn't sample textures bound to
+fixed texture units but instead takes
+@ref GL::Texture::handle() "bindless texture handles" from a
+@ref FlatMaterialTextureUniform buffer bound with
+@ref bindMaterialTextureBuffer(). The buffer is indexed with
+@ref FlatDrawUniform::materialId the same way as the @ref FlatMaterialUniform
+buffer, so each material can reference different textures. The handles are
+expected to be made resident before drawing:
+
+@snippet MagnumShaders-gl.cpp FlatGL-bindless
+
+@requires_extension Extension @gl_extension{ARB,bindless_texture} for
+    bindless textures.
+@requires_gl Bindless textures are not available in OpenGL ES or WebGL.
+
+@section Shaders-FlatGL-vertex-pulling Vertex pulling
+
+With @ref Flag::VertexPulling, the shader doesn't take positions, texture
+coordinates and vertex colors from vertex attributes but fetches them from
+tightly packed shader storage buffers bound with
+@ref bindPositionStorageBuffer(), @ref bindTextureCoordinatesStorageBuffer()
+and @ref bindColorStorageBuffer(), indexed with @glsl gl_VertexID @ce. Offset
+of the first vertex for each draw is taken from a @ref VertexPullingUniform
+buffer bound with @ref bindVertexPullingBuffer(), which makes it possible to
+put many meshes into a single set of buffers and draw them together with
+@ref Flag::MultiDraw without any vertex format or buffer rebinding in between.
+The mesh itself only needs the index buffer and vertex count, other attributes
+such as instanced transformation or skinning joints are still taken from
+regular vertex attributes:
+
+@snippet MagnumShaders-gl.cpp FlatGL-vertex-pulling
+
+@requires_gl43 Extension @gl_extension{ARB,shader_storage_buffer_object} for
+    vertex pulling.
+@requires_gles31 Shader storage buffers are not available in OpenGL ES 3.0
+    and older.
+@requires_gles Shader storage buffers are not available in WebGL.
+
 @see @ref shaders, @ref FlatGL2D, @ref FlatGL3D
 */
 template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT FlatGL: public GL::AbstractShaderProgram {
@@ -240,6 +335,66 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT FlatGL: public GL::
         typedef typename GenericGL<dimensions>::Color4 Color4;
 
         #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Joint ids
+         * @m_since_latest
+         *
+         * @ref shaders-generic "Generic attribute",
+         * @ref Magnum::Vector4ui "Vector4ui". Used only if
+         * @ref perVertexJointCount() isn't @cpp 0 @ce.
+         * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+         * @requires_gles30 Skinning requires integer support in shaders,
+         *      which is not available in OpenGL ES 2.0.
+         * @requires_webgl20 Skinning requires integer support in shaders,
+         *      which is not available in WebGL 1.0.
+         */
+        typedef typename GenericGL<dimensions>::JointIds JointIds;
+
+        /**
+         * @brief Weights
+         * @m_since_latest
+         *
+         * @ref shaders-generic "Generic attribute",
+         * @ref Magnum::Vector4 "Vector4". Used only if
+         * @ref perVertexJointCount() isn't @cpp 0 @ce.
+         * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+         * @requires_gles30 Skinning requires integer support in shaders,
+         *      which is not available in OpenGL ES 2.0.
+         * @requires_webgl20 Skinning requires integer support in shaders,
+         *      which is not available in WebGL 1.0.
+         */
+        typedef typename GenericGL<dimensions>::Weights Weights;
+
+        /**
+         * @brief Secondary joint ids
+         * @m_since_latest
+         *
+         * @ref shaders-generic "Generic attribute",
+         * @ref Magnum::Vector4ui "Vector4ui". Used only if
+         * @ref secondaryPerVertexJointCount() isn't @cpp 0 @ce.
+         * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+         * @requires_gles30 Skinning requires integer support in shaders,
+         *      which is not available in OpenGL ES 2.0.
+         * @requires_webgl20 Skinning requires integer support in shaders,
+         *      which is not available in WebGL 1.0.
+         */
+        typedef typename GenericGL<dimensions>::SecondaryJointIds SecondaryJointIds;
+
+        /**
+         * @brief Secondary weights
+         * @m_since_latest
+         *
+         * @ref shaders-generic "Generic attribute",
+         * @ref Magnum::Vector4 "Vector4". Used only if
+         * @ref secondaryPerVertexJointCount() isn't @cpp 0 @ce.
+         * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+         * @requires_gles30 Skinning requires integer support in shaders,
+         *      which is not available in OpenGL ES 2.0.
+         * @requires_webgl20 Skinning requires integer support in shaders,
+         *      which is not available in WebGL 1.0.
+         */
+        typedef typename GenericGL<dimensions>::SecondaryWeights SecondaryWeights;
+
         /**
          * @brief (Instanced) object ID
          * @m_since{2020,06}
@@ -328,7 +483,23 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT FlatGL: public GL::
              *      shaders, which is not available in WebGL 1.0.
              * @m_since{2019,10}
              */
-            ObjectIdOutput = GenericGL<dimensions>::ObjectIdOutput
+            ObjectIdOutput = GenericGL<dimensions>::ObjectIdOutput,
+
+            /**
+             * Revealage output. @ref shaders-generic "Generic output",
+             * present only if @ref Flag::OrderIndependentTransparency is set.
+             * Expects a single-component floating-point or normalized buffer
+             * attachment. See @ref Shaders-FlatGL-oit for more information.
+             * @requires_gl30 Extension @gl_extension{ARB,texture_float}
+             * @requires_gles30 Order-independent transparency requires
+             *      floating-point render targets, which are not available in
+             *      OpenGL ES 2.0.
+             * @requires_webgl20 Order-independent transparency requires
+             *      floating-point render targets, which are not available in
+             *      WebGL 1.0.
+             * @m_since_latest
+             */
+            RevealageOutput = GenericGL<dimensions>::RevealageOutput
             #endif
         };
 
@@ -523,7 +694,86 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT FlatGL: public GL::
              * @requires_webgl20 Texture arrays are not available in WebGL 1.0.
              * @m_since_latest
              */
-            TextureArrays = 1 << 10
+            TextureArrays = 1 << 10,
+
+            #ifndef MAGNUM_TARGET_GLES
+            /**
+             * Use bindless textures. Expects that @ref Flag::UniformBuffers
+             * is enabled as well and that the color and object ID texture
+             * handles are supplied per material via
+             * @ref bindMaterialTextureBuffer() instead of binding the
+             * textures with @ref bindTexture() and
+             * @ref bindObjectIdTexture(). Together with @ref Flag::MultiDraw
+             * this allows drawing meshes with arbitrary textures in a single
+             * draw call. See @ref Shaders-FlatGL-bindless for more
+             * information.
+             * @requires_extension Extension @gl_extension{ARB,bindless_texture}
+             * @requires_gl Bindless textures are not available in OpenGL ES
+             *      or WebGL.
+             * @m_since_latest
+             */
+            BindlessTextures = 1 << 12,
+            #endif
+
+            /**
+             * Dynamic per-vertex joint count for skinning. Uses only the
+             * first @cpp M @ce / @cpp N @ce primary / secondary components
+             * defined by @ref setPerVertexJointCount() instead of all
+             * primary / secondary components defined by
+             * @ref Configuration::setJointCount() at shader compilation time.
+             * Useful in order to avoid having a shader permutation defined
+             * for every possible joint count, at the cost of a branch in the
+             * vertex shader. See @ref Shaders-FlatGL-skinning for more
+             * information.
+             * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+             * @requires_gles30 Skinning requires integer support in shaders,
+             *      which is not available in OpenGL ES 2.0.
+             * @requires_webgl20 Skinning requires integer support in shaders,
+             *      which is not available in WebGL 1.0.
+             * @m_since_latest
+             */
+            DynamicPerVertexJointCount = 1 << 13,
+
+            /**
+             * Weighted blended order-independent transparency. Instead of the
+             * final color, @ref ColorOutput contains a premultiplied color
+             * scaled by a depth- and alpha-dependent weight, meant to be
+             * accumulated in a floating-point attachment, and
+             * @ref RevealageOutput the alpha, meant to be multiplied
+             * together. The result is then composited with
+             * @ref TransparencyResolveGL. See @ref Shaders-FlatGL-oit for
+             * more information.
+             * @requires_gl30 Extension @gl_extension{ARB,texture_float}
+             * @requires_gles30 Order-independent transparency requires
+             *      floating-point render targets, which are not available in
+             *      OpenGL ES 2.0.
+             * @requires_webgl20 Order-independent transparency requires
+             *      floating-point render targets, which are not available in
+             *      WebGL 1.0.
+             * @m_since_latest
+             */
+            OrderIndependentTransparency = 1 << 14,
+
+            #ifndef MAGNUM_TARGET_WEBGL
+            /**
+             * Fetch positions, texture coordinates and vertex colors from
+             * shader storage buffers bound with
+             * @ref bindPositionStorageBuffer(),
+             * @ref bindTextureCoordinatesStorageBuffer() and
+             * @ref bindColorStorageBuffer() instead of vertex attributes,
+             * with per-draw offsets supplied via
+             * @ref bindVertexPullingBuffer(). Implies
+             * @ref Flag::UniformBuffers. See
+             * @ref Shaders-FlatGL-vertex-pulling for more information.
+             * @requires_gl43 Extension @gl_extension{ARB,shader_storage_buffer_object}
+             * @requires_gles31 Shader storage buffers are not available in
+             *      OpenGL ES 3.0 and older.
+             * @requires_gles Shader storage buffers are not available in
+             *      WebGL.
+             * @m_since_latest
+             */
+            VertexPulling = UniformBuffers|(1 << 15)
+            #endif
             #endif
         };
 
@@ -540,6 +790,49 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT FlatGL: public GL::
         typedef Implementation::FlatGLFlags Flags;
         #endif
 
+        class Configuration;
+        class CompileState;
+
+        /**
+         * @brief Compile asynchronously
+         * @m_since_latest
+         *
+         * Compared to @ref FlatGL(Flags) can perform an asynchronous
+         * compilation and linking. See @ref shaders-async for more
+         * information.
+         * @see @ref FlatGL(CompileState&&),
+         *      @ref compile(Flags, UnsignedInt, UnsignedInt),
+         *      @ref compile(const Configuration&)
+         */
+        static CompileState compile(Flags flags = {});
+
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Compile for a multi-draw scenario asynchronously
+         * @m_since_latest
+         *
+         * Compared to @ref FlatGL(Flags, UnsignedInt, UnsignedInt) can
+         * perform an asynchronous compilation and linking. See
+         * @ref shaders-async for more information.
+         * @see @ref FlatGL(CompileState&&), @ref compile(Flags)
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        static CompileState compile(Flags flags, UnsignedInt materialCount, UnsignedInt drawCount);
+        #endif
+
+        /**
+         * @brief Compile with a configuration asynchronously
+         * @m_since_latest
+         *
+         * Compared to @ref FlatGL(const Configuration&) can perform an
+         * asynchronous compilation and linking. See @ref shaders-async for
+         * more information.
+         * @see @ref FlatGL(CompileState&&)
+         */
+        static CompileState compile(const Configuration& configuration);
+
         /**
          * @brief Constructor
          * @param flags     Flags
@@ -548,6 +841,7 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT FlatGL: public GL::
          * scenario (without @ref Flag::UniformBuffers set), it's equivalent to
          * @ref FlatGL(Flags, UnsignedInt, UnsignedInt) with @p materialCount
          * and @p drawCount set to @cpp 1 @ce.
+         * @see @ref FlatGL(const Configuration&)
          */
         explicit FlatGL(Flags flags = {});
 
@@ -575,19 +869,32 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT FlatGL: public GL::
          * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
          * @requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
          * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         * @see @ref FlatGL(const Configuration&)
          */
-        /** @todo this constructor will eventually need to have also joint
-            count, per-vertex weight count, view count for multiview and clip
-            plane count ... and putting them in arbitrary order next to each
-            other is too error-prone, so it needs some other solution
-            (accepting pairs of parameter type and value like in GL context
-            creation, e.g., which will probably need a new enum as reusing Flag
-            for this might be too confusing); what if some parameters won't be
-            (unsigned) integers? like a string with shader extensions? make a
-            whole Configuration class? */
         explicit FlatGL(Flags flags, UnsignedInt materialCount, UnsignedInt drawCount);
         #endif
 
+        /**
+         * @brief Construct with a configuration
+         * @m_since_latest
+         *
+         * A superset of @ref FlatGL(Flags, UnsignedInt, UnsignedInt),
+         * additionally allowing to enable skinning via
+         * @ref Configuration::setJointCount().
+         * @see @ref compile(const Configuration&)
+         */
+        explicit FlatGL(const Configuration& configuration);
+
+        /**
+         * @brief Finalize an asynchronous compilation
+         * @m_since_latest
+         *
+         * Takes an asynchronous compilation state returned by @ref compile()
+         * and forms a ready-to-use shader object. See @ref shaders-async for
+         * more information.
+         */
+        explicit FlatGL(CompileState&& state);
+
         /**
          * @brief Construct without creating the underlying OpenGL object
          *
@@ -643,6 +950,72 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT FlatGL: public GL::
          * @requires_webgl20 Not defined on WebGL 1.0 builds.
          */
         UnsignedInt drawCount() const { return _drawCount; }
+
+        /**
+         * @brief Joint count
+         * @m_since_latest
+         *
+         * If @ref Flag::UniformBuffers is not set, this is the number of joint
+         * matrices accepted by @ref setJointMatrices() / @ref setJointMatrix().
+         * If @ref Flag::UniformBuffers is set, this is the statically defined
+         * size of the @ref TransformationUniform2D /
+         * @ref TransformationUniform3D uniform buffer bound with
+         * @ref bindJointBuffer(). If @cpp 0 @ce, skinning is disabled.
+         * @see @ref Configuration::setJointCount()
+         * @requires_gles30 Not defined on OpenGL ES 2.0 builds.
+         * @requires_webgl20 Not defined on WebGL 1.0 builds.
+         */
+        UnsignedInt jointCount() const { return _jointCount; }
+
+        /**
+         * @brief Count of joints affecting a single vertex
+         * @m_since_latest
+         *
+         * If @ref Flag::DynamicPerVertexJointCount is set, the count can be
+         * additionally modified per-draw using
+         * @ref setPerVertexJointCount().
+         * @see @ref Configuration::setJointCount()
+         * @requires_gles30 Not defined on OpenGL ES 2.0 builds.
+         * @requires_webgl20 Not defined on WebGL 1.0 builds.
+         */
+        UnsignedInt perVertexJointCount() const { return _perVertexJointCount; }
+
+        /**
+         * @brief Count of secondary joints affecting a single vertex
+         * @m_since_latest
+         *
+         * If @ref Flag::DynamicPerVertexJointCount is set, the count can be
+         * additionally modified per-draw using
+         * @ref setPerVertexJointCount().
+         * @see @ref Configuration::setJointCount()
+         * @requires_gles30 Not defined on OpenGL ES 2.0 builds.
+         * @requires_webgl20 Not defined on WebGL 1.0 builds.
+         */
+        UnsignedInt secondaryPerVertexJointCount() const { return _secondaryPerVertexJointCount; }
+
+        /**
+         * @brief Set dynamic per-vertex skinning joint count
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Allows reducing the count of iterated joints for a particular draw
+         * call, making it possible to use a single shader with meshes that
+         * contain different count of per-vertex joints. See
+         * @ref Flag::DynamicPerVertexJointCount for more information. Initial
+         * value is the same as @ref perVertexJointCount() and
+         * @ref secondaryPerVertexJointCount().
+         *
+         * Expects that @ref Flag::DynamicPerVertexJointCount is set,
+         * @p count is not larger than @ref perVertexJointCount() and
+         * @p secondaryCount not larger than
+         * @ref secondaryPerVertexJointCount().
+         * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+         * @requires_gles30 Skinning requires integer support in shaders,
+         *      which is not available in OpenGL ES 2.0.
+         * @requires_webgl20 Skinning requires integer support in shaders,
+         *      which is not available in WebGL 1.0.
+         */
+        FlatGL<dimensions>& setPerVertexJointCount(UnsignedInt count, UnsignedInt secondaryCount = 0);
         #endif
 
         /** @{
@@ -766,6 +1139,53 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT FlatGL: public GL::
          *      shaders, which is not available in WebGL 1.0.
          */
         FlatGL<dimensions>& setObjectId(UnsignedInt id);
+
+        /**
+         * @brief Set joint matrices
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Initial values are identity transformations. Expects that the size
+         * of the @p matrices array is not larger than @ref jointCount().
+         *
+         * Expects that @ref Flag::UniformBuffers is not set, in that case fill
+         * @ref TransformationUniform2D::transformationMatrix /
+         * @ref TransformationUniform3D::transformationMatrix and call
+         * @ref bindJointBuffer() instead.
+         * @see @ref Shaders-FlatGL-skinning, @ref setJointMatrix()
+         * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+         * @requires_gles30 Skinning requires integer support in shaders,
+         *      which is not available in OpenGL ES 2.0.
+         * @requires_webgl20 Skinning requires integer support in shaders,
+         *      which is not available in WebGL 1.0.
+         */
+        FlatGL<dimensions>& setJointMatrices(Containers::ArrayView<const MatrixTypeFor<dimensions, Float>> matrices);
+
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        FlatGL<dimensions>& setJointMatrices(std::initializer_list<MatrixTypeFor<dimensions, Float>> matrices);
+
+        /**
+         * @brief Set joint matrix for given joint
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Unlike @ref setJointMatrices() updates just a single joint matrix.
+         * Expects that @p id is less than @ref jointCount().
+         *
+         * Expects that @ref Flag::UniformBuffers is not set, in that case fill
+         * @ref TransformationUniform2D::transformationMatrix /
+         * @ref TransformationUniform3D::transformationMatrix and call
+         * @ref bindJointBuffer() instead.
+         * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+         * @requires_gles30 Skinning requires integer support in shaders,
+         *      which is not available in OpenGL ES 2.0.
+         * @requires_webgl20 Skinning requires integer support in shaders,
+         *      which is not available in WebGL 1.0.
+         */
+        FlatGL<dimensions>& setJointMatrix(UnsignedInt id, const MatrixTypeFor<dimensions, Float>& matrix);
         #endif
 
         /**
@@ -886,6 +1306,135 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT FlatGL: public GL::
          */
         FlatGL<dimensions>& bindMaterialBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
 
+        /**
+         * @brief Set a joint matrix uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::UniformBuffers is set. The buffer is
+         * expected to contain @ref jointCount() instances of
+         * @ref TransformationUniform2D / @ref TransformationUniform3D. Which
+         * range of the buffer is used for a particular draw is controlled by
+         * @ref FlatDrawUniform::jointOffset.
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        FlatGL<dimensions>& bindJointBuffer(GL::Buffer& buffer);
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        FlatGL<dimensions>& bindJointBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Set a material texture uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::BindlessTextures is set. The buffer is
+         * expected to contain @ref materialCount() instances of
+         * @ref FlatMaterialTextureUniform with handles of resident
+         * textures. See @ref Shaders-FlatGL-bindless for more information.
+         * @requires_extension Extension @gl_extension{ARB,bindless_texture}
+         * @requires_gl Bindless textures are not available in OpenGL ES or
+         *      WebGL.
+         */
+        FlatGL<dimensions>& bindMaterialTextureBuffer(GL::Buffer& buffer);
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        FlatGL<dimensions>& bindMaterialTextureBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+        #endif
+
+        #ifndef MAGNUM_TARGET_WEBGL
+        /**
+         * @brief Set a vertex pulling uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::VertexPulling is set. The buffer is
+         * expected to contain @ref drawCount() instances of
+         * @ref VertexPullingUniform. See
+         * @ref Shaders-FlatGL-vertex-pulling for more information.
+         * @requires_gl43 Extension @gl_extension{ARB,shader_storage_buffer_object}
+         * @requires_gles31 Shader storage buffers are not available in
+         *      OpenGL ES 3.0 and older.
+         * @requires_gles Shader storage buffers are not available in WebGL.
+         */
+        FlatGL<dimensions>& bindVertexPullingBuffer(GL::Buffer& buffer);
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        FlatGL<dimensions>& bindVertexPullingBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Set a position storage buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::VertexPulling is set. The buffer is
+         * expected to contain tightly packed @ref Vector2 positions for 2D
+         * and @ref Vector3 positions for 3D, the first vertex of each draw
+         * given by @ref VertexPullingUniform::positionOffset.
+         * @requires_gl43 Extension @gl_extension{ARB,shader_storage_buffer_object}
+         * @requires_gles31 Shader storage buffers are not available in
+         *      OpenGL ES 3.0 and older.
+         * @requires_gles Shader storage buffers are not available in WebGL.
+         */
+        FlatGL<dimensions>& bindPositionStorageBuffer(GL::Buffer& buffer);
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        FlatGL<dimensions>& bindPositionStorageBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Set a texture coordinate storage buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::VertexPulling is set and the shader is
+         * textured. The buffer is expected to contain tightly packed
+         * @ref Vector2 texture coordinates, the first vertex of each draw
+         * given by @ref VertexPullingUniform::textureCoordinatesOffset.
+         * @requires_gl43 Extension @gl_extension{ARB,shader_storage_buffer_object}
+         * @requires_gles31 Shader storage buffers are not available in
+         *      OpenGL ES 3.0 and older.
+         * @requires_gles Shader storage buffers are not available in WebGL.
+         */
+        FlatGL<dimensions>& bindTextureCoordinatesStorageBuffer(GL::Buffer& buffer);
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        FlatGL<dimensions>& bindTextureCoordinatesStorageBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Set a vertex color storage buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that both @ref Flag::VertexPulling and
+         * @ref Flag::VertexColor is set. The buffer is expected to contain
+         * tightly packed @ref Color4 vertex colors, the first vertex of each
+         * draw given by @ref VertexPullingUniform::colorOffset.
+         * @requires_gl43 Extension @gl_extension{ARB,shader_storage_buffer_object}
+         * @requires_gles31 Shader storage buffers are not available in
+         *      OpenGL ES 3.0 and older.
+         * @requires_gles Shader storage buffers are not available in WebGL.
+         */
+        FlatGL<dimensions>& bindColorStorageBuffer(GL::Buffer& buffer);
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        FlatGL<dimensions>& bindColorStorageBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+        #endif
+
         /**
          * @}
          */
@@ -1011,6 +1560,10 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT FlatGL: public GL::
         #endif
 
     private:
+        /* Creates the GL shader program object but does nothing else.
+           Internal, used by compile(). */
+        explicit FlatGL(NoInitT) {}
+
         /* Prevent accidentally calling irrelevant functions */
         #ifndef MAGNUM_TARGET_GLES
         using GL::AbstractShaderProgram::drawTransformFeedback;
@@ -1021,7 +1574,8 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT FlatGL: public GL::
 
         Flags _flags;
         #ifndef MAGNUM_TARGET_GLES2
-        UnsignedInt _materialCount{}, _drawCount{};
+        UnsignedInt _materialCount{}, _drawCount{}, _jointCount{},
+            _perVertexJointCount{}, _secondaryPerVertexJointCount{};
         #endif
         Int _transformationProjectionMatrixUniform{0},
             _textureMatrixUniform{1},
@@ -1031,13 +1585,175 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT FlatGL: public GL::
             _colorUniform{3},
             _alphaMaskUniform{4};
         #ifndef MAGNUM_TARGET_GLES2
-        Int _objectIdUniform{5};
-        /* Used instead of all other uniforms when Flag::UniformBuffers is set,
-           so it can alias them */
+        Int _objectIdUniform{5},
+            _jointMatricesUniform{6},
+            _perVertexJointCountUniform; /* 6 + jointCount */
+        /* Used instead of all other uniforms except joints when
+           Flag::UniformBuffers is set, so it can alias them */
         Int _drawOffsetUniform{0};
         #endif
 };
 
+/**
+@brief Configuration
+@m_since_latest
+
+@see @ref FlatGL(const Configuration&), @ref compile(const Configuration&)
+*/
+template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT FlatGL<dimensions>::Configuration {
+    public:
+        explicit Configuration() = default;
+
+        /** @brief Flags */
+        Flags flags() const { return _flags; }
+
+        /**
+         * @brief Set flags
+         *
+         * No flags are set by default.
+         * @see @ref FlatGL::flags()
+         */
+        Configuration& setFlags(Flags flags) {
+            _flags = flags;
+            return *this;
+        }
+
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Material count
+         *
+         * @requires_gles30 Not defined on OpenGL ES 2.0 builds.
+         * @requires_webgl20 Not defined on WebGL 1.0 builds.
+         */
+        UnsignedInt materialCount() const { return _materialCount; }
+
+        /**
+         * @brief Set material count
+         *
+         * If @ref Flag::UniformBuffers is set, describes size of a
+         * @ref FlatMaterialUniform buffer bound with
+         * @ref FlatGL::bindMaterialBuffer(), ignored otherwise. Default value
+         * is @cpp 1 @ce.
+         * @see @ref FlatGL::materialCount()
+         * @requires_gles30 Not defined on OpenGL ES 2.0 builds.
+         * @requires_webgl20 Not defined on WebGL 1.0 builds.
+         */
+        Configuration& setMaterialCount(UnsignedInt count) {
+            _materialCount = count;
+            return *this;
+        }
+
+        /**
+         * @brief Draw count
+         *
+         * @requires_gles30 Not defined on OpenGL ES 2.0 builds.
+         * @requires_webgl20 Not defined on WebGL 1.0 builds.
+         */
+        UnsignedInt drawCount() const { return _drawCount; }
+
+        /**
+         * @brief Set draw count
+         *
+         * If @ref Flag::UniformBuffers is set, describes size of a
+         * @ref TransformationProjectionUniform2D /
+         * @ref TransformationProjectionUniform3D / @ref FlatDrawUniform /
+         * @ref TextureTransformationUniform buffer bound with
+         * @ref FlatGL::bindTransformationProjectionBuffer(),
+         * @ref FlatGL::bindDrawBuffer() and
+         * @ref FlatGL::bindTextureTransformationBuffer(), ignored otherwise.
+         * Default value is @cpp 1 @ce.
+         * @see @ref FlatGL::drawCount()
+         * @requires_gles30 Not defined on OpenGL ES 2.0 builds.
+         * @requires_webgl20 Not defined on WebGL 1.0 builds.
+         */
+        Configuration& setDrawCount(UnsignedInt count) {
+            _drawCount = count;
+            return *this;
+        }
+
+        /**
+         * @brief Joint count
+         *
+         * @requires_gles30 Not defined on OpenGL ES 2.0 builds.
+         * @requires_webgl20 Not defined on WebGL 1.0 builds.
+         */
+        UnsignedInt jointCount() const { return _jointCount; }
+
+        /**
+         * @brief Per-vertex joint count
+         *
+         * @requires_gles30 Not defined on OpenGL ES 2.0 builds.
+         * @requires_webgl20 Not defined on WebGL 1.0 builds.
+         */
+        UnsignedInt perVertexJointCount() const { return _perVertexJointCount; }
+
+        /**
+         * @brief Secondary per-vertex joint count
+         *
+         * @requires_gles30 Not defined on OpenGL ES 2.0 builds.
+         * @requires_webgl20 Not defined on WebGL 1.0 builds.
+         */
+        UnsignedInt secondaryPerVertexJointCount() const { return _secondaryPerVertexJointCount; }
+
+        /**
+         * @brief Set joint count
+         *
+         * If @ref Flag::UniformBuffers isn't set, @p count describes an upper
+         * bound on how many joint matrices get supplied to each draw with
+         * @ref FlatGL::setJointMatrices() / @ref FlatGL::setJointMatrix().
+         * If @ref Flag::UniformBuffers is set, @p count describes size of a
+         * @ref TransformationUniform2D / @ref TransformationUniform3D buffer
+         * bound with @ref FlatGL::bindJointBuffer().
+         *
+         * The @p perVertexCount and @p secondaryPerVertexCount parameters
+         * describe how many components are taken from @ref JointIds /
+         * @ref Weights and @ref SecondaryJointIds / @ref SecondaryWeights
+         * attributes. Both values are expected to not be larger than
+         * @cpp 4 @ce, setting either of these to @cpp 0 @ce means given
+         * attribute is not used at all.
+         *
+         * Expects that either both @p count and the per-vertex counts are
+         * zero or both are non-zero. Default value for all three is
+         * @cpp 0 @ce.
+         * @see @ref FlatGL::jointCount(),
+         *      @ref FlatGL::perVertexJointCount(),
+         *      @ref FlatGL::secondaryPerVertexJointCount()
+         * @requires_gles30 Not defined on OpenGL ES 2.0 builds.
+         * @requires_webgl20 Not defined on WebGL 1.0 builds.
+         */
+        Configuration& setJointCount(UnsignedInt count, UnsignedInt perVertexCount, UnsignedInt secondaryPerVertexCount = 0);
+        #endif
+
+    private:
+        Flags _flags;
+        #ifndef MAGNUM_TARGET_GLES2
+        UnsignedInt _materialCount = 1;
+        UnsignedInt _drawCount = 1;
+        UnsignedInt _jointCount = 0;
+        UnsignedInt _perVertexJointCount = 0;
+        UnsignedInt _secondaryPerVertexJointCount = 0;
+        #endif
+};
+
+/**
+@brief Asynchronous compilation state
+@m_since_latest
+
+Returned by @ref compile(). See @ref shaders-async for more information.
+*/
+template<UnsignedInt dimensions> class FlatGL<dimensions>::CompileState: public FlatGL<dimensions> {
+    /* Everything deliberately private except for the inheritance */
+    friend class FlatGL;
+
+    explicit CompileState(NoCreateT): FlatGL<dimensions>{NoCreate}, _vert{NoCreate}, _frag{NoCreate} {}
+
+    explicit CompileState(FlatGL<dimensions>&& shader, GL::Shader&& vert, GL::Shader&& frag, GL::Version version, bool cached): FlatGL<dimensions>{std::move(shader)}, _vert{std::move(vert)}, _frag{std::move(frag)}, _version{version}, _cached{cached} {}
+
+    GL::Shader _vert, _frag;
+    GL::Version _version;
+    bool _cached;
+};
+
 /**
 @brief 2D flat OpenGL shader
 @m_since_latest
@@ -26,7 +26,7 @@
 */
 
 /** @file
- * @brief Struct @ref Magnum::Shaders::ProjectionUniform2D, @ref Magnum::Shaders::ProjectionUniform3D, @ref Magnum::Shaders::TransformationUniform2D, @ref Magnum::Shaders::TransformationUniform3D, @ref Magnum::Shaders::TextureTransformationUniform
+ * @brief Struct @ref Magnum::Shaders::ProjectionUniform2D, @ref Magnum::Shaders::ProjectionUniform3D, @ref Magnum::Shaders::TransformationUniform2D, @ref Magnum::Shaders::TransformationUniform3D, @ref Magnum::Shaders::TextureTransformationUniform, @ref Magnum::Shaders::VertexPullingUniform
  */
 
 #include "Magnum/Magnum.h"
@@ -484,6 +484,117 @@ struct TextureTransformationUniform {
     #endif
 };
 
+/**
+@brief Vertex pulling uniform
+@m_since_latest
+
+Per-draw offsets into vertex storage buffers, used only if
+@ref FlatGL::Flag::VertexPulling or @ref PhongGL::Flag::VertexPulling is
+enabled. All offsets are in vertices, not bytes, which allows multiple meshes
+to be placed into the same set of storage buffers and drawn with a single
+multi-draw call.
+@see @ref FlatGL::bindVertexPullingBuffer(),
+    @ref PhongGL::bindVertexPullingBuffer()
+*/
+struct VertexPullingUniform {
+    /** @brief Construct with default parameters */
+    constexpr explicit VertexPullingUniform(DefaultInitT = DefaultInit) noexcept: positionOffset{0}, normalOffset{0}, textureCoordinatesOffset{0}, colorOffset{0} {}
+    /** @brief Construct without initializing the contents */
+    explicit VertexPullingUniform(NoInitT) noexcept {}
+
+    /** @{
+     * @name Convenience setters
+     *
+     * Provided to allow the use of method chaining for populating a structure
+     * in a single expression, otherwise equivalent to accessing the fields
+     * directly. Also guaranteed to provide backwards compatibility when
+     * packing of the actual fields changes.
+     */
+
+    /**
+     * @brief Set the @ref positionOffset field
+     * @return Reference to self (for method chaining)
+     */
+    VertexPullingUniform& setPositionOffset(UnsignedInt offset) {
+        positionOffset = offset;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref normalOffset field
+     * @return Reference to self (for method chaining)
+     */
+    VertexPullingUniform& setNormalOffset(UnsignedInt offset) {
+        normalOffset = offset;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref textureCoordinatesOffset field
+     * @return Reference to self (for method chaining)
+     */
+    VertexPullingUniform& setTextureCoordinatesOffset(UnsignedInt offset) {
+        textureCoordinatesOffset = offset;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref colorOffset field
+     * @return Reference to self (for method chaining)
+     */
+    VertexPullingUniform& setColorOffset(UnsignedInt offset) {
+        colorOffset = offset;
+        return *this;
+    }
+
+    /**
+     * @}
+     */
+
+    /**
+     * @brief Position offset
+     *
+     * Offset of the first vertex of the draw in the position storage buffer,
+     * in vertices. Default value is @cpp 0 @ce.
+     * @see @ref FlatGL::bindPositionStorageBuffer(),
+     *      @ref PhongGL::bindPositionStorageBuffer()
+     */
+    UnsignedInt positionOffset;
+
+    /**
+     * @brief Normal offset
+     *
+     * Offset of the first vertex of the draw in the normal storage buffer, in
+     * vertices. Default value is @cpp 0 @ce. Used only by @ref PhongGL if
+     * there's at least one light, ignored otherwise.
+     * @see @ref PhongGL::bindNormalStorageBuffer()
+     */
+    UnsignedInt normalOffset;
+
+    /**
+     * @brief Texture coordinates offset
+     *
+     * Offset of the first vertex of the draw in the texture coordinate
+     * storage buffer, in vertices. Default value is @cpp 0 @ce. Used only if
+     * the shader is textured, ignored otherwise.
+     * @see @ref FlatGL::bindTextureCoordinatesStorageBuffer(),
+     *      @ref PhongGL::bindTextureCoordinatesStorageBuffer()
+     */
+    UnsignedInt textureCoordinatesOffset;
+
+    /**
+     * @brief Color offset
+     *
+     * Offset of the first vertex of the draw in the vertex color storage
+     * buffer, in vertices. Default value is @cpp 0 @ce. Used only if
+     * @ref FlatGL::Flag::VertexColor / @ref PhongGL::Flag::VertexColor is
+     * enabled, ignored otherwise.
+     * @see @ref FlatGL::bindColorStorageBuffer(),
+     *      @ref PhongGL::bindColorStorageBuffer()
+     */
+    UnsignedInt colorOffset;
+};
+
 #ifdef MAGNUM_BUILD_DEPRECATED
 /* Deprecated aliases not present here but in GenericGL.h instead, as a lot of
    existing code relies on these being transitively included from Phong.h etc.,
@@ -125,13 +125,13 @@ both bitangents and object ID for instancing, \n
 <tr>
 <td>6</td>
 <td colspan="3">
-* *Reserved* --- vertex weights
+@ref Weights
 </td>
 </tr>
 <tr>
 <td>7</td>
 <td colspan="3">
-* *Reserved* --- bone indices
+@ref JointIds
 </td>
 </tr>
 <tr>
@@ -149,13 +149,13 @@ both bitangents and object ID for instancing, \n
 <tr>
 <td>10</td>
 <td colspan="2">
-* *Reserved* --- 2nd vertex weights
+@ref SecondaryWeights
 </td>
 </tr>
 <tr>
 <td>11</td>
 <td colspan="2">
-* *Reserved* --- 2nd bone indices
+@ref SecondaryJointIds
 </td>
 </tr>
 <tr>
@@ -273,7 +273,21 @@ template<UnsignedInt dimensions> struct GenericGL {
          * @requires_webgl20 Object ID output requires integer support in
          *      shaders, which is not available in WebGL 1.0.
          */
-        ObjectIdOutput = 1
+        ObjectIdOutput = 1,
+
+        /**
+         * Revealage output for weighted blended order-independent
+         * transparency. Expects a single-component floating-point or
+         * normalized buffer attachment. See @ref TransparencyResolveGL for
+         * more information.
+         * @requires_gl30 Extension @gl_extension{ARB,texture_float}
+         * @requires_gles30 Floating-point render targets are not available
+         *      in OpenGL ES 2.0.
+         * @requires_webgl20 Floating-point render targets are not available
+         *      in WebGL 1.0.
+         * @m_since_latest
+         */
+        RevealageOutput = 2
         #endif
     };
 
@@ -382,7 +396,37 @@ template<UnsignedInt dimensions> struct GenericGL {
      */
     typedef GL::Attribute<5, Vector3> Normal;
 
-    /* 6, 7 reserved for vertex weights / bone IDs */
+    #ifndef MAGNUM_TARGET_GLES2
+    /**
+     * @brief Weights
+     * @m_since_latest
+     *
+     * @ref Magnum::Vector4 "Vector4", weights of up to four joints
+     * referenced by @ref JointIds. Currently doesn't have a corresponding
+     * @ref Trade::MeshAttribute.
+     * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+     * @requires_gles30 Skinning requires integer support in shaders, which
+     *      is not available in OpenGL ES 2.0.
+     * @requires_webgl20 Skinning requires integer support in shaders, which
+     *      is not available in WebGL 1.0.
+     */
+    typedef GL::Attribute<6, Vector4> Weights;
+
+    /**
+     * @brief Joint IDs
+     * @m_since_latest
+     *
+     * @ref Magnum::Vector4ui "Vector4ui", IDs of up to four joints, indexing
+     * the joint matrix array. Currently doesn't have a corresponding
+     * @ref Trade::MeshAttribute.
+     * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+     * @requires_gles30 Skinning requires integer support in shaders, which
+     *      is not available in OpenGL ES 2.0.
+     * @requires_webgl20 Skinning requires integer support in shaders, which
+     *      is not available in WebGL 1.0.
+     */
+    typedef GL::Attribute<7, Vector4ui> JointIds;
+    #endif
 
     /**
      * @brief (Instanced) transformation matrix
@@ -401,6 +445,45 @@ template<UnsignedInt dimensions> struct GenericGL {
 
     /* 9, 10, 11 occupied by TransformationMatrix */
 
+    #ifndef MAGNUM_TARGET_GLES2
+    /**
+     * @brief Secondary weights
+     * @m_since_latest
+     *
+     * @ref Magnum::Vector4 "Vector4", weights of additional four joints
+     * referenced by @ref SecondaryJointIds, for meshes with more than four
+     * joints per vertex. Currently doesn't have a corresponding
+     * @ref Trade::MeshAttribute.
+     *
+     * This attribute conflicts with @ref TransformationMatrix, so it's not
+     * possible to use it together with instanced transformation.
+     * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+     * @requires_gles30 Skinning requires integer support in shaders, which
+     *      is not available in OpenGL ES 2.0.
+     * @requires_webgl20 Skinning requires integer support in shaders, which
+     *      is not available in WebGL 1.0.
+     */
+    typedef GL::Attribute<10, Vector4> SecondaryWeights;
+
+    /**
+     * @brief Secondary joint IDs
+     * @m_since_latest
+     *
+     * @ref Magnum::Vector4ui "Vector4ui", IDs of additional four joints, for
+     * meshes with more than four joints per vertex. Currently doesn't have a
+     * corresponding @ref Trade::MeshAttribute.
+     *
+     * This attribute conflicts with @ref TransformationMatrix in 3D, so it's
+     * not possible to use it together with instanced transformation.
+     * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+     * @requires_gles30 Skinning requires integer support in shaders, which
+     *      is not available in OpenGL ES 2.0.
+     * @requires_webgl20 Skinning requires integer support in shaders, which
+     *      is not available in WebGL 1.0.
+     */
+    typedef GL::Attribute<11, Vector4ui> SecondaryJointIds;
+    #endif
+
     /**
      * @brief (Instanced) normal matrix
      * @m_since{2020,06}
@@ -469,7 +552,8 @@ struct BaseGenericGL {
     enum: UnsignedInt {
         ColorOutput = 0,
         #ifndef MAGNUM_TARGET_GLES2
-        ObjectIdOutput = 1
+        ObjectIdOutput = 1,
+        RevealageOutput = 2
         #endif
     };
 
@@ -478,6 +562,10 @@ struct BaseGenericGL {
     typedef GL::Attribute<2, Magnum::Color4> Color4;
     #ifndef MAGNUM_TARGET_GLES2
     typedef GL::Attribute<4, UnsignedInt> ObjectId;
+    typedef GL::Attribute<6, Vector4> Weights;
+    typedef GL::Attribute<7, Vector4ui> JointIds;
+    typedef GL::Attribute<10, Vector4> SecondaryWeights;
+    typedef GL::Attribute<11, Vector4ui> SecondaryJointIds;
     #endif
 
     typedef GL::Attribute<15, Vector2> TextureOffset;
@@ -491,7 +579,7 @@ template<> struct GenericGL<2>: BaseGenericGL {
     /* 1, 2 used by TextureCoordinates and Color */
 
     typedef GL::Attribute<8, Matrix3> TransformationMatrix;
-    /* 9, 10 occupied by TransformationMatrix */
+    /* 9, 10 occupied by TransformationMatrix, 10 also by SecondaryWeights */
     /* 15 used by TextureOffset */
 };
 
@@ -502,10 +590,11 @@ template<> struct GenericGL<3>: BaseGenericGL {
     typedef GL::Attribute<3, Vector4> Tangent4;
     typedef GL::Attribute<4, Vector3> Bitangent; /* also ObjectId */
     typedef GL::Attribute<5, Vector3> Normal;
-    /* 6, 7 reserved for vertex weights / bone IDs */
+    /* 6, 7 used by Weights and JointIds */
 
     typedef GL::Attribute<8, Matrix4> TransformationMatrix;
-    /* 9, 10, 11 occupied by TransformationMatrix */
+    /* 9, 10, 11 occupied by TransformationMatrix, 10 and 11 also by
+       SecondaryWeights and SecondaryJointIds */
     typedef GL::Attribute<12, Matrix3x3> NormalMatrix;
     /* 13, 14 occupied by NormalMatrix */
     /* 15 used by TextureOffset */
@@ -0,0 +1,226 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "InstanceBatcherGL.h"
+
+#include <unordered_map>
+#include <Corrade/Containers/GrowableArray.h>
+
+#include "Magnum/GL/Buffer.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/Mesh.h"
+
+namespace Magnum { namespace Shaders {
+
+namespace {
+
+struct BatchKey {
+    GL::AbstractShaderProgram* shader;
+    GL::Mesh* mesh;
+    UnsignedInt material;
+
+    bool operator==(const BatchKey& other) const {
+        return shader == other.shader && mesh == other.mesh && material == other.material;
+    }
+};
+
+struct BatchKeyHash {
+    std::size_t operator()(const BatchKey& key) const {
+        std::size_t hash = std::hash<void*>{}(key.shader);
+        hash ^= std::hash<void*>{}(key.mesh) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        hash ^= std::hash<UnsignedInt>{}(key.material) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        return hash;
+    }
+};
+
+struct Batch {
+    GL::AbstractShaderProgram* shader;
+    GL::Mesh* mesh;
+    UnsignedInt material;
+    bool phong;
+    UnsignedInt count;
+    /* Filled during flush() */
+    UnsignedInt offset;
+};
+
+}
+
+struct InstanceBatcherGL::State {
+    explicit State(GL::Buffer&& buffer): buffer{std::move(buffer)} {}
+
+    GL::Buffer buffer;
+    MaterialCallback materialCallback{};
+    void* materialCallbackUserData{};
+
+    std::unordered_map<BatchKey, UnsignedInt, BatchKeyHash> batchIds;
+    Containers::Array<Batch> batches;
+    /* Instances in the order they were added, together with the batch they
+       belong to. Sorted by batch into instancesSorted during flush(). */
+    Containers::Array<Instance> instances;
+    Containers::Array<UnsignedInt> instanceBatches;
+    Containers::Array<Instance> instancesSorted;
+};
+
+InstanceBatcherGL::InstanceBatcherGL(): _state{InPlaceInit, GL::Buffer{GL::Buffer::TargetHint::Array}} {}
+
+InstanceBatcherGL::InstanceBatcherGL(NoCreateT): _state{InPlaceInit, GL::Buffer{NoCreate}} {}
+
+InstanceBatcherGL::InstanceBatcherGL(InstanceBatcherGL&&) noexcept = default;
+
+InstanceBatcherGL::~InstanceBatcherGL() = default;
+
+InstanceBatcherGL& InstanceBatcherGL::operator=(InstanceBatcherGL&&) noexcept = default;
+
+GL::Buffer& InstanceBatcherGL::instanceBuffer() { return _state->buffer; }
+
+InstanceBatcherGL& InstanceBatcherGL::setupMesh(GL::Mesh& mesh) {
+    CORRADE_ASSERT(_state->buffer.id(),
+        "Shaders::InstanceBatcherGL::setupMesh(): the batcher was constructed with NoCreate", *this);
+    mesh.addVertexBufferInstanced(_state->buffer, 1, 0,
+        PhongGL::TransformationMatrix{},
+        PhongGL::NormalMatrix{});
+    return *this;
+}
+
+InstanceBatcherGL& InstanceBatcherGL::setMaterialCallback(const MaterialCallback callback, void* const userData) {
+    _state->materialCallback = callback;
+    _state->materialCallbackUserData = userData;
+    return *this;
+}
+
+std::size_t InstanceBatcherGL::instanceCount() const {
+    return _state->instances.size();
+}
+
+std::size_t InstanceBatcherGL::batchCount() const {
+    return _state->batches.size();
+}
+
+InstanceBatcherGL& InstanceBatcherGL::add(PhongGL& shader, GL::Mesh& mesh, const UnsignedInt material, const Matrix4& transformationMatrix) {
+    CORRADE_ASSERT(shader.flags() & PhongGL::Flag::InstancedTransformation,
+        "Shaders::InstanceBatcherGL::add(): the shader wasn't created with instanced transformation", *this);
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(shader.flags() & PhongGL::Flag::UniformBuffers),
+        "Shaders::InstanceBatcherGL::add(): shaders with uniform buffers are not supported", *this);
+    #endif
+    addInternal(shader, true, mesh, material, transformationMatrix);
+    return *this;
+}
+
+InstanceBatcherGL& InstanceBatcherGL::add(FlatGL3D& shader, GL::Mesh& mesh, const UnsignedInt material, const Matrix4& transformationMatrix) {
+    CORRADE_ASSERT(shader.flags() & FlatGL3D::Flag::InstancedTransformation,
+        "Shaders::InstanceBatcherGL::add(): the shader wasn't created with instanced transformation", *this);
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(shader.flags() & FlatGL3D::Flag::UniformBuffers),
+        "Shaders::InstanceBatcherGL::add(): shaders with uniform buffers are not supported", *this);
+    #endif
+    addInternal(shader, false, mesh, material, transformationMatrix);
+    return *this;
+}
+
+void InstanceBatcherGL::addInternal(GL::AbstractShaderProgram& shader, const bool phong, GL::Mesh& mesh, const UnsignedInt material, const Matrix4& transformationMatrix) {
+    State& state = *_state;
+
+    /* Find the batch or create a new one if this combination wasn't seen
+       yet */
+    const auto inserted = state.batchIds.emplace(BatchKey{&shader, &mesh, material}, UnsignedInt(state.batches.size()));
+    if(inserted.second)
+        arrayAppend(state.batches, Batch{&shader, &mesh, material, phong, 0, 0});
+    const UnsignedInt batch = inserted.first->second;
+
+    ++state.batches[batch].count;
+    arrayAppend(state.instances, Instance{transformationMatrix, transformationMatrix.normalMatrix()});
+    arrayAppend(state.instanceBatches, batch);
+}
+
+UnsignedInt InstanceBatcherGL::flush(const Matrix4& projectionMatrix) {
+    State& state = *_state;
+    CORRADE_ASSERT(state.buffer.id(),
+        "Shaders::InstanceBatcherGL::flush(): the batcher was constructed with NoCreate", {});
+
+    if(state.batches.isEmpty()) return 0;
+
+    /* Calculate offset of each batch and sort the instances by batch. The
+       counting sort keeps the order in which instances were added. */
+    UnsignedInt offset = 0;
+    for(Batch& batch: state.batches) {
+        batch.offset = offset;
+        offset += batch.count;
+    }
+    arrayResize(state.instancesSorted, NoInit, state.instances.size());
+    for(std::size_t i = 0; i != state.instances.size(); ++i)
+        state.instancesSorted[state.batches[state.instanceBatches[i]].offset++] = state.instances[i];
+
+    /* With base instance support upload everything at once, otherwise each
+       batch gets reuploaded right before its draw */
+    #ifndef MAGNUM_TARGET_GLES
+    const bool baseInstance = GL::Context::current().isExtensionSupported<GL::Extensions::ARB::base_instance>();
+    if(baseInstance)
+        state.buffer.setData(state.instancesSorted, GL::BufferUsage::StreamDraw);
+    #endif
+
+    for(const Batch& batch: state.batches) {
+        /* The offset got shifted to the end of the batch by the sort above */
+        const UnsignedInt begin = batch.offset - batch.count;
+
+        if(batch.phong) static_cast<PhongGL&>(*batch.shader)
+            .setProjectionMatrix(projectionMatrix)
+            .setTransformationMatrix(Matrix4{})
+            .setNormalMatrix(Matrix3x3{});
+        else static_cast<FlatGL3D&>(*batch.shader)
+            .setTransformationProjectionMatrix(projectionMatrix);
+
+        if(state.materialCallback)
+            state.materialCallback(*batch.shader, batch.material, state.materialCallbackUserData);
+
+        #ifndef MAGNUM_TARGET_GLES
+        if(baseInstance)
+            batch.mesh->setBaseInstance(begin);
+        else
+        #endif
+        {
+            state.buffer.setData(state.instancesSorted.slice(begin, begin + batch.count), GL::BufferUsage::StreamDraw);
+        }
+
+        batch.mesh->setInstanceCount(Int(batch.count));
+        batch.shader->draw(*batch.mesh);
+    }
+
+    const UnsignedInt drawCount = state.batches.size();
+    clear();
+    return drawCount;
+}
+
+InstanceBatcherGL& InstanceBatcherGL::clear() {
+    State& state = *_state;
+    state.batchIds.clear();
+    arrayResize(state.batches, NoInit, 0);
+    arrayResize(state.instances, NoInit, 0);
+    arrayResize(state.instanceBatches, NoInit, 0);
+    return *this;
+}
+
+}}
@@ -0,0 +1,263 @@
+#ifndef Magnum_Shaders_InstanceBatcherGL_h
+#define Magnum_Shaders_InstanceBatcherGL_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Shaders::InstanceBatcherGL
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Shaders/FlatGL.h"
+#include "Magnum/Shaders/PhongGL.h"
+
+namespace Magnum { namespace Shaders {
+
+/**
+@brief Instanced draw batcher
+@m_since_latest
+
+Collects draws of many objects sharing the same mesh, shader and material and
+submits each such group as a single instanced draw with
+@ref PhongGL::Flag::InstancedTransformation or
+@ref FlatGL::Flag::InstancedTransformation, instead of a separate draw with
+different uniforms for every object. Useful for scenes with a lot of
+repeated objects such as vegetation or buildings, where the draw call
+overhead dominates.
+
+@section Shaders-InstanceBatcherGL-usage Usage
+
+Each mesh that's going to be drawn through the batcher has to be set up with
+@ref setupMesh() first, which attaches the batcher-owned instance buffer to
+it. Then, instead of drawing directly, call @ref add() with a shader, mesh,
+a material ID and a transformation matrix. The shaders are expected to be
+created with the @relativeref{PhongGL,Flag::InstancedTransformation} flag.
+Finally, @ref flush() uploads the collected instances and draws each group
+with a single call, calling the callback set with @ref setMaterialCallback()
+before each draw to apply uniforms and textures of given material:
+
+@snippet MagnumShaders-gl.cpp InstanceBatcherGL-usage
+
+Groups are drawn in the order in which their first instance was added, and
+instances inside a group keep the order in which they were added.
+
+@section Shaders-InstanceBatcherGL-scenegraph Use with SceneGraph
+
+The batcher fits into the @ref SceneGraph drawing pipeline by having the
+@ref SceneGraph::Drawable::draw() implementation call @ref add() with the
+camera-relative transformation instead of drawing. The
+@ref SceneGraph::Camera::draw() then calculates all transformations as usual
+and a subsequent @ref flush() with the camera projection matrix submits the
+batches:
+
+@snippet MagnumSceneGraph-gl.cpp InstanceBatcherGL-scenegraph
+
+@section Shaders-InstanceBatcherGL-limitations Limitations
+
+Each instance consists of a @ref Instance::transformationMatrix "transformation"
+and a @ref Instance::normalMatrix "normal matrix", matching the
+@ref PhongGL::TransformationMatrix and @ref PhongGL::NormalMatrix attributes.
+The normal matrix is ignored by @ref FlatGL3D. Per-instance colors or texture
+offsets are not supported, objects that differ in those have to use different
+material IDs. The shaders are expected to not have
+@relativeref{PhongGL,Flag::UniformBuffers} enabled, the @ref flush() sets the
+projection, transformation and normal matrix uniforms and leaves the rest to
+the material callback. The batcher also overwrites the instance count and
+base instance of the meshes it draws.
+
+On desktop GL with @gl_extension{ARB,base_instance} available, all instances
+are uploaded to the buffer at once and each group is drawn with a different
+base instance. Otherwise the buffer is reuploaded with instances of each
+group before drawing it.
+*/
+class MAGNUM_SHADERS_EXPORT InstanceBatcherGL {
+    public:
+        /**
+         * @brief Instance data
+         *
+         * Layout of a single instance in @ref instanceBuffer().
+         */
+        struct Instance {
+            /** @brief Transformation matrix */
+            Matrix4 transformationMatrix;
+
+            /** @brief Normal matrix */
+            Matrix3x3 normalMatrix;
+        };
+
+        /**
+         * @brief Material callback
+         *
+         * Receives the shader, the material ID passed to @ref add() and the
+         * user data pointer passed to @ref setMaterialCallback(). The shader
+         * is either a @ref PhongGL or a @ref FlatGL3D, depending on what was
+         * passed to @ref add().
+         */
+        typedef void(*MaterialCallback)(GL::AbstractShaderProgram&, UnsignedInt, void*);
+
+        /**
+         * @brief Constructor
+         *
+         * Creates the instance buffer.
+         */
+        explicit InstanceBatcherGL();
+
+        /**
+         * @brief Construct without creating the instance buffer
+         *
+         * Draws can be still added to it, but @ref setupMesh() and
+         * @ref flush() can't be called. This function can be safely used for
+         * constructing (and later destructing) objects even without any
+         * OpenGL context being active.
+         */
+        explicit InstanceBatcherGL(NoCreateT);
+
+        /** @brief Copying is not allowed */
+        InstanceBatcherGL(const InstanceBatcherGL&) = delete;
+
+        /** @brief Move constructor */
+        InstanceBatcherGL(InstanceBatcherGL&&) noexcept;
+
+        ~InstanceBatcherGL();
+
+        /** @brief Copying is not allowed */
+        InstanceBatcherGL& operator=(const InstanceBatcherGL&) = delete;
+
+        /** @brief Move assignment */
+        InstanceBatcherGL& operator=(InstanceBatcherGL&&) noexcept;
+
+        /**
+         * @brief Instance buffer
+         *
+         * Contains @ref Instance items uploaded by the last @ref flush().
+         */
+        GL::Buffer& instanceBuffer();
+
+        /**
+         * @brief Set up a mesh for instanced drawing
+         * @return Reference to self (for method chaining)
+         *
+         * Attaches @ref instanceBuffer() to @p mesh with the
+         * @ref PhongGL::TransformationMatrix and @ref PhongGL::NormalMatrix
+         * attributes. Has to be called exactly once for each mesh that's
+         * passed to @ref add(). The batcher is expected to outlive the mesh.
+         */
+        InstanceBatcherGL& setupMesh(GL::Mesh& mesh);
+
+        /**
+         * @brief Set material callback
+         * @return Reference to self (for method chaining)
+         *
+         * The @p callback is called during @ref flush() before drawing each
+         * group, with the group shader, its material ID and @p userData.
+         * Default is @cpp nullptr @ce, i.e. no callback.
+         */
+        InstanceBatcherGL& setMaterialCallback(MaterialCallback callback, void* userData = nullptr);
+
+        /** @brief Count of draws added since the last @ref flush() */
+        std::size_t instanceCount() const;
+
+        /**
+         * @brief Count of groups added since the last @ref flush()
+         *
+         * Equal to count of draw calls the next @ref flush() will submit.
+         */
+        std::size_t batchCount() const;
+
+        /**
+         * @brief Add a Phong draw
+         * @param shader                Shader to draw with
+         * @param mesh                  Mesh to draw
+         * @param material              Material ID passed to the
+         *      @ref setMaterialCallback() "material callback"
+         * @param transformationMatrix  Transformation matrix, in camera space
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @p shader was created with
+         * @ref PhongGL::Flag::InstancedTransformation and without
+         * @ref PhongGL::Flag::UniformBuffers. The @p mesh is expected to be
+         * set up with @ref setupMesh(). The normal matrix is calculated from
+         * @p transformationMatrix using @ref Matrix4::normalMatrix(). The
+         * shader and the mesh are expected to stay alive until the next
+         * @ref flush().
+         */
+        InstanceBatcherGL& add(PhongGL& shader, GL::Mesh& mesh, UnsignedInt material, const Matrix4& transformationMatrix);
+
+        /**
+         * @brief Add a flat draw
+         * @param shader                Shader to draw with
+         * @param mesh                  Mesh to draw
+         * @param material              Material ID passed to the
+         *      @ref setMaterialCallback() "material callback"
+         * @param transformationMatrix  Transformation matrix, in camera space
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @p shader was created with
+         * @ref FlatGL::Flag::InstancedTransformation and without
+         * @ref FlatGL::Flag::UniformBuffers. The @p mesh is expected to be
+         * set up with @ref setupMesh(). The shader and the mesh are expected
+         * to stay alive until the next @ref flush().
+         */
+        InstanceBatcherGL& add(FlatGL3D& shader, GL::Mesh& mesh, UnsignedInt material, const Matrix4& transformationMatrix);
+
+        /**
+         * @brief Draw all batches
+         * @return Count of draw calls submitted
+         *
+         * Uploads the instances, and for each group sets
+         * @ref PhongGL::setProjectionMatrix() to @p projectionMatrix and
+         * @ref PhongGL::setTransformationMatrix() and
+         * @relativeref{PhongGL,setNormalMatrix()} to an identity, or
+         * @ref FlatGL::setTransformationProjectionMatrix() to
+         * @p projectionMatrix, calls the material callback and draws the
+         * mesh with an instance count equal to size of the group. Clears all
+         * added draws afterwards.
+         */
+        UnsignedInt flush(const Matrix4& projectionMatrix);
+
+        /**
+         * @brief Clear all added draws
+         * @return Reference to self (for method chaining)
+         *
+         * Discards everything added since the last @ref flush() without
+         * drawing anything.
+         */
+        InstanceBatcherGL& clear();
+
+    private:
+        struct State;
+
+        MAGNUM_SHADERS_LOCAL void addInternal(GL::AbstractShaderProgram& shader, bool phong, GL::Mesh& mesh, UnsignedInt material, const Matrix4& transformationMatrix);
+
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
@@ -0,0 +1,278 @@
+#ifndef Magnum_Shaders_InstanceCulling_h
+#define Magnum_Shaders_InstanceCulling_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Struct @ref Magnum::Shaders::InstanceCullingUniform, @ref Magnum::Shaders::InstanceCullingDrawUniform
+ * @m_since_latest
+ */
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Tags.h"
+#include "Magnum/Math/Frustum.h"
+#include "Magnum/Math/Matrix4.h"
+
+namespace Magnum { namespace Shaders {
+
+/**
+@brief Instance culling parameters
+@m_since_latest
+
+Describes the view frustum and the layout of the instance buffers used by
+@ref InstanceCullingGL.
+@see @ref InstanceCullingGL::bindInstanceCullingBuffer()
+*/
+struct InstanceCullingUniform {
+    /** @brief Construct with default parameters */
+    constexpr explicit InstanceCullingUniform(DefaultInitT = DefaultInit) noexcept: frustum{Math::IdentityInit}, projectionMatrix{Math::IdentityInit}, hierarchicalZSize{1.0f, 1.0f}, instanceStride{16}
+        #if (defined(CORRADE_TARGET_CLANG) && __clang_major__ < 4) || (defined(CORRADE_TARGET_APPLE_CLANG) && __clang_major__ < 8)
+        , _pad0{} /* Otherwise it refuses to constexpr, on 3.8 at least */
+        #endif
+        {}
+    /** @brief Construct without initializing the contents */
+    explicit InstanceCullingUniform(NoInitT) noexcept: frustum{NoInit}, projectionMatrix{NoInit}, hierarchicalZSize{NoInit} {}
+
+    /** @{
+     * @name Convenience setters
+     *
+     * Provided to allow the use of method chaining for populating a structure
+     * in a single expression, otherwise equivalent to accessing the fields
+     * directly. Also guaranteed to provide backwards compatibility when
+     * packing of the actual fields changes.
+     */
+
+    /**
+     * @brief Set the @ref frustum field
+     * @return Reference to self (for method chaining)
+     */
+    InstanceCullingUniform& setFrustum(const Frustum& frustum) {
+        this->frustum = frustum;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref projectionMatrix field
+     * @return Reference to self (for method chaining)
+     */
+    InstanceCullingUniform& setProjectionMatrix(const Matrix4& matrix) {
+        projectionMatrix = matrix;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref hierarchicalZSize field
+     * @return Reference to self (for method chaining)
+     */
+    InstanceCullingUniform& setHierarchicalZSize(const Vector2& size) {
+        hierarchicalZSize = size;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref instanceStride field
+     * @return Reference to self (for method chaining)
+     */
+    InstanceCullingUniform& setInstanceStride(UnsignedInt stride) {
+        instanceStride = stride;
+        return *this;
+    }
+
+    /**
+     * @}
+     */
+
+    /**
+     * @brief View frustum
+     *
+     * Frustum in the same space as the instance transformations, usually
+     * calculated with @ref Frustum::fromMatrix() from a product of the
+     * projection and camera matrix. The planes don't need to be normalized.
+     * Default value is an identity frustum, i.e. a cube from
+     * @f$ (-1, -1, -1) @f$ to @f$ (1, 1, 1) @f$.
+     */
+    Frustum frustum;
+
+    /**
+     * @brief Projection matrix
+     *
+     * Combined projection and camera matrix used to project bounding spheres
+     * for the hierarchical Z test. Used only if
+     * @ref InstanceCullingGL::Flag::HierarchicalZ is enabled. Default value
+     * is an identity matrix.
+     */
+    Matrix4 projectionMatrix;
+
+    /**
+     * @brief Hierarchical Z pyramid size
+     *
+     * Size of the base level of the texture bound with
+     * @ref InstanceCullingGL::bindHierarchicalZTexture(), used to pick a mip
+     * level matching the projected size of a bounding sphere. Used only if
+     * @ref InstanceCullingGL::Flag::HierarchicalZ is enabled. Default value
+     * is @cpp {1.0f, 1.0f} @ce.
+     */
+    Vector2 hierarchicalZSize;
+
+    /**
+     * @brief Instance stride
+     *
+     * Size of a single instance record in the input and output instance
+     * buffers, in multiples of four bytes. Expected to be at least
+     * @cpp 16 @ce, as the first sixteen values are treated as a column-major
+     * transformation matrix. Default value is @cpp 16 @ce.
+     */
+    UnsignedInt instanceStride;
+
+    /* warning: Member __pad0__ is not documented. FFS DOXYGEN WHY DO YOU THINK
+       I MADE THOSE UNNAMED, YOU DUMB FOOL */
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    Int
+        #if (defined(CORRADE_TARGET_CLANG) && __clang_major__ < 4) || (defined(CORRADE_TARGET_APPLE_CLANG) && __clang_major__ < 8)
+        _pad0 /* Otherwise it refuses to constexpr, on 3.8 at least */
+        #endif
+        :32;
+    #endif
+};
+
+/**
+@brief Per-draw instance culling parameters
+@m_since_latest
+
+Describes a single batch of instances of the same mesh processed by
+@ref InstanceCullingGL. Instances visible from the
+@ref InstanceCullingUniform::frustum are copied to the output instance buffer
+starting at @ref outputOffset and their count is written into an indirect draw
+command at @ref commandOffset.
+@see @ref InstanceCullingGL::bindDrawBuffer()
+*/
+struct InstanceCullingDrawUniform {
+    /** @brief Construct with default parameters */
+    constexpr explicit InstanceCullingDrawUniform(DefaultInitT = DefaultInit) noexcept: boundingSphere{0.0f, 0.0f, 0.0f, 1.0f}, instanceOffset{0}, instanceCount{0}, outputOffset{0}, commandOffset{0} {}
+    /** @brief Construct without initializing the contents */
+    explicit InstanceCullingDrawUniform(NoInitT) noexcept: boundingSphere{NoInit} {}
+
+    /** @{
+     * @name Convenience setters
+     *
+     * Provided to allow the use of method chaining for populating a structure
+     * in a single expression, otherwise equivalent to accessing the fields
+     * directly. Also guaranteed to provide backwards compatibility when
+     * packing of the actual fields changes.
+     */
+
+    /**
+     * @brief Set the @ref boundingSphere field
+     * @return Reference to self (for method chaining)
+     *
+     * The XYZ components are filled with @p center, W with @p radius.
+     */
+    InstanceCullingDrawUniform& setBoundingSphere(const Vector3& center, Float radius) {
+        boundingSphere = {center, radius};
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref instanceOffset and @ref instanceCount fields
+     * @return Reference to self (for method chaining)
+     */
+    InstanceCullingDrawUniform& setInstanceRange(UnsignedInt offset, UnsignedInt count) {
+        instanceOffset = offset;
+        instanceCount = count;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref outputOffset field
+     * @return Reference to self (for method chaining)
+     */
+    InstanceCullingDrawUniform& setOutputOffset(UnsignedInt offset) {
+        outputOffset = offset;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref commandOffset field
+     * @return Reference to self (for method chaining)
+     */
+    InstanceCullingDrawUniform& setCommandOffset(UnsignedInt offset) {
+        commandOffset = offset;
+        return *this;
+    }
+
+    /**
+     * @}
+     */
+
+    /**
+     * @brief Bounding sphere
+     *
+     * Center of the mesh bounding sphere in the XYZ components, radius in the
+     * W component, both in model space. The sphere gets transformed by each
+     * instance transformation before testing. Default value is
+     * @cpp {0.0f, 0.0f, 0.0f, 1.0f} @ce.
+     */
+    Vector4 boundingSphere;
+
+    /**
+     * @brief Instance offset
+     *
+     * Index of the first instance record in the input instance buffer.
+     * Default value is @cpp 0 @ce.
+     */
+    UnsignedInt instanceOffset;
+
+    /**
+     * @brief Instance count
+     *
+     * Count of instance records in the input instance buffer. Default value
+     * is @cpp 0 @ce.
+     */
+    UnsignedInt instanceCount;
+
+    /**
+     * @brief Output offset
+     *
+     * Index of the first instance record in the output instance buffer.
+     * Expected to have space for at least @ref instanceCount records. Default
+     * value is @cpp 0 @ce.
+     */
+    UnsignedInt outputOffset;
+
+    /**
+     * @brief Command offset
+     *
+     * Offset of the indirect draw command in the command buffer, in multiples
+     * of four bytes. The instance count, which is the second value of both
+     * indexed and non-indexed commands, is overwritten with the count of
+     * visible instances, other values are left untouched. Default value is
+     * @cpp 0 @ce.
+     */
+    UnsignedInt commandOffset;
+};
+
+}}
+
+#endif
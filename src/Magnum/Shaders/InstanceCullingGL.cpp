@@ -0,0 +1,222 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "InstanceCullingGL.h"
+
+#include <Corrade/Containers/EnumSet.hpp>
+#include <Corrade/Containers/Reference.h>
+#include <Corrade/Utility/Resource.h>
+
+#include "Magnum/GL/Buffer.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/Renderer.h"
+#include "Magnum/GL/Texture.h"
+#include "Magnum/Math/Vector3.h"
+
+#include "Magnum/Shaders/Implementation/CreateCompatibilityShader.h"
+
+namespace Magnum { namespace Shaders {
+
+namespace {
+    enum: Int {
+        InstanceCullingBufferBinding = 0
+    };
+
+    enum: Int {
+        DrawBufferBinding = 0,
+        InputInstanceBufferBinding = 1,
+        OutputInstanceBufferBinding = 2,
+        CommandBufferBinding = 3
+    };
+
+    enum: Int {
+        HierarchicalZTextureUnit = 0
+    };
+
+    enum: Int {
+        ResetUniform = 0,
+        DrawCountUniform = 1
+    };
+
+    /* Keep in sync with GROUP_SIZE in InstanceCulling.comp */
+    constexpr UnsignedInt GroupSize = 64;
+}
+
+InstanceCullingGL::CompileState InstanceCullingGL::compile(const Flags flags) {
+    #ifndef MAGNUM_TARGET_GLES
+    MAGNUM_ASSERT_GL_VERSION_SUPPORTED(GL::Version::GL430);
+    #else
+    MAGNUM_ASSERT_GL_VERSION_SUPPORTED(GL::Version::GLES310);
+    #endif
+
+    #ifdef MAGNUM_BUILD_STATIC
+    /* Import resources on static build, if not already */
+    if(!Utility::Resource::hasGroup("MagnumShadersGL"))
+        importShaderResources();
+    #endif
+    Utility::Resource rs("MagnumShadersGL");
+
+    #ifndef MAGNUM_TARGET_GLES
+    const GL::Version version = GL::Version::GL430;
+    #else
+    const GL::Version version = GL::Version::GLES310;
+    #endif
+
+    GL::Shader comp = Implementation::createCompatibilityShader(rs, version, GL::Shader::Type::Compute);
+    comp.addSource(flags & Flag::HierarchicalZ ? "#define HIERARCHICAL_Z\n" : "")
+        .addSource(rs.getString("InstanceCulling.comp"));
+
+    InstanceCullingGL out{NoInit};
+    out._flags = flags;
+
+    /* If a matching program binary is cached, there's nothing to compile
+       or link */
+    const bool cached = out.loadCachedBinary({comp});
+    if(!cached) {
+        comp.submitCompile();
+        out.attachShader(comp);
+        out.submitLink();
+    }
+
+    return CompileState{std::move(out), std::move(comp), cached};
+}
+
+InstanceCullingGL::InstanceCullingGL(CompileState&& state): InstanceCullingGL{static_cast<InstanceCullingGL&&>(std::move(state))} {
+    #ifdef CORRADE_GRACEFUL_ASSERT
+    /* When graceful assertions fire from within compile(), we get a
+       NoCreate'd CompileState. Exiting makes it possible to test the
+       assert. */
+    if(!id()) return;
+    #endif
+
+    /* If the program was loaded from the binary cache, there's nothing to
+       check */
+    if(!state._cached) {
+        CORRADE_INTERNAL_ASSERT_OUTPUT(state._comp.checkCompile());
+        CORRADE_INTERNAL_ASSERT_OUTPUT(checkLink());
+        saveCachedBinary({state._comp});
+    }
+
+    /* All bindings and uniform locations are specified in the shader code
+       directly */
+}
+
+InstanceCullingGL::InstanceCullingGL(const Flags flags): InstanceCullingGL{compile(flags)} {}
+
+InstanceCullingGL& InstanceCullingGL::bindInstanceCullingBuffer(GL::Buffer& buffer) {
+    buffer.bind(GL::Buffer::Target::Uniform, InstanceCullingBufferBinding);
+    return *this;
+}
+
+InstanceCullingGL& InstanceCullingGL::bindInstanceCullingBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    buffer.bind(GL::Buffer::Target::Uniform, InstanceCullingBufferBinding, offset, size);
+    return *this;
+}
+
+InstanceCullingGL& InstanceCullingGL::bindDrawBuffer(GL::Buffer& buffer) {
+    buffer.bind(GL::Buffer::Target::ShaderStorage, DrawBufferBinding);
+    return *this;
+}
+
+InstanceCullingGL& InstanceCullingGL::bindDrawBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    buffer.bind(GL::Buffer::Target::ShaderStorage, DrawBufferBinding, offset, size);
+    return *this;
+}
+
+InstanceCullingGL& InstanceCullingGL::bindInputInstanceBuffer(GL::Buffer& buffer) {
+    buffer.bind(GL::Buffer::Target::ShaderStorage, InputInstanceBufferBinding);
+    return *this;
+}
+
+InstanceCullingGL& InstanceCullingGL::bindInputInstanceBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    buffer.bind(GL::Buffer::Target::ShaderStorage, InputInstanceBufferBinding, offset, size);
+    return *this;
+}
+
+InstanceCullingGL& InstanceCullingGL::bindOutputInstanceBuffer(GL::Buffer& buffer) {
+    buffer.bind(GL::Buffer::Target::ShaderStorage, OutputInstanceBufferBinding);
+    return *this;
+}
+
+InstanceCullingGL& InstanceCullingGL::bindOutputInstanceBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    buffer.bind(GL::Buffer::Target::ShaderStorage, OutputInstanceBufferBinding, offset, size);
+    return *this;
+}
+
+InstanceCullingGL& InstanceCullingGL::bindCommandBuffer(GL::Buffer& buffer) {
+    buffer.bind(GL::Buffer::Target::ShaderStorage, CommandBufferBinding);
+    return *this;
+}
+
+InstanceCullingGL& InstanceCullingGL::bindCommandBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    buffer.bind(GL::Buffer::Target::ShaderStorage, CommandBufferBinding, offset, size);
+    return *this;
+}
+
+InstanceCullingGL& InstanceCullingGL::bindHierarchicalZTexture(GL::Texture2D& texture) {
+    CORRADE_ASSERT(_flags & Flag::HierarchicalZ,
+        "Shaders::InstanceCullingGL::bindHierarchicalZTexture(): the shader was not created with hierarchical Z enabled", *this);
+    texture.bind(HierarchicalZTextureUnit);
+    return *this;
+}
+
+InstanceCullingGL& InstanceCullingGL::cull(const UnsignedInt drawCount, const UnsignedInt maxInstanceCount) {
+    CORRADE_ASSERT(drawCount && maxInstanceCount,
+        "Shaders::InstanceCullingGL::cull(): expected non-zero draw and instance count but got" << drawCount << "and" << maxInstanceCount, *this);
+
+    /* Reset the instance counts first, then let the culling pass increment
+       them. The second pass needs to see the zeros, hence the barrier. */
+    setUniform(DrawCountUniform, drawCount);
+    setUniform(ResetUniform, 1);
+    dispatchCompute({(drawCount + GroupSize - 1)/GroupSize, 1, 1});
+    GL::Renderer::setMemoryBarrier(GL::Renderer::MemoryBarrier::ShaderStorage);
+
+    setUniform(ResetUniform, 0);
+    dispatchCompute({(maxInstanceCount + GroupSize - 1)/GroupSize, drawCount, 1});
+    return *this;
+}
+
+Debug& operator<<(Debug& debug, const InstanceCullingGL::Flag value) {
+    debug << "Shaders::InstanceCullingGL::Flag" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(v) case InstanceCullingGL::Flag::v: return debug << "::" #v;
+        _c(HierarchicalZ)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+Debug& operator<<(Debug& debug, const InstanceCullingGL::Flags value) {
+    return Containers::enumSetDebugOutput(debug, value, "Shaders::InstanceCullingGL::Flags{}", {
+        InstanceCullingGL::Flag::HierarchicalZ
+    });
+}
+
+}}
@@ -0,0 +1,332 @@
+#ifndef Magnum_Shaders_InstanceCullingGL_h
+#define Magnum_Shaders_InstanceCullingGL_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+/** @file
+ * @brief Class @ref Magnum::Shaders::InstanceCullingGL
+ * @m_since_latest
+ */
+#endif
+
+#include <Corrade/Containers/EnumSet.h>
+
+#include "Magnum/GL/AbstractShaderProgram.h"
+#include "Magnum/GL/Shader.h"
+#include "Magnum/Shaders/visibility.h"
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+namespace Magnum { namespace Shaders {
+
+/**
+@brief GPU instance culling OpenGL compute shader
+@m_since_latest
+
+Companion to @ref PhongGL::Flag::InstancedTransformation and
+@ref FlatGL::Flag::InstancedTransformation for scenes with a large amount of
+instances, most of which are not visible at any given time. Tests a bounding
+sphere of each instance against the view frustum and optionally a hierarchical
+Z pyramid and compacts the visible instances into an output buffer together
+with writing their count into an indirect draw command, without any
+per-instance work or a round trip done on the CPU.
+
+@section Shaders-InstanceCullingGL-usage Usage
+
+The shader takes a single @ref InstanceCullingUniform describing the view
+frustum and the instance record layout and a list of
+@ref InstanceCullingDrawUniform items, each describing one batch of instances
+of the same mesh. The instance buffers contain tightly packed records of
+@ref InstanceCullingUniform::instanceStride four-byte values, the first
+sixteen of which are the column-major instance transformation matrix. The rest
+of the record, such as a normal matrix or a texture offset, is copied to the
+output verbatim. The layout thus directly matches what's consumed by
+@ref PhongGL::TransformationMatrix and the other instanced attributes.
+
+For each @ref InstanceCullingDrawUniform the shader overwrites the instance
+count of an indirect draw command at
+@ref InstanceCullingDrawUniform::commandOffset and copies the visible instances
+to @ref InstanceCullingDrawUniform::outputOffset. The
+@cpp baseInstance @ce field of the command is left untouched --- as it's not
+available on OpenGL ES, each batch is expected to have the output buffer
+attached to its mesh at a matching offset instead. Order of the output
+instances is not deterministic.
+
+Execute the culling with @ref cull() and issue a
+@ref GL::Renderer::MemoryBarrier::VertexAttributeArray and
+@ref GL::Renderer::MemoryBarrier::Command "Command" barrier before drawing:
+
+@snippet MagnumShaders-gl.cpp InstanceCullingGL-usage
+
+@section Shaders-InstanceCullingGL-hierarchical-z Hierarchical Z culling
+
+With @ref Flag::HierarchicalZ enabled, instances that pass the frustum test
+are additionally tested against a depth pyramid bound with
+@ref bindHierarchicalZTexture(), usually built from the depth buffer of the
+previous frame using @ref DepthPyramidGL. Each level of the pyramid is expected to contain the
+*farthest* depth of the corresponding four texels in the level above, with
+depth values in the @f$ [0, 1] @f$ range and smaller values being closer to
+the camera. The bounding sphere is projected using
+@ref InstanceCullingUniform::projectionMatrix, a level where the projected
+rectangle covers at most two by two texels is picked and the instance is
+culled if its nearest depth is farther than all four texels. Instances
+crossing the near plane are always considered visible. See
+@ref Shaders-DepthPyramidGL-usage for a complete example and
+@ref Shaders-DepthPyramidGL-fallback for occlusion culling on platforms
+without compute shaders.
+
+@requires_gl43 Extensions @gl_extension{ARB,compute_shader} and
+    @gl_extension{ARB,shader_storage_buffer_object}
+@requires_gles31 Compute shaders and shader storage buffers are not available
+    in OpenGL ES 3.0 and older.
+@requires_gles Compute shaders are not available in WebGL.
+*/
+class MAGNUM_SHADERS_EXPORT InstanceCullingGL: public GL::AbstractShaderProgram {
+    public:
+        class CompileState;
+
+        /**
+         * @brief Flag
+         *
+         * @see @ref Flags, @ref flags()
+         */
+        enum class Flag: UnsignedByte {
+            /**
+             * Additionally cull instances occluded according to a
+             * hierarchical Z pyramid. See
+             * @ref Shaders-InstanceCullingGL-hierarchical-z for more
+             * information.
+             * @see @ref bindHierarchicalZTexture()
+             */
+            HierarchicalZ = 1 << 0
+        };
+
+        /**
+         * @brief Flags
+         *
+         * @see @ref flags()
+         */
+        typedef Containers::EnumSet<Flag> Flags;
+
+        /**
+         * @brief Compile asynchronously
+         *
+         * Compared to @ref InstanceCullingGL(Flags) can perform an
+         * asynchronous compilation and linking. See @ref shaders-async for
+         * more information.
+         * @see @ref InstanceCullingGL(CompileState&&)
+         */
+        static CompileState compile(Flags flags = {});
+
+        /**
+         * @brief Constructor
+         * @param flags     Flags
+         */
+        explicit InstanceCullingGL(Flags flags = {});
+
+        /**
+         * @brief Finalize an asynchronous compilation
+         *
+         * Takes an asynchronous compilation state returned by @ref compile()
+         * and forms a ready-to-use shader object. See @ref shaders-async for
+         * more information.
+         */
+        explicit InstanceCullingGL(CompileState&& state);
+
+        /**
+         * @brief Construct without creating the underlying OpenGL object
+         *
+         * The constructed instance is equivalent to a moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         *
+         * This function can be safely used for constructing (and later
+         * destructing) objects even without any OpenGL context being active.
+         * However note that this is a low-level and a potentially dangerous
+         * API, see the documentation of @ref NoCreate for alternatives.
+         */
+        explicit InstanceCullingGL(NoCreateT) noexcept: AbstractShaderProgram{NoCreate} {}
+
+        /** @brief Copying is not allowed */
+        InstanceCullingGL(const InstanceCullingGL&) = delete;
+
+        /** @brief Move constructor */
+        InstanceCullingGL(InstanceCullingGL&&) noexcept = default;
+
+        /** @brief Copying is not allowed */
+        InstanceCullingGL& operator=(const InstanceCullingGL&) = delete;
+
+        /** @brief Move assignment */
+        InstanceCullingGL& operator=(InstanceCullingGL&&) noexcept = default;
+
+        /** @brief Flags */
+        Flags flags() const { return _flags; }
+
+        /** @{
+         * @name Buffer and texture binding
+         */
+
+        /**
+         * @brief Bind an instance culling uniform buffer
+         * @return Reference to self (for method chaining)
+         *
+         * The buffer is expected to contain a single
+         * @ref InstanceCullingUniform.
+         */
+        InstanceCullingGL& bindInstanceCullingBuffer(GL::Buffer& buffer);
+        /** @overload */
+        InstanceCullingGL& bindInstanceCullingBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Bind a draw storage buffer
+         * @return Reference to self (for method chaining)
+         *
+         * The buffer is expected to contain at least as many
+         * @ref InstanceCullingDrawUniform items as is the draw count passed
+         * to @ref cull().
+         */
+        InstanceCullingGL& bindDrawBuffer(GL::Buffer& buffer);
+        /** @overload */
+        InstanceCullingGL& bindDrawBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Bind an input instance storage buffer
+         * @return Reference to self (for method chaining)
+         *
+         * The buffer is expected to contain instance records referenced by
+         * @ref InstanceCullingDrawUniform::instanceOffset and
+         * @ref InstanceCullingDrawUniform::instanceCount "instanceCount".
+         * See @ref Shaders-InstanceCullingGL-usage for more information.
+         */
+        InstanceCullingGL& bindInputInstanceBuffer(GL::Buffer& buffer);
+        /** @overload */
+        InstanceCullingGL& bindInputInstanceBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Bind an output instance storage buffer
+         * @return Reference to self (for method chaining)
+         *
+         * The buffer is expected to have space for instance records
+         * referenced by @ref InstanceCullingDrawUniform::outputOffset and
+         * @ref InstanceCullingDrawUniform::instanceCount "instanceCount". See
+         * @ref Shaders-InstanceCullingGL-usage for more information.
+         */
+        InstanceCullingGL& bindOutputInstanceBuffer(GL::Buffer& buffer);
+        /** @overload */
+        InstanceCullingGL& bindOutputInstanceBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Bind an indirect draw command storage buffer
+         * @return Reference to self (for method chaining)
+         *
+         * The buffer is expected to contain indirect draw commands at
+         * locations referenced by
+         * @ref InstanceCullingDrawUniform::commandOffset. The same buffer is
+         * then passed to @ref GL::AbstractShaderProgram::drawIndirect().
+         */
+        InstanceCullingGL& bindCommandBuffer(GL::Buffer& buffer);
+        /** @overload */
+        InstanceCullingGL& bindCommandBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Bind a hierarchical Z texture
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that the shader was created with @ref Flag::HierarchicalZ
+         * enabled. The texture is expected to have a single-channel
+         * floating-point format, a complete mip chain and
+         * @ref GL::SamplerFilter::Nearest together with
+         * @ref GL::SamplerMipmap::Nearest filtering. See
+         * @ref Shaders-InstanceCullingGL-hierarchical-z for more information.
+         */
+        InstanceCullingGL& bindHierarchicalZTexture(GL::Texture2D& texture);
+
+        /**
+         * @}
+         */
+
+        /**
+         * @brief Cull instances
+         * @param drawCount         Count of @ref InstanceCullingDrawUniform
+         *      items to process
+         * @param maxInstanceCount  Max of
+         *      @ref InstanceCullingDrawUniform::instanceCount across all
+         *      processed items
+         * @return Reference to self (for method chaining)
+         *
+         * First resets instance counts of all referenced indirect draw
+         * commands to zero and then dispatches enough work groups to cover
+         * @p maxInstanceCount instances for each of the @p drawCount draws.
+         * Both values are expected to be non-zero.
+         * @see @ref GL::Renderer::setMemoryBarrier()
+         */
+        InstanceCullingGL& cull(UnsignedInt drawCount, UnsignedInt maxInstanceCount);
+
+    private:
+        /* Creates the GL shader program object but does nothing else.
+           Internal, used by compile(). */
+        explicit InstanceCullingGL(NoInitT) {}
+
+        /* Prevent accidentally calling irrelevant functions */
+        using GL::AbstractShaderProgram::draw;
+        #ifndef MAGNUM_TARGET_GLES
+        using GL::AbstractShaderProgram::drawTransformFeedback;
+        #endif
+
+        Flags _flags;
+};
+
+/**
+@brief Asynchronous compilation state
+@m_since_latest
+
+Returned by @ref compile(). See @ref shaders-async for more information.
+*/
+class InstanceCullingGL::CompileState: public InstanceCullingGL {
+    /* Everything deliberately private except for the inheritance */
+    friend class InstanceCullingGL;
+
+    explicit CompileState(NoCreateT): InstanceCullingGL{NoCreate}, _comp{NoCreate} {}
+
+    explicit CompileState(InstanceCullingGL&& shader, GL::Shader&& comp, bool cached): InstanceCullingGL{std::move(shader)}, _comp{std::move(comp)}, _cached{cached} {}
+
+    GL::Shader _comp;
+    bool _cached;
+};
+
+/** @debugoperatorclassenum{InstanceCullingGL,InstanceCullingGL::Flag} */
+MAGNUM_SHADERS_EXPORT Debug& operator<<(Debug& debug, InstanceCullingGL::Flag value);
+
+/** @debugoperatorclassenum{InstanceCullingGL,InstanceCullingGL::Flags} */
+MAGNUM_SHADERS_EXPORT Debug& operator<<(Debug& debug, InstanceCullingGL::Flags value);
+
+CORRADE_ENUMSET_OPERATORS(InstanceCullingGL::Flags)
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 and WebGL build
+#endif
+
+#endif
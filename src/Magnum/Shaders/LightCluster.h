@@ -0,0 +1,168 @@
+#ifndef Magnum_Shaders_LightCluster_h
+#define Magnum_Shaders_LightCluster_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Struct @ref Magnum::Shaders::LightClusterUniform
+ * @m_since_latest
+ */
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Tags.h"
+#include "Magnum/Math/Matrix4.h"
+
+namespace Magnum { namespace Shaders {
+
+/**
+@brief Light cluster parameters
+@m_since_latest
+
+Describes the froxel grid used by @ref LightClusterGL to assign lights to
+clusters and by @ref PhongGL with @ref PhongGL::Flag::LightClusters to look up
+the cluster a fragment belongs to. The grid is uniformly subdivided in screen
+space and exponentially along the view depth between @ref near and @ref far.
+@see @ref LightClusterGL::bindLightClusterBuffer(),
+    @ref PhongGL::bindLightClusterBuffer()
+*/
+struct LightClusterUniform {
+    /** @brief Construct with default parameters */
+    constexpr explicit LightClusterUniform(DefaultInitT = DefaultInit) noexcept: inverseProjectionMatrix{Math::IdentityInit}, clusterCount{16, 9, 24}, lightCount{0}, viewportSize{1.0f, 1.0f}, near{0.01f}, far{100.0f} {}
+    /** @brief Construct without initializing the contents */
+    explicit LightClusterUniform(NoInitT) noexcept: inverseProjectionMatrix{NoInit}, clusterCount{NoInit}, viewportSize{NoInit} {}
+
+    /** @{
+     * @name Convenience setters
+     *
+     * Provided to allow the use of method chaining for populating a structure
+     * in a single expression, otherwise equivalent to accessing the fields
+     * directly. Also guaranteed to provide backwards compatibility when
+     * packing of the actual fields changes.
+     */
+
+    /**
+     * @brief Set the @ref inverseProjectionMatrix field
+     * @return Reference to self (for method chaining)
+     */
+    LightClusterUniform& setInverseProjectionMatrix(const Matrix4& matrix) {
+        inverseProjectionMatrix = matrix;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref clusterCount field
+     * @return Reference to self (for method chaining)
+     */
+    LightClusterUniform& setClusterCount(const Vector3ui& count) {
+        clusterCount = count;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref lightCount field
+     * @return Reference to self (for method chaining)
+     */
+    LightClusterUniform& setLightCount(UnsignedInt count) {
+        lightCount = count;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref viewportSize field
+     * @return Reference to self (for method chaining)
+     */
+    LightClusterUniform& setViewportSize(const Vector2& size) {
+        viewportSize = size;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref near and @ref far fields
+     * @return Reference to self (for method chaining)
+     */
+    LightClusterUniform& setDepthRange(Float near, Float far) {
+        this->near = near;
+        this->far = far;
+        return *this;
+    }
+
+    /**
+     * @}
+     */
+
+    /**
+     * @brief Inverse projection matrix
+     *
+     * Used to calculate view-space bounds of each cluster. Expected to be an
+     * inverse of a perspective projection matrix matching @ref near and
+     * @ref far. Default value is an identity matrix.
+     */
+    Matrix4 inverseProjectionMatrix;
+
+    /**
+     * @brief Cluster count
+     *
+     * Count of clusters along the horizontal and vertical screen axis and
+     * along the view depth. Default value is @cpp {16, 9, 24} @ce.
+     */
+    Vector3ui clusterCount;
+
+    /**
+     * @brief Light count
+     *
+     * Count of @ref PhongLightUniform items in the buffer bound with
+     * @ref LightClusterGL::bindLightBuffer(). Not used by @ref PhongGL.
+     * Default value is @cpp 0 @ce.
+     */
+    UnsignedInt lightCount;
+
+    /**
+     * @brief Viewport size
+     *
+     * Used to map fragment coordinates to clusters. Default value is
+     * @cpp {1.0f, 1.0f} @ce.
+     */
+    Vector2 viewportSize;
+
+    /**
+     * @brief Near plane distance
+     *
+     * Positive distance of the near clipping plane. Default value is
+     * @cpp 0.01f @ce.
+     */
+    Float near;
+
+    /**
+     * @brief Far plane distance
+     *
+     * Positive distance of the far clipping plane. Default value is
+     * @cpp 100.0f @ce.
+     */
+    Float far;
+};
+
+}}
+
+#endif
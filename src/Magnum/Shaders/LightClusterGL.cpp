@@ -0,0 +1,170 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "LightClusterGL.h"
+
+#include <Corrade/Containers/Reference.h>
+#include <Corrade/Utility/FormatStl.h>
+#include <Corrade/Utility/Resource.h>
+
+#include "Magnum/GL/Buffer.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/Math/Vector3.h"
+
+#include "Magnum/Shaders/Implementation/CreateCompatibilityShader.h"
+
+namespace Magnum { namespace Shaders {
+
+namespace {
+    enum: Int {
+        /* Same as in PhongGL so the buffers can stay bound for both the
+           compute and the draw pass */
+        LightClusterBufferBinding = 7
+    };
+
+    enum: Int {
+        LightBufferBinding = 5,
+        ClusterLightRangeBufferBinding = 6,
+        ClusterLightIndexBufferBinding = 7
+    };
+
+    /* Keep in sync with GROUP_SIZE in LightCluster.comp */
+    constexpr UnsignedInt GroupSize = 64;
+}
+
+LightClusterGL::CompileState LightClusterGL::compile(const UnsignedInt maxLightsPerCluster) {
+    CORRADE_ASSERT(maxLightsPerCluster,
+        "Shaders::LightClusterGL: max lights per cluster can't be zero", CompileState{NoCreate});
+
+    #ifndef MAGNUM_TARGET_GLES
+    MAGNUM_ASSERT_GL_VERSION_SUPPORTED(GL::Version::GL430);
+    #else
+    MAGNUM_ASSERT_GL_VERSION_SUPPORTED(GL::Version::GLES310);
+    #endif
+
+    #ifdef MAGNUM_BUILD_STATIC
+    /* Import resources on static build, if not already */
+    if(!Utility::Resource::hasGroup("MagnumShadersGL"))
+        importShaderResources();
+    #endif
+    Utility::Resource rs("MagnumShadersGL");
+
+    #ifndef MAGNUM_TARGET_GLES
+    const GL::Version version = GL::Version::GL430;
+    #else
+    const GL::Version version = GL::Version::GLES310;
+    #endif
+
+    GL::Shader comp = Implementation::createCompatibilityShader(rs, version, GL::Shader::Type::Compute);
+    comp.addSource(Utility::formatString(
+            "#define MAX_LIGHTS_PER_CLUSTER {}\n",
+            maxLightsPerCluster))
+        .addSource(rs.getString("LightCluster.comp"));
+
+    LightClusterGL out{NoInit};
+    out._maxLightsPerCluster = maxLightsPerCluster;
+
+    /* If a matching program binary is cached, there's nothing to compile
+       or link */
+    const bool cached = out.loadCachedBinary({comp});
+    if(!cached) {
+        comp.submitCompile();
+        out.attachShader(comp);
+        out.submitLink();
+    }
+
+    return CompileState{std::move(out), std::move(comp), cached};
+}
+
+LightClusterGL::LightClusterGL(CompileState&& state): LightClusterGL{static_cast<LightClusterGL&&>(std::move(state))} {
+    #ifdef CORRADE_GRACEFUL_ASSERT
+    /* When graceful assertions fire from within compile(), we get a
+       NoCreate'd CompileState. Exiting makes it possible to test the
+       assert. */
+    if(!id()) return;
+    #endif
+
+    /* If the program was loaded from the binary cache, there's nothing to
+       check */
+    if(!state._cached) {
+        CORRADE_INTERNAL_ASSERT_OUTPUT(state._comp.checkCompile());
+        CORRADE_INTERNAL_ASSERT_OUTPUT(checkLink());
+        saveCachedBinary({state._comp});
+    }
+
+    /* All bindings are specified in the shader code directly */
+}
+
+LightClusterGL::LightClusterGL(const UnsignedInt maxLightsPerCluster): LightClusterGL{compile(maxLightsPerCluster)} {}
+
+LightClusterGL& LightClusterGL::bindLightClusterBuffer(GL::Buffer& buffer) {
+    buffer.bind(GL::Buffer::Target::Uniform, LightClusterBufferBinding);
+    return *this;
+}
+
+LightClusterGL& LightClusterGL::bindLightClusterBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    buffer.bind(GL::Buffer::Target::Uniform, LightClusterBufferBinding, offset, size);
+    return *this;
+}
+
+LightClusterGL& LightClusterGL::bindLightBuffer(GL::Buffer& buffer) {
+    buffer.bind(GL::Buffer::Target::ShaderStorage, LightBufferBinding);
+    return *this;
+}
+
+LightClusterGL& LightClusterGL::bindLightBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    buffer.bind(GL::Buffer::Target::ShaderStorage, LightBufferBinding, offset, size);
+    return *this;
+}
+
+LightClusterGL& LightClusterGL::bindClusterLightRangeBuffer(GL::Buffer& buffer) {
+    buffer.bind(GL::Buffer::Target::ShaderStorage, ClusterLightRangeBufferBinding);
+    return *this;
+}
+
+LightClusterGL& LightClusterGL::bindClusterLightRangeBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    buffer.bind(GL::Buffer::Target::ShaderStorage, ClusterLightRangeBufferBinding, offset, size);
+    return *this;
+}
+
+LightClusterGL& LightClusterGL::bindClusterLightIndexBuffer(GL::Buffer& buffer) {
+    buffer.bind(GL::Buffer::Target::ShaderStorage, ClusterLightIndexBufferBinding);
+    return *this;
+}
+
+LightClusterGL& LightClusterGL::bindClusterLightIndexBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    buffer.bind(GL::Buffer::Target::ShaderStorage, ClusterLightIndexBufferBinding, offset, size);
+    return *this;
+}
+
+LightClusterGL& LightClusterGL::dispatch(const Vector3ui& clusterCount) {
+    CORRADE_ASSERT(clusterCount.product(),
+        "Shaders::LightClusterGL::dispatch(): expected a non-zero cluster count but got" << Debug::packed << clusterCount, *this);
+    dispatchCompute({(clusterCount.product() + GroupSize - 1)/GroupSize, 1, 1});
+    return *this;
+}
+
+}}
@@ -0,0 +1,265 @@
+#ifndef Magnum_Shaders_LightClusterGL_h
+#define Magnum_Shaders_LightClusterGL_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+/** @file
+ * @brief Class @ref Magnum::Shaders::LightClusterGL
+ * @m_since_latest
+ */
+#endif
+
+#include "Magnum/GL/AbstractShaderProgram.h"
+#include "Magnum/GL/Shader.h"
+#include "Magnum/Shaders/visibility.h"
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+namespace Magnum { namespace Shaders {
+
+/**
+@brief Clustered light assignment OpenGL compute shader
+@m_since_latest
+
+Bins lights into a froxel grid --- a screen-space tile grid that's further
+subdivided exponentially along the view depth --- so @ref PhongGL with
+@ref PhongGL::Flag::LightClusters enabled evaluates for each fragment only the
+lights that can actually affect it. Compared to per-draw light ranges used by
+@ref PhongGL::Flag::LightCulling this scales to thousands of lights without
+any culling done on the CPU.
+
+@section Shaders-LightClusterGL-usage Usage
+
+The shader takes a @ref LightClusterUniform describing the grid and the
+camera projection and the same @ref PhongLightUniform array that's used by
+@ref PhongGL, with positions in camera space. Point lights are assigned to
+every cluster their @ref PhongLightUniform::range intersects, directional
+lights to all clusters. It produces two shader storage buffers:
+
+-   the cluster light range buffer, containing a pair of an offset and a count
+    of @ref Magnum::UnsignedInt "UnsignedInt" indices for each cluster, i.e.
+    @cpp 8 @ce bytes for each cluster,
+-   the cluster light index buffer, containing light indices for each
+    cluster, each cluster having a fixed slot for @ref maxLightsPerCluster()
+    lights, i.e. @cpp 4*maxLightsPerCluster() @ce bytes for each cluster.
+    Lights that don't fit into the slot are dropped.
+
+The same bindings are used by @ref PhongGL, so the buffers don't need to be
+rebound between the compute and the draw pass. Execute the assignment with
+@ref dispatch() every time the camera or the lights change and issue a
+@ref GL::Renderer::MemoryBarrier::ShaderStorage barrier before drawing:
+
+@snippet MagnumShaders-gl.cpp LightClusterGL-usage
+
+Note that lights with an infinite range, which is the default for
+@ref PhongLightUniform::range, affect every cluster. Finite ranges are needed
+for the culling to have any effect.
+
+The cluster bounds are calculated by unprojecting the tile corners, which is
+valid only for perspective projections.
+
+@requires_gl43 Extensions @gl_extension{ARB,compute_shader} and
+    @gl_extension{ARB,shader_storage_buffer_object}
+@requires_gles31 Compute shaders and shader storage buffers are not available
+    in OpenGL ES 3.0 and older.
+@requires_gles Compute shaders are not available in WebGL.
+*/
+class MAGNUM_SHADERS_EXPORT LightClusterGL: public GL::AbstractShaderProgram {
+    public:
+        class CompileState;
+
+        /**
+         * @brief Compile asynchronously
+         *
+         * Compared to @ref LightClusterGL(UnsignedInt) can perform an
+         * asynchronous compilation and linking. See @ref shaders-async for
+         * more information.
+         * @see @ref LightClusterGL(CompileState&&)
+         */
+        static CompileState compile(UnsignedInt maxLightsPerCluster = 128);
+
+        /**
+         * @brief Constructor
+         * @param maxLightsPerCluster   Max count of lights assigned to a
+         *      single cluster
+         *
+         * Expects that @p maxLightsPerCluster is not zero.
+         */
+        explicit LightClusterGL(UnsignedInt maxLightsPerCluster = 128);
+
+        /**
+         * @brief Finalize an asynchronous compilation
+         *
+         * Takes an asynchronous compilation state returned by @ref compile()
+         * and forms a ready-to-use shader object. See @ref shaders-async for
+         * more information.
+         */
+        explicit LightClusterGL(CompileState&& state);
+
+        /**
+         * @brief Construct without creating the underlying OpenGL object
+         *
+         * The constructed instance is equivalent to a moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         *
+         * This function can be safely used for constructing (and later
+         * destructing) objects even without any OpenGL context being active.
+         * However note that this is a low-level and a potentially dangerous
+         * API, see the documentation of @ref NoCreate for alternatives.
+         */
+        explicit LightClusterGL(NoCreateT) noexcept: AbstractShaderProgram{NoCreate} {}
+
+        /** @brief Copying is not allowed */
+        LightClusterGL(const LightClusterGL&) = delete;
+
+        /** @brief Move constructor */
+        LightClusterGL(LightClusterGL&&) noexcept = default;
+
+        /** @brief Copying is not allowed */
+        LightClusterGL& operator=(const LightClusterGL&) = delete;
+
+        /** @brief Move assignment */
+        LightClusterGL& operator=(LightClusterGL&&) noexcept = default;
+
+        /**
+         * @brief Max count of lights assigned to a single cluster
+         *
+         * Size of the per-cluster slot in the buffer bound with
+         * @ref bindClusterLightIndexBuffer().
+         */
+        UnsignedInt maxLightsPerCluster() const { return _maxLightsPerCluster; }
+
+        /** @{
+         * @name Buffer binding
+         */
+
+        /**
+         * @brief Bind a light cluster uniform buffer
+         * @return Reference to self (for method chaining)
+         *
+         * The buffer is expected to contain a single @ref LightClusterUniform.
+         * @see @ref PhongGL::bindLightClusterBuffer()
+         */
+        LightClusterGL& bindLightClusterBuffer(GL::Buffer& buffer);
+        /** @overload */
+        LightClusterGL& bindLightClusterBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Bind a light storage buffer
+         * @return Reference to self (for method chaining)
+         *
+         * The buffer is expected to contain
+         * @ref LightClusterUniform::lightCount instances of
+         * @ref PhongLightUniform.
+         * @see @ref PhongGL::bindLightBuffer()
+         */
+        LightClusterGL& bindLightBuffer(GL::Buffer& buffer);
+        /** @overload */
+        LightClusterGL& bindLightBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Bind a cluster light range storage buffer
+         * @return Reference to self (for method chaining)
+         *
+         * The buffer is expected to have space for a pair of
+         * @ref Magnum::UnsignedInt "UnsignedInt" values for each of the
+         * @ref LightClusterUniform::clusterCount clusters. See
+         * @ref Shaders-LightClusterGL-usage for more information.
+         * @see @ref PhongGL::bindClusterLightRangeBuffer()
+         */
+        LightClusterGL& bindClusterLightRangeBuffer(GL::Buffer& buffer);
+        /** @overload */
+        LightClusterGL& bindClusterLightRangeBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Bind a cluster light index storage buffer
+         * @return Reference to self (for method chaining)
+         *
+         * The buffer is expected to have space for @ref maxLightsPerCluster()
+         * @ref Magnum::UnsignedInt "UnsignedInt" values for each of the
+         * @ref LightClusterUniform::clusterCount clusters. See
+         * @ref Shaders-LightClusterGL-usage for more information.
+         * @see @ref PhongGL::bindClusterLightIndexBuffer()
+         */
+        LightClusterGL& bindClusterLightIndexBuffer(GL::Buffer& buffer);
+        /** @overload */
+        LightClusterGL& bindClusterLightIndexBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @}
+         */
+
+        /**
+         * @brief Assign lights to clusters
+         * @return Reference to self (for method chaining)
+         *
+         * Dispatches enough work groups to cover all @p clusterCount
+         * clusters. The value is expected to match
+         * @ref LightClusterUniform::clusterCount in the buffer bound with
+         * @ref bindLightClusterBuffer() and all components are expected to be
+         * non-zero.
+         * @see @ref GL::Renderer::setMemoryBarrier()
+         */
+        LightClusterGL& dispatch(const Vector3ui& clusterCount);
+
+    private:
+        /* Creates the GL shader program object but does nothing else.
+           Internal, used by compile(). */
+        explicit LightClusterGL(NoInitT) {}
+
+        /* Prevent accidentally calling irrelevant functions */
+        using GL::AbstractShaderProgram::draw;
+        #ifndef MAGNUM_TARGET_GLES
+        using GL::AbstractShaderProgram::drawTransformFeedback;
+        #endif
+
+        UnsignedInt _maxLightsPerCluster{};
+};
+
+/**
+@brief Asynchronous compilation state
+@m_since_latest
+
+Returned by @ref compile(). See @ref shaders-async for more information.
+*/
+class LightClusterGL::CompileState: public LightClusterGL {
+    /* Everything deliberately private except for the inheritance */
+    friend class LightClusterGL;
+
+    explicit CompileState(NoCreateT): LightClusterGL{NoCreate}, _comp{NoCreate} {}
+
+    explicit CompileState(LightClusterGL&& shader, GL::Shader&& comp, bool cached): LightClusterGL{std::move(shader)}, _comp{std::move(comp)}, _cached{cached} {}
+
+    GL::Shader _comp;
+    bool _cached;
+};
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 and WebGL build
+#endif
+
+#endif
@@ -382,21 +382,23 @@ MeshVisualizerGLBase& MeshVisualizerGLBase::bindObjectIdTexture(GL::Texture2DArr
 
 }
 
-MeshVisualizerGL2D::MeshVisualizerGL2D(const Flags flags
+MeshVisualizerGL2D::CompileState MeshVisualizerGL2D::compile(const Flags flags
     #ifndef MAGNUM_TARGET_GLES2
     , const UnsignedInt materialCount, const UnsignedInt drawCount
     #endif
-): Implementation::MeshVisualizerGLBase{Implementation::MeshVisualizerGLBase::FlagBase(UnsignedInt(flags))
-    #ifndef MAGNUM_TARGET_GLES2
-    , materialCount, drawCount
-    #endif
-} {
+) {
+    MeshVisualizerGL2D out{NoInit, flags
+        #ifndef MAGNUM_TARGET_GLES2
+        , materialCount, drawCount
+        #endif
+    };
+
     #ifndef MAGNUM_TARGET_GLES2
     CORRADE_ASSERT(flags & ((Flag::Wireframe|Flag::ObjectId|Flag::VertexId|Flag::PrimitiveIdFromVertexId) & ~Flag::NoGeometryShader),
-        "Shaders::MeshVisualizerGL2D: at least one visualization feature has to be enabled", );
+        "Shaders::MeshVisualizerGL2D: at least one visualization feature has to be enabled", CompileState{NoCreate});
     #else
     CORRADE_ASSERT(flags & (Flag::Wireframe & ~Flag::NoGeometryShader),
-        "Shaders::MeshVisualizerGL2D: at least Flag::Wireframe has to be enabled", );
+        "Shaders::MeshVisualizerGL2D: at least Flag::Wireframe has to be enabled", CompileState{NoCreate});
     #endif
 
     /* Has to be here and not in the base class in order to have it exit the
@@ -404,9 +406,9 @@ MeshVisualizerGL2D::MeshVisualizerGL2D(const Flags flags
        otherwise */
     #ifndef MAGNUM_TARGET_GLES2
     CORRADE_ASSERT(!(flags >= Flag::UniformBuffers) || materialCount,
-        "Shaders::MeshVisualizerGL2D: material count can't be zero", );
+        "Shaders::MeshVisualizerGL2D: material count can't be zero", CompileState{NoCreate});
     CORRADE_ASSERT(!(flags >= Flag::UniformBuffers) || drawCount,
-        "Shaders::MeshVisualizerGL2D: draw count can't be zero", );
+        "Shaders::MeshVisualizerGL2D: draw count can't be zero", CompileState{NoCreate});
     #endif
 
     #ifndef MAGNUM_TARGET_GLES
@@ -416,7 +418,7 @@ MeshVisualizerGL2D::MeshVisualizerGL2D(const Flags flags
     Utility::Resource rs{"MagnumShadersGL"};
     GL::Shader vert{NoCreate};
     GL::Shader frag{NoCreate};
-    const GL::Version version = setupShaders(vert, frag, rs);
+    const GL::Version version = out.setupShaders(vert, frag, rs);
 
     vert.addSource("#define TWO_DIMENSIONS\n")
         /* Pass NO_GEOMETRY_SHADER not only when NoGeometryShader but also when
@@ -445,13 +447,13 @@ MeshVisualizerGL2D::MeshVisualizerGL2D(const Flags flags
         geom = Implementation::createCompatibilityShader(rs, version, GL::Shader::Type::Geometry);
         (*geom)
             .addSource("#define WIREFRAME_RENDERING\n#define MAX_VERTICES 3\n")
-            .addSource(_flags >= FlagBase::ObjectIdTexture ? "#define TEXTURED\n" : "")
-            .addSource(_flags & FlagBase::TextureArrays ? "#define TEXTURE_ARRAYS\n" : "")
-            .addSource(_flags & FlagBase::ObjectId ? "#define OBJECT_ID\n" : "")
-            .addSource(_flags >= FlagBase::InstancedObjectId ? "#define INSTANCED_OBJECT_ID\n" : "")
-            .addSource(_flags & FlagBase::VertexId ? "#define VERTEX_ID\n" : "")
-            .addSource(_flags & FlagBase::PrimitiveId ?
-                (_flags >= FlagBase::PrimitiveIdFromVertexId ?
+            .addSource(out._flags >= FlagBase::ObjectIdTexture ? "#define TEXTURED\n" : "")
+            .addSource(out._flags & FlagBase::TextureArrays ? "#define TEXTURE_ARRAYS\n" : "")
+            .addSource(out._flags & FlagBase::ObjectId ? "#define OBJECT_ID\n" : "")
+            .addSource(out._flags >= FlagBase::InstancedObjectId ? "#define INSTANCED_OBJECT_ID\n" : "")
+            .addSource(out._flags & FlagBase::VertexId ? "#define VERTEX_ID\n" : "")
+            .addSource(out._flags & FlagBase::PrimitiveId ?
+                (out._flags >= FlagBase::PrimitiveIdFromVertexId ?
                     "#define PRIMITIVE_ID_FROM_VERTEX_ID\n" :
                     "#define PRIMITIVE_ID\n") : "");
         #ifndef MAGNUM_TARGET_GLES2
@@ -461,8 +463,8 @@ MeshVisualizerGL2D::MeshVisualizerGL2D(const Flags flags
                 "#define UNIFORM_BUFFERS\n"
                 "#define DRAW_COUNT {}\n"
                 "#define MATERIAL_COUNT {}\n",
-                _drawCount,
-                _materialCount));
+                out._drawCount,
+                out._materialCount));
             geom->addSource(flags >= Flag::MultiDraw ? "#define MULTI_DRAW\n" : "");
         }
         #endif
@@ -472,48 +474,99 @@ MeshVisualizerGL2D::MeshVisualizerGL2D(const Flags flags
     static_cast<void>(version);
     #endif
 
+    /* If a matching program binary is cached, there's nothing to compile
+       or link */
     #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
-    if(geom) CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::compile({vert, *geom, frag}));
-    else
-    #endif
-        CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::compile({vert, frag}));
-
-    attachShaders({vert, frag});
-    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
-    if(geom) attachShader(*geom);
-    #endif
-
-    /* ES3 has this done in the shader directly */
-    #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
-    #ifndef MAGNUM_TARGET_GLES
-    if(!context.isExtensionSupported<GL::Extensions::ARB::explicit_attrib_location>(version))
+    const bool cached = geom ?
+        out.loadCachedBinary({vert, *geom, frag}) :
+        out.loadCachedBinary({vert, frag});
+    #else
+    const bool cached = false;
     #endif
-    {
-        bindAttributeLocation(Position::Location, "position");
-        #ifndef MAGNUM_TARGET_GLES2
-        if(flags >= Flag::ObjectIdTexture)
-            bindAttributeLocation(TextureCoordinates::Location, "textureCoordinates");
-        if(flags >= Flag::InstancedObjectId)
-            bindAttributeLocation(ObjectId::Location, "instanceObjectId");
+    if(!cached) {
+        vert.submitCompile();
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        if(geom) geom->submitCompile();
         #endif
-        if(flags & Flag::InstancedTransformation)
-            bindAttributeLocation(TransformationMatrix::Location, "instancedTransformationMatrix");
-        #ifndef MAGNUM_TARGET_GLES2
-        if(flags >= Flag::InstancedTextureOffset)
-            bindAttributeLocation(TextureOffset::Location, "instancedTextureOffset");
+        frag.submitCompile();
+
+        out.attachShaders({vert, frag});
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        if(geom) out.attachShader(*geom);
         #endif
+
+        /* ES3 has this done in the shader directly */
         #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
         #ifndef MAGNUM_TARGET_GLES
-        if(!context.isVersionSupported(GL::Version::GL310))
+        if(!context.isExtensionSupported<GL::Extensions::ARB::explicit_attrib_location>(version))
         #endif
         {
-            bindAttributeLocation(VertexIndex::Location, "vertexIndex");
+            out.bindAttributeLocation(Position::Location, "position");
+            #ifndef MAGNUM_TARGET_GLES2
+            if(flags >= Flag::ObjectIdTexture)
+                out.bindAttributeLocation(TextureCoordinates::Location, "textureCoordinates");
+            if(flags >= Flag::InstancedObjectId)
+                out.bindAttributeLocation(ObjectId::Location, "instanceObjectId");
+            #endif
+            if(flags & Flag::InstancedTransformation)
+                out.bindAttributeLocation(TransformationMatrix::Location, "instancedTransformationMatrix");
+            #ifndef MAGNUM_TARGET_GLES2
+            if(flags >= Flag::InstancedTextureOffset)
+                out.bindAttributeLocation(TextureOffset::Location, "instancedTextureOffset");
+            #endif
+            #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
+            #ifndef MAGNUM_TARGET_GLES
+            if(!context.isVersionSupported(GL::Version::GL310))
+            #endif
+            {
+                out.bindAttributeLocation(VertexIndex::Location, "vertexIndex");
+            }
+            #endif
         }
         #endif
+
+        out.submitLink();
     }
+
+    return CompileState{std::move(out), std::move(vert), std::move(frag),
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        std::move(geom),
+        #endif
+        version, cached};
+}
+
+MeshVisualizerGL2D::MeshVisualizerGL2D(CompileState&& state): MeshVisualizerGL2D{static_cast<MeshVisualizerGL2D&&>(std::move(state))} {
+    #ifdef CORRADE_GRACEFUL_ASSERT
+    /* When graceful assertions fire from within compile(), we get a
+       NoCreate'd CompileState. Exiting makes it possible to test the
+       assert. */
+    if(!id()) return;
     #endif
 
-    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+    /* If the program was loaded from the binary cache, there's nothing to
+       check */
+    if(!state._cached) {
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        if(state._geom) {
+            CORRADE_INTERNAL_ASSERT_OUTPUT(state._vert.checkCompile() && state._geom->checkCompile() && state._frag.checkCompile());
+            CORRADE_INTERNAL_ASSERT_OUTPUT(checkLink());
+            saveCachedBinary({state._vert, *state._geom, state._frag});
+        } else
+        #endif
+        {
+            CORRADE_INTERNAL_ASSERT_OUTPUT(state._vert.checkCompile() && state._frag.checkCompile());
+            CORRADE_INTERNAL_ASSERT_OUTPUT(checkLink());
+            #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+            saveCachedBinary({state._vert, state._frag});
+            #endif
+        }
+    }
+
+    #ifndef MAGNUM_TARGET_GLES
+    const GL::Context& context = GL::Context::current();
+    const GL::Version version = state._version;
+    #endif
+    const Flags flags = this->flags();
 
     #ifndef MAGNUM_TARGET_GLES
     if(!context.isExtensionSupported<GL::Extensions::ARB::explicit_uniform_location>(version))
@@ -611,9 +664,27 @@ MeshVisualizerGL2D::MeshVisualizerGL2D(const Flags flags
 }
 
 #ifndef MAGNUM_TARGET_GLES2
-MeshVisualizerGL2D::MeshVisualizerGL2D(const Flags flags): MeshVisualizerGL2D{flags, 1, 1} {}
+MeshVisualizerGL2D::CompileState MeshVisualizerGL2D::compile(const Flags flags) {
+    return compile(flags, 1, 1);
+}
+#endif
+
+MeshVisualizerGL2D::MeshVisualizerGL2D(const Flags flags): MeshVisualizerGL2D{compile(flags)} {}
+
+#ifndef MAGNUM_TARGET_GLES2
+MeshVisualizerGL2D::MeshVisualizerGL2D(const Flags flags, const UnsignedInt materialCount, const UnsignedInt drawCount): MeshVisualizerGL2D{compile(flags, materialCount, drawCount)} {}
 #endif
 
+MeshVisualizerGL2D::MeshVisualizerGL2D(NoInitT, const Flags flags
+    #ifndef MAGNUM_TARGET_GLES2
+    , const UnsignedInt materialCount, const UnsignedInt drawCount
+    #endif
+): Implementation::MeshVisualizerGLBase{Implementation::MeshVisualizerGLBase::FlagBase(UnsignedInt(flags))
+    #ifndef MAGNUM_TARGET_GLES2
+    , materialCount, drawCount
+    #endif
+} {}
+
 MeshVisualizerGL2D& MeshVisualizerGL2D::setViewportSize(const Vector2& size) {
     /* Not asserting here, since the relation to wireframe is a bit vague.
        Also it's an ugly hack that should be removed, ideally. */
@@ -674,33 +745,35 @@ MeshVisualizerGL2D& MeshVisualizerGL2D::bindDrawBuffer(GL::Buffer& buffer, const
 }
 #endif
 
-MeshVisualizerGL3D::MeshVisualizerGL3D(const Flags flags
+MeshVisualizerGL3D::CompileState MeshVisualizerGL3D::compile(const Flags flags
     #ifndef MAGNUM_TARGET_GLES2
     , const UnsignedInt materialCount, const UnsignedInt drawCount
     #endif
-): Implementation::MeshVisualizerGLBase{Implementation::MeshVisualizerGLBase::FlagBase(UnsignedInt(flags))
-    #ifndef MAGNUM_TARGET_GLES2
-    , materialCount, drawCount
-    #endif
-} {
+) {
+    MeshVisualizerGL3D out{NoInit, flags
+        #ifndef MAGNUM_TARGET_GLES2
+        , materialCount, drawCount
+        #endif
+    };
+
     #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
     CORRADE_ASSERT(flags & ((Flag::Wireframe|Flag::TangentDirection|Flag::BitangentFromTangentDirection|Flag::BitangentDirection|Flag::NormalDirection|Flag::ObjectId|Flag::VertexId|Flag::PrimitiveIdFromVertexId) & ~Flag::NoGeometryShader),
-        "Shaders::MeshVisualizerGL3D: at least one visualization feature has to be enabled", );
+        "Shaders::MeshVisualizerGL3D: at least one visualization feature has to be enabled", CompileState{NoCreate});
     CORRADE_ASSERT(!(flags & Flag::NoGeometryShader && flags & (Flag::TangentDirection|Flag::BitangentFromTangentDirection|Flag::BitangentDirection|Flag::NormalDirection)),
-        "Shaders::MeshVisualizerGL3D: geometry shader has to be enabled when rendering TBN direction", );
+        "Shaders::MeshVisualizerGL3D: geometry shader has to be enabled when rendering TBN direction", CompileState{NoCreate});
     CORRADE_ASSERT(!(flags & Flag::BitangentDirection && flags & Flag::BitangentFromTangentDirection),
-        "Shaders::MeshVisualizerGL3D: Flag::BitangentDirection and Flag::BitangentFromTangentDirection are mutually exclusive", );
+        "Shaders::MeshVisualizerGL3D: Flag::BitangentDirection and Flag::BitangentFromTangentDirection are mutually exclusive", CompileState{NoCreate});
     #elif !defined(MAGNUM_TARGET_GLES2)
     CORRADE_ASSERT(flags & ((Flag::Wireframe|Flag::ObjectId|Flag::VertexId|Flag::PrimitiveIdFromVertexId) & ~Flag::NoGeometryShader),
-        "Shaders::MeshVisualizerGL3D: at least one visualization feature has to be enabled", );
+        "Shaders::MeshVisualizerGL3D: at least one visualization feature has to be enabled", CompileState{NoCreate});
     #else
     CORRADE_ASSERT(flags & (Flag::Wireframe & ~Flag::NoGeometryShader),
-        "Shaders::MeshVisualizerGL3D: at least Flag::Wireframe has to be enabled", );
+        "Shaders::MeshVisualizerGL3D: at least Flag::Wireframe has to be enabled", CompileState{NoCreate});
     #endif
 
     #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
     CORRADE_ASSERT(!(flags >= Flag::InstancedObjectId) || !(flags & Flag::BitangentDirection),
-        "Shaders::MeshVisualizerGL3D: Bitangent attribute binding conflicts with the ObjectId attribute, use a Tangent4 attribute with instanced object ID rendering instead", );
+        "Shaders::MeshVisualizerGL3D: Bitangent attribute binding conflicts with the ObjectId attribute, use a Tangent4 attribute with instanced object ID rendering instead", CompileState{NoCreate});
     #endif
 
     /* Has to be here and not in the base class in order to have it exit the
@@ -708,9 +781,9 @@ MeshVisualizerGL3D::MeshVisualizerGL3D(const Flags flags
        otherwise */
     #ifndef MAGNUM_TARGET_GLES2
     CORRADE_ASSERT(!(flags >= Flag::UniformBuffers) || materialCount,
-        "Shaders::MeshVisualizerGL3D: material count can't be zero", );
+        "Shaders::MeshVisualizerGL3D: material count can't be zero", CompileState{NoCreate});
     CORRADE_ASSERT(!(flags >= Flag::UniformBuffers) || drawCount,
-        "Shaders::MeshVisualizerGL3D: draw count can't be zero", );
+        "Shaders::MeshVisualizerGL3D: draw count can't be zero", CompileState{NoCreate});
     #endif
 
     #ifndef MAGNUM_TARGET_GLES
@@ -720,7 +793,7 @@ MeshVisualizerGL3D::MeshVisualizerGL3D(const Flags flags
     Utility::Resource rs{"MagnumShadersGL"};
     GL::Shader vert{NoCreate};
     GL::Shader frag{NoCreate};
-    const GL::Version version = setupShaders(vert, frag, rs);
+    const GL::Version version = out.setupShaders(vert, frag, rs);
 
     /* Expands the check done for wireframe in MeshVisualizerBase with TBN */
     #ifndef MAGNUM_TARGET_GLES
@@ -781,13 +854,13 @@ MeshVisualizerGL3D::MeshVisualizerGL3D(const Flags flags
         (*geom)
             .addSource(Utility::formatString("#define MAX_VERTICES {}\n", maxVertices))
             .addSource(flags & Flag::Wireframe ? "#define WIREFRAME_RENDERING\n" : "")
-            .addSource(_flags >= FlagBase::ObjectIdTexture ? "#define TEXTURED\n" : "")
-            .addSource(_flags & FlagBase::TextureArrays ? "#define TEXTURE_ARRAYS\n" : "")
-            .addSource(_flags & FlagBase::ObjectId ? "#define OBJECT_ID\n" : "")
-            .addSource(_flags >= FlagBase::InstancedObjectId ? "#define INSTANCED_OBJECT_ID\n" : "")
-            .addSource(_flags & FlagBase::VertexId ? "#define VERTEX_ID\n" : "")
-            .addSource(_flags & FlagBase::PrimitiveId ?
-                (_flags >= FlagBase::PrimitiveIdFromVertexId ?
+            .addSource(out._flags >= FlagBase::ObjectIdTexture ? "#define TEXTURED\n" : "")
+            .addSource(out._flags & FlagBase::TextureArrays ? "#define TEXTURE_ARRAYS\n" : "")
+            .addSource(out._flags & FlagBase::ObjectId ? "#define OBJECT_ID\n" : "")
+            .addSource(out._flags >= FlagBase::InstancedObjectId ? "#define INSTANCED_OBJECT_ID\n" : "")
+            .addSource(out._flags & FlagBase::VertexId ? "#define VERTEX_ID\n" : "")
+            .addSource(out._flags & FlagBase::PrimitiveId ?
+                (out._flags >= FlagBase::PrimitiveIdFromVertexId ?
                     "#define PRIMITIVE_ID_FROM_VERTEX_ID\n" :
                     "#define PRIMITIVE_ID\n") : "")
             .addSource(flags & Flag::TangentDirection ? "#define TANGENT_DIRECTION\n" : "")
@@ -800,8 +873,8 @@ MeshVisualizerGL3D::MeshVisualizerGL3D(const Flags flags
                 "#define UNIFORM_BUFFERS\n"
                 "#define DRAW_COUNT {}\n"
                 "#define MATERIAL_COUNT {}\n",
-                _drawCount,
-                _materialCount));
+                out._drawCount,
+                out._materialCount));
             geom->addSource(flags >= Flag::MultiDraw ? "#define MULTI_DRAW\n" : "");
         }
         #endif
@@ -811,64 +884,115 @@ MeshVisualizerGL3D::MeshVisualizerGL3D(const Flags flags
     static_cast<void>(version);
     #endif
 
+    /* If a matching program binary is cached, there's nothing to compile
+       or link */
     #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
-    if(geom) CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::compile({vert, *geom, frag}));
-    else
+    const bool cached = geom ?
+        out.loadCachedBinary({vert, *geom, frag}) :
+        out.loadCachedBinary({vert, frag});
+    #else
+    const bool cached = false;
     #endif
-        CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::compile({vert, frag}));
+    if(!cached) {
+        vert.submitCompile();
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        if(geom) geom->submitCompile();
+        #endif
+        frag.submitCompile();
 
-    attachShaders({vert, frag});
-    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
-    if(geom) attachShader(*geom);
-    #endif
+        out.attachShaders({vert, frag});
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        if(geom) out.attachShader(*geom);
+        #endif
 
-    /* ES3 has this done in the shader directly */
-    #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
-    #ifndef MAGNUM_TARGET_GLES
-    if(!context.isExtensionSupported<GL::Extensions::ARB::explicit_attrib_location>(version))
-    #endif
-    {
-        bindAttributeLocation(Position::Location, "position");
-        #ifndef MAGNUM_TARGET_GLES2
-        if(flags >= Flag::ObjectIdTexture)
-            bindAttributeLocation(TextureCoordinates::Location, "textureCoordinates");
-        if(flags >= Flag::InstancedObjectId)
-            bindAttributeLocation(ObjectId::Location, "instanceObjectId");
+        /* ES3 has this done in the shader directly */
+        #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
+        #ifndef MAGNUM_TARGET_GLES
+        if(!context.isExtensionSupported<GL::Extensions::ARB::explicit_attrib_location>(version))
         #endif
-        if(flags & Flag::InstancedTransformation) {
-            bindAttributeLocation(TransformationMatrix::Location, "instancedTransformationMatrix");
+        {
+            out.bindAttributeLocation(Position::Location, "position");
+            #ifndef MAGNUM_TARGET_GLES2
+            if(flags >= Flag::ObjectIdTexture)
+                out.bindAttributeLocation(TextureCoordinates::Location, "textureCoordinates");
+            if(flags >= Flag::InstancedObjectId)
+                out.bindAttributeLocation(ObjectId::Location, "instanceObjectId");
+            #endif
+            if(flags & Flag::InstancedTransformation) {
+                out.bindAttributeLocation(TransformationMatrix::Location, "instancedTransformationMatrix");
+                #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+                if(flags & (Flag::TangentDirection|Flag::BitangentFromTangentDirection|Flag::BitangentDirection|Flag::NormalDirection))
+                    out.bindAttributeLocation(NormalMatrix::Location, "instancedNormalMatrix");
+                #endif
+            }
+            #ifndef MAGNUM_TARGET_GLES2
+            if(flags >= Flag::InstancedTextureOffset)
+                out.bindAttributeLocation(TextureOffset::Location, "instancedTextureOffset");
+            #endif
             #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
-            if(flags & (Flag::TangentDirection|Flag::BitangentFromTangentDirection|Flag::BitangentDirection|Flag::NormalDirection))
-                bindAttributeLocation(NormalMatrix::Location, "instancedNormalMatrix");
+            if(flags & Flag::TangentDirection ||
+               flags & Flag::BitangentFromTangentDirection)
+                out.bindAttributeLocation(Tangent4::Location, "tangent");
+            if(flags & Flag::BitangentDirection)
+                out.bindAttributeLocation(Bitangent::Location, "bitangent");
+            if(flags & Flag::NormalDirection ||
+               flags & Flag::BitangentFromTangentDirection)
+                out.bindAttributeLocation(Normal::Location, "normal");
+            #endif
+
+            #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
+            #ifndef MAGNUM_TARGET_GLES
+            if(!context.isVersionSupported(GL::Version::GL310))
+            #endif
+            {
+                out.bindAttributeLocation(VertexIndex::Location, "vertexIndex");
+            }
             #endif
         }
-        #ifndef MAGNUM_TARGET_GLES2
-        if(flags >= Flag::InstancedTextureOffset)
-            bindAttributeLocation(TextureOffset::Location, "instancedTextureOffset");
         #endif
+
+        out.submitLink();
+    }
+
+    return CompileState{std::move(out), std::move(vert), std::move(frag),
         #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
-        if(flags & Flag::TangentDirection ||
-           flags & Flag::BitangentFromTangentDirection)
-            bindAttributeLocation(Tangent4::Location, "tangent");
-        if(flags & Flag::BitangentDirection)
-            bindAttributeLocation(Bitangent::Location, "bitangent");
-        if(flags & Flag::NormalDirection ||
-           flags & Flag::BitangentFromTangentDirection)
-            bindAttributeLocation(Normal::Location, "normal");
+        std::move(geom),
         #endif
+        version, cached};
+}
 
-        #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
-        #ifndef MAGNUM_TARGET_GLES
-        if(!context.isVersionSupported(GL::Version::GL310))
+MeshVisualizerGL3D::MeshVisualizerGL3D(CompileState&& state): MeshVisualizerGL3D{static_cast<MeshVisualizerGL3D&&>(std::move(state))} {
+    #ifdef CORRADE_GRACEFUL_ASSERT
+    /* When graceful assertions fire from within compile(), we get a
+       NoCreate'd CompileState. Exiting makes it possible to test the
+       assert. */
+    if(!id()) return;
+    #endif
+
+    /* If the program was loaded from the binary cache, there's nothing to
+       check */
+    if(!state._cached) {
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        if(state._geom) {
+            CORRADE_INTERNAL_ASSERT_OUTPUT(state._vert.checkCompile() && state._geom->checkCompile() && state._frag.checkCompile());
+            CORRADE_INTERNAL_ASSERT_OUTPUT(checkLink());
+            saveCachedBinary({state._vert, *state._geom, state._frag});
+        } else
         #endif
         {
-            bindAttributeLocation(VertexIndex::Location, "vertexIndex");
+            CORRADE_INTERNAL_ASSERT_OUTPUT(state._vert.checkCompile() && state._frag.checkCompile());
+            CORRADE_INTERNAL_ASSERT_OUTPUT(checkLink());
+            #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+            saveCachedBinary({state._vert, state._frag});
+            #endif
         }
-        #endif
     }
-    #endif
 
-    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+    #ifndef MAGNUM_TARGET_GLES
+    const GL::Context& context = GL::Context::current();
+    const GL::Version version = state._version;
+    #endif
+    const Flags flags = this->flags();
 
     #ifndef MAGNUM_TARGET_GLES
     if(!context.isExtensionSupported<GL::Extensions::ARB::explicit_uniform_location>(version))
@@ -999,9 +1123,27 @@ MeshVisualizerGL3D::MeshVisualizerGL3D(const Flags flags
 }
 
 #ifndef MAGNUM_TARGET_GLES2
-MeshVisualizerGL3D::MeshVisualizerGL3D(const Flags flags): MeshVisualizerGL3D{flags, 1, 1} {}
+MeshVisualizerGL3D::CompileState MeshVisualizerGL3D::compile(const Flags flags) {
+    return compile(flags, 1, 1);
+}
+#endif
+
+MeshVisualizerGL3D::MeshVisualizerGL3D(const Flags flags): MeshVisualizerGL3D{compile(flags)} {}
+
+#ifndef MAGNUM_TARGET_GLES2
+MeshVisualizerGL3D::MeshVisualizerGL3D(const Flags flags, const UnsignedInt materialCount, const UnsignedInt drawCount): MeshVisualizerGL3D{compile(flags, materialCount, drawCount)} {}
 #endif
 
+MeshVisualizerGL3D::MeshVisualizerGL3D(NoInitT, const Flags flags
+    #ifndef MAGNUM_TARGET_GLES2
+    , const UnsignedInt materialCount, const UnsignedInt drawCount
+    #endif
+): Implementation::MeshVisualizerGLBase{Implementation::MeshVisualizerGLBase::FlagBase(UnsignedInt(flags))
+    #ifndef MAGNUM_TARGET_GLES2
+    , materialCount, drawCount
+    #endif
+} {}
+
 MeshVisualizerGL3D& MeshVisualizerGL3D::setTransformationMatrix(const Matrix4& matrix) {
     #ifndef MAGNUM_TARGET_GLES2
     CORRADE_ASSERT(!(flags() >= Flag::UniformBuffers),
@@ -30,10 +30,12 @@
  * @m_since_latest
  */
 
+#include <Corrade/Containers/Optional.h>
 #include <Corrade/Utility/Utility.h>
 
 #include "Magnum/DimensionTraits.h"
 #include "Magnum/GL/AbstractShaderProgram.h"
+#include "Magnum/GL/Shader.h"
 #include "Magnum/Shaders/GenericGL.h"
 #include "Magnum/Shaders/visibility.h"
 
@@ -441,6 +443,36 @@ class MAGNUM_SHADERS_EXPORT MeshVisualizerGL2D: public Implementation::MeshVisua
         /** @brief Flags */
         typedef Containers::EnumSet<Flag> Flags;
 
+        class CompileState;
+
+        /**
+         * @brief Compile asynchronously
+         * @m_since_latest
+         *
+         * Compared to @ref MeshVisualizerGL2D(Flags) can perform an asynchronous
+         * compilation and linking. See @ref shaders-async for more
+         * information.
+         * @see @ref MeshVisualizerGL2D(CompileState&&),
+         *      @ref compile(Flags, UnsignedInt, UnsignedInt)
+         */
+        static CompileState compile(Flags flags);
+
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Compile for a multi-draw scenario asynchronously
+         * @m_since_latest
+         *
+         * Compared to @ref MeshVisualizerGL2D(Flags, UnsignedInt, UnsignedInt) can
+         * perform an asynchronous compilation and linking. See
+         * @ref shaders-async for more information.
+         * @see @ref MeshVisualizerGL2D(CompileState&&), @ref compile(Flags)
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        static CompileState compile(Flags flags, UnsignedInt materialCount, UnsignedInt drawCount);
+        #endif
+
         /**
          * @brief Constructor
          * @param flags     Flags
@@ -491,6 +523,16 @@ class MAGNUM_SHADERS_EXPORT MeshVisualizerGL2D: public Implementation::MeshVisua
         explicit MeshVisualizerGL2D(Flags flags, UnsignedInt materialCount, UnsignedInt drawCount);
         #endif
 
+        /**
+         * @brief Finalize an asynchronous compilation
+         * @m_since_latest
+         *
+         * Takes an asynchronous compilation state returned by @ref compile()
+         * and forms a ready-to-use shader object. See @ref shaders-async for
+         * more information.
+         */
+        explicit MeshVisualizerGL2D(CompileState&& state);
+
         /**
          * @brief Construct without creating the underlying OpenGL object
          *
@@ -862,9 +904,47 @@ class MAGNUM_SHADERS_EXPORT MeshVisualizerGL2D: public Implementation::MeshVisua
         #endif
 
     private:
+        /* Creates the GL shader program object and checks the base flags but
+           does nothing else. Internal, used by compile(). */
+        explicit MeshVisualizerGL2D(NoInitT, Flags flags
+            #ifndef MAGNUM_TARGET_GLES2
+            , UnsignedInt materialCount, UnsignedInt drawCount
+            #endif
+        );
+
         Int _transformationProjectionMatrixUniform{9};
 };
 
+/**
+@brief Asynchronous compilation state
+@m_since_latest
+
+Returned by @ref compile(). See @ref shaders-async for more information.
+*/
+class MeshVisualizerGL2D::CompileState: public MeshVisualizerGL2D {
+    /* Everything deliberately private except for the inheritance */
+    friend class MeshVisualizerGL2D;
+
+    explicit CompileState(NoCreateT): MeshVisualizerGL2D{NoCreate}, _vert{NoCreate}, _frag{NoCreate} {}
+
+    explicit CompileState(MeshVisualizerGL2D&& shader, GL::Shader&& vert, GL::Shader&& frag,
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        Containers::Optional<GL::Shader>&& geom,
+        #endif
+        GL::Version version, bool cached): MeshVisualizerGL2D{std::move(shader)}, _vert{std::move(vert)}, _frag{std::move(frag)},
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        _geom{std::move(geom)},
+        #endif
+        _version{version}, _cached{cached} {}
+
+    GL::Shader _vert, _frag;
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    Containers::Optional<GL::Shader> _geom;
+    #endif
+    GL::Version _version;
+    bool _cached;
+};
+
 /**
 @brief 3D mesh visualization OpenGL shader
 @m_since_latest
@@ -948,6 +1028,10 @@ Rendering setup:
 
 @snippet MagnumShaders-gl.cpp MeshVisualizerGL3D-usage-no-geom2
 
+For large meshes, the conversion can be done on the GPU with
+@ref MeshVisualizerPrepassGL, see @ref Shaders-MeshVisualizerPrepassGL-wireframe
+for more information.
+
 @subsection Shaders-MeshVisualizerGL3D-usage-wireframe-no-geom-old Wireframe visualization of non-indexed meshes without a geometry shader on older hardware
 
 You need to provide also the @ref VertexIndex attribute. Mesh setup *in
@@ -990,6 +1074,10 @@ Rendering setup:
 
 @snippet MagnumShaders-gl.cpp MeshVisualizerGL3D-usage-tbn2
 
+Where geometry shaders aren't available or are too slow, the lines can be
+generated once per mesh with @ref MeshVisualizerPrepassGL instead, see
+@ref Shaders-MeshVisualizerPrepassGL-tbn for more information.
+
 @section Shaders-MeshVisualizerGL3D-object-id Object, vertex and primitive ID visualization
 
 If the mesh contains a per-vertex (or instanced) @ref ObjectId, it can be
@@ -1617,6 +1705,36 @@ class MAGNUM_SHADERS_EXPORT MeshVisualizerGL3D: public Implementation::MeshVisua
         /** @brief Flags */
         typedef Containers::EnumSet<Flag> Flags;
 
+        class CompileState;
+
+        /**
+         * @brief Compile asynchronously
+         * @m_since_latest
+         *
+         * Compared to @ref MeshVisualizerGL3D(Flags) can perform an asynchronous
+         * compilation and linking. See @ref shaders-async for more
+         * information.
+         * @see @ref MeshVisualizerGL3D(CompileState&&),
+         *      @ref compile(Flags, UnsignedInt, UnsignedInt)
+         */
+        static CompileState compile(Flags flags);
+
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Compile for a multi-draw scenario asynchronously
+         * @m_since_latest
+         *
+         * Compared to @ref MeshVisualizerGL3D(Flags, UnsignedInt, UnsignedInt) can
+         * perform an asynchronous compilation and linking. See
+         * @ref shaders-async for more information.
+         * @see @ref MeshVisualizerGL3D(CompileState&&), @ref compile(Flags)
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        static CompileState compile(Flags flags, UnsignedInt materialCount, UnsignedInt drawCount);
+        #endif
+
         /**
          * @brief Constructor
          * @param flags     Flags
@@ -1684,6 +1802,16 @@ class MAGNUM_SHADERS_EXPORT MeshVisualizerGL3D: public Implementation::MeshVisua
         explicit MeshVisualizerGL3D(Flags flags, UnsignedInt materialCount, UnsignedInt drawCount);
         #endif
 
+        /**
+         * @brief Finalize an asynchronous compilation
+         * @m_since_latest
+         *
+         * Takes an asynchronous compilation state returned by @ref compile()
+         * and forms a ready-to-use shader object. See @ref shaders-async for
+         * more information.
+         */
+        explicit MeshVisualizerGL3D(CompileState&& state);
+
         /**
          * @brief Construct without creating the underlying OpenGL object
          *
@@ -2326,6 +2454,14 @@ class MAGNUM_SHADERS_EXPORT MeshVisualizerGL3D: public Implementation::MeshVisua
         #endif
 
     private:
+        /* Creates the GL shader program object and checks the base flags but
+           does nothing else. Internal, used by compile(). */
+        explicit MeshVisualizerGL3D(NoInitT, Flags flags
+            #ifndef MAGNUM_TARGET_GLES2
+            , UnsignedInt materialCount, UnsignedInt drawCount
+            #endif
+        );
+
         Int _transformationMatrixUniform{9},
             _projectionMatrixUniform{10};
         #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
@@ -2335,6 +2471,36 @@ class MAGNUM_SHADERS_EXPORT MeshVisualizerGL3D: public Implementation::MeshVisua
         #endif
 };
 
+/**
+@brief Asynchronous compilation state
+@m_since_latest
+
+Returned by @ref compile(). See @ref shaders-async for more information.
+*/
+class MeshVisualizerGL3D::CompileState: public MeshVisualizerGL3D {
+    /* Everything deliberately private except for the inheritance */
+    friend class MeshVisualizerGL3D;
+
+    explicit CompileState(NoCreateT): MeshVisualizerGL3D{NoCreate}, _vert{NoCreate}, _frag{NoCreate} {}
+
+    explicit CompileState(MeshVisualizerGL3D&& shader, GL::Shader&& vert, GL::Shader&& frag,
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        Containers::Optional<GL::Shader>&& geom,
+        #endif
+        GL::Version version, bool cached): MeshVisualizerGL3D{std::move(shader)}, _vert{std::move(vert)}, _frag{std::move(frag)},
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        _geom{std::move(geom)},
+        #endif
+        _version{version}, _cached{cached} {}
+
+    GL::Shader _vert, _frag;
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    Containers::Optional<GL::Shader> _geom;
+    #endif
+    GL::Version _version;
+    bool _cached;
+};
+
 /** @debugoperatorclassenum{MeshVisualizerGL2D,MeshVisualizerGL2D::Flag} */
 MAGNUM_SHADERS_EXPORT Debug& operator<<(Debug& debug, MeshVisualizerGL2D::Flag value);
 
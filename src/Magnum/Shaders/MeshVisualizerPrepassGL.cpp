@@ -0,0 +1,305 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MeshVisualizerPrepassGL.h"
+
+#include <Corrade/Containers/EnumSet.hpp>
+#include <Corrade/Containers/Reference.h>
+#include <Corrade/Containers/StringStl.h>
+#include <Corrade/Utility/FormatStl.h>
+#include <Corrade/Utility/Resource.h>
+
+#include "Magnum/GL/Buffer.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector3.h"
+
+#include "Magnum/Shaders/Implementation/CreateCompatibilityShader.h"
+
+namespace Magnum { namespace Shaders {
+
+namespace {
+    enum: Int {
+        PositionBufferBinding = 0,
+        IndexBufferBinding = 1,
+        NormalBufferBinding = 2,
+        TangentBufferBinding = 3,
+        BitangentBufferBinding = 4,
+        WireframeBufferBinding = 5,
+        LineBufferBinding = 6
+    };
+
+    enum: Int {
+        IndexCountUniform = 0,
+        VertexCountUniform = 1,
+        LineLengthUniform = 2
+    };
+
+    /* Keep in sync with GROUP_SIZE in MeshVisualizerPrepass.comp */
+    constexpr UnsignedInt GroupSize = 64;
+
+    constexpr MeshVisualizerPrepassGL::Flags LineFlags =
+        MeshVisualizerPrepassGL::Flag::TangentDirection|
+        MeshVisualizerPrepassGL::Flag::BitangentFromTangentDirection|
+        MeshVisualizerPrepassGL::Flag::BitangentDirection|
+        MeshVisualizerPrepassGL::Flag::NormalDirection;
+}
+
+MeshVisualizerPrepassGL::CompileState MeshVisualizerPrepassGL::compile(const Flags flags) {
+    CORRADE_ASSERT(flags,
+        "Shaders::MeshVisualizerPrepassGL: at least one visualization feature has to be enabled", CompileState{NoCreate});
+    CORRADE_ASSERT(!(flags & Flag::BitangentDirection && flags & Flag::BitangentFromTangentDirection),
+        "Shaders::MeshVisualizerPrepassGL: Flag::BitangentDirection and Flag::BitangentFromTangentDirection are mutually exclusive", CompileState{NoCreate});
+
+    #ifndef MAGNUM_TARGET_GLES
+    MAGNUM_ASSERT_GL_VERSION_SUPPORTED(GL::Version::GL430);
+    #else
+    MAGNUM_ASSERT_GL_VERSION_SUPPORTED(GL::Version::GLES310);
+    #endif
+
+    #ifdef MAGNUM_BUILD_STATIC
+    /* Import resources on static build, if not already */
+    if(!Utility::Resource::hasGroup("MagnumShadersGL"))
+        importShaderResources();
+    #endif
+    Utility::Resource rs("MagnumShadersGL");
+
+    #ifndef MAGNUM_TARGET_GLES
+    const GL::Version version = GL::Version::GL430;
+    #else
+    const GL::Version version = GL::Version::GLES310;
+    #endif
+
+    MeshVisualizerPrepassGL out{NoInit};
+    out._flags = flags;
+
+    GL::Shader comp = Implementation::createCompatibilityShader(rs, version, GL::Shader::Type::Compute);
+    comp.addSource(flags & Flag::Wireframe ? "#define WIREFRAME\n" : "")
+        .addSource(flags & Flag::TangentDirection ? "#define TANGENT_DIRECTION\n" : "")
+        .addSource(flags & Flag::BitangentFromTangentDirection ? "#define BITANGENT_FROM_TANGENT_DIRECTION\n" : "")
+        .addSource(flags & Flag::BitangentDirection ? "#define BITANGENT_DIRECTION\n" : "")
+        .addSource(flags & Flag::NormalDirection ? "#define NORMAL_DIRECTION\n" : "");
+    if(flags & LineFlags)
+        comp.addSource(Utility::formatString("#define LINE_COUNT_PER_VERTEX {}\n", out.lineCountPerVertex()));
+    comp.addSource(rs.getString("MeshVisualizerPrepass.comp"));
+
+    /* If a matching program binary is cached, there's nothing to compile
+       or link */
+    const bool cached = out.loadCachedBinary({comp});
+    if(!cached) {
+        comp.submitCompile();
+        out.attachShader(comp);
+        out.submitLink();
+    }
+
+    return CompileState{std::move(out), std::move(comp), cached};
+}
+
+MeshVisualizerPrepassGL::MeshVisualizerPrepassGL(CompileState&& state): MeshVisualizerPrepassGL{static_cast<MeshVisualizerPrepassGL&&>(std::move(state))} {
+    #ifdef CORRADE_GRACEFUL_ASSERT
+    /* When graceful assertions fire from within compile(), we get a
+       NoCreate'd CompileState. Exiting makes it possible to test the
+       assert. */
+    if(!id()) return;
+    #endif
+
+    /* If the program was loaded from the binary cache, there's nothing to
+       check */
+    if(!state._cached) {
+        CORRADE_INTERNAL_ASSERT_OUTPUT(state._comp.checkCompile());
+        CORRADE_INTERNAL_ASSERT_OUTPUT(checkLink());
+        saveCachedBinary({state._comp});
+    }
+
+    /* All bindings and uniform locations are specified in the shader code
+       directly, only set the default uniform value */
+    if(_flags & LineFlags)
+        setLineLength(1.0f);
+}
+
+MeshVisualizerPrepassGL::MeshVisualizerPrepassGL(const Flags flags): MeshVisualizerPrepassGL{compile(flags)} {}
+
+UnsignedInt MeshVisualizerPrepassGL::lineCountPerVertex() const {
+    return (_flags & Flag::TangentDirection ? 1 : 0) +
+           (_flags & (Flag::BitangentFromTangentDirection|Flag::BitangentDirection) ? 1 : 0) +
+           (_flags & Flag::NormalDirection ? 1 : 0);
+}
+
+MeshVisualizerPrepassGL& MeshVisualizerPrepassGL::setLineLength(const Float length) {
+    CORRADE_ASSERT(_flags & LineFlags,
+        "Shaders::MeshVisualizerPrepassGL::setLineLength(): the shader was not created with TBN direction enabled", *this);
+    setUniform(LineLengthUniform, length);
+    return *this;
+}
+
+MeshVisualizerPrepassGL& MeshVisualizerPrepassGL::bindPositionBuffer(GL::Buffer& buffer) {
+    buffer.bind(GL::Buffer::Target::ShaderStorage, PositionBufferBinding);
+    return *this;
+}
+
+MeshVisualizerPrepassGL& MeshVisualizerPrepassGL::bindPositionBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    buffer.bind(GL::Buffer::Target::ShaderStorage, PositionBufferBinding, offset, size);
+    return *this;
+}
+
+MeshVisualizerPrepassGL& MeshVisualizerPrepassGL::bindIndexBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags & Flag::Wireframe,
+        "Shaders::MeshVisualizerPrepassGL::bindIndexBuffer(): the shader was not created with wireframe enabled", *this);
+    buffer.bind(GL::Buffer::Target::ShaderStorage, IndexBufferBinding);
+    return *this;
+}
+
+MeshVisualizerPrepassGL& MeshVisualizerPrepassGL::bindIndexBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags & Flag::Wireframe,
+        "Shaders::MeshVisualizerPrepassGL::bindIndexBuffer(): the shader was not created with wireframe enabled", *this);
+    buffer.bind(GL::Buffer::Target::ShaderStorage, IndexBufferBinding, offset, size);
+    return *this;
+}
+
+MeshVisualizerPrepassGL& MeshVisualizerPrepassGL::bindNormalBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags & (Flag::NormalDirection|Flag::BitangentFromTangentDirection),
+        "Shaders::MeshVisualizerPrepassGL::bindNormalBuffer(): the shader was not created with normal direction enabled", *this);
+    buffer.bind(GL::Buffer::Target::ShaderStorage, NormalBufferBinding);
+    return *this;
+}
+
+MeshVisualizerPrepassGL& MeshVisualizerPrepassGL::bindNormalBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags & (Flag::NormalDirection|Flag::BitangentFromTangentDirection),
+        "Shaders::MeshVisualizerPrepassGL::bindNormalBuffer(): the shader was not created with normal direction enabled", *this);
+    buffer.bind(GL::Buffer::Target::ShaderStorage, NormalBufferBinding, offset, size);
+    return *this;
+}
+
+MeshVisualizerPrepassGL& MeshVisualizerPrepassGL::bindTangentBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags & (Flag::TangentDirection|Flag::BitangentFromTangentDirection),
+        "Shaders::MeshVisualizerPrepassGL::bindTangentBuffer(): the shader was not created with tangent direction enabled", *this);
+    buffer.bind(GL::Buffer::Target::ShaderStorage, TangentBufferBinding);
+    return *this;
+}
+
+MeshVisualizerPrepassGL& MeshVisualizerPrepassGL::bindTangentBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags & (Flag::TangentDirection|Flag::BitangentFromTangentDirection),
+        "Shaders::MeshVisualizerPrepassGL::bindTangentBuffer(): the shader was not created with tangent direction enabled", *this);
+    buffer.bind(GL::Buffer::Target::ShaderStorage, TangentBufferBinding, offset, size);
+    return *this;
+}
+
+MeshVisualizerPrepassGL& MeshVisualizerPrepassGL::bindBitangentBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags & Flag::BitangentDirection,
+        "Shaders::MeshVisualizerPrepassGL::bindBitangentBuffer(): the shader was not created with bitangent direction enabled", *this);
+    buffer.bind(GL::Buffer::Target::ShaderStorage, BitangentBufferBinding);
+    return *this;
+}
+
+MeshVisualizerPrepassGL& MeshVisualizerPrepassGL::bindBitangentBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags & Flag::BitangentDirection,
+        "Shaders::MeshVisualizerPrepassGL::bindBitangentBuffer(): the shader was not created with bitangent direction enabled", *this);
+    buffer.bind(GL::Buffer::Target::ShaderStorage, BitangentBufferBinding, offset, size);
+    return *this;
+}
+
+MeshVisualizerPrepassGL& MeshVisualizerPrepassGL::bindWireframeBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags & Flag::Wireframe,
+        "Shaders::MeshVisualizerPrepassGL::bindWireframeBuffer(): the shader was not created with wireframe enabled", *this);
+    buffer.bind(GL::Buffer::Target::ShaderStorage, WireframeBufferBinding);
+    return *this;
+}
+
+MeshVisualizerPrepassGL& MeshVisualizerPrepassGL::bindWireframeBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags & Flag::Wireframe,
+        "Shaders::MeshVisualizerPrepassGL::bindWireframeBuffer(): the shader was not created with wireframe enabled", *this);
+    buffer.bind(GL::Buffer::Target::ShaderStorage, WireframeBufferBinding, offset, size);
+    return *this;
+}
+
+MeshVisualizerPrepassGL& MeshVisualizerPrepassGL::bindLineBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags & LineFlags,
+        "Shaders::MeshVisualizerPrepassGL::bindLineBuffer(): the shader was not created with TBN direction enabled", *this);
+    buffer.bind(GL::Buffer::Target::ShaderStorage, LineBufferBinding);
+    return *this;
+}
+
+MeshVisualizerPrepassGL& MeshVisualizerPrepassGL::bindLineBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags & LineFlags,
+        "Shaders::MeshVisualizerPrepassGL::bindLineBuffer(): the shader was not created with TBN direction enabled", *this);
+    buffer.bind(GL::Buffer::Target::ShaderStorage, LineBufferBinding, offset, size);
+    return *this;
+}
+
+MeshVisualizerPrepassGL& MeshVisualizerPrepassGL::generate(const UnsignedInt vertexCount, const UnsignedInt indexCount) {
+    CORRADE_ASSERT(vertexCount,
+        "Shaders::MeshVisualizerPrepassGL::generate(): expected a non-zero vertex count", *this);
+    CORRADE_ASSERT(!(_flags & Flag::Wireframe) || (indexCount && indexCount % 3 == 0),
+        "Shaders::MeshVisualizerPrepassGL::generate(): expected a non-zero index count divisible by 3 but got" << indexCount, *this);
+
+    /* Each invocation processes one index and one vertex at most */
+    UnsignedInt invocationCount = 0;
+    if(_flags & Flag::Wireframe) {
+        setUniform(IndexCountUniform, indexCount);
+        invocationCount = indexCount;
+    }
+    if(_flags & LineFlags) {
+        setUniform(VertexCountUniform, vertexCount);
+        invocationCount = Math::max(invocationCount, vertexCount);
+    }
+
+    /* The X work group count is guaranteed to be at least 65535, spread
+       larger meshes across Y */
+    const UnsignedInt groupCount = (invocationCount + GroupSize - 1)/GroupSize;
+    const UnsignedInt groupCountX = Math::min(groupCount, 65535u);
+    dispatchCompute({groupCountX, (groupCount + groupCountX - 1)/groupCountX, 1});
+    return *this;
+}
+
+Debug& operator<<(Debug& debug, const MeshVisualizerPrepassGL::Flag value) {
+    debug << "Shaders::MeshVisualizerPrepassGL::Flag" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(v) case MeshVisualizerPrepassGL::Flag::v: return debug << "::" #v;
+        _c(Wireframe)
+        _c(TangentDirection)
+        _c(BitangentFromTangentDirection)
+        _c(BitangentDirection)
+        _c(NormalDirection)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+Debug& operator<<(Debug& debug, const MeshVisualizerPrepassGL::Flags value) {
+    return Containers::enumSetDebugOutput(debug, value, "Shaders::MeshVisualizerPrepassGL::Flags{}", {
+        MeshVisualizerPrepassGL::Flag::Wireframe,
+        MeshVisualizerPrepassGL::Flag::TangentDirection,
+        MeshVisualizerPrepassGL::Flag::BitangentFromTangentDirection,
+        MeshVisualizerPrepassGL::Flag::BitangentDirection,
+        MeshVisualizerPrepassGL::Flag::NormalDirection
+    });
+}
+
+}}
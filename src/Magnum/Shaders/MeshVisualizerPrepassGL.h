@@ -0,0 +1,396 @@
+#ifndef Magnum_Shaders_MeshVisualizerPrepassGL_h
+#define Magnum_Shaders_MeshVisualizerPrepassGL_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+/** @file
+ * @brief Class @ref Magnum::Shaders::MeshVisualizerPrepassGL
+ * @m_since_latest
+ */
+#endif
+
+#include <Corrade/Containers/EnumSet.h>
+
+#include "Magnum/GL/AbstractShaderProgram.h"
+#include "Magnum/GL/Shader.h"
+#include "Magnum/Shaders/visibility.h"
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+namespace Magnum { namespace Shaders {
+
+/**
+@brief Mesh visualizer preprocessing OpenGL compute shader
+@m_since_latest
+
+Generates data for visualizing a mesh wireframe and tangent space with
+@ref MeshVisualizerGL3D without a geometry shader, which is slow or
+unavailable on many GPUs. The data is generated once per mesh on the GPU, so
+there's no need to download or duplicate the mesh on the CPU and the
+subsequent draws have no per-primitive overhead.
+
+@section Shaders-MeshVisualizerPrepassGL-wireframe Wireframe
+
+@ref MeshVisualizerGL3D::Flag::NoGeometryShader derives barycentric
+coordinates from @glsl gl_VertexID @ce, which works only for non-indexed
+meshes. With @ref Flag::Wireframe, the shader reads an index buffer bound
+with @ref bindIndexBuffer() and writes, for each index, the position it
+references to a buffer bound with @ref bindWireframeBuffer(). The output
+contains tightly packed @ref Magnum::Vector3 "Vector3" positions and is meant
+to be drawn as a non-indexed @ref MeshPrimitive::Triangles mesh with the
+@ref MeshVisualizerGL3D::Position attribute:
+
+@snippet MagnumShaders-gl.cpp MeshVisualizerPrepassGL-wireframe
+
+Other vertex attributes are not de-indexed, so this path is usable only for
+visualization features that need just the position.
+
+@section Shaders-MeshVisualizerPrepassGL-tbn Tangent space
+
+With @ref Flag::TangentDirection, @ref Flag::BitangentFromTangentDirection,
+@ref Flag::BitangentDirection or @ref Flag::NormalDirection, the shader
+writes, for each vertex and each enabled direction, a line segment starting
+at the vertex position to a buffer bound with @ref bindLineBuffer(). Each
+line vertex is a @ref Magnum::Vector3 "Vector3" position followed by a
+@ref Magnum::Color4 "Color4", with tangents colored red, bitangents green and
+normals blue like in @ref MeshVisualizerGL3D. The output is meant to be drawn
+as a @ref MeshPrimitive::Lines mesh with @ref VertexColorGL3D, for example on
+top of a wireframe rendered through the above:
+
+@snippet MagnumShaders-gl.cpp MeshVisualizerPrepassGL-tbn
+
+Compared to the geometry shader implementation, the lines are generated in
+object space, so the length set with @ref setLineLength() is in object space
+as well, and they're rasterized with the implementation-defined line width
+instead of being expanded to smooth quads.
+
+The input attributes are expected in tightly packed shader storage buffers,
+with positions, normals and bitangents being @ref Magnum::Vector3 "Vector3"
+and tangents @ref Magnum::Vector4 "Vector4", and indices being
+@ref Magnum::UnsignedInt "UnsignedInt". Meshes with 8- or 16-bit indices or
+interleaved attributes need to be repacked first.
+
+@requires_gl43 Extensions @gl_extension{ARB,compute_shader} and
+    @gl_extension{ARB,shader_storage_buffer_object}
+@requires_gles31 Compute shaders and shader storage buffers are not available
+    in OpenGL ES 3.0 and older.
+@requires_gles Compute shaders are not available in WebGL.
+*/
+class MAGNUM_SHADERS_EXPORT MeshVisualizerPrepassGL: public GL::AbstractShaderProgram {
+    public:
+        class CompileState;
+
+        /**
+         * @brief Flag
+         *
+         * @see @ref Flags, @ref flags()
+         */
+        enum class Flag: UnsignedByte {
+            /**
+             * Generate de-indexed positions for wireframe visualization. See
+             * @ref Shaders-MeshVisualizerPrepassGL-wireframe for more
+             * information.
+             * @see @ref bindIndexBuffer(), @ref bindWireframeBuffer()
+             */
+            Wireframe = 1 << 0,
+
+            /**
+             * Generate tangent direction lines. See
+             * @ref Shaders-MeshVisualizerPrepassGL-tbn for more information.
+             * @see @ref bindTangentBuffer(), @ref bindLineBuffer()
+             */
+            TangentDirection = 1 << 1,
+
+            /**
+             * Generate bitangent direction lines from normals and the fourth
+             * component of tangents. Mutually exclusive with
+             * @ref Flag::BitangentDirection.
+             * @see @ref bindNormalBuffer(), @ref bindTangentBuffer(),
+             *      @ref bindLineBuffer()
+             */
+            BitangentFromTangentDirection = 1 << 2,
+
+            /**
+             * Generate bitangent direction lines. Mutually exclusive with
+             * @ref Flag::BitangentFromTangentDirection.
+             * @see @ref bindBitangentBuffer(), @ref bindLineBuffer()
+             */
+            BitangentDirection = 1 << 3,
+
+            /**
+             * Generate normal direction lines.
+             * @see @ref bindNormalBuffer(), @ref bindLineBuffer()
+             */
+            NormalDirection = 1 << 4
+        };
+
+        /**
+         * @brief Flags
+         *
+         * @see @ref flags()
+         */
+        typedef Containers::EnumSet<Flag> Flags;
+
+        /**
+         * @brief Compile asynchronously
+         *
+         * Compared to @ref MeshVisualizerPrepassGL(Flags) can perform an
+         * asynchronous compilation and linking. See @ref shaders-async for
+         * more information.
+         * @see @ref MeshVisualizerPrepassGL(CompileState&&)
+         */
+        static CompileState compile(Flags flags);
+
+        /**
+         * @brief Constructor
+         * @param flags     Flags
+         *
+         * At least one flag is expected to be enabled.
+         */
+        explicit MeshVisualizerPrepassGL(Flags flags);
+
+        /**
+         * @brief Finalize an asynchronous compilation
+         *
+         * Takes an asynchronous compilation state returned by @ref compile()
+         * and forms a ready-to-use shader object. See @ref shaders-async for
+         * more information.
+         */
+        explicit MeshVisualizerPrepassGL(CompileState&& state);
+
+        /**
+         * @brief Construct without creating the underlying OpenGL object
+         *
+         * The constructed instance is equivalent to a moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         *
+         * This function can be safely used for constructing (and later
+         * destructing) objects even without any OpenGL context being active.
+         * However note that this is a low-level and a potentially dangerous
+         * API, see the documentation of @ref NoCreate for alternatives.
+         */
+        explicit MeshVisualizerPrepassGL(NoCreateT) noexcept: AbstractShaderProgram{NoCreate} {}
+
+        /** @brief Copying is not allowed */
+        MeshVisualizerPrepassGL(const MeshVisualizerPrepassGL&) = delete;
+
+        /** @brief Move constructor */
+        MeshVisualizerPrepassGL(MeshVisualizerPrepassGL&&) noexcept = default;
+
+        /** @brief Copying is not allowed */
+        MeshVisualizerPrepassGL& operator=(const MeshVisualizerPrepassGL&) = delete;
+
+        /** @brief Move assignment */
+        MeshVisualizerPrepassGL& operator=(MeshVisualizerPrepassGL&&) noexcept = default;
+
+        /** @brief Flags */
+        Flags flags() const { return _flags; }
+
+        /**
+         * @brief Count of generated lines per vertex
+         *
+         * Count of enabled @ref Flag::TangentDirection,
+         * @ref Flag::BitangentFromTangentDirection,
+         * @ref Flag::BitangentDirection and @ref Flag::NormalDirection flags.
+         * The buffer bound with @ref bindLineBuffer() is expected to have
+         * space for @cpp 2*lineCountPerVertex() @ce line vertices for each
+         * vertex.
+         */
+        UnsignedInt lineCountPerVertex() const;
+
+        /**
+         * @brief Set line length
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that at least one of @ref Flag::TangentDirection,
+         * @ref Flag::BitangentFromTangentDirection,
+         * @ref Flag::BitangentDirection and @ref Flag::NormalDirection is
+         * enabled. The directions are normalized and the length is in
+         * object space. Initial value is @cpp 1.0f @ce.
+         */
+        MeshVisualizerPrepassGL& setLineLength(Float length);
+
+        /** @{
+         * @name Buffer binding
+         */
+
+        /**
+         * @brief Bind a position storage buffer
+         * @return Reference to self (for method chaining)
+         *
+         * The buffer is expected to contain tightly packed
+         * @ref Magnum::Vector3 "Vector3" positions.
+         */
+        MeshVisualizerPrepassGL& bindPositionBuffer(GL::Buffer& buffer);
+        /** @overload */
+        MeshVisualizerPrepassGL& bindPositionBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Bind an index storage buffer
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @ref Flag::Wireframe is enabled. The buffer is
+         * expected to contain @ref Magnum::UnsignedInt "UnsignedInt" indices
+         * of a @ref MeshPrimitive::Triangles mesh.
+         */
+        MeshVisualizerPrepassGL& bindIndexBuffer(GL::Buffer& buffer);
+        /** @overload */
+        MeshVisualizerPrepassGL& bindIndexBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Bind a normal storage buffer
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @ref Flag::NormalDirection or
+         * @ref Flag::BitangentFromTangentDirection is enabled. The buffer is
+         * expected to contain tightly packed @ref Magnum::Vector3 "Vector3"
+         * normals.
+         */
+        MeshVisualizerPrepassGL& bindNormalBuffer(GL::Buffer& buffer);
+        /** @overload */
+        MeshVisualizerPrepassGL& bindNormalBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Bind a tangent storage buffer
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @ref Flag::TangentDirection or
+         * @ref Flag::BitangentFromTangentDirection is enabled. The buffer is
+         * expected to contain tightly packed @ref Magnum::Vector4 "Vector4"
+         * tangents, with the fourth component being the bitangent sign.
+         */
+        MeshVisualizerPrepassGL& bindTangentBuffer(GL::Buffer& buffer);
+        /** @overload */
+        MeshVisualizerPrepassGL& bindTangentBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Bind a bitangent storage buffer
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @ref Flag::BitangentDirection is enabled. The buffer
+         * is expected to contain tightly packed @ref Magnum::Vector3 "Vector3"
+         * bitangents.
+         */
+        MeshVisualizerPrepassGL& bindBitangentBuffer(GL::Buffer& buffer);
+        /** @overload */
+        MeshVisualizerPrepassGL& bindBitangentBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Bind a wireframe output storage buffer
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @ref Flag::Wireframe is enabled. The buffer is
+         * expected to have space for a @ref Magnum::Vector3 "Vector3" for
+         * each index. See @ref Shaders-MeshVisualizerPrepassGL-wireframe for
+         * more information.
+         */
+        MeshVisualizerPrepassGL& bindWireframeBuffer(GL::Buffer& buffer);
+        /** @overload */
+        MeshVisualizerPrepassGL& bindWireframeBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Bind a line output storage buffer
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that at least one of @ref Flag::TangentDirection,
+         * @ref Flag::BitangentFromTangentDirection,
+         * @ref Flag::BitangentDirection and @ref Flag::NormalDirection is
+         * enabled. The buffer is expected to have space for
+         * @cpp 2*lineCountPerVertex() @ce pairs of a
+         * @ref Magnum::Vector3 "Vector3" and a @ref Magnum::Color4 "Color4"
+         * for each vertex. See @ref Shaders-MeshVisualizerPrepassGL-tbn for
+         * more information.
+         */
+        MeshVisualizerPrepassGL& bindLineBuffer(GL::Buffer& buffer);
+        /** @overload */
+        MeshVisualizerPrepassGL& bindLineBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @}
+         */
+
+        /**
+         * @brief Generate the visualization data
+         * @param vertexCount   Count of vertices in the bound attribute
+         *      buffers
+         * @param indexCount    Count of indices in the buffer bound with
+         *      @ref bindIndexBuffer()
+         * @return Reference to self (for method chaining)
+         *
+         * The @p vertexCount is expected to be non-zero and the @p indexCount
+         * a non-zero multiple of three if @ref Flag::Wireframe is enabled.
+         * The work is split into as many work groups as needed, so there's no
+         * limit on the mesh size other than the buffer sizes.
+         * @see @ref GL::Renderer::setMemoryBarrier()
+         */
+        MeshVisualizerPrepassGL& generate(UnsignedInt vertexCount, UnsignedInt indexCount = 0);
+
+    private:
+        /* Creates the GL shader program object but does nothing else.
+           Internal, used by compile(). */
+        explicit MeshVisualizerPrepassGL(NoInitT) {}
+
+        /* Prevent accidentally calling irrelevant functions */
+        using GL::AbstractShaderProgram::draw;
+        #ifndef MAGNUM_TARGET_GLES
+        using GL::AbstractShaderProgram::drawTransformFeedback;
+        #endif
+
+        Flags _flags;
+};
+
+/**
+@brief Asynchronous compilation state
+@m_since_latest
+
+Returned by @ref compile(). See @ref shaders-async for more information.
+*/
+class MeshVisualizerPrepassGL::CompileState: public MeshVisualizerPrepassGL {
+    /* Everything deliberately private except for the inheritance */
+    friend class MeshVisualizerPrepassGL;
+
+    explicit CompileState(NoCreateT): MeshVisualizerPrepassGL{NoCreate}, _comp{NoCreate} {}
+
+    explicit CompileState(MeshVisualizerPrepassGL&& shader, GL::Shader&& comp, bool cached): MeshVisualizerPrepassGL{std::move(shader)}, _comp{std::move(comp)}, _cached{cached} {}
+
+    GL::Shader _comp;
+    bool _cached;
+};
+
+/** @debugoperatorclassenum{MeshVisualizerPrepassGL,MeshVisualizerPrepassGL::Flag} */
+MAGNUM_SHADERS_EXPORT Debug& operator<<(Debug& debug, MeshVisualizerPrepassGL::Flag value);
+
+/** @debugoperatorclassenum{MeshVisualizerPrepassGL,MeshVisualizerPrepassGL::Flags} */
+MAGNUM_SHADERS_EXPORT Debug& operator<<(Debug& debug, MeshVisualizerPrepassGL::Flags value);
+
+CORRADE_ENUMSET_OPERATORS(MeshVisualizerPrepassGL::Flags)
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 and WebGL build
+#endif
+
+#endif
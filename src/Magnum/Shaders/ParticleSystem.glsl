@@ -0,0 +1,104 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef RUNTIME_CONST
+#define const
+#endif
+
+/* Shared between ParticleSystem.comp and ParticleSystem.vert. Uniform
+   locations are queried by name in ParticleSystemGL.cpp, as the transform
+   feedback variant can't rely on explicit uniform locations being
+   available. */
+
+uniform highp uint seed;
+uniform highp float timeDelta;
+
+uniform highp vec3 emitterPosition;
+uniform highp float emitterRadius;
+uniform highp vec3 velocity;
+uniform highp float velocitySpread;
+uniform highp vec2 lifetimeRange;
+uniform highp vec3 acceleration;
+uniform highp float drag;
+
+uniform lowp vec4 startColor;
+uniform lowp vec4 endColor;
+uniform highp vec2 sizeRange;
+uniform highp mat3 billboardRotation;
+
+/* PCG-based integer hash, good enough for decorrelating neighboring particle
+   IDs without any state kept between frames */
+highp uint hash(highp uint value) {
+    highp const uint state = value*747796405u + 2891336453u;
+    highp const uint word = ((state >> ((state >> 28u) + 4u)) ^ state)*277803737u;
+    return (word >> 22u) ^ word;
+}
+
+/* Uniformly distributed value in [0, 1) */
+highp float random(inout highp uint state) {
+    state = hash(state);
+    return float(state >> 8u)*(1.0/16777216.0);
+}
+
+/* Uniformly distributed point inside a unit sphere */
+highp vec3 randomInSphere(inout highp uint state) {
+    highp const float z = random(state)*2.0 - 1.0;
+    highp const float angle = random(state)*6.28318530718;
+    highp const float radius = sqrt(max(1.0 - z*z, 0.0));
+    return vec3(radius*cos(angle), radius*sin(angle), z)*pow(random(state), 1.0/3.0);
+}
+
+/* A particle is stored as two vec4s, position and age in the first,
+   velocity and lifetime in the second. A zero-initialized particle is dead. */
+
+bool isAlive(highp vec4 positionAge, highp vec4 velocityLifetime) {
+    return positionAge.w < velocityLifetime.w;
+}
+
+void spawn(highp uint id, out highp vec4 positionAge, out highp vec4 velocityLifetime) {
+    highp uint state = hash(id ^ hash(seed));
+    positionAge = vec4(emitterPosition + randomInSphere(state)*emitterRadius, 0.0);
+    highp const vec3 particleVelocity = velocity + randomInSphere(state)*velocitySpread;
+    velocityLifetime = vec4(particleVelocity, mix(lifetimeRange.x, lifetimeRange.y, random(state)));
+}
+
+void integrate(inout highp vec4 positionAge, inout highp vec4 velocityLifetime) {
+    velocityLifetime.xyz = (velocityLifetime.xyz + acceleration*timeDelta)*max(1.0 - drag*timeDelta, 0.0);
+    positionAge.xyz += velocityLifetime.xyz*timeDelta;
+    positionAge.w += timeDelta;
+}
+
+/* Camera-facing transformation and color interpolated over the particle
+   lifetime. Dead particles get a zero scale so they don't rasterize. */
+void instance(highp vec4 positionAge, highp vec4 velocityLifetime, out highp mat4 transformation, out lowp vec4 color) {
+    highp const float t = clamp(positionAge.w/max(velocityLifetime.w, 0.000001), 0.0, 1.0);
+    highp const float size = isAlive(positionAge, velocityLifetime) ?
+        mix(sizeRange.x, sizeRange.y, t) : 0.0;
+    transformation = mat4(vec4(billboardRotation[0]*size, 0.0),
+                          vec4(billboardRotation[1]*size, 0.0),
+                          vec4(billboardRotation[2]*size, 0.0),
+                          vec4(positionAge.xyz, 1.0));
+    color = mix(startColor, endColor, t);
+}
@@ -0,0 +1,78 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/* Preceded by ParticleSystem.glsl. Either UPDATE or INSTANCES is defined. */
+
+#ifdef UPDATE
+uniform highp uint capacity;
+uniform highp uint emitBegin;
+uniform highp uint emitCount;
+#endif
+
+/* Inputs, attribute locations are bound in ParticleSystemGL.cpp */
+
+in highp vec4 positionAge;
+in highp vec4 velocityLifetime;
+
+/* Outputs, captured with transform feedback */
+
+#ifdef UPDATE
+out highp vec4 outputPositionAge;
+out highp vec4 outputVelocityLifetime;
+#elif defined(INSTANCES)
+out highp vec4 transformationColumn0;
+out highp vec4 transformationColumn1;
+out highp vec4 transformationColumn2;
+out highp vec4 transformationColumn3;
+out lowp vec4 instanceColor;
+#else
+#error either UPDATE or INSTANCES has to be defined
+#endif
+
+void main() {
+    #ifdef UPDATE
+    outputPositionAge = positionAge;
+    outputVelocityLifetime = velocityLifetime;
+
+    /* The buffer is a ring, newly emitted particles replace the oldest
+       slots */
+    highp const uint id = uint(gl_VertexID);
+    if((id + capacity - emitBegin) % capacity < emitCount)
+        spawn(id, outputPositionAge, outputVelocityLifetime);
+    else if(isAlive(positionAge, velocityLifetime))
+        integrate(outputPositionAge, outputVelocityLifetime);
+
+    #elif defined(INSTANCES)
+    highp mat4 transformation;
+    instance(positionAge, velocityLifetime, transformation, instanceColor);
+    transformationColumn0 = transformation[0];
+    transformationColumn1 = transformation[1];
+    transformationColumn2 = transformation[2];
+    transformationColumn3 = transformation[3];
+    #endif
+
+    /* Nothing gets rasterized */
+    gl_Position = vec4(0.0);
+}
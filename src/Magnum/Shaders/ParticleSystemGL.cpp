@@ -0,0 +1,597 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ParticleSystemGL.h"
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Reference.h>
+#include <Corrade/Utility/Resource.h>
+
+#include "Magnum/GL/AbstractShaderProgram.h"
+#include "Magnum/GL/Attribute.h"
+#include "Magnum/GL/Buffer.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/Mesh.h"
+#include "Magnum/GL/Renderer.h"
+#include "Magnum/GL/Shader.h"
+#include "Magnum/GL/TransformFeedback.h"
+#include "Magnum/GL/Version.h"
+#include "Magnum/Math/Functions.h"
+
+#include "Magnum/Shaders/Implementation/CreateCompatibilityShader.h"
+
+namespace Magnum { namespace Shaders {
+
+namespace {
+
+#ifndef MAGNUM_TARGET_WEBGL
+/* Keep in sync with GROUP_SIZE in ParticleSystem.comp */
+constexpr UnsignedInt GroupSize = 64;
+
+enum: UnsignedInt {
+    InputParticleBufferBinding = 0,
+    OutputParticleBufferBinding = 1,
+    InstanceBufferBinding = 2,
+    CounterBufferBinding = 3,
+    CommandBufferBinding = 4
+};
+
+/* Keep in sync with PASS_* in ParticleSystem.comp */
+enum: Int {
+    UpdatePass = 0,
+    EmitPass = 1,
+    FinalizePass = 2
+};
+
+/* Offset of the indirect dispatch workgroup count in the counter buffer */
+constexpr GLintptr DispatchOffset = 2*sizeof(UnsignedInt);
+#endif
+
+/* Two vec4s, see ParticleSystem.glsl */
+constexpr std::size_t ParticleSize = 2*sizeof(Vector4);
+
+/* Both the transform feedback and the compute variant. Uniform locations are
+   queried by name as the transform feedback variant runs on GL 3.0 / ES 3.0
+   where explicit uniform locations aren't guaranteed. Uniforms not used by
+   given variant get -1, for which setUniform() is a no-op. */
+class ParticleShaderGL: public GL::AbstractShaderProgram {
+    public:
+        typedef GL::Attribute<0, Vector4> PositionAge;
+        typedef GL::Attribute<1, Vector4> VelocityLifetime;
+
+        explicit ParticleShaderGL(NoCreateT): GL::AbstractShaderProgram{NoCreate} {}
+
+        /* Transform feedback update or instance pass */
+        explicit ParticleShaderGL(const Utility::Resource& rs, bool update);
+
+        #ifndef MAGNUM_TARGET_WEBGL
+        /* Compute update, emit and finalize passes */
+        explicit ParticleShaderGL(const Utility::Resource& rs);
+        #endif
+
+        ParticleShaderGL& setParameters(const Vector3& emitterPosition, Float emitterRadius, const Vector3& velocity, Float velocitySpread, const Vector2& lifetime, const Vector3& acceleration, Float drag, const Color4& startColor, const Color4& endColor, const Vector2& size) {
+            setUniform(_emitterPositionUniform, emitterPosition);
+            setUniform(_emitterRadiusUniform, emitterRadius);
+            setUniform(_velocityUniform, velocity);
+            setUniform(_velocitySpreadUniform, velocitySpread);
+            setUniform(_lifetimeRangeUniform, lifetime);
+            setUniform(_accelerationUniform, acceleration);
+            setUniform(_dragUniform, drag);
+            setUniform(_startColorUniform, startColor);
+            setUniform(_endColorUniform, endColor);
+            setUniform(_sizeRangeUniform, size);
+            return *this;
+        }
+
+        ParticleShaderGL& setFrame(UnsignedInt seed, Float timeDelta, const Matrix3x3& billboardRotation, UnsignedInt capacity) {
+            setUniform(_seedUniform, seed);
+            setUniform(_timeDeltaUniform, timeDelta);
+            setUniform(_billboardRotationUniform, billboardRotation);
+            setUniform(_capacityUniform, capacity);
+            return *this;
+        }
+
+        ParticleShaderGL& setEmit(UnsignedInt begin, UnsignedInt count) {
+            setUniform(_emitBeginUniform, begin);
+            setUniform(_emitCountUniform, count);
+            return *this;
+        }
+
+        #ifndef MAGNUM_TARGET_WEBGL
+        ParticleShaderGL& setPass(Int pass) {
+            setUniform(_passUniform, pass);
+            return *this;
+        }
+        #endif
+
+    private:
+        void initializeUniformLocations();
+
+        Int _seedUniform,
+            _timeDeltaUniform,
+            _emitterPositionUniform,
+            _emitterRadiusUniform,
+            _velocityUniform,
+            _velocitySpreadUniform,
+            _lifetimeRangeUniform,
+            _accelerationUniform,
+            _dragUniform,
+            _startColorUniform,
+            _endColorUniform,
+            _sizeRangeUniform,
+            _billboardRotationUniform,
+            _capacityUniform,
+            _emitBeginUniform,
+            _emitCountUniform,
+            _passUniform;
+};
+
+ParticleShaderGL::ParticleShaderGL(const Utility::Resource& rs, const bool update) {
+    #ifndef MAGNUM_TARGET_GLES
+    const GL::Version version = GL::Version::GL300;
+    #else
+    const GL::Version version = GL::Version::GLES300;
+    #endif
+
+    GL::Shader vert = Implementation::createCompatibilityShader(rs, version, GL::Shader::Type::Vertex);
+    vert.addSource(update ? "#define UPDATE\n" : "#define INSTANCES\n")
+        .addSource(rs.getString("ParticleSystem.glsl"))
+        .addSource(rs.getString("ParticleSystem.vert"));
+
+    /* ES requires a fragment shader even if nothing is rasterized */
+    #ifdef MAGNUM_TARGET_GLES
+    GL::Shader frag = Implementation::createCompatibilityShader(rs, version, GL::Shader::Type::Fragment);
+    frag.addSource(rs.getString("ParticleSystem.frag"));
+    CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::compile({vert, frag}));
+    attachShaders({vert, frag});
+    #else
+    CORRADE_INTERNAL_ASSERT_OUTPUT(vert.compile());
+    attachShader(vert);
+    #endif
+
+    bindAttributeLocation(PositionAge::Location, "positionAge");
+    bindAttributeLocation(VelocityLifetime::Location, "velocityLifetime");
+    if(update) setTransformFeedbackOutputs({
+        "outputPositionAge",
+        "outputVelocityLifetime"
+    }, TransformFeedbackBufferMode::InterleavedAttributes);
+    else setTransformFeedbackOutputs({
+        "transformationColumn0",
+        "transformationColumn1",
+        "transformationColumn2",
+        "transformationColumn3",
+        "instanceColor"
+    }, TransformFeedbackBufferMode::InterleavedAttributes);
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+
+    initializeUniformLocations();
+}
+
+#ifndef MAGNUM_TARGET_WEBGL
+ParticleShaderGL::ParticleShaderGL(const Utility::Resource& rs) {
+    #ifndef MAGNUM_TARGET_GLES
+    const GL::Version version = GL::Version::GL430;
+    #else
+    const GL::Version version = GL::Version::GLES310;
+    #endif
+
+    GL::Shader comp = Implementation::createCompatibilityShader(rs, version, GL::Shader::Type::Compute);
+    comp.addSource(rs.getString("ParticleSystem.glsl"))
+        .addSource(rs.getString("ParticleSystem.comp"));
+    CORRADE_INTERNAL_ASSERT_OUTPUT(comp.compile());
+    attachShader(comp);
+    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+
+    /* Buffer bindings are specified in the shader code directly */
+    initializeUniformLocations();
+}
+#endif
+
+void ParticleShaderGL::initializeUniformLocations() {
+    _seedUniform = uniformLocation("seed");
+    _timeDeltaUniform = uniformLocation("timeDelta");
+    _emitterPositionUniform = uniformLocation("emitterPosition");
+    _emitterRadiusUniform = uniformLocation("emitterRadius");
+    _velocityUniform = uniformLocation("velocity");
+    _velocitySpreadUniform = uniformLocation("velocitySpread");
+    _lifetimeRangeUniform = uniformLocation("lifetimeRange");
+    _accelerationUniform = uniformLocation("acceleration");
+    _dragUniform = uniformLocation("drag");
+    _startColorUniform = uniformLocation("startColor");
+    _endColorUniform = uniformLocation("endColor");
+    _sizeRangeUniform = uniformLocation("sizeRange");
+    _billboardRotationUniform = uniformLocation("billboardRotation");
+    _capacityUniform = uniformLocation("capacity");
+    _emitBeginUniform = uniformLocation("emitBegin");
+    _emitCountUniform = uniformLocation("emitCount");
+    _passUniform = uniformLocation("pass");
+}
+
+}
+
+struct ParticleSystemGL::State {
+    Backend backend = Backend::TransformFeedback;
+    UnsignedInt capacity{};
+
+    Vector3 emitterPosition;
+    Float emitterRadius{};
+    Vector3 velocity;
+    Float velocitySpread{};
+    Vector2 lifetime{1.0f};
+    Vector3 acceleration;
+    Float drag{};
+    Color4 startColor{1.0f};
+    Color4 endColor{1.0f};
+    Vector2 size{1.0f};
+    /* Set when any of the above changes, parameters are uploaded to the
+       shaders lazily in update() */
+    bool parametersDirty = true;
+
+    UnsignedInt emitCount{};
+    /* Incremented every update() to get a different random sequence every
+       frame */
+    UnsignedInt seed{};
+    /* Ring buffer position of the next emitted particle, transform feedback
+       only */
+    UnsignedInt emitBegin{};
+    /* Which of the two particle buffers contains the current state */
+    UnsignedInt current{};
+
+    GL::Buffer particles[2]{GL::Buffer{NoCreate}, GL::Buffer{NoCreate}};
+    GL::Buffer instances{NoCreate};
+
+    /* Update program for transform feedback, all passes for compute */
+    ParticleShaderGL shader{NoCreate};
+    /* Transform feedback only */
+    ParticleShaderGL instanceShader{NoCreate};
+    GL::TransformFeedback transformFeedback{NoCreate};
+    GL::Mesh particleMeshes[2]{GL::Mesh{NoCreate}, GL::Mesh{NoCreate}};
+
+    #ifndef MAGNUM_TARGET_WEBGL
+    /* Compute only */
+    GL::Buffer counters{NoCreate};
+    GL::Buffer command{NoCreate};
+    #endif
+};
+
+ParticleSystemGL::Backend ParticleSystemGL::defaultBackend() {
+    #ifndef MAGNUM_TARGET_WEBGL
+    #ifndef MAGNUM_TARGET_GLES
+    if(GL::Context::current().isVersionSupported(GL::Version::GL430))
+    #else
+    if(GL::Context::current().isVersionSupported(GL::Version::GLES310))
+    #endif
+        return Backend::Compute;
+    #endif
+    return Backend::TransformFeedback;
+}
+
+ParticleSystemGL::ParticleSystemGL(const UnsignedInt capacity, const Backend backend): _state{InPlaceInit} {
+    CORRADE_ASSERT(capacity,
+        "Shaders::ParticleSystemGL: expected a non-zero capacity", );
+
+    #ifndef MAGNUM_TARGET_WEBGL
+    if(backend == Backend::Compute) {
+        #ifndef MAGNUM_TARGET_GLES
+        MAGNUM_ASSERT_GL_VERSION_SUPPORTED(GL::Version::GL430);
+        #else
+        MAGNUM_ASSERT_GL_VERSION_SUPPORTED(GL::Version::GLES310);
+        #endif
+    } else
+    #endif
+    {
+        #ifndef MAGNUM_TARGET_GLES
+        MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::ARB::transform_feedback2);
+        #endif
+    }
+
+    #ifdef MAGNUM_BUILD_STATIC
+    /* Import resources on static build, if not already */
+    if(!Utility::Resource::hasGroup("MagnumShadersGL"))
+        importShaderResources();
+    #endif
+    Utility::Resource rs("MagnumShadersGL");
+
+    State& state = *_state;
+    state.backend = backend;
+    state.capacity = capacity;
+
+    /* A zero-initialized particle is dead, see ParticleSystem.glsl */
+    const Containers::Array<char> zeros{ValueInit, capacity*ParticleSize};
+    for(GL::Buffer& buffer: state.particles) {
+        buffer = GL::Buffer{GL::Buffer::TargetHint::Array};
+        buffer.setData(zeros, GL::BufferUsage::DynamicCopy);
+    }
+    state.instances = GL::Buffer{GL::Buffer::TargetHint::Array};
+    state.instances.setData({nullptr, capacity*sizeof(Instance)}, GL::BufferUsage::DynamicCopy);
+
+    #ifndef MAGNUM_TARGET_WEBGL
+    if(backend == Backend::Compute) {
+        state.shader = ParticleShaderGL{rs};
+        /* No particles alive, an empty workgroup count for the indirect
+           dispatch */
+        state.counters = GL::Buffer{GL::Buffer::TargetHint::ShaderStorage, {
+            0u, 0u, 0u, 1u, 1u
+        }, GL::BufferUsage::DynamicCopy};
+        /* Five items to cover the indexed variant as well, the vertex count
+           is filled in draw() and the instance count by the shader */
+        state.command = GL::Buffer{GL::Buffer::TargetHint::DrawIndirect, {
+            0u, 0u, 0u, 0u, 0u
+        }, GL::BufferUsage::DynamicDraw};
+    } else
+    #endif
+    {
+        state.shader = ParticleShaderGL{rs, true};
+        state.instanceShader = ParticleShaderGL{rs, false};
+        state.transformFeedback = GL::TransformFeedback{};
+        for(std::size_t i = 0; i != 2; ++i) {
+            state.particleMeshes[i] = GL::Mesh{MeshPrimitive::Points};
+            state.particleMeshes[i]
+                .setCount(capacity)
+                .addVertexBuffer(state.particles[i], 0,
+                    ParticleShaderGL::PositionAge{},
+                    ParticleShaderGL::VelocityLifetime{});
+        }
+    }
+}
+
+ParticleSystemGL::ParticleSystemGL(const UnsignedInt capacity): ParticleSystemGL{capacity, defaultBackend()} {}
+
+ParticleSystemGL::ParticleSystemGL(NoCreateT): _state{InPlaceInit} {}
+
+ParticleSystemGL::ParticleSystemGL(ParticleSystemGL&&) noexcept = default;
+
+ParticleSystemGL::~ParticleSystemGL() = default;
+
+ParticleSystemGL& ParticleSystemGL::operator=(ParticleSystemGL&&) noexcept = default;
+
+ParticleSystemGL::Backend ParticleSystemGL::backend() const { return _state->backend; }
+
+UnsignedInt ParticleSystemGL::capacity() const { return _state->capacity; }
+
+GL::Buffer& ParticleSystemGL::instanceBuffer() { return _state->instances; }
+
+Vector3 ParticleSystemGL::emitterPosition() const { return _state->emitterPosition; }
+
+ParticleSystemGL& ParticleSystemGL::setEmitterPosition(const Vector3& position) {
+    _state->emitterPosition = position;
+    _state->parametersDirty = true;
+    return *this;
+}
+
+Float ParticleSystemGL::emitterRadius() const { return _state->emitterRadius; }
+
+ParticleSystemGL& ParticleSystemGL::setEmitterRadius(const Float radius) {
+    _state->emitterRadius = radius;
+    _state->parametersDirty = true;
+    return *this;
+}
+
+Vector3 ParticleSystemGL::velocity() const { return _state->velocity; }
+
+Float ParticleSystemGL::velocitySpread() const { return _state->velocitySpread; }
+
+ParticleSystemGL& ParticleSystemGL::setVelocity(const Vector3& velocity, const Float spread) {
+    _state->velocity = velocity;
+    _state->velocitySpread = spread;
+    _state->parametersDirty = true;
+    return *this;
+}
+
+Vector2 ParticleSystemGL::lifetime() const { return _state->lifetime; }
+
+ParticleSystemGL& ParticleSystemGL::setLifetime(const Float min, const Float max) {
+    CORRADE_ASSERT(min <= max,
+        "Shaders::ParticleSystemGL::setLifetime(): expected min not larger than max but got" << min << "and" << max, *this);
+    _state->lifetime = {min, max};
+    _state->parametersDirty = true;
+    return *this;
+}
+
+Vector3 ParticleSystemGL::acceleration() const { return _state->acceleration; }
+
+ParticleSystemGL& ParticleSystemGL::setAcceleration(const Vector3& acceleration) {
+    _state->acceleration = acceleration;
+    _state->parametersDirty = true;
+    return *this;
+}
+
+Float ParticleSystemGL::drag() const { return _state->drag; }
+
+ParticleSystemGL& ParticleSystemGL::setDrag(const Float drag) {
+    _state->drag = drag;
+    _state->parametersDirty = true;
+    return *this;
+}
+
+Color4 ParticleSystemGL::startColor() const { return _state->startColor; }
+
+Color4 ParticleSystemGL::endColor() const { return _state->endColor; }
+
+ParticleSystemGL& ParticleSystemGL::setColor(const Color4& start, const Color4& end) {
+    _state->startColor = start;
+    _state->endColor = end;
+    _state->parametersDirty = true;
+    return *this;
+}
+
+Vector2 ParticleSystemGL::size() const { return _state->size; }
+
+ParticleSystemGL& ParticleSystemGL::setSize(const Float start, const Float end) {
+    _state->size = {start, end};
+    _state->parametersDirty = true;
+    return *this;
+}
+
+UnsignedInt ParticleSystemGL::emitCount() const { return _state->emitCount; }
+
+ParticleSystemGL& ParticleSystemGL::emit(const UnsignedInt count) {
+    _state->emitCount = Math::min(_state->emitCount + Math::min(count, _state->capacity), _state->capacity);
+    return *this;
+}
+
+ParticleSystemGL& ParticleSystemGL::update(const Float timeDelta, const Matrix4& cameraMatrix) {
+    State& state = *_state;
+    CORRADE_ASSERT(state.shader.id(),
+        "Shaders::ParticleSystemGL::update(): the particle system was constructed with NoCreate", *this);
+
+    if(state.parametersDirty) {
+        for(ParticleShaderGL* shader: {&state.shader, &state.instanceShader}) {
+            if(!shader->id()) continue;
+            shader->setParameters(state.emitterPosition, state.emitterRadius,
+                state.velocity, state.velocitySpread, state.lifetime,
+                state.acceleration, state.drag, state.startColor,
+                state.endColor, state.size);
+        }
+        state.parametersDirty = false;
+    }
+
+    /* Rotation-only inverse of the camera, to make the billboards face it */
+    const Matrix3x3 billboardRotation = cameraMatrix.rotation().transposed();
+    ++state.seed;
+
+    const UnsignedInt next = state.current ^ 1;
+
+    #ifndef MAGNUM_TARGET_WEBGL
+    if(state.backend == Backend::Compute) {
+        state.shader
+            .setFrame(state.seed, timeDelta, billboardRotation, state.capacity)
+            .setEmit(0, state.emitCount);
+        state.particles[state.current].bind(GL::Buffer::Target::ShaderStorage, InputParticleBufferBinding);
+        state.particles[next].bind(GL::Buffer::Target::ShaderStorage, OutputParticleBufferBinding);
+        state.instances.bind(GL::Buffer::Target::ShaderStorage, InstanceBufferBinding);
+        state.counters.bind(GL::Buffer::Target::ShaderStorage, CounterBufferBinding);
+        state.command.bind(GL::Buffer::Target::ShaderStorage, CommandBufferBinding);
+
+        /* Integrate and compact the alive particles, with the workgroup
+           count calculated by the previous finalize pass */
+        state.shader
+            .setPass(UpdatePass)
+            .dispatchComputeIndirect(state.counters, DispatchOffset);
+
+        /* Append the new particles after the surviving ones */
+        if(state.emitCount) {
+            GL::Renderer::setMemoryBarrier(GL::Renderer::MemoryBarrier::ShaderStorage);
+            state.shader
+                .setPass(EmitPass)
+                .dispatchCompute({(state.emitCount + GroupSize - 1)/GroupSize, 1, 1});
+        }
+
+        /* Update the counters and the draw command for the next frame */
+        GL::Renderer::setMemoryBarrier(GL::Renderer::MemoryBarrier::ShaderStorage);
+        state.shader
+            .setPass(FinalizePass)
+            .dispatchCompute({1, 1, 1});
+
+        /* The instance buffer is used as a vertex buffer and the counters and
+           command buffers as indirect parameters from now on */
+        GL::Renderer::setMemoryBarrier(
+            GL::Renderer::MemoryBarrier::ShaderStorage|
+            GL::Renderer::MemoryBarrier::VertexAttributeArray|
+            GL::Renderer::MemoryBarrier::Command);
+    } else
+    #endif
+    {
+        state.shader
+            .setFrame(state.seed, timeDelta, billboardRotation, state.capacity)
+            .setEmit(state.emitBegin, state.emitCount);
+        state.instanceShader
+            .setFrame(state.seed, timeDelta, billboardRotation, state.capacity);
+
+        GL::Renderer::enable(GL::Renderer::Feature::RasterizerDiscard);
+
+        /* Update all particle slots, emitting into the oldest ones */
+        state.transformFeedback.attachBuffer(0, state.particles[next]);
+        state.transformFeedback.begin(state.shader, GL::TransformFeedback::PrimitiveMode::Points);
+        state.shader.draw(state.particleMeshes[state.current]);
+        state.transformFeedback.end();
+
+        /* Produce instances from the updated particles */
+        state.transformFeedback.attachBuffer(0, state.instances);
+        state.transformFeedback.begin(state.instanceShader, GL::TransformFeedback::PrimitiveMode::Points);
+        state.instanceShader.draw(state.particleMeshes[next]);
+        state.transformFeedback.end();
+
+        GL::Renderer::disable(GL::Renderer::Feature::RasterizerDiscard);
+
+        state.emitBegin = (state.emitBegin + state.emitCount) % state.capacity;
+    }
+
+    state.current = next;
+    state.emitCount = 0;
+    return *this;
+}
+
+ParticleSystemGL& ParticleSystemGL::setupMesh(GL::Mesh& mesh) {
+    CORRADE_ASSERT(_state->instances.id(),
+        "Shaders::ParticleSystemGL::setupMesh(): the particle system was constructed with NoCreate", *this);
+    mesh.addVertexBufferInstanced(_state->instances, 1, 0,
+        FlatGL3D::TransformationMatrix{},
+        FlatGL3D::Color4{});
+    return *this;
+}
+
+ParticleSystemGL& ParticleSystemGL::draw(FlatGL3D& shader, GL::Mesh& mesh) {
+    State& state = *_state;
+    CORRADE_ASSERT(state.instances.id(),
+        "Shaders::ParticleSystemGL::draw(): the particle system was constructed with NoCreate", *this);
+    CORRADE_ASSERT(shader.flags() >= (FlatGL3D::Flag::InstancedTransformation|FlatGL3D::Flag::VertexColor),
+        "Shaders::ParticleSystemGL::draw(): expected the shader to have instanced transformation and vertex color enabled but got" << shader.flags(), *this);
+
+    #ifndef MAGNUM_TARGET_WEBGL
+    if(state.backend == Backend::Compute) {
+        /* The instance count is already filled by the finalize pass */
+        state.command.setSubData(0, {UnsignedInt(mesh.count())});
+        shader.drawIndirect(mesh, state.command);
+    } else
+    #endif
+    {
+        mesh.setInstanceCount(state.capacity);
+        shader.draw(mesh);
+    }
+
+    return *this;
+}
+
+Debug& operator<<(Debug& debug, const ParticleSystemGL::Backend value) {
+    debug << "Shaders::ParticleSystemGL::Backend" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(v) case ParticleSystemGL::Backend::v: return debug << "::" #v;
+        _c(TransformFeedback)
+        #ifndef MAGNUM_TARGET_WEBGL
+        _c(Compute)
+        #endif
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+}}
@@ -0,0 +1,403 @@
+#ifndef Magnum_Shaders_ParticleSystemGL_h
+#define Magnum_Shaders_ParticleSystemGL_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MAGNUM_TARGET_GLES2
+/** @file
+ * @brief Class @ref Magnum::Shaders::ParticleSystemGL
+ * @m_since_latest
+ */
+#endif
+
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Shaders/FlatGL.h"
+
+#ifndef MAGNUM_TARGET_GLES2
+namespace Magnum { namespace Shaders {
+
+/**
+@brief GPU particle system
+@m_since_latest
+
+Simulates particles entirely on the GPU, without the particle state ever being
+read back or uploaded from the CPU. Each @ref update() integrates the alive
+particles, spawns particles queued with @ref emit() and produces one
+@ref Instance per particle, which is then drawn by @ref FlatGL3D as an
+instanced camera-facing billboard. With the @ref Backend::Compute backend,
+a million particles are updated and drawn in well under a millisecond on
+contemporary desktop GPUs.
+
+@section Shaders-ParticleSystemGL-usage Usage
+
+The system is created with a fixed capacity and configured with an emitter
+shape, initial velocity, lifetime, forces, and color and size over the
+lifetime. A billboard mesh, such as a @ref Primitives::planeSolid(), is set up
+with @ref setupMesh(), and then each frame the system is updated with a time
+delta and the camera matrix that the billboards should face, and drawn with a
+@ref FlatGL3D that has both @ref FlatGL3D::Flag::InstancedTransformation and
+@relativeref{FlatGL3D,Flag::VertexColor} enabled:
+
+@snippet MagnumShaders-gl.cpp ParticleSystemGL-usage
+
+Particles are spawned at a uniformly distributed random position within a
+sphere of @ref setEmitterRadius() "given radius" around the emitter position,
+with the @ref setVelocity() "initial velocity" randomly varied within a
+sphere of given spread. The velocity is then affected by
+@ref setAcceleration() "a constant acceleration" such as gravity and by
+@ref setDrag() "linear drag". Particle color and size is linearly
+interpolated over the particle lifetime.
+
+@section Shaders-ParticleSystemGL-backends Backends
+
+@m_class{m-block m-success}
+
+@par Compute backend
+    With @ref Backend::Compute, a compute shader appends surviving and newly
+    emitted particles to the front of the other of two ping-ponged buffers,
+    so the instance buffer contains only alive particles, tightly packed.
+    Their count never leaves the GPU --- it's written directly into an
+    indirect draw command, and @ref draw() is a single
+    @ref GL::AbstractShaderProgram::drawIndirect() call. Particles emitted
+    over the capacity are dropped. Requires OpenGL 4.3 or OpenGL ES 3.1, not
+    available in WebGL.
+
+@m_class{m-block m-warning}
+
+@par Transform feedback backend
+    With @ref Backend::TransformFeedback, a vertex shader processes all
+    particle slots with @ref GL::TransformFeedback capturing the result, and
+    a second pass then produces the instances. Without geometry shaders a
+    vertex shader can't drop its output, so the particle buffer is treated
+    as a ring --- newly emitted particles replace the oldest slots,
+    regardless of whether they're still alive, and all @ref capacity()
+    instances are always drawn, with dead particles scaled down to zero.
+    Available on OpenGL 4.0, OpenGL ES 3.0 and WebGL 2.0.
+
+@see @ref InstanceBatcherGL
+@requires_gl40 Extension @gl_extension{ARB,transform_feedback2} for
+    @ref Backend::TransformFeedback
+@requires_gl43 Extension @gl_extension{ARB,compute_shader},
+    @gl_extension{ARB,shader_storage_buffer_object} and
+    @gl_extension{ARB,draw_indirect} for @ref Backend::Compute
+@requires_gles30 Transform feedback is not available in OpenGL ES 2.0.
+@requires_gles31 Compute shaders are not available in OpenGL ES 3.0 and
+    older, only @ref Backend::TransformFeedback is available there.
+@requires_webgl20 Transform feedback is not available in WebGL 1.0.
+@requires_gles Compute shaders are not available in WebGL, only
+    @ref Backend::TransformFeedback is available there.
+*/
+class MAGNUM_SHADERS_EXPORT ParticleSystemGL {
+    public:
+        /**
+         * @brief Backend
+         *
+         * @see @ref backend(), @ref defaultBackend()
+         */
+        enum class Backend: UnsignedByte {
+            /**
+             * Update with transform feedback. Particles are stored in a ring
+             * buffer and all slots are always drawn.
+             */
+            TransformFeedback,
+
+            #ifndef MAGNUM_TARGET_WEBGL
+            /**
+             * Update with a compute shader, compacting alive particles and
+             * drawing them indirectly.
+             * @requires_gl43 Extension @gl_extension{ARB,compute_shader}
+             * @requires_gles31 Compute shaders are not available in OpenGL
+             *      ES 3.0 and older.
+             * @requires_gles Compute shaders are not available in WebGL.
+             */
+            Compute
+            #endif
+        };
+
+        /**
+         * @brief Instance data
+         *
+         * Layout of a single instance in @ref instanceBuffer(), matching the
+         * @ref FlatGL3D::TransformationMatrix and @ref FlatGL3D::Color4
+         * attributes.
+         */
+        struct Instance {
+            /** @brief Transformation matrix */
+            Matrix4 transformationMatrix;
+
+            /** @brief Color */
+            Color4 color;
+        };
+
+        /**
+         * @brief Default backend
+         *
+         * @ref Backend::Compute if OpenGL 4.3 or OpenGL ES 3.1 is supported,
+         * @ref Backend::TransformFeedback otherwise. Always
+         * @ref Backend::TransformFeedback on WebGL.
+         */
+        static Backend defaultBackend();
+
+        /**
+         * @brief Constructor
+         * @param capacity  Max count of particles alive at the same time
+         * @param backend   Backend to use
+         *
+         * Expects that @p capacity is not zero. Compiles the shaders for
+         * given @p backend and allocates the particle and instance buffers,
+         * with all particles initially dead.
+         */
+        explicit ParticleSystemGL(UnsignedInt capacity, Backend backend);
+
+        /**
+         * @brief Construct with the default backend
+         *
+         * Equivalent to calling @ref ParticleSystemGL(UnsignedInt, Backend)
+         * with @ref defaultBackend().
+         */
+        explicit ParticleSystemGL(UnsignedInt capacity);
+
+        /**
+         * @brief Construct without creating the underlying OpenGL objects
+         *
+         * The constructed instance is equivalent to a moved-from state.
+         * Useful in cases where you will overwrite the instance later
+         * anyway. Move another object over it to make it useful. This
+         * function can be safely used for constructing (and later
+         * destructing) objects even without any OpenGL context being active.
+         */
+        explicit ParticleSystemGL(NoCreateT);
+
+        /** @brief Copying is not allowed */
+        ParticleSystemGL(const ParticleSystemGL&) = delete;
+
+        /** @brief Move constructor */
+        ParticleSystemGL(ParticleSystemGL&&) noexcept;
+
+        ~ParticleSystemGL();
+
+        /** @brief Copying is not allowed */
+        ParticleSystemGL& operator=(const ParticleSystemGL&) = delete;
+
+        /** @brief Move assignment */
+        ParticleSystemGL& operator=(ParticleSystemGL&&) noexcept;
+
+        /** @brief Backend */
+        Backend backend() const;
+
+        /** @brief Max count of particles alive at the same time */
+        UnsignedInt capacity() const;
+
+        /**
+         * @brief Instance buffer
+         *
+         * Contains @ref capacity() @ref Instance items filled by the last
+         * @ref update().
+         */
+        GL::Buffer& instanceBuffer();
+
+        /** @brief Emitter position */
+        Vector3 emitterPosition() const;
+
+        /**
+         * @brief Set emitter position
+         * @return Reference to self (for method chaining)
+         *
+         * Affects only particles emitted in subsequent @ref update() calls.
+         * Default is a zero vector.
+         */
+        ParticleSystemGL& setEmitterPosition(const Vector3& position);
+
+        /** @brief Emitter radius */
+        Float emitterRadius() const;
+
+        /**
+         * @brief Set emitter radius
+         * @return Reference to self (for method chaining)
+         *
+         * Particles are spawned uniformly distributed in a sphere of given
+         * radius around @ref emitterPosition(). Default is @cpp 0.0f @ce,
+         * i.e. a point emitter.
+         */
+        ParticleSystemGL& setEmitterRadius(Float radius);
+
+        /** @brief Initial velocity */
+        Vector3 velocity() const;
+
+        /** @brief Initial velocity spread */
+        Float velocitySpread() const;
+
+        /**
+         * @brief Set initial velocity
+         * @return Reference to self (for method chaining)
+         *
+         * Each particle gets @p velocity with a random vector from a sphere
+         * of radius @p spread added to it. Default is a zero velocity and a
+         * zero spread.
+         */
+        ParticleSystemGL& setVelocity(const Vector3& velocity, Float spread);
+
+        /** @brief Lifetime range */
+        Vector2 lifetime() const;
+
+        /**
+         * @brief Set lifetime range
+         * @return Reference to self (for method chaining)
+         *
+         * Each particle gets a lifetime uniformly distributed between @p min
+         * and @p max, in the same units as the time delta passed to
+         * @ref update(). Expects that @p min is not larger than @p max.
+         * Default is @cpp 1.0f @ce for both.
+         */
+        ParticleSystemGL& setLifetime(Float min, Float max);
+
+        /** @brief Acceleration */
+        Vector3 acceleration() const;
+
+        /**
+         * @brief Set acceleration
+         * @return Reference to self (for method chaining)
+         *
+         * Constant acceleration applied to all alive particles, such as
+         * gravity. Default is a zero vector.
+         */
+        ParticleSystemGL& setAcceleration(const Vector3& acceleration);
+
+        /** @brief Drag */
+        Float drag() const;
+
+        /**
+         * @brief Set drag
+         * @return Reference to self (for method chaining)
+         *
+         * Fraction of the velocity lost per unit of time. Default is
+         * @cpp 0.0f @ce, i.e. no drag.
+         */
+        ParticleSystemGL& setDrag(Float drag);
+
+        /** @brief Color at the start of the particle lifetime */
+        Color4 startColor() const;
+
+        /** @brief Color at the end of the particle lifetime */
+        Color4 endColor() const;
+
+        /**
+         * @brief Set color over the particle lifetime
+         * @return Reference to self (for method chaining)
+         *
+         * The color is linearly interpolated from @p start to @p end. Default
+         * is @cpp 0xffffffff_rgbaf @ce for both.
+         */
+        ParticleSystemGL& setColor(const Color4& start, const Color4& end);
+
+        /** @brief Size over the particle lifetime */
+        Vector2 size() const;
+
+        /**
+         * @brief Set size over the particle lifetime
+         * @return Reference to self (for method chaining)
+         *
+         * The billboard scale is linearly interpolated from @p start to
+         * @p end. Default is @cpp 1.0f @ce for both.
+         */
+        ParticleSystemGL& setSize(Float start, Float end);
+
+        /**
+         * @brief Count of particles to be emitted in the next @ref update()
+         *
+         * @see @ref emit()
+         */
+        UnsignedInt emitCount() const;
+
+        /**
+         * @brief Emit particles
+         * @return Reference to self (for method chaining)
+         *
+         * The particles are spawned in the next @ref update(), repeated
+         * calls accumulate. The count is clamped to @ref capacity(). See
+         * @ref Shaders-ParticleSystemGL-backends for how emitting over the
+         * capacity is handled.
+         */
+        ParticleSystemGL& emit(UnsignedInt count);
+
+        /**
+         * @brief Update the particles
+         * @param timeDelta     Time elapsed since the last update
+         * @param cameraMatrix  Camera matrix the billboards should face
+         * @return Reference to self (for method chaining)
+         *
+         * Integrates and ages all alive particles, spawns particles queued
+         * with @ref emit() and fills @ref instanceBuffer(). The billboards
+         * are oriented using an inverse of the rotation part of
+         * @p cameraMatrix, so they face the camera.
+         */
+        ParticleSystemGL& update(Float timeDelta, const Matrix4& cameraMatrix);
+
+        /**
+         * @brief Set up a billboard mesh for drawing the particles
+         * @return Reference to self (for method chaining)
+         *
+         * Attaches @ref instanceBuffer() to @p mesh with the
+         * @ref FlatGL3D::TransformationMatrix and @ref FlatGL3D::Color4
+         * attributes. The mesh is expected to not have a color attribute on
+         * its own. The particle system is expected to outlive the mesh.
+         */
+        ParticleSystemGL& setupMesh(GL::Mesh& mesh);
+
+        /**
+         * @brief Draw the particles
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @p shader was created with
+         * @ref FlatGL3D::Flag::InstancedTransformation and
+         * @relativeref{FlatGL3D,Flag::VertexColor} and @p mesh was set up
+         * with @ref setupMesh(). The instance transformations are in world
+         * space, so the shader transformation projection matrix is expected
+         * to be set to a projection matrix multiplied by the camera matrix
+         * passed to @ref update(). Overwrites the instance count of @p mesh.
+         */
+        ParticleSystemGL& draw(FlatGL3D& shader, GL::Mesh& mesh);
+
+    private:
+        struct State;
+
+        Containers::Pointer<State> _state;
+};
+
+/**
+@debugoperatorclassenum{ParticleSystemGL,ParticleSystemGL::Backend}
+@m_since_latest
+*/
+MAGNUM_SHADERS_EXPORT Debug& operator<<(Debug& debug, ParticleSystemGL::Backend value);
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 and WebGL 1.0 build
+#endif
+
+#endif
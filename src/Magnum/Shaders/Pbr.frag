@@ -0,0 +1,380 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef RUNTIME_CONST
+#define const
+#endif
+
+#define PI 3.14159265359
+
+/* Uniform buffers */
+
+#ifndef MULTI_DRAW
+#if DRAW_COUNT > 1
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 0)
+#endif
+uniform highp uint drawOffset
+    #ifndef GL_ES
+    = 0u
+    #endif
+    ;
+#else
+#define drawOffset 0u
+#endif
+#define drawId drawOffset
+#endif
+
+/* Keep in sync with Pbr.vert. Can't "outsource" to a common file because
+   the #extension directive needs to be always before any code. */
+struct DrawUniform {
+    /* Can't be a mat3 because of ANGLE, see Phong.vert for details */
+    mediump mat3x4 normalMatrix;
+    highp uvec4 materialIdReservedLightOffsetLightCount;
+    #define draw_materialId materialIdReservedLightOffsetLightCount.x
+    #define draw_lightOffset materialIdReservedLightOffsetLightCount.z
+    #define draw_lightCount materialIdReservedLightOffsetLightCount.w
+};
+
+layout(std140
+    #ifdef EXPLICIT_BINDING
+    , binding = 2
+    #endif
+) uniform Draw {
+    DrawUniform draws[DRAW_COUNT];
+};
+
+struct MaterialUniform {
+    lowp vec4 baseColor;
+    mediump vec4 emissiveColorNormalTextureScale;
+    #define material_emissiveColor emissiveColorNormalTextureScale.xyz
+    #define material_normalTextureScale emissiveColorNormalTextureScale.w
+    mediump vec4 metalnessRoughnessOcclusionStrengthAlphaMask;
+    #define material_metalness metalnessRoughnessOcclusionStrengthAlphaMask.x
+    #define material_roughness metalnessRoughnessOcclusionStrengthAlphaMask.y
+    #define material_occlusionStrength metalnessRoughnessOcclusionStrengthAlphaMask.z
+    #define material_alphaMask metalnessRoughnessOcclusionStrengthAlphaMask.w
+};
+
+layout(std140
+    #ifdef EXPLICIT_BINDING
+    , binding = 4
+    #endif
+) uniform Material {
+    MaterialUniform materials[MATERIAL_COUNT];
+};
+
+#if LIGHT_COUNT
+/* Same layout as in Phong.frag, the specular color is unused */
+struct LightUniform {
+    highp vec4 position;
+    lowp vec3 colorReserved;
+    #define light_color colorReserved.xyz
+    lowp vec4 specularColorReserved;
+    lowp vec4 rangeReservedReservedReserved;
+    #define light_range rangeReservedReservedReserved.x
+};
+
+layout(std140
+    #ifdef EXPLICIT_BINDING
+    , binding = 5
+    #endif
+) uniform Light {
+    LightUniform lights[LIGHT_COUNT];
+};
+#endif
+
+#ifdef IMAGE_BASED_LIGHTING
+layout(std140
+    #ifdef EXPLICIT_BINDING
+    , binding = 6
+    #endif
+) uniform ImageBasedLighting {
+    /* Can't be a mat3 because of ANGLE, see Phong.vert for details */
+    mediump mat3x4 environmentRotation;
+    mediump float environmentIntensity;
+    highp uint environmentLevelCount;
+};
+#endif
+
+/* Textures */
+
+#ifdef BASE_COLOR_TEXTURE
+#ifdef EXPLICIT_BINDING
+layout(binding = 0)
+#endif
+uniform lowp
+    #ifndef TEXTURE_ARRAYS
+    sampler2D
+    #else
+    sampler2DArray
+    #endif
+    baseColorTexture;
+#endif
+
+#ifdef METALLIC_ROUGHNESS_TEXTURE
+#ifdef EXPLICIT_BINDING
+layout(binding = 1)
+#endif
+uniform lowp
+    #ifndef TEXTURE_ARRAYS
+    sampler2D
+    #else
+    sampler2DArray
+    #endif
+    metallicRoughnessTexture;
+#endif
+
+#ifdef NORMAL_TEXTURE
+#ifdef EXPLICIT_BINDING
+layout(binding = 2)
+#endif
+uniform lowp
+    #ifndef TEXTURE_ARRAYS
+    sampler2D
+    #else
+    sampler2DArray
+    #endif
+    normalTexture;
+#endif
+
+#ifdef OCCLUSION_TEXTURE
+#ifdef EXPLICIT_BINDING
+layout(binding = 3)
+#endif
+uniform lowp
+    #ifndef TEXTURE_ARRAYS
+    sampler2D
+    #else
+    sampler2DArray
+    #endif
+    occlusionTexture;
+#endif
+
+#ifdef EMISSIVE_TEXTURE
+#ifdef EXPLICIT_BINDING
+layout(binding = 4)
+#endif
+uniform lowp
+    #ifndef TEXTURE_ARRAYS
+    sampler2D
+    #else
+    sampler2DArray
+    #endif
+    emissiveTexture;
+#endif
+
+#ifdef IMAGE_BASED_LIGHTING
+#ifdef EXPLICIT_BINDING
+layout(binding = 5)
+#endif
+uniform mediump sampler2D brdfLookupTexture;
+
+#ifdef EXPLICIT_BINDING
+layout(binding = 6)
+#endif
+uniform mediump samplerCube environmentTexture;
+#endif
+
+/* Inputs */
+
+in mediump vec3 transformedNormal;
+#ifdef NORMAL_TEXTURE
+in mediump vec4 transformedTangent;
+#endif
+in highp vec3 transformedPosition;
+
+#ifdef TEXTURED
+in mediump
+    #ifndef TEXTURE_ARRAYS
+    vec2
+    #else
+    vec3
+    #endif
+    interpolatedTextureCoordinates;
+#endif
+
+#ifdef VERTEX_COLOR
+in lowp vec4 interpolatedVertexColor;
+#endif
+
+#ifdef MULTI_DRAW
+flat in highp uint drawId;
+#endif
+
+/* Outputs */
+
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = COLOR_OUTPUT_ATTRIBUTE_LOCATION)
+#endif
+/* The output is linear and may go over 1 when rendering to a floating-point
+   attachment */
+out mediump vec4 fragmentColor;
+
+void main() {
+    #if MATERIAL_COUNT > 1
+    mediump const uint materialId = draws[drawId].draw_materialId;
+    #else
+    #define materialId 0u
+    #endif
+    #if LIGHT_COUNT
+    mediump const uint lightOffset = draws[drawId].draw_lightOffset;
+    #endif
+
+    lowp const vec4 baseColor =
+        #ifdef BASE_COLOR_TEXTURE
+        texture(baseColorTexture, interpolatedTextureCoordinates)*
+        #endif
+        #ifdef VERTEX_COLOR
+        interpolatedVertexColor*
+        #endif
+        materials[materialId].baseColor;
+
+    #ifdef ALPHA_MASK
+    /* Using <= because if mask is set to 1.0, it should discard all, similarly
+       as when using 0, it should only discard what's already invisible
+       anyway. */
+    if(baseColor.a <= materials[materialId].material_alphaMask) discard;
+    #endif
+
+    #ifdef METALLIC_ROUGHNESS_TEXTURE
+    /* Same packing as glTF, roughness in green, metalness in blue */
+    lowp const vec2 metallicRoughness = texture(metallicRoughnessTexture, interpolatedTextureCoordinates).bg;
+    #else
+    #define metallicRoughness vec2(1.0)
+    #endif
+    lowp const float metalness = clamp(materials[materialId].material_metalness*metallicRoughness.x, 0.0, 1.0);
+    /* Clamping the roughness to a small value to avoid a division by zero in
+       the distribution term */
+    mediump const float roughness = clamp(materials[materialId].material_roughness*metallicRoughness.y, 0.03, 1.0);
+
+    lowp const vec3 diffuseColor = baseColor.rgb*(1.0 - metalness);
+    /* Reflectance at normal incidence, 4% for dielectrics */
+    lowp const vec3 f0 = mix(vec3(0.04), baseColor.rgb, metalness);
+
+    /* Normal */
+    mediump vec3 normalizedTransformedNormal = normalize(transformedNormal);
+    #ifdef NORMAL_TEXTURE
+    mediump vec3 normalizedTransformedTangent = normalize(transformedTangent.xyz);
+    mediump mat3 tbn = mat3(
+        normalizedTransformedTangent,
+        normalize(cross(normalizedTransformedNormal,
+                        normalizedTransformedTangent)*transformedTangent.w),
+        normalizedTransformedNormal
+    );
+    mediump const float normalTextureScale = materials[materialId].material_normalTextureScale;
+    normalizedTransformedNormal = tbn*(normalize((texture(normalTexture, interpolatedTextureCoordinates).rgb*2.0 - vec3(1.0))*vec3(normalTextureScale, normalTextureScale, 1.0)));
+    #endif
+
+    highp const vec3 cameraDirection = normalize(-transformedPosition);
+    mediump const float nDotV = max(dot(normalizedTransformedNormal, cameraDirection), 0.0001);
+
+    fragmentColor = vec4(vec3(0.0), baseColor.a);
+
+    #if LIGHT_COUNT
+    mediump const float alpha = roughness*roughness;
+    mediump const float alpha2 = alpha*alpha;
+
+    #ifndef LIGHT_CULLING
+    for(int i = 0; i < LIGHT_COUNT; ++i)
+    #else
+    for(uint i = 0u, actualLightCount = min(uint(LIGHT_COUNT), draws[drawId].draw_lightCount); i < actualLightCount; ++i)
+    #endif
+    {
+        lowp const vec3 lightColor = lights[
+            #ifdef LIGHT_CULLING
+            lightOffset +
+            #endif
+            i].light_color;
+        lowp const float lightRange = lights[
+            #ifdef LIGHT_CULLING
+            lightOffset +
+            #endif
+            i].light_range;
+        highp const vec4 lightPosition = lights[
+            #ifdef LIGHT_CULLING
+            lightOffset +
+            #endif
+            i].position;
+        highp const vec4 lightDirection = vec4(lightPosition.xyz - transformedPosition*lightPosition.w, lightPosition.w);
+
+        /* Attenuation, same as in Phong.frag */
+        highp const float len = length(lightDirection.xyz);
+        highp const float dist = len*lightDirection.w;
+        highp float attenuation = clamp(1.0 - pow(dist/max(lightRange, 0.0001), 4.0), 0.0, 1.0);
+        attenuation = attenuation*attenuation/(1.0 + dist*dist);
+
+        highp const vec3 normalizedLightDirection = lightDirection.xyz/len;
+        mediump const float nDotL = dot(normalizedTransformedNormal, normalizedLightDirection);
+        if(nDotL <= 0.0) continue;
+
+        mediump const vec3 halfVector = normalize(normalizedLightDirection + cameraDirection);
+        mediump const float nDotH = max(dot(normalizedTransformedNormal, halfVector), 0.0);
+        mediump const float vDotH = max(dot(cameraDirection, halfVector), 0.0);
+
+        /* GGX / Trowbridge-Reitz normal distribution */
+        mediump const float d = nDotH*nDotH*(alpha2 - 1.0) + 1.0;
+        mediump const float distribution = alpha2/(PI*d*d);
+        /* Height-correlated Smith visibility, already including the
+           1/(4 nDotL nDotV) denominator */
+        mediump const float visibility = 0.5/(
+            nDotL*sqrt(nDotV*nDotV*(1.0 - alpha2) + alpha2) +
+            nDotV*sqrt(nDotL*nDotL*(1.0 - alpha2) + alpha2));
+        /* Schlick Fresnel */
+        lowp const vec3 fresnel = f0 + (vec3(1.0) - f0)*pow(1.0 - vDotH, 5.0);
+
+        fragmentColor.rgb += ((vec3(1.0) - fresnel)*diffuseColor/PI + fresnel*distribution*visibility)*lightColor*nDotL*attenuation;
+    }
+    #endif
+
+    #ifdef IMAGE_BASED_LIGHTING
+    /* Split-sum approximation. Levels of the prefiltered map correspond to
+       linearly increasing roughness, the roughest level is used as an
+       approximation of the irradiance for the diffuse term. */
+    mediump const mat3 environmentRotation3 = mat3(environmentRotation);
+    mediump const float lastLevel = float(environmentLevelCount - 1u);
+    mediump const vec3 reflection = reflect(-cameraDirection, normalizedTransformedNormal);
+    mediump const vec3 prefiltered = textureLod(environmentTexture, environmentRotation3*reflection, roughness*lastLevel).rgb;
+    mediump const vec3 irradiance = textureLod(environmentTexture, environmentRotation3*normalizedTransformedNormal, lastLevel).rgb;
+    mediump const vec2 brdf = texture(brdfLookupTexture, vec2(nDotV, roughness)).rg;
+
+    lowp float occlusion =
+        #ifdef OCCLUSION_TEXTURE
+        mix(1.0, texture(occlusionTexture, interpolatedTextureCoordinates).r, materials[materialId].material_occlusionStrength)
+        #else
+        1.0
+        #endif
+        ;
+
+    fragmentColor.rgb += (diffuseColor*irradiance + prefiltered*(f0*brdf.x + vec3(brdf.y)))*environmentIntensity*occlusion;
+    #endif
+
+    /* Emission is unaffected by lighting */
+    fragmentColor.rgb +=
+        #ifdef EMISSIVE_TEXTURE
+        texture(emissiveTexture, interpolatedTextureCoordinates).rgb*
+        #endif
+        materials[materialId].material_emissiveColor;
+}
@@ -0,0 +1,450 @@
+#ifndef Magnum_Shaders_Pbr_h
+#define Magnum_Shaders_Pbr_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Struct @ref Magnum::Shaders::PbrDrawUniform, @ref Magnum::Shaders::PbrMaterialUniform, @ref Magnum::Shaders::PbrImageBasedLightingUniform
+ * @m_since_latest
+ */
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Tags.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Matrix.h"
+
+namespace Magnum { namespace Shaders {
+
+/**
+@brief Per-draw uniform for PBR shaders
+@m_since_latest
+
+Together with the generic @ref TransformationUniform3D contains parameters that
+are specific to each draw call. Texture transformation, if needed, is supplied
+separately in a @ref TextureTransformationUniform; material-related properties
+are expected to be shared among multiple draw calls and thus are provided in a
+separate @ref PbrMaterialUniform structure, referenced by @ref materialId.
+@see @ref PbrGL::bindDrawBuffer()
+*/
+struct PbrDrawUniform {
+    /** @brief Construct with default parameters */
+    constexpr explicit PbrDrawUniform(DefaultInitT = DefaultInit) noexcept: normalMatrix{Math::IdentityInit}, materialId{0}, lightOffset{0}, lightCount{0xffffffffu}
+        #if (defined(CORRADE_TARGET_CLANG) && __clang_major__ < 4) || (defined(CORRADE_TARGET_APPLE_CLANG) && __clang_major__ < 8)
+        , _pad0{} /* Otherwise it refuses to constexpr, on 3.8 at least */
+        #endif
+        {}
+
+    /** @brief Construct without initializing the contents */
+    explicit PbrDrawUniform(NoInitT) noexcept: normalMatrix{NoInit} {}
+
+    /** @{
+     * @name Convenience setters
+     *
+     * Provided to allow the use of method chaining for populating a structure
+     * in a single expression, otherwise equivalent to accessing the fields
+     * directly. Also guaranteed to provide backwards compatibility when
+     * packing of the actual fields changes.
+     */
+
+    /**
+     * @brief Set the @ref normalMatrix field
+     * @return Reference to self (for method chaining)
+     *
+     * The matrix is expanded to @relativeref{Magnum,Matrix3x4}, with the
+     * bottom row being zeros.
+     */
+    PbrDrawUniform& setNormalMatrix(const Matrix3x3& matrix) {
+        normalMatrix = Matrix3x4{matrix};
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref materialId field
+     * @return Reference to self (for method chaining)
+     */
+    PbrDrawUniform& setMaterialId(UnsignedInt id) {
+        materialId = id;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref lightOffset and @ref lightCount fields
+     * @return Reference to self (for method chaining)
+     */
+    PbrDrawUniform& setLightOffsetCount(UnsignedInt offset, UnsignedInt count) {
+        lightOffset = offset;
+        lightCount = count;
+        return *this;
+    }
+
+    /**
+     * @}
+     */
+
+    /**
+     * @brief Normal matrix
+     *
+     * Default value is an identity matrix. The bottom row is unused and acts
+     * only as a padding to match uniform buffer packing rules.
+     *
+     * If @ref PbrGL::Flag::InstancedTransformation is enabled, the
+     * per-instance normal matrix coming from the @ref PbrGL::NormalMatrix
+     * attribute is applied first, before this one.
+     */
+    Matrix3x4 normalMatrix;
+
+    /**
+     * @brief Material ID
+     *
+     * References a particular material from a @ref PbrMaterialUniform array.
+     * Should be less than the material count passed to
+     * @ref PbrGL::Configuration::setMaterialCount(), if material count is
+     * @cpp 1 @ce, this field is assumed to be @cpp 0 @ce and isn't even read
+     * by the shader. Default value is @cpp 0 @ce, meaning the first material
+     * gets used.
+     */
+    UnsignedInt materialId;
+
+    /* warning: Member __pad0__ is not documented. FFS DOXYGEN WHY DO YOU THINK
+       I MADE THOSE UNNAMED, YOU DUMB FOOL */
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    Int
+        #if (defined(CORRADE_TARGET_CLANG) && __clang_major__ < 4) || (defined(CORRADE_TARGET_APPLE_CLANG) && __clang_major__ < 8)
+        _pad0 /* Otherwise it refuses to constexpr, on 3.8 at least */
+        #endif
+        :32;
+    #endif
+
+    /**
+     * @brief Light offset
+     *
+     * References the first light in the @ref PhongLightUniform array. Should
+     * be less than the light count passed to
+     * @ref PbrGL::Configuration::setLightCount(). Default value is
+     * @cpp 0 @ce.
+     *
+     * Used only if @ref PbrGL::Flag::LightCulling is enabled, otherwise
+     * light offset is implicitly @cpp 0 @ce.
+     */
+    UnsignedInt lightOffset;
+
+    /**
+     * @brief Light count
+     *
+     * Specifies how many lights after the @p lightOffset are used from the
+     * @ref PhongLightUniform array. Gets clamped by the shader so it's
+     * together with @ref lightOffset not larger than the light count passed to
+     * @ref PbrGL::Configuration::setLightCount(). Default value is
+     * @cpp 0xffffffffu @ce.
+     *
+     * Used only if @ref PbrGL::Flag::LightCulling is enabled, otherwise
+     * light count is implicitly @ref PbrGL::lightCount().
+     */
+    UnsignedInt lightCount;
+};
+
+/**
+@brief Material uniform for PBR shaders
+@m_since_latest
+
+Describes metallic/roughness material properties referenced from
+@ref PbrDrawUniform::materialId. The fields and their defaults match the
+@ref Trade::PbrMetallicRoughnessMaterialData accessors, so translating an
+imported material is a plain field-by-field copy --- see
+@ref Shaders-PbrGL-usage for an example.
+@see @ref PbrGL::bindMaterialBuffer()
+*/
+struct PbrMaterialUniform {
+    /** @brief Construct with default parameters */
+    constexpr explicit PbrMaterialUniform(DefaultInitT = DefaultInit) noexcept: baseColor{1.0f, 1.0f, 1.0f, 1.0f}, emissiveColor{0.0f, 0.0f, 0.0f}, normalTextureScale{1.0f}, metalness{1.0f}, roughness{1.0f}, occlusionStrength{1.0f}, alphaMask{0.5f} {}
+
+    /** @brief Construct without initializing the contents */
+    explicit PbrMaterialUniform(NoInitT) noexcept: baseColor{NoInit}, emissiveColor{NoInit} {}
+
+    /** @{
+     * @name Convenience setters
+     *
+     * Provided to allow the use of method chaining for populating a structure
+     * in a single expression, otherwise equivalent to accessing the fields
+     * directly. Also guaranteed to provide backwards compatibility when
+     * packing of the actual fields changes.
+     */
+
+    /**
+     * @brief Set the @ref baseColor field
+     * @return Reference to self (for method chaining)
+     */
+    PbrMaterialUniform& setBaseColor(const Color4& color) {
+        baseColor = color;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref emissiveColor field
+     * @return Reference to self (for method chaining)
+     */
+    PbrMaterialUniform& setEmissiveColor(const Color3& color) {
+        emissiveColor = color;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref normalTextureScale field
+     * @return Reference to self (for method chaining)
+     */
+    PbrMaterialUniform& setNormalTextureScale(Float scale) {
+        normalTextureScale = scale;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref metalness field
+     * @return Reference to self (for method chaining)
+     */
+    PbrMaterialUniform& setMetalness(Float metalness) {
+        this->metalness = metalness;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref roughness field
+     * @return Reference to self (for method chaining)
+     */
+    PbrMaterialUniform& setRoughness(Float roughness) {
+        this->roughness = roughness;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref occlusionStrength field
+     * @return Reference to self (for method chaining)
+     */
+    PbrMaterialUniform& setOcclusionStrength(Float strength) {
+        occlusionStrength = strength;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref alphaMask field
+     * @return Reference to self (for method chaining)
+     */
+    PbrMaterialUniform& setAlphaMask(Float alphaMask) {
+        this->alphaMask = alphaMask;
+        return *this;
+    }
+
+    /**
+     * @}
+     */
+
+    /**
+     * @brief Base color
+     *
+     * Default value is @cpp 0xffffffff_rgbaf @ce. If
+     * @ref PbrGL::Flag::BaseColorTexture is enabled, the color is multiplied
+     * with the texture; if @ref PbrGL::Flag::VertexColor is enabled, the
+     * color is multiplied with a color coming from the @ref PbrGL::Color3 /
+     * @ref PbrGL::Color4 attribute.
+     * @see @ref Trade::PbrMetallicRoughnessMaterialData::baseColor()
+     */
+    Color4 baseColor;
+
+    /**
+     * @brief Emissive color
+     *
+     * Default value is @cpp 0x000000_rgbf @ce. If
+     * @ref PbrGL::Flag::EmissiveTexture is enabled, the color is multiplied
+     * with the texture.
+     * @see @ref Trade::PbrMetallicRoughnessMaterialData::emissiveColor()
+     */
+    Color3 emissiveColor;
+
+    /**
+     * @brief Normal texture scale
+     *
+     * Affects strength of the normal mapping. Default value is @cpp 1.0f @ce,
+     * meaning the normal texture is not changed in any way; a value of
+     * @cpp 0.0f @ce disables the normal texture effect altogether.
+     *
+     * Used only if @ref PbrGL::Flag::NormalTexture is enabled, ignored
+     * otherwise.
+     * @see @ref Trade::PbrMetallicRoughnessMaterialData::normalTextureScale()
+     */
+    Float normalTextureScale;
+
+    /**
+     * @brief Metalness
+     *
+     * Default value is @cpp 1.0f @ce. If
+     * @ref PbrGL::Flag::MetallicRoughnessTexture is enabled, the value is
+     * multiplied with the blue channel of the texture.
+     * @see @ref Trade::PbrMetallicRoughnessMaterialData::metalness()
+     */
+    Float metalness;
+
+    /**
+     * @brief Roughness
+     *
+     * Default value is @cpp 1.0f @ce. If
+     * @ref PbrGL::Flag::MetallicRoughnessTexture is enabled, the value is
+     * multiplied with the green channel of the texture.
+     * @see @ref Trade::PbrMetallicRoughnessMaterialData::roughness()
+     */
+    Float roughness;
+
+    /**
+     * @brief Occlusion strength
+     *
+     * Default value is @cpp 1.0f @ce, a value of @cpp 0.0f @ce disables the
+     * occlusion texture effect altogether.
+     *
+     * Used only if @ref PbrGL::Flag::OcclusionTexture is enabled, ignored
+     * otherwise.
+     * @see @ref Trade::PbrMetallicRoughnessMaterialData::occlusionTextureStrength()
+     */
+    Float occlusionStrength;
+
+    /**
+     * @brief Alpha mask value
+     *
+     * Fragments with alpha values smaller than the mask value will be
+     * discarded. Default value is @cpp 0.5f @ce.
+     *
+     * Used only if @ref PbrGL::Flag::AlphaMask is enabled, ignored otherwise.
+     * @see @ref Trade::MaterialData::alphaMask()
+     */
+    Float alphaMask;
+};
+
+/**
+@brief Image-based lighting uniform for PBR shaders
+@m_since_latest
+
+Describes how the prefiltered environment map bound with
+@ref PbrGL::bindEnvironmentTexture() is sampled. Used only if
+@ref PbrGL::Flag::ImageBasedLighting is enabled.
+@see @ref PbrGL::bindImageBasedLightingBuffer()
+*/
+struct PbrImageBasedLightingUniform {
+    /** @brief Construct with default parameters */
+    constexpr explicit PbrImageBasedLightingUniform(DefaultInitT = DefaultInit) noexcept: environmentRotation{Math::IdentityInit}, intensity{1.0f}, levelCount{1}
+        #if (defined(CORRADE_TARGET_CLANG) && __clang_major__ < 4) || (defined(CORRADE_TARGET_APPLE_CLANG) && __clang_major__ < 8)
+        , _pad0{}, _pad1{} /* Otherwise it refuses to constexpr, on 3.8 at least */
+        #endif
+        {}
+
+    /** @brief Construct without initializing the contents */
+    explicit PbrImageBasedLightingUniform(NoInitT) noexcept: environmentRotation{NoInit} {}
+
+    /** @{
+     * @name Convenience setters
+     *
+     * Provided to allow the use of method chaining for populating a structure
+     * in a single expression, otherwise equivalent to accessing the fields
+     * directly. Also guaranteed to provide backwards compatibility when
+     * packing of the actual fields changes.
+     */
+
+    /**
+     * @brief Set the @ref environmentRotation field
+     * @return Reference to self (for method chaining)
+     *
+     * The matrix is expanded to @relativeref{Magnum,Matrix3x4}, with the
+     * bottom row being zeros.
+     */
+    PbrImageBasedLightingUniform& setEnvironmentRotation(const Matrix3x3& rotation) {
+        environmentRotation = Matrix3x4{rotation};
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref intensity field
+     * @return Reference to self (for method chaining)
+     */
+    PbrImageBasedLightingUniform& setIntensity(Float intensity) {
+        this->intensity = intensity;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref levelCount field
+     * @return Reference to self (for method chaining)
+     */
+    PbrImageBasedLightingUniform& setLevelCount(UnsignedInt count) {
+        levelCount = count;
+        return *this;
+    }
+
+    /**
+     * @}
+     */
+
+    /**
+     * @brief Environment rotation
+     *
+     * Rotates camera-space reflection and normal vectors into the space of
+     * the environment map. Usually the rotation part of the inverted camera
+     * matrix. Default value is an identity matrix. The bottom row is unused
+     * and acts only as a padding to match uniform buffer packing rules.
+     */
+    Matrix3x4 environmentRotation;
+
+    /**
+     * @brief Intensity
+     *
+     * Multiplier for the environment contribution. Default value is
+     * @cpp 1.0f @ce.
+     */
+    Float intensity;
+
+    /**
+     * @brief Level count
+     *
+     * Count of mip levels in the prefiltered environment texture, with the
+     * last level corresponding to a roughness of @cpp 1.0f @ce. Should match
+     * the level count passed to @ref pbrPrefilteredEnvironmentTexture().
+     * Default value is @cpp 1 @ce.
+     */
+    UnsignedInt levelCount;
+
+    /* warning: Member __pad0__ is not documented. FFS DOXYGEN WHY DO YOU THINK
+       I MADE THOSE UNNAMED, YOU DUMB FOOL */
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    Int
+        #if (defined(CORRADE_TARGET_CLANG) && __clang_major__ < 4) || (defined(CORRADE_TARGET_APPLE_CLANG) && __clang_major__ < 8)
+        _pad0 /* Otherwise it refuses to constexpr, on 3.8 at least */
+        #endif
+        :32;
+    Int
+        #if (defined(CORRADE_TARGET_CLANG) && __clang_major__ < 4) || (defined(CORRADE_TARGET_APPLE_CLANG) && __clang_major__ < 8)
+        _pad1 /* Otherwise it refuses to constexpr, on 3.8 at least */
+        #endif
+        :32;
+    #endif
+};
+
+}}
+
+#endif
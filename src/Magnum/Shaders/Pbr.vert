@@ -0,0 +1,267 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#if defined(TEXTURE_ARRAYS) && !defined(GL_ES)
+#extension GL_ARB_shader_bit_encoding: require
+#endif
+
+#ifdef MULTI_DRAW
+#ifndef GL_ES
+#extension GL_ARB_shader_draw_parameters: require
+#else /* covers WebGL as well */
+#extension GL_ANGLE_multi_draw: require
+#endif
+#endif
+
+#ifndef RUNTIME_CONST
+#define const
+#endif
+
+/* Uniform buffers */
+
+#if DRAW_COUNT > 1
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 0)
+#endif
+uniform highp uint drawOffset
+    #ifndef GL_ES
+    = 0u
+    #endif
+    ;
+#else
+#define drawOffset 0u
+#endif
+
+/* Keep in sync with Pbr.frag. Can't "outsource" to a common file because
+   the #extension directive needs to be always before any code. */
+struct DrawUniform {
+    /* Can't be a mat3 because of ANGLE, see Phong.vert for details */
+    mediump mat3x4 normalMatrix;
+    highp uvec4 materialIdReservedLightOffsetLightCount;
+    #define draw_materialId materialIdReservedLightOffsetLightCount.x
+    #define draw_lightOffset materialIdReservedLightOffsetLightCount.z
+    #define draw_lightCount materialIdReservedLightOffsetLightCount.w
+};
+
+layout(std140
+    #ifdef EXPLICIT_BINDING
+    , binding = 2
+    #endif
+) uniform Draw {
+    DrawUniform draws[DRAW_COUNT];
+};
+
+layout(std140
+    #ifdef EXPLICIT_BINDING
+    , binding = 0
+    #endif
+) uniform Projection {
+    highp mat4 projectionMatrix;
+};
+
+layout(std140
+    #ifdef EXPLICIT_BINDING
+    , binding = 1
+    #endif
+) uniform Transformation {
+    highp mat4 transformationMatrices[DRAW_COUNT];
+};
+
+#ifdef TEXTURE_TRANSFORMATION
+struct TextureTransformationUniform {
+    highp vec4 rotationScaling;
+    highp vec4 offsetLayerReserved;
+    #define textureTransformation_offset offsetLayerReserved.xy
+    #define textureTransformation_layer offsetLayerReserved.z
+};
+
+layout(std140
+    #ifdef EXPLICIT_BINDING
+    , binding = 3
+    #endif
+) uniform TextureTransformation {
+    TextureTransformationUniform textureTransformations[DRAW_COUNT];
+};
+#endif
+
+/* Inputs */
+
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = POSITION_ATTRIBUTE_LOCATION)
+#endif
+in highp vec4 position;
+
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = NORMAL_ATTRIBUTE_LOCATION)
+#endif
+in mediump vec3 normal;
+
+#ifdef NORMAL_TEXTURE
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = TANGENT_ATTRIBUTE_LOCATION)
+#endif
+in mediump vec4 tangent;
+#endif
+
+#ifdef TEXTURED
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = TEXTURECOORDINATES_ATTRIBUTE_LOCATION)
+#endif
+in mediump vec2 textureCoordinates;
+#endif
+
+#ifdef VERTEX_COLOR
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = COLOR_ATTRIBUTE_LOCATION)
+#endif
+in lowp vec4 vertexColor;
+#endif
+
+#ifdef INSTANCED_TRANSFORMATION
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = TRANSFORMATION_MATRIX_ATTRIBUTE_LOCATION)
+#endif
+in highp mat4 instancedTransformationMatrix;
+
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = NORMAL_MATRIX_ATTRIBUTE_LOCATION)
+#endif
+in highp mat3 instancedNormalMatrix;
+#endif
+
+#ifdef INSTANCED_TEXTURE_OFFSET
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = TEXTURE_OFFSET_ATTRIBUTE_LOCATION)
+#endif
+in mediump
+    #ifndef TEXTURE_ARRAYS
+    vec2
+    #else
+    vec3
+    #endif
+    instancedTextureOffset;
+#endif
+
+/* Outputs */
+
+#ifdef TEXTURED
+out mediump
+    #ifndef TEXTURE_ARRAYS
+    vec2
+    #else
+    vec3
+    #endif
+    interpolatedTextureCoordinates;
+#endif
+
+#ifdef VERTEX_COLOR
+out lowp vec4 interpolatedVertexColor;
+#endif
+
+out mediump vec3 transformedNormal;
+#ifdef NORMAL_TEXTURE
+out mediump vec4 transformedTangent;
+#endif
+out highp vec3 transformedPosition;
+
+#ifdef MULTI_DRAW
+flat out highp uint drawId;
+#endif
+
+void main() {
+    #ifdef MULTI_DRAW
+    drawId = drawOffset + uint(
+        #ifndef GL_ES
+        gl_DrawIDARB /* Using GL_ARB_shader_draw_parameters, not GLSL 4.6 */
+        #else
+        gl_DrawID
+        #endif
+        );
+    #else
+    #define drawId drawOffset
+    #endif
+
+    highp const mat4 transformationMatrix = transformationMatrices[drawId];
+    mediump const mat3 normalMatrix = mat3(draws[drawId].normalMatrix);
+    #ifdef TEXTURE_TRANSFORMATION
+    mediump const mat3 textureMatrix = mat3(textureTransformations[drawId].rotationScaling.xy, 0.0, textureTransformations[drawId].rotationScaling.zw, 0.0, textureTransformations[drawId].textureTransformation_offset, 1.0);
+    #ifdef TEXTURE_ARRAYS
+    highp const uint textureLayer = floatBitsToUint(textureTransformations[drawId].textureTransformation_layer);
+    #endif
+    #endif
+
+    /* Transformed vertex position */
+    highp vec4 transformedPosition4 = transformationMatrix*
+        #ifdef INSTANCED_TRANSFORMATION
+        instancedTransformationMatrix*
+        #endif
+        position;
+    transformedPosition = transformedPosition4.xyz/transformedPosition4.w;
+
+    /* Transformed normal and tangent vector */
+    transformedNormal = normalMatrix*
+        #ifdef INSTANCED_TRANSFORMATION
+        instancedNormalMatrix*
+        #endif
+        normal;
+    #ifdef NORMAL_TEXTURE
+    transformedTangent = vec4(normalMatrix*
+        #ifdef INSTANCED_TRANSFORMATION
+        instancedNormalMatrix*
+        #endif
+        tangent.xyz, tangent.w);
+    #endif
+
+    /* Transform the position */
+    gl_Position = projectionMatrix*transformedPosition4;
+
+    #ifdef TEXTURED
+    /* Texture coordinates, if needed */
+    interpolatedTextureCoordinates.xy =
+        #ifdef TEXTURE_TRANSFORMATION
+        (textureMatrix*vec3(
+            #ifdef INSTANCED_TEXTURE_OFFSET
+            instancedTextureOffset.xy +
+            #endif
+            textureCoordinates, 1.0)).xy
+        #else
+        textureCoordinates
+        #endif
+        ;
+    #ifdef TEXTURE_ARRAYS
+    interpolatedTextureCoordinates.z = float(
+        #ifdef INSTANCED_TEXTURE_OFFSET
+        uint(instancedTextureOffset.z) +
+        #endif
+        textureLayer
+    );
+    #endif
+    #endif
+
+    #ifdef VERTEX_COLOR
+    /* Vertex colors, if enabled */
+    interpolatedVertexColor = vertexColor;
+    #endif
+}
@@ -0,0 +1,88 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#define PI 3.14159265359
+#define SAMPLE_COUNT 1024u
+
+/* Common to PbrPrefilter.frag */
+
+/* Van der Corput radical inverse, done with a bit reversal. GLSL 1.30 / ES 3.0
+   doesn't have bitfieldReverse(). */
+highp float radicalInverse(highp uint bits) {
+    bits = (bits << 16u)|(bits >> 16u);
+    bits = ((bits & 0x55555555u) << 1u)|((bits & 0xAAAAAAAAu) >> 1u);
+    bits = ((bits & 0x33333333u) << 2u)|((bits & 0xCCCCCCCCu) >> 2u);
+    bits = ((bits & 0x0F0F0F0Fu) << 4u)|((bits & 0xF0F0F0F0u) >> 4u);
+    bits = ((bits & 0x00FF00FFu) << 8u)|((bits & 0xFF00FF00u) >> 8u);
+    return float(bits)*2.3283064365386963e-10; /* 1/2^32 */
+}
+
+/* GGX importance sampling of a half vector around the +Z axis */
+highp vec3 importanceSampleGgx(highp uint i, highp float alpha2) {
+    highp const float phi = 2.0*PI*(float(i) + 0.5)/float(SAMPLE_COUNT);
+    highp const float xi = radicalInverse(i);
+    highp const float cosTheta = sqrt((1.0 - xi)/(1.0 + (alpha2 - 1.0)*xi));
+    highp const float sinTheta = sqrt(1.0 - cosTheta*cosTheta);
+    return vec3(sinTheta*cos(phi), sinTheta*sin(phi), cosTheta);
+}
+
+in highp vec2 interpolatedPosition;
+
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = COLOR_OUTPUT_ATTRIBUTE_LOCATION)
+#endif
+out highp vec2 fragmentColor;
+
+void main() {
+    /* Texel centers map to [0, 1] on both axes */
+    highp const vec2 coordinates = interpolatedPosition*0.5 + vec2(0.5);
+    highp const float nDotV = max(coordinates.x, 0.0001);
+    highp const float roughness = coordinates.y;
+    highp const float alpha2 = roughness*roughness*roughness*roughness;
+
+    /* View vector in a tangent space with the normal being +Z */
+    highp const vec3 v = vec3(sqrt(1.0 - nDotV*nDotV), 0.0, nDotV);
+
+    highp vec2 result = vec2(0.0);
+    for(highp uint i = 0u; i != SAMPLE_COUNT; ++i) {
+        highp const vec3 h = importanceSampleGgx(i, alpha2);
+        highp const float vDotH = max(dot(v, h), 0.0);
+        highp const vec3 l = 2.0*vDotH*h - v;
+        highp const float nDotL = l.z;
+        if(nDotL <= 0.0) continue;
+        highp const float nDotH = max(h.z, 0.0);
+
+        /* Height-correlated Smith visibility, same as in Pbr.frag, multiplied
+           by the inverse of the sampling pdf */
+        highp const float visibility = 0.5/(
+            nDotL*sqrt(nDotV*nDotV*(1.0 - alpha2) + alpha2) +
+            nDotV*sqrt(nDotL*nDotL*(1.0 - alpha2) + alpha2));
+        highp const float weight = 4.0*visibility*nDotL*vDotH/nDotH;
+        highp const float fresnel = pow(1.0 - vDotH, 5.0);
+        result += vec2(1.0 - fresnel, fresnel)*weight;
+    }
+
+    fragmentColor = result/float(SAMPLE_COUNT);
+}
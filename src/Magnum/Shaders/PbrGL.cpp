@@ -0,0 +1,687 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "PbrGL.h"
+
+#include <Corrade/Containers/EnumSet.hpp>
+#include <Corrade/Containers/Reference.h>
+#include <Corrade/Containers/StringStl.h>
+#include <Corrade/Utility/FormatStl.h>
+#include <Corrade/Utility/Resource.h>
+
+#include "Magnum/GL/Buffer.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/CubeMapTexture.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/Framebuffer.h"
+#include "Magnum/GL/Mesh.h"
+#include "Magnum/GL/Shader.h"
+#include "Magnum/GL/Texture.h"
+#include "Magnum/GL/TextureArray.h"
+#include "Magnum/GL/TextureFormat.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Range.h"
+
+#include "Magnum/Shaders/Implementation/CreateCompatibilityShader.h"
+
+namespace Magnum { namespace Shaders {
+
+namespace {
+    enum: Int {
+        BaseColorTextureUnit = 0,
+        MetallicRoughnessTextureUnit = 1,
+        NormalTextureUnit = 2,
+        OcclusionTextureUnit = 3,
+        EmissiveTextureUnit = 4,
+        BrdfLookupTextureUnit = 5,
+        EnvironmentTextureUnit = 6
+    };
+
+    enum: Int {
+        ProjectionBufferBinding = 0,
+        TransformationBufferBinding = 1,
+        DrawBufferBinding = 2,
+        TextureTransformationBufferBinding = 3,
+        MaterialBufferBinding = 4,
+        LightBufferBinding = 5,
+        ImageBasedLightingBufferBinding = 6
+    };
+
+    constexpr PbrGL::Flags TextureFlags = PbrGL::Flag::BaseColorTexture|PbrGL::Flag::MetallicRoughnessTexture|PbrGL::Flag::NormalTexture|PbrGL::Flag::OcclusionTexture|PbrGL::Flag::EmissiveTexture;
+}
+
+PbrGL::CompileState PbrGL::compile(const Configuration& configuration) {
+    const Flags flags = configuration.flags();
+    const UnsignedInt lightCount = configuration.lightCount();
+    const UnsignedInt materialCount = configuration.materialCount();
+    const UnsignedInt drawCount = configuration.drawCount();
+
+    CORRADE_ASSERT(!(flags & Flag::TextureTransformation) || (flags & TextureFlags),
+        "Shaders::PbrGL: texture transformation enabled but the shader is not textured", CompileState{NoCreate});
+    CORRADE_ASSERT(!(flags & Flag::TextureArrays) || (flags & TextureFlags),
+        "Shaders::PbrGL: texture arrays enabled but the shader is not textured", CompileState{NoCreate});
+    CORRADE_ASSERT(!(flags & Flag::TextureArrays) || flags >= (Flag::TextureArrays|Flag::TextureTransformation),
+        "Shaders::PbrGL: texture arrays require texture transformation enabled as well", CompileState{NoCreate});
+    CORRADE_ASSERT(materialCount,
+        "Shaders::PbrGL: material count can't be zero", CompileState{NoCreate});
+    CORRADE_ASSERT(drawCount,
+        "Shaders::PbrGL: draw count can't be zero", CompileState{NoCreate});
+
+    #ifndef MAGNUM_TARGET_GLES
+    MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::ARB::uniform_buffer_object);
+    #endif
+    if(flags >= Flag::MultiDraw) {
+        #ifndef MAGNUM_TARGET_GLES
+        MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::ARB::shader_draw_parameters);
+        #elif !defined(MAGNUM_TARGET_WEBGL)
+        MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::ANGLE::multi_draw);
+        #else
+        MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::WEBGL::multi_draw);
+        #endif
+    }
+    #ifndef MAGNUM_TARGET_GLES
+    if(flags >= Flag::TextureArrays)
+        MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::EXT::texture_array);
+    #endif
+
+    #ifdef MAGNUM_BUILD_STATIC
+    /* Import resources on static build, if not already */
+    if(!Utility::Resource::hasGroup("MagnumShadersGL"))
+        importShaderResources();
+    #endif
+    Utility::Resource rs("MagnumShadersGL");
+
+    const GL::Context& context = GL::Context::current();
+
+    #ifndef MAGNUM_TARGET_GLES
+    const GL::Version version = context.supportedVersion({GL::Version::GL320, GL::Version::GL310, GL::Version::GL300});
+    #else
+    const GL::Version version = GL::Version::GLES300;
+    #endif
+
+    PbrGL out{NoInit};
+    out._flags = flags;
+    out._lightCount = lightCount;
+    out._materialCount = materialCount;
+    out._drawCount = drawCount;
+
+    GL::Shader vert = Implementation::createCompatibilityShader(rs, version, GL::Shader::Type::Vertex);
+    GL::Shader frag = Implementation::createCompatibilityShader(rs, version, GL::Shader::Type::Fragment);
+
+    vert.addSource(flags & TextureFlags ? "#define TEXTURED\n" : "")
+        .addSource(flags & Flag::NormalTexture ? "#define NORMAL_TEXTURE\n" : "")
+        .addSource(flags & Flag::VertexColor ? "#define VERTEX_COLOR\n" : "")
+        .addSource(flags & Flag::TextureTransformation ? "#define TEXTURE_TRANSFORMATION\n" : "")
+        .addSource(flags & Flag::TextureArrays ? "#define TEXTURE_ARRAYS\n" : "")
+        .addSource(flags & Flag::InstancedTransformation ? "#define INSTANCED_TRANSFORMATION\n" : "")
+        .addSource(flags >= Flag::InstancedTextureOffset ? "#define INSTANCED_TEXTURE_OFFSET\n" : "")
+        .addSource(flags >= Flag::MultiDraw ? "#define MULTI_DRAW\n" : "")
+        .addSource(Utility::formatString(
+            "#define DRAW_COUNT {}\n",
+            drawCount))
+        .addSource(rs.getString("generic.glsl"))
+        .addSource(rs.getString("Pbr.vert"));
+    frag.addSource(flags & TextureFlags ? "#define TEXTURED\n" : "")
+        .addSource(flags & Flag::BaseColorTexture ? "#define BASE_COLOR_TEXTURE\n" : "")
+        .addSource(flags & Flag::MetallicRoughnessTexture ? "#define METALLIC_ROUGHNESS_TEXTURE\n" : "")
+        .addSource(flags & Flag::NormalTexture ? "#define NORMAL_TEXTURE\n" : "")
+        .addSource(flags & Flag::OcclusionTexture ? "#define OCCLUSION_TEXTURE\n" : "")
+        .addSource(flags & Flag::EmissiveTexture ? "#define EMISSIVE_TEXTURE\n" : "")
+        .addSource(flags & Flag::TextureArrays ? "#define TEXTURE_ARRAYS\n" : "")
+        .addSource(flags & Flag::VertexColor ? "#define VERTEX_COLOR\n" : "")
+        .addSource(flags & Flag::AlphaMask ? "#define ALPHA_MASK\n" : "")
+        .addSource(flags >= Flag::MultiDraw ? "#define MULTI_DRAW\n" : "")
+        .addSource(flags & Flag::LightCulling ? "#define LIGHT_CULLING\n" : "")
+        .addSource(flags & Flag::ImageBasedLighting ? "#define IMAGE_BASED_LIGHTING\n" : "")
+        .addSource(Utility::formatString(
+            "#define DRAW_COUNT {}\n"
+            "#define MATERIAL_COUNT {}\n"
+            "#define LIGHT_COUNT {}\n",
+            drawCount,
+            materialCount,
+            lightCount))
+        .addSource(rs.getString("generic.glsl"))
+        .addSource(rs.getString("Pbr.frag"));
+
+    /* If a matching program binary is cached, there's nothing to compile
+       or link */
+    #ifndef MAGNUM_TARGET_WEBGL
+    const bool cached = out.loadCachedBinary({vert, frag});
+    #else
+    const bool cached = false;
+    #endif
+    if(!cached) {
+        vert.submitCompile();
+        frag.submitCompile();
+
+        out.attachShaders({vert, frag});
+
+        /* ES3 has this done in the shader directly and doesn't even provide
+           bindFragmentDataLocation() */
+        #ifndef MAGNUM_TARGET_GLES
+        if(!context.isExtensionSupported<GL::Extensions::ARB::explicit_attrib_location>(version)) {
+            out.bindAttributeLocation(Position::Location, "position");
+            out.bindAttributeLocation(Normal::Location, "normal");
+            if(flags & Flag::NormalTexture)
+                out.bindAttributeLocation(Tangent4::Location, "tangent");
+            if(flags & Flag::VertexColor)
+                out.bindAttributeLocation(Color3::Location, "vertexColor"); /* Color4 is the same */
+            if(flags & TextureFlags)
+                out.bindAttributeLocation(TextureCoordinates::Location, "textureCoordinates");
+            if(flags & Flag::InstancedTransformation) {
+                out.bindAttributeLocation(TransformationMatrix::Location, "instancedTransformationMatrix");
+                out.bindAttributeLocation(NormalMatrix::Location, "instancedNormalMatrix");
+            }
+            if(flags >= Flag::InstancedTextureOffset)
+                out.bindAttributeLocation(TextureOffset::Location, "instancedTextureOffset");
+            out.bindFragmentDataLocation(ColorOutput, "fragmentColor");
+        }
+        #else
+        static_cast<void>(context);
+        #endif
+
+        out.submitLink();
+    }
+
+    return CompileState{std::move(out), std::move(vert), std::move(frag), version, cached};
+}
+
+PbrGL::CompileState PbrGL::compile(const Flags flags, const UnsignedInt lightCount) {
+    return compile(Configuration{}
+        .setFlags(flags)
+        .setLightCount(lightCount));
+}
+
+PbrGL::PbrGL(CompileState&& state): PbrGL{static_cast<PbrGL&&>(std::move(state))} {
+    #ifdef CORRADE_GRACEFUL_ASSERT
+    /* When graceful assertions fire from within compile(), we get a
+       NoCreate'd CompileState. Exiting makes it possible to test the
+       assert. */
+    if(!id()) return;
+    #endif
+
+    /* If the program was loaded from the binary cache, there's nothing to
+       check */
+    if(!state._cached) {
+        CORRADE_INTERNAL_ASSERT_OUTPUT(state._vert.checkCompile() && state._frag.checkCompile());
+        CORRADE_INTERNAL_ASSERT_OUTPUT(checkLink());
+        #ifndef MAGNUM_TARGET_WEBGL
+        saveCachedBinary({state._vert, state._frag});
+        #endif
+    }
+
+    #ifndef MAGNUM_TARGET_GLES
+    const GL::Context& context = GL::Context::current();
+    const GL::Version version = state._version;
+    #endif
+    const Flags flags = _flags;
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!context.isExtensionSupported<GL::Extensions::ARB::explicit_uniform_location>(version))
+    #endif
+    {
+        if(_drawCount > 1) _drawOffsetUniform = uniformLocation("drawOffset");
+    }
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!context.isExtensionSupported<GL::Extensions::ARB::shading_language_420pack>(version))
+    #endif
+    {
+        if(flags & Flag::BaseColorTexture) setUniform(uniformLocation("baseColorTexture"), BaseColorTextureUnit);
+        if(flags & Flag::MetallicRoughnessTexture) setUniform(uniformLocation("metallicRoughnessTexture"), MetallicRoughnessTextureUnit);
+        if(flags & Flag::NormalTexture) setUniform(uniformLocation("normalTexture"), NormalTextureUnit);
+        if(flags & Flag::OcclusionTexture) setUniform(uniformLocation("occlusionTexture"), OcclusionTextureUnit);
+        if(flags & Flag::EmissiveTexture) setUniform(uniformLocation("emissiveTexture"), EmissiveTextureUnit);
+        if(flags & Flag::ImageBasedLighting) {
+            setUniform(uniformLocation("brdfLookupTexture"), BrdfLookupTextureUnit);
+            setUniform(uniformLocation("environmentTexture"), EnvironmentTextureUnit);
+        }
+        setUniformBlockBinding(uniformBlockIndex("Projection"), ProjectionBufferBinding);
+        setUniformBlockBinding(uniformBlockIndex("Transformation"), TransformationBufferBinding);
+        setUniformBlockBinding(uniformBlockIndex("Draw"), DrawBufferBinding);
+        setUniformBlockBinding(uniformBlockIndex("Material"), MaterialBufferBinding);
+        if(flags & Flag::TextureTransformation)
+            setUniformBlockBinding(uniformBlockIndex("TextureTransformation"), TextureTransformationBufferBinding);
+        if(_lightCount)
+            setUniformBlockBinding(uniformBlockIndex("Light"), LightBufferBinding);
+        if(flags & Flag::ImageBasedLighting)
+            setUniformBlockBinding(uniformBlockIndex("ImageBasedLighting"), ImageBasedLightingBufferBinding);
+    }
+
+    /* Draw offset is zero by default */
+}
+
+PbrGL::PbrGL(const Flags flags, const UnsignedInt lightCount): PbrGL{compile(flags, lightCount)} {}
+
+PbrGL::PbrGL(const Configuration& configuration): PbrGL{compile(configuration)} {}
+
+PbrGL& PbrGL::setDrawOffset(const UnsignedInt offset) {
+    CORRADE_ASSERT(offset < _drawCount,
+        "Shaders::PbrGL::setDrawOffset(): draw offset" << offset << "is out of bounds for" << _drawCount << "draws", *this);
+    if(_drawCount > 1) setUniform(_drawOffsetUniform, offset);
+    return *this;
+}
+
+PbrGL& PbrGL::bindProjectionBuffer(GL::Buffer& buffer) {
+    buffer.bind(GL::Buffer::Target::Uniform, ProjectionBufferBinding);
+    return *this;
+}
+
+PbrGL& PbrGL::bindProjectionBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    buffer.bind(GL::Buffer::Target::Uniform, ProjectionBufferBinding, offset, size);
+    return *this;
+}
+
+PbrGL& PbrGL::bindTransformationBuffer(GL::Buffer& buffer) {
+    buffer.bind(GL::Buffer::Target::Uniform, TransformationBufferBinding);
+    return *this;
+}
+
+PbrGL& PbrGL::bindTransformationBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    buffer.bind(GL::Buffer::Target::Uniform, TransformationBufferBinding, offset, size);
+    return *this;
+}
+
+PbrGL& PbrGL::bindDrawBuffer(GL::Buffer& buffer) {
+    buffer.bind(GL::Buffer::Target::Uniform, DrawBufferBinding);
+    return *this;
+}
+
+PbrGL& PbrGL::bindDrawBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    buffer.bind(GL::Buffer::Target::Uniform, DrawBufferBinding, offset, size);
+    return *this;
+}
+
+PbrGL& PbrGL::bindTextureTransformationBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags & Flag::TextureTransformation,
+        "Shaders::PbrGL::bindTextureTransformationBuffer(): the shader was not created with texture transformation enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, TextureTransformationBufferBinding);
+    return *this;
+}
+
+PbrGL& PbrGL::bindTextureTransformationBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags & Flag::TextureTransformation,
+        "Shaders::PbrGL::bindTextureTransformationBuffer(): the shader was not created with texture transformation enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, TextureTransformationBufferBinding, offset, size);
+    return *this;
+}
+
+PbrGL& PbrGL::bindMaterialBuffer(GL::Buffer& buffer) {
+    buffer.bind(GL::Buffer::Target::Uniform, MaterialBufferBinding);
+    return *this;
+}
+
+PbrGL& PbrGL::bindMaterialBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    buffer.bind(GL::Buffer::Target::Uniform, MaterialBufferBinding, offset, size);
+    return *this;
+}
+
+PbrGL& PbrGL::bindLightBuffer(GL::Buffer& buffer) {
+    buffer.bind(GL::Buffer::Target::Uniform, LightBufferBinding);
+    return *this;
+}
+
+PbrGL& PbrGL::bindLightBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    buffer.bind(GL::Buffer::Target::Uniform, LightBufferBinding, offset, size);
+    return *this;
+}
+
+PbrGL& PbrGL::bindImageBasedLightingBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags & Flag::ImageBasedLighting,
+        "Shaders::PbrGL::bindImageBasedLightingBuffer(): the shader was not created with image-based lighting enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, ImageBasedLightingBufferBinding);
+    return *this;
+}
+
+PbrGL& PbrGL::bindImageBasedLightingBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags & Flag::ImageBasedLighting,
+        "Shaders::PbrGL::bindImageBasedLightingBuffer(): the shader was not created with image-based lighting enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, ImageBasedLightingBufferBinding, offset, size);
+    return *this;
+}
+
+PbrGL& PbrGL::bindBaseColorTexture(GL::Texture2D& texture) {
+    CORRADE_ASSERT(_flags & Flag::BaseColorTexture,
+        "Shaders::PbrGL::bindBaseColorTexture(): the shader was not created with base color texture enabled", *this);
+    CORRADE_ASSERT(!(_flags & Flag::TextureArrays),
+        "Shaders::PbrGL::bindBaseColorTexture(): the shader was created with texture arrays enabled, use a Texture2DArray instead", *this);
+    texture.bind(BaseColorTextureUnit);
+    return *this;
+}
+
+PbrGL& PbrGL::bindBaseColorTexture(GL::Texture2DArray& texture) {
+    CORRADE_ASSERT(_flags & Flag::BaseColorTexture,
+        "Shaders::PbrGL::bindBaseColorTexture(): the shader was not created with base color texture enabled", *this);
+    CORRADE_ASSERT(_flags & Flag::TextureArrays,
+        "Shaders::PbrGL::bindBaseColorTexture(): the shader was not created with texture arrays enabled, use a Texture2D instead", *this);
+    texture.bind(BaseColorTextureUnit);
+    return *this;
+}
+
+PbrGL& PbrGL::bindMetallicRoughnessTexture(GL::Texture2D& texture) {
+    CORRADE_ASSERT(_flags & Flag::MetallicRoughnessTexture,
+        "Shaders::PbrGL::bindMetallicRoughnessTexture(): the shader was not created with metallic/roughness texture enabled", *this);
+    CORRADE_ASSERT(!(_flags & Flag::TextureArrays),
+        "Shaders::PbrGL::bindMetallicRoughnessTexture(): the shader was created with texture arrays enabled, use a Texture2DArray instead", *this);
+    texture.bind(MetallicRoughnessTextureUnit);
+    return *this;
+}
+
+PbrGL& PbrGL::bindMetallicRoughnessTexture(GL::Texture2DArray& texture) {
+    CORRADE_ASSERT(_flags & Flag::MetallicRoughnessTexture,
+        "Shaders::PbrGL::bindMetallicRoughnessTexture(): the shader was not created with metallic/roughness texture enabled", *this);
+    CORRADE_ASSERT(_flags & Flag::TextureArrays,
+        "Shaders::PbrGL::bindMetallicRoughnessTexture(): the shader was not created with texture arrays enabled, use a Texture2D instead", *this);
+    texture.bind(MetallicRoughnessTextureUnit);
+    return *this;
+}
+
+PbrGL& PbrGL::bindNormalTexture(GL::Texture2D& texture) {
+    CORRADE_ASSERT(_flags & Flag::NormalTexture,
+        "Shaders::PbrGL::bindNormalTexture(): the shader was not created with normal texture enabled", *this);
+    CORRADE_ASSERT(!(_flags & Flag::TextureArrays),
+        "Shaders::PbrGL::bindNormalTexture(): the shader was created with texture arrays enabled, use a Texture2DArray instead", *this);
+    texture.bind(NormalTextureUnit);
+    return *this;
+}
+
+PbrGL& PbrGL::bindNormalTexture(GL::Texture2DArray& texture) {
+    CORRADE_ASSERT(_flags & Flag::NormalTexture,
+        "Shaders::PbrGL::bindNormalTexture(): the shader was not created with normal texture enabled", *this);
+    CORRADE_ASSERT(_flags & Flag::TextureArrays,
+        "Shaders::PbrGL::bindNormalTexture(): the shader was not created with texture arrays enabled, use a Texture2D instead", *this);
+    texture.bind(NormalTextureUnit);
+    return *this;
+}
+
+PbrGL& PbrGL::bindOcclusionTexture(GL::Texture2D& texture) {
+    CORRADE_ASSERT(_flags & Flag::OcclusionTexture,
+        "Shaders::PbrGL::bindOcclusionTexture(): the shader was not created with occlusion texture enabled", *this);
+    CORRADE_ASSERT(!(_flags & Flag::TextureArrays),
+        "Shaders::PbrGL::bindOcclusionTexture(): the shader was created with texture arrays enabled, use a Texture2DArray instead", *this);
+    texture.bind(OcclusionTextureUnit);
+    return *this;
+}
+
+PbrGL& PbrGL::bindOcclusionTexture(GL::Texture2DArray& texture) {
+    CORRADE_ASSERT(_flags & Flag::OcclusionTexture,
+        "Shaders::PbrGL::bindOcclusionTexture(): the shader was not created with occlusion texture enabled", *this);
+    CORRADE_ASSERT(_flags & Flag::TextureArrays,
+        "Shaders::PbrGL::bindOcclusionTexture(): the shader was not created with texture arrays enabled, use a Texture2D instead", *this);
+    texture.bind(OcclusionTextureUnit);
+    return *this;
+}
+
+PbrGL& PbrGL::bindEmissiveTexture(GL::Texture2D& texture) {
+    CORRADE_ASSERT(_flags & Flag::EmissiveTexture,
+        "Shaders::PbrGL::bindEmissiveTexture(): the shader was not created with emissive texture enabled", *this);
+    CORRADE_ASSERT(!(_flags & Flag::TextureArrays),
+        "Shaders::PbrGL::bindEmissiveTexture(): the shader was created with texture arrays enabled, use a Texture2DArray instead", *this);
+    texture.bind(EmissiveTextureUnit);
+    return *this;
+}
+
+PbrGL& PbrGL::bindEmissiveTexture(GL::Texture2DArray& texture) {
+    CORRADE_ASSERT(_flags & Flag::EmissiveTexture,
+        "Shaders::PbrGL::bindEmissiveTexture(): the shader was not created with emissive texture enabled", *this);
+    CORRADE_ASSERT(_flags & Flag::TextureArrays,
+        "Shaders::PbrGL::bindEmissiveTexture(): the shader was not created with texture arrays enabled, use a Texture2D instead", *this);
+    texture.bind(EmissiveTextureUnit);
+    return *this;
+}
+
+PbrGL& PbrGL::bindBrdfLookupTexture(GL::Texture2D& texture) {
+    CORRADE_ASSERT(_flags & Flag::ImageBasedLighting,
+        "Shaders::PbrGL::bindBrdfLookupTexture(): the shader was not created with image-based lighting enabled", *this);
+    texture.bind(BrdfLookupTextureUnit);
+    return *this;
+}
+
+PbrGL& PbrGL::bindEnvironmentTexture(GL::CubeMapTexture& texture) {
+    CORRADE_ASSERT(_flags & Flag::ImageBasedLighting,
+        "Shaders::PbrGL::bindEnvironmentTexture(): the shader was not created with image-based lighting enabled", *this);
+    texture.bind(EnvironmentTextureUnit);
+    return *this;
+}
+
+namespace {
+
+/* Full-screen passes used by pbrBrdfLookupTexture() and
+   pbrPrefilteredEnvironmentTexture(). Used just once, so compiled
+   synchronously and without the binary cache. */
+class PbrPrecomputeShader: public GL::AbstractShaderProgram {
+    public:
+        explicit PbrPrecomputeShader(const char* fragmentSource);
+
+        PbrPrecomputeShader& bindEnvironmentTexture(GL::CubeMapTexture& texture) {
+            texture.bind(0);
+            return *this;
+        }
+
+        PbrPrecomputeShader& setFace(Int face) {
+            setUniform(_faceUniform, face);
+            return *this;
+        }
+
+        PbrPrecomputeShader& setRoughness(Float roughness) {
+            setUniform(_roughnessUniform, roughness);
+            return *this;
+        }
+
+    private:
+        Int _faceUniform{0},
+            _roughnessUniform{1};
+};
+
+PbrPrecomputeShader::PbrPrecomputeShader(const char* const fragmentSource) {
+    #ifdef MAGNUM_BUILD_STATIC
+    /* Import resources on static build, if not already */
+    if(!Utility::Resource::hasGroup("MagnumShadersGL"))
+        importShaderResources();
+    #endif
+    Utility::Resource rs("MagnumShadersGL");
+
+    const GL::Context& context = GL::Context::current();
+
+    #ifndef MAGNUM_TARGET_GLES
+    const GL::Version version = context.supportedVersion({GL::Version::GL320, GL::Version::GL310, GL::Version::GL300});
+    #else
+    const GL::Version version = GL::Version::GLES300;
+    #endif
+
+    GL::Shader vert = Implementation::createCompatibilityShader(rs, version, GL::Shader::Type::Vertex);
+    GL::Shader frag = Implementation::createCompatibilityShader(rs, version, GL::Shader::Type::Fragment);
+
+    vert.addSource(rs.getString("FullScreenTriangle.glsl"))
+        .addSource(rs.getString("PbrPrecompute.vert"));
+    frag.addSource(rs.getString("generic.glsl"))
+        .addSource(rs.getString(fragmentSource));
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::compile({vert, frag}));
+    attachShaders({vert, frag});
+
+    /* Without gl_VertexID the triangle is taken from an attribute */
+    if(!context.isExtensionSupported<GL::Extensions::MAGNUM::shader_vertex_id>(version))
+        bindAttributeLocation(GenericGL2D::Position::Location, "position");
+
+    /* ES3 has this done in the shader directly and doesn't even provide
+       bindFragmentDataLocation() */
+    #ifndef MAGNUM_TARGET_GLES
+    if(!context.isExtensionSupported<GL::Extensions::ARB::explicit_attrib_location>(version))
+        bindFragmentDataLocation(GenericGL2D::ColorOutput, "fragmentColor");
+    #endif
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!context.isExtensionSupported<GL::Extensions::ARB::explicit_uniform_location>(version))
+    #endif
+    {
+        _faceUniform = uniformLocation("face");
+        _roughnessUniform = uniformLocation("roughness");
+    }
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!context.isExtensionSupported<GL::Extensions::ARB::shading_language_420pack>(version))
+    #endif
+    {
+        setUniform(uniformLocation("environmentTexture"), 0);
+    }
+}
+
+GL::Mesh fullScreenTriangle() {
+    GL::Mesh mesh;
+    mesh.setCount(3);
+
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::MAGNUM::shader_vertex_id>()) {
+        constexpr Vector2 triangle[]{
+            {-1.0f,  1.0f},
+            {-1.0f, -3.0f},
+            { 3.0f,  1.0f}
+        };
+        GL::Buffer buffer{GL::Buffer::TargetHint::Array};
+        buffer.setData(triangle, GL::BufferUsage::StaticDraw);
+        mesh.addVertexBuffer(std::move(buffer), 0, GenericGL2D::Position{});
+    }
+
+    return mesh;
+}
+
+}
+
+GL::Texture2D pbrBrdfLookupTexture(const Vector2i& size) {
+    CORRADE_ASSERT(size.product(),
+        "Shaders::pbrBrdfLookupTexture(): expected a non-zero size, got" << Debug::packed << size, GL::Texture2D{NoCreate});
+    #ifdef MAGNUM_TARGET_GLES
+    MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::EXT::color_buffer_float);
+    #endif
+
+    GL::Texture2D out;
+    out.setMinificationFilter(SamplerFilter::Linear)
+        .setMagnificationFilter(SamplerFilter::Linear)
+        .setWrapping(SamplerWrapping::ClampToEdge)
+        .setStorage(1, GL::TextureFormat::RG16F, size);
+
+    GL::Framebuffer framebuffer{{{}, size}};
+    framebuffer.attachTexture(GL::Framebuffer::ColorAttachment{0}, out, 0)
+        .bind();
+
+    PbrPrecomputeShader{"PbrBrdfLookup.frag"}
+        .draw(fullScreenTriangle());
+
+    return out;
+}
+
+GL::CubeMapTexture pbrPrefilteredEnvironmentTexture(GL::CubeMapTexture& environment, const Int size, const Int levelCount) {
+    CORRADE_ASSERT(size > 0,
+        "Shaders::pbrPrefilteredEnvironmentTexture(): expected a non-zero size", GL::CubeMapTexture{NoCreate});
+    CORRADE_ASSERT(levelCount >= 1 && levelCount <= Int(Math::log2(size)) + 1,
+        "Shaders::pbrPrefilteredEnvironmentTexture(): expected level count to be between 1 and" << Math::log2(size) + 1 << "for size" << size << "but got" << levelCount, GL::CubeMapTexture{NoCreate});
+    #ifdef MAGNUM_TARGET_GLES
+    MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::EXT::color_buffer_float);
+    #endif
+
+    GL::CubeMapTexture out;
+    out.setMinificationFilter(SamplerFilter::Linear, SamplerMipmap::Linear)
+        .setMagnificationFilter(SamplerFilter::Linear)
+        .setWrapping(SamplerWrapping::ClampToEdge)
+        .setStorage(levelCount, GL::TextureFormat::RGBA16F, Vector2i{size});
+
+    PbrPrecomputeShader shader{"PbrPrefilter.frag"};
+    shader.bindEnvironmentTexture(environment);
+    GL::Mesh mesh = fullScreenTriangle();
+
+    constexpr GL::CubeMapCoordinate faces[]{
+        GL::CubeMapCoordinate::PositiveX,
+        GL::CubeMapCoordinate::NegativeX,
+        GL::CubeMapCoordinate::PositiveY,
+        GL::CubeMapCoordinate::NegativeY,
+        GL::CubeMapCoordinate::PositiveZ,
+        GL::CubeMapCoordinate::NegativeZ
+    };
+
+    GL::Framebuffer framebuffer{{{}, Vector2i{size}}};
+    for(Int level = 0; level != levelCount; ++level) {
+        const Vector2i levelSize{Math::max(size >> level, 1)};
+        framebuffer.setViewport({{}, levelSize});
+        shader.setRoughness(levelCount == 1 ? 0.0f : Float(level)/Float(levelCount - 1));
+        for(Int face = 0; face != 6; ++face) {
+            framebuffer.attachCubeMapTexture(GL::Framebuffer::ColorAttachment{0}, out, faces[face], level)
+                .bind();
+            shader.setFace(face)
+                .draw(mesh);
+        }
+    }
+
+    return out;
+}
+
+Debug& operator<<(Debug& debug, const PbrGL::Flag value) {
+    debug << "Shaders::PbrGL::Flag" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(v) case PbrGL::Flag::v: return debug << "::" #v;
+        _c(BaseColorTexture)
+        _c(MetallicRoughnessTexture)
+        _c(NormalTexture)
+        _c(OcclusionTexture)
+        _c(EmissiveTexture)
+        _c(AlphaMask)
+        _c(VertexColor)
+        _c(TextureTransformation)
+        _c(InstancedTransformation)
+        _c(InstancedTextureOffset)
+        _c(MultiDraw)
+        _c(TextureArrays)
+        _c(LightCulling)
+        _c(ImageBasedLighting)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedInt(value)) << Debug::nospace << ")";
+}
+
+Debug& operator<<(Debug& debug, const PbrGL::Flags value) {
+    return Containers::enumSetDebugOutput(debug, value, "Shaders::PbrGL::Flags{}", {
+        PbrGL::Flag::BaseColorTexture,
+        PbrGL::Flag::MetallicRoughnessTexture,
+        PbrGL::Flag::NormalTexture,
+        PbrGL::Flag::OcclusionTexture,
+        PbrGL::Flag::EmissiveTexture,
+        PbrGL::Flag::AlphaMask,
+        PbrGL::Flag::VertexColor,
+        PbrGL::Flag::InstancedTextureOffset, /* Superset of TextureTransformation */
+        PbrGL::Flag::TextureTransformation,
+        PbrGL::Flag::InstancedTransformation,
+        PbrGL::Flag::MultiDraw,
+        PbrGL::Flag::TextureArrays,
+        PbrGL::Flag::LightCulling,
+        PbrGL::Flag::ImageBasedLighting
+    });
+}
+
+}}
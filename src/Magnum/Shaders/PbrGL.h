@@ -0,0 +1,901 @@
+#ifndef Magnum_Shaders_PbrGL_h
+#define Magnum_Shaders_PbrGL_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MAGNUM_TARGET_GLES2
+/** @file
+ * @brief Class @ref Magnum::Shaders::PbrGL, function @ref Magnum::Shaders::pbrBrdfLookupTexture(), @ref Magnum::Shaders::pbrPrefilteredEnvironmentTexture()
+ * @m_since_latest
+ */
+#endif
+
+#include "Magnum/GL/AbstractShaderProgram.h"
+#include "Magnum/GL/Shader.h"
+#include "Magnum/Shaders/GenericGL.h"
+#include "Magnum/Shaders/visibility.h"
+
+#ifndef MAGNUM_TARGET_GLES2
+namespace Magnum { namespace Shaders {
+
+/**
+@brief PBR metallic/roughness OpenGL shader
+@m_since_latest
+
+Physically-based shader implementing the glTF metallic/roughness material
+model --- a Lambertian diffuse term and a GGX specular term with Smith
+height-correlated visibility and Schlick Fresnel --- with optional
+image-based lighting using the split-sum approximation. It's designed to
+consume @ref Trade::PbrMetallicRoughnessMaterialData directly, each material
+property has a matching field in @ref PbrMaterialUniform.
+
+Unlike @ref PhongGL, the shader works exclusively with uniform buffers, there
+are no classic uniform setters. Apart from that it follows the same design ---
+per-draw @ref TransformationUniform3D, @ref PbrDrawUniform and
+@ref TextureTransformationUniform arrays indexed by @ref setDrawOffset() or
+@glsl gl_DrawID @ce with @ref Flag::MultiDraw, a @ref PbrMaterialUniform array
+referenced from @ref PbrDrawUniform::materialId, instanced transformation and
+texture offset attributes and texture arrays. Lights are supplied in the same
+@ref PhongLightUniform array as used by @ref PhongGL, with
+@ref PhongLightUniform::specularColor being ignored.
+
+Object ID output, skinning, light clusters, bindless textures,
+order-independent transparency and the depth-only variant available in
+@ref PhongGL aren't implemented.
+
+@section Shaders-PbrGL-usage Example usage
+
+Material properties are expected to be copied from imported material data
+once, the draw then only references them by index:
+
+@snippet MagnumShaders-gl.cpp PbrGL-usage
+
+@section Shaders-PbrGL-ibl Image-based lighting
+
+With @ref Flag::ImageBasedLighting, the shader additionally samples a BRDF
+lookup texture bound with @ref bindBrdfLookupTexture() and a prefiltered
+environment cube map bound with @ref bindEnvironmentTexture(). Both are
+generated once on the GPU with @ref pbrBrdfLookupTexture() and
+@ref pbrPrefilteredEnvironmentTexture(). Each mip level of the prefiltered
+map corresponds to a linearly increasing roughness; the diffuse contribution
+is approximated by sampling the roughest level in the direction of the normal,
+so there's no need for a separate irradiance map. The
+@ref PbrImageBasedLightingUniform supplied via
+@ref bindImageBasedLightingBuffer() specifies the mip level count, intensity
+and a rotation from camera space to the space of the environment map:
+
+@snippet MagnumShaders-gl.cpp PbrGL-ibl
+
+On desktop GL it's recommended to enable
+@ref GL::Renderer::Feature::SeamlessCubeMapTexture, otherwise the rough
+levels of the prefiltered map have visible seams at cube face edges.
+
+@requires_gl30 Extension @gl_extension{ARB,uniform_buffer_object} and
+    @gl_extension{EXT,gpu_shader4}
+@requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+*/
+class MAGNUM_SHADERS_EXPORT PbrGL: public GL::AbstractShaderProgram {
+    public:
+        /**
+         * @brief Vertex position
+         *
+         * @ref shaders-generic "Generic attribute",
+         * @ref Magnum::Vector3 "Vector3".
+         */
+        typedef GenericGL3D::Position Position;
+
+        /**
+         * @brief Normal direction
+         *
+         * @ref shaders-generic "Generic attribute",
+         * @ref Magnum::Vector3 "Vector3".
+         */
+        typedef GenericGL3D::Normal Normal;
+
+        /**
+         * @brief Tangent direction with a bitangent sign
+         *
+         * @ref shaders-generic "Generic attribute",
+         * @ref Magnum::Vector4 "Vector4". Used only if
+         * @ref Flag::NormalTexture is set.
+         */
+        typedef GenericGL3D::Tangent4 Tangent4;
+
+        /**
+         * @brief 2D texture coordinates
+         *
+         * @ref shaders-generic "Generic attribute",
+         * @ref Magnum::Vector2 "Vector2", used only if at least one of
+         * @ref Flag::BaseColorTexture, @ref Flag::MetallicRoughnessTexture,
+         * @ref Flag::NormalTexture, @ref Flag::OcclusionTexture and
+         * @ref Flag::EmissiveTexture is set.
+         */
+        typedef GenericGL3D::TextureCoordinates TextureCoordinates;
+
+        /**
+         * @brief Three-component vertex color
+         *
+         * @ref shaders-generic "Generic attribute", @ref Magnum::Color3. Use
+         * either this or the @ref Color4 attribute. Used only if
+         * @ref Flag::VertexColor is set.
+         */
+        typedef GenericGL3D::Color3 Color3;
+
+        /**
+         * @brief Four-component vertex color
+         *
+         * @ref shaders-generic "Generic attribute", @ref Magnum::Color4. Use
+         * either this or the @ref Color3 attribute. Used only if
+         * @ref Flag::VertexColor is set.
+         */
+        typedef GenericGL3D::Color4 Color4;
+
+        /**
+         * @brief (Instanced) transformation matrix
+         *
+         * @ref shaders-generic "Generic attribute", @ref Magnum::Matrix4.
+         * Used only if @ref Flag::InstancedTransformation is set.
+         */
+        typedef GenericGL3D::TransformationMatrix TransformationMatrix;
+
+        /**
+         * @brief (Instanced) normal matrix
+         *
+         * @ref shaders-generic "Generic attribute", @ref Magnum::Matrix3x3.
+         * Used only if @ref Flag::InstancedTransformation is set.
+         */
+        typedef GenericGL3D::NormalMatrix NormalMatrix;
+
+        /**
+         * @brief (Instanced) texture offset
+         *
+         * @ref shaders-generic "Generic attribute", @ref Magnum::Vector2. Used
+         * only if @ref Flag::InstancedTextureOffset is set.
+         */
+        typedef typename GenericGL3D::TextureOffset TextureOffset;
+
+        /**
+         * @brief (Instanced) texture offset and layer
+         *
+         * @ref shaders-generic "Generic attribute", @ref Magnum::Vector3, with
+         * the last component interpreted as an integer. Use either this or the
+         * @ref TextureOffset attribute. First two components used only if
+         * @ref Flag::InstancedTextureOffset is set, third component only if
+         * @ref Flag::TextureArrays is set.
+         */
+        typedef typename GenericGL3D::TextureOffsetLayer TextureOffsetLayer;
+
+        enum: UnsignedInt {
+            /**
+             * Color shader output. @ref shaders-generic "Generic output",
+             * present always. Expects three- or four-component floating-point
+             * or normalized buffer attachment. The output is in linear space,
+             * use a @ref GL::TextureFormat::SRGB8Alpha8 attachment or a
+             * floating-point attachment with a subsequent tonemapping pass
+             * for correct results.
+             */
+            ColorOutput = GenericGL3D::ColorOutput
+        };
+
+        /**
+         * @brief Flag
+         *
+         * @see @ref Flags, @ref flags()
+         */
+        enum class Flag: UnsignedInt {
+            /**
+             * Multiply base color with a texture.
+             * @see @ref PbrMaterialUniform::baseColor,
+             *      @ref bindBaseColorTexture()
+             */
+            BaseColorTexture = 1 << 0,
+
+            /**
+             * Multiply metalness and roughness with the blue and green
+             * channel of a texture, matching the glTF packing.
+             * @see @ref PbrMaterialUniform::metalness,
+             *      @ref PbrMaterialUniform::roughness,
+             *      @ref bindMetallicRoughnessTexture()
+             */
+            MetallicRoughnessTexture = 1 << 1,
+
+            /**
+             * Modify normals according to a texture. Requires the
+             * @ref Tangent4 attribute to be present.
+             * @see @ref PbrMaterialUniform::normalTextureScale,
+             *      @ref bindNormalTexture()
+             */
+            NormalTexture = 1 << 2,
+
+            /**
+             * Attenuate ambient and image-based lighting with the red channel
+             * of a texture.
+             * @see @ref PbrMaterialUniform::occlusionStrength,
+             *      @ref bindOcclusionTexture()
+             */
+            OcclusionTexture = 1 << 3,
+
+            /**
+             * Multiply emissive color with a texture.
+             * @see @ref PbrMaterialUniform::emissiveColor,
+             *      @ref bindEmissiveTexture()
+             */
+            EmissiveTexture = 1 << 4,
+
+            /**
+             * Enable alpha masking. If the combined fragment color has an
+             * alpha less than the @ref PbrMaterialUniform::alphaMask value,
+             * given fragment is discarded.
+             */
+            AlphaMask = 1 << 5,
+
+            /**
+             * Multiply the base color with a vertex color. Requires either
+             * the @ref Color3 or @ref Color4 attribute to be present.
+             */
+            VertexColor = 1 << 6,
+
+            /**
+             * Enable texture coordinate transformation. Texture transformation
+             * is supplied via @ref bindTextureTransformationBuffer().
+             */
+            TextureTransformation = 1 << 7,
+
+            /**
+             * Instanced transformation. Retrieves a per-instance
+             * transformation and normal matrix from the
+             * @ref TransformationMatrix / @ref NormalMatrix attributes and
+             * uses them together with the matrices coming from the
+             * @ref TransformationUniform3D and @ref PbrDrawUniform
+             * buffers, first the per-instance and then the per-draw one.
+             */
+            InstancedTransformation = 1 << 8,
+
+            /**
+             * Instanced texture offset. Retrieves a per-instance offset vector
+             * from the @ref TextureOffset attribute and uses it together with
+             * the matrix coming from @ref TextureTransformationUniform, first
+             * the per-instance vector and then the per-draw matrix. If
+             * @ref Flag::TextureArrays is set as well, a three-component
+             * @ref TextureOffsetLayer attribute can be used instead of
+             * @ref TextureOffset to specify per-instance texture layer, which
+             * gets added to @ref TextureTransformationUniform::layer.
+             */
+            InstancedTextureOffset = (1 << 9)|TextureTransformation,
+
+            /**
+             * Enable multidraw functionality. Adds the value from
+             * @ref setDrawOffset() with the @glsl gl_DrawID @ce builtin,
+             * which makes draws submitted via
+             * @ref GL::AbstractShaderProgram::draw(Containers::ArrayView<const Containers::Reference<MeshView>>)
+             * pick up per-draw parameters directly, without having to rebind
+             * the uniform buffers or specify @ref setDrawOffset() before each
+             * draw.
+             * @requires_gl46 Extension @gl_extension{ARB,shader_draw_parameters}
+             * @requires_es_extension OpenGL ES 3.0 and extension
+             *      @m_class{m-doc-external} [ANGLE_multi_draw](https://chromium.googlesource.com/angle/angle/+/master/extensions/ANGLE_multi_draw.txt)
+             *      (unlisted)
+             * @requires_webgl_extension WebGL 2.0 and extension
+             *      @webgl_extension{WEBGL,multi_draw}
+             */
+            MultiDraw = 1 << 10,
+
+            /**
+             * Use 2D texture arrays. Expects that the texture is supplied via
+             * @ref bindBaseColorTexture(GL::Texture2DArray&) and related
+             * overloads instead of the @ref GL::Texture2D variants and the
+             * layer is set via @ref TextureTransformationUniform::layer.
+             * Requires @ref Flag::TextureTransformation to be enabled as well.
+             * @requires_gl30 Extension @gl_extension{EXT,texture_array}
+             */
+            TextureArrays = 1 << 11,
+
+            /**
+             * Enable light culling. Lights are taken from the range
+             * specified by @ref PbrDrawUniform::lightOffset and
+             * @ref PbrDrawUniform::lightCount instead of using all lights.
+             */
+            LightCulling = 1 << 12,
+
+            /**
+             * Enable image-based lighting. Expects a BRDF lookup texture, a
+             * prefiltered environment cube map and a
+             * @ref PbrImageBasedLightingUniform buffer to be bound. See
+             * @ref Shaders-PbrGL-ibl for more information.
+             * @see @ref bindBrdfLookupTexture(),
+             *      @ref bindEnvironmentTexture(),
+             *      @ref bindImageBasedLightingBuffer()
+             */
+            ImageBasedLighting = 1 << 13
+        };
+
+        /**
+         * @brief Flags
+         *
+         * @see @ref flags()
+         */
+        typedef Containers::EnumSet<Flag> Flags;
+
+        class Configuration;
+        class CompileState;
+
+        /**
+         * @brief Compile asynchronously
+         *
+         * Compared to @ref PbrGL(Flags, UnsignedInt) can perform an
+         * asynchronous compilation and linking. See @ref shaders-async for
+         * more information.
+         * @see @ref PbrGL(CompileState&&), @ref compile(const Configuration&)
+         */
+        static CompileState compile(Flags flags = {}, UnsignedInt lightCount = 1);
+
+        /**
+         * @brief Compile with a configuration asynchronously
+         *
+         * Compared to @ref PbrGL(const Configuration&) can perform an
+         * asynchronous compilation and linking. See @ref shaders-async for
+         * more information.
+         * @see @ref PbrGL(CompileState&&)
+         */
+        static CompileState compile(const Configuration& configuration);
+
+        /**
+         * @brief Constructor
+         * @param flags         Flags
+         * @param lightCount    Size of a @ref PhongLightUniform buffer bound
+         *      with @ref bindLightBuffer()
+         *
+         * Equivalent to @ref PbrGL(const Configuration&) with material and
+         * draw count set to @cpp 1 @ce.
+         */
+        explicit PbrGL(Flags flags = {}, UnsignedInt lightCount = 1);
+
+        /**
+         * @brief Construct with a configuration
+         *
+         * @see @ref compile(const Configuration&)
+         */
+        explicit PbrGL(const Configuration& configuration);
+
+        /**
+         * @brief Finalize an asynchronous compilation
+         *
+         * Takes an asynchronous compilation state returned by @ref compile()
+         * and forms a ready-to-use shader object. See @ref shaders-async for
+         * more information.
+         */
+        explicit PbrGL(CompileState&& state);
+
+        /**
+         * @brief Construct without creating the underlying OpenGL object
+         *
+         * The constructed instance is equivalent to a moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         *
+         * This function can be safely used for constructing (and later
+         * destructing) objects even without any OpenGL context being active.
+         * However note that this is a low-level and a potentially dangerous
+         * API, see the documentation of @ref NoCreate for alternatives.
+         */
+        explicit PbrGL(NoCreateT) noexcept: GL::AbstractShaderProgram{NoCreate} {}
+
+        /** @brief Copying is not allowed */
+        PbrGL(const PbrGL&) = delete;
+
+        /** @brief Move constructor */
+        PbrGL(PbrGL&&) noexcept = default;
+
+        /** @brief Copying is not allowed */
+        PbrGL& operator=(const PbrGL&) = delete;
+
+        /** @brief Move assignment */
+        PbrGL& operator=(PbrGL&&) noexcept = default;
+
+        /** @brief Flags */
+        Flags flags() const { return _flags; }
+
+        /**
+         * @brief Light count
+         *
+         * Statically defined size of the @ref PhongLightUniform uniform
+         * buffer bound with @ref bindLightBuffer().
+         * @see @ref Configuration::setLightCount()
+         */
+        UnsignedInt lightCount() const { return _lightCount; }
+
+        /**
+         * @brief Material count
+         *
+         * Statically defined size of the @ref PbrMaterialUniform uniform
+         * buffer bound with @ref bindMaterialBuffer().
+         * @see @ref Configuration::setMaterialCount()
+         */
+        UnsignedInt materialCount() const { return _materialCount; }
+
+        /**
+         * @brief Draw count
+         *
+         * Statically defined size of each of the @ref ProjectionUniform3D,
+         * @ref TransformationUniform3D, @ref PbrDrawUniform and
+         * @ref TextureTransformationUniform uniform buffers.
+         * @see @ref Configuration::setDrawCount()
+         */
+        UnsignedInt drawCount() const { return _drawCount; }
+
+        /**
+         * @brief Set a draw offset
+         * @return Reference to self (for method chaining)
+         *
+         * Specifies which item in the @ref TransformationUniform3D,
+         * @ref PbrDrawUniform and @ref TextureTransformationUniform buffers
+         * bound with @ref bindTransformationBuffer(), @ref bindDrawBuffer()
+         * and @ref bindTextureTransformationBuffer() should be used for
+         * current draw. Expects that @p offset is less than
+         * @ref drawCount(). Initial value is @cpp 0 @ce, if
+         * @ref drawCount() is @cpp 1 @ce, the function is a no-op as the
+         * shader assumes draw offset to be always zero.
+         *
+         * If @ref Flag::MultiDraw is set, @glsl gl_DrawID @ce is added to
+         * this value, which makes each draw submitted via
+         * @ref GL::AbstractShaderProgram::draw(Containers::ArrayView<const Containers::Reference<MeshView>>)
+         * pick up its own per-draw parameters.
+         */
+        PbrGL& setDrawOffset(UnsignedInt offset);
+
+        /** @{
+         * @name Uniform buffer binding
+         */
+
+        /**
+         * @brief Bind a projection uniform buffer
+         * @return Reference to self (for method chaining)
+         *
+         * The buffer is expected to contain at least one instance of
+         * @ref ProjectionUniform3D. At the very least you need to call also
+         * @ref bindTransformationBuffer(), @ref bindDrawBuffer() and
+         * @ref bindMaterialBuffer().
+         */
+        PbrGL& bindProjectionBuffer(GL::Buffer& buffer);
+        /** @overload */
+        PbrGL& bindProjectionBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Bind a transformation uniform buffer
+         * @return Reference to self (for method chaining)
+         *
+         * The buffer is expected to contain @ref drawCount() instances of
+         * @ref TransformationUniform3D.
+         */
+        PbrGL& bindTransformationBuffer(GL::Buffer& buffer);
+        /** @overload */
+        PbrGL& bindTransformationBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Bind a draw uniform buffer
+         * @return Reference to self (for method chaining)
+         *
+         * The buffer is expected to contain @ref drawCount() instances of
+         * @ref PbrDrawUniform.
+         */
+        PbrGL& bindDrawBuffer(GL::Buffer& buffer);
+        /** @overload */
+        PbrGL& bindDrawBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Bind a texture transformation uniform buffer
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @ref Flag::TextureTransformation is set. The buffer is
+         * expected to contain @ref drawCount() instances of
+         * @ref TextureTransformationUniform.
+         */
+        PbrGL& bindTextureTransformationBuffer(GL::Buffer& buffer);
+        /** @overload */
+        PbrGL& bindTextureTransformationBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Bind a material uniform buffer
+         * @return Reference to self (for method chaining)
+         *
+         * The buffer is expected to contain @ref materialCount() instances of
+         * @ref PbrMaterialUniform.
+         */
+        PbrGL& bindMaterialBuffer(GL::Buffer& buffer);
+        /** @overload */
+        PbrGL& bindMaterialBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Bind a light uniform buffer
+         * @return Reference to self (for method chaining)
+         *
+         * The buffer is expected to contain @ref lightCount() instances of
+         * @ref PhongLightUniform.
+         */
+        PbrGL& bindLightBuffer(GL::Buffer& buffer);
+        /** @overload */
+        PbrGL& bindLightBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Bind an image-based lighting uniform buffer
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @ref Flag::ImageBasedLighting is set. The buffer is
+         * expected to contain a single @ref PbrImageBasedLightingUniform.
+         */
+        PbrGL& bindImageBasedLightingBuffer(GL::Buffer& buffer);
+        /** @overload */
+        PbrGL& bindImageBasedLightingBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @}
+         */
+
+        /** @{
+         * @name Texture binding
+         */
+
+        /**
+         * @brief Bind a base color texture
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that the shader was created with
+         * @ref Flag::BaseColorTexture enabled and @ref Flag::TextureArrays
+         * not enabled. The texture is expected to be in sRGB, i.e. with one
+         * of the sRGB @ref GL::TextureFormat values.
+         */
+        PbrGL& bindBaseColorTexture(GL::Texture2D& texture);
+
+        /**
+         * @brief Bind a base color array texture
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that the shader was created with both
+         * @ref Flag::BaseColorTexture and @ref Flag::TextureArrays enabled.
+         */
+        PbrGL& bindBaseColorTexture(GL::Texture2DArray& texture);
+
+        /**
+         * @brief Bind a metallic/roughness texture
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that the shader was created with
+         * @ref Flag::MetallicRoughnessTexture enabled and
+         * @ref Flag::TextureArrays not enabled.
+         */
+        PbrGL& bindMetallicRoughnessTexture(GL::Texture2D& texture);
+
+        /**
+         * @brief Bind a metallic/roughness array texture
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that the shader was created with both
+         * @ref Flag::MetallicRoughnessTexture and @ref Flag::TextureArrays
+         * enabled.
+         */
+        PbrGL& bindMetallicRoughnessTexture(GL::Texture2DArray& texture);
+
+        /**
+         * @brief Bind a normal texture
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that the shader was created with @ref Flag::NormalTexture
+         * enabled and @ref Flag::TextureArrays not enabled.
+         */
+        PbrGL& bindNormalTexture(GL::Texture2D& texture);
+
+        /**
+         * @brief Bind a normal array texture
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that the shader was created with both
+         * @ref Flag::NormalTexture and @ref Flag::TextureArrays enabled.
+         */
+        PbrGL& bindNormalTexture(GL::Texture2DArray& texture);
+
+        /**
+         * @brief Bind an occlusion texture
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that the shader was created with
+         * @ref Flag::OcclusionTexture enabled and @ref Flag::TextureArrays
+         * not enabled.
+         */
+        PbrGL& bindOcclusionTexture(GL::Texture2D& texture);
+
+        /**
+         * @brief Bind an occlusion array texture
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that the shader was created with both
+         * @ref Flag::OcclusionTexture and @ref Flag::TextureArrays enabled.
+         */
+        PbrGL& bindOcclusionTexture(GL::Texture2DArray& texture);
+
+        /**
+         * @brief Bind an emissive texture
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that the shader was created with
+         * @ref Flag::EmissiveTexture enabled and @ref Flag::TextureArrays
+         * not enabled. The texture is expected to be in sRGB.
+         */
+        PbrGL& bindEmissiveTexture(GL::Texture2D& texture);
+
+        /**
+         * @brief Bind an emissive array texture
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that the shader was created with both
+         * @ref Flag::EmissiveTexture and @ref Flag::TextureArrays enabled.
+         */
+        PbrGL& bindEmissiveTexture(GL::Texture2DArray& texture);
+
+        /**
+         * @brief Bind a BRDF lookup texture
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that the shader was created with
+         * @ref Flag::ImageBasedLighting enabled. The texture is expected to
+         * be created with @ref pbrBrdfLookupTexture().
+         * @see @ref Shaders-PbrGL-ibl
+         */
+        PbrGL& bindBrdfLookupTexture(GL::Texture2D& texture);
+
+        /**
+         * @brief Bind a prefiltered environment texture
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that the shader was created with
+         * @ref Flag::ImageBasedLighting enabled. The texture is expected to
+         * be created with @ref pbrPrefilteredEnvironmentTexture().
+         * @see @ref Shaders-PbrGL-ibl
+         */
+        PbrGL& bindEnvironmentTexture(GL::CubeMapTexture& texture);
+
+        /**
+         * @}
+         */
+
+        /* Overloads to remove WTF-factor from method chaining order */
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        PbrGL& draw(GL::Mesh& mesh) {
+            return static_cast<PbrGL&>(GL::AbstractShaderProgram::draw(mesh));
+        }
+        PbrGL& draw(GL::Mesh&& mesh) {
+            return static_cast<PbrGL&>(GL::AbstractShaderProgram::draw(mesh));
+        }
+        PbrGL& draw(GL::MeshView& mesh) {
+            return static_cast<PbrGL&>(GL::AbstractShaderProgram::draw(mesh));
+        }
+        PbrGL& draw(GL::MeshView&& mesh) {
+            return static_cast<PbrGL&>(GL::AbstractShaderProgram::draw(mesh));
+        }
+        PbrGL& draw(GL::Mesh& mesh, const Containers::StridedArrayView1D<const UnsignedInt>& counts, const Containers::StridedArrayView1D<const UnsignedInt>& vertexOffsets, const Containers::StridedArrayView1D<const UnsignedInt>& indexOffsets) {
+            return static_cast<PbrGL&>(GL::AbstractShaderProgram::draw(mesh, counts, vertexOffsets, indexOffsets));
+        }
+        #ifndef CORRADE_TARGET_32BIT
+        PbrGL& draw(GL::Mesh& mesh, const Containers::StridedArrayView1D<const UnsignedInt>& counts, const Containers::StridedArrayView1D<const UnsignedInt>& vertexOffsets, const Containers::StridedArrayView1D<const UnsignedLong>& indexOffsets) {
+            return static_cast<PbrGL&>(GL::AbstractShaderProgram::draw(mesh, counts, vertexOffsets, indexOffsets));
+        }
+        PbrGL& draw(GL::Mesh& mesh, const Containers::StridedArrayView1D<const UnsignedInt>& counts, const Containers::StridedArrayView1D<const UnsignedInt>& vertexOffsets, std::nullptr_t) {
+            return static_cast<PbrGL&>(GL::AbstractShaderProgram::draw(mesh, counts, vertexOffsets, nullptr));
+        }
+        #endif
+        PbrGL& draw(Containers::ArrayView<const Containers::Reference<GL::MeshView>> meshes) {
+            return static_cast<PbrGL&>(GL::AbstractShaderProgram::draw(meshes));
+        }
+        PbrGL& draw(std::initializer_list<Containers::Reference<GL::MeshView>> meshes) {
+            return static_cast<PbrGL&>(GL::AbstractShaderProgram::draw(meshes));
+        }
+        #endif
+
+    private:
+        /* Creates the GL shader program object but does nothing else.
+           Internal, used by compile(). */
+        explicit PbrGL(NoInitT) {}
+
+        /* Prevent accidentally calling irrelevant functions */
+        #ifndef MAGNUM_TARGET_GLES
+        using GL::AbstractShaderProgram::drawTransformFeedback;
+        #endif
+        #ifndef MAGNUM_TARGET_WEBGL
+        using GL::AbstractShaderProgram::dispatchCompute;
+        #endif
+
+        Flags _flags;
+        UnsignedInt _lightCount{}, _materialCount{}, _drawCount{};
+        Int _drawOffsetUniform{0};
+};
+
+/**
+@brief Configuration
+
+@see @ref PbrGL(const Configuration&), @ref compile(const Configuration&)
+*/
+class MAGNUM_SHADERS_EXPORT PbrGL::Configuration {
+    public:
+        explicit Configuration() = default;
+
+        /** @brief Flags */
+        Flags flags() const { return _flags; }
+
+        /**
+         * @brief Set flags
+         *
+         * No flags are set by default.
+         * @see @ref PbrGL::flags()
+         */
+        Configuration& setFlags(Flags flags) {
+            _flags = flags;
+            return *this;
+        }
+
+        /** @brief Light count */
+        UnsignedInt lightCount() const { return _lightCount; }
+
+        /**
+         * @brief Set light count
+         *
+         * Describes size of a @ref PhongLightUniform buffer bound with
+         * @ref PbrGL::bindLightBuffer(). Can be @cpp 0 @ce, in which case
+         * only emissive and image-based lighting is done. Default value is
+         * @cpp 1 @ce.
+         * @see @ref PbrGL::lightCount()
+         */
+        Configuration& setLightCount(UnsignedInt count) {
+            _lightCount = count;
+            return *this;
+        }
+
+        /** @brief Material count */
+        UnsignedInt materialCount() const { return _materialCount; }
+
+        /**
+         * @brief Set material count
+         *
+         * Describes size of a @ref PbrMaterialUniform buffer bound with
+         * @ref PbrGL::bindMaterialBuffer(). Default value is @cpp 1 @ce.
+         * @see @ref PbrGL::materialCount()
+         */
+        Configuration& setMaterialCount(UnsignedInt count) {
+            _materialCount = count;
+            return *this;
+        }
+
+        /** @brief Draw count */
+        UnsignedInt drawCount() const { return _drawCount; }
+
+        /**
+         * @brief Set draw count
+         *
+         * Describes size of a @ref ProjectionUniform3D /
+         * @ref TransformationUniform3D / @ref PbrDrawUniform /
+         * @ref TextureTransformationUniform buffer bound with
+         * @ref PbrGL::bindProjectionBuffer(),
+         * @ref PbrGL::bindTransformationBuffer(),
+         * @ref PbrGL::bindDrawBuffer() and
+         * @ref PbrGL::bindTextureTransformationBuffer(). Default value is
+         * @cpp 1 @ce.
+         * @see @ref PbrGL::drawCount()
+         */
+        Configuration& setDrawCount(UnsignedInt count) {
+            _drawCount = count;
+            return *this;
+        }
+
+    private:
+        Flags _flags;
+        UnsignedInt _lightCount = 1;
+        UnsignedInt _materialCount = 1;
+        UnsignedInt _drawCount = 1;
+};
+
+/**
+@brief Asynchronous compilation state
+
+Returned by @ref compile(). See @ref shaders-async for more information.
+*/
+class PbrGL::CompileState: public PbrGL {
+    /* Everything deliberately private except for the inheritance */
+    friend class PbrGL;
+
+    explicit CompileState(NoCreateT): PbrGL{NoCreate}, _vert{NoCreate}, _frag{NoCreate} {}
+
+    explicit CompileState(PbrGL&& shader, GL::Shader&& vert, GL::Shader&& frag, GL::Version version, bool cached): PbrGL{std::move(shader)}, _vert{std::move(vert)}, _frag{std::move(frag)}, _version{version}, _cached{cached} {}
+
+    GL::Shader _vert, _frag;
+    GL::Version _version;
+    bool _cached;
+};
+
+/**
+@brief Generate a BRDF lookup texture for image-based lighting
+@m_since_latest
+
+Integrates the GGX specular BRDF over the hemisphere for the split-sum
+approximation, with the X axis being the dot product of the normal and view
+direction and the Y axis being the roughness, both in range @f$ [0, 1] @f$.
+The red and green channel contain the scale and bias applied to the Fresnel
+reflectance at normal incidence. The result is a
+@ref GL::TextureFormat::RG16F texture with linear filtering and
+clamp-to-edge wrapping. It doesn't depend on the environment and thus needs
+to be generated only once. Expects that @p size is non-zero.
+
+The function leaves an internal framebuffer bound, rebind the framebuffer you
+render to afterwards.
+@see @ref PbrGL::bindBrdfLookupTexture(), @ref Shaders-PbrGL-ibl
+@requires_gl30 Extension @gl_extension{ARB,texture_float}
+@requires_gles30 Extension @gl_extension{EXT,color_buffer_float} for
+    rendering to floating-point textures.
+@requires_webgl20 Extension @webgl_extension{EXT,color_buffer_float} for
+    rendering to floating-point textures.
+*/
+MAGNUM_SHADERS_EXPORT GL::Texture2D pbrBrdfLookupTexture(const Vector2i& size = {128, 128});
+
+/**
+@brief Generate a prefiltered environment texture for image-based lighting
+@m_since_latest
+@param environment  Source environment cube map
+@param size         Size of the output cube map faces
+@param levelCount   Count of mip levels in the output
+
+Convolves @p environment with the GGX distribution using importance
+sampling, each of the @p levelCount output levels corresponding to a
+roughness linearly increasing from @cpp 0.0f @ce for the first level to
+@cpp 1.0f @ce for the last. The result is a @ref GL::TextureFormat::RGBA16F
+cube map with trilinear filtering. For faster and less noisy convolution,
+@p environment is expected to have a complete mip chain, as the samples are
+taken from a level matching the sample footprint.
+
+Expects that @p size is non-zero and @p levelCount is at least @cpp 1 @ce
+and not larger than the mip chain length for @p size. The same level count
+should be then set in @ref PbrImageBasedLightingUniform::levelCount. The
+function leaves an internal framebuffer bound, rebind the framebuffer you
+render to afterwards.
+@see @ref PbrGL::bindEnvironmentTexture(), @ref Shaders-PbrGL-ibl
+@requires_gl30 Extension @gl_extension{ARB,texture_float}
+@requires_gles30 Extension @gl_extension{EXT,color_buffer_float} for
+    rendering to floating-point textures.
+@requires_webgl20 Extension @webgl_extension{EXT,color_buffer_float} for
+    rendering to floating-point textures.
+*/
+MAGNUM_SHADERS_EXPORT GL::CubeMapTexture pbrPrefilteredEnvironmentTexture(GL::CubeMapTexture& environment, Int size, Int levelCount);
+
+/** @debugoperatorclassenum{PbrGL,PbrGL::Flag} */
+MAGNUM_SHADERS_EXPORT Debug& operator<<(Debug& debug, PbrGL::Flag value);
+
+/** @debugoperatorclassenum{PbrGL,PbrGL::Flags} */
+MAGNUM_SHADERS_EXPORT Debug& operator<<(Debug& debug, PbrGL::Flags value);
+
+CORRADE_ENUMSET_OPERATORS(PbrGL::Flags)
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 and WebGL 1.0 build
+#endif
+
+#endif
@@ -0,0 +1,125 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#define PI 3.14159265359
+#define SAMPLE_COUNT 256u
+
+/* Common to PbrBrdfLookup.frag */
+
+/* Van der Corput radical inverse, done with a bit reversal. GLSL 1.30 / ES 3.0
+   doesn't have bitfieldReverse(). */
+highp float radicalInverse(highp uint bits) {
+    bits = (bits << 16u)|(bits >> 16u);
+    bits = ((bits & 0x55555555u) << 1u)|((bits & 0xAAAAAAAAu) >> 1u);
+    bits = ((bits & 0x33333333u) << 2u)|((bits & 0xCCCCCCCCu) >> 2u);
+    bits = ((bits & 0x0F0F0F0Fu) << 4u)|((bits & 0xF0F0F0F0u) >> 4u);
+    bits = ((bits & 0x00FF00FFu) << 8u)|((bits & 0xFF00FF00u) >> 8u);
+    return float(bits)*2.3283064365386963e-10; /* 1/2^32 */
+}
+
+/* GGX importance sampling of a half vector around the +Z axis */
+highp vec3 importanceSampleGgx(highp uint i, highp float alpha2) {
+    highp const float phi = 2.0*PI*(float(i) + 0.5)/float(SAMPLE_COUNT);
+    highp const float xi = radicalInverse(i);
+    highp const float cosTheta = sqrt((1.0 - xi)/(1.0 + (alpha2 - 1.0)*xi));
+    highp const float sinTheta = sqrt(1.0 - cosTheta*cosTheta);
+    return vec3(sinTheta*cos(phi), sinTheta*sin(phi), cosTheta);
+}
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 0)
+#endif
+uniform mediump int face; /* defaults to zero */
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 1)
+#endif
+uniform mediump float roughness; /* defaults to zero */
+
+#ifdef EXPLICIT_BINDING
+layout(binding = 0)
+#endif
+uniform mediump samplerCube environmentTexture;
+
+in highp vec2 interpolatedPosition;
+
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = COLOR_OUTPUT_ATTRIBUTE_LOCATION)
+#endif
+out mediump vec4 fragmentColor;
+
+void main() {
+    /* Direction corresponding to the fragment on given cube map face, with the
+       orientation as defined by the GL spec */
+    highp const vec2 p = interpolatedPosition;
+    highp vec3 n;
+    if(face == 0)      n = vec3( 1.0,  -p.y,  -p.x);
+    else if(face == 1) n = vec3(-1.0,  -p.y,   p.x);
+    else if(face == 2) n = vec3( p.x,   1.0,   p.y);
+    else if(face == 3) n = vec3( p.x,  -1.0,  -p.y);
+    else if(face == 4) n = vec3( p.x,  -p.y,   1.0);
+    else               n = vec3(-p.x,  -p.y,  -1.0);
+    n = normalize(n);
+
+    /* The first level is a copy of the environment */
+    if(roughness == 0.0) {
+        fragmentColor = vec4(textureLod(environmentTexture, n, 0.0).rgb, 1.0);
+        return;
+    }
+
+    /* Tangent frame around the normal, assuming the view and normal
+       directions being the same */
+    highp const vec3 up = abs(n.z) < 0.999 ? vec3(0.0, 0.0, 1.0) : vec3(1.0, 0.0, 0.0);
+    highp const vec3 tangent = normalize(cross(up, n));
+    highp const vec3 bitangent = cross(n, tangent);
+
+    highp const float alpha2 = roughness*roughness*roughness*roughness;
+    /* Solid angle of a single texel of the source level zero */
+    highp const float texelSolidAngle = 4.0*PI/(6.0*float(textureSize(environmentTexture, 0).x*textureSize(environmentTexture, 0).x));
+
+    highp vec3 result = vec3(0.0);
+    highp float weight = 0.0;
+    for(highp uint i = 0u; i != SAMPLE_COUNT; ++i) {
+        highp const vec3 hTangent = importanceSampleGgx(i, alpha2);
+        highp const vec3 h = tangent*hTangent.x + bitangent*hTangent.y + n*hTangent.z;
+        highp const vec3 l = 2.0*dot(n, h)*h - n;
+        highp const float nDotL = dot(n, l);
+        if(nDotL <= 0.0) continue;
+
+        /* Sample from a level matching the footprint of the sample to avoid
+           aliasing with a low sample count, "filtered importance sampling"
+           from GPU Gems 3, chapter 20 */
+        highp const float nDotH = hTangent.z;
+        highp const float d = nDotH*nDotH*(alpha2 - 1.0) + 1.0;
+        highp const float pdf = alpha2/(PI*d*d)*0.25;
+        highp const float sampleSolidAngle = 1.0/(float(SAMPLE_COUNT)*pdf + 0.0001);
+        highp const float level = max(0.5*log2(sampleSolidAngle/texelSolidAngle) + 1.0, 0.0);
+
+        result += textureLod(environmentTexture, l, level).rgb*nDotL;
+        weight += nDotL;
+    }
+
+    fragmentColor = vec4(result/weight, 1.0);
+}
@@ -27,6 +27,10 @@
 #extension GL_EXT_gpu_shader4: require
 #endif
 
+#ifdef BINDLESS_TEXTURES
+#extension GL_ARB_bindless_texture: require
+#endif
+
 #ifndef NEW_GLSL
 #define in varying
 #define fragmentColor gl_FragColor
@@ -183,11 +187,11 @@ uniform highp uint drawOffset
 struct DrawUniform {
     /* Can't be a mat3 because of ANGLE, see Phong.vert for details */
     mediump mat3x4 normalMatrix;
-    highp uvec4 materialIdReservedObjectIdLightOffsetLightCount;
-    #define draw_materialIdReserved materialIdReservedObjectIdLightOffsetLightCount.x
-    #define draw_objectId materialIdReservedObjectIdLightOffsetLightCount.y
-    #define draw_lightOffset materialIdReservedObjectIdLightOffsetLightCount.z
-    #define draw_lightCount materialIdReservedObjectIdLightOffsetLightCount.w
+    highp uvec4 materialIdJointOffsetObjectIdLightOffsetLightCount;
+    #define draw_materialIdJointOffset materialIdJointOffsetObjectIdLightOffsetLightCount.x
+    #define draw_objectId materialIdJointOffsetObjectIdLightOffsetLightCount.y
+    #define draw_lightOffset materialIdJointOffsetObjectIdLightOffsetLightCount.z
+    #define draw_lightCount materialIdJointOffsetObjectIdLightOffsetLightCount.w
 };
 
 layout(std140
@@ -227,6 +231,7 @@ struct LightUniform {
     #define light_range rangeReservedReservedReserved.x
 };
 
+#ifndef LIGHT_CLUSTERS
 layout(std140
     #ifdef EXPLICIT_BINDING
     , binding = 5
@@ -234,11 +239,96 @@ layout(std140
 ) uniform Light {
     LightUniform lights[LIGHT_COUNT];
 };
+#else
+/* With light clusters there's usually way more lights than what fits into a
+   uniform buffer, so they're supplied in a shader storage buffer instead.
+   Explicit bindings are always available as light clusters require GL 4.3 /
+   ES 3.1, and ES doesn't have any other way to specify bindings of shader
+   storage blocks. Keep in sync with LightCluster.comp. */
+layout(std430, binding = 5) readonly buffer Light {
+    LightUniform lights[LIGHT_COUNT];
+};
+
+layout(std140, binding = 7) uniform LightCluster {
+    highp mat4 inverseProjectionMatrix; /* unused here */
+    highp uvec4 clusterCountLightCount;
+    #define lightCluster_clusterCount clusterCountLightCount.xyz
+    highp vec4 viewportSizeNearFar;
+    #define lightCluster_viewportSize viewportSizeNearFar.xy
+    #define lightCluster_near viewportSizeNearFar.z
+    #define lightCluster_far viewportSizeNearFar.w
+};
+
+layout(std430, binding = 6) readonly buffer ClusterLightRange {
+    highp uvec2 clusterLightRanges[];
+};
+
+layout(std430, binding = 7) readonly buffer ClusterLightIndex {
+    highp uint clusterLightIndices[];
+};
+#endif
+#endif
+
+#ifdef BINDLESS_TEXTURES
+/* Indexed with the same material ID as the Material block above, the handles
+   are 64-bit, stored as low and high 32-bit halves */
+struct MaterialTextureUniform {
+    highp uvec4 ambientDiffuseTextureHandles;
+    #define materialTexture_ambientTextureHandle ambientDiffuseTextureHandles.xy
+    #define materialTexture_diffuseTextureHandle ambientDiffuseTextureHandles.zw
+    highp uvec4 specularNormalTextureHandles;
+    #define materialTexture_specularTextureHandle specularNormalTextureHandles.xy
+    #define materialTexture_normalTextureHandle specularNormalTextureHandles.zw
+    highp uvec4 objectIdTextureHandleReservedReserved;
+    #define materialTexture_objectIdTextureHandle objectIdTextureHandleReservedReserved.xy
+};
+
+layout(std140
+    #ifdef EXPLICIT_BINDING
+    , binding = 6
+    #endif
+) uniform MaterialTexture {
+    MaterialTextureUniform materialTextures[MATERIAL_COUNT];
+};
+#endif
+
+#ifdef SHADOW_MAPS
+/* Keep in sync with ShadowCascadeUniform */
+layout(std140
+    #ifdef EXPLICIT_BINDING
+    , binding = 9
+    #endif
+) uniform Shadow {
+    highp mat4 shadowCascadeMatrices[4];
+    highp vec4 shadowCascadeSplits;
+    /* Mixed integer and float fields, so can't be packed into a vec4 */
+    highp uint shadow_lightIndex;
+    highp uint shadow_cascadeCount;
+    highp float shadow_bias;
+    highp float shadow_filterRadius;
+};
 #endif
 #endif
 
 /* Textures */
 
+#ifdef BINDLESS_TEXTURES
+/* Samplers get constructed from the handles in the MaterialTexture block, the
+   materialId is defined at the start of main() */
+#ifndef TEXTURE_ARRAYS
+#define ambientTexture sampler2D(materialTextures[materialId].materialTexture_ambientTextureHandle)
+#define diffuseTexture sampler2D(materialTextures[materialId].materialTexture_diffuseTextureHandle)
+#define specularTexture sampler2D(materialTextures[materialId].materialTexture_specularTextureHandle)
+#define normalTexture sampler2D(materialTextures[materialId].materialTexture_normalTextureHandle)
+#define objectIdTextureData usampler2D(materialTextures[materialId].materialTexture_objectIdTextureHandle)
+#else
+#define ambientTexture sampler2DArray(materialTextures[materialId].materialTexture_ambientTextureHandle)
+#define diffuseTexture sampler2DArray(materialTextures[materialId].materialTexture_diffuseTextureHandle)
+#define specularTexture sampler2DArray(materialTextures[materialId].materialTexture_specularTextureHandle)
+#define normalTexture sampler2DArray(materialTextures[materialId].materialTexture_normalTextureHandle)
+#define objectIdTextureData usampler2DArray(materialTextures[materialId].materialTexture_objectIdTextureHandle)
+#endif
+#else
 #ifdef AMBIENT_TEXTURE
 #ifdef EXPLICIT_BINDING
 layout(binding = 0)
@@ -305,10 +395,18 @@ uniform lowp
     #endif
     objectIdTextureData;
 #endif
+#endif
+
+#ifdef SHADOW_MAPS
+#ifdef EXPLICIT_BINDING
+layout(binding = 6)
+#endif
+uniform highp sampler2DArrayShadow shadowTexture;
+#endif
 
 /* Inputs */
 
-#if LIGHT_COUNT
+#if LIGHT_COUNT && !defined(DEPTH_ONLY)
 in mediump vec3 transformedNormal;
 #ifdef NORMAL_TEXTURE
 #ifndef BITANGENT
@@ -345,11 +443,25 @@ flat in highp uint drawId;
 
 /* Outputs */
 
-#ifdef NEW_GLSL
+#if defined(NEW_GLSL) && !defined(DEPTH_ONLY)
 #ifdef EXPLICIT_ATTRIB_LOCATION
 layout(location = COLOR_OUTPUT_ATTRIBUTE_LOCATION)
 #endif
-out lowp vec4 fragmentColor;
+/* The weighted color for order-independent transparency goes way over the
+   lowp range */
+out
+    #ifndef ORDER_INDEPENDENT_TRANSPARENCY
+    lowp
+    #else
+    highp
+    #endif
+    vec4 fragmentColor;
+#endif
+#ifdef ORDER_INDEPENDENT_TRANSPARENCY
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = REVEALAGE_OUTPUT_ATTRIBUTE_LOCATION)
+#endif
+out lowp float fragmentRevealage;
 #endif
 #ifdef OBJECT_ID
 #ifdef EXPLICIT_ATTRIB_LOCATION
@@ -365,7 +477,7 @@ void main() {
     highp const uint objectId = draws[drawId].draw_objectId;
     #endif
     #if MATERIAL_COUNT > 1
-    mediump const uint materialId = draws[drawId].draw_materialIdReserved & 0xffffu;
+    mediump const uint materialId = draws[drawId].draw_materialIdJointOffset & 0xffffu;
     #else
     #define materialId 0u
     #endif
@@ -386,6 +498,32 @@ void main() {
     #endif
     #endif
 
+    #ifdef DEPTH_ONLY
+    /* No lighting and no outputs, only the same alpha as below minus the
+       light-dependent specular contribution */
+    #ifdef ALPHA_MASK
+    lowp const float alpha =
+        #ifdef AMBIENT_TEXTURE
+        texture(ambientTexture, interpolatedTextureCoordinates).a*
+        #endif
+        #ifdef VERTEX_COLOR
+        interpolatedVertexColor.a*
+        #endif
+        ambientColor.a
+        #if LIGHT_COUNT
+        +
+        #ifdef DIFFUSE_TEXTURE
+        texture(diffuseTexture, interpolatedTextureCoordinates).a*
+        #endif
+        #ifdef VERTEX_COLOR
+        interpolatedVertexColor.a*
+        #endif
+        diffuseColor.a
+        #endif
+        ;
+    if(alpha <= alphaMask) discard;
+    #endif
+    #else
     lowp const vec4 finalAmbientColor =
         #ifdef AMBIENT_TEXTURE
         texture(ambientTexture, interpolatedTextureCoordinates)*
@@ -440,13 +578,52 @@ void main() {
 
     highp const vec3 cameraDirection = normalize(-transformedPosition);
 
+    #ifdef LIGHT_CLUSTERS
+    /* Find the cluster this fragment belongs to. Uniform subdivision in
+       screen space, exponential along the view depth, matching the
+       subdivision done in LightCluster.comp. */
+    highp const uvec3 clusterCount = lightCluster_clusterCount;
+    highp const uvec3 cluster = min(uvec3(
+        uvec2(gl_FragCoord.xy*vec2(clusterCount.xy)/lightCluster_viewportSize),
+        uint(max(log(-transformedPosition.z/lightCluster_near)/log(lightCluster_far/lightCluster_near)*float(clusterCount.z), 0.0))),
+        clusterCount - uvec3(1u));
+    highp const uvec2 clusterLightRange = clusterLightRanges[cluster.x + clusterCount.x*(cluster.y + clusterCount.y*cluster.z)];
+    #endif
+
+    #ifdef SHADOW_MAPS
+    /* Pick the first cascade that contains the fragment. Fragments beyond the
+       last cascade aren't shadowed. */
+    lowp float shadowFactor = 1.0;
+    highp uint cascade = 0u;
+    while(cascade < shadow_cascadeCount && -transformedPosition.z > shadowCascadeSplits[cascade])
+        ++cascade;
+    if(cascade < shadow_cascadeCount) {
+        highp const vec4 shadowPosition = shadowCascadeMatrices[cascade]*vec4(transformedPosition, 1.0);
+        highp const vec3 shadowCoordinates = shadowPosition.xyz/shadowPosition.w*0.5 + vec3(0.5);
+        highp const vec2 shadowTexelSize = shadow_filterRadius/vec2(textureSize(shadowTexture, 0).xy);
+
+        /* 3x3 percentage-closer filtering, each lookup is additionally
+           bilinearly filtered if the texture has linear filtering enabled */
+        shadowFactor = 0.0;
+        for(int y = -1; y <= 1; ++y) for(int x = -1; x <= 1; ++x)
+            shadowFactor += texture(shadowTexture, vec4(shadowCoordinates.xy + vec2(float(x), float(y))*shadowTexelSize, float(cascade), shadowCoordinates.z - shadow_bias));
+        shadowFactor /= 9.0;
+    }
+    #endif
+
     /* Add diffuse color for each light */
-    #ifndef LIGHT_CULLING
+    #ifdef LIGHT_CLUSTERS
+    for(highp uint clusterLight = 0u; clusterLight < clusterLightRange.y; ++clusterLight)
+    #elif !defined(LIGHT_CULLING)
     for(int i = 0; i < LIGHT_COUNT; ++i)
     #else
     for(uint i = 0u, actualLightCount = min(uint(LIGHT_COUNT), draws[drawId].draw_lightCount); i < actualLightCount; ++i)
     #endif
     {
+        #ifdef LIGHT_CLUSTERS
+        highp const uint i = clusterLightIndices[clusterLightRange.x + clusterLight];
+        #endif
+
         lowp const vec3 lightColor =
             #ifndef UNIFORM_BUFFERS
             lightColors[i]
@@ -507,6 +684,15 @@ void main() {
         highp float attenuation = clamp(1.0 - pow(dist/max(lightRange, 0.0001), 4.0), 0.0, 1.0);
         attenuation = attenuation*attenuation/(1.0 + dist*dist);
 
+        #ifdef SHADOW_MAPS
+        if(uint(
+            #ifdef LIGHT_CULLING
+            lightOffset +
+            #endif
+            i) == shadow_lightIndex)
+            attenuation *= shadowFactor;
+        #endif
+
         highp vec3 normalizedLightDirection = lightDirection.xyz/len;
         lowp float intensity = max(0.0, dot(normalizedTransformedNormal, normalizedLightDirection))*attenuation;
         fragmentColor.rgb += finalDiffuseColor.rgb*lightColor*intensity;
@@ -542,4 +728,16 @@ void main() {
         #endif
         objectId;
     #endif
+
+    #ifdef ORDER_INDEPENDENT_TRANSPARENCY
+    /* Weighted blended order-independent transparency, weight function from
+       equation (10) in http://jcgt.org/published/0002/02/09/. The alpha can
+       be larger than 1 as the ambient, diffuse and specular alphas get added
+       together, so clamp it first. */
+    lowp const float alpha = min(fragmentColor.a, 1.0);
+    highp const float weight = clamp(pow(min(1.0, alpha*10.0) + 0.01, 3.0)*1.0e8*pow(1.0 - gl_FragCoord.z*0.9, 3.0), 1.0e-2, 3.0e3);
+    fragmentColor = vec4(fragmentColor.rgb*alpha, alpha)*weight;
+    fragmentRevealage = alpha;
+    #endif
+    #endif
 }
@@ -26,7 +26,7 @@
 */
 
 /** @file
- * @brief Struct @ref Magnum::Shaders::PhongDrawUniform, @ref Magnum::Shaders::PhongMaterialUniform, @ref Magnum::Shaders::PhongLightUniform
+ * @brief Struct @ref Magnum::Shaders::PhongDrawUniform, @ref Magnum::Shaders::PhongMaterialUniform, @ref Magnum::Shaders::PhongMaterialTextureUniform, @ref Magnum::Shaders::PhongLightUniform
  */
 
 #include "Magnum/Magnum.h"
@@ -56,12 +56,12 @@ separate @ref PhongMaterialUniform structure, referenced by @ref materialId.
 struct PhongDrawUniform {
     /** @brief Construct with default parameters */
     constexpr explicit PhongDrawUniform(DefaultInitT = DefaultInit) noexcept: normalMatrix{Math::IdentityInit},
-        #if ((defined(CORRADE_TARGET_CLANG) && __clang_major__ < 4) || (defined(CORRADE_TARGET_APPLE_CLANG) && __clang_major__ < 8)) && defined(CORRADE_TARGET_BIG_ENDIAN)
-        _pad0{}, /* Otherwise it refuses to constexpr, on 3.8 at least */
+        #ifdef CORRADE_TARGET_BIG_ENDIAN
+        jointOffset{0},
         #endif
         materialId{0},
-        #if (defined(CORRADE_TARGET_CLANG) && __clang_major__ < 4) || (defined(CORRADE_TARGET_APPLE_CLANG) && __clang_major__ < 8) && !defined(CORRADE_TARGET_BIG_ENDIAN)
-        _pad0{},
+        #ifndef CORRADE_TARGET_BIG_ENDIAN
+        jointOffset{0},
         #endif
         objectId{0}, lightOffset{0}, lightCount{0xffffffffu} {}
 
@@ -107,6 +107,16 @@ struct PhongDrawUniform {
         return *this;
     }
 
+    /**
+     * @brief Set the @ref jointOffset field
+     * @return Reference to self (for method chaining)
+     * @m_since_latest
+     */
+    PhongDrawUniform& setJointOffset(UnsignedInt offset) {
+        jointOffset = offset;
+        return *this;
+    }
+
     /**
      * @brief Set the @ref lightOffset and @ref lightCount fields
      * @return Reference to self (for method chaining)
@@ -146,25 +156,29 @@ struct PhongDrawUniform {
      * @cpp 0 @ce, meaning the first material gets used.
      */
 
+    /** @var jointOffset
+     * @brief Joint offset
+     * @m_since_latest
+     *
+     * Offset added to joint IDs in the @ref PhongGL::JointIds and
+     * @ref PhongGL::SecondaryJointIds attributes. Useful when a UBO with joint
+     * matrices for more than one skin is supplied or in a multi-draw
+     * scenario. Should be less than the joint count passed to
+     * @ref PhongGL::Configuration::setJointCount(). Default value is
+     * @cpp 0 @ce, meaning no offset is added to joint IDs.
+     *
+     * Used only if the shader was created with a non-zero joint count,
+     * ignored otherwise.
+     */
+
     /* This field is an UnsignedInt in the shader and materialId is extracted
-       as (value & 0xffff), so the order has to be different on BE */
+       as (value & 0xffff) and jointOffset as (value >> 16), so the order has
+       to be different on BE */
     #ifndef CORRADE_TARGET_BIG_ENDIAN
     UnsignedShort materialId;
-    /* warning: Member __pad0__ is not documented. FFS DOXYGEN WHY DO YOU THINK
-       I MADE THOSE UNNAMED, YOU DUMB FOOL */
-    #ifndef DOXYGEN_GENERATING_OUTPUT
-    UnsignedShort
-        #if (defined(CORRADE_TARGET_CLANG) && __clang_major__ < 4) || (defined(CORRADE_TARGET_APPLE_CLANG) && __clang_major__ < 8)
-        _pad0 /* Otherwise it refuses to constexpr, on 3.8 at least */
-        #endif
-        :16; /* reserved for skinOffset */
-    #endif
+    UnsignedShort jointOffset;
     #else
-    UnsignedShort
-        #if (defined(CORRADE_TARGET_CLANG) && __clang_major__ < 4) || (defined(CORRADE_TARGET_APPLE_CLANG) && __clang_major__ < 8)
-        _pad0 /* Otherwise it refuses to constexpr, on 3.8 at least */
-        #endif
-        :16; /* reserved for skinOffset */
+    UnsignedShort jointOffset;
     UnsignedShort materialId;
     #endif
 
@@ -382,6 +396,147 @@ struct PhongMaterialUniform {
     #endif
 };
 
+/**
+@brief Material texture uniform for Phong shaders
+@m_since_latest
+
+Bindless texture handles of a material referenced from
+@ref PhongDrawUniform::materialId, used if
+@ref PhongGL::Flag::BindlessTextures is enabled. The handles are stored as two
+32-bit halves to keep the structure compatible with the std140 layout of an
+@glsl uvec2 @ce, use the setters to fill them from a 64-bit value.
+@see @ref PhongGL::bindMaterialTextureBuffer(),
+    @ref GL::Texture::handle() "GL::Texture*::handle()"
+*/
+struct PhongMaterialTextureUniform {
+    /** @brief Construct with default parameters */
+    constexpr explicit PhongMaterialTextureUniform(DefaultInitT = DefaultInit) noexcept: ambientTextureHandle{}, diffuseTextureHandle{}, specularTextureHandle{}, normalTextureHandle{}, objectIdTextureHandle{}
+        #if (defined(CORRADE_TARGET_CLANG) && __clang_major__ < 4) || (defined(CORRADE_TARGET_APPLE_CLANG) && __clang_major__ < 8)
+        , _pad0{}, _pad1{} /* Otherwise it refuses to constexpr, on 3.8 at least */
+        #endif
+        {}
+
+    /** @brief Construct without initializing the contents */
+    explicit PhongMaterialTextureUniform(NoInitT) noexcept: ambientTextureHandle{NoInit}, diffuseTextureHandle{NoInit}, specularTextureHandle{NoInit}, normalTextureHandle{NoInit}, objectIdTextureHandle{NoInit} {}
+
+    /** @{
+     * @name Convenience setters
+     *
+     * Provided to allow the use of method chaining for populating a structure
+     * in a single expression, otherwise equivalent to accessing the fields
+     * directly. Also guaranteed to provide backwards compatibility when
+     * packing of the actual fields changes.
+     */
+
+    /**
+     * @brief Set the @ref ambientTextureHandle field
+     * @return Reference to self (for method chaining)
+     */
+    PhongMaterialTextureUniform& setAmbientTextureHandle(UnsignedLong handle) {
+        ambientTextureHandle = {UnsignedInt(handle), UnsignedInt(handle >> 32)};
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref diffuseTextureHandle field
+     * @return Reference to self (for method chaining)
+     */
+    PhongMaterialTextureUniform& setDiffuseTextureHandle(UnsignedLong handle) {
+        diffuseTextureHandle = {UnsignedInt(handle), UnsignedInt(handle >> 32)};
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref specularTextureHandle field
+     * @return Reference to self (for method chaining)
+     */
+    PhongMaterialTextureUniform& setSpecularTextureHandle(UnsignedLong handle) {
+        specularTextureHandle = {UnsignedInt(handle), UnsignedInt(handle >> 32)};
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref normalTextureHandle field
+     * @return Reference to self (for method chaining)
+     */
+    PhongMaterialTextureUniform& setNormalTextureHandle(UnsignedLong handle) {
+        normalTextureHandle = {UnsignedInt(handle), UnsignedInt(handle >> 32)};
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref objectIdTextureHandle field
+     * @return Reference to self (for method chaining)
+     */
+    PhongMaterialTextureUniform& setObjectIdTextureHandle(UnsignedLong handle) {
+        objectIdTextureHandle = {UnsignedInt(handle), UnsignedInt(handle >> 32)};
+        return *this;
+    }
+
+    /**
+     * @}
+     */
+
+    /**
+     * @brief Ambient texture handle
+     *
+     * Low and high 32 bits of a resident texture handle. Default value is
+     * @cpp {0, 0} @ce. Used only if @ref PhongGL::Flag::AmbientTexture is
+     * enabled, ignored otherwise. If @ref PhongGL::Flag::TextureArrays is
+     * enabled, the handle is expected to be of a @ref GL::Texture2DArray,
+     * otherwise of a @ref GL::Texture2D. The same applies to all other
+     * handles.
+     */
+    Vector2ui ambientTextureHandle;
+
+    /**
+     * @brief Diffuse texture handle
+     *
+     * Default value is @cpp {0, 0} @ce. Used only if
+     * @ref PhongGL::Flag::DiffuseTexture is enabled, ignored otherwise.
+     */
+    Vector2ui diffuseTextureHandle;
+
+    /**
+     * @brief Specular texture handle
+     *
+     * Default value is @cpp {0, 0} @ce. Used only if
+     * @ref PhongGL::Flag::SpecularTexture is enabled, ignored otherwise.
+     */
+    Vector2ui specularTextureHandle;
+
+    /**
+     * @brief Normal texture handle
+     *
+     * Default value is @cpp {0, 0} @ce. Used only if
+     * @ref PhongGL::Flag::NormalTexture is enabled, ignored otherwise.
+     */
+    Vector2ui normalTextureHandle;
+
+    /**
+     * @brief Object ID texture handle
+     *
+     * Default value is @cpp {0, 0} @ce. Used only if
+     * @ref PhongGL::Flag::ObjectIdTexture is enabled, ignored otherwise.
+     */
+    Vector2ui objectIdTextureHandle;
+
+    /* warning: Member __pad0__ is not documented. FFS DOXYGEN WHY DO YOU THINK
+       I MADE THOSE UNNAMED, YOU DUMB FOOL */
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    Int
+        #if (defined(CORRADE_TARGET_CLANG) && __clang_major__ < 4) || (defined(CORRADE_TARGET_APPLE_CLANG) && __clang_major__ < 8)
+        _pad0 /* Otherwise it refuses to constexpr, on 3.8 at least */
+        #endif
+        :32;
+    Int
+        #if (defined(CORRADE_TARGET_CLANG) && __clang_major__ < 4) || (defined(CORRADE_TARGET_APPLE_CLANG) && __clang_major__ < 8)
+        _pad1 /* Otherwise it refuses to constexpr, on 3.8 at least */
+        #endif
+        :32;
+    #endif
+};
+
 /**
 @brief Light parameters for Phong shaders
 @m_since_latest
@@ -23,7 +23,7 @@
     DEALINGS IN THE SOFTWARE.
 */
 
-#if defined(INSTANCED_OBJECT_ID) && !defined(GL_ES) && !defined(NEW_GLSL)
+#if (defined(INSTANCED_OBJECT_ID) || defined(JOINT_COUNT)) && !defined(GL_ES) && !defined(NEW_GLSL)
 #extension GL_EXT_gpu_shader4: require
 #endif
 
@@ -99,6 +99,15 @@ layout(location = 4)
 uniform highp uint textureLayer; /* defaults to zero */
 #endif
 
+#ifdef JOINT_COUNT
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = JOINT_MATRICES_LOCATION)
+#endif
+/* Defaults set from the constructor, a mat4[] initializer for an arbitrary
+   count would be needlessly long */
+uniform highp mat4 jointMatrices[JOINT_COUNT];
+#endif
+
 /* Uniform buffers */
 
 #else
@@ -132,11 +141,11 @@ struct DrawUniform {
        2. Forget to actually implement and test the damn thing.
     */
     mediump mat3x4 normalMatrix;
-    highp uvec4 materialIdReservedObjectIdLightOffsetLightCount;
-    #define draw_materialIdReserved materialIdReservedObjectIdLightOffsetLightCount.x
-    #define draw_objectId materialIdReservedObjectIdLightOffsetLightCount.y
-    #define draw_lightOffset materialIdReservedObjectIdLightOffsetLightCount.z
-    #define draw_lightCount materialIdReservedObjectIdLightOffsetLightCount.w
+    highp uvec4 materialIdJointOffsetObjectIdLightOffsetLightCount;
+    #define draw_materialIdJointOffset materialIdJointOffsetObjectIdLightOffsetLightCount.x
+    #define draw_objectId materialIdJointOffsetObjectIdLightOffsetLightCount.y
+    #define draw_lightOffset materialIdJointOffsetObjectIdLightOffsetLightCount.z
+    #define draw_lightCount materialIdJointOffsetObjectIdLightOffsetLightCount.w
 };
 
 layout(std140
@@ -179,20 +188,91 @@ layout(std140
     TextureTransformationUniform textureTransformations[DRAW_COUNT];
 };
 #endif
+
+#ifdef JOINT_COUNT
+layout(std140
+    #ifdef EXPLICIT_BINDING
+    , binding = 8
+    #endif
+) uniform Joint {
+    highp mat4 jointMatrices[JOINT_COUNT];
+};
+#endif
+
+#ifdef VERTEX_PULLING
+/* Keep in sync with Flat.vert. Offsets are in vertices, not bytes. */
+struct VertexPullingUniform {
+    highp uvec4 positionNormalTextureCoordinatesColorOffset;
+    #define vertexPulling_positionOffset positionNormalTextureCoordinatesColorOffset.x
+    #define vertexPulling_normalOffset positionNormalTextureCoordinatesColorOffset.y
+    #define vertexPulling_textureCoordinatesOffset positionNormalTextureCoordinatesColorOffset.z
+    #define vertexPulling_colorOffset positionNormalTextureCoordinatesColorOffset.w
+};
+
+layout(std140
+    #ifdef EXPLICIT_BINDING
+    , binding = 10
+    #endif
+) uniform VertexPulling {
+    VertexPullingUniform vertexPullings[DRAW_COUNT];
+};
+
+/* Tightly packed floats, as a vec3 / vec2 array would be padded to sixteen
+   bytes even with std430. Storage buffers need GL 4.3 / ES 3.1 so explicit
+   bindings are always available. */
+layout(std430, binding = 0) readonly buffer PositionStorage {
+    highp float positionStorage[];
+};
+
+#ifdef TEXTURED
+layout(std430, binding = 1) readonly buffer TextureCoordinatesStorage {
+    mediump float textureCoordinatesStorage[];
+};
+#endif
+
+#ifdef VERTEX_COLOR
+layout(std430, binding = 2) readonly buffer ColorStorage {
+    lowp float colorStorage[];
+};
+#endif
+
+#ifdef HAS_LIGHTS
+layout(std430, binding = 3) readonly buffer NormalStorage {
+    mediump float normalStorage[];
+};
+#endif
+#endif
+#endif
+
+#ifdef DYNAMIC_PER_VERTEX_JOINT_COUNT
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = PER_VERTEX_JOINT_COUNT_LOCATION)
+#endif
+uniform mediump uvec2 perVertexJointCount
+    #ifndef GL_ES
+    = uvec2(PER_VERTEX_JOINT_COUNT, SECONDARY_PER_VERTEX_JOINT_COUNT)
+    #endif
+    ;
 #endif
 
 /* Inputs */
 
+/* With vertex pulling, position, normal, texture coordinates and vertex color
+   are fetched from storage buffers at the beginning of main() instead */
+#ifndef VERTEX_PULLING
 #ifdef EXPLICIT_ATTRIB_LOCATION
 layout(location = POSITION_ATTRIBUTE_LOCATION)
 #endif
 in highp vec4 position;
+#endif
 
 #ifdef HAS_LIGHTS
+#ifndef VERTEX_PULLING
 #ifdef EXPLICIT_ATTRIB_LOCATION
 layout(location = NORMAL_ATTRIBUTE_LOCATION)
 #endif
 in mediump vec3 normal;
+#endif
 
 #ifdef NORMAL_TEXTURE
 #ifdef EXPLICIT_ATTRIB_LOCATION
@@ -215,14 +295,40 @@ in mediump vec3 bitangent;
 #endif
 #endif
 
-#ifdef TEXTURED
+#if defined(TEXTURED) && !defined(VERTEX_PULLING)
 #ifdef EXPLICIT_ATTRIB_LOCATION
 layout(location = TEXTURECOORDINATES_ATTRIBUTE_LOCATION)
 #endif
 in mediump vec2 textureCoordinates;
 #endif
 
-#ifdef VERTEX_COLOR
+#ifdef JOINT_COUNT
+#if PER_VERTEX_JOINT_COUNT
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = WEIGHTS_ATTRIBUTE_LOCATION)
+#endif
+in mediump vec4 weights;
+
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = JOINTIDS_ATTRIBUTE_LOCATION)
+#endif
+in mediump uvec4 jointIds;
+#endif
+
+#if SECONDARY_PER_VERTEX_JOINT_COUNT
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = SECONDARY_WEIGHTS_ATTRIBUTE_LOCATION)
+#endif
+in mediump vec4 secondaryWeights;
+
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = SECONDARY_JOINTIDS_ATTRIBUTE_LOCATION)
+#endif
+in mediump uvec4 secondaryJointIds;
+#endif
+#endif
+
+#if defined(VERTEX_COLOR) && !defined(VERTEX_PULLING)
 #ifdef EXPLICIT_ATTRIB_LOCATION
 layout(location = COLOR_ATTRIBUTE_LOCATION)
 #endif
@@ -265,6 +371,10 @@ in mediump
 
 /* Outputs */
 
+/* So a depth prepass done with DEPTH_ONLY produces exactly the same depth as
+   the shading pass */
+invariant gl_Position;
+
 #ifdef TEXTURED
 out mediump
     #ifndef TEXTURE_ARRAYS
@@ -324,6 +434,63 @@ void main() {
     highp const uint textureLayer = floatBitsToUint(textureTransformations[drawId].textureTransformation_layer);
     #endif
     #endif
+
+    #ifdef VERTEX_PULLING
+    /* gl_VertexID already includes the base vertex for indexed draws, the
+       per-draw offsets allow multiple meshes to share the same buffers */
+    highp const uint positionIndex = vertexPullings[drawId].vertexPulling_positionOffset + uint(gl_VertexID);
+    highp const vec4 position = vec4(
+        positionStorage[positionIndex*3u],
+        positionStorage[positionIndex*3u + 1u],
+        positionStorage[positionIndex*3u + 2u], 1.0);
+    #ifdef HAS_LIGHTS
+    highp const uint normalIndex = vertexPullings[drawId].vertexPulling_normalOffset + uint(gl_VertexID);
+    mediump const vec3 normal = vec3(
+        normalStorage[normalIndex*3u],
+        normalStorage[normalIndex*3u + 1u],
+        normalStorage[normalIndex*3u + 2u]);
+    #endif
+    #ifdef TEXTURED
+    highp const uint textureCoordinatesIndex = vertexPullings[drawId].vertexPulling_textureCoordinatesOffset + uint(gl_VertexID);
+    mediump const vec2 textureCoordinates = vec2(
+        textureCoordinatesStorage[textureCoordinatesIndex*2u],
+        textureCoordinatesStorage[textureCoordinatesIndex*2u + 1u]);
+    #endif
+    #ifdef VERTEX_COLOR
+    highp const uint colorIndex = vertexPullings[drawId].vertexPulling_colorOffset + uint(gl_VertexID);
+    lowp const vec4 vertexColor = vec4(
+        colorStorage[colorIndex*4u],
+        colorStorage[colorIndex*4u + 1u],
+        colorStorage[colorIndex*4u + 2u],
+        colorStorage[colorIndex*4u + 3u]);
+    #endif
+    #endif
+    #endif
+
+    #ifdef JOINT_COUNT
+    /* Skin matrix, a weighted sum of joint matrices affecting the vertex */
+    #ifdef UNIFORM_BUFFERS
+    highp const uint jointOffset = draws[drawId].draw_materialIdJointOffset >> 16u;
+    #else
+    #define jointOffset 0u
+    #endif
+    highp mat4 skinMatrix = mat4(0.0);
+    #if PER_VERTEX_JOINT_COUNT
+    for(int i = 0; i != PER_VERTEX_JOINT_COUNT; ++i) {
+        #ifdef DYNAMIC_PER_VERTEX_JOINT_COUNT
+        if(uint(i) >= perVertexJointCount.x) break;
+        #endif
+        skinMatrix += weights[i]*jointMatrices[jointOffset + jointIds[i]];
+    }
+    #endif
+    #if SECONDARY_PER_VERTEX_JOINT_COUNT
+    for(int i = 0; i != SECONDARY_PER_VERTEX_JOINT_COUNT; ++i) {
+        #ifdef DYNAMIC_PER_VERTEX_JOINT_COUNT
+        if(uint(i) >= perVertexJointCount.y) break;
+        #endif
+        skinMatrix += secondaryWeights[i]*jointMatrices[jointOffset + secondaryJointIds[i]];
+    }
+    #endif
     #endif
 
     /* Transformed vertex position */
@@ -331,6 +498,9 @@ void main() {
         #ifdef INSTANCED_TRANSFORMATION
         instancedTransformationMatrix*
         #endif
+        #ifdef JOINT_COUNT
+        skinMatrix*
+        #endif
         position;
     #ifndef HAS_LIGHTS
     highp vec3
@@ -343,6 +513,9 @@ void main() {
         #ifdef INSTANCED_TRANSFORMATION
         instancedNormalMatrix*
         #endif
+        #ifdef JOINT_COUNT
+        mat3(skinMatrix)*
+        #endif
         normal;
     #ifdef NORMAL_TEXTURE
     #ifndef BITANGENT
@@ -350,17 +523,26 @@ void main() {
         #ifdef INSTANCED_TRANSFORMATION
         instancedNormalMatrix*
         #endif
+        #ifdef JOINT_COUNT
+        mat3(skinMatrix)*
+        #endif
         tangent.xyz, tangent.w);
     #else
     transformedTangent = normalMatrix*
         #ifdef INSTANCED_TRANSFORMATION
         instancedNormalMatrix*
         #endif
+        #ifdef JOINT_COUNT
+        mat3(skinMatrix)*
+        #endif
         tangent;
     transformedBitangent = normalMatrix*
         #ifdef INSTANCED_TRANSFORMATION
         instancedNormalMatrix*
         #endif
+        #ifdef JOINT_COUNT
+        mat3(skinMatrix)*
+        #endif
         bitangent;
     #endif
     #endif
@@ -25,7 +25,7 @@
 
 #include "PhongGL.h"
 
-#if defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_BUILD_DEPRECATED)
+#if defined(MAGNUM_TARGET_GLES) || !defined(MAGNUM_TARGET_GLES2) || defined(MAGNUM_BUILD_DEPRECATED)
 #include <Corrade/Containers/Array.h>
 #endif
 #include <Corrade/Containers/EnumSet.hpp>
@@ -59,7 +59,8 @@ namespace {
         SpecularTextureUnit = 2,
         NormalTextureUnit = 3,
         /* 4 taken by MeshVisualizer colormap */
-        ObjectIdTextureUnit = 5 /* shared with Flat and MeshVisualizer */
+        ObjectIdTextureUnit = 5, /* shared with Flat and MeshVisualizer */
+        ShadowTextureUnit = 6
     };
 
     #ifndef MAGNUM_TARGET_GLES2
@@ -69,26 +70,53 @@ namespace {
         DrawBufferBinding = 2,
         TextureTransformationBufferBinding = 3,
         MaterialBufferBinding = 4,
-        LightBufferBinding = 5
+        LightBufferBinding = 5,
+        #ifndef MAGNUM_TARGET_GLES
+        MaterialTextureBufferBinding = 6,
+        #endif
+        #ifndef MAGNUM_TARGET_WEBGL
+        /* Same as in LightClusterGL */
+        LightClusterBufferBinding = 7,
+        #endif
+        JointBufferBinding = 8, /* shared with Flat */
+        ShadowBufferBinding = 9,
+        #ifndef MAGNUM_TARGET_WEBGL
+        VertexPullingBufferBinding = 10 /* shared with Flat */
+        #endif
     };
     #endif
-}
 
-PhongGL::PhongGL(const Flags flags, const UnsignedInt lightCount
-    #ifndef MAGNUM_TARGET_GLES2
-    , const UnsignedInt materialCount, const UnsignedInt drawCount
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    /* Shader storage buffer bindings used with Flag::LightClusters, same as
+       in LightClusterGL. The light buffer uses the same index as the light
+       uniform buffer. */
+    enum: Int {
+        ClusterLightRangeBufferBinding = 6,
+        ClusterLightIndexBufferBinding = 7
+    };
+
+    /* Shader storage buffer bindings used with Flag::VertexPulling, the first
+       three shared with Flat */
+    enum: Int {
+        PositionStorageBufferBinding = 0,
+        TextureCoordinatesStorageBufferBinding = 1,
+        ColorStorageBufferBinding = 2,
+        NormalStorageBufferBinding = 3
+    };
     #endif
-):
-    _flags{flags},
-    _lightCount{lightCount},
+}
+
+PhongGL::CompileState PhongGL::compile(const Configuration& configuration) {
+    const Flags flags = configuration.flags();
+    const UnsignedInt lightCount = configuration.lightCount();
     #ifndef MAGNUM_TARGET_GLES2
-    _materialCount{materialCount},
-    _drawCount{drawCount},
+    const UnsignedInt materialCount = configuration.materialCount();
+    const UnsignedInt drawCount = configuration.drawCount();
+    const UnsignedInt jointCount = configuration.jointCount();
+    const UnsignedInt perVertexJointCount = configuration.perVertexJointCount();
+    const UnsignedInt secondaryPerVertexJointCount = configuration.secondaryPerVertexJointCount();
     #endif
-    _lightColorsUniform{_lightPositionsUniform + Int(lightCount)},
-    _lightSpecularColorsUniform{_lightPositionsUniform + 2*Int(lightCount)},
-    _lightRangesUniform{_lightPositionsUniform + 3*Int(lightCount)}
-{
+
     {
         const bool textureTransformationNotEnabledOrTextured = !(flags & Flag::TextureTransformation) || (flags & (Flag::AmbientTexture|Flag::DiffuseTexture|Flag::SpecularTexture|Flag::NormalTexture))
             #ifndef MAGNUM_TARGET_GLES2
@@ -96,32 +124,57 @@ PhongGL::PhongGL(const Flags flags, const UnsignedInt lightCount
             #endif
             ;
         CORRADE_ASSERT(textureTransformationNotEnabledOrTextured,
-            "Shaders::PhongGL: texture transformation enabled but the shader is not textured", );
+            "Shaders::PhongGL: texture transformation enabled but the shader is not textured", CompileState{NoCreate});
     }
 
     #ifndef MAGNUM_TARGET_GLES2
     CORRADE_ASSERT(!(flags >= Flag::InstancedObjectId) || !(flags & Flag::Bitangent),
-        "Shaders::PhongGL: Bitangent attribute binding conflicts with the ObjectId attribute, use a Tangent4 attribute with instanced object ID rendering instead", );
+        "Shaders::PhongGL: Bitangent attribute binding conflicts with the ObjectId attribute, use a Tangent4 attribute with instanced object ID rendering instead", CompileState{NoCreate});
     #endif
 
     #ifndef MAGNUM_TARGET_GLES2
     CORRADE_ASSERT(!(flags >= Flag::UniformBuffers) || materialCount,
-        "Shaders::PhongGL: material count can't be zero", );
+        "Shaders::PhongGL: material count can't be zero", CompileState{NoCreate});
     CORRADE_ASSERT(!(flags >= Flag::UniformBuffers) || drawCount,
-        "Shaders::PhongGL: draw count can't be zero", );
+        "Shaders::PhongGL: draw count can't be zero", CompileState{NoCreate});
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(flags & Flag::DynamicPerVertexJointCount) || jointCount,
+        "Shaders::PhongGL: dynamic per-vertex joint count enabled for zero joints", CompileState{NoCreate});
+    CORRADE_ASSERT(!secondaryPerVertexJointCount || !(flags & Flag::InstancedTransformation),
+        "Shaders::PhongGL: secondary per-vertex joint attributes conflict with the instanced TransformationMatrix attribute", CompileState{NoCreate});
     #endif
 
     #ifndef MAGNUM_TARGET_GLES2
     CORRADE_ASSERT(!(flags & Flag::TextureArrays) || (flags & (Flag::AmbientTexture|Flag::DiffuseTexture|Flag::SpecularTexture|Flag::NormalTexture)) || flags >= Flag::ObjectIdTexture,
-        "Shaders::PhongGL: texture arrays enabled but the shader is not textured", );
+        "Shaders::PhongGL: texture arrays enabled but the shader is not textured", CompileState{NoCreate});
     CORRADE_ASSERT(!(flags & Flag::UniformBuffers) || !(flags & Flag::TextureArrays) || flags >= (Flag::TextureArrays|Flag::TextureTransformation),
-        "Shaders::PhongGL: texture arrays require texture transformation enabled as well if uniform buffers are used", );
+        "Shaders::PhongGL: texture arrays require texture transformation enabled as well if uniform buffers are used", CompileState{NoCreate});
     CORRADE_ASSERT(!(flags & Flag::LightCulling) || (flags & Flag::UniformBuffers),
-        "Shaders::PhongGL: light culling requires uniform buffers to be enabled", );
+        "Shaders::PhongGL: light culling requires uniform buffers to be enabled", CompileState{NoCreate});
+    #endif
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    CORRADE_ASSERT(!(flags >= Flag::LightClusters) || !(flags & Flag::LightCulling),
+        "Shaders::PhongGL: light clusters and light culling are mutually exclusive", CompileState{NoCreate});
+    CORRADE_ASSERT(!(flags >= Flag::LightClusters) || lightCount,
+        "Shaders::PhongGL: light clusters require a non-zero light count", CompileState{NoCreate});
+    #endif
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_ASSERT(!(flags & Flag::BindlessTextures) || flags >= Flag::UniformBuffers,
+        "Shaders::PhongGL: bindless textures require uniform buffers to be enabled", CompileState{NoCreate});
     #endif
 
     CORRADE_ASSERT(!(flags & Flag::SpecularTexture) || !(flags & (Flag::NoSpecular)),
-        "Shaders::PhongGL: specular texture requires the shader to not have specular disabled", );
+        "Shaders::PhongGL: specular texture requires the shader to not have specular disabled", CompileState{NoCreate});
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(flags & Flag::DepthOnly) || !(flags & (Flag::ObjectId|Flag::OrderIndependentTransparency)),
+        "Shaders::PhongGL: depth-only rendering is mutually exclusive with object ID and order-independent transparency", CompileState{NoCreate});
+    CORRADE_ASSERT(!(flags >= Flag::ShadowMaps) || lightCount,
+        "Shaders::PhongGL: shadow maps require a non-zero light count", CompileState{NoCreate});
+    CORRADE_ASSERT(!(flags >= Flag::ShadowMaps) || !(flags & Flag::DepthOnly),
+        "Shaders::PhongGL: shadow maps are mutually exclusive with depth-only rendering", CompileState{NoCreate});
+    #endif
 
     #ifndef MAGNUM_TARGET_GLES
     if(flags >= Flag::UniformBuffers)
@@ -139,8 +192,19 @@ PhongGL::PhongGL(const Flags flags, const UnsignedInt lightCount
     }
     #endif
     #ifndef MAGNUM_TARGET_GLES
-    if(flags >= Flag::TextureArrays)
+    if(flags >= Flag::TextureArrays || flags >= Flag::ShadowMaps)
         MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::EXT::texture_array);
+    if(flags >= Flag::BindlessTextures)
+        MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::ARB::bindless_texture);
+    #endif
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if(flags >= Flag::LightClusters || flags >= Flag::VertexPulling) {
+        #ifndef MAGNUM_TARGET_GLES
+        MAGNUM_ASSERT_GL_VERSION_SUPPORTED(GL::Version::GL430);
+        #else
+        MAGNUM_ASSERT_GL_VERSION_SUPPORTED(GL::Version::GLES310);
+        #endif
+    }
     #endif
 
     #ifdef MAGNUM_BUILD_STATIC
@@ -157,12 +221,43 @@ PhongGL::PhongGL(const Flags flags, const UnsignedInt lightCount
         "Shaders::PhongGL: uniform buffers require" << GL::Extensions::ARB::uniform_buffer_object::string(), );
     #endif
 
+    /* Shader storage buffers used by light clusters and vertex pulling need
+       GLSL 4.30 / ES 3.10 */
     #ifndef MAGNUM_TARGET_GLES
-    const GL::Version version = context.supportedVersion({GL::Version::GL320, GL::Version::GL310, GL::Version::GL300, GL::Version::GL210});
+    const GL::Version version = flags >= Flag::LightClusters || flags >= Flag::VertexPulling ? GL::Version::GL430 :
+        context.supportedVersion({GL::Version::GL320, GL::Version::GL310, GL::Version::GL300, GL::Version::GL210});
+    #elif !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    const GL::Version version = flags >= Flag::LightClusters || flags >= Flag::VertexPulling ? GL::Version::GLES310 :
+        context.supportedVersion({GL::Version::GLES300, GL::Version::GLES200});
     #else
     const GL::Version version = context.supportedVersion({GL::Version::GLES300, GL::Version::GLES200});
     #endif
 
+    PhongGL out{NoInit};
+    out._flags = flags;
+    out._lightCount = lightCount;
+    #ifndef MAGNUM_TARGET_GLES2
+    out._materialCount = materialCount;
+    out._drawCount = drawCount;
+    out._jointCount = jointCount;
+    out._perVertexJointCount = perVertexJointCount;
+    out._secondaryPerVertexJointCount = secondaryPerVertexJointCount;
+    #endif
+    out._lightColorsUniform = out._lightPositionsUniform + Int(lightCount);
+    out._lightSpecularColorsUniform = out._lightPositionsUniform + 2*Int(lightCount);
+    out._lightRangesUniform = out._lightPositionsUniform + 3*Int(lightCount);
+    #ifndef MAGNUM_TARGET_GLES2
+    /* With uniform buffers all other uniforms are aliased, so the per-vertex
+       joint count is put right after the draw offset */
+    if(flags >= Flag::UniformBuffers) {
+        out._jointMatricesUniform = -1;
+        out._perVertexJointCountUniform = 1;
+    } else {
+        out._jointMatricesUniform = out._lightPositionsUniform + 4*Int(lightCount);
+        out._perVertexJointCountUniform = out._jointMatricesUniform + Int(jointCount);
+    }
+    #endif
+
     GL::Shader vert = Implementation::createCompatibilityShader(rs, version, GL::Shader::Type::Vertex);
     GL::Shader frag = Implementation::createCompatibilityShader(rs, version, GL::Shader::Type::Fragment);
 
@@ -227,13 +322,31 @@ PhongGL::PhongGL(const Flags flags, const UnsignedInt lightCount
         #ifndef MAGNUM_TARGET_GLES2
         .addSource(flags & Flag::TextureArrays ? "#define TEXTURE_ARRAYS\n" : "")
         #endif
-        .addSource(lightCount ? "#define HAS_LIGHTS\n" : "")
+        /* The depth-only variant doesn't need any normals */
+        .addSource(lightCount && !(flags & Flag::DepthOnly) ? "#define HAS_LIGHTS\n" : "")
         #ifndef MAGNUM_TARGET_GLES2
         .addSource(flags >= Flag::InstancedObjectId ? "#define INSTANCED_OBJECT_ID\n" : "")
         #endif
         .addSource(flags & Flag::InstancedTransformation ? "#define INSTANCED_TRANSFORMATION\n" : "")
         .addSource(flags >= Flag::InstancedTextureOffset ? "#define INSTANCED_TEXTURE_OFFSET\n" : "");
     #ifndef MAGNUM_TARGET_GLES2
+    if(jointCount) {
+        vert.addSource(Utility::formatString(
+            "#define JOINT_COUNT {}\n"
+            "#define PER_VERTEX_JOINT_COUNT {}\n"
+            "#define SECONDARY_PER_VERTEX_JOINT_COUNT {}\n"
+            "#define JOINT_MATRICES_LOCATION {}\n",
+            jointCount,
+            perVertexJointCount,
+            secondaryPerVertexJointCount,
+            out._jointMatricesUniform));
+    }
+    if(flags >= Flag::DynamicPerVertexJointCount) {
+        vert.addSource(Utility::formatString(
+            "#define DYNAMIC_PER_VERTEX_JOINT_COUNT\n"
+            "#define PER_VERTEX_JOINT_COUNT_LOCATION {}\n",
+            out._perVertexJointCountUniform));
+    }
     if(flags >= Flag::UniformBuffers) {
         vert.addSource(Utility::formatString(
             "#define UNIFORM_BUFFERS\n"
@@ -241,6 +354,9 @@ PhongGL::PhongGL(const Flags flags, const UnsignedInt lightCount
             drawCount,
             lightCount));
         vert.addSource(flags >= Flag::MultiDraw ? "#define MULTI_DRAW\n" : "");
+        #ifndef MAGNUM_TARGET_WEBGL
+        vert.addSource(flags >= Flag::VertexPulling ? "#define VERTEX_PULLING\n" : "");
+        #endif
     }
     #endif
     vert.addSource(rs.getString("generic.glsl"))
@@ -259,8 +375,10 @@ PhongGL::PhongGL(const Flags flags, const UnsignedInt lightCount
         .addSource(flags & Flag::ObjectId ? "#define OBJECT_ID\n" : "")
         .addSource(flags >= Flag::InstancedObjectId ? "#define INSTANCED_OBJECT_ID\n" : "")
         .addSource(flags >= Flag::ObjectIdTexture ? "#define OBJECT_ID_TEXTURE\n" : "")
+        .addSource(flags & Flag::OrderIndependentTransparency ? "#define ORDER_INDEPENDENT_TRANSPARENCY\n" : "")
         #endif
         .addSource(flags & Flag::NoSpecular ? "#define NO_SPECULAR\n" : "")
+        .addSource(flags & Flag::DepthOnly ? "#define DEPTH_ONLY\n" : "")
         ;
     #ifndef MAGNUM_TARGET_GLES2
     if(flags >= Flag::UniformBuffers) {
@@ -273,7 +391,14 @@ PhongGL::PhongGL(const Flags flags, const UnsignedInt lightCount
             materialCount,
             lightCount));
         frag.addSource(flags >= Flag::MultiDraw ? "#define MULTI_DRAW\n" : "")
-            .addSource(flags >= Flag::LightCulling ? "#define LIGHT_CULLING\n" : "");
+            .addSource(flags >= Flag::LightCulling ? "#define LIGHT_CULLING\n" : "")
+            .addSource(flags >= Flag::ShadowMaps ? "#define SHADOW_MAPS\n" : "");
+        #ifndef MAGNUM_TARGET_WEBGL
+        frag.addSource(flags >= Flag::LightClusters ? "#define LIGHT_CLUSTERS\n" : "");
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        frag.addSource(flags >= Flag::BindlessTextures ? "#define BINDLESS_TEXTURES\n" : "");
+        #endif
     } else
     #endif
     {
@@ -283,9 +408,9 @@ PhongGL::PhongGL(const Flags flags, const UnsignedInt lightCount
             "#define LIGHT_SPECULAR_COLORS_LOCATION {}\n"
             "#define LIGHT_RANGES_LOCATION {}\n",
             lightCount,
-            _lightPositionsUniform + lightCount,
-            _lightPositionsUniform + 2*lightCount,
-            _lightPositionsUniform + 3*lightCount));
+            out._lightPositionsUniform + lightCount,
+            out._lightPositionsUniform + 2*lightCount,
+            out._lightPositionsUniform + 3*lightCount));
     }
     #ifndef MAGNUM_TARGET_GLES
     if(!(flags >= Flag::UniformBuffers) && lightCount)
@@ -294,58 +419,112 @@ PhongGL::PhongGL(const Flags flags, const UnsignedInt lightCount
     frag.addSource(rs.getString("generic.glsl"))
         .addSource(rs.getString("Phong.frag"));
 
-    CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::compile({vert, frag}));
+    /* If a matching program binary is cached, there's nothing to compile
+       or link */
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    const bool cached = out.loadCachedBinary({vert, frag});
+    #else
+    const bool cached = false;
+    #endif
+    if(!cached) {
+        vert.submitCompile();
+        frag.submitCompile();
 
-    attachShaders({vert, frag});
+        out.attachShaders({vert, frag});
 
-    /* ES3 has this done in the shader directly and doesn't even provide
-       bindFragmentDataLocation() */
-    #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
-    #ifndef MAGNUM_TARGET_GLES
-    if(!context.isExtensionSupported<GL::Extensions::ARB::explicit_attrib_location>(version))
-    #endif
-    {
-        bindAttributeLocation(Position::Location, "position");
-        if(lightCount)
-            bindAttributeLocation(Normal::Location, "normal");
-        if((flags & Flag::NormalTexture) && lightCount) {
-            bindAttributeLocation(Tangent::Location, "tangent");
-            if(flags & Flag::Bitangent)
-                bindAttributeLocation(Bitangent::Location, "bitangent");
-        }
-        if(flags & Flag::VertexColor)
-            bindAttributeLocation(Color3::Location, "vertexColor"); /* Color4 is the same */
-        if(flags & (Flag::AmbientTexture|Flag::DiffuseTexture|Flag::SpecularTexture)
+        /* ES3 has this done in the shader directly and doesn't even provide
+           bindFragmentDataLocation() */
+        #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
+        #ifndef MAGNUM_TARGET_GLES
+        if(!context.isExtensionSupported<GL::Extensions::ARB::explicit_attrib_location>(version))
+        #endif
+        {
+            out.bindAttributeLocation(Position::Location, "position");
+            if(lightCount)
+                out.bindAttributeLocation(Normal::Location, "normal");
+            if((flags & Flag::NormalTexture) && lightCount) {
+                out.bindAttributeLocation(Tangent::Location, "tangent");
+                if(flags & Flag::Bitangent)
+                    out.bindAttributeLocation(Bitangent::Location, "bitangent");
+            }
+            if(flags & Flag::VertexColor)
+                out.bindAttributeLocation(Color3::Location, "vertexColor"); /* Color4 is the same */
+            if(flags & (Flag::AmbientTexture|Flag::DiffuseTexture|Flag::SpecularTexture)
+                #ifndef MAGNUM_TARGET_GLES2
+                || flags >= Flag::ObjectIdTexture
+                #endif
+            )
+                out.bindAttributeLocation(TextureCoordinates::Location, "textureCoordinates");
             #ifndef MAGNUM_TARGET_GLES2
-            || flags >= Flag::ObjectIdTexture
+            if(flags & Flag::ObjectId) {
+                out.bindFragmentDataLocation(ColorOutput, "color");
+                out.bindFragmentDataLocation(ObjectIdOutput, "objectId");
+            }
+            if(flags & Flag::OrderIndependentTransparency) {
+                out.bindFragmentDataLocation(ColorOutput, "fragmentColor");
+                out.bindFragmentDataLocation(RevealageOutput, "fragmentRevealage");
+            }
+            if(flags >= Flag::InstancedObjectId)
+                out.bindAttributeLocation(ObjectId::Location, "instanceObjectId");
+            #endif
+            if(flags & Flag::InstancedTransformation) {
+                out.bindAttributeLocation(TransformationMatrix::Location, "instancedTransformationMatrix");
+                if(lightCount)
+                    out.bindAttributeLocation(NormalMatrix::Location, "instancedNormalMatrix");
+            }
+            if(flags >= Flag::InstancedTextureOffset)
+                out.bindAttributeLocation(TextureOffset::Location, "instancedTextureOffset");
+            #ifndef MAGNUM_TARGET_GLES2
+            if(perVertexJointCount) {
+                out.bindAttributeLocation(Weights::Location, "weights");
+                out.bindAttributeLocation(JointIds::Location, "jointIds");
+            }
+            if(secondaryPerVertexJointCount) {
+                out.bindAttributeLocation(SecondaryWeights::Location, "secondaryWeights");
+                out.bindAttributeLocation(SecondaryJointIds::Location, "secondaryJointIds");
+            }
             #endif
-        )
-            bindAttributeLocation(TextureCoordinates::Location, "textureCoordinates");
-        #ifndef MAGNUM_TARGET_GLES2
-        if(flags & Flag::ObjectId) {
-            bindFragmentDataLocation(ColorOutput, "color");
-            bindFragmentDataLocation(ObjectIdOutput, "objectId");
         }
-        if(flags >= Flag::InstancedObjectId)
-            bindAttributeLocation(ObjectId::Location, "instanceObjectId");
         #endif
-        if(flags & Flag::InstancedTransformation) {
-            bindAttributeLocation(TransformationMatrix::Location, "instancedTransformationMatrix");
-            if(lightCount)
-                bindAttributeLocation(NormalMatrix::Location, "instancedNormalMatrix");
-        }
-        if(flags >= Flag::InstancedTextureOffset)
-            bindAttributeLocation(TextureOffset::Location, "instancedTextureOffset");
+
+        out.submitLink();
     }
+
+    return CompileState{std::move(out), std::move(vert), std::move(frag), version, cached};
+}
+
+PhongGL::PhongGL(CompileState&& state): PhongGL{static_cast<PhongGL&&>(std::move(state))} {
+    #ifdef CORRADE_GRACEFUL_ASSERT
+    /* When graceful assertions fire from within compile(), we get a
+       NoCreate'd CompileState. Exiting makes it possible to test the
+       assert. */
+    if(!id()) return;
     #endif
 
-    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+    /* If the program was loaded from the binary cache, there's nothing to
+       check */
+    if(!state._cached) {
+        CORRADE_INTERNAL_ASSERT_OUTPUT(state._vert.checkCompile() && state._frag.checkCompile());
+        CORRADE_INTERNAL_ASSERT_OUTPUT(checkLink());
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        saveCachedBinary({state._vert, state._frag});
+        #endif
+    }
+
+    #ifndef MAGNUM_TARGET_GLES
+    const GL::Context& context = GL::Context::current();
+    const GL::Version version = state._version;
+    #endif
+    const Flags flags = _flags;
+    const UnsignedInt lightCount = _lightCount;
 
     #ifndef MAGNUM_TARGET_GLES
     if(!context.isExtensionSupported<GL::Extensions::ARB::explicit_uniform_location>(version))
     #endif
     {
         #ifndef MAGNUM_TARGET_GLES2
+        if(flags >= Flag::DynamicPerVertexJointCount)
+            _perVertexJointCountUniform = uniformLocation("perVertexJointCount");
         if(flags >= Flag::UniformBuffers) {
             if(_drawCount > 1) _drawOffsetUniform = uniformLocation("drawOffset");
         } else
@@ -378,6 +557,7 @@ PhongGL::PhongGL(const Flags flags, const UnsignedInt lightCount
             if(flags & Flag::AlphaMask) _alphaMaskUniform = uniformLocation("alphaMask");
             #ifndef MAGNUM_TARGET_GLES2
             if(flags & Flag::ObjectId) _objectIdUniform = uniformLocation("objectId");
+            if(_jointCount) _jointMatricesUniform = uniformLocation("jointMatrices");
             #endif
         }
     }
@@ -386,14 +566,25 @@ PhongGL::PhongGL(const Flags flags, const UnsignedInt lightCount
     if(flags && !context.isExtensionSupported<GL::Extensions::ARB::shading_language_420pack>(version))
     #endif
     {
-        if(flags & Flag::AmbientTexture) setUniform(uniformLocation("ambientTexture"), AmbientTextureUnit);
-        if(lightCount) {
-            if(flags & Flag::DiffuseTexture) setUniform(uniformLocation("diffuseTexture"), DiffuseTextureUnit);
-            if(flags & Flag::SpecularTexture) setUniform(uniformLocation("specularTexture"), SpecularTextureUnit);
-            if(flags & Flag::NormalTexture) setUniform(uniformLocation("normalTexture"), NormalTextureUnit);
+        /* With bindless textures the samplers come from a uniform buffer and
+           there are no sampler uniforms to set */
+        #ifndef MAGNUM_TARGET_GLES
+        if(!(flags >= Flag::BindlessTextures))
+        #endif
+        {
+            if(flags & Flag::AmbientTexture) setUniform(uniformLocation("ambientTexture"), AmbientTextureUnit);
+            if(lightCount) {
+                if(flags & Flag::DiffuseTexture) setUniform(uniformLocation("diffuseTexture"), DiffuseTextureUnit);
+                if(flags & Flag::SpecularTexture) setUniform(uniformLocation("specularTexture"), SpecularTextureUnit);
+                if(flags & Flag::NormalTexture) setUniform(uniformLocation("normalTexture"), NormalTextureUnit);
+            }
+            #ifndef MAGNUM_TARGET_GLES2
+            if(flags >= Flag::ObjectIdTexture) setUniform(uniformLocation("objectIdTextureData"), ObjectIdTextureUnit);
+            #endif
         }
         #ifndef MAGNUM_TARGET_GLES2
-        if(flags >= Flag::ObjectIdTexture) setUniform(uniformLocation("objectIdTextureData"), ObjectIdTextureUnit);
+        /* The shadow map is never bindless */
+        if(flags >= Flag::ShadowMaps) setUniform(uniformLocation("shadowTexture"), ShadowTextureUnit);
         if(flags >= Flag::UniformBuffers) {
             setUniformBlockBinding(uniformBlockIndex("Projection"), ProjectionBufferBinding);
             setUniformBlockBinding(uniformBlockIndex("Transformation"), TransformationBufferBinding);
@@ -401,15 +592,42 @@ PhongGL::PhongGL(const Flags flags, const UnsignedInt lightCount
             setUniformBlockBinding(uniformBlockIndex("Material"), MaterialBufferBinding);
             if(flags & Flag::TextureTransformation)
                 setUniformBlockBinding(uniformBlockIndex("TextureTransformation"), TextureTransformationBufferBinding);
-            if(lightCount)
+            /* With light clusters all light-related blocks have explicit
+               bindings in the shader code */
+            if(lightCount
+                #ifndef MAGNUM_TARGET_WEBGL
+                && !(flags >= Flag::LightClusters)
+                #endif
+            )
                 setUniformBlockBinding(uniformBlockIndex("Light"), LightBufferBinding);
+            #ifndef MAGNUM_TARGET_GLES
+            if(flags >= Flag::BindlessTextures)
+                setUniformBlockBinding(uniformBlockIndex("MaterialTexture"), MaterialTextureBufferBinding);
+            #endif
+            if(_jointCount)
+                setUniformBlockBinding(uniformBlockIndex("Joint"), JointBufferBinding);
+            if(flags >= Flag::ShadowMaps)
+                setUniformBlockBinding(uniformBlockIndex("Shadow"), ShadowBufferBinding);
+            #ifndef MAGNUM_TARGET_WEBGL
+            if(flags >= Flag::VertexPulling)
+                setUniformBlockBinding(uniformBlockIndex("VertexPulling"), VertexPullingBufferBinding);
+            #endif
         }
         #endif
     }
 
+    /* Joint matrices don't have a shader-side initializer on any platform,
+       as it'd be needlessly long for large joint counts */
+    #ifndef MAGNUM_TARGET_GLES2
+    if(_jointCount && !(flags >= Flag::UniformBuffers))
+        setJointMatrices(Containers::Array<Matrix4>{DirectInit, _jointCount, Math::IdentityInit});
+    #endif
+
     /* Set defaults in OpenGL ES (for desktop they are set in shader code itself) */
     #ifdef MAGNUM_TARGET_GLES
     #ifndef MAGNUM_TARGET_GLES2
+    if(flags >= Flag::DynamicPerVertexJointCount)
+        setPerVertexJointCount(_perVertexJointCount, _secondaryPerVertexJointCount);
     if(flags >= Flag::UniformBuffers) {
         /* Draw offset is zero by default */
     } else
@@ -446,8 +664,41 @@ PhongGL::PhongGL(const Flags flags, const UnsignedInt lightCount
     #endif
 }
 
+PhongGL::CompileState PhongGL::compile(const Flags flags, const UnsignedInt lightCount) {
+    return compile(Configuration{}
+        .setFlags(flags)
+        .setLightCount(lightCount));
+}
+
 #ifndef MAGNUM_TARGET_GLES2
-PhongGL::PhongGL(const Flags flags, const UnsignedInt lightCount): PhongGL{flags, lightCount, 1, 1} {}
+PhongGL::CompileState PhongGL::compile(const Flags flags, const UnsignedInt lightCount, const UnsignedInt materialCount, const UnsignedInt drawCount) {
+    return compile(Configuration{}
+        .setFlags(flags)
+        .setLightCount(lightCount)
+        .setMaterialCount(materialCount)
+        .setDrawCount(drawCount));
+}
+#endif
+
+PhongGL::PhongGL(const Flags flags, const UnsignedInt lightCount): PhongGL{compile(flags, lightCount)} {}
+
+#ifndef MAGNUM_TARGET_GLES2
+PhongGL::PhongGL(const Flags flags, const UnsignedInt lightCount, const UnsignedInt materialCount, const UnsignedInt drawCount): PhongGL{compile(flags, lightCount, materialCount, drawCount)} {}
+#endif
+
+PhongGL::PhongGL(const Configuration& configuration): PhongGL{compile(configuration)} {}
+
+#ifndef MAGNUM_TARGET_GLES2
+PhongGL& PhongGL::setPerVertexJointCount(const UnsignedInt count, const UnsignedInt secondaryCount) {
+    CORRADE_ASSERT(_flags >= Flag::DynamicPerVertexJointCount,
+        "Shaders::PhongGL::setPerVertexJointCount(): the shader was not created with dynamic per-vertex joint count enabled", *this);
+    CORRADE_ASSERT(count <= _perVertexJointCount,
+        "Shaders::PhongGL::setPerVertexJointCount(): expected at most" << _perVertexJointCount << "per-vertex joints, got" << count, *this);
+    CORRADE_ASSERT(secondaryCount <= _secondaryPerVertexJointCount,
+        "Shaders::PhongGL::setPerVertexJointCount(): expected at most" << _secondaryPerVertexJointCount << "secondary per-vertex joints, got" << secondaryCount, *this);
+    setUniform(_perVertexJointCountUniform, Vector2ui{count, secondaryCount});
+    return *this;
+}
 #endif
 
 PhongGL& PhongGL::setAmbientColor(const Magnum::Color4& color) {
@@ -736,6 +987,30 @@ PhongGL& PhongGL::setLightRange(const UnsignedInt id, const Float range) {
     return *this;
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+PhongGL& PhongGL::setJointMatrices(const Containers::ArrayView<const Matrix4> matrices) {
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::PhongGL::setJointMatrices(): the shader was created with uniform buffers enabled", *this);
+    CORRADE_ASSERT(matrices.size() <= _jointCount,
+        "Shaders::PhongGL::setJointMatrices(): expected at most" << _jointCount << "items but got" << matrices.size(), *this);
+    if(matrices.size()) setUniform(_jointMatricesUniform, matrices);
+    return *this;
+}
+
+PhongGL& PhongGL::setJointMatrices(const std::initializer_list<Matrix4> matrices) {
+    return setJointMatrices(Containers::arrayView(matrices));
+}
+
+PhongGL& PhongGL::setJointMatrix(const UnsignedInt id, const Matrix4& matrix) {
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::PhongGL::setJointMatrix(): the shader was created with uniform buffers enabled", *this);
+    CORRADE_ASSERT(id < _jointCount,
+        "Shaders::PhongGL::setJointMatrix(): joint ID" << id << "is out of bounds for" << _jointCount << "joints", *this);
+    setUniform(_jointMatricesUniform + id, matrix);
+    return *this;
+}
+#endif
+
 #ifndef MAGNUM_TARGET_GLES2
 PhongGL& PhongGL::setDrawOffset(const UnsignedInt offset) {
     CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
@@ -820,21 +1095,207 @@ PhongGL& PhongGL::bindMaterialBuffer(GL::Buffer& buffer, const GLintptr offset,
     return *this;
 }
 
+#ifndef MAGNUM_TARGET_GLES
+PhongGL& PhongGL::bindMaterialTextureBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags >= Flag::BindlessTextures,
+        "Shaders::PhongGL::bindMaterialTextureBuffer(): the shader was not created with bindless textures enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, MaterialTextureBufferBinding);
+    return *this;
+}
+
+PhongGL& PhongGL::bindMaterialTextureBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags >= Flag::BindlessTextures,
+        "Shaders::PhongGL::bindMaterialTextureBuffer(): the shader was not created with bindless textures enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, MaterialTextureBufferBinding, offset, size);
+    return *this;
+}
+#endif
+
 PhongGL& PhongGL::bindLightBuffer(GL::Buffer& buffer) {
     CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
         "Shaders::PhongGL::bindLightBuffer(): the shader was not created with uniform buffers enabled", *this);
-    buffer.bind(GL::Buffer::Target::Uniform, LightBufferBinding);
+    #ifndef MAGNUM_TARGET_WEBGL
+    if(_flags >= Flag::LightClusters)
+        buffer.bind(GL::Buffer::Target::ShaderStorage, LightBufferBinding);
+    else
+    #endif
+    {
+        buffer.bind(GL::Buffer::Target::Uniform, LightBufferBinding);
+    }
     return *this;
 }
 
 PhongGL& PhongGL::bindLightBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
     CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
         "Shaders::PhongGL::bindLightBuffer(): the shader was not created with uniform buffers enabled", *this);
-    buffer.bind(GL::Buffer::Target::Uniform, LightBufferBinding, offset, size);
+    #ifndef MAGNUM_TARGET_WEBGL
+    if(_flags >= Flag::LightClusters)
+        buffer.bind(GL::Buffer::Target::ShaderStorage, LightBufferBinding, offset, size);
+    else
+    #endif
+    {
+        buffer.bind(GL::Buffer::Target::Uniform, LightBufferBinding, offset, size);
+    }
+    return *this;
+}
+
+#ifndef MAGNUM_TARGET_WEBGL
+PhongGL& PhongGL::bindLightClusterBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags >= Flag::LightClusters,
+        "Shaders::PhongGL::bindLightClusterBuffer(): the shader was not created with light clusters enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, LightClusterBufferBinding);
+    return *this;
+}
+
+PhongGL& PhongGL::bindLightClusterBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags >= Flag::LightClusters,
+        "Shaders::PhongGL::bindLightClusterBuffer(): the shader was not created with light clusters enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, LightClusterBufferBinding, offset, size);
+    return *this;
+}
+
+PhongGL& PhongGL::bindClusterLightRangeBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags >= Flag::LightClusters,
+        "Shaders::PhongGL::bindClusterLightRangeBuffer(): the shader was not created with light clusters enabled", *this);
+    buffer.bind(GL::Buffer::Target::ShaderStorage, ClusterLightRangeBufferBinding);
+    return *this;
+}
+
+PhongGL& PhongGL::bindClusterLightRangeBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags >= Flag::LightClusters,
+        "Shaders::PhongGL::bindClusterLightRangeBuffer(): the shader was not created with light clusters enabled", *this);
+    buffer.bind(GL::Buffer::Target::ShaderStorage, ClusterLightRangeBufferBinding, offset, size);
+    return *this;
+}
+
+PhongGL& PhongGL::bindClusterLightIndexBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags >= Flag::LightClusters,
+        "Shaders::PhongGL::bindClusterLightIndexBuffer(): the shader was not created with light clusters enabled", *this);
+    buffer.bind(GL::Buffer::Target::ShaderStorage, ClusterLightIndexBufferBinding);
+    return *this;
+}
+
+PhongGL& PhongGL::bindClusterLightIndexBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags >= Flag::LightClusters,
+        "Shaders::PhongGL::bindClusterLightIndexBuffer(): the shader was not created with light clusters enabled", *this);
+    buffer.bind(GL::Buffer::Target::ShaderStorage, ClusterLightIndexBufferBinding, offset, size);
     return *this;
 }
 #endif
 
+PhongGL& PhongGL::bindJointBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::PhongGL::bindJointBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, JointBufferBinding);
+    return *this;
+}
+
+PhongGL& PhongGL::bindJointBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::PhongGL::bindJointBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, JointBufferBinding, offset, size);
+    return *this;
+}
+
+PhongGL& PhongGL::bindShadowBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags >= Flag::ShadowMaps,
+        "Shaders::PhongGL::bindShadowBuffer(): the shader was not created with shadow maps enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, ShadowBufferBinding);
+    return *this;
+}
+
+PhongGL& PhongGL::bindShadowBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags >= Flag::ShadowMaps,
+        "Shaders::PhongGL::bindShadowBuffer(): the shader was not created with shadow maps enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, ShadowBufferBinding, offset, size);
+    return *this;
+}
+
+#ifndef MAGNUM_TARGET_WEBGL
+PhongGL& PhongGL::bindVertexPullingBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags >= Flag::VertexPulling,
+        "Shaders::PhongGL::bindVertexPullingBuffer(): the shader was not created with vertex pulling enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, VertexPullingBufferBinding);
+    return *this;
+}
+
+PhongGL& PhongGL::bindVertexPullingBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags >= Flag::VertexPulling,
+        "Shaders::PhongGL::bindVertexPullingBuffer(): the shader was not created with vertex pulling enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, VertexPullingBufferBinding, offset, size);
+    return *this;
+}
+
+PhongGL& PhongGL::bindPositionStorageBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags >= Flag::VertexPulling,
+        "Shaders::PhongGL::bindPositionStorageBuffer(): the shader was not created with vertex pulling enabled", *this);
+    buffer.bind(GL::Buffer::Target::ShaderStorage, PositionStorageBufferBinding);
+    return *this;
+}
+
+PhongGL& PhongGL::bindPositionStorageBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags >= Flag::VertexPulling,
+        "Shaders::PhongGL::bindPositionStorageBuffer(): the shader was not created with vertex pulling enabled", *this);
+    buffer.bind(GL::Buffer::Target::ShaderStorage, PositionStorageBufferBinding, offset, size);
+    return *this;
+}
+
+PhongGL& PhongGL::bindNormalStorageBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags >= Flag::VertexPulling,
+        "Shaders::PhongGL::bindNormalStorageBuffer(): the shader was not created with vertex pulling enabled", *this);
+    CORRADE_ASSERT(_lightCount,
+        "Shaders::PhongGL::bindNormalStorageBuffer(): the shader was not created with any lights", *this);
+    buffer.bind(GL::Buffer::Target::ShaderStorage, NormalStorageBufferBinding);
+    return *this;
+}
+
+PhongGL& PhongGL::bindNormalStorageBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags >= Flag::VertexPulling,
+        "Shaders::PhongGL::bindNormalStorageBuffer(): the shader was not created with vertex pulling enabled", *this);
+    CORRADE_ASSERT(_lightCount,
+        "Shaders::PhongGL::bindNormalStorageBuffer(): the shader was not created with any lights", *this);
+    buffer.bind(GL::Buffer::Target::ShaderStorage, NormalStorageBufferBinding, offset, size);
+    return *this;
+}
+
+PhongGL& PhongGL::bindTextureCoordinatesStorageBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags >= Flag::VertexPulling,
+        "Shaders::PhongGL::bindTextureCoordinatesStorageBuffer(): the shader was not created with vertex pulling enabled", *this);
+    CORRADE_ASSERT(_flags & (Flag::AmbientTexture|Flag::DiffuseTexture|Flag::SpecularTexture|Flag::NormalTexture) || _flags >= Flag::ObjectIdTexture,
+        "Shaders::PhongGL::bindTextureCoordinatesStorageBuffer(): the shader was not created with texturing enabled", *this);
+    buffer.bind(GL::Buffer::Target::ShaderStorage, TextureCoordinatesStorageBufferBinding);
+    return *this;
+}
+
+PhongGL& PhongGL::bindTextureCoordinatesStorageBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags >= Flag::VertexPulling,
+        "Shaders::PhongGL::bindTextureCoordinatesStorageBuffer(): the shader was not created with vertex pulling enabled", *this);
+    CORRADE_ASSERT(_flags & (Flag::AmbientTexture|Flag::DiffuseTexture|Flag::SpecularTexture|Flag::NormalTexture) || _flags >= Flag::ObjectIdTexture,
+        "Shaders::PhongGL::bindTextureCoordinatesStorageBuffer(): the shader was not created with texturing enabled", *this);
+    buffer.bind(GL::Buffer::Target::ShaderStorage, TextureCoordinatesStorageBufferBinding, offset, size);
+    return *this;
+}
+
+PhongGL& PhongGL::bindColorStorageBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags >= Flag::VertexPulling,
+        "Shaders::PhongGL::bindColorStorageBuffer(): the shader was not created with vertex pulling enabled", *this);
+    CORRADE_ASSERT(_flags & Flag::VertexColor,
+        "Shaders::PhongGL::bindColorStorageBuffer(): the shader was not created with vertex colors enabled", *this);
+    buffer.bind(GL::Buffer::Target::ShaderStorage, ColorStorageBufferBinding);
+    return *this;
+}
+
+PhongGL& PhongGL::bindColorStorageBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags >= Flag::VertexPulling,
+        "Shaders::PhongGL::bindColorStorageBuffer(): the shader was not created with vertex pulling enabled", *this);
+    CORRADE_ASSERT(_flags & Flag::VertexColor,
+        "Shaders::PhongGL::bindColorStorageBuffer(): the shader was not created with vertex colors enabled", *this);
+    buffer.bind(GL::Buffer::Target::ShaderStorage, ColorStorageBufferBinding, offset, size);
+    return *this;
+}
+#endif
+#endif
+
 PhongGL& PhongGL::bindAmbientTexture(GL::Texture2D& texture) {
     CORRADE_ASSERT(_flags & Flag::AmbientTexture,
         "Shaders::PhongGL::bindAmbientTexture(): the shader was not created with ambient texture enabled", *this);
@@ -943,6 +1404,13 @@ PhongGL& PhongGL::bindObjectIdTexture(GL::Texture2DArray& texture) {
     texture.bind(ObjectIdTextureUnit);
     return *this;
 }
+
+PhongGL& PhongGL::bindShadowTexture(GL::Texture2DArray& texture) {
+    CORRADE_ASSERT(_flags >= Flag::ShadowMaps,
+        "Shaders::PhongGL::bindShadowTexture(): the shader was not created with shadow maps enabled", *this);
+    texture.bind(ShadowTextureUnit);
+    return *this;
+}
 #endif
 
 PhongGL& PhongGL::bindTextures(GL::Texture2D* ambient, GL::Texture2D* diffuse, GL::Texture2D* specular, GL::Texture2D* normal) {
@@ -956,6 +1424,23 @@ PhongGL& PhongGL::bindTextures(GL::Texture2D* ambient, GL::Texture2D* diffuse, G
     return *this;
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+PhongGL::Configuration& PhongGL::Configuration::setJointCount(const UnsignedInt count, const UnsignedInt perVertexCount, const UnsignedInt secondaryPerVertexCount) {
+    CORRADE_ASSERT(perVertexCount <= 4,
+        "Shaders::PhongGL::Configuration::setJointCount(): expected at most 4 per-vertex joints, got" << perVertexCount, *this);
+    CORRADE_ASSERT(secondaryPerVertexCount <= 4,
+        "Shaders::PhongGL::Configuration::setJointCount(): expected at most 4 secondary per-vertex joints, got" << secondaryPerVertexCount, *this);
+    CORRADE_ASSERT(count || !(perVertexCount || secondaryPerVertexCount),
+        "Shaders::PhongGL::Configuration::setJointCount(): count can't be zero if per-vertex joint count is non-zero", *this);
+    CORRADE_ASSERT(!count || perVertexCount || secondaryPerVertexCount,
+        "Shaders::PhongGL::Configuration::setJointCount(): per-vertex joint count can't be zero if count is non-zero", *this);
+    _jointCount = count;
+    _perVertexJointCount = perVertexCount;
+    _secondaryPerVertexJointCount = secondaryPerVertexCount;
+    return *this;
+}
+#endif
+
 Debug& operator<<(Debug& debug, const PhongGL::Flag value) {
     #ifndef MAGNUM_TARGET_GLES2
     /* Special case coming from the Flags printer. As both flags are a superset
@@ -990,8 +1475,21 @@ Debug& operator<<(Debug& debug, const PhongGL::Flag value) {
         _c(MultiDraw)
         _c(TextureArrays)
         _c(LightCulling)
+        _c(DynamicPerVertexJointCount)
+        _c(OrderIndependentTransparency)
         #endif
         _c(NoSpecular)
+        _c(DepthOnly)
+        #ifndef MAGNUM_TARGET_GLES2
+        _c(ShadowMaps)
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        _c(BindlessTextures)
+        #endif
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        _c(LightClusters)
+        _c(VertexPulling)
+        #endif
         #undef _c
         /* LCOV_EXCL_STOP */
     }
@@ -1021,12 +1519,23 @@ Debug& operator<<(Debug& debug, const PhongGL::Flags value) {
         #endif
         PhongGL::Flag::InstancedTransformation,
         #ifndef MAGNUM_TARGET_GLES2
+        #ifndef MAGNUM_TARGET_WEBGL
+        PhongGL::Flag::LightClusters, /* Superset of UniformBuffers */
+        PhongGL::Flag::VertexPulling, /* Superset of UniformBuffers */
+        #endif
         PhongGL::Flag::MultiDraw, /* Superset of UniformBuffers */
+        PhongGL::Flag::ShadowMaps, /* Superset of UniformBuffers */
         PhongGL::Flag::UniformBuffers,
         PhongGL::Flag::TextureArrays,
         PhongGL::Flag::LightCulling,
+        PhongGL::Flag::DynamicPerVertexJointCount,
+        PhongGL::Flag::OrderIndependentTransparency,
+        #endif
+        PhongGL::Flag::NoSpecular,
+        PhongGL::Flag::DepthOnly,
+        #ifndef MAGNUM_TARGET_GLES
+        PhongGL::Flag::BindlessTextures
         #endif
-        PhongGL::Flag::NoSpecular
     });
 }
 
@@ -31,6 +31,7 @@
  */
 
 #include "Magnum/GL/AbstractShaderProgram.h"
+#include "Magnum/GL/Shader.h"
 #include "Magnum/Shaders/GenericGL.h"
 #include "Magnum/Shaders/visibility.h"
 
@@ -179,6 +180,77 @@ diffuse part and then separate the alpha like this:
 
 @snippet MagnumShaders-gl.cpp PhongGL-usage-alpha
 
+@section Shaders-PhongGL-oit Order-independent transparency
+
+Blending transparent objects as described above requires them to be sorted
+back to front, which gets expensive with many objects and isn't possible to
+do correctly for intersecting geometry. Enabling
+@ref Flag::OrderIndependentTransparency makes the shader output values for
+weighted blended order-independent transparency instead, which can be drawn in
+any order. The @ref ColorOutput is meant to be accumulated in a floating-point
+attachment and the @ref RevealageOutput in a single-component attachment,
+which are then composited over the opaque geometry with
+@ref TransparencyResolveGL. See its documentation for a complete example.
+
+The result is an approximation that weights the overlapping surfaces based on
+their depth and opacity, so it's best suited for many layers of similarly
+transparent surfaces such as particles or x-ray views. Opaque surfaces drawn
+this way get blended with whatever else is at the same pixel, draw them
+regularly before the transparent ones.
+
+@section Shaders-PhongGL-depth-prepass Depth prepass
+
+With many overlapping surfaces, the expensive lighting calculation gets done
+for fragments that end up being occluded anyway. Drawing the scene first with
+@ref Flag::DepthOnly enabled fills the depth buffer with a cheap shader, the
+shading pass is then done with depth writes disabled and the depth function
+set to @ref GL::Renderer::DepthFunction::Equal, which makes each pixel shaded
+only once:
+
+@snippet MagnumShaders-gl.cpp PhongGL-depth-prepass
+
+The depth-only variant should be created with the same flags affecting the
+vertex stage as the shading variant --- such as
+@ref Flag::InstancedTransformation, @ref Flag::MultiDraw, skinning or
+@ref Flag::TextureTransformation --- and with the same light count, so the
+same uniforms and uniform buffers can be used with both. The shader declares
+@glsl gl_Position @ce as @glsl invariant @ce, guaranteeing that both variants
+produce the exact same depth values. To have alpha-masked geometry correctly
+cut out in the prepass, enable @ref Flag::AlphaMask and the ambient and
+diffuse textures that provide the alpha in both variants. Note that the
+specular alpha, which is only added for lit fragments, isn't taken into
+account in the depth-only variant.
+
+@section Shaders-PhongGL-shadows Cascaded shadow maps
+
+With @ref Flag::ShadowMaps, a single light --- usually a directional sun light
+--- is attenuated by a lookup into a depth texture array, each layer
+containing one of up to four cascades that cover consecutive slices of the
+camera frustum. The cascades are rendered first with @ref Flag::DepthOnly
+into layers of a @ref GL::Texture2DArray with a depth format and a
+@ref GL::SamplerCompareMode::CompareRefToTexture comparison mode, using
+projections calculated with @ref shadowCascadeProjection() from the camera
+matrices and cascade splits calculated with @ref shadowCascadeSplits(). The
+shading pass then takes the splits and the cascade matrices in a
+@ref ShadowCascadeUniform supplied via @ref bindShadowBuffer():
+
+@snippet MagnumShaders-gl.cpp PhongGL-shadows
+
+The fragment picks a cascade based on its camera-space depth and takes nine
+samples around its projected position, resulting in shadow edges softened
+over @ref ShadowCascadeUniform::filterRadius texels. Only the light at
+@ref ShadowCascadeUniform::lightIndex is shadowed, which, with
+@ref Flag::LightCulling, is an index into the whole light buffer. Fragments
+beyond the last cascade are left unshadowed. The cascade parameters are kept
+in a dedicated uniform buffer shared by all draws, so the flag can be freely
+combined with @ref Flag::MultiDraw.
+
+@requires_gl30 Extension @gl_extension{EXT,texture_array} for shadow maps.
+@requires_gles30 Neither texture arrays nor uniform buffers are available in
+    OpenGL ES 2.0.
+@requires_webgl20 Neither texture arrays nor uniform buffers are available in
+    WebGL 1.0.
+
 @section Shaders-PhongGL-normal-mapping Normal mapping
 
 If you want to use normal textures, enable @ref Flag::NormalTexture and call
@@ -253,6 +325,37 @@ well to ensure lighting works:
 @requires_webgl20 Extension @webgl_extension{ANGLE,instanced_arrays} in WebGL
     1.0.
 
+@section Shaders-PhongGL-skinning Skinning
+
+To render skinned meshes, set the count of joint matrices and the count of
+joints affecting each vertex with @ref Configuration::setJointCount() and pass
+the configuration to @ref PhongGL(const Configuration&). The mesh is then
+expected to contain the @ref JointIds and @ref Weights attributes, with up to
+four more joints per vertex supplied in the @ref SecondaryJointIds and
+@ref SecondaryWeights attributes. Joint matrices, usually the absolute joint
+transformation multiplied by the inverse bind matrix, are supplied with
+@ref setJointMatrices() and are applied before the instanced and the
+per-draw transformation:
+
+@snippet MagnumShaders-gl.cpp PhongGL-usage-skinning
+
+With @ref Flag::UniformBuffers, joint matrices are supplied in a
+@ref TransformationUniform3D buffer bound with @ref bindJointBuffer() instead,
+each draw picking its range via @ref PhongDrawUniform::jointOffset. In order
+to use a single shader for meshes with different count of per-vertex joints,
+enable @ref Flag::DynamicPerVertexJointCount and set the actual per-draw count
+with @ref setPerVertexJointCount().
+
+The secondary attributes share locations with the instanced
+@ref TransformationMatrix, so secondary per-vertex joints can't be used
+together with @ref Flag::InstancedTransformation.
+
+@requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+@requires_gles30 Skinning requires integer support in shaders, which is not
+    available in OpenGL ES 2.0.
+@requires_webgl20 Skinning requires integer support in shaders, which is not
+    available in WebGL 1.0.
+
 @section Shaders-PhongGL-ubo Uniform buffers
 
 See @ref shaders-usage-ubo for a high-level overview that applies to all
@@ -276,7 +379,8 @@ every draw then specify material references and texture offsets/layers. With
 supplying a subrange into the @ref PhongLightUniform array using
 @ref PhongDrawUniform::lightOffset and @relativeref{PhongDrawUniform,lightCount}.
 Besides that, the usage is similar for all shaders, see
-@ref shaders-usage-multidraw for an example.
+@ref shaders-usage-multidraw for an example. For large light counts see
+@ref Shaders-PhongGL-light-clusters below.
 
 @requires_gl30 Extension @gl_extension{EXT,texture_array} for texture arrays.
 @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object} for uniform
@@ -292,6 +396,59 @@ Besides that, the usage is similar for all shaders, see
 @requires_webgl_extension Extension @webgl_extension{ANGLE,multi_draw} for
     multidraw.
 
+@section Shaders-PhongGL-light-clusters Clustered light culling
+
+With @ref Flag::LightClusters, lights are assigned to a froxel grid on the GPU
+by a @ref LightClusterGL compute pass and each fragment then evaluates only the
+lights affecting its cluster, which makes it feasible to render scenes with
+thousands of lights. The @ref lightCount() passed to the constructor is then
+the size of the whole light buffer, which is bound as a shader storage buffer.
+The @ref LightClusterUniform and the output buffers of the compute pass are
+bound to the same binding points in both shaders, see
+@ref Shaders-LightClusterGL-usage for an example.
+
+@requires_gl43 Extension @gl_extension{ARB,shader_storage_buffer_object} for
+    light clusters.
+@requires_gles31 Shader storage buffers are not available in OpenGL ES 3.0
+    and older.
+@requires_gles Shader storage buffers are not available in WebGL.
+
+@section Shaders-PhongGL-bindless Bindless textures
+
+With @ref Flag::BindlessTextures, the shader doesn't sample textures bound to
+fixed texture units but instead takes
+@ref GL::Texture::handle() "bindless texture handles" from a
+@ref PhongMaterialTextureUniform buffer bound with
+@ref bindMaterialTextureBuffer(). The buffer is indexed with
+@ref PhongDrawUniform::materialId the same way as the
+@ref PhongMaterialUniform buffer, which together with @ref Flag::MultiDraw
+allows drawing meshes with different textures in a single draw call. Apart
+from the shader class and the set of handles the setup is the same as in the
+@ref Shaders-FlatGL-bindless "FlatGL bindless example".
+
+@requires_extension Extension @gl_extension{ARB,bindless_texture} for
+    bindless textures.
+@requires_gl Bindless textures are not available in OpenGL ES or WebGL.
+
+@section Shaders-PhongGL-vertex-pulling Vertex pulling
+
+With @ref Flag::VertexPulling, positions, normals, texture coordinates and
+vertex colors are fetched from tightly packed shader storage buffers bound
+with @ref bindPositionStorageBuffer(), @ref bindNormalStorageBuffer(),
+@ref bindTextureCoordinatesStorageBuffer() and @ref bindColorStorageBuffer()
+instead of vertex attributes, with per-draw offsets taken from a
+@ref VertexPullingUniform buffer bound with @ref bindVertexPullingBuffer().
+Tangents, bitangents, skinning and instancing attributes are still taken from
+regular vertex attributes. Apart from the shader class and the additional
+normal buffer the setup is the same as in the
+@ref Shaders-FlatGL-vertex-pulling "FlatGL vertex pulling example".
+
+@requires_gl43 Extension @gl_extension{ARB,shader_storage_buffer_object} for
+    vertex pulling.
+@requires_gles31 Shader storage buffers are not available in OpenGL ES 3.0
+    and older.
+@requires_gles Shader storage buffers are not available in WebGL.
+
 @see @ref shaders
 */
 class MAGNUM_SHADERS_EXPORT PhongGL: public GL::AbstractShaderProgram {
@@ -382,6 +539,66 @@ class MAGNUM_SHADERS_EXPORT PhongGL: public GL::AbstractShaderProgram {
         typedef GenericGL3D::Color4 Color4;
 
         #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Joint ids
+         * @m_since_latest
+         *
+         * @ref shaders-generic "Generic attribute",
+         * @ref Magnum::Vector4ui "Vector4ui". Used only if
+         * @ref perVertexJointCount() isn't @cpp 0 @ce.
+         * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+         * @requires_gles30 Skinning requires integer support in shaders,
+         *      which is not available in OpenGL ES 2.0.
+         * @requires_webgl20 Skinning requires integer support in shaders,
+         *      which is not available in WebGL 1.0.
+         */
+        typedef GenericGL3D::JointIds JointIds;
+
+        /**
+         * @brief Weights
+         * @m_since_latest
+         *
+         * @ref shaders-generic "Generic attribute",
+         * @ref Magnum::Vector4 "Vector4". Used only if
+         * @ref perVertexJointCount() isn't @cpp 0 @ce.
+         * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+         * @requires_gles30 Skinning requires integer support in shaders,
+         *      which is not available in OpenGL ES 2.0.
+         * @requires_webgl20 Skinning requires integer support in shaders,
+         *      which is not available in WebGL 1.0.
+         */
+        typedef GenericGL3D::Weights Weights;
+
+        /**
+         * @brief Secondary joint ids
+         * @m_since_latest
+         *
+         * @ref shaders-generic "Generic attribute",
+         * @ref Magnum::Vector4ui "Vector4ui". Used only if
+         * @ref secondaryPerVertexJointCount() isn't @cpp 0 @ce.
+         * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+         * @requires_gles30 Skinning requires integer support in shaders,
+         *      which is not available in OpenGL ES 2.0.
+         * @requires_webgl20 Skinning requires integer support in shaders,
+         *      which is not available in WebGL 1.0.
+         */
+        typedef GenericGL3D::SecondaryJointIds SecondaryJointIds;
+
+        /**
+         * @brief Secondary weights
+         * @m_since_latest
+         *
+         * @ref shaders-generic "Generic attribute",
+         * @ref Magnum::Vector4 "Vector4". Used only if
+         * @ref secondaryPerVertexJointCount() isn't @cpp 0 @ce.
+         * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+         * @requires_gles30 Skinning requires integer support in shaders,
+         *      which is not available in OpenGL ES 2.0.
+         * @requires_webgl20 Skinning requires integer support in shaders,
+         *      which is not available in WebGL 1.0.
+         */
+        typedef GenericGL3D::SecondaryWeights SecondaryWeights;
+
         /**
          * @brief (Instanced) object ID
          * @m_since{2020,06}
@@ -484,7 +701,23 @@ class MAGNUM_SHADERS_EXPORT PhongGL: public GL::AbstractShaderProgram {
              *      shaders, which is not available in WebGL 1.0.
              * @m_since{2019,10}
              */
-            ObjectIdOutput = GenericGL3D::ObjectIdOutput
+            ObjectIdOutput = GenericGL3D::ObjectIdOutput,
+
+            /**
+             * Revealage output. @ref shaders-generic "Generic output",
+             * present only if @ref Flag::OrderIndependentTransparency is set.
+             * Expects a single-component floating-point or normalized buffer
+             * attachment. See @ref Shaders-PhongGL-oit for more information.
+             * @requires_gl30 Extension @gl_extension{ARB,texture_float}
+             * @requires_gles30 Order-independent transparency requires
+             *      floating-point render targets, which are not available in
+             *      OpenGL ES 2.0.
+             * @requires_webgl20 Order-independent transparency requires
+             *      floating-point render targets, which are not available in
+             *      WebGL 1.0.
+             * @m_since_latest
+             */
+            RevealageOutput = GenericGL3D::RevealageOutput
             #endif
         };
 
@@ -743,7 +976,143 @@ class MAGNUM_SHADERS_EXPORT PhongGL: public GL::AbstractShaderProgram {
              * specular highlights are not desired.
              * @m_since_latest
              */
-            NoSpecular = 1 << 16
+            NoSpecular = 1 << 16,
+
+            #ifndef MAGNUM_TARGET_GLES
+            /**
+             * Use bindless textures. Expects that @ref Flag::UniformBuffers
+             * is enabled as well and that the texture handles are supplied
+             * per material via @ref bindMaterialTextureBuffer() instead of
+             * binding the textures with @ref bindAmbientTexture(),
+             * @ref bindDiffuseTexture(), @ref bindSpecularTexture(),
+             * @ref bindNormalTexture() and @ref bindObjectIdTexture(). See
+             * @ref Shaders-PhongGL-bindless for more information.
+             * @requires_extension Extension @gl_extension{ARB,bindless_texture}
+             * @requires_gl Bindless textures are not available in OpenGL ES
+             *      or WebGL.
+             * @m_since_latest
+             */
+            BindlessTextures = 1 << 18,
+            #endif
+
+            #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+            /**
+             * Enable clustered light culling. Implies
+             * @ref Flag::UniformBuffers, lights are supplied in a shader
+             * storage buffer bound with @ref bindLightBuffer() and each
+             * fragment evaluates only the lights assigned to its cluster by
+             * @ref LightClusterGL, taken from buffers bound with
+             * @ref bindLightClusterBuffer(),
+             * @ref bindClusterLightRangeBuffer() and
+             * @ref bindClusterLightIndexBuffer(). Mutually exclusive with
+             * @ref Flag::LightCulling. See @ref Shaders-PhongGL-light-clusters
+             * for more information.
+             * @requires_gl43 Extension @gl_extension{ARB,shader_storage_buffer_object}
+             * @requires_gles31 Shader storage buffers are not available in
+             *      OpenGL ES 3.0 and older. Additionally, fragment shader
+             *      storage blocks are optional in OpenGL ES 3.1.
+             * @requires_gles Shader storage buffers are not available in
+             *      WebGL.
+             * @m_since_latest
+             */
+            LightClusters = UniformBuffers|(1 << 19),
+            #endif
+
+            #ifndef MAGNUM_TARGET_GLES2
+            /**
+             * Dynamic per-vertex joint count for skinning. Uses only the
+             * first @cpp M @ce / @cpp N @ce primary / secondary components
+             * defined by @ref setPerVertexJointCount() instead of all
+             * primary / secondary components defined by
+             * @ref Configuration::setJointCount() at shader compilation time.
+             * Useful in order to avoid having a shader permutation defined
+             * for every possible joint count, at the cost of a branch in the
+             * vertex shader. See @ref Shaders-PhongGL-skinning for more
+             * information.
+             * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+             * @requires_gles30 Skinning requires integer support in shaders,
+             *      which is not available in OpenGL ES 2.0.
+             * @requires_webgl20 Skinning requires integer support in shaders,
+             *      which is not available in WebGL 1.0.
+             * @m_since_latest
+             */
+            DynamicPerVertexJointCount = 1 << 20,
+
+            /**
+             * Weighted blended order-independent transparency. Instead of the
+             * final color, @ref ColorOutput contains a premultiplied color
+             * scaled by a depth- and alpha-dependent weight, meant to be
+             * accumulated in a floating-point attachment, and
+             * @ref RevealageOutput the alpha, meant to be multiplied
+             * together. The result is then composited with
+             * @ref TransparencyResolveGL. See @ref Shaders-PhongGL-oit for
+             * more information.
+             * @requires_gl30 Extension @gl_extension{ARB,texture_float}
+             * @requires_gles30 Order-independent transparency requires
+             *      floating-point render targets, which are not available in
+             *      OpenGL ES 2.0.
+             * @requires_webgl20 Order-independent transparency requires
+             *      floating-point render targets, which are not available in
+             *      WebGL 1.0.
+             * @m_since_latest
+             */
+            OrderIndependentTransparency = 1 << 21,
+            #endif
+
+            /**
+             * Depth-only rendering. Keeps the vertex stage including
+             * instancing, multidraw and skinning, but the fragment stage
+             * doesn't calculate any lighting and doesn't write any color
+             * output. If @ref Flag::AlphaMask is enabled, fragments with
+             * the ambient and diffuse alpha below @ref setAlphaMask() are
+             * discarded, otherwise the fragment stage is empty. Mutually
+             * exclusive with @ref Flag::ObjectId and
+             * @ref Flag::OrderIndependentTransparency. See
+             * @ref Shaders-PhongGL-depth-prepass for more information.
+             * @m_since_latest
+             */
+            DepthOnly = 1 << 22,
+
+            #ifndef MAGNUM_TARGET_GLES2
+            /**
+             * Cascaded shadow maps. Implies @ref Flag::UniformBuffers, the
+             * light at @ref ShadowCascadeUniform::lightIndex is attenuated by
+             * a percentage-closer filtered lookup into a depth texture array
+             * bound with @ref bindShadowTexture(), with cascade parameters
+             * supplied via @ref bindShadowBuffer(). Expects a non-zero
+             * @ref lightCount(). See @ref Shaders-PhongGL-shadows for more
+             * information.
+             * @requires_gl30 Extension @gl_extension{EXT,texture_array}
+             * @requires_gles30 Neither texture arrays nor uniform buffers are
+             *      available in OpenGL ES 2.0.
+             * @requires_webgl20 Neither texture arrays nor uniform buffers are
+             *      available in WebGL 1.0.
+             * @m_since_latest
+             */
+            ShadowMaps = UniformBuffers|(1 << 23),
+            #endif
+
+            #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+            /**
+             * Fetch positions, normals, texture coordinates and vertex colors
+             * from shader storage buffers bound with
+             * @ref bindPositionStorageBuffer(),
+             * @ref bindNormalStorageBuffer(),
+             * @ref bindTextureCoordinatesStorageBuffer() and
+             * @ref bindColorStorageBuffer() instead of vertex attributes,
+             * with per-draw offsets supplied via
+             * @ref bindVertexPullingBuffer(). Implies
+             * @ref Flag::UniformBuffers. See
+             * @ref Shaders-PhongGL-vertex-pulling for more information.
+             * @requires_gl43 Extension @gl_extension{ARB,shader_storage_buffer_object}
+             * @requires_gles31 Shader storage buffers are not available in
+             *      OpenGL ES 3.0 and older.
+             * @requires_gles Shader storage buffers are not available in
+             *      WebGL.
+             * @m_since_latest
+             */
+            VertexPulling = UniformBuffers|(1 << 24)
+            #endif
         };
 
         /**
@@ -753,6 +1122,49 @@ class MAGNUM_SHADERS_EXPORT PhongGL: public GL::AbstractShaderProgram {
          */
         typedef Containers::EnumSet<Flag> Flags;
 
+        class Configuration;
+        class CompileState;
+
+        /**
+         * @brief Compile asynchronously
+         * @m_since_latest
+         *
+         * Compared to @ref PhongGL(Flags, UnsignedInt) can perform an
+         * asynchronous compilation and linking. See @ref shaders-async for
+         * more information.
+         * @see @ref PhongGL(CompileState&&),
+         *      @ref compile(Flags, UnsignedInt, UnsignedInt, UnsignedInt),
+         *      @ref compile(const Configuration&)
+         */
+        static CompileState compile(Flags flags = {}, UnsignedInt lightCount = 1);
+
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Compile for a multi-draw scenario asynchronously
+         * @m_since_latest
+         *
+         * Compared to @ref PhongGL(Flags, UnsignedInt, UnsignedInt, UnsignedInt)
+         * can perform an asynchronous compilation and linking. See
+         * @ref shaders-async for more information.
+         * @see @ref PhongGL(CompileState&&), @ref compile(Flags, UnsignedInt)
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        static CompileState compile(Flags flags, UnsignedInt lightCount, UnsignedInt materialCount, UnsignedInt drawCount);
+        #endif
+
+        /**
+         * @brief Compile with a configuration asynchronously
+         * @m_since_latest
+         *
+         * Compared to @ref PhongGL(const Configuration&) can perform an
+         * asynchronous compilation and linking. See @ref shaders-async for
+         * more information.
+         * @see @ref PhongGL(CompileState&&)
+         */
+        static CompileState compile(const Configuration& configuration);
+
         /**
          * @brief Constructor
          * @param flags         Flags
@@ -762,6 +1174,7 @@ class MAGNUM_SHADERS_EXPORT PhongGL: public GL::AbstractShaderProgram {
          * scenario (without @ref Flag::UniformBuffers set), it's equivalent to
          * @ref PhongGL(Flags, UnsignedInt, UnsignedInt, UnsignedInt) with
          * @p materialCount and @p drawCount set to @cpp 1 @ce.
+         * @see @ref PhongGL(const Configuration&)
          */
         explicit PhongGL(Flags flags = {}, UnsignedInt lightCount = 1);
 
@@ -794,19 +1207,34 @@ class MAGNUM_SHADERS_EXPORT PhongGL: public GL::AbstractShaderProgram {
          * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
          * @requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
          * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         * @see @ref PhongGL(const Configuration&)
          */
-        /** @todo this constructor will eventually need to have also joint
-            count, per-vertex weight count, view count for multiview and clip
-            plane count ... and putting them in arbitrary order next to each
-            other is too error-prone, so it needs some other solution
-            (accepting pairs of parameter type and value like in GL context
-            creation, e.g., which will probably need a new enum as reusing Flag
-            for this might be too confusing); what if some parameters won't be
-            (unsigned) integers? like a string with shader extensions? make a
-            whole Configuration class? */
         explicit PhongGL(Flags flags, UnsignedInt lightCount, UnsignedInt materialCount, UnsignedInt drawCount);
         #endif
 
+        /**
+         * @brief Construct with a configuration
+         * @m_since_latest
+         *
+         * A superset of @ref PhongGL(Flags, UnsignedInt, UnsignedInt, UnsignedInt),
+         * additionally allowing to enable skinning via
+         * @ref Configuration::setJointCount(). New compile-time options are
+         * exposed only through the @ref Configuration class instead of
+         * growing the list of positional arguments.
+         * @see @ref compile(const Configuration&)
+         */
+        explicit PhongGL(const Configuration& configuration);
+
+        /**
+         * @brief Finalize an asynchronous compilation
+         * @m_since_latest
+         *
+         * Takes an asynchronous compilation state returned by @ref compile()
+         * and forms a ready-to-use shader object. See @ref shaders-async for
+         * more information.
+         */
+        explicit PhongGL(CompileState&& state);
+
         /**
          * @brief Construct without creating the underlying OpenGL object
          *
@@ -870,6 +1298,74 @@ class MAGNUM_SHADERS_EXPORT PhongGL: public GL::AbstractShaderProgram {
          * @requires_webgl20 Not defined on WebGL 1.0 builds.
          */
         UnsignedInt drawCount() const { return _drawCount; }
+
+        /**
+         * @brief Joint count
+         * @m_since_latest
+         *
+         * If @ref Flag::UniformBuffers is not set, this is the number of joint
+         * matrices accepted by @ref setJointMatrices() / @ref setJointMatrix().
+         * If @ref Flag::UniformBuffers is set, this is the statically defined
+         * size of the @ref TransformationUniform3D uniform buffer bound with
+         * @ref bindJointBuffer(). If @cpp 0 @ce, skinning is disabled.
+         * @see @ref Configuration::setJointCount()
+         * @requires_gles30 Not defined on OpenGL ES 2.0 builds.
+         * @requires_webgl20 Not defined on WebGL 1.0 builds.
+         */
+        UnsignedInt jointCount() const { return _jointCount; }
+
+        /**
+         * @brief Count of joints affecting a single vertex
+         * @m_since_latest
+         *
+         * If @ref Flag::DynamicPerVertexJointCount is set, the count can be
+         * additionally modified per-draw using
+         * @ref setPerVertexJointCount().
+         * @see @ref Configuration::setJointCount()
+         * @requires_gles30 Not defined on OpenGL ES 2.0 builds.
+         * @requires_webgl20 Not defined on WebGL 1.0 builds.
+         */
+        UnsignedInt perVertexJointCount() const { return _perVertexJointCount; }
+
+        /**
+         * @brief Count of secondary joints affecting a single vertex
+         * @m_since_latest
+         *
+         * If @ref Flag::DynamicPerVertexJointCount is set, the count can be
+         * additionally modified per-draw using
+         * @ref setPerVertexJointCount().
+         * @see @ref Configuration::setJointCount()
+         * @requires_gles30 Not defined on OpenGL ES 2.0 builds.
+         * @requires_webgl20 Not defined on WebGL 1.0 builds.
+         */
+        UnsignedInt secondaryPerVertexJointCount() const { return _secondaryPerVertexJointCount; }
+
+        /**
+         * @brief Set dynamic per-vertex skinning joint count
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Allows reducing the count of iterated joints for a particular draw
+         * call, making it possible to use a single shader with meshes that
+         * contain different count of per-vertex joints. See
+         * @ref Flag::DynamicPerVertexJointCount for more information. As the
+         * joint count is tied to the mesh layout, this is a per-draw-call
+         * setting even in case of @ref Flag::UniformBuffers instead of being
+         * a value in @ref PhongDrawUniform. Initial value is the same as
+         * @ref perVertexJointCount() and
+         * @ref secondaryPerVertexJointCount().
+         *
+         * Expects that @ref Flag::DynamicPerVertexJointCount is set,
+         * @p count is not larger than @ref perVertexJointCount() and
+         * @p secondaryCount not larger than
+         * @ref secondaryPerVertexJointCount().
+         * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+         * @requires_gles30 Skinning requires integer support in shaders,
+         *      which is not available in OpenGL ES 2.0.
+         * @requires_webgl20 Skinning requires integer support in shaders,
+         *      which is not available in WebGL 1.0.
+         */
+        PhongGL& setPerVertexJointCount(UnsignedInt count, UnsignedInt secondaryCount = 0);
         #endif
 
         /** @{
@@ -1337,6 +1833,53 @@ class MAGNUM_SHADERS_EXPORT PhongGL: public GL::AbstractShaderProgram {
          */
         PhongGL& setLightRange(UnsignedInt id, Float range);
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Set joint matrices
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Initial values are identity transformations. Expects that the size
+         * of the @p matrices array is not larger than @ref jointCount().
+         *
+         * Expects that @ref Flag::UniformBuffers is not set, in that case fill
+         * @ref TransformationUniform3D::transformationMatrix and call
+         * @ref bindJointBuffer() instead.
+         * @see @ref Shaders-PhongGL-skinning, @ref setJointMatrix()
+         * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+         * @requires_gles30 Skinning requires integer support in shaders,
+         *      which is not available in OpenGL ES 2.0.
+         * @requires_webgl20 Skinning requires integer support in shaders,
+         *      which is not available in WebGL 1.0.
+         */
+        PhongGL& setJointMatrices(Containers::ArrayView<const Matrix4> matrices);
+
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        PhongGL& setJointMatrices(std::initializer_list<Matrix4> matrices);
+
+        /**
+         * @brief Set joint matrix for given joint
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Unlike @ref setJointMatrices() updates just a single joint matrix.
+         * Expects that @p id is less than @ref jointCount().
+         *
+         * Expects that @ref Flag::UniformBuffers is not set, in that case fill
+         * @ref TransformationUniform3D::transformationMatrix and call
+         * @ref bindJointBuffer() instead.
+         * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+         * @requires_gles30 Skinning requires integer support in shaders,
+         *      which is not available in OpenGL ES 2.0.
+         * @requires_webgl20 Skinning requires integer support in shaders,
+         *      which is not available in WebGL 1.0.
+         */
+        PhongGL& setJointMatrix(UnsignedInt id, const Matrix4& matrix);
+        #endif
+
         /**
          * @}
          */
@@ -1476,6 +2019,28 @@ class MAGNUM_SHADERS_EXPORT PhongGL: public GL::AbstractShaderProgram {
          */
         PhongGL& bindMaterialBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
 
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Set a material texture uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::BindlessTextures is set. The buffer is
+         * expected to contain @ref materialCount() instances of
+         * @ref PhongMaterialTextureUniform with handles of resident
+         * textures. See @ref Shaders-PhongGL-bindless for more information.
+         * @requires_extension Extension @gl_extension{ARB,bindless_texture}
+         * @requires_gl Bindless textures are not available in OpenGL ES or
+         *      WebGL.
+         */
+        PhongGL& bindMaterialTextureBuffer(GL::Buffer& buffer);
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        PhongGL& bindMaterialTextureBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+        #endif
+
         /**
          * @brief Set a light uniform buffer
          * @return Reference to self (for method chaining)
@@ -1483,7 +2048,9 @@ class MAGNUM_SHADERS_EXPORT PhongGL: public GL::AbstractShaderProgram {
          *
          * Expects that @ref Flag::UniformBuffers is set. The buffer is
          * expected to contain @ref lightCount() instances of
-         * @ref PhongLightUniform.
+         * @ref PhongLightUniform. If @ref Flag::LightClusters is set, the
+         * buffer is bound as a shader storage buffer instead of a uniform
+         * buffer.
          * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
          * @requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
          * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
@@ -1495,6 +2062,215 @@ class MAGNUM_SHADERS_EXPORT PhongGL: public GL::AbstractShaderProgram {
          */
         PhongGL& bindLightBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
 
+        /**
+         * @brief Set a joint matrix uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::UniformBuffers is set. The buffer is
+         * expected to contain @ref jointCount() instances of
+         * @ref TransformationUniform3D. Which range of the buffer is used for
+         * a particular draw is controlled by @ref PhongDrawUniform::jointOffset.
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        PhongGL& bindJointBuffer(GL::Buffer& buffer);
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        PhongGL& bindJointBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        #ifndef MAGNUM_TARGET_WEBGL
+        /**
+         * @brief Set a light cluster uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::LightClusters is set. The buffer is
+         * expected to contain a single @ref LightClusterUniform, usually the
+         * same that's used by @ref LightClusterGL::bindLightClusterBuffer().
+         * @requires_gl43 Extension @gl_extension{ARB,shader_storage_buffer_object}
+         * @requires_gles31 Shader storage buffers are not available in
+         *      OpenGL ES 3.0 and older.
+         * @requires_gles Shader storage buffers are not available in WebGL.
+         */
+        PhongGL& bindLightClusterBuffer(GL::Buffer& buffer);
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        PhongGL& bindLightClusterBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Set a cluster light range storage buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::LightClusters is set. The buffer is
+         * expected to be filled by
+         * @ref LightClusterGL::bindClusterLightRangeBuffer().
+         * @requires_gl43 Extension @gl_extension{ARB,shader_storage_buffer_object}
+         * @requires_gles31 Shader storage buffers are not available in
+         *      OpenGL ES 3.0 and older.
+         * @requires_gles Shader storage buffers are not available in WebGL.
+         */
+        PhongGL& bindClusterLightRangeBuffer(GL::Buffer& buffer);
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        PhongGL& bindClusterLightRangeBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Set a cluster light index storage buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::LightClusters is set. The buffer is
+         * expected to be filled by
+         * @ref LightClusterGL::bindClusterLightIndexBuffer().
+         * @requires_gl43 Extension @gl_extension{ARB,shader_storage_buffer_object}
+         * @requires_gles31 Shader storage buffers are not available in
+         *      OpenGL ES 3.0 and older.
+         * @requires_gles Shader storage buffers are not available in WebGL.
+         */
+        PhongGL& bindClusterLightIndexBuffer(GL::Buffer& buffer);
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        PhongGL& bindClusterLightIndexBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+        #endif
+
+        /**
+         * @brief Set a shadow uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::ShadowMaps is set. The buffer is expected
+         * to contain a single @ref ShadowCascadeUniform, shared by all draws.
+         * See @ref Shaders-PhongGL-shadows for more information.
+         * @see @ref bindShadowTexture()
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        PhongGL& bindShadowBuffer(GL::Buffer& buffer);
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        PhongGL& bindShadowBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        #ifndef MAGNUM_TARGET_WEBGL
+        /**
+         * @brief Set a vertex pulling uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::VertexPulling is set. The buffer is
+         * expected to contain @ref drawCount() instances of
+         * @ref VertexPullingUniform. See
+         * @ref Shaders-PhongGL-vertex-pulling for more information.
+         * @requires_gl43 Extension @gl_extension{ARB,shader_storage_buffer_object}
+         * @requires_gles31 Shader storage buffers are not available in
+         *      OpenGL ES 3.0 and older.
+         * @requires_gles Shader storage buffers are not available in WebGL.
+         */
+        PhongGL& bindVertexPullingBuffer(GL::Buffer& buffer);
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        PhongGL& bindVertexPullingBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Set a position storage buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::VertexPulling is set. The buffer is
+         * expected to contain tightly packed @ref Vector3 positions, the
+         * first vertex of each draw given by
+         * @ref VertexPullingUniform::positionOffset.
+         * @requires_gl43 Extension @gl_extension{ARB,shader_storage_buffer_object}
+         * @requires_gles31 Shader storage buffers are not available in
+         *      OpenGL ES 3.0 and older.
+         * @requires_gles Shader storage buffers are not available in WebGL.
+         */
+        PhongGL& bindPositionStorageBuffer(GL::Buffer& buffer);
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        PhongGL& bindPositionStorageBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Set a normal storage buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::VertexPulling is set and
+         * @ref lightCount() is not zero. The buffer is expected to contain
+         * tightly packed @ref Vector3 normals, the first vertex of each draw
+         * given by @ref VertexPullingUniform::normalOffset.
+         * @requires_gl43 Extension @gl_extension{ARB,shader_storage_buffer_object}
+         * @requires_gles31 Shader storage buffers are not available in
+         *      OpenGL ES 3.0 and older.
+         * @requires_gles Shader storage buffers are not available in WebGL.
+         */
+        PhongGL& bindNormalStorageBuffer(GL::Buffer& buffer);
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        PhongGL& bindNormalStorageBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Set a texture coordinate storage buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::VertexPulling is set and the shader is
+         * textured. The buffer is expected to contain tightly packed
+         * @ref Vector2 texture coordinates, the first vertex of each draw
+         * given by @ref VertexPullingUniform::textureCoordinatesOffset.
+         * @requires_gl43 Extension @gl_extension{ARB,shader_storage_buffer_object}
+         * @requires_gles31 Shader storage buffers are not available in
+         *      OpenGL ES 3.0 and older.
+         * @requires_gles Shader storage buffers are not available in WebGL.
+         */
+        PhongGL& bindTextureCoordinatesStorageBuffer(GL::Buffer& buffer);
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        PhongGL& bindTextureCoordinatesStorageBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Set a vertex color storage buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that both @ref Flag::VertexPulling and
+         * @ref Flag::VertexColor is set. The buffer is expected to contain
+         * tightly packed @ref Color4 vertex colors, the first vertex of each
+         * draw given by @ref VertexPullingUniform::colorOffset.
+         * @requires_gl43 Extension @gl_extension{ARB,shader_storage_buffer_object}
+         * @requires_gles31 Shader storage buffers are not available in
+         *      OpenGL ES 3.0 and older.
+         * @requires_gles Shader storage buffers are not available in WebGL.
+         */
+        PhongGL& bindColorStorageBuffer(GL::Buffer& buffer);
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        PhongGL& bindColorStorageBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+        #endif
+
         /**
          * @}
          */
@@ -1684,6 +2460,23 @@ class MAGNUM_SHADERS_EXPORT PhongGL: public GL::AbstractShaderProgram {
          *      are not available in WebGL 1.0.
          */
         PhongGL& bindObjectIdTexture(GL::Texture2DArray& texture);
+
+        /**
+         * @brief Bind a shadow map texture
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that the shader was created with @ref Flag::ShadowMaps
+         * enabled. The texture is expected to have a depth format, a
+         * @ref GL::SamplerCompareMode::CompareRefToTexture comparison mode
+         * and a layer for each of @ref ShadowCascadeUniform::cascadeCount
+         * cascades. See @ref Shaders-PhongGL-shadows for more information.
+         * @see @ref bindShadowBuffer()
+         * @requires_gl30 Extension @gl_extension{EXT,texture_array}
+         * @requires_gles30 Texture arrays are not available in OpenGL ES 2.0.
+         * @requires_webgl20 Texture arrays are not available in WebGL 1.0.
+         */
+        PhongGL& bindShadowTexture(GL::Texture2DArray& texture);
         #endif
 
         /**
@@ -1744,6 +2537,10 @@ class MAGNUM_SHADERS_EXPORT PhongGL: public GL::AbstractShaderProgram {
         #endif
 
     private:
+        /* Creates the GL shader program object but does nothing else.
+           Internal, used by compile(). */
+        explicit PhongGL(NoInitT) {}
+
         /* Prevent accidentally calling irrelevant functions */
         #ifndef MAGNUM_TARGET_GLES
         using GL::AbstractShaderProgram::drawTransformFeedback;
@@ -1755,7 +2552,8 @@ class MAGNUM_SHADERS_EXPORT PhongGL: public GL::AbstractShaderProgram {
         Flags _flags;
         UnsignedInt _lightCount{};
         #ifndef MAGNUM_TARGET_GLES2
-        UnsignedInt _materialCount{}, _drawCount{};
+        UnsignedInt _materialCount{}, _drawCount{}, _jointCount{},
+            _perVertexJointCount{}, _secondaryPerVertexJointCount{};
         #endif
         Int _transformationMatrixUniform{0},
             _projectionMatrixUniform{1},
@@ -1778,12 +2576,194 @@ class MAGNUM_SHADERS_EXPORT PhongGL: public GL::AbstractShaderProgram {
             _lightSpecularColorsUniform, /* 12 + 2*lightCount */
             _lightRangesUniform; /* 12 + 3*lightCount */
         #ifndef MAGNUM_TARGET_GLES2
-        /* Used instead of all other uniforms when Flag::UniformBuffers is set,
-           so it can alias them */
+        Int _jointMatricesUniform, /* 12 + 4*lightCount */
+            _perVertexJointCountUniform; /* 12 + 4*lightCount + jointCount */
+        /* Used instead of all other uniforms except joints when
+           Flag::UniformBuffers is set, so it can alias them */
         Int _drawOffsetUniform{0};
         #endif
 };
 
+/**
+@brief Configuration
+@m_since_latest
+
+@see @ref PhongGL(const Configuration&), @ref compile(const Configuration&)
+*/
+class MAGNUM_SHADERS_EXPORT PhongGL::Configuration {
+    public:
+        explicit Configuration() = default;
+
+        /** @brief Flags */
+        Flags flags() const { return _flags; }
+
+        /**
+         * @brief Set flags
+         *
+         * No flags are set by default.
+         * @see @ref PhongGL::flags()
+         */
+        Configuration& setFlags(Flags flags) {
+            _flags = flags;
+            return *this;
+        }
+
+        /** @brief Light count */
+        UnsignedInt lightCount() const { return _lightCount; }
+
+        /**
+         * @brief Set light count
+         *
+         * If @ref Flag::UniformBuffers is set, describes size of a
+         * @ref PhongLightUniform buffer bound with
+         * @ref PhongGL::bindLightBuffer(). Default value is @cpp 1 @ce.
+         * @see @ref PhongGL::lightCount()
+         */
+        Configuration& setLightCount(UnsignedInt count) {
+            _lightCount = count;
+            return *this;
+        }
+
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Material count
+         *
+         * @requires_gles30 Not defined on OpenGL ES 2.0 builds.
+         * @requires_webgl20 Not defined on WebGL 1.0 builds.
+         */
+        UnsignedInt materialCount() const { return _materialCount; }
+
+        /**
+         * @brief Set material count
+         *
+         * If @ref Flag::UniformBuffers is set, describes size of a
+         * @ref PhongMaterialUniform buffer bound with
+         * @ref PhongGL::bindMaterialBuffer(), ignored otherwise. Default value
+         * is @cpp 1 @ce.
+         * @see @ref PhongGL::materialCount()
+         * @requires_gles30 Not defined on OpenGL ES 2.0 builds.
+         * @requires_webgl20 Not defined on WebGL 1.0 builds.
+         */
+        Configuration& setMaterialCount(UnsignedInt count) {
+            _materialCount = count;
+            return *this;
+        }
+
+        /**
+         * @brief Draw count
+         *
+         * @requires_gles30 Not defined on OpenGL ES 2.0 builds.
+         * @requires_webgl20 Not defined on WebGL 1.0 builds.
+         */
+        UnsignedInt drawCount() const { return _drawCount; }
+
+        /**
+         * @brief Set draw count
+         *
+         * If @ref Flag::UniformBuffers is set, describes size of a
+         * @ref ProjectionUniform3D / @ref TransformationUniform3D /
+         * @ref PhongDrawUniform / @ref TextureTransformationUniform buffer
+         * bound with @ref PhongGL::bindProjectionBuffer(),
+         * @ref PhongGL::bindTransformationBuffer(),
+         * @ref PhongGL::bindDrawBuffer() and
+         * @ref PhongGL::bindTextureTransformationBuffer(), ignored
+         * otherwise. Default value is @cpp 1 @ce.
+         * @see @ref PhongGL::drawCount()
+         * @requires_gles30 Not defined on OpenGL ES 2.0 builds.
+         * @requires_webgl20 Not defined on WebGL 1.0 builds.
+         */
+        Configuration& setDrawCount(UnsignedInt count) {
+            _drawCount = count;
+            return *this;
+        }
+
+        /**
+         * @brief Joint count
+         *
+         * @requires_gles30 Not defined on OpenGL ES 2.0 builds.
+         * @requires_webgl20 Not defined on WebGL 1.0 builds.
+         */
+        UnsignedInt jointCount() const { return _jointCount; }
+
+        /**
+         * @brief Per-vertex joint count
+         *
+         * @requires_gles30 Not defined on OpenGL ES 2.0 builds.
+         * @requires_webgl20 Not defined on WebGL 1.0 builds.
+         */
+        UnsignedInt perVertexJointCount() const { return _perVertexJointCount; }
+
+        /**
+         * @brief Secondary per-vertex joint count
+         *
+         * @requires_gles30 Not defined on OpenGL ES 2.0 builds.
+         * @requires_webgl20 Not defined on WebGL 1.0 builds.
+         */
+        UnsignedInt secondaryPerVertexJointCount() const { return _secondaryPerVertexJointCount; }
+
+        /**
+         * @brief Set joint count
+         *
+         * If @ref Flag::UniformBuffers isn't set, @p count describes an upper
+         * bound on how many joint matrices get supplied to each draw with
+         * @ref PhongGL::setJointMatrices() / @ref PhongGL::setJointMatrix().
+         * If @ref Flag::UniformBuffers is set, @p count describes size of a
+         * @ref TransformationUniform3D buffer bound with
+         * @ref PhongGL::bindJointBuffer().
+         *
+         * The @p perVertexCount and @p secondaryPerVertexCount parameters
+         * describe how many components are taken from @ref JointIds /
+         * @ref Weights and @ref SecondaryJointIds / @ref SecondaryWeights
+         * attributes. Both values are expected to not be larger than
+         * @cpp 4 @ce, setting either of these to @cpp 0 @ce means given
+         * attribute is not used at all. If both are @cpp 0 @ce, skinning is
+         * not performed. Unless @ref Flag::DynamicPerVertexJointCount is set,
+         * the shader always iterates through all components, which is
+         * faster than a dynamic loop bound if the counts are known upfront.
+         *
+         * Expects that either both @p count and the per-vertex counts are
+         * zero or both are non-zero. Default value for all three is
+         * @cpp 0 @ce.
+         * @see @ref PhongGL::jointCount(),
+         *      @ref PhongGL::perVertexJointCount(),
+         *      @ref PhongGL::secondaryPerVertexJointCount()
+         * @requires_gles30 Not defined on OpenGL ES 2.0 builds.
+         * @requires_webgl20 Not defined on WebGL 1.0 builds.
+         */
+        Configuration& setJointCount(UnsignedInt count, UnsignedInt perVertexCount, UnsignedInt secondaryPerVertexCount = 0);
+        #endif
+
+    private:
+        Flags _flags;
+        UnsignedInt _lightCount = 1;
+        #ifndef MAGNUM_TARGET_GLES2
+        UnsignedInt _materialCount = 1;
+        UnsignedInt _drawCount = 1;
+        UnsignedInt _jointCount = 0;
+        UnsignedInt _perVertexJointCount = 0;
+        UnsignedInt _secondaryPerVertexJointCount = 0;
+        #endif
+};
+
+/**
+@brief Asynchronous compilation state
+@m_since_latest
+
+Returned by @ref compile(). See @ref shaders-async for more information.
+*/
+class PhongGL::CompileState: public PhongGL {
+    /* Everything deliberately private except for the inheritance */
+    friend class PhongGL;
+
+    explicit CompileState(NoCreateT): PhongGL{NoCreate}, _vert{NoCreate}, _frag{NoCreate} {}
+
+    explicit CompileState(PhongGL&& shader, GL::Shader&& vert, GL::Shader&& frag, GL::Version version, bool cached): PhongGL{std::move(shader)}, _vert{std::move(vert)}, _frag{std::move(frag)}, _version{version}, _cached{cached} {}
+
+    GL::Shader _vert, _frag;
+    GL::Version _version;
+    bool _cached;
+};
+
 /** @debugoperatorclassenum{PhongGL,PhongGL::Flag} */
 MAGNUM_SHADERS_EXPORT Debug& operator<<(Debug& debug, PhongGL::Flag value);
 
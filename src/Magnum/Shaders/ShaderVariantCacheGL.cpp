@@ -0,0 +1,408 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ShaderVariantCacheGL.h"
+
+#include <chrono>
+#include <sstream>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/StringStl.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/FormatStl.h>
+
+namespace Magnum { namespace Shaders {
+
+namespace {
+
+UnsignedLong now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/* Used in the serialization format, keep in sync with ShaderType */
+constexpr const char* ShaderTypeNames[]{
+    "FlatGL2D",
+    "FlatGL3D",
+    "PhongGL"
+};
+
+template<UnsignedInt dimensions> typename FlatGL<dimensions>::Configuration flatConfiguration(const ShaderVariantCacheGL::Variant& variant) {
+    typename FlatGL<dimensions>::Configuration configuration;
+    configuration.setFlags(typename FlatGL<dimensions>::Flag(variant.flags()));
+    #ifndef MAGNUM_TARGET_GLES2
+    configuration
+        .setMaterialCount(variant.materialCount())
+        .setDrawCount(variant.drawCount())
+        .setJointCount(variant.jointCount(), variant.perVertexJointCount(), variant.secondaryPerVertexJointCount());
+    #endif
+    return configuration;
+}
+
+PhongGL::Configuration phongConfiguration(const ShaderVariantCacheGL::Variant& variant) {
+    PhongGL::Configuration configuration;
+    configuration
+        .setFlags(PhongGL::Flag(variant.flags()))
+        .setLightCount(variant.lightCount());
+    #ifndef MAGNUM_TARGET_GLES2
+    configuration
+        .setMaterialCount(variant.materialCount())
+        .setDrawCount(variant.drawCount())
+        .setJointCount(variant.jointCount(), variant.perVertexJointCount(), variant.secondaryPerVertexJointCount());
+    #endif
+    return configuration;
+}
+
+}
+
+ShaderVariantCacheGL::Variant::Variant(const ShaderType shaderType) noexcept: _shaderType{shaderType}, _flags{}, _lightCount{}, _materialCount{}, _drawCount{}, _jointCount{}, _perVertexJointCount{}, _secondaryPerVertexJointCount{}, _requestCount{}, _compileTime{} {}
+
+ShaderVariantCacheGL::ShaderVariantCacheGL() = default;
+
+ShaderVariantCacheGL::ShaderVariantCacheGL(ShaderVariantCacheGL&&) noexcept = default;
+
+ShaderVariantCacheGL::~ShaderVariantCacheGL() = default;
+
+ShaderVariantCacheGL& ShaderVariantCacheGL::operator=(ShaderVariantCacheGL&&) noexcept = default;
+
+std::size_t ShaderVariantCacheGL::compiledVariantCount() const {
+    std::size_t count = 0;
+    for(const Variant& variant: _variants)
+        if(variant._shader) ++count;
+    return count;
+}
+
+const ShaderVariantCacheGL::Variant& ShaderVariantCacheGL::variant(const std::size_t id) const {
+    CORRADE_ASSERT(id < _variants.size(),
+        "Shaders::ShaderVariantCacheGL::variant(): index" << id << "out of range for" << _variants.size() << "variants", _variants[0]);
+    return _variants[id];
+}
+
+UnsignedLong ShaderVariantCacheGL::compileTime() const {
+    UnsignedLong time = 0;
+    for(const Variant& variant: _variants)
+        time += variant._compileTime;
+    return time;
+}
+
+template<UnsignedInt dimensions> ShaderVariantCacheGL::Variant ShaderVariantCacheGL::flatVariant(const ShaderType type, const typename FlatGL<dimensions>::Configuration& configuration) {
+    Variant variant{type};
+    variant._flags = UnsignedShort(configuration.flags());
+    #ifndef MAGNUM_TARGET_GLES2
+    /* Material and draw count is ignored without uniform buffers, don't let
+       it produce distinct variants */
+    if(configuration.flags() >= FlatGL<dimensions>::Flag::UniformBuffers) {
+        variant._materialCount = configuration.materialCount();
+        variant._drawCount = configuration.drawCount();
+    }
+    variant._jointCount = configuration.jointCount();
+    variant._perVertexJointCount = configuration.perVertexJointCount();
+    variant._secondaryPerVertexJointCount = configuration.secondaryPerVertexJointCount();
+    #endif
+    return variant;
+}
+
+ShaderVariantCacheGL::Variant ShaderVariantCacheGL::phongVariant(const PhongGL::Configuration& configuration) {
+    Variant variant{ShaderType::Phong};
+    variant._flags = UnsignedInt(configuration.flags());
+    variant._lightCount = configuration.lightCount();
+    #ifndef MAGNUM_TARGET_GLES2
+    if(configuration.flags() >= PhongGL::Flag::UniformBuffers) {
+        variant._materialCount = configuration.materialCount();
+        variant._drawCount = configuration.drawCount();
+    }
+    variant._jointCount = configuration.jointCount();
+    variant._perVertexJointCount = configuration.perVertexJointCount();
+    variant._secondaryPerVertexJointCount = configuration.secondaryPerVertexJointCount();
+    #endif
+    return variant;
+}
+
+std::size_t ShaderVariantCacheGL::findOrAdd(Variant&& variant) {
+    /* Linear search is fine, even heavy permutation explosions are in the
+       order of hundreds of variants and a lookup is way cheaper than a
+       compilation */
+    for(std::size_t i = 0; i != _variants.size(); ++i) {
+        const Variant& other = _variants[i];
+        if(other._shaderType == variant._shaderType &&
+           other._flags == variant._flags &&
+           other._lightCount == variant._lightCount &&
+           other._materialCount == variant._materialCount &&
+           other._drawCount == variant._drawCount &&
+           other._jointCount == variant._jointCount &&
+           other._perVertexJointCount == variant._perVertexJointCount &&
+           other._secondaryPerVertexJointCount == variant._secondaryPerVertexJointCount)
+            return i;
+    }
+
+    arrayAppend(_variants, std::move(variant));
+    return _variants.size() - 1;
+}
+
+void ShaderVariantCacheGL::compile(const std::size_t id) {
+    Variant& variant = _variants[id];
+    const UnsignedLong start = now();
+    switch(variant._shaderType) {
+        case ShaderType::Flat2D:
+            variant._shader = Containers::Pointer<GL::AbstractShaderProgram>{new FlatGL2D{flatConfiguration<2>(variant)}};
+            break;
+        case ShaderType::Flat3D:
+            variant._shader = Containers::Pointer<GL::AbstractShaderProgram>{new FlatGL3D{flatConfiguration<3>(variant)}};
+            break;
+        case ShaderType::Phong:
+            variant._shader = Containers::Pointer<GL::AbstractShaderProgram>{new PhongGL{phongConfiguration(variant)}};
+            break;
+    }
+    variant._compileTime = now() - start;
+}
+
+FlatGL2D& ShaderVariantCacheGL::flat2D(const FlatGL2D::Configuration& configuration) {
+    const std::size_t id = findOrAdd(flatVariant<2>(ShaderType::Flat2D, configuration));
+    if(!_variants[id]._shader) compile(id);
+    ++_variants[id]._requestCount;
+    return static_cast<FlatGL2D&>(*_variants[id]._shader);
+}
+
+FlatGL3D& ShaderVariantCacheGL::flat3D(const FlatGL3D::Configuration& configuration) {
+    const std::size_t id = findOrAdd(flatVariant<3>(ShaderType::Flat3D, configuration));
+    if(!_variants[id]._shader) compile(id);
+    ++_variants[id]._requestCount;
+    return static_cast<FlatGL3D&>(*_variants[id]._shader);
+}
+
+PhongGL& ShaderVariantCacheGL::phong(const PhongGL::Configuration& configuration) {
+    const std::size_t id = findOrAdd(phongVariant(configuration));
+    if(!_variants[id]._shader) compile(id);
+    ++_variants[id]._requestCount;
+    return static_cast<PhongGL&>(*_variants[id]._shader);
+}
+
+ShaderVariantCacheGL& ShaderVariantCacheGL::addFlat2D(const FlatGL2D::Configuration& configuration) {
+    findOrAdd(flatVariant<2>(ShaderType::Flat2D, configuration));
+    return *this;
+}
+
+ShaderVariantCacheGL& ShaderVariantCacheGL::addFlat3D(const FlatGL3D::Configuration& configuration) {
+    findOrAdd(flatVariant<3>(ShaderType::Flat3D, configuration));
+    return *this;
+}
+
+ShaderVariantCacheGL& ShaderVariantCacheGL::addPhong(const PhongGL::Configuration& configuration) {
+    findOrAdd(phongVariant(configuration));
+    return *this;
+}
+
+ShaderVariantCacheGL& ShaderVariantCacheGL::precompile() {
+    /* Submit all compilations first so the driver can process them in
+       parallel, and only then wait for them. The compile states are kept
+       through a base pointer, they're all derived from the shader class. */
+    struct Pending {
+        std::size_t id;
+        UnsignedLong time;
+        Containers::Pointer<GL::AbstractShaderProgram> state;
+    };
+    Containers::Array<Pending> pending;
+    for(std::size_t i = 0; i != _variants.size(); ++i) {
+        const Variant& variant = _variants[i];
+        if(variant._shader) continue;
+
+        const UnsignedLong start = now();
+        Containers::Pointer<GL::AbstractShaderProgram> state;
+        switch(variant._shaderType) {
+            case ShaderType::Flat2D:
+                state = Containers::Pointer<GL::AbstractShaderProgram>{new FlatGL2D::CompileState{FlatGL2D::compile(flatConfiguration<2>(variant))}};
+                break;
+            case ShaderType::Flat3D:
+                state = Containers::Pointer<GL::AbstractShaderProgram>{new FlatGL3D::CompileState{FlatGL3D::compile(flatConfiguration<3>(variant))}};
+                break;
+            case ShaderType::Phong:
+                state = Containers::Pointer<GL::AbstractShaderProgram>{new PhongGL::CompileState{PhongGL::compile(phongConfiguration(variant))}};
+                break;
+        }
+        arrayAppend(pending, InPlaceInit, i, now() - start, std::move(state));
+    }
+
+    for(Pending& p: pending) {
+        Variant& variant = _variants[p.id];
+        const UnsignedLong start = now();
+        switch(variant._shaderType) {
+            case ShaderType::Flat2D:
+                variant._shader = Containers::Pointer<GL::AbstractShaderProgram>{new FlatGL2D{std::move(static_cast<FlatGL2D::CompileState&>(*p.state))}};
+                break;
+            case ShaderType::Flat3D:
+                variant._shader = Containers::Pointer<GL::AbstractShaderProgram>{new FlatGL3D{std::move(static_cast<FlatGL3D::CompileState&>(*p.state))}};
+                break;
+            case ShaderType::Phong:
+                variant._shader = Containers::Pointer<GL::AbstractShaderProgram>{new PhongGL{std::move(static_cast<PhongGL::CompileState&>(*p.state))}};
+                break;
+        }
+        variant._compileTime = p.time + now() - start;
+    }
+
+    return *this;
+}
+
+std::string ShaderVariantCacheGL::serialize() const {
+    std::string out =
+        "# Magnum::Shaders::ShaderVariantCacheGL\n"
+        "# type flags lightCount materialCount drawCount jointCount perVertexJointCount secondaryPerVertexJointCount\n";
+    for(const Variant& variant: _variants)
+        out += Utility::formatString("{} {:x} {} {} {} {} {} {}\n",
+            ShaderTypeNames[UnsignedInt(variant._shaderType)],
+            variant._flags,
+            variant._lightCount,
+            variant._materialCount,
+            variant._drawCount,
+            variant._jointCount,
+            variant._perVertexJointCount,
+            variant._secondaryPerVertexJointCount);
+    return out;
+}
+
+bool ShaderVariantCacheGL::deserialize(const Containers::StringView data) {
+    /* Parse everything first so the cache stays unchanged on error */
+    Containers::Array<Variant> variants;
+    std::istringstream in{std::string{data.data(), data.size()}};
+    std::string line;
+    for(std::size_t lineNumber = 1; std::getline(in, line); ++lineNumber) {
+        if(!line.empty() && line.back() == '\r') line.pop_back();
+        if(line.empty() || line[0] == '#') continue;
+
+        std::istringstream lineIn{line};
+        std::string type;
+        UnsignedInt flags, lightCount, materialCount, drawCount, jointCount, perVertexJointCount, secondaryPerVertexJointCount;
+        lineIn >> type >> std::hex >> flags >> std::dec >> lightCount >> materialCount >> drawCount >> jointCount >> perVertexJointCount >> secondaryPerVertexJointCount >> std::ws;
+        if(lineIn.fail() || !lineIn.eof()) {
+            Error{} << "Shaders::ShaderVariantCacheGL::deserialize(): invalid variant on line" << lineNumber;
+            return false;
+        }
+
+        ShaderType shaderType;
+        if(type == ShaderTypeNames[UnsignedInt(ShaderType::Flat2D)])
+            shaderType = ShaderType::Flat2D;
+        else if(type == ShaderTypeNames[UnsignedInt(ShaderType::Flat3D)])
+            shaderType = ShaderType::Flat3D;
+        else if(type == ShaderTypeNames[UnsignedInt(ShaderType::Phong)])
+            shaderType = ShaderType::Phong;
+        else {
+            Error{} << "Shaders::ShaderVariantCacheGL::deserialize(): unknown shader type" << type << "on line" << lineNumber;
+            return false;
+        }
+
+        /* Catch what would otherwise blow up on an assertion in
+           Configuration::setJointCount() only when compiling */
+        if(perVertexJointCount > 4 || secondaryPerVertexJointCount > 4 || !jointCount != (!perVertexJointCount && !secondaryPerVertexJointCount)) {
+            Error{} << "Shaders::ShaderVariantCacheGL::deserialize(): invalid joint count" << jointCount << Debug::nospace << "," << perVertexJointCount << Debug::nospace << "," << secondaryPerVertexJointCount << "on line" << lineNumber;
+            return false;
+        }
+
+        Variant parsed{shaderType};
+        parsed._flags = flags;
+        parsed._lightCount = lightCount;
+        parsed._materialCount = materialCount;
+        parsed._drawCount = drawCount;
+        parsed._jointCount = jointCount;
+        parsed._perVertexJointCount = perVertexJointCount;
+        parsed._secondaryPerVertexJointCount = secondaryPerVertexJointCount;
+
+        /* Go through the configuration to drop values that don't apply to
+           given shader type or target, so the result is the same as if the
+           variant was added directly */
+        switch(shaderType) {
+            case ShaderType::Flat2D:
+                arrayAppend(variants, flatVariant<2>(shaderType, flatConfiguration<2>(parsed)));
+                break;
+            case ShaderType::Flat3D:
+                arrayAppend(variants, flatVariant<3>(shaderType, flatConfiguration<3>(parsed)));
+                break;
+            case ShaderType::Phong:
+                arrayAppend(variants, phongVariant(phongConfiguration(parsed)));
+                break;
+        }
+    }
+
+    for(Variant& variant: variants)
+        findOrAdd(std::move(variant));
+    return true;
+}
+
+std::string ShaderVariantCacheGL::statistics() const {
+    std::ostringstream out;
+    Debug d{&out, Debug::Flag::NoNewlineAtTheEnd|Debug::Flag::DisableColors};
+    d << "Shader variants:" << _variants.size() << Debug::nospace << ","
+      << compiledVariantCount() << "compiled in"
+      << Utility::formatString("{:.2f}", compileTime()/1.0e6) << "ms";
+
+    for(const Variant& variant: _variants) {
+        d << Debug::newline << " " << ShaderTypeNames[UnsignedInt(variant._shaderType)];
+        switch(variant._shaderType) {
+            case ShaderType::Flat2D:
+                d << FlatGL2D::Flags{FlatGL2D::Flag(variant._flags)};
+                break;
+            case ShaderType::Flat3D:
+                d << FlatGL3D::Flags{FlatGL3D::Flag(variant._flags)};
+                break;
+            case ShaderType::Phong:
+                d << PhongGL::Flags{PhongGL::Flag(variant._flags)}
+                  << Debug::newline << "    Lights:" << variant._lightCount;
+                break;
+        }
+        #ifndef MAGNUM_TARGET_GLES2
+        if(variant._materialCount || variant._drawCount)
+            d << Debug::newline << "    Materials:" << variant._materialCount
+              << Debug::nospace << ", draws:" << variant._drawCount;
+        if(variant._jointCount)
+            d << Debug::newline << "    Joints:" << variant._jointCount
+              << Debug::nospace << ", per-vertex:" << variant._perVertexJointCount
+              << Debug::nospace << ", secondary per-vertex:"
+              << variant._secondaryPerVertexJointCount;
+        #endif
+        d << Debug::newline << "    Requests:" << variant._requestCount
+          << Debug::nospace << ",";
+        if(variant._shader)
+            d << "compiled in" << Utility::formatString("{:.2f}", variant._compileTime/1.0e6) << "ms";
+        else
+            d << "not compiled";
+    }
+
+    return out.str();
+}
+
+Debug& operator<<(Debug& debug, const ShaderVariantCacheGL::ShaderType value) {
+    debug << "Shaders::ShaderVariantCacheGL::ShaderType" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(v) case ShaderVariantCacheGL::ShaderType::v: return debug << "::" #v;
+        _c(Flat2D)
+        _c(Flat3D)
+        _c(Phong)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+}}
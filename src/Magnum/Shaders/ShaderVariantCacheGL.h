@@ -0,0 +1,373 @@
+#ifndef Magnum_Shaders_ShaderVariantCacheGL_h
+#define Magnum_Shaders_ShaderVariantCacheGL_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Shaders::ShaderVariantCacheGL, enum @ref Magnum::Shaders::ShaderVariantCacheGL::ShaderType
+ * @m_since_latest
+ */
+
+#include <string>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Shaders/FlatGL.h"
+#include "Magnum/Shaders/PhongGL.h"
+
+namespace Magnum { namespace Shaders {
+
+/**
+@brief Shader variant cache
+@m_since_latest
+
+Each combination of flags, light count, material count, draw count and joint
+count of @ref FlatGL or @ref PhongGL results in a distinct shader program
+that's compiled and linked when constructed. This class keeps track of the
+variants an application requests, shares a single instance among all users of
+the same variant, measures how long each took to compile and makes it
+possible to compile all of them upfront instead of in the middle of the
+first frames.
+
+@section Shaders-ShaderVariantCacheGL-usage Usage
+
+Instead of constructing the shaders directly, request them through
+@ref flat2D(), @ref flat3D() or @ref phong(). The first request compiles the
+variant, subsequent requests with the same configuration return the same
+instance:
+
+@snippet MagnumShaders-gl.cpp ShaderVariantCacheGL-usage
+
+At the end of a representative run, save the list of requested variants with
+@ref serialize(). On the next startup, or in a build step that populates the
+@ref GL-AbstractShaderProgram-binary-cache "program binary cache", load the
+list with @ref deserialize() and compile everything with @ref precompile(),
+which submits all variants for compilation first and only then waits for the
+results, allowing drivers with parallel shader compilation to process them
+all at once:
+
+@snippet MagnumShaders-gl.cpp ShaderVariantCacheGL-precompile
+
+The @ref statistics() function then lists all variants together with their
+request counts and compilation times.
+
+@section Shaders-ShaderVariantCacheGL-format Serialization format
+
+The serialized list is a plain text with one variant per line. Each line
+contains a shader type name, flags as a hexadecimal number, light count,
+material count, draw count, joint count, per-vertex joint count and
+secondary per-vertex joint count, separated by spaces. Counts that don't apply
+to given shader type are zero. Lines starting with @cb{.ini} # @ce are
+comments and empty lines are ignored. The format may change in future
+versions, so it's not meant to be written by hand.
+*/
+class MAGNUM_SHADERS_EXPORT ShaderVariantCacheGL {
+    public:
+        /**
+         * @brief Shader type
+         *
+         * @see @ref Variant::shaderType()
+         */
+        enum class ShaderType: UnsignedByte {
+            Flat2D,     /**< @ref FlatGL2D */
+            Flat3D,     /**< @ref FlatGL3D */
+            Phong       /**< @ref PhongGL */
+        };
+
+        class Variant;
+
+        /**
+         * @brief Constructor
+         *
+         * Doesn't compile anything and can be constructed without a GL
+         * context being active.
+         */
+        explicit ShaderVariantCacheGL();
+
+        /** @brief Copying is not allowed */
+        ShaderVariantCacheGL(const ShaderVariantCacheGL&) = delete;
+
+        /** @brief Move constructor */
+        ShaderVariantCacheGL(ShaderVariantCacheGL&&) noexcept;
+
+        ~ShaderVariantCacheGL();
+
+        /** @brief Copying is not allowed */
+        ShaderVariantCacheGL& operator=(const ShaderVariantCacheGL&) = delete;
+
+        /** @brief Move assignment */
+        ShaderVariantCacheGL& operator=(ShaderVariantCacheGL&&) noexcept;
+
+        /**
+         * @brief Variant count
+         *
+         * Count of all variants that were either requested or added,
+         * including ones that weren't compiled yet.
+         * @see @ref compiledVariantCount()
+         */
+        std::size_t variantCount() const { return _variants.size(); }
+
+        /** @brief Count of compiled variants */
+        std::size_t compiledVariantCount() const;
+
+        /**
+         * @brief Variant
+         *
+         * Expects that @p id is less than @ref variantCount(). Variants are
+         * ordered by the time they were first requested or added.
+         */
+        const Variant& variant(std::size_t id) const;
+
+        /**
+         * @brief Total compilation time
+         *
+         * Sum of @ref Variant::compileTime() of all variants, in nanoseconds.
+         */
+        UnsignedLong compileTime() const;
+
+        /**
+         * @brief Get a 2D flat shader variant
+         *
+         * If a variant matching @p configuration is already present and
+         * compiled, returns it. Otherwise compiles it first. Every call
+         * increments @ref Variant::requestCount().
+         */
+        FlatGL2D& flat2D(const FlatGL2D::Configuration& configuration);
+
+        /**
+         * @brief Get a 3D flat shader variant
+         *
+         * If a variant matching @p configuration is already present and
+         * compiled, returns it. Otherwise compiles it first. Every call
+         * increments @ref Variant::requestCount().
+         */
+        FlatGL3D& flat3D(const FlatGL3D::Configuration& configuration);
+
+        /**
+         * @brief Get a Phong shader variant
+         *
+         * If a variant matching @p configuration is already present and
+         * compiled, returns it. Otherwise compiles it first. Every call
+         * increments @ref Variant::requestCount().
+         */
+        PhongGL& phong(const PhongGL::Configuration& configuration);
+
+        /**
+         * @brief Add a 2D flat shader variant
+         * @return Reference to self (for method chaining)
+         *
+         * Records the variant without compiling it, if not already present.
+         * Use @ref precompile() to compile all added variants. Doesn't
+         * affect @ref Variant::requestCount().
+         */
+        ShaderVariantCacheGL& addFlat2D(const FlatGL2D::Configuration& configuration);
+
+        /**
+         * @brief Add a 3D flat shader variant
+         * @return Reference to self (for method chaining)
+         *
+         * Records the variant without compiling it, if not already present.
+         * Use @ref precompile() to compile all added variants. Doesn't
+         * affect @ref Variant::requestCount().
+         */
+        ShaderVariantCacheGL& addFlat3D(const FlatGL3D::Configuration& configuration);
+
+        /**
+         * @brief Add a Phong shader variant
+         * @return Reference to self (for method chaining)
+         *
+         * Records the variant without compiling it, if not already present.
+         * Use @ref precompile() to compile all added variants. Doesn't
+         * affect @ref Variant::requestCount().
+         */
+        ShaderVariantCacheGL& addPhong(const PhongGL::Configuration& configuration);
+
+        /**
+         * @brief Compile all variants that weren't compiled yet
+         * @return Reference to self (for method chaining)
+         *
+         * Submits compilation of all remaining variants and only after that
+         * waits for each to finish, so drivers that support parallel shader
+         * compilation can process them concurrently. Combined with the
+         * @ref GL-AbstractShaderProgram-binary-cache "program binary cache"
+         * this can be used to populate the cache in a build step.
+         * @see @ref shaders-async
+         */
+        ShaderVariantCacheGL& precompile();
+
+        /**
+         * @brief Serialize the variant list
+         *
+         * Returns all variants, compiled or not, in the format described in
+         * @ref Shaders-ShaderVariantCacheGL-format.
+         * @see @ref deserialize()
+         */
+        std::string serialize() const;
+
+        /**
+         * @brief Deserialize a variant list
+         *
+         * Adds all variants from @p data as if @ref addFlat2D(),
+         * @ref addFlat3D() or @ref addPhong() was called for each, without
+         * compiling them. Variants that are already present are skipped. On
+         * a parse error prints a message to @relativeref{Magnum,Error},
+         * leaves the cache unchanged and returns @cpp false @ce.
+         * @see @ref serialize(), @ref precompile()
+         */
+        bool deserialize(Containers::StringView data);
+
+        /**
+         * @brief Variant statistics
+         *
+         * Returns a formatted list of all variants with their request counts
+         * and compilation times, ordered by the time they were first
+         * requested or added.
+         */
+        std::string statistics() const;
+
+    private:
+        template<UnsignedInt dimensions> MAGNUM_SHADERS_LOCAL static Variant flatVariant(ShaderType type, const typename FlatGL<dimensions>::Configuration& configuration);
+        MAGNUM_SHADERS_LOCAL static Variant phongVariant(const PhongGL::Configuration& configuration);
+        MAGNUM_SHADERS_LOCAL std::size_t findOrAdd(Variant&& variant);
+        MAGNUM_SHADERS_LOCAL void compile(std::size_t id);
+
+        Containers::Array<Variant> _variants;
+};
+
+/**
+@brief Shader variant
+@m_since_latest
+
+Description of a single variant tracked by @ref ShaderVariantCacheGL.
+*/
+class MAGNUM_SHADERS_EXPORT ShaderVariantCacheGL::Variant {
+    public:
+        /** @brief Shader type */
+        ShaderType shaderType() const { return _shaderType; }
+
+        /**
+         * @brief Flags
+         *
+         * Contents of @ref FlatGL::Flags or @ref PhongGL::Flags, depending on
+         * @ref shaderType(), as a raw integer.
+         */
+        UnsignedInt flags() const { return _flags; }
+
+        /**
+         * @brief Light count
+         *
+         * Always @cpp 0 @ce for @ref ShaderType::Flat2D and
+         * @ref ShaderType::Flat3D.
+         */
+        UnsignedInt lightCount() const { return _lightCount; }
+
+        /**
+         * @brief Material count
+         *
+         * Always @cpp 0 @ce if the variant doesn't have uniform buffers
+         * enabled and on OpenGL ES 2.0 and WebGL 1.0.
+         */
+        UnsignedInt materialCount() const { return _materialCount; }
+
+        /**
+         * @brief Draw count
+         *
+         * Always @cpp 0 @ce if the variant doesn't have uniform buffers
+         * enabled and on OpenGL ES 2.0 and WebGL 1.0.
+         */
+        UnsignedInt drawCount() const { return _drawCount; }
+
+        /**
+         * @brief Joint count
+         *
+         * Always @cpp 0 @ce on OpenGL ES 2.0 and WebGL 1.0.
+         */
+        UnsignedInt jointCount() const { return _jointCount; }
+
+        /**
+         * @brief Per-vertex joint count
+         *
+         * Always @cpp 0 @ce on OpenGL ES 2.0 and WebGL 1.0.
+         */
+        UnsignedInt perVertexJointCount() const { return _perVertexJointCount; }
+
+        /**
+         * @brief Secondary per-vertex joint count
+         *
+         * Always @cpp 0 @ce on OpenGL ES 2.0 and WebGL 1.0.
+         */
+        UnsignedInt secondaryPerVertexJointCount() const { return _secondaryPerVertexJointCount; }
+
+        /**
+         * @brief Request count
+         *
+         * How many times the variant was retrieved via
+         * @ref ShaderVariantCacheGL::flat2D(), @relativeref{ShaderVariantCacheGL,flat3D()}
+         * or @relativeref{ShaderVariantCacheGL,phong()}. Variants that were
+         * only added or deserialized have a zero request count.
+         */
+        UnsignedInt requestCount() const { return _requestCount; }
+
+        /** @brief Whether the variant is compiled */
+        bool isCompiled() const { return !!_shader; }
+
+        /**
+         * @brief Compilation time
+         *
+         * Time spent compiling and linking the variant on the calling
+         * thread, in nanoseconds. If the variant was compiled through
+         * @ref ShaderVariantCacheGL::precompile(), time the driver spent
+         * compiling in parallel with other variants isn't included.
+         * @cpp 0 @ce if the variant isn't compiled yet.
+         */
+        UnsignedLong compileTime() const { return _compileTime; }
+
+    private:
+        friend ShaderVariantCacheGL;
+
+        explicit Variant(ShaderType shaderType) noexcept;
+
+        ShaderType _shaderType;
+        UnsignedInt _flags,
+            _lightCount,
+            _materialCount,
+            _drawCount,
+            _jointCount,
+            _perVertexJointCount,
+            _secondaryPerVertexJointCount,
+            _requestCount;
+        UnsignedLong _compileTime;
+        Containers::Pointer<GL::AbstractShaderProgram> _shader;
+};
+
+/**
+@debugoperatorclassenum{ShaderVariantCacheGL,ShaderVariantCacheGL::ShaderType}
+@m_since_latest
+*/
+MAGNUM_SHADERS_EXPORT Debug& operator<<(Debug& debug, ShaderVariantCacheGL::ShaderType value);
+
+}}
+
+#endif
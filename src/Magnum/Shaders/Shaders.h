@@ -58,6 +58,15 @@ typedef CORRADE_DEPRECATED("use FlatGL3D instead") FlatGL3D Flat3D;
 
 /* Generic is used only statically */
 
+class InstanceBatcherGL;
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+class DepthPyramidGL;
+class InstanceCullingGL;
+class LightClusterGL;
+class MeshVisualizerPrepassGL;
+#endif
+
 class MeshVisualizerGL2D;
 class MeshVisualizerGL3D;
 #ifdef MAGNUM_BUILD_DEPRECATED
@@ -66,11 +75,22 @@ typedef CORRADE_DEPRECATED("use MeshVisualizerGL3D instead") MeshVisualizerGL3D
 typedef CORRADE_DEPRECATED("use MeshVisualizerGL3D instead") MeshVisualizerGL3D MeshVisualizer;
 #endif
 
+#ifndef MAGNUM_TARGET_GLES2
+class ParticleSystemGL;
+class PbrGL;
+#endif
 class PhongGL;
 #ifdef MAGNUM_BUILD_DEPRECATED
 typedef CORRADE_DEPRECATED("use PhongGL instead") PhongGL Phong;
 #endif
 
+class ShaderVariantCacheGL;
+
+#ifndef MAGNUM_TARGET_GLES2
+class TransparencyResolveGL;
+class UniformBufferBatcherGL;
+#endif
+
 template<UnsignedInt> class VectorGL;
 typedef VectorGL<2> VectorGL2D;
 typedef VectorGL<3> VectorGL3D;
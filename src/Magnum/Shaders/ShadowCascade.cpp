@@ -0,0 +1,81 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ShadowCascade.h"
+
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum { namespace Shaders {
+
+Vector4 shadowCascadeSplits(const Float near, const Float far, const UnsignedInt count, const Float lambda) {
+    CORRADE_ASSERT(near > 0.0f && near < far,
+        "Shaders::shadowCascadeSplits(): expected 0 < near < far but got" << near << "and" << far, {});
+    CORRADE_ASSERT(count >= 1 && count <= 4,
+        "Shaders::shadowCascadeSplits(): expected 1 to 4 cascades but got" << count, {});
+
+    /* Blend of a logarithmic and a uniform split, the so-called practical
+       split scheme */
+    Vector4 out{far};
+    for(UnsignedInt i = 1; i < count; ++i) {
+        const Float t = Float(i)/count;
+        out[i - 1] = Math::lerp(near + (far - near)*t, near*Math::pow(far/near, t), lambda);
+    }
+    return out;
+}
+
+Matrix4 shadowCascadeProjection(const Matrix4& cameraMatrix, const Matrix4& projectionMatrix, const Float near, const Float far, const Vector3& lightDirection) {
+    /* Unproject the frustum corners at the near and far NDC plane to camera
+       space. The near and far end of the slice is then interpolated along
+       the corner rays based on the camera-space depth, which works for both
+       perspective and orthographic projections. */
+    const Matrix4 inverseProjection = projectionMatrix.inverted();
+    const Matrix4 inverseCamera = cameraMatrix.inverted();
+    Vector3 corners[8];
+    for(UnsignedInt i = 0; i != 4; ++i) {
+        const Vector2 xy{i & 1 ? 1.0f : -1.0f, i & 2 ? 1.0f : -1.0f};
+        const Vector3 a = inverseProjection.transformPoint({xy, -1.0f});
+        const Vector3 b = inverseProjection.transformPoint({xy, 1.0f});
+        const Vector3 direction = (b - a)/(a.z() - b.z());
+        corners[i*2 + 0] = inverseCamera.transformPoint(a + direction*(near + a.z()));
+        corners[i*2 + 1] = inverseCamera.transformPoint(a + direction*(far + a.z()));
+    }
+
+    /* Enclose the slice in a sphere, so the projection size doesn't change
+       with camera rotation */
+    Vector3 center;
+    for(const Vector3& corner: corners) center += corner;
+    center /= 8.0f;
+    Float radius = 0.0f;
+    for(const Vector3& corner: corners)
+        radius = Math::max(radius, (corner - center).length());
+
+    /* Pick an up vector that's not parallel to the light direction */
+    const Vector3 up = Math::abs(lightDirection.y()) < 0.99f ?
+        Vector3::yAxis() : Vector3::zAxis();
+    const Matrix4 lightView = Matrix4::lookAt(center, center + lightDirection, up).invertedRigid();
+    return Matrix4::orthographicProjection(Vector2{2.0f*radius}, -radius, radius)*lightView;
+}
+
+}}
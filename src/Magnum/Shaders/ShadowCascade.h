@@ -0,0 +1,235 @@
+#ifndef Magnum_Shaders_ShadowCascade_h
+#define Magnum_Shaders_ShadowCascade_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Struct @ref Magnum::Shaders::ShadowCascadeUniform, function @ref Magnum::Shaders::shadowCascadeSplits(), @ref Magnum::Shaders::shadowCascadeProjection()
+ * @m_since_latest
+ */
+
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Tags.h"
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Shaders/visibility.h"
+
+namespace Magnum { namespace Shaders {
+
+/**
+@brief Shadow cascade parameters
+@m_since_latest
+
+Describes cascaded shadow maps sampled by @ref PhongGL with
+@ref PhongGL::Flag::ShadowMaps enabled. Up to four cascades are supported,
+each being a layer of a depth texture array bound with
+@ref PhongGL::bindShadowTexture(). See @ref Shaders-PhongGL-shadows for more
+information.
+@see @ref PhongGL::bindShadowBuffer()
+*/
+struct ShadowCascadeUniform {
+    /** @brief Construct with default parameters */
+    constexpr explicit ShadowCascadeUniform(DefaultInitT = DefaultInit) noexcept: cascadeMatrices{Matrix4{Math::IdentityInit}, Matrix4{Math::IdentityInit}, Matrix4{Math::IdentityInit}, Matrix4{Math::IdentityInit}}, cascadeSplits{Constants::inf()}, lightIndex{0}, cascadeCount{1}, bias{0.005f}, filterRadius{1.0f} {}
+    /** @brief Construct without initializing the contents */
+    explicit ShadowCascadeUniform(NoInitT) noexcept: cascadeMatrices{Matrix4{NoInit}, Matrix4{NoInit}, Matrix4{NoInit}, Matrix4{NoInit}}, cascadeSplits{NoInit} {}
+
+    /** @{
+     * @name Convenience setters
+     *
+     * Provided to allow the use of method chaining for populating a structure
+     * in a single expression, otherwise equivalent to accessing the fields
+     * directly. Also guaranteed to provide backwards compatibility when
+     * packing of the actual fields changes.
+     */
+
+    /**
+     * @brief Set a @ref cascadeMatrices field item
+     * @return Reference to self (for method chaining)
+     *
+     * Expects that @p id is less than @cpp 4 @ce.
+     */
+    ShadowCascadeUniform& setCascadeMatrix(UnsignedInt id, const Matrix4& matrix) {
+        CORRADE_ASSERT(id < 4,
+            "Shaders::ShadowCascadeUniform::setCascadeMatrix(): index" << id << "out of range for 4 cascades", *this);
+        cascadeMatrices[id] = matrix;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref cascadeSplits field
+     * @return Reference to self (for method chaining)
+     */
+    ShadowCascadeUniform& setCascadeSplits(const Vector4& splits) {
+        cascadeSplits = splits;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref lightIndex field
+     * @return Reference to self (for method chaining)
+     */
+    ShadowCascadeUniform& setLightIndex(UnsignedInt index) {
+        lightIndex = index;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref cascadeCount field
+     * @return Reference to self (for method chaining)
+     */
+    ShadowCascadeUniform& setCascadeCount(UnsignedInt count) {
+        cascadeCount = count;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref bias field
+     * @return Reference to self (for method chaining)
+     */
+    ShadowCascadeUniform& setBias(Float bias) {
+        this->bias = bias;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref filterRadius field
+     * @return Reference to self (for method chaining)
+     */
+    ShadowCascadeUniform& setFilterRadius(Float radius) {
+        filterRadius = radius;
+        return *this;
+    }
+
+    /**
+     * @}
+     */
+
+    /**
+     * @brief Cascade matrices
+     *
+     * For each cascade a matrix transforming a camera-space position to the
+     * clip space of given cascade, usually a
+     * @ref shadowCascadeProjection() multiplied with an inverted camera
+     * matrix. Default value is an identity matrix for all cascades.
+     */
+    Matrix4 cascadeMatrices[4];
+
+    /**
+     * @brief Cascade splits
+     *
+     * Positive camera-space distance of the far end of each cascade, usually
+     * calculated with @ref shadowCascadeSplits(). A fragment uses the first
+     * cascade the far end of which is further than the fragment. Fragments
+     * further than the last used cascade aren't shadowed. Default value is
+     * @ref Constants::inf() for all cascades.
+     */
+    Vector4 cascadeSplits;
+
+    /**
+     * @brief Light index
+     *
+     * Index of the light that casts the shadow in the buffer bound with
+     * @ref PhongGL::bindLightBuffer(). All other lights are unshadowed.
+     * Default value is @cpp 0 @ce.
+     */
+    UnsignedInt lightIndex;
+
+    /**
+     * @brief Cascade count
+     *
+     * Expected to be at least @cpp 1 @ce and at most @cpp 4 @ce. Default
+     * value is @cpp 1 @ce.
+     */
+    UnsignedInt cascadeCount;
+
+    /**
+     * @brief Depth bias
+     *
+     * Subtracted from the fragment depth in the shadow map clip space before
+     * comparing against the shadow map to avoid self-shadowing artifacts.
+     * Default value is @cpp 0.005f @ce.
+     */
+    Float bias;
+
+    /**
+     * @brief Filter radius
+     *
+     * Distance between the percentage-closer filtering samples in texels of
+     * the shadow map. The shader takes a 3x3 grid of samples, larger values
+     * make the shadow edge softer. Default value is @cpp 1.0f @ce.
+     */
+    Float filterRadius;
+};
+
+/**
+@brief Calculate shadow cascade splits
+@param near         Camera near plane distance
+@param far          Camera far plane distance
+@param count        Cascade count
+@param lambda       Blend factor between a logarithmic and a uniform split
+@m_since_latest
+
+Returns the far end of each cascade, usable for
+@ref ShadowCascadeUniform::cascadeSplits. With @p lambda being @cpp 1.0f @ce
+the splits are distributed logarithmically, which matches the perspective
+aliasing the best but gives very small cascades close to the camera, with
+@cpp 0.0f @ce they're distributed uniformly. Components beyond @p count are
+set to @p far. Expects that @p near is positive and less than @p far and
+@p count is at least @cpp 1 @ce and at most @cpp 4 @ce.
+*/
+MAGNUM_SHADERS_EXPORT Vector4 shadowCascadeSplits(Float near, Float far, UnsignedInt count, Float lambda = 0.5f);
+
+/**
+@brief Calculate a shadow cascade projection
+@param cameraMatrix     Camera matrix, i.e. an inverse of the camera
+    transformation, such as @ref SceneGraph::Camera::cameraMatrix()
+@param projectionMatrix Camera projection matrix, such as
+    @ref SceneGraph::Camera::projectionMatrix()
+@param near         Positive camera-space distance of the cascade near end
+@param far          Positive camera-space distance of the cascade far end
+@param lightDirection   Normalized world-space direction the light shines in
+@m_since_latest
+
+Returns an orthographic projection looking in @p lightDirection that encloses
+the part of the camera frustum between @p near and @p far. The projection
+transforms world-space positions and is meant to be used for rendering shadow
+casters into given cascade, for example with @ref PhongGL::Flag::DepthOnly.
+The corresponding @ref ShadowCascadeUniform::cascadeMatrices item is the
+returned matrix multiplied with @cpp cameraMatrix.inverted() @ce.
+
+The projection encloses a bounding sphere of the frustum slice, which keeps
+its size constant when the camera rotates. Only depth of casters inside the
+sphere is preserved. On desktop GL enable
+@ref GL::Renderer::Feature::DepthClamp when rendering the casters to not lose
+shadows from casters that are between the light and the sphere, elsewhere
+such casters are clipped away.
+*/
+MAGNUM_SHADERS_EXPORT Matrix4 shadowCascadeProjection(const Matrix4& cameraMatrix, const Matrix4& projectionMatrix, Float near, Float far, const Vector3& lightDirection);
+
+}}
+
+#endif
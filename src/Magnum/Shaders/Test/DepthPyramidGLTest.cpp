@@ -0,0 +1,221 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/System.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/GL/Renderer.h"
+#include "Magnum/GL/Sampler.h"
+#include "Magnum/GL/Texture.h"
+#include "Magnum/GL/TextureFormat.h"
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/Shaders/DepthPyramidGL.h"
+
+namespace Magnum { namespace Shaders { namespace Test { namespace {
+
+struct DepthPyramidGLTest: GL::OpenGLTester {
+    explicit DepthPyramidGLTest();
+
+    void construct();
+    void constructAsync();
+    void constructMove();
+
+    void build();
+    void buildInvalid();
+};
+
+DepthPyramidGLTest::DepthPyramidGLTest() {
+    addTests({&DepthPyramidGLTest::construct,
+              &DepthPyramidGLTest::constructAsync,
+              &DepthPyramidGLTest::constructMove,
+
+              &DepthPyramidGLTest::build,
+              &DepthPyramidGLTest::buildInvalid});
+}
+
+void DepthPyramidGLTest::construct() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isVersionSupported(GL::Version::GL430))
+        CORRADE_SKIP(GL::Version::GL430 << "is not supported.");
+    #else
+    if(!GL::Context::current().isVersionSupported(GL::Version::GLES310))
+        CORRADE_SKIP(GL::Version::GLES310 << "is not supported.");
+    #endif
+
+    DepthPyramidGL shader;
+    CORRADE_VERIFY(shader.id());
+    {
+        #if defined(CORRADE_TARGET_APPLE) && !defined(MAGNUM_TARGET_GLES)
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void DepthPyramidGLTest::constructAsync() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isVersionSupported(GL::Version::GL430))
+        CORRADE_SKIP(GL::Version::GL430 << "is not supported.");
+    #else
+    if(!GL::Context::current().isVersionSupported(GL::Version::GLES310))
+        CORRADE_SKIP(GL::Version::GLES310 << "is not supported.");
+    #endif
+
+    DepthPyramidGL::CompileState state = DepthPyramidGL::compile();
+
+    while(!state.isLinkFinished())
+        Utility::System::sleep(100);
+
+    DepthPyramidGL shader{std::move(state)};
+    CORRADE_VERIFY(shader.id());
+    {
+        #if defined(CORRADE_TARGET_APPLE) && !defined(MAGNUM_TARGET_GLES)
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void DepthPyramidGLTest::constructMove() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isVersionSupported(GL::Version::GL430))
+        CORRADE_SKIP(GL::Version::GL430 << "is not supported.");
+    #else
+    if(!GL::Context::current().isVersionSupported(GL::Version::GLES310))
+        CORRADE_SKIP(GL::Version::GLES310 << "is not supported.");
+    #endif
+
+    DepthPyramidGL a;
+    const GLuint id = a.id();
+    CORRADE_VERIFY(id);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    DepthPyramidGL b{std::move(a)};
+    CORRADE_COMPARE(b.id(), id);
+    CORRADE_VERIFY(!a.id());
+
+    DepthPyramidGL c{NoCreate};
+    c = std::move(b);
+    CORRADE_COMPARE(c.id(), id);
+    CORRADE_VERIFY(!b.id());
+}
+
+void DepthPyramidGLTest::build() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isVersionSupported(GL::Version::GL430))
+        CORRADE_SKIP(GL::Version::GL430 << "is not supported.");
+    #else
+    if(!GL::Context::current().isVersionSupported(GL::Version::GLES310))
+        CORRADE_SKIP(GL::Version::GLES310 << "is not supported.");
+    #endif
+
+    /* Odd size in both directions to verify the last row and column get
+       included */
+    const Float depthData[]{
+        0.1f, 0.2f, 0.3f, 0.4f, 0.5f,
+        0.6f, 0.1f, 0.1f, 0.1f, 0.9f,
+        0.2f, 0.2f, 0.2f, 0.7f, 0.1f
+    };
+    GL::Texture2D depth;
+    depth.setMinificationFilter(GL::SamplerFilter::Nearest, GL::SamplerMipmap::Base)
+        .setMagnificationFilter(GL::SamplerFilter::Nearest)
+        .setStorage(1, GL::TextureFormat::DepthComponent32F, {5, 3})
+        .setSubImage(0, {}, ImageView2D{PixelFormat::Depth32F, {5, 3}, depthData});
+
+    CORRADE_COMPARE(DepthPyramidGL::levelCount({5, 3}), 3);
+    GL::Texture2D pyramid;
+    pyramid.setMinificationFilter(GL::SamplerFilter::Nearest, GL::SamplerMipmap::Nearest)
+        .setMagnificationFilter(GL::SamplerFilter::Nearest)
+        .setStorage(DepthPyramidGL::levelCount({5, 3}), GL::TextureFormat::R32F, {5, 3});
+
+    DepthPyramidGL shader;
+    shader.build(depth, pyramid, {5, 3});
+    GL::Renderer::setMemoryBarrier(GL::Renderer::MemoryBarrier::TextureUpdate);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    #ifndef MAGNUM_TARGET_GLES
+    Image2D level0 = pyramid.image(0, {PixelFormat::R32F});
+    Image2D level1 = pyramid.image(1, {PixelFormat::R32F});
+    Image2D level2 = pyramid.image(2, {PixelFormat::R32F});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_COMPARE(level0.size(), (Vector2i{5, 3}));
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Float>(level0.data()),
+        Containers::arrayView(depthData),
+        TestSuite::Compare::Container);
+
+    /* The second texel of the first row covers three columns and both
+       levels cover all three rows */
+    CORRADE_COMPARE(level1.size(), (Vector2i{2, 1}));
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Float>(level1.data()),
+        Containers::arrayView({0.6f, 0.9f}),
+        TestSuite::Compare::Container);
+
+    CORRADE_COMPARE(level2.size(), (Vector2i{1, 1}));
+    CORRADE_COMPARE(Containers::arrayCast<const Float>(level2.data())[0], 0.9f);
+    #else
+    CORRADE_SKIP("Texture image queries are not available on OpenGL ES, can't verify the output.");
+    #endif
+}
+
+void DepthPyramidGLTest::buildInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isVersionSupported(GL::Version::GL430))
+        CORRADE_SKIP(GL::Version::GL430 << "is not supported.");
+    #else
+    if(!GL::Context::current().isVersionSupported(GL::Version::GLES310))
+        CORRADE_SKIP(GL::Version::GLES310 << "is not supported.");
+    #endif
+
+    GL::Texture2D depth, pyramid;
+    DepthPyramidGL shader;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    shader.build(depth, pyramid, {0, 16});
+    CORRADE_COMPARE(out.str(),
+        "Shaders::DepthPyramidGL::build(): expected a non-zero size but got {0, 16}\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Shaders::Test::DepthPyramidGLTest)
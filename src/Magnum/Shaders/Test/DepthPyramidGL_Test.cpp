@@ -0,0 +1,87 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/Shaders/DepthPyramidGL.h"
+
+namespace Magnum { namespace Shaders { namespace Test { namespace {
+
+/* There's an underscore between GL and Test to disambiguate from GLTest, which
+   is a common suffix used to mark tests that need a GL context. Ugly, I know. */
+struct DepthPyramidGL_Test: TestSuite::Tester {
+    explicit DepthPyramidGL_Test();
+
+    void constructNoCreate();
+    void constructCopy();
+
+    void levelCount();
+    void levelCountInvalid();
+};
+
+DepthPyramidGL_Test::DepthPyramidGL_Test() {
+    addTests({&DepthPyramidGL_Test::constructNoCreate,
+              &DepthPyramidGL_Test::constructCopy,
+
+              &DepthPyramidGL_Test::levelCount,
+              &DepthPyramidGL_Test::levelCountInvalid});
+}
+
+void DepthPyramidGL_Test::constructNoCreate() {
+    {
+        DepthPyramidGL shader{NoCreate};
+        CORRADE_COMPARE(shader.id(), 0);
+    }
+
+    CORRADE_VERIFY(true);
+}
+
+void DepthPyramidGL_Test::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<DepthPyramidGL>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<DepthPyramidGL>{});
+}
+
+void DepthPyramidGL_Test::levelCount() {
+    CORRADE_COMPARE(DepthPyramidGL::levelCount({1, 1}), 1);
+    CORRADE_COMPARE(DepthPyramidGL::levelCount({5, 3}), 3);
+    CORRADE_COMPARE(DepthPyramidGL::levelCount({1920, 1080}), 11);
+    CORRADE_COMPARE(DepthPyramidGL::levelCount({2048, 16}), 12);
+}
+
+void DepthPyramidGL_Test::levelCountInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    DepthPyramidGL::levelCount({16, 0});
+    CORRADE_COMPARE(out.str(), "Shaders::DepthPyramidGL::levelCount(): expected a non-zero size but got {16, 0}\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Shaders::Test::DepthPyramidGL_Test)
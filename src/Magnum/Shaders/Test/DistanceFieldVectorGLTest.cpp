@@ -32,10 +32,10 @@
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Format.h>
 #include <Corrade/Utility/Path.h>
+#include <Corrade/Utility/System.h>
 
 #ifdef CORRADE_TARGET_APPLE
 #include <Corrade/Containers/Pair.h>
-#include <Corrade/Utility/System.h> /* isSandboxed() */
 #endif
 
 #include "Magnum/Image.h"
@@ -88,6 +88,11 @@ struct DistanceFieldVectorGLTest: GL::OpenGLTester {
     template<UnsignedInt dimensions> void constructUniformBuffers();
     #endif
 
+    template<UnsignedInt dimensions> void constructAsync();
+    #ifndef MAGNUM_TARGET_GLES2
+    template<UnsignedInt dimensions> void constructUniformBuffersAsync();
+    #endif
+
     template<UnsignedInt dimensions> void constructMove();
     #ifndef MAGNUM_TARGET_GLES2
     template<UnsignedInt dimensions> void constructMoveUniformBuffers();
@@ -104,6 +109,7 @@ struct DistanceFieldVectorGLTest: GL::OpenGLTester {
     template<UnsignedInt dimensions> void setTextureMatrixNotEnabled();
     #ifndef MAGNUM_TARGET_GLES2
     template<UnsignedInt dimensions> void bindTextureTransformBufferNotEnabled();
+    template<UnsignedInt dimensions> void bindGlyphRectangleTextureNotEnabled();
     #endif
     #ifndef MAGNUM_TARGET_GLES2
     template<UnsignedInt dimensions> void setWrongDrawOffset();
@@ -167,7 +173,11 @@ constexpr struct {
     DistanceFieldVectorGL2D::Flags flags;
 } ConstructData[]{
     {"", {}},
-    {"texture transformation", DistanceFieldVectorGL2D::Flag::TextureTransformation}
+    {"texture transformation", DistanceFieldVectorGL2D::Flag::TextureTransformation},
+    {"multi-channel", DistanceFieldVectorGL2D::Flag::MultiChannel},
+    #ifndef MAGNUM_TARGET_GLES2
+    {"instanced glyphs", DistanceFieldVectorGL2D::Flag::InstancedGlyphs},
+    #endif
 };
 
 #ifndef MAGNUM_TARGET_GLES2
@@ -217,6 +227,9 @@ const struct {
     {"smooth0.2", {}, {}, 0xffff99_rgbf, 0x9999ff_rgbf, 0.5f, 1.0f, 0.2f,
         "smooth0.2-2D.tga", "smooth0.2-3D.tga", false},
     {"outline", {}, {}, 0xffff99_rgbf, 0x9999ff_rgbf, 0.6f, 0.45f, 0.05f,
+        "outline2D.tga", "outline3D.tga", false},
+    {"outline, multi-channel", DistanceFieldVectorGL2D::Flag::MultiChannel, {},
+        0xffff99_rgbf, 0x9999ff_rgbf, 0.6f, 0.45f, 0.05f,
         "outline2D.tga", "outline3D.tga", false}
 };
 
@@ -259,6 +272,14 @@ DistanceFieldVectorGLTest::DistanceFieldVectorGLTest() {
     #endif
 
     addTests<DistanceFieldVectorGLTest>({
+        &DistanceFieldVectorGLTest::constructAsync<2>,
+        &DistanceFieldVectorGLTest::constructAsync<3>,
+
+        #ifndef MAGNUM_TARGET_GLES2
+        &DistanceFieldVectorGLTest::constructUniformBuffersAsync<2>,
+        &DistanceFieldVectorGLTest::constructUniformBuffersAsync<3>,
+        #endif
+
         &DistanceFieldVectorGLTest::constructMove<2>,
         &DistanceFieldVectorGLTest::constructMove<3>,
 
@@ -287,6 +308,8 @@ DistanceFieldVectorGLTest::DistanceFieldVectorGLTest() {
         #ifndef MAGNUM_TARGET_GLES2
         &DistanceFieldVectorGLTest::bindTextureTransformBufferNotEnabled<2>,
         &DistanceFieldVectorGLTest::bindTextureTransformBufferNotEnabled<3>,
+        &DistanceFieldVectorGLTest::bindGlyphRectangleTextureNotEnabled<2>,
+        &DistanceFieldVectorGLTest::bindGlyphRectangleTextureNotEnabled<3>,
         #endif
         #ifndef MAGNUM_TARGET_GLES2
         &DistanceFieldVectorGLTest::setWrongDrawOffset<2>,
@@ -361,6 +384,15 @@ template<UnsignedInt dimensions> void DistanceFieldVectorGLTest::construct() {
     auto&& data = ConstructData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
 
+    #ifndef MAGNUM_TARGET_GLES
+    if(data.flags >= DistanceFieldVectorGL2D::Flag::InstancedGlyphs) {
+        if(!GL::Context::current().isVersionSupported(GL::Version::GL300))
+            CORRADE_SKIP(GL::Version::GL300 << "is not supported.");
+        if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::instanced_arrays>())
+            CORRADE_SKIP(GL::Extensions::ARB::instanced_arrays::string() << "is not supported.");
+    }
+    #endif
+
     DistanceFieldVectorGL<dimensions> shader{data.flags};
     CORRADE_COMPARE(shader.flags(), data.flags);
     CORRADE_VERIFY(shader.id());
@@ -415,6 +447,61 @@ template<UnsignedInt dimensions> void DistanceFieldVectorGLTest::constructUnifor
 }
 #endif
 
+template<UnsignedInt dimensions> void DistanceFieldVectorGLTest::constructAsync() {
+    setTestCaseTemplateName(Utility::format("{}", dimensions));
+
+    typename DistanceFieldVectorGL<dimensions>::CompileState state = DistanceFieldVectorGL<dimensions>::compile(DistanceFieldVectorGL2D::Flag::TextureTransformation);
+    CORRADE_COMPARE(state.flags(), DistanceFieldVectorGL2D::Flag::TextureTransformation);
+
+    while(!state.isLinkFinished())
+        Utility::System::sleep(100);
+
+    DistanceFieldVectorGL<dimensions> shader{std::move(state)};
+    CORRADE_COMPARE(shader.flags(), DistanceFieldVectorGL2D::Flag::TextureTransformation);
+    CORRADE_VERIFY(shader.id());
+    {
+        #if defined(CORRADE_TARGET_APPLE) && !defined(MAGNUM_TARGET_GLES)
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+template<UnsignedInt dimensions> void DistanceFieldVectorGLTest::constructUniformBuffersAsync() {
+    setTestCaseTemplateName(Utility::format("{}", dimensions));
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() << "is not supported.");
+    #endif
+
+    typename DistanceFieldVectorGL<dimensions>::CompileState state = DistanceFieldVectorGL<dimensions>::compile(DistanceFieldVectorGL2D::Flag::UniformBuffers|DistanceFieldVectorGL2D::Flag::TextureTransformation, 3, 5);
+    CORRADE_COMPARE(state.flags(), DistanceFieldVectorGL2D::Flag::UniformBuffers|DistanceFieldVectorGL2D::Flag::TextureTransformation);
+    CORRADE_COMPARE(state.materialCount(), 3);
+    CORRADE_COMPARE(state.drawCount(), 5);
+
+    while(!state.isLinkFinished())
+        Utility::System::sleep(100);
+
+    DistanceFieldVectorGL<dimensions> shader{std::move(state)};
+    CORRADE_COMPARE(shader.flags(), DistanceFieldVectorGL2D::Flag::UniformBuffers|DistanceFieldVectorGL2D::Flag::TextureTransformation);
+    CORRADE_COMPARE(shader.materialCount(), 3);
+    CORRADE_COMPARE(shader.drawCount(), 5);
+    CORRADE_VERIFY(shader.id());
+    {
+        #if defined(CORRADE_TARGET_APPLE) && !defined(MAGNUM_TARGET_GLES)
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+#endif
+
 template<UnsignedInt dimensions> void DistanceFieldVectorGLTest::constructMove() {
     setTestCaseTemplateName(Utility::format("{}", dimensions));
 
@@ -589,6 +676,21 @@ template<UnsignedInt dimensions> void DistanceFieldVectorGLTest::bindTextureTran
         "Shaders::DistanceFieldVectorGL::bindTextureTransformationBuffer(): the shader was not created with texture transformation enabled\n"
         "Shaders::DistanceFieldVectorGL::bindTextureTransformationBuffer(): the shader was not created with texture transformation enabled\n");
 }
+
+template<UnsignedInt dimensions> void DistanceFieldVectorGLTest::bindGlyphRectangleTextureNotEnabled() {
+    setTestCaseTemplateName(Utility::format("{}", dimensions));
+
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    GL::Texture2D texture;
+    DistanceFieldVectorGL<dimensions> shader;
+    shader.bindGlyphRectangleTexture(texture);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::DistanceFieldVectorGL::bindGlyphRectangleTexture(): the shader was not created with instanced glyphs enabled\n");
+}
 #endif
 
 #ifndef MAGNUM_TARGET_GLES2
@@ -853,14 +955,32 @@ template<DistanceFieldVectorGL2D::Flag flag> void DistanceFieldVectorGLTest::ren
         .setMagnificationFilter(GL::SamplerFilter::Linear)
         .setWrapping(GL::SamplerWrapping::ClampToEdge);
 
-    #ifdef MAGNUM_TARGET_GLES2
-    /* Don't want to bother with the fiasco of single-channel formats and
-       texture storage extensions on ES2 */
-    texture.setImage(0, TextureFormatR, *image);
-    #else
-    texture.setStorage(1, TextureFormatR, image->size())
-        .setSubImage(0, {}, *image);
-    #endif
+    /* For the multi-channel variant replicate the red channel to all three,
+       which should result in exactly the same output */
+    if(data.flags & DistanceFieldVectorGL2D::Flag::MultiChannel) {
+        Image2D rgb{PixelStorage{}.setAlignment(1), PixelFormat::RGB8Unorm, image->size(), Containers::Array<char>{NoInit, std::size_t(image->size().product()*3)}};
+        const Containers::StridedArrayView2D<const UnsignedByte> src = image->pixels<UnsignedByte>();
+        const Containers::StridedArrayView2D<Color3ub> dst = rgb.pixels<Color3ub>();
+        for(std::size_t y = 0; y != src.size()[0]; ++y)
+            for(std::size_t x = 0; x != src.size()[1]; ++x)
+                dst[y][x] = Color3ub{src[y][x]};
+
+        #ifdef MAGNUM_TARGET_GLES2
+        texture.setImage(0, GL::TextureFormat::RGB, rgb);
+        #else
+        texture.setStorage(1, GL::TextureFormat::RGB8, rgb.size())
+            .setSubImage(0, {}, rgb);
+        #endif
+    } else {
+        #ifdef MAGNUM_TARGET_GLES2
+        /* Don't want to bother with the fiasco of single-channel formats
+           and texture storage extensions on ES2 */
+        texture.setImage(0, TextureFormatR, *image);
+        #else
+        texture.setStorage(1, TextureFormatR, image->size())
+            .setSubImage(0, {}, *image);
+        #endif
+    }
 
     DistanceFieldVectorGL2D shader{data.flags|flag};
     shader.bindVectorTexture(texture);
@@ -961,14 +1081,32 @@ template<DistanceFieldVectorGL3D::Flag flag> void DistanceFieldVectorGLTest::ren
         .setMagnificationFilter(GL::SamplerFilter::Linear)
         .setWrapping(GL::SamplerWrapping::ClampToEdge);
 
-    #ifdef MAGNUM_TARGET_GLES2
-    /* Don't want to bother with the fiasco of single-channel formats and
-       texture storage extensions on ES2 */
-    texture.setImage(0, TextureFormatR, *image);
-    #else
-    texture.setStorage(1, TextureFormatR, image->size())
-        .setSubImage(0, {}, *image);
-    #endif
+    /* For the multi-channel variant replicate the red channel to all three,
+       which should result in exactly the same output */
+    if(data.flags & DistanceFieldVectorGL2D::Flag::MultiChannel) {
+        Image2D rgb{PixelStorage{}.setAlignment(1), PixelFormat::RGB8Unorm, image->size(), Containers::Array<char>{NoInit, std::size_t(image->size().product()*3)}};
+        const Containers::StridedArrayView2D<const UnsignedByte> src = image->pixels<UnsignedByte>();
+        const Containers::StridedArrayView2D<Color3ub> dst = rgb.pixels<Color3ub>();
+        for(std::size_t y = 0; y != src.size()[0]; ++y)
+            for(std::size_t x = 0; x != src.size()[1]; ++x)
+                dst[y][x] = Color3ub{src[y][x]};
+
+        #ifdef MAGNUM_TARGET_GLES2
+        texture.setImage(0, GL::TextureFormat::RGB, rgb);
+        #else
+        texture.setStorage(1, GL::TextureFormat::RGB8, rgb.size())
+            .setSubImage(0, {}, rgb);
+        #endif
+    } else {
+        #ifdef MAGNUM_TARGET_GLES2
+        /* Don't want to bother with the fiasco of single-channel formats
+           and texture storage extensions on ES2 */
+        texture.setImage(0, TextureFormatR, *image);
+        #else
+        texture.setStorage(1, TextureFormatR, image->size())
+            .setSubImage(0, {}, *image);
+        #endif
+    }
 
     DistanceFieldVectorGL3D shader{data.flags|flag};
     shader.bindVectorTexture(texture);
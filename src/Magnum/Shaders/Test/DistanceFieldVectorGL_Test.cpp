@@ -86,8 +86,8 @@ template<UnsignedInt dimensions> void DistanceFieldVectorGL_Test::constructCopy(
 void DistanceFieldVectorGL_Test::debugFlag() {
     std::ostringstream out;
 
-    Debug{&out} << DistanceFieldVectorGL2D::Flag::TextureTransformation << DistanceFieldVectorGL2D::Flag(0xf0);
-    CORRADE_COMPARE(out.str(), "Shaders::DistanceFieldVectorGL::Flag::TextureTransformation Shaders::DistanceFieldVectorGL::Flag(0xf0)\n");
+    Debug{&out} << DistanceFieldVectorGL2D::Flag::TextureTransformation << DistanceFieldVectorGL2D::Flag::MultiChannel << DistanceFieldVectorGL2D::Flag(0xf0);
+    CORRADE_COMPARE(out.str(), "Shaders::DistanceFieldVectorGL::Flag::TextureTransformation Shaders::DistanceFieldVectorGL::Flag::MultiChannel Shaders::DistanceFieldVectorGL::Flag(0xf0)\n");
 }
 
 void DistanceFieldVectorGL_Test::debugFlags() {
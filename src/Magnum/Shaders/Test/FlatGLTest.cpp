@@ -24,6 +24,7 @@
 */
 
 #include <sstream>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Containers/String.h>
@@ -32,10 +33,10 @@
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/FormatStl.h>
 #include <Corrade/Utility/Path.h>
+#include <Corrade/Utility/System.h>
 
 #ifdef CORRADE_TARGET_APPLE
 #include <Corrade/Containers/Pair.h>
-#include <Corrade/Utility/System.h> /* isSandboxed() */
 #endif
 
 #include "Magnum/Image.h"
@@ -87,13 +88,23 @@ struct FlatGLTest: GL::OpenGLTester {
     template<UnsignedInt dimensions> void constructUniformBuffers();
     #endif
 
+    template<UnsignedInt dimensions> void constructAsync();
+    #ifndef MAGNUM_TARGET_GLES2
+    template<UnsignedInt dimensions> void constructUniformBuffersAsync();
+    #endif
+
     template<UnsignedInt dimensions> void constructMove();
     #ifndef MAGNUM_TARGET_GLES2
     template<UnsignedInt dimensions> void constructMoveUniformBuffers();
     #endif
 
+    #ifndef MAGNUM_TARGET_GLES2
+    template<UnsignedInt dimensions> void constructSkinning();
+    #endif
+
     template<UnsignedInt dimensions> void constructInvalid();
     #ifndef MAGNUM_TARGET_GLES2
+    template<UnsignedInt dimensions> void constructSkinningInvalid();
     template<UnsignedInt dimensions> void constructUniformBuffersInvalid();
     #endif
 
@@ -116,6 +127,8 @@ struct FlatGLTest: GL::OpenGLTester {
     #endif
     #ifndef MAGNUM_TARGET_GLES2
     template<UnsignedInt dimensions> void setWrongDrawOffset();
+    template<UnsignedInt dimensions> void setWrongJointCountOrId();
+    template<UnsignedInt dimensions> void setPerVertexJointCountInvalid();
     #endif
 
     void renderSetup();
@@ -150,6 +163,10 @@ struct FlatGLTest: GL::OpenGLTester {
     template<FlatGL2D::Flag flag = FlatGL2D::Flag{}> void renderInstanced2D();
     template<FlatGL3D::Flag flag = FlatGL3D::Flag{}> void renderInstanced3D();
 
+    #ifndef MAGNUM_TARGET_GLES2
+    template<FlatGL2D::Flag flag = FlatGL2D::Flag{}> void renderSkinning2D();
+    #endif
+
     #ifndef MAGNUM_TARGET_GLES2
     void renderMulti2D();
     void renderMulti3D();
@@ -278,11 +295,73 @@ constexpr struct {
         /* ObjectId shares bits with ObjectIdTexture but should still trigger
            the assert */
         FlatGL2D::Flag::TextureArrays|FlatGL2D::Flag::ObjectId,
-        "texture arrays enabled but the shader is not textured"}
+        "texture arrays enabled but the shader is not textured"},
+    #endif
+    #ifndef MAGNUM_TARGET_GLES
+    {"bindless textures but no uniform buffers",
+        FlatGL2D::Flag::Textured|FlatGL2D::Flag::BindlessTextures,
+        "bindless textures require uniform buffers to be enabled"}
     #endif
 };
 
 #ifndef MAGNUM_TARGET_GLES2
+constexpr struct {
+    const char* name;
+    FlatGL2D::Flags flags;
+    UnsignedInt jointCount, perVertexJointCount, secondaryPerVertexJointCount;
+} ConstructSkinningData[]{
+    {"one set", {}, 16, 4, 0},
+    {"two partial sets", {}, 32, 2, 3},
+    {"secondary set only", {}, 12, 0, 4},
+    {"dynamic", FlatGL2D::Flag::DynamicPerVertexJointCount, 16, 4, 4},
+    {"instanced", FlatGL2D::Flag::InstancedTransformation, 16, 4, 0},
+    {"uniform buffers", FlatGL2D::Flag::UniformBuffers, 16, 4, 4},
+    {"uniform buffers + dynamic", FlatGL2D::Flag::UniformBuffers|FlatGL2D::Flag::DynamicPerVertexJointCount, 16, 4, 4},
+    {"multidraw", FlatGL2D::Flag::MultiDraw, 64, 2, 1},
+};
+
+constexpr struct {
+    const char* name;
+    FlatGL2D::Flags flags;
+    UnsignedInt jointCount, perVertexJointCount, secondaryPerVertexJointCount;
+    const char* message;
+} ConstructSkinningInvalidData[]{
+    {"dynamic per-vertex joint count but no joints",
+        FlatGL2D::Flag::DynamicPerVertexJointCount, 0, 0, 0,
+        "dynamic per-vertex joint count enabled for zero joints"},
+    {"secondary joints + instanced transformation",
+        FlatGL2D::Flag::InstancedTransformation, 16, 2, 2,
+        "secondary per-vertex joint attributes conflict with the instanced TransformationMatrix attribute"},
+};
+
+constexpr struct {
+    const char* name;
+    FlatGL2D::Flags flags;
+    UnsignedInt jointCount, perVertexJointCount, secondaryPerVertexJointCount;
+    UnsignedInt dynamicPerVertexJointCount, dynamicSecondaryPerVertexJointCount;
+    Vector4ui jointIds, secondaryJointIds;
+    Vector4 weights, secondaryWeights;
+} RenderSkinningData[]{
+    {"primary joints",
+        {}, 2, 2, 0, 0, 0,
+        {0, 1, 0, 0}, {},
+        {0.5f, 0.5f, 0.0f, 0.0f}, {}},
+    {"primary + secondary joints",
+        {}, 2, 1, 1, 0, 0,
+        {0, 0, 0, 0}, {1, 0, 0, 0},
+        {0.5f, 0.0f, 0.0f, 0.0f}, {0.5f, 0.0f, 0.0f, 0.0f}},
+    /* The extra components reference a joint with a garbage matrix, it
+       should be ignored */
+    {"dynamic primary joint count",
+        FlatGL2D::Flag::DynamicPerVertexJointCount, 3, 4, 0, 2, 0,
+        {0, 1, 2, 2}, {},
+        {0.5f, 0.5f, 1.0f, 1.0f}, {}},
+    {"dynamic secondary joint count",
+        FlatGL2D::Flag::DynamicPerVertexJointCount, 3, 2, 3, 2, 0,
+        {0, 1, 0, 0}, {2, 2, 2, 0},
+        {0.5f, 0.5f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f, 0.0f}},
+};
+
 constexpr struct {
     const char* name;
     FlatGL2D::Flags flags;
@@ -608,6 +687,14 @@ FlatGLTest::FlatGLTest() {
     #endif
 
     addTests<FlatGLTest>({
+        &FlatGLTest::constructAsync<2>,
+        &FlatGLTest::constructAsync<3>,
+
+        #ifndef MAGNUM_TARGET_GLES2
+        &FlatGLTest::constructUniformBuffersAsync<2>,
+        &FlatGLTest::constructUniformBuffersAsync<3>,
+        #endif
+
         &FlatGLTest::constructMove<2>,
         &FlatGLTest::constructMove<3>,
 
@@ -617,12 +704,24 @@ FlatGLTest::FlatGLTest() {
         #endif
         });
 
+    #ifndef MAGNUM_TARGET_GLES2
+    addInstancedTests<FlatGLTest>({
+        &FlatGLTest::constructSkinning<2>,
+        &FlatGLTest::constructSkinning<3>},
+        Containers::arraySize(ConstructSkinningData));
+    #endif
+
     addInstancedTests<FlatGLTest>({
         &FlatGLTest::constructInvalid<2>,
         &FlatGLTest::constructInvalid<3>},
         Containers::arraySize(ConstructInvalidData));
 
     #ifndef MAGNUM_TARGET_GLES2
+    addInstancedTests<FlatGLTest>({
+        &FlatGLTest::constructSkinningInvalid<2>,
+        &FlatGLTest::constructSkinningInvalid<3>},
+        Containers::arraySize(ConstructSkinningInvalidData));
+
     addInstancedTests<FlatGLTest>({
         &FlatGLTest::constructUniformBuffersInvalid<2>,
         &FlatGLTest::constructUniformBuffersInvalid<3>},
@@ -670,6 +769,10 @@ FlatGLTest::FlatGLTest() {
         #ifndef MAGNUM_TARGET_GLES2
         &FlatGLTest::setWrongDrawOffset<2>,
         &FlatGLTest::setWrongDrawOffset<3>,
+        &FlatGLTest::setWrongJointCountOrId<2>,
+        &FlatGLTest::setWrongJointCountOrId<3>,
+        &FlatGLTest::setPerVertexJointCountInvalid<2>,
+        &FlatGLTest::setPerVertexJointCountInvalid<3>,
         #endif
     });
 
@@ -795,6 +898,16 @@ FlatGLTest::FlatGLTest() {
         #endif
         );
 
+    #ifndef MAGNUM_TARGET_GLES2
+    /* MSVC needs explicit type due to default template args */
+    addInstancedTests<FlatGLTest>({
+        &FlatGLTest::renderSkinning2D,
+        &FlatGLTest::renderSkinning2D<FlatGL2D::Flag::UniformBuffers>},
+        Containers::arraySize(RenderSkinningData),
+        &FlatGLTest::renderSetup,
+        &FlatGLTest::renderTeardown);
+    #endif
+
     #ifndef MAGNUM_TARGET_GLES2
     addInstancedTests({&FlatGLTest::renderMulti2D,
                        &FlatGLTest::renderMulti3D},
@@ -898,6 +1011,61 @@ template<UnsignedInt dimensions> void FlatGLTest::constructUniformBuffers() {
 }
 #endif
 
+template<UnsignedInt dimensions> void FlatGLTest::constructAsync() {
+    setTestCaseTemplateName(Utility::format("{}", dimensions));
+
+    typename FlatGL<dimensions>::CompileState state = FlatGL<dimensions>::compile(FlatGL2D::Flag::Textured|FlatGL2D::Flag::VertexColor);
+    CORRADE_COMPARE(state.flags(), FlatGL2D::Flag::Textured|FlatGL2D::Flag::VertexColor);
+
+    while(!state.isLinkFinished())
+        Utility::System::sleep(100);
+
+    FlatGL<dimensions> shader{std::move(state)};
+    CORRADE_COMPARE(shader.flags(), FlatGL2D::Flag::Textured|FlatGL2D::Flag::VertexColor);
+    CORRADE_VERIFY(shader.id());
+    {
+        #if defined(CORRADE_TARGET_APPLE) && !defined(MAGNUM_TARGET_GLES)
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+template<UnsignedInt dimensions> void FlatGLTest::constructUniformBuffersAsync() {
+    setTestCaseTemplateName(Utility::format("{}", dimensions));
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() << "is not supported.");
+    #endif
+
+    typename FlatGL<dimensions>::CompileState state = FlatGL<dimensions>::compile(FlatGL2D::Flag::UniformBuffers|FlatGL2D::Flag::Textured|FlatGL2D::Flag::VertexColor, 3, 5);
+    CORRADE_COMPARE(state.flags(), FlatGL2D::Flag::UniformBuffers|FlatGL2D::Flag::Textured|FlatGL2D::Flag::VertexColor);
+    CORRADE_COMPARE(state.materialCount(), 3);
+    CORRADE_COMPARE(state.drawCount(), 5);
+
+    while(!state.isLinkFinished())
+        Utility::System::sleep(100);
+
+    FlatGL<dimensions> shader{std::move(state)};
+    CORRADE_COMPARE(shader.flags(), FlatGL2D::Flag::UniformBuffers|FlatGL2D::Flag::Textured|FlatGL2D::Flag::VertexColor);
+    CORRADE_COMPARE(shader.materialCount(), 3);
+    CORRADE_COMPARE(shader.drawCount(), 5);
+    CORRADE_VERIFY(shader.id());
+    {
+        #if defined(CORRADE_TARGET_APPLE) && !defined(MAGNUM_TARGET_GLES)
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+#endif
+
 template<UnsignedInt dimensions> void FlatGLTest::constructMove() {
     setTestCaseTemplateName(Utility::format("{}", dimensions));
 
@@ -951,6 +1119,53 @@ template<UnsignedInt dimensions> void FlatGLTest::constructMoveUniformBuffers()
 }
 #endif
 
+#ifndef MAGNUM_TARGET_GLES2
+template<UnsignedInt dimensions> void FlatGLTest::constructSkinning() {
+    auto&& data = ConstructSkinningData[testCaseInstanceId()];
+    setTestCaseTemplateName(Utility::format("{}", dimensions));
+    setTestCaseDescription(data.name);
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::gpu_shader4>())
+        CORRADE_SKIP(GL::Extensions::EXT::gpu_shader4::string() << "is not supported.");
+    if((data.flags & FlatGL2D::Flag::UniformBuffers) && !GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() << "is not supported.");
+    #endif
+
+    if(data.flags >= FlatGL2D::Flag::MultiDraw) {
+        #ifndef MAGNUM_TARGET_GLES
+        if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::shader_draw_parameters>())
+            CORRADE_SKIP(GL::Extensions::ARB::shader_draw_parameters::string() << "is not supported.");
+        #elif !defined(MAGNUM_TARGET_WEBGL)
+        if(!GL::Context::current().isExtensionSupported<GL::Extensions::ANGLE::multi_draw>())
+            CORRADE_SKIP(GL::Extensions::ANGLE::multi_draw::string() << "is not supported.");
+        #else
+        if(!GL::Context::current().isExtensionSupported<GL::Extensions::WEBGL::multi_draw>())
+            CORRADE_SKIP(GL::Extensions::WEBGL::multi_draw::string() << "is not supported.");
+        #endif
+    }
+
+    FlatGL<dimensions> shader{typename FlatGL<dimensions>::Configuration{}
+        .setFlags(data.flags)
+        .setJointCount(data.jointCount, data.perVertexJointCount, data.secondaryPerVertexJointCount)};
+    CORRADE_COMPARE(shader.flags(), data.flags);
+    CORRADE_COMPARE(shader.materialCount(), 1);
+    CORRADE_COMPARE(shader.drawCount(), 1);
+    CORRADE_COMPARE(shader.jointCount(), data.jointCount);
+    CORRADE_COMPARE(shader.perVertexJointCount(), data.perVertexJointCount);
+    CORRADE_COMPARE(shader.secondaryPerVertexJointCount(), data.secondaryPerVertexJointCount);
+    CORRADE_VERIFY(shader.id());
+    {
+        #if defined(CORRADE_TARGET_APPLE) && !defined(MAGNUM_TARGET_GLES)
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+#endif
+
 template<UnsignedInt dimensions> void FlatGLTest::constructInvalid() {
     auto&& data = ConstructInvalidData[testCaseInstanceId()];
     setTestCaseTemplateName(Utility::format("{}", dimensions));
@@ -966,6 +1181,22 @@ template<UnsignedInt dimensions> void FlatGLTest::constructInvalid() {
 }
 
 #ifndef MAGNUM_TARGET_GLES2
+template<UnsignedInt dimensions> void FlatGLTest::constructSkinningInvalid() {
+    auto&& data = ConstructSkinningInvalidData[testCaseInstanceId()];
+    setTestCaseTemplateName(Utility::format("{}", dimensions));
+    setTestCaseDescription(data.name);
+
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    FlatGL<dimensions>{typename FlatGL<dimensions>::Configuration{}
+        .setFlags(data.flags)
+        .setJointCount(data.jointCount, data.perVertexJointCount, data.secondaryPerVertexJointCount)};
+    CORRADE_COMPARE(out.str(), Utility::formatString(
+        "Shaders::FlatGL: {}\n", data.message));
+}
+
 template<UnsignedInt dimensions> void FlatGLTest::constructUniformBuffersInvalid() {
     auto&& data = ConstructUniformBuffersInvalidData[testCaseInstanceId()];
     setTestCaseTemplateName(Utility::format("{}", dimensions));
@@ -1006,14 +1237,18 @@ template<UnsignedInt dimensions> void FlatGLTest::setUniformUniformBuffersEnable
         .setTextureLayer({})
         .setColor({})
         .setAlphaMask({})
-        .setObjectId({});
+        .setObjectId({})
+        .setJointMatrices({})
+        .setJointMatrix(0, {});
     CORRADE_COMPARE(out.str(),
         "Shaders::FlatGL::setTransformationProjectionMatrix(): the shader was created with uniform buffers enabled\n"
         "Shaders::FlatGL::setTextureMatrix(): the shader was created with uniform buffers enabled\n"
         "Shaders::FlatGL::setTextureLayer(): the shader was created with uniform buffers enabled\n"
         "Shaders::FlatGL::setColor(): the shader was created with uniform buffers enabled\n"
         "Shaders::FlatGL::setAlphaMask(): the shader was created with uniform buffers enabled\n"
-        "Shaders::FlatGL::setObjectId(): the shader was created with uniform buffers enabled\n");
+        "Shaders::FlatGL::setObjectId(): the shader was created with uniform buffers enabled\n"
+        "Shaders::FlatGL::setJointMatrices(): the shader was created with uniform buffers enabled\n"
+        "Shaders::FlatGL::setJointMatrix(): the shader was created with uniform buffers enabled\n");
 }
 
 template<UnsignedInt dimensions> void FlatGLTest::bindBufferUniformBuffersNotEnabled() {
@@ -1034,6 +1269,8 @@ template<UnsignedInt dimensions> void FlatGLTest::bindBufferUniformBuffersNotEna
           .bindTextureTransformationBuffer(buffer, 0, 16)
           .bindMaterialBuffer(buffer)
           .bindMaterialBuffer(buffer, 0, 16)
+          .bindJointBuffer(buffer)
+          .bindJointBuffer(buffer, 0, 16)
           .setDrawOffset(0);
     CORRADE_COMPARE(out.str(),
         "Shaders::FlatGL::bindTransformationProjectionBuffer(): the shader was not created with uniform buffers enabled\n"
@@ -1044,6 +1281,8 @@ template<UnsignedInt dimensions> void FlatGLTest::bindBufferUniformBuffersNotEna
         "Shaders::FlatGL::bindTextureTransformationBuffer(): the shader was not created with uniform buffers enabled\n"
         "Shaders::FlatGL::bindMaterialBuffer(): the shader was not created with uniform buffers enabled\n"
         "Shaders::FlatGL::bindMaterialBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::FlatGL::bindJointBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::FlatGL::bindJointBuffer(): the shader was not created with uniform buffers enabled\n"
         "Shaders::FlatGL::setDrawOffset(): the shader was not created with uniform buffers enabled\n");
 }
 #endif
@@ -1202,6 +1441,63 @@ template<UnsignedInt dimensions> void FlatGLTest::setWrongDrawOffset() {
     CORRADE_COMPARE(out.str(),
         "Shaders::FlatGL::setDrawOffset(): draw offset 5 is out of bounds for 5 draws\n");
 }
+
+template<UnsignedInt dimensions> void FlatGLTest::setWrongJointCountOrId() {
+    setTestCaseTemplateName(Utility::format("{}", dimensions));
+
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::gpu_shader4>())
+        CORRADE_SKIP(GL::Extensions::EXT::gpu_shader4::string() << "is not supported.");
+    #endif
+
+    FlatGL<dimensions> shader{typename FlatGL<dimensions>::Configuration{}
+        .setJointCount(5, 1)};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    /* Calling setJointMatrices() with less items is fine, tested in
+       renderSkinning2D() */
+    shader.setJointMatrices({
+            MatrixTypeFor<dimensions, Float>{},
+            MatrixTypeFor<dimensions, Float>{},
+            MatrixTypeFor<dimensions, Float>{},
+            MatrixTypeFor<dimensions, Float>{},
+            MatrixTypeFor<dimensions, Float>{},
+            MatrixTypeFor<dimensions, Float>{}})
+        .setJointMatrix(5, MatrixTypeFor<dimensions, Float>{});
+    CORRADE_COMPARE(out.str(),
+        "Shaders::FlatGL::setJointMatrices(): expected at most 5 items but got 6\n"
+        "Shaders::FlatGL::setJointMatrix(): joint ID 5 is out of bounds for 5 joints\n");
+}
+
+template<UnsignedInt dimensions> void FlatGLTest::setPerVertexJointCountInvalid() {
+    setTestCaseTemplateName(Utility::format("{}", dimensions));
+
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::gpu_shader4>())
+        CORRADE_SKIP(GL::Extensions::EXT::gpu_shader4::string() << "is not supported.");
+    #endif
+
+    FlatGL<dimensions> a{typename FlatGL<dimensions>::Configuration{}
+        .setJointCount(16, 3, 2)};
+    FlatGL<dimensions> b{typename FlatGL<dimensions>::Configuration{}
+        .setFlags(FlatGL<dimensions>::Flag::DynamicPerVertexJointCount)
+        .setJointCount(16, 3, 2)};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    a.setPerVertexJointCount(3, 2);
+    b.setPerVertexJointCount(4, 0);
+    b.setPerVertexJointCount(3, 3);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::FlatGL::setPerVertexJointCount(): the shader was not created with dynamic per-vertex joint count enabled\n"
+        "Shaders::FlatGL::setPerVertexJointCount(): expected at most 3 per-vertex joints, got 4\n"
+        "Shaders::FlatGL::setPerVertexJointCount(): expected at most 2 secondary per-vertex joints, got 3\n");
+}
 #endif
 
 constexpr Vector2i RenderSize{80, 80};
@@ -3324,6 +3620,106 @@ template<FlatGL3D::Flag flag> void FlatGLTest::renderInstanced3D() {
 }
 
 #ifndef MAGNUM_TARGET_GLES2
+template<FlatGL2D::Flag flag> void FlatGLTest::renderSkinning2D() {
+    auto&& data = RenderSkinningData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::gpu_shader4>())
+        CORRADE_SKIP(GL::Extensions::EXT::gpu_shader4::string() << "is not supported.");
+    #endif
+
+    if(flag == FlatGL2D::Flag::UniformBuffers) {
+        setTestCaseTemplateName("Flag::UniformBuffers");
+
+        #ifndef MAGNUM_TARGET_GLES
+        if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+            CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() << "is not supported.");
+        #endif
+    }
+
+    /* The joint translations cancel each other out with the weights used,
+       so the output should be the same as in renderColored2D(). The third
+       joint, if present, is garbage that should never get used. */
+    const Matrix3 jointMatrices[]{
+        Matrix3::translation(Vector2::xAxis(-1.0f)),
+        Matrix3::translation(Vector2::xAxis(1.0f)),
+        Matrix3::scaling(Vector2{100.0f})
+    };
+
+    Trade::MeshData circleData = Primitives::circle2DSolid(32);
+    GL::Mesh circle = MeshTools::compile(circleData);
+
+    struct Vertex {
+        Vector4ui jointIds;
+        Vector4 weights;
+        Vector4ui secondaryJointIds;
+        Vector4 secondaryWeights;
+    };
+    Containers::Array<Vertex> vertices{DirectInit, circleData.vertexCount(), Vertex{
+        data.jointIds, data.weights,
+        data.secondaryJointIds, data.secondaryWeights
+    }};
+    GL::Buffer vertexBuffer{GL::Buffer::TargetHint::Array, vertices};
+    if(data.perVertexJointCount)
+        circle.addVertexBuffer(vertexBuffer, 0, FlatGL2D::JointIds{}, FlatGL2D::Weights{}, sizeof(Vector4ui) + sizeof(Vector4));
+    if(data.secondaryPerVertexJointCount)
+        circle.addVertexBuffer(vertexBuffer, 0, sizeof(Vector4ui) + sizeof(Vector4), FlatGL2D::SecondaryJointIds{}, FlatGL2D::SecondaryWeights{});
+
+    FlatGL2D shader{FlatGL2D::Configuration{}
+        .setFlags(flag|data.flags)
+        /* With UBOs there's one extra joint at the front to test the joint
+           offset */
+        .setJointCount(data.jointCount + (flag == FlatGL2D::Flag::UniformBuffers ? 1 : 0), data.perVertexJointCount, data.secondaryPerVertexJointCount)};
+    if(data.flags >= FlatGL2D::Flag::DynamicPerVertexJointCount)
+        shader.setPerVertexJointCount(data.dynamicPerVertexJointCount, data.dynamicSecondaryPerVertexJointCount);
+
+    if(flag == FlatGL2D::Flag{}) {
+        shader
+            .setJointMatrices(Containers::arrayView(jointMatrices).prefix(data.jointCount))
+            .setColor(0x9999ff_rgbf)
+            .setTransformationProjectionMatrix(Matrix3::projection({2.1f, 2.1f}))
+            .draw(circle);
+    } else if(flag == FlatGL2D::Flag::UniformBuffers) {
+        GL::Buffer transformationProjectionUniform{GL::Buffer::TargetHint::Uniform, {
+            TransformationProjectionUniform2D{}
+                .setTransformationProjectionMatrix(Matrix3::projection({2.1f, 2.1f}))
+        }};
+        GL::Buffer drawUniform{GL::Buffer::TargetHint::Uniform, {
+            FlatDrawUniform{}
+                .setJointOffset(1)
+        }};
+        GL::Buffer materialUniform{GL::Buffer::TargetHint::Uniform, {
+            FlatMaterialUniform{}
+                .setColor(0x9999ff_rgbf)
+        }};
+        TransformationUniform2D jointUniformData[4];
+        jointUniformData[0].setTransformationMatrix(Matrix3::scaling(Vector2{100.0f}));
+        for(UnsignedInt i = 0; i != data.jointCount; ++i)
+            jointUniformData[i + 1].setTransformationMatrix(jointMatrices[i]);
+        GL::Buffer jointUniform{GL::Buffer::TargetHint::Uniform, Containers::arrayView(jointUniformData).prefix(data.jointCount + 1)};
+        shader
+            .bindTransformationProjectionBuffer(transformationProjectionUniform)
+            .bindDrawBuffer(drawUniform)
+            .bindMaterialBuffer(materialUniform)
+            .bindJointBuffer(jointUniform)
+            .draw(circle);
+    } else CORRADE_INTERNAL_ASSERT_UNREACHABLE();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    if(!(_manager.loadState("AnyImageImporter") & PluginManager::LoadState::Loaded) ||
+       !(_manager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("AnyImageImporter / TgaImporter plugins not found.");
+
+    CORRADE_COMPARE_WITH(
+        /* Dropping the alpha channel, as it's always 1.0 */
+        Containers::arrayCast<Color3ub>(_framebuffer.read(_framebuffer.viewport(), {PixelFormat::RGBA8Unorm}).pixels<Color4ub>()),
+        Utility::Path::join(_testDir, "FlatTestFiles/colored2D.tga"),
+        /* Minor differences due to the skin matrix being a weighted sum */
+        (DebugTools::CompareImageToFile{_manager, 0.34f, 0.01f}));
+}
+
 void FlatGLTest::renderMulti2D() {
     auto&& data = RenderMultiData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
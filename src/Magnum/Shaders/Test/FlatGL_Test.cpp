@@ -41,6 +41,12 @@ struct FlatGL_Test: TestSuite::Tester {
     template<UnsignedInt dimensions> void constructNoCreate();
     template<UnsignedInt dimensions> void constructCopy();
 
+    template<UnsignedInt dimensions> void configurationDefaults();
+    template<UnsignedInt dimensions> void configurationSetters();
+    #ifndef MAGNUM_TARGET_GLES2
+    template<UnsignedInt dimensions> void configurationSetJointCountInvalid();
+    #endif
+
     void debugFlag();
     void debugFlags();
     void debugFlagsSupersets();
@@ -53,6 +59,15 @@ FlatGL_Test::FlatGL_Test() {
               &FlatGL_Test::constructCopy<2>,
               &FlatGL_Test::constructCopy<3>,
 
+              &FlatGL_Test::configurationDefaults<2>,
+              &FlatGL_Test::configurationDefaults<3>,
+              &FlatGL_Test::configurationSetters<2>,
+              &FlatGL_Test::configurationSetters<3>,
+              #ifndef MAGNUM_TARGET_GLES2
+              &FlatGL_Test::configurationSetJointCountInvalid<2>,
+              &FlatGL_Test::configurationSetJointCountInvalid<3>,
+              #endif
+
               &FlatGL_Test::debugFlag,
               &FlatGL_Test::debugFlags,
               &FlatGL_Test::debugFlagsSupersets});
@@ -65,6 +80,13 @@ template<UnsignedInt dimensions> void FlatGL_Test::constructNoCreate() {
         FlatGL<dimensions> shader{NoCreate};
         CORRADE_COMPARE(shader.id(), 0);
         CORRADE_COMPARE(shader.flags(), typename FlatGL<dimensions>::Flags{});
+        #ifndef MAGNUM_TARGET_GLES2
+        CORRADE_COMPARE(shader.materialCount(), 0);
+        CORRADE_COMPARE(shader.drawCount(), 0);
+        CORRADE_COMPARE(shader.jointCount(), 0);
+        CORRADE_COMPARE(shader.perVertexJointCount(), 0);
+        CORRADE_COMPARE(shader.secondaryPerVertexJointCount(), 0);
+        #endif
     }
 
     CORRADE_VERIFY(true);
@@ -77,6 +99,66 @@ template<UnsignedInt dimensions> void FlatGL_Test::constructCopy() {
     CORRADE_VERIFY(!std::is_copy_assignable<FlatGL<dimensions>>{});
 }
 
+template<UnsignedInt dimensions> void FlatGL_Test::configurationDefaults() {
+    setTestCaseTemplateName(Utility::format("{}", dimensions));
+
+    typename FlatGL<dimensions>::Configuration configuration;
+    CORRADE_COMPARE(configuration.flags(), typename FlatGL<dimensions>::Flags{});
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_COMPARE(configuration.materialCount(), 1);
+    CORRADE_COMPARE(configuration.drawCount(), 1);
+    CORRADE_COMPARE(configuration.jointCount(), 0);
+    CORRADE_COMPARE(configuration.perVertexJointCount(), 0);
+    CORRADE_COMPARE(configuration.secondaryPerVertexJointCount(), 0);
+    #endif
+}
+
+template<UnsignedInt dimensions> void FlatGL_Test::configurationSetters() {
+    setTestCaseTemplateName(Utility::format("{}", dimensions));
+
+    typename FlatGL<dimensions>::Configuration configuration = typename FlatGL<dimensions>::Configuration{}
+        .setFlags(FlatGL<dimensions>::Flag::VertexColor|FlatGL<dimensions>::Flag::AlphaMask)
+        #ifndef MAGNUM_TARGET_GLES2
+        .setMaterialCount(5)
+        .setDrawCount(7)
+        .setJointCount(16, 4, 2)
+        #endif
+        ;
+    CORRADE_COMPARE(configuration.flags(), FlatGL<dimensions>::Flag::VertexColor|FlatGL<dimensions>::Flag::AlphaMask);
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_COMPARE(configuration.materialCount(), 5);
+    CORRADE_COMPARE(configuration.drawCount(), 7);
+    CORRADE_COMPARE(configuration.jointCount(), 16);
+    CORRADE_COMPARE(configuration.perVertexJointCount(), 4);
+    CORRADE_COMPARE(configuration.secondaryPerVertexJointCount(), 2);
+    #endif
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+template<UnsignedInt dimensions> void FlatGL_Test::configurationSetJointCountInvalid() {
+    setTestCaseTemplateName(Utility::format("{}", dimensions));
+
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    typename FlatGL<dimensions>::Configuration configuration;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    configuration
+        .setJointCount(16, 5, 0)
+        .setJointCount(16, 0, 5)
+        .setJointCount(0, 1, 0)
+        .setJointCount(0, 0, 1)
+        .setJointCount(16, 0, 0);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::FlatGL::Configuration::setJointCount(): expected at most 4 per-vertex joints, got 5\n"
+        "Shaders::FlatGL::Configuration::setJointCount(): expected at most 4 secondary per-vertex joints, got 5\n"
+        "Shaders::FlatGL::Configuration::setJointCount(): count can't be zero if per-vertex joint count is non-zero\n"
+        "Shaders::FlatGL::Configuration::setJointCount(): count can't be zero if per-vertex joint count is non-zero\n"
+        "Shaders::FlatGL::Configuration::setJointCount(): per-vertex joint count can't be zero if count is non-zero\n");
+}
+#endif
+
 void FlatGL_Test::debugFlag() {
     std::ostringstream out;
 
@@ -126,6 +208,16 @@ void FlatGL_Test::debugFlagsSupersets() {
         CORRADE_COMPARE(out.str(), "Shaders::FlatGL::Flag::MultiDraw\n");
     }
     #endif
+
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    /* VertexPulling is a superset of UniformBuffers so only one should be
+       printed */
+    {
+        std::ostringstream out;
+        Debug{&out} << (FlatGL3D::Flag::VertexPulling|FlatGL3D::Flag::UniformBuffers);
+        CORRADE_COMPARE(out.str(), "Shaders::FlatGL::Flag::VertexPulling\n");
+    }
+    #endif
 }
 
 }}}}
@@ -43,11 +43,16 @@ struct FlatTest: TestSuite::Tester {
     void materialUniformConstructDefault();
     void materialUniformConstructNoInit();
     void materialUniformSetters();
+
+    void materialTextureUniformConstructDefault();
+    void materialTextureUniformConstructNoInit();
+    void materialTextureUniformSetters();
 };
 
 FlatTest::FlatTest() {
     addTests({&FlatTest::uniformSizeAlignment<FlatDrawUniform>,
               &FlatTest::uniformSizeAlignment<FlatMaterialUniform>,
+              &FlatTest::uniformSizeAlignment<FlatMaterialTextureUniform>,
 
               &FlatTest::drawUniformConstructDefault,
               &FlatTest::drawUniformConstructNoInit,
@@ -56,7 +61,11 @@ FlatTest::FlatTest() {
 
               &FlatTest::materialUniformConstructDefault,
               &FlatTest::materialUniformConstructNoInit,
-              &FlatTest::materialUniformSetters});
+              &FlatTest::materialUniformSetters,
+
+              &FlatTest::materialTextureUniformConstructDefault,
+              &FlatTest::materialTextureUniformConstructNoInit,
+              &FlatTest::materialTextureUniformSetters});
 }
 
 using namespace Math::Literals;
@@ -68,6 +77,9 @@ template<> struct UniformTraits<FlatDrawUniform> {
 template<> struct UniformTraits<FlatMaterialUniform> {
     static const char* name() { return "FlatMaterialUniform"; }
 };
+template<> struct UniformTraits<FlatMaterialTextureUniform> {
+    static const char* name() { return "FlatMaterialTextureUniform"; }
+};
 
 template<class T> void FlatTest::uniformSizeAlignment() {
     setTestCaseTemplateName(UniformTraits<T>::name());
@@ -88,6 +100,8 @@ void FlatTest::drawUniformConstructDefault() {
     FlatDrawUniform b{DefaultInit};
     CORRADE_COMPARE(a.materialId, 0);
     CORRADE_COMPARE(b.materialId, 0);
+    CORRADE_COMPARE(a.jointOffset, 0);
+    CORRADE_COMPARE(b.jointOffset, 0);
     CORRADE_COMPARE(a.objectId, 0);
     CORRADE_COMPARE(b.objectId, 0);
 
@@ -95,6 +109,8 @@ void FlatTest::drawUniformConstructDefault() {
     constexpr FlatDrawUniform cb{DefaultInit};
     CORRADE_COMPARE(ca.materialId, 0);
     CORRADE_COMPARE(cb.materialId, 0);
+    CORRADE_COMPARE(ca.jointOffset, 0);
+    CORRADE_COMPARE(cb.jointOffset, 0);
     CORRADE_COMPARE(ca.objectId, 0);
     CORRADE_COMPARE(cb.objectId, 0);
 
@@ -132,8 +148,10 @@ void FlatTest::drawUniformConstructNoInit() {
 void FlatTest::drawUniformSetters() {
     FlatDrawUniform a;
     a.setMaterialId(5)
+     .setJointOffset(11)
      .setObjectId(7);
     CORRADE_COMPARE(a.materialId, 5);
+    CORRADE_COMPARE(a.jointOffset, 11);
     CORRADE_COMPARE(a.objectId, 7);
 }
 
@@ -143,6 +161,12 @@ void FlatTest::drawUniformMaterialIdPacking() {
     /* materialId should be right at the beginning, in the low 16 bits on both
        LE and BE */
     CORRADE_COMPARE(reinterpret_cast<UnsignedInt*>(&a)[0] & 0xffff, 13765);
+
+    a.setJointOffset(2765);
+    /* jointOffset should be right after materialId, in the high 16 bits on
+       both LE and BE */
+    CORRADE_COMPARE(reinterpret_cast<UnsignedInt*>(&a)[0] >> 16, 2765);
+    CORRADE_COMPARE(reinterpret_cast<UnsignedInt*>(&a)[0] & 0xffff, 13765);
 }
 
 void FlatTest::materialUniformConstructDefault() {
@@ -199,6 +223,60 @@ void FlatTest::materialUniformSetters() {
     CORRADE_COMPARE(a.alphaMask, 0.7f);
 }
 
+void FlatTest::materialTextureUniformConstructDefault() {
+    FlatMaterialTextureUniform a;
+    FlatMaterialTextureUniform b{DefaultInit};
+    CORRADE_COMPARE(a.textureHandle, Vector2ui{});
+    CORRADE_COMPARE(b.textureHandle, Vector2ui{});
+    CORRADE_COMPARE(a.objectIdTextureHandle, Vector2ui{});
+    CORRADE_COMPARE(b.objectIdTextureHandle, Vector2ui{});
+
+    constexpr FlatMaterialTextureUniform ca;
+    constexpr FlatMaterialTextureUniform cb{DefaultInit};
+    CORRADE_COMPARE(ca.textureHandle, Vector2ui{});
+    CORRADE_COMPARE(cb.textureHandle, Vector2ui{});
+    CORRADE_COMPARE(ca.objectIdTextureHandle, Vector2ui{});
+    CORRADE_COMPARE(cb.objectIdTextureHandle, Vector2ui{});
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<FlatMaterialTextureUniform>::value);
+    CORRADE_VERIFY(std::is_nothrow_constructible<FlatMaterialTextureUniform, DefaultInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<DefaultInitT, FlatMaterialTextureUniform>::value);
+}
+
+void FlatTest::materialTextureUniformConstructNoInit() {
+    FlatMaterialTextureUniform a;
+    a.textureHandle = {3, 5};
+    a.objectIdTextureHandle = {7, 9};
+
+    new(&a) FlatMaterialTextureUniform{NoInit};
+    {
+        /* Explicitly check we're not on Clang because certain Clang-based IDEs
+           inherit __GNUC__ if GCC is used instead of leaving it at 4 like
+           Clang itself does */
+        #if defined(CORRADE_TARGET_GCC) && !defined(CORRADE_TARGET_CLANG) && __GNUC__*100 + __GNUC_MINOR__ >= 601 && __OPTIMIZE__
+        CORRADE_EXPECT_FAIL("GCC 6.1+ misoptimizes and overwrites the value.");
+        #endif
+        CORRADE_COMPARE(a.textureHandle, (Vector2ui{3, 5}));
+        CORRADE_COMPARE(a.objectIdTextureHandle, (Vector2ui{7, 9}));
+    }
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<FlatMaterialTextureUniform, NoInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoInitT, FlatMaterialTextureUniform>::value);
+}
+
+void FlatTest::materialTextureUniformSetters() {
+    FlatMaterialTextureUniform a;
+    a.setTextureHandle(0x0000000500000003ull)
+     .setObjectIdTextureHandle(0x0000000900000007ull);
+    /* The low half is first */
+    CORRADE_COMPARE(a.textureHandle, (Vector2ui{3, 5}));
+    CORRADE_COMPARE(a.objectIdTextureHandle, (Vector2ui{7, 9}));
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Shaders::Test::FlatTest)
@@ -54,6 +54,10 @@ struct GenericTest: TestSuite::Tester {
     void textureTransformationUniformConstructDefault();
     void textureTransformationUniformConstructNoInit();
     void textureTransformationUniformSetters();
+
+    void vertexPullingUniformConstructDefault();
+    void vertexPullingUniformConstructNoInit();
+    void vertexPullingUniformSetters();
 };
 
 GenericTest::GenericTest() {
@@ -62,6 +66,7 @@ GenericTest::GenericTest() {
               &GenericTest::uniformSizeAlignment<TransformationUniform2D>,
               &GenericTest::uniformSizeAlignment<TransformationUniform3D>,
               &GenericTest::uniformSizeAlignment<TextureTransformationUniform>,
+              &GenericTest::uniformSizeAlignment<VertexPullingUniform>,
 
               &GenericTest::projectionUniform2DConstructDefault,
               &GenericTest::projectionUniform2DConstructNoInit,
@@ -81,7 +86,11 @@ GenericTest::GenericTest() {
 
               &GenericTest::textureTransformationUniformConstructDefault,
               &GenericTest::textureTransformationUniformConstructNoInit,
-              &GenericTest::textureTransformationUniformSetters});
+              &GenericTest::textureTransformationUniformSetters,
+
+              &GenericTest::vertexPullingUniformConstructDefault,
+              &GenericTest::vertexPullingUniformConstructNoInit,
+              &GenericTest::vertexPullingUniformSetters});
 }
 
 using namespace Math::Literals;
@@ -102,6 +111,9 @@ template<> struct UniformTraits<TransformationUniform3D> {
 template<> struct UniformTraits<TextureTransformationUniform> {
     static const char* name() { return "TextureTransformationUniform"; }
 };
+template<> struct UniformTraits<VertexPullingUniform> {
+    static const char* name() { return "VertexPullingUniform"; }
+};
 
 template<class T> void GenericTest::uniformSizeAlignment() {
     setTestCaseTemplateName(UniformTraits<T>::name());
@@ -453,6 +465,75 @@ void GenericTest::textureTransformationUniformSetters() {
     CORRADE_COMPARE(a.layer, 37);
 }
 
+void GenericTest::vertexPullingUniformConstructDefault() {
+    VertexPullingUniform a;
+    VertexPullingUniform b{DefaultInit};
+    CORRADE_COMPARE(a.positionOffset, 0);
+    CORRADE_COMPARE(b.positionOffset, 0);
+    CORRADE_COMPARE(a.normalOffset, 0);
+    CORRADE_COMPARE(b.normalOffset, 0);
+    CORRADE_COMPARE(a.textureCoordinatesOffset, 0);
+    CORRADE_COMPARE(b.textureCoordinatesOffset, 0);
+    CORRADE_COMPARE(a.colorOffset, 0);
+    CORRADE_COMPARE(b.colorOffset, 0);
+
+    constexpr VertexPullingUniform ca;
+    constexpr VertexPullingUniform cb{DefaultInit};
+    CORRADE_COMPARE(ca.positionOffset, 0);
+    CORRADE_COMPARE(cb.positionOffset, 0);
+    CORRADE_COMPARE(ca.normalOffset, 0);
+    CORRADE_COMPARE(cb.normalOffset, 0);
+    CORRADE_COMPARE(ca.textureCoordinatesOffset, 0);
+    CORRADE_COMPARE(cb.textureCoordinatesOffset, 0);
+    CORRADE_COMPARE(ca.colorOffset, 0);
+    CORRADE_COMPARE(cb.colorOffset, 0);
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<VertexPullingUniform>::value);
+    CORRADE_VERIFY(std::is_nothrow_constructible<VertexPullingUniform, DefaultInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<DefaultInitT, VertexPullingUniform>::value);
+}
+
+void GenericTest::vertexPullingUniformConstructNoInit() {
+    VertexPullingUniform a;
+    a.positionOffset = 5;
+    a.normalOffset = 17;
+    a.textureCoordinatesOffset = 26;
+    a.colorOffset = 37;
+
+    new(&a) VertexPullingUniform{NoInit};
+    {
+        /* Explicitly check we're not on Clang because certain Clang-based IDEs
+           inherit __GNUC__ if GCC is used instead of leaving it at 4 like
+           Clang itself does */
+        #if defined(CORRADE_TARGET_GCC) && !defined(CORRADE_TARGET_CLANG) && __GNUC__*100 + __GNUC_MINOR__ >= 601 && __OPTIMIZE__
+        CORRADE_EXPECT_FAIL("GCC 6.1+ misoptimizes and overwrites the value.");
+        #endif
+        CORRADE_COMPARE(a.positionOffset, 5);
+        CORRADE_COMPARE(a.normalOffset, 17);
+        CORRADE_COMPARE(a.textureCoordinatesOffset, 26);
+        CORRADE_COMPARE(a.colorOffset, 37);
+    }
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<VertexPullingUniform, NoInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoInitT, VertexPullingUniform>::value);
+}
+
+void GenericTest::vertexPullingUniformSetters() {
+    VertexPullingUniform a;
+    a.setPositionOffset(5)
+     .setNormalOffset(17)
+     .setTextureCoordinatesOffset(26)
+     .setColorOffset(37);
+    CORRADE_COMPARE(a.positionOffset, 5);
+    CORRADE_COMPARE(a.normalOffset, 17);
+    CORRADE_COMPARE(a.textureCoordinatesOffset, 26);
+    CORRADE_COMPARE(a.colorOffset, 37);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Shaders::Test::GenericTest)
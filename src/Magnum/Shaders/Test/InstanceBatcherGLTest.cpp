@@ -0,0 +1,220 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <vector>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/GL/Buffer.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/Mesh.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Shaders/InstanceBatcherGL.h"
+
+namespace Magnum { namespace Shaders { namespace Test { namespace {
+
+struct InstanceBatcherGLTest: GL::OpenGLTester {
+    explicit InstanceBatcherGLTest();
+
+    void add();
+    #ifndef MAGNUM_TARGET_GLES2
+    void addUniformBuffers();
+    #endif
+    void flush();
+    void flushEmpty();
+};
+
+InstanceBatcherGLTest::InstanceBatcherGLTest() {
+    addTests({&InstanceBatcherGLTest::add,
+              #ifndef MAGNUM_TARGET_GLES2
+              &InstanceBatcherGLTest::addUniformBuffers,
+              #endif
+              &InstanceBatcherGLTest::flush,
+              &InstanceBatcherGLTest::flushEmpty});
+}
+
+void InstanceBatcherGLTest::add() {
+    InstanceBatcherGL batcher;
+    PhongGL phong{PhongGL::Configuration{}
+        .setFlags(PhongGL::Flag::InstancedTransformation)};
+    FlatGL3D flat{FlatGL3D::Configuration{}
+        .setFlags(FlatGL3D::Flag::InstancedTransformation)};
+    GL::Mesh a{NoCreate}, b{NoCreate};
+
+    batcher
+        .add(phong, a, 0, Matrix4::translation(Vector3::xAxis()))
+        .add(phong, b, 0, Matrix4::translation(Vector3::yAxis()))
+        /* Same shader and mesh but a different material is a new batch */
+        .add(phong, a, 1, Matrix4::translation(Vector3::zAxis()))
+        /* Same mesh and material but a different shader is a new batch */
+        .add(flat, a, 0, Matrix4{})
+        /* Existing batches */
+        .add(phong, a, 0, Matrix4::scaling(Vector3{2.0f}))
+        .add(flat, a, 0, Matrix4{});
+    CORRADE_COMPARE(batcher.instanceCount(), 6);
+    CORRADE_COMPARE(batcher.batchCount(), 4);
+
+    batcher.clear();
+    CORRADE_COMPARE(batcher.instanceCount(), 0);
+    CORRADE_COMPARE(batcher.batchCount(), 0);
+
+    /* Adding after a clear starts from scratch */
+    batcher.add(flat, b, 3, Matrix4{});
+    CORRADE_COMPARE(batcher.instanceCount(), 1);
+    CORRADE_COMPARE(batcher.batchCount(), 1);
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+void InstanceBatcherGLTest::addUniformBuffers() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() << "is not supported.");
+    #endif
+
+    InstanceBatcherGL batcher;
+    PhongGL phong{PhongGL::Configuration{}
+        .setFlags(PhongGL::Flag::InstancedTransformation|PhongGL::Flag::UniformBuffers)};
+    FlatGL3D flat{FlatGL3D::Configuration{}
+        .setFlags(FlatGL3D::Flag::InstancedTransformation|FlatGL3D::Flag::UniformBuffers)};
+    GL::Mesh mesh{NoCreate};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    batcher.add(phong, mesh, 0, Matrix4{});
+    batcher.add(flat, mesh, 0, Matrix4{});
+    CORRADE_COMPARE(batcher.instanceCount(), 0);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::InstanceBatcherGL::add(): shaders with uniform buffers are not supported\n"
+        "Shaders::InstanceBatcherGL::add(): shaders with uniform buffers are not supported\n");
+}
+#endif
+
+void InstanceBatcherGLTest::flush() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::instanced_arrays>())
+        CORRADE_SKIP(GL::Extensions::ARB::instanced_arrays::string() << "is not supported.");
+    #elif defined(MAGNUM_TARGET_GLES2)
+    #ifndef MAGNUM_TARGET_WEBGL
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ANGLE::instanced_arrays>() &&
+       !GL::Context::current().isExtensionSupported<GL::Extensions::EXT::instanced_arrays>() &&
+       !GL::Context::current().isExtensionSupported<GL::Extensions::NV::instanced_arrays>())
+        CORRADE_SKIP("GL_{ANGLE,EXT,NV}_instanced_arrays is not supported");
+    #else
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ANGLE::instanced_arrays>())
+        CORRADE_SKIP(GL::Extensions::ANGLE::instanced_arrays::string() << "is not supported.");
+    #endif
+    #endif
+
+    GL::Buffer vertices{GL::Buffer::TargetHint::Array, {
+        Vector3{-1.0f, -1.0f, 0.0f},
+        Vector3{ 1.0f, -1.0f, 0.0f},
+        Vector3{ 0.0f,  1.0f, 0.0f}
+    }};
+    GL::Mesh a, b;
+    a.setCount(3)
+        .addVertexBuffer(vertices, 0, FlatGL3D::Position{});
+    b.setCount(3)
+        .addVertexBuffer(vertices, 0, FlatGL3D::Position{});
+
+    InstanceBatcherGL batcher;
+    batcher
+        .setupMesh(a)
+        .setupMesh(b);
+
+    PhongGL phong{PhongGL::Configuration{}
+        .setFlags(PhongGL::Flag::InstancedTransformation)};
+    FlatGL3D flat{FlatGL3D::Configuration{}
+        .setFlags(FlatGL3D::Flag::InstancedTransformation)};
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    std::vector<Containers::Pair<GL::AbstractShaderProgram*, UnsignedInt>> materials;
+    batcher.setMaterialCallback([](GL::AbstractShaderProgram& shader, UnsignedInt material, void* userData) {
+        static_cast<std::vector<Containers::Pair<GL::AbstractShaderProgram*, UnsignedInt>>*>(userData)->emplace_back(&shader, material);
+    }, &materials);
+
+    batcher
+        .add(phong, a, 7, Matrix4::translation(Vector3::xAxis()))
+        .add(flat, b, 3, Matrix4::translation(Vector3::yAxis()))
+        .add(phong, a, 7, Matrix4::translation(Vector3::zAxis()))
+        .add(phong, b, 7, Matrix4::scaling(Vector3{2.0f}))
+        .add(phong, a, 7, Matrix4::translation(-Vector3::xAxis()));
+    CORRADE_COMPARE(batcher.batchCount(), 3);
+
+    CORRADE_COMPARE(batcher.flush(Matrix4::perspectiveProjection(Deg(35.0f), 1.0f, 0.01f, 100.0f)), 3);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Material callback called once for each batch, in order of first
+       addition */
+    CORRADE_COMPARE(materials.size(), 3);
+    CORRADE_COMPARE(materials[0].first(), &phong);
+    CORRADE_COMPARE(materials[0].second(), 7);
+    CORRADE_COMPARE(materials[1].first(), &flat);
+    CORRADE_COMPARE(materials[1].second(), 3);
+    CORRADE_COMPARE(materials[2].first(), &phong);
+    CORRADE_COMPARE(materials[2].second(), 7);
+
+    /* Instance counts of the meshes are set to the last batch drawn with
+       them */
+    CORRADE_COMPARE(a.instanceCount(), 3);
+    CORRADE_COMPARE(b.instanceCount(), 1);
+
+    /* Everything is cleared after */
+    CORRADE_COMPARE(batcher.instanceCount(), 0);
+    CORRADE_COMPARE(batcher.batchCount(), 0);
+
+    #ifndef MAGNUM_TARGET_GLES
+    /* With base instance support, all instances are uploaded at once, sorted
+       by batch */
+    if(GL::Context::current().isExtensionSupported<GL::Extensions::ARB::base_instance>()) {
+        Containers::Array<char> data = batcher.instanceBuffer().data();
+        Containers::ArrayView<const InstanceBatcherGL::Instance> instances = Containers::arrayCast<const InstanceBatcherGL::Instance>(Containers::arrayView(data));
+        CORRADE_COMPARE(instances.size(), 5);
+        CORRADE_COMPARE(instances[0].transformationMatrix, Matrix4::translation(Vector3::xAxis()));
+        CORRADE_COMPARE(instances[1].transformationMatrix, Matrix4::translation(Vector3::zAxis()));
+        CORRADE_COMPARE(instances[2].transformationMatrix, Matrix4::translation(-Vector3::xAxis()));
+        CORRADE_COMPARE(instances[3].transformationMatrix, Matrix4::translation(Vector3::yAxis()));
+        CORRADE_COMPARE(instances[4].transformationMatrix, Matrix4::scaling(Vector3{2.0f}));
+        CORRADE_COMPARE(instances[4].normalMatrix, Matrix4::scaling(Vector3{2.0f}).normalMatrix());
+        CORRADE_COMPARE(a.baseInstance(), 0);
+        CORRADE_COMPARE(b.baseInstance(), 4);
+    }
+    #endif
+}
+
+void InstanceBatcherGLTest::flushEmpty() {
+    InstanceBatcherGL batcher;
+    CORRADE_COMPARE(batcher.flush(Matrix4{}), 0);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Shaders::Test::InstanceBatcherGLTest)
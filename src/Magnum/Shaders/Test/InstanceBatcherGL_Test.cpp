@@ -0,0 +1,121 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstddef>
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/GL/Mesh.h"
+#include "Magnum/Shaders/InstanceBatcherGL.h"
+
+namespace Magnum { namespace Shaders { namespace Test { namespace {
+
+/* There's an underscore between GL and Test to disambiguate from GLTest, which
+   is a common suffix used to mark tests that need a GL context. Ugly, I know. */
+struct InstanceBatcherGL_Test: TestSuite::Tester {
+    explicit InstanceBatcherGL_Test();
+
+    void constructNoCreate();
+    void constructCopy();
+
+    void instanceLayout();
+
+    void addNotInstanced();
+    void noCreate();
+};
+
+InstanceBatcherGL_Test::InstanceBatcherGL_Test() {
+    addTests({&InstanceBatcherGL_Test::constructNoCreate,
+              &InstanceBatcherGL_Test::constructCopy,
+
+              &InstanceBatcherGL_Test::instanceLayout,
+
+              &InstanceBatcherGL_Test::addNotInstanced,
+              &InstanceBatcherGL_Test::noCreate});
+}
+
+void InstanceBatcherGL_Test::constructNoCreate() {
+    {
+        InstanceBatcherGL batcher{NoCreate};
+        CORRADE_VERIFY(!batcher.instanceBuffer().id());
+        CORRADE_COMPARE(batcher.instanceCount(), 0);
+        CORRADE_COMPARE(batcher.batchCount(), 0);
+    }
+
+    CORRADE_VERIFY(true);
+}
+
+void InstanceBatcherGL_Test::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<InstanceBatcherGL>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<InstanceBatcherGL>{});
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<InstanceBatcherGL>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<InstanceBatcherGL>::value);
+}
+
+void InstanceBatcherGL_Test::instanceLayout() {
+    /* Has to match the attributes attached in setupMesh(), a 4x4 and a 3x3
+       float matrix tightly packed */
+    CORRADE_COMPARE(sizeof(InstanceBatcherGL::Instance), 16*4 + 9*4);
+    CORRADE_COMPARE(offsetof(InstanceBatcherGL::Instance, normalMatrix), sizeof(Matrix4));
+}
+
+void InstanceBatcherGL_Test::addNotInstanced() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    InstanceBatcherGL batcher{NoCreate};
+    /* Shaders constructed with NoCreate have no flags */
+    PhongGL phong{NoCreate};
+    FlatGL3D flat{NoCreate};
+    GL::Mesh mesh{NoCreate};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    batcher.add(phong, mesh, 0, Matrix4{});
+    batcher.add(flat, mesh, 0, Matrix4{});
+    CORRADE_COMPARE(batcher.instanceCount(), 0);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::InstanceBatcherGL::add(): the shader wasn't created with instanced transformation\n"
+        "Shaders::InstanceBatcherGL::add(): the shader wasn't created with instanced transformation\n");
+}
+
+void InstanceBatcherGL_Test::noCreate() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    InstanceBatcherGL batcher{NoCreate};
+    GL::Mesh mesh{NoCreate};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    batcher.setupMesh(mesh);
+    batcher.flush(Matrix4{});
+    CORRADE_COMPARE(out.str(),
+        "Shaders::InstanceBatcherGL::setupMesh(): the batcher was constructed with NoCreate\n"
+        "Shaders::InstanceBatcherGL::flush(): the batcher was constructed with NoCreate\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Shaders::Test::InstanceBatcherGL_Test)
@@ -0,0 +1,367 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/System.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/GL/Buffer.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/GL/Renderer.h"
+#include "Magnum/GL/Sampler.h"
+#include "Magnum/GL/Texture.h"
+#include "Magnum/GL/TextureFormat.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Shaders/InstanceCulling.h"
+#include "Magnum/Shaders/InstanceCullingGL.h"
+
+namespace Magnum { namespace Shaders { namespace Test { namespace {
+
+struct InstanceCullingGLTest: GL::OpenGLTester {
+    explicit InstanceCullingGLTest();
+
+    void construct();
+    void constructAsync();
+    void constructMove();
+
+    void bindHierarchicalZTextureInvalid();
+
+    void cull();
+    void cullHierarchicalZ();
+    void cullInvalid();
+};
+
+const struct {
+    const char* name;
+    InstanceCullingGL::Flags flags;
+} ConstructData[]{
+    {"", {}},
+    {"hierarchical Z", InstanceCullingGL::Flag::HierarchicalZ}
+};
+
+InstanceCullingGLTest::InstanceCullingGLTest() {
+    addInstancedTests({&InstanceCullingGLTest::construct},
+        Containers::arraySize(ConstructData));
+
+    addTests({&InstanceCullingGLTest::constructAsync,
+              &InstanceCullingGLTest::constructMove,
+
+              &InstanceCullingGLTest::bindHierarchicalZTextureInvalid,
+
+              &InstanceCullingGLTest::cull,
+              &InstanceCullingGLTest::cullHierarchicalZ,
+              &InstanceCullingGLTest::cullInvalid});
+}
+
+void InstanceCullingGLTest::construct() {
+    auto&& data = ConstructData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isVersionSupported(GL::Version::GL430))
+        CORRADE_SKIP(GL::Version::GL430 << "is not supported.");
+    #else
+    if(!GL::Context::current().isVersionSupported(GL::Version::GLES310))
+        CORRADE_SKIP(GL::Version::GLES310 << "is not supported.");
+    #endif
+
+    InstanceCullingGL shader{data.flags};
+    CORRADE_COMPARE(shader.flags(), data.flags);
+    CORRADE_VERIFY(shader.id());
+    {
+        #if defined(CORRADE_TARGET_APPLE) && !defined(MAGNUM_TARGET_GLES)
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void InstanceCullingGLTest::constructAsync() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isVersionSupported(GL::Version::GL430))
+        CORRADE_SKIP(GL::Version::GL430 << "is not supported.");
+    #else
+    if(!GL::Context::current().isVersionSupported(GL::Version::GLES310))
+        CORRADE_SKIP(GL::Version::GLES310 << "is not supported.");
+    #endif
+
+    InstanceCullingGL::CompileState state = InstanceCullingGL::compile(InstanceCullingGL::Flag::HierarchicalZ);
+    CORRADE_COMPARE(state.flags(), InstanceCullingGL::Flag::HierarchicalZ);
+
+    while(!state.isLinkFinished())
+        Utility::System::sleep(100);
+
+    InstanceCullingGL shader{std::move(state)};
+    CORRADE_COMPARE(shader.flags(), InstanceCullingGL::Flag::HierarchicalZ);
+    CORRADE_VERIFY(shader.id());
+    {
+        #if defined(CORRADE_TARGET_APPLE) && !defined(MAGNUM_TARGET_GLES)
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void InstanceCullingGLTest::constructMove() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isVersionSupported(GL::Version::GL430))
+        CORRADE_SKIP(GL::Version::GL430 << "is not supported.");
+    #else
+    if(!GL::Context::current().isVersionSupported(GL::Version::GLES310))
+        CORRADE_SKIP(GL::Version::GLES310 << "is not supported.");
+    #endif
+
+    InstanceCullingGL a{InstanceCullingGL::Flag::HierarchicalZ};
+    const GLuint id = a.id();
+    CORRADE_VERIFY(id);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    InstanceCullingGL b{std::move(a)};
+    CORRADE_COMPARE(b.id(), id);
+    CORRADE_COMPARE(b.flags(), InstanceCullingGL::Flag::HierarchicalZ);
+    CORRADE_VERIFY(!a.id());
+
+    InstanceCullingGL c{NoCreate};
+    c = std::move(b);
+    CORRADE_COMPARE(c.id(), id);
+    CORRADE_COMPARE(c.flags(), InstanceCullingGL::Flag::HierarchicalZ);
+    CORRADE_VERIFY(!b.id());
+}
+
+void InstanceCullingGLTest::bindHierarchicalZTextureInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isVersionSupported(GL::Version::GL430))
+        CORRADE_SKIP(GL::Version::GL430 << "is not supported.");
+    #else
+    if(!GL::Context::current().isVersionSupported(GL::Version::GLES310))
+        CORRADE_SKIP(GL::Version::GLES310 << "is not supported.");
+    #endif
+
+    GL::Texture2D texture;
+    InstanceCullingGL shader;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    shader.bindHierarchicalZTexture(texture);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::InstanceCullingGL::bindHierarchicalZTexture(): the shader was not created with hierarchical Z enabled\n");
+}
+
+/* Transformation matrix followed by an ID that's copied to the output
+   verbatim, padded to a multiple of vec4 */
+struct Instance {
+    Matrix4 transformationMatrix;
+    UnsignedInt id;
+    UnsignedInt padding[3];
+};
+
+void InstanceCullingGLTest::cull() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isVersionSupported(GL::Version::GL430))
+        CORRADE_SKIP(GL::Version::GL430 << "is not supported.");
+    #else
+    if(!GL::Context::current().isVersionSupported(GL::Version::GLES310))
+        CORRADE_SKIP(GL::Version::GLES310 << "is not supported.");
+    #endif
+
+    /* A 4x4 box going from 1 to 11 units in front of the camera */
+    const Matrix4 projection = Matrix4::orthographicProjection({4.0f, 4.0f}, 1.0f, 11.0f);
+    GL::Buffer instanceCullingUniform{GL::Buffer::TargetHint::Uniform, {
+        InstanceCullingUniform{}
+            .setFrustum(Frustum::fromMatrix(projection))
+            .setInstanceStride(sizeof(Instance)/4)
+    }};
+
+    /* First draw has the first instance in the center, second fully outside
+       and third crossing the edge only thanks to its scale. Second draw has
+       a single instance behind the camera. */
+    GL::Buffer drawUniform{GL::Buffer::TargetHint::ShaderStorage, {
+        InstanceCullingDrawUniform{}
+            .setBoundingSphere({}, 0.5f)
+            .setInstanceRange(0, 3)
+            .setOutputOffset(0)
+            .setCommandOffset(0),
+        InstanceCullingDrawUniform{}
+            .setBoundingSphere({}, 0.5f)
+            .setInstanceRange(3, 1)
+            .setOutputOffset(3)
+            .setCommandOffset(5)
+    }};
+    GL::Buffer inputInstances{GL::Buffer::TargetHint::ShaderStorage, {
+        Instance{Matrix4::translation({0.0f, 0.0f, -5.0f}), 0, {}},
+        Instance{Matrix4::translation({10.0f, 0.0f, -5.0f}), 1, {}},
+        Instance{Matrix4::translation({2.8f, 0.0f, -5.0f})*Matrix4::scaling(Vector3{2.0f}), 2, {}},
+        Instance{Matrix4::translation({0.0f, 0.0f, 5.0f}), 3, {}}
+    }};
+    GL::Buffer outputInstances{GL::Buffer::TargetHint::ShaderStorage};
+    outputInstances.setData({nullptr, 4*sizeof(Instance)}, GL::BufferUsage::DynamicRead);
+
+    /* Two indexed draw commands, the instance count is filled with garbage
+       to verify it gets reset */
+    GL::Buffer commands{GL::Buffer::TargetHint::ShaderStorage, {
+        36u, 777u, 0u, 0u, 0u,
+        36u, 777u, 0u, 0u, 0u
+    }};
+
+    InstanceCullingGL shader;
+    shader.bindInstanceCullingBuffer(instanceCullingUniform)
+        .bindDrawBuffer(drawUniform)
+        .bindInputInstanceBuffer(inputInstances)
+        .bindOutputInstanceBuffer(outputInstances)
+        .bindCommandBuffer(commands)
+        .cull(2, 3);
+    GL::Renderer::setMemoryBarrier(GL::Renderer::MemoryBarrier::BufferUpdate);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Containers::ArrayView<const UnsignedInt> commandData = Containers::arrayCast<const UnsignedInt>(commands.mapRead(0, 10*sizeof(UnsignedInt)));
+    CORRADE_VERIFY(commandData);
+    CORRADE_COMPARE_AS(commandData, Containers::arrayView<UnsignedInt>({
+        36u, 2u, 0u, 0u, 0u,
+        36u, 0u, 0u, 0u, 0u
+    }), TestSuite::Compare::Container);
+    CORRADE_VERIFY(commands.unmap());
+
+    /* The output order isn't deterministic */
+    Containers::ArrayView<const Instance> output = Containers::arrayCast<const Instance>(outputInstances.mapRead(0, 2*sizeof(Instance)));
+    CORRADE_VERIFY(output);
+    const std::size_t first = output[0].id == 0 ? 0 : 1;
+    CORRADE_COMPARE(output[first].id, 0);
+    CORRADE_COMPARE(output[first].transformationMatrix, Matrix4::translation({0.0f, 0.0f, -5.0f}));
+    CORRADE_COMPARE(output[1 - first].id, 2);
+    CORRADE_COMPARE(output[1 - first].transformationMatrix, Matrix4::translation({2.8f, 0.0f, -5.0f})*Matrix4::scaling(Vector3{2.0f}));
+    CORRADE_VERIFY(outputInstances.unmap());
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void InstanceCullingGLTest::cullHierarchicalZ() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isVersionSupported(GL::Version::GL430))
+        CORRADE_SKIP(GL::Version::GL430 << "is not supported.");
+    #else
+    if(!GL::Context::current().isVersionSupported(GL::Version::GLES310))
+        CORRADE_SKIP(GL::Version::GLES310 << "is not supported.");
+    #endif
+
+    /* Depth goes linearly from 0 at 1 unit in front of the camera to 1 at
+       11 units. A single-texel pyramid with the depth in the middle thus
+       occludes everything farther than 6 units. */
+    const Matrix4 projection = Matrix4::orthographicProjection({4.0f, 4.0f}, 1.0f, 11.0f);
+    GL::Buffer instanceCullingUniform{GL::Buffer::TargetHint::Uniform, {
+        InstanceCullingUniform{}
+            .setFrustum(Frustum::fromMatrix(projection))
+            .setProjectionMatrix(projection)
+            .setHierarchicalZSize({1.0f, 1.0f})
+            .setInstanceStride(sizeof(Instance)/4)
+    }};
+    GL::Buffer drawUniform{GL::Buffer::TargetHint::ShaderStorage, {
+        InstanceCullingDrawUniform{}
+            .setBoundingSphere({}, 0.5f)
+            .setInstanceRange(0, 3)
+    }};
+    GL::Buffer inputInstances{GL::Buffer::TargetHint::ShaderStorage, {
+        Instance{Matrix4::translation({0.0f, 0.0f, -3.0f}), 0, {}},
+        Instance{Matrix4::translation({0.0f, 0.0f, -9.0f}), 1, {}},
+        /* Occluded only partially */
+        Instance{Matrix4::translation({0.0f, 0.0f, -6.2f}), 2, {}}
+    }};
+    GL::Buffer outputInstances{GL::Buffer::TargetHint::ShaderStorage};
+    outputInstances.setData({nullptr, 3*sizeof(Instance)}, GL::BufferUsage::DynamicRead);
+    GL::Buffer commands{GL::Buffer::TargetHint::ShaderStorage, {
+        36u, 777u, 0u, 0u, 0u
+    }};
+
+    const Float depth[]{0.5f};
+    GL::Texture2D hierarchicalZ;
+    hierarchicalZ.setMinificationFilter(GL::SamplerFilter::Nearest, GL::SamplerMipmap::Nearest)
+        .setMagnificationFilter(GL::SamplerFilter::Nearest)
+        .setWrapping(GL::SamplerWrapping::ClampToEdge)
+        .setStorage(1, GL::TextureFormat::R32F, {1, 1})
+        .setSubImage(0, {}, ImageView2D{PixelFormat::R32F, {1, 1}, depth});
+
+    InstanceCullingGL shader{InstanceCullingGL::Flag::HierarchicalZ};
+    shader.bindInstanceCullingBuffer(instanceCullingUniform)
+        .bindDrawBuffer(drawUniform)
+        .bindInputInstanceBuffer(inputInstances)
+        .bindOutputInstanceBuffer(outputInstances)
+        .bindCommandBuffer(commands)
+        .bindHierarchicalZTexture(hierarchicalZ)
+        .cull(1, 3);
+    GL::Renderer::setMemoryBarrier(GL::Renderer::MemoryBarrier::BufferUpdate);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Containers::ArrayView<const UnsignedInt> commandData = Containers::arrayCast<const UnsignedInt>(commands.mapRead(0, 5*sizeof(UnsignedInt)));
+    CORRADE_VERIFY(commandData);
+    CORRADE_COMPARE(commandData[1], 2);
+    CORRADE_VERIFY(commands.unmap());
+
+    Containers::ArrayView<const Instance> output = Containers::arrayCast<const Instance>(outputInstances.mapRead(0, 2*sizeof(Instance)));
+    CORRADE_VERIFY(output);
+    CORRADE_COMPARE(output[0].id + output[1].id, 0 + 2);
+    CORRADE_VERIFY(outputInstances.unmap());
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void InstanceCullingGLTest::cullInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isVersionSupported(GL::Version::GL430))
+        CORRADE_SKIP(GL::Version::GL430 << "is not supported.");
+    #else
+    if(!GL::Context::current().isVersionSupported(GL::Version::GLES310))
+        CORRADE_SKIP(GL::Version::GLES310 << "is not supported.");
+    #endif
+
+    InstanceCullingGL shader;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    shader.cull(0, 1000)
+        .cull(16, 0);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::InstanceCullingGL::cull(): expected non-zero draw and instance count but got 0 and 1000\n"
+        "Shaders::InstanceCullingGL::cull(): expected non-zero draw and instance count but got 16 and 0\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Shaders::Test::InstanceCullingGLTest)
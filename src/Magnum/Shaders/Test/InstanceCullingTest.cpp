@@ -0,0 +1,216 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <new>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Shaders/InstanceCulling.h"
+
+namespace Magnum { namespace Shaders { namespace Test { namespace {
+
+struct InstanceCullingTest: TestSuite::Tester {
+    explicit InstanceCullingTest();
+
+    template<class T> void uniformSizeAlignment();
+
+    void uniformConstructDefault();
+    void uniformConstructNoInit();
+    void uniformSetters();
+
+    void drawUniformConstructDefault();
+    void drawUniformConstructNoInit();
+    void drawUniformSetters();
+};
+
+template<class> struct UniformTraits;
+template<> struct UniformTraits<InstanceCullingUniform> {
+    static const char* name() { return "InstanceCullingUniform"; }
+};
+template<> struct UniformTraits<InstanceCullingDrawUniform> {
+    static const char* name() { return "InstanceCullingDrawUniform"; }
+};
+
+InstanceCullingTest::InstanceCullingTest() {
+    addTests({&InstanceCullingTest::uniformSizeAlignment<InstanceCullingUniform>,
+              &InstanceCullingTest::uniformSizeAlignment<InstanceCullingDrawUniform>,
+
+              &InstanceCullingTest::uniformConstructDefault,
+              &InstanceCullingTest::uniformConstructNoInit,
+              &InstanceCullingTest::uniformSetters,
+
+              &InstanceCullingTest::drawUniformConstructDefault,
+              &InstanceCullingTest::drawUniformConstructNoInit,
+              &InstanceCullingTest::drawUniformSetters});
+}
+
+template<class T> void InstanceCullingTest::uniformSizeAlignment() {
+    setTestCaseTemplateName(UniformTraits<T>::name());
+
+    CORRADE_FAIL_IF(sizeof(T) % sizeof(Vector4) != 0, sizeof(T) << "is not a multiple of vec4 for UBO alignment.");
+    CORRADE_COMPARE(alignof(T), 4);
+}
+
+void InstanceCullingTest::uniformConstructDefault() {
+    InstanceCullingUniform a;
+    InstanceCullingUniform b{DefaultInit};
+    CORRADE_COMPARE(a.frustum, Frustum{});
+    CORRADE_COMPARE(b.frustum, Frustum{});
+    CORRADE_COMPARE(a.projectionMatrix, Matrix4{});
+    CORRADE_COMPARE(b.projectionMatrix, Matrix4{});
+    CORRADE_COMPARE(a.hierarchicalZSize, (Vector2{1.0f, 1.0f}));
+    CORRADE_COMPARE(b.hierarchicalZSize, (Vector2{1.0f, 1.0f}));
+    CORRADE_COMPARE(a.instanceStride, 16);
+    CORRADE_COMPARE(b.instanceStride, 16);
+
+    constexpr InstanceCullingUniform ca;
+    constexpr InstanceCullingUniform cb{DefaultInit};
+    CORRADE_COMPARE(ca.frustum, Frustum{});
+    CORRADE_COMPARE(cb.frustum, Frustum{});
+    CORRADE_COMPARE(ca.projectionMatrix, Matrix4{});
+    CORRADE_COMPARE(cb.projectionMatrix, Matrix4{});
+    CORRADE_COMPARE(ca.hierarchicalZSize, (Vector2{1.0f, 1.0f}));
+    CORRADE_COMPARE(cb.hierarchicalZSize, (Vector2{1.0f, 1.0f}));
+    CORRADE_COMPARE(ca.instanceStride, 16);
+    CORRADE_COMPARE(cb.instanceStride, 16);
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<InstanceCullingUniform>::value);
+    CORRADE_VERIFY(std::is_nothrow_constructible<InstanceCullingUniform, DefaultInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<DefaultInitT, InstanceCullingUniform>::value);
+}
+
+void InstanceCullingTest::uniformConstructNoInit() {
+    /* Testing only some fields, should be enough */
+    InstanceCullingUniform a;
+    a.hierarchicalZSize = {1024.0f, 512.0f};
+    a.instanceStride = 28;
+
+    new(&a) InstanceCullingUniform{NoInit};
+    {
+        /* Explicitly check we're not on Clang because certain Clang-based IDEs
+           inherit __GNUC__ if GCC is used instead of leaving it at 4 like
+           Clang itself does */
+        #if defined(CORRADE_TARGET_GCC) && !defined(CORRADE_TARGET_CLANG) && __GNUC__*100 + __GNUC_MINOR__ >= 601 && __OPTIMIZE__
+        CORRADE_EXPECT_FAIL("GCC 6.1+ misoptimizes and overwrites the value.");
+        #endif
+        CORRADE_COMPARE(a.hierarchicalZSize, (Vector2{1024.0f, 512.0f}));
+        CORRADE_COMPARE(a.instanceStride, 28);
+    }
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<InstanceCullingUniform, NoInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoInitT, InstanceCullingUniform>::value);
+}
+
+void InstanceCullingTest::uniformSetters() {
+    const Frustum frustum = Frustum::fromMatrix(Matrix4::orthographicProjection({4.0f, 2.0f}, 0.5f, 10.0f));
+
+    InstanceCullingUniform a;
+    a.setFrustum(frustum)
+     .setProjectionMatrix(Matrix4::scaling({2.0f, 3.0f, 4.0f}))
+     .setHierarchicalZSize({1024.0f, 512.0f})
+     .setInstanceStride(28);
+    CORRADE_COMPARE(a.frustum, frustum);
+    CORRADE_COMPARE(a.projectionMatrix, Matrix4::scaling({2.0f, 3.0f, 4.0f}));
+    CORRADE_COMPARE(a.hierarchicalZSize, (Vector2{1024.0f, 512.0f}));
+    CORRADE_COMPARE(a.instanceStride, 28);
+}
+
+void InstanceCullingTest::drawUniformConstructDefault() {
+    InstanceCullingDrawUniform a;
+    InstanceCullingDrawUniform b{DefaultInit};
+    CORRADE_COMPARE(a.boundingSphere, (Vector4{0.0f, 0.0f, 0.0f, 1.0f}));
+    CORRADE_COMPARE(b.boundingSphere, (Vector4{0.0f, 0.0f, 0.0f, 1.0f}));
+    CORRADE_COMPARE(a.instanceOffset, 0);
+    CORRADE_COMPARE(b.instanceOffset, 0);
+    CORRADE_COMPARE(a.instanceCount, 0);
+    CORRADE_COMPARE(b.instanceCount, 0);
+    CORRADE_COMPARE(a.outputOffset, 0);
+    CORRADE_COMPARE(b.outputOffset, 0);
+    CORRADE_COMPARE(a.commandOffset, 0);
+    CORRADE_COMPARE(b.commandOffset, 0);
+
+    constexpr InstanceCullingDrawUniform ca;
+    constexpr InstanceCullingDrawUniform cb{DefaultInit};
+    CORRADE_COMPARE(ca.boundingSphere, (Vector4{0.0f, 0.0f, 0.0f, 1.0f}));
+    CORRADE_COMPARE(cb.boundingSphere, (Vector4{0.0f, 0.0f, 0.0f, 1.0f}));
+    CORRADE_COMPARE(ca.instanceOffset, 0);
+    CORRADE_COMPARE(cb.instanceOffset, 0);
+    CORRADE_COMPARE(ca.instanceCount, 0);
+    CORRADE_COMPARE(cb.instanceCount, 0);
+    CORRADE_COMPARE(ca.outputOffset, 0);
+    CORRADE_COMPARE(cb.outputOffset, 0);
+    CORRADE_COMPARE(ca.commandOffset, 0);
+    CORRADE_COMPARE(cb.commandOffset, 0);
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<InstanceCullingDrawUniform>::value);
+    CORRADE_VERIFY(std::is_nothrow_constructible<InstanceCullingDrawUniform, DefaultInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<DefaultInitT, InstanceCullingDrawUniform>::value);
+}
+
+void InstanceCullingTest::drawUniformConstructNoInit() {
+    /* Testing only some fields, should be enough */
+    InstanceCullingDrawUniform a;
+    a.boundingSphere = {1.0f, 2.0f, 3.0f, 0.5f};
+    a.commandOffset = 15;
+
+    new(&a) InstanceCullingDrawUniform{NoInit};
+    {
+        /* Explicitly check we're not on Clang because certain Clang-based IDEs
+           inherit __GNUC__ if GCC is used instead of leaving it at 4 like
+           Clang itself does */
+        #if defined(CORRADE_TARGET_GCC) && !defined(CORRADE_TARGET_CLANG) && __GNUC__*100 + __GNUC_MINOR__ >= 601 && __OPTIMIZE__
+        CORRADE_EXPECT_FAIL("GCC 6.1+ misoptimizes and overwrites the value.");
+        #endif
+        CORRADE_COMPARE(a.boundingSphere, (Vector4{1.0f, 2.0f, 3.0f, 0.5f}));
+        CORRADE_COMPARE(a.commandOffset, 15);
+    }
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<InstanceCullingDrawUniform, NoInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoInitT, InstanceCullingDrawUniform>::value);
+}
+
+void InstanceCullingTest::drawUniformSetters() {
+    InstanceCullingDrawUniform a;
+    a.setBoundingSphere({1.0f, 2.0f, 3.0f}, 0.5f)
+     .setInstanceRange(1000, 250)
+     .setOutputOffset(3000)
+     .setCommandOffset(15);
+    CORRADE_COMPARE(a.boundingSphere, (Vector4{1.0f, 2.0f, 3.0f, 0.5f}));
+    CORRADE_COMPARE(a.instanceOffset, 1000);
+    CORRADE_COMPARE(a.instanceCount, 250);
+    CORRADE_COMPARE(a.outputOffset, 3000);
+    CORRADE_COMPARE(a.commandOffset, 15);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Shaders::Test::InstanceCullingTest)
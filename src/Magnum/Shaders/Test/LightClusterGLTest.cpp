@@ -0,0 +1,288 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/System.h>
+
+#include "Magnum/GL/Buffer.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/GL/Renderer.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Shaders/LightCluster.h"
+#include "Magnum/Shaders/LightClusterGL.h"
+#include "Magnum/Shaders/Phong.h"
+
+namespace Magnum { namespace Shaders { namespace Test { namespace {
+
+struct LightClusterGLTest: GL::OpenGLTester {
+    explicit LightClusterGLTest();
+
+    void construct();
+    void constructAsync();
+    void constructMove();
+    void constructInvalid();
+
+    void dispatch();
+    void dispatchOverflow();
+    void dispatchInvalid();
+};
+
+using namespace Math::Literals;
+
+LightClusterGLTest::LightClusterGLTest() {
+    addTests({&LightClusterGLTest::construct,
+              &LightClusterGLTest::constructAsync,
+              &LightClusterGLTest::constructMove,
+              &LightClusterGLTest::constructInvalid,
+
+              &LightClusterGLTest::dispatch,
+              &LightClusterGLTest::dispatchOverflow,
+              &LightClusterGLTest::dispatchInvalid});
+}
+
+void LightClusterGLTest::construct() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isVersionSupported(GL::Version::GL430))
+        CORRADE_SKIP(GL::Version::GL430 << "is not supported.");
+    #else
+    if(!GL::Context::current().isVersionSupported(GL::Version::GLES310))
+        CORRADE_SKIP(GL::Version::GLES310 << "is not supported.");
+    #endif
+
+    LightClusterGL shader{32};
+    CORRADE_COMPARE(shader.maxLightsPerCluster(), 32);
+    CORRADE_VERIFY(shader.id());
+    {
+        #if defined(CORRADE_TARGET_APPLE) && !defined(MAGNUM_TARGET_GLES)
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void LightClusterGLTest::constructAsync() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isVersionSupported(GL::Version::GL430))
+        CORRADE_SKIP(GL::Version::GL430 << "is not supported.");
+    #else
+    if(!GL::Context::current().isVersionSupported(GL::Version::GLES310))
+        CORRADE_SKIP(GL::Version::GLES310 << "is not supported.");
+    #endif
+
+    LightClusterGL::CompileState state = LightClusterGL::compile(32);
+    CORRADE_COMPARE(state.maxLightsPerCluster(), 32);
+
+    while(!state.isLinkFinished())
+        Utility::System::sleep(100);
+
+    LightClusterGL shader{std::move(state)};
+    CORRADE_COMPARE(shader.maxLightsPerCluster(), 32);
+    CORRADE_VERIFY(shader.id());
+    {
+        #if defined(CORRADE_TARGET_APPLE) && !defined(MAGNUM_TARGET_GLES)
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void LightClusterGLTest::constructMove() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isVersionSupported(GL::Version::GL430))
+        CORRADE_SKIP(GL::Version::GL430 << "is not supported.");
+    #else
+    if(!GL::Context::current().isVersionSupported(GL::Version::GLES310))
+        CORRADE_SKIP(GL::Version::GLES310 << "is not supported.");
+    #endif
+
+    LightClusterGL a{32};
+    const GLuint id = a.id();
+    CORRADE_VERIFY(id);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    LightClusterGL b{std::move(a)};
+    CORRADE_COMPARE(b.id(), id);
+    CORRADE_COMPARE(b.maxLightsPerCluster(), 32);
+    CORRADE_VERIFY(!a.id());
+
+    LightClusterGL c{NoCreate};
+    c = std::move(b);
+    CORRADE_COMPARE(c.id(), id);
+    CORRADE_COMPARE(c.maxLightsPerCluster(), 32);
+    CORRADE_VERIFY(!b.id());
+}
+
+void LightClusterGLTest::constructInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    LightClusterGL{0};
+    CORRADE_COMPARE(out.str(),
+        "Shaders::LightClusterGL: max lights per cluster can't be zero\n");
+}
+
+void LightClusterGLTest::dispatch() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isVersionSupported(GL::Version::GL430))
+        CORRADE_SKIP(GL::Version::GL430 << "is not supported.");
+    #else
+    if(!GL::Context::current().isVersionSupported(GL::Version::GLES310))
+        CORRADE_SKIP(GL::Version::GLES310 << "is not supported.");
+    #endif
+
+    /* A single cluster covering the whole frustum. The directional light and
+       the point light in front of the camera get assigned to it, the point
+       light behind the camera doesn't. */
+    GL::Buffer lightClusterUniform{GL::Buffer::TargetHint::Uniform, {
+        LightClusterUniform{}
+            .setInverseProjectionMatrix(Matrix4::perspectiveProjection(60.0_degf, 1.0f, 0.1f, 10.0f).inverted())
+            .setClusterCount({1, 1, 1})
+            .setLightCount(3)
+            .setViewportSize({80.0f, 80.0f})
+            .setDepthRange(0.1f, 10.0f)
+    }};
+    GL::Buffer lights{GL::Buffer::TargetHint::ShaderStorage, {
+        PhongLightUniform{}
+            .setPosition({0.0f, 0.0f, 1.0f, 0.0f}),
+        PhongLightUniform{}
+            .setPosition({0.0f, 0.0f, -5.0f, 1.0f})
+            .setRange(1.0f),
+        PhongLightUniform{}
+            .setPosition({0.0f, 0.0f, 5.0f, 1.0f})
+            .setRange(1.0f)
+    }};
+    GL::Buffer clusterLightRanges{GL::Buffer::TargetHint::ShaderStorage};
+    clusterLightRanges.setData({nullptr, 2*sizeof(UnsignedInt)}, GL::BufferUsage::DynamicRead);
+    GL::Buffer clusterLightIndices{GL::Buffer::TargetHint::ShaderStorage};
+    clusterLightIndices.setData({nullptr, 4*sizeof(UnsignedInt)}, GL::BufferUsage::DynamicRead);
+
+    LightClusterGL shader{4};
+    shader.bindLightClusterBuffer(lightClusterUniform)
+        .bindLightBuffer(lights)
+        .bindClusterLightRangeBuffer(clusterLightRanges)
+        .bindClusterLightIndexBuffer(clusterLightIndices)
+        .dispatch({1, 1, 1});
+    GL::Renderer::setMemoryBarrier(GL::Renderer::MemoryBarrier::BufferUpdate);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Containers::ArrayView<const UnsignedInt> ranges = Containers::arrayCast<const UnsignedInt>(clusterLightRanges.mapRead(0, 2*sizeof(UnsignedInt)));
+    CORRADE_VERIFY(ranges);
+    CORRADE_COMPARE(ranges[0], 0);
+    CORRADE_COMPARE(ranges[1], 2);
+    CORRADE_VERIFY(clusterLightRanges.unmap());
+
+    Containers::ArrayView<const UnsignedInt> indices = Containers::arrayCast<const UnsignedInt>(clusterLightIndices.mapRead(0, 2*sizeof(UnsignedInt)));
+    CORRADE_VERIFY(indices);
+    CORRADE_COMPARE(indices[0], 0);
+    CORRADE_COMPARE(indices[1], 1);
+    CORRADE_VERIFY(clusterLightIndices.unmap());
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void LightClusterGLTest::dispatchOverflow() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isVersionSupported(GL::Version::GL430))
+        CORRADE_SKIP(GL::Version::GL430 << "is not supported.");
+    #else
+    if(!GL::Context::current().isVersionSupported(GL::Version::GLES310))
+        CORRADE_SKIP(GL::Version::GLES310 << "is not supported.");
+    #endif
+
+    /* Five directional lights affecting everything, only the first three fit
+       into the slot */
+    GL::Buffer lightClusterUniform{GL::Buffer::TargetHint::Uniform, {
+        LightClusterUniform{}
+            .setInverseProjectionMatrix(Matrix4::perspectiveProjection(60.0_degf, 1.0f, 0.1f, 10.0f).inverted())
+            .setClusterCount({1, 1, 1})
+            .setLightCount(5)
+            .setViewportSize({80.0f, 80.0f})
+            .setDepthRange(0.1f, 10.0f)
+    }};
+    GL::Buffer lights{GL::Buffer::TargetHint::ShaderStorage, {
+        PhongLightUniform{}.setPosition({0.0f, 0.0f, 1.0f, 0.0f}),
+        PhongLightUniform{}.setPosition({0.0f, 1.0f, 0.0f, 0.0f}),
+        PhongLightUniform{}.setPosition({1.0f, 0.0f, 0.0f, 0.0f}),
+        PhongLightUniform{}.setPosition({0.0f, 0.0f, -1.0f, 0.0f}),
+        PhongLightUniform{}.setPosition({0.0f, -1.0f, 0.0f, 0.0f})
+    }};
+    GL::Buffer clusterLightRanges{GL::Buffer::TargetHint::ShaderStorage};
+    clusterLightRanges.setData({nullptr, 2*sizeof(UnsignedInt)}, GL::BufferUsage::DynamicRead);
+    GL::Buffer clusterLightIndices{GL::Buffer::TargetHint::ShaderStorage};
+    clusterLightIndices.setData({nullptr, 3*sizeof(UnsignedInt)}, GL::BufferUsage::DynamicRead);
+
+    LightClusterGL shader{3};
+    shader.bindLightClusterBuffer(lightClusterUniform)
+        .bindLightBuffer(lights)
+        .bindClusterLightRangeBuffer(clusterLightRanges)
+        .bindClusterLightIndexBuffer(clusterLightIndices)
+        .dispatch({1, 1, 1});
+    GL::Renderer::setMemoryBarrier(GL::Renderer::MemoryBarrier::BufferUpdate);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Containers::ArrayView<const UnsignedInt> ranges = Containers::arrayCast<const UnsignedInt>(clusterLightRanges.mapRead(0, 2*sizeof(UnsignedInt)));
+    CORRADE_VERIFY(ranges);
+    CORRADE_COMPARE(ranges[0], 0);
+    CORRADE_COMPARE(ranges[1], 3);
+    CORRADE_VERIFY(clusterLightRanges.unmap());
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void LightClusterGLTest::dispatchInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isVersionSupported(GL::Version::GL430))
+        CORRADE_SKIP(GL::Version::GL430 << "is not supported.");
+    #else
+    if(!GL::Context::current().isVersionSupported(GL::Version::GLES310))
+        CORRADE_SKIP(GL::Version::GLES310 << "is not supported.");
+    #endif
+
+    LightClusterGL shader;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    shader.dispatch({16, 0, 24});
+    CORRADE_COMPARE(out.str(),
+        "Shaders::LightClusterGL::dispatch(): expected a non-zero cluster count but got {16, 0, 24}\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Shaders::Test::LightClusterGLTest)
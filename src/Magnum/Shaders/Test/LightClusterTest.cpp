@@ -0,0 +1,139 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <new>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Shaders/LightCluster.h"
+
+namespace Magnum { namespace Shaders { namespace Test { namespace {
+
+struct LightClusterTest: TestSuite::Tester {
+    explicit LightClusterTest();
+
+    void uniformSizeAlignment();
+
+    void uniformConstructDefault();
+    void uniformConstructNoInit();
+    void uniformSetters();
+};
+
+LightClusterTest::LightClusterTest() {
+    addTests({&LightClusterTest::uniformSizeAlignment,
+
+              &LightClusterTest::uniformConstructDefault,
+              &LightClusterTest::uniformConstructNoInit,
+              &LightClusterTest::uniformSetters});
+}
+
+void LightClusterTest::uniformSizeAlignment() {
+    CORRADE_FAIL_IF(sizeof(LightClusterUniform) % sizeof(Vector4) != 0, sizeof(LightClusterUniform) << "is not a multiple of vec4 for UBO alignment.");
+
+    /* The structure is used only as a single instance, so it doesn't need to
+       fit exactly into the UBO alignment */
+    CORRADE_COMPARE(sizeof(LightClusterUniform), 96);
+    CORRADE_COMPARE(alignof(LightClusterUniform), 4);
+}
+
+void LightClusterTest::uniformConstructDefault() {
+    LightClusterUniform a;
+    LightClusterUniform b{DefaultInit};
+    CORRADE_COMPARE(a.inverseProjectionMatrix, Matrix4{});
+    CORRADE_COMPARE(b.inverseProjectionMatrix, Matrix4{});
+    CORRADE_COMPARE(a.clusterCount, (Vector3ui{16, 9, 24}));
+    CORRADE_COMPARE(b.clusterCount, (Vector3ui{16, 9, 24}));
+    CORRADE_COMPARE(a.lightCount, 0);
+    CORRADE_COMPARE(b.lightCount, 0);
+    CORRADE_COMPARE(a.viewportSize, (Vector2{1.0f, 1.0f}));
+    CORRADE_COMPARE(b.viewportSize, (Vector2{1.0f, 1.0f}));
+    CORRADE_COMPARE(a.near, 0.01f);
+    CORRADE_COMPARE(b.near, 0.01f);
+    CORRADE_COMPARE(a.far, 100.0f);
+    CORRADE_COMPARE(b.far, 100.0f);
+
+    constexpr LightClusterUniform ca;
+    constexpr LightClusterUniform cb{DefaultInit};
+    CORRADE_COMPARE(ca.inverseProjectionMatrix, Matrix4{});
+    CORRADE_COMPARE(cb.inverseProjectionMatrix, Matrix4{});
+    CORRADE_COMPARE(ca.clusterCount, (Vector3ui{16, 9, 24}));
+    CORRADE_COMPARE(cb.clusterCount, (Vector3ui{16, 9, 24}));
+    CORRADE_COMPARE(ca.lightCount, 0);
+    CORRADE_COMPARE(cb.lightCount, 0);
+    CORRADE_COMPARE(ca.viewportSize, (Vector2{1.0f, 1.0f}));
+    CORRADE_COMPARE(cb.viewportSize, (Vector2{1.0f, 1.0f}));
+    CORRADE_COMPARE(ca.near, 0.01f);
+    CORRADE_COMPARE(cb.near, 0.01f);
+    CORRADE_COMPARE(ca.far, 100.0f);
+    CORRADE_COMPARE(cb.far, 100.0f);
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<LightClusterUniform>::value);
+    CORRADE_VERIFY(std::is_nothrow_constructible<LightClusterUniform, DefaultInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<DefaultInitT, LightClusterUniform>::value);
+}
+
+void LightClusterTest::uniformConstructNoInit() {
+    /* Testing only some fields, should be enough */
+    LightClusterUniform a;
+    a.clusterCount = {8, 4, 16};
+    a.far = 250.0f;
+
+    new(&a) LightClusterUniform{NoInit};
+    {
+        /* Explicitly check we're not on Clang because certain Clang-based IDEs
+           inherit __GNUC__ if GCC is used instead of leaving it at 4 like
+           Clang itself does */
+        #if defined(CORRADE_TARGET_GCC) && !defined(CORRADE_TARGET_CLANG) && __GNUC__*100 + __GNUC_MINOR__ >= 601 && __OPTIMIZE__
+        CORRADE_EXPECT_FAIL("GCC 6.1+ misoptimizes and overwrites the value.");
+        #endif
+        CORRADE_COMPARE(a.clusterCount, (Vector3ui{8, 4, 16}));
+        CORRADE_COMPARE(a.far, 250.0f);
+    }
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<LightClusterUniform, NoInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoInitT, LightClusterUniform>::value);
+}
+
+void LightClusterTest::uniformSetters() {
+    LightClusterUniform a;
+    a.setInverseProjectionMatrix(Matrix4::scaling({2.0f, 3.0f, 4.0f}))
+     .setClusterCount({8, 4, 16})
+     .setLightCount(3500)
+     .setViewportSize({1920.0f, 1080.0f})
+     .setDepthRange(0.5f, 250.0f);
+    CORRADE_COMPARE(a.inverseProjectionMatrix, Matrix4::scaling({2.0f, 3.0f, 4.0f}));
+    CORRADE_COMPARE(a.clusterCount, (Vector3ui{8, 4, 16}));
+    CORRADE_COMPARE(a.lightCount, 3500);
+    CORRADE_COMPARE(a.viewportSize, (Vector2{1920.0f, 1080.0f}));
+    CORRADE_COMPARE(a.near, 0.5f);
+    CORRADE_COMPARE(a.far, 250.0f);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Shaders::Test::LightClusterTest)
@@ -32,10 +32,10 @@
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/FormatStl.h>
 #include <Corrade/Utility/Path.h>
+#include <Corrade/Utility/System.h>
 
 #ifdef CORRADE_TARGET_APPLE
 #include <Corrade/Containers/Pair.h>
-#include <Corrade/Utility/System.h> /* isSandboxed() */
 #endif
 
 #include "Magnum/DebugTools/ColorMap.h"
@@ -105,10 +105,21 @@ struct MeshVisualizerGLTest: GL::OpenGLTester {
     void constructUniformBuffers3DInvalid();
     #endif
 
+    void constructAsync2D();
+    #ifndef MAGNUM_TARGET_GLES2
+    void constructUniformBuffersAsync2D();
+    #endif
+
     void constructMove2D();
     #ifndef MAGNUM_TARGET_GLES2
     void constructMoveUniformBuffers2D();
     #endif
+
+    void constructAsync3D();
+    #ifndef MAGNUM_TARGET_GLES2
+    void constructUniformBuffersAsync3D();
+    #endif
+
     void constructMove3D();
     #ifndef MAGNUM_TARGET_GLES2
     void constructMoveUniformBuffers3D();
@@ -1085,10 +1096,21 @@ MeshVisualizerGLTest::MeshVisualizerGLTest() {
     #endif
 
     addTests({
+        &MeshVisualizerGLTest::constructAsync2D,
+        #ifndef MAGNUM_TARGET_GLES2
+        &MeshVisualizerGLTest::constructUniformBuffersAsync2D,
+        #endif
+
         &MeshVisualizerGLTest::constructMove2D,
         #ifndef MAGNUM_TARGET_GLES2
         &MeshVisualizerGLTest::constructMoveUniformBuffers2D,
         #endif
+
+        &MeshVisualizerGLTest::constructAsync3D,
+        #ifndef MAGNUM_TARGET_GLES2
+        &MeshVisualizerGLTest::constructUniformBuffersAsync3D,
+        #endif
+
         &MeshVisualizerGLTest::constructMove3D,
         #ifndef MAGNUM_TARGET_GLES2
         &MeshVisualizerGLTest::constructMoveUniformBuffers3D,
@@ -1682,6 +1704,83 @@ void MeshVisualizerGLTest::constructUniformBuffers3DInvalid() {
 }
 #endif
 
+void MeshVisualizerGLTest::constructAsync2D() {
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::geometry_shader4>())
+        CORRADE_SKIP(GL::Extensions::ARB::geometry_shader4::string() << "is not supported.");
+    #else
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::geometry_shader>())
+        CORRADE_SKIP(GL::Extensions::EXT::geometry_shader::string() << "is not supported.");
+    #endif
+    const MeshVisualizerGL2D::Flags flags = MeshVisualizerGL2D::Flag::Wireframe;
+    #else
+    const MeshVisualizerGL2D::Flags flags = MeshVisualizerGL2D::Flag::Wireframe|MeshVisualizerGL2D::Flag::NoGeometryShader;
+    #endif
+
+    MeshVisualizerGL2D::CompileState state = MeshVisualizerGL2D::compile(flags);
+    CORRADE_COMPARE(state.flags(), flags);
+
+    while(!state.isLinkFinished())
+        Utility::System::sleep(100);
+
+    MeshVisualizerGL2D shader{std::move(state)};
+    CORRADE_COMPARE(shader.flags(), flags);
+    CORRADE_VERIFY(shader.id());
+    {
+        #if defined(CORRADE_TARGET_APPLE) && !defined(MAGNUM_TARGET_GLES)
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+void MeshVisualizerGLTest::constructUniformBuffersAsync2D() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() << "is not supported.");
+    #endif
+
+    #ifndef MAGNUM_TARGET_WEBGL
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::geometry_shader4>())
+        CORRADE_SKIP(GL::Extensions::ARB::geometry_shader4::string() << "is not supported.");
+    #else
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::geometry_shader>())
+        CORRADE_SKIP(GL::Extensions::EXT::geometry_shader::string() << "is not supported.");
+    #endif
+    const MeshVisualizerGL2D::Flags flags = MeshVisualizerGL2D::Flag::UniformBuffers|MeshVisualizerGL2D::Flag::Wireframe;
+    #else
+    const MeshVisualizerGL2D::Flags flags = MeshVisualizerGL2D::Flag::UniformBuffers|MeshVisualizerGL2D::Flag::Wireframe|MeshVisualizerGL2D::Flag::NoGeometryShader;
+    #endif
+
+    MeshVisualizerGL2D::CompileState state = MeshVisualizerGL2D::compile(flags, 4, 5);
+    CORRADE_COMPARE(state.flags(), flags);
+    CORRADE_COMPARE(state.materialCount(), 4);
+    CORRADE_COMPARE(state.drawCount(), 5);
+
+    while(!state.isLinkFinished())
+        Utility::System::sleep(100);
+
+    MeshVisualizerGL2D shader{std::move(state)};
+    CORRADE_COMPARE(shader.flags(), flags);
+    CORRADE_COMPARE(shader.materialCount(), 4);
+    CORRADE_COMPARE(shader.drawCount(), 5);
+    CORRADE_VERIFY(shader.id());
+    {
+        #if defined(CORRADE_TARGET_APPLE) && !defined(MAGNUM_TARGET_GLES)
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+#endif
+
 void MeshVisualizerGLTest::constructMove2D() {
     MeshVisualizerGL2D a{MeshVisualizerGL2D::Flag::Wireframe|MeshVisualizerGL2D::Flag::NoGeometryShader};
     const GLuint id = a.id();
@@ -1731,6 +1830,83 @@ void MeshVisualizerGLTest::constructMoveUniformBuffers2D() {
 }
 #endif
 
+void MeshVisualizerGLTest::constructAsync3D() {
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::geometry_shader4>())
+        CORRADE_SKIP(GL::Extensions::ARB::geometry_shader4::string() << "is not supported.");
+    #else
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::geometry_shader>())
+        CORRADE_SKIP(GL::Extensions::EXT::geometry_shader::string() << "is not supported.");
+    #endif
+    const MeshVisualizerGL3D::Flags flags = MeshVisualizerGL3D::Flag::Wireframe;
+    #else
+    const MeshVisualizerGL3D::Flags flags = MeshVisualizerGL3D::Flag::Wireframe|MeshVisualizerGL3D::Flag::NoGeometryShader;
+    #endif
+
+    MeshVisualizerGL3D::CompileState state = MeshVisualizerGL3D::compile(flags);
+    CORRADE_COMPARE(state.flags(), flags);
+
+    while(!state.isLinkFinished())
+        Utility::System::sleep(100);
+
+    MeshVisualizerGL3D shader{std::move(state)};
+    CORRADE_COMPARE(shader.flags(), flags);
+    CORRADE_VERIFY(shader.id());
+    {
+        #if defined(CORRADE_TARGET_APPLE) && !defined(MAGNUM_TARGET_GLES)
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+void MeshVisualizerGLTest::constructUniformBuffersAsync3D() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() << "is not supported.");
+    #endif
+
+    #ifndef MAGNUM_TARGET_WEBGL
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::geometry_shader4>())
+        CORRADE_SKIP(GL::Extensions::ARB::geometry_shader4::string() << "is not supported.");
+    #else
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::geometry_shader>())
+        CORRADE_SKIP(GL::Extensions::EXT::geometry_shader::string() << "is not supported.");
+    #endif
+    const MeshVisualizerGL3D::Flags flags = MeshVisualizerGL3D::Flag::UniformBuffers|MeshVisualizerGL3D::Flag::Wireframe;
+    #else
+    const MeshVisualizerGL3D::Flags flags = MeshVisualizerGL3D::Flag::UniformBuffers|MeshVisualizerGL3D::Flag::Wireframe|MeshVisualizerGL3D::Flag::NoGeometryShader;
+    #endif
+
+    MeshVisualizerGL3D::CompileState state = MeshVisualizerGL3D::compile(flags, 4, 5);
+    CORRADE_COMPARE(state.flags(), flags);
+    CORRADE_COMPARE(state.materialCount(), 4);
+    CORRADE_COMPARE(state.drawCount(), 5);
+
+    while(!state.isLinkFinished())
+        Utility::System::sleep(100);
+
+    MeshVisualizerGL3D shader{std::move(state)};
+    CORRADE_COMPARE(shader.flags(), flags);
+    CORRADE_COMPARE(shader.materialCount(), 4);
+    CORRADE_COMPARE(shader.drawCount(), 5);
+    CORRADE_VERIFY(shader.id());
+    {
+        #if defined(CORRADE_TARGET_APPLE) && !defined(MAGNUM_TARGET_GLES)
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+#endif
+
 void MeshVisualizerGLTest::constructMove3D() {
     MeshVisualizerGL3D a{MeshVisualizerGL3D::Flag::Wireframe|MeshVisualizerGL3D::Flag::NoGeometryShader};
     const GLuint id = a.id();
@@ -0,0 +1,437 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/FormatStl.h>
+#include <Corrade/Utility/System.h>
+
+#include "Magnum/GL/Buffer.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/GL/Renderer.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Shaders/MeshVisualizerPrepassGL.h"
+
+namespace Magnum { namespace Shaders { namespace Test { namespace {
+
+using namespace Math::Literals;
+
+struct MeshVisualizerPrepassGLTest: GL::OpenGLTester {
+    explicit MeshVisualizerPrepassGLTest();
+
+    void construct();
+    void constructAsync();
+    void constructMove();
+    void constructInvalid();
+
+    void bindBufferNotEnabled();
+    void setLineLengthNotEnabled();
+
+    void generateWireframe();
+    void generateLines();
+    void generateLinesBitangent();
+    void generateInvalid();
+};
+
+const struct {
+    const char* name;
+    MeshVisualizerPrepassGL::Flags flags;
+    UnsignedInt lineCountPerVertex;
+} ConstructData[]{
+    {"wireframe", MeshVisualizerPrepassGL::Flag::Wireframe, 0},
+    {"tangent direction", MeshVisualizerPrepassGL::Flag::TangentDirection, 1},
+    {"bitangent from tangent direction", MeshVisualizerPrepassGL::Flag::BitangentFromTangentDirection, 1},
+    {"bitangent direction", MeshVisualizerPrepassGL::Flag::BitangentDirection, 1},
+    {"normal direction", MeshVisualizerPrepassGL::Flag::NormalDirection, 1},
+    {"wireframe + TBN", MeshVisualizerPrepassGL::Flag::Wireframe|MeshVisualizerPrepassGL::Flag::TangentDirection|MeshVisualizerPrepassGL::Flag::BitangentFromTangentDirection|MeshVisualizerPrepassGL::Flag::NormalDirection, 3}
+};
+
+const struct {
+    const char* name;
+    MeshVisualizerPrepassGL::Flags flags;
+    const char* message;
+} ConstructInvalidData[]{
+    {"no feature enabled", {},
+        "at least one visualization feature has to be enabled"},
+    {"both bitangent variants enabled", MeshVisualizerPrepassGL::Flag::BitangentDirection|MeshVisualizerPrepassGL::Flag::BitangentFromTangentDirection,
+        "Flag::BitangentDirection and Flag::BitangentFromTangentDirection are mutually exclusive"}
+};
+
+MeshVisualizerPrepassGLTest::MeshVisualizerPrepassGLTest() {
+    addInstancedTests({&MeshVisualizerPrepassGLTest::construct},
+        Containers::arraySize(ConstructData));
+
+    addTests({&MeshVisualizerPrepassGLTest::constructAsync,
+              &MeshVisualizerPrepassGLTest::constructMove});
+
+    addInstancedTests({&MeshVisualizerPrepassGLTest::constructInvalid},
+        Containers::arraySize(ConstructInvalidData));
+
+    addTests({&MeshVisualizerPrepassGLTest::bindBufferNotEnabled,
+              &MeshVisualizerPrepassGLTest::setLineLengthNotEnabled,
+
+              &MeshVisualizerPrepassGLTest::generateWireframe,
+              &MeshVisualizerPrepassGLTest::generateLines,
+              &MeshVisualizerPrepassGLTest::generateLinesBitangent,
+              &MeshVisualizerPrepassGLTest::generateInvalid});
+}
+
+void MeshVisualizerPrepassGLTest::construct() {
+    auto&& data = ConstructData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isVersionSupported(GL::Version::GL430))
+        CORRADE_SKIP(GL::Version::GL430 << "is not supported.");
+    #else
+    if(!GL::Context::current().isVersionSupported(GL::Version::GLES310))
+        CORRADE_SKIP(GL::Version::GLES310 << "is not supported.");
+    #endif
+
+    MeshVisualizerPrepassGL shader{data.flags};
+    CORRADE_COMPARE(shader.flags(), data.flags);
+    CORRADE_COMPARE(shader.lineCountPerVertex(), data.lineCountPerVertex);
+    CORRADE_VERIFY(shader.id());
+    {
+        #if defined(CORRADE_TARGET_APPLE) && !defined(MAGNUM_TARGET_GLES)
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void MeshVisualizerPrepassGLTest::constructAsync() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isVersionSupported(GL::Version::GL430))
+        CORRADE_SKIP(GL::Version::GL430 << "is not supported.");
+    #else
+    if(!GL::Context::current().isVersionSupported(GL::Version::GLES310))
+        CORRADE_SKIP(GL::Version::GLES310 << "is not supported.");
+    #endif
+
+    MeshVisualizerPrepassGL::CompileState state = MeshVisualizerPrepassGL::compile(MeshVisualizerPrepassGL::Flag::Wireframe|MeshVisualizerPrepassGL::Flag::NormalDirection);
+    CORRADE_COMPARE(state.flags(), MeshVisualizerPrepassGL::Flag::Wireframe|MeshVisualizerPrepassGL::Flag::NormalDirection);
+
+    while(!state.isLinkFinished())
+        Utility::System::sleep(100);
+
+    MeshVisualizerPrepassGL shader{std::move(state)};
+    CORRADE_COMPARE(shader.flags(), MeshVisualizerPrepassGL::Flag::Wireframe|MeshVisualizerPrepassGL::Flag::NormalDirection);
+    CORRADE_VERIFY(shader.id());
+    {
+        #if defined(CORRADE_TARGET_APPLE) && !defined(MAGNUM_TARGET_GLES)
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void MeshVisualizerPrepassGLTest::constructMove() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isVersionSupported(GL::Version::GL430))
+        CORRADE_SKIP(GL::Version::GL430 << "is not supported.");
+    #else
+    if(!GL::Context::current().isVersionSupported(GL::Version::GLES310))
+        CORRADE_SKIP(GL::Version::GLES310 << "is not supported.");
+    #endif
+
+    MeshVisualizerPrepassGL a{MeshVisualizerPrepassGL::Flag::Wireframe};
+    const GLuint id = a.id();
+    CORRADE_VERIFY(id);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    MeshVisualizerPrepassGL b{std::move(a)};
+    CORRADE_COMPARE(b.id(), id);
+    CORRADE_COMPARE(b.flags(), MeshVisualizerPrepassGL::Flag::Wireframe);
+    CORRADE_VERIFY(!a.id());
+
+    MeshVisualizerPrepassGL c{NoCreate};
+    c = std::move(b);
+    CORRADE_COMPARE(c.id(), id);
+    CORRADE_COMPARE(c.flags(), MeshVisualizerPrepassGL::Flag::Wireframe);
+    CORRADE_VERIFY(!b.id());
+}
+
+void MeshVisualizerPrepassGLTest::constructInvalid() {
+    auto&& data = ConstructInvalidData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshVisualizerPrepassGL{data.flags};
+    CORRADE_COMPARE(out.str(), Utility::formatString(
+        "Shaders::MeshVisualizerPrepassGL: {}\n", data.message));
+}
+
+void MeshVisualizerPrepassGLTest::bindBufferNotEnabled() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isVersionSupported(GL::Version::GL430))
+        CORRADE_SKIP(GL::Version::GL430 << "is not supported.");
+    #else
+    if(!GL::Context::current().isVersionSupported(GL::Version::GLES310))
+        CORRADE_SKIP(GL::Version::GLES310 << "is not supported.");
+    #endif
+
+    GL::Buffer buffer{GL::Buffer::TargetHint::ShaderStorage};
+    MeshVisualizerPrepassGL wireframe{MeshVisualizerPrepassGL::Flag::Wireframe};
+    MeshVisualizerPrepassGL normal{MeshVisualizerPrepassGL::Flag::NormalDirection};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    normal.bindIndexBuffer(buffer)
+        .bindIndexBuffer(buffer, 0, 16)
+        .bindWireframeBuffer(buffer)
+        .bindWireframeBuffer(buffer, 0, 16)
+        .bindTangentBuffer(buffer)
+        .bindTangentBuffer(buffer, 0, 16)
+        .bindBitangentBuffer(buffer)
+        .bindBitangentBuffer(buffer, 0, 16);
+    wireframe.bindNormalBuffer(buffer)
+        .bindNormalBuffer(buffer, 0, 16)
+        .bindLineBuffer(buffer)
+        .bindLineBuffer(buffer, 0, 16);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::MeshVisualizerPrepassGL::bindIndexBuffer(): the shader was not created with wireframe enabled\n"
+        "Shaders::MeshVisualizerPrepassGL::bindIndexBuffer(): the shader was not created with wireframe enabled\n"
+        "Shaders::MeshVisualizerPrepassGL::bindWireframeBuffer(): the shader was not created with wireframe enabled\n"
+        "Shaders::MeshVisualizerPrepassGL::bindWireframeBuffer(): the shader was not created with wireframe enabled\n"
+        "Shaders::MeshVisualizerPrepassGL::bindTangentBuffer(): the shader was not created with tangent direction enabled\n"
+        "Shaders::MeshVisualizerPrepassGL::bindTangentBuffer(): the shader was not created with tangent direction enabled\n"
+        "Shaders::MeshVisualizerPrepassGL::bindBitangentBuffer(): the shader was not created with bitangent direction enabled\n"
+        "Shaders::MeshVisualizerPrepassGL::bindBitangentBuffer(): the shader was not created with bitangent direction enabled\n"
+        "Shaders::MeshVisualizerPrepassGL::bindNormalBuffer(): the shader was not created with normal direction enabled\n"
+        "Shaders::MeshVisualizerPrepassGL::bindNormalBuffer(): the shader was not created with normal direction enabled\n"
+        "Shaders::MeshVisualizerPrepassGL::bindLineBuffer(): the shader was not created with TBN direction enabled\n"
+        "Shaders::MeshVisualizerPrepassGL::bindLineBuffer(): the shader was not created with TBN direction enabled\n");
+}
+
+void MeshVisualizerPrepassGLTest::setLineLengthNotEnabled() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isVersionSupported(GL::Version::GL430))
+        CORRADE_SKIP(GL::Version::GL430 << "is not supported.");
+    #else
+    if(!GL::Context::current().isVersionSupported(GL::Version::GLES310))
+        CORRADE_SKIP(GL::Version::GLES310 << "is not supported.");
+    #endif
+
+    MeshVisualizerPrepassGL shader{MeshVisualizerPrepassGL::Flag::Wireframe};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    shader.setLineLength(2.0f);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::MeshVisualizerPrepassGL::setLineLength(): the shader was not created with TBN direction enabled\n");
+}
+
+void MeshVisualizerPrepassGLTest::generateWireframe() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isVersionSupported(GL::Version::GL430))
+        CORRADE_SKIP(GL::Version::GL430 << "is not supported.");
+    #else
+    if(!GL::Context::current().isVersionSupported(GL::Version::GLES310))
+        CORRADE_SKIP(GL::Version::GLES310 << "is not supported.");
+    #endif
+
+    /* A quad made of two triangles sharing two vertices */
+    GL::Buffer positions{GL::Buffer::TargetHint::ShaderStorage, {
+        Vector3{-1.0f, -1.0f, 0.0f},
+        Vector3{ 1.0f, -1.0f, 0.0f},
+        Vector3{-1.0f,  1.0f, 0.0f},
+        Vector3{ 1.0f,  1.0f, 0.5f}
+    }};
+    GL::Buffer indices{GL::Buffer::TargetHint::ShaderStorage, {
+        0u, 1u, 2u, 2u, 1u, 3u
+    }};
+    GL::Buffer wireframe{GL::Buffer::TargetHint::ShaderStorage};
+    wireframe.setData({nullptr, 6*sizeof(Vector3)}, GL::BufferUsage::DynamicRead);
+
+    MeshVisualizerPrepassGL shader{MeshVisualizerPrepassGL::Flag::Wireframe};
+    shader.bindPositionBuffer(positions)
+        .bindIndexBuffer(indices)
+        .bindWireframeBuffer(wireframe)
+        .generate(4, 6);
+    GL::Renderer::setMemoryBarrier(GL::Renderer::MemoryBarrier::BufferUpdate);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Containers::ArrayView<const Vector3> output = Containers::arrayCast<const Vector3>(wireframe.mapRead(0, 6*sizeof(Vector3)));
+    CORRADE_VERIFY(output);
+    CORRADE_COMPARE_AS(output, Containers::arrayView<Vector3>({
+        {-1.0f, -1.0f, 0.0f},
+        { 1.0f, -1.0f, 0.0f},
+        {-1.0f,  1.0f, 0.0f},
+        {-1.0f,  1.0f, 0.0f},
+        { 1.0f, -1.0f, 0.0f},
+        { 1.0f,  1.0f, 0.5f}
+    }), TestSuite::Compare::Container);
+    CORRADE_VERIFY(wireframe.unmap());
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+struct LineVertex {
+    Vector3 position;
+    Color4 color;
+};
+
+void MeshVisualizerPrepassGLTest::generateLines() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isVersionSupported(GL::Version::GL430))
+        CORRADE_SKIP(GL::Version::GL430 << "is not supported.");
+    #else
+    if(!GL::Context::current().isVersionSupported(GL::Version::GLES310))
+        CORRADE_SKIP(GL::Version::GLES310 << "is not supported.");
+    #endif
+
+    /* The directions are deliberately not normalized, the second vertex has
+       a flipped bitangent */
+    GL::Buffer positions{GL::Buffer::TargetHint::ShaderStorage, {
+        Vector3{0.0f, 0.0f, 0.0f},
+        Vector3{1.0f, 2.0f, 3.0f}
+    }};
+    GL::Buffer normals{GL::Buffer::TargetHint::ShaderStorage, {
+        Vector3{0.0f, 0.0f, 2.0f},
+        Vector3{0.0f, 0.0f, 1.0f}
+    }};
+    GL::Buffer tangents{GL::Buffer::TargetHint::ShaderStorage, {
+        Vector4{3.0f, 0.0f, 0.0f, 1.0f},
+        Vector4{1.0f, 0.0f, 0.0f, -1.0f}
+    }};
+    GL::Buffer lines{GL::Buffer::TargetHint::ShaderStorage};
+    lines.setData({nullptr, 2*3*2*sizeof(LineVertex)}, GL::BufferUsage::DynamicRead);
+
+    MeshVisualizerPrepassGL shader{MeshVisualizerPrepassGL::Flag::TangentDirection|MeshVisualizerPrepassGL::Flag::BitangentFromTangentDirection|MeshVisualizerPrepassGL::Flag::NormalDirection};
+    CORRADE_COMPARE(shader.lineCountPerVertex(), 3);
+    shader.bindPositionBuffer(positions)
+        .bindNormalBuffer(normals)
+        .bindTangentBuffer(tangents)
+        .bindLineBuffer(lines)
+        .setLineLength(0.5f)
+        .generate(2);
+    GL::Renderer::setMemoryBarrier(GL::Renderer::MemoryBarrier::BufferUpdate);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Containers::ArrayView<const LineVertex> output = Containers::arrayCast<const LineVertex>(lines.mapRead(0, 2*3*2*sizeof(LineVertex)));
+    CORRADE_VERIFY(output);
+    CORRADE_COMPARE(output[0].position, (Vector3{0.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(output[1].position, (Vector3{0.5f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(output[0].color, 0xff0000ff_rgbaf);
+    CORRADE_COMPARE(output[1].color, 0xff0000ff_rgbaf);
+    CORRADE_COMPARE(output[2].position, (Vector3{0.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(output[3].position, (Vector3{0.0f, 0.5f, 0.0f}));
+    CORRADE_COMPARE(output[3].color, 0x00ff00ff_rgbaf);
+    CORRADE_COMPARE(output[5].position, (Vector3{0.0f, 0.0f, 0.5f}));
+    CORRADE_COMPARE(output[5].color, 0x0000ffff_rgbaf);
+
+    CORRADE_COMPARE(output[6].position, (Vector3{1.0f, 2.0f, 3.0f}));
+    CORRADE_COMPARE(output[7].position, (Vector3{1.5f, 2.0f, 3.0f}));
+    CORRADE_COMPARE(output[9].position, (Vector3{1.0f, 1.5f, 3.0f}));
+    CORRADE_COMPARE(output[11].position, (Vector3{1.0f, 2.0f, 3.5f}));
+    CORRADE_VERIFY(lines.unmap());
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void MeshVisualizerPrepassGLTest::generateLinesBitangent() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isVersionSupported(GL::Version::GL430))
+        CORRADE_SKIP(GL::Version::GL430 << "is not supported.");
+    #else
+    if(!GL::Context::current().isVersionSupported(GL::Version::GLES310))
+        CORRADE_SKIP(GL::Version::GLES310 << "is not supported.");
+    #endif
+
+    GL::Buffer positions{GL::Buffer::TargetHint::ShaderStorage, {
+        Vector3{1.0f, 2.0f, 3.0f}
+    }};
+    GL::Buffer bitangents{GL::Buffer::TargetHint::ShaderStorage, {
+        Vector3{0.0f, -4.0f, 0.0f}
+    }};
+    GL::Buffer lines{GL::Buffer::TargetHint::ShaderStorage};
+    lines.setData({nullptr, 2*sizeof(LineVertex)}, GL::BufferUsage::DynamicRead);
+
+    /* Default line length */
+    MeshVisualizerPrepassGL shader{MeshVisualizerPrepassGL::Flag::BitangentDirection};
+    shader.bindPositionBuffer(positions)
+        .bindBitangentBuffer(bitangents)
+        .bindLineBuffer(lines)
+        .generate(1);
+    GL::Renderer::setMemoryBarrier(GL::Renderer::MemoryBarrier::BufferUpdate);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Containers::ArrayView<const LineVertex> output = Containers::arrayCast<const LineVertex>(lines.mapRead(0, 2*sizeof(LineVertex)));
+    CORRADE_VERIFY(output);
+    CORRADE_COMPARE(output[0].position, (Vector3{1.0f, 2.0f, 3.0f}));
+    CORRADE_COMPARE(output[1].position, (Vector3{1.0f, 1.0f, 3.0f}));
+    CORRADE_COMPARE(output[1].color, 0x00ff00ff_rgbaf);
+    CORRADE_VERIFY(lines.unmap());
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void MeshVisualizerPrepassGLTest::generateInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isVersionSupported(GL::Version::GL430))
+        CORRADE_SKIP(GL::Version::GL430 << "is not supported.");
+    #else
+    if(!GL::Context::current().isVersionSupported(GL::Version::GLES310))
+        CORRADE_SKIP(GL::Version::GLES310 << "is not supported.");
+    #endif
+
+    MeshVisualizerPrepassGL shader{MeshVisualizerPrepassGL::Flag::Wireframe};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    shader.generate(0, 3)
+        .generate(3)
+        .generate(3, 4);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::MeshVisualizerPrepassGL::generate(): expected a non-zero vertex count\n"
+        "Shaders::MeshVisualizerPrepassGL::generate(): expected a non-zero index count divisible by 3 but got 0\n"
+        "Shaders::MeshVisualizerPrepassGL::generate(): expected a non-zero index count divisible by 3 but got 4\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Shaders::Test::MeshVisualizerPrepassGLTest)
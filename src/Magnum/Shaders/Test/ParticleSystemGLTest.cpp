@@ -0,0 +1,316 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/GL/Buffer.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/Mesh.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Shaders/ParticleSystemGL.h"
+
+namespace Magnum { namespace Shaders { namespace Test { namespace {
+
+struct ParticleSystemGLTest: GL::OpenGLTester {
+    explicit ParticleSystemGLTest();
+
+    void construct();
+    void constructZeroCapacity();
+    void constructMove();
+
+    void update();
+    void expire();
+    void emitOverCapacity();
+    void drawInvalidShader();
+};
+
+using namespace Math::Literals;
+
+const struct {
+    const char* name;
+    ParticleSystemGL::Backend backend;
+} BackendData[]{
+    {"transform feedback", ParticleSystemGL::Backend::TransformFeedback},
+    #ifndef MAGNUM_TARGET_WEBGL
+    {"compute", ParticleSystemGL::Backend::Compute},
+    #endif
+};
+
+ParticleSystemGLTest::ParticleSystemGLTest() {
+    addInstancedTests({&ParticleSystemGLTest::construct},
+        Containers::arraySize(BackendData));
+
+    addTests({&ParticleSystemGLTest::constructZeroCapacity,
+              &ParticleSystemGLTest::constructMove});
+
+    addInstancedTests({&ParticleSystemGLTest::update,
+                       &ParticleSystemGLTest::expire,
+                       &ParticleSystemGLTest::emitOverCapacity},
+        Containers::arraySize(BackendData));
+
+    addTests({&ParticleSystemGLTest::drawInvalidShader});
+}
+
+/* Has to be a macro as CORRADE_SKIP() needs to return from the test case */
+#ifndef MAGNUM_TARGET_GLES
+#define SKIP_IF_UNSUPPORTED(backend)                                        \
+    if(backend == ParticleSystemGL::Backend::Compute && !GL::Context::current().isVersionSupported(GL::Version::GL430)) \
+        CORRADE_SKIP(GL::Version::GL430 << "is not supported.");            \
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::transform_feedback2>()) \
+        CORRADE_SKIP(GL::Extensions::ARB::transform_feedback2::string() << "is not supported.");
+#elif !defined(MAGNUM_TARGET_WEBGL)
+#define SKIP_IF_UNSUPPORTED(backend)                                        \
+    if(backend == ParticleSystemGL::Backend::Compute && !GL::Context::current().isVersionSupported(GL::Version::GLES310)) \
+        CORRADE_SKIP(GL::Version::GLES310 << "is not supported.");
+#else
+#define SKIP_IF_UNSUPPORTED(backend) static_cast<void>(backend);
+#endif
+
+void ParticleSystemGLTest::construct() {
+    auto&& data = BackendData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    SKIP_IF_UNSUPPORTED(data.backend)
+
+    ParticleSystemGL particles{16, data.backend};
+    CORRADE_COMPARE(particles.backend(), data.backend);
+    CORRADE_COMPARE(particles.capacity(), 16);
+    CORRADE_VERIFY(particles.instanceBuffer().id());
+    CORRADE_COMPARE(particles.instanceBuffer().size(), Int(16*sizeof(ParticleSystemGL::Instance)));
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void ParticleSystemGLTest::constructZeroCapacity() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    ParticleSystemGL{0, ParticleSystemGL::Backend::TransformFeedback};
+    CORRADE_COMPARE(out.str(), "Shaders::ParticleSystemGL: expected a non-zero capacity\n");
+}
+
+void ParticleSystemGLTest::constructMove() {
+    SKIP_IF_UNSUPPORTED(ParticleSystemGL::Backend::TransformFeedback)
+
+    ParticleSystemGL a{16, ParticleSystemGL::Backend::TransformFeedback};
+    const GLuint id = a.instanceBuffer().id();
+    CORRADE_VERIFY(id);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    ParticleSystemGL b{std::move(a)};
+    CORRADE_COMPARE(b.instanceBuffer().id(), id);
+    CORRADE_COMPARE(b.capacity(), 16);
+
+    ParticleSystemGL c{NoCreate};
+    c = std::move(b);
+    CORRADE_COMPARE(c.instanceBuffer().id(), id);
+    CORRADE_COMPARE(c.capacity(), 16);
+}
+
+void ParticleSystemGLTest::update() {
+    auto&& data = BackendData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    SKIP_IF_UNSUPPORTED(data.backend)
+
+    #ifdef MAGNUM_TARGET_WEBGL
+    CORRADE_SKIP("Buffer mapping is not available on WebGL.");
+    #else
+    /* No radius or spread, so all emitted particles are the same */
+    ParticleSystemGL particles{16, data.backend};
+    particles
+        .setEmitterPosition({1.0f, 2.0f, 3.0f})
+        .setVelocity({0.0f, 2.0f, 0.0f}, 0.0f)
+        .setLifetime(10.0f, 10.0f)
+        .setAcceleration({0.0f, 0.0f, -4.0f})
+        .setColor(0xff0000ff_rgbaf, 0x0000ffff_rgbaf)
+        .setSize(2.0f, 12.0f)
+        .emit(4);
+    CORRADE_COMPARE(particles.emitCount(), 4);
+
+    /* Emitted particles are spawned but not integrated in the first update */
+    particles.update(1.0f, Matrix4{});
+    CORRADE_COMPARE(particles.emitCount(), 0);
+
+    /* The second update integrates them, with the billboards facing the
+       camera rotated around Y */
+    particles.update(1.0f, Matrix4::rotationY(90.0_degf));
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* In case of transform feedback the particles are in the first four
+       slots of the ring, in case of compute they're compacted at the front
+       in an unspecified order, which doesn't matter here */
+    Containers::ArrayView<const ParticleSystemGL::Instance> instances = Containers::arrayCast<const ParticleSystemGL::Instance>(particles.instanceBuffer().mapRead(0, 4*sizeof(ParticleSystemGL::Instance)));
+    CORRADE_VERIFY(instances);
+    for(const ParticleSystemGL::Instance& instance: instances) {
+        CORRADE_ITERATION(&instance - instances.data());
+        /* Velocity is {0, 2, -4} after the first second, age is 1/10 of the
+           lifetime */
+        CORRADE_COMPARE(instance.transformationMatrix,
+            Matrix4::translation({1.0f, 4.0f, -1.0f})*
+            Matrix4::rotationY(-90.0_degf)*
+            Matrix4::scaling(Vector3{3.0f}));
+        CORRADE_COMPARE(instance.color, (Color4{0.9f, 0.0f, 0.1f, 1.0f}));
+    }
+    CORRADE_VERIFY(particles.instanceBuffer().unmap());
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    #endif
+}
+
+void ParticleSystemGLTest::expire() {
+    auto&& data = BackendData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    SKIP_IF_UNSUPPORTED(data.backend)
+
+    #ifdef MAGNUM_TARGET_WEBGL
+    CORRADE_SKIP("Buffer mapping is not available on WebGL.");
+    #else
+    ParticleSystemGL particles{16, data.backend};
+    particles
+        .setEmitterPosition({1.0f, 2.0f, 3.0f})
+        .setLifetime(1.5f, 1.5f)
+        .emit(4)
+        .update(1.0f, Matrix4{});
+
+    /* The first four particles die in this update, while a new one is
+       emitted at a different position */
+    particles
+        .setEmitterPosition({4.0f, 5.0f, 6.0f})
+        .emit(1)
+        .update(1.0f, Matrix4{})
+        .update(1.0f, Matrix4{});
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Containers::ArrayView<const ParticleSystemGL::Instance> instances = Containers::arrayCast<const ParticleSystemGL::Instance>(particles.instanceBuffer().mapRead(0, 5*sizeof(ParticleSystemGL::Instance)));
+    CORRADE_VERIFY(instances);
+
+    #ifndef MAGNUM_TARGET_WEBGL
+    /* With compute, the surviving particle is moved to the front */
+    if(data.backend == ParticleSystemGL::Backend::Compute) {
+        CORRADE_COMPARE(instances[0].transformationMatrix,
+            Matrix4::translation({4.0f, 5.0f, 6.0f}));
+    } else
+    #endif
+    /* With transform feedback, the dead particles stay in their slots with a
+       zero scale and the new one is emitted after them */
+    {
+        for(std::size_t i = 0; i != 4; ++i) {
+            CORRADE_ITERATION(i);
+            CORRADE_COMPARE(instances[i].transformationMatrix,
+                Matrix4::translation({1.0f, 2.0f, 3.0f})*
+                Matrix4::scaling(Vector3{0.0f}));
+        }
+        CORRADE_COMPARE(instances[4].transformationMatrix,
+            Matrix4::translation({4.0f, 5.0f, 6.0f}));
+    }
+    CORRADE_VERIFY(particles.instanceBuffer().unmap());
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    #endif
+}
+
+void ParticleSystemGLTest::emitOverCapacity() {
+    auto&& data = BackendData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    SKIP_IF_UNSUPPORTED(data.backend)
+
+    #ifdef MAGNUM_TARGET_WEBGL
+    CORRADE_SKIP("Buffer mapping is not available on WebGL.");
+    #else
+    ParticleSystemGL particles{4, data.backend};
+    particles
+        .setEmitterPosition({1.0f, 2.0f, 3.0f})
+        .setLifetime(10.0f, 10.0f)
+        .emit(3)
+        .update(1.0f, Matrix4{});
+
+    /* The emit count is clamped to the capacity */
+    particles.emit(7);
+    CORRADE_COMPARE(particles.emitCount(), 4);
+    particles
+        .setEmitterPosition({4.0f, 5.0f, 6.0f})
+        .update(1.0f, Matrix4{});
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Containers::ArrayView<const ParticleSystemGL::Instance> instances = Containers::arrayCast<const ParticleSystemGL::Instance>(particles.instanceBuffer().mapRead(0, 4*sizeof(ParticleSystemGL::Instance)));
+    CORRADE_VERIFY(instances);
+
+    #ifndef MAGNUM_TARGET_WEBGL
+    /* With compute, the alive particles are kept and the one remaining slot
+       is filled with one of the new ones, the rest is dropped. The order is
+       unspecified, so just count the new ones. */
+    if(data.backend == ParticleSystemGL::Backend::Compute) {
+        std::size_t newCount = 0;
+        for(const ParticleSystemGL::Instance& instance: instances)
+            if(instance.transformationMatrix.translation() == Vector3{4.0f, 5.0f, 6.0f}) ++newCount;
+        CORRADE_COMPARE(newCount, 1);
+    } else
+    #endif
+    /* With transform feedback, all slots are replaced by the new ones */
+    {
+        for(std::size_t i = 0; i != 4; ++i) {
+            CORRADE_ITERATION(i);
+            CORRADE_COMPARE(instances[i].transformationMatrix.translation(),
+                (Vector3{4.0f, 5.0f, 6.0f}));
+        }
+    }
+    CORRADE_VERIFY(particles.instanceBuffer().unmap());
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    #endif
+}
+
+void ParticleSystemGLTest::drawInvalidShader() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    SKIP_IF_UNSUPPORTED(ParticleSystemGL::Backend::TransformFeedback)
+
+    ParticleSystemGL particles{16, ParticleSystemGL::Backend::TransformFeedback};
+    FlatGL3D shader{FlatGL3D::Configuration{}
+        .setFlags(FlatGL3D::Flag::InstancedTransformation)};
+    GL::Mesh mesh;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    particles.draw(shader, mesh);
+    CORRADE_COMPARE(out.str(), "Shaders::ParticleSystemGL::draw(): expected the shader to have instanced transformation and vertex color enabled but got Shaders::FlatGL::Flag::InstancedTransformation\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Shaders::Test::ParticleSystemGLTest)
@@ -0,0 +1,170 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/GL/Mesh.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Shaders/ParticleSystemGL.h"
+
+namespace Magnum { namespace Shaders { namespace Test { namespace {
+
+/* There's an underscore between GL and Test to disambiguate from GLTest, which
+   is a common suffix used to mark tests that need a GL context. Ugly, I know. */
+struct ParticleSystemGL_Test: TestSuite::Tester {
+    explicit ParticleSystemGL_Test();
+
+    void constructNoCreate();
+    void constructCopy();
+    void constructMove();
+
+    void setters();
+    void setLifetimeInvalid();
+    void noCreate();
+
+    void debugBackend();
+};
+
+ParticleSystemGL_Test::ParticleSystemGL_Test() {
+    addTests({&ParticleSystemGL_Test::constructNoCreate,
+              &ParticleSystemGL_Test::constructCopy,
+              &ParticleSystemGL_Test::constructMove,
+
+              &ParticleSystemGL_Test::setters,
+              &ParticleSystemGL_Test::setLifetimeInvalid,
+              &ParticleSystemGL_Test::noCreate,
+
+              &ParticleSystemGL_Test::debugBackend});
+}
+
+using namespace Math::Literals;
+
+void ParticleSystemGL_Test::constructNoCreate() {
+    {
+        ParticleSystemGL particles{NoCreate};
+        CORRADE_COMPARE(particles.backend(), ParticleSystemGL::Backend::TransformFeedback);
+        CORRADE_COMPARE(particles.capacity(), 0);
+        CORRADE_COMPARE(particles.instanceBuffer().id(), 0);
+        CORRADE_COMPARE(particles.emitCount(), 0);
+
+        /* Defaults */
+        CORRADE_COMPARE(particles.emitterPosition(), Vector3{});
+        CORRADE_COMPARE(particles.emitterRadius(), 0.0f);
+        CORRADE_COMPARE(particles.velocity(), Vector3{});
+        CORRADE_COMPARE(particles.velocitySpread(), 0.0f);
+        CORRADE_COMPARE(particles.lifetime(), Vector2{1.0f});
+        CORRADE_COMPARE(particles.acceleration(), Vector3{});
+        CORRADE_COMPARE(particles.drag(), 0.0f);
+        CORRADE_COMPARE(particles.startColor(), 0xffffffff_rgbaf);
+        CORRADE_COMPARE(particles.endColor(), 0xffffffff_rgbaf);
+        CORRADE_COMPARE(particles.size(), Vector2{1.0f});
+    }
+
+    CORRADE_VERIFY(true);
+}
+
+void ParticleSystemGL_Test::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<ParticleSystemGL>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<ParticleSystemGL>{});
+}
+
+void ParticleSystemGL_Test::constructMove() {
+    ParticleSystemGL a{NoCreate};
+    a.setDrag(0.5f);
+
+    ParticleSystemGL b{std::move(a)};
+    CORRADE_COMPARE(b.drag(), 0.5f);
+
+    ParticleSystemGL c{NoCreate};
+    c = std::move(b);
+    CORRADE_COMPARE(c.drag(), 0.5f);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<ParticleSystemGL>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<ParticleSystemGL>::value);
+}
+
+void ParticleSystemGL_Test::setters() {
+    ParticleSystemGL particles{NoCreate};
+    particles
+        .setEmitterPosition({1.0f, 2.0f, 3.0f})
+        .setEmitterRadius(0.5f)
+        .setVelocity({0.0f, 4.0f, 0.0f}, 1.5f)
+        .setLifetime(2.0f, 3.0f)
+        .setAcceleration({0.0f, -9.81f, 0.0f})
+        .setDrag(0.25f)
+        .setColor(0xff3366ff_rgbaf, 0x3366ff00_rgbaf)
+        .setSize(0.1f, 0.4f);
+    CORRADE_COMPARE(particles.emitterPosition(), (Vector3{1.0f, 2.0f, 3.0f}));
+    CORRADE_COMPARE(particles.emitterRadius(), 0.5f);
+    CORRADE_COMPARE(particles.velocity(), (Vector3{0.0f, 4.0f, 0.0f}));
+    CORRADE_COMPARE(particles.velocitySpread(), 1.5f);
+    CORRADE_COMPARE(particles.lifetime(), (Vector2{2.0f, 3.0f}));
+    CORRADE_COMPARE(particles.acceleration(), (Vector3{0.0f, -9.81f, 0.0f}));
+    CORRADE_COMPARE(particles.drag(), 0.25f);
+    CORRADE_COMPARE(particles.startColor(), 0xff3366ff_rgbaf);
+    CORRADE_COMPARE(particles.endColor(), 0x3366ff00_rgbaf);
+    CORRADE_COMPARE(particles.size(), (Vector2{0.1f, 0.4f}));
+}
+
+void ParticleSystemGL_Test::setLifetimeInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    ParticleSystemGL particles{NoCreate};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    particles.setLifetime(2.0f, 1.5f);
+    CORRADE_COMPARE(out.str(), "Shaders::ParticleSystemGL::setLifetime(): expected min not larger than max but got 2 and 1.5\n");
+}
+
+void ParticleSystemGL_Test::noCreate() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    ParticleSystemGL particles{NoCreate};
+    GL::Mesh mesh{NoCreate};
+    FlatGL3D shader{NoCreate};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    particles.update(0.016f, {});
+    particles.setupMesh(mesh);
+    particles.draw(shader, mesh);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::ParticleSystemGL::update(): the particle system was constructed with NoCreate\n"
+        "Shaders::ParticleSystemGL::setupMesh(): the particle system was constructed with NoCreate\n"
+        "Shaders::ParticleSystemGL::draw(): the particle system was constructed with NoCreate\n");
+}
+
+void ParticleSystemGL_Test::debugBackend() {
+    std::ostringstream out;
+    Debug{&out} << ParticleSystemGL::Backend::TransformFeedback << ParticleSystemGL::Backend(0xf0);
+    CORRADE_COMPARE(out.str(), "Shaders::ParticleSystemGL::Backend::TransformFeedback Shaders::ParticleSystemGL::Backend(0xf0)\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Shaders::Test::ParticleSystemGL_Test)
@@ -0,0 +1,655 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/FormatStl.h>
+#include <Corrade/Utility/System.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/GL/Buffer.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/CubeMapTexture.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/Framebuffer.h"
+#include "Magnum/GL/Mesh.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/GL/Renderbuffer.h"
+#include "Magnum/GL/RenderbufferFormat.h"
+#include "Magnum/GL/Texture.h"
+#include "Magnum/GL/TextureArray.h"
+#include "Magnum/GL/TextureFormat.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/MeshTools/Compile.h"
+#include "Magnum/Primitives/Plane.h"
+#include "Magnum/Shaders/Generic.h"
+#include "Magnum/Shaders/Pbr.h"
+#include "Magnum/Shaders/PbrGL.h"
+#include "Magnum/Shaders/Phong.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace Shaders { namespace Test { namespace {
+
+struct PbrGLTest: GL::OpenGLTester {
+    explicit PbrGLTest();
+
+    void construct();
+    void constructAsync();
+    void constructMove();
+    void constructInvalid();
+
+    void bindBufferNotEnabled();
+    void bindTexturesNotEnabled();
+    void bindTextureArraysNotEnabled();
+    void setWrongDrawOffset();
+
+    void brdfLookupTexture();
+    void brdfLookupTextureInvalid();
+    void prefilteredEnvironmentTexture();
+    void prefilteredEnvironmentTextureInvalid();
+
+    void render();
+    void renderImageBasedLighting();
+};
+
+using namespace Math::Literals;
+
+const struct {
+    const char* name;
+    PbrGL::Flags flags;
+    UnsignedInt lightCount, materialCount, drawCount;
+} ConstructData[]{
+    {"", {}, 1, 1, 1},
+    {"multiple lights, materials, draws", {}, 8, 8, 24},
+    {"multiple lights, materials, draws + light culling", PbrGL::Flag::LightCulling, 8, 8, 24},
+    {"zero lights", {}, 0, 1, 1},
+    {"all textures", PbrGL::Flag::BaseColorTexture|PbrGL::Flag::MetallicRoughnessTexture|PbrGL::Flag::NormalTexture|PbrGL::Flag::OcclusionTexture|PbrGL::Flag::EmissiveTexture, 1, 1, 1},
+    {"all textures + texture transformation", PbrGL::Flag::BaseColorTexture|PbrGL::Flag::MetallicRoughnessTexture|PbrGL::Flag::NormalTexture|PbrGL::Flag::OcclusionTexture|PbrGL::Flag::EmissiveTexture|PbrGL::Flag::TextureTransformation, 1, 1, 1},
+    {"all texture arrays + texture transformation", PbrGL::Flag::BaseColorTexture|PbrGL::Flag::MetallicRoughnessTexture|PbrGL::Flag::NormalTexture|PbrGL::Flag::OcclusionTexture|PbrGL::Flag::EmissiveTexture|PbrGL::Flag::TextureArrays|PbrGL::Flag::TextureTransformation, 1, 1, 1},
+    {"alpha mask", PbrGL::Flag::AlphaMask, 1, 1, 1},
+    {"vertex colors", PbrGL::Flag::VertexColor, 1, 1, 1},
+    {"instanced transformation", PbrGL::Flag::InstancedTransformation, 1, 1, 1},
+    {"instanced texture offset", PbrGL::Flag::BaseColorTexture|PbrGL::Flag::InstancedTextureOffset, 1, 1, 1},
+    {"instanced texture array offset", PbrGL::Flag::BaseColorTexture|PbrGL::Flag::InstancedTextureOffset|PbrGL::Flag::TextureArrays, 1, 1, 1},
+    {"multidraw with all the things", PbrGL::Flag::MultiDraw|PbrGL::Flag::BaseColorTexture|PbrGL::Flag::NormalTexture|PbrGL::Flag::TextureTransformation|PbrGL::Flag::AlphaMask|PbrGL::Flag::InstancedTransformation|PbrGL::Flag::LightCulling, 8, 8, 24},
+    {"image-based lighting", PbrGL::Flag::ImageBasedLighting, 1, 1, 1},
+    {"image-based lighting, zero lights", PbrGL::Flag::ImageBasedLighting|PbrGL::Flag::OcclusionTexture, 0, 1, 1}
+};
+
+const struct {
+    const char* name;
+    PbrGL::Flags flags;
+    UnsignedInt materialCount, drawCount;
+    const char* message;
+} ConstructInvalidData[]{
+    {"texture transformation but not textured",
+        PbrGL::Flag::TextureTransformation, 1, 1,
+        "texture transformation enabled but the shader is not textured"},
+    {"texture arrays but not textured",
+        PbrGL::Flag::TextureArrays, 1, 1,
+        "texture arrays enabled but the shader is not textured"},
+    {"texture arrays but no transformation",
+        PbrGL::Flag::BaseColorTexture|PbrGL::Flag::TextureArrays, 1, 1,
+        "texture arrays require texture transformation enabled as well"},
+    {"zero materials",
+        {}, 0, 1,
+        "material count can't be zero"},
+    {"zero draws",
+        {}, 1, 0,
+        "draw count can't be zero"}
+};
+
+const struct {
+    const char* name;
+    Color4 baseColor;
+    Color3 emissiveColor;
+    Float metalness, roughness;
+    UnsignedInt lightCount;
+    Color4ub expected;
+} RenderData[]{
+    /* Only emission, no lighting at all */
+    {"emissive only", 0x000000ff_rgbaf, {0.25f, 0.5f, 0.75f}, 0.0f, 1.0f, 0,
+        {64, 128, 191, 255}},
+    /* With N = V = L the diffuse term is 0.96/pi and the specular term
+       0.04*D*V = 0.04*1/pi*0.25 */
+    {"rough dielectric", 0xffffffff_rgbaf, {}, 0.0f, 1.0f, 1,
+        {79, 79, 79, 255}},
+    /* No diffuse, specular is the base color times 1/pi*0.25 */
+    {"rough metal", 0xffffffff_rgbaf, {}, 1.0f, 1.0f, 1,
+        {20, 20, 20, 255}}
+};
+
+PbrGLTest::PbrGLTest() {
+    addInstancedTests({&PbrGLTest::construct},
+        Containers::arraySize(ConstructData));
+
+    addTests({&PbrGLTest::constructAsync,
+              &PbrGLTest::constructMove});
+
+    addInstancedTests({&PbrGLTest::constructInvalid},
+        Containers::arraySize(ConstructInvalidData));
+
+    addTests({&PbrGLTest::bindBufferNotEnabled,
+              &PbrGLTest::bindTexturesNotEnabled,
+              &PbrGLTest::bindTextureArraysNotEnabled,
+              &PbrGLTest::setWrongDrawOffset,
+
+              &PbrGLTest::brdfLookupTexture,
+              &PbrGLTest::brdfLookupTextureInvalid,
+              &PbrGLTest::prefilteredEnvironmentTexture,
+              &PbrGLTest::prefilteredEnvironmentTextureInvalid});
+
+    addInstancedTests({&PbrGLTest::render},
+        Containers::arraySize(RenderData));
+
+    addTests({&PbrGLTest::renderImageBasedLighting});
+}
+
+void PbrGLTest::construct() {
+    auto&& data = ConstructData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() << "is not supported.");
+    if((data.flags & PbrGL::Flag::TextureArrays) && !GL::Context::current().isExtensionSupported<GL::Extensions::EXT::texture_array>())
+        CORRADE_SKIP(GL::Extensions::EXT::texture_array::string() << "is not supported.");
+    #endif
+
+    if(data.flags >= PbrGL::Flag::MultiDraw) {
+        #ifndef MAGNUM_TARGET_GLES
+        if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::shader_draw_parameters>())
+            CORRADE_SKIP(GL::Extensions::ARB::shader_draw_parameters::string() << "is not supported.");
+        #elif !defined(MAGNUM_TARGET_WEBGL)
+        if(!GL::Context::current().isExtensionSupported<GL::Extensions::ANGLE::multi_draw>())
+            CORRADE_SKIP(GL::Extensions::ANGLE::multi_draw::string() << "is not supported.");
+        #else
+        if(!GL::Context::current().isExtensionSupported<GL::Extensions::WEBGL::multi_draw>())
+            CORRADE_SKIP(GL::Extensions::WEBGL::multi_draw::string() << "is not supported.");
+        #endif
+    }
+
+    PbrGL shader{PbrGL::Configuration{}
+        .setFlags(data.flags)
+        .setLightCount(data.lightCount)
+        .setMaterialCount(data.materialCount)
+        .setDrawCount(data.drawCount)};
+    CORRADE_COMPARE(shader.flags(), data.flags);
+    CORRADE_COMPARE(shader.lightCount(), data.lightCount);
+    CORRADE_COMPARE(shader.materialCount(), data.materialCount);
+    CORRADE_COMPARE(shader.drawCount(), data.drawCount);
+    CORRADE_VERIFY(shader.id());
+    {
+        #if defined(CORRADE_TARGET_APPLE) && !defined(MAGNUM_TARGET_GLES)
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void PbrGLTest::constructAsync() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() << "is not supported.");
+    #endif
+
+    PbrGL::CompileState state = PbrGL::compile(PbrGL::Configuration{}
+        .setFlags(PbrGL::Flag::BaseColorTexture|PbrGL::Flag::ImageBasedLighting)
+        .setLightCount(3)
+        .setMaterialCount(4)
+        .setDrawCount(5));
+    CORRADE_COMPARE(state.flags(), PbrGL::Flag::BaseColorTexture|PbrGL::Flag::ImageBasedLighting);
+    CORRADE_COMPARE(state.lightCount(), 3);
+    CORRADE_COMPARE(state.materialCount(), 4);
+    CORRADE_COMPARE(state.drawCount(), 5);
+
+    while(!state.isLinkFinished())
+        Utility::System::sleep(100);
+
+    PbrGL shader{std::move(state)};
+    CORRADE_COMPARE(shader.flags(), PbrGL::Flag::BaseColorTexture|PbrGL::Flag::ImageBasedLighting);
+    CORRADE_COMPARE(shader.lightCount(), 3);
+    CORRADE_COMPARE(shader.materialCount(), 4);
+    CORRADE_COMPARE(shader.drawCount(), 5);
+    CORRADE_VERIFY(shader.id());
+    {
+        #if defined(CORRADE_TARGET_APPLE) && !defined(MAGNUM_TARGET_GLES)
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void PbrGLTest::constructMove() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() << "is not supported.");
+    #endif
+
+    PbrGL a{PbrGL::Flag::AlphaMask, 2};
+    const GLuint id = a.id();
+    CORRADE_VERIFY(id);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    PbrGL b{std::move(a)};
+    CORRADE_COMPARE(b.id(), id);
+    CORRADE_COMPARE(b.flags(), PbrGL::Flag::AlphaMask);
+    CORRADE_COMPARE(b.lightCount(), 2);
+    CORRADE_VERIFY(!a.id());
+
+    PbrGL c{NoCreate};
+    c = std::move(b);
+    CORRADE_COMPARE(c.id(), id);
+    CORRADE_COMPARE(c.flags(), PbrGL::Flag::AlphaMask);
+    CORRADE_COMPARE(c.lightCount(), 2);
+    CORRADE_VERIFY(!b.id());
+}
+
+void PbrGLTest::constructInvalid() {
+    auto&& data = ConstructInvalidData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    PbrGL{PbrGL::Configuration{}
+        .setFlags(data.flags)
+        .setMaterialCount(data.materialCount)
+        .setDrawCount(data.drawCount)};
+    CORRADE_COMPARE(out.str(), Utility::formatString(
+        "Shaders::PbrGL: {}\n", data.message));
+}
+
+void PbrGLTest::bindBufferNotEnabled() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() << "is not supported.");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    GL::Buffer buffer{GL::Buffer::TargetHint::Uniform};
+    PbrGL shader;
+    shader.bindTextureTransformationBuffer(buffer)
+          .bindTextureTransformationBuffer(buffer, 0, 16)
+          .bindImageBasedLightingBuffer(buffer)
+          .bindImageBasedLightingBuffer(buffer, 0, 16);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::PbrGL::bindTextureTransformationBuffer(): the shader was not created with texture transformation enabled\n"
+        "Shaders::PbrGL::bindTextureTransformationBuffer(): the shader was not created with texture transformation enabled\n"
+        "Shaders::PbrGL::bindImageBasedLightingBuffer(): the shader was not created with image-based lighting enabled\n"
+        "Shaders::PbrGL::bindImageBasedLightingBuffer(): the shader was not created with image-based lighting enabled\n");
+}
+
+void PbrGLTest::bindTexturesNotEnabled() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() << "is not supported.");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    GL::Texture2D texture;
+    GL::CubeMapTexture cubeMap;
+    PbrGL shader;
+    shader.bindBaseColorTexture(texture)
+          .bindMetallicRoughnessTexture(texture)
+          .bindNormalTexture(texture)
+          .bindOcclusionTexture(texture)
+          .bindEmissiveTexture(texture)
+          .bindBrdfLookupTexture(texture)
+          .bindEnvironmentTexture(cubeMap);
+
+    CORRADE_COMPARE(out.str(),
+        "Shaders::PbrGL::bindBaseColorTexture(): the shader was not created with base color texture enabled\n"
+        "Shaders::PbrGL::bindMetallicRoughnessTexture(): the shader was not created with metallic/roughness texture enabled\n"
+        "Shaders::PbrGL::bindNormalTexture(): the shader was not created with normal texture enabled\n"
+        "Shaders::PbrGL::bindOcclusionTexture(): the shader was not created with occlusion texture enabled\n"
+        "Shaders::PbrGL::bindEmissiveTexture(): the shader was not created with emissive texture enabled\n"
+        "Shaders::PbrGL::bindBrdfLookupTexture(): the shader was not created with image-based lighting enabled\n"
+        "Shaders::PbrGL::bindEnvironmentTexture(): the shader was not created with image-based lighting enabled\n");
+}
+
+void PbrGLTest::bindTextureArraysNotEnabled() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() << "is not supported.");
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::texture_array>())
+        CORRADE_SKIP(GL::Extensions::EXT::texture_array::string() << "is not supported.");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    GL::Texture2DArray textureArray;
+    PbrGL shader{PbrGL::Flag::BaseColorTexture};
+    shader.bindBaseColorTexture(textureArray);
+
+    GL::Texture2D texture;
+    PbrGL shaderArrays{PbrGL::Flag::BaseColorTexture|PbrGL::Flag::TextureArrays|PbrGL::Flag::TextureTransformation};
+    shaderArrays.bindBaseColorTexture(texture);
+
+    CORRADE_COMPARE(out.str(),
+        "Shaders::PbrGL::bindBaseColorTexture(): the shader was not created with texture arrays enabled, use a Texture2D instead\n"
+        "Shaders::PbrGL::bindBaseColorTexture(): the shader was created with texture arrays enabled, use a Texture2DArray instead\n");
+}
+
+void PbrGLTest::setWrongDrawOffset() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() << "is not supported.");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    PbrGL{PbrGL::Configuration{}
+        .setMaterialCount(2)
+        .setDrawCount(5)}
+        .setDrawOffset(5);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::PbrGL::setDrawOffset(): draw offset 5 is out of bounds for 5 draws\n");
+}
+
+void PbrGLTest::brdfLookupTexture() {
+    #ifdef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::color_buffer_float>())
+        CORRADE_SKIP(GL::Extensions::EXT::color_buffer_float::string() << "is not supported.");
+    #endif
+
+    GL::Texture2D lut = pbrBrdfLookupTexture({32, 32});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(lut.imageSize(0), (Vector2i{32, 32}));
+
+    GL::Framebuffer framebuffer{{{}, {32, 32}}};
+    framebuffer.attachTexture(GL::Framebuffer::ColorAttachment{0}, lut, 0);
+    Image2D image = framebuffer.read(framebuffer.viewport(), {PixelFormat::RGBA32F});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* A smooth surface viewed head-on reflects exactly the Fresnel
+       reflectance at normal incidence, i.e. scale 1 and bias 0 */
+    const Vector4 smoothHeadOn = image.pixels<Vector4>()[0][31];
+    CORRADE_COMPARE_WITH(smoothHeadOn.x(), 1.0f, TestSuite::Compare::around(0.05f));
+    CORRADE_COMPARE_WITH(smoothHeadOn.y(), 0.0f, TestSuite::Compare::around(0.05f));
+
+    /* The BRDF never reflects more energy than it receives */
+    for(auto&& row: image.pixels<Vector4>())
+        for(const Vector4& pixel: row)
+            CORRADE_COMPARE_AS(pixel.x() + pixel.y(), 1.01f, TestSuite::Compare::LessOrEqual);
+}
+
+void PbrGLTest::brdfLookupTextureInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    pbrBrdfLookupTexture({32, 0});
+    CORRADE_COMPARE(out.str(),
+        "Shaders::pbrBrdfLookupTexture(): expected a non-zero size, got {32, 0}\n");
+}
+
+void PbrGLTest::prefilteredEnvironmentTexture() {
+    #ifdef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::color_buffer_float>())
+        CORRADE_SKIP(GL::Extensions::EXT::color_buffer_float::string() << "is not supported.");
+    #endif
+
+    /* An uniformly colored environment stays the same color after
+       convolution, regardless of the roughness */
+    Color4ub environmentData[16*16];
+    for(Color4ub& i: environmentData) i = 0x3366ccff_rgba;
+    GL::CubeMapTexture environment;
+    environment.setMinificationFilter(SamplerFilter::Linear, SamplerMipmap::Linear)
+        .setMagnificationFilter(SamplerFilter::Linear)
+        .setWrapping(SamplerWrapping::ClampToEdge)
+        .setStorage(5, GL::TextureFormat::RGBA8, {16, 16});
+    for(GL::CubeMapCoordinate face: {
+        GL::CubeMapCoordinate::PositiveX,
+        GL::CubeMapCoordinate::NegativeX,
+        GL::CubeMapCoordinate::PositiveY,
+        GL::CubeMapCoordinate::NegativeY,
+        GL::CubeMapCoordinate::PositiveZ,
+        GL::CubeMapCoordinate::NegativeZ
+    })
+        environment.setSubImage(face, 0, {}, ImageView2D{PixelFormat::RGBA8Unorm, {16, 16}, environmentData});
+    environment.generateMipmap();
+
+    GL::CubeMapTexture prefiltered = pbrPrefilteredEnvironmentTexture(environment, 16, 3);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(prefiltered.imageSize(0), (Vector2i{16, 16}));
+    CORRADE_COMPARE(prefiltered.imageSize(2), (Vector2i{4, 4}));
+
+    GL::Framebuffer framebuffer{{{}, {16, 16}}};
+    for(Int level: {0, 2}) {
+        CORRADE_ITERATION(level);
+        const Vector2i size{16 >> level};
+        framebuffer.attachCubeMapTexture(GL::Framebuffer::ColorAttachment{0}, prefiltered, GL::CubeMapCoordinate::NegativeY, level);
+        Image2D image = framebuffer.read({{}, size}, {PixelFormat::RGBA32F});
+        MAGNUM_VERIFY_NO_GL_ERROR();
+
+        const Vector4 pixel = image.pixels<Vector4>()[size.y()/2][size.x()/2];
+        const Color4 expected = 0x3366ccff_rgbaf;
+        CORRADE_COMPARE_WITH(pixel.x(), expected.r(), TestSuite::Compare::around(0.02f));
+        CORRADE_COMPARE_WITH(pixel.y(), expected.g(), TestSuite::Compare::around(0.02f));
+        CORRADE_COMPARE_WITH(pixel.z(), expected.b(), TestSuite::Compare::around(0.02f));
+    }
+}
+
+void PbrGLTest::prefilteredEnvironmentTextureInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    GL::CubeMapTexture environment{NoCreate};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    pbrPrefilteredEnvironmentTexture(environment, 0, 1);
+    pbrPrefilteredEnvironmentTexture(environment, 16, 0);
+    pbrPrefilteredEnvironmentTexture(environment, 16, 6);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::pbrPrefilteredEnvironmentTexture(): expected a non-zero size\n"
+        "Shaders::pbrPrefilteredEnvironmentTexture(): expected level count to be between 1 and 5 for size 16 but got 0\n"
+        "Shaders::pbrPrefilteredEnvironmentTexture(): expected level count to be between 1 and 5 for size 16 but got 6\n");
+}
+
+constexpr Vector2i RenderSize{80, 80};
+
+void PbrGLTest::render() {
+    auto&& data = RenderData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() << "is not supported.");
+    #endif
+
+    GL::Renderbuffer color;
+    color.setStorage(GL::RenderbufferFormat::RGBA8, RenderSize);
+    GL::Framebuffer framebuffer{{{}, RenderSize}};
+    framebuffer
+        .attachRenderbuffer(GL::Framebuffer::ColorAttachment{0}, color)
+        .clearColor(0, 0x000000ff_rgbaf)
+        .bind();
+
+    /* A plane facing the camera, covering the whole viewport. The light
+       comes from the camera direction, so at the center the normal, view and
+       light directions are all the same. */
+    GL::Mesh plane = MeshTools::compile(Primitives::planeSolid());
+
+    GL::Buffer projectionUniform{GL::Buffer::TargetHint::Uniform, {
+        ProjectionUniform3D{}.setProjectionMatrix(
+            Matrix4::orthographicProjection({2.0f, 2.0f}, 0.1f, 10.0f))
+    }};
+    GL::Buffer transformationUniform{GL::Buffer::TargetHint::Uniform, {
+        TransformationUniform3D{}.setTransformationMatrix(
+            Matrix4::translation(Vector3::zAxis(-1.0f)))
+    }};
+    GL::Buffer drawUniform{GL::Buffer::TargetHint::Uniform, {
+        PbrDrawUniform{}
+    }};
+    GL::Buffer materialUniform{GL::Buffer::TargetHint::Uniform, {
+        PbrMaterialUniform{}
+            .setBaseColor(data.baseColor)
+            .setEmissiveColor(data.emissiveColor)
+            .setMetalness(data.metalness)
+            .setRoughness(data.roughness)
+    }};
+    GL::Buffer lightUniform{GL::Buffer::TargetHint::Uniform, {
+        PhongLightUniform{}
+            .setPosition({0.0f, 0.0f, 1.0f, 0.0f})
+            .setColor(0xffffff_rgbf)
+    }};
+
+    PbrGL shader{PbrGL::Configuration{}
+        .setLightCount(data.lightCount)};
+    shader.bindProjectionBuffer(projectionUniform)
+        .bindTransformationBuffer(transformationUniform)
+        .bindDrawBuffer(drawUniform)
+        .bindMaterialBuffer(materialUniform);
+    if(data.lightCount) shader.bindLightBuffer(lightUniform);
+    shader.draw(plane);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Image2D image = framebuffer.read(framebuffer.viewport(), {PixelFormat::RGBA8Unorm});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    const Color4ub pixel = image.pixels<Color4ub>()[RenderSize.y()/2][RenderSize.x()/2];
+    CORRADE_COMPARE_WITH(Int(pixel.r()), data.expected.r(), TestSuite::Compare::around(1));
+    CORRADE_COMPARE_WITH(Int(pixel.g()), data.expected.g(), TestSuite::Compare::around(1));
+    CORRADE_COMPARE_WITH(Int(pixel.b()), data.expected.b(), TestSuite::Compare::around(1));
+}
+
+void PbrGLTest::renderImageBasedLighting() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() << "is not supported.");
+    #else
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::color_buffer_float>())
+        CORRADE_SKIP(GL::Extensions::EXT::color_buffer_float::string() << "is not supported.");
+    #endif
+
+    /* Uniform gray environment */
+    Color4ub environmentData[8*8];
+    for(Color4ub& i: environmentData) i = 0x808080ff_rgba;
+    GL::CubeMapTexture environment;
+    environment.setMinificationFilter(SamplerFilter::Linear, SamplerMipmap::Linear)
+        .setMagnificationFilter(SamplerFilter::Linear)
+        .setWrapping(SamplerWrapping::ClampToEdge)
+        .setStorage(4, GL::TextureFormat::RGBA8, {8, 8});
+    for(GL::CubeMapCoordinate face: {
+        GL::CubeMapCoordinate::PositiveX,
+        GL::CubeMapCoordinate::NegativeX,
+        GL::CubeMapCoordinate::PositiveY,
+        GL::CubeMapCoordinate::NegativeY,
+        GL::CubeMapCoordinate::PositiveZ,
+        GL::CubeMapCoordinate::NegativeZ
+    })
+        environment.setSubImage(face, 0, {}, ImageView2D{PixelFormat::RGBA8Unorm, {8, 8}, environmentData});
+    environment.generateMipmap();
+
+    GL::Texture2D brdfLookup = pbrBrdfLookupTexture({32, 32});
+    GL::CubeMapTexture prefiltered = pbrPrefilteredEnvironmentTexture(environment, 8, 4);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    GL::Renderbuffer color;
+    color.setStorage(GL::RenderbufferFormat::RGBA8, RenderSize);
+    GL::Framebuffer framebuffer{{{}, RenderSize}};
+    framebuffer
+        .attachRenderbuffer(GL::Framebuffer::ColorAttachment{0}, color)
+        .clearColor(0, 0x000000ff_rgbaf)
+        .bind();
+
+    GL::Mesh plane = MeshTools::compile(Primitives::planeSolid());
+
+    GL::Buffer projectionUniform{GL::Buffer::TargetHint::Uniform, {
+        ProjectionUniform3D{}.setProjectionMatrix(
+            Matrix4::orthographicProjection({2.0f, 2.0f}, 0.1f, 10.0f))
+    }};
+    GL::Buffer transformationUniform{GL::Buffer::TargetHint::Uniform, {
+        TransformationUniform3D{}.setTransformationMatrix(
+            Matrix4::translation(Vector3::zAxis(-1.0f)))
+    }};
+    GL::Buffer drawUniform{GL::Buffer::TargetHint::Uniform, {
+        PbrDrawUniform{}
+    }};
+    /* A white dielectric, for which the diffuse contribution dominates */
+    GL::Buffer materialUniform{GL::Buffer::TargetHint::Uniform, {
+        PbrMaterialUniform{}
+            .setMetalness(0.0f)
+            .setRoughness(1.0f)
+    }};
+    GL::Buffer imageBasedLightingUniform{GL::Buffer::TargetHint::Uniform, {
+        PbrImageBasedLightingUniform{}
+            .setLevelCount(4)
+    }};
+
+    PbrGL{PbrGL::Configuration{}
+        .setFlags(PbrGL::Flag::ImageBasedLighting)
+        .setLightCount(0)}
+        .bindProjectionBuffer(projectionUniform)
+        .bindTransformationBuffer(transformationUniform)
+        .bindDrawBuffer(drawUniform)
+        .bindMaterialBuffer(materialUniform)
+        .bindImageBasedLightingBuffer(imageBasedLightingUniform)
+        .bindBrdfLookupTexture(brdfLookup)
+        .bindEnvironmentTexture(prefiltered)
+        .draw(plane);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* The result is the environment color attenuated by the diffuse albedo
+       of 0.96 and with a bit of specular reflection added. It can't be
+       brighter than the environment itself. */
+    Image2D image = framebuffer.read(framebuffer.viewport(), {PixelFormat::RGBA8Unorm});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    const Color4ub pixel = image.pixels<Color4ub>()[RenderSize.y()/2][RenderSize.x()/2];
+    CORRADE_COMPARE(pixel.r(), pixel.g());
+    CORRADE_COMPARE(pixel.r(), pixel.b());
+    CORRADE_COMPARE_AS(Int(pixel.r()), 0x80*96/100 - 2, TestSuite::Compare::GreaterOrEqual);
+    CORRADE_COMPARE_AS(Int(pixel.r()), 0x80 + 1, TestSuite::Compare::LessOrEqual);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Shaders::Test::PbrGLTest)
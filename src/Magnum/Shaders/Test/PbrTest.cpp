@@ -0,0 +1,350 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <new>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Shaders/Pbr.h"
+
+namespace Magnum { namespace Shaders { namespace Test { namespace {
+
+struct PbrTest: TestSuite::Tester {
+    explicit PbrTest();
+
+    template<class T> void uniformSizeAlignment();
+
+    void drawUniformConstructDefault();
+    void drawUniformConstructNoInit();
+    void drawUniformSetters();
+
+    void materialUniformConstructDefault();
+    void materialUniformConstructNoInit();
+    void materialUniformSetters();
+
+    void imageBasedLightingUniformConstructDefault();
+    void imageBasedLightingUniformConstructNoInit();
+    void imageBasedLightingUniformSetters();
+};
+
+PbrTest::PbrTest() {
+    addTests({&PbrTest::uniformSizeAlignment<PbrDrawUniform>,
+              &PbrTest::uniformSizeAlignment<PbrMaterialUniform>,
+              &PbrTest::uniformSizeAlignment<PbrImageBasedLightingUniform>,
+
+              &PbrTest::drawUniformConstructDefault,
+              &PbrTest::drawUniformConstructNoInit,
+              &PbrTest::drawUniformSetters,
+
+              &PbrTest::materialUniformConstructDefault,
+              &PbrTest::materialUniformConstructNoInit,
+              &PbrTest::materialUniformSetters,
+
+              &PbrTest::imageBasedLightingUniformConstructDefault,
+              &PbrTest::imageBasedLightingUniformConstructNoInit,
+              &PbrTest::imageBasedLightingUniformSetters});
+}
+
+using namespace Math::Literals;
+
+template<class> struct UniformTraits;
+template<> struct UniformTraits<PbrDrawUniform> {
+    static const char* name() { return "PbrDrawUniform"; }
+};
+template<> struct UniformTraits<PbrMaterialUniform> {
+    static const char* name() { return "PbrMaterialUniform"; }
+};
+template<> struct UniformTraits<PbrImageBasedLightingUniform> {
+    static const char* name() { return "PbrImageBasedLightingUniform"; }
+};
+
+template<class T> void PbrTest::uniformSizeAlignment() {
+    setTestCaseTemplateName(UniformTraits<T>::name());
+
+    CORRADE_FAIL_IF(sizeof(T) % sizeof(Vector4) != 0, sizeof(T) << "is not a multiple of vec4 for UBO alignment.");
+
+    /* 48-byte structures are fine, we'll align them to 768 bytes and not
+       256, but warn about that */
+    CORRADE_FAIL_IF(768 % sizeof(T) != 0, sizeof(T) << "can't fit exactly into 768-byte UBO alignment.");
+    if(256 % sizeof(T) != 0)
+        CORRADE_WARN(sizeof(T) << "can't fit exactly into 256-byte UBO alignment, only 768.");
+
+    CORRADE_COMPARE(alignof(T), 4);
+}
+
+void PbrTest::drawUniformConstructDefault() {
+    PbrDrawUniform a;
+    PbrDrawUniform b{DefaultInit};
+    CORRADE_COMPARE(a.normalMatrix, (Matrix3x4{
+        Vector4{1.0f, 0.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 1.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 0.0f, 1.0f, 0.0f}
+    }));
+    CORRADE_COMPARE(b.normalMatrix, (Matrix3x4{
+        Vector4{1.0f, 0.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 1.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 0.0f, 1.0f, 0.0f}
+    }));
+    CORRADE_COMPARE(a.materialId, 0);
+    CORRADE_COMPARE(b.materialId, 0);
+    CORRADE_COMPARE(a.lightOffset, 0);
+    CORRADE_COMPARE(b.lightOffset, 0);
+    CORRADE_COMPARE(a.lightCount, 0xffffffffu);
+    CORRADE_COMPARE(b.lightCount, 0xffffffffu);
+
+    constexpr PbrDrawUniform ca;
+    constexpr PbrDrawUniform cb{DefaultInit};
+    CORRADE_COMPARE(ca.normalMatrix, (Matrix3x4{
+        Vector4{1.0f, 0.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 1.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 0.0f, 1.0f, 0.0f}
+    }));
+    CORRADE_COMPARE(cb.normalMatrix, (Matrix3x4{
+        Vector4{1.0f, 0.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 1.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 0.0f, 1.0f, 0.0f}
+    }));
+    CORRADE_COMPARE(ca.materialId, 0);
+    CORRADE_COMPARE(cb.materialId, 0);
+    CORRADE_COMPARE(ca.lightOffset, 0);
+    CORRADE_COMPARE(cb.lightOffset, 0);
+    CORRADE_COMPARE(ca.lightCount, 0xffffffffu);
+    CORRADE_COMPARE(cb.lightCount, 0xffffffffu);
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<PbrDrawUniform>::value);
+    CORRADE_VERIFY(std::is_nothrow_constructible<PbrDrawUniform, DefaultInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<DefaultInitT, PbrDrawUniform>::value);
+}
+
+void PbrTest::drawUniformConstructNoInit() {
+    /* Testing only some fields, should be enough */
+    PbrDrawUniform a;
+    a.normalMatrix[2] = {1.5f, 0.3f, 3.1f, 0.5f};
+    a.materialId = 5;
+    a.lightCount = 7;
+
+    new(&a) PbrDrawUniform{NoInit};
+    {
+        /* Explicitly check we're not on Clang because certain Clang-based IDEs
+           inherit __GNUC__ if GCC is used instead of leaving it at 4 like
+           Clang itself does */
+        #if defined(CORRADE_TARGET_GCC) && !defined(CORRADE_TARGET_CLANG) && __GNUC__*100 + __GNUC_MINOR__ >= 601 && __OPTIMIZE__
+        CORRADE_EXPECT_FAIL("GCC 6.1+ misoptimizes and overwrites the value.");
+        #endif
+        CORRADE_COMPARE(a.normalMatrix[2], (Vector4{1.5f, 0.3f, 3.1f, 0.5f}));
+        CORRADE_COMPARE(a.materialId, 5);
+        CORRADE_COMPARE(a.lightCount, 7);
+    }
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<PbrDrawUniform, NoInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoInitT, PbrDrawUniform>::value);
+}
+
+void PbrTest::drawUniformSetters() {
+    PbrDrawUniform a;
+    a.setNormalMatrix(Matrix4::rotationX(90.0_degf).normalMatrix())
+     .setMaterialId(5)
+     .setLightOffsetCount(9, 13);
+    CORRADE_COMPARE(a.normalMatrix, (Matrix3x4{
+        Vector4{1.0f,  0.0f, 0.0f, 0.0f},
+        Vector4{0.0f,  0.0f, 1.0f, 0.0f},
+        Vector4{0.0f, -1.0f, 0.0f, 0.0f}
+    }));
+    CORRADE_COMPARE(a.materialId, 5);
+    CORRADE_COMPARE(a.lightOffset, 9);
+    CORRADE_COMPARE(a.lightCount, 13);
+}
+
+void PbrTest::materialUniformConstructDefault() {
+    PbrMaterialUniform a;
+    PbrMaterialUniform b{DefaultInit};
+    CORRADE_COMPARE(a.baseColor, 0xffffffff_rgbaf);
+    CORRADE_COMPARE(b.baseColor, 0xffffffff_rgbaf);
+    CORRADE_COMPARE(a.emissiveColor, 0x000000_rgbf);
+    CORRADE_COMPARE(b.emissiveColor, 0x000000_rgbf);
+    CORRADE_COMPARE(a.normalTextureScale, 1.0f);
+    CORRADE_COMPARE(b.normalTextureScale, 1.0f);
+    CORRADE_COMPARE(a.metalness, 1.0f);
+    CORRADE_COMPARE(b.metalness, 1.0f);
+    CORRADE_COMPARE(a.roughness, 1.0f);
+    CORRADE_COMPARE(b.roughness, 1.0f);
+    CORRADE_COMPARE(a.occlusionStrength, 1.0f);
+    CORRADE_COMPARE(b.occlusionStrength, 1.0f);
+    CORRADE_COMPARE(a.alphaMask, 0.5f);
+    CORRADE_COMPARE(b.alphaMask, 0.5f);
+
+    constexpr PbrMaterialUniform ca;
+    constexpr PbrMaterialUniform cb{DefaultInit};
+    CORRADE_COMPARE(ca.baseColor, 0xffffffff_rgbaf);
+    CORRADE_COMPARE(cb.baseColor, 0xffffffff_rgbaf);
+    CORRADE_COMPARE(ca.emissiveColor, 0x000000_rgbf);
+    CORRADE_COMPARE(cb.emissiveColor, 0x000000_rgbf);
+    CORRADE_COMPARE(ca.normalTextureScale, 1.0f);
+    CORRADE_COMPARE(cb.normalTextureScale, 1.0f);
+    CORRADE_COMPARE(ca.metalness, 1.0f);
+    CORRADE_COMPARE(cb.metalness, 1.0f);
+    CORRADE_COMPARE(ca.roughness, 1.0f);
+    CORRADE_COMPARE(cb.roughness, 1.0f);
+    CORRADE_COMPARE(ca.occlusionStrength, 1.0f);
+    CORRADE_COMPARE(cb.occlusionStrength, 1.0f);
+    CORRADE_COMPARE(ca.alphaMask, 0.5f);
+    CORRADE_COMPARE(cb.alphaMask, 0.5f);
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<PbrMaterialUniform>::value);
+    CORRADE_VERIFY(std::is_nothrow_constructible<PbrMaterialUniform, DefaultInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<DefaultInitT, PbrMaterialUniform>::value);
+}
+
+void PbrTest::materialUniformConstructNoInit() {
+    /* Testing only some fields, should be enough */
+    PbrMaterialUniform a;
+    a.baseColor = 0x354565fc_rgbaf;
+    a.roughness = 0.25f;
+
+    new(&a) PbrMaterialUniform{NoInit};
+    {
+        /* Explicitly check we're not on Clang because certain Clang-based IDEs
+           inherit __GNUC__ if GCC is used instead of leaving it at 4 like
+           Clang itself does */
+        #if defined(CORRADE_TARGET_GCC) && !defined(CORRADE_TARGET_CLANG) && __GNUC__*100 + __GNUC_MINOR__ >= 601 && __OPTIMIZE__
+        CORRADE_EXPECT_FAIL("GCC 6.1+ misoptimizes and overwrites the value.");
+        #endif
+        CORRADE_COMPARE(a.baseColor, 0x354565fc_rgbaf);
+        CORRADE_COMPARE(a.roughness, 0.25f);
+    }
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<PbrMaterialUniform, NoInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoInitT, PbrMaterialUniform>::value);
+}
+
+void PbrTest::materialUniformSetters() {
+    PbrMaterialUniform a;
+    a.setBaseColor(0x354565fc_rgbaf)
+     .setEmissiveColor(0x9933ff_rgbf)
+     .setNormalTextureScale(0.5f)
+     .setMetalness(0.25f)
+     .setRoughness(0.75f)
+     .setOcclusionStrength(0.125f)
+     .setAlphaMask(0.7f);
+    CORRADE_COMPARE(a.baseColor, 0x354565fc_rgbaf);
+    CORRADE_COMPARE(a.emissiveColor, 0x9933ff_rgbf);
+    CORRADE_COMPARE(a.normalTextureScale, 0.5f);
+    CORRADE_COMPARE(a.metalness, 0.25f);
+    CORRADE_COMPARE(a.roughness, 0.75f);
+    CORRADE_COMPARE(a.occlusionStrength, 0.125f);
+    CORRADE_COMPARE(a.alphaMask, 0.7f);
+}
+
+void PbrTest::imageBasedLightingUniformConstructDefault() {
+    PbrImageBasedLightingUniform a;
+    PbrImageBasedLightingUniform b{DefaultInit};
+    CORRADE_COMPARE(a.environmentRotation, (Matrix3x4{
+        Vector4{1.0f, 0.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 1.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 0.0f, 1.0f, 0.0f}
+    }));
+    CORRADE_COMPARE(b.environmentRotation, (Matrix3x4{
+        Vector4{1.0f, 0.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 1.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 0.0f, 1.0f, 0.0f}
+    }));
+    CORRADE_COMPARE(a.intensity, 1.0f);
+    CORRADE_COMPARE(b.intensity, 1.0f);
+    CORRADE_COMPARE(a.levelCount, 1);
+    CORRADE_COMPARE(b.levelCount, 1);
+
+    constexpr PbrImageBasedLightingUniform ca;
+    constexpr PbrImageBasedLightingUniform cb{DefaultInit};
+    CORRADE_COMPARE(ca.environmentRotation, (Matrix3x4{
+        Vector4{1.0f, 0.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 1.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 0.0f, 1.0f, 0.0f}
+    }));
+    CORRADE_COMPARE(cb.environmentRotation, (Matrix3x4{
+        Vector4{1.0f, 0.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 1.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 0.0f, 1.0f, 0.0f}
+    }));
+    CORRADE_COMPARE(ca.intensity, 1.0f);
+    CORRADE_COMPARE(cb.intensity, 1.0f);
+    CORRADE_COMPARE(ca.levelCount, 1);
+    CORRADE_COMPARE(cb.levelCount, 1);
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<PbrImageBasedLightingUniform>::value);
+    CORRADE_VERIFY(std::is_nothrow_constructible<PbrImageBasedLightingUniform, DefaultInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<DefaultInitT, PbrImageBasedLightingUniform>::value);
+}
+
+void PbrTest::imageBasedLightingUniformConstructNoInit() {
+    /* Testing only some fields, should be enough */
+    PbrImageBasedLightingUniform a;
+    a.environmentRotation[1] = {1.5f, 0.3f, 3.1f, 0.5f};
+    a.levelCount = 7;
+
+    new(&a) PbrImageBasedLightingUniform{NoInit};
+    {
+        /* Explicitly check we're not on Clang because certain Clang-based IDEs
+           inherit __GNUC__ if GCC is used instead of leaving it at 4 like
+           Clang itself does */
+        #if defined(CORRADE_TARGET_GCC) && !defined(CORRADE_TARGET_CLANG) && __GNUC__*100 + __GNUC_MINOR__ >= 601 && __OPTIMIZE__
+        CORRADE_EXPECT_FAIL("GCC 6.1+ misoptimizes and overwrites the value.");
+        #endif
+        CORRADE_COMPARE(a.environmentRotation[1], (Vector4{1.5f, 0.3f, 3.1f, 0.5f}));
+        CORRADE_COMPARE(a.levelCount, 7);
+    }
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<PbrImageBasedLightingUniform, NoInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoInitT, PbrImageBasedLightingUniform>::value);
+}
+
+void PbrTest::imageBasedLightingUniformSetters() {
+    PbrImageBasedLightingUniform a;
+    a.setEnvironmentRotation(Matrix4::rotationX(90.0_degf).rotationScaling())
+     .setIntensity(0.5f)
+     .setLevelCount(6);
+    CORRADE_COMPARE(a.environmentRotation, (Matrix3x4{
+        Vector4{1.0f,  0.0f, 0.0f, 0.0f},
+        Vector4{0.0f,  0.0f, 1.0f, 0.0f},
+        Vector4{0.0f, -1.0f, 0.0f, 0.0f}
+    }));
+    CORRADE_COMPARE(a.intensity, 0.5f);
+    CORRADE_COMPARE(a.levelCount, 6);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Shaders::Test::PbrTest)
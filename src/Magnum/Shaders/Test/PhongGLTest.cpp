@@ -33,10 +33,10 @@
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/FormatStl.h>
 #include <Corrade/Utility/Path.h>
+#include <Corrade/Utility/System.h>
 
 #ifdef CORRADE_TARGET_APPLE
 #include <Corrade/Containers/Pair.h>
-#include <Corrade/Utility/System.h> /* isSandboxed() */
 #endif
 
 #include "Magnum/Image.h"
@@ -73,6 +73,12 @@
 #include "Magnum/Primitives/Cone.h"
 #include "Magnum/Shaders/Generic.h"
 #include "Magnum/Shaders/Phong.h"
+#include "Magnum/Shaders/ShadowCascade.h"
+#endif
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include "Magnum/Shaders/LightCluster.h"
+#include "Magnum/Shaders/LightClusterGL.h"
 #endif
 
 #include "configure.h"
@@ -87,11 +93,20 @@ struct PhongGLTest: GL::OpenGLTester {
     void constructUniformBuffers();
     #endif
 
+    void constructAsync();
+    #ifndef MAGNUM_TARGET_GLES2
+    void constructUniformBuffersAsync();
+    #endif
+
     void constructMove();
     #ifndef MAGNUM_TARGET_GLES2
     void constructMoveUniformBuffers();
     #endif
 
+    #ifndef MAGNUM_TARGET_GLES2
+    void constructSkinning();
+    void constructSkinningInvalid();
+    #endif
     void constructInvalid();
     #ifndef MAGNUM_TARGET_GLES2
     void constructUniformBuffersInvalid();
@@ -101,6 +116,12 @@ struct PhongGLTest: GL::OpenGLTester {
     void setUniformUniformBuffersEnabled();
     void bindBufferUniformBuffersNotEnabled();
     #endif
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    void bindBufferLightClustersNotEnabled();
+    #endif
+    #ifndef MAGNUM_TARGET_GLES2
+    void bindShadowMapsNotEnabled();
+    #endif
     void bindTexturesInvalid();
     #ifndef MAGNUM_TARGET_GLES2
     void bindTextureArraysInvalid();
@@ -120,6 +141,8 @@ struct PhongGLTest: GL::OpenGLTester {
     void setWrongLightId();
     #ifndef MAGNUM_TARGET_GLES2
     void setWrongDrawOffset();
+    void setWrongJointCountOrId();
+    void setPerVertexJointCountInvalid();
     #endif
 
     void renderSetup();
@@ -157,11 +180,23 @@ struct PhongGLTest: GL::OpenGLTester {
     #ifndef MAGNUM_TARGET_GLES2
     void renderLightCulling();
     #endif
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    void renderLightClusters();
+    #endif
 
     template<PhongGL::Flag flag = PhongGL::Flag{}> void renderZeroLights();
 
+    void renderDepthPrepass();
+    #ifndef MAGNUM_TARGET_GLES2
+    void renderShadowMaps();
+    #endif
+
     template<PhongGL::Flag flag = PhongGL::Flag{}> void renderInstanced();
 
+    #ifndef MAGNUM_TARGET_GLES2
+    template<PhongGL::Flag flag = PhongGL::Flag{}> void renderSkinning();
+    #endif
+
     #ifndef MAGNUM_TARGET_GLES2
     void renderMulti();
     #endif
@@ -250,6 +285,10 @@ constexpr struct {
     {"object ID texture, zero lights", PhongGL::Flag::ObjectIdTexture, 0},
     #endif
     {"no specular", PhongGL::Flag::NoSpecular, 1},
+    {"depth only", PhongGL::Flag::DepthOnly, 1},
+    {"depth only + alpha mask + ambient and diffuse texture", PhongGL::Flag::DepthOnly|PhongGL::Flag::AlphaMask|PhongGL::Flag::AmbientTexture|PhongGL::Flag::DiffuseTexture, 1},
+    {"depth only + alpha mask + vertex colors, zero lights", PhongGL::Flag::DepthOnly|PhongGL::Flag::AlphaMask|PhongGL::Flag::VertexColor, 0},
+    {"depth only + instanced transformation", PhongGL::Flag::DepthOnly|PhongGL::Flag::InstancedTransformation, 3},
     {"five lights", {}, 5},
     {"zero lights", {}, 0},
     {"instanced transformation", PhongGL::Flag::InstancedTransformation, 3},
@@ -290,6 +329,10 @@ constexpr struct {
     {"instanced object ID texture array + texture transformation", PhongGL::Flag::UniformBuffers|PhongGL::Flag::ObjectIdTexture|PhongGL::Flag::InstancedObjectId|PhongGL::Flag::TextureArrays|PhongGL::Flag::TextureTransformation, 1, 1, 1},
     {"object ID texture + diffuse texture", PhongGL::Flag::UniformBuffers|PhongGL::Flag::ObjectIdTexture|PhongGL::Flag::DiffuseTexture, 1, 1, 1},
     {"no specular", PhongGL::Flag::UniformBuffers|PhongGL::Flag::NoSpecular, 1, 1, 1},
+    {"depth only + alpha mask", PhongGL::Flag::UniformBuffers|PhongGL::Flag::DepthOnly|PhongGL::Flag::AlphaMask, 8, 8, 24},
+    {"shadow maps", PhongGL::Flag::ShadowMaps, 1, 1, 1},
+    {"shadow maps + light culling", PhongGL::Flag::ShadowMaps|PhongGL::Flag::LightCulling, 8, 4, 16},
+    {"multidraw + shadow maps", PhongGL::Flag::MultiDraw|PhongGL::Flag::ShadowMaps|PhongGL::Flag::NoSpecular, 4, 8, 24},
     {"multidraw with all the things", PhongGL::Flag::MultiDraw|PhongGL::Flag::TextureTransformation|PhongGL::Flag::DiffuseTexture|PhongGL::Flag::AmbientTexture|PhongGL::Flag::SpecularTexture|PhongGL::Flag::NormalTexture|PhongGL::Flag::TextureArrays|PhongGL::Flag::AlphaMask|PhongGL::Flag::ObjectId|PhongGL::Flag::InstancedTextureOffset|PhongGL::Flag::InstancedTransformation|PhongGL::Flag::InstancedObjectId|PhongGL::Flag::LightCulling, 8, 16, 24}
 };
 #endif
@@ -317,10 +360,21 @@ constexpr struct {
     {"conflicting bitangent and instanced object id attribute",
         PhongGL::Flag::Bitangent|PhongGL::Flag::InstancedObjectId,
         "Bitangent attribute binding conflicts with the ObjectId attribute, use a Tangent4 attribute with instanced object ID rendering instead"},
+    {"depth only + object ID",
+        PhongGL::Flag::DepthOnly|PhongGL::Flag::ObjectId,
+        "depth-only rendering is mutually exclusive with object ID and order-independent transparency"},
+    {"depth only + order-independent transparency",
+        PhongGL::Flag::DepthOnly|PhongGL::Flag::OrderIndependentTransparency,
+        "depth-only rendering is mutually exclusive with object ID and order-independent transparency"},
     #endif
     {"specular texture but no specular",
         PhongGL::Flag::SpecularTexture|PhongGL::Flag::NoSpecular,
-        "specular texture requires the shader to not have specular disabled"}
+        "specular texture requires the shader to not have specular disabled"},
+    #ifndef MAGNUM_TARGET_GLES
+    {"bindless textures but no uniform buffers",
+        PhongGL::Flag::DiffuseTexture|PhongGL::Flag::BindlessTextures,
+        "bindless textures require uniform buffers to be enabled"}
+    #endif
 };
 
 #ifndef MAGNUM_TARGET_GLES2
@@ -337,7 +391,48 @@ constexpr struct {
     {"texture arrays but no transformation", PhongGL::Flag::UniformBuffers|PhongGL::Flag::DiffuseTexture|PhongGL::Flag::TextureArrays, 1, 1, 1,
         "texture arrays require texture transformation enabled as well if uniform buffers are used"},
     {"light culling but no UBOs", PhongGL::Flag::LightCulling, 1, 1, 1,
-        "light culling requires uniform buffers to be enabled"}
+        "light culling requires uniform buffers to be enabled"},
+    {"shadow maps but zero lights", PhongGL::Flag::ShadowMaps, 0, 1, 1,
+        "shadow maps require a non-zero light count"},
+    {"shadow maps + depth only", PhongGL::Flag::ShadowMaps|PhongGL::Flag::DepthOnly, 1, 1, 1,
+        "shadow maps are mutually exclusive with depth-only rendering"},
+    #ifndef MAGNUM_TARGET_WEBGL
+    {"light clusters + light culling", PhongGL::Flag::LightClusters|PhongGL::Flag::LightCulling, 1, 1, 1,
+        "light clusters and light culling are mutually exclusive"},
+    {"light clusters but zero lights", PhongGL::Flag::LightClusters, 0, 1, 1,
+        "light clusters require a non-zero light count"},
+    #endif
+};
+#endif
+
+#ifndef MAGNUM_TARGET_GLES2
+constexpr struct {
+    const char* name;
+    PhongGL::Flags flags;
+    UnsignedInt jointCount, perVertexJointCount, secondaryPerVertexJointCount;
+} ConstructSkinningData[]{
+    {"one set", {}, 16, 4, 0},
+    {"two partial sets", {}, 32, 2, 3},
+    {"secondary set only", {}, 12, 0, 4},
+    {"dynamic", PhongGL::Flag::DynamicPerVertexJointCount, 16, 4, 4},
+    {"instanced", PhongGL::Flag::InstancedTransformation, 16, 4, 0},
+    {"uniform buffers", PhongGL::Flag::UniformBuffers, 16, 4, 4},
+    {"uniform buffers + dynamic", PhongGL::Flag::UniformBuffers|PhongGL::Flag::DynamicPerVertexJointCount, 16, 4, 4},
+    {"multidraw", PhongGL::Flag::MultiDraw, 64, 2, 1},
+};
+
+constexpr struct {
+    const char* name;
+    PhongGL::Flags flags;
+    UnsignedInt jointCount, perVertexJointCount, secondaryPerVertexJointCount;
+    const char* message;
+} ConstructSkinningInvalidData[]{
+    {"dynamic per-vertex joint count but no joints",
+        PhongGL::Flag::DynamicPerVertexJointCount, 0, 0, 0,
+        "dynamic per-vertex joint count enabled for zero joints"},
+    {"secondary joints + instanced transformation",
+        PhongGL::Flag::InstancedTransformation, 16, 2, 2,
+        "secondary per-vertex joint attributes conflict with the instanced TransformationMatrix attribute"},
 };
 #endif
 
@@ -742,6 +837,40 @@ const struct {
 };
 #endif
 
+#ifndef MAGNUM_TARGET_GLES2
+constexpr struct {
+    const char* name;
+    PhongGL::Flags flags;
+    UnsignedInt jointCount, perVertexJointCount, secondaryPerVertexJointCount;
+    UnsignedInt dynamicPerVertexJointCount, dynamicSecondaryPerVertexJointCount;
+    Vector4ui jointIds, secondaryJointIds;
+    Vector4 weights, secondaryWeights;
+} RenderSkinningData[]{
+    {"primary joints",
+        {}, 2, 2, 0, 0, 0,
+        {0, 1, 0, 0}, {},
+        {0.5f, 0.5f, 0.0f, 0.0f}, {}},
+    {"primary + secondary joints",
+        {}, 2, 1, 1, 0, 0,
+        {0, 0, 0, 0}, {1, 0, 0, 0},
+        {0.5f, 0.0f, 0.0f, 0.0f}, {0.5f, 0.0f, 0.0f, 0.0f}},
+    {"secondary joints only",
+        {}, 2, 0, 2, 0, 0,
+        {}, {1, 0, 0, 0},
+        {}, {0.5f, 0.5f, 0.0f, 0.0f}},
+    /* The extra components reference a joint with a garbage matrix, it
+       should be ignored */
+    {"dynamic primary joint count",
+        PhongGL::Flag::DynamicPerVertexJointCount, 3, 4, 0, 2, 0,
+        {0, 1, 2, 2}, {},
+        {0.5f, 0.5f, 1.0f, 1.0f}, {}},
+    {"dynamic secondary joint count",
+        PhongGL::Flag::DynamicPerVertexJointCount, 3, 2, 3, 2, 0,
+        {0, 1, 0, 0}, {2, 2, 2, 0},
+        {0.5f, 0.5f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f, 0.0f}},
+};
+#endif
+
 constexpr struct {
     const char* name;
     const char* expected;
@@ -933,15 +1062,30 @@ PhongGLTest::PhongGLTest() {
     #endif
 
     addTests({
+        &PhongGLTest::constructAsync,
+        #ifndef MAGNUM_TARGET_GLES2
+        &PhongGLTest::constructUniformBuffersAsync,
+        #endif
+
         &PhongGLTest::constructMove,
         #ifndef MAGNUM_TARGET_GLES2
         &PhongGLTest::constructMoveUniformBuffers,
         #endif
     });
 
+    #ifndef MAGNUM_TARGET_GLES2
+    addInstancedTests({&PhongGLTest::constructSkinning},
+        Containers::arraySize(ConstructSkinningData));
+    #endif
+
     addInstancedTests({&PhongGLTest::constructInvalid},
         Containers::arraySize(ConstructInvalidData));
 
+    #ifndef MAGNUM_TARGET_GLES2
+    addInstancedTests({&PhongGLTest::constructSkinningInvalid},
+        Containers::arraySize(ConstructSkinningInvalidData));
+    #endif
+
     #ifndef MAGNUM_TARGET_GLES2
     addInstancedTests({
         &PhongGLTest::constructUniformBuffersInvalid},
@@ -953,6 +1097,14 @@ PhongGLTest::PhongGLTest() {
               &PhongGLTest::bindBufferUniformBuffersNotEnabled});
     #endif
 
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    addTests({&PhongGLTest::bindBufferLightClustersNotEnabled});
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES2
+    addTests({&PhongGLTest::bindShadowMapsNotEnabled});
+    #endif
+
     addInstancedTests({&PhongGLTest::bindTexturesInvalid},
         Containers::arraySize(BindTexturesInvalidData));
 
@@ -978,7 +1130,9 @@ PhongGLTest::PhongGLTest() {
         &PhongGLTest::setWrongLightCount,
         &PhongGLTest::setWrongLightId,
         #ifndef MAGNUM_TARGET_GLES2
-        &PhongGLTest::setWrongDrawOffset
+        &PhongGLTest::setWrongDrawOffset,
+        &PhongGLTest::setWrongJointCountOrId,
+        &PhongGLTest::setPerVertexJointCountInvalid
         #endif
     });
 
@@ -1097,7 +1251,10 @@ PhongGLTest::PhongGLTest() {
         &PhongGLTest::renderLightsSetOneByOne,
         &PhongGLTest::renderLowLightAngle,
         #ifndef MAGNUM_TARGET_GLES2
-        &PhongGLTest::renderLightCulling
+        &PhongGLTest::renderLightCulling,
+        #endif
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        &PhongGLTest::renderLightClusters
         #endif
         },
         &PhongGLTest::renderSetup,
@@ -1119,6 +1276,14 @@ PhongGLTest::PhongGLTest() {
         #endif
     );
 
+    addTests({&PhongGLTest::renderDepthPrepass,
+              #ifndef MAGNUM_TARGET_GLES2
+              &PhongGLTest::renderShadowMaps
+              #endif
+              },
+        &PhongGLTest::renderSetup,
+        &PhongGLTest::renderTeardown);
+
     /* MSVC needs explicit type due to default template args */
     addInstancedTests<PhongGLTest>({
         &PhongGLTest::renderInstanced,
@@ -1136,6 +1301,17 @@ PhongGLTest::PhongGLTest() {
         #endif
     );
 
+    #ifndef MAGNUM_TARGET_GLES2
+    /* MSVC needs explicit type due to default template args */
+    addInstancedTests<PhongGLTest>({
+        &PhongGLTest::renderSkinning,
+        &PhongGLTest::renderSkinning<PhongGL::Flag::UniformBuffers>
+        },
+        Containers::arraySize(RenderSkinningData),
+        &PhongGLTest::renderSetup,
+        &PhongGLTest::renderTeardown);
+    #endif
+
     #ifndef MAGNUM_TARGET_GLES2
     addInstancedTests({&PhongGLTest::renderMulti},
         Containers::arraySize(RenderMultiData),
@@ -1236,6 +1412,61 @@ void PhongGLTest::constructUniformBuffers() {
 }
 #endif
 
+void PhongGLTest::constructAsync() {
+    PhongGL::CompileState state = PhongGL::compile(PhongGL::Flag::DiffuseTexture|PhongGL::Flag::NormalTexture, 3);
+    CORRADE_COMPARE(state.flags(), PhongGL::Flag::DiffuseTexture|PhongGL::Flag::NormalTexture);
+    CORRADE_COMPARE(state.lightCount(), 3);
+
+    while(!state.isLinkFinished())
+        Utility::System::sleep(100);
+
+    PhongGL shader{std::move(state)};
+    CORRADE_COMPARE(shader.flags(), PhongGL::Flag::DiffuseTexture|PhongGL::Flag::NormalTexture);
+    CORRADE_COMPARE(shader.lightCount(), 3);
+    CORRADE_VERIFY(shader.id());
+    {
+        #if defined(CORRADE_TARGET_APPLE) && !defined(MAGNUM_TARGET_GLES)
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+void PhongGLTest::constructUniformBuffersAsync() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() << "is not supported.");
+    #endif
+
+    PhongGL::CompileState state = PhongGL::compile(PhongGL::Flag::UniformBuffers|PhongGL::Flag::DiffuseTexture, 3, 4, 5);
+    CORRADE_COMPARE(state.flags(), PhongGL::Flag::UniformBuffers|PhongGL::Flag::DiffuseTexture);
+    CORRADE_COMPARE(state.lightCount(), 3);
+    CORRADE_COMPARE(state.materialCount(), 4);
+    CORRADE_COMPARE(state.drawCount(), 5);
+
+    while(!state.isLinkFinished())
+        Utility::System::sleep(100);
+
+    PhongGL shader{std::move(state)};
+    CORRADE_COMPARE(shader.flags(), PhongGL::Flag::UniformBuffers|PhongGL::Flag::DiffuseTexture);
+    CORRADE_COMPARE(shader.lightCount(), 3);
+    CORRADE_COMPARE(shader.materialCount(), 4);
+    CORRADE_COMPARE(shader.drawCount(), 5);
+    CORRADE_VERIFY(shader.id());
+    {
+        #if defined(CORRADE_TARGET_APPLE) && !defined(MAGNUM_TARGET_GLES)
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+#endif
+
 void PhongGLTest::constructMove() {
     PhongGL a{PhongGL::Flag::AlphaMask, 3};
     const GLuint id = a.id();
@@ -1289,6 +1520,53 @@ void PhongGLTest::constructMoveUniformBuffers() {
 }
 #endif
 
+#ifndef MAGNUM_TARGET_GLES2
+void PhongGLTest::constructSkinning() {
+    auto&& data = ConstructSkinningData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::gpu_shader4>())
+        CORRADE_SKIP(GL::Extensions::EXT::gpu_shader4::string() << "is not supported.");
+    if((data.flags & PhongGL::Flag::UniformBuffers) && !GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() << "is not supported.");
+    #endif
+
+    if(data.flags >= PhongGL::Flag::MultiDraw) {
+        #ifndef MAGNUM_TARGET_GLES
+        if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::shader_draw_parameters>())
+            CORRADE_SKIP(GL::Extensions::ARB::shader_draw_parameters::string() << "is not supported.");
+        #elif !defined(MAGNUM_TARGET_WEBGL)
+        if(!GL::Context::current().isExtensionSupported<GL::Extensions::ANGLE::multi_draw>())
+            CORRADE_SKIP(GL::Extensions::ANGLE::multi_draw::string() << "is not supported.");
+        #else
+        if(!GL::Context::current().isExtensionSupported<GL::Extensions::WEBGL::multi_draw>())
+            CORRADE_SKIP(GL::Extensions::WEBGL::multi_draw::string() << "is not supported.");
+        #endif
+    }
+
+    PhongGL shader{PhongGL::Configuration{}
+        .setFlags(data.flags)
+        .setJointCount(data.jointCount, data.perVertexJointCount, data.secondaryPerVertexJointCount)};
+    CORRADE_COMPARE(shader.flags(), data.flags);
+    CORRADE_COMPARE(shader.lightCount(), 1);
+    CORRADE_COMPARE(shader.materialCount(), 1);
+    CORRADE_COMPARE(shader.drawCount(), 1);
+    CORRADE_COMPARE(shader.jointCount(), data.jointCount);
+    CORRADE_COMPARE(shader.perVertexJointCount(), data.perVertexJointCount);
+    CORRADE_COMPARE(shader.secondaryPerVertexJointCount(), data.secondaryPerVertexJointCount);
+    CORRADE_VERIFY(shader.id());
+    {
+        #if defined(CORRADE_TARGET_APPLE) && !defined(MAGNUM_TARGET_GLES)
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+#endif
+
 void PhongGLTest::constructInvalid() {
     auto&& data = ConstructInvalidData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
@@ -1302,6 +1580,23 @@ void PhongGLTest::constructInvalid() {
         "Shaders::PhongGL: {}\n", data.message));
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+void PhongGLTest::constructSkinningInvalid() {
+    auto&& data = ConstructSkinningInvalidData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    PhongGL{PhongGL::Configuration{}
+        .setFlags(data.flags)
+        .setJointCount(data.jointCount, data.perVertexJointCount, data.secondaryPerVertexJointCount)};
+    CORRADE_COMPARE(out.str(), Utility::formatString(
+        "Shaders::PhongGL: {}\n", data.message));
+}
+#endif
+
 #ifndef MAGNUM_TARGET_GLES2
 void PhongGLTest::constructUniformBuffersInvalid() {
     auto&& data = ConstructUniformBuffersInvalidData[testCaseInstanceId()];
@@ -1354,7 +1649,9 @@ void PhongGLTest::setUniformUniformBuffersEnabled() {
           .setLightSpecularColors({})
           .setLightSpecularColor(0, {})
           .setLightRanges({})
-          .setLightRange(0, {});
+          .setLightRange(0, {})
+          .setJointMatrices({})
+          .setJointMatrix(0, {});
     CORRADE_COMPARE(out.str(),
         "Shaders::PhongGL::setAmbientColor(): the shader was created with uniform buffers enabled\n"
         "Shaders::PhongGL::setDiffuseColor(): the shader was created with uniform buffers enabled\n"
@@ -1375,7 +1672,9 @@ void PhongGLTest::setUniformUniformBuffersEnabled() {
         "Shaders::PhongGL::setLightSpecularColors(): the shader was created with uniform buffers enabled\n"
         "Shaders::PhongGL::setLightSpecularColor(): the shader was created with uniform buffers enabled\n"
         "Shaders::PhongGL::setLightRanges(): the shader was created with uniform buffers enabled\n"
-        "Shaders::PhongGL::setLightRange(): the shader was created with uniform buffers enabled\n");
+        "Shaders::PhongGL::setLightRange(): the shader was created with uniform buffers enabled\n"
+        "Shaders::PhongGL::setJointMatrices(): the shader was created with uniform buffers enabled\n"
+        "Shaders::PhongGL::setJointMatrix(): the shader was created with uniform buffers enabled\n");
 }
 
 void PhongGLTest::bindBufferUniformBuffersNotEnabled() {
@@ -1398,6 +1697,8 @@ void PhongGLTest::bindBufferUniformBuffersNotEnabled() {
           .bindMaterialBuffer(buffer, 0, 16)
           .bindLightBuffer(buffer)
           .bindLightBuffer(buffer, 0, 16)
+          .bindJointBuffer(buffer)
+          .bindJointBuffer(buffer, 0, 16)
           .setDrawOffset(0);
     CORRADE_COMPARE(out.str(),
         "Shaders::PhongGL::bindProjectionBuffer(): the shader was not created with uniform buffers enabled\n"
@@ -1412,10 +1713,67 @@ void PhongGLTest::bindBufferUniformBuffersNotEnabled() {
         "Shaders::PhongGL::bindMaterialBuffer(): the shader was not created with uniform buffers enabled\n"
         "Shaders::PhongGL::bindLightBuffer(): the shader was not created with uniform buffers enabled\n"
         "Shaders::PhongGL::bindLightBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::PhongGL::bindJointBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::PhongGL::bindJointBuffer(): the shader was not created with uniform buffers enabled\n"
         "Shaders::PhongGL::setDrawOffset(): the shader was not created with uniform buffers enabled\n");
 }
 #endif
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+void PhongGLTest::bindBufferLightClustersNotEnabled() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() << "is not supported.");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    GL::Buffer buffer;
+    PhongGL shader{PhongGL::Flag::UniformBuffers};
+    shader.bindLightClusterBuffer(buffer)
+          .bindLightClusterBuffer(buffer, 0, 16)
+          .bindClusterLightRangeBuffer(buffer)
+          .bindClusterLightRangeBuffer(buffer, 0, 16)
+          .bindClusterLightIndexBuffer(buffer)
+          .bindClusterLightIndexBuffer(buffer, 0, 16);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::PhongGL::bindLightClusterBuffer(): the shader was not created with light clusters enabled\n"
+        "Shaders::PhongGL::bindLightClusterBuffer(): the shader was not created with light clusters enabled\n"
+        "Shaders::PhongGL::bindClusterLightRangeBuffer(): the shader was not created with light clusters enabled\n"
+        "Shaders::PhongGL::bindClusterLightRangeBuffer(): the shader was not created with light clusters enabled\n"
+        "Shaders::PhongGL::bindClusterLightIndexBuffer(): the shader was not created with light clusters enabled\n"
+        "Shaders::PhongGL::bindClusterLightIndexBuffer(): the shader was not created with light clusters enabled\n");
+}
+#endif
+
+#ifndef MAGNUM_TARGET_GLES2
+void PhongGLTest::bindShadowMapsNotEnabled() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() << "is not supported.");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    GL::Buffer buffer;
+    GL::Texture2DArray texture;
+    PhongGL shader{PhongGL::Flag::UniformBuffers};
+    shader.bindShadowBuffer(buffer)
+          .bindShadowBuffer(buffer, 0, 16)
+          .bindShadowTexture(texture);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::PhongGL::bindShadowBuffer(): the shader was not created with shadow maps enabled\n"
+        "Shaders::PhongGL::bindShadowBuffer(): the shader was not created with shadow maps enabled\n"
+        "Shaders::PhongGL::bindShadowTexture(): the shader was not created with shadow maps enabled\n");
+}
+#endif
+
 void PhongGLTest::bindTexturesInvalid() {
     auto&& data = BindTexturesInvalidData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
@@ -1628,6 +1986,53 @@ void PhongGLTest::setWrongDrawOffset() {
     CORRADE_COMPARE(out.str(),
         "Shaders::PhongGL::setDrawOffset(): draw offset 5 is out of bounds for 5 draws\n");
 }
+
+void PhongGLTest::setWrongJointCountOrId() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::gpu_shader4>())
+        CORRADE_SKIP(GL::Extensions::EXT::gpu_shader4::string() << "is not supported.");
+    #endif
+
+    PhongGL shader{PhongGL::Configuration{}
+        .setJointCount(5, 1)};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    /* Calling setJointMatrices() with less items is fine, tested in
+       renderSkinning() */
+    shader.setJointMatrices({Matrix4{}, Matrix4{}, Matrix4{}, Matrix4{}, Matrix4{}, Matrix4{}})
+        .setJointMatrix(5, Matrix4{});
+    CORRADE_COMPARE(out.str(),
+        "Shaders::PhongGL::setJointMatrices(): expected at most 5 items but got 6\n"
+        "Shaders::PhongGL::setJointMatrix(): joint ID 5 is out of bounds for 5 joints\n");
+}
+
+void PhongGLTest::setPerVertexJointCountInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::gpu_shader4>())
+        CORRADE_SKIP(GL::Extensions::EXT::gpu_shader4::string() << "is not supported.");
+    #endif
+
+    PhongGL a{PhongGL::Configuration{}
+        .setJointCount(16, 3, 2)};
+    PhongGL b{PhongGL::Configuration{}
+        .setFlags(PhongGL::Flag::DynamicPerVertexJointCount)
+        .setJointCount(16, 3, 2)};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    a.setPerVertexJointCount(3, 2);
+    b.setPerVertexJointCount(4, 0);
+    b.setPerVertexJointCount(3, 3);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::PhongGL::setPerVertexJointCount(): the shader was not created with dynamic per-vertex joint count enabled\n"
+        "Shaders::PhongGL::setPerVertexJointCount(): expected at most 3 per-vertex joints, got 4\n"
+        "Shaders::PhongGL::setPerVertexJointCount(): expected at most 2 secondary per-vertex joints, got 3\n");
+}
 #endif
 
 constexpr Vector2i RenderSize{80, 80};
@@ -3372,6 +3777,106 @@ void PhongGLTest::renderLightCulling() {
 }
 #endif
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+void PhongGLTest::renderLightClusters() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isVersionSupported(GL::Version::GL430))
+        CORRADE_SKIP(GL::Version::GL430 << "is not supported.");
+    #else
+    if(!GL::Context::current().isVersionSupported(GL::Version::GLES310))
+        CORRADE_SKIP(GL::Version::GLES310 << "is not supported.");
+    if(GL::Shader::maxShaderStorageBlocks(GL::Shader::Type::Fragment) < 3)
+        CORRADE_SKIP("Not enough fragment shader storage blocks supported.");
+    #endif
+
+    GL::Mesh sphere = MeshTools::compile(Primitives::uvSphereSolid(16, 32));
+
+    const Matrix4 projectionMatrix = Matrix4::perspectiveProjection(60.0_degf, 1.0f, 0.1f, 10.0f);
+    GL::Buffer projectionUniform{GL::Buffer::TargetHint::Uniform, {
+        ProjectionUniform3D{}
+            .setProjectionMatrix(projectionMatrix)
+    }};
+    GL::Buffer transformationUniform{GL::Buffer::TargetHint::Uniform, {
+        TransformationUniform3D{}
+            .setTransformationMatrix(Matrix4::translation(Vector3::zAxis(-2.15f)))
+    }};
+    GL::Buffer drawUniform{GL::Buffer::TargetHint::Uniform, {
+        PhongDrawUniform{}
+    }};
+    GL::Buffer materialUniform{GL::Buffer::TargetHint::Uniform, {
+        PhongMaterialUniform{}
+            .setAmbientColor(0x330033_rgbf)
+            .setDiffuseColor(0xccffcc_rgbf)
+            .setSpecularColor(0x6666ff_rgbf)
+    }};
+    /* Same as in renderLightCulling(), except that the remaining lights are
+       bright but far away and with a short range, so they shouldn't get
+       assigned to any cluster */
+    PhongLightUniform lights[64];
+    for(PhongLightUniform& light: lights) light
+        .setPosition({0.0f, 0.0f, -50.0f, 1.0f})
+        .setColor(0xffffff_rgbf)
+        .setRange(0.5f);
+    lights[57] = PhongLightUniform{}
+        .setPosition({-3.0f, -3.0f, 2.0f, 0.0f})
+        .setColor(0x993366_rgbf);
+    lights[58] = PhongLightUniform{}
+        .setPosition({3.0f, -3.0f, 2.0f, 0.0f})
+        .setColor(0x669933_rgbf);
+    GL::Buffer lightStorage{lights};
+
+    const Vector3ui clusterCount{4, 4, 8};
+    GL::Buffer lightClusterUniform{GL::Buffer::TargetHint::Uniform, {
+        LightClusterUniform{}
+            .setInverseProjectionMatrix(projectionMatrix.inverted())
+            .setClusterCount(clusterCount)
+            .setLightCount(Containers::arraySize(lights))
+            .setViewportSize(Vector2{RenderSize})
+            .setDepthRange(0.1f, 10.0f)
+    }};
+
+    LightClusterGL cluster{16};
+    GL::Buffer clusterLightRanges{GL::Buffer::TargetHint::ShaderStorage};
+    clusterLightRanges.setData({nullptr, clusterCount.product()*8});
+    GL::Buffer clusterLightIndices{GL::Buffer::TargetHint::ShaderStorage};
+    clusterLightIndices.setData({nullptr, clusterCount.product()*cluster.maxLightsPerCluster()*4});
+
+    cluster
+        .bindLightClusterBuffer(lightClusterUniform)
+        .bindLightBuffer(lightStorage)
+        .bindClusterLightRangeBuffer(clusterLightRanges)
+        .bindClusterLightIndexBuffer(clusterLightIndices)
+        .dispatch(clusterCount);
+    GL::Renderer::setMemoryBarrier(GL::Renderer::MemoryBarrier::ShaderStorage);
+
+    PhongGL shader{PhongGL::Flag::LightClusters, 64};
+    shader
+        .bindProjectionBuffer(projectionUniform)
+        .bindTransformationBuffer(transformationUniform)
+        .bindDrawBuffer(drawUniform)
+        .bindMaterialBuffer(materialUniform)
+        .bindLightBuffer(lightStorage)
+        .bindLightClusterBuffer(lightClusterUniform)
+        .bindClusterLightRangeBuffer(clusterLightRanges)
+        .bindClusterLightIndexBuffer(clusterLightIndices)
+        .draw(sphere);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    if(!(_manager.loadState("AnyImageImporter") & PluginManager::LoadState::Loaded) ||
+       !(_manager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("AnyImageImporter / TgaImporter plugins not found.");
+
+    /* Same thresholds as in renderLightCulling() */
+    const Float maxThreshold = 8.34f, meanThreshold = 0.100f;
+    CORRADE_COMPARE_WITH(
+        /* Dropping the alpha channel, as it's always 1.0 */
+        Containers::arrayCast<Color3ub>(_framebuffer.read(_framebuffer.viewport(), {PixelFormat::RGBA8Unorm}).pixels<Color4ub>()),
+        Utility::Path::join(_testDir, "PhongTestFiles/colored.tga"),
+        (DebugTools::CompareImageToFile{_manager, maxThreshold, meanThreshold}));
+}
+#endif
+
 template<PhongGL::Flag flag> void PhongGLTest::renderZeroLights() {
     if(!(_manager.loadState("AnyImageImporter") & PluginManager::LoadState::Loaded) ||
        !(_manager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
@@ -3539,6 +4044,152 @@ template<PhongGL::Flag flag> void PhongGLTest::renderZeroLights() {
     #endif
 }
 
+void PhongGLTest::renderDepthPrepass() {
+    GL::Renderbuffer depth;
+    depth.setStorage(GL::RenderbufferFormat::DepthComponent16, RenderSize);
+    _framebuffer
+        .attachRenderbuffer(GL::Framebuffer::BufferAttachment::Depth, depth)
+        .clear(GL::FramebufferClear::Depth);
+    GL::Renderer::enable(GL::Renderer::Feature::DepthTest);
+
+    GL::Mesh sphere = MeshTools::compile(Primitives::uvSphereSolid(16, 32));
+
+    const Matrix4 transformation = Matrix4::translation(Vector3::zAxis(-2.15f));
+    const Matrix4 projection = Matrix4::perspectiveProjection(60.0_degf, 1.0f, 0.1f, 10.0f);
+
+    /* The prepass draws nothing to the color buffer */
+    PhongGL depthOnly{PhongGL::Configuration{}
+        .setFlags(PhongGL::Flag::DepthOnly)
+        .setLightCount(2)};
+    depthOnly
+        .setTransformationMatrix(transformation)
+        .setProjectionMatrix(projection)
+        .draw(sphere);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* With an invariant position, the shading pass passes the equal depth
+       test everywhere the prepass was drawn. Same as in renderColored(). */
+    GL::Renderer::setDepthMask(false);
+    GL::Renderer::setDepthFunction(GL::Renderer::DepthFunction::Equal);
+    PhongGL shader{PhongGL::Configuration{}
+        .setLightCount(2)};
+    shader
+        .setLightColors({0x993366_rgbf, 0x669933_rgbf})
+        .setLightPositions({{-3.0f, -3.0f, 2.0f, 0.0f},
+                            { 3.0f, -3.0f, 2.0f, 0.0f}})
+        .setAmbientColor(0x330033_rgbf)
+        .setDiffuseColor(0xccffcc_rgbf)
+        .setSpecularColor(0x6666ff_rgbf)
+        .setTransformationMatrix(transformation)
+        .setNormalMatrix(transformation.normalMatrix())
+        .setProjectionMatrix(projection)
+        .draw(sphere);
+    GL::Renderer::setDepthMask(true);
+    GL::Renderer::setDepthFunction(GL::Renderer::DepthFunction::Less);
+    GL::Renderer::disable(GL::Renderer::Feature::DepthTest);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    if(!(_manager.loadState("AnyImageImporter") & PluginManager::LoadState::Loaded) ||
+       !(_manager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("AnyImageImporter / TgaImporter plugins not found.");
+
+    #if !(defined(MAGNUM_TARGET_GLES2) && defined(MAGNUM_TARGET_WEBGL))
+    /* Same thresholds as in renderColored() */
+    const Float maxThreshold = 8.34f, meanThreshold = 0.100f;
+    #else
+    /* WebGL 1 doesn't have 8bit renderbuffer storage, so it's way worse */
+    const Float maxThreshold = 15.34f, meanThreshold = 3.33f;
+    #endif
+    CORRADE_COMPARE_WITH(
+        /* Dropping the alpha channel, as it's always 1.0 */
+        Containers::arrayCast<Color3ub>(_framebuffer.read(_framebuffer.viewport(), {PixelFormat::RGBA8Unorm}).pixels<Color4ub>()),
+        Utility::Path::join(_testDir, "PhongTestFiles/colored.tga"),
+        (DebugTools::CompareImageToFile{_manager, maxThreshold, meanThreshold}));
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+void PhongGLTest::renderShadowMaps() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() << "is not supported.");
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::texture_array>())
+        CORRADE_SKIP(GL::Extensions::EXT::texture_array::string() << "is not supported.");
+    #endif
+
+    /* A plane facing the camera, filling the whole viewport */
+    GL::Mesh plane = MeshTools::compile(Primitives::planeSolid());
+
+    /* The cascade uses the same projection as the camera, so the plane ends
+       up at a depth of 0.5 in the shadow map. The left texel is closer,
+       shadowing the left half of the plane, the right texel is further. */
+    const Matrix4 projectionMatrix = Matrix4::orthographicProjection({2.0f, 2.0f}, 0.0f, 2.0f);
+    const Float shadowDepth[]{0.25f, 1.0f};
+    GL::Texture2DArray shadow;
+    shadow.setMinificationFilter(GL::SamplerFilter::Nearest)
+        .setMagnificationFilter(GL::SamplerFilter::Nearest)
+        .setWrapping(GL::SamplerWrapping::ClampToEdge)
+        .setCompareMode(GL::SamplerCompareMode::CompareRefToTexture)
+        .setCompareFunction(GL::SamplerCompareFunction::LessOrEqual)
+        .setStorage(1, GL::TextureFormat::DepthComponent32F, {2, 1, 1})
+        .setSubImage(0, {}, ImageView3D{PixelFormat::Depth32F, {2, 1, 1}, shadowDepth});
+
+    GL::Buffer projectionUniform{GL::Buffer::TargetHint::Uniform, {
+        ProjectionUniform3D{}
+            .setProjectionMatrix(projectionMatrix)
+    }};
+    GL::Buffer transformationUniform{GL::Buffer::TargetHint::Uniform, {
+        TransformationUniform3D{}
+            .setTransformationMatrix(Matrix4::translation(Vector3::zAxis(-1.0f)))
+    }};
+    GL::Buffer drawUniform{GL::Buffer::TargetHint::Uniform, {
+        PhongDrawUniform{}
+    }};
+    GL::Buffer materialUniform{GL::Buffer::TargetHint::Uniform, {
+        PhongMaterialUniform{}
+            .setAmbientColor(0x000000_rgbf)
+            .setDiffuseColor(0xffffff_rgbf)
+    }};
+    /* Only the second light casts a shadow, the first is always visible */
+    GL::Buffer lightUniform{GL::Buffer::TargetHint::Uniform, {
+        PhongLightUniform{}
+            .setPosition({0.0f, 0.0f, 1.0f, 0.0f})
+            .setColor(0x333333_rgbf),
+        PhongLightUniform{}
+            .setPosition({0.0f, 0.0f, 1.0f, 0.0f})
+            .setColor(0xcccccc_rgbf)
+    }};
+    GL::Buffer shadowUniform{GL::Buffer::TargetHint::Uniform, {
+        ShadowCascadeUniform{}
+            .setCascadeMatrix(0, projectionMatrix)
+            .setLightIndex(1)
+            .setFilterRadius(0.0f)
+    }};
+
+    PhongGL shader{PhongGL::Configuration{}
+        .setFlags(PhongGL::Flag::ShadowMaps|PhongGL::Flag::NoSpecular)
+        .setLightCount(2)};
+    shader
+        .bindProjectionBuffer(projectionUniform)
+        .bindTransformationBuffer(transformationUniform)
+        .bindDrawBuffer(drawUniform)
+        .bindMaterialBuffer(materialUniform)
+        .bindLightBuffer(lightUniform)
+        .bindShadowBuffer(shadowUniform)
+        .bindShadowTexture(shadow)
+        .draw(plane);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Image2D image = _framebuffer.read(_framebuffer.viewport(), {PixelFormat::RGBA8Unorm});
+    Containers::StridedArrayView2D<const Color4ub> pixels = image.pixels<Color4ub>();
+    /* Shadowed half gets only the first light, the other both */
+    CORRADE_COMPARE(pixels[RenderSize.y()/2][RenderSize.x()/4], 0x333333ff_rgba);
+    CORRADE_COMPARE(pixels[RenderSize.y()/2][RenderSize.x()*3/4], 0xffffffff_rgba);
+}
+#endif
+
 template<PhongGL::Flag flag> void PhongGLTest::renderInstanced() {
     auto&& data = RenderInstancedData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
@@ -3949,6 +4600,138 @@ template<PhongGL::Flag flag> void PhongGLTest::renderInstanced() {
 }
 
 #ifndef MAGNUM_TARGET_GLES2
+template<PhongGL::Flag flag> void PhongGLTest::renderSkinning() {
+    auto&& data = RenderSkinningData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::gpu_shader4>())
+        CORRADE_SKIP(GL::Extensions::EXT::gpu_shader4::string() << "is not supported.");
+    #endif
+
+    if(flag == PhongGL::Flag::UniformBuffers) {
+        setTestCaseTemplateName("Flag::UniformBuffers");
+
+        #ifndef MAGNUM_TARGET_GLES
+        if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+            CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() << "is not supported.");
+        #endif
+
+        #if defined(MAGNUM_TARGET_GLES) && !defined(MAGNUM_TARGET_WEBGL)
+        if(GL::Context::current().detectedDriver() & GL::Context::DetectedDriver::SwiftShader)
+            CORRADE_SKIP("UBOs with dynamically indexed (light) arrays are a crashy dumpster fire on SwiftShader, can't test.");
+        #endif
+    }
+
+    /* The mesh is drawn with an identity transformation and the joints are
+       set up so that their weighted sum is the same as the transformation in
+       the rotated case of renderColored(), which means the output should be
+       the same as well. Translations of the two joints cancel each other out,
+       the third joint, if present, is garbage that should never get used. */
+    const Matrix4 jointMatrices[]{
+        Matrix4::translation(Vector3::xAxis(-1.0f))*Matrix4::rotationY(45.0_degf),
+        Matrix4::translation(Vector3::xAxis(1.0f))*Matrix4::rotationY(45.0_degf),
+        Matrix4::scaling(Vector3{100.0f})
+    };
+
+    Trade::MeshData sphereData = Primitives::uvSphereSolid(16, 32);
+    GL::Mesh sphere = MeshTools::compile(sphereData);
+
+    struct Vertex {
+        Vector4ui jointIds;
+        Vector4 weights;
+        Vector4ui secondaryJointIds;
+        Vector4 secondaryWeights;
+    };
+    Containers::Array<Vertex> vertices{DirectInit, sphereData.vertexCount(), Vertex{
+        data.jointIds, data.weights,
+        data.secondaryJointIds, data.secondaryWeights
+    }};
+    GL::Buffer vertexBuffer{GL::Buffer::TargetHint::Array, vertices};
+    if(data.perVertexJointCount)
+        sphere.addVertexBuffer(vertexBuffer, 0, PhongGL::JointIds{}, PhongGL::Weights{}, sizeof(Vector4ui) + sizeof(Vector4));
+    if(data.secondaryPerVertexJointCount)
+        sphere.addVertexBuffer(vertexBuffer, 0, sizeof(Vector4ui) + sizeof(Vector4), PhongGL::SecondaryJointIds{}, PhongGL::SecondaryWeights{});
+
+    PhongGL shader{PhongGL::Configuration{}
+        .setFlags(flag|data.flags)
+        .setLightCount(2)
+        /* With UBOs there's one extra joint at the front to test the joint
+           offset */
+        .setJointCount(data.jointCount + (flag == PhongGL::Flag::UniformBuffers ? 1 : 0), data.perVertexJointCount, data.secondaryPerVertexJointCount)};
+    if(data.flags >= PhongGL::Flag::DynamicPerVertexJointCount)
+        shader.setPerVertexJointCount(data.dynamicPerVertexJointCount, data.dynamicSecondaryPerVertexJointCount);
+
+    if(flag == PhongGL::Flag{}) {
+        shader
+            .setLightColors({0x993366_rgbf, 0x669933_rgbf})
+            .setLightPositions({{-3.0f, -3.0f, 2.0f, 0.0f},
+                                { 3.0f, -3.0f, 2.0f, 0.0f}})
+            .setAmbientColor(0x330033_rgbf)
+            .setDiffuseColor(0xccffcc_rgbf)
+            .setSpecularColor(0x6666ff_rgbf)
+            .setJointMatrices(Containers::arrayView(jointMatrices).prefix(data.jointCount))
+            .setTransformationMatrix(Matrix4::translation(Vector3::zAxis(-2.15f)))
+            .setProjectionMatrix(Matrix4::perspectiveProjection(60.0_degf, 1.0f, 0.1f, 10.0f))
+            .draw(sphere);
+    } else if(flag == PhongGL::Flag::UniformBuffers) {
+        GL::Buffer projectionUniform{GL::Buffer::TargetHint::Uniform, {
+            ProjectionUniform3D{}
+                .setProjectionMatrix(Matrix4::perspectiveProjection(60.0_degf, 1.0f, 0.1f, 10.0f))
+        }};
+        GL::Buffer transformationUniform{GL::Buffer::TargetHint::Uniform, {
+            TransformationUniform3D{}
+                .setTransformationMatrix(Matrix4::translation(Vector3::zAxis(-2.15f)))
+        }};
+        GL::Buffer drawUniform{GL::Buffer::TargetHint::Uniform, {
+            PhongDrawUniform{}
+                .setJointOffset(1)
+        }};
+        GL::Buffer materialUniform{GL::Buffer::TargetHint::Uniform, {
+            PhongMaterialUniform{}
+                .setAmbientColor(0x330033_rgbf)
+                .setDiffuseColor(0xccffcc_rgbf)
+                .setSpecularColor(0x6666ff_rgbf)
+        }};
+        GL::Buffer lightUniform{GL::Buffer::TargetHint::Uniform, {
+            PhongLightUniform{}
+                .setPosition({-3.0f, -3.0f, 2.0f, 0.0f})
+                .setColor(0x993366_rgbf),
+            PhongLightUniform{}
+                .setPosition({3.0f, -3.0f, 2.0f, 0.0f})
+                .setColor(0x669933_rgbf)
+        }};
+        TransformationUniform3D jointData[4];
+        /* The first joint is skipped by the joint offset */
+        jointData[0].setTransformationMatrix(Matrix4::scaling(Vector3{100.0f}));
+        for(std::size_t i = 0; i != data.jointCount; ++i)
+            jointData[i + 1].setTransformationMatrix(jointMatrices[i]);
+        GL::Buffer jointUniform{GL::Buffer::TargetHint::Uniform, Containers::arrayView(jointData).prefix(data.jointCount + 1)};
+        shader
+            .bindProjectionBuffer(projectionUniform)
+            .bindTransformationBuffer(transformationUniform)
+            .bindDrawBuffer(drawUniform)
+            .bindMaterialBuffer(materialUniform)
+            .bindLightBuffer(lightUniform)
+            .bindJointBuffer(jointUniform)
+            .draw(sphere);
+    } else CORRADE_INTERNAL_ASSERT_UNREACHABLE();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    if(!(_manager.loadState("AnyImageImporter") & PluginManager::LoadState::Loaded) ||
+       !(_manager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("AnyImageImporter / TgaImporter plugins not found.");
+
+    /* Same thresholds as in renderColored() */
+    const Float maxThreshold = 8.34f, meanThreshold = 0.100f;
+    CORRADE_COMPARE_WITH(
+        /* Dropping the alpha channel, as it's always 1.0 */
+        Containers::arrayCast<Color3ub>(_framebuffer.read(_framebuffer.viewport(), {PixelFormat::RGBA8Unorm}).pixels<Color4ub>()),
+        Utility::Path::join(_testDir, "PhongTestFiles/colored.tga"),
+        (DebugTools::CompareImageToFile{_manager, maxThreshold, meanThreshold}));
+}
+
 void PhongGLTest::renderMulti() {
     auto&& data = RenderMultiData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
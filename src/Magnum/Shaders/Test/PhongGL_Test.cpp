@@ -39,6 +39,12 @@ struct PhongGL_Test: TestSuite::Tester {
     void constructNoCreate();
     void constructCopy();
 
+    void configurationDefaults();
+    void configurationSetters();
+    #ifndef MAGNUM_TARGET_GLES2
+    void configurationSetJointCountInvalid();
+    #endif
+
     void debugFlag();
     void debugFlags();
     void debugFlagsSupersets();
@@ -48,6 +54,12 @@ PhongGL_Test::PhongGL_Test() {
     addTests({&PhongGL_Test::constructNoCreate,
               &PhongGL_Test::constructCopy,
 
+              &PhongGL_Test::configurationDefaults,
+              &PhongGL_Test::configurationSetters,
+              #ifndef MAGNUM_TARGET_GLES2
+              &PhongGL_Test::configurationSetJointCountInvalid,
+              #endif
+
               &PhongGL_Test::debugFlag,
               &PhongGL_Test::debugFlags,
               &PhongGL_Test::debugFlagsSupersets});
@@ -59,6 +71,13 @@ void PhongGL_Test::constructNoCreate() {
         CORRADE_COMPARE(shader.id(), 0);
         CORRADE_COMPARE(shader.flags(), PhongGL::Flags{});
         CORRADE_COMPARE(shader.lightCount(), 0);
+        #ifndef MAGNUM_TARGET_GLES2
+        CORRADE_COMPARE(shader.materialCount(), 0);
+        CORRADE_COMPARE(shader.drawCount(), 0);
+        CORRADE_COMPARE(shader.jointCount(), 0);
+        CORRADE_COMPARE(shader.perVertexJointCount(), 0);
+        CORRADE_COMPARE(shader.secondaryPerVertexJointCount(), 0);
+        #endif
     }
 
     CORRADE_VERIFY(true);
@@ -69,6 +88,63 @@ void PhongGL_Test::constructCopy() {
     CORRADE_VERIFY(!std::is_copy_assignable<PhongGL>{});
 }
 
+void PhongGL_Test::configurationDefaults() {
+    PhongGL::Configuration configuration;
+    CORRADE_COMPARE(configuration.flags(), PhongGL::Flags{});
+    CORRADE_COMPARE(configuration.lightCount(), 1);
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_COMPARE(configuration.materialCount(), 1);
+    CORRADE_COMPARE(configuration.drawCount(), 1);
+    CORRADE_COMPARE(configuration.jointCount(), 0);
+    CORRADE_COMPARE(configuration.perVertexJointCount(), 0);
+    CORRADE_COMPARE(configuration.secondaryPerVertexJointCount(), 0);
+    #endif
+}
+
+void PhongGL_Test::configurationSetters() {
+    PhongGL::Configuration configuration = PhongGL::Configuration{}
+        .setFlags(PhongGL::Flag::VertexColor|PhongGL::Flag::AlphaMask)
+        .setLightCount(3)
+        #ifndef MAGNUM_TARGET_GLES2
+        .setMaterialCount(5)
+        .setDrawCount(7)
+        .setJointCount(16, 4, 2)
+        #endif
+        ;
+    CORRADE_COMPARE(configuration.flags(), PhongGL::Flag::VertexColor|PhongGL::Flag::AlphaMask);
+    CORRADE_COMPARE(configuration.lightCount(), 3);
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_COMPARE(configuration.materialCount(), 5);
+    CORRADE_COMPARE(configuration.drawCount(), 7);
+    CORRADE_COMPARE(configuration.jointCount(), 16);
+    CORRADE_COMPARE(configuration.perVertexJointCount(), 4);
+    CORRADE_COMPARE(configuration.secondaryPerVertexJointCount(), 2);
+    #endif
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+void PhongGL_Test::configurationSetJointCountInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    PhongGL::Configuration configuration;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    configuration
+        .setJointCount(16, 5, 0)
+        .setJointCount(16, 0, 5)
+        .setJointCount(0, 1, 0)
+        .setJointCount(0, 0, 1)
+        .setJointCount(16, 0, 0);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::PhongGL::Configuration::setJointCount(): expected at most 4 per-vertex joints, got 5\n"
+        "Shaders::PhongGL::Configuration::setJointCount(): expected at most 4 secondary per-vertex joints, got 5\n"
+        "Shaders::PhongGL::Configuration::setJointCount(): count can't be zero if per-vertex joint count is non-zero\n"
+        "Shaders::PhongGL::Configuration::setJointCount(): count can't be zero if per-vertex joint count is non-zero\n"
+        "Shaders::PhongGL::Configuration::setJointCount(): per-vertex joint count can't be zero if count is non-zero\n");
+}
+#endif
+
 void PhongGL_Test::debugFlag() {
     std::ostringstream out;
 
@@ -118,6 +194,24 @@ void PhongGL_Test::debugFlagsSupersets() {
         CORRADE_COMPARE(out.str(), "Shaders::PhongGL::Flag::MultiDraw\n");
     }
     #endif
+
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    /* LightClusters is a superset of UniformBuffers so only one should be
+       printed */
+    {
+        std::ostringstream out;
+        Debug{&out} << (PhongGL::Flag::LightClusters|PhongGL::Flag::UniformBuffers);
+        CORRADE_COMPARE(out.str(), "Shaders::PhongGL::Flag::LightClusters\n");
+    }
+
+    /* VertexPulling is a superset of UniformBuffers so only one should be
+       printed */
+    {
+        std::ostringstream out;
+        Debug{&out} << (PhongGL::Flag::VertexPulling|PhongGL::Flag::UniformBuffers);
+        CORRADE_COMPARE(out.str(), "Shaders::PhongGL::Flag::VertexPulling\n");
+    }
+    #endif
 }
 
 }}}}
@@ -45,6 +45,10 @@ struct PhongTest: TestSuite::Tester {
     void materialUniformConstructNoInit();
     void materialUniformSetters();
 
+    void materialTextureUniformConstructDefault();
+    void materialTextureUniformConstructNoInit();
+    void materialTextureUniformSetters();
+
     void lightUniformConstructDefault();
     void lightUniformConstructNoInit();
     void lightUniformSetters();
@@ -53,6 +57,7 @@ struct PhongTest: TestSuite::Tester {
 PhongTest::PhongTest() {
     addTests({&PhongTest::uniformSizeAlignment<PhongDrawUniform>,
               &PhongTest::uniformSizeAlignment<PhongMaterialUniform>,
+              &PhongTest::uniformSizeAlignment<PhongMaterialTextureUniform>,
               &PhongTest::uniformSizeAlignment<PhongLightUniform>,
 
               &PhongTest::drawUniformConstructDefault,
@@ -64,6 +69,10 @@ PhongTest::PhongTest() {
               &PhongTest::materialUniformConstructNoInit,
               &PhongTest::materialUniformSetters,
 
+              &PhongTest::materialTextureUniformConstructDefault,
+              &PhongTest::materialTextureUniformConstructNoInit,
+              &PhongTest::materialTextureUniformSetters,
+
               &PhongTest::lightUniformConstructDefault,
               &PhongTest::lightUniformConstructNoInit,
               &PhongTest::lightUniformSetters});
@@ -78,6 +87,9 @@ template<> struct UniformTraits<PhongDrawUniform> {
 template<> struct UniformTraits<PhongMaterialUniform> {
     static const char* name() { return "PhongMaterialUniform"; }
 };
+template<> struct UniformTraits<PhongMaterialTextureUniform> {
+    static const char* name() { return "PhongMaterialTextureUniform"; }
+};
 template<> struct UniformTraits<PhongLightUniform> {
     static const char* name() { return "PhongLightUniform"; }
 };
@@ -111,6 +123,8 @@ void PhongTest::drawUniformConstructDefault() {
     }));
     CORRADE_COMPARE(a.materialId, 0);
     CORRADE_COMPARE(b.materialId, 0);
+    CORRADE_COMPARE(a.jointOffset, 0);
+    CORRADE_COMPARE(b.jointOffset, 0);
     CORRADE_COMPARE(a.objectId, 0);
     CORRADE_COMPARE(b.objectId, 0);
     CORRADE_COMPARE(a.lightOffset, 0);
@@ -132,6 +146,8 @@ void PhongTest::drawUniformConstructDefault() {
     }));
     CORRADE_COMPARE(ca.materialId, 0);
     CORRADE_COMPARE(cb.materialId, 0);
+    CORRADE_COMPARE(ca.jointOffset, 0);
+    CORRADE_COMPARE(cb.jointOffset, 0);
     CORRADE_COMPARE(ca.objectId, 0);
     CORRADE_COMPARE(cb.objectId, 0);
     CORRADE_COMPARE(ca.lightOffset, 0);
@@ -176,6 +192,7 @@ void PhongTest::drawUniformSetters() {
     PhongDrawUniform a;
     a.setNormalMatrix(Matrix4::rotationX(90.0_degf).normalMatrix())
      .setMaterialId(5)
+     .setJointOffset(11)
      .setObjectId(7)
      .setLightOffsetCount(9, 13);
     CORRADE_COMPARE(a.normalMatrix, (Matrix3x4{
@@ -184,6 +201,7 @@ void PhongTest::drawUniformSetters() {
         Vector4{0.0f, -1.0f, 0.0f, 0.0f}
     }));
     CORRADE_COMPARE(a.materialId, 5);
+    CORRADE_COMPARE(a.jointOffset, 11);
     CORRADE_COMPARE(a.objectId, 7);
     CORRADE_COMPARE(a.lightOffset, 9);
     CORRADE_COMPARE(a.lightCount, 13);
@@ -195,6 +213,12 @@ void PhongTest::drawUniformMaterialIdPacking() {
     /* The normalMatrix field is 3x4 floats, materialId should be right after
        in the low 16 bits on both LE and BE */
     CORRADE_COMPARE(reinterpret_cast<UnsignedInt*>(&a)[12] & 0xffff, 13765);
+
+    a.setJointOffset(2765);
+    /* jointOffset should be right after materialId, in the high 16 bits on
+       both LE and BE */
+    CORRADE_COMPARE(reinterpret_cast<UnsignedInt*>(&a)[12] >> 16, 2765);
+    CORRADE_COMPARE(reinterpret_cast<UnsignedInt*>(&a)[12] & 0xffff, 13765);
 }
 
 void PhongTest::materialUniformConstructDefault() {
@@ -277,6 +301,73 @@ void PhongTest::materialUniformSetters() {
     CORRADE_COMPARE(a.alphaMask, 2.5f);
 }
 
+void PhongTest::materialTextureUniformConstructDefault() {
+    PhongMaterialTextureUniform a;
+    PhongMaterialTextureUniform b{DefaultInit};
+    CORRADE_COMPARE(a.ambientTextureHandle, Vector2ui{});
+    CORRADE_COMPARE(b.ambientTextureHandle, Vector2ui{});
+    CORRADE_COMPARE(a.diffuseTextureHandle, Vector2ui{});
+    CORRADE_COMPARE(b.diffuseTextureHandle, Vector2ui{});
+    CORRADE_COMPARE(a.specularTextureHandle, Vector2ui{});
+    CORRADE_COMPARE(b.specularTextureHandle, Vector2ui{});
+    CORRADE_COMPARE(a.normalTextureHandle, Vector2ui{});
+    CORRADE_COMPARE(b.normalTextureHandle, Vector2ui{});
+    CORRADE_COMPARE(a.objectIdTextureHandle, Vector2ui{});
+    CORRADE_COMPARE(b.objectIdTextureHandle, Vector2ui{});
+
+    constexpr PhongMaterialTextureUniform ca;
+    constexpr PhongMaterialTextureUniform cb{DefaultInit};
+    CORRADE_COMPARE(ca.ambientTextureHandle, Vector2ui{});
+    CORRADE_COMPARE(cb.ambientTextureHandle, Vector2ui{});
+    CORRADE_COMPARE(ca.objectIdTextureHandle, Vector2ui{});
+    CORRADE_COMPARE(cb.objectIdTextureHandle, Vector2ui{});
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<PhongMaterialTextureUniform>::value);
+    CORRADE_VERIFY(std::is_nothrow_constructible<PhongMaterialTextureUniform, DefaultInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<DefaultInitT, PhongMaterialTextureUniform>::value);
+}
+
+void PhongTest::materialTextureUniformConstructNoInit() {
+    /* Testing only some fields, should be enough */
+    PhongMaterialTextureUniform a;
+    a.diffuseTextureHandle = {3, 5};
+    a.normalTextureHandle = {7, 9};
+
+    new(&a) PhongMaterialTextureUniform{NoInit};
+    {
+        /* Explicitly check we're not on Clang because certain Clang-based IDEs
+           inherit __GNUC__ if GCC is used instead of leaving it at 4 like
+           Clang itself does */
+        #if defined(CORRADE_TARGET_GCC) && !defined(CORRADE_TARGET_CLANG) && __GNUC__*100 + __GNUC_MINOR__ >= 601 && __OPTIMIZE__
+        CORRADE_EXPECT_FAIL("GCC 6.1+ misoptimizes and overwrites the value.");
+        #endif
+        CORRADE_COMPARE(a.diffuseTextureHandle, (Vector2ui{3, 5}));
+        CORRADE_COMPARE(a.normalTextureHandle, (Vector2ui{7, 9}));
+    }
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<PhongMaterialTextureUniform, NoInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoInitT, PhongMaterialTextureUniform>::value);
+}
+
+void PhongTest::materialTextureUniformSetters() {
+    PhongMaterialTextureUniform a;
+    a.setAmbientTextureHandle(0x0000000200000001ull)
+     .setDiffuseTextureHandle(0x0000000400000003ull)
+     .setSpecularTextureHandle(0x0000000600000005ull)
+     .setNormalTextureHandle(0x0000000800000007ull)
+     .setObjectIdTextureHandle(0x0000000a00000009ull);
+    /* The low half is first */
+    CORRADE_COMPARE(a.ambientTextureHandle, (Vector2ui{1, 2}));
+    CORRADE_COMPARE(a.diffuseTextureHandle, (Vector2ui{3, 4}));
+    CORRADE_COMPARE(a.specularTextureHandle, (Vector2ui{5, 6}));
+    CORRADE_COMPARE(a.normalTextureHandle, (Vector2ui{7, 8}));
+    CORRADE_COMPARE(a.objectIdTextureHandle, (Vector2ui{9, 10}));
+}
+
 void PhongTest::lightUniformConstructDefault() {
     PhongLightUniform a;
     PhongLightUniform b{DefaultInit};
@@ -0,0 +1,124 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/Shaders/ShaderVariantCacheGL.h"
+
+namespace Magnum { namespace Shaders { namespace Test { namespace {
+
+struct ShaderVariantCacheGLTest: GL::OpenGLTester {
+    explicit ShaderVariantCacheGLTest();
+
+    void request();
+    void precompile();
+};
+
+ShaderVariantCacheGLTest::ShaderVariantCacheGLTest() {
+    addTests({&ShaderVariantCacheGLTest::request,
+              &ShaderVariantCacheGLTest::precompile});
+}
+
+void ShaderVariantCacheGLTest::request() {
+    ShaderVariantCacheGL cache;
+
+    PhongGL& phong = cache.phong(PhongGL::Configuration{}
+        .setFlags(PhongGL::Flag::VertexColor)
+        .setLightCount(2));
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(phong.id());
+    CORRADE_COMPARE(phong.flags(), PhongGL::Flag::VertexColor);
+    CORRADE_COMPARE(phong.lightCount(), 2);
+    CORRADE_COMPARE(cache.variantCount(), 1);
+    CORRADE_COMPARE(cache.compiledVariantCount(), 1);
+    CORRADE_VERIFY(cache.variant(0).isCompiled());
+    CORRADE_COMPARE(cache.variant(0).requestCount(), 1);
+    CORRADE_VERIFY(cache.variant(0).compileTime());
+
+    /* Requesting the same variant again gives back the same instance */
+    PhongGL& phong2 = cache.phong(PhongGL::Configuration{}
+        .setFlags(PhongGL::Flag::VertexColor)
+        .setLightCount(2));
+    CORRADE_COMPARE(&phong2, &phong);
+    CORRADE_COMPARE(cache.variantCount(), 1);
+    CORRADE_COMPARE(cache.variant(0).requestCount(), 2);
+
+    FlatGL2D& flat2D = cache.flat2D(FlatGL2D::Configuration{}
+        .setFlags(FlatGL2D::Flag::Textured));
+    FlatGL3D& flat3D = cache.flat3D(FlatGL3D::Configuration{}
+        .setFlags(FlatGL3D::Flag::Textured));
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(flat2D.id());
+    CORRADE_VERIFY(flat3D.id());
+    CORRADE_COMPARE(flat2D.flags(), FlatGL2D::Flag::Textured);
+    CORRADE_COMPARE(flat3D.flags(), FlatGL3D::Flag::Textured);
+    CORRADE_COMPARE(cache.variantCount(), 3);
+    CORRADE_COMPARE(cache.compiledVariantCount(), 3);
+
+    /* The instance stays the same even after the internal storage grows */
+    CORRADE_COMPARE(&cache.phong(PhongGL::Configuration{}
+        .setFlags(PhongGL::Flag::VertexColor)
+        .setLightCount(2)), &phong);
+    CORRADE_COMPARE(cache.compileTime(), cache.variant(0).compileTime() + cache.variant(1).compileTime() + cache.variant(2).compileTime());
+}
+
+void ShaderVariantCacheGLTest::precompile() {
+    ShaderVariantCacheGL cache;
+    PhongGL& compiled = cache.phong(PhongGL::Configuration{});
+    const UnsignedLong compiledTime = cache.variant(0).compileTime();
+
+    cache
+        .addFlat3D(FlatGL3D::Configuration{}
+            .setFlags(FlatGL3D::Flag::VertexColor))
+        .addPhong(PhongGL::Configuration{}
+            .setFlags(PhongGL::Flag::AlphaMask)
+            .setLightCount(3));
+    CORRADE_COMPARE(cache.variantCount(), 3);
+    CORRADE_COMPARE(cache.compiledVariantCount(), 1);
+
+    cache.precompile();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(cache.compiledVariantCount(), 3);
+    CORRADE_VERIFY(cache.variant(1).compileTime());
+    CORRADE_VERIFY(cache.variant(2).compileTime());
+
+    /* The already compiled variant isn't touched */
+    CORRADE_COMPARE(cache.variant(0).compileTime(), compiledTime);
+    CORRADE_COMPARE(&cache.phong(PhongGL::Configuration{}), &compiled);
+
+    /* Precompiled variants aren't counted as requested until they actually
+       are */
+    CORRADE_COMPARE(cache.variant(2).requestCount(), 0);
+    PhongGL& phong = cache.phong(PhongGL::Configuration{}
+        .setFlags(PhongGL::Flag::AlphaMask)
+        .setLightCount(3));
+    CORRADE_COMPARE(phong.flags(), PhongGL::Flag::AlphaMask);
+    CORRADE_COMPARE(phong.lightCount(), 3);
+    CORRADE_COMPARE(cache.variant(2).requestCount(), 1);
+    CORRADE_COMPARE(cache.variantCount(), 3);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Shaders::Test::ShaderVariantCacheGLTest)
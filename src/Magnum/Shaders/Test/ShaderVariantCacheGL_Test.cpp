@@ -0,0 +1,301 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/FormatStl.h>
+
+#include "Magnum/Shaders/ShaderVariantCacheGL.h"
+
+namespace Magnum { namespace Shaders { namespace Test { namespace {
+
+/* There's an underscore between GL and Test to disambiguate from GLTest, which
+   is a common suffix used to mark tests that need a GL context. Ugly, I know. */
+struct ShaderVariantCacheGL_Test: TestSuite::Tester {
+    explicit ShaderVariantCacheGL_Test();
+
+    void construct();
+    void constructCopy();
+    void constructMove();
+
+    void add();
+    #ifndef MAGNUM_TARGET_GLES2
+    void addCounts();
+    #endif
+    void variantInvalid();
+
+    void serialize();
+    void deserialize();
+    void deserializeInvalid();
+
+    void statistics();
+
+    void debugShaderType();
+};
+
+using namespace Containers::Literals;
+
+const struct {
+    const char* name;
+    Containers::StringView data;
+    const char* message;
+} DeserializeInvalidData[]{
+    {"missing values", "PhongGL a 3 0 0 0 0\n"_s,
+        "invalid variant on line 1"},
+    {"extra values", "FlatGL3D 0 0 0 0 0 0 0\n\nFlatGL2D 1 0 0 0 0 0 0 0\n"_s,
+        "invalid variant on line 3"},
+    {"not a number", "# comment\nFlatGL3D 1 0 0 0 zero 0 0\n"_s,
+        "invalid variant on line 2"},
+    {"unknown type", "VectorGL2D 1 0 0 0 0 0 0\n"_s,
+        "unknown shader type VectorGL2D on line 1"},
+    {"too many per-vertex joints", "PhongGL 0 1 0 0 16 5 0\n"_s,
+        "invalid joint count 16, 5, 0 on line 1"},
+    {"joints without per-vertex joints", "PhongGL 0 1 0 0 16 0 0\n"_s,
+        "invalid joint count 16, 0, 0 on line 1"},
+    {"per-vertex joints without joints", "PhongGL 0 1 0 0 0 0 2\n"_s,
+        "invalid joint count 0, 0, 2 on line 1"},
+};
+
+ShaderVariantCacheGL_Test::ShaderVariantCacheGL_Test() {
+    addTests({&ShaderVariantCacheGL_Test::construct,
+              &ShaderVariantCacheGL_Test::constructCopy,
+              &ShaderVariantCacheGL_Test::constructMove,
+
+              &ShaderVariantCacheGL_Test::add,
+              #ifndef MAGNUM_TARGET_GLES2
+              &ShaderVariantCacheGL_Test::addCounts,
+              #endif
+              &ShaderVariantCacheGL_Test::variantInvalid,
+
+              &ShaderVariantCacheGL_Test::serialize,
+              &ShaderVariantCacheGL_Test::deserialize});
+
+    addInstancedTests({&ShaderVariantCacheGL_Test::deserializeInvalid},
+        Containers::arraySize(DeserializeInvalidData));
+
+    addTests({&ShaderVariantCacheGL_Test::statistics,
+
+              &ShaderVariantCacheGL_Test::debugShaderType});
+}
+
+void ShaderVariantCacheGL_Test::construct() {
+    ShaderVariantCacheGL cache;
+    CORRADE_COMPARE(cache.variantCount(), 0);
+    CORRADE_COMPARE(cache.compiledVariantCount(), 0);
+    CORRADE_COMPARE(cache.compileTime(), 0);
+}
+
+void ShaderVariantCacheGL_Test::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<ShaderVariantCacheGL>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<ShaderVariantCacheGL>{});
+}
+
+void ShaderVariantCacheGL_Test::constructMove() {
+    ShaderVariantCacheGL a;
+    a.addPhong(PhongGL::Configuration{});
+
+    ShaderVariantCacheGL b{std::move(a)};
+    CORRADE_COMPARE(b.variantCount(), 1);
+
+    ShaderVariantCacheGL c;
+    c.addFlat2D(FlatGL2D::Configuration{})
+     .addFlat3D(FlatGL3D::Configuration{});
+    c = std::move(b);
+    CORRADE_COMPARE(c.variantCount(), 1);
+    CORRADE_COMPARE(c.variant(0).shaderType(), ShaderVariantCacheGL::ShaderType::Phong);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<ShaderVariantCacheGL>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<ShaderVariantCacheGL>::value);
+}
+
+void ShaderVariantCacheGL_Test::add() {
+    ShaderVariantCacheGL cache;
+    cache
+        .addFlat3D(FlatGL3D::Configuration{}
+            .setFlags(FlatGL3D::Flag::Textured|FlatGL3D::Flag::VertexColor))
+        .addPhong(PhongGL::Configuration{}
+            .setFlags(PhongGL::Flag::DiffuseTexture)
+            .setLightCount(3))
+        /* Same as the first, should be deduplicated */
+        .addFlat3D(FlatGL3D::Configuration{}
+            .setFlags(FlatGL3D::Flag::VertexColor|FlatGL3D::Flag::Textured))
+        /* Same flags but a different dimension count */
+        .addFlat2D(FlatGL2D::Configuration{}
+            .setFlags(FlatGL2D::Flag::Textured|FlatGL2D::Flag::VertexColor))
+        /* Same flags but a different light count */
+        .addPhong(PhongGL::Configuration{}
+            .setFlags(PhongGL::Flag::DiffuseTexture)
+            .setLightCount(4));
+    CORRADE_COMPARE(cache.variantCount(), 4);
+    CORRADE_COMPARE(cache.compiledVariantCount(), 0);
+
+    const ShaderVariantCacheGL::Variant& flat3D = cache.variant(0);
+    CORRADE_COMPARE(flat3D.shaderType(), ShaderVariantCacheGL::ShaderType::Flat3D);
+    CORRADE_COMPARE(flat3D.flags(), UnsignedInt(UnsignedShort(FlatGL3D::Flag::Textured|FlatGL3D::Flag::VertexColor)));
+    CORRADE_COMPARE(flat3D.lightCount(), 0);
+    CORRADE_COMPARE(flat3D.requestCount(), 0);
+    CORRADE_VERIFY(!flat3D.isCompiled());
+    CORRADE_COMPARE(flat3D.compileTime(), 0);
+
+    const ShaderVariantCacheGL::Variant& phong = cache.variant(1);
+    CORRADE_COMPARE(phong.shaderType(), ShaderVariantCacheGL::ShaderType::Phong);
+    CORRADE_COMPARE(phong.flags(), UnsignedInt(PhongGL::Flag::DiffuseTexture));
+    CORRADE_COMPARE(phong.lightCount(), 3);
+
+    CORRADE_COMPARE(cache.variant(2).shaderType(), ShaderVariantCacheGL::ShaderType::Flat2D);
+    CORRADE_COMPARE(cache.variant(3).lightCount(), 4);
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+void ShaderVariantCacheGL_Test::addCounts() {
+    ShaderVariantCacheGL cache;
+    cache
+        .addPhong(PhongGL::Configuration{}
+            .setFlags(PhongGL::Flag::UniformBuffers)
+            .setLightCount(2)
+            .setMaterialCount(4)
+            .setDrawCount(16)
+            .setJointCount(32, 4, 2))
+        /* Differs only in the secondary per-vertex joint count */
+        .addPhong(PhongGL::Configuration{}
+            .setFlags(PhongGL::Flag::UniformBuffers)
+            .setLightCount(2)
+            .setMaterialCount(4)
+            .setDrawCount(16)
+            .setJointCount(32, 4, 1));
+    CORRADE_COMPARE(cache.variantCount(), 2);
+
+    const ShaderVariantCacheGL::Variant& variant = cache.variant(0);
+    CORRADE_COMPARE(variant.lightCount(), 2);
+    CORRADE_COMPARE(variant.materialCount(), 4);
+    CORRADE_COMPARE(variant.drawCount(), 16);
+    CORRADE_COMPARE(variant.jointCount(), 32);
+    CORRADE_COMPARE(variant.perVertexJointCount(), 4);
+    CORRADE_COMPARE(variant.secondaryPerVertexJointCount(), 2);
+    CORRADE_COMPARE(cache.variant(1).secondaryPerVertexJointCount(), 1);
+}
+#endif
+
+void ShaderVariantCacheGL_Test::variantInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    ShaderVariantCacheGL cache;
+    cache.addPhong(PhongGL::Configuration{});
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    cache.variant(1);
+    CORRADE_COMPARE(out.str(), "Shaders::ShaderVariantCacheGL::variant(): index 1 out of range for 1 variants\n");
+}
+
+void ShaderVariantCacheGL_Test::serialize() {
+    ShaderVariantCacheGL cache;
+    cache
+        .addFlat3D(FlatGL3D::Configuration{}
+            .setFlags(FlatGL3D::Flag::Textured|FlatGL3D::Flag::VertexColor))
+        .addPhong(PhongGL::Configuration{}
+            .setFlags(PhongGL::Flag::DiffuseTexture|PhongGL::Flag::AlphaMask)
+            .setLightCount(3));
+    CORRADE_COMPARE(cache.serialize(),
+        "# Magnum::Shaders::ShaderVariantCacheGL\n"
+        "# type flags lightCount materialCount drawCount jointCount perVertexJointCount secondaryPerVertexJointCount\n"
+        "FlatGL3D 5 0 0 0 0 0 0\n"
+        "PhongGL a 3 0 0 0 0 0\n");
+}
+
+void ShaderVariantCacheGL_Test::deserialize() {
+    ShaderVariantCacheGL cache;
+    cache.addPhong(PhongGL::Configuration{}
+        .setFlags(PhongGL::Flag::DiffuseTexture|PhongGL::Flag::AlphaMask)
+        .setLightCount(3));
+
+    /* The Phong variant is already present and gets skipped, CRLF line
+       endings and comments are handled */
+    CORRADE_VERIFY(cache.deserialize(
+        "# A comment\r\n"
+        "FlatGL3D 5 0 0 0 0 0 0\r\n"
+        "\r\n"
+        "PhongGL a 3 0 0 0 0 0\r\n"
+        "FlatGL2D 0 0 0 0 0 0 0\r\n"_s));
+    CORRADE_COMPARE(cache.variantCount(), 3);
+    CORRADE_COMPARE(cache.compiledVariantCount(), 0);
+    CORRADE_COMPARE(cache.variant(0).shaderType(), ShaderVariantCacheGL::ShaderType::Phong);
+    CORRADE_COMPARE(cache.variant(1).shaderType(), ShaderVariantCacheGL::ShaderType::Flat3D);
+    CORRADE_COMPARE(cache.variant(1).flags(), UnsignedInt(UnsignedShort(FlatGL3D::Flag::Textured|FlatGL3D::Flag::VertexColor)));
+    CORRADE_COMPARE(cache.variant(2).shaderType(), ShaderVariantCacheGL::ShaderType::Flat2D);
+
+    /* Serializing back produces the same as with the variants added
+       directly */
+    ShaderVariantCacheGL roundtrip;
+    CORRADE_VERIFY(roundtrip.deserialize(cache.serialize()));
+    CORRADE_COMPARE(roundtrip.serialize(), cache.serialize());
+}
+
+void ShaderVariantCacheGL_Test::deserializeInvalid() {
+    auto&& data = DeserializeInvalidData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    ShaderVariantCacheGL cache;
+    cache.addFlat2D(FlatGL2D::Configuration{});
+
+    std::ostringstream out;
+    {
+        Error redirectError{&out};
+        CORRADE_VERIFY(!cache.deserialize(data.data));
+    }
+    CORRADE_COMPARE(out.str(), Utility::formatString("Shaders::ShaderVariantCacheGL::deserialize(): {}\n", data.message));
+
+    /* Nothing gets added on failure, not even the valid lines before */
+    CORRADE_COMPARE(cache.variantCount(), 1);
+}
+
+void ShaderVariantCacheGL_Test::statistics() {
+    ShaderVariantCacheGL cache;
+    cache
+        .addFlat2D(FlatGL2D::Configuration{}
+            .setFlags(FlatGL2D::Flag::Textured))
+        .addPhong(PhongGL::Configuration{}
+            .setLightCount(3));
+    CORRADE_COMPARE(cache.statistics(),
+        "Shader variants: 2, 0 compiled in 0.00 ms\n"
+        "  FlatGL2D Shaders::FlatGL::Flag::Textured\n"
+        "    Requests: 0, not compiled\n"
+        "  PhongGL Shaders::PhongGL::Flags{}\n"
+        "    Lights: 3\n"
+        "    Requests: 0, not compiled");
+}
+
+void ShaderVariantCacheGL_Test::debugShaderType() {
+    std::ostringstream out;
+
+    Debug{&out} << ShaderVariantCacheGL::ShaderType::Flat3D << ShaderVariantCacheGL::ShaderType(0xf0);
+    CORRADE_COMPARE(out.str(), "Shaders::ShaderVariantCacheGL::ShaderType::Flat3D Shaders::ShaderVariantCacheGL::ShaderType(0xf0)\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Shaders::Test::ShaderVariantCacheGL_Test)
@@ -38,8 +38,10 @@
 #include "Magnum/GL/OpenGLTester.h"
 #include "Magnum/GL/Renderbuffer.h"
 #include "Magnum/GL/RenderbufferFormat.h"
+#include "Magnum/GL/Renderer.h"
 #include "Magnum/GL/Texture.h"
 #include "Magnum/GL/TextureFormat.h"
+#include "Magnum/GL/TimeQuery.h"
 #include "Magnum/Math/Color.h"
 #include "Magnum/Math/Matrix4.h"
 #include "Magnum/MeshTools/Compile.h"
@@ -89,6 +91,14 @@ namespace Magnum { namespace Shaders { namespace Test { namespace {
     -   if instancing features are enabled, there's exactly one instance
     -   if alpha mask is enabled, it's 0.0
     -   uniforms / binding overhead is not included in the benchmark
+
+    The throughput benchmarks at the end are the exception, as their goal is
+    to measure exactly the per-draw overhead excluded above. They draw a
+    tiny quad many times, setting up per-draw state the way an application
+    would for given code path, and report the CPU time spent submitting a
+    whole batch of draws together with how many draws per second the GPU
+    processes. For instanced draws each instance counts as a draw, so all
+    paths are comparable.
 */
 
 struct ShadersGLBenchmark: GL::OpenGLTester {
@@ -105,6 +115,13 @@ struct ShadersGLBenchmark: GL::OpenGLTester {
     void meshVisualizer2D();
     void meshVisualizer3D();
 
+    void throughputSetup();
+    void throughputBenchmarkBegin();
+    std::uint64_t throughputBenchmarkEnd();
+
+    void flatThroughput();
+    void phongThroughput();
+
     private:
         PluginManager::Manager<Trade::AbstractImporter> _manager{"nonexistent"};
 
@@ -121,6 +138,9 @@ struct ShadersGLBenchmark: GL::OpenGLTester {
         #ifndef MAGNUM_TARGET_GLES2
         GL::Texture2DArray _textureWhiteArray, _textureBlueArray;
         #endif
+
+        GL::TimeQuery _throughputQuery{NoCreate};
+        UnsignedLong _throughputDrawCount{};
 };
 
 using namespace Math::Literals;
@@ -137,6 +157,16 @@ constexpr std::size_t BenchmarkIterations{1000};
 constexpr std::size_t SlowBenchmarkIterations{250};
 #endif
 constexpr std::size_t BenchmarkRepeats{4};
+constexpr std::size_t ThroughputWarmupIterations{2};
+constexpr std::size_t ThroughputIterations{10};
+/* Count of draws addressable by a single uniform buffer binding in the
+   throughput benchmarks. With a 64-byte transformation uniform it fits into
+   the 16 kB minimum uniform block size guaranteed by GL and all per-draw
+   uniform structures are small powers of two, so each chunk offset satisfies
+   the uniform buffer offset alignment as well. */
+#ifndef MAGNUM_TARGET_GLES2
+constexpr UnsignedInt ThroughputChunkDrawCount{256};
+#endif
 
 const struct {
     const char* name;
@@ -344,6 +374,40 @@ const struct {
     #endif
 };
 
+enum class Submit {
+    Uniforms,
+    #ifndef MAGNUM_TARGET_GLES2
+    UniformBuffers,
+    MultiDraw,
+    #endif
+    Instanced
+};
+
+const struct {
+    const char* name;
+    Submit submit;
+    bool textureArrays;
+    UnsignedInt drawCount, instanceCount;
+} ThroughputData[] {
+    {"uniforms, 1 draw", Submit::Uniforms, false, 1, 1},
+    {"uniforms, 1k draws", Submit::Uniforms, false, 1000, 1},
+    {"uniforms, 10k draws", Submit::Uniforms, false, 10000, 1},
+    #ifndef MAGNUM_TARGET_GLES2
+    {"uniforms, 1k draws, texture arrays", Submit::Uniforms, true, 1000, 1},
+    {"UBO, 1 draw", Submit::UniformBuffers, false, 1, 1},
+    {"UBO, 1k draws", Submit::UniformBuffers, false, 1000, 1},
+    {"UBO, 10k draws", Submit::UniformBuffers, false, 10000, 1},
+    {"UBO, 1k draws, texture arrays", Submit::UniformBuffers, true, 1000, 1},
+    {"multidraw, 1 draw", Submit::MultiDraw, false, 1, 1},
+    {"multidraw, 1k draws", Submit::MultiDraw, false, 1000, 1},
+    {"multidraw, 10k draws", Submit::MultiDraw, false, 10000, 1},
+    {"multidraw, 10k draws, texture arrays", Submit::MultiDraw, true, 10000, 1},
+    #endif
+    {"instanced, 1k instances", Submit::Instanced, false, 1, 1000},
+    {"instanced, 100k instances", Submit::Instanced, false, 1, 100000},
+    {"instanced, 1M instances", Submit::Instanced, false, 1, 1000000},
+};
+
 ShadersGLBenchmark::ShadersGLBenchmark(): _framebuffer{{{}, RenderSize}} {
     addInstancedBenchmarks({&ShadersGLBenchmark::flat<2>,
                             &ShadersGLBenchmark::flat<3>},
@@ -391,6 +455,24 @@ ShadersGLBenchmark::ShadersGLBenchmark(): _framebuffer{{{}, RenderSize}} {
         &ShadersGLBenchmark::renderTeardown,
         BenchmarkType::GpuTime);
 
+    /* CPU submit time of the whole batch */
+    addInstancedBenchmarks({&ShadersGLBenchmark::flatThroughput,
+                            &ShadersGLBenchmark::phongThroughput},
+        BenchmarkRepeats, Containers::arraySize(ThroughputData),
+        &ShadersGLBenchmark::throughputSetup,
+        &ShadersGLBenchmark::renderTeardown,
+        BenchmarkType::WallTime);
+
+    /* Draws per second processed by the GPU */
+    addCustomInstancedBenchmarks({&ShadersGLBenchmark::flatThroughput,
+                                  &ShadersGLBenchmark::phongThroughput},
+        BenchmarkRepeats, Containers::arraySize(ThroughputData),
+        &ShadersGLBenchmark::throughputSetup,
+        &ShadersGLBenchmark::renderTeardown,
+        &ShadersGLBenchmark::throughputBenchmarkBegin,
+        &ShadersGLBenchmark::throughputBenchmarkEnd,
+        BenchmarkUnits::Count);
+
     /* Set up the framebuffer */
     _color.setStorage(
         #if !defined(MAGNUM_TARGET_GLES2) || !defined(MAGNUM_TARGET_WEBGL)
@@ -1328,6 +1410,368 @@ void ShadersGLBenchmark::meshVisualizer3D() {
         DebugTools::CompareImageToFile{_manager});
 }
 
+void ShadersGLBenchmark::throughputSetup() {
+    renderSetup();
+
+    /* Wait for everything submitted so far to finish so it doesn't affect
+       the CPU submit time */
+    GL::Renderer::finish();
+}
+
+void ShadersGLBenchmark::throughputBenchmarkBegin() {
+    setBenchmarkName("GPU draws/s");
+
+    if(!_throughputQuery.id())
+        _throughputQuery = GL::TimeQuery{GL::TimeQuery::Target::TimeElapsed};
+    _throughputQuery.begin();
+}
+
+std::uint64_t ShadersGLBenchmark::throughputBenchmarkEnd() {
+    _throughputQuery.end();
+    const UnsignedLong elapsed = Math::max(_throughputQuery.result<UnsignedLong>(), UnsignedLong{1});
+
+    /* The returned value gets divided by the iteration count passed to
+       CORRADE_BENCHMARK(), so multiply it by the count once more to get draws
+       per second */
+    return UnsignedLong(Double(_throughputDrawCount)*ThroughputIterations*ThroughputIterations*1.0e9/elapsed);
+}
+
+bool timerQuerySupported() {
+    #ifndef MAGNUM_TARGET_GLES
+    return GL::Context::current().isExtensionSupported<GL::Extensions::ARB::timer_query>();
+    #elif defined(MAGNUM_TARGET_WEBGL) && !defined(MAGNUM_TARGET_GLES2)
+    return GL::Context::current().isExtensionSupported<GL::Extensions::EXT::disjoint_timer_query_webgl2>();
+    #else
+    return GL::Context::current().isExtensionSupported<GL::Extensions::EXT::disjoint_timer_query>();
+    #endif
+}
+
+/* A non-indexed quad that's just a few pixels large after transformation, so
+   the throughput benchmarks aren't fill-bound even with a million instances
+   drawn over each other */
+GL::Mesh throughputMesh(const UnsignedInt instanceCount) {
+    GL::Mesh mesh = MeshTools::compile(MeshTools::duplicate(Primitives::grid3DSolid({1, 1},
+        Primitives::GridFlag::TextureCoordinates|
+        Primitives::GridFlag::Normals)));
+
+    if(instanceCount != 1) {
+        struct Instance {
+            Matrix4 transformation;
+            Matrix3x3 normalMatrix;
+        };
+        mesh.addVertexBufferInstanced(GL::Buffer{Containers::Array<Instance>{instanceCount}}, 1, 0,
+            GenericGL3D::TransformationMatrix{},
+            GenericGL3D::NormalMatrix{});
+        mesh.setInstanceCount(instanceCount);
+    }
+
+    return mesh;
+}
+
+const Matrix4 ThroughputTransformation = Matrix4::scaling(Vector3{1.0f/64.0f});
+
+void ShadersGLBenchmark::flatThroughput() {
+    auto&& data = ThroughputData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if(!timerQuerySupported())
+        CORRADE_SKIP("Timer queries are not supported.");
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(data.submit != Submit::Uniforms && data.submit != Submit::Instanced && !GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() << "is not supported.");
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES2
+    if(data.submit == Submit::MultiDraw) {
+        #ifndef MAGNUM_TARGET_GLES
+        if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::shader_draw_parameters>())
+            CORRADE_SKIP(GL::Extensions::ARB::shader_draw_parameters::string() << "is not supported.");
+        #elif !defined(MAGNUM_TARGET_WEBGL)
+        if(!GL::Context::current().isExtensionSupported<GL::Extensions::ANGLE::multi_draw>())
+            CORRADE_SKIP(GL::Extensions::ANGLE::multi_draw::string() << "is not supported.");
+        #else
+        if(!GL::Context::current().isExtensionSupported<GL::Extensions::WEBGL::multi_draw>())
+            CORRADE_SKIP(GL::Extensions::WEBGL::multi_draw::string() << "is not supported.");
+        #endif
+    }
+    #endif
+
+    if(data.submit == Submit::Instanced) {
+        #ifndef MAGNUM_TARGET_GLES
+        if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::instanced_arrays>())
+            CORRADE_SKIP(GL::Extensions::ARB::instanced_arrays::string() << "is not supported.");
+        #elif defined(MAGNUM_TARGET_GLES2)
+        #ifndef MAGNUM_TARGET_WEBGL
+        if(!GL::Context::current().isExtensionSupported<GL::Extensions::ANGLE::instanced_arrays>() &&
+        !GL::Context::current().isExtensionSupported<GL::Extensions::EXT::instanced_arrays>() &&
+        !GL::Context::current().isExtensionSupported<GL::Extensions::NV::instanced_arrays>())
+            CORRADE_SKIP("Required extension is not available.");
+        #else
+        if(!GL::Context::current().isExtensionSupported<GL::Extensions::ANGLE::instanced_arrays>())
+            CORRADE_SKIP(GL::Extensions::ANGLE::instanced_arrays::string() << "is not supported.");
+        #endif
+        #endif
+    }
+
+    FlatGL3D::Flags flags;
+    if(data.submit == Submit::Instanced)
+        flags |= FlatGL3D::Flag::InstancedTransformation;
+    #ifndef MAGNUM_TARGET_GLES2
+    if(data.submit == Submit::UniformBuffers)
+        flags |= FlatGL3D::Flag::UniformBuffers;
+    if(data.submit == Submit::MultiDraw)
+        flags |= FlatGL3D::Flag::MultiDraw;
+    if(data.textureArrays) {
+        flags |= FlatGL3D::Flag::Textured|FlatGL3D::Flag::TextureArrays;
+        /* With uniform buffers the layer is taken from the texture
+           transformation buffer */
+        if(data.submit != Submit::Uniforms)
+            flags |= FlatGL3D::Flag::TextureTransformation;
+    }
+    const UnsignedInt chunkDrawCount = Math::min(data.drawCount, ThroughputChunkDrawCount);
+    #endif
+
+    GL::Mesh mesh = throughputMesh(data.instanceCount);
+    _throughputDrawCount = UnsignedLong(data.drawCount)*data.instanceCount;
+
+    FlatGL3D shader{FlatGL3D::Configuration{}
+        .setFlags(flags)
+        #ifndef MAGNUM_TARGET_GLES2
+        .setDrawCount(chunkDrawCount)
+        #endif
+    };
+
+    #ifndef MAGNUM_TARGET_GLES2
+    if(data.textureArrays)
+        shader.bindTexture(_textureWhiteArray);
+
+    GL::Buffer transformationProjectionUniform{NoCreate};
+    GL::Buffer drawUniform{NoCreate};
+    GL::Buffer materialUniform{NoCreate};
+    GL::Buffer textureTransformationUniform{NoCreate};
+    Containers::Array<UnsignedInt> counts, vertexOffsets;
+    if(flags & FlatGL3D::Flag::UniformBuffers) {
+        /* Round up to whole chunks so each binding is in bounds */
+        const std::size_t size = (data.drawCount + chunkDrawCount - 1)/chunkDrawCount*chunkDrawCount;
+        transformationProjectionUniform = GL::Buffer{GL::Buffer::TargetHint::Uniform, Containers::Array<TransformationProjectionUniform3D>{DirectInit, size, TransformationProjectionUniform3D{}.setTransformationProjectionMatrix(ThroughputTransformation)}};
+        drawUniform = GL::Buffer{GL::Buffer::TargetHint::Uniform, Containers::Array<FlatDrawUniform>{size}};
+        materialUniform = GL::Buffer{GL::Buffer::TargetHint::Uniform, {FlatMaterialUniform{}}};
+        if(flags & FlatGL3D::Flag::TextureTransformation)
+            textureTransformationUniform = GL::Buffer{GL::Buffer::TargetHint::Uniform, Containers::Array<TextureTransformationUniform>{size}};
+        shader.bindMaterialBuffer(materialUniform);
+
+        if(flags >= FlatGL3D::Flag::MultiDraw) {
+            counts = Containers::Array<UnsignedInt>{DirectInit, chunkDrawCount, UnsignedInt(mesh.count())};
+            vertexOffsets = Containers::Array<UnsignedInt>{ValueInit, chunkDrawCount};
+        }
+    }
+    #endif
+
+    auto submit = [&]() {
+        #ifndef MAGNUM_TARGET_GLES2
+        if(flags & FlatGL3D::Flag::UniformBuffers) {
+            for(UnsignedInt offset = 0; offset < data.drawCount; offset += chunkDrawCount) {
+                shader
+                    .bindTransformationProjectionBuffer(transformationProjectionUniform,
+                        offset*sizeof(TransformationProjectionUniform3D),
+                        chunkDrawCount*sizeof(TransformationProjectionUniform3D))
+                    .bindDrawBuffer(drawUniform,
+                        offset*sizeof(FlatDrawUniform),
+                        chunkDrawCount*sizeof(FlatDrawUniform));
+                if(flags & FlatGL3D::Flag::TextureTransformation)
+                    shader.bindTextureTransformationBuffer(textureTransformationUniform,
+                        offset*sizeof(TextureTransformationUniform),
+                        chunkDrawCount*sizeof(TextureTransformationUniform));
+
+                const UnsignedInt count = Math::min(data.drawCount - offset, chunkDrawCount);
+                if(flags >= FlatGL3D::Flag::MultiDraw)
+                    shader.draw(mesh, counts.prefix(count), vertexOffsets.prefix(count), nullptr);
+                else for(UnsignedInt i = 0; i != count; ++i) {
+                    shader.setDrawOffset(i);
+                    shader.draw(mesh);
+                }
+            }
+        } else
+        #endif
+        {
+            for(UnsignedInt i = 0; i != data.drawCount; ++i) {
+                shader.setTransformationProjectionMatrix(ThroughputTransformation);
+                #ifndef MAGNUM_TARGET_GLES2
+                if(data.textureArrays)
+                    shader.setTextureLayer(0);
+                #endif
+                shader.draw(mesh);
+            }
+        }
+    };
+
+    /* Warmup run */
+    for(std::size_t i = 0; i != ThroughputWarmupIterations; ++i)
+        submit();
+
+    CORRADE_BENCHMARK(ThroughputIterations)
+        submit();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void ShadersGLBenchmark::phongThroughput() {
+    auto&& data = ThroughputData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if(!timerQuerySupported())
+        CORRADE_SKIP("Timer queries are not supported.");
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(data.submit != Submit::Uniforms && data.submit != Submit::Instanced && !GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() << "is not supported.");
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES2
+    if(data.submit == Submit::MultiDraw) {
+        #ifndef MAGNUM_TARGET_GLES
+        if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::shader_draw_parameters>())
+            CORRADE_SKIP(GL::Extensions::ARB::shader_draw_parameters::string() << "is not supported.");
+        #elif !defined(MAGNUM_TARGET_WEBGL)
+        if(!GL::Context::current().isExtensionSupported<GL::Extensions::ANGLE::multi_draw>())
+            CORRADE_SKIP(GL::Extensions::ANGLE::multi_draw::string() << "is not supported.");
+        #else
+        if(!GL::Context::current().isExtensionSupported<GL::Extensions::WEBGL::multi_draw>())
+            CORRADE_SKIP(GL::Extensions::WEBGL::multi_draw::string() << "is not supported.");
+        #endif
+    }
+    #endif
+
+    if(data.submit == Submit::Instanced) {
+        #ifndef MAGNUM_TARGET_GLES
+        if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::instanced_arrays>())
+            CORRADE_SKIP(GL::Extensions::ARB::instanced_arrays::string() << "is not supported.");
+        #elif defined(MAGNUM_TARGET_GLES2)
+        #ifndef MAGNUM_TARGET_WEBGL
+        if(!GL::Context::current().isExtensionSupported<GL::Extensions::ANGLE::instanced_arrays>() &&
+        !GL::Context::current().isExtensionSupported<GL::Extensions::EXT::instanced_arrays>() &&
+        !GL::Context::current().isExtensionSupported<GL::Extensions::NV::instanced_arrays>())
+            CORRADE_SKIP("Required extension is not available.");
+        #else
+        if(!GL::Context::current().isExtensionSupported<GL::Extensions::ANGLE::instanced_arrays>())
+            CORRADE_SKIP(GL::Extensions::ANGLE::instanced_arrays::string() << "is not supported.");
+        #endif
+        #endif
+    }
+
+    PhongGL::Flags flags;
+    if(data.submit == Submit::Instanced)
+        flags |= PhongGL::Flag::InstancedTransformation;
+    #ifndef MAGNUM_TARGET_GLES2
+    if(data.submit == Submit::UniformBuffers)
+        flags |= PhongGL::Flag::UniformBuffers;
+    if(data.submit == Submit::MultiDraw)
+        flags |= PhongGL::Flag::MultiDraw;
+    if(data.textureArrays) {
+        flags |= PhongGL::Flag::DiffuseTexture|PhongGL::Flag::TextureArrays;
+        /* With uniform buffers the layer is taken from the texture
+           transformation buffer */
+        if(data.submit != Submit::Uniforms)
+            flags |= PhongGL::Flag::TextureTransformation;
+    }
+    const UnsignedInt chunkDrawCount = Math::min(data.drawCount, ThroughputChunkDrawCount);
+    #endif
+
+    GL::Mesh mesh = throughputMesh(data.instanceCount);
+    _throughputDrawCount = UnsignedLong(data.drawCount)*data.instanceCount;
+
+    PhongGL shader{PhongGL::Configuration{}
+        .setFlags(flags)
+        .setLightCount(1)
+        #ifndef MAGNUM_TARGET_GLES2
+        .setDrawCount(chunkDrawCount)
+        #endif
+    };
+
+    #ifndef MAGNUM_TARGET_GLES2
+    if(data.textureArrays)
+        shader.bindDiffuseTexture(_textureWhiteArray);
+
+    GL::Buffer projectionUniform{NoCreate};
+    GL::Buffer transformationUniform{NoCreate};
+    GL::Buffer drawUniform{NoCreate};
+    GL::Buffer materialUniform{NoCreate};
+    GL::Buffer lightUniform{NoCreate};
+    GL::Buffer textureTransformationUniform{NoCreate};
+    Containers::Array<UnsignedInt> counts, vertexOffsets;
+    if(flags & PhongGL::Flag::UniformBuffers) {
+        /* Round up to whole chunks so each binding is in bounds */
+        const std::size_t size = (data.drawCount + chunkDrawCount - 1)/chunkDrawCount*chunkDrawCount;
+        projectionUniform = GL::Buffer{GL::Buffer::TargetHint::Uniform, {ProjectionUniform3D{}}};
+        transformationUniform = GL::Buffer{GL::Buffer::TargetHint::Uniform, Containers::Array<TransformationUniform3D>{DirectInit, size, TransformationUniform3D{}.setTransformationMatrix(ThroughputTransformation)}};
+        drawUniform = GL::Buffer{GL::Buffer::TargetHint::Uniform, Containers::Array<PhongDrawUniform>{DirectInit, size, PhongDrawUniform{}.setNormalMatrix(ThroughputTransformation.normalMatrix())}};
+        materialUniform = GL::Buffer{GL::Buffer::TargetHint::Uniform, {PhongMaterialUniform{}}};
+        lightUniform = GL::Buffer{GL::Buffer::TargetHint::Uniform, {PhongLightUniform{}}};
+        if(flags & PhongGL::Flag::TextureTransformation)
+            textureTransformationUniform = GL::Buffer{GL::Buffer::TargetHint::Uniform, Containers::Array<TextureTransformationUniform>{size}};
+        shader
+            .bindProjectionBuffer(projectionUniform)
+            .bindMaterialBuffer(materialUniform)
+            .bindLightBuffer(lightUniform);
+
+        if(flags >= PhongGL::Flag::MultiDraw) {
+            counts = Containers::Array<UnsignedInt>{DirectInit, chunkDrawCount, UnsignedInt(mesh.count())};
+            vertexOffsets = Containers::Array<UnsignedInt>{ValueInit, chunkDrawCount};
+        }
+    }
+    #endif
+
+    auto submit = [&]() {
+        #ifndef MAGNUM_TARGET_GLES2
+        if(flags & PhongGL::Flag::UniformBuffers) {
+            for(UnsignedInt offset = 0; offset < data.drawCount; offset += chunkDrawCount) {
+                shader
+                    .bindTransformationBuffer(transformationUniform,
+                        offset*sizeof(TransformationUniform3D),
+                        chunkDrawCount*sizeof(TransformationUniform3D))
+                    .bindDrawBuffer(drawUniform,
+                        offset*sizeof(PhongDrawUniform),
+                        chunkDrawCount*sizeof(PhongDrawUniform));
+                if(flags & PhongGL::Flag::TextureTransformation)
+                    shader.bindTextureTransformationBuffer(textureTransformationUniform,
+                        offset*sizeof(TextureTransformationUniform),
+                        chunkDrawCount*sizeof(TextureTransformationUniform));
+
+                const UnsignedInt count = Math::min(data.drawCount - offset, chunkDrawCount);
+                if(flags >= PhongGL::Flag::MultiDraw)
+                    shader.draw(mesh, counts.prefix(count), vertexOffsets.prefix(count), nullptr);
+                else for(UnsignedInt i = 0; i != count; ++i) {
+                    shader.setDrawOffset(i);
+                    shader.draw(mesh);
+                }
+            }
+        } else
+        #endif
+        {
+            for(UnsignedInt i = 0; i != data.drawCount; ++i) {
+                shader
+                    .setTransformationMatrix(ThroughputTransformation)
+                    .setNormalMatrix(ThroughputTransformation.normalMatrix());
+                #ifndef MAGNUM_TARGET_GLES2
+                if(data.textureArrays)
+                    shader.setTextureLayer(0);
+                #endif
+                shader.draw(mesh);
+            }
+        }
+    };
+
+    /* Warmup run */
+    for(std::size_t i = 0; i != ThroughputWarmupIterations; ++i)
+        submit();
+
+    CORRADE_BENCHMARK(ThroughputIterations)
+        submit();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Shaders::Test::ShadersGLBenchmark)
@@ -0,0 +1,259 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <new>
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Shaders/ShadowCascade.h"
+
+namespace Magnum { namespace Shaders { namespace Test { namespace {
+
+struct ShadowCascadeTest: TestSuite::Tester {
+    explicit ShadowCascadeTest();
+
+    void uniformSizeAlignment();
+
+    void uniformConstructDefault();
+    void uniformConstructNoInit();
+    void uniformSetters();
+    void uniformSetCascadeMatrixInvalid();
+
+    void splits();
+    void splitsInvalid();
+
+    void projection();
+};
+
+using namespace Math::Literals;
+
+const struct {
+    const char* name;
+    UnsignedInt count;
+    Float lambda;
+    Vector4 expected;
+} SplitsData[]{
+    {"logarithmic", 4, 1.0f, {3.16228f, 10.0f, 31.6228f, 100.0f}},
+    {"uniform", 4, 0.0f, {25.75f, 50.5f, 75.25f, 100.0f}},
+    {"practical, two cascades", 2, 0.5f, {30.25f, 100.0f, 100.0f, 100.0f}},
+    {"single cascade", 1, 0.5f, Vector4{100.0f}}
+};
+
+const struct {
+    const char* name;
+    Matrix4 cameraMatrix;
+    Vector3 lightDirection;
+} ProjectionData[]{
+    {"light along the view direction", {},
+        Vector3::zAxis(-1.0f)},
+    {"rotated camera, oblique light",
+        (Matrix4::translation({3.0f, -1.0f, 5.0f})*Matrix4::rotationY(35.0_degf)).inverted(),
+        Vector3{1.0f, -2.0f, 0.5f}.normalized()},
+    {"light straight down",
+        (Matrix4::rotationX(-20.0_degf)).inverted(),
+        Vector3::yAxis(-1.0f)},
+};
+
+ShadowCascadeTest::ShadowCascadeTest() {
+    addTests({&ShadowCascadeTest::uniformSizeAlignment,
+
+              &ShadowCascadeTest::uniformConstructDefault,
+              &ShadowCascadeTest::uniformConstructNoInit,
+              &ShadowCascadeTest::uniformSetters,
+              &ShadowCascadeTest::uniformSetCascadeMatrixInvalid});
+
+    addInstancedTests({&ShadowCascadeTest::splits},
+        Containers::arraySize(SplitsData));
+
+    addTests({&ShadowCascadeTest::splitsInvalid});
+
+    addInstancedTests({&ShadowCascadeTest::projection},
+        Containers::arraySize(ProjectionData));
+}
+
+void ShadowCascadeTest::uniformSizeAlignment() {
+    CORRADE_FAIL_IF(sizeof(ShadowCascadeUniform) % sizeof(Vector4) != 0, sizeof(ShadowCascadeUniform) << "is not a multiple of vec4 for UBO alignment.");
+
+    /* The structure is used only as a single instance, so it doesn't need to
+       fit exactly into the UBO alignment */
+    CORRADE_COMPARE(sizeof(ShadowCascadeUniform), 288);
+    CORRADE_COMPARE(alignof(ShadowCascadeUniform), 4);
+}
+
+void ShadowCascadeTest::uniformConstructDefault() {
+    ShadowCascadeUniform a;
+    ShadowCascadeUniform b{DefaultInit};
+    CORRADE_COMPARE(a.cascadeMatrices[0], Matrix4{});
+    CORRADE_COMPARE(b.cascadeMatrices[0], Matrix4{});
+    CORRADE_COMPARE(a.cascadeMatrices[3], Matrix4{});
+    CORRADE_COMPARE(b.cascadeMatrices[3], Matrix4{});
+    CORRADE_COMPARE(a.cascadeSplits, Vector4{Constants::inf()});
+    CORRADE_COMPARE(b.cascadeSplits, Vector4{Constants::inf()});
+    CORRADE_COMPARE(a.lightIndex, 0);
+    CORRADE_COMPARE(b.lightIndex, 0);
+    CORRADE_COMPARE(a.cascadeCount, 1);
+    CORRADE_COMPARE(b.cascadeCount, 1);
+    CORRADE_COMPARE(a.bias, 0.005f);
+    CORRADE_COMPARE(b.bias, 0.005f);
+    CORRADE_COMPARE(a.filterRadius, 1.0f);
+    CORRADE_COMPARE(b.filterRadius, 1.0f);
+
+    constexpr ShadowCascadeUniform ca;
+    constexpr ShadowCascadeUniform cb{DefaultInit};
+    CORRADE_COMPARE(ca.cascadeMatrices[0], Matrix4{});
+    CORRADE_COMPARE(cb.cascadeMatrices[0], Matrix4{});
+    CORRADE_COMPARE(ca.cascadeSplits, Vector4{Constants::inf()});
+    CORRADE_COMPARE(cb.cascadeSplits, Vector4{Constants::inf()});
+    CORRADE_COMPARE(ca.lightIndex, 0);
+    CORRADE_COMPARE(cb.lightIndex, 0);
+    CORRADE_COMPARE(ca.cascadeCount, 1);
+    CORRADE_COMPARE(cb.cascadeCount, 1);
+    CORRADE_COMPARE(ca.bias, 0.005f);
+    CORRADE_COMPARE(cb.bias, 0.005f);
+    CORRADE_COMPARE(ca.filterRadius, 1.0f);
+    CORRADE_COMPARE(cb.filterRadius, 1.0f);
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<ShadowCascadeUniform>::value);
+    CORRADE_VERIFY(std::is_nothrow_constructible<ShadowCascadeUniform, DefaultInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<DefaultInitT, ShadowCascadeUniform>::value);
+}
+
+void ShadowCascadeTest::uniformConstructNoInit() {
+    /* Testing only some fields, should be enough */
+    ShadowCascadeUniform a;
+    a.cascadeSplits = {1.0f, 2.0f, 3.0f, 4.0f};
+    a.filterRadius = 2.5f;
+
+    new(&a) ShadowCascadeUniform{NoInit};
+    {
+        /* Explicitly check we're not on Clang because certain Clang-based IDEs
+           inherit __GNUC__ if GCC is used instead of leaving it at 4 like
+           Clang itself does */
+        #if defined(CORRADE_TARGET_GCC) && !defined(CORRADE_TARGET_CLANG) && __GNUC__*100 + __GNUC_MINOR__ >= 601 && __OPTIMIZE__
+        CORRADE_EXPECT_FAIL("GCC 6.1+ misoptimizes and overwrites the value.");
+        #endif
+        CORRADE_COMPARE(a.cascadeSplits, (Vector4{1.0f, 2.0f, 3.0f, 4.0f}));
+        CORRADE_COMPARE(a.filterRadius, 2.5f);
+    }
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<ShadowCascadeUniform, NoInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoInitT, ShadowCascadeUniform>::value);
+}
+
+void ShadowCascadeTest::uniformSetters() {
+    ShadowCascadeUniform a;
+    a.setCascadeMatrix(2, Matrix4::scaling({2.0f, 3.0f, 4.0f}))
+     .setCascadeSplits({1.0f, 2.0f, 3.0f, 4.0f})
+     .setLightIndex(7)
+     .setCascadeCount(3)
+     .setBias(0.01f)
+     .setFilterRadius(1.5f);
+    CORRADE_COMPARE(a.cascadeMatrices[1], Matrix4{});
+    CORRADE_COMPARE(a.cascadeMatrices[2], Matrix4::scaling({2.0f, 3.0f, 4.0f}));
+    CORRADE_COMPARE(a.cascadeSplits, (Vector4{1.0f, 2.0f, 3.0f, 4.0f}));
+    CORRADE_COMPARE(a.lightIndex, 7);
+    CORRADE_COMPARE(a.cascadeCount, 3);
+    CORRADE_COMPARE(a.bias, 0.01f);
+    CORRADE_COMPARE(a.filterRadius, 1.5f);
+}
+
+void ShadowCascadeTest::uniformSetCascadeMatrixInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    ShadowCascadeUniform a;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    a.setCascadeMatrix(4, {});
+    CORRADE_COMPARE(out.str(), "Shaders::ShadowCascadeUniform::setCascadeMatrix(): index 4 out of range for 4 cascades\n");
+}
+
+void ShadowCascadeTest::splits() {
+    auto&& data = SplitsData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    CORRADE_COMPARE(shadowCascadeSplits(1.0f, 100.0f, data.count, data.lambda), data.expected);
+}
+
+void ShadowCascadeTest::splitsInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    shadowCascadeSplits(0.0f, 100.0f, 4);
+    shadowCascadeSplits(10.0f, 10.0f, 4);
+    shadowCascadeSplits(1.0f, 100.0f, 0);
+    shadowCascadeSplits(1.0f, 100.0f, 5);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::shadowCascadeSplits(): expected 0 < near < far but got 0 and 100\n"
+        "Shaders::shadowCascadeSplits(): expected 0 < near < far but got 10 and 10\n"
+        "Shaders::shadowCascadeSplits(): expected 1 to 4 cascades but got 0\n"
+        "Shaders::shadowCascadeSplits(): expected 1 to 4 cascades but got 5\n");
+}
+
+void ShadowCascadeTest::projection() {
+    auto&& data = ProjectionData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* With a 90° FoV and a square aspect ratio the frustum corners at a
+       distance d are at (±d, ±d, -d) */
+    const Matrix4 projectionMatrix = Matrix4::perspectiveProjection(90.0_degf, 1.0f, 0.1f, 100.0f);
+    const Matrix4 cascade = shadowCascadeProjection(data.cameraMatrix, projectionMatrix, 2.0f, 10.0f, data.lightDirection);
+
+    /* All corners of the frustum slice should be inside the projection */
+    const Matrix4 cameraTransformation = data.cameraMatrix.inverted();
+    for(const Float d: {2.0f, 10.0f}) for(const Vector2& xy: {
+        Vector2{-1.0f, -1.0f}, Vector2{1.0f, -1.0f},
+        Vector2{-1.0f, 1.0f}, Vector2{1.0f, 1.0f}
+    }) {
+        CORRADE_ITERATION(d << xy);
+        const Vector3 projected = cascade.transformPoint(cameraTransformation.transformPoint({xy*d, -d}));
+        CORRADE_COMPARE_AS(Math::abs(projected).max(), 1.0f + 1.0e-5f,
+            TestSuite::Compare::LessOrEqual);
+    }
+
+    /* The projection is orthographic, looking along the light direction */
+    CORRADE_COMPARE(cascade.row(3), (Vector4{0.0f, 0.0f, 0.0f, 1.0f}));
+    CORRADE_COMPARE(cascade.transformVector(data.lightDirection).xy(), Vector2{});
+    CORRADE_COMPARE_AS(cascade.transformVector(data.lightDirection).z(), 0.0f,
+        TestSuite::Compare::Greater);
+
+    /* The slice is enclosed in a bounding sphere, so the size depends only on
+       the slice and not on the camera orientation or the light direction.
+       The slice center is at a distance of 6, the far corners then at a
+       distance of sqrt(4² + 10² + 10²). */
+    CORRADE_COMPARE(cascade.transformVector(Vector3::xAxis()).length(), 1.0f/Math::sqrt(216.0f));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Shaders::Test::ShadowCascadeTest)
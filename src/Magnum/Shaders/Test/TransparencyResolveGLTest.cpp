@@ -0,0 +1,230 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/System.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/Framebuffer.h"
+#include "Magnum/GL/Mesh.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/GL/Renderbuffer.h"
+#include "Magnum/GL/RenderbufferFormat.h"
+#include "Magnum/GL/Renderer.h"
+#include "Magnum/GL/Texture.h"
+#include "Magnum/GL/TextureFormat.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/MeshTools/Compile.h"
+#include "Magnum/MeshTools/FullScreenTriangle.h"
+#include "Magnum/Primitives/Plane.h"
+#include "Magnum/Shaders/FlatGL.h"
+#include "Magnum/Shaders/GenericGL.h"
+#include "Magnum/Shaders/TransparencyResolveGL.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace Shaders { namespace Test { namespace {
+
+struct TransparencyResolveGLTest: GL::OpenGLTester {
+    explicit TransparencyResolveGLTest();
+
+    void construct();
+    void constructAsync();
+    void constructMove();
+
+    void render();
+};
+
+using namespace Math::Literals;
+
+const struct {
+    const char* name;
+    bool redFirst;
+} RenderData[]{
+    {"red first", true},
+    {"blue first", false}
+};
+
+TransparencyResolveGLTest::TransparencyResolveGLTest() {
+    addTests({&TransparencyResolveGLTest::construct,
+              &TransparencyResolveGLTest::constructAsync,
+              &TransparencyResolveGLTest::constructMove});
+
+    addInstancedTests({&TransparencyResolveGLTest::render},
+        Containers::arraySize(RenderData));
+}
+
+void TransparencyResolveGLTest::construct() {
+    TransparencyResolveGL shader;
+    CORRADE_VERIFY(shader.id());
+    {
+        #if defined(CORRADE_TARGET_APPLE) && !defined(MAGNUM_TARGET_GLES)
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void TransparencyResolveGLTest::constructAsync() {
+    TransparencyResolveGL::CompileState state = TransparencyResolveGL::compile();
+
+    while(!state.isLinkFinished())
+        Utility::System::sleep(100);
+
+    TransparencyResolveGL shader{std::move(state)};
+    CORRADE_VERIFY(shader.id());
+    {
+        #if defined(CORRADE_TARGET_APPLE) && !defined(MAGNUM_TARGET_GLES)
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void TransparencyResolveGLTest::constructMove() {
+    TransparencyResolveGL a;
+    const GLuint id = a.id();
+    CORRADE_VERIFY(id);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    TransparencyResolveGL b{std::move(a)};
+    CORRADE_COMPARE(b.id(), id);
+    CORRADE_VERIFY(!a.id());
+
+    TransparencyResolveGL c{NoCreate};
+    c = std::move(b);
+    CORRADE_COMPARE(c.id(), id);
+    CORRADE_VERIFY(!b.id());
+}
+
+constexpr Vector2i RenderSize{80, 80};
+
+void TransparencyResolveGLTest::render() {
+    auto&& data = RenderData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::draw_buffers_blend>())
+        CORRADE_SKIP(GL::Extensions::ARB::draw_buffers_blend::string() << "is not supported.");
+    #else
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::draw_buffers_indexed>())
+        CORRADE_SKIP(GL::Extensions::EXT::draw_buffers_indexed::string() << "is not supported.");
+    #ifndef MAGNUM_TARGET_WEBGL
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::color_buffer_half_float>())
+        CORRADE_SKIP(GL::Extensions::EXT::color_buffer_half_float::string() << "is not supported.");
+    #else
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::color_buffer_float>())
+        CORRADE_SKIP(GL::Extensions::EXT::color_buffer_float::string() << "is not supported.");
+    #endif
+    #endif
+
+    GL::Renderbuffer color;
+    color.setStorage(GL::RenderbufferFormat::RGBA8, RenderSize);
+    GL::Texture2D accumulation;
+    accumulation.setStorage(1, GL::TextureFormat::RGBA16F, RenderSize);
+    GL::Texture2D revealage;
+    revealage.setStorage(1, GL::TextureFormat::R8, RenderSize);
+
+    GL::Framebuffer framebuffer{{{}, RenderSize}};
+    framebuffer
+        .attachRenderbuffer(GL::Framebuffer::ColorAttachment{0}, color)
+        .attachTexture(GL::Framebuffer::ColorAttachment{1}, accumulation, 0)
+        .attachTexture(GL::Framebuffer::ColorAttachment{2}, revealage, 0)
+        .clearColor(0, 0x000000ff_rgbaf)
+        .mapForDraw({
+            {FlatGL3D::ColorOutput, GL::Framebuffer::ColorAttachment{1}},
+            {FlatGL3D::RevealageOutput, GL::Framebuffer::ColorAttachment{2}}
+        })
+        /* Clear indices are draw buffers, not attachments */
+        .clearColor(FlatGL3D::ColorOutput, Color4{0.0f})
+        .clearColor(FlatGL3D::RevealageOutput, Color4{1.0f})
+        .bind();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Two overlapping half-transparent planes. With the weights depending
+       only on alpha and depth, the result is the same regardless of the
+       draw order. */
+    GL::Mesh plane = MeshTools::compile(Primitives::planeSolid());
+    FlatGL3D flat{FlatGL3D::Configuration{}
+        .setFlags(FlatGL3D::Flag::OrderIndependentTransparency)};
+    const Color4 colors[]{
+        data.redFirst ? 0xff000080_rgbaf : 0x0000ff80_rgbaf,
+        data.redFirst ? 0x0000ff80_rgbaf : 0xff000080_rgbaf
+    };
+
+    GL::Renderer::enable(GL::Renderer::Feature::Blending);
+    GL::Renderer::setBlendFunction(FlatGL3D::ColorOutput,
+        GL::Renderer::BlendFunction::One,
+        GL::Renderer::BlendFunction::One);
+    GL::Renderer::setBlendFunction(FlatGL3D::RevealageOutput,
+        GL::Renderer::BlendFunction::Zero,
+        GL::Renderer::BlendFunction::OneMinusSourceColor);
+    for(const Color4& c: colors)
+        flat.setColor(c)
+            .draw(plane);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Composite over the opaque attachment */
+    framebuffer.mapForDraw({
+        {GenericGL3D::ColorOutput, GL::Framebuffer::ColorAttachment{0}}
+    });
+    GL::Renderer::setBlendFunction(
+        GL::Renderer::BlendFunction::SourceAlpha,
+        GL::Renderer::BlendFunction::OneMinusSourceAlpha);
+    GL::Mesh triangle = MeshTools::fullScreenTriangle();
+    TransparencyResolveGL resolve;
+    resolve
+        .bindAccumulationTexture(accumulation)
+        .bindRevealageTexture(revealage)
+        .draw(triangle);
+    GL::Renderer::disable(GL::Renderer::Feature::Blending);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Both colors contribute equally with a total coverage of
+       1 - 0.5*0.5 = 0.75, i.e. 0.5*0.75 = 0.375 for each of the two channels
+       over black */
+    framebuffer.mapForRead(GL::Framebuffer::ColorAttachment{0});
+    Image2D image = framebuffer.read(framebuffer.viewport(), {PixelFormat::RGBA8Unorm});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    const Color4ub pixel = image.pixels<Color4ub>()[RenderSize.y()/2][RenderSize.x()/2];
+    CORRADE_COMPARE_WITH(Int(pixel.r()), 96, TestSuite::Compare::around(1));
+    CORRADE_COMPARE(pixel.g(), 0);
+    CORRADE_COMPARE_WITH(Int(pixel.b()), 96, TestSuite::Compare::around(1));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Shaders::Test::TransparencyResolveGLTest)
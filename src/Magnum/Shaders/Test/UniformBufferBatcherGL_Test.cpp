@@ -0,0 +1,107 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/GL/Buffer.h"
+#include "Magnum/GL/Mesh.h"
+#include "Magnum/Shaders/UniformBufferBatcherGL.h"
+
+namespace Magnum { namespace Shaders { namespace Test { namespace {
+
+/* There's an underscore between GL and Test to disambiguate from GLTest, which
+   is a common suffix used to mark tests that need a GL context. Ugly, I know. */
+struct UniformBufferBatcherGL_Test: TestSuite::Tester {
+    explicit UniformBufferBatcherGL_Test();
+
+    void constructNoCreate();
+    void constructCopy();
+
+    void addNoUniformBuffers();
+    void noCreate();
+};
+
+UniformBufferBatcherGL_Test::UniformBufferBatcherGL_Test() {
+    addTests({&UniformBufferBatcherGL_Test::constructNoCreate,
+              &UniformBufferBatcherGL_Test::constructCopy,
+
+              &UniformBufferBatcherGL_Test::addNoUniformBuffers,
+              &UniformBufferBatcherGL_Test::noCreate});
+}
+
+void UniformBufferBatcherGL_Test::constructNoCreate() {
+    {
+        UniformBufferBatcherGL batcher{NoCreate};
+        CORRADE_VERIFY(!batcher.uniformBuffer().id());
+        CORRADE_COMPARE(batcher.drawCount(), 0);
+        CORRADE_COMPARE(batcher.dataSize(), 0);
+    }
+
+    CORRADE_VERIFY(true);
+}
+
+void UniformBufferBatcherGL_Test::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<UniformBufferBatcherGL>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<UniformBufferBatcherGL>{});
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<UniformBufferBatcherGL>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<UniformBufferBatcherGL>::value);
+}
+
+void UniformBufferBatcherGL_Test::addNoUniformBuffers() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    UniformBufferBatcherGL batcher{NoCreate};
+    /* Shaders constructed with NoCreate have no flags */
+    PhongGL phong{NoCreate};
+    FlatGL3D flat{NoCreate};
+    GL::Mesh mesh{NoCreate};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    batcher.add(phong, mesh, TransformationUniform3D{}, PhongDrawUniform{});
+    batcher.add(flat, mesh, TransformationProjectionUniform3D{}, FlatDrawUniform{});
+    CORRADE_COMPARE(batcher.drawCount(), 0);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::UniformBufferBatcherGL::add(): the shader wasn't created with uniform buffers\n"
+        "Shaders::UniformBufferBatcherGL::add(): the shader wasn't created with uniform buffers\n");
+}
+
+void UniformBufferBatcherGL_Test::noCreate() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    UniformBufferBatcherGL batcher{NoCreate};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    batcher.flush();
+    CORRADE_COMPARE(out.str(),
+        "Shaders::UniformBufferBatcherGL::flush(): the batcher was constructed with NoCreate\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Shaders::Test::UniformBufferBatcherGL_Test)
@@ -32,10 +32,10 @@
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/FormatStl.h>
 #include <Corrade/Utility/Path.h>
+#include <Corrade/Utility/System.h>
 
 #ifdef CORRADE_TARGET_APPLE
 #include <Corrade/Containers/Pair.h>
-#include <Corrade/Utility/System.h> /* isSandboxed() */
 #endif
 
 #include "Magnum/Image.h"
@@ -87,6 +87,11 @@ struct VectorGLTest: GL::OpenGLTester {
     template<UnsignedInt dimensions> void constructUniformBuffers();
     #endif
 
+    template<UnsignedInt dimensions> void constructAsync();
+    #ifndef MAGNUM_TARGET_GLES2
+    template<UnsignedInt dimensions> void constructUniformBuffersAsync();
+    #endif
+
     template<UnsignedInt dimensions> void constructMove();
     #ifndef MAGNUM_TARGET_GLES2
     template<UnsignedInt dimensions> void constructMoveUniformBuffers();
@@ -103,6 +108,7 @@ struct VectorGLTest: GL::OpenGLTester {
     template<UnsignedInt dimensions> void setTextureMatrixNotEnabled();
     #ifndef MAGNUM_TARGET_GLES2
     template<UnsignedInt dimensions> void bindTextureTransformBufferNotEnabled();
+    template<UnsignedInt dimensions> void bindGlyphRectangleTextureNotEnabled();
     #endif
     #ifndef MAGNUM_TARGET_GLES2
     template<UnsignedInt dimensions> void setWrongDrawOffset();
@@ -166,7 +172,10 @@ constexpr struct {
     VectorGL2D::Flags flags;
 } ConstructData[]{
     {"", {}},
-    {"texture transformation", VectorGL2D::Flag::TextureTransformation}
+    {"texture transformation", VectorGL2D::Flag::TextureTransformation},
+    #ifndef MAGNUM_TARGET_GLES2
+    {"instanced glyphs", VectorGL2D::Flag::InstancedGlyphs},
+    #endif
 };
 
 #ifndef MAGNUM_TARGET_GLES2
@@ -255,6 +264,14 @@ VectorGLTest::VectorGLTest() {
     #endif
 
     addTests<VectorGLTest>({
+        &VectorGLTest::constructAsync<2>,
+        &VectorGLTest::constructAsync<3>,
+
+        #ifndef MAGNUM_TARGET_GLES2
+        &VectorGLTest::constructUniformBuffersAsync<2>,
+        &VectorGLTest::constructUniformBuffersAsync<3>,
+        #endif
+
         &VectorGLTest::constructMove<2>,
         &VectorGLTest::constructMove<3>,
 
@@ -283,6 +300,8 @@ VectorGLTest::VectorGLTest() {
         #ifndef MAGNUM_TARGET_GLES2
         &VectorGLTest::bindTextureTransformBufferNotEnabled<2>,
         &VectorGLTest::bindTextureTransformBufferNotEnabled<3>,
+        &VectorGLTest::bindGlyphRectangleTextureNotEnabled<2>,
+        &VectorGLTest::bindGlyphRectangleTextureNotEnabled<3>,
         #endif
         #ifndef MAGNUM_TARGET_GLES2
         &VectorGLTest::setWrongDrawOffset<2>,
@@ -357,6 +376,15 @@ template<UnsignedInt dimensions> void VectorGLTest::construct() {
     auto&& data = ConstructData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
 
+    #ifndef MAGNUM_TARGET_GLES
+    if(data.flags >= VectorGL2D::Flag::InstancedGlyphs) {
+        if(!GL::Context::current().isVersionSupported(GL::Version::GL300))
+            CORRADE_SKIP(GL::Version::GL300 << "is not supported.");
+        if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::instanced_arrays>())
+            CORRADE_SKIP(GL::Extensions::ARB::instanced_arrays::string() << "is not supported.");
+    }
+    #endif
+
     VectorGL<dimensions> shader{data.flags};
     CORRADE_COMPARE(shader.flags(), data.flags);
     CORRADE_VERIFY(shader.id());
@@ -410,6 +438,61 @@ template<UnsignedInt dimensions> void VectorGLTest::constructUniformBuffers() {
 }
 #endif
 
+template<UnsignedInt dimensions> void VectorGLTest::constructAsync() {
+    setTestCaseTemplateName(Utility::format("{}", dimensions));
+
+    typename VectorGL<dimensions>::CompileState state = VectorGL<dimensions>::compile(VectorGL2D::Flag::TextureTransformation);
+    CORRADE_COMPARE(state.flags(), VectorGL2D::Flag::TextureTransformation);
+
+    while(!state.isLinkFinished())
+        Utility::System::sleep(100);
+
+    VectorGL<dimensions> shader{std::move(state)};
+    CORRADE_COMPARE(shader.flags(), VectorGL2D::Flag::TextureTransformation);
+    CORRADE_VERIFY(shader.id());
+    {
+        #if defined(CORRADE_TARGET_APPLE) && !defined(MAGNUM_TARGET_GLES)
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+template<UnsignedInt dimensions> void VectorGLTest::constructUniformBuffersAsync() {
+    setTestCaseTemplateName(Utility::format("{}", dimensions));
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() << "is not supported.");
+    #endif
+
+    typename VectorGL<dimensions>::CompileState state = VectorGL<dimensions>::compile(VectorGL2D::Flag::UniformBuffers|VectorGL2D::Flag::TextureTransformation, 3, 5);
+    CORRADE_COMPARE(state.flags(), VectorGL2D::Flag::UniformBuffers|VectorGL2D::Flag::TextureTransformation);
+    CORRADE_COMPARE(state.materialCount(), 3);
+    CORRADE_COMPARE(state.drawCount(), 5);
+
+    while(!state.isLinkFinished())
+        Utility::System::sleep(100);
+
+    VectorGL<dimensions> shader{std::move(state)};
+    CORRADE_COMPARE(shader.flags(), VectorGL2D::Flag::UniformBuffers|VectorGL2D::Flag::TextureTransformation);
+    CORRADE_COMPARE(shader.materialCount(), 3);
+    CORRADE_COMPARE(shader.drawCount(), 5);
+    CORRADE_VERIFY(shader.id());
+    {
+        #if defined(CORRADE_TARGET_APPLE) && !defined(MAGNUM_TARGET_GLES)
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+#endif
+
 template<UnsignedInt dimensions> void VectorGLTest::constructMove() {
     setTestCaseTemplateName(Utility::format("{}", dimensions));
 
@@ -579,6 +662,21 @@ template<UnsignedInt dimensions> void VectorGLTest::bindTextureTransformBufferNo
         "Shaders::VectorGL::bindTextureTransformationBuffer(): the shader was not created with texture transformation enabled\n"
         "Shaders::VectorGL::bindTextureTransformationBuffer(): the shader was not created with texture transformation enabled\n");
 }
+
+template<UnsignedInt dimensions> void VectorGLTest::bindGlyphRectangleTextureNotEnabled() {
+    setTestCaseTemplateName(Utility::format("{}", dimensions));
+
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    GL::Texture2D texture;
+    VectorGL<dimensions> shader;
+    shader.bindGlyphRectangleTexture(texture);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::VectorGL::bindGlyphRectangleTexture(): the shader was not created with instanced glyphs enabled\n");
+}
 #endif
 
 #ifndef MAGNUM_TARGET_GLES2
@@ -30,10 +30,10 @@
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Format.h>
 #include <Corrade/Utility/Path.h>
+#include <Corrade/Utility/System.h>
 
 #ifdef CORRADE_TARGET_APPLE
 #include <Corrade/Containers/Pair.h>
-#include <Corrade/Utility/System.h> /* isSandboxed() */
 #endif
 
 #include "Magnum/DebugTools/CompareImage.h"
@@ -78,6 +78,11 @@ struct VertexColorGLTest: GL::OpenGLTester {
     template<UnsignedInt dimensions> void constructUniformBuffers();
     #endif
 
+    template<UnsignedInt dimensions> void constructAsync();
+    #ifndef MAGNUM_TARGET_GLES2
+    template<UnsignedInt dimensions> void constructUniformBuffersAsync();
+    #endif
+
     template<UnsignedInt dimensions> void constructMove();
     #ifndef MAGNUM_TARGET_GLES2
     template<UnsignedInt dimensions> void constructMoveUniformBuffers();
@@ -200,6 +205,14 @@ VertexColorGLTest::VertexColorGLTest() {
     #endif
 
     addTests<VertexColorGLTest>({
+        &VertexColorGLTest::constructAsync<2>,
+        &VertexColorGLTest::constructAsync<3>,
+
+        #ifndef MAGNUM_TARGET_GLES2
+        &VertexColorGLTest::constructUniformBuffersAsync<2>,
+        &VertexColorGLTest::constructUniformBuffersAsync<3>,
+        #endif
+
         &VertexColorGLTest::constructMove<2>,
         &VertexColorGLTest::constructMove<3>,
 
@@ -349,6 +362,59 @@ template<UnsignedInt dimensions> void VertexColorGLTest::constructUniformBuffers
 }
 #endif
 
+template<UnsignedInt dimensions> void VertexColorGLTest::constructAsync() {
+    setTestCaseTemplateName(Utility::format("{}", dimensions));
+
+    typename VertexColorGL<dimensions>::CompileState state = VertexColorGL<dimensions>::compile(VertexColorGL2D::Flags{});
+    CORRADE_COMPARE(state.flags(), VertexColorGL2D::Flags{});
+
+    while(!state.isLinkFinished())
+        Utility::System::sleep(100);
+
+    VertexColorGL<dimensions> shader{std::move(state)};
+    CORRADE_COMPARE(shader.flags(), VertexColorGL2D::Flags{});
+    CORRADE_VERIFY(shader.id());
+    {
+        #if defined(CORRADE_TARGET_APPLE) && !defined(MAGNUM_TARGET_GLES)
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+template<UnsignedInt dimensions> void VertexColorGLTest::constructUniformBuffersAsync() {
+    setTestCaseTemplateName(Utility::format("{}", dimensions));
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() << "is not supported.");
+    #endif
+
+    typename VertexColorGL<dimensions>::CompileState state = VertexColorGL<dimensions>::compile(VertexColorGL2D::Flag::UniformBuffers, 5);
+    CORRADE_COMPARE(state.flags(), VertexColorGL2D::Flag::UniformBuffers);
+    CORRADE_COMPARE(state.drawCount(), 5);
+
+    while(!state.isLinkFinished())
+        Utility::System::sleep(100);
+
+    VertexColorGL<dimensions> shader{std::move(state)};
+    CORRADE_COMPARE(shader.flags(), VertexColorGL2D::Flag::UniformBuffers);
+    CORRADE_COMPARE(shader.drawCount(), 5);
+    CORRADE_VERIFY(shader.id());
+    {
+        #if defined(CORRADE_TARGET_APPLE) && !defined(MAGNUM_TARGET_GLES)
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+#endif
+
 template<UnsignedInt dimensions> void VertexColorGLTest::constructMove() {
     setTestCaseTemplateName(Utility::format("{}", dimensions));
 
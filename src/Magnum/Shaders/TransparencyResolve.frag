@@ -0,0 +1,57 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/* Uniforms */
+
+#ifdef EXPLICIT_BINDING
+layout(binding = 0)
+#endif
+uniform highp sampler2D accumulationTexture;
+
+#ifdef EXPLICIT_BINDING
+layout(binding = 1)
+#endif
+uniform lowp sampler2D revealageTexture;
+
+/* Outputs */
+
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = COLOR_OUTPUT_ATTRIBUTE_LOCATION)
+#endif
+out lowp vec4 fragmentColor;
+
+void main() {
+    ivec2 coordinates = ivec2(gl_FragCoord.xy);
+
+    /* If nothing transparent was drawn here, the revealage stays at its
+       clear value and there's nothing to composite */
+    lowp float revealage = texelFetch(revealageTexture, coordinates, 0).r;
+    if(revealage == 1.0) discard;
+
+    /* Equation (6) of http://jcgt.org/published/0002/02/09/, the clamp
+       prevents overflow to infinity and division by zero */
+    highp vec4 accumulation = texelFetch(accumulationTexture, coordinates, 0);
+    fragmentColor = vec4(accumulation.rgb/clamp(accumulation.a, 1.0e-4, 5.0e4), 1.0 - revealage);
+}
@@ -0,0 +1,147 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "TransparencyResolveGL.h"
+
+#include <Corrade/Containers/Reference.h>
+#include <Corrade/Utility/Resource.h>
+
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/Texture.h"
+#include "Magnum/Shaders/GenericGL.h"
+
+#include "Magnum/Shaders/Implementation/CreateCompatibilityShader.h"
+
+namespace Magnum { namespace Shaders {
+
+namespace {
+    enum: Int {
+        AccumulationTextureUnit = 0,
+        RevealageTextureUnit = 1
+    };
+}
+
+TransparencyResolveGL::CompileState TransparencyResolveGL::compile() {
+    #ifndef MAGNUM_TARGET_GLES
+    MAGNUM_ASSERT_GL_VERSION_SUPPORTED(GL::Version::GL300);
+    #endif
+
+    #ifdef MAGNUM_BUILD_STATIC
+    /* Import resources on static build, if not already */
+    if(!Utility::Resource::hasGroup("MagnumShadersGL"))
+        importShaderResources();
+    #endif
+    Utility::Resource rs("MagnumShadersGL");
+
+    const GL::Context& context = GL::Context::current();
+
+    #ifndef MAGNUM_TARGET_GLES
+    const GL::Version version = context.supportedVersion({GL::Version::GL320, GL::Version::GL310, GL::Version::GL300});
+    #else
+    const GL::Version version = GL::Version::GLES300;
+    #endif
+
+    GL::Shader vert = Implementation::createCompatibilityShader(rs, version, GL::Shader::Type::Vertex);
+    GL::Shader frag = Implementation::createCompatibilityShader(rs, version, GL::Shader::Type::Fragment);
+
+    vert.addSource(rs.getString("FullScreenTriangle.glsl"))
+        .addSource(rs.getString("TransparencyResolve.vert"));
+    frag.addSource(rs.getString("generic.glsl"))
+        .addSource(rs.getString("TransparencyResolve.frag"));
+
+    TransparencyResolveGL out{NoInit};
+
+    /* If a matching program binary is cached, there's nothing to compile
+       or link */
+    #ifndef MAGNUM_TARGET_WEBGL
+    const bool cached = out.loadCachedBinary({vert, frag});
+    #else
+    const bool cached = false;
+    #endif
+    if(!cached) {
+        vert.submitCompile();
+        frag.submitCompile();
+
+        out.attachShaders({vert, frag});
+
+        /* Without gl_VertexID the triangle is taken from an attribute, see
+           MeshTools::fullScreenTriangle() */
+        if(!context.isExtensionSupported<GL::Extensions::MAGNUM::shader_vertex_id>(version))
+            out.bindAttributeLocation(GenericGL2D::Position::Location, "position");
+
+        /* ES3 has this done in the shader directly and doesn't even provide
+           bindFragmentDataLocation() */
+        #ifndef MAGNUM_TARGET_GLES
+        if(!context.isExtensionSupported<GL::Extensions::ARB::explicit_attrib_location>(version))
+            out.bindFragmentDataLocation(GenericGL2D::ColorOutput, "fragmentColor");
+        #endif
+
+        out.submitLink();
+    }
+
+    return CompileState{std::move(out), std::move(vert), std::move(frag), version, cached};
+}
+
+TransparencyResolveGL::TransparencyResolveGL(CompileState&& state): TransparencyResolveGL{static_cast<TransparencyResolveGL&&>(std::move(state))} {
+    #ifdef CORRADE_GRACEFUL_ASSERT
+    /* When graceful assertions fire from within compile(), we get a
+       NoCreate'd CompileState. Exiting makes it possible to test the
+       assert. */
+    if(!id()) return;
+    #endif
+
+    /* If the program was loaded from the binary cache, there's nothing to
+       check */
+    if(!state._cached) {
+        CORRADE_INTERNAL_ASSERT_OUTPUT(state._vert.checkCompile() && state._frag.checkCompile());
+        CORRADE_INTERNAL_ASSERT_OUTPUT(checkLink());
+        #ifndef MAGNUM_TARGET_WEBGL
+        saveCachedBinary({state._vert, state._frag});
+        #endif
+    }
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::shading_language_420pack>(state._version))
+    #endif
+    {
+        setUniform(uniformLocation("accumulationTexture"), AccumulationTextureUnit);
+        setUniform(uniformLocation("revealageTexture"), RevealageTextureUnit);
+    }
+}
+
+TransparencyResolveGL::TransparencyResolveGL(): TransparencyResolveGL{compile()} {}
+
+TransparencyResolveGL& TransparencyResolveGL::bindAccumulationTexture(GL::Texture2D& texture) {
+    texture.bind(AccumulationTextureUnit);
+    return *this;
+}
+
+TransparencyResolveGL& TransparencyResolveGL::bindRevealageTexture(GL::Texture2D& texture) {
+    texture.bind(RevealageTextureUnit);
+    return *this;
+}
+
+}}
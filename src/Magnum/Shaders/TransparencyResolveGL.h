@@ -0,0 +1,210 @@
+#ifndef Magnum_Shaders_TransparencyResolveGL_h
+#define Magnum_Shaders_TransparencyResolveGL_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MAGNUM_TARGET_GLES2
+/** @file
+ * @brief Class @ref Magnum::Shaders::TransparencyResolveGL
+ * @m_since_latest
+ */
+#endif
+
+#include "Magnum/GL/AbstractShaderProgram.h"
+#include "Magnum/GL/Shader.h"
+#include "Magnum/GL/Version.h"
+#include "Magnum/Shaders/visibility.h"
+
+#ifndef MAGNUM_TARGET_GLES2
+namespace Magnum { namespace Shaders {
+
+/**
+@brief Weighted blended order-independent transparency resolve OpenGL shader
+@m_since_latest
+
+Composites transparent geometry drawn with
+@ref FlatGL::Flag::OrderIndependentTransparency or
+@ref PhongGL::Flag::OrderIndependentTransparency over the opaque geometry.
+Compared to regular alpha blending, the transparent objects don't need to be
+sorted back to front, removing both the per-frame sort and the need to draw
+each transparent object separately.
+
+@section Shaders-TransparencyResolveGL-usage Usage
+
+Draw the opaque geometry first. Then, with depth test enabled against the
+opaque depth buffer but depth writes disabled, draw the transparent geometry
+into two additional attachments --- an accumulation attachment with a
+four-component floating-point format such as
+@ref GL::TextureFormat::RGBA16F bound to the
+@relativeref{FlatGL,ColorOutput}, cleared to @cpp 0.0f @ce, and a revealage
+attachment with a single-component format such as
+@ref GL::TextureFormat::R8 bound to the @relativeref{FlatGL,RevealageOutput},
+cleared to @cpp 1.0f @ce. The accumulation attachment is blended with
+@ref GL::Renderer::BlendFunction::One for both the source and destination and
+the revealage attachment with @ref GL::Renderer::BlendFunction::Zero for the
+source and @relativeref{GL::Renderer::BlendFunction,OneMinusSourceColor} for
+the destination. Finally, bind both attachments with
+@ref bindAccumulationTexture() and @ref bindRevealageTexture() and draw a
+@ref MeshTools::fullScreenTriangle() over the opaque image with regular
+@ref GL::Renderer::BlendFunction::SourceAlpha and
+@relativeref{GL::Renderer::BlendFunction,OneMinusSourceAlpha} blending:
+
+@snippet MagnumShaders-gl.cpp TransparencyResolveGL-usage
+
+The attachments are expected to have the same size as the framebuffer the
+resolve is drawn into. Pixels with no transparent geometry are discarded.
+
+@requires_gl30 Extension @gl_extension{ARB,texture_float} for the
+    accumulation attachment
+@requires_gl40 Extension @gl_extension{ARB,draw_buffers_blend} for setting a
+    different blend function for each attachment
+@requires_gles30 Floating-point render targets are not available in OpenGL
+    ES 2.0.
+@requires_gles32 Extension @gl_extension{EXT,color_buffer_half_float} and
+    @gl_extension{EXT,draw_buffers_indexed}
+@requires_webgl20 Floating-point render targets are not available in WebGL
+    1.0.
+@requires_webgl_extension Extension @webgl_extension{EXT,color_buffer_float}
+    and @webgl_extension{EXT,draw_buffers_indexed}
+*/
+class MAGNUM_SHADERS_EXPORT TransparencyResolveGL: public GL::AbstractShaderProgram {
+    public:
+        class CompileState;
+
+        /**
+         * @brief Compile asynchronously
+         *
+         * Compared to @ref TransparencyResolveGL() can perform an
+         * asynchronous compilation and linking. See @ref shaders-async for
+         * more information.
+         * @see @ref TransparencyResolveGL(CompileState&&)
+         */
+        static CompileState compile();
+
+        /** @brief Constructor */
+        explicit TransparencyResolveGL();
+
+        /**
+         * @brief Finalize an asynchronous compilation
+         *
+         * Takes an asynchronous compilation state returned by @ref compile()
+         * and forms a ready-to-use shader object. See @ref shaders-async for
+         * more information.
+         */
+        explicit TransparencyResolveGL(CompileState&& state);
+
+        /**
+         * @brief Construct without creating the underlying OpenGL object
+         *
+         * The constructed instance is equivalent to a moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         *
+         * This function can be safely used for constructing (and later
+         * destructing) objects even without any OpenGL context being active.
+         * However note that this is a low-level and a potentially dangerous
+         * API, see the documentation of @ref NoCreate for alternatives.
+         */
+        explicit TransparencyResolveGL(NoCreateT) noexcept: AbstractShaderProgram{NoCreate} {}
+
+        /** @brief Copying is not allowed */
+        TransparencyResolveGL(const TransparencyResolveGL&) = delete;
+
+        /** @brief Move constructor */
+        TransparencyResolveGL(TransparencyResolveGL&&) noexcept = default;
+
+        /** @brief Copying is not allowed */
+        TransparencyResolveGL& operator=(const TransparencyResolveGL&) = delete;
+
+        /** @brief Move assignment */
+        TransparencyResolveGL& operator=(TransparencyResolveGL&&) noexcept = default;
+
+        /** @{
+         * @name Texture binding
+         */
+
+        /**
+         * @brief Bind an accumulation texture
+         * @return Reference to self (for method chaining)
+         *
+         * Expected to contain the accumulated
+         * @relativeref{FlatGL,ColorOutput} of transparent geometry. See
+         * @ref Shaders-TransparencyResolveGL-usage for more information.
+         */
+        TransparencyResolveGL& bindAccumulationTexture(GL::Texture2D& texture);
+
+        /**
+         * @brief Bind a revealage texture
+         * @return Reference to self (for method chaining)
+         *
+         * Expected to contain the multiplied
+         * @relativeref{FlatGL,RevealageOutput} of transparent geometry. See
+         * @ref Shaders-TransparencyResolveGL-usage for more information.
+         */
+        TransparencyResolveGL& bindRevealageTexture(GL::Texture2D& texture);
+
+        /**
+         * @}
+         */
+
+    private:
+        /* Creates the GL shader program object but does nothing else.
+           Internal, used by compile(). */
+        explicit TransparencyResolveGL(NoInitT) {}
+
+        /* Prevent accidentally calling irrelevant functions */
+        #ifndef MAGNUM_TARGET_GLES
+        using GL::AbstractShaderProgram::drawTransformFeedback;
+        #endif
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        using GL::AbstractShaderProgram::dispatchCompute;
+        #endif
+};
+
+/**
+@brief Asynchronous compilation state
+@m_since_latest
+
+Returned by @ref compile(). See @ref shaders-async for more information.
+*/
+class TransparencyResolveGL::CompileState: public TransparencyResolveGL {
+    /* Everything deliberately private except for the inheritance */
+    friend class TransparencyResolveGL;
+
+    explicit CompileState(NoCreateT): TransparencyResolveGL{NoCreate}, _vert{NoCreate}, _frag{NoCreate} {}
+
+    explicit CompileState(TransparencyResolveGL&& shader, GL::Shader&& vert, GL::Shader&& frag, GL::Version version, bool cached): TransparencyResolveGL{std::move(shader)}, _vert{std::move(vert)}, _frag{std::move(frag)}, _version{version}, _cached{cached} {}
+
+    GL::Shader _vert, _frag;
+    GL::Version _version;
+    bool _cached;
+};
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 build
+#endif
+
+#endif
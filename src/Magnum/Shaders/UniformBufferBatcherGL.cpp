@@ -0,0 +1,197 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "UniformBufferBatcherGL.h"
+
+#include <cstring>
+#include <unordered_map>
+#include <Corrade/Containers/GrowableArray.h>
+
+#include "Magnum/GL/Buffer.h"
+#include "Magnum/GL/Mesh.h"
+
+namespace Magnum { namespace Shaders {
+
+namespace {
+
+struct Window {
+    GL::AbstractShaderProgram* shader;
+    bool phong;
+    UnsignedInt count;
+    UnsignedInt capacity;
+    std::size_t transformationOffset;
+    std::size_t transformationSize;
+    std::size_t drawOffset;
+    std::size_t drawSize;
+};
+
+struct Draw {
+    GL::Mesh* mesh;
+    UnsignedInt window;
+    UnsignedInt offset;
+};
+
+}
+
+struct UniformBufferBatcherGL::State {
+    explicit State(GL::Buffer&& buffer, std::size_t alignment): buffer{std::move(buffer)}, alignment{alignment} {}
+
+    GL::Buffer buffer;
+    std::size_t alignment;
+    /* Size the buffer storage was last allocated with. If the data fit,
+       they're uploaded with setSubData() instead of reallocating. */
+    std::size_t bufferSize{};
+
+    /* The last window of each shader, new draws are added to it until it's
+       full */
+    std::unordered_map<GL::AbstractShaderProgram*, UnsignedInt> windowIds;
+    Containers::Array<Window> windows;
+    Containers::Array<Draw> draws;
+    Containers::Array<char> data;
+};
+
+UniformBufferBatcherGL::UniformBufferBatcherGL(): _state{InPlaceInit, GL::Buffer{GL::Buffer::TargetHint::Uniform}, std::size_t(GL::Buffer::uniformOffsetAlignment())} {}
+
+UniformBufferBatcherGL::UniformBufferBatcherGL(NoCreateT): _state{InPlaceInit, GL::Buffer{NoCreate}, std::size_t{1}} {}
+
+UniformBufferBatcherGL::UniformBufferBatcherGL(UniformBufferBatcherGL&&) noexcept = default;
+
+UniformBufferBatcherGL::~UniformBufferBatcherGL() = default;
+
+UniformBufferBatcherGL& UniformBufferBatcherGL::operator=(UniformBufferBatcherGL&&) noexcept = default;
+
+GL::Buffer& UniformBufferBatcherGL::uniformBuffer() { return _state->buffer; }
+
+std::size_t UniformBufferBatcherGL::drawCount() const {
+    return _state->draws.size();
+}
+
+std::size_t UniformBufferBatcherGL::dataSize() const {
+    return _state->data.size();
+}
+
+UniformBufferBatcherGL& UniformBufferBatcherGL::add(PhongGL& shader, GL::Mesh& mesh, const TransformationUniform3D& transformation, const PhongDrawUniform& draw) {
+    CORRADE_ASSERT(shader.flags() & PhongGL::Flag::UniformBuffers,
+        "Shaders::UniformBufferBatcherGL::add(): the shader wasn't created with uniform buffers", *this);
+    CORRADE_ASSERT(!(shader.flags() & PhongGL::Flag::TextureTransformation),
+        "Shaders::UniformBufferBatcherGL::add(): shaders with texture transformation are not supported", *this);
+    addInternal(shader, true, mesh, shader.drawCount(), &transformation, sizeof(TransformationUniform3D), &draw, sizeof(PhongDrawUniform));
+    return *this;
+}
+
+UniformBufferBatcherGL& UniformBufferBatcherGL::add(FlatGL3D& shader, GL::Mesh& mesh, const TransformationProjectionUniform3D& transformationProjection, const FlatDrawUniform& draw) {
+    CORRADE_ASSERT(shader.flags() & FlatGL3D::Flag::UniformBuffers,
+        "Shaders::UniformBufferBatcherGL::add(): the shader wasn't created with uniform buffers", *this);
+    CORRADE_ASSERT(!(shader.flags() & FlatGL3D::Flag::TextureTransformation),
+        "Shaders::UniformBufferBatcherGL::add(): shaders with texture transformation are not supported", *this);
+    addInternal(shader, false, mesh, shader.drawCount(), &transformationProjection, sizeof(TransformationProjectionUniform3D), &draw, sizeof(FlatDrawUniform));
+    return *this;
+}
+
+void UniformBufferBatcherGL::addInternal(GL::AbstractShaderProgram& shader, const bool phong, GL::Mesh& mesh, const UnsignedInt drawCount, const void* const transformation, const std::size_t transformationSize, const void* const draw, const std::size_t drawSize) {
+    State& state = *_state;
+
+    /* Open a new window if this shader wasn't seen yet or if its last window
+       is full. The whole window is reserved upfront so the ranges bound in
+       flush() have the size the shader expects, the unused part stays
+       zero-initialized. */
+    const auto found = state.windowIds.find(&shader);
+    UnsignedInt windowId;
+    if(found != state.windowIds.end() && state.windows[found->second].count != state.windows[found->second].capacity) {
+        windowId = found->second;
+    } else {
+        const auto aligned = [&](std::size_t size) {
+            return (size + state.alignment - 1)/state.alignment*state.alignment;
+        };
+
+        Window window;
+        window.shader = &shader;
+        window.phong = phong;
+        window.count = 0;
+        window.capacity = drawCount;
+        window.transformationOffset = state.data.size();
+        window.transformationSize = drawCount*transformationSize;
+        window.drawOffset = window.transformationOffset + aligned(window.transformationSize);
+        window.drawSize = drawCount*drawSize;
+        arrayResize(state.data, ValueInit, state.data.size() + aligned(window.transformationSize) + aligned(window.drawSize));
+
+        windowId = state.windows.size();
+        state.windowIds[&shader] = windowId;
+        arrayAppend(state.windows, window);
+    }
+
+    Window& window = state.windows[windowId];
+    std::memcpy(state.data + window.transformationOffset + window.count*transformationSize, transformation, transformationSize);
+    std::memcpy(state.data + window.drawOffset + window.count*drawSize, draw, drawSize);
+    arrayAppend(state.draws, Draw{&mesh, windowId, window.count});
+    ++window.count;
+}
+
+UnsignedInt UniformBufferBatcherGL::flush() {
+    State& state = *_state;
+    CORRADE_ASSERT(state.buffer.id(),
+        "Shaders::UniformBufferBatcherGL::flush(): the batcher was constructed with NoCreate", {});
+
+    if(state.draws.isEmpty()) return 0;
+
+    /* Upload everything at once. Reallocate the storage only if it's not
+       large enough, otherwise just replace the contents. */
+    if(state.data.size() > state.bufferSize) {
+        state.buffer.setData(state.data, GL::BufferUsage::StreamDraw);
+        state.bufferSize = state.data.size();
+    } else state.buffer.setSubData(0, state.data);
+
+    /* The buffer binds are skipped by GL::Buffer if the same range is already
+       bound, so consecutive draws from the same window only update the draw
+       offset */
+    for(const Draw& draw: state.draws) {
+        const Window& window = state.windows[draw.window];
+        if(window.phong) static_cast<PhongGL&>(*window.shader)
+            .bindTransformationBuffer(state.buffer, window.transformationOffset, window.transformationSize)
+            .bindDrawBuffer(state.buffer, window.drawOffset, window.drawSize)
+            .setDrawOffset(draw.offset)
+            .draw(*draw.mesh);
+        else static_cast<FlatGL3D&>(*window.shader)
+            .bindTransformationProjectionBuffer(state.buffer, window.transformationOffset, window.transformationSize)
+            .bindDrawBuffer(state.buffer, window.drawOffset, window.drawSize)
+            .setDrawOffset(draw.offset)
+            .draw(*draw.mesh);
+    }
+
+    const UnsignedInt drawCount = state.draws.size();
+    clear();
+    return drawCount;
+}
+
+UniformBufferBatcherGL& UniformBufferBatcherGL::clear() {
+    State& state = *_state;
+    state.windowIds.clear();
+    arrayResize(state.windows, NoInit, 0);
+    arrayResize(state.draws, NoInit, 0);
+    arrayResize(state.data, NoInit, 0);
+    return *this;
+}
+
+}}
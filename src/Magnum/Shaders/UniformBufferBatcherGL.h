@@ -0,0 +1,213 @@
+#ifndef Magnum_Shaders_UniformBufferBatcherGL_h
+#define Magnum_Shaders_UniformBufferBatcherGL_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MAGNUM_TARGET_GLES2
+/** @file
+ * @brief Class @ref Magnum::Shaders::UniformBufferBatcherGL
+ * @m_since_latest
+ */
+#endif
+
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Shaders/Flat.h"
+#include "Magnum/Shaders/FlatGL.h"
+#include "Magnum/Shaders/Generic.h"
+#include "Magnum/Shaders/Phong.h"
+#include "Magnum/Shaders/PhongGL.h"
+
+#ifndef MAGNUM_TARGET_GLES2
+namespace Magnum { namespace Shaders {
+
+/**
+@brief Uniform buffer draw batcher
+@m_since_latest
+
+Collects per-draw uniforms of many objects drawn with
+@ref PhongGL::Flag::UniformBuffers or @ref FlatGL::Flag::UniformBuffers
+shaders, uploads all of them to a single buffer with one call and then draws
+the objects one after another, only changing the draw offset and binding
+a different range of the buffer once every @ref PhongGL::drawCount() draws.
+Compared to setting the uniforms on each draw, which on WebGL means a
+validated JavaScript call for every uniform, this reduces the per-draw
+overhead to a single uniform update and a draw call.
+
+@section Shaders-UniformBufferBatcherGL-usage Usage
+
+Instead of setting the transformation and per-draw uniforms and drawing
+directly, call @ref add() with a shader, mesh and the uniforms. The shaders are
+expected to be created with the @relativeref{PhongGL,Flag::UniformBuffers}
+flag. Other uniform buffers --- @ref PhongGL::bindProjectionBuffer() "projection",
+@ref PhongGL::bindMaterialBuffer() "material" and
+@ref PhongGL::bindLightBuffer() "light" buffers --- are expected to be bound
+by the application. Finally, @ref flush() uploads the collected uniforms and
+draws all meshes in the order in which they were added.
+
+@snippet MagnumShaders-gl.cpp UniformBufferBatcherGL-usage
+
+@section Shaders-UniformBufferBatcherGL-layout Buffer layout
+
+The draws are split into windows of @ref PhongGL::drawCount() "drawCount()"
+consecutive draws of the same shader. Each window consists of an array of
+@ref TransformationUniform3D or @ref TransformationProjectionUniform3D
+followed by an array of @ref PhongDrawUniform or @ref FlatDrawUniform, both
+with @ref PhongGL::drawCount() "drawCount()" items and both aligned to
+@ref GL::Buffer::uniformOffsetAlignment(). When drawing, the two arrays of
+given window are bound with @ref PhongGL::bindTransformationBuffer(GL::Buffer&, GLintptr, GLsizeiptr) "bindTransformationBuffer()"
+and @ref PhongGL::bindDrawBuffer(GL::Buffer&, GLintptr, GLsizeiptr) "bindDrawBuffer()"
+and the position of the draw inside the window is passed to
+@ref PhongGL::setDrawOffset(). As @ref GL::Buffer tracks uniform buffer
+bindings, draws of different shaders can be interleaved without the ranges
+being rebound on every draw, as long as each shader has a distinct binding
+for its buffers.
+
+@section Shaders-UniformBufferBatcherGL-limitations Limitations
+
+Shaders with @relativeref{PhongGL,Flag::TextureTransformation} are not
+supported, as the texture transformation buffer would need to be indexed by
+the draw offset as well. The batcher doesn't sort the draws in any way, for
+grouping of draws with the same mesh and material into instanced draws see
+@ref InstanceBatcherGL.
+*/
+class MAGNUM_SHADERS_EXPORT UniformBufferBatcherGL {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * Creates the uniform buffer and queries
+         * @ref GL::Buffer::uniformOffsetAlignment().
+         */
+        explicit UniformBufferBatcherGL();
+
+        /**
+         * @brief Construct without creating the uniform buffer
+         *
+         * Draws can be still added to it, but @ref flush() can't be called.
+         * This function can be safely used for constructing (and later
+         * destructing) objects even without any OpenGL context being active.
+         */
+        explicit UniformBufferBatcherGL(NoCreateT);
+
+        /** @brief Copying is not allowed */
+        UniformBufferBatcherGL(const UniformBufferBatcherGL&) = delete;
+
+        /** @brief Move constructor */
+        UniformBufferBatcherGL(UniformBufferBatcherGL&&) noexcept;
+
+        ~UniformBufferBatcherGL();
+
+        /** @brief Copying is not allowed */
+        UniformBufferBatcherGL& operator=(const UniformBufferBatcherGL&) = delete;
+
+        /** @brief Move assignment */
+        UniformBufferBatcherGL& operator=(UniformBufferBatcherGL&&) noexcept;
+
+        /**
+         * @brief Uniform buffer
+         *
+         * Contains data uploaded by the last @ref flush(), in a layout
+         * described in @ref Shaders-UniformBufferBatcherGL-layout.
+         */
+        GL::Buffer& uniformBuffer();
+
+        /** @brief Count of draws added since the last @ref flush() */
+        std::size_t drawCount() const;
+
+        /**
+         * @brief Size of uniform data added since the last @ref flush()
+         *
+         * In bytes, including alignment padding. Equal to size of the data
+         * the next @ref flush() will upload.
+         */
+        std::size_t dataSize() const;
+
+        /**
+         * @brief Add a Phong draw
+         * @param shader            Shader to draw with
+         * @param mesh              Mesh to draw
+         * @param transformation    Transformation uniform
+         * @param draw              Per-draw uniform
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @p shader was created with
+         * @ref PhongGL::Flag::UniformBuffers and without
+         * @ref PhongGL::Flag::TextureTransformation. The shader and the mesh
+         * are expected to stay alive until the next @ref flush().
+         */
+        UniformBufferBatcherGL& add(PhongGL& shader, GL::Mesh& mesh, const TransformationUniform3D& transformation, const PhongDrawUniform& draw);
+
+        /**
+         * @brief Add a flat draw
+         * @param shader                    Shader to draw with
+         * @param mesh                      Mesh to draw
+         * @param transformationProjection  Transformation and projection
+         *      uniform
+         * @param draw                      Per-draw uniform
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @p shader was created with
+         * @ref FlatGL::Flag::UniformBuffers and without
+         * @ref FlatGL::Flag::TextureTransformation. The shader and the mesh
+         * are expected to stay alive until the next @ref flush().
+         */
+        UniformBufferBatcherGL& add(FlatGL3D& shader, GL::Mesh& mesh, const TransformationProjectionUniform3D& transformationProjection, const FlatDrawUniform& draw);
+
+        /**
+         * @brief Draw everything
+         * @return Count of draw calls submitted
+         *
+         * Uploads all uniforms with a single buffer update and draws the
+         * meshes in the order they were added, binding the corresponding
+         * buffer ranges and setting @ref PhongGL::setDrawOffset() or
+         * @ref FlatGL::setDrawOffset() before each. Clears all added draws
+         * afterwards.
+         */
+        UnsignedInt flush();
+
+        /**
+         * @brief Clear all added draws
+         * @return Reference to self (for method chaining)
+         *
+         * Discards everything added since the last @ref flush() without
+         * drawing anything.
+         */
+        UniformBufferBatcherGL& clear();
+
+    private:
+        struct State;
+
+        MAGNUM_SHADERS_LOCAL void addInternal(GL::AbstractShaderProgram& shader, bool phong, GL::Mesh& mesh, UnsignedInt drawCount, const void* transformation, std::size_t transformationSize, const void* draw, std::size_t drawSize);
+
+        Containers::Pointer<State> _state;
+};
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 and WebGL 1.0 build
+#endif
+
+#endif
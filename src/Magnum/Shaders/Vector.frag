@@ -108,6 +108,10 @@ uniform lowp sampler2D vectorTexture;
 
 in mediump vec2 interpolatedTextureCoordinates;
 
+#ifdef INSTANCED_GLYPHS
+in lowp vec4 interpolatedColor;
+#endif
+
 #ifdef MULTI_DRAW
 flat in highp uint drawId;
 #endif
@@ -133,5 +137,9 @@ void main() {
     #endif
 
     lowp float intensity = texture(vectorTexture, interpolatedTextureCoordinates).r;
-    fragmentColor = mix(backgroundColor, color, intensity);
+    fragmentColor = mix(backgroundColor, color
+        #ifdef INSTANCED_GLYPHS
+        *interpolatedColor
+        #endif
+        , intensity);
 }
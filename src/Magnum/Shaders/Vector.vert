@@ -124,8 +124,18 @@ layout(std140
 #endif
 #endif
 
+/* Textures */
+
+#ifdef INSTANCED_GLYPHS
+#ifdef EXPLICIT_BINDING
+layout(binding = 7)
+#endif
+uniform highp sampler2D glyphRectangleTexture;
+#endif
+
 /* Inputs */
 
+#ifndef INSTANCED_GLYPHS
 #ifdef EXPLICIT_ATTRIB_LOCATION
 layout(location = POSITION_ATTRIBUTE_LOCATION)
 #endif
@@ -141,11 +151,31 @@ in highp vec4 position;
 layout(location = TEXTURECOORDINATES_ATTRIBUTE_LOCATION)
 #endif
 in mediump vec2 textureCoordinates;
+#else
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = TEXTURE_OFFSET_ATTRIBUTE_LOCATION)
+#endif
+in highp vec3 glyphOffsetScale;
+
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = OBJECT_ID_ATTRIBUTE_LOCATION)
+#endif
+in highp uint glyphId;
+
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = COLOR_ATTRIBUTE_LOCATION)
+#endif
+in lowp vec4 glyphColor;
+#endif
 
 /* Outputs */
 
 out mediump vec2 interpolatedTextureCoordinates;
 
+#ifdef INSTANCED_GLYPHS
+out lowp vec4 interpolatedColor;
+#endif
+
 #ifdef MULTI_DRAW
 flat out highp uint drawId;
 #endif
@@ -176,6 +206,27 @@ void main() {
     #endif
     #endif
 
+    #ifdef INSTANCED_GLYPHS
+    /* Each instance is a triangle strip with four vertices, expanded from the
+       glyph rectangle: 0 = bottom left, 1 = bottom right, 2 = top left,
+       3 = top right. The first texel of a row contains the glyph quad
+       relative to the cursor in glyph cache units, the second its texture
+       coordinates. */
+    highp const vec2 corner = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1));
+    highp const vec4 glyphQuad = texelFetch(glyphRectangleTexture, ivec2(0, int(glyphId)), 0);
+    mediump const vec4 glyphTextureCoordinates = texelFetch(glyphRectangleTexture, ivec2(1, int(glyphId)), 0);
+    highp const vec2 glyphPosition = glyphOffsetScale.xy + glyphOffsetScale.z*mix(glyphQuad.xy, glyphQuad.zw, corner);
+    #ifdef TWO_DIMENSIONS
+    highp const vec2 position = glyphPosition;
+    #elif defined(THREE_DIMENSIONS)
+    highp const vec4 position = vec4(glyphPosition, 0.0, 1.0);
+    #else
+    #error
+    #endif
+    mediump const vec2 textureCoordinates = mix(glyphTextureCoordinates.xy, glyphTextureCoordinates.zw, corner);
+    interpolatedColor = glyphColor;
+    #endif
+
     #ifdef TWO_DIMENSIONS
     gl_Position.xywz = vec4(transformationProjectionMatrix*vec3(position, 1.0), 0.0);
     #elif defined(THREE_DIMENSIONS)
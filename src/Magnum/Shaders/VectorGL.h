@@ -32,6 +32,7 @@
 
 #include "Magnum/DimensionTraits.h"
 #include "Magnum/GL/AbstractShaderProgram.h"
+#include "Magnum/GL/Shader.h"
 #include "Magnum/Shaders/GenericGL.h"
 #include "Magnum/Shaders/visibility.h"
 
@@ -42,7 +43,8 @@ namespace Implementation {
         TextureTransformation = 1 << 0,
         #ifndef MAGNUM_TARGET_GLES2
         UniformBuffers = 1 << 1,
-        MultiDraw = UniformBuffers|(1 << 2)
+        MultiDraw = UniformBuffers|(1 << 2),
+        InstancedGlyphs = 1 << 3
         #endif
     };
     typedef Containers::EnumSet<VectorGLFlag> VectorGLFlags;
@@ -111,6 +113,29 @@ example.
 @requires_webgl_extension Extension @webgl_extension{ANGLE,multi_draw} for
     multidraw.
 
+@section Shaders-VectorGL-instanced-glyphs Instanced glyph rendering
+
+With @ref Flag::InstancedGlyphs enabled, the shader doesn't use the
+@ref Position and @ref TextureCoordinates attributes. Instead, every instance
+is a single glyph described by a @ref GlyphOffsetScale, @ref GlyphId and
+@ref GlyphColor, which is expanded to a quad in the vertex shader from a
+four-vertex @ref GL::MeshPrimitive::TriangleStrip. The quad and texture
+coordinates of each glyph are fetched from a texture bound with
+@ref bindGlyphRectangleTexture(), which has two
+@ref GL::TextureFormat::RGBA32F texels in each row --- the first is the quad
+relative to the cursor in the cache pixel units, the second the texture
+coordinates, both as minimal and maximal X and Y. The glyph color is
+multiplied with @ref setColor(). Such mesh and texture is produced by
+@ref Text::InstancedRenderer, which makes the text vertex data about four
+times smaller compared to @ref Text::Renderer.
+
+@requires_gl30 Extension @gl_extension{EXT,gpu_shader4} for instanced
+    glyphs.
+@requires_gl33 Extension @gl_extension{ARB,instanced_arrays} for instanced
+    glyphs.
+@requires_gles30 Instanced glyphs are not available in OpenGL ES 2.0.
+@requires_webgl20 Instanced glyphs are not available in WebGL 1.0.
+
 @see @ref shaders, @ref VectorGL2D, @ref VectorGL3D
 */
 template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT VectorGL: public GL::AbstractShaderProgram {
@@ -132,6 +157,52 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT VectorGL: public GL
          */
         typedef typename GenericGL<dimensions>::TextureCoordinates TextureCoordinates;
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Glyph offset and scale
+         * @m_since_latest
+         *
+         * @ref Magnum::Vector3 "Vector3", with the first two components
+         * being the glyph origin and the third a scale applied to the glyph
+         * quad. Per-instance, used only if @ref Flag::InstancedGlyphs is set.
+         * Shares the location with @ref GenericGL::TextureOffsetLayer.
+         * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+         * @requires_gles30 Instanced glyphs are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Instanced glyphs are not available in WebGL 1.0.
+         */
+        typedef GL::Attribute<GenericGL<dimensions>::TextureOffsetLayer::Location, Vector3> GlyphOffsetScale;
+
+        /**
+         * @brief Glyph ID
+         * @m_since_latest
+         *
+         * @ref Magnum::UnsignedInt "UnsignedInt", row of the texture bound
+         * with @ref bindGlyphRectangleTexture(). Per-instance, used only if
+         * @ref Flag::InstancedGlyphs is set. Shares the location with
+         * @ref GenericGL::ObjectId.
+         * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+         * @requires_gles30 Instanced glyphs are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Instanced glyphs are not available in WebGL 1.0.
+         */
+        typedef GL::Attribute<GenericGL<dimensions>::ObjectId::Location, UnsignedInt> GlyphId;
+
+        /**
+         * @brief Glyph color
+         * @m_since_latest
+         *
+         * @ref Magnum::Color4 "Color4", multiplied with @ref setColor().
+         * Per-instance, used only if @ref Flag::InstancedGlyphs is set.
+         * Shares the location with @ref GenericGL::Color4.
+         * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+         * @requires_gles30 Instanced glyphs are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Instanced glyphs are not available in WebGL 1.0.
+         */
+        typedef typename GenericGL<dimensions>::Color4 GlyphColor;
+        #endif
+
         enum: UnsignedInt {
             /**
              * Color shader output. @ref shaders-generic "Generic output",
@@ -194,7 +265,24 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT VectorGL: public GL
              *      relies on uniform buffers, which require WebGL 2.0.
              * @m_since_latest
              */
-            MultiDraw = UniformBuffers|(1 << 2)
+            MultiDraw = UniformBuffers|(1 << 2),
+
+            /**
+             * Render instanced glyphs. Instead of @ref Position and
+             * @ref TextureCoordinates, expects a per-instance
+             * @ref GlyphOffsetScale, @ref GlyphId and @ref GlyphColor and
+             * glyph rectangles supplied via
+             * @ref bindGlyphRectangleTexture(). See
+             * @ref Shaders-VectorGL-instanced-glyphs for more information.
+             * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+             * @requires_gl33 Extension @gl_extension{ARB,instanced_arrays}
+             * @requires_gles30 Instanced glyphs are not available in OpenGL
+             *      ES 2.0.
+             * @requires_webgl20 Instanced glyphs are not available in WebGL
+             *      1.0.
+             * @m_since_latest
+             */
+            InstancedGlyphs = 1 << 3
             #endif
         };
 
@@ -212,6 +300,36 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT VectorGL: public GL
         typedef Implementation::VectorGLFlags Flags;
         #endif
 
+        class CompileState;
+
+        /**
+         * @brief Compile asynchronously
+         * @m_since_latest
+         *
+         * Compared to @ref VectorGL(Flags) can perform an asynchronous
+         * compilation and linking. See @ref shaders-async for more
+         * information.
+         * @see @ref VectorGL(CompileState&&),
+         *      @ref compile(Flags, UnsignedInt, UnsignedInt)
+         */
+        static CompileState compile(Flags flags = {});
+
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Compile for a multi-draw scenario asynchronously
+         * @m_since_latest
+         *
+         * Compared to @ref VectorGL(Flags, UnsignedInt, UnsignedInt) can perform an
+         * asynchronous compilation and linking. See @ref shaders-async for
+         * more information.
+         * @see @ref VectorGL(CompileState&&), @ref compile(Flags)
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        static CompileState compile(Flags flags, UnsignedInt materialCount, UnsignedInt drawCount);
+        #endif
+
         /**
          * @brief Constructor
          * @param flags     Flags
@@ -259,6 +377,16 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT VectorGL: public GL
         explicit VectorGL(Flags flags, UnsignedInt materialCount, UnsignedInt drawCount);
         #endif
 
+        /**
+         * @brief Finalize an asynchronous compilation
+         * @m_since_latest
+         *
+         * Takes an asynchronous compilation state returned by @ref compile()
+         * and forms a ready-to-use shader object. See @ref shaders-async for
+         * more information.
+         */
+        explicit VectorGL(CompileState&& state);
+
         /**
          * @brief Construct without creating the underlying OpenGL object
          *
@@ -516,6 +644,24 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT VectorGL: public GL
          */
         VectorGL<dimensions>& bindVectorTexture(GL::Texture2D& texture);
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Bind a glyph rectangle texture
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that the shader was created with
+         * @ref Flag::InstancedGlyphs enabled. See
+         * @ref Shaders-VectorGL-instanced-glyphs for the expected layout.
+         * @see @ref Text::InstancedRenderer::glyphRectangleTexture()
+         * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+         * @requires_gles30 Instanced glyphs are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Instanced glyphs are not available in WebGL 1.0.
+         */
+        VectorGL<dimensions>& bindGlyphRectangleTexture(GL::Texture2D& texture);
+        #endif
+
         /**
          * @}
          */
@@ -554,6 +700,10 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT VectorGL: public GL
         #endif
 
     private:
+        /* Creates the GL shader program object but does nothing else.
+           Internal, used by compile(). */
+        explicit VectorGL(NoInitT) {}
+
         /* Prevent accidentally calling irrelevant functions */
         #ifndef MAGNUM_TARGET_GLES
         using GL::AbstractShaderProgram::drawTransformFeedback;
@@ -577,6 +727,25 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT VectorGL: public GL
         #endif
 };
 
+/**
+@brief Asynchronous compilation state
+@m_since_latest
+
+Returned by @ref compile(). See @ref shaders-async for more information.
+*/
+template<UnsignedInt dimensions> class VectorGL<dimensions>::CompileState: public VectorGL<dimensions> {
+    /* Everything deliberately private except for the inheritance */
+    friend class VectorGL;
+
+    explicit CompileState(NoCreateT): VectorGL<dimensions>{NoCreate}, _vert{NoCreate}, _frag{NoCreate} {}
+
+    explicit CompileState(VectorGL<dimensions>&& shader, GL::Shader&& vert, GL::Shader&& frag, GL::Version version, bool cached): VectorGL<dimensions>{std::move(shader)}, _vert{std::move(vert)}, _frag{std::move(frag)}, _version{version}, _cached{cached} {}
+
+    GL::Shader _vert, _frag;
+    GL::Version _version;
+    bool _cached;
+};
+
 /**
 @brief Two-dimensional vector OpenGL shader
 @m_since_latest
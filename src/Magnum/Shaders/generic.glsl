@@ -32,11 +32,16 @@
 #define BITANGENT_ATTRIBUTE_LOCATION 4 /* also ObjectId */
 #define OBJECT_ID_ATTRIBUTE_LOCATION 4 /* also Bitangent */
 #define NORMAL_ATTRIBUTE_LOCATION 5
+#define WEIGHTS_ATTRIBUTE_LOCATION 6
+#define JOINTIDS_ATTRIBUTE_LOCATION 7
 
 #define TRANSFORMATION_MATRIX_ATTRIBUTE_LOCATION 8
+#define SECONDARY_WEIGHTS_ATTRIBUTE_LOCATION 10 /* also TransformationMatrix */
+#define SECONDARY_JOINTIDS_ATTRIBUTE_LOCATION 11 /* also TransformationMatrix */
 #define NORMAL_MATRIX_ATTRIBUTE_LOCATION 12
 #define TEXTURE_OFFSET_ATTRIBUTE_LOCATION 15 /* + layer in the 3rd component */
 
 /* Outputs */
 #define COLOR_OUTPUT_ATTRIBUTE_LOCATION 0
 #define OBJECT_ID_OUTPUT_ATTRIBUTE_LOCATION 1
+#define REVEALAGE_OUTPUT_ATTRIBUTE_LOCATION 2
@@ -0,0 +1,335 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "TaskScheduler.h"
+
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+#include <Corrade/Utility/Macros.h> /* CORRADE_THREAD_LOCAL */
+#if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional> /* std::ref() */
+#include <mutex>
+#include <thread>
+#endif
+
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum {
+
+namespace {
+
+TaskScheduler* globalScheduler{};
+
+#if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+struct Job {
+    void(*task)(void*, std::size_t);
+    void* state;
+    /* Count of chunks not yet finished. Decrementing it is the last access
+       to the job from a worker, once it reaches zero the job can go out of
+       scope. */
+    std::atomic<std::size_t> remaining;
+};
+
+struct Chunk {
+    Job* job;
+    std::size_t begin, end;
+};
+
+struct Queue {
+    std::mutex mutex;
+    std::deque<Chunk> chunks;
+};
+#endif
+
+struct Pool {
+    UnsignedInt threadCount;
+    #if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+    /* One queue for each worker thread, the last one is shared by all
+       threads that aren't workers of this pool and call run() */
+    Containers::Array<Queue> queues;
+    Containers::Array<std::thread> threads;
+
+    /* Count of chunks in all queues. Incremented before the chunks are
+       queued and decremented after they're taken, so it's never lower than
+       the actual count. */
+    std::atomic<std::size_t> queued{};
+
+    /* For sleeping workers. The queued count is incremented and quit set
+       with the mutex locked so a worker about to sleep doesn't miss a
+       notification. */
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool quit{};
+    #endif
+};
+
+#if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+/* Pool and queue index of the current thread, if it's a pool worker */
+CORRADE_THREAD_LOCAL Pool* currentPool{};
+CORRADE_THREAD_LOCAL std::size_t currentQueue{};
+
+/* Takes a chunk from the back of own queue or, if it's empty, steals one from
+   the front of the other queues and executes it. Returns false if there was
+   nothing to execute. */
+bool executeOne(Pool& state, const std::size_t own) {
+    if(!state.queued.load(std::memory_order_relaxed)) return false;
+
+    Chunk chunk{};
+    bool found = false;
+    {
+        Queue& queue = state.queues[own];
+        std::lock_guard<std::mutex> lock{queue.mutex};
+        if(!queue.chunks.empty()) {
+            chunk = queue.chunks.back();
+            queue.chunks.pop_back();
+            found = true;
+        }
+    }
+    for(std::size_t i = 1; !found && i != state.queues.size(); ++i) {
+        Queue& queue = state.queues[(own + i) % state.queues.size()];
+        std::lock_guard<std::mutex> lock{queue.mutex};
+        if(!queue.chunks.empty()) {
+            chunk = queue.chunks.front();
+            queue.chunks.pop_front();
+            found = true;
+        }
+    }
+    if(!found) return false;
+
+    state.queued.fetch_sub(1, std::memory_order_relaxed);
+    for(std::size_t i = chunk.begin; i != chunk.end; ++i)
+        chunk.job->task(chunk.job->state, i);
+    chunk.job->remaining.fetch_sub(1, std::memory_order_acq_rel);
+    return true;
+}
+
+void work(Pool& state, const std::size_t id) {
+    currentPool = &state;
+    currentQueue = id;
+    for(;;) {
+        if(executeOne(state, id)) continue;
+
+        std::unique_lock<std::mutex> lock{state.mutex};
+        state.condition.wait(lock, [&state]() {
+            return state.quit || state.queued.load(std::memory_order_relaxed);
+        });
+        if(state.quit) return;
+    }
+}
+#endif
+
+}
+
+struct ThreadPoolTaskScheduler::State: Pool {};
+
+TaskScheduler& TaskScheduler::global() {
+    if(globalScheduler) return *globalScheduler;
+
+    /* Intentionally never destroyed, joining threads from a static
+       destructor can deadlock on some platforms. The workers are sleeping
+       when the application exits. */
+    static TaskScheduler* const scheduler = new ThreadPoolTaskScheduler;
+    return *scheduler;
+}
+
+void TaskScheduler::setGlobal(TaskScheduler* const scheduler) {
+    globalScheduler = scheduler;
+}
+
+TaskScheduler::TaskScheduler() = default;
+
+TaskScheduler::~TaskScheduler() = default;
+
+UnsignedInt TaskScheduler::threadCount() const {
+    return Math::max(doThreadCount(), 1u);
+}
+
+void TaskScheduler::run(const std::size_t count, void(*const task)(void*, std::size_t), void* const state) {
+    CORRADE_ASSERT(task,
+        "TaskScheduler::run(): task can't be null", );
+
+    if(count == 1) task(state, 0);
+    else if(count) doRun(count, task, state);
+}
+
+ThreadPoolTaskScheduler::ThreadPoolTaskScheduler(UnsignedInt threadCount): _state{InPlaceInit} {
+    #if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+    if(!threadCount) threadCount = Math::max(std::thread::hardware_concurrency(), 1u);
+    _state->threadCount = threadCount;
+    if(threadCount > 1) {
+        _state->queues = Containers::Array<Queue>{threadCount};
+        _state->threads = Containers::Array<std::thread>{threadCount - 1};
+        for(std::size_t i = 0; i != _state->threads.size(); ++i)
+            _state->threads[i] = std::thread{work, std::ref<Pool>(*_state), i};
+    }
+    #else
+    static_cast<void>(threadCount);
+    _state->threadCount = 1;
+    #endif
+}
+
+ThreadPoolTaskScheduler::~ThreadPoolTaskScheduler() {
+    #if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+    {
+        std::lock_guard<std::mutex> lock{_state->mutex};
+        _state->quit = true;
+    }
+    _state->condition.notify_all();
+    for(std::thread& thread: _state->threads)
+        thread.join();
+    #endif
+}
+
+UnsignedInt ThreadPoolTaskScheduler::doThreadCount() const {
+    return _state->threadCount;
+}
+
+void ThreadPoolTaskScheduler::doRun(const std::size_t count, void(*const task)(void*, std::size_t), void* const state) {
+    #if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+    State& s = *_state;
+    if(!s.threads.isEmpty()) {
+        const std::size_t own = currentPool == &s ? currentQueue : s.queues.size() - 1;
+
+        /* A few chunks per thread so threads that finish early have
+           something to steal from the slower ones */
+        const std::size_t chunkCount = Math::min(count, std::size_t(s.threadCount)*4);
+        Job job;
+        job.task = task;
+        job.state = state;
+        job.remaining.store(chunkCount, std::memory_order_relaxed);
+
+        {
+            std::lock_guard<std::mutex> lock{s.mutex};
+            s.queued.fetch_add(chunkCount, std::memory_order_relaxed);
+        }
+        /* Distributing the chunks round-robin so all workers have something
+           to start with without stealing. The remainder is spread across the
+           first chunks so their sizes differ by at most one. */
+        for(std::size_t i = 0; i != chunkCount; ++i) {
+            Queue& queue = s.queues[(own + i) % s.queues.size()];
+            std::lock_guard<std::mutex> lock{queue.mutex};
+            queue.chunks.push_back({&job, i*count/chunkCount, (i + 1)*count/chunkCount});
+        }
+        s.condition.notify_all();
+
+        /* Help with executing the queued chunks, which may be of this job or
+           of any other, until this job is done */
+        while(job.remaining.load(std::memory_order_acquire))
+            if(!executeOne(s, own)) std::this_thread::yield();
+
+        return;
+    }
+    #endif
+
+    for(std::size_t i = 0; i != count; ++i)
+        task(state, i);
+}
+
+TaskGraph::TaskGraph() = default;
+
+TaskGraph::TaskGraph(TaskGraph&&) noexcept = default;
+
+TaskGraph::~TaskGraph() = default;
+
+TaskGraph& TaskGraph::operator=(TaskGraph&&) noexcept = default;
+
+UnsignedInt TaskGraph::addTask(void(*const task)(void*), void* const state) {
+    CORRADE_ASSERT(task,
+        "TaskGraph::addTask(): task can't be null", {});
+    arrayAppend(_tasks, InPlaceInit, task, state);
+    return _tasks.size() - 1;
+}
+
+TaskGraph& TaskGraph::addDependency(const UnsignedInt task, const UnsignedInt dependency) {
+    CORRADE_ASSERT(task < _tasks.size() && dependency < _tasks.size(),
+        "TaskGraph::addDependency(): index" << task << "or" << dependency << "out of range for" << _tasks.size() << "tasks", *this);
+    CORRADE_ASSERT(task != dependency,
+        "TaskGraph::addDependency(): task" << task << "can't depend on itself", *this);
+    arrayAppend(_dependencies, InPlaceInit, dependency, task);
+    return *this;
+}
+
+void TaskGraph::run(TaskScheduler& scheduler) {
+    /* Dependents of each task, sorted by the dependency using a counting
+       sort, and a count of unfinished dependencies for each task */
+    Containers::Array<UnsignedInt> dependentOffsets{ValueInit, _tasks.size() + 1};
+    Containers::Array<UnsignedInt> remaining{ValueInit, _tasks.size()};
+    for(const Containers::Pair<UnsignedInt, UnsignedInt>& dependency: _dependencies) {
+        ++dependentOffsets[dependency.first() + 1];
+        ++remaining[dependency.second()];
+    }
+    for(std::size_t i = 1; i < dependentOffsets.size(); ++i)
+        dependentOffsets[i] += dependentOffsets[i - 1];
+    Containers::Array<UnsignedInt> dependents{NoInit, _dependencies.size()};
+    {
+        Containers::Array<UnsignedInt> cursors{NoInit, _tasks.size()};
+        for(std::size_t i = 0; i != _tasks.size(); ++i)
+            cursors[i] = dependentOffsets[i];
+        for(const Containers::Pair<UnsignedInt, UnsignedInt>& dependency: _dependencies)
+            dependents[cursors[dependency.first()]++] = dependency.second();
+    }
+
+    /* Order the tasks into waves first, so a cycle is detected before
+       anything gets executed */
+    Containers::Array<UnsignedInt> order{NoInit, _tasks.size()};
+    Containers::Array<std::size_t> waveOffsets;
+    arrayAppend(waveOffsets, std::size_t{});
+    std::size_t orderSize = 0;
+    for(UnsignedInt i = 0; i != _tasks.size(); ++i)
+        if(!remaining[i]) order[orderSize++] = i;
+    while(orderSize != waveOffsets.back()) {
+        const std::size_t waveBegin = waveOffsets.back();
+        const std::size_t waveEnd = orderSize;
+        arrayAppend(waveOffsets, waveEnd);
+        for(std::size_t i = waveBegin; i != waveEnd; ++i)
+            for(std::size_t j = dependentOffsets[order[i]]; j != dependentOffsets[order[i] + 1]; ++j)
+                if(!--remaining[dependents[j]])
+                    order[orderSize++] = dependents[j];
+    }
+    CORRADE_ASSERT(orderSize == _tasks.size(),
+        "TaskGraph::run(): the dependencies contain a cycle", );
+
+    for(std::size_t i = 0; i + 1 < waveOffsets.size(); ++i) {
+        struct State {
+            const Task* tasks;
+            const UnsignedInt* wave;
+        } state{_tasks.data(), order.data() + waveOffsets[i]};
+        scheduler.run(waveOffsets[i + 1] - waveOffsets[i], [](void* state, const std::size_t i) {
+            const State& s = *static_cast<const State*>(state);
+            const Task& task = s.tasks[s.wave[i]];
+            task.function(task.state);
+        }, &state);
+    }
+}
+
+void TaskGraph::run() {
+    run(TaskScheduler::global());
+}
+
+}
@@ -0,0 +1,321 @@
+#ifndef Magnum_TaskScheduler_h
+#define Magnum_TaskScheduler_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::TaskScheduler, @ref Magnum::ThreadPoolTaskScheduler, @ref Magnum::TaskGraph
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum {
+
+/**
+@brief Task scheduler
+@m_since_latest
+
+Interface for executing independent tasks in parallel, shared by all
+multithreaded algorithms in Magnum. Instead of each algorithm spawning its own
+threads, the work is submitted to @ref global(), which is a
+@ref ThreadPoolTaskScheduler with one thread for each available core by
+default. An application that already has its own job system can subclass this
+interface and make Magnum use it with @ref setGlobal():
+
+@snippet Magnum.cpp TaskScheduler-custom
+
+The @ref run() function blocks until all tasks are done. It can be called
+from inside a running task as well, implementations are expected to not
+deadlock in that case --- the builtin @ref ThreadPoolTaskScheduler for example
+executes queued tasks on the waiting thread.
+
+Algorithms taking a @cpp threadCount @ce parameter, such as
+@ref copyImage(), @ref Math::Algorithms::kahanSum(),
+@ref MeshTools::subdivideSharedInPlace() or @ref Animation::Player::advance(),
+split the work into at most @cpp threadCount @ce tasks and submit them to
+@ref global(). A @cpp threadCount @ce of @cpp 0 @ce means
+@ref threadCount() of the global scheduler.
+
+@section TaskScheduler-single-threaded Single-threaded builds
+
+If Corrade isn't built with @ref CORRADE_BUILD_MULTITHREADED or when
+targeting @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten", the builtin
+@ref ThreadPoolTaskScheduler executes all tasks sequentially on the calling
+thread and reports a @ref threadCount() of @cpp 1 @ce. A custom scheduler can
+still be set in that case.
+*/
+class MAGNUM_EXPORT TaskScheduler {
+    public:
+        /**
+         * @brief Global scheduler
+         *
+         * Returns the scheduler passed to @ref setGlobal() or, if none was
+         * set, a @ref ThreadPoolTaskScheduler with one thread for each
+         * available core that's created on first use.
+         */
+        static TaskScheduler& global();
+
+        /**
+         * @brief Set the global scheduler
+         *
+         * Passing @cpp nullptr @ce makes @ref global() use the builtin
+         * @ref ThreadPoolTaskScheduler again. The scheduler isn't owned by
+         * Magnum and has to stay alive for as long as it's set. Expected to
+         * be called only while no tasks are running.
+         */
+        static void setGlobal(TaskScheduler* scheduler);
+
+        explicit TaskScheduler();
+
+        /** @brief Copying is not allowed */
+        TaskScheduler(const TaskScheduler&) = delete;
+
+        /** @brief Moving is not allowed */
+        TaskScheduler(TaskScheduler&&) = delete;
+
+        virtual ~TaskScheduler();
+
+        /** @brief Copying is not allowed */
+        TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+        /** @brief Moving is not allowed */
+        TaskScheduler& operator=(TaskScheduler&&) = delete;
+
+        /**
+         * @brief Count of threads executing the tasks
+         *
+         * Including the thread calling @ref run(). Always at least
+         * @cpp 1 @ce.
+         */
+        UnsignedInt threadCount() const;
+
+        /**
+         * @brief Run tasks in parallel
+         * @param count     Task count
+         * @param task      Task function
+         * @param state     State passed to the task function
+         *
+         * Calls @p task with @p state and an index in range
+         * @cpp [0, count) @ce for each task, in an unspecified order and
+         * possibly from multiple threads at once. Returns after all tasks
+         * finish. If @p count is @cpp 0 @ce, does nothing.
+         * @see @ref parallelFor()
+         */
+        void run(std::size_t count, void(*task)(void* state, std::size_t i), void* state);
+
+        /**
+         * @brief Call a function on parallel ranges
+         * @param count     Item count
+         * @param taskCount Max count of tasks to split the range into. If
+         *      @cpp 0 @ce, @ref threadCount() is used.
+         * @param f         Function taking a @cpp std::size_t @ce begin and
+         *      end of a range
+         *
+         * Splits @cpp [0, count) @ce into at most @p taskCount contiguous
+         * ranges of roughly the same size and calls @p f on each in
+         * parallel. Meant for work where all items take roughly the same
+         * time. For items of varying cost, use a higher @p taskCount or
+         * @ref run() directly, the scheduler then balances the load across
+         * threads.
+         */
+        template<class F> void parallelFor(std::size_t count, UnsignedInt taskCount, const F& f);
+
+    private:
+        /** @brief Implementation for @ref threadCount() */
+        virtual UnsignedInt doThreadCount() const = 0;
+
+        /**
+         * @brief Implementation for @ref run()
+         *
+         * Called only if @p count is larger than @cpp 1 @ce, otherwise the
+         * task is executed directly. Has to call @p task for every index
+         * exactly once and return only after all calls finished.
+         */
+        virtual void doRun(std::size_t count, void(*task)(void*, std::size_t), void* state) = 0;
+};
+
+/**
+@brief Work-stealing thread pool task scheduler
+@m_since_latest
+
+The builtin @ref TaskScheduler implementation, used by
+@ref TaskScheduler::global() unless a custom scheduler is set. Each worker
+thread has its own task queue. Tasks submitted with @ref run() are split into
+chunks distributed across the queues, a worker takes chunks from the back of
+its own queue and, once it's empty, steals from the front of the other
+queues. The thread calling @ref run() executes queued chunks as well while
+waiting, which makes nested @ref run() calls from inside a task safe.
+
+The worker threads are started in the constructor and sleep while there's no
+work. They're stopped in the destructor.
+*/
+class MAGNUM_EXPORT ThreadPoolTaskScheduler: public TaskScheduler {
+    public:
+        /**
+         * @brief Constructor
+         * @param threadCount   Count of threads executing the tasks,
+         *      including the thread calling @ref run(). If @cpp 0 @ce,
+         *      @m_class{m-doc-external} [std::thread::hardware_concurrency()](https://en.cppreference.com/w/cpp/thread/thread/hardware_concurrency)
+         *      is used.
+         *
+         * Starts @cpp threadCount - 1 @ce worker threads. If Corrade isn't
+         * built with @ref CORRADE_BUILD_MULTITHREADED or when targeting
+         * @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten", @p threadCount is
+         * ignored and no threads are started.
+         */
+        explicit ThreadPoolTaskScheduler(UnsignedInt threadCount = 0);
+
+        /**
+         * @brief Destructor
+         *
+         * Stops and joins the worker threads. Expects that no @ref run() is
+         * in progress.
+         */
+        ~ThreadPoolTaskScheduler();
+
+    private:
+        struct State;
+
+        UnsignedInt doThreadCount() const override;
+        void doRun(std::size_t count, void(*task)(void*, std::size_t), void* state) override;
+
+        Containers::Pointer<State> _state;
+};
+
+/**
+@brief Task graph
+@m_since_latest
+
+A set of tasks with dependencies between them, executed on a
+@ref TaskScheduler. A task is run only after all tasks it depends on
+finished, tasks that don't depend on each other run in parallel.
+
+@snippet Magnum.cpp TaskGraph-usage
+
+The graph can be executed any number of times. Tasks are executed in waves
+--- all tasks whose dependencies finished in the previous wave are submitted
+to the scheduler at once --- so a long-running task delays the start of its
+independent successors in the next wave. For work consisting of many
+uniform tasks this has negligible overhead.
+*/
+class MAGNUM_EXPORT TaskGraph {
+    public:
+        /** @brief Constructor */
+        explicit TaskGraph();
+
+        /** @brief Copying is not allowed */
+        TaskGraph(const TaskGraph&) = delete;
+
+        /** @brief Move constructor */
+        TaskGraph(TaskGraph&&) noexcept;
+
+        ~TaskGraph();
+
+        /** @brief Copying is not allowed */
+        TaskGraph& operator=(const TaskGraph&) = delete;
+
+        /** @brief Move assignment */
+        TaskGraph& operator=(TaskGraph&&) noexcept;
+
+        /** @brief Task count */
+        std::size_t taskCount() const { return _tasks.size(); }
+
+        /**
+         * @brief Add a task
+         * @param task      Task function
+         * @param state     State passed to the task function
+         * @return Task ID
+         *
+         * The @p state is not copied, it's expected to stay alive for as long
+         * as the graph is executed.
+         */
+        UnsignedInt addTask(void(*task)(void* state), void* state);
+
+        /**
+         * @brief Add a dependency between two tasks
+         * @return Reference to self (for method chaining)
+         *
+         * The task @p task will be run only after @p dependency finished.
+         * Both are expected to be valid task IDs and different from each
+         * other.
+         */
+        TaskGraph& addDependency(UnsignedInt task, UnsignedInt dependency);
+
+        /**
+         * @brief Run the graph
+         *
+         * Executes all tasks on @p scheduler and returns after all of them
+         * finished. Expects that the dependencies don't form a cycle.
+         */
+        void run(TaskScheduler& scheduler);
+
+        /**
+         * @brief Run the graph on the global scheduler
+         *
+         * Equivalent to calling @ref run(TaskScheduler&) with
+         * @ref TaskScheduler::global().
+         */
+        void run();
+
+    private:
+        struct Task {
+            void(*function)(void*);
+            void* state;
+        };
+
+        Containers::Array<Task> _tasks;
+        /* Dependency first, dependent task second */
+        Containers::Array<Containers::Pair<UnsignedInt, UnsignedInt>> _dependencies;
+};
+
+template<class F> void TaskScheduler::parallelFor(const std::size_t count, UnsignedInt taskCount, const F& f) {
+    if(!taskCount) taskCount = threadCount();
+    if(std::size_t(taskCount) > count) taskCount = UnsignedInt(count);
+    if(taskCount <= 1) {
+        f(std::size_t{}, count);
+        return;
+    }
+
+    struct State {
+        const F& f;
+        std::size_t count, taskCount;
+    } state{f, count, taskCount};
+    run(taskCount, [](void* state, const std::size_t i) {
+        const State& s = *static_cast<const State*>(state);
+        /* Distributing the remainder across the first ranges, so their sizes
+           differ by at most one */
+        s.f(i*s.count/s.taskCount, (i + 1)*s.count/s.taskCount);
+    }, &state);
+}
+
+}
+
+#endif
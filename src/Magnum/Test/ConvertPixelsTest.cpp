@@ -0,0 +1,476 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/ConvertPixels.h"
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Half.h"
+
+namespace Magnum { namespace Test { namespace {
+
+struct ConvertPixelsTest: TestSuite::Tester {
+    explicit ConvertPixelsTest();
+
+    void debugFlag();
+    void debugFlags();
+
+    void copy();
+    void copyImplementationSpecific();
+
+    void rgbToRgba();
+    void rgbaToRgb();
+    void swapRedBlue();
+    void swapRedBlueInPlace();
+    void shuffle16();
+    void shuffle32();
+
+    void unormToFloat();
+    void floatToUnorm();
+    void floatToSnorm();
+    void srgbToLinear();
+    void srgbRoundtrip();
+    void halfRoundtrip();
+    void floatSwapRedBlueInPlace();
+
+    void multipleThreads();
+    void newImage();
+
+    void sizeMismatch();
+    void implementationSpecific();
+    void depthStencil();
+    void unsupported();
+    void swapRedBlueTooFewChannels();
+};
+
+const struct {
+    const char* name;
+    ConvertPixelsFlags flags;
+} SwapData[]{
+    {"", {}},
+    {"swapping red and blue", ConvertPixelsFlag::SwapRedBlue}
+};
+
+ConvertPixelsTest::ConvertPixelsTest() {
+    addTests({&ConvertPixelsTest::debugFlag,
+              &ConvertPixelsTest::debugFlags,
+
+              &ConvertPixelsTest::copy,
+              &ConvertPixelsTest::copyImplementationSpecific});
+
+    addInstancedTests({&ConvertPixelsTest::rgbToRgba,
+                       &ConvertPixelsTest::rgbaToRgb},
+        Containers::arraySize(SwapData));
+
+    addTests({&ConvertPixelsTest::swapRedBlue,
+              &ConvertPixelsTest::swapRedBlueInPlace,
+              &ConvertPixelsTest::shuffle16,
+              &ConvertPixelsTest::shuffle32,
+
+              &ConvertPixelsTest::unormToFloat,
+              &ConvertPixelsTest::floatToUnorm,
+              &ConvertPixelsTest::floatToSnorm,
+              &ConvertPixelsTest::srgbToLinear,
+              &ConvertPixelsTest::srgbRoundtrip,
+              &ConvertPixelsTest::halfRoundtrip,
+              &ConvertPixelsTest::floatSwapRedBlueInPlace,
+
+              &ConvertPixelsTest::multipleThreads,
+              &ConvertPixelsTest::newImage,
+
+              &ConvertPixelsTest::sizeMismatch,
+              &ConvertPixelsTest::implementationSpecific,
+              &ConvertPixelsTest::depthStencil,
+              &ConvertPixelsTest::unsupported,
+              &ConvertPixelsTest::swapRedBlueTooFewChannels});
+}
+
+using namespace Math::Literals;
+
+/* Enough pixels to go through the vectorized kernels and have a remainder
+   processed by the scalar code */
+constexpr std::size_t Count = 37;
+
+void ConvertPixelsTest::debugFlag() {
+    std::ostringstream out;
+    Debug{&out} << ConvertPixelsFlag::SwapRedBlue << ConvertPixelsFlag(0xf0);
+    CORRADE_COMPARE(out.str(), "ConvertPixelsFlag::SwapRedBlue ConvertPixelsFlag(0xf0)\n");
+}
+
+void ConvertPixelsTest::debugFlags() {
+    std::ostringstream out;
+    Debug{&out} << (ConvertPixelsFlag::SwapRedBlue|ConvertPixelsFlag(0xf0)) << ConvertPixelsFlags{};
+    CORRADE_COMPARE(out.str(), "ConvertPixelsFlag::SwapRedBlue|ConvertPixelsFlag(0xf0) ConvertPixelsFlags{}\n");
+}
+
+void ConvertPixelsTest::copy() {
+    /* The source rows are padded to four bytes, the destination not */
+    const char src[]{
+        1, 2, 3, 4, 5, 6, 0, 0,
+        7, 8, 9, 10, 11, 12, 0, 0
+    };
+    char dst[12]{};
+    convertPixels(
+        ImageView2D{PixelFormat::RGB8Unorm, {2, 2}, src},
+        MutableImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::RGB8Unorm, {2, 2}, dst});
+    CORRADE_COMPARE_AS(Containers::arrayView(dst), Containers::arrayView<char>({
+        1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12
+    }), TestSuite::Compare::Container);
+}
+
+void ConvertPixelsTest::copyImplementationSpecific() {
+    const char src[]{1, 2, 3, 4, 5, 6, 7, 8};
+    char dst[8]{};
+    convertPixels(
+        ImageView2D{PixelStorage{}, 0x1234, 0, 4, {2, 1}, src},
+        MutableImageView2D{PixelStorage{}, 0x1234, 0, 4, {2, 1}, dst});
+    CORRADE_COMPARE_AS(Containers::arrayView(dst), Containers::arrayView(src),
+        TestSuite::Compare::Container);
+}
+
+void ConvertPixelsTest::rgbToRgba() {
+    auto&& data = SwapData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Color3ub src[Count];
+    Color4ub expected[Count];
+    for(std::size_t i = 0; i != Count; ++i) {
+        src[i] = {UnsignedByte(i), UnsignedByte(i*2), UnsignedByte(i*3)};
+        expected[i] = data.flags ?
+            Color4ub{UnsignedByte(i*3), UnsignedByte(i*2), UnsignedByte(i), 255} :
+            Color4ub{UnsignedByte(i), UnsignedByte(i*2), UnsignedByte(i*3), 255};
+    }
+
+    Color4ub dst[Count];
+    convertPixels(
+        ImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::RGB8Srgb, {Count, 1}, src},
+        MutableImageView2D{PixelFormat::RGBA8Srgb, {Count, 1}, dst},
+        data.flags);
+    CORRADE_COMPARE_AS(Containers::arrayView(dst), Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void ConvertPixelsTest::rgbaToRgb() {
+    auto&& data = SwapData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Color4ub src[Count];
+    Color3ub expected[Count];
+    for(std::size_t i = 0; i != Count; ++i) {
+        src[i] = {UnsignedByte(i), UnsignedByte(i*2), UnsignedByte(i*3), UnsignedByte(i*4)};
+        expected[i] = data.flags ?
+            Color3ub{UnsignedByte(i*3), UnsignedByte(i*2), UnsignedByte(i)} :
+            Color3ub{UnsignedByte(i), UnsignedByte(i*2), UnsignedByte(i*3)};
+    }
+
+    Color3ub dst[Count];
+    convertPixels(
+        ImageView2D{PixelFormat::RGBA8Unorm, {Count, 1}, src},
+        MutableImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::RGB8Unorm, {Count, 1}, dst},
+        data.flags);
+    CORRADE_COMPARE_AS(Containers::arrayView(dst), Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void ConvertPixelsTest::swapRedBlue() {
+    Color3ub src[Count];
+    Color3ub expected[Count];
+    for(std::size_t i = 0; i != Count; ++i) {
+        src[i] = {UnsignedByte(i), UnsignedByte(i*2), UnsignedByte(i*3)};
+        expected[i] = {UnsignedByte(i*3), UnsignedByte(i*2), UnsignedByte(i)};
+    }
+
+    Color3ub dst[Count];
+    convertPixels(
+        ImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::RGB8Unorm, {Count, 1}, src},
+        MutableImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::RGB8Unorm, {Count, 1}, dst},
+        ConvertPixelsFlag::SwapRedBlue);
+    CORRADE_COMPARE_AS(Containers::arrayView(dst), Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void ConvertPixelsTest::swapRedBlueInPlace() {
+    Color4ub data[Count];
+    Color4ub expected[Count];
+    for(std::size_t i = 0; i != Count; ++i) {
+        data[i] = {UnsignedByte(i), UnsignedByte(i*2), UnsignedByte(i*3), UnsignedByte(i*4)};
+        expected[i] = {UnsignedByte(i*3), UnsignedByte(i*2), UnsignedByte(i), UnsignedByte(i*4)};
+    }
+
+    MutableImageView2D image{PixelFormat::RGBA8Unorm, {Count, 1}, data};
+    convertPixels(image, image, ConvertPixelsFlag::SwapRedBlue);
+    CORRADE_COMPARE_AS(Containers::arrayView(data), Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void ConvertPixelsTest::shuffle16() {
+    const Math::Vector2<UnsignedShort> src[]{{1, 2}, {3, 4}};
+    Math::Vector4<UnsignedShort> dst[2];
+    convertPixels(
+        ImageView2D{PixelFormat::RG16UI, {2, 1}, src},
+        MutableImageView2D{PixelFormat::RGBA16UI, {2, 1}, dst});
+    CORRADE_COMPARE_AS(Containers::arrayView(dst), Containers::arrayView<Math::Vector4<UnsignedShort>>({
+        {1, 2, 0, 1},
+        {3, 4, 0, 1}
+    }), TestSuite::Compare::Container);
+}
+
+void ConvertPixelsTest::shuffle32() {
+    /* The alpha is filled with a 1.0f bit pattern */
+    const Vector3 src[]{{1.0f, 2.0f, 3.0f}, {4.0f, 5.0f, 6.0f}};
+    Vector4 dst[2];
+    convertPixels(
+        ImageView2D{PixelFormat::RGB32F, {2, 1}, src},
+        MutableImageView2D{PixelFormat::RGBA32F, {2, 1}, dst},
+        ConvertPixelsFlag::SwapRedBlue);
+    CORRADE_COMPARE_AS(Containers::arrayView(dst), Containers::arrayView<Vector4>({
+        {3.0f, 2.0f, 1.0f, 1.0f},
+        {6.0f, 5.0f, 4.0f, 1.0f}
+    }), TestSuite::Compare::Container);
+}
+
+void ConvertPixelsTest::unormToFloat() {
+    /* Missing channels are filled with zero, alpha with one */
+    const UnsignedByte src[]{0, 51, 255, 0};
+    Vector4 dst[3];
+    convertPixels(
+        ImageView2D{PixelFormat::R8Unorm, {3, 1}, src},
+        MutableImageView2D{PixelFormat::RGBA32F, {3, 1}, dst});
+    CORRADE_COMPARE_AS(Containers::arrayView(dst), Containers::arrayView<Vector4>({
+        {0.0f, 0.0f, 0.0f, 1.0f},
+        {0.2f, 0.0f, 0.0f, 1.0f},
+        {1.0f, 0.0f, 0.0f, 1.0f}
+    }), TestSuite::Compare::Container);
+}
+
+void ConvertPixelsTest::floatToUnorm() {
+    /* Out-of-range values get clamped */
+    const Vector2 src[]{{-1.0f, 0.5f}, {2.0f, 0.2f}};
+    Math::Vector2<UnsignedByte> dst[2];
+    convertPixels(
+        ImageView2D{PixelFormat::RG32F, {2, 1}, src},
+        MutableImageView2D{PixelFormat::RG8Unorm, {2, 1}, dst});
+    CORRADE_COMPARE_AS(Containers::arrayView(dst), Containers::arrayView<Math::Vector2<UnsignedByte>>({
+        {0, 128},
+        {255, 51}
+    }), TestSuite::Compare::Container);
+}
+
+void ConvertPixelsTest::floatToSnorm() {
+    const Float src[]{-2.0f, -1.0f, 0.5f, 1.0f};
+    Byte dst[4];
+    convertPixels(
+        ImageView2D{PixelFormat::R32F, {4, 1}, src},
+        MutableImageView2D{PixelFormat::R8Snorm, {4, 1}, dst});
+    CORRADE_COMPARE_AS(Containers::arrayView(dst), Containers::arrayView<Byte>({
+        -127, -127, 64, 127
+    }), TestSuite::Compare::Container);
+}
+
+void ConvertPixelsTest::srgbToLinear() {
+    /* Alpha is linear */
+    const Color4ub src[]{
+        0x33669980_rgba,
+        0xffcc0040_rgba
+    };
+    Color4 dst[2];
+    convertPixels(
+        ImageView2D{PixelFormat::RGBA8Srgb, {2, 1}, src},
+        MutableImageView2D{PixelFormat::RGBA32F, {2, 1}, dst});
+    CORRADE_COMPARE_AS(Containers::arrayView(dst), Containers::arrayView<Color4>({
+        Color4::fromSrgbAlpha(src[0]),
+        Color4::fromSrgbAlpha(src[1])
+    }), TestSuite::Compare::Container);
+}
+
+void ConvertPixelsTest::srgbRoundtrip() {
+    /* Each sRGB value should survive going to linear floats and back */
+    Color4ub src[256];
+    for(std::size_t i = 0; i != 256; ++i)
+        src[i] = Color4ub{UnsignedByte(i)};
+
+    Color4 linear[256];
+    Color4ub dst[256];
+    convertPixels(
+        ImageView2D{PixelFormat::RGBA8Srgb, {256, 1}, src},
+        MutableImageView2D{PixelFormat::RGBA32F, {256, 1}, linear});
+    convertPixels(
+        ImageView2D{PixelFormat::RGBA32F, {256, 1}, linear},
+        MutableImageView2D{PixelFormat::RGBA8Srgb, {256, 1}, dst});
+    CORRADE_COMPARE_AS(Containers::arrayView(dst), Containers::arrayView(src),
+        TestSuite::Compare::Container);
+}
+
+void ConvertPixelsTest::halfRoundtrip() {
+    Color4ub src[256];
+    for(std::size_t i = 0; i != 256; ++i)
+        src[i] = {UnsignedByte(i), UnsignedByte(255 - i), UnsignedByte(i/2), 255};
+
+    Vector4h half[256];
+    Color4ub dst[256];
+    convertPixels(
+        ImageView2D{PixelFormat::RGBA8Unorm, {256, 1}, src},
+        MutableImageView2D{PixelFormat::RGBA16F, {256, 1}, half});
+    CORRADE_COMPARE(half[255].x(), 1.0_h);
+    CORRADE_COMPARE(half[255].y(), 0.0_h);
+    CORRADE_COMPARE(half[255].w(), 1.0_h);
+
+    convertPixels(
+        ImageView2D{PixelFormat::RGBA16F, {256, 1}, half},
+        MutableImageView2D{PixelFormat::RGBA8Unorm, {256, 1}, dst});
+    CORRADE_COMPARE_AS(Containers::arrayView(dst), Containers::arrayView(src),
+        TestSuite::Compare::Container);
+}
+
+void ConvertPixelsTest::floatSwapRedBlueInPlace() {
+    /* Pixel size is the same, so this goes through floats in-place */
+    Color4ub data[]{
+        0x336699ff_rgba,
+        0xffcc0080_rgba
+    };
+    MutableImageView2D src{PixelFormat::RGBA8Srgb, {2, 1}, data};
+    MutableImageView2D dst{PixelFormat::RGBA8Unorm, {2, 1}, data};
+    convertPixels(src, dst, ConvertPixelsFlag::SwapRedBlue);
+    CORRADE_COMPARE(data[0], Math::pack<Color4ub>(Color4::fromSrgbAlpha(0x996633ff_rgba)));
+    CORRADE_COMPARE(data[1], Math::pack<Color4ub>(Color4::fromSrgbAlpha(0x00ccff80_rgba)));
+}
+
+void ConvertPixelsTest::multipleThreads() {
+    /* Large enough to be split across threads */
+    const Vector2i size{1024, 512};
+    Containers::Array<Color4ub> src{NoInit, std::size_t(size.product())};
+    for(std::size_t i = 0; i != src.size(); ++i)
+        src[i] = {UnsignedByte(i), UnsignedByte(i >> 8), UnsignedByte(i >> 16), UnsignedByte(i*3)};
+
+    Containers::Array<Color3> expected{NoInit, src.size()};
+    Containers::Array<Color3> dst{NoInit, src.size()};
+    convertPixels(
+        ImageView2D{PixelFormat::RGBA8Unorm, size, Containers::arrayView(src)},
+        MutableImageView2D{PixelFormat::RGB32F, size, Containers::arrayView(expected)},
+        ConvertPixelsFlag::SwapRedBlue, 1);
+    convertPixels(
+        ImageView2D{PixelFormat::RGBA8Unorm, size, Containers::arrayView(src)},
+        MutableImageView2D{PixelFormat::RGB32F, size, Containers::arrayView(dst)},
+        ConvertPixelsFlag::SwapRedBlue, 4);
+    const Color4ub& pixel = src[size.x() + 3];
+    CORRADE_COMPARE(expected[size.x() + 3], (Color3{pixel.b()/255.0f, pixel.g()/255.0f, pixel.r()/255.0f}));
+    CORRADE_COMPARE_AS(dst, expected,
+        TestSuite::Compare::Container);
+}
+
+void ConvertPixelsTest::newImage() {
+    /* The rows get padded to four bytes */
+    const Color4ub src[]{
+        0x112233ff_rgba, 0x445566ff_rgba, 0x778899ff_rgba, 0xaabbccff_rgba
+    };
+    Image2D image = convertPixels(ImageView2D{PixelFormat::RGBA8Unorm, {1, 4}, src}, PixelFormat::RGB8Unorm);
+    CORRADE_COMPARE(image.format(), PixelFormat::RGB8Unorm);
+    CORRADE_COMPARE(image.size(), (Vector2i{1, 4}));
+    CORRADE_COMPARE(image.data().size(), 16);
+    CORRADE_COMPARE(image.pixels<Color3ub>()[2][0], 0x778899_rgb);
+}
+
+void ConvertPixelsTest::sizeMismatch() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    char data[16];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    convertPixels(
+        ImageView2D{PixelFormat::RGBA8Unorm, {2, 2}, data},
+        MutableImageView2D{PixelFormat::RGBA8Unorm, {4, 1}, data});
+    CORRADE_COMPARE(out.str(), "convertPixels(): expected images of the same size, got {2, 2} and {4, 1}\n");
+}
+
+void ConvertPixelsTest::implementationSpecific() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    char data[4];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    convertPixels(
+        ImageView2D{PixelStorage{}, 0x1234, 0, 4, {1, 1}, data},
+        MutableImageView2D{PixelFormat::RGBA8Unorm, {1, 1}, data});
+    CORRADE_COMPARE(out.str(), "convertPixels(): can't convert implementation-specific pixel formats, got PixelFormat::ImplementationSpecific(0x1234) and PixelFormat::RGBA8Unorm\n");
+}
+
+void ConvertPixelsTest::depthStencil() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    char data[4];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    convertPixels(
+        ImageView2D{PixelFormat::Depth32F, {1, 1}, data},
+        MutableImageView2D{PixelFormat::R32F, {1, 1}, data});
+    CORRADE_COMPARE(out.str(), "convertPixels(): can't convert depth/stencil pixel formats, got PixelFormat::Depth32F and PixelFormat::R32F\n");
+}
+
+void ConvertPixelsTest::unsupported() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    char data[4];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    convertPixels(
+        ImageView2D{PixelFormat::RGBA8UI, {1, 1}, data},
+        MutableImageView2D{PixelFormat::RGBA8Unorm, {1, 1}, data});
+    convertPixels(
+        ImageView2D{PixelFormat::R32F, {1, 1}, data},
+        MutableImageView2D{PixelFormat::R32I, {1, 1}, data});
+    CORRADE_COMPARE(out.str(),
+        "convertPixels(): can't convert PixelFormat::RGBA8UI to PixelFormat::RGBA8Unorm\n"
+        "convertPixels(): can't convert PixelFormat::R32F to PixelFormat::R32I\n");
+}
+
+void ConvertPixelsTest::swapRedBlueTooFewChannels() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    char data[4];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    convertPixels(
+        ImageView2D{PixelFormat::RG16F, {1, 1}, data},
+        MutableImageView2D{PixelFormat::RGBA8Unorm, {1, 1}, data},
+        ConvertPixelsFlag::SwapRedBlue);
+    CORRADE_COMPARE(out.str(), "convertPixels(): can't swap red and blue channels of PixelFormat::RG16F\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Test::ConvertPixelsTest)
@@ -0,0 +1,351 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <type_traits>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/FramePacer.h"
+
+namespace Magnum { namespace Test { namespace {
+
+struct FramePacerTest: TestSuite::Tester {
+    explicit FramePacerTest();
+
+    void construct();
+    void constructZeroHistory();
+    void constructMove();
+
+    void setters();
+    void settersInvalid();
+
+    void nextFrame();
+    void nextFrameStopped();
+    void nextFrameBackwards();
+    void history();
+    void historyWraparound();
+    void maxFrameDuration();
+    void refreshRateSnapping();
+    void percentileInvalid();
+
+    void targetFrameRate();
+};
+
+using namespace std::chrono;
+
+FramePacerTest::FramePacerTest() {
+    addTests({&FramePacerTest::construct,
+              &FramePacerTest::constructZeroHistory,
+              &FramePacerTest::constructMove,
+
+              &FramePacerTest::setters,
+              &FramePacerTest::settersInvalid,
+
+              &FramePacerTest::nextFrame,
+              &FramePacerTest::nextFrameStopped,
+              &FramePacerTest::nextFrameBackwards,
+              &FramePacerTest::history,
+              &FramePacerTest::historyWraparound,
+              &FramePacerTest::maxFrameDuration,
+              &FramePacerTest::refreshRateSnapping,
+              &FramePacerTest::percentileInvalid,
+
+              &FramePacerTest::targetFrameRate});
+}
+
+void FramePacerTest::construct() {
+    FramePacer pacer{30};
+    CORRADE_COMPARE(pacer.historySize(), 30);
+    CORRADE_VERIFY(!pacer.isRunning());
+    CORRADE_COMPARE(pacer.targetFrameRate(), 0.0f);
+    CORRADE_COMPARE(pacer.spinDuration(), 0.002f);
+    CORRADE_COMPARE(pacer.refreshRate(), 0.0f);
+    CORRADE_COMPARE(pacer.maxFrameDuration(), 0.25f);
+    CORRADE_COMPARE(pacer.frameCount(), 0);
+    CORRADE_COMPARE(pacer.previousFrameTime(), 0.0f);
+    CORRADE_COMPARE(pacer.previousFrameDuration(), 0.0f);
+    CORRADE_COMPARE(pacer.smoothedFrameDuration(), 0.0f);
+    CORRADE_COMPARE(pacer.frameDurationMin(), 0.0f);
+    CORRADE_COMPARE(pacer.frameDurationMax(), 0.0f);
+    CORRADE_COMPARE(pacer.frameDurationMean(), 0.0f);
+    CORRADE_COMPARE(pacer.frameDurationStandardDeviation(), 0.0f);
+    CORRADE_COMPARE(pacer.frameDurationPercentile(0.5f), 0.0f);
+}
+
+void FramePacerTest::constructZeroHistory() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    FramePacer{0};
+    CORRADE_COMPARE(out.str(), "FramePacer: expected a non-zero history size\n");
+}
+
+void FramePacerTest::constructMove() {
+    const steady_clock::time_point start{};
+
+    FramePacer a{10};
+    a.start(start)
+     .nextFrame(start + milliseconds{20});
+
+    FramePacer b{std::move(a)};
+    CORRADE_COMPARE(b.historySize(), 10);
+    CORRADE_COMPARE(b.frameCount(), 1);
+    CORRADE_COMPARE(b.frameDurationMean(), 0.02f);
+
+    FramePacer c{5};
+    c = std::move(b);
+    CORRADE_COMPARE(c.historySize(), 10);
+    CORRADE_COMPARE(c.frameCount(), 1);
+    CORRADE_COMPARE(c.frameDurationMean(), 0.02f);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<FramePacer>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<FramePacer>::value);
+}
+
+void FramePacerTest::setters() {
+    FramePacer pacer;
+    pacer.setTargetFrameRate(50.0f)
+         .setSpinDuration(0.001f)
+         .setRefreshRate(60.0f)
+         .setMaxFrameDuration(0.1f);
+    CORRADE_COMPARE(pacer.targetFrameRate(), 50.0f);
+    CORRADE_COMPARE(pacer.spinDuration(), 0.001f);
+    CORRADE_COMPARE(pacer.refreshRate(), 60.0f);
+    CORRADE_COMPARE(pacer.maxFrameDuration(), 0.1f);
+
+    /* With no frames measured, the target duration is used */
+    CORRADE_COMPARE(pacer.smoothedFrameDuration(), 0.02f);
+
+    pacer.setTargetFrameRate(0.0f);
+    CORRADE_COMPARE(pacer.targetFrameRate(), 0.0f);
+    CORRADE_COMPARE(pacer.smoothedFrameDuration(), 0.0f);
+}
+
+void FramePacerTest::settersInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    FramePacer pacer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    pacer.setTargetFrameRate(-1.0f)
+         .setSpinDuration(-1.0f)
+         .setRefreshRate(-1.0f)
+         .setMaxFrameDuration(0.0f);
+    CORRADE_COMPARE(out.str(),
+        "FramePacer::setTargetFrameRate(): expected a non-negative value, got -1\n"
+        "FramePacer::setSpinDuration(): expected a non-negative value, got -1\n"
+        "FramePacer::setRefreshRate(): expected a non-negative value, got -1\n"
+        "FramePacer::setMaxFrameDuration(): expected a positive value, got 0\n");
+}
+
+void FramePacerTest::nextFrame() {
+    const steady_clock::time_point start{seconds{100}};
+
+    FramePacer pacer;
+    pacer.start(start);
+    CORRADE_VERIFY(pacer.isRunning());
+
+    pacer.nextFrame(start + milliseconds{10});
+    CORRADE_COMPARE(pacer.previousFrameTime(), 0.01f);
+    CORRADE_COMPARE(pacer.previousFrameDuration(), 0.01f);
+
+    pacer.nextFrame(start + milliseconds{40});
+    CORRADE_COMPARE(pacer.previousFrameTime(), 0.04f);
+    CORRADE_COMPARE(pacer.previousFrameDuration(), 0.03f);
+    CORRADE_COMPARE(pacer.frameCount(), 2);
+    CORRADE_COMPARE(pacer.smoothedFrameDuration(), 0.02f);
+    CORRADE_COMPARE(pacer.predictedNextFrameTime(), 0.06f);
+
+    /* Restarting clears everything */
+    pacer.start(start + seconds{1});
+    CORRADE_COMPARE(pacer.frameCount(), 0);
+    CORRADE_COMPARE(pacer.previousFrameTime(), 0.0f);
+    CORRADE_COMPARE(pacer.previousFrameDuration(), 0.0f);
+
+    pacer.stop();
+    CORRADE_VERIFY(!pacer.isRunning());
+    CORRADE_COMPARE(pacer.frameCount(), 0);
+}
+
+void FramePacerTest::nextFrameStopped() {
+    FramePacer pacer;
+    pacer.nextFrame()
+         .nextFrame(steady_clock::now());
+    CORRADE_COMPARE(pacer.frameCount(), 0);
+    CORRADE_COMPARE(pacer.previousFrameDuration(), 0.0f);
+}
+
+void FramePacerTest::nextFrameBackwards() {
+    const steady_clock::time_point start{seconds{100}};
+
+    FramePacer pacer;
+    pacer.start(start)
+         .nextFrame(start + milliseconds{20})
+         .nextFrame(start + milliseconds{10});
+    CORRADE_COMPARE(pacer.frameCount(), 2);
+    CORRADE_COMPARE(pacer.previousFrameDuration(), 0.0f);
+    CORRADE_COMPARE(pacer.previousFrameTime(), 0.02f);
+}
+
+void FramePacerTest::history() {
+    const steady_clock::time_point start{};
+
+    FramePacer pacer;
+    pacer.start(start);
+    steady_clock::time_point time = start;
+    for(Int duration: {10, 20, 30, 40, 50}) {
+        time += milliseconds{duration};
+        pacer.nextFrame(time);
+    }
+
+    CORRADE_COMPARE(pacer.frameCount(), 5);
+    CORRADE_COMPARE(pacer.frameDurationMin(), 0.01f);
+    CORRADE_COMPARE(pacer.frameDurationMax(), 0.05f);
+    CORRADE_COMPARE(pacer.frameDurationMean(), 0.03f);
+    CORRADE_COMPARE(pacer.frameDurationStandardDeviation(), 0.01414214f);
+    CORRADE_COMPARE(pacer.frameDurationPercentile(0.0f), 0.01f);
+    CORRADE_COMPARE(pacer.frameDurationPercentile(0.5f), 0.03f);
+    CORRADE_COMPARE(pacer.frameDurationPercentile(0.75f), 0.04f);
+    CORRADE_COMPARE(pacer.frameDurationPercentile(1.0f), 0.05f);
+}
+
+void FramePacerTest::historyWraparound() {
+    const steady_clock::time_point start{};
+
+    FramePacer pacer{3};
+    pacer.start(start);
+    steady_clock::time_point time = start;
+    for(Int duration: {100, 10, 20, 30}) {
+        time += milliseconds{duration};
+        pacer.nextFrame(time);
+    }
+
+    /* The first frame fell out of the history */
+    CORRADE_COMPARE(pacer.frameCount(), 3);
+    CORRADE_COMPARE(pacer.frameDurationMax(), 0.03f);
+    CORRADE_COMPARE(pacer.frameDurationMean(), 0.02f);
+    CORRADE_COMPARE(pacer.frameDurationPercentile(0.5f), 0.02f);
+}
+
+void FramePacerTest::maxFrameDuration() {
+    const steady_clock::time_point start{};
+
+    FramePacer pacer{4};
+    pacer.setMaxFrameDuration(0.05f)
+         .start(start)
+         .nextFrame(start + milliseconds{10})
+         .nextFrame(start + milliseconds{20})
+         .nextFrame(start + milliseconds{30})
+         /* A one-second hitch */
+         .nextFrame(start + milliseconds{1030});
+
+    /* The raw duration is reported, but the history is clamped */
+    CORRADE_COMPARE(pacer.previousFrameDuration(), 1.0f);
+    CORRADE_COMPARE(pacer.frameDurationMax(), 0.05f);
+    CORRADE_COMPARE(pacer.smoothedFrameDuration(), 0.02f);
+}
+
+void FramePacerTest::refreshRateSnapping() {
+    const steady_clock::time_point start{};
+
+    /* Jittery frames with an average slightly off the 60 Hz period */
+    FramePacer pacer;
+    pacer.start(start);
+    steady_clock::time_point time = start;
+    for(Int duration: {16000, 17500, 16200, 17100}) {
+        time += microseconds{duration};
+        pacer.nextFrame(time);
+    }
+    CORRADE_COMPARE(pacer.frameDurationMean(), 0.0167f);
+    CORRADE_COMPARE(pacer.smoothedFrameDuration(), 0.0167f);
+
+    /* With the refresh rate set, it snaps to the period */
+    pacer.setRefreshRate(60.0f);
+    CORRADE_COMPARE(pacer.smoothedFrameDuration(), 1.0f/60.0f);
+
+    /* Also to multiples of the period if the frames take longer */
+    pacer.start(start);
+    time = start;
+    for(Int duration: {33000, 34000}) {
+        time += microseconds{duration};
+        pacer.nextFrame(time);
+    }
+    CORRADE_COMPARE(pacer.smoothedFrameDuration(), 2.0f/60.0f);
+
+    /* But not if it's too far */
+    pacer.start(start);
+    time = start;
+    for(Int duration: {25000, 25000}) {
+        time += microseconds{duration};
+        pacer.nextFrame(time);
+    }
+    CORRADE_COMPARE(pacer.smoothedFrameDuration(), 0.025f);
+}
+
+void FramePacerTest::percentileInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    FramePacer pacer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    pacer.frameDurationPercentile(1.5f);
+    CORRADE_COMPARE(out.str(), "FramePacer::frameDurationPercentile(): expected a value in the [0, 1] range, got 1.5\n");
+}
+
+void FramePacerTest::targetFrameRate() {
+    #ifdef CORRADE_TARGET_EMSCRIPTEN
+    CORRADE_SKIP("The target frame rate is ignored on Emscripten.");
+    #endif
+
+    FramePacer pacer;
+    pacer.setTargetFrameRate(100.0f)
+         .start();
+
+    const steady_clock::time_point start = steady_clock::now();
+    for(Int i = 0; i != 10; ++i)
+        pacer.nextFrame();
+    const Float elapsed = duration_cast<microseconds>(steady_clock::now() - start).count()/1.0e6f;
+
+    /* The frames don't do anything, so they should be paced to exactly
+       10 ms. Not checking the upper bound too strictly as CI machines can be
+       overloaded. */
+    CORRADE_COMPARE_AS(elapsed, 0.099f,
+        TestSuite::Compare::GreaterOrEqual);
+    CORRADE_COMPARE_AS(elapsed, 0.2f,
+        TestSuite::Compare::Less);
+    /* Individual frames may be shorter to compensate for a late frame, but
+       on average it should hit the target */
+    CORRADE_COMPARE_AS(pacer.frameDurationMean(), 0.0099f,
+        TestSuite::Compare::GreaterOrEqual);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Test::FramePacerTest)
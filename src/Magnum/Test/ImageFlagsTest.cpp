@@ -71,6 +71,7 @@ ImageFlagsTest::ImageFlagsTest() {
 
 void ImageFlagsTest::matchingValues() {
     CORRADE_COMPARE(UnsignedShort(ImageFlag3D::Array), UnsignedShort(ImageFlag2D::Array));
+    CORRADE_COMPARE(UnsignedShort(ImageFlag3D::YDown), UnsignedShort(ImageFlag2D::YDown));
 }
 
 void ImageFlagsTest::debugFlag1D() {
@@ -123,14 +124,14 @@ void ImageFlagsTest::debugFlags1D() {
 
 void ImageFlagsTest::debugFlags2D() {
     std::ostringstream out;
-    Debug{&out} << (ImageFlag2D::Array|ImageFlag2D(0xcafe)) << ImageFlags2D{};
-    CORRADE_COMPARE(out.str(), "ImageFlag2D::Array|ImageFlag2D(0xcafe) ImageFlags2D{}\n");
+    Debug{&out} << (ImageFlag2D::Array|ImageFlag2D::YDown|ImageFlag2D(0xcaf0)) << ImageFlags2D{};
+    CORRADE_COMPARE(out.str(), "ImageFlag2D::Array|ImageFlag2D::YDown|ImageFlag2D(0xcaf0) ImageFlags2D{}\n");
 }
 
 void ImageFlagsTest::debugFlags3D() {
     std::ostringstream out;
-    Debug{&out} << (ImageFlag3D::Array|ImageFlag3D::CubeMap |ImageFlag3D(0xcaf0)) << ImageFlags3D{};
-    CORRADE_COMPARE(out.str(), "ImageFlag3D::Array|ImageFlag3D::CubeMap|ImageFlag3D(0xcaf0) ImageFlags3D{}\n");
+    Debug{&out} << (ImageFlag3D::Array|ImageFlag3D::CubeMap|ImageFlag3D::YDown|ImageFlag3D(0xcaf0)) << ImageFlags3D{};
+    CORRADE_COMPARE(out.str(), "ImageFlag3D::Array|ImageFlag3D::CubeMap|ImageFlag3D::YDown|ImageFlag3D(0xcaf0) ImageFlags3D{}\n");
 }
 
 void ImageFlagsTest::debugFlags1DPacked() {
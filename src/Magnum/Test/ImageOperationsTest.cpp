@@ -0,0 +1,350 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageOperations.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Range.h"
+
+namespace Magnum { namespace Test { namespace {
+
+struct ImageOperationsTest: TestSuite::Tester {
+    explicit ImageOperationsTest();
+
+    void copy();
+    void copyContiguous();
+    void copyNewImage();
+    void copySizeMismatch();
+    void copyFormatMismatch();
+
+    void crop();
+    void cropMutable();
+    void cropNested();
+    void cropOutOfBounds();
+
+    void flipY();
+    void extractChannel();
+    void extractChannel16();
+    void extractChannel32();
+    void extractChannelSizeMismatch();
+    void extractChannelInvalidFormat();
+    void extractChannelOutOfRange();
+    void extractChannelPixelSizeMismatch();
+};
+
+const struct {
+    const char* name;
+    Int height;
+    UnsignedInt threadCount;
+} FlipData[]{
+    {"even row count", 4, 1},
+    {"odd row count", 5, 1},
+    /* 4 MB, enough to be split across threads */
+    {"large, four threads", 1024, 4}
+};
+
+ImageOperationsTest::ImageOperationsTest() {
+    addTests({&ImageOperationsTest::copy,
+              &ImageOperationsTest::copyContiguous,
+              &ImageOperationsTest::copyNewImage,
+              &ImageOperationsTest::copySizeMismatch,
+              &ImageOperationsTest::copyFormatMismatch,
+
+              &ImageOperationsTest::crop,
+              &ImageOperationsTest::cropMutable,
+              &ImageOperationsTest::cropNested,
+              &ImageOperationsTest::cropOutOfBounds});
+
+    addInstancedTests({&ImageOperationsTest::flipY},
+        Containers::arraySize(FlipData));
+
+    addTests({&ImageOperationsTest::extractChannel,
+              &ImageOperationsTest::extractChannel16,
+              &ImageOperationsTest::extractChannel32,
+              &ImageOperationsTest::extractChannelSizeMismatch,
+              &ImageOperationsTest::extractChannelInvalidFormat,
+              &ImageOperationsTest::extractChannelOutOfRange,
+              &ImageOperationsTest::extractChannelPixelSizeMismatch});
+}
+
+using namespace Math::Literals;
+
+void ImageOperationsTest::copy() {
+    /* The source rows are padded to four bytes, the destination not */
+    const char src[]{
+        1, 2, 3, 4, 5, 6, 0, 0,
+        7, 8, 9, 10, 11, 12, 0, 0
+    };
+    char dst[12]{};
+    copyImage(
+        ImageView2D{PixelFormat::RGB8Unorm, {2, 2}, src},
+        MutableImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::RGB8Unorm, {2, 2}, dst});
+    CORRADE_COMPARE_AS(Containers::arrayView(dst), Containers::arrayView<char>({
+        1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12
+    }), TestSuite::Compare::Container);
+}
+
+void ImageOperationsTest::copyContiguous() {
+    /* Large enough to be split across threads, all rows copied at once */
+    const Vector2i size{1024, 1024};
+    Containers::Array<Color4ub> src{NoInit, std::size_t(size.product())};
+    for(std::size_t i = 0; i != src.size(); ++i)
+        src[i] = {UnsignedByte(i), UnsignedByte(i >> 8), UnsignedByte(i >> 16), 255};
+
+    Containers::Array<Color4ub> dst{ValueInit, src.size()};
+    copyImage(
+        ImageView2D{PixelFormat::RGBA8Unorm, size, Containers::arrayView(src)},
+        MutableImageView2D{PixelFormat::RGBA8Unorm, size, Containers::arrayView(dst)}, 4);
+    CORRADE_COMPARE_AS(dst, src, TestSuite::Compare::Container);
+}
+
+void ImageOperationsTest::copyNewImage() {
+    const char src[]{
+        1, 2, 3, 4, 5, 6,
+        7, 8, 9, 10, 11, 12
+    };
+    Image2D image = copyImage(ImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::RGB8Unorm, {2, 2}, src});
+    CORRADE_COMPARE(image.storage().alignment(), 4);
+    CORRADE_COMPARE(image.format(), PixelFormat::RGB8Unorm);
+    CORRADE_COMPARE(image.size(), (Vector2i{2, 2}));
+    CORRADE_COMPARE(image.data().size(), 16);
+    CORRADE_COMPARE(image.pixels<Color3ub>()[1][0], (Color3ub{7, 8, 9}));
+    CORRADE_COMPARE(image.pixels<Color3ub>()[1][1], (Color3ub{10, 11, 12}));
+}
+
+void ImageOperationsTest::copySizeMismatch() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    char data[16];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    copyImage(
+        ImageView2D{PixelFormat::RGBA8Unorm, {2, 2}, data},
+        MutableImageView2D{PixelFormat::RGBA8Unorm, {4, 1}, data});
+    CORRADE_COMPARE(out.str(), "copyImage(): expected images of the same size, got {2, 2} and {4, 1}\n");
+}
+
+void ImageOperationsTest::copyFormatMismatch() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    char data[16];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    copyImage(
+        ImageView2D{PixelFormat::RGBA8Unorm, {2, 2}, data},
+        MutableImageView2D{PixelFormat::RGBA8Srgb, {2, 2}, data});
+    CORRADE_COMPARE(out.str(), "copyImage(): expected images of the same format, got PixelFormat::RGBA8Unorm and PixelFormat::RGBA8Srgb\n");
+}
+
+const UnsignedByte CropData[]{
+     0,  1,  2,  3,
+     4,  5,  6,  7,
+     8,  9, 10, 11,
+    12, 13, 14, 15
+};
+
+void ImageOperationsTest::crop() {
+    ImageView2D cropped = cropImage(ImageView2D{PixelFormat::R8Unorm, {4, 4}, CropData}, {{1, 1}, {3, 4}});
+    CORRADE_COMPARE(cropped.size(), (Vector2i{2, 3}));
+    CORRADE_COMPARE(cropped.storage().rowLength(), 4);
+    CORRADE_COMPARE(cropped.storage().skip(), (Vector3i{1, 1, 0}));
+    CORRADE_VERIFY(cropped.data().data() == static_cast<const void*>(CropData));
+
+    /* Copying it into a new image makes it tightly packed again */
+    Image2D image = copyImage(cropped);
+    CORRADE_COMPARE(image.storage().rowLength(), 0);
+    CORRADE_COMPARE(image.storage().skip(), Vector3i{});
+    CORRADE_COMPARE(image.pixels<UnsignedByte>()[0][0], 5);
+    CORRADE_COMPARE(image.pixels<UnsignedByte>()[0][1], 6);
+    CORRADE_COMPARE(image.pixels<UnsignedByte>()[2][0], 13);
+    CORRADE_COMPARE(image.pixels<UnsignedByte>()[2][1], 14);
+}
+
+void ImageOperationsTest::cropMutable() {
+    Color3ub data[3*2]{};
+    MutableImageView2D cropped = cropImage(MutableImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::RGB8Unorm, {3, 2}, data}, {{2, 1}, {3, 2}});
+    CORRADE_COMPARE(cropped.size(), (Vector2i{1, 1}));
+    cropped.pixels<Color3ub>()[0][0] = 0xff3366_rgb;
+    CORRADE_COMPARE(data[5], 0xff3366_rgb);
+}
+
+void ImageOperationsTest::cropNested() {
+    /* The skip accumulates, the row length stays */
+    ImageView2D cropped = cropImage(cropImage(ImageView2D{PixelFormat::R8Unorm, {4, 4}, CropData}, {{1, 1}, {4, 4}}), {{1, 0}, {2, 2}});
+    CORRADE_COMPARE(cropped.storage().rowLength(), 4);
+    CORRADE_COMPARE(cropped.storage().skip(), (Vector3i{2, 1, 0}));
+    CORRADE_COMPARE(cropped.size(), (Vector2i{1, 2}));
+    CORRADE_COMPARE(cropped.pixels<UnsignedByte>()[0][0], 6);
+    CORRADE_COMPARE(cropped.pixels<UnsignedByte>()[1][0], 10);
+}
+
+void ImageOperationsTest::cropOutOfBounds() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    cropImage(ImageView2D{PixelFormat::R8Unorm, {4, 4}, CropData}, {{1, 1}, {5, 3}});
+    CORRADE_COMPARE(out.str(), "cropImage(): range {1, 1} to {5, 3} out of bounds for an image of size {4, 4}\n");
+}
+
+void ImageOperationsTest::flipY() {
+    auto&& data = FlipData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const Vector2i size{1024, data.height};
+    Containers::Array<UnsignedInt> pixels{NoInit, std::size_t(size.product())};
+    for(std::size_t i = 0; i != pixels.size(); ++i)
+        pixels[i] = i;
+
+    flipImageY(MutableImageView2D{PixelFormat::RGBA8Unorm, size, Containers::arrayView(pixels)}, data.threadCount);
+
+    /* The middle row of an odd-sized image stays in place */
+    for(Int y = 0; y != size.y(); ++y) {
+        CORRADE_ITERATION(y);
+        const std::size_t flipped = size.y() - y - 1;
+        CORRADE_COMPARE(pixels[y*size.x()], UnsignedInt(flipped*size.x()));
+        CORRADE_COMPARE(pixels[y*size.x() + size.x() - 1], UnsignedInt(flipped*size.x() + size.x() - 1));
+    }
+}
+
+void ImageOperationsTest::extractChannel() {
+    /* Enough pixels to go through the vectorized kernel and have a
+       remainder processed by the scalar code */
+    constexpr std::size_t Count = 37;
+    Color4ub src[Count];
+    UnsignedByte expected[Count];
+    for(std::size_t i = 0; i != Count; ++i) {
+        src[i] = {UnsignedByte(i), UnsignedByte(i*2), UnsignedByte(i*3), UnsignedByte(i*4)};
+        expected[i] = UnsignedByte(i*3);
+    }
+
+    /* Linear alpha out of sRGB, the destination format isn't checked */
+    UnsignedByte dst[Count];
+    extractImageChannel(
+        ImageView2D{PixelFormat::RGBA8Srgb, {Count, 1}, src}, 2,
+        MutableImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::R8Unorm, {Count, 1}, dst});
+    CORRADE_COMPARE_AS(Containers::arrayView(dst), Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void ImageOperationsTest::extractChannel16() {
+    const Math::Vector4<UnsignedShort> src[]{
+        {1, 2, 3, 4},
+        {5, 6, 7, 8}
+    };
+    UnsignedShort dst[2];
+    extractImageChannel(
+        ImageView2D{PixelFormat::RGBA16Unorm, {2, 1}, src}, 3,
+        MutableImageView2D{PixelFormat::R16Unorm, {2, 1}, dst});
+    CORRADE_COMPARE_AS(Containers::arrayView(dst), Containers::arrayView<UnsignedShort>({
+        4, 8
+    }), TestSuite::Compare::Container);
+}
+
+void ImageOperationsTest::extractChannel32() {
+    const Vector2 src[]{
+        {1.0f, 2.0f},
+        {3.0f, 4.0f}
+    };
+    Float dst[2];
+    extractImageChannel(
+        ImageView2D{PixelFormat::RG32F, {1, 2}, src}, 0,
+        MutableImageView2D{PixelFormat::R32F, {1, 2}, dst});
+    CORRADE_COMPARE_AS(Containers::arrayView(dst), Containers::arrayView<Float>({
+        1.0f, 3.0f
+    }), TestSuite::Compare::Container);
+}
+
+void ImageOperationsTest::extractChannelSizeMismatch() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    char data[16];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    extractImageChannel(
+        ImageView2D{PixelFormat::RGBA8Unorm, {2, 2}, data}, 0,
+        MutableImageView2D{PixelFormat::R8Unorm, {4, 1}, data});
+    CORRADE_COMPARE(out.str(), "extractImageChannel(): expected images of the same size, got {2, 2} and {4, 1}\n");
+}
+
+void ImageOperationsTest::extractChannelInvalidFormat() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    char data[4];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    extractImageChannel(
+        ImageView2D{PixelStorage{}, 0x1234, 0, 4, {1, 1}, data}, 0,
+        MutableImageView2D{PixelFormat::R8Unorm, {1, 1}, data});
+    extractImageChannel(
+        ImageView2D{PixelFormat::Depth32F, {1, 1}, data}, 0,
+        MutableImageView2D{PixelFormat::R32F, {1, 1}, data});
+    CORRADE_COMPARE(out.str(),
+        "extractImageChannel(): can't extract a channel from PixelFormat::ImplementationSpecific(0x1234)\n"
+        "extractImageChannel(): can't extract a channel from PixelFormat::Depth32F\n");
+}
+
+void ImageOperationsTest::extractChannelOutOfRange() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    char data[4];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    extractImageChannel(
+        ImageView2D{PixelFormat::RGB8Unorm, {1, 1}, data}, 3,
+        MutableImageView2D{PixelFormat::R8Unorm, {1, 1}, data});
+    CORRADE_COMPARE(out.str(), "extractImageChannel(): index 3 out of range for 3 channels in PixelFormat::RGB8Unorm\n");
+}
+
+void ImageOperationsTest::extractChannelPixelSizeMismatch() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    char data[8];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    extractImageChannel(
+        ImageView2D{PixelFormat::RG16F, {1, 1}, data}, 1,
+        MutableImageView2D{PixelFormat::R8Unorm, {1, 1}, data});
+    CORRADE_COMPARE(out.str(), "extractImageChannel(): expected destination pixel size to be 2 but got 1\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Test::ImageOperationsTest)
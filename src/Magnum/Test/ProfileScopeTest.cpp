@@ -0,0 +1,267 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+#include <thread>
+#endif
+
+#include "Magnum/ProfileScope.h"
+
+namespace Magnum { namespace Test { namespace {
+
+struct ProfileScopeTest: TestSuite::Tester {
+    explicit ProfileScopeTest();
+
+    void noConsumer();
+    void nested();
+    void bufferFull();
+    void bufferFullNested();
+    #if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+    void threads();
+    #endif
+
+    void nullName();
+
+    void macro();
+};
+
+ProfileScopeTest::ProfileScopeTest() {
+    addTests({&ProfileScopeTest::noConsumer,
+              &ProfileScopeTest::nested,
+              &ProfileScopeTest::bufferFull,
+              &ProfileScopeTest::bufferFullNested,
+              #if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+              &ProfileScopeTest::threads,
+              #endif
+
+              &ProfileScopeTest::nullName,
+
+              &ProfileScopeTest::macro});
+}
+
+struct Event {
+    std::size_t thread;
+    Implementation::ProfileScopeEvent event;
+};
+
+Containers::Array<Event> consume() {
+    Containers::Array<Event> out;
+    Implementation::profileScopeConsume([](void* state, std::size_t thread, const Implementation::ProfileScopeEvent* events, std::size_t count) {
+        for(std::size_t i = 0; i != count; ++i)
+            arrayAppend(*static_cast<Containers::Array<Event>*>(state), Event{thread, events[i]});
+    }, &out);
+    return out;
+}
+
+/* Acquires the consumer for the duration of a test case and throws away
+   everything recorded before */
+struct Consumer {
+    explicit Consumer() {
+        Implementation::profileScopeAcquire();
+        consume();
+    }
+
+    ~Consumer() {
+        Implementation::profileScopeRelease();
+        consume();
+    }
+};
+
+void ProfileScopeTest::noConsumer() {
+    {
+        ProfileScope scope{"nothing"};
+        CORRADE_VERIFY(!scope.isRecorded());
+    }
+
+    CORRADE_COMPARE(consume().size(), 0);
+}
+
+void ProfileScopeTest::nested() {
+    Consumer consumer;
+
+    {
+        ProfileScope a{"a"};
+        CORRADE_VERIFY(a.isRecorded());
+        {
+            ProfileScope b{"b"};
+            CORRADE_VERIFY(b.isRecorded());
+        }
+    }
+
+    Containers::Array<Event> events = consume();
+    CORRADE_COMPARE(events.size(), 4);
+    CORRADE_COMPARE(Containers::StringView{events[0].event.name}, "a");
+    CORRADE_COMPARE(Containers::StringView{events[1].event.name}, "b");
+    CORRADE_VERIFY(!events[2].event.name);
+    CORRADE_VERIFY(!events[3].event.name);
+    for(std::size_t i = 1; i != events.size(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(events[i].thread, events[0].thread);
+        CORRADE_COMPARE_AS(events[i].event.time, events[i - 1].event.time,
+            TestSuite::Compare::GreaterOrEqual);
+    }
+
+    /* Everything got consumed */
+    CORRADE_COMPARE(consume().size(), 0);
+}
+
+void ProfileScopeTest::bufferFull() {
+    Consumer consumer;
+
+    /* Way more than fits into the buffer */
+    std::size_t recorded = 0;
+    for(std::size_t i = 0; i != 100000; ++i) {
+        ProfileScope scope{"scope"};
+        if(scope.isRecorded()) ++recorded;
+    }
+    CORRADE_COMPARE_AS(recorded, 0,
+        TestSuite::Compare::Greater);
+    CORRADE_COMPARE_AS(recorded, 100000,
+        TestSuite::Compare::Less);
+
+    /* All recorded scopes have both the begin and the end */
+    Containers::Array<Event> events = consume();
+    CORRADE_COMPARE(events.size(), recorded*2);
+    for(std::size_t i = 0; i != events.size(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(!events[i].event.name, i % 2 == 1);
+    }
+
+    /* After consuming the events there's space again */
+    ProfileScope scope{"scope"};
+    CORRADE_VERIFY(scope.isRecorded());
+}
+
+void ProfileScopeTest::bufferFullNested() {
+    Consumer consumer;
+
+    /* Open way more nested scopes than fits into the buffer, then close them
+       all */
+    std::size_t recorded = 0;
+    {
+        Containers::Array<Containers::Pointer<ProfileScope>> scopes;
+        for(std::size_t i = 0; i != 10000; ++i) {
+            arrayAppend(scopes, Containers::pointer<ProfileScope>("scope"));
+            if(scopes.back()->isRecorded()) ++recorded;
+        }
+        CORRADE_COMPARE_AS(recorded, 0,
+            TestSuite::Compare::Greater);
+        CORRADE_COMPARE_AS(recorded, 10000,
+            TestSuite::Compare::Less);
+
+        /* Close the scopes in reverse order */
+        while(!scopes.isEmpty()) arrayRemoveSuffix(scopes);
+    }
+
+    /* Even though the buffer was full, there was space reserved for the
+       ends of all recorded scopes */
+    Containers::Array<Event> events = consume();
+    CORRADE_COMPARE(events.size(), recorded*2);
+    for(std::size_t i = 0; i != events.size(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(!events[i].event.name, i >= recorded);
+    }
+}
+
+#if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+void ProfileScopeTest::threads() {
+    Consumer consumer;
+
+    {
+        ProfileScope mainScope{"main"};
+        std::thread thread{[]() {
+            ProfileScope threadScope{"thread"};
+            CORRADE_INTERNAL_ASSERT(threadScope.isRecorded());
+        }};
+        thread.join();
+    }
+
+    Containers::Array<Event> events = consume();
+    CORRADE_COMPARE(events.size(), 4);
+
+    std::size_t mainThread = ~std::size_t{}, otherThread = ~std::size_t{};
+    for(const Event& event: events) {
+        if(!event.event.name) continue;
+        if(Containers::StringView{event.event.name} == "main")
+            mainThread = event.thread;
+        else if(Containers::StringView{event.event.name} == "thread")
+            otherThread = event.thread;
+    }
+    CORRADE_VERIFY(mainThread != ~std::size_t{});
+    CORRADE_VERIFY(otherThread != ~std::size_t{});
+    CORRADE_VERIFY(mainThread != otherThread);
+
+    /* Each thread has its begin before its end */
+    for(std::size_t thread: {mainThread, otherThread}) {
+        CORRADE_ITERATION(thread);
+        Containers::Array<bool> isEnd;
+        for(const Event& event: events)
+            if(event.thread == thread) arrayAppend(isEnd, !event.event.name);
+        CORRADE_COMPARE(isEnd.size(), 2);
+        CORRADE_VERIFY(!isEnd[0]);
+        CORRADE_VERIFY(isEnd[1]);
+    }
+}
+#endif
+
+void ProfileScopeTest::nullName() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Consumer consumer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    ProfileScope scope{nullptr};
+    CORRADE_VERIFY(!scope.isRecorded());
+    CORRADE_COMPARE(out.str(), "ProfileScope: name can't be null\n");
+}
+
+void ProfileScopeTest::macro() {
+    Consumer consumer;
+
+    {
+        MAGNUM_PROFILE_SCOPE("macro");
+    }
+
+    /* With an external profiler backend the macro doesn't go through
+       ProfileScope */
+    #if defined(MAGNUM_BUILD_PROFILING) && !defined(MAGNUM_PROFILING_TRACY) && !defined(MAGNUM_PROFILING_ITT)
+    CORRADE_COMPARE(consume().size(), 2);
+    #else
+    CORRADE_COMPARE(consume().size(), 0);
+    #endif
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Test::ProfileScopeTest)
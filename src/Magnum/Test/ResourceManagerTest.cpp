@@ -25,10 +25,14 @@
 */
 
 #include <sstream>
+#include <string>
+#include <vector>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
 #include <Corrade/Utility/FormatStl.h>
 
 #include "Magnum/AbstractResourceLoader.h"
+#include "Magnum/AsyncResourceLoader.h"
 #include "Magnum/ResourceManager.h"
 
 namespace Magnum { namespace Test { namespace {
@@ -50,15 +54,24 @@ struct ResourceManagerTest: TestSuite::Tester {
     void residentPolicy();
     void referenceCountedPolicy();
     void manualPolicy();
+    void cachedPolicy();
+    void cachedPolicySetBudget();
     void defaults();
     void clear();
     void clearWhileReferenced();
+    void manyResources();
 
     void loader();
     void loaderSetNullptr();
+    void loaderAsync();
+    void loaderAsyncBudget();
+    void loaderAsyncStop();
 
     void debugResourceState();
     void debugResourceKey();
+
+    void benchmarkGet();
+    void benchmarkAccessMutable();
 };
 
 struct Data {
@@ -87,15 +100,24 @@ ResourceManagerTest::ResourceManagerTest() {
               &ResourceManagerTest::residentPolicy,
               &ResourceManagerTest::referenceCountedPolicy,
               &ResourceManagerTest::manualPolicy,
+              &ResourceManagerTest::cachedPolicy,
+              &ResourceManagerTest::cachedPolicySetBudget,
               &ResourceManagerTest::defaults,
               &ResourceManagerTest::clear,
               &ResourceManagerTest::clearWhileReferenced,
+              &ResourceManagerTest::manyResources,
 
               &ResourceManagerTest::loader,
               &ResourceManagerTest::loaderSetNullptr,
+              &ResourceManagerTest::loaderAsync,
+              &ResourceManagerTest::loaderAsyncBudget,
+              &ResourceManagerTest::loaderAsyncStop,
 
               &ResourceManagerTest::debugResourceState,
               &ResourceManagerTest::debugResourceKey});
+
+    addBenchmarks({&ResourceManagerTest::benchmarkGet,
+                   &ResourceManagerTest::benchmarkAccessMutable}, 50);
 }
 
 void ResourceManagerTest::constructResource() {
@@ -388,6 +410,105 @@ void ResourceManagerTest::manualPolicy() {
     CORRADE_COMPARE(Data::count, 1);
 }
 
+void ResourceManagerTest::cachedPolicy() {
+    ResourceManager rm;
+
+    /* Resources that weren't acquired yet count towards the budget */
+    rm.set("a", Containers::pointer<Data>(), ResourceDataState::Final, ResourcePolicy::Cached, 60);
+    rm.set("b", Containers::pointer<Data>(), ResourceDataState::Final, ResourcePolicy::Cached, 70);
+    CORRADE_COMPARE(rm.count<Data>(), 2);
+    CORRADE_COMPARE(rm.cachedSize<Data>(), 130);
+    CORRADE_COMPARE(Data::count, 2);
+
+    /* Acquiring removes them from the cache */
+    {
+        Resource<Data> a = rm.get<Data>("a");
+        Resource<Data> b = rm.get<Data>("b");
+        CORRADE_COMPARE(rm.cachedSize<Data>(), 0);
+
+        rm.setCacheBudget<Data>(100);
+        CORRADE_COMPARE(rm.cacheBudget<Data>(), 100);
+        CORRADE_COMPARE(rm.cacheBudget<Int>(), ~std::size_t{});
+        CORRADE_COMPARE(Data::count, 2);
+
+        /* Resource released, stays in the cache */
+        b = Resource<Data>{};
+        CORRADE_COMPARE(rm.cachedSize<Data>(), 70);
+        CORRADE_COMPARE(rm.count<Data>(), 2);
+        CORRADE_COMPARE(Data::count, 2);
+    }
+
+    /* Released the second, the cache is over budget and the least recently
+       released one gets evicted */
+    CORRADE_COMPARE(rm.cachedSize<Data>(), 60);
+    CORRADE_COMPARE(rm.count<Data>(), 1);
+    CORRADE_COMPARE(Data::count, 1);
+    CORRADE_COMPARE(rm.state<Data>("a"), ResourceState::Final);
+    CORRADE_COMPARE(rm.state<Data>("b"), ResourceState::NotLoaded);
+
+    /* Acquiring and releasing a cached resource again doesn't unload it */
+    {
+        Resource<Data> a = rm.get<Data>("a");
+        CORRADE_COMPARE(a.state(), ResourceState::Final);
+        CORRADE_COMPARE(rm.cachedSize<Data>(), 0);
+    }
+    CORRADE_COMPARE(rm.cachedSize<Data>(), 60);
+    CORRADE_COMPARE(Data::count, 1);
+
+    /* A resource that was just set evicts older ones but not itself, even
+       though it's over the budget alone */
+    rm.set("b", Containers::pointer<Data>(), ResourceDataState::Final, ResourcePolicy::Cached, 150);
+    CORRADE_COMPARE(rm.cachedSize<Data>(), 150);
+    CORRADE_COMPARE(rm.state<Data>("a"), ResourceState::NotLoaded);
+    CORRADE_COMPARE(rm.state<Data>("b"), ResourceState::Final);
+    CORRADE_COMPARE(Data::count, 1);
+
+    /* Which happens once it's acquired and released */
+    rm.get<Data>("b");
+    CORRADE_COMPARE(rm.cachedSize<Data>(), 0);
+    CORRADE_COMPARE(rm.count<Data>(), 0);
+    CORRADE_COMPARE(Data::count, 0);
+
+    /* Changing the policy removes it from the cache */
+    rm.set("a", Containers::pointer<Data>(), ResourceDataState::Final, ResourcePolicy::Cached, 60);
+    CORRADE_COMPARE(rm.cachedSize<Data>(), 60);
+    rm.set("a", Containers::pointer<Data>(), ResourceDataState::Final, ResourcePolicy::Manual);
+    CORRADE_COMPARE(rm.cachedSize<Data>(), 0);
+    CORRADE_COMPARE(Data::count, 1);
+
+    /* Cached resources are freed by free() as well */
+    rm.set("c", Containers::pointer<Data>(), ResourceDataState::Final, ResourcePolicy::Cached, 10);
+    CORRADE_COMPARE(rm.cachedSize<Data>(), 10);
+    CORRADE_COMPARE(Data::count, 2);
+    rm.free<Data>();
+    CORRADE_COMPARE(rm.cachedSize<Data>(), 0);
+    CORRADE_COMPARE(rm.count<Data>(), 0);
+    CORRADE_COMPARE(Data::count, 0);
+}
+
+void ResourceManagerTest::cachedPolicySetBudget() {
+    ResourceManager rm;
+    rm.set("a", Containers::pointer<Data>(), ResourceDataState::Final, ResourcePolicy::Cached, 30);
+    rm.set("b", Containers::pointer<Data>(), ResourceDataState::Final, ResourcePolicy::Cached, 40);
+    rm.set("c", Containers::pointer<Data>(), ResourceDataState::Final, ResourcePolicy::Cached, 50);
+
+    /* Unlimited budget by default */
+    CORRADE_COMPARE(rm.cachedSize<Data>(), 120);
+    CORRADE_COMPARE(Data::count, 3);
+
+    /* Lowering the budget evicts the oldest until it fits */
+    rm.setCacheBudget<Data>(90);
+    CORRADE_COMPARE(rm.cachedSize<Data>(), 90);
+    CORRADE_COMPARE(rm.state<Data>("a"), ResourceState::NotLoaded);
+    CORRADE_COMPARE(rm.state<Data>("b"), ResourceState::Final);
+    CORRADE_COMPARE(rm.state<Data>("c"), ResourceState::Final);
+
+    rm.setCacheBudget<Data>(0);
+    CORRADE_COMPARE(rm.cachedSize<Data>(), 0);
+    CORRADE_COMPARE(rm.count<Data>(), 0);
+    CORRADE_COMPARE(Data::count, 0);
+}
+
 void ResourceManagerTest::defaults() {
     ResourceManager rm;
     rm.set("data", Containers::pointer<Data>());
@@ -426,6 +547,51 @@ void ResourceManagerTest::clearWhileReferenced() {
     CORRADE_COMPARE(out.str(), "ResourceManager: cleared/destroyed while data are still referenced\n");
 }
 
+void ResourceManagerTest::manyResources() {
+    ResourceManager rm;
+
+    /* Enough resources to cause the storage to grow several times */
+    for(Int i = 0; i != 1000; ++i)
+        rm.set(std::to_string(i), i, ResourceDataState::Final, ResourcePolicy::ReferenceCounted);
+    CORRADE_COMPARE(rm.count<Int>(), 1000);
+
+    {
+        /* Resources acquired before the storage grows point to the right data
+           afterwards */
+        Resource<Int> first = rm.get<Int>("0");
+        for(Int i = 1000; i != 2000; ++i)
+            rm.set(std::to_string(i), i, ResourceDataState::Mutable, ResourcePolicy::ReferenceCounted);
+        CORRADE_COMPARE(*first, 0);
+
+        /* Acquire and immediately release every odd one, which removes it */
+        for(Int i = 1; i < 2000; i += 2)
+            rm.get<Int>(std::to_string(i));
+        CORRADE_COMPARE(rm.count<Int>(), 1000);
+        CORRADE_COMPARE(rm.state<Int>("1"), ResourceState::NotLoaded);
+        CORRADE_COMPARE(rm.state<Int>("1999"), ResourceState::NotLoaded);
+
+        /* The remaining ones are still found */
+        for(Int i = 0; i < 2000; i += 2) {
+            CORRADE_ITERATION(i);
+            Resource<Int> r = rm.get<Int>(std::to_string(i));
+            CORRADE_VERIFY(r);
+            CORRADE_COMPARE(*r, i);
+        }
+        CORRADE_COMPARE(rm.count<Int>(), 1);
+
+        /* Removed slots get reused, the existing resource isn't affected */
+        for(Int i = 0; i != 1000; ++i)
+            rm.set(std::to_string(i + 5000), i, ResourceDataState::Final, ResourcePolicy::Manual);
+        CORRADE_COMPARE(rm.count<Int>(), 1001);
+        CORRADE_COMPARE(*first, 0);
+        CORRADE_COMPARE(*rm.get<Int>("5999"), 999);
+    }
+
+    CORRADE_COMPARE(rm.count<Int>(), 1000);
+    rm.free<Int>();
+    CORRADE_COMPARE(rm.count<Int>(), 0);
+}
+
 void ResourceManagerTest::loader() {
     class IntResourceLoader: public AbstractResourceLoader<Int> {
         public:
@@ -530,6 +696,106 @@ void ResourceManagerTest::loaderSetNullptr() {
     CORRADE_COMPARE(*world, 42);
 }
 
+/* Decodes "hello" and "world" to their length, uploads only the even-length
+   ones */
+class AsyncIntResourceLoader: public AsyncResourceLoader<Int, std::size_t> {
+    public:
+        using AsyncResourceLoader<Int, std::size_t>::AsyncResourceLoader;
+
+    private:
+        Containers::Optional<std::size_t> doDecode(ResourceKey key) override {
+            if(key == ResourceKey{"hello"}) return std::size_t{5};
+            if(key == ResourceKey{"world!"}) return std::size_t{6};
+            return {};
+        }
+
+        Containers::Pointer<Int> doUpload(ResourceKey, std::size_t&& data) override {
+            if(data % 2) return {};
+            return Containers::pointer<Int>(Int(data));
+        }
+};
+
+void ResourceManagerTest::loaderAsync() {
+    ResourceManager rm;
+    Containers::Pointer<AsyncIntResourceLoader> loaderPtr{InPlaceInit, 2u};
+    AsyncIntResourceLoader& loader = *loaderPtr;
+    rm.setLoader<Int>(std::move(loaderPtr));
+    #if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+    CORRADE_COMPARE(loader.threadCount(), 2);
+    #else
+    CORRADE_COMPARE(loader.threadCount(), 0);
+    #endif
+
+    /* Nothing to do yet */
+    CORRADE_COMPARE(rm.update(), 0);
+
+    Resource<Int> hello = rm.get<Int>("hello");
+    Resource<Int> world = rm.get<Int>("world!");
+    Resource<Int> nonexistent = rm.get<Int>("nonexistent");
+    CORRADE_COMPARE(hello.state(), ResourceState::Loading);
+    CORRADE_COMPARE(world.state(), ResourceState::Loading);
+    CORRADE_COMPARE(nonexistent.state(), ResourceState::Loading);
+    CORRADE_COMPARE(loader.requestedCount(), 3);
+    CORRADE_COMPARE(loader.pendingCount(), 3);
+
+    /* The states change only in update(), spin until the workers are done */
+    std::size_t count = 0;
+    while(loader.pendingCount())
+        count += rm.update();
+    CORRADE_COMPARE(count, 3);
+
+    /* Odd length gets rejected by the upload, unknown key by the decode */
+    CORRADE_COMPARE(hello.state(), ResourceState::NotFound);
+    CORRADE_COMPARE(world.state(), ResourceState::Final);
+    CORRADE_COMPARE(*world, 6);
+    CORRADE_COMPARE(nonexistent.state(), ResourceState::NotFound);
+    CORRADE_COMPARE(loader.loadedCount(), 1);
+    CORRADE_COMPARE(loader.notFoundCount(), 2);
+}
+
+void ResourceManagerTest::loaderAsyncBudget() {
+    ResourceManager rm;
+    Containers::Pointer<AsyncIntResourceLoader> loaderPtr{InPlaceInit};
+    AsyncIntResourceLoader& loader = *loaderPtr;
+    rm.setLoader<Int>(std::move(loaderPtr));
+
+    Resource<Int> hello = rm.get<Int>("hello");
+    Resource<Int> world = rm.get<Int>("world!");
+    Resource<Int> nonexistent = rm.get<Int>("nonexistent");
+
+    /* With a tiny budget there's exactly one resource processed in each
+       update() once the data are decoded */
+    while(loader.pendingCount())
+        CORRADE_COMPARE_AS(rm.update(std::chrono::nanoseconds{1}), 1,
+            TestSuite::Compare::LessOrEqual);
+
+    CORRADE_COMPARE(world.state(), ResourceState::Final);
+    CORRADE_COMPARE(*world, 6);
+}
+
+void ResourceManagerTest::loaderAsyncStop() {
+    ResourceManager rm;
+    Containers::Pointer<AsyncIntResourceLoader> loaderPtr{InPlaceInit};
+    AsyncIntResourceLoader& loader = *loaderPtr;
+    rm.setLoader<Int>(std::move(loaderPtr));
+
+    Resource<Int> hello = rm.get<Int>("hello");
+    CORRADE_COMPARE(loader.pendingCount(), 1);
+
+    /* The request is discarded and the resource stays in the loading state */
+    loader.stop();
+    CORRADE_COMPARE(loader.pendingCount(), 0);
+    CORRADE_COMPARE(rm.update(), 0);
+    CORRADE_COMPARE(hello.state(), ResourceState::Loading);
+
+    /* Requests after stop() restart the workers */
+    Resource<Int> world = rm.get<Int>("world!");
+    while(loader.pendingCount())
+        rm.update();
+    CORRADE_COMPARE(world.state(), ResourceState::Final);
+    CORRADE_COMPARE(*world, 6);
+}
+
 void ResourceManagerTest::debugResourceState() {
     std::ostringstream out;
     Debug{&out} << ResourceState::Loading << ResourceState(0xbe);
@@ -543,6 +809,43 @@ void ResourceManagerTest::debugResourceKey() {
     CORRADE_COMPARE(out.str(), Utility::formatString("ResourceKey(0x{})\n", hello.hexString()));
 }
 
+void ResourceManagerTest::benchmarkGet() {
+    ResourceManager rm;
+    std::vector<ResourceKey> keys;
+    for(Int i = 0; i != 1000; ++i) {
+        keys.emplace_back(std::to_string(i));
+        rm.set(keys.back(), i);
+    }
+
+    Int sum = 0;
+    CORRADE_BENCHMARK(10) {
+        for(const ResourceKey& key: keys)
+            sum += *rm.get<Int>(key);
+    }
+
+    CORRADE_COMPARE(sum, 10*999*1000/2);
+}
+
+void ResourceManagerTest::benchmarkAccessMutable() {
+    ResourceManager rm;
+    std::vector<Resource<Int>> resources;
+    for(Int i = 0; i != 1000; ++i) {
+        rm.set(std::to_string(i), i, ResourceDataState::Mutable, ResourcePolicy::Manual);
+        resources.push_back(rm.get<Int>(std::to_string(i)));
+    }
+
+    /* Mutable resources look the data up again each time anything in the
+       manager changes */
+    Int sum = 0;
+    CORRADE_BENCHMARK(10) {
+        rm.setFallback<Int>(nullptr);
+        for(Resource<Int>& resource: resources)
+            sum += *resource;
+    }
+
+    CORRADE_COMPARE(sum, 10*999*1000/2);
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Test::ResourceManagerTest)
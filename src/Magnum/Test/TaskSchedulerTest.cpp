@@ -0,0 +1,398 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <atomic>
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/TaskScheduler.h"
+#include "Magnum/Implementation/parallelFor.h"
+
+namespace Magnum { namespace Test { namespace {
+
+struct TaskSchedulerTest: TestSuite::Tester {
+    explicit TaskSchedulerTest();
+
+    void threadCount();
+    void run();
+    void runEmpty();
+    void runSingle();
+    void runNested();
+    void runNullTask();
+    void parallelFor();
+    void parallelForMoreTasksThanItems();
+
+    void global();
+    void globalCustom();
+
+    void graph();
+    void graphEmpty();
+    void graphRunTwice();
+    void graphDependencyOutOfRange();
+    void graphDependencySelf();
+    void graphCycle();
+};
+
+const struct {
+    const char* name;
+    UnsignedInt threadCount;
+} ThreadCountData[]{
+    {"single thread", 1},
+    {"two threads", 2},
+    {"eight threads", 8},
+};
+
+TaskSchedulerTest::TaskSchedulerTest() {
+    addTests({&TaskSchedulerTest::threadCount});
+
+    addInstancedTests({&TaskSchedulerTest::run},
+        Containers::arraySize(ThreadCountData));
+
+    addTests({&TaskSchedulerTest::runEmpty,
+              &TaskSchedulerTest::runSingle});
+
+    addInstancedTests({&TaskSchedulerTest::runNested,
+                       &TaskSchedulerTest::parallelFor},
+        Containers::arraySize(ThreadCountData));
+
+    addTests({&TaskSchedulerTest::runNullTask,
+              &TaskSchedulerTest::parallelForMoreTasksThanItems,
+
+              &TaskSchedulerTest::global,
+              &TaskSchedulerTest::globalCustom});
+
+    addInstancedTests({&TaskSchedulerTest::graph},
+        Containers::arraySize(ThreadCountData));
+
+    addTests({&TaskSchedulerTest::graphEmpty,
+              &TaskSchedulerTest::graphRunTwice,
+              &TaskSchedulerTest::graphDependencyOutOfRange,
+              &TaskSchedulerTest::graphDependencySelf,
+              &TaskSchedulerTest::graphCycle});
+}
+
+/* Counts how many times each index was executed */
+void countTask(void* state, const std::size_t i) {
+    ++static_cast<std::atomic<Int>*>(state)[i];
+}
+
+void TaskSchedulerTest::threadCount() {
+    ThreadPoolTaskScheduler three{3};
+    ThreadPoolTaskScheduler all;
+    #if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+    CORRADE_COMPARE(three.threadCount(), 3);
+    #else
+    CORRADE_COMPARE(three.threadCount(), 1);
+    #endif
+    CORRADE_VERIFY(all.threadCount() >= 1);
+}
+
+void TaskSchedulerTest::run() {
+    auto&& data = ThreadCountData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    ThreadPoolTaskScheduler scheduler{data.threadCount};
+
+    std::atomic<Int> counts[1000]{};
+    scheduler.run(Containers::arraySize(counts), countTask, counts);
+    for(std::size_t i = 0; i != Containers::arraySize(counts); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(counts[i].load(), 1);
+    }
+}
+
+void TaskSchedulerTest::runEmpty() {
+    ThreadPoolTaskScheduler scheduler{4};
+
+    /* Shouldn't call the task at all */
+    std::atomic<Int> counts[1]{};
+    scheduler.run(0, countTask, counts);
+    CORRADE_COMPARE(counts[0].load(), 0);
+}
+
+void TaskSchedulerTest::runSingle() {
+    ThreadPoolTaskScheduler scheduler{4};
+
+    std::atomic<Int> counts[1]{};
+    scheduler.run(1, countTask, counts);
+    CORRADE_COMPARE(counts[0].load(), 1);
+}
+
+void TaskSchedulerTest::runNested() {
+    auto&& data = ThreadCountData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    ThreadPoolTaskScheduler scheduler{data.threadCount};
+
+    /* Each outer task runs an inner batch on the same scheduler, which
+       shouldn't deadlock even if all threads are busy with outer tasks */
+    struct State {
+        ThreadPoolTaskScheduler& scheduler;
+        std::atomic<Int> counts[16][64];
+    } state{scheduler, {}};
+    scheduler.run(16, [](void* state, const std::size_t i) {
+        State& s = *static_cast<State*>(state);
+        s.scheduler.run(64, countTask, s.counts[i]);
+    }, &state);
+
+    for(std::size_t i = 0; i != 16; ++i) for(std::size_t j = 0; j != 64; ++j) {
+        CORRADE_ITERATION(i);
+        CORRADE_ITERATION(j);
+        CORRADE_COMPARE(state.counts[i][j].load(), 1);
+    }
+}
+
+void TaskSchedulerTest::runNullTask() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    ThreadPoolTaskScheduler scheduler{1};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    scheduler.run(3, nullptr, nullptr);
+    CORRADE_COMPARE(out.str(), "TaskScheduler::run(): task can't be null\n");
+}
+
+void TaskSchedulerTest::parallelFor() {
+    auto&& data = ThreadCountData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    ThreadPoolTaskScheduler scheduler{data.threadCount};
+
+    std::atomic<Int> counts[1003]{};
+    std::atomic<Int> ranges{};
+    scheduler.parallelFor(Containers::arraySize(counts), 0, [&](const std::size_t begin, const std::size_t end) {
+        ++ranges;
+        for(std::size_t i = begin; i != end; ++i)
+            ++counts[i];
+    });
+    for(std::size_t i = 0; i != Containers::arraySize(counts); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(counts[i].load(), 1);
+    }
+
+    /* Split into exactly as many ranges as there are threads */
+    CORRADE_COMPARE(ranges.load(), scheduler.threadCount());
+}
+
+void TaskSchedulerTest::parallelForMoreTasksThanItems() {
+    ThreadPoolTaskScheduler scheduler{4};
+
+    std::atomic<Int> counts[3]{};
+    std::atomic<Int> ranges{};
+    scheduler.parallelFor(Containers::arraySize(counts), 16, [&](const std::size_t begin, const std::size_t end) {
+        CORRADE_COMPARE(end - begin, 1);
+        ++ranges;
+        ++counts[begin];
+    });
+    CORRADE_COMPARE(ranges.load(), 3);
+    CORRADE_COMPARE(counts[0].load(), 1);
+    CORRADE_COMPARE(counts[1].load(), 1);
+    CORRADE_COMPARE(counts[2].load(), 1);
+}
+
+void TaskSchedulerTest::global() {
+    /* The builtin scheduler is returned by default and also after resetting
+       a custom one */
+    TaskScheduler& builtin = TaskScheduler::global();
+    CORRADE_VERIFY(dynamic_cast<ThreadPoolTaskScheduler*>(&builtin));
+
+    ThreadPoolTaskScheduler custom{2};
+    TaskScheduler::setGlobal(&custom);
+    CORRADE_COMPARE(&TaskScheduler::global(), &custom);
+
+    TaskScheduler::setGlobal(nullptr);
+    CORRADE_COMPARE(&TaskScheduler::global(), &builtin);
+}
+
+void TaskSchedulerTest::globalCustom() {
+    /* A sequential scheduler recording how many times it was called */
+    struct CustomTaskScheduler: TaskScheduler {
+        UnsignedInt doThreadCount() const override { return 5; }
+        void doRun(std::size_t count, void(*task)(void*, std::size_t), void* state) override {
+            ++runCount;
+            taskCount += count;
+            for(std::size_t i = 0; i != count; ++i)
+                task(state, i);
+        }
+
+        Int runCount = 0;
+        std::size_t taskCount = 0;
+    } scheduler;
+    TaskScheduler::setGlobal(&scheduler);
+
+    /* The internal helper used by library algorithms should go through it,
+       with a zero thread count picking the scheduler thread count */
+    std::atomic<Int> counts[100]{};
+    Implementation::parallelFor(Containers::arraySize(counts), 0, [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t i = begin; i != end; ++i)
+            ++counts[i];
+    });
+    TaskScheduler::setGlobal(nullptr);
+
+    CORRADE_COMPARE(scheduler.runCount, 1);
+    CORRADE_COMPARE(scheduler.taskCount, 5);
+    for(std::size_t i = 0; i != Containers::arraySize(counts); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(counts[i].load(), 1);
+    }
+}
+
+struct GraphState {
+    std::atomic<Int> finished{};
+    /* Order in which each task finished */
+    Int order[6];
+};
+
+struct GraphTask {
+    GraphState* state;
+    std::size_t id;
+};
+
+void graphTask(void* task) {
+    GraphTask& t = *static_cast<GraphTask*>(task);
+    t.state->order[t.id] = t.state->finished++;
+}
+
+void TaskSchedulerTest::graph() {
+    auto&& data = ThreadCountData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    ThreadPoolTaskScheduler scheduler{data.threadCount};
+
+    GraphState state;
+    GraphTask tasks[6];
+    TaskGraph graph;
+    for(std::size_t i = 0; i != 6; ++i) {
+        tasks[i] = {&state, i};
+        CORRADE_COMPARE(graph.addTask(graphTask, &tasks[i]), i);
+    }
+    CORRADE_COMPARE(graph.taskCount(), 6);
+
+    /*  0   1
+         \ / \
+          2   3
+          |   |
+          4   |
+           \ /
+            5   */
+    graph.addDependency(2, 0)
+         .addDependency(2, 1)
+         .addDependency(3, 1)
+         .addDependency(4, 2)
+         .addDependency(5, 4)
+         .addDependency(5, 3);
+    graph.run(scheduler);
+
+    CORRADE_COMPARE(state.finished.load(), 6);
+    CORRADE_COMPARE_AS(state.order[2], state.order[0], TestSuite::Compare::Greater);
+    CORRADE_COMPARE_AS(state.order[2], state.order[1], TestSuite::Compare::Greater);
+    CORRADE_COMPARE_AS(state.order[3], state.order[1], TestSuite::Compare::Greater);
+    CORRADE_COMPARE_AS(state.order[4], state.order[2], TestSuite::Compare::Greater);
+    CORRADE_COMPARE(state.order[5], 5);
+}
+
+void TaskSchedulerTest::graphEmpty() {
+    TaskGraph graph;
+    CORRADE_COMPARE(graph.taskCount(), 0);
+
+    /* Shouldn't crash or assert */
+    graph.run();
+    CORRADE_VERIFY(true);
+}
+
+void TaskSchedulerTest::graphRunTwice() {
+    std::atomic<Int> counts[2]{};
+    TaskGraph graph;
+    graph.addTask([](void* state) {
+        ++*static_cast<std::atomic<Int>*>(state);
+    }, &counts[0]);
+    graph.addTask([](void* state) {
+        ++*static_cast<std::atomic<Int>*>(state);
+    }, &counts[1]);
+    graph.addDependency(1, 0);
+
+    graph.run();
+    graph.run();
+    CORRADE_COMPARE(counts[0].load(), 2);
+    CORRADE_COMPARE(counts[1].load(), 2);
+}
+
+void TaskSchedulerTest::graphDependencyOutOfRange() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    TaskGraph graph;
+    graph.addTask([](void*) {}, nullptr);
+    graph.addTask([](void*) {}, nullptr);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    graph.addDependency(2, 0);
+    graph.addDependency(1, 2);
+    CORRADE_COMPARE(out.str(),
+        "TaskGraph::addDependency(): index 2 or 0 out of range for 2 tasks\n"
+        "TaskGraph::addDependency(): index 1 or 2 out of range for 2 tasks\n");
+}
+
+void TaskSchedulerTest::graphDependencySelf() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    TaskGraph graph;
+    graph.addTask([](void*) {}, nullptr);
+    graph.addTask([](void*) {}, nullptr);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    graph.addDependency(1, 1);
+    CORRADE_COMPARE(out.str(), "TaskGraph::addDependency(): task 1 can't depend on itself\n");
+}
+
+void TaskSchedulerTest::graphCycle() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Int called = 0;
+    TaskGraph graph;
+    for(std::size_t i = 0; i != 3; ++i) graph.addTask([](void* state) {
+        ++*static_cast<Int*>(state);
+    }, &called);
+    graph.addDependency(1, 0)
+         .addDependency(2, 1)
+         .addDependency(1, 2);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    graph.run();
+    CORRADE_COMPARE(out.str(), "TaskGraph::run(): the dependencies contain a cycle\n");
+
+    /* Nothing should be executed if there's a cycle */
+    CORRADE_COMPARE(called, 0);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Test::TaskSchedulerTest)
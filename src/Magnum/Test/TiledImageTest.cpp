@@ -0,0 +1,435 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/TiledImage.h"
+#include "Magnum/Math/Color.h"
+
+namespace Magnum { namespace Test { namespace {
+
+struct TiledImageTest: TestSuite::Tester {
+    explicit TiledImageTest();
+
+    void construct();
+    void constructImplementationSpecificFormat();
+    void constructZeroTileSize();
+    void constructMove();
+
+    void tileRange();
+    void tilesCovering();
+    void tilesCoveringOutOfBounds();
+
+    void mutableTile();
+    void tileNotAllocated();
+    void tileOutOfRange();
+
+    void setSubImage();
+    void setSubImageFullTile();
+    void setSubImageFormatMismatch();
+    void setSubImageOutOfBounds();
+
+    void subImage();
+    void subImageEmptyUniform();
+    void subImageIntoSizeMismatch();
+
+    void compact();
+    void compactZero();
+    void release();
+
+    void debugTileState();
+};
+
+TiledImageTest::TiledImageTest() {
+    addTests({&TiledImageTest::construct,
+              &TiledImageTest::constructImplementationSpecificFormat,
+              &TiledImageTest::constructZeroTileSize,
+              &TiledImageTest::constructMove,
+
+              &TiledImageTest::tileRange,
+              &TiledImageTest::tilesCovering,
+              &TiledImageTest::tilesCoveringOutOfBounds,
+
+              &TiledImageTest::mutableTile,
+              &TiledImageTest::tileNotAllocated,
+              &TiledImageTest::tileOutOfRange,
+
+              &TiledImageTest::setSubImage,
+              &TiledImageTest::setSubImageFullTile,
+              &TiledImageTest::setSubImageFormatMismatch,
+              &TiledImageTest::setSubImageOutOfBounds,
+
+              &TiledImageTest::subImage,
+              &TiledImageTest::subImageEmptyUniform,
+              &TiledImageTest::subImageIntoSizeMismatch,
+
+              &TiledImageTest::compact,
+              &TiledImageTest::compactZero,
+              &TiledImageTest::release,
+
+              &TiledImageTest::debugTileState});
+}
+
+/* A 10x7 RGB image with unique pixel values */
+Image2D gradient() {
+    Image2D image{PixelFormat::RGB8Unorm, {10, 7}, Containers::Array<char>{NoInit, 32*7}};
+    const Containers::StridedArrayView2D<Color3ub> pixels = image.pixels<Color3ub>();
+    for(Int y = 0; y != 7; ++y) for(Int x = 0; x != 10; ++x)
+        pixels[y][x] = {UnsignedByte(x), UnsignedByte(y), UnsignedByte(x*10 + y)};
+    return image;
+}
+
+void TiledImageTest::construct() {
+    TiledImage2D image{PixelFormat::RGB8Unorm, {10, 7}, {4, 3}};
+    CORRADE_COMPARE(image.format(), PixelFormat::RGB8Unorm);
+    CORRADE_COMPARE(image.pixelSize(), 3);
+    CORRADE_COMPARE(image.size(), (Vector2i{10, 7}));
+    CORRADE_COMPARE(image.tileSize(), (Vector2i{4, 3}));
+    CORRADE_COMPARE(image.tileCount(), (Vector2i{3, 3}));
+    CORRADE_COMPARE(image.dataSize(), 0);
+    for(Int y = 0; y != 3; ++y) for(Int x = 0; x != 3; ++x) {
+        CORRADE_ITERATION(Vector2i(x, y));
+        CORRADE_COMPARE(image.tileState({x, y}), TiledImageTileState::Empty);
+    }
+}
+
+void TiledImageTest::constructImplementationSpecificFormat() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    TiledImage2D{pixelFormatWrap(0xdead), {10, 7}, {4, 3}};
+    CORRADE_COMPARE(out.str(), "TiledImage2D: can't use an implementation-specific pixel format 0xdead\n");
+}
+
+void TiledImageTest::constructZeroTileSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    TiledImage2D{PixelFormat::RGB8Unorm, {10, 7}, {4, 0}};
+    CORRADE_COMPARE(out.str(), "TiledImage2D: expected a positive tile size, got {4, 0}\n");
+}
+
+void TiledImageTest::constructMove() {
+    TiledImage2D a{PixelFormat::R8Unorm, {10, 7}, {4, 3}};
+    a.mutableTile({1, 2}).pixels<UnsignedByte>()[0][0] = 0x37;
+
+    TiledImage2D b = std::move(a);
+    CORRADE_COMPARE(b.size(), (Vector2i{10, 7}));
+    CORRADE_COMPARE(b.tileState({1, 2}), TiledImageTileState::Allocated);
+    CORRADE_COMPARE(b.tile({1, 2}).pixels<UnsignedByte>()[0][0], UnsignedByte(0x37));
+
+    TiledImage2D c{PixelFormat::RGBA8Unorm, {1, 1}, {1, 1}};
+    c = std::move(b);
+    CORRADE_COMPARE(c.format(), PixelFormat::R8Unorm);
+    CORRADE_COMPARE(c.tileState({1, 2}), TiledImageTileState::Allocated);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<TiledImage2D>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<TiledImage2D>::value);
+}
+
+void TiledImageTest::tileRange() {
+    TiledImage2D image{PixelFormat::RGB8Unorm, {10, 7}, {4, 3}};
+    CORRADE_COMPARE(image.tileRange({0, 0}), (Range2Di{{0, 0}, {4, 3}}));
+    CORRADE_COMPARE(image.tileRange({1, 1}), (Range2Di{{4, 3}, {8, 6}}));
+    /* Edge tiles are clipped */
+    CORRADE_COMPARE(image.tileRange({2, 2}), (Range2Di{{8, 6}, {10, 7}}));
+}
+
+void TiledImageTest::tilesCovering() {
+    TiledImage2D image{PixelFormat::RGB8Unorm, {10, 7}, {4, 3}};
+    CORRADE_COMPARE(image.tilesCovering({{0, 0}, {10, 7}}), (Range2Di{{0, 0}, {3, 3}}));
+    CORRADE_COMPARE(image.tilesCovering({{4, 3}, {8, 6}}), (Range2Di{{1, 1}, {2, 2}}));
+    CORRADE_COMPARE(image.tilesCovering({{3, 2}, {5, 4}}), (Range2Di{{0, 0}, {2, 2}}));
+    CORRADE_COMPARE(image.tilesCovering({{5, 5}, {5, 6}}), Range2Di{});
+}
+
+void TiledImageTest::tilesCoveringOutOfBounds() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    TiledImage2D image{PixelFormat::RGB8Unorm, {10, 7}, {4, 3}};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    image.tilesCovering({{3, 2}, {11, 4}});
+    CORRADE_COMPARE(out.str(), "TiledImage2D::tilesCovering(): range {3, 2} to {11, 4} out of bounds for an image of size {10, 7}\n");
+}
+
+void TiledImageTest::mutableTile() {
+    TiledImage2D image{PixelFormat::RGB8Unorm, {10, 7}, {4, 3}};
+
+    /* Allocates and zero-fills */
+    MutableImageView2D tile = image.mutableTile({2, 1});
+    CORRADE_COMPARE(image.tileState({2, 1}), TiledImageTileState::Allocated);
+    CORRADE_COMPARE(tile.size(), (Vector2i{2, 3}));
+    CORRADE_COMPARE(tile.format(), PixelFormat::RGB8Unorm);
+    /* Rows are padded to four bytes */
+    CORRADE_COMPARE(image.dataSize(), 8*3);
+    for(Int y = 0; y != 3; ++y) for(Int x = 0; x != 2; ++x) {
+        CORRADE_ITERATION(Vector2i(x, y));
+        CORRADE_COMPARE(tile.pixels<Color3ub>()[y][x], Color3ub{});
+    }
+
+    tile.pixels<Color3ub>()[1][1] = {1, 2, 3};
+
+    /* Second call returns the same memory */
+    MutableImageView2D tile2 = image.mutableTile({2, 1});
+    CORRADE_COMPARE(tile2.data().data(), tile.data().data());
+    CORRADE_COMPARE(image.tile({2, 1}).pixels<Color3ub>()[1][1], (Color3ub{1, 2, 3}));
+}
+
+void TiledImageTest::tileNotAllocated() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    TiledImage2D image{PixelFormat::RGB8Unorm, {10, 7}, {4, 3}};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    image.tile({1, 1});
+    image.uniformTilePixel({1, 1});
+    CORRADE_COMPARE(out.str(),
+        "TiledImage2D::tile(): expected tile {1, 1} to be allocated but it's TiledImageTileState::Empty\n"
+        "TiledImage2D::uniformTilePixel(): expected tile {1, 1} to be uniform but it's TiledImageTileState::Empty\n");
+}
+
+void TiledImageTest::tileOutOfRange() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    TiledImage2D image{PixelFormat::RGB8Unorm, {10, 7}, {4, 3}};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    image.tileRange({3, 0});
+    image.tileState({0, 3});
+    image.tile({-1, 0});
+    image.mutableTile({3, 3});
+    image.uniformTilePixel({3, 0});
+    image.releaseTile({3, 0});
+    image.compactTile({3, 0});
+    CORRADE_COMPARE(out.str(),
+        "TiledImage2D::tileRange(): tile {3, 0} out of range for {3, 3} tiles\n"
+        "TiledImage2D::tileState(): tile {0, 3} out of range for {3, 3} tiles\n"
+        "TiledImage2D::tile(): tile {-1, 0} out of range for {3, 3} tiles\n"
+        "TiledImage2D::mutableTile(): tile {3, 3} out of range for {3, 3} tiles\n"
+        "TiledImage2D::uniformTilePixel(): tile {3, 0} out of range for {3, 3} tiles\n"
+        "TiledImage2D::releaseTile(): tile {3, 0} out of range for {3, 3} tiles\n"
+        "TiledImage2D::compactTile(): tile {3, 0} out of range for {3, 3} tiles\n");
+}
+
+void TiledImageTest::setSubImage() {
+    TiledImage2D image{PixelFormat::RGB8Unorm, {10, 7}, {4, 3}};
+    image.mutableTile({0, 0}).pixels<Color3ub>()[0][0] = {0xff, 0xff, 0xff};
+
+    /* A 3x2 piece of the gradient placed across four tiles */
+    Image2D src = gradient();
+    const ImageView2D piece{PixelStorage{}.setRowLength(10).setSkip({2, 1, 0}), PixelFormat::RGB8Unorm, {3, 2}, src.data()};
+    image.setSubImage({3, 2}, piece);
+
+    CORRADE_COMPARE(image.tileState({0, 0}), TiledImageTileState::Allocated);
+    CORRADE_COMPARE(image.tileState({1, 0}), TiledImageTileState::Allocated);
+    CORRADE_COMPARE(image.tileState({0, 1}), TiledImageTileState::Allocated);
+    CORRADE_COMPARE(image.tileState({1, 1}), TiledImageTileState::Allocated);
+    CORRADE_COMPARE(image.tileState({2, 0}), TiledImageTileState::Empty);
+    CORRADE_COMPARE(image.tileState({2, 2}), TiledImageTileState::Empty);
+
+    /* Existing contents of the tile got preserved */
+    CORRADE_COMPARE(image.tile({0, 0}).pixels<Color3ub>()[0][0], (Color3ub{0xff, 0xff, 0xff}));
+    /* Source pixel {2, 1} is at {3, 2}, i.e. the top right corner of tile
+       {0, 0} */
+    CORRADE_COMPARE(image.tile({0, 0}).pixels<Color3ub>()[2][3], (Color3ub{2, 1, 21}));
+    /* Source pixel {4, 2} is at {5, 3}, i.e. {1, 0} in tile {1, 1} */
+    CORRADE_COMPARE(image.tile({1, 1}).pixels<Color3ub>()[0][1], (Color3ub{4, 2, 42}));
+    /* Pixels outside of the range are zero-filled */
+    CORRADE_COMPARE(image.tile({1, 1}).pixels<Color3ub>()[0][2], Color3ub{});
+}
+
+void TiledImageTest::setSubImageFullTile() {
+    TiledImage2D image{PixelFormat::RGB8Unorm, {10, 7}, {4, 3}};
+
+    Image2D src = gradient();
+    image.setSubImage({}, src);
+
+    /* Everything is allocated and round-trips */
+    CORRADE_COMPARE(image.dataSize(), (12 + 12 + 8)*(3 + 3 + 1));
+    Image2D out = image.subImage({{}, {10, 7}});
+    CORRADE_COMPARE_AS(out.pixels<Color3ub>(), src.pixels<Color3ub>(),
+        TestSuite::Compare::Container);
+}
+
+void TiledImageTest::setSubImageFormatMismatch() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    TiledImage2D image{PixelFormat::RGB8Unorm, {10, 7}, {4, 3}};
+    const char data[4*4]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    image.setSubImage({}, ImageView2D{PixelFormat::RGBA8Unorm, {2, 2}, data});
+    image.subImageInto({{}, {2, 2}}, MutableImageView2D{PixelFormat::R8Unorm, {2, 2}});
+    CORRADE_COMPARE(out.str(),
+        "TiledImage2D::setSubImage(): expected PixelFormat::RGB8Unorm but got PixelFormat::RGBA8Unorm\n"
+        "TiledImage2D::subImageInto(): expected PixelFormat::RGB8Unorm but got PixelFormat::R8Unorm\n");
+}
+
+void TiledImageTest::setSubImageOutOfBounds() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    TiledImage2D image{PixelFormat::RGB8Unorm, {10, 7}, {4, 3}};
+    const char data[4*4]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    image.setSubImage({9, 0}, ImageView2D{PixelFormat::RGB8Unorm, {2, 2}, data});
+    image.subImage({{0, 6}, {2, 8}});
+    image.subImageInto({{-1, 0}, {1, 2}}, MutableImageView2D{PixelFormat::RGB8Unorm, {2, 2}});
+    CORRADE_COMPARE(out.str(),
+        "TiledImage2D::setSubImage(): range {9, 0} to {11, 2} out of bounds for an image of size {10, 7}\n"
+        "TiledImage2D::subImage(): range {0, 6} to {2, 8} out of bounds for an image of size {10, 7}\n"
+        "TiledImage2D::subImageInto(): range {-1, 0} to {1, 2} out of bounds for an image of size {10, 7}\n");
+}
+
+void TiledImageTest::subImage() {
+    TiledImage2D image{PixelFormat::RGB8Unorm, {10, 7}, {4, 3}};
+    Image2D src = gradient();
+    image.setSubImage({}, src);
+
+    /* A range crossing all tile boundaries */
+    Image2D out = image.subImage({{3, 2}, {9, 7}});
+    CORRADE_COMPARE(out.format(), PixelFormat::RGB8Unorm);
+    CORRADE_COMPARE(out.size(), (Vector2i{6, 5}));
+    for(Int y = 0; y != 5; ++y) for(Int x = 0; x != 6; ++x) {
+        CORRADE_ITERATION(Vector2i(x, y));
+        CORRADE_COMPARE(out.pixels<Color3ub>()[y][x], src.pixels<Color3ub>()[y + 2][x + 3]);
+    }
+}
+
+void TiledImageTest::subImageEmptyUniform() {
+    TiledImage2D image{PixelFormat::RGB8Unorm, {10, 7}, {4, 3}};
+
+    /* Tile {1, 0} uniform, the rest empty */
+    MutableImageView2D tile = image.mutableTile({1, 0});
+    for(Int y = 0; y != 3; ++y) for(Int x = 0; x != 4; ++x)
+        tile.pixels<Color3ub>()[y][x] = {7, 8, 9};
+    CORRADE_VERIFY(image.compactTile({1, 0}));
+    CORRADE_COMPARE(image.tileState({1, 0}), TiledImageTileState::Uniform);
+
+    /* Pre-fill the output with garbage to verify everything gets
+       overwritten */
+    Image2D out{PixelStorage{}.setAlignment(1), PixelFormat::RGB8Unorm, {6, 4}, Containers::Array<char>{DirectInit, 6*3*4, '\xcd'}};
+    image.subImageInto({{2, 1}, {8, 5}}, out);
+    for(Int y = 0; y != 4; ++y) for(Int x = 0; x != 6; ++x) {
+        CORRADE_ITERATION(Vector2i(x, y));
+        const bool uniform = x + 2 >= 4 && x + 2 < 8 && y + 1 < 3;
+        CORRADE_COMPARE(out.pixels<Color3ub>()[y][x], (uniform ? Color3ub{7, 8, 9} : Color3ub{}));
+    }
+
+    /* No tile got allocated by reading */
+    CORRADE_COMPARE(image.tileState({1, 0}), TiledImageTileState::Uniform);
+    CORRADE_COMPARE(image.tileState({0, 0}), TiledImageTileState::Empty);
+}
+
+void TiledImageTest::subImageIntoSizeMismatch() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    TiledImage2D image{PixelFormat::RGB8Unorm, {10, 7}, {4, 3}};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    image.subImageInto({{}, {2, 3}}, MutableImageView2D{PixelFormat::RGB8Unorm, {3, 2}});
+    CORRADE_COMPARE(out.str(), "TiledImage2D::subImageInto(): expected an image of size {2, 3} but got {3, 2}\n");
+}
+
+void TiledImageTest::compact() {
+    TiledImage2D image{PixelFormat::RGB8Unorm, {10, 7}, {4, 3}};
+    Image2D src = gradient();
+    image.setSubImage({}, src);
+
+    /* Make tile {2, 2}, which is 2x1, uniform */
+    MutableImageView2D tile = image.mutableTile({2, 2});
+    tile.pixels<Color3ub>()[0][0] = tile.pixels<Color3ub>()[0][1] = {3, 2, 1};
+
+    CORRADE_COMPARE(image.compact(), 1);
+    CORRADE_COMPARE(image.tileState({2, 2}), TiledImageTileState::Uniform);
+    CORRADE_COMPARE(image.tileState({1, 2}), TiledImageTileState::Allocated);
+    CORRADE_COMPARE_AS(image.uniformTilePixel({2, 2}),
+        Containers::arrayView({'\x03', '\x02', '\x01'}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(image.dataSize(), (12 + 12 + 8)*(3 + 3) + 12 + 12 + 3);
+
+    /* Compacting again does nothing */
+    CORRADE_COMPARE(image.compact(), 0);
+
+    /* Getting a mutable tile expands it back */
+    MutableImageView2D expanded = image.mutableTile({2, 2});
+    CORRADE_COMPARE(image.tileState({2, 2}), TiledImageTileState::Allocated);
+    CORRADE_COMPARE(expanded.pixels<Color3ub>()[0][0], (Color3ub{3, 2, 1}));
+    CORRADE_COMPARE(expanded.pixels<Color3ub>()[0][1], (Color3ub{3, 2, 1}));
+}
+
+void TiledImageTest::compactZero() {
+    TiledImage2D image{PixelFormat::RGB8Unorm, {10, 7}, {4, 3}};
+    image.mutableTile({1, 1});
+    CORRADE_COMPARE(image.tileState({1, 1}), TiledImageTileState::Allocated);
+
+    /* All-zero tiles become empty */
+    CORRADE_VERIFY(image.compactTile({1, 1}));
+    CORRADE_COMPARE(image.tileState({1, 1}), TiledImageTileState::Empty);
+    CORRADE_COMPARE(image.dataSize(), 0);
+
+    /* Empty tiles aren't compacted further */
+    CORRADE_VERIFY(!image.compactTile({1, 1}));
+}
+
+void TiledImageTest::release() {
+    TiledImage2D image{PixelFormat::RGB8Unorm, {10, 7}, {4, 3}};
+    image.mutableTile({0, 1}).pixels<Color3ub>()[0][0] = {1, 2, 3};
+    CORRADE_COMPARE(image.dataSize(), 12*3);
+
+    image.releaseTile({0, 1});
+    CORRADE_COMPARE(image.tileState({0, 1}), TiledImageTileState::Empty);
+    CORRADE_COMPARE(image.dataSize(), 0);
+
+    /* Allocating again gives back zeros */
+    CORRADE_COMPARE(image.mutableTile({0, 1}).pixels<Color3ub>()[0][0], Color3ub{});
+}
+
+void TiledImageTest::debugTileState() {
+    std::ostringstream out;
+    Debug{&out} << TiledImageTileState::Uniform << TiledImageTileState(0xbe);
+    CORRADE_COMPARE(out.str(), "TiledImageTileState::Uniform TiledImageTileState(0xbe)\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Test::TiledImageTest)
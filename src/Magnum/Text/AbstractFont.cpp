@@ -29,6 +29,8 @@
 #include <Corrade/Containers/EnumSet.hpp>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/String.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Containers/StringStl.h> /** @todo remove once file callbacks are <string>-free */
 #include <Corrade/PluginManager/Manager.hpp>
 #include <Corrade/Utility/DebugStl.h> /** @todo remove once AbstractFont is <string>-free */
@@ -56,7 +58,7 @@ using namespace Containers::Literals;
 Containers::StringView AbstractFont::pluginInterface() {
     return
 /* [interface] */
-"cz.mosra.magnum.Text.AbstractFont/0.3"_s
+"cz.mosra.magnum.Text.AbstractFont/0.3.1"_s
 /* [interface] */
     ;
 }
@@ -282,6 +284,34 @@ Containers::Pointer<AbstractLayouter> AbstractFont::layout(const AbstractGlyphCa
     return doLayout(cache, size, text);
 }
 
+UnsignedInt AbstractFont::layoutInto(const Float size, const Containers::StringView text, const Containers::StridedArrayView1D<UnsignedInt>& glyphIds, const Containers::StridedArrayView1D<Vector2>& glyphOffsets, const Containers::StridedArrayView1D<Vector2>& glyphAdvances) {
+    CORRADE_ASSERT(isOpened(), "Text::AbstractFont::layoutInto(): no font opened", {});
+    CORRADE_ASSERT(glyphOffsets.size() == glyphIds.size() && glyphAdvances.size() == glyphIds.size(),
+        "Text::AbstractFont::layoutInto(): expected glyph ID, offset and advance views to have the same size, got" << glyphIds.size() << Debug::nospace << "," << glyphOffsets.size() << "and" << glyphAdvances.size(), {});
+    CORRADE_ASSERT(glyphIds.size() >= text.size(),
+        "Text::AbstractFont::layoutInto(): expected the views to have at least" << text.size() << "elements but got" << glyphIds.size(), {});
+
+    const UnsignedInt count = doLayoutInto(size, text, glyphIds, glyphOffsets, glyphAdvances);
+    CORRADE_INTERNAL_ASSERT(count <= text.size());
+    return count;
+}
+
+UnsignedInt AbstractFont::doLayoutInto(const Float size, const Containers::StringView text, const Containers::StridedArrayView1D<UnsignedInt>& glyphIds, const Containers::StridedArrayView1D<Vector2>& glyphOffsets, const Containers::StridedArrayView1D<Vector2>& glyphAdvances) {
+    const Containers::ArrayView<const char> data = text;
+    const Float scale = size/_size;
+
+    UnsignedInt count = 0;
+    for(std::size_t i = 0; i != data.size(); ++count) {
+        char32_t codepoint;
+        std::tie(codepoint, i) = Utility::Unicode::nextChar(data, i);
+        glyphIds[count] = doGlyphId(codepoint);
+        glyphOffsets[count] = {};
+        glyphAdvances[count] = doGlyphAdvance(glyphIds[count])*scale;
+    }
+
+    return count;
+}
+
 Debug& operator<<(Debug& debug, const FontFeature value) {
     debug << "Text::FontFeature" << Debug::nospace;
 
@@ -446,6 +446,32 @@ class MAGNUM_TEXT_EXPORT AbstractFont: public PluginManager::AbstractPlugin {
          */
         Containers::Pointer<AbstractLayouter> layout(const AbstractGlyphCache& cache, Float size, const std::string& text);
 
+        /**
+         * @brief Layout the text into caller-provided views
+         * @param size          Font size
+         * @param text          UTF-8 text to layout
+         * @param glyphIds      Where to put glyph IDs
+         * @param glyphOffsets  Where to put glyph offsets
+         * @param glyphAdvances Where to put glyph advances
+         * @return Count of glyphs written to the views
+         * @m_since_latest
+         *
+         * Unlike @ref layout(), this function doesn't allocate and doesn't
+         * need a glyph cache, making it suitable for relayouting text on
+         * every change. Offsets and advances are scaled to @p size, offsets
+         * are relative to the cursor position and contain only adjustments
+         * coming from the layouting itself, not glyph bearings --- those are
+         * stored in the glyph cache. Cursor position of a glyph is the sum of
+         * advances of all glyphs before it.
+         *
+         * Expects that a font is opened, that all three views have the same
+         * size and that the size is at least the byte length of @p text,
+         * which is an upper bound on the resulting glyph count. Only the
+         * prefix of the views given by the returned glyph count is written.
+         * @see @ref glyphId(), @ref glyphAdvance()
+         */
+        UnsignedInt layoutInto(Float size, Containers::StringView text, const Containers::StridedArrayView1D<UnsignedInt>& glyphIds, const Containers::StridedArrayView1D<Vector2>& glyphOffsets, const Containers::StridedArrayView1D<Vector2>& glyphAdvances);
+
     protected:
         /**
          * @brief Font metrics
@@ -552,6 +578,19 @@ class MAGNUM_TEXT_EXPORT AbstractFont: public PluginManager::AbstractPlugin {
         /** @brief Implementation for @ref layout() */
         virtual Containers::Pointer<AbstractLayouter> doLayout(const AbstractGlyphCache& cache, Float size, const std::string& text) = 0;
 
+        /**
+         * @brief Implementation for @ref layoutInto()
+         * @m_since_latest
+         *
+         * The views are guaranteed to have the same size and be large enough
+         * to contain one glyph for every byte of @p text. Default
+         * implementation decodes the text, queries @ref doGlyphId() and
+         * @ref doGlyphAdvance() for every character and writes zero offsets.
+         * Implementations are encouraged to override this to avoid the
+         * virtual calls for every glyph.
+         */
+        virtual UnsignedInt doLayoutInto(Float size, Containers::StringView text, const Containers::StridedArrayView1D<UnsignedInt>& glyphIds, const Containers::StridedArrayView1D<Vector2>& glyphOffsets, const Containers::StridedArrayView1D<Vector2>& glyphAdvances);
+
         Containers::Optional<Containers::ArrayView<const char>>(*_fileCallback)(const std::string&, InputFileCallbackPolicy, void*){};
         void* _fileCallbackUserData{};
 
@@ -41,6 +41,10 @@ AbstractGlyphCache::AbstractGlyphCache(const Vector2i& size, const Vector2i& pad
 AbstractGlyphCache::~AbstractGlyphCache() = default;
 
 std::vector<Range2Di> AbstractGlyphCache::reserve(const std::vector<Vector2i>& sizes) {
+    return doReserve(sizes);
+}
+
+std::vector<Range2Di> AbstractGlyphCache::doReserve(const std::vector<Vector2i>& sizes) {
     CORRADE_ASSERT((glyphs.size() == 1 && glyphs.at(0) == std::pair<Vector2i, Range2Di>()),
         "Text::AbstractGlyphCache::reserve(): reserving space in non-empty cache is not yet implemented", {});
     glyphs.reserve(glyphs.size() + sizes.size());
@@ -49,6 +53,7 @@ std::vector<Range2Di> AbstractGlyphCache::reserve(const std::vector<Vector2i>& s
 
 void AbstractGlyphCache::insert(const UnsignedInt glyph, const Vector2i& position, const Range2Di& rectangle) {
     const std::pair<Vector2i, Range2Di> glyphData = {position-_padding, rectangle.padded(_padding)};
+    ++_generation;
 
     /* Overwriting "Not Found" glyph */
     if(glyph == 0) glyphs[0] = glyphData;
@@ -57,6 +62,14 @@ void AbstractGlyphCache::insert(const UnsignedInt glyph, const Vector2i& positio
     else CORRADE_INTERNAL_ASSERT_OUTPUT(glyphs.insert({glyph, glyphData}).second);
 }
 
+bool AbstractGlyphCache::erase(const UnsignedInt glyph) {
+    CORRADE_ASSERT(glyph,
+        "Text::AbstractGlyphCache::erase(): can't erase glyph 0", {});
+    if(!glyphs.erase(glyph)) return false;
+    ++_generation;
+    return true;
+}
+
 void AbstractGlyphCache::setImage(const Vector2i& offset, const ImageView2D& image) {
     CORRADE_ASSERT((offset >= Vector2i{} && offset + image.size() <= _size).all(),
         "Text::AbstractGlyphCache::setImage():" << Range2Di::fromSize(offset, image.size()) << "out of bounds for texture size" << _size, );
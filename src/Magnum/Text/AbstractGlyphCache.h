@@ -77,7 +77,9 @@ An API-agnostic base for glyph caches. See @ref GlyphCache and
 The subclass needs to implement the @ref doSetImage() function and manage the
 glyph cache image. The public @ref setImage() function already does checking
 for rectangle bounds so it's not needed to do it again on the implementation
-side.
+side. Subclasses managing the atlas space on their own can additionally
+override @ref doReserve() and use @ref erase() to remove glyphs, see
+@ref DynamicGlyphCache for an example.
 */
 class MAGNUM_TEXT_EXPORT AbstractGlyphCache {
     public:
@@ -102,6 +104,17 @@ class MAGNUM_TEXT_EXPORT AbstractGlyphCache {
         /** @brief Count of glyphs in the cache */
         std::size_t glyphCount() const { return glyphs.size(); }
 
+        /**
+         * @brief Cache generation
+         * @m_since_latest
+         *
+         * Incremented every time a glyph is added with @ref insert() or
+         * removed with @ref erase(). Can be used to detect that text laid
+         * out with this cache may have become stale, see @ref LayoutCache for
+         * an example.
+         */
+        UnsignedInt generation() const { return _generation; }
+
         /**
          * @brief Parameters of given glyph
          * @param glyph         Glyph ID
@@ -143,6 +156,8 @@ class MAGNUM_TEXT_EXPORT AbstractGlyphCache {
          *
          * @attention Cache size must be large enough to contain all rendered
          *      glyphs.
+         *
+         * Calls @ref doReserve().
          * @see @ref padding()
          */
         std::vector<Range2Di> reserve(const std::vector<Vector2i>& sizes);
@@ -183,7 +198,23 @@ class MAGNUM_TEXT_EXPORT AbstractGlyphCache {
          */
         Image2D image();
 
+    protected:
+        /**
+         * @brief Remove a glyph from the cache
+         * @m_since_latest
+         *
+         * Meant to be used by subclasses that manage the atlas space on their
+         * own and need to evict glyphs. Returns @cpp false @ce if the glyph
+         * wasn't in the cache. Expects that @p glyph is not @cpp 0 @ce, the
+         * "Not Found" glyph can only be reset with @ref insert().
+         */
+        bool erase(UnsignedInt glyph);
+
+    #ifdef DOXYGEN_GENERATING_OUTPUT
+    protected:
+    #else
     private:
+    #endif
         /** @brief Implementation for @ref features() */
         virtual GlyphCacheFeatures doFeatures() const = 0;
 
@@ -198,7 +229,21 @@ class MAGNUM_TEXT_EXPORT AbstractGlyphCache {
         /** @brief Implementation for @ref image() */
         virtual Image2D doImage();
 
+        /**
+         * @brief Implementation for @ref reserve()
+         * @m_since_latest
+         *
+         * Default implementation lays out the glyphs with
+         * @ref TextureTools::atlas(), expecting that the cache is empty.
+         */
+        virtual std::vector<Range2Di> doReserve(const std::vector<Vector2i>& sizes);
+
+    #ifdef DOXYGEN_GENERATING_OUTPUT
+    private:
+    #endif
+
         Vector2i _size, _padding;
+        UnsignedInt _generation{};
         std::unordered_map<UnsignedInt, std::pair<Vector2i, Range2Di>> glyphs;
 };
 
@@ -0,0 +1,350 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "DynamicGlyphCache.h"
+
+#include <algorithm>
+#include <tuple>
+#include <unordered_map>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Unicode.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Text/AbstractFont.h"
+
+namespace Magnum { namespace Text {
+
+namespace {
+    constexpr UnsignedInt None = ~UnsignedInt{};
+}
+
+struct DynamicGlyphCache::State {
+    explicit State(const Vector2i& size): size{size}, image{ValueInit, std::size_t(size.product())} {}
+
+    /* Row of slots, filled from left to right */
+    struct Shelf {
+        Int y, height, x;
+    };
+
+    struct Slot {
+        /* Whole area including padding */
+        Range2Di rectangle;
+        /* None if the slot is free or pending */
+        UnsignedInt glyph;
+        /* Neighbors in the LRU list, None at its ends */
+        UnsignedInt previous, next;
+        /* Frame in which the glyph was last used */
+        UnsignedInt frame;
+    };
+
+    void unlink(UnsignedInt slot);
+    void pushFront(UnsignedInt slot);
+    void touch(UnsignedInt slot);
+    UnsignedInt allocate(const Vector2i& size);
+    UnsignedInt evict();
+    void clear(UnsignedInt slot);
+
+    Vector2i size;
+    /* Copy of the texture, to not depend on how the font plugin uploads the
+       glyphs */
+    Containers::Array<char> image;
+
+    Containers::Array<Shelf> shelves;
+    Containers::Array<Slot> slots;
+    Containers::Array<UnsignedInt> freeSlots;
+    /* Slots reserved during current fill(), not yet assigned to a glyph */
+    Containers::Array<UnsignedInt> pendingSlots;
+    std::unordered_map<UnsignedInt, UnsignedInt> glyphSlots;
+
+    /* Most and least recently used slot */
+    UnsignedInt first = None, last = None;
+    /* Where the next shelf starts */
+    Int shelfEnd{};
+
+    UnsignedInt frame = 1;
+    std::size_t evictedGlyphCount{};
+
+    /* Texture rows that need to be uploaded, empty if nothing changed */
+    Int dirtyBegin{}, dirtyEnd{};
+
+    bool filling{}, failed{};
+};
+
+void DynamicGlyphCache::State::unlink(const UnsignedInt slot) {
+    Slot& s = slots[slot];
+    if(s.previous != None) slots[s.previous].next = s.next;
+    else first = s.next;
+    if(s.next != None) slots[s.next].previous = s.previous;
+    else last = s.previous;
+    s.previous = s.next = None;
+}
+
+void DynamicGlyphCache::State::pushFront(const UnsignedInt slot) {
+    Slot& s = slots[slot];
+    s.previous = None;
+    s.next = first;
+    if(first != None) slots[first].previous = slot;
+    else last = slot;
+    first = slot;
+}
+
+void DynamicGlyphCache::State::touch(const UnsignedInt slot) {
+    unlink(slot);
+    pushFront(slot);
+    slots[slot].frame = frame;
+}
+
+UnsignedInt DynamicGlyphCache::State::allocate(const Vector2i& size) {
+    /* Reuse the smallest free slot that's large enough */
+    std::size_t bestFree = freeSlots.size();
+    for(std::size_t i = 0; i != freeSlots.size(); ++i) {
+        const Vector2i slotSize = slots[freeSlots[i]].rectangle.size();
+        if((slotSize >= size).all() && (bestFree == freeSlots.size() || slotSize.product() < slots[freeSlots[bestFree]].rectangle.size().product()))
+            bestFree = i;
+    }
+    if(bestFree != freeSlots.size()) {
+        const UnsignedInt slot = freeSlots[bestFree];
+        freeSlots[bestFree] = freeSlots.back();
+        arrayResize(freeSlots, freeSlots.size() - 1);
+        return slot;
+    }
+
+    /* If there are no glyphs left at all, start from scratch to get rid of
+       the fragmentation */
+    if(!slots.empty() && glyphSlots.empty() && pendingSlots.empty()) {
+        arrayResize(shelves, 0);
+        arrayResize(slots, 0);
+        arrayResize(freeSlots, 0);
+        first = last = None;
+        shelfEnd = 0;
+    }
+
+    /* Otherwise put it to the lowest shelf that has enough space, or open a
+       new shelf if possible */
+    Shelf* bestShelf = nullptr;
+    for(Shelf& shelf: shelves) {
+        if(shelf.height >= size.y() && shelf.x + size.x() <= this->size.x() && (!bestShelf || shelf.height < bestShelf->height))
+            bestShelf = &shelf;
+    }
+    if(!bestShelf) {
+        if(shelfEnd + size.y() > this->size.y() || size.x() > this->size.x())
+            return None;
+        arrayAppend(shelves, Shelf{shelfEnd, size.y(), 0});
+        shelfEnd += size.y();
+        bestShelf = &shelves.back();
+    }
+
+    arrayAppend(slots, Slot{Range2Di::fromSize({bestShelf->x, bestShelf->y}, size), None, None, None, 0});
+    bestShelf->x += size.x();
+    return slots.size() - 1;
+}
+
+UnsignedInt DynamicGlyphCache::State::evict() {
+    /* Glyphs used in current frame are never evicted */
+    if(last == None || slots[last].frame == frame) return None;
+
+    const UnsignedInt slot = last;
+    unlink(slot);
+    glyphSlots.erase(slots[slot].glyph);
+    arrayAppend(freeSlots, slot);
+    ++evictedGlyphCount;
+    return slot;
+}
+
+void DynamicGlyphCache::State::clear(const UnsignedInt slot) {
+    /* Clear the whole slot including padding, so nothing from a previously
+       evicted glyph stays there */
+    const Range2Di& rectangle = slots[slot].rectangle;
+    for(Int y = rectangle.min().y(); y != rectangle.max().y(); ++y)
+        for(Int x = rectangle.min().x(); x != rectangle.max().x(); ++x)
+            image[y*size.x() + x] = 0;
+
+    if(dirtyBegin == dirtyEnd) {
+        dirtyBegin = rectangle.min().y();
+        dirtyEnd = rectangle.max().y();
+    } else {
+        dirtyBegin = Math::min(dirtyBegin, rectangle.min().y());
+        dirtyEnd = Math::max(dirtyEnd, rectangle.max().y());
+    }
+}
+
+DynamicGlyphCache::DynamicGlyphCache(const Vector2i& size, const Vector2i& padding): GlyphCache{size, padding}, _state{InPlaceInit, size} {
+    /* Texture storage contents are undefined initially, clear it so only the
+       changed rows need to be uploaded later */
+    texture().setSubImage(0, {}, ImageView2D{
+        PixelStorage{}.setAlignment(1), PixelFormat::R8Unorm, size,
+        _state->image});
+}
+
+DynamicGlyphCache::~DynamicGlyphCache() = default;
+
+std::size_t DynamicGlyphCache::evictedGlyphCount() const {
+    return _state->evictedGlyphCount;
+}
+
+void DynamicGlyphCache::nextFrame() {
+    ++_state->frame;
+}
+
+bool DynamicGlyphCache::fill(AbstractFont& font, const std::string& characters) {
+    State& state = *_state;
+
+    /* Mark glyphs that are already present as used and collect the missing
+       ones. Each glyph is requested just once, even if more characters map to
+       it. */
+    std::string missingCharacters;
+    std::vector<UnsignedInt> missingGlyphs;
+    for(std::size_t i = 0; i != characters.size(); ) {
+        const std::size_t begin = i;
+        char32_t character;
+        std::tie(character, i) = Utility::Unicode::nextChar(characters, i);
+
+        const UnsignedInt glyph = font.glyphId(character);
+        if(!glyph) continue;
+
+        const auto found = state.glyphSlots.find(glyph);
+        if(found != state.glyphSlots.end()) {
+            state.touch(found->second);
+            continue;
+        }
+
+        if(std::find(missingGlyphs.begin(), missingGlyphs.end(), glyph) != missingGlyphs.end())
+            continue;
+        missingGlyphs.push_back(glyph);
+        missingCharacters.append(characters, begin, i - begin);
+    }
+
+    if(missingGlyphs.empty()) return true;
+
+    /* Rasterize the missing glyphs. The font calls reserve(), which ends up
+       in doReserve(), then insert() and setImage() with the result. */
+    state.filling = true;
+    state.failed = false;
+    font.fillGlyphCache(*this, missingCharacters);
+    state.filling = false;
+
+    if(state.failed) {
+        Error{} << "Text::DynamicGlyphCache::fill(): cache too small to fit" << missingGlyphs.size() << "new glyphs";
+
+        /* Roll back everything, the slots that made it are reused next
+           time */
+        for(const UnsignedInt glyph: missingGlyphs) erase(glyph);
+
+    /* Assign the reserved slots to glyphs. The font inserts the glyphs with
+       the rectangles returned from doReserve(), which start at the slot
+       origin once the padding is added back. */
+    } else for(const UnsignedInt glyph: missingGlyphs) {
+        const Vector2i min = (*this)[glyph].second.min();
+        for(std::size_t i = 0; i != state.pendingSlots.size(); ++i) {
+            const UnsignedInt slot = state.pendingSlots[i];
+            if(state.slots[slot].rectangle.min() != min) continue;
+
+            state.slots[slot].glyph = glyph;
+            state.slots[slot].frame = state.frame;
+            state.pushFront(slot);
+            state.glyphSlots.emplace(glyph, slot);
+            state.pendingSlots[i] = state.pendingSlots.back();
+            arrayResize(state.pendingSlots, state.pendingSlots.size() - 1);
+            break;
+        }
+    }
+
+    /* Slots that didn't get any glyph are free again */
+    for(const UnsignedInt slot: state.pendingSlots)
+        arrayAppend(state.freeSlots, slot);
+    arrayResize(state.pendingSlots, 0);
+
+    /* Upload the changed rows. Whole rows are contiguous in memory, so they
+       can be uploaded without any row length pixel storage, which isn't
+       available on ES2. */
+    if(state.dirtyBegin != state.dirtyEnd) {
+        const Int width = state.size.x();
+        texture().setSubImage(0, {0, state.dirtyBegin}, ImageView2D{
+            PixelStorage{}.setAlignment(1), PixelFormat::R8Unorm,
+            {width, state.dirtyEnd - state.dirtyBegin},
+            state.image.slice(state.dirtyBegin*width, state.dirtyEnd*width)});
+        state.dirtyBegin = state.dirtyEnd = 0;
+    }
+
+    return !state.failed;
+}
+
+std::vector<Range2Di> DynamicGlyphCache::doReserve(const std::vector<Vector2i>& sizes) {
+    State& state = *_state;
+    CORRADE_ASSERT(state.filling,
+        "Text::DynamicGlyphCache::reserve(): the cache can be filled only through fill()", {});
+
+    std::vector<Range2Di> out;
+    out.reserve(sizes.size());
+    for(const Vector2i& size: sizes) {
+        /* Every glyph gets at least a single pixel so the slots can be
+           matched to glyphs by their position in fill() */
+        const Vector2i slotSize = Math::max(size + 2*padding(), Vector2i{1});
+
+        /* Evict least recently used glyphs until there's space */
+        UnsignedInt slot;
+        while((slot = state.allocate(slotSize)) == None) {
+            const UnsignedInt evicted = state.evict();
+            if(evicted == None) break;
+            erase(state.slots[evicted].glyph);
+            state.slots[evicted].glyph = None;
+        }
+
+        if(slot == None) {
+            state.failed = true;
+            out.emplace_back();
+            continue;
+        }
+
+        arrayAppend(state.pendingSlots, slot);
+        state.clear(slot);
+        out.push_back(Range2Di::fromSize(state.slots[slot].rectangle.min() + padding(), size));
+    }
+
+    return out;
+}
+
+void DynamicGlyphCache::doSetImage(const Vector2i& offset, const ImageView2D& image) {
+    State& state = *_state;
+    CORRADE_ASSERT(image.pixelSize() == 1,
+        "Text::DynamicGlyphCache::setImage(): expected a single-byte pixel format, got" << image.format(), );
+
+    /* Copy only the parts that belong to slots reserved in current fill(),
+       fonts may upload the whole texture including areas they didn't touch */
+    const Containers::StridedArrayView3D<const char> pixels = image.pixels();
+    const Range2Di imageRectangle = Range2Di::fromSize(offset, image.size());
+    for(const UnsignedInt slot: state.pendingSlots) {
+        const Range2Di rectangle = Math::intersect(state.slots[slot].rectangle, imageRectangle);
+        for(Int y = rectangle.min().y(); y < rectangle.max().y(); ++y)
+            for(Int x = rectangle.min().x(); x < rectangle.max().x(); ++x)
+                state.image[y*state.size.x() + x] = pixels[y - offset.y()][x - offset.x()][0];
+    }
+}
+
+}}
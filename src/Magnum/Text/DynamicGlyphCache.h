@@ -0,0 +1,142 @@
+#ifndef Magnum_Text_DynamicGlyphCache_h
+#define Magnum_Text_DynamicGlyphCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Text::DynamicGlyphCache
+ * @m_since_latest
+ */
+
+#include "Magnum/configure.h"
+
+#ifdef MAGNUM_TARGET_GL
+#include <string>
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Text/GlyphCache.h"
+
+namespace Magnum { namespace Text {
+
+/**
+@brief Dynamic glyph cache
+@m_since_latest
+
+Unlike @ref GlyphCache, which is meant to be filled once with a fixed
+character set, this cache rasterizes glyphs on first use and evicts least
+recently used glyphs when running out of space. That makes it suitable for
+scripts with large character sets or for user-generated text, where
+prerendering every possible glyph would need excessive amounts of memory.
+
+@section Text-DynamicGlyphCache-usage Usage
+
+Call @ref fill() with the text that's about to be rendered. Glyphs that are
+already in the cache are only marked as used, missing glyphs get rasterized
+using @ref AbstractFont::fillGlyphCache() and only the texture rows that
+changed get uploaded. Call @ref nextFrame() once per frame --- glyphs used
+since the last call are never evicted, so all text rendered in the same frame
+stays valid.
+
+@snippet MagnumText.cpp DynamicGlyphCache-usage
+
+Space in the texture is allocated in horizontal shelves, glyphs evicted from
+the cache leave a slot that's reused by later glyphs of the same or smaller
+size. The cache keeps a copy of the texture in memory, which makes the updates
+independent on how the font plugin uploads the rasterized glyphs.
+
+Note that an evicted glyph can't be rendered until it's filled again, which
+means meshes that were rendered with it before need to be regenerated. Fonts
+with @ref FontFeature::PreparedGlyphCache can't be used with this cache. The
+texture is always single-channel, so this class can't be used in place of a
+@ref DistanceFieldGlyphCache.
+
+@note This class is available only if Magnum is compiled with
+    @ref MAGNUM_TARGET_GL enabled (done by default). See @ref building-features
+    for more information.
+*/
+class MAGNUM_TEXT_EXPORT DynamicGlyphCache: public GlyphCache {
+    public:
+        /**
+         * @brief Constructor
+         * @param size              Glyph cache texture size
+         * @param padding           Padding around every glyph
+         *
+         * The texture format is the same as with
+         * @ref GlyphCache::GlyphCache(const Vector2i&, const Vector2i&).
+         */
+        explicit DynamicGlyphCache(const Vector2i& size, const Vector2i& padding = {});
+
+        ~DynamicGlyphCache();
+
+        /**
+         * @brief Count of glyphs evicted so far
+         *
+         * Useful for tuning the cache size --- if the count grows with every
+         * frame, the cache is too small for the text being rendered.
+         */
+        std::size_t evictedGlyphCount() const;
+
+        /**
+         * @brief Make sure glyphs for given characters are in the cache
+         * @param font          Font to rasterize missing glyphs with
+         * @param characters    UTF-8 characters
+         * @return Whether all glyphs are in the cache
+         *
+         * Glyphs that are already present are marked as used in current
+         * frame. The remaining glyphs are rasterized with
+         * @ref AbstractFont::fillGlyphCache(), evicting glyphs not used in
+         * current frame if there's not enough space. Characters that map to
+         * glyph @cpp 0 @ce are ignored. Changed texture rows are uploaded
+         * right away.
+         *
+         * If some glyphs don't fit even after evicting all glyphs not used in
+         * current frame, a message is printed to @relativeref{Magnum,Error},
+         * the glyphs are not added and the function returns
+         * @cpp false @ce.
+         */
+        bool fill(AbstractFont& font, const std::string& characters);
+
+        /**
+         * @brief Advance to next frame
+         *
+         * Glyphs used in the previous frame become candidates for eviction.
+         */
+        void nextFrame();
+
+    private:
+        struct State;
+
+        MAGNUM_TEXT_LOCAL std::vector<Range2Di> doReserve(const std::vector<Vector2i>& sizes) override;
+        MAGNUM_TEXT_LOCAL void doSetImage(const Vector2i& offset, const ImageView2D& image) override;
+
+        Containers::Pointer<State> _state;
+};
+
+}}
+#else
+#error this header is available only in the OpenGL build
+#endif
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef Magnum_Text_Implementation_layoutCache_h
+#define Magnum_Text_Implementation_layoutCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <string>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Text/LayoutCache.h"
+
+namespace Magnum { namespace Text { namespace Implementation {
+
+/* Used by the renderers to access LayoutCache internals. The vertices are
+   interleaved position and texture coordinate pairs, four vertices and thus
+   eight items per glyph. */
+struct LayoutCacheAccess {
+    /* Returns false if the text isn't cached or if the glyph cache changed
+       since, in which case the outputs are left untouched. The vertices
+       point into the cache and are valid only until the next add(). */
+    static bool find(LayoutCache& layoutCache, const AbstractFont& font, const AbstractGlyphCache& cache, Float size, Alignment alignment, const std::string& text, Containers::ArrayView<const Vector2>& vertices, Range2D& rectangle);
+
+    static void add(LayoutCache& layoutCache, const AbstractFont& font, const AbstractGlyphCache& cache, Float size, Alignment alignment, const std::string& text, Containers::ArrayView<const Vector2> vertices, const Range2D& rectangle);
+
+    /* Returns ~UnsignedInt{} if not found */
+    static UnsignedInt findEntry(LayoutCache::State& state, std::size_t hash, const AbstractFont& font, const AbstractGlyphCache& cache, Float size, Alignment alignment, const std::string& text);
+};
+
+}}}
+
+#endif
@@ -0,0 +1,195 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "LayoutCache.h"
+
+#include <cstring>
+#include <unordered_map>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Utility/Algorithms.h>
+
+#include "Magnum/Math/Range.h"
+#include "Magnum/Text/Alignment.h"
+#include "Magnum/Text/AbstractGlyphCache.h"
+#include "Magnum/Text/Implementation/layoutCache.h"
+
+namespace Magnum { namespace Text {
+
+struct LayoutCache::State {
+    explicit State(UnsignedInt glyphCapacity): glyphCapacity{glyphCapacity} {}
+
+    struct Entry {
+        const AbstractFont* font;
+        const AbstractGlyphCache* cache;
+        Float size;
+        Alignment alignment;
+        UnsignedInt generation;
+        std::size_t textOffset, textSize;
+        /* Offset and count of vertices, and the count the slot has space
+           for, so a relaid out text can reuse it if it isn't larger */
+        UnsignedInt vertexOffset, vertexCount, vertexCapacity;
+        Range2D rectangle;
+    };
+
+    UnsignedInt glyphCapacity;
+    std::size_t hitCount{}, missCount{};
+
+    /* Interleaved positions and texture coordinates, eight per glyph */
+    Containers::Array<Vector2> vertices;
+    Containers::Array<char> text;
+    Containers::Array<Entry> entries;
+    /* Hash of all parameters to an index into entries. Colliding hashes are
+       resolved by comparing the parameters and the text. */
+    std::unordered_multimap<std::size_t, UnsignedInt> lookup;
+};
+
+namespace {
+
+std::size_t hash(const AbstractFont& font, const AbstractGlyphCache& cache, const Float size, const Alignment alignment, const std::string& text) {
+    std::size_t seed = std::hash<std::string>{}(text);
+    /* Same as boost::hash_combine() */
+    const auto combine = [&seed](const std::size_t value) {
+        seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    };
+    combine(std::hash<const void*>{}(&font));
+    combine(std::hash<const void*>{}(&cache));
+    combine(std::hash<Float>{}(size));
+    combine(std::size_t(alignment));
+    return seed;
+}
+
+}
+
+UnsignedInt Implementation::LayoutCacheAccess::findEntry(LayoutCache::State& state, const std::size_t hash, const AbstractFont& font, const AbstractGlyphCache& cache, const Float size, const Alignment alignment, const std::string& text) {
+    const auto range = state.lookup.equal_range(hash);
+    for(auto it = range.first; it != range.second; ++it) {
+        const LayoutCache::State::Entry& entry = state.entries[it->second];
+        if(entry.font == &font && entry.cache == &cache && entry.size == size && entry.alignment == alignment && entry.textSize == text.size() && std::memcmp(state.text.data() + entry.textOffset, text.data(), text.size()) == 0)
+            return it->second;
+    }
+
+    return ~UnsignedInt{};
+}
+
+LayoutCache::LayoutCache(const UnsignedInt glyphCapacity): _state{InPlaceInit, glyphCapacity} {}
+
+LayoutCache::LayoutCache(LayoutCache&&) noexcept = default;
+
+LayoutCache::~LayoutCache() = default;
+
+LayoutCache& LayoutCache::operator=(LayoutCache&&) noexcept = default;
+
+UnsignedInt LayoutCache::glyphCapacity() const {
+    return _state->glyphCapacity;
+}
+
+UnsignedInt LayoutCache::glyphCount() const {
+    return _state->vertices.size()/8;
+}
+
+std::size_t LayoutCache::textCount() const {
+    return _state->entries.size();
+}
+
+std::size_t LayoutCache::hitCount() const {
+    return _state->hitCount;
+}
+
+std::size_t LayoutCache::missCount() const {
+    return _state->missCount;
+}
+
+void LayoutCache::clear() {
+    /* Clearing the growable arrays this way keeps their capacity */
+    State& state = *_state;
+    arrayResize(state.vertices, 0);
+    arrayResize(state.text, 0);
+    arrayResize(state.entries, 0);
+    state.lookup.clear();
+}
+
+bool Implementation::LayoutCacheAccess::find(LayoutCache& layoutCache, const AbstractFont& font, const AbstractGlyphCache& cache, const Float size, const Alignment alignment, const std::string& text, Containers::ArrayView<const Vector2>& vertices, Range2D& rectangle) {
+    LayoutCache::State& state = *layoutCache._state;
+
+    /* Not found or laid out with an older glyph cache */
+    const UnsignedInt id = findEntry(state, hash(font, cache, size, alignment, text), font, cache, size, alignment, text);
+    if(id == ~UnsignedInt{} || state.entries[id].generation != cache.generation()) {
+        ++state.missCount;
+        return false;
+    }
+
+    ++state.hitCount;
+    const LayoutCache::State::Entry& entry = state.entries[id];
+    vertices = state.vertices.slice(entry.vertexOffset, entry.vertexOffset + entry.vertexCount);
+    rectangle = entry.rectangle;
+    return true;
+}
+
+void Implementation::LayoutCacheAccess::add(LayoutCache& layoutCache, const AbstractFont& font, const AbstractGlyphCache& cache, const Float size, const Alignment alignment, const std::string& text, const Containers::ArrayView<const Vector2> vertices, const Range2D& rectangle) {
+    LayoutCache::State& state = *layoutCache._state;
+    const std::size_t glyphCapacity = std::size_t(state.glyphCapacity)*8;
+
+    /* Text that wouldn't fit even into an empty cache isn't cached at all */
+    if(vertices.size() > glyphCapacity) return;
+
+    /* If the text is there already, it was laid out with an older glyph
+       cache. Reuse its slot if the new data fit. */
+    const std::size_t textHash = hash(font, cache, size, alignment, text);
+    const UnsignedInt existing = findEntry(state, textHash, font, cache, size, alignment, text);
+    if(existing != ~UnsignedInt{}) {
+        LayoutCache::State::Entry* const entry = &state.entries[existing];
+        if(vertices.size() <= entry->vertexCapacity) {
+            Utility::copy(vertices, state.vertices.slice(entry->vertexOffset, entry->vertexOffset + vertices.size()));
+            entry->vertexCount = vertices.size();
+            entry->generation = cache.generation();
+            entry->rectangle = rectangle;
+            return;
+        }
+
+        /* Otherwise put the data at the end if there's space, the original
+           slot stays unused until the cache gets cleared */
+        if(state.vertices.size() + vertices.size() <= glyphCapacity) {
+            entry->vertexOffset = state.vertices.size();
+            entry->vertexCount = entry->vertexCapacity = vertices.size();
+            entry->generation = cache.generation();
+            entry->rectangle = rectangle;
+            arrayAppend(state.vertices, vertices);
+            return;
+        }
+    }
+
+    /* Drop everything if there's not enough space left. This also drops
+       the stale entry for this text, if any, so it's added anew below. */
+    if(state.vertices.size() + vertices.size() > glyphCapacity)
+        layoutCache.clear();
+
+    const UnsignedInt id = state.entries.size();
+    arrayAppend(state.entries, LayoutCache::State::Entry{&font, &cache, size, alignment, cache.generation(), state.text.size(), text.size(), UnsignedInt(state.vertices.size()), UnsignedInt(vertices.size()), UnsignedInt(vertices.size()), rectangle});
+    arrayAppend(state.text, Containers::arrayView(text.data(), text.size()));
+    arrayAppend(state.vertices, vertices);
+    state.lookup.emplace(textHash, id);
+}
+
+}}
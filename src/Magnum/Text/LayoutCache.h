@@ -0,0 +1,166 @@
+#ifndef Magnum_Text_LayoutCache_h
+#define Magnum_Text_LayoutCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+
+/** @file
+ * @brief Class @ref Magnum::Text::LayoutCache
+ * @m_since_latest
+ */
+
+#include "Magnum/configure.h"
+
+#ifdef MAGNUM_TARGET_GL
+#include <string>
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Text/Text.h"
+#include "Magnum/Text/visibility.h"
+
+namespace Magnum { namespace Text {
+
+namespace Implementation {
+    struct LayoutCacheAccess;
+}
+
+/**
+@brief Cache for laid out text
+@m_since_latest
+
+Text layout is often the most expensive part of text rendering, yet a typical
+UI renders the same labels, numbers and units over and over. When set on a
+@ref Renderer using @ref AbstractRenderer::setLayoutCache() or on a
+@ref BatchRenderer using @ref AbstractBatchRenderer::setLayoutCache(), each
+laid out text is remembered together with the font, glyph cache, size and
+alignment it was laid out with, and rendering the same text again with the
+same parameters copies the remembered vertex data instead of doing the layout
+again:
+
+@snippet MagnumText.cpp LayoutCache-usage
+
+The cache can be shared among any number of renderers, including ones using
+different fonts, glyph caches, sizes or alignments.
+
+@section Text-LayoutCache-storage Storage and invalidation
+
+Vertex data of all texts are stored in a single contiguous allocation, with
+another one holding the text strings, and looked up through a hash of all
+parameters. Once adding a new text would exceed @ref glyphCapacity(), all
+entries are dropped and the cache starts filling again from scratch --- so
+for a steady-state UI it's best to pick a capacity that's large enough for
+all texts that are visible at once. Text that has more glyphs than the whole
+capacity is never cached.
+
+A cached text is used only if the glyph cache didn't change since, which is
+detected through @ref AbstractGlyphCache::generation(). That makes the cache
+usable also with a @ref DynamicGlyphCache, which adds and evicts glyphs as
+needed. Other changes aren't detected --- in particular, fonts are
+identified only by their address, so if a font is closed or destroyed and
+another one is opened in its place, call @ref clear() to avoid using stale
+data.
+
+@note This class is available only if Magnum is compiled with
+    @ref MAGNUM_TARGET_GL enabled (done by default). See @ref building-features
+    for more information.
+*/
+class MAGNUM_TEXT_EXPORT LayoutCache {
+    public:
+        /**
+         * @brief Constructor
+         * @param glyphCapacity     Total count of glyphs that can be cached
+         *
+         * No memory is allocated until the first text is cached.
+         */
+        explicit LayoutCache(UnsignedInt glyphCapacity = 16384);
+
+        /** @brief Copying is not allowed */
+        LayoutCache(const LayoutCache&) = delete;
+
+        /** @brief Move constructor */
+        LayoutCache(LayoutCache&&) noexcept;
+
+        ~LayoutCache();
+
+        /** @brief Copying is not allowed */
+        LayoutCache& operator=(const LayoutCache&) = delete;
+
+        /** @brief Move assignment */
+        LayoutCache& operator=(LayoutCache&&) noexcept;
+
+        /** @brief Total count of glyphs that can be cached */
+        UnsignedInt glyphCapacity() const;
+
+        /**
+         * @brief Count of cached glyphs
+         *
+         * Includes also glyphs of texts that were invalidated by a glyph
+         * cache change but not yet dropped. Never larger than
+         * @ref glyphCapacity().
+         */
+        UnsignedInt glyphCount() const;
+
+        /** @brief Count of cached texts */
+        std::size_t textCount() const;
+
+        /**
+         * @brief Count of cache hits
+         *
+         * Count of texts that were taken from the cache without doing the
+         * layout. Not reset by @ref clear().
+         */
+        std::size_t hitCount() const;
+
+        /**
+         * @brief Count of cache misses
+         *
+         * Count of texts that had to be laid out, either because they
+         * weren't in the cache yet or because the glyph cache changed since.
+         * Not reset by @ref clear().
+         */
+        std::size_t missCount() const;
+
+        /**
+         * @brief Drop all cached texts
+         *
+         * Keeps the allocated memory for reuse.
+         */
+        void clear();
+
+    private:
+        friend Implementation::LayoutCacheAccess;
+
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+}}
+#else
+#error this header is available only in the OpenGL build
+#endif
+
+#endif
@@ -0,0 +1,85 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MultiChannelDistanceFieldGlyphCache.h"
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/GL/TextureFormat.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/TextureTools/DistanceFieldCpu.h"
+
+namespace Magnum { namespace Text {
+
+MultiChannelDistanceFieldGlyphCache::MultiChannelDistanceFieldGlyphCache(const Vector2i& originalSize, const Vector2i& size, const UnsignedInt radius):
+    #ifndef MAGNUM_TARGET_GLES2
+    GlyphCache{GL::TextureFormat::RGB8, originalSize, size, Vector2i(radius)},
+    #else
+    GlyphCache{GL::TextureFormat::RGB, originalSize, size, Vector2i(radius)},
+    #endif
+    _scale{Vector2(size)/Vector2(originalSize)}, _radius{radius}
+{
+    CORRADE_ASSERT((size <= originalSize).all(),
+        "Text::MultiChannelDistanceFieldGlyphCache: expected size to not be larger than" << Debug::packed << originalSize << "but got" << Debug::packed << size, );
+}
+
+void MultiChannelDistanceFieldGlyphCache::doSetImage(const Vector2i& offset, const ImageView2D& image) {
+    CORRADE_ASSERT(image.format() == PixelFormat::R8Unorm,
+        "Text::MultiChannelDistanceFieldGlyphCache::setImage(): expected" << PixelFormat::R8Unorm << "but got" << image.format(), );
+
+    /* Calculate a single-channel distance field on the CPU */
+    const Vector2i outputSize = image.size()*_scale;
+    Image2D distanceField{PixelStorage{}.setAlignment(1), PixelFormat::R8Unorm, outputSize, Containers::Array<char>{NoInit, std::size_t(outputSize.product())}};
+    TextureTools::distanceFieldInto(image, distanceField, _radius);
+
+    /* Replicate it to all three channels */
+    Image2D rgb{PixelStorage{}.setAlignment(1), PixelFormat::RGB8Unorm, outputSize, Containers::Array<char>{NoInit, std::size_t(outputSize.product()*3)}};
+    const Containers::StridedArrayView2D<const UnsignedByte> src = distanceField.pixels<UnsignedByte>();
+    const Containers::StridedArrayView2D<Color3ub> dst = rgb.pixels<Color3ub>();
+    for(std::size_t y = 0; y != src.size()[0]; ++y)
+        for(std::size_t x = 0; x != src.size()[1]; ++x)
+            dst[y][x] = Color3ub{src[y][x]};
+
+    texture().setSubImage(0, offset*_scale, rgb);
+}
+
+void MultiChannelDistanceFieldGlyphCache::setDistanceFieldImage(const Vector2i& offset, const ImageView2D& image) {
+    CORRADE_ASSERT(image.format() == PixelFormat::RGB8Unorm,
+        "Text::MultiChannelDistanceFieldGlyphCache::setDistanceFieldImage(): expected" << PixelFormat::RGB8Unorm << "but got" << image.format(), );
+
+    texture().setSubImage(0, offset, image);
+}
+
+#ifndef MAGNUM_TARGET_GLES
+Image2D MultiChannelDistanceFieldGlyphCache::doImage() {
+    return texture().image(0, Image2D{PixelStorage{}.setAlignment(1), PixelFormat::RGB8Unorm});
+}
+#endif
+
+}}
@@ -0,0 +1,119 @@
+#ifndef Magnum_Text_MultiChannelDistanceFieldGlyphCache_h
+#define Magnum_Text_MultiChannelDistanceFieldGlyphCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Text::MultiChannelDistanceFieldGlyphCache
+ * @m_since_latest
+ */
+
+#include "Magnum/configure.h"
+
+#ifdef MAGNUM_TARGET_GL
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/Text/GlyphCache.h"
+
+namespace Magnum { namespace Text {
+
+/**
+@brief Glyph cache with multi-channel distance field rendering
+@m_since_latest
+
+Unlike @ref DistanceFieldGlyphCache, which stores a single-channel signed
+distance field, this cache stores a three-channel one, where a median of the
+red, green and blue channel gives the distance. Compared to a single-channel
+distance field, which rounds off sharp corners unless the resolution is high,
+a multi-channel distance field preserves them, allowing the cache texture to
+be several times smaller at equivalent quality. Use it together with
+@ref Shaders::DistanceFieldVectorGL with
+@ref Shaders::DistanceFieldVectorGL::Flag::MultiChannel enabled.
+
+@section Text-MultiChannelDistanceFieldGlyphCache-usage Usage
+
+Generating a multi-channel distance field requires the glyph outlines, which
+the font plugins don't provide --- they only rasterize the glyphs. The data
+are thus expected to be generated externally, for example with
+[msdfgen](https://github.com/Chlumsky/msdfgen), and uploaded using
+@ref setDistanceFieldImage() to areas reserved with @ref reserve() and
+populated with @ref insert(), with the radius matching what was used for the
+generation:
+
+@snippet MagnumText.cpp MultiChannelDistanceFieldGlyphCache-usage
+
+As a fallback, rasterized glyph images passed to @ref setImage(), such as
+when using @ref AbstractFont::fillGlyphCache(), are converted to a
+single-channel distance field on the CPU using
+@ref TextureTools::distanceFieldInto() and replicated to all three channels.
+That makes the cache usable with any font, but without the sharp corners.
+
+@note This class is available only if Magnum is compiled with
+    @ref MAGNUM_TARGET_GL enabled (done by default). See @ref building-features
+    for more information.
+*/
+class MAGNUM_TEXT_EXPORT MultiChannelDistanceFieldGlyphCache: public GlyphCache {
+    public:
+        /**
+         * @brief Constructor
+         * @param originalSize      Unscaled glyph cache texture size
+         * @param size              Actual glyph cache texture size
+         * @param radius            Distance field radius
+         *
+         * The @p size is expected to be not larger than @p originalSize.
+         * The @p radius is used as glyph padding and for the distance field
+         * conversion in @ref setImage(). Sets internal texture format to
+         * @ref GL::TextureFormat::RGB8, on OpenGL ES 2.0 and WebGL 1.0 to
+         * @ref GL::TextureFormat::RGB.
+         */
+        explicit MultiChannelDistanceFieldGlyphCache(const Vector2i& originalSize, const Vector2i& size, UnsignedInt radius);
+
+        /** @brief Distance field radius */
+        UnsignedInt radius() const { return _radius; }
+
+        /**
+         * @brief Set multi-channel distance field cache image
+         *
+         * Uploads already computed multi-channel distance field image to
+         * given offset in the distance field texture. Expects that the image
+         * is @ref PixelFormat::RGB8Unorm.
+         */
+        void setDistanceFieldImage(const Vector2i& offset, const ImageView2D& image);
+
+    private:
+        void MAGNUM_TEXT_LOCAL doSetImage(const Vector2i& offset, const ImageView2D& image) override;
+        #ifndef MAGNUM_TARGET_GLES
+        Image2D MAGNUM_TEXT_LOCAL doImage() override;
+        #endif
+
+        Vector2 _scale;
+        UnsignedInt _radius;
+};
+
+}}
+#else
+#error this header is available only in the OpenGL build
+#endif
+
+#endif
@@ -27,15 +27,35 @@
 
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/ArrayViewStl.h>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Utility/Algorithms.h>
+#ifndef MAGNUM_TARGET_GLES
+#include <cstring>
+#endif
+#ifndef MAGNUM_TARGET_GLES2
+#include <unordered_map>
+#endif
 
 #include "Magnum/Mesh.h"
 #include "Magnum/GL/Context.h"
 #include "Magnum/GL/Extensions.h"
 #include "Magnum/GL/Mesh.h"
+#ifndef MAGNUM_TARGET_GLES
+#include "Magnum/GL/StreamingBuffer.h"
+#endif
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/GL/Sampler.h"
+#include "Magnum/GL/Texture.h"
+#include "Magnum/GL/TextureFormat.h"
+#endif
 #include "Magnum/Math/Functions.h"
 #include "Magnum/Shaders/GenericGL.h"
 #include "Magnum/Text/AbstractFont.h"
 #include "Magnum/Text/GlyphCache.h"
+#include "Magnum/Text/LayoutCache.h"
+#include "Magnum/Text/Implementation/layoutCache.h"
 
 namespace Magnum { namespace Text {
 
@@ -176,6 +196,20 @@ std::tuple<std::vector<Vertex>, Range2D> renderVerticesInternal(AbstractFont& fo
     return std::make_tuple(std::move(vertices), rectangle);
 }
 
+/* Takes the vertices from the layout cache if there's one and the text is in
+   it, otherwise lays the text out into the storage and puts it into the
+   cache. The returned view is valid only until the next call. */
+Containers::ArrayView<const Vertex> renderVerticesCachedInternal(LayoutCache* const layoutCache, std::vector<Vertex>& storage, Range2D& rectangle, AbstractFont& font, const GlyphCache& cache, const Float size, const std::string& text, const Alignment alignment) {
+    Containers::ArrayView<const Vector2> cached;
+    if(layoutCache && Implementation::LayoutCacheAccess::find(*layoutCache, font, cache, size, alignment, text, cached, rectangle))
+        return Containers::arrayCast<const Vertex>(cached);
+
+    std::tie(storage, rectangle) = renderVerticesInternal(font, cache, size, text, alignment);
+    if(layoutCache)
+        Implementation::LayoutCacheAccess::add(*layoutCache, font, cache, size, alignment, text, Containers::arrayCast<const Vector2>(Containers::arrayView(storage)), rectangle);
+    return storage;
+}
+
 std::pair<Containers::Array<char>, MeshIndexType> renderIndicesInternal(const UnsignedInt glyphCount) {
     const UnsignedInt vertexCount = glyphCount*4;
     const UnsignedInt indexCount = glyphCount*6;
@@ -199,6 +233,20 @@ std::pair<Containers::Array<char>, MeshIndexType> renderIndicesInternal(const Un
     return {std::move(indices), indexType};
 }
 
+#ifndef MAGNUM_TARGET_GLES
+/* Used when switching between a regular and a streaming vertex buffer. The
+   attribute setup is the same for 2D and 3D as the positions are
+   two-component in both, so it doesn't need to be done in the subclass. */
+GL::Mesh meshInternal(GL::Buffer& vertexBuffer) {
+    GL::Mesh mesh;
+    mesh.setPrimitive(MeshPrimitive::Triangles)
+        .addVertexBuffer(vertexBuffer, 0,
+            Shaders::GenericGL2D::Position{},
+            Shaders::GenericGL2D::TextureCoordinates{});
+    return mesh;
+}
+#endif
+
 std::tuple<GL::Mesh, Range2D> renderInternal(AbstractFont& font, const GlyphCache& cache, Float size, const std::string& text, GL::Buffer& vertexBuffer, GL::Buffer& indexBuffer, GL::BufferUsage usage, Alignment alignment) {
     /* Render vertices and upload them */
     std::vector<Vertex> vertices;
@@ -297,6 +345,20 @@ void AbstractRenderer::bufferUnmapImplementationDefault(GL::Buffer& buffer)
     #endif
 }
 
+#ifndef MAGNUM_TARGET_GLES
+struct AbstractRenderer::Streaming {
+    explicit Streaming(const UnsignedInt glyphCapacity, const UnsignedInt bufferCount): buffer{std::size_t(glyphCapacity)*bufferCount*4*sizeof(Vertex), glyphCapacity*4*sizeof(Vertex)}, shadow{ValueInit, std::size_t(glyphCapacity)*bufferCount*4}, writtenGlyphCounts{ValueInit, bufferCount} {}
+
+    GL::StreamingBuffer buffer;
+    /* CPU-side copy of what was written to each copy of the vertex data, as
+       reading back from the mapped memory would be slow */
+    Containers::Array<Vertex> shadow;
+    /* Count of glyphs ever written to each copy. Contents past it are
+       undefined and have to be always written. */
+    Containers::Array<UnsignedInt> writtenGlyphCounts;
+};
+#endif
+
 AbstractRenderer::AbstractRenderer(AbstractFont& font, const GlyphCache& cache, const Float size, const Alignment alignment): _vertexBuffer{GL::Buffer::TargetHint::Array}, _indexBuffer{GL::Buffer::TargetHint::ElementArray}, font(font), cache(cache), size(size), _alignment(alignment), _capacity(0) {
     #ifndef MAGNUM_TARGET_GLES
     MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::ARB::map_buffer_range);
@@ -325,9 +387,24 @@ template<UnsignedInt dimensions> Renderer<dimensions>::Renderer(AbstractFont& fo
         typename Shaders::GenericGL<dimensions>::TextureCoordinates());
 }
 
+GL::Buffer& AbstractRenderer::vertexBuffer() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(_streaming) return _streaming->buffer.buffer();
+    #endif
+    return _vertexBuffer;
+}
+
 void AbstractRenderer::reserve(const uint32_t glyphCount, const GL::BufferUsage vertexBufferUsage, const GL::BufferUsage indexBufferUsage) {
     _capacity = glyphCount;
 
+    /* Switch back from a streaming buffer, if it was used */
+    #ifndef MAGNUM_TARGET_GLES
+    if(_streaming) {
+        _streaming = nullptr;
+        _mesh = meshInternal(_vertexBuffer);
+    }
+    #endif
+
     const UnsignedInt vertexCount = glyphCount*4;
 
     /* Allocate vertex buffer, reset vertex count */
@@ -337,6 +414,30 @@ void AbstractRenderer::reserve(const uint32_t glyphCount, const GL::BufferUsage
     #endif
     _mesh.setCount(0);
 
+    reserveIndices(glyphCount, indexBufferUsage);
+}
+
+#ifndef MAGNUM_TARGET_GLES
+void AbstractRenderer::reserveStreaming(const UnsignedInt glyphCount, const UnsignedInt bufferCount, const GL::BufferUsage indexBufferUsage) {
+    CORRADE_ASSERT(glyphCount && bufferCount,
+        "Text::Renderer::reserveStreaming(): expected non-zero glyph and buffer count but got" << glyphCount << "and" << bufferCount, );
+    MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::ARB::buffer_storage);
+    MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::ARB::draw_elements_base_vertex);
+
+    _capacity = glyphCount;
+
+    /* The mesh has to be recreated to use the new buffer */
+    _streaming.emplace(glyphCount, bufferCount);
+    _mesh = meshInternal(_streaming->buffer.buffer());
+    _mesh.setCount(0);
+
+    reserveIndices(glyphCount, indexBufferUsage);
+}
+#endif
+
+void AbstractRenderer::reserveIndices(const UnsignedInt glyphCount, const GL::BufferUsage indexBufferUsage) {
+    const UnsignedInt vertexCount = glyphCount*4;
+
     /* Render indices */
     Containers::Array<char> indexData;
     MeshIndexType indexType;
@@ -359,10 +460,10 @@ void AbstractRenderer::reserve(const uint32_t glyphCount, const GL::BufferUsage
 }
 
 void AbstractRenderer::render(const std::string& text) {
-    /* Render vertex data */
-    std::vector<Vertex> vertexData;
+    /* Render vertex data or take them from the layout cache */
+    std::vector<Vertex> vertexStorage;
     _rectangle = {};
-    std::tie(vertexData, _rectangle) = renderVerticesInternal(font, cache, size, text, _alignment);
+    const Containers::ArrayView<const Vertex> vertexData = renderVerticesCachedInternal(_layoutCache, vertexStorage, _rectangle, font, cache, size, text, _alignment);
 
     const UnsignedInt glyphCount = vertexData.size()/4;
     const UnsignedInt vertexCount = glyphCount*4;
@@ -371,20 +472,427 @@ void AbstractRenderer::render(const std::string& text) {
     CORRADE_ASSERT(glyphCount <= _capacity,
         "Text::Renderer::render(): capacity" << _capacity << "too small to render" << glyphCount << "glyphs", );
 
+    #ifndef MAGNUM_TARGET_GLES
+    if(_streaming) {
+        Streaming& streaming = *_streaming;
+        const std::size_t copyVertexCount = _capacity*4;
+
+        /* Everything submitted since the previous render(), including the
+           draw using the previous copy, has to finish before that copy can
+           be written again. Then take the next copy. */
+        streaming.buffer.fence();
+        const Containers::ArrayView<char> allocation = streaming.buffer.allocate(copyVertexCount*sizeof(Vertex));
+        const UnsignedInt copy = streaming.buffer.offset(allocation)/(copyVertexCount*sizeof(Vertex));
+        const Containers::ArrayView<Vertex> out = Containers::arrayCast<Vertex>(allocation);
+        const Containers::ArrayView<Vertex> shadow = streaming.shadow.slice(copy*copyVertexCount, (copy + 1)*copyVertexCount);
+        UnsignedInt& writtenGlyphCount = streaming.writtenGlyphCounts[copy];
+
+        /* Write only the quads that differ from what was in the copy */
+        for(UnsignedInt i = 0; i != glyphCount; ++i) {
+            const Containers::ArrayView<const Vertex> quad = vertexData.slice(i*4, i*4 + 4);
+            const Containers::ArrayView<Vertex> shadowQuad = shadow.slice(i*4, i*4 + 4);
+            if(i < writtenGlyphCount && std::memcmp(quad.data(), shadowQuad.data(), 4*sizeof(Vertex)) == 0)
+                continue;
+
+            Utility::copy(quad, shadowQuad);
+            Utility::copy(quad, out.slice(i*4, i*4 + 4));
+        }
+        writtenGlyphCount = Math::max(writtenGlyphCount, glyphCount);
+
+        _mesh.setBaseVertex(copy*copyVertexCount)
+            .setCount(indexCount);
+        return;
+    }
+    #endif
+
     /* Interleave the data into mapped buffer*/
     Containers::ArrayView<Vertex> vertices(static_cast<Vertex*>(bufferMapImplementation(_vertexBuffer,
         vertexCount*sizeof(Vertex))), vertexCount);
     CORRADE_INTERNAL_ASSERT_OUTPUT(vertices);
-    std::copy(vertexData.begin(), vertexData.end(), vertices.begin());
+    Utility::copy(vertexData, vertices);
     bufferUnmapImplementation(_vertexBuffer);
 
     /* Update index count */
     _mesh.setCount(indexCount);
 }
 
+struct AbstractBatchRenderer::State {
+    explicit State(AbstractFont& font, const GlyphCache& cache, Float size, Alignment alignment): font(font), cache(cache), size{size}, alignment{alignment} {}
+
+    struct Label {
+        UnsignedInt glyphOffset, glyphCapacity, glyphCount;
+        Vector2 position;
+        /* Relative to the position */
+        Range2D rectangle;
+    };
+
+    AbstractFont& font;
+    const GlyphCache& cache;
+    Float size;
+    Alignment alignment;
+    LayoutCache* layoutCache{};
+
+    /* CPU-side copy of the whole vertex buffer, glyphs not used by any label
+       text are zeroed out and thus degenerate */
+    Containers::Array<Vertex> vertices;
+    Containers::Array<Label> labels;
+    UnsignedInt glyphCount{};
+
+    /* Range of glyphs that need to be uploaded, empty if nothing changed */
+    UnsignedInt dirtyBegin{~UnsignedInt{}}, dirtyEnd{};
+    bool countDirty{};
+};
+
+AbstractBatchRenderer::AbstractBatchRenderer(AbstractFont& font, const GlyphCache& cache, const Float size, const Alignment alignment): _vertexBuffer{GL::Buffer::TargetHint::Array}, _indexBuffer{GL::Buffer::TargetHint::ElementArray}, _state{InPlaceInit, font, cache, size, alignment} {
+    /* Vertex buffer configuration depends on dimension count, done in subclass */
+    _mesh.setPrimitive(MeshPrimitive::Triangles)
+        .setCount(0);
+}
+
+AbstractBatchRenderer::~AbstractBatchRenderer() = default;
+
+template<UnsignedInt dimensions> BatchRenderer<dimensions>::BatchRenderer(AbstractFont& font, const GlyphCache& cache, const Float size, const Alignment alignment): AbstractBatchRenderer{font, cache, size, alignment} {
+    /* Finalize mesh configuration */
+    _mesh.addVertexBuffer(_vertexBuffer, 0,
+        typename Shaders::GenericGL<dimensions>::Position(
+            Shaders::GenericGL<dimensions>::Position::Components::Two),
+        typename Shaders::GenericGL<dimensions>::TextureCoordinates());
+}
+
+UnsignedInt AbstractBatchRenderer::capacity() const {
+    return _state->vertices.size()/4;
+}
+
+UnsignedInt AbstractBatchRenderer::glyphCount() const {
+    return _state->glyphCount;
+}
+
+UnsignedInt AbstractBatchRenderer::labelCount() const {
+    return _state->labels.size();
+}
+
+void AbstractBatchRenderer::reserve(const UnsignedInt glyphCount, const GL::BufferUsage vertexBufferUsage, const GL::BufferUsage indexBufferUsage) {
+    State& state = *_state;
+    state.vertices = Containers::Array<Vertex>{ValueInit, glyphCount*4};
+    state.labels = {};
+    state.glyphCount = 0;
+    state.dirtyBegin = ~UnsignedInt{};
+    state.dirtyEnd = 0;
+    state.countDirty = false;
+
+    /* Allocate the vertex buffer, the data get uploaded in update() */
+    _vertexBuffer.setData({nullptr, state.vertices.size()*sizeof(Vertex)}, vertexBufferUsage);
+
+    /* Render indices and upload them right away, they never change */
+    Containers::Array<char> indexData;
+    MeshIndexType indexType;
+    std::tie(indexData, indexType) = renderIndicesInternal(glyphCount);
+    _indexBuffer.setData(indexData, indexBufferUsage);
+    _mesh.setCount(0)
+        .setIndexBuffer(_indexBuffer, 0, indexType, 0, state.vertices.size());
+}
+
+UnsignedInt AbstractBatchRenderer::add(const std::string& text, const Vector2& position, const UnsignedInt glyphCapacity) {
+    State& state = *_state;
+    CORRADE_ASSERT(state.glyphCount + glyphCapacity <= state.vertices.size()/4,
+        "Text::BatchRenderer::add(): capacity" << state.vertices.size()/4 << "too small to add" << glyphCapacity << "glyphs to" << state.glyphCount << "already used", {});
+
+    const UnsignedInt id = state.labels.size();
+    arrayAppend(state.labels, State::Label{state.glyphCount, glyphCapacity, 0, position, {}});
+    state.glyphCount += glyphCapacity;
+    state.countDirty = true;
+
+    setText(id, text);
+    return id;
+}
+
+UnsignedInt AbstractBatchRenderer::add(const std::string& text, const Vector2& position) {
+    State& state = *_state;
+
+    /* Lay out the text just to know the glyph count. Not ideal to do it
+       twice, but this variant is meant mainly for static labels. With a
+       layout cache the second layout is skipped. */
+    std::vector<Vertex> storage;
+    Range2D rectangle;
+    return add(text, position, renderVerticesCachedInternal(state.layoutCache, storage, rectangle, state.font, state.cache, state.size, text, state.alignment).size()/4);
+}
+
+void AbstractBatchRenderer::clear() {
+    /* The vertex data don't need to be touched, newly added labels overwrite
+       their whole glyph range */
+    State& state = *_state;
+    state.labels = {};
+    state.glyphCount = 0;
+    state.dirtyBegin = ~UnsignedInt{};
+    state.dirtyEnd = 0;
+    state.countDirty = true;
+}
+
+Vector2 AbstractBatchRenderer::position(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _state->labels.size(),
+        "Text::BatchRenderer::position(): index" << id << "out of range for" << _state->labels.size() << "labels", {});
+    return _state->labels[id].position;
+}
+
+Range2D AbstractBatchRenderer::rectangle(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _state->labels.size(),
+        "Text::BatchRenderer::rectangle(): index" << id << "out of range for" << _state->labels.size() << "labels", {});
+    const State::Label& label = _state->labels[id];
+    return label.rectangle.translated(label.position);
+}
+
+std::pair<UnsignedInt, UnsignedInt> AbstractBatchRenderer::glyphRange(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _state->labels.size(),
+        "Text::BatchRenderer::glyphRange(): index" << id << "out of range for" << _state->labels.size() << "labels", {});
+    const State::Label& label = _state->labels[id];
+    return {label.glyphOffset, label.glyphCapacity};
+}
+
+void AbstractBatchRenderer::setText(const UnsignedInt id, const std::string& text) {
+    State& state = *_state;
+    CORRADE_ASSERT(id < state.labels.size(),
+        "Text::BatchRenderer::setText(): index" << id << "out of range for" << state.labels.size() << "labels", );
+    State::Label& label = state.labels[id];
+
+    std::vector<Vertex> storage;
+    const Containers::ArrayView<const Vertex> vertices = renderVerticesCachedInternal(state.layoutCache, storage, label.rectangle, state.font, state.cache, state.size, text, state.alignment);
+    CORRADE_ASSERT(vertices.size() <= label.glyphCapacity*4,
+        "Text::BatchRenderer::setText(): label capacity" << label.glyphCapacity << "too small to render" << vertices.size()/4 << "glyphs", );
+
+    /* Copy the vertices with the position applied, zero out the rest */
+    label.glyphCount = vertices.size()/4;
+    Containers::ArrayView<Vertex> out = state.vertices.slice(label.glyphOffset*4, (label.glyphOffset + label.glyphCapacity)*4);
+    for(std::size_t i = 0; i != vertices.size(); ++i)
+        out[i] = {vertices[i].position + label.position, vertices[i].textureCoordinates};
+    for(Vertex& vertex: out.suffix(vertices.size()))
+        vertex = {};
+
+    state.dirtyBegin = Math::min(state.dirtyBegin, label.glyphOffset);
+    state.dirtyEnd = Math::max(state.dirtyEnd, label.glyphOffset + label.glyphCapacity);
+}
+
+void AbstractBatchRenderer::setPosition(const UnsignedInt id, const Vector2& position) {
+    State& state = *_state;
+    CORRADE_ASSERT(id < state.labels.size(),
+        "Text::BatchRenderer::setPosition(): index" << id << "out of range for" << state.labels.size() << "labels", );
+    State::Label& label = state.labels[id];
+
+    /* Translate only the glyphs that are actually used, the degenerate ones
+       have to stay at zero */
+    const Vector2 delta = position - label.position;
+    label.position = position;
+    for(Vertex& vertex: state.vertices.slice(label.glyphOffset*4, (label.glyphOffset + label.glyphCount)*4))
+        vertex.position += delta;
+
+    state.dirtyBegin = Math::min(state.dirtyBegin, label.glyphOffset);
+    state.dirtyEnd = Math::max(state.dirtyEnd, label.glyphOffset + label.glyphCount);
+}
+
+LayoutCache* AbstractBatchRenderer::layoutCache() const {
+    return _state->layoutCache;
+}
+
+AbstractBatchRenderer& AbstractBatchRenderer::setLayoutCache(LayoutCache* const cache) {
+    _state->layoutCache = cache;
+    return *this;
+}
+
+void AbstractBatchRenderer::update() {
+    State& state = *_state;
+
+    /* Upload everything between the first and last dirty glyph in one go.
+       For scattered updates it might upload unchanged data in between, but
+       a single large upload is generally cheaper than many small ones. */
+    if(state.dirtyBegin < state.dirtyEnd) {
+        _vertexBuffer.setSubData(state.dirtyBegin*4*sizeof(Vertex),
+            state.vertices.slice(state.dirtyBegin*4, state.dirtyEnd*4));
+        state.dirtyBegin = ~UnsignedInt{};
+        state.dirtyEnd = 0;
+    }
+
+    if(state.countDirty) {
+        _mesh.setCount(state.glyphCount*6);
+        state.countDirty = false;
+    }
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+struct InstancedRenderer::State {
+    explicit State(AbstractFont& font, const GlyphCache& cache, Float size, Alignment alignment): font(font), cache(cache), size{size}, alignment{alignment}, instanceBuffer{GL::Buffer::TargetHint::Array} {}
+
+    /* Matches the GlyphOffsetScale, GlyphId and GlyphColor attributes of
+       Shaders::VectorGL and Shaders::DistanceFieldVectorGL */
+    struct Instance {
+        Vector3 offsetScale;
+        UnsignedInt glyphId;
+        Color4 color;
+    };
+
+    AbstractFont& font;
+    const GlyphCache& cache;
+    Float size;
+    Alignment alignment;
+
+    GL::Texture2D glyphRectangleTexture;
+    GL::Buffer instanceBuffer;
+    GL::Mesh mesh;
+
+    /* Cache generation the glyph rectangle texture was filled from */
+    UnsignedInt cacheGeneration;
+    /* Glyph rectangle in the cache texture, packed into a single 64-bit
+       value, mapped to the glyph row in the glyph rectangle texture and the
+       minimum of its quad in the cache pixel units */
+    std::unordered_map<UnsignedLong, std::pair<UnsignedInt, Vector2>> glyphs;
+
+    UnsignedInt capacity{}, glyphCount{};
+    Range2D rectangle;
+};
+
+namespace {
+
+/* Glyph cache textures are never larger than 64k, so 16 bits for each
+   coordinate is enough */
+inline UnsignedLong packGlyphRectangle(const Range2Di& rectangle) {
+    return UnsignedLong(UnsignedShort(rectangle.left())) |
+           UnsignedLong(UnsignedShort(rectangle.bottom())) << 16 |
+           UnsignedLong(UnsignedShort(rectangle.right())) << 32 |
+           UnsignedLong(UnsignedShort(rectangle.top())) << 48;
+}
+
+}
+
+InstancedRenderer::InstancedRenderer(AbstractFont& font, const GlyphCache& cache, const Float size, const Alignment alignment): _state{InPlaceInit, font, cache, size, alignment} {
+    #ifndef MAGNUM_TARGET_GLES
+    MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::ARB::instanced_arrays);
+    #endif
+
+    State& state = *_state;
+    state.glyphRectangleTexture
+        .setMinificationFilter(GL::SamplerFilter::Nearest, GL::SamplerMipmap::Base)
+        .setMagnificationFilter(GL::SamplerFilter::Nearest)
+        .setWrapping(GL::SamplerWrapping::ClampToEdge);
+    state.mesh.setPrimitive(MeshPrimitive::TriangleStrip)
+        .setCount(4)
+        .setInstanceCount(0)
+        .addVertexBufferInstanced(state.instanceBuffer, 1, 0,
+            Shaders::GenericGL3D::TextureOffsetLayer{},
+            Shaders::GenericGL3D::ObjectId{},
+            Shaders::GenericGL3D::Color4{});
+
+    updateGlyphRectangles();
+}
+
+InstancedRenderer::~InstancedRenderer() = default;
+
+UnsignedInt InstancedRenderer::capacity() const {
+    return _state->capacity;
+}
+
+UnsignedInt InstancedRenderer::glyphCount() const {
+    return _state->glyphCount;
+}
+
+Range2D InstancedRenderer::rectangle() const {
+    return _state->rectangle;
+}
+
+GL::Texture2D& InstancedRenderer::glyphRectangleTexture() {
+    return _state->glyphRectangleTexture;
+}
+
+GL::Buffer& InstancedRenderer::instanceBuffer() {
+    return _state->instanceBuffer;
+}
+
+GL::Mesh& InstancedRenderer::mesh() {
+    return _state->mesh;
+}
+
+void InstancedRenderer::updateGlyphRectangles() {
+    State& state = *_state;
+    const Vector2 textureSize{state.cache.textureSize()};
+
+    /* Each row is the glyph quad in cache pixel units followed by its
+       texture coordinates, both as a min and max. Always at least one row to
+       have a valid texture. */
+    Containers::Array<Vector4> data{ValueInit, Math::max(std::size_t{1}, state.cache.glyphCount())*2};
+    state.glyphs.clear();
+    UnsignedInt row = 0;
+    for(const auto& glyph: state.cache) {
+        const Vector2i& position = glyph.second.first;
+        const Range2Di& rectangle = glyph.second.second;
+        const Range2D quad{Range2Di::fromSize(position, rectangle.size())};
+        const Range2D textureCoordinates = Range2D{rectangle}.scaled(1.0f/textureSize);
+        data[row*2 + 0] = {quad.left(), quad.bottom(), quad.right(), quad.top()};
+        data[row*2 + 1] = {textureCoordinates.left(), textureCoordinates.bottom(), textureCoordinates.right(), textureCoordinates.top()};
+
+        /* If more glyphs share the same rectangle, the first one wins. The
+           quad size is the same for all of them and the offset is calculated
+           relative to the quad minimum, so it doesn't matter. */
+        state.glyphs.emplace(packGlyphRectangle(rectangle), std::make_pair(row, quad.min()));
+        ++row;
+    }
+
+    state.glyphRectangleTexture.setImage(0, GL::TextureFormat::RGBA32F,
+        ImageView2D{PixelFormat::RGBA32F, {2, Int(data.size()/2)}, data});
+    state.cacheGeneration = state.cache.generation();
+}
+
+void InstancedRenderer::reserve(const UnsignedInt glyphCount, const GL::BufferUsage usage) {
+    State& state = *_state;
+    state.capacity = glyphCount;
+    state.glyphCount = 0;
+    state.instanceBuffer.setData({nullptr, glyphCount*sizeof(State::Instance)}, usage);
+    state.mesh.setInstanceCount(0);
+}
+
+void InstancedRenderer::render(const std::string& text, const Color4& color) {
+    State& state = *_state;
+
+    /* Glyphs were added to or removed from the cache since the last time,
+       refill the texture */
+    if(state.cacheGeneration != state.cache.generation())
+        updateGlyphRectangles();
+
+    std::vector<Vertex> vertices;
+    Range2D rectangle;
+    std::tie(vertices, rectangle) = renderVerticesInternal(state.font, state.cache, state.size, text, state.alignment);
+
+    const UnsignedInt glyphCount = vertices.size()/4;
+    CORRADE_ASSERT(glyphCount <= state.capacity,
+        "Text::InstancedRenderer::render(): capacity" << state.capacity << "too small to render" << glyphCount << "glyphs", );
+
+    /* Find the glyph by its texture coordinates and derive the offset from
+       the bottom left corner of its quad */
+    const Vector2 textureSize{state.cache.textureSize()};
+    const Float scale = state.size/state.font.size();
+    Containers::Array<State::Instance> instances{NoInit, glyphCount};
+    for(UnsignedInt i = 0; i != glyphCount; ++i) {
+        const Vertex& bottomLeft = vertices[i*4 + 1];
+        const Vertex& topRight = vertices[i*4 + 2];
+        const Range2D textureCoordinates{bottomLeft.textureCoordinates, topRight.textureCoordinates};
+        const auto found = state.glyphs.find(packGlyphRectangle(Range2Di{
+            Vector2i{Math::round(textureCoordinates.min()*textureSize)},
+            Vector2i{Math::round(textureCoordinates.max()*textureSize)}}));
+        CORRADE_ASSERT(found != state.glyphs.end(),
+            "Text::InstancedRenderer::render(): no glyph in the cache matches texture coordinates" << textureCoordinates, );
+        instances[i] = State::Instance{
+            {bottomLeft.position - found->second.second*scale, scale},
+            found->second.first, color};
+    }
+
+    state.instanceBuffer.setSubData(0, instances);
+    state.mesh.setInstanceCount(glyphCount);
+    state.glyphCount = glyphCount;
+    state.rectangle = rectangle;
+}
+#endif
+
 #ifndef DOXYGEN_GENERATING_OUTPUT
 template class MAGNUM_TEXT_EXPORT Renderer<2>;
 template class MAGNUM_TEXT_EXPORT Renderer<3>;
+template class MAGNUM_TEXT_EXPORT BatchRenderer<2>;
+template class MAGNUM_TEXT_EXPORT BatchRenderer<3>;
 #endif
 
 }}
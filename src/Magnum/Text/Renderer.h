@@ -26,7 +26,7 @@
 */
 
 /** @file Text/Renderer.h
- * @brief Class @ref Magnum::Text::AbstractRenderer, @ref Magnum::Text::Renderer, typedef @ref Magnum::Text::Renderer2D, @ref Magnum::Text::Renderer3D
+ * @brief Class @ref Magnum::Text::AbstractRenderer, @ref Magnum::Text::Renderer, @ref Magnum::Text::AbstractBatchRenderer, @ref Magnum::Text::BatchRenderer, @ref Magnum::Text::InstancedRenderer, typedef @ref Magnum::Text::Renderer2D, @ref Magnum::Text::Renderer3D, @ref Magnum::Text::BatchRenderer2D, @ref Magnum::Text::BatchRenderer3D
  */
 
 #include "Magnum/configure.h"
@@ -35,8 +35,10 @@
 #include <string>
 #include <tuple>
 #include <vector>
+#include <Corrade/Containers/Pointer.h>
 
 #include "Magnum/DimensionTraits.h"
+#include "Magnum/Math/Color.h"
 #include "Magnum/Math/Range.h"
 #include "Magnum/GL/Buffer.h"
 #include "Magnum/GL/Mesh.h"
@@ -81,8 +83,13 @@ class MAGNUM_TEXT_EXPORT AbstractRenderer {
         /** @brief Rectangle spanning the rendered text */
         Range2D rectangle() const { return _rectangle; }
 
-        /** @brief Vertex buffer */
-        GL::Buffer& vertexBuffer() { return _vertexBuffer; }
+        /**
+         * @brief Vertex buffer
+         *
+         * If @ref reserveStreaming() was called, returns the buffer
+         * underlying the persistently mapped @ref GL::StreamingBuffer.
+         */
+        GL::Buffer& vertexBuffer();
 
         /** @brief Index buffer */
         GL::Buffer& indexBuffer() { return _indexBuffer; }
@@ -99,11 +106,46 @@ class MAGNUM_TEXT_EXPORT AbstractRenderer {
          * only by calling this function, thus @p indexBufferUsage generally
          * doesn't need to be so dynamic if the capacity won't be changed much.
          *
-         * Initially zero capacity is reserved.
+         * Initially zero capacity is reserved. If @ref reserveStreaming() was
+         * called before, the renderer is switched back to a regular vertex
+         * buffer.
          * @see @ref capacity()
          */
         void reserve(UnsignedInt glyphCount, GL::BufferUsage vertexBufferUsage, GL::BufferUsage indexBufferUsage);
 
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Reserve capacity for rendered glyphs in a persistently mapped buffer
+         * @param glyphCount        Glyph capacity
+         * @param bufferCount       Count of vertex data copies to cycle
+         *      through
+         * @param indexBufferUsage  Index buffer usage
+         * @m_since_latest
+         *
+         * Unlike @ref reserve(), where each @ref render(const std::string&)
+         * maps the vertex buffer, writes all glyphs and unmaps it again,
+         * the vertex data are stored in a @ref GL::StreamingBuffer that's
+         * mapped just once and holds @p bufferCount copies of them. Each
+         * @ref render(const std::string&) writes to the next copy and
+         * switches the mesh to it using @ref GL::Mesh::setBaseVertex().
+         * Only glyph quads that differ from what was written to the same
+         * copy the last time are written. The index buffer is filled for
+         * the whole capacity here and isn't touched afterwards.
+         *
+         * A copy is marked as used by the GPU with a fence at the beginning
+         * of the next @ref render(const std::string&) call, so the mesh is
+         * expected to be drawn in between. Before a copy gets written again,
+         * the renderer waits for its fence --- to avoid stalls, the
+         * @p bufferCount should cover all frames in flight. Expects that
+         * both @p glyphCount and @p bufferCount are non-zero.
+         * @requires_gl44 Extension @gl_extension{ARB,buffer_storage}
+         * @requires_gl32 Extension @gl_extension{ARB,draw_elements_base_vertex}
+         * @requires_gl Persistently mapped buffers are not available in
+         *      OpenGL ES and WebGL.
+         */
+        void reserveStreaming(UnsignedInt glyphCount, UnsignedInt bufferCount = 3, GL::BufferUsage indexBufferUsage = GL::BufferUsage::StaticDraw);
+        #endif
+
         /**
          * @brief Render text
          *
@@ -117,6 +159,30 @@ class MAGNUM_TEXT_EXPORT AbstractRenderer {
          */
         void render(const std::string& text);
 
+        /**
+         * @brief Layout cache
+         * @m_since_latest
+         *
+         * @cpp nullptr @ce if not set.
+         */
+        LayoutCache* layoutCache() const { return _layoutCache; }
+
+        /**
+         * @brief Set layout cache
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * If set, @ref render(const std::string&) takes already laid out
+         * text from @p cache instead of doing the layout again and puts newly
+         * laid out text into it. The cache is expected to stay in scope for
+         * as long as it's set. Pass @cpp nullptr @ce to not use a cache,
+         * which is the default.
+         */
+        AbstractRenderer& setLayoutCache(LayoutCache* cache) {
+            _layoutCache = cache;
+            return *this;
+        }
+
     #ifndef DOXYGEN_GENERATING_OUTPUT
     protected:
     #else
@@ -139,6 +205,13 @@ class MAGNUM_TEXT_EXPORT AbstractRenderer {
         Alignment _alignment;
         UnsignedInt _capacity;
         Range2D _rectangle;
+        LayoutCache* _layoutCache{};
+        #ifndef MAGNUM_TARGET_GLES
+        struct Streaming;
+        Containers::Pointer<Streaming> _streaming;
+        #endif
+
+        void MAGNUM_TEXT_LOCAL reserveIndices(UnsignedInt glyphCount, GL::BufferUsage indexBufferUsage);
 
         #if defined(MAGNUM_TARGET_GLES2) && !defined(CORRADE_TARGET_EMSCRIPTEN)
         typedef void*(*BufferMapImplementation)(GL::Buffer&, GLsizeiptr);
@@ -193,6 +266,16 @@ that doesn't recreate everything on each text change:
 
 @snippet MagnumText.cpp Renderer-usage2
 
+On desktop OpenGL, frequently changing text can be rendered into a
+persistently mapped buffer instead, which avoids mapping the buffer on every
+change and writes only the glyphs that changed. Enable it by calling
+@ref reserveStreaming() instead of @ref reserve(), and draw the mesh after
+every @ref render(const std::string&) call.
+
+If the same texts get rendered repeatedly, such as when cycling through a
+fixed set of labels or numbers, set a @ref LayoutCache using
+@ref setLayoutCache() to avoid laying them out again every time.
+
 @section Text-Renderer-required-opengl-functionality Required OpenGL functionality
 
 Mutable text rendering requires @gl_extension{ARB,map_buffer_range} on desktop
@@ -244,6 +327,362 @@ typedef Renderer<2> Renderer2D;
 /** @brief Three-dimensional text renderer */
 typedef Renderer<3> Renderer3D;
 
+/**
+@brief Base for batch text renderers
+@m_since_latest
+
+Not meant to be used directly, see @ref BatchRenderer for more information.
+@see @ref BatchRenderer2D, @ref BatchRenderer3D
+*/
+class MAGNUM_TEXT_EXPORT AbstractBatchRenderer {
+    public:
+        /** @brief Copying is not allowed */
+        AbstractBatchRenderer(const AbstractBatchRenderer&) = delete;
+
+        /** @brief Copying is not allowed */
+        AbstractBatchRenderer& operator=(const AbstractBatchRenderer&) = delete;
+
+        /**
+         * @brief Capacity for rendered glyphs
+         *
+         * Total count of glyphs for all labels. Initially zero.
+         * @see @ref reserve(), @ref glyphCount()
+         */
+        UnsignedInt capacity() const;
+
+        /**
+         * @brief Count of glyphs allocated for labels
+         *
+         * Sum of glyph capacities of all labels added with @ref add(). Never
+         * larger than @ref capacity().
+         */
+        UnsignedInt glyphCount() const;
+
+        /** @brief Count of added labels */
+        UnsignedInt labelCount() const;
+
+        /** @brief Vertex buffer */
+        GL::Buffer& vertexBuffer() { return _vertexBuffer; }
+
+        /** @brief Index buffer */
+        GL::Buffer& indexBuffer() { return _indexBuffer; }
+
+        /**
+         * @brief Mesh
+         *
+         * Contains all labels. The index count is updated in @ref update().
+         */
+        GL::Mesh& mesh() { return _mesh; }
+
+        /**
+         * @brief Reserve capacity for rendered glyphs
+         *
+         * Reallocates both buffers to hold @p glyphCount glyphs and prefills
+         * the index buffer. All labels are removed. Initially zero capacity
+         * is reserved.
+         * @see @ref capacity()
+         */
+        void reserve(UnsignedInt glyphCount, GL::BufferUsage vertexBufferUsage, GL::BufferUsage indexBufferUsage);
+
+        /**
+         * @brief Add a label
+         * @param text          Label text
+         * @param position      Label position
+         * @param glyphCapacity Count of glyphs reserved for the label
+         * @return Label ID, numbered consecutively from zero
+         *
+         * The text is laid out right away and positioned so its alignment
+         * origin is at @p position. Expects that the @p text fits into
+         * @p glyphCapacity and that there's enough space left in
+         * @ref capacity(). The GPU data are updated on the next
+         * @ref update() call.
+         */
+        UnsignedInt add(const std::string& text, const Vector2& position, UnsignedInt glyphCapacity);
+
+        /**
+         * @brief Add a label with glyph capacity matching its text
+         *
+         * Same as calling @ref add(const std::string&, const Vector2&, UnsignedInt)
+         * with @p glyphCapacity being the count of glyphs the @p text is laid
+         * out to. The label text can be changed later only to a text with the
+         * same or smaller glyph count.
+         */
+        UnsignedInt add(const std::string& text, const Vector2& position);
+
+        /**
+         * @brief Remove all labels
+         *
+         * Keeps the capacity. The mesh index count is updated on the next
+         * @ref update() call.
+         */
+        void clear();
+
+        /**
+         * @brief Label position
+         *
+         * Expects that @p id is less than @ref labelCount().
+         */
+        Vector2 position(UnsignedInt id) const;
+
+        /**
+         * @brief Rectangle spanning the label text
+         *
+         * Includes the label position. Expects that @p id is less than
+         * @ref labelCount().
+         */
+        Range2D rectangle(UnsignedInt id) const;
+
+        /**
+         * @brief Glyph range of a label
+         *
+         * Returns offset of the first glyph and glyph capacity of the label.
+         * Multiply both by @cpp 6 @ce to get an index range for drawing a
+         * subset of the labels via a @ref GL::MeshView. Expects that @p id is
+         * less than @ref labelCount().
+         */
+        std::pair<UnsignedInt, UnsignedInt> glyphRange(UnsignedInt id) const;
+
+        /**
+         * @brief Change label text
+         *
+         * Lays out the text again and marks the label as dirty. Glyphs that
+         * are not used by the new text are made degenerate, so they don't
+         * get rendered. Expects that @p id is less than @ref labelCount() and
+         * that the text fits into the glyph capacity of given label.
+         * @see @ref update()
+         */
+        void setText(UnsignedInt id, const std::string& text);
+
+        /**
+         * @brief Change label position
+         *
+         * Translates already laid out glyphs and marks the label as dirty,
+         * without laying out the text again. Expects that @p id is less than
+         * @ref labelCount().
+         * @see @ref update()
+         */
+        void setPosition(UnsignedInt id, const Vector2& position);
+
+        /**
+         * @brief Layout cache
+         * @m_since_latest
+         *
+         * @cpp nullptr @ce if not set.
+         */
+        LayoutCache* layoutCache() const;
+
+        /**
+         * @brief Set layout cache
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * If set, @ref add() and @ref setText() take already laid out text
+         * from @p cache instead of doing the layout again and put newly laid
+         * out text into it. The cache is expected to stay in scope for as
+         * long as it's set. Pass @cpp nullptr @ce to not use a cache, which
+         * is the default.
+         */
+        AbstractBatchRenderer& setLayoutCache(LayoutCache* cache);
+
+        /**
+         * @brief Upload dirty labels
+         *
+         * Uploads a contiguous range of the vertex buffer spanning all labels
+         * added or changed since the last call and updates the mesh index
+         * count. If nothing changed, the function is a no-op.
+         */
+        void update();
+
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    protected:
+    #else
+    private:
+    #endif
+        explicit MAGNUM_TEXT_LOCAL AbstractBatchRenderer(AbstractFont& font, const GlyphCache& cache, Float size, Alignment alignment);
+
+        ~AbstractBatchRenderer();
+
+        GL::Mesh _mesh;
+        GL::Buffer _vertexBuffer, _indexBuffer;
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+/**
+@brief Batch text renderer
+@m_since_latest
+
+Compared to @ref Renderer, which needs a dedicated mesh and a pair of buffers
+for every text, this renderer lays out many labels into a single shared vertex
+buffer. Each label has a fixed range of glyphs in the buffer, changing its
+text or position updates only that range and all labels are drawn with a
+single draw call with @ref Shaders::VectorGL or
+@ref Shaders::DistanceFieldVectorGL, as the label positions are baked into the
+vertex data:
+
+@snippet MagnumText.cpp BatchRenderer-usage
+
+Changes done through @ref add(), @ref setText() and @ref setPosition() are
+only recorded on the CPU side, the vertex data of all changed labels is then
+uploaded with a single buffer update in @ref update(). Text layout is done
+only for labels whose text changes, moving a label doesn't need a relayout.
+
+As all labels share the same font, glyph cache, size and alignment, use
+multiple instances for labels that differ in any of these. Subsets of the
+labels can be drawn using @ref GL::MeshView and ranges returned from
+@ref glyphRange().
+
+Labels that are set to the same text over and over can avoid repeated layout
+by using a @ref LayoutCache, set via @ref setLayoutCache().
+
+Unlike @ref Renderer, buffer mapping isn't used, so there are no extension
+requirements.
+@see @ref BatchRenderer2D, @ref BatchRenderer3D
+*/
+template<UnsignedInt dimensions> class MAGNUM_TEXT_EXPORT BatchRenderer: public AbstractBatchRenderer {
+    public:
+        /**
+         * @brief Constructor
+         * @param font          Font
+         * @param cache         Glyph cache
+         * @param size          Font size
+         * @param alignment     Text alignment of all labels relative to their
+         *      position
+         */
+        explicit BatchRenderer(AbstractFont& font, const GlyphCache& cache, Float size, Alignment alignment = Alignment::LineLeft);
+        BatchRenderer(AbstractFont&, GlyphCache&&, Float, Alignment alignment = Alignment::LineLeft) = delete; /**< @overload */
+};
+
+/**
+@brief Two-dimensional batch text renderer
+@m_since_latest
+*/
+typedef BatchRenderer<2> BatchRenderer2D;
+
+/**
+@brief Three-dimensional batch text renderer
+@m_since_latest
+*/
+typedef BatchRenderer<3> BatchRenderer3D;
+
+#ifndef MAGNUM_TARGET_GLES2
+/**
+@brief Instanced text renderer
+@m_since_latest
+
+Compared to @ref Renderer, which generates four vertices and six indices for
+every glyph on the CPU, this renderer produces just a single 32-byte instance
+per glyph, containing an offset, scale, a glyph ID and a color. The glyph
+quad is then expanded in the vertex shader of @ref Shaders::VectorGL or
+@ref Shaders::DistanceFieldVectorGL created with
+@relativeref{Shaders::VectorGL,Flag::InstancedGlyphs}, taking glyph
+rectangles from @ref glyphRectangleTexture(). This makes the vertex data and
+the CPU work done per glyph about four times smaller:
+
+@snippet MagnumText.cpp InstancedRenderer-usage
+
+The mesh doesn't have any dimension-specific attributes, so the same renderer
+can be used with both the 2D and 3D variants of the shaders. The glyph
+rectangle texture is filled with all glyphs from the cache on construction
+and then again in @ref render() every time the cache
+@ref AbstractGlyphCache::generation() "generation" changes.
+
+The glyphs are identified by their texture coordinates, which means the font
+is expected to produce glyph quads from the cache the same way as for example
+@ref MagnumFont does --- with the quad being the cache rectangle placed at the
+glyph position and scaled by the ratio of the rendered size and
+@ref AbstractFont::size().
+@requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+@requires_gl33 Extension @gl_extension{ARB,instanced_arrays}
+@requires_gles30 Not available in OpenGL ES 2.0.
+@requires_webgl20 Not available in WebGL 1.0.
+*/
+class MAGNUM_TEXT_EXPORT InstancedRenderer {
+    public:
+        /**
+         * @brief Constructor
+         * @param font          Font
+         * @param cache         Glyph cache
+         * @param size          Font size
+         * @param alignment     Text alignment
+         */
+        explicit InstancedRenderer(AbstractFont& font, const GlyphCache& cache, Float size, Alignment alignment = Alignment::LineLeft);
+        InstancedRenderer(AbstractFont&, GlyphCache&&, Float, Alignment alignment = Alignment::LineLeft) = delete; /**< @overload */
+
+        /** @brief Copying is not allowed */
+        InstancedRenderer(const InstancedRenderer&) = delete;
+
+        /** @brief Copying is not allowed */
+        InstancedRenderer& operator=(const InstancedRenderer&) = delete;
+
+        ~InstancedRenderer();
+
+        /**
+         * @brief Capacity for rendered glyphs
+         *
+         * Initially zero.
+         * @see @ref reserve()
+         */
+        UnsignedInt capacity() const;
+
+        /** @brief Count of glyphs rendered by the last @ref render() call */
+        UnsignedInt glyphCount() const;
+
+        /** @brief Rectangle spanning the rendered text */
+        Range2D rectangle() const;
+
+        /**
+         * @brief Glyph rectangle texture
+         *
+         * Pass to @relativeref{Shaders::VectorGL,bindGlyphRectangleTexture()}
+         * or @relativeref{Shaders::DistanceFieldVectorGL,bindGlyphRectangleTexture()}.
+         * Contains one row for each glyph in the cache, see
+         * @ref Shaders-VectorGL-instanced-glyphs for details about the
+         * layout.
+         */
+        GL::Texture2D& glyphRectangleTexture();
+
+        /** @brief Instance buffer */
+        GL::Buffer& instanceBuffer();
+
+        /**
+         * @brief Mesh
+         *
+         * A four-vertex @ref MeshPrimitive::TriangleStrip, the instance count
+         * is updated in @ref render().
+         */
+        GL::Mesh& mesh();
+
+        /**
+         * @brief Reserve capacity for rendered glyphs
+         *
+         * Reallocates the instance buffer to hold @p glyphCount glyphs and
+         * resets the instance count to zero.
+         * @see @ref capacity()
+         */
+        void reserve(UnsignedInt glyphCount, GL::BufferUsage usage);
+
+        /**
+         * @brief Render text
+         * @param text      Text to render
+         * @param color     Color of all glyphs
+         *
+         * Lays out the text, uploads the instances and updates the mesh
+         * instance count. Expects that the text fits into @ref capacity()
+         * and that all glyphs the font produces are present in the cache.
+         */
+        void render(const std::string& text, const Color4& color = Color4{1.0f});
+
+    private:
+        MAGNUM_TEXT_LOCAL void updateGlyphRectangles();
+
+        struct State;
+        Containers::Pointer<State> _state;
+};
+#endif
+
 }}
 #else
 #error this header is available only in the OpenGL build
@@ -26,8 +26,11 @@
 #include <sstream>
 #include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Containers/StringStl.h> /** @todo remove once AbstractFont is <string>-free */
+#include <Corrade/Containers/StringView.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/TestSuite/Compare/String.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Path.h>
@@ -83,6 +86,10 @@ struct AbstractFontTest: TestSuite::Tester {
 
     void layout();
     void layoutNoFont();
+    void layoutInto();
+    void layoutIntoCustom();
+    void layoutIntoNoFont();
+    void layoutIntoInvalidViews();
 
     void fillGlyphCache();
     void fillGlyphCacheNotSupported();
@@ -138,6 +145,10 @@ AbstractFontTest::AbstractFontTest() {
 
               &AbstractFontTest::layout,
               &AbstractFontTest::layoutNoFont,
+              &AbstractFontTest::layoutInto,
+              &AbstractFontTest::layoutIntoCustom,
+              &AbstractFontTest::layoutIntoNoFont,
+              &AbstractFontTest::layoutIntoInvalidViews,
 
               &AbstractFontTest::fillGlyphCache,
               &AbstractFontTest::fillGlyphCacheNotSupported,
@@ -977,6 +988,125 @@ void AbstractFontTest::layoutNoFont() {
     CORRADE_COMPARE(out.str(), "Text::AbstractFont::layout(): no font opened\n");
 }
 
+void AbstractFontTest::layoutInto() {
+    struct MyFont: AbstractFont {
+        FontFeatures doFeatures() const override { return FontFeature::OpenData; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+        Metrics doOpenData(Containers::ArrayView<const char>, Float) override {
+            return {2.0f, 0.0f, 0.0f, 0.0f};
+        }
+
+        UnsignedInt doGlyphId(char32_t a) override { return a; }
+        Vector2 doGlyphAdvance(UnsignedInt a) override { return {Float(a), 1.0f}; }
+        Containers::Pointer<AbstractLayouter> doLayout(const AbstractGlyphCache&, Float, const std::string&) override { return nullptr; }
+    } font;
+
+    /* Open to set the font size, the advances get scaled by 0.5 */
+    CORRADE_VERIFY(font.openData(nullptr, 2.0f));
+
+    UnsignedInt ids[6];
+    Vector2 offsets[6]{{7.0f, 7.0f}, {7.0f, 7.0f}, {7.0f, 7.0f}, {7.0f, 7.0f}, {7.0f, 7.0f}, {7.0f, 7.0f}};
+    Vector2 advances[6];
+
+    /* The default implementation decodes UTF-8, so the two-byte character
+       results in just one glyph */
+    CORRADE_COMPARE(font.layoutInto(1.0f, "a\xc5\xa1" "b", ids, offsets, advances), 3);
+    CORRADE_COMPARE_AS(Containers::arrayView(ids).prefix(3),
+        Containers::arrayView<UnsignedInt>({U'a', U'\u0161', U'b'}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(offsets).prefix(3),
+        Containers::arrayView<Vector2>({{}, {}, {}}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(advances).prefix(3),
+        Containers::arrayView<Vector2>({
+            {97.0f*0.5f, 0.5f},
+            {353.0f*0.5f, 0.5f},
+            {98.0f*0.5f, 0.5f}
+        }), TestSuite::Compare::Container);
+
+    /* The rest isn't touched */
+    CORRADE_COMPARE(offsets[3], (Vector2{7.0f, 7.0f}));
+}
+
+void AbstractFontTest::layoutIntoCustom() {
+    struct MyFont: AbstractFont {
+        FontFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        UnsignedInt doGlyphId(char32_t) override { return {}; }
+        Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+        Containers::Pointer<AbstractLayouter> doLayout(const AbstractGlyphCache&, Float, const std::string&) override { return nullptr; }
+        UnsignedInt doLayoutInto(Float size, Containers::StringView text, const Containers::StridedArrayView1D<UnsignedInt>& glyphIds, const Containers::StridedArrayView1D<Vector2>& glyphOffsets, const Containers::StridedArrayView1D<Vector2>& glyphAdvances) override {
+            CORRADE_COMPARE(glyphIds.size(), 5);
+            glyphIds[0] = text.size();
+            glyphOffsets[0] = {size, 0.0f};
+            glyphAdvances[0] = {0.0f, size};
+            return 1;
+        }
+    } font;
+
+    UnsignedInt ids[5];
+    Vector2 offsets[5];
+    Vector2 advances[5];
+    CORRADE_COMPARE(font.layoutInto(0.25f, "hello", ids, offsets, advances), 1);
+    CORRADE_COMPARE(ids[0], 5);
+    CORRADE_COMPARE(offsets[0], (Vector2{0.25f, 0.0f}));
+    CORRADE_COMPARE(advances[0], (Vector2{0.0f, 0.25f}));
+}
+
+void AbstractFontTest::layoutIntoNoFont() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    struct MyFont: AbstractFont {
+        FontFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return false; }
+        void doClose() override {}
+
+        UnsignedInt doGlyphId(char32_t) override { return {}; }
+        Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+        Containers::Pointer<AbstractLayouter> doLayout(const AbstractGlyphCache&, Float, const std::string&) override { return nullptr; }
+    } font;
+
+    UnsignedInt ids[5];
+    Vector2 offsets[5];
+    Vector2 advances[5];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    font.layoutInto(0.25f, "hello", ids, offsets, advances);
+    CORRADE_COMPARE(out.str(), "Text::AbstractFont::layoutInto(): no font opened\n");
+}
+
+void AbstractFontTest::layoutIntoInvalidViews() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    struct MyFont: AbstractFont {
+        FontFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        UnsignedInt doGlyphId(char32_t) override { return {}; }
+        Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+        Containers::Pointer<AbstractLayouter> doLayout(const AbstractGlyphCache&, Float, const std::string&) override { return nullptr; }
+    } font;
+
+    UnsignedInt ids[5];
+    Vector2 offsets[5];
+    Vector2 advances[5];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    font.layoutInto(0.25f, "hello", ids, Containers::arrayView(offsets).prefix(4), advances);
+    font.layoutInto(0.25f, "hello", ids, offsets, Containers::arrayView(advances).prefix(4));
+    font.layoutInto(0.25f, "hello!", ids, offsets, advances);
+    CORRADE_COMPARE(out.str(),
+        "Text::AbstractFont::layoutInto(): expected glyph ID, offset and advance views to have the same size, got 5, 4 and 5\n"
+        "Text::AbstractFont::layoutInto(): expected glyph ID, offset and advance views to have the same size, got 5, 5 and 4\n"
+        "Text::AbstractFont::layoutInto(): expected the views to have at least 6 elements but got 5\n");
+}
+
 void AbstractFontTest::fillGlyphCache() {
     struct MyFont: AbstractFont {
         FontFeatures doFeatures() const override { return {}; }
@@ -41,6 +41,9 @@ struct AbstractGlyphCacheTest: TestSuite::Tester {
     void initialize();
     void access();
     void reserve();
+    void reserveCustom();
+    void erase();
+    void eraseZero();
 
     void setImage();
     void setImageOutOfBounds();
@@ -54,6 +57,9 @@ AbstractGlyphCacheTest::AbstractGlyphCacheTest() {
     addTests({&AbstractGlyphCacheTest::initialize,
               &AbstractGlyphCacheTest::access,
               &AbstractGlyphCacheTest::reserve,
+              &AbstractGlyphCacheTest::reserveCustom,
+              &AbstractGlyphCacheTest::erase,
+              &AbstractGlyphCacheTest::eraseZero,
 
               &AbstractGlyphCacheTest::setImage,
               &AbstractGlyphCacheTest::setImageOutOfBounds,
@@ -83,6 +89,7 @@ void AbstractGlyphCacheTest::access() {
 
     /* Default "Not Found" glyph */
     CORRADE_COMPARE(cache.glyphCount(), 1);
+    CORRADE_COMPARE(cache.generation(), 0);
     std::tie(position, rectangle) = cache[0];
     CORRADE_COMPARE(position, Vector2i(0, 0));
     CORRADE_COMPARE(rectangle, Range2Di({0, 0}, {0, 0}));
@@ -90,6 +97,7 @@ void AbstractGlyphCacheTest::access() {
     /* Overwrite the "Not Found" glyph */
     cache.insert(0, {3, 5}, {{10, 10}, {23, 45}});
     CORRADE_COMPARE(cache.glyphCount(), 1);
+    CORRADE_COMPARE(cache.generation(), 1);
     std::tie(position, rectangle) = cache[0];
     CORRADE_COMPARE(position, Vector2i(3, 5));
     CORRADE_COMPARE(rectangle, Range2Di({10, 10}, {23, 45}));
@@ -97,6 +105,7 @@ void AbstractGlyphCacheTest::access() {
     /* Querying available glyph */
     cache.insert(25, {3, 4}, {{15, 30}, {45, 35}});
     CORRADE_COMPARE(cache.glyphCount(), 2);
+    CORRADE_COMPARE(cache.generation(), 2);
     std::tie(position, rectangle) = cache[25];
     CORRADE_COMPARE(position, Vector2i(3, 4));
     CORRADE_COMPARE(rectangle, Range2Di({15, 30}, {45, 35}));
@@ -114,6 +123,60 @@ void AbstractGlyphCacheTest::reserve() {
     CORRADE_VERIFY(!cache.reserve({{5, 3}}).empty());
 }
 
+void AbstractGlyphCacheTest::reserveCustom() {
+    struct MyGlyphCache: AbstractGlyphCache {
+        using AbstractGlyphCache::AbstractGlyphCache;
+
+        GlyphCacheFeatures doFeatures() const override { return {}; }
+        void doSetImage(const Vector2i&, const ImageView2D&) override {}
+        std::vector<Range2Di> doReserve(const std::vector<Vector2i>& sizes) override {
+            return {Range2Di::fromSize({}, sizes[0]*2)};
+        }
+    } cache{Vector2i{236}};
+
+    /* Works also for a non-empty cache, unlike the default implementation */
+    cache.insert(3, {}, {{}, {5, 3}});
+    CORRADE_COMPARE(cache.reserve({{5, 3}}), (std::vector<Range2Di>{{{}, {10, 6}}}));
+}
+
+struct ErasingGlyphCache: DummyGlyphCache {
+    using DummyGlyphCache::DummyGlyphCache;
+    using DummyGlyphCache::erase;
+};
+
+void AbstractGlyphCacheTest::erase() {
+    ErasingGlyphCache cache{Vector2i{236}};
+    cache.insert(3, {}, {{10, 10}, {23, 45}});
+    CORRADE_COMPARE(cache.glyphCount(), 2);
+
+    CORRADE_COMPARE(cache.generation(), 1);
+
+    CORRADE_VERIFY(cache.erase(3));
+    CORRADE_COMPARE(cache.glyphCount(), 1);
+    CORRADE_COMPARE(cache.generation(), 2);
+    CORRADE_COMPARE(cache[3], cache[0]);
+
+    /* Erasing a glyph that isn't there does nothing */
+    CORRADE_VERIFY(!cache.erase(3));
+    CORRADE_COMPARE(cache.glyphCount(), 1);
+    CORRADE_COMPARE(cache.generation(), 2);
+
+    /* The glyph can be inserted again after */
+    cache.insert(3, {}, {{10, 10}, {23, 45}});
+    CORRADE_COMPARE(cache.glyphCount(), 2);
+}
+
+void AbstractGlyphCacheTest::eraseZero() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    ErasingGlyphCache cache{Vector2i{236}};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    cache.erase(0);
+    CORRADE_COMPARE(out.str(), "Text::AbstractGlyphCache::erase(): can't erase glyph 0\n");
+}
+
 void AbstractGlyphCacheTest::setImage() {
     struct MyGlyphCache: AbstractGlyphCache {
         using AbstractGlyphCache::AbstractGlyphCache;
@@ -0,0 +1,207 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/Text/AbstractFont.h"
+#include "Magnum/Text/DynamicGlyphCache.h"
+
+namespace Magnum { namespace Text { namespace Test { namespace {
+
+struct DynamicGlyphCacheGLTest: GL::OpenGLTester {
+    explicit DynamicGlyphCacheGLTest();
+
+    void fill();
+    void fillEvict();
+    void fillTooSmall();
+    void reserveOutsideFill();
+};
+
+DynamicGlyphCacheGLTest::DynamicGlyphCacheGLTest() {
+    addTests({&DynamicGlyphCacheGLTest::fill,
+              &DynamicGlyphCacheGLTest::fillEvict,
+              &DynamicGlyphCacheGLTest::fillTooSmall,
+              &DynamicGlyphCacheGLTest::reserveOutsideFill});
+}
+
+/* Every glyph is 4x4 pixels, filled with its ID. Glyph IDs are the character
+   codes, except for '_', which maps to glyph 0. */
+struct TestFont: AbstractFont {
+    FontFeatures doFeatures() const override { return {}; }
+    bool doIsOpened() const override { return true; }
+    void doClose() override {}
+
+    UnsignedInt doGlyphId(char32_t character) override {
+        return character == U'_' ? 0 : character;
+    }
+    Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+    Containers::Pointer<AbstractLayouter> doLayout(const AbstractGlyphCache&, Float, const std::string&) override { return nullptr; }
+
+    void doFillGlyphCache(AbstractGlyphCache& cache, const std::u32string& characters) override {
+        ++fillCount;
+        for(const char32_t character: characters)
+            filledCharacters += char(character);
+
+        const std::vector<Range2Di> rectangles = cache.reserve(std::vector<Vector2i>(characters.size(), Vector2i{4}));
+        if(rectangles.size() != characters.size()) return;
+
+        /* Upload the whole texture at once, like e.g. FreeTypeFont does */
+        Containers::Array<char> data{ValueInit, std::size_t(cache.textureSize().product())};
+        for(std::size_t i = 0; i != characters.size(); ++i) {
+            cache.insert(characters[i], {}, rectangles[i]);
+            for(Int y = rectangles[i].min().y(); y != rectangles[i].max().y(); ++y)
+                for(Int x = rectangles[i].min().x(); x != rectangles[i].max().x(); ++x)
+                    data[y*cache.textureSize().x() + x] = char(characters[i]);
+        }
+        cache.setImage({}, ImageView2D{PixelFormat::R8Unorm, cache.textureSize(), data});
+    }
+
+    Int fillCount = 0;
+    std::string filledCharacters;
+};
+
+void DynamicGlyphCacheGLTest::fill() {
+    TestFont font;
+    DynamicGlyphCache cache{{16, 8}};
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Duplicate characters and characters mapping to glyph 0 are not
+       requested from the font */
+    CORRADE_VERIFY(cache.fill(font, "ab_a"));
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(font.fillCount, 1);
+    CORRADE_COMPARE(font.filledCharacters, "ab");
+    CORRADE_COMPARE(cache.glyphCount(), 3);
+    CORRADE_COMPARE(cache[U'a'], std::make_pair(Vector2i{}, Range2Di{{0, 0}, {4, 4}}));
+    CORRADE_COMPARE(cache[U'b'], std::make_pair(Vector2i{}, Range2Di{{4, 0}, {8, 4}}));
+
+    /* Glyphs already present are not requested again */
+    CORRADE_VERIFY(cache.fill(font, "bac"));
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(font.fillCount, 2);
+    CORRADE_COMPARE(font.filledCharacters, "abc");
+    CORRADE_COMPARE(cache[U'c'], std::make_pair(Vector2i{}, Range2Di{{8, 0}, {12, 4}}));
+
+    CORRADE_VERIFY(cache.fill(font, "cab"));
+    CORRADE_COMPARE(font.fillCount, 2);
+    CORRADE_COMPARE(cache.evictedGlyphCount(), 0);
+
+    /** @todo How to verify this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    /* The second fill uploaded the whole texture with only 'c' in it, the
+       glyphs from the first fill should be still there */
+    Image2D image = cache.image();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(image.pixels<UnsignedByte>()[2][1], 'a');
+    CORRADE_COMPARE(image.pixels<UnsignedByte>()[2][5], 'b');
+    CORRADE_COMPARE(image.pixels<UnsignedByte>()[2][9], 'c');
+    CORRADE_COMPARE(image.pixels<UnsignedByte>()[2][13], 0);
+    CORRADE_COMPARE(image.pixels<UnsignedByte>()[6][1], 0);
+    #endif
+}
+
+void DynamicGlyphCacheGLTest::fillEvict() {
+    TestFont font;
+    /* Space for eight glyphs */
+    DynamicGlyphCache cache{{16, 8}};
+    CORRADE_VERIFY(cache.fill(font, "abcdefgh"));
+    CORRADE_COMPARE(cache.glyphCount(), 9);
+
+    /* Using some glyphs in the next frame makes the others evictable, the
+       least recently used ones first */
+    cache.nextFrame();
+    CORRADE_VERIFY(cache.fill(font, "hgab"));
+    CORRADE_VERIFY(cache.fill(font, "ij"));
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(cache.evictedGlyphCount(), 2);
+    CORRADE_COMPARE(cache.glyphCount(), 9);
+
+    /* 'c' and 'd' got evicted, 'i' and 'j' reuse their slots */
+    CORRADE_COMPARE(cache[U'c'], cache[0]);
+    CORRADE_COMPARE(cache[U'd'], cache[0]);
+    CORRADE_COMPARE(cache[U'i'].second, Range2Di({8, 0}, {12, 4}));
+    CORRADE_COMPARE(cache[U'j'].second, Range2Di({12, 0}, {16, 4}));
+
+    /* Filling an evicted glyph again evicts another one */
+    CORRADE_VERIFY(cache.fill(font, "c"));
+    CORRADE_COMPARE(cache.evictedGlyphCount(), 3);
+    CORRADE_COMPARE(cache[U'e'], cache[0]);
+    CORRADE_COMPARE(font.filledCharacters, "abcdefghijc");
+
+    /** @todo How to verify this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    Image2D image = cache.image();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(image.pixels<UnsignedByte>()[1][9], 'i');
+    CORRADE_COMPARE(image.pixels<UnsignedByte>()[1][13], 'j');
+    CORRADE_COMPARE(image.pixels<UnsignedByte>()[5][1], 'c');
+    #endif
+}
+
+void DynamicGlyphCacheGLTest::fillTooSmall() {
+    TestFont font;
+    DynamicGlyphCache cache{{16, 8}};
+    CORRADE_VERIFY(cache.fill(font, "abcdefg"));
+
+    /* All glyphs are used in current frame, so nothing can be evicted */
+    std::ostringstream out;
+    {
+        Error redirectError{&out};
+        CORRADE_VERIFY(!cache.fill(font, "hij"));
+    }
+    CORRADE_COMPARE(out.str(), "Text::DynamicGlyphCache::fill(): cache too small to fit 3 new glyphs\n");
+    CORRADE_COMPARE(cache.glyphCount(), 8);
+    CORRADE_COMPARE(cache[U'h'], cache[0]);
+    CORRADE_COMPARE(cache.evictedGlyphCount(), 0);
+
+    /* The slot reserved for the failed fill is available again */
+    CORRADE_VERIFY(cache.fill(font, "h"));
+    CORRADE_COMPARE(cache[U'h'].second, Range2Di({12, 4}, {16, 8}));
+    CORRADE_COMPARE(cache.glyphCount(), 9);
+}
+
+void DynamicGlyphCacheGLTest::reserveOutsideFill() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    TestFont font;
+    DynamicGlyphCache cache{{16, 8}};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    font.fillGlyphCache(cache, "a");
+    CORRADE_COMPARE(out.str(), "Text::DynamicGlyphCache::reserve(): the cache can be filled only through fill()\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Text::Test::DynamicGlyphCacheGLTest)
@@ -0,0 +1,170 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Text/MultiChannelDistanceFieldGlyphCache.h"
+
+namespace Magnum { namespace Text { namespace Test { namespace {
+
+struct MultiChannelDistanceFieldGlyphCacheGLTest: GL::OpenGLTester {
+    explicit MultiChannelDistanceFieldGlyphCacheGLTest();
+
+    void initialize();
+    void initializeSizeTooLarge();
+
+    void setImage();
+    void setImageInvalidFormat();
+    void setDistanceFieldImage();
+    void setDistanceFieldImageInvalidFormat();
+};
+
+MultiChannelDistanceFieldGlyphCacheGLTest::MultiChannelDistanceFieldGlyphCacheGLTest() {
+    addTests({&MultiChannelDistanceFieldGlyphCacheGLTest::initialize,
+              &MultiChannelDistanceFieldGlyphCacheGLTest::initializeSizeTooLarge,
+
+              &MultiChannelDistanceFieldGlyphCacheGLTest::setImage,
+              &MultiChannelDistanceFieldGlyphCacheGLTest::setImageInvalidFormat,
+              &MultiChannelDistanceFieldGlyphCacheGLTest::setDistanceFieldImage,
+              &MultiChannelDistanceFieldGlyphCacheGLTest::setDistanceFieldImageInvalidFormat});
+}
+
+void MultiChannelDistanceFieldGlyphCacheGLTest::initialize() {
+    MultiChannelDistanceFieldGlyphCache cache{{1024, 2048}, {256, 512}, 16};
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_COMPARE(cache.textureSize(), (Vector2i{1024, 2048}));
+    CORRADE_COMPARE(cache.padding(), Vector2i{16});
+    CORRADE_COMPARE(cache.radius(), 16);
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_COMPARE(cache.texture().imageSize(0), (Vector2i{256, 512}));
+    #endif
+}
+
+void MultiChannelDistanceFieldGlyphCacheGLTest::initializeSizeTooLarge() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MultiChannelDistanceFieldGlyphCache{{256, 128}, {128, 256}, 4};
+    CORRADE_COMPARE(out.str(), "Text::MultiChannelDistanceFieldGlyphCache: expected size to not be larger than {256, 128} but got {128, 256}\n");
+}
+
+void MultiChannelDistanceFieldGlyphCacheGLTest::setImage() {
+    MultiChannelDistanceFieldGlyphCache cache{{64, 64}, {16, 16}, 4};
+
+    /* A filled square in the middle of the input */
+    UnsignedByte data[64*64]{};
+    for(std::size_t y = 16; y != 48; ++y)
+        for(std::size_t x = 16; x != 48; ++x)
+            data[y*64 + x] = 255;
+    cache.setImage({}, ImageView2D{PixelFormat::R8Unorm, {64, 64}, data});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    #ifndef MAGNUM_TARGET_GLES
+    Image2D image = cache.image();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(image.size(), (Vector2i{16, 16}));
+    CORRADE_COMPARE(image.format(), PixelFormat::RGB8Unorm);
+
+    /* All channels are the same, inside is above and outside below 0.5 */
+    const Containers::StridedArrayView2D<const Color3ub> pixels = image.pixels<Color3ub>();
+    for(std::size_t y = 0; y != pixels.size()[0]; ++y) {
+        for(std::size_t x = 0; x != pixels.size()[1]; ++x) {
+            CORRADE_ITERATION(Vector2i(x, y));
+            CORRADE_COMPARE(pixels[y][x].g(), pixels[y][x].r());
+            CORRADE_COMPARE(pixels[y][x].b(), pixels[y][x].r());
+        }
+    }
+    CORRADE_COMPARE_AS(pixels[8][8].r(), 128, TestSuite::Compare::Greater);
+    CORRADE_COMPARE_AS(pixels[0][0].r(), 128, TestSuite::Compare::Less);
+    #else
+    CORRADE_SKIP("Skipping image download test as it's not available on ES.");
+    #endif
+}
+
+void MultiChannelDistanceFieldGlyphCacheGLTest::setImageInvalidFormat() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    MultiChannelDistanceFieldGlyphCache cache{{64, 64}, {16, 16}, 4};
+
+    const char data[16*4]{};
+    std::ostringstream out;
+    Error redirectError{&out};
+    cache.setImage({}, ImageView2D{PixelFormat::RGBA8Unorm, {4, 4}, data});
+    CORRADE_COMPARE(out.str(), "Text::MultiChannelDistanceFieldGlyphCache::setImage(): expected PixelFormat::R8Unorm but got PixelFormat::RGBA8Unorm\n");
+}
+
+void MultiChannelDistanceFieldGlyphCacheGLTest::setDistanceFieldImage() {
+    MultiChannelDistanceFieldGlyphCache cache{{64, 64}, {16, 16}, 4};
+
+    Color3ub data[4*4];
+    for(std::size_t i = 0; i != 16; ++i)
+        data[i] = {UnsignedByte(i*16), UnsignedByte(255 - i*16), UnsignedByte(i)};
+    cache.setDistanceFieldImage({8, 4}, ImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::RGB8Unorm, {4, 4}, data});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    #ifndef MAGNUM_TARGET_GLES
+    Image2D image = cache.image();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(image.size(), (Vector2i{16, 16}));
+
+    /* The data are uploaded as-is, without any scaling */
+    const Containers::StridedArrayView2D<const Color3ub> pixels = image.pixels<Color3ub>();
+    for(std::size_t y = 0; y != 4; ++y) {
+        for(std::size_t x = 0; x != 4; ++x) {
+            CORRADE_ITERATION(Vector2i(x, y));
+            CORRADE_COMPARE(pixels[4 + y][8 + x], data[y*4 + x]);
+        }
+    }
+    #else
+    CORRADE_SKIP("Skipping image download test as it's not available on ES.");
+    #endif
+}
+
+void MultiChannelDistanceFieldGlyphCacheGLTest::setDistanceFieldImageInvalidFormat() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    MultiChannelDistanceFieldGlyphCache cache{{64, 64}, {16, 16}, 4};
+
+    const char data[16]{};
+    std::ostringstream out;
+    Error redirectError{&out};
+    cache.setDistanceFieldImage({}, ImageView2D{PixelFormat::R8Unorm, {4, 4}, data});
+    CORRADE_COMPARE(out.str(), "Text::MultiChannelDistanceFieldGlyphCache::setDistanceFieldImage(): expected PixelFormat::RGB8Unorm but got PixelFormat::R8Unorm\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Text::Test::MultiChannelDistanceFieldGlyphCacheGLTest)
@@ -23,15 +23,29 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <sstream>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
 
 #include "Magnum/GL/Context.h"
 #include "Magnum/GL/Extensions.h"
 #include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/Math/Color.h"
 #include "Magnum/Text/AbstractFont.h"
+#include "Magnum/Text/GlyphCache.h"
+#include "Magnum/Text/LayoutCache.h"
 #include "Magnum/Text/Renderer.h"
 
+#ifndef MAGNUM_TARGET_GLES
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/GL/Texture.h"
+#endif
+
 namespace Magnum { namespace Text { namespace Test { namespace {
 
 struct RendererGLTest: GL::OpenGLTester {
@@ -41,8 +55,30 @@ struct RendererGLTest: GL::OpenGLTester {
     void renderMesh();
     void renderMeshIndexType();
     void mutableText();
+    #ifndef MAGNUM_TARGET_GLES
+    void mutableTextStreaming();
+    void mutableTextStreamingSwitchBack();
+    void mutableTextStreamingInvalid();
+    #endif
 
     void multiline();
+
+    void batch();
+    void batchUpdate();
+    void batchClear();
+    void batchInvalid();
+
+    void layoutCache();
+    void layoutCacheBatch();
+    void layoutCacheParameters();
+    void layoutCacheGlyphCacheChange();
+    void layoutCacheCapacity();
+
+    #ifndef MAGNUM_TARGET_GLES2
+    void instanced();
+    void instancedCacheUpdate();
+    void instancedInvalid();
+    #endif
 };
 
 RendererGLTest::RendererGLTest() {
@@ -50,8 +86,31 @@ RendererGLTest::RendererGLTest() {
               &RendererGLTest::renderMesh,
               &RendererGLTest::renderMeshIndexType,
               &RendererGLTest::mutableText,
-
-              &RendererGLTest::multiline});
+              #ifndef MAGNUM_TARGET_GLES
+              &RendererGLTest::mutableTextStreaming,
+              &RendererGLTest::mutableTextStreamingSwitchBack,
+              &RendererGLTest::mutableTextStreamingInvalid,
+              #endif
+
+              &RendererGLTest::multiline,
+
+              &RendererGLTest::batch,
+              &RendererGLTest::batchUpdate,
+              &RendererGLTest::batchClear,
+              &RendererGLTest::batchInvalid,
+
+              &RendererGLTest::layoutCache,
+              &RendererGLTest::layoutCacheBatch,
+              &RendererGLTest::layoutCacheParameters,
+              &RendererGLTest::layoutCacheGlyphCacheChange,
+              &RendererGLTest::layoutCacheCapacity,
+
+              #ifndef MAGNUM_TARGET_GLES2
+              &RendererGLTest::instanced,
+              &RendererGLTest::instancedCacheUpdate,
+              &RendererGLTest::instancedInvalid
+              #endif
+              });
 }
 
 class TestLayouter: public Text::AbstractLayouter {
@@ -80,9 +139,59 @@ class TestFont: public Text::AbstractFont {
     Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
 
     Containers::Pointer<AbstractLayouter> doLayout(const AbstractGlyphCache&, const Float size, const std::string& text) override {
+        ++layoutCount;
         return Containers::Pointer<AbstractLayouter>(new TestLayouter(size, text.size()));
     }
+
+    public:
+        Int layoutCount = 0;
+};
+
+#ifndef MAGNUM_TARGET_GLES2
+/* Takes glyphs from the cache the same way as MagnumFont does, glyph ID is
+   the character position in the alphabet starting from 1 */
+class CacheLayouter: public Text::AbstractLayouter {
+    public:
+        explicit CacheLayouter(const AbstractGlyphCache& cache, Float scale, const std::string& text): AbstractLayouter(text.size()), _cache(cache), _scale(scale), _text(text) {}
+
+    private:
+        std::tuple<Range2D, Range2D, Vector2> doRenderGlyph(UnsignedInt i) override {
+            Vector2i position;
+            Range2Di rectangle;
+            std::tie(position, rectangle) = _cache[_text[i] - 'a' + 1];
+            return std::make_tuple(
+                Range2D(Range2Di::fromSize(position, rectangle.size())).scaled(Vector2{_scale}),
+                Range2D(rectangle).scaled(1.0f/Vector2(_cache.textureSize())),
+                Vector2::xAxis(8.0f*_scale)
+            );
+        }
+
+        const AbstractGlyphCache& _cache;
+        Float _scale;
+        std::string _text;
+};
+
+class CacheFont: public Text::AbstractFont {
+    FontFeatures doFeatures() const override { return FontFeature::OpenData; }
+
+    bool doIsOpened() const override { return _opened; }
+    void doClose() override { _opened = false; }
+
+    Metrics doOpenData(Containers::ArrayView<const char>, Float size) override {
+        _opened = true;
+        return {size, 8.0f, -2.0f, 12.0f};
+    }
+
+    UnsignedInt doGlyphId(char32_t) override { return 0; }
+    Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+
+    Containers::Pointer<AbstractLayouter> doLayout(const AbstractGlyphCache& cache, const Float size, const std::string& text) override {
+        return Containers::Pointer<AbstractLayouter>(new CacheLayouter(cache, size/this->size(), text));
+    }
+
+    bool _opened = false;
 };
+#endif
 
 /* *static_cast<GlyphCache*>(nullptr) makes Clang Analyzer grumpy */
 char glyphCacheData;
@@ -324,6 +433,154 @@ void RendererGLTest::mutableText() {
     #endif
 }
 
+#ifndef MAGNUM_TARGET_GLES
+void RendererGLTest::mutableTextStreaming() {
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::map_buffer_range>())
+        CORRADE_SKIP(GL::Extensions::ARB::map_buffer_range::string() << "is not supported.");
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::buffer_storage>())
+        CORRADE_SKIP(GL::Extensions::ARB::buffer_storage::string() << "is not supported.");
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::draw_elements_base_vertex>())
+        CORRADE_SKIP(GL::Extensions::ARB::draw_elements_base_vertex::string() << "is not supported.");
+
+    TestFont font;
+    Text::Renderer2D renderer(font, nullGlyphCache, 0.25f);
+
+    /* Two copies of four glyphs, 16 bytes per vertex */
+    renderer.reserveStreaming(4, 2);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(renderer.capacity(), 4);
+    CORRADE_COMPARE(renderer.vertexBuffer().size(), 2*4*4*16);
+    CORRADE_COMPARE(renderer.mesh().count(), 0);
+
+    /* The index buffer is filled for the whole capacity */
+    Containers::Array<char> indices = renderer.indexBuffer().data();
+    CORRADE_COMPARE_AS(Containers::arrayCast<const UnsignedByte>(indices).prefix(24),
+        Containers::arrayView<UnsignedByte>({
+             0,  1,  2,  1,  3,  2,
+             4,  5,  6,  5,  7,  6,
+             8,  9, 10,  9, 11, 10,
+            12, 13, 14, 13, 15, 14
+        }), TestSuite::Compare::Container);
+
+    /* Each render goes to the next copy */
+    renderer.render("abc");
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(renderer.mesh().baseVertex(), 0);
+    CORRADE_COMPARE(renderer.mesh().count(), 3*6);
+    CORRADE_COMPARE(renderer.rectangle(), Range2D({0.0f, -0.5f}, {5.0f, 1.0f}));
+
+    renderer.render("ab");
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(renderer.mesh().baseVertex(), 16);
+    CORRADE_COMPARE(renderer.mesh().count(), 2*6);
+    CORRADE_COMPARE(renderer.rectangle(), Range2D({0.0f, -0.25f}, {2.5f, 0.75f}));
+
+    /* Wraps around to the first copy again, writing just the glyphs that
+       changed */
+    renderer.render("abcd");
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(renderer.mesh().baseVertex(), 0);
+    CORRADE_COMPARE(renderer.mesh().count(), 4*6);
+
+    Containers::Array<char> vertices = renderer.vertexBuffer().data();
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Float>(vertices).prefix(64),
+        Containers::arrayView<Float>({
+            0.0f,  0.5f, 0.0f, 10.0f,
+            0.0f,  0.0f, 0.0f,  0.0f,
+            0.75f, 0.5f, 6.0f, 10.0f,
+            0.75f, 0.0f, 6.0f,  0.0f,
+
+            1.0f,  0.75f,  6.0f, 10.0f,
+            1.0f, -0.25f,  6.0f,  0.0f,
+            2.5f,  0.75f, 12.0f, 10.0f,
+            2.5f, -0.25f, 12.0f,  0.0f,
+
+            2.75f,  1.0f, 12.0f, 10.0f,
+            2.75f, -0.5f, 12.0f,  0.0f,
+            5.0f,   1.0f, 18.0f, 10.0f,
+            5.0f,  -0.5f, 18.0f,  0.0f,
+
+            5.25f,  1.25f, 18.0f, 10.0f,
+            5.25f, -0.75f, 18.0f,  0.0f,
+            8.25f,  1.25f, 24.0f, 10.0f,
+            8.25f, -0.75f, 24.0f,  0.0f
+        }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Float>(vertices).slice(64, 96),
+        Containers::arrayView<Float>({
+            0.0f,  0.5f, 0.0f, 10.0f,
+            0.0f,  0.0f, 0.0f,  0.0f,
+            0.75f, 0.5f, 6.0f, 10.0f,
+            0.75f, 0.0f, 6.0f,  0.0f,
+
+            1.0f,  0.75f,  6.0f, 10.0f,
+            1.0f, -0.25f,  6.0f,  0.0f,
+            2.5f,  0.75f, 12.0f, 10.0f,
+            2.5f, -0.25f, 12.0f,  0.0f
+        }), TestSuite::Compare::Container);
+}
+
+void RendererGLTest::mutableTextStreamingSwitchBack() {
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::map_buffer_range>())
+        CORRADE_SKIP(GL::Extensions::ARB::map_buffer_range::string() << "is not supported.");
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::buffer_storage>())
+        CORRADE_SKIP(GL::Extensions::ARB::buffer_storage::string() << "is not supported.");
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::draw_elements_base_vertex>())
+        CORRADE_SKIP(GL::Extensions::ARB::draw_elements_base_vertex::string() << "is not supported.");
+
+    TestFont font;
+    Text::Renderer3D renderer(font, nullGlyphCache, 0.25f);
+    renderer.reserveStreaming(4, 3);
+    renderer.render("ab");
+    renderer.render("ab");
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(renderer.mesh().baseVertex(), 16);
+
+    /* Reserving again goes back to a regular buffer */
+    renderer.reserve(2, GL::BufferUsage::DynamicDraw, GL::BufferUsage::DynamicDraw);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(renderer.capacity(), 2);
+    CORRADE_COMPARE(renderer.mesh().baseVertex(), 0);
+    CORRADE_COMPARE(renderer.vertexBuffer().size(), 2*4*16);
+
+    renderer.render("ab");
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(renderer.mesh().baseVertex(), 0);
+    CORRADE_COMPARE(renderer.mesh().count(), 2*6);
+
+    Containers::Array<char> vertices = renderer.vertexBuffer().data();
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Float>(vertices),
+        Containers::arrayView<Float>({
+            0.0f,  0.5f, 0.0f, 10.0f,
+            0.0f,  0.0f, 0.0f,  0.0f,
+            0.75f, 0.5f, 6.0f, 10.0f,
+            0.75f, 0.0f, 6.0f,  0.0f,
+
+            1.0f,  0.75f,  6.0f, 10.0f,
+            1.0f, -0.25f,  6.0f,  0.0f,
+            2.5f,  0.75f, 12.0f, 10.0f,
+            2.5f, -0.25f, 12.0f,  0.0f
+        }), TestSuite::Compare::Container);
+}
+
+void RendererGLTest::mutableTextStreamingInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::map_buffer_range>())
+        CORRADE_SKIP(GL::Extensions::ARB::map_buffer_range::string() << "is not supported.");
+
+    TestFont font;
+    Text::Renderer2D renderer(font, nullGlyphCache, 0.25f);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    renderer.reserveStreaming(0, 3);
+    renderer.reserveStreaming(4, 0);
+    CORRADE_COMPARE(out.str(),
+        "Text::Renderer::reserveStreaming(): expected non-zero glyph and buffer count but got 0 and 3\n"
+        "Text::Renderer::reserveStreaming(): expected non-zero glyph and buffer count but got 4 and 0\n");
+}
+#endif
+
 void RendererGLTest::multiline() {
     class Layouter: public Text::AbstractLayouter {
         public:
@@ -431,6 +688,551 @@ void RendererGLTest::multiline() {
     }), TestSuite::Compare::Container);
 }
 
+void RendererGLTest::batch() {
+    TestFont font;
+    Text::BatchRenderer2D renderer{font, nullGlyphCache, 0.25f};
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(renderer.capacity(), 0);
+    CORRADE_COMPARE(renderer.glyphCount(), 0);
+    CORRADE_COMPARE(renderer.labelCount(), 0);
+    CORRADE_COMPARE(renderer.mesh().count(), 0);
+
+    renderer.reserve(8, GL::BufferUsage::DynamicDraw, GL::BufferUsage::StaticDraw);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(renderer.capacity(), 8);
+
+    /* First label takes exactly as many glyphs as it needs, second has space
+       for two more */
+    CORRADE_COMPARE(renderer.add("abc", {10.0f, 20.0f}), 0);
+    CORRADE_COMPARE(renderer.add("a", {-1.0f, 0.0f}, 3), 1);
+    CORRADE_COMPARE(renderer.glyphCount(), 6);
+    CORRADE_COMPARE(renderer.labelCount(), 2);
+    CORRADE_COMPARE(renderer.glyphRange(0), std::make_pair(0u, 3u));
+    CORRADE_COMPARE(renderer.glyphRange(1), std::make_pair(3u, 3u));
+    CORRADE_COMPARE(renderer.position(1), (Vector2{-1.0f, 0.0f}));
+    CORRADE_COMPARE(renderer.rectangle(0), Range2D({0.0f, -0.5f}, {5.0f, 1.0f}).translated({10.0f, 20.0f}));
+
+    /* The mesh gets updated only after an explicit update */
+    CORRADE_COMPARE(renderer.mesh().count(), 0);
+    renderer.update();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(renderer.mesh().count(), 6*6);
+
+    /** @todo How to verify this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    Containers::Array<char> vertices = renderer.vertexBuffer().data();
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Float>(vertices).prefix(96),
+        Containers::arrayView<Float>({
+            10.0f,  20.5f, 0.0f, 10.0f,
+            10.0f,  20.0f, 0.0f,  0.0f,
+            10.75f, 20.5f, 6.0f, 10.0f,
+            10.75f, 20.0f, 6.0f,  0.0f,
+
+            11.0f,  20.75f,  6.0f, 10.0f,
+            11.0f,  19.75f,  6.0f,  0.0f,
+            12.5f,  20.75f, 12.0f, 10.0f,
+            12.5f,  19.75f, 12.0f,  0.0f,
+
+            12.75f, 21.0f, 12.0f, 10.0f,
+            12.75f, 19.5f, 12.0f,  0.0f,
+            15.0f,  21.0f, 18.0f, 10.0f,
+            15.0f,  19.5f, 18.0f,  0.0f,
+
+            -1.0f,  0.5f, 0.0f, 10.0f,
+            -1.0f,  0.0f, 0.0f,  0.0f,
+            -0.25f, 0.5f, 6.0f, 10.0f,
+            -0.25f, 0.0f, 6.0f,  0.0f,
+
+            /* Unused glyphs are degenerate */
+            0.0f, 0.0f, 0.0f, 0.0f,
+            0.0f, 0.0f, 0.0f, 0.0f,
+            0.0f, 0.0f, 0.0f, 0.0f,
+            0.0f, 0.0f, 0.0f, 0.0f,
+
+            0.0f, 0.0f, 0.0f, 0.0f,
+            0.0f, 0.0f, 0.0f, 0.0f,
+            0.0f, 0.0f, 0.0f, 0.0f,
+            0.0f, 0.0f, 0.0f, 0.0f
+        }), TestSuite::Compare::Container);
+
+    Containers::Array<char> indices = renderer.indexBuffer().data();
+    CORRADE_COMPARE_AS(Containers::arrayCast<const UnsignedByte>(indices).prefix(12),
+        Containers::arrayView<UnsignedByte>({
+             0,  1,  2,  1,  3,  2,
+             4,  5,  6,  5,  7,  6
+        }), TestSuite::Compare::Container);
+    #endif
+}
+
+void RendererGLTest::batchUpdate() {
+    TestFont font;
+    Text::BatchRenderer2D renderer{font, nullGlyphCache, 0.25f};
+    renderer.reserve(4, GL::BufferUsage::DynamicDraw, GL::BufferUsage::StaticDraw);
+    renderer.add("a", {}, 1);
+    renderer.add("ab", {}, 3);
+    renderer.update();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Changing the text of the second label and moving the first one */
+    renderer.setText(1, "abc");
+    renderer.setPosition(0, {2.0f, 3.0f});
+    CORRADE_COMPARE(renderer.position(0), (Vector2{2.0f, 3.0f}));
+    CORRADE_COMPARE(renderer.rectangle(0), Range2D({0.0f, 0.0f}, {0.75f, 0.5f}).translated({2.0f, 3.0f}));
+    CORRADE_COMPARE(renderer.rectangle(1), Range2D({0.0f, -0.5f}, {5.0f, 1.0f}));
+    renderer.update();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(renderer.mesh().count(), 4*6);
+
+    /** @todo How to verify this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    Containers::Array<char> vertices = renderer.vertexBuffer().data();
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Float>(vertices).prefix(16),
+        Containers::arrayView<Float>({
+            2.0f,  3.5f, 0.0f, 10.0f,
+            2.0f,  3.0f, 0.0f,  0.0f,
+            2.75f, 3.5f, 6.0f, 10.0f,
+            2.75f, 3.0f, 6.0f,  0.0f
+        }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Float>(vertices).suffix(16),
+        Containers::arrayView<Float>({
+            2.75f,  1.0f, 12.0f, 10.0f,
+            2.75f, -0.5f, 12.0f,  0.0f,
+            5.0f,   1.0f, 18.0f, 10.0f,
+            5.0f,  -0.5f, 18.0f,  0.0f
+        }), TestSuite::Compare::Container);
+    #endif
+}
+
+void RendererGLTest::batchClear() {
+    TestFont font;
+    Text::BatchRenderer3D renderer{font, nullGlyphCache, 0.25f};
+    renderer.reserve(4, GL::BufferUsage::DynamicDraw, GL::BufferUsage::StaticDraw);
+    renderer.add("abc", {});
+    renderer.update();
+    CORRADE_COMPARE(renderer.mesh().count(), 3*6);
+
+    renderer.clear();
+    CORRADE_COMPARE(renderer.capacity(), 4);
+    CORRADE_COMPARE(renderer.glyphCount(), 0);
+    CORRADE_COMPARE(renderer.labelCount(), 0);
+    renderer.update();
+    CORRADE_COMPARE(renderer.mesh().count(), 0);
+
+    /* The capacity is available again */
+    CORRADE_COMPARE(renderer.add("abcd", {}), 0);
+    renderer.update();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(renderer.mesh().count(), 4*6);
+}
+
+void RendererGLTest::batchInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    TestFont font;
+    Text::BatchRenderer2D renderer{font, nullGlyphCache, 0.25f};
+    renderer.reserve(4, GL::BufferUsage::DynamicDraw, GL::BufferUsage::StaticDraw);
+    renderer.add("ab", {}, 2);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    renderer.add("abc", {});
+    renderer.setText(0, "abc");
+    renderer.setText(1, "a");
+    renderer.setPosition(1, {});
+    renderer.position(1);
+    renderer.rectangle(1);
+    renderer.glyphRange(1);
+    CORRADE_COMPARE(out.str(),
+        "Text::BatchRenderer::add(): capacity 4 too small to add 3 glyphs to 2 already used\n"
+        "Text::BatchRenderer::setText(): label capacity 2 too small to render 3 glyphs\n"
+        "Text::BatchRenderer::setText(): index 1 out of range for 1 labels\n"
+        "Text::BatchRenderer::setPosition(): index 1 out of range for 1 labels\n"
+        "Text::BatchRenderer::position(): index 1 out of range for 1 labels\n"
+        "Text::BatchRenderer::rectangle(): index 1 out of range for 1 labels\n"
+        "Text::BatchRenderer::glyphRange(): index 1 out of range for 1 labels\n");
+}
+
+void RendererGLTest::layoutCache() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::map_buffer_range>())
+        CORRADE_SKIP(GL::Extensions::ARB::map_buffer_range::string() << "is not supported.");
+    #elif defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::map_buffer_range>() &&
+       !GL::Context::current().isExtensionSupported<GL::Extensions::OES::mapbuffer>())
+        CORRADE_SKIP("No required extension is supported");
+    #endif
+
+    TestFont font;
+    GlyphCache glyphCache{Vector2i{16}};
+    LayoutCache cache;
+    CORRADE_COMPARE(cache.glyphCapacity(), 16384);
+    CORRADE_COMPARE(cache.glyphCount(), 0);
+    CORRADE_COMPARE(cache.textCount(), 0);
+
+    Text::Renderer2D renderer(font, glyphCache, 0.25f);
+    CORRADE_VERIFY(!renderer.layoutCache());
+    CORRADE_COMPARE(&renderer.setLayoutCache(&cache), &renderer);
+    CORRADE_COMPARE(renderer.layoutCache(), &cache);
+    renderer.reserve(4, GL::BufferUsage::DynamicDraw, GL::BufferUsage::DynamicDraw);
+
+    /* First render of each text does the layout */
+    renderer.render("abc");
+    renderer.render("ab");
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(font.layoutCount, 2);
+    CORRADE_COMPARE(cache.hitCount(), 0);
+    CORRADE_COMPARE(cache.missCount(), 2);
+    CORRADE_COMPARE(cache.textCount(), 2);
+    CORRADE_COMPARE(cache.glyphCount(), 5);
+
+    /* Rendering a text again takes it from the cache */
+    renderer.render("abc");
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(font.layoutCount, 2);
+    CORRADE_COMPARE(cache.hitCount(), 1);
+    CORRADE_COMPARE(cache.missCount(), 2);
+    CORRADE_COMPARE(cache.textCount(), 2);
+    CORRADE_COMPARE(renderer.rectangle(), Range2D({0.0f, -0.5f}, {5.0f, 1.0f}));
+    CORRADE_COMPARE(renderer.mesh().count(), 3*6);
+
+    /* Same data as in mutableText() */
+    /** @todo How to verify this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    Containers::Array<char> vertices = renderer.vertexBuffer().data();
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Float>(vertices).prefix(48),
+        Containers::arrayView<Float>({
+            0.0f,  0.5f, 0.0f, 10.0f,
+            0.0f,  0.0f, 0.0f,  0.0f,
+            0.75f, 0.5f, 6.0f, 10.0f,
+            0.75f, 0.0f, 6.0f,  0.0f,
+
+            1.0f,  0.75f,  6.0f, 10.0f,
+            1.0f, -0.25f,  6.0f,  0.0f,
+            2.5f,  0.75f, 12.0f, 10.0f,
+            2.5f, -0.25f, 12.0f,  0.0f,
+
+            2.75f,  1.0f, 12.0f, 10.0f,
+            2.75f, -0.5f, 12.0f,  0.0f,
+            5.0f,   1.0f, 18.0f, 10.0f,
+            5.0f,  -0.5f, 18.0f,  0.0f
+        }), TestSuite::Compare::Container);
+    #endif
+
+    /* Without the cache the layout is done again */
+    renderer.setLayoutCache(nullptr);
+    renderer.render("abc");
+    CORRADE_COMPARE(font.layoutCount, 3);
+    CORRADE_COMPARE(cache.hitCount(), 1);
+    CORRADE_COMPARE(cache.missCount(), 2);
+}
+
+void RendererGLTest::layoutCacheBatch() {
+    TestFont font;
+    GlyphCache glyphCache{Vector2i{16}};
+    LayoutCache cache;
+
+    Text::BatchRenderer2D renderer{font, glyphCache, 0.25f};
+    CORRADE_VERIFY(!renderer.layoutCache());
+    CORRADE_COMPARE(&renderer.setLayoutCache(&cache), &renderer);
+    CORRADE_COMPARE(renderer.layoutCache(), &cache);
+    renderer.reserve(8, GL::BufferUsage::DynamicDraw, GL::BufferUsage::StaticDraw);
+
+    /* Adding a label without an explicit capacity lays the text out only
+       once, the second lookup is a hit */
+    renderer.add("abc", {10.0f, 20.0f});
+    CORRADE_COMPARE(font.layoutCount, 1);
+    CORRADE_COMPARE(cache.hitCount(), 1);
+    CORRADE_COMPARE(cache.missCount(), 1);
+
+    /* Same text in another label, and setting it again, is a hit as well */
+    renderer.add("abc", {-1.0f, 0.0f}, 5);
+    renderer.setText(0, "abc");
+    CORRADE_COMPARE(font.layoutCount, 1);
+    CORRADE_COMPARE(cache.hitCount(), 3);
+    CORRADE_COMPARE(cache.missCount(), 1);
+    CORRADE_COMPARE(cache.textCount(), 1);
+    CORRADE_COMPARE(renderer.rectangle(0), Range2D({0.0f, -0.5f}, {5.0f, 1.0f}).translated({10.0f, 20.0f}));
+    CORRADE_COMPARE(renderer.rectangle(1), Range2D({0.0f, -0.5f}, {5.0f, 1.0f}).translated({-1.0f, 0.0f}));
+
+    renderer.update();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(renderer.mesh().count(), 8*6);
+
+    /** @todo How to verify this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    Containers::Array<char> vertices = renderer.vertexBuffer().data();
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Float>(vertices).slice(48, 64),
+        Containers::arrayView<Float>({
+            -1.0f,  0.5f, 0.0f, 10.0f,
+            -1.0f,  0.0f, 0.0f,  0.0f,
+            -0.25f, 0.5f, 6.0f, 10.0f,
+            -0.25f, 0.0f, 6.0f,  0.0f
+        }), TestSuite::Compare::Container);
+    #endif
+}
+
+void RendererGLTest::layoutCacheParameters() {
+    TestFont font1, font2;
+    GlyphCache glyphCache1{Vector2i{16}}, glyphCache2{Vector2i{16}};
+    LayoutCache cache;
+
+    /* The cache is shared among all renderers, but each of them differs in
+       one parameter so none of them is a hit */
+    Text::BatchRenderer2D a{font1, glyphCache1, 0.25f};
+    Text::BatchRenderer2D b{font2, glyphCache1, 0.25f};
+    Text::BatchRenderer2D c{font1, glyphCache2, 0.25f};
+    Text::BatchRenderer2D d{font1, glyphCache1, 0.5f};
+    Text::BatchRenderer2D e{font1, glyphCache1, 0.25f, Alignment::LineRight};
+    for(Text::BatchRenderer2D* renderer: {&a, &b, &c, &d, &e}) {
+        renderer->setLayoutCache(&cache)
+            .reserve(4, GL::BufferUsage::DynamicDraw, GL::BufferUsage::StaticDraw);
+        renderer->add("ab", {}, 4);
+    }
+    CORRADE_COMPARE(cache.hitCount(), 0);
+    CORRADE_COMPARE(cache.missCount(), 5);
+    CORRADE_COMPARE(cache.textCount(), 5);
+
+    /* A different text is a miss also, the same text is a hit */
+    a.setText(0, "abc");
+    a.setText(0, "ab");
+    CORRADE_COMPARE(cache.hitCount(), 1);
+    CORRADE_COMPARE(cache.missCount(), 6);
+    CORRADE_COMPARE(cache.textCount(), 6);
+    CORRADE_COMPARE(font1.layoutCount, 5);
+    CORRADE_COMPARE(font2.layoutCount, 1);
+    CORRADE_COMPARE(a.rectangle(0), Range2D({0.0f, -0.25f}, {2.5f, 0.75f}));
+    CORRADE_COMPARE(e.rectangle(0), Range2D({-2.5f, -0.25f}, {0.0f, 0.75f}));
+}
+
+void RendererGLTest::layoutCacheGlyphCacheChange() {
+    TestFont font;
+    GlyphCache glyphCache{Vector2i{16}};
+    LayoutCache cache;
+
+    Text::BatchRenderer2D renderer{font, glyphCache, 0.25f};
+    renderer.setLayoutCache(&cache)
+        .reserve(4, GL::BufferUsage::DynamicDraw, GL::BufferUsage::StaticDraw);
+    renderer.add("abc", {}, 4);
+    renderer.setText(0, "abc");
+    CORRADE_COMPARE(font.layoutCount, 1);
+    CORRADE_COMPARE(cache.hitCount(), 1);
+    CORRADE_COMPARE(cache.missCount(), 1);
+
+    /* Adding a glyph to the glyph cache invalidates all text laid out with
+       it. The text gets laid out again, reusing the original slot. */
+    glyphCache.insert(1, {}, {{}, {2, 2}});
+    renderer.setText(0, "abc");
+    CORRADE_COMPARE(font.layoutCount, 2);
+    CORRADE_COMPARE(cache.hitCount(), 1);
+    CORRADE_COMPARE(cache.missCount(), 2);
+    CORRADE_COMPARE(cache.textCount(), 1);
+    CORRADE_COMPARE(cache.glyphCount(), 3);
+
+    /* And it's a hit again after */
+    renderer.setText(0, "abc");
+    CORRADE_COMPARE(font.layoutCount, 2);
+    CORRADE_COMPARE(cache.hitCount(), 2);
+    CORRADE_COMPARE(cache.missCount(), 2);
+}
+
+void RendererGLTest::layoutCacheCapacity() {
+    TestFont font;
+    GlyphCache glyphCache{Vector2i{16}};
+    LayoutCache cache{4};
+    CORRADE_COMPARE(cache.glyphCapacity(), 4);
+
+    Text::BatchRenderer2D renderer{font, glyphCache, 0.25f};
+    renderer.setLayoutCache(&cache)
+        .reserve(8, GL::BufferUsage::DynamicDraw, GL::BufferUsage::StaticDraw);
+    renderer.add("abc", {}, 8);
+    CORRADE_COMPARE(cache.textCount(), 1);
+    CORRADE_COMPARE(cache.glyphCount(), 3);
+
+    /* Not enough space left, the cache is dropped and starts again */
+    renderer.setText(0, "ab");
+    CORRADE_COMPARE(cache.textCount(), 1);
+    CORRADE_COMPARE(cache.glyphCount(), 2);
+    renderer.setText(0, "abc");
+    CORRADE_COMPARE(cache.missCount(), 3);
+
+    /* Text larger than the whole capacity isn't cached at all */
+    renderer.setText(0, "abcde");
+    renderer.setText(0, "abcde");
+    CORRADE_COMPARE(font.layoutCount, 5);
+    CORRADE_COMPARE(cache.hitCount(), 0);
+    CORRADE_COMPARE(cache.missCount(), 5);
+    CORRADE_COMPARE(cache.textCount(), 1);
+    CORRADE_COMPARE(cache.glyphCount(), 3);
+    CORRADE_COMPARE(renderer.rectangle(0), Range2D({0.0f, -1.0f}, {12.25f, 1.5f}));
+
+    /* Clearing drops everything but keeps the statistics */
+    cache.clear();
+    CORRADE_COMPARE(cache.textCount(), 0);
+    CORRADE_COMPARE(cache.glyphCount(), 0);
+    CORRADE_COMPARE(cache.missCount(), 5);
+    renderer.setText(0, "abc");
+    CORRADE_COMPARE(cache.missCount(), 6);
+    CORRADE_COMPARE(cache.textCount(), 1);
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+void RendererGLTest::instanced() {
+    using namespace Math::Literals;
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::instanced_arrays>())
+        CORRADE_SKIP(GL::Extensions::ARB::instanced_arrays::string() << "is not supported.");
+    #endif
+
+    CacheFont font;
+    font.openData(nullptr, 10.0f);
+
+    /* The first and the third glyph share the same rectangle but have a
+       different position */
+    GlyphCache cache{{16, 16}};
+    cache.insert(1, {1, 2}, {{0, 0}, {4, 8}});
+    cache.insert(2, {0, -1}, {{4, 0}, {10, 6}});
+    cache.insert(3, {2, 0}, {{0, 0}, {4, 8}});
+
+    Text::InstancedRenderer renderer{font, cache, 5.0f};
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(renderer.capacity(), 0);
+    CORRADE_COMPARE(renderer.glyphCount(), 0);
+    CORRADE_COMPARE(renderer.mesh().primitive(), MeshPrimitive::TriangleStrip);
+    CORRADE_COMPARE(renderer.mesh().count(), 4);
+    CORRADE_COMPARE(renderer.mesh().instanceCount(), 0);
+
+    renderer.reserve(4, GL::BufferUsage::DynamicDraw);
+    renderer.render("abc", 0x3bd267_rgbf);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(renderer.capacity(), 4);
+    CORRADE_COMPARE(renderer.glyphCount(), 3);
+    CORRADE_COMPARE(renderer.mesh().instanceCount(), 3);
+    CORRADE_COMPARE(renderer.rectangle(), Range2D({0.5f, -0.5f}, {11.0f, 5.0f}));
+
+    /** @todo How to verify this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    struct Instance {
+        Vector3 offsetScale;
+        UnsignedInt glyphId;
+        Color4 color;
+    };
+    Containers::Array<char> instanceData = renderer.instanceBuffer().data();
+    CORRADE_COMPARE(instanceData.size(), 4*sizeof(Instance));
+    const Containers::ArrayView<const Instance> instances = Containers::arrayCast<const Instance>(instanceData).prefix(3);
+
+    /* Four glyphs in the cache including the "Not Found" glyph, each has two
+       texels */
+    Image2D image = renderer.glyphRectangleTexture().image(0, {PixelFormat::RGBA32F});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(image.size(), (Vector2i{2, 4}));
+    const Containers::StridedArrayView2D<const Vector4> rows = image.pixels<Vector4>();
+
+    /* Expand the instances the same way as the shader does. Which of the two
+       glyphs sharing a rectangle gets picked is implementation-defined, but
+       the result is the same. */
+    const Range2D expectedQuads[]{
+        {{0.5f, 1.0f}, {2.5f, 5.0f}},
+        {{4.0f, -0.5f}, {7.0f, 2.5f}},
+        {{9.0f, 0.0f}, {11.0f, 4.0f}}
+    };
+    const Range2D expectedTextureCoordinates[]{
+        {{0.0f, 0.0f}, {0.25f, 0.5f}},
+        {{0.25f, 0.0f}, {0.625f, 0.375f}},
+        {{0.0f, 0.0f}, {0.25f, 0.5f}}
+    };
+    for(std::size_t i = 0; i != instances.size(); ++i) {
+        CORRADE_ITERATION(i);
+        const Instance& instance = instances[i];
+        CORRADE_COMPARE_AS(instance.glyphId, 4u, TestSuite::Compare::Less);
+        const Vector4 quad = rows[instance.glyphId][0];
+        const Vector4 textureCoordinates = rows[instance.glyphId][1];
+        CORRADE_COMPARE(instance.offsetScale.z(), 0.5f);
+        CORRADE_COMPARE(Range2D(
+            instance.offsetScale.xy() + instance.offsetScale.z()*quad.xy(),
+            instance.offsetScale.xy() + instance.offsetScale.z()*Vector2{quad.z(), quad.w()}),
+            expectedQuads[i]);
+        CORRADE_COMPARE(Range2D(textureCoordinates.xy(), Vector2{textureCoordinates.z(), textureCoordinates.w()}), expectedTextureCoordinates[i]);
+        CORRADE_COMPARE(instance.color, 0x3bd267ff_rgbaf);
+    }
+    #endif
+
+    /* Rendering a shorter text updates just the count */
+    renderer.render("b");
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(renderer.glyphCount(), 1);
+    CORRADE_COMPARE(renderer.mesh().instanceCount(), 1);
+    CORRADE_COMPARE(renderer.rectangle(), Range2D({0.0f, -0.5f}, {3.0f, 2.5f}));
+
+    /* Reserving resets the count */
+    renderer.reserve(8, GL::BufferUsage::DynamicDraw);
+    CORRADE_COMPARE(renderer.capacity(), 8);
+    CORRADE_COMPARE(renderer.glyphCount(), 0);
+    CORRADE_COMPARE(renderer.mesh().instanceCount(), 0);
+}
+
+void RendererGLTest::instancedCacheUpdate() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::instanced_arrays>())
+        CORRADE_SKIP(GL::Extensions::ARB::instanced_arrays::string() << "is not supported.");
+    #endif
+
+    CacheFont font;
+    font.openData(nullptr, 10.0f);
+
+    GlyphCache cache{{16, 16}};
+    cache.insert(1, {1, 2}, {{0, 0}, {4, 8}});
+
+    Text::InstancedRenderer renderer{font, cache, 5.0f};
+    renderer.reserve(2, GL::BufferUsage::DynamicDraw);
+
+    /* A glyph added after the renderer was created gets picked up on the
+       next render(), otherwise the render would assert */
+    cache.insert(2, {0, -1}, {{4, 0}, {10, 6}});
+    renderer.render("ab");
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(renderer.glyphCount(), 2);
+
+    /** @todo How to verify this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    Image2D image = renderer.glyphRectangleTexture().image(0, {PixelFormat::RGBA32F});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(image.size(), (Vector2i{2, 3}));
+    #endif
+}
+
+void RendererGLTest::instancedInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::instanced_arrays>())
+        CORRADE_SKIP(GL::Extensions::ARB::instanced_arrays::string() << "is not supported.");
+    #endif
+
+    CacheFont font;
+    font.openData(nullptr, 10.0f);
+
+    GlyphCache cache{{16, 16}};
+    cache.insert(1, {1, 2}, {{0, 0}, {4, 8}});
+
+    /* TestFont produces texture coordinates that don't match any glyph */
+    TestFont testFont;
+
+    Text::InstancedRenderer renderer{font, cache, 5.0f};
+    Text::InstancedRenderer testRenderer{testFont, cache, 5.0f};
+    renderer.reserve(2, GL::BufferUsage::DynamicDraw);
+    testRenderer.reserve(2, GL::BufferUsage::DynamicDraw);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    renderer.render("aaa");
+    testRenderer.render("a");
+    CORRADE_COMPARE(out.str(),
+        "Text::InstancedRenderer::render(): capacity 2 too small to render 3 glyphs\n"
+        "Text::InstancedRenderer::render(): no glyph in the cache matches texture coordinates Range({0, 0}, {6, 10})\n");
+}
+#endif
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Text::Test::RendererGLTest)
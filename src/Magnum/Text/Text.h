@@ -45,11 +45,21 @@ enum class Alignment: UnsignedByte;
 class AbstractGlyphCache;
 #ifdef MAGNUM_TARGET_GL
 class DistanceFieldGlyphCache;
+class DynamicGlyphCache;
 class GlyphCache;
+class LayoutCache;
+class MultiChannelDistanceFieldGlyphCache;
 class AbstractRenderer;
 template<UnsignedInt> class Renderer;
 typedef Renderer<2> Renderer2D;
 typedef Renderer<3> Renderer3D;
+class AbstractBatchRenderer;
+template<UnsignedInt> class BatchRenderer;
+typedef BatchRenderer<2> BatchRenderer2D;
+typedef BatchRenderer<3> BatchRenderer3D;
+#ifndef MAGNUM_TARGET_GLES2
+class InstancedRenderer;
+#endif
 #endif
 #endif
 
@@ -28,6 +28,8 @@
 #include <algorithm>
 #include <vector>
 #include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/EnumSet.hpp>
+#include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Containers/Pair.h>
 
@@ -36,6 +38,272 @@
 
 namespace Magnum { namespace TextureTools {
 
+Debug& operator<<(Debug& debug, const AtlasPackerFlag value) {
+    debug << "TextureTools::AtlasPackerFlag" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(v) case AtlasPackerFlag::v: return debug << "::" #v;
+        _c(AllowRotation)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+Debug& operator<<(Debug& debug, const AtlasPackerFlags value) {
+    return Containers::enumSetDebugOutput(debug, value, "TextureTools::AtlasPackerFlags{}", {
+        AtlasPackerFlag::AllowRotation});
+}
+
+namespace {
+
+struct FreeRectangle {
+    Range2Di rectangle;
+    Int layer;
+};
+
+/* Places a rectangle into the free space, splitting free rectangles that
+   overlap it and removing the ones that are fully contained in others
+   afterwards */
+void place(Containers::Array<FreeRectangle>& free, const Range2Di& placed, const Int layer) {
+    for(std::size_t i = 0; i != free.size(); ) {
+        const FreeRectangle f = free[i];
+        /* Touching edges don't count as an intersection */
+        if(f.layer != layer || !Math::intersects(f.rectangle, placed)) {
+            ++i;
+            continue;
+        }
+
+        /* Remove the overlapped rectangle, replace it with up to four parts
+           that are outside of the placed one. The parts overlap each other,
+           that's how MaxRects works. */
+        free[i] = free.back();
+        arrayResize(free, free.size() - 1);
+        const Range2Di& r = f.rectangle;
+        if(placed.left() > r.left())
+            arrayAppend(free, FreeRectangle{{r.min(), {placed.left(), r.top()}}, layer});
+        if(placed.right() < r.right())
+            arrayAppend(free, FreeRectangle{{{placed.right(), r.bottom()}, r.max()}, layer});
+        if(placed.bottom() > r.bottom())
+            arrayAppend(free, FreeRectangle{{r.min(), {r.right(), placed.bottom()}}, layer});
+        if(placed.top() < r.top())
+            arrayAppend(free, FreeRectangle{{{r.left(), placed.top()}, r.max()}, layer});
+    }
+}
+
+void prune(Containers::Array<FreeRectangle>& free) {
+    for(std::size_t i = 0; i < free.size(); ) {
+        bool contained = false;
+        for(std::size_t j = 0; j != free.size(); ++j) {
+            if(i == j || free[i].layer != free[j].layer || !free[j].rectangle.contains(free[i].rectangle))
+                continue;
+            /* If two rectangles are the same, remove just the one with the
+               larger index */
+            if(free[i].rectangle == free[j].rectangle && i < j)
+                continue;
+            contained = true;
+            break;
+        }
+
+        if(contained) {
+            free[i] = free.back();
+            arrayResize(free, free.size() - 1);
+        } else ++i;
+    }
+}
+
+/* Merges free rectangles that share a whole edge. Used after removal as the
+   freed space isn't in a maximal rectangle. */
+void merge(Containers::Array<FreeRectangle>& free) {
+    for(bool merged = true; merged; ) {
+        merged = false;
+        for(std::size_t i = 0; i != free.size() && !merged; ++i) {
+            for(std::size_t j = i + 1; j != free.size(); ++j) {
+                if(free[i].layer != free[j].layer) continue;
+
+                const Range2Di& a = free[i].rectangle;
+                const Range2Di& b = free[j].rectangle;
+                Range2Di joined;
+                if(a.bottom() == b.bottom() && a.top() == b.top() && (a.right() == b.left() || b.right() == a.left()))
+                    joined = Math::join(a, b);
+                else if(a.left() == b.left() && a.right() == b.right() && (a.top() == b.bottom() || b.top() == a.bottom()))
+                    joined = Math::join(a, b);
+                else continue;
+
+                free[i].rectangle = joined;
+                free[j] = free.back();
+                arrayResize(free, free.size() - 1);
+                merged = true;
+                break;
+            }
+        }
+    }
+}
+
+}
+
+struct AtlasPacker::State {
+    Vector3i size;
+    AtlasPackerFlags flags;
+    Vector2i padding;
+    std::size_t count{}, filledArea{};
+    Containers::Array<FreeRectangle> free;
+};
+
+AtlasPacker::AtlasPacker(const Vector3i& size, const AtlasPackerFlags flags): _state{InPlaceInit} {
+    CORRADE_ASSERT(size.product(),
+        "TextureTools::AtlasPacker: expected a non-zero size, got" << Debug::packed << size, );
+
+    _state->size = size;
+    _state->flags = flags;
+    clear();
+}
+
+AtlasPacker::AtlasPacker(AtlasPacker&&) noexcept = default;
+
+AtlasPacker::~AtlasPacker() = default;
+
+AtlasPacker& AtlasPacker::operator=(AtlasPacker&&) noexcept = default;
+
+Vector3i AtlasPacker::size() const { return _state->size; }
+
+AtlasPackerFlags AtlasPacker::flags() const { return _state->flags; }
+
+Vector2i AtlasPacker::padding() const { return _state->padding; }
+
+AtlasPacker& AtlasPacker::setPadding(const Vector2i& padding) {
+    CORRADE_ASSERT(!_state->count,
+        "TextureTools::AtlasPacker::setPadding(): the packer is not empty", *this);
+    _state->padding = padding;
+    return *this;
+}
+
+std::size_t AtlasPacker::count() const { return _state->count; }
+
+std::size_t AtlasPacker::filledArea() const { return _state->filledArea; }
+
+bool AtlasPacker::add(const Containers::StridedArrayView1D<const Vector2i>& sizes, const Containers::StridedArrayView1D<Vector3i>& offsets, const Containers::StridedArrayView1D<bool>& rotations) {
+    State& state = *_state;
+    CORRADE_ASSERT(offsets.size() == sizes.size() && rotations.size() == sizes.size(),
+        "TextureTools::AtlasPacker::add(): expected sizes, offsets and rotations views to have the same size, got" << sizes.size() << Debug::nospace << "," << offsets.size() << "and" << rotations.size(), {});
+
+    /* Sort the textures by their longer side and then by the shorter side,
+       largest first. Keeping the original index in Z. */
+    Containers::Array<Vector3i> sorted{NoInit, sizes.size()};
+    for(std::size_t i = 0; i != sizes.size(); ++i) {
+        CORRADE_ASSERT((sizes[i] >= Vector2i{}).all(),
+            "TextureTools::AtlasPacker::add(): expected size" << i << "to be non-negative, got" << Debug::packed << sizes[i], {});
+        sorted[i] = {sizes[i], Int(i)};
+    }
+    std::stable_sort(sorted.begin(), sorted.end(), [](const Vector3i& a, const Vector3i& b) {
+        const Int aLonger = Math::max(a.x(), a.y()), bLonger = Math::max(b.x(), b.y());
+        if(aLonger != bLonger) return aLonger > bLonger;
+        return Math::min(a.x(), a.y()) > Math::min(b.x(), b.y());
+    });
+
+    /* Work on a copy of the free space so the state can be left untouched if
+       something doesn't fit */
+    Containers::Array<FreeRectangle> free;
+    arrayAppend(free, Containers::ArrayView<const FreeRectangle>{state.free});
+
+    const bool allowRotation = state.flags & AtlasPackerFlag::AllowRotation;
+    std::size_t filledArea = 0;
+    for(const Vector3i& item: sorted) {
+        const Vector2i paddedSize = item.xy() + 2*state.padding;
+
+        /* Find the free rectangle in the lowest possible layer, where the
+           texture leaves the shortest leftover side, and if equal, the
+           shortest longer leftover side */
+        std::size_t best = free.size();
+        bool bestRotated = false;
+        Int bestLayer{}, bestShortSide{}, bestLongSide{};
+        for(std::size_t i = 0; i != free.size(); ++i) {
+            const FreeRectangle& f = free[i];
+            for(const bool rotated: {false, true}) {
+                if(rotated && (!allowRotation || paddedSize.x() == paddedSize.y()))
+                    continue;
+                const Vector2i leftover = f.rectangle.size() - (rotated ? paddedSize.flipped() : paddedSize);
+                if((leftover < Vector2i{}).any()) continue;
+
+                const Int shortSide = leftover.min();
+                const Int longSide = leftover.max();
+                if(best == free.size() ||
+                   f.layer < bestLayer ||
+                  (f.layer == bestLayer && (shortSide < bestShortSide ||
+                  (shortSide == bestShortSide && longSide < bestLongSide)))) {
+                    best = i;
+                    bestRotated = rotated;
+                    bestLayer = f.layer;
+                    bestShortSide = shortSide;
+                    bestLongSide = longSide;
+                }
+            }
+        }
+
+        if(best == free.size()) return false;
+
+        const Range2Di placed = Range2Di::fromSize(free[best].rectangle.min(),
+            bestRotated ? paddedSize.flipped() : paddedSize);
+        place(free, placed, bestLayer);
+        prune(free);
+
+        offsets[item.z()] = {placed.min() + state.padding, bestLayer};
+        rotations[item.z()] = bestRotated;
+        filledArea += placed.size().product();
+    }
+
+    state.free = std::move(free);
+    state.count += sizes.size();
+    state.filledArea += filledArea;
+    return true;
+}
+
+bool AtlasPacker::add(const Containers::StridedArrayView1D<const Vector2i>& sizes, const Containers::StridedArrayView1D<Vector3i>& offsets) {
+    CORRADE_ASSERT(!(_state->flags & AtlasPackerFlag::AllowRotation),
+        "TextureTools::AtlasPacker::add():" << AtlasPackerFlag::AllowRotation << "set, expected a rotations view", {});
+
+    /* The rotations are never set to true in this case, so it's enough to
+       give it a single value with a zero stride */
+    bool rotation;
+    return add(sizes, offsets, Containers::StridedArrayView1D<bool>{Containers::arrayView(&rotation, 1), sizes.size(), 0});
+}
+
+void AtlasPacker::remove(const Vector3i& offset, const Vector2i& size) {
+    State& state = *_state;
+    const Range2Di rectangle = Range2Di::fromSize(offset.xy() - state.padding, size + 2*state.padding);
+    CORRADE_ASSERT(offset.z() >= 0 && offset.z() < state.size.z() && (rectangle.min() >= Vector2i{}).all() && (rectangle.max() <= state.size.xy()).all(),
+        "TextureTools::AtlasPacker::remove(): rectangle" << rectangle << "in layer" << offset.z() << "out of bounds for" << Debug::packed << state.size, );
+    CORRADE_ASSERT(state.count,
+        "TextureTools::AtlasPacker::remove(): the packer is empty", );
+
+    --state.count;
+    state.filledArea -= rectangle.size().product();
+
+    /* If this was the last texture, start from scratch */
+    if(!state.count) {
+        clear();
+        return;
+    }
+
+    /* Zero-area rectangles don't occupy anything */
+    if(!rectangle.size().product()) return;
+
+    arrayAppend(state.free, FreeRectangle{rectangle, offset.z()});
+    merge(state.free);
+    prune(state.free);
+}
+
+void AtlasPacker::clear() {
+    State& state = *_state;
+    state.count = 0;
+    state.filledArea = 0;
+    arrayResize(state.free, 0);
+    for(Int layer = 0; layer != state.size.z(); ++layer)
+        arrayAppend(state.free, FreeRectangle{{{}, state.size.xy()}, layer});
+}
+
 std::vector<Range2Di> atlas(const Vector2i& atlasSize, const std::vector<Vector2i>& sizes, const Vector2i& padding) {
     if(sizes.empty()) return {};
 
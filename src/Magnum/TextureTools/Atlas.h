@@ -26,17 +26,191 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::TextureTools::atlas(), @ref Magnum::TextureTools::atlasArrayPowerOfTwo()
+ * @brief Class @ref Magnum::TextureTools::AtlasPacker, function @ref Magnum::TextureTools::atlas(), @ref Magnum::TextureTools::atlasArrayPowerOfTwo(), enum @ref Magnum::TextureTools::AtlasPackerFlag, enum set @ref Magnum::TextureTools::AtlasPackerFlags
  */
 
+#include <Corrade/Containers/EnumSet.h>
+#include <Corrade/Containers/Pointer.h>
 #include <Corrade/Utility/StlForwardVector.h>
 
 #include "Magnum/Magnum.h"
-#include "Magnum/Math/Vector2.h"
+#include "Magnum/Math/Vector3.h"
 #include "Magnum/TextureTools/visibility.h"
 
 namespace Magnum { namespace TextureTools {
 
+/**
+@brief Atlas packer flag
+@m_since_latest
+
+@see @ref AtlasPackerFlags, @ref AtlasPacker
+*/
+enum class AtlasPackerFlag: UnsignedByte {
+    /**
+     * Allow rotating the textures by 90° if they fit better that way. The
+     * rotation is reported for each texture in
+     * @ref AtlasPacker::add(const Containers::StridedArrayView1D<const Vector2i>&, const Containers::StridedArrayView1D<Vector3i>&, const Containers::StridedArrayView1D<bool>&).
+     */
+    AllowRotation = 1 << 0
+};
+
+/**
+@brief Atlas packer flags
+@m_since_latest
+
+@see @ref AtlasPacker
+*/
+typedef Containers::EnumSet<AtlasPackerFlag> AtlasPackerFlags;
+
+CORRADE_ENUMSET_OPERATORS(AtlasPackerFlags)
+
+/**
+@debugoperatorenum{AtlasPackerFlag}
+@m_since_latest
+*/
+MAGNUM_TEXTURETOOLS_EXPORT Debug& operator<<(Debug& debug, AtlasPackerFlag value);
+
+/**
+@debugoperatorenum{AtlasPackerFlags}
+@m_since_latest
+*/
+MAGNUM_TEXTURETOOLS_EXPORT Debug& operator<<(Debug& debug, AtlasPackerFlags value);
+
+/**
+@brief Incremental texture atlas packer
+@m_since_latest
+
+Unlike @ref atlas(), which places all textures in a grid of the largest texture
+size at once, this packer keeps track of free space in the atlas, allowing
+textures to be added and removed over time. It implements the *MaxRects*
+algorithm with the *best short side fit* heuristic, which is known to give
+fill rates well above 90% for typical texture sets, compared to the grid
+placement where the fill rate depends on how much the texture sizes differ.
+
+@section TextureTools-AtlasPacker-usage Usage
+
+Construct the packer with the atlas size and layer count, then call
+@ref add() with texture sizes. On success, the offsets are filled with
+positions of the textures, Z being the layer index.
+
+@snippet MagnumTextureTools.cpp AtlasPacker-usage
+
+Each @ref add() call sorts the textures from largest to smallest for better
+packing, so it's better to add many textures at once than one by one. Textures
+are put into the first layer that has enough space. If some texture doesn't fit
+into any layer, the function returns @cpp false @ce and the packer state is
+left unchanged.
+
+Textures added earlier can be removed with @ref remove(), making the space
+available again. The free space is not defragmented, so after many removals
+the fill rate may be worse than with a fresh packer. Use @ref clear() to start
+from scratch.
+*/
+class MAGNUM_TEXTURETOOLS_EXPORT AtlasPacker {
+    public:
+        /**
+         * @brief Constructor
+         * @param size      Atlas size, with Z being the layer count
+         * @param flags     Flags
+         *
+         * Expects that all components of @p size are non-zero.
+         */
+        explicit AtlasPacker(const Vector3i& size, AtlasPackerFlags flags = {});
+
+        /** @brief Copying is not allowed */
+        AtlasPacker(const AtlasPacker&) = delete;
+
+        /** @brief Move constructor */
+        AtlasPacker(AtlasPacker&&) noexcept;
+
+        ~AtlasPacker();
+
+        /** @brief Copying is not allowed */
+        AtlasPacker& operator=(const AtlasPacker&) = delete;
+
+        /** @brief Move assignment */
+        AtlasPacker& operator=(AtlasPacker&&) noexcept;
+
+        /** @brief Atlas size, with Z being the layer count */
+        Vector3i size() const;
+
+        /** @brief Flags */
+        AtlasPackerFlags flags() const;
+
+        /** @brief Padding around each texture */
+        Vector2i padding() const;
+
+        /**
+         * @brief Set padding around each texture
+         * @return Reference to self (for method chaining)
+         *
+         * Padding is added twice to each size and the textures are placed so
+         * the padding doesn't overlap. Offsets returned from @ref add() don't
+         * include the padding. Can be called only if the packer is empty.
+         * Default is a zero vector.
+         */
+        AtlasPacker& setPadding(const Vector2i& padding);
+
+        /** @brief Count of textures currently in the atlas */
+        std::size_t count() const;
+
+        /**
+         * @brief Area of textures currently in the atlas
+         *
+         * Includes padding. Dividing this by the product of @ref size() gives
+         * the fill rate.
+         */
+        std::size_t filledArea() const;
+
+        /**
+         * @brief Add textures to the atlas
+         * @param[in] sizes     Texture sizes
+         * @param[out] offsets  Where to put texture offsets, with Z being the
+         *      layer index
+         * @param[out] rotations Where to put whether given texture was
+         *      rotated by 90°
+         * @return Whether all textures fit into the atlas
+         *
+         * Expects that all views have the same size. If @ref AtlasPackerFlag::AllowRotation
+         * isn't set, all @p rotations are set to @cpp false @ce. Otherwise,
+         * if a texture is rotated, it occupies a rectangle of size
+         * @p sizes flipped. If not all textures fit, returns @cpp false @ce,
+         * leaves the packer state unchanged and the contents of @p offsets
+         * and @p rotations are unspecified.
+         */
+        bool add(const Containers::StridedArrayView1D<const Vector2i>& sizes, const Containers::StridedArrayView1D<Vector3i>& offsets, const Containers::StridedArrayView1D<bool>& rotations);
+
+        /**
+         * @brief Add textures to the atlas without rotation
+         *
+         * Same as above, but expects that
+         * @ref AtlasPackerFlag::AllowRotation is not set.
+         */
+        bool add(const Containers::StridedArrayView1D<const Vector2i>& sizes, const Containers::StridedArrayView1D<Vector3i>& offsets);
+
+        /**
+         * @brief Remove a texture from the atlas
+         * @param offset    Texture offset, with Z being the layer index
+         * @param size      Texture size, flipped if the texture was rotated
+         *
+         * Expects that the rectangle, including padding, is in bounds of the
+         * atlas. The rectangle is expected to be a texture previously added
+         * with @ref add(), this isn't checked.
+         */
+        void remove(const Vector3i& offset, const Vector2i& size);
+
+        /**
+         * @brief Remove all textures from the atlas
+         *
+         * Padding is preserved.
+         */
+        void clear();
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
 /**
 @brief Pack textures into texture atlas
 @param atlasSize    Size of resulting atlas
@@ -49,6 +223,11 @@ into required size, empty vector is returned.
 Padding is added twice to each size and the atlas is laid out so the padding
 don't overlap. Returned sizes are the same as original sizes, i.e. without the
 padding.
+
+The textures are placed in a grid with cell size being the largest texture
+size, which wastes a lot of space if the sizes differ. See @ref AtlasPacker for
+a packer with a significantly better fill rate that additionally supports
+incremental insertion, removal, multiple layers and rotation.
 */
 std::vector<Range2Di> MAGNUM_TEXTURETOOLS_EXPORT atlas(const Vector2i& atlasSize, const std::vector<Vector2i>& sizes, const Vector2i& padding = Vector2i());
 
@@ -0,0 +1,864 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "CompressBlocks.h"
+
+#include <cstring>
+#include <utility>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/EnumSet.hpp>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/Implementation/parallelFor.h"
+
+#ifdef MAGNUM_TARGET_GL
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#endif
+
+#ifdef CORRADE_TARGET_SSE2
+#include <emmintrin.h>
+#elif defined(CORRADE_TARGET_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace Magnum { namespace TextureTools {
+
+namespace {
+
+/* A 4x4 block of pixels in a planar layout, with pixels in a row-major order
+   and the first row being the first row in memory. The values are signed
+   16-bit so the SIMD kernels can subtract them without overflow. */
+struct Block {
+    Short channels[4][16];
+};
+
+void fetchBlock(const Containers::StridedArrayView3D<const char>& pixels, const UnsignedInt channelCount, const Vector2i& position, Block& out) {
+    const Int width = Int(pixels.size()[1]);
+    const Int height = Int(pixels.size()[0]);
+    for(Int y = 0; y != 4; ++y) {
+        /* Partial blocks on the edges repeat the last row and column */
+        const Int imageY = Math::min(position.y() + y, height - 1);
+        for(Int x = 0; x != 4; ++x) {
+            const Int imageX = Math::min(position.x() + x, width - 1);
+            const UnsignedByte* const pixel = reinterpret_cast<const UnsignedByte*>(static_cast<const char*>(pixels.data()) + imageY*pixels.stride()[0] + imageX*pixels.stride()[1]);
+            for(UnsignedInt c = 0; c != 4; ++c)
+                out.channels[c][y*4 + x] = c < channelCount ? pixel[c] : c == 3 ? 255 : 0;
+        }
+    }
+}
+
+void writeLittleEndian(char* const out, const UnsignedLong value, const UnsignedInt byteCount) {
+    for(UnsignedInt i = 0; i != byteCount; ++i)
+        out[i] = char(value >> (i*8) & 0xff);
+}
+
+void writeBigEndian(char* const out, const UnsignedLong value, const UnsignedInt byteCount) {
+    for(UnsignedInt i = 0; i != byteCount; ++i)
+        out[i] = char(value >> ((byteCount - i - 1)*8) & 0xff);
+}
+
+/* Appends count lowest bits of value to a little-endian bit stream. The
+   output is expected to be zero-initialized. */
+void writeBits(UnsignedByte* const out, UnsignedInt& offset, const UnsignedInt value, const UnsignedInt count) {
+    for(UnsignedInt i = 0; i != count; ++i, ++offset)
+        if(value >> i & 1) out[offset >> 3] |= 1 << (offset & 7);
+}
+
+/* For each pixel finds the nearest of the first paletteSize palette entries,
+   taking into account the first three or all four channels. Saves its index
+   and the squared distance to it. */
+template<UnsignedInt channels> void nearestPaletteEntries(const Block& block, const Short(&palette)[16][4], const UnsignedInt paletteSize, Int(&indices)[16], Int(&distances)[16]) {
+    #ifdef CORRADE_TARGET_SSE2
+    /* Four pixels at a time, with the channel differences interleaved so
+       _mm_madd_epi16() directly gives a sum of two squares in 32 bits */
+    const __m128i zero = _mm_setzero_si128();
+    for(std::size_t i = 0; i != 16; i += 4) {
+        const __m128i r = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(block.channels[0] + i));
+        const __m128i g = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(block.channels[1] + i));
+        const __m128i b = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(block.channels[2] + i));
+        const __m128i a = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(block.channels[3] + i));
+        __m128i best = _mm_set1_epi32(0x7fffffff);
+        __m128i bestIndex = zero;
+        for(UnsignedInt j = 0; j != paletteSize; ++j) {
+            const __m128i rg = _mm_unpacklo_epi16(
+                _mm_sub_epi16(r, _mm_set1_epi16(palette[j][0])),
+                _mm_sub_epi16(g, _mm_set1_epi16(palette[j][1])));
+            const __m128i ba = _mm_unpacklo_epi16(
+                _mm_sub_epi16(b, _mm_set1_epi16(palette[j][2])),
+                channels == 4 ? _mm_sub_epi16(a, _mm_set1_epi16(palette[j][3])) : zero);
+            const __m128i distance = _mm_add_epi32(_mm_madd_epi16(rg, rg), _mm_madd_epi16(ba, ba));
+            const __m128i less = _mm_cmplt_epi32(distance, best);
+            best = _mm_or_si128(_mm_and_si128(less, distance), _mm_andnot_si128(less, best));
+            bestIndex = _mm_or_si128(_mm_and_si128(less, _mm_set1_epi32(Int(j))), _mm_andnot_si128(less, bestIndex));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(indices + i), bestIndex);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(distances + i), best);
+    }
+    #elif defined(CORRADE_TARGET_NEON)
+    for(std::size_t i = 0; i != 16; i += 4) {
+        const int16x4_t r = vld1_s16(block.channels[0] + i);
+        const int16x4_t g = vld1_s16(block.channels[1] + i);
+        const int16x4_t b = vld1_s16(block.channels[2] + i);
+        const int16x4_t a = vld1_s16(block.channels[3] + i);
+        int32x4_t best = vdupq_n_s32(0x7fffffff);
+        int32x4_t bestIndex = vdupq_n_s32(0);
+        for(UnsignedInt j = 0; j != paletteSize; ++j) {
+            const int16x4_t dr = vsub_s16(r, vdup_n_s16(palette[j][0]));
+            const int16x4_t dg = vsub_s16(g, vdup_n_s16(palette[j][1]));
+            const int16x4_t db = vsub_s16(b, vdup_n_s16(palette[j][2]));
+            int32x4_t distance = vmull_s16(dr, dr);
+            distance = vmlal_s16(distance, dg, dg);
+            distance = vmlal_s16(distance, db, db);
+            if(channels == 4) {
+                const int16x4_t da = vsub_s16(a, vdup_n_s16(palette[j][3]));
+                distance = vmlal_s16(distance, da, da);
+            }
+            const uint32x4_t less = vcltq_s32(distance, best);
+            best = vbslq_s32(less, distance, best);
+            bestIndex = vbslq_s32(less, vdupq_n_s32(Int(j)), bestIndex);
+        }
+        vst1q_s32(indices + i, bestIndex);
+        vst1q_s32(distances + i, best);
+    }
+    #else
+    for(std::size_t i = 0; i != 16; ++i) {
+        Int best = 0x7fffffff;
+        Int bestIndex = 0;
+        for(UnsignedInt j = 0; j != paletteSize; ++j) {
+            Int distance = 0;
+            for(UnsignedInt c = 0; c != channels; ++c) {
+                const Int d = block.channels[c][i] - palette[j][c];
+                distance += d*d;
+            }
+            if(distance < best) {
+                best = distance;
+                bestIndex = Int(j);
+            }
+        }
+        indices[i] = bestIndex;
+        distances[i] = best;
+    }
+    #endif
+}
+
+/* Endpoints on the principal axis of pixels in the mask, found with a power
+   iteration on their covariance matrix. The endpoints are moved inwards by
+   given fraction of their distance, as the extremes are usually outliers. */
+template<UnsignedInt channels> void principalAxisEndpoints(const Block& block, const UnsignedInt mask, const Float inset, Float(&a)[channels], Float(&b)[channels]) {
+    Float mean[channels]{};
+    Float min[channels], max[channels];
+    Float count = 0.0f;
+    for(UnsignedInt c = 0; c != channels; ++c) {
+        min[c] = 255.0f;
+        max[c] = 0.0f;
+    }
+    for(UnsignedInt i = 0; i != 16; ++i) if(mask & (1 << i)) {
+        for(UnsignedInt c = 0; c != channels; ++c) {
+            const Float value = block.channels[c][i];
+            mean[c] += value;
+            min[c] = Math::min(min[c], value);
+            max[c] = Math::max(max[c], value);
+        }
+        count += 1.0f;
+    }
+    for(UnsignedInt c = 0; c != channels; ++c)
+        mean[c] /= count;
+
+    Float covariance[channels][channels]{};
+    for(UnsignedInt i = 0; i != 16; ++i) if(mask & (1 << i)) {
+        Float d[channels];
+        for(UnsignedInt c = 0; c != channels; ++c)
+            d[c] = block.channels[c][i] - mean[c];
+        for(UnsignedInt c = 0; c != channels; ++c)
+            for(UnsignedInt e = 0; e != channels; ++e)
+                covariance[c][e] += d[c]*d[e];
+    }
+
+    /* Starting from the bounding box diagonal, a few iterations are enough
+       to converge for practical data */
+    Float axis[channels];
+    for(UnsignedInt c = 0; c != channels; ++c)
+        axis[c] = max[c] - min[c];
+    for(UnsignedInt iteration = 0; iteration != 8; ++iteration) {
+        Float next[channels]{};
+        Float length = 0.0f;
+        for(UnsignedInt c = 0; c != channels; ++c) {
+            for(UnsignedInt e = 0; e != channels; ++e)
+                next[c] += covariance[c][e]*axis[e];
+            length = Math::max(length, Math::abs(next[c]));
+        }
+        if(length == 0.0f) break;
+        for(UnsignedInt c = 0; c != channels; ++c)
+            axis[c] = next[c]/length;
+    }
+
+    Float axisLengthSquared = 0.0f;
+    for(UnsignedInt c = 0; c != channels; ++c)
+        axisLengthSquared += axis[c]*axis[c];
+    Float tMin = 0.0f, tMax = 0.0f;
+    if(axisLengthSquared > 0.0f) for(UnsignedInt i = 0; i != 16; ++i) if(mask & (1 << i)) {
+        Float t = 0.0f;
+        for(UnsignedInt c = 0; c != channels; ++c)
+            t += (block.channels[c][i] - mean[c])*axis[c];
+        t /= axisLengthSquared;
+        tMin = Math::min(tMin, t);
+        tMax = Math::max(tMax, t);
+    }
+
+    const Float tInset = (tMax - tMin)*inset;
+    for(UnsignedInt c = 0; c != channels; ++c) {
+        a[c] = Math::clamp(mean[c] + axis[c]*(tMin + tInset), 0.0f, 255.0f);
+        b[c] = Math::clamp(mean[c] + axis[c]*(tMax - tInset), 0.0f, 255.0f);
+    }
+}
+
+/* Least-squares fit of endpoints for pixels in the mask, with the weight
+   being the fraction of the second endpoint in the interpolated value.
+   Returns false if all weights are the same and there's no unique
+   solution. */
+template<UnsignedInt channels> bool leastSquaresEndpoints(const Block& block, const UnsignedInt mask, const Float(&weights)[16], Float(&a)[channels], Float(&b)[channels]) {
+    Float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+    Float ax[channels]{}, bx[channels]{};
+    for(UnsignedInt i = 0; i != 16; ++i) if(mask & (1 << i)) {
+        const Float w = weights[i];
+        const Float v = 1.0f - w;
+        aa += v*v;
+        ab += v*w;
+        bb += w*w;
+        for(UnsignedInt c = 0; c != channels; ++c) {
+            ax[c] += v*block.channels[c][i];
+            bx[c] += w*block.channels[c][i];
+        }
+    }
+
+    const Float determinant = aa*bb - ab*ab;
+    if(determinant < 1.0e-4f) return false;
+
+    for(UnsignedInt c = 0; c != channels; ++c) {
+        a[c] = Math::clamp((bb*ax[c] - ab*bx[c])/determinant, 0.0f, 255.0f);
+        b[c] = Math::clamp((aa*bx[c] - ab*ax[c])/determinant, 0.0f, 255.0f);
+    }
+    return true;
+}
+
+UnsignedShort packRgb565(const Float(&color)[3]) {
+    return UnsignedShort(Int(color[0]*(31.0f/255.0f) + 0.5f) << 11|
+                         Int(color[1]*(63.0f/255.0f) + 0.5f) << 5|
+                         Int(color[2]*(31.0f/255.0f) + 0.5f));
+}
+
+void unpackRgb565(const UnsignedShort color, Short(&out)[4]) {
+    const Int r = color >> 11;
+    const Int g = (color >> 5) & 0x3f;
+    const Int b = color & 0x1f;
+    out[0] = Short(r << 3|r >> 2);
+    out[1] = Short(g << 2|g >> 4);
+    out[2] = Short(b << 3|b >> 2);
+    out[3] = 0;
+}
+
+/* Fraction of color1 in each BC1 palette entry */
+constexpr Float Bc1FourColorWeights[]{0.0f, 1.0f, 1.0f/3.0f, 2.0f/3.0f};
+constexpr Float Bc1ThreeColorWeights[]{0.0f, 1.0f, 0.5f, 0.0f};
+
+/* Compresses RGB of pixels in the mask into a BC1 color block. If threeColor
+   is set, the three-color mode is used and pixels outside of the mask are
+   encoded as transparent black, otherwise the mask is expected to contain
+   all pixels. */
+void compressBc1Color(const Block& block, const UnsignedInt mask, const bool threeColor, char* const out) {
+    /* All pixels transparent, the endpoints are equal and thus in the
+       three-color mode */
+    if(!mask) {
+        writeLittleEndian(out, 0xffffffff00000000ull, 8);
+        return;
+    }
+
+    Float a[3], b[3];
+    principalAxisEndpoints<3>(block, mask, 1.0f/16.0f, a, b);
+
+    UnsignedShort bestColors[2]{};
+    Int bestIndices[16]{};
+    Int bestError = 0x7fffffff;
+    for(UnsignedInt iteration = 0; iteration != 3; ++iteration) {
+        /* The mode is given by endpoint order, color0 > color1 is the
+           four-color mode. Equal endpoints are in the three-color mode,
+           which is fine as the only palette entry used is then the first. */
+        UnsignedShort colors[2]{packRgb565(a), packRgb565(b)};
+        if(threeColor ? colors[0] > colors[1] : colors[0] < colors[1])
+            std::swap(colors[0], colors[1]);
+
+        Short palette[16][4];
+        unpackRgb565(colors[0], palette[0]);
+        unpackRgb565(colors[1], palette[1]);
+        for(UnsignedInt c = 0; c != 3; ++c) {
+            if(threeColor) {
+                palette[2][c] = Short((palette[0][c] + palette[1][c] + 1)/2);
+            } else {
+                palette[2][c] = Short((2*palette[0][c] + palette[1][c] + 1)/3);
+                palette[3][c] = Short((palette[0][c] + 2*palette[1][c] + 1)/3);
+            }
+        }
+
+        Int indices[16], distances[16];
+        nearestPaletteEntries<3>(block, palette, threeColor ? 3 : 4, indices, distances);
+        Int error = 0;
+        for(UnsignedInt i = 0; i != 16; ++i) {
+            if(mask & (1 << i)) error += distances[i];
+            else indices[i] = 3;
+        }
+        if(error < bestError) {
+            bestError = error;
+            bestColors[0] = colors[0];
+            bestColors[1] = colors[1];
+            std::memcpy(bestIndices, indices, sizeof(indices));
+        }
+        if(!error) break;
+
+        /* Refit the endpoints to the chosen palette entries. If there was a
+           swap above, the weights are relative to the swapped endpoints,
+           which is what the fit calculates. */
+        Float weights[16];
+        for(UnsignedInt i = 0; i != 16; ++i)
+            weights[i] = (threeColor ? Bc1ThreeColorWeights : Bc1FourColorWeights)[indices[i]];
+        if(!leastSquaresEndpoints<3>(block, mask, weights, a, b)) break;
+    }
+
+    UnsignedLong data = UnsignedLong(bestColors[0])|UnsignedLong(bestColors[1]) << 16;
+    for(UnsignedInt i = 0; i != 16; ++i)
+        data |= UnsignedLong(bestIndices[i]) << (32 + 2*i);
+    writeLittleEndian(out, data, 8);
+}
+
+/* BC4 block, also used for BC3 alpha and both BC5 channels. Always in the
+   eight-value mode, i.e. with value0 > value1, with the first endpoint being
+   the maximum and the second the minimum. */
+void compressBc4(const Short(&values)[16], char* const out) {
+    Int min = 255, max = 0;
+    for(UnsignedInt i = 0; i != 16; ++i) {
+        min = Math::min(min, Int(values[i]));
+        max = Math::max(max, Int(values[i]));
+    }
+
+    UnsignedLong data = UnsignedLong(max)|UnsignedLong(min) << 8;
+    if(max != min) {
+        const Int range = max - min;
+        for(UnsignedInt i = 0; i != 16; ++i) {
+            /* Position between the minimum and maximum, rounded to one of
+               the eight steps, and then mapped to the palette order, where
+               index 0 is the maximum, 1 the minimum and 2 to 7 the
+               interpolated values going from the maximum down */
+            const Int t = ((values[i] - min)*14 + range)/(2*range);
+            const Int index = t == 7 ? 0 : t == 0 ? 1 : 8 - t;
+            data |= UnsignedLong(index) << (16 + 3*i);
+        }
+    }
+    writeLittleEndian(out, data, 8);
+}
+
+/* BC2 explicit alpha, four bits per pixel */
+void compressBc2Alpha(const Short(&values)[16], char* const out) {
+    UnsignedLong data = 0;
+    for(UnsignedInt i = 0; i != 16; ++i)
+        data |= UnsignedLong((values[i]*15 + 127)/255) << (4*i);
+    writeLittleEndian(out, data, 8);
+}
+
+/* BC7 interpolation weights for 4-bit indices, out of 64 */
+constexpr Int Bc7Weights[]{0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+/* Quantizes a BC7 mode 6 endpoint to 7 bits per channel and a shared
+   p-bit, which is the lowest bit of the final 8-bit value */
+void quantizeBc7Endpoint(const Float(&color)[4], UnsignedInt(&out)[4], UnsignedInt& pBit) {
+    Float bestError = Constants::inf();
+    for(UnsignedInt p = 0; p != 2; ++p) {
+        UnsignedInt quantized[4];
+        Float error = 0.0f;
+        for(UnsignedInt c = 0; c != 4; ++c) {
+            quantized[c] = UnsignedInt(Math::min(Int((color[c] - Float(p))*0.5f + 0.5f), 127));
+            const Float d = Float(quantized[c] << 1|p) - color[c];
+            error += d*d;
+        }
+        if(error < bestError) {
+            bestError = error;
+            pBit = p;
+            for(UnsignedInt c = 0; c != 4; ++c) out[c] = quantized[c];
+        }
+    }
+}
+
+/* BC7 block, always in mode 6, which has a single subset with RGBA
+   endpoints and 4-bit indices */
+void compressBc7(const Block& block, char* const out) {
+    Float a[4], b[4];
+    principalAxisEndpoints<4>(block, 0xffff, 1.0f/64.0f, a, b);
+
+    UnsignedInt bestEndpoints[2][4]{};
+    UnsignedInt bestPBits[2]{};
+    Int bestIndices[16]{};
+    Int bestError = 0x7fffffff;
+    for(UnsignedInt iteration = 0; iteration != 3; ++iteration) {
+        UnsignedInt endpoints[2][4];
+        UnsignedInt pBits[2];
+        quantizeBc7Endpoint(a, endpoints[0], pBits[0]);
+        quantizeBc7Endpoint(b, endpoints[1], pBits[1]);
+
+        Short palette[16][4];
+        for(UnsignedInt j = 0; j != 16; ++j) {
+            for(UnsignedInt c = 0; c != 4; ++c) {
+                const Int e0 = endpoints[0][c] << 1|pBits[0];
+                const Int e1 = endpoints[1][c] << 1|pBits[1];
+                palette[j][c] = Short(((64 - Bc7Weights[j])*e0 + Bc7Weights[j]*e1 + 32) >> 6);
+            }
+        }
+
+        Int indices[16], distances[16];
+        nearestPaletteEntries<4>(block, palette, 16, indices, distances);
+        Int error = 0;
+        for(UnsignedInt i = 0; i != 16; ++i) error += distances[i];
+        if(error < bestError) {
+            bestError = error;
+            std::memcpy(bestEndpoints, endpoints, sizeof(endpoints));
+            std::memcpy(bestPBits, pBits, sizeof(pBits));
+            std::memcpy(bestIndices, indices, sizeof(indices));
+        }
+        if(!error) break;
+
+        Float weights[16];
+        for(UnsignedInt i = 0; i != 16; ++i)
+            weights[i] = Bc7Weights[indices[i]]/64.0f;
+        if(!leastSquaresEndpoints<4>(block, 0xffff, weights, a, b)) break;
+    }
+
+    /* The highest bit of the first index is implicitly zero, if it's set
+       swap the endpoints and invert all indices */
+    if(bestIndices[0] >= 8) {
+        for(UnsignedInt c = 0; c != 4; ++c)
+            std::swap(bestEndpoints[0][c], bestEndpoints[1][c]);
+        std::swap(bestPBits[0], bestPBits[1]);
+        for(Int& index: bestIndices) index = 15 - index;
+    }
+
+    UnsignedByte data[16]{};
+    UnsignedInt offset = 0;
+    writeBits(data, offset, 1 << 6, 7);
+    for(UnsignedInt c = 0; c != 4; ++c) {
+        writeBits(data, offset, bestEndpoints[0][c], 7);
+        writeBits(data, offset, bestEndpoints[1][c], 7);
+    }
+    writeBits(data, offset, bestPBits[0], 1);
+    writeBits(data, offset, bestPBits[1], 1);
+    writeBits(data, offset, bestIndices[0], 3);
+    for(UnsignedInt i = 1; i != 16; ++i)
+        writeBits(data, offset, bestIndices[i], 4);
+    CORRADE_INTERNAL_ASSERT(offset == 128);
+    std::memcpy(out, data, 16);
+}
+
+/* ETC1 / ETC2 intensity modifier tables, the pixel index values 0 to 3 map
+   to a, b, -a and -b */
+constexpr Int EtcModifiers[8][2]{
+    {2, 8}, {5, 17}, {9, 29}, {13, 42},
+    {18, 60}, {24, 80}, {33, 106}, {47, 183}
+};
+
+/* Picks the best modifier table and per-pixel modifiers for an ETC sub-block
+   given by the mask, returning the squared error */
+Int compressEtcSubBlock(const Block& block, const UnsignedInt mask, const Int(&base)[3], UnsignedInt& table, Int(&modifiers)[16]) {
+    Int bestError = 0x7fffffff;
+    for(UnsignedInt t = 0; t != 8; ++t) {
+        Int candidates[4][3];
+        for(UnsignedInt c = 0; c != 3; ++c) {
+            candidates[0][c] = Math::min(base[c] + EtcModifiers[t][0], 255);
+            candidates[1][c] = Math::min(base[c] + EtcModifiers[t][1], 255);
+            candidates[2][c] = Math::max(base[c] - EtcModifiers[t][0], 0);
+            candidates[3][c] = Math::max(base[c] - EtcModifiers[t][1], 0);
+        }
+
+        Int error = 0;
+        Int tableModifiers[16]{};
+        for(UnsignedInt i = 0; i != 16; ++i) if(mask & (1 << i)) {
+            Int best = 0x7fffffff;
+            for(UnsignedInt m = 0; m != 4; ++m) {
+                Int distance = 0;
+                for(UnsignedInt c = 0; c != 3; ++c) {
+                    const Int d = block.channels[c][i] - candidates[m][c];
+                    distance += d*d;
+                }
+                if(distance < best) {
+                    best = distance;
+                    tableModifiers[i] = Int(m);
+                }
+            }
+            error += best;
+        }
+
+        if(error < bestError) {
+            bestError = error;
+            table = t;
+            for(UnsignedInt i = 0; i != 16; ++i)
+                if(mask & (1 << i)) modifiers[i] = tableModifiers[i];
+        }
+    }
+
+    return bestError;
+}
+
+/* ETC2 RGB block using only the individual and differential modes, i.e.
+   what's also a valid ETC1 block. The base colors are averages of the
+   sub-blocks. */
+void compressEtc2RGB(const Block& block, char* const out) {
+    UnsignedLong bestData = 0;
+    Int bestError = 0x7fffffff;
+    for(UnsignedInt flip = 0; flip != 2; ++flip) {
+        /* Without a flip the block is split into left and right 2x4 halves,
+           with a flip into top and bottom 4x2 halves */
+        const UnsignedInt masks[2]{
+            flip ? 0x00ffu : 0x3333u,
+            flip ? 0xff00u : 0xccccu
+        };
+
+        Float averages[2][3]{};
+        for(UnsignedInt half = 0; half != 2; ++half)
+            for(UnsignedInt i = 0; i != 16; ++i) if(masks[half] & (1 << i))
+                for(UnsignedInt c = 0; c != 3; ++c)
+                    averages[half][c] += block.channels[c][i]*0.125f;
+
+        for(UnsignedInt differential = 0; differential != 2; ++differential) {
+            /* 4-bit base colors in the individual mode, 5-bit base colors
+               with the second being a 3-bit signed difference from the first
+               in the differential mode */
+            const Float maxValue = differential ? 31.0f : 15.0f;
+            Int quantized[2][3];
+            Int base[2][3];
+            for(UnsignedInt half = 0; half != 2; ++half) {
+                for(UnsignedInt c = 0; c != 3; ++c) {
+                    quantized[half][c] = Int(averages[half][c]*maxValue/255.0f + 0.5f);
+                    base[half][c] = differential ?
+                        quantized[half][c] << 3|quantized[half][c] >> 2 :
+                        quantized[half][c] << 4|quantized[half][c];
+                }
+            }
+
+            UnsignedLong data = 0;
+            if(differential) {
+                /* If the difference doesn't fit, it's not representable.
+                   ETC2 additionally reinterprets such blocks as the T, H and
+                   planar modes, so it's important to not produce them. */
+                bool fits = true;
+                for(UnsignedInt c = 0; c != 3; ++c) {
+                    const Int difference = quantized[1][c] - quantized[0][c];
+                    if(difference < -4 || difference > 3) fits = false;
+                    data |= UnsignedLong(quantized[0][c]) << (59 - 8*c)|
+                            UnsignedLong(difference & 0x7) << (56 - 8*c);
+                }
+                if(!fits) continue;
+            } else for(UnsignedInt c = 0; c != 3; ++c) {
+                data |= UnsignedLong(quantized[0][c]) << (60 - 8*c)|
+                        UnsignedLong(quantized[1][c]) << (56 - 8*c);
+            }
+
+            UnsignedInt tables[2];
+            Int modifiers[16];
+            const Int error =
+                compressEtcSubBlock(block, masks[0], base[0], tables[0], modifiers) +
+                compressEtcSubBlock(block, masks[1], base[1], tables[1], modifiers);
+            if(error >= bestError) continue;
+
+            data |= UnsignedLong(tables[0]) << 37|
+                    UnsignedLong(tables[1]) << 34|
+                    UnsignedLong(differential) << 33|
+                    UnsignedLong(flip) << 32;
+            /* The pixel indices are in a column-major order, with the low
+               bits of all indices first and the high bits after */
+            for(UnsignedInt i = 0; i != 16; ++i) {
+                const UnsignedInt j = (i % 4)*4 + i/4;
+                data |= UnsignedLong(modifiers[i] & 1) << j|
+                        UnsignedLong(modifiers[i] >> 1) << (16 + j);
+            }
+
+            bestError = error;
+            bestData = data;
+        }
+    }
+
+    writeBigEndian(out, bestData, 8);
+}
+
+UnsignedInt opaqueMask(const Block& block) {
+    UnsignedInt mask = 0;
+    for(UnsignedInt i = 0; i != 16; ++i)
+        if(block.channels[3][i] >= 128) mask |= 1 << i;
+    return mask;
+}
+
+bool isInputFormatSupported(const PixelFormat format) {
+    switch(format) {
+        case PixelFormat::R8Unorm:
+        case PixelFormat::RG8Unorm:
+        case PixelFormat::RGB8Unorm:
+        case PixelFormat::RGBA8Unorm:
+        case PixelFormat::R8Srgb:
+        case PixelFormat::RG8Srgb:
+        case PixelFormat::RGB8Srgb:
+        case PixelFormat::RGBA8Srgb:
+            return true;
+        default:
+            return false;
+    }
+}
+
+}
+
+bool isCompressBlocksFormatSupported(const CompressedPixelFormat format) {
+    switch(format) {
+        case CompressedPixelFormat::Bc1RGBUnorm:
+        case CompressedPixelFormat::Bc1RGBSrgb:
+        case CompressedPixelFormat::Bc1RGBAUnorm:
+        case CompressedPixelFormat::Bc1RGBASrgb:
+        case CompressedPixelFormat::Bc2RGBAUnorm:
+        case CompressedPixelFormat::Bc2RGBASrgb:
+        case CompressedPixelFormat::Bc3RGBAUnorm:
+        case CompressedPixelFormat::Bc3RGBASrgb:
+        case CompressedPixelFormat::Bc4RUnorm:
+        case CompressedPixelFormat::Bc5RGUnorm:
+        case CompressedPixelFormat::Bc7RGBAUnorm:
+        case CompressedPixelFormat::Bc7RGBASrgb:
+        case CompressedPixelFormat::Etc2RGB8Unorm:
+        case CompressedPixelFormat::Etc2RGB8Srgb:
+            return true;
+        default:
+            return false;
+    }
+}
+
+Containers::Optional<CompressedPixelFormat> compressBlocksFormat(const PixelFormat format, const CompressBlocksTargets targets) {
+    CORRADE_ASSERT(isInputFormatSupported(format),
+        "TextureTools::compressBlocksFormat(): expected an 8-bit normalized format, got" << format, {});
+
+    const bool srgb = isPixelFormatSrgb(format);
+    const bool s3tc = !!(targets & (srgb ? CompressBlocksTarget::S3tcSrgb : CompressBlocksTarget::S3tc));
+    const bool rgtc = !srgb && (targets & CompressBlocksTarget::Rgtc);
+    const bool bptc = !!(targets & CompressBlocksTarget::Bptc);
+    const bool etc2 = !!(targets & CompressBlocksTarget::Etc2);
+    const CompressedPixelFormat bc1 = srgb ? CompressedPixelFormat::Bc1RGBSrgb : CompressedPixelFormat::Bc1RGBUnorm;
+    const CompressedPixelFormat bc3 = srgb ? CompressedPixelFormat::Bc3RGBASrgb : CompressedPixelFormat::Bc3RGBAUnorm;
+    const CompressedPixelFormat bc7 = srgb ? CompressedPixelFormat::Bc7RGBASrgb : CompressedPixelFormat::Bc7RGBAUnorm;
+    const CompressedPixelFormat etc2Rgb = srgb ? CompressedPixelFormat::Etc2RGB8Srgb : CompressedPixelFormat::Etc2RGB8Unorm;
+
+    /* Preferring formats that keep all input channels and then the ones with
+       smaller blocks */
+    switch(pixelFormatChannelCount(format)) {
+        case 1:
+            if(rgtc) return CompressedPixelFormat::Bc4RUnorm;
+            if(s3tc) return bc1;
+            if(etc2) return etc2Rgb;
+            if(bptc) return bc7;
+            break;
+        case 2:
+            if(rgtc) return CompressedPixelFormat::Bc5RGUnorm;
+            if(bptc) return bc7;
+            if(s3tc) return bc1;
+            if(etc2) return etc2Rgb;
+            break;
+        case 3:
+            if(s3tc) return bc1;
+            if(etc2) return etc2Rgb;
+            if(bptc) return bc7;
+            break;
+        case 4:
+            if(bptc) return bc7;
+            if(s3tc) return bc3;
+            break;
+        default: CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+    }
+
+    return {};
+}
+
+#ifdef MAGNUM_TARGET_GL
+CompressBlocksTargets compressBlocksTargets(const GL::Context& context) {
+    CompressBlocksTargets targets;
+
+    #ifndef MAGNUM_TARGET_WEBGL
+    if(context.isExtensionSupported<GL::Extensions::EXT::texture_compression_s3tc>()) {
+        targets |= CompressBlocksTarget::S3tc;
+        /* sRGB variants are core since GL 2.1 on desktop, an extension on
+           ES */
+        #ifndef MAGNUM_TARGET_GLES
+        targets |= CompressBlocksTarget::S3tcSrgb;
+        #else
+        if(context.isExtensionSupported<GL::Extensions::EXT::texture_compression_s3tc_srgb>())
+            targets |= CompressBlocksTarget::S3tcSrgb;
+        #endif
+    }
+    #else
+    if(context.isExtensionSupported<GL::Extensions::WEBGL::compressed_texture_s3tc>())
+        targets |= CompressBlocksTarget::S3tc;
+    if(context.isExtensionSupported<GL::Extensions::WEBGL::compressed_texture_s3tc_srgb>())
+        targets |= CompressBlocksTarget::S3tcSrgb;
+    #endif
+
+    #if !defined(MAGNUM_TARGET_GLES2) || defined(MAGNUM_TARGET_WEBGL)
+    if(context.isExtensionSupported<GL::Extensions::EXT::texture_compression_rgtc>())
+        targets |= CompressBlocksTarget::Rgtc;
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(context.isExtensionSupported<GL::Extensions::ARB::texture_compression_bptc>())
+        targets |= CompressBlocksTarget::Bptc;
+    #elif !defined(MAGNUM_TARGET_GLES2) || defined(MAGNUM_TARGET_WEBGL)
+    if(context.isExtensionSupported<GL::Extensions::EXT::texture_compression_bptc>())
+        targets |= CompressBlocksTarget::Bptc;
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(context.isExtensionSupported<GL::Extensions::ARB::ES3_compatibility>())
+        targets |= CompressBlocksTarget::Etc2;
+    #elif defined(MAGNUM_TARGET_WEBGL)
+    if(context.isExtensionSupported<GL::Extensions::WEBGL::compressed_texture_etc>())
+        targets |= CompressBlocksTarget::Etc2;
+    #elif defined(MAGNUM_TARGET_GLES2)
+    if(context.isExtensionSupported<GL::Extensions::ANGLE::compressed_texture_etc>())
+        targets |= CompressBlocksTarget::Etc2;
+    #else
+    /* Core in ES 3.0 */
+    targets |= CompressBlocksTarget::Etc2;
+    #endif
+
+    return targets;
+}
+#endif
+
+void compressBlocksInto(const ImageView2D& image, const Containers::ArrayView<char>& output, const CompressedPixelFormat format, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(isInputFormatSupported(image.format()),
+        "TextureTools::compressBlocksInto(): expected an 8-bit normalized format, got" << image.format(), );
+    CORRADE_ASSERT(isCompressBlocksFormatSupported(format),
+        "TextureTools::compressBlocksInto(): unsupported format" << format, );
+
+    const Vector2i blockCount = (image.size() + Vector2i{3})/4;
+    const std::size_t blockDataSize = compressedPixelFormatBlockDataSize(format);
+    CORRADE_ASSERT(output.size() == std::size_t(blockCount.product())*blockDataSize,
+        "TextureTools::compressBlocksInto(): expected output size to be" << std::size_t(blockCount.product())*blockDataSize << "bytes for" << blockCount << "blocks of" << format << "but got" << output.size(), );
+
+    const Containers::StridedArrayView3D<const char> pixels = image.pixels();
+    const UnsignedInt channelCount = pixelFormatChannelCount(image.format());
+    Implementation::parallelFor(blockCount.product(), threadCount, [&](const std::size_t begin, const std::size_t end) {
+        Block block;
+        for(std::size_t i = begin; i != end; ++i) {
+            fetchBlock(pixels, channelCount, Vector2i{Int(i % blockCount.x()), Int(i/blockCount.x())}*4, block);
+            char* const out = output.data() + i*blockDataSize;
+            /* The encoders OR bits into the block, the output memory can be
+               arbitrary */
+            std::memset(out, 0, blockDataSize);
+            switch(format) {
+                case CompressedPixelFormat::Bc1RGBUnorm:
+                case CompressedPixelFormat::Bc1RGBSrgb:
+                    compressBc1Color(block, 0xffff, false, out);
+                    break;
+                case CompressedPixelFormat::Bc1RGBAUnorm:
+                case CompressedPixelFormat::Bc1RGBASrgb: {
+                    const UnsignedInt mask = opaqueMask(block);
+                    compressBc1Color(block, mask, mask != 0xffff, out);
+                } break;
+                case CompressedPixelFormat::Bc2RGBAUnorm:
+                case CompressedPixelFormat::Bc2RGBASrgb:
+                    compressBc2Alpha(block.channels[3], out);
+                    compressBc1Color(block, 0xffff, false, out + 8);
+                    break;
+                case CompressedPixelFormat::Bc3RGBAUnorm:
+                case CompressedPixelFormat::Bc3RGBASrgb:
+                    compressBc4(block.channels[3], out);
+                    compressBc1Color(block, 0xffff, false, out + 8);
+                    break;
+                case CompressedPixelFormat::Bc4RUnorm:
+                    compressBc4(block.channels[0], out);
+                    break;
+                case CompressedPixelFormat::Bc5RGUnorm:
+                    compressBc4(block.channels[0], out);
+                    compressBc4(block.channels[1], out + 8);
+                    break;
+                case CompressedPixelFormat::Bc7RGBAUnorm:
+                case CompressedPixelFormat::Bc7RGBASrgb:
+                    compressBc7(block, out);
+                    break;
+                case CompressedPixelFormat::Etc2RGB8Unorm:
+                case CompressedPixelFormat::Etc2RGB8Srgb:
+                    compressEtc2RGB(block, out);
+                    break;
+                default: CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+            }
+        }
+    });
+}
+
+CompressedImage2D compressBlocks(const ImageView2D& image, const CompressedPixelFormat format, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(isInputFormatSupported(image.format()),
+        "TextureTools::compressBlocks(): expected an 8-bit normalized format, got" << image.format(), (CompressedImage2D{}));
+    CORRADE_ASSERT(isCompressBlocksFormatSupported(format),
+        "TextureTools::compressBlocks(): unsupported format" << format, (CompressedImage2D{}));
+
+    const Vector2i blockCount = (image.size() + Vector2i{3})/4;
+    Containers::Array<char> data{NoInit, std::size_t(blockCount.product())*compressedPixelFormatBlockDataSize(format)};
+    compressBlocksInto(image, data, format, threadCount);
+    return CompressedImage2D{format, image.size(), std::move(data)};
+}
+
+Debug& operator<<(Debug& debug, const CompressBlocksTarget value) {
+    debug << "TextureTools::CompressBlocksTarget" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(v) case CompressBlocksTarget::v: return debug << "::" #v;
+        _c(S3tc)
+        _c(S3tcSrgb)
+        _c(Rgtc)
+        _c(Bptc)
+        _c(Etc2)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+Debug& operator<<(Debug& debug, const CompressBlocksTargets value) {
+    return Containers::enumSetDebugOutput(debug, value, "TextureTools::CompressBlocksTargets{}", {
+        CompressBlocksTarget::S3tc,
+        CompressBlocksTarget::S3tcSrgb,
+        CompressBlocksTarget::Rgtc,
+        CompressBlocksTarget::Bptc,
+        CompressBlocksTarget::Etc2});
+}
+
+}}
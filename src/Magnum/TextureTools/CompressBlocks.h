@@ -0,0 +1,286 @@
+#ifndef Magnum_TextureTools_CompressBlocks_h
+#define Magnum_TextureTools_CompressBlocks_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::TextureTools::compressBlocks(), @ref Magnum::TextureTools::compressBlocksInto(), @ref Magnum::TextureTools::isCompressBlocksFormatSupported(), @ref Magnum::TextureTools::compressBlocksFormat(), @ref Magnum::TextureTools::compressBlocksTargets(), enum @ref Magnum::TextureTools::CompressBlocksTarget, enum set @ref Magnum::TextureTools::CompressBlocksTargets
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/EnumSet.h>
+#include <Corrade/Containers/Optional.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/TextureTools/visibility.h"
+
+#ifdef MAGNUM_TARGET_GL
+#include "Magnum/GL/GL.h"
+#endif
+
+namespace Magnum { namespace TextureTools {
+
+/**
+@brief Block compression target format family
+@m_since_latest
+
+Describes which families of formats produced by @ref compressBlocks() can be
+consumed by a particular GPU. Used by @ref compressBlocksFormat() to pick the
+best output format for given input.
+@see @ref CompressBlocksTargets, @ref compressBlocksTargets()
+*/
+enum class CompressBlocksTarget: UnsignedByte {
+    /**
+     * S3TC formats, i.e. @ref CompressedPixelFormat::Bc1RGBUnorm,
+     * @relativeref{CompressedPixelFormat,Bc1RGBAUnorm},
+     * @relativeref{CompressedPixelFormat,Bc2RGBAUnorm} and
+     * @relativeref{CompressedPixelFormat,Bc3RGBAUnorm}
+     */
+    S3tc = 1 << 0,
+
+    /**
+     * sRGB variants of the S3TC formats, i.e.
+     * @ref CompressedPixelFormat::Bc1RGBSrgb,
+     * @relativeref{CompressedPixelFormat,Bc1RGBASrgb},
+     * @relativeref{CompressedPixelFormat,Bc2RGBASrgb} and
+     * @relativeref{CompressedPixelFormat,Bc3RGBASrgb}
+     */
+    S3tcSrgb = 1 << 1,
+
+    /**
+     * RGTC formats, i.e. @ref CompressedPixelFormat::Bc4RUnorm and
+     * @relativeref{CompressedPixelFormat,Bc5RGUnorm}
+     */
+    Rgtc = 1 << 2,
+
+    /**
+     * BPTC formats, i.e. @ref CompressedPixelFormat::Bc7RGBAUnorm and
+     * @relativeref{CompressedPixelFormat,Bc7RGBASrgb}
+     */
+    Bptc = 1 << 3,
+
+    /**
+     * ETC2 formats, i.e. @ref CompressedPixelFormat::Etc2RGB8Unorm and
+     * @relativeref{CompressedPixelFormat,Etc2RGB8Srgb}
+     */
+    Etc2 = 1 << 4
+};
+
+/**
+@brief Block compression target format families
+@m_since_latest
+
+@see @ref compressBlocksFormat(), @ref compressBlocksTargets()
+*/
+typedef Containers::EnumSet<CompressBlocksTarget> CompressBlocksTargets;
+
+CORRADE_ENUMSET_OPERATORS(CompressBlocksTargets)
+
+/**
+@debugoperatorenum{CompressBlocksTarget}
+@m_since_latest
+*/
+MAGNUM_TEXTURETOOLS_EXPORT Debug& operator<<(Debug& debug, CompressBlocksTarget value);
+
+/**
+@debugoperatorenum{CompressBlocksTargets}
+@m_since_latest
+*/
+MAGNUM_TEXTURETOOLS_EXPORT Debug& operator<<(Debug& debug, CompressBlocksTargets value);
+
+/**
+@brief Whether given format is supported by @ref compressBlocks()
+@m_since_latest
+
+Returns @cpp true @ce for the following formats, @cpp false @ce otherwise:
+
+-   @ref CompressedPixelFormat::Bc1RGBUnorm,
+    @relativeref{CompressedPixelFormat,Bc1RGBSrgb},
+    @relativeref{CompressedPixelFormat,Bc1RGBAUnorm} and
+    @relativeref{CompressedPixelFormat,Bc1RGBASrgb}
+-   @ref CompressedPixelFormat::Bc2RGBAUnorm and
+    @relativeref{CompressedPixelFormat,Bc2RGBASrgb}
+-   @ref CompressedPixelFormat::Bc3RGBAUnorm and
+    @relativeref{CompressedPixelFormat,Bc3RGBASrgb}
+-   @ref CompressedPixelFormat::Bc4RUnorm
+-   @ref CompressedPixelFormat::Bc5RGUnorm
+-   @ref CompressedPixelFormat::Bc7RGBAUnorm and
+    @relativeref{CompressedPixelFormat,Bc7RGBASrgb}
+-   @ref CompressedPixelFormat::Etc2RGB8Unorm and
+    @relativeref{CompressedPixelFormat,Etc2RGB8Srgb}
+*/
+MAGNUM_TEXTURETOOLS_EXPORT bool isCompressBlocksFormatSupported(CompressedPixelFormat format);
+
+/**
+@brief Pick the best block-compressed format for given input and targets
+@m_since_latest
+
+Expects that @p format is one of the input formats accepted by
+@ref compressBlocks(). Returns the format that preserves the most of the input
+channels while taking the least memory among the formats allowed by
+@p targets, or @ref Containers::NullOpt if none of @p targets can represent
+given input. The preference order is the following, sRGB inputs get the
+corresponding sRGB output formats and skip RGTC, which has no sRGB variant:
+
+-   @ref PixelFormat::R8Unorm picks
+    @ref CompressedPixelFormat::Bc4RUnorm,
+    @relativeref{CompressedPixelFormat,Bc1RGBUnorm},
+    @relativeref{CompressedPixelFormat,Etc2RGB8Unorm} or
+    @relativeref{CompressedPixelFormat,Bc7RGBAUnorm}
+-   @ref PixelFormat::RG8Unorm picks
+    @ref CompressedPixelFormat::Bc5RGUnorm,
+    @relativeref{CompressedPixelFormat,Bc7RGBAUnorm},
+    @relativeref{CompressedPixelFormat,Bc1RGBUnorm} or
+    @relativeref{CompressedPixelFormat,Etc2RGB8Unorm}
+-   @ref PixelFormat::RGB8Unorm picks
+    @ref CompressedPixelFormat::Bc1RGBUnorm,
+    @relativeref{CompressedPixelFormat,Etc2RGB8Unorm} or
+    @relativeref{CompressedPixelFormat,Bc7RGBAUnorm}
+-   @ref PixelFormat::RGBA8Unorm picks
+    @ref CompressedPixelFormat::Bc7RGBAUnorm or
+    @relativeref{CompressedPixelFormat,Bc3RGBAUnorm}
+
+Together with @ref compressBlocksTargets() this makes it possible to ship a
+single set of uncompressed assets and encode them at runtime into whatever the
+GPU supports:
+
+@snippet MagnumTextureTools.cpp compressBlocksFormat
+*/
+MAGNUM_TEXTURETOOLS_EXPORT Containers::Optional<CompressedPixelFormat> compressBlocksFormat(PixelFormat format, CompressBlocksTargets targets);
+
+#if defined(MAGNUM_TARGET_GL) || defined(DOXYGEN_GENERATING_OUTPUT)
+/**
+@brief Block compression target format families supported by a GL context
+@m_since_latest
+
+Checks the following extensions, or the core version containing them:
+
+-   @ref CompressBlocksTarget::S3tc with
+    @gl_extension{EXT,texture_compression_s3tc} on desktop and ES,
+    @webgl_extension{WEBGL,compressed_texture_s3tc} on WebGL
+-   @ref CompressBlocksTarget::S3tcSrgb with
+    @gl_extension{EXT,texture_compression_s3tc} on desktop, where the sRGB
+    variants are core since OpenGL 2.1,
+    @gl_extension{EXT,texture_compression_s3tc_srgb} on ES and
+    @webgl_extension{WEBGL,compressed_texture_s3tc_srgb} on WebGL
+-   @ref CompressBlocksTarget::Rgtc with
+    @gl_extension{EXT,texture_compression_rgtc}
+-   @ref CompressBlocksTarget::Bptc with
+    @gl_extension{ARB,texture_compression_bptc} on desktop,
+    @gl_extension{EXT,texture_compression_bptc} on ES and WebGL
+-   @ref CompressBlocksTarget::Etc2 with
+    @gl_extension{ARB,ES3_compatibility} on desktop, always on OpenGL ES 3.0,
+    @gl_extension{ANGLE,compressed_texture_etc} on OpenGL ES 2.0 and
+    @webgl_extension{WEBGL,compressed_texture_etc} on WebGL
+
+There's no Vulkan equivalent of this function as the library doesn't depend
+on the @ref Vk library, but the mapping is straightforward ---
+@ref Vk::DeviceFeature::TextureCompressionBc implies
+@ref CompressBlocksTarget::S3tc, @relativeref{CompressBlocksTarget,S3tcSrgb},
+@relativeref{CompressBlocksTarget,Rgtc} and
+@relativeref{CompressBlocksTarget,Bptc}, while
+@ref Vk::DeviceFeature::TextureCompressionEtc2 implies
+@ref CompressBlocksTarget::Etc2.
+@note This function is available only if Magnum is compiled with
+    @ref MAGNUM_TARGET_GL enabled (done by default). See
+    @ref building-features for more information.
+@see @ref compressBlocksFormat()
+*/
+MAGNUM_TEXTURETOOLS_EXPORT CompressBlocksTargets compressBlocksTargets(const GL::Context& context);
+#endif
+
+/**
+@brief Compress an image into a block-compressed format on the CPU
+@param image        Input image
+@param format       Output format
+@param threadCount  Max count of threads to use. If @cpp 0 @ce,
+    @ref TaskScheduler::threadCount() of @ref TaskScheduler::global() is used.
+@m_since_latest
+
+Expects that @p image is one of @ref PixelFormat::R8Unorm,
+@relativeref{PixelFormat,RG8Unorm}, @relativeref{PixelFormat,RGB8Unorm},
+@relativeref{PixelFormat,RGBA8Unorm} or their sRGB variants and that @p format
+is supported according to @ref isCompressBlocksFormatSupported(). Channels
+missing in the input are treated as @cpp 0 @ce, except for alpha, which is
+treated as @cpp 255 @ce. No sRGB conversion is done, the values are stored
+as-is and it's up to the caller to pick an sRGB output format for sRGB input.
+If the image size isn't a multiple of the block size, the edge pixels are
+repeated to fill the partial blocks.
+
+The encoders aim for speed over the best possible quality, comparable to the
+"fast" presets of dedicated compression tools:
+
+-   BC1, BC2 and BC3 color endpoints are picked along the principal axis of
+    the block colors and then refined with a least-squares fit. Pixels with
+    alpha below @cpp 128 @ce make @ref CompressedPixelFormat::Bc1RGBAUnorm
+    use the three-color mode with transparent black.
+-   BC4, BC5 and BC3 alpha blocks use the minimum and maximum value as
+    endpoints with the eight-value interpolation.
+-   BC7 always uses the single-subset mode 6 with RGBA endpoints and 4-bit
+    indices.
+-   ETC2 uses only the individual and differential modes that are shared with
+    ETC1, picking the better of them and of both sub-block orientations.
+
+The blocks are distributed over up to @p threadCount threads. Nearest palette
+entry search for BC1, BC2, BC3 and BC7 uses SSE2 or NEON if available. If
+Corrade isn't built with @ref CORRADE_BUILD_MULTITHREADED or on Emscripten,
+everything is done on the calling thread.
+
+The output is tightly packed with default @ref CompressedPixelStorage and can
+be passed for example directly to
+@ref GL::Texture::setCompressedImage() or saved to a file with a converter
+supporting compressed images:
+
+@snippet MagnumTextureTools.cpp compressBlocks
+
+@see @ref compressedPixelFormatBlockSize(),
+    @ref compressedPixelFormatBlockDataSize(), @ref compressBlocksInto(),
+    @ref compressBlocksFormat()
+*/
+MAGNUM_TEXTURETOOLS_EXPORT CompressedImage2D compressBlocks(const ImageView2D& image, CompressedPixelFormat format, UnsignedInt threadCount = 0);
+
+/**
+@brief Compress an image into a block-compressed format into existing memory
+@param image        Input image
+@param output       Output memory
+@param format       Output format
+@param threadCount  Max count of threads to use. If @cpp 0 @ce,
+    @ref TaskScheduler::threadCount() of @ref TaskScheduler::global() is used.
+@m_since_latest
+
+Same as @ref compressBlocks(), but writes the blocks into @p output instead of
+allocating a new image, which makes it possible to encode directly into
+mapped GPU upload memory without an intermediate copy. Expects that the
+@p output size is exactly the count of blocks covering @p image multiplied by
+@ref compressedPixelFormatBlockDataSize(). The blocks are tightly packed
+row after row, matching default @ref CompressedPixelStorage:
+
+@snippet MagnumTextureTools.cpp compressBlocksInto
+*/
+MAGNUM_TEXTURETOOLS_EXPORT void compressBlocksInto(const ImageView2D& image, const Containers::ArrayView<char>& output, CompressedPixelFormat format, UnsignedInt threadCount = 0);
+
+}}
+
+#endif
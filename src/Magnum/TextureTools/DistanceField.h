@@ -79,7 +79,8 @@ and Special Effects, SIGGRAPH 2007,
 http://www.valvesoftware.com/publications/2007/SIGGRAPH2007_AlphaTestedMagnification.pdf*
 
 @attention This is a GPU-only implementation, so it expects an active GL
-    context.
+    context. See @ref distanceFieldInto() for a CPU implementation producing
+    the same output.
 
 @note If internal format of @p output texture is not renderable, this function
     prints a message to error output and does nothing. On desktop OpenGL and
@@ -0,0 +1,188 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "DistanceFieldCpu.h"
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Packing.h"
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/Implementation/parallelFor.h"
+
+namespace Magnum { namespace TextureTools {
+
+namespace {
+
+/* One-dimensional squared Euclidean distance transform of a sampled function
+   from Felzenszwalb and Huttenlocher, Distance Transforms of Sampled
+   Functions, 2012. The `vertices` and `boundaries` are scratch memory of
+   f.size() and f.size() + 1 elements. */
+void distanceTransform(const Containers::ArrayView<const Int> f, const Containers::ArrayView<Int> out, const Containers::ArrayView<Int> vertices, const Containers::ArrayView<Double> boundaries) {
+    /* Calculate the lower envelope of parabolas rooted at each f */
+    std::size_t k = 0;
+    vertices[0] = 0;
+    boundaries[0] = -Constantsd::inf();
+    boundaries[1] = Constantsd::inf();
+    for(Int q = 1; q != Int(f.size()); ++q) {
+        Double s;
+        for(;;) {
+            const Int v = vertices[k];
+            s = (Double(f[q]) + Double(q)*q - Double(f[v]) - Double(v)*v)/(2.0*(q - v));
+            if(s > boundaries[k]) break;
+            --k;
+        }
+
+        ++k;
+        vertices[k] = q;
+        boundaries[k] = s;
+        boundaries[k + 1] = Constantsd::inf();
+    }
+
+    /* Fill in the values of the envelope */
+    k = 0;
+    for(Int q = 0; q != Int(f.size()); ++q) {
+        while(boundaries[k + 1] < q) ++k;
+        const Int v = vertices[k];
+        out[q] = (q - v)*(q - v) + f[v];
+    }
+}
+
+}
+
+void distanceFieldInto(const ImageView2D& input, const MutableImageView2D& output, const UnsignedInt radius, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(input.format() == PixelFormat::R8Unorm ||
+                   input.format() == PixelFormat::RG8Unorm ||
+                   input.format() == PixelFormat::RGB8Unorm ||
+                   input.format() == PixelFormat::RGBA8Unorm,
+        "TextureTools::distanceFieldInto(): unsupported input format" << input.format(), );
+    CORRADE_ASSERT(output.format() == PixelFormat::R8Unorm ||
+                   output.format() == PixelFormat::R32F,
+        "TextureTools::distanceFieldInto(): unsupported output format" << output.format(), );
+    CORRADE_ASSERT((output.size() <= input.size()).all(),
+        "TextureTools::distanceFieldInto(): expected output size to not be larger than" << Debug::packed << input.size() << "but got" << Debug::packed << output.size(), );
+
+    const Vector2i inputSize = input.size();
+    const Vector2i outputSize = output.size();
+    if(!outputSize.product()) return;
+
+    /* Distances larger than radius + 1 are all treated the same, so clamping
+       them early keeps all values small */
+    const Int maxDistance = Int(radius + 1);
+    const Int maxDistanceSquared = maxDistance*maxDistance;
+
+    /* Input pixel coordinates corresponding to output pixels, the same as
+       what the shader does */
+    Containers::Array<Int> columns{NoInit, std::size_t(outputSize.x())};
+    for(Int x = 0; x != outputSize.x(); ++x)
+        columns[x] = Int((Long(x)*inputSize.x())/outputSize.x());
+    Containers::Array<Int> rows{NoInit, std::size_t(outputSize.y())};
+    for(Int y = 0; y != outputSize.y(); ++y)
+        rows[y] = Int((Long(y)*inputSize.y())/outputSize.y());
+
+    /* Only the red channel is used */
+    const Containers::StridedArrayView3D<const char> pixels = input.pixels();
+    const auto isInside = [&pixels](const Int x, const Int y) {
+        return UnsignedByte(pixels[y][x][0]) >= 128;
+    };
+
+    /* For each input row calculate the squared horizontal distance to the
+       nearest inside and outside pixel, but store it only for the sampled
+       columns. The result is transposed so the column pass below operates on
+       contiguous memory. */
+    Containers::Array<Int> distancesToInside{NoInit, std::size_t(outputSize.x()*inputSize.y())};
+    Containers::Array<Int> distancesToOutside{NoInit, std::size_t(outputSize.x()*inputSize.y())};
+    Implementation::parallelFor(std::size_t(inputSize.y()), threadCount, [&](const std::size_t begin, const std::size_t end) {
+        Containers::Array<Int> toInside{NoInit, std::size_t(inputSize.x())};
+        Containers::Array<Int> toOutside{NoInit, std::size_t(inputSize.x())};
+        for(Int y = Int(begin); y != Int(end); ++y) {
+            /* Going forward finds the nearest pixels on the left, going
+               backward then the nearest pixels on the right */
+            Int lastInside = -maxDistance, lastOutside = -maxDistance;
+            for(Int x = 0; x != inputSize.x(); ++x) {
+                (isInside(x, y) ? lastInside : lastOutside) = x;
+                toInside[x] = x - lastInside;
+                toOutside[x] = x - lastOutside;
+            }
+            lastInside = lastOutside = inputSize.x() + maxDistance;
+            for(Int x = inputSize.x() - 1; x >= 0; --x) {
+                (isInside(x, y) ? lastInside : lastOutside) = x;
+                toInside[x] = Math::min(toInside[x], lastInside - x);
+                toOutside[x] = Math::min(toOutside[x], lastOutside - x);
+            }
+
+            for(Int x = 0; x != outputSize.x(); ++x) {
+                const std::size_t i = std::size_t(x)*inputSize.y() + y;
+                const Int distanceToInside = Math::min(toInside[columns[x]], maxDistance);
+                const Int distanceToOutside = Math::min(toOutside[columns[x]], maxDistance);
+                distancesToInside[i] = distanceToInside*distanceToInside;
+                distancesToOutside[i] = distanceToOutside*distanceToOutside;
+            }
+        }
+    });
+
+    /* For each sampled column calculate the full 2D distance, evaluate it for
+       the sampled rows and convert it to the output value */
+    const bool outputFloat = output.format() == PixelFormat::R32F;
+    Containers::StridedArrayView2D<UnsignedByte> outputUnorm;
+    Containers::StridedArrayView2D<Float> outputFloatPixels;
+    if(outputFloat)
+        outputFloatPixels = output.pixels<Float>();
+    else
+        outputUnorm = output.pixels<UnsignedByte>();
+    Implementation::parallelFor(std::size_t(outputSize.x()), threadCount, [&](const std::size_t begin, const std::size_t end) {
+        Containers::Array<Int> toInside{NoInit, std::size_t(inputSize.y())};
+        Containers::Array<Int> toOutside{NoInit, std::size_t(inputSize.y())};
+        Containers::Array<Int> vertices{NoInit, std::size_t(inputSize.y())};
+        Containers::Array<Double> boundaries{NoInit, std::size_t(inputSize.y() + 1)};
+        for(Int x = Int(begin); x != Int(end); ++x) {
+            const std::size_t offset = std::size_t(x)*inputSize.y();
+            distanceTransform(distancesToInside.slice(offset, offset + inputSize.y()), toInside, vertices, boundaries);
+            distanceTransform(distancesToOutside.slice(offset, offset + inputSize.y()), toOutside, vertices, boundaries);
+
+            for(Int y = 0; y != outputSize.y(); ++y) {
+                /* Signed distance normalized from [-radius-1, radius+1] to
+                   [0, 1]. If the pixel is inside, we want the distance to the
+                   nearest pixel outside and the value is above 0.5, and vice
+                   versa. */
+                const Int row = rows[y];
+                const bool inside = isInside(columns[x], row);
+                const Float distance = Math::sqrt(Float(Math::min(inside ? toOutside[row] : toInside[row], maxDistanceSquared)));
+                const Float value = (inside ? 0.5f : -0.5f)*distance/Float(radius + 1) + 0.5f;
+
+                if(outputFloat)
+                    outputFloatPixels[y][x] = value;
+                else
+                    outputUnorm[y][x] = Math::pack<UnsignedByte>(value);
+            }
+        }
+    });
+}
+
+}}
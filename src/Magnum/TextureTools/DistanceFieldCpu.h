@@ -0,0 +1,81 @@
+#ifndef Magnum_TextureTools_DistanceFieldCpu_h
+#define Magnum_TextureTools_DistanceFieldCpu_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::TextureTools::distanceFieldInto()
+ * @m_since_latest
+ */
+
+#include "Magnum/Magnum.h"
+#include "Magnum/TextureTools/visibility.h"
+
+namespace Magnum { namespace TextureTools {
+
+/**
+@brief Create a signed distance field on the CPU
+@param input        Input image
+@param output       Output image
+@param radius       Max lookup radius in the input image
+@param threadCount  Max count of threads to use. If @cpp 0 @ce,
+    @ref TaskScheduler::threadCount() of @ref TaskScheduler::global() is used.
+@m_since_latest
+
+A CPU counterpart to @ref DistanceField, producing the same output without
+requiring a GL context, which makes it usable for example for generating
+distance field fonts or icons on headless machines. See
+@ref TextureTools-DistanceField-algorithm for details about the output.
+
+The red channel of @p input is treated as a binary image, with values of
+@cpp 128 @ce and above being inside. The @p output is sampled from the input
+at the same positions as @ref DistanceField does, i.e. the output pixel
+@f$ (x, y) @f$ corresponds to input pixel
+@f$ \left( \left\lfloor x \frac{w_i}{w_o} \right\rfloor, \left\lfloor y \frac{h_i}{h_o} \right\rfloor \right) @f$.
+Pixels outside of the input image are not considered when searching for the
+nearest pixel of opposite color.
+
+Instead of a brute-force search around each pixel the distances are
+calculated with an exact separable Euclidean distance transform in linear time
+independently of @p radius --- first for each input row, sampled at the output
+columns, and then for each output column. The rows and columns are distributed
+over up to @p threadCount threads. If Corrade isn't built with
+@ref CORRADE_BUILD_MULTITHREADED or on Emscripten, everything is done on the
+calling thread.
+
+Expects that @p input is @ref PixelFormat::R8Unorm,
+@relativeref{PixelFormat,RG8Unorm}, @relativeref{PixelFormat,RGB8Unorm} or
+@relativeref{PixelFormat,RGBA8Unorm}, @p output is
+@ref PixelFormat::R8Unorm or @relativeref{PixelFormat,R32F} and its size is
+not larger than the size of @p input. The resulting image can be for example
+passed to @ref Text::DistanceFieldGlyphCache::setDistanceFieldImage().
+
+@snippet MagnumTextureTools.cpp distanceFieldInto
+*/
+MAGNUM_TEXTURETOOLS_EXPORT void distanceFieldInto(const ImageView2D& input, const MutableImageView2D& output, UnsignedInt radius, UnsignedInt threadCount = 0);
+
+}}
+
+#endif
@@ -0,0 +1,392 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Downsample.h"
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Packing.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Implementation/parallelFor.h"
+
+namespace Magnum { namespace TextureTools {
+
+Debug& operator<<(Debug& debug, const DownsampleFilter value) {
+    debug << "TextureTools::DownsampleFilter" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case DownsampleFilter::value: return debug << "::" #value;
+        _c(Box)
+        _c(Kaiser)
+        _c(Lanczos)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+namespace {
+
+Float sinc(const Float x) {
+    if(x == 0.0f) return 1.0f;
+    const Float px = Constants::pi()*x;
+    return std::sin(px)/px;
+}
+
+/* Zeroth-order modified Bessel function of the first kind, used by the Kaiser
+   window. The series converges quickly for the small arguments used here. */
+Float besselI0(const Float x) {
+    Float sum = 1.0f, term = 1.0f;
+    const Float halfXSquared = x*x*0.25f;
+    for(Int k = 1; k != 32 && term > sum*1.0e-8f; ++k) {
+        term *= halfXSquared/Float(k*k);
+        sum += term;
+    }
+    return sum;
+}
+
+/* Filter radius in output pixels */
+Float filterRadius(const DownsampleFilter filter) {
+    return filter == DownsampleFilter::Box ? 0.5f : 3.0f;
+}
+
+Float filterWeight(const DownsampleFilter filter, const Float x) {
+    switch(filter) {
+        case DownsampleFilter::Box:
+            /* Half-open so a pixel exactly at the boundary of two output
+               pixels isn't counted twice */
+            return x > -0.5f && x <= 0.5f ? 1.0f : 0.0f;
+        case DownsampleFilter::Kaiser: {
+            constexpr Float Alpha = 4.0f;
+            const Float t = x/3.0f;
+            if(t*t >= 1.0f) return 0.0f;
+            return sinc(x)*besselI0(Alpha*std::sqrt(1.0f - t*t))/besselI0(Alpha);
+        }
+        case DownsampleFilter::Lanczos:
+            if(x <= -3.0f || x >= 3.0f) return 0.0f;
+            return sinc(x)*sinc(x/3.0f);
+    }
+
+    CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+/* Input pixel indices and normalized weights contributing to each output
+   pixel along one axis. Taps for output pixel i are in the
+   [offsets[i], offsets[i + 1]) range of indices and weights. */
+struct Taps {
+    Containers::Array<UnsignedInt> offsets;
+    Containers::Array<Int> indices;
+    Containers::Array<Float> weights;
+};
+
+Taps calculateTaps(const DownsampleFilter filter, const Int inputSize, const Int outputSize) {
+    Taps taps;
+    arrayAppend(taps.offsets, 0u);
+
+    /* Stretch the filter to cover the input pixels that map to a single
+       output pixel */
+    const Float scale = Float(inputSize)/Float(outputSize);
+    const Float radius = filterRadius(filter)*scale;
+    for(Int i = 0; i != outputSize; ++i) {
+        const Float center = (Float(i) + 0.5f)*scale;
+        const Int begin = Int(std::floor(center - radius));
+        const Int end = Int(std::ceil(center + radius));
+
+        Float sum = 0.0f;
+        const std::size_t first = taps.weights.size();
+        for(Int j = begin; j != end; ++j) {
+            const Float weight = filterWeight(filter, (Float(j) + 0.5f - center)/scale);
+            if(weight == 0.0f) continue;
+
+            /* Clamp to edge */
+            arrayAppend(taps.indices, Math::clamp(j, 0, inputSize - 1));
+            arrayAppend(taps.weights, weight);
+            sum += weight;
+        }
+
+        for(std::size_t j = first; j != taps.weights.size(); ++j)
+            taps.weights[j] /= sum;
+        arrayAppend(taps.offsets, UnsignedInt(taps.weights.size()));
+    }
+
+    return taps;
+}
+
+/* Filters `input` laid out as [outer][inputSize][inner] along the middle
+   dimension into `output` laid out as [outer][outputSize][inner]. The
+   innermost loop goes over contiguous memory with no dependencies between
+   iterations, so the compiler can vectorize it. */
+void filterAxis(const Taps& taps, const std::size_t outer, const std::size_t inputSize, const std::size_t inner, const Containers::ArrayView<const Float> input, const Containers::ArrayView<Float> output, const UnsignedInt threadCount) {
+    const std::size_t outputSize = taps.offsets.size() - 1;
+    Implementation::parallelFor(outer*outputSize, threadCount, [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t item = begin; item != end; ++item) {
+            const std::size_t o = item/outputSize;
+            const std::size_t i = item%outputSize;
+            Float* const out = output.data() + item*inner;
+            for(std::size_t e = 0; e != inner; ++e) out[e] = 0.0f;
+
+            for(UnsignedInt t = taps.offsets[i]; t != taps.offsets[i + 1]; ++t) {
+                const Float* const in = input.data() + (o*inputSize + taps.indices[t])*inner;
+                const Float weight = taps.weights[t];
+                for(std::size_t e = 0; e != inner; ++e)
+                    out[e] += weight*in[e];
+            }
+        }
+    });
+}
+
+Float srgbToLinear(const Float value) {
+    return value <= 0.04045f ? value/12.92f : std::pow((value + 0.055f)/1.055f, 2.4f);
+}
+
+Float linearToSrgb(const Float value) {
+    return value <= 0.0031308f ? value*12.92f : 1.055f*std::pow(value, 1.0f/2.4f) - 0.055f;
+}
+
+bool isFormatSupported(const PixelFormat format) {
+    if(isPixelFormatImplementationSpecific(format) || isPixelFormatDepthOrStencil(format))
+        return false;
+
+    const PixelFormat channelFormat = pixelFormatChannelFormat(format);
+    return channelFormat == PixelFormat::R8Unorm ||
+           channelFormat == PixelFormat::R8Srgb ||
+           channelFormat == PixelFormat::R16Unorm ||
+           channelFormat == PixelFormat::R16F ||
+           channelFormat == PixelFormat::R32F;
+}
+
+/* Converts a row of `width` pixels to floats with the color channels in
+   linear space */
+void decodeRow(const PixelFormat channelFormat, const UnsignedInt channelCount, const char* const in, Float* const out, const std::size_t width) {
+    const std::size_t count = width*channelCount;
+    switch(channelFormat) {
+        case PixelFormat::R8Unorm: {
+            const UnsignedByte* const data = reinterpret_cast<const UnsignedByte*>(in);
+            for(std::size_t i = 0; i != count; ++i)
+                out[i] = Math::unpack<Float>(data[i]);
+        } return;
+        case PixelFormat::R8Srgb: {
+            /* Only 256 possible inputs, so it's cheaper to calculate all of
+               them once than to call pow() for every pixel */
+            static const Containers::Array<Float> srgbTable = []{
+                Containers::Array<Float> table{NoInit, 256};
+                for(std::size_t i = 0; i != 256; ++i)
+                    table[i] = srgbToLinear(Math::unpack<Float>(UnsignedByte(i)));
+                return table;
+            }();
+            const UnsignedByte* const data = reinterpret_cast<const UnsignedByte*>(in);
+            for(std::size_t i = 0; i != count; ++i)
+                out[i] = i % channelCount == 3 ?
+                    Math::unpack<Float>(data[i]) : srgbTable[data[i]];
+        } return;
+        case PixelFormat::R16Unorm: {
+            const UnsignedShort* const data = reinterpret_cast<const UnsignedShort*>(in);
+            for(std::size_t i = 0; i != count; ++i)
+                out[i] = Math::unpack<Float>(data[i]);
+        } return;
+        case PixelFormat::R16F: {
+            const UnsignedShort* const data = reinterpret_cast<const UnsignedShort*>(in);
+            for(std::size_t i = 0; i != count; ++i)
+                out[i] = Math::unpackHalf(data[i]);
+        } return;
+        case PixelFormat::R32F: {
+            const Float* const data = reinterpret_cast<const Float*>(in);
+            for(std::size_t i = 0; i != count; ++i)
+                out[i] = data[i];
+        } return;
+        default: CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+    }
+}
+
+/* Inverse of decodeRow() */
+void encodeRow(const PixelFormat channelFormat, const UnsignedInt channelCount, const Float* const in, char* const out, const std::size_t width) {
+    const std::size_t count = width*channelCount;
+    switch(channelFormat) {
+        case PixelFormat::R8Unorm: {
+            UnsignedByte* const data = reinterpret_cast<UnsignedByte*>(out);
+            for(std::size_t i = 0; i != count; ++i)
+                data[i] = Math::pack<UnsignedByte>(Math::clamp(in[i], 0.0f, 1.0f));
+        } return;
+        case PixelFormat::R8Srgb: {
+            UnsignedByte* const data = reinterpret_cast<UnsignedByte*>(out);
+            for(std::size_t i = 0; i != count; ++i) {
+                const Float value = Math::clamp(in[i], 0.0f, 1.0f);
+                data[i] = Math::pack<UnsignedByte>(i % channelCount == 3 ?
+                    value : linearToSrgb(value));
+            }
+        } return;
+        case PixelFormat::R16Unorm: {
+            UnsignedShort* const data = reinterpret_cast<UnsignedShort*>(out);
+            for(std::size_t i = 0; i != count; ++i)
+                data[i] = Math::pack<UnsignedShort>(Math::clamp(in[i], 0.0f, 1.0f));
+        } return;
+        case PixelFormat::R16F: {
+            UnsignedShort* const data = reinterpret_cast<UnsignedShort*>(out);
+            for(std::size_t i = 0; i != count; ++i)
+                data[i] = Math::packHalf(in[i]);
+        } return;
+        case PixelFormat::R32F: {
+            Float* const data = reinterpret_cast<Float*>(out);
+            for(std::size_t i = 0; i != count; ++i)
+                data[i] = in[i];
+        } return;
+        default: CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+    }
+}
+
+/* Pointers to the beginning of a row in a 2D or 3D image. Pixels in a row
+   are always contiguous, only rows and slices can have padding. */
+const char* rowPointer(const Containers::StridedArrayView3D<const char>& pixels, Int, const Int y) {
+    return static_cast<const char*>(pixels[y].data());
+}
+const char* rowPointer(const Containers::StridedArrayView4D<const char>& pixels, const Int z, const Int y) {
+    return static_cast<const char*>(pixels[z][y].data());
+}
+char* rowPointer(const Containers::StridedArrayView3D<char>& pixels, Int, const Int y) {
+    return static_cast<char*>(pixels[y].data());
+}
+char* rowPointer(const Containers::StridedArrayView4D<char>& pixels, const Int z, const Int y) {
+    return static_cast<char*>(pixels[z][y].data());
+}
+
+Vector3i size3D(const Vector2i& size) { return {size, 1}; }
+Vector3i size3D(const Vector3i& size) { return size; }
+
+template<UnsignedInt dimensions> void downsampleIntoImplementation(const BasicImageView<dimensions>& input, const BasicMutableImageView<dimensions>& output, const DownsampleFilter filter, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(input.format() == output.format(),
+        "TextureTools::downsampleInto(): expected output format to be" << input.format() << "but got" << output.format(), );
+    CORRADE_ASSERT(isFormatSupported(input.format()),
+        "TextureTools::downsampleInto(): unsupported format" << input.format(), );
+    CORRADE_ASSERT((output.size() <= input.size()).all(),
+        "TextureTools::downsampleInto(): expected output size to not be larger than" << Debug::packed << input.size() << "but got" << Debug::packed << output.size(), );
+
+    const Vector3i inputSize = size3D(input.size());
+    const Vector3i outputSize = size3D(output.size());
+    if(!outputSize.product()) return;
+
+    const PixelFormat channelFormat = pixelFormatChannelFormat(input.format());
+    const UnsignedInt channelCount = pixelFormatChannelCount(input.format());
+
+    /* Decode the input to floats, laid out as [z][y][x][channel] */
+    const auto inputPixels = input.pixels();
+    Containers::Array<Float> current{NoInit, std::size_t(inputSize.product())*channelCount};
+    Implementation::parallelFor(std::size_t(inputSize.z()*inputSize.y()), threadCount, [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t row = begin; row != end; ++row)
+            decodeRow(channelFormat, channelCount,
+                rowPointer(inputPixels, Int(row/inputSize.y()), Int(row%inputSize.y())),
+                current.data() + row*inputSize.x()*channelCount, inputSize.x());
+    });
+
+    /* Filter along X, Y and Z, skipping dimensions that don't change. After
+       each pass the size in given dimension becomes the output size. */
+    Vector3i size = inputSize;
+    for(std::size_t axis = 0; axis != 3; ++axis) {
+        if(size[axis] == outputSize[axis]) continue;
+
+        std::size_t outer = 1, inner = channelCount;
+        for(std::size_t i = 0; i != axis; ++i) inner *= size[i];
+        for(std::size_t i = axis + 1; i != 3; ++i) outer *= size[i];
+
+        Containers::Array<Float> next{NoInit, outer*outputSize[axis]*inner};
+        filterAxis(calculateTaps(filter, size[axis], outputSize[axis]), outer, size[axis], inner, current, next, threadCount);
+        current = std::move(next);
+        size[axis] = outputSize[axis];
+    }
+
+    /* Encode the result back */
+    const auto outputPixels = output.pixels();
+    Implementation::parallelFor(std::size_t(outputSize.z()*outputSize.y()), threadCount, [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t row = begin; row != end; ++row)
+            encodeRow(channelFormat, channelCount,
+                current.data() + row*outputSize.x()*channelCount,
+                rowPointer(outputPixels, Int(row/outputSize.y()), Int(row%outputSize.y())),
+                outputSize.x());
+    });
+}
+
+template<UnsignedInt dimensions> Image<dimensions> allocateImage(const PixelFormat format, const VectorTypeFor<dimensions, Int>& size) {
+    return Image<dimensions>{PixelStorage{}.setAlignment(1), format, size,
+        Containers::Array<char>{NoInit, std::size_t(size.product())*pixelFormatSize(format)}};
+}
+
+template<UnsignedInt dimensions> Containers::Array<Image<dimensions>> mipmapsImplementation(const BasicImageView<dimensions>& image, const DownsampleFilter filter, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(isFormatSupported(image.format()),
+        "TextureTools::mipmaps(): unsupported format" << image.format(), {});
+    CORRADE_ASSERT(image.size().product(),
+        "TextureTools::mipmaps(): expected a non-empty image", {});
+
+    Containers::Array<Image<dimensions>> levels;
+
+    /* Copy of the base level first */
+    {
+        Image<dimensions> base = allocateImage<dimensions>(image.format(), image.size());
+        Utility::copy(image.pixels(), base.pixels());
+        arrayAppend(levels, std::move(base));
+    }
+
+    /* Each level is made from the previous one, which is cheaper and for
+       power-of-two sizes equivalent to making all from the base level */
+    while(levels.back().size() != VectorTypeFor<dimensions, Int>{1}) {
+        const VectorTypeFor<dimensions, Int> size = Math::max(levels.back().size()/2, VectorTypeFor<dimensions, Int>{1});
+        Image<dimensions> level = allocateImage<dimensions>(image.format(), size);
+        downsampleIntoImplementation<dimensions>(levels.back(), level, filter, threadCount);
+        arrayAppend(levels, std::move(level));
+    }
+
+    /* Convert back to a default deleter to make this usable in plugins. Image
+       isn't default-constructible, so the elements are moved instead. */
+    arrayShrink(levels);
+    return levels;
+}
+
+}
+
+void downsampleInto(const ImageView2D& input, const MutableImageView2D& output, const DownsampleFilter filter, const UnsignedInt threadCount) {
+    downsampleIntoImplementation<2>(input, output, filter, threadCount);
+}
+
+void downsampleInto(const ImageView3D& input, const MutableImageView3D& output, const DownsampleFilter filter, const UnsignedInt threadCount) {
+    downsampleIntoImplementation<3>(input, output, filter, threadCount);
+}
+
+Containers::Array<Image2D> mipmaps(const ImageView2D& image, const DownsampleFilter filter, const UnsignedInt threadCount) {
+    return mipmapsImplementation<2>(image, filter, threadCount);
+}
+
+Containers::Array<Image3D> mipmaps(const ImageView3D& image, const DownsampleFilter filter, const UnsignedInt threadCount) {
+    return mipmapsImplementation<3>(image, filter, threadCount);
+}
+
+}}
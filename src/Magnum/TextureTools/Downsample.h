@@ -0,0 +1,151 @@
+#ifndef Magnum_TextureTools_Downsample_h
+#define Magnum_TextureTools_Downsample_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Enum @ref Magnum::TextureTools::DownsampleFilter, function @ref Magnum::TextureTools::downsampleInto(), @ref Magnum::TextureTools::mipmaps()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/TextureTools/visibility.h"
+
+namespace Magnum { namespace TextureTools {
+
+/**
+@brief Downsampling filter
+@m_since_latest
+
+@see @ref downsampleInto(), @ref mipmaps()
+*/
+enum class DownsampleFilter: UnsignedByte {
+    /**
+     * Box filter. Each output pixel is an average of input pixels it covers.
+     * Fastest, for power-of-two sizes equivalent to what
+     * @ref GL::Texture::generateMipmap() commonly does, but produces visible
+     * aliasing on high-frequency content.
+     */
+    Box,
+
+    /**
+     * Kaiser-windowed sinc filter with a radius of three output pixels.
+     * Sharper than @ref DownsampleFilter::Box with less ringing than
+     * @ref DownsampleFilter::Lanczos.
+     */
+    Kaiser,
+
+    /**
+     * Lanczos filter with a radius of three output pixels. Sharpest, but may
+     * cause slight ringing around hard edges.
+     */
+    Lanczos
+};
+
+/**
+@debugoperatorenum{DownsampleFilter}
+@m_since_latest
+*/
+MAGNUM_TEXTURETOOLS_EXPORT Debug& operator<<(Debug& debug, DownsampleFilter value);
+
+/**
+@brief Downsample an image on the CPU
+@param input        Input image
+@param output       Output image
+@param filter       Filter to use
+@param threadCount  Max count of threads to use. If @cpp 0 @ce,
+    @ref TaskScheduler::threadCount() of @ref TaskScheduler::global() is used.
+@m_since_latest
+
+Resamples @p input to the size of @p output using a separable @p filter,
+first along rows and then along columns, with the filter footprint scaled by
+the ratio of the input and output size. Pixels outside of the image are
+treated as if the edge pixels were repeated. The work is distributed over up
+to @p threadCount threads. If Corrade isn't built with
+@ref CORRADE_BUILD_MULTITHREADED or on Emscripten, everything is done on the
+calling thread.
+
+Expects that @p input and @p output have the same format and @p output isn't
+larger than @p input in any dimension. Supported are all
+@ref PixelFormat::R8Unorm, @relativeref{PixelFormat,R8Srgb},
+@relativeref{PixelFormat,R16Unorm}, @relativeref{PixelFormat,R16F} and
+@relativeref{PixelFormat,R32F} variants with one to four channels. The
+filtering is done in linear space, for sRGB formats the color channels are
+converted from sRGB first and back afterwards, while alpha is kept linear.
+Values of normalized formats are clamped to the representable range.
+@see @ref mipmaps()
+*/
+MAGNUM_TEXTURETOOLS_EXPORT void downsampleInto(const ImageView2D& input, const MutableImageView2D& output, DownsampleFilter filter = DownsampleFilter::Box, UnsignedInt threadCount = 0);
+
+/**
+@brief Downsample a 3D image on the CPU
+@m_since_latest
+
+Same as @ref downsampleInto(const ImageView2D&, const MutableImageView2D&, DownsampleFilter, UnsignedInt),
+but resampling in all three dimensions, which is what mip levels of a 3D
+texture need. For 2D array textures call the 2D variant on each layer
+instead.
+*/
+MAGNUM_TEXTURETOOLS_EXPORT void downsampleInto(const ImageView3D& input, const MutableImageView3D& output, DownsampleFilter filter = DownsampleFilter::Box, UnsignedInt threadCount = 0);
+
+/**
+@brief Generate a mip chain on the CPU
+@param image        Base level
+@param filter       Filter to use
+@param threadCount  Max count of threads to use. If @cpp 0 @ce,
+    @ref TaskScheduler::threadCount() of @ref TaskScheduler::global() is used.
+@m_since_latest
+
+Returns a copy of @p image followed by all its mip levels down to a
+@f$ 1 \times 1 @f$ image, each level half the size of the previous one
+rounded down, generated with @ref downsampleInto() from the previous level.
+The images are tightly packed, i.e. with @ref PixelStorage::setAlignment() set
+to @cpp 1 @ce. The output can be passed directly to a multi-level
+@ref Trade::AbstractImageConverter::convertToFile(Containers::ArrayView<const ImageView2D>, Containers::StringView)
+to be saved, for example, as a DDS or KTX2 file:
+
+@snippet MagnumTextureTools.cpp mipmaps
+
+Expects that @p image has one of the formats supported by
+@ref downsampleInto() and is non-empty. Unlike
+@ref GL::Texture::generateMipmap() this doesn't need a GL context and allows
+choosing a higher-quality filter.
+*/
+MAGNUM_TEXTURETOOLS_EXPORT Containers::Array<Image2D> mipmaps(const ImageView2D& image, DownsampleFilter filter = DownsampleFilter::Box, UnsignedInt threadCount = 0);
+
+/**
+@brief Generate a 3D mip chain on the CPU
+@m_since_latest
+
+Same as @ref mipmaps(const ImageView2D&, DownsampleFilter, UnsignedInt), but
+halving the image in all three dimensions.
+*/
+MAGNUM_TEXTURETOOLS_EXPORT Containers::Array<Image3D> mipmaps(const ImageView3D& image, DownsampleFilter filter = DownsampleFilter::Box, UnsignedInt threadCount = 0);
+
+}}
+
+#endif
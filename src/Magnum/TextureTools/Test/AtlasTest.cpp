@@ -30,6 +30,7 @@
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/FormatStl.h>
 
@@ -53,6 +54,25 @@ struct AtlasTest: TestSuite::Tester {
     void arrayPowerOfTwoMoreLayers();
     void arrayPowerOfTwoWrongLayerSize();
     void arrayPowerOfTwoWrongSize();
+
+    void debugPackerFlag();
+    void debugPackerFlags();
+
+    void packer();
+    void packerRotation();
+    void packerLayers();
+    void packerPadding();
+    void packerFull();
+    void packerRemove();
+    void packerRemoveMerge();
+    void packerFillRate();
+    void packerInvalidSize();
+    void packerSetPaddingNotEmpty();
+    void packerAddInvalidViewSizes();
+    void packerAddNegativeSize();
+    void packerAddNoRotationsView();
+    void packerRemoveOutOfBounds();
+    void packerRemoveEmpty();
 };
 
 /* Could make order[15] and then Containers::arraySize(), but then it won't
@@ -98,6 +118,25 @@ AtlasTest::AtlasTest() {
     addInstancedTests({&AtlasTest::arrayPowerOfTwoWrongLayerSize,
                        &AtlasTest::arrayPowerOfTwoWrongSize},
         Containers::arraySize(ArrayPowerOfTwoWrongSizeData));
+
+    addTests({&AtlasTest::debugPackerFlag,
+              &AtlasTest::debugPackerFlags,
+
+              &AtlasTest::packer,
+              &AtlasTest::packerRotation,
+              &AtlasTest::packerLayers,
+              &AtlasTest::packerPadding,
+              &AtlasTest::packerFull,
+              &AtlasTest::packerRemove,
+              &AtlasTest::packerRemoveMerge,
+              &AtlasTest::packerFillRate,
+              &AtlasTest::packerInvalidSize,
+              &AtlasTest::packerSetPaddingNotEmpty,
+              &AtlasTest::packerAddInvalidViewSizes,
+              &AtlasTest::packerAddNegativeSize,
+              &AtlasTest::packerAddNoRotationsView,
+              &AtlasTest::packerRemoveOutOfBounds,
+              &AtlasTest::packerRemoveEmpty});
 }
 
 void AtlasTest::basic() {
@@ -301,6 +340,348 @@ void AtlasTest::arrayPowerOfTwoWrongSize() {
     CORRADE_COMPARE(out.str(), Utility::formatString("TextureTools::atlasArrayPowerOfTwo(): expected size 2 to be a non-zero power-of-two square, got {}\n", data.message));
 }
 
+void AtlasTest::debugPackerFlag() {
+    std::ostringstream out;
+    Debug{&out} << AtlasPackerFlag::AllowRotation << AtlasPackerFlag(0xca);
+    CORRADE_COMPARE(out.str(), "TextureTools::AtlasPackerFlag::AllowRotation TextureTools::AtlasPackerFlag(0xca)\n");
+}
+
+void AtlasTest::debugPackerFlags() {
+    std::ostringstream out;
+    Debug{&out} << (AtlasPackerFlag::AllowRotation|AtlasPackerFlag(0x80)) << AtlasPackerFlags{};
+    CORRADE_COMPARE(out.str(), "TextureTools::AtlasPackerFlag::AllowRotation|TextureTools::AtlasPackerFlag(0x80) TextureTools::AtlasPackerFlags{}\n");
+}
+
+void AtlasTest::packer() {
+    AtlasPacker packer{{64, 64, 1}};
+    CORRADE_COMPARE(packer.size(), (Vector3i{64, 64, 1}));
+    CORRADE_COMPARE(packer.flags(), AtlasPackerFlags{});
+    CORRADE_COMPARE(packer.padding(), Vector2i{});
+    CORRADE_COMPARE(packer.count(), 0);
+    CORRADE_COMPARE(packer.filledArea(), 0);
+
+    /* The textures get sorted by the longer side, so the last one is placed
+       first */
+    const Vector2i sizes[]{
+        {16, 32},
+        {32, 32},
+        {64, 16}
+    };
+    Vector3i offsets[3];
+    CORRADE_VERIFY(packer.add(sizes, offsets));
+    CORRADE_COMPARE_AS(Containers::arrayView(offsets), Containers::arrayView<Vector3i>({
+        {32, 16, 0},
+        {0, 16, 0},
+        {0, 0, 0}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(packer.count(), 3);
+    CORRADE_COMPARE(packer.filledArea(), 16*32 + 32*32 + 64*16);
+}
+
+void AtlasTest::packerRotation() {
+    const Vector2i sizes[]{
+        {16, 64}
+    };
+    Vector3i offsets[1];
+
+    /* Doesn't fit without a rotation */
+    {
+        AtlasPacker packer{{64, 32, 1}};
+        CORRADE_VERIFY(!packer.add(sizes, offsets));
+        CORRADE_COMPARE(packer.count(), 0);
+    }
+
+    AtlasPacker packer{{64, 32, 1}, AtlasPackerFlag::AllowRotation};
+    CORRADE_COMPARE(packer.flags(), AtlasPackerFlag::AllowRotation);
+
+    bool rotations[1]{};
+    CORRADE_VERIFY(packer.add(sizes, offsets, rotations));
+    CORRADE_COMPARE(offsets[0], (Vector3i{0, 0, 0}));
+    CORRADE_VERIFY(rotations[0]);
+    CORRADE_COMPARE(packer.filledArea(), 16*64);
+}
+
+void AtlasTest::packerLayers() {
+    AtlasPacker packer{{32, 32, 2}};
+
+    /* The square is placed first and fills the whole first layer, the other
+       two then go to the second layer in their original order */
+    const Vector2i sizes[]{
+        {32, 16},
+        {32, 32},
+        {32, 16}
+    };
+    Vector3i offsets[3];
+    CORRADE_VERIFY(packer.add(sizes, offsets));
+    CORRADE_COMPARE_AS(Containers::arrayView(offsets), Containers::arrayView<Vector3i>({
+        {0, 0, 1},
+        {0, 0, 0},
+        {0, 16, 1}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(packer.count(), 3);
+    CORRADE_COMPARE(packer.filledArea(), 2*32*32);
+}
+
+void AtlasTest::packerPadding() {
+    AtlasPacker packer{{64, 64, 1}};
+    packer.setPadding({2, 1});
+    CORRADE_COMPARE(packer.padding(), (Vector2i{2, 1}));
+
+    const Vector2i sizes[]{
+        {8, 16}
+    };
+    Vector3i offsets[1];
+    CORRADE_VERIFY(packer.add(sizes, offsets));
+    CORRADE_COMPARE(offsets[0], (Vector3i{2, 1, 0}));
+
+    /* Adding incrementally puts the second texture into the space that leaves
+       the shortest side */
+    CORRADE_VERIFY(packer.add(sizes, offsets));
+    CORRADE_COMPARE(offsets[0], (Vector3i{2, 19, 0}));
+
+    /* Filled area includes the padding */
+    CORRADE_COMPARE(packer.count(), 2);
+    CORRADE_COMPARE(packer.filledArea(), 2*12*18);
+}
+
+void AtlasTest::packerFull() {
+    AtlasPacker packer{{32, 32, 1}};
+
+    /* If one texture doesn't fit, none of them is added */
+    {
+        const Vector2i sizes[]{
+            {16, 16},
+            {64, 64}
+        };
+        Vector3i offsets[2];
+        CORRADE_VERIFY(!packer.add(sizes, offsets));
+        CORRADE_COMPARE(packer.count(), 0);
+        CORRADE_COMPARE(packer.filledArea(), 0);
+    }
+
+    /* The state stays untouched, so the whole space is still available */
+    const Vector2i sizes[]{
+        {32, 32}
+    };
+    Vector3i offsets[1];
+    CORRADE_VERIFY(packer.add(sizes, offsets));
+    CORRADE_COMPARE(offsets[0], (Vector3i{0, 0, 0}));
+
+    const Vector2i sizesSmall[]{
+        {1, 1}
+    };
+    CORRADE_VERIFY(!packer.add(sizesSmall, offsets));
+    CORRADE_COMPARE(packer.count(), 1);
+    CORRADE_COMPARE(packer.filledArea(), 32*32);
+}
+
+void AtlasTest::packerRemove() {
+    AtlasPacker packer{{64, 32, 1}};
+
+    const Vector2i sizes[]{
+        {32, 32},
+        {32, 32}
+    };
+    Vector3i offsets[2];
+    CORRADE_VERIFY(packer.add(sizes, offsets));
+    CORRADE_COMPARE_AS(Containers::arrayView(offsets), Containers::arrayView<Vector3i>({
+        {0, 0, 0},
+        {32, 0, 0}
+    }), TestSuite::Compare::Container);
+
+    /* The atlas is full now, removing the first texture makes space for
+       another in the same place */
+    packer.remove(offsets[0], sizes[0]);
+    CORRADE_COMPARE(packer.count(), 1);
+    CORRADE_COMPARE(packer.filledArea(), 32*32);
+
+    Vector3i offset[1];
+    CORRADE_VERIFY(packer.add(Containers::arrayView(sizes).prefix(1), offset));
+    CORRADE_COMPARE(offset[0], (Vector3i{0, 0, 0}));
+    CORRADE_COMPARE(packer.count(), 2);
+
+    /* Removing everything resets the packer to the initial state */
+    packer.remove(offset[0], sizes[0]);
+    packer.remove(offsets[1], sizes[1]);
+    CORRADE_COMPARE(packer.count(), 0);
+    CORRADE_COMPARE(packer.filledArea(), 0);
+
+    const Vector2i sizesWhole[]{
+        {64, 32}
+    };
+    CORRADE_VERIFY(packer.add(sizesWhole, offset));
+    CORRADE_COMPARE(offset[0], (Vector3i{0, 0, 0}));
+}
+
+void AtlasTest::packerRemoveMerge() {
+    AtlasPacker packer{{96, 32, 1}};
+
+    const Vector2i sizes[]{
+        {32, 32},
+        {32, 32},
+        {32, 32}
+    };
+    Vector3i offsets[3];
+    CORRADE_VERIFY(packer.add(sizes, offsets));
+    CORRADE_COMPARE_AS(Containers::arrayView(offsets), Containers::arrayView<Vector3i>({
+        {0, 0, 0},
+        {32, 0, 0},
+        {64, 0, 0}
+    }), TestSuite::Compare::Container);
+
+    /* Two neighboring freed rectangles get merged to fit a larger one */
+    packer.remove(offsets[0], sizes[0]);
+    packer.remove(offsets[1], sizes[1]);
+    CORRADE_COMPARE(packer.count(), 1);
+
+    const Vector2i sizesLarger[]{
+        {64, 32}
+    };
+    Vector3i offset[1];
+    CORRADE_VERIFY(packer.add(sizesLarger, offset));
+    CORRADE_COMPARE(offset[0], (Vector3i{0, 0, 0}));
+}
+
+void AtlasTest::packerFillRate() {
+    /* A pseudo-random set of sizes, the largest being 32x36 */
+    Containers::Array<Vector2i> sizes{NoInit, 100};
+    std::size_t area = 0;
+    for(std::size_t i = 0; i != sizes.size(); ++i) {
+        sizes[i] = {8 + Int(i*7 % 25), 8 + Int(i*13 % 29)};
+        area += sizes[i].product();
+    }
+
+    /* The grid-based atlas() doesn't manage to fit them */
+    {
+        std::ostringstream out;
+        Error redirectError{&out};
+        CORRADE_VERIFY(atlas({256, 256}, std::vector<Vector2i>{sizes.begin(), sizes.end()}).empty());
+    }
+
+    /* The packer does, with over two thirds of the area used */
+    AtlasPacker packer{{256, 256, 1}};
+    Containers::Array<Vector3i> offsets{NoInit, sizes.size()};
+    CORRADE_VERIFY(packer.add(sizes, offsets));
+    CORRADE_COMPARE(packer.filledArea(), area);
+    CORRADE_COMPARE_AS(Float(packer.filledArea())/(256*256), 0.66f,
+        TestSuite::Compare::Greater);
+
+    /* Verify the textures are in bounds and don't overlap */
+    for(std::size_t i = 0; i != sizes.size(); ++i) {
+        CORRADE_ITERATION(i);
+        const Range2Di a = Range2Di::fromSize(offsets[i].xy(), sizes[i]);
+        CORRADE_COMPARE(offsets[i].z(), 0);
+        CORRADE_VERIFY((a.min() >= Vector2i{}).all());
+        CORRADE_VERIFY((a.max() <= Vector2i{256}).all());
+        for(std::size_t j = 0; j != i; ++j) {
+            CORRADE_ITERATION(j);
+            const Range2Di b = Range2Di::fromSize(offsets[j].xy(), sizes[j]);
+            CORRADE_VERIFY(!Math::intersects(a, b));
+        }
+    }
+}
+
+void AtlasTest::packerInvalidSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    AtlasPacker{{64, 0, 1}};
+    CORRADE_COMPARE(out.str(), "TextureTools::AtlasPacker: expected a non-zero size, got {64, 0, 1}\n");
+}
+
+void AtlasTest::packerSetPaddingNotEmpty() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    AtlasPacker packer{{64, 64, 1}};
+    const Vector2i sizes[]{
+        {16, 16}
+    };
+    Vector3i offsets[1];
+    CORRADE_VERIFY(packer.add(sizes, offsets));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    packer.setPadding({1, 1});
+    CORRADE_COMPARE(out.str(), "TextureTools::AtlasPacker::setPadding(): the packer is not empty\n");
+}
+
+void AtlasTest::packerAddInvalidViewSizes() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    AtlasPacker packer{{64, 64, 1}, AtlasPackerFlag::AllowRotation};
+    const Vector2i sizes[2]{};
+    Vector3i offsets[2];
+    Vector3i offsetsInvalid[3];
+    bool rotations[2];
+    bool rotationsInvalid[3];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    packer.add(sizes, offsetsInvalid, rotations);
+    packer.add(sizes, offsets, rotationsInvalid);
+    CORRADE_COMPARE(out.str(),
+        "TextureTools::AtlasPacker::add(): expected sizes, offsets and rotations views to have the same size, got 2, 3 and 2\n"
+        "TextureTools::AtlasPacker::add(): expected sizes, offsets and rotations views to have the same size, got 2, 2 and 3\n");
+}
+
+void AtlasTest::packerAddNegativeSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    AtlasPacker packer{{64, 64, 1}};
+    const Vector2i sizes[]{
+        {16, 16},
+        {-1, 2}
+    };
+    Vector3i offsets[2];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    packer.add(sizes, offsets);
+    CORRADE_COMPARE(out.str(), "TextureTools::AtlasPacker::add(): expected size 1 to be non-negative, got {-1, 2}\n");
+}
+
+void AtlasTest::packerAddNoRotationsView() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    AtlasPacker packer{{64, 64, 1}, AtlasPackerFlag::AllowRotation};
+    const Vector2i sizes[1]{};
+    Vector3i offsets[1];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    packer.add(sizes, offsets);
+    CORRADE_COMPARE(out.str(), "TextureTools::AtlasPacker::add(): TextureTools::AtlasPackerFlag::AllowRotation set, expected a rotations view\n");
+}
+
+void AtlasTest::packerRemoveOutOfBounds() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    AtlasPacker packer{{64, 32, 2}};
+    packer.setPadding({1, 2});
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    packer.remove({60, 2, 0}, {8, 8});
+    packer.remove({1, 2, 2}, {8, 8});
+    packer.remove({0, 2, 0}, {8, 8});
+    CORRADE_COMPARE(out.str(),
+        "TextureTools::AtlasPacker::remove(): rectangle Range({59, 0}, {69, 12}) in layer 0 out of bounds for {64, 32, 2}\n"
+        "TextureTools::AtlasPacker::remove(): rectangle Range({0, 0}, {10, 12}) in layer 2 out of bounds for {64, 32, 2}\n"
+        "TextureTools::AtlasPacker::remove(): rectangle Range({-1, 0}, {9, 12}) in layer 0 out of bounds for {64, 32, 2}\n");
+}
+
+void AtlasTest::packerRemoveEmpty() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    AtlasPacker packer{{64, 32, 1}};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    packer.remove({0, 0, 0}, {8, 8});
+    CORRADE_COMPARE(out.str(), "TextureTools::AtlasPacker::remove(): the packer is empty\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::TextureTools::Test::AtlasTest)
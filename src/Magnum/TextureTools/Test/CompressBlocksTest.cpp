@@ -0,0 +1,558 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/TextureTools/CompressBlocks.h"
+
+namespace Magnum { namespace TextureTools { namespace Test { namespace {
+
+struct CompressBlocksTest: TestSuite::Tester {
+    explicit CompressBlocksTest();
+
+    void formatSupported();
+    void compress();
+    void constant();
+    void bc1PunchThrough();
+    void singleChannelInput();
+    void threadCountIndependent();
+    void empty();
+
+    void into();
+    void intoWrongSize();
+
+    void format();
+    void formatNone();
+    void formatInvalidInput();
+
+    void invalidInputFormat();
+    void unsupportedFormat();
+
+    void debugTarget();
+    void debugTargets();
+};
+
+const struct {
+    const char* name;
+    CompressedPixelFormat format;
+    UnsignedInt channelCount;
+    Float maxMeanError;
+    /* Exactly representable in given format */
+    Color4ub constant;
+} CompressData[]{
+    {"BC1 RGB", CompressedPixelFormat::Bc1RGBUnorm, 3, 3.0f,
+        {0, 255, 255, 255}},
+    {"BC1 RGBA sRGB", CompressedPixelFormat::Bc1RGBASrgb, 3, 3.0f,
+        {255, 0, 255, 255}},
+    {"BC2 RGBA", CompressedPixelFormat::Bc2RGBAUnorm, 4, 4.0f,
+        {0, 255, 0, 136}},
+    {"BC3 RGBA", CompressedPixelFormat::Bc3RGBAUnorm, 4, 3.0f,
+        {255, 0, 0, 100}},
+    {"BC4 R", CompressedPixelFormat::Bc4RUnorm, 1, 3.0f,
+        {100, 0, 0, 0}},
+    {"BC5 RG", CompressedPixelFormat::Bc5RGUnorm, 2, 3.0f,
+        {100, 200, 0, 0}},
+    /* Mode 6 has the lowest bit shared across all channels of an endpoint */
+    {"BC7 RGBA", CompressedPixelFormat::Bc7RGBAUnorm, 4, 2.0f,
+        {254, 0, 254, 100}},
+    /* The modifiers are never zero, so only the clamped values are exact */
+    {"ETC2 RGB", CompressedPixelFormat::Etc2RGB8Unorm, 3, 8.0f,
+        {0, 255, 0, 255}},
+};
+
+const struct {
+    const char* name;
+    PixelFormat format;
+    CompressBlocksTargets targets;
+    CompressedPixelFormat expected;
+} FormatData[]{
+    {"R, everything", PixelFormat::R8Unorm,
+        ~CompressBlocksTargets{},
+        CompressedPixelFormat::Bc4RUnorm},
+    {"R, S3TC + BPTC", PixelFormat::R8Unorm,
+        CompressBlocksTarget::S3tc|CompressBlocksTarget::Bptc,
+        CompressedPixelFormat::Bc1RGBUnorm},
+    {"R, ETC2 + BPTC", PixelFormat::R8Unorm,
+        CompressBlocksTarget::Etc2|CompressBlocksTarget::Bptc,
+        CompressedPixelFormat::Etc2RGB8Unorm},
+    {"R sRGB, everything", PixelFormat::R8Srgb,
+        ~CompressBlocksTargets{},
+        CompressedPixelFormat::Bc1RGBSrgb},
+    {"R sRGB, RGTC + S3TC without sRGB + BPTC", PixelFormat::R8Srgb,
+        CompressBlocksTarget::Rgtc|CompressBlocksTarget::S3tc|CompressBlocksTarget::Bptc,
+        CompressedPixelFormat::Bc7RGBASrgb},
+    {"RG, everything", PixelFormat::RG8Unorm,
+        ~CompressBlocksTargets{},
+        CompressedPixelFormat::Bc5RGUnorm},
+    {"RG, everything except RGTC", PixelFormat::RG8Unorm,
+        ~CompressBlocksTarget::Rgtc,
+        CompressedPixelFormat::Bc7RGBAUnorm},
+    {"RG, ETC2", PixelFormat::RG8Unorm,
+        CompressBlocksTarget::Etc2,
+        CompressedPixelFormat::Etc2RGB8Unorm},
+    {"RGB, everything", PixelFormat::RGB8Unorm,
+        ~CompressBlocksTargets{},
+        CompressedPixelFormat::Bc1RGBUnorm},
+    {"RGB, ETC2 + BPTC", PixelFormat::RGB8Unorm,
+        CompressBlocksTarget::Etc2|CompressBlocksTarget::Bptc,
+        CompressedPixelFormat::Etc2RGB8Unorm},
+    {"RGB sRGB, S3TC sRGB + ETC2", PixelFormat::RGB8Srgb,
+        CompressBlocksTarget::S3tcSrgb|CompressBlocksTarget::Etc2,
+        CompressedPixelFormat::Bc1RGBSrgb},
+    {"RGB sRGB, BPTC", PixelFormat::RGB8Srgb,
+        CompressBlocksTarget::Bptc,
+        CompressedPixelFormat::Bc7RGBASrgb},
+    {"RGBA, everything", PixelFormat::RGBA8Unorm,
+        ~CompressBlocksTargets{},
+        CompressedPixelFormat::Bc7RGBAUnorm},
+    {"RGBA, S3TC + ETC2", PixelFormat::RGBA8Unorm,
+        CompressBlocksTarget::S3tc|CompressBlocksTarget::Etc2,
+        CompressedPixelFormat::Bc3RGBAUnorm},
+    {"RGBA sRGB, S3TC sRGB", PixelFormat::RGBA8Srgb,
+        CompressBlocksTarget::S3tcSrgb,
+        CompressedPixelFormat::Bc3RGBASrgb},
+};
+
+CompressBlocksTest::CompressBlocksTest() {
+    addTests({&CompressBlocksTest::formatSupported});
+
+    addInstancedTests({&CompressBlocksTest::compress,
+                       &CompressBlocksTest::constant},
+        Containers::arraySize(CompressData));
+
+    addTests({&CompressBlocksTest::bc1PunchThrough,
+              &CompressBlocksTest::singleChannelInput});
+
+    addInstancedTests({&CompressBlocksTest::threadCountIndependent},
+        Containers::arraySize(CompressData));
+
+    addTests({&CompressBlocksTest::empty,
+
+              &CompressBlocksTest::into,
+              &CompressBlocksTest::intoWrongSize});
+
+    addInstancedTests({&CompressBlocksTest::format},
+        Containers::arraySize(FormatData));
+
+    addTests({&CompressBlocksTest::formatNone,
+              &CompressBlocksTest::formatInvalidInput,
+
+              &CompressBlocksTest::invalidInputFormat,
+              &CompressBlocksTest::unsupportedFormat,
+
+              &CompressBlocksTest::debugTarget,
+              &CompressBlocksTest::debugTargets});
+}
+
+/* Straightforward decoders to verify the output against, following the
+   format specifications */
+
+UnsignedLong readLittleEndian(const char* data) {
+    UnsignedLong value = 0;
+    for(Int i = 7; i >= 0; --i)
+        value = value << 8|UnsignedByte(data[i]);
+    return value;
+}
+
+Color3ub unpackRgb565(const UnsignedInt color) {
+    const UnsignedInt r = color >> 11, g = (color >> 5) & 0x3f, b = color & 0x1f;
+    return {UnsignedByte(r << 3|r >> 2), UnsignedByte(g << 2|g >> 4), UnsignedByte(b << 3|b >> 2)};
+}
+
+void decodeBc1(const char* data, bool alwaysFourColor, Color4ub(&out)[16]) {
+    const UnsignedLong block = readLittleEndian(data);
+    const UnsignedInt color0 = block & 0xffff, color1 = (block >> 16) & 0xffff;
+    Color4ub palette[4];
+    palette[0] = Color4ub{unpackRgb565(color0), 255};
+    palette[1] = Color4ub{unpackRgb565(color1), 255};
+    if(color0 > color1 || alwaysFourColor) {
+        palette[2] = Color4ub{(Vector4i{palette[0]}*2 + Vector4i{palette[1]})/3};
+        palette[3] = Color4ub{(Vector4i{palette[0]} + Vector4i{palette[1]}*2)/3};
+    } else {
+        palette[2] = Color4ub{(Vector4i{palette[0]} + Vector4i{palette[1]})/2};
+        palette[3] = Color4ub{0, 0, 0, 0};
+    }
+    for(UnsignedInt i = 0; i != 16; ++i)
+        out[i] = palette[(block >> (32 + 2*i)) & 0x3];
+}
+
+void decodeBc4(const char* data, UnsignedInt channel, Color4ub(&out)[16]) {
+    const UnsignedLong block = readLittleEndian(data);
+    const Int value0 = block & 0xff, value1 = (block >> 8) & 0xff;
+    Int palette[8]{value0, value1};
+    if(value0 > value1) {
+        for(Int i = 2; i != 8; ++i)
+            palette[i] = ((8 - i)*value0 + (i - 1)*value1)/7;
+    } else {
+        for(Int i = 2; i != 6; ++i)
+            palette[i] = ((6 - i)*value0 + (i - 1)*value1)/5;
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+    for(UnsignedInt i = 0; i != 16; ++i)
+        out[i][channel] = UnsignedByte(palette[(block >> (16 + 3*i)) & 0x7]);
+}
+
+void decodeBc2Alpha(const char* data, Color4ub(&out)[16]) {
+    const UnsignedLong block = readLittleEndian(data);
+    for(UnsignedInt i = 0; i != 16; ++i)
+        out[i].a() = UnsignedByte(((block >> 4*i) & 0xf)*17);
+}
+
+void decodeBc7(const char* data, Color4ub(&out)[16]) {
+    std::size_t offset = 0;
+    auto bits = [&](UnsignedInt count) {
+        UnsignedInt value = 0;
+        for(UnsignedInt i = 0; i != count; ++i, ++offset)
+            value |= ((UnsignedByte(data[offset >> 3]) >> (offset & 7)) & 1) << i;
+        return value;
+    };
+
+    /* Only mode 6 is produced */
+    CORRADE_INTERNAL_ASSERT(bits(7) == 1 << 6);
+    Vector4i endpoints[2];
+    for(UnsignedInt c = 0; c != 4; ++c) {
+        endpoints[0][c] = bits(7) << 1;
+        endpoints[1][c] = bits(7) << 1;
+    }
+    endpoints[0] += Vector4i{Int(bits(1))};
+    endpoints[1] += Vector4i{Int(bits(1))};
+
+    constexpr Int Weights[]{0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+    for(UnsignedInt i = 0; i != 16; ++i) {
+        const Int weight = Weights[bits(i ? 4 : 3)];
+        out[i] = Color4ub{(endpoints[0]*(64 - weight) + endpoints[1]*weight + Vector4i{32})/64};
+    }
+}
+
+void decodeEtc2RGB(const char* data, Color4ub(&out)[16]) {
+    UnsignedLong block = 0;
+    for(UnsignedInt i = 0; i != 8; ++i)
+        block = block << 8|UnsignedByte(data[i]);
+
+    /* Only the individual and differential modes are produced */
+    const bool differential = block >> 33 & 1;
+    const bool flip = block >> 32 & 1;
+    Vector3i base[2];
+    for(UnsignedInt c = 0; c != 3; ++c) {
+        if(differential) {
+            const Int value = (block >> (59 - 8*c)) & 0x1f;
+            const Int difference = Int((block >> (56 - 8*c)) & 0x7) - (block >> (58 - 8*c) & 1 ? 8 : 0);
+            const Int value2 = value + difference;
+            CORRADE_INTERNAL_ASSERT(value2 >= 0 && value2 < 32);
+            base[0][c] = value << 3|value >> 2;
+            base[1][c] = value2 << 3|value2 >> 2;
+        } else {
+            base[0][c] = ((block >> (60 - 8*c)) & 0xf)*17;
+            base[1][c] = ((block >> (56 - 8*c)) & 0xf)*17;
+        }
+    }
+
+    constexpr Int Modifiers[8][2]{
+        {2, 8}, {5, 17}, {9, 29}, {13, 42},
+        {18, 60}, {24, 80}, {33, 106}, {47, 183}
+    };
+    const UnsignedInt tables[2]{UnsignedInt(block >> 37) & 0x7, UnsignedInt(block >> 34) & 0x7};
+    for(UnsignedInt y = 0; y != 4; ++y) for(UnsignedInt x = 0; x != 4; ++x) {
+        const UnsignedInt half = flip ? y >= 2 : x >= 2;
+        const UnsignedInt j = x*4 + y;
+        const UnsignedInt index = ((block >> j) & 1)|((block >> (16 + j)) & 1) << 1;
+        const Int modifier = Modifiers[tables[half]][index & 1]*(index & 2 ? -1 : 1);
+        out[y*4 + x] = Color4ub{Color3ub{Math::clamp(base[half] + Vector3i{modifier}, 0, 255)}, 255};
+    }
+}
+
+Containers::Array<Color4ub> decode(const CompressedImage2D& image) {
+    const Vector2i blockCount = (image.size() + Vector2i{3})/4;
+    const std::size_t blockDataSize = compressedPixelFormatBlockDataSize(image.format());
+    CORRADE_INTERNAL_ASSERT(image.data().size() == std::size_t(blockCount.product())*blockDataSize);
+
+    Containers::Array<Color4ub> out{ValueInit, std::size_t(image.size().product())};
+    for(Int by = 0; by != blockCount.y(); ++by) for(Int bx = 0; bx != blockCount.x(); ++bx) {
+        const char* data = image.data().data() + (by*blockCount.x() + bx)*blockDataSize;
+        Color4ub block[16]{};
+        switch(image.format()) {
+            case CompressedPixelFormat::Bc1RGBUnorm:
+                decodeBc1(data, false, block);
+                for(Color4ub& i: block) i.a() = 255;
+                break;
+            case CompressedPixelFormat::Bc1RGBASrgb:
+                decodeBc1(data, false, block);
+                break;
+            case CompressedPixelFormat::Bc2RGBAUnorm:
+                decodeBc1(data + 8, true, block);
+                decodeBc2Alpha(data, block);
+                break;
+            case CompressedPixelFormat::Bc3RGBAUnorm:
+                decodeBc1(data + 8, true, block);
+                decodeBc4(data, 3, block);
+                break;
+            case CompressedPixelFormat::Bc4RUnorm:
+                decodeBc4(data, 0, block);
+                break;
+            case CompressedPixelFormat::Bc5RGUnorm:
+                decodeBc4(data, 0, block);
+                decodeBc4(data + 8, 1, block);
+                break;
+            case CompressedPixelFormat::Bc7RGBAUnorm:
+                decodeBc7(data, block);
+                break;
+            case CompressedPixelFormat::Etc2RGB8Unorm:
+                decodeEtc2RGB(data, block);
+                break;
+            default: CORRADE_INTERNAL_ASSERT_UNREACHABLE();
+        }
+
+        for(Int y = 0; y != 4; ++y) for(Int x = 0; x != 4; ++x) {
+            const Vector2i position{bx*4 + x, by*4 + y};
+            if((position >= image.size()).any()) continue;
+            out[position.y()*image.size().x() + position.x()] = block[y*4 + x];
+        }
+    }
+
+    return out;
+}
+
+/* A smooth gradient that isn't a multiple of the block size, with each block
+   having its colors roughly on a line */
+Image2D gradient() {
+    Image2D image{PixelFormat::RGBA8Unorm, {13, 7}, Containers::Array<char>{NoInit, 13*7*4}};
+    const Containers::StridedArrayView2D<Color4ub> pixels = image.pixels<Color4ub>();
+    for(Int y = 0; y != 7; ++y) for(Int x = 0; x != 13; ++x)
+        pixels[y][x] = Color4ub(x*15 + y, 64 + x*8 + y, 255 - x*12 - y, 255 - x*4 - y*2);
+    return image;
+}
+
+void CompressBlocksTest::formatSupported() {
+    CORRADE_VERIFY(isCompressBlocksFormatSupported(CompressedPixelFormat::Bc1RGBAUnorm));
+    CORRADE_VERIFY(isCompressBlocksFormatSupported(CompressedPixelFormat::Bc7RGBASrgb));
+    CORRADE_VERIFY(isCompressBlocksFormatSupported(CompressedPixelFormat::Etc2RGB8Srgb));
+    CORRADE_VERIFY(!isCompressBlocksFormatSupported(CompressedPixelFormat::Bc6hRGBUfloat));
+    CORRADE_VERIFY(!isCompressBlocksFormatSupported(CompressedPixelFormat::Bc4RSnorm));
+    CORRADE_VERIFY(!isCompressBlocksFormatSupported(CompressedPixelFormat::Astc4x4RGBAUnorm));
+    CORRADE_VERIFY(!isCompressBlocksFormatSupported(compressedPixelFormatWrap(0xdead)));
+}
+
+void CompressBlocksTest::compress() {
+    auto&& data = CompressData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Image2D image = gradient();
+    CompressedImage2D compressed = compressBlocks(image, data.format);
+    CORRADE_COMPARE(compressed.format(), data.format);
+    CORRADE_COMPARE(compressed.size(), (Vector2i{13, 7}));
+    CORRADE_COMPARE(compressed.data().size(), std::size_t(4*2*compressedPixelFormatBlockDataSize(data.format)));
+
+    const Containers::Array<Color4ub> decoded = decode(compressed);
+    const Containers::StridedArrayView2D<const Color4ub> pixels = image.pixels<Color4ub>();
+    Float error = 0.0f;
+    for(Int y = 0; y != 7; ++y) for(Int x = 0; x != 13; ++x) {
+        for(UnsignedInt c = 0; c != data.channelCount; ++c)
+            error += Math::abs(Float(decoded[y*13 + x][c]) - Float(pixels[y][x][c]));
+    }
+    error /= Float(13*7*data.channelCount);
+    CORRADE_COMPARE_AS(error, data.maxMeanError, TestSuite::Compare::Less);
+}
+
+void CompressBlocksTest::constant() {
+    auto&& data = CompressData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Color4ub pixels[8*4];
+    for(Color4ub& i: pixels) i = data.constant;
+
+    const Containers::Array<Color4ub> decoded = decode(compressBlocks(ImageView2D{PixelFormat::RGBA8Unorm, {8, 4}, pixels}, data.format));
+    for(std::size_t i = 0; i != decoded.size(); ++i) {
+        CORRADE_ITERATION(i);
+        for(UnsignedInt c = 0; c != data.channelCount; ++c)
+            CORRADE_COMPARE(decoded[i][c], data.constant[c]);
+    }
+}
+
+void CompressBlocksTest::bc1PunchThrough() {
+    /* Left half transparent, right half opaque */
+    Color4ub pixels[4*4];
+    for(std::size_t i = 0; i != 16; ++i)
+        pixels[i] = i % 4 < 2 ? Color4ub{255, 0, 0, 100} : Color4ub{0, 0, 255, 200};
+
+    const Containers::Array<Color4ub> decoded = decode(compressBlocks(ImageView2D{PixelFormat::RGBA8Unorm, {4, 4}, pixels}, CompressedPixelFormat::Bc1RGBASrgb));
+    for(std::size_t i = 0; i != 16; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(decoded[i], i % 4 < 2 ? Color4ub{0, 0, 0, 0} : Color4ub{0, 0, 255, 255});
+    }
+}
+
+void CompressBlocksTest::singleChannelInput() {
+    /* Missing channels are zero, alpha is opaque */
+    const UnsignedByte pixels[4*4]{
+        0, 0, 0, 0,
+        255, 255, 255, 255,
+        0, 0, 0, 0,
+        255, 255, 255, 255
+    };
+
+    const Containers::Array<Color4ub> decoded = decode(compressBlocks(ImageView2D{PixelFormat::R8Unorm, {4, 4}, pixels}, CompressedPixelFormat::Bc3RGBAUnorm));
+    for(std::size_t i = 0; i != 16; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(decoded[i], (Color4ub{pixels[i], 0, 0, 255}));
+    }
+}
+
+void CompressBlocksTest::threadCountIndependent() {
+    auto&& data = CompressData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* A larger image so each thread gets several blocks */
+    Image2D image{PixelFormat::RGBA8Unorm, {64, 64}, Containers::Array<char>{NoInit, 64*64*4}};
+    const Containers::StridedArrayView2D<Color4ub> pixels = image.pixels<Color4ub>();
+    for(Int y = 0; y != 64; ++y) for(Int x = 0; x != 64; ++x)
+        pixels[y][x] = Color4ub(x*4, y*4, (x*y) & 0xff, 255 - x);
+
+    CompressedImage2D single = compressBlocks(image, data.format, 1);
+    CompressedImage2D multiple = compressBlocks(image, data.format, 4);
+    CORRADE_COMPARE_AS(multiple.data(), single.data(),
+        TestSuite::Compare::Container);
+}
+
+void CompressBlocksTest::empty() {
+    CompressedImage2D compressed = compressBlocks(ImageView2D{PixelFormat::RGBA8Unorm, {0, 4}}, CompressedPixelFormat::Bc1RGBUnorm);
+    CORRADE_COMPARE(compressed.size(), (Vector2i{0, 4}));
+    CORRADE_VERIFY(compressed.data().isEmpty());
+}
+
+void CompressBlocksTest::into() {
+    Image2D image{PixelFormat::RGBA8Unorm, {12, 8}, Containers::Array<char>{NoInit, 12*8*4}};
+    const Containers::StridedArrayView2D<Color4ub> pixels = image.pixels<Color4ub>();
+    for(Int y = 0; y != 8; ++y) for(Int x = 0; x != 12; ++x)
+        pixels[y][x] = Color4ub(x*20, y*30, (x*y*7) & 0xff, 255 - x*3);
+
+    CompressedImage2D expected = compressBlocks(image, CompressedPixelFormat::Bc7RGBAUnorm);
+
+    /* Pre-fill the output with garbage to verify everything gets
+       overwritten */
+    Containers::Array<char> output{DirectInit, 3*2*16, '\xcd'};
+    compressBlocksInto(image, output, CompressedPixelFormat::Bc7RGBAUnorm);
+    CORRADE_COMPARE_AS(output, expected.data(),
+        TestSuite::Compare::Container);
+}
+
+void CompressBlocksTest::intoWrongSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const char data[8*4*4]{};
+    char output[3*8];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    compressBlocksInto(ImageView2D{PixelFormat::RGBA8Unorm, {8, 4}, data}, output, CompressedPixelFormat::Bc1RGBUnorm);
+    CORRADE_COMPARE(out.str(),
+        "TextureTools::compressBlocksInto(): expected output size to be 16 bytes for Vector(2, 1) blocks of CompressedPixelFormat::Bc1RGBUnorm but got 24\n");
+}
+
+void CompressBlocksTest::format() {
+    auto&& data = FormatData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Optional<CompressedPixelFormat> format = compressBlocksFormat(data.format, data.targets);
+    CORRADE_VERIFY(format);
+    CORRADE_COMPARE(*format, data.expected);
+    CORRADE_VERIFY(isCompressBlocksFormatSupported(*format));
+}
+
+void CompressBlocksTest::formatNone() {
+    /* No targets at all */
+    CORRADE_VERIFY(!compressBlocksFormat(PixelFormat::RGB8Unorm, {}));
+
+    /* ETC2 doesn't have an alpha variant in the supported set */
+    CORRADE_VERIFY(!compressBlocksFormat(PixelFormat::RGBA8Unorm, CompressBlocksTarget::Etc2));
+
+    /* RGTC has no sRGB variants, S3TC without sRGB can't be used either */
+    CORRADE_VERIFY(!compressBlocksFormat(PixelFormat::R8Srgb, CompressBlocksTarget::Rgtc|CompressBlocksTarget::S3tc));
+}
+
+void CompressBlocksTest::formatInvalidInput() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    compressBlocksFormat(PixelFormat::RG16Unorm, CompressBlocksTarget::Rgtc);
+    CORRADE_COMPARE(out.str(),
+        "TextureTools::compressBlocksFormat(): expected an 8-bit normalized format, got PixelFormat::RG16Unorm\n");
+}
+
+void CompressBlocksTest::invalidInputFormat() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const char data[4*4*4]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    compressBlocks(ImageView2D{PixelFormat::RGBA8Snorm, {4, 4}, data}, CompressedPixelFormat::Bc1RGBUnorm);
+    compressBlocks(ImageView2D{PixelFormat::R32F, {4, 4}, data}, CompressedPixelFormat::Bc4RUnorm);
+    CORRADE_COMPARE(out.str(),
+        "TextureTools::compressBlocks(): expected an 8-bit normalized format, got PixelFormat::RGBA8Snorm\n"
+        "TextureTools::compressBlocks(): expected an 8-bit normalized format, got PixelFormat::R32F\n");
+}
+
+void CompressBlocksTest::unsupportedFormat() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const char data[4*4*4]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    compressBlocks(ImageView2D{PixelFormat::RGBA8Unorm, {4, 4}, data}, CompressedPixelFormat::Bc6hRGBUfloat);
+    compressBlocksInto(ImageView2D{PixelFormat::RGBA8Unorm, {4, 4}, data}, nullptr, CompressedPixelFormat::Etc2RGB8A1Unorm);
+    CORRADE_COMPARE(out.str(),
+        "TextureTools::compressBlocks(): unsupported format CompressedPixelFormat::Bc6hRGBUfloat\n"
+        "TextureTools::compressBlocksInto(): unsupported format CompressedPixelFormat::Etc2RGB8A1Unorm\n");
+}
+
+void CompressBlocksTest::debugTarget() {
+    std::ostringstream out;
+    Debug{&out} << CompressBlocksTarget::Rgtc << CompressBlocksTarget(0xbe);
+    CORRADE_COMPARE(out.str(), "TextureTools::CompressBlocksTarget::Rgtc TextureTools::CompressBlocksTarget(0xbe)\n");
+}
+
+void CompressBlocksTest::debugTargets() {
+    std::ostringstream out;
+    Debug{&out} << (CompressBlocksTarget::S3tc|CompressBlocksTarget::Etc2|CompressBlocksTarget(0x80)) << CompressBlocksTargets{};
+    CORRADE_COMPARE(out.str(), "TextureTools::CompressBlocksTarget::S3tc|TextureTools::CompressBlocksTarget::Etc2|TextureTools::CompressBlocksTarget(0x80) TextureTools::CompressBlocksTargets{}\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::TextureTools::Test::CompressBlocksTest)
@@ -0,0 +1,252 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/StringStl.h> /** @todo remove when AbstractImporter is <string>-free */
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Path.h>
+
+#ifdef CORRADE_TARGET_APPLE
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Utility/System.h> /* isSandboxed() */
+#endif
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/DebugTools/CompareImage.h"
+#include "Magnum/TextureTools/DistanceFieldCpu.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/ImageData.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace TextureTools { namespace Test { namespace {
+
+struct DistanceFieldCpuTest: TestSuite::Tester {
+    explicit DistanceFieldCpuTest();
+
+    void simple();
+    void file();
+    void inputChannels();
+    void emptyOutput();
+
+    void invalidInputFormat();
+    void invalidOutputFormat();
+    void invalidOutputSize();
+
+    void benchmark();
+
+    private:
+        PluginManager::Manager<Trade::AbstractImporter> _manager{"nonexistent"};
+        Containers::String _testDir;
+};
+
+const struct {
+    const char* name;
+    UnsignedInt threadCount;
+} ThreadData[]{
+    {"single thread", 1},
+    {"four threads", 4},
+    {"hardware concurrency", 0},
+};
+
+DistanceFieldCpuTest::DistanceFieldCpuTest() {
+    addInstancedTests({&DistanceFieldCpuTest::simple,
+                       &DistanceFieldCpuTest::file},
+        Containers::arraySize(ThreadData));
+
+    addTests({&DistanceFieldCpuTest::inputChannels,
+              &DistanceFieldCpuTest::emptyOutput,
+
+              &DistanceFieldCpuTest::invalidInputFormat,
+              &DistanceFieldCpuTest::invalidOutputFormat,
+              &DistanceFieldCpuTest::invalidOutputSize});
+
+    addBenchmarks({&DistanceFieldCpuTest::benchmark}, 5);
+
+    /* Load the plugin directly from the build tree. Otherwise it's either
+       static and already loaded or not present in the build tree */
+    #ifdef ANYIMAGEIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(ANYIMAGEIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+    #ifdef TGAIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(TGAIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+
+    #ifdef CORRADE_TARGET_APPLE
+    if(Utility::System::isSandboxed()
+        #if defined(CORRADE_TARGET_IOS) && defined(CORRADE_TESTSUITE_TARGET_XCTEST)
+        /** @todo Fix this once I persuade CMake to run XCTest tests properly */
+        && std::getenv("SIMULATOR_UDID")
+        #endif
+    ) {
+        _testDir = Utility::Path::join(Utility::Path::split(*Utility::Path::executableLocation()).first(), "DistanceFieldGLTestFiles");
+    } else
+    #endif
+    {
+        _testDir = DISTANCEFIELDGLTEST_FILES_DIR;
+    }
+}
+
+void DistanceFieldCpuTest::simple() {
+    auto&& data = ThreadData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* A single inside pixel in the middle */
+    const UnsignedByte inputData[]{
+          0,   0,   0,   0,   0,
+          0,   0,   0,   0,   0,
+          0,   0, 255,   0,   0,
+          0,   0,   0,   0,   0,
+          0,   0,   0,   0,   0
+    };
+    ImageView2D input{PixelStorage{}.setAlignment(1), PixelFormat::R8Unorm, {5, 5}, inputData};
+
+    Float outputData[25];
+    distanceFieldInto(input, MutableImageView2D{PixelFormat::R32F, {5, 5}, outputData}, 1, data.threadCount);
+
+    /* With radius 1 the distances are normalized from [-2, 2] to [0, 1] */
+    CORRADE_COMPARE_AS(Containers::arrayView(outputData), Containers::arrayView<Float>({
+        0.0f,      0.0f,  0.0f,      0.0f, 0.0f,
+        0.0f, 0.146447f, 0.25f, 0.146447f, 0.0f,
+        0.0f,     0.25f, 0.75f,     0.25f, 0.0f,
+        0.0f, 0.146447f, 0.25f, 0.146447f, 0.0f,
+        0.0f,      0.0f,  0.0f,      0.0f, 0.0f
+    }), TestSuite::Compare::Container);
+}
+
+void DistanceFieldCpuTest::file() {
+    auto&& data = ThreadData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<Trade::AbstractImporter> importer;
+    if(!(importer = _manager.loadAndInstantiate("TgaImporter")))
+        CORRADE_SKIP("TgaImporter plugin not found.");
+
+    CORRADE_VERIFY(importer->openFile(Utility::Path::join(_testDir, "input.tga")));
+    CORRADE_COMPARE(importer->image2DCount(), 1);
+    Containers::Optional<Trade::ImageData2D> input = importer->image2D(0);
+    CORRADE_VERIFY(input);
+    CORRADE_COMPARE(input->format(), PixelFormat::R8Unorm);
+
+    Image2D output{PixelFormat::R8Unorm, Vector2i{64}, Containers::Array<char>{ValueInit, 64*64}};
+    distanceFieldInto(*input, output, 32, data.threadCount);
+
+    if(!(_manager.loadState("AnyImageImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("AnyImageImporter plugin not found.");
+
+    /* The output should be exactly the same as what the GL implementation
+       produces */
+    CORRADE_COMPARE_WITH(output,
+        Utility::Path::join(_testDir, "output.tga"),
+        DebugTools::CompareImageToFile{_manager});
+}
+
+void DistanceFieldCpuTest::inputChannels() {
+    /* Only the red channel should be taken into account */
+    const Color4ub inputData[]{
+        {0, 255, 255, 255}, {255, 0, 0, 0}, {0, 255, 255, 255}, {0, 255, 255, 255}
+    };
+    ImageView2D input{PixelFormat::RGBA8Unorm, {4, 1}, inputData};
+
+    UnsignedByte outputData[4];
+    distanceFieldInto(input, MutableImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::R8Unorm, {4, 1}, outputData}, 1);
+    CORRADE_COMPARE_AS(Containers::arrayView(outputData), Containers::arrayView<UnsignedByte>({
+        64, 191, 64, 0
+    }), TestSuite::Compare::Container);
+}
+
+void DistanceFieldCpuTest::emptyOutput() {
+    const UnsignedByte inputData[4]{};
+    ImageView2D input{PixelFormat::R8Unorm, {4, 1}, inputData};
+
+    /* Shouldn't crash or do anything */
+    distanceFieldInto(input, MutableImageView2D{PixelFormat::R8Unorm, {0, 1}, nullptr}, 1);
+    CORRADE_VERIFY(true);
+}
+
+void DistanceFieldCpuTest::invalidInputFormat() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const char data[16]{};
+    char outputData[16];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    distanceFieldInto(ImageView2D{PixelFormat::R8Snorm, {4, 4}, data}, MutableImageView2D{PixelFormat::R8Unorm, {4, 4}, outputData}, 4);
+    CORRADE_COMPARE(out.str(), "TextureTools::distanceFieldInto(): unsupported input format PixelFormat::R8Snorm\n");
+}
+
+void DistanceFieldCpuTest::invalidOutputFormat() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const char data[16]{};
+    char outputData[32];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    distanceFieldInto(ImageView2D{PixelFormat::R8Unorm, {4, 4}, data}, MutableImageView2D{PixelFormat::RG8Unorm, {4, 4}, outputData}, 4);
+    CORRADE_COMPARE(out.str(), "TextureTools::distanceFieldInto(): unsupported output format PixelFormat::RG8Unorm\n");
+}
+
+void DistanceFieldCpuTest::invalidOutputSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const char data[16]{};
+    char outputData[32];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    distanceFieldInto(ImageView2D{PixelFormat::R8Unorm, {4, 4}, data}, MutableImageView2D{PixelFormat::R8Unorm, {8, 4}, outputData}, 4);
+    CORRADE_COMPARE(out.str(), "TextureTools::distanceFieldInto(): expected output size to not be larger than {4, 4} but got {8, 4}\n");
+}
+
+void DistanceFieldCpuTest::benchmark() {
+    Containers::Pointer<Trade::AbstractImporter> importer;
+    if(!(importer = _manager.loadAndInstantiate("TgaImporter")))
+        CORRADE_SKIP("TgaImporter plugin not found.");
+
+    CORRADE_VERIFY(importer->openFile(Utility::Path::join(_testDir, "input.tga")));
+    Containers::Optional<Trade::ImageData2D> input = importer->image2D(0);
+    CORRADE_VERIFY(input);
+
+    Image2D output{PixelFormat::R8Unorm, Vector2i{64}, Containers::Array<char>{ValueInit, 64*64}};
+    CORRADE_BENCHMARK(5)
+        distanceFieldInto(*input, output, 32);
+
+    CORRADE_COMPARE(output.pixels<UnsignedByte>()[0][0], 0);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::TextureTools::Test::DistanceFieldCpuTest)
@@ -0,0 +1,339 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Packing.h"
+#include "Magnum/TextureTools/Downsample.h"
+
+namespace Magnum { namespace TextureTools { namespace Test { namespace {
+
+struct DownsampleTest: TestSuite::Tester {
+    explicit DownsampleTest();
+
+    void box();
+    void boxNonPowerOfTwo();
+    void srgb();
+    void unorm16();
+    void half();
+    void constant();
+    void threeDimensional();
+    void emptyOutput();
+
+    void invalidFormatMismatch();
+    void invalidFormat();
+    void invalidOutputSize();
+
+    void mipmaps();
+    void mipmaps3D();
+    void mipmapsSinglePixel();
+    void mipmapsInvalidFormat();
+    void mipmapsEmpty();
+
+    void debugFilter();
+};
+
+const struct {
+    const char* name;
+    UnsignedInt threadCount;
+} ThreadData[]{
+    {"single thread", 1},
+    {"four threads", 4},
+};
+
+const struct {
+    const char* name;
+    DownsampleFilter filter;
+} FilterData[]{
+    {"box", DownsampleFilter::Box},
+    {"Kaiser", DownsampleFilter::Kaiser},
+    {"Lanczos", DownsampleFilter::Lanczos},
+};
+
+DownsampleTest::DownsampleTest() {
+    addInstancedTests({&DownsampleTest::box},
+        Containers::arraySize(ThreadData));
+
+    addTests({&DownsampleTest::boxNonPowerOfTwo,
+              &DownsampleTest::srgb,
+              &DownsampleTest::unorm16,
+              &DownsampleTest::half});
+
+    addInstancedTests({&DownsampleTest::constant},
+        Containers::arraySize(FilterData));
+
+    addInstancedTests({&DownsampleTest::threeDimensional},
+        Containers::arraySize(ThreadData));
+
+    addTests({&DownsampleTest::emptyOutput,
+
+              &DownsampleTest::invalidFormatMismatch,
+              &DownsampleTest::invalidFormat,
+              &DownsampleTest::invalidOutputSize,
+
+              &DownsampleTest::mipmaps,
+              &DownsampleTest::mipmaps3D,
+              &DownsampleTest::mipmapsSinglePixel,
+              &DownsampleTest::mipmapsInvalidFormat,
+              &DownsampleTest::mipmapsEmpty,
+
+              &DownsampleTest::debugFilter});
+}
+
+void DownsampleTest::box() {
+    auto&& data = ThreadData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const UnsignedByte input[]{
+         0, 100, 200,  50,
+        20,  40,  60, 250
+    };
+    UnsignedByte output[2];
+    downsampleInto(
+        ImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::R8Unorm, {4, 2}, input},
+        MutableImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::R8Unorm, {2, 1}, output},
+        DownsampleFilter::Box, data.threadCount);
+    CORRADE_COMPARE_AS(Containers::arrayView(output), Containers::arrayView<UnsignedByte>({
+        40, 140
+    }), TestSuite::Compare::Container);
+}
+
+void DownsampleTest::boxNonPowerOfTwo() {
+    /* Each output pixel is an average of three input pixels */
+    const UnsignedByte input[]{30, 60, 90, 0, 0, 3};
+    UnsignedByte output[2];
+    downsampleInto(
+        ImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::R8Unorm, {6, 1}, input},
+        MutableImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::R8Unorm, {2, 1}, output});
+    CORRADE_COMPARE_AS(Containers::arrayView(output), Containers::arrayView<UnsignedByte>({
+        60, 1
+    }), TestSuite::Compare::Container);
+}
+
+void DownsampleTest::srgb() {
+    const Color4ub input[]{
+        {0, 0, 0, 0}, {255, 255, 255, 255}
+    };
+    Color4ub output[1];
+
+    /* Linear formats average the values directly */
+    downsampleInto(
+        ImageView2D{PixelFormat::RGBA8Unorm, {2, 1}, input},
+        MutableImageView2D{PixelFormat::RGBA8Unorm, {1, 1}, output});
+    CORRADE_COMPARE(output[0], (Color4ub{128, 128, 128, 128}));
+
+    /* sRGB formats average in linear space, resulting in a brighter color.
+       Alpha stays linear. */
+    downsampleInto(
+        ImageView2D{PixelFormat::RGBA8Srgb, {2, 1}, input},
+        MutableImageView2D{PixelFormat::RGBA8Srgb, {1, 1}, output});
+    CORRADE_COMPARE(output[0], (Color4ub{188, 188, 188, 128}));
+}
+
+void DownsampleTest::unorm16() {
+    const UnsignedShort input[]{0, 65535};
+    UnsignedShort output[1];
+    downsampleInto(
+        ImageView2D{PixelFormat::R16Unorm, {2, 1}, input},
+        MutableImageView2D{PixelStorage{}.setAlignment(2), PixelFormat::R16Unorm, {1, 1}, output});
+    CORRADE_COMPARE(output[0], 32768);
+}
+
+void DownsampleTest::half() {
+    const UnsignedShort input[]{
+        Math::packHalf(1.0f), Math::packHalf(2.0f),
+        Math::packHalf(3.0f), Math::packHalf(6.0f)
+    };
+    UnsignedShort output[1];
+    downsampleInto(
+        ImageView2D{PixelFormat::R16F, {2, 2}, input},
+        MutableImageView2D{PixelStorage{}.setAlignment(2), PixelFormat::R16F, {1, 1}, output});
+    CORRADE_COMPARE(Math::unpackHalf(output[0]), 3.0f);
+}
+
+void DownsampleTest::constant() {
+    auto&& data = FilterData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Weights are normalized, so a constant image stays constant
+       independently of the filter, including the edges */
+    Float input[7*5];
+    for(Float& i: input) i = 0.25f;
+    Float output[3*2];
+    downsampleInto(
+        ImageView2D{PixelFormat::R32F, {7, 5}, input},
+        MutableImageView2D{PixelFormat::R32F, {3, 2}, output},
+        data.filter);
+    for(std::size_t i = 0; i != Containers::arraySize(output); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(output[i], 0.25f);
+    }
+}
+
+void DownsampleTest::threeDimensional() {
+    auto&& data = ThreadData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const UnsignedByte input[]{
+         0, 10,
+        20, 30,
+
+        40, 50,
+        60, 70
+    };
+    UnsignedByte output[1];
+    downsampleInto(
+        ImageView3D{PixelStorage{}.setAlignment(1), PixelFormat::R8Unorm, {2, 2, 2}, input},
+        MutableImageView3D{PixelStorage{}.setAlignment(1), PixelFormat::R8Unorm, {1, 1, 1}, output},
+        DownsampleFilter::Box, data.threadCount);
+    CORRADE_COMPARE(output[0], 35);
+}
+
+void DownsampleTest::emptyOutput() {
+    const UnsignedByte input[4]{};
+
+    /* Shouldn't crash or assert */
+    downsampleInto(
+        ImageView2D{PixelFormat::R8Unorm, {4, 1}, input},
+        MutableImageView2D{PixelFormat::R8Unorm, {0, 1}});
+    CORRADE_VERIFY(true);
+}
+
+void DownsampleTest::invalidFormatMismatch() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const char data[16]{};
+    char outputData[16];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    downsampleInto(ImageView2D{PixelFormat::R8Unorm, {4, 4}, data}, MutableImageView2D{PixelFormat::RGBA8Unorm, {1, 1}, outputData});
+    CORRADE_COMPARE(out.str(), "TextureTools::downsampleInto(): expected output format to be PixelFormat::R8Unorm but got PixelFormat::RGBA8Unorm\n");
+}
+
+void DownsampleTest::invalidFormat() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const char data[64]{};
+    char outputData[16];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    downsampleInto(ImageView2D{PixelFormat::RGBA8Snorm, {4, 4}, data}, MutableImageView2D{PixelFormat::RGBA8Snorm, {2, 2}, outputData});
+    downsampleInto(ImageView2D{PixelFormat::Depth32F, {4, 4}, data}, MutableImageView2D{PixelFormat::Depth32F, {2, 2}, outputData});
+    CORRADE_COMPARE(out.str(),
+        "TextureTools::downsampleInto(): unsupported format PixelFormat::RGBA8Snorm\n"
+        "TextureTools::downsampleInto(): unsupported format PixelFormat::Depth32F\n");
+}
+
+void DownsampleTest::invalidOutputSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const char data[16]{};
+    char outputData[32];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    downsampleInto(ImageView2D{PixelFormat::R8Unorm, {4, 4}, data}, MutableImageView2D{PixelFormat::R8Unorm, {8, 4}, outputData});
+    CORRADE_COMPARE(out.str(), "TextureTools::downsampleInto(): expected output size to not be larger than {4, 4} but got {8, 4}\n");
+}
+
+void DownsampleTest::mipmaps() {
+    Color4ub input[5*3];
+    for(std::size_t i = 0; i != Containers::arraySize(input); ++i)
+        input[i] = Color4ub{UnsignedByte(i*10)};
+
+    Containers::Array<Image2D> levels = TextureTools::mipmaps(ImageView2D{PixelFormat::RGBA8Unorm, {5, 3}, input});
+    CORRADE_COMPARE(levels.size(), 3);
+    CORRADE_COMPARE(levels[0].size(), (Vector2i{5, 3}));
+    CORRADE_COMPARE(levels[1].size(), (Vector2i{2, 1}));
+    CORRADE_COMPARE(levels[2].size(), (Vector2i{1, 1}));
+    for(const Image2D& level: levels) {
+        CORRADE_COMPARE(level.format(), PixelFormat::RGBA8Unorm);
+        CORRADE_COMPARE(level.storage().alignment(), 1);
+    }
+
+    /* The base level is a copy */
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Color4ub>(levels[0].data()),
+        Containers::arrayView(input),
+        TestSuite::Compare::Container);
+}
+
+void DownsampleTest::mipmaps3D() {
+    const UnsignedByte input[4*2*2]{};
+
+    Containers::Array<Image3D> levels = TextureTools::mipmaps(ImageView3D{PixelFormat::R8Unorm, {4, 2, 2}, input});
+    CORRADE_COMPARE(levels.size(), 3);
+    CORRADE_COMPARE(levels[0].size(), (Vector3i{4, 2, 2}));
+    CORRADE_COMPARE(levels[1].size(), (Vector3i{2, 1, 1}));
+    CORRADE_COMPARE(levels[2].size(), (Vector3i{1, 1, 1}));
+}
+
+void DownsampleTest::mipmapsSinglePixel() {
+    const Float input[]{0.75f};
+
+    Containers::Array<Image2D> levels = TextureTools::mipmaps(ImageView2D{PixelFormat::R32F, {1, 1}, input}, DownsampleFilter::Lanczos);
+    CORRADE_COMPARE(levels.size(), 1);
+    CORRADE_COMPARE(levels[0].pixels<Float>()[0][0], 0.75f);
+}
+
+void DownsampleTest::mipmapsInvalidFormat() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const char data[16]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    TextureTools::mipmaps(ImageView2D{PixelFormat::RGBA8Snorm, {2, 2}, data});
+    CORRADE_COMPARE(out.str(), "TextureTools::mipmaps(): unsupported format PixelFormat::RGBA8Snorm\n");
+}
+
+void DownsampleTest::mipmapsEmpty() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    TextureTools::mipmaps(ImageView2D{PixelFormat::R8Unorm, {4, 0}});
+    CORRADE_COMPARE(out.str(), "TextureTools::mipmaps(): expected a non-empty image\n");
+}
+
+void DownsampleTest::debugFilter() {
+    std::ostringstream out;
+    Debug{&out} << DownsampleFilter::Lanczos << DownsampleFilter(0xfe);
+    CORRADE_COMPARE(out.str(), "TextureTools::DownsampleFilter::Lanczos TextureTools::DownsampleFilter(0xfe)\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::TextureTools::Test::DownsampleTest)
@@ -38,6 +38,7 @@
 #include "Magnum/GL/Texture.h"
 #include "Magnum/GL/TextureFormat.h"
 #include "Magnum/TextureTools/DistanceField.h"
+#include "Magnum/TextureTools/DistanceFieldCpu.h"
 #include "Magnum/Trade/AbstractImporter.h"
 #include "Magnum/Trade/AbstractImageConverter.h"
 #include "Magnum/Trade/ImageData.h"
@@ -107,7 +108,7 @@ that can write PNG files.
 @code{.sh}
 magnum-distancefieldconverter [--magnum-...] [-h|--help] [--importer IMPORTER]
     [--converter CONVERTER] [--plugin-dir DIR] --output-size "X Y" --radius N
-    [--] input output
+    [--cpu] [--] input output
 @endcode
 
 Arguments:
@@ -122,6 +123,9 @@ Arguments:
 -   `--plugin-dir DIR` --- override base plugin dir
 -   `--output-size "X Y"` --- size of output image
 -   `--radius N` --- distance field computation radius
+-   `--cpu` --- use @ref TextureTools::distanceFieldInto() instead of
+    @ref TextureTools::DistanceField, which doesn't need a GL context and is
+    thus usable on headless machines without a GPU
 -   `--magnum-...` --- engine-specific options (see
     @ref GL-Context-usage-command-line for details)
 
@@ -153,11 +157,13 @@ DistanceFieldConverter::DistanceFieldConverter(const Arguments& arguments): Plat
         .addOption("plugin-dir").setHelp("plugin-dir", "override base plugin dir", "DIR")
         .addNamedArgument("output-size").setHelp("output-size", "size of output image", "\"X Y\"")
         .addNamedArgument("radius").setHelp("radius", "distance field computation radius", "N")
+        .addBooleanOption("cpu").setHelp("cpu", "calculate on the CPU instead of using GL")
         .addSkippedPrefix("magnum", "engine-specific options")
         .setGlobalHelp("Converts red channel of an image to distance field representation.")
         .parse(arguments.argc, arguments.argv);
 
-    createContext();
+    /* The CPU implementation doesn't need any GL context */
+    if(!args.isSet("cpu")) createContext();
 }
 
 int DistanceFieldConverter::exec() {
@@ -182,6 +188,34 @@ int DistanceFieldConverter::exec() {
         return 3;
     }
 
+    /* Do it on the CPU, if requested */
+    if(args.isSet("cpu")) {
+        if(image->format() != PixelFormat::R8Unorm &&
+           image->format() != PixelFormat::RGB8Unorm &&
+           image->format() != PixelFormat::RGBA8Unorm) {
+            Error() << "Unsupported image format" << image->format();
+            return 4;
+        }
+
+        const Vector2i outputSize = args.value<Vector2i>("output-size");
+        if((outputSize > image->size()).any()) {
+            Error() << "Output size" << outputSize << "is larger than input size" << image->size();
+            return 4;
+        }
+
+        Image2D result{PixelStorage{}.setAlignment(1), PixelFormat::R8Unorm, outputSize, Containers::Array<char>{NoInit, std::size_t(outputSize.product())}};
+
+        Debug() << "Converting image of size" << image->size() << "to distance field on the CPU...";
+        TextureTools::distanceFieldInto(*image, result, args.value<UnsignedInt>("radius"));
+
+        if(!converter->convertToFile(result, args.value("output"))) {
+            Error() << "Cannot save file" << args.value("output");
+            return 5;
+        }
+
+        return 0;
+    }
+
     /* Decide about internal format */
     GL::TextureFormat internalFormat;
     if(image->format() == PixelFormat::R8Unorm)
@@ -0,0 +1,301 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "TiledImage.h"
+
+#include <cstring>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageOperations.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum {
+
+namespace {
+
+/* Matches the default PixelStorage alignment */
+inline std::size_t alignedRowSize(const UnsignedInt pixelSize, const Int width) {
+    return 4*((std::size_t(pixelSize)*width + 3)/4);
+}
+
+/* Fills the image with a single pixel by copying from a view with zero
+   strides. If there's no pixel, a single zero byte is repeated instead. */
+void fillImage(const MutableImageView2D& image, const char* const pixel, const std::size_t pixelSize) {
+    static const char zero = 0;
+    const Containers::StridedArrayView3D<char> dst = image.pixels();
+    Utility::copy(pixel ?
+        Containers::StridedArrayView3D<const char>{Containers::ArrayView<const char>{pixel, pixelSize}, dst.size(), {0, 0, 1}} :
+        Containers::StridedArrayView3D<const char>{Containers::ArrayView<const char>{&zero, 1}, dst.size(), {0, 0, 0}}, dst);
+}
+
+}
+
+Debug& operator<<(Debug& debug, const TiledImageTileState value) {
+    debug << "TiledImageTileState" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(v) case TiledImageTileState::v: return debug << "::" #v;
+        _c(Empty)
+        _c(Uniform)
+        _c(Allocated)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+TiledImage2D::TiledImage2D(const PixelFormat format, const Vector2i& size, const Vector2i& tileSize): _format{format}, _pixelSize{}, _size{size}, _tileSize{tileSize} {
+    CORRADE_ASSERT(!isPixelFormatImplementationSpecific(format),
+        "TiledImage2D: can't use an implementation-specific pixel format" << reinterpret_cast<void*>(pixelFormatUnwrap(format)), );
+    CORRADE_ASSERT(tileSize.x() > 0 && tileSize.y() > 0,
+        "TiledImage2D: expected a positive tile size, got" << Debug::packed << tileSize, );
+
+    _pixelSize = pixelFormatSize(format);
+    _tileCount = (size + tileSize - Vector2i{1})/tileSize;
+    _tileStates = Containers::Array<TiledImageTileState>{ValueInit, std::size_t(_tileCount.product())};
+    _tileData = Containers::Array<Containers::Array<char>>{ValueInit, std::size_t(_tileCount.product())};
+}
+
+TiledImage2D::TiledImage2D(TiledImage2D&&) noexcept = default;
+
+TiledImage2D::~TiledImage2D() = default;
+
+TiledImage2D& TiledImage2D::operator=(TiledImage2D&&) noexcept = default;
+
+std::size_t TiledImage2D::tileId(const Vector2i& tile) const {
+    return std::size_t(tile.y())*_tileCount.x() + tile.x();
+}
+
+Range2Di TiledImage2D::tileRange(const Vector2i& tile) const {
+    CORRADE_ASSERT(Range2Di{{}, _tileCount}.contains(tile),
+        "TiledImage2D::tileRange(): tile" << Debug::packed << tile << "out of range for" << Debug::packed << _tileCount << "tiles", {});
+
+    const Vector2i min = tile*_tileSize;
+    return {min, Math::min(min + _tileSize, _size)};
+}
+
+Range2Di TiledImage2D::tilesCovering(const Range2Di& range) const {
+    CORRADE_ASSERT(Range2Di{{}, _size}.contains(range),
+        "TiledImage2D::tilesCovering(): range" << Debug::packed << range.min() << "to" << Debug::packed << range.max() << "out of bounds for an image of size" << Debug::packed << _size, {});
+
+    if(range.sizeX() <= 0 || range.sizeY() <= 0) return {};
+    return {range.min()/_tileSize, (range.max() + _tileSize - Vector2i{1})/_tileSize};
+}
+
+TiledImageTileState TiledImage2D::tileState(const Vector2i& tile) const {
+    CORRADE_ASSERT(Range2Di{{}, _tileCount}.contains(tile),
+        "TiledImage2D::tileState(): tile" << Debug::packed << tile << "out of range for" << Debug::packed << _tileCount << "tiles", {});
+
+    return _tileStates[tileId(tile)];
+}
+
+std::size_t TiledImage2D::dataSize() const {
+    std::size_t size = 0;
+    for(const Containers::Array<char>& data: _tileData)
+        size += data.size();
+    return size;
+}
+
+ImageView2D TiledImage2D::tile(const Vector2i& tile) const {
+    CORRADE_ASSERT(Range2Di{{}, _tileCount}.contains(tile),
+        "TiledImage2D::tile(): tile" << Debug::packed << tile << "out of range for" << Debug::packed << _tileCount << "tiles", (ImageView2D{_format, {}}));
+    const std::size_t id = tileId(tile);
+    CORRADE_ASSERT(_tileStates[id] == TiledImageTileState::Allocated,
+        "TiledImage2D::tile(): expected tile" << Debug::packed << tile << "to be allocated but it's" << _tileStates[id], (ImageView2D{_format, {}}));
+
+    return ImageView2D{_format, tileRange(tile).size(), _tileData[id]};
+}
+
+void TiledImage2D::allocateTile(const std::size_t id, const bool fill) {
+    const Vector2i size = tileRange({Int(id % _tileCount.x()), Int(id/_tileCount.x())}).size();
+    const std::size_t dataSize = alignedRowSize(_pixelSize, size.x())*size.y();
+
+    /* If the tile is going to be fully overwritten, there's no need to
+       initialize anything */
+    Containers::Array<char> data;
+    if(!fill) {
+        data = Containers::Array<char>{NoInit, dataSize};
+    } else if(_tileStates[id] == TiledImageTileState::Uniform) {
+        data = Containers::Array<char>{NoInit, dataSize};
+        fillImage(MutableImageView2D{_format, size, data}, _tileData[id].data(), _pixelSize);
+    } else {
+        CORRADE_INTERNAL_ASSERT(_tileStates[id] == TiledImageTileState::Empty);
+        data = Containers::Array<char>{ValueInit, dataSize};
+    }
+
+    _tileData[id] = std::move(data);
+    _tileStates[id] = TiledImageTileState::Allocated;
+}
+
+MutableImageView2D TiledImage2D::mutableTile(const Vector2i& tile) {
+    CORRADE_ASSERT(Range2Di{{}, _tileCount}.contains(tile),
+        "TiledImage2D::mutableTile(): tile" << Debug::packed << tile << "out of range for" << Debug::packed << _tileCount << "tiles", (MutableImageView2D{_format, {}}));
+
+    const std::size_t id = tileId(tile);
+    if(_tileStates[id] != TiledImageTileState::Allocated)
+        allocateTile(id, true);
+
+    return MutableImageView2D{_format, tileRange(tile).size(), _tileData[id]};
+}
+
+Containers::ArrayView<const char> TiledImage2D::uniformTilePixel(const Vector2i& tile) const {
+    CORRADE_ASSERT(Range2Di{{}, _tileCount}.contains(tile),
+        "TiledImage2D::uniformTilePixel(): tile" << Debug::packed << tile << "out of range for" << Debug::packed << _tileCount << "tiles", {});
+    const std::size_t id = tileId(tile);
+    CORRADE_ASSERT(_tileStates[id] == TiledImageTileState::Uniform,
+        "TiledImage2D::uniformTilePixel(): expected tile" << Debug::packed << tile << "to be uniform but it's" << _tileStates[id], {});
+
+    return _tileData[id];
+}
+
+void TiledImage2D::releaseTile(const Vector2i& tile) {
+    CORRADE_ASSERT(Range2Di{{}, _tileCount}.contains(tile),
+        "TiledImage2D::releaseTile(): tile" << Debug::packed << tile << "out of range for" << Debug::packed << _tileCount << "tiles", );
+
+    const std::size_t id = tileId(tile);
+    _tileData[id] = nullptr;
+    _tileStates[id] = TiledImageTileState::Empty;
+}
+
+bool TiledImage2D::compactTile(const Vector2i& tile) {
+    CORRADE_ASSERT(Range2Di{{}, _tileCount}.contains(tile),
+        "TiledImage2D::compactTile(): tile" << Debug::packed << tile << "out of range for" << Debug::packed << _tileCount << "tiles", {});
+
+    const std::size_t id = tileId(tile);
+    if(_tileStates[id] != TiledImageTileState::Allocated) return false;
+
+    /* Compare all pixels against the first one, row by row */
+    const Vector2i size = tileRange(tile).size();
+    const std::size_t rowSize = alignedRowSize(_pixelSize, size.x());
+    const char* const data = _tileData[id].data();
+    for(Int y = 0; y != size.y(); ++y) {
+        const char* const row = data + y*rowSize;
+        for(Int x = 0; x != size.x(); ++x)
+            if(std::memcmp(row + x*_pixelSize, data, _pixelSize) != 0)
+                return false;
+    }
+
+    /* All pixels are the same. If they're zero, the tile can be released
+       altogether. */
+    bool zero = true;
+    for(std::size_t i = 0; i != _pixelSize; ++i) if(data[i]) {
+        zero = false;
+        break;
+    }
+    if(zero) {
+        releaseTile(tile);
+        return true;
+    }
+
+    Containers::Array<char> pixel{NoInit, _pixelSize};
+    std::memcpy(pixel.data(), data, _pixelSize);
+    _tileData[id] = std::move(pixel);
+    _tileStates[id] = TiledImageTileState::Uniform;
+    return true;
+}
+
+std::size_t TiledImage2D::compact() {
+    std::size_t count = 0;
+    for(Int y = 0; y != _tileCount.y(); ++y)
+        for(Int x = 0; x != _tileCount.x(); ++x)
+            if(compactTile({x, y})) ++count;
+    return count;
+}
+
+void TiledImage2D::setSubImage(const Vector2i& offset, const ImageView2D& image) {
+    CORRADE_ASSERT(image.format() == _format,
+        "TiledImage2D::setSubImage(): expected" << _format << "but got" << image.format(), );
+    const Range2Di range = Range2Di::fromSize(offset, image.size());
+    CORRADE_ASSERT(Range2Di{{}, _size}.contains(range),
+        "TiledImage2D::setSubImage(): range" << Debug::packed << range.min() << "to" << Debug::packed << range.max() << "out of bounds for an image of size" << Debug::packed << _size, );
+
+    const Range2Di tiles = tilesCovering(range);
+    for(Int y = tiles.min().y(); y < tiles.max().y(); ++y) {
+        for(Int x = tiles.min().x(); x < tiles.max().x(); ++x) {
+            const Vector2i tile{x, y};
+            const std::size_t id = tileId(tile);
+            const Range2Di tileRange = this->tileRange(tile);
+            const Range2Di intersection = Math::intersect(range, tileRange);
+
+            if(_tileStates[id] != TiledImageTileState::Allocated)
+                allocateTile(id, intersection != tileRange);
+
+            copyImage(
+                cropImage(image, intersection.translated(-offset)),
+                cropImage(MutableImageView2D{_format, tileRange.size(), _tileData[id]}, intersection.translated(-tileRange.min())));
+        }
+    }
+}
+
+void TiledImage2D::subImageInto(const Range2Di& range, const MutableImageView2D& image) const {
+    CORRADE_ASSERT(image.format() == _format,
+        "TiledImage2D::subImageInto(): expected" << _format << "but got" << image.format(), );
+    CORRADE_ASSERT(Range2Di{{}, _size}.contains(range),
+        "TiledImage2D::subImageInto(): range" << Debug::packed << range.min() << "to" << Debug::packed << range.max() << "out of bounds for an image of size" << Debug::packed << _size, );
+    CORRADE_ASSERT(range.size() == image.size(),
+        "TiledImage2D::subImageInto(): expected an image of size" << Debug::packed << range.size() << "but got" << Debug::packed << image.size(), );
+
+    const Range2Di tiles = tilesCovering(range);
+    for(Int y = tiles.min().y(); y < tiles.max().y(); ++y) {
+        for(Int x = tiles.min().x(); x < tiles.max().x(); ++x) {
+            const Vector2i tile{x, y};
+            const std::size_t id = tileId(tile);
+            const Range2Di tileRange = this->tileRange(tile);
+            const Range2Di intersection = Math::intersect(range, tileRange);
+            const MutableImageView2D dst = cropImage(image, intersection.translated(-range.min()));
+
+            switch(_tileStates[id]) {
+                case TiledImageTileState::Empty:
+                    fillImage(dst, nullptr, 0);
+                    break;
+                case TiledImageTileState::Uniform:
+                    fillImage(dst, _tileData[id].data(), _pixelSize);
+                    break;
+                case TiledImageTileState::Allocated:
+                    copyImage(cropImage(ImageView2D{_format, tileRange.size(), _tileData[id]}, intersection.translated(-tileRange.min())), dst);
+                    break;
+            }
+        }
+    }
+}
+
+Image2D TiledImage2D::subImage(const Range2Di& range) const {
+    CORRADE_ASSERT(Range2Di{{}, _size}.contains(range),
+        "TiledImage2D::subImage(): range" << Debug::packed << range.min() << "to" << Debug::packed << range.max() << "out of bounds for an image of size" << Debug::packed << _size, (Image2D{_format}));
+
+    Image2D out{_format, range.size(), Containers::Array<char>{NoInit, alignedRowSize(_pixelSize, range.sizeX())*range.sizeY()}};
+    subImageInto(range, out);
+    return out;
+}
+
+}
@@ -0,0 +1,291 @@
+#ifndef Magnum_TiledImage_h
+#define Magnum_TiledImage_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::TiledImage2D, enum @ref Magnum::TiledImageTileState
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum {
+
+/**
+@brief Tile state in a tiled image
+@m_since_latest
+
+@see @ref TiledImage2D::tileState()
+*/
+enum class TiledImageTileState: UnsignedByte {
+    /** The tile has no memory allocated and all its pixels are zero */
+    Empty,
+
+    /**
+     * All pixels of the tile have the same value, stored just once. Available
+     * through @ref TiledImage2D::uniformTilePixel().
+     */
+    Uniform,
+
+    /** The tile has its pixels allocated, available through @ref TiledImage2D::tile() */
+    Allocated
+};
+
+/**
+@debugoperatorenum{TiledImageTileState}
+@m_since_latest
+*/
+MAGNUM_EXPORT Debug& operator<<(Debug& debug, TiledImageTileState value);
+
+/**
+@brief Tiled image
+@m_since_latest
+
+Stores a 2D image split into a grid of fixed-size tiles, allocating memory
+only for tiles that were written to. Useful for working with images that are
+too large to be allocated at once, such as gigapixel orthophotos, where only a
+part of the image is touched at a time or large areas are empty.
+
+Tiles at the right and top edge of the image are clipped to the image size,
+all other tiles are @ref tileSize() large. Each tile is in one of the
+@ref TiledImageTileState states:
+
+-   @ref TiledImageTileState::Empty tiles take no memory and their pixels are
+    all zero. All tiles start in this state and can be brought back to it
+    with @ref releaseTile().
+-   @ref TiledImageTileState::Uniform tiles store just a single pixel value.
+    Allocated tiles that have all pixels the same are turned into this state
+    by @ref compactTile() or @ref compact(), which for example collapses
+    no-data regions of an orthophoto to a few bytes each.
+-   @ref TiledImageTileState::Allocated tiles store all their pixels, tightly
+    packed with rows aligned to four bytes, i.e. with default
+    @ref PixelStorage. A view on them is returned from @ref tile() and
+    @ref mutableTile(), with the latter allocating the tile if it isn't
+    already, which is what importers and converters can stream through
+    without ever materializing the whole image.
+
+@section TiledImage2D-usage Usage
+
+Arbitrary rectangles of the image can be written with @ref setSubImage() and
+read with @ref subImage() or @ref subImageInto(), which take care of
+splitting the operation across tiles:
+
+@snippet Magnum.cpp TiledImage2D-usage
+
+Only @ref PixelFormat values that aren't implementation-specific are
+supported.
+@see @ref Image2D, @ref ImageView2D
+*/
+class MAGNUM_EXPORT TiledImage2D {
+    public:
+        /**
+         * @brief Constructor
+         * @param format    Pixel format
+         * @param size      Image size
+         * @param tileSize  Tile size
+         *
+         * Expects that @p format isn't implementation-specific and that
+         * @p tileSize is positive in both dimensions. All tiles are
+         * @ref TiledImageTileState::Empty initially, no memory is allocated
+         * for them.
+         */
+        explicit TiledImage2D(PixelFormat format, const Vector2i& size, const Vector2i& tileSize);
+
+        /** @brief Copying is not allowed */
+        TiledImage2D(const TiledImage2D&) = delete;
+
+        /** @brief Move constructor */
+        TiledImage2D(TiledImage2D&&) noexcept;
+
+        ~TiledImage2D();
+
+        /** @brief Copying is not allowed */
+        TiledImage2D& operator=(const TiledImage2D&) = delete;
+
+        /** @brief Move assignment */
+        TiledImage2D& operator=(TiledImage2D&&) noexcept;
+
+        /** @brief Pixel format */
+        PixelFormat format() const { return _format; }
+
+        /**
+         * @brief Pixel size in bytes
+         *
+         * Same as @ref pixelFormatSize() of @ref format().
+         */
+        UnsignedInt pixelSize() const { return _pixelSize; }
+
+        /** @brief Image size */
+        Vector2i size() const { return _size; }
+
+        /** @brief Tile size */
+        Vector2i tileSize() const { return _tileSize; }
+
+        /**
+         * @brief Tile count
+         *
+         * Image size divided by tile size, rounded up.
+         */
+        Vector2i tileCount() const { return _tileCount; }
+
+        /**
+         * @brief Pixel range of a tile
+         *
+         * Expects that @p tile is less than @ref tileCount(). For tiles at
+         * the right and top edge the range is clipped to the image size.
+         */
+        Range2Di tileRange(const Vector2i& tile) const;
+
+        /**
+         * @brief Range of tiles covering given pixel range
+         *
+         * Expects that @p range is contained in the image. The returned range
+         * is in tile coordinates, with the max being exclusive. An empty
+         * @p range results in an empty tile range.
+         */
+        Range2Di tilesCovering(const Range2Di& range) const;
+
+        /**
+         * @brief Tile state
+         *
+         * Expects that @p tile is less than @ref tileCount().
+         */
+        TiledImageTileState tileState(const Vector2i& tile) const;
+
+        /**
+         * @brief Memory used by tile data
+         *
+         * Sum of memory allocated for all @ref TiledImageTileState::Uniform
+         * and @ref TiledImageTileState::Allocated tiles, in bytes.
+         */
+        std::size_t dataSize() const;
+
+        /**
+         * @brief Pixels of an allocated tile
+         *
+         * Expects that @p tile is less than @ref tileCount() and is in the
+         * @ref TiledImageTileState::Allocated state. Use @ref subImage() to
+         * read tiles regardless of their state.
+         */
+        ImageView2D tile(const Vector2i& tile) const;
+
+        /**
+         * @brief Mutable pixels of a tile
+         *
+         * Expects that @p tile is less than @ref tileCount(). If the tile is
+         * @ref TiledImageTileState::Empty, it gets allocated and
+         * zero-filled, if it's @ref TiledImageTileState::Uniform, it gets
+         * allocated and filled with the uniform value. The tile is
+         * @ref TiledImageTileState::Allocated afterwards.
+         */
+        MutableImageView2D mutableTile(const Vector2i& tile);
+
+        /**
+         * @brief Value of a uniform tile
+         *
+         * Expects that @p tile is less than @ref tileCount() and is in the
+         * @ref TiledImageTileState::Uniform state. The returned view is
+         * @ref pixelSize() bytes large.
+         */
+        Containers::ArrayView<const char> uniformTilePixel(const Vector2i& tile) const;
+
+        /**
+         * @brief Release a tile
+         *
+         * Expects that @p tile is less than @ref tileCount(). Frees the tile
+         * memory, if any, and puts it into the
+         * @ref TiledImageTileState::Empty state.
+         */
+        void releaseTile(const Vector2i& tile);
+
+        /**
+         * @brief Compact a tile
+         * @return Whether the tile got compacted
+         *
+         * Expects that @p tile is less than @ref tileCount(). If the tile is
+         * @ref TiledImageTileState::Allocated and all its pixels are the
+         * same, it's turned into @ref TiledImageTileState::Uniform, or into
+         * @ref TiledImageTileState::Empty if all pixels are zero. Otherwise
+         * it's left untouched.
+         */
+        bool compactTile(const Vector2i& tile);
+
+        /**
+         * @brief Compact all tiles
+         * @return Count of tiles that got compacted
+         *
+         * Calls @ref compactTile() on all tiles.
+         */
+        std::size_t compact();
+
+        /**
+         * @brief Set a sub-image
+         *
+         * Expects that @p image has the same @ref format() and that the
+         * range of @p image placed at @p offset is contained in the image.
+         * Tiles touched by the range are allocated as described in
+         * @ref mutableTile(). Tiles that are fully covered by @p image are
+         * not zero-filled or filled with their uniform value before being
+         * overwritten.
+         */
+        void setSubImage(const Vector2i& offset, const ImageView2D& image);
+
+        /**
+         * @brief Read a sub-image into existing memory
+         *
+         * Expects that @p image has the same @ref format(), that @p range is
+         * contained in the image and has the same size as @p image. Empty
+         * and uniform tiles are expanded, no tile gets allocated by this
+         * operation.
+         */
+        void subImageInto(const Range2Di& range, const MutableImageView2D& image) const;
+
+        /**
+         * @brief Read a sub-image
+         *
+         * Allocates a new image of @ref format() and @p range size with
+         * default @ref PixelStorage and calls @ref subImageInto() on it.
+         */
+        Image2D subImage(const Range2Di& range) const;
+
+    private:
+        MAGNUM_LOCAL std::size_t tileId(const Vector2i& tile) const;
+        MAGNUM_LOCAL void allocateTile(std::size_t id, bool fill);
+
+        PixelFormat _format;
+        UnsignedInt _pixelSize;
+        Vector2i _size, _tileSize, _tileCount;
+        Containers::Array<TiledImageTileState> _tileStates;
+        Containers::Array<Containers::Array<char>> _tileData;
+};
+
+}
+
+#endif
@@ -36,14 +36,14 @@ namespace Magnum {
 
 void Timeline::start() {
     running = true;
-    _startTime = high_resolution_clock::now();
+    _startTime = steady_clock::now();
     _previousFrameTime = _startTime;
     _previousFrameDuration = 0;
 }
 
 void Timeline::stop() {
     running = false;
-    _startTime = high_resolution_clock::time_point();
+    _startTime = steady_clock::time_point();
     _previousFrameTime = _startTime;
     _previousFrameDuration = 0;
 }
@@ -51,7 +51,7 @@ void Timeline::stop() {
 void Timeline::nextFrame() {
     if(!running) return;
 
-    auto now = high_resolution_clock::now();
+    auto now = steady_clock::now();
     auto duration = UnsignedInt(duration_cast<microseconds>(now-_previousFrameTime).count());
     _previousFrameDuration = duration/1e6f;
     _previousFrameTime = now;
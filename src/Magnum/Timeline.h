@@ -40,7 +40,8 @@ namespace Magnum {
 @brief Timeline
 
 Keeps track of time delta between frames. Can be used as source for animation
-speed computations.
+speed computations. See @ref FramePacer for a more advanced alternative with
+frame duration smoothing and precise frame rate limiting.
 
 @section Timeline-usage Basic usage
 
@@ -135,8 +136,8 @@ class MAGNUM_EXPORT Timeline {
         Float previousFrameDuration() const { return _previousFrameDuration; }
 
     private:
-        std::chrono::high_resolution_clock::time_point _startTime;
-        std::chrono::high_resolution_clock::time_point _previousFrameTime;
+        std::chrono::steady_clock::time_point _startTime;
+        std::chrono::steady_clock::time_point _previousFrameTime;
         Float _previousFrameDuration;
 
         bool running;
@@ -57,7 +57,7 @@ using namespace Containers::Literals;
 Containers::StringView AbstractImageConverter::pluginInterface() {
     return
 /* [interface] */
-"cz.mosra.magnum.Trade.AbstractImageConverter/0.3.2"_s
+"cz.mosra.magnum.Trade.AbstractImageConverter/0.3.3"_s
 /* [interface] */
     ;
 }
@@ -1243,6 +1243,78 @@ bool AbstractImageConverter::doConvertToFile(const Containers::ArrayView<const C
     return true;
 }
 
+bool AbstractImageConverter::beginConvertRowsToFile(const Containers::StringView filename, const PixelFormat format, const Vector2i& size) {
+    CORRADE_ASSERT(features() & ImageConverterFeature::ConvertRows2DToFile,
+        "Trade::AbstractImageConverter::beginConvertRowsToFile(): incremental 2D image conversion not supported", {});
+    CORRADE_ASSERT(!isConvertingRowsToFile(),
+        "Trade::AbstractImageConverter::beginConvertRowsToFile(): a conversion is already in progress", {});
+    CORRADE_ASSERT(size.product(),
+        "Trade::AbstractImageConverter::beginConvertRowsToFile(): can't convert image with a zero size:" << size, {});
+
+    if(!doBeginConvertRowsToFile(filename, format, size))
+        return false;
+
+    _rowsFormat = format;
+    _rowsWidth = size.x();
+    _rowsHeight = size.y();
+    _rowsDone = 0;
+    return true;
+}
+
+bool AbstractImageConverter::doBeginConvertRowsToFile(Containers::StringView, PixelFormat, const Vector2i&) {
+    CORRADE_ASSERT_UNREACHABLE("Trade::AbstractImageConverter::beginConvertRowsToFile(): incremental 2D image conversion advertised but not implemented", {});
+}
+
+bool AbstractImageConverter::convertRowsToFile(const ImageView2D& rows) {
+    CORRADE_ASSERT(isConvertingRowsToFile(),
+        "Trade::AbstractImageConverter::convertRowsToFile(): no conversion in progress", {});
+    CORRADE_ASSERT(rows.format() == _rowsFormat,
+        "Trade::AbstractImageConverter::convertRowsToFile(): expected" << _rowsFormat << "but got" << rows.format(), {});
+    CORRADE_ASSERT(rows.size().x() == _rowsWidth,
+        "Trade::AbstractImageConverter::convertRowsToFile(): expected width" << _rowsWidth << "but got" << rows.size().x(), {});
+    CORRADE_ASSERT(_rowsDone + rows.size().y() <= _rowsHeight,
+        "Trade::AbstractImageConverter::convertRowsToFile(): can't add" << rows.size().y() << "rows to" << _rowsDone << "out of" << _rowsHeight, {});
+
+    #ifndef CORRADE_NO_ASSERT
+    /* Explicitly return if checks fail for CORRADE_GRACEFUL_ASSERT builds */
+    if(!checkImageValidity("Trade::AbstractImageConverter::convertRowsToFile():", rows))
+        return {};
+    #endif
+
+    if(!doConvertRowsToFile(rows))
+        return false;
+
+    _rowsDone += rows.size().y();
+    return true;
+}
+
+bool AbstractImageConverter::doConvertRowsToFile(const ImageView2D&) {
+    CORRADE_ASSERT_UNREACHABLE("Trade::AbstractImageConverter::convertRowsToFile(): incremental 2D image conversion advertised but not implemented", {});
+}
+
+bool AbstractImageConverter::endConvertRowsToFile() {
+    CORRADE_ASSERT(isConvertingRowsToFile(),
+        "Trade::AbstractImageConverter::endConvertRowsToFile(): no conversion in progress", {});
+
+    /* Call the implementation always so it can clean up, reset the state
+       regardless of the outcome */
+    const bool out = doEndConvertRowsToFile();
+    const Int done = _rowsDone;
+    const Int height = _rowsHeight;
+    _rowsHeight = -1;
+
+    if(done != height) {
+        Error{} << "Trade::AbstractImageConverter::endConvertRowsToFile(): expected" << height << "rows but got" << done;
+        return false;
+    }
+
+    return out;
+}
+
+bool AbstractImageConverter::doEndConvertRowsToFile() {
+    CORRADE_ASSERT_UNREACHABLE("Trade::AbstractImageConverter::endConvertRowsToFile(): incremental 2D image conversion advertised but not implemented", {});
+}
+
 Debug& operator<<(Debug& debug, const ImageConverterFeature value) {
     debug << "Trade::ImageConverterFeature" << Debug::nospace;
 
@@ -1279,6 +1351,7 @@ Debug& operator<<(Debug& debug, const ImageConverterFeature value) {
         _c(ConvertCompressedLevels1DToData)
         _c(ConvertCompressedLevels2DToData)
         _c(ConvertCompressedLevels3DToData)
+        _c(ConvertRows2DToFile)
         #undef _c
         /* LCOV_EXCL_STOP */
     }
@@ -1294,6 +1367,7 @@ Debug& operator<<(Debug& debug, const ImageConverterFeatures value) {
         ImageConverterFeature::ConvertCompressed1D,
         ImageConverterFeature::ConvertCompressed2D,
         ImageConverterFeature::ConvertCompressed3D,
+        ImageConverterFeature::ConvertRows2DToFile,
         ImageConverterFeature::ConvertLevels1DToData,
         ImageConverterFeature::ConvertLevels2DToData,
         ImageConverterFeature::ConvertLevels3DToData,
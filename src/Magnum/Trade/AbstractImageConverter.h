@@ -347,7 +347,16 @@ enum class ImageConverterFeature: UnsignedInt {
      * implies also @relativeref{ImageConverterFeature,ConvertCompressed3DToFile}.
      * @m_since_latest
      */
-    ConvertCompressedLevels3DToData = ConvertCompressedLevels3DToFile|ConvertCompressed3DToData|(1 << 14)
+    ConvertCompressedLevels3DToData = ConvertCompressedLevels3DToFile|ConvertCompressed3DToData|(1 << 14),
+
+    /**
+     * Convert a 2D image to a file incrementally, row range by row range,
+     * with @ref AbstractImageConverter::beginConvertRowsToFile(),
+     * @relativeref{AbstractImageConverter,convertRowsToFile()} and
+     * @relativeref{AbstractImageConverter,endConvertRowsToFile()}.
+     * @m_since_latest
+     */
+    ConvertRows2DToFile = 1 << 15
 };
 
 /**
@@ -1575,6 +1584,64 @@ class MAGNUM_TRADE_EXPORT AbstractImageConverter: public PluginManager::Abstract
          */
         bool convertToFile(std::initializer_list<CompressedImageView3D> imageLevels, Containers::StringView filename);
 
+        /**
+         * @brief Begin converting a 2D image to a file incrementally
+         * @param filename  Output file
+         * @param format    Pixel format of the image
+         * @param size      Image size
+         * @m_since_latest
+         *
+         * Available only if @ref ImageConverterFeature::ConvertRows2DToFile is
+         * supported. Opens the file for writing, after which the image data
+         * are expected to be passed in consecutive row ranges using
+         * @ref convertRowsToFile(), starting from the first row, and the
+         * conversion is finished with @ref endConvertRowsToFile(). Compared
+         * to @ref convertToFile(const ImageView2D&, Containers::StringView)
+         * the whole image doesn't need to be in memory at once, which
+         * together with @ref AbstractImporter::image2DRows() allows
+         * processing of images larger than available memory.
+         *
+         * Expects that @p size is non-zero and no other incremental
+         * conversion is in progress. On failure prints a message to
+         * @relativeref{Magnum,Error} and returns @cpp false @ce, in which case
+         * no conversion is in progress.
+         */
+        bool beginConvertRowsToFile(Containers::StringView filename, PixelFormat format, const Vector2i& size);
+
+        /**
+         * @brief Whether an incremental conversion is in progress
+         * @m_since_latest
+         *
+         * @see @ref beginConvertRowsToFile(), @ref endConvertRowsToFile()
+         */
+        bool isConvertingRowsToFile() const { return _rowsHeight >= 0; }
+
+        /**
+         * @brief Convert next range of rows to a file
+         * @m_since_latest
+         *
+         * Expects that @ref beginConvertRowsToFile() was called before, that
+         * @p rows have the same format and width as passed to
+         * @ref beginConvertRowsToFile() and that the total count of rows
+         * passed so far doesn't exceed the image height. On failure prints a
+         * message to @relativeref{Magnum,Error} and returns @cpp false @ce,
+         * the conversion is still in progress after and has to be finished
+         * with @ref endConvertRowsToFile().
+         */
+        bool convertRowsToFile(const ImageView2D& rows);
+
+        /**
+         * @brief End converting a 2D image to a file incrementally
+         * @m_since_latest
+         *
+         * Expects that @ref beginConvertRowsToFile() was called before.
+         * Finishes the file and ends the conversion. If not all rows were
+         * passed to @ref convertRowsToFile(), prints a message to
+         * @relativeref{Magnum,Error} and returns @cpp false @ce, the file
+         * contents are unspecified in that case.
+         */
+        bool endConvertRowsToFile();
+
     protected:
         /**
          * @brief Implementation for @ref convertToFile(const ImageView1D&, Containers::StringView)
@@ -1909,7 +1976,41 @@ class MAGNUM_TRADE_EXPORT AbstractImageConverter: public PluginManager::Abstract
          */
         virtual Containers::Optional<Containers::Array<char>> doConvertToData(Containers::ArrayView<const CompressedImageView3D> imageLevels);
 
+        /**
+         * @brief Implementation for @ref beginConvertRowsToFile()
+         * @m_since_latest
+         *
+         * Called only if @ref ImageConverterFeature::ConvertRows2DToFile is
+         * supported. The implementation is expected to check that @p format
+         * is supported.
+         */
+        virtual bool doBeginConvertRowsToFile(Containers::StringView filename, PixelFormat format, const Vector2i& size);
+
+        /**
+         * @brief Implementation for @ref convertRowsToFile()
+         * @m_since_latest
+         *
+         * The @p rows are guaranteed to have the same format and width as
+         * passed to @ref doBeginConvertRowsToFile() and to not exceed the
+         * image height together with rows passed previously.
+         */
+        virtual bool doConvertRowsToFile(const ImageView2D& rows);
+
+        /**
+         * @brief Implementation for @ref endConvertRowsToFile()
+         * @m_since_latest
+         *
+         * Called always when @ref endConvertRowsToFile() is called, even if
+         * not all rows were passed, to let the implementation release its
+         * resources.
+         */
+        virtual bool doEndConvertRowsToFile();
+
         ImageConverterFlags _flags;
+        /* State of an incremental conversion, height of -1 means no
+           conversion is in progress */
+        PixelFormat _rowsFormat{};
+        Int _rowsWidth{}, _rowsHeight{-1}, _rowsDone{};
 };
 
 }}
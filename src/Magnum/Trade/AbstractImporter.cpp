@@ -29,16 +29,23 @@
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/EnumSet.hpp>
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Containers/String.h>
 #include <Corrade/Containers/StringStl.h> /** @todo remove once file callbacks are <string>-free */
 #include <Corrade/PluginManager/Manager.hpp>
+#include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/Path.h>
 
 #include "Magnum/FileCallback.h"
+#include "Magnum/ProfileScope.h"
+#include "Magnum/Math/FunctionsBatch.h"
+#include "Magnum/Math/Range.h"
 #include "Magnum/Trade/AnimationData.h"
 #include "Magnum/Trade/ArrayAllocator.h"
+#include "Magnum/Trade/DataArena.h"
 #include "Magnum/Trade/CameraData.h"
+#include "Magnum/Trade/ChunkedMeshData.h"
 #include "Magnum/Trade/ImageData.h"
 #include "Magnum/Trade/LightData.h"
 #include "Magnum/Trade/MaterialData.h"
@@ -83,7 +90,7 @@ using namespace Containers::Literals;
 Containers::StringView AbstractImporter::pluginInterface() {
     return
 /* [interface] */
-"cz.mosra.magnum.Trade.AbstractImporter/0.5"_s
+"cz.mosra.magnum.Trade.AbstractImporter/0.5.1"_s
 /* [interface] */
     ;
 }
@@ -111,17 +118,27 @@ Containers::Array<Containers::String> AbstractImporter::pluginSearchPaths() {
 }
 #endif
 
+/* Memory mapping is not available on Emscripten and WinRT */
+#if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+#define MAGNUM_TRADE_IMPORTER_MAP_FILES
+#endif
+
+struct AbstractImporter::MappedFile {
+    #ifdef MAGNUM_TRADE_IMPORTER_MAP_FILES
+    Containers::Array<const char, Utility::Path::MapDeleter> data;
+    #endif
+};
+
 AbstractImporter::AbstractImporter() = default;
 
 AbstractImporter::AbstractImporter(PluginManager::Manager<AbstractImporter>& manager): PluginManager::AbstractManagingPlugin<AbstractImporter>{manager} {}
 
 AbstractImporter::AbstractImporter(PluginManager::AbstractManager& manager, const Containers::StringView& plugin): PluginManager::AbstractManagingPlugin<AbstractImporter>{manager, plugin} {}
 
-#ifdef MAGNUM_BUILD_DEPRECATED
-/* These twp needed because of the Array<CachedScenes> member */
+/* These two needed because of the Pointer<MappedFile> and
+   Pointer<CachedScenes> members */
 AbstractImporter::AbstractImporter(AbstractImporter&&) noexcept = default;
 AbstractImporter::~AbstractImporter() = default;
-#endif
 
 void AbstractImporter::setFlags(ImporterFlags flags) {
     CORRADE_ASSERT(!isOpened(),
@@ -140,6 +157,10 @@ void AbstractImporter::clearFlags(ImporterFlags flags) {
     setFlags(_flags & ~flags);
 }
 
+Containers::Array<char> AbstractImporter::allocateData(const std::size_t size) {
+    return _dataArena ? _dataArena->allocate(size) : Containers::Array<char>{NoInit, size};
+}
+
 void AbstractImporter::setFileCallback(Containers::Optional<Containers::ArrayView<const char>>(*callback)(const std::string&, InputFileCallbackPolicy, void*), void* const userData) {
     CORRADE_ASSERT(!isOpened(), "Trade::AbstractImporter::setFileCallback(): can't be set while a file is opened", );
     CORRADE_ASSERT(features() & (ImporterFeature::FileCallback|ImporterFeature::OpenData), "Trade::AbstractImporter::setFileCallback(): importer supports neither loading from data nor via callbacks, callbacks can't be used", );
@@ -159,6 +180,7 @@ bool AbstractImporter::openData(Containers::ArrayView<const void> data) {
        the check doesn't be done on the plugin side) because for some file
        formats it could be valid (e.g. OBJ or JSON-based formats). */
     close();
+    MAGNUM_PROFILE_SCOPE("Trade::AbstractImporter::openData()");
     doOpenData(Containers::Array<char>{const_cast<char*>(static_cast<const char*>(data.data())), data.size(), Implementation::nonOwnedArrayDeleter}, {});
     return isOpened();
 }
@@ -188,6 +210,7 @@ bool AbstractImporter::openMemory(Containers::ArrayView<const void> memory) {
        the check doesn't be done on the plugin side) because for some file
        formats it could be valid (e.g. OBJ or JSON-based formats). */
     close();
+    MAGNUM_PROFILE_SCOPE("Trade::AbstractImporter::openMemory()");
     doOpenData(Containers::Array<char>{const_cast<char*>(static_cast<const char*>(memory.data())), memory.size(), Implementation::nonOwnedArrayDeleter}, DataFlag::ExternallyOwned);
     return isOpened();
 }
@@ -211,6 +234,7 @@ void AbstractImporter::doOpenState(const void*, const Containers::StringView) {
 
 bool AbstractImporter::openFile(const Containers::StringView filename) {
     close();
+    MAGNUM_PROFILE_SCOPE("Trade::AbstractImporter::openFile()");
 
     /* If file loading callbacks are not set or the importer supports handling
        them directly, call into the implementation */
@@ -267,6 +291,26 @@ void AbstractImporter::doOpenFile(const Containers::StringView filename) {
 
     /* Otherwise open the file directly */
     } else {
+        #ifdef MAGNUM_TRADE_IMPORTER_MAP_FILES
+        /* If requested, map the file and keep the mapping alive until close()
+           so the implementation can reference it without copying, same as
+           with openMemory() */
+        if(_flags & ImporterFlag::MapFiles) {
+            Containers::Optional<Containers::Array<const char, Utility::Path::MapDeleter>> data = Utility::Path::mapRead(filename);
+            if(!data) {
+                Error() << "Trade::AbstractImporter::openFile(): cannot open file" << filename;
+                return;
+            }
+
+            _mappedFile.reset(new MappedFile{*std::move(data)});
+            doOpenData(Containers::Array<char>{const_cast<char*>(_mappedFile->data.data()), _mappedFile->data.size(), Implementation::nonOwnedArrayDeleter}, DataFlag::ExternallyOwned);
+
+            /* The mapping isn't needed if the opening failed */
+            if(!isOpened()) _mappedFile = nullptr;
+            return;
+        }
+        #endif
+
         Containers::Optional<Containers::Array<char>> data = Utility::Path::read(filename);
         if(!data) {
             Error() << "Trade::AbstractImporter::openFile(): cannot open file" << filename;
@@ -282,6 +326,10 @@ void AbstractImporter::close() {
         doClose();
         CORRADE_INTERNAL_ASSERT(!isOpened());
     }
+
+    /* Release a file mapped with ImporterFlag::MapFiles only after the
+       implementation is done with it */
+    _mappedFile = nullptr;
 }
 
 Int AbstractImporter::defaultScene() const {
@@ -353,6 +401,7 @@ Containers::String AbstractImporter::doObjectName(UnsignedLong) { return {}; }
 Containers::Optional<SceneData> AbstractImporter::scene(const UnsignedInt id) {
     CORRADE_ASSERT(isOpened(), "Trade::AbstractImporter::scene(): no file opened", {});
     CORRADE_ASSERT(id < doSceneCount(), "Trade::AbstractImporter::scene(): index" << id << "out of range for" << doSceneCount() << "entries", {});
+    MAGNUM_PROFILE_SCOPE("Trade::AbstractImporter::scene()");
     Containers::Optional<SceneData> scene = doScene(id);
     CORRADE_ASSERT(!scene || (
         (!scene->_data.deleter() || scene->_data.deleter() == static_cast<void(*)(char*, std::size_t)>(Implementation::nonOwnedArrayDeleter)) &&
@@ -428,9 +477,10 @@ Containers::String AbstractImporter::doAnimationName(UnsignedInt) { return {}; }
 Containers::Optional<AnimationData> AbstractImporter::animation(const UnsignedInt id) {
     CORRADE_ASSERT(isOpened(), "Trade::AbstractImporter::animation(): no file opened", {});
     CORRADE_ASSERT(id < doAnimationCount(), "Trade::AbstractImporter::animation(): index" << id << "out of range for" << doAnimationCount() << "entries", {});
+    MAGNUM_PROFILE_SCOPE("Trade::AbstractImporter::animation()");
     Containers::Optional<AnimationData> animation = doAnimation(id);
     CORRADE_ASSERT(!animation ||
-        ((!animation->_data.deleter() || animation->_data.deleter() == static_cast<void(*)(char*, std::size_t)>(Implementation::nonOwnedArrayDeleter) || animation->_data.deleter() == ArrayAllocator<char>::deleter) &&
+        ((!animation->_data.deleter() || animation->_data.deleter() == static_cast<void(*)(char*, std::size_t)>(Implementation::nonOwnedArrayDeleter) || animation->_data.deleter() == ArrayAllocator<char>::deleter || animation->_data.deleter() == DataArena::deleter) &&
         (!animation->_tracks.deleter() || animation->_tracks.deleter() == static_cast<void(*)(AnimationTrackData*, std::size_t)>(Implementation::nonOwnedArrayDeleter))),
         "Trade::AbstractImporter::animation(): implementation is not allowed to use a custom Array deleter", {});
     return animation;
@@ -1118,10 +1168,11 @@ Containers::Optional<MeshData> AbstractImporter::mesh(const UnsignedInt id, cons
         CORRADE_ASSERT(level < levelCount, "Trade::AbstractImporter::mesh(): level" << level << "out of range for" << levelCount << "entries", {});
     }
     #endif
+    MAGNUM_PROFILE_SCOPE("Trade::AbstractImporter::mesh()");
     Containers::Optional<MeshData> mesh = doMesh(id, level);
     CORRADE_ASSERT(!mesh || (
-        (!mesh->_indexData.deleter() || mesh->_indexData.deleter() == static_cast<void(*)(char*, std::size_t)>(Implementation::nonOwnedArrayDeleter) || mesh->_indexData.deleter() == ArrayAllocator<char>::deleter) &&
-        (!mesh->_vertexData.deleter() || mesh->_vertexData.deleter() == static_cast<void(*)(char*, std::size_t)>(Implementation::nonOwnedArrayDeleter) || mesh->_vertexData.deleter() == ArrayAllocator<char>::deleter) &&
+        (!mesh->_indexData.deleter() || mesh->_indexData.deleter() == static_cast<void(*)(char*, std::size_t)>(Implementation::nonOwnedArrayDeleter) || mesh->_indexData.deleter() == ArrayAllocator<char>::deleter || mesh->_indexData.deleter() == DataArena::deleter) &&
+        (!mesh->_vertexData.deleter() || mesh->_vertexData.deleter() == static_cast<void(*)(char*, std::size_t)>(Implementation::nonOwnedArrayDeleter) || mesh->_vertexData.deleter() == ArrayAllocator<char>::deleter || mesh->_vertexData.deleter() == DataArena::deleter) &&
         (!mesh->_attributes.deleter() || mesh->_attributes.deleter() == static_cast<void(*)(MeshAttributeData*, std::size_t)>(Implementation::nonOwnedArrayDeleter))),
         "Trade::AbstractImporter::mesh(): implementation is not allowed to use a custom Array deleter", {});
     return mesh;
@@ -1141,6 +1192,118 @@ Containers::Optional<MeshData> AbstractImporter::mesh(const Containers::StringVi
     return mesh(id, level); /* not doMesh(), so we get the checks also */
 }
 
+Containers::Optional<ChunkedMeshData> AbstractImporter::meshChunks(const UnsignedInt id, const UnsignedInt chunkSize, const UnsignedInt level) {
+    CORRADE_ASSERT(isOpened(), "Trade::AbstractImporter::meshChunks(): no file opened", {});
+    CORRADE_ASSERT(id < doMeshCount(), "Trade::AbstractImporter::meshChunks(): index" << id << "out of range for" << doMeshCount() << "entries", {});
+    CORRADE_ASSERT(chunkSize, "Trade::AbstractImporter::meshChunks(): expected a non-zero chunk size", {});
+    #ifndef CORRADE_NO_ASSERT
+    /* Same as in mesh() */
+    if(level) {
+        const UnsignedInt levelCount = doMeshLevelCount(id);
+        CORRADE_ASSERT(levelCount, "Trade::AbstractImporter::meshChunks(): implementation reported zero levels", {});
+        CORRADE_ASSERT(level < levelCount, "Trade::AbstractImporter::meshChunks(): level" << level << "out of range for" << levelCount << "entries", {});
+    }
+    #endif
+    MAGNUM_PROFILE_SCOPE("Trade::AbstractImporter::meshChunks()");
+    Containers::Optional<ChunkedMeshData> chunks = doMeshChunks(id, chunkSize, level);
+    CORRADE_ASSERT(!chunks || !chunks->_chunkBoundData.deleter() || chunks->_chunkBoundData.deleter() == static_cast<void(*)(Range3D*, std::size_t)>(Implementation::nonOwnedArrayDeleter) || chunks->_chunkBoundData.deleter() == ArrayAllocator<Range3D>::deleter,
+        "Trade::AbstractImporter::meshChunks(): implementation is not allowed to use a custom Array deleter", {});
+    CORRADE_ASSERT(!chunks || chunks->chunkSize() == chunkSize,
+        "Trade::AbstractImporter::meshChunks(): implementation returned chunk size" << chunks->chunkSize() << "but expected" << chunkSize, {});
+    return chunks;
+}
+
+Containers::Optional<ChunkedMeshData> AbstractImporter::doMeshChunks(const UnsignedInt id, const UnsignedInt chunkSize, const UnsignedInt level) {
+    Containers::Optional<MeshData> mesh = doMesh(id, level);
+    if(!mesh) return {};
+
+    if(mesh->isIndexed()) {
+        Error{} << "Trade::AbstractImporter::meshChunks(): chunked access to indexed meshes is not supported";
+        return {};
+    }
+    if(!mesh->hasAttribute(MeshAttribute::Position)) {
+        Error{} << "Trade::AbstractImporter::meshChunks(): the mesh has no positions";
+        return {};
+    }
+    if((mesh->primitive() == MeshPrimitive::Lines && chunkSize % 2) ||
+       (mesh->primitive() == MeshPrimitive::Triangles && chunkSize % 3)) {
+        Error{} << "Trade::AbstractImporter::meshChunks(): chunk size" << chunkSize << "doesn't contain whole" << mesh->primitive() << "primitives";
+        return {};
+    }
+
+    /* Decode positions just one chunk at a time to not need a full copy of
+       the position attribute in case it's packed */
+    const UnsignedInt vertexCount = mesh->vertexCount();
+    Containers::Array<Range3D> chunkBounds{NoInit, (vertexCount + std::size_t{chunkSize} - 1)/chunkSize};
+    Containers::Array<Vector3> positions{NoInit, Math::min(vertexCount, chunkSize)};
+    for(std::size_t i = 0; i != chunkBounds.size(); ++i) {
+        const std::size_t offset = i*chunkSize;
+        const Containers::ArrayView<Vector3> chunkPositions = positions.prefix(Math::min(std::size_t{chunkSize}, vertexCount - offset));
+        mesh->positions3DInto(chunkPositions, offset, 0);
+        chunkBounds[i] = Math::minmax(chunkPositions);
+    }
+
+    return ChunkedMeshData{mesh->primitive(), vertexCount, chunkSize, std::move(chunkBounds), mesh->importerState()};
+}
+
+Containers::Optional<MeshData> AbstractImporter::meshChunk(const UnsignedInt id, const UnsignedLong vertexOffset, const UnsignedInt vertexCount, const UnsignedInt level) {
+    CORRADE_ASSERT(isOpened(), "Trade::AbstractImporter::meshChunk(): no file opened", {});
+    CORRADE_ASSERT(id < doMeshCount(), "Trade::AbstractImporter::meshChunk(): index" << id << "out of range for" << doMeshCount() << "entries", {});
+    #ifndef CORRADE_NO_ASSERT
+    /* Same as in mesh() */
+    if(level) {
+        const UnsignedInt levelCount = doMeshLevelCount(id);
+        CORRADE_ASSERT(levelCount, "Trade::AbstractImporter::meshChunk(): implementation reported zero levels", {});
+        CORRADE_ASSERT(level < levelCount, "Trade::AbstractImporter::meshChunk(): level" << level << "out of range for" << levelCount << "entries", {});
+    }
+    #endif
+    MAGNUM_PROFILE_SCOPE("Trade::AbstractImporter::meshChunk()");
+    Containers::Optional<MeshData> mesh = doMeshChunk(id, vertexOffset, vertexCount, level);
+    CORRADE_ASSERT(!mesh || (
+        (!mesh->_indexData.deleter() || mesh->_indexData.deleter() == static_cast<void(*)(char*, std::size_t)>(Implementation::nonOwnedArrayDeleter) || mesh->_indexData.deleter() == ArrayAllocator<char>::deleter || mesh->_indexData.deleter() == DataArena::deleter) &&
+        (!mesh->_vertexData.deleter() || mesh->_vertexData.deleter() == static_cast<void(*)(char*, std::size_t)>(Implementation::nonOwnedArrayDeleter) || mesh->_vertexData.deleter() == ArrayAllocator<char>::deleter || mesh->_vertexData.deleter() == DataArena::deleter) &&
+        (!mesh->_attributes.deleter() || mesh->_attributes.deleter() == static_cast<void(*)(MeshAttributeData*, std::size_t)>(Implementation::nonOwnedArrayDeleter))),
+        "Trade::AbstractImporter::meshChunk(): implementation is not allowed to use a custom Array deleter", {});
+    CORRADE_ASSERT(!mesh || (!mesh->isIndexed() && mesh->vertexCount() == vertexCount),
+        "Trade::AbstractImporter::meshChunk(): implementation returned an indexed mesh or a wrong vertex count", {});
+    return mesh;
+}
+
+Containers::Optional<MeshData> AbstractImporter::doMeshChunk(const UnsignedInt id, const UnsignedLong vertexOffset, const UnsignedInt vertexCount, const UnsignedInt level) {
+    Containers::Optional<MeshData> mesh = doMesh(id, level);
+    if(!mesh) return {};
+
+    if(mesh->isIndexed()) {
+        Error{} << "Trade::AbstractImporter::meshChunk(): chunked access to indexed meshes is not supported";
+        return {};
+    }
+    if(vertexOffset + vertexCount > mesh->vertexCount()) {
+        Error{} << "Trade::AbstractImporter::meshChunk(): range [" << Debug::nospace << vertexOffset << Debug::nospace << ":" << Debug::nospace << vertexOffset + vertexCount << Debug::nospace << "] out of bounds for" << mesh->vertexCount() << "vertices";
+        return {};
+    }
+
+    /* Copy each attribute into its own tightly packed block. Implementation-
+       specific formats and array attributes are handled transparently as
+       the copy is done on the raw bytes. */
+    std::size_t vertexDataSize = 0;
+    for(UnsignedInt i = 0; i != mesh->attributeCount(); ++i)
+        vertexDataSize += std::size_t{vertexCount}*mesh->attribute(i).size()[1];
+
+    Containers::Array<char> vertexData{NoInit, vertexDataSize};
+    Containers::Array<MeshAttributeData> attributes{mesh->attributeCount()};
+    std::size_t offset = 0;
+    for(UnsignedInt i = 0; i != mesh->attributeCount(); ++i) {
+        const Containers::StridedArrayView2D<const char> src = mesh->attribute(i).sliceSize(vertexOffset, vertexCount);
+        const std::size_t size = src.size()[1];
+        const Containers::StridedArrayView2D<char> dst{vertexData.sliceSize(offset, vertexCount*size), {vertexCount, size}};
+        Utility::copy(src, dst);
+        attributes[i] = MeshAttributeData{mesh->attributeName(i), mesh->attributeFormat(i), Containers::StridedArrayView1D<const void>{vertexData, vertexData.data() + offset, vertexCount, std::ptrdiff_t(size)}, mesh->attributeArraySize(i)};
+        offset += vertexCount*size;
+    }
+
+    return MeshData{mesh->primitive(), std::move(vertexData), std::move(attributes), vertexCount, mesh->importerState()};
+}
+
 MeshAttribute AbstractImporter::meshAttributeForName(const Containers::StringView name) {
     const MeshAttribute out = doMeshAttributeForName(name);
     CORRADE_ASSERT(out == MeshAttribute{} || isMeshAttributeCustom(out),
@@ -1290,6 +1453,7 @@ AbstractImporter::material(const UnsignedInt id) {
     CORRADE_ASSERT(isOpened(), "Trade::AbstractImporter::material(): no file opened", {});
     CORRADE_ASSERT(id < doMaterialCount(), "Trade::AbstractImporter::material(): index" << id << "out of range for" << doMaterialCount() << "entries", {});
 
+    MAGNUM_PROFILE_SCOPE("Trade::AbstractImporter::material()");
     Containers::Optional<MaterialData> material = doMaterial(id);
     CORRADE_ASSERT(!material || (
         (!material->_data.deleter() || material->_data.deleter() == static_cast<void(*)(MaterialAttributeData*, std::size_t)>(Implementation::nonOwnedArrayDeleter)) &&
@@ -1424,8 +1588,9 @@ Containers::Optional<ImageData1D> AbstractImporter::image1D(const UnsignedInt id
         CORRADE_ASSERT(level < levelCount, "Trade::AbstractImporter::image1D(): level" << level << "out of range for" << levelCount << "entries", {});
     }
     #endif
+    MAGNUM_PROFILE_SCOPE("Trade::AbstractImporter::image1D()");
     Containers::Optional<ImageData1D> image = doImage1D(id, level);
-    CORRADE_ASSERT(!image || !image->_data.deleter() || image->_data.deleter() == static_cast<void(*)(char*, std::size_t)>(Implementation::nonOwnedArrayDeleter) || image->_data.deleter() == ArrayAllocator<char>::deleter, "Trade::AbstractImporter::image1D(): implementation is not allowed to use a custom Array deleter", {});
+    CORRADE_ASSERT(!image || !image->_data.deleter() || image->_data.deleter() == static_cast<void(*)(char*, std::size_t)>(Implementation::nonOwnedArrayDeleter) || image->_data.deleter() == ArrayAllocator<char>::deleter || image->_data.deleter() == DataArena::deleter, "Trade::AbstractImporter::image1D(): implementation is not allowed to use a custom Array deleter", {});
     return image;
 }
 
@@ -1497,8 +1662,9 @@ Containers::Optional<ImageData2D> AbstractImporter::image2D(const UnsignedInt id
         CORRADE_ASSERT(level < levelCount, "Trade::AbstractImporter::image2D(): level" << level << "out of range for" << levelCount << "entries", {});
     }
     #endif
+    MAGNUM_PROFILE_SCOPE("Trade::AbstractImporter::image2D()");
     Containers::Optional<ImageData2D> image = doImage2D(id, level);
-    CORRADE_ASSERT(!image || !image->_data.deleter() || image->_data.deleter() == static_cast<void(*)(char*, std::size_t)>(Implementation::nonOwnedArrayDeleter) || image->_data.deleter() == ArrayAllocator<char>::deleter, "Trade::AbstractImporter::image2D(): implementation is not allowed to use a custom Array deleter", {});
+    CORRADE_ASSERT(!image || !image->_data.deleter() || image->_data.deleter() == static_cast<void(*)(char*, std::size_t)>(Implementation::nonOwnedArrayDeleter) || image->_data.deleter() == ArrayAllocator<char>::deleter || image->_data.deleter() == DataArena::deleter, "Trade::AbstractImporter::image2D(): implementation is not allowed to use a custom Array deleter", {});
     return image;
 }
 
@@ -1517,6 +1683,69 @@ Containers::Optional<ImageData2D> AbstractImporter::image2D(const Containers::St
     return image2D(id, level);
 }
 
+Containers::Optional<Vector2i> AbstractImporter::image2DSize(const UnsignedInt id, const UnsignedInt level) {
+    CORRADE_ASSERT(isOpened(), "Trade::AbstractImporter::image2DSize(): no file opened", {});
+    CORRADE_ASSERT(id < doImage2DCount(), "Trade::AbstractImporter::image2DSize(): index" << id << "out of range for" << doImage2DCount() << "entries", {});
+    #ifndef CORRADE_NO_ASSERT
+    /* See image2D() for why this is checked only for nonzero levels */
+    if(level) {
+        const UnsignedInt levelCount = doImage2DLevelCount(id);
+        CORRADE_ASSERT(levelCount, "Trade::AbstractImporter::image2DSize(): implementation reported zero levels", {});
+        CORRADE_ASSERT(level < levelCount, "Trade::AbstractImporter::image2DSize(): level" << level << "out of range for" << levelCount << "entries", {});
+    }
+    #endif
+    return doImage2DSize(id, level);
+}
+
+Containers::Optional<Vector2i> AbstractImporter::doImage2DSize(const UnsignedInt id, const UnsignedInt level) {
+    Containers::Optional<ImageData2D> image = doImage2D(id, level);
+    if(!image) return {};
+    return image->size();
+}
+
+Containers::Optional<ImageData2D> AbstractImporter::image2DRows(const UnsignedInt id, const UnsignedInt level, const Range1Dui& rows) {
+    CORRADE_ASSERT(isOpened(), "Trade::AbstractImporter::image2DRows(): no file opened", {});
+    CORRADE_ASSERT(id < doImage2DCount(), "Trade::AbstractImporter::image2DRows(): index" << id << "out of range for" << doImage2DCount() << "entries", {});
+    CORRADE_ASSERT(rows.min() <= rows.max(), "Trade::AbstractImporter::image2DRows(): expected a non-inverted row range, got" << rows.min() << "to" << rows.max(), {});
+    #ifndef CORRADE_NO_ASSERT
+    /* See image2D() for why this is checked only for nonzero levels */
+    if(level) {
+        const UnsignedInt levelCount = doImage2DLevelCount(id);
+        CORRADE_ASSERT(levelCount, "Trade::AbstractImporter::image2DRows(): implementation reported zero levels", {});
+        CORRADE_ASSERT(level < levelCount, "Trade::AbstractImporter::image2DRows(): level" << level << "out of range for" << levelCount << "entries", {});
+    }
+    #endif
+    MAGNUM_PROFILE_SCOPE("Trade::AbstractImporter::image2DRows()");
+    Containers::Optional<ImageData2D> image = doImage2DRows(id, level, rows);
+    CORRADE_ASSERT(!image || !image->_data.deleter() || image->_data.deleter() == static_cast<void(*)(char*, std::size_t)>(Implementation::nonOwnedArrayDeleter) || image->_data.deleter() == ArrayAllocator<char>::deleter || image->_data.deleter() == DataArena::deleter, "Trade::AbstractImporter::image2DRows(): implementation is not allowed to use a custom Array deleter", {});
+    return image;
+}
+
+Containers::Optional<ImageData2D> AbstractImporter::doImage2DRows(const UnsignedInt id, const UnsignedInt level, const Range1Dui& rows) {
+    Containers::Optional<ImageData2D> image = doImage2D(id, level);
+    if(!image) return {};
+
+    if(image->isCompressed()) {
+        Error{} << "Trade::AbstractImporter::image2DRows(): compressed images are not supported";
+        return {};
+    }
+
+    if(rows.max() > UnsignedInt(image->size().y())) {
+        Error{} << "Trade::AbstractImporter::image2DRows(): rows" << rows.min() << "to" << rows.max() << "out of range for an image of" << image->size().y() << "rows";
+        return {};
+    }
+
+    /* Keep the alignment of the original, drop everything else from the
+       storage as the output is tightly packed */
+    const Vector2i size{image->size().x(), Int(rows.size())};
+    const Int alignment = image->storage().alignment();
+    const std::size_t rowStride = (size.x()*image->pixelSize() + alignment - 1)/alignment*alignment;
+    Containers::Array<char> data{ValueInit, rowStride*size.y()};
+    ImageData2D out{PixelStorage{}.setAlignment(alignment), image->format(), image->formatExtra(), image->pixelSize(), size, std::move(data), image->flags()};
+    Utility::copy(image->pixels().sliceSize({rows.min(), 0, 0}, {rows.size(), std::size_t(size.x()), image->pixelSize()}), out.mutablePixels());
+    return Containers::optional(std::move(out));
+}
+
 UnsignedInt AbstractImporter::image3DCount() const {
     CORRADE_ASSERT(isOpened(), "Trade::AbstractImporter::image3DCount(): no file opened", {});
     return doImage3DCount();
@@ -1570,8 +1799,9 @@ Containers::Optional<ImageData3D> AbstractImporter::image3D(const UnsignedInt id
         CORRADE_ASSERT(level < levelCount, "Trade::AbstractImporter::image3D(): level" << level << "out of range for" << levelCount << "entries", {});
     }
     #endif
+    MAGNUM_PROFILE_SCOPE("Trade::AbstractImporter::image3D()");
     Containers::Optional<ImageData3D> image = doImage3D(id, level);
-    CORRADE_ASSERT(!image || !image->_data.deleter() || image->_data.deleter() == static_cast<void(*)(char*, std::size_t)>(Implementation::nonOwnedArrayDeleter) || image->_data.deleter() == ArrayAllocator<char>::deleter, "Trade::AbstractImporter::image3D(): implementation is not allowed to use a custom Array deleter", {});
+    CORRADE_ASSERT(!image || !image->_data.deleter() || image->_data.deleter() == static_cast<void(*)(char*, std::size_t)>(Implementation::nonOwnedArrayDeleter) || image->_data.deleter() == ArrayAllocator<char>::deleter || image->_data.deleter() == DataArena::deleter, "Trade::AbstractImporter::image3D(): implementation is not allowed to use a custom Array deleter", {});
     return image;
 }
 
@@ -1606,6 +1836,7 @@ Debug& operator<<(Debug& debug, const ImporterFeature value) {
         _c(OpenData)
         _c(OpenState)
         _c(FileCallback)
+        _c(ThreadSafeImport)
         #undef _c
         /* LCOV_EXCL_STOP */
     }
@@ -1617,7 +1848,8 @@ Debug& operator<<(Debug& debug, const ImporterFeatures value) {
     return Containers::enumSetDebugOutput(debug, value, "Trade::ImporterFeatures{}", {
         ImporterFeature::OpenData,
         ImporterFeature::OpenState,
-        ImporterFeature::FileCallback});
+        ImporterFeature::FileCallback,
+        ImporterFeature::ThreadSafeImport});
 }
 
 Debug& operator<<(Debug& debug, const ImporterFlag value) {
@@ -1627,6 +1859,7 @@ Debug& operator<<(Debug& debug, const ImporterFlag value) {
         /* LCOV_EXCL_START */
         #define _c(v) case ImporterFlag::v: return debug << "::" #v;
         _c(Verbose)
+        _c(MapFiles)
         #undef _c
         /* LCOV_EXCL_STOP */
     }
@@ -1636,7 +1869,8 @@ Debug& operator<<(Debug& debug, const ImporterFlag value) {
 
 Debug& operator<<(Debug& debug, const ImporterFlags value) {
     return Containers::enumSetDebugOutput(debug, value, "Trade::ImporterFlags{}", {
-        ImporterFlag::Verbose});
+        ImporterFlag::Verbose,
+        ImporterFlag::MapFiles});
 }
 
 }}
@@ -30,6 +30,7 @@
  */
 
 #include <Corrade/Containers/EnumSet.h>
+#include <Corrade/Containers/Pointer.h>
 #include <Corrade/PluginManager/AbstractManagingPlugin.h>
 #include <Corrade/Utility/StlForwardString.h> /** @todo remove once file callbacks are std::string-free */
 
@@ -72,7 +73,18 @@ enum class ImporterFeature: UnsignedByte {
      * See @ref Trade-AbstractImporter-usage-callbacks and particular importer
      * documentation for more information.
      */
-    FileCallback = 1 << 2
+    FileCallback = 1 << 2,
+
+    /**
+     * Once a file is opened, @ref AbstractImporter::mesh() and
+     * @ref AbstractImporter::image2D() can be called concurrently from
+     * multiple threads on the same importer instance. Other functions,
+     * including opening and closing a file, still have to be serialized. Used
+     * by @ref parallelLoadMeshes() and @ref parallelLoadImages2D() to decide
+     * whether to fan the work out to multiple threads.
+     * @m_since_latest
+     */
+    ThreadSafeImport = 1 << 3
 };
 
 /**
@@ -117,6 +129,33 @@ enum class ImporterFlag: UnsignedByte {
      */
     Verbose = 1 << 0,
 
+    /**
+     * Memory-map files opened with @ref AbstractImporter::openFile() instead
+     * of reading them into a newly allocated array. The file is then passed
+     * to @ref AbstractImporter::doOpenData() with
+     * @ref DataFlag::ExternallyOwned, same as with
+     * @ref AbstractImporter::openMemory(), and the mapping is kept alive until
+     * @ref AbstractImporter::close() is called, another file is opened or the
+     * importer is destroyed. Importers that operate directly on externally
+     * owned memory can then avoid a copy of the file contents altogether,
+     * reducing both the load time and peak memory use for large files.
+     *
+     * Data returned from such importers may reference the mapped file and be
+     * marked as @ref DataFlag::ExternallyOwned, in which case they're valid
+     * only until the importer gets closed. If the data need to outlive the
+     * importer, map the file yourself and pass it to
+     * @ref AbstractImporter::openMemory() instead.
+     *
+     * The flag has an effect only if the importer supports
+     * @ref ImporterFeature::OpenData, doesn't implement its own file loading
+     * and no file callback is set via
+     * @ref AbstractImporter::setFileCallback(). On platforms without
+     * memory-mapping support, such as @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten",
+     * the file is read the usual way.
+     * @m_since_latest
+     */
+    MapFiles = 1 << 1,
+
     /** @todo ~~Y flip~~ Y up for images, "I want to import just once, don't copy" ... */
 };
 
@@ -187,6 +226,8 @@ ID of a texture it uses). The following kinds of data can be imported:
     @ref meshCount(). Similarly as with images, each mesh can also have
     multiple levels (LODs or for example separate edge/face data), which are
     requested through the second parameter up to @ref meshLevelCount().
+    Large non-indexed meshes can be alternatively accessed in fixed-size
+    vertex chunks through @ref meshChunks() and @ref meshChunk().
 -   @ref SceneData using @ref scene(UnsignedInt) up to @ref sceneCount(), with
     the default scene index exposed through @ref defaultScene(). A scene then
     contains all data for its objects such as transformations and parent/child
@@ -419,7 +460,8 @@ checked by the implementation:
     As @ref Trade-AbstractImporter-data-dependency "mentioned above",
     @relativeref{Corrade,Containers::Array} instances returned from plugin
     implementations are not allowed to use anything else than the default
-    deleter or the deleter used by @ref Trade::ArrayAllocator, otherwise this
+    deleter, the deleter used by @ref Trade::ArrayAllocator or
+    @ref DataArena::deleter() via @ref allocateData(), otherwise this
     could cause dangling function pointer call on array destruction if the
     plugin gets unloaded before the array is destroyed. This is asserted by the
     base implementation on return.
@@ -484,10 +526,10 @@ class MAGNUM_TRADE_EXPORT AbstractImporter: public PluginManager::AbstractManagi
            header. */
         explicit AbstractImporter(PluginManager::AbstractManager& manager, const Containers::StringView& plugin);
 
-        #if defined(MAGNUM_BUILD_DEPRECATED) && !defined(DOXYGEN_GENERATING_OUTPUT)
-        /* These twp needed because of the Array<CachedScenes> member
-           (AnyImageImporter relies on the move), move assignment disabled by
-           AbstractPlugin already */
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        /* These two needed because of the Pointer<MappedFile> and
+           Pointer<CachedScenes> members (AnyImageImporter relies on the move),
+           move assignment disabled by AbstractPlugin already */
         AbstractImporter(AbstractImporter&&) noexcept;
         ~AbstractImporter();
         #endif
@@ -626,6 +668,29 @@ class MAGNUM_TRADE_EXPORT AbstractImporter: public PluginManager::AbstractManagi
         template<class Callback, class T> void setFileCallback(Callback callback, T& userData);
         #endif
 
+        /**
+         * @brief Data arena
+         * @m_since_latest
+         *
+         * @see @ref setDataArena()
+         */
+        DataArena* dataArena() const { return _dataArena; }
+
+        /**
+         * @brief Set data arena
+         * @m_since_latest
+         *
+         * If set, importers that support it allocate index, vertex and pixel
+         * data of returned @ref MeshData and @ref ImageData instances from
+         * @p arena instead of allocating each array separately, see
+         * @ref DataArena for more information. The arena is expected to stay
+         * in scope for as long as any data allocated from it, which is
+         * usually longer than the importer itself. Pass @cpp nullptr @ce to
+         * go back to regular allocations, which is also the default.
+         * @see @ref allocateData()
+         */
+        void setDataArena(DataArena* arena) { _dataArena = arena; }
+
         /**
          * @brief Whether any file is opened
          *
@@ -1298,6 +1363,55 @@ class MAGNUM_TRADE_EXPORT AbstractImporter: public PluginManager::AbstractManagi
          */
         Containers::Optional<MeshData> mesh(Containers::StringView name, UnsignedInt level = 0);
 
+        /**
+         * @brief Mesh chunk layout
+         * @param id        Mesh ID, from range [0, @ref meshCount()).
+         * @param chunkSize Vertex count in each chunk
+         * @param level     Mesh level, from range [0, @ref meshLevelCount())
+         * @m_since_latest
+         *
+         * Returns a layout of the mesh split into chunks of @p chunkSize
+         * vertices together with position bounds of each chunk. Vertex data
+         * of particular chunks can be then retrieved with @ref meshChunk().
+         * Expects that a file is opened, that @p chunkSize is non-zero and
+         * that it's a multiple of two for @ref MeshPrimitive::Lines and a
+         * multiple of three for @ref MeshPrimitive::Triangles.
+         *
+         * On failure, or if the mesh is indexed or doesn't have a
+         * @ref MeshAttribute::Position, prints a message to
+         * @relativeref{Magnum,Error} and returns @ref Containers::NullOpt.
+         * Importers that don't implement chunked access natively fall back to
+         * importing the whole mesh with @ref mesh(UnsignedInt, UnsignedInt),
+         * which works but doesn't bound the memory use.
+         * @see @ref ChunkedMeshData::chunkVertexOffset(),
+         *      @ref ChunkedMeshData::chunkVertexCount()
+         */
+        Containers::Optional<ChunkedMeshData> meshChunks(UnsignedInt id, UnsignedInt chunkSize, UnsignedInt level = 0);
+
+        /**
+         * @brief Mesh vertex range
+         * @param id            Mesh ID, from range [0, @ref meshCount()).
+         * @param vertexOffset  Offset of the first vertex
+         * @param vertexCount   Vertex count
+         * @param level         Mesh level, from range
+         *      [0, @ref meshLevelCount())
+         * @m_since_latest
+         *
+         * Returns a non-indexed mesh containing only vertices in range
+         * @cpp [vertexOffset, vertexOffset + vertexCount) @ce, usually a
+         * single chunk as described by @ref meshChunks(). Expects that a file
+         * is opened.
+         *
+         * On failure, or if the mesh is indexed or the range is out of
+         * bounds, prints a message to @relativeref{Magnum,Error} and returns
+         * @ref Containers::NullOpt. Importers that don't implement chunked
+         * access natively fall back to importing the whole mesh with
+         * @ref mesh(UnsignedInt, UnsignedInt) and copying the range out of
+         * it, with each attribute stored non-interleaved in the returned
+         * instance.
+         */
+        Containers::Optional<MeshData> meshChunk(UnsignedInt id, UnsignedLong vertexOffset, UnsignedInt vertexCount, UnsignedInt level = 0);
+
         /**
          * @brief Mesh attribute for given name
          * @m_since{2020,06}
@@ -1642,6 +1756,47 @@ class MAGNUM_TRADE_EXPORT AbstractImporter: public PluginManager::AbstractManagi
          */
         Containers::Optional<ImageData2D> image2D(Containers::StringView name, UnsignedInt level = 0);
 
+        /**
+         * @brief Two-dimensional image size
+         * @param id        Image ID, from range [0, @ref image2DCount()).
+         * @param level     Mip level, from range [0, @ref image2DLevelCount())
+         * @m_since_latest
+         *
+         * Meant to be used together with @ref image2DRows() to know the
+         * image dimensions without decoding the whole image. Importers that
+         * can't query the size without decoding import the whole image
+         * through @ref image2D() and return its size. On failure prints a
+         * message to @relativeref{Magnum,Error} and returns
+         * @ref Containers::NullOpt. Expects that a file is opened.
+         */
+        Containers::Optional<Vector2i> image2DSize(UnsignedInt id, UnsignedInt level = 0);
+
+        /**
+         * @brief Range of rows of a two-dimensional image
+         * @param id        Image ID, from range [0, @ref image2DCount()).
+         * @param level     Mip level, from range [0, @ref image2DLevelCount())
+         * @param rows      Row range to import
+         * @m_since_latest
+         *
+         * Returns an image containing just rows from @p rows, with the first
+         * row of the range being the first row of the returned image and
+         * width and pixel format the same as with @ref image2D(). Importers
+         * that implement this natively decode just the requested range,
+         * keeping peak memory use proportional to the range size and not the
+         * whole image, which makes it possible to process huge images in
+         * strips. Otherwise the whole image is imported through
+         * @ref image2D() and the rows copied out, which gives the same result
+         * but no memory savings. Compressed images are not supported.
+         *
+         * On failure, including the case of @p rows not being in bounds of
+         * the image height, prints a message to @relativeref{Magnum,Error}
+         * and returns @ref Containers::NullOpt. Expects that a file is
+         * opened.
+         * @see @ref image2DSize(),
+         *      @ref AbstractImageConverter::beginConvertRowsToFile()
+         */
+        Containers::Optional<ImageData2D> image2DRows(UnsignedInt id, UnsignedInt level, const Range1Dui& rows);
+
         /**
          * @brief Three-dimensional image count
          *
@@ -1746,6 +1901,17 @@ class MAGNUM_TRADE_EXPORT AbstractImporter: public PluginManager::AbstractManagi
          */
         virtual void doOpenFile(Containers::StringView filename);
 
+        /**
+         * @brief Allocate data for a returned instance
+         * @m_since_latest
+         *
+         * Meant to be used by implementations for index, vertex and pixel
+         * data. If @ref dataArena() is set, allocates from it, otherwise
+         * returns a regular @relativeref{Corrade,Containers::Array} with a
+         * default deleter. In both cases the contents are left uninitialized.
+         */
+        Containers::Array<char> allocateData(std::size_t size);
+
     private:
         /** @brief Implementation for @ref features() */
         virtual ImporterFeatures doFeatures() const = 0;
@@ -2227,6 +2393,27 @@ class MAGNUM_TRADE_EXPORT AbstractImporter: public PluginManager::AbstractManagi
          */
         virtual Containers::Optional<MeshData> doMesh(UnsignedInt id, UnsignedInt level);
 
+        /**
+         * @brief Implementation for @ref meshChunks()
+         * @m_since_latest
+         *
+         * Default implementation imports the whole mesh through
+         * @ref doMesh() and calculates position bounds of each chunk from
+         * it. Override to provide chunk bounds without loading all vertex
+         * data.
+         */
+        virtual Containers::Optional<ChunkedMeshData> doMeshChunks(UnsignedInt id, UnsignedInt chunkSize, UnsignedInt level);
+
+        /**
+         * @brief Implementation for @ref meshChunk()
+         * @m_since_latest
+         *
+         * Default implementation imports the whole mesh through
+         * @ref doMesh() and copies the requested vertex range out of it.
+         * Override to read just the requested range.
+         */
+        virtual Containers::Optional<MeshData> doMeshChunk(UnsignedInt id, UnsignedLong vertexOffset, UnsignedInt vertexCount, UnsignedInt level);
+
         /**
          * @brief Implementation for @ref meshAttributeForName()
          * @m_since{2020,06}
@@ -2491,6 +2678,26 @@ class MAGNUM_TRADE_EXPORT AbstractImporter: public PluginManager::AbstractManagi
         /** @brief Implementation for @ref image2D() */
         virtual Containers::Optional<ImageData2D> doImage2D(UnsignedInt id, UnsignedInt level);
 
+        /**
+         * @brief Implementation for @ref image2DSize()
+         * @m_since_latest
+         *
+         * Default implementation imports the image through @ref doImage2D()
+         * and returns its size.
+         */
+        virtual Containers::Optional<Vector2i> doImage2DSize(UnsignedInt id, UnsignedInt level);
+
+        /**
+         * @brief Implementation for @ref image2DRows()
+         * @m_since_latest
+         *
+         * Default implementation imports the whole image through
+         * @ref doImage2D() and copies out the requested rows. The
+         * implementation is expected to check that @p rows are in bounds of
+         * the image height.
+         */
+        virtual Containers::Optional<ImageData2D> doImage2DRows(UnsignedInt id, UnsignedInt level, const Range1Dui& rows);
+
         /**
          * @brief Implementation for @ref image3DCount()
          *
@@ -2531,6 +2738,7 @@ class MAGNUM_TRADE_EXPORT AbstractImporter: public PluginManager::AbstractManagi
         virtual const void* doImporterState() const;
 
         ImporterFlags _flags;
+        DataArena* _dataArena{};
 
         Containers::Optional<Containers::ArrayView<const char>>(*_fileCallback)(const std::string&, InputFileCallbackPolicy, void*){};
         void* _fileCallbackUserData{};
@@ -2542,6 +2750,10 @@ class MAGNUM_TRADE_EXPORT AbstractImporter: public PluginManager::AbstractManagi
         /* GCC 4.8 complains loudly about missing initializers otherwise */
         } _fileCallbackTemplate{nullptr, nullptr};
 
+        /* Used by ImporterFlag::MapFiles, kept alive until close() */
+        struct MappedFile;
+        Containers::Pointer<MappedFile> _mappedFile;
+
         #ifdef MAGNUM_BUILD_DEPRECATED
         struct CachedScenes;
         Containers::Pointer<CachedScenes> _cachedScenes;
@@ -0,0 +1,71 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ChunkedMeshData.h"
+
+#include <Corrade/Utility/Assert.h>
+
+namespace Magnum { namespace Trade {
+
+ChunkedMeshData::ChunkedMeshData(const MeshPrimitive primitive, const UnsignedLong vertexCount, const UnsignedInt chunkSize, Containers::Array<Range3D>&& chunkBoundData, const void* const importerState) noexcept: _primitive{primitive}, _chunkSize{chunkSize}, _vertexCount{vertexCount}, _chunkBoundData{std::move(chunkBoundData)}, _importerState{importerState} {
+    CORRADE_ASSERT(chunkSize,
+        "Trade::ChunkedMeshData: expected a non-zero chunk size", );
+    CORRADE_ASSERT(_chunkBoundData.size() == (vertexCount + chunkSize - 1)/chunkSize,
+        "Trade::ChunkedMeshData: expected" << (vertexCount + chunkSize - 1)/chunkSize << "chunk bounds for" << vertexCount << "vertices and chunk size" << chunkSize << "but got" << _chunkBoundData.size(), );
+}
+
+ChunkedMeshData::ChunkedMeshData(ChunkedMeshData&&) noexcept = default;
+
+ChunkedMeshData::~ChunkedMeshData() = default;
+
+ChunkedMeshData& ChunkedMeshData::operator=(ChunkedMeshData&&) noexcept = default;
+
+UnsignedLong ChunkedMeshData::chunkVertexOffset(const UnsignedInt chunk) const {
+    CORRADE_ASSERT(chunk < _chunkBoundData.size(),
+        "Trade::ChunkedMeshData::chunkVertexOffset(): index" << chunk << "out of range for" << _chunkBoundData.size() << "chunks", {});
+    return UnsignedLong(chunk)*_chunkSize;
+}
+
+UnsignedInt ChunkedMeshData::chunkVertexCount(const UnsignedInt chunk) const {
+    CORRADE_ASSERT(chunk < _chunkBoundData.size(),
+        "Trade::ChunkedMeshData::chunkVertexCount(): index" << chunk << "out of range for" << _chunkBoundData.size() << "chunks", {});
+    return UnsignedInt(Math::min(UnsignedLong(_chunkSize), _vertexCount - UnsignedLong(chunk)*_chunkSize));
+}
+
+Range3D ChunkedMeshData::bounds() const {
+    if(_chunkBoundData.isEmpty()) return {};
+
+    Range3D out = _chunkBoundData[0];
+    for(std::size_t i = 1; i != _chunkBoundData.size(); ++i)
+        out = Math::join(out, _chunkBoundData[i]);
+    return out;
+}
+
+Containers::Array<Range3D> ChunkedMeshData::releaseChunkBoundData() {
+    _vertexCount = 0;
+    return std::move(_chunkBoundData);
+}
+
+}}
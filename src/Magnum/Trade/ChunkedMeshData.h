@@ -0,0 +1,175 @@
+#ifndef Magnum_Trade_ChunkedMeshData_h
+#define Magnum_Trade_ChunkedMeshData_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Trade::ChunkedMeshData
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Trade/Trade.h"
+#include "Magnum/Trade/visibility.h"
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Chunked mesh data
+@m_since_latest
+
+Describes a non-indexed mesh that's too large to be resident in memory at
+once, split into chunks of a fixed vertex count. Only the chunk layout and
+per-chunk bounds are stored, the actual vertex data of each chunk are then
+fetched on demand through @ref AbstractImporter::meshChunk().
+
+@section Trade-ChunkedMeshData-usage Usage
+
+The instance is returned from @ref AbstractImporter::meshChunks(). The
+per-chunk bounds can be used for culling or spatial queries without touching
+the vertex data at all, and operations that don't need to see the whole mesh
+at once --- transformation, flat normal generation or GPU upload --- can be
+then performed chunk by chunk with memory use bounded by @ref chunkSize():
+
+@snippet MagnumTrade.cpp ChunkedMeshData-usage
+
+For @ref MeshPrimitive::Lines and @ref MeshPrimitive::Triangles the chunk size
+is a multiple of the primitive vertex count, so each chunk contains only whole
+primitives.
+@see @ref MeshData, @ref MeshTools::boundingRange(const Trade::ChunkedMeshData&, const Matrix4&)
+*/
+class MAGNUM_TRADE_EXPORT ChunkedMeshData {
+    public:
+        /**
+         * @brief Constructor
+         * @param primitive     Primitive
+         * @param vertexCount   Total vertex count
+         * @param chunkSize     Vertex count in each chunk except for the last
+         * @param chunkBoundData  Position bounds of each chunk
+         * @param importerState Importer-specific state
+         *
+         * The @p chunkSize is expected to be non-zero and the
+         * @p chunkBoundData array is expected to have exactly
+         * @ref chunkCount() items.
+         */
+        explicit ChunkedMeshData(MeshPrimitive primitive, UnsignedLong vertexCount, UnsignedInt chunkSize, Containers::Array<Range3D>&& chunkBoundData, const void* importerState = nullptr) noexcept;
+
+        /** @brief Copying is not allowed */
+        ChunkedMeshData(const ChunkedMeshData&) = delete;
+
+        /** @brief Move constructor */
+        ChunkedMeshData(ChunkedMeshData&&) noexcept;
+
+        ~ChunkedMeshData();
+
+        /** @brief Copying is not allowed */
+        ChunkedMeshData& operator=(const ChunkedMeshData&) = delete;
+
+        /** @brief Move assignment */
+        ChunkedMeshData& operator=(ChunkedMeshData&&) noexcept;
+
+        /** @brief Primitive */
+        MeshPrimitive primitive() const { return _primitive; }
+
+        /**
+         * @brief Total vertex count
+         *
+         * Sum of @ref chunkVertexCount() of all chunks.
+         */
+        UnsignedLong vertexCount() const { return _vertexCount; }
+
+        /**
+         * @brief Chunk size
+         *
+         * Vertex count in every chunk except for the last, which may be
+         * smaller.
+         * @see @ref chunkVertexCount()
+         */
+        UnsignedInt chunkSize() const { return _chunkSize; }
+
+        /** @brief Chunk count */
+        UnsignedInt chunkCount() const { return _chunkBoundData.size(); }
+
+        /**
+         * @brief Offset of the first vertex in given chunk
+         *
+         * Expects that @p chunk is less than @ref chunkCount().
+         */
+        UnsignedLong chunkVertexOffset(UnsignedInt chunk) const;
+
+        /**
+         * @brief Vertex count in given chunk
+         *
+         * Equal to @ref chunkSize() for all chunks except for the last one.
+         * Expects that @p chunk is less than @ref chunkCount().
+         */
+        UnsignedInt chunkVertexCount(UnsignedInt chunk) const;
+
+        /**
+         * @brief Position bounds of all chunks
+         *
+         * The returned array has @ref chunkCount() items.
+         * @see @ref bounds(), @ref releaseChunkBoundData()
+         */
+        Containers::ArrayView<const Range3D> chunkBounds() const { return _chunkBoundData; }
+
+        /**
+         * @brief Position bounds of the whole mesh
+         *
+         * Calculated as a union of all @ref chunkBounds(). If there are no
+         * chunks, returns a default-constructed range.
+         */
+        Range3D bounds() const;
+
+        /**
+         * @brief Release chunk bound data storage
+         *
+         * Releases the ownership of the chunk bound array. The instance then
+         * behaves like if it has no chunks and no vertices.
+         */
+        Containers::Array<Range3D> releaseChunkBoundData();
+
+        /** @brief Importer-specific state */
+        const void* importerState() const { return _importerState; }
+
+    private:
+        /* For custom deleter checks. Not done in the constructors here because
+           the restriction is pointless when used outside of plugin
+           implementations. */
+        friend AbstractImporter;
+
+        MeshPrimitive _primitive;
+        UnsignedInt _chunkSize;
+        UnsignedLong _vertexCount;
+        Containers::Array<Range3D> _chunkBoundData;
+        const void* _importerState;
+};
+
+}}
+
+#endif
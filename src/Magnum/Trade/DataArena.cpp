@@ -0,0 +1,131 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "DataArena.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <Corrade/Containers/GrowableArray.h>
+
+namespace Magnum { namespace Trade {
+
+struct DataArena::State {
+    explicit State(std::size_t blockSize): blockSize{blockSize} {}
+
+    std::size_t blockSize;
+    Containers::Array<Containers::Array<char>> blocks;
+    /* Block that's currently allocated from and an offset in it */
+    std::size_t currentBlock{};
+    std::size_t offset{};
+    /* Size used in all blocks before the current one */
+    std::size_t previousBlocksUsedSize{};
+    /* Decremented from deleter(), which can run on any thread */
+    std::atomic<std::size_t> allocationCount{};
+};
+
+void DataArena::deleter(char* const data, std::size_t) {
+    /* The state pointer is stored right before the data */
+    State* state;
+    std::memcpy(&state, data - sizeof(State*), sizeof(State*));
+    --state->allocationCount;
+}
+
+DataArena::DataArena(const std::size_t blockSize): _state{InPlaceInit, blockSize} {}
+
+DataArena::DataArena(DataArena&&) noexcept = default;
+
+DataArena::~DataArena() {
+    /* Moved-out instance */
+    if(!_state) return;
+
+    CORRADE_ASSERT(!_state->allocationCount,
+        "Trade::DataArena: destroyed while" << _state->allocationCount.load() << "allocations are still alive", );
+}
+
+DataArena& DataArena::operator=(DataArena&&) noexcept = default;
+
+std::size_t DataArena::blockSize() const { return _state->blockSize; }
+
+std::size_t DataArena::blockCount() const { return _state->blocks.size(); }
+
+std::size_t DataArena::usedSize() const {
+    return _state->previousBlocksUsedSize + _state->offset;
+}
+
+std::size_t DataArena::allocationCount() const {
+    return _state->allocationCount;
+}
+
+Containers::Array<char> DataArena::allocate(const std::size_t size, std::size_t alignment) {
+    CORRADE_ASSERT(alignment && !(alignment & (alignment - 1)),
+        "Trade::DataArena::allocate(): expected alignment to be a power of two, got" << alignment, {});
+
+    /* The header with the state pointer has to be aligned as well */
+    if(alignment < alignof(State*)) alignment = alignof(State*);
+
+    State& state = *_state;
+
+    /* Find the first block from the current one that has enough space. Each
+       block is allocated with new[] so its start is aligned at least to
+       alignof(State*), so the worst case padding is alignment - 1. */
+    const std::size_t worstCaseSize = sizeof(State*) + alignment - 1 + size;
+    for(; state.currentBlock < state.blocks.size(); ++state.currentBlock) {
+        if(state.offset + worstCaseSize <= state.blocks[state.currentBlock].size())
+            break;
+
+        state.previousBlocksUsedSize += state.offset;
+        state.offset = 0;
+    }
+
+    /* None found, allocate a new one */
+    if(state.currentBlock == state.blocks.size())
+        arrayAppend(state.blocks, InPlaceInit, NoInit, worstCaseSize > state.blockSize ? worstCaseSize : state.blockSize);
+
+    char* const block = state.blocks[state.currentBlock];
+    const std::size_t headerOffset = state.offset;
+    const std::uintptr_t dataAddress = (reinterpret_cast<std::uintptr_t>(block + headerOffset + sizeof(State*)) + alignment - 1) & ~std::uintptr_t(alignment - 1);
+    char* const data = reinterpret_cast<char*>(dataAddress);
+
+    /* Save the state pointer right before the data for use in deleter() */
+    State* const statePointer = &state;
+    std::memcpy(data - sizeof(State*), &statePointer, sizeof(State*));
+
+    state.offset = std::size_t(data + size - block);
+    ++state.allocationCount;
+    return Containers::Array<char>{data, size, deleter};
+}
+
+DataArena& DataArena::reset() {
+    CORRADE_ASSERT(!_state->allocationCount,
+        "Trade::DataArena::reset():" << _state->allocationCount.load() << "allocations are still alive", *this);
+
+    _state->currentBlock = 0;
+    _state->offset = 0;
+    _state->previousBlocksUsedSize = 0;
+    return *this;
+}
+
+}}
@@ -0,0 +1,166 @@
+#ifndef Magnum_Trade_DataArena_h
+#define Magnum_Trade_DataArena_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Trade::DataArena
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Trade/Trade.h"
+#include "Magnum/Trade/visibility.h"
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Bump allocator for imported data
+@m_since_latest
+
+Hands out @relativeref{Corrade,Containers,Array} instances carved out of
+large memory blocks, advancing a single offset on each allocation. Destroying
+an array doesn't make its memory available again, instead the whole arena is
+recycled at once with @ref reset() when all data from it are no longer needed.
+Compared to allocating each array separately with @cpp new[] @ce or
+@ref std::malloc() there's no per-allocation bookkeeping and no contention on
+the global allocator lock, which makes a per-thread arena suitable for loading
+many assets in parallel:
+
+@snippet MagnumTrade.cpp DataArena
+
+The arena can be passed to @ref AbstractImporter::setDataArena(), after which
+importers that support it allocate index, vertex and pixel data from it. The
+@ref MeshTools::owned(const Trade::MeshData&, Trade::DataArena&) overload
+copies an existing mesh into an arena as well.
+
+@section Trade-DataArena-lifetime Array lifetime
+
+The returned arrays use @ref deleter(), which is defined in the @ref Trade
+library, so they can safely outlive the plugin that created them. The arena
+counts arrays that weren't destroyed yet and both @ref reset() and the
+destructor expect that there are none, as their memory would be reused or
+freed. The count is updated atomically, so arrays can be destroyed from any
+thread, however @ref allocate() and @ref reset() can't be called from multiple
+threads at once.
+*/
+class MAGNUM_TRADE_EXPORT DataArena {
+    public:
+        /**
+         * @brief Deleter used by arrays allocated from an arena
+         *
+         * Only decrements the count of live allocations, the memory is
+         * released by @ref reset() or by destroying the arena.
+         */
+        static void deleter(char* data, std::size_t size);
+
+        /**
+         * @brief Constructor
+         * @param blockSize     Size of a memory block in bytes
+         *
+         * The memory is allocated lazily on the first call to
+         * @ref allocate(). Allocations larger than @p blockSize get a
+         * dedicated block.
+         */
+        explicit DataArena(std::size_t blockSize = 1024*1024);
+
+        /** @brief Copying is not allowed */
+        DataArena(const DataArena&) = delete;
+
+        /**
+         * @brief Move constructor
+         *
+         * Arrays allocated from the original instance stay valid.
+         */
+        DataArena(DataArena&&) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Expects that all arrays allocated from the arena are destroyed.
+         */
+        ~DataArena();
+
+        /** @brief Copying is not allowed */
+        DataArena& operator=(const DataArena&) = delete;
+
+        /** @brief Move assignment */
+        DataArena& operator=(DataArena&&) noexcept;
+
+        /** @brief Size of a memory block in bytes */
+        std::size_t blockSize() const;
+
+        /**
+         * @brief Count of allocated memory blocks
+         *
+         * Blocks are kept across @ref reset() calls.
+         */
+        std::size_t blockCount() const;
+
+        /**
+         * @brief Count of bytes used since the last reset
+         *
+         * Includes alignment padding and a per-allocation header.
+         */
+        std::size_t usedSize() const;
+
+        /**
+         * @brief Count of arrays that weren't destroyed yet
+         *
+         * Incremented in @ref allocate(), decremented in @ref deleter().
+         */
+        std::size_t allocationCount() const;
+
+        /**
+         * @brief Allocate an array
+         * @param size      Size in bytes
+         * @param alignment Alignment, expected to be a power of two
+         *
+         * The contents are left uninitialized. The returned array uses
+         * @ref deleter() and has to be destroyed before the arena is reset or
+         * destroyed.
+         */
+        Containers::Array<char> allocate(std::size_t size, std::size_t alignment = 16);
+
+        /**
+         * @brief Reset the arena
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that all arrays allocated from the arena were destroyed.
+         * Makes the whole memory available for subsequent allocations without
+         * freeing the blocks.
+         */
+        DataArena& reset();
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
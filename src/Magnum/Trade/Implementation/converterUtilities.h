@@ -27,6 +27,10 @@
 
 #include <chrono>
 #include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/Utility/Path.h>
 
 #include "Magnum/Trade/AbstractImporter.h"
 #include "Magnum/Trade/ImageData.h"
@@ -155,6 +159,61 @@ Containers::Array<ImageInfo> imageInfo(AbstractImporter& importer, bool& error,
     return infos;
 }
 
+/* A single input / output pair of a --batch conversion, together with its
+   timing and outcome */
+struct BatchEntry {
+    Containers::String input, output;
+    /* Wow, C++, you suck. This implicitly initializes to random shit?! */
+    std::chrono::high_resolution_clock::duration importTime{}, conversionTime{};
+    bool succeeded;
+};
+
+/* Parses a --batch manifest. Each non-empty line that doesn't start with #
+   contains a whitespace-separated input and output filename. */
+Containers::Optional<Containers::Array<BatchEntry>> parseBatchManifest(const Containers::StringView filename) {
+    const Containers::Optional<Containers::String> manifest = Utility::Path::readString(filename);
+    if(!manifest) {
+        Error{} << "Cannot read the batch manifest" << filename;
+        return {};
+    }
+
+    Containers::Array<BatchEntry> entries;
+    const Containers::Array<Containers::StringView> lines = manifest->split('\n');
+    for(std::size_t i = 0; i != lines.size(); ++i) {
+        const Containers::StringView line = lines[i].trimmed();
+        if(line.isEmpty() || line.hasPrefix('#')) continue;
+
+        const Containers::Array<Containers::StringView> files = line.splitOnWhitespaceWithoutEmpty();
+        if(files.size() != 2) {
+            Error{} << "Invalid batch manifest line" << i + 1 << "in" << filename << Debug::nospace << ", expected an input and an output file but got" << line;
+            return {};
+        }
+
+        arrayAppend(entries, BatchEntry{files[0], files[1], {}, {}, false});
+    }
+
+    return Containers::optional(std::move(entries));
+}
+
+/* Prints per-file timings in the manifest order and a total, returns the
+   count of failed entries */
+std::size_t printBatchProfile(const Containers::ArrayView<const BatchEntry> entries, const std::size_t workerCount, const std::chrono::high_resolution_clock::duration totalTime, const bool profile) {
+    std::size_t failed = 0;
+    for(const BatchEntry& entry: entries) {
+        if(!entry.succeeded) ++failed;
+        if(!profile) continue;
+
+        Debug d;
+        d << entry.input << Debug::nospace << ": import took" << UnsignedInt(std::chrono::duration_cast<std::chrono::milliseconds>(entry.importTime).count())/1.0e3f << "seconds, conversion" << UnsignedInt(std::chrono::duration_cast<std::chrono::milliseconds>(entry.conversionTime).count())/1.0e3f << "seconds";
+        if(!entry.succeeded) d << "(failed)";
+    }
+
+    if(profile)
+        Debug{} << "Converted" << entries.size() - failed << "out of" << entries.size() << "files with" << workerCount << "workers in" << UnsignedInt(std::chrono::duration_cast<std::chrono::milliseconds>(totalTime).count())/1.0e3f << "seconds";
+
+    return failed;
+}
+
 }
 
 }}}
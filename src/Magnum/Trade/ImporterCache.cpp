@@ -0,0 +1,180 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ImporterCache.h"
+
+#include <map>
+#include <tuple>
+#include <Corrade/Containers/Optional.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/MaterialData.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace Trade {
+
+namespace {
+
+enum class Type: UnsignedByte {
+    Mesh,
+    Material,
+    Image2D
+};
+
+/* Type, ID and level */
+typedef std::tuple<Type, UnsignedInt, UnsignedInt> Key;
+
+/* Only one of the data is populated, based on the type in the key */
+struct Entry {
+    Containers::Optional<MeshData> mesh;
+    Containers::Optional<MaterialData> material;
+    Containers::Optional<ImageData2D> image2D;
+    std::size_t size;
+    UnsignedLong lastUsed;
+};
+
+}
+
+struct ImporterCache::State {
+    explicit State(AbstractImporter& importer, std::size_t budget): importer(importer), budget{budget} {}
+
+    /* Returns a cached entry and marks it as most recently used, or nullptr
+       if not cached */
+    Entry* find(const Key& key) {
+        const auto found = entries.find(key);
+        if(found == entries.end()) return nullptr;
+        found->second.lastUsed = ++time;
+        return &found->second;
+    }
+
+    /* Adds a new entry and evicts others to fit into the budget */
+    Entry& insert(const Key& key, Entry&& entry) {
+        entry.lastUsed = ++time;
+        size += entry.size;
+        Entry& inserted = entries.emplace(key, std::move(entry)).first->second;
+        evict(&inserted);
+        return inserted;
+    }
+
+    /* Evicts least recently used entries except for `keep` until the size
+       fits into the budget. Linear in the entry count for each eviction,
+       which is fine given the amount of work needed to import each entry in
+       the first place. */
+    void evict(const Entry* const keep) {
+        while(size > budget) {
+            auto oldest = entries.end();
+            for(auto it = entries.begin(); it != entries.end(); ++it) {
+                if(&it->second == keep) continue;
+                if(oldest == entries.end() || it->second.lastUsed < oldest->second.lastUsed)
+                    oldest = it;
+            }
+            if(oldest == entries.end()) break;
+
+            size -= oldest->second.size;
+            entries.erase(oldest);
+        }
+    }
+
+    AbstractImporter& importer;
+    std::size_t budget;
+    std::size_t size{};
+    UnsignedLong time{};
+    std::map<Key, Entry> entries;
+};
+
+ImporterCache::ImporterCache(AbstractImporter& importer, const std::size_t budget): _state{InPlaceInit, importer, budget} {}
+
+ImporterCache::ImporterCache(ImporterCache&&) noexcept = default;
+
+ImporterCache::~ImporterCache() = default;
+
+ImporterCache& ImporterCache::operator=(ImporterCache&&) noexcept = default;
+
+AbstractImporter& ImporterCache::importer() { return _state->importer; }
+
+std::size_t ImporterCache::budget() const { return _state->budget; }
+
+ImporterCache& ImporterCache::setBudget(const std::size_t budget) {
+    _state->budget = budget;
+
+    /* Keep the most recently used entry, consistently with what insert()
+       does */
+    const Entry* mostRecentlyUsed = nullptr;
+    for(const auto& entry: _state->entries)
+        if(!mostRecentlyUsed || entry.second.lastUsed > mostRecentlyUsed->lastUsed)
+            mostRecentlyUsed = &entry.second;
+    _state->evict(mostRecentlyUsed);
+    return *this;
+}
+
+std::size_t ImporterCache::size() const { return _state->size; }
+
+std::size_t ImporterCache::count() const { return _state->entries.size(); }
+
+const MeshData* ImporterCache::mesh(const UnsignedInt id, const UnsignedInt level) {
+    const Key key{Type::Mesh, id, level};
+    if(const Entry* const entry = _state->find(key))
+        return &*entry->mesh;
+
+    Containers::Optional<MeshData> mesh = _state->importer.mesh(id, level);
+    if(!mesh) return nullptr;
+
+    const std::size_t size = mesh->indexData().size() + mesh->vertexData().size() + mesh->attributeData().size()*sizeof(MeshAttributeData);
+    return &*_state->insert(key, Entry{std::move(mesh), Containers::NullOpt, Containers::NullOpt, size, 0}).mesh;
+}
+
+const MaterialData* ImporterCache::material(const UnsignedInt id) {
+    const Key key{Type::Material, id, 0};
+    if(const Entry* const entry = _state->find(key))
+        return &*entry->material;
+
+    Containers::Optional<MaterialData> material = _state->importer.material(id);
+    if(!material) return nullptr;
+
+    const std::size_t size = material->attributeData().size()*sizeof(MaterialAttributeData) + material->layerData().size()*sizeof(UnsignedInt);
+    return &*_state->insert(key, Entry{Containers::NullOpt, std::move(material), Containers::NullOpt, size, 0}).material;
+}
+
+const ImageData2D* ImporterCache::image2D(const UnsignedInt id, const UnsignedInt level) {
+    const Key key{Type::Image2D, id, level};
+    if(const Entry* const entry = _state->find(key))
+        return &*entry->image2D;
+
+    Containers::Optional<ImageData2D> image = _state->importer.image2D(id, level);
+    if(!image) return nullptr;
+
+    const std::size_t size = image->data().size();
+    return &*_state->insert(key, Entry{Containers::NullOpt, Containers::NullOpt, std::move(image), size, 0}).image2D;
+}
+
+ImporterCache& ImporterCache::clear() {
+    _state->entries.clear();
+    _state->size = 0;
+    return *this;
+}
+
+}}
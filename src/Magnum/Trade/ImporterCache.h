@@ -0,0 +1,171 @@
+#ifndef Magnum_Trade_ImporterCache_h
+#define Magnum_Trade_ImporterCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Trade::ImporterCache
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Trade/Trade.h"
+#include "Magnum/Trade/visibility.h"
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Importer cache
+@m_since_latest
+
+Memoizes meshes, materials and 2D images returned by an @ref AbstractImporter,
+so repeated requests for the same ID are not going through the importer
+again. The cache has a byte budget --- once the total size of cached data
+exceeds it, least recently used items are evicted until it fits again. This
+makes it possible to load items on-demand when streaming large scenes without
+having to manage their lifetime manually:
+
+@snippet MagnumTrade.cpp ImporterCache
+
+Size of an item is the size of its index, vertex and attribute data for
+meshes, attribute and layer data for materials and pixel data for images. The
+most recently loaded item is never evicted, which means an item larger than
+the budget is still returned and stays in the cache until another item is
+loaded.
+
+Pointers returned from @ref mesh(), @ref material() and @ref image2D() stay
+valid until a subsequent call that isn't satisfied from the cache and thus may
+cause an eviction, until @ref setBudget() or @ref clear() is called or until
+the cache is destroyed. Items that fail to import are not cached, so the
+importer gets asked again the next time. The cache doesn't track the state of
+the importer, @ref clear() it when a different file gets opened.
+*/
+class MAGNUM_TRADE_EXPORT ImporterCache {
+    public:
+        /**
+         * @brief Constructor
+         * @param importer  Importer to load the data from
+         * @param budget    Max size of cached data in bytes
+         *
+         * The @p importer is expected to stay in scope for the whole lifetime
+         * of the cache.
+         */
+        explicit ImporterCache(AbstractImporter& importer, std::size_t budget);
+
+        /** @brief Copying is not allowed */
+        ImporterCache(const ImporterCache&) = delete;
+
+        /** @brief Move constructor */
+        ImporterCache(ImporterCache&&) noexcept;
+
+        ~ImporterCache();
+
+        /** @brief Copying is not allowed */
+        ImporterCache& operator=(const ImporterCache&) = delete;
+
+        /** @brief Move assignment */
+        ImporterCache& operator=(ImporterCache&&) noexcept;
+
+        /** @brief Importer the data are loaded from */
+        AbstractImporter& importer();
+
+        /** @brief Max size of cached data in bytes */
+        std::size_t budget() const;
+
+        /**
+         * @brief Set max size of cached data
+         * @return Reference to self (for method chaining)
+         *
+         * If the size of currently cached data is over @p budget, least
+         * recently used items are evicted right away. The most recently
+         * loaded item is kept even if it's alone over the budget.
+         */
+        ImporterCache& setBudget(std::size_t budget);
+
+        /**
+         * @brief Size of cached data in bytes
+         *
+         * Can be larger than @ref budget() only if the most recently loaded
+         * item alone is over the budget.
+         */
+        std::size_t size() const;
+
+        /** @brief Count of cached items */
+        std::size_t count() const;
+
+        /**
+         * @brief Mesh
+         * @param id        Mesh ID, from range [0, @ref AbstractImporter::meshCount())
+         * @param level     Mesh level, from range [0, @ref AbstractImporter::meshLevelCount())
+         *
+         * Returns a cached mesh if present, otherwise calls
+         * @ref AbstractImporter::mesh() and caches the result. Returns
+         * @cpp nullptr @ce if the import fails. See the
+         * @ref ImporterCache "class documentation" for details about
+         * validity of the returned pointer.
+         */
+        const MeshData* mesh(UnsignedInt id, UnsignedInt level = 0);
+
+        /**
+         * @brief Material
+         * @param id        Material ID, from range [0, @ref AbstractImporter::materialCount())
+         *
+         * Returns a cached material if present, otherwise calls
+         * @ref AbstractImporter::material() and caches the result. Returns
+         * @cpp nullptr @ce if the import fails. See the
+         * @ref ImporterCache "class documentation" for details about
+         * validity of the returned pointer.
+         */
+        const MaterialData* material(UnsignedInt id);
+
+        /**
+         * @brief Two-dimensional image
+         * @param id        Image ID, from range [0, @ref AbstractImporter::image2DCount())
+         * @param level     Mip level, from range [0, @ref AbstractImporter::image2DLevelCount())
+         *
+         * Returns a cached image if present, otherwise calls
+         * @ref AbstractImporter::image2D() and caches the result. Returns
+         * @cpp nullptr @ce if the import fails. See the
+         * @ref ImporterCache "class documentation" for details about
+         * validity of the returned pointer.
+         */
+        const ImageData2D* image2D(UnsignedInt id, UnsignedInt level = 0);
+
+        /**
+         * @brief Clear the cache
+         * @return Reference to self (for method chaining)
+         */
+        ImporterCache& clear();
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
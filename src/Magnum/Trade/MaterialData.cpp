@@ -29,6 +29,8 @@
 #include <algorithm> /* std::sort() */
 #include <Corrade/Containers/EnumSet.hpp>
 #include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Reference.h>
+#include <Corrade/Containers/StridedArrayView.h>
 
 #include "Magnum/Math/Vector4.h"
 #include "Magnum/Math/Matrix3.h"
@@ -63,6 +65,38 @@ constexpr struct {
 };
 #endif
 
+constexpr std::size_t AttributeCount = Containers::arraySize(AttributeMap);
+
+/* AttributeMap indices sorted by name, for mapping attribute names back to
+   MaterialAttribute values. Calculated on first use. */
+struct SortedAttributeMap {
+    SortedAttributeMap() {
+        for(std::size_t i = 0; i != AttributeCount; ++i) indices[i] = i;
+        std::sort(indices, indices + AttributeCount, [](UnsignedByte a, UnsignedByte b) {
+            return AttributeMap[a].name < AttributeMap[b].name;
+        });
+    }
+
+    UnsignedByte indices[AttributeCount];
+};
+
+const SortedAttributeMap& sortedAttributeMap() {
+    static const SortedAttributeMap map;
+    return map;
+}
+
+/* Returns MaterialAttribute corresponding to given name or an invalid
+   MaterialAttribute{} if it's a custom name */
+MaterialAttribute attributeForString(const Containers::StringView name) {
+    const UnsignedByte* const indices = sortedAttributeMap().indices;
+    const UnsignedByte* const found = std::lower_bound(indices, indices + AttributeCount, name, [](UnsignedByte a, const Containers::StringView& b) {
+        return AttributeMap[a].name < b;
+    });
+    if(found == indices + AttributeCount || AttributeMap[*found].name != name)
+        return MaterialAttribute{};
+    return MaterialAttribute(*found + 1);
+}
+
 }
 
 UnsignedInt materialTextureSwizzleComponentCount(const MaterialTextureSwizzle swizzle) {
@@ -252,6 +286,8 @@ MaterialData::MaterialData(const MaterialTypes types, Containers::Array<Material
 
         begin = end;
     }
+
+    buildAttributeLookup();
 }
 
 MaterialData::MaterialData(const MaterialTypes types, const std::initializer_list<MaterialAttributeData> attributeData, const std::initializer_list<UnsignedInt> layerData, const void* const importerState): MaterialData{types, Implementation::initializerListToArrayWithDefaultDeleter(attributeData), Implementation::initializerListToArrayWithDefaultDeleter(layerData), importerState} {}
@@ -290,6 +326,8 @@ MaterialData::MaterialData(const MaterialTypes types, const DataFlags attributeD
         begin = end;
     }
     #endif
+
+    buildAttributeLookup();
 }
 
 MaterialData::MaterialData(MaterialData&&) noexcept = default;
@@ -298,6 +336,32 @@ MaterialData::~MaterialData() = default;
 
 MaterialData& MaterialData::operator=(MaterialData&&) noexcept = default;
 
+void MaterialData::buildAttributeLookup() {
+    const UnsignedInt layerCount = this->layerCount();
+    _attributeLookup = Containers::Array<UnsignedByte>{ValueInit, layerCount*AttributeCount};
+
+    /* Both the attributes in each layer and the sorted attribute map are
+       sorted by name, so it's enough to walk both at the same time */
+    const UnsignedByte* const indices = sortedAttributeMap().indices;
+    for(UnsignedInt layer = 0; layer != layerCount; ++layer) {
+        UnsignedByte* const lookup = _attributeLookup + layer*AttributeCount;
+        const UnsignedInt begin = layerOffset(layer);
+        const UnsignedInt end = _layerOffsets ? _layerOffsets[layer] : UnsignedInt(_data.size());
+        std::size_t mapIndex = 0;
+        for(UnsignedInt i = begin; i != end && mapIndex != AttributeCount; ++i) {
+            const Containers::StringView name = _data[i].name();
+            while(mapIndex != AttributeCount && AttributeMap[indices[mapIndex]].name < name)
+                ++mapIndex;
+            if(mapIndex == AttributeCount || AttributeMap[indices[mapIndex]].name != name)
+                continue;
+
+            /* IDs that don't fit into a byte get looked up by name */
+            lookup[indices[mapIndex]] = i - begin < 254 ? i - begin + 1 : 255;
+            ++mapIndex;
+        }
+    }
+}
+
 Containers::StringView MaterialData::layerString(const MaterialLayer name) {
     #ifndef CORRADE_NO_ASSERT
     if(UnsignedInt(name) - 1 >= Containers::arraySize(LayerMap))
@@ -557,6 +621,15 @@ UnsignedInt MaterialData::attributeFor(const UnsignedInt layer, const Containers
     return found - begin;
 }
 
+UnsignedInt MaterialData::attributeFor(const UnsignedInt layer, const MaterialAttribute name) const {
+    /* The lookup table is not present after releaseAttributeData() or
+       releaseLayerData(), the name is expected to be valid */
+    const UnsignedByte id = _attributeLookup ?
+        _attributeLookup[layer*AttributeCount + UnsignedInt(name) - 1] : 255;
+    if(id == 255) return attributeFor(layer, AttributeMap[UnsignedInt(name) - 1].name);
+    return id ? id - 1 : ~UnsignedInt{};
+}
+
 bool MaterialData::hasAttribute(const UnsignedInt layer, const Containers::StringView name) const {
     CORRADE_ASSERT(layer < layerCount(),
         "Trade::MaterialData::hasAttribute(): index" << layer << "out of range for" << layerCount() << "layers", {});
@@ -564,9 +637,10 @@ bool MaterialData::hasAttribute(const UnsignedInt layer, const Containers::Strin
 }
 
 bool MaterialData::hasAttribute(const UnsignedInt layer, const MaterialAttribute name) const {
-    const Containers::StringView string = attributeString(name);
-    CORRADE_ASSERT(string, "Trade::MaterialData::hasAttribute(): invalid name" << name, {});
-    return hasAttribute(layer, string);
+    CORRADE_ASSERT(attributeString(name), "Trade::MaterialData::hasAttribute(): invalid name" << name, {});
+    CORRADE_ASSERT(layer < layerCount(),
+        "Trade::MaterialData::hasAttribute(): index" << layer << "out of range for" << layerCount() << "layers", {});
+    return attributeFor(layer, name) != ~UnsignedInt{};
 }
 
 bool MaterialData::hasAttribute(const Containers::StringView layer, const Containers::StringView name) const {
@@ -604,9 +678,13 @@ UnsignedInt MaterialData::attributeId(const UnsignedInt layer, const Containers:
 }
 
 UnsignedInt MaterialData::attributeId(const UnsignedInt layer, const MaterialAttribute name) const {
-    const Containers::StringView string = attributeString(name);
-    CORRADE_ASSERT(string, "Trade::MaterialData::attributeId(): invalid name" << name, {});
-    return attributeId(layer, string);
+    CORRADE_ASSERT(attributeString(name), "Trade::MaterialData::attributeId(): invalid name" << name, {});
+    CORRADE_ASSERT(layer < layerCount(),
+        "Trade::MaterialData::attributeId(): index" << layer << "out of range for" << layerCount() << "layers", {});
+    const UnsignedInt id = attributeFor(layer, name);
+    CORRADE_ASSERT(id != ~UnsignedInt{},
+        "Trade::MaterialData::attributeId(): attribute" << attributeString(name) << "not found in layer" << layer, {});
+    return id;
 }
 
 UnsignedInt MaterialData::attributeId(const Containers::StringView layer, const Containers::StringView name) const {
@@ -678,9 +756,13 @@ MaterialAttributeType MaterialData::attributeType(const UnsignedInt layer, const
 }
 
 MaterialAttributeType MaterialData::attributeType(const UnsignedInt layer, const MaterialAttribute name) const {
-    const Containers::StringView string = attributeString(name);
-    CORRADE_ASSERT(string, "Trade::MaterialData::attributeType(): invalid name" << name, {});
-    return attributeType(layer, string);
+    CORRADE_ASSERT(attributeString(name), "Trade::MaterialData::attributeType(): invalid name" << name, {});
+    CORRADE_ASSERT(layer < layerCount(),
+        "Trade::MaterialData::attributeType(): index" << layer << "out of range for" << layerCount() << "layers", {});
+    const UnsignedInt id = attributeFor(layer, name);
+    CORRADE_ASSERT(id != ~UnsignedInt{},
+        "Trade::MaterialData::attributeType(): attribute" << attributeString(name) << "not found in layer" << layer, {});
+    return _data[layerOffset(layer) + id]._data.type;
 }
 
 MaterialAttributeType MaterialData::attributeType(const Containers::StringView layer, const UnsignedInt id) const {
@@ -765,15 +847,25 @@ void* MaterialData::mutableAttribute(const UnsignedInt layer, const Containers::
 }
 
 const void* MaterialData::attribute(const UnsignedInt layer, const MaterialAttribute name) const {
-    const Containers::StringView string = attributeString(name);
-    CORRADE_ASSERT(string, "Trade::MaterialData::attribute(): invalid name" << name, {});
-    return attribute(layer, string);
+    CORRADE_ASSERT(attributeString(name), "Trade::MaterialData::attribute(): invalid name" << name, {});
+    CORRADE_ASSERT(layer < layerCount(),
+        "Trade::MaterialData::attribute(): index" << layer << "out of range for" << layerCount() << "layers", {});
+    const UnsignedInt id = attributeFor(layer, name);
+    CORRADE_ASSERT(id != ~UnsignedInt{},
+        "Trade::MaterialData::attribute(): attribute" << attributeString(name) << "not found in layer" << layer, {});
+    return _data[layerOffset(layer) + id].value();
 }
 
 void* MaterialData::mutableAttribute(const UnsignedInt layer, const MaterialAttribute name) {
-    const Containers::StringView string = attributeString(name);
-    CORRADE_ASSERT(string, "Trade::MaterialData::mutableAttribute(): invalid name" << name, {});
-    return mutableAttribute(layer, string);
+    CORRADE_ASSERT(attributeString(name), "Trade::MaterialData::mutableAttribute(): invalid name" << name, {});
+    CORRADE_ASSERT(_attributeDataFlags & DataFlag::Mutable,
+        "Trade::MaterialData::mutableAttribute(): attribute data not mutable", {});
+    CORRADE_ASSERT(layer < layerCount(),
+        "Trade::MaterialData::mutableAttribute(): index" << layer << "out of range for" << layerCount() << "layers", {});
+    const UnsignedInt id = attributeFor(layer, name);
+    CORRADE_ASSERT(id != ~UnsignedInt{},
+        "Trade::MaterialData::mutableAttribute(): attribute" << attributeString(name) << "not found in layer" << layer, {});
+    return const_cast<void*>(_data[layerOffset(layer) + id].value());
 }
 
 const void* MaterialData::attribute(const Containers::StringView layer, const UnsignedInt id) const {
@@ -907,9 +999,12 @@ const void* MaterialData::tryAttribute(const UnsignedInt layer, const Containers
 }
 
 const void* MaterialData::tryAttribute(const UnsignedInt layer, const MaterialAttribute name) const {
-    const Containers::StringView string = attributeString(name);
-    CORRADE_ASSERT(string, "Trade::MaterialData::tryAttribute(): invalid name" << name, {});
-    return tryAttribute(layer, string);
+    CORRADE_ASSERT(attributeString(name), "Trade::MaterialData::tryAttribute(): invalid name" << name, {});
+    CORRADE_ASSERT(layer < layerCount(),
+        "Trade::MaterialData::tryAttribute(): index" << layer << "out of range for" << layerCount() << "layers", {});
+    const UnsignedInt id = attributeFor(layer, name);
+    if(id == ~UnsignedInt{}) return nullptr;
+    return _data[layerOffset(layer) + id].value();
 }
 
 const void* MaterialData::tryAttribute(const Containers::StringView layer, const Containers::StringView name) const {
@@ -967,13 +1062,63 @@ Float MaterialData::alphaMask() const {
 }
 
 Containers::Array<UnsignedInt> MaterialData::releaseLayerData() {
+    _attributeLookup = nullptr;
     return std::move(_layerOffsets);
 }
 
 Containers::Array<MaterialAttributeData> MaterialData::releaseAttributeData() {
+    _attributeLookup = nullptr;
     return std::move(_data);
 }
 
+void materialAttributesInto(const Containers::ArrayView<const Containers::Reference<const MaterialData>> materials, const UnsignedInt layer, const Containers::ArrayView<const MaterialAttributeData> attributes, const Containers::ArrayView<const Containers::StridedArrayView2D<char>> destinations) {
+    CORRADE_ASSERT(attributes.size() == destinations.size(),
+        "Trade::materialAttributesInto(): expected" << attributes.size() << "destination views but got" << destinations.size(), );
+
+    /* Figure out the enum names and sizes upfront so it's not done for each
+       material again */
+    Containers::Array<MaterialAttribute> names{NoInit, attributes.size()};
+    Containers::Array<std::size_t> sizes{NoInit, attributes.size()};
+    for(std::size_t i = 0; i != attributes.size(); ++i) {
+        CORRADE_ASSERT(attributes[i].type() != MaterialAttributeType::String,
+            "Trade::materialAttributesInto(): string attributes are not supported but got" << attributes[i].name(), );
+        sizes[i] = materialAttributeTypeSize(attributes[i].type());
+        CORRADE_ASSERT(destinations[i].size()[0] == materials.size(),
+            "Trade::materialAttributesInto(): expected destination view" << i << "to have" << materials.size() << "elements but got" << destinations[i].size()[0], );
+        CORRADE_ASSERT(destinations[i].size()[1] == sizes[i],
+            "Trade::materialAttributesInto(): expected destination view" << i << "second dimension size to be" << sizes[i] << "for" << attributes[i].type() << "but got" << destinations[i].size()[1], );
+        CORRADE_ASSERT(destinations[i].isContiguous<1>(),
+            "Trade::materialAttributesInto(): second destination view" << i << "dimension is not contiguous", );
+        names[i] = attributeForString(attributes[i].name());
+    }
+
+    for(std::size_t i = 0; i != materials.size(); ++i) {
+        const MaterialData& material = materials[i];
+        const bool hasLayer = layer < material.layerCount();
+        for(std::size_t j = 0; j != attributes.size(); ++j) {
+            UnsignedInt id = ~UnsignedInt{};
+            if(hasLayer) id = names[j] != MaterialAttribute{} ?
+                material.attributeFor(layer, names[j]) :
+                material.attributeFor(layer, attributes[j].name());
+
+            const void* value;
+            if(id == ~UnsignedInt{}) value = attributes[j].value();
+            else {
+                const MaterialAttributeData& data = material._data[material.layerOffset(layer) + id];
+                CORRADE_ASSERT(data.type() == attributes[j].type(),
+                    "Trade::materialAttributesInto():" << attributes[j].name() << "in material" << i << "is" << data.type() << "but expected" << attributes[j].type(), );
+                value = data.value();
+            }
+
+            std::memcpy(destinations[j][i].data(), value, sizes[j]);
+        }
+    }
+}
+
+void materialAttributesInto(const Containers::ArrayView<const Containers::Reference<const MaterialData>> materials, const UnsignedInt layer, const std::initializer_list<MaterialAttributeData> attributes, const std::initializer_list<Containers::StridedArrayView2D<char>> destinations) {
+    materialAttributesInto(materials, layer, Containers::arrayView(attributes), Containers::arrayView(destinations));
+}
+
 Debug& operator<<(Debug& debug, const MaterialLayer value) {
     debug << "Trade::MaterialLayer" << Debug::nospace;
 
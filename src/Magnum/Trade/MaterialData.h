@@ -26,7 +26,7 @@
 */
 
 /** @file
- * @brief Class @ref Magnum::Trade::MaterialData, @ref Magnum::Trade::MaterialAttributeData, enum @ref Magnum::Trade::MaterialLayer, @ref Magnum::Trade::MaterialAttribute, @ref Magnum::Trade::MaterialTextureSwizzle, @ref Magnum::Trade::MaterialAttributeType
+ * @brief Class @ref Magnum::Trade::MaterialData, @ref Magnum::Trade::MaterialAttributeData, enum @ref Magnum::Trade::MaterialLayer, @ref Magnum::Trade::MaterialAttribute, @ref Magnum::Trade::MaterialTextureSwizzle, @ref Magnum::Trade::MaterialAttributeType, function @ref Magnum::Trade::materialAttributesInto()
  * @m_since_latest
  */
 
@@ -2958,6 +2958,8 @@ class MAGNUM_TRADE_EXPORT MaterialData {
            the restriction is pointless when used outside of plugin
            implementations. */
         friend AbstractImporter;
+        /* Uses the private lookup helpers */
+        friend MAGNUM_TRADE_EXPORT void materialAttributesInto(Containers::ArrayView<const Containers::Reference<const MaterialData>>, UnsignedInt, Containers::ArrayView<const MaterialAttributeData>, Containers::ArrayView<const Containers::StridedArrayView2D<char>>);
 
         static Containers::StringView layerString(MaterialLayer name);
         static Containers::StringView attributeString(MaterialAttribute name);
@@ -2967,9 +2969,15 @@ class MAGNUM_TRADE_EXPORT MaterialData {
             return layer && _layerOffsets ? _layerOffsets[layer - 1] : 0;
         }
         UnsignedInt attributeFor(UnsignedInt layer, Containers::StringView name) const;
+        /* Uses _attributeLookup, falls back to the above if not possible */
+        UnsignedInt attributeFor(UnsignedInt layer, MaterialAttribute name) const;
+        void buildAttributeLookup();
 
         Containers::Array<MaterialAttributeData> _data;
         Containers::Array<UnsignedInt> _layerOffsets;
+        /* For each layer, layer-local ID + 1 of every MaterialAttribute, 0 if
+           not present, 255 if the ID doesn't fit. Empty after a release*(). */
+        Containers::Array<UnsignedByte> _attributeLookup;
         MaterialTypes _types;
         DataFlags _attributeDataFlags, _layerDataFlags;
         /* 2 bytes free */
@@ -3002,6 +3010,41 @@ MAGNUM_TRADE_EXPORT Debug& operator<<(Debug& debug, MaterialData::Flags value);
 CORRADE_IGNORE_DEPRECATED_POP
 #endif
 
+/**
+@brief Extract attributes from a batch of materials
+@param[in] materials    Materials to extract the attributes from
+@param[in] layer        Layer to extract the attributes from
+@param[in] attributes   Attribute names, types and default values
+@param[out] destinations Where to put the values for each attribute
+@m_since_latest
+
+Fills the @p destinations with structure-of-arrays data, where the @p i-th
+item of the @p j-th view is the value of the @p j-th attribute from the
+@p i-th material. If given material doesn't have the attribute or doesn't
+have given @p layer at all, the value from @p attributes is used instead,
+similarly to @ref MaterialData::attributeOr(). Attributes with names
+corresponding to a @ref MaterialAttribute are looked up in constant time,
+while custom attribute names use a binary search in each material.
+
+Expects that @p attributes and @p destinations have the same size and that
+none of the @p attributes is a @ref MaterialAttributeType::String. The first
+dimension of each of the @p destinations is expected to have the same size as
+@p materials, the second dimension is expected to be contiguous and have the
+size given by @ref materialAttributeTypeSize() for corresponding attribute
+type. Attributes of a different type than in @p attributes are treated as a
+programmer error. Example usage, extracting base color and base color texture
+from all materials:
+
+@snippet MagnumTrade.cpp materialAttributesInto
+*/
+MAGNUM_TRADE_EXPORT void materialAttributesInto(Containers::ArrayView<const Containers::Reference<const MaterialData>> materials, UnsignedInt layer, Containers::ArrayView<const MaterialAttributeData> attributes, Containers::ArrayView<const Containers::StridedArrayView2D<char>> destinations);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_TRADE_EXPORT void materialAttributesInto(Containers::ArrayView<const Containers::Reference<const MaterialData>> materials, UnsignedInt layer, std::initializer_list<MaterialAttributeData> attributes, std::initializer_list<Containers::StridedArrayView2D<char>> destinations);
+
 namespace Implementation {
     /* LCOV_EXCL_START */
     /* Has to be a struct because there can't be partial specializations for a
@@ -3157,15 +3200,23 @@ template<class T> typename std::conditional<std::is_same<T, Containers::MutableS
 }
 
 template<class T> T MaterialData::attribute(const UnsignedInt layer, const MaterialAttribute name) const {
-    const Containers::StringView string = attributeString(name);
-    CORRADE_ASSERT(string.data(), "Trade::MaterialData::attribute(): invalid name" << name, {});
-    return attribute<T>(layer, string);
+    CORRADE_ASSERT(attributeString(name).data(), "Trade::MaterialData::attribute(): invalid name" << name, {});
+    CORRADE_ASSERT(layer < layerCount(),
+        "Trade::MaterialData::attribute(): index" << layer << "out of range for" << layerCount() << "layers", {});
+    const UnsignedInt id = attributeFor(layer, name);
+    CORRADE_ASSERT(id != ~UnsignedInt{},
+        "Trade::MaterialData::attribute(): attribute" << attributeString(name) << "not found in layer" << layer, {});
+    return attribute<T>(layer, id);
 }
 
 template<class T> typename std::conditional<std::is_same<T, Containers::MutableStringView>::value, Containers::MutableStringView, T&>::type MaterialData::mutableAttribute(const UnsignedInt layer, const MaterialAttribute name) {
-    const Containers::StringView string = attributeString(name);
-    CORRADE_ASSERT(string.data(), "Trade::MaterialData::mutableAttribute(): invalid name" << name, *reinterpret_cast<T*>(this));
-    return mutableAttribute<T>(layer, string);
+    CORRADE_ASSERT(attributeString(name).data(), "Trade::MaterialData::mutableAttribute(): invalid name" << name, *reinterpret_cast<T*>(this));
+    CORRADE_ASSERT(layer < layerCount(),
+        "Trade::MaterialData::mutableAttribute(): index" << layer << "out of range for" << layerCount() << "layers", *reinterpret_cast<T*>(this));
+    const UnsignedInt id = attributeFor(layer, name);
+    CORRADE_ASSERT(id != ~UnsignedInt{},
+        "Trade::MaterialData::mutableAttribute(): attribute" << attributeString(name) << "not found in layer" << layer, *reinterpret_cast<T*>(this));
+    return mutableAttribute<T>(layer, id);
 }
 
 template<class T> T MaterialData::attribute(const Containers::StringView layer, const UnsignedInt id) const {
@@ -3263,9 +3314,12 @@ template<class T> Containers::Optional<T> MaterialData::tryAttribute(const Unsig
 }
 
 template<class T> Containers::Optional<T> MaterialData::tryAttribute(const UnsignedInt layer, const MaterialAttribute name) const {
-    const Containers::StringView string = attributeString(name);
-    CORRADE_ASSERT(string.data(), "Trade::MaterialData::tryAttribute(): invalid name" << name, {});
-    return tryAttribute<T>(layer, string);
+    CORRADE_ASSERT(attributeString(name).data(), "Trade::MaterialData::tryAttribute(): invalid name" << name, {});
+    CORRADE_ASSERT(layer < layerCount(),
+        "Trade::MaterialData::tryAttribute(): index" << layer << "out of range for" << layerCount() << "layers", {});
+    const UnsignedInt id = attributeFor(layer, name);
+    if(id == ~UnsignedInt{}) return {};
+    return attribute<T>(layer, id);
 }
 
 template<class T> Containers::Optional<T> MaterialData::tryAttribute(const Containers::StringView layer, const Containers::StringView name) const {
@@ -3302,9 +3356,12 @@ template<class T> T MaterialData::attributeOr(const UnsignedInt layer, const Con
 }
 
 template<class T> T MaterialData::attributeOr(const UnsignedInt layer, const MaterialAttribute name, const T& defaultValue) const {
-    const Containers::StringView string = attributeString(name);
-    CORRADE_ASSERT(string.data(), "Trade::MaterialData::attributeOr(): invalid name" << name, {});
-    return attributeOr<T>(layer, string, defaultValue);
+    CORRADE_ASSERT(attributeString(name).data(), "Trade::MaterialData::attributeOr(): invalid name" << name, {});
+    CORRADE_ASSERT(layer < layerCount(),
+        "Trade::MaterialData::attributeOr(): index" << layer << "out of range for" << layerCount() << "layers", {});
+    const UnsignedInt id = attributeFor(layer, name);
+    if(id == ~UnsignedInt{}) return defaultValue;
+    return attribute<T>(layer, id);
 }
 
 template<class T> T MaterialData::attributeOr(const Containers::StringView layer, const Containers::StringView name, const T& defaultValue) const {
@@ -556,81 +556,98 @@ Containers::Array<Vector2> MeshData::positions2DAsArray(const UnsignedInt id) co
     return out;
 }
 
-void MeshData::positions3DInto(const Containers::StridedArrayView1D<Vector3>& destination, const UnsignedInt id) const {
-    const UnsignedInt attributeId = findAttributeIdInternal(MeshAttribute::Position, id);
-    CORRADE_ASSERT(attributeId != ~UnsignedInt{}, "Trade::MeshData::positions3DInto(): index" << id << "out of range for" << attributeCount(MeshAttribute::Position) << "position attributes", );
-    CORRADE_ASSERT(destination.size() == _vertexCount, "Trade::MeshData::positions3DInto(): expected a view with" << _vertexCount << "elements but got" << destination.size(), );
-    const MeshAttributeData& attribute = _attributes[attributeId];
-    CORRADE_ASSERT(!isVertexFormatImplementationSpecific(attribute._format),
-        "Trade::MeshData::positions3DInto(): can't extract data out of an implementation-specific vertex format" << reinterpret_cast<void*>(vertexFormatUnwrap(attribute._format)), );
-    const Containers::StridedArrayView1D<const void> attributeData = attributeDataViewInternal(attribute);
+namespace {
+
+void positions3DIntoImplementation(const Containers::StridedArrayView1D<const void>& attributeData, const Containers::StridedArrayView1D<Vector3>& destination, const VertexFormat format) {
     const Containers::StridedArrayView2D<Float> destination2f = Containers::arrayCast<2, Float>(Containers::arrayCast<Vector2>(destination));
     const Containers::StridedArrayView2D<Float> destination3f = Containers::arrayCast<2, Float>(destination);
 
     /* For 2D positions copy the XY part to the first two components */
-    if(attribute._format == VertexFormat::Vector2)
+    if(format == VertexFormat::Vector2)
         Utility::copy(Containers::arrayCast<const Vector2>(attributeData),
                       Containers::arrayCast<Vector2>(destination));
-    else if(attribute._format == VertexFormat::Vector2h)
+    else if(format == VertexFormat::Vector2h)
         Math::unpackHalfInto(Containers::arrayCast<2, const UnsignedShort>(attributeData, 2), destination2f);
-    else if(attribute._format == VertexFormat::Vector2ub)
+    else if(format == VertexFormat::Vector2ub)
         Math::castInto(Containers::arrayCast<2, const UnsignedByte>(attributeData, 2), destination2f);
-    else if(attribute._format == VertexFormat::Vector2b)
+    else if(format == VertexFormat::Vector2b)
         Math::castInto(Containers::arrayCast<2, const Byte>(attributeData, 2), destination2f);
-    else if(attribute._format == VertexFormat::Vector2us)
+    else if(format == VertexFormat::Vector2us)
         Math::castInto(Containers::arrayCast<2, const UnsignedShort>(attributeData, 2), destination2f);
-    else if(attribute._format == VertexFormat::Vector2s)
+    else if(format == VertexFormat::Vector2s)
         Math::castInto(Containers::arrayCast<2, const Short>(attributeData, 2), destination2f);
-    else if(attribute._format == VertexFormat::Vector2ubNormalized)
+    else if(format == VertexFormat::Vector2ubNormalized)
         Math::unpackInto(Containers::arrayCast<2, const UnsignedByte>(attributeData, 2), destination2f);
-    else if(attribute._format == VertexFormat::Vector2bNormalized)
+    else if(format == VertexFormat::Vector2bNormalized)
         Math::unpackInto(Containers::arrayCast<2, const Byte>(attributeData, 2), destination2f);
-    else if(attribute._format == VertexFormat::Vector2usNormalized)
+    else if(format == VertexFormat::Vector2usNormalized)
         Math::unpackInto(Containers::arrayCast<2, const UnsignedShort>(attributeData, 2), destination2f);
-    else if(attribute._format == VertexFormat::Vector2sNormalized)
+    else if(format == VertexFormat::Vector2sNormalized)
         Math::unpackInto(Containers::arrayCast<2, const Short>(attributeData, 2), destination2f);
 
     /* Copy 3D positions as-is */
-    else if(attribute._format == VertexFormat::Vector3)
+    else if(format == VertexFormat::Vector3)
         Utility::copy(Containers::arrayCast<const Vector3>(attributeData), destination);
-    else if(attribute._format == VertexFormat::Vector3h)
+    else if(format == VertexFormat::Vector3h)
         Math::unpackHalfInto(Containers::arrayCast<2, const UnsignedShort>(attributeData, 3), destination3f);
-    else if(attribute._format == VertexFormat::Vector3ub)
+    else if(format == VertexFormat::Vector3ub)
         Math::castInto(Containers::arrayCast<2, const UnsignedByte>(attributeData, 3), destination3f);
-    else if(attribute._format == VertexFormat::Vector3b)
+    else if(format == VertexFormat::Vector3b)
         Math::castInto(Containers::arrayCast<2, const Byte>(attributeData, 3), destination3f);
-    else if(attribute._format == VertexFormat::Vector3us)
+    else if(format == VertexFormat::Vector3us)
         Math::castInto(Containers::arrayCast<2, const UnsignedShort>(attributeData, 3), destination3f);
-    else if(attribute._format == VertexFormat::Vector3s)
+    else if(format == VertexFormat::Vector3s)
         Math::castInto(Containers::arrayCast<2, const Short>(attributeData, 3), destination3f);
-    else if(attribute._format == VertexFormat::Vector3ubNormalized)
+    else if(format == VertexFormat::Vector3ubNormalized)
         Math::unpackInto(Containers::arrayCast<2, const UnsignedByte>(attributeData, 3), destination3f);
-    else if(attribute._format == VertexFormat::Vector3bNormalized)
+    else if(format == VertexFormat::Vector3bNormalized)
         Math::unpackInto(Containers::arrayCast<2, const Byte>(attributeData, 3), destination3f);
-    else if(attribute._format == VertexFormat::Vector3usNormalized)
+    else if(format == VertexFormat::Vector3usNormalized)
         Math::unpackInto(Containers::arrayCast<2, const UnsignedShort>(attributeData, 3), destination3f);
-    else if(attribute._format == VertexFormat::Vector3sNormalized)
+    else if(format == VertexFormat::Vector3sNormalized)
         Math::unpackInto(Containers::arrayCast<2, const Short>(attributeData, 3), destination3f);
     else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
 
     /* For 2D positions finally fill the Z with a single value */
-    if(attribute._format == VertexFormat::Vector2 ||
-       attribute._format == VertexFormat::Vector2h ||
-       attribute._format == VertexFormat::Vector2ub ||
-       attribute._format == VertexFormat::Vector2b ||
-       attribute._format == VertexFormat::Vector2us ||
-       attribute._format == VertexFormat::Vector2s ||
-       attribute._format == VertexFormat::Vector2ubNormalized ||
-       attribute._format == VertexFormat::Vector2bNormalized ||
-       attribute._format == VertexFormat::Vector2usNormalized ||
-       attribute._format == VertexFormat::Vector2sNormalized) {
+    if(format == VertexFormat::Vector2 ||
+       format == VertexFormat::Vector2h ||
+       format == VertexFormat::Vector2ub ||
+       format == VertexFormat::Vector2b ||
+       format == VertexFormat::Vector2us ||
+       format == VertexFormat::Vector2s ||
+       format == VertexFormat::Vector2ubNormalized ||
+       format == VertexFormat::Vector2bNormalized ||
+       format == VertexFormat::Vector2usNormalized ||
+       format == VertexFormat::Vector2sNormalized) {
         constexpr Float z[1]{0.0f};
         Utility::copy(
-            Containers::stridedArrayView(z).broadcasted<0>(_vertexCount),
+            Containers::stridedArrayView(z).broadcasted<0>(destination.size()),
             destination3f.transposed<0, 1>()[2]);
     }
 }
 
+}
+
+void MeshData::positions3DInto(const Containers::StridedArrayView1D<Vector3>& destination, const UnsignedInt id) const {
+    const UnsignedInt attributeId = findAttributeIdInternal(MeshAttribute::Position, id);
+    CORRADE_ASSERT(attributeId != ~UnsignedInt{}, "Trade::MeshData::positions3DInto(): index" << id << "out of range for" << attributeCount(MeshAttribute::Position) << "position attributes", );
+    CORRADE_ASSERT(destination.size() == _vertexCount, "Trade::MeshData::positions3DInto(): expected a view with" << _vertexCount << "elements but got" << destination.size(), );
+    const MeshAttributeData& attribute = _attributes[attributeId];
+    CORRADE_ASSERT(!isVertexFormatImplementationSpecific(attribute._format),
+        "Trade::MeshData::positions3DInto(): can't extract data out of an implementation-specific vertex format" << reinterpret_cast<void*>(vertexFormatUnwrap(attribute._format)), );
+    positions3DIntoImplementation(attributeDataViewInternal(attribute), destination, attribute._format);
+}
+
+void MeshData::positions3DInto(const Containers::StridedArrayView1D<Vector3>& destination, const std::size_t offset, const UnsignedInt id) const {
+    const UnsignedInt attributeId = findAttributeIdInternal(MeshAttribute::Position, id);
+    CORRADE_ASSERT(attributeId != ~UnsignedInt{}, "Trade::MeshData::positions3DInto(): index" << id << "out of range for" << attributeCount(MeshAttribute::Position) << "position attributes", );
+    CORRADE_ASSERT(offset + destination.size() <= _vertexCount, "Trade::MeshData::positions3DInto(): range [" << Debug::nospace << offset << Debug::nospace << ":" << Debug::nospace << offset + destination.size() << Debug::nospace << "] out of bounds for" << _vertexCount << "vertices", );
+    const MeshAttributeData& attribute = _attributes[attributeId];
+    CORRADE_ASSERT(!isVertexFormatImplementationSpecific(attribute._format),
+        "Trade::MeshData::positions3DInto(): can't extract data out of an implementation-specific vertex format" << reinterpret_cast<void*>(vertexFormatUnwrap(attribute._format)), );
+    positions3DIntoImplementation(attributeDataViewInternal(attribute).sliceSize(offset, destination.size()), destination, attribute._format);
+}
+
 Containers::Array<Vector3> MeshData::positions3DAsArray(const UnsignedInt id) const {
     Containers::Array<Vector3> out{NoInit, _vertexCount};
     positions3DInto(out, id);
@@ -737,45 +754,72 @@ void MeshData::normalsInto(const Containers::StridedArrayView1D<Vector3>& destin
     tangentsOrNormalsInto(attributeDataViewInternal(attribute), destination, attribute._format);
 }
 
+void MeshData::normalsInto(const Containers::StridedArrayView1D<Vector3>& destination, const std::size_t offset, const UnsignedInt id) const {
+    const UnsignedInt attributeId = findAttributeIdInternal(MeshAttribute::Normal, id);
+    CORRADE_ASSERT(attributeId != ~UnsignedInt{}, "Trade::MeshData::normalsInto(): index" << id << "out of range for" << attributeCount(MeshAttribute::Normal) << "normal attributes", );
+    CORRADE_ASSERT(offset + destination.size() <= _vertexCount, "Trade::MeshData::normalsInto(): range [" << Debug::nospace << offset << Debug::nospace << ":" << Debug::nospace << offset + destination.size() << Debug::nospace << "] out of bounds for" << _vertexCount << "vertices", );
+    const MeshAttributeData& attribute = _attributes[attributeId];
+    CORRADE_ASSERT(!isVertexFormatImplementationSpecific(attribute._format),
+        "Trade::MeshData::normalsInto(): can't extract data out of an implementation-specific vertex format" << reinterpret_cast<void*>(vertexFormatUnwrap(attribute._format)), );
+    tangentsOrNormalsInto(attributeDataViewInternal(attribute).sliceSize(offset, destination.size()), destination, attribute._format);
+}
+
 Containers::Array<Vector3> MeshData::normalsAsArray(const UnsignedInt id) const {
     Containers::Array<Vector3> out{NoInit, _vertexCount};
     normalsInto(out, id);
     return out;
 }
 
-void MeshData::textureCoordinates2DInto(const Containers::StridedArrayView1D<Vector2>& destination, const UnsignedInt id) const {
-    const UnsignedInt attributeId = findAttributeIdInternal(MeshAttribute::TextureCoordinates, id);
-    CORRADE_ASSERT(attributeId != ~UnsignedInt{}, "Trade::MeshData::textureCoordinates2DInto(): index" << id << "out of range for" << attributeCount(MeshAttribute::TextureCoordinates) << "texture coordinate attributes", );
-    CORRADE_ASSERT(destination.size() == _vertexCount, "Trade::MeshData::textureCoordinates2DInto(): expected a view with" << _vertexCount << "elements but got" << destination.size(), );
-    const MeshAttributeData& attribute = _attributes[attributeId];
-    CORRADE_ASSERT(!isVertexFormatImplementationSpecific(attribute._format),
-        "Trade::MeshData::textureCoordinatesInto(): can't extract data out of an implementation-specific vertex format" << reinterpret_cast<void*>(vertexFormatUnwrap(attribute._format)), );
-    const Containers::StridedArrayView1D<const void> attributeData = attributeDataViewInternal(attribute);
+namespace {
+
+void textureCoordinates2DIntoImplementation(const Containers::StridedArrayView1D<const void>& attributeData, const Containers::StridedArrayView1D<Vector2>& destination, const VertexFormat format) {
     const auto destination2f = Containers::arrayCast<2, Float>(destination);
 
-    if(attribute._format == VertexFormat::Vector2)
+    if(format == VertexFormat::Vector2)
         Utility::copy(Containers::arrayCast<const Vector2>(attributeData), destination);
-    else if(attribute._format == VertexFormat::Vector2h)
+    else if(format == VertexFormat::Vector2h)
         Math::unpackHalfInto(Containers::arrayCast<2, const UnsignedShort>(attributeData, 2), destination2f);
-    else if(attribute._format == VertexFormat::Vector2ub)
+    else if(format == VertexFormat::Vector2ub)
         Math::castInto(Containers::arrayCast<2, const UnsignedByte>(attributeData, 2), destination2f);
-    else if(attribute._format == VertexFormat::Vector2b)
+    else if(format == VertexFormat::Vector2b)
         Math::castInto(Containers::arrayCast<2, const Byte>(attributeData, 2), destination2f);
-    else if(attribute._format == VertexFormat::Vector2us)
+    else if(format == VertexFormat::Vector2us)
         Math::castInto(Containers::arrayCast<2, const UnsignedShort>(attributeData, 2), destination2f);
-    else if(attribute._format == VertexFormat::Vector2s)
+    else if(format == VertexFormat::Vector2s)
         Math::castInto(Containers::arrayCast<2, const Short>(attributeData, 2), destination2f);
-    else if(attribute._format == VertexFormat::Vector2ubNormalized)
+    else if(format == VertexFormat::Vector2ubNormalized)
         Math::unpackInto(Containers::arrayCast<2, const UnsignedByte>(attributeData, 2), destination2f);
-    else if(attribute._format == VertexFormat::Vector2bNormalized)
+    else if(format == VertexFormat::Vector2bNormalized)
         Math::unpackInto(Containers::arrayCast<2, const Byte>(attributeData, 2), destination2f);
-    else if(attribute._format == VertexFormat::Vector2usNormalized)
+    else if(format == VertexFormat::Vector2usNormalized)
         Math::unpackInto(Containers::arrayCast<2, const UnsignedShort>(attributeData, 2), destination2f);
-    else if(attribute._format == VertexFormat::Vector2sNormalized)
+    else if(format == VertexFormat::Vector2sNormalized)
         Math::unpackInto(Containers::arrayCast<2, const Short>(attributeData, 2), destination2f);
     else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
 }
 
+}
+
+void MeshData::textureCoordinates2DInto(const Containers::StridedArrayView1D<Vector2>& destination, const UnsignedInt id) const {
+    const UnsignedInt attributeId = findAttributeIdInternal(MeshAttribute::TextureCoordinates, id);
+    CORRADE_ASSERT(attributeId != ~UnsignedInt{}, "Trade::MeshData::textureCoordinates2DInto(): index" << id << "out of range for" << attributeCount(MeshAttribute::TextureCoordinates) << "texture coordinate attributes", );
+    CORRADE_ASSERT(destination.size() == _vertexCount, "Trade::MeshData::textureCoordinates2DInto(): expected a view with" << _vertexCount << "elements but got" << destination.size(), );
+    const MeshAttributeData& attribute = _attributes[attributeId];
+    CORRADE_ASSERT(!isVertexFormatImplementationSpecific(attribute._format),
+        "Trade::MeshData::textureCoordinatesInto(): can't extract data out of an implementation-specific vertex format" << reinterpret_cast<void*>(vertexFormatUnwrap(attribute._format)), );
+    textureCoordinates2DIntoImplementation(attributeDataViewInternal(attribute), destination, attribute._format);
+}
+
+void MeshData::textureCoordinates2DInto(const Containers::StridedArrayView1D<Vector2>& destination, const std::size_t offset, const UnsignedInt id) const {
+    const UnsignedInt attributeId = findAttributeIdInternal(MeshAttribute::TextureCoordinates, id);
+    CORRADE_ASSERT(attributeId != ~UnsignedInt{}, "Trade::MeshData::textureCoordinates2DInto(): index" << id << "out of range for" << attributeCount(MeshAttribute::TextureCoordinates) << "texture coordinate attributes", );
+    CORRADE_ASSERT(offset + destination.size() <= _vertexCount, "Trade::MeshData::textureCoordinates2DInto(): range [" << Debug::nospace << offset << Debug::nospace << ":" << Debug::nospace << offset + destination.size() << Debug::nospace << "] out of bounds for" << _vertexCount << "vertices", );
+    const MeshAttributeData& attribute = _attributes[attributeId];
+    CORRADE_ASSERT(!isVertexFormatImplementationSpecific(attribute._format),
+        "Trade::MeshData::textureCoordinatesInto(): can't extract data out of an implementation-specific vertex format" << reinterpret_cast<void*>(vertexFormatUnwrap(attribute._format)), );
+    textureCoordinates2DIntoImplementation(attributeDataViewInternal(attribute).sliceSize(offset, destination.size()), destination, attribute._format);
+}
+
 Containers::Array<Vector2> MeshData::textureCoordinates2DAsArray(const UnsignedInt id) const {
     Containers::Array<Vector2> out{NoInit, _vertexCount};
     textureCoordinates2DInto(out, id);
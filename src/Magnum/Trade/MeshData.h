@@ -1719,6 +1719,20 @@ class MAGNUM_TRADE_EXPORT MeshData {
          */
         void positions3DInto(const Containers::StridedArrayView1D<Vector3>& destination, UnsignedInt id = 0) const;
 
+        /**
+         * @brief Positions as 3D float vectors in a sub-range into a pre-allocated view
+         * @m_since_latest
+         *
+         * Like @ref positions3DInto(const Containers::StridedArrayView1D<Vector3>&, UnsignedInt) const,
+         * but converts only @p destination size vertices starting at
+         * @p offset. Useful for processing large meshes in cache-friendly
+         * chunks without allocating a copy of the whole attribute. Expects
+         * that the range fits into @ref vertexCount(). The @p id parameter
+         * has no default value in order to avoid ambiguity with the above
+         * overload.
+         */
+        void positions3DInto(const Containers::StridedArrayView1D<Vector3>& destination, std::size_t offset, UnsignedInt id) const;
+
         /**
          * @brief Tangents as 3D float vectors
          *
@@ -1829,6 +1843,20 @@ class MAGNUM_TRADE_EXPORT MeshData {
          */
         void normalsInto(const Containers::StridedArrayView1D<Vector3>& destination, UnsignedInt id = 0) const;
 
+        /**
+         * @brief Normals as 3D float vectors in a sub-range into a pre-allocated view
+         * @m_since_latest
+         *
+         * Like @ref normalsInto(const Containers::StridedArrayView1D<Vector3>&, UnsignedInt) const,
+         * but converts only @p destination size vertices starting at
+         * @p offset. Useful for processing large meshes in cache-friendly
+         * chunks without allocating a copy of the whole attribute. Expects
+         * that the range fits into @ref vertexCount(). The @p id parameter
+         * has no default value in order to avoid ambiguity with the above
+         * overload.
+         */
+        void normalsInto(const Containers::StridedArrayView1D<Vector3>& destination, std::size_t offset, UnsignedInt id) const;
+
         /**
          * @brief Texture coordinates as 2D float vectors
          *
@@ -1854,6 +1882,20 @@ class MAGNUM_TRADE_EXPORT MeshData {
          */
         void textureCoordinates2DInto(const Containers::StridedArrayView1D<Vector2>& destination, UnsignedInt id = 0) const;
 
+        /**
+         * @brief Texture coordinates as 2D float vectors in a sub-range into a pre-allocated view
+         * @m_since_latest
+         *
+         * Like @ref textureCoordinates2DInto(const Containers::StridedArrayView1D<Vector2>&, UnsignedInt) const,
+         * but converts only @p destination size vertices starting at
+         * @p offset. Useful for processing large meshes in cache-friendly
+         * chunks without allocating a copy of the whole attribute. Expects
+         * that the range fits into @ref vertexCount(). The @p id parameter
+         * has no default value in order to avoid ambiguity with the above
+         * overload.
+         */
+        void textureCoordinates2DInto(const Containers::StridedArrayView1D<Vector2>& destination, std::size_t offset, UnsignedInt id) const;
+
         /**
          * @brief Colors as RGBA floats
          *
@@ -0,0 +1,109 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ParallelLoad.h"
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <atomic>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/TaskScheduler.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace Trade {
+
+namespace {
+
+template<class T, class F> Containers::Array<Containers::Optional<T>> parallelLoad(AbstractImporter& importer, const Containers::ArrayView<const UnsignedInt> ids, UnsignedInt threadCount, F load) {
+    Containers::Array<Containers::Optional<T>> out{ids.size()};
+
+    TaskScheduler& scheduler = TaskScheduler::global();
+    if(!threadCount) threadCount = scheduler.threadCount();
+    threadCount = Math::min(threadCount, UnsignedInt(ids.size()));
+    if(threadCount > 1 && (importer.features() & ImporterFeature::ThreadSafeImport)) {
+        /* Items can take vastly different time to import, so instead of
+           splitting the IDs into fixed chunks each task picks the next
+           unprocessed one */
+        std::atomic<std::size_t> next{0};
+        scheduler.parallelFor(threadCount, threadCount, [&](std::size_t, std::size_t) {
+            for(std::size_t i; (i = next++) < ids.size(); )
+                out[i] = load(importer, ids[i]);
+        });
+
+        return out;
+    }
+
+    for(std::size_t i = 0; i != ids.size(); ++i)
+        out[i] = load(importer, ids[i]);
+    return out;
+}
+
+}
+
+Containers::Array<Containers::Optional<MeshData>> parallelLoadMeshes(AbstractImporter& importer, const Containers::ArrayView<const UnsignedInt> ids, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(importer.isOpened(),
+        "Trade::parallelLoadMeshes(): no file opened", {});
+    /* Check the ranges upfront so the assertions don't fire from the worker
+       threads */
+    #ifndef CORRADE_NO_ASSERT
+    const UnsignedInt count = importer.meshCount();
+    for(const UnsignedInt id: ids)
+        CORRADE_ASSERT(id < count,
+            "Trade::parallelLoadMeshes(): index" << id << "out of range for" << count << "entries", {});
+    #endif
+
+    return parallelLoad<MeshData>(importer, ids, threadCount, [](AbstractImporter& from, UnsignedInt id) {
+        return from.mesh(id);
+    });
+}
+
+Containers::Array<Containers::Optional<MeshData>> parallelLoadMeshes(AbstractImporter& importer, const std::initializer_list<UnsignedInt> ids, const UnsignedInt threadCount) {
+    return parallelLoadMeshes(importer, Containers::arrayView(ids), threadCount);
+}
+
+Containers::Array<Containers::Optional<ImageData2D>> parallelLoadImages2D(AbstractImporter& importer, const Containers::ArrayView<const UnsignedInt> ids, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(importer.isOpened(),
+        "Trade::parallelLoadImages2D(): no file opened", {});
+    #ifndef CORRADE_NO_ASSERT
+    const UnsignedInt count = importer.image2DCount();
+    for(const UnsignedInt id: ids)
+        CORRADE_ASSERT(id < count,
+            "Trade::parallelLoadImages2D(): index" << id << "out of range for" << count << "entries", {});
+    #endif
+
+    return parallelLoad<ImageData2D>(importer, ids, threadCount, [](AbstractImporter& from, UnsignedInt id) {
+        return from.image2D(id);
+    });
+}
+
+Containers::Array<Containers::Optional<ImageData2D>> parallelLoadImages2D(AbstractImporter& importer, const std::initializer_list<UnsignedInt> ids, const UnsignedInt threadCount) {
+    return parallelLoadImages2D(importer, Containers::arrayView(ids), threadCount);
+}
+
+}}
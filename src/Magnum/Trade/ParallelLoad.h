@@ -0,0 +1,95 @@
+#ifndef Magnum_Trade_ParallelLoad_h
+#define Magnum_Trade_ParallelLoad_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::Trade::parallelLoadMeshes(), @ref Magnum::Trade::parallelLoadImages2D()
+ * @m_since_latest
+ */
+
+#include <initializer_list>
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Trade/Trade.h"
+#include "Magnum/Trade/visibility.h"
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Load meshes in parallel
+@param importer     Importer to load the meshes from
+@param ids          Mesh IDs, from range [0, @ref AbstractImporter::meshCount())
+@param threadCount  Max count of threads to use. If @cpp 0 @ce,
+    @ref TaskScheduler::threadCount() of @ref TaskScheduler::global() is
+    used.
+@return Meshes corresponding to @p ids, a @ref Containers::NullOpt for meshes
+    that failed to import
+@m_since_latest
+
+If the @p importer advertises @ref ImporterFeature::ThreadSafeImport, the IDs
+are distributed over up to @p threadCount threads, each calling
+@ref AbstractImporter::mesh() on the same importer instance. Otherwise, or if
+Corrade isn't built with @ref CORRADE_BUILD_MULTITHREADED, or on Emscripten,
+the meshes are loaded sequentially on the calling thread. Only the first level
+of each mesh is loaded. Expects that the importer has a file opened and all
+@p ids are in range.
+
+@snippet MagnumTrade.cpp parallelLoadMeshes
+*/
+MAGNUM_TRADE_EXPORT Containers::Array<Containers::Optional<MeshData>> parallelLoadMeshes(AbstractImporter& importer, Containers::ArrayView<const UnsignedInt> ids, UnsignedInt threadCount = 0);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_TRADE_EXPORT Containers::Array<Containers::Optional<MeshData>> parallelLoadMeshes(AbstractImporter& importer, std::initializer_list<UnsignedInt> ids, UnsignedInt threadCount = 0);
+
+/**
+@brief Load 2D images in parallel
+@param importer     Importer to load the images from
+@param ids          Image IDs, from range [0, @ref AbstractImporter::image2DCount())
+@param threadCount  Max count of threads to use. If @cpp 0 @ce,
+    @ref TaskScheduler::threadCount() of @ref TaskScheduler::global() is
+    used.
+@return Images corresponding to @p ids, a @ref Containers::NullOpt for images
+    that failed to import
+@m_since_latest
+
+Like @ref parallelLoadMeshes(), but calling @ref AbstractImporter::image2D().
+Only the first level of each image is loaded.
+*/
+MAGNUM_TRADE_EXPORT Containers::Array<Containers::Optional<ImageData2D>> parallelLoadImages2D(AbstractImporter& importer, Containers::ArrayView<const UnsignedInt> ids, UnsignedInt threadCount = 0);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_TRADE_EXPORT Containers::Array<Containers::Optional<ImageData2D>> parallelLoadImages2D(AbstractImporter& importer, std::initializer_list<UnsignedInt> ids, UnsignedInt threadCount = 0);
+
+}}
+
+#endif
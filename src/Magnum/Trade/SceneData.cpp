@@ -1303,29 +1303,57 @@ template<class Source, class Destination> void expandTransformationMatrix(const
         destination[i] = Destination{Math::RectangularMatrix<Source::Cols, Source::Rows, Float>{sourceT[i]}};
 }
 
-/** @todo these (or the float variants at least) should eventually be replaced
-    with optimized batched APIs (applyTranslationsInto() updating just the
-    last matrix column etc.) */
+/* Compared to a full matrix multiplication these update only the parts of
+   the matrix that actually change. Multiplying a translation, rotation or
+   scaling from the left affects only the upper N rows, and for translation
+   it's just the bottom row scaled by the translation vector added to it,
+   which is a no-op for all but the last column of an affine matrix. That's
+   ~12 mul-adds for a 3D translation or scaling instead of 64. */
 
 template<class Source, class Destination> void applyTranslation(const Containers::StridedArrayView1D<const void>& source, const Containers::StridedArrayView1D<Destination>& destination) {
     CORRADE_INTERNAL_ASSERT(source.size() == destination.size());
+    constexpr std::size_t Dimensions = Destination::Size - 1;
     const auto sourceT = Containers::arrayCast<const Source>(source);
-    for(std::size_t i = 0; i != sourceT.size(); ++i)
-        destination[i] = Destination::translation(Math::Vector<Destination::Size - 1, Float>{sourceT[i]})*destination[i];
+    for(std::size_t i = 0; i != sourceT.size(); ++i) {
+        const Math::Vector<Dimensions, Float> translation{sourceT[i]};
+        Destination& matrix = destination[i];
+        for(std::size_t col = 0; col != Destination::Size; ++col) {
+            const Float w = matrix[col][Dimensions];
+            for(std::size_t row = 0; row != Dimensions; ++row)
+                matrix[col][row] += translation[row]*w;
+        }
+    }
 }
 
 template<class Source, class Destination> void applyRotation(const Containers::StridedArrayView1D<const void>& source, const Containers::StridedArrayView1D<Destination>& destination) {
     CORRADE_INTERNAL_ASSERT(source.size() == destination.size());
+    constexpr std::size_t Dimensions = Destination::Size - 1;
     const auto sourceT = Containers::arrayCast<const Source>(source);
-    for(std::size_t i = 0; i != sourceT.size(); ++i)
-        destination[i] = Destination{Math::Matrix<Destination::Size - 1, Float>{ sourceT[i].toMatrix()}}*destination[i];
+    for(std::size_t i = 0; i != sourceT.size(); ++i) {
+        const Math::Matrix<Dimensions, Float> rotation{sourceT[i].toMatrix()};
+        Destination& matrix = destination[i];
+        for(std::size_t col = 0; col != Destination::Size; ++col) {
+            Math::Vector<Dimensions, Float> column{Math::NoInit};
+            for(std::size_t row = 0; row != Dimensions; ++row)
+                column[row] = matrix[col][row];
+            column = rotation*column;
+            for(std::size_t row = 0; row != Dimensions; ++row)
+                matrix[col][row] = column[row];
+        }
+    }
 }
 
 template<class Source, class Destination> void applyScaling(const Containers::StridedArrayView1D<const void>& source, const Containers::StridedArrayView1D<Destination>& destination) {
     CORRADE_INTERNAL_ASSERT(source.size() == destination.size());
+    constexpr std::size_t Dimensions = Destination::Size - 1;
     const auto sourceT = Containers::arrayCast<const Source>(source);
-    for(std::size_t i = 0; i != sourceT.size(); ++i)
-        destination[i] = Destination::scaling(Math::Vector<Destination::Size - 1, Float>{sourceT[i]})*destination[i];
+    for(std::size_t i = 0; i != sourceT.size(); ++i) {
+        const Math::Vector<Dimensions, Float> scaling{sourceT[i]};
+        Destination& matrix = destination[i];
+        for(std::size_t col = 0; col != Destination::Size; ++col)
+            for(std::size_t row = 0; row != Dimensions; ++row)
+                matrix[col][row] *= scaling[row];
+    }
 }
 
 }
@@ -2233,6 +2233,10 @@ class MAGNUM_TRADE_EXPORT SceneData {
          * of the views, returning the count of items actually extracted. The
          * @p offset is expected to not be larger than the field size, views
          * that are not @cpp nullptr @ce are expected to have the same size.
+         *
+         * The function doesn't modify any internal state, so for scenes with
+         * a large amount of objects it can be called from multiple threads
+         * at once, each extracting a disjoint subrange of the field.
          * @see @ref transformationFieldSize(),
          *      @ref fieldObjectOffset(SceneField, UnsignedLong, std::size_t) const
          */
@@ -2289,6 +2293,9 @@ class MAGNUM_TRADE_EXPORT SceneData {
          * of the views, returning the count of items actually extracted. The
          * @p offset is expected to not be larger than the field size, views
          * that are not @cpp nullptr @ce are expected to have the same size.
+         *
+         * Similarly to @ref transformations3DInto(std::size_t, const Containers::StridedArrayView1D<UnsignedInt>&, const Containers::StridedArrayView1D<Matrix4>&) const
+         * disjoint subranges can be extracted from multiple threads at once.
          * @see @ref transformationFieldSize(),
          *      @ref fieldObjectOffset(SceneField, UnsignedLong, std::size_t) const
          */
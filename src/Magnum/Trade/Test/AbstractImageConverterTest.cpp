@@ -291,6 +291,13 @@ struct AbstractImageConverterTest: TestSuite::Tester {
     void convertCompressed2DToFileThroughLevels();
     void convertCompressed3DToFileThroughLevels();
 
+    void convertRows2DToFile();
+    void convertRows2DToFileFailed();
+    void convertRows2DToFileIncomplete();
+    void convertRows2DToFileNotSupported();
+    void convertRows2DToFileNotImplemented();
+    void convertRows2DToFileInvalid();
+
     void debugFeature();
     void debugFeatures();
     void debugFeaturesSupersets();
@@ -523,6 +530,13 @@ AbstractImageConverterTest::AbstractImageConverterTest() {
               &AbstractImageConverterTest::convertCompressed2DToFileThroughLevels,
               &AbstractImageConverterTest::convertCompressed3DToFileThroughLevels,
 
+              &AbstractImageConverterTest::convertRows2DToFile,
+              &AbstractImageConverterTest::convertRows2DToFileFailed,
+              &AbstractImageConverterTest::convertRows2DToFileIncomplete,
+              &AbstractImageConverterTest::convertRows2DToFileNotSupported,
+              &AbstractImageConverterTest::convertRows2DToFileNotImplemented,
+              &AbstractImageConverterTest::convertRows2DToFileInvalid,
+
               &AbstractImageConverterTest::debugFeature,
               &AbstractImageConverterTest::debugFeatures,
               &AbstractImageConverterTest::debugFeaturesSupersets,
@@ -4187,6 +4201,160 @@ void AbstractImageConverterTest::convertCompressed3DToFileThroughLevels() {
         "\x0f\x0d\x0e\x01", TestSuite::Compare::FileToString);
 }
 
+void AbstractImageConverterTest::convertRows2DToFile() {
+    struct: AbstractImageConverter {
+        ImageConverterFeatures doFeatures() const override { return ImageConverterFeature::ConvertRows2DToFile; }
+
+        bool doBeginConvertRowsToFile(Containers::StringView filename, PixelFormat format, const Vector2i& size) override {
+            CORRADE_COMPARE(filename, "image.out");
+            CORRADE_COMPARE(format, PixelFormat::RGBA8Unorm);
+            CORRADE_COMPARE(size, (Vector2i{2, 5}));
+            began = true;
+            return true;
+        }
+        bool doConvertRowsToFile(const ImageView2D& rows) override {
+            CORRADE_COMPARE(rows.size().x(), 2);
+            rowCount += rows.size().y();
+            return true;
+        }
+        bool doEndConvertRowsToFile() override {
+            ended = true;
+            return true;
+        }
+
+        bool began = false, ended = false;
+        Int rowCount = 0;
+    } converter;
+
+    const char data[40]{};
+    CORRADE_VERIFY(!converter.isConvertingRowsToFile());
+    CORRADE_VERIFY(converter.beginConvertRowsToFile("image.out", PixelFormat::RGBA8Unorm, {2, 5}));
+    CORRADE_VERIFY(converter.began);
+    CORRADE_VERIFY(converter.isConvertingRowsToFile());
+    CORRADE_VERIFY(converter.convertRowsToFile(ImageView2D{PixelFormat::RGBA8Unorm, {2, 2}, data}));
+    CORRADE_VERIFY(converter.convertRowsToFile(ImageView2D{PixelFormat::RGBA8Unorm, {2, 3}, data}));
+    CORRADE_COMPARE(converter.rowCount, 5);
+    CORRADE_VERIFY(converter.endConvertRowsToFile());
+    CORRADE_VERIFY(converter.ended);
+    CORRADE_VERIFY(!converter.isConvertingRowsToFile());
+}
+
+void AbstractImageConverterTest::convertRows2DToFileFailed() {
+    struct: AbstractImageConverter {
+        ImageConverterFeatures doFeatures() const override { return ImageConverterFeature::ConvertRows2DToFile; }
+
+        bool doBeginConvertRowsToFile(Containers::StringView, PixelFormat, const Vector2i&) override {
+            return false;
+        }
+    } converter;
+
+    /* The implementation is expected to print an error message on its own */
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!converter.beginConvertRowsToFile("image.out", PixelFormat::RGBA8Unorm, {2, 5}));
+    CORRADE_VERIFY(!converter.isConvertingRowsToFile());
+    CORRADE_COMPARE(out.str(), "");
+}
+
+void AbstractImageConverterTest::convertRows2DToFileIncomplete() {
+    struct: AbstractImageConverter {
+        ImageConverterFeatures doFeatures() const override { return ImageConverterFeature::ConvertRows2DToFile; }
+
+        bool doBeginConvertRowsToFile(Containers::StringView, PixelFormat, const Vector2i&) override {
+            return true;
+        }
+        bool doConvertRowsToFile(const ImageView2D&) override {
+            return true;
+        }
+        bool doEndConvertRowsToFile() override {
+            ended = true;
+            return true;
+        }
+
+        bool ended = false;
+    } converter;
+
+    const char data[16]{};
+    CORRADE_VERIFY(converter.beginConvertRowsToFile("image.out", PixelFormat::RGBA8Unorm, {2, 5}));
+    CORRADE_VERIFY(converter.convertRowsToFile(ImageView2D{PixelFormat::RGBA8Unorm, {2, 2}, data}));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!converter.endConvertRowsToFile());
+    /* The implementation should still get called to clean up */
+    CORRADE_VERIFY(converter.ended);
+    CORRADE_VERIFY(!converter.isConvertingRowsToFile());
+    CORRADE_COMPARE(out.str(), "Trade::AbstractImageConverter::endConvertRowsToFile(): expected 5 rows but got 2\n");
+}
+
+void AbstractImageConverterTest::convertRows2DToFileNotSupported() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    struct: AbstractImageConverter {
+        ImageConverterFeatures doFeatures() const override { return ImageConverterFeature::Convert2DToFile; }
+    } converter;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    converter.beginConvertRowsToFile("image.out", PixelFormat::RGBA8Unorm, {2, 5});
+    CORRADE_COMPARE(out.str(), "Trade::AbstractImageConverter::beginConvertRowsToFile(): incremental 2D image conversion not supported\n");
+}
+
+void AbstractImageConverterTest::convertRows2DToFileNotImplemented() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    struct: AbstractImageConverter {
+        ImageConverterFeatures doFeatures() const override { return ImageConverterFeature::ConvertRows2DToFile; }
+    } converter;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    converter.beginConvertRowsToFile("image.out", PixelFormat::RGBA8Unorm, {2, 5});
+    CORRADE_COMPARE(out.str(), "Trade::AbstractImageConverter::beginConvertRowsToFile(): incremental 2D image conversion advertised but not implemented\n");
+}
+
+void AbstractImageConverterTest::convertRows2DToFileInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    struct: AbstractImageConverter {
+        ImageConverterFeatures doFeatures() const override { return ImageConverterFeature::ConvertRows2DToFile; }
+
+        bool doBeginConvertRowsToFile(Containers::StringView, PixelFormat, const Vector2i&) override {
+            return true;
+        }
+        bool doConvertRowsToFile(const ImageView2D&) override {
+            return true;
+        }
+        bool doEndConvertRowsToFile() override {
+            return true;
+        }
+    } converter;
+
+    const char data[48]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    converter.convertRowsToFile(ImageView2D{PixelFormat::RGBA8Unorm, {2, 2}, data});
+    converter.endConvertRowsToFile();
+    converter.beginConvertRowsToFile("image.out", PixelFormat::RGBA8Unorm, {2, 0});
+
+    CORRADE_VERIFY(converter.beginConvertRowsToFile("image.out", PixelFormat::RGBA8Unorm, {2, 5}));
+    converter.beginConvertRowsToFile("image.out", PixelFormat::RGBA8Unorm, {2, 5});
+    converter.convertRowsToFile(ImageView2D{PixelFormat::RGB8Unorm, {2, 2}, data});
+    converter.convertRowsToFile(ImageView2D{PixelFormat::RGBA8Unorm, {3, 2}, data});
+    converter.convertRowsToFile(ImageView2D{PixelFormat::RGBA8Unorm, {2, 6}, data});
+    converter.convertRowsToFile(ImageView2D{PixelFormat::RGBA8Unorm, {2, 0}, data});
+    CORRADE_COMPARE(out.str(),
+        "Trade::AbstractImageConverter::convertRowsToFile(): no conversion in progress\n"
+        "Trade::AbstractImageConverter::endConvertRowsToFile(): no conversion in progress\n"
+        "Trade::AbstractImageConverter::beginConvertRowsToFile(): can't convert image with a zero size: Vector(2, 0)\n"
+        "Trade::AbstractImageConverter::beginConvertRowsToFile(): a conversion is already in progress\n"
+        "Trade::AbstractImageConverter::convertRowsToFile(): expected PixelFormat::RGBA8Unorm but got PixelFormat::RGB8Unorm\n"
+        "Trade::AbstractImageConverter::convertRowsToFile(): expected width 2 but got 3\n"
+        "Trade::AbstractImageConverter::convertRowsToFile(): can't add 6 rows to 0 out of 5\n"
+        "Trade::AbstractImageConverter::convertRowsToFile(): can't convert image with a zero size: Vector(2, 0)\n");
+}
+
 void AbstractImageConverterTest::debugFeature() {
     std::ostringstream out;
 
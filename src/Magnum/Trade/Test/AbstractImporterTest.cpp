@@ -39,10 +39,13 @@
 #include "Magnum/FileCallback.h"
 #include "Magnum/Math/Matrix3.h"
 #include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Range.h"
 #include "Magnum/Trade/AbstractImporter.h"
 #include "Magnum/Trade/AnimationData.h"
 #include "Magnum/Trade/ArrayAllocator.h"
+#include "Magnum/Trade/DataArena.h"
 #include "Magnum/Trade/CameraData.h"
+#include "Magnum/Trade/ChunkedMeshData.h"
 #include "Magnum/Trade/ImageData.h"
 #include "Magnum/Trade/LightData.h"
 #include "Magnum/Trade/MeshData.h"
@@ -90,6 +93,9 @@ struct AbstractImporterTest: TestSuite::Tester {
     void openFileFailed();
     void openFileAsData();
     void openFileAsDataNotFound();
+    void openFileAsDataMapped();
+    void openFileAsDataMappedFailed();
+    void openFileAsDataMappedNotFound();
     void openState();
     void openStateFailed();
 
@@ -261,10 +267,22 @@ struct AbstractImporterTest: TestSuite::Tester {
     void meshLevelOutOfRange();
     void meshNonOwningDeleters();
     void meshGrowableDeleters();
+    void meshDataArena();
     void meshCustomIndexDataDeleter();
     void meshCustomVertexDataDeleter();
     void meshCustomAttributesDeleter();
 
+    void meshChunks();
+    void meshChunksIndexed();
+    void meshChunksNoPositions();
+    void meshChunksNotWholePrimitives();
+    void meshChunksZeroChunkSize();
+    void meshChunksOutOfRange();
+    void meshChunk();
+    void meshChunkIndexed();
+    void meshChunkOutOfBounds();
+    void meshChunkOutOfRange();
+
     void meshAttributeName();
     void meshAttributeNameNotImplemented();
     void meshAttributeNameNotCustom();
@@ -351,6 +369,11 @@ struct AbstractImporterTest: TestSuite::Tester {
     void image2DNonOwningDeleter();
     void image2DGrowableDeleter();
     void image2DCustomDeleter();
+    void image2DSize();
+    void image2DRows();
+    void image2DRowsOutOfRange();
+    void image2DRowsCompressed();
+    void image2DRowsInvalid();
 
     void image3D();
     void image3DFailed();
@@ -407,6 +430,9 @@ AbstractImporterTest::AbstractImporterTest() {
               &AbstractImporterTest::openFileFailed,
               &AbstractImporterTest::openFileAsData,
               &AbstractImporterTest::openFileAsDataNotFound,
+              &AbstractImporterTest::openFileAsDataMapped,
+              &AbstractImporterTest::openFileAsDataMappedFailed,
+              &AbstractImporterTest::openFileAsDataMappedNotFound,
               &AbstractImporterTest::openState,
               &AbstractImporterTest::openStateFailed,
 
@@ -587,10 +613,22 @@ AbstractImporterTest::AbstractImporterTest() {
               &AbstractImporterTest::meshLevelOutOfRange,
               &AbstractImporterTest::meshNonOwningDeleters,
               &AbstractImporterTest::meshGrowableDeleters,
+              &AbstractImporterTest::meshDataArena,
               &AbstractImporterTest::meshCustomIndexDataDeleter,
               &AbstractImporterTest::meshCustomVertexDataDeleter,
               &AbstractImporterTest::meshCustomAttributesDeleter,
 
+              &AbstractImporterTest::meshChunks,
+              &AbstractImporterTest::meshChunksIndexed,
+              &AbstractImporterTest::meshChunksNoPositions,
+              &AbstractImporterTest::meshChunksNotWholePrimitives,
+              &AbstractImporterTest::meshChunksZeroChunkSize,
+              &AbstractImporterTest::meshChunksOutOfRange,
+              &AbstractImporterTest::meshChunk,
+              &AbstractImporterTest::meshChunkIndexed,
+              &AbstractImporterTest::meshChunkOutOfBounds,
+              &AbstractImporterTest::meshChunkOutOfRange,
+
               &AbstractImporterTest::meshAttributeName,
               &AbstractImporterTest::meshAttributeNameNotImplemented,
               &AbstractImporterTest::meshAttributeNameNotCustom,
@@ -677,6 +715,11 @@ AbstractImporterTest::AbstractImporterTest() {
               &AbstractImporterTest::image2DNonOwningDeleter,
               &AbstractImporterTest::image2DGrowableDeleter,
               &AbstractImporterTest::image2DCustomDeleter,
+              &AbstractImporterTest::image2DSize,
+              &AbstractImporterTest::image2DRows,
+              &AbstractImporterTest::image2DRowsOutOfRange,
+              &AbstractImporterTest::image2DRowsCompressed,
+              &AbstractImporterTest::image2DRowsInvalid,
 
               &AbstractImporterTest::image3D,
               &AbstractImporterTest::image3DFailed,
@@ -1003,6 +1046,96 @@ void AbstractImporterTest::openFileAsDataNotFound() {
         TestSuite::Compare::StringHasSuffix);
 }
 
+void AbstractImporterTest::openFileAsDataMapped() {
+    #if !defined(CORRADE_TARGET_UNIX) && (!defined(CORRADE_TARGET_WINDOWS) || defined(CORRADE_TARGET_WINDOWS_RT))
+    CORRADE_SKIP("Memory mapping not available on this platform.");
+    #else
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::OpenData; }
+        bool doIsOpened() const override { return _data.data(); }
+        void doClose() override { _data = nullptr; }
+
+        void doOpenData(Containers::Array<char>&& data, DataFlags dataFlags) override {
+            CORRADE_COMPARE_AS(data,
+                Containers::arrayView({'\xa5'}),
+                TestSuite::Compare::Container);
+            CORRADE_COMPARE(dataFlags, DataFlag::ExternallyOwned);
+            /* I.e., it's just a view on the mapped file */
+            CORRADE_VERIFY(data.deleter());
+            _data = data;
+        }
+
+        Containers::ArrayView<const char> _data;
+    } importer;
+    importer.addFlags(ImporterFlag::MapFiles);
+
+    CORRADE_VERIFY(!importer.isOpened());
+    CORRADE_VERIFY(importer.openFile(Utility::Path::join(TRADE_TEST_DIR, "file.bin")));
+    CORRADE_VERIFY(importer.isOpened());
+
+    /* The memory should stay valid even after doOpenData() exits */
+    CORRADE_COMPARE_AS(importer._data,
+        Containers::arrayView({'\xa5'}),
+        TestSuite::Compare::Container);
+
+    importer.close();
+    CORRADE_VERIFY(!importer.isOpened());
+    #endif
+}
+
+void AbstractImporterTest::openFileAsDataMappedFailed() {
+    #if !defined(CORRADE_TARGET_UNIX) && (!defined(CORRADE_TARGET_WINDOWS) || defined(CORRADE_TARGET_WINDOWS_RT))
+    CORRADE_SKIP("Memory mapping not available on this platform.");
+    #else
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::OpenData; }
+        bool doIsOpened() const override { return false; }
+        void doClose() override {}
+
+        void doOpenData(Containers::Array<char>&&, DataFlags) override {
+            Error{} << "Failed.";
+        }
+    } importer;
+    importer.addFlags(ImporterFlag::MapFiles);
+
+    /* The mapping should get released right away, not leak until close() */
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer.openFile(Utility::Path::join(TRADE_TEST_DIR, "file.bin")));
+    CORRADE_VERIFY(!importer.isOpened());
+    CORRADE_COMPARE(out.str(), "Failed.\n");
+    #endif
+}
+
+void AbstractImporterTest::openFileAsDataMappedNotFound() {
+    #if !defined(CORRADE_TARGET_UNIX) && (!defined(CORRADE_TARGET_WINDOWS) || defined(CORRADE_TARGET_WINDOWS_RT))
+    CORRADE_SKIP("Memory mapping not available on this platform.");
+    #else
+    struct Importer: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::OpenData; }
+        bool doIsOpened() const override { return _opened; }
+        void doClose() override { _opened = false; }
+
+        void doOpenData(Containers::Array<char>&&, DataFlags) override {
+            _opened = true;
+        }
+
+        bool _opened = false;
+    } importer;
+    importer.addFlags(ImporterFlag::MapFiles);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    CORRADE_VERIFY(!importer.openFile("nonexistent.bin"));
+    CORRADE_VERIFY(!importer.isOpened());
+    /* There's an error message from Path::mapRead() before */
+    CORRADE_COMPARE_AS(out.str(),
+        "\nTrade::AbstractImporter::openFile(): cannot open file nonexistent.bin\n",
+        TestSuite::Compare::StringHasSuffix);
+    #endif
+}
+
 void AbstractImporterTest::openState() {
     struct: AbstractImporter {
         ImporterFeatures doFeatures() const override {
@@ -1768,6 +1901,8 @@ void AbstractImporterTest::thingNoFile() {
     importer.image1D("foo");
     importer.image2D(42);
     importer.image2D("foo");
+    importer.image2DSize(42);
+    importer.image2DRows(42, 0, {});
     importer.image3D(42);
     importer.image3D("foo");
 
@@ -1800,6 +1935,8 @@ void AbstractImporterTest::thingNoFile() {
         "Trade::AbstractImporter::image1D(): no file opened\n"
         "Trade::AbstractImporter::image2D(): no file opened\n"
         "Trade::AbstractImporter::image2D(): no file opened\n"
+        "Trade::AbstractImporter::image2DSize(): no file opened\n"
+        "Trade::AbstractImporter::image2DRows(): no file opened\n"
         "Trade::AbstractImporter::image3D(): no file opened\n"
         "Trade::AbstractImporter::image3D(): no file opened\n"
 
@@ -5734,6 +5871,49 @@ void AbstractImporterTest::meshGrowableDeleters() {
     CORRADE_COMPARE(data->vertexData().size(), 12);
 }
 
+void AbstractImporterTest::meshDataArena() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        UnsignedInt doMeshCount() const override { return 1; }
+        Containers::Optional<MeshData> doMesh(UnsignedInt, UnsignedInt) override {
+            Containers::Array<char> indexData = allocateData(1);
+            indexData[0] = '\xab';
+            Containers::Array<char> vertexData = allocateData(sizeof(Vector3));
+            MeshIndexData indices{MeshIndexType::UnsignedByte, indexData};
+            MeshAttributeData positions{MeshAttribute::Position, Containers::arrayCast<Vector3>(vertexData)};
+
+            return MeshData{MeshPrimitive::Triangles,
+                std::move(indexData), indices,
+                std::move(vertexData), {positions}};
+        }
+    } importer;
+    CORRADE_VERIFY(!importer.dataArena());
+
+    /* Without an arena the data are allocated with a default deleter */
+    {
+        auto data = importer.mesh(0);
+        CORRADE_VERIFY(data);
+        CORRADE_COMPARE(data->indexData()[0], '\xab');
+        CORRADE_VERIFY(!data->releaseVertexData().deleter());
+    }
+
+    /* With an arena they come from it and pass the deleter check */
+    DataArena arena;
+    importer.setDataArena(&arena);
+    CORRADE_COMPARE(importer.dataArena(), &arena);
+    {
+        auto data = importer.mesh(0);
+        CORRADE_VERIFY(data);
+        CORRADE_COMPARE(data->indexData()[0], '\xab');
+        CORRADE_COMPARE(data->vertexData().size(), 12);
+        CORRADE_COMPARE(arena.allocationCount(), 2);
+    }
+    CORRADE_COMPARE(arena.allocationCount(), 0);
+}
+
 void AbstractImporterTest::meshCustomIndexDataDeleter() {
     CORRADE_SKIP_IF_NO_ASSERT();
 
@@ -5814,6 +5994,181 @@ void AbstractImporterTest::meshCustomAttributesDeleter() {
     );
 }
 
+const struct ChunkVertex {
+    Vector3 position;
+    Vector2 textureCoordinates;
+} ChunkVertices[]{
+    {{0.0f, 1.0f, 2.0f}, {0.0f, 0.0f}},
+    {{-1.0f, 3.0f, 0.0f}, {0.25f, 0.5f}},
+    {{2.0f, 0.0f, 1.0f}, {0.5f, 1.0f}},
+    {{4.0f, 4.0f, 4.0f}, {0.75f, 0.5f}},
+    {{3.0f, -1.0f, 5.0f}, {1.0f, 0.0f}}
+};
+
+/* Importer not implementing doMeshChunks() / doMeshChunk(), to test the
+   fallback implementations */
+struct ChunkImporter: AbstractImporter {
+    explicit ChunkImporter(MeshPrimitive primitive = MeshPrimitive::Points, bool indexed = false, bool positions = true): _primitive{primitive}, _indexed{indexed}, _positions{positions} {}
+
+    ImporterFeatures doFeatures() const override { return {}; }
+    bool doIsOpened() const override { return true; }
+    void doClose() override {}
+
+    UnsignedInt doMeshCount() const override { return 1; }
+    Containers::Optional<MeshData> doMesh(UnsignedInt, UnsignedInt) override {
+        Containers::Array<char> vertexData{sizeof(ChunkVertices)};
+        Containers::StridedArrayView1D<ChunkVertex> vertices = Containers::arrayCast<ChunkVertex>(vertexData);
+        for(std::size_t i = 0; i != vertices.size(); ++i)
+            vertices[i] = ChunkVertices[i];
+
+        Containers::Array<char> indexData;
+        MeshIndexData indices;
+        if(_indexed) {
+            indexData = Containers::Array<char>{3*sizeof(UnsignedShort)};
+            indices = MeshIndexData{Containers::arrayCast<UnsignedShort>(indexData)};
+        }
+
+        return MeshData{_primitive, std::move(indexData), indices, std::move(vertexData), {
+            MeshAttributeData{_positions ? MeshAttribute::Position : MeshAttribute::Normal, vertices.slice(&ChunkVertex::position)},
+            MeshAttributeData{MeshAttribute::TextureCoordinates, vertices.slice(&ChunkVertex::textureCoordinates)}
+        }, MeshData::ImplicitVertexCount, &state};
+    }
+
+    MeshPrimitive _primitive;
+    bool _indexed, _positions;
+};
+
+void AbstractImporterTest::meshChunks() {
+    ChunkImporter importer;
+
+    Containers::Optional<ChunkedMeshData> chunks = importer.meshChunks(0, 2);
+    CORRADE_VERIFY(chunks);
+    CORRADE_COMPARE(chunks->primitive(), MeshPrimitive::Points);
+    CORRADE_COMPARE(chunks->vertexCount(), 5);
+    CORRADE_COMPARE(chunks->chunkSize(), 2);
+    CORRADE_COMPARE(chunks->importerState(), &state);
+    CORRADE_COMPARE_AS(chunks->chunkBounds(), Containers::arrayView<Range3D>({
+        {{-1.0f, 1.0f, 0.0f}, {0.0f, 3.0f, 2.0f}},
+        {{2.0f, 0.0f, 1.0f}, {4.0f, 4.0f, 4.0f}},
+        {{3.0f, -1.0f, 5.0f}, {3.0f, -1.0f, 5.0f}}
+    }), TestSuite::Compare::Container);
+}
+
+void AbstractImporterTest::meshChunksIndexed() {
+    ChunkImporter importer{MeshPrimitive::Points, true};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer.meshChunks(0, 2));
+    CORRADE_COMPARE(out.str(), "Trade::AbstractImporter::meshChunks(): chunked access to indexed meshes is not supported\n");
+}
+
+void AbstractImporterTest::meshChunksNoPositions() {
+    ChunkImporter importer{MeshPrimitive::Points, false, false};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer.meshChunks(0, 2));
+    CORRADE_COMPARE(out.str(), "Trade::AbstractImporter::meshChunks(): the mesh has no positions\n");
+}
+
+void AbstractImporterTest::meshChunksNotWholePrimitives() {
+    ChunkImporter triangles{MeshPrimitive::Triangles};
+    ChunkImporter lines{MeshPrimitive::Lines};
+
+    /* A multiple of the primitive size is fine */
+    CORRADE_VERIFY(triangles.meshChunks(0, 3));
+    CORRADE_VERIFY(lines.meshChunks(0, 4));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!triangles.meshChunks(0, 4));
+    CORRADE_VERIFY(!lines.meshChunks(0, 3));
+    CORRADE_COMPARE(out.str(),
+        "Trade::AbstractImporter::meshChunks(): chunk size 4 doesn't contain whole MeshPrimitive::Triangles primitives\n"
+        "Trade::AbstractImporter::meshChunks(): chunk size 3 doesn't contain whole MeshPrimitive::Lines primitives\n");
+}
+
+void AbstractImporterTest::meshChunksZeroChunkSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    ChunkImporter importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    importer.meshChunks(0, 0);
+    CORRADE_COMPARE(out.str(), "Trade::AbstractImporter::meshChunks(): expected a non-zero chunk size\n");
+}
+
+void AbstractImporterTest::meshChunksOutOfRange() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    ChunkImporter importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    importer.meshChunks(1, 2);
+    CORRADE_COMPARE(out.str(), "Trade::AbstractImporter::meshChunks(): index 1 out of range for 1 entries\n");
+}
+
+void AbstractImporterTest::meshChunk() {
+    ChunkImporter importer;
+
+    Containers::Optional<MeshData> chunk = importer.meshChunk(0, 1, 3);
+    CORRADE_VERIFY(chunk);
+    CORRADE_VERIFY(!chunk->isIndexed());
+    CORRADE_COMPARE(chunk->primitive(), MeshPrimitive::Points);
+    CORRADE_COMPARE(chunk->vertexCount(), 3);
+    CORRADE_COMPARE(chunk->attributeCount(), 2);
+    CORRADE_COMPARE(chunk->importerState(), &state);
+    CORRADE_COMPARE_AS(chunk->attribute<Vector3>(MeshAttribute::Position), Containers::arrayView<Vector3>({
+        {-1.0f, 3.0f, 0.0f},
+        {2.0f, 0.0f, 1.0f},
+        {4.0f, 4.0f, 4.0f}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(chunk->attribute<Vector2>(MeshAttribute::TextureCoordinates), Containers::arrayView<Vector2>({
+        {0.25f, 0.5f},
+        {0.5f, 1.0f},
+        {0.75f, 0.5f}
+    }), TestSuite::Compare::Container);
+
+    /* The attributes are no longer interleaved */
+    CORRADE_COMPARE(chunk->attributeStride(MeshAttribute::Position), sizeof(Vector3));
+    CORRADE_COMPARE(chunk->attributeStride(MeshAttribute::TextureCoordinates), sizeof(Vector2));
+}
+
+void AbstractImporterTest::meshChunkIndexed() {
+    ChunkImporter importer{MeshPrimitive::Points, true};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer.meshChunk(0, 0, 2));
+    CORRADE_COMPARE(out.str(), "Trade::AbstractImporter::meshChunk(): chunked access to indexed meshes is not supported\n");
+}
+
+void AbstractImporterTest::meshChunkOutOfBounds() {
+    ChunkImporter importer;
+
+    /* An empty range at the end is fine */
+    CORRADE_VERIFY(importer.meshChunk(0, 5, 0));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer.meshChunk(0, 4, 2));
+    CORRADE_COMPARE(out.str(), "Trade::AbstractImporter::meshChunk(): range [4:6] out of bounds for 5 vertices\n");
+}
+
+void AbstractImporterTest::meshChunkOutOfRange() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    ChunkImporter importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    importer.meshChunk(1, 0, 2);
+    CORRADE_COMPARE(out.str(), "Trade::AbstractImporter::meshChunk(): index 1 out of range for 1 entries\n");
+}
+
 void AbstractImporterTest::meshAttributeName() {
     struct: AbstractImporter {
         ImporterFeatures doFeatures() const override { return {}; }
@@ -7346,6 +7701,121 @@ void AbstractImporterTest::image2DCustomDeleter() {
         "Trade::AbstractImporter::image2D(): implementation is not allowed to use a custom Array deleter\n");
 }
 
+void AbstractImporterTest::image2DSize() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        UnsignedInt doImage2DCount() const override { return 8; }
+        UnsignedInt doImage2DLevelCount(UnsignedInt) override { return 3; }
+        Containers::Optional<ImageData2D> doImage2D(UnsignedInt id, UnsignedInt level) override {
+            if(id == 7 && level == 2) return ImageData2D{PixelFormat::RGBA8Unorm, {3, 2}, Containers::Array<char>{ValueInit, 24}};
+            return {};
+        }
+    } importer;
+
+    /* The default implementation goes through image2D() */
+    Containers::Optional<Vector2i> size = importer.image2DSize(7, 2);
+    CORRADE_VERIFY(size);
+    CORRADE_COMPARE(*size, (Vector2i{3, 2}));
+
+    /* Failure gets propagated */
+    CORRADE_VERIFY(!importer.image2DSize(6, 2));
+}
+
+void AbstractImporterTest::image2DRows() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        UnsignedInt doImage2DCount() const override { return 1; }
+        Containers::Optional<ImageData2D> doImage2D(UnsignedInt, UnsignedInt) override {
+            /* Three RGB rows, padded to four bytes */
+            Containers::Array<char> data{NoInit, 24};
+            for(std::size_t i = 0; i != data.size(); ++i) data[i] = i;
+            return ImageData2D{PixelFormat::RGB8Unorm, {2, 3}, std::move(data), ImageFlag2D::Array};
+        }
+    } importer;
+
+    /* The default implementation imports the whole image and copies the rows
+       out */
+    Containers::Optional<ImageData2D> image = importer.image2DRows(0, 0, {1, 3});
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->format(), PixelFormat::RGB8Unorm);
+    CORRADE_COMPARE(image->flags(), ImageFlag2D::Array);
+    CORRADE_COMPARE(image->storage().alignment(), 4);
+    CORRADE_COMPARE(image->size(), (Vector2i{2, 2}));
+    CORRADE_COMPARE_AS(image->data(), Containers::arrayView<char>({
+        8, 9, 10, 11, 12, 13, 0, 0,
+        16, 17, 18, 19, 20, 21, 0, 0
+    }), TestSuite::Compare::Container);
+}
+
+void AbstractImporterTest::image2DRowsOutOfRange() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        UnsignedInt doImage2DCount() const override { return 1; }
+        Containers::Optional<ImageData2D> doImage2D(UnsignedInt, UnsignedInt) override {
+            return ImageData2D{PixelFormat::RGBA8Unorm, {2, 3}, Containers::Array<char>{ValueInit, 24}};
+        }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer.image2DRows(0, 0, {2, 4}));
+    CORRADE_COMPARE(out.str(), "Trade::AbstractImporter::image2DRows(): rows 2 to 4 out of range for an image of 3 rows\n");
+}
+
+void AbstractImporterTest::image2DRowsCompressed() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        UnsignedInt doImage2DCount() const override { return 1; }
+        Containers::Optional<ImageData2D> doImage2D(UnsignedInt, UnsignedInt) override {
+            return ImageData2D{CompressedPixelFormat::Bc1RGBAUnorm, {4, 4}, Containers::Array<char>{ValueInit, 8}};
+        }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer.image2DRows(0, 0, {0, 1}));
+    CORRADE_COMPARE(out.str(), "Trade::AbstractImporter::image2DRows(): compressed images are not supported\n");
+}
+
+void AbstractImporterTest::image2DRowsInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        UnsignedInt doImage2DCount() const override { return 8; }
+        UnsignedInt doImage2DLevelCount(UnsignedInt) override { return 3; }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    importer.image2DSize(8);
+    importer.image2DSize(7, 3);
+    importer.image2DRows(8, 0, {});
+    importer.image2DRows(7, 3, {});
+    importer.image2DRows(7, 0, {3, 2});
+    CORRADE_COMPARE(out.str(),
+        "Trade::AbstractImporter::image2DSize(): index 8 out of range for 8 entries\n"
+        "Trade::AbstractImporter::image2DSize(): level 3 out of range for 3 entries\n"
+        "Trade::AbstractImporter::image2DRows(): index 8 out of range for 8 entries\n"
+        "Trade::AbstractImporter::image2DRows(): level 3 out of range for 3 entries\n"
+        "Trade::AbstractImporter::image2DRows(): expected a non-inverted row range, got 3 to 2\n");
+}
+
 void AbstractImporterTest::image3D() {
     struct: AbstractImporter {
         ImporterFeatures doFeatures() const override { return {}; }
@@ -7698,22 +8168,22 @@ void AbstractImporterTest::debugFeature() {
 void AbstractImporterTest::debugFeatures() {
     std::ostringstream out;
 
-    Debug{&out} << (ImporterFeature::OpenData|ImporterFeature::OpenState) << ImporterFeatures{};
-    CORRADE_COMPARE(out.str(), "Trade::ImporterFeature::OpenData|Trade::ImporterFeature::OpenState Trade::ImporterFeatures{}\n");
+    Debug{&out} << (ImporterFeature::OpenData|ImporterFeature::OpenState) << (ImporterFeature::FileCallback|ImporterFeature::ThreadSafeImport) << ImporterFeatures{};
+    CORRADE_COMPARE(out.str(), "Trade::ImporterFeature::OpenData|Trade::ImporterFeature::OpenState Trade::ImporterFeature::FileCallback|Trade::ImporterFeature::ThreadSafeImport Trade::ImporterFeatures{}\n");
 }
 
 void AbstractImporterTest::debugFlag() {
     std::ostringstream out;
 
-    Debug{&out} << ImporterFlag::Verbose << ImporterFlag(0xf0);
-    CORRADE_COMPARE(out.str(), "Trade::ImporterFlag::Verbose Trade::ImporterFlag(0xf0)\n");
+    Debug{&out} << ImporterFlag::Verbose << ImporterFlag::MapFiles << ImporterFlag(0xf0);
+    CORRADE_COMPARE(out.str(), "Trade::ImporterFlag::Verbose Trade::ImporterFlag::MapFiles Trade::ImporterFlag(0xf0)\n");
 }
 
 void AbstractImporterTest::debugFlags() {
     std::ostringstream out;
 
-    Debug{&out} << (ImporterFlag::Verbose|ImporterFlag(0xf0)) << ImporterFlags{};
-    CORRADE_COMPARE(out.str(), "Trade::ImporterFlag::Verbose|Trade::ImporterFlag(0xf0) Trade::ImporterFlags{}\n");
+    Debug{&out} << (ImporterFlag::Verbose|ImporterFlag::MapFiles|ImporterFlag(0xf0)) << ImporterFlags{};
+    CORRADE_COMPARE(out.str(), "Trade::ImporterFlag::Verbose|Trade::ImporterFlag::MapFiles|Trade::ImporterFlag(0xf0) Trade::ImporterFlags{}\n");
 }
 
 }}}}
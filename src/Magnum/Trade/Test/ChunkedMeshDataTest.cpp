@@ -0,0 +1,173 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Trade/ChunkedMeshData.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct ChunkedMeshDataTest: TestSuite::Tester {
+    explicit ChunkedMeshDataTest();
+
+    void construct();
+    void constructEmpty();
+    void constructZeroChunkSize();
+    void constructWrongBoundCount();
+    void constructCopy();
+    void constructMove();
+
+    void chunkOutOfRange();
+
+    void release();
+};
+
+ChunkedMeshDataTest::ChunkedMeshDataTest() {
+    addTests({&ChunkedMeshDataTest::construct,
+              &ChunkedMeshDataTest::constructEmpty,
+              &ChunkedMeshDataTest::constructZeroChunkSize,
+              &ChunkedMeshDataTest::constructWrongBoundCount,
+              &ChunkedMeshDataTest::constructCopy,
+              &ChunkedMeshDataTest::constructMove,
+
+              &ChunkedMeshDataTest::chunkOutOfRange,
+
+              &ChunkedMeshDataTest::release});
+}
+
+void ChunkedMeshDataTest::construct() {
+    int state{}; /* GCC 11 complains that "maybe uninitialized" w/o the {} */
+    ChunkedMeshData data{MeshPrimitive::Points, 2500, 1000, Containers::array<Range3D>({
+        {{0.0f, 1.0f, 2.0f}, {3.0f, 4.0f, 5.0f}},
+        {{-1.0f, 2.0f, 0.0f}, {1.0f, 3.0f, 1.0f}},
+        {{0.5f, 0.5f, 0.5f}, {7.0f, 0.5f, 0.5f}}
+    }), &state};
+
+    CORRADE_COMPARE(data.primitive(), MeshPrimitive::Points);
+    CORRADE_COMPARE(data.vertexCount(), 2500);
+    CORRADE_COMPARE(data.chunkSize(), 1000);
+    CORRADE_COMPARE(data.chunkCount(), 3);
+    CORRADE_COMPARE(data.chunkVertexOffset(0), 0);
+    CORRADE_COMPARE(data.chunkVertexOffset(2), 2000);
+    CORRADE_COMPARE(data.chunkVertexCount(0), 1000);
+    CORRADE_COMPARE(data.chunkVertexCount(1), 1000);
+    CORRADE_COMPARE(data.chunkVertexCount(2), 500);
+    CORRADE_COMPARE(data.chunkBounds().size(), 3);
+    CORRADE_COMPARE(data.chunkBounds()[1], (Range3D{{-1.0f, 2.0f, 0.0f}, {1.0f, 3.0f, 1.0f}}));
+    CORRADE_COMPARE(data.bounds(), (Range3D{{-1.0f, 0.5f, 0.0f}, {7.0f, 4.0f, 5.0f}}));
+    CORRADE_COMPARE(data.importerState(), &state);
+}
+
+void ChunkedMeshDataTest::constructEmpty() {
+    ChunkedMeshData data{MeshPrimitive::Triangles, 0, 999, nullptr};
+
+    CORRADE_COMPARE(data.primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(data.vertexCount(), 0);
+    CORRADE_COMPARE(data.chunkSize(), 999);
+    CORRADE_COMPARE(data.chunkCount(), 0);
+    CORRADE_COMPARE(data.bounds(), Range3D{});
+}
+
+void ChunkedMeshDataTest::constructZeroChunkSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    ChunkedMeshData{MeshPrimitive::Points, 0, 0, nullptr};
+    CORRADE_COMPARE(out.str(), "Trade::ChunkedMeshData: expected a non-zero chunk size\n");
+}
+
+void ChunkedMeshDataTest::constructWrongBoundCount() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    ChunkedMeshData{MeshPrimitive::Points, 2001, 1000, Containers::Array<Range3D>{2}};
+    CORRADE_COMPARE(out.str(), "Trade::ChunkedMeshData: expected 3 chunk bounds for 2001 vertices and chunk size 1000 but got 2\n");
+}
+
+void ChunkedMeshDataTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<ChunkedMeshData>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<ChunkedMeshData>{});
+}
+
+void ChunkedMeshDataTest::constructMove() {
+    int state{}; /* GCC 11 complains that "maybe uninitialized" w/o the {} */
+    ChunkedMeshData a{MeshPrimitive::Lines, 6, 4, Containers::array<Range3D>({
+        {{0.0f, 1.0f, 2.0f}, {3.0f, 4.0f, 5.0f}},
+        {{-1.0f, 2.0f, 0.0f}, {1.0f, 3.0f, 1.0f}}
+    }), &state};
+
+    ChunkedMeshData b = std::move(a);
+    CORRADE_COMPARE(b.primitive(), MeshPrimitive::Lines);
+    CORRADE_COMPARE(b.vertexCount(), 6);
+    CORRADE_COMPARE(b.chunkSize(), 4);
+    CORRADE_COMPARE(b.chunkBounds()[1], (Range3D{{-1.0f, 2.0f, 0.0f}, {1.0f, 3.0f, 1.0f}}));
+    CORRADE_COMPARE(b.importerState(), &state);
+
+    ChunkedMeshData c{MeshPrimitive::Points, 0, 1, nullptr};
+    c = std::move(b);
+    CORRADE_COMPARE(c.primitive(), MeshPrimitive::Lines);
+    CORRADE_COMPARE(c.vertexCount(), 6);
+    CORRADE_COMPARE(c.chunkSize(), 4);
+    CORRADE_COMPARE(c.chunkBounds()[1], (Range3D{{-1.0f, 2.0f, 0.0f}, {1.0f, 3.0f, 1.0f}}));
+    CORRADE_COMPARE(c.importerState(), &state);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<ChunkedMeshData>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<ChunkedMeshData>::value);
+}
+
+void ChunkedMeshDataTest::chunkOutOfRange() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    ChunkedMeshData data{MeshPrimitive::Points, 6, 4, Containers::Array<Range3D>{2}};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    data.chunkVertexOffset(2);
+    data.chunkVertexCount(2);
+    CORRADE_COMPARE(out.str(),
+        "Trade::ChunkedMeshData::chunkVertexOffset(): index 2 out of range for 2 chunks\n"
+        "Trade::ChunkedMeshData::chunkVertexCount(): index 2 out of range for 2 chunks\n");
+}
+
+void ChunkedMeshDataTest::release() {
+    Containers::Array<Range3D> bounds{2};
+    const void* boundsPointer = bounds;
+
+    ChunkedMeshData data{MeshPrimitive::Points, 6, 4, std::move(bounds)};
+
+    Containers::Array<Range3D> released = data.releaseChunkBoundData();
+    CORRADE_COMPARE(data.vertexCount(), 0);
+    CORRADE_COMPARE(data.chunkCount(), 0);
+    CORRADE_COMPARE(released.size(), 2);
+    CORRADE_COMPARE(released, boundsPointer);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::ChunkedMeshDataTest)
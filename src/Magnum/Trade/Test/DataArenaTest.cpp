@@ -0,0 +1,229 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstdint>
+#include <sstream>
+#include <type_traits>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Trade/DataArena.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct DataArenaTest: TestSuite::Tester {
+    explicit DataArenaTest();
+
+    void construct();
+    void constructCopy();
+    void constructMove();
+
+    void allocate();
+    void allocateAlignment();
+    void allocateLargerThanBlock();
+    void allocateInvalidAlignment();
+
+    void reset();
+    void resetAllocationsAlive();
+    void destroyAllocationsAlive();
+};
+
+DataArenaTest::DataArenaTest() {
+    addTests({&DataArenaTest::construct,
+              &DataArenaTest::constructCopy,
+              &DataArenaTest::constructMove,
+
+              &DataArenaTest::allocate,
+              &DataArenaTest::allocateAlignment,
+              &DataArenaTest::allocateLargerThanBlock,
+              &DataArenaTest::allocateInvalidAlignment,
+
+              &DataArenaTest::reset,
+              &DataArenaTest::resetAllocationsAlive,
+              &DataArenaTest::destroyAllocationsAlive});
+}
+
+void DataArenaTest::construct() {
+    DataArena arena{4096};
+    CORRADE_COMPARE(arena.blockSize(), 4096);
+    CORRADE_COMPARE(arena.blockCount(), 0);
+    CORRADE_COMPARE(arena.usedSize(), 0);
+    CORRADE_COMPARE(arena.allocationCount(), 0);
+}
+
+void DataArenaTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<DataArena>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<DataArena>{});
+}
+
+void DataArenaTest::constructMove() {
+    DataArena a{4096};
+    Containers::Array<char> data = a.allocate(100);
+
+    /* The array stays valid after the move */
+    DataArena b{std::move(a)};
+    CORRADE_COMPARE(b.blockSize(), 4096);
+    CORRADE_COMPARE(b.allocationCount(), 1);
+
+    DataArena c{128};
+    c = std::move(b);
+    CORRADE_COMPARE(c.blockSize(), 4096);
+    CORRADE_COMPARE(c.allocationCount(), 1);
+
+    data = nullptr;
+    CORRADE_COMPARE(c.allocationCount(), 0);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<DataArena>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<DataArena>::value);
+}
+
+void DataArenaTest::allocate() {
+    DataArena arena{4096};
+
+    Containers::Array<char> a = arena.allocate(100);
+    Containers::Array<char> b = arena.allocate(200);
+    CORRADE_COMPARE(a.size(), 100);
+    CORRADE_COMPARE(b.size(), 200);
+    CORRADE_VERIFY(a.deleter() == DataArena::deleter);
+    CORRADE_VERIFY(b.deleter() == DataArena::deleter);
+    CORRADE_COMPARE(arena.blockCount(), 1);
+    CORRADE_COMPARE(arena.allocationCount(), 2);
+
+    /* The allocations are consecutive in a single block and don't overlap */
+    CORRADE_VERIFY(b.data() >= a.data() + a.size());
+    CORRADE_VERIFY(b.data() < a.data() + 4096);
+    CORRADE_COMPARE_AS(arena.usedSize(), 300, TestSuite::Compare::GreaterOrEqual);
+
+    /* Writing to the data doesn't corrupt the other allocation */
+    for(char& i: a) i = 'a';
+    for(char& i: b) i = 'b';
+    CORRADE_COMPARE(a[99], 'a');
+    CORRADE_COMPARE(b[0], 'b');
+
+    a = nullptr;
+    CORRADE_COMPARE(arena.allocationCount(), 1);
+    b = nullptr;
+    CORRADE_COMPARE(arena.allocationCount(), 0);
+
+    /* Empty allocations are counted as well */
+    Containers::Array<char> empty = arena.allocate(0);
+    CORRADE_COMPARE(empty.size(), 0);
+    CORRADE_COMPARE(arena.allocationCount(), 1);
+}
+
+void DataArenaTest::allocateAlignment() {
+    DataArena arena{4096};
+
+    Containers::Array<char> a = arena.allocate(3, 1);
+    Containers::Array<char> b = arena.allocate(3, 64);
+    Containers::Array<char> c = arena.allocate(3);
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(b.data()) % 64, 0);
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(c.data()) % 16, 0);
+}
+
+void DataArenaTest::allocateLargerThanBlock() {
+    DataArena arena{256};
+
+    Containers::Array<char> a = arena.allocate(200);
+    CORRADE_COMPARE(arena.blockCount(), 1);
+
+    /* Doesn't fit into the rest of the first block, a new one is made */
+    Containers::Array<char> b = arena.allocate(200);
+    CORRADE_COMPARE(arena.blockCount(), 2);
+
+    /* Larger than a block, gets a dedicated block */
+    Containers::Array<char> c = arena.allocate(1000);
+    CORRADE_COMPARE(arena.blockCount(), 3);
+    CORRADE_COMPARE(c.size(), 1000);
+    CORRADE_COMPARE_AS(arena.usedSize(), 1400, TestSuite::Compare::GreaterOrEqual);
+}
+
+void DataArenaTest::allocateInvalidAlignment() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    DataArena arena;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    arena.allocate(16, 0);
+    arena.allocate(16, 12);
+    CORRADE_COMPARE(out.str(),
+        "Trade::DataArena::allocate(): expected alignment to be a power of two, got 0\n"
+        "Trade::DataArena::allocate(): expected alignment to be a power of two, got 12\n");
+}
+
+void DataArenaTest::reset() {
+    DataArena arena{256};
+
+    {
+        Containers::Array<char> a = arena.allocate(200);
+        Containers::Array<char> b = arena.allocate(200);
+        CORRADE_COMPARE(arena.blockCount(), 2);
+    }
+
+    arena.reset();
+    CORRADE_COMPARE(arena.usedSize(), 0);
+    CORRADE_COMPARE(arena.allocationCount(), 0);
+
+    /* The blocks are reused */
+    Containers::Array<char> a = arena.allocate(200);
+    Containers::Array<char> b = arena.allocate(200);
+    CORRADE_COMPARE(arena.blockCount(), 2);
+}
+
+void DataArenaTest::resetAllocationsAlive() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    DataArena arena;
+    Containers::Array<char> a = arena.allocate(16);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    arena.reset();
+    CORRADE_COMPARE(out.str(), "Trade::DataArena::reset(): 1 allocations are still alive\n");
+}
+
+void DataArenaTest::destroyAllocationsAlive() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Containers::Array<char> a;
+
+    std::ostringstream out;
+    {
+        Error redirectError{&out};
+        DataArena arena;
+        a = arena.allocate(16);
+    }
+    CORRADE_COMPARE(out.str(), "Trade::DataArena: destroyed while 1 allocations are still alive\n");
+
+    /* The memory is gone already, don't call the deleter */
+    a.release();
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::DataArenaTest)
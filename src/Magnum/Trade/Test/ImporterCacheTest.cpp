@@ -0,0 +1,353 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/ImporterCache.h"
+#include "Magnum/Trade/MaterialData.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct ImporterCacheTest: TestSuite::Tester {
+    explicit ImporterCacheTest();
+
+    void construct();
+    void constructCopy();
+    void constructMove();
+
+    void mesh();
+    void meshLevel();
+    void meshFailed();
+    void material();
+    void image2D();
+
+    void evict();
+    void evictLeastRecentlyUsed();
+    void evictOverBudget();
+    void setBudget();
+    void clear();
+};
+
+ImporterCacheTest::ImporterCacheTest() {
+    addTests({&ImporterCacheTest::construct,
+              &ImporterCacheTest::constructCopy,
+              &ImporterCacheTest::constructMove,
+
+              &ImporterCacheTest::mesh,
+              &ImporterCacheTest::meshLevel,
+              &ImporterCacheTest::meshFailed,
+              &ImporterCacheTest::material,
+              &ImporterCacheTest::image2D,
+
+              &ImporterCacheTest::evict,
+              &ImporterCacheTest::evictLeastRecentlyUsed,
+              &ImporterCacheTest::evictOverBudget,
+              &ImporterCacheTest::setBudget,
+              &ImporterCacheTest::clear});
+}
+
+/* Each mesh has a size of this many bytes in the cache, mesh 3 fails to
+   import */
+constexpr std::size_t MeshSize = 10*sizeof(Vector3) + sizeof(MeshAttributeData);
+
+struct Importer: AbstractImporter {
+    ImporterFeatures doFeatures() const override { return {}; }
+    bool doIsOpened() const override { return true; }
+    void doClose() override {}
+
+    UnsignedInt doMeshCount() const override { return 4; }
+    UnsignedInt doMeshLevelCount(UnsignedInt) override { return 2; }
+    Containers::Optional<MeshData> doMesh(UnsignedInt id, UnsignedInt level) override {
+        ++meshCalls;
+        if(id == 3) return {};
+
+        Containers::Array<char> vertexData{ValueInit, 10*sizeof(Vector3)};
+        Containers::StridedArrayView1D<Vector3> positions = Containers::arrayCast<Vector3>(vertexData);
+        positions[0] = Vector3{Float(id), Float(level), 0.0f};
+        return MeshData{MeshPrimitive::Points, std::move(vertexData), {MeshAttributeData{MeshAttribute::Position, positions}}};
+    }
+
+    UnsignedInt doMaterialCount() const override { return 2; }
+    Containers::Optional<MaterialData> doMaterial(UnsignedInt id) override {
+        ++materialCalls;
+        return MaterialData{{}, {
+            {MaterialAttribute::BaseColor, Color4{Float(id)}}
+        }};
+    }
+
+    UnsignedInt doImage2DCount() const override { return 2; }
+    Containers::Optional<ImageData2D> doImage2D(UnsignedInt id, UnsignedInt) override {
+        ++image2DCalls;
+        Containers::Array<char> data{ValueInit, 4*4*4};
+        data[0] = char(id);
+        return ImageData2D{PixelFormat::RGBA8Unorm, {4, 4}, std::move(data)};
+    }
+
+    Int meshCalls = 0;
+    Int materialCalls = 0;
+    Int image2DCalls = 0;
+};
+
+void ImporterCacheTest::construct() {
+    Importer importer;
+    ImporterCache cache{importer, 1024};
+    CORRADE_COMPARE(&cache.importer(), &importer);
+    CORRADE_COMPARE(cache.budget(), 1024);
+    CORRADE_COMPARE(cache.size(), 0);
+    CORRADE_COMPARE(cache.count(), 0);
+}
+
+void ImporterCacheTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<ImporterCache>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<ImporterCache>{});
+}
+
+void ImporterCacheTest::constructMove() {
+    Importer importer;
+    ImporterCache a{importer, 1024};
+    const MeshData* mesh = a.mesh(0);
+    CORRADE_VERIFY(mesh);
+
+    ImporterCache b{std::move(a)};
+    CORRADE_COMPARE(&b.importer(), &importer);
+    CORRADE_COMPARE(b.budget(), 1024);
+    CORRADE_COMPARE(b.count(), 1);
+    /* The pointer stays the same */
+    CORRADE_COMPARE(b.mesh(0), mesh);
+
+    Importer importer2;
+    ImporterCache c{importer2, 512};
+    c = std::move(b);
+    CORRADE_COMPARE(&c.importer(), &importer);
+    CORRADE_COMPARE(c.budget(), 1024);
+    CORRADE_COMPARE(c.count(), 1);
+    CORRADE_COMPARE(c.mesh(0), mesh);
+    CORRADE_COMPARE(importer.meshCalls, 1);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<ImporterCache>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<ImporterCache>::value);
+}
+
+void ImporterCacheTest::mesh() {
+    Importer importer;
+    ImporterCache cache{importer, 1024};
+
+    const MeshData* mesh = cache.mesh(1);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->attribute<Vector3>(MeshAttribute::Position)[0], (Vector3{1.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(importer.meshCalls, 1);
+    CORRADE_COMPARE(cache.size(), MeshSize);
+    CORRADE_COMPARE(cache.count(), 1);
+
+    /* Second query doesn't go to the importer */
+    CORRADE_COMPARE(cache.mesh(1), mesh);
+    CORRADE_COMPARE(importer.meshCalls, 1);
+    CORRADE_COMPARE(cache.size(), MeshSize);
+    CORRADE_COMPARE(cache.count(), 1);
+}
+
+void ImporterCacheTest::meshLevel() {
+    Importer importer;
+    ImporterCache cache{importer, 1024};
+
+    const MeshData* level0 = cache.mesh(1);
+    const MeshData* level1 = cache.mesh(1, 1);
+    CORRADE_VERIFY(level0);
+    CORRADE_VERIFY(level1);
+    CORRADE_VERIFY(level0 != level1);
+    CORRADE_COMPARE(level1->attribute<Vector3>(MeshAttribute::Position)[0], (Vector3{1.0f, 1.0f, 0.0f}));
+    CORRADE_COMPARE(importer.meshCalls, 2);
+    CORRADE_COMPARE(cache.count(), 2);
+
+    CORRADE_COMPARE(cache.mesh(1, 0), level0);
+    CORRADE_COMPARE(cache.mesh(1, 1), level1);
+    CORRADE_COMPARE(importer.meshCalls, 2);
+}
+
+void ImporterCacheTest::meshFailed() {
+    Importer importer;
+    ImporterCache cache{importer, 1024};
+
+    CORRADE_VERIFY(!cache.mesh(3));
+    CORRADE_COMPARE(importer.meshCalls, 1);
+    CORRADE_COMPARE(cache.size(), 0);
+    CORRADE_COMPARE(cache.count(), 0);
+
+    /* Failures are not cached, the importer gets asked again */
+    CORRADE_VERIFY(!cache.mesh(3));
+    CORRADE_COMPARE(importer.meshCalls, 2);
+}
+
+void ImporterCacheTest::material() {
+    Importer importer;
+    ImporterCache cache{importer, 1024};
+
+    const MaterialData* material = cache.material(1);
+    CORRADE_VERIFY(material);
+    CORRADE_COMPARE(material->attribute<Color4>(MaterialAttribute::BaseColor), Color4{1.0f});
+    CORRADE_COMPARE(importer.materialCalls, 1);
+    CORRADE_COMPARE(cache.size(), sizeof(MaterialAttributeData));
+
+    CORRADE_COMPARE(cache.material(1), material);
+    CORRADE_COMPARE(importer.materialCalls, 1);
+
+    /* Materials and meshes with the same ID are distinct */
+    CORRADE_VERIFY(cache.mesh(1));
+    CORRADE_COMPARE(importer.meshCalls, 1);
+    CORRADE_COMPARE(cache.count(), 2);
+}
+
+void ImporterCacheTest::image2D() {
+    Importer importer;
+    ImporterCache cache{importer, 1024};
+
+    const ImageData2D* image = cache.image2D(1);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->size(), (Vector2i{4, 4}));
+    CORRADE_COMPARE(image->data()[0], '\x01');
+    CORRADE_COMPARE(importer.image2DCalls, 1);
+    CORRADE_COMPARE(cache.size(), 64);
+
+    CORRADE_COMPARE(cache.image2D(1), image);
+    CORRADE_COMPARE(importer.image2DCalls, 1);
+}
+
+void ImporterCacheTest::evict() {
+    Importer importer;
+    ImporterCache cache{importer, 2*MeshSize};
+
+    CORRADE_VERIFY(cache.mesh(0));
+    CORRADE_VERIFY(cache.mesh(1));
+    CORRADE_COMPARE(cache.size(), 2*MeshSize);
+    CORRADE_COMPARE(cache.count(), 2);
+
+    /* Adding a third mesh evicts the first one */
+    CORRADE_VERIFY(cache.mesh(2));
+    CORRADE_COMPARE(cache.size(), 2*MeshSize);
+    CORRADE_COMPARE(cache.count(), 2);
+    CORRADE_COMPARE(importer.meshCalls, 3);
+
+    /* Mesh 2 and 1 are still cached, mesh 0 has to be imported again */
+    CORRADE_VERIFY(cache.mesh(2));
+    CORRADE_VERIFY(cache.mesh(1));
+    CORRADE_COMPARE(importer.meshCalls, 3);
+    CORRADE_VERIFY(cache.mesh(0));
+    CORRADE_COMPARE(importer.meshCalls, 4);
+}
+
+void ImporterCacheTest::evictLeastRecentlyUsed() {
+    Importer importer;
+    ImporterCache cache{importer, 2*MeshSize};
+
+    CORRADE_VERIFY(cache.mesh(0));
+    CORRADE_VERIFY(cache.mesh(1));
+
+    /* Using mesh 0 again makes mesh 1 the least recently used */
+    CORRADE_VERIFY(cache.mesh(0));
+    CORRADE_VERIFY(cache.mesh(2));
+    CORRADE_COMPARE(importer.meshCalls, 3);
+
+    CORRADE_VERIFY(cache.mesh(0));
+    CORRADE_COMPARE(importer.meshCalls, 3);
+    CORRADE_VERIFY(cache.mesh(1));
+    CORRADE_COMPARE(importer.meshCalls, 4);
+}
+
+void ImporterCacheTest::evictOverBudget() {
+    Importer importer;
+    ImporterCache cache{importer, MeshSize/2};
+
+    /* The item is over budget alone, but is kept until something else gets
+       loaded */
+    const MeshData* mesh = cache.mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(cache.size(), MeshSize);
+    CORRADE_COMPARE(cache.count(), 1);
+    CORRADE_COMPARE(cache.mesh(0), mesh);
+    CORRADE_COMPARE(importer.meshCalls, 1);
+
+    CORRADE_VERIFY(cache.mesh(1));
+    CORRADE_COMPARE(cache.size(), MeshSize);
+    CORRADE_COMPARE(cache.count(), 1);
+    CORRADE_VERIFY(cache.mesh(0));
+    CORRADE_COMPARE(importer.meshCalls, 3);
+}
+
+void ImporterCacheTest::setBudget() {
+    Importer importer;
+    ImporterCache cache{importer, 1024};
+
+    CORRADE_VERIFY(cache.mesh(0));
+    CORRADE_VERIFY(cache.mesh(1));
+    CORRADE_VERIFY(cache.mesh(2));
+    /* Mesh 1 is now the least recently used */
+    CORRADE_VERIFY(cache.mesh(0));
+    CORRADE_COMPARE(cache.count(), 3);
+
+    cache.setBudget(2*MeshSize);
+    CORRADE_COMPARE(cache.budget(), 2*MeshSize);
+    CORRADE_COMPARE(cache.size(), 2*MeshSize);
+    CORRADE_COMPARE(cache.count(), 2);
+
+    CORRADE_VERIFY(cache.mesh(0));
+    CORRADE_VERIFY(cache.mesh(2));
+    CORRADE_COMPARE(importer.meshCalls, 3);
+
+    /* The most recently used item is kept even if it doesn't fit */
+    cache.setBudget(0);
+    CORRADE_COMPARE(cache.size(), MeshSize);
+    CORRADE_COMPARE(cache.count(), 1);
+    CORRADE_VERIFY(cache.mesh(2));
+    CORRADE_COMPARE(importer.meshCalls, 3);
+}
+
+void ImporterCacheTest::clear() {
+    Importer importer;
+    ImporterCache cache{importer, 1024};
+
+    CORRADE_VERIFY(cache.mesh(0));
+    CORRADE_VERIFY(cache.material(0));
+    CORRADE_VERIFY(cache.image2D(0));
+    CORRADE_COMPARE(cache.count(), 3);
+
+    cache.clear();
+    CORRADE_COMPARE(cache.size(), 0);
+    CORRADE_COMPARE(cache.count(), 0);
+
+    CORRADE_VERIFY(cache.mesh(0));
+    CORRADE_COMPARE(importer.meshCalls, 2);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::ImporterCacheTest)
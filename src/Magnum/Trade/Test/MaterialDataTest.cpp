@@ -25,7 +25,11 @@
 
 #include <algorithm> /* std::next_permutation() */
 #include <sstream>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/Reference.h>
 #include <Corrade/Containers/StaticArray.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Containers/StringStl.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Numeric.h>
@@ -147,6 +151,15 @@ struct MaterialDataTest: TestSuite::Tester {
     void releaseAttributes();
     void releaseLayers();
 
+    void attributeLookupLayers();
+    void attributeLookupLargeLayer();
+    void attributeLookupReleased();
+
+    void attributesInto();
+    void attributesIntoCustomName();
+    void attributesIntoInvalid();
+    void attributesIntoWrongType();
+
     void templateLayerAccess();
     void templateLayerAccessMutable();
 
@@ -300,6 +313,15 @@ MaterialDataTest::MaterialDataTest() {
               &MaterialDataTest::releaseAttributes,
               &MaterialDataTest::releaseLayers,
 
+              &MaterialDataTest::attributeLookupLayers,
+              &MaterialDataTest::attributeLookupLargeLayer,
+              &MaterialDataTest::attributeLookupReleased,
+
+              &MaterialDataTest::attributesInto,
+              &MaterialDataTest::attributesIntoCustomName,
+              &MaterialDataTest::attributesIntoInvalid,
+              &MaterialDataTest::attributesIntoWrongType,
+
               &MaterialDataTest::templateLayerAccess,
               &MaterialDataTest::templateLayerAccessMutable,
 
@@ -2852,6 +2874,252 @@ void MaterialDataTest::releaseLayers() {
     CORRADE_COMPARE(data.attributeCount(), 2);
 }
 
+void MaterialDataTest::attributeLookupLayers() {
+    /* Custom attributes interleaved with builtin ones, the same attribute
+       present in multiple layers */
+    MaterialData data{{}, {
+        {"AaCustom", 1.5f},
+        {MaterialAttribute::BaseColor, 0x335566ff_rgbaf},
+        {"Zzz", 3u},
+        {MaterialAttribute::Roughness, 0.25f},
+        {MaterialAttribute::AlphaMask, 0.5f},
+
+        {MaterialLayer::ClearCoat},
+        {MaterialAttribute::Roughness, 0.75f},
+        {"Bzz", 4u},
+
+        /* Empty layer */
+
+        {MaterialAttribute::TextureMatrix, Matrix3::scaling({0.5f, 1.0f})},
+    }, {5, 8, 8, 9}};
+
+    CORRADE_COMPARE(data.layerCount(), 4);
+
+    /* Each lookup should give the same result as the string-based one */
+    for(UnsignedInt layer = 0; layer != data.layerCount(); ++layer) {
+        CORRADE_ITERATION(layer);
+        for(const Containers::Pair<MaterialAttribute, Containers::StringView> attribute: {
+            Containers::pair(MaterialAttribute::LayerName, " LayerName"_s),
+            Containers::pair(MaterialAttribute::AlphaMask, "AlphaMask"_s),
+            Containers::pair(MaterialAttribute::BaseColor, "BaseColor"_s),
+            Containers::pair(MaterialAttribute::Roughness, "Roughness"_s),
+            Containers::pair(MaterialAttribute::Metalness, "Metalness"_s),
+            Containers::pair(MaterialAttribute::TextureMatrix, "TextureMatrix"_s),
+        }) {
+            const MaterialAttribute name = attribute.first();
+            const Containers::StringView string = attribute.second();
+            CORRADE_ITERATION(string);
+            CORRADE_COMPARE(data.hasAttribute(layer, name), data.hasAttribute(layer, string));
+            if(data.hasAttribute(layer, string))
+                CORRADE_COMPARE(data.attributeId(layer, name), data.attributeId(layer, string));
+        }
+    }
+
+    CORRADE_COMPARE(data.attributeId(0, MaterialAttribute::AlphaMask), 1);
+    CORRADE_COMPARE(data.attributeId(0, MaterialAttribute::BaseColor), 2);
+    CORRADE_COMPARE(data.attributeId(0, MaterialAttribute::Roughness), 3);
+    CORRADE_COMPARE(data.attribute<Float>(0, MaterialAttribute::Roughness), 0.25f);
+    CORRADE_COMPARE(data.attributeId(1, MaterialAttribute::LayerName), 0);
+    CORRADE_COMPARE(data.attributeId(1, MaterialAttribute::Roughness), 2);
+    CORRADE_COMPARE(data.attribute<Float>(1, MaterialAttribute::Roughness), 0.75f);
+    CORRADE_VERIFY(!data.hasAttribute(2, MaterialAttribute::Roughness));
+    CORRADE_COMPARE(data.attributeOr(2, MaterialAttribute::Roughness, 1.0f), 1.0f);
+    CORRADE_COMPARE(data.attribute<Matrix3>(3, MaterialAttribute::TextureMatrix), Matrix3::scaling({0.5f, 1.0f}));
+    CORRADE_VERIFY(!data.tryAttribute<Float>(3, MaterialAttribute::Roughness));
+}
+
+void MaterialDataTest::attributeLookupLargeLayer() {
+    /* 300 custom attributes sorted before all builtin names, so the builtin
+       ones have IDs that don't fit into the lookup table and have to be
+       looked up by name */
+    Containers::Array<MaterialAttributeData> attributes;
+    for(UnsignedInt i = 0; i != 300; ++i) {
+        const char name[]{'A', char('0' + i/100), char('0' + i/10%10), char('0' + i%10)};
+        arrayAppend(attributes, MaterialAttributeData{Containers::StringView{name, 4}, i});
+    }
+    arrayAppend(attributes, MaterialAttributeData{MaterialAttribute::BaseColor, 0x335566ff_rgbaf});
+    arrayAppend(attributes, MaterialAttributeData{MaterialAttribute::AlphaMask, 0.5f});
+    /* Sorts before all the custom names */
+    arrayAppend(attributes, MaterialAttributeData{MaterialAttribute::LayerName, "base"_s});
+    MaterialData data{{}, std::move(attributes)};
+
+    CORRADE_COMPARE(data.attributeCount(), 303);
+    CORRADE_COMPARE(data.attributeId(MaterialAttribute::LayerName), 0);
+    CORRADE_COMPARE(data.attributeId(MaterialAttribute::AlphaMask), 301);
+    CORRADE_COMPARE(data.attributeId(MaterialAttribute::BaseColor), 302);
+    CORRADE_COMPARE(data.attribute<Float>(MaterialAttribute::AlphaMask), 0.5f);
+    CORRADE_COMPARE(data.attribute<Color4>(MaterialAttribute::BaseColor), 0x335566ff_rgbaf);
+    CORRADE_VERIFY(!data.hasAttribute(MaterialAttribute::Roughness));
+}
+
+void MaterialDataTest::attributeLookupReleased() {
+    MaterialData data{{}, {
+        {MaterialAttribute::BaseColor, 0x335566ff_rgbaf},
+
+        {MaterialAttribute::Roughness, 0.25f}
+    }, {1, 2}};
+
+    /* After releasing the layers all attributes are seen as being in the
+       base material, the lookup should behave the same as the string
+       lookup */
+    data.releaseLayerData();
+    CORRADE_COMPARE(data.attributeId(MaterialAttribute::BaseColor), 0);
+    CORRADE_COMPARE(data.attributeId(MaterialAttribute::Roughness), 1);
+    CORRADE_COMPARE(data.attribute<Float>(MaterialAttribute::Roughness), 0.25f);
+}
+
+void MaterialDataTest::attributesInto() {
+    MaterialData a{{}, {
+        {MaterialAttribute::BaseColor, 0x335566ff_rgbaf},
+        {MaterialAttribute::BaseColorTexture, 3u},
+
+        {MaterialAttribute::Roughness, 0.25f}
+    }, {2, 3}};
+    MaterialData b{{}, {
+        {MaterialAttribute::BaseColorTexture, 7u},
+    }};
+    MaterialData c{{}, {
+        {MaterialAttribute::BaseColor, 0xff0000ff_rgbaf},
+
+        {MaterialAttribute::Roughness, 0.75f}
+    }, {1, 2}};
+    const Containers::Reference<const MaterialData> materials[]{a, b, c};
+
+    /* Interleaved output to verify strides are respected */
+    struct Out {
+        Color4 baseColor;
+        UnsignedInt baseColorTexture;
+        Float roughness;
+    } out[3];
+    Containers::StridedArrayView1D<Out> view = out;
+    materialAttributesInto(materials, 0, {
+        {MaterialAttribute::BaseColor, 0xffffffff_rgbaf},
+        {MaterialAttribute::BaseColorTexture, ~UnsignedInt{}},
+        {MaterialAttribute::Roughness, 1.0f}
+    }, {
+        Containers::arrayCast<2, char>(view.slice(&Out::baseColor)),
+        Containers::arrayCast<2, char>(view.slice(&Out::baseColorTexture)),
+        Containers::arrayCast<2, char>(view.slice(&Out::roughness))
+    });
+    CORRADE_COMPARE(out[0].baseColor, 0x335566ff_rgbaf);
+    CORRADE_COMPARE(out[1].baseColor, 0xffffffff_rgbaf);
+    CORRADE_COMPARE(out[2].baseColor, 0xff0000ff_rgbaf);
+    CORRADE_COMPARE(out[0].baseColorTexture, 3);
+    CORRADE_COMPARE(out[1].baseColorTexture, 7);
+    CORRADE_COMPARE(out[2].baseColorTexture, ~UnsignedInt{});
+    /* Roughness is only in the second layer */
+    CORRADE_COMPARE(out[0].roughness, 1.0f);
+    CORRADE_COMPARE(out[1].roughness, 1.0f);
+    CORRADE_COMPARE(out[2].roughness, 1.0f);
+
+    /* The second material doesn't have the layer, default is used */
+    Float roughness[3];
+    materialAttributesInto(materials, 1, {
+        {MaterialAttribute::Roughness, 1.0f}
+    }, {
+        Containers::arrayCast<2, char>(Containers::stridedArrayView(roughness))
+    });
+    CORRADE_COMPARE(roughness[0], 0.25f);
+    CORRADE_COMPARE(roughness[1], 1.0f);
+    CORRADE_COMPARE(roughness[2], 0.75f);
+}
+
+void MaterialDataTest::attributesIntoCustomName() {
+    MaterialData a{{}, {
+        {"customFactor", 0.25f},
+        {MaterialAttribute::Roughness, 0.5f}
+    }};
+    MaterialData b{{}, {
+        {MaterialAttribute::Roughness, 0.75f}
+    }};
+    const Containers::Reference<const MaterialData> materials[]{a, b};
+
+    Float customFactor[2];
+    Float roughness[2];
+    materialAttributesInto(materials, 0, {
+        {"customFactor", 1.0f},
+        /* A builtin attribute specified via a string should work too */
+        {"Roughness", 0.0f}
+    }, {
+        Containers::arrayCast<2, char>(Containers::stridedArrayView(customFactor)),
+        Containers::arrayCast<2, char>(Containers::stridedArrayView(roughness))
+    });
+    CORRADE_COMPARE(customFactor[0], 0.25f);
+    CORRADE_COMPARE(customFactor[1], 1.0f);
+    CORRADE_COMPARE(roughness[0], 0.5f);
+    CORRADE_COMPARE(roughness[1], 0.75f);
+}
+
+void MaterialDataTest::attributesIntoInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    MaterialData a{{}, {
+        {MaterialAttribute::Roughness, 0.5f}
+    }};
+    const Containers::Reference<const MaterialData> materials[]{a, a};
+
+    Float roughness[2];
+    Float roughnessWrongSize[3];
+    UnsignedShort roughnessWrongType[2];
+    Vector2 roughnessNotContiguous[2];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    materialAttributesInto(materials, 0, {
+        {MaterialAttribute::Roughness, 1.0f}
+    }, {});
+    materialAttributesInto(materials, 0, {
+        {MaterialAttribute::LayerName, "hello"_s}
+    }, {
+        Containers::arrayCast<2, char>(Containers::stridedArrayView(roughness))
+    });
+    materialAttributesInto(materials, 0, {
+        {MaterialAttribute::Roughness, 1.0f}
+    }, {
+        Containers::arrayCast<2, char>(Containers::stridedArrayView(roughnessWrongSize))
+    });
+    materialAttributesInto(materials, 0, {
+        {MaterialAttribute::Roughness, 1.0f}
+    }, {
+        Containers::arrayCast<2, char>(Containers::stridedArrayView(roughnessWrongType))
+    });
+    materialAttributesInto(materials, 0, {
+        {MaterialAttribute::Roughness, 1.0f}
+    }, {
+        Containers::arrayCast<2, char>(Containers::stridedArrayView(roughnessNotContiguous)).every({1, 2})
+    });
+    CORRADE_COMPARE(out.str(),
+        "Trade::materialAttributesInto(): expected 1 destination views but got 0\n"
+        "Trade::materialAttributesInto(): string attributes are not supported but got  LayerName\n"
+        "Trade::materialAttributesInto(): expected destination view 0 to have 2 elements but got 3\n"
+        "Trade::materialAttributesInto(): expected destination view 0 second dimension size to be 4 for Trade::MaterialAttributeType::Float but got 2\n"
+        "Trade::materialAttributesInto(): second destination view 0 dimension is not contiguous\n");
+}
+
+void MaterialDataTest::attributesIntoWrongType() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    MaterialData a{{}, {
+        {MaterialAttribute::Roughness, 0.5f}
+    }};
+    MaterialData b{{}, {
+        {"Roughness", 5u}
+    }};
+    const Containers::Reference<const MaterialData> materials[]{a, b};
+
+    Float roughness[2];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    materialAttributesInto(materials, 0, {
+        {MaterialAttribute::Roughness, 1.0f}
+    }, {
+        Containers::arrayCast<2, char>(Containers::stridedArrayView(roughness))
+    });
+    CORRADE_COMPARE(out.str(),
+        "Trade::materialAttributesInto(): Roughness in material 1 is Trade::MaterialAttributeType::UnsignedInt but expected Trade::MaterialAttributeType::Float\n");
+}
+
 void MaterialDataTest::templateLayerAccess() {
     MaterialLayerData<MaterialLayer::ClearCoat> data{{}, {
         {MaterialAttribute::BaseColor, 0x335566ff_rgbaf},
@@ -160,6 +160,8 @@ struct MeshDataTest: TestSuite::Tester {
     template<class T> void textureCoordinates2DAsArrayPackedUnsignedNormalized();
     template<class T> void textureCoordinates2DAsArrayPackedSignedNormalized();
     void textureCoordinates2DIntoArrayInvalidSize();
+    void attributesIntoArraySubRange();
+    void attributesIntoArraySubRangeOutOfBounds();
     template<class T> void colorsAsArray();
     template<class T> void colorsAsArrayPackedUnsignedNormalized();
     void colorsIntoArrayInvalidSize();
@@ -385,6 +387,8 @@ MeshDataTest::MeshDataTest() {
               &MeshDataTest::textureCoordinates2DAsArrayPackedSignedNormalized<Vector2b>,
               &MeshDataTest::textureCoordinates2DAsArrayPackedSignedNormalized<Vector2s>,
               &MeshDataTest::textureCoordinates2DIntoArrayInvalidSize,
+              &MeshDataTest::attributesIntoArraySubRange,
+              &MeshDataTest::attributesIntoArraySubRangeOutOfBounds,
               &MeshDataTest::colorsAsArray<Color3>,
               &MeshDataTest::colorsAsArray<Color3h>,
               &MeshDataTest::colorsAsArray<Color4>,
@@ -3127,6 +3131,81 @@ void MeshDataTest::textureCoordinates2DIntoArrayInvalidSize() {
         "Trade::MeshData::textureCoordinates2DInto(): expected a view with 3 elements but got 2\n");
 }
 
+void MeshDataTest::attributesIntoArraySubRange() {
+    /* Interleaved packed attributes, which is where the batch conversion
+       has to go through the gather path */
+    struct Vertex {
+        Vector3h position;
+        Vector3s normal;
+        Vector2us textureCoordinates;
+    };
+
+    Containers::Array<char> vertexData{5*sizeof(Vertex)};
+    Containers::StridedArrayView1D<Vertex> vertices = Containers::arrayCast<Vertex>(vertexData);
+    for(std::size_t i = 0; i != vertices.size(); ++i) {
+        vertices[i].position = Vector3h{Vector3{Float(i), -Float(i), 0.5f}};
+        vertices[i].normal = Math::pack<Vector3s>(Vector3{0.0f, i % 2 ? -1.0f : 1.0f, 0.0f});
+        vertices[i].textureCoordinates = Math::pack<Vector2us>(Vector2{i*0.25f, 1.0f});
+    }
+
+    MeshData data{MeshPrimitive::Points, std::move(vertexData), {
+        MeshAttributeData{MeshAttribute::Position, vertices.slice(&Vertex::position)},
+        MeshAttributeData{MeshAttribute::Normal, VertexFormat::Vector3sNormalized, vertices.slice(&Vertex::normal)},
+        MeshAttributeData{MeshAttribute::TextureCoordinates, VertexFormat::Vector2usNormalized, vertices.slice(&Vertex::textureCoordinates)}
+    }};
+
+    Vector3 positions[3];
+    data.positions3DInto(positions, 1, 0);
+    CORRADE_COMPARE_AS(Containers::arrayView(positions), Containers::arrayView<Vector3>({
+        {1.0f, -1.0f, 0.5f},
+        {2.0f, -2.0f, 0.5f},
+        {3.0f, -3.0f, 0.5f}
+    }), TestSuite::Compare::Container);
+
+    Vector3 normals[2];
+    data.normalsInto(normals, 3, 0);
+    CORRADE_COMPARE_AS(Containers::arrayView(normals), Containers::arrayView<Vector3>({
+        {0.0f, -1.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f}
+    }), TestSuite::Compare::Container);
+
+    Vector2 textureCoordinates[2];
+    data.textureCoordinates2DInto(textureCoordinates, 0, 0);
+    CORRADE_COMPARE_AS(Containers::arrayView(textureCoordinates), Containers::arrayView<Vector2>({
+        {0.0f, 1.0f},
+        {0.25f, 1.0f}
+    }), TestSuite::Compare::Container);
+
+    /* An empty range at the end is fine */
+    data.positions3DInto(nullptr, 5, 0);
+}
+
+void MeshDataTest::attributesIntoArraySubRangeOutOfBounds() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Containers::Array<char> vertexData{3*sizeof(Vector3)};
+    Containers::StridedArrayView1D<Vector3> view = Containers::arrayCast<Vector3>(vertexData);
+    MeshData data{MeshPrimitive::Points, std::move(vertexData), {
+        MeshAttributeData{MeshAttribute::Position, view},
+        MeshAttributeData{MeshAttribute::Normal, view},
+        MeshAttributeData{MeshAttribute::TextureCoordinates, Containers::arrayCast<Vector2>(view)}
+    }};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Vector3 destination3[2];
+    Vector2 destination2[2];
+    data.positions3DInto(destination3, 2, 0);
+    data.normalsInto(destination3, 2, 0);
+    data.textureCoordinates2DInto(destination2, 2, 0);
+    data.positions3DInto(destination3, 0, 1);
+    CORRADE_COMPARE(out.str(),
+        "Trade::MeshData::positions3DInto(): range [2:4] out of bounds for 3 vertices\n"
+        "Trade::MeshData::normalsInto(): range [2:4] out of bounds for 3 vertices\n"
+        "Trade::MeshData::textureCoordinates2DInto(): range [2:4] out of bounds for 3 vertices\n"
+        "Trade::MeshData::positions3DInto(): index 1 out of range for 1 position attributes\n");
+}
+
 template<class T> void MeshDataTest::colorsAsArray() {
     setTestCaseTemplateName(NameTraits<T>::name());
     typedef typename T::Type U;
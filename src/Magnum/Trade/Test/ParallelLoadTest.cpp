@@ -0,0 +1,209 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <atomic>
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/MeshData.h"
+#include "Magnum/Trade/ParallelLoad.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct ParallelLoadTest: TestSuite::Tester {
+    explicit ParallelLoadTest();
+
+    void meshes();
+    void meshesEmpty();
+    void meshesNotOpened();
+    void meshesOutOfRange();
+
+    void images2D();
+    void images2DNotOpened();
+    void images2DOutOfRange();
+};
+
+const struct {
+    const char* name;
+    ImporterFeatures features;
+    UnsignedInt threadCount;
+} Data[]{
+    {"not thread-safe", {}, 4},
+    {"thread-safe, single thread", ImporterFeature::ThreadSafeImport, 1},
+    {"thread-safe, four threads", ImporterFeature::ThreadSafeImport, 4},
+    {"thread-safe, hardware concurrency", ImporterFeature::ThreadSafeImport, 0},
+};
+
+ParallelLoadTest::ParallelLoadTest() {
+    addInstancedTests({&ParallelLoadTest::meshes},
+        Containers::arraySize(Data));
+
+    addTests({&ParallelLoadTest::meshesEmpty,
+              &ParallelLoadTest::meshesNotOpened,
+              &ParallelLoadTest::meshesOutOfRange});
+
+    addInstancedTests({&ParallelLoadTest::images2D},
+        Containers::arraySize(Data));
+
+    addTests({&ParallelLoadTest::images2DNotOpened,
+              &ParallelLoadTest::images2DOutOfRange});
+}
+
+/* Mesh and image with ID 3 fail to import, vertex count and image width is
+   the ID */
+struct Importer: AbstractImporter {
+    explicit Importer(ImporterFeatures features, bool opened = true): _features{features}, _opened{opened} {}
+
+    ImporterFeatures doFeatures() const override { return _features; }
+    bool doIsOpened() const override { return _opened; }
+    void doClose() override {}
+
+    UnsignedInt doMeshCount() const override { return 5; }
+    Containers::Optional<MeshData> doMesh(UnsignedInt id, UnsignedInt) override {
+        ++calls;
+        if(id == 3) return {};
+        return MeshData{MeshPrimitive::Points, id};
+    }
+
+    UnsignedInt doImage2DCount() const override { return 5; }
+    Containers::Optional<ImageData2D> doImage2D(UnsignedInt id, UnsignedInt) override {
+        ++calls;
+        if(id == 3) return {};
+        return ImageData2D{PixelFormat::RGBA8Unorm, {Int(id), 1}, Containers::Array<char>{ValueInit, id*4}};
+    }
+
+    std::atomic<Int> calls{0};
+
+    private:
+        ImporterFeatures _features;
+        bool _opened;
+};
+
+void ParallelLoadTest::meshes() {
+    auto&& data = Data[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Importer importer{data.features};
+    Containers::Array<Containers::Optional<MeshData>> out = parallelLoadMeshes(importer, {4, 0, 3, 2, 2, 1, 4, 3}, data.threadCount);
+    CORRADE_COMPARE(out.size(), 8);
+    CORRADE_COMPARE(importer.calls.load(), 8);
+
+    /* The output is in the same order as the IDs */
+    const Int expected[]{4, 0, -1, 2, 2, 1, 4, -1};
+    for(std::size_t i = 0; i != out.size(); ++i) {
+        CORRADE_ITERATION(i);
+        if(expected[i] == -1) {
+            CORRADE_VERIFY(!out[i]);
+        } else {
+            CORRADE_VERIFY(out[i]);
+            CORRADE_COMPARE(out[i]->vertexCount(), expected[i]);
+        }
+    }
+}
+
+void ParallelLoadTest::meshesEmpty() {
+    Importer importer{ImporterFeature::ThreadSafeImport};
+    CORRADE_COMPARE(parallelLoadMeshes(importer, {}).size(), 0);
+    CORRADE_COMPARE(importer.calls.load(), 0);
+}
+
+void ParallelLoadTest::meshesNotOpened() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Importer importer{ImporterFeature::ThreadSafeImport, false};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    parallelLoadMeshes(importer, {0});
+    CORRADE_COMPARE(out.str(), "Trade::parallelLoadMeshes(): no file opened\n");
+}
+
+void ParallelLoadTest::meshesOutOfRange() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Importer importer{ImporterFeature::ThreadSafeImport};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    parallelLoadMeshes(importer, {0, 4, 5, 1});
+    CORRADE_COMPARE(out.str(), "Trade::parallelLoadMeshes(): index 5 out of range for 5 entries\n");
+    /* Nothing gets imported if the assertion fires */
+    CORRADE_COMPARE(importer.calls.load(), 0);
+}
+
+void ParallelLoadTest::images2D() {
+    auto&& data = Data[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Importer importer{data.features};
+    Containers::Array<Containers::Optional<ImageData2D>> out = parallelLoadImages2D(importer, {4, 0, 3, 2, 2, 1, 4, 3}, data.threadCount);
+    CORRADE_COMPARE(out.size(), 8);
+    CORRADE_COMPARE(importer.calls.load(), 8);
+
+    const Int expected[]{4, 0, -1, 2, 2, 1, 4, -1};
+    for(std::size_t i = 0; i != out.size(); ++i) {
+        CORRADE_ITERATION(i);
+        if(expected[i] == -1) {
+            CORRADE_VERIFY(!out[i]);
+        } else {
+            CORRADE_VERIFY(out[i]);
+            CORRADE_COMPARE(out[i]->size(), (Vector2i{expected[i], 1}));
+        }
+    }
+}
+
+void ParallelLoadTest::images2DNotOpened() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Importer importer{ImporterFeature::ThreadSafeImport, false};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    parallelLoadImages2D(importer, {0});
+    CORRADE_COMPARE(out.str(), "Trade::parallelLoadImages2D(): no file opened\n");
+}
+
+void ParallelLoadTest::images2DOutOfRange() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Importer importer{ImporterFeature::ThreadSafeImport};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    parallelLoadImages2D(importer, {0, 4, 5, 1});
+    CORRADE_COMPARE(out.str(), "Trade::parallelLoadImages2D(): index 5 out of range for 5 entries\n");
+    CORRADE_COMPARE(importer.calls.load(), 0);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::ParallelLoadTest)
@@ -48,6 +48,8 @@ class AbstractSceneConverter;
 typedef CORRADE_DEPRECATED("use InputFileCallbackPolicy instead") InputFileCallbackPolicy ImporterFileCallbackPolicy;
 #endif
 
+class ImporterCache;
+
 enum class MaterialAttribute: UnsignedInt;
 enum class MaterialTextureSwizzle: UnsignedInt;
 enum class MaterialAttributeType: UnsignedByte;
@@ -69,6 +71,7 @@ class AnimationData;
 enum class CameraType: UnsignedByte;
 class CameraData;
 
+class DataArena;
 enum class DataFlag: UnsignedByte;
 typedef Containers::EnumSet<DataFlag> DataFlags;
 
@@ -85,6 +88,7 @@ enum class MeshAttribute: UnsignedShort;
 class MeshIndexData;
 class MeshAttributeData;
 class MeshData;
+class ChunkedMeshData;
 
 #ifdef MAGNUM_BUILD_DEPRECATED
 class CORRADE_DEPRECATED("use MeshData instead") MeshData2D;
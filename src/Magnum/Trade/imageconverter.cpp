@@ -25,6 +25,7 @@
 
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Pointer.h>
 #include <Corrade/Containers/StaticArray.h>
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/PluginManager/Manager.h>
@@ -191,7 +192,8 @@ magnum-imageconverter [-h|--help] [-I|--importer PLUGIN]
     [-i|--importer-options key=val,key2=val2,…]
     [-c|--converter-options key=val,key2=val2,…]... [-D|--dimensions N]
     [--image N] [--level N] [--layer N] [--layers] [--levels] [--in-place]
-    [--info] [--color on|off|auto] [-v|--verbose] [--profile] [--] input output
+    [--info] [--color on|off|auto] [-v|--verbose] [--profile] [--batch FILE]
+    [-j|--jobs N] [--] input output
 @endcode
 
 Arguments:
@@ -224,6 +226,9 @@ Arguments:
 -   `--color` --- colored output for `--info` (default: `auto`)
 -   `-v`, `--verbose` --- verbose output from importer and converter plugins
 -   `--profile` --- measure import and conversion time
+-   `--batch FILE` --- convert all input / output pairs listed in a file
+-   `-j`, `--jobs N` --- worker count for `--batch` (default: `0`, which means
+    all available cores)
 
 Specifying `--importer raw:&lt;format&gt;` will treat the input as a raw
 tightly-packed square of pixels in given @ref PixelFormat. Specifying `-C` /
@@ -248,6 +253,29 @@ image-to-image or image-to-file conversion. If the last converter doesn't
 support conversion to a file, @relativeref{Trade,AnyImageConverter} is used to
 save its output; if no `-C` / `--converter` is specified,
 @relativeref{Trade,AnyImageConverter} is used.
+
+@subsection magnum-imageconverter-usage-batch Batch conversion
+
+If `--batch` is given, `input` and `output` are not specified and the pairs
+are read from given file instead, one whitespace-separated pair per line.
+Empty lines and lines starting with `#` are skipped. Filenames containing
+spaces are not supported.
+
+@code{.sh}
+magnum-imageconverter --batch textures.txt -j 8 --profile \
+    -C StbResizeImageConverter -c size="512 512"
+@endcode
+
+All plugins are loaded and configured just once for each of the `-j` /
+`--jobs` workers and then reused for all files, which avoids the plugin
+loading and startup overhead of invoking the utility for each file
+separately. Files are distributed to the workers dynamically as they finish
+previous conversions. With `--profile`, import and conversion time is printed
+for each file together with the total time. A failure to convert any file is
+reported but doesn't stop conversion of the remaining ones, the utility then
+exits with a non-zero code. Only 2D images are supported in this mode and it
+can't be combined with `--layers`, `--levels`, `--layer`, `--in-place`,
+`--info` or raw input and output.
 */
 
 }
@@ -340,6 +368,161 @@ template<UnsignedInt dimensions> bool convertImages(Trade::AbstractImageConverte
     return true;
 }
 
+/* Everything a --batch worker needs. The plugin managers are not shared
+   between workers, as the Any* plugins load their delegates through them. The
+   instances are declared after the managers so they get destroyed first. */
+struct BatchWorker {
+    Containers::Pointer<PluginManager::Manager<Trade::AbstractImporter>> importerManager;
+    Containers::Pointer<PluginManager::Manager<Trade::AbstractImageConverter>> converterManager;
+    Containers::Pointer<Trade::AbstractImporter> importer;
+    /* The last one is the one saving to a file */
+    Containers::Array<Containers::Pointer<Trade::AbstractImageConverter>> converters;
+};
+
+int convertBatch(const Utility::Arguments& args) {
+    if(args.arrayValueCount("input") || !args.value("output").empty()) {
+        Error{} << "Input and output files shouldn't be set for --batch";
+        return 1;
+    }
+    if(args.isSet("layers") || args.isSet("levels") || !args.value("layer").empty() || args.isSet("in-place") || args.isSet("info")) {
+        Error{} << "The --batch option can't be combined with --layers, --levels, --layer, --in-place or --info";
+        return 1;
+    }
+    if(args.value<Int>("dimensions") != 2) {
+        Error{} << "The --batch option can be only used for 2D images";
+        return 1;
+    }
+    if(args.value<Containers::StringView>("importer").hasPrefix("raw:"_s)) {
+        Error{} << "The --batch option can't be combined with raw data inputs";
+        return 1;
+    }
+    for(std::size_t i = 0; i != args.arrayValueCount("converter"); ++i) if(args.arrayValue("converter", i) == "raw") {
+        Error{} << "The --batch option can't be combined with raw data output";
+        return 1;
+    }
+
+    Containers::Optional<Containers::Array<Trade::Implementation::BatchEntry>> entries = Trade::Implementation::parseBatchManifest(args.value("batch"));
+    if(!entries) return 3;
+
+    /* Load all plugins upfront on the main thread, so the workers only do the
+       actual conversion */
+    const UnsignedInt image = args.value<UnsignedInt>("image");
+    Containers::Optional<UnsignedInt> level;
+    if(!args.value("level").empty()) level = args.value<UnsignedInt>("level");
+    Containers::Array<BatchWorker> workers{Implementation::batchWorkerCount(args.value<UnsignedInt>("jobs"), entries->size())};
+    for(BatchWorker& worker: workers) {
+        worker.importerManager.emplace(
+            args.value("plugin-dir").empty() ? Containers::String{} :
+            Utility::Path::join(args.value("plugin-dir"), Trade::AbstractImporter::pluginSearchPaths().back()));
+        worker.converterManager.emplace(
+            args.value("plugin-dir").empty() ? Containers::String{} :
+            Utility::Path::join(args.value("plugin-dir"), Trade::AbstractImageConverter::pluginSearchPaths().back()));
+
+        if(!(worker.importer = worker.importerManager->loadAndInstantiate(args.value("importer")))) {
+            Debug{} << "Available importer plugins:" << ", "_s.join(worker.importerManager->aliasList());
+            return 1;
+        }
+        if(args.isSet("verbose")) worker.importer->addFlags(Trade::ImporterFlag::Verbose);
+        Implementation::setOptions(*worker.importer, "AnyImageImporter", args.value("importer-options"));
+
+        /* Same logic as in the non-batch case -- the last passed converter is
+           used for saving if it's capable of that, otherwise the implicit
+           AnyImageConverter is appended */
+        for(std::size_t i = 0, converterCount = args.arrayValueCount("converter"); i <= converterCount; ++i) {
+            const Containers::StringView converterName = i == converterCount ?
+                "AnyImageConverter"_s : args.arrayValue<Containers::StringView>("converter", i);
+            Containers::Pointer<Trade::AbstractImageConverter> converter = worker.converterManager->loadAndInstantiate(converterName);
+            if(!converter) {
+                Debug{} << "Available converter plugins:" << ", "_s.join(worker.converterManager->aliasList());
+                return 2;
+            }
+
+            if(args.isSet("verbose")) converter->addFlags(Trade::ImageConverterFlag::Verbose);
+            if(i < args.arrayValueCount("converter-options"))
+                Implementation::setOptions(*converter, "AnyImageConverter", args.arrayValue("converter-options", i));
+
+            const bool last = i + 1 >= converterCount && (converter->features() & (Trade::ImageConverterFeature::Convert2DToFile|Trade::ImageConverterFeature::ConvertCompressed2DToFile));
+            arrayAppend(worker.converters, std::move(converter));
+            if(last) break;
+        }
+    }
+
+    /* Wow, C++, you suck. This implicitly initializes to random shit?! */
+    std::chrono::high_resolution_clock::duration totalTime{};
+    {
+        Trade::Implementation::Duration totalDuration{totalTime};
+        Implementation::runBatch(workers.size(), entries->size(), [&](const std::size_t workerId, const std::size_t i) {
+            BatchWorker& worker = workers[workerId];
+            Trade::Implementation::BatchEntry& entry = (*entries)[i];
+
+            Containers::Array<Trade::ImageData2D> images;
+            {
+                Trade::Implementation::Duration d{entry.importTime};
+                #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+                Containers::Optional<Containers::Array<const char, Utility::Path::MapDeleter>> mapped;
+                if(args.isSet("map")) {
+                    if(!(mapped = Utility::Path::mapRead(entry.input)) || !worker.importer->openMemory(*mapped)) {
+                        Error{} << "Cannot memory-map file" << entry.input;
+                        return;
+                    }
+                } else
+                #endif
+                if(!worker.importer->openFile(entry.input)) {
+                    Error{} << "Cannot open file" << entry.input;
+                    return;
+                }
+
+                if(image >= worker.importer->image2DCount()) {
+                    Error{} << "2D image number" << image << "not found in" << entry.input << Debug::nospace << ", the file has only" << worker.importer->image2DCount() << "2D images";
+                    worker.importer->close();
+                    return;
+                }
+
+                /* Import all levels of the input or just one if specified */
+                const UnsignedInt levelCount = worker.importer->image2DLevelCount(image);
+                if(level && *level >= levelCount) {
+                    Error{} << "2D image" << image << "in" << entry.input << "doesn't have a level number" << *level << Debug::nospace << ", only" << levelCount << "levels";
+                    worker.importer->close();
+                    return;
+                }
+                for(UnsignedInt j = level ? *level : 0, max = level ? *level + 1 : levelCount; j != max; ++j) {
+                    Containers::Optional<Trade::ImageData2D> imported = worker.importer->image2D(image, j);
+                    if(!imported) {
+                        Error{} << "Cannot import 2D image" << image << Debug::nospace << ":" << Debug::nospace << j << "from" << entry.input;
+                        worker.importer->close();
+                        return;
+                    }
+                    arrayAppend(images, std::move(*imported));
+                }
+
+                /* The (possibly memory-mapped) file isn't needed anymore as
+                   the images are owned */
+                worker.importer->close();
+            }
+
+            Trade::Implementation::Duration d{entry.conversionTime};
+            for(std::size_t j = 0; j + 1 < worker.converters.size(); ++j) {
+                if(!(worker.converters[j]->features() & (images.front().isCompressed() ? Trade::ImageConverterFeature::ConvertCompressed2D : Trade::ImageConverterFeature::Convert2D))) {
+                    Error{} << args.arrayValue("converter", j) << "doesn't support" << (images.front().isCompressed() ? "compressed 2D" : "2D") << "image conversion, only" << worker.converters[j]->features();
+                    return;
+                }
+                if(!convertImages(*worker.converters[j], images)) {
+                    Error{} << args.arrayValue("converter", j) << "cannot convert" << entry.input;
+                    return;
+                }
+            }
+            if(!convertOneOrMoreImagesToFile(*worker.converters.back(), images, entry.output)) {
+                Error{} << "Cannot save file" << entry.output;
+                return;
+            }
+
+            entry.succeeded = true;
+        });
+    }
+
+    return Trade::Implementation::printBatchProfile(*entries, workers.size(), totalTime, args.isSet("profile")) ? 1 : 0;
+}
+
 }
 
 int main(int argc, char** argv) {
@@ -365,6 +548,8 @@ int main(int argc, char** argv) {
         .addOption("color", "auto").setHelp("color", "colored output for --info", "on|off|auto")
         .addBooleanOption('v', "verbose").setHelp("verbose", "verbose output from importer and converter plugins")
         .addBooleanOption("profile").setHelp("profile", "measure import and conversion time")
+        .addOption("batch").setHelp("batch", "convert all input / output pairs listed in a file", "FILE")
+        .addOption('j', "jobs", "0").setHelp("jobs", "worker count for --batch, 0 means all available cores", "N")
         .setParseErrorCallback([](const Utility::Arguments& args, Utility::Arguments::ParseError error, const std::string& key) {
             /* If --in-place or --info is passed, we don't need the output
                argument */
@@ -372,6 +557,11 @@ int main(int argc, char** argv) {
                key == "output" && (args.isSet("in-place") || args.isSet("info")))
                 return true;
 
+            /* With --batch the files are taken from the manifest */
+            if(error == Utility::Arguments::ParseError::MissingArgument &&
+               (key == "input" || key == "output") && !args.value("batch").empty())
+                return true;
+
             /* Handle all other errors as usual */
             return false;
         })
@@ -396,9 +586,19 @@ together. All converters in the chain have to support image-to-image
 conversion, the last converter has to be either raw or support either
 image-to-image or image-to-file conversion. If the last converter doesn't
 support conversion to a file, AnyImageConverter is used to save its output; if
-no -C / --converter is specified, AnyImageConverter is used.)")
+no -C / --converter is specified, AnyImageConverter is used.
+
+If --batch is given, the input and output arguments are not specified and the
+input / output pairs are read from given file instead, one whitespace-separated
+pair per line, skipping empty lines and lines starting with #. Plugins are
+loaded just once and all files are converted on -j / --jobs workers, with
+--profile printing timing for each file. Only 2D images are supported in this
+mode and it can't be combined with --layers, --levels, --layer, --in-place,
+--info or raw input and output.)")
         .parse(argc, argv);
 
+    if(!args.value("batch").empty()) return convertBatch(args);
+
     /* Generic checks */
     if(!args.value<Containers::StringView>("output").isEmpty()) {
         if(args.isSet("in-place")) {
@@ -63,7 +63,7 @@ Buffer Buffer::wrap(Device& device, const VkBuffer handle, const HandleFlags fla
     return out;
 }
 
-Buffer::Buffer(Device& device, const BufferCreateInfo& info, NoAllocateT): _device{&device}, _flags{HandleFlag::DestroyOnDestruction}, _dedicatedMemory{NoCreate} {
+Buffer::Buffer(Device& device, const BufferCreateInfo& info, NoAllocateT): _device{&device}, _flags{HandleFlag::DestroyOnDestruction}, _dedicatedMemory{NoCreate}, _allocatedMemory{NoCreate} {
     MAGNUM_VK_INTERNAL_ASSERT_SUCCESS(device->CreateBuffer(device, info, nullptr, &_handle));
 }
 
@@ -75,9 +75,13 @@ Buffer::Buffer(Device& device, const BufferCreateInfo& info, const MemoryFlags m
     }});
 }
 
-Buffer::Buffer(NoCreateT): _device{}, _handle{}, _dedicatedMemory{NoCreate} {}
+Buffer::Buffer(Device& device, const BufferCreateInfo& info, MemoryAllocator& allocator, const MemoryFlags memoryFlags): Buffer{device, info, NoAllocate} {
+    bindAllocatedMemory(allocator.allocate(memoryRequirements(), memoryFlags));
+}
+
+Buffer::Buffer(NoCreateT): _device{}, _handle{}, _dedicatedMemory{NoCreate}, _allocatedMemory{NoCreate} {}
 
-Buffer::Buffer(Buffer&& other) noexcept: _device{other._device}, _handle{other._handle}, _flags{other._flags}, _dedicatedMemory{std::move(other._dedicatedMemory)} {
+Buffer::Buffer(Buffer&& other) noexcept: _device{other._device}, _handle{other._handle}, _flags{other._flags}, _dedicatedMemory{std::move(other._dedicatedMemory)}, _allocatedMemory{std::move(other._allocatedMemory)} {
     other._handle = {};
 }
 
@@ -92,6 +96,7 @@ Buffer& Buffer::operator=(Buffer&& other) noexcept {
     swap(other._handle, _handle);
     swap(other._flags, _flags);
     swap(other._dedicatedMemory, _dedicatedMemory);
+    swap(other._allocatedMemory, _allocatedMemory);
     return *this;
 }
 
@@ -130,6 +135,23 @@ Memory& Buffer::dedicatedMemory() {
     return _dedicatedMemory;
 }
 
+void Buffer::bindAllocatedMemory(MemoryAllocation&& allocation) {
+    CORRADE_ASSERT(allocation.isCreated(),
+        "Vk::Buffer::bindAllocatedMemory(): the allocation is not created", );
+    bindMemory(allocation.memory(), allocation.offset());
+    _allocatedMemory = std::move(allocation);
+}
+
+bool Buffer::hasAllocatedMemory() const {
+    return _allocatedMemory.isCreated();
+}
+
+MemoryAllocation& Buffer::allocatedMemory() {
+    CORRADE_ASSERT(_allocatedMemory.isCreated(),
+        "Vk::Buffer::allocatedMemory(): buffer doesn't have an allocated memory", _allocatedMemory);
+    return _allocatedMemory;
+}
+
 VkBuffer Buffer::release() {
     const VkBuffer handle = _handle;
     _handle = {};
@@ -37,6 +37,7 @@
 #include "Magnum/Magnum.h"
 #include "Magnum/Tags.h"
 #include "Magnum/Vk/Memory.h"
+#include "Magnum/Vk/MemoryAllocator.h"
 #include "Magnum/Vk/Vk.h"
 #include "Magnum/Vk/Vulkan.h"
 #include "Magnum/Vk/visibility.h"
@@ -78,6 +79,18 @@ available through @ref dedicatedMemory(). This matches current behavior of the
 above, except that you have more control over choosing and allocating the
 memory.
 
+@subsection Vk-Buffer-creation-allocator Allocating from a memory allocator
+
+Creating a dedicated allocation for every buffer is slow and the count of
+allocations is limited. Passing a @ref MemoryAllocator to the
+@ref Buffer(Device&, const BufferCreateInfo&, MemoryAllocator&, MemoryFlags) constructor
+sub-allocates the memory from a larger block instead, the allocation is
+subsequently available through @ref allocatedMemory(). Alternatively, an
+allocation made with @ref MemoryAllocator::allocate() can be bound using
+@ref bindAllocatedMemory().
+
+@snippet MagnumVk.cpp Buffer-creation-allocator
+
 @section Vk-Buffer-usage Buffer usage
 
 @subsection Vk-Buffer-usage-fill Clearing / filling buffer data
@@ -147,6 +160,22 @@ class MAGNUM_VK_EXPORT Buffer {
          */
         explicit Buffer(Device& device, const BufferCreateInfo& info, MemoryFlags memoryFlags);
 
+        /**
+         * @brief Construct a buffer with memory from an allocator
+         * @param device        Vulkan device to create the buffer on
+         * @param info          Buffer creation info
+         * @param allocator     Memory allocator
+         * @param memoryFlags   Memory allocation flags
+         * @m_since_latest
+         *
+         * Compared to @ref Buffer(Device&, const BufferCreateInfo&, MemoryFlags) the
+         * memory is allocated using
+         * @ref MemoryAllocator::allocate(const MemoryRequirements&, MemoryFlags, MemoryFlags)
+         * and is subsequently accessible through @ref allocatedMemory(). The
+         * allocator is expected to outlive the buffer.
+         */
+        explicit Buffer(Device& device, const BufferCreateInfo& info, MemoryAllocator& allocator, MemoryFlags memoryFlags);
+
         /**
          * @brief Construct without creating the buffer
          *
@@ -231,6 +260,37 @@ class MAGNUM_VK_EXPORT Buffer {
          */
         Memory& dedicatedMemory();
 
+        /**
+         * @brief Bind memory from an allocator
+         * @m_since_latest
+         *
+         * Equivalent to @ref bindMemory() with @ref MemoryAllocation::memory()
+         * and @ref MemoryAllocation::offset(), with the additional effect
+         * that @p allocation ownership transfers to the buffer and is then
+         * available through @ref allocatedMemory(). The allocation is
+         * returned back to the allocator when the buffer is destroyed.
+         */
+        void bindAllocatedMemory(MemoryAllocation&& allocation);
+
+        /**
+         * @brief Whether the buffer has memory from an allocator
+         * @m_since_latest
+         *
+         * Returns @cpp true @ce if the buffer memory was bound using
+         * @ref bindAllocatedMemory(), @cpp false @ce otherwise.
+         * @see @ref allocatedMemory()
+         */
+        bool hasAllocatedMemory() const;
+
+        /**
+         * @brief Memory allocation of the buffer
+         * @m_since_latest
+         *
+         * Expects that the buffer has memory from an allocator.
+         * @see @ref hasAllocatedMemory()
+         */
+        MemoryAllocation& allocatedMemory();
+
         /**
          * @brief Release the underlying Vulkan buffer
          *
@@ -258,6 +318,7 @@ class MAGNUM_VK_EXPORT Buffer {
         VkBuffer _handle;
         HandleFlags _flags;
         Memory _dedicatedMemory;
+        MemoryAllocation _allocatedMemory;
 };
 
 /**
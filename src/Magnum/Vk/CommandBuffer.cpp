@@ -25,6 +25,8 @@
 
 #include "CommandBuffer.h"
 
+#include <Corrade/Containers/Array.h>
+
 #include "Magnum/Vk/Assert.h"
 #include "Magnum/Vk/Device.h"
 #include "Magnum/Vk/Handle.h"
@@ -66,11 +68,34 @@ void CommandBuffer::reset(const CommandBufferResetFlags flags) {
     MAGNUM_VK_INTERNAL_ASSERT_SUCCESS((**_device).ResetCommandBuffer(_handle, VkCommandBufferResetFlags(flags)));
 }
 
-CommandBufferBeginInfo::CommandBufferBeginInfo(const Flags flags): _info{} {
+CommandBufferInheritanceInfo::CommandBufferInheritanceInfo(const VkRenderPass renderPass, const UnsignedInt subpass, const VkFramebuffer framebuffer): _info{} {
+    _info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    _info.renderPass = renderPass;
+    _info.subpass = subpass;
+    _info.framebuffer = framebuffer;
+}
+
+CommandBufferInheritanceInfo::CommandBufferInheritanceInfo(NoInitT) noexcept {}
+
+CommandBufferInheritanceInfo::CommandBufferInheritanceInfo(const VkCommandBufferInheritanceInfo& info):
+    /* Can't use {} with GCC 4.8 here because it tries to initialize the first
+       member instead of doing a copy */
+    _info(info) {}
+
+CommandBufferBeginInfo::CommandBufferBeginInfo(const Flags flags): _info{}, _inheritanceInfo{} {
     _info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
     _info.flags = VkCommandBufferUsageFlags(flags);
 }
 
+CommandBufferBeginInfo::CommandBufferBeginInfo(const CommandBufferInheritanceInfo& inheritanceInfo, const Flags flags): CommandBufferBeginInfo{flags} {
+    _inheritanceInfo = *inheritanceInfo;
+    _info.pInheritanceInfo = &_inheritanceInfo;
+    /* The render pass (and subpass, framebuffer) is ignored without this
+       flag, so add it implicitly to avoid a hard-to-discover mistake */
+    if(_inheritanceInfo.renderPass)
+        _info.flags |= VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+}
+
 CommandBufferBeginInfo::CommandBufferBeginInfo(NoInitT) noexcept {}
 
 CommandBufferBeginInfo::CommandBufferBeginInfo(const VkCommandBufferBeginInfo& info):
@@ -78,6 +103,23 @@ CommandBufferBeginInfo::CommandBufferBeginInfo(const VkCommandBufferBeginInfo& i
        member instead of doing a copy */
     _info(info) {}
 
+CommandBufferBeginInfo::CommandBufferBeginInfo(const CommandBufferBeginInfo& other) noexcept:
+    /* Can't use {} with GCC 4.8 here because it tries to initialize the first
+       member instead of doing a copy */
+    _info(other._info), _inheritanceInfo(other._inheritanceInfo)
+{
+    if(_info.pInheritanceInfo == &other._inheritanceInfo)
+        _info.pInheritanceInfo = &_inheritanceInfo;
+}
+
+CommandBufferBeginInfo& CommandBufferBeginInfo::operator=(const CommandBufferBeginInfo& other) noexcept {
+    _info = other._info;
+    _inheritanceInfo = other._inheritanceInfo;
+    if(_info.pInheritanceInfo == &other._inheritanceInfo)
+        _info.pInheritanceInfo = &_inheritanceInfo;
+    return *this;
+}
+
 CommandBuffer& CommandBuffer::begin(const CommandBufferBeginInfo& info) {
     MAGNUM_VK_INTERNAL_ASSERT_SUCCESS((**_device).BeginCommandBuffer(_handle, info));
     return *this;
@@ -93,6 +135,22 @@ void CommandBuffer::end() {
     MAGNUM_VK_INTERNAL_ASSERT_SUCCESS((**_device).EndCommandBuffer(_handle));
 }
 
+CommandBuffer& CommandBuffer::executeCommands(const Containers::ArrayView<const VkCommandBuffer> buffers) {
+    (**_device).CmdExecuteCommands(_handle, buffers.size(), buffers.data());
+    return *this;
+}
+
+CommandBuffer& CommandBuffer::executeCommands(const std::initializer_list<VkCommandBuffer> buffers) {
+    return executeCommands(Containers::arrayView(buffers));
+}
+
+CommandBuffer& CommandBuffer::executeCommands(const Containers::ArrayView<CommandBuffer> buffers) {
+    Containers::Array<VkCommandBuffer> handles{NoInit, buffers.size()};
+    for(std::size_t i = 0; i != buffers.size(); ++i)
+        handles[i] = buffers[i];
+    return executeCommands(handles);
+}
+
 VkCommandBuffer CommandBuffer::release() {
     const VkCommandBuffer handle = _handle;
     _handle = nullptr;
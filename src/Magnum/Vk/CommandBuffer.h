@@ -26,7 +26,7 @@
 */
 
 /** @file
- * @brief Class @ref Magnum::Vk::CommandBuffer, @ref Magnum::Vk::CommandBufferBeginInfo, enum @ref Magnum::Vk::CommandPoolResetFlag, enum set @ref Magnum::Vk::CommandPoolResetFlags
+ * @brief Class @ref Magnum::Vk::CommandBuffer, @ref Magnum::Vk::CommandBufferBeginInfo, @ref Magnum::Vk::CommandBufferInheritanceInfo, enum @ref Magnum::Vk::CommandPoolResetFlag, enum set @ref Magnum::Vk::CommandPoolResetFlags
  * @m_since_latest
  */
 
@@ -44,6 +44,70 @@ namespace Magnum { namespace Vk {
 
 namespace Implementation { struct DeviceState; }
 
+/**
+@brief Command buffer inheritance info
+@m_since_latest
+
+Wraps a @type_vk_keyword{CommandBufferInheritanceInfo}. Describes state a
+@ref CommandBufferLevel::Secondary command buffer inherits from the primary
+command buffer it gets executed from. See
+@ref Vk-CommandBuffer-secondary "Secondary command buffers" for more
+information.
+@see @ref CommandBufferBeginInfo::CommandBufferBeginInfo(const CommandBufferInheritanceInfo&, Flags)
+*/
+class MAGNUM_VK_EXPORT CommandBufferInheritanceInfo {
+    public:
+        /**
+         * @brief Constructor
+         * @param renderPass    Render pass the secondary command buffer will
+         *      be executed in or @cpp {} @ce if it'll be executed outside of
+         *      a render pass
+         * @param subpass       Index of the subpass in @p renderPass
+         * @param framebuffer   Framebuffer the secondary command buffer will
+         *      be rendering to. If not known upfront, can be @cpp {} @ce,
+         *      but specifying it may result in better performance.
+         *
+         * The following @type_vk{CommandBufferInheritanceInfo} fields are
+         * pre-filled in addition to `sType`, everything else is zero-filled:
+         *
+         * -    `renderPass`
+         * -    `subpass`
+         * -    `framebuffer`
+         */
+        explicit CommandBufferInheritanceInfo(VkRenderPass renderPass = {}, UnsignedInt subpass = 0, VkFramebuffer framebuffer = {});
+
+        /**
+         * @brief Construct without initializing the contents
+         *
+         * Note that not even the `sType` field is set --- the structure has to
+         * be fully initialized afterwards in order to be usable.
+         */
+        explicit CommandBufferInheritanceInfo(NoInitT) noexcept;
+
+        /**
+         * @brief Construct from existing data
+         *
+         * Copies the existing values verbatim, pointers are kept unchanged
+         * without taking over the ownership. Modifying the newly created
+         * instance will not modify the original data nor the pointed-to data.
+         */
+        explicit CommandBufferInheritanceInfo(const VkCommandBufferInheritanceInfo& info);
+
+        /** @brief Underlying @type_vk{CommandBufferInheritanceInfo} structure */
+        VkCommandBufferInheritanceInfo& operator*() { return _info; }
+        /** @overload */
+        const VkCommandBufferInheritanceInfo& operator*() const { return _info; }
+        /** @overload */
+        VkCommandBufferInheritanceInfo* operator->() { return &_info; }
+        /** @overload */
+        const VkCommandBufferInheritanceInfo* operator->() const { return &_info; }
+        /** @overload */
+        operator const VkCommandBufferInheritanceInfo*() const { return &_info; }
+
+    private:
+        VkCommandBufferInheritanceInfo _info;
+};
+
 /**
 @brief Command buffer begin info
 @m_since_latest
@@ -111,6 +175,21 @@ class MAGNUM_VK_EXPORT CommandBufferBeginInfo {
            point in making this implicit. */
         explicit CommandBufferBeginInfo(Flags flags = {});
 
+        /**
+         * @brief Construct for a secondary command buffer
+         * @param inheritanceInfo   Inheritance info
+         * @param flags             Command buffer begin flags
+         *
+         * Compared to @ref CommandBufferBeginInfo(Flags), the
+         * `pInheritanceInfo` field is set to a copy of @p inheritanceInfo
+         * stored inside this instance. If @p inheritanceInfo references a
+         * render pass, @ref Flag::RenderPassContinue is implicitly added to
+         * @p flags, as the render pass isn't taken into account otherwise.
+         * Only meaningful for @ref CommandBufferLevel::Secondary command
+         * buffers, ignored for primary.
+         */
+        explicit CommandBufferBeginInfo(const CommandBufferInheritanceInfo& inheritanceInfo, Flags flags = {});
+
         /**
          * @brief Construct without initializing the contents
          *
@@ -128,6 +207,22 @@ class MAGNUM_VK_EXPORT CommandBufferBeginInfo {
          */
         explicit CommandBufferBeginInfo(const VkCommandBufferBeginInfo& info);
 
+        /**
+         * @brief Copy constructor
+         *
+         * If the `pInheritanceInfo` field points to the inheritance info
+         * stored inside @p other, it's redirected to the copy.
+         */
+        CommandBufferBeginInfo(const CommandBufferBeginInfo& other) noexcept;
+
+        /**
+         * @brief Copy assignment
+         *
+         * See @ref CommandBufferBeginInfo(const CommandBufferBeginInfo&) for
+         * details.
+         */
+        CommandBufferBeginInfo& operator=(const CommandBufferBeginInfo& other) noexcept;
+
         /** @brief Underlying @type_vk{CommandBufferBeginInfo} structure */
         VkCommandBufferBeginInfo& operator*() { return _info; }
         /** @overload */
@@ -141,6 +236,7 @@ class MAGNUM_VK_EXPORT CommandBufferBeginInfo {
 
     private:
         VkCommandBufferBeginInfo _info;
+        VkCommandBufferInheritanceInfo _inheritanceInfo;
 };
 
 CORRADE_ENUMSET_OPERATORS(CommandBufferBeginInfo::Flags)
@@ -205,6 +301,24 @@ that was set up at @ref Vk-Device-creation "device creation time". Usually
 you'd want to wait on the submit completion with a @link Fence @endlink:
 
 @snippet MagnumVk.cpp CommandBuffer-usage-submit
+
+@section Vk-CommandBuffer-secondary Secondary command buffers
+
+A @ref CommandBufferLevel::Secondary command buffer can't be submitted to a
+queue directly, instead it's executed from a primary command buffer using
+@ref executeCommands(). To be executed inside a render pass, it has to be
+recorded with a @ref CommandBufferInheritanceInfo referencing the render pass
+and subpass, and the subpass has to begin with
+@ref SubpassContents::SecondaryCommandBuffers:
+
+@snippet MagnumVk.cpp CommandBuffer-secondary
+
+As the commands for a single subpass can be recorded into multiple secondary
+command buffers, this is the main building block for recording a frame from
+multiple threads. A command pool and buffers allocated from it can't be
+used from more than one thread at a time though, see the
+@ref ParallelCommandRecorder class for a helper that manages a pool for each
+thread and records secondary command buffers in parallel.
 */
 class MAGNUM_VK_EXPORT CommandBuffer {
     public:
@@ -371,6 +485,53 @@ class MAGNUM_VK_EXPORT CommandBuffer {
         CommandBuffer& endRenderPass();
         #endif
 
+        /**
+         * @brief Begin dynamic rendering
+         * @return Reference to self (for method chaining)
+         *
+         * Alternative to @ref beginRenderPass() that doesn't need any
+         * @ref RenderPass or @ref Framebuffer objects --- the attachments are
+         * specified directly in @p info, and rasterization pipelines used
+         * inside are expected to be created with
+         * @ref RasterizationPipelineCreateInfo::setRenderingFormats() instead
+         * of a render pass. See @ref RenderingInfo for a usage example. The
+         * rendering has to be ended with @ref endRendering().
+         * @requires_vk_feature @ref DeviceFeature::DynamicRendering
+         * @see @fn_vk_keyword{CmdBeginRenderingKHR}
+         */
+        CommandBuffer& beginRendering(const RenderingInfo& info);
+
+        /**
+         * @brief End dynamic rendering
+         * @return Reference to self (for method chaining)
+         *
+         * @requires_vk_feature @ref DeviceFeature::DynamicRendering
+         * @see @ref beginRendering(), @fn_vk_keyword{CmdEndRenderingKHR}
+         */
+        CommandBuffer& endRendering();
+
+        /**
+         * @brief Execute secondary command buffers
+         * @return Reference to self (for method chaining)
+         *
+         * Can be called both inside and outside a render pass. The
+         * @p buffers are expected to be non-empty and all be
+         * @ref CommandBufferLevel::Secondary command buffers in the
+         * executable state. When called inside a render pass, the current
+         * subpass is expected to be started with
+         * @ref SubpassContents::SecondaryCommandBuffers and the buffers
+         * recorded with a @ref CommandBufferInheritanceInfo matching it. See
+         * @ref Vk-CommandBuffer-secondary for a usage example.
+         * @see @fn_vk_keyword{CmdExecuteCommands}
+         */
+        CommandBuffer& executeCommands(Containers::ArrayView<const VkCommandBuffer> buffers);
+
+        /** @overload */
+        CommandBuffer& executeCommands(std::initializer_list<VkCommandBuffer> buffers);
+
+        /** @overload */
+        CommandBuffer& executeCommands(Containers::ArrayView<CommandBuffer> buffers);
+
         /**
          * @brief Bind a pipeline
          * @return Reference to self (for method chaining)
@@ -393,6 +554,97 @@ class MAGNUM_VK_EXPORT CommandBuffer {
          */
         CommandBuffer& draw(Mesh& mesh);
 
+        /**
+         * @brief Draw a mesh with parameters sourced from a buffer
+         * @param mesh          Mesh to draw
+         * @param buffer        Buffer containing the draw parameters.
+         *      Expected to have been created with
+         *      @ref BufferUsage::IndirectBuffer.
+         * @param offset        Offset of the first draw parameters in
+         *      @p buffer. Has to be a multiple of @cpp 4 @ce.
+         * @param drawCount     Count of draws to execute
+         * @param stride        Stride between consecutive draw parameters. If
+         *      @cpp 0 @ce, the parameters are assumed to be tightly packed.
+         * @return Reference to self (for method chaining)
+         *
+         * Binds vertex and index buffers of @p mesh and sets dynamic states
+         * the same way as @ref draw(), but the vertex or index count,
+         * instance count and offsets are taken from @p buffer instead of
+         * @ref Mesh::count(), @ref Mesh::instanceCount() and related. If the
+         * mesh is indexed, @p buffer is expected to contain
+         * @type_vk{DrawIndexedIndirectCommand} structures, otherwise
+         * @type_vk{DrawIndirectCommand} structures.
+         *
+         * Can be only called inside a render pass with a graphics pipeline
+         * bound. If @p drawCount is larger than @cpp 1 @ce,
+         * @ref DeviceFeature::MultiDrawIndirect has to be enabled. If the
+         * draws use a non-zero first instance,
+         * @ref DeviceFeature::DrawIndirectFirstInstance has to be enabled.
+         *
+         * @snippet MagnumVk.cpp CommandBuffer-draw-indirect
+         *
+         * @see @ref Mesh::isIndexed(), @ref drawIndirectCount(),
+         *      @fn_vk_keyword{CmdDrawIndirect},
+         *      @fn_vk_keyword{CmdDrawIndexedIndirect}
+         */
+        CommandBuffer& drawIndirect(Mesh& mesh, VkBuffer buffer, UnsignedLong offset, UnsignedInt drawCount, UnsignedInt stride = 0);
+
+        /**
+         * @brief Draw a mesh with parameters and draw count sourced from a buffer
+         * @param mesh          Mesh to draw
+         * @param buffer        Buffer containing the draw parameters.
+         *      Expected to have been created with
+         *      @ref BufferUsage::IndirectBuffer.
+         * @param offset        Offset of the first draw parameters in
+         *      @p buffer. Has to be a multiple of @cpp 4 @ce.
+         * @param countBuffer   Buffer containing the draw count. Expected to
+         *      have been created with @ref BufferUsage::IndirectBuffer.
+         * @param countOffset   Offset of the draw count in @p countBuffer.
+         *      Has to be a multiple of @cpp 4 @ce.
+         * @param maxDrawCount  Max count of draws to execute
+         * @param stride        Stride between consecutive draw parameters. If
+         *      @cpp 0 @ce, the parameters are assumed to be tightly packed.
+         * @return Reference to self (for method chaining)
+         *
+         * Compared to @ref drawIndirect() the draw count is read from
+         * @p countBuffer and clamped to @p maxDrawCount, which allows for
+         * example a compute shader to cull the draws on the GPU. Expects
+         * that @vk_extension{KHR,draw_indirect_count} is enabled on the
+         * device or Vulkan 1.2 is supported. If the extension isn't enabled
+         * on a Vulkan 1.2 device, the `drawIndirectCount` feature of
+         * @type_vk{PhysicalDeviceVulkan12Features} has to be enabled instead.
+         * @see @fn_vk_keyword{CmdDrawIndirectCount},
+         *      @fn_vk_keyword{CmdDrawIndexedIndirectCount}
+         */
+        CommandBuffer& drawIndirectCount(Mesh& mesh, VkBuffer buffer, UnsignedLong offset, VkBuffer countBuffer, UnsignedLong countOffset, UnsignedInt maxDrawCount, UnsignedInt stride = 0);
+
+        /**
+         * @brief Dispatch compute work
+         * @param count     Count of local workgroups in each dimension
+         * @return Reference to self (for method chaining)
+         *
+         * Can be only called outside of a render pass with a compute pipeline
+         * bound. If any component of @p count is zero, no work is dispatched.
+         * @see @ref Vk-Pipeline-usage, @ref dispatchIndirect(),
+         *      @fn_vk_keyword{CmdDispatch}
+         */
+        CommandBuffer& dispatch(const Vector3ui& count);
+
+        /**
+         * @brief Dispatch compute work with parameters sourced from a buffer
+         * @param buffer    Buffer containing a
+         *      @type_vk{DispatchIndirectCommand} structure. Expected to have
+         *      been created with @ref BufferUsage::IndirectBuffer.
+         * @param offset    Offset of the parameters in @p buffer. Has to be a
+         *      multiple of @cpp 4 @ce.
+         * @return Reference to self (for method chaining)
+         *
+         * Can be only called outside of a render pass with a compute pipeline
+         * bound.
+         * @see @ref dispatch(), @fn_vk_keyword{CmdDispatchIndirect}
+         */
+        CommandBuffer& dispatchIndirect(VkBuffer buffer, UnsignedLong offset = 0);
+
         /**
          * @brief Insert an execution barrier with optional memory dependencies
          * @param sourceStages          Source stages. Has to contain at least
@@ -506,6 +758,21 @@ class MAGNUM_VK_EXPORT CommandBuffer {
         /** @overload */
         CommandBuffer& pipelineBarrier(PipelineStages sourceStages, PipelineStages destinationStages, std::initializer_list<ImageMemoryBarrier> imageMemoryBarriers, DependencyFlags dependencyFlags = {});
 
+        /**
+         * @brief Insert a dependency with per-barrier pipeline stages
+         * @return Reference to self (for method chaining)
+         *
+         * Compared to @ref pipelineBarrier(PipelineStages, PipelineStages, Containers::ArrayView<const MemoryBarrier>, Containers::ArrayView<const BufferMemoryBarrier>, Containers::ArrayView<const ImageMemoryBarrier>, DependencyFlags)
+         * each barrier in @p info has its own pair of source and destination
+         * stages. If @ref DeviceFeature::Synchronization2 is not enabled on
+         * the device, the stages of all barriers are merged together and the
+         * barriers are submitted through the classic
+         * @fn_vk{CmdPipelineBarrier} instead. See @ref DependencyInfo for a
+         * usage example.
+         * @see @fn_vk_keyword{CmdPipelineBarrier2KHR}
+         */
+        CommandBuffer& pipelineBarrier(const DependencyInfo& info);
+
         /**
          * @brief Fill a buffer region with a fixed value
          * @param buffer    Source @p Buffer or a raw Vulkan buffer handle to
@@ -781,6 +1048,61 @@ class MAGNUM_VK_EXPORT CommandBuffer {
          */
         CommandBuffer& copyImageToBuffer(const CopyImageToBufferInfo& info);
 
+        /**
+         * @brief Reset queries in a query pool
+         * @param pool      Query pool
+         * @param first     First query to reset
+         * @param count     Count of queries to reset
+         * @return Reference to self (for method chaining)
+         *
+         * Allowed only outside of a render pass. Queries have to be reset
+         * before each use. See @ref Vk-QueryPool-usage for details.
+         * @see @fn_vk_keyword{CmdResetQueryPool}
+         */
+        CommandBuffer& resetQueryPool(VkQueryPool pool, UnsignedInt first, UnsignedInt count);
+
+        /**
+         * @brief Begin a query
+         * @param pool      Query pool
+         * @param query     Query index
+         * @param flags     Query control flags
+         * @return Reference to self (for method chaining)
+         *
+         * Used for @ref QueryType::Occlusion and
+         * @ref QueryType::PipelineStatistics queries. The query has to be
+         * reset first using @ref resetQueryPool() and ended using
+         * @ref endQuery(). See @ref Vk-QueryPool-usage for details.
+         * @see @fn_vk_keyword{CmdBeginQuery}
+         */
+        CommandBuffer& beginQuery(VkQueryPool pool, UnsignedInt query, QueryControlFlags flags = {});
+
+        /**
+         * @brief End a query
+         * @param pool      Query pool
+         * @param query     Query index
+         * @return Reference to self (for method chaining)
+         *
+         * Ends a query started with @ref beginQuery().
+         * @see @fn_vk_keyword{CmdEndQuery}
+         */
+        CommandBuffer& endQuery(VkQueryPool pool, UnsignedInt query);
+
+        /**
+         * @brief Write a timestamp
+         * @param stage     Pipeline stage after which the timestamp is
+         *      written
+         * @param pool      Query pool
+         * @param query     Query index
+         * @return Reference to self (for method chaining)
+         *
+         * The @p pool is expected to be of @ref QueryType::Timestamp and the
+         * query has to be reset first using @ref resetQueryPool(). Writes
+         * the timestamp once all previous commands complete the @p stage. See
+         * @ref Vk-QueryPool-usage for details.
+         * @see @fn_vk_keyword{CmdWriteTimestamp}
+         */
+        CommandBuffer& writeTimestamp(PipelineStage stage, VkQueryPool pool, UnsignedInt query);
+
     private:
         friend CommandPool;
         friend Implementation::DeviceState;
@@ -797,9 +1119,28 @@ class MAGNUM_VK_EXPORT CommandBuffer {
         MAGNUM_VK_LOCAL static void endRenderPassImplementationKHR(CommandBuffer& self, const VkSubpassEndInfo& endInfo);
         MAGNUM_VK_LOCAL static void endRenderPassImplementation12(CommandBuffer& self, const VkSubpassEndInfo& endInfo);
 
+        MAGNUM_VK_LOCAL static void beginRenderingImplementationDefault(CommandBuffer& self, const VkRenderingInfoKHR& info);
+        MAGNUM_VK_LOCAL static void beginRenderingImplementationKHR(CommandBuffer& self, const VkRenderingInfoKHR& info);
+
+        MAGNUM_VK_LOCAL static void endRenderingImplementationDefault(CommandBuffer& self);
+        MAGNUM_VK_LOCAL static void endRenderingImplementationKHR(CommandBuffer& self);
+
+        MAGNUM_VK_LOCAL static void pipelineBarrier2ImplementationDefault(CommandBuffer& self, const VkDependencyInfoKHR& info);
+        MAGNUM_VK_LOCAL static void pipelineBarrier2ImplementationKHR(CommandBuffer& self, const VkDependencyInfoKHR& info);
+
         MAGNUM_VK_LOCAL static void bindVertexBuffersImplementationDefault(CommandBuffer& self, UnsignedInt firstBinding, UnsignedInt bindingCount, const VkBuffer* buffers, const UnsignedLong* offsets, const UnsignedLong* strides);
         MAGNUM_VK_LOCAL static void bindVertexBuffersImplementationEXT(CommandBuffer& self, UnsignedInt firstBinding, UnsignedInt bindingCount, const VkBuffer* buffers, const UnsignedLong* offsets, const UnsignedLong* strides);
 
+        MAGNUM_VK_LOCAL void bindMeshBuffers(Mesh& mesh);
+
+        MAGNUM_VK_LOCAL static void drawIndirectCountImplementationDefault(CommandBuffer& self, VkBuffer buffer, UnsignedLong offset, VkBuffer countBuffer, UnsignedLong countOffset, UnsignedInt maxDrawCount, UnsignedInt stride);
+        MAGNUM_VK_LOCAL static void drawIndirectCountImplementationKHR(CommandBuffer& self, VkBuffer buffer, UnsignedLong offset, VkBuffer countBuffer, UnsignedLong countOffset, UnsignedInt maxDrawCount, UnsignedInt stride);
+        MAGNUM_VK_LOCAL static void drawIndirectCountImplementation12(CommandBuffer& self, VkBuffer buffer, UnsignedLong offset, VkBuffer countBuffer, UnsignedLong countOffset, UnsignedInt maxDrawCount, UnsignedInt stride);
+
+        MAGNUM_VK_LOCAL static void drawIndexedIndirectCountImplementationDefault(CommandBuffer& self, VkBuffer buffer, UnsignedLong offset, VkBuffer countBuffer, UnsignedLong countOffset, UnsignedInt maxDrawCount, UnsignedInt stride);
+        MAGNUM_VK_LOCAL static void drawIndexedIndirectCountImplementationKHR(CommandBuffer& self, VkBuffer buffer, UnsignedLong offset, VkBuffer countBuffer, UnsignedLong countOffset, UnsignedInt maxDrawCount, UnsignedInt stride);
+        MAGNUM_VK_LOCAL static void drawIndexedIndirectCountImplementation12(CommandBuffer& self, VkBuffer buffer, UnsignedLong offset, VkBuffer countBuffer, UnsignedLong countOffset, UnsignedInt maxDrawCount, UnsignedInt stride);
+
         MAGNUM_VK_LOCAL static void copyBufferImplementationDefault(CommandBuffer& self, const CopyBufferInfo& info);
         MAGNUM_VK_LOCAL static void copyBufferImplementationKHR(CommandBuffer& self, const CopyBufferInfo& info);
 
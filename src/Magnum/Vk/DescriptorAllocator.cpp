@@ -0,0 +1,131 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "DescriptorAllocator.h"
+
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Vk/DescriptorPool.h"
+#include "Magnum/Vk/DescriptorSet.h"
+
+namespace Magnum { namespace Vk {
+
+struct DescriptorAllocator::Frame {
+    Containers::Array<DescriptorPool> pools;
+    /* Index of the pool to allocate from, equal to pools.size() if all are
+       exhausted */
+    std::size_t current;
+};
+
+DescriptorAllocator::DescriptorAllocator(Device& device, DescriptorPoolCreateInfo&& poolInfo, const UnsignedInt frameCount): _device{&device}, _poolInfo{std::move(poolInfo)}, _frameIndex{} {
+    CORRADE_ASSERT(frameCount,
+        "Vk::DescriptorAllocator: expected non-zero frame count", );
+    CORRADE_ASSERT(!(_poolInfo->flags & VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT),
+        "Vk::DescriptorAllocator: pools with Vk::DescriptorPoolCreateInfo::Flag::FreeDescriptorSet are not allowed", );
+
+    _frames = Containers::Array<Frame>{ValueInit, frameCount};
+}
+
+DescriptorAllocator::DescriptorAllocator(NoCreateT) noexcept: _device{}, _poolInfo{NoInit}, _frameIndex{} {}
+
+DescriptorAllocator::DescriptorAllocator(DescriptorAllocator&& other) noexcept: _device{other._device}, _poolInfo{std::move(other._poolInfo)}, _frames{std::move(other._frames)}, _frameIndex{other._frameIndex} {
+    other._device = nullptr;
+    other._frameIndex = 0;
+}
+
+DescriptorAllocator::~DescriptorAllocator() = default;
+
+DescriptorAllocator& DescriptorAllocator::operator=(DescriptorAllocator&& other) noexcept {
+    using std::swap;
+    swap(other._device, _device);
+    swap(other._poolInfo, _poolInfo);
+    swap(other._frames, _frames);
+    swap(other._frameIndex, _frameIndex);
+    return *this;
+}
+
+UnsignedInt DescriptorAllocator::frameCount() const {
+    return _frames.size();
+}
+
+std::size_t DescriptorAllocator::poolCount(const UnsignedInt frameIndex) const {
+    CORRADE_ASSERT(frameIndex < _frames.size(),
+        "Vk::DescriptorAllocator::poolCount(): index" << frameIndex << "out of range for" << _frames.size() << "frames", {});
+    return _frames[frameIndex].pools.size();
+}
+
+void DescriptorAllocator::beginFrame(const UnsignedInt frameIndex) {
+    CORRADE_ASSERT(frameIndex < _frames.size(),
+        "Vk::DescriptorAllocator::beginFrame(): index" << frameIndex << "out of range for" << _frames.size() << "frames", );
+
+    /* Reset only pools that were actually allocated from, the rest is empty
+       already */
+    Frame& frame = _frames[frameIndex];
+    for(std::size_t i = 0, end = Math::min(frame.current + 1, frame.pools.size()); i != end; ++i)
+        frame.pools[i].reset();
+    frame.current = 0;
+    _frameIndex = frameIndex;
+}
+
+DescriptorPool& DescriptorAllocator::currentPool(bool& created) {
+    Frame& frame = _frames[_frameIndex];
+    created = frame.current == frame.pools.size();
+    if(created) arrayAppend(frame.pools, InPlaceInit, *_device, _poolInfo);
+    return frame.pools[frame.current];
+}
+
+DescriptorSet DescriptorAllocator::allocate(const VkDescriptorSetLayout layout) {
+    CORRADE_ASSERT(_device,
+        "Vk::DescriptorAllocator::allocate(): the allocator is not created", DescriptorSet{NoCreate});
+
+    for(;;) {
+        bool created;
+        if(Containers::Optional<DescriptorSet> set = currentPool(created).tryAllocate(layout))
+            return std::move(*set);
+
+        CORRADE_ASSERT(!created,
+            "Vk::DescriptorAllocator::allocate(): layout doesn't fit into an empty pool", DescriptorSet{NoCreate});
+        ++_frames[_frameIndex].current;
+    }
+}
+
+DescriptorSet DescriptorAllocator::allocate(const VkDescriptorSetLayout layout, const UnsignedInt variableDescriptorCount) {
+    CORRADE_ASSERT(_device,
+        "Vk::DescriptorAllocator::allocate(): the allocator is not created", DescriptorSet{NoCreate});
+
+    for(;;) {
+        bool created;
+        if(Containers::Optional<DescriptorSet> set = currentPool(created).tryAllocate(layout, variableDescriptorCount))
+            return std::move(*set);
+
+        CORRADE_ASSERT(!created,
+            "Vk::DescriptorAllocator::allocate(): layout doesn't fit into an empty pool", DescriptorSet{NoCreate});
+        ++_frames[_frameIndex].current;
+    }
+}
+
+}}
@@ -0,0 +1,200 @@
+#ifndef Magnum_Vk_DescriptorAllocator_h
+#define Magnum_Vk_DescriptorAllocator_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+/** @file
+ * @brief Class @ref Magnum::Vk::DescriptorAllocator
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Tags.h"
+#include "Magnum/Vk/DescriptorPoolCreateInfo.h"
+#include "Magnum/Vk/Vk.h"
+#include "Magnum/Vk/Vulkan.h"
+#include "Magnum/Vk/visibility.h"
+
+namespace Magnum { namespace Vk {
+
+/**
+@brief Per-frame descriptor set allocator
+@m_since_latest
+
+Allocates descriptor sets that are used only for a single frame from a set of
+@ref DescriptorPool instances dedicated to each frame in flight. If the
+current pool gets exhausted, allocation continues from the next pool, creating
+a new one if there's none left. Instead of freeing individual sets, all pools
+of a frame get reset at once when the frame begins again, making them
+available for the next allocations. After the first few frames the pool count
+stabilizes and the allocator no longer creates any new pools, with the
+steady-state cost being just a @fn_vk{AllocateDescriptorSets} call for each
+set and a @fn_vk{ResetDescriptorPool} call for each pool every frame.
+
+@section Vk-DescriptorAllocator-creation Allocator creation
+
+The allocator takes a @ref DescriptorPoolCreateInfo describing a single pool,
+which is then used for creating all pools, and a count of frames in flight.
+The pool should be large enough to fit descriptor sets of all layouts used by
+the application, as allocation of a set that doesn't fit into an empty pool
+fails:
+
+@snippet MagnumVk.cpp DescriptorAllocator-creation
+
+Because the descriptor sets are freed only in bulk, the
+@ref DescriptorPoolCreateInfo::Flag::FreeDescriptorSet flag is not allowed.
+Allocation relies on @ref Result::ErrorOutOfPoolMemory being returned by the
+driver when a pool gets exhausted, which is guaranteed only on Vulkan 1.1 or
+with @vk_extension{KHR,maintenance1} enabled. See
+@ref DescriptorPool::tryAllocate() for details.
+
+@section Vk-DescriptorAllocator-usage Usage
+
+Each frame starts with @ref beginFrame(), which resets all pools used by the
+frame with the same index. It's the responsibility of the application to
+ensure that the GPU is done with the sets allocated for that frame, which is
+conveniently handled by the @ref FramePacer. Sets allocated using
+@ref allocate() are then valid until the next @ref beginFrame() call with the
+same index:
+
+@snippet MagnumVk.cpp DescriptorAllocator-usage
+*/
+class MAGNUM_VK_EXPORT DescriptorAllocator {
+    public:
+        /**
+         * @brief Constructor
+         * @param device        Vulkan device
+         * @param poolInfo      Creation info used for each
+         *      @ref DescriptorPool
+         * @param frameCount    Count of frames in flight
+         *
+         * Expects that @p frameCount is non-zero and that @p poolInfo
+         * doesn't have @ref DescriptorPoolCreateInfo::Flag::FreeDescriptorSet
+         * set. No pools are created upfront, they're created on-demand
+         * during the first @ref allocate() calls. The current frame index is
+         * @cpp 0 @ce.
+         */
+        explicit DescriptorAllocator(Device& device, DescriptorPoolCreateInfo&& poolInfo, UnsignedInt frameCount = 2);
+
+        /**
+         * @brief Construct without creating the allocator
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit DescriptorAllocator(NoCreateT) noexcept;
+
+        /** @brief Copying is not allowed */
+        DescriptorAllocator(const DescriptorAllocator&) = delete;
+
+        /** @brief Move constructor */
+        DescriptorAllocator(DescriptorAllocator&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Destroys all pools, which frees all allocated descriptor sets.
+         */
+        ~DescriptorAllocator();
+
+        /** @brief Copying is not allowed */
+        DescriptorAllocator& operator=(const DescriptorAllocator&) = delete;
+
+        /** @brief Move assignment */
+        DescriptorAllocator& operator=(DescriptorAllocator&& other) noexcept;
+
+        /** @brief Count of frames in flight */
+        UnsignedInt frameCount() const;
+
+        /**
+         * @brief Current frame index
+         *
+         * Initially @cpp 0 @ce, changed with @ref beginFrame().
+         */
+        UnsignedInt frameIndex() const { return _frameIndex; }
+
+        /**
+         * @brief Count of pools created for given frame
+         *
+         * Expects that @p frameIndex is less than @ref frameCount().
+         */
+        std::size_t poolCount(UnsignedInt frameIndex) const;
+
+        /**
+         * @brief Begin a frame
+         *
+         * Resets all pools used by a frame with index @p frameIndex and makes
+         * it the current frame. All descriptor sets previously allocated for
+         * the frame become invalid. Expects that @p frameIndex is less than
+         * @ref frameCount() and that the GPU is no longer using the sets.
+         * @see @ref FramePacer::beginFrame(), @ref DescriptorPool::reset()
+         */
+        void beginFrame(UnsignedInt frameIndex);
+
+        /**
+         * @brief Allocate a descriptor set for the current frame
+         *
+         * Allocates from the first pool of the current frame that isn't
+         * exhausted yet, creating a new pool if all are. Expects that
+         * @p layout fits into an empty pool. The returned set doesn't free
+         * itself on destruction and is valid until the next
+         * @ref beginFrame() call with the same frame index.
+         * @see @ref DescriptorPool::tryAllocate(VkDescriptorSetLayout)
+         */
+        DescriptorSet allocate(VkDescriptorSetLayout layout);
+
+        /**
+         * @brief Allocate a descriptor set with a variable descriptor count for the current frame
+         *
+         * Compared to @ref allocate(VkDescriptorSetLayout), the
+         * @p variableDescriptorCount is used for a binding that was created
+         * with @ref DescriptorSetLayoutBinding::Flag::VariableDescriptorCount.
+         * @see @ref DescriptorPool::tryAllocate(VkDescriptorSetLayout, UnsignedInt)
+         * @requires_vk_feature @ref DeviceFeature::DescriptorBindingVariableDescriptorCount
+         */
+        DescriptorSet allocate(VkDescriptorSetLayout layout, UnsignedInt variableDescriptorCount);
+
+    private:
+        struct Frame;
+
+        /* Returns the pool to allocate from in the current frame, creating
+           it if there's none left. The created flag is set if the pool was
+           created in this call, thus allocation failing on it means the set
+           doesn't fit even into an empty pool. */
+        MAGNUM_VK_LOCAL DescriptorPool& currentPool(bool& created);
+
+        /* Can't be a reference because of the NoCreate constructor */
+        Device* _device;
+
+        DescriptorPoolCreateInfo _poolInfo;
+        Containers::Array<Frame> _frames;
+        UnsignedInt _frameIndex;
+};
+
+}}
+
+#endif
@@ -438,7 +438,9 @@ DeviceCreateInfo& DeviceCreateInfo::setEnabledFeatures(const DeviceFeatures& fea
             _state->features.robustness2,
             _state->features.imageRobustness,
             _state->features.rayTracingPipeline,
-            _state->features.rayQuery
+            _state->features.rayQuery,
+            _state->features.dynamicRendering,
+            _state->features.synchronization2
         });
 
         _state->firstEnabledFeature = {};
@@ -566,6 +568,10 @@ DeviceCreateInfo& DeviceCreateInfo::setEnabledFeatures(const DeviceFeatures& fea
         _state->features.rayTracingPipeline, VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_RAY_TRACING_PIPELINE_FEATURES_KHR);
     structureConnectIfUsed(next, _state->firstEnabledFeature,
         _state->features.rayQuery, VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_RAY_QUERY_FEATURES_KHR);
+    structureConnectIfUsed(next, _state->firstEnabledFeature,
+        _state->features.dynamicRendering, VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR);
+    structureConnectIfUsed(next, _state->firstEnabledFeature,
+        _state->features.synchronization2, VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES_KHR);
 
     return *this;
 }
@@ -291,6 +291,10 @@ class MAGNUM_VK_EXPORT DeviceCreateInfo {
          *      (@vk_extension{KHR,ray_tracing_pipeline})
          * -    @type_vk_keyword{PhysicalDeviceRayQueryFeaturesKHR}
          *      (@vk_extension{KHR,ray_query})
+         * -    @type_vk_keyword{PhysicalDeviceDynamicRenderingFeaturesKHR}
+         *      (@vk_extension{KHR,dynamic_rendering})
+         * -    @type_vk_keyword{PhysicalDeviceSynchronization2FeaturesKHR}
+         *      (@vk_extension{KHR,synchronization2})
          */
         DeviceCreateInfo& setEnabledFeatures(const DeviceFeatures& features) &;
         /** @overload */
@@ -1401,7 +1401,26 @@ enum class DeviceFeature: UnsignedShort {
      * Whether ray query functionality is supported.
      * @requires_vk_extension Extension @vk_extension{KHR,ray_query}
      */
-    RayQuery
+    RayQuery,
+
+    /* VkPhysicalDeviceDynamicRenderingFeaturesKHR, #45 */
+
+    /**
+     * Whether rendering without a @ref RenderPass and a @ref Framebuffer using
+     * @ref CommandBuffer::beginRendering() is supported.
+     * @requires_vk_extension Extension @vk_extension{KHR,dynamic_rendering}
+     */
+    DynamicRendering,
+
+    /* VkPhysicalDeviceSynchronization2FeaturesKHR, #315 */
+
+    /**
+     * Whether the @ref CommandBuffer::pipelineBarrier(const DependencyInfo&)
+     * can use the @fn_vk{CmdPipelineBarrier2KHR} command with per-barrier
+     * stage masks.
+     * @requires_vk_extension Extension @vk_extension{KHR,synchronization2}
+     */
+    Synchronization2
 };
 
 /**
@@ -347,6 +347,10 @@ const DeviceFeatures& DeviceProperties::features() {
             Implementation::structureConnect(next, features.rayTracingPipeline, VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_RAY_TRACING_PIPELINE_FEATURES_KHR);
         if(isOrVersionSupportedInternal<Extensions::KHR::ray_query>())
             Implementation::structureConnect(next, features.rayQuery, VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_RAY_QUERY_FEATURES_KHR);
+        if(isOrVersionSupportedInternal<Extensions::KHR::dynamic_rendering>())
+            Implementation::structureConnect(next, features.dynamicRendering, VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR);
+        if(isOrVersionSupportedInternal<Extensions::KHR::synchronization2>())
+            Implementation::structureConnect(next, features.synchronization2, VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES_KHR);
 
         _state->getFeaturesImplementation(*this, features2);
 
@@ -504,6 +504,12 @@ class MAGNUM_VK_EXPORT DeviceProperties {
          * -    If the @vk_extension{KHR,ray_query} extension is supported by
          *      the device, the `pNext` chain contains
          *      @type_vk_keyword{PhysicalDeviceRayQueryFeaturesKHR}
+         * -    If the @vk_extension{KHR,dynamic_rendering} extension is
+         *      supported by the device, the `pNext` chain contains
+         *      @type_vk_keyword{PhysicalDeviceDynamicRenderingFeaturesKHR}
+         * -    If the @vk_extension{KHR,synchronization2} extension is
+         *      supported by the device, the `pNext` chain contains
+         *      @type_vk_keyword{PhysicalDeviceSynchronization2FeaturesKHR}
          *
          * If the @vk_extension{KHR,portability_subset} is *not* supported by
          * the device, all features related to it are implicitly marked as
@@ -38,6 +38,7 @@ constexpr InstanceExtension InstanceExtensions[] {
     Extensions::EXT::debug_report{},
     Extensions::EXT::debug_utils{},
     Extensions::EXT::validation_features{},
+    Extensions::KHR::surface{},
 };
 constexpr InstanceExtension InstanceExtensions11[] {
     Extensions::KHR::device_group_creation{},
@@ -78,10 +79,13 @@ constexpr Extension DeviceExtensions[] {
     Extensions::KHR::acceleration_structure{},
     Extensions::KHR::copy_commands2{},
     Extensions::KHR::deferred_host_operations{},
+    Extensions::KHR::dynamic_rendering{},
     Extensions::KHR::pipeline_library{},
     Extensions::KHR::portability_subset{},
     Extensions::KHR::ray_query{},
     Extensions::KHR::ray_tracing_pipeline{},
+    Extensions::KHR::swapchain{},
+    Extensions::KHR::synchronization2{},
 };
 constexpr Extension DeviceExtensions11[] {
     Extensions::KHR::_16bit_storage{},
@@ -95,6 +95,7 @@ namespace EXT {
     _extension(12, KHR,external_memory_capabilities,        Vk10, Vk11) // #72
     _extension(13, KHR,external_semaphore_capabilities,     Vk10, Vk11) // #77
     _extension(14, KHR,external_fence_capabilities,         Vk10, Vk11) // #113
+    _extension(15, KHR,surface,                             Vk10, None) // #1
 }
 #undef _extension
 
@@ -172,6 +173,9 @@ namespace EXT {
     _extension(70, KHR,copy_commands2,                      Vk10, None) // #338
     _extension(71, KHR,ray_tracing_pipeline,                Vk11, None) // #348
     _extension(72, KHR,ray_query,                           Vk11, None) // #349
+    _extension(73, KHR,dynamic_rendering,                   Vk10, None) // #45
+    _extension(74, KHR,synchronization2,                    Vk10, None) // #315
+    _extension(75, KHR,swapchain,                           Vk10, None) // #2
 }
 #undef _extension
 #undef _extension_
@@ -0,0 +1,79 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FramePacer.h"
+
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Vk/SemaphoreCreateInfo.h"
+
+namespace Magnum { namespace Vk {
+
+FramePacer::FramePacer(Device& device, const UnsignedInt framesInFlight): _semaphore{NoCreate}, _frame{}, _framesInFlight{framesInFlight} {
+    CORRADE_ASSERT(framesInFlight,
+        "Vk::FramePacer: expected non-zero frames in flight", );
+    _semaphore = Semaphore{device, SemaphoreCreateInfo{SemaphoreType::Timeline, 0}};
+}
+
+FramePacer::FramePacer(NoCreateT) noexcept: _semaphore{NoCreate}, _frame{}, _framesInFlight{} {}
+
+FramePacer::FramePacer(FramePacer&& other) noexcept: _semaphore{std::move(other._semaphore)}, _frame{other._frame}, _framesInFlight{other._framesInFlight} {
+    other._frame = 0;
+    other._framesInFlight = 0;
+}
+
+FramePacer::~FramePacer() = default;
+
+FramePacer& FramePacer::operator=(FramePacer&& other) noexcept {
+    using std::swap;
+    swap(other._semaphore, _semaphore);
+    swap(other._frame, _frame);
+    swap(other._framesInFlight, _framesInFlight);
+    return *this;
+}
+
+UnsignedInt FramePacer::frameIndex() const {
+    CORRADE_ASSERT(_frame,
+        "Vk::FramePacer::frameIndex(): no frame begun yet", {});
+    return (_frame - 1) % _framesInFlight;
+}
+
+UnsignedInt FramePacer::beginFrame() {
+    ++_frame;
+
+    /* The first few frames have nothing to wait for. Otherwise wait for the
+       frame that used the same per-frame resources, which is also enough to
+       ensure that there's at most framesInFlight frames in flight. */
+    if(_frame > _framesInFlight)
+        _semaphore.wait(_frame - _framesInFlight);
+
+    return (_frame - 1) % _framesInFlight;
+}
+
+void FramePacer::wait() {
+    if(_frame) _semaphore.wait(_frame);
+}
+
+}}
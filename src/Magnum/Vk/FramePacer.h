@@ -0,0 +1,160 @@
+#ifndef Magnum_Vk_FramePacer_h
+#define Magnum_Vk_FramePacer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Vk::FramePacer
+ * @m_since_latest
+ */
+
+#include "Magnum/Vk/Semaphore.h"
+
+namespace Magnum { namespace Vk {
+
+/**
+@brief Frame pacer
+@m_since_latest
+
+Keeps a fixed count of frames in flight using a single
+@ref SemaphoreType::Timeline @ref Semaphore instead of a @ref Fence for each
+frame. Every frame gets a serial number, which the last queue submission of
+the frame signals on the semaphore. At the beginning of a frame the pacer then
+waits only until the frame that used the same per-frame resources finishes,
+without having to create, reset and wait on a fence for each frame.
+
+@section Vk-FramePacer-usage Usage
+
+The pacer is created on a device with @ref DeviceFeature::TimelineSemaphore
+enabled and a count of frames in flight. Each frame starts with
+@ref beginFrame(), which returns an index that can be used to pick per-frame
+resources such as command buffers or uniform buffers. The last submission of
+the frame then signals @ref semaphore() with the value of @ref frame():
+
+@snippet MagnumVk.cpp FramePacer-usage
+
+Before destroying resources used by the frames, call @ref wait() to ensure
+the GPU is done with all of them.
+*/
+class MAGNUM_VK_EXPORT FramePacer {
+    public:
+        /**
+         * @brief Constructor
+         * @param device            Vulkan device
+         * @param framesInFlight    Max count of frames in flight
+         *
+         * Creates a @ref SemaphoreType::Timeline semaphore with an initial
+         * value of @cpp 0 @ce. Expects that @p framesInFlight is non-zero.
+         */
+        explicit FramePacer(Device& device, UnsignedInt framesInFlight = 2);
+
+        /**
+         * @brief Construct without creating the pacer
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit FramePacer(NoCreateT) noexcept;
+
+        /** @brief Copying is not allowed */
+        FramePacer(const FramePacer&) = delete;
+
+        /** @brief Move constructor */
+        FramePacer(FramePacer&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Destroys the semaphore. Doesn't wait for the frames in flight, as
+         * it can't know whether the current frame was submitted. Call
+         * @ref wait() before if needed.
+         */
+        ~FramePacer();
+
+        /** @brief Copying is not allowed */
+        FramePacer& operator=(const FramePacer&) = delete;
+
+        /** @brief Move assignment */
+        FramePacer& operator=(FramePacer&& other) noexcept;
+
+        /** @brief Max count of frames in flight */
+        UnsignedInt framesInFlight() const { return _framesInFlight; }
+
+        /**
+         * @brief Timeline semaphore
+         *
+         * The last submission of each frame is expected to signal it with
+         * the value of @ref frame().
+         */
+        Semaphore& semaphore() { return _semaphore; }
+
+        /**
+         * @brief Current frame serial number
+         *
+         * Initially @cpp 0 @ce, incremented with every @ref beginFrame().
+         */
+        UnsignedLong frame() const { return _frame; }
+
+        /**
+         * @brief Current frame index
+         *
+         * Index of per-frame resources for the current frame, in range
+         * @cpp [0, framesInFlight()) @ce. Expects that @ref beginFrame() was
+         * called at least once.
+         */
+        UnsignedInt frameIndex() const;
+
+        /**
+         * @brief Begin a new frame
+         * @return Index of per-frame resources for the new frame
+         *
+         * Increments @ref frame() and waits until the semaphore reaches the
+         * value of the frame that was @ref framesInFlight() frames before,
+         * i.e. the last frame that used the same per-frame resources. Returns
+         * immediately for the first @ref framesInFlight() frames. The
+         * previous frame is expected to have its signal already submitted.
+         * @see @ref frameIndex(), @ref Semaphore::wait()
+         */
+        UnsignedInt beginFrame();
+
+        /**
+         * @brief Wait for all frames to finish
+         *
+         * Waits until the semaphore reaches the value of @ref frame(). The
+         * current frame is expected to have its signal already submitted.
+         * @see @ref Semaphore::wait()
+         */
+        void wait();
+
+    private:
+        Semaphore _semaphore;
+        UnsignedLong _frame;
+        UnsignedInt _framesInFlight;
+};
+
+}}
+
+#endif
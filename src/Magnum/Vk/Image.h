@@ -35,6 +35,7 @@
 
 #include "Magnum/Magnum.h"
 #include "Magnum/Vk/Memory.h"
+#include "Magnum/Vk/MemoryAllocator.h"
 #include "Magnum/Vk/Vk.h"
 #include "Magnum/Vk/Vulkan.h"
 #include "Magnum/Vk/visibility.h"
@@ -163,6 +164,13 @@ enum class ImageLayout: Int {
      */
     TransferDestination = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
 
+    /**
+     * Layout for presenting a swapchain image. Images have to be
+     * transitioned to it before passing them to @ref Swapchain::present().
+     * @requires_vk_extension Extension @vk_extension{KHR,swapchain}
+     */
+    PresentSource = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+
     /** @todo remaining ones from @vk_extension{KHR,maintenance2} (1.1),
         @vk_extension{KHR,separate_depth_stencil_layouts} (1.2) */
 };
@@ -260,6 +268,18 @@ available through @ref dedicatedMemory(). This matches current behavior of the
 above, except that you have more control over choosing and allocating the
 memory.
 
+@subsection Vk-Image-creation-allocator Allocating from a memory allocator
+
+Creating a dedicated allocation for every image is slow and the count of
+allocations is limited. Passing a @ref MemoryAllocator to the
+@ref Image(Device&, const ImageCreateInfo&, MemoryAllocator&, MemoryFlags) constructor
+sub-allocates the memory from a larger block instead, the allocation is
+subsequently available through @ref allocatedMemory(). Alternatively, an
+allocation made with @ref MemoryAllocator::allocate() can be bound using
+@ref bindAllocatedMemory().
+
+@snippet MagnumVk.cpp Image-creation-allocator
+
 @section Vk-Image-usage Image usage
 
 @subsection Vk-Image-usage-clear Clearing image data
@@ -375,6 +395,22 @@ class MAGNUM_VK_EXPORT Image {
          */
         explicit Image(Device& device, const ImageCreateInfo& info, MemoryFlags memoryFlags);
 
+        /**
+         * @brief Construct a image with memory from an allocator
+         * @param device        Vulkan device to create the image on
+         * @param info          Image creation info
+         * @param allocator     Memory allocator
+         * @param memoryFlags   Memory allocation flags
+         * @m_since_latest
+         *
+         * Compared to @ref Image(Device&, const ImageCreateInfo&, MemoryFlags) the
+         * memory is allocated using
+         * @ref MemoryAllocator::allocate(const MemoryRequirements&, MemoryFlags, MemoryFlags)
+         * and is subsequently accessible through @ref allocatedMemory(). The
+         * allocator is expected to outlive the image.
+         */
+        explicit Image(Device& device, const ImageCreateInfo& info, MemoryAllocator& allocator, MemoryFlags memoryFlags);
+
         /**
          * @brief Construct without creating the image
          *
@@ -462,6 +498,37 @@ class MAGNUM_VK_EXPORT Image {
          */
         Memory& dedicatedMemory();
 
+        /**
+         * @brief Bind memory from an allocator
+         * @m_since_latest
+         *
+         * Equivalent to @ref bindMemory() with @ref MemoryAllocation::memory()
+         * and @ref MemoryAllocation::offset(), with the additional effect
+         * that @p allocation ownership transfers to the image and is then
+         * available through @ref allocatedMemory(). The allocation is
+         * returned back to the allocator when the image is destroyed.
+         */
+        void bindAllocatedMemory(MemoryAllocation&& allocation);
+
+        /**
+         * @brief Whether the image has memory from an allocator
+         * @m_since_latest
+         *
+         * Returns @cpp true @ce if the image memory was bound using
+         * @ref bindAllocatedMemory(), @cpp false @ce otherwise.
+         * @see @ref allocatedMemory()
+         */
+        bool hasAllocatedMemory() const;
+
+        /**
+         * @brief Memory allocation of the image
+         * @m_since_latest
+         *
+         * Expects that the image has memory from an allocator.
+         * @see @ref hasAllocatedMemory()
+         */
+        MemoryAllocation& allocatedMemory();
+
         /**
          * @brief Release the underlying Vulkan image
          *
@@ -502,6 +569,7 @@ class MAGNUM_VK_EXPORT Image {
         PixelFormat _format;
 
         Memory _dedicatedMemory;
+        MemoryAllocation _allocatedMemory;
 };
 
 /**
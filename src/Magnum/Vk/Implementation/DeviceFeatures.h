@@ -65,6 +65,8 @@ struct DeviceFeatures {
     VkPhysicalDeviceImageRobustnessFeaturesEXT imageRobustness;
     VkPhysicalDeviceRayTracingPipelineFeaturesKHR rayTracingPipeline;
     VkPhysicalDeviceRayQueryFeaturesKHR rayQuery;
+    VkPhysicalDeviceDynamicRenderingFeaturesKHR dynamicRendering;
+    VkPhysicalDeviceSynchronization2FeaturesKHR synchronization2;
 };
 
 constexpr Vk::DeviceFeatures deviceFeaturesPortabilitySubset() {
@@ -28,10 +28,12 @@
 #include "Magnum/Vk/Buffer.h"
 #include "Magnum/Vk/CommandBuffer.h"
 #include "Magnum/Vk/Device.h"
+#include "Magnum/Vk/DeviceFeatures.h"
 #include "Magnum/Vk/DeviceProperties.h"
 #include "Magnum/Vk/Extensions.h"
 #include "Magnum/Vk/Image.h"
 #include "Magnum/Vk/RenderPass.h"
+#include "Magnum/Vk/Semaphore.h"
 #include "Magnum/Vk/Shader.h"
 #include "Magnum/Vk/Version.h"
 #include "Magnum/Vk/Implementation/DriverWorkaround.h"
@@ -89,12 +91,56 @@ DeviceState::DeviceState(Device& device, Containers::Array<std::pair<Containers:
         cmdEndRenderPassImplementation = &CommandBuffer::endRenderPassImplementationDefault;
     }
 
+    /* Unlike most other extensions, the dynamic rendering and synchronization2
+       entrypoints are usable only if the corresponding feature is enabled */
+    if(device.enabledFeatures() & DeviceFeature::DynamicRendering) {
+        cmdBeginRenderingImplementation = &CommandBuffer::beginRenderingImplementationKHR;
+        cmdEndRenderingImplementation = &CommandBuffer::endRenderingImplementationKHR;
+    } else {
+        cmdBeginRenderingImplementation = &CommandBuffer::beginRenderingImplementationDefault;
+        cmdEndRenderingImplementation = &CommandBuffer::endRenderingImplementationDefault;
+    }
+
+    if(device.enabledFeatures() & DeviceFeature::Synchronization2) {
+        cmdPipelineBarrier2Implementation = &CommandBuffer::pipelineBarrier2ImplementationKHR;
+    } else {
+        cmdPipelineBarrier2Implementation = &CommandBuffer::pipelineBarrier2ImplementationDefault;
+    }
+
+    if(device.isVersionSupported(Version::Vk12)) {
+        getSemaphoreValueImplementation = &Semaphore::getValueImplementation12;
+        signalSemaphoreImplementation = &Semaphore::signalImplementation12;
+        waitSemaphoresImplementation = &Semaphore::waitImplementation12;
+    } else if(device.isExtensionEnabled<Extensions::KHR::timeline_semaphore>()) {
+        getSemaphoreValueImplementation = &Semaphore::getValueImplementationKHR;
+        signalSemaphoreImplementation = &Semaphore::signalImplementationKHR;
+        waitSemaphoresImplementation = &Semaphore::waitImplementationKHR;
+    } else {
+        getSemaphoreValueImplementation = &Semaphore::getValueImplementationDefault;
+        signalSemaphoreImplementation = &Semaphore::signalImplementationDefault;
+        waitSemaphoresImplementation = &Semaphore::waitImplementationDefault;
+    }
+
     if(device.isExtensionEnabled<Extensions::EXT::extended_dynamic_state>()) {
         cmdBindVertexBuffersImplementation = &CommandBuffer::bindVertexBuffersImplementationEXT;
     } else {
         cmdBindVertexBuffersImplementation = &CommandBuffer::bindVertexBuffersImplementationDefault;
     }
 
+    /* Unlike with other promoted extensions, the core 1.2 entrypoints need
+       the drawIndirectCount feature to be enabled while the extension ones
+       don't, so prefer the extension if it's enabled */
+    if(device.isExtensionEnabled<Extensions::KHR::draw_indirect_count>()) {
+        cmdDrawIndirectCountImplementation = &CommandBuffer::drawIndirectCountImplementationKHR;
+        cmdDrawIndexedIndirectCountImplementation = &CommandBuffer::drawIndexedIndirectCountImplementationKHR;
+    } else if(device.isVersionSupported(Version::Vk12)) {
+        cmdDrawIndirectCountImplementation = &CommandBuffer::drawIndirectCountImplementation12;
+        cmdDrawIndexedIndirectCountImplementation = &CommandBuffer::drawIndexedIndirectCountImplementation12;
+    } else {
+        cmdDrawIndirectCountImplementation = &CommandBuffer::drawIndirectCountImplementationDefault;
+        cmdDrawIndexedIndirectCountImplementation = &CommandBuffer::drawIndexedIndirectCountImplementationDefault;
+    }
+
     if(device.isExtensionEnabled<Extensions::KHR::copy_commands2>()) {
         cmdCopyBufferImplementation = &CommandBuffer::copyBufferImplementationKHR;
         cmdCopyImageImplementation = &CommandBuffer::copyImageImplementationKHR;
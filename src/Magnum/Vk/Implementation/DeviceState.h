@@ -55,10 +55,20 @@ struct DeviceState {
     void(*cmdBeginRenderPassImplementation)(CommandBuffer&, const VkRenderPassBeginInfo&, const VkSubpassBeginInfo&);
     void(*cmdNextSubpassImplementation)(CommandBuffer&, const VkSubpassEndInfo&, const VkSubpassBeginInfo&);
     void(*cmdEndRenderPassImplementation)(CommandBuffer&, const VkSubpassEndInfo&);
+    void(*cmdBeginRenderingImplementation)(CommandBuffer&, const VkRenderingInfoKHR&);
+    void(*cmdEndRenderingImplementation)(CommandBuffer&);
+
+    void(*cmdPipelineBarrier2Implementation)(CommandBuffer&, const VkDependencyInfoKHR&);
 
     VkResult(*createShaderImplementation)(Device&, const VkShaderModuleCreateInfo&, const VkAllocationCallbacks*, VkShaderModule&);
 
+    VkResult(*getSemaphoreValueImplementation)(Device&, VkSemaphore, UnsignedLong*);
+    VkResult(*signalSemaphoreImplementation)(Device&, const VkSemaphoreSignalInfo&);
+    VkResult(*waitSemaphoresImplementation)(Device&, const VkSemaphoreWaitInfo&, UnsignedLong);
+
     void(*cmdBindVertexBuffersImplementation)(CommandBuffer&, UnsignedInt, UnsignedInt, const VkBuffer*, const UnsignedLong*, const UnsignedLong*);
+    void(*cmdDrawIndirectCountImplementation)(CommandBuffer&, VkBuffer, UnsignedLong, VkBuffer, UnsignedLong, UnsignedInt, UnsignedInt);
+    void(*cmdDrawIndexedIndirectCountImplementation)(CommandBuffer&, VkBuffer, UnsignedLong, VkBuffer, UnsignedLong, UnsignedInt, UnsignedInt);
 
     void(*cmdCopyBufferImplementation)(CommandBuffer&, const CopyBufferInfo&);
     void(*cmdCopyImageImplementation)(CommandBuffer&, const CopyImageInfo&);
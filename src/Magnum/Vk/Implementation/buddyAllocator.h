@@ -0,0 +1,129 @@
+#ifndef Magnum_Vk_Implementation_buddyAllocator_h
+#define Magnum_Vk_Implementation_buddyAllocator_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum { namespace Vk { namespace Implementation {
+
+/* Buddy sub-allocator of a single memory block, used by MemoryAllocator.
+   Operates only on offsets and doesn't touch any Vulkan state, so it's
+   testable without a device. Every node is aligned to its own size, which
+   means power-of-two alignment requirements up to the node size are
+   satisfied implicitly. */
+class BuddyAllocator {
+    public:
+        /* Both expected to be powers of two, size >= minNodeSize */
+        explicit BuddyAllocator(UnsignedLong size, UnsignedLong minNodeSize): _minNodeSize{minNodeSize}, _usedSize{} {
+            CORRADE_INTERNAL_ASSERT(minNodeSize && !(minNodeSize & (minNodeSize - 1)));
+            CORRADE_INTERNAL_ASSERT(size >= minNodeSize && !(size & (size - 1)));
+            _orderCount = 1;
+            while((minNodeSize << (_orderCount - 1)) != size) ++_orderCount;
+            _freeLists = Containers::Array<Containers::Array<UnsignedLong>>{_orderCount};
+            arrayAppend(_freeLists[_orderCount - 1], UnsignedLong{});
+        }
+
+        UnsignedLong size() const { return _minNodeSize << (_orderCount - 1); }
+        UnsignedLong minNodeSize() const { return _minNodeSize; }
+        UnsignedLong usedSize() const { return _usedSize; }
+        bool isEmpty() const { return !_usedSize; }
+
+        /* Returns an offset of a free node of given size, which is expected
+           to be a power of two between minNodeSize() and size(), or ~0 if there's no
+           free node large enough */
+        UnsignedLong allocate(const UnsignedLong nodeSize) {
+            const UnsignedInt order = orderFor(nodeSize);
+
+            /* Find the smallest free node that's big enough */
+            UnsignedInt found = order;
+            while(found != _orderCount && _freeLists[found].isEmpty()) ++found;
+            if(found == _orderCount) return ~UnsignedLong{};
+
+            const UnsignedLong offset = _freeLists[found].back();
+            arrayRemoveSuffix(_freeLists[found], 1);
+
+            /* Split it until it's of the requested size, putting the upper
+               halves to the free lists */
+            while(found != order) {
+                --found;
+                arrayAppend(_freeLists[found], offset + (_minNodeSize << found));
+            }
+
+            _usedSize += nodeSize;
+            return offset;
+        }
+
+        /* Frees a node previously returned from allocate(), merging it with
+           its buddies as long as they're free */
+        void free(UnsignedLong offset, const UnsignedLong nodeSize) {
+            UnsignedInt order = orderFor(nodeSize);
+            _usedSize -= nodeSize;
+
+            for(; order + 1 < _orderCount; ++order) {
+                const UnsignedLong buddy = offset ^ (_minNodeSize << order);
+                Containers::Array<UnsignedLong>& freeList = _freeLists[order];
+                std::size_t i = 0;
+                while(i != freeList.size() && freeList[i] != buddy) ++i;
+                if(i == freeList.size()) break;
+
+                freeList[i] = freeList.back();
+                arrayRemoveSuffix(freeList, 1);
+                offset = Math::min(offset, buddy);
+            }
+
+            arrayAppend(_freeLists[order], offset);
+        }
+
+        /* Size of the largest free node, 0 if the block is full */
+        UnsignedLong largestFreeNodeSize() const {
+            for(UnsignedInt order = _orderCount; order != 0; --order)
+                if(!_freeLists[order - 1].isEmpty())
+                    return _minNodeSize << (order - 1);
+            return 0;
+        }
+
+    private:
+        UnsignedInt orderFor(const UnsignedLong nodeSize) const {
+            UnsignedInt order = 0;
+            while((_minNodeSize << order) < nodeSize) ++order;
+            CORRADE_INTERNAL_ASSERT(order < _orderCount && (_minNodeSize << order) == nodeSize);
+            return order;
+        }
+
+        UnsignedLong _minNodeSize, _usedSize;
+        UnsignedInt _orderCount;
+        /* Offsets of free nodes for each order, order 0 being nodes of
+           _minNodeSize */
+        Containers::Array<Containers::Array<UnsignedLong>> _freeLists;
+};
+
+}}}
+
+#endif
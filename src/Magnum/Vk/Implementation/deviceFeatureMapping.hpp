@@ -234,4 +234,8 @@ _ce(RayTraversalPrimitiveCulling, rayTraversalPrimitiveCulling)
 #undef _ce
 
 _cext(RayQuery, rayQuery, rayQuery, KHR::ray_query)
+
+_cext(DynamicRendering, dynamicRendering, dynamicRendering, KHR::dynamic_rendering)
+
+_cext(Synchronization2, synchronization2, synchronization2, KHR::synchronization2)
 #endif
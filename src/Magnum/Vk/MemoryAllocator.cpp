@@ -0,0 +1,321 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MemoryAllocator.h"
+
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Vk/Device.h"
+#include "Magnum/Vk/DeviceProperties.h"
+#include "Magnum/Vk/MemoryAllocateInfo.h"
+#include "Magnum/Vk/Implementation/buddyAllocator.h"
+
+namespace Magnum { namespace Vk {
+
+namespace {
+
+struct Block {
+    /* NoCreate if the block was released, the slot is then reused by the next
+       allocated block to keep block indices in live allocations stable */
+    Memory memory;
+    Implementation::BuddyAllocator allocator;
+    UnsignedInt allocationCount;
+};
+
+bool isLive(const Block& block) {
+    /* Sigh. Though better than needing to have `const handle()` overloads
+       returning `const VkDeviceMemory_T*` */
+    return const_cast<Block&>(block).memory.handle();
+}
+
+}
+
+struct MemoryAllocator::State {
+    Device* device;
+    UnsignedLong blockSize, dedicatedThreshold, minAllocationSize;
+    /* Block size for each memory type, clamped to heap size */
+    Containers::Array<UnsignedLong> blockSizes;
+    /* Blocks for each memory type */
+    Containers::Array<Containers::Array<Block>> blocks;
+    UnsignedInt allocationCount{}, dedicatedAllocationCount{};
+    UnsignedLong dedicatedSize{};
+};
+
+MemoryAllocator::MemoryAllocator(Device& device, const UnsignedLong blockSize, const UnsignedLong dedicatedThreshold): _state{InPlaceInit} {
+    CORRADE_ASSERT(blockSize && !(blockSize & (blockSize - 1)),
+        "Vk::MemoryAllocator: expected block size to be a power of two, got" << blockSize, );
+    CORRADE_ASSERT(dedicatedThreshold <= blockSize,
+        "Vk::MemoryAllocator: expected dedicated threshold to not be larger than block size" << blockSize << Debug::nospace << ", got" << dedicatedThreshold, );
+
+    DeviceProperties& properties = device.properties();
+
+    /* Rounding every allocation to at least the buffer-image granularity
+       means there's never a linear and an optimal resource on the same
+       granularity page. The granularity is usually a power of two already but
+       not necessarily, so round it up. */
+    UnsignedLong minAllocationSize = 256;
+    while(minAllocationSize < properties.properties().properties.limits.bufferImageGranularity)
+        minAllocationSize <<= 1;
+
+    _state->device = &device;
+    _state->blockSize = blockSize;
+    _state->dedicatedThreshold = dedicatedThreshold;
+    _state->minAllocationSize = Math::min(minAllocationSize, blockSize);
+    _state->blockSizes = Containers::Array<UnsignedLong>{NoInit, properties.memoryCount()};
+    _state->blocks = Containers::Array<Containers::Array<Block>>{properties.memoryCount()};
+
+    /* Don't let a single block take more than an eighth of the heap, which
+       would be the case for example with the 256 MB host-visible
+       device-local heaps on discrete GPUs */
+    for(UnsignedInt i = 0; i != _state->blockSizes.size(); ++i) {
+        const UnsignedLong heapSize = properties.memoryHeapSize(properties.memoryHeapIndex(i));
+        UnsignedLong size = blockSize;
+        while(size > _state->minAllocationSize && size > heapSize/8)
+            size >>= 1;
+        _state->blockSizes[i] = size;
+    }
+}
+
+MemoryAllocator::MemoryAllocator(NoCreateT) {}
+
+MemoryAllocator::MemoryAllocator(MemoryAllocator&&) noexcept = default;
+
+MemoryAllocator::~MemoryAllocator() {
+    CORRADE_ASSERT(!_state || !_state->allocationCount,
+        "Vk::MemoryAllocator: destroyed with" << _state->allocationCount << "live allocations", );
+}
+
+MemoryAllocator& MemoryAllocator::operator=(MemoryAllocator&&) noexcept = default;
+
+UnsignedLong MemoryAllocator::blockSize() const {
+    return _state ? _state->blockSize : 0;
+}
+
+UnsignedLong MemoryAllocator::dedicatedThreshold() const {
+    return _state ? _state->dedicatedThreshold : 0;
+}
+
+UnsignedLong MemoryAllocator::minAllocationSize() const {
+    return _state ? _state->minAllocationSize : 0;
+}
+
+MemoryAllocation MemoryAllocator::allocate(const MemoryRequirements& requirements, const MemoryFlags requiredFlags, const MemoryFlags preferredFlags) {
+    CORRADE_ASSERT(_state,
+        "Vk::MemoryAllocator::allocate(): the allocator is not created", MemoryAllocation{NoCreate});
+    return allocate(_state->device->properties().pickMemory(requiredFlags, preferredFlags, requirements.memories()), requirements.size(), requirements.alignment());
+}
+
+MemoryAllocation MemoryAllocator::allocate(const UnsignedInt memory, const UnsignedLong size, const UnsignedLong alignment) {
+    CORRADE_ASSERT(_state,
+        "Vk::MemoryAllocator::allocate(): the allocator is not created", MemoryAllocation{NoCreate});
+    CORRADE_ASSERT(memory < _state->blocks.size(),
+        "Vk::MemoryAllocator::allocate(): index" << memory << "out of range for" << _state->blocks.size() << "memory types", MemoryAllocation{NoCreate});
+    CORRADE_ASSERT(alignment && !(alignment & (alignment - 1)),
+        "Vk::MemoryAllocator::allocate(): expected alignment to be a power of two, got" << alignment, MemoryAllocation{NoCreate});
+
+    /* Large allocations would waste too much of a block, give them their own
+       memory. The same if it doesn't fit into a block at all, which can
+       happen if the block size got clamped to a small heap. */
+    if(size >= _state->dedicatedThreshold)
+        return allocateDedicated(memory, size);
+    const UnsignedLong blockSize = _state->blockSizes[memory];
+    const UnsignedLong required = Math::max(size, alignment);
+    UnsignedLong nodeSize = _state->minAllocationSize;
+    while(nodeSize < required) nodeSize <<= 1;
+    if(nodeSize > blockSize)
+        return allocateDedicated(memory, size);
+
+    /* Find the first live block with enough space, remember the first free
+       slot on the way */
+    Containers::Array<Block>& blocks = _state->blocks[memory];
+    UnsignedInt freeSlot = ~UnsignedInt{};
+    for(UnsignedInt i = 0; i != blocks.size(); ++i) {
+        Block& block = blocks[i];
+        if(!isLive(block)) {
+            if(freeSlot == ~UnsignedInt{}) freeSlot = i;
+            continue;
+        }
+
+        const UnsignedLong offset = block.allocator.allocate(nodeSize);
+        if(offset == ~UnsignedLong{}) continue;
+
+        ++block.allocationCount;
+        ++_state->allocationCount;
+        return MemoryAllocation{*_state, memory, i, offset, size, nodeSize};
+    }
+
+    /* No space anywhere, allocate a new block, reusing a released slot if
+       there's any */
+    Memory blockMemory{*_state->device, MemoryAllocateInfo{blockSize, memory}};
+    Implementation::BuddyAllocator allocator{blockSize, _state->minAllocationSize};
+    if(freeSlot == ~UnsignedInt{}) {
+        freeSlot = blocks.size();
+        arrayAppend(blocks, InPlaceInit, std::move(blockMemory), std::move(allocator), 0u);
+    } else {
+        blocks[freeSlot].memory = std::move(blockMemory);
+        blocks[freeSlot].allocator = std::move(allocator);
+        blocks[freeSlot].allocationCount = 0;
+    }
+
+    Block& block = blocks[freeSlot];
+    const UnsignedLong offset = block.allocator.allocate(nodeSize);
+    CORRADE_INTERNAL_ASSERT(offset != ~UnsignedLong{});
+    ++block.allocationCount;
+    ++_state->allocationCount;
+    return MemoryAllocation{*_state, memory, freeSlot, offset, size, nodeSize};
+}
+
+MemoryAllocation MemoryAllocator::allocateDedicated(const MemoryRequirements& requirements, const MemoryFlags requiredFlags, const MemoryFlags preferredFlags) {
+    CORRADE_ASSERT(_state,
+        "Vk::MemoryAllocator::allocateDedicated(): the allocator is not created", MemoryAllocation{NoCreate});
+    return allocateDedicated(_state->device->properties().pickMemory(requiredFlags, preferredFlags, requirements.memories()), requirements.size());
+}
+
+MemoryAllocation MemoryAllocator::allocateDedicated(const UnsignedInt memory, const UnsignedLong size) {
+    CORRADE_ASSERT(_state,
+        "Vk::MemoryAllocator::allocateDedicated(): the allocator is not created", MemoryAllocation{NoCreate});
+    CORRADE_ASSERT(memory < _state->blocks.size(),
+        "Vk::MemoryAllocator::allocateDedicated(): index" << memory << "out of range for" << _state->blocks.size() << "memory types", MemoryAllocation{NoCreate});
+
+    ++_state->allocationCount;
+    ++_state->dedicatedAllocationCount;
+    _state->dedicatedSize += size;
+    return MemoryAllocation{*_state, memory, Memory{*_state->device, MemoryAllocateInfo{size, memory}}};
+}
+
+UnsignedInt MemoryAllocator::blockCount() const {
+    if(!_state) return 0;
+    UnsignedInt count = 0;
+    for(const Containers::Array<Block>& blocks: _state->blocks)
+        for(const Block& block: blocks)
+            if(isLive(block)) ++count;
+    return count;
+}
+
+UnsignedInt MemoryAllocator::allocationCount() const {
+    return _state ? _state->allocationCount : 0;
+}
+
+UnsignedInt MemoryAllocator::dedicatedAllocationCount() const {
+    return _state ? _state->dedicatedAllocationCount : 0;
+}
+
+UnsignedLong MemoryAllocator::allocatedSize() const {
+    if(!_state) return 0;
+    UnsignedLong size = _state->dedicatedSize;
+    for(const Containers::Array<Block>& blocks: _state->blocks)
+        for(const Block& block: blocks)
+            if(isLive(block)) size += block.allocator.size();
+    return size;
+}
+
+UnsignedLong MemoryAllocator::usedSize() const {
+    if(!_state) return 0;
+    UnsignedLong size = _state->dedicatedSize;
+    for(const Containers::Array<Block>& blocks: _state->blocks)
+        for(const Block& block: blocks)
+            if(isLive(block)) size += block.allocator.usedSize();
+    return size;
+}
+
+Float MemoryAllocator::fragmentation() const {
+    if(!_state) return 0.0f;
+    UnsignedLong totalFree = 0, largestFree = 0;
+    for(const Containers::Array<Block>& blocks: _state->blocks)
+        for(const Block& block: blocks) {
+            if(!isLive(block)) continue;
+            totalFree += block.allocator.size() - block.allocator.usedSize();
+            largestFree = Math::max(largestFree, block.allocator.largestFreeNodeSize());
+        }
+    return totalFree ? 1.0f - Float(Double(largestFree)/Double(totalFree)) : 0.0f;
+}
+
+UnsignedInt MemoryAllocator::releaseEmptyBlocks() {
+    if(!_state) return 0;
+    UnsignedInt count = 0;
+    for(Containers::Array<Block>& blocks: _state->blocks) {
+        for(Block& block: blocks) {
+            if(!isLive(block) || block.allocationCount) continue;
+            block.memory = Memory{NoCreate};
+            ++count;
+        }
+
+        /* Trailing released slots aren't referenced by any allocation, so
+           they can be removed altogether */
+        std::size_t end = blocks.size();
+        while(end && !isLive(blocks[end - 1])) --end;
+        arrayRemoveSuffix(blocks, blocks.size() - end);
+    }
+    return count;
+}
+
+MemoryAllocation::MemoryAllocation(NoCreateT) noexcept: _state{}, _memoryType{}, _block{}, _offset{}, _size{}, _nodeSize{}, _dedicatedMemory{NoCreate} {}
+
+MemoryAllocation::MemoryAllocation(MemoryAllocator::State& state, const UnsignedInt memoryType, const UnsignedInt block, const UnsignedLong offset, const UnsignedLong size, const UnsignedLong nodeSize) noexcept: _state{&state}, _memoryType{memoryType}, _block{block}, _offset{offset}, _size{size}, _nodeSize{nodeSize}, _dedicatedMemory{NoCreate} {}
+
+MemoryAllocation::MemoryAllocation(MemoryAllocator::State& state, const UnsignedInt memoryType, Memory&& memory) noexcept: _state{&state}, _memoryType{memoryType}, _block{~UnsignedInt{}}, _offset{}, _size{memory.size()}, _nodeSize{memory.size()}, _dedicatedMemory{std::move(memory)} {}
+
+MemoryAllocation::MemoryAllocation(MemoryAllocation&& other) noexcept: _state{other._state}, _memoryType{other._memoryType}, _block{other._block}, _offset{other._offset}, _size{other._size}, _nodeSize{other._nodeSize}, _dedicatedMemory{std::move(other._dedicatedMemory)} {
+    other._state = nullptr;
+}
+
+MemoryAllocation::~MemoryAllocation() {
+    if(!_state) return;
+
+    if(_block == ~UnsignedInt{}) {
+        --_state->dedicatedAllocationCount;
+        _state->dedicatedSize -= _nodeSize;
+        /* The memory itself is freed by its destructor */
+    } else {
+        Block& block = _state->blocks[_memoryType][_block];
+        block.allocator.free(_offset, _nodeSize);
+        --block.allocationCount;
+    }
+
+    --_state->allocationCount;
+}
+
+MemoryAllocation& MemoryAllocation::operator=(MemoryAllocation&& other) noexcept {
+    using std::swap;
+    swap(other._state, _state);
+    swap(other._memoryType, _memoryType);
+    swap(other._block, _block);
+    swap(other._offset, _offset);
+    swap(other._size, _size);
+    swap(other._nodeSize, _nodeSize);
+    swap(other._dedicatedMemory, _dedicatedMemory);
+    return *this;
+}
+
+Memory& MemoryAllocation::memory() {
+    CORRADE_ASSERT(_state,
+        "Vk::MemoryAllocation::memory(): the allocation is not created", _dedicatedMemory);
+    if(_block == ~UnsignedInt{}) return _dedicatedMemory;
+    return _state->blocks[_memoryType][_block].memory;
+}
+
+}}
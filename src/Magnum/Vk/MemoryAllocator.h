@@ -0,0 +1,375 @@
+#ifndef Magnum_Vk_MemoryAllocator_h
+#define Magnum_Vk_MemoryAllocator_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Vk::MemoryAllocator, @ref Magnum::Vk::MemoryAllocation
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Tags.h"
+#include "Magnum/Vk/Memory.h"
+#include "Magnum/Vk/Vk.h"
+#include "Magnum/Vk/Vulkan.h"
+#include "Magnum/Vk/visibility.h"
+
+namespace Magnum { namespace Vk {
+
+/**
+@brief Device memory allocator
+@m_since_latest
+
+Allocates large per-memory-type blocks of @ref Memory and sub-allocates them
+for particular resources, avoiding the overhead of a @fn_vk{AllocateMemory}
+call per resource and hitting the
+@ref DeviceProperties::properties() "maxMemoryAllocationCount" limit.
+It's meant to be used as an alternative to the implicit dedicated allocation
+done by @ref Buffer::Buffer(Device&, const BufferCreateInfo&, MemoryFlags) and
+@ref Image::Image(Device&, const ImageCreateInfo&, MemoryFlags).
+
+@section Vk-MemoryAllocator-usage Usage
+
+Create the allocator on a @ref Device and then pass it to the
+@ref Buffer::Buffer(Device&, const BufferCreateInfo&, MemoryAllocator&, MemoryFlags)
+or @ref Image::Image(Device&, const ImageCreateInfo&, MemoryAllocator&, MemoryFlags)
+constructors. The resulting @ref MemoryAllocation is owned by the resource and
+returned back to the allocator when the resource is destroyed:
+
+@snippet MagnumVk.cpp MemoryAllocator-usage
+
+Alternatively, call @ref allocate() directly and bind the result with
+@ref Buffer::bindAllocatedMemory() / @ref Image::bindAllocatedMemory(), or
+keep the @ref MemoryAllocation around and bind it using
+@ref Buffer::bindMemory() with @ref MemoryAllocation::memory() and
+@ref MemoryAllocation::offset().
+
+The allocator is expected to outlive all allocations made from it.
+
+@section Vk-MemoryAllocator-algorithm Allocation strategy
+
+Memory of each type is allocated in blocks of at most the size passed to the
+constructor, clamped to an eighth of the size of the corresponding heap in
+order to not exhaust small heaps such as host-visible device-local memory on
+discrete GPUs. Blocks are sub-allocated using a buddy allocator --- every
+allocation is rounded up to a power of two at least as large as the
+@ref DeviceProperties::properties() "bufferImageGranularity" limit (and
+@cpp 256 @ce bytes), which means linear and optimally tiled resources never
+share a granularity page and alignment requirements are satisfied implicitly.
+
+Allocations larger than the dedicated threshold passed to the constructor (by
+default half the block size), typically large render targets, get their own
+dedicated @ref Memory instead of being sub-allocated, as they would waste
+large parts of the block due to the power-of-two rounding. A dedicated
+allocation can be also explicitly requested with @ref allocateDedicated().
+
+@section Vk-MemoryAllocator-defragmentation Defragmentation
+
+The allocator doesn't move any resources on its own, as that requires
+recording copy commands and recreating views, which is up to the application.
+It however provides hooks for deciding when it's worth doing: the
+@ref fragmentation() metric tells how much of the free space is unusable for
+large allocations, and after the application moves resources to new
+allocations and destroys the old ones, @ref releaseEmptyBlocks() returns the
+emptied blocks back to the driver. Empty blocks are otherwise kept around to
+make subsequent allocations fast.
+
+@section Vk-MemoryAllocator-mapping Mapping the memory
+
+As sub-allocations share the same @ref Memory, it isn't possible to have
+more than one of them mapped at a time using @ref Memory::map(). For
+frequently mapped resources either keep the whole block mapped for its whole
+lifetime or use dedicated allocations.
+*/
+class MAGNUM_VK_EXPORT MemoryAllocator {
+    public:
+        /**
+         * @brief Constructor
+         * @param device                Vulkan device to allocate the memory
+         *      on
+         * @param blockSize             Size of a single block from which
+         *      allocations are made. Expected to be a power of two.
+         * @param dedicatedThreshold    Allocations of this size and larger
+         *      use a dedicated memory instead of a block. Expected to not be
+         *      larger than @p blockSize.
+         */
+        explicit MemoryAllocator(Device& device, UnsignedLong blockSize = 64*1024*1024, UnsignedLong dedicatedThreshold = 32*1024*1024);
+
+        /**
+         * @brief Construct without creating the allocator
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit MemoryAllocator(NoCreateT);
+
+        /** @brief Copying is not allowed */
+        MemoryAllocator(const MemoryAllocator&) = delete;
+
+        /**
+         * @brief Move constructor
+         *
+         * Allocations made from the original instance stay valid.
+         */
+        MemoryAllocator(MemoryAllocator&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Frees all memory blocks. Expects that there are no live
+         * allocations made from this allocator.
+         */
+        ~MemoryAllocator();
+
+        /** @brief Copying is not allowed */
+        MemoryAllocator& operator=(const MemoryAllocator&) = delete;
+
+        /** @brief Move assignment */
+        MemoryAllocator& operator=(MemoryAllocator&& other) noexcept;
+
+        /** @brief Block size */
+        UnsignedLong blockSize() const;
+
+        /** @brief Dedicated allocation threshold */
+        UnsignedLong dedicatedThreshold() const;
+
+        /**
+         * @brief Minimal allocation size
+         *
+         * Each allocation is rounded up to a power of two that's at least
+         * this size. Calculated from the
+         * @ref DeviceProperties::properties() "bufferImageGranularity" limit.
+         */
+        UnsignedLong minAllocationSize() const;
+
+        /**
+         * @brief Allocate memory for given requirements
+         * @param requirements      Memory requirements, usually coming from
+         *      @ref Buffer::memoryRequirements() or
+         *      @ref Image::memoryRequirements()
+         * @param requiredFlags     Memory flags the memory type is required
+         *      to have
+         * @param preferredFlags    Memory flags the memory type is preferred
+         *      to have
+         *
+         * Picks a memory type using @ref DeviceProperties::pickMemory() and
+         * delegates to @ref allocate(UnsignedInt, UnsignedLong, UnsignedLong).
+         */
+        MemoryAllocation allocate(const MemoryRequirements& requirements, MemoryFlags requiredFlags, MemoryFlags preferredFlags = {});
+
+        /**
+         * @brief Allocate memory of given type
+         * @param memory        Memory type index. Expected to be less than
+         *      @ref DeviceProperties::memoryCount().
+         * @param size          Allocation size
+         * @param alignment     Allocation alignment. Expected to be a power
+         *      of two.
+         *
+         * If @p size is at least @ref dedicatedThreshold(), delegates to
+         * @ref allocateDedicated(). Otherwise finds the first block of given
+         * memory type that has enough space, allocating a new block if
+         * there's none.
+         */
+        MemoryAllocation allocate(UnsignedInt memory, UnsignedLong size, UnsignedLong alignment);
+
+        /**
+         * @brief Allocate a dedicated memory for given requirements
+         *
+         * Like @ref allocate(const MemoryRequirements&, MemoryFlags, MemoryFlags)
+         * but always creates a dedicated memory.
+         */
+        MemoryAllocation allocateDedicated(const MemoryRequirements& requirements, MemoryFlags requiredFlags, MemoryFlags preferredFlags = {});
+
+        /**
+         * @brief Allocate a dedicated memory of given type
+         *
+         * The allocation owns a new @ref Memory of exactly @p size, which is
+         * freed when the allocation is destroyed.
+         */
+        MemoryAllocation allocateDedicated(UnsignedInt memory, UnsignedLong size);
+
+        /**
+         * @brief Count of allocated blocks
+         *
+         * Includes empty blocks that weren't released yet, doesn't include
+         * dedicated allocations.
+         * @see @ref releaseEmptyBlocks()
+         */
+        UnsignedInt blockCount() const;
+
+        /**
+         * @brief Count of live allocations
+         *
+         * Including dedicated allocations.
+         */
+        UnsignedInt allocationCount() const;
+
+        /** @brief Count of live dedicated allocations */
+        UnsignedInt dedicatedAllocationCount() const;
+
+        /**
+         * @brief Total amount of allocated device memory
+         *
+         * Sum of sizes of all blocks and dedicated allocations.
+         */
+        UnsignedLong allocatedSize() const;
+
+        /**
+         * @brief Amount of device memory used by live allocations
+         *
+         * Includes padding caused by rounding allocations to a power of two.
+         */
+        UnsignedLong usedSize() const;
+
+        /**
+         * @brief Block fragmentation
+         *
+         * A value in range @f$ [0, 1] @f$, calculated as
+         * @f$ 1 - \frac{f_{max}}{f} @f$, where @f$ f_{max} @f$ is the largest
+         * free contiguous range in any block and @f$ f @f$ is the total free
+         * size in all blocks. Zero if there's no free space or all free space
+         * is contiguous, values close to one mean that large allocations will
+         * likely need a new block despite there being enough free memory.
+         * Dedicated allocations aren't taken into account.
+         */
+        Float fragmentation() const;
+
+        /**
+         * @brief Release empty blocks
+         * @return Count of released blocks
+         *
+         * Frees all blocks that have no allocations in them. Subsequent
+         * allocations will allocate new blocks as needed.
+         */
+        UnsignedInt releaseEmptyBlocks();
+
+    private:
+        friend MemoryAllocation;
+
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+/**
+@brief Device memory allocation
+@m_since_latest
+
+A range of @ref Memory allocated by @ref MemoryAllocator, either a
+sub-allocation of a larger block or a dedicated allocation. Returned back to
+the allocator on destruction. See the @ref MemoryAllocator class
+documentation for more information.
+*/
+class MAGNUM_VK_EXPORT MemoryAllocation {
+    public:
+        /**
+         * @brief Construct without creating the allocation
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit MemoryAllocation(NoCreateT) noexcept;
+
+        /** @brief Copying is not allowed */
+        MemoryAllocation(const MemoryAllocation&) = delete;
+
+        /** @brief Move constructor */
+        MemoryAllocation(MemoryAllocation&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Returns the range back to the originating @ref MemoryAllocator or
+         * frees the memory if the allocation is dedicated.
+         */
+        ~MemoryAllocation();
+
+        /** @brief Copying is not allowed */
+        MemoryAllocation& operator=(const MemoryAllocation&) = delete;
+
+        /** @brief Move assignment */
+        MemoryAllocation& operator=(MemoryAllocation&& other) noexcept;
+
+        /**
+         * @brief Whether the allocation is created
+         *
+         * Returns @cpp false @ce for a @ref MemoryAllocation(NoCreateT)
+         * or moved-out instance.
+         */
+        bool isCreated() const { return _state; }
+
+        /**
+         * @brief Whether the allocation is dedicated
+         *
+         * @see @ref MemoryAllocator::allocateDedicated()
+         */
+        bool isDedicated() const { return _state && _block == ~UnsignedInt{}; }
+
+        /**
+         * @brief Memory the allocation is in
+         *
+         * For a dedicated allocation returns the owned memory, otherwise the
+         * block shared with other allocations. Expects that the allocation is
+         * created.
+         */
+        Memory& memory();
+
+        /**
+         * @brief Offset in the memory
+         *
+         * Always @cpp 0 @ce for a dedicated allocation.
+         */
+        UnsignedLong offset() const { return _offset; }
+
+        /**
+         * @brief Allocation size
+         *
+         * The size that was requested, the actual space occupied in the
+         * block may be larger.
+         */
+        UnsignedLong size() const { return _size; }
+
+        /** @brief Memory type index */
+        UnsignedInt memoryType() const { return _memoryType; }
+
+    private:
+        friend MemoryAllocator;
+
+        explicit MemoryAllocation(MemoryAllocator::State& state, UnsignedInt memoryType, UnsignedInt block, UnsignedLong offset, UnsignedLong size, UnsignedLong nodeSize) noexcept;
+        explicit MemoryAllocation(MemoryAllocator::State& state, UnsignedInt memoryType, Memory&& memory) noexcept;
+
+        MemoryAllocator::State* _state;
+        UnsignedInt _memoryType, _block;
+        UnsignedLong _offset, _size, _nodeSize;
+        Memory _dedicatedMemory;
+};
+
+}}
+
+#endif
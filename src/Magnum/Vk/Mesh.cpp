@@ -202,12 +202,7 @@ MeshIndexType Mesh::indexType() const {
     return _state->indexType;
 }
 
-CommandBuffer& CommandBuffer::draw(Mesh& mesh) {
-    CORRADE_ASSERT(mesh.isCountSet(),
-        "Vk::CommandBuffer::draw(): Mesh::setCount() was never called, probably a mistake?", *this);
-
-    if(!mesh.count() || !mesh.instanceCount()) return *this;
-
+void CommandBuffer::bindMeshBuffers(Mesh& mesh) {
     if(_dynamicRasterizationStates & DynamicRasterizationState::MeshPrimitive)
         (**_device).CmdSetPrimitiveTopologyEXT(_handle, mesh.layout().vkPipelineInputAssemblyStateCreateInfo().topology);
 
@@ -223,16 +218,76 @@ CommandBuffer& CommandBuffer::draw(Mesh& mesh) {
         );
     }
 
-    if(mesh.isIndexed()) {
+    if(mesh.isIndexed())
         (**_device).CmdBindIndexBuffer(_handle, mesh.indexBuffer(), mesh.indexBufferOffset(), VkIndexType(mesh.indexType()));
+}
+
+CommandBuffer& CommandBuffer::draw(Mesh& mesh) {
+    CORRADE_ASSERT(mesh.isCountSet(),
+        "Vk::CommandBuffer::draw(): Mesh::setCount() was never called, probably a mistake?", *this);
+
+    if(!mesh.count() || !mesh.instanceCount()) return *this;
+
+    bindMeshBuffers(mesh);
+
+    if(mesh.isIndexed())
         (**_device).CmdDrawIndexed(_handle, mesh.count(), mesh.instanceCount(), mesh.indexOffset(), mesh.vertexOffset(), mesh.instanceOffset());
-    } else {
+    else
         (**_device).CmdDraw(_handle, mesh.count(), mesh.instanceCount(), mesh.vertexOffset(), mesh.instanceOffset());
-    }
 
     return *this;
 }
 
+CommandBuffer& CommandBuffer::drawIndirect(Mesh& mesh, const VkBuffer buffer, const UnsignedLong offset, const UnsignedInt drawCount, const UnsignedInt stride) {
+    if(!drawCount) return *this;
+
+    bindMeshBuffers(mesh);
+
+    if(mesh.isIndexed())
+        (**_device).CmdDrawIndexedIndirect(_handle, buffer, offset, drawCount, stride ? stride : sizeof(VkDrawIndexedIndirectCommand));
+    else
+        (**_device).CmdDrawIndirect(_handle, buffer, offset, drawCount, stride ? stride : sizeof(VkDrawIndirectCommand));
+
+    return *this;
+}
+
+CommandBuffer& CommandBuffer::drawIndirectCount(Mesh& mesh, const VkBuffer buffer, const UnsignedLong offset, const VkBuffer countBuffer, const UnsignedLong countOffset, const UnsignedInt maxDrawCount, const UnsignedInt stride) {
+    if(!maxDrawCount) return *this;
+
+    bindMeshBuffers(mesh);
+
+    if(mesh.isIndexed())
+        _device->state().cmdDrawIndexedIndirectCountImplementation(*this, buffer, offset, countBuffer, countOffset, maxDrawCount, stride ? stride : sizeof(VkDrawIndexedIndirectCommand));
+    else
+        _device->state().cmdDrawIndirectCountImplementation(*this, buffer, offset, countBuffer, countOffset, maxDrawCount, stride ? stride : sizeof(VkDrawIndirectCommand));
+
+    return *this;
+}
+
+void CommandBuffer::drawIndirectCountImplementationDefault(CommandBuffer&, VkBuffer, UnsignedLong, VkBuffer, UnsignedLong, UnsignedInt, UnsignedInt) {
+    CORRADE_ASSERT_UNREACHABLE("Vk::CommandBuffer::drawIndirectCount(): requires Vulkan 1.2 or KHR_draw_indirect_count", );
+}
+
+void CommandBuffer::drawIndirectCountImplementationKHR(CommandBuffer& self, const VkBuffer buffer, const UnsignedLong offset, const VkBuffer countBuffer, const UnsignedLong countOffset, const UnsignedInt maxDrawCount, const UnsignedInt stride) {
+    return (**self._device).CmdDrawIndirectCountKHR(self, buffer, offset, countBuffer, countOffset, maxDrawCount, stride);
+}
+
+void CommandBuffer::drawIndirectCountImplementation12(CommandBuffer& self, const VkBuffer buffer, const UnsignedLong offset, const VkBuffer countBuffer, const UnsignedLong countOffset, const UnsignedInt maxDrawCount, const UnsignedInt stride) {
+    return (**self._device).CmdDrawIndirectCount(self, buffer, offset, countBuffer, countOffset, maxDrawCount, stride);
+}
+
+void CommandBuffer::drawIndexedIndirectCountImplementationDefault(CommandBuffer&, VkBuffer, UnsignedLong, VkBuffer, UnsignedLong, UnsignedInt, UnsignedInt) {
+    CORRADE_ASSERT_UNREACHABLE("Vk::CommandBuffer::drawIndirectCount(): requires Vulkan 1.2 or KHR_draw_indirect_count", );
+}
+
+void CommandBuffer::drawIndexedIndirectCountImplementationKHR(CommandBuffer& self, const VkBuffer buffer, const UnsignedLong offset, const VkBuffer countBuffer, const UnsignedLong countOffset, const UnsignedInt maxDrawCount, const UnsignedInt stride) {
+    return (**self._device).CmdDrawIndexedIndirectCountKHR(self, buffer, offset, countBuffer, countOffset, maxDrawCount, stride);
+}
+
+void CommandBuffer::drawIndexedIndirectCountImplementation12(CommandBuffer& self, const VkBuffer buffer, const UnsignedLong offset, const VkBuffer countBuffer, const UnsignedLong countOffset, const UnsignedInt maxDrawCount, const UnsignedInt stride) {
+    return (**self._device).CmdDrawIndexedIndirectCount(self, buffer, offset, countBuffer, countOffset, maxDrawCount, stride);
+}
+
 void CommandBuffer::bindVertexBuffersImplementationDefault(CommandBuffer& self, const UnsignedInt firstBinding, const UnsignedInt bindingCount, const VkBuffer* const buffers, const UnsignedLong* const offsets, const UnsignedLong* const strides) {
     CORRADE_ASSERT(!strides,
         "Vk::CommandBuffer::draw(): dynamic strides supplied for an implementation without extended dynamic state",
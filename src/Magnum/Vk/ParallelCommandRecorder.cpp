@@ -0,0 +1,118 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ParallelCommandRecorder.h"
+
+#if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+#include <atomic>
+#include <functional>
+#include <thread>
+#endif
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Vk/CommandPoolCreateInfo.h"
+
+namespace Magnum { namespace Vk {
+
+namespace {
+
+UnsignedInt threadCountFor(UnsignedInt threadCount) {
+    #if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+    if(!threadCount) threadCount = std::thread::hardware_concurrency();
+    /* hardware_concurrency() is allowed to return 0 if it doesn't know */
+    return Math::max(threadCount, 1u);
+    #else
+    static_cast<void>(threadCount);
+    return 1;
+    #endif
+}
+
+}
+
+ParallelCommandRecorder::ParallelCommandRecorder(Device& device, const CommandPoolCreateInfo& info, const UnsignedInt threadCount): _pools{DirectInit, threadCountFor(threadCount), device, info} {}
+
+ParallelCommandRecorder::ParallelCommandRecorder(NoCreateT) noexcept {}
+
+ParallelCommandRecorder::ParallelCommandRecorder(ParallelCommandRecorder&&) noexcept = default;
+
+ParallelCommandRecorder::~ParallelCommandRecorder() = default;
+
+ParallelCommandRecorder& ParallelCommandRecorder::operator=(ParallelCommandRecorder&&) noexcept = default;
+
+CommandPool& ParallelCommandRecorder::pool(const UnsignedInt thread) {
+    CORRADE_ASSERT(thread < _pools.size(),
+        "Vk::ParallelCommandRecorder::pool(): index" << thread << "out of range for" << _pools.size() << "threads", _pools[0]);
+    return _pools[thread];
+}
+
+void ParallelCommandRecorder::reset(const CommandPoolResetFlags flags) {
+    for(CommandPool& pool: _pools) pool.reset(flags);
+}
+
+Containers::Array<CommandBuffer> ParallelCommandRecorder::recordSecondary(const CommandBufferInheritanceInfo& inheritanceInfo, const std::size_t count, void(*const callback)(CommandBuffer&, std::size_t, void*), void* const userData, const CommandBufferBeginInfo::Flags flags) {
+    CORRADE_ASSERT(callback,
+        "Vk::ParallelCommandRecorder::recordSecondary(): callback can't be null", {});
+
+    Containers::Array<CommandBuffer> out{DirectInit, count, NoCreate};
+    /* Shared by all threads, only read from */
+    const CommandBufferBeginInfo beginInfo{inheritanceInfo, flags};
+    const auto record = [&](CommandPool& pool, const std::size_t i) {
+        out[i] = pool.allocate(CommandBufferLevel::Secondary);
+        out[i].begin(beginInfo);
+        callback(out[i], i, userData);
+        out[i].end();
+    };
+
+    #if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+    const UnsignedInt threadCount = Math::min(UnsignedInt(_pools.size()), UnsignedInt(count));
+    if(threadCount > 1) {
+        /* Command buffers can take vastly different time to record, so
+           instead of splitting them into fixed chunks each thread picks the
+           next unrecorded one, always allocating it from its own pool */
+        std::atomic<std::size_t> next{0};
+        const auto worker = [&](CommandPool& pool) {
+            for(std::size_t i; (i = next++) < count; )
+                record(pool, i);
+        };
+
+        /* The calling thread does its share of the work as well, using the
+           first pool */
+        Containers::Array<std::thread> threads{threadCount - 1};
+        for(std::size_t i = 0; i != threads.size(); ++i)
+            threads[i] = std::thread{worker, std::ref(_pools[i + 1])};
+        worker(_pools[0]);
+        for(std::thread& thread: threads)
+            thread.join();
+
+        return out;
+    }
+    #endif
+
+    for(std::size_t i = 0; i != count; ++i)
+        record(_pools[0], i);
+    return out;
+}
+
+}}
@@ -0,0 +1,196 @@
+#ifndef Magnum_Vk_ParallelCommandRecorder_h
+#define Magnum_Vk_ParallelCommandRecorder_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Vk::ParallelCommandRecorder
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Vk/CommandBuffer.h"
+#include "Magnum/Vk/CommandPool.h"
+
+namespace Magnum { namespace Vk {
+
+/**
+@brief Parallel command recorder
+@m_since_latest
+
+Manages a set of @ref CommandPool "CommandPool"s, one for each thread, and
+records @ref CommandBufferLevel::Secondary command buffers from them in
+parallel. Command pools are externally synchronized in Vulkan --- a pool and
+all command buffers allocated from it can be only used by a single thread at a
+time --- so parallel recording needs a pool for each thread.
+
+@section Vk-ParallelCommandRecorder-creation Recorder creation
+
+The recorder takes a @ref CommandPoolCreateInfo that's used to create all
+pools and a thread count. If the thread count is @cpp 0 @ce or not specified,
+@ref std::thread::hardware_concurrency() is used. If Corrade is built without
+@ref CORRADE_BUILD_MULTITHREADED or on Emscripten, there's always just a
+single pool and all recording happens on the calling thread.
+
+@snippet MagnumVk.cpp ParallelCommandRecorder-creation
+
+@section Vk-ParallelCommandRecorder-recording Parallel recording
+
+The @ref recordSecondary() function records given count of secondary command
+buffers, calling a function for each of them. The command buffers are
+distributed across the threads, each thread allocating them from its own pool,
+and the calling thread does its share of the work as well. The returned
+buffers are then executed from a primary command buffer using
+@ref CommandBuffer::executeCommands() inside a subpass started with
+@ref SubpassContents::SecondaryCommandBuffers:
+
+@snippet MagnumVk.cpp ParallelCommandRecorder-recording
+
+The callback should be safe to call from multiple threads at once and it
+shouldn't touch any state that's shared with other recorded command buffers.
+The returned command buffers are owned by the caller and allocated from
+different pools, so in order to recycle them it's recommended to let them
+destruct and @ref reset() all pools once the GPU is done executing them ---
+for example at the beginning of the next frame that uses the same recorder.
+*/
+class MAGNUM_VK_EXPORT ParallelCommandRecorder {
+    public:
+        /**
+         * @brief Constructor
+         * @param device        Vulkan device to create the command pools on
+         * @param info          Command pool creation info, used for all
+         *      pools
+         * @param threadCount   Thread count. If @cpp 0 @ce, the value of
+         *      @ref std::thread::hardware_concurrency() is used.
+         *
+         * Creates one @ref CommandPool for each thread.
+         */
+        explicit ParallelCommandRecorder(Device& device, const CommandPoolCreateInfo& info, UnsignedInt threadCount = 0);
+
+        /**
+         * @brief Construct without creating the pools
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit ParallelCommandRecorder(NoCreateT) noexcept;
+
+        /** @brief Copying is not allowed */
+        ParallelCommandRecorder(const ParallelCommandRecorder&) = delete;
+
+        /** @brief Move constructor */
+        ParallelCommandRecorder(ParallelCommandRecorder&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Destroys all command pools. Command buffers allocated from them
+         * have to be destroyed before.
+         */
+        ~ParallelCommandRecorder();
+
+        /** @brief Copying is not allowed */
+        ParallelCommandRecorder& operator=(const ParallelCommandRecorder&) = delete;
+
+        /** @brief Move assignment */
+        ParallelCommandRecorder& operator=(ParallelCommandRecorder&& other) noexcept;
+
+        /**
+         * @brief Thread count
+         *
+         * Count of command pools and max count of threads that
+         * @ref recordSecondary() uses. Always at least @cpp 1 @ce, except
+         * for a @ref ParallelCommandRecorder(NoCreateT) "NoCreate"'d
+         * instance.
+         */
+        UnsignedInt threadCount() const { return _pools.size(); }
+
+        /**
+         * @brief Command pool for given thread
+         *
+         * Expects that @p thread is less than @ref threadCount(). Useful for
+         * recording into pools on threads managed by the application. Pool
+         * @cpp 0 @ce is the one that's used by the calling thread in
+         * @ref recordSecondary().
+         */
+        CommandPool& pool(UnsignedInt thread);
+
+        /**
+         * @brief Reset all command pools
+         *
+         * All command buffers allocated from all the pools are reset as well.
+         * @see @ref CommandPool::reset()
+         */
+        void reset(CommandPoolResetFlags flags = {});
+
+        /**
+         * @brief Record secondary command buffers in parallel
+         * @param inheritanceInfo   Inheritance info for all recorded command
+         *      buffers
+         * @param count             Count of command buffers to record
+         * @param callback          Function to record each command buffer
+         * @param userData          User data passed to @p callback
+         * @param flags             Command buffer begin flags
+         *
+         * Allocates @p count @ref CommandBufferLevel::Secondary command
+         * buffers, distributing them across at most @ref threadCount()
+         * threads, each using its own pool. Each command buffer is begun with
+         * @ref CommandBufferBeginInfo::CommandBufferBeginInfo(const CommandBufferInheritanceInfo&, Flags)
+         * created from @p inheritanceInfo and @p flags, then @p callback is
+         * called with the command buffer, its index and @p userData, and
+         * then the buffer is ended. The returned command buffers are in the
+         * same order as the indices passed to @p callback. Expects that
+         * @p callback is not @cpp nullptr @ce. See
+         * @ref Vk-ParallelCommandRecorder-recording for more information.
+         */
+        Containers::Array<CommandBuffer> recordSecondary(const CommandBufferInheritanceInfo& inheritanceInfo, std::size_t count, void(*callback)(CommandBuffer&, std::size_t, void*), void* userData = nullptr, CommandBufferBeginInfo::Flags flags = {});
+
+        /**
+         * @brief Record secondary command buffers in parallel
+         *
+         * Equivalent to calling the above with a lambda wrapper that casts
+         * @cpp void* @ce back to @cpp T* @ce and dereferences it in order to
+         * pass it to @p callback.
+         */
+        #ifdef DOXYGEN_GENERATING_OUTPUT
+        template<class T> Containers::Array<CommandBuffer> recordSecondary(const CommandBufferInheritanceInfo& inheritanceInfo, std::size_t count, void(*callback)(CommandBuffer&, std::size_t, T&), T& userData, CommandBufferBeginInfo::Flags flags = {});
+        #else
+        /* Otherwise the user would be forced to use the + operator to convert
+           a lambda to a function pointer */
+        template<class Callback, class T> Containers::Array<CommandBuffer> recordSecondary(const CommandBufferInheritanceInfo& inheritanceInfo, std::size_t count, Callback callback, T& userData, CommandBufferBeginInfo::Flags flags = {}) {
+            const auto callbackPtr = static_cast<void(*)(CommandBuffer&, std::size_t, T&)>(callback);
+            return recordSecondary(inheritanceInfo, count, reinterpret_cast<void(*)(CommandBuffer&, std::size_t, void*)>(callbackPtr), &userData, flags);
+        }
+        #endif
+
+    private:
+        Containers::Array<CommandPool> _pools;
+};
+
+}}
+
+#endif
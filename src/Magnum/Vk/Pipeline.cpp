@@ -30,14 +30,18 @@
 
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/BigEnumSet.hpp>
+#include <Corrade/Containers/GrowableArray.h>
 
+#include "Magnum/Math/Vector3.h"
 #include "Magnum/Vk/Assert.h"
 #include "Magnum/Vk/Device.h"
 #include "Magnum/Vk/Handle.h"
 #include "Magnum/Vk/Image.h"
 #include "Magnum/Vk/Integration.h"
 #include "Magnum/Vk/MeshLayout.h"
+#include "Magnum/Vk/PipelineCache.h"
 #include "Magnum/Vk/ShaderSet.h"
+#include "Magnum/Vk/Implementation/DeviceState.h"
 
 namespace Magnum { namespace Vk {
 
@@ -52,6 +56,9 @@ struct RasterizationPipelineCreateInfo::State {
     /** @todo make an array once we support multiview */
     VkViewport viewport;
     VkRect2D scissor;
+
+    Containers::Array<VkFormat> renderingColorFormats;
+    VkPipelineRenderingCreateInfoKHR renderingInfo{};
 };
 
 RasterizationPipelineCreateInfo::RasterizationPipelineCreateInfo(const ShaderSet& shaderSet, const MeshLayout& meshLayout, const VkPipelineLayout pipelineLayout, const VkRenderPass renderPass, const UnsignedInt subpass, const UnsignedInt subpassColorAttachmentCount, Flags flags): _info{}, _viewportInfo{}, _rasterizationInfo{}, _multisampleInfo{}, _depthStencilInfo{}, _colorBlendInfo{}, _dynamicInfo{}, _state{InPlaceInit} {
@@ -269,6 +276,34 @@ RasterizationPipelineCreateInfo& RasterizationPipelineCreateInfo::setDynamicStat
     return *this;
 }
 
+RasterizationPipelineCreateInfo& RasterizationPipelineCreateInfo::setRenderingFormats(const Containers::ArrayView<const PixelFormat> colorFormats, const PixelFormat depthFormat, const PixelFormat stencilFormat) {
+    CORRADE_ASSERT(!_info.pColorBlendState || colorFormats.size() == _colorBlendInfo.attachmentCount,
+        "Vk::RasterizationPipelineCreateInfo::setRenderingFormats(): expected" << _colorBlendInfo.attachmentCount << "color formats but got" << colorFormats.size(), *this);
+    if(!_state) _state.emplace();
+
+    _state->renderingColorFormats = Containers::Array<VkFormat>{NoInit, colorFormats.size()};
+    for(std::size_t i = 0; i != colorFormats.size(); ++i)
+        _state->renderingColorFormats[i] = VkFormat(colorFormats[i]);
+
+    /* Put the structure at the front of the chain, preserving whatever was
+       there before, unless it's connected already */
+    VkPipelineRenderingCreateInfoKHR& info = _state->renderingInfo;
+    if(_info.pNext != &info) {
+        info.sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR;
+        info.pNext = _info.pNext;
+        _info.pNext = &info;
+    }
+    info.colorAttachmentCount = _state->renderingColorFormats.size();
+    info.pColorAttachmentFormats = _state->renderingColorFormats;
+    info.depthAttachmentFormat = VkFormat(depthFormat);
+    info.stencilAttachmentFormat = VkFormat(stencilFormat);
+    return *this;
+}
+
+RasterizationPipelineCreateInfo& RasterizationPipelineCreateInfo::setRenderingFormats(const std::initializer_list<PixelFormat> colorFormats, const PixelFormat depthFormat, const PixelFormat stencilFormat) {
+    return setRenderingFormats(Containers::arrayView(colorFormats), depthFormat, stencilFormat);
+}
+
 ComputePipelineCreateInfo::ComputePipelineCreateInfo(const ShaderSet& shaderSet, const VkPipelineLayout pipelineLayout, const Flags flags): _info{} {
     CORRADE_ASSERT(shaderSet.stages().size() == 1,
         "Vk::ComputePipelineCreateInfo: the shader set has to contain exactly one shader, got" << shaderSet.stages().size(), );
@@ -300,7 +335,11 @@ Pipeline Pipeline::wrap(Device& device, const PipelineBindPoint bindPoint, const
     return wrap(device, bindPoint, handle, DynamicRasterizationStates{}, flags);
 }
 
-Pipeline::Pipeline(Device& device, const RasterizationPipelineCreateInfo& info):
+Pipeline::Pipeline(Device& device, const RasterizationPipelineCreateInfo& info): Pipeline{device, info, VkPipelineCache{}} {}
+
+Pipeline::Pipeline(Device& device, const RasterizationPipelineCreateInfo& info, PipelineCache& cache): Pipeline{device, info, cache.handle()} {}
+
+Pipeline::Pipeline(Device& device, const RasterizationPipelineCreateInfo& info, const VkPipelineCache cache):
     _device{&device},
     #ifdef CORRADE_GRACEFUL_ASSERT
     /* Otherwise vkDestroyPipeline() crashes when we hit the assert */
@@ -315,11 +354,15 @@ Pipeline::Pipeline(Device& device, const RasterizationPipelineCreateInfo& info):
     CORRADE_ASSERT(info->pViewportState || info->pRasterizationState->rasterizerDiscardEnable || info->pDynamicState,
         "Vk::Pipeline: if rasterization discard is not enabled, the viewport has to be either dynamic or set via setViewport()", );
 
-    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS(device->CreateGraphicsPipelines(device, {}, 1, info, nullptr, &_handle));
+    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS(device->CreateGraphicsPipelines(device, cache, 1, info, nullptr, &_handle));
 }
 
-Pipeline::Pipeline(Device& device, const ComputePipelineCreateInfo& info): _device{&device}, _bindPoint{PipelineBindPoint::Compute}, _flags{HandleFlag::DestroyOnDestruction}, _dynamicStates{} {
-    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS(device->CreateComputePipelines(device, {}, 1, info, nullptr, &_handle));
+Pipeline::Pipeline(Device& device, const ComputePipelineCreateInfo& info): Pipeline{device, info, VkPipelineCache{}} {}
+
+Pipeline::Pipeline(Device& device, const ComputePipelineCreateInfo& info, PipelineCache& cache): Pipeline{device, info, cache.handle()} {}
+
+Pipeline::Pipeline(Device& device, const ComputePipelineCreateInfo& info, const VkPipelineCache cache): _device{&device}, _bindPoint{PipelineBindPoint::Compute}, _flags{HandleFlag::DestroyOnDestruction}, _dynamicStates{} {
+    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS(device->CreateComputePipelines(device, cache, 1, info, nullptr, &_handle));
 }
 
 Pipeline::Pipeline(NoCreateT): _device{}, _handle{}, _bindPoint{}, _dynamicStates{} {}
@@ -411,6 +454,113 @@ ImageMemoryBarrier::ImageMemoryBarrier(const VkImageMemoryBarrier& barrier):
        member instead of doing a copy */
     _barrier(barrier) {}
 
+struct DependencyInfo::State {
+    Containers::Array<VkMemoryBarrier2KHR> memoryBarriers;
+    Containers::Array<VkBufferMemoryBarrier2KHR> bufferMemoryBarriers;
+    Containers::Array<VkImageMemoryBarrier2KHR> imageMemoryBarriers;
+};
+
+DependencyInfo::DependencyInfo(const DependencyFlags flags): _info{} {
+    _info.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO_KHR;
+    _info.dependencyFlags = VkDependencyFlags(flags);
+}
+
+DependencyInfo::DependencyInfo(NoInitT) noexcept {}
+
+DependencyInfo::DependencyInfo(const VkDependencyInfoKHR& info):
+    /* Can't use {} with GCC 4.8 here because it tries to initialize the first
+       member instead of doing a copy */
+    _info(info) {}
+
+DependencyInfo::DependencyInfo(DependencyInfo&& other) noexcept:
+    /* Can't use {} with GCC 4.8 here because it tries to initialize the first
+       member instead of doing a copy */
+    _info(other._info),
+    _state{std::move(other._state)}
+{
+    /* Ensure the previous instance doesn't reference state that's now ours */
+    other._info.memoryBarrierCount = 0;
+    other._info.pMemoryBarriers = nullptr;
+    other._info.bufferMemoryBarrierCount = 0;
+    other._info.pBufferMemoryBarriers = nullptr;
+    other._info.imageMemoryBarrierCount = 0;
+    other._info.pImageMemoryBarriers = nullptr;
+}
+
+DependencyInfo::~DependencyInfo() = default;
+
+DependencyInfo& DependencyInfo::operator=(DependencyInfo&& other) noexcept {
+    using std::swap;
+    swap(other._info, _info);
+    swap(other._state, _state);
+    return *this;
+}
+
+DependencyInfo& DependencyInfo::addMemoryBarrier(const PipelineStages sourceStages, const Accesses sourceAccesses, const PipelineStages destinationStages, const Accesses destinationAccesses) {
+    if(!_state) _state.emplace();
+
+    VkMemoryBarrier2KHR& barrier = arrayAppend(_state->memoryBarriers, InPlaceInit);
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2_KHR;
+    barrier.srcStageMask = VkPipelineStageFlags(sourceStages);
+    barrier.srcAccessMask = VkAccessFlags(sourceAccesses);
+    barrier.dstStageMask = VkPipelineStageFlags(destinationStages);
+    barrier.dstAccessMask = VkAccessFlags(destinationAccesses);
+
+    /* The array might have been reallocated, update the pointer */
+    _info.memoryBarrierCount = _state->memoryBarriers.size();
+    _info.pMemoryBarriers = _state->memoryBarriers;
+    return *this;
+}
+
+DependencyInfo& DependencyInfo::addBufferMemoryBarrier(const PipelineStages sourceStages, const Accesses sourceAccesses, const PipelineStages destinationStages, const Accesses destinationAccesses, const VkBuffer buffer, const UnsignedLong offset, const UnsignedLong size) {
+    if(!_state) _state.emplace();
+
+    VkBufferMemoryBarrier2KHR& barrier = arrayAppend(_state->bufferMemoryBarriers, InPlaceInit);
+    barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2_KHR;
+    barrier.srcStageMask = VkPipelineStageFlags(sourceStages);
+    barrier.srcAccessMask = VkAccessFlags(sourceAccesses);
+    barrier.dstStageMask = VkPipelineStageFlags(destinationStages);
+    barrier.dstAccessMask = VkAccessFlags(destinationAccesses);
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.buffer = buffer;
+    barrier.offset = offset;
+    barrier.size = size;
+
+    _info.bufferMemoryBarrierCount = _state->bufferMemoryBarriers.size();
+    _info.pBufferMemoryBarriers = _state->bufferMemoryBarriers;
+    return *this;
+}
+
+DependencyInfo& DependencyInfo::addImageMemoryBarrier(const PipelineStages sourceStages, const Accesses sourceAccesses, const PipelineStages destinationStages, const Accesses destinationAccesses, const ImageLayout oldLayout, const ImageLayout newLayout, const VkImage image, const ImageAspects aspects, const UnsignedInt layerOffset, const UnsignedInt layerCount, const UnsignedInt levelOffset, const UnsignedInt levelCount) {
+    if(!_state) _state.emplace();
+
+    VkImageMemoryBarrier2KHR& barrier = arrayAppend(_state->imageMemoryBarriers, InPlaceInit);
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2_KHR;
+    barrier.srcStageMask = VkPipelineStageFlags(sourceStages);
+    barrier.srcAccessMask = VkAccessFlags(sourceAccesses);
+    barrier.dstStageMask = VkPipelineStageFlags(destinationStages);
+    barrier.dstAccessMask = VkAccessFlags(destinationAccesses);
+    barrier.oldLayout = VkImageLayout(oldLayout);
+    barrier.newLayout = VkImageLayout(newLayout);
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = image;
+    barrier.subresourceRange.aspectMask = VkImageAspectFlags(aspects);
+    barrier.subresourceRange.baseMipLevel = levelOffset;
+    barrier.subresourceRange.levelCount = levelCount;
+    barrier.subresourceRange.baseArrayLayer = layerOffset;
+    barrier.subresourceRange.layerCount = layerCount;
+
+    _info.imageMemoryBarrierCount = _state->imageMemoryBarriers.size();
+    _info.pImageMemoryBarriers = _state->imageMemoryBarriers;
+    return *this;
+}
+
+DependencyInfo& DependencyInfo::addImageMemoryBarrier(const PipelineStages sourceStages, const Accesses sourceAccesses, const PipelineStages destinationStages, const Accesses destinationAccesses, const ImageLayout oldLayout, const ImageLayout newLayout, Image& image, const UnsignedInt layerOffset, const UnsignedInt layerCount, const UnsignedInt levelOffset, const UnsignedInt levelCount) {
+    return addImageMemoryBarrier(sourceStages, sourceAccesses, destinationStages, destinationAccesses, oldLayout, newLayout, image, imageAspectsFor(image.format()), layerOffset, layerCount, levelOffset, levelCount);
+}
+
 CommandBuffer& CommandBuffer::bindPipeline(Pipeline& pipeline) {
     /* Save the set of dynamic states for future use */
     if(pipeline.bindPoint() == PipelineBindPoint::Rasterization)
@@ -420,6 +570,16 @@ CommandBuffer& CommandBuffer::bindPipeline(Pipeline& pipeline) {
     return *this;
 }
 
+CommandBuffer& CommandBuffer::dispatch(const Vector3ui& count) {
+    (**_device).CmdDispatch(_handle, count.x(), count.y(), count.z());
+    return *this;
+}
+
+CommandBuffer& CommandBuffer::dispatchIndirect(const VkBuffer buffer, const UnsignedLong offset) {
+    (**_device).CmdDispatchIndirect(_handle, buffer, offset);
+    return *this;
+}
+
 CommandBuffer& CommandBuffer::pipelineBarrier(const PipelineStages sourceStages, const PipelineStages destinationStages, const Containers::ArrayView<const MemoryBarrier> memoryBarriers, const Containers::ArrayView<const BufferMemoryBarrier> bufferMemoryBarriers, const Containers::ArrayView<const ImageMemoryBarrier> imageMemoryBarriers, const DependencyFlags dependencyFlags) {
     /* Once these grow (VkSampleLocationsInfoEXT?), they will need to be
        linearized into a separate array first */
@@ -464,6 +624,71 @@ CommandBuffer& CommandBuffer::pipelineBarrier(const PipelineStages sourceStages,
     return pipelineBarrier(sourceStages, destinationStages, Containers::arrayView(imageMemoryBarriers), dependencyFlags);
 }
 
+CommandBuffer& CommandBuffer::pipelineBarrier(const DependencyInfo& info) {
+    _device->state().cmdPipelineBarrier2Implementation(*this, *info);
+    return *this;
+}
+
+void CommandBuffer::pipelineBarrier2ImplementationDefault(CommandBuffer& self, const VkDependencyInfoKHR& info) {
+    /* The legacy call has only a single pair of stage masks for all barriers,
+       so merge stages of all of them together. That may synchronize more than
+       strictly needed but is still correct. The masks are guaranteed to fit
+       into 32 bits as DependencyInfo takes only the 32-bit enums. */
+    VkPipelineStageFlags sourceStages = 0;
+    VkPipelineStageFlags destinationStages = 0;
+
+    Containers::Array<VkMemoryBarrier> memoryBarriers{ValueInit, info.memoryBarrierCount};
+    for(std::size_t i = 0; i != memoryBarriers.size(); ++i) {
+        const VkMemoryBarrier2KHR& barrier = info.pMemoryBarriers[i];
+        sourceStages |= VkPipelineStageFlags(barrier.srcStageMask);
+        destinationStages |= VkPipelineStageFlags(barrier.dstStageMask);
+        memoryBarriers[i].sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        memoryBarriers[i].srcAccessMask = VkAccessFlags(barrier.srcAccessMask);
+        memoryBarriers[i].dstAccessMask = VkAccessFlags(barrier.dstAccessMask);
+    }
+
+    Containers::Array<VkBufferMemoryBarrier> bufferMemoryBarriers{ValueInit, info.bufferMemoryBarrierCount};
+    for(std::size_t i = 0; i != bufferMemoryBarriers.size(); ++i) {
+        const VkBufferMemoryBarrier2KHR& barrier = info.pBufferMemoryBarriers[i];
+        sourceStages |= VkPipelineStageFlags(barrier.srcStageMask);
+        destinationStages |= VkPipelineStageFlags(barrier.dstStageMask);
+        bufferMemoryBarriers[i].sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        bufferMemoryBarriers[i].srcAccessMask = VkAccessFlags(barrier.srcAccessMask);
+        bufferMemoryBarriers[i].dstAccessMask = VkAccessFlags(barrier.dstAccessMask);
+        bufferMemoryBarriers[i].srcQueueFamilyIndex = barrier.srcQueueFamilyIndex;
+        bufferMemoryBarriers[i].dstQueueFamilyIndex = barrier.dstQueueFamilyIndex;
+        bufferMemoryBarriers[i].buffer = barrier.buffer;
+        bufferMemoryBarriers[i].offset = barrier.offset;
+        bufferMemoryBarriers[i].size = barrier.size;
+    }
+
+    Containers::Array<VkImageMemoryBarrier> imageMemoryBarriers{ValueInit, info.imageMemoryBarrierCount};
+    for(std::size_t i = 0; i != imageMemoryBarriers.size(); ++i) {
+        const VkImageMemoryBarrier2KHR& barrier = info.pImageMemoryBarriers[i];
+        sourceStages |= VkPipelineStageFlags(barrier.srcStageMask);
+        destinationStages |= VkPipelineStageFlags(barrier.dstStageMask);
+        imageMemoryBarriers[i].sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        imageMemoryBarriers[i].srcAccessMask = VkAccessFlags(barrier.srcAccessMask);
+        imageMemoryBarriers[i].dstAccessMask = VkAccessFlags(barrier.dstAccessMask);
+        imageMemoryBarriers[i].oldLayout = barrier.oldLayout;
+        imageMemoryBarriers[i].newLayout = barrier.newLayout;
+        imageMemoryBarriers[i].srcQueueFamilyIndex = barrier.srcQueueFamilyIndex;
+        imageMemoryBarriers[i].dstQueueFamilyIndex = barrier.dstQueueFamilyIndex;
+        imageMemoryBarriers[i].image = barrier.image;
+        imageMemoryBarriers[i].subresourceRange = barrier.subresourceRange;
+    }
+
+    /* Synchronization2 allows empty stage masks, the legacy call doesn't */
+    if(!sourceStages) sourceStages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+    if(!destinationStages) destinationStages = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+
+    (**self._device).CmdPipelineBarrier(self, sourceStages, destinationStages, info.dependencyFlags, memoryBarriers.size(), memoryBarriers, bufferMemoryBarriers.size(), bufferMemoryBarriers, imageMemoryBarriers.size(), imageMemoryBarriers);
+}
+
+void CommandBuffer::pipelineBarrier2ImplementationKHR(CommandBuffer& self, const VkDependencyInfoKHR& info) {
+    return (**self._device).CmdPipelineBarrier2KHR(self, &info);
+}
+
 Debug& operator<<(Debug& debug, const PipelineBindPoint value) {
     debug << "Vk::PipelineBindPoint" << Debug::nospace;
 
@@ -26,12 +26,13 @@
 */
 
 /** @file
- * @brief Class @ref Magnum::Vk::Pipeline, @ref Magnum::Vk::MemoryBarrier, @ref Magnum::Vk::BufferMemoryBarrier, @ref Magnum::Vk::ImageMemoryBarrier, enum @ref Magnum::Vk::PipelineBindPoint, @ref Magnum::Vk::PipelineStage, @ref Magnum::Vk::Access, @ref Magnum::Vk::DependencyFlag, enum set @ref Magnum::Vk::PipelineStages, @ref Magnum::Vk::Accesses, @ref Magnum::Vk::DependencyFlags
+ * @brief Class @ref Magnum::Vk::Pipeline, @ref Magnum::Vk::MemoryBarrier, @ref Magnum::Vk::BufferMemoryBarrier, @ref Magnum::Vk::ImageMemoryBarrier, @ref Magnum::Vk::DependencyInfo, enum @ref Magnum::Vk::PipelineBindPoint, @ref Magnum::Vk::PipelineStage, @ref Magnum::Vk::Access, @ref Magnum::Vk::DependencyFlag, enum set @ref Magnum::Vk::PipelineStages, @ref Magnum::Vk::Accesses, @ref Magnum::Vk::DependencyFlags
  * @m_since_latest
  */
 
 #include <Corrade/Containers/BigEnumSet.h>
 #include <Corrade/Containers/EnumSet.h>
+#include <Corrade/Containers/Pointer.h>
 
 #include "Magnum/Magnum.h"
 #include "Magnum/Tags.h"
@@ -146,6 +147,21 @@ class MAGNUM_VK_EXPORT Pipeline {
          */
         explicit Pipeline(Device& device, const RasterizationPipelineCreateInfo& info);
 
+        /**
+         * @brief Construct a rasterization pipeline using a pipeline cache
+         * @param device    Vulkan device to create the pipeline on
+         * @param info      Rasterization pipeline creation info
+         * @param cache     Pipeline cache
+         * @m_since_latest
+         *
+         * Compared to @ref Pipeline(Device&, const RasterizationPipelineCreateInfo&)
+         * the driver can reuse results of previous pipeline creations stored
+         * in @p cache and stores the result there as well. See
+         * @ref PipelineCache for more information.
+         * @see @ref PipelineCache::createPipelines()
+         */
+        explicit Pipeline(Device& device, const RasterizationPipelineCreateInfo& info, PipelineCache& cache);
+
         /**
          * @brief Construct a compute pipeline
          * @param device    Vulkan device to create the pipeline on
@@ -156,6 +172,21 @@ class MAGNUM_VK_EXPORT Pipeline {
          */
         explicit Pipeline(Device& device, const ComputePipelineCreateInfo& info);
 
+        /**
+         * @brief Construct a compute pipeline using a pipeline cache
+         * @param device    Vulkan device to create the pipeline on
+         * @param info      Compute pipeline creation info
+         * @param cache     Pipeline cache
+         * @m_since_latest
+         *
+         * Compared to @ref Pipeline(Device&, const ComputePipelineCreateInfo&)
+         * the driver can reuse results of previous pipeline creations stored
+         * in @p cache and stores the result there as well. See
+         * @ref PipelineCache for more information.
+         * @see @ref PipelineCache::createPipelines()
+         */
+        explicit Pipeline(Device& device, const ComputePipelineCreateInfo& info, PipelineCache& cache);
+
         /**
          * @brief Construct without creating the pipeline layout
          *
@@ -223,6 +254,9 @@ class MAGNUM_VK_EXPORT Pipeline {
         VkPipeline release();
 
     private:
+        MAGNUM_VK_LOCAL explicit Pipeline(Device& device, const RasterizationPipelineCreateInfo& info, VkPipelineCache cache);
+        MAGNUM_VK_LOCAL explicit Pipeline(Device& device, const ComputePipelineCreateInfo& info, VkPipelineCache cache);
+
         /* Can't be a reference because of the NoCreate constructor */
         Device* _device;
 
@@ -852,6 +886,165 @@ class MAGNUM_VK_EXPORT ImageMemoryBarrier {
         VkImageMemoryBarrier _barrier;
 };
 
+/**
+@brief Dependency info
+@m_since_latest
+
+Wraps a @type_vk_keyword{DependencyInfoKHR}. Compared to passing
+@ref MemoryBarrier, @ref BufferMemoryBarrier and @ref ImageMemoryBarrier
+instances to @ref CommandBuffer::pipelineBarrier(PipelineStages, PipelineStages, Containers::ArrayView<const MemoryBarrier>, Containers::ArrayView<const BufferMemoryBarrier>, Containers::ArrayView<const ImageMemoryBarrier>, DependencyFlags),
+each barrier has its own source and destination @ref PipelineStages, which
+allows the driver to avoid waiting for stages that only some of the barriers
+depend on. The structure is subsequently passed to
+@ref CommandBuffer::pipelineBarrier(const DependencyInfo&):
+
+@snippet MagnumVk.cpp DependencyInfo-usage
+
+If @ref DeviceFeature::Synchronization2 is enabled on the device, the barriers
+are passed as-is to @fn_vk_keyword{CmdPipelineBarrier2KHR}. Otherwise the
+stages of all barriers are merged together and the barriers are submitted
+with a single @fn_vk{CmdPipelineBarrier} call, which is still correct but
+potentially synchronizes more than necessary.
+*/
+class MAGNUM_VK_EXPORT DependencyInfo {
+    public:
+        /**
+         * @brief Constructor
+         * @param dependencyFlags   Dependency flags
+         *
+         * The following @type_vk{DependencyInfoKHR} fields are pre-filled in
+         * addition to `sType`, everything else is zero-filled:
+         *
+         * -    `dependencyFlags`
+         *
+         * @see @ref addMemoryBarrier(), @ref addBufferMemoryBarrier(),
+         *      @ref addImageMemoryBarrier()
+         */
+        explicit DependencyInfo(DependencyFlags dependencyFlags = {});
+
+        /**
+         * @brief Construct without initializing the contents
+         *
+         * Note that not even the `sType` field is set --- the structure has to
+         * be fully initialized afterwards in order to be usable.
+         */
+        explicit DependencyInfo(NoInitT) noexcept;
+
+        /**
+         * @brief Construct from existing data
+         *
+         * Copies the existing values verbatim, pointers are kept unchanged
+         * without taking over the ownership. Modifying the newly created
+         * instance will not modify the original data nor the pointed-to data.
+         */
+        explicit DependencyInfo(const VkDependencyInfoKHR& info);
+
+        /** @brief Copying is not allowed */
+        DependencyInfo(const DependencyInfo&) = delete;
+
+        /** @brief Move constructor */
+        DependencyInfo(DependencyInfo&& other) noexcept;
+
+        ~DependencyInfo();
+
+        /** @brief Copying is not allowed */
+        DependencyInfo& operator=(const DependencyInfo&) = delete;
+
+        /** @brief Move assignment */
+        DependencyInfo& operator=(DependencyInfo&& other) noexcept;
+
+        /**
+         * @brief Add a global memory barrier
+         * @param sourceStages          Source stages
+         * @param sourceAccesses        Source memory access types
+         *      participating in a dependency
+         * @param destinationStages     Destination stages
+         * @param destinationAccesses   Destination memory access types
+         *      participating in a dependency
+         * @return Reference to self (for method chaining)
+         *
+         * Unlike with @ref CommandBuffer::pipelineBarrier(PipelineStages, PipelineStages, Containers::ArrayView<const MemoryBarrier>, Containers::ArrayView<const BufferMemoryBarrier>, Containers::ArrayView<const ImageMemoryBarrier>, DependencyFlags),
+         * the stages are allowed to be empty. Adds a
+         * @type_vk_keyword{MemoryBarrier2KHR} structure to the
+         * `pMemoryBarriers` list.
+         */
+        DependencyInfo& addMemoryBarrier(PipelineStages sourceStages, Accesses sourceAccesses, PipelineStages destinationStages, Accesses destinationAccesses);
+
+        /**
+         * @brief Add a memory barrier affecting a single buffer
+         * @param sourceStages          Source stages
+         * @param sourceAccesses        Source memory access types
+         *      participating in a dependency
+         * @param destinationStages     Destination stages
+         * @param destinationAccesses   Destination memory access types
+         *      participating in a dependency
+         * @param buffer                A @ref Buffer or a raw Vulkan buffer
+         *      handle affected by the barrier
+         * @param offset                Buffer memory offset affected by the
+         *      barrier, in bytes
+         * @param size                  Buffer memory size affected by the
+         *      barrier, in bytes
+         * @return Reference to self (for method chaining)
+         *
+         * Adds a @type_vk_keyword{BufferMemoryBarrier2KHR} structure to the
+         * `pBufferMemoryBarriers` list.
+         */
+        DependencyInfo& addBufferMemoryBarrier(PipelineStages sourceStages, Accesses sourceAccesses, PipelineStages destinationStages, Accesses destinationAccesses, VkBuffer buffer, UnsignedLong offset = 0, UnsignedLong size = VK_WHOLE_SIZE);
+
+        /**
+         * @brief Add a memory barrier affecting a single image
+         * @param sourceStages          Source stages
+         * @param sourceAccesses        Source memory access types
+         *      participating in a dependency
+         * @param destinationStages     Destination stages
+         * @param destinationAccesses   Destination memory access types
+         *      participating in a dependency
+         * @param oldLayout             Old layout in an image layout
+         *      transition
+         * @param newLayout             New layout in an image layout
+         *      transition
+         * @param image                 An @ref Image or a raw Vulkan image
+         *      handle affected by the barrier
+         * @param aspects               Image aspects affected by the barrier
+         * @param layerOffset           Offset to the first layer affected by
+         *      the barrier
+         * @param layerCount            Layer count affected by the barrier
+         * @param levelOffset           Offset to the first mip level affected
+         *      by the barrier
+         * @param levelCount            Mip level count affected by the barrier
+         * @return Reference to self (for method chaining)
+         *
+         * Adds a @type_vk_keyword{ImageMemoryBarrier2KHR} structure to the
+         * `pImageMemoryBarriers` list.
+         */
+        DependencyInfo& addImageMemoryBarrier(PipelineStages sourceStages, Accesses sourceAccesses, PipelineStages destinationStages, Accesses destinationAccesses, ImageLayout oldLayout, ImageLayout newLayout, VkImage image, ImageAspects aspects, UnsignedInt layerOffset = 0, UnsignedInt layerCount = VK_REMAINING_ARRAY_LAYERS, UnsignedInt levelOffset = 0, UnsignedInt levelCount = VK_REMAINING_MIP_LEVELS);
+
+        /**
+         * @brief Add a memory barrier affecting a single image with an implicit image aspect
+         *
+         * Compared to @ref addImageMemoryBarrier(PipelineStages, Accesses, PipelineStages, Accesses, ImageLayout, ImageLayout, VkImage, ImageAspects, UnsignedInt, UnsignedInt, UnsignedInt, UnsignedInt)
+         * the @ref ImageAspects are chosen implicitly using
+         * @ref imageAspectsFor() from @ref Image::format().
+         */
+        DependencyInfo& addImageMemoryBarrier(PipelineStages sourceStages, Accesses sourceAccesses, PipelineStages destinationStages, Accesses destinationAccesses, ImageLayout oldLayout, ImageLayout newLayout, Image& image, UnsignedInt layerOffset = 0, UnsignedInt layerCount = VK_REMAINING_ARRAY_LAYERS, UnsignedInt levelOffset = 0, UnsignedInt levelCount = VK_REMAINING_MIP_LEVELS);
+
+        /** @brief Underlying @type_vk{DependencyInfoKHR} structure */
+        VkDependencyInfoKHR& operator*() { return _info; }
+        /** @overload */
+        const VkDependencyInfoKHR& operator*() const { return _info; }
+        /** @overload */
+        VkDependencyInfoKHR* operator->() { return &_info; }
+        /** @overload */
+        const VkDependencyInfoKHR* operator->() const { return &_info; }
+        /** @overload */
+        operator const VkDependencyInfoKHR*() const { return &_info; }
+
+    private:
+        VkDependencyInfoKHR _info;
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
 }}
 
 #endif
@@ -0,0 +1,230 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "PipelineCache.h"
+#include "PipelineCacheCreateInfo.h"
+
+#include <cstring>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Reference.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/Utility/Path.h>
+#if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+#include <atomic>
+#include <thread>
+#endif
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Vk/Assert.h"
+#include "Magnum/Vk/Device.h"
+#include "Magnum/Vk/DeviceProperties.h"
+#include "Magnum/Vk/Pipeline.h"
+
+namespace Magnum { namespace Vk {
+
+PipelineCacheCreateInfo::PipelineCacheCreateInfo(const Containers::ArrayView<const void> data, const Flags flags): _info{} {
+    _info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    _info.flags = VkPipelineCacheCreateFlags(flags);
+    _info.pInitialData = data.data();
+    _info.initialDataSize = data.size();
+}
+
+PipelineCacheCreateInfo::PipelineCacheCreateInfo(NoInitT) noexcept {}
+
+PipelineCacheCreateInfo::PipelineCacheCreateInfo(const VkPipelineCacheCreateInfo& info):
+    /* Can't use {} with GCC 4.8 here because it tries to initialize the first
+       member instead of doing a copy */
+    _info(info) {}
+
+PipelineCache PipelineCache::wrap(Device& device, const VkPipelineCache handle, const HandleFlags flags) {
+    PipelineCache out{NoCreate};
+    out._device = &device;
+    out._handle = handle;
+    out._flags = flags;
+    return out;
+}
+
+PipelineCache PipelineCache::load(Device& device, const Containers::StringView filename) {
+    /* A missing file is the expected case on the first run, so don't
+       complain about those */
+    Containers::Optional<Containers::Array<char>> data;
+    if(Utility::Path::exists(filename))
+        data = Utility::Path::read(filename);
+    if(!data) return PipelineCache{device};
+
+    /* The constructor checks the header compatibility */
+    return PipelineCache{device, PipelineCacheCreateInfo{*data}};
+}
+
+bool PipelineCache::isCompatible(DeviceProperties& properties, const Containers::ArrayView<const void> data) {
+    VkPipelineCacheHeaderVersionOne header;
+    if(data.size() < sizeof(header)) return false;
+    std::memcpy(&header, data.data(), sizeof(header));
+
+    const VkPhysicalDeviceProperties& deviceProperties = properties.properties().properties;
+    return header.headerSize >= sizeof(header) &&
+        header.headerSize <= data.size() &&
+        header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+        header.vendorID == deviceProperties.vendorID &&
+        header.deviceID == deviceProperties.deviceID &&
+        std::memcmp(header.pipelineCacheUUID, deviceProperties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
+
+PipelineCache::PipelineCache(Device& device, const PipelineCacheCreateInfo& info): _device{&device}, _flags{HandleFlag::DestroyOnDestruction} {
+    /* Some drivers crash on data coming from a different device or driver
+       version instead of ignoring them, so check the header first */
+    VkPipelineCacheCreateInfo checkedInfo = *info;
+    if(checkedInfo.initialDataSize && !isCompatible(device.properties(), {checkedInfo.pInitialData, checkedInfo.initialDataSize})) {
+        checkedInfo.pInitialData = nullptr;
+        checkedInfo.initialDataSize = 0;
+    }
+
+    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS(device->CreatePipelineCache(device, &checkedInfo, nullptr, &_handle));
+}
+
+PipelineCache::PipelineCache(Device& device): PipelineCache{device, PipelineCacheCreateInfo{}} {}
+
+PipelineCache::PipelineCache(NoCreateT): _device{}, _handle{} {}
+
+PipelineCache::PipelineCache(PipelineCache&& other) noexcept: _device{other._device}, _handle{other._handle}, _flags{other._flags} {
+    other._handle = {};
+}
+
+PipelineCache::~PipelineCache() {
+    if(_handle && (_flags & HandleFlag::DestroyOnDestruction))
+        (**_device).DestroyPipelineCache(*_device, _handle, nullptr);
+}
+
+PipelineCache& PipelineCache::operator=(PipelineCache&& other) noexcept {
+    using std::swap;
+    swap(other._device, _device);
+    swap(other._handle, _handle);
+    swap(other._flags, _flags);
+    return *this;
+}
+
+Containers::Array<char> PipelineCache::data() {
+    std::size_t size;
+    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS((**_device).GetPipelineCacheData(*_device, _handle, &size, nullptr));
+
+    /* The size reported by the first call is the upper bound, the second call
+       returns the actual amount written */
+    Containers::Array<char> out{NoInit, size};
+    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS((**_device).GetPipelineCacheData(*_device, _handle, &size, out.data()));
+    CORRADE_INTERNAL_ASSERT(size == out.size());
+    return out;
+}
+
+bool PipelineCache::save(const Containers::StringView filename) {
+    using namespace Containers::Literals;
+
+    /* Write to a temporary file first and then move it over so concurrently
+       running instances never see a partially written file */
+    const Containers::String temporary = filename + ".tmp"_s;
+    return Utility::Path::write(temporary, data()) &&
+        Utility::Path::move(temporary, filename);
+}
+
+PipelineCache& PipelineCache::merge(const Containers::ArrayView<const Containers::Reference<PipelineCache>> caches) {
+    Containers::Array<VkPipelineCache> handles{NoInit, caches.size()};
+    for(std::size_t i = 0; i != caches.size(); ++i) {
+        CORRADE_ASSERT(&caches[i].get() != this,
+            "Vk::PipelineCache::merge(): can't merge a cache into itself", *this);
+        handles[i] = caches[i]->handle();
+    }
+
+    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS((**_device).MergePipelineCaches(*_device, _handle, handles.size(), handles));
+    return *this;
+}
+
+PipelineCache& PipelineCache::merge(const std::initializer_list<Containers::Reference<PipelineCache>> caches) {
+    return merge(Containers::arrayView(caches));
+}
+
+namespace {
+
+template<class T> Containers::Array<Pipeline> createPipelinesImplementation(Device& device, PipelineCache& cache, const Containers::ArrayView<const Containers::Reference<const T>> infos, UnsignedInt threadCount) {
+    Containers::Array<Pipeline> out{DirectInit, infos.size(), NoCreate};
+
+    #if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+    if(!threadCount) threadCount = std::thread::hardware_concurrency();
+    threadCount = Math::min(threadCount, UnsignedInt(infos.size()));
+    if(threadCount > 1) {
+        /* Pipelines can take vastly different time to compile, so instead of
+           splitting the infos into fixed chunks each thread picks the next
+           unprocessed one. The cache is internally synchronized, so all
+           threads can use it directly. */
+        std::atomic<std::size_t> next{0};
+        const auto worker = [&]() {
+            for(std::size_t i; (i = next++) < infos.size(); )
+                out[i] = Pipeline{device, *infos[i], cache};
+        };
+
+        /* The calling thread does its share of the work as well */
+        Containers::Array<std::thread> threads{threadCount - 1};
+        for(std::thread& thread: threads)
+            thread = std::thread{worker};
+        worker();
+        for(std::thread& thread: threads)
+            thread.join();
+
+        return out;
+    }
+    #else
+    static_cast<void>(threadCount);
+    #endif
+
+    for(std::size_t i = 0; i != infos.size(); ++i)
+        out[i] = Pipeline{device, *infos[i], cache};
+    return out;
+}
+
+}
+
+Containers::Array<Pipeline> PipelineCache::createPipelines(const Containers::ArrayView<const Containers::Reference<const RasterizationPipelineCreateInfo>> infos, const UnsignedInt threadCount) {
+    return createPipelinesImplementation(*_device, *this, infos, threadCount);
+}
+
+Containers::Array<Pipeline> PipelineCache::createPipelines(const std::initializer_list<Containers::Reference<const RasterizationPipelineCreateInfo>> infos, const UnsignedInt threadCount) {
+    return createPipelines(Containers::arrayView(infos), threadCount);
+}
+
+Containers::Array<Pipeline> PipelineCache::createPipelines(const Containers::ArrayView<const Containers::Reference<const ComputePipelineCreateInfo>> infos, const UnsignedInt threadCount) {
+    return createPipelinesImplementation(*_device, *this, infos, threadCount);
+}
+
+Containers::Array<Pipeline> PipelineCache::createPipelines(const std::initializer_list<Containers::Reference<const ComputePipelineCreateInfo>> infos, const UnsignedInt threadCount) {
+    return createPipelines(Containers::arrayView(infos), threadCount);
+}
+
+VkPipelineCache PipelineCache::release() {
+    const VkPipelineCache handle = _handle;
+    _handle = {};
+    return handle;
+}
+
+}}
@@ -0,0 +1,267 @@
+#ifndef Magnum_Vk_PipelineCache_h
+#define Magnum_Vk_PipelineCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Vk::PipelineCache
+ * @m_since_latest
+ */
+
+#include <initializer_list>
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Tags.h"
+#include "Magnum/Vk/Handle.h"
+#include "Magnum/Vk/Vk.h"
+#include "Magnum/Vk/Vulkan.h"
+#include "Magnum/Vk/visibility.h"
+
+namespace Magnum { namespace Vk {
+
+/**
+@brief Pipeline cache
+@m_since_latest
+
+Wraps a @type_vk_keyword{PipelineCache}, which lets the driver reuse results
+of shader compilation across @ref Pipeline creations and, if persisted, across
+application runs.
+
+@section Vk-PipelineCache-creation Pipeline cache creation
+
+An empty cache can be constructed directly using
+@ref PipelineCache(Device&, const PipelineCacheCreateInfo&), leaving the
+@p info parameter at its default. The cache is then passed to the
+@ref Pipeline::Pipeline(Device&, const RasterizationPipelineCreateInfo&, PipelineCache&)
+or @ref Pipeline::Pipeline(Device&, const ComputePipelineCreateInfo&, PipelineCache&)
+constructors:
+
+@snippet MagnumVk.cpp PipelineCache-creation
+
+@section Vk-PipelineCache-persistence Persisting the cache on disk
+
+Use @ref save() to write the cache contents to a file and @ref load() to
+create a cache from it again in the next run. The data are prefixed with a
+@type_vk{PipelineCacheHeaderVersionOne} header identifying the device and
+driver that produced them. Since some drivers don't handle data produced
+by a different device or driver version gracefully, initial data passed to
+the constructor are checked with @ref isCompatible() and if they don't match
+@ref DeviceProperties of the device, the cache is created empty instead.
+
+@snippet MagnumVk.cpp PipelineCache-persistence
+
+@section Vk-PipelineCache-batch Batch pipeline creation
+
+Pipeline creation is where the shaders get compiled and is thus expensive,
+@ref createPipelines() creates a batch of pipelines on multiple threads,
+all of them using this cache:
+
+@snippet MagnumVk.cpp PipelineCache-batch
+
+Pipeline caches are internally synchronized, so a single cache can be also
+used from multiple threads directly. Alternatively, each thread can use its
+own cache and the results can be combined together with @ref merge().
+*/
+class MAGNUM_VK_EXPORT PipelineCache {
+    public:
+        /**
+         * @brief Wrap existing Vulkan handle
+         * @param device            Vulkan device the pipeline cache is
+         *      created on
+         * @param handle            The @type_vk{PipelineCache} handle
+         * @param flags             Handle flags
+         *
+         * The @p handle is expected to be originating from @p device. Unlike
+         * a pipeline cache created using a constructor, the Vulkan pipeline
+         * cache is by default not deleted on destruction, use @p flags for
+         * different behavior.
+         * @see @ref release()
+         */
+        static PipelineCache wrap(Device& device, VkPipelineCache handle, HandleFlags flags = {});
+
+        /**
+         * @brief Load a pipeline cache from a file
+         * @param device    Vulkan device to create the pipeline cache on
+         * @param filename  File previously written with @ref save()
+         *
+         * If the file doesn't exist, can't be read or its contents aren't
+         * compatible with @p device according to @ref isCompatible(), an
+         * empty cache is created.
+         */
+        static PipelineCache load(Device& device, Containers::StringView filename);
+
+        /**
+         * @brief Whether pipeline cache data are compatible with given device
+         *
+         * Returns @cpp true @ce if @p data start with a valid
+         * @type_vk{PipelineCacheHeaderVersionOne} and its `vendorID`,
+         * `deviceID` and `pipelineCacheUUID` match the
+         * @type_vk{PhysicalDeviceProperties} of @p properties,
+         * @cpp false @ce otherwise. The driver is still free to reject
+         * compatible data, for example if they're corrupted.
+         */
+        static bool isCompatible(DeviceProperties& properties, Containers::ArrayView<const void> data);
+
+        /**
+         * @brief Constructor
+         * @param device    Vulkan device to create the pipeline cache on
+         * @param info      Pipeline cache creation info
+         *
+         * If the initial data in @p info aren't compatible with @p device
+         * according to @ref isCompatible(), they're ignored and the cache is
+         * created empty.
+         * @see @fn_vk_keyword{CreatePipelineCache}
+         */
+        #ifdef DOXYGEN_GENERATING_OUTPUT
+        explicit PipelineCache(Device& device, const PipelineCacheCreateInfo& info = PipelineCacheCreateInfo{});
+        #else
+        explicit PipelineCache(Device& device, const PipelineCacheCreateInfo& info);
+        explicit PipelineCache(Device& device);
+        #endif
+
+        /**
+         * @brief Construct without creating the pipeline cache
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit PipelineCache(NoCreateT);
+
+        /** @brief Copying is not allowed */
+        PipelineCache(const PipelineCache&) = delete;
+
+        /** @brief Move constructor */
+        PipelineCache(PipelineCache&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Destroys associated @type_vk{PipelineCache} handle, unless the
+         * instance was created using @ref wrap() without
+         * @ref HandleFlag::DestroyOnDestruction specified.
+         * @see @fn_vk_keyword{DestroyPipelineCache}, @ref release()
+         */
+        ~PipelineCache();
+
+        /** @brief Copying is not allowed */
+        PipelineCache& operator=(const PipelineCache&) = delete;
+
+        /** @brief Move assignment */
+        PipelineCache& operator=(PipelineCache&& other) noexcept;
+
+        /** @brief Underlying @type_vk{PipelineCache} handle */
+        VkPipelineCache handle() { return _handle; }
+        /** @overload */
+        operator VkPipelineCache() { return _handle; }
+
+        /** @brief Handle flags */
+        HandleFlags handleFlags() const { return _flags; }
+
+        /**
+         * @brief Pipeline cache data
+         *
+         * The data can be passed to @ref PipelineCacheCreateInfo in a later
+         * run of the application.
+         * @see @ref save(), @fn_vk_keyword{GetPipelineCacheData}
+         */
+        Containers::Array<char> data();
+
+        /**
+         * @brief Save the pipeline cache to a file
+         * @return @cpp true @ce on success, @cpp false @ce otherwise
+         *
+         * Writes @ref data() to a temporary file in the same directory first
+         * and then moves it over @p filename, so other running instances of
+         * the application never see a partially written file.
+         * @see @ref load()
+         */
+        bool save(Containers::StringView filename);
+
+        /**
+         * @brief Merge other pipeline caches into this one
+         * @return Reference to self (for method chaining)
+         *
+         * The @p caches are expected to not contain this cache.
+         * @see @fn_vk_keyword{MergePipelineCaches}
+         */
+        PipelineCache& merge(Containers::ArrayView<const Containers::Reference<PipelineCache>> caches);
+
+        /** @overload */
+        PipelineCache& merge(std::initializer_list<Containers::Reference<PipelineCache>> caches);
+
+        /**
+         * @brief Create rasterization pipelines in parallel
+         * @param infos         Rasterization pipeline creation infos
+         * @param threadCount   Max count of threads to use. If @cpp 0 @ce,
+         *      @ref std::thread::hardware_concurrency() is used.
+         * @return Pipelines corresponding to @p infos
+         *
+         * The @p infos are distributed over up to @p threadCount threads,
+         * each creating the pipelines using
+         * @ref Pipeline::Pipeline(Device&, const RasterizationPipelineCreateInfo&, PipelineCache&)
+         * with this cache. If Corrade isn't built with
+         * @ref CORRADE_BUILD_MULTITHREADED or on Emscripten, the pipelines
+         * are created sequentially on the calling thread.
+         */
+        Containers::Array<Pipeline> createPipelines(Containers::ArrayView<const Containers::Reference<const RasterizationPipelineCreateInfo>> infos, UnsignedInt threadCount = 0);
+
+        /** @overload */
+        Containers::Array<Pipeline> createPipelines(std::initializer_list<Containers::Reference<const RasterizationPipelineCreateInfo>> infos, UnsignedInt threadCount = 0);
+
+        /**
+         * @brief Create compute pipelines in parallel
+         *
+         * Like @ref createPipelines(Containers::ArrayView<const Containers::Reference<const RasterizationPipelineCreateInfo>>, UnsignedInt),
+         * but using @ref Pipeline::Pipeline(Device&, const ComputePipelineCreateInfo&, PipelineCache&).
+         */
+        Containers::Array<Pipeline> createPipelines(Containers::ArrayView<const Containers::Reference<const ComputePipelineCreateInfo>> infos, UnsignedInt threadCount = 0);
+
+        /** @overload */
+        Containers::Array<Pipeline> createPipelines(std::initializer_list<Containers::Reference<const ComputePipelineCreateInfo>> infos, UnsignedInt threadCount = 0);
+
+        /**
+         * @brief Release the underlying Vulkan pipeline cache
+         *
+         * Releases ownership of the Vulkan pipeline cache and returns its
+         * handle so @fn_vk{DestroyPipelineCache} is not called on
+         * destruction. The internal state is then equivalent to moved-from
+         * state.
+         * @see @ref wrap()
+         */
+        VkPipelineCache release();
+
+    private:
+        /* Can't be a reference because of the NoCreate constructor */
+        Device* _device;
+
+        VkPipelineCache _handle;
+        HandleFlags _flags;
+};
+
+}}
+
+#endif
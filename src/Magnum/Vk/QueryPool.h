@@ -0,0 +1,336 @@
+#ifndef Magnum_Vk_QueryPool_h
+#define Magnum_Vk_QueryPool_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+/** @file
+ * @brief Class @ref Magnum::Vk::QueryPool, enum @ref Magnum::Vk::QueryType, @ref Magnum::Vk::QueryPipelineStatistic, @ref Magnum::Vk::QueryControlFlag, @ref Magnum::Vk::QueryResultFlag, enum set @ref Magnum::Vk::QueryPipelineStatistics, @ref Magnum::Vk::QueryControlFlags, @ref Magnum::Vk::QueryResultFlags
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/EnumSet.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Tags.h"
+#include "Magnum/Vk/Handle.h"
+#include "Magnum/Vk/Vk.h"
+#include "Magnum/Vk/Vulkan.h"
+#include "Magnum/Vk/visibility.h"
+
+namespace Magnum { namespace Vk {
+
+/**
+@brief Query type
+@m_since_latest
+
+Wraps a @type_vk_keyword{QueryType}.
+@see @ref QueryPoolCreateInfo
+@m_enum_values_as_keywords
+*/
+enum class QueryType: Int {
+    /**
+     * Occlusion query. Counts samples passing the depth and stencil tests
+     * between @ref CommandBuffer::beginQuery() and
+     * @ref CommandBuffer::endQuery().
+     */
+    Occlusion = VK_QUERY_TYPE_OCCLUSION,
+
+    /**
+     * Pipeline statistics query. Counts values selected by
+     * @ref QueryPipelineStatistics between @ref CommandBuffer::beginQuery()
+     * and @ref CommandBuffer::endQuery().
+     * @requires_vk_feature @ref DeviceFeature::PipelineStatisticsQuery
+     */
+    PipelineStatistics = VK_QUERY_TYPE_PIPELINE_STATISTICS,
+
+    /**
+     * Timestamp query. Written using @ref CommandBuffer::writeTimestamp(),
+     * the value is in units of
+     * @cpp VkPhysicalDeviceLimits::timestampPeriod @ce nanoseconds.
+     */
+    Timestamp = VK_QUERY_TYPE_TIMESTAMP
+};
+
+/**
+@brief Query pipeline statistic
+@m_since_latest
+
+Wraps a @type_vk_keyword{QueryPipelineStatisticFlagBits}. Results of a
+@ref QueryType::PipelineStatistics query are written in the order of the bits
+in this enum.
+@see @ref QueryPipelineStatistics, @ref QueryPoolCreateInfo
+@m_enum_values_as_keywords
+*/
+enum class QueryPipelineStatistic: UnsignedInt {
+    /** Count of vertices processed by the input assembly stage */
+    InputAssemblyVertices = VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_VERTICES_BIT,
+
+    /** Count of primitives processed by the input assembly stage */
+    InputAssemblyPrimitives = VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_PRIMITIVES_BIT,
+
+    /** Count of vertex shader invocations */
+    VertexShaderInvocations = VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT,
+
+    /** Count of geometry shader invocations */
+    GeometryShaderInvocations = VK_QUERY_PIPELINE_STATISTIC_GEOMETRY_SHADER_INVOCATIONS_BIT,
+
+    /** Count of primitives generated by geometry shader invocations */
+    GeometryShaderPrimitives = VK_QUERY_PIPELINE_STATISTIC_GEOMETRY_SHADER_PRIMITIVES_BIT,
+
+    /** Count of primitives processed by the primitive clipping stage */
+    ClippingInvocations = VK_QUERY_PIPELINE_STATISTIC_CLIPPING_INVOCATIONS_BIT,
+
+    /** Count of primitives output by the primitive clipping stage */
+    ClippingPrimitives = VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT,
+
+    /** Count of fragment shader invocations */
+    FragmentShaderInvocations = VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT,
+
+    /** Count of patches processed by the tessellation control shader */
+    TessellationControlShaderPatches = VK_QUERY_PIPELINE_STATISTIC_TESSELLATION_CONTROL_SHADER_PATCHES_BIT,
+
+    /** Count of tessellation evaluation shader invocations */
+    TessellationEvaluationShaderInvocations = VK_QUERY_PIPELINE_STATISTIC_TESSELLATION_EVALUATION_SHADER_INVOCATIONS_BIT,
+
+    /** Count of compute shader invocations */
+    ComputeShaderInvocations = VK_QUERY_PIPELINE_STATISTIC_COMPUTE_SHADER_INVOCATIONS_BIT
+};
+
+/**
+@brief Query pipeline statistics
+@m_since_latest
+
+Type-safe wrapper for @type_vk_keyword{QueryPipelineStatisticFlags}.
+@see @ref QueryPoolCreateInfo
+*/
+typedef Containers::EnumSet<QueryPipelineStatistic> QueryPipelineStatistics;
+
+CORRADE_ENUMSET_OPERATORS(QueryPipelineStatistics)
+
+/**
+@brief Query control flag
+@m_since_latest
+
+Wraps a @type_vk_keyword{QueryControlFlagBits}.
+@see @ref QueryControlFlags, @ref CommandBuffer::beginQuery()
+@m_enum_values_as_keywords
+*/
+enum class QueryControlFlag: UnsignedInt {
+    /**
+     * Return an exact sample count from a @ref QueryType::Occlusion query
+     * instead of just a non-zero value if any samples passed.
+     * @requires_vk_feature @ref DeviceFeature::OcclusionQueryPrecise
+     */
+    Precise = VK_QUERY_CONTROL_PRECISE_BIT
+};
+
+/**
+@brief Query control flags
+@m_since_latest
+
+Type-safe wrapper for @type_vk_keyword{QueryControlFlags}.
+@see @ref CommandBuffer::beginQuery()
+*/
+typedef Containers::EnumSet<QueryControlFlag> QueryControlFlags;
+
+CORRADE_ENUMSET_OPERATORS(QueryControlFlags)
+
+/**
+@brief Query result flag
+@m_since_latest
+
+Wraps a @type_vk_keyword{QueryResultFlagBits}. The
+@def_vk_keyword{QUERY_RESULT_64_BIT,QueryResultFlagBits} is implicitly
+always set by @ref QueryPool::results().
+@see @ref QueryResultFlags
+@m_enum_values_as_keywords
+*/
+enum class QueryResultFlag: UnsignedInt {
+    /** Wait until results of all queries are available */
+    Wait = VK_QUERY_RESULT_WAIT_BIT,
+
+    /**
+     * Write availability of each query after its results. If not set,
+     * @ref QueryPool::results() returns @cpp false @ce if any of the results
+     * isn't available yet.
+     */
+    WithAvailability = VK_QUERY_RESULT_WITH_AVAILABILITY_BIT,
+
+    /**
+     * Return partial results of queries that aren't available yet. Not
+     * allowed for @ref QueryType::Timestamp.
+     */
+    Partial = VK_QUERY_RESULT_PARTIAL_BIT
+};
+
+/**
+@brief Query result flags
+@m_since_latest
+
+Type-safe wrapper for @type_vk_keyword{QueryResultFlags}.
+@see @ref QueryPool::results()
+*/
+typedef Containers::EnumSet<QueryResultFlag> QueryResultFlags;
+
+CORRADE_ENUMSET_OPERATORS(QueryResultFlags)
+
+/**
+@brief Query pool
+@m_since_latest
+
+Wraps a @type_vk_keyword{QueryPool}, which is used for retrieving GPU
+timestamps, occlusion sample counts and pipeline statistics.
+
+@section Vk-QueryPool-creation Query pool creation
+
+The @ref QueryPoolCreateInfo takes a @ref QueryType and a count of queries in
+the pool. For @ref QueryType::PipelineStatistics it additionally takes a set
+of statistics to collect:
+
+@snippet MagnumVk.cpp QueryPool-creation
+
+@section Vk-QueryPool-usage Basic usage
+
+Queries have to be reset before each use with
+@ref CommandBuffer::resetQueryPool(). Timestamps are then written with
+@ref CommandBuffer::writeTimestamp(), other query types are recorded between
+@ref CommandBuffer::beginQuery() and @ref CommandBuffer::endQuery(). Once the
+command buffer is executed, the results can be retrieved with
+@ref results():
+
+@snippet MagnumVk.cpp QueryPool-usage
+
+To avoid stalling the pipeline, the results should be retrieved with a delay
+of a few frames, using a different range of queries for each frame in flight.
+See @ref DebugTools::FrameProfilerVk for a ready-to-use frame profiler built
+on top of query pools.
+*/
+class MAGNUM_VK_EXPORT QueryPool {
+    public:
+        /**
+         * @brief Wrap existing Vulkan handle
+         * @param device            Vulkan device the query pool is created on
+         * @param handle            The @type_vk{QueryPool} handle
+         * @param flags             Handle flags
+         *
+         * The @p handle is expected to be originating from @p device. Unlike
+         * a query pool created using a constructor, the Vulkan query pool is
+         * by default not deleted on destruction, use @p flags for different
+         * behavior.
+         * @see @ref release()
+         */
+        static QueryPool wrap(Device& device, VkQueryPool handle, HandleFlags flags = {});
+
+        /**
+         * @brief Constructor
+         * @param device    Vulkan device to create the query pool on
+         * @param info      Query pool creation info
+         *
+         * @see @fn_vk_keyword{CreateQueryPool}
+         */
+        explicit QueryPool(Device& device, const QueryPoolCreateInfo& info);
+
+        /**
+         * @brief Construct without creating the query pool
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit QueryPool(NoCreateT);
+
+        /** @brief Copying is not allowed */
+        QueryPool(const QueryPool&) = delete;
+
+        /** @brief Move constructor */
+        QueryPool(QueryPool&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Destroys associated @type_vk{QueryPool} handle, unless the instance
+         * was created using @ref wrap() without
+         * @ref HandleFlag::DestroyOnDestruction specified.
+         * @see @fn_vk_keyword{DestroyQueryPool}, @ref release()
+         */
+        ~QueryPool();
+
+        /** @brief Copying is not allowed */
+        QueryPool& operator=(const QueryPool&) = delete;
+
+        /** @brief Move assignment */
+        QueryPool& operator=(QueryPool&& other) noexcept;
+
+        /** @brief Underlying @type_vk{QueryPool} handle */
+        VkQueryPool handle() { return _handle; }
+        /** @overload */
+        operator VkQueryPool() { return _handle; }
+
+        /** @brief Handle flags */
+        HandleFlags handleFlags() const { return _flags; }
+
+        /**
+         * @brief Retrieve query results
+         * @param first     First query
+         * @param count     Query count
+         * @param data      Where to put the results
+         * @param flags     Result flags
+         * @return @cpp true @ce if all results were available,
+         *      @cpp false @ce otherwise
+         *
+         * Results are written as 64-bit values, @p data is expected to have a
+         * size divisible by @p count. Results of each query occupy
+         * @cpp data.size()/count @ce items --- one for
+         * @ref QueryType::Occlusion and @ref QueryType::Timestamp, one for
+         * each statistic for @ref QueryType::PipelineStatistics, and
+         * additionally one more if @ref QueryResultFlag::WithAvailability is
+         * set. If neither @ref QueryResultFlag::Wait nor
+         * @ref QueryResultFlag::WithAvailability is set and some results
+         * aren't available yet, @cpp false @ce is returned and contents of
+         * @p data for the unavailable queries are undefined.
+         * @see @fn_vk_keyword{GetQueryPoolResults}
+         */
+        bool results(UnsignedInt first, UnsignedInt count, Containers::ArrayView<UnsignedLong> data, QueryResultFlags flags = {});
+
+        /**
+         * @brief Release the underlying Vulkan query pool
+         *
+         * Releases ownership of the Vulkan query pool and returns its handle
+         * so @fn_vk{DestroyQueryPool} is not called on destruction. The
+         * internal state is then equivalent to moved-from state.
+         * @see @ref wrap()
+         */
+        VkQueryPool release();
+
+    private:
+        /* Can't be a reference because of the NoCreate constructor */
+        Device* _device;
+
+        VkQueryPool _handle;
+        HandleFlags _flags;
+};
+
+}}
+
+#endif
@@ -0,0 +1,104 @@
+#ifndef Magnum_Vk_QueryPoolCreateInfo_h
+#define Magnum_Vk_QueryPoolCreateInfo_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+/** @file
+ * @brief Class @ref Magnum::Vk::QueryPoolCreateInfo
+ * @m_since_latest
+ */
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Tags.h"
+#include "Magnum/Vk/QueryPool.h"
+#include "Magnum/Vk/visibility.h"
+#include "Magnum/Vk/Vk.h"
+#include "Magnum/Vk/Vulkan.h"
+
+namespace Magnum { namespace Vk {
+
+/**
+@brief Query pool creation info
+@m_since_latest
+
+Wraps a @type_vk_keyword{QueryPoolCreateInfo}. See
+@ref Vk-QueryPool-creation "Query pool creation" for usage information.
+*/
+class MAGNUM_VK_EXPORT QueryPoolCreateInfo {
+    public:
+        /**
+         * @brief Constructor
+         * @param type          Query type
+         * @param count         Query count
+         * @param statistics    Pipeline statistics to collect if @p type is
+         *      @ref QueryType::PipelineStatistics
+         *
+         * The following @type_vk{QueryPoolCreateInfo} fields are pre-filled
+         * in addition to `sType`, everything else is zero-filled:
+         *
+         * -    `queryType` to @p type
+         * -    `queryCount` to @p count
+         * -    `pipelineStatistics` to @p statistics
+         *
+         * Expects that @p count is non-zero and that @p statistics are
+         * non-empty if and only if @p type is
+         * @ref QueryType::PipelineStatistics.
+         */
+        explicit QueryPoolCreateInfo(QueryType type, UnsignedInt count, QueryPipelineStatistics statistics = {});
+
+        /**
+         * @brief Construct without initializing the contents
+         *
+         * Note that not even the `sType` field is set --- the structure has to
+         * be fully initialized afterwards in order to be usable.
+         */
+        explicit QueryPoolCreateInfo(NoInitT) noexcept;
+
+        /**
+         * @brief Construct from existing data
+         *
+         * Copies the existing values verbatim, pointers are kept unchanged
+         * without taking over the ownership. Modifying the newly created
+         * instance will not modify the original data nor the pointed-to data.
+         */
+        explicit QueryPoolCreateInfo(const VkQueryPoolCreateInfo& info);
+
+        /** @brief Underlying @type_vk{QueryPoolCreateInfo} structure */
+        VkQueryPoolCreateInfo& operator*() { return _info; }
+        /** @overload */
+        const VkQueryPoolCreateInfo& operator*() const { return _info; }
+        /** @overload */
+        VkQueryPoolCreateInfo* operator->() { return &_info; }
+        /** @overload */
+        const VkQueryPoolCreateInfo* operator->() const { return &_info; }
+        /** @overload */
+        operator const VkQueryPoolCreateInfo*() const { return &_info; }
+
+    private:
+        VkQueryPoolCreateInfo _info;
+};
+
+}}
+
+#endif
@@ -32,6 +32,7 @@
 #include "Magnum/Vk/Assert.h"
 #include "Magnum/Vk/Device.h"
 #include "Magnum/Vk/Fence.h"
+#include "Magnum/Vk/Pipeline.h"
 
 namespace Magnum { namespace Vk {
 
@@ -96,6 +97,12 @@ Fence Queue::submit(const std::initializer_list<Containers::Reference<const Subm
 
 struct SubmitInfo::State {
     Containers::Array<VkCommandBuffer> commandBuffers;
+    Containers::Array<VkSemaphore> waitSemaphores;
+    Containers::Array<VkPipelineStageFlags> waitStages;
+    Containers::Array<UnsignedLong> waitValues;
+    Containers::Array<VkSemaphore> signalSemaphores;
+    Containers::Array<UnsignedLong> signalValues;
+    VkTimelineSemaphoreSubmitInfo timelineInfo{};
 };
 
 SubmitInfo::SubmitInfo(): _info{} {
@@ -151,4 +158,94 @@ SubmitInfo& SubmitInfo::setCommandBuffers(const std::initializer_list<VkCommandB
     return setCommandBuffers(Containers::arrayView(buffers));
 }
 
+void SubmitInfo::connectTimelineInfo() {
+    if(_info.pNext == &_state->timelineInfo) return;
+
+    /* Put the structure at the front of the chain, preserving whatever was
+       there before */
+    _state->timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+    _state->timelineInfo.pNext = _info.pNext;
+    _info.pNext = &_state->timelineInfo;
+}
+
+SubmitInfo& SubmitInfo::setWaitSemaphores(const Containers::ArrayView<const VkSemaphore> semaphores, const Containers::ArrayView<const PipelineStages> stages) {
+    CORRADE_ASSERT(stages.size() == semaphores.size(),
+        "Vk::SubmitInfo::setWaitSemaphores(): expected" << semaphores.size() << "stages but got" << stages.size(), *this);
+    if(!_state) _state.emplace();
+
+    _state->waitSemaphores = Containers::Array<VkSemaphore>{NoInit, semaphores.size()};
+    Utility::copy(semaphores, _state->waitSemaphores);
+    _state->waitStages = Containers::Array<VkPipelineStageFlags>{NoInit, stages.size()};
+    for(std::size_t i = 0; i != stages.size(); ++i)
+        _state->waitStages[i] = VkPipelineStageFlags(stages[i]);
+    _info.waitSemaphoreCount = _state->waitSemaphores.size();
+    _info.pWaitSemaphores = _state->waitSemaphores;
+    _info.pWaitDstStageMask = _state->waitStages;
+
+    /* Reset values from a potential previous timeline wait, as the counts
+       would no longer match */
+    _state->waitValues = {};
+    _state->timelineInfo.waitSemaphoreValueCount = 0;
+    _state->timelineInfo.pWaitSemaphoreValues = nullptr;
+    return *this;
+}
+
+SubmitInfo& SubmitInfo::setWaitSemaphores(const std::initializer_list<VkSemaphore> semaphores, const std::initializer_list<PipelineStages> stages) {
+    return setWaitSemaphores(Containers::arrayView(semaphores), Containers::arrayView(stages));
+}
+
+SubmitInfo& SubmitInfo::setWaitSemaphores(const Containers::ArrayView<const VkSemaphore> semaphores, const Containers::ArrayView<const PipelineStages> stages, const Containers::ArrayView<const UnsignedLong> values) {
+    CORRADE_ASSERT(values.size() == semaphores.size(),
+        "Vk::SubmitInfo::setWaitSemaphores(): expected" << semaphores.size() << "values but got" << values.size(), *this);
+    setWaitSemaphores(semaphores, stages);
+
+    _state->waitValues = Containers::Array<UnsignedLong>{NoInit, values.size()};
+    Utility::copy(values, _state->waitValues);
+    _state->timelineInfo.waitSemaphoreValueCount = _state->waitValues.size();
+    _state->timelineInfo.pWaitSemaphoreValues = _state->waitValues;
+    connectTimelineInfo();
+    return *this;
+}
+
+SubmitInfo& SubmitInfo::setWaitSemaphores(const std::initializer_list<VkSemaphore> semaphores, const std::initializer_list<PipelineStages> stages, const std::initializer_list<UnsignedLong> values) {
+    return setWaitSemaphores(Containers::arrayView(semaphores), Containers::arrayView(stages), Containers::arrayView(values));
+}
+
+SubmitInfo& SubmitInfo::setSignalSemaphores(const Containers::ArrayView<const VkSemaphore> semaphores) {
+    if(!_state) _state.emplace();
+
+    _state->signalSemaphores = Containers::Array<VkSemaphore>{NoInit, semaphores.size()};
+    Utility::copy(semaphores, _state->signalSemaphores);
+    _info.signalSemaphoreCount = _state->signalSemaphores.size();
+    _info.pSignalSemaphores = _state->signalSemaphores;
+
+    /* Reset values from a potential previous timeline signal, as the counts
+       would no longer match */
+    _state->signalValues = {};
+    _state->timelineInfo.signalSemaphoreValueCount = 0;
+    _state->timelineInfo.pSignalSemaphoreValues = nullptr;
+    return *this;
+}
+
+SubmitInfo& SubmitInfo::setSignalSemaphores(const std::initializer_list<VkSemaphore> semaphores) {
+    return setSignalSemaphores(Containers::arrayView(semaphores));
+}
+
+SubmitInfo& SubmitInfo::setSignalSemaphores(const Containers::ArrayView<const VkSemaphore> semaphores, const Containers::ArrayView<const UnsignedLong> values) {
+    CORRADE_ASSERT(values.size() == semaphores.size(),
+        "Vk::SubmitInfo::setSignalSemaphores(): expected" << semaphores.size() << "values but got" << values.size(), *this);
+    setSignalSemaphores(semaphores);
+
+    _state->signalValues = Containers::Array<UnsignedLong>{NoInit, values.size()};
+    Utility::copy(values, _state->signalValues);
+    _state->timelineInfo.signalSemaphoreValueCount = _state->signalValues.size();
+    _state->timelineInfo.pSignalSemaphoreValues = _state->signalValues;
+    connectTimelineInfo();
+    return *this;
+}
+
+SubmitInfo& SubmitInfo::setSignalSemaphores(const std::initializer_list<VkSemaphore> semaphores, const std::initializer_list<UnsignedLong> values) {
+    return setSignalSemaphores(Containers::arrayView(semaphores), Containers::arrayView(values));
+}
+
 }}
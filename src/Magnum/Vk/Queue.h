@@ -161,7 +161,8 @@ class MAGNUM_VK_EXPORT SubmitInfo {
          *
          * -    *(none)*
          *
-         * @see @ref setCommandBuffers()
+         * @see @ref setCommandBuffers(), @ref setWaitSemaphores(),
+         *      @ref setSignalSemaphores()
          */
         explicit SubmitInfo();
 
@@ -208,6 +209,73 @@ class MAGNUM_VK_EXPORT SubmitInfo {
         /** @overload */
         SubmitInfo& setCommandBuffers(std::initializer_list<VkCommandBuffer> buffers);
 
+        /**
+         * @brief Set semaphores to wait on before executing the batch
+         * @param semaphores    Semaphores to wait on
+         * @param stages        Pipeline stages at which each wait happens
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @p stages have the same size as @p semaphores. For
+         * @ref SemaphoreType::Timeline semaphores use
+         * @ref setWaitSemaphores(Containers::ArrayView<const VkSemaphore>, Containers::ArrayView<const PipelineStages>, Containers::ArrayView<const UnsignedLong>)
+         * instead.
+         * @see @ref Vk-Semaphore-usage
+         */
+        SubmitInfo& setWaitSemaphores(Containers::ArrayView<const VkSemaphore> semaphores, Containers::ArrayView<const PipelineStages> stages);
+        /** @overload */
+        SubmitInfo& setWaitSemaphores(std::initializer_list<VkSemaphore> semaphores, std::initializer_list<PipelineStages> stages);
+
+        /**
+         * @brief Set semaphores to wait on before executing the batch, with timeline values
+         * @param semaphores    Semaphores to wait on
+         * @param stages        Pipeline stages at which each wait happens
+         * @param values        Values to wait for
+         * @return Reference to self (for method chaining)
+         *
+         * Compared to @ref setWaitSemaphores(Containers::ArrayView<const VkSemaphore>, Containers::ArrayView<const PipelineStages>)
+         * references a @type_vk_keyword{TimelineSemaphoreSubmitInfo}
+         * structure from the `pNext` chain, with `pWaitSemaphoreValues` set
+         * to @p values. Values corresponding to
+         * @ref SemaphoreType::Binary semaphores are ignored. Expects that
+         * both @p stages and @p values have the same size as
+         * @p semaphores.
+         * @requires_vk12 Extension @vk_extension{KHR,timeline_semaphore}
+         */
+        SubmitInfo& setWaitSemaphores(Containers::ArrayView<const VkSemaphore> semaphores, Containers::ArrayView<const PipelineStages> stages, Containers::ArrayView<const UnsignedLong> values);
+        /** @overload */
+        SubmitInfo& setWaitSemaphores(std::initializer_list<VkSemaphore> semaphores, std::initializer_list<PipelineStages> stages, std::initializer_list<UnsignedLong> values);
+
+        /**
+         * @brief Set semaphores to signal once the batch finishes executing
+         * @return Reference to self (for method chaining)
+         *
+         * For @ref SemaphoreType::Timeline semaphores use
+         * @ref setSignalSemaphores(Containers::ArrayView<const VkSemaphore>, Containers::ArrayView<const UnsignedLong>)
+         * instead.
+         * @see @ref Vk-Semaphore-usage
+         */
+        SubmitInfo& setSignalSemaphores(Containers::ArrayView<const VkSemaphore> semaphores);
+        /** @overload */
+        SubmitInfo& setSignalSemaphores(std::initializer_list<VkSemaphore> semaphores);
+
+        /**
+         * @brief Set semaphores to signal once the batch finishes executing, with timeline values
+         * @param semaphores    Semaphores to signal
+         * @param values        Values to signal
+         * @return Reference to self (for method chaining)
+         *
+         * Compared to @ref setSignalSemaphores(Containers::ArrayView<const VkSemaphore>)
+         * references a @type_vk_keyword{TimelineSemaphoreSubmitInfo}
+         * structure from the `pNext` chain, with `pSignalSemaphoreValues`
+         * set to @p values. Values corresponding to
+         * @ref SemaphoreType::Binary semaphores are ignored. Expects that
+         * @p values have the same size as @p semaphores.
+         * @requires_vk12 Extension @vk_extension{KHR,timeline_semaphore}
+         */
+        SubmitInfo& setSignalSemaphores(Containers::ArrayView<const VkSemaphore> semaphores, Containers::ArrayView<const UnsignedLong> values);
+        /** @overload */
+        SubmitInfo& setSignalSemaphores(std::initializer_list<VkSemaphore> semaphores, std::initializer_list<UnsignedLong> values);
+
         /** @brief Underlying @type_vk{SubmitInfo} structure */
         VkSubmitInfo& operator*() { return _info; }
         /** @overload */
@@ -229,6 +297,8 @@ class MAGNUM_VK_EXPORT SubmitInfo {
         operator const VkSubmitInfo&() const { return _info; }
 
     private:
+        MAGNUM_VK_LOCAL void connectTimelineInfo();
+
         VkSubmitInfo _info;
 
         struct State;
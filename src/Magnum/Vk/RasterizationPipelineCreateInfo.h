@@ -513,6 +513,35 @@ class MAGNUM_VK_EXPORT RasterizationPipelineCreateInfo {
          */
         RasterizationPipelineCreateInfo& setDynamicStates(const DynamicRasterizationStates& states);
 
+        /**
+         * @brief Set attachment formats for dynamic rendering
+         * @param colorFormats      Color attachment formats
+         * @param depthFormat       Depth attachment format or
+         *      @cpp PixelFormat{} @ce if there's no depth attachment
+         * @param stencilFormat     Stencil attachment format or
+         *      @cpp PixelFormat{} @ce if there's no stencil attachment
+         * @return Reference to self (for method chaining)
+         *
+         * Makes the pipeline usable inside @ref CommandBuffer::beginRendering()
+         * instead of a render pass. In that case the pipeline is expected to
+         * be constructed with a null @p renderPass and @p subpass set to
+         * @cpp 0 @ce. The size of @p colorFormats is expected to match the
+         * @p subpassColorAttachmentCount passed to the constructor. The
+         * following @type_vk{GraphicsPipelineCreateInfo} fields are modified
+         * by this function, in addition to `sType` of newly referenced
+         * structures:
+         *
+         * -    `pNext` chain with @type_vk_keyword{PipelineRenderingCreateInfoKHR}
+         *      and its `colorAttachmentCount`, `pColorAttachmentFormats`,
+         *      `depthAttachmentFormat` and `stencilAttachmentFormat` fields
+         *      set to @p colorFormats, @p depthFormat and @p stencilFormat
+         *
+         * @requires_vk_feature @ref DeviceFeature::DynamicRendering
+         */
+        RasterizationPipelineCreateInfo& setRenderingFormats(Containers::ArrayView<const PixelFormat> colorFormats, PixelFormat depthFormat = {}, PixelFormat stencilFormat = {});
+        /** @overload */
+        RasterizationPipelineCreateInfo& setRenderingFormats(std::initializer_list<PixelFormat> colorFormats, PixelFormat depthFormat = {}, PixelFormat stencilFormat = {});
+
         /** @brief Underlying @type_vk{GraphicsPipelineCreateInfo} structure */
         VkGraphicsPipelineCreateInfo& operator*() { return _info; }
         /** @overload */
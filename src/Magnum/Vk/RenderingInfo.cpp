@@ -0,0 +1,155 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "RenderingInfo.h"
+#include "CommandBuffer.h"
+
+#include <Corrade/Containers/GrowableArray.h>
+
+#include "Magnum/Math/Range.h"
+#include "Magnum/Vk/Device.h"
+#include "Magnum/Vk/Image.h"
+#include "Magnum/Vk/Integration.h"
+#include "Magnum/Vk/Implementation/DeviceState.h"
+
+namespace Magnum { namespace Vk {
+
+struct RenderingInfo::State {
+    Containers::Array<VkRenderingAttachmentInfoKHR> colorAttachments;
+    VkRenderingAttachmentInfoKHR depthAttachment;
+    VkRenderingAttachmentInfoKHR stencilAttachment;
+};
+
+namespace {
+
+VkRenderingAttachmentInfoKHR attachmentInfo(const VkImageView imageView, const ImageLayout layout, const AttachmentLoadOperation loadOperation, const AttachmentStoreOperation storeOperation, const VkClearValue& clearValue) {
+    VkRenderingAttachmentInfoKHR info{};
+    info.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR;
+    info.imageView = imageView;
+    info.imageLayout = VkImageLayout(layout);
+    info.loadOp = VkAttachmentLoadOp(loadOperation);
+    info.storeOp = VkAttachmentStoreOp(storeOperation);
+    info.clearValue = clearValue;
+    return info;
+}
+
+}
+
+RenderingInfo::RenderingInfo(const Range2Di& renderArea, const UnsignedInt layerCount, const Flags flags): _info{} {
+    _info.sType = VK_STRUCTURE_TYPE_RENDERING_INFO_KHR;
+    _info.flags = VkRenderingFlagsKHR(flags);
+    _info.renderArea = VkRect2D(renderArea);
+    _info.layerCount = layerCount;
+}
+
+RenderingInfo::RenderingInfo(NoInitT) noexcept {}
+
+RenderingInfo::RenderingInfo(const VkRenderingInfoKHR& info):
+    /* Can't use {} with GCC 4.8 here because it tries to initialize the first
+       member instead of doing a copy */
+    _info(info) {}
+
+RenderingInfo::RenderingInfo(RenderingInfo&& other) noexcept:
+    /* Can't use {} with GCC 4.8 here because it tries to initialize the first
+       member instead of doing a copy */
+    _info(other._info),
+    _state{std::move(other._state)}
+{
+    /* Ensure the previous instance doesn't reference state that's now ours */
+    other._info.colorAttachmentCount = 0;
+    other._info.pColorAttachments = nullptr;
+    other._info.pDepthAttachment = nullptr;
+    other._info.pStencilAttachment = nullptr;
+}
+
+RenderingInfo::~RenderingInfo() = default;
+
+RenderingInfo& RenderingInfo::operator=(RenderingInfo&& other) noexcept {
+    using std::swap;
+    swap(other._info, _info);
+    swap(other._state, _state);
+    return *this;
+}
+
+RenderingInfo& RenderingInfo::addColorAttachment(const VkImageView imageView, const ImageLayout layout, const AttachmentLoadOperation loadOperation, const AttachmentStoreOperation storeOperation, const Color4& clearColor) {
+    if(!_state) _state.emplace();
+
+    VkClearValue clearValue;
+    clearValue.color = VkClearColorValue(clearColor);
+    arrayAppend(_state->colorAttachments, attachmentInfo(imageView, layout, loadOperation, storeOperation, clearValue));
+
+    /* The array might have been reallocated, update the pointer */
+    _info.colorAttachmentCount = _state->colorAttachments.size();
+    _info.pColorAttachments = _state->colorAttachments;
+    return *this;
+}
+
+RenderingInfo& RenderingInfo::setDepthAttachment(const VkImageView imageView, const ImageLayout layout, const AttachmentLoadOperation loadOperation, const AttachmentStoreOperation storeOperation, const Float clearDepth) {
+    if(!_state) _state.emplace();
+
+    VkClearValue clearValue;
+    clearValue.depthStencil = {clearDepth, 0};
+    _state->depthAttachment = attachmentInfo(imageView, layout, loadOperation, storeOperation, clearValue);
+    _info.pDepthAttachment = &_state->depthAttachment;
+    return *this;
+}
+
+RenderingInfo& RenderingInfo::setStencilAttachment(const VkImageView imageView, const ImageLayout layout, const AttachmentLoadOperation loadOperation, const AttachmentStoreOperation storeOperation, const UnsignedInt clearStencil) {
+    if(!_state) _state.emplace();
+
+    VkClearValue clearValue;
+    clearValue.depthStencil = {0.0f, clearStencil};
+    _state->stencilAttachment = attachmentInfo(imageView, layout, loadOperation, storeOperation, clearValue);
+    _info.pStencilAttachment = &_state->stencilAttachment;
+    return *this;
+}
+
+CommandBuffer& CommandBuffer::beginRendering(const RenderingInfo& info) {
+    _device->state().cmdBeginRenderingImplementation(*this, *info);
+    return *this;
+}
+
+void CommandBuffer::beginRenderingImplementationDefault(CommandBuffer&, const VkRenderingInfoKHR&) {
+    CORRADE_ASSERT_UNREACHABLE("Vk::CommandBuffer::beginRendering(): requires the KHR_dynamic_rendering extension with the dynamicRendering feature enabled", );
+}
+
+void CommandBuffer::beginRenderingImplementationKHR(CommandBuffer& self, const VkRenderingInfoKHR& info) {
+    return (**self._device).CmdBeginRenderingKHR(self, &info);
+}
+
+CommandBuffer& CommandBuffer::endRendering() {
+    _device->state().cmdEndRenderingImplementation(*this);
+    return *this;
+}
+
+void CommandBuffer::endRenderingImplementationDefault(CommandBuffer&) {
+    CORRADE_ASSERT_UNREACHABLE("Vk::CommandBuffer::endRendering(): requires the KHR_dynamic_rendering extension with the dynamicRendering feature enabled", );
+}
+
+void CommandBuffer::endRenderingImplementationKHR(CommandBuffer& self) {
+    return (**self._device).CmdEndRenderingKHR(self);
+}
+
+}}
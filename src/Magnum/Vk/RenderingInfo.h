@@ -0,0 +1,220 @@
+#ifndef Magnum_Vk_RenderingInfo_h
+#define Magnum_Vk_RenderingInfo_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Vk::RenderingInfo
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/EnumSet.h>
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Tags.h"
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Vk/RenderPassCreateInfo.h"
+#include "Magnum/Vk/Vk.h"
+#include "Magnum/Vk/Vulkan.h"
+#include "Magnum/Vk/visibility.h"
+
+namespace Magnum { namespace Vk {
+
+/**
+@brief Dynamic rendering info
+@m_since_latest
+
+Wraps a @type_vk_keyword{RenderingInfoKHR}. Used to begin rendering with
+@ref CommandBuffer::beginRendering() without having to create a
+@ref RenderPass and a @ref Framebuffer up front. The attachments are specified
+directly as image views, together with their layouts and load and store
+operations:
+
+@snippet MagnumVk.cpp RenderingInfo-usage
+
+Rasterization pipelines used inside the rendering are then created with a null
+@ref RenderPass handle and the attachment formats specified via
+@ref RasterizationPipelineCreateInfo::setRenderingFormats().
+
+@requires_vk_feature @ref DeviceFeature::DynamicRendering
+*/
+class MAGNUM_VK_EXPORT RenderingInfo {
+    public:
+        /**
+         * @brief Rendering flag
+         *
+         * Wraps @type_vk_keyword{RenderingFlagBitsKHR}.
+         * @see @ref Flags, @ref RenderingInfo(const Range2Di&, UnsignedInt, Flags)
+         * @m_enum_values_as_keywords
+         */
+        enum class Flag: UnsignedInt {
+            /**
+             * Contents of the rendering are recorded in secondary command
+             * buffers.
+             */
+            ContentsSecondaryCommandBuffers = VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT_KHR,
+
+            /** The rendering will be suspended */
+            Suspending = VK_RENDERING_SUSPENDING_BIT_KHR,
+
+            /** The rendering resumes a previously suspended one */
+            Resuming = VK_RENDERING_RESUMING_BIT_KHR
+        };
+
+        /**
+         * @brief Rendering flags
+         *
+         * Type-safe wrapper for @type_vk_keyword{RenderingFlagsKHR}.
+         * @see @ref RenderingInfo(const Range2Di&, UnsignedInt, Flags)
+         */
+        typedef Containers::EnumSet<Flag> Flags;
+
+        /**
+         * @brief Constructor
+         * @param renderArea    Render area affected by the rendering
+         * @param layerCount    Number of layers rendered to
+         * @param flags         Rendering flags
+         *
+         * The following @type_vk{RenderingInfoKHR} fields are pre-filled in
+         * addition to `sType`, everything else is zero-filled:
+         *
+         * -    `flags`
+         * -    `renderArea`
+         * -    `layerCount`
+         *
+         * @see @ref addColorAttachment(), @ref setDepthAttachment(),
+         *      @ref setStencilAttachment()
+         */
+        explicit RenderingInfo(const Range2Di& renderArea, UnsignedInt layerCount = 1, Flags flags = {});
+
+        /**
+         * @brief Construct without initializing the contents
+         *
+         * Note that not even the `sType` field is set --- the structure has to
+         * be fully initialized afterwards in order to be usable.
+         */
+        explicit RenderingInfo(NoInitT) noexcept;
+
+        /**
+         * @brief Construct from existing data
+         *
+         * Copies the existing values verbatim, pointers are kept unchanged
+         * without taking over the ownership. Modifying the newly created
+         * instance will not modify the original data nor the pointed-to data.
+         */
+        explicit RenderingInfo(const VkRenderingInfoKHR& info);
+
+        /** @brief Copying is not allowed */
+        RenderingInfo(const RenderingInfo&) = delete;
+
+        /** @brief Move constructor */
+        RenderingInfo(RenderingInfo&& other) noexcept;
+
+        ~RenderingInfo();
+
+        /** @brief Copying is not allowed */
+        RenderingInfo& operator=(const RenderingInfo&) = delete;
+
+        /** @brief Move assignment */
+        RenderingInfo& operator=(RenderingInfo&& other) noexcept;
+
+        /**
+         * @brief Add a color attachment
+         * @param imageView         An @ref ImageView or a raw Vulkan image
+         *      view handle to render to
+         * @param layout            Layout the image view is in during the
+         *      rendering
+         * @param loadOperation     How the previous contents are treated at
+         *      the beginning of the rendering
+         * @param storeOperation    How the contents are treated at the end of
+         *      the rendering
+         * @param clearColor        Clear color, used if @p loadOperation is
+         *      @ref AttachmentLoadOperation::Clear
+         * @return Reference to self (for method chaining)
+         *
+         * Attachments are numbered in the order they're added, matching the
+         * order of color formats passed to
+         * @ref RasterizationPipelineCreateInfo::setRenderingFormats().
+         */
+        RenderingInfo& addColorAttachment(VkImageView imageView, ImageLayout layout, AttachmentLoadOperation loadOperation, AttachmentStoreOperation storeOperation, const Color4& clearColor = {});
+
+        /**
+         * @brief Set a depth attachment
+         * @param imageView         An @ref ImageView or a raw Vulkan image
+         *      view handle to render to
+         * @param layout            Layout the image view is in during the
+         *      rendering
+         * @param loadOperation     How the previous contents are treated at
+         *      the beginning of the rendering
+         * @param storeOperation    How the contents are treated at the end of
+         *      the rendering
+         * @param clearDepth        Clear depth, used if @p loadOperation is
+         *      @ref AttachmentLoadOperation::Clear
+         * @return Reference to self (for method chaining)
+         *
+         * For a combined depth/stencil format, call
+         * @ref setStencilAttachment() with the same @p imageView as well.
+         */
+        RenderingInfo& setDepthAttachment(VkImageView imageView, ImageLayout layout, AttachmentLoadOperation loadOperation, AttachmentStoreOperation storeOperation, Float clearDepth = 1.0f);
+
+        /**
+         * @brief Set a stencil attachment
+         * @param imageView         An @ref ImageView or a raw Vulkan image
+         *      view handle to render to
+         * @param layout            Layout the image view is in during the
+         *      rendering
+         * @param loadOperation     How the previous contents are treated at
+         *      the beginning of the rendering
+         * @param storeOperation    How the contents are treated at the end of
+         *      the rendering
+         * @param clearStencil      Clear stencil value, used if
+         *      @p loadOperation is @ref AttachmentLoadOperation::Clear
+         * @return Reference to self (for method chaining)
+         */
+        RenderingInfo& setStencilAttachment(VkImageView imageView, ImageLayout layout, AttachmentLoadOperation loadOperation, AttachmentStoreOperation storeOperation, UnsignedInt clearStencil = 0);
+
+        /** @brief Underlying @type_vk{RenderingInfoKHR} structure */
+        VkRenderingInfoKHR& operator*() { return _info; }
+        /** @overload */
+        const VkRenderingInfoKHR& operator*() const { return _info; }
+        /** @overload */
+        VkRenderingInfoKHR* operator->() { return &_info; }
+        /** @overload */
+        const VkRenderingInfoKHR* operator->() const { return &_info; }
+        /** @overload */
+        operator const VkRenderingInfoKHR*() const { return &_info; }
+
+    private:
+        VkRenderingInfoKHR _info;
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+CORRADE_ENUMSET_OPERATORS(RenderingInfo::Flags)
+
+}}
+
+#endif
@@ -91,6 +91,13 @@ enum class Result: Int {
      */
     OperationNotDeferred = VK_OPERATION_NOT_DEFERRED_KHR,
 
+    /**
+     * A swapchain no longer matches the surface properties exactly, but can
+     * still be used to present to the surface successfully.
+     * @requires_vk_extension Extension @vk_extension{KHR,swapchain}
+     */
+    Suboptimal = VK_SUBOPTIMAL_KHR,
+
     /**
      * A host memory allocation has failed.
      * @see @ref Result::ErrorOutOfDeviceMemory,
@@ -181,6 +188,21 @@ enum class Result: Int {
      */
     ErrorInvalidOpaqueCaptureAddress = VK_ERROR_INVALID_OPAQUE_CAPTURE_ADDRESS,
 
+    /**
+     * A surface is no longer available.
+     * @requires_vk_extension Extension @vk_extension{KHR,surface}
+     */
+    ErrorSurfaceLost = VK_ERROR_SURFACE_LOST_KHR,
+
+    /**
+     * A surface has changed in such a way that it is no longer compatible
+     * with the swapchain and further presentation requests will fail. The
+     * swapchain has to be recreated.
+     * @requires_vk_extension Extension @vk_extension{KHR,swapchain}
+     * @see @ref Swapchain::recreate()
+     */
+    ErrorOutOfDate = VK_ERROR_OUT_OF_DATE_KHR,
+
     /**
      * Validation failed.
      * @todoc it's nice that docs for deprecated extensions are GONE from the
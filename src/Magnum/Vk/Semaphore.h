@@ -0,0 +1,251 @@
+#ifndef Magnum_Vk_Semaphore_h
+#define Magnum_Vk_Semaphore_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Vk::Semaphore, enum @ref Magnum::Vk::SemaphoreType
+ * @m_since_latest
+ */
+
+#include <chrono>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Tags.h"
+#include "Magnum/Vk/Handle.h"
+#include "Magnum/Vk/Vk.h"
+#include "Magnum/Vk/Vulkan.h"
+#include "Magnum/Vk/visibility.h"
+
+namespace Magnum { namespace Vk {
+
+namespace Implementation { struct DeviceState; }
+
+/**
+@brief Semaphore type
+@m_since_latest
+
+Wraps a @type_vk_keyword{SemaphoreType}.
+@see @ref SemaphoreCreateInfo
+@m_enum_values_as_keywords
+*/
+enum class SemaphoreType: Int {
+    /** Binary semaphore */
+    Binary = VK_SEMAPHORE_TYPE_BINARY,
+
+    /**
+     * Timeline semaphore.
+     *
+     * @requires_vk12 Extension @vk_extension{KHR,timeline_semaphore}
+     * @requires_vk_feature @ref DeviceFeature::TimelineSemaphore
+     */
+    Timeline = VK_SEMAPHORE_TYPE_TIMELINE
+};
+
+/**
+@brief Semaphore
+@m_since_latest
+
+Wraps a @type_vk_keyword{Semaphore}, which is used for synchronizing queue
+submissions with each other and, in case of timeline semaphores, with the
+CPU as well.
+
+@section Vk-Semaphore-creation Semaphore creation
+
+A binary semaphore doesn't need any extra parameters for construction and can
+be constructed directly using @ref Semaphore(Device&, const SemaphoreCreateInfo&),
+leaving the @p info parameter at its default. A timeline semaphore is created
+by passing @ref SemaphoreType::Timeline and an initial value to
+@ref SemaphoreCreateInfo:
+
+@snippet MagnumVk.cpp Semaphore-creation
+
+@section Vk-Semaphore-usage Basic usage
+
+Binary semaphores are signaled and waited on only by the GPU, by passing them
+to @ref SubmitInfo::setSignalSemaphores() and
+@ref SubmitInfo::setWaitSemaphores(). A timeline semaphore has a
+monotonically increasing 64-bit value instead of a signaled state, the values
+to wait for and signal are passed alongside the semaphores in the
+@ref SubmitInfo:
+
+@snippet MagnumVk.cpp Semaphore-usage
+
+Additionally, the current value of a timeline semaphore can be queried from
+the CPU using @ref value(), the CPU can wait for it to reach a particular
+value using @ref wait() and set it to a new value using @ref signal(). A
+single timeline semaphore can thus replace a set of fences, see
+@ref FramePacer for an example.
+*/
+class MAGNUM_VK_EXPORT Semaphore {
+    public:
+        /**
+         * @brief Wrap existing Vulkan handle
+         * @param device            Vulkan device the semaphore is created on
+         * @param handle            The @type_vk{Semaphore} handle
+         * @param flags             Handle flags
+         *
+         * The @p handle is expected to be originating from @p device. Unlike
+         * a semaphore created using a constructor, the Vulkan semaphore is by
+         * default not deleted on destruction, use @p flags for different
+         * behavior.
+         * @see @ref release()
+         */
+        static Semaphore wrap(Device& device, VkSemaphore handle, HandleFlags flags = {});
+
+        /**
+         * @brief Constructor
+         * @param device    Vulkan device to create the semaphore on
+         * @param info      Semaphore creation info
+         *
+         * @see @fn_vk_keyword{CreateSemaphore}
+         */
+        #ifdef DOXYGEN_GENERATING_OUTPUT
+        explicit Semaphore(Device& device, const SemaphoreCreateInfo& info = SemaphoreCreateInfo{});
+        #else
+        explicit Semaphore(Device& device, const SemaphoreCreateInfo& info);
+        explicit Semaphore(Device& device);
+        #endif
+
+        /**
+         * @brief Construct without creating the semaphore
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit Semaphore(NoCreateT);
+
+        /** @brief Copying is not allowed */
+        Semaphore(const Semaphore&) = delete;
+
+        /** @brief Move constructor */
+        Semaphore(Semaphore&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Destroys associated @type_vk{Semaphore} handle, unless the instance
+         * was created using @ref wrap() without
+         * @ref HandleFlag::DestroyOnDestruction specified.
+         * @see @fn_vk_keyword{DestroySemaphore}, @ref release()
+         */
+        ~Semaphore();
+
+        /** @brief Copying is not allowed */
+        Semaphore& operator=(const Semaphore&) = delete;
+
+        /** @brief Move assignment */
+        Semaphore& operator=(Semaphore&& other) noexcept;
+
+        /** @brief Underlying @type_vk{Semaphore} handle */
+        VkSemaphore handle() { return _handle; }
+        /** @overload */
+        operator VkSemaphore() { return _handle; }
+
+        /** @brief Handle flags */
+        HandleFlags handleFlags() const { return _flags; }
+
+        /**
+         * @brief Current value of a timeline semaphore
+         *
+         * Can be only called on a @ref SemaphoreType::Timeline semaphore.
+         * @see @fn_vk_keyword{GetSemaphoreCounterValue},
+         *      @fn_vk_keyword{GetSemaphoreCounterValueKHR}
+         * @requires_vk12 Extension @vk_extension{KHR,timeline_semaphore}
+         */
+        UnsignedLong value();
+
+        /**
+         * @brief Signal a timeline semaphore from the host
+         *
+         * Sets the value of the semaphore to @p value. Can be only called on
+         * a @ref SemaphoreType::Timeline semaphore, @p value has to be larger
+         * than the current value and smaller than values of all pending
+         * signal operations.
+         * @see @fn_vk_keyword{SignalSemaphore},
+         *      @fn_vk_keyword{SignalSemaphoreKHR}
+         * @requires_vk12 Extension @vk_extension{KHR,timeline_semaphore}
+         */
+        void signal(UnsignedLong value);
+
+        /**
+         * @brief Wait for a timeline semaphore to reach given value
+         *
+         * Blocks until the semaphore value becomes equal or larger to
+         * @p value or @p timeout is elapsed, whichever happens sooner,
+         * returning @cpp true @ce if the value was reached. If the value is
+         * already reached, the function returns immediately, if the timeout
+         * happens before the value is reached, @cpp false @ce is returned.
+         * Can be only called on a @ref SemaphoreType::Timeline semaphore.
+         * @see @fn_vk_keyword{WaitSemaphores},
+         *      @fn_vk_keyword{WaitSemaphoresKHR}
+         * @requires_vk12 Extension @vk_extension{KHR,timeline_semaphore}
+         * @todo batch version waiting for multiple semaphores, needs
+         *      DynamicArray to avoid an allocation
+         */
+        bool wait(UnsignedLong value, std::chrono::nanoseconds timeout);
+
+        /**
+         * @brief Wait indefinitely for a timeline semaphore to reach given value
+         *
+         * Equivalent to calling @ref wait(UnsignedLong, std::chrono::nanoseconds)
+         * with the largest representable 64-bit value.
+         */
+        void wait(UnsignedLong value);
+
+        /**
+         * @brief Release the underlying Vulkan semaphore
+         *
+         * Releases ownership of the Vulkan semaphore and returns its handle so
+         * @fn_vk{DestroySemaphore} is not called on destruction. The internal
+         * state is then equivalent to moved-from state.
+         * @see @ref wrap()
+         */
+        VkSemaphore release();
+
+    private:
+        friend Implementation::DeviceState;
+
+        MAGNUM_VK_LOCAL static VkResult getValueImplementationDefault(Device& device, VkSemaphore semaphore, UnsignedLong* value);
+        MAGNUM_VK_LOCAL static VkResult getValueImplementationKHR(Device& device, VkSemaphore semaphore, UnsignedLong* value);
+        MAGNUM_VK_LOCAL static VkResult getValueImplementation12(Device& device, VkSemaphore semaphore, UnsignedLong* value);
+        MAGNUM_VK_LOCAL static VkResult signalImplementationDefault(Device& device, const VkSemaphoreSignalInfo& info);
+        MAGNUM_VK_LOCAL static VkResult signalImplementationKHR(Device& device, const VkSemaphoreSignalInfo& info);
+        MAGNUM_VK_LOCAL static VkResult signalImplementation12(Device& device, const VkSemaphoreSignalInfo& info);
+        MAGNUM_VK_LOCAL static VkResult waitImplementationDefault(Device& device, const VkSemaphoreWaitInfo& info, UnsignedLong timeout);
+        MAGNUM_VK_LOCAL static VkResult waitImplementationKHR(Device& device, const VkSemaphoreWaitInfo& info, UnsignedLong timeout);
+        MAGNUM_VK_LOCAL static VkResult waitImplementation12(Device& device, const VkSemaphoreWaitInfo& info, UnsignedLong timeout);
+
+        /* Can't be a reference because of the NoCreate constructor */
+        Device* _device;
+
+        VkSemaphore _handle;
+        HandleFlags _flags;
+};
+
+}}
+
+#endif
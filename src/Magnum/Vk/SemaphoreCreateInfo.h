@@ -0,0 +1,123 @@
+#ifndef Magnum_Vk_SemaphoreCreateInfo_h
+#define Magnum_Vk_SemaphoreCreateInfo_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Vk::SemaphoreCreateInfo
+ * @m_since_latest
+ */
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Tags.h"
+#include "Magnum/Vk/Semaphore.h"
+#include "Magnum/Vk/visibility.h"
+#include "Magnum/Vk/Vk.h"
+#include "Magnum/Vk/Vulkan.h"
+
+namespace Magnum { namespace Vk {
+
+/**
+@brief Semaphore creation info
+@m_since_latest
+
+Wraps a @type_vk_keyword{SemaphoreCreateInfo} and
+@type_vk_keyword{SemaphoreTypeCreateInfo}. See
+@ref Vk-Semaphore-creation "Semaphore creation" for usage information.
+*/
+class MAGNUM_VK_EXPORT SemaphoreCreateInfo {
+    public:
+        /**
+         * @brief Constructor
+         * @param type          Semaphore type
+         * @param initialValue  Initial value of a
+         *      @ref SemaphoreType::Timeline semaphore
+         *
+         * The following @type_vk{SemaphoreCreateInfo} fields are pre-filled
+         * in addition to `sType`, everything else is zero-filled:
+         *
+         * -    *(none)*
+         *
+         * If @p type is @ref SemaphoreType::Timeline, a
+         * @type_vk{SemaphoreTypeCreateInfo} structure is referenced from the
+         * `pNext` chain, with the following fields set in addition to
+         * `sType`:
+         *
+         * -    `semaphoreType` to @p type
+         * -    `initialValue`
+         *
+         * Expects that @p initialValue is @cpp 0 @ce for a
+         * @ref SemaphoreType::Binary semaphore.
+         */
+        explicit SemaphoreCreateInfo(SemaphoreType type = SemaphoreType::Binary, UnsignedLong initialValue = 0);
+
+        /**
+         * @brief Construct without initializing the contents
+         *
+         * Note that not even the `sType` field is set --- the structure has to
+         * be fully initialized afterwards in order to be usable.
+         */
+        explicit SemaphoreCreateInfo(NoInitT) noexcept;
+
+        /**
+         * @brief Construct from existing data
+         *
+         * Copies the existing values verbatim, pointers are kept unchanged
+         * without taking over the ownership. Modifying the newly created
+         * instance will not modify the original data nor the pointed-to data.
+         */
+        explicit SemaphoreCreateInfo(const VkSemaphoreCreateInfo& info);
+
+        /**
+         * @brief Copy constructor
+         *
+         * If the `pNext` chain of @p other points to its own
+         * @type_vk{SemaphoreTypeCreateInfo}, the copy points to its own copy
+         * of that structure.
+         */
+        SemaphoreCreateInfo(const SemaphoreCreateInfo& other) noexcept;
+
+        /** @brief Copy assignment */
+        SemaphoreCreateInfo& operator=(const SemaphoreCreateInfo& other) noexcept;
+
+        /** @brief Underlying @type_vk{SemaphoreCreateInfo} structure */
+        VkSemaphoreCreateInfo& operator*() { return _info; }
+        /** @overload */
+        const VkSemaphoreCreateInfo& operator*() const { return _info; }
+        /** @overload */
+        VkSemaphoreCreateInfo* operator->() { return &_info; }
+        /** @overload */
+        const VkSemaphoreCreateInfo* operator->() const { return &_info; }
+        /** @overload */
+        operator const VkSemaphoreCreateInfo*() const { return &_info; }
+
+    private:
+        VkSemaphoreCreateInfo _info;
+        VkSemaphoreTypeCreateInfo _typeInfo;
+};
+
+}}
+
+#endif
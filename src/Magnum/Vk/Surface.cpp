@@ -0,0 +1,134 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Surface.h"
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Vk/Assert.h"
+#include "Magnum/Vk/DeviceProperties.h"
+#include "Magnum/Vk/Instance.h"
+#include "Magnum/Vk/Result.h"
+
+namespace Magnum { namespace Vk {
+
+Debug& operator<<(Debug& debug, const PresentMode value) {
+    debug << "Vk::PresentMode" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case Vk::PresentMode::value: return debug << "::" << Debug::nospace << #value;
+        _c(Immediate)
+        _c(Mailbox)
+        _c(Fifo)
+        _c(FifoRelaxed)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    /* Vulkan docs have the values in decimal, so not converting to hex */
+    return debug << "(" << Debug::nospace << Int(value) << Debug::nospace << ")";
+}
+
+Surface Surface::wrap(Instance& instance, const VkSurfaceKHR handle, const HandleFlags flags) {
+    Surface out{NoCreate};
+    out._instance = &instance;
+    out._handle = handle;
+    out._flags = flags;
+    return out;
+}
+
+Surface::Surface(NoCreateT): _instance{}, _handle{} {}
+
+Surface::Surface(Surface&& other) noexcept: _instance{other._instance}, _handle{other._handle}, _flags{other._flags} {
+    other._handle = {};
+}
+
+Surface::~Surface() {
+    if(_handle && (_flags & HandleFlag::DestroyOnDestruction))
+        (**_instance).DestroySurfaceKHR(*_instance, _handle, nullptr);
+}
+
+Surface& Surface::operator=(Surface&& other) noexcept {
+    using std::swap;
+    swap(other._instance, _instance);
+    swap(other._handle, _handle);
+    swap(other._flags, _flags);
+    return *this;
+}
+
+bool Surface::isPresentationSupported(DeviceProperties& device, const UnsignedInt queueFamily) {
+    VkBool32 supported;
+    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS((**_instance).GetPhysicalDeviceSurfaceSupportKHR(device, queueFamily, _handle, &supported));
+    return supported;
+}
+
+VkSurfaceCapabilitiesKHR Surface::capabilities(DeviceProperties& device) {
+    VkSurfaceCapabilitiesKHR capabilities;
+    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS((**_instance).GetPhysicalDeviceSurfaceCapabilitiesKHR(device, _handle, &capabilities));
+    return capabilities;
+}
+
+Containers::Array<VkSurfaceFormatKHR> Surface::formats(DeviceProperties& device) {
+    /* Expect the count didn't change between the two calls */
+    UnsignedInt count;
+    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS((**_instance).GetPhysicalDeviceSurfaceFormatsKHR(device, _handle, &count, nullptr));
+    Containers::Array<VkSurfaceFormatKHR> out{NoInit, count};
+    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS((**_instance).GetPhysicalDeviceSurfaceFormatsKHR(device, _handle, &count, out.data()));
+    CORRADE_INTERNAL_ASSERT(count == out.size());
+    return out;
+}
+
+Containers::Array<PresentMode> Surface::presentModes(DeviceProperties& device) {
+    UnsignedInt count;
+    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS((**_instance).GetPhysicalDeviceSurfacePresentModesKHR(device, _handle, &count, nullptr));
+    Containers::Array<PresentMode> out{NoInit, count};
+    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS((**_instance).GetPhysicalDeviceSurfacePresentModesKHR(device, _handle, &count, reinterpret_cast<VkPresentModeKHR*>(out.data())));
+    CORRADE_INTERNAL_ASSERT(count == out.size());
+    return out;
+}
+
+PresentMode Surface::pickPresentMode(DeviceProperties& device, const Containers::ArrayView<const PresentMode> preferred) {
+    const Containers::Array<PresentMode> supported = presentModes(device);
+    for(const PresentMode mode: preferred)
+        for(const PresentMode supportedMode: supported)
+            if(mode == supportedMode) return mode;
+
+    /* FIFO is the only mode the spec requires to be supported */
+    return PresentMode::Fifo;
+}
+
+PresentMode Surface::pickPresentMode(DeviceProperties& device, const std::initializer_list<PresentMode> preferred) {
+    return pickPresentMode(device, Containers::arrayView(preferred));
+}
+
+VkSurfaceKHR Surface::release() {
+    const VkSurfaceKHR handle = _handle;
+    _handle = {};
+    return handle;
+}
+
+}}
@@ -0,0 +1,245 @@
+#ifndef Magnum_Vk_Surface_h
+#define Magnum_Vk_Surface_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Vk::Surface, enum @ref Magnum::Vk::PresentMode
+ * @m_since_latest
+ */
+
+#include <initializer_list>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Tags.h"
+#include "Magnum/Vk/Handle.h"
+#include "Magnum/Vk/Vk.h"
+#include "Magnum/Vk/Vulkan.h"
+#include "Magnum/Vk/visibility.h"
+
+namespace Magnum { namespace Vk {
+
+/**
+@brief Presentation mode
+@m_since_latest
+
+Wraps a @type_vk_keyword{PresentModeKHR}.
+@see @ref Surface::presentModes(), @ref Surface::pickPresentMode(),
+    @ref SwapchainCreateInfo
+@m_enum_values_as_keywords
+*/
+enum class PresentMode: Int {
+    /**
+     * Images are presented immediately, without waiting for a vertical
+     * blank. Has the lowest latency but may result in visible tearing.
+     */
+    Immediate = VK_PRESENT_MODE_IMMEDIATE_KHR,
+
+    /**
+     * Images are presented at a vertical blank, a newly presented image
+     * replaces the one waiting in a single-entry queue. Rendering is never
+     * blocked by presentation, resulting in a low latency without tearing,
+     * at the cost of discarding frames when rendering faster than the
+     * display refresh rate. Not supported everywhere.
+     */
+    Mailbox = VK_PRESENT_MODE_MAILBOX_KHR,
+
+    /**
+     * Images are presented at a vertical blank from a queue, rendering blocks
+     * when the queue is full. Equivalent to a classic V-Sync. The only mode
+     * that's guaranteed to be supported.
+     */
+    Fifo = VK_PRESENT_MODE_FIFO_KHR,
+
+    /**
+     * Like @ref PresentMode::Fifo, but if a vertical blank was missed, the
+     * late image is presented immediately, possibly resulting in tearing.
+     * Avoids stutter when rendering is occasionally slower than the display
+     * refresh rate. Not supported everywhere.
+     */
+    FifoRelaxed = VK_PRESENT_MODE_FIFO_RELAXED_KHR
+};
+
+/**
+@debugoperatorenum{PresentMode}
+@m_since_latest
+*/
+MAGNUM_VK_EXPORT Debug& operator<<(Debug& debug, PresentMode value);
+
+/**
+@brief Surface
+@m_since_latest
+
+Wraps a @type_vk_keyword{SurfaceKHR}, which represents a native window to
+present to.
+
+@section Vk-Surface-creation Surface creation
+
+Surface creation is platform-specific and is thus not exposed by this class.
+Instead, a surface created by the windowing toolkit is wrapped using
+@ref wrap(), for example with @ref Platform::Sdl2Application::createVkSurface()
+or @ref Platform::GlfwApplication::createVkSurface(). The instance has to be
+created with @vk_extension{KHR,surface} and the platform-specific surface
+extension enabled, which the application classes list in
+@ref Platform::Sdl2Application::vkInstanceExtensions() "vkInstanceExtensions()":
+
+@snippet MagnumVk.cpp Surface-creation
+
+@section Vk-Surface-usage Basic usage
+
+The surface is then used to check that a queue family can present to it using
+@ref isPresentationSupported(), to query its @ref capabilities() and to pick
+a @ref PresentMode for a @ref Swapchain using @ref pickPresentMode().
+*/
+class MAGNUM_VK_EXPORT Surface {
+    public:
+        /**
+         * @brief Wrap existing Vulkan handle
+         * @param instance          Vulkan instance the surface is created on
+         * @param handle            The @type_vk{SurfaceKHR} handle
+         * @param flags             Handle flags
+         *
+         * The @p handle is expected to be originating from @p instance.
+         * Unlike other objects, surfaces can't be created directly, so the
+         * Vulkan surface is by default not deleted on destruction, use
+         * @p flags for different behavior.
+         * @see @ref release()
+         */
+        static Surface wrap(Instance& instance, VkSurfaceKHR handle, HandleFlags flags = {});
+
+        /**
+         * @brief Construct without creating the surface
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit Surface(NoCreateT);
+
+        /** @brief Copying is not allowed */
+        Surface(const Surface&) = delete;
+
+        /** @brief Move constructor */
+        Surface(Surface&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Destroys associated @type_vk{SurfaceKHR} handle if the instance
+         * was created using @ref wrap() with
+         * @ref HandleFlag::DestroyOnDestruction specified.
+         * @see @fn_vk_keyword{DestroySurfaceKHR}, @ref release()
+         */
+        ~Surface();
+
+        /** @brief Copying is not allowed */
+        Surface& operator=(const Surface&) = delete;
+
+        /** @brief Move assignment */
+        Surface& operator=(Surface&& other) noexcept;
+
+        /** @brief Underlying @type_vk{SurfaceKHR} handle */
+        VkSurfaceKHR handle() { return _handle; }
+        /** @overload */
+        operator VkSurfaceKHR() { return _handle; }
+
+        /** @brief Handle flags */
+        HandleFlags handleFlags() const { return _flags; }
+
+        /**
+         * @brief Whether given queue family can present to the surface
+         * @param device        Physical device
+         * @param queueFamily   Queue family index
+         *
+         * @see @ref DeviceProperties::pickQueueFamily(),
+         *      @fn_vk_keyword{GetPhysicalDeviceSurfaceSupportKHR}
+         */
+        bool isPresentationSupported(DeviceProperties& device, UnsignedInt queueFamily);
+
+        /**
+         * @brief Surface capabilities
+         *
+         * The `currentExtent` field contains the surface size in pixels, or
+         * @cpp 0xffffffff @ce in both dimensions if the size is determined by
+         * the swapchain. Use it to size a @ref Swapchain on creation and
+         * after a resize.
+         * @see @fn_vk_keyword{GetPhysicalDeviceSurfaceCapabilitiesKHR}
+         */
+        VkSurfaceCapabilitiesKHR capabilities(DeviceProperties& device);
+
+        /**
+         * @brief Supported surface formats
+         *
+         * @see @fn_vk_keyword{GetPhysicalDeviceSurfaceFormatsKHR}
+         */
+        Containers::Array<VkSurfaceFormatKHR> formats(DeviceProperties& device);
+
+        /**
+         * @brief Supported presentation modes
+         *
+         * @see @ref pickPresentMode(),
+         *      @fn_vk_keyword{GetPhysicalDeviceSurfacePresentModesKHR}
+         */
+        Containers::Array<PresentMode> presentModes(DeviceProperties& device);
+
+        /**
+         * @brief Pick a presentation mode
+         * @param device        Physical device
+         * @param preferred     Presentation modes in order of preference
+         *
+         * Returns the first mode from @p preferred that's supported by the
+         * surface. If none of them is, returns @ref PresentMode::Fifo, which
+         * is guaranteed to be supported. For example, passing
+         * @ref PresentMode::Mailbox and @ref PresentMode::FifoRelaxed picks
+         * the lowest-latency tear-free mode available.
+         * @see @ref presentModes()
+         */
+        PresentMode pickPresentMode(DeviceProperties& device, Containers::ArrayView<const PresentMode> preferred);
+
+        /** @overload */
+        PresentMode pickPresentMode(DeviceProperties& device, std::initializer_list<PresentMode> preferred);
+
+        /**
+         * @brief Release the underlying Vulkan surface
+         *
+         * Releases ownership of the Vulkan surface and returns its handle so
+         * @fn_vk{DestroySurfaceKHR} is not called on destruction. The
+         * internal state is then equivalent to moved-from state.
+         * @see @ref wrap()
+         */
+        VkSurfaceKHR release();
+
+    private:
+        /* Can't be a reference because of the NoCreate constructor */
+        Instance* _instance;
+
+        VkSurfaceKHR _handle;
+        HandleFlags _flags;
+};
+
+}}
+
+#endif
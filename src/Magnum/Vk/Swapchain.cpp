@@ -0,0 +1,207 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Swapchain.h"
+#include "SwapchainCreateInfo.h"
+
+#include <new>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Utility/Algorithms.h>
+
+#include "Magnum/Vk/Assert.h"
+#include "Magnum/Vk/Device.h"
+#include "Magnum/Vk/Integration.h"
+#include "Magnum/Vk/PixelFormat.h"
+#include "Magnum/Vk/Queue.h"
+#include "Magnum/Vk/Result.h"
+
+namespace Magnum { namespace Vk {
+
+SwapchainCreateInfo::SwapchainCreateInfo(const VkSurfaceKHR surface, const PixelFormat format, const Vector2i& size, const PresentMode presentMode, const UnsignedInt imageCount, const ImageUsages usages): _info{} {
+    _info.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
+    _info.surface = surface;
+    _info.minImageCount = imageCount;
+    _info.imageFormat = VkFormat(format);
+    _info.imageColorSpace = VK_COLOR_SPACE_SRGB_NONLINEAR_KHR;
+    _info.imageExtent = VkExtent2D(size);
+    _info.imageArrayLayers = 1;
+    _info.imageUsage = VkImageUsageFlags(usages);
+    _info.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    _info.preTransform = VK_SURFACE_TRANSFORM_IDENTITY_BIT_KHR;
+    _info.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
+    _info.presentMode = VkPresentModeKHR(presentMode);
+    _info.clipped = VK_TRUE;
+}
+
+SwapchainCreateInfo::SwapchainCreateInfo(const VkSurfaceKHR surface, const Magnum::PixelFormat format, const Vector2i& size, const PresentMode presentMode, const UnsignedInt imageCount, const ImageUsages usages): SwapchainCreateInfo{surface, pixelFormat(format), size, presentMode, imageCount, usages} {}
+
+SwapchainCreateInfo::SwapchainCreateInfo(NoInitT) noexcept {}
+
+SwapchainCreateInfo::SwapchainCreateInfo(const VkSwapchainCreateInfoKHR& info):
+    /* Can't use {} with GCC 4.8 here because it tries to initialize the first
+       member instead of doing a copy */
+    _info(info) {}
+
+SwapchainCreateInfo& SwapchainCreateInfo::setOldSwapchain(const VkSwapchainKHR swapchain) {
+    _info.oldSwapchain = swapchain;
+    return *this;
+}
+
+Swapchain Swapchain::wrap(Device& device, const VkSwapchainKHR handle, const PixelFormat format, const Vector2i& size, const HandleFlags flags) {
+    Swapchain out{NoCreate};
+    out._device = &device;
+    out._handle = handle;
+    out._flags = flags;
+    out._format = format;
+    out._size = size;
+    out.populateImages();
+    return out;
+}
+
+Swapchain::Swapchain(Device& device, const SwapchainCreateInfo& info): _device{&device}, _flags{HandleFlag::DestroyOnDestruction}, _format{PixelFormat(info->imageFormat)}, _size{info->imageExtent},
+    /* Can't use {} with GCC 4.8 here because it tries to initialize the first
+       member instead of doing a copy */
+    _info(*info)
+{
+    CORRADE_ASSERT(_size.product(),
+        "Vk::Swapchain: expected a non-zero size, got" << Debug::packed << _size, );
+
+    /* The pNext chain isn't remembered, as it may point to temporaries. The
+       queue family indices are copied for the same reason. */
+    _info.pNext = nullptr;
+    _info.oldSwapchain = {};
+    if(_info.queueFamilyIndexCount) {
+        _queueFamilyIndices = Containers::Array<UnsignedInt>{NoInit, _info.queueFamilyIndexCount};
+        Utility::copy(Containers::arrayView(_info.pQueueFamilyIndices, _info.queueFamilyIndexCount), _queueFamilyIndices);
+        _info.pQueueFamilyIndices = _queueFamilyIndices;
+    }
+
+    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS(device->CreateSwapchainKHR(device, info, nullptr, &_handle));
+    populateImages();
+}
+
+Swapchain::Swapchain(NoCreateT): _device{}, _handle{}, _format{}, _info{} {}
+
+Swapchain::Swapchain(Swapchain&& other) noexcept: _device{other._device}, _handle{other._handle}, _flags{other._flags}, _format{other._format}, _size{other._size}, _images{std::move(other._images)},
+    /* Can't use {} with GCC 4.8 here because it tries to initialize the first
+       member instead of doing a copy */
+    _info(other._info), _queueFamilyIndices{std::move(other._queueFamilyIndices)}
+{
+    other._handle = {};
+}
+
+Swapchain::~Swapchain() {
+    /* Release the images first, they're not destroyed on their own but
+       shouldn't outlive the swapchain */
+    _images = nullptr;
+    if(_handle && (_flags & HandleFlag::DestroyOnDestruction))
+        (**_device).DestroySwapchainKHR(*_device, _handle, nullptr);
+}
+
+Swapchain& Swapchain::operator=(Swapchain&& other) noexcept {
+    using std::swap;
+    swap(other._device, _device);
+    swap(other._handle, _handle);
+    swap(other._flags, _flags);
+    swap(other._format, _format);
+    swap(other._size, _size);
+    swap(other._images, _images);
+    swap(other._info, _info);
+    swap(other._queueFamilyIndices, _queueFamilyIndices);
+    return *this;
+}
+
+void Swapchain::populateImages() {
+    UnsignedInt count;
+    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS((**_device).GetSwapchainImagesKHR(*_device, _handle, &count, nullptr));
+    Containers::Array<VkImage> handles{NoInit, count};
+    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS((**_device).GetSwapchainImagesKHR(*_device, _handle, &count, handles));
+    CORRADE_INTERNAL_ASSERT(count == handles.size());
+
+    /* The images are owned by the swapchain, so they're not destroyed on
+       destruction */
+    _images = Containers::Array<Image>{NoInit, count};
+    for(std::size_t i = 0; i != count; ++i)
+        new(&_images[i]) Image{Image::wrap(*_device, handles[i], _format)};
+}
+
+Containers::Optional<UnsignedInt> Swapchain::acquire(const VkSemaphore signal, const VkFence fence) {
+    CORRADE_ASSERT(signal || fence,
+        "Vk::Swapchain::acquire(): expected a semaphore or a fence to be present", {});
+
+    /* With an infinite timeout neither Result::Timeout nor Result::NotReady
+       can be returned. A suboptimal swapchain still acquires the image and
+       signals the semaphore, so it's treated as a success here and reported
+       from present() instead. */
+    UnsignedInt index;
+    if(MAGNUM_VK_INTERNAL_ASSERT_SUCCESS_OR((**_device).AcquireNextImageKHR(*_device, _handle, ~UnsignedLong{}, signal, fence, &index), Result::Suboptimal, Result::ErrorOutOfDate) == Result::ErrorOutOfDate)
+        return {};
+    return index;
+}
+
+bool Swapchain::present(Queue& queue, const UnsignedInt image, const VkSemaphore wait) {
+    CORRADE_ASSERT(image < _images.size(),
+        "Vk::Swapchain::present(): index" << image << "out of range for" << _images.size() << "images", {});
+
+    VkPresentInfoKHR info{};
+    info.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+    if(wait) {
+        info.waitSemaphoreCount = 1;
+        info.pWaitSemaphores = &wait;
+    }
+    info.swapchainCount = 1;
+    info.pSwapchains = &_handle;
+    info.pImageIndices = &image;
+    return MAGNUM_VK_INTERNAL_ASSERT_SUCCESS_OR((**_device).QueuePresentKHR(queue, &info), Result::Suboptimal, Result::ErrorOutOfDate) == Result::Success;
+}
+
+void Swapchain::recreate(const Vector2i& size) {
+    CORRADE_ASSERT(_info.sType,
+        "Vk::Swapchain::recreate(): can't recreate a wrapped swapchain", );
+    CORRADE_ASSERT(size.product(),
+        "Vk::Swapchain::recreate(): expected a non-zero size, got" << Debug::packed << size, );
+
+    _info.imageExtent = VkExtent2D(size);
+    _info.oldSwapchain = _handle;
+    VkSwapchainKHR handle;
+    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS((**_device).CreateSwapchainKHR(*_device, &_info, nullptr, &handle));
+    _info.oldSwapchain = {};
+
+    /* The old images are retired together with the swapchain */
+    _images = nullptr;
+    if(_flags & HandleFlag::DestroyOnDestruction)
+        (**_device).DestroySwapchainKHR(*_device, _handle, nullptr);
+    _handle = handle;
+    _size = size;
+    populateImages();
+}
+
+VkSwapchainKHR Swapchain::release() {
+    const VkSwapchainKHR handle = _handle;
+    _handle = {};
+    return handle;
+}
+
+}}
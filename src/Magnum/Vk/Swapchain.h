@@ -0,0 +1,269 @@
+#ifndef Magnum_Vk_Swapchain_h
+#define Magnum_Vk_Swapchain_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Vk::Swapchain
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Tags.h"
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/Vk/Handle.h"
+#include "Magnum/Vk/Image.h"
+#include "Magnum/Vk/Vk.h"
+#include "Magnum/Vk/Vulkan.h"
+#include "Magnum/Vk/visibility.h"
+
+namespace Magnum { namespace Vk {
+
+/**
+@brief Swapchain
+@m_since_latest
+
+Wraps a @type_vk_keyword{SwapchainKHR}, which is a queue of images presented
+to a @ref Surface.
+
+@section Vk-Swapchain-creation Swapchain creation
+
+The swapchain is created from a @ref SwapchainCreateInfo on a device with
+@vk_extension{KHR,swapchain} enabled, the format, size and image count
+should be chosen from what the @ref Surface reports. The presentation mode
+determines the latency --- @ref PresentMode::Mailbox never blocks rendering
+and always presents the newest image, @ref PresentMode::FifoRelaxed
+presents late frames immediately instead of waiting for the next vertical
+blank. Neither is supported everywhere, so pick the first supported one
+using @ref Surface::pickPresentMode(), which falls back to
+@ref PresentMode::Fifo:
+
+@snippet MagnumVk.cpp Swapchain-creation
+
+@section Vk-Swapchain-usage Acquiring and presenting images
+
+Every frame, an image to render to is acquired with @ref acquire() and
+passed back to the presentation engine with @ref present() once rendered.
+Presentation can only wait on and signal a @ref SemaphoreType::Binary
+semaphore, timeline semaphores aren't supported by the presentation engine.
+The queue submission thus waits for a binary semaphore signaled by
+@ref acquire() and signals another binary semaphore @ref present() waits on.
+The CPU is paced using a @ref FramePacer, whose timeline semaphore is
+signaled by the same submission --- the binary semaphore passed to
+@ref acquire() is then indexed by @ref FramePacer::frameIndex(), as it's
+guaranteed to be unsignaled again once the frame that used it finished:
+
+@snippet MagnumVk.cpp Swapchain-usage
+
+The images are in @ref ImageLayout::Undefined after acquire and have to be
+transitioned to @ref ImageLayout::PresentSource before being presented, for
+example as the final layout of a render pass.
+
+@section Vk-Swapchain-resize Handling window resize
+
+When the surface size changes, @ref acquire() returns
+@ref Containers::NullOpt and @ref present() returns @cpp false @ce. In that
+case, wait for the frames in flight to finish and call @ref recreate() with
+the new size. The new swapchain is created with the old one passed as
+`oldSwapchain`, which allows the implementation to reuse its resources. The
+resize is also commonly handled proactively in the application viewport
+event:
+
+@snippet MagnumVk.cpp Swapchain-resize
+
+A minimized window has a zero size, in which case no swapchain can be created
+and rendering should be skipped until the window is restored.
+*/
+class MAGNUM_VK_EXPORT Swapchain {
+    public:
+        /**
+         * @brief Wrap existing Vulkan handle
+         * @param device            Vulkan device the swapchain is created on
+         * @param handle            The @type_vk{SwapchainKHR} handle
+         * @param format            Image format. Available through
+         *      @ref format() afterwards.
+         * @param size              Image size. Available through
+         *      @ref size() afterwards.
+         * @param flags             Handle flags
+         *
+         * The @p handle is expected to be originating from @p device. The
+         * @p format and @p size parameters are expected to match the creation
+         * parameters. Unlike a swapchain created using a constructor, the
+         * Vulkan swapchain is by default not deleted on destruction, use
+         * @p flags for different behavior. A wrapped swapchain can't be
+         * recreated using @ref recreate().
+         * @see @ref release()
+         */
+        static Swapchain wrap(Device& device, VkSwapchainKHR handle, PixelFormat format, const Vector2i& size, HandleFlags flags = {});
+
+        /**
+         * @brief Constructor
+         * @param device    Vulkan device to create the swapchain on
+         * @param info      Swapchain creation info
+         *
+         * Expects that the size isn't zero. The creation info is remembered
+         * for @ref recreate(), except for the `pNext` chain.
+         * @see @fn_vk_keyword{CreateSwapchainKHR},
+         *      @fn_vk_keyword{GetSwapchainImagesKHR}
+         */
+        explicit Swapchain(Device& device, const SwapchainCreateInfo& info);
+
+        /**
+         * @brief Construct without creating the swapchain
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit Swapchain(NoCreateT);
+
+        /** @brief Copying is not allowed */
+        Swapchain(const Swapchain&) = delete;
+
+        /** @brief Move constructor */
+        Swapchain(Swapchain&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Destroys associated @type_vk{SwapchainKHR} handle, unless the
+         * instance was created using @ref wrap() without
+         * @ref HandleFlag::DestroyOnDestruction specified.
+         * @see @fn_vk_keyword{DestroySwapchainKHR}, @ref release()
+         */
+        ~Swapchain();
+
+        /** @brief Copying is not allowed */
+        Swapchain& operator=(const Swapchain&) = delete;
+
+        /** @brief Move assignment */
+        Swapchain& operator=(Swapchain&& other) noexcept;
+
+        /** @brief Underlying @type_vk{SwapchainKHR} handle */
+        VkSwapchainKHR handle() { return _handle; }
+        /** @overload */
+        operator VkSwapchainKHR() { return _handle; }
+
+        /** @brief Handle flags */
+        HandleFlags handleFlags() const { return _flags; }
+
+        /** @brief Image format */
+        PixelFormat format() const { return _format; }
+
+        /** @brief Image size */
+        Vector2i size() const { return _size; }
+
+        /**
+         * @brief Swapchain images
+         *
+         * The images are owned by the swapchain and are destroyed together
+         * with it. The list is refreshed on @ref recreate(), which
+         * invalidates all previously returned references.
+         */
+        Containers::ArrayView<Image> images() { return _images; }
+
+        /**
+         * @brief Acquire an image
+         * @param signal    Semaphore to signal once the image is ready to be
+         *      rendered to
+         * @param fence     Fence to signal once the image is ready to be
+         *      rendered to
+         * @return Index into @ref images() or @ref Containers::NullOpt if the
+         *      swapchain is out of date and has to be recreated
+         *
+         * Blocks until an image is available. At least one of @p signal and
+         * @p fence is expected to be present, @p signal is expected to be a
+         * @ref SemaphoreType::Binary semaphore with no pending signal
+         * operations.
+         * @see @ref Result::ErrorOutOfDate, @ref recreate(),
+         *      @fn_vk_keyword{AcquireNextImageKHR}
+         */
+        Containers::Optional<UnsignedInt> acquire(VkSemaphore signal, VkFence fence = {});
+
+        /**
+         * @brief Present an image
+         * @param queue     Queue to present on
+         * @param image     Index of the image returned from @ref acquire()
+         * @param wait      Semaphore to wait for before presenting
+         * @return @cpp true @ce if the image was presented and the swapchain
+         *      matches the surface exactly, @cpp false @ce if the swapchain
+         *      is out of date or suboptimal and should be recreated
+         *
+         * The @p queue is expected to support presenting to the surface,
+         * check with @ref Surface::isPresentationSupported(). The @p wait
+         * semaphore is expected to be a @ref SemaphoreType::Binary semaphore
+         * signaled by the queue submission that rendered the image, or
+         * @cpp nullptr @ce if there's nothing to wait for.
+         * @see @ref Result::Suboptimal, @ref Result::ErrorOutOfDate,
+         *      @fn_vk_keyword{QueuePresentKHR}
+         */
+        bool present(Queue& queue, UnsignedInt image, VkSemaphore wait);
+
+        /**
+         * @brief Recreate the swapchain with a new size
+         *
+         * Creates a new swapchain with the same parameters as before except
+         * for @p size, passing the current one as `oldSwapchain`, then
+         * destroys the current one and queries the new @ref images(). Expects
+         * that @p size isn't zero, that the swapchain wasn't created using
+         * @ref wrap() and that the device doesn't use any of the current
+         * images anymore, for example by calling @ref FramePacer::wait()
+         * before.
+         * @see @ref SwapchainCreateInfo::setOldSwapchain()
+         */
+        void recreate(const Vector2i& size);
+
+        /**
+         * @brief Release the underlying Vulkan swapchain
+         *
+         * Releases ownership of the Vulkan swapchain and returns its handle
+         * so @fn_vk{DestroySwapchainKHR} is not called on destruction. The
+         * internal state is then equivalent to moved-from state.
+         * @see @ref wrap()
+         */
+        VkSwapchainKHR release();
+
+    private:
+        MAGNUM_VK_LOCAL void populateImages();
+
+        /* Can't be a reference because of the NoCreate constructor */
+        Device* _device;
+
+        VkSwapchainKHR _handle;
+        HandleFlags _flags;
+        PixelFormat _format;
+        Vector2i _size;
+        Containers::Array<Image> _images;
+
+        /* Remembered for recreate(), sType is zero for wrapped swapchains */
+        VkSwapchainCreateInfoKHR _info;
+        Containers::Array<UnsignedInt> _queueFamilyIndices;
+};
+
+}}
+
+#endif
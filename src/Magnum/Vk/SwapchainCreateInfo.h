@@ -0,0 +1,136 @@
+#ifndef Magnum_Vk_SwapchainCreateInfo_h
+#define Magnum_Vk_SwapchainCreateInfo_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Vk::SwapchainCreateInfo
+ * @m_since_latest
+ */
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Tags.h"
+#include "Magnum/Vk/ImageCreateInfo.h"
+#include "Magnum/Vk/Surface.h"
+#include "Magnum/Vk/Vk.h"
+#include "Magnum/Vk/Vulkan.h"
+#include "Magnum/Vk/visibility.h"
+
+namespace Magnum { namespace Vk {
+
+/**
+@brief Swapchain creation info
+@m_since_latest
+
+Wraps a @type_vk_keyword{SwapchainCreateInfoKHR}. See
+@ref Vk-Swapchain-creation "Swapchain creation" for usage information.
+*/
+class MAGNUM_VK_EXPORT SwapchainCreateInfo {
+    public:
+        /**
+         * @brief Constructor
+         * @param surface       Surface to present to
+         * @param format        Image format
+         * @param size          Image size in pixels
+         * @param presentMode   Presentation mode
+         * @param imageCount    Minimal count of images
+         * @param usages        Image usages
+         *
+         * The following @type_vk{SwapchainCreateInfoKHR} fields are
+         * pre-filled in addition to `sType`, everything else is zero-filled:
+         *
+         * -    `surface`
+         * -    `minImageCount` to @p imageCount
+         * -    `imageFormat` to @p format
+         * -    `imageColorSpace` to @val_vk{COLOR_SPACE_SRGB_NONLINEAR_KHR,ColorSpaceKHR}
+         * -    `imageExtent` to @p size
+         * -    `imageArrayLayers` to @cpp 1 @ce
+         * -    `imageUsage` to @p usages
+         * -    `imageSharingMode` to @val_vk{SHARING_MODE_EXCLUSIVE,SharingMode}
+         * -    `preTransform` to @val_vk{SURFACE_TRANSFORM_IDENTITY_BIT_KHR,SurfaceTransformFlagBitsKHR}
+         * -    `compositeAlpha` to @val_vk{COMPOSITE_ALPHA_OPAQUE_BIT_KHR,CompositeAlphaFlagBitsKHR}
+         * -    `presentMode`
+         * -    `clipped` to @val_vk{TRUE,Bool32}
+         *
+         * The @p format, @p size and @p imageCount are expected to be in
+         * bounds of what @ref Surface::formats() and
+         * @ref Surface::capabilities() report. Use three images with
+         * @ref PresentMode::Mailbox so the application can render into one
+         * while another waits for presentation.
+         */
+        explicit SwapchainCreateInfo(VkSurfaceKHR surface, PixelFormat format, const Vector2i& size, PresentMode presentMode = PresentMode::Fifo, UnsignedInt imageCount = 2, ImageUsages usages = ImageUsage::ColorAttachment);
+
+        /** @overload */
+        explicit SwapchainCreateInfo(VkSurfaceKHR surface, Magnum::PixelFormat format, const Vector2i& size, PresentMode presentMode = PresentMode::Fifo, UnsignedInt imageCount = 2, ImageUsages usages = ImageUsage::ColorAttachment);
+
+        /**
+         * @brief Construct without initializing the contents
+         *
+         * Note that not even the `sType` field is set --- the structure has to
+         * be fully initialized afterwards in order to be usable.
+         */
+        explicit SwapchainCreateInfo(NoInitT) noexcept;
+
+        /**
+         * @brief Construct from existing data
+         *
+         * Copies the existing values verbatim, pointers are kept unchanged
+         * without taking over the ownership. Modifying the newly created
+         * instance will not modify the original data nor the pointed-to data.
+         */
+        explicit SwapchainCreateInfo(const VkSwapchainCreateInfoKHR& info);
+
+        /**
+         * @brief Set the swapchain being replaced
+         * @return Reference to self (for method chaining)
+         *
+         * Sets the `oldSwapchain` field. Allows the implementation to reuse
+         * resources of the old swapchain and to present its already acquired
+         * images. Done implicitly by @ref Swapchain::recreate().
+         */
+        SwapchainCreateInfo& setOldSwapchain(VkSwapchainKHR swapchain);
+
+        /** @brief Underlying @type_vk{SwapchainCreateInfoKHR} structure */
+        VkSwapchainCreateInfoKHR& operator*() { return _info; }
+        /** @overload */
+        const VkSwapchainCreateInfoKHR& operator*() const { return _info; }
+        /** @overload */
+        VkSwapchainCreateInfoKHR* operator->() { return &_info; }
+        /** @overload */
+        const VkSwapchainCreateInfoKHR* operator->() const { return &_info; }
+        /** @overload */
+        operator const VkSwapchainCreateInfoKHR*() const { return &_info; }
+
+    private:
+        VkSwapchainCreateInfoKHR _info;
+};
+
+}}
+
+/* Make the definition complete -- it doesn't make sense to have a CreateInfo
+   without the corresponding object anyway. */
+#include "Magnum/Vk/Swapchain.h"
+
+#endif
@@ -0,0 +1,148 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Vk/Implementation/buddyAllocator.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct BuddyAllocatorTest: TestSuite::Tester {
+    explicit BuddyAllocatorTest();
+
+    void construct();
+    void allocate();
+    void allocateFull();
+    void free();
+    void freeCoalesce();
+    void freeNoCoalesce();
+};
+
+BuddyAllocatorTest::BuddyAllocatorTest() {
+    addTests({&BuddyAllocatorTest::construct,
+              &BuddyAllocatorTest::allocate,
+              &BuddyAllocatorTest::allocateFull,
+              &BuddyAllocatorTest::free,
+              &BuddyAllocatorTest::freeCoalesce,
+              &BuddyAllocatorTest::freeNoCoalesce});
+}
+
+using Implementation::BuddyAllocator;
+
+void BuddyAllocatorTest::construct() {
+    BuddyAllocator allocator{1024, 64};
+    CORRADE_COMPARE(allocator.size(), 1024);
+    CORRADE_COMPARE(allocator.minNodeSize(), 64);
+    CORRADE_COMPARE(allocator.usedSize(), 0);
+    CORRADE_VERIFY(allocator.isEmpty());
+    CORRADE_COMPARE(allocator.largestFreeNodeSize(), 1024);
+}
+
+void BuddyAllocatorTest::allocate() {
+    BuddyAllocator allocator{1024, 64};
+
+    /* The first allocation splits the block all the way down */
+    CORRADE_COMPARE(allocator.allocate(64), 0);
+    CORRADE_COMPARE(allocator.usedSize(), 64);
+    CORRADE_VERIFY(!allocator.isEmpty());
+    CORRADE_COMPARE(allocator.largestFreeNodeSize(), 512);
+
+    /* The buddy of the first node is used next */
+    CORRADE_COMPARE(allocator.allocate(64), 64);
+    CORRADE_COMPARE(allocator.allocate(128), 128);
+    /* Each node is aligned to its size */
+    CORRADE_COMPARE(allocator.allocate(256), 256);
+    CORRADE_COMPARE(allocator.allocate(256), 512);
+    CORRADE_COMPARE(allocator.usedSize(), 768);
+    CORRADE_COMPARE(allocator.largestFreeNodeSize(), 256);
+}
+
+void BuddyAllocatorTest::allocateFull() {
+    BuddyAllocator allocator{1024, 64};
+    CORRADE_COMPARE(allocator.allocate(512), 0);
+    CORRADE_COMPARE(allocator.allocate(256), 512);
+
+    /* There's no 512-byte node anymore */
+    CORRADE_COMPARE(allocator.allocate(512), ~UnsignedLong{});
+    CORRADE_COMPARE(allocator.usedSize(), 768);
+
+    CORRADE_COMPARE(allocator.allocate(256), 768);
+    CORRADE_COMPARE(allocator.allocate(64), ~UnsignedLong{});
+    CORRADE_COMPARE(allocator.largestFreeNodeSize(), 0);
+}
+
+void BuddyAllocatorTest::free() {
+    BuddyAllocator allocator{1024, 64};
+    CORRADE_COMPARE(allocator.allocate(256), 0);
+    CORRADE_COMPARE(allocator.allocate(256), 256);
+
+    allocator.free(0, 256);
+    CORRADE_COMPARE(allocator.usedSize(), 256);
+
+    /* The freed node gets reused */
+    CORRADE_COMPARE(allocator.allocate(128), 0);
+    CORRADE_COMPARE(allocator.usedSize(), 384);
+}
+
+void BuddyAllocatorTest::freeCoalesce() {
+    BuddyAllocator allocator{1024, 64};
+    const UnsignedLong a = allocator.allocate(64);
+    const UnsignedLong b = allocator.allocate(64);
+    const UnsignedLong c = allocator.allocate(128);
+    const UnsignedLong d = allocator.allocate(512);
+    CORRADE_COMPARE(allocator.largestFreeNodeSize(), 256);
+
+    allocator.free(b, 64);
+    allocator.free(a, 64);
+    CORRADE_COMPARE(allocator.largestFreeNodeSize(), 256);
+
+    /* Once all buddies are free, the nodes are merged back */
+    allocator.free(c, 128);
+    CORRADE_COMPARE(allocator.largestFreeNodeSize(), 512);
+    allocator.free(d, 512);
+    CORRADE_VERIFY(allocator.isEmpty());
+    CORRADE_COMPARE(allocator.largestFreeNodeSize(), 1024);
+
+    /* And the whole block can be allocated again */
+    CORRADE_COMPARE(allocator.allocate(1024), 0);
+}
+
+void BuddyAllocatorTest::freeNoCoalesce() {
+    BuddyAllocator allocator{1024, 64};
+    const UnsignedLong a = allocator.allocate(64);
+    CORRADE_COMPARE(allocator.allocate(64), 64);
+    const UnsignedLong c = allocator.allocate(64);
+    CORRADE_COMPARE(allocator.allocate(64), 192);
+
+    /* Nodes 0 and 128 aren't buddies, so they stay separate */
+    allocator.free(a, 64);
+    allocator.free(c, 64);
+    CORRADE_COMPARE(allocator.largestFreeNodeSize(), 512);
+    CORRADE_COMPARE(allocator.allocate(128), 256);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::BuddyAllocatorTest)
@@ -44,6 +44,7 @@ struct BufferTest: TestSuite::Tester {
     void constructCopy();
 
     void dedicatedMemoryNotDedicated();
+    void allocatedMemoryNotAllocated();
 
     /* While *ConstructFromVk() tests that going from VkFromThing -> Vk::Thing
        -> VkToThing doesn't result in information loss, the *ConvertToVk()
@@ -72,6 +73,7 @@ BufferTest::BufferTest() {
               &BufferTest::constructCopy,
 
               &BufferTest::dedicatedMemoryNotDedicated,
+              &BufferTest::allocatedMemoryNotAllocated,
 
               &BufferTest::bufferCopyConstruct,
               &BufferTest::bufferCopyConstructNoInit,
@@ -161,6 +163,21 @@ void BufferTest::dedicatedMemoryNotDedicated() {
     CORRADE_COMPARE(out.str(), "Vk::Buffer::dedicatedMemory(): buffer doesn't have a dedicated memory\n");
 }
 
+void BufferTest::allocatedMemoryNotAllocated() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Buffer buffer{NoCreate};
+    CORRADE_VERIFY(!buffer.hasAllocatedMemory());
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    buffer.allocatedMemory();
+    buffer.bindAllocatedMemory(MemoryAllocation{NoCreate});
+    CORRADE_COMPARE(out.str(),
+        "Vk::Buffer::allocatedMemory(): buffer doesn't have an allocated memory\n"
+        "Vk::Buffer::bindAllocatedMemory(): the allocation is not created\n");
+}
+
 void BufferTest::bufferCopyConstruct() {
     BufferCopy copy{3, 5, 7};
     CORRADE_COMPARE(copy->srcOffset, 3);
@@ -33,28 +33,105 @@ namespace Magnum { namespace Vk { namespace Test { namespace {
 struct CommandBufferTest: TestSuite::Tester {
     explicit CommandBufferTest();
 
+    void inheritanceInfoConstruct();
+    void inheritanceInfoConstructRenderPass();
+    void inheritanceInfoConstructNoInit();
+    void inheritanceInfoConstructFromVk();
+
     void beginInfoConstruct();
+    void beginInfoConstructInheritance();
+    void beginInfoConstructInheritanceRenderPass();
     void beginInfoConstructNoInit();
     void beginInfoConstructFromVk();
+    void beginInfoConstructCopy();
 
     void constructNoCreate();
     void constructCopy();
 };
 
 CommandBufferTest::CommandBufferTest() {
-    addTests({&CommandBufferTest::beginInfoConstruct,
+    addTests({&CommandBufferTest::inheritanceInfoConstruct,
+              &CommandBufferTest::inheritanceInfoConstructRenderPass,
+              &CommandBufferTest::inheritanceInfoConstructNoInit,
+              &CommandBufferTest::inheritanceInfoConstructFromVk,
+
+              &CommandBufferTest::beginInfoConstruct,
+              &CommandBufferTest::beginInfoConstructInheritance,
+              &CommandBufferTest::beginInfoConstructInheritanceRenderPass,
               &CommandBufferTest::beginInfoConstructNoInit,
               &CommandBufferTest::beginInfoConstructFromVk,
+              &CommandBufferTest::beginInfoConstructCopy,
 
               &CommandBufferTest::constructNoCreate,
               &CommandBufferTest::constructCopy});
 }
 
+void CommandBufferTest::inheritanceInfoConstruct() {
+    CommandBufferInheritanceInfo info;
+    CORRADE_COMPARE(info->sType, VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO);
+    CORRADE_VERIFY(!info->renderPass);
+    CORRADE_COMPARE(info->subpass, 0);
+    CORRADE_VERIFY(!info->framebuffer);
+}
+
+void CommandBufferTest::inheritanceInfoConstructRenderPass() {
+    auto renderPass = reinterpret_cast<VkRenderPass>(reinterpret_cast<void*>(0xdead));
+    auto framebuffer = reinterpret_cast<VkFramebuffer>(reinterpret_cast<void*>(0xbeef));
+
+    CommandBufferInheritanceInfo info{renderPass, 3, framebuffer};
+    CORRADE_COMPARE(info->renderPass, renderPass);
+    CORRADE_COMPARE(info->subpass, 3);
+    CORRADE_COMPARE(info->framebuffer, framebuffer);
+}
+
+void CommandBufferTest::inheritanceInfoConstructNoInit() {
+    CommandBufferInheritanceInfo info{NoInit};
+    info->sType = VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2;
+    new(&info) CommandBufferInheritanceInfo{NoInit};
+    CORRADE_COMPARE(info->sType, VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2);
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<CommandBufferInheritanceInfo, NoInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoInitT, CommandBufferInheritanceInfo>::value);
+}
+
+void CommandBufferTest::inheritanceInfoConstructFromVk() {
+    VkCommandBufferInheritanceInfo vkInfo;
+    vkInfo.sType = VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2;
+
+    CommandBufferInheritanceInfo info{vkInfo};
+    CORRADE_COMPARE(info->sType, VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2);
+}
+
 void CommandBufferTest::beginInfoConstruct() {
     CommandBufferBeginInfo info{CommandBufferBeginInfo::Flag::OneTimeSubmit};
     CORRADE_COMPARE(info->flags, VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
 }
 
+void CommandBufferTest::beginInfoConstructInheritance() {
+    CommandBufferInheritanceInfo inheritanceInfo;
+    inheritanceInfo->occlusionQueryEnable = true;
+
+    CommandBufferBeginInfo info{inheritanceInfo, CommandBufferBeginInfo::Flag::OneTimeSubmit};
+    /* No render pass, so the flag isn't added */
+    CORRADE_COMPARE(info->flags, VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+    CORRADE_VERIFY(info->pInheritanceInfo);
+    /* It's a copy */
+    CORRADE_VERIFY(info->pInheritanceInfo != inheritanceInfo);
+    CORRADE_COMPARE(info->pInheritanceInfo->occlusionQueryEnable, true);
+}
+
+void CommandBufferTest::beginInfoConstructInheritanceRenderPass() {
+    auto renderPass = reinterpret_cast<VkRenderPass>(reinterpret_cast<void*>(0xdead));
+
+    CommandBufferBeginInfo info{CommandBufferInheritanceInfo{renderPass, 2}};
+    CORRADE_COMPARE(info->flags, VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT);
+    CORRADE_VERIFY(info->pInheritanceInfo);
+    CORRADE_COMPARE(info->pInheritanceInfo->renderPass, renderPass);
+    CORRADE_COMPARE(info->pInheritanceInfo->subpass, 2);
+}
+
 void CommandBufferTest::beginInfoConstructNoInit() {
     CommandBufferBeginInfo info{NoInit};
     info->sType = VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2;
@@ -75,6 +152,31 @@ void CommandBufferTest::beginInfoConstructFromVk() {
     CORRADE_COMPARE(info->sType, VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2);
 }
 
+void CommandBufferTest::beginInfoConstructCopy() {
+    CommandBufferBeginInfo a{CommandBufferInheritanceInfo{{}, 3}};
+    CORRADE_VERIFY(a->pInheritanceInfo);
+
+    CommandBufferBeginInfo b = a;
+    CORRADE_VERIFY(b->pInheritanceInfo);
+    /* Points to its own copy */
+    CORRADE_VERIFY(b->pInheritanceInfo != a->pInheritanceInfo);
+    CORRADE_COMPARE(b->pInheritanceInfo->subpass, 3);
+
+    CommandBufferBeginInfo c;
+    c = b;
+    CORRADE_VERIFY(c->pInheritanceInfo);
+    CORRADE_VERIFY(c->pInheritanceInfo != b->pInheritanceInfo);
+    CORRADE_COMPARE(c->pInheritanceInfo->subpass, 3);
+
+    /* An external pointer is kept as-is */
+    VkCommandBufferInheritanceInfo external{};
+    VkCommandBufferBeginInfo vkInfo{};
+    vkInfo.pInheritanceInfo = &external;
+    CommandBufferBeginInfo d{vkInfo};
+    CommandBufferBeginInfo e = d;
+    CORRADE_COMPARE(e->pInheritanceInfo, &external);
+}
+
 void CommandBufferTest::constructNoCreate() {
     {
         CommandBuffer buffer{NoCreate};
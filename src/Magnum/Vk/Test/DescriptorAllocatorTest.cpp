@@ -0,0 +1,147 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Vk/DescriptorAllocator.h"
+#include "Magnum/Vk/DescriptorSet.h"
+#include "Magnum/Vk/DescriptorType.h"
+#include "Magnum/Vk/Device.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct DescriptorAllocatorTest: TestSuite::Tester {
+    explicit DescriptorAllocatorTest();
+
+    void constructNoCreate();
+    void constructZeroFrames();
+    void constructFreeDescriptorSet();
+    void constructCopy();
+
+    void poolCountOutOfRange();
+    void beginFrameOutOfRange();
+    void allocateNoCreate();
+};
+
+DescriptorAllocatorTest::DescriptorAllocatorTest() {
+    addTests({&DescriptorAllocatorTest::constructNoCreate,
+              &DescriptorAllocatorTest::constructZeroFrames,
+              &DescriptorAllocatorTest::constructFreeDescriptorSet,
+              &DescriptorAllocatorTest::constructCopy,
+
+              &DescriptorAllocatorTest::poolCountOutOfRange,
+              &DescriptorAllocatorTest::beginFrameOutOfRange,
+              &DescriptorAllocatorTest::allocateNoCreate});
+}
+
+void DescriptorAllocatorTest::constructNoCreate() {
+    {
+        DescriptorAllocator allocator{NoCreate};
+        CORRADE_COMPARE(allocator.frameCount(), 0);
+        CORRADE_COMPARE(allocator.frameIndex(), 0);
+    }
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoCreateT, DescriptorAllocator>::value);
+}
+
+void DescriptorAllocatorTest::constructZeroFrames() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Device device{NoCreate};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    DescriptorAllocator{device, DescriptorPoolCreateInfo{1, {
+        {DescriptorType::UniformBuffer, 1}
+    }}, 0};
+    CORRADE_COMPARE(out.str(), "Vk::DescriptorAllocator: expected non-zero frame count\n");
+}
+
+void DescriptorAllocatorTest::constructFreeDescriptorSet() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Device device{NoCreate};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    DescriptorAllocator{device, DescriptorPoolCreateInfo{1, {
+        {DescriptorType::UniformBuffer, 1}
+    }, DescriptorPoolCreateInfo::Flag::FreeDescriptorSet}};
+    CORRADE_COMPARE(out.str(), "Vk::DescriptorAllocator: pools with Vk::DescriptorPoolCreateInfo::Flag::FreeDescriptorSet are not allowed\n");
+}
+
+void DescriptorAllocatorTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<DescriptorAllocator>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<DescriptorAllocator>{});
+}
+
+void DescriptorAllocatorTest::poolCountOutOfRange() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Device device{NoCreate};
+    DescriptorAllocator allocator{device, DescriptorPoolCreateInfo{1, {
+        {DescriptorType::UniformBuffer, 1}
+    }}, 3};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    allocator.poolCount(3);
+    CORRADE_COMPARE(out.str(), "Vk::DescriptorAllocator::poolCount(): index 3 out of range for 3 frames\n");
+}
+
+void DescriptorAllocatorTest::beginFrameOutOfRange() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Device device{NoCreate};
+    DescriptorAllocator allocator{device, DescriptorPoolCreateInfo{1, {
+        {DescriptorType::UniformBuffer, 1}
+    }}, 3};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    allocator.beginFrame(3);
+    CORRADE_COMPARE(out.str(), "Vk::DescriptorAllocator::beginFrame(): index 3 out of range for 3 frames\n");
+}
+
+void DescriptorAllocatorTest::allocateNoCreate() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    DescriptorAllocator allocator{NoCreate};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    allocator.allocate({});
+    allocator.allocate({}, 3);
+    CORRADE_COMPARE(out.str(),
+        "Vk::DescriptorAllocator::allocate(): the allocator is not created\n"
+        "Vk::DescriptorAllocator::allocate(): the allocator is not created\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::DescriptorAllocatorTest)
@@ -0,0 +1,186 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Vk/DescriptorAllocator.h"
+#include "Magnum/Vk/DescriptorSet.h"
+#include "Magnum/Vk/DescriptorSetLayoutCreateInfo.h"
+#include "Magnum/Vk/DescriptorType.h"
+#include "Magnum/Vk/VulkanTester.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct DescriptorAllocatorVkTest: VulkanTester {
+    explicit DescriptorAllocatorVkTest();
+
+    void construct();
+    void constructMove();
+
+    void allocate();
+    void allocateGrow();
+    void allocateDoesNotFit();
+
+    void beginFrame();
+};
+
+DescriptorAllocatorVkTest::DescriptorAllocatorVkTest() {
+    addTests({&DescriptorAllocatorVkTest::construct,
+              &DescriptorAllocatorVkTest::constructMove,
+
+              &DescriptorAllocatorVkTest::allocate,
+              &DescriptorAllocatorVkTest::allocateGrow,
+              &DescriptorAllocatorVkTest::allocateDoesNotFit,
+
+              &DescriptorAllocatorVkTest::beginFrame});
+}
+
+void DescriptorAllocatorVkTest::construct() {
+    {
+        DescriptorAllocator allocator{device(), DescriptorPoolCreateInfo{2, {
+            {DescriptorType::UniformBuffer, 2}
+        }}, 3};
+        CORRADE_COMPARE(allocator.frameCount(), 3);
+        CORRADE_COMPARE(allocator.frameIndex(), 0);
+        /* No pools are created upfront */
+        CORRADE_COMPARE(allocator.poolCount(0), 0);
+        CORRADE_COMPARE(allocator.poolCount(2), 0);
+    }
+
+    /* Shouldn't crash or anything */
+    CORRADE_VERIFY(true);
+}
+
+void DescriptorAllocatorVkTest::constructMove() {
+    DescriptorSetLayout layout{device(), DescriptorSetLayoutCreateInfo{
+        {{0, DescriptorType::UniformBuffer}}
+    }};
+
+    DescriptorAllocator a{device(), DescriptorPoolCreateInfo{2, {
+        {DescriptorType::UniformBuffer, 2}
+    }}, 3};
+    a.allocate(layout);
+    CORRADE_COMPARE(a.poolCount(0), 1);
+
+    DescriptorAllocator b = std::move(a);
+    CORRADE_COMPARE(a.frameCount(), 0);
+    CORRADE_COMPARE(b.frameCount(), 3);
+    CORRADE_COMPARE(b.poolCount(0), 1);
+
+    DescriptorAllocator c{NoCreate};
+    c = std::move(b);
+    CORRADE_COMPARE(b.frameCount(), 0);
+    CORRADE_COMPARE(c.frameCount(), 3);
+    CORRADE_COMPARE(c.poolCount(0), 1);
+
+    /* The moved-to instance should be still usable */
+    CORRADE_VERIFY(c.allocate(layout).handle());
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<DescriptorAllocator>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<DescriptorAllocator>::value);
+}
+
+void DescriptorAllocatorVkTest::allocate() {
+    DescriptorSetLayout layout{device(), DescriptorSetLayoutCreateInfo{
+        {{0, DescriptorType::UniformBuffer}}
+    }};
+
+    DescriptorAllocator allocator{device(), DescriptorPoolCreateInfo{2, {
+        {DescriptorType::UniformBuffer, 2}
+    }}};
+
+    DescriptorSet a = allocator.allocate(layout);
+    DescriptorSet b = allocator.allocate(layout);
+    CORRADE_VERIFY(a.handle());
+    CORRADE_VERIFY(b.handle());
+    CORRADE_VERIFY(a.handle() != b.handle());
+    /* The sets get freed only on pool reset */
+    CORRADE_COMPARE(a.handleFlags(), HandleFlags{});
+    CORRADE_COMPARE(b.handleFlags(), HandleFlags{});
+
+    /* Both fit into a single pool */
+    CORRADE_COMPARE(allocator.poolCount(0), 1);
+    CORRADE_COMPARE(allocator.poolCount(1), 0);
+}
+
+void DescriptorAllocatorVkTest::allocateGrow() {
+    DescriptorSetLayout layout{device(), DescriptorSetLayoutCreateInfo{
+        {{0, DescriptorType::UniformBuffer}}
+    }};
+
+    DescriptorAllocator allocator{device(), DescriptorPoolCreateInfo{2, {
+        {DescriptorType::UniformBuffer, 2}
+    }}};
+
+    /* Five sets need three pools */
+    for(std::size_t i = 0; i != 5; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_VERIFY(allocator.allocate(layout).handle());
+    }
+    CORRADE_COMPARE(allocator.poolCount(0), 3);
+}
+
+void DescriptorAllocatorVkTest::allocateDoesNotFit() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    DescriptorSetLayout layout{device(), DescriptorSetLayoutCreateInfo{
+        {{0, DescriptorType::UniformBuffer, 3}}
+    }};
+
+    DescriptorAllocator allocator{device(), DescriptorPoolCreateInfo{2, {
+        {DescriptorType::UniformBuffer, 2}
+    }}};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    allocator.allocate(layout);
+    CORRADE_COMPARE(out.str(), "Vk::DescriptorAllocator::allocate(): layout doesn't fit into an empty pool\n");
+}
+
+void DescriptorAllocatorVkTest::beginFrame() {
+    DescriptorSetLayout layout{device(), DescriptorSetLayoutCreateInfo{
+        {{0, DescriptorType::UniformBuffer}}
+    }};
+
+    DescriptorAllocator allocator{device(), DescriptorPoolCreateInfo{2, {
+        {DescriptorType::UniformBuffer, 2}
+    }}};
+
+    /* Two frames, each allocating five sets. The pool count for each frame
+       should stay the same, as the pools get reused after a reset. */
+    for(UnsignedInt frame: {0, 1, 0, 1, 0, 1}) {
+        CORRADE_ITERATION(frame);
+        allocator.beginFrame(frame);
+        CORRADE_COMPARE(allocator.frameIndex(), frame);
+        for(std::size_t i = 0; i != 5; ++i)
+            CORRADE_VERIFY(allocator.allocate(layout).handle());
+        CORRADE_COMPARE(allocator.poolCount(frame), 3);
+    }
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::DescriptorAllocatorVkTest)
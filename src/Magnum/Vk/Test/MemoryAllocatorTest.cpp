@@ -0,0 +1,106 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Vk/MemoryAllocator.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct MemoryAllocatorTest: TestSuite::Tester {
+    explicit MemoryAllocatorTest();
+
+    void constructNoCreate();
+    void constructCopy();
+
+    void allocationConstructNoCreate();
+    void allocationConstructCopy();
+    void allocationMemoryNotCreated();
+};
+
+MemoryAllocatorTest::MemoryAllocatorTest() {
+    addTests({&MemoryAllocatorTest::constructNoCreate,
+              &MemoryAllocatorTest::constructCopy,
+
+              &MemoryAllocatorTest::allocationConstructNoCreate,
+              &MemoryAllocatorTest::allocationConstructCopy,
+              &MemoryAllocatorTest::allocationMemoryNotCreated});
+}
+
+void MemoryAllocatorTest::constructNoCreate() {
+    {
+        MemoryAllocator allocator{NoCreate};
+        CORRADE_COMPARE(allocator.blockSize(), 0);
+        CORRADE_COMPARE(allocator.blockCount(), 0);
+        CORRADE_COMPARE(allocator.allocationCount(), 0);
+        CORRADE_COMPARE(allocator.allocatedSize(), 0);
+        CORRADE_COMPARE(allocator.fragmentation(), 0.0f);
+    }
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoCreateT, MemoryAllocator>::value);
+}
+
+void MemoryAllocatorTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<MemoryAllocator>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<MemoryAllocator>{});
+}
+
+void MemoryAllocatorTest::allocationConstructNoCreate() {
+    {
+        MemoryAllocation allocation{NoCreate};
+        CORRADE_VERIFY(!allocation.isCreated());
+        CORRADE_VERIFY(!allocation.isDedicated());
+        CORRADE_COMPARE(allocation.offset(), 0);
+        CORRADE_COMPARE(allocation.size(), 0);
+    }
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<MemoryAllocation, NoCreateT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoCreateT, MemoryAllocation>::value);
+}
+
+void MemoryAllocatorTest::allocationConstructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<MemoryAllocation>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<MemoryAllocation>{});
+}
+
+void MemoryAllocatorTest::allocationMemoryNotCreated() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    MemoryAllocation allocation{NoCreate};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    allocation.memory();
+    CORRADE_COMPARE(out.str(), "Vk::MemoryAllocation::memory(): the allocation is not created\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::MemoryAllocatorTest)
@@ -0,0 +1,263 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Compare/Numeric.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Vk/BufferCreateInfo.h"
+#include "Magnum/Vk/DeviceProperties.h"
+#include "Magnum/Vk/ImageCreateInfo.h"
+#include "Magnum/Vk/MemoryAllocateInfo.h"
+#include "Magnum/Vk/MemoryAllocator.h"
+#include "Magnum/Vk/PixelFormat.h"
+#include "Magnum/Vk/VulkanTester.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct MemoryAllocatorVkTest: VulkanTester {
+    explicit MemoryAllocatorVkTest();
+
+    void construct();
+    void constructMove();
+
+    void allocate();
+    void allocateNewBlock();
+    void allocateDedicated();
+    void allocateDedicatedThreshold();
+
+    void releaseEmptyBlocks();
+
+    void buffer();
+    void image();
+};
+
+MemoryAllocatorVkTest::MemoryAllocatorVkTest() {
+    addTests({&MemoryAllocatorVkTest::construct,
+              &MemoryAllocatorVkTest::constructMove,
+
+              &MemoryAllocatorVkTest::allocate,
+              &MemoryAllocatorVkTest::allocateNewBlock,
+              &MemoryAllocatorVkTest::allocateDedicated,
+              &MemoryAllocatorVkTest::allocateDedicatedThreshold,
+
+              &MemoryAllocatorVkTest::releaseEmptyBlocks,
+
+              &MemoryAllocatorVkTest::buffer,
+              &MemoryAllocatorVkTest::image});
+}
+
+void MemoryAllocatorVkTest::construct() {
+    MemoryAllocator allocator{device(), 1024*1024, 256*1024};
+    CORRADE_COMPARE(allocator.blockSize(), 1024*1024);
+    CORRADE_COMPARE(allocator.dedicatedThreshold(), 256*1024);
+    CORRADE_COMPARE_AS(allocator.minAllocationSize(), 256,
+        TestSuite::Compare::GreaterOrEqual);
+    CORRADE_COMPARE_AS(allocator.minAllocationSize(), device().properties().properties().properties.limits.bufferImageGranularity,
+        TestSuite::Compare::GreaterOrEqual);
+    CORRADE_COMPARE(allocator.blockCount(), 0);
+    CORRADE_COMPARE(allocator.allocationCount(), 0);
+    CORRADE_COMPARE(allocator.allocatedSize(), 0);
+    CORRADE_COMPARE(allocator.usedSize(), 0);
+}
+
+void MemoryAllocatorVkTest::constructMove() {
+    MemoryAllocator a{device(), 1024*1024, 256*1024};
+    MemoryAllocation allocation = a.allocate(device().properties().pickMemory(MemoryFlag::DeviceLocal), 1000, 16);
+
+    /* The allocation should stay valid after the move */
+    MemoryAllocator b = std::move(a);
+    CORRADE_COMPARE(a.blockSize(), 0);
+    CORRADE_COMPARE(b.blockSize(), 1024*1024);
+    CORRADE_COMPARE(b.allocationCount(), 1);
+
+    MemoryAllocator c{NoCreate};
+    c = std::move(b);
+    CORRADE_COMPARE(b.blockSize(), 0);
+    CORRADE_COMPARE(c.blockSize(), 1024*1024);
+    CORRADE_COMPARE(c.allocationCount(), 1);
+
+    allocation = MemoryAllocation{NoCreate};
+    CORRADE_COMPARE(c.allocationCount(), 0);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<MemoryAllocator>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<MemoryAllocator>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<MemoryAllocation>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<MemoryAllocation>::value);
+}
+
+void MemoryAllocatorVkTest::allocate() {
+    MemoryAllocator allocator{device(), 1024*1024, 256*1024};
+    const UnsignedInt memory = device().properties().pickMemory(MemoryFlag::DeviceLocal);
+    const UnsignedLong min = allocator.minAllocationSize();
+
+    MemoryAllocation a = allocator.allocate(memory, 1000, 16);
+    CORRADE_VERIFY(a.isCreated());
+    CORRADE_VERIFY(!a.isDedicated());
+    CORRADE_VERIFY(a.memory().handle());
+    CORRADE_COMPARE(a.memory().size(), 1024*1024);
+    CORRADE_COMPARE(a.offset(), 0);
+    CORRADE_COMPARE(a.size(), 1000);
+    CORRADE_COMPARE(a.memoryType(), memory);
+
+    /* Second allocation is in the same block */
+    MemoryAllocation b = allocator.allocate(memory, 100, 512);
+    CORRADE_COMPARE(b.memory().handle(), a.memory().handle());
+    CORRADE_COMPARE(b.offset() % 512, 0);
+    CORRADE_VERIFY(b.offset() >= Math::max(UnsignedLong{1024}, min));
+    CORRADE_COMPARE(allocator.blockCount(), 1);
+    CORRADE_COMPARE(allocator.allocationCount(), 2);
+    CORRADE_COMPARE(allocator.dedicatedAllocationCount(), 0);
+    CORRADE_COMPARE(allocator.allocatedSize(), 1024*1024);
+    CORRADE_COMPARE(allocator.usedSize(), Math::max(UnsignedLong{1024}, min) + Math::max(UnsignedLong{512}, min));
+
+    /* Freeing returns the space back */
+    a = MemoryAllocation{NoCreate};
+    b = MemoryAllocation{NoCreate};
+    CORRADE_COMPARE(allocator.allocationCount(), 0);
+    CORRADE_COMPARE(allocator.usedSize(), 0);
+    CORRADE_COMPARE(allocator.fragmentation(), 0.0f);
+    /* The block is kept around */
+    CORRADE_COMPARE(allocator.blockCount(), 1);
+}
+
+void MemoryAllocatorVkTest::allocateNewBlock() {
+    MemoryAllocator allocator{device(), 1024*1024, 1024*1024};
+    const UnsignedInt memory = device().properties().pickMemory(MemoryFlag::DeviceLocal);
+
+    MemoryAllocation a = allocator.allocate(memory, 768*1024, 16);
+    MemoryAllocation b = allocator.allocate(memory, 768*1024, 16);
+    CORRADE_VERIFY(!a.isDedicated());
+    CORRADE_VERIFY(!b.isDedicated());
+    CORRADE_VERIFY(a.memory().handle() != b.memory().handle());
+    CORRADE_COMPARE(b.offset(), 0);
+    CORRADE_COMPARE(allocator.blockCount(), 2);
+    CORRADE_COMPARE(allocator.allocatedSize(), 2*1024*1024);
+}
+
+void MemoryAllocatorVkTest::allocateDedicated() {
+    MemoryAllocator allocator{device(), 1024*1024, 256*1024};
+
+    MemoryRequirements requirements;
+    requirements->memoryRequirements.size = 1000;
+    requirements->memoryRequirements.alignment = 16;
+    requirements->memoryRequirements.memoryTypeBits = ~UnsignedInt{};
+    MemoryAllocation a = allocator.allocateDedicated(requirements, MemoryFlag::DeviceLocal);
+    CORRADE_VERIFY(a.isCreated());
+    CORRADE_VERIFY(a.isDedicated());
+    CORRADE_COMPARE(a.memory().size(), 1000);
+    CORRADE_COMPARE(a.offset(), 0);
+    CORRADE_COMPARE(a.size(), 1000);
+    CORRADE_COMPARE(allocator.blockCount(), 0);
+    CORRADE_COMPARE(allocator.allocationCount(), 1);
+    CORRADE_COMPARE(allocator.dedicatedAllocationCount(), 1);
+    CORRADE_COMPARE(allocator.allocatedSize(), 1000);
+
+    a = MemoryAllocation{NoCreate};
+    CORRADE_COMPARE(allocator.allocationCount(), 0);
+    CORRADE_COMPARE(allocator.dedicatedAllocationCount(), 0);
+    CORRADE_COMPARE(allocator.allocatedSize(), 0);
+}
+
+void MemoryAllocatorVkTest::allocateDedicatedThreshold() {
+    MemoryAllocator allocator{device(), 1024*1024, 256*1024};
+    const UnsignedInt memory = device().properties().pickMemory(MemoryFlag::DeviceLocal);
+
+    MemoryAllocation a = allocator.allocate(memory, 256*1024 - 1, 16);
+    CORRADE_VERIFY(!a.isDedicated());
+
+    MemoryAllocation b = allocator.allocate(memory, 256*1024, 16);
+    CORRADE_VERIFY(b.isDedicated());
+    CORRADE_COMPARE(b.memory().size(), 256*1024);
+    CORRADE_COMPARE(allocator.dedicatedAllocationCount(), 1);
+}
+
+void MemoryAllocatorVkTest::releaseEmptyBlocks() {
+    MemoryAllocator allocator{device(), 1024*1024, 1024*1024};
+    const UnsignedInt memory = device().properties().pickMemory(MemoryFlag::DeviceLocal);
+
+    MemoryAllocation a = allocator.allocate(memory, 768*1024, 16);
+    MemoryAllocation b = allocator.allocate(memory, 768*1024, 16);
+    MemoryAllocation c = allocator.allocate(memory, 768*1024, 16);
+    CORRADE_COMPARE(allocator.blockCount(), 3);
+
+    /* Releasing a block in the middle keeps the indices of the others
+       stable */
+    b = MemoryAllocation{NoCreate};
+    CORRADE_COMPARE(allocator.releaseEmptyBlocks(), 1);
+    CORRADE_COMPARE(allocator.blockCount(), 2);
+    CORRADE_COMPARE(allocator.allocatedSize(), 2*1024*1024);
+    CORRADE_VERIFY(a.memory().handle());
+    CORRADE_VERIFY(c.memory().handle());
+
+    /* The released slot gets reused by a new block */
+    MemoryAllocation d = allocator.allocate(memory, 768*1024, 16);
+    CORRADE_COMPARE(allocator.blockCount(), 3);
+    CORRADE_VERIFY(d.memory().handle() != a.memory().handle());
+    CORRADE_VERIFY(d.memory().handle() != c.memory().handle());
+
+    /* Nothing to release now */
+    CORRADE_COMPARE(allocator.releaseEmptyBlocks(), 0);
+}
+
+void MemoryAllocatorVkTest::buffer() {
+    MemoryAllocator allocator{device()};
+
+    Buffer a{device(), BufferCreateInfo{BufferUsage::StorageBuffer, 16384}, allocator, MemoryFlag::DeviceLocal};
+    Buffer b{device(), BufferCreateInfo{BufferUsage::StorageBuffer, 16384}, allocator, MemoryFlag::DeviceLocal};
+    CORRADE_VERIFY(!a.hasDedicatedMemory());
+    CORRADE_VERIFY(a.hasAllocatedMemory());
+    CORRADE_VERIFY(b.hasAllocatedMemory());
+    CORRADE_COMPARE(a.allocatedMemory().memory().handle(), b.allocatedMemory().memory().handle());
+    CORRADE_VERIFY(a.allocatedMemory().offset() != b.allocatedMemory().offset());
+    CORRADE_COMPARE(allocator.allocationCount(), 2);
+
+    /* Moving the buffer moves the allocation as well */
+    Buffer c = std::move(a);
+    CORRADE_VERIFY(!a.hasAllocatedMemory());
+    CORRADE_VERIFY(c.hasAllocatedMemory());
+    CORRADE_COMPARE(allocator.allocationCount(), 2);
+
+    /* Destroying the buffer returns the allocation */
+    c = Buffer{NoCreate};
+    CORRADE_COMPARE(allocator.allocationCount(), 1);
+}
+
+void MemoryAllocatorVkTest::image() {
+    MemoryAllocator allocator{device()};
+
+    {
+        Image image{device(), ImageCreateInfo2D{ImageUsage::Sampled,
+            PixelFormat::RGBA8Unorm, {256, 256}, 1}, allocator, MemoryFlag::DeviceLocal};
+        CORRADE_VERIFY(!image.hasDedicatedMemory());
+        CORRADE_VERIFY(image.hasAllocatedMemory());
+        CORRADE_COMPARE(allocator.allocationCount(), 1);
+    }
+
+    CORRADE_COMPARE(allocator.allocationCount(), 0);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::MemoryAllocatorVkTest)
@@ -23,6 +23,7 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <cstring>
 #include <sstream>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/Optional.h>
@@ -50,6 +51,7 @@
 #include "Magnum/Vk/FramebufferCreateInfo.h"
 #include "Magnum/Vk/ImageCreateInfo.h"
 #include "Magnum/Vk/ImageViewCreateInfo.h"
+#include "Magnum/Vk/Memory.h"
 #include "Magnum/Vk/Mesh.h"
 #include "Magnum/Vk/PipelineLayoutCreateInfo.h"
 #include "Magnum/Vk/PixelFormat.h"
@@ -57,6 +59,7 @@
 #include "Magnum/Vk/RenderPassCreateInfo.h"
 #include "Magnum/Vk/ShaderCreateInfo.h"
 #include "Magnum/Vk/ShaderSet.h"
+#include "Magnum/Vk/Version.h"
 #include "Magnum/Vk/VertexFormat.h"
 #include "Magnum/Vk/VulkanTester.h"
 
@@ -71,6 +74,7 @@ struct MeshVkTest: VulkanTester {
     void setup() { setup(device()); }
     void setupRobustness2();
     void setupExtendedDynamicState();
+    void setupDrawIndirectCount();
     void teardown();
 
     void cmdDraw();
@@ -85,8 +89,14 @@ struct MeshVkTest: VulkanTester {
     void cmdDrawDynamicStride();
     void cmdDrawDynamicStrideInsufficientImplementation();
 
+    void cmdDrawIndirect();
+    void cmdDrawIndirectIndexed();
+    void cmdDrawIndirectZeroCount();
+    void cmdDrawIndirectCount();
+    void cmdDrawIndirectCountNotSupported();
+
     Queue _queue{NoCreate};
-    Device _deviceRobustness2{NoCreate}, _deviceExtendedDynamicState{NoCreate};
+    Device _deviceRobustness2{NoCreate}, _deviceExtendedDynamicState{NoCreate}, _deviceDrawIndirectCount{NoCreate};
     CommandPool _pool{NoCreate};
     Image _color{NoCreate};
     RenderPass _renderPass{NoCreate};
@@ -137,7 +147,19 @@ MeshVkTest::MeshVkTest() {
         &MeshVkTest::setupExtendedDynamicState,
         &MeshVkTest::teardown);
 
-    addTests({&MeshVkTest::cmdDrawDynamicStrideInsufficientImplementation},
+    addTests({&MeshVkTest::cmdDrawDynamicStrideInsufficientImplementation,
+
+              &MeshVkTest::cmdDrawIndirect,
+              &MeshVkTest::cmdDrawIndirectIndexed,
+              &MeshVkTest::cmdDrawIndirectZeroCount},
+        &MeshVkTest::setup,
+        &MeshVkTest::teardown);
+
+    addTests({&MeshVkTest::cmdDrawIndirectCount},
+        &MeshVkTest::setupDrawIndirectCount,
+        &MeshVkTest::teardown);
+
+    addTests({&MeshVkTest::cmdDrawIndirectCountNotSupported},
         &MeshVkTest::setup,
         &MeshVkTest::teardown);
 
@@ -222,6 +244,21 @@ void MeshVkTest::setupExtendedDynamicState() {
     setup(_deviceExtendedDynamicState);
 }
 
+void MeshVkTest::setupDrawIndirectCount() {
+    DeviceProperties properties = pickDevice(instance());
+    /* If the extension isn't supported, do nothing */
+    if(!properties.enumerateExtensionProperties().isSupported<Extensions::KHR::draw_indirect_count>())
+        return;
+
+    /* Create the device only if not already, to avoid spamming the output */
+    if(!_deviceDrawIndirectCount.handle()) _deviceDrawIndirectCount.create(instance(), DeviceCreateInfo{std::move(properties)}
+        .addQueues(QueueFlag::Graphics, {0.0f}, {_queue})
+        .addEnabledExtensions<Extensions::KHR::draw_indirect_count>()
+    );
+
+    setup(_deviceDrawIndirectCount);
+}
+
 void MeshVkTest::teardown() {
     _pool = CommandPool{NoCreate};
     _renderPass = RenderPass{NoCreate};
@@ -880,6 +917,325 @@ void MeshVkTest::cmdDrawDynamicStrideInsufficientImplementation() {
     CORRADE_COMPARE(out.str(), "Vk::CommandBuffer::draw(): dynamic strides supplied for an implementation without extended dynamic state\n");
 }
 
+void MeshVkTest::cmdDrawIndirect() {
+    Mesh mesh{MeshLayout{MeshPrimitive::TriangleStrip}
+        .addBinding(0, sizeof(Vector3))
+        .addAttribute(0, 0, VertexFormat::Vector3, 0)
+    };
+    {
+        Buffer buffer{device(), BufferCreateInfo{
+            BufferUsage::VertexBuffer,
+            sizeof(Vector3)*4
+        }, MemoryFlag::HostVisible};
+        /** @todo ffs fucking casts!!! */
+        Utility::copy(
+            Containers::stridedArrayView(QuadData).slice(&Quad::position),
+            Containers::arrayCast<Vector3>(Containers::arrayView(buffer.dedicatedMemory().map())));
+        /* The count isn't used by indirect draws, so not setting it. The
+           indirect draw shouldn't assert on that either. */
+        mesh.addVertexBuffer(0, std::move(buffer), 0);
+    }
+
+    /* Artificial offset at the beginning to test that the offset is used */
+    Buffer indirect{device(), BufferCreateInfo{
+        BufferUsage::IndirectBuffer, 4 + sizeof(VkDrawIndirectCommand)
+    }, MemoryFlag::HostVisible};
+    {
+        VkDrawIndirectCommand command{4, 1, 0, 0};
+        Containers::Array<char, MemoryMapDeleter> data = indirect.dedicatedMemory().map();
+        std::memcpy(data + 4, &command, sizeof(command));
+    }
+
+    Containers::Optional<Containers::Array<char>> shaderData = Utility::Path::read(Utility::Path::join(VK_TEST_DIR, "MeshTestFiles/flat.spv"));
+    CORRADE_VERIFY(shaderData);
+
+    Shader shader{device(), ShaderCreateInfo{*shaderData}};
+
+    ShaderSet shaderSet;
+    shaderSet
+        .addShader(ShaderStage::Vertex, shader, "ver"_s)
+        .addShader(ShaderStage::Fragment, shader, "fra"_s);
+
+    Pipeline pipeline{device(), RasterizationPipelineCreateInfo{
+            shaderSet, mesh.layout(), _pipelineLayout, _renderPass, 0, 1}
+        .setViewport({{}, Vector2{_framebuffer.size().xy()}})
+    };
+
+    CommandBuffer cmd = _pool.allocate();
+    cmd.begin()
+       .beginRenderPass(Vk::RenderPassBeginInfo{_renderPass, _framebuffer}
+           .clearColor(0, 0x1f1f1f_srgbf)
+        )
+       .bindPipeline(pipeline)
+       .drawIndirect(mesh, indirect, 4, 1)
+       .endRenderPass()
+       .copyImageToBuffer({_color, Vk::ImageLayout::TransferSource, _pixels, {
+            Vk::BufferImageCopy2D{0, Vk::ImageAspect::Color, 0, {{}, _framebuffer.size().xy()}}
+        }})
+       .pipelineBarrier(Vk::PipelineStage::Transfer, Vk::PipelineStage::Host, {
+            {Vk::Access::TransferWrite, Vk::Access::HostRead, _pixels}
+        })
+       .end();
+
+    queue().submit({SubmitInfo{}.setCommandBuffers({cmd})}).wait();
+
+    if(!(_manager.loadState("AnyImageImporter") & PluginManager::LoadState::Loaded) ||
+       !(_manager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("AnyImageImporter / TgaImporter plugins not found.");
+
+    CORRADE_COMPARE_WITH((ImageView2D{Magnum::PixelFormat::RGBA8Unorm,
+        _framebuffer.size().xy(),
+        _pixels.dedicatedMemory().mapRead()}),
+        Utility::Path::join(VK_TEST_DIR, "MeshTestFiles/flat.tga"),
+        DebugTools::CompareImageToFile{_manager});
+}
+
+void MeshVkTest::cmdDrawIndirectIndexed() {
+    Mesh mesh{MeshLayout{MeshPrimitive::Triangles}
+        .addBinding(0, sizeof(Vector3))
+        .addAttribute(0, 0, VertexFormat::Vector3, 0)
+    };
+    {
+        Buffer buffer{device(), BufferCreateInfo{
+            BufferUsage::VertexBuffer|BufferUsage::IndexBuffer,
+            12*4 + sizeof(QuadIndexData)
+        }, MemoryFlag::HostVisible};
+        Containers::Array<char, MemoryMapDeleter> data = buffer.dedicatedMemory().map();
+        /** @todo ffs fucking casts!!! */
+        Utility::copy(Containers::stridedArrayView(QuadData).slice(&Quad::position),
+            Containers::arrayCast<Vector3>(data.prefix(12*4)));
+        Utility::copy(Containers::arrayCast<const char>(QuadIndexData),
+            Containers::stridedArrayView(data).exceptPrefix(12*4));
+        mesh.addVertexBuffer(0, buffer, 0)
+            .setIndexBuffer(std::move(buffer), 12*4, MeshIndexType::UnsignedShort);
+    }
+
+    /* Artificial offset at the beginning to test that the offset is used */
+    Buffer indirect{device(), BufferCreateInfo{
+        BufferUsage::IndirectBuffer, 4 + sizeof(VkDrawIndexedIndirectCommand)
+    }, MemoryFlag::HostVisible};
+    {
+        VkDrawIndexedIndirectCommand command{6, 1, 0, 0, 0};
+        Containers::Array<char, MemoryMapDeleter> data = indirect.dedicatedMemory().map();
+        std::memcpy(data + 4, &command, sizeof(command));
+    }
+
+    Containers::Optional<Containers::Array<char>> shaderData = Utility::Path::read(Utility::Path::join(VK_TEST_DIR, "MeshTestFiles/flat.spv"));
+    CORRADE_VERIFY(shaderData);
+
+    Shader shader{device(), ShaderCreateInfo{*shaderData}};
+
+    ShaderSet shaderSet;
+    shaderSet
+        .addShader(ShaderStage::Vertex, shader, "ver"_s)
+        .addShader(ShaderStage::Fragment, shader, "fra"_s);
+
+    Pipeline pipeline{device(), RasterizationPipelineCreateInfo{
+            shaderSet, mesh.layout(), _pipelineLayout, _renderPass, 0, 1}
+        .setViewport({{}, Vector2{_framebuffer.size().xy()}})
+    };
+
+    CommandBuffer cmd = _pool.allocate();
+    cmd.begin()
+       .beginRenderPass(Vk::RenderPassBeginInfo{_renderPass, _framebuffer}
+           .clearColor(0, 0x1f1f1f_srgbf)
+        )
+       .bindPipeline(pipeline)
+       .drawIndirect(mesh, indirect, 4, 1)
+       .endRenderPass()
+       .copyImageToBuffer({_color, Vk::ImageLayout::TransferSource, _pixels, {
+            Vk::BufferImageCopy2D{0, Vk::ImageAspect::Color, 0, {{}, _framebuffer.size().xy()}}
+        }})
+       .pipelineBarrier(Vk::PipelineStage::Transfer, Vk::PipelineStage::Host, {
+            {Vk::Access::TransferWrite, Vk::Access::HostRead, _pixels}
+        })
+       .end();
+
+    queue().submit({SubmitInfo{}.setCommandBuffers({cmd})}).wait();
+
+    if(!(_manager.loadState("AnyImageImporter") & PluginManager::LoadState::Loaded) ||
+       !(_manager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("AnyImageImporter / TgaImporter plugins not found.");
+
+    CORRADE_COMPARE_WITH((ImageView2D{Magnum::PixelFormat::RGBA8Unorm,
+        _framebuffer.size().xy(),
+        _pixels.dedicatedMemory().mapRead()}),
+        Utility::Path::join(VK_TEST_DIR, "MeshTestFiles/flat.tga"),
+        DebugTools::CompareImageToFile{_manager});
+}
+
+void MeshVkTest::cmdDrawIndirectZeroCount() {
+    Mesh mesh{MeshLayout{MeshPrimitive::Triangles}
+        .addBinding(0, sizeof(Vector3))
+        .addAttribute(0, 0, VertexFormat::Vector3, 0)
+    };
+    /* Deliberately not setting up any buffer -- the drawIndirect() should be
+       a no-op and thus no draw validation (and error messages) should
+       happen */
+
+    Containers::Optional<Containers::Array<char>> shaderData = Utility::Path::read(Utility::Path::join(VK_TEST_DIR, "MeshTestFiles/flat.spv"));
+    CORRADE_VERIFY(shaderData);
+
+    Shader shader{device(), ShaderCreateInfo{*shaderData}};
+
+    ShaderSet shaderSet;
+    shaderSet
+        .addShader(ShaderStage::Vertex, shader, "ver"_s)
+        .addShader(ShaderStage::Fragment, shader, "fra"_s);
+
+    Pipeline pipeline{device(), RasterizationPipelineCreateInfo{
+            shaderSet, mesh.layout(), _pipelineLayout, _renderPass, 0, 1}
+        .setViewport({{}, Vector2{_framebuffer.size().xy()}})
+    };
+
+    CommandBuffer cmd = _pool.allocate();
+    cmd.begin()
+       .beginRenderPass(Vk::RenderPassBeginInfo{_renderPass, _framebuffer}
+           .clearColor(0, 0x1f1f1f_srgbf)
+        )
+       .bindPipeline(pipeline)
+       .drawIndirect(mesh, {}, 0, 0)
+       .endRenderPass()
+       .copyImageToBuffer({_color, Vk::ImageLayout::TransferSource, _pixels, {
+            Vk::BufferImageCopy2D{0, Vk::ImageAspect::Color, 0, {{}, _framebuffer.size().xy()}}
+        }})
+       .pipelineBarrier(Vk::PipelineStage::Transfer, Vk::PipelineStage::Host, {
+            {Vk::Access::TransferWrite, Vk::Access::HostRead, _pixels}
+        })
+       .end();
+
+    queue().submit({SubmitInfo{}.setCommandBuffers({cmd})}).wait();
+
+    if(!(_manager.loadState("AnyImageImporter") & PluginManager::LoadState::Loaded) ||
+       !(_manager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("AnyImageImporter / TgaImporter plugins not found.");
+
+    CORRADE_COMPARE_WITH((ImageView2D{Magnum::PixelFormat::RGBA8Unorm,
+        _framebuffer.size().xy(),
+        _pixels.dedicatedMemory().mapRead()}),
+        Utility::Path::join(VK_TEST_DIR, "MeshTestFiles/noop.tga"),
+        DebugTools::CompareImageToFile{_manager});
+}
+
+void MeshVkTest::cmdDrawIndirectCount() {
+    if(!_deviceDrawIndirectCount.isExtensionEnabled<Extensions::KHR::draw_indirect_count>())
+        CORRADE_SKIP("VK_KHR_draw_indirect_count not supported, can't test.");
+
+    Mesh mesh{MeshLayout{MeshPrimitive::TriangleStrip}
+        .addBinding(0, sizeof(Vector3))
+        .addAttribute(0, 0, VertexFormat::Vector3, 0)
+    };
+    {
+        Buffer buffer{_deviceDrawIndirectCount, BufferCreateInfo{
+            BufferUsage::VertexBuffer,
+            sizeof(Vector3)*4
+        }, MemoryFlag::HostVisible};
+        /** @todo ffs fucking casts!!! */
+        Utility::copy(
+            Containers::stridedArrayView(QuadData).slice(&Quad::position),
+            Containers::arrayCast<Vector3>(Containers::arrayView(buffer.dedicatedMemory().map())));
+        /* The count isn't used by indirect draws, so not setting it. The
+           indirect draw shouldn't assert on that either. */
+        mesh.addVertexBuffer(0, std::move(buffer), 0);
+    }
+
+    /* Two draws of which only the first one is executed. The second one would
+       draw nothing anyway, but if it'd be executed the validation layers
+       would complain about the first instance being out of range. */
+    Buffer indirect{_deviceDrawIndirectCount, BufferCreateInfo{
+        BufferUsage::IndirectBuffer, 2*sizeof(VkDrawIndirectCommand) + 4
+    }, MemoryFlag::HostVisible};
+    {
+        const VkDrawIndirectCommand commands[]{
+            {4, 1, 0, 0},
+            {0, 1, 0, 1}
+        };
+        const UnsignedInt count = 1;
+        Containers::Array<char, MemoryMapDeleter> data = indirect.dedicatedMemory().map();
+        std::memcpy(data, commands, sizeof(commands));
+        std::memcpy(data + sizeof(commands), &count, sizeof(count));
+    }
+
+    Containers::Optional<Containers::Array<char>> shaderData = Utility::Path::read(Utility::Path::join(VK_TEST_DIR, "MeshTestFiles/flat.spv"));
+    CORRADE_VERIFY(shaderData);
+
+    Shader shader{_deviceDrawIndirectCount, ShaderCreateInfo{*shaderData}};
+
+    ShaderSet shaderSet;
+    shaderSet
+        .addShader(ShaderStage::Vertex, shader, "ver"_s)
+        .addShader(ShaderStage::Fragment, shader, "fra"_s);
+
+    Pipeline pipeline{_deviceDrawIndirectCount, RasterizationPipelineCreateInfo{
+            shaderSet, mesh.layout(), _pipelineLayout, _renderPass, 0, 1}
+        .setViewport({{}, Vector2{_framebuffer.size().xy()}})
+    };
+
+    CommandBuffer cmd = _pool.allocate();
+    cmd.begin()
+       .beginRenderPass(Vk::RenderPassBeginInfo{_renderPass, _framebuffer}
+           .clearColor(0, 0x1f1f1f_srgbf)
+        )
+       .bindPipeline(pipeline)
+       .drawIndirectCount(mesh, indirect, 0, indirect, 2*sizeof(VkDrawIndirectCommand), 2)
+       .endRenderPass()
+       .copyImageToBuffer({_color, Vk::ImageLayout::TransferSource, _pixels, {
+            Vk::BufferImageCopy2D{0, Vk::ImageAspect::Color, 0, {{}, _framebuffer.size().xy()}}
+        }})
+       .pipelineBarrier(Vk::PipelineStage::Transfer, Vk::PipelineStage::Host, {
+            {Vk::Access::TransferWrite, Vk::Access::HostRead, _pixels}
+        })
+       .end();
+
+    _queue.submit({SubmitInfo{}.setCommandBuffers({cmd})}).wait();
+
+    if(!(_manager.loadState("AnyImageImporter") & PluginManager::LoadState::Loaded) ||
+       !(_manager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("AnyImageImporter / TgaImporter plugins not found.");
+
+    CORRADE_COMPARE_WITH((ImageView2D{Magnum::PixelFormat::RGBA8Unorm,
+        _framebuffer.size().xy(),
+        _pixels.dedicatedMemory().mapRead()}),
+        Utility::Path::join(VK_TEST_DIR, "MeshTestFiles/flat.tga"),
+        DebugTools::CompareImageToFile{_manager});
+}
+
+void MeshVkTest::cmdDrawIndirectCountNotSupported() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    if(device().isVersionSupported(Version::Vk12) || device().isExtensionEnabled<Extensions::KHR::draw_indirect_count>())
+        CORRADE_SKIP("VK_KHR_draw_indirect_count or Vulkan 1.2 supported, can't test.");
+
+    Mesh mesh{MeshLayout{MeshPrimitive::Triangles}};
+
+    Containers::Optional<Containers::Array<char>> shaderData = Utility::Path::read(Utility::Path::join(VK_TEST_DIR, "MeshTestFiles/noop.spv"));
+    CORRADE_VERIFY(shaderData);
+
+    Shader shader{device(), ShaderCreateInfo{*shaderData}};
+
+    ShaderSet shaderSet;
+    shaderSet
+        .addShader(ShaderStage::Vertex, shader, "ver"_s)
+        .addShader(ShaderStage::Fragment, shader, "fra"_s);
+
+    Pipeline pipeline{device(), RasterizationPipelineCreateInfo{
+            shaderSet, mesh.layout(), _pipelineLayout, _renderPass, 0, 1}
+        .setViewport({{}, Vector2{_framebuffer.size().xy()}})
+    };
+
+    CommandBuffer cmd = _pool.allocate();
+    cmd.begin()
+       .beginRenderPass(Vk::RenderPassBeginInfo{_renderPass, _framebuffer}
+           .clearColor(0, 0x1f1f1f_srgbf)
+        )
+       .bindPipeline(pipeline);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    cmd.drawIndirectCount(mesh, {}, 0, {}, 0, 1);
+    CORRADE_COMPARE(out.str(), "Vk::CommandBuffer::drawIndirectCount(): requires Vulkan 1.2 or KHR_draw_indirect_count\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Vk::Test::MeshVkTest)
@@ -0,0 +1,78 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Vk/ParallelCommandRecorder.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct ParallelCommandRecorderTest: TestSuite::Tester {
+    explicit ParallelCommandRecorderTest();
+
+    void constructNoCreate();
+    void constructCopy();
+
+    void recordSecondaryNullCallback();
+};
+
+ParallelCommandRecorderTest::ParallelCommandRecorderTest() {
+    addTests({&ParallelCommandRecorderTest::constructNoCreate,
+              &ParallelCommandRecorderTest::constructCopy,
+
+              &ParallelCommandRecorderTest::recordSecondaryNullCallback});
+}
+
+void ParallelCommandRecorderTest::constructNoCreate() {
+    {
+        ParallelCommandRecorder recorder{NoCreate};
+        CORRADE_COMPARE(recorder.threadCount(), 0);
+    }
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoCreateT, ParallelCommandRecorder>::value);
+}
+
+void ParallelCommandRecorderTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<ParallelCommandRecorder>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<ParallelCommandRecorder>{});
+}
+
+void ParallelCommandRecorderTest::recordSecondaryNullCallback() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    ParallelCommandRecorder recorder{NoCreate};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    recorder.recordSecondary(CommandBufferInheritanceInfo{}, 3, nullptr);
+    CORRADE_COMPARE(out.str(), "Vk::ParallelCommandRecorder::recordSecondary(): callback can't be null\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::ParallelCommandRecorderTest)
@@ -0,0 +1,245 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <atomic>
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Vk/CommandPoolCreateInfo.h"
+#include "Magnum/Vk/DeviceProperties.h"
+#include "Magnum/Vk/Fence.h"
+#include "Magnum/Vk/FramebufferCreateInfo.h"
+#include "Magnum/Vk/Handle.h"
+#include "Magnum/Vk/ImageCreateInfo.h"
+#include "Magnum/Vk/ImageViewCreateInfo.h"
+#include "Magnum/Vk/ParallelCommandRecorder.h"
+#include "Magnum/Vk/PixelFormat.h"
+#include "Magnum/Vk/Queue.h"
+#include "Magnum/Vk/RenderPassCreateInfo.h"
+#include "Magnum/Vk/VulkanTester.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct ParallelCommandRecorderVkTest: VulkanTester {
+    explicit ParallelCommandRecorderVkTest();
+
+    void construct();
+    void constructDefaultThreadCount();
+    void constructMove();
+
+    void poolOutOfRange();
+    void reset();
+
+    void recordSecondary();
+    void recordSecondaryEmpty();
+    void recordSecondaryRenderPass();
+};
+
+ParallelCommandRecorderVkTest::ParallelCommandRecorderVkTest() {
+    addTests({&ParallelCommandRecorderVkTest::construct,
+              &ParallelCommandRecorderVkTest::constructDefaultThreadCount,
+              &ParallelCommandRecorderVkTest::constructMove,
+
+              &ParallelCommandRecorderVkTest::poolOutOfRange,
+              &ParallelCommandRecorderVkTest::reset,
+
+              &ParallelCommandRecorderVkTest::recordSecondary,
+              &ParallelCommandRecorderVkTest::recordSecondaryEmpty,
+              &ParallelCommandRecorderVkTest::recordSecondaryRenderPass});
+}
+
+void ParallelCommandRecorderVkTest::construct() {
+    {
+        ParallelCommandRecorder recorder{device(), CommandPoolCreateInfo{
+            device().properties().pickQueueFamily(QueueFlag::Graphics)}, 3};
+        #if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+        CORRADE_COMPARE(recorder.threadCount(), 3);
+        #else
+        CORRADE_COMPARE(recorder.threadCount(), 1);
+        #endif
+        for(UnsignedInt i = 0; i != recorder.threadCount(); ++i) {
+            CORRADE_ITERATION(i);
+            CORRADE_VERIFY(recorder.pool(i).handle());
+            CORRADE_COMPARE(recorder.pool(i).handleFlags(), HandleFlag::DestroyOnDestruction);
+        }
+
+        /* All pools should be distinct */
+        if(recorder.threadCount() > 1)
+            CORRADE_VERIFY(recorder.pool(0).handle() != recorder.pool(1).handle());
+    }
+
+    /* Shouldn't crash or anything */
+    CORRADE_VERIFY(true);
+}
+
+void ParallelCommandRecorderVkTest::constructDefaultThreadCount() {
+    ParallelCommandRecorder recorder{device(), CommandPoolCreateInfo{
+        device().properties().pickQueueFamily(QueueFlag::Graphics)}};
+    CORRADE_COMPARE_AS(recorder.threadCount(), 1,
+        TestSuite::Compare::GreaterOrEqual);
+}
+
+void ParallelCommandRecorderVkTest::constructMove() {
+    ParallelCommandRecorder a{device(), CommandPoolCreateInfo{
+        device().properties().pickQueueFamily(QueueFlag::Graphics)}, 2};
+    const UnsignedInt threadCount = a.threadCount();
+    VkCommandPool handle = a.pool(0).handle();
+
+    ParallelCommandRecorder b = std::move(a);
+    CORRADE_COMPARE(a.threadCount(), 0);
+    CORRADE_COMPARE(b.threadCount(), threadCount);
+    CORRADE_COMPARE(b.pool(0).handle(), handle);
+
+    ParallelCommandRecorder c{NoCreate};
+    c = std::move(b);
+    CORRADE_COMPARE(b.threadCount(), 0);
+    CORRADE_COMPARE(c.threadCount(), threadCount);
+    CORRADE_COMPARE(c.pool(0).handle(), handle);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<ParallelCommandRecorder>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<ParallelCommandRecorder>::value);
+}
+
+void ParallelCommandRecorderVkTest::poolOutOfRange() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    ParallelCommandRecorder recorder{device(), CommandPoolCreateInfo{
+        device().properties().pickQueueFamily(QueueFlag::Graphics)}, 1};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    recorder.pool(1);
+    CORRADE_COMPARE(out.str(), "Vk::ParallelCommandRecorder::pool(): index 1 out of range for 1 threads\n");
+}
+
+void ParallelCommandRecorderVkTest::reset() {
+    ParallelCommandRecorder recorder{device(), CommandPoolCreateInfo{
+        device().properties().pickQueueFamily(QueueFlag::Graphics)}, 2};
+
+    recorder.reset(CommandPoolResetFlag::ReleaseResources);
+
+    /* Does not do anything visible, so just test that it didn't blow up */
+    CORRADE_VERIFY(true);
+}
+
+void ParallelCommandRecorderVkTest::recordSecondary() {
+    ParallelCommandRecorder recorder{device(), CommandPoolCreateInfo{
+        device().properties().pickQueueFamily(QueueFlag::Graphics)}, 4};
+
+    struct State {
+        std::atomic<std::size_t> called;
+        std::atomic<std::size_t> indexSum;
+    } state{{0}, {0}};
+    Containers::Array<CommandBuffer> buffers = recorder.recordSecondary(CommandBufferInheritanceInfo{}, 10, [](CommandBuffer& cmd, std::size_t i, State& state) {
+        CORRADE_INTERNAL_ASSERT(cmd.handle());
+        ++state.called;
+        state.indexSum += i;
+    }, state);
+    CORRADE_COMPARE(buffers.size(), 10);
+    CORRADE_COMPARE(state.called, 10);
+    CORRADE_COMPARE(state.indexSum, 0 + 1 + 2 + 3 + 4 + 5 + 6 + 7 + 8 + 9);
+    for(CommandBuffer& buffer: buffers) {
+        CORRADE_ITERATION(&buffer - buffers.data());
+        CORRADE_VERIFY(buffer.handle());
+        CORRADE_COMPARE(buffer.handleFlags(), HandleFlag::DestroyOnDestruction);
+    }
+
+    /* Execute them outside of a render pass and submit */
+    CommandPool pool{device(), CommandPoolCreateInfo{
+        device().properties().pickQueueFamily(QueueFlag::Graphics)}};
+    CommandBuffer cmd = pool.allocate();
+    cmd.begin()
+       .executeCommands(buffers)
+       .end();
+    queue().submit({SubmitInfo{}.setCommandBuffers({cmd})}).wait();
+
+    /* Err there's not really anything else visible to verify */
+    CORRADE_VERIFY(true);
+}
+
+void ParallelCommandRecorderVkTest::recordSecondaryEmpty() {
+    ParallelCommandRecorder recorder{device(), CommandPoolCreateInfo{
+        device().properties().pickQueueFamily(QueueFlag::Graphics)}, 4};
+
+    Containers::Array<CommandBuffer> buffers = recorder.recordSecondary(CommandBufferInheritanceInfo{}, 0, [](CommandBuffer&, std::size_t, void*) {
+        CORRADE_INTERNAL_ASSERT_UNREACHABLE();
+    });
+    CORRADE_COMPARE(buffers.size(), 0);
+}
+
+void ParallelCommandRecorderVkTest::recordSecondaryRenderPass() {
+    using namespace Math::Literals;
+
+    Image color{device(), ImageCreateInfo2D{ImageUsage::ColorAttachment,
+        PixelFormat::RGBA8Unorm, {256, 256}, 1}, MemoryFlag::DeviceLocal};
+    ImageView colorView{device(), ImageViewCreateInfo2D{color}};
+
+    RenderPass renderPass{device(), RenderPassCreateInfo{}
+        .setAttachments({
+            AttachmentDescription{color.format(),
+                AttachmentLoadOperation::Clear,
+                AttachmentStoreOperation::Store,
+                ImageLayout::Undefined,
+                ImageLayout::ColorAttachment}
+        })
+        .addSubpass(SubpassDescription{}.setColorAttachments({
+            AttachmentReference{0, ImageLayout::ColorAttachment}
+        }))
+    };
+
+    Framebuffer framebuffer{device(), FramebufferCreateInfo{renderPass, {
+        colorView
+    }, {256, 256}}};
+
+    ParallelCommandRecorder recorder{device(), CommandPoolCreateInfo{
+        device().properties().pickQueueFamily(QueueFlag::Graphics)}, 2};
+    Containers::Array<CommandBuffer> buffers = recorder.recordSecondary(CommandBufferInheritanceInfo{renderPass, 0, framebuffer}, 3, [](CommandBuffer&, std::size_t, void*) {
+        /* Nothing to draw here, the recording itself is what's tested */
+    }, nullptr, CommandBufferBeginInfo::Flag::OneTimeSubmit);
+    CORRADE_COMPARE(buffers.size(), 3);
+
+    CommandPool pool{device(), CommandPoolCreateInfo{
+        device().properties().pickQueueFamily(QueueFlag::Graphics)}};
+    CommandBuffer cmd = pool.allocate();
+    cmd.begin()
+       .beginRenderPass(RenderPassBeginInfo{renderPass, framebuffer}
+           .clearColor(0, 0x1f1f1f_rgbf),
+           SubpassBeginInfo{SubpassContents::SecondaryCommandBuffers})
+       .executeCommands(buffers)
+       .endRenderPass()
+       .end();
+    queue().submit({SubmitInfo{}.setCommandBuffers({cmd})}).wait();
+
+    /* Err there's not really anything visible to verify */
+    CORRADE_VERIFY(cmd.handle());
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::ParallelCommandRecorderVkTest)
@@ -0,0 +1,107 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <new>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Vk/PipelineCacheCreateInfo.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct PipelineCacheTest: TestSuite::Tester {
+    explicit PipelineCacheTest();
+
+    void createInfoConstruct();
+    void createInfoConstructData();
+    void createInfoConstructNoInit();
+    void createInfoConstructFromVk();
+
+    void constructNoCreate();
+    void constructCopy();
+};
+
+PipelineCacheTest::PipelineCacheTest() {
+    addTests({&PipelineCacheTest::createInfoConstruct,
+              &PipelineCacheTest::createInfoConstructData,
+              &PipelineCacheTest::createInfoConstructNoInit,
+              &PipelineCacheTest::createInfoConstructFromVk,
+
+              &PipelineCacheTest::constructNoCreate,
+              &PipelineCacheTest::constructCopy});
+}
+
+void PipelineCacheTest::createInfoConstruct() {
+    PipelineCacheCreateInfo info;
+    CORRADE_COMPARE(info->sType, VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO);
+    CORRADE_COMPARE(info->flags, 0);
+    CORRADE_VERIFY(!info->pInitialData);
+    CORRADE_COMPARE(info->initialDataSize, 0);
+}
+
+void PipelineCacheTest::createInfoConstructData() {
+    const char data[37]{};
+    PipelineCacheCreateInfo info{data};
+    CORRADE_COMPARE(info->pInitialData, static_cast<const void*>(data));
+    CORRADE_COMPARE(info->initialDataSize, 37);
+}
+
+void PipelineCacheTest::createInfoConstructNoInit() {
+    PipelineCacheCreateInfo info{NoInit};
+    info->sType = VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2;
+    new(&info) PipelineCacheCreateInfo{NoInit};
+    CORRADE_COMPARE(info->sType, VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2);
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<PipelineCacheCreateInfo, NoInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoInitT, PipelineCacheCreateInfo>::value);
+}
+
+void PipelineCacheTest::createInfoConstructFromVk() {
+    VkPipelineCacheCreateInfo vkInfo;
+    vkInfo.sType = VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2;
+
+    PipelineCacheCreateInfo info{vkInfo};
+    CORRADE_COMPARE(info->sType, VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2);
+}
+
+void PipelineCacheTest::constructNoCreate() {
+    {
+        PipelineCache cache{NoCreate};
+        CORRADE_VERIFY(!cache.handle());
+    }
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoCreateT, PipelineCache>::value);
+}
+
+void PipelineCacheTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<PipelineCache>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<PipelineCache>{});
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::PipelineCacheTest)
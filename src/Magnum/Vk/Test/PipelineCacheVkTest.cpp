@@ -0,0 +1,297 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Reference.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Path.h>
+
+#include "Magnum/Vk/ComputePipelineCreateInfo.h"
+#include "Magnum/Vk/DeviceProperties.h"
+#include "Magnum/Vk/Pipeline.h"
+#include "Magnum/Vk/PipelineCacheCreateInfo.h"
+#include "Magnum/Vk/PipelineLayoutCreateInfo.h"
+#include "Magnum/Vk/Result.h"
+#include "Magnum/Vk/ShaderCreateInfo.h"
+#include "Magnum/Vk/ShaderSet.h"
+#include "Magnum/Vk/VulkanTester.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct PipelineCacheVkTest: VulkanTester {
+    explicit PipelineCacheVkTest();
+
+    void construct();
+    void constructInitialData();
+    void constructIncompatibleData();
+    void constructMove();
+
+    void wrap();
+
+    void isCompatible();
+
+    void saveLoad();
+    void loadNonexistent();
+
+    void merge();
+    void mergeSelf();
+
+    void pipeline();
+    void createPipelines();
+};
+
+using namespace Containers::Literals;
+
+PipelineCacheVkTest::PipelineCacheVkTest() {
+    addTests({&PipelineCacheVkTest::construct,
+              &PipelineCacheVkTest::constructInitialData,
+              &PipelineCacheVkTest::constructIncompatibleData,
+              &PipelineCacheVkTest::constructMove,
+
+              &PipelineCacheVkTest::wrap,
+
+              &PipelineCacheVkTest::isCompatible,
+
+              &PipelineCacheVkTest::saveLoad,
+              &PipelineCacheVkTest::loadNonexistent,
+
+              &PipelineCacheVkTest::merge,
+              &PipelineCacheVkTest::mergeSelf,
+
+              &PipelineCacheVkTest::pipeline,
+              &PipelineCacheVkTest::createPipelines});
+}
+
+void PipelineCacheVkTest::construct() {
+    {
+        PipelineCache cache{device()};
+        CORRADE_VERIFY(cache.handle());
+        CORRADE_COMPARE(cache.handleFlags(), HandleFlag::DestroyOnDestruction);
+
+        /* Even an empty cache has the header */
+        Containers::Array<char> data = cache.data();
+        CORRADE_COMPARE_AS(data.size(), sizeof(VkPipelineCacheHeaderVersionOne),
+            TestSuite::Compare::GreaterOrEqual);
+        CORRADE_VERIFY(PipelineCache::isCompatible(device().properties(), data));
+    }
+
+    /* Shouldn't crash or anything */
+    CORRADE_VERIFY(true);
+}
+
+void PipelineCacheVkTest::constructInitialData() {
+    Containers::Array<char> data = PipelineCache{device()}.data();
+
+    PipelineCache cache{device(), PipelineCacheCreateInfo{data}};
+    CORRADE_VERIFY(cache.handle());
+    CORRADE_VERIFY(PipelineCache::isCompatible(device().properties(), cache.data()));
+}
+
+void PipelineCacheVkTest::constructIncompatibleData() {
+    Containers::Array<char> data = PipelineCache{device()}.data();
+    /* Make the UUID not match */
+    data[offsetof(VkPipelineCacheHeaderVersionOne, pipelineCacheUUID)] ^= 0xff;
+    CORRADE_VERIFY(!PipelineCache::isCompatible(device().properties(), data));
+
+    /* The data should get ignored instead of passing them to the driver */
+    PipelineCache cache{device(), PipelineCacheCreateInfo{data}};
+    CORRADE_VERIFY(cache.handle());
+    CORRADE_VERIFY(PipelineCache::isCompatible(device().properties(), cache.data()));
+}
+
+void PipelineCacheVkTest::constructMove() {
+    PipelineCache a{device()};
+    VkPipelineCache handle = a.handle();
+
+    PipelineCache b = std::move(a);
+    CORRADE_VERIFY(!a.handle());
+    CORRADE_COMPARE(b.handle(), handle);
+    CORRADE_COMPARE(b.handleFlags(), HandleFlag::DestroyOnDestruction);
+
+    PipelineCache c{NoCreate};
+    c = std::move(b);
+    CORRADE_VERIFY(!b.handle());
+    CORRADE_COMPARE(b.handleFlags(), HandleFlags{});
+    CORRADE_COMPARE(c.handle(), handle);
+    CORRADE_COMPARE(c.handleFlags(), HandleFlag::DestroyOnDestruction);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<PipelineCache>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<PipelineCache>::value);
+}
+
+void PipelineCacheVkTest::wrap() {
+    VkPipelineCache cache{};
+    CORRADE_COMPARE(Result(device()->CreatePipelineCache(device(),
+        PipelineCacheCreateInfo{},
+        nullptr, &cache)), Result::Success);
+
+    auto wrapped = PipelineCache::wrap(device(), cache, HandleFlag::DestroyOnDestruction);
+    CORRADE_COMPARE(wrapped.handle(), cache);
+
+    /* Release the handle again, destroy by hand */
+    CORRADE_COMPARE(wrapped.release(), cache);
+    CORRADE_VERIFY(!wrapped.handle());
+    device()->DestroyPipelineCache(device(), cache, nullptr);
+}
+
+void PipelineCacheVkTest::isCompatible() {
+    Containers::Array<char> data = PipelineCache{device()}.data();
+    CORRADE_VERIFY(PipelineCache::isCompatible(device().properties(), data));
+
+    /* Too short */
+    CORRADE_VERIFY(!PipelineCache::isCompatible(device().properties(), {}));
+    CORRADE_VERIFY(!PipelineCache::isCompatible(device().properties(), data.prefix(sizeof(VkPipelineCacheHeaderVersionOne) - 1)));
+
+    /* Different device */
+    {
+        Containers::Array<char> copy{NoInit, data.size()};
+        Utility::copy(data, copy);
+        VkPipelineCacheHeaderVersionOne header;
+        std::memcpy(&header, copy.data(), sizeof(header));
+        ++header.deviceID;
+        std::memcpy(copy.data(), &header, sizeof(header));
+        CORRADE_VERIFY(!PipelineCache::isCompatible(device().properties(), copy));
+    }
+
+    /* Unknown header version */
+    {
+        Containers::Array<char> copy{NoInit, data.size()};
+        Utility::copy(data, copy);
+        VkPipelineCacheHeaderVersionOne header;
+        std::memcpy(&header, copy.data(), sizeof(header));
+        header.headerVersion = VkPipelineCacheHeaderVersion(0x7fffffff);
+        std::memcpy(copy.data(), &header, sizeof(header));
+        CORRADE_VERIFY(!PipelineCache::isCompatible(device().properties(), copy));
+    }
+}
+
+void PipelineCacheVkTest::saveLoad() {
+    const Containers::String filename = Utility::Path::join(VK_TEST_OUTPUT_DIR, "pipeline.cache");
+    if(Utility::Path::exists(filename))
+        CORRADE_VERIFY(Utility::Path::remove(filename));
+    CORRADE_VERIFY(Utility::Path::make(VK_TEST_OUTPUT_DIR));
+
+    {
+        PipelineCache cache{device()};
+        CORRADE_VERIFY(cache.save(filename));
+    }
+
+    CORRADE_VERIFY(Utility::Path::exists(filename));
+    /* The temporary file should be gone */
+    CORRADE_VERIFY(!Utility::Path::exists(filename + ".tmp"_s));
+
+    PipelineCache cache = PipelineCache::load(device(), filename);
+    CORRADE_VERIFY(cache.handle());
+    CORRADE_VERIFY(PipelineCache::isCompatible(device().properties(), cache.data()));
+}
+
+void PipelineCacheVkTest::loadNonexistent() {
+    PipelineCache cache = PipelineCache::load(device(), "nonexistent.cache");
+    CORRADE_VERIFY(cache.handle());
+    CORRADE_COMPARE(cache.handleFlags(), HandleFlag::DestroyOnDestruction);
+}
+
+void PipelineCacheVkTest::merge() {
+    PipelineCache a{device()};
+    PipelineCache b{device()};
+    PipelineCache c{device()};
+
+    PipelineCache& out = a.merge({b, c});
+    CORRADE_COMPARE(&out, &a);
+    CORRADE_VERIFY(PipelineCache::isCompatible(device().properties(), a.data()));
+}
+
+void PipelineCacheVkTest::mergeSelf() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    PipelineCache a{device()};
+    PipelineCache b{device()};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    a.merge({b, a});
+    CORRADE_COMPARE(out.str(), "Vk::PipelineCache::merge(): can't merge a cache into itself\n");
+}
+
+void PipelineCacheVkTest::pipeline() {
+    PipelineLayout pipelineLayout{device(), PipelineLayoutCreateInfo{}};
+
+    Containers::Optional<Containers::Array<char>> data = Utility::Path::read(Utility::Path::join(VK_TEST_DIR, "compute-noop.spv"));
+    CORRADE_VERIFY(data);
+    Shader shader{device(), ShaderCreateInfo{*data}};
+
+    ShaderSet shaderSet;
+    shaderSet.addShader(ShaderStage::Compute, shader, "main"_s);
+
+    PipelineCache cache{device()};
+    const std::size_t emptySize = cache.data().size();
+
+    Pipeline pipeline{device(), ComputePipelineCreateInfo{
+        shaderSet, pipelineLayout
+    }, cache};
+    CORRADE_VERIFY(pipeline.handle());
+    CORRADE_COMPARE(pipeline.bindPoint(), PipelineBindPoint::Compute);
+
+    /* The driver doesn't have to populate the cache, so can't check it got
+       larger */
+    CORRADE_COMPARE_AS(cache.data().size(), emptySize,
+        TestSuite::Compare::GreaterOrEqual);
+}
+
+void PipelineCacheVkTest::createPipelines() {
+    PipelineLayout pipelineLayout{device(), PipelineLayoutCreateInfo{}};
+
+    Containers::Optional<Containers::Array<char>> data = Utility::Path::read(Utility::Path::join(VK_TEST_DIR, "compute-noop.spv"));
+    CORRADE_VERIFY(data);
+    Shader shader{device(), ShaderCreateInfo{*data}};
+
+    ShaderSet shaderSet;
+    shaderSet.addShader(ShaderStage::Compute, shader, "main"_s);
+
+    ComputePipelineCreateInfo a{shaderSet, pipelineLayout};
+    ComputePipelineCreateInfo b{shaderSet, pipelineLayout};
+
+    PipelineCache cache{device()};
+    Containers::Array<Pipeline> pipelines = cache.createPipelines({a, b, a, b, a}, 3);
+    CORRADE_COMPARE(pipelines.size(), 5);
+    for(Pipeline& pipeline: pipelines) {
+        CORRADE_ITERATION(&pipeline - pipelines.data());
+        CORRADE_VERIFY(pipeline.handle());
+        CORRADE_COMPARE(pipeline.bindPoint(), PipelineBindPoint::Compute);
+        CORRADE_COMPARE(pipeline.handleFlags(), HandleFlag::DestroyOnDestruction);
+    }
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::PipelineCacheVkTest)
@@ -60,6 +60,8 @@ struct PipelineTest: TestSuite::Tester {
     void rasterizationCreateInfoViewportImplicitScissor();
     void rasterizationCreateInfoViewport2DImplicitScissor();
     void rasterizationCreateInfoDynamicState();
+    void rasterizationCreateInfoRenderingFormats();
+    void rasterizationCreateInfoRenderingFormatsWrongCount();
 
     void computeCreateInfoConstruct();
     void computeCreateInfoConstructOwnedEntrypoint();
@@ -83,6 +85,16 @@ struct PipelineTest: TestSuite::Tester {
     void imageMemoryBarrierConstructNoInit();
     void imageMemoryBarrierConstructFromVk();
 
+    void dependencyInfoConstruct();
+    void dependencyInfoConstructNoInit();
+    void dependencyInfoConstructFromVk();
+    void dependencyInfoConstructCopy();
+    void dependencyInfoConstructMove();
+    void dependencyInfoMemoryBarriers();
+    void dependencyInfoBufferMemoryBarriers();
+    void dependencyInfoImageMemoryBarriers();
+    void dependencyInfoImageMemoryBarrierImplicitAspect();
+
     void debugBindPoint();
     void debugDynamicRasterizationState();
     void debugDynamicRasterizationStates();
@@ -103,6 +115,8 @@ PipelineTest::PipelineTest() {
               &PipelineTest::rasterizationCreateInfoViewportImplicitScissor,
               &PipelineTest::rasterizationCreateInfoViewport2DImplicitScissor,
               &PipelineTest::rasterizationCreateInfoDynamicState,
+              &PipelineTest::rasterizationCreateInfoRenderingFormats,
+              &PipelineTest::rasterizationCreateInfoRenderingFormatsWrongCount,
 
               &PipelineTest::computeCreateInfoConstruct,
               &PipelineTest::computeCreateInfoConstructOwnedEntrypoint,
@@ -126,6 +140,16 @@ PipelineTest::PipelineTest() {
               &PipelineTest::imageMemoryBarrierConstructNoInit,
               &PipelineTest::imageMemoryBarrierConstructFromVk,
 
+              &PipelineTest::dependencyInfoConstruct,
+              &PipelineTest::dependencyInfoConstructNoInit,
+              &PipelineTest::dependencyInfoConstructFromVk,
+              &PipelineTest::dependencyInfoConstructCopy,
+              &PipelineTest::dependencyInfoConstructMove,
+              &PipelineTest::dependencyInfoMemoryBarriers,
+              &PipelineTest::dependencyInfoBufferMemoryBarriers,
+              &PipelineTest::dependencyInfoImageMemoryBarriers,
+              &PipelineTest::dependencyInfoImageMemoryBarrierImplicitAspect,
+
               &PipelineTest::debugBindPoint,
               &PipelineTest::debugDynamicRasterizationState,
               &PipelineTest::debugDynamicRasterizationStates});
@@ -538,6 +562,49 @@ void PipelineTest::rasterizationCreateInfoDynamicState() {
     CORRADE_COMPARE(info->pDynamicState->pDynamicStates[2], VK_DYNAMIC_STATE_DEPTH_BOUNDS_TEST_ENABLE_EXT);
 }
 
+void PipelineTest::rasterizationCreateInfoRenderingFormats() {
+    MeshLayout meshLayout{MeshPrimitive::Triangles};
+    RasterizationPipelineCreateInfo info{ShaderSet{}, meshLayout, VkPipelineLayout{}, VkRenderPass{}, 0, 2};
+    CORRADE_VERIFY(!info->pNext);
+
+    info.setRenderingFormats({PixelFormat::RGBA8Srgb, PixelFormat::RG16F}, PixelFormat::Depth24UnormStencil8UI, PixelFormat::Depth24UnormStencil8UI);
+    CORRADE_VERIFY(info->pNext);
+    const auto& rendering = *static_cast<const VkPipelineRenderingCreateInfoKHR*>(info->pNext);
+    CORRADE_COMPARE(rendering.sType, VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR);
+    CORRADE_VERIFY(!rendering.pNext);
+    CORRADE_COMPARE(rendering.colorAttachmentCount, 2);
+    CORRADE_VERIFY(rendering.pColorAttachmentFormats);
+    CORRADE_COMPARE(rendering.pColorAttachmentFormats[0], VK_FORMAT_R8G8B8A8_SRGB);
+    CORRADE_COMPARE(rendering.pColorAttachmentFormats[1], VK_FORMAT_R16G16_SFLOAT);
+    CORRADE_COMPARE(rendering.depthAttachmentFormat, VK_FORMAT_D24_UNORM_S8_UINT);
+    CORRADE_COMPARE(rendering.stencilAttachmentFormat, VK_FORMAT_D24_UNORM_S8_UINT);
+
+    /* Calling it again shouldn't connect the structure twice */
+    info.setRenderingFormats({PixelFormat::RGBA8Unorm, PixelFormat::RGBA8Unorm});
+    CORRADE_COMPARE(info->pNext, &rendering);
+    CORRADE_VERIFY(!rendering.pNext);
+    CORRADE_COMPARE(rendering.pColorAttachmentFormats[0], VK_FORMAT_R8G8B8A8_UNORM);
+    CORRADE_COMPARE(rendering.depthAttachmentFormat, VK_FORMAT_UNDEFINED);
+    CORRADE_COMPARE(rendering.stencilAttachmentFormat, VK_FORMAT_UNDEFINED);
+
+    /* The structure should survive a move */
+    RasterizationPipelineCreateInfo b = std::move(info);
+    CORRADE_COMPARE(b->pNext, &rendering);
+    CORRADE_VERIFY(!info->pNext);
+}
+
+void PipelineTest::rasterizationCreateInfoRenderingFormatsWrongCount() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    MeshLayout meshLayout{MeshPrimitive::Triangles};
+    RasterizationPipelineCreateInfo info{ShaderSet{}, meshLayout, VkPipelineLayout{}, VkRenderPass{}, 0, 2};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    info.setRenderingFormats({PixelFormat::RGBA8Srgb});
+    CORRADE_COMPARE(out.str(), "Vk::RasterizationPipelineCreateInfo::setRenderingFormats(): expected 2 color formats but got 1\n");
+}
+
 void PipelineTest::computeCreateInfoConstruct() {
     ShaderSet shaderSet;
     Containers::StringView name = "dead"_s;
@@ -727,6 +794,152 @@ void PipelineTest::imageMemoryBarrierConstructFromVk() {
     CORRADE_COMPARE(barrier->sType, VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2);
 }
 
+void PipelineTest::dependencyInfoConstruct() {
+    DependencyInfo info{DependencyFlag::ByRegion};
+    CORRADE_COMPARE(info->sType, VK_STRUCTURE_TYPE_DEPENDENCY_INFO_KHR);
+    CORRADE_COMPARE(info->dependencyFlags, VK_DEPENDENCY_BY_REGION_BIT);
+    CORRADE_COMPARE(info->memoryBarrierCount, 0);
+    CORRADE_VERIFY(!info->pMemoryBarriers);
+    CORRADE_COMPARE(info->bufferMemoryBarrierCount, 0);
+    CORRADE_VERIFY(!info->pBufferMemoryBarriers);
+    CORRADE_COMPARE(info->imageMemoryBarrierCount, 0);
+    CORRADE_VERIFY(!info->pImageMemoryBarriers);
+}
+
+void PipelineTest::dependencyInfoConstructNoInit() {
+    DependencyInfo info{NoInit};
+    info->sType = VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2;
+    new(&info) DependencyInfo{NoInit};
+    CORRADE_COMPARE(info->sType, VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2);
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<DependencyInfo, NoInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoInitT, DependencyInfo>::value);
+}
+
+void PipelineTest::dependencyInfoConstructFromVk() {
+    VkDependencyInfoKHR vkInfo;
+    vkInfo.sType = VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2;
+
+    DependencyInfo info{vkInfo};
+    CORRADE_COMPARE(info->sType, VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2);
+}
+
+void PipelineTest::dependencyInfoConstructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<DependencyInfo>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<DependencyInfo>{});
+}
+
+void PipelineTest::dependencyInfoConstructMove() {
+    DependencyInfo a;
+    a.addMemoryBarrier(PipelineStage::Transfer, Access::TransferWrite, PipelineStage::VertexInput, Access::VertexAttributeRead);
+    a.addBufferMemoryBarrier(PipelineStage::Transfer, Access::TransferWrite, PipelineStage::VertexInput, Access::VertexAttributeRead, {});
+    a.addImageMemoryBarrier(PipelineStage::Transfer, Access::TransferWrite, PipelineStage::FragmentShader, Access::ShaderRead, ImageLayout::TransferDestination, ImageLayout::ShaderReadOnly, {}, ImageAspect::Color);
+    const VkMemoryBarrier2KHR* memoryBarriers = a->pMemoryBarriers;
+
+    DependencyInfo b = std::move(a);
+    CORRADE_COMPARE(a->memoryBarrierCount, 0);
+    CORRADE_VERIFY(!a->pMemoryBarriers);
+    CORRADE_COMPARE(a->bufferMemoryBarrierCount, 0);
+    CORRADE_VERIFY(!a->pBufferMemoryBarriers);
+    CORRADE_COMPARE(a->imageMemoryBarrierCount, 0);
+    CORRADE_VERIFY(!a->pImageMemoryBarriers);
+    CORRADE_COMPARE(b->memoryBarrierCount, 1);
+    CORRADE_COMPARE(b->pMemoryBarriers, memoryBarriers);
+    CORRADE_COMPARE(b->bufferMemoryBarrierCount, 1);
+    CORRADE_COMPARE(b->imageMemoryBarrierCount, 1);
+
+    DependencyInfo c{VkDependencyInfoKHR{}};
+    c = std::move(b);
+    CORRADE_VERIFY(!b->pMemoryBarriers);
+    CORRADE_COMPARE(c->memoryBarrierCount, 1);
+    CORRADE_COMPARE(c->pMemoryBarriers, memoryBarriers);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<DependencyInfo>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<DependencyInfo>::value);
+}
+
+void PipelineTest::dependencyInfoMemoryBarriers() {
+    DependencyInfo info;
+    info.addMemoryBarrier(PipelineStage::Transfer, Access::TransferWrite, PipelineStage::VertexInput, Access::VertexAttributeRead)
+        .addMemoryBarrier({}, {}, PipelineStage::ComputeShader, Access::ShaderRead);
+    CORRADE_COMPARE(info->memoryBarrierCount, 2);
+    CORRADE_VERIFY(info->pMemoryBarriers);
+    CORRADE_COMPARE(info->pMemoryBarriers[0].sType, VK_STRUCTURE_TYPE_MEMORY_BARRIER_2_KHR);
+    CORRADE_COMPARE(info->pMemoryBarriers[0].srcStageMask, VK_PIPELINE_STAGE_TRANSFER_BIT);
+    CORRADE_COMPARE(info->pMemoryBarriers[0].srcAccessMask, VK_ACCESS_TRANSFER_WRITE_BIT);
+    CORRADE_COMPARE(info->pMemoryBarriers[0].dstStageMask, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT);
+    CORRADE_COMPARE(info->pMemoryBarriers[0].dstAccessMask, VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT);
+    CORRADE_COMPARE(info->pMemoryBarriers[1].srcStageMask, 0);
+    CORRADE_COMPARE(info->pMemoryBarriers[1].srcAccessMask, 0);
+    CORRADE_COMPARE(info->pMemoryBarriers[1].dstStageMask, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+    CORRADE_COMPARE(info->pMemoryBarriers[1].dstAccessMask, VK_ACCESS_SHADER_READ_BIT);
+}
+
+void PipelineTest::dependencyInfoBufferMemoryBarriers() {
+    DependencyInfo info;
+    /* The double reinterpret_cast is needed because the handle is an uint64_t
+       instead of a pointer on 32-bit builds and only this works on both */
+    info.addBufferMemoryBarrier(PipelineStage::Transfer, Access::TransferWrite, PipelineStage::VertexInput, Access::VertexAttributeRead, reinterpret_cast<VkBuffer>(reinterpret_cast<void*>(0xdead)), 3, 5);
+    CORRADE_COMPARE(info->bufferMemoryBarrierCount, 1);
+    CORRADE_VERIFY(info->pBufferMemoryBarriers);
+    const VkBufferMemoryBarrier2KHR& barrier = info->pBufferMemoryBarriers[0];
+    CORRADE_COMPARE(barrier.sType, VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2_KHR);
+    CORRADE_COMPARE(barrier.srcStageMask, VK_PIPELINE_STAGE_TRANSFER_BIT);
+    CORRADE_COMPARE(barrier.srcAccessMask, VK_ACCESS_TRANSFER_WRITE_BIT);
+    CORRADE_COMPARE(barrier.dstStageMask, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT);
+    CORRADE_COMPARE(barrier.dstAccessMask, VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT);
+    CORRADE_COMPARE(barrier.srcQueueFamilyIndex, VK_QUEUE_FAMILY_IGNORED);
+    CORRADE_COMPARE(barrier.dstQueueFamilyIndex, VK_QUEUE_FAMILY_IGNORED);
+    CORRADE_COMPARE(barrier.buffer, reinterpret_cast<VkBuffer>(reinterpret_cast<void*>(0xdead)));
+    CORRADE_COMPARE(barrier.offset, 3);
+    CORRADE_COMPARE(barrier.size, 5);
+}
+
+void PipelineTest::dependencyInfoImageMemoryBarriers() {
+    DependencyInfo info;
+    /* The double reinterpret_cast is needed because the handle is an uint64_t
+       instead of a pointer on 32-bit builds and only this works on both */
+    info.addImageMemoryBarrier(PipelineStage::ColorAttachmentOutput, Access::ColorAttachmentWrite, PipelineStage::FragmentShader, Access::ShaderRead, ImageLayout::ColorAttachment, ImageLayout::ShaderReadOnly, reinterpret_cast<VkImage>(reinterpret_cast<void*>(0xdead)), ImageAspect::Color, 3, 5, 7, 9);
+    CORRADE_COMPARE(info->imageMemoryBarrierCount, 1);
+    CORRADE_VERIFY(info->pImageMemoryBarriers);
+    const VkImageMemoryBarrier2KHR& barrier = info->pImageMemoryBarriers[0];
+    CORRADE_COMPARE(barrier.sType, VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2_KHR);
+    CORRADE_COMPARE(barrier.srcStageMask, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+    CORRADE_COMPARE(barrier.srcAccessMask, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT);
+    CORRADE_COMPARE(barrier.dstStageMask, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+    CORRADE_COMPARE(barrier.dstAccessMask, VK_ACCESS_SHADER_READ_BIT);
+    CORRADE_COMPARE(barrier.oldLayout, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+    CORRADE_COMPARE(barrier.newLayout, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    CORRADE_COMPARE(barrier.srcQueueFamilyIndex, VK_QUEUE_FAMILY_IGNORED);
+    CORRADE_COMPARE(barrier.dstQueueFamilyIndex, VK_QUEUE_FAMILY_IGNORED);
+    CORRADE_COMPARE(barrier.image, reinterpret_cast<VkImage>(reinterpret_cast<void*>(0xdead)));
+    CORRADE_COMPARE(barrier.subresourceRange.aspectMask, VK_IMAGE_ASPECT_COLOR_BIT);
+    CORRADE_COMPARE(barrier.subresourceRange.baseMipLevel, 7);
+    CORRADE_COMPARE(barrier.subresourceRange.levelCount, 9);
+    CORRADE_COMPARE(barrier.subresourceRange.baseArrayLayer, 3);
+    CORRADE_COMPARE(barrier.subresourceRange.layerCount, 5);
+}
+
+void PipelineTest::dependencyInfoImageMemoryBarrierImplicitAspect() {
+    /* The double reinterpret_cast is needed because the handle is an uint64_t
+       instead of a pointer on 32-bit builds and only this works on both */
+    Device device{NoCreate};
+    Image image = Image::wrap(device, reinterpret_cast<VkImage>(reinterpret_cast<void*>(0xdead)), PixelFormat::Depth24UnormStencil8UI);
+
+    DependencyInfo info;
+    info.addImageMemoryBarrier(PipelineStage::Transfer, Access::TransferWrite, PipelineStage::EarlyFragmentTests, Access::DepthStencilAttachmentRead, ImageLayout::TransferDestination, ImageLayout::DepthStencilAttachment, image);
+    CORRADE_COMPARE(info->imageMemoryBarrierCount, 1);
+    const VkImageMemoryBarrier2KHR& barrier = info->pImageMemoryBarriers[0];
+    CORRADE_COMPARE(barrier.image, reinterpret_cast<VkImage>(reinterpret_cast<void*>(0xdead)));
+    CORRADE_COMPARE(barrier.subresourceRange.aspectMask, VK_IMAGE_ASPECT_DEPTH_BIT|VK_IMAGE_ASPECT_STENCIL_BIT);
+    CORRADE_COMPARE(barrier.subresourceRange.baseMipLevel, 0);
+    CORRADE_COMPARE(barrier.subresourceRange.levelCount, VK_REMAINING_MIP_LEVELS);
+    CORRADE_COMPARE(barrier.subresourceRange.baseArrayLayer, 0);
+    CORRADE_COMPARE(barrier.subresourceRange.layerCount, VK_REMAINING_ARRAY_LAYERS);
+}
+
 void PipelineTest::debugBindPoint() {
     std::ostringstream out;
     Debug{&out} << PipelineBindPoint::Compute << PipelineBindPoint(-10007655);
@@ -0,0 +1,207 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Reference.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+
+#include "Magnum/Vk/CommandBuffer.h"
+#include "Magnum/Vk/CommandPoolCreateInfo.h"
+#include "Magnum/Vk/DeviceCreateInfo.h"
+#include "Magnum/Vk/DeviceFeatures.h"
+#include "Magnum/Vk/DeviceProperties.h"
+#include "Magnum/Vk/Fence.h"
+#include "Magnum/Vk/Pipeline.h"
+#include "Magnum/Vk/QueryPoolCreateInfo.h"
+#include "Magnum/Vk/Queue.h"
+#include "Magnum/Vk/Result.h"
+#include "Magnum/Vk/VulkanTester.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct QueryPoolVkTest: VulkanTester {
+    explicit QueryPoolVkTest();
+
+    void construct();
+    void constructPipelineStatistics();
+    void constructMove();
+
+    void wrap();
+
+    void resultsNotReady();
+    void timestamp();
+    void occlusion();
+};
+
+QueryPoolVkTest::QueryPoolVkTest(): VulkanTester{NoCreate} {
+    addTests({&QueryPoolVkTest::construct,
+              &QueryPoolVkTest::constructPipelineStatistics,
+              &QueryPoolVkTest::constructMove,
+
+              &QueryPoolVkTest::wrap,
+
+              &QueryPoolVkTest::resultsNotReady,
+              &QueryPoolVkTest::timestamp,
+              &QueryPoolVkTest::occlusion});
+
+    /* Enable pipeline statistics if supported, the tests that need them skip
+       otherwise */
+    DeviceProperties properties = pickDevice(instance());
+    const bool pipelineStatistics = !!(properties.features() & DeviceFeature::PipelineStatisticsQuery);
+    DeviceCreateInfo info{std::move(properties)};
+    info.addQueues(QueueFlag::Graphics, {0.0f}, {queue()});
+    if(pipelineStatistics)
+        info.setEnabledFeatures(DeviceFeature::PipelineStatisticsQuery);
+    device().create(instance(), std::move(info));
+}
+
+void QueryPoolVkTest::construct() {
+    {
+        QueryPool pool{device(), QueryPoolCreateInfo{QueryType::Timestamp, 4}};
+        CORRADE_VERIFY(pool.handle());
+        CORRADE_COMPARE(pool.handleFlags(), HandleFlag::DestroyOnDestruction);
+    }
+
+    /* Shouldn't crash or anything */
+    CORRADE_VERIFY(true);
+}
+
+void QueryPoolVkTest::constructPipelineStatistics() {
+    if(!(device().enabledFeatures() & DeviceFeature::PipelineStatisticsQuery))
+        CORRADE_SKIP("DeviceFeature::PipelineStatisticsQuery not supported, can't test.");
+
+    {
+        QueryPool pool{device(), QueryPoolCreateInfo{QueryType::PipelineStatistics, 4, QueryPipelineStatistic::VertexShaderInvocations|QueryPipelineStatistic::ClippingInvocations}};
+        CORRADE_VERIFY(pool.handle());
+        CORRADE_COMPARE(pool.handleFlags(), HandleFlag::DestroyOnDestruction);
+    }
+
+    /* Shouldn't crash or anything */
+    CORRADE_VERIFY(true);
+}
+
+void QueryPoolVkTest::constructMove() {
+    QueryPool a{device(), QueryPoolCreateInfo{QueryType::Timestamp, 4}};
+    VkQueryPool handle = a.handle();
+
+    QueryPool b = std::move(a);
+    CORRADE_VERIFY(!a.handle());
+    CORRADE_COMPARE(b.handle(), handle);
+    CORRADE_COMPARE(b.handleFlags(), HandleFlag::DestroyOnDestruction);
+
+    QueryPool c{NoCreate};
+    c = std::move(b);
+    CORRADE_VERIFY(!b.handle());
+    CORRADE_COMPARE(b.handleFlags(), HandleFlags{});
+    CORRADE_COMPARE(c.handle(), handle);
+    CORRADE_COMPARE(c.handleFlags(), HandleFlag::DestroyOnDestruction);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<QueryPool>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<QueryPool>::value);
+}
+
+void QueryPoolVkTest::wrap() {
+    VkQueryPool pool{};
+    CORRADE_COMPARE(Result(device()->CreateQueryPool(device(),
+        QueryPoolCreateInfo{QueryType::Occlusion, 2},
+        nullptr, &pool)), Result::Success);
+
+    auto wrapped = QueryPool::wrap(device(), pool, HandleFlag::DestroyOnDestruction);
+    CORRADE_COMPARE(wrapped.handle(), pool);
+
+    /* Release the handle again, destroy by hand */
+    CORRADE_COMPARE(wrapped.release(), pool);
+    CORRADE_VERIFY(!wrapped.handle());
+    device()->DestroyQueryPool(device(), pool, nullptr);
+}
+
+void QueryPoolVkTest::resultsNotReady() {
+    CommandPool commandPool{device(), CommandPoolCreateInfo{
+        device().properties().pickQueueFamily(QueueFlag::Graphics)}};
+    CommandBuffer cmd = commandPool.allocate();
+
+    QueryPool pool{device(), QueryPoolCreateInfo{QueryType::Timestamp, 2}};
+
+    /* Reset the queries but don't write anything to them, they should stay
+       unavailable */
+    cmd.begin()
+       .resetQueryPool(pool, 0, 2)
+       .end();
+    queue().submit({SubmitInfo{}.setCommandBuffers({cmd})}).wait();
+
+    UnsignedLong data[4]{};
+    CORRADE_VERIFY(!pool.results(0, 2, data));
+
+    /* With availability the call succeeds and reports both as unavailable */
+    CORRADE_VERIFY(pool.results(0, 2, data, QueryResultFlag::WithAvailability));
+    CORRADE_COMPARE(data[1], 0);
+    CORRADE_COMPARE(data[3], 0);
+}
+
+void QueryPoolVkTest::timestamp() {
+    if(!device().properties().properties().properties.limits.timestampComputeAndGraphics)
+        CORRADE_SKIP("Timestamps not supported on graphics queues, can't test.");
+
+    CommandPool commandPool{device(), CommandPoolCreateInfo{
+        device().properties().pickQueueFamily(QueueFlag::Graphics)}};
+    CommandBuffer cmd = commandPool.allocate();
+
+    QueryPool pool{device(), QueryPoolCreateInfo{QueryType::Timestamp, 2}};
+
+    cmd.begin()
+       .resetQueryPool(pool, 0, 2)
+       .writeTimestamp(PipelineStage::TopOfPipe, pool, 0)
+       .writeTimestamp(PipelineStage::BottomOfPipe, pool, 1)
+       .end();
+    queue().submit({SubmitInfo{}.setCommandBuffers({cmd})}).wait();
+
+    UnsignedLong data[2]{};
+    CORRADE_VERIFY(pool.results(0, 2, data, QueryResultFlag::Wait));
+    CORRADE_COMPARE_AS(data[1], data[0],
+        TestSuite::Compare::GreaterOrEqual);
+}
+
+void QueryPoolVkTest::occlusion() {
+    CommandPool commandPool{device(), CommandPoolCreateInfo{
+        device().properties().pickQueueFamily(QueueFlag::Graphics)}};
+    CommandBuffer cmd = commandPool.allocate();
+
+    QueryPool pool{device(), QueryPoolCreateInfo{QueryType::Occlusion, 1}};
+
+    /* Nothing is drawn inside the query, so no samples should pass */
+    cmd.begin()
+       .resetQueryPool(pool, 0, 1)
+       .beginQuery(pool, 0)
+       .endQuery(pool, 0)
+       .end();
+    queue().submit({SubmitInfo{}.setCommandBuffers({cmd})}).wait();
+
+    UnsignedLong data[1]{0xdeadbeef};
+    CORRADE_VERIFY(pool.results(0, 1, data, QueryResultFlag::Wait));
+    CORRADE_COMPARE(data[0], 0);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::QueryPoolVkTest)
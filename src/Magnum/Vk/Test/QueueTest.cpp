@@ -24,9 +24,12 @@
 */
 
 #include <new>
+#include <sstream>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
 
 #include "Magnum/Vk/Device.h"
+#include "Magnum/Vk/Pipeline.h"
 #include "Magnum/Vk/Queue.h"
 
 namespace Magnum { namespace Vk { namespace Test { namespace {
@@ -43,6 +46,12 @@ struct QueueTest: TestSuite::Tester {
     void submitInfoConstruct();
     void submitInfoConstructNoInit();
     void submitInfoConstructCommandBuffers();
+    void submitInfoConstructWaitSemaphores();
+    void submitInfoConstructWaitSemaphoresTimeline();
+    void submitInfoConstructWaitSemaphoresWrongSize();
+    void submitInfoConstructSignalSemaphores();
+    void submitInfoConstructSignalSemaphoresTimeline();
+    void submitInfoConstructSignalSemaphoresWrongSize();
     void submitInfoConstructFromVk();
     void submitInfoConstructCopy();
     void submitInfoConstructMove();
@@ -58,6 +67,12 @@ QueueTest::QueueTest() {
               &QueueTest::submitInfoConstruct,
               &QueueTest::submitInfoConstructNoInit,
               &QueueTest::submitInfoConstructCommandBuffers,
+              &QueueTest::submitInfoConstructWaitSemaphores,
+              &QueueTest::submitInfoConstructWaitSemaphoresTimeline,
+              &QueueTest::submitInfoConstructWaitSemaphoresWrongSize,
+              &QueueTest::submitInfoConstructSignalSemaphores,
+              &QueueTest::submitInfoConstructSignalSemaphoresTimeline,
+              &QueueTest::submitInfoConstructSignalSemaphoresWrongSize,
               &QueueTest::submitInfoConstructFromVk,
               &QueueTest::submitInfoConstructCopy,
               &QueueTest::submitInfoConstructMove});
@@ -141,6 +156,106 @@ void QueueTest::submitInfoConstructCommandBuffers() {
     CORRADE_COMPARE(info->pCommandBuffers[1], reinterpret_cast<VkCommandBuffer>(reinterpret_cast<void*>(0xcafecafe)));
 }
 
+void QueueTest::submitInfoConstructWaitSemaphores() {
+    /* The double reinterpret_cast is needed because the handle is an uint64_t
+       instead of a pointer on 32-bit builds and only this works on both */
+    SubmitInfo info;
+    info.setWaitSemaphores({
+        reinterpret_cast<VkSemaphore>(reinterpret_cast<void*>(0xbadbeef)),
+        reinterpret_cast<VkSemaphore>(reinterpret_cast<void*>(0xcafecafe))
+    }, {PipelineStage::TopOfPipe, PipelineStage::Transfer});
+    CORRADE_VERIFY(!info->pNext);
+    CORRADE_COMPARE(info->waitSemaphoreCount, 2);
+    CORRADE_VERIFY(info->pWaitSemaphores);
+    CORRADE_VERIFY(info->pWaitDstStageMask);
+    CORRADE_COMPARE(info->pWaitSemaphores[1], reinterpret_cast<VkSemaphore>(reinterpret_cast<void*>(0xcafecafe)));
+    CORRADE_COMPARE(info->pWaitDstStageMask[0], VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT);
+    CORRADE_COMPARE(info->pWaitDstStageMask[1], VK_PIPELINE_STAGE_TRANSFER_BIT);
+}
+
+void QueueTest::submitInfoConstructWaitSemaphoresTimeline() {
+    SubmitInfo info;
+    info.setWaitSemaphores({
+        reinterpret_cast<VkSemaphore>(reinterpret_cast<void*>(0xbadbeef)),
+        reinterpret_cast<VkSemaphore>(reinterpret_cast<void*>(0xcafecafe))
+    }, {PipelineStage::TopOfPipe, PipelineStage::Transfer}, {0, 37});
+    CORRADE_COMPARE(info->waitSemaphoreCount, 2);
+    CORRADE_VERIFY(info->pNext);
+    const auto& timelineInfo = *static_cast<const VkTimelineSemaphoreSubmitInfo*>(info->pNext);
+    CORRADE_COMPARE(timelineInfo.sType, VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO);
+    CORRADE_COMPARE(timelineInfo.waitSemaphoreValueCount, 2);
+    CORRADE_VERIFY(timelineInfo.pWaitSemaphoreValues);
+    CORRADE_COMPARE(timelineInfo.pWaitSemaphoreValues[1], 37);
+    CORRADE_COMPARE(timelineInfo.signalSemaphoreValueCount, 0);
+
+    /* Setting binary semaphores again resets the values */
+    info.setWaitSemaphores({VkSemaphore{}}, {PipelineStage::TopOfPipe});
+    CORRADE_COMPARE(info->waitSemaphoreCount, 1);
+    CORRADE_COMPARE(timelineInfo.waitSemaphoreValueCount, 0);
+    CORRADE_VERIFY(!timelineInfo.pWaitSemaphoreValues);
+}
+
+void QueueTest::submitInfoConstructWaitSemaphoresWrongSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    SubmitInfo info;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    info.setWaitSemaphores({VkSemaphore{}, VkSemaphore{}}, {PipelineStage::TopOfPipe});
+    info.setWaitSemaphores({VkSemaphore{}, VkSemaphore{}}, {PipelineStage::TopOfPipe, PipelineStage::TopOfPipe}, {37});
+    CORRADE_COMPARE(out.str(),
+        "Vk::SubmitInfo::setWaitSemaphores(): expected 2 stages but got 1\n"
+        "Vk::SubmitInfo::setWaitSemaphores(): expected 2 values but got 1\n");
+}
+
+void QueueTest::submitInfoConstructSignalSemaphores() {
+    SubmitInfo info;
+    info.setSignalSemaphores({
+        reinterpret_cast<VkSemaphore>(reinterpret_cast<void*>(0xbadbeef)),
+        reinterpret_cast<VkSemaphore>(reinterpret_cast<void*>(0xcafecafe))
+    });
+    CORRADE_VERIFY(!info->pNext);
+    CORRADE_COMPARE(info->signalSemaphoreCount, 2);
+    CORRADE_VERIFY(info->pSignalSemaphores);
+    CORRADE_COMPARE(info->pSignalSemaphores[1], reinterpret_cast<VkSemaphore>(reinterpret_cast<void*>(0xcafecafe)));
+}
+
+void QueueTest::submitInfoConstructSignalSemaphoresTimeline() {
+    SubmitInfo info;
+    info.setSignalSemaphores({
+        reinterpret_cast<VkSemaphore>(reinterpret_cast<void*>(0xbadbeef)),
+        reinterpret_cast<VkSemaphore>(reinterpret_cast<void*>(0xcafecafe))
+    }, {0, 37});
+    CORRADE_COMPARE(info->signalSemaphoreCount, 2);
+    CORRADE_VERIFY(info->pNext);
+    const auto& timelineInfo = *static_cast<const VkTimelineSemaphoreSubmitInfo*>(info->pNext);
+    CORRADE_COMPARE(timelineInfo.sType, VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO);
+    CORRADE_COMPARE(timelineInfo.signalSemaphoreValueCount, 2);
+    CORRADE_VERIFY(timelineInfo.pSignalSemaphoreValues);
+    CORRADE_COMPARE(timelineInfo.pSignalSemaphoreValues[1], 37);
+    CORRADE_COMPARE(timelineInfo.waitSemaphoreValueCount, 0);
+
+    /* Setting also wait values doesn't connect the structure twice */
+    info.setWaitSemaphores({VkSemaphore{}}, {PipelineStage::TopOfPipe}, {1});
+    CORRADE_COMPARE(info->pNext, &timelineInfo);
+    CORRADE_VERIFY(!timelineInfo.pNext);
+    CORRADE_COMPARE(timelineInfo.waitSemaphoreValueCount, 1);
+    CORRADE_COMPARE(timelineInfo.signalSemaphoreValueCount, 2);
+}
+
+void QueueTest::submitInfoConstructSignalSemaphoresWrongSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    SubmitInfo info;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    info.setSignalSemaphores({VkSemaphore{}, VkSemaphore{}}, {37});
+    CORRADE_COMPARE(out.str(),
+        "Vk::SubmitInfo::setSignalSemaphores(): expected 2 values but got 1\n");
+}
+
 void QueueTest::submitInfoConstructFromVk() {
     VkSubmitInfo vkInfo;
     vkInfo.sType = VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2;
@@ -0,0 +1,182 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <new>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Range.h"
+#include "Magnum/Vk/Image.h"
+#include "Magnum/Vk/Integration.h"
+#include "Magnum/Vk/RenderingInfo.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct RenderingInfoTest: TestSuite::Tester {
+    explicit RenderingInfoTest();
+
+    void construct();
+    void constructNoInit();
+    void constructFromVk();
+    void constructCopy();
+    void constructMove();
+
+    void colorAttachments();
+    void depthStencilAttachments();
+};
+
+RenderingInfoTest::RenderingInfoTest() {
+    addTests({&RenderingInfoTest::construct,
+              &RenderingInfoTest::constructNoInit,
+              &RenderingInfoTest::constructFromVk,
+              &RenderingInfoTest::constructCopy,
+              &RenderingInfoTest::constructMove,
+
+              &RenderingInfoTest::colorAttachments,
+              &RenderingInfoTest::depthStencilAttachments});
+}
+
+void RenderingInfoTest::construct() {
+    RenderingInfo info{{{3, 5}, {64, 32}}, 6, RenderingInfo::Flag::Suspending|RenderingInfo::Flag::ContentsSecondaryCommandBuffers};
+    CORRADE_COMPARE(info->sType, VK_STRUCTURE_TYPE_RENDERING_INFO_KHR);
+    CORRADE_COMPARE(info->flags, VK_RENDERING_SUSPENDING_BIT_KHR|VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT_KHR);
+    CORRADE_COMPARE(Range2Di{info->renderArea}, (Range2Di{{3, 5}, {64, 32}}));
+    CORRADE_COMPARE(info->layerCount, 6);
+    CORRADE_COMPARE(info->viewMask, 0);
+    CORRADE_COMPARE(info->colorAttachmentCount, 0);
+    CORRADE_VERIFY(!info->pColorAttachments);
+    CORRADE_VERIFY(!info->pDepthAttachment);
+    CORRADE_VERIFY(!info->pStencilAttachment);
+}
+
+void RenderingInfoTest::constructNoInit() {
+    RenderingInfo info{NoInit};
+    info->sType = VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2;
+    new(&info) RenderingInfo{NoInit};
+    CORRADE_COMPARE(info->sType, VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2);
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<RenderingInfo, NoInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoInitT, RenderingInfo>::value);
+}
+
+void RenderingInfoTest::constructFromVk() {
+    VkRenderingInfoKHR vkInfo;
+    vkInfo.sType = VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2;
+
+    RenderingInfo info{vkInfo};
+    CORRADE_COMPARE(info->sType, VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2);
+}
+
+void RenderingInfoTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<RenderingInfo>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<RenderingInfo>{});
+}
+
+void RenderingInfoTest::constructMove() {
+    RenderingInfo a{{{}, {64, 32}}};
+    a.addColorAttachment({}, ImageLayout::ColorAttachment, AttachmentLoadOperation::Clear, AttachmentStoreOperation::Store)
+     .setDepthAttachment({}, ImageLayout::DepthStencilAttachment, AttachmentLoadOperation::Clear, AttachmentStoreOperation::DontCare)
+     .setStencilAttachment({}, ImageLayout::DepthStencilAttachment, AttachmentLoadOperation::Clear, AttachmentStoreOperation::DontCare);
+    const VkRenderingAttachmentInfoKHR* colorAttachments = a->pColorAttachments;
+    const VkRenderingAttachmentInfoKHR* depthAttachment = a->pDepthAttachment;
+
+    RenderingInfo b = std::move(a);
+    CORRADE_COMPARE(a->colorAttachmentCount, 0);
+    CORRADE_VERIFY(!a->pColorAttachments);
+    CORRADE_VERIFY(!a->pDepthAttachment);
+    CORRADE_VERIFY(!a->pStencilAttachment);
+    CORRADE_COMPARE(b->renderArea.extent.width, 64);
+    CORRADE_COMPARE(b->colorAttachmentCount, 1);
+    CORRADE_COMPARE(b->pColorAttachments, colorAttachments);
+    CORRADE_COMPARE(b->pDepthAttachment, depthAttachment);
+    CORRADE_VERIFY(b->pStencilAttachment);
+
+    RenderingInfo c{VkRenderingInfoKHR{}};
+    c = std::move(b);
+    CORRADE_VERIFY(!b->pColorAttachments);
+    CORRADE_COMPARE(c->renderArea.extent.width, 64);
+    CORRADE_COMPARE(c->colorAttachmentCount, 1);
+    CORRADE_COMPARE(c->pColorAttachments, colorAttachments);
+    CORRADE_COMPARE(c->pDepthAttachment, depthAttachment);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<RenderingInfo>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<RenderingInfo>::value);
+}
+
+void RenderingInfoTest::colorAttachments() {
+    RenderingInfo info{{{}, {64, 32}}};
+    /* The double reinterpret_cast is needed because the handle is an uint64_t
+       instead of a pointer on 32-bit builds and only this works on both */
+    info.addColorAttachment(reinterpret_cast<VkImageView>(reinterpret_cast<void*>(0xdead)), ImageLayout::ColorAttachment, AttachmentLoadOperation::Clear, AttachmentStoreOperation::Store, Color4{0.25f, 0.5f, 0.75f, 1.0f})
+        .addColorAttachment(reinterpret_cast<VkImageView>(reinterpret_cast<void*>(0xbeef)), ImageLayout::General, AttachmentLoadOperation::Load, AttachmentStoreOperation::DontCare);
+    CORRADE_COMPARE(info->colorAttachmentCount, 2);
+    CORRADE_VERIFY(info->pColorAttachments);
+
+    const VkRenderingAttachmentInfoKHR& first = info->pColorAttachments[0];
+    CORRADE_COMPARE(first.sType, VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR);
+    CORRADE_COMPARE(first.imageView, reinterpret_cast<VkImageView>(reinterpret_cast<void*>(0xdead)));
+    CORRADE_COMPARE(first.imageLayout, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+    CORRADE_COMPARE(first.resolveMode, 0);
+    CORRADE_COMPARE(first.loadOp, VK_ATTACHMENT_LOAD_OP_CLEAR);
+    CORRADE_COMPARE(first.storeOp, VK_ATTACHMENT_STORE_OP_STORE);
+    CORRADE_COMPARE(first.clearValue.color.float32[0], 0.25f);
+    CORRADE_COMPARE(first.clearValue.color.float32[1], 0.5f);
+    CORRADE_COMPARE(first.clearValue.color.float32[2], 0.75f);
+    CORRADE_COMPARE(first.clearValue.color.float32[3], 1.0f);
+
+    const VkRenderingAttachmentInfoKHR& second = info->pColorAttachments[1];
+    CORRADE_COMPARE(second.imageView, reinterpret_cast<VkImageView>(reinterpret_cast<void*>(0xbeef)));
+    CORRADE_COMPARE(second.imageLayout, VK_IMAGE_LAYOUT_GENERAL);
+    CORRADE_COMPARE(second.loadOp, VK_ATTACHMENT_LOAD_OP_LOAD);
+    CORRADE_COMPARE(second.storeOp, VK_ATTACHMENT_STORE_OP_DONT_CARE);
+}
+
+void RenderingInfoTest::depthStencilAttachments() {
+    RenderingInfo info{{{}, {64, 32}}};
+    /* The double reinterpret_cast is needed because the handle is an uint64_t
+       instead of a pointer on 32-bit builds and only this works on both */
+    info.setDepthAttachment(reinterpret_cast<VkImageView>(reinterpret_cast<void*>(0xdead)), ImageLayout::DepthStencilAttachment, AttachmentLoadOperation::Clear, AttachmentStoreOperation::DontCare, 0.5f)
+        .setStencilAttachment(reinterpret_cast<VkImageView>(reinterpret_cast<void*>(0xdead)), ImageLayout::DepthStencilAttachment, AttachmentLoadOperation::Load, AttachmentStoreOperation::Store, 133);
+    CORRADE_COMPARE(info->colorAttachmentCount, 0);
+
+    CORRADE_VERIFY(info->pDepthAttachment);
+    CORRADE_COMPARE(info->pDepthAttachment->sType, VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR);
+    CORRADE_COMPARE(info->pDepthAttachment->imageView, reinterpret_cast<VkImageView>(reinterpret_cast<void*>(0xdead)));
+    CORRADE_COMPARE(info->pDepthAttachment->imageLayout, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
+    CORRADE_COMPARE(info->pDepthAttachment->loadOp, VK_ATTACHMENT_LOAD_OP_CLEAR);
+    CORRADE_COMPARE(info->pDepthAttachment->storeOp, VK_ATTACHMENT_STORE_OP_DONT_CARE);
+    CORRADE_COMPARE(info->pDepthAttachment->clearValue.depthStencil.depth, 0.5f);
+
+    CORRADE_VERIFY(info->pStencilAttachment);
+    CORRADE_COMPARE(info->pStencilAttachment->sType, VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR);
+    CORRADE_COMPARE(info->pStencilAttachment->loadOp, VK_ATTACHMENT_LOAD_OP_LOAD);
+    CORRADE_COMPARE(info->pStencilAttachment->storeOp, VK_ATTACHMENT_STORE_OP_STORE);
+    CORRADE_COMPARE(info->pStencilAttachment->clearValue.depthStencil.stencil, 133);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::RenderingInfoTest)
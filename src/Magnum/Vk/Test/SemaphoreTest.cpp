@@ -0,0 +1,144 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <new>
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Vk/SemaphoreCreateInfo.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct SemaphoreTest: TestSuite::Tester {
+    explicit SemaphoreTest();
+
+    void createInfoConstruct();
+    void createInfoConstructTimeline();
+    void createInfoConstructBinaryInitialValue();
+    void createInfoConstructNoInit();
+    void createInfoConstructFromVk();
+    void createInfoConstructCopy();
+
+    void constructNoCreate();
+    void constructCopy();
+};
+
+SemaphoreTest::SemaphoreTest() {
+    addTests({&SemaphoreTest::createInfoConstruct,
+              &SemaphoreTest::createInfoConstructTimeline,
+              &SemaphoreTest::createInfoConstructBinaryInitialValue,
+              &SemaphoreTest::createInfoConstructNoInit,
+              &SemaphoreTest::createInfoConstructFromVk,
+              &SemaphoreTest::createInfoConstructCopy,
+
+              &SemaphoreTest::constructNoCreate,
+              &SemaphoreTest::constructCopy});
+}
+
+void SemaphoreTest::createInfoConstruct() {
+    SemaphoreCreateInfo info;
+    CORRADE_COMPARE(info->sType, VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO);
+    /* Binary semaphores don't need the type structure */
+    CORRADE_VERIFY(!info->pNext);
+}
+
+void SemaphoreTest::createInfoConstructTimeline() {
+    SemaphoreCreateInfo info{SemaphoreType::Timeline, 37};
+    CORRADE_VERIFY(info->pNext);
+    const auto& typeInfo = *static_cast<const VkSemaphoreTypeCreateInfo*>(info->pNext);
+    CORRADE_COMPARE(typeInfo.sType, VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO);
+    CORRADE_COMPARE(typeInfo.semaphoreType, VK_SEMAPHORE_TYPE_TIMELINE);
+    CORRADE_COMPARE(typeInfo.initialValue, 37);
+}
+
+void SemaphoreTest::createInfoConstructBinaryInitialValue() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    SemaphoreCreateInfo{SemaphoreType::Binary, 37};
+    CORRADE_COMPARE(out.str(), "Vk::SemaphoreCreateInfo: initial value can be set only for a timeline semaphore\n");
+}
+
+void SemaphoreTest::createInfoConstructNoInit() {
+    SemaphoreCreateInfo info{NoInit};
+    info->sType = VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2;
+    new(&info) SemaphoreCreateInfo{NoInit};
+    CORRADE_COMPARE(info->sType, VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2);
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<SemaphoreCreateInfo, NoInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoInitT, SemaphoreCreateInfo>::value);
+}
+
+void SemaphoreTest::createInfoConstructFromVk() {
+    VkSemaphoreCreateInfo vkInfo;
+    vkInfo.sType = VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2;
+
+    SemaphoreCreateInfo info{vkInfo};
+    CORRADE_COMPARE(info->sType, VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2);
+}
+
+void SemaphoreTest::createInfoConstructCopy() {
+    SemaphoreCreateInfo a{SemaphoreType::Timeline, 37};
+
+    /* The copy should point to its own type structure */
+    SemaphoreCreateInfo b = a;
+    CORRADE_VERIFY(b->pNext);
+    CORRADE_VERIFY(b->pNext != a->pNext);
+    CORRADE_COMPARE(static_cast<const VkSemaphoreTypeCreateInfo*>(b->pNext)->initialValue, 37);
+
+    SemaphoreCreateInfo c;
+    c = a;
+    CORRADE_VERIFY(c->pNext);
+    CORRADE_VERIFY(c->pNext != a->pNext);
+    CORRADE_COMPARE(static_cast<const VkSemaphoreTypeCreateInfo*>(c->pNext)->initialValue, 37);
+
+    /* A binary semaphore info stays without the structure */
+    SemaphoreCreateInfo d;
+    SemaphoreCreateInfo e = d;
+    CORRADE_VERIFY(!e->pNext);
+}
+
+void SemaphoreTest::constructNoCreate() {
+    {
+        Semaphore semaphore{NoCreate};
+        CORRADE_VERIFY(!semaphore.handle());
+    }
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoCreateT, Semaphore>::value);
+}
+
+void SemaphoreTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<Semaphore>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<Semaphore>{});
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::SemaphoreTest)
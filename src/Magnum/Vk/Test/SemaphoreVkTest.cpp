@@ -0,0 +1,274 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Reference.h>
+
+#include "Magnum/Vk/DeviceCreateInfo.h"
+#include "Magnum/Vk/DeviceFeatures.h"
+#include "Magnum/Vk/DeviceProperties.h"
+#include "Magnum/Vk/Extensions.h"
+#include "Magnum/Vk/ExtensionProperties.h"
+#include "Magnum/Vk/FramePacer.h"
+#include "Magnum/Vk/Pipeline.h"
+#include "Magnum/Vk/Queue.h"
+#include "Magnum/Vk/Result.h"
+#include "Magnum/Vk/SemaphoreCreateInfo.h"
+#include "Magnum/Vk/Version.h"
+#include "Magnum/Vk/VulkanTester.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct SemaphoreVkTest: VulkanTester {
+    explicit SemaphoreVkTest();
+
+    void construct();
+    void constructTimeline();
+    void constructMove();
+
+    void wrap();
+
+    void value();
+    void signal();
+    void wait();
+    void waitTimeout();
+
+    void submitSignal();
+    void submitWaitSignal();
+
+    void framePacer();
+    void framePacerMove();
+};
+
+SemaphoreVkTest::SemaphoreVkTest(): VulkanTester{NoCreate} {
+    addTests({&SemaphoreVkTest::construct,
+              &SemaphoreVkTest::constructTimeline,
+              &SemaphoreVkTest::constructMove,
+
+              &SemaphoreVkTest::wrap,
+
+              &SemaphoreVkTest::value,
+              &SemaphoreVkTest::signal,
+              &SemaphoreVkTest::wait,
+              &SemaphoreVkTest::waitTimeout,
+
+              &SemaphoreVkTest::submitSignal,
+              &SemaphoreVkTest::submitWaitSignal,
+
+              &SemaphoreVkTest::framePacer,
+              &SemaphoreVkTest::framePacerMove});
+
+    /* Enable timeline semaphores if supported, the tests that need them skip
+       otherwise */
+    DeviceProperties properties = pickDevice(instance());
+    const bool timelineSemaphore = !!(properties.features() & DeviceFeature::TimelineSemaphore);
+    const bool vk12 = properties.isVersionSupported(Version::Vk12);
+    DeviceCreateInfo info{std::move(properties)};
+    info.addQueues(QueueFlag::Graphics, {0.0f}, {queue()});
+    if(timelineSemaphore) {
+        if(!vk12)
+            info.addEnabledExtensions<Extensions::KHR::timeline_semaphore>();
+        info.setEnabledFeatures(DeviceFeature::TimelineSemaphore);
+    }
+    device().create(instance(), std::move(info));
+}
+
+void SemaphoreVkTest::construct() {
+    {
+        Semaphore semaphore{device()};
+        CORRADE_VERIFY(semaphore.handle());
+        CORRADE_COMPARE(semaphore.handleFlags(), HandleFlag::DestroyOnDestruction);
+    }
+
+    /* Shouldn't crash or anything */
+    CORRADE_VERIFY(true);
+}
+
+void SemaphoreVkTest::constructTimeline() {
+    if(!(device().enabledFeatures() & DeviceFeature::TimelineSemaphore))
+        CORRADE_SKIP("DeviceFeature::TimelineSemaphore not supported, can't test.");
+
+    {
+        Semaphore semaphore{device(), SemaphoreCreateInfo{SemaphoreType::Timeline, 37}};
+        CORRADE_VERIFY(semaphore.handle());
+        CORRADE_COMPARE(semaphore.handleFlags(), HandleFlag::DestroyOnDestruction);
+        CORRADE_COMPARE(semaphore.value(), 37);
+    }
+
+    /* Shouldn't crash or anything */
+    CORRADE_VERIFY(true);
+}
+
+void SemaphoreVkTest::constructMove() {
+    Semaphore a{device()};
+    VkSemaphore handle = a.handle();
+
+    Semaphore b = std::move(a);
+    CORRADE_VERIFY(!a.handle());
+    CORRADE_COMPARE(b.handle(), handle);
+    CORRADE_COMPARE(b.handleFlags(), HandleFlag::DestroyOnDestruction);
+
+    Semaphore c{NoCreate};
+    c = std::move(b);
+    CORRADE_VERIFY(!b.handle());
+    CORRADE_COMPARE(b.handleFlags(), HandleFlags{});
+    CORRADE_COMPARE(c.handle(), handle);
+    CORRADE_COMPARE(c.handleFlags(), HandleFlag::DestroyOnDestruction);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<Semaphore>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<Semaphore>::value);
+}
+
+void SemaphoreVkTest::wrap() {
+    VkSemaphore semaphore{};
+    CORRADE_COMPARE(Result(device()->CreateSemaphore(device(),
+        SemaphoreCreateInfo{},
+        nullptr, &semaphore)), Result::Success);
+
+    auto wrapped = Semaphore::wrap(device(), semaphore, HandleFlag::DestroyOnDestruction);
+    CORRADE_COMPARE(wrapped.handle(), semaphore);
+
+    /* Release the handle again, destroy by hand */
+    CORRADE_COMPARE(wrapped.release(), semaphore);
+    CORRADE_VERIFY(!wrapped.handle());
+    device()->DestroySemaphore(device(), semaphore, nullptr);
+}
+
+void SemaphoreVkTest::value() {
+    if(!(device().enabledFeatures() & DeviceFeature::TimelineSemaphore))
+        CORRADE_SKIP("DeviceFeature::TimelineSemaphore not supported, can't test.");
+
+    Semaphore a{device(), SemaphoreCreateInfo{SemaphoreType::Timeline}};
+    CORRADE_COMPARE(a.value(), 0);
+}
+
+void SemaphoreVkTest::signal() {
+    if(!(device().enabledFeatures() & DeviceFeature::TimelineSemaphore))
+        CORRADE_SKIP("DeviceFeature::TimelineSemaphore not supported, can't test.");
+
+    Semaphore a{device(), SemaphoreCreateInfo{SemaphoreType::Timeline, 3}};
+    a.signal(17);
+    CORRADE_COMPARE(a.value(), 17);
+}
+
+void SemaphoreVkTest::wait() {
+    if(!(device().enabledFeatures() & DeviceFeature::TimelineSemaphore))
+        CORRADE_SKIP("DeviceFeature::TimelineSemaphore not supported, can't test.");
+
+    Semaphore a{device(), SemaphoreCreateInfo{SemaphoreType::Timeline, 5}};
+
+    /* Both a value that's equal and a value that's smaller should return
+       immediately */
+    a.wait(5);
+    a.wait(2);
+    CORRADE_VERIFY(a.wait(5, std::chrono::nanoseconds{0}));
+}
+
+void SemaphoreVkTest::waitTimeout() {
+    if(!(device().enabledFeatures() & DeviceFeature::TimelineSemaphore))
+        CORRADE_SKIP("DeviceFeature::TimelineSemaphore not supported, can't test.");
+
+    Semaphore a{device(), SemaphoreCreateInfo{SemaphoreType::Timeline, 5}};
+    CORRADE_VERIFY(!a.wait(6, std::chrono::milliseconds{1}));
+}
+
+void SemaphoreVkTest::submitSignal() {
+    if(!(device().enabledFeatures() & DeviceFeature::TimelineSemaphore))
+        CORRADE_SKIP("DeviceFeature::TimelineSemaphore not supported, can't test.");
+
+    Semaphore a{device(), SemaphoreCreateInfo{SemaphoreType::Timeline}};
+
+    /* An empty submission only signaling the semaphore, no fence */
+    queue().submit({SubmitInfo{}.setSignalSemaphores({a}, {3})}, {});
+    a.wait(3);
+    CORRADE_COMPARE(a.value(), 3);
+}
+
+void SemaphoreVkTest::submitWaitSignal() {
+    if(!(device().enabledFeatures() & DeviceFeature::TimelineSemaphore))
+        CORRADE_SKIP("DeviceFeature::TimelineSemaphore not supported, can't test.");
+
+    Semaphore a{device(), SemaphoreCreateInfo{SemaphoreType::Timeline}};
+    Semaphore b{device(), SemaphoreCreateInfo{SemaphoreType::Timeline}};
+
+    /* The submission waits on a signal from the host and then signals the
+       other semaphore */
+    queue().submit({SubmitInfo{}
+        .setWaitSemaphores({a}, {PipelineStage::TopOfPipe}, {1})
+        .setSignalSemaphores({b}, {2})}, {});
+    CORRADE_VERIFY(!b.wait(2, std::chrono::milliseconds{1}));
+
+    a.signal(1);
+    b.wait(2);
+    CORRADE_COMPARE(b.value(), 2);
+}
+
+void SemaphoreVkTest::framePacer() {
+    if(!(device().enabledFeatures() & DeviceFeature::TimelineSemaphore))
+        CORRADE_SKIP("DeviceFeature::TimelineSemaphore not supported, can't test.");
+
+    FramePacer pacer{device(), 2};
+    CORRADE_COMPARE(pacer.framesInFlight(), 2);
+    CORRADE_COMPARE(pacer.frame(), 0);
+    CORRADE_VERIFY(pacer.semaphore().handle());
+
+    /* Each frame only signals the semaphore. The first two frames don't wait
+       for anything, the third waits for the first. */
+    for(UnsignedInt i: {0, 1, 0, 1, 0}) {
+        CORRADE_ITERATION(pacer.frame());
+        CORRADE_COMPARE(pacer.beginFrame(), i);
+        CORRADE_COMPARE(pacer.frameIndex(), i);
+        queue().submit({SubmitInfo{}.setSignalSemaphores({pacer.semaphore()}, {pacer.frame()})}, {});
+    }
+
+    CORRADE_COMPARE(pacer.frame(), 5);
+    pacer.wait();
+    CORRADE_COMPARE(pacer.semaphore().value(), 5);
+}
+
+void SemaphoreVkTest::framePacerMove() {
+    if(!(device().enabledFeatures() & DeviceFeature::TimelineSemaphore))
+        CORRADE_SKIP("DeviceFeature::TimelineSemaphore not supported, can't test.");
+
+    FramePacer a{device(), 3};
+    VkSemaphore handle = a.semaphore().handle();
+
+    FramePacer b = std::move(a);
+    CORRADE_VERIFY(!a.semaphore().handle());
+    CORRADE_COMPARE(b.semaphore().handle(), handle);
+    CORRADE_COMPARE(b.framesInFlight(), 3);
+
+    FramePacer c{NoCreate};
+    c = std::move(b);
+    CORRADE_VERIFY(!b.semaphore().handle());
+    CORRADE_COMPARE(c.semaphore().handle(), handle);
+    CORRADE_COMPARE(c.framesInFlight(), 3);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<FramePacer>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<FramePacer>::value);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::SemaphoreVkTest)
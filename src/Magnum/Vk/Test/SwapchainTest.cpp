@@ -0,0 +1,133 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <new>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Vk/SwapchainCreateInfo.h"
+
+#include "Magnum/Vk/Test/pixelFormatTraits.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct SwapchainTest: TestSuite::Tester {
+    explicit SwapchainTest();
+
+    template<class T> void createInfoConstruct();
+    void createInfoConstructNoInit();
+    void createInfoConstructFromVk();
+    void createInfoSetOldSwapchain();
+
+    void constructNoCreate();
+    void constructCopy();
+};
+
+SwapchainTest::SwapchainTest() {
+    addTests({&SwapchainTest::createInfoConstruct<PixelFormat>,
+              &SwapchainTest::createInfoConstruct<Magnum::PixelFormat>,
+              &SwapchainTest::createInfoConstructNoInit,
+              &SwapchainTest::createInfoConstructFromVk,
+              &SwapchainTest::createInfoSetOldSwapchain,
+
+              &SwapchainTest::constructNoCreate,
+              &SwapchainTest::constructCopy});
+}
+
+template<class T> void SwapchainTest::createInfoConstruct() {
+    setTestCaseTemplateName(PixelFormatTraits<T>::name());
+
+    /* The double reinterpret_cast is needed because the handle is an uint64_t
+       instead of a pointer on 32-bit builds and only this works on both */
+    auto surface = reinterpret_cast<VkSurfaceKHR>(reinterpret_cast<void*>(0xdead));
+    SwapchainCreateInfo info{surface, PixelFormatTraits<T>::format(), {1280, 720}, PresentMode::Mailbox, 3, ImageUsage::ColorAttachment|ImageUsage::TransferDestination};
+    CORRADE_COMPARE(info->sType, VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR);
+    CORRADE_VERIFY(!info->pNext);
+    CORRADE_COMPARE(info->surface, surface);
+    CORRADE_COMPARE(info->minImageCount, 3);
+    CORRADE_COMPARE(info->imageFormat, PixelFormatTraits<T>::expected());
+    CORRADE_COMPARE(info->imageColorSpace, VK_COLOR_SPACE_SRGB_NONLINEAR_KHR);
+    CORRADE_COMPARE(info->imageExtent.width, 1280);
+    CORRADE_COMPARE(info->imageExtent.height, 720);
+    CORRADE_COMPARE(info->imageArrayLayers, 1);
+    CORRADE_COMPARE(info->imageUsage, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT|VK_IMAGE_USAGE_TRANSFER_DST_BIT);
+    CORRADE_COMPARE(info->imageSharingMode, VK_SHARING_MODE_EXCLUSIVE);
+    CORRADE_COMPARE(info->preTransform, VK_SURFACE_TRANSFORM_IDENTITY_BIT_KHR);
+    CORRADE_COMPARE(info->compositeAlpha, VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR);
+    CORRADE_COMPARE(info->presentMode, VK_PRESENT_MODE_MAILBOX_KHR);
+    CORRADE_COMPARE(info->clipped, VK_TRUE);
+    CORRADE_VERIFY(!info->oldSwapchain);
+}
+
+void SwapchainTest::createInfoConstructNoInit() {
+    SwapchainCreateInfo info{NoInit};
+    info->sType = VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2;
+    new(&info) SwapchainCreateInfo{NoInit};
+    CORRADE_COMPARE(info->sType, VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2);
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<SwapchainCreateInfo, NoInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoInitT, SwapchainCreateInfo>::value);
+}
+
+void SwapchainTest::createInfoConstructFromVk() {
+    VkSwapchainCreateInfoKHR vkInfo;
+    vkInfo.sType = VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2;
+
+    SwapchainCreateInfo info{vkInfo};
+    CORRADE_COMPARE(info->sType, VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2);
+}
+
+void SwapchainTest::createInfoSetOldSwapchain() {
+    auto oldSwapchain = reinterpret_cast<VkSwapchainKHR>(reinterpret_cast<void*>(0xcafe));
+    SwapchainCreateInfo info{{}, PixelFormat::BGRA8Srgb, {640, 480}};
+    info.setOldSwapchain(oldSwapchain);
+    CORRADE_COMPARE(info->oldSwapchain, oldSwapchain);
+    /* Defaults */
+    CORRADE_COMPARE(info->presentMode, VK_PRESENT_MODE_FIFO_KHR);
+    CORRADE_COMPARE(info->minImageCount, 2);
+    CORRADE_COMPARE(info->imageUsage, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT);
+}
+
+void SwapchainTest::constructNoCreate() {
+    {
+        Swapchain swapchain{NoCreate};
+        CORRADE_VERIFY(!swapchain.handle());
+        CORRADE_VERIFY(swapchain.images().isEmpty());
+        CORRADE_COMPARE(swapchain.size(), Vector2i{});
+    }
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoCreateT, Swapchain>::value);
+}
+
+void SwapchainTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<Swapchain>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<Swapchain>{});
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::SwapchainTest)
@@ -0,0 +1,127 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Vk/UploadBatcher.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct UploadBatcherTest: TestSuite::Tester {
+    explicit UploadBatcherTest();
+
+    void constructNoCreate();
+    void constructCopy();
+
+    void uploadTooLarge();
+    void uploadImageTooLarge();
+    void flushNothing();
+    void waitNotSubmitted();
+};
+
+UploadBatcherTest::UploadBatcherTest() {
+    addTests({&UploadBatcherTest::constructNoCreate,
+              &UploadBatcherTest::constructCopy,
+
+              &UploadBatcherTest::uploadTooLarge,
+              &UploadBatcherTest::uploadImageTooLarge,
+              &UploadBatcherTest::flushNothing,
+              &UploadBatcherTest::waitNotSubmitted});
+}
+
+void UploadBatcherTest::constructNoCreate() {
+    {
+        UploadBatcher batcher{NoCreate};
+        CORRADE_COMPARE(batcher.stagingSize(), 0);
+        CORRADE_COMPARE(batcher.batchCount(), 0);
+        CORRADE_COMPARE(batcher.submitted(), 0);
+        CORRADE_COMPARE(batcher.completed(), 0);
+    }
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoCreateT, UploadBatcher>::value);
+}
+
+void UploadBatcherTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<UploadBatcher>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<UploadBatcher>{});
+}
+
+void UploadBatcherTest::uploadTooLarge() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    UploadBatcher batcher{NoCreate};
+    const char data[3]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    batcher.upload(data, {});
+    CORRADE_COMPARE(out.str(), "Vk::UploadBatcher::upload(): data size 3 larger than staging size 0\n");
+}
+
+void UploadBatcherTest::uploadImageTooLarge() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    UploadBatcher batcher{NoCreate};
+    const char data[4*4*2]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    batcher.upload(ImageView2D{Magnum::PixelFormat::RGBA8Unorm, {4, 2}, data}, {});
+    CORRADE_COMPARE(out.str(), "Vk::UploadBatcher::upload(): image size 32 larger than staging size 0\n");
+}
+
+void UploadBatcherTest::flushNothing() {
+    UploadBatcher batcher{NoCreate};
+
+    /* Nothing is being recorded, so this shouldn't touch the nonexistent
+       queue */
+    CORRADE_COMPARE(batcher.flush(), 0);
+    CORRADE_COMPARE(batcher.submitted(), 0);
+
+    /* Waiting for nothing is a no-op too */
+    batcher.wait(0);
+    batcher.finish();
+    CORRADE_COMPARE(batcher.completed(), 0);
+}
+
+void UploadBatcherTest::waitNotSubmitted() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    UploadBatcher batcher{NoCreate};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    batcher.wait(1);
+    CORRADE_COMPARE(out.str(), "Vk::UploadBatcher::wait(): batch 1 not submitted yet, last submitted is 0\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::UploadBatcherTest)
@@ -0,0 +1,233 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/Utility/Algorithms.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Vk/BufferCreateInfo.h"
+#include "Magnum/Vk/DeviceProperties.h"
+#include "Magnum/Vk/ImageCreateInfo.h"
+#include "Magnum/Vk/Pipeline.h"
+#include "Magnum/Vk/PixelFormat.h"
+#include "Magnum/Vk/UploadBatcher.h"
+#include "Magnum/Vk/VulkanTester.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct UploadBatcherVkTest: VulkanTester {
+    explicit UploadBatcherVkTest();
+
+    void construct();
+    void constructMove();
+
+    void upload();
+    void uploadEmpty();
+    void uploadWraparound();
+    void uploadImage();
+
+    void completed();
+};
+
+using namespace Containers::Literals;
+
+UploadBatcherVkTest::UploadBatcherVkTest() {
+    addTests({&UploadBatcherVkTest::construct,
+              &UploadBatcherVkTest::constructMove,
+
+              &UploadBatcherVkTest::upload,
+              &UploadBatcherVkTest::uploadEmpty,
+              &UploadBatcherVkTest::uploadWraparound,
+              &UploadBatcherVkTest::uploadImage,
+
+              &UploadBatcherVkTest::completed});
+}
+
+void UploadBatcherVkTest::construct() {
+    {
+        UploadBatcher batcher{device(), queue(), device().properties().pickQueueFamily(QueueFlag::Graphics), 1024, 3};
+        CORRADE_COMPARE(batcher.stagingSize(), 1024);
+        CORRADE_COMPARE(batcher.batchCount(), 3);
+        CORRADE_COMPARE(batcher.submitted(), 0);
+        CORRADE_COMPARE(batcher.completed(), 0);
+    }
+
+    /* Shouldn't crash or anything */
+    CORRADE_VERIFY(true);
+}
+
+void UploadBatcherVkTest::constructMove() {
+    Buffer buffer{device(), BufferCreateInfo{
+        BufferUsage::TransferDestination, 4
+    }, MemoryFlag::HostVisible};
+
+    UploadBatcher a{device(), queue(), device().properties().pickQueueFamily(QueueFlag::Graphics), 1024, 3};
+    a.upload("abcd"_s, buffer)
+     .flush();
+
+    UploadBatcher b = std::move(a);
+    CORRADE_COMPARE(a.stagingSize(), 0);
+    CORRADE_COMPARE(a.submitted(), 0);
+    CORRADE_COMPARE(b.stagingSize(), 1024);
+    CORRADE_COMPARE(b.batchCount(), 3);
+    CORRADE_COMPARE(b.submitted(), 1);
+
+    UploadBatcher c{NoCreate};
+    c = std::move(b);
+    CORRADE_COMPARE(b.stagingSize(), 0);
+    CORRADE_COMPARE(b.submitted(), 0);
+    CORRADE_COMPARE(c.stagingSize(), 1024);
+    CORRADE_COMPARE(c.submitted(), 1);
+
+    /* The batch submitted from the original instance should be still
+       waitable */
+    c.wait(1);
+    CORRADE_COMPARE(c.completed(), 1);
+    CORRADE_COMPARE(arrayView(buffer.dedicatedMemory().mapRead()), "abcd"_s);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<UploadBatcher>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<UploadBatcher>::value);
+}
+
+void UploadBatcherVkTest::upload() {
+    Buffer buffer{device(), BufferCreateInfo{
+        BufferUsage::TransferDestination, 16
+    }, MemoryFlag::HostVisible};
+    Utility::copy("................"_s, buffer.dedicatedMemory().map());
+
+    UploadBatcher batcher{device(), queue(), device().properties().pickQueueFamily(QueueFlag::Graphics), 1024};
+    batcher
+        .upload("Hello"_s, buffer, 2)
+        .upload("world"_s, buffer, 9);
+    CORRADE_COMPARE(batcher.submitted(), 0);
+
+    /* Both uploads should go into a single batch */
+    CORRADE_COMPARE(batcher.flush(), 1);
+    CORRADE_COMPARE(batcher.submitted(), 1);
+
+    /* Flushing again does nothing */
+    CORRADE_COMPARE(batcher.flush(), 1);
+
+    batcher.wait(1);
+    CORRADE_COMPARE(batcher.completed(), 1);
+    CORRADE_COMPARE(arrayView(buffer.dedicatedMemory().mapRead()), "..Hello..world.."_s);
+}
+
+void UploadBatcherVkTest::uploadEmpty() {
+    UploadBatcher batcher{device(), queue(), device().properties().pickQueueFamily(QueueFlag::Graphics), 1024};
+    batcher.upload(nullptr, {});
+
+    /* Nothing was recorded, so nothing gets submitted */
+    CORRADE_COMPARE(batcher.flush(), 0);
+    CORRADE_COMPARE(batcher.submitted(), 0);
+}
+
+void UploadBatcherVkTest::uploadWraparound() {
+    Buffer buffer{device(), BufferCreateInfo{
+        BufferUsage::TransferDestination, 10*12
+    }, MemoryFlag::HostVisible};
+
+    /* The staging buffer fits just a single upload, so every next upload has
+       to submit the previous batch and wait for it, wrapping around to the
+       beginning */
+    UploadBatcher batcher{device(), queue(), device().properties().pickQueueFamily(QueueFlag::Graphics), 16, 2};
+    const Containers::StringView chunks[]{
+        "AaaaAaaaAaaa"_s, "BbbbBbbbBbbb"_s, "CcccCcccCccc"_s, "DdddDdddDddd"_s,
+        "EeeeEeeeEeee"_s, "FfffFfffFfff"_s, "GgggGgggGggg"_s, "HhhhHhhhHhhh"_s,
+        "IiiiIiiiIiii"_s, "JjjjJjjjJjjj"_s
+    };
+    for(std::size_t i = 0; i != Containers::arraySize(chunks); ++i)
+        batcher.upload(chunks[i], buffer, i*12);
+    batcher.finish();
+
+    CORRADE_COMPARE(batcher.submitted(), 10);
+    CORRADE_COMPARE(batcher.completed(), 10);
+    CORRADE_COMPARE(arrayView(buffer.dedicatedMemory().mapRead()),
+        "AaaaAaaaAaaaBbbbBbbbBbbbCcccCcccCcccDdddDdddDddd"
+        "EeeeEeeeEeeeFfffFfffFfffGgggGgggGgggHhhhHhhhHhhh"
+        "IiiiIiiiIiiiJjjjJjjjJjjj"_s);
+}
+
+void UploadBatcherVkTest::uploadImage() {
+    Image image{device(), ImageCreateInfo2D{
+        ImageUsage::TransferDestination|ImageUsage::TransferSource,
+        PixelFormat::RGBA8UI, {2, 2}, 1
+    }, MemoryFlag::DeviceLocal};
+
+    Buffer buffer{device(), BufferCreateInfo{
+        BufferUsage::TransferDestination, 2*2*4
+    }, MemoryFlag::HostVisible};
+
+    /* The image has rows padded to three pixels, which shouldn't get
+       uploaded */
+    const Containers::StringView data = "AaaaBbbb____CcccDddd____"_s;
+
+    UploadBatcher batcher{device(), queue(), device().properties().pickQueueFamily(QueueFlag::Graphics), 1024};
+    batcher.commandBuffer()
+        .pipelineBarrier(PipelineStage::TopOfPipe, PipelineStage::Transfer, {
+            {Accesses{}, Access::TransferWrite,
+             ImageLayout::Undefined, ImageLayout::TransferDestination, image}
+        });
+    batcher.upload(ImageView2D{PixelStorage{}.setRowLength(3),
+        Magnum::PixelFormat::RGBA8UI, {2, 2}, data}, image);
+    batcher.commandBuffer()
+        .pipelineBarrier(PipelineStage::Transfer, PipelineStage::Transfer, {
+            {Access::TransferWrite, Access::TransferRead,
+             ImageLayout::TransferDestination, ImageLayout::TransferSource, image}
+        })
+        .copyImageToBuffer({image, ImageLayout::TransferSource, buffer, {
+            BufferImageCopy2D{0, ImageAspect::Color, 0, {{}, {2, 2}}}
+        }})
+        .pipelineBarrier(PipelineStage::Transfer, PipelineStage::Host, {
+            {Access::TransferWrite, Access::HostRead, buffer}
+        });
+    batcher.finish();
+
+    CORRADE_COMPARE(arrayView(buffer.dedicatedMemory().mapRead()),
+        "AaaaBbbbCcccDddd"_s);
+}
+
+void UploadBatcherVkTest::completed() {
+    Buffer buffer{device(), BufferCreateInfo{
+        BufferUsage::TransferDestination, 4
+    }, MemoryFlag::HostVisible};
+
+    UploadBatcher batcher{device(), queue(), device().properties().pickQueueFamily(QueueFlag::Graphics), 1024};
+    batcher.upload("abcd"_s, buffer);
+    const UnsignedLong batch = batcher.flush();
+    CORRADE_COMPARE(batch, 1);
+
+    /* Polling should eventually report the batch as finished */
+    while(batcher.completed() != batch);
+    CORRADE_COMPARE(batcher.completed(), 1);
+    CORRADE_COMPARE(arrayView(buffer.dedicatedMemory().mapRead()), "abcd"_s);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::UploadBatcherVkTest)
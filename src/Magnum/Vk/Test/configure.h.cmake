@@ -26,3 +26,4 @@
 #cmakedefine ANYIMAGEIMPORTER_PLUGIN_FILENAME "${ANYIMAGEIMPORTER_PLUGIN_FILENAME}"
 #cmakedefine TGAIMPORTER_PLUGIN_FILENAME "${TGAIMPORTER_PLUGIN_FILENAME}"
 #define VK_TEST_DIR "${VK_TEST_DIR}"
+#define VK_TEST_OUTPUT_DIR "${VK_TEST_OUTPUT_DIR}"
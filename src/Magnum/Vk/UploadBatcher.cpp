@@ -0,0 +1,234 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "UploadBatcher.h"
+
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Vk/BufferCreateInfo.h"
+#include "Magnum/Vk/CommandPoolCreateInfo.h"
+#include "Magnum/Vk/Queue.h"
+
+namespace Magnum { namespace Vk {
+
+UploadBatcher::UploadBatcher(Device& device, Queue& queue, const UnsignedInt queueFamilyIndex, const UnsignedLong stagingSize, const UnsignedInt batchCount): _queue{&queue}, _staging{NoCreate}, _pool{NoCreate}, _head{}, _tail{}, _submitted{}, _completed{}, _recording{} {
+    CORRADE_ASSERT(stagingSize,
+        "Vk::UploadBatcher: expected non-zero staging size", );
+    CORRADE_ASSERT(batchCount,
+        "Vk::UploadBatcher: expected non-zero batch count", );
+
+    _staging = Buffer{device, BufferCreateInfo{BufferUsage::TransferSource, stagingSize}, MemoryFlag::HostVisible|MemoryFlag::HostCoherent};
+    /* The staging buffer stays mapped for the whole batcher lifetime */
+    _stagingData = _staging.dedicatedMemory().map();
+
+    _pool = CommandPool{device, CommandPoolCreateInfo{queueFamilyIndex, CommandPoolCreateInfo::Flag::ResetCommandBuffer}};
+    _commandBuffers = Containers::Array<CommandBuffer>{DirectInit, batchCount, NoCreate};
+    for(CommandBuffer& commandBuffer: _commandBuffers)
+        commandBuffer = _pool.allocate();
+    _fences = Containers::Array<Fence>{DirectInit, batchCount, device};
+    _batchEnds = Containers::Array<UnsignedLong>{ValueInit, batchCount};
+}
+
+UploadBatcher::UploadBatcher(NoCreateT) noexcept: _queue{}, _staging{NoCreate}, _pool{NoCreate}, _head{}, _tail{}, _submitted{}, _completed{}, _recording{} {}
+
+UploadBatcher::UploadBatcher(UploadBatcher&& other) noexcept: _queue{other._queue}, _staging{std::move(other._staging)}, _stagingData{std::move(other._stagingData)}, _pool{std::move(other._pool)}, _commandBuffers{std::move(other._commandBuffers)}, _fences{std::move(other._fences)}, _batchEnds{std::move(other._batchEnds)}, _head{other._head}, _tail{other._tail}, _submitted{other._submitted}, _completed{other._completed}, _recording{other._recording} {
+    other._queue = nullptr;
+    other._head = other._tail = other._submitted = other._completed = 0;
+    other._recording = false;
+}
+
+UploadBatcher::~UploadBatcher() {
+    /* The staging memory and command buffers can't be destroyed while the GPU
+       is still using them */
+    while(_completed != _submitted) retireOldest();
+}
+
+UploadBatcher& UploadBatcher::operator=(UploadBatcher&& other) noexcept {
+    using std::swap;
+    swap(other._queue, _queue);
+    swap(other._staging, _staging);
+    swap(other._stagingData, _stagingData);
+    swap(other._pool, _pool);
+    swap(other._commandBuffers, _commandBuffers);
+    swap(other._fences, _fences);
+    swap(other._batchEnds, _batchEnds);
+    swap(other._head, _head);
+    swap(other._tail, _tail);
+    swap(other._submitted, _submitted);
+    swap(other._completed, _completed);
+    swap(other._recording, _recording);
+    return *this;
+}
+
+void UploadBatcher::retireOldest() {
+    Fence& fence = _fences[_completed % _fences.size()];
+    fence.wait();
+    fence.reset();
+    _tail = _batchEnds[_completed % _fences.size()];
+    ++_completed;
+
+    /* If nothing is in flight or being recorded anymore, the whole ring is
+       free again. Starting from the beginning avoids needless wraparounds. */
+    if(_completed == _submitted && !_recording)
+        _head = _tail = 0;
+}
+
+UnsignedLong UploadBatcher::completed() {
+    /* Batches submitted to the same queue finish in order, so it's enough to
+       check them from the oldest. The fence is known to be signaled so
+       retireOldest() won't block. */
+    while(_completed != _submitted && _fences[_completed % _fences.size()].status())
+        retireOldest();
+    return _completed;
+}
+
+CommandBuffer& UploadBatcher::commandBuffer() {
+    CommandBuffer& commandBuffer = _commandBuffers[_submitted % _commandBuffers.size()];
+    if(!_recording) {
+        /* The command buffer for the next batch is still in flight, wait for
+           it */
+        if(_submitted - _completed == _commandBuffers.size())
+            retireOldest();
+        commandBuffer.begin(CommandBufferBeginInfo{CommandBufferBeginInfo::Flag::OneTimeSubmit});
+        _recording = true;
+    }
+    return commandBuffer;
+}
+
+bool UploadBatcher::tryAllocate(const UnsignedLong size, const UnsignedLong alignment, UnsignedLong& offset) {
+    const UnsignedLong aligned = (_head + alignment - 1)/alignment*alignment;
+
+    /* Not wrapped around, the free space is after the head and before the
+       tail */
+    if(_head >= _tail) {
+        if(aligned + size <= _stagingData.size()) {
+            offset = aligned;
+            _head = aligned + size;
+            return true;
+        }
+
+        /* Wrap around. Has to stay strictly before the tail so a full ring
+           isn't confused with an empty one. Offset 0 is aligned for
+           anything. */
+        if(size < _tail) {
+            offset = 0;
+            _head = size;
+            return true;
+        }
+
+        return false;
+    }
+
+    /* Wrapped around, the free space is between the head and the tail */
+    if(aligned + size < _tail) {
+        offset = aligned;
+        _head = aligned + size;
+        return true;
+    }
+
+    return false;
+}
+
+UnsignedLong UploadBatcher::allocate(const UnsignedLong size, const UnsignedLong alignment) {
+    /* Begin recording first -- if it has to wait for a command buffer to
+       become available, it could otherwise reset the ring with the just
+       allocated range in it */
+    commandBuffer();
+
+    UnsignedLong offset;
+    while(!tryAllocate(size, alignment, offset)) {
+        /* Free the oldest batch in flight first. If there's none, the
+           current batch is what takes the space, so submit it to be able to
+           wait for it in the next iteration. Once both are done, the ring is
+           empty and the allocation succeeds. */
+        if(_completed != _submitted) retireOldest();
+        else flush();
+    }
+    return offset;
+}
+
+UploadBatcher& UploadBatcher::upload(const Containers::ArrayView<const void> data, const VkBuffer destination, const UnsignedLong destinationOffset) {
+    CORRADE_ASSERT(data.size() <= _stagingData.size(),
+        "Vk::UploadBatcher::upload(): data size" << data.size() << "larger than staging size" << _stagingData.size(), *this);
+    if(data.isEmpty()) return *this;
+
+    const UnsignedLong offset = allocate(data.size(), 4);
+    Utility::copy(Containers::ArrayView<const char>{static_cast<const char*>(data.data()), data.size()}, _stagingData.slice(offset, offset + data.size()));
+
+    commandBuffer().copyBuffer({_staging, destination, {
+        {offset, destinationOffset, data.size()}
+    }});
+    return *this;
+}
+
+UploadBatcher& UploadBatcher::upload(const ImageView2D& image, const VkImage destination, const ImageLayout layout, const ImageAspect aspect, const Int level, const Vector2i& offset) {
+    const std::size_t pixelSize = image.pixelSize();
+    const std::size_t size = std::size_t(image.size().product())*pixelSize;
+    CORRADE_ASSERT(size <= _stagingData.size(),
+        "Vk::UploadBatcher::upload(): image size" << size << "larger than staging size" << _stagingData.size(), *this);
+    if(!size) return *this;
+
+    /* The buffer offset has to be a multiple of both the texel size and 4 */
+    const UnsignedLong alignment = pixelSize % 4 == 0 ? pixelSize :
+        pixelSize % 2 == 0 ? pixelSize*2 : pixelSize*4;
+    const UnsignedLong stagingOffset = allocate(size, alignment);
+
+    /* Copy with tightly packed rows, dropping any padding the image has */
+    const Containers::StridedArrayView3D<const char> src = image.pixels();
+    Utility::copy(src, Containers::StridedArrayView3D<char>{
+        _stagingData.slice(stagingOffset, stagingOffset + size),
+        {std::size_t(image.size().y()), std::size_t(image.size().x()), pixelSize}});
+
+    commandBuffer().copyBufferToImage({_staging, destination, layout, {
+        BufferImageCopy2D{stagingOffset, aspect, level, Range2Di::fromSize(offset, image.size())}
+    }});
+    return *this;
+}
+
+UnsignedLong UploadBatcher::flush() {
+    if(!_recording) return _submitted;
+
+    const std::size_t id = _submitted % _commandBuffers.size();
+    _commandBuffers[id].end();
+    _batchEnds[id] = _head;
+    _queue->submit({SubmitInfo{}.setCommandBuffers({_commandBuffers[id]})}, _fences[id]);
+    _recording = false;
+    return ++_submitted;
+}
+
+void UploadBatcher::wait(const UnsignedLong batch) {
+    CORRADE_ASSERT(batch <= _submitted,
+        "Vk::UploadBatcher::wait(): batch" << batch << "not submitted yet, last submitted is" << _submitted, );
+    while(_completed < batch) retireOldest();
+}
+
+void UploadBatcher::finish() {
+    wait(flush());
+}
+
+}}
@@ -0,0 +1,276 @@
+#ifndef Magnum_Vk_UploadBatcher_h
+#define Magnum_Vk_UploadBatcher_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Vk::UploadBatcher
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Vk/Buffer.h"
+#include "Magnum/Vk/CommandBuffer.h"
+#include "Magnum/Vk/CommandPool.h"
+#include "Magnum/Vk/Fence.h"
+#include "Magnum/Vk/Image.h"
+#include "Magnum/Vk/Memory.h"
+
+namespace Magnum { namespace Vk {
+
+/**
+@brief Staging upload batcher
+@m_since_latest
+
+Packs many buffer and image uploads into a single persistently mapped
+host-visible staging buffer used as a ring, records the copies into command
+buffers and submits them to a queue in batches. Compared to creating a
+staging buffer, recording a command buffer and waiting on a fence for every
+upload, this results in just a few queue submissions and no staging
+allocations after the initial one.
+
+@section Vk-UploadBatcher-creation Batcher creation
+
+The batcher takes a @ref Queue the copies get submitted to, index of its
+family, a size of the staging buffer and a count of batches that can be in
+flight at the same time. The queue can be a dedicated transfer queue
+retrieved using @ref DeviceCreateInfo::addQueues() with a family picked by
+@ref DeviceProperties::pickQueueFamily():
+
+@snippet MagnumVk.cpp UploadBatcher-creation
+
+@section Vk-UploadBatcher-upload Uploading data
+
+The @ref upload() functions copy the data to the staging buffer right away
+and record a copy to the destination into the current batch. The staging
+buffer is used as a ring --- if there's not enough space, the batcher waits
+until the oldest batch in flight is finished and reuses its memory,
+submitting the current batch first if needed. Mesh vertex and index data can
+be uploaded directly from @ref Trade::MeshData::vertexData() and
+@ref Trade::MeshData::indexData():
+
+@snippet MagnumVk.cpp UploadBatcher-upload
+
+The @ref flush() function submits the current batch and returns its serial
+number. Serial numbers increase monotonically, a batch with a given serial is
+finished once @ref completed() returns the same or a larger value, or you can
+explicitly block until it's finished using @ref wait().
+
+Images are expected to be in a layout suitable for a transfer destination when
+the copy executes. The @ref commandBuffer() function gives access to the
+current batch command buffer, allowing you to record the layout transitions
+and other barriers next to the copies:
+
+@snippet MagnumVk.cpp UploadBatcher-image
+
+@m_class{m-note m-warning}
+
+@par
+    If the queue the batcher submits to is from a different family than the
+    queue that consumes the resources, and the resources aren't created with
+    a concurrent sharing mode, a queue family ownership transfer has to be
+    done by the application.
+*/
+class MAGNUM_VK_EXPORT UploadBatcher {
+    public:
+        /**
+         * @brief Constructor
+         * @param device            Vulkan device
+         * @param queue             Queue to submit the batches to
+         * @param queueFamilyIndex  Family index of @p queue
+         * @param stagingSize       Staging buffer size in bytes
+         * @param batchCount        Max count of batches in flight
+         *
+         * Creates a @ref MemoryFlag::HostVisible and
+         * @ref MemoryFlag::HostCoherent staging @ref Buffer with
+         * @ref BufferUsage::TransferSource and maps it, a @ref CommandPool
+         * with @ref CommandPoolCreateInfo::Flag::ResetCommandBuffer on
+         * @p queueFamilyIndex, and @p batchCount command buffers and
+         * fences. Expects that @p stagingSize and @p batchCount are both
+         * non-zero.
+         */
+        explicit UploadBatcher(Device& device, Queue& queue, UnsignedInt queueFamilyIndex, UnsignedLong stagingSize, UnsignedInt batchCount = 4);
+
+        /**
+         * @brief Construct without creating the batcher
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit UploadBatcher(NoCreateT) noexcept;
+
+        /** @brief Copying is not allowed */
+        UploadBatcher(const UploadBatcher&) = delete;
+
+        /** @brief Move constructor */
+        UploadBatcher(UploadBatcher&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Waits until all submitted batches are finished and destroys the
+         * staging buffer, command buffers and fences. A batch that's being
+         * recorded and wasn't submitted via @ref flush() is discarded.
+         */
+        ~UploadBatcher();
+
+        /** @brief Copying is not allowed */
+        UploadBatcher& operator=(const UploadBatcher&) = delete;
+
+        /** @brief Move assignment */
+        UploadBatcher& operator=(UploadBatcher&& other) noexcept;
+
+        /** @brief Staging buffer size in bytes */
+        UnsignedLong stagingSize() const { return _stagingData.size(); }
+
+        /** @brief Max count of batches in flight */
+        UnsignedInt batchCount() const { return _commandBuffers.size(); }
+
+        /**
+         * @brief Serial number of the last submitted batch
+         *
+         * Initially @cpp 0 @ce, incremented with every @ref flush() that
+         * submitted a batch.
+         */
+        UnsignedLong submitted() const { return _submitted; }
+
+        /**
+         * @brief Serial number of the last finished batch
+         *
+         * Checks status of the batches in flight, marks the finished ones as
+         * available for reuse and returns serial number of the last batch
+         * that's known to be finished. Initially @cpp 0 @ce, always less or
+         * equal to @ref submitted().
+         * @see @ref Fence::status()
+         */
+        UnsignedLong completed();
+
+        /**
+         * @brief Current batch command buffer
+         *
+         * If no batch is being recorded, waits for the oldest batch in flight
+         * if @ref batchCount() batches are in flight already and begins
+         * recording a new one. Useful for recording barriers around the
+         * copies, the command buffer shouldn't be ended or submitted
+         * directly.
+         */
+        CommandBuffer& commandBuffer();
+
+        /**
+         * @brief Upload data to a buffer
+         * @param data              Data to upload
+         * @param destination       Destination buffer. Expected to have
+         *      @ref BufferUsage::TransferDestination.
+         * @param destinationOffset Offset in the destination buffer
+         * @return Reference to self (for method chaining)
+         *
+         * Copies @p data to the staging buffer and records a
+         * @ref CommandBuffer::copyBuffer() to @p destination into the
+         * current batch. Expects that size of @p data isn't larger than
+         * @ref stagingSize(). If @p data is empty, the function is a no-op.
+         */
+        UploadBatcher& upload(Containers::ArrayView<const void> data, VkBuffer destination, UnsignedLong destinationOffset = 0);
+
+        /**
+         * @brief Upload an image
+         * @param image             Image to upload
+         * @param destination       Destination image. Expected to have
+         *      @ref ImageUsage::TransferDestination.
+         * @param layout            Layout @p destination is in when the copy
+         *      executes. Allowed values are
+         *      @ref ImageLayout::TransferDestination and
+         *      @ref ImageLayout::General.
+         * @param aspect            Destination image aspect
+         * @param level             Destination image mip level
+         * @param offset            Offset in the destination image
+         * @return Reference to self (for method chaining)
+         *
+         * Copies pixels of @p image to the staging buffer with tightly
+         * packed rows, discarding any padding from @ref PixelStorage, and
+         * records a @ref CommandBuffer::copyBufferToImage() to
+         * @p destination into the current batch. The pixel format of
+         * @p image is expected to match @p destination. Expects that the
+         * tightly packed pixel data fit into @ref stagingSize(). If
+         * @p image is empty, the function is a no-op.
+         */
+        UploadBatcher& upload(const ImageView2D& image, VkImage destination, ImageLayout layout = ImageLayout::TransferDestination, ImageAspect aspect = ImageAspect::Color, Int level = 0, const Vector2i& offset = {});
+
+        /**
+         * @brief Submit the current batch
+         * @return Serial number of the submitted batch
+         *
+         * If there's no batch being recorded, does nothing and returns
+         * @ref submitted().
+         * @see @ref Queue::submit()
+         */
+        UnsignedLong flush();
+
+        /**
+         * @brief Wait for a batch to finish
+         *
+         * Blocks until the batch with serial number @p batch and all batches
+         * before it are finished. Expects that @p batch is not larger than
+         * @ref submitted(), waiting for @cpp 0 @ce is a no-op.
+         * @see @ref Fence::wait()
+         */
+        void wait(UnsignedLong batch);
+
+        /**
+         * @brief Submit the current batch and wait for everything to finish
+         *
+         * Equivalent to calling @ref flush() followed by @ref wait() with
+         * its result.
+         */
+        void finish();
+
+    private:
+        /* Finds a place for given count of bytes in the staging ring,
+           submitting the current batch and waiting for the ones in flight if
+           needed */
+        MAGNUM_VK_LOCAL UnsignedLong allocate(UnsignedLong size, UnsignedLong alignment);
+        MAGNUM_VK_LOCAL bool tryAllocate(UnsignedLong size, UnsignedLong alignment, UnsignedLong& offset);
+        MAGNUM_VK_LOCAL void retireOldest();
+
+        Queue* _queue;
+        Buffer _staging;
+        Containers::Array<char, MemoryMapDeleter> _stagingData;
+        CommandPool _pool;
+        Containers::Array<CommandBuffer> _commandBuffers;
+        Containers::Array<Fence> _fences;
+        /* Position of the staging ring head after each batch was recorded */
+        Containers::Array<UnsignedLong> _batchEnds;
+        /* The staging ring is used between _tail and _head, wrapping around
+           if _head is less than _tail */
+        UnsignedLong _head, _tail;
+        UnsignedLong _submitted, _completed;
+        bool _recording;
+};
+
+}}
+
+#endif
@@ -42,7 +42,8 @@ class Buffer;
 class BufferCreateInfo;
 class BufferMemoryBarrier;
 class CommandBuffer;
-/* CommandBufferBeginInfo is useful only in combination with CommandBuffer */
+/* CommandBufferBeginInfo and CommandBufferInheritanceInfo are useful only in
+   combination with CommandBuffer */
 class CommandPool;
 class CommandPoolCreateInfo;
 class ComputePipelineCreateInfo;
@@ -57,6 +58,8 @@ class CopyImageToBufferInfo;
 /* Not forward-declaring CopyBufferToImageInfo1D etc right now, I see no need */
 enum class DependencyFlag: UnsignedInt;
 typedef Containers::EnumSet<DependencyFlag> DependencyFlags;
+class DependencyInfo;
+class DescriptorAllocator;
 class DescriptorPool;
 class DescriptorPoolCreateInfo;
 class DescriptorSet;
@@ -75,6 +78,7 @@ class Extension;
 class ExtensionProperties;
 class Fence;
 class FenceCreateInfo;
+class FramePacer;
 class Framebuffer;
 class FramebufferCreateInfo;
 enum class HandleFlag: UnsignedByte;
@@ -96,6 +100,8 @@ class InstanceExtensionProperties;
 class LayerProperties;
 class Memory;
 class MemoryAllocateInfo;
+class MemoryAllocation;
+class MemoryAllocator;
 class MemoryBarrier;
 class MemoryMapDeleter;
 class MemoryRequirements;
@@ -107,13 +113,26 @@ class Mesh;
 enum class MeshIndexType: Int;
 class MeshLayout;
 enum class MeshPrimitive: Int;
+class ParallelCommandRecorder;
 class Pipeline;
 enum class PipelineBindPoint: Int;
+class PipelineCache;
+class PipelineCacheCreateInfo;
 class PipelineLayout;
 class PipelineLayoutCreateInfo;
 enum class PipelineStage: UnsignedInt;
 typedef Containers::EnumSet<PipelineStage> PipelineStages;
 enum class PixelFormat: Int;
+enum class PresentMode: Int;
+enum class QueryControlFlag: UnsignedInt;
+typedef Containers::EnumSet<QueryControlFlag> QueryControlFlags;
+enum class QueryPipelineStatistic: UnsignedInt;
+typedef Containers::EnumSet<QueryPipelineStatistic> QueryPipelineStatistics;
+class QueryPool;
+class QueryPoolCreateInfo;
+enum class QueryResultFlag: UnsignedInt;
+typedef Containers::EnumSet<QueryResultFlag> QueryResultFlags;
+enum class QueryType: Int;
 class Queue;
 enum class QueueFlag: UnsignedInt;
 typedef Containers::EnumSet<QueueFlag> QueueFlags;
@@ -121,6 +140,7 @@ class RasterizationPipelineCreateInfo;
 class RenderPass;
 class RenderPassBeginInfo;
 class RenderPassCreateInfo;
+class RenderingInfo;
 /* AttachmentDescription, AttachmentReference, SubpassDescription,
    SubpassDependency are useful only to be passed directly to
    RenderPassCreateInfo */
@@ -130,6 +150,9 @@ class SamplerCreateInfo;
 enum class SamplerFilter: Int;
 enum class SamplerMipmap: Int;
 enum class SamplerWrapping: Int;
+class Semaphore;
+class SemaphoreCreateInfo;
+enum class SemaphoreType: Int;
 class Shader;
 class ShaderCreateInfo;
 class ShaderSet;
@@ -142,6 +165,10 @@ typedef Containers::EnumSet<ShaderStage, 0x7FFFFFFF> ShaderStages;
 class SubmitInfo;
 class SubpassBeginInfo;
 class SubpassEndInfo;
+class Surface;
+class Swapchain;
+class SwapchainCreateInfo;
+class UploadBatcher;
 enum class Version: UnsignedInt;
 enum class VertexFormat: Int;
 #endif
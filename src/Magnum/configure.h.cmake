@@ -26,6 +26,9 @@
 */
 
 #cmakedefine MAGNUM_BUILD_DEPRECATED
+#cmakedefine MAGNUM_BUILD_PROFILING
+#cmakedefine MAGNUM_PROFILING_TRACY
+#cmakedefine MAGNUM_PROFILING_ITT
 #cmakedefine MAGNUM_BUILD_STATIC
 #cmakedefine MAGNUM_BUILD_STATIC_UNIQUE_GLOBALS
 #cmakedefine MAGNUM_TARGET_GL
@@ -331,6 +331,26 @@ extern "C" {
 #define VK_KHR_RAY_QUERY_SPEC_VERSION 1
 #define VK_KHR_RAY_QUERY_EXTENSION_NAME "VK_KHR_ray_query"
 
+/* VK_KHR_dynamic_rendering */
+
+#define VK_KHR_DYNAMIC_RENDERING_SPEC_VERSION 1
+#define VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME "VK_KHR_dynamic_rendering"
+
+/* VK_KHR_synchronization2 */
+
+#define VK_KHR_SYNCHRONIZATION_2_SPEC_VERSION 1
+#define VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME "VK_KHR_synchronization2"
+
+/* VK_KHR_surface */
+
+#define VK_KHR_SURFACE_SPEC_VERSION 25
+#define VK_KHR_SURFACE_EXTENSION_NAME "VK_KHR_surface"
+
+/* VK_KHR_swapchain */
+
+#define VK_KHR_SWAPCHAIN_SPEC_VERSION 70
+#define VK_KHR_SWAPCHAIN_EXTENSION_NAME "VK_KHR_swapchain"
+
 /* Data types */
 
 // DEPRECATED: This define is deprecated. VK_MAKE_API_VERSION should be used instead.
@@ -390,6 +410,7 @@ extern "C" {
 typedef uint32_t VkSampleMask;
 typedef uint32_t VkBool32;
 typedef uint32_t VkFlags;
+typedef uint64_t VkFlags64;
 typedef uint64_t VkDeviceSize;
 typedef uint64_t VkDeviceAddress;
 typedef VkFlags VkFramebufferCreateFlags;
@@ -492,6 +513,12 @@ typedef VkFlags VkDebugUtilsMessengerCreateFlagsEXT;
 typedef VkFlags VkDebugUtilsMessengerCallbackDataFlagsEXT;
 typedef VkFlags VkDescriptorBindingFlags;
 typedef VkFlags VkResolveModeFlags;
+typedef VkFlags VkRenderingFlags;
+typedef VkFlags VkSurfaceTransformFlagsKHR;
+typedef VkFlags VkCompositeAlphaFlagsKHR;
+typedef VkFlags VkSwapchainCreateFlagsKHR;
+typedef VkFlags64 VkPipelineStageFlags2;
+typedef VkFlags64 VkAccessFlags2;
 VK_DEFINE_HANDLE(VkInstance)
 VK_DEFINE_HANDLE(VkPhysicalDevice)
 VK_DEFINE_HANDLE(VkDevice)
@@ -527,6 +554,8 @@ VK_DEFINE_NON_DISPATCHABLE_HANDLE(VkAccelerationStructureKHR)
 VK_DEFINE_NON_DISPATCHABLE_HANDLE(VkDeferredOperationKHR)
 VK_DEFINE_NON_DISPATCHABLE_HANDLE(VkDebugReportCallbackEXT)
 VK_DEFINE_NON_DISPATCHABLE_HANDLE(VkDebugUtilsMessengerEXT)
+VK_DEFINE_NON_DISPATCHABLE_HANDLE(VkSurfaceKHR)
+VK_DEFINE_NON_DISPATCHABLE_HANDLE(VkSwapchainKHR)
 
 typedef enum {
     VK_ATTACHMENT_LOAD_OP_LOAD = 0,
@@ -1107,6 +1136,7 @@ typedef enum {
     VK_IMAGE_LAYOUT_DEPTH_READ_ONLY_OPTIMAL = 1000241001,
     VK_IMAGE_LAYOUT_STENCIL_ATTACHMENT_OPTIMAL = 1000241002,
     VK_IMAGE_LAYOUT_STENCIL_READ_ONLY_OPTIMAL = 1000241003,
+    VK_IMAGE_LAYOUT_PRESENT_SRC_KHR = 1000001002,
     VK_IMAGE_LAYOUT_DEPTH_READ_ONLY_STENCIL_ATTACHMENT_OPTIMAL_KHR = VK_IMAGE_LAYOUT_DEPTH_READ_ONLY_STENCIL_ATTACHMENT_OPTIMAL,
     VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_STENCIL_READ_ONLY_OPTIMAL_KHR = VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_STENCIL_READ_ONLY_OPTIMAL
 } VkImageLayout;
@@ -1334,6 +1364,10 @@ typedef enum {
     VK_ERROR_VALIDATION_FAILED_EXT = -1000011001,
     VK_ERROR_INVALID_OPAQUE_CAPTURE_ADDRESS_KHR = VK_ERROR_INVALID_OPAQUE_CAPTURE_ADDRESS,
     VK_ERROR_FRAGMENTATION_EXT = VK_ERROR_FRAGMENTATION,
+    VK_ERROR_SURFACE_LOST_KHR = -1000000000,
+    VK_ERROR_NATIVE_WINDOW_IN_USE_KHR = -1000000001,
+    VK_SUBOPTIMAL_KHR = 1000001003,
+    VK_ERROR_OUT_OF_DATE_KHR = -1000001004,
     VK_THREAD_IDLE_KHR = 1000268000,
     VK_THREAD_DONE_KHR = 1000268001,
     VK_OPERATION_DEFERRED_KHR = 1000268002,
@@ -1668,7 +1702,19 @@ typedef enum {
     VK_STRUCTURE_TYPE_RAY_TRACING_PIPELINE_CREATE_INFO_KHR = 1000150015,
     VK_STRUCTURE_TYPE_RAY_TRACING_SHADER_GROUP_CREATE_INFO_KHR = 1000150016,
     VK_STRUCTURE_TYPE_RAY_TRACING_PIPELINE_INTERFACE_CREATE_INFO_KHR = 1000150018,
-    VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_RAY_QUERY_FEATURES_KHR = 1000348013
+    VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_RAY_QUERY_FEATURES_KHR = 1000348013,
+    VK_STRUCTURE_TYPE_RENDERING_INFO_KHR = 1000044000,
+    VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR = 1000044001,
+    VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR = 1000044002,
+    VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR = 1000044003,
+    VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO_KHR = 1000044004,
+    VK_STRUCTURE_TYPE_MEMORY_BARRIER_2_KHR = 1000314000,
+    VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2_KHR = 1000314001,
+    VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2_KHR = 1000314002,
+    VK_STRUCTURE_TYPE_DEPENDENCY_INFO_KHR = 1000314003,
+    VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES_KHR = 1000314007,
+    VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR = 1000001000,
+    VK_STRUCTURE_TYPE_PRESENT_INFO_KHR = 1000001001
 } VkStructureType;
 
 typedef enum {
@@ -1796,9 +1842,42 @@ typedef enum {
     VK_OBJECT_TYPE_SAMPLER_YCBCR_CONVERSION_KHR = VK_OBJECT_TYPE_SAMPLER_YCBCR_CONVERSION,
     VK_OBJECT_TYPE_DEBUG_UTILS_MESSENGER_EXT = 1000128000,
     VK_OBJECT_TYPE_DEFERRED_OPERATION_KHR = 1000268000,
-    VK_OBJECT_TYPE_ACCELERATION_STRUCTURE_KHR = 1000150000
+    VK_OBJECT_TYPE_ACCELERATION_STRUCTURE_KHR = 1000150000,
+    VK_OBJECT_TYPE_SURFACE_KHR = 1000000000,
+    VK_OBJECT_TYPE_SWAPCHAIN_KHR = 1000001000
 } VkObjectType;
 
+typedef enum {
+    VK_PRESENT_MODE_IMMEDIATE_KHR = 0,
+    VK_PRESENT_MODE_MAILBOX_KHR = 1,
+    VK_PRESENT_MODE_FIFO_KHR = 2,
+    VK_PRESENT_MODE_FIFO_RELAXED_KHR = 3
+} VkPresentModeKHR;
+
+typedef enum {
+    VK_COLOR_SPACE_SRGB_NONLINEAR_KHR = 0,
+    VK_COLORSPACE_SRGB_NONLINEAR_KHR = VK_COLOR_SPACE_SRGB_NONLINEAR_KHR
+} VkColorSpaceKHR;
+
+typedef enum {
+    VK_SURFACE_TRANSFORM_IDENTITY_BIT_KHR = 1 << 0,
+    VK_SURFACE_TRANSFORM_ROTATE_90_BIT_KHR = 1 << 1,
+    VK_SURFACE_TRANSFORM_ROTATE_180_BIT_KHR = 1 << 2,
+    VK_SURFACE_TRANSFORM_ROTATE_270_BIT_KHR = 1 << 3,
+    VK_SURFACE_TRANSFORM_HORIZONTAL_MIRROR_BIT_KHR = 1 << 4,
+    VK_SURFACE_TRANSFORM_HORIZONTAL_MIRROR_ROTATE_90_BIT_KHR = 1 << 5,
+    VK_SURFACE_TRANSFORM_HORIZONTAL_MIRROR_ROTATE_180_BIT_KHR = 1 << 6,
+    VK_SURFACE_TRANSFORM_HORIZONTAL_MIRROR_ROTATE_270_BIT_KHR = 1 << 7,
+    VK_SURFACE_TRANSFORM_INHERIT_BIT_KHR = 1 << 8
+} VkSurfaceTransformFlagBitsKHR;
+
+typedef enum {
+    VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR = 1 << 0,
+    VK_COMPOSITE_ALPHA_PRE_MULTIPLIED_BIT_KHR = 1 << 1,
+    VK_COMPOSITE_ALPHA_POST_MULTIPLIED_BIT_KHR = 1 << 2,
+    VK_COMPOSITE_ALPHA_INHERIT_BIT_KHR = 1 << 3
+} VkCompositeAlphaFlagBitsKHR;
+
 typedef int VkEventCreateFlagBits;
 
 typedef enum {
@@ -1824,6 +1903,15 @@ typedef enum {
     VK_RESOLVE_MODE_MAX_BIT = 1 << 3
 } VkResolveModeFlagBits;
 
+typedef enum {
+    VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT = 1 << 0,
+    VK_RENDERING_SUSPENDING_BIT = 1 << 1,
+    VK_RENDERING_RESUMING_BIT = 1 << 2,
+    VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT_KHR = VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT,
+    VK_RENDERING_SUSPENDING_BIT_KHR = VK_RENDERING_SUSPENDING_BIT,
+    VK_RENDERING_RESUMING_BIT_KHR = VK_RENDERING_RESUMING_BIT
+} VkRenderingFlagBits;
+
 typedef enum {
     VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT = 1 << 0,
     VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT = 1 << 1,
@@ -5082,6 +5170,172 @@ typedef struct VkAccelerationStructureBuildSizesInfoKHR {
     VkDeviceSize                       buildScratchSize;
 } VkAccelerationStructureBuildSizesInfoKHR;
 
+typedef struct VkRenderingAttachmentInfo {
+    VkStructureType sType;
+    const void*        pNext;
+    VkImageView                      imageView;
+    VkImageLayout                    imageLayout;
+    VkResolveModeFlagBits            resolveMode;
+    VkImageView                      resolveImageView;
+    VkImageLayout                    resolveImageLayout;
+    VkAttachmentLoadOp               loadOp;
+    VkAttachmentStoreOp              storeOp;
+    VkClearValue                     clearValue;
+} VkRenderingAttachmentInfo;
+
+typedef VkRenderingAttachmentInfo VkRenderingAttachmentInfoKHR;
+
+typedef struct VkRenderingInfo {
+    VkStructureType sType;
+    const void*                                                     pNext;
+    VkRenderingFlags                                                flags;
+    VkRect2D                                                        renderArea;
+    uint32_t                                                        layerCount;
+    uint32_t                                                        viewMask;
+    uint32_t                                                        colorAttachmentCount;
+    const VkRenderingAttachmentInfo*    pColorAttachments;
+    const VkRenderingAttachmentInfo*                                pDepthAttachment;
+    const VkRenderingAttachmentInfo*                                pStencilAttachment;
+} VkRenderingInfo;
+
+typedef VkRenderingInfo VkRenderingInfoKHR;
+
+typedef struct VkPipelineRenderingCreateInfo {
+    VkStructureType sType;
+    const void*                                                pNext;
+    uint32_t                                                   viewMask;
+    uint32_t                                                   colorAttachmentCount;
+    const VkFormat*    pColorAttachmentFormats;
+    VkFormat                                                   depthAttachmentFormat;
+    VkFormat                                                   stencilAttachmentFormat;
+} VkPipelineRenderingCreateInfo;
+
+typedef VkPipelineRenderingCreateInfo VkPipelineRenderingCreateInfoKHR;
+
+typedef struct VkPhysicalDeviceDynamicRenderingFeatures {
+    VkStructureType sType;
+    void*                                    pNext;
+    VkBool32                                 dynamicRendering;
+} VkPhysicalDeviceDynamicRenderingFeatures;
+
+typedef VkPhysicalDeviceDynamicRenderingFeatures VkPhysicalDeviceDynamicRenderingFeaturesKHR;
+
+typedef struct VkMemoryBarrier2 {
+    VkStructureType sType;
+    const void*                    pNext;
+    VkPipelineStageFlags2  srcStageMask;
+    VkAccessFlags2         srcAccessMask;
+    VkPipelineStageFlags2  dstStageMask;
+    VkAccessFlags2         dstAccessMask;
+} VkMemoryBarrier2;
+
+typedef VkMemoryBarrier2 VkMemoryBarrier2KHR;
+
+typedef struct VkBufferMemoryBarrier2 {
+    VkStructureType sType;
+    const void*                    pNext;
+    VkPipelineStageFlags2  srcStageMask;
+    VkAccessFlags2         srcAccessMask;
+    VkPipelineStageFlags2  dstStageMask;
+    VkAccessFlags2         dstAccessMask;
+    uint32_t                       srcQueueFamilyIndex;
+    uint32_t                       dstQueueFamilyIndex;
+    VkBuffer                       buffer;
+    VkDeviceSize                   offset;
+    VkDeviceSize                   size;
+} VkBufferMemoryBarrier2;
+
+typedef VkBufferMemoryBarrier2 VkBufferMemoryBarrier2KHR;
+
+typedef struct VkImageMemoryBarrier2 {
+    VkStructureType sType;
+    const void*                    pNext;
+    VkPipelineStageFlags2  srcStageMask;
+    VkAccessFlags2         srcAccessMask;
+    VkPipelineStageFlags2  dstStageMask;
+    VkAccessFlags2         dstAccessMask;
+    VkImageLayout                  oldLayout;
+    VkImageLayout                  newLayout;
+    uint32_t                       srcQueueFamilyIndex;
+    uint32_t                       dstQueueFamilyIndex;
+    VkImage                        image;
+    VkImageSubresourceRange        subresourceRange;
+} VkImageMemoryBarrier2;
+
+typedef VkImageMemoryBarrier2 VkImageMemoryBarrier2KHR;
+
+typedef struct VkDependencyInfo {
+    VkStructureType sType;
+    const void*                                      pNext;
+    VkDependencyFlags                                dependencyFlags;
+    uint32_t                                         memoryBarrierCount;
+    const VkMemoryBarrier2*            pMemoryBarriers;
+    uint32_t                                         bufferMemoryBarrierCount;
+    const VkBufferMemoryBarrier2*      pBufferMemoryBarriers;
+    uint32_t                                         imageMemoryBarrierCount;
+    const VkImageMemoryBarrier2*        pImageMemoryBarriers;
+} VkDependencyInfo;
+
+typedef VkDependencyInfo VkDependencyInfoKHR;
+
+typedef struct VkPhysicalDeviceSynchronization2Features {
+    VkStructureType sType;
+    void*        pNext;
+    VkBool32                           synchronization2;
+} VkPhysicalDeviceSynchronization2Features;
+
+typedef VkPhysicalDeviceSynchronization2Features VkPhysicalDeviceSynchronization2FeaturesKHR;
+
+typedef struct VkSurfaceCapabilitiesKHR {
+    uint32_t                         minImageCount;
+    uint32_t                         maxImageCount;
+    VkExtent2D                       currentExtent;
+    VkExtent2D                       minImageExtent;
+    VkExtent2D                       maxImageExtent;
+    uint32_t                         maxImageArrayLayers;
+    VkSurfaceTransformFlagsKHR       supportedTransforms;
+    VkSurfaceTransformFlagBitsKHR    currentTransform;
+    VkCompositeAlphaFlagsKHR         supportedCompositeAlpha;
+    VkImageUsageFlags                supportedUsageFlags;
+} VkSurfaceCapabilitiesKHR;
+
+typedef struct VkSurfaceFormatKHR {
+    VkFormat                         format;
+    VkColorSpaceKHR                  colorSpace;
+} VkSurfaceFormatKHR;
+
+typedef struct VkSwapchainCreateInfoKHR {
+    VkStructureType sType;
+    const void*                      pNext;
+    VkSwapchainCreateFlagsKHR        flags;
+    VkSurfaceKHR                     surface;
+    uint32_t                         minImageCount;
+    VkFormat                         imageFormat;
+    VkColorSpaceKHR                  imageColorSpace;
+    VkExtent2D                       imageExtent;
+    uint32_t                         imageArrayLayers;
+    VkImageUsageFlags                imageUsage;
+    VkSharingMode                    imageSharingMode;
+    uint32_t                         queueFamilyIndexCount;
+    const uint32_t*                  pQueueFamilyIndices;
+    VkSurfaceTransformFlagBitsKHR    preTransform;
+    VkCompositeAlphaFlagBitsKHR      compositeAlpha;
+    VkPresentModeKHR                 presentMode;
+    VkBool32                         clipped;
+    VkSwapchainKHR                   oldSwapchain;
+} VkSwapchainCreateInfoKHR;
+
+typedef struct VkPresentInfoKHR {
+    VkStructureType sType;
+    const void*                      pNext;
+    uint32_t                         waitSemaphoreCount;
+    const VkSemaphore*               pWaitSemaphores;
+    uint32_t                         swapchainCount;
+    const VkSwapchainKHR*            pSwapchains;
+    const uint32_t*                  pImageIndices;
+    VkResult*                        pResults;
+} VkPresentInfoKHR;
+
 /* I'll bite the bullet and expect that vkCreateInstance(),
    vkEnumerateInstanceExtensionProperties() and vkEnumerateInstanceLayerProperties()
    functions can be loaded statically to avoid the need for a global
@@ -5153,6 +5407,9 @@ struct FlextVkInstance {
     /* VK_KHR_draw_indirect_count */
 
 
+    /* VK_KHR_dynamic_rendering */
+
+
     /* VK_KHR_external_fence_capabilities */
 
     void    (VKAPI_PTR *GetPhysicalDeviceExternalFencePropertiesKHR)(VkPhysicalDevice, const VkPhysicalDeviceExternalFenceInfo*, VkExternalFenceProperties*);
@@ -5190,6 +5447,20 @@ struct FlextVkInstance {
     /* VK_KHR_sampler_ycbcr_conversion */
 
 
+    /* VK_KHR_surface */
+
+    void    (VKAPI_PTR *DestroySurfaceKHR)(VkInstance, VkSurfaceKHR, const VkAllocationCallbacks*);
+    VkResult    (VKAPI_PTR *GetPhysicalDeviceSurfaceCapabilitiesKHR)(VkPhysicalDevice, VkSurfaceKHR, VkSurfaceCapabilitiesKHR*);
+    VkResult    (VKAPI_PTR *GetPhysicalDeviceSurfaceFormatsKHR)(VkPhysicalDevice, VkSurfaceKHR, uint32_t*, VkSurfaceFormatKHR*);
+    VkResult    (VKAPI_PTR *GetPhysicalDeviceSurfacePresentModesKHR)(VkPhysicalDevice, VkSurfaceKHR, uint32_t*, VkPresentModeKHR*);
+    VkResult    (VKAPI_PTR *GetPhysicalDeviceSurfaceSupportKHR)(VkPhysicalDevice, uint32_t, VkSurfaceKHR, VkBool32*);
+
+    /* VK_KHR_swapchain */
+
+
+    /* VK_KHR_synchronization2 */
+
+
     /* VK_KHR_timeline_semaphore */
 
 
@@ -5347,6 +5618,11 @@ struct FlextVkDevice {
     void    (VKAPI_PTR *CmdDrawIndexedIndirectCountKHR)(VkCommandBuffer, VkBuffer, VkDeviceSize, VkBuffer, VkDeviceSize, uint32_t, uint32_t);
     void    (VKAPI_PTR *CmdDrawIndirectCountKHR)(VkCommandBuffer, VkBuffer, VkDeviceSize, VkBuffer, VkDeviceSize, uint32_t, uint32_t);
 
+    /* VK_KHR_dynamic_rendering */
+
+    void    (VKAPI_PTR *CmdBeginRenderingKHR)(VkCommandBuffer, const VkRenderingInfo*);
+    void    (VKAPI_PTR *CmdEndRenderingKHR)(VkCommandBuffer);
+
     /* VK_KHR_external_fence_capabilities */
 
 
@@ -5388,6 +5664,21 @@ struct FlextVkDevice {
     VkResult    (VKAPI_PTR *CreateSamplerYcbcrConversionKHR)(VkDevice, const VkSamplerYcbcrConversionCreateInfo*, const VkAllocationCallbacks*, VkSamplerYcbcrConversion*);
     void    (VKAPI_PTR *DestroySamplerYcbcrConversionKHR)(VkDevice, VkSamplerYcbcrConversion, const VkAllocationCallbacks*);
 
+    /* VK_KHR_surface */
+
+
+    /* VK_KHR_swapchain */
+
+    VkResult    (VKAPI_PTR *AcquireNextImageKHR)(VkDevice, VkSwapchainKHR, uint64_t, VkSemaphore, VkFence, uint32_t*);
+    VkResult    (VKAPI_PTR *CreateSwapchainKHR)(VkDevice, const VkSwapchainCreateInfoKHR*, const VkAllocationCallbacks*, VkSwapchainKHR*);
+    void    (VKAPI_PTR *DestroySwapchainKHR)(VkDevice, VkSwapchainKHR, const VkAllocationCallbacks*);
+    VkResult    (VKAPI_PTR *GetSwapchainImagesKHR)(VkDevice, VkSwapchainKHR, uint32_t*, VkImage*);
+    VkResult    (VKAPI_PTR *QueuePresentKHR)(VkQueue, const VkPresentInfoKHR*);
+
+    /* VK_KHR_synchronization2 */
+
+    void    (VKAPI_PTR *CmdPipelineBarrier2KHR)(VkCommandBuffer, const VkDependencyInfo*);
+
     /* VK_KHR_timeline_semaphore */
 
     VkResult    (VKAPI_PTR *GetSemaphoreCounterValueKHR)(VkDevice, VkSemaphore, uint64_t*);
@@ -88,6 +88,9 @@ extern FLEXTVK_EXPORT FlextVkInstance flextVkInstance;
 /* VK_KHR_draw_indirect_count */
 
 
+/* VK_KHR_dynamic_rendering */
+
+
 /* VK_KHR_external_fence_capabilities */
 
 #define vkGetPhysicalDeviceExternalFencePropertiesKHR flextVkInstance.GetPhysicalDeviceExternalFencePropertiesKHR
@@ -125,6 +128,20 @@ extern FLEXTVK_EXPORT FlextVkInstance flextVkInstance;
 /* VK_KHR_sampler_ycbcr_conversion */
 
 
+/* VK_KHR_surface */
+
+#define vkDestroySurfaceKHR flextVkInstance.DestroySurfaceKHR
+#define vkGetPhysicalDeviceSurfaceCapabilitiesKHR flextVkInstance.GetPhysicalDeviceSurfaceCapabilitiesKHR
+#define vkGetPhysicalDeviceSurfaceFormatsKHR flextVkInstance.GetPhysicalDeviceSurfaceFormatsKHR
+#define vkGetPhysicalDeviceSurfacePresentModesKHR flextVkInstance.GetPhysicalDeviceSurfacePresentModesKHR
+#define vkGetPhysicalDeviceSurfaceSupportKHR flextVkInstance.GetPhysicalDeviceSurfaceSupportKHR
+
+/* VK_KHR_swapchain */
+
+
+/* VK_KHR_synchronization2 */
+
+
 /* VK_KHR_timeline_semaphore */
 
 
@@ -278,6 +295,11 @@ extern FLEXTVK_EXPORT FlextVkDevice flextVkDevice;
 #define vkCmdDrawIndexedIndirectCountKHR flextVkDevice.CmdDrawIndexedIndirectCountKHR
 #define vkCmdDrawIndirectCountKHR flextVkDevice.CmdDrawIndirectCountKHR
 
+/* VK_KHR_dynamic_rendering */
+
+#define vkCmdBeginRenderingKHR flextVkDevice.CmdBeginRenderingKHR
+#define vkCmdEndRenderingKHR flextVkDevice.CmdEndRenderingKHR
+
 /* VK_KHR_external_fence_capabilities */
 
 
@@ -319,6 +341,21 @@ extern FLEXTVK_EXPORT FlextVkDevice flextVkDevice;
 #define vkCreateSamplerYcbcrConversionKHR flextVkDevice.CreateSamplerYcbcrConversionKHR
 #define vkDestroySamplerYcbcrConversionKHR flextVkDevice.DestroySamplerYcbcrConversionKHR
 
+/* VK_KHR_surface */
+
+
+/* VK_KHR_swapchain */
+
+#define vkAcquireNextImageKHR flextVkDevice.AcquireNextImageKHR
+#define vkCreateSwapchainKHR flextVkDevice.CreateSwapchainKHR
+#define vkDestroySwapchainKHR flextVkDevice.DestroySwapchainKHR
+#define vkGetSwapchainImagesKHR flextVkDevice.GetSwapchainImagesKHR
+#define vkQueuePresentKHR flextVkDevice.QueuePresentKHR
+
+/* VK_KHR_synchronization2 */
+
+#define vkCmdPipelineBarrier2KHR flextVkDevice.CmdPipelineBarrier2KHR
+
 /* VK_KHR_timeline_semaphore */
 
 #define vkGetSemaphoreCounterValueKHR flextVkDevice.GetSemaphoreCounterValueKHR
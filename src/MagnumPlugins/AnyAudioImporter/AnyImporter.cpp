@@ -104,7 +104,13 @@ UnsignedInt AnyImporter::doFrequency() const { return _in->frequency(); }
 
 Containers::Array<char> AnyImporter::doData() { return _in->data(); }
 
+std::size_t AnyImporter::doDataChunk(const Containers::ArrayView<char> destination) { return _in->dataChunk(destination); }
+
+void AnyImporter::doSeekData(const std::size_t frame) { _in->seekData(frame); }
+
+Containers::Optional<Containers::ArrayView<const char>> AnyImporter::doDataView() { return _in->dataView(); }
+
 }}
 
 CORRADE_PLUGIN_REGISTER(AnyAudioImporter, Magnum::Audio::AnyImporter,
-    "cz.mosra.magnum.Audio.AbstractImporter/0.1")
+    "cz.mosra.magnum.Audio.AbstractImporter/0.2")
@@ -131,6 +131,9 @@ class MAGNUM_ANYAUDIOIMPORTER_EXPORT AnyImporter: public AbstractImporter {
         MAGNUM_ANYAUDIOIMPORTER_LOCAL BufferFormat doFormat() const override;
         MAGNUM_ANYAUDIOIMPORTER_LOCAL UnsignedInt doFrequency() const override;
         MAGNUM_ANYAUDIOIMPORTER_LOCAL Containers::Array<char> doData() override;
+        MAGNUM_ANYAUDIOIMPORTER_LOCAL std::size_t doDataChunk(Containers::ArrayView<char> destination) override;
+        MAGNUM_ANYAUDIOIMPORTER_LOCAL void doSeekData(std::size_t frame) override;
+        MAGNUM_ANYAUDIOIMPORTER_LOCAL Containers::Optional<Containers::ArrayView<const char>> doDataView() override;
 
         Containers::Pointer<AbstractImporter> _in;
 };
@@ -25,6 +25,7 @@
 
 #include <sstream>
 #include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
 #include <Corrade/PluginManager/Manager.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/Utility/ConfigurationGroup.h>
@@ -108,6 +109,20 @@ void AnyImporterTest::load() {
     CORRADE_COMPARE(importer->frequency(), 96000);
     CORRADE_COMPARE(importer->data().size(), 4);
 
+    /* Chunked decoding is delegated as well, the destination gets rounded
+       down to whole sample frames */
+    char chunk[3];
+    CORRADE_COMPARE(importer->dataChunk(chunk), 2);
+    CORRADE_COMPARE(importer->dataChunk(chunk), 2);
+    CORRADE_COMPARE(importer->dataChunk(chunk), 0);
+    importer->seekData(1);
+    CORRADE_COMPARE(importer->dataChunk(chunk), 2);
+
+    /* Data view as well */
+    Containers::Optional<Containers::ArrayView<const char>> view = importer->dataView();
+    CORRADE_VERIFY(view);
+    CORRADE_COMPARE(view->size(), 4);
+
     importer->close();
     CORRADE_VERIFY(!importer->isOpened());
 }
@@ -26,6 +26,7 @@
 
 #include "AnyImageImporter.h"
 
+#include <algorithm>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/StringView.h>
 #include <Corrade/PluginManager/Manager.h>
@@ -59,6 +60,65 @@ bool AnyImageImporter::doIsOpened() const { return !!_in; }
 
 void AnyImageImporter::doClose() {
     _in = nullptr;
+    _data = nullptr;
+}
+
+namespace {
+
+struct ExtensionPlugin {
+    Containers::StringView extension;
+    Containers::StringView plugin;
+};
+
+/* Sorted by the extension for a binary search in pluginForExtension(), keep it
+   that way when adding new entries */
+constexpr ExtensionPlugin ExtensionPlugins[]{
+    {".astc"_s, "AstcImporter"_s},
+    {".basis"_s, "BasisImporter"_s},
+    {".bmp"_s, "BmpImporter"_s},
+    {".bw"_s, "SgiImporter"_s},
+    {".cur"_s, "IcoImporter"_s},
+    {".dds"_s, "DdsImporter"_s},
+    {".exr"_s, "OpenExrImporter"_s},
+    {".gif"_s, "GifImporter"_s},
+    {".hdr"_s, "HdrImporter"_s},
+    {".icb"_s, "TgaImporter"_s},
+    {".ico"_s, "IcoImporter"_s},
+    {".jp2"_s, "Jpeg2000Importer"_s},
+    {".jpe"_s, "JpegImporter"_s},
+    {".jpeg"_s, "JpegImporter"_s},
+    {".jpg"_s, "JpegImporter"_s},
+    {".ktx2"_s, "KtxImporter"_s},
+    {".mng"_s, "MngImporter"_s},
+    {".pbm"_s, "PbmImporter"_s},
+    {".pcx"_s, "PcxImporter"_s},
+    {".pgm"_s, "PgmImporter"_s},
+    {".pic"_s, "PicImporter"_s},
+    {".png"_s, "PngImporter"_s},
+    {".pnm"_s, "PnmImporter"_s},
+    {".ppm"_s, "PpmImporter"_s},
+    {".psd"_s, "PsdImporter"_s},
+    {".rgb"_s, "SgiImporter"_s},
+    {".rgba"_s, "SgiImporter"_s},
+    {".sgi"_s, "SgiImporter"_s},
+    {".tga"_s, "TgaImporter"_s},
+    {".tif"_s, "TiffImporter"_s},
+    {".tiff"_s, "TiffImporter"_s},
+    {".vda"_s, "TgaImporter"_s},
+    {".vdb"_s, "OpenVdbImporter"_s},
+    {".vst"_s, "TgaImporter"_s},
+    {".webp"_s, "WebPImporter"_s},
+};
+
+Containers::StringView pluginForExtension(const Containers::StringView extension) {
+    const ExtensionPlugin* const found = std::lower_bound(std::begin(ExtensionPlugins), std::end(ExtensionPlugins), extension, [](const ExtensionPlugin& a, const Containers::StringView b) {
+        return a.extension < b;
+    });
+    if(found == std::end(ExtensionPlugins) || found->extension != extension)
+        return {};
+    return found->plugin;
+}
+
 }
 
 void AnyImageImporter::doOpenFile(const Containers::StringView filename) {
@@ -70,68 +130,8 @@ void AnyImageImporter::doOpenFile(const Containers::StringView filename) {
     const Containers::String normalizedExtension = Utility::String::lowercase(Utility::Path::splitExtension(filename).second());
 
     /* Detect the plugin from extension */
-    Containers::StringView plugin;
-    if(normalizedExtension == ".astc"_s)
-        plugin = "AstcImporter"_s;
-    else if(normalizedExtension == ".basis"_s)
-        plugin = "BasisImporter"_s;
-    else if(normalizedExtension == ".bmp"_s)
-        plugin = "BmpImporter"_s;
-    else if(normalizedExtension == ".dds"_s)
-        plugin = "DdsImporter"_s;
-    else if(normalizedExtension == ".exr"_s)
-        plugin = "OpenExrImporter"_s;
-    else if(normalizedExtension == ".gif"_s)
-        plugin = "GifImporter"_s;
-    else if(normalizedExtension == ".hdr"_s)
-        plugin = "HdrImporter"_s;
-    else if(normalizedExtension == ".ico"_s ||
-            normalizedExtension == ".cur"_s)
-        plugin = "IcoImporter"_s;
-    else if(normalizedExtension == ".jpg"_s ||
-            normalizedExtension == ".jpeg"_s ||
-            normalizedExtension == ".jpe"_s)
-        plugin = "JpegImporter"_s;
-    else if(normalizedExtension == ".jp2"_s)
-        plugin = "Jpeg2000Importer"_s;
-    else if(normalizedExtension == ".ktx2"_s)
-        plugin = "KtxImporter"_s;
-    else if(normalizedExtension == ".mng"_s)
-        plugin = "MngImporter"_s;
-    else if(normalizedExtension == ".pbm"_s)
-        plugin = "PbmImporter"_s;
-    else if(normalizedExtension == ".pcx"_s)
-        plugin = "PcxImporter"_s;
-    else if(normalizedExtension == ".pgm"_s)
-        plugin = "PgmImporter"_s;
-    else if(normalizedExtension == ".pic"_s)
-        plugin = "PicImporter"_s;
-    else if(normalizedExtension == ".pnm"_s)
-        plugin = "PnmImporter"_s;
-    else if(normalizedExtension == ".png"_s)
-        plugin = "PngImporter"_s;
-    else if(normalizedExtension == ".ppm"_s)
-        plugin = "PpmImporter"_s;
-    else if(normalizedExtension == ".psd"_s)
-        plugin = "PsdImporter"_s;
-    else if(normalizedExtension == ".sgi"_s ||
-            normalizedExtension == ".bw"_s ||
-            normalizedExtension == ".rgb"_s ||
-            normalizedExtension == ".rgba"_s)
-        plugin = "SgiImporter"_s;
-    else if(normalizedExtension == ".tif"_s ||
-            normalizedExtension == ".tiff"_s)
-        plugin = "TiffImporter"_s;
-    else if(normalizedExtension == ".tga"_s ||
-            normalizedExtension == ".vda"_s ||
-            normalizedExtension == ".icb"_s ||
-            normalizedExtension == ".vst"_s)
-        plugin = "TgaImporter"_s;
-    else if(normalizedExtension == ".vdb"_s)
-        plugin = "OpenVdbImporter"_s;
-    else if(normalizedExtension == ".webp"_s)
-        plugin = "WebPImporter"_s;
-    else {
+    const Containers::StringView plugin = pluginForExtension(normalizedExtension);
+    if(plugin.isEmpty()) {
         Error{} << "Trade::AnyImageImporter::openFile(): cannot determine the format of" << filename;
         return;
     }
@@ -167,7 +167,7 @@ void AnyImageImporter::doOpenFile(const Containers::StringView filename) {
     _in = std::move(importer);
 }
 
-void AnyImageImporter::doOpenData(Containers::Array<char>&& data, DataFlags) {
+void AnyImageImporter::doOpenData(Containers::Array<char>&& data, const DataFlags dataFlags) {
     using namespace Containers::Literals;
 
     CORRADE_INTERNAL_ASSERT(manager());
@@ -277,9 +277,15 @@ void AnyImageImporter::doOpenData(Containers::Array<char>&& data, DataFlags) {
     /* Propagate configuration */
     Magnum::Implementation::propagateConfiguration("Trade::AnyImageImporter::openData():", {}, metadata->name(), configuration(), importer->configuration());
 
-    /* Try to open the file (error output should be printed by the plugin
-       itself) */
-    if(!importer->openData(data)) return;
+    /* If the data are owned by us or guaranteed to stay in scope, pass them
+       as memory so the concrete importer doesn't need to make its own copy.
+       Owned data are kept around for as long as the importer is. Otherwise
+       the data are temporary and the importer has to copy them if it needs
+       to. Error output should be printed by the plugin itself. */
+    if(dataFlags & (DataFlag::Owned|DataFlag::ExternallyOwned)) {
+        if(!importer->openMemory(data)) return;
+        if(dataFlags & DataFlag::Owned) _data = std::move(data);
+    } else if(!importer->openData(data)) return;
 
     /* Success, save the instance */
     _in = std::move(importer);
@@ -306,4 +312,4 @@ Containers::Optional<ImageData3D> AnyImageImporter::doImage3D(const UnsignedInt
 }}
 
 CORRADE_PLUGIN_REGISTER(AnyImageImporter, Magnum::Trade::AnyImageImporter,
-    "cz.mosra.magnum.Trade.AbstractImporter/0.5")
+    "cz.mosra.magnum.Trade.AbstractImporter/0.5.1")
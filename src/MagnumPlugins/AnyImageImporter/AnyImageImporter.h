@@ -29,6 +29,8 @@
  * @brief Class @ref Magnum::Trade::AnyImageImporter
  */
 
+#include <Corrade/Containers/Array.h>
+
 #include "Magnum/Trade/AbstractImporter.h"
 #include "MagnumPlugins/AnyImageImporter/configure.h"
 
@@ -104,9 +106,11 @@ Supported formats:
 -   WebP (`*.webp` or data with corresponding signature), loaded with
     @ref WebPImporter or any other plugin that provides it
 
-Detecting file type through @ref openData() is supported only for a subset of
-formats that are marked as such in the list above.
-@ref ImporterFeature::FileCallback is supported as well.
+Detecting file type through @ref openData() / @ref openMemory() is supported
+only for a subset of formats that are marked as such in the list above.
+@ref ImporterFeature::FileCallback is supported as well. Data passed through
+@ref openMemory() are handed over to the concrete plugin without a copy, while
+@ref openData() lets the concrete plugin copy the data if it needs to.
 
 @section Trade-AnyImageImporter-usage Usage
 
@@ -201,6 +205,9 @@ class MAGNUM_ANYIMAGEIMPORTER_EXPORT AnyImageImporter: public AbstractImporter {
         MAGNUM_ANYIMAGEIMPORTER_LOCAL Containers::Optional<ImageData3D> doImage3D(UnsignedInt id, UnsignedInt level) override;
 
         Containers::Pointer<AbstractImporter> _in;
+        /* Data passed to openData() with DataFlag::Owned, kept alive for the
+           lifetime of _in */
+        Containers::Array<char> _data;
 };
 
 }}
@@ -25,14 +25,20 @@
 
 #include "AnySceneImporter.h"
 
+#include <algorithm>
+#include <cstring>
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StringView.h>
 #include <Corrade/PluginManager/Manager.h>
 #include <Corrade/PluginManager/PluginMetadata.h>
 #include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/DebugStl.h> /* for PluginMetadata::name() */
+#include <Corrade/Utility/Endianness.h>
+#include <Corrade/Utility/Format.h>
 #include <Corrade/Utility/Path.h>
 #include <Corrade/Utility/String.h>
 
+#include "Magnum/Math/Functions.h"
 #include "Magnum/Trade/AnimationData.h"
 #include "Magnum/Trade/CameraData.h"
 #include "Magnum/Trade/ImageData.h"
@@ -65,109 +71,179 @@ AnySceneImporter::AnySceneImporter(PluginManager::AbstractManager& manager, cons
 AnySceneImporter::~AnySceneImporter() = default;
 
 ImporterFeatures AnySceneImporter::doFeatures() const {
-    return ImporterFeature::FileCallback;
+    return ImporterFeature::OpenData|ImporterFeature::FileCallback;
 }
 
 bool AnySceneImporter::doIsOpened() const { return !!_in; }
 
 void AnySceneImporter::doClose() {
     _in = nullptr;
+    _data = nullptr;
 }
 
-void AnySceneImporter::doOpenFile(const Containers::StringView filename) {
-    CORRADE_INTERNAL_ASSERT(manager());
-
-    /* We don't detect any double extensions yet, so we can normalize just the
-       extension. In case we eventually might, it'd have to be split() instead
-       to save at least by normalizing just the filename and not the path. */
-    const Containers::String normalizedExtension = Utility::String::lowercase(Utility::Path::splitExtension(filename).second());
+namespace {
 
-    /* Detect the plugin from extension */
+struct ExtensionPlugin {
+    Containers::StringView extension;
     Containers::StringView plugin;
-    if(normalizedExtension == ".3ds"_s ||
-       normalizedExtension == ".ase"_s)
-        plugin = "3dsImporter"_s;
-    else if(normalizedExtension == ".3mf"_s)
-        plugin = "3mfImporter"_s;
-    else if(normalizedExtension == ".ac"_s)
-        plugin = "Ac3dImporter"_s;
-    else if(normalizedExtension == ".blend"_s)
-        plugin = "BlenderImporter"_s;
-    else if(normalizedExtension == ".bvh"_s)
-        plugin = "BvhImporter"_s;
-    else if(normalizedExtension == ".csm"_s)
-        plugin = "CsmImporter"_s;
-    else if(normalizedExtension == ".dae"_s)
-        plugin = "ColladaImporter"_s;
-    else if(normalizedExtension == ".x"_s)
-        plugin = "DirectXImporter"_s;
-    else if(normalizedExtension == ".dxf"_s)
-        plugin = "DxfImporter"_s;
-    else if(normalizedExtension == ".fbx"_s)
-        plugin = "FbxImporter"_s;
-    else if(normalizedExtension == ".gltf"_s ||
-            normalizedExtension == ".glb"_s)
-        plugin = "GltfImporter"_s;
-    else if(normalizedExtension == ".ifc"_s)
-        plugin = "IfcImporter"_s;
-    else if(normalizedExtension == ".irrmesh"_s ||
-            normalizedExtension == ".irr"_s)
-        plugin = "IrrlichtImporter"_s;
-    else if(normalizedExtension == ".lwo"_s ||
-            normalizedExtension == ".lws"_s)
-        plugin = "LightWaveImporter"_s;
-    else if(normalizedExtension == ".lxo"_s)
-        plugin = "ModoImporter"_s;
-    else if(normalizedExtension == ".ms3d"_s)
-        plugin = "MilkshapeImporter"_s;
-    else if(normalizedExtension == ".obj"_s)
-        plugin = "ObjImporter"_s;
-    else if(normalizedExtension == ".xml"_s)
-        plugin = "OgreImporter"_s;
-    else if(normalizedExtension == ".ogex"_s)
-        plugin = "OpenGexImporter"_s;
-    else if(normalizedExtension == ".ply"_s)
-        plugin = "StanfordImporter"_s;
-    else if(normalizedExtension == ".stl"_s)
-        plugin = "StlImporter"_s;
-    else if(normalizedExtension == ".cob"_s ||
-            normalizedExtension == ".scn"_s)
-        plugin = "TrueSpaceImporter"_s;
-    else if(normalizedExtension == ".3d"_s)
-        plugin = "UnrealImporter"_s;
-    else if(normalizedExtension == ".smd"_s ||
-            normalizedExtension == ".vta"_s)
-        plugin = "ValveImporter"_s;
-    else if(normalizedExtension == ".xgl"_s ||
-            normalizedExtension == ".zgl"_s)
-        plugin = "XglImporter"_s;
-    else {
-        Error{} << "Trade::AnySceneImporter::openFile(): cannot determine the format of" << filename;
-        return;
+};
+
+/* Sorted by the extension for a binary search in pluginForExtension(), keep it
+   that way when adding new entries */
+constexpr ExtensionPlugin ExtensionPlugins[]{
+    {".3d"_s, "UnrealImporter"_s},
+    {".3ds"_s, "3dsImporter"_s},
+    {".3mf"_s, "3mfImporter"_s},
+    {".ac"_s, "Ac3dImporter"_s},
+    {".ase"_s, "3dsImporter"_s},
+    {".blend"_s, "BlenderImporter"_s},
+    {".bvh"_s, "BvhImporter"_s},
+    {".cob"_s, "TrueSpaceImporter"_s},
+    {".csm"_s, "CsmImporter"_s},
+    {".dae"_s, "ColladaImporter"_s},
+    {".dxf"_s, "DxfImporter"_s},
+    {".fbx"_s, "FbxImporter"_s},
+    {".glb"_s, "GltfImporter"_s},
+    {".gltf"_s, "GltfImporter"_s},
+    {".ifc"_s, "IfcImporter"_s},
+    {".irr"_s, "IrrlichtImporter"_s},
+    {".irrmesh"_s, "IrrlichtImporter"_s},
+    {".lwo"_s, "LightWaveImporter"_s},
+    {".lws"_s, "LightWaveImporter"_s},
+    {".lxo"_s, "ModoImporter"_s},
+    {".ms3d"_s, "MilkshapeImporter"_s},
+    {".obj"_s, "ObjImporter"_s},
+    {".ogex"_s, "OpenGexImporter"_s},
+    {".ply"_s, "StanfordImporter"_s},
+    {".scn"_s, "TrueSpaceImporter"_s},
+    {".smd"_s, "ValveImporter"_s},
+    {".stl"_s, "StlImporter"_s},
+    {".vta"_s, "ValveImporter"_s},
+    {".x"_s, "DirectXImporter"_s},
+    {".xgl"_s, "XglImporter"_s},
+    {".xml"_s, "OgreImporter"_s},
+    {".zgl"_s, "XglImporter"_s},
+};
+
+Containers::StringView pluginForExtension(const Containers::StringView extension) {
+    const ExtensionPlugin* const found = std::lower_bound(std::begin(ExtensionPlugins), std::end(ExtensionPlugins), extension, [](const ExtensionPlugin& a, const Containers::StringView b) {
+        return a.extension < b;
+    });
+    if(found == std::end(ExtensionPlugins) || found->extension != extension)
+        return {};
+    return found->plugin;
+}
+
+Containers::StringView pluginForSignature(const Containers::StringView data) {
+    /* https://registry.khronos.org/glTF/specs/2.0/glTF-2.0.html#binary-header */
+    if(data.hasPrefix("glTF"_s))
+        return "GltfImporter"_s;
+    /* https://en.wikipedia.org/wiki/PLY_(file_format)#File_format */
+    if(data.hasPrefix("ply\n"_s) || data.hasPrefix("ply\r\n"_s))
+        return "StanfordImporter"_s;
+    /* https://code.blender.org/2011/11/blender-file-format/ */
+    if(data.hasPrefix("BLENDER"_s))
+        return "BlenderImporter"_s;
+    /* https://code.blender.org/2013/08/fbx-binary-file-format-specification/ */
+    if(data.hasPrefix("Kaydara FBX Binary  \0"_s) || data.hasPrefix("; FBX"_s))
+        return "FbxImporter"_s;
+    /* https://en.wikipedia.org/wiki/STL_(file_format)#Binary_STL -- an
+       80-byte header followed by a triangle count, 50 bytes per triangle.
+       Has to be checked before the ASCII variant as a lot of exporters put
+       "solid" into the binary header as well. */
+    if(data.size() >= 84) {
+        UnsignedInt triangleCount;
+        std::memcpy(&triangleCount, data.data() + 80, 4);
+        Utility::Endianness::littleEndianInPlace(triangleCount);
+        if(data.size() == 84 + std::size_t{triangleCount}*50)
+            return "StlImporter"_s;
+    }
+    if(data.hasPrefix("solid "_s))
+        return "StlImporter"_s;
+    /* https://en.wikipedia.org/wiki/.3ds -- the main chunk ID followed by a
+       32-bit chunk length that spans the whole file */
+    if(data.size() >= 6 && data.hasPrefix("\x4d\x4d"_s)) {
+        UnsignedInt length;
+        std::memcpy(&length, data.data() + 2, 4);
+        Utility::Endianness::littleEndianInPlace(length);
+        if(length == data.size())
+            return "3dsImporter"_s;
     }
 
+    /* Text-based formats, skip a potential UTF-8 BOM and leading whitespace.
+       JSON- and XML-based formats are recognized only by looking at the
+       first kilobyte, which should be enough for any sane file. */
+    Containers::StringView text = data;
+    if(text.hasPrefix("\xef\xbb\xbf"_s)) text = text.exceptPrefix(3);
+    text = text.trimmedPrefix();
+    const Containers::StringView head = text.prefix(Math::min(text.size(), std::size_t{1024}));
+    if(head.hasPrefix('{') && head.contains("\"asset\""_s))
+        return "GltfImporter"_s;
+    if(head.hasPrefix('<') && head.contains("<COLLADA"_s))
+        return "ColladaImporter"_s;
+
+    /* OBJ has no signature at all, so it's a guesswork similar to TGA in
+       AnyImageImporter -- look at the first line that isn't a comment and
+       check that it starts with one of the common keywords */
+    while(text.hasPrefix('#')) {
+        const Containers::StringView newline = text.find('\n');
+        if(!newline) return {};
+        text = text.slice(newline.end(), text.end()).trimmedPrefix();
+    }
+    for(const Containers::StringView keyword: {"v "_s, "vn "_s, "vt "_s, "f "_s, "o "_s, "g "_s, "s "_s, "mtllib "_s, "usemtl "_s})
+        if(text.hasPrefix(keyword)) return "ObjImporter"_s;
+
+    return {};
+}
+
+/* Common for doOpenFile() and doOpenData(). Prints a message and returns a
+   null pointer on failure. */
+Containers::Pointer<AbstractImporter> instantiatePlugin(AbstractImporter& self, const char* const messagePrefix, const Containers::StringView plugin) {
+    CORRADE_INTERNAL_ASSERT(self.manager());
+
     /* Try to load the plugin */
-    if(!(manager()->load(plugin) & PluginManager::LoadState::Loaded)) {
-        Error{} << "Trade::AnySceneImporter::openFile(): cannot load the" << plugin << "plugin";
-        return;
+    if(!(self.manager()->load(plugin) & PluginManager::LoadState::Loaded)) {
+        Error{} << messagePrefix << "cannot load the" << plugin << "plugin";
+        return nullptr;
     }
 
-    const PluginManager::PluginMetadata* const metadata = manager()->metadata(plugin);
+    const PluginManager::PluginMetadata* const metadata = self.manager()->metadata(plugin);
     CORRADE_INTERNAL_ASSERT(metadata);
-    if(flags() & ImporterFlag::Verbose) {
+    if(self.flags() & ImporterFlag::Verbose) {
         Debug d;
-        d << "Trade::AnySceneImporter::openFile(): using" << plugin;
+        d << messagePrefix << "using" << plugin;
         if(plugin != metadata->name())
             d << "(provided by" << metadata->name() << Debug::nospace << ")";
     }
 
     /* Instantiate the plugin, propagate flags and the file callback, if set */
-    Containers::Pointer<AbstractImporter> importer = static_cast<PluginManager::Manager<AbstractImporter>*>(manager())->instantiate(plugin);
-    importer->setFlags(flags());
-    if(fileCallback()) importer->setFileCallback(fileCallback(), fileCallbackUserData());
+    Containers::Pointer<AbstractImporter> importer = static_cast<PluginManager::Manager<AbstractImporter>*>(self.manager())->instantiate(plugin);
+    importer->setFlags(self.flags());
+    if(self.fileCallback()) importer->setFileCallback(self.fileCallback(), self.fileCallbackUserData());
 
     /* Propagate configuration */
-    Magnum::Implementation::propagateConfiguration("Trade::AnySceneImporter::openFile():", {}, metadata->name(), configuration(), importer->configuration());
+    Magnum::Implementation::propagateConfiguration(messagePrefix, {}, metadata->name(), self.configuration(), importer->configuration());
+
+    return importer;
+}
+
+}
+
+void AnySceneImporter::doOpenFile(const Containers::StringView filename) {
+    /* We don't detect any double extensions yet, so we can normalize just the
+       extension. In case we eventually might, it'd have to be split() instead
+       to save at least by normalizing just the filename and not the path. */
+    const Containers::String normalizedExtension = Utility::String::lowercase(Utility::Path::splitExtension(filename).second());
+
+    /* Detect the plugin from extension */
+    const Containers::StringView plugin = pluginForExtension(normalizedExtension);
+    if(plugin.isEmpty()) {
+        Error{} << "Trade::AnySceneImporter::openFile(): cannot determine the format of" << filename;
+        return;
+    }
+
+    Containers::Pointer<AbstractImporter> importer = instantiatePlugin(*this, "Trade::AnySceneImporter::openFile():", plugin);
+    if(!importer) return;
 
     /* Try to open the file (error output should be printed by the plugin
        itself) */
@@ -177,6 +253,47 @@ void AnySceneImporter::doOpenFile(const Containers::StringView filename) {
     _in = std::move(importer);
 }
 
+void AnySceneImporter::doOpenData(Containers::Array<char>&& data, const DataFlags dataFlags) {
+    const Containers::StringView plugin = pluginForSignature(Containers::ArrayView<const char>{data});
+    if(plugin.isEmpty()) {
+        if(data.isEmpty()) {
+            Error{} << "Trade::AnySceneImporter::openData(): file is empty";
+            return;
+        }
+
+        /* FFS so much casting to avoid implicit sign extension ruining
+           everything */
+        UnsignedInt signature = UnsignedInt(UnsignedByte(data[0])) << 24;
+        if(data.size() > 1) signature |= UnsignedInt(UnsignedByte(data[1])) << 16;
+        if(data.size() > 2) signature |= UnsignedInt(UnsignedByte(data[2])) << 8;
+        if(data.size() > 3) signature |= UnsignedInt(UnsignedByte(data[3]));
+        /* If there's less than four bytes, cut the rest away */
+        Error{} << "Trade::AnySceneImporter::openData(): cannot determine the format from signature 0x" << Debug::nospace << Utility::format("{:.8x}", signature).prefix(Math::min(data.size(), std::size_t{4})*2);
+        return;
+    }
+
+    Containers::Pointer<AbstractImporter> importer = instantiatePlugin(*this, "Trade::AnySceneImporter::openData():", plugin);
+    if(!importer) return;
+
+    if(!(importer->features() & ImporterFeature::OpenData)) {
+        Error{} << "Trade::AnySceneImporter::openData():" << plugin << "doesn't support opening data";
+        return;
+    }
+
+    /* If the data are owned by us or guaranteed to stay in scope, pass them
+       as memory so the concrete importer doesn't need to make its own copy.
+       Owned data are kept around for as long as the importer is. Otherwise
+       the data are temporary and the importer has to copy them if it needs
+       to. Error output should be printed by the plugin itself. */
+    if(dataFlags & (DataFlag::Owned|DataFlag::ExternallyOwned)) {
+        if(!importer->openMemory(data)) return;
+        if(dataFlags & DataFlag::Owned) _data = std::move(data);
+    } else if(!importer->openData(data)) return;
+
+    /* Success, save the instance */
+    _in = std::move(importer);
+}
+
 UnsignedInt AnySceneImporter::doAnimationCount() const { return _in->animationCount(); }
 Int AnySceneImporter::doAnimationForName(const Containers::StringView name) { return _in->animationForName(name); }
 Containers::String AnySceneImporter::doAnimationName(const UnsignedInt id) { return _in->animationName(id); }
@@ -298,4 +415,4 @@ Containers::Optional<ImageData3D> AnySceneImporter::doImage3D(const UnsignedInt
 }}
 
 CORRADE_PLUGIN_REGISTER(AnySceneImporter, Magnum::Trade::AnySceneImporter,
-    "cz.mosra.magnum.Trade.AbstractImporter/0.5")
+    "cz.mosra.magnum.Trade.AbstractImporter/0.5.1")
@@ -29,6 +29,8 @@
  * @brief Class @ref Magnum::Trade::AnySceneImporter
  */
 
+#include <Corrade/Containers/Array.h>
+
 #include "Magnum/Trade/AbstractImporter.h"
 #include "MagnumPlugins/AnySceneImporter/configure.h"
 
@@ -53,25 +55,29 @@ namespace Magnum { namespace Trade {
 /**
 @brief Any scene importer plugin
 
-Detects file type based on file extension, loads corresponding plugin and then
-tries to open the file with it. Supported formats:
+Detects file type based on file extension or a signature at the start of the
+file, loads corresponding plugin and then tries to open the file with it.
+Supported formats:
 
--   3ds Max 3DS and ASE (`*.3ds`, `*.ase`), loaded with any plugin that
-    provides `3dsImporter`
+-   3ds Max 3DS and ASE (`*.3ds`, `*.ase` or 3DS data with corresponding
+    signature), loaded with any plugin that provides `3dsImporter`
 -   3D Manufacturing Format (`*.3mf`), loaded with any plugin that provides
     `3mfImporter`
 -   AC3D (`*.ac`), loaded with any plugin that provides `Ac3dImporter`
--   Blender 3D (`*.blend`), loaded with any plugin that provides
-    `BlenderImporter`
+-   Blender 3D (`*.blend` or data with corresponding signature), loaded with
+    any plugin that provides `BlenderImporter`
 -   Biovision BVH (`*.bvh`), loaded with any plugin that provides `BvhImporter`
 -   CharacterStudio Motion (`*.csm`), loaded with any plugin that provides
     `CsmImporter`
--   COLLADA (`*.dae`), loaded with any plugin that provides `ColladaImporter`
+-   COLLADA (`*.dae` or data with a `<COLLADA` element), loaded with any
+    plugin that provides `ColladaImporter`
 -   DirectX X (`*.x`), loaded with any plugin that provides `DirectXImporter`
 -   AutoCAD DXF (`*.dxf`), loaded with any plugin that provides `DxfImporter`
--   Autodesk FBX (`*.fbx`), loaded with any plugin that provides `FbxImporter`
--   glTF (`*.gltf`, `*.glb`), loaded with @ref GltfImporter or any other plugin
-    that provides it
+-   Autodesk FBX (`*.fbx` or data with corresponding signature), loaded with
+    any plugin that provides `FbxImporter`
+-   glTF (`*.gltf`, `*.glb` or binary data with corresponding signature or
+    JSON data with an `"asset"` property), loaded with @ref GltfImporter or
+    any other plugin that provides it
 -   Industry Foundation Classes (IFC/Step) (`*.ifc`), loaded with any plugin
     that provides `IfcImporter`
 -   Irrlicht Mesh and Scene (`*.irrmesh`, `*.irr`), loaded with any plugin that
@@ -81,15 +87,15 @@ tries to open the file with it. Supported formats:
 -   Modo (`*.lxo`), loaded with any plugin that provides `ModoImporter`
 -   Milkshape 3D (`*.ms3d`), loaded with any plugin that provides
     `MilkshapeImporter`
--   Wavefront OBJ (`*.obj`), loaded with @ref ObjImporter or any other plugin
-    that provides it
+-   Wavefront OBJ (`*.obj` or data starting with a known OBJ keyword), loaded
+    with @ref ObjImporter or any other plugin that provides it
 -   Ogre XML (`*.xml`), loaded with any plugin that provides `OgreImporter`
 -   OpenGEX (`*.ogex`), loaded with @ref OpenGexImporter or any other plugin
     that provides it
--   Stanford (`*.ply`), loaded with @ref StanfordImporter or any other plugin
-    that provides it
--   Stereolitography (`*.stl`), loaded with any plugin that provides
-    `StlImporter`
+-   Stanford (`*.ply` or data with corresponding signature), loaded with
+    @ref StanfordImporter or any other plugin that provides it
+-   Stereolitography (`*.stl` or data with corresponding signature), loaded
+    with any plugin that provides `StlImporter`
 -   TrueSpace (`*.cob`, `*.scn`), loaded with any plugin that provides
     `TrueSpaceImporter`
 -   Unreal (`*.3d`), loaded with any plugin that provides `UnrealImporter`
@@ -97,8 +103,11 @@ tries to open the file with it. Supported formats:
     `ValveImporter`
 -   XGL (`*.xgl`, `*.zgl`), loaded with any plugin that provides `XglImporter`
 
-Only loading from files is supported as the filename is used to detect the
-format, however @ref ImporterFeature::FileCallback is supported as well.
+Detecting file type through @ref openData() / @ref openMemory() is supported
+only for a subset of formats that are marked as such in the list above.
+@ref ImporterFeature::FileCallback is supported as well. Data passed through
+@ref openMemory() are handed over to the concrete plugin without a copy, while
+@ref openData() lets the concrete plugin copy the data if it needs to.
 
 @section Trade-AnySceneImporter-usage Usage
 
@@ -133,12 +142,12 @@ information.
 
 @section Trade-AnySceneImporter-proxy Interface proxying and option propagation
 
-On a call to @ref openFile(), a file format is detected from the extension and
-a corresponding plugin is loaded. After that, flags set via @ref setFlags(),
-file callbacks set via @ref setFileCallback() and options set through
-@ref configuration() are propagated to the concrete implementation. A warning
-is emitted in case an option set is not present in the default configuration of
-the target plugin.
+On a call to @ref openFile() / @ref openData(), a file format is detected from
+the extension / file signature and a corresponding plugin is loaded. After
+that, flags set via @ref setFlags(), file callbacks set via
+@ref setFileCallback() and options set through @ref configuration() are
+propagated to the concrete implementation. A warning is emitted in case an
+option set is not present in the default configuration of the target plugin.
 
 Calls to the @ref animation(), @ref scene(), @ref light(), @ref camera(),
 @ref object2D(), @ref object3D(), @ref skin2D(), @ref skin3D(), @ref mesh(),
@@ -166,6 +175,7 @@ class MAGNUM_ANYSCENEIMPORTER_EXPORT AnySceneImporter: public AbstractImporter {
         MAGNUM_ANYSCENEIMPORTER_LOCAL bool doIsOpened() const override;
         MAGNUM_ANYSCENEIMPORTER_LOCAL void doClose() override;
         MAGNUM_ANYSCENEIMPORTER_LOCAL void doOpenFile(Containers::StringView filename) override;
+        MAGNUM_ANYSCENEIMPORTER_LOCAL void doOpenData(Containers::Array<char>&& data, DataFlags dataFlags) override;
 
         MAGNUM_ANYSCENEIMPORTER_LOCAL UnsignedInt doAnimationCount() const override;
         MAGNUM_ANYSCENEIMPORTER_LOCAL Containers::String doAnimationName(UnsignedInt id) override;
@@ -273,6 +283,9 @@ class MAGNUM_ANYSCENEIMPORTER_EXPORT AnySceneImporter: public AbstractImporter {
         MAGNUM_ANYSCENEIMPORTER_LOCAL Containers::Optional<ImageData3D> doImage3D(UnsignedInt id, UnsignedInt level) override;
 
         Containers::Pointer<AbstractImporter> _in;
+        /* Data passed to openData() with DataFlag::Owned, kept alive for the
+           lifetime of _in */
+        Containers::Array<char> _data;
 };
 
 }}
@@ -57,8 +57,11 @@ struct AnySceneImporterTest: TestSuite::Tester {
     void loadDeprecatedMeshData();
     #endif
     void detect();
+    void detectData();
 
     void unknown();
+    void unknownSignature();
+    void emptyData();
 
     void propagateFlags();
     void propagateConfiguration();
@@ -74,11 +77,20 @@ struct AnySceneImporterTest: TestSuite::Tester {
     PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
 };
 
+enum class Open {
+    File,
+    Data,
+    Memory
+};
+
 const struct {
     const char* name;
     Containers::String filename;
+    Open open;
 } LoadData[]{
-    {"OBJ", Utility::Path::join(OBJIMPORTER_TEST_DIR, "mesh-primitive-points.obj")},
+    {"OBJ", Utility::Path::join(OBJIMPORTER_TEST_DIR, "mesh-primitive-points.obj"), Open::File},
+    {"OBJ data", Utility::Path::join(OBJIMPORTER_TEST_DIR, "mesh-primitive-points.obj"), Open::Data},
+    {"OBJ memory", Utility::Path::join(OBJIMPORTER_TEST_DIR, "mesh-primitive-points.obj"), Open::Memory},
 };
 
 constexpr struct {
@@ -98,6 +110,47 @@ constexpr struct {
     /* Not testing everything, only the most important ones */
 };
 
+using namespace Containers::Literals;
+
+/* 80-byte header, zero triangle count */
+constexpr char StlBinaryEmpty[84]{'s', 'o', 'l', 'i', 'd'};
+/* 3DS main chunk with a length matching the data size */
+constexpr char ThreeDsMainChunk[6]{'\x4d', '\x4d', 6, 0, 0, 0};
+
+const struct {
+    const char* name;
+    Containers::StringView data;
+    const char* plugin;
+} DetectDataData[]{
+    {"3DS", Containers::StringView{ThreeDsMainChunk, sizeof(ThreeDsMainChunk)}, "3dsImporter"},
+    {"Blender", "BLENDER-v300"_s, "BlenderImporter"},
+    {"COLLADA", "<?xml version=\"1.0\"?>\n<COLLADA version=\"1.4.1\">"_s, "ColladaImporter"},
+    {"FBX binary", "Kaydara FBX Binary  \0\x1a\0"_s, "FbxImporter"},
+    {"FBX ASCII", "; FBX 7.4.0 project file"_s, "FbxImporter"},
+    {"glTF binary", "glTF\x02\0\0\0"_s, "GltfImporter"},
+    {"glTF", "  {\n  \"asset\": {\"version\": \"2.0\"}}"_s, "GltfImporter"},
+    {"glTF with a BOM", "\xef\xbb\xbf{\"asset\":{}}"_s, "GltfImporter"},
+    {"OBJ", "v 1 2 3\n"_s, "ObjImporter"},
+    {"OBJ with comments", "# Blender\n\n# more\r\nmtllib a.mtl\n"_s, "ObjImporter"},
+    {"Stanford PLY", "ply\nformat ascii 1.0\n"_s, "StanfordImporter"},
+    {"Stanford PLY CRLF", "ply\r\nformat ascii 1.0\r\n"_s, "StanfordImporter"},
+    {"STL binary", Containers::StringView{StlBinaryEmpty, sizeof(StlBinaryEmpty)}, "StlImporter"},
+    {"STL ASCII", "solid cube\n"_s, "StlImporter"},
+};
+
+const struct {
+    const char* name;
+    Containers::StringView data;
+    const char* signature;
+} DetectUnknownData[]{
+    {"something random", "\x25\x3a\x00\x56 blablabla"_s, "253a0056"},
+    {"just one byte", "\x33"_s, "33"},
+    {"JSON, but not glTF", "{\"version\": 2}"_s, "7b227665"},
+    {"XML, but not COLLADA", "<?xml?><mesh/>"_s, "3c3f786d"},
+    {"3DS, but wrong length", "\x4d\x4d\x07\0\0\0"_s, "4d4d0700"},
+    {"comment-only text", "# nothing here"_s, "23206e6f"},
+};
+
 AnySceneImporterTest::AnySceneImporterTest() {
     addInstancedTests({&AnySceneImporterTest::load},
         Containers::arraySize(LoadData));
@@ -109,7 +162,15 @@ AnySceneImporterTest::AnySceneImporterTest() {
     addInstancedTests({&AnySceneImporterTest::detect},
         Containers::arraySize(DetectData));
 
-    addTests({&AnySceneImporterTest::unknown,
+    addInstancedTests({&AnySceneImporterTest::detectData},
+        Containers::arraySize(DetectDataData));
+
+    addTests({&AnySceneImporterTest::unknown});
+
+    addInstancedTests({&AnySceneImporterTest::unknownSignature},
+        Containers::arraySize(DetectUnknownData));
+
+    addTests({&AnySceneImporterTest::emptyData,
 
               &AnySceneImporterTest::propagateFlags,
               &AnySceneImporterTest::propagateConfiguration,
@@ -140,7 +201,17 @@ void AnySceneImporterTest::load() {
         CORRADE_SKIP("ObjImporter plugin not enabled, cannot test");
 
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("AnySceneImporter");
-    CORRADE_VERIFY(importer->openFile(data.filename));
+    Containers::Optional<Containers::Array<char>> read;
+    if(data.open == Open::File)
+        CORRADE_VERIFY(importer->openFile(data.filename));
+    else {
+        read = Utility::Path::read(data.filename);
+        CORRADE_VERIFY(read);
+        if(data.open == Open::Data)
+            CORRADE_VERIFY(importer->openData(*read));
+        else
+            CORRADE_VERIFY(importer->openMemory(*read));
+    }
 
     /* Check only size, as it is good enough proof that it is working */
     Containers::Optional<MeshData> mesh = importer->mesh(0);
@@ -192,6 +263,30 @@ void AnySceneImporterTest::detect() {
     #endif
 }
 
+void AnySceneImporterTest::detectData() {
+    auto&& data = DetectDataData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("AnySceneImporter");
+
+    /* Skip the test if the plugin is actually present, as then the data
+       would fail to open for an unrelated reason */
+    if(_manager.loadState(data.plugin) != PluginManager::LoadState::NotFound)
+        CORRADE_SKIP(data.plugin << "is present, can't test");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->openData(data.data));
+    /* Can't use raw string literals in macros on GCC 4.8 */
+    #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+    CORRADE_COMPARE(out.str(), Utility::formatString(
+"PluginManager::Manager::load(): plugin {0} is not static and was not found in nonexistent\nTrade::AnySceneImporter::openData(): cannot load the {0} plugin\n", data.plugin));
+    #else
+    CORRADE_COMPARE(out.str(), Utility::formatString(
+"PluginManager::Manager::load(): plugin {0} was not found\nTrade::AnySceneImporter::openData(): cannot load the {0} plugin\n", data.plugin));
+    #endif
+}
+
 void AnySceneImporterTest::unknown() {
     std::ostringstream output;
     Error redirectError{&output};
@@ -202,6 +297,29 @@ void AnySceneImporterTest::unknown() {
     CORRADE_COMPARE(output.str(), "Trade::AnySceneImporter::openFile(): cannot determine the format of mesh.wtf\n");
 }
 
+void AnySceneImporterTest::unknownSignature() {
+    auto&& data = DetectUnknownData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    std::ostringstream output;
+    Error redirectError{&output};
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("AnySceneImporter");
+    CORRADE_VERIFY(!importer->openData(data.data));
+
+    CORRADE_COMPARE(output.str(), Utility::formatString("Trade::AnySceneImporter::openData(): cannot determine the format from signature 0x{}\n", data.signature));
+}
+
+void AnySceneImporterTest::emptyData() {
+    std::ostringstream output;
+    Error redirectError{&output};
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("AnySceneImporter");
+    CORRADE_VERIFY(!importer->openData(nullptr));
+
+    CORRADE_COMPARE(output.str(), "Trade::AnySceneImporter::openData(): file is empty\n");
+}
+
 void AnySceneImporterTest::propagateFlags() {
     PluginManager::Manager<AbstractImporter> manager{MAGNUM_PLUGINS_IMPORTER_INSTALL_DIR};
     #ifdef ANYSCENEIMPORTER_PLUGIN_FILENAME
@@ -0,0 +1,114 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "BlockCompressionImageConverter.h"
+
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/TextureTools/CompressBlocks.h"
+#include "Magnum/Trade/ImageData.h"
+
+namespace Magnum { namespace Trade {
+
+using namespace Containers::Literals;
+
+namespace {
+
+/* Linear and sRGB variant of each format, the same if there's no sRGB
+   variant */
+constexpr struct {
+    Containers::StringView name;
+    CompressedPixelFormat format;
+    CompressedPixelFormat srgbFormat;
+} Formats[]{
+    {"bc1"_s, CompressedPixelFormat::Bc1RGBUnorm, CompressedPixelFormat::Bc1RGBSrgb},
+    {"bc1a"_s, CompressedPixelFormat::Bc1RGBAUnorm, CompressedPixelFormat::Bc1RGBASrgb},
+    {"bc2"_s, CompressedPixelFormat::Bc2RGBAUnorm, CompressedPixelFormat::Bc2RGBASrgb},
+    {"bc3"_s, CompressedPixelFormat::Bc3RGBAUnorm, CompressedPixelFormat::Bc3RGBASrgb},
+    {"bc4"_s, CompressedPixelFormat::Bc4RUnorm, CompressedPixelFormat::Bc4RUnorm},
+    {"bc5"_s, CompressedPixelFormat::Bc5RGUnorm, CompressedPixelFormat::Bc5RGUnorm},
+    {"bc7"_s, CompressedPixelFormat::Bc7RGBAUnorm, CompressedPixelFormat::Bc7RGBASrgb},
+    {"etc2"_s, CompressedPixelFormat::Etc2RGB8Unorm, CompressedPixelFormat::Etc2RGB8Srgb},
+};
+
+}
+
+BlockCompressionImageConverter::BlockCompressionImageConverter(PluginManager::AbstractManager& manager, const Containers::StringView& plugin): AbstractImageConverter{manager, plugin} {}
+
+ImageConverterFeatures BlockCompressionImageConverter::doFeatures() const { return ImageConverterFeature::Convert2D; }
+
+Containers::Optional<ImageData2D> BlockCompressionImageConverter::doConvert(const ImageView2D& image) {
+    const char* defaultFormat;
+    switch(image.format()) {
+        case PixelFormat::R8Unorm:
+        case PixelFormat::R8Srgb:
+            defaultFormat = "bc4";
+            break;
+        case PixelFormat::RG8Unorm:
+        case PixelFormat::RG8Srgb:
+            defaultFormat = "bc5";
+            break;
+        case PixelFormat::RGB8Unorm:
+        case PixelFormat::RGB8Srgb:
+            defaultFormat = "bc1";
+            break;
+        case PixelFormat::RGBA8Unorm:
+        case PixelFormat::RGBA8Srgb:
+            defaultFormat = "bc3";
+            break;
+        default:
+            Error{} << "Trade::BlockCompressionImageConverter::convert(): unsupported format" << image.format();
+            return {};
+    }
+
+    Containers::StringView formatName = configuration().value<Containers::StringView>("format");
+    if(formatName.isEmpty()) formatName = defaultFormat;
+
+    CompressedPixelFormat format{};
+    for(const auto& i: Formats) if(i.name == formatName) {
+        format = isPixelFormatSrgb(image.format()) ? i.srgbFormat : i.format;
+        break;
+    }
+    if(format == CompressedPixelFormat{}) {
+        Error{} << "Trade::BlockCompressionImageConverter::convert(): unrecognized format" << formatName;
+        return {};
+    }
+
+    if(flags() & ImageConverterFlag::Verbose)
+        Debug{} << "Trade::BlockCompressionImageConverter::convert(): compressing" << image.format() << "to" << format;
+
+    CompressedImage2D compressed = TextureTools::compressBlocks(image, format, configuration().value<UnsignedInt>("threads"));
+    return ImageData2D{format, compressed.size(), compressed.release(), image.flags()};
+}
+
+}}
+
+CORRADE_PLUGIN_REGISTER(BlockCompressionImageConverter, Magnum::Trade::BlockCompressionImageConverter,
+    "cz.mosra.magnum.Trade.AbstractImageConverter/0.3.3")
@@ -0,0 +1,140 @@
+#ifndef Magnum_Trade_BlockCompressionImageConverter_h
+#define Magnum_Trade_BlockCompressionImageConverter_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Trade::BlockCompressionImageConverter
+ * @m_since_latest
+ */
+
+#include "Magnum/Trade/AbstractImageConverter.h"
+
+#include "MagnumPlugins/BlockCompressionImageConverter/configure.h"
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+#ifndef MAGNUM_BLOCKCOMPRESSIONIMAGECONVERTER_BUILD_STATIC
+    #if defined(BlockCompressionImageConverter_EXPORTS) || defined(BlockCompressionImageConverterObjects_EXPORTS)
+        #define MAGNUM_BLOCKCOMPRESSIONIMAGECONVERTER_EXPORT CORRADE_VISIBILITY_EXPORT
+    #else
+        #define MAGNUM_BLOCKCOMPRESSIONIMAGECONVERTER_EXPORT CORRADE_VISIBILITY_IMPORT
+    #endif
+#else
+    #define MAGNUM_BLOCKCOMPRESSIONIMAGECONVERTER_EXPORT CORRADE_VISIBILITY_STATIC
+#endif
+#define MAGNUM_BLOCKCOMPRESSIONIMAGECONVERTER_LOCAL CORRADE_VISIBILITY_LOCAL
+#else
+#define MAGNUM_BLOCKCOMPRESSIONIMAGECONVERTER_EXPORT
+#define MAGNUM_BLOCKCOMPRESSIONIMAGECONVERTER_LOCAL
+#endif
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Block compression image converter plugin
+@m_since_latest
+
+Compresses images with format @ref PixelFormat::R8Unorm,
+@relativeref{PixelFormat,RG8Unorm}, @relativeref{PixelFormat,RGB8Unorm},
+@relativeref{PixelFormat,RGBA8Unorm} or their sRGB variants to BC1, BC2, BC3,
+BC4, BC5, BC7 or ETC2 using @ref TextureTools::compressBlocks().
+
+@section Trade-BlockCompressionImageConverter-usage Usage
+
+This plugin depends on the @ref TextureTools and @ref Trade libraries and is
+built if `MAGNUM_WITH_BLOCKCOMPRESSIONIMAGECONVERTER` is enabled when building
+Magnum. To use as a dynamic plugin, load
+@cpp "BlockCompressionImageConverter" @ce via
+@ref Corrade::PluginManager::Manager.
+
+Additionally, if you're using Magnum as a CMake subproject, do the following:
+
+@code{.cmake}
+set(MAGNUM_WITH_BLOCKCOMPRESSIONIMAGECONVERTER ON CACHE BOOL "" FORCE)
+add_subdirectory(magnum EXCLUDE_FROM_ALL)
+
+# So the dynamically loaded plugin gets built implicitly
+add_dependencies(your-app Magnum::BlockCompressionImageConverter)
+@endcode
+
+To use as a static plugin or as a dependency of another plugin with CMake, you
+need to request the `BlockCompressionImageConverter` component of the `Magnum`
+package and link to the `Magnum::BlockCompressionImageConverter` target:
+
+@code{.cmake}
+find_package(Magnum REQUIRED BlockCompressionImageConverter)
+
+# ...
+target_link_libraries(your-app PRIVATE Magnum::BlockCompressionImageConverter)
+@endcode
+
+See @ref building, @ref cmake, @ref plugins and @ref file-formats for more
+information.
+
+@section Trade-BlockCompressionImageConverter-behavior Behavior and limitations
+
+The plugin supports only @ref ImageConverterFeature::Convert2D, producing a
+compressed @ref ImageData2D. To save the result to a file, pass it to a
+converter supporting compressed images, such as @ref KtxImageConverter. With
+@ref magnum-imageconverter this can be done by chaining the two:
+
+@code{.sh}
+magnum-imageconverter image.png -C BlockCompressionImageConverter \
+    -c format=bc7 image.ktx2
+@endcode
+
+The output format is chosen by the @cb{.ini} format @ce
+@ref Trade-BlockCompressionImageConverter-configuration "configuration option".
+If not set, it's picked based on the channel count of the input. If the input
+is sRGB, the sRGB variant of the output format is used if there's one. See
+@ref TextureTools::compressBlocks() for details about the encoders and their
+quality tradeoffs.
+
+Images with @ref ImageFlag2D::Array set are compressed as if it was a regular
+2D image and the flag is passed through to the output.
+
+@section Trade-BlockCompressionImageConverter-configuration Plugin-specific configuration
+
+It's possible to tune various output options through @ref configuration(). See
+below for all options and their default values:
+
+@snippet MagnumPlugins/BlockCompressionImageConverter/BlockCompressionImageConverter.conf configuration_
+
+See @ref plugins-configuration for more information and an example showing how
+to edit the configuration values.
+*/
+class MAGNUM_BLOCKCOMPRESSIONIMAGECONVERTER_EXPORT BlockCompressionImageConverter: public AbstractImageConverter {
+    public:
+        /** @brief Plugin manager constructor */
+        explicit BlockCompressionImageConverter(PluginManager::AbstractManager& manager, const Containers::StringView& plugin);
+
+    private:
+        MAGNUM_BLOCKCOMPRESSIONIMAGECONVERTER_LOCAL ImageConverterFeatures doFeatures() const override;
+        MAGNUM_BLOCKCOMPRESSIONIMAGECONVERTER_LOCAL Containers::Optional<ImageData2D> doConvert(const ImageView2D& image) override;
+};
+
+}}
+
+#endif
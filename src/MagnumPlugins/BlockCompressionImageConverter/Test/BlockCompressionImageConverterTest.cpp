@@ -0,0 +1,178 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
+#include <Corrade/Utility/DebugStl.h> /** @todo remove once Debug is stream-free */
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/TextureTools/CompressBlocks.h"
+#include "Magnum/Trade/AbstractImageConverter.h"
+#include "Magnum/Trade/ImageData.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct BlockCompressionImageConverterTest: TestSuite::Tester {
+    explicit BlockCompressionImageConverterTest();
+
+    void convert();
+    void verbose();
+    void arrayFlag();
+
+    void unsupportedFormat();
+    void unrecognizedFormatOption();
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractImageConverter> _manager{"nonexistent"};
+};
+
+const struct {
+    const char* name;
+    PixelFormat format;
+    const char* formatOption;
+    CompressedPixelFormat expected;
+} ConvertData[]{
+    {"R, default", PixelFormat::R8Unorm, nullptr,
+        CompressedPixelFormat::Bc4RUnorm},
+    {"RG, default", PixelFormat::RG8Unorm, nullptr,
+        CompressedPixelFormat::Bc5RGUnorm},
+    {"RGB sRGB, default", PixelFormat::RGB8Srgb, nullptr,
+        CompressedPixelFormat::Bc1RGBSrgb},
+    {"RGBA, default", PixelFormat::RGBA8Unorm, nullptr,
+        CompressedPixelFormat::Bc3RGBAUnorm},
+    {"RGBA, BC1 with alpha", PixelFormat::RGBA8Unorm, "bc1a",
+        CompressedPixelFormat::Bc1RGBAUnorm},
+    {"RGBA sRGB, BC2", PixelFormat::RGBA8Srgb, "bc2",
+        CompressedPixelFormat::Bc2RGBASrgb},
+    {"R sRGB, BC4", PixelFormat::R8Srgb, "bc4",
+        CompressedPixelFormat::Bc4RUnorm},
+    {"RGBA sRGB, BC7", PixelFormat::RGBA8Srgb, "bc7",
+        CompressedPixelFormat::Bc7RGBASrgb},
+    {"RGB, ETC2", PixelFormat::RGB8Unorm, "etc2",
+        CompressedPixelFormat::Etc2RGB8Unorm},
+};
+
+BlockCompressionImageConverterTest::BlockCompressionImageConverterTest() {
+    addInstancedTests({&BlockCompressionImageConverterTest::convert},
+        Containers::arraySize(ConvertData));
+
+    addTests({&BlockCompressionImageConverterTest::verbose,
+              &BlockCompressionImageConverterTest::arrayFlag,
+
+              &BlockCompressionImageConverterTest::unsupportedFormat,
+              &BlockCompressionImageConverterTest::unrecognizedFormatOption});
+
+    /* Load the plugin directly from the build tree. Otherwise it's static and
+       already loaded. */
+    #ifdef BLOCKCOMPRESSIONIMAGECONVERTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(BLOCKCOMPRESSIONIMAGECONVERTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+}
+
+/* Enough for 5x6 pixels in all formats used, so there are partial blocks in
+   both directions. What's not listed is zero. */
+const UnsignedByte Data[5*6*4]{
+    0x00, 0x10, 0x20, 0x30, 0x40, 0x50, 0x60, 0x70,
+    0x80, 0x90, 0xa0, 0xb0, 0xc0, 0xd0, 0xe0, 0xf0,
+    0xff, 0xef, 0xdf, 0xcf, 0xbf, 0xaf, 0x9f, 0x8f,
+    0x7f, 0x6f, 0x5f, 0x4f, 0x3f, 0x2f, 0x1f, 0x0f,
+    0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88,
+    0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff, 0x00,
+};
+
+void BlockCompressionImageConverterTest::convert() {
+    auto&& data = ConvertData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImageConverter> converter = _manager.instantiate("BlockCompressionImageConverter");
+    if(data.formatOption)
+        converter->configuration().setValue("format", data.formatOption);
+
+    const ImageView2D image{data.format, {5, 6}, Data};
+    Containers::Optional<ImageData2D> converted = converter->convert(image);
+    CORRADE_VERIFY(converted);
+    CORRADE_VERIFY(converted->isCompressed());
+    CORRADE_COMPARE(converted->compressedFormat(), data.expected);
+    CORRADE_COMPARE(converted->size(), (Vector2i{5, 6}));
+    CORRADE_COMPARE(converted->flags(), ImageFlags2D{});
+
+    /* The output should be the same as when calling the API directly */
+    CompressedImage2D expected = TextureTools::compressBlocks(image, data.expected);
+    CORRADE_COMPARE_AS(converted->data(), expected.data(),
+        TestSuite::Compare::Container);
+}
+
+void BlockCompressionImageConverterTest::verbose() {
+    Containers::Pointer<AbstractImageConverter> converter = _manager.instantiate("BlockCompressionImageConverter");
+    converter->setFlags(ImageConverterFlag::Verbose);
+    converter->configuration().setValue("format", "bc7");
+
+    std::ostringstream out;
+    {
+        Debug redirectOutput{&out};
+        CORRADE_VERIFY(converter->convert(ImageView2D{PixelFormat::RGBA8Srgb, {5, 6}, Data}));
+    }
+    CORRADE_COMPARE(out.str(), "Trade::BlockCompressionImageConverter::convert(): compressing PixelFormat::RGBA8Srgb to CompressedPixelFormat::Bc7RGBASrgb\n");
+}
+
+void BlockCompressionImageConverterTest::arrayFlag() {
+    Containers::Pointer<AbstractImageConverter> converter = _manager.instantiate("BlockCompressionImageConverter");
+
+    Containers::Optional<ImageData2D> converted = converter->convert(ImageView2D{PixelFormat::RGBA8Unorm, {5, 6}, Data, ImageFlag2D::Array});
+    CORRADE_VERIFY(converted);
+    CORRADE_COMPARE(converted->flags(), ImageFlag2D::Array);
+}
+
+void BlockCompressionImageConverterTest::unsupportedFormat() {
+    Containers::Pointer<AbstractImageConverter> converter = _manager.instantiate("BlockCompressionImageConverter");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!converter->convert(ImageView2D{PixelFormat::RG16Unorm, {5, 6}, Data}));
+    CORRADE_COMPARE(out.str(), "Trade::BlockCompressionImageConverter::convert(): unsupported format PixelFormat::RG16Unorm\n");
+}
+
+void BlockCompressionImageConverterTest::unrecognizedFormatOption() {
+    Containers::Pointer<AbstractImageConverter> converter = _manager.instantiate("BlockCompressionImageConverter");
+    converter->configuration().setValue("format", "bc6h");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!converter->convert(ImageView2D{PixelFormat::RGBA8Unorm, {5, 6}, Data}));
+    CORRADE_COMPARE(out.str(), "Trade::BlockCompressionImageConverter::convert(): unrecognized format bc6h\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::BlockCompressionImageConverterTest)
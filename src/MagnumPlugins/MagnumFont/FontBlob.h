@@ -0,0 +1,98 @@
+#ifndef Magnum_Text_FontBlob_h
+#define Magnum_Text_FontBlob_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Math/Range.h"
+
+/* Used by both MagnumFont and MagnumFontConverter, which is why it isn't
+   directly inside MagnumFont.cpp. OTOH it doesn't need to be exposed
+   publicly, which is why it has no docblocks.
+
+   The file is a header, followed by a glyph table, a character table sorted
+   by codepoint and the glyph cache image data with rows aligned to four
+   bytes. All offsets are absolute from the file start and aligned to
+   FontBlobDataAlignment, so when the file is memory-mapped or loaded into a
+   suitably aligned allocation, everything can be referenced directly without
+   any parsing. The data are stored in the endianness of the machine that
+   produced them, indicated in the header. */
+
+namespace Magnum { namespace Text { namespace Implementation {
+
+constexpr char FontBlobMagic[4]{'M', 'G', 'F', 'B'};
+constexpr UnsignedByte FontBlobVersion = 1;
+constexpr std::size_t FontBlobDataAlignment = 4;
+
+enum: UnsignedByte {
+    FontBlobFlagBigEndian = 1 << 0
+};
+
+struct FontBlobHeader {
+    char magic[4];
+    UnsignedByte version;
+    UnsignedByte flags;
+    UnsignedShort reserved;
+
+    Float fontSize;
+    Float ascent;
+    Float descent;
+    Float lineHeight;
+
+    Vector2i originalImageSize;
+    Vector2i padding;
+    Vector2i imageSize;
+    UnsignedInt imageFormat;        /* PixelFormat */
+
+    UnsignedInt glyphCount;
+    UnsignedInt glyphOffset;
+    UnsignedInt charCount;
+    UnsignedInt charOffset;
+    UnsignedInt imageDataOffset;
+    UnsignedInt imageDataSize;
+};
+
+static_assert(sizeof(FontBlobHeader) == 76, "FontBlobHeader size is not 76 bytes");
+
+/* glyphCount entries at glyphOffset, indexed by glyph ID. Padding is already
+   removed from position and rectangle, same as in the text format. */
+struct FontBlobGlyph {
+    Vector2 advance;
+    Vector2i position;
+    Range2Di rectangle;
+};
+
+static_assert(sizeof(FontBlobGlyph) == 32, "FontBlobGlyph size is not 32 bytes");
+
+/* charCount entries at charOffset, sorted by codepoint for binary search */
+struct FontBlobChar {
+    UnsignedInt codepoint;
+    UnsignedInt glyph;
+};
+
+static_assert(sizeof(FontBlobChar) == 8, "FontBlobChar size is not 8 bytes");
+
+}}}
+
+#endif
@@ -25,19 +25,27 @@
 
 #include "MagnumFont.h"
 
+#include <algorithm> /* std::lower_bound() */
+#include <cstring>
 #include <sstream>
-#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Containers/StringStl.h> /** @todo remove once AbstractFont is <string>-free */
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/Configuration.h>
+#include <Corrade/Utility/Endianness.h>
 #include <Corrade/Utility/Path.h>
 #include <Corrade/Utility/Unicode.h>
 
 #include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
 #include "Magnum/Math/ConfigurationValue.h"
 #include "Magnum/Text/GlyphCache.h"
 #include "Magnum/Trade/ImageData.h"
+#include "MagnumPlugins/MagnumFont/FontBlob.h"
 #include "MagnumPlugins/TgaImporter/TgaImporter.h"
 
 namespace Magnum { namespace Text {
@@ -53,17 +61,30 @@ struct MagnumFont::Data {
     Containers::Optional<Containers::String> filePath;
     std::unordered_map<char32_t, UnsignedInt> glyphId;
     std::vector<Vector2> glyphAdvance;
+
+    /* Binary font. The data are either a copy made in openData() or a
+       memory-mapped file, everything else points into them. */
+    Containers::Array<char> blobData;
+    #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    Containers::Array<const char, Utility::Path::MapDeleter> blobMapped;
+    #endif
+    const Implementation::FontBlobHeader* blob{};
+    Containers::ArrayView<const Implementation::FontBlobGlyph> blobGlyphs;
+    Containers::ArrayView<const Implementation::FontBlobChar> blobChars;
+
+    /* Points either to glyphAdvance or to blobGlyphs */
+    Containers::StridedArrayView1D<const Vector2> glyphAdvances;
 };
 
 namespace {
     class MagnumFontLayouter: public AbstractLayouter {
         public:
-            explicit MagnumFontLayouter(const std::vector<Vector2>& glyphAdvance, const AbstractGlyphCache& cache, Float fontSize, Float textSize, std::vector<UnsignedInt>&& glyphs);
+            explicit MagnumFontLayouter(const Containers::StridedArrayView1D<const Vector2>& glyphAdvance, const AbstractGlyphCache& cache, Float fontSize, Float textSize, std::vector<UnsignedInt>&& glyphs);
 
         private:
             std::tuple<Range2D, Range2D, Vector2> doRenderGlyph(UnsignedInt i) override;
 
-            const std::vector<Vector2>& glyphAdvance;
+            const Containers::StridedArrayView1D<const Vector2> glyphAdvance;
             const AbstractGlyphCache& cache;
             const Float fontSize, textSize;
             const std::vector<UnsignedInt> glyphs;
@@ -85,6 +106,14 @@ void MagnumFont::doClose() { _opened = nullptr; }
 auto MagnumFont::doOpenData(const Containers::ArrayView<const char> data, const Float) -> Metrics {
     if(!_opened) _opened.emplace();
 
+    /* Binary file. Make a copy as there's no guarantee the data stay in
+       scope, everything is then referenced directly from the copy. */
+    if(data.size() >= sizeof(Implementation::FontBlobMagic) && std::memcmp(data.data(), Implementation::FontBlobMagic, sizeof(Implementation::FontBlobMagic)) == 0) {
+        _opened->blobData = Containers::Array<char>{NoInit, data.size()};
+        Utility::copy(data, _opened->blobData);
+        return openBlob(_opened->blobData, "openData");
+    }
+
     if(!_opened->filePath && !fileCallback()) {
         Error{} << "Text::MagnumFont::openData(): the font can be opened only from the filesystem or if a file callback is present";
         return {};
@@ -122,6 +151,7 @@ auto MagnumFont::doOpenData(const Containers::ArrayView<const char> data, const
     _opened->glyphAdvance.reserve(glyphs.size());
     for(const Utility::ConfigurationGroup* const g: glyphs)
         _opened->glyphAdvance.push_back(g->value<Vector2>("advance"));
+    _opened->glyphAdvances = Containers::arrayView(_opened->glyphAdvance);
 
     /* Fill character->glyph map */
     const std::vector<Utility::ConfigurationGroup*> chars = _opened->conf.groups("char");
@@ -137,23 +167,120 @@ auto MagnumFont::doOpenData(const Containers::ArrayView<const char> data, const
             _opened->conf.value<Float>("lineHeight")};
 }
 
+auto MagnumFont::openBlob(const Containers::ArrayView<const char> data, const char* const function) -> Metrics {
+    if(data.size() < sizeof(Implementation::FontBlobHeader)) {
+        Error{} << "Text::MagnumFont::" << Debug::nospace << function << Debug::nospace << "(): file too short, expected at least" << sizeof(Implementation::FontBlobHeader) << "bytes but got" << data.size();
+        return {};
+    }
+
+    const auto& header = *reinterpret_cast<const Implementation::FontBlobHeader*>(data.data());
+    if(header.version != Implementation::FontBlobVersion) {
+        Error{} << "Text::MagnumFont::" << Debug::nospace << function << Debug::nospace << "(): unsupported binary file version" << header.version << Debug::nospace << ", expected" << Implementation::FontBlobVersion;
+        return {};
+    }
+    if(bool(header.flags & Implementation::FontBlobFlagBigEndian) != Utility::Endianness::isBigEndian()) {
+        Error{} << "Text::MagnumFont::" << Debug::nospace << function << Debug::nospace << "(): file is" << (header.flags & Implementation::FontBlobFlagBigEndian ? "big-endian" : "little-endian") << "but the machine is not";
+        return {};
+    }
+
+    /* Check all offsets against the file size. Done in 64 bits to not have
+       the multiplications overflow on 32-bit platforms. */
+    if(header.glyphOffset % Implementation::FontBlobDataAlignment || header.glyphOffset + std::uint64_t(header.glyphCount)*sizeof(Implementation::FontBlobGlyph) > data.size()) {
+        Error{} << "Text::MagnumFont::" << Debug::nospace << function << Debug::nospace << "():" << header.glyphCount << "glyphs at offset" << header.glyphOffset << "out of bounds for" << data.size() << "bytes";
+        return {};
+    }
+    if(header.charOffset % Implementation::FontBlobDataAlignment || header.charOffset + std::uint64_t(header.charCount)*sizeof(Implementation::FontBlobChar) > data.size()) {
+        Error{} << "Text::MagnumFont::" << Debug::nospace << function << Debug::nospace << "():" << header.charCount << "characters at offset" << header.charOffset << "out of bounds for" << data.size() << "bytes";
+        return {};
+    }
+    if(header.imageDataOffset + std::uint64_t(header.imageDataSize) > data.size()) {
+        Error{} << "Text::MagnumFont::" << Debug::nospace << function << Debug::nospace << "(): image data of" << header.imageDataSize << "bytes at offset" << header.imageDataOffset << "out of bounds for" << data.size() << "bytes";
+        return {};
+    }
+
+    /* The converter saves only single-channel or RGBA 8-bit images, so it's
+       enough to check for those */
+    const PixelFormat format = PixelFormat(header.imageFormat);
+    if(format != PixelFormat::R8Unorm && format != PixelFormat::RGBA8Unorm) {
+        Error{} << "Text::MagnumFont::" << Debug::nospace << function << Debug::nospace << "(): unsupported image format" << reinterpret_cast<void*>(header.imageFormat);
+        return {};
+    }
+    const std::size_t rowSize = (header.imageSize.x()*pixelFormatSize(format) + 3)/4*4;
+    if(rowSize*header.imageSize.y() != header.imageDataSize) {
+        Error{} << "Text::MagnumFont::" << Debug::nospace << function << Debug::nospace << "(): expected" << rowSize*header.imageSize.y() << "bytes for a" << Debug::packed << header.imageSize << format << "image but got" << header.imageDataSize;
+        return {};
+    }
+
+    /* Everything okay, reference the data directly */
+    _opened->blob = &header;
+    _opened->blobGlyphs = Containers::arrayCast<const Implementation::FontBlobGlyph>(data.slice(header.glyphOffset, header.glyphOffset + header.glyphCount*sizeof(Implementation::FontBlobGlyph)));
+    _opened->blobChars = Containers::arrayCast<const Implementation::FontBlobChar>(data.slice(header.charOffset, header.charOffset + header.charCount*sizeof(Implementation::FontBlobChar)));
+    _opened->glyphAdvances = Containers::stridedArrayView(_opened->blobGlyphs).slice(&Implementation::FontBlobGlyph::advance);
+    _opened->image = Trade::ImageData2D{format, header.imageSize, Trade::DataFlags{}, data.slice(header.imageDataOffset, header.imageDataOffset + header.imageDataSize)};
+
+    return {header.fontSize, header.ascent, header.descent, header.lineHeight};
+}
+
 auto MagnumFont::doOpenFile(const std::string& filename, Float size) -> Metrics {
     _opened.emplace();
     _opened->filePath.emplace(Utility::Path::split(filename).first());
 
+    /* Binary files are memory-mapped if possible, so opening is just a matter
+       of checking the header. Otherwise the data get read through the base
+       implementation and copied in doOpenData(). */
+    #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    if(!fileCallback() && Containers::StringView{filename}.hasSuffix(".magnum-font")) {
+        Containers::Optional<Containers::Array<const char, Utility::Path::MapDeleter>> mapped = Utility::Path::mapRead(filename);
+        if(!mapped) {
+            Error{} << "Text::MagnumFont::openFile(): cannot open file" << filename;
+            return {};
+        }
+
+        _opened->blobMapped = *std::move(mapped);
+        return openBlob(_opened->blobMapped, "openFile");
+    }
+    #endif
+
     return AbstractFont::doOpenFile(filename, size);
 }
 
-UnsignedInt MagnumFont::doGlyphId(const char32_t character) {
+UnsignedInt MagnumFont::glyphIdInternal(const char32_t character) const {
+    /* Binary font has the characters sorted */
+    if(_opened->blob) {
+        const Implementation::FontBlobChar* const found = std::lower_bound(_opened->blobChars.begin(), _opened->blobChars.end(), UnsignedInt(character),
+            [](const Implementation::FontBlobChar& a, const UnsignedInt b) {
+                return a.codepoint < b;
+            });
+        return found != _opened->blobChars.end() && found->codepoint == UnsignedInt(character) && found->glyph < _opened->blobGlyphs.size() ? found->glyph : 0;
+    }
+
     auto it = _opened->glyphId.find(character);
     return it != _opened->glyphId.end() ? it->second : 0;
 }
 
+UnsignedInt MagnumFont::doGlyphId(const char32_t character) {
+    return glyphIdInternal(character);
+}
+
 Vector2 MagnumFont::doGlyphAdvance(const UnsignedInt glyph) {
-    return glyph < _opened->glyphAdvance.size() ? _opened->glyphAdvance[glyph] : Vector2();
+    return glyph < _opened->glyphAdvances.size() ? _opened->glyphAdvances[glyph] : Vector2();
 }
 
 Containers::Pointer<AbstractGlyphCache> MagnumFont::doCreateGlyphCache() {
+    /* Binary font, everything is in the header and the glyph table */
+    if(_opened->blob) {
+        Containers::Pointer<AbstractGlyphCache> cache(new Text::GlyphCache(
+            _opened->blob->originalImageSize,
+            _opened->image->size(),
+            _opened->blob->padding));
+        cache->setImage({}, *_opened->image);
+
+        for(std::size_t i = 0; i != _opened->blobGlyphs.size(); ++i)
+            cache->insert(i, _opened->blobGlyphs[i].position, _opened->blobGlyphs[i].rectangle);
+
+        return cache;
+    }
+
     /* Set cache image */
     Containers::Pointer<AbstractGlyphCache> cache(new Text::GlyphCache(
         _opened->conf.value<Vector2i>("originalImageSize"),
@@ -176,16 +303,35 @@ Containers::Pointer<AbstractLayouter> MagnumFont::doLayout(const AbstractGlyphCa
     for(std::size_t i = 0; i != text.size(); ) {
         UnsignedInt codepoint;
         std::tie(codepoint, i) = Utility::Unicode::nextChar(text, i);
-        const auto it = _opened->glyphId.find(codepoint);
-        glyphs.push_back(it == _opened->glyphId.end() ? 0 : it->second);
+        glyphs.push_back(glyphIdInternal(codepoint));
+    }
+
+    return Containers::Pointer<MagnumFontLayouter>(new MagnumFontLayouter(_opened->glyphAdvances, cache, this->size(), size, std::move(glyphs)));
+}
+
+UnsignedInt MagnumFont::doLayoutInto(const Float size, const Containers::StringView text, const Containers::StridedArrayView1D<UnsignedInt>& glyphIds, const Containers::StridedArrayView1D<Vector2>& glyphOffsets, const Containers::StridedArrayView1D<Vector2>& glyphAdvances) {
+    const Containers::ArrayView<const char> data = text;
+    const Float scale = size/this->size();
+
+    /* Same as doLayout() above, but writing directly to the output instead of
+       going through an intermediate glyph list and a layouter instance. The
+       font has no kerning or other positioning info, so offsets are zero. */
+    UnsignedInt count = 0;
+    for(std::size_t i = 0; i != data.size(); ++count) {
+        char32_t codepoint;
+        std::tie(codepoint, i) = Utility::Unicode::nextChar(data, i);
+        const UnsignedInt glyph = glyphIdInternal(codepoint);
+        glyphIds[count] = glyph;
+        glyphOffsets[count] = {};
+        glyphAdvances[count] = _opened->glyphAdvances[glyph]*scale;
     }
 
-    return Containers::Pointer<MagnumFontLayouter>(new MagnumFontLayouter(_opened->glyphAdvance, cache, this->size(), size, std::move(glyphs)));
+    return count;
 }
 
 namespace {
 
-MagnumFontLayouter::MagnumFontLayouter(const std::vector<Vector2>& glyphAdvance, const AbstractGlyphCache& cache, const Float fontSize, const Float textSize, std::vector<UnsignedInt>&& glyphs): AbstractLayouter(glyphs.size()), glyphAdvance(glyphAdvance), cache(cache), fontSize(fontSize), textSize(textSize), glyphs(std::move(glyphs)) {}
+MagnumFontLayouter::MagnumFontLayouter(const Containers::StridedArrayView1D<const Vector2>& glyphAdvance, const AbstractGlyphCache& cache, const Float fontSize, const Float textSize, std::vector<UnsignedInt>&& glyphs): AbstractLayouter(glyphs.size()), glyphAdvance(glyphAdvance), cache(cache), fontSize(fontSize), textSize(textSize), glyphs(std::move(glyphs)) {}
 
 std::tuple<Range2D, Range2D, Vector2> MagnumFontLayouter::doRenderGlyph(const UnsignedInt i) {
     /* Position of the texture in the resulting glyph, texture coordinates */
@@ -211,4 +357,4 @@ std::tuple<Range2D, Range2D, Vector2> MagnumFontLayouter::doRenderGlyph(const Un
 }}
 
 CORRADE_PLUGIN_REGISTER(MagnumFont, Magnum::Text::MagnumFont,
-    "cz.mosra.magnum.Text.AbstractFont/0.3")
+    "cz.mosra.magnum.Text.AbstractFont/0.3.1")
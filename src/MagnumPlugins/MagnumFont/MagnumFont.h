@@ -116,6 +116,19 @@ rectangle=45 0 44 25
 # ...
 @endcode
 
+@section Text-MagnumFont-binary Binary font files
+
+Parsing the text configuration gets slow for fonts with many thousands of
+glyphs. Files with a `*.magnum-font` extension produced by
+@ref MagnumFontConverter contain the same information in a binary form ---
+a glyph table, a character table sorted by codepoint and the glyph cache image
+embedded directly, without a separate TGA file. The format is detected by its
+signature in @ref openData(), where the data are copied, while
+@ref openFile() memory-maps the file on Unix and non-RT Windows if no file
+callback is set, making the open time independent of glyph count. The file is
+stored in native endianness and opening a file produced on a machine with
+different endianness fails.
+
 @section Text-MagnumFont-usage Usage
 
 This plugin depends on the @ref Text library and the
@@ -173,6 +186,10 @@ class MAGNUM_MAGNUMFONT_EXPORT MagnumFont: public AbstractFont {
         MAGNUM_MAGNUMFONT_LOCAL Vector2 doGlyphAdvance(UnsignedInt glyph) override;
         MAGNUM_MAGNUMFONT_LOCAL Containers::Pointer<AbstractGlyphCache> doCreateGlyphCache() override;
         MAGNUM_MAGNUMFONT_LOCAL Containers::Pointer<AbstractLayouter> doLayout(const AbstractGlyphCache& cache, Float size, const std::string& text) override;
+        MAGNUM_MAGNUMFONT_LOCAL UnsignedInt doLayoutInto(Float size, Containers::StringView text, const Containers::StridedArrayView1D<UnsignedInt>& glyphIds, const Containers::StridedArrayView1D<Vector2>& glyphOffsets, const Containers::StridedArrayView1D<Vector2>& glyphAdvances) override;
+
+        MAGNUM_MAGNUMFONT_LOCAL Metrics openBlob(Containers::ArrayView<const char> data, const char* function);
+        MAGNUM_MAGNUMFONT_LOCAL UnsignedInt glyphIdInternal(char32_t character) const;
 
         struct Data;
         Containers::Pointer<Data> _opened;
@@ -0,0 +1,172 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <chrono>
+#include <string>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StringStl.h> /** @todo remove once AbstractFont is <string>-free */
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/FormatStl.h>
+
+#include "Magnum/FileCallback.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Text/AbstractFont.h"
+#include "Magnum/Trade/AbstractImporter.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Text { namespace Test { namespace {
+
+struct MagnumFontBenchmark: TestSuite::Tester {
+    explicit MagnumFontBenchmark();
+
+    void open();
+
+    void throughputBegin();
+    std::uint64_t throughputEnd();
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<Trade::AbstractImporter> _importerManager{"nonexistent"};
+    PluginManager::Manager<AbstractFont> _fontManager{"nonexistent"};
+
+    std::size_t _throughputSize;
+    std::chrono::high_resolution_clock::time_point _throughputBegin;
+};
+
+constexpr std::size_t BenchmarkRepeats = 5;
+constexpr std::size_t BenchmarkIterations = 1;
+constexpr Int ImageSize = 256;
+
+const struct {
+    const char* name;
+    UnsignedInt glyphCount;
+} OpenData[]{
+    {"256 glyphs", 256},
+    {"4096 glyphs", 4096},
+    {"65536 glyphs", 65536},
+};
+
+MagnumFontBenchmark::MagnumFontBenchmark() {
+    /* Time of open, including the glyph cache image import */
+    addInstancedBenchmarks({&MagnumFontBenchmark::open},
+        BenchmarkRepeats, Containers::arraySize(OpenData));
+
+    /* Megabytes of input data processed per second */
+    addCustomInstancedBenchmarks({&MagnumFontBenchmark::open},
+        BenchmarkRepeats, Containers::arraySize(OpenData),
+        &MagnumFontBenchmark::throughputBegin,
+        &MagnumFontBenchmark::throughputEnd,
+        BenchmarkUnits::Count);
+
+    /* Load the plugins directly from the build tree. Otherwise they're static
+       and already loaded. */
+    _fontManager.registerExternalManager(_importerManager);
+    #if defined(TGAIMPORTER_PLUGIN_FILENAME) && defined(MAGNUMFONT_PLUGIN_FILENAME)
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_importerManager.load(TGAIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_fontManager.load(MAGNUMFONT_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+}
+
+void MagnumFontBenchmark::throughputBegin() {
+    setBenchmarkName("MB/s");
+    _throughputBegin = std::chrono::high_resolution_clock::now();
+}
+
+std::uint64_t MagnumFontBenchmark::throughputEnd() {
+    const std::uint64_t elapsed = Math::max(std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - _throughputBegin).count()), std::uint64_t{1});
+
+    /* The returned value gets divided by the iteration count passed to
+       CORRADE_BENCHMARK(), so multiply it by the count once more to get
+       megabytes per second */
+    return std::uint64_t(Double(_throughputSize)*BenchmarkIterations*BenchmarkIterations*1.0e3/elapsed);
+}
+
+std::string generateConf(const UnsignedInt glyphCount) {
+    std::string out = Utility::formatString(
+        "version=1\n"
+        "image=font.tga\n"
+        "originalImageSize={0} {0}\n"
+        "padding=0 0\n"
+        "fontSize=16\n"
+        "ascent=25\n"
+        "descent=-10\n"
+        "lineHeight=39.7333\n", ImageSize);
+
+    /* Characters first, glyphs after, both mapped 1:1 */
+    for(UnsignedInt i = 0; i != glyphCount; ++i)
+        out += Utility::formatString(
+            "[char]\n"
+            "unicode={:x}\n"
+            "glyph={}\n", 32 + i, i);
+    for(UnsignedInt i = 0; i != glyphCount; ++i)
+        out += Utility::formatString(
+            "[glyph]\n"
+            "advance=8 0\n"
+            "position=1 2\n"
+            "rectangle={} {} {} {}\n", i % 16*16, i/16 % 16*16, i % 16*16 + 16, i/16 % 16*16 + 16);
+
+    return out;
+}
+
+/* A grayscale uncompressed TGA */
+Containers::Array<char> generateTga() {
+    Containers::Array<char> out{ValueInit, 18 + ImageSize*ImageSize};
+    out[2] = 3;
+    out[12] = char(ImageSize & 0xff);
+    out[13] = char(ImageSize >> 8);
+    out[14] = char(ImageSize & 0xff);
+    out[15] = char(ImageSize >> 8);
+    out[16] = 8;
+    return out;
+}
+
+void MagnumFontBenchmark::open() {
+    auto&& data = OpenData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractFont> font = _fontManager.instantiate("MagnumFont");
+
+    const std::string conf = generateConf(data.glyphCount);
+    Containers::Array<char> tga = generateTga();
+    _throughputSize = conf.size() + tga.size();
+
+    font->setFileCallback([](const std::string&, InputFileCallbackPolicy,
+        Containers::Array<char>& tga) {
+            return Containers::optional(Containers::ArrayView<const char>(tga));
+        }, tga);
+
+    bool opened = false;
+    CORRADE_BENCHMARK(BenchmarkIterations) {
+        opened = font->openData({conf.data(), conf.size()}, 0.0f);
+    }
+
+    CORRADE_VERIFY(opened);
+    CORRADE_COMPARE(font->glyphId(char32_t(32 + data.glyphCount - 1)), data.glyphCount - 1);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Text::Test::MagnumFontBenchmark)
@@ -41,6 +41,7 @@ struct MagnumFontGLTest: GL::OpenGLTester {
     explicit MagnumFontGLTest();
 
     void createGlyphCache();
+    void createGlyphCacheBinary();
 
     /* Explicitly forbid system-wide plugin dependencies */
     PluginManager::Manager<Trade::AbstractImporter> _importerManager{"nonexistent"};
@@ -48,7 +49,8 @@ struct MagnumFontGLTest: GL::OpenGLTester {
 };
 
 MagnumFontGLTest::MagnumFontGLTest() {
-    addTests({&MagnumFontGLTest::createGlyphCache});
+    addTests({&MagnumFontGLTest::createGlyphCache,
+              &MagnumFontGLTest::createGlyphCacheBinary});
 
     /* Load the plugins directly from the build tree. Otherwise they're static
        and already loaded. */
@@ -74,6 +76,23 @@ void MagnumFontGLTest::createGlyphCache() {
     /** @todo properly test contents */
 }
 
+void MagnumFontGLTest::createGlyphCacheBinary() {
+    Containers::Pointer<AbstractFont> font = _fontManager.instantiate("MagnumFont");
+
+    CORRADE_VERIFY(font->openFile(Utility::Path::join(MAGNUMFONT_TEST_DIR, "font.magnum-font"), 0.0f));
+
+    Containers::Pointer<AbstractGlyphCache> cache = font->createGlyphCache();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(cache);
+    CORRADE_COMPARE(cache->glyphCount(), 3);
+    CORRADE_COMPARE(cache->padding(), Vector2i{24});
+
+    /* Padding got added back when inserting */
+    CORRADE_COMPARE((*cache)[2].first, (Vector2i{1, 10}));
+    CORRADE_COMPARE((*cache)[2].second, (Range2Di{{-24, -16}, {40, 152}}));
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Text::Test::MagnumFontGLTest)
@@ -23,13 +23,18 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <cstring>
 #include <sstream>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Containers/StringStl.h> /** @todo remove once AbstractFont is <string>-free */
+#include <Corrade/Containers/StringView.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/TestSuite/Compare/String.h>
 #include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Format.h>
 #include <Corrade/Utility/Path.h>
 
 #include "Magnum/FileCallback.h"
@@ -41,12 +46,47 @@
 
 namespace Magnum { namespace Text { namespace Test { namespace {
 
+/* Patches given four bytes of font.magnum-font and cuts it to given size */
+const struct {
+    const char* name;
+    std::size_t size;
+    std::size_t offset;
+    UnsignedInt value;
+    const char* message;
+} BinaryInvalidData[]{
+    {"too short", 75, 8, 0,
+        "file too short, expected at least 76 bytes but got 75"},
+    /* Version is the fifth byte, flags the sixth, overwriting the reserved
+       field as well doesn't matter */
+    {"unsupported version", 216, 4, 2,
+        "unsupported binary file version 2, expected 1"},
+    #ifndef CORRADE_TARGET_BIG_ENDIAN
+    {"wrong endianness", 216, 4, 0x0101,
+        "file is big-endian but the machine is not"},
+    #endif
+    {"glyphs out of bounds", 216, 52, 5,
+        "5 glyphs at offset 76 out of bounds for 216 bytes"},
+    {"characters out of bounds", 216, 60, 13,
+        "13 characters at offset 172 out of bounds for 216 bytes"},
+    {"image data out of bounds", 216, 68, 205,
+        "image data of 12 bytes at offset 205 out of bounds for 216 bytes"},
+    {"unsupported image format", 216, 48, 0xdead,
+        "unsupported image format 0xdead"},
+    {"image data size mismatch", 216, 72, 8,
+        "expected 12 bytes for a {2, 3} PixelFormat::R8Unorm image but got 8"},
+};
+
 struct MagnumFontTest: TestSuite::Tester {
     explicit MagnumFontTest();
 
     void nonexistent();
     void properties();
     void layout();
+    void layoutInto();
+
+    void binary();
+    void binaryData();
+    void binaryInvalid();
 
     void fileCallbackImage();
     void fileCallbackImageNotFound();
@@ -60,8 +100,15 @@ MagnumFontTest::MagnumFontTest() {
     addTests({&MagnumFontTest::nonexistent,
               &MagnumFontTest::properties,
               &MagnumFontTest::layout,
+              &MagnumFontTest::layoutInto,
+
+              &MagnumFontTest::binary,
+              &MagnumFontTest::binaryData});
 
-              &MagnumFontTest::fileCallbackImage,
+    addInstancedTests({&MagnumFontTest::binaryInvalid},
+        Containers::arraySize(BinaryInvalidData));
+
+    addTests({              &MagnumFontTest::fileCallbackImage,
               &MagnumFontTest::fileCallbackImageNotFound});
 
     /* Load the plugins directly from the build tree. Otherwise they're static
@@ -145,6 +192,99 @@ void MagnumFontTest::layout() {
     CORRADE_COMPARE(cursorPosition, Vector2(0.375f, 0.0f));
 }
 
+void MagnumFontTest::layoutInto() {
+    Containers::Pointer<AbstractFont> font = _fontManager.instantiate("MagnumFont");
+
+    CORRADE_VERIFY(font->openFile(Utility::Path::join(MAGNUMFONT_TEST_DIR, "font.conf"), 0.0f));
+
+    UnsignedInt ids[4];
+    Vector2 offsets[4];
+    Vector2 advances[4];
+    CORRADE_COMPARE(font->layoutInto(0.5f, "Wave", ids, offsets, advances), 4);
+
+    /* 'a' and 'v' map to glyph 0, same as in layout() above */
+    CORRADE_COMPARE_AS(Containers::arrayView(ids),
+        Containers::arrayView<UnsignedInt>({2, 0, 0, 1}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(offsets),
+        Containers::arrayView<Vector2>({{}, {}, {}, {}}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(advances),
+        Containers::arrayView<Vector2>({
+            {0.71875f, 0.0f},
+            {0.25f, 0.0f},
+            {0.25f, 0.0f},
+            {0.375f, 0.0f}
+        }), TestSuite::Compare::Container);
+}
+
+void MagnumFontTest::binary() {
+    Containers::Pointer<AbstractFont> font = _fontManager.instantiate("MagnumFont");
+
+    /* The file is memory-mapped on platforms that support it, there's no
+       separate image file needed */
+    CORRADE_VERIFY(font->openFile(Utility::Path::join(MAGNUMFONT_TEST_DIR, "font.magnum-font"), 0.0f));
+    CORRADE_COMPARE(font->size(), 16.0f);
+    CORRADE_COMPARE(font->ascent(), 25.0f);
+    CORRADE_COMPARE(font->descent(), -10.0f);
+    CORRADE_COMPARE(font->lineHeight(), 39.7333f);
+    CORRADE_COMPARE(font->glyphId(U'W'), 2);
+    CORRADE_COMPARE(font->glyphId(U'e'), 1);
+    CORRADE_COMPARE(font->glyphId(U'a'), 0);
+    /* Not in the character table at all */
+    CORRADE_COMPARE(font->glyphId(U'X'), 0);
+    CORRADE_COMPARE(font->glyphAdvance(font->glyphId(U'W')), Vector2(23.0f, 0.0f));
+    CORRADE_COMPARE(font->glyphAdvance(3), Vector2{});
+
+    /* Same output as layoutInto() with the text file */
+    UnsignedInt ids[4];
+    Vector2 offsets[4];
+    Vector2 advances[4];
+    CORRADE_COMPARE(font->layoutInto(0.5f, "Wave", ids, offsets, advances), 4);
+    CORRADE_COMPARE_AS(Containers::arrayView(ids),
+        Containers::arrayView<UnsignedInt>({2, 0, 0, 1}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(advances),
+        Containers::arrayView<Vector2>({
+            {0.71875f, 0.0f},
+            {0.25f, 0.0f},
+            {0.25f, 0.0f},
+            {0.375f, 0.0f}
+        }), TestSuite::Compare::Container);
+}
+
+void MagnumFontTest::binaryData() {
+    Containers::Pointer<AbstractFont> font = _fontManager.instantiate("MagnumFont");
+
+    /* Unlike with the text file, no file path or callback is needed */
+    Containers::Optional<Containers::Array<char>> data = Utility::Path::read(Utility::Path::join(MAGNUMFONT_TEST_DIR, "font.magnum-font"));
+    CORRADE_VERIFY(data);
+    CORRADE_VERIFY(font->openData(*data, 0.0f));
+
+    /* The data are copied, so it's fine to discard them now */
+    data = Containers::NullOpt;
+    CORRADE_COMPARE(font->size(), 16.0f);
+    CORRADE_COMPARE(font->glyphId(U'e'), 1);
+    CORRADE_COMPARE(font->glyphAdvance(1), Vector2(12.0f, 0.0f));
+}
+
+void MagnumFontTest::binaryInvalid() {
+    auto&& data = BinaryInvalidData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractFont> font = _fontManager.instantiate("MagnumFont");
+
+    Containers::Optional<Containers::Array<char>> file = Utility::Path::read(Utility::Path::join(MAGNUMFONT_TEST_DIR, "font.magnum-font"));
+    CORRADE_VERIFY(file);
+    CORRADE_COMPARE(file->size(), 216);
+    std::memcpy(file->data() + data.offset, &data.value, sizeof(UnsignedInt));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!font->openData(file->prefix(data.size), 0.0f));
+    CORRADE_COMPARE(out.str(), Utility::formatString("Text::MagnumFont::openData(): {}\n", data.message));
+}
+
 void MagnumFontTest::fileCallbackImage() {
     Containers::Pointer<AbstractFont> font = _fontManager.instantiate("MagnumFont");
     CORRADE_VERIFY(font->features() & FontFeature::FileCallback);
@@ -25,12 +25,18 @@
 
 #include "MagnumFontConverter.h"
 
-#include <algorithm> /* std::sort() */
+#include <algorithm> /* std::sort(), std::unique() */
+#include <cstring>
 #include <sstream>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/StringStl.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/Configuration.h>
+#include <Corrade/Utility/Endianness.h>
 #include <Corrade/Utility/Path.h>
 
 #include "Magnum/Image.h"
@@ -39,16 +45,126 @@
 #include "Magnum/Math/ConfigurationValue.h"
 #include "Magnum/Text/AbstractFont.h"
 #include "Magnum/Text/AbstractGlyphCache.h"
+#include "Magnum/Trade/ImageData.h"
+#include "MagnumPlugins/MagnumFont/FontBlob.h"
 #include "MagnumPlugins/TgaImageConverter/TgaImageConverter.h"
+#include "MagnumPlugins/TgaImporter/TgaImporter.h"
+
+#ifdef MAGNUM_TARGET_GL
+#include "Magnum/GL/TextureFormat.h"
+#include "Magnum/Text/GlyphCache.h"
+#endif
 
 namespace Magnum { namespace Text {
 
+namespace {
+
+/* Glyphs sorted by ID for predictable output */
+std::vector<std::pair<UnsignedInt, std::pair<Vector2i, Range2Di>>> sortedGlyphs(const AbstractGlyphCache& cache) {
+    std::vector<std::pair<UnsignedInt, std::pair<Vector2i, Range2Di>>> out;
+    out.reserve(cache.glyphCount());
+    for(const std::pair<const UnsignedInt, std::pair<Vector2i, Range2Di>>& glyph: cache)
+        out.emplace_back(glyph);
+    std::sort(out.begin(), out.end(),
+        [](const std::pair<UnsignedInt, std::pair<Vector2i, Range2Di>>& a,
+           const std::pair<UnsignedInt, std::pair<Vector2i, Range2Di>>& b) {
+            return a.first < b.first;
+        });
+    return out;
+}
+
+Containers::Array<char> configurationData(const Utility::Configuration& configuration) {
+    std::ostringstream out;
+    configuration.save(out);
+    const std::string str = out.str();
+    Containers::Array<char> data{NoInit, str.size()};
+    std::copy(str.begin(), str.end(), data.begin());
+    return data;
+}
+
+/* Binary variant of exportFontToData(), with glyph IDs already compressed.
+   See FontBlob.h for the layout. */
+std::vector<std::pair<std::string, Containers::Array<char>>> exportFontBlob(AbstractFont& font, AbstractGlyphCache& cache, const std::string& filename, const std::u32string& characters, const std::unordered_map<UnsignedInt, UnsignedInt>& glyphIdMap, const std::vector<UnsignedInt>& inverseGlyphIdMap) {
+    const Image2D image = cache.image();
+    if(image.format() != PixelFormat::R8Unorm && image.format() != PixelFormat::RGBA8Unorm) {
+        Error{} << "Text::MagnumFontConverter::exportFontToData(): unsupported glyph cache image format" << image.format() << "for a binary font";
+        return {};
+    }
+
+    /* Character->glyph map sorted by codepoint, with duplicates removed, so
+       the font can do a binary search on it */
+    std::vector<Implementation::FontBlobChar> chars;
+    chars.reserve(characters.size());
+    for(const char32_t c: characters) {
+        const auto found = glyphIdMap.find(font.glyphId(c));
+        chars.push_back({UnsignedInt(c), found == glyphIdMap.end() ? 0 : found->second});
+    }
+    std::sort(chars.begin(), chars.end(),
+        [](const Implementation::FontBlobChar& a, const Implementation::FontBlobChar& b) {
+            return a.codepoint < b.codepoint;
+        });
+    chars.erase(std::unique(chars.begin(), chars.end(),
+        [](const Implementation::FontBlobChar& a, const Implementation::FontBlobChar& b) {
+            return a.codepoint == b.codepoint;
+        }), chars.end());
+
+    /* Image rows aligned to four bytes, matching the default pixel storage */
+    const std::size_t rowSize = (image.size().x()*image.pixelSize() + 3)/4*4;
+
+    Implementation::FontBlobHeader header{};
+    std::memcpy(header.magic, Implementation::FontBlobMagic, sizeof(header.magic));
+    header.version = Implementation::FontBlobVersion;
+    header.flags = Utility::Endianness::isBigEndian() ? Implementation::FontBlobFlagBigEndian : 0;
+    header.fontSize = font.size();
+    header.ascent = font.ascent();
+    header.descent = font.descent();
+    header.lineHeight = font.lineHeight();
+    header.originalImageSize = cache.textureSize();
+    header.padding = cache.padding();
+    header.imageSize = image.size();
+    header.imageFormat = UnsignedInt(image.format());
+    header.glyphCount = inverseGlyphIdMap.size();
+    header.glyphOffset = sizeof(Implementation::FontBlobHeader);
+    header.charCount = chars.size();
+    header.charOffset = header.glyphOffset + header.glyphCount*sizeof(Implementation::FontBlobGlyph);
+    header.imageDataOffset = header.charOffset + header.charCount*sizeof(Implementation::FontBlobChar);
+    header.imageDataSize = rowSize*image.size().y();
+
+    Containers::Array<char> data{ValueInit, header.imageDataOffset + header.imageDataSize};
+    *reinterpret_cast<Implementation::FontBlobHeader*>(data.data()) = header;
+
+    /* Glyph properties in order which preserves their IDs, with padding
+       removed the same way as in the text format */
+    Containers::ArrayView<Implementation::FontBlobGlyph> glyphs = Containers::arrayCast<Implementation::FontBlobGlyph>(data.slice(header.glyphOffset, header.charOffset));
+    for(std::size_t i = 0; i != inverseGlyphIdMap.size(); ++i) {
+        const std::pair<Vector2i, Range2Di> glyph = cache[inverseGlyphIdMap[i]];
+        glyphs[i].advance = font.glyphAdvance(inverseGlyphIdMap[i]);
+        glyphs[i].position = glyph.first + cache.padding();
+        glyphs[i].rectangle = glyph.second.padded(-cache.padding());
+    }
+
+    Utility::copy(Containers::arrayView(chars), Containers::arrayCast<Implementation::FontBlobChar>(data.slice(header.charOffset, header.imageDataOffset)));
+
+    Utility::copy(image.pixels(), MutableImageView2D{image.format(), image.size(), data.exceptPrefix(header.imageDataOffset)}.pixels());
+
+    std::vector<std::pair<std::string, Containers::Array<char>>> out;
+    out.emplace_back(filename, std::move(data));
+    return out;
+}
+
+}
+
 MagnumFontConverter::MagnumFontConverter() = default;
 
 MagnumFontConverter::MagnumFontConverter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractFontConverter{manager, plugin} {}
 
 FontConverterFeatures MagnumFontConverter::doFeatures() const {
-    return FontConverterFeature::ExportFont|FontConverterFeature::ConvertData|FontConverterFeature::MultiFile;
+    return FontConverterFeature::ExportFont|
+        FontConverterFeature::ExportGlyphCache|
+        #ifdef MAGNUM_TARGET_GL
+        FontConverterFeature::ImportGlyphCache|
+        #endif
+        FontConverterFeature::ConvertData|FontConverterFeature::MultiFile;
 }
 
 std::vector<std::pair<std::string, Containers::Array<char>>> MagnumFontConverter::doExportFontToData(AbstractFont& font, AbstractGlyphCache& cache, const std::string& filename, const std::u32string& characters) const {
@@ -57,33 +173,12 @@ std::vector<std::pair<std::string, Containers::Array<char>>> MagnumFontConverter
         return {};
     }
 
-    Utility::Configuration configuration;
-
-    configuration.setValue("version", 1);
-    configuration.setValue("image", Utility::Path::split(filename).second() + ".tga");
-    configuration.setValue("originalImageSize", cache.textureSize());
-    configuration.setValue("padding", cache.padding());
-    configuration.setValue("fontSize", font.size());
-    configuration.setValue("ascent", font.ascent());
-    configuration.setValue("descent", font.descent());
-    configuration.setValue("lineHeight", font.lineHeight());
-
-    /* Get the glyphs and sort them for predictable output */
-    std::vector<std::pair<UnsignedInt, std::pair<Vector2i, Range2Di>>> sortedGlyphs;
-    for(const std::pair<const UnsignedInt, std::pair<Vector2i, Range2Di>>& glyph: cache)
-        sortedGlyphs.emplace_back(glyph);
-    std::sort(sortedGlyphs.begin(), sortedGlyphs.end(),
-        [](const std::pair<UnsignedInt, std::pair<Vector2i, Range2Di>>& a,
-           const std::pair<UnsignedInt, std::pair<Vector2i, Range2Di>>& b) {
-            return a.first < b.first;
-        });
-
     /* Compress glyph IDs so the glyphs are in a consecutive array, glyph 0
        should stay at position 0 */
     std::unordered_map<UnsignedInt, UnsignedInt> glyphIdMap;
     glyphIdMap.reserve(cache.glyphCount());
     glyphIdMap.emplace(0, 0);
-    for(const std::pair<UnsignedInt, std::pair<Vector2i, Range2Di>>& glyph: sortedGlyphs)
+    for(const std::pair<UnsignedInt, std::pair<Vector2i, Range2Di>>& glyph: sortedGlyphs(cache))
         glyphIdMap.emplace(glyph.first, glyphIdMap.size());
 
     /** @todo Save only glyphs contained in @p characters */
@@ -93,6 +188,20 @@ std::vector<std::pair<std::string, Containers::Array<char>>> MagnumFontConverter
     for(const std::pair<const UnsignedInt, UnsignedInt>& map: glyphIdMap)
         inverseGlyphIdMap[map.second] = map.first;
 
+    if(Containers::StringView{filename}.hasSuffix(".magnum-font"))
+        return exportFontBlob(font, cache, filename, characters, glyphIdMap, inverseGlyphIdMap);
+
+    Utility::Configuration configuration;
+
+    configuration.setValue("version", 1);
+    configuration.setValue("image", Utility::Path::split(filename).second() + ".tga");
+    configuration.setValue("originalImageSize", cache.textureSize());
+    configuration.setValue("padding", cache.padding());
+    configuration.setValue("fontSize", font.size());
+    configuration.setValue("ascent", font.ascent());
+    configuration.setValue("descent", font.descent());
+    configuration.setValue("lineHeight", font.lineHeight());
+
     /* Character->glyph map, map glyph IDs to new ones */
     for(const char32_t c: characters) {
         Utility::ConfigurationGroup* group = configuration.addGroup("char");
@@ -115,22 +224,123 @@ std::vector<std::pair<std::string, Containers::Array<char>>> MagnumFontConverter
         group->setValue("rectangle", glyph.second.padded(-cache.padding()));
     }
 
-    std::ostringstream confOut;
-    configuration.save(confOut);
-    std::string confStr = confOut.str();
-    Containers::Array<char> confData{confStr.size()};
-    std::copy(confStr.begin(), confStr.end(), confData.begin());
-
     /* Save cache image */
     Containers::Optional<Containers::Array<char>> tgaData = Trade::TgaImageConverter().convertToData(cache.image());
     if(!tgaData) return {};
 
     std::vector<std::pair<std::string, Containers::Array<char>>> out;
-    out.emplace_back(filename + ".conf", std::move(confData));
+    out.emplace_back(filename + ".conf", configurationData(configuration));
+    out.emplace_back(filename + ".tga", *std::move(tgaData));
+    return out;
+}
+
+std::vector<std::pair<std::string, Containers::Array<char>>> MagnumFontConverter::doExportGlyphCacheToData(AbstractGlyphCache& cache, const std::string& filename) const {
+    if(!(cache.features() & GlyphCacheFeature::ImageDownload)) {
+        Error{} << "Text::MagnumFontConverter::exportGlyphCacheToData(): passed glyph cache doesn't support image download";
+        return {};
+    }
+
+    Utility::Configuration configuration;
+
+    configuration.setValue("version", 1);
+    configuration.setValue("image", Utility::Path::split(filename).second() + ".tga");
+    configuration.setValue("originalImageSize", cache.textureSize());
+    configuration.setValue("padding", cache.padding());
+
+    /* Unlike with exportFontToData(), the glyph IDs are kept as-is because
+       there's no font to remap them against. Padding is removed the same way
+       so importing can pass the values directly to insert(). */
+    for(const std::pair<UnsignedInt, std::pair<Vector2i, Range2Di>>& glyph: sortedGlyphs(cache)) {
+        Utility::ConfigurationGroup* group = configuration.addGroup("glyph");
+        group->setValue("id", glyph.first);
+        group->setValue("position", glyph.second.first + cache.padding());
+        group->setValue("rectangle", glyph.second.second.padded(-cache.padding()));
+    }
+
+    Containers::Optional<Containers::Array<char>> tgaData = Trade::TgaImageConverter().convertToData(cache.image());
+    if(!tgaData) return {};
+
+    std::vector<std::pair<std::string, Containers::Array<char>>> out;
+    out.emplace_back(filename + ".conf", configurationData(configuration));
     out.emplace_back(filename + ".tga", *std::move(tgaData));
     return out;
 }
 
+#ifdef MAGNUM_TARGET_GL
+Containers::Pointer<AbstractGlyphCache> MagnumFontConverter::doImportGlyphCacheFromData(const std::vector<std::pair<std::string, Containers::ArrayView<const char>>>& data) const {
+    /* The first file is the configuration, the image is looked up by name
+       among the rest */
+    std::istringstream in{std::string{data[0].second.data(), data[0].second.size()}};
+    Utility::Configuration configuration{in, Utility::Configuration::Flag::SkipComments};
+    if(!configuration.isValid() || configuration.isEmpty()) {
+        Error{} << "Text::MagnumFontConverter::importGlyphCacheFromData(): glyph cache file is not valid";
+        return nullptr;
+    }
+    if(configuration.value<UnsignedInt>("version") != 1) {
+        Error{} << "Text::MagnumFontConverter::importGlyphCacheFromData(): unsupported file version, expected 1 but got"
+            << configuration.value<UnsignedInt>("version");
+        return nullptr;
+    }
+
+    const std::string imageName = configuration.value("image");
+    Containers::ArrayView<const char> imageData;
+    bool imageFound = false;
+    for(std::size_t i = 1; i < data.size(); ++i) {
+        if(Utility::Path::split(data[i].first).second() != imageName) continue;
+        imageData = data[i].second;
+        imageFound = true;
+        break;
+    }
+    if(!imageFound) {
+        Error{} << "Text::MagnumFontConverter::importGlyphCacheFromData(): image file" << imageName << "not found";
+        return nullptr;
+    }
+
+    /* TgaImporter prints a message on its own if anything goes wrong */
+    Trade::TgaImporter importer;
+    if(!importer.openData(imageData)) return nullptr;
+    Containers::Optional<Trade::ImageData2D> image = importer.image2D(0);
+    if(!image) return nullptr;
+
+    /* Pick the texture format based on the image so prebuilt multi-channel
+       caches survive the round trip as well */
+    Containers::Pointer<AbstractGlyphCache> cache{new GlyphCache{
+        GL::textureFormat(image->format()),
+        configuration.value<Vector2i>("originalImageSize"),
+        image->size(),
+        configuration.value<Vector2i>("padding")}};
+    cache->setImage({}, *image);
+
+    for(const Utility::ConfigurationGroup* group: configuration.groups("glyph"))
+        cache->insert(group->value<UnsignedInt>("id"), group->value<Vector2i>("position"), group->value<Range2Di>("rectangle"));
+
+    return cache;
+}
+
+Containers::Pointer<AbstractGlyphCache> MagnumFontConverter::doImportGlyphCacheFromFile(const std::string& filename) const {
+    const Containers::Optional<Containers::Array<char>> confData = Utility::Path::read(filename);
+    if(!confData) {
+        Error{} << "Text::MagnumFontConverter::importGlyphCacheFromFile(): cannot open file" << filename;
+        return nullptr;
+    }
+
+    /* Peek into the configuration to know which image file to load. Errors
+       in the file itself are reported by doImportGlyphCacheFromData(). */
+    std::istringstream in{std::string{confData->data(), confData->size()}};
+    const Utility::Configuration configuration{in, Utility::Configuration::Flag::SkipComments};
+    const std::string imageFilename = Utility::Path::join(Utility::Path::split(filename).first(), configuration.value("image"));
+    const Containers::Optional<Containers::Array<char>> imageData = Utility::Path::read(imageFilename);
+    if(!imageData) {
+        Error{} << "Text::MagnumFontConverter::importGlyphCacheFromFile(): cannot open file" << imageFilename;
+        return nullptr;
+    }
+
+    return doImportGlyphCacheFromData({
+        {filename, *confData},
+        {imageFilename, *imageData}});
+}
+#endif
+
 }}
 
 CORRADE_PLUGIN_REGISTER(MagnumFontConverter, Magnum::Text::MagnumFontConverter,
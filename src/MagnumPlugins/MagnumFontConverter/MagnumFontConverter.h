@@ -58,10 +58,54 @@ Expects filename prefix, creates two files, `prefix.conf` and `prefix.tga`. See
 @ref MagnumFont for more information about the font. The plugin requires the
 passed @ref AbstractGlyphCache to support @ref GlyphCacheFeature::ImageDownload.
 
+@section Text-MagnumFontConverter-binary Binary font export
+
+If the filename passed to @ref exportFontToFile() ends with `.magnum-font`,
+a single binary file is created instead, containing the glyph table, a sorted
+character table and the glyph cache image. See
+@ref Text-MagnumFont-binary "MagnumFont" for details. Only
+@ref PixelFormat::R8Unorm and @ref PixelFormat::RGBA8Unorm glyph cache images
+are supported in this case. The font API doesn't provide any kerning
+information, so none is saved.
+
+@section Text-MagnumFontConverter-glyph-cache Glyph cache export and import
+
+Besides whole fonts, the plugin can save just the glyph cache using
+@ref exportGlyphCacheToFile() and load it back with
+@ref importGlyphCacheFromFile(), which avoids rasterizing and packing all
+glyphs again on every application startup. The output is again a pair of
+`prefix.conf` and `prefix.tga` files, the configuration contains the original
+texture size, padding and a `[glyph]` group with original glyph ID, position
+and rectangle for each glyph in the cache:
+
+@code{.ini}
+version=1
+image=prefix.tga
+originalImageSize=1536 1536
+padding=24 24
+[glyph]
+id=0
+position=24 24
+rectangle=24 24 -24 -24
+[glyph]
+id=1
+position=25 12
+rectangle=16 4 64 32
+@endcode
+
+@snippet MagnumText.cpp MagnumFontConverter-glyph-cache
+
+The imported cache is always a @ref GlyphCache with internal texture format
+matching the saved image, so a previously processed
+@ref DistanceFieldGlyphCache can be loaded back directly and used for
+rendering. Glyph cache import is available only if Magnum is built with
+@ref MAGNUM_TARGET_GL enabled.
+
 @section Text-MagnumFontConverter-usage Usage
 
-This plugin depends on the @ref Text library and the
-@ref Trade::TgaImageConverter "TgaImageConverter" plugin. It is built if
+This plugin depends on the @ref Text library, the
+@ref Trade::TgaImageConverter "TgaImageConverter" and
+@ref Trade::TgaImporter "TgaImporter" plugins. It is built if
 `MAGNUM_WITH_MAGNUMFONTCONVERTER` is enabled when building Magnum. To use as a
 dynamic plugin, load @cpp "MagnumFontConverter" @ce via
 @ref Corrade::PluginManager::Manager.
@@ -87,8 +131,9 @@ find_package(Magnum REQUIRED MagnumFontConverter)
 target_link_libraries(your-app PRIVATE Magnum::MagnumFontConverter)
 @endcode
 
-Because the plugin needs access to @ref Trade::AbstractImageConverter plugins,
-you need to instantiate a manager for them and register it with
+Because the plugin needs access to @ref Trade::AbstractImageConverter and
+@ref Trade::AbstractImporter plugins, you need to instantiate managers for them
+and register them with
 @ref Corrade::PluginManager::Manager::registerExternalManager():
 
 @snippet plugins.cpp MagnumFontConverter-imageconverter-register
@@ -106,6 +151,11 @@ class MAGNUM_MAGNUMFONTCONVERTER_EXPORT MagnumFontConverter: public Text::Abstra
     private:
         MAGNUM_MAGNUMFONTCONVERTER_LOCAL FontConverterFeatures doFeatures() const override;
         MAGNUM_MAGNUMFONTCONVERTER_LOCAL std::vector<std::pair<std::string, Containers::Array<char>>> doExportFontToData(AbstractFont& font, AbstractGlyphCache& cache, const std::string& filename, const std::u32string& characters) const override;
+        MAGNUM_MAGNUMFONTCONVERTER_LOCAL std::vector<std::pair<std::string, Containers::Array<char>>> doExportGlyphCacheToData(AbstractGlyphCache& cache, const std::string& filename) const override;
+        #ifdef MAGNUM_TARGET_GL
+        MAGNUM_MAGNUMFONTCONVERTER_LOCAL Containers::Pointer<AbstractGlyphCache> doImportGlyphCacheFromData(const std::vector<std::pair<std::string, Containers::ArrayView<const char>>>& data) const override;
+        MAGNUM_MAGNUMFONTCONVERTER_LOCAL Containers::Pointer<AbstractGlyphCache> doImportGlyphCacheFromFile(const std::string& filename) const override;
+        #endif
 };
 
 }}
@@ -0,0 +1,190 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/Containers/StringStl.h> /** @todo remove once AbstractFontConverter is <string>-free */
+#include <Corrade/TestSuite/Compare/String.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Path.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Text/AbstractFontConverter.h"
+#include "Magnum/Text/AbstractGlyphCache.h"
+#include "Magnum/Trade/AbstractImageConverter.h"
+#include "Magnum/Trade/AbstractImporter.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Text { namespace Test { namespace {
+
+struct MagnumFontConverterGLTest: GL::OpenGLTester {
+    explicit MagnumFontConverterGLTest();
+
+    void importGlyphCacheFromData();
+    void importGlyphCacheFromFile();
+    void importGlyphCacheFromFileNotFound();
+    void importGlyphCacheInvalid();
+    void importGlyphCacheUnsupportedVersion();
+    void importGlyphCacheImageNotFound();
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<Trade::AbstractImageConverter> _imageConverterManager{"nonexistent"};
+    PluginManager::Manager<Trade::AbstractImporter> _importerManager{"nonexistent"};
+    PluginManager::Manager<AbstractFontConverter> _fontConverterManager{"nonexistent"};
+};
+
+/* Cache with a recognizable glyph set, the image contents don't matter */
+struct ExportedCache: AbstractGlyphCache {
+    explicit ExportedCache(): AbstractGlyphCache{Vector2i{1536}, Vector2i{24}} {
+        insert(2, {25, 34}, {{0, 8}, {16, 128}});
+        insert(1, {25, 12}, {{16, 4}, {64, 32}});
+    }
+
+    GlyphCacheFeatures doFeatures() const override { return GlyphCacheFeature::ImageDownload; }
+    void doSetImage(const Vector2i&, const ImageView2D&) override {}
+    Image2D doImage() override {
+        return Image2D{PixelFormat::R8Unorm, Vector2i{256}, Containers::Array<char>{ValueInit, 256*256}};
+    }
+};
+
+MagnumFontConverterGLTest::MagnumFontConverterGLTest() {
+    addTests({&MagnumFontConverterGLTest::importGlyphCacheFromData,
+              &MagnumFontConverterGLTest::importGlyphCacheFromFile,
+              &MagnumFontConverterGLTest::importGlyphCacheFromFileNotFound,
+              &MagnumFontConverterGLTest::importGlyphCacheInvalid,
+              &MagnumFontConverterGLTest::importGlyphCacheUnsupportedVersion,
+              &MagnumFontConverterGLTest::importGlyphCacheImageNotFound});
+
+    /* Load the plugins directly from the build tree. Otherwise they are static
+       and already loaded. */
+    _fontConverterManager.registerExternalManager(_imageConverterManager);
+    _fontConverterManager.registerExternalManager(_importerManager);
+    #if defined(TGAIMAGECONVERTER_PLUGIN_FILENAME) && defined(TGAIMPORTER_PLUGIN_FILENAME) && defined(MAGNUMFONTCONVERTER_PLUGIN_FILENAME)
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_imageConverterManager.load(TGAIMAGECONVERTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_importerManager.load(TGAIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_fontConverterManager.load(MAGNUMFONTCONVERTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+
+    /* Create the output directory if it doesn't exist yet */
+    CORRADE_INTERNAL_ASSERT_OUTPUT(Utility::Path::make(MAGNUMFONTCONVERTER_TEST_WRITE_DIR));
+}
+
+void MagnumFontConverterGLTest::importGlyphCacheFromData() {
+    ExportedCache exported;
+
+    Containers::Pointer<AbstractFontConverter> converter = _fontConverterManager.instantiate("MagnumFontConverter");
+    std::vector<std::pair<std::string, Containers::Array<char>>> data = converter->exportGlyphCacheToData(exported, "cache");
+    CORRADE_COMPARE(data.size(), 2);
+
+    Containers::Pointer<AbstractGlyphCache> cache = converter->importGlyphCacheFromData({
+        {data[0].first, data[0].second},
+        {data[1].first, data[1].second}});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(cache);
+    CORRADE_COMPARE(cache->textureSize(), Vector2i{1536});
+    CORRADE_COMPARE(cache->padding(), Vector2i{24});
+    CORRADE_COMPARE(cache->glyphCount(), 3);
+
+    /* The values should be exactly the same as in the original, with padding
+       applied only once */
+    for(UnsignedInt glyph: {0, 1, 2}) {
+        CORRADE_ITERATION(glyph);
+        CORRADE_COMPARE((*cache)[glyph].first, exported[glyph].first);
+        CORRADE_COMPARE((*cache)[glyph].second, exported[glyph].second);
+    }
+}
+
+void MagnumFontConverterGLTest::importGlyphCacheFromFile() {
+    ExportedCache exported;
+
+    Containers::Pointer<AbstractFontConverter> converter = _fontConverterManager.instantiate("MagnumFontConverter");
+    CORRADE_VERIFY(converter->exportGlyphCacheToFile(exported, Utility::Path::join(MAGNUMFONTCONVERTER_TEST_WRITE_DIR, "glyphcache-import")));
+
+    /* The image is found relative to the configuration file */
+    Containers::Pointer<AbstractGlyphCache> cache = converter->importGlyphCacheFromFile(Utility::Path::join(MAGNUMFONTCONVERTER_TEST_WRITE_DIR, "glyphcache-import.conf"));
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(cache);
+    CORRADE_COMPARE(cache->textureSize(), Vector2i{1536});
+    CORRADE_COMPARE(cache->padding(), Vector2i{24});
+    CORRADE_COMPARE(cache->glyphCount(), 3);
+    CORRADE_COMPARE((*cache)[2].first, exported[2].first);
+    CORRADE_COMPARE((*cache)[2].second, exported[2].second);
+}
+
+void MagnumFontConverterGLTest::importGlyphCacheFromFileNotFound() {
+    Containers::Pointer<AbstractFontConverter> converter = _fontConverterManager.instantiate("MagnumFontConverter");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!converter->importGlyphCacheFromFile("nonexistent.conf"));
+    /* There's an error from Path::read() before */
+    CORRADE_COMPARE_AS(out.str(),
+        "\nText::MagnumFontConverter::importGlyphCacheFromFile(): cannot open file nonexistent.conf\n",
+        TestSuite::Compare::StringHasSuffix);
+}
+
+void MagnumFontConverterGLTest::importGlyphCacheInvalid() {
+    Containers::Pointer<AbstractFontConverter> converter = _fontConverterManager.instantiate("MagnumFontConverter");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!converter->importGlyphCacheFromData({
+        {"cache.conf", {}}}));
+    CORRADE_COMPARE(out.str(), "Text::MagnumFontConverter::importGlyphCacheFromData(): glyph cache file is not valid\n");
+}
+
+void MagnumFontConverterGLTest::importGlyphCacheUnsupportedVersion() {
+    Containers::Pointer<AbstractFontConverter> converter = _fontConverterManager.instantiate("MagnumFontConverter");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!converter->importGlyphCacheFromData({
+        {"cache.conf", Containers::StringView{"version=2\nimage=cache.tga\n"}}}));
+    CORRADE_COMPARE(out.str(), "Text::MagnumFontConverter::importGlyphCacheFromData(): unsupported file version, expected 1 but got 2\n");
+}
+
+void MagnumFontConverterGLTest::importGlyphCacheImageNotFound() {
+    Containers::Pointer<AbstractFontConverter> converter = _fontConverterManager.instantiate("MagnumFontConverter");
+
+    Containers::Optional<Containers::Array<char>> conf = Utility::Path::read(Utility::Path::join(MAGNUMFONTCONVERTER_TEST_DIR, "glyphcache.conf"));
+    CORRADE_VERIFY(conf);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!converter->importGlyphCacheFromData({
+        {"glyphcache.conf", *conf},
+        {"font.tga", {}}}));
+    CORRADE_COMPARE(out.str(), "Text::MagnumFontConverter::importGlyphCacheFromData(): image file glyphcache.tga not found\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Text::Test::MagnumFontConverterGLTest)
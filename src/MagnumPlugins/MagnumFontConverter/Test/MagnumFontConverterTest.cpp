@@ -25,8 +25,11 @@
 
 #include <sstream>
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Containers/StringStl.h> /** @todo remove once AbstractFont is <string>-free */
+#include <Corrade/Containers/StringView.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/TestSuite/Compare/File.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Path.h>
@@ -39,6 +42,7 @@
 #include "Magnum/Trade/AbstractImageConverter.h"
 #include "Magnum/Trade/AbstractImporter.h"
 #include "Magnum/Trade/ImageData.h"
+#include "MagnumPlugins/MagnumFont/FontBlob.h"
 
 #include "configure.h"
 
@@ -49,6 +53,9 @@ struct MagnumFontConverterTest: TestSuite::Tester {
 
     void exportFont();
     void exportFontNoGlyphCacheImageDownload();
+    void exportFontBinary();
+    void exportGlyphCache();
+    void exportGlyphCacheNoGlyphCacheImageDownload();
 
     /* Explicitly forbid system-wide plugin dependencies */
     PluginManager::Manager<Trade::AbstractImageConverter> _imageConverterManager{"nonexistent"};
@@ -58,18 +65,19 @@ struct MagnumFontConverterTest: TestSuite::Tester {
 
 MagnumFontConverterTest::MagnumFontConverterTest() {
     addTests({&MagnumFontConverterTest::exportFont,
-              &MagnumFontConverterTest::exportFontNoGlyphCacheImageDownload});
+              &MagnumFontConverterTest::exportFontNoGlyphCacheImageDownload,
+              &MagnumFontConverterTest::exportFontBinary,
+              &MagnumFontConverterTest::exportGlyphCache,
+              &MagnumFontConverterTest::exportGlyphCacheNoGlyphCacheImageDownload});
 
     /* Load the plugins directly from the build tree. Otherwise they are static
        and already loaded. */
     _fontConverterManager.registerExternalManager(_imageConverterManager);
-    #if defined(TGAIMAGECONVERTER_PLUGIN_FILENAME) && defined(MAGNUMFONTCONVERTER_PLUGIN_FILENAME)
+    _fontConverterManager.registerExternalManager(_importerManager);
+    #if defined(TGAIMAGECONVERTER_PLUGIN_FILENAME) && defined(TGAIMPORTER_PLUGIN_FILENAME) && defined(MAGNUMFONTCONVERTER_PLUGIN_FILENAME)
     CORRADE_INTERNAL_ASSERT_OUTPUT(_imageConverterManager.load(TGAIMAGECONVERTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
-    CORRADE_INTERNAL_ASSERT_OUTPUT(_fontConverterManager.load(MAGNUMFONTCONVERTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
-    #endif
-    /* Optional plugins that don't have to be here */
-    #ifdef TGAIMPORTER_PLUGIN_FILENAME
     CORRADE_INTERNAL_ASSERT_OUTPUT(_importerManager.load(TGAIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_fontConverterManager.load(MAGNUMFONTCONVERTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
     #endif
 
     /* Create the output directory if it doesn't exist yet */
@@ -145,9 +153,6 @@ void MagnumFontConverterTest::exportFont() {
         Utility::Path::join(MAGNUMFONT_TEST_DIR, "font.conf"),
         TestSuite::Compare::File);
 
-    if(!(_importerManager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
-        CORRADE_SKIP("TgaImporter plugin not enabled, not testing glyph cache contents");
-
     /* Verify font image, no need to test image contents, as the image is
        garbage anyway */
     Containers::Pointer<Trade::AbstractImporter> importer = _importerManager.instantiate("TgaImporter");
@@ -187,6 +192,153 @@ void MagnumFontConverterTest::exportFontNoGlyphCacheImageDownload() {
     CORRADE_COMPARE(out.str(), "Text::MagnumFontConverter::exportFontToData(): passed glyph cache doesn't support image download\n");
 }
 
+void MagnumFontConverterTest::exportFontBinary() {
+    Containers::String filename = Utility::Path::join(MAGNUMFONTCONVERTER_TEST_WRITE_DIR, "font.magnum-font");
+    if(Utility::Path::exists(filename))
+        CORRADE_VERIFY(Utility::Path::remove(filename));
+
+    /* Same font and cache as in exportFont(), but with an image that has
+       padded rows */
+    struct MyFont: AbstractFont {
+        FontFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return _opened; }
+        void doClose() override { _opened = false; }
+        Metrics doOpenFile(const std::string&, Float) override {
+            _opened = true;
+            return {16.0f, 25.0f, -10.0f, 39.7333f};
+        }
+
+        UnsignedInt doGlyphId(const char32_t character) override {
+            return character == 'W' ? 2 : character == 'e' ? 1 : 0;
+        }
+        Vector2 doGlyphAdvance(const UnsignedInt glyph) override {
+            return {glyph == 2 ? 23.0f : glyph == 1 ? 12.0f : 8.0f, 0.0f};
+        }
+        Containers::Pointer<AbstractLayouter> doLayout(const AbstractGlyphCache&, Float, const std::string&) override {
+            return nullptr;
+        }
+
+        bool _opened = false;
+    } font;
+    font.openFile({}, {});
+
+    struct MyCache: AbstractGlyphCache {
+        explicit MyCache(): AbstractGlyphCache{Vector2i{1536}, Vector2i{24}} {}
+
+        GlyphCacheFeatures doFeatures() const override { return GlyphCacheFeature::ImageDownload; }
+        void doSetImage(const Vector2i&, const ImageView2D&) override {}
+        Image2D doImage() override {
+            /* 3x2 pixels, rows padded to four bytes, padding filled with
+               garbage that shouldn't get copied */
+            Containers::Array<char> data{NoInit, 4*2};
+            for(std::size_t i = 0; i != data.size(); ++i) data[i] = i;
+            return Image2D{PixelFormat::R8Unorm, {3, 2}, std::move(data)};
+        }
+    } cache;
+    cache.insert(font.glyphId(U'W'), {25, 34}, {{0, 8}, {16, 128}});
+    cache.insert(font.glyphId(U'e'), {25, 12}, {{16, 4}, {64, 32}});
+
+    Containers::Pointer<AbstractFontConverter> converter = _fontConverterManager.instantiate("MagnumFontConverter");
+    /* Characters out of order and with a duplicate */
+    CORRADE_VERIFY(converter->exportFontToFile(font, cache, filename, "eWvae"));
+
+    /* Just a single file, no TGA */
+    CORRADE_VERIFY(!Utility::Path::exists(Utility::Path::join(MAGNUMFONTCONVERTER_TEST_WRITE_DIR, "font.magnum-font.tga")));
+
+    Containers::Optional<Containers::Array<char>> data = Utility::Path::read(filename);
+    CORRADE_VERIFY(data);
+    CORRADE_COMPARE(data->size(), 76 + 3*32 + 4*8 + 4*2);
+
+    const auto& header = *reinterpret_cast<const Implementation::FontBlobHeader*>(data->data());
+    CORRADE_COMPARE(Containers::StringView(header.magic, 4), "MGFB");
+    CORRADE_COMPARE(header.version, 1);
+    CORRADE_COMPARE(header.fontSize, 16.0f);
+    CORRADE_COMPARE(header.lineHeight, 39.7333f);
+    CORRADE_COMPARE(header.originalImageSize, Vector2i{1536});
+    CORRADE_COMPARE(header.padding, Vector2i{24});
+    CORRADE_COMPARE(header.imageSize, (Vector2i{3, 2}));
+    CORRADE_COMPARE(PixelFormat(header.imageFormat), PixelFormat::R8Unorm);
+    CORRADE_COMPARE(header.glyphCount, 3);
+    CORRADE_COMPARE(header.charCount, 4);
+
+    /* Glyph IDs are compressed and padding removed, same as in the text
+       format */
+    Containers::ArrayView<const Implementation::FontBlobGlyph> glyphs = Containers::arrayCast<const Implementation::FontBlobGlyph>(data->slice(header.glyphOffset, header.charOffset));
+    CORRADE_COMPARE_AS(Containers::stridedArrayView(glyphs).slice(&Implementation::FontBlobGlyph::advance),
+        Containers::arrayView<Vector2>({{8.0f, 0.0f}, {12.0f, 0.0f}, {23.0f, 0.0f}}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(glyphs[1].position, (Vector2i{25, 12}));
+    CORRADE_COMPARE(glyphs[1].rectangle, (Range2Di{{16, 4}, {64, 32}}));
+
+    /* Characters are sorted and deduplicated */
+    Containers::ArrayView<const Implementation::FontBlobChar> chars = Containers::arrayCast<const Implementation::FontBlobChar>(data->slice(header.charOffset, header.imageDataOffset));
+    CORRADE_COMPARE_AS(Containers::stridedArrayView(chars).slice(&Implementation::FontBlobChar::codepoint),
+        Containers::arrayView<UnsignedInt>({'W', 'a', 'e', 'v'}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::stridedArrayView(chars).slice(&Implementation::FontBlobChar::glyph),
+        Containers::arrayView<UnsignedInt>({2, 0, 1, 0}),
+        TestSuite::Compare::Container);
+
+    CORRADE_COMPARE(header.imageDataSize, 8);
+    CORRADE_COMPARE_AS(data->slice(header.imageDataOffset, header.imageDataOffset + header.imageDataSize),
+        Containers::arrayView<char>({0, 1, 2, 0, 4, 5, 6, 0}),
+        TestSuite::Compare::Container);
+}
+
+void MagnumFontConverterTest::exportGlyphCache() {
+    Containers::String confFilename = Utility::Path::join(MAGNUMFONTCONVERTER_TEST_WRITE_DIR, "glyphcache.conf");
+    Containers::String tgaFilename = Utility::Path::join(MAGNUMFONTCONVERTER_TEST_WRITE_DIR, "glyphcache.tga");
+    /* Remove previously created files */
+    if(Utility::Path::exists(confFilename))
+        CORRADE_VERIFY(Utility::Path::remove(confFilename));
+    if(Utility::Path::exists(tgaFilename))
+        CORRADE_VERIFY(Utility::Path::remove(tgaFilename));
+
+    /* Same cache as in exportFont(), no font needed this time */
+    struct MyCache: AbstractGlyphCache {
+        explicit MyCache(): AbstractGlyphCache{Vector2i{1536}, Vector2i{24}} {}
+
+        GlyphCacheFeatures doFeatures() const override { return GlyphCacheFeature::ImageDownload; }
+        void doSetImage(const Vector2i&, const ImageView2D&) override {}
+        Image2D doImage() override {
+            return Image2D{PixelFormat::R8Unorm, Vector2i{256}, Containers::Array<char>{ValueInit, 256*256}};
+        }
+    } cache;
+    cache.insert(2, {25, 34}, {{0, 8}, {16, 128}});
+    cache.insert(1, {25, 12}, {{16, 4}, {64, 32}});
+
+    Containers::Pointer<AbstractFontConverter> converter = _fontConverterManager.instantiate("MagnumFontConverter");
+    CORRADE_VERIFY(converter->exportGlyphCacheToFile(cache, Utility::Path::join(MAGNUMFONTCONVERTER_TEST_WRITE_DIR, "glyphcache")));
+
+    /* Glyphs are sorted by their original ID, padding is removed */
+    CORRADE_COMPARE_AS(confFilename,
+        Utility::Path::join(MAGNUMFONTCONVERTER_TEST_DIR, "glyphcache.conf"),
+        TestSuite::Compare::File);
+
+    Containers::Pointer<Trade::AbstractImporter> importer = _importerManager.instantiate("TgaImporter");
+    CORRADE_VERIFY(importer->openFile(tgaFilename));
+    Containers::Optional<Trade::ImageData2D> image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->size(), Vector2i(256));
+    CORRADE_COMPARE(image->format(), PixelFormat::R8Unorm);
+}
+
+void MagnumFontConverterTest::exportGlyphCacheNoGlyphCacheImageDownload() {
+    struct DummyGlyphCache: AbstractGlyphCache {
+        using AbstractGlyphCache::AbstractGlyphCache;
+
+        GlyphCacheFeatures doFeatures() const override { return {}; }
+        void doSetImage(const Vector2i&, const ImageView2D&) override {}
+    } cache{{100, 100}};
+
+    Containers::Pointer<AbstractFontConverter> converter = _fontConverterManager.instantiate("MagnumFontConverter");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!converter->exportGlyphCacheToFile(cache, Utility::Path::join(MAGNUMFONTCONVERTER_TEST_WRITE_DIR, "glyphcache")));
+    CORRADE_COMPARE(out.str(), "Text::MagnumFontConverter::exportGlyphCacheToData(): passed glyph cache doesn't support image download\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Text::Test::MagnumFontConverterTest)
@@ -26,5 +26,6 @@
 #cmakedefine MAGNUMFONTCONVERTER_PLUGIN_FILENAME "${MAGNUMFONTCONVERTER_PLUGIN_FILENAME}"
 #cmakedefine TGAIMAGECONVERTER_PLUGIN_FILENAME "${TGAIMAGECONVERTER_PLUGIN_FILENAME}"
 #cmakedefine TGAIMPORTER_PLUGIN_FILENAME "${TGAIMPORTER_PLUGIN_FILENAME}"
+#define MAGNUMFONTCONVERTER_TEST_DIR "${MAGNUMFONTCONVERTER_TEST_DIR}"
 #define MAGNUMFONTCONVERTER_TEST_WRITE_DIR "${MAGNUMFONTCONVERTER_TEST_WRITE_DIR}"
 #define MAGNUMFONT_TEST_DIR "${MAGNUMFONT_TEST_DIR}"
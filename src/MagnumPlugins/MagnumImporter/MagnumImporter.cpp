@@ -0,0 +1,255 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MagnumImporter.h"
+
+#include <cstring>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/Endianness.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/VertexFormat.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/MeshTools/Codec.h"
+#include "Magnum/Trade/MeshData.h"
+#include "MagnumPlugins/MagnumImporter/MeshBlob.h"
+
+namespace Magnum { namespace Trade {
+
+namespace {
+
+/* Returns false if a strided view of `count` items of `size` bytes starting
+   at `offset` with `stride` doesn't fit into `dataSize` bytes */
+bool viewInBounds(const UnsignedLong offset, const UnsignedInt count, const Int stride, const std::size_t size, const UnsignedLong dataSize) {
+    if(!count) return offset <= dataSize;
+
+    const Long span = Long(count - 1)*stride;
+    const Long begin = Long(offset) + Math::min(span, Long{});
+    const Long end = Long(offset) + Math::max(span, Long{}) + Long(size);
+    return offset <= dataSize && begin >= 0 && UnsignedLong(end) <= dataSize;
+}
+
+Implementation::MeshBlobHeader blobHeader(const Containers::ArrayView<const char> data) {
+    /* The data may not be aligned when they're not zero-copy */
+    Implementation::MeshBlobHeader header;
+    std::memcpy(&header, data.data(), sizeof(header));
+    return header;
+}
+
+}
+
+MagnumImporter::MagnumImporter() = default;
+
+MagnumImporter::MagnumImporter(PluginManager::AbstractManager& manager, const Containers::StringView& plugin): AbstractImporter{manager, plugin} {}
+
+MagnumImporter::~MagnumImporter() = default;
+
+ImporterFeatures MagnumImporter::doFeatures() const { return ImporterFeature::OpenData|ImporterFeature::ThreadSafeImport; }
+
+bool MagnumImporter::doIsOpened() const { return _in; }
+
+void MagnumImporter::doClose() { _in = nullptr; }
+
+void MagnumImporter::doOpenData(Containers::Array<char>&& data, const DataFlags dataFlags) {
+    if(data.size() < sizeof(Implementation::MeshBlobHeader)) {
+        Error{} << "Trade::MagnumImporter::openData(): file too short, expected at least" << sizeof(Implementation::MeshBlobHeader) << "bytes but got" << data.size();
+        return;
+    }
+
+    const Implementation::MeshBlobHeader header = blobHeader(data);
+    if(std::memcmp(header.magic, Implementation::MeshBlobMagic, sizeof(header.magic)) != 0) {
+        Error{} << "Trade::MagnumImporter::openData(): invalid file signature";
+        return;
+    }
+    if(header.version != Implementation::MeshBlobVersion) {
+        Error{} << "Trade::MagnumImporter::openData(): unsupported file version" << header.version << Debug::nospace << ", expected" << Implementation::MeshBlobVersion;
+        return;
+    }
+    if(bool(header.flags & Implementation::MeshBlobFlagBigEndian) != Utility::Endianness::isBigEndian()) {
+        Error{} << "Trade::MagnumImporter::openData(): file is" << (header.flags & Implementation::MeshBlobFlagBigEndian ? "big-endian" : "little-endian") << "but the machine is not";
+        return;
+    }
+    if(header.flags & ~(Implementation::MeshBlobFlagBigEndian|Implementation::MeshBlobFlagCompressed)) {
+        Error{} << "Trade::MagnumImporter::openData(): unsupported flags" << reinterpret_cast<void*>(header.flags);
+        return;
+    }
+    const bool compressed = header.flags & Implementation::MeshBlobFlagCompressed;
+
+    /* Check that all data are in bounds. Done upfront so doMesh() can just
+       wrap the data without any further checks. */
+    const std::size_t attributeTableEnd = sizeof(Implementation::MeshBlobHeader) + std::size_t(header.attributeCount)*sizeof(Implementation::MeshBlobAttribute);
+    if(attributeTableEnd > data.size()) {
+        Error{} << "Trade::MagnumImporter::openData(): file too short, expected at least" << attributeTableEnd << "bytes for" << header.attributeCount << "attributes but got" << data.size();
+        return;
+    }
+    if(header.indexDataOffset > data.size() || header.indexDataSize > data.size() - header.indexDataOffset) {
+        Error{} << "Trade::MagnumImporter::openData(): index data of" << header.indexDataSize << "bytes at offset" << header.indexDataOffset << "out of bounds for" << data.size() << "bytes";
+        return;
+    }
+    if(header.vertexDataOffset > data.size() || header.vertexDataSize > data.size() - header.vertexDataOffset) {
+        Error{} << "Trade::MagnumImporter::openData(): vertex data of" << header.vertexDataSize << "bytes at offset" << header.vertexDataOffset << "out of bounds for" << data.size() << "bytes";
+        return;
+    }
+
+    /* For compressed files the layout is checked against the size of the
+       decoded data, the encoded data get checked during decoding */
+    UnsignedLong indexDataSize = header.indexDataSize;
+    UnsignedLong vertexDataSize = header.vertexDataSize;
+    if(compressed) {
+        indexDataSize = header.indexType && header.indexType <= UnsignedInt(MeshIndexType::UnsignedInt) ? UnsignedLong(header.indexCount)*meshIndexTypeSize(MeshIndexType(header.indexType)) : 0;
+        vertexDataSize = UnsignedLong(header.vertexCount)*header.vertexStride;
+    }
+
+    if(header.indexType) {
+        if(header.indexType > UnsignedInt(MeshIndexType::UnsignedInt)) {
+            Error{} << "Trade::MagnumImporter::openData(): unsupported index type" << reinterpret_cast<void*>(header.indexType);
+            return;
+        }
+        if(header.indexStride < -32768 || header.indexStride > 32767 || !viewInBounds(header.indexOffset, header.indexCount, header.indexStride, meshIndexTypeSize(MeshIndexType(header.indexType)), indexDataSize)) {
+            Error{} << "Trade::MagnumImporter::openData():" << header.indexCount << "indices with a stride of" << header.indexStride << "at offset" << header.indexOffset << "out of bounds for" << indexDataSize << "bytes of index data";
+            return;
+        }
+    }
+
+    for(UnsignedInt i = 0; i != header.attributeCount; ++i) {
+        Implementation::MeshBlobAttribute attribute;
+        std::memcpy(&attribute, data.data() + sizeof(Implementation::MeshBlobHeader) + i*sizeof(Implementation::MeshBlobAttribute), sizeof(attribute));
+        const MeshAttribute name = MeshAttribute(attribute.name);
+        const VertexFormat format = VertexFormat(attribute.format);
+
+        if(!isVertexFormatImplementationSpecific(format) && (!attribute.format || attribute.format > UnsignedInt(VertexFormat::Matrix4x3sNormalizedAligned))) {
+            Error{} << "Trade::MagnumImporter::openData(): invalid format" << reinterpret_cast<void*>(attribute.format) << "for attribute" << i;
+            return;
+        }
+        if(!Implementation::isVertexFormatCompatibleWithAttribute(name, format)) {
+            Error{} << "Trade::MagnumImporter::openData():" << format << "is not a valid format for attribute" << i << "of type" << name;
+            return;
+        }
+        if(attribute.arraySize && (!isMeshAttributeCustom(name) || isVertexFormatImplementationSpecific(format))) {
+            Error{} << "Trade::MagnumImporter::openData(): attribute" << i << "of type" << name << "and format" << format << "can't be an array";
+            return;
+        }
+        if(attribute.stride < -32768 || attribute.stride > 32767 || (!isVertexFormatImplementationSpecific(format) && !viewInBounds(attribute.offset, header.vertexCount, attribute.stride, vertexFormatSize(format)*Math::max(attribute.arraySize, UnsignedShort{1}), vertexDataSize))) {
+            Error{} << "Trade::MagnumImporter::openData(): attribute" << i << "with a stride of" << attribute.stride << "at offset" << attribute.offset << "out of bounds for" << header.vertexCount << "vertices and" << vertexDataSize << "bytes of vertex data";
+            return;
+        }
+    }
+
+    /* Take over the existing array or copy the data if we can't. The data
+       can be referenced directly by the imported mesh only if they're
+       externally owned, suitably aligned and not compressed, in all other
+       cases the mesh gets a copy. */
+    _zeroCopy = !compressed && (dataFlags & DataFlag::ExternallyOwned) && reinterpret_cast<std::uintptr_t>(data.data()) % Implementation::MeshBlobDataAlignment == 0;
+    if(dataFlags & (DataFlag::Owned|DataFlag::ExternallyOwned)) {
+        _in = std::move(data);
+    } else {
+        _in = Containers::Array<char>{NoInit, data.size()};
+        Utility::copy(data, _in);
+    }
+}
+
+UnsignedInt MagnumImporter::doMeshCount() const { return 1; }
+
+Containers::Optional<MeshData> MagnumImporter::doMesh(UnsignedInt, UnsignedInt) {
+    const Implementation::MeshBlobHeader header = blobHeader(_in);
+
+    Containers::Array<MeshAttributeData> attributes{header.attributeCount};
+    for(UnsignedInt i = 0; i != header.attributeCount; ++i) {
+        Implementation::MeshBlobAttribute attribute;
+        std::memcpy(&attribute, _in.data() + sizeof(Implementation::MeshBlobHeader) + i*sizeof(Implementation::MeshBlobAttribute), sizeof(attribute));
+        attributes[i] = MeshAttributeData{MeshAttribute(attribute.name), VertexFormat(attribute.format), std::size_t(attribute.offset), header.vertexCount, attribute.stride, attribute.arraySize};
+    }
+
+    const Containers::ArrayView<const char> indexData = _in.slice(header.indexDataOffset, header.indexDataOffset + header.indexDataSize);
+    const Containers::ArrayView<const char> vertexData = _in.slice(header.vertexDataOffset, header.vertexDataOffset + header.vertexDataSize);
+    const MeshPrimitive primitive = MeshPrimitive(header.primitive);
+
+    /* Decode compressed data into new allocations */
+    if(header.flags & Implementation::MeshBlobFlagCompressed) {
+        MeshIndexData indices;
+        Containers::Array<char> decodedIndexData;
+        if(header.indexType) {
+            const MeshIndexType indexType = MeshIndexType(header.indexType);
+            decodedIndexData = Containers::Array<char>{NoInit, header.indexCount*meshIndexTypeSize(indexType)};
+            bool decoded = false;
+            switch(indexType) {
+                case MeshIndexType::UnsignedByte:
+                    decoded = MeshTools::decodeIndicesInto(indexData, Containers::arrayCast<UnsignedByte>(decodedIndexData));
+                    break;
+                case MeshIndexType::UnsignedShort:
+                    decoded = MeshTools::decodeIndicesInto(indexData, Containers::arrayCast<UnsignedShort>(decodedIndexData));
+                    break;
+                case MeshIndexType::UnsignedInt:
+                    decoded = MeshTools::decodeIndicesInto(indexData, Containers::arrayCast<UnsignedInt>(decodedIndexData));
+                    break;
+                default: CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+            }
+            if(!decoded) return {};
+
+            indices = MeshIndexData{indexType, Containers::StridedArrayView1D<const void>{decodedIndexData, decodedIndexData.data() + header.indexOffset, header.indexCount, header.indexStride}};
+        }
+
+        Containers::Array<char> decodedVertexData{NoInit, std::size_t(header.vertexCount)*header.vertexStride};
+        if(!MeshTools::decodeVerticesInto(vertexData, Containers::StridedArrayView2D<char>{decodedVertexData, {header.vertexCount, header.vertexStride}}))
+            return {};
+
+        return MeshData{primitive,
+            std::move(decodedIndexData), indices,
+            std::move(decodedVertexData), std::move(attributes),
+            header.vertexCount};
+    }
+
+    /* Reference the data directly */
+    if(_zeroCopy) {
+        MeshIndexData indices;
+        if(header.indexType) indices = MeshIndexData{MeshIndexType(header.indexType), Containers::StridedArrayView1D<const void>{indexData, indexData.data() + header.indexOffset, header.indexCount, header.indexStride}};
+
+        return MeshData{primitive,
+            DataFlags{}, indexData, indices,
+            DataFlags{}, vertexData, std::move(attributes),
+            header.vertexCount};
+    }
+
+    /* Otherwise make a copy */
+    Containers::Array<char> indexDataCopy{NoInit, indexData.size()};
+    Utility::copy(indexData, indexDataCopy);
+    Containers::Array<char> vertexDataCopy{NoInit, vertexData.size()};
+    Utility::copy(vertexData, vertexDataCopy);
+
+    MeshIndexData indices;
+    if(header.indexType) indices = MeshIndexData{MeshIndexType(header.indexType), Containers::StridedArrayView1D<const void>{indexDataCopy, indexDataCopy.data() + header.indexOffset, header.indexCount, header.indexStride}};
+
+    return MeshData{primitive,
+        std::move(indexDataCopy), indices,
+        std::move(vertexDataCopy), std::move(attributes),
+        header.vertexCount};
+}
+
+}}
+
+CORRADE_PLUGIN_REGISTER(MagnumImporter, Magnum::Trade::MagnumImporter,
+    "cz.mosra.magnum.Trade.AbstractImporter/0.5.1")
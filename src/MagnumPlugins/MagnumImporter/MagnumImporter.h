@@ -0,0 +1,146 @@
+#ifndef Magnum_Trade_MagnumImporter_h
+#define Magnum_Trade_MagnumImporter_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Trade::MagnumImporter
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/VisibilityMacros.h>
+
+#include "Magnum/Trade/AbstractImporter.h"
+
+#include "MagnumPlugins/MagnumImporter/configure.h"
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+#ifndef MAGNUM_MAGNUMIMPORTER_BUILD_STATIC
+    #ifdef MagnumImporter_EXPORTS
+        #define MAGNUM_MAGNUMIMPORTER_EXPORT CORRADE_VISIBILITY_EXPORT
+    #else
+        #define MAGNUM_MAGNUMIMPORTER_EXPORT CORRADE_VISIBILITY_IMPORT
+    #endif
+#else
+    #define MAGNUM_MAGNUMIMPORTER_EXPORT CORRADE_VISIBILITY_STATIC
+#endif
+#define MAGNUM_MAGNUMIMPORTER_LOCAL CORRADE_VISIBILITY_LOCAL
+#else
+#define MAGNUM_MAGNUMIMPORTER_EXPORT
+#define MAGNUM_MAGNUMIMPORTER_LOCAL
+#endif
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Magnum blob importer plugin
+@m_since_latest
+
+Imports native binary blobs (`*.blob`) produced by
+@ref MagnumSceneConverter. The format stores a single @ref MeshData with its
+index and vertex data laid out exactly as they're in memory, so importing
+is just a validation of the header followed by wrapping the data.
+
+@section Trade-MagnumImporter-usage Usage
+
+This plugin depends on the @ref Trade and @ref MeshTools libraries and is
+built if `MAGNUM_WITH_MAGNUMIMPORTER` is enabled when building Magnum. To use
+as a dynamic plugin, load @cpp "MagnumImporter" @ce via
+@ref Corrade::PluginManager::Manager.
+
+Additionally, if you're using Magnum as a CMake subproject, do the following:
+
+@code{.cmake}
+set(MAGNUM_WITH_MAGNUMIMPORTER ON CACHE BOOL "" FORCE)
+add_subdirectory(magnum EXCLUDE_FROM_ALL)
+
+# So the dynamically loaded plugin gets built implicitly
+add_dependencies(your-app Magnum::MagnumImporter)
+@endcode
+
+To use as a static plugin or as a dependency of another plugin with CMake, you
+need to request the `MagnumImporter` component of the `Magnum` package and
+link to the `Magnum::MagnumImporter` target:
+
+@code{.cmake}
+find_package(Magnum REQUIRED MagnumImporter)
+
+# ...
+target_link_libraries(your-app PRIVATE Magnum::MagnumImporter)
+@endcode
+
+See @ref building, @ref cmake, @ref plugins and @ref file-formats for more
+information.
+
+@section Trade-MagnumImporter-behavior Behavior and limitations
+
+The file is expected to have the same endianness as the machine it's being
+imported on, files of a different version are not supported.
+
+If the data are opened with @ref openMemory() or with
+@ref ImporterFlag::MapFiles set, the imported mesh references the index and
+vertex data directly without any copy, with @ref MeshData::indexDataFlags()
+and @ref MeshData::vertexDataFlags() being empty. The mesh is then valid only
+as long as the memory is. Otherwise the data are copied to the returned mesh.
+For a zero-copy import the memory is expected to be aligned to at least 8
+bytes, which is the case for memory-mapped files.
+
+Files produced with the @cb{.ini} compress @ce option of
+@ref MagnumSceneConverter are decoded using @ref MeshTools::decodeIndicesInto()
+and @ref MeshTools::decodeVerticesInto() into a newly allocated mesh
+regardless of how the data were opened, with the indices tightly packed and
+the attributes tightly interleaved. The decoding happens in @ref mesh(), if
+the data are corrupted, the function prints a message to
+@relativeref{Magnum,Error} and returns @relativeref{Corrade,Containers::NullOpt}.
+
+The importer supports @ref ImporterFeature::ThreadSafeImport.
+*/
+class MAGNUM_MAGNUMIMPORTER_EXPORT MagnumImporter: public AbstractImporter {
+    public:
+        /** @brief Default constructor */
+        explicit MagnumImporter();
+
+        /** @brief Plugin manager constructor */
+        explicit MagnumImporter(PluginManager::AbstractManager& manager, const Containers::StringView& plugin);
+
+        ~MagnumImporter();
+
+    private:
+        MAGNUM_MAGNUMIMPORTER_LOCAL ImporterFeatures doFeatures() const override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL bool doIsOpened() const override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL void doOpenData(Containers::Array<char>&& data, DataFlags dataFlags) override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL void doClose() override;
+
+        MAGNUM_MAGNUMIMPORTER_LOCAL UnsignedInt doMeshCount() const override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL Containers::Optional<MeshData> doMesh(UnsignedInt id, UnsignedInt level) override;
+
+        Containers::Array<char> _in;
+        bool _zeroCopy;
+};
+
+}}
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef Magnum_Trade_MeshBlob_h
+#define Magnum_Trade_MeshBlob_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Types.h"
+
+/* Used by both MagnumImporter and MagnumSceneConverter, which is why it isn't
+   directly inside MagnumImporter.cpp. OTOH it doesn't need to be exposed
+   publicly, which is why it has no docblocks.
+
+   The file is a header, followed by an attribute table, index data and
+   vertex data. All offsets are absolute from the file start and index and
+   vertex data are aligned to MeshBlobDataAlignment, so when the file is
+   memory-mapped or loaded into a suitably aligned allocation, the data can be
+   referenced directly. The data are stored in the endianness of the machine
+   that produced them, indicated in the header.
+
+   If MeshBlobFlagCompressed is set, the index and vertex data are instead
+   encoded with MeshTools::encodeIndices() and MeshTools::encodeVertices()
+   and the sizes in the header are sizes of the encoded data. The decoded
+   indices are tightly packed at the beginning of the index data and the
+   decoded vertex data are vertexCount items of vertexStride bytes each. */
+
+namespace Magnum { namespace Trade { namespace Implementation {
+
+constexpr char MeshBlobMagic[4]{'M', 'G', 'M', 'B'};
+constexpr UnsignedByte MeshBlobVersion = 1;
+constexpr std::size_t MeshBlobDataAlignment = 8;
+
+enum: UnsignedByte {
+    MeshBlobFlagBigEndian = 1 << 0,
+    MeshBlobFlagCompressed = 1 << 1
+};
+
+struct MeshBlobHeader {
+    char magic[4];
+    UnsignedByte version;
+    UnsignedByte flags;
+    UnsignedShort vertexStride;     /* Only if compressed, otherwise 0 */
+
+    UnsignedInt primitive;          /* MeshPrimitive */
+    UnsignedInt indexType;          /* MeshIndexType, 0 if not indexed */
+    UnsignedInt indexCount;
+    Int indexStride;
+    UnsignedInt vertexCount;
+    UnsignedInt attributeCount;
+
+    UnsignedLong indexOffset;       /* Relative to index data begin */
+    UnsignedLong indexDataOffset;
+    UnsignedLong indexDataSize;
+    UnsignedLong vertexDataOffset;
+    UnsignedLong vertexDataSize;
+};
+
+static_assert(sizeof(MeshBlobHeader) == 72, "MeshBlobHeader size is not 72 bytes");
+
+/* Immediately follows the header, attributeCount entries */
+struct MeshBlobAttribute {
+    UnsignedInt format;             /* VertexFormat */
+    UnsignedShort name;             /* MeshAttribute */
+    UnsignedShort arraySize;
+    UnsignedLong offset;            /* Relative to vertex data begin */
+    Int stride;
+    UnsignedInt reserved;
+};
+
+static_assert(sizeof(MeshBlobAttribute) == 24, "MeshBlobAttribute size is not 24 bytes");
+
+}}}
+
+#endif
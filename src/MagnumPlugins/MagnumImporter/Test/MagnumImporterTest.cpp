@@ -0,0 +1,357 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstddef>
+#include <cstring>
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Endianness.h>
+#include <Corrade/Utility/FormatStl.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/MeshData.h"
+#include "MagnumPlugins/MagnumImporter/MeshBlob.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct MagnumImporterTest: TestSuite::Tester {
+    explicit MagnumImporterTest();
+
+    void tooShort();
+    void invalid();
+
+    void mesh();
+    void meshNotIndexed();
+    void meshUnaligned();
+    void meshCompressedInvalid();
+
+    void openTwice();
+    void importTwice();
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
+};
+
+struct Vertex {
+    Vector3 position;
+    UnsignedShort custom[2];
+};
+
+/* Header, two attributes, four indices and three vertices, laid out exactly
+   like MagnumSceneConverter would do it */
+struct Blob {
+    Implementation::MeshBlobHeader header;
+    Implementation::MeshBlobAttribute attributes[2];
+    UnsignedShort indices[4];
+    Vertex vertices[3];
+};
+
+static_assert(sizeof(Blob) == 176, "unexpected blob size");
+
+Blob blob() {
+    Blob out;
+    std::memset(&out, 0, sizeof(out));
+    std::memcpy(out.header.magic, "MGMB", 4);
+    out.header.version = 1;
+    out.header.flags = Utility::Endianness::isBigEndian() ? Implementation::MeshBlobFlagBigEndian : 0;
+    out.header.primitive = UnsignedInt(MeshPrimitive::Triangles);
+    out.header.indexType = UnsignedInt(MeshIndexType::UnsignedShort);
+    out.header.indexCount = 3;
+    out.header.indexStride = 2;
+    out.header.indexOffset = 2;
+    out.header.vertexCount = 3;
+    out.header.attributeCount = 2;
+    out.header.indexDataOffset = offsetof(Blob, indices);
+    out.header.indexDataSize = sizeof(Blob::indices);
+    out.header.vertexDataOffset = offsetof(Blob, vertices);
+    out.header.vertexDataSize = sizeof(Blob::vertices);
+
+    out.attributes[0].name = UnsignedShort(MeshAttribute::Position);
+    out.attributes[0].format = UnsignedInt(VertexFormat::Vector3);
+    out.attributes[0].offset = offsetof(Vertex, position);
+    out.attributes[0].stride = sizeof(Vertex);
+    out.attributes[1].name = UnsignedShort(meshAttributeCustom(3));
+    out.attributes[1].format = UnsignedInt(VertexFormat::UnsignedShort);
+    out.attributes[1].arraySize = 2;
+    out.attributes[1].offset = offsetof(Vertex, custom);
+    out.attributes[1].stride = sizeof(Vertex);
+
+    const UnsignedShort indices[]{0xdead, 2, 1, 0};
+    std::memcpy(out.indices, indices, sizeof(indices));
+    out.vertices[0] = {{1.0f, 2.0f, 3.0f}, {10, 11}};
+    out.vertices[1] = {{4.0f, 5.0f, 6.0f}, {12, 13}};
+    out.vertices[2] = {{7.0f, 8.0f, 9.0f}, {14, 15}};
+    return out;
+}
+
+const struct {
+    const char* name;
+    void(*modify)(Blob&);
+    const char* message;
+} InvalidData[]{
+    {"invalid signature", [](Blob& blob) {
+        blob.header.magic[3] = 'X';
+    }, "invalid file signature"},
+    {"unsupported version", [](Blob& blob) {
+        blob.header.version = 2;
+    }, "unsupported file version 2, expected 1"},
+    {"different endianness", [](Blob& blob) {
+        blob.header.flags ^= Implementation::MeshBlobFlagBigEndian;
+    }, Utility::Endianness::isBigEndian() ? "file is little-endian but the machine is not" : "file is big-endian but the machine is not"},
+    {"unsupported flags", [](Blob& blob) {
+        blob.header.flags |= 1 << 2;
+    }, Utility::Endianness::isBigEndian() ? "unsupported flags 0x5" : "unsupported flags 0x4"},
+    {"attribute table out of bounds", [](Blob& blob) {
+        blob.header.attributeCount = 100;
+    }, "file too short, expected at least 2472 bytes for 100 attributes but got 176"},
+    {"index data out of bounds", [](Blob& blob) {
+        blob.header.indexDataSize = 100;
+    }, "index data of 100 bytes at offset 120 out of bounds for 176 bytes"},
+    {"vertex data out of bounds", [](Blob& blob) {
+        blob.header.vertexDataOffset = 160;
+    }, "vertex data of 48 bytes at offset 160 out of bounds for 176 bytes"},
+    {"invalid index type", [](Blob& blob) {
+        blob.header.indexType = 4;
+    }, "unsupported index type 0x4"},
+    {"indices out of bounds", [](Blob& blob) {
+        blob.header.indexCount = 4;
+    }, "4 indices with a stride of 2 at offset 2 out of bounds for 8 bytes of index data"},
+    {"compressed indices out of bounds", [](Blob& blob) {
+        /* The decoded indices have no leading padding, so the offset is out
+           of bounds */
+        blob.header.flags |= Implementation::MeshBlobFlagCompressed;
+        blob.header.vertexStride = sizeof(Vertex);
+    }, "3 indices with a stride of 2 at offset 2 out of bounds for 6 bytes of index data"},
+    {"invalid vertex format", [](Blob& blob) {
+        blob.attributes[1].format = 0;
+    }, "invalid format 0x0 for attribute 1"},
+    {"incompatible vertex format", [](Blob& blob) {
+        blob.attributes[0].format = UnsignedInt(VertexFormat::Float);
+    }, "VertexFormat::Float is not a valid format for attribute 0 of type Trade::MeshAttribute::Position"},
+    {"array attribute not allowed", [](Blob& blob) {
+        blob.attributes[0].arraySize = 2;
+    }, "attribute 0 of type Trade::MeshAttribute::Position and format VertexFormat::Vector3 can't be an array"},
+    {"attribute out of bounds", [](Blob& blob) {
+        blob.header.vertexCount = 4;
+    }, "attribute 0 with a stride of 16 at offset 0 out of bounds for 4 vertices and 48 bytes of vertex data"},
+    {"compressed attribute out of bounds", [](Blob& blob) {
+        blob.header.flags |= Implementation::MeshBlobFlagCompressed;
+        blob.header.indexOffset = 0;
+        blob.header.vertexStride = 12;
+    }, "attribute 0 with a stride of 16 at offset 0 out of bounds for 3 vertices and 36 bytes of vertex data"},
+    {"array attribute out of bounds", [](Blob& blob) {
+        blob.attributes[1].arraySize = 3;
+    }, "attribute 1 with a stride of 16 at offset 12 out of bounds for 3 vertices and 48 bytes of vertex data"},
+};
+
+MagnumImporterTest::MagnumImporterTest() {
+    addTests({&MagnumImporterTest::tooShort});
+
+    addInstancedTests({&MagnumImporterTest::invalid},
+        Containers::arraySize(InvalidData));
+
+    addTests({&MagnumImporterTest::mesh,
+              &MagnumImporterTest::meshNotIndexed,
+              &MagnumImporterTest::meshUnaligned,
+              &MagnumImporterTest::meshCompressedInvalid,
+
+              &MagnumImporterTest::openTwice,
+              &MagnumImporterTest::importTwice});
+
+    /* Load the plugin directly from the build tree. Otherwise it's static and
+       already loaded. */
+    #ifdef MAGNUMIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(MAGNUMIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+}
+
+void MagnumImporterTest::tooShort() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+
+    const Blob data = blob();
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->openData(Containers::arrayView(reinterpret_cast<const char*>(&data), 71)));
+    CORRADE_COMPARE(out.str(), "Trade::MagnumImporter::openData(): file too short, expected at least 72 bytes but got 71\n");
+}
+
+void MagnumImporterTest::invalid() {
+    auto&& data = InvalidData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+
+    Blob b = blob();
+    data.modify(b);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->openData(Containers::arrayView(reinterpret_cast<const char*>(&b), sizeof(b))));
+    CORRADE_COMPARE(out.str(), Utility::formatString("Trade::MagnumImporter::openData(): {}\n", data.message));
+}
+
+void MagnumImporterTest::mesh() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+    CORRADE_VERIFY(importer->features() & ImporterFeature::ThreadSafeImport);
+
+    /* The data are copied on open, the mesh gets its own copy */
+    const Blob data = blob();
+    CORRADE_VERIFY(importer->openData(Containers::arrayView(reinterpret_cast<const char*>(&data), sizeof(data))));
+    CORRADE_COMPARE(importer->meshCount(), 1);
+
+    Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->indexDataFlags(), DataFlag::Owned|DataFlag::Mutable);
+    CORRADE_COMPARE(mesh->vertexDataFlags(), DataFlag::Owned|DataFlag::Mutable);
+    CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(mesh->indexType(), MeshIndexType::UnsignedShort);
+    CORRADE_COMPARE(mesh->indexOffset(), 2);
+    CORRADE_COMPARE_AS(mesh->indices<UnsignedShort>(),
+        Containers::arrayView<UnsignedShort>({2, 1, 0}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(mesh->vertexCount(), 3);
+    CORRADE_COMPARE(mesh->attributeCount(), 2);
+    CORRADE_COMPARE_AS(mesh->attribute<Vector3>(MeshAttribute::Position),
+        Containers::arrayView<Vector3>({
+            {1.0f, 2.0f, 3.0f},
+            {4.0f, 5.0f, 6.0f},
+            {7.0f, 8.0f, 9.0f}
+        }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(mesh->attributeName(1), meshAttributeCustom(3));
+    CORRADE_COMPARE(mesh->attributeFormat(1), VertexFormat::UnsignedShort);
+    CORRADE_COMPARE(mesh->attributeArraySize(1), 2);
+    CORRADE_COMPARE(mesh->attributeOffset(1), 12);
+    CORRADE_COMPARE(mesh->attributeStride(1), 16);
+    CORRADE_COMPARE_AS((mesh->attribute<UnsignedShort[]>(1).transposed<0, 1>()[1]),
+        Containers::arrayView<UnsignedShort>({11, 13, 15}),
+        TestSuite::Compare::Container);
+
+    /* Opening a memory references the data directly */
+    CORRADE_VERIFY(importer->openMemory(Containers::arrayView(reinterpret_cast<const char*>(&data), sizeof(data))));
+    Containers::Optional<MeshData> zeroCopy = importer->mesh(0);
+    CORRADE_VERIFY(zeroCopy);
+    CORRADE_COMPARE(zeroCopy->indexDataFlags(), DataFlags{});
+    CORRADE_COMPARE(zeroCopy->vertexDataFlags(), DataFlags{});
+    CORRADE_COMPARE(static_cast<const void*>(zeroCopy->indexData().data()), static_cast<const void*>(data.indices));
+    CORRADE_COMPARE(static_cast<const void*>(zeroCopy->vertexData().data()), static_cast<const void*>(data.vertices));
+    CORRADE_COMPARE_AS(zeroCopy->indices<UnsignedShort>(),
+        Containers::arrayView<UnsignedShort>({2, 1, 0}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(zeroCopy->attribute<Vector3>(MeshAttribute::Position)[2], (Vector3{7.0f, 8.0f, 9.0f}));
+}
+
+void MagnumImporterTest::meshNotIndexed() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+
+    Blob data = blob();
+    data.header.indexType = 0;
+    data.header.indexCount = 0;
+    data.header.indexOffset = 0;
+    data.header.indexDataSize = 0;
+    /* Points to garbage, but shouldn't be touched if empty */
+    data.header.indexDataOffset = 175;
+    CORRADE_VERIFY(importer->openMemory(Containers::arrayView(reinterpret_cast<const char*>(&data), sizeof(data))));
+
+    Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_VERIFY(!mesh->isIndexed());
+    CORRADE_COMPARE(mesh->vertexCount(), 3);
+    CORRADE_COMPARE(mesh->attributeCount(), 2);
+}
+
+void MagnumImporterTest::meshUnaligned() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+
+    /* Memory that's not aligned can't be referenced directly, the importer
+       makes a copy instead */
+    const Blob data = blob();
+    Containers::Array<char> unaligned{ValueInit, sizeof(data) + 1};
+    std::memcpy(unaligned + 1, &data, sizeof(data));
+    CORRADE_VERIFY(importer->openMemory(unaligned.exceptPrefix(1)));
+
+    Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->vertexDataFlags(), DataFlag::Owned|DataFlag::Mutable);
+    CORRADE_COMPARE(mesh->attribute<Vector3>(MeshAttribute::Position)[1], (Vector3{4.0f, 5.0f, 6.0f}));
+}
+
+void MagnumImporterTest::meshCompressedInvalid() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+
+    /* The layout is valid but the data aren't encoded, which is discovered
+       only when decoding in mesh() */
+    Blob data = blob();
+    data.header.flags |= Implementation::MeshBlobFlagCompressed;
+    data.header.indexOffset = 0;
+    data.header.vertexStride = sizeof(Vertex);
+    CORRADE_VERIFY(importer->openData(Containers::arrayView(reinterpret_cast<const char*>(&data), sizeof(data))));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->mesh(0));
+    CORRADE_COMPARE(out.str(), "MeshTools::decodeIndicesInto(): invalid header for 16-bit indices\n");
+}
+
+void MagnumImporterTest::openTwice() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+
+    const Blob data = blob();
+    CORRADE_VERIFY(importer->openData(Containers::arrayView(reinterpret_cast<const char*>(&data), sizeof(data))));
+    CORRADE_VERIFY(importer->openData(Containers::arrayView(reinterpret_cast<const char*>(&data), sizeof(data))));
+
+    /* Shouldn't crash, leak or anything */
+}
+
+void MagnumImporterTest::importTwice() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+
+    const Blob data = blob();
+    CORRADE_VERIFY(importer->openData(Containers::arrayView(reinterpret_cast<const char*>(&data), sizeof(data))));
+
+    /* Verify that everything is working the same way on second use */
+    {
+        Containers::Optional<MeshData> mesh = importer->mesh(0);
+        CORRADE_VERIFY(mesh);
+        CORRADE_COMPARE(mesh->vertexCount(), 3);
+    } {
+        Containers::Optional<MeshData> mesh = importer->mesh(0);
+        CORRADE_VERIFY(mesh);
+        CORRADE_COMPARE(mesh->vertexCount(), 3);
+    }
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::MagnumImporterTest)
@@ -0,0 +1,171 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MagnumSceneConverter.h"
+
+#include <cstring>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
+#include <Corrade/Utility/Endianness.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/VertexFormat.h"
+#include "Magnum/MeshTools/Codec.h"
+#include "Magnum/MeshTools/Interleave.h"
+#include "Magnum/Trade/MeshData.h"
+#include "MagnumPlugins/MagnumImporter/MeshBlob.h"
+
+namespace Magnum { namespace Trade {
+
+namespace {
+
+constexpr std::size_t alignBlobData(const std::size_t offset) {
+    return (offset + Implementation::MeshBlobDataAlignment - 1)/Implementation::MeshBlobDataAlignment*Implementation::MeshBlobDataAlignment;
+}
+
+}
+
+MagnumSceneConverter::MagnumSceneConverter() = default;
+
+MagnumSceneConverter::MagnumSceneConverter(PluginManager::AbstractManager& manager, const Containers::StringView& plugin): AbstractSceneConverter{manager, plugin} {}
+
+MagnumSceneConverter::~MagnumSceneConverter() = default;
+
+SceneConverterFeatures MagnumSceneConverter::doFeatures() const {
+    return SceneConverterFeature::ConvertMeshToData;
+}
+
+Containers::Optional<Containers::Array<char>> MagnumSceneConverter::doConvertToData(const MeshData& mesh) {
+    Containers::ArrayView<const char> indexData = mesh.indexData();
+    Containers::ArrayView<const char> vertexData = mesh.vertexData();
+    UnsignedLong indexOffset = mesh.isIndexed() ? mesh.indexOffset() : 0;
+    Int indexStride = mesh.isIndexed() ? mesh.indexStride() : 0;
+    UnsignedLong vertexOffset = 0;
+    UnsignedShort vertexStride = 0;
+
+    /* If compressing, pack the indices and the vertices tightly first and
+       then encode them. The attribute offsets are then relative to the first
+       attribute and all strides are the packed vertex size. */
+    const bool compress = configuration().value<bool>("compress");
+    Containers::Optional<MeshData> packed;
+    Containers::Array<char> encodedIndexData, encodedVertexData;
+    if(compress) {
+        if(mesh.isIndexed() && isMeshIndexTypeImplementationSpecific(mesh.indexType())) {
+            Error{} << "Trade::MagnumSceneConverter::convertToData(): can't compress an implementation-specific index type" << reinterpret_cast<void*>(meshIndexTypeUnwrap(mesh.indexType()));
+            return {};
+        }
+        for(UnsignedInt i = 0; i != mesh.attributeCount(); ++i) {
+            if(isVertexFormatImplementationSpecific(mesh.attributeFormat(i))) {
+                Error{} << "Trade::MagnumSceneConverter::convertToData(): can't compress an implementation-specific format" << reinterpret_cast<void*>(vertexFormatUnwrap(mesh.attributeFormat(i))) << "of attribute" << i;
+                return {};
+            }
+        }
+
+        /* Without any flags both strided indices and attributes with padding
+           get repacked */
+        packed = MeshTools::interleave(mesh, {}, MeshTools::InterleaveFlags{});
+
+        if(packed->isIndexed()) {
+            switch(packed->indexType()) {
+                case MeshIndexType::UnsignedByte:
+                    encodedIndexData = MeshTools::encodeIndices(packed->indices<UnsignedByte>());
+                    break;
+                case MeshIndexType::UnsignedShort:
+                    encodedIndexData = MeshTools::encodeIndices(packed->indices<UnsignedShort>());
+                    break;
+                case MeshIndexType::UnsignedInt:
+                    encodedIndexData = MeshTools::encodeIndices(packed->indices<UnsignedInt>());
+                    break;
+                default: CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+            }
+            indexOffset = 0;
+            indexStride = meshIndexTypeSize(packed->indexType());
+        }
+
+        if(packed->attributeCount()) {
+            const Containers::StridedArrayView2D<const char> vertices = MeshTools::interleavedData(*packed);
+            encodedVertexData = MeshTools::encodeVertices(vertices);
+            vertexOffset = static_cast<const char*>(vertices.data()) - packed->vertexData().data();
+            vertexStride = UnsignedShort(vertices.size()[1]);
+        } else encodedVertexData = MeshTools::encodeVertices({});
+
+        indexData = encodedIndexData;
+        vertexData = encodedVertexData;
+    }
+    const MeshData& source = packed ? *packed : mesh;
+
+    /* Calculate the layout. The attribute table is right after the header
+       and thus implicitly aligned, index and vertex data are padded. */
+    const std::size_t attributeTableOffset = sizeof(Implementation::MeshBlobHeader);
+    const std::size_t indexDataOffset = alignBlobData(attributeTableOffset + source.attributeCount()*sizeof(Implementation::MeshBlobAttribute));
+    const std::size_t vertexDataOffset = alignBlobData(indexDataOffset + indexData.size());
+    const std::size_t size = vertexDataOffset + vertexData.size();
+
+    /* Zero-initialized so the padding and reserved fields are deterministic */
+    Containers::Array<char> out{ValueInit, size};
+
+    Implementation::MeshBlobHeader& header = *reinterpret_cast<Implementation::MeshBlobHeader*>(out.data());
+    std::memcpy(header.magic, Implementation::MeshBlobMagic, sizeof(header.magic));
+    header.version = Implementation::MeshBlobVersion;
+    header.flags = (Utility::Endianness::isBigEndian() ? Implementation::MeshBlobFlagBigEndian : 0)|(compress ? Implementation::MeshBlobFlagCompressed : 0);
+    header.vertexStride = vertexStride;
+    header.primitive = UnsignedInt(source.primitive());
+    if(source.isIndexed()) {
+        header.indexType = UnsignedInt(source.indexType());
+        header.indexCount = source.indexCount();
+        header.indexStride = indexStride;
+        header.indexOffset = indexOffset;
+    }
+    header.vertexCount = source.vertexCount();
+    header.attributeCount = source.attributeCount();
+    header.indexDataOffset = indexDataOffset;
+    header.indexDataSize = indexData.size();
+    header.vertexDataOffset = vertexDataOffset;
+    header.vertexDataSize = vertexData.size();
+
+    Containers::ArrayView<Implementation::MeshBlobAttribute> attributes{reinterpret_cast<Implementation::MeshBlobAttribute*>(out.data() + attributeTableOffset), source.attributeCount()};
+    for(UnsignedInt i = 0; i != source.attributeCount(); ++i) {
+        Implementation::MeshBlobAttribute& attribute = attributes[i];
+        attribute.format = UnsignedInt(source.attributeFormat(i));
+        attribute.name = UnsignedShort(source.attributeName(i));
+        attribute.arraySize = source.attributeArraySize(i);
+        attribute.offset = source.attributeOffset(i) - vertexOffset;
+        attribute.stride = compress ? vertexStride : source.attributeStride(i);
+    }
+
+    Utility::copy(indexData, out.slice(indexDataOffset, indexDataOffset + indexData.size()));
+    Utility::copy(vertexData, out.exceptPrefix(vertexDataOffset));
+
+    /* GCC 4.8 needs extra help here */
+    return Containers::optional(std::move(out));
+}
+
+}}
+
+CORRADE_PLUGIN_REGISTER(MagnumSceneConverter, Magnum::Trade::MagnumSceneConverter,
+    "cz.mosra.magnum.Trade.AbstractSceneConverter/0.1.2")
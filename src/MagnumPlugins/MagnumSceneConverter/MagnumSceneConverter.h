@@ -0,0 +1,145 @@
+#ifndef Magnum_Trade_MagnumSceneConverter_h
+#define Magnum_Trade_MagnumSceneConverter_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Trade::MagnumSceneConverter
+ * @m_since_latest
+ */
+
+#include "Magnum/Trade/AbstractSceneConverter.h"
+#include "MagnumPlugins/MagnumSceneConverter/configure.h"
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+#ifndef MAGNUM_MAGNUMSCENECONVERTER_BUILD_STATIC
+    #ifdef MagnumSceneConverter_EXPORTS
+        #define MAGNUM_MAGNUMSCENECONVERTER_EXPORT CORRADE_VISIBILITY_EXPORT
+    #else
+        #define MAGNUM_MAGNUMSCENECONVERTER_EXPORT CORRADE_VISIBILITY_IMPORT
+    #endif
+#else
+    #define MAGNUM_MAGNUMSCENECONVERTER_EXPORT CORRADE_VISIBILITY_STATIC
+#endif
+#define MAGNUM_MAGNUMSCENECONVERTER_LOCAL CORRADE_VISIBILITY_LOCAL
+#else
+#define MAGNUM_MAGNUMSCENECONVERTER_EXPORT
+#define MAGNUM_MAGNUMSCENECONVERTER_LOCAL
+#endif
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Magnum blob scene converter plugin
+@m_since_latest
+
+Saves a @ref MeshData into a native binary blob (`*.blob`) that can be loaded
+back with @ref MagnumImporter with zero copies and without any processing,
+making it suitable for caching of already processed assets.
+
+@section Trade-MagnumSceneConverter-usage Usage
+
+This plugin depends on the @ref Trade and @ref MeshTools libraries and is
+built if `MAGNUM_WITH_MAGNUMSCENECONVERTER` is enabled when building Magnum.
+To use as a dynamic plugin, load @cpp "MagnumSceneConverter" @ce via
+@ref Corrade::PluginManager::Manager.
+
+Additionally, if you're using Magnum as a CMake subproject, do the following:
+
+@code{.cmake}
+set(MAGNUM_WITH_MAGNUMSCENECONVERTER ON CACHE BOOL "" FORCE)
+add_subdirectory(magnum EXCLUDE_FROM_ALL)
+
+# So the dynamically loaded plugin gets built implicitly
+add_dependencies(your-app Magnum::MagnumSceneConverter)
+@endcode
+
+To use as a static plugin or as a dependency of another plugin with CMake, you
+need to request the `MagnumSceneConverter` component of the `Magnum` package
+and link to the `Magnum::MagnumSceneConverter` target:
+
+@code{.cmake}
+find_package(Magnum REQUIRED MagnumSceneConverter)
+
+# ...
+target_link_libraries(your-app PRIVATE Magnum::MagnumSceneConverter)
+@endcode
+
+See @ref building, @ref cmake, @ref plugins and @ref file-formats for more
+information.
+
+@section Trade-MagnumSceneConverter-behavior Behavior and limitations
+
+The index and vertex data are stored as-is, including any padding, with
+attribute layout, index type and primitive preserved. Index and vertex data
+are aligned to 8 bytes in the file, which is enough for all
+@ref VertexFormat types. The data are saved in the endianness of the machine
+running the conversion and @ref MagnumImporter refuses to open files of a
+different endianness.
+
+Implementation-specific primitives, vertex formats and index types are
+preserved as well, as they're just raw values. Custom attribute names are not
+saved, only their IDs. Importer state is not saved.
+
+@subsection Trade-MagnumSceneConverter-behavior-compression Compression
+
+If the @cb{.ini} compress @ce @ref Trade-MagnumSceneConverter-configuration "configuration option"
+is enabled, the indices are tightly packed and the attributes tightly
+interleaved using @ref MeshTools::interleave() first, dropping any padding.
+The indices are then encoded with @ref MeshTools::encodeIndices() and the
+vertex data with @ref MeshTools::encodeVertices(), which is meant for network
+delivery of meshes that were quantized with @ref MeshTools::quantize()
+beforehand. Such files can't be imported with zero copies as the data have
+to be decoded first. Meshes with implementation-specific index types or
+vertex formats can't be compressed.
+
+@section Trade-MagnumSceneConverter-configuration Plugin-specific configuration
+
+It's possible to tune various output options through @ref configuration(). See
+below for all options and their default values:
+
+@snippet MagnumPlugins/MagnumSceneConverter/MagnumSceneConverter.conf configuration_
+
+See @ref plugins-configuration for more information and an example showing how
+to edit the configuration values.
+*/
+class MAGNUM_MAGNUMSCENECONVERTER_EXPORT MagnumSceneConverter: public AbstractSceneConverter {
+    public:
+        /** @brief Default constructor */
+        explicit MagnumSceneConverter();
+
+        /** @brief Plugin manager constructor */
+        explicit MagnumSceneConverter(PluginManager::AbstractManager& manager, const Containers::StringView& plugin);
+
+        ~MagnumSceneConverter();
+
+    private:
+        MAGNUM_MAGNUMSCENECONVERTER_LOCAL SceneConverterFeatures doFeatures() const override;
+        MAGNUM_MAGNUMSCENECONVERTER_LOCAL Containers::Optional<Containers::Array<char>> doConvertToData(const MeshData& mesh) override;
+};
+
+}}
+
+#endif
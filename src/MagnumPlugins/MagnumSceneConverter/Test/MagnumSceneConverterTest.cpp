@@ -0,0 +1,309 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Endianness.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/VertexFormat.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/Codec.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/AbstractSceneConverter.h"
+#include "Magnum/Trade/MeshData.h"
+#include "MagnumPlugins/MagnumImporter/MeshBlob.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct MagnumSceneConverterTest: TestSuite::Tester {
+    explicit MagnumSceneConverterTest();
+
+    void indexed();
+    void nonIndexed();
+    void empty();
+    void compressed();
+    void compressedImplementationSpecific();
+
+    void roundtrip();
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractSceneConverter> _converterManager{"nonexistent"};
+    PluginManager::Manager<AbstractImporter> _importerManager{"nonexistent"};
+};
+
+const struct {
+    const char* name;
+    bool memory;
+    bool compress;
+} RoundtripData[]{
+    {"data", false, false},
+    {"memory", true, false},
+    {"compressed, data", false, true},
+    {"compressed, memory", true, true},
+};
+
+MagnumSceneConverterTest::MagnumSceneConverterTest() {
+    addTests({&MagnumSceneConverterTest::indexed,
+              &MagnumSceneConverterTest::nonIndexed,
+              &MagnumSceneConverterTest::empty,
+              &MagnumSceneConverterTest::compressed,
+              &MagnumSceneConverterTest::compressedImplementationSpecific});
+
+    addInstancedTests({&MagnumSceneConverterTest::roundtrip},
+        Containers::arraySize(RoundtripData));
+
+    /* Load the plugins directly from the build tree. Otherwise they're static
+       and already loaded. */
+    #ifdef MAGNUMSCENECONVERTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_converterManager.load(MAGNUMSCENECONVERTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+    #ifdef MAGNUMIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_importerManager.load(MAGNUMIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+}
+
+struct Vertex {
+    Vector3 position;
+    Float padding;
+    Vector2 textureCoordinates;
+};
+
+const Vertex Vertices[]{
+    {{1.0f, 2.0f, 3.0f}, 0.0f, {0.25f, 0.5f}},
+    {{4.0f, 5.0f, 6.0f}, 0.0f, {0.75f, 1.0f}},
+    {{7.0f, 8.0f, 9.0f}, 0.0f, {0.0f, 0.125f}}
+};
+
+/* Some leading padding to test the offset is preserved */
+const UnsignedShort Indices[]{0xdead, 2, 1, 0, 1, 2};
+
+MeshData indexedMesh() {
+    Containers::StridedArrayView1D<const Vertex> vertices = Vertices;
+    return MeshData{MeshPrimitive::Triangles,
+        {}, Indices, MeshIndexData{Containers::arrayView(Indices).exceptPrefix(1)},
+        {}, Vertices, {
+            MeshAttributeData{MeshAttribute::Position, vertices.slice(&Vertex::position)},
+            MeshAttributeData{MeshAttribute::TextureCoordinates, vertices.slice(&Vertex::textureCoordinates)}
+        }};
+}
+
+Implementation::MeshBlobHeader header(Containers::ArrayView<const char> data) {
+    Implementation::MeshBlobHeader out;
+    std::memcpy(&out, data.data(), sizeof(out));
+    return out;
+}
+
+Implementation::MeshBlobAttribute attribute(Containers::ArrayView<const char> data, UnsignedInt id) {
+    Implementation::MeshBlobAttribute out;
+    std::memcpy(&out, data.data() + sizeof(Implementation::MeshBlobHeader) + id*sizeof(Implementation::MeshBlobAttribute), sizeof(out));
+    return out;
+}
+
+void MagnumSceneConverterTest::indexed() {
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("MagnumSceneConverter");
+
+    Containers::Optional<Containers::Array<char>> data = converter->convertToData(indexedMesh());
+    CORRADE_VERIFY(data);
+
+    const Implementation::MeshBlobHeader h = header(*data);
+    CORRADE_COMPARE((Containers::StringView{h.magic, 4}), "MGMB");
+    CORRADE_COMPARE(h.version, 1);
+    CORRADE_COMPARE(h.flags, Utility::Endianness::isBigEndian() ? 1 : 0);
+    CORRADE_COMPARE(MeshPrimitive(h.primitive), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(MeshIndexType(h.indexType), MeshIndexType::UnsignedShort);
+    CORRADE_COMPARE(h.indexCount, 5);
+    CORRADE_COMPARE(h.indexStride, 2);
+    CORRADE_COMPARE(h.indexOffset, 2);
+    CORRADE_COMPARE(h.vertexCount, 3);
+    CORRADE_COMPARE(h.attributeCount, 2);
+
+    /* Attribute table right after the header, data aligned */
+    CORRADE_COMPARE(h.indexDataOffset, 72 + 2*24);
+    CORRADE_COMPARE(h.indexDataSize, sizeof(Indices));
+    CORRADE_COMPARE(h.vertexDataOffset, 136);
+    CORRADE_COMPARE(h.vertexDataSize, sizeof(Vertices));
+    CORRADE_COMPARE(data->size(), 136 + sizeof(Vertices));
+
+    const Implementation::MeshBlobAttribute position = attribute(*data, 0);
+    CORRADE_COMPARE(MeshAttribute(position.name), MeshAttribute::Position);
+    CORRADE_COMPARE(VertexFormat(position.format), VertexFormat::Vector3);
+    CORRADE_COMPARE(position.offset, 0);
+    CORRADE_COMPARE(position.stride, sizeof(Vertex));
+    CORRADE_COMPARE(position.arraySize, 0);
+
+    const Implementation::MeshBlobAttribute textureCoordinates = attribute(*data, 1);
+    CORRADE_COMPARE(MeshAttribute(textureCoordinates.name), MeshAttribute::TextureCoordinates);
+    CORRADE_COMPARE(VertexFormat(textureCoordinates.format), VertexFormat::Vector2);
+    CORRADE_COMPARE(textureCoordinates.offset, 16);
+    CORRADE_COMPARE(textureCoordinates.stride, sizeof(Vertex));
+
+    CORRADE_COMPARE_AS(data->slice(h.indexDataOffset, h.indexDataOffset + h.indexDataSize),
+        Containers::arrayCast<const char>(Containers::arrayView(Indices)),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(data->exceptPrefix(h.vertexDataOffset),
+        Containers::arrayCast<const char>(Containers::arrayView(Vertices)),
+        TestSuite::Compare::Container);
+}
+
+void MagnumSceneConverterTest::nonIndexed() {
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("MagnumSceneConverter");
+
+    Containers::StridedArrayView1D<const Vertex> vertices = Vertices;
+    Containers::Optional<Containers::Array<char>> data = converter->convertToData(MeshData{MeshPrimitive::Points, {}, Vertices, {
+        MeshAttributeData{MeshAttribute::Position, vertices.slice(&Vertex::position)}
+    }});
+    CORRADE_VERIFY(data);
+
+    const Implementation::MeshBlobHeader h = header(*data);
+    CORRADE_COMPARE(MeshPrimitive(h.primitive), MeshPrimitive::Points);
+    CORRADE_COMPARE(h.indexType, 0);
+    CORRADE_COMPARE(h.indexCount, 0);
+    CORRADE_COMPARE(h.indexDataSize, 0);
+    CORRADE_COMPARE(h.attributeCount, 1);
+    /* 72 + 24 is already aligned */
+    CORRADE_COMPARE(h.vertexDataOffset, 96);
+    CORRADE_COMPARE(data->size(), 96 + sizeof(Vertices));
+}
+
+void MagnumSceneConverterTest::empty() {
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("MagnumSceneConverter");
+
+    Containers::Optional<Containers::Array<char>> data = converter->convertToData(MeshData{MeshPrimitive::Instances, 15});
+    CORRADE_VERIFY(data);
+    CORRADE_COMPARE(data->size(), 72);
+
+    const Implementation::MeshBlobHeader h = header(*data);
+    CORRADE_COMPARE(MeshPrimitive(h.primitive), MeshPrimitive::Instances);
+    CORRADE_COMPARE(h.vertexCount, 15);
+    CORRADE_COMPARE(h.attributeCount, 0);
+}
+
+void MagnumSceneConverterTest::compressed() {
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("MagnumSceneConverter");
+    converter->configuration().setValue("compress", true);
+
+    Containers::Optional<Containers::Array<char>> data = converter->convertToData(indexedMesh());
+    CORRADE_VERIFY(data);
+
+    /* The leading index padding and the padding between the attributes is
+       dropped */
+    const Implementation::MeshBlobHeader h = header(*data);
+    CORRADE_COMPARE(h.flags, Implementation::MeshBlobFlagCompressed|(Utility::Endianness::isBigEndian() ? Implementation::MeshBlobFlagBigEndian : 0));
+    CORRADE_COMPARE(MeshIndexType(h.indexType), MeshIndexType::UnsignedShort);
+    CORRADE_COMPARE(h.indexCount, 5);
+    CORRADE_COMPARE(h.indexStride, 2);
+    CORRADE_COMPARE(h.indexOffset, 0);
+    CORRADE_COMPARE(h.vertexCount, 3);
+    CORRADE_COMPARE(h.vertexStride, 20);
+    CORRADE_COMPARE(h.attributeCount, 2);
+
+    const Implementation::MeshBlobAttribute position = attribute(*data, 0);
+    CORRADE_COMPARE(MeshAttribute(position.name), MeshAttribute::Position);
+    CORRADE_COMPARE(position.offset, 0);
+    CORRADE_COMPARE(position.stride, 20);
+
+    const Implementation::MeshBlobAttribute textureCoordinates = attribute(*data, 1);
+    CORRADE_COMPARE(MeshAttribute(textureCoordinates.name), MeshAttribute::TextureCoordinates);
+    CORRADE_COMPARE(textureCoordinates.offset, 12);
+    CORRADE_COMPARE(textureCoordinates.stride, 20);
+
+    /* The data are the encoded packed indices and vertices */
+    CORRADE_COMPARE_AS(data->slice(h.indexDataOffset, h.indexDataOffset + h.indexDataSize),
+        MeshTools::encodeIndices(Containers::arrayView(Indices).exceptPrefix(1)),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(data->size(), h.vertexDataOffset + h.vertexDataSize);
+}
+
+void MagnumSceneConverterTest::compressedImplementationSpecific() {
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("MagnumSceneConverter");
+    converter->configuration().setValue("compress", true);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!converter->convertToData(MeshData{MeshPrimitive::Points, {}, Vertices, {
+        MeshAttributeData{MeshAttribute::Position, vertexFormatWrap(0xcaca), Containers::stridedArrayView(Vertices).slice(&Vertex::position)}
+    }}));
+    CORRADE_COMPARE(out.str(), "Trade::MagnumSceneConverter::convertToData(): can't compress an implementation-specific format 0xcaca of attribute 0\n");
+}
+
+void MagnumSceneConverterTest::roundtrip() {
+    auto&& data = RoundtripData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if(!(_importerManager.loadState("MagnumImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("MagnumImporter plugin not enabled, can't test the result");
+
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("MagnumSceneConverter");
+    converter->configuration().setValue("compress", data.compress);
+    Containers::Optional<Containers::Array<char>> blob = converter->convertToData(indexedMesh());
+    CORRADE_VERIFY(blob);
+
+    Containers::Pointer<AbstractImporter> importer = _importerManager.instantiate("MagnumImporter");
+    CORRADE_VERIFY(data.memory ? importer->openMemory(*blob) : importer->openData(*blob));
+    CORRADE_COMPARE(importer->meshCount(), 1);
+
+    Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(mesh->indexType(), MeshIndexType::UnsignedShort);
+    CORRADE_COMPARE_AS(mesh->indices<UnsignedShort>(),
+        Containers::arrayView(Indices).exceptPrefix(1),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(mesh->vertexCount(), 3);
+    CORRADE_COMPARE(mesh->attributeCount(), 2);
+    /* The padding is removed when compressing */
+    CORRADE_COMPARE(mesh->attributeStride(MeshAttribute::Position), data.compress ? 20 : sizeof(Vertex));
+    CORRADE_COMPARE_AS(mesh->attribute<Vector3>(MeshAttribute::Position),
+        Containers::stridedArrayView(Vertices).slice(&Vertex::position),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(mesh->attribute<Vector2>(MeshAttribute::TextureCoordinates),
+        Containers::stridedArrayView(Vertices).slice(&Vertex::textureCoordinates),
+        TestSuite::Compare::Container);
+
+    /* Zero-copy import references the blob directly, compressed data are
+       always decoded to a new allocation */
+    if(data.memory && !data.compress) {
+        CORRADE_COMPARE(mesh->vertexDataFlags(), DataFlags{});
+        CORRADE_COMPARE(static_cast<const void*>(mesh->vertexData().data()), blob->data() + 136);
+    } else {
+        CORRADE_COMPARE(mesh->vertexDataFlags(), DataFlag::Owned|DataFlag::Mutable);
+    }
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::MagnumSceneConverterTest)
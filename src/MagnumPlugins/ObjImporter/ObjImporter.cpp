@@ -25,60 +25,221 @@
 
 #include "ObjImporter.h"
 
-#include <fstream>
-#include <limits>
-#include <sstream>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <tuple>
 #include <unordered_map>
-#include <Corrade/Containers/GrowableArray.h>
+#include <vector>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Containers/String.h>
-#include <Corrade/Containers/StringStl.h> /** @todo remove once iostream is dropped */
-#include <Corrade/Utility/DebugStl.h>
-#include <Corrade/Utility/String.h>
+#include <Corrade/Containers/StringStl.h> /** @todo remove once the name map is std::string-free */
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/Utility/Algorithms.h>
 
 #include "Magnum/Mesh.h"
+#include "Magnum/TaskScheduler.h"
+#include "Magnum/Implementation/parallelFor.h"
 #include "Magnum/MeshTools/RemoveDuplicates.h"
 #include "Magnum/MeshTools/Duplicate.h"
 #include "Magnum/Math/Color.h"
+#include "Magnum/Math/Functions.h"
 #include "Magnum/Trade/MeshData.h"
 
 namespace Magnum { namespace Trade {
 
+using namespace Containers::Literals;
+
 struct ObjImporter::File {
     std::unordered_map<std::string, UnsignedInt> meshesForName;
     std::vector<std::string> meshNames;
-    std::vector<std::tuple<std::streampos, std::streampos, UnsignedInt, UnsignedInt, UnsignedInt>> meshes;
-    Containers::Pointer<std::istream> in;
+    /* Begin and end offset in the data, position, texture coordinate and
+       normal index offset */
+    std::vector<std::tuple<std::size_t, std::size_t, UnsignedInt, UnsignedInt, UnsignedInt>> meshes;
+    Containers::Array<char> data;
 };
 
 namespace {
 
-void ignoreLine(std::istream& in) {
-    in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+/* Newlines are handled separately in nextLine() */
+inline bool isWhitespace(const char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
 }
 
-template<std::size_t size> Math::Vector<size, Float> extractFloatData(const std::string& str, Float* extra = nullptr) {
-    std::vector<std::string> data = Utility::String::splitWithoutEmptyParts(str, ' ');
-    if(data.size() < size || data.size() > size + (extra ? 1 : 0)) {
-        Error() << "Trade::ObjImporter::mesh(): invalid float array size";
-        throw 0;
+/* Cuts off the first line from the view, without the newline character */
+Containers::StringView nextLine(Containers::StringView& string) {
+    const char* const newline = static_cast<const char*>(std::memchr(string.data(), '\n', string.size()));
+    const char* const end = newline ? newline : string.end();
+    const Containers::StringView line{string.data(), std::size_t(end - string.data())};
+    const char* const next = newline ? newline + 1 : string.end();
+    string = Containers::StringView{next, std::size_t(string.end() - next)};
+    return line;
+}
+
+/* Cuts off the first whitespace-separated token from the view. Returns an
+   empty view if there are no more tokens. */
+Containers::StringView nextToken(Containers::StringView& string) {
+    const char* i = string.begin();
+    const char* const end = string.end();
+    while(i != end && isWhitespace(*i)) ++i;
+    const char* const tokenBegin = i;
+    while(i != end && !isWhitespace(*i)) ++i;
+    string = Containers::StringView{i, std::size_t(end - i)};
+    return Containers::StringView{tokenBegin, std::size_t(i - tokenBegin)};
+}
+
+/* Doubles up to 1e22 are exactly representable */
+constexpr double PowersOfTen[]{
+    1.0e0, 1.0e1, 1.0e2, 1.0e3, 1.0e4, 1.0e5, 1.0e6, 1.0e7, 1.0e8, 1.0e9,
+    1.0e10, 1.0e11, 1.0e12, 1.0e13, 1.0e14, 1.0e15, 1.0e16, 1.0e17, 1.0e18,
+    1.0e19, 1.0e20, 1.0e21, 1.0e22
+};
+
+/* Parses the whole token as a float. Plain decimal numbers with a mantissa
+   that fits into 53 bits and a decimal exponent within 22 are calculated
+   directly, as both the mantissa and the power of ten are exact doubles in
+   that case. Everything else, such as long mantissas, large exponents or
+   inf / nan, goes through std::strtod() on a null-terminated copy on the
+   stack. */
+bool parseFloat(const Containers::StringView token, Float& out) {
+    const char* i = token.begin();
+    const char* const end = token.end();
+
+    bool negative = false;
+    if(i != end && (*i == '-' || *i == '+')) {
+        negative = *i == '-';
+        ++i;
+    }
+
+    UnsignedLong mantissa = 0;
+    Int exponent = 0;
+    std::size_t significantDigitCount = 0;
+    bool hasDigits = false;
+    bool fast = true;
+    for(; i != end && *i >= '0' && *i <= '9'; ++i) {
+        hasDigits = true;
+        if(significantDigitCount == 19) {
+            fast = false;
+            continue;
+        }
+        mantissa = mantissa*10 + (*i - '0');
+        if(mantissa) ++significantDigitCount;
+    }
+    if(i != end && *i == '.') for(++i; i != end && *i >= '0' && *i <= '9'; ++i) {
+        hasDigits = true;
+        if(significantDigitCount == 19) {
+            fast = false;
+            continue;
+        }
+        mantissa = mantissa*10 + (*i - '0');
+        if(mantissa) ++significantDigitCount;
+        --exponent;
+    }
+    if(hasDigits && i != end && (*i == 'e' || *i == 'E')) {
+        ++i;
+        bool negativeExponent = false;
+        if(i != end && (*i == '-' || *i == '+')) {
+            negativeExponent = *i == '-';
+            ++i;
+        }
+        Int explicitExponent = 0;
+        bool hasExponentDigits = false;
+        for(; i != end && *i >= '0' && *i <= '9'; ++i) {
+            hasExponentDigits = true;
+            /* Clamp to avoid overflow, the fallback handles the rest */
+            if(explicitExponent < 10000)
+                explicitExponent = explicitExponent*10 + (*i - '0');
+        }
+        if(!hasExponentDigits) fast = false;
+        exponent += negativeExponent ? -explicitExponent : explicitExponent;
     }
 
-    Math::Vector<size, Float> output;
+    if(fast && hasDigits && i == end && mantissa <= (1ull << 53) && exponent >= -22 && exponent <= 22) {
+        const double value = exponent < 0 ?
+            double(mantissa)/PowersOfTen[-exponent] :
+            double(mantissa)*PowersOfTen[exponent];
+        out = Float(negative ? -value : value);
+        return true;
+    }
+
+    char buffer[64];
+    if(token.isEmpty() || token.size() >= sizeof(buffer)) return false;
+    std::memcpy(buffer, token.data(), token.size());
+    buffer[token.size()] = '\0';
+    char* parsedEnd;
+    const double value = std::strtod(buffer, &parsedEnd);
+    if(parsedEnd != buffer + token.size()) return false;
+    out = Float(value);
+    return true;
+}
+
+/* Parses the whole token as an unsigned 32-bit integer */
+bool parseIndex(const Containers::StringView token, UnsignedInt& out) {
+    if(token.isEmpty()) return false;
 
-    for(std::size_t i = 0; i != size; ++i)
-        output[i] = std::stof(data[i]);
+    UnsignedLong value = 0;
+    for(const char c: token) {
+        if(c < '0' || c > '9') return false;
+        value = value*10 + (c - '0');
+        if(value > 0xffffffffull) return false;
+    }
 
-    if(data.size() == size+1) {
-        /* This should be obvious from the first if, but add this just to make
-           Clang Analyzer happy */
+    out = UnsignedInt(value);
+    return true;
+}
+
+template<std::size_t size> bool extractFloatData(Containers::StringView contents, Math::Vector<size, Float>& out, Float* extra = nullptr) {
+    /* Gather the tokens first so a wrong count is reported before a wrong
+       number */
+    const std::size_t maxCount = size + (extra ? 1 : 0);
+    Containers::StringView tokens[size + 1];
+    std::size_t count = 0;
+    for(Containers::StringView token = nextToken(contents); !token.isEmpty(); token = nextToken(contents)) {
+        if(count == maxCount) {
+            ++count;
+            break;
+        }
+        tokens[count++] = token;
+    }
+    if(count < size || count > maxCount) {
+        Error() << "Trade::ObjImporter::mesh(): invalid float array size";
+        return false;
+    }
+
+    for(std::size_t i = 0; i != size; ++i) if(!parseFloat(tokens[i], out[i])) {
+        Error() << "Trade::ObjImporter::mesh(): error while converting numeric data";
+        return false;
+    }
+
+    if(count == size + 1) {
+        /* This should be obvious from the count check, but add this just to
+           make Clang Analyzer happy */
         CORRADE_INTERNAL_ASSERT(extra);
 
-        *extra = std::stof(data.back());
+        if(!parseFloat(tokens[size], *extra)) {
+            Error() << "Trade::ObjImporter::mesh(): error while converting numeric data";
+            return false;
+        }
     }
 
-    return output;
+    return true;
+}
+
+/* Splits a v/vt/vn index tuple on slashes. Returns the count of parts, or 4
+   if there's more than three. */
+std::size_t splitIndexTuple(const Containers::StringView tuple, Containers::StringView(&parts)[3]) {
+    std::size_t count = 0;
+    const char* partBegin = tuple.begin();
+    for(const char* i = tuple.begin(); ; ++i) {
+        if(i != tuple.end() && *i != '/') continue;
+        if(count == 3) return 4;
+        parts[count++] = Containers::StringView{partBegin, std::size_t(i - partBegin)};
+        if(i == tuple.end()) break;
+        partBegin = i + 1;
+    }
+    return count;
 }
 
 }
@@ -89,77 +250,70 @@ ObjImporter::ObjImporter(PluginManager::AbstractManager& manager, const Containe
 
 ObjImporter::~ObjImporter() = default;
 
-ImporterFeatures ObjImporter::doFeatures() const { return ImporterFeature::OpenData; }
+ImporterFeatures ObjImporter::doFeatures() const { return ImporterFeature::OpenData|ImporterFeature::ThreadSafeImport; }
 
 void ObjImporter::doClose() { _file.reset(); }
 
 bool ObjImporter::doIsOpened() const { return !!_file; }
 
-void ObjImporter::doOpenFile(const Containers::StringView filename) {
-    /** @todo ARGH clean this up, won't work with UTF-8 */
-    Containers::Pointer<std::istream> in{new std::ifstream{filename, std::ios::binary}};
-    if(!in->good()) {
-        Error() << "Trade::ObjImporter::openFile(): cannot open file" << filename;
-        return;
-    }
-
+void ObjImporter::doOpenData(Containers::Array<char>&& data, const DataFlags dataFlags) {
     _file.reset(new File);
-    _file->in = std::move(in);
-    parseMeshNames();
-}
 
-void ObjImporter::doOpenData(Containers::Array<char>&& data, DataFlags) {
-    _file.reset(new File);
-    /** @todo ARGH MY EYES what is this cursed thing, burn it to the ground */
-    _file->in.reset(new std::istringstream{{data.begin(), data.size()}});
+    /* Take over the existing array or copy the data if we can't. Externally
+       owned memory, such as from openMemory() or ImporterFlag::MapFiles, is
+       referenced directly. */
+    if(dataFlags & (DataFlag::Owned|DataFlag::ExternallyOwned)) {
+        _file->data = std::move(data);
+    } else {
+        _file->data = Containers::Array<char>{NoInit, data.size()};
+        Utility::copy(data, _file->data);
+    }
 
     parseMeshNames();
 }
 
 void ObjImporter::parseMeshNames() {
+    const Containers::StringView data{_file->data.data(), _file->data.size()};
+
     /* First mesh starts at the beginning, its indices start from 1. The end
        offset will be updated to proper value later. */
     UnsignedInt positionIndexOffset = 1;
     UnsignedInt normalIndexOffset = 1;
     UnsignedInt textureCoordinateIndexOffset = 1;
-    _file->meshes.emplace_back(0, 0, positionIndexOffset, normalIndexOffset, textureCoordinateIndexOffset);
+    _file->meshes.emplace_back(0, 0, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset);
 
     /* The first mesh doesn't have name by default but we might find it later,
        so we need to track whether there are any data before first name */
     bool thisIsFirstMeshAndItHasNoData = true;
     _file->meshNames.emplace_back();
 
-    while(_file->in->good()) {
+    Containers::StringView rest = data;
+    while(!rest.isEmpty()) {
         /* The previous object might end at the beginning of this line */
-        const std::streampos end = _file->in->tellg();
+        const std::size_t end = rest.data() - data.data();
 
-        /* Comment line */
-        if(_file->in->peek() == '#') {
-            ignoreLine(*_file->in);
-            continue;
-        }
+        Containers::StringView contents = nextLine(rest);
+        const Containers::StringView keyword = nextToken(contents);
 
-        /* Parse the keyword */
-        std::string keyword;
-        *_file->in >> keyword;
+        /* Empty or comment line */
+        if(keyword.isEmpty() || keyword[0] == '#') continue;
 
         /* Mesh name */
-        if(keyword == "o") {
-            std::string name;
-            std::getline(*_file->in, name);
-            name = Utility::String::trim(name);
+        if(keyword == "o"_s) {
+            const Containers::StringView name = contents.trimmed();
+            const std::size_t begin = rest.data() - data.data();
 
             /* This is the name of first mesh */
             if(thisIsFirstMeshAndItHasNoData) {
                 thisIsFirstMeshAndItHasNoData = false;
 
                 /* Update its name and add it to name map */
-                if(!name.empty())
+                if(!name.isEmpty())
                     _file->meshesForName.emplace(name, _file->meshes.size() - 1);
-                _file->meshNames.back() = std::move(name);
+                _file->meshNames.back() = name;
 
                 /* Update its begin offset to be more precise */
-                std::get<0>(_file->meshes.back()) = _file->in->tellg();
+                std::get<0>(_file->meshes.back()) = begin;
 
             /* Otherwise this is a name of new mesh */
             } else {
@@ -168,45 +322,35 @@ void ObjImporter::parseMeshNames() {
 
                 /* Save name and offset of the new one. The end offset will be
                    updated later. */
-                if(!name.empty())
+                if(!name.isEmpty())
                     _file->meshesForName.emplace(name, _file->meshes.size());
-                _file->meshNames.emplace_back(std::move(name));
-                _file->meshes.emplace_back(_file->in->tellg(), 0, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset);
+                _file->meshNames.emplace_back(name);
+                _file->meshes.emplace_back(begin, 0, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset);
             }
 
-            continue;
-
         /* If there are any data/indices before the first name, it means that
            the first object is unnamed. We need to check for them. */
 
         /* Vertex data, update index offset for the following meshes */
-        } else if(keyword == "v") {
+        } else if(keyword == "v"_s) {
             ++positionIndexOffset;
             thisIsFirstMeshAndItHasNoData = false;
-        } else if(keyword == "vt") {
+        } else if(keyword == "vt"_s) {
             ++textureCoordinateIndexOffset;
             thisIsFirstMeshAndItHasNoData = false;
-        } else if(keyword == "vn") {
+        } else if(keyword == "vn"_s) {
             ++normalIndexOffset;
             thisIsFirstMeshAndItHasNoData = false;
 
         /* Index data, just mark that we found something for first unnamed
            object */
-        } else if(thisIsFirstMeshAndItHasNoData) for(const std::string data: {"p", "l", "f"}) {
-            if(keyword == data) {
-                thisIsFirstMeshAndItHasNoData = false;
-                break;
-            }
+        } else if(keyword == "p"_s || keyword == "l"_s || keyword == "f"_s) {
+            thisIsFirstMeshAndItHasNoData = false;
         }
-
-        /* Ignore the rest of the line */
-        ignoreLine(*_file->in);
     }
 
     /* Set end of the last object */
-    _file->in->clear();
-    _file->in->seekg(0, std::ios::end);
-    std::get<1>(_file->meshes.back()) = _file->in->tellg();
+    std::get<1>(_file->meshes.back()) = data.size();
 }
 
 UnsignedInt ObjImporter::doMeshCount() const { return _file->meshes.size(); }
@@ -234,172 +378,313 @@ template<class T> bool checkAndDuplicateInto(const Containers::StridedArrayView1
     return true;
 }
 
-}
+/* Ranges of data smaller than this aren't worth parsing on multiple
+   threads */
+constexpr std::size_t MinChunkSize = 256*1024;
 
-Containers::Optional<MeshData> ObjImporter::doMesh(UnsignedInt id, UnsignedInt) {
-    /* Seek the file, set mesh parsing parameters */
-    std::streampos begin, end;
-    UnsignedInt positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset;
-    std::tie(begin, end, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset) = _file->meshes[id];
-    _file->in->seekg(begin);
+/* A range of lines parsed by a single task */
+struct Chunk {
+    Containers::StringView data;
 
-    Containers::Optional<MeshPrimitive> primitive;
-    Containers::Array<Vector3> positions;
-    Containers::Array<Vector3> normals;
-    Containers::Array<Vector2> textureCoordinates;
-    /* Taking a shortcut as there's fortunately nothing else than just 3 types
-       of data. First positions, then normals, then texture coordinates. */
-    Containers::Array<Vector3ui> indices;
-    std::size_t textureCoordinateIndexCount = 0, normalIndexCount = 0;
+    /* Count of positions, texture coordinates, normals and index tuples in
+       the range, calculated upfront in countChunk() */
+    std::size_t positionCount, textureCoordinateCount, normalCount, indexCount;
 
-    try { while(_file->in->good() && _file->in->tellg() < end) {
-        /* Ignore comments */
-        if(_file->in->peek() == '#') {
-            ignoreLine(*_file->in);
-            continue;
-        }
+    /* Offsets of the above in the output arrays */
+    std::size_t positionOffset, textureCoordinateOffset, normalOffset, indexOffset;
 
-        /* Get the line */
-        std::string line;
-        std::getline(*_file->in, line);
-        line = Utility::String::trim(line);
+    /* Filled by parseChunk() */
+    std::size_t textureCoordinateIndexCount, normalIndexCount;
+    Containers::Optional<MeshPrimitive> primitive;
+    bool failed;
+};
 
-        /* Ignore empty lines */
-        if(line.empty()) continue;
+/* Counts the data and index tuples in the chunk using the same tokenization
+   as parseChunk(), so the latter never writes past the counted range. Doesn't
+   do any validation, invalid lines are caught by parseChunk() later. */
+void countChunk(Chunk& chunk) {
+    Containers::StringView rest = chunk.data;
+    while(!rest.isEmpty()) {
+        Containers::StringView contents = nextLine(rest);
+        const Containers::StringView keyword = nextToken(contents);
+
+        if(keyword == "v"_s)
+            ++chunk.positionCount;
+        else if(keyword == "vt"_s)
+            ++chunk.textureCoordinateCount;
+        else if(keyword == "vn"_s)
+            ++chunk.normalCount;
+        else if(keyword == "p"_s || keyword == "l"_s || keyword == "f"_s)
+            while(!nextToken(contents).isEmpty()) ++chunk.indexCount;
+    }
+}
 
+/* Parses the chunk into its ranges of the output arrays. The firstIndex is
+   the first position, normal and texture coordinate index of the mesh, in
+   the order the indices are stored in. */
+bool parseChunk(Chunk& chunk, const Vector3ui& firstIndex, const Containers::ArrayView<Vector3> positions, const Containers::ArrayView<Vector2> textureCoordinates, const Containers::ArrayView<Vector3> normals, const Containers::ArrayView<Vector3ui> indices) {
+    std::size_t positionOffset = chunk.positionOffset;
+    std::size_t textureCoordinateOffset = chunk.textureCoordinateOffset;
+    std::size_t normalOffset = chunk.normalOffset;
+    std::size_t indexOffset = chunk.indexOffset;
+
+    /* Going through the data line by line and token by token, without
+       allocating anything */
+    Containers::StringView rest = chunk.data;
+    while(!rest.isEmpty()) {
         /* Split the line into keyword and contents */
-        const std::size_t keywordEnd = line.find(' ');
-        const std::string keyword = line.substr(0, keywordEnd);
-        const std::string contents = keywordEnd != std::string::npos ?
-            Utility::String::ltrim(line.substr(keywordEnd+1)) : "";
+        Containers::StringView contents = nextLine(rest);
+        const Containers::StringView keyword = nextToken(contents);
+
+        /* Ignore empty lines and comments */
+        if(keyword.isEmpty() || keyword[0] == '#') continue;
 
         /* Vertex position */
-        if(keyword == "v") {
+        if(keyword == "v"_s) {
+            Vector3 data;
             Float extra{1.0f};
-            const Vector3 data = extractFloatData<3>(contents, &extra);
+            if(!extractFloatData(contents, data, &extra))
+                return false;
             if(!Math::TypeTraits<Float>::equals(extra, 1.0f)) {
                 Error() << "Trade::ObjImporter::mesh(): homogeneous coordinates are not supported";
-                return Containers::NullOpt;
+                return false;
             }
 
-            arrayAppend(positions, data);
+            positions[positionOffset++] = data;
 
         /* Texture coordinate */
-        } else if(keyword == "vt") {
+        } else if(keyword == "vt"_s) {
+            Vector2 data;
             Float extra{0.0f};
-            const Vector2 data = extractFloatData<2>(contents, &extra);
+            if(!extractFloatData(contents, data, &extra))
+                return false;
             if(!Math::TypeTraits<Float>::equals(extra, 0.0f)) {
                 Error() << "Trade::ObjImporter::mesh(): 3D texture coordinates are not supported";
-                return Containers::NullOpt;
+                return false;
             }
 
-            arrayAppend(textureCoordinates, data);
+            textureCoordinates[textureCoordinateOffset++] = data;
 
         /* Normal */
-        } else if(keyword == "vn") {
-            arrayAppend(normals, Vector3{extractFloatData<3>(contents)});
+        } else if(keyword == "vn"_s) {
+            Vector3 data;
+            if(!extractFloatData(contents, data))
+                return false;
+
+            normals[normalOffset++] = data;
 
         /* Indices */
-        } else if(keyword == "p" || keyword == "l" || keyword == "f") {
-            const std::vector<std::string> indexTuples = Utility::String::splitWithoutEmptyParts(contents, ' ');
+        } else if(keyword == "p"_s || keyword == "l"_s || keyword == "f"_s) {
+            /* Count the index tuples first to check them against the
+               primitive */
+            std::size_t indexTupleCount = 0;
+            for(Containers::StringView tuples = contents; !nextToken(tuples).isEmpty(); )
+                ++indexTupleCount;
 
             /* Points */
-            if(keyword == "p") {
+            if(keyword == "p"_s) {
                 /* Check that we don't mix the primitives in one mesh */
-                if(primitive && primitive != MeshPrimitive::Points) {
-                    Error() << "Trade::ObjImporter::mesh(): mixed primitive" << *primitive << "and" << MeshPrimitive::Points;
-                    return Containers::NullOpt;
+                if(chunk.primitive && chunk.primitive != MeshPrimitive::Points) {
+                    Error() << "Trade::ObjImporter::mesh(): mixed primitive" << *chunk.primitive << "and" << MeshPrimitive::Points;
+                    return false;
                 }
 
                 /* Check vertex count per primitive */
-                if(indexTuples.size() != 1) {
+                if(indexTupleCount != 1) {
                     Error() << "Trade::ObjImporter::mesh(): wrong index count for point";
-                    return Containers::NullOpt;
+                    return false;
                 }
 
-                primitive = MeshPrimitive::Points;
+                chunk.primitive = MeshPrimitive::Points;
 
             /* Lines */
-            } else if(keyword == "l") {
+            } else if(keyword == "l"_s) {
                 /* Check that we don't mix the primitives in one mesh */
-                if(primitive && primitive != MeshPrimitive::Lines) {
-                    Error() << "Trade::ObjImporter::mesh(): mixed primitive" << *primitive << "and" << MeshPrimitive::Lines;
-                    return Containers::NullOpt;
+                if(chunk.primitive && chunk.primitive != MeshPrimitive::Lines) {
+                    Error() << "Trade::ObjImporter::mesh(): mixed primitive" << *chunk.primitive << "and" << MeshPrimitive::Lines;
+                    return false;
                 }
 
                 /* Check vertex count per primitive */
-                if(indexTuples.size() != 2) {
+                if(indexTupleCount != 2) {
                     Error() << "Trade::ObjImporter::mesh(): wrong index count for line";
-                    return Containers::NullOpt;
+                    return false;
                 }
 
-                primitive = MeshPrimitive::Lines;
+                chunk.primitive = MeshPrimitive::Lines;
 
             /* Faces */
-            } else if(keyword == "f") {
+            } else if(keyword == "f"_s) {
                 /* Check that we don't mix the primitives in one mesh */
-                if(primitive && primitive != MeshPrimitive::Triangles) {
-                    Error() << "Trade::ObjImporter::mesh(): mixed primitive" << *primitive << "and" << MeshPrimitive::Triangles;
-                    return Containers::NullOpt;
+                if(chunk.primitive && chunk.primitive != MeshPrimitive::Triangles) {
+                    Error() << "Trade::ObjImporter::mesh(): mixed primitive" << *chunk.primitive << "and" << MeshPrimitive::Triangles;
+                    return false;
                 }
 
                 /* Check vertex count per primitive */
-                if(indexTuples.size() < 3) {
+                if(indexTupleCount < 3) {
                     Error() << "Trade::ObjImporter::mesh(): wrong index count for triangle";
-                    return Containers::NullOpt;
-                } else if(indexTuples.size() != 3) {
+                    return false;
+                } else if(indexTupleCount != 3) {
                     Error() << "Trade::ObjImporter::mesh(): polygons are not supported";
-                    return Containers::NullOpt;
+                    return false;
                 }
 
-                primitive = MeshPrimitive::Triangles;
+                chunk.primitive = MeshPrimitive::Triangles;
 
             } else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
 
-            for(const std::string& indexTuple: indexTuples) {
-                std::vector<std::string> indexStrings = Utility::String::split(indexTuple, '/');
-                if(indexStrings.size() > 3) {
+            for(Containers::StringView indexTuple = nextToken(contents); !indexTuple.isEmpty(); indexTuple = nextToken(contents)) {
+                Containers::StringView indexStrings[3];
+                const std::size_t indexStringCount = splitIndexTuple(indexTuple, indexStrings);
+                if(indexStringCount > 3) {
                     Error() << "Trade::ObjImporter::mesh(): invalid index data";
-                    return Containers::NullOpt;
+                    return false;
                 }
 
                 Vector3ui index;
 
                 /* Position indices */
-                index[0] = std::stoul(indexStrings[0]) - positionIndexOffset;
+                if(!parseIndex(indexStrings[0], index[0])) {
+                    Error() << "Trade::ObjImporter::mesh(): error while converting numeric data";
+                    return false;
+                }
+                index[0] -= firstIndex[0];
 
                 /* Texture coordinates */
-                if(indexStrings.size() == 2 || (indexStrings.size() == 3 && !indexStrings[1].empty())) {
-                    index[2] = std::stoul(indexStrings[1]) - textureCoordinateIndexOffset;
-                    ++textureCoordinateIndexCount;
+                if(indexStringCount == 2 || (indexStringCount == 3 && !indexStrings[1].isEmpty())) {
+                    if(!parseIndex(indexStrings[1], index[2])) {
+                        Error() << "Trade::ObjImporter::mesh(): error while converting numeric data";
+                        return false;
+                    }
+                    index[2] -= firstIndex[2];
+                    ++chunk.textureCoordinateIndexCount;
                 }
 
                 /* Normal indices */
-                if(indexStrings.size() == 3) {
-                    index[1] = std::stoul(indexStrings[2]) - normalIndexOffset;
-                    ++normalIndexCount;
+                if(indexStringCount == 3) {
+                    if(!parseIndex(indexStrings[2], index[1])) {
+                        Error() << "Trade::ObjImporter::mesh(): error while converting numeric data";
+                        return false;
+                    }
+                    index[1] -= firstIndex[1];
+                    ++chunk.normalIndexCount;
                 }
 
-                arrayAppend(indices, index);
+                indices[indexOffset++] = index;
             }
 
         /* Ignore unsupported keywords, error out on unknown keywords */
-        } else if(![&keyword](){
-            /* Using lambda to emulate for-else construct like in Python */
-            for(const std::string expected: {"mtllib", "usemtl", "g", "s"})
-                if(keyword == expected) return true;
-            return false;
-        }()) {
+        } else if(keyword != "mtllib"_s && keyword != "usemtl"_s && keyword != "g"_s && keyword != "s"_s) {
             Error() << "Trade::ObjImporter::mesh(): unknown keyword" << keyword;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+}
+
+Containers::Optional<MeshData> ObjImporter::doMesh(UnsignedInt id, UnsignedInt) {
+    /* Get the mesh range, set mesh parsing parameters */
+    std::size_t begin, end;
+    UnsignedInt positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset;
+    std::tie(begin, end, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset) = _file->meshes[id];
+    const Containers::StringView data{_file->data.data() + begin, end - begin};
+
+    /* Split the range into chunks of whole lines, one for each thread, but
+       not smaller than MinChunkSize */
+    std::size_t chunkCount = configuration().value<UnsignedInt>("threadCount");
+    if(!chunkCount) chunkCount = TaskScheduler::global().threadCount();
+    chunkCount = Math::max(Math::min(chunkCount, data.size()/MinChunkSize), std::size_t{1});
+    Containers::Array<Chunk> chunks{ValueInit, chunkCount};
+    {
+        const char* chunkBegin = data.begin();
+        for(std::size_t i = 0; i != chunkCount; ++i) {
+            const char* chunkEnd = data.end();
+            if(i + 1 != chunkCount) {
+                /* Extend the chunk to the end of the line it would end in */
+                const char* split = data.begin() + (i + 1)*data.size()/chunkCount;
+                if(split < chunkBegin) split = chunkBegin;
+                Containers::StringView rest{split, std::size_t(data.end() - split)};
+                nextLine(rest);
+                chunkEnd = rest.begin();
+            }
+            chunks[i].data = Containers::StringView{chunkBegin, std::size_t(chunkEnd - chunkBegin)};
+            chunkBegin = chunkEnd;
+        }
+    }
+
+    /* Count the data in each chunk and calculate where each chunk should put
+       its output. This also means the output gets allocated just once, with
+       the exact size. */
+    Magnum::Implementation::parallelFor(chunkCount, UnsignedInt(chunkCount), [&](const std::size_t chunksBegin, const std::size_t chunksEnd) {
+        for(std::size_t i = chunksBegin; i != chunksEnd; ++i)
+            countChunk(chunks[i]);
+    });
+    std::size_t positionCount = 0, textureCoordinateCount = 0, normalCount = 0, indexCount = 0;
+    for(Chunk& chunk: chunks) {
+        chunk.positionOffset = positionCount;
+        chunk.textureCoordinateOffset = textureCoordinateCount;
+        chunk.normalOffset = normalCount;
+        chunk.indexOffset = indexCount;
+        positionCount += chunk.positionCount;
+        textureCoordinateCount += chunk.textureCoordinateCount;
+        normalCount += chunk.normalCount;
+        indexCount += chunk.indexCount;
+    }
+
+    Containers::Array<Vector3> positions{NoInit, positionCount};
+    Containers::Array<Vector3> normals{NoInit, normalCount};
+    Containers::Array<Vector2> textureCoordinates{NoInit, textureCoordinateCount};
+    /* Taking a shortcut as there's fortunately nothing else than just 3 types
+       of data. First positions, then normals, then texture coordinates. */
+    Containers::Array<Vector3ui> indices{NoInit, indexCount};
+    const Vector3ui firstIndex{positionIndexOffset, normalIndexOffset, textureCoordinateIndexOffset};
+
+    if(chunkCount == 1) {
+        if(!parseChunk(chunks[0], firstIndex, positions, textureCoordinates, normals, indices))
             return Containers::NullOpt;
+    } else {
+        Magnum::Implementation::parallelFor(chunkCount, UnsignedInt(chunkCount), [&](const std::size_t chunksBegin, const std::size_t chunksEnd) {
+            /* Errors from different chunks would be printed in random order
+               and not necessarily the first one in the file, which is
+               printed by a serial pass below instead */
+            Error silenceError{nullptr};
+            for(std::size_t i = chunksBegin; i != chunksEnd; ++i)
+                chunks[i].failed = !parseChunk(chunks[i], firstIndex, positions, textureCoordinates, normals, indices);
+        });
+
+        /* Each chunk checks only that it doesn't mix primitives on its own,
+           check that the chunks agree with each other */
+        bool failed = false;
+        Containers::Optional<MeshPrimitive> primitive;
+        for(const Chunk& chunk: chunks) {
+            if(chunk.failed || (primitive && chunk.primitive && *primitive != *chunk.primitive)) {
+                failed = true;
+                break;
+            }
+            if(chunk.primitive) primitive = chunk.primitive;
         }
 
-    }} catch(const std::exception&) {
-        Error() << "Trade::ObjImporter::mesh(): error while converting numeric data";
-        return Containers::NullOpt;
-    } catch(...) {
-        /* Error message already printed */
-        return Containers::NullOpt;
+        /* If anything failed, parse the whole range serially again to print
+           the same message as a single-threaded import would. Errors are
+           expected to be rare, so it's not worth trying to be smarter. */
+        if(failed) {
+            Chunk whole{};
+            whole.data = data;
+            CORRADE_INTERNAL_ASSERT_OUTPUT(!parseChunk(whole, firstIndex, positions, textureCoordinates, normals, indices));
+            return Containers::NullOpt;
+        }
+    }
+
+    Containers::Optional<MeshPrimitive> primitive;
+    std::size_t textureCoordinateIndexCount = 0, normalIndexCount = 0;
+    for(const Chunk& chunk: chunks) {
+        if(!primitive) primitive = chunk.primitive;
+        textureCoordinateIndexCount += chunk.textureCoordinateIndexCount;
+        normalIndexCount += chunk.normalIndexCount;
     }
 
     /* There should be at least indexed position data */
@@ -431,10 +716,12 @@ Containers::Optional<MeshData> ObjImporter::doMesh(UnsignedInt id, UnsignedInt)
     }
 
     /* Merge index arrays. If any of the attributes was not there, the whole
-       index array has zeros, not affecting the uniqueness in any way. */
-    Containers::Array<char> indexData{NoInit, indices.size()*sizeof(UnsignedInt)};
+       index array has zeros, not affecting the uniqueness in any way. The
+       radix sort variant is considerably faster than hashing for the index
+       triplets of large meshes. */
+    Containers::Array<char> indexData = allocateData(indices.size()*sizeof(UnsignedInt));
     const auto indexDataI = Containers::arrayCast<UnsignedInt>(indexData);
-    const std::size_t vertexCount = MeshTools::removeDuplicatesInPlaceInto(
+    const std::size_t vertexCount = MeshTools::removeDuplicatesRadixInPlaceInto(
         Containers::arrayCast<2, char>(arrayView(indices)), indexDataI);
 
     /* Allocate attribute and vertex data */
@@ -449,7 +736,7 @@ Containers::Optional<MeshData> ObjImporter::doMesh(UnsignedInt id, UnsignedInt)
         stride += sizeof(Vector2);
     }
     Containers::Array<MeshAttributeData> attributeData{attributeCount};
-    Containers::Array<char> vertexData{NoInit, vertexCount*stride};
+    Containers::Array<char> vertexData = allocateData(vertexCount*stride);
 
     /* Duplicate the vertices into the output */
     const auto indicesPerAttribute = Containers::arrayCast<2, const UnsignedInt>(stridedArrayView(indices)).transposed<0, 1>();
@@ -489,4 +776,4 @@ Containers::Optional<MeshData> ObjImporter::doMesh(UnsignedInt id, UnsignedInt)
 }}
 
 CORRADE_PLUGIN_REGISTER(ObjImporter, Magnum::Trade::ObjImporter,
-    "cz.mosra.magnum.Trade.AbstractImporter/0.5")
+    "cz.mosra.magnum.Trade.AbstractImporter/0.5.1")
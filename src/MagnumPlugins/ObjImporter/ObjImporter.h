@@ -98,6 +98,34 @@ positions with optional @ref VertexFormat::Vector3 normals and
 @ref VertexFormat::Vector2 texture coordinates, if present in the source file.
 
 Polygons (quads etc.) and material properties are currently not supported.
+
+The file is parsed directly from memory without any per-line allocations. If
+the data are opened with @ref openMemory() or with
+@ref ImporterFlag::MapFiles set, the importer references them directly
+instead of making a copy.
+
+Meshes larger than a few hundred kilobytes are additionally split into ranges
+of whole lines that are parsed in parallel on @ref TaskScheduler::global(),
+with the count of ranges limited by the @cb{.ini} threadCount @ce
+@ref Trade-ObjImporter-configuration "configuration option". The ranges are
+first scanned to count the data in each, so the output is allocated just once
+and every range writes to its own part of it, resulting in the same mesh as a
+single-threaded import. If parsing any range fails, the whole mesh is parsed
+again on the calling thread, in order to print the first error in the file.
+
+The importer supports @ref ImporterFeature::ThreadSafeImport, meshes can be
+imported from multiple threads at once, for example using
+@ref parallelLoadMeshes().
+
+@section Trade-ObjImporter-configuration Plugin-specific configuration
+
+It's possible to tune various import options through @ref configuration(). See
+below for all options and their default values:
+
+@snippet MagnumPlugins/ObjImporter/ObjImporter.conf configuration_
+
+See @ref plugins-configuration for more information and an example showing how
+to edit the configuration values.
 */
 class MAGNUM_OBJIMPORTER_EXPORT ObjImporter: public AbstractImporter {
     public:
@@ -116,7 +144,6 @@ class MAGNUM_OBJIMPORTER_EXPORT ObjImporter: public AbstractImporter {
 
         MAGNUM_OBJIMPORTER_LOCAL bool doIsOpened() const override;
         MAGNUM_OBJIMPORTER_LOCAL void doOpenData(Containers::Array<char>&& data, DataFlags dataFlags) override;
-        MAGNUM_OBJIMPORTER_LOCAL void doOpenFile(Containers::StringView filename) override;
         MAGNUM_OBJIMPORTER_LOCAL void doClose() override;
 
         MAGNUM_OBJIMPORTER_LOCAL UnsignedInt doMeshCount() const override;
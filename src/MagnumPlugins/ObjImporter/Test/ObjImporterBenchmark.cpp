@@ -0,0 +1,153 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <chrono>
+#include <string>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/FormatStl.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/MeshData.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct ObjImporterBenchmark: TestSuite::Tester {
+    explicit ObjImporterBenchmark();
+
+    void import();
+
+    void throughputBegin();
+    std::uint64_t throughputEnd();
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
+
+    std::size_t _throughputSize;
+    std::chrono::high_resolution_clock::time_point _throughputBegin;
+};
+
+constexpr std::size_t BenchmarkRepeats = 5;
+constexpr std::size_t BenchmarkIterations = 1;
+
+const struct {
+    const char* name;
+    UnsignedInt size;
+    bool textureCoordinatesNormals;
+} ImportData[]{
+    {"positions, 64x64 grid", 64, false},
+    {"positions, 512x512 grid", 512, false},
+    {"positions, texture coordinates, normals, 64x64 grid", 64, true},
+    {"positions, texture coordinates, normals, 512x512 grid", 512, true},
+};
+
+ObjImporterBenchmark::ObjImporterBenchmark() {
+    /* Time of open + import */
+    addInstancedBenchmarks({&ObjImporterBenchmark::import},
+        BenchmarkRepeats, Containers::arraySize(ImportData));
+
+    /* Megabytes of input data processed per second */
+    addCustomInstancedBenchmarks({&ObjImporterBenchmark::import},
+        BenchmarkRepeats, Containers::arraySize(ImportData),
+        &ObjImporterBenchmark::throughputBegin,
+        &ObjImporterBenchmark::throughputEnd,
+        BenchmarkUnits::Count);
+
+    /* Load the plugin directly from the build tree. Otherwise it's static and
+       already loaded. */
+    #ifdef OBJIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(OBJIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+}
+
+void ObjImporterBenchmark::throughputBegin() {
+    setBenchmarkName("MB/s");
+    _throughputBegin = std::chrono::high_resolution_clock::now();
+}
+
+std::uint64_t ObjImporterBenchmark::throughputEnd() {
+    const std::uint64_t elapsed = Math::max(std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - _throughputBegin).count()), std::uint64_t{1});
+
+    /* The returned value gets divided by the iteration count passed to
+       CORRADE_BENCHMARK(), so multiply it by the count once more to get
+       megabytes per second */
+    return std::uint64_t(Double(_throughputSize)*BenchmarkIterations*BenchmarkIterations*1.0e3/elapsed);
+}
+
+/* A grid of size*size vertices, two triangles per cell */
+std::string generateObj(const UnsignedInt size, const bool textureCoordinatesNormals) {
+    std::string out;
+    for(UnsignedInt y = 0; y != size; ++y)
+        for(UnsignedInt x = 0; x != size; ++x)
+            out += Utility::formatString("v {} {} 0.5\n", Float(x)/size, Float(y)/size);
+
+    if(textureCoordinatesNormals) {
+        for(UnsignedInt y = 0; y != size; ++y)
+            for(UnsignedInt x = 0; x != size; ++x)
+                out += Utility::formatString("vt {} {}\n", Float(x)/size, Float(y)/size);
+        for(UnsignedInt i = 0; i != size*size; ++i)
+            out += "vn 0 0 1\n";
+    }
+
+    const char* const format = textureCoordinatesNormals ?
+        "f {0}/{0}/{0} {1}/{1}/{1} {2}/{2}/{2}\n" : "f {0} {1} {2}\n";
+    for(UnsignedInt y = 0; y != size - 1; ++y) {
+        for(UnsignedInt x = 0; x != size - 1; ++x) {
+            /* OBJ indices are one-based */
+            const UnsignedInt i = y*size + x + 1;
+            out += Utility::formatString(format, i, i + 1, i + size + 1);
+            out += Utility::formatString(format, i, i + size + 1, i + size);
+        }
+    }
+
+    return out;
+}
+
+void ObjImporterBenchmark::import() {
+    auto&& data = ImportData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+
+    const std::string obj = generateObj(data.size, data.textureCoordinatesNormals);
+    _throughputSize = obj.size();
+
+    Containers::Optional<MeshData> mesh;
+    CORRADE_BENCHMARK(BenchmarkIterations) {
+        importer->openData({obj.data(), obj.size()});
+        mesh = importer->mesh(0);
+    }
+
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->indexCount(), (data.size - 1)*(data.size - 1)*6);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::ObjImporterBenchmark)
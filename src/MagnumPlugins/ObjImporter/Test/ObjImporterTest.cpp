@@ -24,6 +24,7 @@
 */
 
 #include <sstream>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/String.h>
 #include <Corrade/TestSuite/Tester.h>
@@ -36,6 +37,7 @@
 #include "Magnum/Math/Vector3.h"
 #include "Magnum/Trade/AbstractImporter.h"
 #include "Magnum/Trade/MeshData.h"
+#include "Magnum/Trade/ParallelLoad.h"
 
 #include "configure.h"
 
@@ -58,6 +60,8 @@ struct ObjImporterTest: TestSuite::Tester {
     void meshTextureCoordinatesNormals();
 
     void meshIgnoredKeyword();
+    void meshWhitespaceNumberFormats();
+    void meshOpenMemory();
 
     void meshNamed();
     void meshNamedFirstUnnamed();
@@ -79,6 +83,9 @@ struct ObjImporterTest: TestSuite::Tester {
 
     void openTwice();
     void importTwice();
+    void importParallel();
+    void importMultithreaded();
+    void importMultithreadedInvalid();
 
     /* Explicitly forbid system-wide plugin dependencies */
     PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
@@ -122,7 +129,8 @@ const struct {
     {"position index out of range", "index 1 out of range for 1 vertices"},
     {"texture index out of range", "index 4 out of range for 3 vertices"},
     {"normal index out of range", "index 3 out of range for 2 vertices"},
-    {"zero index", "index 0 out of range for 1 vertices"}
+    {"zero index", "index 0 out of range for 1 vertices"},
+    {"float literal with trailing characters", "error while converting numeric data"}
 };
 
 const struct {
@@ -167,6 +175,66 @@ const struct {
     {"texture with optional third component not zero", "3D texture coordinates are not supported"}
 };
 
+const struct {
+    const char* name;
+    UnsignedInt threadCount;
+} ImportMultithreadedData[]{
+    {"all threads", 0},
+    {"two threads", 2},
+    {"five threads", 5}
+};
+
+const struct {
+    const char* name;
+    UnsignedInt threadCount;
+    const char* prefix;
+    const char* middle;
+    const char* suffix;
+    const char* message;
+} ImportMultithreadedInvalidData[]{
+    {"invalid number, two threads", 2,
+        "", "v 1.0 nope 2.0\n", "vn 1.0 0.0\n",
+        "error while converting numeric data"},
+    {"invalid number, five threads", 5,
+        "", "v 1.0 nope 2.0\n", "vn 1.0 0.0\n",
+        "error while converting numeric data"},
+    {"mixed primitives in different ranges, two threads", 2,
+        "f 1 2 3\n", "", "p 1\n",
+        "mixed primitive MeshPrimitive::Triangles and MeshPrimitive::Points"},
+    {"mixed primitives in different ranges, five threads", 5,
+        "f 1 2 3\n", "", "p 1\n",
+        "mixed primitive MeshPrimitive::Triangles and MeshPrimitive::Points"}
+};
+
+/* Vertex data of a 200x200 grid, over a megabyte in total so the file gets
+   split into several ranges when parsing on multiple threads */
+constexpr std::size_t GridSize = 200;
+
+std::string gridVertices(std::size_t begin, std::size_t end) {
+    std::string out;
+    for(std::size_t i = begin; i != end; ++i) {
+        const std::size_t x = i % GridSize, y = i/GridSize;
+        out += Utility::formatString("v {} {} {}\nvt {} {}\nvn 0.0 {} 1.0\n",
+            x*0.1f, y*0.1f, (x*y % 7)*0.1f,
+            x*0.005f, y*0.005f, (x % 3)*0.5f);
+    }
+    return out;
+}
+
+std::string gridFaces() {
+    std::string out;
+    for(std::size_t y = 0; y != GridSize - 1; ++y) {
+        for(std::size_t x = 0; x != GridSize - 1; ++x) {
+            const std::size_t a = y*GridSize + x + 1;
+            const std::size_t b = a + 1;
+            const std::size_t c = a + GridSize;
+            const std::size_t d = c + 1;
+            out += Utility::formatString("f {0}/{0}/{0} {1}/{1}/{1} {2}/{2}/{2}\nf {1}/{1}/{1} {3}/{3}/{3} {2}/{2}/{2}\n", a, b, c, d);
+        }
+    }
+    return out;
+}
+
 ObjImporterTest::ObjImporterTest() {
     addTests({&ObjImporterTest::empty,
 
@@ -181,6 +249,8 @@ ObjImporterTest::ObjImporterTest() {
               &ObjImporterTest::meshTextureCoordinatesNormals,
 
               &ObjImporterTest::meshIgnoredKeyword,
+              &ObjImporterTest::meshWhitespaceNumberFormats,
+              &ObjImporterTest::meshOpenMemory,
 
               &ObjImporterTest::meshNamed});
 
@@ -211,7 +281,14 @@ ObjImporterTest::ObjImporterTest() {
         Containers::arraySize(InvalidOptionalCoordinateData));
 
     addTests({&ObjImporterTest::openTwice,
-              &ObjImporterTest::importTwice});
+              &ObjImporterTest::importTwice,
+              &ObjImporterTest::importParallel});
+
+    addInstancedTests({&ObjImporterTest::importMultithreaded},
+        Containers::arraySize(ImportMultithreadedData));
+
+    addInstancedTests({&ObjImporterTest::importMultithreadedInvalid},
+        Containers::arraySize(ImportMultithreadedInvalidData));
 
     #ifdef OBJIMPORTER_PLUGIN_FILENAME
     CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(OBJIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
@@ -452,6 +529,56 @@ void ObjImporterTest::meshIgnoredKeyword() {
         TestSuite::Compare::Container);
 }
 
+void ObjImporterTest::meshWhitespaceNumberFormats() {
+    /* CRLF line endings, tabs and repeated spaces as separators, exponents,
+       signs, leading and trailing decimal points, a mantissa too long for the
+       fast path and an exponent too large for it */
+    const char data[] =
+        "# A comment\r\n"
+        "\r\n"
+        "v 1.5e1  -2.25E-1 +3\r\n"
+        "v\t0.000001\t123456789012345678901234 -0\r\n"
+        "  v .5 5. 1e-30\r\n"
+        "p 1\r\n"
+        "p\t2 \r\n"
+        "p 3";
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+    /* Not including the null terminator */
+    CORRADE_VERIFY(importer->openData(Containers::arrayView(data, sizeof(data) - 1)));
+    CORRADE_COMPARE(importer->meshCount(), 1);
+
+    const Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Points);
+    CORRADE_COMPARE_AS(mesh->attribute<Vector3>(MeshAttribute::Position),
+        Containers::arrayView<Vector3>({
+            {15.0f, -0.225f, 3.0f},
+            {0.000001f, 1.23456789e23f, 0.0f},
+            {0.5f, 5.0f, 1.0e-30f}
+        }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(mesh->indices<UnsignedInt>(),
+        Containers::arrayView<UnsignedInt>({0, 1, 2}),
+        TestSuite::Compare::Container);
+}
+
+void ObjImporterTest::meshOpenMemory() {
+    /* Same as meshPrimitivePoints(), except that the data are referenced
+       instead of copied. There's no observable difference except for the data
+       having to stay in scope. */
+    Containers::Optional<Containers::Array<char>> data = Utility::Path::read(Utility::Path::join(OBJIMPORTER_TEST_DIR, "mesh-primitive-points.obj"));
+    CORRADE_VERIFY(data);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+    CORRADE_VERIFY(importer->openMemory(*data));
+    CORRADE_COMPARE(importer->meshCount(), 1);
+
+    Containers::Optional<Trade::MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Points);
+    CORRADE_COMPARE(mesh->vertexCount(), 3);
+}
+
 void ObjImporterTest::meshNamed() {
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
     CORRADE_VERIFY(importer->openFile(Utility::Path::join(OBJIMPORTER_TEST_DIR, "mesh-named.obj")));
@@ -691,6 +818,82 @@ void ObjImporterTest::importTwice() {
     }
 }
 
+void ObjImporterTest::importParallel() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+    CORRADE_VERIFY(importer->features() & ImporterFeature::ThreadSafeImport);
+    CORRADE_VERIFY(importer->openFile(Utility::Path::join(OBJIMPORTER_TEST_DIR, "mesh-multiple.obj")));
+
+    /* Import each mesh several times to have the threads race on the same
+       data */
+    Containers::Array<Containers::Optional<MeshData>> meshes = parallelLoadMeshes(*importer, {0, 1, 2, 0, 1, 2, 0, 1, 2}, 4);
+    CORRADE_COMPARE(meshes.size(), 9);
+    for(std::size_t i = 0; i != meshes.size(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_VERIFY(meshes[i]);
+        Containers::Optional<MeshData> expected = importer->mesh(i % 3);
+        CORRADE_VERIFY(expected);
+        CORRADE_COMPARE(meshes[i]->primitive(), expected->primitive());
+        CORRADE_COMPARE_AS(meshes[i]->attribute<Vector3>(MeshAttribute::Position),
+            expected->attribute<Vector3>(MeshAttribute::Position),
+            TestSuite::Compare::Container);
+        CORRADE_COMPARE_AS(meshes[i]->indices<UnsignedInt>(),
+            expected->indices<UnsignedInt>(),
+            TestSuite::Compare::Container);
+    }
+}
+
+void ObjImporterTest::importMultithreaded() {
+    auto&& data = ImportMultithreadedData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const std::string obj = gridVertices(0, GridSize*GridSize) + gridFaces();
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+    importer->configuration().setValue("threadCount", 1);
+    CORRADE_VERIFY(importer->openData(Containers::arrayView(obj.data(), obj.size())));
+    Containers::Optional<MeshData> expected = importer->mesh(0);
+    CORRADE_VERIFY(expected);
+    CORRADE_COMPARE(expected->vertexCount(), GridSize*GridSize);
+
+    /* The output should be exactly the same as with a single thread */
+    importer->configuration().setValue("threadCount", data.threadCount);
+    Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE_AS(mesh->indices<UnsignedInt>(),
+        expected->indices<UnsignedInt>(),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(mesh->attribute<Vector3>(MeshAttribute::Position),
+        expected->attribute<Vector3>(MeshAttribute::Position),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(mesh->attribute<Vector2>(MeshAttribute::TextureCoordinates),
+        expected->attribute<Vector2>(MeshAttribute::TextureCoordinates),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(mesh->attribute<Vector3>(MeshAttribute::Normal),
+        expected->attribute<Vector3>(MeshAttribute::Normal),
+        TestSuite::Compare::Container);
+}
+
+void ObjImporterTest::importMultithreadedInvalid() {
+    auto&& data = ImportMultithreadedInvalidData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* The error in the middle is printed even though there's another one
+       later in the file, same as with a single thread */
+    const std::string obj = data.prefix +
+        gridVertices(0, GridSize*GridSize/2) + data.middle +
+        gridVertices(GridSize*GridSize/2, GridSize*GridSize) + data.suffix;
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+    importer->configuration().setValue("threadCount", data.threadCount);
+    CORRADE_VERIFY(importer->openData(Containers::arrayView(obj.data(), obj.size())));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->mesh(0));
+    CORRADE_COMPARE(out.str(), Utility::formatString("Trade::ObjImporter::mesh(): {}\n", data.message));
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Trade::Test::ObjImporterTest)
@@ -0,0 +1,134 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <chrono>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Trade/AbstractImageConverter.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct TgaImageConverterBenchmark: TestSuite::Tester {
+    explicit TgaImageConverterBenchmark();
+
+    void convert();
+
+    void throughputBegin();
+    std::uint64_t throughputEnd();
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractImageConverter> _manager{"nonexistent"};
+
+    std::size_t _throughputSize;
+    std::chrono::high_resolution_clock::time_point _throughputBegin;
+};
+
+constexpr std::size_t BenchmarkRepeats = 5;
+constexpr std::size_t BenchmarkIterations = 5;
+
+const struct {
+    const char* name;
+    Int size;
+    PixelFormat format;
+    bool rle;
+} ConvertData[]{
+    {"RGB, 256x256", 256, PixelFormat::RGB8Unorm, false},
+    {"RGB, 2048x2048", 2048, PixelFormat::RGB8Unorm, false},
+    {"RGBA, 2048x2048", 2048, PixelFormat::RGBA8Unorm, false},
+    {"grayscale, 2048x2048", 2048, PixelFormat::R8Unorm, false},
+    {"RGB RLE, 2048x2048", 2048, PixelFormat::RGB8Unorm, true},
+    {"grayscale RLE, 2048x2048", 2048, PixelFormat::R8Unorm, true},
+};
+
+TgaImageConverterBenchmark::TgaImageConverterBenchmark() {
+    /* Time of the conversion */
+    addInstancedBenchmarks({&TgaImageConverterBenchmark::convert},
+        BenchmarkRepeats, Containers::arraySize(ConvertData));
+
+    /* Megabytes of input data processed per second */
+    addCustomInstancedBenchmarks({&TgaImageConverterBenchmark::convert},
+        BenchmarkRepeats, Containers::arraySize(ConvertData),
+        &TgaImageConverterBenchmark::throughputBegin,
+        &TgaImageConverterBenchmark::throughputEnd,
+        BenchmarkUnits::Count);
+
+    /* Load the plugin directly from the build tree. Otherwise it's static and
+       already loaded. */
+    #ifdef TGAIMAGECONVERTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(TGAIMAGECONVERTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+}
+
+void TgaImageConverterBenchmark::throughputBegin() {
+    setBenchmarkName("MB/s");
+    _throughputBegin = std::chrono::high_resolution_clock::now();
+}
+
+std::uint64_t TgaImageConverterBenchmark::throughputEnd() {
+    const std::uint64_t elapsed = Math::max(std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - _throughputBegin).count()), std::uint64_t{1});
+
+    /* The returned value gets divided by the iteration count passed to
+       CORRADE_BENCHMARK(), so multiply it by the count once more to get
+       megabytes per second */
+    return std::uint64_t(Double(_throughputSize)*BenchmarkIterations*BenchmarkIterations*1.0e3/elapsed);
+}
+
+void TgaImageConverterBenchmark::convert() {
+    auto&& data = ConvertData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImageConverter> converter = _manager.instantiate("TgaImageConverter");
+    converter->configuration().setValue("rle", data.rle);
+
+    /* Sizes are all multiples of four so there's no row padding. For RLE the
+       data are runs of 16 equal pixels, uncompressed data are a gradient. */
+    const std::size_t pixelSize = pixelFormatSize(data.format);
+    Containers::Array<char> pixels{NoInit, std::size_t(data.size)*data.size*pixelSize};
+    for(std::size_t i = 0; i != pixels.size(); ++i)
+        pixels[i] = char(data.rle ? i/(16*pixelSize) : i);
+    const ImageView2D image{data.format, Vector2i{data.size}, pixels};
+    _throughputSize = pixels.size();
+
+    Containers::Optional<Containers::Array<char>> out;
+    CORRADE_BENCHMARK(BenchmarkIterations) {
+        out = converter->convertToData(image);
+    }
+
+    CORRADE_VERIFY(out);
+    /* Each run of 16 pixels is a header byte and a single pixel */
+    CORRADE_COMPARE(out->size(), 18 + (data.rle ? pixels.size()/(16*pixelSize)*(1 + pixelSize) : pixels.size()));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::TgaImageConverterBenchmark)
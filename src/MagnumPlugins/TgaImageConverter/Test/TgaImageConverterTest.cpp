@@ -27,15 +27,17 @@
 #include <tuple>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/Optional.h>
-#include <Corrade/Containers/StringView.h>
+#include <Corrade/Containers/String.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/DebugStl.h> /** @todo remove once Debug is stream-free */
 #include <Corrade/Utility/FormatStl.h>
 #include <Corrade/Utility/Path.h>
 
 #include "Magnum/ImageView.h"
 #include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Color.h"
 #include "Magnum/Trade/ImageData.h"
 #include "Magnum/Trade/AbstractImageConverter.h"
 #include "Magnum/Trade/AbstractImporter.h"
@@ -54,6 +56,13 @@ struct TgaImageConverterTest: TestSuite::Tester {
 
     void unsupportedMetadata();
 
+    void rle();
+    void rleLongRun();
+
+    void rows();
+    void rowsRle();
+    void rowsWrongFormat();
+
     /* Explicitly forbid system-wide plugin dependencies */
     PluginManager::Manager<AbstractImageConverter> _converterManager{"nonexistent"};
     PluginManager::Manager<AbstractImporter> _importerManager{"nonexistent"};
@@ -91,6 +100,13 @@ TgaImageConverterTest::TgaImageConverterTest() {
     addInstancedTests({&TgaImageConverterTest::unsupportedMetadata},
         Containers::arraySize(UnsupportedMetadataData));
 
+    addTests({&TgaImageConverterTest::rle,
+              &TgaImageConverterTest::rleLongRun,
+
+              &TgaImageConverterTest::rows,
+              &TgaImageConverterTest::rowsRle,
+              &TgaImageConverterTest::rowsWrongFormat});
+
     /* Load the plugin directly from the build tree. Otherwise it's static and
        already loaded. */
     #ifdef TGAIMAGECONVERTER_PLUGIN_FILENAME
@@ -100,6 +116,9 @@ TgaImageConverterTest::TgaImageConverterTest() {
     #ifdef TGAIMPORTER_PLUGIN_FILENAME
     CORRADE_INTERNAL_ASSERT_OUTPUT(_importerManager.load(TGAIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
     #endif
+
+    /* Create the output directory if it doesn't exist yet */
+    CORRADE_INTERNAL_ASSERT_OUTPUT(Utility::Path::make(TGAIMAGECONVERTER_TEST_OUTPUT_DIR));
 }
 
 void TgaImageConverterTest::wrongFormat() {
@@ -214,6 +233,144 @@ void TgaImageConverterTest::unsupportedMetadata() {
     CORRADE_COMPARE(out.str(), Utility::formatString("Trade::TgaImageConverter::convertToData(): {}\n", data.message));
 }
 
+/* Rows are 5 bytes, not padded */
+constexpr char OriginalDataRle[]{
+    7, 7, 7, 7, 1,
+    1, 2, 2, 3, 3
+};
+
+void TgaImageConverterTest::rle() {
+    Containers::Pointer<AbstractImageConverter> converter = _converterManager.instantiate("TgaImageConverter");
+    converter->configuration().setValue("rle", true);
+
+    Containers::Optional<Containers::Array<char>> array = converter->convertToData(ImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::R8Unorm, {5, 2}, OriginalDataRle});
+    CORRADE_VERIFY(array);
+
+    /* Image type is RLE grayscale */
+    CORRADE_COMPARE((*array)[2], 11);
+    /* A run of four in the first row and a raw packet for the rest, which
+       doesn't cross into the second row. Runs of two single-byte pixels
+       aren't worth it, so the second row is a single raw packet. */
+    CORRADE_COMPARE_AS(array->exceptPrefix(18), Containers::arrayView<char>({
+        char(0x83), 7, 0x00, 1,
+        0x04, 1, 2, 2, 3, 3
+    }), TestSuite::Compare::Container);
+
+    if(!(_importerManager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("TgaImporter plugin not enabled, can't test the result");
+
+    Containers::Pointer<AbstractImporter> importer = _importerManager.instantiate("TgaImporter");
+    CORRADE_VERIFY(importer->openData(*array));
+    Containers::Optional<Trade::ImageData2D> converted = importer->image2D(0);
+    CORRADE_VERIFY(converted);
+    CORRADE_COMPARE(converted->size(), Vector2i(5, 2));
+    CORRADE_COMPARE(converted->format(), PixelFormat::R8Unorm);
+    CORRADE_COMPARE_AS(converted->data(), Containers::arrayView(OriginalDataRle),
+        TestSuite::Compare::Container);
+}
+
+void TgaImageConverterTest::rleLongRun() {
+    Containers::Pointer<AbstractImageConverter> converter = _converterManager.instantiate("TgaImageConverter");
+    converter->configuration().setValue("rle", true);
+
+    /* 130 equal RGBA pixels followed by two different ones, which has to be
+       split into two repeat packets as a packet can have at most 128
+       pixels */
+    Color4ub pixels[132];
+    for(Color4ub& i: pixels) i = {1, 2, 3, 4};
+    pixels[130] = {5, 6, 7, 8};
+    pixels[131] = {9, 10, 11, 12};
+
+    Containers::Optional<Containers::Array<char>> array = converter->convertToData(ImageView2D{PixelFormat::RGBA8Unorm, {132, 1}, pixels});
+    CORRADE_VERIFY(array);
+
+    /* Image type is RLE color, channels are swizzled to BGRA */
+    CORRADE_COMPARE((*array)[2], 10);
+    CORRADE_COMPARE_AS(array->exceptPrefix(18), Containers::arrayView<char>({
+        char(0xff), 3, 2, 1, 4,
+        char(0x81), 3, 2, 1, 4,
+        0x01, 7, 6, 5, 8, 11, 10, 9, 12
+    }), TestSuite::Compare::Container);
+
+    if(!(_importerManager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("TgaImporter plugin not enabled, can't test the result");
+
+    Containers::Pointer<AbstractImporter> importer = _importerManager.instantiate("TgaImporter");
+    CORRADE_VERIFY(importer->openData(*array));
+    Containers::Optional<Trade::ImageData2D> converted = importer->image2D(0);
+    CORRADE_VERIFY(converted);
+    CORRADE_COMPARE(converted->size(), Vector2i(132, 1));
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Color4ub>(converted->data()),
+        Containers::ArrayView<const Color4ub>{pixels},
+        TestSuite::Compare::Container);
+}
+
+void TgaImageConverterTest::rows() {
+    Containers::Pointer<AbstractImageConverter> converter = _converterManager.instantiate("TgaImageConverter");
+    CORRADE_VERIFY(converter->features() & ImageConverterFeature::ConvertRows2DToFile);
+
+    Containers::String filename = Utility::Path::join(TGAIMAGECONVERTER_TEST_OUTPUT_DIR, "rows.tga");
+    if(Utility::Path::exists(filename))
+        CORRADE_VERIFY(Utility::Path::remove(filename));
+
+    /* Pass the padded RGB image in two parts, one and two rows */
+    CORRADE_VERIFY(converter->beginConvertRowsToFile(filename, PixelFormat::RGB8Unorm, {2, 3}));
+    CORRADE_VERIFY(converter->convertRowsToFile(ImageView2D{
+        PixelStorage{}.setSkip({0, 1, 0}),
+        PixelFormat::RGB8Unorm, {2, 1}, OriginalDataRGB}));
+    CORRADE_VERIFY(converter->convertRowsToFile(ImageView2D{
+        PixelStorage{}.setSkip({0, 2, 0}),
+        PixelFormat::RGB8Unorm, {2, 2}, OriginalDataRGB}));
+    CORRADE_VERIFY(converter->endConvertRowsToFile());
+
+    /* The output should be the same as when converting the whole image at
+       once */
+    Containers::Optional<Containers::Array<char>> expected = converter->convertToData(OriginalRGB);
+    CORRADE_VERIFY(expected);
+    Containers::Optional<Containers::Array<char>> actual = Utility::Path::read(filename);
+    CORRADE_VERIFY(actual);
+    CORRADE_COMPARE_AS(*actual, *expected,
+        TestSuite::Compare::Container);
+}
+
+void TgaImageConverterTest::rowsRle() {
+    Containers::Pointer<AbstractImageConverter> converter = _converterManager.instantiate("TgaImageConverter");
+    converter->configuration().setValue("rle", true);
+
+    Containers::String filename = Utility::Path::join(TGAIMAGECONVERTER_TEST_OUTPUT_DIR, "rows-rle.tga");
+    if(Utility::Path::exists(filename))
+        CORRADE_VERIFY(Utility::Path::remove(filename));
+
+    /* Pass the image row by row */
+    CORRADE_VERIFY(converter->beginConvertRowsToFile(filename, PixelFormat::R8Unorm, {5, 2}));
+    CORRADE_VERIFY(converter->convertRowsToFile(ImageView2D{
+        PixelStorage{}.setAlignment(1),
+        PixelFormat::R8Unorm, {5, 1}, OriginalDataRle}));
+    CORRADE_VERIFY(converter->convertRowsToFile(ImageView2D{
+        PixelStorage{}.setAlignment(1).setSkip({0, 1, 0}),
+        PixelFormat::R8Unorm, {5, 1}, OriginalDataRle}));
+    CORRADE_VERIFY(converter->endConvertRowsToFile());
+
+    /* As the packets don't cross rows, the output should be the same as when
+       converting the whole image at once */
+    Containers::Optional<Containers::Array<char>> expected = converter->convertToData(ImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::R8Unorm, {5, 2}, OriginalDataRle});
+    CORRADE_VERIFY(expected);
+    Containers::Optional<Containers::Array<char>> actual = Utility::Path::read(filename);
+    CORRADE_VERIFY(actual);
+    CORRADE_COMPARE_AS(*actual, *expected,
+        TestSuite::Compare::Container);
+}
+
+void TgaImageConverterTest::rowsWrongFormat() {
+    Containers::Pointer<AbstractImageConverter> converter = _converterManager.instantiate("TgaImageConverter");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!converter->beginConvertRowsToFile(Utility::Path::join(TGAIMAGECONVERTER_TEST_OUTPUT_DIR, "rows.tga"), PixelFormat::RG8Unorm, {1, 1}));
+    CORRADE_VERIFY(!converter->isConvertingRowsToFile());
+    CORRADE_COMPARE(out.str(), "Trade::TgaImageConverter::beginConvertRowsToFile(): unsupported pixel format PixelFormat::RG8Unorm\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Trade::Test::TgaImageConverterTest)
@@ -25,3 +25,4 @@
 
 #cmakedefine TGAIMAGECONVERTER_PLUGIN_FILENAME "${TGAIMAGECONVERTER_PLUGIN_FILENAME}"
 #cmakedefine TGAIMPORTER_PLUGIN_FILENAME "${TGAIMPORTER_PLUGIN_FILENAME}"
+#define TGAIMAGECONVERTER_TEST_OUTPUT_DIR "${TGAIMAGECONVERTER_TEST_OUTPUT_DIR}"
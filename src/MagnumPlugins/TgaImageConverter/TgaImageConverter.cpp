@@ -25,12 +25,16 @@
 
 #include "TgaImageConverter.h"
 
+#include <cstring>
 #include <fstream>
 #include <tuple>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/Endianness.h>
+#include <Corrade/Utility/Path.h>
 
 #include "Magnum/ImageView.h"
 #include "Magnum/PixelFormat.h"
@@ -44,7 +48,97 @@ TgaImageConverter::TgaImageConverter() = default;
 
 TgaImageConverter::TgaImageConverter(PluginManager::AbstractManager& manager, const Containers::StringView& plugin): AbstractImageConverter{manager, plugin} {}
 
-ImageConverterFeatures TgaImageConverter::doFeatures() const { return ImageConverterFeature::Convert2DToData; }
+ImageConverterFeatures TgaImageConverter::doFeatures() const { return ImageConverterFeature::Convert2DToData|ImageConverterFeature::ConvertRows2DToFile; }
+
+namespace {
+
+bool fillHeader(Implementation::TgaHeader& header, const PixelFormat format, const Vector2i& size, const bool rle, const char* const messagePrefix) {
+    switch(format) {
+        case PixelFormat::RGB8Unorm:
+        case PixelFormat::RGBA8Unorm:
+            header.imageType = rle ? 10 : 2;
+            break;
+        case PixelFormat::R8Unorm:
+            header.imageType = rle ? 11 : 3;
+            break;
+        default:
+            Error() << messagePrefix << "unsupported pixel format" << format;
+            return false;
+    }
+    header.bpp = pixelFormatSize(format)*8;
+    header.width = UnsignedShort(Utility::Endianness::littleEndian(size.x()));
+    header.height = UnsignedShort(Utility::Endianness::littleEndian(size.y()));
+    return true;
+}
+
+void swizzlePixels(const PixelFormat format, const Containers::ArrayView<char> pixels, const bool verbose, const char* const messagePrefix) {
+    if(format == PixelFormat::RGB8Unorm) {
+        if(verbose)
+            Debug{} << messagePrefix << "converting from RGB to BGR";
+        for(Vector3ub& pixel: Containers::arrayCast<Vector3ub>(pixels))
+            pixel = Math::gather<'b', 'g', 'r'>(pixel);
+    } else if(format == PixelFormat::RGBA8Unorm) {
+        if(verbose)
+            Debug{} << messagePrefix << "converting from RGBA to BGRA";
+        for(Vector4ub& pixel: Containers::arrayCast<Vector4ub>(pixels))
+            pixel = Math::gather<'b', 'g', 'r', 'a'>(pixel);
+    }
+}
+
+/* Upper bound for RLE output size. A repeat packet is always at least one
+   byte smaller than the pixels it replaces, which pays for the header of a
+   raw packet that got split by it, so the worst case is raw packets only. */
+std::size_t rleBound(const Vector2i& size, const std::size_t pixelSize) {
+    return std::size_t(size.y())*(std::size_t(size.x())*pixelSize + size.x()/128 + 1);
+}
+
+/* Count of pixels equal to the one at x, including it, at most limit */
+inline std::size_t runLength(const char* const row, const std::size_t x, const std::size_t width, const std::size_t pixelSize, const std::size_t limit) {
+    const char* const pixel = row + x*pixelSize;
+    std::size_t run = 1;
+    while(run != limit && x + run != width && std::memcmp(pixel + run*pixelSize, pixel, pixelSize) == 0)
+        ++run;
+    return run;
+}
+
+/* Encodes tightly packed pixels into RLE packets, returns the size of the
+   output. Packets never cross rows, as recommended by the TGA 2.0 spec,
+   which also makes row ranges encodable independently. */
+std::size_t encodeRle(const Containers::ArrayView<const char> pixels, const Vector2i& size, const std::size_t pixelSize, const Containers::ArrayView<char> out) {
+    /* For single-byte pixels a run of two is as large as a raw packet of two,
+       so it makes sense only from three on */
+    const std::size_t minRun = pixelSize == 1 ? 3 : 2;
+    const std::size_t width = size.x();
+    char* o = out.data();
+    for(std::size_t y = 0; y != std::size_t(size.y()); ++y) {
+        const char* const row = pixels.data() + y*width*pixelSize;
+        for(std::size_t x = 0; x != width; ) {
+            /* Repeat packet, a header and a single pixel */
+            const std::size_t run = runLength(row, x, width, pixelSize, 128);
+            if(run >= minRun) {
+                *o++ = char(0x80|(run - 1));
+                std::memcpy(o, row + x*pixelSize, pixelSize);
+                o += pixelSize;
+                x += run;
+                continue;
+            }
+
+            /* Raw packet, gathering pixels until a long enough run starts */
+            std::size_t count = run;
+            while(count != 128 && x + count != width && runLength(row, x + count, width, pixelSize, minRun) < minRun)
+                ++count;
+            *o++ = char(count - 1);
+            std::memcpy(o, row + x*pixelSize, count*pixelSize);
+            o += count*pixelSize;
+            x += count;
+        }
+    }
+
+    CORRADE_INTERNAL_ASSERT(std::size_t(o - out.data()) <= out.size());
+    return o - out.data();
+}
+
+}
 
 Containers::Optional<Containers::Array<char>> TgaImageConverter::doConvertToData(const ImageView2D& image) {
     /* Warn about lost metadata */
@@ -52,50 +146,104 @@ Containers::Optional<Containers::Array<char>> TgaImageConverter::doConvertToData
         Warning{} << "Trade::TgaImageConverter::convertToData(): 1D array images are unrepresentable in TGA, saving as a regular 2D image";
     }
 
+    const bool rle = configuration().value<bool>("rle");
+
     /* Initialize data buffer */
     const auto pixelSize = UnsignedByte(image.pixelSize());
     Containers::Array<char> data{ValueInit, sizeof(Implementation::TgaHeader) + pixelSize*image.size().product()};
 
     /* Fill header */
-    auto header = reinterpret_cast<Implementation::TgaHeader*>(data.begin());
-    switch(image.format()) {
-        case PixelFormat::RGB8Unorm:
-        case PixelFormat::RGBA8Unorm:
-            header->imageType = 2;
-            break;
-        case PixelFormat::R8Unorm:
-            header->imageType = 3;
-            break;
-        default:
-            Error() << "Trade::TgaImageConverter::convertToData(): unsupported pixel format" << image.format();
-            return {};
-    }
-    header->bpp = pixelSize*8;
-    header->width = UnsignedShort(Utility::Endianness::littleEndian(image.size().x()));
-    header->height = UnsignedShort(Utility::Endianness::littleEndian(image.size().y()));
+    if(!fillHeader(*reinterpret_cast<Implementation::TgaHeader*>(data.begin()), image.format(), image.size(), rle, "Trade::TgaImageConverter::convertToData():"))
+        return {};
 
     /* Copy the pixels into output, dropping padding (if any) */
     const Containers::ArrayView<char> pixels = data.exceptPrefix(sizeof(Implementation::TgaHeader));
     Utility::copy(image.pixels(), Containers::StridedArrayView3D<char>{pixels,
         {std::size_t(image.size().y()), std::size_t(image.size().x()), pixelSize}});
 
-    if(image.format() == PixelFormat::RGB8Unorm) {
-        if(flags() & ImageConverterFlag::Verbose)
-            Debug{} << "Trade::TgaImageConverter::convertToData(): converting from RGB to BGR";
-        for(Vector3ub& pixel: Containers::arrayCast<Vector3ub>(pixels))
-            pixel = Math::gather<'b', 'g', 'r'>(pixel);
-    } else if(image.format() == PixelFormat::RGBA8Unorm) {
+    swizzlePixels(image.format(), pixels, bool(flags() & ImageConverterFlag::Verbose), "Trade::TgaImageConverter::convertToData():");
+
+    /* Compress the tightly packed pixels into a separate allocation, copy
+       the header and the result into a final exactly-sized one */
+    if(rle) {
+        Containers::Array<char> compressed{NoInit, rleBound(image.size(), pixelSize)};
+        const std::size_t compressedSize = encodeRle(pixels, image.size(), pixelSize, compressed);
+
+        Containers::Array<char> out{NoInit, sizeof(Implementation::TgaHeader) + compressedSize};
+        Utility::copy(data.prefix(sizeof(Implementation::TgaHeader)), out.prefix(sizeof(Implementation::TgaHeader)));
+        Utility::copy(compressed.prefix(compressedSize), out.exceptPrefix(sizeof(Implementation::TgaHeader)));
+
         if(flags() & ImageConverterFlag::Verbose)
-            Debug{} << "Trade::TgaImageConverter::convertToData(): converting from RGBA to BGRA";
-        for(Vector4ub& pixel: Containers::arrayCast<Vector4ub>(pixels))
-            pixel = Math::gather<'b', 'g', 'r', 'a'>(pixel);
+            Debug{} << "Trade::TgaImageConverter::convertToData(): RLE-compressed" << pixels.size() << "bytes to" << compressedSize;
+
+        /* GCC 4.8 needs extra help here */
+        return Containers::optional(std::move(out));
     }
 
     /* GCC 4.8 needs extra help here */
     return Containers::optional(std::move(data));
 }
 
+bool TgaImageConverter::doBeginConvertRowsToFile(const Containers::StringView filename, const PixelFormat format, const Vector2i& size) {
+    /* Query the option here so the header and all rows agree even if it
+       gets changed in the middle */
+    const bool rle = configuration().value<bool>("rle");
+
+    Implementation::TgaHeader header{};
+    if(!fillHeader(header, format, size, rle, "Trade::TgaImageConverter::beginConvertRowsToFile():"))
+        return false;
+
+    /* The file is reopened for every row range instead of keeping a stream
+       open. Utility::Path takes care of UTF-8 filenames on Windows and the
+       row ranges are expected to be large enough for this to not matter. */
+    if(!Utility::Path::write(filename, Containers::arrayView(&header, 1))) {
+        Error{} << "Trade::TgaImageConverter::beginConvertRowsToFile(): cannot write to file" << filename;
+        return false;
+    }
+
+    _rowsFilename = filename;
+    _rowsRle = rle;
+    return true;
+}
+
+bool TgaImageConverter::doConvertRowsToFile(const ImageView2D& rows) {
+    /* Copy the pixels into a temporary, dropping padding (if any) and
+       swizzling to BGR(A). This is proportional to the row range size, not
+       to the whole image. */
+    const std::size_t pixelSize = rows.pixelSize();
+    Containers::Array<char> data{NoInit, pixelSize*rows.size().product()};
+    Utility::copy(rows.pixels(), Containers::StridedArrayView3D<char>{data,
+        {std::size_t(rows.size().y()), std::size_t(rows.size().x()), pixelSize}});
+
+    swizzlePixels(rows.format(), data, bool(flags() & ImageConverterFlag::Verbose), "Trade::TgaImageConverter::convertRowsToFile():");
+
+    /* RLE packets don't cross rows, so each row range can be compressed
+       independently */
+    if(_rowsRle) {
+        Containers::Array<char> compressed{NoInit, rleBound(rows.size(), pixelSize)};
+        const std::size_t compressedSize = encodeRle(data, rows.size(), pixelSize, compressed);
+        if(!Utility::Path::append(_rowsFilename, compressed.prefix(compressedSize))) {
+            Error{} << "Trade::TgaImageConverter::convertRowsToFile(): cannot write to file" << _rowsFilename;
+            return false;
+        }
+
+        return true;
+    }
+
+    if(!Utility::Path::append(_rowsFilename, data)) {
+        Error{} << "Trade::TgaImageConverter::convertRowsToFile(): cannot write to file" << _rowsFilename;
+        return false;
+    }
+
+    return true;
+}
+
+bool TgaImageConverter::doEndConvertRowsToFile() {
+    _rowsFilename = {};
+    return true;
+}
+
 }}
 
 CORRADE_PLUGIN_REGISTER(TgaImageConverter, Magnum::Trade::TgaImageConverter,
-    "cz.mosra.magnum.Trade.AbstractImageConverter/0.3.2")
+    "cz.mosra.magnum.Trade.AbstractImageConverter/0.3.3")
@@ -29,6 +29,8 @@
  * @brief Class @ref Magnum::Trade::TgaImageConverter
  */
 
+#include <Corrade/Containers/String.h>
+
 #include "Magnum/Trade/AbstractImageConverter.h"
 
 #include "MagnumPlugins/TgaImageConverter/configure.h"
@@ -91,12 +93,35 @@ information.
 
 @section Trade-TgaImageConverter-behavior Behavior and limitations
 
-The output is always uncompressed. If you want to make use of RLE compression
-and have the files smaller, use the @ref StbImageConverter plugin instead.
+The output is uncompressed by default. If the @cb{.ini} rle @ce
+@ref Trade-TgaImageConverter-configuration "configuration option" is enabled,
+the data are RLE-compressed instead, which can be imported back with the
+@ref TgaImporter plugin. Runs of identical pixels are stored as repeat
+packets, everything else as raw packets, so in the worst case the output is
+just a byte per row and every 128 pixels larger than uncompressed. Packets
+don't cross row boundaries.
 
 The TGA file format doesn't have a way to distinguish between 2D and 1D array
 images. If an image has @ref ImageFlag2D::Array set, a warning is printed and
 the file is saved as a regular 2D image.
+
+The plugin supports @ref ImageConverterFeature::ConvertRows2DToFile. With
+@ref beginConvertRowsToFile() the header is written and each
+@ref convertRowsToFile() call appends the passed rows to the file, so only the
+currently passed rows need to be in memory. This works with RLE compression
+as well, the @cb{.ini} rle @ce option is queried in
+@ref beginConvertRowsToFile() and the result is the same as when converting
+the whole image at once.
+
+@section Trade-TgaImageConverter-configuration Plugin-specific configuration
+
+It's possible to tune various output options through @ref configuration(). See
+below for all options and their default values:
+
+@snippet MagnumPlugins/TgaImageConverter/TgaImageConverter.conf configuration_
+
+See @ref plugins-configuration for more information and an example showing how
+to edit the configuration values.
 */
 class MAGNUM_TGAIMAGECONVERTER_EXPORT TgaImageConverter: public AbstractImageConverter {
     public:
@@ -109,6 +134,12 @@ class MAGNUM_TGAIMAGECONVERTER_EXPORT TgaImageConverter: public AbstractImageCon
     private:
         ImageConverterFeatures MAGNUM_TGAIMAGECONVERTER_LOCAL doFeatures() const override;
         Containers::Optional<Containers::Array<char>> MAGNUM_TGAIMAGECONVERTER_LOCAL doConvertToData(const ImageView2D& image) override;
+        bool MAGNUM_TGAIMAGECONVERTER_LOCAL doBeginConvertRowsToFile(Containers::StringView filename, PixelFormat format, const Vector2i& size) override;
+        bool MAGNUM_TGAIMAGECONVERTER_LOCAL doConvertRowsToFile(const ImageView2D& rows) override;
+        bool MAGNUM_TGAIMAGECONVERTER_LOCAL doEndConvertRowsToFile() override;
+
+        Containers::String _rowsFilename;
+        bool _rowsRle;
 };
 
 }}
@@ -0,0 +1,152 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <chrono>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/ImageData.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct TgaImporterBenchmark: TestSuite::Tester {
+    explicit TgaImporterBenchmark();
+
+    void import();
+
+    void throughputBegin();
+    std::uint64_t throughputEnd();
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
+
+    std::size_t _throughputSize;
+    std::chrono::high_resolution_clock::time_point _throughputBegin;
+};
+
+constexpr std::size_t BenchmarkRepeats = 5;
+constexpr std::size_t BenchmarkIterations = 5;
+
+const struct {
+    const char* name;
+    Int size;
+    UnsignedByte bpp;
+    bool rle;
+} ImportData[]{
+    {"RGB, 256x256", 256, 24, false},
+    {"RGB, 2048x2048", 2048, 24, false},
+    {"RGBA, 2048x2048", 2048, 32, false},
+    {"grayscale, 2048x2048", 2048, 8, false},
+    {"RGB RLE, 256x256", 256, 24, true},
+    {"RGB RLE, 2048x2048", 2048, 24, true},
+};
+
+TgaImporterBenchmark::TgaImporterBenchmark() {
+    /* Time of open + import */
+    addInstancedBenchmarks({&TgaImporterBenchmark::import},
+        BenchmarkRepeats, Containers::arraySize(ImportData));
+
+    /* Megabytes of input data processed per second */
+    addCustomInstancedBenchmarks({&TgaImporterBenchmark::import},
+        BenchmarkRepeats, Containers::arraySize(ImportData),
+        &TgaImporterBenchmark::throughputBegin,
+        &TgaImporterBenchmark::throughputEnd,
+        BenchmarkUnits::Count);
+
+    /* Load the plugin directly from the build tree. Otherwise it's static and
+       already loaded. */
+    #ifdef TGAIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(TGAIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+}
+
+void TgaImporterBenchmark::throughputBegin() {
+    setBenchmarkName("MB/s");
+    _throughputBegin = std::chrono::high_resolution_clock::now();
+}
+
+std::uint64_t TgaImporterBenchmark::throughputEnd() {
+    const std::uint64_t elapsed = Math::max(std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - _throughputBegin).count()), std::uint64_t{1});
+
+    /* The returned value gets divided by the iteration count passed to
+       CORRADE_BENCHMARK(), so multiply it by the count once more to get
+       megabytes per second */
+    return std::uint64_t(Double(_throughputSize)*BenchmarkIterations*BenchmarkIterations*1.0e3/elapsed);
+}
+
+Containers::Array<char> generateTga(const Int size, const UnsignedByte bpp, const bool rle) {
+    const std::size_t pixelSize = bpp/8;
+    const std::size_t pixelCount = std::size_t(size)*size;
+
+    /* RLE data are a repeat packet for every 16 pixels, which is the best
+       case for the decoder, uncompressed data are a gradient */
+    const std::size_t dataSize = rle ? pixelCount/16*(1 + pixelSize) : pixelCount*pixelSize;
+    Containers::Array<char> out{ValueInit, 18 + dataSize};
+    out[2] = bpp == 8 ? (rle ? 11 : 3) : (rle ? 10 : 2);
+    out[12] = char(size & 0xff);
+    out[13] = char(size >> 8);
+    out[14] = char(size & 0xff);
+    out[15] = char(size >> 8);
+    out[16] = char(bpp);
+
+    char* data = out + 18;
+    if(rle) for(std::size_t i = 0; i != pixelCount/16; ++i) {
+        *data++ = char(0x80|15);
+        for(std::size_t j = 0; j != pixelSize; ++j)
+            *data++ = char(i*pixelSize + j);
+    } else for(std::size_t i = 0; i != pixelCount*pixelSize; ++i)
+        data[i] = char(i);
+
+    return out;
+}
+
+void TgaImporterBenchmark::import() {
+    auto&& data = ImportData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+
+    const Containers::Array<char> tga = generateTga(data.size, data.bpp, data.rle);
+    _throughputSize = tga.size();
+
+    Containers::Optional<ImageData2D> image;
+    CORRADE_BENCHMARK(BenchmarkIterations) {
+        importer->openData(tga);
+        image = importer->image2D(0);
+    }
+
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->size(), Vector2i{data.size});
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::TgaImporterBenchmark)
@@ -24,19 +24,22 @@
 */
 
 #include <sstream>
-#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/String.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/FormatStl.h>
 #include <Corrade/Utility/Path.h>
 
 #include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Range.h"
 #include "Magnum/Trade/AbstractImporter.h"
 #include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/ParallelLoad.h"
 
 #include "configure.h"
 
@@ -58,12 +61,22 @@ struct TgaImporterTest: TestSuite::Tester {
     void color32Rle();
     void grayscale8();
     void grayscale8Rle();
+    void topDown();
 
+    void rleLongRun();
     void rleTooLarge();
 
+    void size();
+    void rows();
+    void rowsOutOfRange();
+    void rowsRleShort();
+    void rowsRleTooLarge();
+
     void openMemory();
+    void openMemoryZeroCopy();
     void openTwice();
     void importTwice();
+    void importParallel();
 
     /* Explicitly forbid system-wide plugin dependencies */
     PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
@@ -100,6 +113,21 @@ constexpr const char Color24[] = {
     5, 6, 7, 6, 7, 8
 };
 
+/* Same pixels as Color24 but with the top-down bit set in the descriptor */
+constexpr const char Color24TopDown[] = {
+    0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 3, 0, 24, 0x20,
+    1, 2, 3, 2, 3, 4,
+    3, 4, 5, 4, 5, 6,
+    5, 6, 7, 6, 7, 8
+};
+
+constexpr const char Grayscale8[] = {
+    0, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 3, 0, 8, 0,
+    1, 2,
+    3, 4,
+    5, 6
+};
+
 constexpr const char Color24Rle[] = {
     0, 0, 10, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 3, 0, 24, 0,
     /* 3 pixels as-is */
@@ -126,6 +154,35 @@ const struct {
         "RLE file too short at pixel 0"}
 };
 
+/* Same for both the RLE and non-RLE variant */
+constexpr const char Color24Row0[] = {3, 2, 1, 4, 3, 2};
+constexpr const char Color24Row1[] = {5, 4, 3, 6, 5, 4};
+constexpr const char Color24Rows12[] = {5, 4, 3, 6, 5, 4, 7, 6, 5, 8, 7, 6};
+constexpr const char Color24RleRows12[] = {5, 4, 3, 6, 5, 4, 6, 5, 4, 6, 5, 4};
+constexpr const char Color24Row2[] = {7, 6, 5, 8, 7, 6};
+constexpr const char Color24Rows01[] = {3, 2, 1, 4, 3, 2, 5, 4, 3, 6, 5, 4};
+
+/* MSVC 2015 crashes when seeing constexpr here. Not doing that, then. */
+const struct {
+    const char* name;
+    Containers::ArrayView<const char> data;
+    Range1Dui rows;
+    Containers::ArrayView<const char> expected;
+} RowsData[] {
+    {"first row", Color24, {0, 1}, Color24Row0},
+    {"middle row", Color24, {1, 2}, Color24Row1},
+    {"last two rows", Color24, {1, 3}, Color24Rows12},
+    {"empty", Color24, {2, 2}, nullptr},
+    {"RLE, first row, packet split", Color24Rle, {0, 1}, Color24Row0},
+    {"RLE, middle row, packet split", Color24Rle, {1, 2}, Color24Row1},
+    {"RLE, last two rows", Color24Rle, {1, 3}, Color24RleRows12},
+    {"RLE, empty", Color24Rle, {1, 1}, nullptr},
+    /* The first row in the file is the last one in the output */
+    {"top-down, first row", Color24TopDown, {0, 1}, Color24Row2},
+    {"top-down, last row", Color24TopDown, {2, 3}, Color24Row0},
+    {"top-down, last two rows", Color24TopDown, {1, 3}, Color24Rows01},
+};
+
 /* Shared among all plugins that implement data copying optimizations */
 const struct {
     const char* name;
@@ -142,6 +199,21 @@ const struct {
     }},
 };
 
+/* MSVC 2015 crashes when seeing constexpr here. Not doing that, then. */
+const struct {
+    const char* name;
+    Containers::ArrayView<const char> data;
+    bool swizzle;
+    PixelFormat format;
+    ImageFlags2D flags;
+    /* Offset of the row 1 in the file, relative to the pixel data start */
+    std::size_t row1Offset;
+} ZeroCopyData[] {
+    {"grayscale", Grayscale8, true, PixelFormat::R8Unorm, {}, 2},
+    {"color, swizzle disabled", Color24, false, PixelFormat::RGB8Unorm, {}, 6},
+    {"color, top-down, swizzle disabled", Color24TopDown, false, PixelFormat::RGB8Unorm, ImageFlag2D::YDown, 6},
+};
+
 TgaImporterTest::TgaImporterTest() {
     addTests({&TgaImporterTest::openEmpty});
 
@@ -164,14 +236,29 @@ TgaImporterTest::TgaImporterTest() {
 
     addTests({&TgaImporterTest::grayscale8,
               &TgaImporterTest::grayscale8Rle,
+              &TgaImporterTest::topDown,
+
+              &TgaImporterTest::rleLongRun,
+              &TgaImporterTest::rleTooLarge,
+
+              &TgaImporterTest::size});
+
+    addInstancedTests({&TgaImporterTest::rows},
+        Containers::arraySize(RowsData));
 
-              &TgaImporterTest::rleTooLarge});
+    addTests({&TgaImporterTest::rowsOutOfRange,
+              &TgaImporterTest::rowsRleShort,
+              &TgaImporterTest::rowsRleTooLarge});
 
     addInstancedTests({&TgaImporterTest::openMemory},
         Containers::arraySize(OpenMemoryData));
 
+    addInstancedTests({&TgaImporterTest::openMemoryZeroCopy},
+        Containers::arraySize(ZeroCopyData));
+
     addTests({&TgaImporterTest::openTwice,
-              &TgaImporterTest::importTwice});
+              &TgaImporterTest::importTwice,
+              &TgaImporterTest::importParallel});
 
     /* Load the plugin directly from the build tree. Otherwise it's static and
        already loaded. */
@@ -369,13 +456,7 @@ void TgaImporterTest::color32Rle() {
 
 void TgaImporterTest::grayscale8() {
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
-    const char data[] = {
-        0, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 3, 0, 8, 0,
-        1, 2,
-        3, 4,
-        5, 6
-    };
-    CORRADE_VERIFY(importer->openData(data));
+    CORRADE_VERIFY(importer->openData(Grayscale8));
 
     Containers::Optional<Trade::ImageData2D> image = importer->image2D(0);
     CORRADE_VERIFY(image);
@@ -418,6 +499,53 @@ void TgaImporterTest::grayscale8Rle() {
     }), TestSuite::Compare::Container);
 }
 
+void TgaImporterTest::topDown() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    importer->setFlags(ImporterFlag::Verbose);
+    CORRADE_VERIFY(importer->openData(Color24TopDown));
+
+    std::ostringstream out;
+    Containers::Optional<Trade::ImageData2D> image;
+    {
+        Debug redirectOutput{&out};
+        image = importer->image2D(0);
+    }
+    CORRADE_VERIFY(image);
+    /* The data are copied, so they get flipped to bottom-up */
+    CORRADE_COMPARE(image->flags(), ImageFlags2D{});
+    CORRADE_COMPARE(image->dataFlags(), DataFlag::Owned|DataFlag::Mutable);
+    CORRADE_COMPARE(image->format(), PixelFormat::RGB8Unorm);
+    CORRADE_COMPARE(image->size(), Vector2i(2, 3));
+    CORRADE_COMPARE_AS(image->data(), Containers::arrayView<char>({
+        7, 6, 5, 8, 7, 6,
+        5, 4, 3, 6, 5, 4,
+        3, 2, 1, 4, 3, 2
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(out.str(),
+        "Trade::TgaImporter::image2D(): converting from BGR to RGB\n"
+        "Trade::TgaImporter::image2D(): flipping the image from top-down to bottom-up\n");
+}
+
+void TgaImporterTest::rleLongRun() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    /* A run of seven 24-bit pixels crossing a row boundary, which needs the
+       last doubling step to be partial, followed by a single raw pixel */
+    const char data[] = {
+        0, 0, 10, 0, 0, 0, 0, 0, 0, 0, 0, 0, 4, 0, 2, 0, 24, 0,
+        '\x86', 1, 2, 3,
+        '\x00', 4, 5, 6
+    };
+    CORRADE_VERIFY(importer->openData(data));
+
+    Containers::Optional<Trade::ImageData2D> image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->size(), Vector2i(4, 2));
+    CORRADE_COMPARE_AS(image->data(), Containers::arrayView<char>({
+        3, 2, 1, 3, 2, 1, 3, 2, 1, 3, 2, 1,
+        3, 2, 1, 3, 2, 1, 3, 2, 1, 6, 5, 4
+    }), TestSuite::Compare::Container);
+}
+
 void TgaImporterTest::rleTooLarge() {
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
     const char data[] = {
@@ -437,6 +565,83 @@ void TgaImporterTest::rleTooLarge() {
     CORRADE_COMPARE(out.str(), "Trade::TgaImporter::image2D(): RLE data larger than advertised Vector(2, 3) pixels at byte 28\n");
 }
 
+void TgaImporterTest::size() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    /* Only the header is parsed, so this works for a truncated file too */
+    CORRADE_VERIFY(importer->openData(Containers::arrayView(Color24Rle).prefix(19)));
+
+    Containers::Optional<Vector2i> imageSize = importer->image2DSize(0);
+    CORRADE_VERIFY(imageSize);
+    CORRADE_COMPARE(*imageSize, (Vector2i{2, 3}));
+}
+
+void TgaImporterTest::rows() {
+    auto&& data = RowsData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    CORRADE_VERIFY(importer->openData(data.data));
+
+    Containers::Optional<Trade::ImageData2D> image = importer->image2DRows(0, 0, data.rows);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->storage().alignment(), 1);
+    CORRADE_COMPARE(image->format(), PixelFormat::RGB8Unorm);
+    CORRADE_COMPARE(image->size(), (Vector2i{2, Int(data.rows.size())}));
+    CORRADE_COMPARE_AS(image->data(), data.expected,
+        TestSuite::Compare::Container);
+}
+
+void TgaImporterTest::rowsOutOfRange() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    CORRADE_VERIFY(importer->openData(Color24));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->image2DRows(0, 0, {2, 4}));
+    CORRADE_COMPARE(out.str(), "Trade::TgaImporter::image2DRows(): rows 2 to 4 out of range for an image of 3 rows\n");
+}
+
+void TgaImporterTest::rowsRleShort() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    CORRADE_VERIFY(importer->openData(Containers::arrayView(Color24Rle).exceptSuffix(1)));
+
+    /* The first row is fully contained in the first packet, which is fine */
+    Containers::Optional<Trade::ImageData2D> image = importer->image2DRows(0, 0, {0, 1});
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE_AS(image->data(), Containers::arrayView(Color24Row0),
+        TestSuite::Compare::Container);
+
+    /* The second row needs the truncated packet */
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->image2DRows(0, 0, {1, 2}));
+    CORRADE_COMPARE(out.str(), "Trade::TgaImporter::image2DRows(): RLE file too short at pixel 3\n");
+}
+
+void TgaImporterTest::rowsRleTooLarge() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    const char data[] = {
+        0, 0, 10, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 3, 0, 24, 0,
+        /* 3 pixels as-is */
+        '\x02', 1, 2, 3,
+                2, 3, 4,
+                3, 4, 5,
+        /* 1 pixel 4x repeated (one more than it should be) */
+        '\x83', 4, 5, 6
+    };
+    CORRADE_VERIFY(importer->openData(data));
+
+    /* Decoding stops after the requested rows, so the error isn't detected
+       here */
+    CORRADE_VERIFY(importer->image2DRows(0, 0, {0, 1}));
+
+    /* But it is if the range includes the last row */
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->image2DRows(0, 0, {2, 3}));
+    CORRADE_COMPARE(out.str(), "Trade::TgaImporter::image2DRows(): RLE data larger than advertised Vector(2, 3) pixels at byte 28\n");
+}
+
 void TgaImporterTest::openMemory() {
     /* same as dxt1() except that it uses openData() & openMemory() to test
        data copying on import */
@@ -452,6 +657,8 @@ void TgaImporterTest::openMemory() {
     Containers::Optional<Trade::ImageData2D> image = importer->image2D(0);
     CORRADE_VERIFY(image);
     CORRADE_COMPARE(image->flags(), ImageFlags2D{});
+    /* The data need to be swizzled, so they're always copied */
+    CORRADE_COMPARE(image->dataFlags(), DataFlag::Owned|DataFlag::Mutable);
     CORRADE_COMPARE(image->storage().alignment(), 1);
     CORRADE_COMPARE(image->format(), PixelFormat::RGB8Unorm);
     CORRADE_COMPARE(image->size(), Vector2i(2, 3));
@@ -462,6 +669,43 @@ void TgaImporterTest::openMemory() {
     }), TestSuite::Compare::Container);
 }
 
+void TgaImporterTest::openMemoryZeroCopy() {
+    auto&& data = ZeroCopyData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    importer->configuration().setValue("swizzle", data.swizzle);
+    CORRADE_VERIFY(importer->openMemory(data.data));
+
+    const char* const pixels = data.data.data() + 18;
+
+    Containers::Optional<Trade::ImageData2D> image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->flags(), data.flags);
+    CORRADE_COMPARE(image->dataFlags(), DataFlags{});
+    CORRADE_COMPARE(image->format(), data.format);
+    CORRADE_COMPARE(image->size(), Vector2i(2, 3));
+    CORRADE_COMPARE(static_cast<const void*>(image->data().data()), pixels);
+    CORRADE_COMPARE(image->data().size(), data.data.size() - 18);
+
+    /* The middle row is at the same place in the file for both bottom-up and
+       top-down files */
+    Containers::Optional<Trade::ImageData2D> row = importer->image2DRows(0, 0, {1, 2});
+    CORRADE_VERIFY(row);
+    CORRADE_COMPARE(row->flags(), data.flags);
+    CORRADE_COMPARE(row->dataFlags(), DataFlags{});
+    CORRADE_COMPARE(row->size(), Vector2i(2, 1));
+    CORRADE_COMPARE(static_cast<const void*>(row->data().data()), pixels + data.row1Offset);
+
+    /* Opening a copy of the data makes the importer copy them as well */
+    CORRADE_VERIFY(importer->openData(data.data));
+    image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->dataFlags(), DataFlag::Owned|DataFlag::Mutable);
+    /* Copied data are always bottom-up */
+    CORRADE_COMPARE(image->flags(), ImageFlags2D{});
+}
+
 void TgaImporterTest::openTwice() {
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
 
@@ -487,6 +731,28 @@ void TgaImporterTest::importTwice() {
     }
 }
 
+void TgaImporterTest::importParallel() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    CORRADE_VERIFY(importer->features() & ImporterFeature::ThreadSafeImport);
+    CORRADE_VERIFY(importer->openFile(Utility::Path::join(TGAIMPORTER_TEST_DIR, "file.tga")));
+
+    Containers::Optional<Trade::ImageData2D> expected = importer->image2D(0);
+    CORRADE_VERIFY(expected);
+
+    /* There's just one image, import it several times to have the threads
+       race on the same data */
+    Containers::Array<Containers::Optional<ImageData2D>> images = parallelLoadImages2D(*importer, {0, 0, 0, 0, 0, 0, 0, 0}, 4);
+    CORRADE_COMPARE(images.size(), 8);
+    for(std::size_t i = 0; i != images.size(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_VERIFY(images[i]);
+        CORRADE_COMPARE(images[i]->format(), expected->format());
+        CORRADE_COMPARE(images[i]->size(), expected->size());
+        CORRADE_COMPARE_AS(images[i]->data(), expected->data(),
+            TestSuite::Compare::Container);
+    }
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Trade::Test::TgaImporterTest)
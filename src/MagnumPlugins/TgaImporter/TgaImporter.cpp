@@ -25,13 +25,19 @@
 
 #include "TgaImporter.h"
 
+#include <cstring>
 #include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/Endianness.h>
 
+#include "Magnum/ConvertPixels.h"
+#include "Magnum/ImageOperations.h"
+#include "Magnum/ImageView.h"
 #include "Magnum/PixelFormat.h"
-#include "Magnum/Math/Swizzle.h"
+#include "Magnum/Math/Range.h"
 #include "Magnum/Math/Vector4.h"
 #include "Magnum/Trade/ImageData.h"
 #include "MagnumPlugins/TgaImporter/TgaHeader.h"
@@ -44,7 +50,7 @@ TgaImporter::TgaImporter(PluginManager::AbstractManager& manager, const Containe
 
 TgaImporter::~TgaImporter() = default;
 
-ImporterFeatures TgaImporter::doFeatures() const { return ImporterFeature::OpenData; }
+ImporterFeatures TgaImporter::doFeatures() const { return ImporterFeature::OpenData|ImporterFeature::ThreadSafeImport; }
 
 bool TgaImporter::doIsOpened() const { return _in; }
 
@@ -63,7 +69,12 @@ void TgaImporter::doOpenData(Containers::Array<char>&& data, const DataFlags dat
         return;
     }
 
-    /* Ttake over the existing array or copy the data if we can't */
+    /* Uncompressed pixel data can be referenced by the imported images only
+       if the memory is guaranteed to stay around, i.e. if it's externally
+       owned. Importer-owned memory would go away on close(). */
+    _zeroCopy = !!(dataFlags & DataFlag::ExternallyOwned);
+
+    /* Take over the existing array or copy the data if we can't */
     if(dataFlags & (DataFlag::Owned|DataFlag::ExternallyOwned)) {
         _in = std::move(data);
     } else {
@@ -74,40 +85,50 @@ void TgaImporter::doOpenData(Containers::Array<char>&& data, const DataFlags dat
 
 UnsignedInt TgaImporter::doImage2DCount() const { return 1; }
 
-Containers::Optional<ImageData2D> TgaImporter::doImage2D(UnsignedInt, UnsignedInt) {
+namespace {
+
+struct TgaProperties {
+    Vector2i size;
+    PixelFormat format;
+    std::size_t pixelSize;
+    bool rle;
+    bool yDown;
+};
+
+Containers::Optional<TgaProperties> parseHeader(const Containers::ArrayView<const char> in, const char* const messagePrefix) {
     /* Check if the file is long enough */
-    if(_in.size() < sizeof(Implementation::TgaHeader)) {
-        Error{} << "Trade::TgaImporter::image2D(): file too short, expected at least" << sizeof(Implementation::TgaHeader) << "bytes but got" << _in.size();
+    if(in.size() < sizeof(Implementation::TgaHeader)) {
+        Error{} << messagePrefix << "file too short, expected at least" << sizeof(Implementation::TgaHeader) << "bytes but got" << in.size();
         return Containers::NullOpt;
     }
 
-    const Implementation::TgaHeader& header = *reinterpret_cast<const Implementation::TgaHeader*>(_in.data());
+    const Implementation::TgaHeader& header = *reinterpret_cast<const Implementation::TgaHeader*>(in.data());
+
+    TgaProperties out;
 
     /* Size in machine endian */
-    const Vector2i size{Utility::Endianness::littleEndian(header.width),
-                        Utility::Endianness::littleEndian(header.height)};
+    out.size = {Utility::Endianness::littleEndian(header.width),
+                Utility::Endianness::littleEndian(header.height)};
 
     /* Image format */
-    PixelFormat format;
     if(header.colorMapType != 0) {
-        Error() << "Trade::TgaImporter::image2D(): paletted files are not supported";
+        Error() << messagePrefix << "paletted files are not supported";
         return Containers::NullOpt;
     }
 
     /* Color */
-    bool rle = false;
     if(header.imageType == 2 || header.imageType == 10) {
         /* Reference: http://www.paulbourke.net/dataformats/tga/ */
-        rle = header.imageType == 10;
+        out.rle = header.imageType == 10;
         switch(header.bpp) {
             case 24:
-                format = PixelFormat::RGB8Unorm;
+                out.format = PixelFormat::RGB8Unorm;
                 break;
             case 32:
-                format = PixelFormat::RGBA8Unorm;
+                out.format = PixelFormat::RGBA8Unorm;
                 break;
             default:
-                Error() << "Trade::TgaImporter::image2D(): unsupported color bits-per-pixel:" << header.bpp;
+                Error() << messagePrefix << "unsupported color bits-per-pixel:" << header.bpp;
                 return Containers::NullOpt;
         }
 
@@ -116,97 +137,214 @@ Containers::Optional<ImageData2D> TgaImporter::doImage2D(UnsignedInt, UnsignedIn
         /* I only discovered this by accident when using ImageMagick's
             mogrify -compression RunLengthEncoded file.tga
            as far as I could find, it's not documented in any TGA specs */
-        rle = header.imageType == 11;
-        format = PixelFormat::R8Unorm;
+        out.rle = header.imageType == 11;
+        out.format = PixelFormat::R8Unorm;
         if(header.bpp != 8) {
-            Error() << "Trade::TgaImporter::image2D(): unsupported grayscale bits-per-pixel:" << header.bpp;
+            Error() << messagePrefix << "unsupported grayscale bits-per-pixel:" << header.bpp;
             return Containers::NullOpt;
         }
 
     /* Other? */
     } else {
-        Error() << "Trade::TgaImporter::image2D(): unsupported image type:" << header.imageType;
+        Error() << messagePrefix << "unsupported image type:" << header.imageType;
         return Containers::NullOpt;
     }
 
-    const std::size_t pixelSize = header.bpp/8;
-    const std::size_t outputSize = std::size_t(size.product())*pixelSize;
+    out.pixelSize = header.bpp/8;
+    /* Bit 5 of the descriptor set means the first row in the file is the top
+       one */
+    out.yDown = header.descriptor & 0x20;
+    return out;
+}
+
+/* Files that are larger are allowed for uncompressed data (but not for RLE).
+   The size is checked for the whole image and not just the requested range
+   to have the same behavior in both cases. */
+bool checkUncompressedSize(const Containers::ArrayView<const char> in, const TgaProperties& properties, const char* const messagePrefix) {
+    const std::size_t dataSize = std::size_t(properties.size.product())*properties.pixelSize;
+    if(in.size() - sizeof(Implementation::TgaHeader) < dataSize) {
+        Error{} << messagePrefix << "file too short, expected" << dataSize + sizeof(Implementation::TgaHeader) << "bytes but got" << in.size();
+        return false;
+    }
+
+    return true;
+}
+
+/* Decodes pixels in range [first, first + dst.size()/pixelSize) into dst,
+   counting pixels row by row in the order in which they're stored in the
+   file. Pixels that aren't present in RLE data are left untouched. */
+bool decodePixels(const Containers::ArrayView<const char> in, const TgaProperties& properties, const std::size_t first, const Containers::ArrayView<char> dst, const char* const messagePrefix) {
+    const std::size_t pixelSize = properties.pixelSize;
+    const std::size_t pixelCount = std::size_t(properties.size.product());
+    const std::size_t last = first + dst.size()/pixelSize;
+    Containers::ArrayView<const char> srcPixels = in.exceptPrefix(sizeof(Implementation::TgaHeader));
 
     /* Copy data directly if not RLE */
-    Containers::Array<char> data{outputSize};
-    Containers::ArrayView<const char> srcPixels = _in.exceptPrefix(sizeof(Implementation::TgaHeader));
-    if(!rle) {
-        /* Files that are larger are allowed in this case (but not for RLE) */
-        if(srcPixels.size() < outputSize) {
-            Error{} << "Trade::TgaImporter::image2D(): file too short, expected" << outputSize + sizeof(Implementation::TgaHeader) << "bytes but got" << _in.size();
-            return Containers::NullOpt;
-        }
+    if(!properties.rle) {
+        if(!checkUncompressedSize(in, properties, messagePrefix))
+            return false;
 
-        Utility::copy(srcPixels.prefix(data.size()), data);
+        Utility::copy(srcPixels.slice(first*pixelSize, last*pixelSize), dst);
+        return true;
+    }
 
-    /* Otherwise decode */
-    } else {
-        Containers::ArrayView<char> dstPixels = data;
-        while(!srcPixels.isEmpty()) {
-            /* Reference: http://www.paulbourke.net/dataformats/tga/ */
-
-            /* 8-bit RLE header. First bit denotes the operation, last 7 bits
-               denotes operation count minus 1. */
-            const UnsignedByte rleHeader = srcPixels[0];
-            const std::size_t count = (rleHeader & ~0x80) + 1;
-
-            /* First bit set to 1 means copying the following pixel given
-               number of times, 0 means copying the following number of
-               pixels once. We represent that operation with a stride. */
-            const std::size_t dataSize = (rleHeader & 0x80 ? 1 : count)*pixelSize;
-            const std::ptrdiff_t stride = rleHeader & 0x80 ? 0 : pixelSize;
-
-            /* Check bounds */
-            if(1 + dataSize > srcPixels.size()) {
-                Error{} << "Trade::TgaImporter::image2D(): RLE file too short at pixel" << (dstPixels.begin() - data.begin())/pixelSize;
-                return Containers::NullOpt;
-            }
-            if(count*pixelSize > dstPixels.size()) {
-                Error{} << "Trade::TgaImporter::image2D(): RLE data larger than advertised" << size << "pixels at byte" << (srcPixels.data() - _in.data());
-                return Containers::NullOpt;
-            }
+    /* Otherwise decode. RLE packets have variable size so all packets before
+       the requested range have to be walked through, but only their
+       intersection with the range gets copied. When decoding the whole image,
+       the loop continues until the end of the data to detect trailing
+       garbage, for a partial range it stops once the range is done. */
+    std::size_t pixel = 0;
+    while(!srcPixels.isEmpty() && (pixel < last || last == pixelCount)) {
+        /* Reference: http://www.paulbourke.net/dataformats/tga/ */
+
+        /* 8-bit RLE header. First bit denotes the operation, last 7 bits
+           denotes operation count minus 1. */
+        const UnsignedByte rleHeader = srcPixels[0];
+        const std::size_t count = (rleHeader & ~0x80) + 1;
 
-            /* Copy the data */
-            Containers::StridedArrayView2D<const char> src{
-                srcPixels.slice(1, 1 + dataSize),
-                {count, pixelSize}, {stride, 1}};
-            Containers::StridedArrayView2D<char> dst{
-                dstPixels.prefix(count*pixelSize),
-                {count, pixelSize}};
-            Utility::copy(src, dst);
-
-            /* Update views for the next round */
-            srcPixels = srcPixels.exceptPrefix(1 + dataSize);
-            dstPixels = dstPixels.exceptPrefix(count*pixelSize);
+        /* First bit set to 1 means copying the following pixel given number
+           of times, 0 means copying the following number of pixels once */
+        const bool repeat = rleHeader & 0x80;
+        const std::size_t dataSize = (repeat ? 1 : count)*pixelSize;
+
+        /* Check bounds */
+        if(1 + dataSize > srcPixels.size()) {
+            Error{} << messagePrefix << "RLE file too short at pixel" << pixel;
+            return false;
+        }
+        if(count > pixelCount - pixel) {
+            Error{} << messagePrefix << "RLE data larger than advertised" << properties.size << "pixels at byte" << (srcPixels.data() - in.data());
+            return false;
         }
+
+        /* Copy the part of the packet that overlaps the requested range */
+        const std::size_t begin = pixel > first ? pixel : first;
+        const std::size_t end = pixel + count < last ? pixel + count : last;
+        if(begin < end) {
+            const char* const src = srcPixels.data() + 1;
+            char* const out = dst.data() + (begin - first)*pixelSize;
+            const std::size_t size = (end - begin)*pixelSize;
+
+            /* Raw packets are a plain copy */
+            if(!repeat)
+                std::memcpy(out, src + (begin - pixel)*pixelSize, size);
+
+            /* Repeated single-byte pixels are a memset(), wider pixels get
+               copied once and then the already filled part is doubled until
+               the whole run is filled, which is considerably faster than
+               copying pixel by pixel for long runs */
+            else if(pixelSize == 1)
+                std::memset(out, src[0], size);
+            else {
+                std::memcpy(out, src, pixelSize);
+                for(std::size_t filled = pixelSize; filled < size; ) {
+                    const std::size_t chunk = filled < size - filled ? filled : size - filled;
+                    std::memcpy(out + filled, out, chunk);
+                    filled += chunk;
+                }
+            }
+        }
+
+        /* Update views for the next round */
+        srcPixels = srcPixels.exceptPrefix(1 + dataSize);
+        pixel += count;
+    }
+
+    return true;
+}
+
+void swizzlePixels(const PixelFormat format, const Vector2i& size, const Containers::ArrayView<char> data, const bool verbose, const char* const messagePrefix) {
+    if(format == PixelFormat::RGB8Unorm) {
+        if(verbose)
+            Debug{} << messagePrefix << "converting from BGR to RGB";
+    } else if(format == PixelFormat::RGBA8Unorm) {
+        if(verbose)
+            Debug{} << messagePrefix << "converting from BGRA to RGBA";
+    } else return;
+
+    /* The data are tightly packed. Converting on a single thread, as parallel
+       import is done at a higher level through ThreadSafeImport. */
+    const MutableImageView2D image{PixelStorage{}.setAlignment(1), format, size, data};
+    convertPixels(image, image, ConvertPixelsFlag::SwapRedBlue, 1);
+}
+
+}
+
+Containers::Optional<ImageData2D> TgaImporter::doImage2D(UnsignedInt, UnsignedInt) {
+    return importRows("Trade::TgaImporter::image2D():", Containers::NullOpt);
+}
+
+Containers::Optional<Vector2i> TgaImporter::doImage2DSize(UnsignedInt, UnsignedInt) {
+    const Containers::Optional<TgaProperties> properties = parseHeader(_in, "Trade::TgaImporter::image2DSize():");
+    if(!properties) return Containers::NullOpt;
+
+    return properties->size;
+}
+
+Containers::Optional<ImageData2D> TgaImporter::doImage2DRows(UnsignedInt, UnsignedInt, const Range1Dui& rows) {
+    return importRows("Trade::TgaImporter::image2DRows():", rows);
+}
+
+Containers::Optional<ImageData2D> TgaImporter::importRows(const char* const messagePrefix, const Containers::Optional<Range1Dui>& rows) {
+    const Containers::Optional<TgaProperties> properties = parseHeader(_in, messagePrefix);
+    if(!properties) return Containers::NullOpt;
+
+    if(rows && rows->max() > UnsignedInt(properties->size.y())) {
+        Error{} << messagePrefix << "rows" << rows->min() << "to" << rows->max() << "out of range for an image of" << properties->size.y() << "rows";
+        return Containers::NullOpt;
     }
 
+    /* Rows in the file are either bottom-up, same as in Magnum, or top-down,
+       in which case the range is mirrored. Either way it maps to a contiguous
+       range of pixels in the file. */
+    const UnsignedInt height = properties->size.y();
+    const Range1Dui fileRows = !rows ? Range1Dui{0, height} :
+        properties->yDown ? Range1Dui{height - rows->max(), height - rows->min()} : *rows;
+    const Vector2i size{properties->size.x(), Int(fileRows.size())};
+    const std::size_t first = std::size_t(fileRows.min())*properties->size.x();
+    const std::size_t dataSize = std::size_t(size.product())*properties->pixelSize;
+
     /* Adjust pixel storage if row size is not four byte aligned */
     PixelStorage storage;
-    if((size.x()*header.bpp/8)%4 != 0)
+    if((size.x()*properties->pixelSize)%4 != 0)
         storage.setAlignment(1);
 
-    if(format == PixelFormat::RGB8Unorm) {
+    /* If the memory stays around, the data aren't compressed and don't need
+       any swizzling, reference them directly. The rows are then kept in the
+       file order, which is signalled with a flag. */
+    const bool swizzle = configuration().value<bool>("swizzle") && properties->format != PixelFormat::R8Unorm;
+    if(_zeroCopy && !properties->rle && !swizzle) {
+        if(!checkUncompressedSize(_in, *properties, messagePrefix))
+            return Containers::NullOpt;
+
         if(flags() & ImporterFlag::Verbose)
-            Debug{} << "Trade::TgaImporter::image2D(): converting from BGR to RGB";
-        for(Vector3ub& pixel: Containers::arrayCast<Vector3ub>(data))
-            pixel = Math::gather<'b', 'g', 'r'>(pixel);
-    } else if(format == PixelFormat::RGBA8Unorm) {
+            Debug{} << messagePrefix << "referencing the data without a copy";
+
+        return ImageData2D{storage, properties->format, size, DataFlags{},
+            _in.sliceSize(sizeof(Implementation::TgaHeader) + first*properties->pixelSize, dataSize),
+            properties->yDown ? ImageFlags2D{ImageFlag2D::YDown} : ImageFlags2D{}};
+    }
+
+    Containers::Array<char> data = allocateData(dataSize);
+    /* RLE data that end early leave the rest of the image zero-filled */
+    if(properties->rle) std::memset(data, 0, data.size());
+    if(!decodePixels(_in, *properties, first, data, messagePrefix))
+        return Containers::NullOpt;
+
+    if(swizzle)
+        swizzlePixels(properties->format, size, data, bool(flags() & ImporterFlag::Verbose), messagePrefix);
+
+    /* Copied data are always returned bottom-up */
+    if(properties->yDown) {
         if(flags() & ImporterFlag::Verbose)
-            Debug{} << "Trade::TgaImporter::image2D(): converting from BGRA to RGBA";
-        for(Vector4ub& pixel: Containers::arrayCast<Vector4ub>(data))
-            pixel = Math::gather<'b', 'g', 'r', 'a'>(pixel);
+            Debug{} << messagePrefix << "flipping the image from top-down to bottom-up";
+        flipImageY(MutableImageView2D{storage, properties->format, size, data}, 1);
     }
 
-    return ImageData2D{storage, format, size, std::move(data)};
+    return ImageData2D{storage, properties->format, size, std::move(data)};
 }
 
 }}
 
 CORRADE_PLUGIN_REGISTER(TgaImporter, Magnum::Trade::TgaImporter,
-    "cz.mosra.magnum.Trade.AbstractImporter/0.5")
+    "cz.mosra.magnum.Trade.AbstractImporter/0.5.1")
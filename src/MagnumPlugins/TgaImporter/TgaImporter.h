@@ -97,7 +97,43 @@ The images are imported with @ref PixelFormat::RGB8Unorm,
 are imported with default @ref PixelStorage parameters except for alignment,
 which may be changed to `1` if the data require it.
 
-RLE compression is supported, paletted images are not.
+RLE compression is supported, paletted images are not. TGA stores color
+channels in a BGR(A) order, the importer by default swaps them to produce RGB(A)
+data. Files with a top-down origin are flipped to the bottom-up row order
+Magnum expects.
+
+If the data are opened with @ref openMemory() or with
+@ref ImporterFlag::MapFiles set and the image is neither RLE-compressed nor
+needs the channels swapped, the returned @ref ImageData2D references the
+pixel data directly instead of making a copy, with @ref ImageData::dataFlags()
+being empty. That's always the case for grayscale images, and for color images
+if the @cb{.ini} swizzle @ce @ref Trade-TgaImporter-configuration "configuration option"
+is disabled. In that case the channels stay in the BGR(A) order even though
+the format is reported as @ref PixelFormat::RGB8Unorm or
+@ref PixelFormat::RGBA8Unorm. As the rows can't be flipped without a copy,
+images with a top-down origin are then imported with @ref ImageFlag2D::YDown
+set, and the caller is expected to either handle the orientation directly or
+flip the image with @ref flipImageY().
+
+The importer implements @ref image2DSize() and @ref image2DRows() natively,
+reading just the file header and decoding just the requested rows,
+respectively. For RLE-compressed files all data preceding the requested rows
+have to be walked through, but only the requested rows are expanded, so the
+memory use is proportional to the row range size and not the whole image.
+
+The importer supports @ref ImporterFeature::ThreadSafeImport, the image can be
+imported from multiple threads at once, for example using
+@ref parallelLoadImages2D().
+
+@section Trade-TgaImporter-configuration Plugin-specific configuration
+
+It's possible to tune various import options through @ref configuration(). See
+below for all options and their default values:
+
+@snippet MagnumPlugins/TgaImporter/TgaImporter.conf configuration_
+
+See @ref plugins-configuration for more information and an example showing how
+to edit the configuration values.
 */
 class MAGNUM_TGAIMPORTER_EXPORT TgaImporter: public AbstractImporter {
     public:
@@ -116,8 +152,13 @@ class MAGNUM_TGAIMPORTER_EXPORT TgaImporter: public AbstractImporter {
         void MAGNUM_TGAIMPORTER_LOCAL doClose() override;
         UnsignedInt MAGNUM_TGAIMPORTER_LOCAL doImage2DCount() const override;
         Containers::Optional<ImageData2D> MAGNUM_TGAIMPORTER_LOCAL doImage2D(UnsignedInt id, UnsignedInt level) override;
+        Containers::Optional<Vector2i> MAGNUM_TGAIMPORTER_LOCAL doImage2DSize(UnsignedInt id, UnsignedInt level) override;
+        Containers::Optional<ImageData2D> MAGNUM_TGAIMPORTER_LOCAL doImage2DRows(UnsignedInt id, UnsignedInt level, const Range1Dui& rows) override;
+
+        MAGNUM_TGAIMPORTER_LOCAL Containers::Optional<ImageData2D> importRows(const char* messagePrefix, const Containers::Optional<Range1Dui>& rows);
 
         Containers::Array<char> _in;
+        bool _zeroCopy{};
 };
 
 }}
@@ -0,0 +1,163 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <chrono>
+#include <cstring>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Audio/AbstractImporter.h"
+#include "Magnum/Audio/BufferFormat.h"
+#include "Magnum/Math/Functions.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Audio { namespace Test { namespace {
+
+struct WavImporterBenchmark: TestSuite::Tester {
+    explicit WavImporterBenchmark();
+
+    void import();
+
+    void throughputBegin();
+    std::uint64_t throughputEnd();
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
+
+    std::size_t _throughputSize;
+    std::chrono::high_resolution_clock::time_point _throughputBegin;
+};
+
+constexpr std::size_t BenchmarkRepeats = 5;
+constexpr std::size_t BenchmarkIterations = 5;
+constexpr UnsignedInt SampleRate = 44100;
+
+const struct {
+    const char* name;
+    UnsignedShort audioFormat;
+    UnsignedShort bitsPerSample;
+    UnsignedInt seconds;
+    BufferFormat expected;
+} ImportData[]{
+    {"16-bit stereo, 1 second", 1, 16, 1, BufferFormat::Stereo16},
+    {"16-bit stereo, 1 minute", 1, 16, 60, BufferFormat::Stereo16},
+    {"32-bit float stereo, 1 second", 3, 32, 1, BufferFormat::StereoFloat},
+    {"32-bit float stereo, 1 minute", 3, 32, 60, BufferFormat::StereoFloat},
+};
+
+WavImporterBenchmark::WavImporterBenchmark() {
+    /* Time of open + import */
+    addInstancedBenchmarks({&WavImporterBenchmark::import},
+        BenchmarkRepeats, Containers::arraySize(ImportData));
+
+    /* Megabytes of input data processed per second */
+    addCustomInstancedBenchmarks({&WavImporterBenchmark::import},
+        BenchmarkRepeats, Containers::arraySize(ImportData),
+        &WavImporterBenchmark::throughputBegin,
+        &WavImporterBenchmark::throughputEnd,
+        BenchmarkUnits::Count);
+
+    /* Load the plugin directly from the build tree. Otherwise it's static and
+       already loaded. */
+    #ifdef WAVAUDIOIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(WAVAUDIOIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+}
+
+void WavImporterBenchmark::throughputBegin() {
+    setBenchmarkName("MB/s");
+    _throughputBegin = std::chrono::high_resolution_clock::now();
+}
+
+std::uint64_t WavImporterBenchmark::throughputEnd() {
+    const std::uint64_t elapsed = Math::max(std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - _throughputBegin).count()), std::uint64_t{1});
+
+    /* The returned value gets divided by the iteration count passed to
+       CORRADE_BENCHMARK(), so multiply it by the count once more to get
+       megabytes per second */
+    return std::uint64_t(Double(_throughputSize)*BenchmarkIterations*BenchmarkIterations*1.0e3/elapsed);
+}
+
+/* Assumes a little-endian platform, the same as the generated file */
+template<class T> char* write(char* out, T value) {
+    std::memcpy(out, &value, sizeof(T));
+    return out + sizeof(T);
+}
+
+Containers::Array<char> generateWav(const UnsignedShort audioFormat, const UnsignedShort bitsPerSample, const UnsignedInt seconds) {
+    constexpr UnsignedShort ChannelCount = 2;
+    const UnsignedShort blockAlign = ChannelCount*bitsPerSample/8;
+    const UnsignedInt dataSize = seconds*SampleRate*blockAlign;
+
+    Containers::Array<char> out{NoInit, 44 + dataSize};
+    char* data = out;
+    std::memcpy(data, "RIFF", 4);
+    data = write<UnsignedInt>(data + 4, 36 + dataSize);
+    std::memcpy(data, "WAVEfmt ", 8);
+    data = write<UnsignedInt>(data + 8, 16);
+    data = write<UnsignedShort>(data, audioFormat);
+    data = write<UnsignedShort>(data, ChannelCount);
+    data = write<UnsignedInt>(data, SampleRate);
+    data = write<UnsignedInt>(data, SampleRate*blockAlign);
+    data = write<UnsignedShort>(data, blockAlign);
+    data = write<UnsignedShort>(data, bitsPerSample);
+    std::memcpy(data, "data", 4);
+    data = write<UnsignedInt>(data + 4, dataSize);
+
+    /* The actual samples don't matter, neither format is converted */
+    for(std::size_t i = 0; i != dataSize; ++i)
+        data[i] = char(i);
+
+    return out;
+}
+
+void WavImporterBenchmark::import() {
+    auto&& data = ImportData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    #ifdef CORRADE_TARGET_BIG_ENDIAN
+    CORRADE_SKIP("The generated file is little-endian.");
+    #endif
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
+
+    const Containers::Array<char> wav = generateWav(data.audioFormat, data.bitsPerSample, data.seconds);
+    _throughputSize = wav.size();
+
+    Containers::Array<char> out;
+    CORRADE_BENCHMARK(BenchmarkIterations) {
+        importer->openData(wav);
+        out = importer->data();
+    }
+
+    CORRADE_COMPARE(importer->format(), data.expected);
+    CORRADE_COMPARE(importer->frequency(), SampleRate);
+    CORRADE_COMPARE(out.size(), wav.size() - 44);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Audio::Test::WavImporterBenchmark)
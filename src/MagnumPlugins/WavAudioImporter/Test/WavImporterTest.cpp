@@ -26,6 +26,7 @@
 
 #include <sstream>
 #include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/String.h>
 #include <Corrade/Containers/StringStl.h> /** @todo remove once AbstractImporter is <string>-free */
 #include <Corrade/TestSuite/Tester.h>
@@ -80,6 +81,14 @@ struct WavImporterTest: TestSuite::Tester {
     void surround51Channel16();
     void surround71Channel24();
 
+    void dataChunk();
+    void dataChunkSeek();
+    void dataChunkReopen();
+
+    void dataView();
+    void openMemory();
+    void openMemoryBigEndian();
+
     /* Explicitly forbid system-wide plugin dependencies */
     PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
 };
@@ -121,7 +130,15 @@ WavImporterTest::WavImporterTest() {
               &WavImporterTest::stereo64fBigEndian,
 
               &WavImporterTest::surround51Channel16,
-              &WavImporterTest::surround71Channel24});
+              &WavImporterTest::surround71Channel24,
+
+              &WavImporterTest::dataChunk,
+              &WavImporterTest::dataChunkSeek,
+              &WavImporterTest::dataChunkReopen,
+
+              &WavImporterTest::dataView,
+              &WavImporterTest::openMemory,
+              &WavImporterTest::openMemoryBigEndian});
 
     /* Load the plugin directly from the build tree. Otherwise it's static and
        already loaded. */
@@ -471,6 +488,136 @@ void WavImporterTest::surround71Channel24() {
     CORRADE_COMPARE(out.str(), "Audio::WavImporter::openData(): unsupported format Audio::WavAudioFormat::Extensible\n");
 }
 
+void WavImporterTest::dataChunk() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
+    CORRADE_VERIFY(importer->openFile(Utility::Path::join(WAVAUDIOIMPORTER_TEST_DIR, "stereo32f.wav")));
+    CORRADE_COMPARE(importer->format(), BufferFormat::StereoFloat);
+
+    /* 1352 bytes in total, 8 bytes per frame. The destination gets rounded
+       down to 496 bytes. */
+    Containers::Array<char> data = importer->data();
+    Containers::Array<char> chunk{ValueInit, 500};
+    CORRADE_COMPARE(importer->dataChunk(chunk), 496);
+    CORRADE_COMPARE_AS(chunk.prefix(496), data.prefix(496),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(importer->dataChunk(chunk), 496);
+    CORRADE_COMPARE_AS(chunk.prefix(496), data.sliceSize(496, 496),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(importer->dataChunk(chunk), 360);
+    CORRADE_COMPARE_AS(chunk.prefix(360), data.exceptPrefix(992),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(importer->dataChunk(chunk), 0);
+    CORRADE_COMPARE(importer->dataChunk(chunk), 0);
+}
+
+void WavImporterTest::dataChunkSeek() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
+    CORRADE_VERIFY(importer->openFile(Utility::Path::join(WAVAUDIOIMPORTER_TEST_DIR, "stereo32f.wav")));
+
+    Containers::Array<char> data = importer->data();
+    Containers::Array<char> chunk{ValueInit, 1352};
+
+    /* Seek to the last ten frames */
+    importer->seekData(159);
+    CORRADE_COMPARE(importer->dataChunk(chunk), 80);
+    CORRADE_COMPARE_AS(chunk.prefix(80), data.exceptPrefix(1272),
+        TestSuite::Compare::Container);
+
+    /* Seeking back to the start gives everything again */
+    importer->seekData(0);
+    CORRADE_COMPARE(importer->dataChunk(chunk), 1352);
+    CORRADE_COMPARE_AS(chunk, data,
+        TestSuite::Compare::Container);
+
+    /* Seeking past the end gives nothing */
+    importer->seekData(1000);
+    CORRADE_COMPARE(importer->dataChunk(chunk), 0);
+}
+
+void WavImporterTest::dataChunkReopen() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
+    CORRADE_VERIFY(importer->openFile(Utility::Path::join(WAVAUDIOIMPORTER_TEST_DIR, "stereo8.wav")));
+
+    char chunk[4];
+    CORRADE_COMPARE(importer->dataChunk(chunk), 4);
+    CORRADE_COMPARE(importer->dataChunk(chunk), 0);
+
+    /* Opening a file again should start from the beginning */
+    CORRADE_VERIFY(importer->openFile(Utility::Path::join(WAVAUDIOIMPORTER_TEST_DIR, "stereo8.wav")));
+    CORRADE_COMPARE(importer->dataChunk(chunk), 4);
+    CORRADE_COMPARE_AS(Containers::arrayView(chunk), Containers::arrayView<char>({
+        '\xde', '\xfe', '\xca', '\x7e'
+    }), TestSuite::Compare::Container);
+}
+
+void WavImporterTest::dataView() {
+    Containers::Optional<Containers::Array<char>> data = Utility::Path::read(Utility::Path::join(WAVAUDIOIMPORTER_TEST_DIR, "mono16.wav"));
+    CORRADE_VERIFY(data);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
+    CORRADE_VERIFY(importer->openData(*data));
+
+    /* The view is available, but points to an importer-owned copy */
+    Containers::Optional<Containers::ArrayView<const char>> view = importer->dataView();
+    CORRADE_VERIFY(view);
+    CORRADE_VERIFY(view->begin() >= data->end() || view->end() <= data->begin());
+    CORRADE_COMPARE_AS(Containers::arrayCast<const UnsignedShort>(*view),
+        Containers::arrayView<UnsignedShort>({0x101d, 0xc571}),
+        TestSuite::Compare::Container);
+}
+
+void WavImporterTest::openMemory() {
+    Containers::Optional<Containers::Array<char>> data = Utility::Path::read(Utility::Path::join(WAVAUDIOIMPORTER_TEST_DIR, "mono16.wav"));
+    CORRADE_VERIFY(data);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
+    CORRADE_VERIFY(importer->openMemory(*data));
+    CORRADE_COMPARE(importer->format(), BufferFormat::Mono16);
+    CORRADE_COMPARE(importer->frequency(), 44000);
+
+    Containers::Optional<Containers::ArrayView<const char>> view = importer->dataView();
+    CORRADE_VERIFY(view);
+    CORRADE_COMPARE(view->size(), 4);
+    #ifndef CORRADE_TARGET_BIG_ENDIAN
+    /* The view should point directly into the passed memory, right at the
+       end since the data chunk is the last one */
+    CORRADE_COMPARE(static_cast<const void*>(view->data()), static_cast<const void*>(data->end() - 4));
+    #endif
+    CORRADE_COMPARE_AS(Containers::arrayCast<const UnsignedShort>(*view),
+        Containers::arrayView<UnsignedShort>({0x101d, 0xc571}),
+        TestSuite::Compare::Container);
+
+    /* The copying APIs should work with the referenced memory as well */
+    CORRADE_COMPARE_AS(Containers::arrayCast<UnsignedShort>(importer->data()),
+        Containers::arrayView<UnsignedShort>({0x101d, 0xc571}),
+        TestSuite::Compare::Container);
+    char chunk[2];
+    CORRADE_COMPARE(importer->dataChunk(chunk), 2);
+    CORRADE_COMPARE(importer->dataChunk(chunk), 2);
+    CORRADE_COMPARE(importer->dataChunk(chunk), 0);
+
+    importer->close();
+    CORRADE_VERIFY(!importer->isOpened());
+}
+
+void WavImporterTest::openMemoryBigEndian() {
+    Containers::Optional<Containers::Array<char>> data = Utility::Path::read(Utility::Path::join(WAVAUDIOIMPORTER_TEST_DIR, "mono16be.wav"));
+    CORRADE_VERIFY(data);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
+    CORRADE_VERIFY(importer->openMemory(*data));
+
+    Containers::Optional<Containers::ArrayView<const char>> view = importer->dataView();
+    CORRADE_VERIFY(view);
+    #ifndef CORRADE_TARGET_BIG_ENDIAN
+    /* The data need to be endian-swapped, so it's a copy */
+    CORRADE_VERIFY(view->begin() >= data->end() || view->end() <= data->begin());
+    #endif
+    CORRADE_COMPARE_AS(Containers::arrayCast<const UnsignedShort>(*view),
+        Containers::arrayView<UnsignedShort>({0x101d, 0xc571}),
+        TestSuite::Compare::Container);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Audio::Test::WavImporterTest)
@@ -31,6 +31,8 @@
 #include <Corrade/Utility/Debug.h>
 #include <Corrade/Utility/EndiannessBatch.h>
 
+#include "Magnum/Audio/BufferFormat.h"
+#include "Magnum/Math/Functions.h"
 #include "MagnumPlugins/WavAudioImporter/WavHeader.h"
 
 namespace Magnum { namespace Audio {
@@ -49,6 +51,14 @@ ImporterFeatures WavImporter::doFeatures() const { return ImporterFeature::OpenD
 bool WavImporter::doIsOpened() const { return !!_data; }
 
 void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
+    openInternal(data, true);
+}
+
+void WavImporter::doOpenMemory(Containers::ArrayView<const char> memory) {
+    openInternal(memory, false);
+}
+
+void WavImporter::openInternal(Containers::ArrayView<const char> data, const bool copy) {
     /* Check file size */
     if(data.size() < sizeof(WavHeaderChunk) + sizeof(WavFormatChunk) + sizeof(RiffChunk)) {
         Error() << "Audio::WavImporter::openData(): the file is too short:" << data.size() << "bytes";
@@ -218,12 +228,25 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
         return;
     }
 
-    /* Save frequency */
+    /* Save frequency, reset the dataChunk() position */
     _frequency = formatChunk->sampleRate;
+    _dataOffset = 0;
+
+    const Containers::ArrayView<const char> samples{reinterpret_cast<const char*>(dataChunk + 1), dataChunkSize};
+
+    /* If the memory is guaranteed to stay around and the data don't need
+       any endian swapping, reference them directly. The empty array is there
+       only to mark the file as opened. */
+    if(!copy && hasBigEndianData == Utility::Endianness::isBigEndian()) {
+        _data = Containers::Array<char>{};
+        _view = samples;
+        return;
+    }
 
-    /* Copy the data */
+    /* Otherwise copy the data */
     _data = Containers::Array<char>{NoInit, dataChunkSize};
-    Utility::copy(Containers::arrayView(reinterpret_cast<const char*>(dataChunk + 1), dataChunkSize), *_data);
+    Utility::copy(samples, *_data);
+    _view = *_data;
 
     /* Fix the data endianness */
     if(hasBigEndianData != Utility::Endianness::isBigEndian()) {
@@ -237,19 +260,43 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
     }
 }
 
-void WavImporter::doClose() { _data = Containers::NullOpt; }
+void WavImporter::doClose() {
+    _data = Containers::NullOpt;
+    _view = nullptr;
+}
 
 BufferFormat WavImporter::doFormat() const { return _format; }
 
 UnsignedInt WavImporter::doFrequency() const { return _frequency; }
 
 Containers::Array<char> WavImporter::doData() {
-    Containers::Array<char> copy{NoInit, _data->size()};
-    Utility::copy(*_data, copy);
+    Containers::Array<char> copy{NoInit, _view.size()};
+    Utility::copy(_view, copy);
     return copy;
 }
 
+Containers::Optional<Containers::ArrayView<const char>> WavImporter::doDataView() {
+    return _view;
+}
+
+std::size_t WavImporter::doDataChunk(const Containers::ArrayView<char> destination) {
+    /* The data are already decoded in memory, so just copy the next part of
+       them instead of making a full copy like doData() does. The size is
+       rounded down to whole sample frames in case the data chunk size isn't
+       a multiple of the frame size. */
+    const std::size_t frameSize = bufferFormatSize(_format);
+    const std::size_t available = _view.size() - Math::min(_dataOffset, _view.size());
+    const std::size_t size = Math::min(destination.size(), available/frameSize*frameSize);
+    Utility::copy(_view.sliceSize(_dataOffset, size), destination.prefix(size));
+    _dataOffset += size;
+    return size;
+}
+
+void WavImporter::doSeekData(const std::size_t frame) {
+    _dataOffset = frame*bufferFormatSize(_format);
+}
+
 }}
 
 CORRADE_PLUGIN_REGISTER(WavAudioImporter, Magnum::Audio::WavImporter,
-    "cz.mosra.magnum.Audio.AbstractImporter/0.1")
+    "cz.mosra.magnum.Audio.AbstractImporter/0.2")
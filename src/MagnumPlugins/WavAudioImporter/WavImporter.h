@@ -108,6 +108,16 @@ See @ref building, @ref cmake and @ref plugins for more information.
 @section Audio-WavImporter-limitations Behavior and limitations
 
 Multi-channel formats are not supported.
+
+With @ref openData() and @ref openFile() the sample data are copied into
+memory on open, @ref dataChunk() then copies directly from it without making a
+full copy of the data first. With @ref openMemory() the sample data are not
+copied at all if the file endianness matches the machine endianness and
+@ref dataView() points directly into the passed memory, see
+@ref Audio-AbstractImporter-zero-copy for an example. Big-Endian files on
+Little-Endian machines and vice versa are always copied in order to convert
+the data. In all cases @ref dataView() is available, pointing either into the
+passed memory or into the importer-owned copy.
 */
 class MAGNUM_WAVAUDIOIMPORTER_EXPORT WavImporter: public AbstractImporter {
     public:
@@ -121,15 +131,24 @@ class MAGNUM_WAVAUDIOIMPORTER_EXPORT WavImporter: public AbstractImporter {
         MAGNUM_WAVAUDIOIMPORTER_LOCAL ImporterFeatures doFeatures() const override;
         MAGNUM_WAVAUDIOIMPORTER_LOCAL bool doIsOpened() const override;
         MAGNUM_WAVAUDIOIMPORTER_LOCAL void doOpenData(Containers::ArrayView<const char> data) override;
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL void doOpenMemory(Containers::ArrayView<const char> memory) override;
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL void openInternal(Containers::ArrayView<const char> data, bool copy);
         MAGNUM_WAVAUDIOIMPORTER_LOCAL void doClose() override;
 
         MAGNUM_WAVAUDIOIMPORTER_LOCAL BufferFormat doFormat() const override;
         MAGNUM_WAVAUDIOIMPORTER_LOCAL UnsignedInt doFrequency() const override;
         MAGNUM_WAVAUDIOIMPORTER_LOCAL Containers::Array<char> doData() override;
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL std::size_t doDataChunk(Containers::ArrayView<char> destination) override;
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL void doSeekData(std::size_t frame) override;
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL Containers::Optional<Containers::ArrayView<const char>> doDataView() override;
 
+        /* Empty if the data are referenced directly from memory passed to
+           openMemory(), NullOpt if no file is opened */
         Containers::Optional<Containers::Array<char>> _data;
+        Containers::ArrayView<const char> _view;
         BufferFormat _format;
         UnsignedInt _frequency;
+        std::size_t _dataOffset;
 };
 
 }}